@@ -15,6 +15,7 @@
 #include "vtkDataSetToPiston.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellType.h"
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
 #include "vtkImageData.h"
@@ -23,12 +24,14 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPistonDataObject.h"
+#include "vtkUnstructuredGrid.h"
 
 //----------------------------------------------------------------------------
 namespace vtkpiston {
   //forward declarations of methods defined in the cuda implementation
   void CopyToGPU(vtkImageData *id, vtkPistonDataObject *od);
   void CopyToGPU(vtkPolyData *id, vtkPistonDataObject *od);
+  void CopyToGPU(vtkUnstructuredGrid *id, vtkPistonDataObject *od);
 }
 
 //----------------------------------------------------------------------------
@@ -172,6 +175,31 @@ int vtkDataSetToPiston::RequestData(vtkInformation *vtkNotUsed(request),
       triangulated->Delete();
       }
       break;
+    case VTK_UNSTRUCTURED_GRID:
+      {
+      vtkUnstructuredGrid *idu = vtkUnstructuredGrid::GetData(inputVector[0]);
+      //piston filters handle tetrahedra only, vtkDataSetTriangleFilter
+      //can make them from other cells
+      vtkIdType numCells = idu->GetNumberOfCells();
+      for (vtkIdType i = 0; i < numCells; i++)
+        {
+        if (idu->GetCellType(i) != VTK_TETRA)
+          {
+          vtkErrorMacro(<< "Can only handle unstructured grids of tetrahedra.");
+          return 1;
+          }
+        }
+      vtkFloatArray *inArray = vtkFloatArray::SafeDownCast(
+        idu->GetPointData()->GetScalars());
+      //this filter expects that input has point associated float scalars
+      if (!inArray || inArray->GetNumberOfComponents() > 1)
+        {
+        vtkErrorMacro(<< "Can't handle the type of array given.\n");
+        return 1;
+        }
+      vtkpiston::CopyToGPU(idu, od);
+      }
+      break;
     default:
       vtkWarningMacro(<< "I don't have a converter from " << ido->GetClassName() << " yet.");
     }
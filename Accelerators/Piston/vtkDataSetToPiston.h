@@ -16,7 +16,10 @@
 // .SECTION Description
 // Converts vtkDataSets that reside on the CPU into piston data that
 // resides on the GPU. Afterward vtkPistonAlgorithms will processed
-// it there.
+// it there. Images with float point scalars, polygonal data and
+// unstructured grids of tetrahedra with float point scalars are
+// converted. The tetrahedra stay on the GPU through vtkPistonThreshold,
+// whose output vtkPistonContour can take without a round trip.
 //
 // .SECTION See Also
 // vtkPistonToDataSet
@@ -1,5 +1,9 @@
 #include <thrust/copy.h>
 #include <thrust/device_vector.h>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/scan.h>
+#include <thrust/transform.h>
 #include "vtkgl.h"
 #include <piston/marching_cube.h>
 #include <piston/vtk_image3d.h>
@@ -14,12 +18,223 @@ namespace vtkpiston {
 using namespace std;
 using namespace piston;
 
+//-----------------------------------------------------------------------------
+// Marching tetrahedra. Each tetrahedron produces no triangle, one triangle
+// when a single vertex is on its side of the isovalue, or two triangles
+// when the vertices split evenly.
+struct tet_triangle_count : thrust::unary_function<int, int>
+{
+  const int *cells;
+  const float *scalars;
+  float isovalue;
+
+  tet_triangle_count(const int *c, const float *s, float iso)
+    : cells(c), scalars(s), isovalue(iso) {}
+
+  __host__ __device__
+  int operator()(int tet) const
+  {
+    int above = 0;
+    for (int i = 0; i < 4; i++)
+      {
+      above += (scalars[cells[tet*4+i]] > isovalue);
+      }
+    return (above == 2) ? 2 : ((above == 1 || above == 3) ? 1 : 0);
+  }
+};
+
+struct tet_triangle_generate
+{
+  const int *cells;
+  const float *points;
+  const float *scalars;
+  const int *offsets;
+  float isovalue;
+  float *outPoints;
+  float *outScalars;
+  float *outNormals;
+
+  tet_triangle_generate(const int *c, const float *p, const float *s,
+                        const int *o, float iso,
+                        float *op, float *os, float *on)
+    : cells(c), points(p), scalars(s), offsets(o), isovalue(iso),
+      outPoints(op), outScalars(os), outNormals(on) {}
+
+  __host__ __device__
+  float3 point(int id) const
+  {
+    return make_float3(points[id*3+0], points[id*3+1], points[id*3+2]);
+  }
+
+  __host__ __device__
+  float3 crossing(int a, int b) const
+  {
+    float t = (isovalue - scalars[a]) / (scalars[b] - scalars[a]);
+    float3 pa = point(a);
+    float3 pb = point(b);
+    return make_float3(pa.x + t*(pb.x - pa.x),
+                       pa.y + t*(pb.y - pa.y),
+                       pa.z + t*(pb.z - pa.z));
+  }
+
+  // write a triangle, oriented so that its normal points from the vertices
+  // above the isovalue to those below, as the normals of marching cubes
+  __host__ __device__
+  void triangle(int tri, float3 p0, float3 p1, float3 p2, float3 down) const
+  {
+    float3 u = make_float3(p1.x - p0.x, p1.y - p0.y, p1.z - p0.z);
+    float3 v = make_float3(p2.x - p0.x, p2.y - p0.y, p2.z - p0.z);
+    float3 n = make_float3(u.y*v.z - u.z*v.y,
+                           u.z*v.x - u.x*v.z,
+                           u.x*v.y - u.y*v.x);
+    if (n.x*down.x + n.y*down.y + n.z*down.z < 0.0f)
+      {
+      float3 tmp = p1; p1 = p2; p2 = tmp;
+      n = make_float3(-n.x, -n.y, -n.z);
+      }
+    float len = sqrtf(n.x*n.x + n.y*n.y + n.z*n.z);
+    if (len > 0.0f)
+      {
+      n = make_float3(n.x/len, n.y/len, n.z/len);
+      }
+    float3 p[3] = { p0, p1, p2 };
+    for (int i = 0; i < 3; i++)
+      {
+      int o = tri*3 + i;
+      outPoints[o*3+0] = p[i].x;
+      outPoints[o*3+1] = p[i].y;
+      outPoints[o*3+2] = p[i].z;
+      outNormals[o*3+0] = n.x;
+      outNormals[o*3+1] = n.y;
+      outNormals[o*3+2] = n.z;
+      outScalars[o] = isovalue;
+      }
+  }
+
+  __host__ __device__
+  void operator()(int tet) const
+  {
+    int in[4];
+    int out[4];
+    int nIn = 0;
+    int nOut = 0;
+    for (int i = 0; i < 4; i++)
+      {
+      int id = cells[tet*4+i];
+      if (scalars[id] > isovalue)
+        {
+        in[nIn++] = id;
+        }
+      else
+        {
+        out[nOut++] = id;
+        }
+      }
+    if (nIn == 0 || nOut == 0)
+      {
+      return;
+      }
+
+    //direction of decreasing scalars, from centroid of in to that of out
+    float3 cIn = make_float3(0.0f, 0.0f, 0.0f);
+    float3 cOut = make_float3(0.0f, 0.0f, 0.0f);
+    for (int i = 0; i < nIn; i++)
+      {
+      float3 p = point(in[i]);
+      cIn.x += p.x/nIn; cIn.y += p.y/nIn; cIn.z += p.z/nIn;
+      }
+    for (int i = 0; i < nOut; i++)
+      {
+      float3 p = point(out[i]);
+      cOut.x += p.x/nOut; cOut.y += p.y/nOut; cOut.z += p.z/nOut;
+      }
+    float3 down = make_float3(cOut.x - cIn.x, cOut.y - cIn.y, cOut.z - cIn.z);
+
+    int tri = offsets[tet];
+    if (nIn == 1)
+      {
+      triangle(tri, crossing(in[0], out[0]), crossing(in[0], out[1]),
+               crossing(in[0], out[2]), down);
+      }
+    else if (nOut == 1)
+      {
+      triangle(tri, crossing(in[0], out[0]), crossing(in[1], out[0]),
+               crossing(in[2], out[0]), down);
+      }
+    else
+      {
+      //the crossings form a quad, in this order around it
+      float3 q0 = crossing(in[0], out[0]);
+      float3 q1 = crossing(in[0], out[1]);
+      float3 q2 = crossing(in[1], out[1]);
+      float3 q3 = crossing(in[1], out[0]);
+      triangle(tri, q0, q1, q2, down);
+      triangle(tri+1, q0, q2, q3, down);
+      }
+  }
+};
+
+//-----------------------------------------------------------------------------
+void ExecutePistonContourTetrahedra(vtkPistonDataObject *inData,
+                                    float isovalue,
+                                    vtkPistonDataObject *outData)
+{
+  vtkPistonReference *ti = inData->GetReference();
+  vtk_tetgrid *gpuData = (vtk_tetgrid *)ti->data;
+  if (gpuData->scalars == NULL)
+    {
+    return;
+    }
+  int nCells = gpuData->nCells;
+  const int *cells = thrust::raw_pointer_cast(gpuData->cells->data());
+  const float *points = thrust::raw_pointer_cast(gpuData->points->data());
+  const float *scalars = thrust::raw_pointer_cast(gpuData->scalars->data());
+
+  //count the triangles of each tetrahedron, then where they start
+  thrust::device_vector<int> offsets(nCells);
+  thrust::transform(thrust::counting_iterator<int>(0),
+                    thrust::counting_iterator<int>(nCells),
+                    offsets.begin(),
+                    tet_triangle_count(cells, scalars, isovalue));
+  int nTriangles = nCells ? offsets.back() : 0;
+  thrust::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin());
+  nTriangles += nCells ? offsets.back() : 0;
+
+  vtkPistonReference *to = outData->GetReference();
+  DeleteData(to);
+
+  to->type = VTK_POLY_DATA;
+  vtk_polydata *newD = new vtk_polydata;
+  to->data = (void*)newD;
+  newD->nPoints = nTriangles*3;
+  newD->vertsPer = 3;
+  newD->points = new thrust::device_vector<float>(newD->nPoints*3);
+  newD->scalars = new thrust::device_vector<float>(newD->nPoints);
+  newD->normals = new thrust::device_vector<float>(newD->nPoints*3);
+  outData->SetScalarsArrayName(inData->GetScalarsArrayName());
+
+  thrust::for_each(thrust::counting_iterator<int>(0),
+                   thrust::counting_iterator<int>(nCells),
+                   tet_triangle_generate(
+                     cells, points, scalars,
+                     thrust::raw_pointer_cast(offsets.data()), isovalue,
+                     thrust::raw_pointer_cast(newD->points->data()),
+                     thrust::raw_pointer_cast(newD->scalars->data()),
+                     thrust::raw_pointer_cast(newD->normals->data())));
+}
+
+//-----------------------------------------------------------------------------
 // execution method found in vtkPistonContour.cu
 void ExecutePistonContour(vtkPistonDataObject *inData,
                           float isovalue,
                           vtkPistonDataObject *outData)
 {
   vtkPistonReference *ti = inData->GetReference();
+  if (ti->type == VTK_UNSTRUCTURED_GRID && ti->data != NULL)
+    {
+    ExecutePistonContourTetrahedra(inData, isovalue, outData);
+    return;
+    }
   if (ti->type != VTK_IMAGE_DATA || ti->data == NULL)
     {
     //type mismatch, don't bother trying
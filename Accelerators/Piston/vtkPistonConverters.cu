@@ -4,11 +4,13 @@
 #include <piston/image3d.h>
 #include <piston/vtk_image3d.h>
 #include "vtkCellArray.h"
+#include "vtkCellType.h"
 #include "vtkFloatArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
 #include "vtkPistonDataObject.h"
 #include "vtkPistonDataWrangling.h"
 #include "vtkPistonReference.h"
@@ -59,6 +61,15 @@ void DeleteData(vtkPistonReference *tr)
     delete oldD;
     }
     break;
+  case VTK_UNSTRUCTURED_GRID:
+    {
+    vtk_tetgrid *oldD = (vtk_tetgrid *)tr->data;
+    delete oldD->points;
+    delete oldD->cells;
+    delete oldD->scalars;
+    delete oldD;
+    }
+    break;
   default:
     cerr << "I don't have a deallocator for " << tr->type << " yet." << endl;
   }
@@ -111,6 +122,19 @@ void DeepCopy(vtkPistonReference *tr, vtkPistonReference *other)
     tr->data = (void*)newD;
     }
     break;
+  case VTK_UNSTRUCTURED_GRID:
+    {
+    vtk_tetgrid *oldD = (vtk_tetgrid *)other->data;
+    vtk_tetgrid *newD = new vtk_tetgrid;
+    newD->nPoints = oldD->nPoints;
+    newD->nCells = oldD->nCells;
+    newD->points = new thrust::device_vector<float>(*oldD->points);
+    newD->cells = new thrust::device_vector<int>(*oldD->cells);
+    newD->scalars = oldD->scalars ?
+      new thrust::device_vector<float>(*oldD->scalars) : NULL;
+    tr->data = (void*)newD;
+    }
+    break;
   default:
     cerr << "I don't have a copy method for " << tr->type << " yet." << endl;
   }
@@ -290,6 +314,63 @@ void CopyToGPU(vtkPolyData *id, vtkPistonDataObject *od)
 
 }
 
+//-----------------------------------------------------------------------------
+void CopyToGPU(vtkUnstructuredGrid *id, vtkPistonDataObject *od)
+{
+  //the caller has checked that all cells are tetrahedra
+  vtkPistonReference *tr = od->GetReference();
+  if (CheckDirty(id, tr))
+    {
+    DeleteData(tr);
+
+    vtk_tetgrid *newD = new vtk_tetgrid;
+    tr->data = (void*)newD;
+
+    int nPoints = id->GetNumberOfPoints();
+    newD->nPoints = nPoints;
+    thrust::host_vector<float> hG(nPoints*3);
+    for (vtkIdType i = 0; i < nPoints; i++)
+      {
+      double *next = id->GetPoint(i);
+      hG[i*3+0] = (float)next[0];
+      hG[i*3+1] = (float)next[1];
+      hG[i*3+2] = (float)next[2];
+      }
+    newD->points = new thrust::device_vector<float>(hG);
+
+    int nCells = id->GetNumberOfCells();
+    newD->nCells = nCells;
+    thrust::host_vector<int> hC(nCells*4);
+    vtkCellArray *cells = id->GetCells();
+    vtkIdType npts = 0;
+    vtkIdType *index = 0;
+    int c = 0;
+    for (cells->InitTraversal(); cells->GetNextCell(npts, index); c++)
+      {
+      for (int j = 0; j < 4; j++)
+        {
+        hC[c*4+j] = (int)index[j];
+        }
+      }
+    newD->cells = new thrust::device_vector<int>(hC);
+
+    vtkFloatArray *inscalars = vtkFloatArray::SafeDownCast(
+      id->GetPointData()->GetScalars()
+      );
+    if (inscalars)
+      {
+      float *raw_ptr = inscalars->GetPointer(0);
+      newD->scalars = new thrust::device_vector<float>(raw_ptr, raw_ptr+nPoints);
+      od->SetScalarsArrayName(inscalars->GetName());
+      }
+    else
+      {
+      newD->scalars = NULL;
+      }
+    }
+  tr->type = VTK_UNSTRUCTURED_GRID;
+}
+
 //-----------------------------------------------------------------------------
 void CopyFromGPU(vtkPistonDataObject *id, vtkImageData *od)
 {
@@ -395,4 +476,63 @@ void CopyFromGPU(vtkPistonDataObject *id, vtkPolyData *od)
     }
 }
 
+//-----------------------------------------------------------------------------
+void CopyFromGPU(vtkPistonDataObject *id, vtkUnstructuredGrid *od)
+{
+  vtkPistonReference *tr = id->GetReference();
+  if (tr->type != VTK_UNSTRUCTURED_GRID || tr->data == NULL)
+    {
+    //type mismatch, don't bother trying
+    return;
+    }
+  if (!CheckDirty(od,tr))
+    {
+    //it hasn't changed, don't recompute
+    return;
+    }
+
+  vtk_tetgrid *gD = (vtk_tetgrid *)tr->data;
+  int nPoints = gD->nPoints;
+  int nCells = gD->nCells;
+
+  //geometry
+  vtkPoints *points = vtkPoints::New();
+  od->SetPoints(points);
+  points->Delete();
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(nPoints);
+  thrust::copy(gD->points->begin(), gD->points->end(),
+               (float*)points->GetVoidPointer(0));
+
+  //topology
+  thrust::host_vector<int> C(nCells*4);
+  thrust::copy(gD->cells->begin(), gD->cells->end(), C.begin());
+  vtkIdTypeArray *cl = vtkIdTypeArray::New();
+  cl->SetNumberOfValues(nCells*5);
+  for (int i = 0; i < nCells; i++)
+    {
+    cl->SetValue(i*5+0, 4);
+    for (int j = 0; j < 4; j++)
+      {
+      cl->SetValue(i*5+j+1, C[i*4+j]);
+      }
+    }
+  vtkCellArray *cells = vtkCellArray::New();
+  cells->SetCells(nCells, cl);
+  cl->Delete();
+  od->SetCells(VTK_TETRA, cells);
+  cells->Delete();
+
+  //attributes
+  if (gD->scalars)
+    {
+    thrust::host_vector<float> V(nPoints);
+    thrust::copy(gD->scalars->begin(), gD->scalars->end(), V.begin());
+    vtkFloatArray *outScalars = makeScalars(&V);
+    outScalars->SetName(id->GetScalarsArrayName());
+    od->GetPointData()->SetScalars(outScalars);
+    outScalars->Delete();
+    }
+}
+
 } //namespace
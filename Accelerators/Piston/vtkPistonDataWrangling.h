@@ -16,7 +16,8 @@
 // .SECTION Description
 // Miscellaneous code that is used in conversion between vtk and piston.
 // The vtk_polydata struct is important as that is how piston's polygonal
-// results get brought back to the CPU.
+// results get brought back to the CPU. The vtk_tetgrid struct keeps
+// tetrahedral unstructured grids on the GPU between filters.
 
 #ifndef vtkPistonDataWrangling_h
 #define vtkPistonDataWrangling_h
@@ -43,6 +44,17 @@ typedef struct
   thrust::device_vector<float> *normals;
 } vtk_polydata;
 
+typedef struct
+{
+  //GPU side representation of a vtkUnstructuredGrid of tetrahedra
+  //the points are shared by the cells, which hold 4 point ids each
+  int nPoints;
+  int nCells;
+  thrust::device_vector<float> *points;
+  thrust::device_vector<int> *cells;
+  thrust::device_vector<float> *scalars;
+} vtk_tetgrid;
+
 struct tuple2float3 :
   thrust::unary_function<thrust::tuple<float, float, float>, float3>
 {
@@ -1,5 +1,9 @@
 #include <thrust/device_vector.h>
 #include <thrust/copy.h>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/scan.h>
+#include <thrust/transform.h>
 #include "vtkgl.h"
 #include <piston/threshold_geometry.h>
 #include <piston/vtk_image3d.h>
@@ -13,12 +17,117 @@ using namespace piston;
 
 namespace vtkpiston {
 
+//-----------------------------------------------------------------------------
+// A tetrahedron passes when the scalars of all its points are in range.
+struct tet_in_range : thrust::unary_function<int, int>
+{
+  const int *cells;
+  const float *scalars;
+  float minvalue;
+  float maxvalue;
+
+  tet_in_range(const int *c, const float *s, float minv, float maxv)
+    : cells(c), scalars(s), minvalue(minv), maxvalue(maxv) {}
+
+  __host__ __device__
+  int operator()(int tet) const
+  {
+    for (int i = 0; i < 4; i++)
+      {
+      float s = scalars[cells[tet*4+i]];
+      if (s < minvalue || s > maxvalue)
+        {
+        return 0;
+        }
+      }
+    return 1;
+  }
+};
+
+struct tet_gather
+{
+  const int *cells;
+  const int *flags;
+  const int *offsets;
+  int *outCells;
+
+  tet_gather(const int *c, const int *f, const int *o, int *oc)
+    : cells(c), flags(f), offsets(o), outCells(oc) {}
+
+  __host__ __device__
+  void operator()(int tet) const
+  {
+    if (flags[tet])
+      {
+      int o = offsets[tet];
+      for (int i = 0; i < 4; i++)
+        {
+        outCells[o*4+i] = cells[tet*4+i];
+        }
+      }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// The passing tetrahedra stay on the GPU as a tetrahedral grid that shares
+// all the points of the input, so that other filters can follow.
+void ExecutePistonThresholdTetrahedra(vtkPistonDataObject *inData,
+                                      float minvalue, float maxvalue,
+                                      vtkPistonDataObject *outData)
+{
+  vtkPistonReference *ti = inData->GetReference();
+  vtk_tetgrid *gpuData = (vtk_tetgrid *)ti->data;
+  if (gpuData->scalars == NULL)
+    {
+    return;
+    }
+  int nCells = gpuData->nCells;
+  const int *cells = thrust::raw_pointer_cast(gpuData->cells->data());
+
+  thrust::device_vector<int> flags(nCells);
+  thrust::transform(thrust::counting_iterator<int>(0),
+                    thrust::counting_iterator<int>(nCells),
+                    flags.begin(),
+                    tet_in_range(cells,
+                      thrust::raw_pointer_cast(gpuData->scalars->data()),
+                      minvalue, maxvalue));
+  thrust::device_vector<int> offsets(nCells);
+  thrust::exclusive_scan(flags.begin(), flags.end(), offsets.begin());
+  int nKept = nCells ? offsets.back() + flags.back() : 0;
+
+  vtkPistonReference *to = outData->GetReference();
+  DeleteData(to);
+
+  to->type = VTK_UNSTRUCTURED_GRID;
+  vtk_tetgrid *newD = new vtk_tetgrid;
+  to->data = (void*)newD;
+  newD->nPoints = gpuData->nPoints;
+  newD->nCells = nKept;
+  newD->points = new thrust::device_vector<float>(*gpuData->points);
+  newD->scalars = new thrust::device_vector<float>(*gpuData->scalars);
+  newD->cells = new thrust::device_vector<int>(nKept*4);
+  outData->SetScalarsArrayName(inData->GetScalarsArrayName());
+
+  thrust::for_each(thrust::counting_iterator<int>(0),
+                   thrust::counting_iterator<int>(nCells),
+                   tet_gather(cells,
+                     thrust::raw_pointer_cast(flags.data()),
+                     thrust::raw_pointer_cast(offsets.data()),
+                     thrust::raw_pointer_cast(newD->cells->data())));
+}
+
+//-----------------------------------------------------------------------------
 // execution method found in vtkPistonThreshold.cu
 void ExecutePistonThreshold(vtkPistonDataObject *inData,
                             float minvalue, float maxvalue,
                             vtkPistonDataObject *outData)
 {
   vtkPistonReference *ti = inData->GetReference();
+  if (ti->type == VTK_UNSTRUCTURED_GRID && ti->data != NULL)
+    {
+    ExecutePistonThresholdTetrahedra(inData, minvalue, maxvalue, outData);
+    return;
+    }
   if (ti->type != VTK_IMAGE_DATA || ti->data == NULL)
     {
     //cerr << "NVM" << endl;
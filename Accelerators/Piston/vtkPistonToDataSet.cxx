@@ -23,12 +23,14 @@
 #include "vtkPolyData.h"
 #include "vtkPistonDataObject.h"
 #include "vtkType.h"
+#include "vtkUnstructuredGrid.h"
 
 //----------------------------------------------------------------------------
 namespace vtkpiston {
   //forward declarations of methods defined in the cuda implementation
   void CopyFromGPU(vtkPistonDataObject *id, vtkImageData *od);
   void CopyFromGPU(vtkPistonDataObject *id, vtkPolyData *od);
+  void CopyFromGPU(vtkPistonDataObject *id, vtkUnstructuredGrid *od);
 }
 
 //----------------------------------------------------------------------------
@@ -126,6 +128,12 @@ int vtkPistonToDataSet::RequestData(vtkInformation *vtkNotUsed(request),
       od->BuildCells();
       }
       break;
+    case VTK_UNSTRUCTURED_GRID:
+      {
+      vtkUnstructuredGrid *od = vtkUnstructuredGrid::GetData(outputVector);
+      vtkpiston::CopyFromGPU(id, od);
+      }
+      break;
     default:
       vtkWarningMacro(<< "I don't have a converter to "
                       << vtkDataObjectTypes::GetClassNameFromTypeId(this->OutputDataSetType)
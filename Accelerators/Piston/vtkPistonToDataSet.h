@@ -38,8 +38,8 @@ public:
   // Description:
   // Changes the output data set type.
   // Range of allowable values are defined in vtkType.h
-  // At the moment only VTK_IMAGE_DATA and VTK_POLY_DATA from those are
-  // implemented.
+  // At the moment only VTK_IMAGE_DATA, VTK_POLY_DATA and
+  // VTK_UNSTRUCTURED_GRID (of tetrahedra) from those are implemented.
   vtkSetMacro(OutputDataSetType, int);
   vtkGetMacro(OutputDataSetType, int);
 
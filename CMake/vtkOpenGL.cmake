@@ -23,7 +23,7 @@ option(VTK_OPENGL_HAS_OSMESA
 option(VTK_USE_OFFSCREEN_EGL
   "Use EGL for OpenGL client API for offscreen rendering." OFF)
 set(VTK_EGL_DEVICE_INDEX 0 CACHE STRING
-  "Index of the EGL device (graphics card) to use.")
+  "Index of the EGL device (graphics card) to use, overridden at run time by the VTK_EGL_DEVICE_INDEX environment variable.")
 
 if (VTK_USE_OFFSCREEN_EGL AND VTK_RENDERING_BACKEND STREQUAL "OpenGL")
   message(FATAL_ERROR "You can use VTK_USE_OFFSCREEN_EGL only for OpenGL2")
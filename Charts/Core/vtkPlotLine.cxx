@@ -52,7 +52,20 @@ bool vtkPlotLine::Paint(vtkContext2D *painter)
   // Draw the line between the points
   painter->ApplyPen(this->Pen);
 
-  if (this->BadPoints && this->BadPoints->GetNumberOfTuples() > 0)
+  float *decimated;
+  vtkIdType numberOfDecimated;
+  unsigned char *colors;
+  if (this->PolyLine &&
+      this->GetDecimatedPoints(painter, true, decimated, numberOfDecimated,
+                               colors))
+    {
+    // draw the pixel columns of a large series
+    if (numberOfDecimated > 1)
+      {
+      painter->DrawPoly(decimated, static_cast<int>(numberOfDecimated));
+      }
+    }
+  else if (this->BadPoints && this->BadPoints->GetNumberOfTuples() > 0)
     {
     // draw lines skipping bad points
     float *points = static_cast<float *>(this->Points->GetVoidPointer(0));
@@ -31,6 +31,10 @@
 #include "vtkCharArray.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkLookupTable.h"
+#include "vtkMatrix3x3.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkTransform2D.h"
 
 #include <vector>
 #include <algorithm>
@@ -61,6 +65,180 @@ public:
   }
 };
 
+// The decimated points of the series, as lines and as markers, for the
+// view they were computed for.
+class vtkPlotPoints::DecimationPIMPL
+{
+public:
+  struct Level
+  {
+    std::vector<float> Points;
+    std::vector<unsigned char> Colors;
+    double View[8];
+    bool Decimated;
+    vtkTimeStamp Time;
+
+    Level() : Decimated(false)
+    {
+      std::fill(this->View, this->View + 8, 0.0);
+    }
+  };
+
+  Level Markers;
+  Level Lines;
+
+  // Whether the x values of the series never decrease, and the bad points
+  // as a mask, updated when the series changes.
+  bool SortedX;
+  std::vector<unsigned char> Bad;
+  vtkTimeStamp DataTime;
+
+  DecimationPIMPL() : SortedX(false) {}
+};
+
+namespace
+{
+// Screens are not wider than this many pixel columns; beyond it, the view is
+// degenerate and the series is drawn in full.
+const vtkIdType VTK_MAX_DECIMATION_CELLS = 1 << 24;
+
+// Lets markers centered outside the axes still show over the edges.
+const int VTK_DECIMATION_MARGIN = 16;
+
+//-----------------------------------------------------------------------------
+class vtkCheckSortedX
+{
+public:
+  const float* Points;
+  vtkSMPThreadLocal<unsigned char> Unsorted;
+
+  vtkCheckSortedX() : Unsorted(0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    unsigned char& unsorted = this->Unsorted.Local();
+    for (vtkIdType i = begin; i < end && !unsorted; ++i)
+      {
+      unsorted = this->Points[2 * i + 2] < this->Points[2 * i];
+      }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Keep the first, lowest, highest and last point of each pixel column of a
+// series sorted along x, which draws the same pixels as the whole series.
+class vtkDecimateLineColumns
+{
+public:
+  const float* Points;
+  vtkIdType NumberOfPoints;
+  double Start;
+  double Width;
+  vtkIdType* Ids;
+
+  vtkIdType LowerBound(double x) const
+  {
+    vtkIdType low = 0;
+    vtkIdType high = this->NumberOfPoints;
+    while (low < high)
+      {
+      vtkIdType middle = low + (high - low) / 2;
+      if (this->Points[2 * middle] < x)
+        {
+        low = middle + 1;
+        }
+      else
+        {
+        high = middle;
+        }
+      }
+    return low;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType c = begin; c < end; ++c)
+      {
+      vtkIdType* ids = this->Ids + 4 * c;
+      vtkIdType first = this->LowerBound(this->Start + c * this->Width);
+      vtkIdType last = this->LowerBound(this->Start + (c + 1) * this->Width);
+      if (first >= last)
+        {
+        ids[0] = ids[1] = ids[2] = ids[3] = -1;
+        continue;
+        }
+      vtkIdType lowest = first;
+      vtkIdType highest = first;
+      for (vtkIdType i = first + 1; i < last; ++i)
+        {
+        if (this->Points[2 * i + 1] < this->Points[2 * lowest + 1])
+          {
+          lowest = i;
+          }
+        else if (this->Points[2 * i + 1] > this->Points[2 * highest + 1])
+          {
+          highest = i;
+          }
+        }
+      ids[0] = first;
+      ids[1] = std::min(lowest, highest);
+      ids[2] = std::max(lowest, highest);
+      ids[3] = last - 1;
+      }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Keep the first point of each pixel, per thread; the lists of the threads
+// are merged afterwards.
+class vtkDecimateMarkers
+{
+public:
+  const float* Points;
+  const unsigned char* Bad;
+  double Origin[2];
+  double Scale[2];
+  vtkIdType Size[2];
+  vtkSMPThreadLocal<std::vector<unsigned char> > Occupied;
+  vtkSMPThreadLocal<std::vector<vtkIdType> > Kept;
+
+  vtkIdType GetCell(vtkIdType i) const
+  {
+    if (this->Bad && this->Bad[i])
+      {
+      return -1;
+      }
+    double x = (this->Points[2 * i] - this->Origin[0]) * this->Scale[0];
+    double y = (this->Points[2 * i + 1] - this->Origin[1]) * this->Scale[1];
+    if (!(x >= 0.0 && x < this->Size[0] && y >= 0.0 && y < this->Size[1]))
+      {
+      return -1;
+      }
+    return static_cast<vtkIdType>(y) * this->Size[0] +
+      static_cast<vtkIdType>(x);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<unsigned char>& occupied = this->Occupied.Local();
+    std::vector<vtkIdType>& kept = this->Kept.Local();
+    if (occupied.empty())
+      {
+      occupied.resize(this->Size[0] * this->Size[1], 0);
+      }
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType cell = this->GetCell(i);
+      if (cell >= 0 && !occupied[cell])
+        {
+        occupied[cell] = 1;
+        kept.push_back(i);
+        }
+      }
+  }
+};
+}
+
 //-----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkPlotPoints)
 
@@ -70,6 +248,9 @@ vtkPlotPoints::vtkPlotPoints()
   this->Points = NULL;
   this->Sorted = NULL;
   this->BadPoints = NULL;
+  this->Decimated = new DecimationPIMPL;
+  this->Decimation = false;
+  this->DecimationThreshold = 100000;
   this->ValidPointMask = NULL;
   this->MarkerStyle = vtkPlotPoints::CIRCLE;
   this->MarkerSize = -1.0;
@@ -93,6 +274,7 @@ vtkPlotPoints::~vtkPlotPoints()
     this->Points = NULL;
     }
   delete this->Sorted;
+  delete this->Decimated;
   if (this->BadPoints)
     {
     this->BadPoints->Delete();
@@ -192,7 +374,20 @@ bool vtkPlotPoints::Paint(vtkContext2D *painter)
       nColorComponents = static_cast<int>(this->Colors->GetNumberOfComponents());
       }
 
-    if (this->BadPoints && this->BadPoints->GetNumberOfTuples() > 0)
+    float *decimated;
+    vtkIdType numberOfDecimated;
+    unsigned char *decimatedColors;
+    if (this->GetDecimatedPoints(painter, false, decimated, numberOfDecimated,
+                                 decimatedColors))
+      {
+      if (numberOfDecimated > 0)
+        {
+        painter->DrawMarkers(this->MarkerStyle, false, decimated,
+                             static_cast<int>(numberOfDecimated),
+                             colors ? decimatedColors : 0, nColorComponents);
+        }
+      }
+    else if (this->BadPoints && this->BadPoints->GetNumberOfTuples() > 0)
       {
       vtkIdType lastGood = 0;
 
@@ -274,6 +469,192 @@ bool vtkPlotPoints::Paint(vtkContext2D *painter)
   return true;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkPlotPoints::GetDecimatedPoints(vtkContext2D *painter, bool lines,
+                                       float *&decimated,
+                                       vtkIdType &numberOfPoints,
+                                       unsigned char *&colors)
+{
+  decimated = 0;
+  numberOfPoints = 0;
+  colors = 0;
+  vtkTransform2D *transform = painter->GetTransform();
+  if (!this->Decimation || !this->Points || !transform ||
+      this->Points->GetNumberOfPoints() <= this->DecimationThreshold)
+    {
+    return false;
+    }
+
+  const float *points = static_cast<float *>(this->Points->GetVoidPointer(0));
+  const vtkIdType n = this->Points->GetNumberOfPoints();
+  DecimationPIMPL *d = this->Decimated;
+  if (d->DataTime < this->BuildTime)
+    {
+    vtkCheckSortedX check;
+    check.Points = points;
+    vtkSMPTools::For(0, n - 1, check);
+    d->SortedX = true;
+    for (vtkSMPThreadLocal<unsigned char>::iterator it =
+         check.Unsorted.begin(); it != check.Unsorted.end(); ++it)
+      {
+      d->SortedX = d->SortedX && !*it;
+      }
+    d->Bad.clear();
+    if (this->BadPoints && this->BadPoints->GetNumberOfTuples() > 0)
+      {
+      d->Bad.resize(n, 0);
+      for (vtkIdType i = 0; i < this->BadPoints->GetNumberOfTuples(); ++i)
+        {
+        d->Bad[this->BadPoints->GetValue(i)] = 1;
+        }
+      }
+    d->DataTime.Modified();
+    }
+  // Lines only skip bad points by breaking the polyline, which the
+  // decimated line does not do.
+  if (lines && (!d->SortedX || !d->Bad.empty()))
+    {
+    return false;
+    }
+
+  // The view is the transform to pixels and the visible range.
+  double bounds[4];
+  if (this->XAxis && this->YAxis)
+    {
+    bounds[0] = this->XAxis->GetMinimum();
+    bounds[1] = this->XAxis->GetMaximum();
+    bounds[2] = this->YAxis->GetMinimum();
+    bounds[3] = this->YAxis->GetMaximum();
+    }
+  else
+    {
+    this->CalculateBounds(bounds);
+    }
+  const double *m = transform->GetMatrix()->GetData();
+  double view[8] = { m[0], m[2], m[4], m[5],
+                     std::min(bounds[0], bounds[1]),
+                     std::max(bounds[0], bounds[1]),
+                     std::min(bounds[2], bounds[3]),
+                     std::max(bounds[2], bounds[3]) };
+
+  DecimationPIMPL::Level &level = lines ? d->Lines : d->Markers;
+  if (level.Time < this->BuildTime ||
+      !std::equal(view, view + 8, level.View))
+    {
+    std::copy(view, view + 8, level.View);
+    level.Time.Modified();
+    level.Points.clear();
+    level.Colors.clear();
+    level.Decimated = false;
+
+    std::vector<vtkIdType> kept;
+    const double scaleX = fabs(m[0]);
+    const double scaleY = fabs(m[4]);
+    const double columns = (view[5] - view[4]) * scaleX;
+    const double rows = (view[7] - view[6]) * scaleY;
+    if (lines && columns >= 0.0 && columns < VTK_MAX_DECIMATION_CELLS &&
+        scaleX > 0.0)
+      {
+      vtkDecimateLineColumns decimate;
+      decimate.Points = points;
+      decimate.NumberOfPoints = n;
+      decimate.Start = view[4];
+      decimate.Width = 1.0 / scaleX;
+      vtkIdType numColumns = static_cast<vtkIdType>(columns) + 1;
+      std::vector<vtkIdType> ids(4 * numColumns);
+      decimate.Ids = &ids[0];
+      vtkSMPTools::For(0, numColumns, decimate);
+
+      // Extend the line to the points just outside the visible range.
+      vtkIdType first = decimate.LowerBound(view[4]);
+      vtkIdType last = decimate.LowerBound(view[4] + numColumns / scaleX);
+      if (first > 0)
+        {
+        kept.push_back(first - 1);
+        }
+      for (size_t i = 0; i < ids.size(); ++i)
+        {
+        if (ids[i] >= 0 && (kept.empty() || ids[i] != kept.back()))
+          {
+          kept.push_back(ids[i]);
+          }
+        }
+      if (last < n)
+        {
+        kept.push_back(last);
+        }
+      level.Decimated = true;
+      }
+    else if (!lines && columns >= 0.0 && rows >= 0.0 &&
+             (columns + 2 * VTK_DECIMATION_MARGIN + 1) *
+             (rows + 2 * VTK_DECIMATION_MARGIN + 1) < VTK_MAX_DECIMATION_CELLS &&
+             scaleX > 0.0 && scaleY > 0.0)
+      {
+      vtkDecimateMarkers decimate;
+      decimate.Points = points;
+      decimate.Bad = d->Bad.empty() ? 0 : &d->Bad[0];
+      decimate.Origin[0] = view[4] - VTK_DECIMATION_MARGIN / scaleX;
+      decimate.Origin[1] = view[6] - VTK_DECIMATION_MARGIN / scaleY;
+      decimate.Scale[0] = scaleX;
+      decimate.Scale[1] = scaleY;
+      decimate.Size[0] =
+        static_cast<vtkIdType>(columns) + 2 * VTK_DECIMATION_MARGIN + 1;
+      decimate.Size[1] =
+        static_cast<vtkIdType>(rows) + 2 * VTK_DECIMATION_MARGIN + 1;
+      vtkSMPTools::For(0, n, decimate);
+
+      std::vector<unsigned char> occupied(
+        decimate.Size[0] * decimate.Size[1], 0);
+      for (vtkSMPThreadLocal<std::vector<vtkIdType> >::iterator it =
+           decimate.Kept.begin(); it != decimate.Kept.end(); ++it)
+        {
+        for (size_t i = 0; i < (*it).size(); ++i)
+          {
+          vtkIdType cell = decimate.GetCell((*it)[i]);
+          if (!occupied[cell])
+            {
+            occupied[cell] = 1;
+            kept.push_back((*it)[i]);
+            }
+          }
+        }
+      // Draw the markers in the order of the series.
+      std::sort(kept.begin(), kept.end());
+      level.Decimated = true;
+      }
+
+    level.Points.resize(2 * kept.size());
+    for (size_t i = 0; i < kept.size(); ++i)
+      {
+      level.Points[2 * i] = points[2 * kept[i]];
+      level.Points[2 * i + 1] = points[2 * kept[i] + 1];
+      }
+    if (this->Colors && !lines)
+      {
+      const int nc = this->Colors->GetNumberOfComponents();
+      const unsigned char *c = this->Colors->GetPointer(0);
+      level.Colors.resize(nc * kept.size());
+      for (size_t i = 0; i < kept.size(); ++i)
+        {
+        std::copy(c + nc * kept[i], c + nc * (kept[i] + 1),
+                  &level.Colors[nc * i]);
+        }
+      }
+    }
+
+  if (!level.Decimated)
+    {
+    return false;
+    }
+  if (!level.Points.empty())
+    {
+    decimated = &level.Points[0];
+    numberOfPoints = static_cast<vtkIdType>(level.Points.size() / 2);
+    colors = level.Colors.empty() ? 0 : &level.Colors[0];
+    }
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 bool vtkPlotPoints::PaintLegend(vtkContext2D *painter, const vtkRectf& rect,
                                 int)
@@ -1040,4 +1421,7 @@ vtkStdString vtkPlotPoints::GetColorArrayName()
 void vtkPlotPoints::PrintSelf(ostream &os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "Decimation: " << this->Decimation << endl;
+  os << indent << "DecimationThreshold: " << this->DecimationThreshold
+     << endl;
 }
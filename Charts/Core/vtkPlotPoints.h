@@ -153,6 +153,24 @@ public:
   vtkGetMacro(ValidPointMaskName, vtkStdString)
   vtkSetMacro(ValidPointMaskName, vtkStdString)
 
+  // Description:
+  // Turn on/off the decimation of large series to the resolution of the
+  // screen. Series with more than DecimationThreshold points are then drawn
+  // as the first, last, lowest and highest point of each pixel column for
+  // lines whose x values are sorted, and as one marker per pixel for
+  // scatter plots. The decimated points are cached until the series or the
+  // view changes. Selection and GetNearestPoint() always use all the points.
+  // Default is off.
+  vtkSetMacro(Decimation, bool);
+  vtkGetMacro(Decimation, bool);
+  vtkBooleanMacro(Decimation, bool);
+
+  // Description:
+  // Get/set the number of points above which a series is decimated.
+  // Default is 100000.
+  vtkSetClampMacro(DecimationThreshold, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(DecimationThreshold, vtkIdType);
+
 //BTX
 protected:
   vtkPlotPoints();
@@ -189,6 +207,13 @@ protected:
   // Create the sorted point list if necessary.
   void CreateSortedPoints();
 
+  // Description:
+  // Get the points to draw at the resolution of the painter, as lines or as
+  // markers, with their colors if the points are colored. Returns false if
+  // the series is not decimated and all its points should be drawn.
+  bool GetDecimatedPoints(vtkContext2D *painter, bool lines, float *&points,
+                          vtkIdType &numberOfPoints, unsigned char *&colors);
+
   // Description:
   // Store a well packed set of XY coordinates for this data series.
   vtkPoints2D *Points;
@@ -204,6 +229,13 @@ protected:
   // pair that has an infinity, -infinity or not a number value.
   vtkIdTypeArray* BadPoints;
 
+  // Description:
+  // The decimated lines and markers, see GetDecimatedPoints().
+  class DecimationPIMPL;
+  DecimationPIMPL* Decimated;
+  bool Decimation;
+  vtkIdType DecimationThreshold;
+
   // Description:
   // Array which marks valid points in the array. If NULL (the default), all
   // points in the input array are considered valid.
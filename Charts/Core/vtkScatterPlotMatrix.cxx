@@ -30,8 +30,13 @@
 #include "vtkAnnotationLink.h"
 #include "vtkObjectFactory.h"
 #include "vtkBrush.h"
+#include "vtkPlotHistogram2D.h"
 #include "vtkPlotPoints.h"
 #include "vtkPlotPoints3D.h"
+#include "vtkImageData.h"
+#include "vtkLookupTable.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkCommand.h"
 #include "vtkTextProperty.h"
 #include "vtkContextScene.h"
@@ -43,6 +48,8 @@
 #include "vtkChartXYZ.h"
 
 // STL includes
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <cassert>
 #include <vector>
@@ -50,7 +57,7 @@
 class vtkScatterPlotMatrix::PIMPL
 {
 public:
-  PIMPL() : VisibleColumnsModified(true), BigChart(NULL),
+  PIMPL() : VisibleColumnsModified(true), DensityBins(0), BigChart(NULL),
     AnimationCallbackInitialized(false), TimerId(0),
     TimerCallbackInitialized(false)
   {
@@ -172,8 +179,40 @@ public:
       }
     }
 
+  // Color the density images from transparent to the scatter plot color.
+  void UpdateDensityLookupTable(double maximum)
+    {
+    vtkColor4ub color =
+      this->ChartSettings[vtkScatterPlotMatrix::SCATTERPLOT]
+      ->PlotPen->GetColorObject();
+    vtkLookupTable *lut = this->DensityLookupTable.GetPointer();
+    lut->SetNumberOfTableValues(256);
+    for (int i = 0; i < 256; ++i)
+      {
+      double t = i / 255.0;
+      lut->SetTableValue(i,
+                         1.0 - t * (1.0 - color[0] / 255.0),
+                         1.0 - t * (1.0 - color[1] / 255.0),
+                         1.0 - t * (1.0 - color[2] / 255.0),
+                         i == 0 ? 0.0 : 0.25 + 0.75 * t);
+      }
+    if (maximum >= 0.0)
+      {
+      lut->SetTableRange(0.0, std::max(maximum, 1e-6));
+      }
+    }
+
   vtkNew<vtkTable> Histogram;
   bool VisibleColumnsModified;
+
+  // The density images of the pairs of visible columns, keyed on the names
+  // of their x and y columns, and what they were computed from.
+  typedef std::pair<std::string, std::string> DensityKey;
+  std::map<DensityKey, vtkSmartPointer<vtkImageData> > DensityImages;
+  std::vector<std::string> DensityColumns;
+  int DensityBins;
+  vtkTimeStamp DensityTime;
+  vtkNew<vtkLookupTable> DensityLookupTable;
   vtkWeakPointer<vtkChart> BigChart;
   vtkNew<vtkAnnotationLink> Link;
 
@@ -279,6 +318,86 @@ bool PopulateHistograms(vtkTable *input, vtkTable *output, vtkStringArray *s,
   return true;
 }
 
+// Bin the values of a column between min and max, 255 marking the values
+// out of range or not a number.
+template <typename T>
+class BinColumnFunctor
+{
+public:
+  const T *Values;
+  unsigned char *Bins;
+  double Min;
+  double Scale;
+  int NumberOfBins;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      double v = (static_cast<double>(this->Values[i]) - this->Min) *
+        this->Scale;
+      this->Bins[i] = (v >= 0.0 && v < this->NumberOfBins) ?
+        static_cast<unsigned char>(v) : 255;
+      }
+  }
+};
+
+template <typename T>
+void BinColumn(const T *values, vtkIdType numberOfRows, double min,
+               double max, int numberOfBins, unsigned char *bins)
+{
+  BinColumnFunctor<T> functor;
+  functor.Values = values;
+  functor.Bins = bins;
+  functor.Min = min;
+  functor.Scale = max > min ? numberOfBins / (max - min) : 0.0;
+  functor.NumberOfBins = numberOfBins;
+  vtkSMPTools::For(0, numberOfRows, functor);
+}
+
+// Count the rows falling in each pair of bins of pairs of binned columns,
+// each thread filling the images of its own pairs. The images hold the
+// logarithm of the counts, which have a large dynamic range.
+class CountPairsFunctor
+{
+public:
+  const unsigned char *Bins;
+  vtkIdType NumberOfRows;
+  int NumberOfBins;
+  const int *PairX;
+  const int *PairY;
+  double * const *Images;
+  vtkSMPThreadLocal<double> Maximum;
+
+  CountPairsFunctor() : Maximum(0.0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double &maximum = this->Maximum.Local();
+    const int nb = this->NumberOfBins;
+    std::vector<vtkIdType> counts(nb * nb);
+    for (vtkIdType p = begin; p < end; ++p)
+      {
+      const unsigned char *x = this->Bins + this->PairX[p] * this->NumberOfRows;
+      const unsigned char *y = this->Bins + this->PairY[p] * this->NumberOfRows;
+      std::fill(counts.begin(), counts.end(), 0);
+      for (vtkIdType i = 0; i < this->NumberOfRows; ++i)
+        {
+        if (x[i] != 255 && y[i] != 255)
+          {
+          ++counts[y[i] * nb + x[i]];
+          }
+        }
+      double *image = this->Images[p];
+      for (int k = 0; k < nb * nb; ++k)
+        {
+        image[k] = log10(1.0 + counts[k]);
+        maximum = std::max(maximum, image[k]);
+        }
+      }
+  }
+};
+
 bool MoveColumn(vtkStringArray* visCols, int fromCol, int toCol)
 {
   if(!visCols || visCols->GetNumberOfTuples() == 0
@@ -353,7 +472,8 @@ bool MoveColumn(vtkStringArray* visCols, int fromCol, int toCol)
 vtkStandardNewMacro(vtkScatterPlotMatrix)
 
 vtkScatterPlotMatrix::vtkScatterPlotMatrix()
-  : NumberOfBins(10), NumberOfFrames(25)
+  : NumberOfBins(10), DensityPlots(false), NumberOfDensityBins(64),
+    NumberOfFrames(25)
 {
   this->Private = new PIMPL;
   this->TitleProperties = vtkSmartPointer<vtkTextProperty>::New();
@@ -379,6 +499,11 @@ void vtkScatterPlotMatrix::Update()
     this->UpdateLayout();
     this->Private->VisibleColumnsModified = false;
     }
+  else
+    {
+    // Recompute the density images if the input changed.
+    this->UpdateDensityImages();
+    }
 }
 
 bool vtkScatterPlotMatrix::Paint(vtkContext2D *painter)
@@ -515,6 +640,7 @@ bool vtkScatterPlotMatrix::SetActivePlot(const vtkVector2i &pos)
                                 ->MarkerSize);
       plotPoints->SetMarkerStyle(this->Private->ChartSettings[ACTIVEPLOT]
                                  ->MarkerStyle);
+      plotPoints->SetDecimation(this->DensityPlots);
       // Set background color.
       this->Private->BigChart->SetBackgroundBrush(
             this->Private->ChartSettings[ACTIVEPLOT]
@@ -999,6 +1125,136 @@ void vtkScatterPlotMatrix::SetNumberOfBins(int numberOfBins)
     }
 }
 
+void vtkScatterPlotMatrix::SetDensityPlots(bool density)
+{
+  if (this->DensityPlots != density)
+    {
+    this->DensityPlots = density;
+    this->Private->VisibleColumnsModified = true;
+    this->Modified();
+    }
+}
+
+void vtkScatterPlotMatrix::SetNumberOfDensityBins(int numberOfBins)
+{
+  numberOfBins = std::min(std::max(numberOfBins, 2), 255);
+  if (this->NumberOfDensityBins != numberOfBins)
+    {
+    this->NumberOfDensityBins = numberOfBins;
+    this->UpdateDensityImages();
+    this->Modified();
+    }
+}
+
+void vtkScatterPlotMatrix::UpdateDensityImages()
+{
+  PIMPL *d = this->Private;
+  if (!this->DensityPlots || !this->Input)
+    {
+    return;
+    }
+  std::vector<std::string> columns;
+  for (vtkIdType i = 0; i < this->VisibleColumns->GetNumberOfTuples(); ++i)
+    {
+    columns.push_back(this->VisibleColumns->GetValue(i));
+    }
+  if (columns == d->DensityColumns &&
+      this->NumberOfDensityBins == d->DensityBins &&
+      this->Input->GetMTime() <= d->DensityTime)
+    {
+    return;
+    }
+  d->DensityColumns = columns;
+  d->DensityBins = this->NumberOfDensityBins;
+  d->DensityTime.Modified();
+
+  // Bin each column once, over the range of its axes.
+  const int numBins = this->NumberOfDensityBins;
+  const vtkIdType numRows = this->Input->GetNumberOfRows();
+  const int numColumns = static_cast<int>(columns.size());
+  std::vector<unsigned char> bins(numColumns * numRows);
+  std::vector<bool> binned(numColumns, false);
+  for (int c = 0; c < numColumns; ++c)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(
+      this->Input->GetColumnByName(columns[c].c_str()));
+    if (!array || array->GetNumberOfComponents() != 1 ||
+        d->ColumnSettings.find(columns[c]) == d->ColumnSettings.end())
+      {
+      continue;
+      }
+    PIMPL::ColumnSetting &setting = d->ColumnSettings[columns[c]];
+    switch (array->GetDataType())
+      {
+      vtkTemplateMacro(
+        BinColumn(static_cast<VTK_TT*>(array->GetVoidPointer(0)), numRows,
+                  setting.min, setting.max, numBins, &bins[c * numRows]));
+      }
+    binned[c] = true;
+    }
+
+  // The scatter plots show the columns before the diagonal along x, and
+  // those after along y. Images are reused for the pairs still shown.
+  std::vector<int> pairX;
+  std::vector<int> pairY;
+  std::vector<double*> images;
+  std::map<PIMPL::DensityKey, vtkSmartPointer<vtkImageData> > densityImages;
+  for (int x = 0; x < numColumns; ++x)
+    {
+    for (int y = x + 1; y < numColumns; ++y)
+      {
+      if (!binned[x] || !binned[y])
+        {
+        continue;
+        }
+      PIMPL::DensityKey key(columns[x], columns[y]);
+      vtkSmartPointer<vtkImageData> image = d->DensityImages[key];
+      if (!image)
+        {
+        image = vtkSmartPointer<vtkImageData>::New();
+        }
+      PIMPL::ColumnSetting &xSetting = d->ColumnSettings[columns[x]];
+      PIMPL::ColumnSetting &ySetting = d->ColumnSettings[columns[y]];
+      image->SetExtent(0, numBins - 1, 0, numBins - 1, 0, 0);
+      image->SetOrigin(xSetting.min, ySetting.min, 0.0);
+      image->SetSpacing((xSetting.max - xSetting.min) / numBins,
+                        (ySetting.max - ySetting.min) / numBins, 1.0);
+      image->AllocateScalars(VTK_DOUBLE, 1);
+      pairX.push_back(x);
+      pairY.push_back(y);
+      images.push_back(static_cast<double*>(image->GetScalarPointer()));
+      densityImages[key] = image;
+      }
+    }
+  d->DensityImages.swap(densityImages);
+  if (images.empty())
+    {
+    return;
+    }
+
+  CountPairsFunctor count;
+  count.Bins = &bins[0];
+  count.NumberOfRows = numRows;
+  count.NumberOfBins = numBins;
+  count.PairX = &pairX[0];
+  count.PairY = &pairY[0];
+  count.Images = &images[0];
+  vtkSMPTools::For(0, static_cast<vtkIdType>(images.size()), count);
+
+  double maximum = 0.0;
+  for (vtkSMPThreadLocal<double>::iterator it = count.Maximum.begin();
+       it != count.Maximum.end(); ++it)
+    {
+    maximum = std::max(maximum, *it);
+    }
+  d->UpdateDensityLookupTable(maximum);
+  for (std::map<PIMPL::DensityKey, vtkSmartPointer<vtkImageData> >::iterator
+       it = d->DensityImages.begin(); it != d->DensityImages.end(); ++it)
+    {
+    it->second->Modified();
+    }
+}
+
 void vtkScatterPlotMatrix::SetPlotColor(int plotType, const vtkColor4ub& color)
 {
   if(plotType >= 0 && plotType < NOPLOT)
@@ -1006,6 +1262,10 @@ void vtkScatterPlotMatrix::SetPlotColor(int plotType, const vtkColor4ub& color)
     if (plotType == ACTIVEPLOT || plotType == SCATTERPLOT)
       {
       this->Private->ChartSettings[plotType]->PlotPen->SetColor(color);
+      if (plotType == SCATTERPLOT)
+        {
+        this->Private->UpdateDensityLookupTable(-1.0);
+        }
       }
     else
       {
@@ -1371,6 +1631,9 @@ void vtkScatterPlotMatrix::UpdateLayout()
   // big chart.
   int n = this->Size.GetX();
   this->UpdateAxes();
+  this->Private->DensityImages.clear();
+  this->Private->DensityColumns.clear();
+  this->UpdateDensityImages();
   this->Private->BigChart3D->SetAnnotationLink(this->Private->Link.GetPointer());
   for (int i = 0; i < n; ++i)
     {
@@ -1390,6 +1653,19 @@ void vtkScatterPlotMatrix::UpdateLayout()
         chart->SetActionToButton(vtkChart::PAN, -1);
         chart->SetActionToButton(vtkChart::ZOOM, -1);
         chart->SetActionToButton(vtkChart::SELECT, -1);
+        std::map<PIMPL::DensityKey, vtkSmartPointer<vtkImageData> >::iterator
+          density = this->Private->DensityImages.find(
+            PIMPL::DensityKey(column, row));
+        if (density != this->Private->DensityImages.end())
+          {
+          // Draw the 2D histogram of the two columns.
+          vtkNew<vtkPlotHistogram2D> plot;
+          plot->SetInputData(density->second);
+          plot->SetTransferFunction(
+            this->Private->DensityLookupTable.GetPointer());
+          chart->AddPlot(plot.GetPointer());
+          continue;
+          }
         vtkPlot *plot = chart->AddPlot(vtkChart::POINTS);
         plot->SetInputData(this->Input.GetPointer(), column, row);
         plot->SetPen(this->Private->ChartSettings[SCATTERPLOT]
@@ -1916,6 +2192,8 @@ void vtkScatterPlotMatrix::PrintSelf(ostream &os, vtkIndent indent)
   Superclass::PrintSelf(os, indent);
 
   os << indent << "NumberOfBins: " << this->NumberOfBins << endl;
+  os << indent << "DensityPlots: " << this->DensityPlots << endl;
+  os << indent << "NumberOfDensityBins: " << this->NumberOfDensityBins << endl;
   os << indent << "Title: " << this->Title << endl;
   os << indent << "SelectionMode: " << this->SelectionMode << endl;
 }
@@ -121,6 +121,22 @@ public:
   // plot matrix. The default value is 10.
   virtual int GetNumberOfBins() const { return this->NumberOfBins; }
 
+  // Description:
+  // Set/get whether the scatter plots are drawn as density images, the 2D
+  // histograms of their pair of columns, rather than as one marker per row.
+  // The histograms of all the pairs of visible columns are computed in
+  // parallel and kept until the input or the visible columns change. The
+  // active plot still shows the points, decimated to the screen resolution.
+  // The default is false.
+  void SetDensityPlots(bool density);
+  bool GetDensityPlots() const { return this->DensityPlots; }
+
+  // Description:
+  // Set/get the number of bins along each axis of the density images,
+  // between 2 and 255. The default value is 64.
+  void SetNumberOfDensityBins(int numberOfBins);
+  int GetNumberOfDensityBins() const { return this->NumberOfDensityBins; }
+
   // Description:
   // Set the color for the specified plotType.
   void SetPlotColor(int plotType, const vtkColor4ub& color);
@@ -359,6 +375,10 @@ protected:
   // The number of bins in the histograms.
   int NumberOfBins;
 
+  // Whether scatter plots are density images, and their number of bins.
+  bool DensityPlots;
+  int NumberOfDensityBins;
+
   // The title of the scatter plot matrix.
   vtkStdString Title;
   vtkSmartPointer<vtkTextProperty> TitleProperties;
@@ -379,6 +399,10 @@ private:
 
   // Go through the process of calculating axis ranges, etc...
   void UpdateAxes();
+
+  // Compute the density images of the visible columns if they are out of
+  // date.
+  void UpdateDensityImages();
   void ApplyAxisSetting(vtkChart *chart, const vtkStdString &x,
                         const vtkStdString &y);
 };
@@ -56,3 +56,21 @@ int vtkSMPTools::GetEstimatedNumberOfThreads()
 {
   return kaapic_get_concurrency();
 }
+
+//--------------------------------------------------------------------------------
+void vtk::detail::smp::vtkSMPTools_Impl_BeginScope(vtkSMPToolsScopeState&,
+                                                   void*&)
+{
+}
+
+//--------------------------------------------------------------------------------
+void vtk::detail::smp::vtkSMPTools_Impl_EndScope(vtkSMPToolsScopeState&,
+                                                 void*)
+{
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPTools::GetThreadIndex()
+{
+  return kaapi_get_self_kid();
+}
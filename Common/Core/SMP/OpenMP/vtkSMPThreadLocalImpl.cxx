@@ -14,6 +14,7 @@
 =========================================================================*/
 
 #include "vtkSMPThreadLocalImpl.h"
+#include "vtkSMPToolsScopeInternal.h"
 
 #include <omp.h>
 
@@ -22,30 +23,17 @@
 namespace detail
 {
 
-static ThreadIdType GetThreadId()
+// 0 marks empty slots
+inline ThreadIdType GetThreadId(int threadIndex)
 {
-  static int threadPrivateData;
-#pragma omp threadprivate(threadPrivateData)
-  return &threadPrivateData;
+  return static_cast<ThreadIdType>(threadIndex) + 1u;
 }
 
 
-// 32 bit FNV-1a hash function
+// Thread ids are dense, they are used as their own hash.
 inline HashType GetHash(ThreadIdType id)
 {
-  const HashType offset_basis = 2166136261u;
-  const HashType FNV_prime = 16777619u;
-
-  unsigned char *bp = reinterpret_cast<unsigned char*>(&id);
-  unsigned char *be = bp + sizeof(id);
-  HashType hval = offset_basis;
-  while (bp < be)
-    {
-    hval ^= static_cast<HashType>(*bp++);
-    hval *= FNV_prime;
-    }
-
-  return hval;
+  return static_cast<HashType>(id);
 }
 
 
@@ -244,7 +232,12 @@ ThreadSpecific::~ThreadSpecific()
 
 StoragePointerType& ThreadSpecific::GetStorage()
 {
-  ThreadIdType threadId = GetThreadId();
+  return this->GetStorage(vtk::detail::smp::vtkSMPToolsGetThreadIndex());
+}
+
+StoragePointerType& ThreadSpecific::GetStorage(int threadIndex)
+{
+  ThreadIdType threadId = GetThreadId(threadIndex);
   size_t hash = GetHash(threadId);
 
   Slot *slot = NULL;
@@ -36,7 +36,9 @@ void vtkSMPTools::Initialize(int numThreads)
 
 int vtkSMPTools::GetEstimatedNumberOfThreads()
 {
-  return vtk::detail::smp::GetNumberOfThreads();
+  int scopeThreads = vtkSMPTools::GetScopeNumberOfThreads();
+  return scopeThreads > 0 ? scopeThreads :
+    vtk::detail::smp::GetNumberOfThreads();
 }
 
 int vtk::detail::smp::GetNumberOfThreads()
@@ -49,15 +51,81 @@ void vtk::detail::smp::vtkSMPTools_Impl_For_OpenMP(vtkIdType first,
   vtkIdType last, vtkIdType grain, ExecuteFunctorPtrType functorExecuter,
   void *functor)
 {
+  const vtkSMPToolsScopeState parent = vtkSMPToolsGetScopeState();
+  int numThreads = parent.NumberOfThreads > 0 ? parent.NumberOfThreads :
+    omp_get_max_threads();
   if (grain <= 0)
     {
-    vtkIdType estimateGrain = (last - first)/(omp_get_max_threads() * 4);
+    vtkIdType estimateGrain = (last - first)/(numThreads * 4);
     grain = (estimateGrain > 0) ? estimateGrain : 1;
     }
 
-# pragma omp parallel for schedule(runtime)
+# pragma omp parallel for schedule(runtime) num_threads(numThreads)
   for (vtkIdType from = first; from < last; from += grain)
     {
+    vtkSMPToolsWorkerScope worker(parent);
     functorExecuter(functor, from, grain, last);
     }
 }
+
+void vtk::detail::smp::vtkSMPTools_Impl_Blocks_OpenMP(
+  ExecuteBlockStagePtrType stageExecuter, void *algorithm, bool finalPass)
+{
+  const vtkSMPToolsScopeState parent = vtkSMPToolsGetScopeState();
+  int numThreads = parent.NumberOfThreads > 0 ? parent.NumberOfThreads :
+    omp_get_max_threads();
+
+# pragma omp parallel num_threads(numThreads)
+  {
+  vtkSMPToolsWorkerScope worker(parent);
+  vtkIdType numBlocks = omp_get_num_threads();
+  vtkIdType block = omp_get_thread_num();
+# pragma omp single
+  stageExecuter(algorithm, vtkSMPTools_PrepareBlocks, 0, numBlocks);
+
+  stageExecuter(algorithm, vtkSMPTools_PartialBlock, block, numBlocks);
+# pragma omp barrier
+
+# pragma omp single
+  stageExecuter(algorithm, vtkSMPTools_CombineBlocks, 0, numBlocks);
+
+  if (finalPass)
+    {
+    stageExecuter(algorithm, vtkSMPTools_FinalBlock, block, numBlocks);
+    }
+  }
+}
+
+// OpenMP only nests parallel regions up to its maximum number of active
+// levels. This setting is global to the process, so it is only changed by
+// scopes entered outside of a parallel region.
+void vtk::detail::smp::vtkSMPTools_Impl_BeginScope(
+  vtkSMPToolsScopeState& state, void*& backendData)
+{
+  if (state.NestedParallelism && !omp_in_parallel())
+    {
+    int levels = omp_get_max_active_levels();
+    if (levels < VTK_INT_MAX)
+      {
+      backendData = new int(levels);
+      omp_set_max_active_levels(VTK_INT_MAX);
+      }
+    }
+}
+
+void vtk::detail::smp::vtkSMPTools_Impl_EndScope(vtkSMPToolsScopeState&,
+                                                 void* backendData)
+{
+  if (backendData)
+    {
+    int* levels = static_cast<int*>(backendData);
+    omp_set_max_active_levels(*levels);
+    delete levels;
+    }
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPTools::GetThreadIndex()
+{
+  return vtk::detail::smp::vtkSMPToolsGetThreadIndex();
+}
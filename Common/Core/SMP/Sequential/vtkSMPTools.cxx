@@ -26,3 +26,21 @@ int vtkSMPTools::GetEstimatedNumberOfThreads()
 {
   return 1;
 }
+
+//--------------------------------------------------------------------------------
+void vtk::detail::smp::vtkSMPTools_Impl_BeginScope(vtkSMPToolsScopeState&,
+                                                   void*&)
+{
+}
+
+//--------------------------------------------------------------------------------
+void vtk::detail::smp::vtkSMPTools_Impl_EndScope(vtkSMPToolsScopeState&,
+                                                 void*)
+{
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPTools::GetThreadIndex()
+{
+  return 0;
+}
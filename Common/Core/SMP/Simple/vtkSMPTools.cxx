@@ -15,6 +15,9 @@
 
 #include "vtkSMPTools.h"
 
+#include "vtkConditionVariable.h"
+#include "vtkCriticalSection.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 
 #include <pthread.h>
@@ -59,6 +62,352 @@ VTKCOMMONCORE_EXPORT std::vector<vtkMultiThreaderIDType>& vtkSMPToolsGetThreadId
   return vtkSMPToolsThreadIds;
 }
 
+//--------------------------------------------------------------------------------
+// Persistent thread pool.
+//
+// The pool keeps numThreads - 1 threads alive between calls; the thread
+// calling For() is thread 0 of every loop, so vtkSMPThreadLocal indices
+// stay in [0, numThreads). Each participating thread owns a range of the
+// loop, initially an equal part of it. It takes chunks from the front of its
+// range and, once the range is empty, steals the back half of the range of
+// another thread, so that irregular workloads stay balanced without a fine
+// static split. When no grain is given, chunks are a fraction of what is
+// left in the range: large at first to limit locking, small at the end.
+namespace
+{
+using vtk::detail::smp::vtkSMPToolsExecuteRangePtr;
+using vtk::detail::smp::vtkSMPToolsScopeState;
+
+// Fraction of its remaining range a thread takes at once without grain.
+const vtkIdType vtkSMPToolsChunkDivisor = 8;
+// Lower bound of the number of chunks per thread without grain.
+const vtkIdType vtkSMPToolsChunksPerThread = 1024;
+
+struct vtkSMPToolsWorkRange
+{
+  vtkSimpleCriticalSection Lock;
+  vtkIdType Begin;
+  vtkIdType End;
+  // Owned by different threads
+  char Padding[VTK_SMP_CACHE_LINE_SIZE];
+};
+
+struct vtkSMPToolsJob
+{
+  vtkSMPToolsExecuteRangePtr Execute;
+  void *Functor;
+  vtkIdType Grain;
+  vtkIdType MinimumChunk;
+  int NumberOfThreads;
+  const vtkSMPToolsScopeState *State;
+};
+
+class vtkSMPToolsThreadPool
+{
+public:
+  vtkSMPToolsThreadPool(int numThreads);
+  ~vtkSMPToolsThreadPool();
+
+  int GetNumberOfThreads() const
+    {
+      return this->NumberOfThreads;
+    }
+
+  // Execute [first, last) with job.NumberOfThreads threads, including the
+  // calling thread.
+  void Run(vtkIdType first, vtkIdType last, vtkSMPToolsJob& job);
+
+private:
+  struct WorkerInfo
+  {
+    vtkSMPToolsThreadPool *Pool;
+    int Index;
+  };
+
+  static VTK_THREAD_RETURN_TYPE WorkerMain(void *arg);
+  void WorkerLoop(int index);
+  void Work(vtkSMPToolsJob& job, int index);
+  bool Steal(vtkSMPToolsJob& job, int index);
+
+  int NumberOfThreads;
+  vtkSMPToolsWorkRange *Ranges;
+  std::vector<WorkerInfo> Workers;
+  std::vector<int> SpawnedThreads;
+  vtkMultiThreader *Threader;
+
+  // Protect the members below.
+  vtkSimpleMutexLock Mutex;
+  vtkSimpleConditionVariable WorkAvailable;
+  vtkSimpleConditionVariable WorkDone;
+  vtkSMPToolsJob *Job;
+  unsigned int Generation;
+  int Busy;
+  int Started;
+  bool Stop;
+
+  vtkSMPToolsThreadPool(const vtkSMPToolsThreadPool&); // not implemented
+  void operator=(const vtkSMPToolsThreadPool&); // not implemented
+};
+
+//--------------------------------------------------------------------------------
+vtkSMPToolsThreadPool::vtkSMPToolsThreadPool(int numThreads)
+  : NumberOfThreads(numThreads), Job(0), Generation(0), Busy(0), Started(0),
+    Stop(false)
+{
+  this->Ranges = new vtkSMPToolsWorkRange[numThreads];
+  for (int i = 0; i < numThreads; ++i)
+    {
+    this->Ranges[i].Begin = this->Ranges[i].End = 0;
+    }
+  this->Threader = vtkMultiThreader::New();
+  this->Workers.resize(numThreads);
+  for (int i = 1; i < numThreads; ++i)
+    {
+    this->Workers[i].Pool = this;
+    this->Workers[i].Index = i;
+    this->SpawnedThreads.push_back(this->Threader->SpawnThread(
+        vtkSMPToolsThreadPool::WorkerMain, &this->Workers[i]));
+    }
+
+  // Wait for all the threads to register their id.
+  this->Mutex.Lock();
+  while (this->Started < numThreads - 1)
+    {
+    this->WorkDone.Wait(this->Mutex);
+    }
+  this->Mutex.Unlock();
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPToolsThreadPool::~vtkSMPToolsThreadPool()
+{
+  this->Mutex.Lock();
+  this->Stop = true;
+  this->WorkAvailable.Broadcast();
+  this->Mutex.Unlock();
+  for (size_t i = 0; i < this->SpawnedThreads.size(); ++i)
+    {
+    this->Threader->TerminateThread(this->SpawnedThreads[i]);
+    }
+  this->Threader->Delete();
+  delete [] this->Ranges;
+}
+
+//--------------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkSMPToolsThreadPool::WorkerMain(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  WorkerInfo *worker = static_cast<WorkerInfo*>(info->UserData);
+  worker->Pool->WorkerLoop(worker->Index);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPToolsThreadPool::WorkerLoop(int index)
+{
+  this->Mutex.Lock();
+  vtkSMPToolsThreadIds[index] = vtkMultiThreader::GetCurrentThreadID();
+  ++this->Started;
+  this->WorkDone.Broadcast();
+
+  unsigned int generation = this->Generation;
+  for (;;)
+    {
+    while (!this->Stop && this->Generation == generation)
+      {
+      this->WorkAvailable.Wait(this->Mutex);
+      }
+    if (this->Stop)
+      {
+      break;
+      }
+    generation = this->Generation;
+    vtkSMPToolsJob *job = this->Job;
+    if (index < job->NumberOfThreads)
+      {
+      this->Mutex.Unlock();
+      this->Work(*job, index);
+      this->Mutex.Lock();
+      if (--this->Busy == 0)
+        {
+        this->WorkDone.Broadcast();
+        }
+      }
+    }
+  this->Mutex.Unlock();
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPToolsThreadPool::Run(vtkIdType first, vtkIdType last,
+                                vtkSMPToolsJob& job)
+{
+  int numThreads = job.NumberOfThreads;
+  vtkIdType n = last - first;
+  for (int i = 0; i < numThreads; ++i)
+    {
+    this->Ranges[i].Begin = first + n * i / numThreads;
+    this->Ranges[i].End = first + n * (i + 1) / numThreads;
+    }
+
+  this->Mutex.Lock();
+  this->Job = &job;
+  this->Busy = numThreads - 1;
+  ++this->Generation;
+  this->WorkAvailable.Broadcast();
+  this->Mutex.Unlock();
+
+  this->Work(job, 0);
+
+  this->Mutex.Lock();
+  while (this->Busy > 0)
+    {
+    this->WorkDone.Wait(this->Mutex);
+    }
+  this->Job = 0;
+  this->Mutex.Unlock();
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPToolsThreadPool::Work(vtkSMPToolsJob& job, int index)
+{
+  vtk::detail::smp::vtkSMPToolsWorkerScope worker(*job.State);
+  vtkSMPToolsWorkRange& range = this->Ranges[index];
+  for (;;)
+    {
+    range.Lock.Lock();
+    vtkIdType begin = range.Begin;
+    vtkIdType remaining = range.End - begin;
+    vtkIdType chunk = job.Grain > 0 ? job.Grain :
+      remaining / vtkSMPToolsChunkDivisor;
+    if (chunk < job.MinimumChunk)
+      {
+      chunk = job.MinimumChunk;
+      }
+    if (chunk > remaining)
+      {
+      chunk = remaining;
+      }
+    range.Begin += chunk;
+    range.Lock.Unlock();
+
+    if (chunk > 0)
+      {
+      job.Execute(job.Functor, begin, begin + chunk);
+      }
+    else if (!this->Steal(job, index))
+      {
+      break;
+      }
+    }
+}
+
+//--------------------------------------------------------------------------------
+// Move the back half of the range of another thread to the empty range of
+// thread index. Return false when there is nothing left to steal.
+bool vtkSMPToolsThreadPool::Steal(vtkSMPToolsJob& job, int index)
+{
+  int numThreads = job.NumberOfThreads;
+  for (int i = 1; i < numThreads; ++i)
+    {
+    vtkSMPToolsWorkRange& victim = this->Ranges[(index + i) % numThreads];
+    victim.Lock.Lock();
+    vtkIdType remaining = victim.End - victim.Begin;
+    if (remaining > 0)
+      {
+      vtkIdType end = victim.End;
+      vtkIdType begin = end - (remaining + 1) / 2;
+      victim.End = begin;
+      victim.Lock.Unlock();
+
+      vtkSMPToolsWorkRange& range = this->Ranges[index];
+      range.Lock.Lock();
+      range.Begin = begin;
+      range.End = end;
+      range.Lock.Unlock();
+      return true;
+      }
+    victim.Lock.Unlock();
+    }
+  return false;
+}
+
+vtkSimpleCriticalSection vtkSMPToolsPoolLock;
+vtkSMPToolsThreadPool *vtkSMPToolsPool = 0;
+
+// Stops the threads of the pool at exit.
+class vtkSMPToolsThreadPoolCleanup
+{
+public:
+  ~vtkSMPToolsThreadPoolCleanup()
+    {
+      delete vtkSMPToolsPool;
+      vtkSMPToolsPool = 0;
+    }
+};
+vtkSMPToolsThreadPoolCleanup vtkSMPToolsPoolCleanup;
+}
+
+//--------------------------------------------------------------------------------
+void vtk::detail::smp::vtkSMPToolsPoolFor(vtkIdType first, vtkIdType last,
+  vtkIdType grain, int numThreads, vtkSMPToolsExecuteRangePtr execute,
+  void *functor, const vtkSMPToolsScopeState& state)
+{
+  vtkIdType n = last - first;
+  if (n <= 0)
+    {
+    return;
+    }
+
+  // The pool runs one loop at a time: loops started concurrently from
+  // several threads are serialized.
+  vtkSMPToolsPoolLock.Lock();
+  vtkSMPToolsThreadIds[0] = vtkMultiThreader::GetCurrentThreadID();
+
+  if (numThreads <= 1 || n == 1 || (grain > 0 && grain >= n))
+    {
+    vtkSMPToolsWorkerScope worker(state);
+    if (grain <= 0)
+      {
+      grain = n;
+      }
+    for (vtkIdType b = first; b < last; b += grain)
+      {
+      execute(functor, b, (last - b > grain) ? b + grain : last);
+      }
+    vtkSMPToolsPoolLock.Unlock();
+    return;
+    }
+
+  if (!vtkSMPToolsPool)
+    {
+    // vtkMultiThreader spawns at most VTK_MAX_THREADS threads.
+    vtkSMPToolsPool = new vtkSMPToolsThreadPool(
+      vtkSMPToolsNumberOfThreads < VTK_MAX_THREADS ?
+      vtkSMPToolsNumberOfThreads : VTK_MAX_THREADS);
+    }
+  if (numThreads > vtkSMPToolsPool->GetNumberOfThreads())
+    {
+    numThreads = vtkSMPToolsPool->GetNumberOfThreads();
+    }
+
+  vtkSMPToolsJob job;
+  job.Execute = execute;
+  job.Functor = functor;
+  job.Grain = grain;
+  job.MinimumChunk = grain > 0 ? grain :
+    n / (numThreads * vtkSMPToolsChunksPerThread);
+  if (job.MinimumChunk < 1)
+    {
+    job.MinimumChunk = 1;
+    }
+  job.NumberOfThreads = numThreads;
+  job.State = &state;
+  vtkSMPToolsPool->Run(first, last, job);
+
+  vtkSMPToolsPoolLock.Unlock();
+}
+
 //--------------------------------------------------------------------------------
 void vtkSMPTools::Initialize(int nThreads)
 {
@@ -84,5 +433,25 @@ void vtkSMPTools::Initialize(int nThreads)
 
 int vtkSMPTools::GetEstimatedNumberOfThreads()
 {
-  return vtkSMPToolsNumberOfThreads;
+  int scopeThreads = vtkSMPTools::GetScopeNumberOfThreads();
+  return (scopeThreads > 0 && scopeThreads < vtkSMPToolsNumberOfThreads) ?
+    scopeThreads : vtkSMPToolsNumberOfThreads;
+}
+
+//--------------------------------------------------------------------------------
+void vtk::detail::smp::vtkSMPTools_Impl_BeginScope(vtkSMPToolsScopeState&,
+                                                   void*&)
+{
+}
+
+//--------------------------------------------------------------------------------
+void vtk::detail::smp::vtkSMPTools_Impl_EndScope(vtkSMPToolsScopeState&,
+                                                 void*)
+{
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPTools::GetThreadIndex()
+{
+  return vtkSMPToolsGetThreadID();
 }
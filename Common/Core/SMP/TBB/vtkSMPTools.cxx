@@ -17,6 +17,7 @@
 
 #include "vtkCriticalSection.h"
 
+#include <tbb/task_arena.h>
 #include <tbb/task_scheduler_init.h>
 
 struct vtkSMPToolsInit
@@ -53,6 +54,39 @@ void vtkSMPTools::Initialize(int numThreads)
 //--------------------------------------------------------------------------------
 int vtkSMPTools::GetEstimatedNumberOfThreads()
 {
+  int scopeThreads = vtkSMPTools::GetScopeNumberOfThreads();
+  if (scopeThreads > 0)
+    {
+    return scopeThreads;
+    }
   return vtkTBBNumSpecifiedThreads ? vtkTBBNumSpecifiedThreads
     : tbb::task_scheduler_init::default_num_threads();
 }
+
+//--------------------------------------------------------------------------------
+// A scope limiting the number of threads gets its own arena. Algorithms
+// started inside it, including nested ones, run in that arena.
+void vtk::detail::smp::vtkSMPTools_Impl_BeginScope(vtkSMPToolsScopeState& state,
+                                                   void*& backendData)
+{
+  vtkSMPTools::Initialize();
+  if (state.NumberOfThreads > 0)
+    {
+    tbb::task_arena* arena = new tbb::task_arena(state.NumberOfThreads);
+    state.Context = arena;
+    backendData = arena;
+    }
+}
+
+//--------------------------------------------------------------------------------
+void vtk::detail::smp::vtkSMPTools_Impl_EndScope(vtkSMPToolsScopeState&,
+                                                 void* backendData)
+{
+  delete static_cast<tbb::task_arena*>(backendData);
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPTools::GetThreadIndex()
+{
+  return vtk::detail::smp::vtkSMPToolsGetThreadIndex();
+}
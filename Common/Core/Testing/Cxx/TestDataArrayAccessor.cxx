@@ -0,0 +1,174 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayAccessor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkAngularPeriodicDataArray.h"
+#include "vtkDataArrayAccessor.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <iostream>
+#include <typeinfo>
+
+namespace
+{
+// Sum all values of the array through an accessor.
+template <class Accessor>
+double SumValues(Accessor accessor)
+{
+  double sum = 0.0;
+  const vtkIdType numTuples = accessor.GetNumberOfTuples();
+  const int numComps = accessor.GetNumberOfComponents();
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    for (int c = 0; c < numComps; ++c)
+      {
+      sum += static_cast<double>(accessor.Get(t, c));
+      }
+    }
+  return sum;
+}
+
+// Scale all values of the array by two through an accessor.
+template <class Accessor>
+void ScaleValues(Accessor accessor)
+{
+  typename Accessor::APIType tuple[3];
+  for (vtkIdType t = 0; t < accessor.GetNumberOfTuples(); ++t)
+    {
+    accessor.Get(t, tuple);
+    for (int c = 0; c < accessor.GetNumberOfComponents(); ++c)
+      {
+      tuple[c] *= 2;
+      }
+    accessor.Set(t, tuple);
+    }
+}
+
+template <class Container>
+bool CheckArray(vtkDataArray *array, double expectedSum)
+{
+  double sum = 0.;
+  bool typeOk = false;
+  switch (array->GetDataType())
+    {
+    vtkDataArrayAccessorMacro(array,
+      sum = SumValues(vtkDAAccessor);
+      typeOk = typeid(vtkDAContainerType) == typeid(Container););
+    }
+  if (!typeOk)
+    {
+    std::cerr << "Unexpected accessor type for " << array->GetClassName()
+              << std::endl;
+    return false;
+    }
+  if (sum != expectedSum)
+    {
+    std::cerr << "Bad sum for " << array->GetClassName() << ": " << sum
+              << " (expected " << expectedSum << ")" << std::endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int TestDataArrayAccessor(int, char *[])
+{
+  const vtkIdType numTuples = 100;
+  double expectedSum = 0.;
+
+  vtkNew<vtkFloatArray> aos;
+  vtkNew<vtkSOADataArrayTemplate<float> > soa;
+  vtkNew<vtkIntArray> ints;
+  aos->SetNumberOfComponents(3);
+  soa->SetNumberOfComponents(3);
+  ints->SetNumberOfComponents(3);
+  aos->SetNumberOfTuples(numTuples);
+  soa->SetNumberOfTuples(numTuples);
+  ints->SetNumberOfTuples(numTuples);
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    for (int c = 0; c < 3; ++c)
+      {
+      aos->SetComponent(t, c, t + c);
+      soa->SetComponent(t, c, t + c);
+      ints->SetComponent(t, c, t + c);
+      expectedSum += t + c;
+      }
+    }
+
+  if (!CheckArray<vtkDataArrayTemplate<float> >(aos.GetPointer(),
+                                                expectedSum) ||
+      !CheckArray<vtkSOADataArrayTemplate<float> >(soa.GetPointer(),
+                                                   expectedSum) ||
+      !CheckArray<vtkDataArrayTemplate<int> >(ints.GetPointer(), expectedSum))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Mapped arrays of unknown class are read through vtkTypedDataArray.
+  vtkNew<vtkAngularPeriodicDataArray<float> > periodic;
+  periodic->InitializeArray(aos.GetPointer());
+  periodic->SetAngle(90.);
+  double periodicSum = 0.;
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    float tuple[3];
+    periodic->GetTupleValue(t, tuple);
+    periodicSum += tuple[0] + tuple[1] + tuple[2];
+    }
+  if (!CheckArray<vtkTypedDataArray<float> >(periodic.GetPointer(),
+                                             periodicSum))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The primary template binds statically to a concrete mapped array.
+  double staticSum = SumValues(
+    vtkDataArrayAccessor<vtkAngularPeriodicDataArray<float> >(
+      periodic.GetPointer()));
+  if (staticSum != periodicSum)
+    {
+    std::cerr << "Bad sum for statically bound periodic array: " << staticSum
+              << " (expected " << periodicSum << ")" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Tuple access and writes.
+  ScaleValues(vtkDataArrayAccessor<vtkDataArrayTemplate<float> >(
+                aos.GetPointer()));
+  ScaleValues(vtkDataArrayAccessor<vtkSOADataArrayTemplate<float> >(
+                soa.GetPointer()));
+  ScaleValues(vtkDataArrayAccessor<vtkDataArray>(ints.GetPointer()));
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    for (int c = 0; c < 3; ++c)
+      {
+      double expected = 2. * (t + c);
+      if (aos->GetComponent(t, c) != expected ||
+          soa->GetComponent(t, c) != expected ||
+          ints->GetComponent(t, c) != expected)
+        {
+        std::cerr << "Bad value after scaling at " << t << ", " << c
+                  << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
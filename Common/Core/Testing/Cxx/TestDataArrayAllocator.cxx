@@ -0,0 +1,160 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkAlignedDataArrayAllocator.h"
+#include "vtkDataArrayAllocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkFirstTouchDataArrayAllocator.h"
+#include "vtkHugePageDataArrayAllocator.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return false;                                                     \
+    }
+
+namespace
+{
+bool IsAligned(void *ptr, size_t alignment)
+{
+  return reinterpret_cast<size_t>(ptr) % alignment == 0;
+}
+
+// Exercise allocation, growth, squeezing and user buffers with the current
+// allocator.
+bool TestArrays(const char *name, size_t alignment)
+{
+  const vtkIdType numValues = 600000; // Larger than a huge page.
+
+  vtkNew<vtkIntArray> array;
+  for (vtkIdType i = 0; i < numValues; ++i)
+    {
+    array->InsertNextValue(static_cast<int>(i));
+    }
+  TEST_ASSERT(IsAligned(array->GetVoidPointer(0), alignment),
+              name << ": bad alignment after growth.");
+  array->Squeeze();
+  TEST_ASSERT(array->GetSize() == numValues, name << ": Squeeze failed.");
+  for (vtkIdType i = 0; i < numValues; ++i)
+    {
+    TEST_ASSERT(array->GetValue(i) == i, name << ": bad value at " << i);
+    }
+
+  vtkNew<vtkDoubleArray> small;
+  small->Allocate(10);
+  TEST_ASSERT(IsAligned(small->GetVoidPointer(0), alignment),
+              name << ": bad alignment after Allocate.");
+
+  // User buffers are copied into allocator memory when they grow.
+  int *user = static_cast<int*>(malloc(4 * sizeof(int)));
+  for (int i = 0; i < 4; ++i)
+    {
+    user[i] = i;
+    }
+  vtkNew<vtkIntArray> userArray;
+  userArray->SetArray(user, 4, 0);
+  userArray->InsertValue(1000, 1000);
+  TEST_ASSERT(userArray->GetValue(3) == 3 && userArray->GetValue(1000) == 1000,
+              name << ": bad values after growing a user array.");
+  TEST_ASSERT(IsAligned(userArray->GetVoidPointer(0), alignment),
+              name << ": user array grown without the allocator.");
+
+  int saved[4] = { 0, 1, 2, 3 };
+  userArray->SetArray(saved, 4, 1);
+  userArray->InsertNextValue(4);
+  TEST_ASSERT(saved[3] == 3 && userArray->GetValue(4) == 4 &&
+              userArray->GetPointer(0) != saved,
+              name << ": saved user array was modified.");
+
+  // vtkPoints data come from the allocator as well.
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(1000);
+  TEST_ASSERT(IsAligned(points->GetVoidPointer(0), alignment),
+              name << ": bad point alignment.");
+  return true;
+}
+}
+
+int TestDataArrayAllocator(int, char *[])
+{
+  if (!TestArrays("default", 1))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkAlignedDataArrayAllocator> aligned;
+  vtkDataArrayAllocator::SetInstance(aligned.GetPointer());
+  if (!TestArrays("aligned", 64))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Arrays release their memory with the allocator that provided it, even
+  // after the instance is replaced.
+  vtkSmartPointer<vtkDoubleArray> survivor =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  survivor->SetNumberOfValues(1000);
+
+  vtkNew<vtkHugePageDataArrayAllocator> hugePages;
+  vtkDataArrayAllocator::SetInstance(hugePages.GetPointer());
+  if (!TestArrays("huge pages", 64))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkFirstTouchDataArrayAllocator> firstTouch;
+  firstTouch->SetParallelThreshold(4096);
+  vtkDataArrayAllocator::SetInstance(firstTouch.GetPointer());
+  if (!TestArrays("first touch", 4096))
+    {
+    return EXIT_FAILURE;
+    }
+  vtkNew<vtkDoubleArray> zeroed;
+  zeroed->SetNumberOfValues(10000);
+  for (vtkIdType i = 0; i < 10000; ++i)
+    {
+    if (zeroed->GetValue(i) != 0.)
+      {
+      std::cerr << "First touch memory is not zeroed." << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  survivor->Resize(100000);
+  if (!IsAligned(survivor->GetVoidPointer(0), 64))
+    {
+    std::cerr << "Resize did not use the allocator that owns the buffer."
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+  survivor = NULL;
+
+  vtkDataArrayAllocator::SetInstance(NULL);
+  if (vtkDataArrayAllocator::GetInstance()->IsA("vtkAlignedDataArrayAllocator"))
+    {
+    std::cerr << "Default allocator was not restored." << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
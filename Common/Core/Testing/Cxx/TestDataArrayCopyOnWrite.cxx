@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayCopyOnWrite.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkDataArray::ShallowCopy() shares the values of arrays of the
+// same type and copies them on the first write only.
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+int TestDataArrayCopyOnWrite(int, char *[])
+{
+  const vtkIdType numTuples = 1000;
+
+  vtkNew<vtkDoubleArray> source;
+  source->SetNumberOfComponents(3);
+  for (vtkIdType i = 0; i < numTuples; ++i)
+    {
+    source->InsertNextTuple3(i, 2 * i, 3 * i);
+    }
+
+  // Sharing does not copy the values.
+  vtkNew<vtkDoubleArray> copy;
+  copy->ShallowCopy(source.GetPointer());
+  TEST_ASSERT(copy->IsShared() && source->IsShared(), "Values not shared.");
+  TEST_ASSERT(copy->GetReadPointer(0) == source->GetReadPointer(0),
+              "Values were copied.");
+  TEST_ASSERT(copy->GetNumberOfComponents() == 3 &&
+              copy->GetNumberOfTuples() == numTuples, "Wrong shape.");
+  TEST_ASSERT(copy->GetComponent(10, 1) == 20.0, "Wrong value.");
+
+  // Writing to the copy copies its values and leaves the source alone.
+  copy->SetComponent(10, 1, -1.0);
+  TEST_ASSERT(!copy->IsShared() && !source->IsShared(),
+              "Values still shared after a write.");
+  TEST_ASSERT(copy->GetReadPointer(0) != source->GetReadPointer(0),
+              "Values not copied on write.");
+  TEST_ASSERT(copy->GetComponent(10, 1) == -1.0, "Write lost.");
+  TEST_ASSERT(source->GetComponent(10, 1) == 20.0, "Source modified.");
+  TEST_ASSERT(copy->GetComponent(999, 2) == 2997.0, "Bad copy.");
+
+  // The last array using the values takes them back without copying.
+  const double *values = source->GetReadPointer(0);
+  source->SetValue(0, 5.0);
+  TEST_ASSERT(source->GetReadPointer(0) == values,
+              "Values copied although not shared anymore.");
+
+  // Pointers to modify the values and growth unshare them as well.
+  vtkNew<vtkDoubleArray> second;
+  second->ShallowCopy(source.GetPointer());
+  double *ptr = second->GetPointer(0);
+  TEST_ASSERT(ptr != source->GetReadPointer(0), "GetPointer() shared.");
+  ptr[0] = 7.0;
+  TEST_ASSERT(source->GetValue(0) == 5.0, "Source modified.");
+  second->ShallowCopy(source.GetPointer());
+  second->InsertNextTuple3(0.0, 0.0, 0.0);
+  TEST_ASSERT(second->GetNumberOfTuples() == numTuples + 1 &&
+              source->GetNumberOfTuples() == numTuples,
+              "Growth changed the source.");
+  TEST_ASSERT(second->GetComponent(999, 2) == 2997.0, "Bad copy on growth.");
+
+  // Releasing an array keeps the values of the others valid.
+  vtkDoubleArray *temporary = vtkDoubleArray::New();
+  temporary->ShallowCopy(source.GetPointer());
+  source->Initialize();
+  TEST_ASSERT(temporary->GetComponent(999, 1) == 1998.0,
+              "Values released with the source.");
+  source->ShallowCopy(temporary);
+  temporary->Delete();
+  TEST_ASSERT(!source->IsShared() && source->GetComponent(999, 0) == 999.0,
+              "Values released with the last array.");
+
+  // Arrays of other types are deep copied.
+  vtkNew<vtkFloatArray> floats;
+  floats->ShallowCopy(source.GetPointer());
+  TEST_ASSERT(!floats->IsShared() && floats->GetComponent(999, 0) == 999.0f,
+              "Bad copy between types.");
+
+  // User memory is never shared.
+  int userValues[4] = { 1, 2, 3, 4 };
+  vtkNew<vtkIntArray> user;
+  user->SetArray(userValues, 4, 1);
+  vtkNew<vtkIntArray> userCopy;
+  userCopy->ShallowCopy(user.GetPointer());
+  TEST_ASSERT(!userCopy->IsShared() && userCopy->GetValue(3) == 4,
+              "User memory was shared.");
+
+  // DeepCopy() shares the values when copy-on-write is turned on.
+  vtkDataArray::SetGlobalCopyOnWrite(1);
+  vtkNew<vtkDoubleArray> deep;
+  deep->DeepCopy(source.GetPointer());
+  vtkDataArray::SetGlobalCopyOnWrite(0);
+  TEST_ASSERT(deep->IsShared() &&
+              deep->GetReadPointer(0) == source->GetReadPointer(0),
+              "DeepCopy() did not share the values.");
+  deep->DeepCopy(source.GetPointer());
+  TEST_ASSERT(!deep->IsShared(), "DeepCopy() shared the values.");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayRange.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkLookupTable.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#define TEST_RANGE(_range, _min, _max, _msg)                               \
+  if ((_range)[0] != (_min) || (_range)[1] != (_max))                      \
+    {                                                                      \
+    std::cerr << "Line " << __LINE__ << ": " << _msg << ": got ["          \
+              << (_range)[0] << ", " << (_range)[1] << "], expected ["     \
+              << (_min) << ", " << (_max) << "]" << std::endl;             \
+    return EXIT_FAILURE;                                                   \
+    }
+
+int TestDataArrayRange(int, char *[])
+{
+  // Large enough to be processed in parallel.
+  const vtkIdType numTuples = 200000;
+
+  vtkNew<vtkFloatArray> array;
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(numTuples);
+  vtkNew<vtkSOADataArrayTemplate<float> > soa;
+  soa->SetNumberOfComponents(3);
+  soa->SetNumberOfTuples(numTuples);
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    float tuple[3] = { static_cast<float>(t), static_cast<float>(-t), 2.f };
+    array->SetTupleValue(t, tuple);
+    soa->SetTupleValue(t, tuple);
+    }
+
+  double range[2];
+  const double last = static_cast<double>(numTuples - 1);
+  array->GetRange(range, 0);
+  TEST_RANGE(range, 0., last, "Component 0");
+  array->GetRange(range, 1);
+  TEST_RANGE(range, -last, 0., "Component 1");
+  array->GetRange(range, 2);
+  TEST_RANGE(range, 2., 2., "Component 2");
+  soa->GetRange(range, 1);
+  TEST_RANGE(range, -last, 0., "SOA component 1");
+
+  array->GetRange(range, -1);
+  if (range[0] != 2. || std::fabs(range[1] - sqrt(2 * last * last + 4.)) > 1e-6)
+    {
+    std::cerr << "Bad magnitude range [" << range[0] << ", " << range[1]
+              << "]" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Non finite values are only ignored by GetFiniteRange.
+  array->SetComponent(10, 0, vtkMath::Inf());
+  array->SetComponent(11, 0, vtkMath::Nan());
+  array->SetComponent(12, 1, vtkMath::NegInf());
+  array->Modified();
+  array->GetFiniteRange(range, 0);
+  TEST_RANGE(range, 0., last, "Finite component 0");
+  array->GetFiniteRange(range, 1);
+  TEST_RANGE(range, -last, 0., "Finite component 1");
+  array->GetRange(range, 0);
+  TEST_RANGE(range, 0., vtkMath::Inf(), "Component 0 with infinity");
+  array->GetRange(range, 1);
+  TEST_RANGE(range, vtkMath::NegInf(), 0., "Component 1 with infinity");
+
+  // The cached ranges must not survive a modification of the values.
+  array->SetComponent(0, 1, 1.);
+  array->Modified();
+  array->GetFiniteRange(range, 1);
+  TEST_RANGE(range, -last, 1., "Finite range after modification");
+  array->GetRange(range, 1);
+  TEST_RANGE(range, vtkMath::NegInf(), 1., "Range after modification");
+
+  // Changing the lookup table keeps the cached range.
+  array->GetRange(range, 2);
+  array->SetValue(2, 100.f); // Not marked as modified.
+  vtkNew<vtkLookupTable> lut;
+  array->SetLookupTable(lut.GetPointer());
+  array->GetRange(range, 2);
+  TEST_RANGE(range, 2., 2., "Range recomputed by SetLookupTable");
+  array->Modified();
+  array->GetRange(range, 2);
+  TEST_RANGE(range, 2., 100., "Range after modification");
+
+  // Ghost-masked ranges.
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetNumberOfTuples(numTuples);
+  std::vector<unsigned char> ghosts(numTuples, 0);
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    scalars->SetValue(t, static_cast<double>(t));
+    }
+  ghosts[0] = 1;
+  ghosts[numTuples - 1] = 2;
+  scalars->SetValue(5, vtkMath::Nan());
+  if (!scalars->ComputeMaskedRange(range, 0, &ghosts[0]))
+    {
+    std::cerr << "ComputeMaskedRange failed." << std::endl;
+    return EXIT_FAILURE;
+    }
+  TEST_RANGE(range, 1., last - 1., "Masked range");
+  scalars->ComputeMaskedRange(range, 0, &ghosts[0], 1);
+  TEST_RANGE(range, 1., last, "Masked range, first ghost type only");
+  scalars->ComputeMaskedRange(range, -1, &ghosts[0], 0xff, true);
+  TEST_RANGE(range, 1., last - 1., "Masked magnitude range");
+
+  std::fill(ghosts.begin(), ghosts.end(), 1);
+  if (scalars->ComputeMaskedRange(range, 0, &ghosts[0]))
+    {
+    std::cerr << "ComputeMaskedRange should fail when all tuples are masked."
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+  TEST_RANGE(range, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, "Fully masked range");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestFileMappedDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that arrays mapped from a file see the file values, that copy on
+// write mappings never modify the file and that mapped arrays can grow.
+
+#include "vtkDoubleArray.h"
+#include "vtkFileMappedDataArrayAllocator.h"
+#include "vtkIntArray.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+namespace
+{
+// A header that is not a multiple of the page size, then the values.
+const vtkTypeInt64 HeaderSize = 8192 + 24;
+const vtkIdType NumberOfValues = 100000;
+
+bool WriteFile(const char *fileName)
+{
+  FILE *file = fopen(fileName, "wb");
+  if (!file)
+    {
+    return false;
+    }
+  std::vector<char> header(static_cast<size_t>(HeaderSize), 'h');
+  std::vector<double> doubles(NumberOfValues);
+  std::vector<int> ints(NumberOfValues);
+  for (vtkIdType i = 0; i < NumberOfValues; ++i)
+    {
+    doubles[i] = 0.5 * i;
+    ints[i] = static_cast<int>(3 * i);
+    }
+  bool ok =
+    fwrite(&header[0], 1, header.size(), file) == header.size() &&
+    fwrite(&doubles[0], sizeof(double), doubles.size(), file) ==
+    doubles.size() &&
+    fwrite(&ints[0], sizeof(int), ints.size(), file) == ints.size();
+  return fclose(file) == 0 && ok;
+}
+
+vtkSmartPointer<vtkIntArray> MapInts(const char *fileName, int mode)
+{
+  vtkSmartPointer<vtkIntArray> array;
+  array.TakeReference(vtkIntArray::SafeDownCast(
+    vtkFileMappedDataArrayAllocator::MapArray(
+      fileName, HeaderSize + NumberOfValues * sizeof(double), VTK_INT, 1,
+      NumberOfValues, mode)));
+  return array;
+}
+}
+
+int TestFileMappedDataArrayAllocator(int argc, char *argv[])
+{
+  if (argc < 2)
+    {
+    std::cout << "Usage: " << argv[0] << " outputFilename" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const char *fileName = argv[1];
+  TEST_ASSERT(WriteFile(fileName), "Cannot write " << fileName);
+
+  // Read only mapping, with the tuples made of two doubles.
+  vtkSmartPointer<vtkDoubleArray> doubles;
+  doubles.TakeReference(vtkDoubleArray::SafeDownCast(
+    vtkFileMappedDataArrayAllocator::MapArray(
+      fileName, HeaderSize, VTK_DOUBLE, 2, NumberOfValues / 2,
+      vtkFileMappedDataArrayAllocator::READ_ONLY,
+      vtkFileMappedDataArrayAllocator::SEQUENTIAL)));
+  TEST_ASSERT(doubles && doubles->GetNumberOfTuples() == NumberOfValues / 2 &&
+              doubles->GetNumberOfComponents() == 2,
+              "Bad read only mapping");
+  for (vtkIdType i = 0; i < NumberOfValues; ++i)
+    {
+    TEST_ASSERT(doubles->GetValue(i) == 0.5 * i, "Bad double at " << i);
+    }
+  double range[2];
+  doubles->GetRange(range, 1);
+  TEST_ASSERT(range[0] == 0.5 && range[1] == 0.5 * (NumberOfValues - 1),
+              "Bad range of mapped values");
+
+  // Copy on write: the array can be modified but the file is unchanged.
+  vtkSmartPointer<vtkIntArray> ints =
+    MapInts(fileName, vtkFileMappedDataArrayAllocator::COPY_ON_WRITE);
+  TEST_ASSERT(ints && ints->GetNumberOfTuples() == NumberOfValues,
+              "Bad copy on write mapping");
+  for (vtkIdType i = 0; i < NumberOfValues; ++i)
+    {
+    TEST_ASSERT(ints->GetValue(i) == 3 * i, "Bad int at " << i);
+    ints->SetValue(i, -1);
+    }
+  vtkSmartPointer<vtkIntArray> check =
+    MapInts(fileName, vtkFileMappedDataArrayAllocator::READ_ONLY);
+  TEST_ASSERT(check && check->GetValue(NumberOfValues - 1) ==
+              3 * (NumberOfValues - 1), "Copy on write changed the file");
+
+  // Growing moves the values out of the mapping.
+  check->InsertNextValue(7);
+  check->Squeeze();
+  TEST_ASSERT(check->GetNumberOfTuples() == NumberOfValues + 1 &&
+              check->GetValue(NumberOfValues) == 7 &&
+              check->GetValue(NumberOfValues - 1) == 3 * (NumberOfValues - 1),
+              "Bad values after growing a mapped array");
+  check->SetValue(0, 5);
+  TEST_ASSERT(check->GetValue(0) == 5, "Grown array is not writable");
+
+  // Mappings that cannot be used as arrays.
+  bool display = vtkObject::GetGlobalWarningDisplay() != 0;
+  vtkObject::GlobalWarningDisplayOff();
+  vtkDataArray *bad = vtkFileMappedDataArrayAllocator::MapArray(
+    fileName, HeaderSize + 1, VTK_DOUBLE, 1, 10,
+    vtkFileMappedDataArrayAllocator::READ_ONLY);
+  TEST_ASSERT(!bad, "Misaligned mapping accepted");
+  bad = vtkFileMappedDataArrayAllocator::MapArray(
+    fileName, HeaderSize, VTK_DOUBLE, 1, 3 * NumberOfValues,
+    vtkFileMappedDataArrayAllocator::READ_ONLY);
+  TEST_ASSERT(!bad, "Mapping past the end of the file accepted");
+  vtkObject::SetGlobalWarningDisplay(display ? 1 : 0);
+
+  doubles = NULL;
+  ints = NULL;
+  check = NULL;
+  remove(fileName);
+  return EXIT_SUCCESS;
+}
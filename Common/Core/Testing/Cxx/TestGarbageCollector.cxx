@@ -74,6 +74,13 @@ static void MyDeleteCallback(vtkObject*, unsigned long, void*, void*)
   called = 1;
 }
 
+// A callback that counts how many times it is called.
+static int numberDeleted = 0;
+static void MyCountCallback(vtkObject*, unsigned long, void*, void*)
+{
+  ++numberDeleted;
+}
+
 // Main test function.
 int TestGarbageCollector(int,char *[])
 {
@@ -115,5 +122,34 @@ int TestGarbageCollector(int,char *[])
     return 1;
     }
 
+  // Delete many objects inside a batch epoch, with deferred collection
+  // nested in it.  None should be collected until the epoch closes.
+  vtkSmartPointer<vtkCallbackCommand> counter =
+    vtkSmartPointer<vtkCallbackCommand>::New();
+  counter->SetCallback(MyCountCallback);
+  const int numberOfObjects = 100;
+  numberDeleted = 0;
+  vtkGarbageCollector::BatchCollectionPush();
+  for(int i = 0; i < numberOfObjects; ++i)
+    {
+    obj = vtkTestReferenceLoop::New();
+    obj->AddObserver(vtkCommand::DeleteEvent, counter);
+    vtkGarbageCollector::DeferredCollectionPush();
+    obj->Delete();
+    vtkGarbageCollector::DeferredCollectionPop();
+    }
+  if(numberDeleted != 0)
+    {
+    cerr << "Object collection not batched." << endl;
+    return 1;
+    }
+  vtkGarbageCollector::BatchCollectionPop();
+  if(numberDeleted != numberOfObjects)
+    {
+    cerr << "Batched collection collected " << numberDeleted
+         << " objects instead of " << numberOfObjects << "." << endl;
+    return 1;
+    }
+
   return 0;
 }
@@ -0,0 +1,99 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestIdList.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkIdList keeps its content when moving between the inline
+// storage and the heap.
+
+#include "vtkIdList.h"
+#include "vtkNew.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+static bool CheckIds(vtkIdList *list, vtkIdType n)
+{
+  if (list->GetNumberOfIds() != n)
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    if (list->GetId(i) != 3 * i)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+int TestIdList(int, char *[])
+{
+  vtkNew<vtkIdList> list;
+  TEST_ASSERT(list->GetNumberOfIds() == 0 && list->GetPointer(0) != NULL,
+              "Bad empty list");
+
+  // Grow through the inline storage to the heap.
+  const vtkIdType n = 10 * VTK_ID_LIST_INLINE_SIZE;
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    list->InsertNextId(3 * i);
+    TEST_ASSERT(CheckIds(list.GetPointer(), i + 1), "Bad insertion " << i);
+    }
+
+  // Shrink back to the inline storage.
+  list->SetNumberOfIds(VTK_ID_LIST_INLINE_SIZE / 2);
+  list->Squeeze();
+  TEST_ASSERT(CheckIds(list.GetPointer(), VTK_ID_LIST_INLINE_SIZE / 2),
+              "Bad squeeze");
+  list->Resize(2 * VTK_ID_LIST_INLINE_SIZE);
+  TEST_ASSERT(CheckIds(list.GetPointer(), VTK_ID_LIST_INLINE_SIZE / 2),
+              "Bad resize");
+
+  vtkNew<vtkIdList> copy;
+  copy->DeepCopy(list.GetPointer());
+  TEST_ASSERT(CheckIds(copy.GetPointer(), VTK_ID_LIST_INLINE_SIZE / 2),
+              "Bad deep copy");
+
+  // A small array owned by the list, then grown.
+  vtkIdType *array = new vtkIdType[2];
+  array[0] = 0;
+  array[1] = 3;
+  list->SetArray(array, 2);
+  list->InsertNextId(6);
+  TEST_ASSERT(CheckIds(list.GetPointer(), 3), "Bad SetArray");
+  list->Allocate(VTK_ID_LIST_INLINE_SIZE);
+  TEST_ASSERT(list->GetNumberOfIds() == 0, "Bad Allocate");
+  list->SetNumberOfIds(VTK_ID_LIST_INLINE_SIZE);
+  for (vtkIdType i = 0; i < VTK_ID_LIST_INLINE_SIZE; ++i)
+    {
+    list->SetId(i, 3 * i);
+    }
+  TEST_ASSERT(CheckIds(list.GetPointer(), VTK_ID_LIST_INLINE_SIZE),
+              "Bad SetNumberOfIds");
+
+  list->Initialize();
+  TEST_ASSERT(list->GetNumberOfIds() == 0, "Bad Initialize");
+  list->InsertId(n - 1, 3 * (n - 1));
+  TEST_ASSERT(list->GetNumberOfIds() == n && list->GetId(n - 1) == 3 * (n - 1),
+              "Bad InsertId");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestIndexedPriorityQueue.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks vtkIndexedPriorityQueue against a std::set through a random
+// sequence of insertions, updates, deletions and pops, with many equal
+// priorities and ids beyond the allocated range.
+
+#include "vtkIndexedPriorityQueue.h"
+#include "vtkNew.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <set>
+#include <utility>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+namespace
+{
+unsigned int Seed = 12345;
+int Random(int n)
+{
+  Seed = Seed * 1103515245u + 12345u;
+  return static_cast<int>((Seed >> 8) % static_cast<unsigned int>(n));
+}
+}
+
+int TestIndexedPriorityQueue(int, char *[])
+{
+  vtkNew<vtkIndexedPriorityQueue> queue;
+  queue->Allocate(100);
+  TEST_ASSERT(queue->Pop() == -1 && queue->GetNumberOfItems() == 0,
+              "Bad empty queue");
+
+  typedef std::pair<double, vtkIdType> Entry;
+  std::set<Entry> expected;
+  std::map<vtkIdType, double> priorities;
+  for (int step = 0; step < 200000; ++step)
+    {
+    vtkIdType id = Random(step < 100000 ? 500 : 50);
+    double priority = Random(20);
+    std::map<vtkIdType, double>::iterator found = priorities.find(id);
+    bool present = found != priorities.end();
+    switch (Random(5))
+      {
+      case 0:
+      case 1:
+        queue->Insert(priority, id);
+        if (!present)
+          {
+          expected.insert(Entry(priority, id));
+          priorities[id] = priority;
+          }
+        break;
+      case 2:
+        queue->Update(priority, id);
+        if (present)
+          {
+          expected.erase(Entry(found->second, id));
+          }
+        expected.insert(Entry(priority, id));
+        priorities[id] = priority;
+        break;
+      case 3:
+        TEST_ASSERT(queue->DeleteId(id) ==
+                    (present ? found->second : VTK_DOUBLE_MAX),
+                    "Bad deletion of " << id << " at step " << step);
+        if (present)
+          {
+          expected.erase(Entry(found->second, id));
+          priorities.erase(found);
+          }
+        break;
+      default:
+        {
+        double popped = -1.0;
+        vtkIdType top = queue->Pop(popped);
+        if (expected.empty())
+          {
+          TEST_ASSERT(top == -1, "Bad pop of empty queue at step " << step);
+          }
+        else
+          {
+          TEST_ASSERT(top == expected.begin()->second &&
+                      popped == expected.begin()->first,
+                      "Bad pop at step " << step);
+          priorities.erase(top);
+          expected.erase(expected.begin());
+          }
+        }
+      }
+    TEST_ASSERT(queue->GetNumberOfItems() ==
+                static_cast<vtkIdType>(expected.size()),
+                "Bad number of items at step " << step);
+    TEST_ASSERT(queue->GetPriority(id) ==
+                (priorities.count(id) ? priorities[id] : VTK_DOUBLE_MAX),
+                "Bad priority of " << id << " at step " << step);
+    }
+
+  double priority;
+  vtkIdType top = queue->Peek(priority);
+  TEST_ASSERT(expected.empty() ? top == -1 :
+              top == expected.begin()->second &&
+              priority == expected.begin()->first, "Bad peek");
+
+  queue->Reset();
+  TEST_ASSERT(queue->GetNumberOfItems() == 0 && queue->Pop() == -1 &&
+              queue->GetPriority(top) == VTK_DOUBLE_MAX, "Bad reset");
+  queue->Insert(1.0, 7);
+  queue->Insert(0.5, 3);
+  queue->Insert(2.0, 7);
+  TEST_ASSERT(queue->Pop() == 3 && queue->Pop() == 7 && queue->Pop() == -1,
+              "Bad queue after reset");
+
+  return EXIT_SUCCESS;
+}
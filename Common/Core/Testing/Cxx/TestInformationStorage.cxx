@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestInformationStorage.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkInformation keeps its entries and the reference counts of
+// their values while growing, shrinking and copying.
+
+#include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIterator.h"
+#include "vtkInformationObjectBaseKey.h"
+#include "vtkNew.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+namespace
+{
+const int NumberOfKeys = 40;
+std::vector<vtkInformationIntegerKey*> Keys;
+
+// The keys are owned by the key manager, which deletes them at exit.
+void MakeKeys()
+{
+  for (int i = 0; i < NumberOfKeys; ++i)
+    {
+    std::ostringstream name;
+    name << "KEY_" << i;
+    Keys.push_back(new vtkInformationIntegerKey(name.str().c_str(),
+                                                "TestInformationStorage"));
+    }
+}
+
+// Check that the keys [0, n) with a step of "step" are set to 7 * i.
+bool CheckKeys(vtkInformation *info, int n, int step)
+{
+  int count = 0;
+  for (int i = 0; i < NumberOfKeys; ++i)
+    {
+    bool expected = i < n && i % step == 0;
+    if (info->Has(Keys[i]) != (expected ? 1 : 0) ||
+        (expected && info->Get(Keys[i]) != 7 * i))
+      {
+      return false;
+      }
+    count += expected ? 1 : 0;
+    }
+
+  int iterated = 0;
+  vtkNew<vtkInformationIterator> it;
+  it->SetInformation(info);
+  for (it->InitTraversal(); !it->IsDoneWithTraversal(); it->GoToNextItem())
+    {
+    ++iterated;
+    }
+  return info->GetNumberOfKeys() == count && iterated == count;
+}
+}
+
+int TestInformationStorage(int, char *[])
+{
+  MakeKeys();
+
+  vtkNew<vtkInformation> info;
+  TEST_ASSERT(CheckKeys(info.GetPointer(), 0, 1), "Bad empty information");
+  for (int i = 0; i < NumberOfKeys; ++i)
+    {
+    info->Set(Keys[i], 7 * i);
+    TEST_ASSERT(CheckKeys(info.GetPointer(), i + 1, 1), "Bad Set " << i);
+    }
+
+  // Overwrite and remove every other key.
+  for (int i = 0; i < NumberOfKeys; ++i)
+    {
+    info->Set(Keys[i], 7 * i);
+    if (i % 2)
+      {
+      info->Remove(Keys[i]);
+      }
+    }
+  TEST_ASSERT(CheckKeys(info.GetPointer(), NumberOfKeys, 2), "Bad Remove");
+
+  // Copy into objects with more and fewer entries, and onto itself.
+  vtkNew<vtkInformation> copy;
+  copy->Set(Keys[1], -1);
+  copy->Copy(info.GetPointer());
+  TEST_ASSERT(CheckKeys(copy.GetPointer(), NumberOfKeys, 2), "Bad Copy");
+  vtkNew<vtkInformation> small;
+  small->Set(Keys[0], 0);
+  copy->Copy(small.GetPointer());
+  TEST_ASSERT(CheckKeys(copy.GetPointer(), 1, 1), "Bad Copy of small");
+  copy->Append(info.GetPointer());
+  TEST_ASSERT(CheckKeys(copy.GetPointer(), NumberOfKeys, 2), "Bad Append");
+  copy->Clear();
+  TEST_ASSERT(CheckKeys(copy.GetPointer(), 0, 1), "Bad Clear");
+
+  // Values are released when replaced, removed or cleared.
+  vtkInformationObjectBaseKey *objectKey =
+    new vtkInformationObjectBaseKey("OBJECT", "TestInformationStorage");
+  vtkNew<vtkInformation> value;
+  info->Set(objectKey, value.GetPointer());
+  copy->Copy(info.GetPointer());
+  TEST_ASSERT(value->GetReferenceCount() == 3, "Bad reference count");
+  copy->Copy(info.GetPointer());
+  TEST_ASSERT(value->GetReferenceCount() == 3, "Bad reference count on copy");
+  copy->Remove(objectKey);
+  info->Clear();
+  TEST_ASSERT(value->GetReferenceCount() == 1, "Value not released");
+
+  return EXIT_SUCCESS;
+}
@@ -20,6 +20,8 @@
 #include "vtkCommand.h"
 #include "vtkSmartPointer.h"
 
+#include <vector>
+
 // simple macro for performing tests
 #define TestAssert(t) \
 if (!(t)) \
@@ -57,6 +59,34 @@ int TestColor4uc(unsigned char* expected, unsigned char* test)
   return !failed;
 }
 
+// Map many values at once and compare with mapping them one at a time.
+template<class T>
+int TestBulkMapping(vtkLookupTable *table, const std::vector<T>& values,
+                    int dataType, int increment)
+{
+  int numberOfValues = static_cast<int>(values.size())/increment;
+  std::vector<unsigned char> rgba(4*numberOfValues);
+  std::vector<unsigned char> rgb(3*numberOfValues);
+  T *input = const_cast<T*>(&values[0]);
+  table->MapScalarsThroughTable2(input, &rgba[0], dataType, numberOfValues,
+                                 increment, VTK_RGBA);
+  table->MapScalarsThroughTable2(input, &rgb[0], dataType, numberOfValues,
+                                 increment, VTK_RGB);
+  for (int i = 0; i < numberOfValues; ++i)
+    {
+    unsigned char *expected =
+      table->MapValue(static_cast<double>(values[i*increment]));
+    if (!TestColor4uc(expected, &rgba[4*i]) ||
+        expected[0] != rgb[3*i] || expected[1] != rgb[3*i+1] ||
+        expected[2] != rgb[3*i+2])
+      {
+      std::cerr << "Bad bulk mapping of value " << i << std::endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
 // a simple error observer
 namespace {
 
@@ -235,5 +265,56 @@ int TestLookupTable(int,char *[])
 
   table->RemoveObserver(observerId);
 
+  // == check mapping of many values, including special colors ==
+
+  table->SetScaleToLinear();
+  table->SetNanColor(0.1, 0.2, 0.3, 0.4);
+  table->UseBelowRangeColorOn();
+  table->SetBelowRangeColor(0.5, 0.6, 0.7, 0.8);
+  table->UseAboveRangeColorOn();
+  table->SetAboveRangeColor(0.9, 1.0, 0.0, 0.1);
+
+  table->SetTableRange(10.0, 200.0);
+  table->Build();
+  std::vector<unsigned char> bytes(20000);
+  for (size_t i = 0; i < bytes.size(); ++i)
+    {
+    bytes[i] = static_cast<unsigned char>((i * 37) % 256);
+    }
+  TestAssert(TestBulkMapping(table.GetPointer(), bytes,
+                             VTK_UNSIGNED_CHAR, 2));
+
+  table->SetTableRange(-1000.0, 30000.0);
+  table->Build();
+  std::vector<short> shorts(300000);
+  for (size_t i = 0; i < shorts.size(); ++i)
+    {
+    shorts[i] = static_cast<short>((i * 7919) % 65536 - 32768);
+    }
+  TestAssert(TestBulkMapping(table.GetPointer(), shorts, VTK_SHORT, 1));
+
+  table->SetTableRange(-1.0, 1.0);
+  table->Build();
+  std::vector<float> floats(100000);
+  for (size_t i = 0; i < floats.size(); ++i)
+    {
+    floats[i] = static_cast<float>(i % 1001) / 400.0f - 1.25f;
+    }
+  floats[17] = static_cast<float>(vtkMath::Nan());
+  TestAssert(TestBulkMapping(table.GetPointer(), floats, VTK_FLOAT, 1));
+
+  // Only positive values: negative values are clamped to the first table
+  // color by the log scale rather than given the below range color.
+  table->SetScaleToLog10();
+  table->SetTableRange(0.01, 1.0);
+  table->Build();
+  std::vector<double> doubles(100000);
+  for (size_t i = 0; i < doubles.size(); ++i)
+    {
+    doubles[i] = 0.001 + static_cast<double>(i % 1001) / 500.0;
+    }
+  doubles[23] = vtkMath::Nan();
+  TestAssert(TestBulkMapping(table.GetPointer(), doubles, VTK_DOUBLE, 1));
+
   return rval;
 }
@@ -0,0 +1,148 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPAlgorithms.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+
+#include <functional>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return false;                                                     \
+    }
+
+namespace
+{
+struct Square
+{
+  vtkIdType operator()(vtkIdType x) const { return x * x; }
+};
+
+// Not commutative: checks that blocks are combined in order.
+struct Concatenate
+{
+  std::pair<vtkIdType, vtkIdType> operator()(
+    const std::pair<vtkIdType, vtkIdType>& a,
+    const std::pair<vtkIdType, vtkIdType>& b) const
+  {
+    // Represents the range [first, second); only adjacent ranges combine.
+    if (a.second != b.first)
+      {
+      return std::make_pair(vtkIdType(-1), vtkIdType(-1));
+      }
+    return std::make_pair(a.first, b.second);
+  }
+};
+
+bool TestSize(vtkIdType n)
+{
+  std::vector<vtkIdType> values(n);
+  vtkSMPTools::Fill(values.begin(), values.end(), vtkIdType(3));
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    TEST_ASSERT(values[i] == 3, "Fill failed at " << i);
+    }
+
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    values[i] = i;
+    }
+  std::vector<vtkIdType> squares(n);
+  vtkSMPTools::Transform(values.begin(), values.end(), squares.begin(),
+                         Square());
+  std::vector<vtkIdType> sums(n);
+  vtkSMPTools::Transform(values.begin(), values.end(), squares.begin(),
+                         sums.begin(), std::plus<vtkIdType>());
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    TEST_ASSERT(squares[i] == i * i && sums[i] == i * i + i,
+                "Transform failed at " << i);
+    }
+
+  vtkIdType total = vtkSMPTools::Reduce(values.begin(), values.end(),
+                                        vtkIdType(7));
+  TEST_ASSERT(total == 7 + n * (n - 1) / 2,
+              "Reduce failed for " << n << ": " << total);
+
+  std::vector<std::pair<vtkIdType, vtkIdType> > ranges(n);
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    ranges[i] = std::make_pair(i + 1, i + 2);
+    }
+  std::pair<vtkIdType, vtkIdType> range = vtkSMPTools::Reduce(
+    ranges.begin(), ranges.end(), std::make_pair(vtkIdType(0), vtkIdType(1)),
+    Concatenate());
+  TEST_ASSERT(range.first == 0 && range.second == n + 1,
+              "Ordered Reduce failed for " << n);
+
+  std::vector<vtkIdType> scan(n);
+  vtkSMPTools::InclusiveScan(values.begin(), values.end(), scan.begin());
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    TEST_ASSERT(scan[i] == i * (i + 1) / 2, "InclusiveScan failed at " << i);
+    }
+
+  // Count then fill: in-place exclusive scan of the counts.
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(n);
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    offsets->SetValue(i, i % 3);
+    }
+  vtkIdType *ptr = offsets->GetPointer(0);
+  vtkIdType size = vtkSMPTools::ExclusiveScan(ptr, ptr + n, ptr, vtkIdType(0));
+  vtkIdType expected = 0;
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    TEST_ASSERT(ptr[i] == expected, "ExclusiveScan failed at " << i);
+    expected += i % 3;
+    }
+  TEST_ASSERT(size == expected, "Bad ExclusiveScan total: " << size);
+
+  std::vector<std::pair<vtkIdType, vtkIdType> > rangeScan(n);
+  range = vtkSMPTools::ExclusiveScan(ranges.begin(), ranges.end(),
+    rangeScan.begin(), std::make_pair(vtkIdType(0), vtkIdType(1)),
+    Concatenate());
+  TEST_ASSERT(range.first == 0 && range.second == n + 1,
+              "Ordered ExclusiveScan failed for " << n);
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    TEST_ASSERT(rangeScan[i].first == 0 && rangeScan[i].second == i + 1,
+                "Ordered ExclusiveScan failed at " << i);
+    }
+  return true;
+}
+}
+
+int TestSMPAlgorithms(int, char *[])
+{
+  vtkSMPTools::Initialize(2);
+
+  // Empty, single block and multiple blocks of uneven sizes.
+  const vtkIdType sizes[] = { 0, 1, 17, 1024, 100003, 1000000 };
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+    if (!TestSize(sizes[i]))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPRadixSort.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return false;                                                     \
+    }
+
+namespace
+{
+// Small deterministic generator, so that failures are reproducible.
+vtkTypeUInt32 Seed = 12345;
+vtkTypeUInt32 NextRandom()
+{
+  Seed = Seed * 1664525u + 1013904223u;
+  return Seed;
+}
+
+struct Tuple
+{
+  int Id;
+  int Bucket;
+};
+
+bool TupleLess(const Tuple& a, const Tuple& b)
+{
+  return a.Bucket < b.Bucket;
+}
+
+template <typename T>
+bool TestKeys(const std::vector<T>& input, const char* name)
+{
+  std::vector<T> expected(input);
+  std::sort(expected.begin(), expected.end());
+  std::vector<T> keys(input);
+  if (!keys.empty())
+    {
+    vtkSMPTools::RadixSort(&keys[0], &keys[0] + keys.size());
+    }
+  TEST_ASSERT(keys == expected, "Bad " << name << " sort of "
+              << input.size() << " keys");
+  return true;
+}
+
+bool TestSize(vtkIdType n)
+{
+  std::vector<int> ints(n);
+  std::vector<unsigned char> bytes(n);
+  std::vector<vtkTypeInt64> longs(n);
+  std::vector<float> floats(n);
+  std::vector<double> doubles(n);
+  std::vector<vtkIdType> ids(n);
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    vtkTypeUInt32 r = NextRandom();
+    ints[i] = static_cast<int>(r);
+    bytes[i] = static_cast<unsigned char>(r >> 24);
+    longs[i] = (static_cast<vtkTypeInt64>(r) << 20) - (vtkTypeInt64(1) << 50);
+    floats[i] = (static_cast<float>(r % 20001) - 10000.0f) / 7.0f;
+    doubles[i] = (static_cast<double>(r) - 2147483648.0) * 1.0e-3;
+    // Small keys: only the low bytes need a pass.
+    ids[i] = static_cast<vtkIdType>(r % 1000);
+    }
+  if (!TestKeys(ints, "int") || !TestKeys(bytes, "unsigned char") ||
+      !TestKeys(longs, "64 bit") || !TestKeys(floats, "float") ||
+      !TestKeys(doubles, "double") || !TestKeys(ids, "id"))
+    {
+    return false;
+    }
+
+  // Key/value sort must be stable.
+  std::vector<vtkIdType> keys(ids);
+  std::vector<vtkIdType> values(n);
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    values[i] = i;
+    }
+  if (n > 0)
+    {
+    vtkSMPTools::RadixSort(&keys[0], &keys[0] + n, &values[0]);
+    }
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    TEST_ASSERT(ids[values[i]] == keys[i], "Values do not follow keys at " << i);
+    TEST_ASSERT(i == 0 || keys[i - 1] < keys[i] || values[i - 1] < values[i],
+                "Key/value sort is not stable at " << i);
+    }
+
+  // Sort of structures by a data member, also stable.
+  std::vector<Tuple> tuples(n);
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    tuples[i].Id = static_cast<int>(i);
+    tuples[i].Bucket = static_cast<int>(ids[i]) - 500;
+    }
+  std::vector<Tuple> expected(tuples);
+  std::stable_sort(expected.begin(), expected.end(), TupleLess);
+  if (n > 0)
+    {
+    vtkSMPTools::RadixSort(&tuples[0], &tuples[0] + n, &Tuple::Bucket);
+    }
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    TEST_ASSERT(tuples[i].Id == expected[i].Id &&
+                tuples[i].Bucket == expected[i].Bucket,
+                "Bad sort of structures at " << i);
+    }
+
+  // All keys equal: nothing to do.
+  std::vector<int> same(n, -3);
+  return TestKeys(same, "constant");
+}
+}
+
+int TestSMPRadixSort(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  const vtkIdType sizes[] = { 0, 1, 2, 31, 33, 1000, 100000, 1000003 };
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+    if (!TestSize(sizes[i]))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,197 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPScope.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPTools.h"
+#include "vtkSMPThreadLocal.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const vtkIdType Size = 1000;
+
+// Records what the functors see of the scope of their caller.
+class ScopeProbe
+{
+public:
+  vtkSMPThreadLocal<int> Errors;
+  int ExpectedThreads;
+
+  ScopeProbe(int expectedThreads)
+    : Errors(0), ExpectedThreads(expectedThreads)
+  {
+  }
+
+  void operator()(vtkIdType, vtkIdType)
+  {
+    if (!vtkSMPTools::IsParallelScope() ||
+        vtkSMPTools::GetScopeNumberOfThreads() != this->ExpectedThreads ||
+        vtkSMPTools::GetEstimatedNumberOfThreads() > this->ExpectedThreads)
+      {
+      ++this->Errors.Local();
+      }
+  }
+
+  int GetNumberOfErrors()
+  {
+    int errors = 0;
+    for (vtkSMPThreadLocal<int>::iterator it = this->Errors.begin();
+         it != this->Errors.end(); ++it)
+      {
+      errors += *it;
+      }
+    return errors;
+  }
+};
+
+// Starts a nested loop from each range of the outer loop.
+class NestedLoop
+{
+public:
+  std::vector<vtkIdType>& Sums;
+  vtkSMPThreadLocal<int> Errors;
+
+  NestedLoop(std::vector<vtkIdType>& sums) : Sums(sums), Errors(0)
+  {
+  }
+
+  struct Inner
+  {
+    vtkIdType Row;
+    vtkIdType Sum;
+    int Errors;
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      if (!vtkSMPTools::IsParallelScope())
+        {
+        ++this->Errors;
+        }
+      for (vtkIdType i = begin; i < end; ++i)
+        {
+        this->Sum += this->Row + i;
+        }
+    }
+  };
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType row = begin; row < end; ++row)
+      {
+      // Nesting is disabled: the inner loop runs on this thread, so the
+      // unsynchronized accumulation in Inner is safe.
+      Inner inner = { row, 0, 0 };
+      vtkSMPTools::For(0, Size, 10, inner);
+      this->Sums[row] = inner.Sum;
+      this->Errors.Local() += inner.Errors;
+      }
+  }
+};
+}
+
+int TestSMPScope(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+  const int defaultThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+
+  if (vtkSMPTools::IsParallelScope() ||
+      vtkSMPTools::GetScopeNumberOfThreads() != 0 ||
+      !vtkSMPTools::GetNestedParallelism())
+    {
+    std::cerr << "Bad default scope." << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  {
+  vtkSMPTools::Scope scope(3, false);
+  if (vtkSMPTools::GetScopeNumberOfThreads() != 3 ||
+      vtkSMPTools::GetNestedParallelism() ||
+      vtkSMPTools::GetEstimatedNumberOfThreads() > 3)
+    {
+    std::cerr << "Scope settings were not applied." << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  ScopeProbe probe(3);
+  vtkSMPTools::For(0, Size, 1, probe);
+  if (probe.GetNumberOfErrors() != 0)
+    {
+    std::cerr << "Functors did not see the scope of their caller."
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::vector<vtkIdType> sums(Size);
+  NestedLoop nested(sums);
+  vtkSMPTools::For(0, Size, nested);
+  int errors = 0;
+  for (vtkSMPThreadLocal<int>::iterator it = nested.Errors.begin();
+       it != nested.Errors.end(); ++it)
+    {
+    errors += *it;
+    }
+  if (errors != 0)
+    {
+    std::cerr << "Nested loops did not run inside the outer loop."
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+  for (vtkIdType row = 0; row < Size; ++row)
+    {
+    if (sums[row] != row * Size + Size * (Size - 1) / 2)
+      {
+      std::cerr << "Bad nested sum for row " << row << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+    {
+    // A single thread scope runs everything on the calling thread.
+    vtkSMPTools::Scope serial(1);
+    ScopeProbe serialProbe(1);
+    vtkSMPTools::For(0, Size, 1, serialProbe);
+    if (serialProbe.GetNumberOfErrors() != 0 ||
+        vtkSMPTools::GetEstimatedNumberOfThreads() != 1)
+      {
+      std::cerr << "Serial scope failed." << std::endl;
+      return EXIT_FAILURE;
+      }
+    std::vector<vtkIdType> values(Size, 1);
+    if (vtkSMPTools::Reduce(values.begin(), values.end(), vtkIdType(0)) !=
+        Size)
+      {
+      std::cerr << "Reduce failed in a serial scope." << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  if (vtkSMPTools::GetScopeNumberOfThreads() != 3)
+    {
+    std::cerr << "Inner scope did not restore its parent." << std::endl;
+    return EXIT_FAILURE;
+    }
+  }
+
+  if (vtkSMPTools::GetScopeNumberOfThreads() != 0 ||
+      !vtkSMPTools::GetNestedParallelism() ||
+      vtkSMPTools::GetEstimatedNumberOfThreads() != defaultThreads)
+    {
+    std::cerr << "Scope was not restored." << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPThreadIndex.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkIntArray.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const vtkIdType Size = 100000;
+
+// Counts the iterations with Local(int) and checks it agrees with Local().
+class IndexedCounter
+{
+public:
+  vtkSMPThreadLocal<vtkIdType> Counter;
+  vtkSMPThreadLocal<int> Errors;
+  vtkSMPThreadLocalObject<vtkIntArray> Arrays;
+
+  IndexedCounter() : Counter(0), Errors(0)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    int threadIndex = vtkSMPTools::GetThreadIndex();
+    vtkIdType& count = this->Counter.Local(threadIndex);
+    if (threadIndex < 0 || &count != &this->Counter.Local() ||
+        this->Arrays.Local(threadIndex) != this->Arrays.Local())
+      {
+      ++this->Errors.Local();
+      }
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      ++count;
+      }
+    this->Arrays.Local(threadIndex)->InsertNextValue(
+      static_cast<int>(end - begin));
+    if (vtkSMPTools::GetThreadIndex() != threadIndex)
+      {
+      ++this->Errors.Local(threadIndex);
+      }
+  }
+};
+}
+
+int TestSMPThreadIndex(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  IndexedCounter functor;
+  vtkSMPTools::For(0, Size, 100, functor);
+
+  int errors = 0;
+  for (vtkSMPThreadLocal<int>::iterator it = functor.Errors.begin();
+       it != functor.Errors.end(); ++it)
+    {
+    errors += *it;
+    }
+  if (errors != 0)
+    {
+    std::cerr << "Local(int) did not return the object of the calling thread."
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkIdType total = 0;
+  for (vtkSMPThreadLocal<vtkIdType>::iterator it = functor.Counter.begin();
+       it != functor.Counter.end(); ++it)
+    {
+    total += *it;
+    }
+  vtkIdType arrayTotal = 0;
+  for (vtkSMPThreadLocalObject<vtkIntArray>::iterator it =
+         functor.Arrays.begin(); it != functor.Arrays.end(); ++it)
+    {
+    for (vtkIdType i = 0; i < (*it)->GetNumberOfTuples(); ++i)
+      {
+      arrayTotal += (*it)->GetValue(i);
+      }
+    }
+  if (total != Size || arrayTotal != Size)
+    {
+    std::cerr << "Bad totals: " << total << " " << arrayTotal << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSOADataArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkDataArrayIteratorMacro.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <iostream>
+#include <numeric>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+namespace
+{
+template <class Iterator>
+double SumValues(Iterator begin, Iterator end)
+{
+  return std::accumulate(begin, end, 0.0);
+}
+}
+
+int TestSOADataArray(int, char *[])
+{
+  const vtkIdType numTuples = 1000;
+  const int numComps = 3;
+
+  // Hand three separate user buffers to the array.
+  float *x = new float[numTuples];
+  float *y = new float[numTuples];
+  float *z = new float[numTuples];
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    x[t] = static_cast<float>(t);
+    y[t] = static_cast<float>(2 * t);
+    z[t] = static_cast<float>(3 * t);
+    }
+
+  vtkNew<vtkSOADataArrayTemplate<float> > soa;
+  soa->SetNumberOfComponents(numComps);
+  soa->SetArray(0, x, numTuples, false, true);
+  soa->SetArray(1, y, numTuples, false, true);
+  soa->SetArray(2, z, numTuples, true, true);
+
+  TEST_ASSERT(soa->GetNumberOfTuples() == numTuples,
+              "Bad number of tuples: " << soa->GetNumberOfTuples());
+  TEST_ASSERT(soa->GetComponentArrayPointer(1) == y,
+              "Component buffer was copied.");
+  TEST_ASSERT(vtkSOADataArrayTemplate<float>::FastDownCast(
+                soa.GetPointer()) == soa.GetPointer(), "FastDownCast failed.");
+  TEST_ASSERT(vtkSOADataArrayTemplate<double>::FastDownCast(
+                soa.GetPointer()) == NULL, "FastDownCast type check failed.");
+  TEST_ASSERT(vtkTypedDataArray<float>::FastDownCast(soa.GetPointer()) != NULL,
+              "vtkTypedDataArray::FastDownCast failed.");
+
+  // Value access uses the interleaved ordering.
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    for (int c = 0; c < numComps; ++c)
+      {
+      float expected = static_cast<float>((c + 1) * t);
+      TEST_ASSERT(soa->GetValue(t * numComps + c) == expected,
+                  "GetValue mismatch at " << t << ", " << c);
+      TEST_ASSERT(soa->GetComponent(t, c) == expected,
+                  "GetComponent mismatch at " << t << ", " << c);
+      }
+    }
+
+  // Iterators visit all components of a tuple before the next tuple.
+  vtkSOADataArrayTemplate<float>::Iterator it = soa->Begin();
+  TEST_ASSERT(soa->End() - soa->Begin() == numTuples * numComps,
+              "Bad iterator distance.");
+  TEST_ASSERT(*(it + 4) == 2.f && it[5] == 3.f, "Bad iterator offset.");
+  ++it; ++it; ++it;
+  TEST_ASSERT(it.GetTupleIndex() == 1 && it.GetComponentIndex() == 0,
+              "Iterator increment did not wrap components.");
+
+  // vtkDataArrayIteratorMacro must select the SOA iterator.
+  double expectedSum = 6.0 * (numTuples * (numTuples - 1) / 2);
+  double sum = 0.0;
+  switch (soa->GetDataType())
+    {
+    vtkDataArrayIteratorMacro(soa.GetPointer(),
+                              sum = SumValues(vtkDABegin, vtkDAEnd));
+    }
+  TEST_ASSERT(sum == expectedSum, "Macro sum " << sum << " != " << expectedSum);
+
+  // Growing copies the user buffers, which must be left untouched.
+  soa->InsertNextTuple3(-1., -2., -3.);
+  TEST_ASSERT(soa->GetNumberOfTuples() == numTuples + 1, "Insert failed.");
+  TEST_ASSERT(soa->GetComponentArrayPointer(0) != x, "Saved buffer reused.");
+  TEST_ASSERT(soa->GetComponent(numTuples, 2) == -3. &&
+              soa->GetComponent(numTuples - 1, 1) == 2. * (numTuples - 1),
+              "Bad values after growth.");
+
+  soa->RemoveTuple(0);
+  TEST_ASSERT(soa->GetNumberOfTuples() == numTuples &&
+              soa->GetComponent(0, 2) == 3.f, "RemoveTuple failed.");
+
+  // Round trip through a standard array.
+  vtkNew<vtkFloatArray> aos;
+  aos->DeepCopy(soa.GetPointer());
+  TEST_ASSERT(aos->GetNumberOfComponents() == numComps &&
+              aos->GetNumberOfTuples() == numTuples, "AOS DeepCopy failed.");
+  TEST_ASSERT(aos->GetValue(3 * 10 + 1) == soa->GetValue(3 * 10 + 1),
+              "AOS DeepCopy values differ.");
+  double *range = aos->GetRange(2);
+  double *soaRange = soa->GetRange(2);
+  TEST_ASSERT(range[0] == soaRange[0] && range[1] == soaRange[1],
+              "Range mismatch.");
+
+  vtkNew<vtkSOADataArrayTemplate<float> > copy;
+  copy->DeepCopy(aos.GetPointer());
+  TEST_ASSERT(copy->GetNumberOfComponents() == numComps &&
+              copy->GetNumberOfTuples() == numTuples, "SOA DeepCopy failed.");
+  for (vtkIdType i = 0; i < numTuples * numComps; ++i)
+    {
+    TEST_ASSERT(copy->GetValue(i) == aos->GetValue(i),
+                "SOA DeepCopy mismatch at " << i);
+    }
+
+  // Interpolation.
+  vtkNew<vtkIdList> ids;
+  ids->InsertNextId(0);
+  ids->InsertNextId(1);
+  double weights[2] = { 0.5, 0.5 };
+  copy->InterpolateTuple(numTuples, ids.GetPointer(), soa.GetPointer(),
+                         weights);
+  TEST_ASSERT(copy->GetNumberOfTuples() == numTuples + 1 &&
+              copy->GetComponent(numTuples, 0) == 1.5f,
+              "InterpolateTuple failed: " << copy->GetComponent(numTuples, 0));
+
+  // Single component arrays expose their buffer without copying.
+  vtkNew<vtkSOADataArrayTemplate<double> > scalars;
+  scalars->SetNumberOfTuples(10);
+  for (vtkIdType t = 0; t < 10; ++t)
+    {
+    scalars->SetValue(t, static_cast<double>(t));
+    }
+  TEST_ASSERT(scalars->HasStandardMemoryLayout(), "Expected standard layout.");
+  TEST_ASSERT(scalars->GetVoidPointer(0) ==
+              scalars->GetComponentArrayPointer(0), "GetVoidPointer copied.");
+
+  delete [] x;
+  delete [] y;
+  delete [] z;
+
+  return EXIT_SUCCESS;
+}
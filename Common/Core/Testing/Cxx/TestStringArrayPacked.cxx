@@ -0,0 +1,199 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStringArrayPacked.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the packed and dictionary encoded storage of vtkStringArray.
+
+#include "vtkCharArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkStringArray.h"
+#include "vtkVariant.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return false;                                                     \
+    }
+
+namespace
+{
+const vtkIdType NumberOfValues = 1000;
+
+vtkStdString ExpectedValue(vtkIdType i)
+{
+  // A few distinct strings, including an empty one.
+  std::ostringstream value;
+  if (i % 7)
+    {
+    value << "category " << (i % 7);
+    }
+  return value.str();
+}
+
+bool CheckValues(vtkStringArray* array, int mode, const char* name)
+{
+  TEST_ASSERT(array->GetNumberOfValues() == NumberOfValues,
+              name << ": bad number of values");
+  TEST_ASSERT(array->GetStorageMode() == mode, name << ": bad storage mode");
+  for (vtkIdType i = 0; i < NumberOfValues; ++i)
+    {
+    vtkIdType length;
+    const char* data = array->GetValueData(i, length);
+    TEST_ASSERT(vtkStdString(data, length) == ExpectedValue(i),
+                name << ": bad value " << i);
+    }
+  TEST_ASSERT(array->GetVariantValue(3).ToString() == ExpectedValue(3),
+              name << ": bad variant value");
+  TEST_ASSERT(array->LookupValue(ExpectedValue(5)) == 5,
+              name << ": bad lookup");
+  vtkNew<vtkIdList> ids;
+  array->LookupValue(ExpectedValue(0), ids.GetPointer());
+  TEST_ASSERT(ids->GetNumberOfIds() == (NumberOfValues + 6) / 7,
+              name << ": bad lookup of all values");
+
+  // Reading values must not unpack the array.
+  TEST_ASSERT(array->GetStorageMode() == mode, name << ": unpacked by reads");
+  return true;
+}
+
+bool TestPackedStorage()
+{
+  vtkNew<vtkStringArray> array;
+  for (vtkIdType i = 0; i < NumberOfValues; ++i)
+    {
+    array->InsertNextValue(ExpectedValue(i));
+    }
+  if (!CheckValues(array.GetPointer(), vtkStringArray::STRING_STORAGE,
+                   "strings"))
+    {
+    return false;
+    }
+
+  array->Pack();
+  if (!CheckValues(array.GetPointer(), vtkStringArray::PACKED_STORAGE,
+                   "packed"))
+    {
+    return false;
+    }
+  TEST_ASSERT(array->GetPackedCodes() == NULL, "Codes without dictionary");
+  TEST_ASSERT(array->GetPackedOffsets()->GetMaxId() == NumberOfValues,
+              "Bad number of offsets");
+
+  array->Pack(1);
+  if (!CheckValues(array.GetPointer(), vtkStringArray::PACKED_STORAGE,
+                   "dictionary"))
+    {
+    return false;
+    }
+  TEST_ASSERT(array->GetPackedOffsets()->GetMaxId() == 7,
+              "Bad number of dictionary entries");
+  TEST_ASSERT(array->GetPackedCodes()->GetValue(8) == 1,
+              "Codes not in order of first appearance");
+
+  // Copies keep the packed storage.
+  vtkNew<vtkStringArray> copy;
+  copy->DeepCopy(array.GetPointer());
+  if (!CheckValues(copy.GetPointer(), vtkStringArray::PACKED_STORAGE,
+                   "deep copy"))
+    {
+    return false;
+    }
+  vtkNew<vtkStringArray> tuples;
+  tuples->SetNumberOfValues(NumberOfValues);
+  for (vtkIdType i = 0; i < NumberOfValues; ++i)
+    {
+    tuples->SetTuple(i, i, array.GetPointer());
+    }
+  if (!CheckValues(tuples.GetPointer(), vtkStringArray::STRING_STORAGE,
+                   "tuple copy"))
+    {
+    return false;
+    }
+  TEST_ASSERT(array->GetStorageMode() == vtkStringArray::PACKED_STORAGE,
+              "Source unpacked by tuple copy");
+
+  // Modifying the array unpacks it.
+  array->SetValue(2, "changed");
+  TEST_ASSERT(array->GetStorageMode() == vtkStringArray::STRING_STORAGE,
+              "Not unpacked by SetValue");
+  TEST_ASSERT(array->GetValue(2) == "changed" &&
+              array->GetValue(9) == ExpectedValue(9), "Bad unpacked values");
+  TEST_ASSERT(array->LookupValue("changed") == 2, "Bad lookup after change");
+  return true;
+}
+
+bool TestSharedPackedData()
+{
+  // Two entries, "ab" and "cde", used by three values.
+  vtkNew<vtkCharArray> chars;
+  const char text[] = "abcde";
+  for (int i = 0; i < 5; ++i)
+    {
+    chars->InsertNextValue(text[i]);
+    }
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->InsertNextValue(0);
+  offsets->InsertNextValue(2);
+  offsets->InsertNextValue(5);
+  vtkNew<vtkIdTypeArray> codes;
+  codes->InsertNextValue(1);
+  codes->InsertNextValue(0);
+  codes->InsertNextValue(1);
+
+  vtkNew<vtkStringArray> array;
+  array->SetPackedData(chars.GetPointer(), offsets.GetPointer(),
+                       codes.GetPointer());
+  TEST_ASSERT(array->GetNumberOfValues() == 3, "Bad shared size");
+  TEST_ASSERT(array->GetPackedCharacters() == chars.GetPointer(),
+              "Packed data copied");
+  TEST_ASSERT(array->GetVariantValue(0).ToString() == "cde" &&
+              array->GetVariantValue(1).ToString() == "ab",
+              "Bad shared values");
+
+  vtkNew<vtkIdList> ids;
+  array->LookupValue("cde", ids.GetPointer());
+  TEST_ASSERT(ids->GetNumberOfIds() == 2 && ids->GetId(0) == 0 &&
+              ids->GetId(1) == 2, "Bad shared lookup");
+
+  array->InsertNextValue("f");
+  TEST_ASSERT(array->GetNumberOfValues() == 4 && array->GetValue(2) == "cde" &&
+              array->GetValue(3) == "f", "Bad insertion after unpack");
+  TEST_ASSERT(array->GetPackedCharacters() == NULL, "Packed data kept");
+
+  array->SetPackedData(chars.GetPointer(), offsets.GetPointer());
+  TEST_ASSERT(array->GetNumberOfValues() == 2 &&
+              array->GetVariantValue(1).ToString() == "cde",
+              "Bad packed data without codes");
+  array->Initialize();
+  TEST_ASSERT(array->GetNumberOfValues() == 0 &&
+              array->GetStorageMode() == vtkStringArray::STRING_STORAGE,
+              "Bad Initialize");
+  return true;
+}
+}
+
+int TestStringArrayPacked(int, char *[])
+{
+  if (!TestPackedStorage() || !TestSharedPackedData())
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
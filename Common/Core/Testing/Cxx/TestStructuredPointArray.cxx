@@ -0,0 +1,147 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStructuredPointArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the coordinates computed by vtkStructuredPointArray against the
+// explicit coordinates of the same lattice, through the array accessors,
+// the copies to regular arrays and the bounds of vtkPoints.
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredPointArray.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+int TestStructuredPointArray(int, char *[])
+{
+  // A uniform lattice and its explicit points.
+  const int dims[3] = { 7, 5, 4 };
+  const double origin[3] = { -1.0, 2.0, 0.5 };
+  const double spacing[3] = { 0.25, -2.0, 3.0 };
+  vtkNew<vtkStructuredPointArray<double> > coords;
+  coords->SetUniformAxes(dims, origin, spacing);
+  vtkNew<vtkDoubleArray> expected;
+  expected->SetNumberOfComponents(3);
+  for (int k = 0; k < dims[2]; ++k)
+    {
+    for (int j = 0; j < dims[1]; ++j)
+      {
+      for (int i = 0; i < dims[0]; ++i)
+        {
+        expected->InsertNextTuple3(origin[0] + i * spacing[0],
+                                   origin[1] + j * spacing[1],
+                                   origin[2] + k * spacing[2]);
+        }
+      }
+    }
+
+  const vtkIdType numTuples = expected->GetNumberOfTuples();
+  TEST_ASSERT(coords->GetNumberOfTuples() == numTuples &&
+              coords->GetNumberOfComponents() == 3,
+              "Bad number of tuples " << coords->GetNumberOfTuples());
+  double tuple[3];
+  double values[3];
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    coords->GetTuple(t, tuple);
+    coords->GetTupleValue(t, values);
+    for (int c = 0; c < 3; ++c)
+      {
+      const double value = expected->GetComponent(t, c);
+      TEST_ASSERT(tuple[c] == value && values[c] == value &&
+                  coords->GetValue(3 * t + c) == value &&
+                  coords->GetValueReference(3 * t + c) == value &&
+                  coords->GetTuple(t)[c] == value,
+                  "Bad component " << c << " of tuple " << t);
+      }
+    }
+  TEST_ASSERT(coords->LookupTypedValue(origin[2] + spacing[2]) ==
+              3 * dims[0] * dims[1] + 2, "Bad lookup");
+
+  // Copies to regular arrays, as made by filters through the vtkDataArray
+  // API.
+  vtkDataArray *da = coords.GetPointer();
+  vtkSmartPointer<vtkDataArray> copy =
+    vtkSmartPointer<vtkDataArray>::Take(da->NewInstance());
+  TEST_ASSERT(copy->HasStandardMemoryLayout(), "NewInstance is not regular");
+  copy->DeepCopy(coords.GetPointer());
+  vtkNew<vtkIdList> ids;
+  ids->InsertNextId(numTuples - 1);
+  ids->InsertNextId(8);
+  vtkNew<vtkDoubleArray> subset;
+  subset->SetNumberOfComponents(3);
+  subset->SetNumberOfTuples(2);
+  coords->GetTuples(ids.GetPointer(), subset.GetPointer());
+  for (int c = 0; c < 3; ++c)
+    {
+    TEST_ASSERT(copy->GetComponent(11, c) == expected->GetComponent(11, c),
+                "Bad deep copy");
+    TEST_ASSERT(subset->GetComponent(0, c) ==
+                expected->GetComponent(numTuples - 1, c) &&
+                subset->GetComponent(1, c) == expected->GetComponent(8, c),
+                "Bad tuples");
+    }
+
+  // The bounds of points are the ranges of the axes.
+  vtkNew<vtkPoints> points;
+  points->SetData(coords.GetPointer());
+  double bounds[6];
+  points->GetBounds(bounds);
+  const double expectedBounds[6] = { -1.0, 0.5, -6.0, 2.0, 0.5, 9.5 };
+  for (int i = 0; i < 6; ++i)
+    {
+    TEST_ASSERT(bounds[i] == expectedBounds[i], "Bad bound " << i);
+    }
+
+  // Axes of a rectilinear grid, converted to the scalar type.
+  vtkNew<vtkFloatArray> x, y, z;
+  x->InsertNextValue(0.0f);
+  x->InsertNextValue(0.5f);
+  x->InsertNextValue(2.0f);
+  y->InsertNextValue(-3.0f);
+  z->InsertNextValue(1.0f);
+  z->InsertNextValue(4.0f);
+  vtkNew<vtkStructuredPointArray<float> > rectCoords;
+  rectCoords->SetAxes(x.GetPointer(), y.GetPointer(), z.GetPointer());
+  TEST_ASSERT(rectCoords->GetNumberOfTuples() == 6 &&
+              rectCoords->GetDimensions()[0] == 3 &&
+              rectCoords->GetAxis(2)[1] == 4.0f, "Bad rectilinear axes");
+  rectCoords->GetTuple(5, tuple);
+  TEST_ASSERT(tuple[0] == 2.0 && tuple[1] == -3.0 && tuple[2] == 4.0,
+              "Bad rectilinear tuple");
+
+  // Large lattices take no room.
+  const int largeDims[3] = { 2048, 2048, 2048 };
+  vtkNew<vtkStructuredPointArray<double> > large;
+  large->SetUniformAxes(largeDims, origin, spacing);
+  TEST_ASSERT(large->GetNumberOfTuples() ==
+              static_cast<vtkIdType>(2048) * 2048 * 2048 &&
+              large->GetActualMemorySize() < 64, "Bad large lattice");
+  large->GetTuple(large->GetNumberOfTuples() - 1, tuple);
+  TEST_ASSERT(tuple[0] == origin[0] + 2047 * spacing[0] &&
+              tuple[2] == origin[2] + 2047 * spacing[2], "Bad last tuple");
+
+  return EXIT_SUCCESS;
+}
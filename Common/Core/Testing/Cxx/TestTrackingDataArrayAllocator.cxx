@@ -0,0 +1,103 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTrackingDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkAlignedDataArrayAllocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkTrackingDataArrayAllocator.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+int TestTrackingDataArrayAllocator(int, char *[])
+{
+  vtkNew<vtkAlignedDataArrayAllocator> aligned;
+  vtkDataArrayAllocator::SetInstance(aligned.GetPointer());
+
+  vtkNew<vtkTrackingDataArrayAllocator> tracker;
+  TEST_ASSERT(!tracker->IsTracking(), "Tracking by default");
+  tracker->Start();
+  TEST_ASSERT(tracker->IsTracking() &&
+              vtkDataArrayAllocator::GetInstance() == tracker.GetPointer() &&
+              tracker->GetAllocator() == aligned.GetPointer(),
+              "Tracker not installed in front of the current instance");
+
+  int ownerA = 0;
+  int ownerB = 0;
+  vtkSmartPointer<vtkDoubleArray> a = vtkSmartPointer<vtkDoubleArray>::New();
+  vtkSmartPointer<vtkIntArray> b = vtkSmartPointer<vtkIntArray>::New();
+  tracker->BeginOwner(&ownerA);
+  a->SetNumberOfValues(1000);
+  vtkTypeInt64 aSize = a->GetSize() * sizeof(double);
+  TEST_ASSERT(reinterpret_cast<size_t>(a->GetVoidPointer(0)) % 64 == 0,
+              "Memory not provided by the tracked allocator");
+  TEST_ASSERT(tracker->GetAllocatedSize(&ownerA) == aSize,
+              "Bad owner size");
+
+  // Owners nest, and a block stays charged to the owner that allocated it.
+  tracker->BeginOwner(&ownerB);
+  b->SetNumberOfValues(500);
+  vtkTypeInt64 bSize = b->GetSize() * sizeof(int);
+  a->Resize(4000);
+  vtkTypeInt64 grownSize = a->GetSize() * sizeof(double);
+  tracker->EndOwner();
+  tracker->EndOwner();
+  TEST_ASSERT(tracker->GetAllocatedSize(&ownerA) == grownSize &&
+              tracker->GetPeakAllocatedSize(&ownerA) == grownSize &&
+              tracker->GetAllocatedSize(&ownerB) == bSize,
+              "Bad owner sizes");
+  TEST_ASSERT(tracker->GetAllocatedSize() == grownSize + bSize,
+              "Bad total size");
+
+  // Without an owner, blocks go to the NULL owner.
+  vtkNew<vtkIntArray> unowned;
+  unowned->SetNumberOfValues(100);
+  TEST_ASSERT(tracker->GetAllocatedSize(NULL) ==
+              static_cast<vtkTypeInt64>(unowned->GetSize() * sizeof(int)),
+              "Bad size without an owner");
+
+  // Freed after the tracker stopped, the blocks are still released.
+  tracker->Stop();
+  TEST_ASSERT(!tracker->IsTracking() &&
+              vtkDataArrayAllocator::GetInstance() == aligned.GetPointer(),
+              "Previous instance not restored");
+  vtkNew<vtkDoubleArray> untracked;
+  untracked->SetNumberOfValues(1000);
+  a = NULL;
+  TEST_ASSERT(tracker->GetAllocatedSize(&ownerA) == 0 &&
+              tracker->GetPeakAllocatedSize(&ownerA) == grownSize,
+              "Bad size after free");
+  TEST_ASSERT(tracker->GetPeakAllocatedSize() >= grownSize + bSize,
+              "Bad total peak");
+  tracker->ResetPeaks();
+  TEST_ASSERT(tracker->GetPeakAllocatedSize(&ownerA) == 0 &&
+              tracker->GetPeakAllocatedSize() == tracker->GetAllocatedSize(),
+              "Peaks not reset");
+  b = NULL;
+  TEST_ASSERT(tracker->GetAllocatedSize(&ownerB) == 0,
+              "Bad size after free");
+
+  vtkDataArrayAllocator::SetInstance(NULL);
+  return EXIT_SUCCESS;
+}
@@ -94,6 +94,29 @@ class TestNumpySupport(Testing.vtkTest):
         a[0] = [10.0, 20.0, 30.0]
         self.assertEqual(vtk_arr.GetTuple3(0), (10., 20., 30.))
 
+    def testNumpyOwnership(self):
+        "Test that the VTK array keeps the numpy data it shares."
+        a = numpy.array([[1, 2, 3],[4, 5, 6]], 'd')
+        vtk_arr = numpy_to_vtk(a)
+        self.assertEqual(vtk.buffer_shared(a, vtk_arr), True)
+        del a
+        self.assertEqual(vtk_arr.GetTuple3(1), (4., 5., 6.))
+        # Growing the VTK array moves the values out of the numpy data.
+        vtk_arr.InsertNextTuple3(7, 8, 9)
+        self.assertEqual(vtk_arr.GetTuple3(0), (1., 2., 3.))
+        self.assertEqual(vtk_arr.GetTuple3(2), (7., 8., 9.))
+
+        # The numpy array keeps the VTK array it shares.
+        b = vtk_to_numpy(numpy_to_vtk(numpy.arange(10, dtype='i')))
+        self.assertEqual(b[9], 9)
+
+        # Read-only data is copied.
+        c = numpy.arange(6, dtype='d')
+        c.flags.writeable = False
+        vtk_arr = numpy_to_vtk(c)
+        self.assertEqual(vtk.buffer_shared(c, vtk_arr), False)
+        self.assertEqual(vtk_arr.GetTuple1(5), 5.)
+
     def testNumpyConversion(self):
         "Test that converting data copies data properly."
         # ----------------------------------------
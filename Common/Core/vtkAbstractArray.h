@@ -502,7 +502,8 @@ public:
     DataArray,
     TypedDataArray,
     DataArrayTemplate,
-    MappedDataArray
+    MappedDataArray,
+    SOADataArrayTemplate
     };
 
   // Description:
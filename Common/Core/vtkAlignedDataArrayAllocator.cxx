@@ -0,0 +1,95 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAlignedDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAlignedDataArrayAllocator.h"
+
+#include "vtkObjectFactory.h"
+
+#include <cstdlib>
+
+#if defined(_WIN32)
+# include <malloc.h> // For _aligned_malloc
+#endif
+
+vtkStandardNewMacro(vtkAlignedDataArrayAllocator);
+
+//----------------------------------------------------------------------------
+vtkAlignedDataArrayAllocator::vtkAlignedDataArrayAllocator()
+{
+  this->Alignment = 64;
+}
+
+//----------------------------------------------------------------------------
+vtkAlignedDataArrayAllocator::~vtkAlignedDataArrayAllocator()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkAlignedDataArrayAllocator::SetAlignment(int alignment)
+{
+  if (alignment <= 0 || (alignment & (alignment - 1)) != 0 ||
+      alignment % static_cast<int>(sizeof(void*)) != 0)
+    {
+    vtkErrorMacro("Alignment must be a power of two multiple of "
+                  << sizeof(void*) << ", got " << alignment);
+    return;
+    }
+  if (this->Alignment != alignment)
+    {
+    this->Alignment = alignment;
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+void *vtkAlignedDataArrayAllocator::Allocate(size_t size)
+{
+  // Zero-sized requests must still return a unique, freeable pointer.
+  size = size > 0 ? size : 1;
+#if defined(_WIN32)
+  return _aligned_malloc(size, static_cast<size_t>(this->Alignment));
+#else
+  void *ptr = 0;
+  if (posix_memalign(&ptr, static_cast<size_t>(this->Alignment), size) != 0)
+    {
+    return 0;
+    }
+  return ptr;
+#endif
+}
+
+//----------------------------------------------------------------------------
+void *vtkAlignedDataArrayAllocator::Reallocate(void *ptr, size_t oldSize,
+                                               size_t newSize)
+{
+  // There is no portable aligned realloc.
+  return this->CopyReallocate(ptr, oldSize, newSize);
+}
+
+//----------------------------------------------------------------------------
+void vtkAlignedDataArrayAllocator::Free(void *ptr, size_t)
+{
+#if defined(_WIN32)
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkAlignedDataArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Alignment: " << this->Alignment << "\n";
+}
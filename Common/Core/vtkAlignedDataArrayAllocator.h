@@ -0,0 +1,64 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAlignedDataArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkAlignedDataArrayAllocator - aligned data array memory
+// .SECTION Description
+// vtkAlignedDataArrayAllocator returns blocks whose address is a multiple
+// of Alignment bytes (64 by default, the cache line size of current x86
+// processors and the width of AVX-512 registers). Aligned buffers allow
+// vectorized loops to use aligned loads and stores and avoid tuples
+// straddling cache lines.
+//
+// .SECTION See Also
+// vtkDataArrayAllocator
+
+#ifndef vtkAlignedDataArrayAllocator_h
+#define vtkAlignedDataArrayAllocator_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkDataArrayAllocator.h"
+
+class VTKCOMMONCORE_EXPORT vtkAlignedDataArrayAllocator
+  : public vtkDataArrayAllocator
+{
+public:
+  static vtkAlignedDataArrayAllocator *New();
+  vtkTypeMacro(vtkAlignedDataArrayAllocator, vtkDataArrayAllocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set/Get the alignment in bytes of the returned blocks. The alignment
+  // must be a power of two and a multiple of sizeof(void*); other values
+  // are rejected. The default is 64.
+  virtual void SetAlignment(int alignment);
+  vtkGetMacro(Alignment, int);
+
+//BTX
+  virtual void *Allocate(size_t size);
+  virtual void *Reallocate(void *ptr, size_t oldSize, size_t newSize);
+  virtual void Free(void *ptr, size_t size);
+//ETX
+
+protected:
+  vtkAlignedDataArrayAllocator();
+  ~vtkAlignedDataArrayAllocator();
+
+  int Alignment;
+
+private:
+  vtkAlignedDataArrayAllocator(const vtkAlignedDataArrayAllocator&);  // Not implemented.
+  void operator=(const vtkAlignedDataArrayAllocator&);  // Not implemented.
+};
+
+#endif
@@ -35,32 +35,42 @@ template<> struct vtkByteSwapper<1>
 {
   static inline void Swap(char*) {}
 };
+// The values are swapped in registers, with shifts that compilers turn
+// into byte swap instructions and vectorize over the ranges below.
+static inline vtkTypeUInt32 vtkByteSwap32(vtkTypeUInt32 v)
+{
+  return (v >> 24) | ((v >> 8) & 0xff00U) | ((v << 8) & 0xff0000U) | (v << 24);
+}
 template<> struct vtkByteSwapper<2>
 {
   static inline void Swap(char* data)
     {
-    char one_byte;
-    one_byte = data[0]; data[0] = data[1]; data[1] = one_byte;
+    vtkTypeUInt16 v;
+    memcpy(&v, data, 2);
+    v = static_cast<vtkTypeUInt16>((v >> 8) | (v << 8));
+    memcpy(data, &v, 2);
     }
 };
 template<> struct vtkByteSwapper<4>
 {
   static inline void Swap(char* data)
     {
-    char one_byte;
-    one_byte = data[0]; data[0] = data[3]; data[3] = one_byte;
-    one_byte = data[1]; data[1] = data[2]; data[2] = one_byte;
+    vtkTypeUInt32 v;
+    memcpy(&v, data, 4);
+    v = vtkByteSwap32(v);
+    memcpy(data, &v, 4);
     }
 };
 template<> struct vtkByteSwapper<8>
 {
   static inline void Swap(char* data)
     {
-    char one_byte;
-    one_byte = data[0]; data[0] = data[7]; data[7] = one_byte;
-    one_byte = data[1]; data[1] = data[6]; data[6] = one_byte;
-    one_byte = data[2]; data[2] = data[5]; data[5] = one_byte;
-    one_byte = data[3]; data[3] = data[4]; data[4] = one_byte;
+    vtkTypeUInt32 v[2];
+    memcpy(v, data, 8);
+    vtkTypeUInt32 first = vtkByteSwap32(v[1]);
+    v[1] = vtkByteSwap32(v[0]);
+    v[0] = first;
+    memcpy(data, v, 8);
     }
 };
 
@@ -204,8 +204,13 @@ bool hasValidKey(InfoType info, KeyType key, ComponentKeyType ckey,
     {
     if ( mtime <= info->GetMTime() )
       {
-      info->Get( key )->GetInformationObject(comp)->Get( ckey, range );
-      return true;
+      vtkInformationVector* infoVec = info->Get( key );
+      if ( comp < infoVec->GetNumberOfInformationObjects() &&
+           infoVec->GetInformationObject(comp)->Has( ckey ) )
+        {
+        infoVec->GetInformationObject(comp)->Get( ckey, range );
+        return true;
+        }
       }
     }
   return false;
@@ -215,6 +220,10 @@ bool hasValidKey(InfoType info, KeyType key, ComponentKeyType ckey,
 
 vtkInformationKeyRestrictedMacro(vtkDataArray, COMPONENT_RANGE, DoubleVector, 2);
 vtkInformationKeyRestrictedMacro(vtkDataArray, L2_NORM_RANGE, DoubleVector, 2);
+vtkInformationKeyRestrictedMacro(vtkDataArray, L2_NORM_FINITE_RANGE, DoubleVector, 2);
+vtkInformationKeyMacro(vtkDataArray, PER_FINITE_COMPONENT, InformationVector);
+
+static int vtkDataArrayGlobalCopyOnWrite = 0;
 
 //----------------------------------------------------------------------------
 // Construct object with default tuple dimension (number of components) of 1.
@@ -223,6 +232,8 @@ vtkDataArray::vtkDataArray()
   this->LookupTable = NULL;
   this->Range[0] = 0;
   this->Range[1] = 0;
+  this->FiniteRange[0] = 0;
+  this->FiniteRange[1] = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -270,6 +281,12 @@ void vtkDataArray::DeepCopy(vtkDataArray *da)
     {
     this->Superclass::DeepCopy( da ); // copy Information object
 
+    if (vtkDataArrayGlobalCopyOnWrite && this->ShareValues(da))
+      {
+      this->CopyLookupTable(da);
+      return;
+      }
+
     vtkIdType numTuples = da->GetNumberOfTuples();
     this->NumberOfComponents = da->NumberOfComponents;
     this->SetNumberOfTuples(numTuples);
@@ -296,17 +313,55 @@ void vtkDataArray::DeepCopy(vtkDataArray *da)
         }
       }
 
-    this->SetLookupTable(0);
-    if (da->LookupTable)
-      {
-      this->LookupTable = da->LookupTable->NewInstance();
-      this->LookupTable->DeepCopy(da->LookupTable);
-      }
+    this->CopyLookupTable(da);
     }
 
   this->Squeeze();
 }
 
+//----------------------------------------------------------------------------
+void vtkDataArray::ShallowCopy(vtkDataArray *other)
+{
+  if (other && other != this && this->ShareValues(other))
+    {
+    this->Superclass::DeepCopy(other); // copy Information object
+    this->CopyLookupTable(other);
+    }
+  else
+    {
+    this->DeepCopy(other);
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataArray::ShareValues(vtkDataArray *)
+{
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArray::CopyLookupTable(vtkDataArray *da)
+{
+  this->SetLookupTable(0);
+  if (da->LookupTable)
+    {
+    this->LookupTable = da->LookupTable->NewInstance();
+    this->LookupTable->DeepCopy(da->LookupTable);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArray::SetGlobalCopyOnWrite(int val)
+{
+  vtkDataArrayGlobalCopyOnWrite = val;
+}
+
+//----------------------------------------------------------------------------
+int vtkDataArray::GetGlobalCopyOnWrite()
+{
+  return vtkDataArrayGlobalCopyOnWrite;
+}
+
 //----------------------------------------------------------------------------
 // These can be overridden for more efficiency
 double vtkDataArray::GetComponent(vtkIdType i, int j)
@@ -572,7 +627,17 @@ void vtkDataArray::SetLookupTable(vtkLookupTable* lut)
       {
       this->LookupTable->Register(this);
       }
+
+    // Changing the lookup table does not change the values: keep the cached
+    // ranges valid if they were up to date.
+    vtkInformation* info =
+      this->HasInformation() ? this->GetInformation() : NULL;
+    const bool rangesValid = info && this->GetMTime() <= info->GetMTime();
     this->Modified();
+    if (rangesValid)
+      {
+      info->Modified();
+      }
     }
 }
 
@@ -1111,6 +1176,14 @@ int vtkDataArray::CopyInformation(vtkInformation* infoFrom, int deep)
     {
     myInfo->Remove( L2_NORM_RANGE() );
     }
+  if (myInfo->Has( L2_NORM_FINITE_RANGE() ))
+    {
+    myInfo->Remove( L2_NORM_FINITE_RANGE() );
+    }
+  if (myInfo->Has( PER_FINITE_COMPONENT() ))
+    {
+    myInfo->Remove( PER_FINITE_COMPONENT() );
+    }
 
   return 1;
 }
@@ -1118,8 +1191,18 @@ int vtkDataArray::CopyInformation(vtkInformation* infoFrom, int deep)
 //----------------------------------------------------------------------------
 void vtkDataArray::ComputeRange(double range[2], int comp)
 {
-  //this method needs a large refactoring to be way easier to read
+  this->ComputeCachedRange(range, comp, false);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArray::ComputeFiniteRange(double range[2], int comp)
+{
+  this->ComputeCachedRange(range, comp, true);
+}
 
+//----------------------------------------------------------------------------
+void vtkDataArray::ComputeCachedRange(double range[2], int comp, bool finite)
+{
   if ( comp >= this->NumberOfComponents )
     { // Ignore requests for nonexistent components.
     return;
@@ -1134,15 +1217,37 @@ void vtkDataArray::ComputeRange(double range[2], int comp)
   range[1] = vtkTypeTraits<double>::Min();
 
   vtkInformation* info = this->GetInformation();
+  if (this->GetMTime() > info->GetMTime())
+    {
+    // All cached ranges become stale together. Drop them so that caching a
+    // new one (which modifies info) does not make the others look valid.
+    info->Remove(L2_NORM_RANGE());
+    info->Remove(L2_NORM_FINITE_RANGE());
+    info->Remove(PER_FINITE_COMPONENT());
+    if (vtkInformationVector* infoVec = info->Get(PER_COMPONENT()))
+      {
+      for (int i = 0; i < infoVec->GetNumberOfInformationObjects(); ++i)
+        {
+        infoVec->GetInformationObject(i)->Remove(COMPONENT_RANGE());
+        }
+      }
+    }
+
   vtkInformationDoubleVectorKey* rkey;
   if ( comp < 0 )
     {
-    rkey = L2_NORM_RANGE();
+    rkey = finite ? L2_NORM_FINITE_RANGE() : L2_NORM_RANGE();
     //hasValidKey will update range to the cached value if it exists.
     if( !hasValidKey(info,rkey,this->GetMTime(),range) )
       {
-
-      this->ComputeVectorRange(range);
+      if (finite)
+        {
+        this->ComputeFiniteVectorRange(range);
+        }
+      else
+        {
+        this->ComputeVectorRange(range);
+        }
       info->Set( rkey, range, 2 );
       }
     return;
@@ -1150,18 +1255,21 @@ void vtkDataArray::ComputeRange(double range[2], int comp)
   else
     {
     rkey = COMPONENT_RANGE();
+    vtkInformationInformationVectorKey* ckey =
+      finite ? PER_FINITE_COMPONENT() : PER_COMPONENT();
 
     //hasValidKey will update range to the cached value if it exists.
-    if( !hasValidKey(info, PER_COMPONENT(), rkey,
-                       this->GetMTime(), range, comp))
+    if( !hasValidKey(info, ckey, rkey, this->GetMTime(), range, comp))
       {
       double* allCompRanges = new double[this->NumberOfComponents*2];
-      const bool computed = this->ComputeScalarRange(allCompRanges);
+      const bool computed = finite ?
+        this->ComputeFiniteScalarRange(allCompRanges) :
+        this->ComputeScalarRange(allCompRanges);
       if(computed)
         {
         //construct the keys and add them to the info object
         vtkInformationVector* infoVec = vtkInformationVector::New();
-        info->Set( PER_COMPONENT(), infoVec );
+        info->Set( ckey, infoVec );
 
         infoVec->SetNumberOfInformationObjects( this->NumberOfComponents );
         for ( int i = 0; i < this->NumberOfComponents; ++i )
@@ -1181,6 +1289,64 @@ void vtkDataArray::ComputeRange(double range[2], int comp)
     }
 }
 
+//----------------------------------------------------------------------------
+bool vtkDataArray::ComputeMaskedRange(double range[2], int comp,
+                                      const unsigned char *ghosts,
+                                      unsigned char ghostsToSkip,
+                                      bool finiteOnly)
+{
+  range[0] = vtkTypeTraits<double>::Max();
+  range[1] = vtkTypeTraits<double>::Min();
+  if ( comp >= this->NumberOfComponents )
+    {
+    return false;
+    }
+  if (comp < 0 && this->NumberOfComponents == 1)
+    {
+    comp = 0;
+    }
+
+  bool computed = false;
+  if (comp < 0)
+    {
+    switch (this->GetDataType())
+      {
+      vtkDataArrayIteratorMacro(this,
+        computed = vtkDataArrayPrivate::DoComputeVectorRange<vtkDAValueType>(
+                                         vtkDABegin, vtkDAEnd,
+                                         this->GetNumberOfComponents(),
+                                         range, ghosts, ghostsToSkip,
+                                         finiteOnly)
+      );
+      default:
+        break;
+      }
+    return computed;
+    }
+
+  double* allCompRanges = new double[this->NumberOfComponents*2];
+  switch (this->GetDataType())
+    {
+    vtkDataArrayIteratorMacro(this,
+      computed = vtkDataArrayPrivate::DoComputeScalarRange<vtkDAValueType>(
+                                       vtkDABegin, vtkDAEnd,
+                                       this->GetNumberOfComponents(),
+                                       allCompRanges, ghosts, ghostsToSkip,
+                                       finiteOnly)
+    );
+    default:
+      break;
+    }
+  if (computed)
+    {
+    range[0] = allCompRanges[comp*2];
+    range[1] = allCompRanges[(comp*2)+1];
+    computed = range[0] <= range[1];
+    }
+  delete[] allCompRanges;
+  return computed;
+}
+
 //----------------------------------------------------------------------------
 bool vtkDataArray::ComputeScalarRange(double* ranges)
 {
@@ -1218,6 +1384,43 @@ bool vtkDataArray::ComputeVectorRange(double range[2])
   return computed;
 }
 
+//----------------------------------------------------------------------------
+bool vtkDataArray::ComputeFiniteScalarRange(double* ranges)
+{
+  bool computed = false;
+  switch (this->GetDataType())
+      {
+      vtkDataArrayIteratorMacro(this,
+        computed = vtkDataArrayPrivate::DoComputeScalarRange<vtkDAValueType>(
+                                         vtkDABegin, vtkDAEnd,
+                                         this->GetNumberOfComponents(),
+                                         ranges, NULL, 0, true)
+      );
+      default:
+        break;
+      }
+  return computed;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkDataArray::ComputeFiniteVectorRange(double range[2])
+{
+  bool computed = false;
+  switch (this->GetDataType())
+    {
+    vtkDataArrayIteratorMacro(this,
+      computed = vtkDataArrayPrivate::DoComputeVectorRange<vtkDAValueType>(
+                                       vtkDABegin, vtkDAEnd,
+                                       this->GetNumberOfComponents(),
+                                       range, NULL, 0, true)
+    );
+    default:
+      break;
+    }
+
+  return computed;
+}
+
 //----------------------------------------------------------------------------
 void vtkDataArray::GetDataTypeRange(double range[2])
 {
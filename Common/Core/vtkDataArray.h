@@ -37,6 +37,7 @@
 #include "vtkCommonCoreModule.h" // For export macro
 #include "vtkAbstractArray.h"
 
+class vtkDataArrayAllocator;
 class vtkDoubleArray;
 class vtkIdList;
 class vtkInformationDoubleVectorKey;
@@ -256,6 +257,26 @@ public:
   virtual void DeepCopy(vtkAbstractArray *aa);
   virtual void DeepCopy(vtkDataArray *da);
 
+  // Description:
+  // Copy other like DeepCopy(), but share its values instead of copying
+  // them when both arrays are of the same vtkDataArrayTemplate type. The
+  // shared values are copied the first time either array modifies them
+  // (copy-on-write), so both arrays still behave as independent copies.
+  // Values are copied right away when they cannot be shared, for instance
+  // when they were set with SetArray() and save set to 1. Pointers
+  // obtained from either array with GetVoidPointer() before the call must
+  // not be used to modify the values afterwards.
+  virtual void ShallowCopy(vtkDataArray *other);
+
+  // Description:
+  // Turn on/off copy-on-write for DeepCopy(). When on, DeepCopy() shares
+  // the values as ShallowCopy() does. This is a global flag, off by
+  // default.
+  static void SetGlobalCopyOnWrite(int val);
+  void GlobalCopyOnWriteOn() {this->SetGlobalCopyOnWrite(1);};
+  void GlobalCopyOnWriteOff() {this->SetGlobalCopyOnWrite(0);};
+  static int GetGlobalCopyOnWrite();
+
   // Description:
   // Fill a component of a data array with a specified value. This method
   // sets the specified component to specified value for all tuples in the
@@ -279,6 +300,18 @@ public:
   // new value ranges as in-use.
   virtual void* WriteVoidPointer(vtkIdType id, vtkIdType number) = 0;
 
+  // Description:
+  // Hand the array a buffer of size values obtained from allocator. The
+  // array keeps a reference to the allocator and releases the buffer with
+  // it, as for the memory it allocates itself. This is how file mappings
+  // are given to arrays, see vtkFileMappedDataArrayAllocator. Returns 0 if
+  // the array cannot use such a buffer, in which case the caller keeps
+  // ownership of it.
+  virtual int SetAllocatedVoidArray(void *vtkNotUsed(array),
+                                    vtkIdType vtkNotUsed(size),
+                                    vtkDataArrayAllocator *vtkNotUsed(allocator))
+    { return 0; }
+
   // Description:
   // Return the memory in kibibytes (1024 bytes) consumed by this data array. Used to
   // support streaming and reading/writing data. The value returned is
@@ -347,6 +380,43 @@ public:
     this->GetRange(range,0);
     }
 
+  // Description:
+  // Same as GetRange(), but NaN and infinite values are ignored. The finite
+  // range is cached separately from the range returned by GetRange(), and
+  // is re-computed only when the array is modified.
+  // THIS METHOD IS NOT THREAD SAFE.
+  void GetFiniteRange(double range[2], int comp)
+    {
+    this->ComputeFiniteRange(range, comp);
+    }
+  double* GetFiniteRange(int comp)
+    {
+    this->GetFiniteRange(this->FiniteRange, comp);
+    return this->FiniteRange;
+    }
+  double* GetFiniteRange()
+    {
+    return this->GetFiniteRange(0);
+    }
+  void GetFiniteRange(double range[2])
+    {
+    this->GetFiniteRange(range, 0);
+    }
+
+  // Description:
+  // Compute the range of the given component (the magnitude if comp is -1)
+  // ignoring tuples marked as ghost or blanked: tuple t is skipped when
+  // ghosts[t] & ghostsToSkip is not zero. ghosts must hold one value per
+  // tuple, e.g. the values of the vtkDataSetAttributes ghost array. If
+  // finiteOnly is true, NaN and infinite values are skipped as well. The
+  // result depends on the ghost array, so it is not cached. Returns false
+  // if no value contributed to the range, in which case range is set to
+  // { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN }.
+  bool ComputeMaskedRange(double range[2], int comp,
+                          const unsigned char *ghosts,
+                          unsigned char ghostsToSkip = 0xff,
+                          bool finiteOnly = false);
+
   // Description:
   // These methods return the Min and Max possible range of the native
   // data type. For example if a vtkScalars consists of unsigned char
@@ -387,6 +457,15 @@ public:
   // this value is set to { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN }.
   static vtkInformationDoubleVectorKey* L2_NORM_RANGE();
 
+  // Description:
+  // Same as L2_NORM_RANGE() for the finite range, see GetFiniteRange().
+  static vtkInformationDoubleVectorKey* L2_NORM_FINITE_RANGE();
+
+  // Description:
+  // Holds one information object per component with the COMPONENT_RANGE()
+  // of the finite values of the component, see GetFiniteRange().
+  static vtkInformationInformationVectorKey* PER_FINITE_COMPONENT();
+
   // Description:
   // Copy information instance. Arrays use information objects
   // in a variety of ways. It is important to have flexibility in
@@ -422,16 +501,36 @@ protected:
   // if you try to compute the range of an array of length zero.
   virtual bool ComputeVectorRange(double range[2]);
 
+  // Description:
+  // Same as ComputeRange(), ComputeScalarRange() and ComputeVectorRange()
+  // but NaN and infinite values are ignored.
+  virtual void ComputeFiniteRange(double range[2], int comp);
+  virtual bool ComputeFiniteScalarRange(double* ranges);
+  virtual bool ComputeFiniteVectorRange(double range[2]);
+
+  // Description:
+  // Make this array use the values of other, copy-on-write, and return
+  // true. Subclasses able to do so override this method; the default
+  // implementation returns false.
+  virtual bool ShareValues(vtkDataArray *other);
+
   // Construct object with default tuple dimension (number of components) of 1.
   vtkDataArray();
   ~vtkDataArray();
 
   vtkLookupTable *LookupTable;
   double Range[2];
+  double FiniteRange[2];
 
 private:
   double* GetTupleN(vtkIdType i, int n);
 
+  // Description:
+  // Shared implementation of ComputeRange() and ComputeFiniteRange().
+  void ComputeCachedRange(double range[2], int comp, bool finite);
+
+  void CopyLookupTable(vtkDataArray *da);
+
 private:
   vtkDataArray(const vtkDataArray&);  // Not implemented.
   void operator=(const vtkDataArray&);  // Not implemented.
@@ -446,6 +545,7 @@ inline vtkDataArray* vtkDataArray::FastDownCast(vtkAbstractArray *source)
     case TypedDataArray:
     case DataArray:
     case MappedDataArray:
+    case SOADataArrayTemplate:
       return static_cast<vtkDataArray*>(source);
     default:
       return NULL;
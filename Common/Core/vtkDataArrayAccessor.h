@@ -0,0 +1,370 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayAccessor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkDataArrayAccessor - Efficient templated access to vtkDataArray.
+//
+// .SECTION Description
+// vtkDataArrayAccessor provides tuple/component access to the values of a
+// vtkDataArray in the native value type of the array, with calls that are
+// statically bound to the concrete array class. Algorithms written against
+// the accessor interface are instantiated once per array class, and the
+// compiler can inline the value lookups into the kernel:
+//
+// \code
+// template <class Accessor>
+// void MyKernel(Accessor in, vtkIdType numTuples, double *out)
+// {
+//   for (vtkIdType t = 0; t < numTuples; ++t)
+//     {
+//     out[t] = static_cast<double>(in.Get(t, 0) + in.Get(t, 1));
+//     }
+// }
+//
+// switch (array->GetDataType())
+//   {
+//   vtkDataArrayAccessorMacro(array, MyKernel(vtkDAAccessor, n, out));
+//   }
+// \endcode
+//
+// The primary template works with any concrete vtkTypedDataArray subclass,
+// including vtkMappedDataArray implementations such as
+// vtkPeriodicDataArray or vtkCPExodusIIResultsArrayTemplate: the member
+// functions are called with a qualified name (Array->ArrayT::GetValue(...))
+// so no virtual dispatch takes place when ArrayT is the most derived type.
+// Code that knows about such arrays can instantiate its kernel for them
+// directly:
+//
+// \code
+// if (vtkCPExodusIIResultsArrayTemplate<double> *exo =
+//     vtkCPExodusIIResultsArrayTemplate<double>::SafeDownCast(array))
+//   {
+//   MyKernel(vtkDataArrayAccessor<
+//            vtkCPExodusIIResultsArrayTemplate<double> >(exo), n, out);
+//   }
+// \endcode
+//
+// Specializations are provided for:
+//  - vtkDataArrayTemplate<T>: reads the raw memory of the array.
+//  - vtkSOADataArrayTemplate<T>: reads the component buffers directly.
+//  - vtkTypedDataArray<T>: typed, but virtual, access for arrays of unknown
+//    class.
+//  - vtkDataArray: virtual access through the double API, as a last resort.
+//
+// vtkDataArrayAccessorMacro picks the most efficient of these for an array
+// whose class and value type are only known at run-time. It defines the
+// following typedefs and variables for use in the _call argument:
+//  - vtkDAValueType is typedef'd to the array's element value type.
+//  - vtkDAContainerType is typedef'd to the array class the accessor is
+//    bound to.
+//  - vtkDAAccessorType is typedef'd to vtkDataArrayAccessor<vtkDAContainerType>
+//  - vtkDAAccessor is an object of type vtkDAAccessorType bound to the array.
+//
+// .SECTION See Also
+// vtkDataArrayIteratorMacro vtkSOADataArrayTemplate vtkTypedDataArray
+
+#ifndef vtkDataArrayAccessor_h
+#define vtkDataArrayAccessor_h
+
+#include "vtkDataArrayIteratorMacro.h" // For array classes and _vtkDAIMUnused
+
+//------------------------------------------------------------------------------
+// Any concrete vtkTypedDataArray subclass. Calls are statically bound.
+template <class ArrayT>
+class vtkDataArrayAccessor
+{
+public:
+  typedef ArrayT ArrayType;
+  typedef typename ArrayType::ValueType APIType;
+
+  ArrayType *Array;
+
+  vtkDataArrayAccessor(ArrayType *array) : Array(array) {}
+
+  vtkIdType GetNumberOfTuples() const
+    {
+    return this->Array->GetNumberOfTuples();
+    }
+
+  int GetNumberOfComponents() const
+    {
+    return this->Array->GetNumberOfComponents();
+    }
+
+  APIType Get(vtkIdType tupleIdx, int compIdx) const
+    {
+    return this->Array->ArrayType::GetValue(
+      tupleIdx * this->Array->GetNumberOfComponents() + compIdx);
+    }
+
+  void Set(vtkIdType tupleIdx, int compIdx, APIType val) const
+    {
+    this->Array->ArrayType::SetValue(
+      tupleIdx * this->Array->GetNumberOfComponents() + compIdx, val);
+    }
+
+  void Get(vtkIdType tupleIdx, APIType *tuple) const
+    {
+    this->Array->ArrayType::GetTupleValue(tupleIdx, tuple);
+    }
+
+  void Set(vtkIdType tupleIdx, const APIType *tuple) const
+    {
+    this->Array->ArrayType::SetTupleValue(tupleIdx, tuple);
+    }
+};
+
+//------------------------------------------------------------------------------
+// Standard (interleaved) arrays: raw memory access.
+template <class T>
+class vtkDataArrayAccessor<vtkDataArrayTemplate<T> >
+{
+public:
+  typedef vtkDataArrayTemplate<T> ArrayType;
+  typedef T APIType;
+
+  ArrayType *Array;
+  T *Data;
+  int NumberOfComponents;
+
+  vtkDataArrayAccessor(ArrayType *array)
+    : Array(array),
+      Data(array->GetPointer(0)),
+      NumberOfComponents(array->GetNumberOfComponents())
+    {
+    }
+
+  vtkIdType GetNumberOfTuples() const
+    {
+    return this->Array->GetNumberOfTuples();
+    }
+
+  int GetNumberOfComponents() const
+    {
+    return this->NumberOfComponents;
+    }
+
+  APIType Get(vtkIdType tupleIdx, int compIdx) const
+    {
+    return this->Data[tupleIdx * this->NumberOfComponents + compIdx];
+    }
+
+  void Set(vtkIdType tupleIdx, int compIdx, APIType val) const
+    {
+    this->Data[tupleIdx * this->NumberOfComponents + compIdx] = val;
+    }
+
+  void Get(vtkIdType tupleIdx, APIType *tuple) const
+    {
+    const T *src = this->Data + tupleIdx * this->NumberOfComponents;
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      tuple[c] = src[c];
+      }
+    }
+
+  void Set(vtkIdType tupleIdx, const APIType *tuple) const
+    {
+    T *dst = this->Data + tupleIdx * this->NumberOfComponents;
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      dst[c] = tuple[c];
+      }
+    }
+};
+
+//------------------------------------------------------------------------------
+// Structure-of-arrays: direct access to the component buffers.
+template <class T>
+class vtkDataArrayAccessor<vtkSOADataArrayTemplate<T> >
+{
+public:
+  typedef vtkSOADataArrayTemplate<T> ArrayType;
+  typedef T APIType;
+
+  ArrayType *Array;
+  int NumberOfComponents;
+
+  vtkDataArrayAccessor(ArrayType *array)
+    : Array(array),
+      NumberOfComponents(array->GetNumberOfComponents())
+    {
+    }
+
+  vtkIdType GetNumberOfTuples() const
+    {
+    return this->Array->GetNumberOfTuples();
+    }
+
+  int GetNumberOfComponents() const
+    {
+    return this->NumberOfComponents;
+    }
+
+  APIType Get(vtkIdType tupleIdx, int compIdx) const
+    {
+    return this->Array->GetTypedComponent(tupleIdx, compIdx);
+    }
+
+  void Set(vtkIdType tupleIdx, int compIdx, APIType val) const
+    {
+    this->Array->SetTypedComponent(tupleIdx, compIdx, val);
+    }
+
+  void Get(vtkIdType tupleIdx, APIType *tuple) const
+    {
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      tuple[c] = this->Array->GetTypedComponent(tupleIdx, c);
+      }
+    }
+
+  void Set(vtkIdType tupleIdx, const APIType *tuple) const
+    {
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      this->Array->SetTypedComponent(tupleIdx, c, tuple[c]);
+      }
+    }
+};
+
+//------------------------------------------------------------------------------
+// Typed arrays of unknown class: virtual calls, but no conversion to double.
+template <class T>
+class vtkDataArrayAccessor<vtkTypedDataArray<T> >
+{
+public:
+  typedef vtkTypedDataArray<T> ArrayType;
+  typedef T APIType;
+
+  ArrayType *Array;
+  int NumberOfComponents;
+
+  vtkDataArrayAccessor(ArrayType *array)
+    : Array(array),
+      NumberOfComponents(array->GetNumberOfComponents())
+    {
+    }
+
+  vtkIdType GetNumberOfTuples() const
+    {
+    return this->Array->GetNumberOfTuples();
+    }
+
+  int GetNumberOfComponents() const
+    {
+    return this->NumberOfComponents;
+    }
+
+  APIType Get(vtkIdType tupleIdx, int compIdx) const
+    {
+    return this->Array->GetValue(tupleIdx * this->NumberOfComponents + compIdx);
+    }
+
+  void Set(vtkIdType tupleIdx, int compIdx, APIType val) const
+    {
+    this->Array->SetValue(tupleIdx * this->NumberOfComponents + compIdx, val);
+    }
+
+  void Get(vtkIdType tupleIdx, APIType *tuple) const
+    {
+    this->Array->GetTupleValue(tupleIdx, tuple);
+    }
+
+  void Set(vtkIdType tupleIdx, const APIType *tuple) const
+    {
+    this->Array->SetTupleValue(tupleIdx, tuple);
+    }
+};
+
+//------------------------------------------------------------------------------
+// Any vtkDataArray: virtual calls through the double API.
+template <>
+class vtkDataArrayAccessor<vtkDataArray>
+{
+public:
+  typedef vtkDataArray ArrayType;
+  typedef double APIType;
+
+  ArrayType *Array;
+
+  vtkDataArrayAccessor(ArrayType *array) : Array(array) {}
+
+  vtkIdType GetNumberOfTuples() const
+    {
+    return this->Array->GetNumberOfTuples();
+    }
+
+  int GetNumberOfComponents() const
+    {
+    return this->Array->GetNumberOfComponents();
+    }
+
+  APIType Get(vtkIdType tupleIdx, int compIdx) const
+    {
+    return this->Array->GetComponent(tupleIdx, compIdx);
+    }
+
+  void Set(vtkIdType tupleIdx, int compIdx, APIType val) const
+    {
+    this->Array->SetComponent(tupleIdx, compIdx, val);
+    }
+
+  void Get(vtkIdType tupleIdx, APIType *tuple) const
+    {
+    this->Array->GetTuple(tupleIdx, tuple);
+    }
+
+  void Set(vtkIdType tupleIdx, const APIType *tuple) const
+    {
+    this->Array->SetTuple(tupleIdx, tuple);
+    }
+};
+
+#define _vtkDataArrayAccessorCase(_type, _arrayvar, _call)                 \
+      {                                                                    \
+      typedef VTK_TT vtkDAValueType _vtkDAIMUnused;                        \
+      typedef _type vtkDAContainerType;                                    \
+      typedef vtkDataArrayAccessor<vtkDAContainerType> vtkDAAccessorType;  \
+      vtkDAAccessorType vtkDAAccessor(_arrayvar);                          \
+      (void)vtkDAAccessor; /* Prevent warnings when unused */              \
+      _call;                                                               \
+      }
+
+#define vtkDataArrayAccessorMacro(_array, _call)                           \
+  vtkTemplateMacro(                                                        \
+    vtkDataArray *_da(_array);                                             \
+    if (vtkDataArrayTemplate<VTK_TT> *_dat =                               \
+        vtkDataArrayTemplate<VTK_TT>::FastDownCast(_da))                   \
+      _vtkDataArrayAccessorCase(vtkDataArrayTemplate<VTK_TT>, _dat, _call) \
+    else if (vtkSOADataArrayTemplate<VTK_TT> *_soa =                       \
+             vtkSOADataArrayTemplate<VTK_TT>::FastDownCast(_da))           \
+      _vtkDataArrayAccessorCase(vtkSOADataArrayTemplate<VTK_TT>, _soa,     \
+                                _call)                                     \
+    else if (vtkTypedDataArray<VTK_TT> *_tda =                             \
+             vtkTypedDataArray<VTK_TT>::FastDownCast(_da))                 \
+      _vtkDataArrayAccessorCase(vtkTypedDataArray<VTK_TT>, _tda, _call)    \
+    else                                                                   \
+      {                                                                    \
+      typedef double vtkDAValueType _vtkDAIMUnused;                        \
+      typedef vtkDataArray vtkDAContainerType;                             \
+      typedef vtkDataArrayAccessor<vtkDAContainerType> vtkDAAccessorType;  \
+      vtkDAAccessorType vtkDAAccessor(_da);                                \
+      (void)vtkDAAccessor;                                                 \
+      _call;                                                               \
+      }                                                                    \
+    )
+
+#endif //vtkDataArrayAccessor_h
+
+// VTK-HeaderTest-Exclude: vtkDataArrayAccessor.h
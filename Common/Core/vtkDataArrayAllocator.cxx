@@ -0,0 +1,133 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArrayAllocator.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
+
+#include <cstdlib>
+#include <cstring>
+
+vtkStandardNewMacro(vtkDataArrayAllocator);
+
+namespace
+{
+vtkDataArrayAllocator *Instance = 0;
+vtkSimpleCriticalSection InstanceLock;
+
+// Drop the reference held on the instance when the program exits. Arrays
+// that outlive this object keep the allocator alive through their own
+// reference.
+class vtkDataArrayAllocatorCleanup
+{
+public:
+  ~vtkDataArrayAllocatorCleanup()
+    {
+    vtkDataArrayAllocator::SetInstance(0);
+    }
+};
+vtkDataArrayAllocatorCleanup Cleanup;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArrayAllocator::vtkDataArrayAllocator()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkDataArrayAllocator::~vtkDataArrayAllocator()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkDataArrayAllocator *vtkDataArrayAllocator::GetInstance()
+{
+  if (!Instance)
+    {
+    InstanceLock.Lock();
+    if (!Instance)
+      {
+      // New() goes through the object factory.
+      Instance = vtkDataArrayAllocator::New();
+      }
+    InstanceLock.Unlock();
+    }
+  return Instance;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayAllocator::SetInstance(vtkDataArrayAllocator *instance)
+{
+  InstanceLock.Lock();
+  if (Instance != instance)
+    {
+    if (instance)
+      {
+      instance->Register(NULL);
+      }
+    if (Instance)
+      {
+      Instance->UnRegister(NULL);
+      }
+    Instance = instance;
+    }
+  InstanceLock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void *vtkDataArrayAllocator::Allocate(size_t size)
+{
+  return malloc(size);
+}
+
+//----------------------------------------------------------------------------
+void *vtkDataArrayAllocator::Reallocate(void *ptr, size_t oldSize,
+                                        size_t newSize)
+{
+  // OS X's realloc does not free memory if the new block is smaller.  This
+  // is a very serious problem and causes huge amount of memory to be
+  // wasted. Do not use realloc on the Mac.
+#if defined __APPLE__
+  return this->CopyReallocate(ptr, oldSize, newSize);
+#else
+  (void)oldSize;
+  return realloc(ptr, newSize);
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayAllocator::Free(void *ptr, size_t)
+{
+  free(ptr);
+}
+
+//----------------------------------------------------------------------------
+void *vtkDataArrayAllocator::CopyReallocate(void *ptr, size_t oldSize,
+                                            size_t newSize)
+{
+  void *newPtr = this->Allocate(newSize);
+  if (newPtr && ptr)
+    {
+    memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+    this->Free(ptr, oldSize);
+    }
+  return newPtr;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
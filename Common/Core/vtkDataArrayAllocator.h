@@ -0,0 +1,96 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkDataArrayAllocator - memory allocation policy for data arrays
+// .SECTION Description
+// vtkDataArrayAllocator provides the memory used by vtkDataArrayTemplate
+// (and therefore by vtkPoints and all the concrete numeric arrays). The
+// default implementation uses malloc, realloc and free, which matches the
+// behavior of previous VTK versions.
+//
+// A process-wide instance is returned by GetInstance(). It is created
+// through the object factory, so an override of "vtkDataArrayAllocator"
+// replaces the policy for the whole application; SetInstance() can be used
+// instead to install a policy programmatically. Each array keeps a
+// reference to the allocator that provided its buffer and releases the
+// buffer with it, so changing the instance only affects later allocations.
+//
+// Buffers handed to an array with SetArray() are never released through
+// the allocator. Conversely, when a policy other than the default is in
+// use, code that takes ownership of an array's memory must release it with
+// the allocator instead of free().
+//
+// .SECTION See Also
+// vtkAlignedDataArrayAllocator vtkHugePageDataArrayAllocator
+// vtkFirstTouchDataArrayAllocator
+
+#ifndef vtkDataArrayAllocator_h
+#define vtkDataArrayAllocator_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <cstddef> // For size_t
+
+class VTKCOMMONCORE_EXPORT vtkDataArrayAllocator : public vtkObject
+{
+public:
+  static vtkDataArrayAllocator *New();
+  vtkTypeMacro(vtkDataArrayAllocator, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Return the allocator used by newly allocated data arrays. The instance
+  // is created on first use, through the object factory. No reference is
+  // added to the returned object.
+  static vtkDataArrayAllocator *GetInstance();
+
+  // Description:
+  // Install the allocator used by newly allocated data arrays. The instance
+  // is reference counted; call Delete() on it after setting it. Passing NULL
+  // restores the default instance on the next call to GetInstance().
+  static void SetInstance(vtkDataArrayAllocator *instance);
+
+//BTX
+  // Description:
+  // Allocate a block of size bytes. Return NULL on failure.
+  virtual void *Allocate(size_t size);
+
+  // Description:
+  // Resize a block of oldSize bytes returned by this allocator to newSize
+  // bytes, preserving the first min(oldSize, newSize) bytes. On failure
+  // NULL is returned and ptr is left untouched.
+  virtual void *Reallocate(void *ptr, size_t oldSize, size_t newSize);
+
+  // Description:
+  // Release a block of size bytes returned by this allocator.
+  virtual void Free(void *ptr, size_t size);
+//ETX
+
+protected:
+  vtkDataArrayAllocator();
+  ~vtkDataArrayAllocator();
+
+//BTX
+  // Description:
+  // Implement Reallocate() with Allocate(), a copy and Free().
+  void *CopyReallocate(void *ptr, size_t oldSize, size_t newSize);
+//ETX
+
+private:
+  vtkDataArrayAllocator(const vtkDataArrayAllocator&);  // Not implemented.
+  void operator=(const vtkDataArrayAllocator&);  // Not implemented.
+};
+
+#endif
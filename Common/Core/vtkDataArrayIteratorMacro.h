@@ -42,8 +42,13 @@
 // optimizations in the standard template library to occur (such as reducing
 // std::copy to memmove).
 //
+// For vtkSOADataArrayTemplate, which stores each component in a separate
+// buffer, a vtkSOADataArrayIterator is used. It reads the component buffers
+// directly and makes no virtual calls.
+//
 // For arrays that are subclasses of vtkTypedDataArray (but not
-// vtkDataArrayTemplate), a vtkTypedDataArrayIterator is used.
+// vtkDataArrayTemplate or vtkSOADataArrayTemplate), a
+// vtkTypedDataArrayIterator is used.
 // Such iterators safely traverse the array using API calls and have
 // pointer-like semantics, but add about a 35% performance overhead compared
 // with iterating over the raw memory (measured by summing a vtkFloatArray
@@ -77,6 +82,7 @@
 #define vtkDataArrayIteratorMacro_h
 
 #include "vtkDataArrayTemplate.h" // For all classes referred to in the macro
+#include "vtkSOADataArrayTemplate.h" // For all classes referred to in the macro
 #include "vtkSetGet.h" // For vtkTemplateMacro
 
 // Silence 'unused typedef' warnings on GCC.
@@ -103,6 +109,18 @@
       (void)vtkDAEnd;                                                      \
       _call;                                                               \
       }                                                                    \
+    else if (vtkSOADataArrayTemplate<VTK_TT> *_soa =                       \
+             vtkSOADataArrayTemplate<VTK_TT>::FastDownCast(_aa))           \
+      {                                                                    \
+      typedef VTK_TT vtkDAValueType;                                       \
+      typedef vtkSOADataArrayTemplate<vtkDAValueType> vtkDAContainerType;  \
+      typedef vtkDAContainerType::Iterator vtkDAIteratorType;              \
+      vtkDAIteratorType vtkDABegin(_soa->Begin());                         \
+      vtkDAIteratorType vtkDAEnd(_soa->End());                             \
+      (void)vtkDABegin;                                                    \
+      (void)vtkDAEnd;                                                      \
+      _call;                                                               \
+      }                                                                    \
     else if (vtkTypedDataArray<VTK_TT> *_tda =                             \
              vtkTypedDataArray<VTK_TT>::FastDownCast(_aa))                 \
       {                                                                    \
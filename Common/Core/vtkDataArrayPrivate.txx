@@ -16,9 +16,14 @@
 #define vtkDataArrayPrivate_txx
 
 
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSOADataArrayIterator.h"
 #include "vtkTypeTraits.h"
 #include <algorithm>
 #include <cassert> // for assert()
+#include <cmath>   // for sqrt()
+#include <vector>
 
 namespace vtkDataArrayPrivate
 {
@@ -60,44 +65,276 @@ using std::max;
 }
 
 //----------------------------------------------------------------------------
-template <class ValueType, int NumComps, int RangeSize>
-struct ComputeScalarRange
+// Iterators that can be dereferenced from several threads at once. The
+// vtkTypedDataArrayIterator goes through GetValueReference(), which some
+// mapped arrays implement with a scratch buffer, so it is excluded.
+template <class IteratorType>
+struct IsThreadSafeIterator
 {
-  template<class InputIteratorType>
-  bool operator()(InputIteratorType begin, InputIteratorType end,
-                  double* ranges)
+  static const bool value = false;
+};
+
+template <class T>
+struct IsThreadSafeIterator<T*>
+{
+  static const bool value = true;
+};
+
+template <class T>
+struct IsThreadSafeIterator<vtkSOADataArrayIterator<T> >
+{
+  static const bool value = true;
+};
+
+//----------------------------------------------------------------------------
+// Arrays with fewer values than this are processed on the calling thread;
+// below this size the threading overhead outweighs the gain.
+static const vtkIdType ParallelRangeThreshold = 65536;
+
+//----------------------------------------------------------------------------
+// x - x is 0 for finite values and NaN for NaN and infinities.
+template <class ValueType>
+inline bool IsFinite(const ValueType&)
+{
+  return true;
+}
+
+template <>
+inline bool IsFinite<float>(const float& value)
+{
+  return (value - value) == 0.f;
+}
+
+template <>
+inline bool IsFinite<double>(const double& value)
+{
+  return (value - value) == 0.0;
+}
+
+//----------------------------------------------------------------------------
+// Run the worker over all tuples, in parallel when it is safe and worth it.
+template <class Worker>
+void ExecuteRangeWorker(Worker& worker, vtkIdType numTuples, int numComp,
+                        bool threadSafe)
+{
+  if (threadSafe && numTuples * numComp >= ParallelRangeThreshold)
+    {
+    vtkSMPTools::For(0, numTuples, worker);
+    }
+  else
+    {
+    worker(0, numTuples);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Computes the range of each component over a set of tuples, with one
+// range per thread that is combined by Reduce(). NumComps > 0 fixes the
+// number of components at compile time, which lets the compiler optimize
+// the inner loop; 0 uses the run-time value. Filtered enables skipping of
+// ghost tuples and of non-finite values.
+template <class ValueType, class IteratorType, int NumComps, bool Filtered>
+class ScalarRangeWorker
+{
+public:
+  ScalarRangeWorker(IteratorType begin, int numComp,
+                    const unsigned char* ghosts, unsigned char ghostsToSkip,
+                    bool finiteOnly)
+    : Begin(begin),
+      NumComp(NumComps > 0 ? NumComps : numComp),
+      Ghosts(ghosts),
+      GhostsToSkip(ghostsToSkip),
+      FiniteOnly(finiteOnly),
+      Range(InitialRange(NumComps > 0 ? NumComps : numComp))
+  {
+  }
+
+  void operator()(vtkIdType first, vtkIdType last)
+  {
+    const int numComp = NumComps > 0 ? NumComps : this->NumComp;
+    ValueType* range = &this->Range.Local()[0];
+    IteratorType value = this->Begin + first * numComp;
+    for (vtkIdType t = first; t < last; ++t, value += numComp)
+      {
+      if (Filtered && this->Ghosts && (this->Ghosts[t] & this->GhostsToSkip))
+        {
+        continue;
+        }
+      for(int i = 0, j = 0; i < numComp; ++i, j+=2)
+        {
+        const ValueType v = value[i];
+        if (Filtered && this->FiniteOnly && !IsFinite(v))
+          {
+          continue;
+          }
+        range[j] = detail::min(range[j], v);
+        range[j+1] = detail::max(range[j+1], v);
+        }
+      }
+  }
+
+  // Combine the per-thread ranges and convert them to doubles. Components
+  // without any value keep the (double max, double min) empty range.
+  // Returns false if no value at all was found.
+  bool Reduce(double* ranges)
   {
-    ValueType tempRange[RangeSize];
-    for(int i = 0, j = 0; i < NumComps; ++i, j+=2)
+    const int numComp = this->NumComp;
+    std::vector<ValueType> combined = InitialRange(numComp);
+    typename vtkSMPThreadLocal<std::vector<ValueType> >::iterator itr;
+    for (itr = this->Range.begin(); itr != this->Range.end(); ++itr)
       {
-      tempRange[j] = vtkTypeTraits<ValueType>::Max();
-      tempRange[j+1] = vtkTypeTraits<ValueType>::Min();
+      for (int j = 0; j < 2 * numComp; j+=2)
+        {
+        combined[j] = detail::min(combined[j], (*itr)[j]);
+        combined[j+1] = detail::max(combined[j+1], (*itr)[j+1]);
+        }
       }
 
-    //compute the range for each component of the data array at the same time
-    for(InputIteratorType value = begin; value != end; value+=NumComps)
+    bool found = false;
+    for (int j = 0; j < 2 * numComp; j+=2)
+      {
+      if (combined[j] <= combined[j+1])
+        {
+        ranges[j] = static_cast<double>(combined[j]);
+        ranges[j+1] = static_cast<double>(combined[j+1]);
+        found = true;
+        }
+      else
+        {
+        ranges[j] = vtkTypeTraits<double>::Max();
+        ranges[j+1] = vtkTypeTraits<double>::Min();
+        }
+      }
+    return found;
+  }
+
+private:
+  static std::vector<ValueType> InitialRange(int numComp)
+  {
+    std::vector<ValueType> range(2 * numComp);
+    for (int j = 0; j < 2 * numComp; j+=2)
+      {
+      range[j] = vtkTypeTraits<ValueType>::Max();
+      range[j+1] = vtkTypeTraits<ValueType>::Min();
+      }
+    return range;
+  }
+
+  IteratorType Begin;
+  int NumComp;
+  const unsigned char* Ghosts;
+  unsigned char GhostsToSkip;
+  bool FiniteOnly;
+  vtkSMPThreadLocal<std::vector<ValueType> > Range;
+};
+
+//----------------------------------------------------------------------------
+template <class ValueType, int NumComps, bool Filtered, class IteratorType>
+bool ComputeScalarRange(IteratorType begin, vtkIdType numTuples, int numComp,
+                        double* ranges, const unsigned char* ghosts,
+                        unsigned char ghostsToSkip, bool finiteOnly)
+{
+  ScalarRangeWorker<ValueType, IteratorType, NumComps, Filtered>
+    worker(begin, numComp, ghosts, ghostsToSkip, finiteOnly);
+  ExecuteRangeWorker(worker, numTuples, numComp,
+                     IsThreadSafeIterator<IteratorType>::value);
+  return worker.Reduce(ranges);
+}
+
+//----------------------------------------------------------------------------
+// Computes the range of the squared L2 norm of the tuples.
+template <class ValueType, class IteratorType, bool Filtered>
+class VectorRangeWorker
+{
+public:
+  VectorRangeWorker(IteratorType begin, int numComp,
+                    const unsigned char* ghosts, unsigned char ghostsToSkip,
+                    bool finiteOnly)
+    : Begin(begin),
+      NumComp(numComp),
+      Ghosts(ghosts),
+      GhostsToSkip(ghostsToSkip),
+      FiniteOnly(finiteOnly),
+      Min(vtkTypeTraits<double>::Max()),
+      Max(vtkTypeTraits<double>::Min())
+  {
+  }
+
+  void operator()(vtkIdType first, vtkIdType last)
+  {
+    const int numComp = this->NumComp;
+    double& min = this->Min.Local();
+    double& max = this->Max.Local();
+    IteratorType value = this->Begin + first * numComp;
+    for (vtkIdType t = first; t < last; ++t, value += numComp)
       {
-      for(int i = 0, j = 0; i < NumComps; ++i, j+=2)
+      if (Filtered && this->Ghosts && (this->Ghosts[t] & this->GhostsToSkip))
+        {
+        continue;
+        }
+      double squaredSum = 0.0;
+      for (int i = 0; i < numComp; ++i)
+        {
+        const double v = static_cast<double>(value[i]);
+        squaredSum += v * v;
+        }
+      if (Filtered && this->FiniteOnly && !IsFinite(squaredSum))
         {
-        tempRange[j] = detail::min(tempRange[j], value[i]);
-        tempRange[j+1] = detail::max(tempRange[j+1], value[i]);
+        continue;
         }
+      min = detail::min(min, squaredSum);
+      max = detail::max(max, squaredSum);
       }
+  }
 
-    //convert the range to doubles
-    for (int i = 0, j = 0; i < NumComps; ++i, j+=2)
+  // Combine the per-thread ranges and take the square root. Returns false
+  // if no tuple was found.
+  bool Reduce(double range[2])
+  {
+    double min = vtkTypeTraits<double>::Max();
+    double max = vtkTypeTraits<double>::Min();
+    vtkSMPThreadLocal<double>::iterator itr;
+    for (itr = this->Min.begin(); itr != this->Min.end(); ++itr)
+      {
+      min = detail::min(min, *itr);
+      }
+    for (itr = this->Max.begin(); itr != this->Max.end(); ++itr)
       {
-      ranges[j] = static_cast<double>(tempRange[j]);
-      ranges[j+1] = static_cast<double>(tempRange[j+1]);
+      max = detail::max(max, *itr);
       }
+    if (min > max)
+      {
+      range[0] = vtkTypeTraits<double>::Max();
+      range[1] = vtkTypeTraits<double>::Min();
+      return false;
+      }
+    range[0] = sqrt(min);
+    range[1] = sqrt(max);
     return true;
   }
+
+private:
+  IteratorType Begin;
+  int NumComp;
+  const unsigned char* Ghosts;
+  unsigned char GhostsToSkip;
+  bool FiniteOnly;
+  vtkSMPThreadLocal<double> Min;
+  vtkSMPThreadLocal<double> Max;
 };
 
 //----------------------------------------------------------------------------
+// Compute the range of each component of the values in [begin, end).
+// If ghosts is not NULL, tuples t for which ghosts[t] & ghostsToSkip is not
+// zero are ignored. If finiteOnly is true, NaN and infinite values are
+// ignored. Large arrays are processed in parallel with vtkSMPTools when
+// the iterator allows it.
 template <class ValueType, class InputIteratorType>
 bool DoComputeScalarRange(InputIteratorType begin, InputIteratorType end,
-                        const int numComp, double* ranges)
+                        const int numComp, double* ranges,
+                        const unsigned char* ghosts = NULL,
+                        unsigned char ghostsToSkip = 0xff,
+                        bool finiteOnly = false)
 {
   //setup the initial ranges to be the max,min for double
   for (int i = 0, j = 0; i < numComp; ++i, j+=2)
@@ -115,83 +352,52 @@ bool DoComputeScalarRange(InputIteratorType begin, InputIteratorType end,
   //verify that length of the array is divisible by the number of components
   //this will make sure we don't walk off the end
   assert((end-begin) % numComp == 0);
+  const vtkIdType numTuples = static_cast<vtkIdType>(end - begin) / numComp;
 
-  //Special case for single value scalar range. This is done to help the
-  //compiler detect it can perform loop optimizations.
-  if (numComp == 1)
+  if (ghosts || finiteOnly)
     {
-    return ComputeScalarRange<ValueType,1,2>()(begin, end, ranges);
+    return ComputeScalarRange<ValueType,0,true>(
+      begin, numTuples, numComp, ranges, ghosts, ghostsToSkip, finiteOnly);
     }
-  else if (numComp == 2)
-    {
-    return ComputeScalarRange<ValueType,2,4>()(begin, end, ranges);
-    }
-  else if (numComp == 3)
-    {
-    return ComputeScalarRange<ValueType,3,6>()(begin, end, ranges);
-    }
-  else if (numComp == 4)
-    {
-    return ComputeScalarRange<ValueType,4,8>()(begin, end, ranges);
-    }
-  else if (numComp == 5)
-    {
-    return ComputeScalarRange<ValueType,5,10>()(begin, end, ranges);
-    }
-  else if (numComp == 6)
-    {
-    return ComputeScalarRange<ValueType,6,12>()(begin, end, ranges);
-    }
-  else if (numComp == 7)
-    {
-    return ComputeScalarRange<ValueType,7,14>()(begin, end, ranges);
-    }
-  else if (numComp == 8)
-    {
-    return ComputeScalarRange<ValueType,8,16>()(begin, end, ranges);
-    }
-  else if (numComp == 9)
-    {
-    return ComputeScalarRange<ValueType,9,18>()(begin, end, ranges);
-    }
-  else
-    {
-    //initialize the temp range storage to min/max pairs
-    ValueType* tempRange = new ValueType[numComp*2];
-    for (int i = 0, j = 0; i < numComp; ++i, j+=2)
-      {
-      tempRange[j] = vtkTypeTraits<ValueType>::Max();
-      tempRange[j+1] = vtkTypeTraits<ValueType>::Min();
-      }
-
-    //compute the range for each component of the data array at the same time
-    for (InputIteratorType value = begin; value != end; value+=numComp)
-      {
-      for(int i = 0, j = 0; i < numComp; ++i, j+=2)
-        {
-        tempRange[j] = detail::min(tempRange[j], value[i]);
-        tempRange[j+1] = detail::max(tempRange[j+1], value[i]);
-        }
-      }
-
-    //convert the range to doubles
-    for (int i = 0, j = 0; i < numComp; ++i, j+=2)
-      {
-      ranges[j] = static_cast<double>(tempRange[j]);
-      ranges[j+1] = static_cast<double>(tempRange[j+1]);
-      }
-
-    //cleanup temp range storage
-    delete[] tempRange;
 
-    return true;
+  //Special case for small numbers of components. This is done to help the
+  //compiler detect it can perform loop optimizations.
+  switch (numComp)
+    {
+    case 1:
+      return ComputeScalarRange<ValueType,1,false>(
+        begin, numTuples, numComp, ranges, NULL, 0, false);
+    case 2:
+      return ComputeScalarRange<ValueType,2,false>(
+        begin, numTuples, numComp, ranges, NULL, 0, false);
+    case 3:
+      return ComputeScalarRange<ValueType,3,false>(
+        begin, numTuples, numComp, ranges, NULL, 0, false);
+    case 4:
+      return ComputeScalarRange<ValueType,4,false>(
+        begin, numTuples, numComp, ranges, NULL, 0, false);
+    case 6:
+      return ComputeScalarRange<ValueType,6,false>(
+        begin, numTuples, numComp, ranges, NULL, 0, false);
+    case 9:
+      return ComputeScalarRange<ValueType,9,false>(
+        begin, numTuples, numComp, ranges, NULL, 0, false);
+    default:
+      return ComputeScalarRange<ValueType,0,false>(
+        begin, numTuples, numComp, ranges, NULL, 0, false);
     }
 }
 
 //----------------------------------------------------------------------------
+// Compute the range of the L2 norm of the tuples in [begin, end). ghosts,
+// ghostsToSkip and finiteOnly have the same meaning as for
+// DoComputeScalarRange.
 template <class ValueType, class InputIteratorType>
 bool DoComputeVectorRange(InputIteratorType begin, InputIteratorType end,
-                          int numComp, double range[2])
+                          int numComp, double range[2],
+                          const unsigned char* ghosts = NULL,
+                          unsigned char ghostsToSkip = 0xff,
+                          bool finiteOnly = false)
 {
   range[0] = vtkTypeTraits<double>::Max();
   range[1] = vtkTypeTraits<double>::Min();
@@ -205,26 +411,21 @@ bool DoComputeVectorRange(InputIteratorType begin, InputIteratorType end,
   //verify that length of the array is divisible by the number of components
   //this will make sure we don't walk off the end
   assert((end-begin) % numComp == 0);
+  const vtkIdType numTuples = static_cast<vtkIdType>(end - begin) / numComp;
+  const bool threadSafe = IsThreadSafeIterator<InputIteratorType>::value;
 
-  //iterate over all the tuples
-  for (InputIteratorType value = begin; value != end; value+=numComp)
+  if (ghosts || finiteOnly)
     {
-    double squaredSum = 0.0;
-    for (int i = 0; i < numComp; ++i)
-      {
-      const double t = static_cast<double>(value[i]);
-      squaredSum += t * t;
-      }
-    range[0] = detail::min(range[0], squaredSum);
-    range[1] = detail::max(range[1], squaredSum);
+    VectorRangeWorker<ValueType, InputIteratorType, true>
+      worker(begin, numComp, ghosts, ghostsToSkip, finiteOnly);
+    ExecuteRangeWorker(worker, numTuples, numComp, threadSafe);
+    return worker.Reduce(range);
     }
 
-  //now that we have computed the smallest and largest value, take the
-  //square root of that value.
-  range[0] = sqrt(range[0]);
-  range[1] = sqrt(range[1]);
-
-  return true;
+  VectorRangeWorker<ValueType, InputIteratorType, false>
+    worker(begin, numComp, NULL, 0, false);
+  ExecuteRangeWorker(worker, numTuples, numComp, threadSafe);
+  return worker.Reduce(range);
 }
 
 }
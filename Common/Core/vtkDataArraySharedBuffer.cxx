@@ -0,0 +1,100 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArraySharedBuffer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArraySharedBuffer.h"
+
+#include "vtkDataArrayAllocator.h"
+#include "vtkObjectFactory.h"
+
+#include <cstdlib>
+
+vtkStandardNewMacro(vtkDataArraySharedBuffer);
+
+//----------------------------------------------------------------------------
+vtkDataArraySharedBuffer::vtkDataArraySharedBuffer()
+{
+  this->Buffer = 0;
+  this->Size = 0;
+  this->Allocator = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArraySharedBuffer::~vtkDataArraySharedBuffer()
+{
+  this->FreeBuffer();
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArraySharedBuffer::TakeBuffer(void *buffer, size_t size,
+                                          vtkDataArrayAllocator *allocator)
+{
+  if (allocator)
+    {
+    allocator->Register(this);
+    }
+  this->FreeBuffer();
+  this->Buffer = buffer;
+  this->Size = size;
+  this->Allocator = allocator;
+}
+
+//----------------------------------------------------------------------------
+void *vtkDataArraySharedBuffer::ReleaseBuffer(
+  vtkDataArrayAllocator *&allocator)
+{
+  void *buffer = this->Buffer;
+  allocator = this->Allocator;
+  if (allocator)
+    {
+    // Hand our reference over to the caller.
+    allocator->Register(NULL);
+    allocator->UnRegister(this);
+    }
+  this->Buffer = 0;
+  this->Size = 0;
+  this->Allocator = 0;
+  return buffer;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArraySharedBuffer::FreeBuffer()
+{
+  if (this->Buffer)
+    {
+    if (this->Allocator)
+      {
+      this->Allocator->Free(this->Buffer, this->Size);
+      }
+    else
+      {
+      free(this->Buffer);
+      }
+    }
+  if (this->Allocator)
+    {
+    this->Allocator->UnRegister(this);
+    }
+  this->Buffer = 0;
+  this->Size = 0;
+  this->Allocator = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArraySharedBuffer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Buffer: " << this->Buffer << "\n";
+  os << indent << "Size: " << this->Size << "\n";
+  os << indent << "Allocator: " << this->Allocator << "\n";
+}
@@ -0,0 +1,81 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArraySharedBuffer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkDataArraySharedBuffer - reference counted data array buffer
+// .SECTION Description
+// vtkDataArraySharedBuffer owns the memory of data arrays sharing their
+// values copy-on-write (see vtkDataArray::ShallowCopy()). Every array
+// using the buffer holds a reference to it; the memory is released with
+// the last reference. An array about to modify the values copies them
+// first, unless it holds the only reference, in which case it takes the
+// memory back with ReleaseBuffer().
+//
+// This class is used internally by vtkDataArrayTemplate.
+//
+// .SECTION See Also
+// vtkDataArray vtkDataArrayTemplate vtkDataArrayAllocator
+
+#ifndef vtkDataArraySharedBuffer_h
+#define vtkDataArraySharedBuffer_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <cstddef> // For size_t
+
+class vtkDataArrayAllocator;
+
+class VTKCOMMONCORE_EXPORT vtkDataArraySharedBuffer : public vtkObject
+{
+public:
+  static vtkDataArraySharedBuffer *New();
+  vtkTypeMacro(vtkDataArraySharedBuffer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+//BTX
+  // Description:
+  // Take ownership of a buffer of size bytes. It is released with
+  // allocator if not NULL, which is then referenced, and otherwise with
+  // free(). Any buffer owned so far is released.
+  void TakeBuffer(void *buffer, size_t size,
+                  vtkDataArrayAllocator *allocator);
+
+  // Description:
+  // Give up ownership of the buffer without releasing it, and return it.
+  // The reference held on its allocator, possibly NULL, is transferred to
+  // the caller through allocator.
+  void *ReleaseBuffer(vtkDataArrayAllocator *&allocator);
+
+  // Description:
+  // Return the buffer and its size in bytes.
+  void *GetBuffer() { return this->Buffer; }
+  size_t GetSize() { return this->Size; }
+//ETX
+
+protected:
+  vtkDataArraySharedBuffer();
+  ~vtkDataArraySharedBuffer();
+
+  void FreeBuffer();
+
+  void *Buffer;
+  size_t Size;
+  vtkDataArrayAllocator *Allocator;
+
+private:
+  vtkDataArraySharedBuffer(const vtkDataArraySharedBuffer&);  // Not implemented.
+  void operator=(const vtkDataArraySharedBuffer&);  // Not implemented.
+};
+
+#endif
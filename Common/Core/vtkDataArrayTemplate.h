@@ -17,6 +17,9 @@
 // There is a vtkDataArray subclass for each native type supported by
 // VTK.  This template is used to implement all the subclasses in the
 // same way while avoiding code duplication.
+//
+// The memory of the array is provided by vtkDataArrayAllocator::GetInstance(),
+// unless it is supplied by the user with SetArray().
 
 #ifndef vtkDataArrayTemplate_h
 #define vtkDataArrayTemplate_h
@@ -27,6 +30,8 @@
 #include "vtkTypeTemplate.h" // For templated vtkObject API
 #include <cassert> // for assert()
 
+class vtkDataArrayAllocator;
+class vtkDataArraySharedBuffer;
 template <class T>
 class vtkDataArrayTemplateLookup;
 
@@ -173,7 +178,14 @@ public:
 
   // Description:
   // Resize object to just fit data requirement. Reclaims extra memory.
-  void Squeeze() { this->ResizeAndExtend (this->MaxId+1); }
+  // Values shared with other arrays are left alone.
+  void Squeeze()
+    {
+    if (!this->SharedBuffer)
+      {
+      this->ResizeAndExtend(this->MaxId+1);
+      }
+    }
 
   // Description:
   // Return the capacity in typeof T units of the current array.
@@ -191,13 +203,21 @@ public:
   T GetValue(vtkIdType id)
     { assert(id >= 0 && id < this->Size); return this->Array[id]; }
   T& GetValueReference(vtkIdType id)
-    { assert(id >= 0 && id < this->Size); return this->Array[id]; }
+    {
+    assert(id >= 0 && id < this->Size);
+    this->DetachArray();
+    return this->Array[id];
+    }
 
   // Description:
   // Set the data at a particular index. Does not do range checking. Make sure
   // you use the method SetNumberOfValues() before inserting data.
   void SetValue(vtkIdType id, T value)
-    { assert(id >= 0 && id < this->Size); this->Array[id] = value;};
+    {
+    assert(id >= 0 && id < this->Size);
+    this->DetachArray();
+    this->Array[id] = value;
+    }
 
   // Description:
   // Specify the number of values for this object to hold. Does an
@@ -261,9 +281,23 @@ public:
   // If the data is simply being iterated over, consider using
   // vtkDataArrayIteratorMacro for safety and efficiency, rather than using this
   // member directly.
-  T* GetPointer(vtkIdType id) { return this->Array + id; }
+  // Since the values may be modified through the returned pointer, values
+  // shared with other arrays are copied first; use GetReadPointer() to
+  // only read them.
+  T* GetPointer(vtkIdType id) { this->DetachArray(); return this->Array + id; }
   virtual void* GetVoidPointer(vtkIdType id) { return this->GetPointer(id); }
 
+  // Description:
+  // Get the address of a particular data index for reading only. Unlike
+  // GetPointer(), values shared with other arrays are not copied.
+  const T* GetReadPointer(vtkIdType id) const { return this->Array + id; }
+
+  // Description:
+  // Return true if the values of this array are currently shared with
+  // other arrays (see vtkDataArray::ShallowCopy()). They are copied the
+  // first time they are modified.
+  bool IsShared();
+
   // Description:
   // This method lets the user specify data to be held by the array.  The
   // array argument is a pointer to the data.  size is the size of the
@@ -285,6 +319,19 @@ public:
       this->SetArray(static_cast<T*>(array), size, save, deleteMethod);
     }
 
+  // Description:
+  // Use a buffer of size values obtained from allocator. Unlike SetArray(),
+  // the buffer is owned by the array: it is reallocated and released with
+  // allocator, which is kept referenced until then.
+  void SetAllocatedArray(T* array, vtkIdType size,
+                         vtkDataArrayAllocator* allocator);
+  virtual int SetAllocatedVoidArray(void* array, vtkIdType size,
+                                    vtkDataArrayAllocator* allocator)
+    {
+      this->SetAllocatedArray(static_cast<T*>(array), size, allocator);
+      return 1;
+    }
+
   // Description:
   // This method copies the array data to the void pointer specified
   // by the user.  It is up to the user to allocate enough memory for
@@ -346,6 +393,25 @@ protected:
   int SaveUserArray;
   int DeleteMethod;
 
+  // Allocator that provided Array, NULL for arrays set by the user.
+  vtkDataArrayAllocator* Allocator;
+  T* AllocateArray(vtkIdType sz);
+
+  // Owner of Array when it is shared with other arrays, NULL otherwise.
+  // SaveUserArray is set and Allocator is NULL while it is not.
+  vtkDataArraySharedBuffer* SharedBuffer;
+  virtual bool ShareValues(vtkDataArray* other);
+
+  // Copy the values shared with other arrays before they are modified.
+  void DetachArray()
+    {
+    if (this->SharedBuffer)
+      {
+      this->UnshareArray();
+      }
+    }
+  void UnshareArray();
+
   virtual bool ComputeScalarRange(double* ranges);
   virtual bool ComputeVectorRange(double range[2]);
 private:
@@ -19,6 +19,8 @@
 #include "vtkDataArrayPrivate.txx"
 
 #include "vtkArrayIteratorTemplate.h"
+#include "vtkDataArrayAllocator.h"
+#include "vtkDataArraySharedBuffer.h"
 #include "vtkDataArrayTemplateHelper.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
@@ -81,6 +83,8 @@ vtkDataArrayTemplate<T>::vtkDataArrayTemplate()
   this->Tuple = 0;
   this->SaveUserArray = 0;
   this->DeleteMethod = vtkAbstractArray::VTK_DATA_ARRAY_FREE;
+  this->Allocator = 0;
+  this->SharedBuffer = 0;
   this->Lookup = 0;
   this->RebuildLookup = true;
 }
@@ -119,6 +123,28 @@ void vtkDataArrayTemplate<T>::SetArray(T* array,
   this->DataChanged();
 }
 
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::SetAllocatedArray(T* array,
+                                                vtkIdType size,
+                                                vtkDataArrayAllocator* allocator)
+{
+  if (allocator)
+    {
+    // Reference first, the allocator may be the one of the current buffer.
+    allocator->Register(NULL);
+    }
+  this->DeleteArray();
+
+  vtkDebugMacro(<<"Setting allocated array to: " << static_cast<void*>(array));
+
+  this->Array = array;
+  this->Size = size;
+  this->MaxId = size-1;
+  this->Allocator = allocator;
+  this->DataChanged();
+}
+
 //----------------------------------------------------------------------------
 // Allocate memory for this array. Delete old storage only if necessary.
 template <class T>
@@ -126,15 +152,15 @@ int vtkDataArrayTemplate<T>::Allocate(vtkIdType sz, vtkIdType)
 {
   this->MaxId = -1;
 
-  if(sz > this->Size)
+  // The previous values are discarded, no need to copy shared ones.
+  if(sz > this->Size || this->SharedBuffer)
     {
     this->DeleteArray();
 
     this->Size = 0;
 
     vtkIdType newSize = (sz > 0 ? sz : 1);
-    this->Array = static_cast<T*>(malloc(static_cast<size_t>(newSize)
-                                         * sizeof(T)));
+    this->Array = this->AllocateArray(newSize);
     if(this->Array==0)
       {
       vtkErrorMacro("Unable to allocate " << newSize
@@ -207,7 +233,12 @@ void vtkDataArrayTemplate<T>::DeleteArray()
 {
   if ((this->Array) && (!this->SaveUserArray))
     {
-    if (this->DeleteMethod == vtkAbstractArray::VTK_DATA_ARRAY_FREE)
+    if (this->Allocator)
+      {
+      this->Allocator->Free(this->Array,
+                            static_cast<size_t>(this->Size) * sizeof(T));
+      }
+    else if (this->DeleteMethod == vtkAbstractArray::VTK_DATA_ARRAY_FREE)
       {
       free(this->Array);
       }
@@ -216,11 +247,136 @@ void vtkDataArrayTemplate<T>::DeleteArray()
       delete[] this->Array;
       }
     }
+  if (this->Allocator)
+    {
+    this->Allocator->UnRegister(NULL);
+    this->Allocator = 0;
+    }
+  if (this->SharedBuffer)
+    {
+    this->SharedBuffer->UnRegister(NULL);
+    this->SharedBuffer = 0;
+    }
   this->SaveUserArray = 0;
   this->DeleteMethod = vtkAbstractArray::VTK_DATA_ARRAY_FREE;
   this->Array = 0;
 }
 
+//----------------------------------------------------------------------------
+// Allocate a new buffer of sz values with the current allocator. The
+// allocator is kept in this->Allocator, which must be NULL on entry.
+template <class T>
+T* vtkDataArrayTemplate<T>::AllocateArray(vtkIdType sz)
+{
+  vtkDataArrayAllocator* allocator = vtkDataArrayAllocator::GetInstance();
+  T* newArray = static_cast<T*>(
+    allocator->Allocate(static_cast<size_t>(sz) * sizeof(T)));
+  if (newArray)
+    {
+    allocator->Register(NULL);
+    this->Allocator = allocator;
+    }
+  return newArray;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+bool vtkDataArrayTemplate<T>::IsShared()
+{
+  return this->SharedBuffer && this->SharedBuffer->GetReferenceCount() > 1;
+}
+
+//----------------------------------------------------------------------------
+// Use the values of other without copying them. Both arrays reference a
+// vtkDataArraySharedBuffer owning the values until one of them modifies
+// them, see UnshareArray().
+template <class T>
+bool vtkDataArrayTemplate<T>::ShareValues(vtkDataArray* other)
+{
+  vtkDataArrayTemplate<T>* source = vtkDataArrayTemplate<T>::FastDownCast(other);
+  if (!source || source == this || !source->Array)
+    {
+    return false;
+    }
+
+  if (!source->SharedBuffer)
+    {
+    // Buffers set by the user may be modified behind the array's back, and
+    // buffers released with delete[] cannot be released by the shared
+    // buffer: copy those.
+    if (source->SaveUserArray ||
+        (!source->Allocator &&
+         source->DeleteMethod != vtkAbstractArray::VTK_DATA_ARRAY_FREE))
+      {
+      return false;
+      }
+    vtkDataArraySharedBuffer* buffer = vtkDataArraySharedBuffer::New();
+    buffer->TakeBuffer(source->Array,
+                       static_cast<size_t>(source->Size) * sizeof(T),
+                       source->Allocator);
+    if (source->Allocator)
+      {
+      source->Allocator->UnRegister(NULL);
+      source->Allocator = 0;
+      }
+    source->SharedBuffer = buffer;
+    source->SaveUserArray = 1;
+    }
+
+  this->DeleteArray();
+  source->SharedBuffer->Register(NULL);
+  this->SharedBuffer = source->SharedBuffer;
+  this->SaveUserArray = 1;
+  this->Array = source->Array;
+  this->Size = source->Size;
+  this->MaxId = source->MaxId;
+  this->NumberOfComponents = source->NumberOfComponents;
+  this->DataChanged();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Give this array its own copy of the values shared with other arrays. The
+// last array using a shared buffer takes it back instead.
+template <class T>
+void vtkDataArrayTemplate<T>::UnshareArray()
+{
+  vtkDataArraySharedBuffer* buffer = this->SharedBuffer;
+  if (buffer->GetReferenceCount() == 1)
+    {
+    this->Array = static_cast<T*>(buffer->ReleaseBuffer(this->Allocator));
+    this->SharedBuffer = 0;
+    this->SaveUserArray = 0;
+    this->DeleteMethod = vtkAbstractArray::VTK_DATA_ARRAY_FREE;
+    buffer->Delete();
+    return;
+    }
+
+  T* newArray = this->AllocateArray(this->Size);
+  if (!newArray)
+    {
+    vtkErrorMacro("Unable to allocate " << this->Size
+                  << " elements of size " << sizeof(T)
+                  << " bytes. ");
+    #if !defined NDEBUG
+    // We're debugging, crash here preserving the stack
+    abort();
+    #elif !defined VTK_DONT_THROW_BAD_ALLOC
+    // We can throw something that has universal meaning
+    throw std::bad_alloc();
+    #else
+    // We indicate that malloc failed by return
+    return;
+    #endif
+    }
+  memcpy(newArray, this->Array, static_cast<size_t>(this->Size) * sizeof(T));
+  this->SharedBuffer = 0;
+  buffer->UnRegister(NULL);
+  this->SaveUserArray = 0;
+  this->DeleteMethod = vtkAbstractArray::VTK_DATA_ARRAY_FREE;
+  this->Array = newArray;
+}
+
 //----------------------------------------------------------------------------
 template <class T>
 T* vtkDataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
@@ -255,22 +411,11 @@ T* vtkDataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
     return 0;
     }
 
-  // OS X's realloc does not free memory if the new block is smaller.  This
-  // is a very serious problem and causes huge amount of memory to be
-  // wasted. Do not use realloc on the Mac.
-  bool dontUseRealloc=false;
-  #if defined __APPLE__
-  dontUseRealloc=true;
-  #endif
-
-  // Allocate the new array or reallocate the old.
-  if (this->Array
-      &&
-      (this->SaveUserArray
-       || this->DeleteMethod==vtkAbstractArray::VTK_DATA_ARRAY_DELETE
-       || dontUseRealloc ))
+  // Allocate the new array or reallocate the old. Buffers supplied by the
+  // user through SetArray() have no allocator and are never reallocated.
+  if (this->Array && !this->Allocator)
     {
-    newArray = static_cast<T*>(malloc(static_cast<size_t>(newSize)*sizeof(T)));
+    newArray = this->AllocateArray(newSize);
     if(!newArray)
       {
       vtkErrorMacro("Unable to allocate " << newSize
@@ -292,15 +437,26 @@ T* vtkDataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
            static_cast<size_t>(newSize < this->Size ? newSize : this->Size)
            * sizeof(T));
 
-    // Realease old array if we own
+    // Realease old array if we own, but keep the new allocator.
+    vtkDataArrayAllocator* allocator = this->Allocator;
+    this->Allocator = 0;
     this->DeleteArray();
+    this->Allocator = allocator;
     }
   else
     {
     // Try to reallocate with minimal memory usage and possibly avoid
     // copying.
-    newArray = static_cast<T*>(
-      realloc(this->Array,static_cast<size_t>(newSize)*sizeof(T)));
+    if (this->Array)
+      {
+      newArray = static_cast<T*>(this->Allocator->Reallocate(
+        this->Array, static_cast<size_t>(this->Size) * sizeof(T),
+        static_cast<size_t>(newSize) * sizeof(T)));
+      }
+    else
+      {
+      newArray = this->AllocateArray(newSize);
+      }
     if(!newArray)
       {
       vtkErrorMacro("Unable to allocate " << newSize
@@ -377,8 +533,13 @@ void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, vtkIdType j,
   vtkIdType loci = i * this->NumberOfComponents;
   vtkIdType locj = j * source->GetNumberOfComponents();
 
-  T* data = static_cast<T*>(source->GetVoidPointer(0));
+  // Do not make a shared source copy its values.
+  vtkDataArrayTemplate<T>* typedSource =
+    vtkDataArrayTemplate<T>::FastDownCast(source);
+  const T* data = typedSource ? typedSource->GetReadPointer(0) :
+    static_cast<T*>(source->GetVoidPointer(0));
 
+  this->DetachArray();
   for (vtkIdType cur = 0; cur < this->NumberOfComponents; cur++)
     {
     this->Array[loci + cur] = data[locj + cur];
@@ -701,6 +862,7 @@ void vtkDataArrayTemplate<T>::GetTupleValue(vtkIdType i, T* tuple)
 template <class T>
 void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, const float* tuple)
 {
+  this->DetachArray();
   vtkIdType loc = i * this->NumberOfComponents;
   for(int j=0; j < this->NumberOfComponents; ++j)
     {
@@ -712,6 +874,7 @@ void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, const float* tuple)
 template <class T>
 void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, const double* tuple)
 {
+  this->DetachArray();
   vtkIdType loc = i * this->NumberOfComponents;
   for(int j=0; j < this->NumberOfComponents; ++j)
     {
@@ -723,6 +886,7 @@ void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, const double* tuple)
 template <class T>
 void vtkDataArrayTemplate<T>::SetTupleValue(vtkIdType i, const T* tuple)
 {
+  this->DetachArray();
   vtkIdType loc = i * this->NumberOfComponents;
   for(int j=0; j < this->NumberOfComponents; ++j)
     {
@@ -862,6 +1026,7 @@ void vtkDataArrayTemplate<T>::RemoveTuple(vtkIdType id)
   len *= this->GetNumberOfComponents();
   vtkIdType from = (id+1) * this->GetNumberOfComponents();
   vtkIdType to = id * this->GetNumberOfComponents();
+  this->DetachArray();
   memmove(this->Array + to, this->Array + from,
           static_cast<size_t>(len) * sizeof(T));
   this->Resize(this->GetNumberOfTuples() - 1);
@@ -940,6 +1105,7 @@ T* vtkDataArrayTemplate<T>::WritePointer(vtkIdType id,
     {
     this->MaxId = newSize;
     }
+  this->DetachArray();
   this->DataChanged();
   return this->Array + id;
 }
@@ -955,6 +1121,7 @@ void vtkDataArrayTemplate<T>::InsertValue(vtkIdType id, T f)
       return;
       }
     }
+  this->DetachArray();
   this->Array[id] = f;
   if ( id > this->MaxId )
     {
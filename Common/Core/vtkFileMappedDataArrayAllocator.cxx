@@ -0,0 +1,307 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFileMappedDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkFileMappedDataArrayAllocator.h"
+
+#include "vtkDataArray.h"
+#include "vtkObjectFactory.h"
+
+#if defined(_WIN32)
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+vtkStandardNewMacro(vtkFileMappedDataArrayAllocator);
+
+namespace
+{
+// Granularity of the offset given to the system mapping call.
+size_t MappingGranularity()
+{
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return static_cast<size_t>(info.dwAllocationGranularity);
+#else
+  long size = sysconf(_SC_PAGESIZE);
+  return size > 0 ? static_cast<size_t>(size) : 4096;
+#endif
+}
+
+#if !defined(_WIN32)
+// Return the size of an open file in bytes, or -1 on failure.
+vtkTypeInt64 FileSize(int fd)
+{
+  struct stat fs;
+  if (fstat(fd, &fs) != 0)
+    {
+    return -1;
+    }
+  return static_cast<vtkTypeInt64>(fs.st_size);
+}
+#endif
+}
+
+//----------------------------------------------------------------------------
+vtkFileMappedDataArrayAllocator::vtkFileMappedDataArrayAllocator()
+{
+  this->Base = 0;
+  this->BaseLength = 0;
+  this->Pointer = 0;
+  this->Length = 0;
+  this->Mode = READ_ONLY;
+}
+
+//----------------------------------------------------------------------------
+vtkFileMappedDataArrayAllocator::~vtkFileMappedDataArrayAllocator()
+{
+  this->Unmap();
+}
+
+//----------------------------------------------------------------------------
+bool vtkFileMappedDataArrayAllocator::IsSupported()
+{
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void *vtkFileMappedDataArrayAllocator::MapFile(const char *fileName,
+                                               vtkTypeInt64 offset,
+                                               size_t length, int mode)
+{
+  this->Unmap();
+  if (!fileName || offset < 0 || length == 0)
+    {
+    vtkErrorMacro("Cannot map " << length << " bytes at offset " << offset
+                  << " of " << (fileName ? fileName : "(null)"));
+    return 0;
+    }
+
+  const size_t granularity = MappingGranularity();
+  const vtkTypeInt64 alignedOffset =
+    offset - offset % static_cast<vtkTypeInt64>(granularity);
+  const size_t head = static_cast<size_t>(offset - alignedOffset);
+  const size_t baseLength = head + length;
+  void *base = 0;
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    {
+    vtkErrorMacro("Cannot open " << fileName);
+    return 0;
+    }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) ||
+      fileSize.QuadPart < offset + static_cast<vtkTypeInt64>(length))
+    {
+    vtkErrorMacro(<< fileName << " is too short to map " << length
+                  << " bytes at offset " << offset);
+    CloseHandle(file);
+    return 0;
+    }
+  HANDLE mapping = CreateFileMappingA(
+    file, NULL, mode == COPY_ON_WRITE ? PAGE_WRITECOPY : PAGE_READONLY,
+    0, 0, NULL);
+  if (mapping)
+    {
+    base = MapViewOfFile(
+      mapping, mode == COPY_ON_WRITE ? FILE_MAP_COPY : FILE_MAP_READ,
+      static_cast<DWORD>(static_cast<vtkTypeUInt64>(alignedOffset) >> 32),
+      static_cast<DWORD>(alignedOffset & 0xffffffff), baseLength);
+    // The view keeps the file and the mapping alive.
+    CloseHandle(mapping);
+    }
+  CloseHandle(file);
+#else
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+    {
+    vtkErrorMacro("Cannot open " << fileName);
+    return 0;
+    }
+  if (FileSize(fd) < offset + static_cast<vtkTypeInt64>(length))
+    {
+    vtkErrorMacro(<< fileName << " is too short to map " << length
+                  << " bytes at offset " << offset);
+    close(fd);
+    return 0;
+    }
+  base = mmap(0, baseLength,
+              mode == COPY_ON_WRITE ? PROT_READ | PROT_WRITE : PROT_READ,
+              mode == COPY_ON_WRITE ? MAP_PRIVATE : MAP_SHARED,
+              fd, static_cast<off_t>(alignedOffset));
+  if (base == MAP_FAILED)
+    {
+    base = 0;
+    }
+  // The mapping keeps the file alive.
+  close(fd);
+#endif
+
+  if (!base)
+    {
+    vtkErrorMacro("Cannot map " << length << " bytes at offset " << offset
+                  << " of " << fileName);
+    return 0;
+    }
+
+  this->Base = base;
+  this->BaseLength = baseLength;
+  this->Pointer = static_cast<char*>(base) + head;
+  this->Length = length;
+  this->Mode = mode;
+  return this->Pointer;
+}
+
+//----------------------------------------------------------------------------
+void vtkFileMappedDataArrayAllocator::Unmap()
+{
+  if (!this->Base)
+    {
+    return;
+    }
+#if defined(_WIN32)
+  UnmapViewOfFile(this->Base);
+#else
+  munmap(this->Base, this->BaseLength);
+#endif
+  this->Base = 0;
+  this->BaseLength = 0;
+  this->Pointer = 0;
+  this->Length = 0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkFileMappedDataArrayAllocator::Advise(int hint, size_t offset,
+                                             size_t length)
+{
+  if (!this->Base || offset >= this->Length)
+    {
+    return false;
+    }
+  if (length == 0 || length > this->Length - offset)
+    {
+    length = this->Length - offset;
+    }
+#if defined(_WIN32)
+  (void)hint;
+  return false;
+#else
+  int advice;
+  switch (hint)
+    {
+    case NORMAL: advice = MADV_NORMAL; break;
+    case SEQUENTIAL: advice = MADV_SEQUENTIAL; break;
+    case RANDOM: advice = MADV_RANDOM; break;
+    case WILL_NEED: advice = MADV_WILLNEED; break;
+    case DONT_NEED:
+      // Dropping private pages would lose the modifications.
+      if (this->Mode == COPY_ON_WRITE)
+        {
+        return false;
+        }
+      advice = MADV_DONTNEED;
+      break;
+    default:
+      return false;
+    }
+  // madvise() needs a page aligned start.
+  char *start = this->Pointer + offset;
+  const size_t head = static_cast<size_t>(
+    start - static_cast<char*>(this->Base)) % MappingGranularity();
+  return madvise(start - head, length + head, advice) == 0;
+#endif
+}
+
+//----------------------------------------------------------------------------
+void *vtkFileMappedDataArrayAllocator::Reallocate(void *ptr, size_t oldSize,
+                                                  size_t newSize)
+{
+  if (ptr && ptr == this->Pointer)
+    {
+    // Move the values out of the mapping, which goes away in Free().
+    return this->CopyReallocate(ptr, oldSize, newSize);
+    }
+  return this->Superclass::Reallocate(ptr, oldSize, newSize);
+}
+
+//----------------------------------------------------------------------------
+void vtkFileMappedDataArrayAllocator::Free(void *ptr, size_t size)
+{
+  if (ptr && ptr == this->Pointer)
+    {
+    this->Unmap();
+    return;
+    }
+  this->Superclass::Free(ptr, size);
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray *vtkFileMappedDataArrayAllocator::MapArray(
+  const char *fileName, vtkTypeInt64 offset, int dataType,
+  int numberOfComponents, vtkIdType numberOfTuples, int mode, int hint)
+{
+  if (numberOfComponents < 1 || numberOfTuples < 1)
+    {
+    return 0;
+    }
+  vtkDataArray *array = vtkDataArray::CreateDataArray(dataType);
+  if (!array)
+    {
+    return 0;
+    }
+  // Bit arrays do not have one value per element size.
+  const int valueSize = dataType == VTK_BIT ? 0 : array->GetDataTypeSize();
+  if (valueSize == 0 || offset % valueSize != 0)
+    {
+    array->Delete();
+    return 0;
+    }
+
+  const vtkIdType numberOfValues = numberOfTuples * numberOfComponents;
+  vtkFileMappedDataArrayAllocator *allocator =
+    vtkFileMappedDataArrayAllocator::New();
+  void *ptr = allocator->MapFile(
+    fileName, offset, static_cast<size_t>(numberOfValues) * valueSize, mode);
+  array->SetNumberOfComponents(numberOfComponents);
+  if (!ptr || !array->SetAllocatedVoidArray(ptr, numberOfValues, allocator))
+    {
+    allocator->Delete();
+    array->Delete();
+    return 0;
+    }
+  if (hint != NORMAL)
+    {
+    allocator->Advise(hint);
+    }
+  allocator->Delete();
+  return array;
+}
+
+//----------------------------------------------------------------------------
+void vtkFileMappedDataArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Mode: "
+     << (this->Mode == COPY_ON_WRITE ? "COPY_ON_WRITE" : "READ_ONLY") << "\n";
+  os << indent << "MappedPointer: " << static_cast<void*>(this->Pointer)
+     << "\n";
+  os << indent << "MappedLength: " << this->Length << "\n";
+}
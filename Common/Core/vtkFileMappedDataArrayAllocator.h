@@ -0,0 +1,145 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFileMappedDataArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkFileMappedDataArrayAllocator - data array memory mapped from a file
+// .SECTION Description
+// vtkFileMappedDataArrayAllocator maps a region of a file into memory and
+// hands it to a data array, so that the values are paged in from the file
+// on first access instead of being copied by the reader. Datasets larger
+// than the physical memory can then be read, the operating system page
+// cache acting as the out-of-core layer.
+//
+// Each instance holds at most one mapping, which is released when the
+// array that uses it frees its memory. The mapping is either READ_ONLY,
+// shared with the page cache and never written, or COPY_ON_WRITE, where
+// modified pages become private to the process and are never written back
+// to the file. Writing to a READ_ONLY mapping crashes the process, so it
+// must only be used for arrays that are known not to be modified. When an
+// array that uses a mapping is resized, its values are copied to memory
+// allocated like in vtkDataArrayAllocator and the mapping is released.
+//
+// Most users only need MapArray(). The file must not be truncated while it
+// is mapped.
+//
+// .SECTION See Also
+// vtkDataArrayAllocator vtkDataArray::SetAllocatedVoidArray
+
+#ifndef vtkFileMappedDataArrayAllocator_h
+#define vtkFileMappedDataArrayAllocator_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkDataArrayAllocator.h"
+
+class vtkDataArray;
+
+class VTKCOMMONCORE_EXPORT vtkFileMappedDataArrayAllocator
+  : public vtkDataArrayAllocator
+{
+public:
+  static vtkFileMappedDataArrayAllocator *New();
+  vtkTypeMacro(vtkFileMappedDataArrayAllocator, vtkDataArrayAllocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  enum MappingModes
+  {
+    READ_ONLY = 0,
+    COPY_ON_WRITE = 1
+  };
+
+  // Description:
+  // Access patterns given to Advise(). WILL_NEED starts reading the pages
+  // in the background and DONT_NEED lets the system drop them.
+  enum AccessHints
+  {
+    NORMAL = 0,
+    SEQUENTIAL,
+    RANDOM,
+    WILL_NEED,
+    DONT_NEED
+  };
+
+  // Description:
+  // Return true if files can be mapped on this platform.
+  static bool IsSupported();
+
+  // Description:
+  // Create an array of the given type that maps numberOfTuples tuples of
+  // numberOfComponents values stored at offset bytes in fileName, in native
+  // byte order. offset must be a multiple of the size of the values. The
+  // hint is passed to Advise() for the whole array. Returns NULL on failure,
+  // in which case the data must be read the usual way. The caller owns the
+  // returned array.
+  static vtkDataArray *MapArray(const char *fileName, vtkTypeInt64 offset,
+                                int dataType, int numberOfComponents,
+                                vtkIdType numberOfTuples,
+                                int mode, int hint);
+  static vtkDataArray *MapArray(const char *fileName, vtkTypeInt64 offset,
+                                int dataType, int numberOfComponents,
+                                vtkIdType numberOfTuples, int mode)
+    {
+    return MapArray(fileName, offset, dataType, numberOfComponents,
+                    numberOfTuples, mode, NORMAL);
+    }
+
+  // Description:
+  // Return the mode of the current mapping.
+  vtkGetMacro(Mode, int);
+
+//BTX
+  // Description:
+  // Map length bytes of fileName starting at offset with the given mode
+  // and return the address of the first byte, or NULL on failure. The
+  // previous mapping, which must not be used by an array, is released.
+  void *MapFile(const char *fileName, vtkTypeInt64 offset, size_t length,
+                int mode);
+
+  // Description:
+  // Release the current mapping. Only needed for a mapping that was never
+  // handed to an array.
+  void Unmap();
+
+  // Description:
+  // Return the address and the length in bytes of the current mapping.
+  void *GetMappedPointer() { return this->Pointer; }
+  size_t GetMappedLength() { return this->Length; }
+
+  // Description:
+  // Tell the system how length bytes of the mapping starting at offset
+  // will be accessed; a length of 0 extends to the end of the mapping.
+  // Returns false if the hint is not supported or the mapping is empty.
+  // This is only a hint and never changes the values.
+  bool Advise(int hint, size_t offset = 0, size_t length = 0);
+
+  virtual void *Reallocate(void *ptr, size_t oldSize, size_t newSize);
+  virtual void Free(void *ptr, size_t size);
+//ETX
+
+protected:
+  vtkFileMappedDataArrayAllocator();
+  ~vtkFileMappedDataArrayAllocator();
+
+  // Page aligned start and length of the system mapping.
+  void *Base;
+  size_t BaseLength;
+  // Requested region inside the system mapping.
+  char *Pointer;
+  size_t Length;
+  int Mode;
+
+private:
+  vtkFileMappedDataArrayAllocator(const vtkFileMappedDataArrayAllocator&);  // Not implemented.
+  void operator=(const vtkFileMappedDataArrayAllocator&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,116 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFirstTouchDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkFirstTouchDataArrayAllocator.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <cstring>
+
+vtkStandardNewMacro(vtkFirstTouchDataArrayAllocator);
+
+namespace
+{
+const size_t PageSize = 4096;
+
+// Copy (or zero when Source is NULL) the pages [begin, end) of a block.
+struct TouchPages
+{
+  char *Target;
+  const char *Source;
+  size_t SourceSize;
+  size_t Size;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    size_t first = static_cast<size_t>(begin) * PageSize;
+    size_t last = static_cast<size_t>(end) * PageSize;
+    last = last < this->Size ? last : this->Size;
+    size_t copyEnd = last < this->SourceSize ? last : this->SourceSize;
+    if (this->Source && first < copyEnd)
+      {
+      memcpy(this->Target + first, this->Source + first, copyEnd - first);
+      first = copyEnd;
+      }
+    if (first < last)
+      {
+      memset(this->Target + first, 0, last - first);
+      }
+    }
+};
+
+void ParallelTouch(void *target, size_t size,
+                   const void *source, size_t sourceSize)
+{
+  TouchPages functor;
+  functor.Target = static_cast<char*>(target);
+  functor.Source = static_cast<const char*>(source);
+  functor.SourceSize = source ? sourceSize : 0;
+  functor.Size = size;
+  vtkIdType numPages = static_cast<vtkIdType>((size + PageSize - 1) / PageSize);
+  vtkSMPTools::For(0, numPages, functor);
+}
+}
+
+//----------------------------------------------------------------------------
+vtkFirstTouchDataArrayAllocator::vtkFirstTouchDataArrayAllocator()
+{
+  this->Alignment = static_cast<int>(PageSize);
+  this->ParallelThreshold = 1024 * 1024;
+}
+
+//----------------------------------------------------------------------------
+vtkFirstTouchDataArrayAllocator::~vtkFirstTouchDataArrayAllocator()
+{
+}
+
+//----------------------------------------------------------------------------
+void *vtkFirstTouchDataArrayAllocator::Allocate(size_t size)
+{
+  void *ptr = this->Superclass::Allocate(size);
+  if (ptr && size >= static_cast<size_t>(this->ParallelThreshold))
+    {
+    ParallelTouch(ptr, size, 0, 0);
+    }
+  return ptr;
+}
+
+//----------------------------------------------------------------------------
+void *vtkFirstTouchDataArrayAllocator::Reallocate(void *ptr, size_t oldSize,
+                                                  size_t newSize)
+{
+  if (newSize < static_cast<size_t>(this->ParallelThreshold))
+    {
+    return this->Superclass::Reallocate(ptr, oldSize, newSize);
+    }
+  // Skip the zeroing pass of Allocate(); the copy touches the pages.
+  void *newPtr = this->Superclass::Allocate(newSize);
+  if (newPtr)
+    {
+    ParallelTouch(newPtr, newSize, ptr, ptr ? oldSize : 0);
+    if (ptr)
+      {
+      this->Free(ptr, oldSize);
+      }
+    }
+  return newPtr;
+}
+
+//----------------------------------------------------------------------------
+void vtkFirstTouchDataArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "ParallelThreshold: " << this->ParallelThreshold << "\n";
+}
@@ -0,0 +1,68 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFirstTouchDataArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkFirstTouchDataArrayAllocator - NUMA friendly data array memory
+// .SECTION Description
+// Operating systems place a page on the NUMA node of the thread that first
+// writes it. Memory initialized by a single thread therefore all lands on
+// one socket, and threads running on the other sockets pay remote access
+// costs for the lifetime of the array. vtkFirstTouchDataArrayAllocator
+// touches the pages of large blocks from a vtkSMPTools::For loop right
+// after allocating them, and also copies the contents in parallel when a
+// block is reallocated, so that the pages are spread over the threads the
+// same way as the subsequent vtkSMPTools loops over the array.
+//
+// Blocks are page aligned and zero initialized when they are at least
+// ParallelThreshold bytes long.
+//
+// .SECTION See Also
+// vtkDataArrayAllocator vtkSMPTools
+
+#ifndef vtkFirstTouchDataArrayAllocator_h
+#define vtkFirstTouchDataArrayAllocator_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkAlignedDataArrayAllocator.h"
+
+class VTKCOMMONCORE_EXPORT vtkFirstTouchDataArrayAllocator
+  : public vtkAlignedDataArrayAllocator
+{
+public:
+  static vtkFirstTouchDataArrayAllocator *New();
+  vtkTypeMacro(vtkFirstTouchDataArrayAllocator, vtkAlignedDataArrayAllocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Blocks smaller than this number of bytes are allocated without
+  // parallel initialization. The default is 1 MiB.
+  vtkSetMacro(ParallelThreshold, vtkIdType);
+  vtkGetMacro(ParallelThreshold, vtkIdType);
+
+//BTX
+  virtual void *Allocate(size_t size);
+  virtual void *Reallocate(void *ptr, size_t oldSize, size_t newSize);
+//ETX
+
+protected:
+  vtkFirstTouchDataArrayAllocator();
+  ~vtkFirstTouchDataArrayAllocator();
+
+  vtkIdType ParallelThreshold;
+
+private:
+  vtkFirstTouchDataArrayAllocator(const vtkFirstTouchDataArrayAllocator&);  // Not implemented.
+  void operator=(const vtkFirstTouchDataArrayAllocator&);  // Not implemented.
+};
+
+#endif
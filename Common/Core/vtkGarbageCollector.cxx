@@ -172,6 +172,10 @@ public:
   void DeferredCollectionPush();
   void DeferredCollectionPop();
 
+  // Push/Pop batched collection epochs.
+  void BatchCollectionPush();
+  void BatchCollectionPop();
+
   // Map from object to number of stored references.
 #if VTK_GARBAGE_COLLECTOR_HASH
   typedef vtksys::hash_map<vtkObjectBase*, int, vtkGarbageCollectorHash>
@@ -187,6 +191,14 @@ public:
   // The number of times DeferredCollectionPush has been called not
   // matched by a DeferredCollectionPop.
   int DeferredCollectionCount;
+
+  // The number of times BatchCollectionPush has been called not
+  // matched by a BatchCollectionPop.
+  int BatchCollectionCount;
+
+  // Whether vtkGarbageCollector::Collect is walking the deferred
+  // references.
+  bool Collecting;
 };
 
 //----------------------------------------------------------------------------
@@ -207,8 +219,8 @@ public:
   // Prevent normal vtkObject reference counting behavior.
   virtual void UnRegister(vtkObjectBase*);
 
-  // Perform a collection check.
-  void CollectInternal(vtkObjectBase* root);
+  // Perform a collection check using the given objects as roots.
+  void CollectInternal(vtkObjectBase* const* roots, size_t numberOfRoots);
 
 
 // Sun's compiler is broken and does not allow access to protected members from
@@ -349,7 +361,7 @@ public:
 
   // Walk the reference graph using Tarjan's algorithm to identify
   // strongly connected components.
-  void FindComponents(vtkObjectBase* root);
+  void FindComponents(vtkObjectBase* const* roots, size_t numberOfRoots);
 
   // Get the entry for the given object.  This may visit the object.
   Entry* MaybeVisit(vtkObjectBase*);
@@ -453,10 +465,11 @@ void vtkGarbageCollectorImpl::UnRegister(vtkObjectBase*)
 }
 
 //----------------------------------------------------------------------------
-void vtkGarbageCollectorImpl::CollectInternal(vtkObjectBase* root)
+void vtkGarbageCollectorImpl::CollectInternal(vtkObjectBase* const* roots,
+                                              size_t numberOfRoots)
 {
   // Identify strong components.
-  this->FindComponents(root);
+  this->FindComponents(roots, numberOfRoots);
 
   // Delete all the leaked components.
   while(!this->LeakedComponents.empty())
@@ -499,12 +512,17 @@ void vtkGarbageCollectorImpl::CollectInternal(vtkObjectBase* root)
 }
 
 //----------------------------------------------------------------------------
-void vtkGarbageCollectorImpl::FindComponents(vtkObjectBase* root)
+void vtkGarbageCollectorImpl::FindComponents(vtkObjectBase* const* roots,
+                                             size_t numberOfRoots)
 {
-  // Walk the references from the given object, if any.
-  if(root)
+  // Walk the references from the given objects, if any.  Objects
+  // already reached from an earlier root are not visited again.
+  for(size_t i = 0; i < numberOfRoots; ++i)
     {
-    this->MaybeVisit(root);
+    if(roots[i])
+      {
+      this->MaybeVisit(roots[i]);
+      }
     }
 }
 
@@ -879,17 +897,41 @@ void vtkGarbageCollector::Collect()
   // This must be called only from the main thread.
   assert(vtkGarbageCollectorIsMainThread());
 
+  vtkGarbageCollectorSingleton* singleton =
+    vtkGarbageCollectorSingletonInstance;
+  if(!singleton)
+    {
+    return;
+    }
+
+  // While a batch epoch is closing, references released by the
+  // objects we delete are queued for the next walk.
+  bool saveCollecting = singleton->Collecting;
+  singleton->Collecting = true;
+
   // Keep collecting until no deferred checks exist.
-  while(vtkGarbageCollectorSingletonInstance &&
-        vtkGarbageCollectorSingletonInstance->TotalNumberOfReferences > 0)
+  std::vector<vtkObjectBase*> roots;
+  while(singleton->TotalNumberOfReferences > 0)
     {
-    // Collect starting from one deferred object at a time.  Each
-    // check will remove at least the starting object and possibly
-    // other objects from the singleton's references.
-    vtkObjectBase* root =
-      vtkGarbageCollectorSingletonInstance->References.begin()->first;
-    vtkGarbageCollector::Collect(root);
+    // Walk from all the deferred objects at once so that parts of the
+    // reference graph shared between them are searched only once.
+    // Visiting a root takes its references from the singleton.
+    roots.clear();
+    for(vtkGarbageCollectorSingleton::ReferencesType::iterator
+          i = singleton->References.begin(), iend = singleton->References.end();
+        i != iend; ++i)
+      {
+      roots.push_back(i->first);
+      }
+
+    vtkGarbageCollectorImpl collector;
+    vtkDebugWithObjectMacro((&collector), "Starting collection check of "
+                            << roots.size() << " deferred objects.");
+    collector.CollectInternal(&roots[0], roots.size());
+    vtkDebugWithObjectMacro((&collector), "Finished collection check.");
     }
+
+  singleton->Collecting = saveCollecting;
 }
 
 //----------------------------------------------------------------------------
@@ -901,7 +943,7 @@ void vtkGarbageCollector::Collect(vtkObjectBase* root)
   vtkDebugWithObjectMacro((&collector), "Starting collection check.");
 
   // Collect leaked objects.
-  collector.CollectInternal(root);
+  collector.CollectInternal(&root, 1);
 
   vtkDebugWithObjectMacro((&collector), "Finished collection check.");
 }
@@ -932,6 +974,32 @@ void vtkGarbageCollector::DeferredCollectionPop()
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkGarbageCollector::BatchCollectionPush()
+{
+  // This must be called only from the main thread.
+  assert(vtkGarbageCollectorIsMainThread());
+
+  // Forward the call to the singleton.
+  if(vtkGarbageCollectorSingletonInstance)
+    {
+    vtkGarbageCollectorSingletonInstance->BatchCollectionPush();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkGarbageCollector::BatchCollectionPop()
+{
+  // This must be called only from the main thread.
+  assert(vtkGarbageCollectorIsMainThread());
+
+  // Forward the call to the singleton.
+  if(vtkGarbageCollectorSingletonInstance)
+    {
+    vtkGarbageCollectorSingletonInstance->BatchCollectionPop();
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkGarbageCollector::GiveReference(vtkObjectBase* obj)
 {
@@ -971,6 +1039,8 @@ vtkGarbageCollectorSingleton::vtkGarbageCollectorSingleton()
 {
   this->TotalNumberOfReferences = 0;
   this->DeferredCollectionCount = 0;
+  this->BatchCollectionCount = 0;
+  this->Collecting = false;
 }
 
 //----------------------------------------------------------------------------
@@ -1037,7 +1107,12 @@ int vtkGarbageCollectorSingleton::CheckAccept()
   // construction.  We do not want to perform deferred collection
   // while an object is under construction because the reference walk
   // might call ReportReferences on a partially constructed object!
-  return this->DeferredCollectionCount > 0;
+  //
+  // While the collection closing a batch epoch runs, references are
+  // accepted too.  They are released by destructors of collected
+  // objects and are walked only once the current walk is complete.
+  return this->DeferredCollectionCount > 0 ||
+    (this->BatchCollectionCount > 0 && this->Collecting);
 }
 
 //----------------------------------------------------------------------------
@@ -1060,6 +1135,22 @@ void vtkGarbageCollectorSingleton::DeferredCollectionPop()
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkGarbageCollectorSingleton::BatchCollectionPush()
+{
+  ++this->BatchCollectionCount;
+  this->DeferredCollectionPush();
+}
+
+//----------------------------------------------------------------------------
+void vtkGarbageCollectorSingleton::BatchCollectionPop()
+{
+  // Pop the deferral first so that the epoch is still open while the
+  // collection it triggers runs.
+  this->DeferredCollectionPop();
+  --this->BatchCollectionCount;
+}
+
 //----------------------------------------------------------------------------
 void vtkGarbageCollectorReportInternal(vtkGarbageCollector* collector,
                                        vtkObjectBase* obj, void* ptr,
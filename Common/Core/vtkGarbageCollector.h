@@ -130,6 +130,17 @@ public:
   static void DeferredCollectionPush();
   static void DeferredCollectionPop();
 
+  // Description:
+  // Push/Pop a batched collection epoch around bulk construction or
+  // teardown.  Collection is deferred while an epoch is open, as with
+  // DeferredCollectionPush.  When the outermost epoch closes all the
+  // deferred objects are collected in a single reference graph walk,
+  // and references released by the objects deleted during that walk
+  // are queued for the next walk instead of each starting its own
+  // check.
+  static void BatchCollectionPush();
+  static void BatchCollectionPop();
+
   // Description:
   // Set/Get global garbage collection debugging flag.  When set to true,
   // all garbage collection checks will produce debugging information.
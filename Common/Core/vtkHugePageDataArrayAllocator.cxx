@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHugePageDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkHugePageDataArrayAllocator.h"
+
+#include "vtkObjectFactory.h"
+
+#if defined(__linux__)
+# include <sys/mman.h>
+# if defined(MADV_HUGEPAGE)
+#  define VTK_USE_TRANSPARENT_HUGE_PAGES
+# endif
+#endif
+
+vtkStandardNewMacro(vtkHugePageDataArrayAllocator);
+
+namespace
+{
+const size_t HugePageSize = 2 * 1024 * 1024;
+
+// Blocks of at least one huge page are mapped directly. The decision only
+// depends on the size so that Free() takes the same path as Allocate().
+inline bool UseHugePages(size_t size)
+{
+#if defined(VTK_USE_TRANSPARENT_HUGE_PAGES)
+  return size >= HugePageSize;
+#else
+  (void)size;
+  return false;
+#endif
+}
+
+inline size_t RoundToHugePage(size_t size)
+{
+  return (size + HugePageSize - 1) & ~(HugePageSize - 1);
+}
+}
+
+//----------------------------------------------------------------------------
+vtkHugePageDataArrayAllocator::vtkHugePageDataArrayAllocator()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkHugePageDataArrayAllocator::~vtkHugePageDataArrayAllocator()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkHugePageDataArrayAllocator::GetHugePageSize()
+{
+  return static_cast<vtkIdType>(HugePageSize);
+}
+
+//----------------------------------------------------------------------------
+bool vtkHugePageDataArrayAllocator::IsSupported()
+{
+#if defined(VTK_USE_TRANSPARENT_HUGE_PAGES)
+  return true;
+#else
+  return false;
+#endif
+}
+
+//----------------------------------------------------------------------------
+void *vtkHugePageDataArrayAllocator::Allocate(size_t size)
+{
+  if (!UseHugePages(size))
+    {
+    return this->Superclass::Allocate(size);
+    }
+#if defined(VTK_USE_TRANSPARENT_HUGE_PAGES)
+  // Over-allocate by one huge page and trim both ends so that the block
+  // starts on a huge page boundary; the kernel collapses only aligned
+  // 2 MiB ranges.
+  const size_t length = RoundToHugePage(size);
+  const size_t mapped = length + HugePageSize;
+  void *ptr = mmap(0, mapped, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED)
+    {
+    return 0;
+    }
+  char *base = static_cast<char*>(ptr);
+  char *aligned = reinterpret_cast<char*>(RoundToHugePage(
+    reinterpret_cast<size_t>(base)));
+  const size_t head = static_cast<size_t>(aligned - base);
+  if (head > 0)
+    {
+    munmap(base, head);
+    }
+  if (mapped - head > length)
+    {
+    munmap(aligned + length, mapped - head - length);
+    }
+  // This is only a hint; the block is usable even if it is refused.
+  madvise(aligned, length, MADV_HUGEPAGE);
+  return aligned;
+#else
+  return 0;
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkHugePageDataArrayAllocator::Free(void *ptr, size_t size)
+{
+  if (!UseHugePages(size))
+    {
+    this->Superclass::Free(ptr, size);
+    return;
+    }
+#if defined(VTK_USE_TRANSPARENT_HUGE_PAGES)
+  if (ptr)
+    {
+    munmap(ptr, RoundToHugePage(size));
+    }
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkHugePageDataArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Supported: " << (IsSupported() ? "true" : "false") << "\n";
+}
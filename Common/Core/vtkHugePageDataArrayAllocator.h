@@ -0,0 +1,64 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHugePageDataArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkHugePageDataArrayAllocator - data array memory backed by huge pages
+// .SECTION Description
+// vtkHugePageDataArrayAllocator maps blocks of at least HugePageSize bytes
+// directly from the operating system, aligned on a huge page boundary, and
+// asks the kernel to back them with transparent huge pages. This reduces
+// TLB misses for random access into large arrays, such as the point
+// coordinates searched by locators. Smaller blocks, and all blocks on
+// platforms without transparent huge page support, are allocated like in
+// vtkAlignedDataArrayAllocator.
+//
+// .SECTION See Also
+// vtkDataArrayAllocator vtkAlignedDataArrayAllocator
+
+#ifndef vtkHugePageDataArrayAllocator_h
+#define vtkHugePageDataArrayAllocator_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkAlignedDataArrayAllocator.h"
+
+class VTKCOMMONCORE_EXPORT vtkHugePageDataArrayAllocator
+  : public vtkAlignedDataArrayAllocator
+{
+public:
+  static vtkHugePageDataArrayAllocator *New();
+  vtkTypeMacro(vtkHugePageDataArrayAllocator, vtkAlignedDataArrayAllocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Size in bytes of a huge page (2 MiB on x86-64 Linux).
+  static vtkIdType GetHugePageSize();
+
+  // Description:
+  // Return true if huge pages are requested on this platform.
+  static bool IsSupported();
+
+//BTX
+  virtual void *Allocate(size_t size);
+  virtual void Free(void *ptr, size_t size);
+//ETX
+
+protected:
+  vtkHugePageDataArrayAllocator();
+  ~vtkHugePageDataArrayAllocator();
+
+private:
+  vtkHugePageDataArrayAllocator(const vtkHugePageDataArrayAllocator&);  // Not implemented.
+  void operator=(const vtkHugePageDataArrayAllocator&);  // Not implemented.
+};
+
+#endif
@@ -21,23 +21,29 @@ vtkStandardNewMacro(vtkIdList);
 vtkIdList::vtkIdList()
 {
   this->NumberOfIds = 0;
-  this->Size = 0;
-  this->Ids = NULL;
+  this->Size = VTK_ID_LIST_INLINE_SIZE;
+  this->Ids = this->InlineIds;
 }
 
 //----------------------------------------------------------------------------
 vtkIdList::~vtkIdList()
 {
-  delete [] this->Ids;
+  if (this->Ids != this->InlineIds)
+    {
+    delete [] this->Ids;
+    }
 }
 
 //----------------------------------------------------------------------------
 void vtkIdList::Initialize()
 {
-  delete [] this->Ids;
-  this->Ids = NULL;
+  if (this->Ids != this->InlineIds)
+    {
+    delete [] this->Ids;
+    }
+  this->Ids = this->InlineIds;
   this->NumberOfIds = 0;
-  this->Size = 0;
+  this->Size = VTK_ID_LIST_INLINE_SIZE;
 }
 
 //----------------------------------------------------------------------------
@@ -46,10 +52,13 @@ int vtkIdList::Allocate(const vtkIdType sz, const int vtkNotUsed(strategy))
   if ( sz > this->Size)
     {
     this->Initialize();
-    this->Size = ( sz > 0 ? sz : 1);
-    if ( (this->Ids = new vtkIdType[this->Size]) == NULL )
+    if ( sz > this->Size )
       {
-      return 0;
+      this->Size = sz;
+      if ( (this->Ids = new vtkIdType[this->Size]) == NULL )
+        {
+        return 0;
+        }
       }
     }
   this->NumberOfIds = 0;
@@ -95,7 +104,10 @@ vtkIdType *vtkIdList::WritePointer(const vtkIdType i, const vtkIdType number)
 //----------------------------------------------------------------------------
 void vtkIdList::SetArray(vtkIdType *array, vtkIdType size)
 {
-  delete [] this->Ids;
+  if (this->Ids != this->InlineIds)
+    {
+    delete [] this->Ids;
+    }
   this->Ids = array;
   this->NumberOfIds = size;
   this->Size = size;
@@ -162,6 +174,20 @@ vtkIdType *vtkIdList::Resize(const vtkIdType sz)
     return 0;
     }
 
+  if (newSize <= VTK_ID_LIST_INLINE_SIZE)
+    {
+    // Small enough for the inline storage.
+    if (this->Ids != this->InlineIds)
+      {
+      memcpy(this->InlineIds, this->Ids,
+             static_cast<size_t>(sz < this->Size ? sz : this->Size) * sizeof(vtkIdType));
+      delete [] this->Ids;
+      this->Ids = this->InlineIds;
+      }
+    this->Size = VTK_ID_LIST_INLINE_SIZE;
+    return this->Ids;
+    }
+
   if ( (newIds = new vtkIdType[newSize]) == NULL )
     {
     vtkErrorMacro(<< "Cannot allocate memory\n");
@@ -172,7 +198,10 @@ vtkIdType *vtkIdList::Resize(const vtkIdType sz)
     {
     memcpy(newIds, this->Ids,
            static_cast<size_t>(sz < this->Size ? sz : this->Size) * sizeof(vtkIdType));
-    delete [] this->Ids;
+    if (this->Ids != this->InlineIds)
+      {
+      delete [] this->Ids;
+      }
     }
 
   this->Size = newSize;
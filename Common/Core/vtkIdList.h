@@ -17,6 +17,10 @@
 // vtkIdList is used to represent and pass data id's between
 // objects. vtkIdList may represent any type of integer id, but
 // usually represents point and cell ids.
+//
+// Lists of up to VTK_ID_LIST_INLINE_SIZE ids are stored inside the object
+// itself, so filling a reused list with the point ids of most cells does
+// not allocate memory.
 
 #ifndef vtkIdList_h
 #define vtkIdList_h
@@ -24,6 +28,9 @@
 #include "vtkCommonCoreModule.h" // For export macro
 #include "vtkObject.h"
 
+// Number of ids stored without a memory allocation.
+#define VTK_ID_LIST_INLINE_SIZE 16
+
 class VTKCOMMONCORE_EXPORT vtkIdList : public vtkObject
 {
 public:
@@ -133,6 +140,7 @@ protected:
   vtkIdType NumberOfIds;
   vtkIdType Size;
   vtkIdType *Ids;
+  vtkIdType InlineIds[VTK_ID_LIST_INLINE_SIZE];
 
 private:
   vtkIdList(const vtkIdList&);  // Not implemented.
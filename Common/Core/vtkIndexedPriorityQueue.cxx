@@ -0,0 +1,315 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkIndexedPriorityQueue.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkIndexedPriorityQueue.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+
+vtkStandardNewMacro(vtkIndexedPriorityQueue);
+
+// Number of children of the nodes of the heap.
+static const vtkIdType vtkIndexedPriorityQueueArity = 4;
+
+//----------------------------------------------------------------------------
+vtkIndexedPriorityQueue::vtkIndexedPriorityQueue()
+{
+  this->Heap = NULL;
+  this->HeapSize = 0;
+  this->HeapCapacity = 0;
+  this->Location = NULL;
+  this->NumberOfIds = 0;
+  this->NumberOfItems = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkIndexedPriorityQueue::~vtkIndexedPriorityQueue()
+{
+  delete [] this->Heap;
+  delete [] this->Location;
+}
+
+//----------------------------------------------------------------------------
+inline bool vtkIndexedPriorityQueue::IsLess(const Item& a, const Item& b)
+{
+  return a.Priority < b.Priority || (a.Priority == b.Priority &&
+    vtkIndexedPriorityQueue::GetItemId(a) <
+    vtkIndexedPriorityQueue::GetItemId(b));
+}
+
+//----------------------------------------------------------------------------
+void vtkIndexedPriorityQueue::Allocate(vtkIdType numIds)
+{
+  this->Reset();
+  this->ReserveIds(numIds);
+  if (this->HeapCapacity < numIds)
+    {
+    delete [] this->Heap;
+    this->Heap = new Item[numIds];
+    this->HeapCapacity = numIds;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkIndexedPriorityQueue::ReserveIds(vtkIdType numIds)
+{
+  if (numIds <= this->NumberOfIds)
+    {
+    return;
+    }
+  vtkIdType newSize = std::max(numIds, 2 * this->NumberOfIds);
+  vtkIdType *location = new vtkIdType[newSize];
+  std::copy(this->Location, this->Location + this->NumberOfIds, location);
+  std::fill(location + this->NumberOfIds, location + newSize,
+            static_cast<vtkIdType>(-1));
+  delete [] this->Location;
+  this->Location = location;
+  this->NumberOfIds = newSize;
+}
+
+//----------------------------------------------------------------------------
+// Move the entry at location up until its parent is smaller, shifting the
+// parents down into the hole.
+void vtkIndexedPriorityQueue::SiftUp(vtkIdType location)
+{
+  Item item = this->Heap[location];
+  while (location > 0)
+    {
+    vtkIdType parent = (location - 1) / vtkIndexedPriorityQueueArity;
+    if (!IsLess(item, this->Heap[parent]))
+      {
+      break;
+      }
+    this->Heap[location] = this->Heap[parent];
+    this->Location[GetItemId(this->Heap[location])] = location;
+    location = parent;
+    }
+  this->Heap[location] = item;
+  this->Location[GetItemId(item)] = location;
+}
+
+//----------------------------------------------------------------------------
+// Move the entry at location down until its children are larger, shifting
+// the smallest child up into the hole.
+void vtkIndexedPriorityQueue::SiftDown(vtkIdType location)
+{
+  Item item = this->Heap[location];
+  for (;;)
+    {
+    vtkIdType first = vtkIndexedPriorityQueueArity * location + 1;
+    if (first >= this->HeapSize)
+      {
+      break;
+      }
+    vtkIdType last = std::min(first + vtkIndexedPriorityQueueArity,
+                              this->HeapSize);
+    vtkIdType smallest = first;
+    for (vtkIdType child = first + 1; child < last; ++child)
+      {
+      if (IsLess(this->Heap[child], this->Heap[smallest]))
+        {
+        smallest = child;
+        }
+      }
+    if (!IsLess(this->Heap[smallest], item))
+      {
+      break;
+      }
+    this->Heap[location] = this->Heap[smallest];
+    this->Location[GetItemId(this->Heap[location])] = location;
+    location = smallest;
+    }
+  this->Heap[location] = item;
+  this->Location[GetItemId(item)] = location;
+}
+
+//----------------------------------------------------------------------------
+void vtkIndexedPriorityQueue::RemoveTop()
+{
+  this->Location[GetItemId(this->Heap[0])] = -1;
+  if (--this->HeapSize > 0)
+    {
+    this->Heap[0] = this->Heap[this->HeapSize];
+    this->SiftDown(0);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Drop the deleted entries from the top of the heap.
+void vtkIndexedPriorityQueue::RemoveDeletedTop()
+{
+  while (this->HeapSize > 0 && this->Heap[0].Id < 0)
+    {
+    this->RemoveTop();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkIndexedPriorityQueue::Insert(double priority, vtkIdType id)
+{
+  this->ReserveIds(id + 1);
+  vtkIdType location = this->Location[id];
+  if (location >= 0)
+    {
+    Item& item = this->Heap[location];
+    if (item.Id >= 0)
+      {
+      return;
+      }
+    // Revive the deleted entry of id in place.
+    bool up = priority < item.Priority;
+    item.Priority = priority;
+    item.Id = id;
+    ++this->NumberOfItems;
+    if (up)
+      {
+      this->SiftUp(location);
+      }
+    else
+      {
+      this->SiftDown(location);
+      }
+    return;
+    }
+
+  if (this->HeapSize == this->HeapCapacity)
+    {
+    vtkIdType capacity = std::max(static_cast<vtkIdType>(1024),
+                                  2 * this->HeapCapacity);
+    Item *heap = new Item[capacity];
+    std::copy(this->Heap, this->Heap + this->HeapSize, heap);
+    delete [] this->Heap;
+    this->Heap = heap;
+    this->HeapCapacity = capacity;
+    }
+  this->Heap[this->HeapSize].Priority = priority;
+  this->Heap[this->HeapSize].Id = id;
+  ++this->NumberOfItems;
+  this->SiftUp(this->HeapSize++);
+}
+
+//----------------------------------------------------------------------------
+void vtkIndexedPriorityQueue::Update(double priority, vtkIdType id)
+{
+  if (id < this->NumberOfIds && this->Location[id] >= 0 &&
+      this->Heap[this->Location[id]].Id >= 0)
+    {
+    vtkIdType location = this->Location[id];
+    bool up = priority < this->Heap[location].Priority;
+    this->Heap[location].Priority = priority;
+    if (up)
+      {
+      this->SiftUp(location);
+      }
+    else
+      {
+      this->SiftDown(location);
+      }
+    }
+  else
+    {
+    this->Insert(priority, id);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkIndexedPriorityQueue::Pop(double &priority)
+{
+  this->RemoveDeletedTop();
+  if (this->HeapSize == 0)
+    {
+    return -1;
+    }
+  vtkIdType id = this->Heap[0].Id;
+  priority = this->Heap[0].Priority;
+  this->RemoveTop();
+  --this->NumberOfItems;
+  return id;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkIndexedPriorityQueue::Pop()
+{
+  double priority;
+  return this->Pop(priority);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkIndexedPriorityQueue::Peek(double &priority)
+{
+  this->RemoveDeletedTop();
+  if (this->HeapSize == 0)
+    {
+    return -1;
+    }
+  priority = this->Heap[0].Priority;
+  return this->Heap[0].Id;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkIndexedPriorityQueue::Peek()
+{
+  double priority;
+  return this->Peek(priority);
+}
+
+//----------------------------------------------------------------------------
+double vtkIndexedPriorityQueue::DeleteId(vtkIdType id)
+{
+  if (id < 0 || id >= this->NumberOfIds || this->Location[id] < 0)
+    {
+    return VTK_DOUBLE_MAX;
+    }
+  Item& item = this->Heap[this->Location[id]];
+  if (item.Id < 0)
+    {
+    return VTK_DOUBLE_MAX;
+    }
+  item.Id = -id - 1;
+  --this->NumberOfItems;
+  return item.Priority;
+}
+
+//----------------------------------------------------------------------------
+double vtkIndexedPriorityQueue::GetPriority(vtkIdType id)
+{
+  if (id < 0 || id >= this->NumberOfIds || this->Location[id] < 0 ||
+      this->Heap[this->Location[id]].Id < 0)
+    {
+    return VTK_DOUBLE_MAX;
+    }
+  return this->Heap[this->Location[id]].Priority;
+}
+
+//----------------------------------------------------------------------------
+void vtkIndexedPriorityQueue::Reset()
+{
+  for (vtkIdType i = 0; i < this->HeapSize; ++i)
+    {
+    this->Location[GetItemId(this->Heap[i])] = -1;
+    }
+  this->HeapSize = 0;
+  this->NumberOfItems = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkIndexedPriorityQueue::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number Of Items: " << this->NumberOfItems << "\n";
+  os << indent << "Heap Size: " << this->HeapSize << "\n";
+  os << indent << "Heap Capacity: " << this->HeapCapacity << "\n";
+  os << indent << "Number Of Ids: " << this->NumberOfIds << "\n";
+}
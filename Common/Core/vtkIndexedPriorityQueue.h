@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkIndexedPriorityQueue.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkIndexedPriorityQueue - a faster priority queue of ids
+// .SECTION Description
+// vtkIndexedPriorityQueue keeps a set of ids (e.g., point or edge ids)
+// ordered by priority, the smallest priority at the top, like
+// vtkPriorityQueue. It is meant for algorithms that repeatedly delete and
+// reinsert the same ids, such as the decimation filters:
+//
+// - The heap is 4-ary, which halves its depth and keeps the children of a
+//   node in the same cache line.
+// - The location of each id in the heap is kept in a plain array, so that
+//   GetPriority(), DeleteId() and Update() are direct lookups.
+// - DeleteId() only marks the entry of the id as deleted. The entry is
+//   revived in place if the id is inserted again, and dropped when it
+//   reaches the top of the heap.
+//
+// Ids of equal priority are popped in increasing order of id, so the order
+// only depends on the priorities, not on the history of the queue. Unlike
+// vtkPriorityQueue, only the top of the queue can be popped.
+// .SECTION See Also
+// vtkPriorityQueue
+
+#ifndef vtkIndexedPriorityQueue_h
+#define vtkIndexedPriorityQueue_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class VTKCOMMONCORE_EXPORT vtkIndexedPriorityQueue : public vtkObject
+{
+public:
+  static vtkIndexedPriorityQueue *New();
+  vtkTypeMacro(vtkIndexedPriorityQueue, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Empty the queue and allocate space for the ids in [0, numIds). Larger
+  // ids can still be inserted; the storage grows as needed.
+  void Allocate(vtkIdType numIds);
+
+  // Description:
+  // Insert id with the given priority. Nothing is done if id is already in
+  // the queue (use Update() to change its priority).
+  void Insert(double priority, vtkIdType id);
+
+  // Description:
+  // Set the priority of id, inserting it if it is not in the queue.
+  void Update(double priority, vtkIdType id);
+
+  //BTX
+  // Description:
+  // Remove the id of smallest priority from the queue and return it, with
+  // its priority. Return -1 if the queue is empty.
+  vtkIdType Pop(double &priority);
+
+  // Description:
+  // Return the id of smallest priority and its priority without removing
+  // it, or -1 if the queue is empty.
+  vtkIdType Peek(double &priority);
+  //ETX
+
+  // Description:
+  // Same as above but simplified for easier wrapping into interpreted
+  // languages.
+  vtkIdType Pop();
+  vtkIdType Peek();
+
+  // Description:
+  // Remove id from the queue. Return its priority, or VTK_DOUBLE_MAX if it
+  // was not in the queue.
+  double DeleteId(vtkIdType id);
+
+  // Description:
+  // Return the priority of id, or VTK_DOUBLE_MAX if it is not in the queue.
+  double GetPriority(vtkIdType id);
+
+  // Description:
+  // Return the number of ids in the queue.
+  vtkIdType GetNumberOfItems()
+    {return this->NumberOfItems;}
+
+  // Description:
+  // Empty the queue without releasing memory. This takes a time
+  // proportional to the number of entries of the heap, not to the number
+  // of ids.
+  void Reset();
+
+protected:
+  vtkIndexedPriorityQueue();
+  ~vtkIndexedPriorityQueue();
+
+  //BTX
+  // An entry of the heap. Deleted entries store -(id+1).
+  struct Item
+  {
+    double Priority;
+    vtkIdType Id;
+  };
+  //ETX
+
+  static vtkIdType GetItemId(const Item& item)
+    {return item.Id >= 0 ? item.Id : -item.Id - 1;}
+  static bool IsLess(const Item& a, const Item& b);
+
+  void SiftUp(vtkIdType location);
+  void SiftDown(vtkIdType location);
+  void RemoveTop();
+  void RemoveDeletedTop();
+  void ReserveIds(vtkIdType numIds);
+
+  Item *Heap;
+  vtkIdType HeapSize; // including the deleted entries
+  vtkIdType HeapCapacity;
+  vtkIdType *Location; // location of each id in Heap, or -1
+  vtkIdType NumberOfIds;
+  vtkIdType NumberOfItems;
+
+private:
+  vtkIndexedPriorityQueue(const vtkIndexedPriorityQueue&);  // Not implemented.
+  void operator=(const vtkIndexedPriorityQueue&);  // Not implemented.
+};
+
+#endif
@@ -25,7 +25,6 @@
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationIntegerPointerKey.h"
 #include "vtkInformationIntegerVectorKey.h"
-#include "vtkInformationIterator.h"
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationObjectBaseKey.h"
 #include "vtkInformationRequestKey.h"
@@ -35,7 +34,6 @@
 #include "vtkInformationVariantKey.h"
 #include "vtkInformationVariantVectorKey.h"
 #include "vtkObjectFactory.h"
-#include "vtkSmartPointer.h"
 #include "vtkVariant.h"
 
 #include <algorithm>
@@ -111,20 +109,10 @@ void vtkInformation::Modified(vtkInformationKey* key)
 }
 
 //----------------------------------------------------------------------------
-// Return the number of keys as a result of iteration.
+// Return the number of keys stored.
 int vtkInformation::GetNumberOfKeys()
 {
-  vtkSmartPointer<vtkInformationIterator> infoIterator =
-    vtkSmartPointer<vtkInformationIterator>::New();
-  infoIterator->SetInformation( this );
-
-  int numberOfKeys = 0;
-  for (infoIterator->InitTraversal(); !infoIterator->IsDoneWithTraversal();
-    infoIterator->GoToNextItem())
-    {
-    numberOfKeys++;
-    }
-  return numberOfKeys;
+  return static_cast<int>(this->Internal->Map.size());
 }
 
 //----------------------------------------------------------------------------
@@ -200,18 +188,20 @@ void vtkInformation::Clear()
 //----------------------------------------------------------------------------
 void vtkInformation::Copy(vtkInformation* from, int deep)
 {
-  vtkInformationInternals* oldInternal = this->Internal;
-  this->Internal = new vtkInformationInternals;
+  // Detach the current entries rather than reallocating the internal
+  // representation.  Their values are released once the copy is done.
+  typedef vtkInformationInternals::MapType MapType;
+  MapType oldMap;
+  this->Internal->Map.MoveTo(oldMap);
   if(from)
     {
-    typedef vtkInformationInternals::MapType MapType;
     for(MapType::const_iterator i = from->Internal->Map.begin();
         i != from->Internal->Map.end(); ++i)
       {
       this->CopyEntry(from, i->first, deep);
       }
     }
-  delete oldInternal;
+  vtkInformationInternals::ReleaseValues(oldMap);
 }
 
 //----------------------------------------------------------------------------
@@ -17,6 +17,12 @@
 // vtkInformationInternals is used in internal implementation of
 // vtkInformation. This should only be accessed by friends
 // and sub-classes of that class.
+//
+// The entries are kept in a flat array of (key, value) pairs searched by
+// key pointer identity. Information objects hold few keys, so a linear
+// scan over contiguous memory beats hashing, and the first
+// VTK_INFORMATION_INLINE_SIZE entries live inside the object itself so
+// that most information objects never allocate entry storage.
 
 #ifndef vtkInformationInternals_h
 #define vtkInformationInternals_h
@@ -24,12 +30,10 @@
 #include "vtkInformationKey.h"
 #include "vtkObjectBase.h"
 
-#define VTK_INFORMATION_USE_HASH_MAP
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-# include <vtksys/hash_map.hxx>
-#else
-# include <map>
-#endif
+#include <cstddef>
+#include <utility>
+
+#define VTK_INFORMATION_INLINE_SIZE 8
 
 //----------------------------------------------------------------------------
 class vtkInformationInternals
@@ -37,27 +41,132 @@ class vtkInformationInternals
 public:
   typedef vtkInformationKey* KeyType;
   typedef vtkObjectBase* DataType;
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  struct HashFun
+
+  // Small map-like table of entries. Iterators are invalidated by insert
+  // and erase.
+  class MapType
   {
-    size_t operator()(KeyType key) const
+  public:
+    typedef std::pair<KeyType, DataType> value_type;
+    typedef value_type* iterator;
+    typedef const value_type* const_iterator;
+
+    MapType(): Entries(this->InlineEntries), Size(0),
+               Capacity(VTK_INFORMATION_INLINE_SIZE) {}
+    ~MapType()
+      {
+      if(this->Entries != this->InlineEntries)
+        {
+        delete [] this->Entries;
+        }
+      }
+
+    iterator begin() { return this->Entries; }
+    iterator end() { return this->Entries + this->Size; }
+    const_iterator begin() const { return this->Entries; }
+    const_iterator end() const { return this->Entries + this->Size; }
+    size_t size() const { return this->Size; }
+    bool empty() const { return this->Size == 0; }
+
+    iterator find(KeyType key)
+      {
+      iterator i = this->Entries;
+      iterator last = i + this->Size;
+      while(i != last && i->first != key)
+        {
+        ++i;
+        }
+      return i;
+      }
+    const_iterator find(KeyType key) const
+      {
+      return const_cast<MapType*>(this)->find(key);
+      }
+
+    // The key must not be in the table yet.
+    void insert(const value_type& entry)
+      {
+      if(this->Size == this->Capacity)
+        {
+        this->Grow();
+        }
+      this->Entries[this->Size++] = entry;
+      }
+
+    // Keeps the remaining entries in insertion order.
+    void erase(iterator i)
+      {
+      iterator last = this->end();
+      for(++i; i != last; ++i)
+        {
+        *(i - 1) = *i;
+        }
+      --this->Size;
+      }
+
+    // Move all entries into the empty table "other", leaving this one
+    // empty. Heap storage changes hands without copying.
+    void MoveTo(MapType& other)
+      {
+      if(this->Entries != this->InlineEntries)
+        {
+        if(other.Entries != other.InlineEntries)
+          {
+          delete [] other.Entries;
+          }
+        other.Entries = this->Entries;
+        other.Capacity = this->Capacity;
+        this->Entries = this->InlineEntries;
+        this->Capacity = VTK_INFORMATION_INLINE_SIZE;
+        }
+      else
+        {
+        for(size_t i = 0; i < this->Size; ++i)
+          {
+          other.Entries[i] = this->Entries[i];
+          }
+        }
+      other.Size = this->Size;
+      this->Size = 0;
+      }
+
+  private:
+    void Grow()
       {
-      return static_cast<size_t>(key - KeyType(0));
+      size_t capacity = 2 * this->Capacity;
+      value_type* entries = new value_type[capacity];
+      for(size_t i = 0; i < this->Size; ++i)
+        {
+        entries[i] = this->Entries[i];
+        }
+      if(this->Entries != this->InlineEntries)
+        {
+        delete [] this->Entries;
+        }
+      this->Entries = entries;
+      this->Capacity = capacity;
       }
+
+    value_type* Entries;
+    size_t Size;
+    size_t Capacity;
+    value_type InlineEntries[VTK_INFORMATION_INLINE_SIZE];
+
+    MapType(const MapType&);  // Not implemented.
+    void operator=(const MapType&);  // Not implemented.
   };
-  typedef vtksys::hash_map<KeyType, DataType, HashFun> MapType;
-#else
-  typedef std::map<KeyType, DataType> MapType;
-#endif
-  MapType Map;
 
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  vtkInformationInternals(): Map(33) {}
-#endif
+  MapType Map;
 
   ~vtkInformationInternals()
     {
-    for(MapType::iterator i = this->Map.begin(); i != this->Map.end(); ++i)
+    ReleaseValues(this->Map);
+    }
+
+  // Unregister all values held by a table.
+  static void ReleaseValues(MapType& map)
+    {
+    for(MapType::iterator i = map.begin(); i != map.end(); ++i)
       {
       if(vtkObjectBase* value = i->second)
         {
@@ -67,7 +176,5 @@ public:
     }
 };
 
-#undef VTK_INFORMATION_USE_HASH_MAP
-
 #endif
 // VTK-HeaderTest-Exclude: vtkInformationInternals.h
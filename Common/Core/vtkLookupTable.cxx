@@ -19,10 +19,13 @@
 #include "vtkMath.h"
 #include "vtkMathConfigure.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
+#include "vtkTypeTraits.h"
 #include "vtkVariantArray.h"
 
 #include <cassert>
+#include <vector>
 
 const vtkIdType vtkLookupTable::BELOW_RANGE_COLOR_INDEX  = 0;
 const vtkIdType vtkLookupTable::ABOVE_RANGE_COLOR_INDEX  = 1;
@@ -960,6 +963,113 @@ void vtkLookupTableMapData(vtkLookupTable *self,
 }
 
 
+//----------------------------------------------------------------------------
+// Number of values below which mapping is not split between threads.
+const vtkIdType vtkLookupTableMapGrain = 16384;
+
+//----------------------------------------------------------------------------
+// Map a range of values on each thread.  Each range computes its own copy
+// of the table parameters.
+template<class T>
+struct vtkLookupTableMapFunctor
+{
+  vtkLookupTable *Self;
+  T *Input;
+  unsigned char *Output;
+  int InIncr;
+  int OutFormat;
+  TableParameters Parameters;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    TableParameters p = this->Parameters;
+    vtkLookupTableMapData(this->Self, this->Input + begin*this->InIncr,
+                          this->Output + begin*this->OutFormat,
+                          static_cast<int>(end - begin), this->InIncr,
+                          this->OutFormat, p);
+    }
+};
+
+//----------------------------------------------------------------------------
+// Copy precomputed colors for 8 and 16 bit integer values.
+template<class T>
+struct vtkLookupTableCopyFunctor
+{
+  const T *Input;
+  unsigned char *Output;
+  int InIncr;
+  int OutFormat;
+  const unsigned char *Colors;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    const int minValue = static_cast<int>(vtkTypeTraits<T>::Min());
+    const T *input = this->Input + begin*this->InIncr;
+    unsigned char *output = this->Output + begin*this->OutFormat;
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const unsigned char *color = this->Colors +
+        (static_cast<int>(*input) - minValue)*this->OutFormat;
+      for (int c = 0; c < this->OutFormat; ++c)
+        {
+        output[c] = color[c];
+        }
+      input += this->InIncr;
+      output += this->OutFormat;
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// The number of distinct values of the types whose colors are precomputed,
+// zero for the other types.
+template<class T> struct vtkLookupTableValueCount
+{ static vtkIdType Get() { return 0; } };
+template<> struct vtkLookupTableValueCount<char>
+{ static vtkIdType Get() { return 256; } };
+template<> struct vtkLookupTableValueCount<signed char>
+{ static vtkIdType Get() { return 256; } };
+template<> struct vtkLookupTableValueCount<unsigned char>
+{ static vtkIdType Get() { return 256; } };
+template<> struct vtkLookupTableValueCount<short>
+{ static vtkIdType Get() { return 65536; } };
+template<> struct vtkLookupTableValueCount<unsigned short>
+{ static vtkIdType Get() { return 65536; } };
+
+//----------------------------------------------------------------------------
+// Map the values with vtkSMPTools.  When there are many more values than
+// the type can represent, the color of every representable value is
+// computed once and the values are mapped by copying those colors.
+template<class T>
+void vtkLookupTableMapDataParallel(vtkLookupTable *self,
+                                   T *input, unsigned char *output,
+                                   int length, int inIncr, int outFormat,
+                                   TableParameters & p)
+{
+  const vtkIdType numberOfValues = vtkLookupTableValueCount<T>::Get();
+  if (numberOfValues > 0 && length > 4*numberOfValues)
+    {
+    std::vector<T> values(numberOfValues);
+    for (vtkIdType k = 0; k < numberOfValues; ++k)
+      {
+      values[k] = static_cast<T>(vtkTypeTraits<T>::Min() + k);
+      }
+    std::vector<unsigned char> colors(numberOfValues*outFormat);
+    vtkLookupTableMapFunctor<T> mapper =
+      { self, &values[0], &colors[0], 1, outFormat, p };
+    vtkSMPTools::For(0, numberOfValues, vtkLookupTableMapGrain, mapper);
+
+    vtkLookupTableCopyFunctor<T> copier =
+      { input, output, inIncr, outFormat, &colors[0] };
+    vtkSMPTools::For(0, length, vtkLookupTableMapGrain, copier);
+    return;
+    }
+
+  vtkLookupTableMapFunctor<T> mapper =
+    { self, input, output, inIncr, outFormat, p };
+  vtkSMPTools::For(0, length, vtkLookupTableMapGrain, mapper);
+}
+
 //----------------------------------------------------------------------------
 template<class T>
 void vtkLookupTableIndexedMapData(
@@ -1162,17 +1272,19 @@ void vtkLookupTable::MapScalarsThroughTable2(void *input,
           {
           newInput->SetValue(i, bitArray->GetValue(id));
           }
-        vtkLookupTableMapData(this, static_cast<unsigned char*>(newInput->GetPointer(0)),
-                              output, numberOfValues,
-                              inputIncrement, outputFormat, p);
+        vtkLookupTableMapDataParallel(this,
+                                      static_cast<unsigned char*>(newInput->GetPointer(0)),
+                                      output, numberOfValues,
+                                      1, outputFormat, p);
         newInput->Delete();
         bitArray->Delete();
         }
         break;
 
       vtkTemplateMacro(
-        vtkLookupTableMapData(this, static_cast<VTK_TT*>(input),output,
-                              numberOfValues, inputIncrement, outputFormat, p)
+        vtkLookupTableMapDataParallel(this, static_cast<VTK_TT*>(input),output,
+                                      numberOfValues, inputIncrement,
+                                      outputFormat, p)
         );
       default:
         vtkErrorMacro(<< "MapScalarsThroughTable2: Unknown input ScalarType");
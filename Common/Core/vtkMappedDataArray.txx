@@ -135,6 +135,7 @@ vtkMappedDataArray<Scalar>::FastDownCast(vtkAbstractArray *source)
   switch (source->GetArrayType())
     {
     case vtkAbstractArray::MappedDataArray:
+    case vtkAbstractArray::SOADataArrayTemplate:
       if (source->GetDataType() == vtkTypeTraits<Scalar>::VTK_TYPE_ID)
         {
         return static_cast<vtkMappedDataArray<Scalar>*>(source);
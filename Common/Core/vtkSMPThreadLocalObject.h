@@ -110,19 +110,16 @@ public:
   // be deleted in the destructor of vtkSMPThreadLocalObject.
   T*& Local()
   {
-    T*& vtkobject = this->Internal.Local();
-    if (!vtkobject)
-      {
-      if (this->Exemplar)
-        {
-        vtkobject = this->Exemplar->NewInstance();
-        }
-      else
-        {
-        vtkobject = T::SafeDownCast(T::New());
-        }
-      }
-    return vtkobject;
+    return this->CreateObject(this->Internal.Local());
+  }
+
+  // Description:
+  // Same as Local() for the thread with the given index, as returned by
+  // vtkSMPTools::GetThreadIndex(). It must be the index of the calling
+  // thread.
+  T*& Local(int threadIndex)
+  {
+    return this->CreateObject(this->Internal.Local(threadIndex));
   }
 
   // Description:
@@ -196,6 +193,22 @@ public:
 private:
   TLS Internal;
   T* Exemplar;
+
+  T*& CreateObject(T*& vtkobject)
+  {
+    if (!vtkobject)
+      {
+      if (this->Exemplar)
+        {
+        vtkobject = this->Exemplar->NewInstance();
+        }
+      else
+        {
+        vtkobject = T::SafeDownCast(T::New());
+        }
+      }
+    return vtkobject;
+  }
 };
 
 #endif
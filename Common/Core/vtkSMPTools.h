@@ -27,8 +27,12 @@
 #include "vtkObject.h"
 
 #include "vtkSMPThreadLocal.h" // For Initialized
+#include "vtkSMPToolsScopeInternal.h" // For Scope
 #include "vtkSMPToolsInternal.h"
 
+#include <functional> // For std::plus
+#include <iterator> // For std::iterator_traits
+
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 #ifndef __WRAP__
@@ -76,7 +80,7 @@ struct vtkSMPTools_FunctorInternal<Functor, false>
   }
   void For(vtkIdType first, vtkIdType last, vtkIdType grain)
   {
-    vtk::detail::smp::vtkSMPTools_Impl_For(first, last, grain, *this);
+    vtk::detail::smp::vtkSMPTools_Impl_ScopedFor(first, last, grain, *this);
   }
   vtkSMPTools_FunctorInternal<Functor, false>& operator=(
     const vtkSMPTools_FunctorInternal<Functor, false>&);
@@ -102,7 +106,7 @@ struct vtkSMPTools_FunctorInternal<Functor, true>
   }
   void For(vtkIdType first, vtkIdType last, vtkIdType grain)
   {
-    vtk::detail::smp::vtkSMPTools_Impl_For(first, last, grain, *this);
+    vtk::detail::smp::vtkSMPTools_Impl_ScopedFor(first, last, grain, *this);
     this->F.Reduce();
   }
   vtkSMPTools_FunctorInternal<Functor, true>& operator=(
@@ -212,6 +216,67 @@ public:
   // available threads.
   static int GetEstimatedNumberOfThreads();
 
+//BTX
+  // Description:
+  // Scope controls the execution of the vtkSMPTools algorithms started by
+  // the calling thread during its lifetime, including the algorithms
+  // started from the functors they execute on other threads. It sets the
+  // number of threads to use (numberOfThreads <= 0 keeps the current
+  // value) and whether an algorithm started from within another one runs
+  // in parallel; when nestedParallelism is false, nested algorithms run
+  // serially on the thread that starts them. Scopes can be nested and each
+  // thread has its own, so concurrent pipelines can use separate thread
+  // budgets:
+  // \code
+  // vtkSMPTools::Scope scope(4, false);
+  // vtkSMPTools::For(0, n, functor); // Uses at most 4 threads.
+  // \endcode
+  // TBB executes the algorithms in a task_arena of the requested size.
+  // OpenMP uses a num_threads clause; allowing nesting also raises the
+  // process-wide maximum number of active levels while the scope exists.
+  // The Simple back-end uses at most the number of threads given to
+  // Initialize() and never nests. X-Kaapi only honors the nesting policy.
+  class VTKCOMMONCORE_EXPORT Scope
+  {
+  public:
+    Scope(int numberOfThreads, bool nestedParallelism = true);
+    ~Scope();
+  private:
+    vtk::detail::smp::vtkSMPToolsScopeState Previous;
+    void *BackendData;
+
+    Scope(const Scope&); // not implemented
+    void operator=(const Scope&); // not implemented
+  };
+//ETX
+
+  // Description:
+  // Return the number of threads requested by the innermost Scope of the
+  // calling thread, or 0 when no Scope sets it. Inside a functor, this is
+  // the value of the thread that started the algorithm.
+  static int GetScopeNumberOfThreads();
+
+  // Description:
+  // Return whether algorithms started by the calling thread from within
+  // another algorithm run in parallel. The default is true.
+  static bool GetNestedParallelism();
+
+  // Description:
+  // Return true when called from a functor executed by a vtkSMPTools
+  // algorithm.
+  static bool IsParallelScope();
+
+  // Description:
+  // Return a small non-negative index identifying the calling thread. It
+  // stays the same as long as the thread executes functors of the same
+  // algorithm (for the Simple and Sequential back-ends, it is the position
+  // of the thread in the team, lower than GetEstimatedNumberOfThreads();
+  // the other back-ends number threads in the order they first ask,
+  // for their whole lifetime). Pass it to vtkSMPThreadLocal::Local(int) to
+  // skip the lookup of the calling thread in kernels that access thread
+  // local storage often.
+  static int GetThreadIndex();
+
   // Description:
   // A convenience method for sorting data. It is a drop in replacement for
   // std::sort(). Under the hood different methods are used. For example,
@@ -234,6 +299,130 @@ public:
     vtk::detail::smp::vtkSMPTools_Impl_Sort(begin,end,comp);
   }
 
+  // Description:
+  // Parallel, stable radix sort of [begin, end) in ascending order. The
+  // elements must be of an integral type, float or double (NaNs are placed
+  // before or after all the numbers depending on their sign bit). Radix
+  // sort reads the data a couple of times per significant byte of the keys,
+  // so it is much faster than Sort() for large arrays of ids, bucket
+  // indices or Morton codes, but it needs a temporary copy of the data.
+  template<typename T>
+    static void RadixSort(T* begin, T* end)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_RadixSort(begin, end,
+      static_cast<vtk::detail::smp::vtkSMPTools_RadixNoValue*>(0),
+      vtk::detail::smp::vtkSMPTools_RadixIdentity<T>());
+  }
+
+  // Description:
+  // Key/value version of RadixSort(): sort the keys [keysBegin, keysEnd) and
+  // apply the same permutation to the values, an array of the same length.
+  template<typename K, typename V>
+    static void RadixSort(K* keysBegin, K* keysEnd, V* values)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_RadixSort(keysBegin, keysEnd, values,
+      vtk::detail::smp::vtkSMPTools_RadixIdentity<K>());
+  }
+
+  // Description:
+  // RadixSort() for arrays of structures, using the given data member as the
+  // key, e.g. vtkSMPTools::RadixSort(tuples, tuples + n, &Tuple::Bucket).
+  template<typename T, typename K>
+    static void RadixSort(T* begin, T* end, K T::*key)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_RadixSort(begin, end,
+      static_cast<vtk::detail::smp::vtkSMPTools_RadixNoValue*>(0),
+      vtk::detail::smp::vtkSMPTools_RadixMember<T, K>(key));
+  }
+
+  // Description:
+  // A parallel drop in replacement for std::transform(). Apply op to each
+  // element of [begin, end) and store the result in the range starting at
+  // out. Iterators must be random access, and op must be safe to call
+  // concurrently.
+  template<typename InputIt, typename OutputIt, typename UnaryOp>
+    static void Transform(InputIt begin, InputIt end, OutputIt out,
+      UnaryOp op)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_Transform(begin, end, out, op);
+  }
+
+  // Description:
+  // Binary version of Transform(): apply op to the pairs of elements of
+  // [begin1, end1) and of the range starting at begin2.
+  template<typename InputIt1, typename InputIt2, typename OutputIt,
+           typename BinaryOp>
+    static void Transform(InputIt1 begin1, InputIt1 end1, InputIt2 begin2,
+      OutputIt out, BinaryOp op)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_Transform(begin1, end1, begin2, out,
+                                                 op);
+  }
+
+  // Description:
+  // A parallel drop in replacement for std::fill().
+  template<typename Iterator, typename T>
+    static void Fill(Iterator begin, Iterator end, const T& value)
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_Fill(begin, end, value);
+  }
+
+  // Description:
+  // Combine init and all the elements of [begin, end) with op, which must
+  // be associative. The elements are combined in order, so op does not
+  // need to be commutative. The first version uses operator+.
+  template<typename InputIt, typename T>
+    static T Reduce(InputIt begin, InputIt end, T init)
+  {
+    return vtk::detail::smp::vtkSMPTools_Impl_Reduce(begin, end, init,
+                                                      std::plus<T>());
+  }
+  template<typename InputIt, typename T, typename BinaryOp>
+    static T Reduce(InputIt begin, InputIt end, T init, BinaryOp op)
+  {
+    return vtk::detail::smp::vtkSMPTools_Impl_Reduce(begin, end, init, op);
+  }
+
+  // Description:
+  // Inclusive prefix scan: out[i] = in[0] op in[1] op ... op in[i]. The op
+  // must be associative; operator+ is used by default. The input and output
+  // ranges may be the same.
+  template<typename InputIt, typename OutputIt>
+    static void InclusiveScan(InputIt begin, InputIt end, OutputIt out)
+  {
+    typedef typename std::iterator_traits<InputIt>::value_type ValueType;
+    vtkSMPTools::InclusiveScan(begin, end, out, std::plus<ValueType>());
+  }
+  template<typename InputIt, typename OutputIt, typename BinaryOp>
+    static void InclusiveScan(InputIt begin, InputIt end, OutputIt out,
+      BinaryOp op)
+  {
+    typedef typename std::iterator_traits<InputIt>::value_type ValueType;
+    vtk::detail::smp::vtkSMPTools_Impl_Scan(begin, end, out, op,
+      static_cast<const ValueType*>(0), false);
+  }
+
+  // Description:
+  // Exclusive prefix scan: out[0] = init and
+  // out[i] = init op in[0] op ... op in[i-1]. Return the combination of init
+  // and all the elements, which is the size of the data to allocate in the
+  // usual "count, scan, then fill" parallel algorithms. The op must be
+  // associative; operator+ is used by default. The input and output ranges
+  // may be the same.
+  template<typename InputIt, typename OutputIt, typename T>
+    static T ExclusiveScan(InputIt begin, InputIt end, OutputIt out, T init)
+  {
+    return vtk::detail::smp::vtkSMPTools_Impl_Scan(begin, end, out,
+      std::plus<T>(), &init, true);
+  }
+  template<typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+    static T ExclusiveScan(InputIt begin, InputIt end, OutputIt out, T init,
+      BinaryOp op)
+  {
+    return vtk::detail::smp::vtkSMPTools_Impl_Scan(begin, end, out, op,
+                                                   &init, true);
+  }
+
 };
 
 #endif
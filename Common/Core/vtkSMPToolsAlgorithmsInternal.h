@@ -0,0 +1,473 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsAlgorithmsInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Building blocks shared by the SMP back-ends to implement the
+// vtkSMPTools Transform, Fill, Reduce, Scan and RadixSort algorithms. This header is
+// included by vtkSMPToolsInternal.h once vtkSMPTools_Impl_For is defined;
+// it should not be included directly.
+//
+// Reduce and Scan split the input in contiguous blocks. A partial pass
+// folds each block independently, a serial step combines the partial
+// results and, for scans, a final pass rewrites each block starting from
+// its offset. The blocks are combined in order, so the operation only needs
+// to be associative. Back-ends either map the blocks onto their threads
+// (OpenMP) or run the passes with vtkSMPTools_Impl_For (the Emulated
+// functions).
+
+#ifndef vtkSMPToolsAlgorithmsInternal_h
+#define vtkSMPToolsAlgorithmsInternal_h
+
+#include <algorithm> // For std::fill
+#include <vector> // For the block partial results
+
+#ifndef __WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+// Blocks processed by ExecuteBlocks() hold at least this many elements.
+const vtkIdType vtkSMPTools_MinimumBlockSize = 1024;
+// Maximum number of blocks used by ExecuteBlocks().
+const vtkIdType vtkSMPTools_MaximumNumberOfBlocks = 256;
+
+enum vtkSMPTools_BlockStage
+{
+  vtkSMPTools_PrepareBlocks,
+  vtkSMPTools_PartialBlock,
+  vtkSMPTools_CombineBlocks,
+  vtkSMPTools_FinalBlock
+};
+
+//--------------------------------------------------------------------------------
+// Execute fi over [first, last) with vtkSMPTools_Impl_For, or on the
+// calling thread when its vtkSMPTools::Scope requires a serial execution.
+template <typename FunctorInternal>
+void vtkSMPTools_Impl_ScopedFor(vtkIdType first, vtkIdType last,
+                                vtkIdType grain, FunctorInternal& fi)
+{
+  if (last <= first)
+    {
+    return;
+    }
+  if (vtkSMPToolsIsSerialScope())
+    {
+    vtkSMPToolsWorkerScope worker(vtkSMPToolsGetScopeState());
+    fi.Execute(first, last);
+    }
+  else
+    {
+    vtkSMPTools_Impl_For(first, last, grain, fi);
+    }
+}
+
+//--------------------------------------------------------------------------------
+template <typename InputIt, typename OutputIt, typename UnaryOp>
+struct vtkSMPTools_UnaryTransform
+{
+  InputIt In;
+  OutputIt Out;
+  UnaryOp Op;
+  vtkSMPTools_UnaryTransform(InputIt in, OutputIt out, UnaryOp op)
+    : In(in), Out(out), Op(op) {}
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    InputIt in = this->In + first;
+    OutputIt out = this->Out + first;
+    for (vtkIdType i = first; i < last; ++i, ++in, ++out)
+      {
+      *out = this->Op(*in);
+      }
+  }
+};
+
+//--------------------------------------------------------------------------------
+template <typename InputIt1, typename InputIt2, typename OutputIt,
+          typename BinaryOp>
+struct vtkSMPTools_BinaryTransform
+{
+  InputIt1 In1;
+  InputIt2 In2;
+  OutputIt Out;
+  BinaryOp Op;
+  vtkSMPTools_BinaryTransform(InputIt1 in1, InputIt2 in2, OutputIt out,
+                              BinaryOp op)
+    : In1(in1), In2(in2), Out(out), Op(op) {}
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    InputIt1 in1 = this->In1 + first;
+    InputIt2 in2 = this->In2 + first;
+    OutputIt out = this->Out + first;
+    for (vtkIdType i = first; i < last; ++i, ++in1, ++in2, ++out)
+      {
+      *out = this->Op(*in1, *in2);
+      }
+  }
+};
+
+//--------------------------------------------------------------------------------
+template <typename Iterator, typename T>
+struct vtkSMPTools_Fill
+{
+  Iterator Begin;
+  const T& Value;
+  vtkSMPTools_Fill(Iterator begin, const T& value)
+    : Begin(begin), Value(value) {}
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    std::fill(this->Begin + first, this->Begin + last, this->Value);
+  }
+private:
+  void operator=(const vtkSMPTools_Fill&); // not implemented
+};
+
+//--------------------------------------------------------------------------------
+// Fold the values of each block, then combine the partial results in
+// order, starting from the initial value.
+template <typename InputIt, typename T, typename BinaryOp>
+class vtkSMPTools_BlockReduce
+{
+public:
+  vtkSMPTools_BlockReduce(InputIt begin, vtkIdType size, const T& init,
+                          BinaryOp op)
+    : Begin(begin), Size(size), Result(init), Op(op) {}
+
+  void SetNumberOfBlocks(vtkIdType numBlocks)
+  {
+    this->NumberOfBlocks = numBlocks;
+    this->Partials.resize(static_cast<size_t>(numBlocks));
+    this->Valid.assign(static_cast<size_t>(numBlocks), 0);
+  }
+
+  void PartialBlock(vtkIdType block)
+  {
+    vtkIdType first = this->Size * block / this->NumberOfBlocks;
+    vtkIdType last = this->Size * (block + 1) / this->NumberOfBlocks;
+    if (first >= last)
+      {
+      return;
+      }
+    InputIt in = this->Begin + first;
+    T value = *in;
+    for (++in, ++first; first < last; ++first, ++in)
+      {
+      value = this->Op(value, *in);
+      }
+    this->Partials[block] = value;
+    this->Valid[block] = 1;
+  }
+
+  void CombineBlocks()
+  {
+    for (vtkIdType block = 0; block < this->NumberOfBlocks; ++block)
+      {
+      if (this->Valid[block])
+        {
+        this->Result = this->Op(this->Result, this->Partials[block]);
+        }
+      }
+  }
+
+  void FinalBlock(vtkIdType) {}
+
+  static bool HasFinalPass() { return false; }
+  vtkIdType GetSize() const { return this->Size; }
+  const T& GetResult() const { return this->Result; }
+
+private:
+  InputIt Begin;
+  vtkIdType Size;
+  vtkIdType NumberOfBlocks;
+  T Result;
+  BinaryOp Op;
+  std::vector<T> Partials;
+  std::vector<char> Valid;
+};
+
+//--------------------------------------------------------------------------------
+// Inclusive or exclusive scan. Each block is first reduced, the block
+// offsets are computed serially, then each block is scanned from its
+// offset. Input and output may be the same range.
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+class vtkSMPTools_BlockScan
+{
+public:
+  vtkSMPTools_BlockScan(InputIt begin, vtkIdType size, OutputIt out,
+                        BinaryOp op, const T* init, bool exclusive)
+    : Begin(begin), Size(size), Out(out), Op(op), HasInit(init != 0),
+      Exclusive(exclusive), HasTotal(false)
+  {
+    if (init)
+      {
+      this->Init = *init;
+      this->Total = *init;
+      this->HasTotal = true;
+      }
+  }
+
+  void SetNumberOfBlocks(vtkIdType numBlocks)
+  {
+    this->NumberOfBlocks = numBlocks;
+    this->Partials.resize(static_cast<size_t>(numBlocks));
+    this->Offsets.resize(static_cast<size_t>(numBlocks));
+    this->Valid.assign(static_cast<size_t>(numBlocks), 0);
+    this->HasOffset.assign(static_cast<size_t>(numBlocks), 0);
+    if (this->HasInit && numBlocks > 0)
+      {
+      // Used when the partial pass is skipped for a single block.
+      this->Offsets[0] = this->Init;
+      this->HasOffset[0] = 1;
+      }
+  }
+
+  void PartialBlock(vtkIdType block)
+  {
+    vtkIdType first = this->Size * block / this->NumberOfBlocks;
+    vtkIdType last = this->Size * (block + 1) / this->NumberOfBlocks;
+    if (first >= last)
+      {
+      return;
+      }
+    InputIt in = this->Begin + first;
+    T value = *in;
+    for (++in, ++first; first < last; ++first, ++in)
+      {
+      value = this->Op(value, *in);
+      }
+    this->Partials[block] = value;
+    this->Valid[block] = 1;
+  }
+
+  void CombineBlocks()
+  {
+    bool hasValue = this->HasInit;
+    T value = this->HasInit ? this->Init : T();
+    for (vtkIdType block = 0; block < this->NumberOfBlocks; ++block)
+      {
+      this->HasOffset[block] = hasValue;
+      if (hasValue)
+        {
+        this->Offsets[block] = value;
+        }
+      if (this->Valid[block])
+        {
+        value = hasValue ? this->Op(value, this->Partials[block]) :
+          this->Partials[block];
+        hasValue = true;
+        }
+      }
+    this->Total = value;
+    this->HasTotal = hasValue;
+  }
+
+  void FinalBlock(vtkIdType block)
+  {
+    vtkIdType first = this->Size * block / this->NumberOfBlocks;
+    vtkIdType last = this->Size * (block + 1) / this->NumberOfBlocks;
+    if (first >= last)
+      {
+      return;
+      }
+    InputIt in = this->Begin + first;
+    OutputIt out = this->Out + first;
+    bool hasValue = this->HasOffset[block] != 0;
+    T value = hasValue ? this->Offsets[block] : T();
+    for (; first < last; ++first, ++in, ++out)
+      {
+      // Read before writing to support in-place scans.
+      T current = *in;
+      if (this->Exclusive)
+        {
+        *out = value;
+        }
+      value = hasValue ? this->Op(value, current) : current;
+      hasValue = true;
+      if (!this->Exclusive)
+        {
+        *out = value;
+        }
+      }
+    if (this->NumberOfBlocks == 1)
+      {
+      this->Total = value;
+      this->HasTotal = true;
+      }
+  }
+
+  static bool HasFinalPass() { return true; }
+  vtkIdType GetSize() const { return this->Size; }
+  T GetResult() const { return this->HasTotal ? this->Total : T(); }
+
+private:
+  InputIt Begin;
+  vtkIdType Size;
+  OutputIt Out;
+  BinaryOp Op;
+  T Init;
+  bool HasInit;
+  bool Exclusive;
+  vtkIdType NumberOfBlocks;
+  T Total;
+  bool HasTotal;
+  std::vector<T> Partials;
+  std::vector<T> Offsets;
+  std::vector<char> Valid;
+  std::vector<char> HasOffset;
+};
+
+//--------------------------------------------------------------------------------
+// Dispatch a stage of a block algorithm; used by back-ends that only deal
+// with untyped functors.
+template <typename Algorithm>
+void vtkSMPTools_ExecuteBlockStage(void *algorithm, int stage,
+                                   vtkIdType block, vtkIdType numBlocks)
+{
+  Algorithm &a = *reinterpret_cast<Algorithm*>(algorithm);
+  switch (stage)
+    {
+    case vtkSMPTools_PrepareBlocks:
+      a.SetNumberOfBlocks(numBlocks);
+      break;
+    case vtkSMPTools_PartialBlock:
+      a.PartialBlock(block);
+      break;
+    case vtkSMPTools_CombineBlocks:
+      a.CombineBlocks();
+      break;
+    case vtkSMPTools_FinalBlock:
+      a.FinalBlock(block);
+      break;
+    }
+}
+
+//--------------------------------------------------------------------------------
+template <typename Algorithm, int Stage>
+struct vtkSMPTools_BlockPass
+{
+  Algorithm& A;
+  vtkSMPTools_BlockPass(Algorithm& a) : A(a) {}
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    for (vtkIdType block = first; block < last; ++block)
+      {
+      vtkSMPTools_ExecuteBlockStage<Algorithm>(&this->A, Stage, block, 0);
+      }
+  }
+private:
+  void operator=(const vtkSMPTools_BlockPass&); // not implemented
+};
+
+//--------------------------------------------------------------------------------
+// Run a block algorithm with vtkSMPTools_Impl_ScopedFor. Small inputs are
+// processed as a single block, which skips the partial pass of scans.
+template <typename Algorithm>
+void vtkSMPTools_ExecuteBlocks(Algorithm& algorithm, vtkIdType maxBlocks)
+{
+  if (vtkSMPToolsIsSerialScope())
+    {
+    maxBlocks = 1;
+    }
+  vtkIdType numBlocks = algorithm.GetSize() / vtkSMPTools_MinimumBlockSize;
+  numBlocks = numBlocks < maxBlocks ? numBlocks : maxBlocks;
+  numBlocks = numBlocks > 0 ? numBlocks : 1;
+  algorithm.SetNumberOfBlocks(numBlocks);
+
+  if (numBlocks == 1)
+    {
+    if (Algorithm::HasFinalPass())
+      {
+      algorithm.FinalBlock(0);
+      }
+    else
+      {
+      algorithm.PartialBlock(0);
+      algorithm.CombineBlocks();
+      }
+    return;
+    }
+
+  vtkSMPTools_BlockPass<Algorithm, vtkSMPTools_PartialBlock> partial(algorithm);
+  vtkSMPTools_Impl_ScopedFor(0, numBlocks, 1, partial);
+  algorithm.CombineBlocks();
+  if (Algorithm::HasFinalPass())
+    {
+    vtkSMPTools_BlockPass<Algorithm, vtkSMPTools_FinalBlock>
+      finalPass(algorithm);
+    vtkSMPTools_Impl_ScopedFor(0, numBlocks, 1, finalPass);
+    }
+}
+
+//--------------------------------------------------------------------------------
+template <typename InputIt, typename OutputIt, typename UnaryOp>
+void vtkSMPTools_Impl_Transform(InputIt begin, InputIt end, OutputIt out,
+                                UnaryOp op)
+{
+  vtkSMPTools_UnaryTransform<InputIt, OutputIt, UnaryOp> fi(begin, out, op);
+  vtkSMPTools_Impl_ScopedFor(0, static_cast<vtkIdType>(end - begin), 0, fi);
+}
+
+//--------------------------------------------------------------------------------
+template <typename InputIt1, typename InputIt2, typename OutputIt,
+          typename BinaryOp>
+void vtkSMPTools_Impl_Transform(InputIt1 begin1, InputIt1 end1,
+                                InputIt2 begin2, OutputIt out, BinaryOp op)
+{
+  vtkSMPTools_BinaryTransform<InputIt1, InputIt2, OutputIt, BinaryOp>
+    fi(begin1, begin2, out, op);
+  vtkSMPTools_Impl_ScopedFor(0, static_cast<vtkIdType>(end1 - begin1), 0, fi);
+}
+
+//--------------------------------------------------------------------------------
+template <typename Iterator, typename T>
+void vtkSMPTools_Impl_Fill(Iterator begin, Iterator end, const T& value)
+{
+  vtkSMPTools_Fill<Iterator, T> fi(begin, value);
+  vtkSMPTools_Impl_ScopedFor(0, static_cast<vtkIdType>(end - begin), 0, fi);
+}
+
+//--------------------------------------------------------------------------------
+// Reduce and Scan for back-ends without native support.
+template <typename InputIt, typename T, typename BinaryOp>
+T vtkSMPTools_Emulated_Reduce(InputIt begin, InputIt end, const T& init,
+                              BinaryOp op, vtkIdType maxBlocks)
+{
+  vtkSMPTools_BlockReduce<InputIt, T, BinaryOp>
+    reduce(begin, static_cast<vtkIdType>(end - begin), init, op);
+  vtkSMPTools_ExecuteBlocks(reduce, maxBlocks);
+  return reduce.GetResult();
+}
+
+//--------------------------------------------------------------------------------
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T vtkSMPTools_Emulated_Scan(InputIt begin, InputIt end, OutputIt out,
+                            BinaryOp op, const T* init, bool exclusive,
+                            vtkIdType maxBlocks)
+{
+  vtkSMPTools_BlockScan<InputIt, OutputIt, T, BinaryOp>
+    scan(begin, static_cast<vtkIdType>(end - begin), out, op, init, exclusive);
+  vtkSMPTools_ExecuteBlocks(scan, maxBlocks);
+  return scan.GetResult();
+}
+
+}//namespace smp
+}//namespace detail
+}//namespace vtk
+#endif // __WRAP__
+
+#include "vtkSMPToolsRadixSortInternal.h"
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsAlgorithmsInternal.h
@@ -0,0 +1,61 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsPaddingInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Padding used by the vtkSMPThreadLocal implementations to keep the objects
+// of different threads on different cache lines. This header is included by
+// the SMP back-ends and should not be included directly.
+
+#ifndef vtkSMPToolsPaddingInternal_h
+#define vtkSMPToolsPaddingInternal_h
+
+#include "vtkSystemIncludes.h"
+
+#define VTK_SMP_CACHE_LINE_SIZE 64
+
+#ifndef __WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+// A value surrounded by a cache line of padding on each side. Whether the
+// padded values are stored contiguously or allocated separately on the
+// heap, no other data shares a cache line with the value, so that threads
+// updating their own small objects (counters, bounds...) do not invalidate
+// each other's caches.
+template <typename T>
+struct vtkSMPToolsPaddedValue
+{
+  char Before[VTK_SMP_CACHE_LINE_SIZE];
+  T Value;
+  char After[VTK_SMP_CACHE_LINE_SIZE];
+
+  vtkSMPToolsPaddedValue() : Value()
+  {
+  }
+
+  explicit vtkSMPToolsPaddedValue(const T& value) : Value(value)
+  {
+  }
+};
+
+}//namespace smp
+}//namespace detail
+}//namespace vtk
+#endif // __WRAP__
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsPaddingInternal.h
@@ -0,0 +1,440 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsRadixSortInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Parallel least significant digit radix sort used by
+// vtkSMPTools::RadixSort(). This header is included by
+// vtkSMPToolsAlgorithmsInternal.h; it should not be included directly.
+//
+// Keys are mapped to unsigned integers that sort in the same order (the
+// sign bit of signed integers is flipped, negative floating point numbers
+// have all their bits flipped) and sorted one byte at a time. The input is
+// split in contiguous blocks. For each byte, the blocks are histogrammed in
+// parallel, the histograms are scanned serially to give each block its
+// output positions, then the blocks are scattered in parallel. Scattering
+// preserves the order of each block, so the sort is stable. Bytes that are
+// the same for all the keys (e.g. the high bytes of small ids) are skipped.
+
+#ifndef vtkSMPToolsRadixSortInternal_h
+#define vtkSMPToolsRadixSortInternal_h
+
+#include <algorithm> // For std::copy
+#include <cstring> // For memcpy
+#include <limits> // For std::numeric_limits
+#include <vector> // For the temporary buffers
+
+#ifndef __WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+// Blocks sorted by a thread hold at least this many elements.
+const vtkIdType vtkSMPTools_RadixSortMinimumBlockSize = 16384;
+// Maximum number of blocks, which bounds the size of the histograms.
+const vtkIdType vtkSMPTools_RadixSortMaximumNumberOfBlocks = 64;
+// Smaller inputs are sorted with an insertion sort.
+const vtkIdType vtkSMPTools_RadixSortInsertionSize = 32;
+
+//--------------------------------------------------------------------------------
+template <int Size> struct vtkSMPTools_RadixUInt;
+template <> struct vtkSMPTools_RadixUInt<1> { typedef vtkTypeUInt8 Type; };
+template <> struct vtkSMPTools_RadixUInt<2> { typedef vtkTypeUInt16 Type; };
+template <> struct vtkSMPTools_RadixUInt<4> { typedef vtkTypeUInt32 Type; };
+template <> struct vtkSMPTools_RadixUInt<8> { typedef vtkTypeUInt64 Type; };
+
+//--------------------------------------------------------------------------------
+// Map a key to an unsigned integer with the same ordering. Only integral
+// types, float and double are supported.
+template <typename T, bool IsInteger = std::numeric_limits<T>::is_integer>
+struct vtkSMPTools_RadixTraits;
+
+template <typename T>
+struct vtkSMPTools_RadixTraits<T, true>
+{
+  typedef typename vtkSMPTools_RadixUInt<sizeof(T)>::Type UIntType;
+  static UIntType Encode(T value)
+  {
+    UIntType bits = static_cast<UIntType>(value);
+    if (std::numeric_limits<T>::is_signed)
+      {
+      bits ^= static_cast<UIntType>(static_cast<UIntType>(1) <<
+                                    (8 * sizeof(T) - 1));
+      }
+    return bits;
+  }
+};
+
+template <>
+struct vtkSMPTools_RadixTraits<float, false>
+{
+  typedef vtkTypeUInt32 UIntType;
+  static UIntType Encode(float value)
+  {
+    UIntType bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+  }
+};
+
+template <>
+struct vtkSMPTools_RadixTraits<double, false>
+{
+  typedef vtkTypeUInt64 UIntType;
+  static UIntType Encode(double value)
+  {
+    const UIntType sign = static_cast<UIntType>(1) << 63;
+    UIntType bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & sign) ? ~bits : (bits | sign);
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Key extractors: the element itself, or one of its data members.
+template <typename T>
+struct vtkSMPTools_RadixIdentity
+{
+  typedef T KeyType;
+  const T& operator()(const T& item) const { return item; }
+};
+
+template <typename T, typename K>
+struct vtkSMPTools_RadixMember
+{
+  typedef K KeyType;
+  K T::*Member;
+  vtkSMPTools_RadixMember(K T::*member) : Member(member) {}
+  const K& operator()(const T& item) const { return item.*(this->Member); }
+};
+
+// Value type used when there are no values to carry along.
+struct vtkSMPTools_RadixNoValue {};
+
+enum vtkSMPTools_RadixStage
+{
+  vtkSMPTools_RadixAnalyze,
+  vtkSMPTools_RadixCount,
+  vtkSMPTools_RadixScatter,
+  vtkSMPTools_RadixCopyBack
+};
+
+//--------------------------------------------------------------------------------
+// Sort Size items (and the optional values with the same index) by the keys
+// returned by KeyOf.
+template <typename Item, typename Value, typename KeyOf>
+class vtkSMPTools_RadixSorter
+{
+public:
+  typedef typename KeyOf::KeyType KeyType;
+  typedef vtkSMPTools_RadixTraits<KeyType> Traits;
+  typedef typename Traits::UIntType UIntType;
+
+  vtkSMPTools_RadixSorter(Item* items, Value* values, vtkIdType size,
+                          KeyOf keyOf)
+    : Size(size), NumberOfBlocks(1), BlockSize(size), Shift(0), Source(0),
+      GetKey(keyOf)
+  {
+    this->Items[0] = items;
+    this->Items[1] = 0;
+    this->Values[0] = values;
+    this->Values[1] = 0;
+  }
+
+  void Sort(vtkIdType maxBlocks);
+  void ExecuteStage(int stage, vtkIdType block);
+
+private:
+  UIntType Encode(const Item& item) const
+  {
+    return Traits::Encode(this->GetKey(item));
+  }
+  unsigned int GetDigit(const Item& item) const
+  {
+    return static_cast<unsigned int>((this->Encode(item) >> this->Shift) &
+                                     0xff);
+  }
+  void GetBlock(vtkIdType block, vtkIdType& first, vtkIdType& last) const
+  {
+    first = block * this->BlockSize;
+    last = first + this->BlockSize;
+    last = last < this->Size ? last : this->Size;
+  }
+  void InsertionSort();
+  void RunStage(int stage);
+
+  vtkIdType Size;
+  vtkIdType NumberOfBlocks;
+  vtkIdType BlockSize;
+  int Shift;
+  int Source;
+  KeyOf GetKey;
+  Item* Items[2];
+  Value* Values[2];
+  std::vector<Item> TemporaryItems;
+  std::vector<Value> TemporaryValues;
+  std::vector<vtkIdType> Counts;
+  std::vector<UIntType> BlockFirst;
+  std::vector<UIntType> BlockDifference;
+};
+
+//--------------------------------------------------------------------------------
+template <typename Sorter, int Stage>
+struct vtkSMPTools_RadixPass
+{
+  Sorter& S;
+  vtkSMPTools_RadixPass(Sorter& s) : S(s) {}
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    for (vtkIdType block = first; block < last; ++block)
+      {
+      this->S.ExecuteStage(Stage, block);
+      }
+  }
+private:
+  void operator=(const vtkSMPTools_RadixPass&); // not implemented
+};
+
+//--------------------------------------------------------------------------------
+template <typename Item, typename Value, typename KeyOf>
+void vtkSMPTools_RadixSorter<Item, Value, KeyOf>::ExecuteStage(
+  int stage, vtkIdType block)
+{
+  vtkIdType first, last;
+  this->GetBlock(block, first, last);
+  const Item* src = this->Items[this->Source];
+  const Value* srcValues = this->Values[this->Source];
+  switch (stage)
+    {
+    case vtkSMPTools_RadixAnalyze:
+      {
+      // Record which bits differ within the block.
+      UIntType firstKey = first < last ? this->Encode(src[first]) : 0;
+      UIntType difference = 0;
+      for (vtkIdType i = first + 1; i < last; ++i)
+        {
+        difference |= this->Encode(src[i]) ^ firstKey;
+        }
+      this->BlockFirst[block] = firstKey;
+      this->BlockDifference[block] = difference;
+      }
+      break;
+    case vtkSMPTools_RadixCount:
+      {
+      vtkIdType* counts = &this->Counts[block * 256];
+      std::fill(counts, counts + 256, 0);
+      for (vtkIdType i = first; i < last; ++i)
+        {
+        ++counts[this->GetDigit(src[i])];
+        }
+      }
+      break;
+    case vtkSMPTools_RadixScatter:
+      {
+      // The counts now hold the output position of each digit.
+      vtkIdType* offsets = &this->Counts[block * 256];
+      Item* dst = this->Items[1 - this->Source];
+      Value* dstValues = this->Values[1 - this->Source];
+      for (vtkIdType i = first; i < last; ++i)
+        {
+        vtkIdType pos = offsets[this->GetDigit(src[i])]++;
+        dst[pos] = src[i];
+        if (dstValues)
+          {
+          dstValues[pos] = srcValues[i];
+          }
+        }
+      }
+      break;
+    case vtkSMPTools_RadixCopyBack:
+      std::copy(src + first, src + last, this->Items[0] + first);
+      if (srcValues)
+        {
+        std::copy(srcValues + first, srcValues + last,
+                  this->Values[0] + first);
+        }
+      break;
+    }
+}
+
+//--------------------------------------------------------------------------------
+template <typename Item, typename Value, typename KeyOf>
+void vtkSMPTools_RadixSorter<Item, Value, KeyOf>::RunStage(int stage)
+{
+  if (this->NumberOfBlocks == 1)
+    {
+    this->ExecuteStage(stage, 0);
+    return;
+    }
+  switch (stage)
+    {
+    case vtkSMPTools_RadixAnalyze:
+      {
+      vtkSMPTools_RadixPass<vtkSMPTools_RadixSorter, vtkSMPTools_RadixAnalyze>
+        pass(*this);
+      vtkSMPTools_Impl_ScopedFor(0, this->NumberOfBlocks, 1, pass);
+      }
+      break;
+    case vtkSMPTools_RadixCount:
+      {
+      vtkSMPTools_RadixPass<vtkSMPTools_RadixSorter, vtkSMPTools_RadixCount>
+        pass(*this);
+      vtkSMPTools_Impl_ScopedFor(0, this->NumberOfBlocks, 1, pass);
+      }
+      break;
+    case vtkSMPTools_RadixScatter:
+      {
+      vtkSMPTools_RadixPass<vtkSMPTools_RadixSorter, vtkSMPTools_RadixScatter>
+        pass(*this);
+      vtkSMPTools_Impl_ScopedFor(0, this->NumberOfBlocks, 1, pass);
+      }
+      break;
+    case vtkSMPTools_RadixCopyBack:
+      {
+      vtkSMPTools_RadixPass<vtkSMPTools_RadixSorter, vtkSMPTools_RadixCopyBack>
+        pass(*this);
+      vtkSMPTools_Impl_ScopedFor(0, this->NumberOfBlocks, 1, pass);
+      }
+      break;
+    }
+}
+
+//--------------------------------------------------------------------------------
+template <typename Item, typename Value, typename KeyOf>
+void vtkSMPTools_RadixSorter<Item, Value, KeyOf>::InsertionSort()
+{
+  Item* items = this->Items[0];
+  Value* values = this->Values[0];
+  for (vtkIdType i = 1; i < this->Size; ++i)
+    {
+    UIntType key = this->Encode(items[i]);
+    vtkIdType j = i;
+    if (this->Encode(items[j - 1]) <= key)
+      {
+      continue;
+      }
+    Item item = items[i];
+    for (; j > 0 && this->Encode(items[j - 1]) > key; --j)
+      {
+      items[j] = items[j - 1];
+      }
+    items[j] = item;
+    if (values)
+      {
+      Value value = values[i];
+      std::copy_backward(values + j, values + i, values + i + 1);
+      values[j] = value;
+      }
+    }
+}
+
+//--------------------------------------------------------------------------------
+template <typename Item, typename Value, typename KeyOf>
+void vtkSMPTools_RadixSorter<Item, Value, KeyOf>::Sort(vtkIdType maxBlocks)
+{
+  if (this->Size < 2)
+    {
+    return;
+    }
+  if (this->Size <= vtkSMPTools_RadixSortInsertionSize)
+    {
+    this->InsertionSort();
+    return;
+    }
+
+  if (vtkSMPToolsIsSerialScope())
+    {
+    maxBlocks = 1;
+    }
+  vtkIdType numBlocks = this->Size / vtkSMPTools_RadixSortMinimumBlockSize;
+  numBlocks = numBlocks < maxBlocks ? numBlocks : maxBlocks;
+  this->NumberOfBlocks = numBlocks > 0 ? numBlocks : 1;
+  this->BlockSize =
+    (this->Size + this->NumberOfBlocks - 1) / this->NumberOfBlocks;
+  this->NumberOfBlocks =
+    (this->Size + this->BlockSize - 1) / this->BlockSize;
+
+  // Find the digits that differ between keys; the others need no pass.
+  this->BlockFirst.resize(static_cast<size_t>(this->NumberOfBlocks));
+  this->BlockDifference.resize(static_cast<size_t>(this->NumberOfBlocks));
+  this->RunStage(vtkSMPTools_RadixAnalyze);
+  UIntType difference = 0;
+  for (vtkIdType block = 0; block < this->NumberOfBlocks; ++block)
+    {
+    difference |= this->BlockDifference[block] |
+      (this->BlockFirst[block] ^ this->BlockFirst[0]);
+    }
+  if (difference == 0)
+    {
+    return;
+    }
+
+  this->TemporaryItems.resize(static_cast<size_t>(this->Size));
+  this->Items[1] = &this->TemporaryItems[0];
+  if (this->Values[0])
+    {
+    this->TemporaryValues.resize(static_cast<size_t>(this->Size));
+    this->Values[1] = &this->TemporaryValues[0];
+    }
+  this->Counts.resize(static_cast<size_t>(this->NumberOfBlocks * 256));
+
+  for (int digit = 0; digit < static_cast<int>(sizeof(UIntType)); ++digit)
+    {
+    this->Shift = 8 * digit;
+    if (((difference >> this->Shift) & 0xff) == 0)
+      {
+      continue;
+      }
+    this->RunStage(vtkSMPTools_RadixCount);
+    // Digit-major exclusive scan of the block histograms.
+    vtkIdType position = 0;
+    for (int d = 0; d < 256; ++d)
+      {
+      for (vtkIdType block = 0; block < this->NumberOfBlocks; ++block)
+        {
+        vtkIdType& count = this->Counts[block * 256 + d];
+        vtkIdType blockCount = count;
+        count = position;
+        position += blockCount;
+        }
+      }
+    this->RunStage(vtkSMPTools_RadixScatter);
+    this->Source = 1 - this->Source;
+    }
+
+  if (this->Source == 1)
+    {
+    this->RunStage(vtkSMPTools_RadixCopyBack);
+    }
+}
+
+//--------------------------------------------------------------------------------
+// Radix sort for back-ends without native support.
+template <typename Item, typename Value, typename KeyOf>
+void vtkSMPTools_Emulated_RadixSort(Item* begin, Item* end, Value* values,
+                                    KeyOf keyOf, vtkIdType maxBlocks)
+{
+  vtkSMPTools_RadixSorter<Item, Value, KeyOf>
+    sorter(begin, values, static_cast<vtkIdType>(end - begin), keyOf);
+  sorter.Sort(maxBlocks);
+}
+
+}//namespace smp
+}//namespace detail
+}//namespace vtk
+#endif // __WRAP__
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsRadixSortInternal.h
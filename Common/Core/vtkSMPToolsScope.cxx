@@ -0,0 +1,94 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsScope.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Back-end independent part of vtkSMPTools::Scope.
+
+#include "vtkSMPTools.h"
+
+#include "vtkAtomicTypes.h"
+
+#if defined(_MSC_VER)
+# define VTK_SMP_THREAD_LOCAL __declspec(thread)
+#else
+# define VTK_SMP_THREAD_LOCAL __thread
+#endif
+
+namespace
+{
+// Threads start with the back-end defaults, nesting allowed.
+VTK_SMP_THREAD_LOCAL vtk::detail::smp::vtkSMPToolsScopeState
+  vtkSMPToolsThreadState = { 0, true, 0, 0 };
+
+VTK_SMP_THREAD_LOCAL int vtkSMPToolsThreadIndex = -1;
+vtkAtomicInt32 vtkSMPToolsNumberOfThreadIndices(0);
+}
+
+//--------------------------------------------------------------------------------
+vtk::detail::smp::vtkSMPToolsScopeState&
+vtk::detail::smp::vtkSMPToolsGetScopeState()
+{
+  return vtkSMPToolsThreadState;
+}
+
+//--------------------------------------------------------------------------------
+int vtk::detail::smp::vtkSMPToolsGetThreadIndex()
+{
+  if (vtkSMPToolsThreadIndex < 0)
+    {
+    vtkSMPToolsThreadIndex = vtkSMPToolsNumberOfThreadIndices++;
+    }
+  return vtkSMPToolsThreadIndex;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::Scope::Scope(int numberOfThreads, bool nestedParallelism)
+{
+  vtk::detail::smp::vtkSMPToolsScopeState& state =
+    vtk::detail::smp::vtkSMPToolsGetScopeState();
+  this->Previous = state;
+  this->BackendData = 0;
+  if (numberOfThreads > 0)
+    {
+    state.NumberOfThreads = numberOfThreads;
+    }
+  state.NestedParallelism = nestedParallelism;
+  vtk::detail::smp::vtkSMPTools_Impl_BeginScope(state, this->BackendData);
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::Scope::~Scope()
+{
+  vtk::detail::smp::vtkSMPToolsScopeState& state =
+    vtk::detail::smp::vtkSMPToolsGetScopeState();
+  vtk::detail::smp::vtkSMPTools_Impl_EndScope(state, this->BackendData);
+  state = this->Previous;
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPTools::GetScopeNumberOfThreads()
+{
+  return vtk::detail::smp::vtkSMPToolsGetScopeState().NumberOfThreads;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPTools::GetNestedParallelism()
+{
+  return vtk::detail::smp::vtkSMPToolsGetScopeState().NestedParallelism;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPTools::IsParallelScope()
+{
+  return vtk::detail::smp::vtkSMPToolsGetScopeState().ParallelDepth > 0;
+}
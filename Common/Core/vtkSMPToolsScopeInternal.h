@@ -0,0 +1,105 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsScopeInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Per-thread execution settings of vtkSMPTools, controlled with
+// vtkSMPTools::Scope. This header is included by the SMP back-ends and
+// should not be included directly.
+//
+// Each thread has its own state. When a back-end runs a piece of an
+// algorithm on a thread, it installs the state of the thread that started
+// the algorithm with a vtkSMPToolsWorkerScope, so that functors see the
+// settings of their caller and nested calls know they are nested.
+
+#ifndef vtkSMPToolsScopeInternal_h
+#define vtkSMPToolsScopeInternal_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSystemIncludes.h"
+
+#ifndef __WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+struct vtkSMPToolsScopeState
+{
+  // Number of threads requested by the innermost scope, 0 for the back-end
+  // default.
+  int NumberOfThreads;
+  // Whether algorithms started from within an algorithm run in parallel.
+  bool NestedParallelism;
+  // Number of algorithms the current thread is executing a part of.
+  int ParallelDepth;
+  // Back-end specific execution context (the task_arena for TBB).
+  void *Context;
+};
+
+// Return the state of the calling thread.
+VTKCOMMONCORE_EXPORT vtkSMPToolsScopeState& vtkSMPToolsGetScopeState();
+
+// Return true if an algorithm started by the calling thread must run
+// serially, either because the scope allows a single thread or because
+// the thread is already running an algorithm and nesting is disabled.
+inline bool vtkSMPToolsIsSerialScope()
+{
+  const vtkSMPToolsScopeState& state = vtkSMPToolsGetScopeState();
+  return state.NumberOfThreads == 1 ||
+    (state.ParallelDepth > 0 && !state.NestedParallelism);
+}
+
+// Install the state of the thread that started an algorithm on the thread
+// executing a part of it, for the lifetime of the object.
+class vtkSMPToolsWorkerScope
+{
+public:
+  vtkSMPToolsWorkerScope(const vtkSMPToolsScopeState& parent)
+    : State(vtkSMPToolsGetScopeState()), Saved(State)
+  {
+    this->State = parent;
+    ++this->State.ParallelDepth;
+  }
+  ~vtkSMPToolsWorkerScope()
+  {
+    this->State = this->Saved;
+  }
+private:
+  vtkSMPToolsScopeState& State;
+  vtkSMPToolsScopeState Saved;
+
+  vtkSMPToolsWorkerScope(const vtkSMPToolsWorkerScope&); // not implemented
+  void operator=(const vtkSMPToolsWorkerScope&); // not implemented
+};
+
+// Return a small index identifying the calling thread, assigned the first
+// time the thread calls this function. See vtkSMPTools::GetThreadIndex().
+VTKCOMMONCORE_EXPORT int vtkSMPToolsGetThreadIndex();
+
+// Back-end hooks called when a vtkSMPTools::Scope is entered and left.
+// The entry hook may set state.Context and return data in backendData,
+// which is given back to the exit hook.
+void vtkSMPTools_Impl_BeginScope(vtkSMPToolsScopeState& state,
+                                 void*& backendData);
+void vtkSMPTools_Impl_EndScope(vtkSMPToolsScopeState& state,
+                               void* backendData);
+
+}//namespace smp
+}//namespace detail
+}//namespace vtk
+#endif // __WRAP__
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsScopeInternal.h
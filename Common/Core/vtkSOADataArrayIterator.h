@@ -0,0 +1,198 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSOADataArrayIterator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// .NAME vtkSOADataArrayIterator - STL-style random access iterator for
+// vtkSOADataArrayTemplate.
+//
+// .SECTION Description
+// vtkSOADataArrayIterator traverses the values of a structure-of-arrays data
+// array in the same order as a standard (interleaved) vtkDataArray, i.e. all
+// components of a tuple are visited before moving on to the next tuple.
+// Unlike vtkTypedDataArrayIterator, no virtual calls are made: the iterator
+// holds the per-component buffer pointers directly, so dereferencing compiles
+// down to a pair of loads and can be inlined into templated kernels.
+//
+// The iterator must not be used after the array has been resized or its
+// component buffers have been replaced.
+//
+// .SECTION See Also
+// vtkSOADataArrayTemplate vtkDataArrayIteratorMacro
+
+#ifndef vtkSOADataArrayIterator_h
+#define vtkSOADataArrayIterator_h
+
+#include "vtkType.h" // For vtkIdType
+
+#include <cstddef>  // For ptrdiff_t
+#include <iterator> // For iterator traits
+
+template<class Scalar>
+class vtkSOADataArrayIterator
+{
+public:
+  typedef std::random_access_iterator_tag iterator_category;
+  typedef Scalar value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef Scalar& reference;
+  typedef Scalar* pointer;
+
+  vtkSOADataArrayIterator()
+    : Arrays(NULL), NumberOfComponents(1), Tuple(0), Component(0) {}
+
+  vtkSOADataArrayIterator(Scalar * const *arrays, int numComps,
+                          vtkIdType valueIdx = 0)
+    : Arrays(arrays),
+      NumberOfComponents(numComps),
+      Tuple(valueIdx / numComps),
+      Component(static_cast<int>(valueIdx % numComps))
+  {
+  }
+
+  bool operator==(const vtkSOADataArrayIterator<Scalar> &o) const
+  {
+    return this->Tuple == o.Tuple && this->Component == o.Component;
+  }
+
+  bool operator!=(const vtkSOADataArrayIterator<Scalar> &o) const
+  {
+    return this->Tuple != o.Tuple || this->Component != o.Component;
+  }
+
+  bool operator<(const vtkSOADataArrayIterator<Scalar> &o) const
+  {
+    return this->GetValueIndex() < o.GetValueIndex();
+  }
+
+  bool operator<=(const vtkSOADataArrayIterator<Scalar> &o) const
+  {
+    return this->GetValueIndex() <= o.GetValueIndex();
+  }
+
+  bool operator>(const vtkSOADataArrayIterator<Scalar> &o) const
+  {
+    return this->GetValueIndex() > o.GetValueIndex();
+  }
+
+  bool operator>=(const vtkSOADataArrayIterator<Scalar> &o) const
+  {
+    return this->GetValueIndex() >= o.GetValueIndex();
+  }
+
+  Scalar& operator*() const
+  {
+    return this->Arrays[this->Component][this->Tuple];
+  }
+
+  Scalar* operator->() const
+  {
+    return &this->Arrays[this->Component][this->Tuple];
+  }
+
+  Scalar& operator[](const difference_type &n) const
+  {
+    const vtkIdType idx = this->GetValueIndex() + n;
+    return this->Arrays[idx % this->NumberOfComponents]
+                       [idx / this->NumberOfComponents];
+  }
+
+  vtkSOADataArrayIterator& operator++()
+  {
+    if (++this->Component == this->NumberOfComponents)
+      {
+      this->Component = 0;
+      ++this->Tuple;
+      }
+    return *this;
+  }
+
+  vtkSOADataArrayIterator& operator--()
+  {
+    if (this->Component-- == 0)
+      {
+      this->Component = this->NumberOfComponents - 1;
+      --this->Tuple;
+      }
+    return *this;
+  }
+
+  vtkSOADataArrayIterator operator++(int)
+  {
+    vtkSOADataArrayIterator copy(*this);
+    ++(*this);
+    return copy;
+  }
+
+  vtkSOADataArrayIterator operator--(int)
+  {
+    vtkSOADataArrayIterator copy(*this);
+    --(*this);
+    return copy;
+  }
+
+  vtkSOADataArrayIterator operator+(const difference_type& n) const
+  {
+    return vtkSOADataArrayIterator(this->Arrays, this->NumberOfComponents,
+                                   this->GetValueIndex() + n);
+  }
+
+  vtkSOADataArrayIterator operator-(const difference_type& n) const
+  {
+    return vtkSOADataArrayIterator(this->Arrays, this->NumberOfComponents,
+                                   this->GetValueIndex() - n);
+  }
+
+  difference_type operator-(const vtkSOADataArrayIterator& other) const
+  {
+    return this->GetValueIndex() - other.GetValueIndex();
+  }
+
+  vtkSOADataArrayIterator& operator+=(const difference_type& n)
+  {
+    this->SetValueIndex(this->GetValueIndex() + n);
+    return *this;
+  }
+
+  vtkSOADataArrayIterator& operator-=(const difference_type& n)
+  {
+    this->SetValueIndex(this->GetValueIndex() - n);
+    return *this;
+  }
+
+  // Description:
+  // Return the tuple/component the iterator currently points at.
+  vtkIdType GetTupleIndex() const { return this->Tuple; }
+  int GetComponentIndex() const { return this->Component; }
+
+private:
+  vtkIdType GetValueIndex() const
+  {
+    return this->Tuple * this->NumberOfComponents + this->Component;
+  }
+
+  void SetValueIndex(vtkIdType idx)
+  {
+    this->Tuple = idx / this->NumberOfComponents;
+    this->Component = static_cast<int>(idx % this->NumberOfComponents);
+  }
+
+  Scalar * const *Arrays;
+  int NumberOfComponents;
+  vtkIdType Tuple;
+  int Component;
+};
+
+#endif // vtkSOADataArrayIterator_h
+
+// VTK-HeaderTest-Exclude: vtkSOADataArrayIterator.h
@@ -0,0 +1,249 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSOADataArrayTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSOADataArrayTemplate - Structure-of-arrays implementation of
+// vtkDataArray.
+//
+// .SECTION Description
+// vtkSOADataArrayTemplate stores each component of the array in its own
+// contiguous buffer, {c1t1, c1t2, ... c1tN}, {c2t1, ... c2tN}, ..., rather
+// than interleaving the components of each tuple as vtkDataArrayTemplate
+// does. Simulation codes that keep their fields as separate x/y/z buffers can
+// hand them to VTK with SetArray() without repacking the data.
+//
+// Although this class derives from vtkMappedDataArray (so that it behaves
+// safely everywhere the pipeline expects a non-standard memory layout), it is
+// a first class citizen of the fast paths: vtkDataArrayIteratorMacro and
+// vtkDataArrayDispatcher recognize it explicitly and use a
+// vtkSOADataArrayIterator, which reads the component buffers directly and
+// involves no virtual calls.
+//
+// Single component arrays have the standard memory layout; in that case
+// GetVoidPointer() returns the component buffer itself without any copy.
+//
+// .SECTION See Also
+// vtkSOADataArrayIterator vtkMappedDataArray vtkDataArrayTemplate
+
+#ifndef vtkSOADataArrayTemplate_h
+#define vtkSOADataArrayTemplate_h
+
+#include "vtkMappedDataArray.h"
+
+#include "vtkSOADataArrayIterator.h" // For Iterator
+#include "vtkTypeTemplate.h" // For templated vtkObject API
+
+#include <vector> // For component buffers
+
+template <class Scalar>
+class vtkSOADataArrayTemplate:
+    public vtkTypeTemplate<vtkSOADataArrayTemplate<Scalar>,
+                           vtkMappedDataArray<Scalar> >
+{
+public:
+  vtkMappedDataArrayNewInstanceMacro(vtkSOADataArrayTemplate<Scalar>)
+  static vtkSOADataArrayTemplate *New();
+  virtual void PrintSelf(ostream &os, vtkIndent indent);
+
+  typedef typename vtkMappedDataArray<Scalar>::ValueType ValueType;
+
+  // Description:
+  // Typedef to a suitable iterator class.
+  // Rather than using this member directly, consider using
+  // vtkDataArrayIteratorMacro for safety and efficiency.
+  typedef vtkSOADataArrayIterator<Scalar> Iterator;
+
+  // Description:
+  // Return an iterator initialized to the first element of the data.
+  Iterator Begin()
+    {
+    return Iterator(&this->Arrays[0], this->NumberOfComponents, 0);
+    }
+
+  // Description:
+  // Return an iterator initialized to first element past the end of the data.
+  Iterator End()
+    {
+    return Iterator(&this->Arrays[0], this->NumberOfComponents,
+                    this->MaxId + 1);
+    }
+
+  // Description:
+  // Perform a fast, safe cast from a vtkAbstractArray to a
+  // vtkSOADataArrayTemplate. Returns NULL if source is not a
+  // vtkSOADataArrayTemplate holding values of type Scalar.
+  static vtkSOADataArrayTemplate<Scalar>* FastDownCast(
+    vtkAbstractArray *source);
+
+  // Description:
+  // Set the number of components. Existing component buffers are kept when
+  // the number of components grows; buffers for components that are removed
+  // are released.
+  virtual void SetNumberOfComponents(int numComps);
+
+  // Description:
+  // Use the buffer pointed to by array to hold the values of component comp.
+  // size is the number of tuples held by the buffer. If updateMaxId is true,
+  // the number of tuples of the array is set to size, otherwise it is left
+  // unchanged (use this when setting several components in a row and update
+  // on the last one). Set save to true to keep the class from deleting the
+  // buffer when it cleans up or reallocates memory. deleteMethod is one of
+  // vtkAbstractArray::VTK_DATA_ARRAY_FREE or VTK_DATA_ARRAY_DELETE and
+  // determines how the buffer is released when it is owned by the array.
+  void SetArray(int comp, Scalar *array, vtkIdType size,
+                bool updateMaxId = false, bool save = false,
+                int deleteMethod = vtkAbstractArray::VTK_DATA_ARRAY_FREE);
+
+  // Description:
+  // Return the buffer holding the values of component comp.
+  Scalar* GetComponentArrayPointer(int comp)
+    {
+    return (comp >= 0 && comp < this->NumberOfComponents) ?
+      this->Arrays[comp] : NULL;
+    }
+
+  // Description:
+  // Fast, inlined access to a single value of the array.
+  Scalar GetTypedComponent(vtkIdType tupleIdx, int comp) const
+    {
+    return this->Arrays[comp][tupleIdx];
+    }
+  void SetTypedComponent(vtkIdType tupleIdx, int comp, Scalar value)
+    {
+    this->Arrays[comp][tupleIdx] = value;
+    }
+
+  // Description:
+  // Component access that avoids the tuple copy done by vtkDataArray.
+  double GetComponent(vtkIdType i, int j);
+  void SetComponent(vtkIdType i, int j, double c);
+  void InsertComponent(vtkIdType i, int j, double c);
+
+  // Description:
+  // Return a pointer to the data. For single component arrays the component
+  // buffer is returned directly. For arrays with several components an
+  // interleaved copy is created (see vtkMappedDataArray::GetVoidPointer).
+  void* GetVoidPointer(vtkIdType id);
+
+  // Description:
+  // Return a writable pointer to the data. Only supported for single
+  // component arrays.
+  void* WriteVoidPointer(vtkIdType id, vtkIdType number);
+
+  // Description:
+  // Copy the values of the array, interleaved, into ptr.
+  void ExportToVoidPointer(void *ptr);
+
+  // Description:
+  // Tell the array the data has been modified through GetVoidPointer().
+  void DataChanged();
+
+  // Description:
+  // Only single component arrays share the standard memory layout.
+  bool HasStandardMemoryLayout() { return this->NumberOfComponents == 1; }
+
+  // Description:
+  // Return the memory in kilobytes consumed by this data array.
+  unsigned long GetActualMemorySize();
+
+  // Reimplemented virtuals -- see superclasses for descriptions:
+  void Initialize();
+  void GetTuples(vtkIdList *ptIds, vtkAbstractArray *output);
+  void GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *output);
+  void Squeeze();
+  vtkArrayIterator *NewIterator();
+  vtkIdType LookupValue(vtkVariant value);
+  void LookupValue(vtkVariant value, vtkIdList *ids);
+  vtkVariant GetVariantValue(vtkIdType idx);
+  void ClearLookup();
+  double* GetTuple(vtkIdType i);
+  void GetTuple(vtkIdType i, double *tuple);
+  vtkIdType LookupTypedValue(Scalar value);
+  void LookupTypedValue(Scalar value, vtkIdList *ids);
+  Scalar GetValue(vtkIdType idx);
+  Scalar& GetValueReference(vtkIdType idx);
+  void GetTupleValue(vtkIdType idx, Scalar *t);
+  int Allocate(vtkIdType sz, vtkIdType ext = 1000);
+  int Resize(vtkIdType numTuples);
+  void SetNumberOfTuples(vtkIdType number);
+  void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source);
+  void SetTuple(vtkIdType i, const float *source);
+  void SetTuple(vtkIdType i, const double *source);
+  void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source);
+  void InsertTuple(vtkIdType i, const float *source);
+  void InsertTuple(vtkIdType i, const double *source);
+  void InsertTuples(vtkIdList *dstIds, vtkIdList *srcIds,
+                    vtkAbstractArray *source);
+  void InsertTuples(vtkIdType dstStart, vtkIdType n, vtkIdType srcStart,
+                    vtkAbstractArray* source);
+  vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray *source);
+  vtkIdType InsertNextTuple(const float *source);
+  vtkIdType InsertNextTuple(const double *source);
+  void DeepCopy(vtkAbstractArray *aa);
+  void DeepCopy(vtkDataArray *da);
+  void InterpolateTuple(vtkIdType i, vtkIdList *ptIndices,
+                        vtkAbstractArray* source,  double* weights);
+  void InterpolateTuple(vtkIdType i, vtkIdType id1, vtkAbstractArray *source1,
+                        vtkIdType id2, vtkAbstractArray *source2, double t);
+  void SetVariantValue(vtkIdType idx, vtkVariant value);
+  void InsertVariantValue(vtkIdType idx, vtkVariant value);
+  void RemoveTuple(vtkIdType id);
+  void RemoveFirstTuple();
+  void RemoveLastTuple();
+  void SetTupleValue(vtkIdType i, const Scalar *t);
+  void InsertTupleValue(vtkIdType i, const Scalar *t);
+  vtkIdType InsertNextTupleValue(const Scalar *t);
+  void SetValue(vtkIdType idx, Scalar value);
+  vtkIdType InsertNextValue(Scalar v);
+  void InsertValue(vtkIdType idx, Scalar v);
+
+protected:
+  vtkSOADataArrayTemplate();
+  ~vtkSOADataArrayTemplate();
+
+  virtual int GetArrayType()
+  {
+    return vtkAbstractArray::SOADataArrayTemplate;
+  }
+
+  // Description:
+  // Make sure there is room for at least numTuples tuples, growing the
+  // component buffers geometrically. Returns false on allocation failure.
+  bool EnsureTupleCapacity(vtkIdType numTuples);
+
+  // Description:
+  // Reallocate all owned component buffers to hold exactly numTuples tuples.
+  bool ReallocateTuples(vtkIdType numTuples);
+
+  // Description:
+  // Release the buffer of component comp if owned by the array.
+  void ReleaseComponent(int comp);
+
+  std::vector<Scalar*> Arrays;
+  std::vector<int> SaveArrays;
+  std::vector<int> DeleteMethods;
+  vtkIdType TupleCapacity;
+
+private:
+  vtkSOADataArrayTemplate(const vtkSOADataArrayTemplate &); // Not implemented.
+  void operator=(const vtkSOADataArrayTemplate &); // Not implemented.
+
+  vtkIdType Lookup(const Scalar &val, vtkIdType startIndex);
+  double *TempDoubleArray;
+};
+
+#include "vtkSOADataArrayTemplate.txx"
+
+#endif //vtkSOADataArrayTemplate_h
+
+// VTK-HeaderTest-Exclude: vtkSOADataArrayTemplate.h
@@ -0,0 +1,1082 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSOADataArrayTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkSOADataArrayTemplate_txx
+#define vtkSOADataArrayTemplate_txx
+
+#include "vtkSOADataArrayTemplate.h"
+
+#include "vtkArrayIteratorTemplate.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkTypeTraits.h"
+#include "vtkVariant.h"
+#include "vtkVariantCast.h"
+
+#include <algorithm> // for std::min, std::copy
+#include <cstdlib>   // for malloc, realloc, free
+#include <cstring>   // for memcpy, memmove
+#include <new>       // for std::bad_alloc
+
+namespace vtkSOADataArrayTemplateInternals
+{
+//------------------------------------------------------------------------------
+// Round integer types, pass floating point types through. Matches the
+// behavior of vtkDataArray::InterpolateTuple.
+template <class T>
+inline T RoundIfNecessary(double val)
+{
+  val = std::max(val, static_cast<double>(vtkTypeTraits<T>::Min()));
+  val = std::min(val, static_cast<double>(vtkTypeTraits<T>::Max()));
+  return static_cast<T>((val >= 0.0) ? (val + 0.5) : (val - 0.5));
+}
+
+template <>
+inline double RoundIfNecessary<double>(double val)
+{
+  return val;
+}
+
+template <>
+inline float RoundIfNecessary<float>(double val)
+{
+  return static_cast<float>(val);
+}
+}
+
+//------------------------------------------------------------------------------
+// Can't use vtkStandardNewMacro on a templated class.
+template <class Scalar> vtkSOADataArrayTemplate<Scalar> *
+vtkSOADataArrayTemplate<Scalar>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkSOADataArrayTemplate<Scalar>)
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkSOADataArrayTemplate<Scalar>
+::vtkSOADataArrayTemplate()
+  : Arrays(1, static_cast<Scalar*>(NULL)),
+    SaveArrays(1, 0),
+    DeleteMethods(1, vtkAbstractArray::VTK_DATA_ARRAY_FREE),
+    TupleCapacity(0),
+    TempDoubleArray(NULL)
+{
+  this->TempDoubleArray = new double[1];
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkSOADataArrayTemplate<Scalar>
+::~vtkSOADataArrayTemplate()
+{
+  for (int c = 0; c < static_cast<int>(this->Arrays.size()); ++c)
+    {
+    this->ReleaseComponent(c);
+    }
+  delete [] this->TempDoubleArray;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->vtkSOADataArrayTemplate<Scalar>::Superclass::PrintSelf(os, indent);
+
+  os << indent << "TupleCapacity: " << this->TupleCapacity << "\n";
+  vtkIndent deeper = indent.GetNextIndent();
+  for (size_t i = 0; i < this->Arrays.size(); ++i)
+    {
+    os << deeper << "Component " << i << ": " << this->Arrays[i]
+       << (this->SaveArrays[i] ? " (user owned)" : "") << "\n";
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> inline vtkSOADataArrayTemplate<Scalar> *
+vtkSOADataArrayTemplate<Scalar>::FastDownCast(vtkAbstractArray *source)
+{
+  if (source &&
+      source->GetArrayType() == vtkAbstractArray::SOADataArrayTemplate &&
+      source->GetDataType() == vtkTypeTraits<Scalar>::VTK_TYPE_ID)
+    {
+    return static_cast<vtkSOADataArrayTemplate<Scalar>*>(source);
+    }
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::ReleaseComponent(int comp)
+{
+  Scalar *ptr = this->Arrays[comp];
+  if (ptr && !this->SaveArrays[comp])
+    {
+    if (this->DeleteMethods[comp] == vtkAbstractArray::VTK_DATA_ARRAY_DELETE)
+      {
+      delete [] ptr;
+      }
+    else
+      {
+      free(ptr);
+      }
+    }
+  this->Arrays[comp] = NULL;
+  this->SaveArrays[comp] = 0;
+  this->DeleteMethods[comp] = vtkAbstractArray::VTK_DATA_ARRAY_FREE;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetNumberOfComponents(int numComps)
+{
+  numComps = numComps < 1 ? 1 : numComps;
+  if (numComps == this->NumberOfComponents &&
+      static_cast<int>(this->Arrays.size()) == numComps)
+    {
+    return;
+    }
+
+  for (int c = numComps; c < static_cast<int>(this->Arrays.size()); ++c)
+    {
+    this->ReleaseComponent(c);
+    }
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  this->Arrays.resize(numComps, NULL);
+  this->SaveArrays.resize(numComps, 0);
+  this->DeleteMethods.resize(numComps, vtkAbstractArray::VTK_DATA_ARRAY_FREE);
+  this->NumberOfComponents = numComps;
+
+  delete [] this->TempDoubleArray;
+  this->TempDoubleArray = new double[numComps];
+
+  // Give the new components the same capacity as the existing ones.
+  if (this->TupleCapacity > 0)
+    {
+    this->ReallocateTuples(this->TupleCapacity);
+    }
+  this->Size = this->TupleCapacity * numComps;
+  this->MaxId = std::min(numTuples * numComps, this->Size) - 1;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetArray(int comp, Scalar *array, vtkIdType size, bool updateMaxId,
+           bool save, int deleteMethod)
+{
+  if (comp < 0)
+    {
+    vtkErrorMacro("Invalid component " << comp);
+    return;
+    }
+  if (comp >= this->NumberOfComponents)
+    {
+    this->SetNumberOfComponents(comp + 1);
+    }
+
+  this->ReleaseComponent(comp);
+  this->Arrays[comp] = array;
+  this->SaveArrays[comp] = save ? 1 : 0;
+  this->DeleteMethods[comp] = deleteMethod;
+
+  this->TupleCapacity = size;
+  this->Size = this->TupleCapacity * this->NumberOfComponents;
+  if (updateMaxId)
+    {
+    this->MaxId = this->Size - 1;
+    }
+  else if (this->MaxId >= this->Size)
+    {
+    this->MaxId = this->Size - 1;
+    }
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> bool vtkSOADataArrayTemplate<Scalar>
+::ReallocateTuples(vtkIdType numTuples)
+{
+  const size_t newBytes = static_cast<size_t>(numTuples) * sizeof(Scalar);
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    Scalar *oldPtr = this->Arrays[c];
+    Scalar *newPtr = NULL;
+    const bool canRealloc = oldPtr && !this->SaveArrays[c] &&
+      this->DeleteMethods[c] == vtkAbstractArray::VTK_DATA_ARRAY_FREE;
+    if (canRealloc)
+      {
+      newPtr = static_cast<Scalar*>(realloc(oldPtr, newBytes));
+      }
+    else
+      {
+      newPtr = static_cast<Scalar*>(malloc(newBytes));
+      if (newPtr && oldPtr)
+        {
+        memcpy(newPtr, oldPtr, static_cast<size_t>(
+                 std::min(numTuples, this->TupleCapacity)) * sizeof(Scalar));
+        }
+      }
+    if (!newPtr)
+      {
+      vtkErrorMacro("Unable to allocate " << numTuples
+                    << " elements of size " << sizeof(Scalar)
+                    << " bytes for component " << c << ".");
+      #if !defined NDEBUG
+      // We're debugging, crash here preserving the stack
+      abort();
+      #elif !defined VTK_DONT_THROW_BAD_ALLOC
+      // We can throw something that has universal meaning
+      throw std::bad_alloc();
+      #else
+      // We indicate that malloc failed by return
+      return false;
+      #endif
+      }
+    if (oldPtr && !canRealloc)
+      {
+      // The old buffer was not handed to realloc; release it if we own it.
+      this->ReleaseComponent(c);
+      }
+    this->Arrays[c] = newPtr;
+    this->SaveArrays[c] = 0;
+    this->DeleteMethods[c] = vtkAbstractArray::VTK_DATA_ARRAY_FREE;
+    }
+
+  this->TupleCapacity = numTuples;
+  this->Size = numTuples * this->NumberOfComponents;
+  if (this->MaxId >= this->Size)
+    {
+    this->MaxId = this->Size - 1;
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> bool vtkSOADataArrayTemplate<Scalar>
+::EnsureTupleCapacity(vtkIdType numTuples)
+{
+  if (numTuples <= this->TupleCapacity)
+    {
+    return true;
+    }
+  // Grow to more than double the current capacity, like
+  // vtkDataArrayTemplate::ResizeAndExtend.
+  return this->ReallocateTuples(this->TupleCapacity + numTuples);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::Initialize()
+{
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    this->ReleaseComponent(c);
+    }
+  this->TupleCapacity = 0;
+  this->MaxId = -1;
+  this->Size = 0;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> int vtkSOADataArrayTemplate<Scalar>
+::Allocate(vtkIdType sz, vtkIdType)
+{
+  this->MaxId = -1;
+  if (sz > this->Size)
+    {
+    vtkIdType numTuples = (sz + this->NumberOfComponents - 1) /
+      this->NumberOfComponents;
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      this->ReleaseComponent(c);
+      }
+    this->TupleCapacity = 0;
+    if (!this->ReallocateTuples(numTuples > 0 ? numTuples : 1))
+      {
+      return 0;
+      }
+    }
+  this->Modified();
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> int vtkSOADataArrayTemplate<Scalar>
+::Resize(vtkIdType numTuples)
+{
+  if (numTuples <= 0)
+    {
+    this->Initialize();
+    return 1;
+    }
+  if (numTuples == this->TupleCapacity)
+    {
+    return 1;
+    }
+  int ok = this->ReallocateTuples(numTuples) ? 1 : 0;
+  this->Modified();
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetNumberOfTuples(vtkIdType number)
+{
+  if (number > this->TupleCapacity && !this->ReallocateTuples(number))
+    {
+    return;
+    }
+  this->MaxId = number * this->NumberOfComponents - 1;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::Squeeze()
+{
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  if (numTuples > 0 && numTuples < this->TupleCapacity)
+    {
+    this->ReallocateTuples(numTuples);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void* vtkSOADataArrayTemplate<Scalar>
+::GetVoidPointer(vtkIdType id)
+{
+  if (this->NumberOfComponents == 1)
+    {
+    // Zero copy: the single component buffer has the standard layout.
+    return static_cast<void*>(this->Arrays[0] + id);
+    }
+  return this->vtkMappedDataArray<Scalar>::GetVoidPointer(id);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void* vtkSOADataArrayTemplate<Scalar>
+::WriteVoidPointer(vtkIdType id, vtkIdType number)
+{
+  if (this->NumberOfComponents != 1)
+    {
+    vtkErrorMacro(<<"WriteVoidPointer is only supported for single component "
+                  "arrays.");
+    return NULL;
+    }
+  vtkIdType newSize = id + number;
+  if (!this->EnsureTupleCapacity(newSize))
+    {
+    return NULL;
+    }
+  if (newSize - 1 > this->MaxId)
+    {
+    this->MaxId = newSize - 1;
+    }
+  this->Modified();
+  return static_cast<void*>(this->Arrays[0] + id);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::ExportToVoidPointer(void *voidPtr)
+{
+  Scalar *ptr = static_cast<Scalar*>(voidPtr);
+  std::copy(this->Begin(), this->End(), ptr);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::DataChanged()
+{
+  if (this->NumberOfComponents == 1)
+    {
+    // GetVoidPointer handed out the real buffer, nothing to copy back.
+    this->Modified();
+    return;
+    }
+  this->vtkMappedDataArray<Scalar>::DataChanged();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> unsigned long vtkSOADataArrayTemplate<Scalar>
+::GetActualMemorySize()
+{
+  return static_cast<unsigned long>(
+    (static_cast<double>(this->TupleCapacity) * this->NumberOfComponents *
+     sizeof(Scalar)) / 1024.0 + 1);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::GetTuples(vtkIdList *ptIds, vtkAbstractArray *output)
+{
+  vtkDataArray *da = vtkDataArray::FastDownCast(output);
+  if (!da)
+    {
+    vtkWarningMacro(<<"Input is not a vtkDataArray");
+    return;
+    }
+
+  if (da->GetNumberOfComponents() != this->GetNumberOfComponents())
+    {
+    vtkWarningMacro(<<"Incorrect number of components in input array.");
+    return;
+    }
+
+  const vtkIdType numPoints = ptIds->GetNumberOfIds();
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    da->SetTuple(i, this->GetTuple(ptIds->GetId(i)));
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *output)
+{
+  vtkDataArray *da = vtkDataArray::FastDownCast(output);
+  if (!da)
+    {
+    vtkErrorMacro(<<"Input is not a vtkDataArray");
+    return;
+    }
+
+  if (da->GetNumberOfComponents() != this->GetNumberOfComponents())
+    {
+    vtkErrorMacro(<<"Incorrect number of components in input array.");
+    return;
+    }
+
+  for (vtkIdType daTupleId = 0; p1 <= p2; ++p1)
+    {
+    da->SetTuple(daTupleId++, this->GetTuple(p1));
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkArrayIterator*
+vtkSOADataArrayTemplate<Scalar>::NewIterator()
+{
+  vtkArrayIteratorTemplate<Scalar>* iter =
+    vtkArrayIteratorTemplate<Scalar>::New();
+  iter->Initialize(this);
+  return iter;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::LookupValue(vtkVariant value)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  if (valid)
+    {
+    return this->Lookup(val, 0);
+    }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::LookupValue(vtkVariant value, vtkIdList *ids)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  ids->Reset();
+  if (valid)
+    {
+    this->LookupTypedValue(val, ids);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkVariant vtkSOADataArrayTemplate<Scalar>
+::GetVariantValue(vtkIdType idx)
+{
+  return vtkVariant(this->GetValue(idx));
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::ClearLookup()
+{
+  // no-op, no fast lookup implemented.
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> double* vtkSOADataArrayTemplate<Scalar>
+::GetTuple(vtkIdType i)
+{
+  this->GetTuple(i, this->TempDoubleArray);
+  return this->TempDoubleArray;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::GetTuple(vtkIdType i, double *tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    tuple[comp] = static_cast<double>(this->Arrays[comp][i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> double vtkSOADataArrayTemplate<Scalar>
+::GetComponent(vtkIdType i, int j)
+{
+  return static_cast<double>(this->Arrays[j][i]);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetComponent(vtkIdType i, int j, double c)
+{
+  this->Arrays[j][i] = static_cast<Scalar>(c);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertComponent(vtkIdType i, int j, double c)
+{
+  this->InsertValue(i * this->NumberOfComponents + j, static_cast<Scalar>(c));
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::LookupTypedValue(Scalar value)
+{
+  return this->Lookup(value, 0);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::LookupTypedValue(Scalar value, vtkIdList *ids)
+{
+  ids->Reset();
+  vtkIdType index = 0;
+  while ((index = this->Lookup(value, index)) >= 0)
+    {
+    ids->InsertNextId(index);
+    ++index;
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar vtkSOADataArrayTemplate<Scalar>
+::GetValue(vtkIdType idx)
+{
+  return this->GetValueReference(idx);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar& vtkSOADataArrayTemplate<Scalar>
+::GetValueReference(vtkIdType idx)
+{
+  const vtkIdType tuple = idx / this->NumberOfComponents;
+  const int comp = static_cast<int>(idx % this->NumberOfComponents);
+  return this->Arrays[comp][tuple];
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::GetTupleValue(vtkIdType tupleId, Scalar *tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    tuple[comp] = this->Arrays[comp][tupleId];
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source)
+{
+  if (!vtkDataTypesCompare(source->GetDataType(), this->GetDataType()))
+    {
+    vtkWarningMacro("Input and output array data types do not match.");
+    return;
+    }
+  if (this->NumberOfComponents != source->GetNumberOfComponents())
+    {
+    vtkWarningMacro("Input and output component sizes do not match.");
+    return;
+    }
+
+  // Copy directly into our buffers if the source has supporting API:
+  if (vtkSOADataArrayTemplate<Scalar> *soaSource =
+      vtkSOADataArrayTemplate<Scalar>::FastDownCast(source))
+    {
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      this->Arrays[c][i] = soaSource->Arrays[c][j];
+      }
+    }
+  else if (vtkTypedDataArray<Scalar> *typedSource =
+           vtkTypedDataArray<Scalar>::FastDownCast(source))
+    {
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      this->Arrays[c][i] =
+        typedSource->GetValue(j * this->NumberOfComponents + c);
+      }
+    }
+  else if (vtkDataArray *dataSource = vtkDataArray::FastDownCast(source))
+    {
+    // Otherwise use the double interface
+    this->SetTuple(i, dataSource->GetTuple(j));
+    return;
+    }
+  else
+    {
+    vtkWarningMacro("Input array is not a vtkDataArray subclass!");
+    return;
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetTuple(vtkIdType i, const float *source)
+{
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    this->Arrays[c][i] = static_cast<Scalar>(source[c]);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetTuple(vtkIdType i, const double *source)
+{
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    this->Arrays[c][i] = static_cast<Scalar>(source[c]);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source)
+{
+  if (!this->EnsureTupleCapacity(i + 1))
+    {
+    return;
+    }
+  vtkIdType maxId = (i + 1) * this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+  this->SetTuple(i, j, source);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType i, const float *source)
+{
+  if (!this->EnsureTupleCapacity(i + 1))
+    {
+    return;
+    }
+  vtkIdType maxId = (i + 1) * this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+  this->SetTuple(i, source);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType i, const double *source)
+{
+  if (!this->EnsureTupleCapacity(i + 1))
+    {
+    return;
+    }
+  vtkIdType maxId = (i + 1) * this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+  this->SetTuple(i, source);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertTuples(vtkIdList *dstIds, vtkIdList *srcIds, vtkAbstractArray *source)
+{
+  vtkIdType numIds = dstIds->GetNumberOfIds();
+  if (srcIds->GetNumberOfIds() != numIds)
+    {
+    vtkWarningMacro("Input and output id array sizes do not match.");
+    return;
+    }
+  for (vtkIdType idIndex = 0; idIndex < numIds; ++idIndex)
+    {
+    this->InsertTuple(dstIds->GetId(idIndex), srcIds->GetId(idIndex), source);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertTuples(vtkIdType dstStart, vtkIdType n, vtkIdType srcStart,
+               vtkAbstractArray *source)
+{
+  if (n <= 0)
+    {
+    return;
+    }
+  if (srcStart + n > source->GetNumberOfTuples())
+    {
+    vtkWarningMacro("Source range exceeds array size (srcStart=" << srcStart
+                    << ", n=" << n << ", numTuples="
+                    << source->GetNumberOfTuples() << ").");
+    return;
+    }
+  if (!this->EnsureTupleCapacity(dstStart + n))
+    {
+    return;
+    }
+  vtkIdType maxId = (dstStart + n) * this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+
+  if (vtkSOADataArrayTemplate<Scalar> *soaSource =
+      vtkSOADataArrayTemplate<Scalar>::FastDownCast(source))
+    {
+    if (soaSource->NumberOfComponents == this->NumberOfComponents)
+      {
+      for (int c = 0; c < this->NumberOfComponents; ++c)
+        {
+        memmove(this->Arrays[c] + dstStart, soaSource->Arrays[c] + srcStart,
+                static_cast<size_t>(n) * sizeof(Scalar));
+        }
+      return;
+      }
+    }
+  for (vtkIdType t = 0; t < n; ++t)
+    {
+    this->SetTuple(dstStart + t, srcStart + t, source);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::InsertNextTuple(vtkIdType j, vtkAbstractArray *source)
+{
+  vtkIdType nextTuple = this->GetNumberOfTuples();
+  this->InsertTuple(nextTuple, j, source);
+  return nextTuple;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::InsertNextTuple(const float *source)
+{
+  vtkIdType nextTuple = this->GetNumberOfTuples();
+  this->InsertTuple(nextTuple, source);
+  return nextTuple;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::InsertNextTuple(const double *source)
+{
+  vtkIdType nextTuple = this->GetNumberOfTuples();
+  this->InsertTuple(nextTuple, source);
+  return nextTuple;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::DeepCopy(vtkAbstractArray *aa)
+{
+  if (aa == NULL)
+    {
+    return;
+    }
+
+  vtkDataArray *da = vtkDataArray::FastDownCast(aa);
+  if (da == NULL)
+    {
+    vtkErrorMacro(<< "Input array is not a vtkDataArray ("
+                  << aa->GetClassName() << ")");
+    return;
+    }
+
+  this->DeepCopy(da);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::DeepCopy(vtkDataArray *da)
+{
+  if (da == NULL || da == this)
+    {
+    return;
+    }
+  // Resize the component buffers first; vtkDataArray::DeepCopy assigns
+  // NumberOfComponents directly and then copies through
+  // vtkDataArrayIteratorMacro, which handles this array type.
+  this->SetNumberOfComponents(da->GetNumberOfComponents());
+  this->vtkDataArray::DeepCopy(da);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InterpolateTuple(vtkIdType i, vtkIdList *ptIndices, vtkAbstractArray *source,
+                   double *weights)
+{
+  if (!vtkDataTypesCompare(this->GetDataType(), source->GetDataType()))
+    {
+    vtkErrorMacro("Cannot InterpolateValue from array of type "
+      << source->GetDataTypeAsString());
+    return;
+    }
+  vtkDataArray *fromData = vtkDataArray::FastDownCast(source);
+  if (!fromData ||
+      fromData->GetNumberOfComponents() != this->NumberOfComponents)
+    {
+    vtkErrorMacro("Source must be a vtkDataArray with matching components.");
+    return;
+    }
+
+  const vtkIdType numIds = ptIndices->GetNumberOfIds();
+  const vtkIdType *ids = ptIndices->GetPointer(0);
+  vtkSOADataArrayTemplate<Scalar> *soaSource =
+    vtkSOADataArrayTemplate<Scalar>::FastDownCast(source);
+
+  // Compute first, fromData may be this array and InsertValue may reallocate.
+  double *tuple = new double[this->NumberOfComponents];
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    double val = 0.0;
+    if (soaSource)
+      {
+      const Scalar *from = soaSource->Arrays[c];
+      for (vtkIdType j = 0; j < numIds; ++j)
+        {
+        val += weights[j] * static_cast<double>(from[ids[j]]);
+        }
+      }
+    else
+      {
+      for (vtkIdType j = 0; j < numIds; ++j)
+        {
+        val += weights[j] * fromData->GetComponent(ids[j], c);
+        }
+      }
+    tuple[c] = val;
+    }
+
+  vtkIdType loc = i * this->NumberOfComponents;
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    this->InsertValue(loc + c,
+      vtkSOADataArrayTemplateInternals::RoundIfNecessary<Scalar>(tuple[c]));
+    }
+  delete [] tuple;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InterpolateTuple(vtkIdType i, vtkIdType id1, vtkAbstractArray *source1,
+                   vtkIdType id2, vtkAbstractArray *source2, double t)
+{
+  int type = this->GetDataType();
+  if (!vtkDataTypesCompare(type, source1->GetDataType()) ||
+      !vtkDataTypesCompare(type, source2->GetDataType()))
+    {
+    vtkErrorMacro("All arrays to InterpolateValue must be of same type.");
+    return;
+    }
+  vtkDataArray *from1 = vtkDataArray::FastDownCast(source1);
+  vtkDataArray *from2 = vtkDataArray::FastDownCast(source2);
+  if (!from1 || !from2 ||
+      from1->GetNumberOfComponents() != this->NumberOfComponents ||
+      from2->GetNumberOfComponents() != this->NumberOfComponents)
+    {
+    vtkErrorMacro("Sources must be vtkDataArrays with matching components.");
+    return;
+    }
+  if (id1 >= from1->GetNumberOfTuples() || id2 >= from2->GetNumberOfTuples())
+    {
+    vtkErrorMacro("Tuple out of range for provided array.");
+    return;
+    }
+
+  const double oneMinusT = 1.0 - t;
+  double *tuple = new double[this->NumberOfComponents];
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    tuple[c] = oneMinusT * from1->GetComponent(id1, c) +
+      t * from2->GetComponent(id2, c);
+    }
+  vtkIdType loc = i * this->NumberOfComponents;
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    this->InsertValue(loc + c,
+      vtkSOADataArrayTemplateInternals::RoundIfNecessary<Scalar>(tuple[c]));
+    }
+  delete [] tuple;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetVariantValue(vtkIdType idx, vtkVariant value)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  if (valid)
+    {
+    this->SetValue(idx, val);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertVariantValue(vtkIdType idx, vtkVariant value)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  if (valid)
+    {
+    this->InsertValue(idx, val);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::RemoveTuple(vtkIdType id)
+{
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  if (id < 0 || id >= numTuples)
+    {
+    return;
+    }
+  if (id < numTuples - 1)
+    {
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      memmove(this->Arrays[c] + id, this->Arrays[c] + id + 1,
+              static_cast<size_t>(numTuples - id - 1) * sizeof(Scalar));
+      }
+    }
+  this->RemoveLastTuple();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::RemoveFirstTuple()
+{
+  this->RemoveTuple(0);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::RemoveLastTuple()
+{
+  if (this->GetNumberOfTuples() > 0)
+    {
+    this->MaxId -= this->NumberOfComponents;
+    this->Modified();
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetTupleValue(vtkIdType i, const Scalar *t)
+{
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    this->Arrays[c][i] = t[c];
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertTupleValue(vtkIdType i, const Scalar *t)
+{
+  if (!this->EnsureTupleCapacity(i + 1))
+    {
+    return;
+    }
+  vtkIdType maxId = (i + 1) * this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+  this->SetTupleValue(i, t);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::InsertNextTupleValue(const Scalar *t)
+{
+  vtkIdType nextTuple = this->GetNumberOfTuples();
+  this->InsertTupleValue(nextTuple, t);
+  return nextTuple;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetValue(vtkIdType idx, Scalar value)
+{
+  this->GetValueReference(idx) = value;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::InsertNextValue(Scalar v)
+{
+  vtkIdType nextValue = this->MaxId + 1;
+  this->InsertValue(nextValue, v);
+  return nextValue;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertValue(vtkIdType idx, Scalar v)
+{
+  if (!this->EnsureTupleCapacity(idx / this->NumberOfComponents + 1))
+    {
+    return;
+    }
+  if (idx > this->MaxId)
+    {
+    this->MaxId = idx;
+    }
+  this->SetValue(idx, v);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::Lookup(const Scalar &val, vtkIdType index)
+{
+  while (index <= this->MaxId)
+    {
+    if (this->GetValueReference(index) == val)
+      {
+      return index;
+      }
+    ++index;
+    }
+  return -1;
+}
+
+#endif //vtkSOADataArrayTemplate_txx
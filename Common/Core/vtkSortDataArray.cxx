@@ -138,6 +138,60 @@ struct TupleComp
     {return Array[idx0*NumComp+K] < Array[idx1*NumComp+K];}
 };
 
+//---------------------------------------------------------------------------
+// Gather the k-th component of the tuples referred to by the sort indices,
+// to radix sort the indices with the keys.
+template <typename T>
+struct GatherKeys
+{
+  const T *Array;
+  int NumComp;
+  int K;
+  const vtkIdType *Idx;
+  T *Keys;
+  GatherKeys(const T *array, int n, int k, const vtkIdType *idx, T *keys) :
+    Array(array), NumComp(n), K(k), Idx(idx), Keys(keys) {};
+  void operator() (vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType i=begin; i < end; ++i)
+      {
+      this->Keys[i] = this->Array[this->Idx[i]*this->NumComp+this->K];
+      }
+    }
+};
+
+//---------------------------------------------------------------------------
+// Sort the indices on the k-th component of the tuples. Numeric keys are
+// radix sorted (which is stable), strings are compared.
+template <typename T>
+void SortIndices(T *array, vtkIdType numKeys, int numComp, int k,
+                 vtkIdType *idx)
+{
+  if ( numKeys < 2 )
+    {
+    return;
+    }
+  T *keys = new T [numKeys];
+  GatherKeys<T> gather(array, numComp, k, idx, keys);
+  vtkSMPTools::For(0, numKeys, gather);
+  vtkSMPTools::RadixSort(keys, keys + numKeys, idx);
+  delete [] keys;
+}
+
+void SortIndices(vtkStdString *array, vtkIdType numKeys, int numComp, int k,
+                 vtkIdType *idx)
+{
+  if ( numComp == 1 )
+    {
+    vtkSMPTools::Sort(idx, idx+numKeys, KeyComp<vtkStdString>(array));
+    }
+  else
+    {
+    vtkSMPTools::Sort(idx, idx+numKeys,
+                      TupleComp<vtkStdString>(array,numComp,k));
+    }
+}
+
 //---------------------------------------------------------------------------
 // Given a set of indices (after sorting), copy the data from a pre-sorted
 // array to a final, post-sorted array, Implementation note: the direction of
@@ -240,8 +294,8 @@ GenerateSort1Indices(int dataType, void *dataIn, vtkIdType numKeys,
     {
     switch ( dataType )
       {
-      vtkExtendedTemplateMacro(vtkSMPTools::Sort(idx, idx+numKeys,
-                               KeyComp<VTK_TT>(static_cast<VTK_TT *>(dataIn))));
+      vtkExtendedTemplateMacro(SortIndices(static_cast<VTK_TT *>(dataIn),
+                                           numKeys, 1, 0, idx));
       }
     }
 }
@@ -267,8 +321,8 @@ GenerateSortIndices(int dataType, void *dataIn, vtkIdType numKeys,
     {
     switch (dataType)
       {
-      vtkExtendedTemplateMacro(vtkSMPTools::Sort(idx, idx+numKeys,
-                               TupleComp<VTK_TT>(static_cast<VTK_TT *>(dataIn),numComp,k)));
+      vtkExtendedTemplateMacro(SortIndices(static_cast<VTK_TT *>(dataIn),
+                                           numKeys, numComp, k, idx));
       }
     }
 }
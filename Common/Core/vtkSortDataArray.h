@@ -51,7 +51,9 @@
 // This class has been threaded with vtkSMPTools. Using TBB or other
 // non-sequential type (set in the CMake variable
 // VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly on
-// multi-core machines.
+// multi-core machines. Sorts with an associated key (and the generation of
+// the sort indices) use the parallel radix sort of vtkSMPTools for numeric
+// keys; it is stable, so tuples with equal keys keep their relative order.
 //
 // The sort methods below are static, hence the sorting methods can be
 // used without instantiating the class. All methods are thread safe.
@@ -74,12 +74,25 @@ public:
 
 vtkStandardNewMacro(vtkStringArray);
 
+//-----------------------------------------------------------------------------
+// Read a value without unpacking a packed array.
+static inline vtkStdString vtkStringArrayGetValue(vtkStringArray* array,
+                                                  vtkIdType id)
+{
+  vtkIdType length;
+  const char* value = array->GetValueData(id, length);
+  return vtkStdString(value, static_cast<size_t>(length));
+}
+
 //-----------------------------------------------------------------------------
 
 vtkStringArray::vtkStringArray()
 {
   this->Array = NULL;
   this->SaveUserArray = 0;
+  this->PackedCharacters = NULL;
+  this->PackedOffsets = NULL;
+  this->PackedCodes = NULL;
   this->Lookup = NULL;
 }
 
@@ -91,9 +104,185 @@ vtkStringArray::~vtkStringArray()
     {
     delete [] this->Array;
     }
+  this->ReleasePackedData();
   delete this->Lookup;
 }
 
+//-----------------------------------------------------------------------------
+void vtkStringArray::ReleasePackedData()
+{
+  if (!this->PackedOffsets)
+    {
+    return;
+    }
+  this->PackedCharacters->Delete();
+  this->PackedCharacters = NULL;
+  this->PackedOffsets->Delete();
+  this->PackedOffsets = NULL;
+  if (this->PackedCodes)
+    {
+    this->PackedCodes->Delete();
+    this->PackedCodes = NULL;
+    }
+  // Packed arrays hold no vtkStdString values.
+  this->Size = 0;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkStringArray::GetValueData(vtkIdType id, vtkIdType& length)
+{
+  if (!this->PackedOffsets)
+    {
+    length = static_cast<vtkIdType>(this->Array[id].size());
+    return this->Array[id].c_str();
+    }
+  vtkIdType entry = this->PackedCodes ? this->PackedCodes->GetValue(id) : id;
+  vtkIdType* offsets = this->PackedOffsets->GetPointer(0);
+  length = offsets[entry + 1] - offsets[entry];
+  return this->PackedCharacters->GetPointer(0) + offsets[entry];
+}
+
+//-----------------------------------------------------------------------------
+void vtkStringArray::Pack(int useDictionary)
+{
+  if (this->PackedOffsets)
+    {
+    if (!useDictionary || this->PackedCodes)
+      {
+      return;
+      }
+    this->Unpack();
+    }
+
+  vtkIdType numValues = this->MaxId + 1;
+  vtkCharArray* chars = vtkCharArray::New();
+  vtkIdTypeArray* offsets = vtkIdTypeArray::New();
+  vtkIdTypeArray* codes = NULL;
+  if (useDictionary)
+    {
+    // Number the distinct strings in order of first appearance.
+    codes = vtkIdTypeArray::New();
+    codes->SetNumberOfValues(numValues);
+    std::map<vtkStdString, vtkIdType> entries;
+    std::vector<const vtkStdString*> order;
+    size_t numChars = 0;
+    for (vtkIdType i = 0; i < numValues; ++i)
+      {
+      std::pair<std::map<vtkStdString, vtkIdType>::iterator, bool> entry =
+        entries.insert(std::make_pair(this->Array[i],
+                                      static_cast<vtkIdType>(order.size())));
+      if (entry.second)
+        {
+        order.push_back(&entry.first->first);
+        numChars += this->Array[i].size();
+        }
+      codes->SetValue(i, entry.first->second);
+      }
+    offsets->SetNumberOfValues(static_cast<vtkIdType>(order.size()) + 1);
+    chars->SetNumberOfValues(static_cast<vtkIdType>(numChars));
+    char* c = chars->GetPointer(0);
+    vtkIdType offset = 0;
+    for (size_t k = 0; k < order.size(); ++k)
+      {
+      offsets->SetValue(static_cast<vtkIdType>(k), offset);
+      std::copy(order[k]->begin(), order[k]->end(), c + offset);
+      offset += static_cast<vtkIdType>(order[k]->size());
+      }
+    offsets->SetValue(static_cast<vtkIdType>(order.size()), offset);
+    }
+  else
+    {
+    size_t numChars = 0;
+    for (vtkIdType i = 0; i < numValues; ++i)
+      {
+      numChars += this->Array[i].size();
+      }
+    offsets->SetNumberOfValues(numValues + 1);
+    chars->SetNumberOfValues(static_cast<vtkIdType>(numChars));
+    char* c = chars->GetPointer(0);
+    vtkIdType offset = 0;
+    for (vtkIdType i = 0; i < numValues; ++i)
+      {
+      offsets->SetValue(i, offset);
+      std::copy(this->Array[i].begin(), this->Array[i].end(), c + offset);
+      offset += static_cast<vtkIdType>(this->Array[i].size());
+      }
+    offsets->SetValue(numValues, offset);
+    }
+
+  this->SetPackedData(chars, offsets, codes);
+  chars->Delete();
+  offsets->Delete();
+  if (codes)
+    {
+    codes->Delete();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkStringArray::Unpack()
+{
+  if (!this->PackedOffsets)
+    {
+    return;
+    }
+  vtkIdType numValues = this->MaxId + 1;
+  vtkStdString* array = new vtkStdString[numValues > 0 ? numValues : 1];
+  for (vtkIdType i = 0; i < numValues; ++i)
+    {
+    vtkIdType length;
+    const char* value = this->GetValueData(i, length);
+    array[i].assign(value, static_cast<size_t>(length));
+    }
+  this->ReleasePackedData();
+  this->Array = array;
+  this->Size = numValues > 0 ? numValues : 1;
+  this->SaveUserArray = 0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkStringArray::SetPackedData(vtkCharArray* chars,
+                                   vtkIdTypeArray* offsets,
+                                   vtkIdTypeArray* codes)
+{
+  if (!chars || !offsets || offsets->GetMaxId() < 0)
+    {
+    vtkErrorMacro("Packed data needs characters and at least one offset.");
+    return;
+    }
+
+  // Reference the new arrays first, they may be our current ones.
+  chars->Register(this);
+  offsets->Register(this);
+  if (codes)
+    {
+    codes->Register(this);
+    }
+  this->ReleasePackedData();
+  if (!this->SaveUserArray)
+    {
+    delete [] this->Array;
+    }
+  this->Array = NULL;
+  this->SaveUserArray = 0;
+
+  this->PackedCharacters = chars;
+  this->PackedOffsets = offsets;
+  this->PackedCodes = codes;
+  this->Size = codes ? codes->GetMaxId() + 1 :
+    offsets->GetMaxId();
+  this->MaxId = this->Size - 1;
+  this->DataChanged();
+}
+
+//-----------------------------------------------------------------------------
+vtkVariant vtkStringArray::GetVariantValue(vtkIdType id)
+{
+  vtkIdType length;
+  const char* value = this->GetValueData(id, length);
+  return vtkVariant(vtkStdString(value, static_cast<size_t>(length)));
+}
+
 //-----------------------------------------------------------------------------
 vtkArrayIterator* vtkStringArray::NewIterator()
 {
@@ -113,6 +302,7 @@ vtkArrayIterator* vtkStringArray::NewIterator()
 
 void vtkStringArray::SetArray(vtkStdString *array, vtkIdType size, int save)
 {
+  this->ReleasePackedData();
   if ((this->Array) && (!this->SaveUserArray))
     {
     vtkDebugMacro (<< "Deleting the array...");
@@ -137,6 +327,8 @@ void vtkStringArray::SetArray(vtkStdString *array, vtkIdType size, int save)
 
 int vtkStringArray::Allocate(vtkIdType sz, vtkIdType)
 {
+  // The previous values need not be kept.
+  this->ReleasePackedData();
   if(sz > this->Size)
     {
     if(!this->SaveUserArray)
@@ -164,6 +356,7 @@ int vtkStringArray::Allocate(vtkIdType sz, vtkIdType)
 
 void vtkStringArray::Initialize()
 {
+  this->ReleasePackedData();
   if(!this->SaveUserArray)
     {
     delete [] this->Array;
@@ -209,10 +402,36 @@ void vtkStringArray::DeepCopy(vtkAbstractArray* aa)
     }
 
   // Free our previous memory.
+  this->ReleasePackedData();
   if(!this->SaveUserArray)
     {
     delete [] this->Array;
     }
+  this->Array = NULL;
+  this->SaveUserArray = 0;
+
+  // Packed arrays are copied in packed form.
+  if (fa->PackedOffsets)
+    {
+    vtkCharArray* chars = vtkCharArray::New();
+    chars->DeepCopy(fa->PackedCharacters);
+    vtkIdTypeArray* offsets = vtkIdTypeArray::New();
+    offsets->DeepCopy(fa->PackedOffsets);
+    vtkIdTypeArray* codes = NULL;
+    if (fa->PackedCodes)
+      {
+      codes = vtkIdTypeArray::New();
+      codes->DeepCopy(fa->PackedCodes);
+      }
+    this->SetPackedData(chars, offsets, codes);
+    chars->Delete();
+    offsets->Delete();
+    if (codes)
+      {
+      codes->Delete();
+      }
+    return;
+    }
 
   // Copy the given array into new memory.
   this->MaxId = fa->GetMaxId();
@@ -297,7 +516,18 @@ void vtkStringArray::InterpolateTuple(vtkIdType i, vtkIdType id1,
 void vtkStringArray::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
-  if(this->Array)
+  os << indent << "StorageMode: "
+     << (this->PackedOffsets ? "PACKED_STORAGE" : "STRING_STORAGE") << "\n";
+  if (this->PackedOffsets)
+    {
+    os << indent << "PackedCharacters: "
+       << this->PackedCharacters->GetMaxId() + 1 << " characters\n";
+    os << indent << "PackedOffsets: "
+       << this->PackedOffsets->GetMaxId() << " strings\n";
+    os << indent << "PackedCodes: "
+       << (this->PackedCodes ? "on" : "off") << "\n";
+    }
+  else if(this->Array)
     {
     os << indent << "Array: " << this->Array << "\n";
     }
@@ -315,6 +545,8 @@ vtkStdString * vtkStringArray::ResizeAndExtend(vtkIdType sz)
   vtkStdString * newArray;
   vtkIdType newSize;
 
+  this->EnsureUnpacked();
+
   if(sz > this->Size)
     {
     // Requested size is bigger than current size.  Allocate enough
@@ -379,6 +611,8 @@ int vtkStringArray::Resize(vtkIdType sz)
   vtkStdString * newArray;
   vtkIdType newSize = sz;
 
+  this->EnsureUnpacked();
+
   if(newSize == this->Size)
     {
     return 1;
@@ -427,6 +661,8 @@ int vtkStringArray::Resize(vtkIdType sz)
 //-----------------------------------------------------------------------------
 void vtkStringArray::SetNumberOfValues(vtkIdType number)
 {
+  // Keep the current values, as Allocate does for unpacked arrays.
+  this->EnsureUnpacked();
   this->Allocate(number);
   this->MaxId = number - 1;
   this->DataChanged();
@@ -436,6 +672,7 @@ void vtkStringArray::SetNumberOfValues(vtkIdType number)
 vtkStdString * vtkStringArray::WritePointer(vtkIdType id,
                                      vtkIdType number)
 {
+  this->EnsureUnpacked();
   vtkIdType newSize=id+number;
   if ( newSize > this->Size )
     {
@@ -452,6 +689,7 @@ vtkStdString * vtkStringArray::WritePointer(vtkIdType id,
 //-----------------------------------------------------------------------------
 void vtkStringArray::InsertValue(vtkIdType id, vtkStdString f)
 {
+  this->EnsureUnpacked();
   if ( id >= this->Size )
     {
     if (!this->ResizeAndExtend(id+1))
@@ -470,6 +708,7 @@ void vtkStringArray::InsertValue(vtkIdType id, vtkStdString f)
 //-----------------------------------------------------------------------------
 vtkIdType vtkStringArray::InsertNextValue(vtkStdString f)
 {
+  this->EnsureUnpacked();
   this->InsertValue (++this->MaxId,f);
   this->DataElementChanged(this->MaxId);
   return this->MaxId;
@@ -484,6 +723,17 @@ int vtkStringArray::GetDataTypeSize( void )
 // ----------------------------------------------------------------------------
 unsigned long vtkStringArray::GetActualMemorySize( void )
 {
+  if (this->PackedOffsets)
+    {
+    unsigned long packedSize = this->PackedCharacters->GetActualMemorySize() +
+      this->PackedOffsets->GetActualMemorySize();
+    if (this->PackedCodes)
+      {
+      packedSize += this->PackedCodes->GetActualMemorySize();
+      }
+    return packedSize;
+    }
+
   size_t totalSize = 0;
   size_t  numPrims = static_cast<size_t>(this->GetSize());
 
@@ -504,7 +754,9 @@ vtkIdType vtkStringArray::GetDataSize()
   size_t numStrs = static_cast<size_t>(this->GetMaxId() + 1);
   for(size_t i=0; i < numStrs; i++)
     {
-    size += this->Array[i].size() + 1;
+    vtkIdType length;
+    this->GetValueData(static_cast<vtkIdType>(i), length);
+    size += static_cast<size_t>(length) + 1;
     // (+1) for termination character.
     }
   return static_cast<vtkIdType>(size);
@@ -529,7 +781,7 @@ void vtkStringArray::SetTuple(vtkIdType i, vtkIdType j,
   vtkIdType locj = j * sa->GetNumberOfComponents();
   for (vtkIdType cur = 0; cur < this->NumberOfComponents; cur++)
     {
-    this->SetValue(loci + cur, sa->GetValue(locj + cur));
+    this->SetValue(loci + cur, vtkStringArrayGetValue(sa, locj + cur));
     }
   this->DataChanged();
 }
@@ -551,7 +803,7 @@ void vtkStringArray::InsertTuple(vtkIdType i, vtkIdType j,
   vtkIdType locj = j * sa->GetNumberOfComponents();
   for (vtkIdType cur = 0; cur < this->NumberOfComponents; cur++)
     {
-    this->InsertValue(loci + cur, sa->GetValue(locj + cur));
+    this->InsertValue(loci + cur, vtkStringArrayGetValue(sa, locj + cur));
     }
   this->DataChanged();
 }
@@ -587,7 +839,7 @@ void vtkStringArray::InsertTuples(vtkIdList *dstIds, vtkIdList *srcIds,
     vtkIdType dstLoc = dstIds->GetId(idIndex) * this->NumberOfComponents;
     while (numComp-- > 0)
       {
-      this->InsertValue(dstLoc++, sa->GetValue(srcLoc++));
+      this->InsertValue(dstLoc++, vtkStringArrayGetValue(sa, srcLoc++));
       }
     }
 
@@ -627,7 +879,7 @@ void vtkStringArray::InsertTuples(vtkIdType dstStart, vtkIdType n,
     vtkIdType dstLoc = (dstStart + i) * this->NumberOfComponents;
     while (numComp-- > 0)
       {
-      this->InsertValue(dstLoc++, sa->GetValue(srcLoc++));
+      this->InsertValue(dstLoc++, vtkStringArrayGetValue(sa, srcLoc++));
       }
     }
 
@@ -651,7 +903,7 @@ vtkIdType vtkStringArray::InsertNextTuple(vtkIdType j,
   vtkIdType locj = j * sa->GetNumberOfComponents();
   for (vtkIdType cur = 0; cur < this->NumberOfComponents; cur++)
     {
-    this->InsertNextValue(sa->GetValue(locj + cur));
+    this->InsertNextValue(vtkStringArrayGetValue(sa, locj + cur));
     }
   this->DataChanged();
   return (this->GetNumberOfTuples()-1);
@@ -660,6 +912,7 @@ vtkIdType vtkStringArray::InsertNextTuple(vtkIdType j,
 // ----------------------------------------------------------------------------
 vtkStdString& vtkStringArray::GetValue( vtkIdType id )
 {
+  this->EnsureUnpacked();
   return this->Array[id];
 }
 
@@ -684,7 +937,7 @@ void vtkStringArray::GetTuples(vtkIdList *indices, vtkAbstractArray *aa)
   for (vtkIdType i = 0; i < indices->GetNumberOfIds(); ++i)
     {
     vtkIdType index = indices->GetId(i);
-    output->SetValue(i, this->GetValue(index));
+    output->SetValue(i, vtkStringArrayGetValue(this, index));
     }
 }
 
@@ -711,7 +964,7 @@ void vtkStringArray::GetTuples(vtkIdType startIndex,
   for (vtkIdType i = 0; i < (endIndex - startIndex) + 1; ++i)
     {
     vtkIdType index = startIndex + i;
-    output->SetValue(i, this->GetValue(index));
+    output->SetValue(i, vtkStringArrayGetValue(this, index));
     }
 }
 
@@ -735,7 +988,8 @@ void vtkStringArray::UpdateLookup()
     std::vector<std::pair<vtkStdString, vtkIdType> > v;
     for (vtkIdType i = 0; i < numComps*numTuples; i++)
       {
-      v.push_back(std::pair<vtkStdString, vtkIdType>(this->Array[i], i));
+      v.push_back(std::pair<vtkStdString, vtkIdType>(
+                    vtkStringArrayGetValue(this, i), i));
       }
     std::sort(v.begin(), v.end());
     for (vtkIdType i = 0; i < numComps*numTuples; i++)
@@ -780,7 +1034,7 @@ vtkIdType vtkStringArray::LookupValue(vtkStdString value)
     if (value == cached->first)
       {
       // Check that the value in the original array hasn't changed.
-      vtkStdString currentValue = this->GetValue(cached->second);
+      vtkStdString currentValue = vtkStringArrayGetValue(this, cached->second);
       if (value == currentValue)
         {
         return cached->second;
@@ -812,7 +1066,7 @@ vtkIdType vtkStringArray::LookupValue(vtkStdString value)
       {
       // Check that the value in the original array hasn't changed.
       vtkIdType index = this->Lookup->IndexArray->GetId(offset);
-      vtkStdString currentValue = this->GetValue(index);
+      vtkStdString currentValue = vtkStringArrayGetValue(this, index);
       if (value == currentValue)
         {
         return index;
@@ -847,7 +1101,8 @@ void vtkStringArray::LookupValue(vtkStdString value, vtkIdList* ids)
   while (cached.first != cached.second)
     {
     // Check that the value in the original array hasn't changed.
-    vtkStdString currentValue = this->GetValue(cached.first->second);
+    vtkStdString currentValue =
+      vtkStringArrayGetValue(this, cached.first->second);
     if (cached.first->first == currentValue)
       {
       ids->InsertNextId(cached.first->second);
@@ -869,7 +1124,7 @@ void vtkStringArray::LookupValue(vtkStdString value, vtkIdList* ids)
     {
     // Check that the value in the original array hasn't changed.
     vtkIdType index = this->Lookup->IndexArray->GetId(offset);
-    vtkStdString currentValue = this->GetValue(index);
+    vtkStdString currentValue = vtkStringArrayGetValue(this, index);
     if (*found.first == currentValue)
       {
       ids->InsertNextId(index);
@@ -910,7 +1165,7 @@ void vtkStringArray::DataElementChanged(vtkIdType id)
         {
         // Insert this change into the set of cached updates
         std::pair<const vtkStdString, vtkIdType>
-          value(this->GetValue(id), id);
+          value(vtkStringArrayGetValue(this, id), id);
         this->Lookup->CachedUpdates.insert(value);
         }
     }
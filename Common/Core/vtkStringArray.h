@@ -18,6 +18,17 @@
 // Points and cells may sometimes have associated data that are stored
 // as strings, e.g. labels for information visualization projects.
 // This class provides a clean way to store and access those strings.
+//
+// By default each value is held in its own vtkStdString.  Large arrays
+// of short strings may instead be packed (see Pack() and
+// SetPackedData()): the characters of all the strings are stored back to
+// back in one vtkCharArray, delimited by a vtkIdTypeArray of offsets, and
+// the strings may optionally be dictionary encoded so that each distinct
+// string is stored only once.  Methods that only read values, such as
+// GetValueData(), GetVariantValue(), LookupValue() and the tuple copying
+// methods used by filters, work on packed arrays directly.  Methods that
+// return references to vtkStdString values or modify the array unpack it
+// first.
 // .SECTION Thanks
 // Andy Wilson (atwilso@sandia.gov) wrote this class.
 
@@ -28,6 +39,8 @@
 #include "vtkAbstractArray.h"
 #include "vtkStdString.h" // needed for vtkStdString definition
 
+class vtkCharArray;
+class vtkIdTypeArray;
 class vtkStringArrayLookup;
 
 class VTKCOMMONCORE_EXPORT vtkStringArray : public vtkAbstractArray
@@ -64,7 +77,8 @@ public:
   // Description:
   // Free any unnecessary memory.
   // Resize object to just fit data requirement. Reclaims extra memory.
-  void Squeeze() { this->ResizeAndExtend (this->MaxId+1); }
+  void Squeeze()
+    { this->EnsureUnpacked(); this->ResizeAndExtend (this->MaxId+1); }
 
   // Description:
   // Resize the array while conserving the data.
@@ -151,7 +165,7 @@ public:
   // Set the data at a particular index. Does not do range checking. Make sure
   // you use the method SetNumberOfValues() before inserting data.
   void SetValue(vtkIdType id, vtkStdString value)
-    { this->Array[id] = value; this->DataChanged(); }
+    { this->EnsureUnpacked(); this->Array[id] = value; this->DataChanged(); }
 //ETX
   void SetValue(vtkIdType id, const char *value);
 
@@ -179,6 +193,10 @@ public:
 //ETX
   void InsertValue(vtkIdType id, const char *val);
 
+  // Description:
+  // Get a value as a variant.  This does not unpack the array.
+  virtual vtkVariant GetVariantValue(vtkIdType idx);
+
   // Description:
   // Set a value in the array form a variant.
   // Insert a value into the array from a variant.
@@ -208,10 +226,58 @@ public:
   // Description:
   // Get the address of a particular data index. Performs no checks
   // to verify that the memory has been allocated etc.
-  vtkStdString* GetPointer(vtkIdType id) { return this->Array + id; }
+  vtkStdString* GetPointer(vtkIdType id)
+    { this->EnsureUnpacked(); return this->Array + id; }
   void* GetVoidPointer(vtkIdType id) { return this->GetPointer(id); }
 //ETX
 
+  // Description:
+  // Get the characters of the value at a particular index, and their
+  // number.  The characters are not null terminated in packed arrays.
+  // This works in both storage modes and does not unpack the array.
+  const char* GetValueData(vtkIdType id, vtkIdType& length);
+
+  // Description:
+  // Storage modes.  STRING_STORAGE (the default) holds one vtkStdString
+  // per value.  PACKED_STORAGE holds the characters of all the values in
+  // one buffer delimited by offsets, optionally dictionary encoded.
+  enum StorageModes
+  {
+    STRING_STORAGE = 0,
+    PACKED_STORAGE = 1
+  };
+  int GetStorageMode()
+    { return this->PackedOffsets ? PACKED_STORAGE : STRING_STORAGE; }
+
+  // Description:
+  // Convert the array to packed storage.  When useDictionary is on, each
+  // distinct string is stored once and the values refer to it through
+  // the codes array, numbered in order of first appearance.
+  void Pack(int useDictionary = 0);
+
+  // Description:
+  // Convert the array back to one vtkStdString per value.
+  void Unpack();
+
+  // Description:
+  // Use packed data directly, without copying it.  Entry k of the packed
+  // strings holds the characters in [offsets[k], offsets[k+1]) of
+  // chars, so offsets has one more value than there are entries.  If
+  // codes is NULL value i is entry i, otherwise value i is entry
+  // codes[i].  The arrays are shared with the caller, so modifying them
+  // afterwards modifies the values of this array.
+  void SetPackedData(vtkCharArray* chars, vtkIdTypeArray* offsets,
+                     vtkIdTypeArray* codes = 0);
+
+  // Description:
+  // Access the packed data, or NULL when the array is not packed (or
+  // not dictionary encoded, for the codes).  These are regular data
+  // arrays, so they can be handed to other tools, e.g. as numpy arrays
+  // in Python, without copying the strings.
+  vtkCharArray* GetPackedCharacters() { return this->PackedCharacters; }
+  vtkIdTypeArray* GetPackedOffsets() { return this->PackedOffsets; }
+  vtkIdTypeArray* GetPackedCodes() { return this->PackedCodes; }
+
   // Description:
   // Deep copy of another string array.  Will complain and change nothing
   // if the array passed in is not a vtkStringArray.
@@ -299,6 +365,20 @@ protected:
 
   int SaveUserArray;
 
+  // Packed storage, all NULL when the array holds vtkStdString values.
+  vtkCharArray* PackedCharacters;
+  vtkIdTypeArray* PackedOffsets;
+  vtkIdTypeArray* PackedCodes;
+
+  void EnsureUnpacked()
+    {
+    if (this->PackedOffsets)
+      {
+      this->Unpack();
+      }
+    }
+  void ReleasePackedData();
+
 private:
   vtkStringArray(const vtkStringArray&);  // Not implemented.
   void operator=(const vtkStringArray&);  // Not implemented.
@@ -0,0 +1,181 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStructuredPointArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStructuredPointArray - Read only array of the point coordinates
+// of a structured grid, computed on access.
+//
+// .SECTION Description
+// vtkStructuredPointArray holds the 3-component coordinates of the points of
+// a nx*ny*nz lattice aligned with the axes, such as the points of a
+// vtkImageData or a vtkRectilinearGrid, without storing them. Only the
+// coordinates along each axis are kept: for point i + nx*(j + ny*k) the
+// coordinates are (X[i], Y[j], Z[k]). A 2048^3 lattice of double
+// coordinates takes 200 GB when made explicit, and 48 KB with this array.
+// The range of each component, hence the bounds of vtkPoints using this
+// array, is computed from the axes.
+//
+// The axes are set with SetUniformAxes() or SetAxes(); the array is read
+// only otherwise. NewInstance() returns a regular array of the same type,
+// so filters that create output arrays from this one are not affected.
+// GetVoidPointer() makes an explicit copy of the coordinates, losing the
+// savings: code that needs raw pointers should check
+// HasStandardMemoryLayout() first.
+//
+// .SECTION Caveats
+// GetTuple(vtkIdType, double*), GetTupleValue() and GetValue() may be called
+// from several threads at the same time. The pointer returned by
+// GetTuple(vtkIdType) and the reference returned by GetValueReference() are
+// shared, and only valid until the next call.
+
+#ifndef vtkStructuredPointArray_h
+#define vtkStructuredPointArray_h
+
+#include "vtkMappedDataArray.h"
+
+#include "vtkTypeTemplate.h" // For templated vtkObject API
+#include "vtkObjectFactory.h" // for vtkStandardNewMacro
+
+#include <vector> // For axes storage
+
+template <class Scalar>
+class vtkStructuredPointArray:
+    public vtkTypeTemplate<vtkStructuredPointArray<Scalar>,
+                           vtkMappedDataArray<Scalar> >
+{
+public:
+  vtkMappedDataArrayNewInstanceMacro(vtkStructuredPointArray<Scalar>)
+  static vtkStructuredPointArray *New();
+  virtual void PrintSelf(ostream &os, vtkIndent indent);
+
+  // Description:
+  // Set the axes of a lattice of the given dimensions, whose point (i,j,k)
+  // is origin + (i,j,k) * spacing, as the points of a vtkImageData.
+  void SetUniformAxes(const int dims[3], const double origin[3],
+                      const double spacing[3]);
+
+  // Description:
+  // Set the axes of the lattice from the coordinates along each one, as
+  // the points of a vtkRectilinearGrid. The first component of each array
+  // is used. The dimensions are the number of tuples of the arrays.
+  void SetAxes(vtkDataArray *x, vtkDataArray *y, vtkDataArray *z);
+
+  // Description:
+  // Return the dimensions of the lattice, and the coordinates along the
+  // given axis (0, 1 or 2), of size GetDimensions()[axis].
+  const int *GetDimensions() { return this->Dimensions; }
+  const Scalar *GetAxis(int axis);
+
+  // Description:
+  // Return the memory in kibibytes used by the axes.
+  unsigned long GetActualMemorySize();
+
+  // Reimplemented virtuals -- see superclasses for descriptions:
+  void Initialize();
+  void GetTuples(vtkIdList *ptIds, vtkAbstractArray *output);
+  void GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *output);
+  void Squeeze();
+  vtkArrayIterator *NewIterator();
+  vtkIdType LookupValue(vtkVariant value);
+  void LookupValue(vtkVariant value, vtkIdList *ids);
+  vtkVariant GetVariantValue(vtkIdType idx);
+  void ClearLookup();
+  double* GetTuple(vtkIdType i);
+  void GetTuple(vtkIdType i, double *tuple);
+  vtkIdType LookupTypedValue(Scalar value);
+  void LookupTypedValue(Scalar value, vtkIdList *ids);
+  Scalar GetValue(vtkIdType idx);
+  Scalar& GetValueReference(vtkIdType idx);
+  void GetTupleValue(vtkIdType idx, Scalar *t);
+
+  // Description:
+  // Copy the axes of another vtkStructuredPointArray of the same type.
+  // Other arrays cannot be copied.
+  void DeepCopy(vtkAbstractArray *aa);
+  void DeepCopy(vtkDataArray *da);
+
+  // Description:
+  // This container is read only -- this method does nothing but print a
+  // warning.
+  int Allocate(vtkIdType sz, vtkIdType ext);
+  int Resize(vtkIdType numTuples);
+  void SetNumberOfTuples(vtkIdType number);
+  void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source);
+  void SetTuple(vtkIdType i, const float *source);
+  void SetTuple(vtkIdType i, const double *source);
+  void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source);
+  void InsertTuple(vtkIdType i, const float *source);
+  void InsertTuple(vtkIdType i, const double *source);
+  void InsertTuples(vtkIdList *dstIds, vtkIdList *srcIds,
+                    vtkAbstractArray *source);
+  void InsertTuples(vtkIdType dstStart, vtkIdType n, vtkIdType srcStart,
+                    vtkAbstractArray* source);
+  vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray *source);
+  vtkIdType InsertNextTuple(const float *source);
+  vtkIdType InsertNextTuple(const double *source);
+  void InterpolateTuple(vtkIdType i, vtkIdList *ptIndices,
+                        vtkAbstractArray* source,  double* weights);
+  void InterpolateTuple(vtkIdType i, vtkIdType id1, vtkAbstractArray *source1,
+                        vtkIdType id2, vtkAbstractArray *source2, double t);
+  void SetVariantValue(vtkIdType idx, vtkVariant value);
+  void InsertVariantValue(vtkIdType idx, vtkVariant value);
+  void RemoveTuple(vtkIdType id);
+  void RemoveFirstTuple();
+  void RemoveLastTuple();
+  void SetTupleValue(vtkIdType i, const Scalar *t);
+  void InsertTupleValue(vtkIdType i, const Scalar *t);
+  vtkIdType InsertNextTupleValue(const Scalar *t);
+  void SetValue(vtkIdType idx, Scalar value);
+  vtkIdType InsertNextValue(Scalar v);
+  void InsertValue(vtkIdType idx, Scalar v);
+
+protected:
+  vtkStructuredPointArray();
+  ~vtkStructuredPointArray();
+
+  // Description:
+  // The range of each component is the range of its axis.
+  bool ComputeScalarRange(double *ranges);
+  bool ComputeFiniteScalarRange(double *ranges);
+
+  int Dimensions[3];
+  std::vector<Scalar> Axes[3];
+
+  // Update the array after the axes are set.
+  void AxesModified();
+
+  // Return the index along each axis of the given tuple.
+  void GetIndices(vtkIdType tupleId, vtkIdType ijk[3])
+  {
+    const vtkIdType nx = this->Dimensions[0];
+    const vtkIdType ny = this->Dimensions[1];
+    ijk[0] = tupleId % nx;
+    ijk[1] = (tupleId / nx) % ny;
+    ijk[2] = tupleId / (nx * ny);
+  }
+
+private:
+  vtkStructuredPointArray(const vtkStructuredPointArray &); // Not implemented.
+  void operator=(const vtkStructuredPointArray &); // Not implemented.
+
+  bool ComputeAxesRange(double *ranges, bool finite);
+  vtkIdType Lookup(const Scalar &val, vtkIdType startIndex);
+  double TempDoubleArray[3];
+  Scalar TempValue;
+};
+
+#include "vtkStructuredPointArray.txx"
+
+#endif //vtkStructuredPointArray_h
+
+// VTK-HeaderTest-Exclude: vtkStructuredPointArray.h
@@ -0,0 +1,646 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStructuredPointArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkStructuredPointArray.h"
+
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkVariant.h"
+#include "vtkVariantCast.h"
+
+#include <algorithm>
+
+//------------------------------------------------------------------------------
+// Can't use vtkStandardNewMacro on a templated class.
+template <class Scalar> vtkStructuredPointArray<Scalar> *
+vtkStructuredPointArray<Scalar>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkStructuredPointArray<Scalar>)
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->vtkStructuredPointArray<Scalar>::Superclass::PrintSelf(os, indent);
+
+  os << indent << "Dimensions: (" << this->Dimensions[0] << ", "
+     << this->Dimensions[1] << ", " << this->Dimensions[2] << ")\n";
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::SetUniformAxes(const int dims[3], const double origin[3],
+                 const double spacing[3])
+{
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    this->Dimensions[axis] = std::max(dims[axis], 0);
+    this->Axes[axis].resize(this->Dimensions[axis]);
+    for (int i = 0; i < this->Dimensions[axis]; ++i)
+      {
+      this->Axes[axis][i] =
+        static_cast<Scalar>(origin[axis] + i * spacing[axis]);
+      }
+    }
+  this->AxesModified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::SetAxes(vtkDataArray *x, vtkDataArray *y, vtkDataArray *z)
+{
+  vtkDataArray *coords[3] = { x, y, z };
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    const vtkIdType size = coords[axis] ? coords[axis]->GetNumberOfTuples() : 0;
+    this->Dimensions[axis] = static_cast<int>(size);
+    this->Axes[axis].resize(size);
+    for (vtkIdType i = 0; i < size; ++i)
+      {
+      this->Axes[axis][i] =
+        static_cast<Scalar>(coords[axis]->GetComponent(i, 0));
+      }
+    }
+  this->AxesModified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>::AxesModified()
+{
+  const vtkIdType numTuples = static_cast<vtkIdType>(this->Dimensions[0]) *
+    this->Dimensions[1] * this->Dimensions[2];
+  if (numTuples == 0)
+    {
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      this->Dimensions[axis] = 0;
+      this->Axes[axis].clear();
+      }
+    }
+  this->NumberOfComponents = 3;
+  this->Size = 3 * numTuples;
+  this->MaxId = this->Size - 1;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> const Scalar *vtkStructuredPointArray<Scalar>
+::GetAxis(int axis)
+{
+  if (axis < 0 || axis > 2 || this->Axes[axis].empty())
+    {
+    return NULL;
+    }
+  return &this->Axes[axis][0];
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> unsigned long vtkStructuredPointArray<Scalar>
+::GetActualMemorySize()
+{
+  size_t size = 0;
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    size += this->Axes[axis].capacity() * sizeof(Scalar);
+    }
+  return static_cast<unsigned long>(size / 1024 + 1);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> bool vtkStructuredPointArray<Scalar>
+::ComputeScalarRange(double *ranges)
+{
+  return this->ComputeAxesRange(ranges, false);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> bool vtkStructuredPointArray<Scalar>
+::ComputeFiniteScalarRange(double *ranges)
+{
+  return this->ComputeAxesRange(ranges, true);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> bool vtkStructuredPointArray<Scalar>
+::ComputeAxesRange(double *ranges, bool finite)
+{
+  bool computed = true;
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    ranges[2 * axis] = VTK_DOUBLE_MAX;
+    ranges[2 * axis + 1] = VTK_DOUBLE_MIN;
+    for (size_t i = 0; i < this->Axes[axis].size(); ++i)
+      {
+      const double value = static_cast<double>(this->Axes[axis][i]);
+      if (!finite || vtkMath::IsFinite(value))
+        {
+        ranges[2 * axis] = std::min(ranges[2 * axis], value);
+        ranges[2 * axis + 1] = std::max(ranges[2 * axis + 1], value);
+        }
+      }
+    computed = computed && ranges[2 * axis] <= ranges[2 * axis + 1];
+    }
+  return computed;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::Initialize()
+{
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    this->Dimensions[axis] = 0;
+    this->Axes[axis].clear();
+    }
+
+  this->MaxId = -1;
+  this->Size = 0;
+  this->NumberOfComponents = 3;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::GetTuples(vtkIdList *ptIds, vtkAbstractArray *output)
+{
+  vtkDataArray *da = vtkDataArray::FastDownCast(output);
+  if (!da)
+    {
+    vtkWarningMacro(<<"Input is not a vtkDataArray");
+    return;
+    }
+
+  if (da->GetNumberOfComponents() != this->GetNumberOfComponents())
+    {
+    vtkWarningMacro(<<"Incorrect number of components in input array.");
+    return;
+    }
+
+  double tuple[3];
+  const vtkIdType numPoints = ptIds->GetNumberOfIds();
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    this->GetTuple(ptIds->GetId(i), tuple);
+    da->SetTuple(i, tuple);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *output)
+{
+  vtkDataArray *da = vtkDataArray::FastDownCast(output);
+  if (!da)
+    {
+    vtkErrorMacro(<<"Input is not a vtkDataArray");
+    return;
+    }
+
+  if (da->GetNumberOfComponents() != this->GetNumberOfComponents())
+    {
+    vtkErrorMacro(<<"Incorrect number of components in input array.");
+    return;
+    }
+
+  double tuple[3];
+  for (vtkIdType daTupleId = 0; p1 <= p2; ++p1)
+    {
+    this->GetTuple(p1, tuple);
+    da->SetTuple(daTupleId++, tuple);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::Squeeze()
+{
+  // no-op, the axes are as small as they get.
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkArrayIterator*
+vtkStructuredPointArray<Scalar>::NewIterator()
+{
+  vtkErrorMacro(<<"Not implemented.");
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStructuredPointArray<Scalar>
+::LookupValue(vtkVariant value)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  if (valid)
+    {
+    return this->Lookup(val, 0);
+    }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::LookupValue(vtkVariant value, vtkIdList *ids)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  ids->Reset();
+  if (valid)
+    {
+    vtkIdType index = 0;
+    while ((index = this->Lookup(val, index)) >= 0)
+      {
+      ids->InsertNextId(index);
+      ++index;
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkVariant vtkStructuredPointArray<Scalar>
+::GetVariantValue(vtkIdType idx)
+{
+  return vtkVariant(this->GetValue(idx));
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::ClearLookup()
+{
+  // no-op, no fast lookup implemented.
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> double* vtkStructuredPointArray<Scalar>
+::GetTuple(vtkIdType i)
+{
+  this->GetTuple(i, this->TempDoubleArray);
+  return this->TempDoubleArray;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::GetTuple(vtkIdType i, double *tuple)
+{
+  vtkIdType ijk[3];
+  this->GetIndices(i, ijk);
+  tuple[0] = static_cast<double>(this->Axes[0][ijk[0]]);
+  tuple[1] = static_cast<double>(this->Axes[1][ijk[1]]);
+  tuple[2] = static_cast<double>(this->Axes[2][ijk[2]]);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStructuredPointArray<Scalar>
+::LookupTypedValue(Scalar value)
+{
+  return this->Lookup(value, 0);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::LookupTypedValue(Scalar value, vtkIdList *ids)
+{
+  ids->Reset();
+  vtkIdType index = 0;
+  while ((index = this->Lookup(value, index)) >= 0)
+    {
+    ids->InsertNextId(index);
+    ++index;
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar vtkStructuredPointArray<Scalar>
+::GetValue(vtkIdType idx)
+{
+  vtkIdType ijk[3];
+  const int comp = static_cast<int>(idx % 3);
+  this->GetIndices(idx / 3, ijk);
+  return this->Axes[comp][ijk[comp]];
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar& vtkStructuredPointArray<Scalar>
+::GetValueReference(vtkIdType idx)
+{
+  this->TempValue = this->GetValue(idx);
+  return this->TempValue;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::GetTupleValue(vtkIdType tupleId, Scalar *tuple)
+{
+  vtkIdType ijk[3];
+  this->GetIndices(tupleId, ijk);
+  tuple[0] = this->Axes[0][ijk[0]];
+  tuple[1] = this->Axes[1][ijk[1]];
+  tuple[2] = this->Axes[2][ijk[2]];
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::DeepCopy(vtkAbstractArray *aa)
+{
+  if (aa == this)
+    {
+    return;
+    }
+  vtkDataArray *da = vtkDataArray::FastDownCast(aa);
+  if (!da)
+    {
+    vtkErrorMacro(<<"Input is not a vtkDataArray");
+    return;
+    }
+  this->DeepCopy(da);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::DeepCopy(vtkDataArray *da)
+{
+  if (da == this)
+    {
+    return;
+    }
+  vtkStructuredPointArray<Scalar> *other =
+    vtkStructuredPointArray<Scalar>::SafeDownCast(da);
+  if (!other)
+    {
+    vtkErrorMacro(<<"Read only container, cannot copy a "
+                  << (da ? da->GetClassName() : "NULL array"));
+    return;
+    }
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    this->Dimensions[axis] = other->Dimensions[axis];
+    this->Axes[axis] = other->Axes[axis];
+    }
+  this->SetName(other->GetName());
+  this->AxesModified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> int vtkStructuredPointArray<Scalar>
+::Allocate(vtkIdType, vtkIdType)
+{
+  vtkErrorMacro("Read only container.")
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> int vtkStructuredPointArray<Scalar>
+::Resize(vtkIdType)
+{
+  vtkErrorMacro("Read only container.")
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::SetNumberOfTuples(vtkIdType)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::SetTuple(vtkIdType, vtkIdType, vtkAbstractArray *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::SetTuple(vtkIdType, const float *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::SetTuple(vtkIdType, const double *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::InsertTuple(vtkIdType, vtkIdType, vtkAbstractArray *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::InsertTuple(vtkIdType, const float *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::InsertTuple(vtkIdType, const double *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::InsertTuples(vtkIdList *, vtkIdList *, vtkAbstractArray *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::InsertTuples(vtkIdType, vtkIdType, vtkIdType, vtkAbstractArray *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStructuredPointArray<Scalar>
+::InsertNextTuple(vtkIdType, vtkAbstractArray *)
+{
+  vtkErrorMacro("Read only container.")
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStructuredPointArray<Scalar>
+::InsertNextTuple(const float *)
+{
+  vtkErrorMacro("Read only container.")
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStructuredPointArray<Scalar>
+::InsertNextTuple(const double *)
+{
+  vtkErrorMacro("Read only container.")
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::InterpolateTuple(vtkIdType, vtkIdList *, vtkAbstractArray *, double *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::InterpolateTuple(vtkIdType, vtkIdType, vtkAbstractArray*, vtkIdType,
+                   vtkAbstractArray*, double)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::SetVariantValue(vtkIdType, vtkVariant)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::InsertVariantValue(vtkIdType, vtkVariant)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::RemoveTuple(vtkIdType)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::RemoveFirstTuple()
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::RemoveLastTuple()
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::SetTupleValue(vtkIdType, const Scalar*)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::InsertTupleValue(vtkIdType, const Scalar*)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStructuredPointArray<Scalar>
+::InsertNextTupleValue(const Scalar *)
+{
+  vtkErrorMacro("Read only container.")
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::SetValue(vtkIdType, Scalar)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStructuredPointArray<Scalar>
+::InsertNextValue(Scalar)
+{
+  vtkErrorMacro("Read only container.")
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStructuredPointArray<Scalar>
+::InsertValue(vtkIdType, Scalar)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkStructuredPointArray<Scalar>
+::vtkStructuredPointArray()
+  : TempValue(0)
+{
+  this->NumberOfComponents = 3;
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    this->Dimensions[axis] = 0;
+    this->TempDoubleArray[axis] = 0.0;
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkStructuredPointArray<Scalar>
+::~vtkStructuredPointArray()
+{
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStructuredPointArray<Scalar>
+::Lookup(const Scalar &val, vtkIdType index)
+{
+  while (index <= this->MaxId)
+    {
+    if (this->GetValue(index) == val)
+      {
+      return index;
+      }
+    ++index;
+    }
+  return -1;
+}
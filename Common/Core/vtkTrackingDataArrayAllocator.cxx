@@ -0,0 +1,317 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTrackingDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkTrackingDataArrayAllocator.h"
+
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
+
+#include <map>
+#include <vector>
+
+vtkStandardNewMacro(vtkTrackingDataArrayAllocator);
+
+//----------------------------------------------------------------------------
+struct vtkTrackingDataArrayAllocatorUsage
+{
+  vtkTrackingDataArrayAllocatorUsage() : Current(0), Peak(0) {}
+
+  void Add(vtkTypeInt64 bytes)
+  {
+    this->Current += bytes;
+    if (this->Current > this->Peak)
+      {
+      this->Peak = this->Current;
+      }
+  }
+
+  vtkTypeInt64 Current;
+  vtkTypeInt64 Peak;
+};
+
+struct vtkTrackingDataArrayAllocatorThread
+{
+  vtkMultiThreaderIDType Thread;
+  std::vector<const void*> Owners;
+};
+
+class vtkTrackingDataArrayAllocatorInternals
+{
+public:
+  vtkSimpleCriticalSection Lock;
+  std::map<void*, const void*> Blocks;
+  std::map<const void*, vtkTrackingDataArrayAllocatorUsage> Owners;
+  vtkTrackingDataArrayAllocatorUsage Total;
+  std::vector<vtkTrackingDataArrayAllocatorThread> Threads;
+
+  // The owner stack of the thread, NULL if it has none. Called with the
+  // lock.
+  std::vector<const void*> *GetOwners(vtkMultiThreaderIDType thread)
+  {
+    for (size_t i = 0; i < this->Threads.size(); ++i)
+      {
+      if (vtkMultiThreader::ThreadsEqual(this->Threads[i].Thread, thread))
+        {
+        return &this->Threads[i].Owners;
+        }
+      }
+    return NULL;
+  }
+
+  // Charge bytes to the owner and to the total. Called with the lock.
+  void Add(const void *owner, vtkTypeInt64 bytes)
+  {
+    this->Owners[owner].Add(bytes);
+    this->Total.Add(bytes);
+  }
+};
+
+//----------------------------------------------------------------------------
+vtkTrackingDataArrayAllocator::vtkTrackingDataArrayAllocator()
+{
+  this->Allocator = NULL;
+  this->Previous = NULL;
+  this->Internals = new vtkTrackingDataArrayAllocatorInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkTrackingDataArrayAllocator::~vtkTrackingDataArrayAllocator()
+{
+  this->Stop();
+  this->SetAllocator(NULL);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+vtkCxxSetObjectMacro(vtkTrackingDataArrayAllocator, Allocator,
+                     vtkDataArrayAllocator);
+
+//----------------------------------------------------------------------------
+void vtkTrackingDataArrayAllocator::Start()
+{
+  if (this->Previous)
+    {
+    return;
+    }
+  this->Previous = vtkDataArrayAllocator::GetInstance();
+  this->Previous->Register(this);
+  if (!this->Allocator)
+    {
+    this->SetAllocator(this->Previous);
+    }
+  vtkDataArrayAllocator::SetInstance(this);
+}
+
+//----------------------------------------------------------------------------
+void vtkTrackingDataArrayAllocator::Stop()
+{
+  if (!this->Previous)
+    {
+    return;
+    }
+  // Another policy may have been installed since, keep it.
+  if (vtkDataArrayAllocator::GetInstance() == this)
+    {
+    vtkDataArrayAllocator::SetInstance(this->Previous);
+    }
+  this->Previous->UnRegister(this);
+  this->Previous = NULL;
+}
+
+//----------------------------------------------------------------------------
+bool vtkTrackingDataArrayAllocator::IsTracking()
+{
+  return this->Previous != NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkTrackingDataArrayAllocator::BeginOwner(const void *owner)
+{
+  vtkMultiThreaderIDType thread = vtkMultiThreader::GetCurrentThreadID();
+  this->Internals->Lock.Lock();
+  std::vector<const void*> *owners = this->Internals->GetOwners(thread);
+  if (!owners)
+    {
+    vtkTrackingDataArrayAllocatorThread t;
+    t.Thread = thread;
+    this->Internals->Threads.push_back(t);
+    owners = &this->Internals->Threads.back().Owners;
+    }
+  owners->push_back(owner);
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkTrackingDataArrayAllocator::EndOwner()
+{
+  vtkMultiThreaderIDType thread = vtkMultiThreader::GetCurrentThreadID();
+  this->Internals->Lock.Lock();
+  std::vector<vtkTrackingDataArrayAllocatorThread> &threads =
+    this->Internals->Threads;
+  for (size_t i = 0; i < threads.size(); ++i)
+    {
+    if (vtkMultiThreader::ThreadsEqual(threads[i].Thread, thread))
+      {
+      threads[i].Owners.pop_back();
+      // Forget the threads without owners, so the list stays short.
+      if (threads[i].Owners.empty())
+        {
+        threads.erase(threads.begin() + i);
+        }
+      break;
+      }
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkTrackingDataArrayAllocator::GetAllocatedSize()
+{
+  this->Internals->Lock.Lock();
+  vtkTypeInt64 size = this->Internals->Total.Current;
+  this->Internals->Lock.Unlock();
+  return size;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkTrackingDataArrayAllocator::GetPeakAllocatedSize()
+{
+  this->Internals->Lock.Lock();
+  vtkTypeInt64 size = this->Internals->Total.Peak;
+  this->Internals->Lock.Unlock();
+  return size;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkTrackingDataArrayAllocator::GetAllocatedSize(const void *owner)
+{
+  vtkTypeInt64 size = 0;
+  this->Internals->Lock.Lock();
+  std::map<const void*, vtkTrackingDataArrayAllocatorUsage>::iterator it =
+    this->Internals->Owners.find(owner);
+  if (it != this->Internals->Owners.end())
+    {
+    size = it->second.Current;
+    }
+  this->Internals->Lock.Unlock();
+  return size;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkTrackingDataArrayAllocator::GetPeakAllocatedSize(
+  const void *owner)
+{
+  vtkTypeInt64 size = 0;
+  this->Internals->Lock.Lock();
+  std::map<const void*, vtkTrackingDataArrayAllocatorUsage>::iterator it =
+    this->Internals->Owners.find(owner);
+  if (it != this->Internals->Owners.end())
+    {
+    size = it->second.Peak;
+    }
+  this->Internals->Lock.Unlock();
+  return size;
+}
+
+//----------------------------------------------------------------------------
+void vtkTrackingDataArrayAllocator::ResetPeaks()
+{
+  this->Internals->Lock.Lock();
+  std::map<const void*, vtkTrackingDataArrayAllocatorUsage>::iterator it;
+  for (it = this->Internals->Owners.begin();
+       it != this->Internals->Owners.end(); ++it)
+    {
+    it->second.Peak = it->second.Current;
+    }
+  this->Internals->Total.Peak = this->Internals->Total.Current;
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void *vtkTrackingDataArrayAllocator::Allocate(size_t size)
+{
+  void *ptr = this->Allocator ?
+    this->Allocator->Allocate(size) : this->Superclass::Allocate(size);
+  if (ptr)
+    {
+    vtkMultiThreaderIDType thread = vtkMultiThreader::GetCurrentThreadID();
+    this->Internals->Lock.Lock();
+    std::vector<const void*> *owners = this->Internals->GetOwners(thread);
+    const void *owner = owners ? owners->back() : NULL;
+    this->Internals->Blocks[ptr] = owner;
+    this->Internals->Add(owner, static_cast<vtkTypeInt64>(size));
+    this->Internals->Lock.Unlock();
+    }
+  return ptr;
+}
+
+//----------------------------------------------------------------------------
+void *vtkTrackingDataArrayAllocator::Reallocate(void *ptr, size_t oldSize,
+                                                size_t newSize)
+{
+  void *newPtr = this->Allocator ?
+    this->Allocator->Reallocate(ptr, oldSize, newSize) :
+    this->Superclass::Reallocate(ptr, oldSize, newSize);
+  if (newPtr)
+    {
+    this->Internals->Lock.Lock();
+    const void *owner = this->Internals->Blocks[ptr];
+    if (newPtr != ptr)
+      {
+      this->Internals->Blocks.erase(ptr);
+      this->Internals->Blocks[newPtr] = owner;
+      }
+    this->Internals->Add(owner, static_cast<vtkTypeInt64>(newSize) -
+                         static_cast<vtkTypeInt64>(oldSize));
+    this->Internals->Lock.Unlock();
+    }
+  return newPtr;
+}
+
+//----------------------------------------------------------------------------
+void vtkTrackingDataArrayAllocator::Free(void *ptr, size_t size)
+{
+  if (!ptr)
+    {
+    return;
+    }
+  if (this->Allocator)
+    {
+    this->Allocator->Free(ptr, size);
+    }
+  else
+    {
+    this->Superclass::Free(ptr, size);
+    }
+  this->Internals->Lock.Lock();
+  std::map<void*, const void*>::iterator it = this->Internals->Blocks.find(ptr);
+  if (it != this->Internals->Blocks.end())
+    {
+    this->Internals->Add(it->second, -static_cast<vtkTypeInt64>(size));
+    this->Internals->Blocks.erase(it);
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkTrackingDataArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Allocator: " << this->Allocator << endl;
+  os << indent << "Tracking: " << (this->IsTracking() ? "On" : "Off") << endl;
+  os << indent << "AllocatedSize: " << this->GetAllocatedSize() << endl;
+  os << indent << "PeakAllocatedSize: " << this->GetPeakAllocatedSize()
+     << endl;
+}
@@ -0,0 +1,110 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTrackingDataArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkTrackingDataArrayAllocator - account for data array memory
+// .SECTION Description
+// vtkTrackingDataArrayAllocator passes the allocations of the data arrays
+// to another allocator and counts the bytes they hold, in total and per
+// owner, along with the peaks of these counts. Start() installs it as the
+// vtkDataArrayAllocator instance in front of the current policy, and
+// Stop() puts that policy back. The arrays allocated in between keep
+// releasing their memory through the tracker, so the counts stay right
+// after it is stopped.
+//
+// An owner is any pointer, usually the algorithm that is executing, made
+// current for the calling thread by BeginOwner() and EndOwner(). The
+// memory of a block is charged to the owner that allocated it until the
+// block is freed, even if it grows later under another owner. Blocks
+// allocated without a current owner, including those of threads spawned
+// by an owner, are charged to the NULL owner.
+//
+// All the data arrays are tracked, vtkPoints and the vtkIdTypeArray of
+// vtkCellArray included, but not vtkBitArray and the other arrays that
+// are not vtkDataArrayTemplate. Every allocation takes a lock, so tracking
+// is meant for profiling sessions.
+//
+// .SECTION See Also
+// vtkDataArrayAllocator vtkExecutionProfiler
+
+#ifndef vtkTrackingDataArrayAllocator_h
+#define vtkTrackingDataArrayAllocator_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkDataArrayAllocator.h"
+
+class vtkTrackingDataArrayAllocatorInternals;
+
+class VTKCOMMONCORE_EXPORT vtkTrackingDataArrayAllocator
+  : public vtkDataArrayAllocator
+{
+public:
+  static vtkTrackingDataArrayAllocator *New();
+  vtkTypeMacro(vtkTrackingDataArrayAllocator, vtkDataArrayAllocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set/Get the allocator that provides the memory. Start() sets it to the
+  // current instance. It must not be changed while blocks are held.
+  void SetAllocator(vtkDataArrayAllocator *allocator);
+  vtkGetObjectMacro(Allocator, vtkDataArrayAllocator);
+
+  // Description:
+  // Install this tracker as the vtkDataArrayAllocator instance, in front of
+  // the current instance, or restore that instance.
+  void Start();
+  void Stop();
+  bool IsTracking();
+
+  // Description:
+  // Make owner the owner of the blocks allocated by the calling thread
+  // until the matching EndOwner(). Owners nest.
+  void BeginOwner(const void *owner);
+  void EndOwner();
+
+  // Description:
+  // The bytes held by the blocks of all owners, and the largest value it
+  // reached.
+  vtkTypeInt64 GetAllocatedSize();
+  vtkTypeInt64 GetPeakAllocatedSize();
+
+  // Description:
+  // The bytes held by the blocks of one owner, and the largest value it
+  // reached.
+  vtkTypeInt64 GetAllocatedSize(const void *owner);
+  vtkTypeInt64 GetPeakAllocatedSize(const void *owner);
+
+  // Description:
+  // Lower the peaks to the bytes held now.
+  void ResetPeaks();
+
+//BTX
+  virtual void *Allocate(size_t size);
+  virtual void *Reallocate(void *ptr, size_t oldSize, size_t newSize);
+  virtual void Free(void *ptr, size_t size);
+//ETX
+
+protected:
+  vtkTrackingDataArrayAllocator();
+  ~vtkTrackingDataArrayAllocator();
+
+  vtkDataArrayAllocator *Allocator;
+  vtkDataArrayAllocator *Previous;
+  vtkTrackingDataArrayAllocatorInternals *Internals;
+
+private:
+  vtkTrackingDataArrayAllocator(const vtkTrackingDataArrayAllocator&);  // Not implemented.
+  void operator=(const vtkTrackingDataArrayAllocator&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,252 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAMRInformationBlockLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the grids found through the block locator of vtkAMRInformation
+// against linear scans of the levels and of the children lists, for single
+// and batched queries, and after the boxes change.
+
+#include "vtkAMRBox.h"
+#include "vtkAMRInformation.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkUnsignedIntArray.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+namespace
+{
+bool Inside(const double q[3], const double bb[6])
+{
+  return q[0] >= bb[0] && q[0] <= bb[1] && q[1] >= bb[2] && q[1] <= bb[3] &&
+    q[2] >= bb[4] && q[2] <= bb[5];
+}
+
+// The first grid of the level that contains q.
+bool LinearFindGridAtLevel(vtkAMRInformation *info, double q[3],
+                           unsigned int level, unsigned int &gridId)
+{
+  for (unsigned int i = 0; i < info->GetNumberOfDataSets(level); ++i)
+    {
+    double bb[6];
+    info->GetBounds(level, i, bb);
+    if (Inside(q, bb))
+      {
+      gridId = i;
+      return true;
+      }
+    }
+  return false;
+}
+
+// Descend from the level 0 grid through the children lists.
+bool LinearFindHighestGrid(vtkAMRInformation *info, double q[3],
+                           unsigned int &level, unsigned int &gridId)
+{
+  if (!LinearFindGridAtLevel(info, q, 0, gridId))
+    {
+    return false;
+    }
+  for (level = 0; level < info->GetNumberOfLevels(); ++level)
+    {
+    unsigned int n;
+    unsigned int *children = info->GetChildren(level, gridId, n);
+    unsigned int i = 0;
+    for (; i < n; ++i)
+      {
+      double bb[6];
+      info->GetBounds(level + 1, children[i], bb);
+      if (Inside(q, bb))
+        {
+        gridId = children[i];
+        break;
+        }
+      }
+    if (i >= n)
+      {
+      break;
+      }
+    }
+  return true;
+}
+
+void SetRandomBox(vtkAMRInformation *info, unsigned int level,
+                  unsigned int id, int extent, int maxSize)
+{
+  int lo[3], hi[3];
+  for (int i = 0; i < 3; ++i)
+    {
+    lo[i] = static_cast<int>(vtkMath::Random(0, extent - maxSize));
+    hi[i] = lo[i] + static_cast<int>(vtkMath::Random(1, maxSize));
+    }
+  info->SetAMRBox(level, id, vtkAMRBox(lo, hi));
+}
+}
+
+int TestAMRInformationBlockLocator(int, char *[])
+{
+  vtkMath::RandomSeed(4321);
+
+  // Level 0 tiles the domain with 6x6x3 boxes of 8^3 cells, the finer
+  // levels have random, overlapping boxes. One box of level 1 is left
+  // invalid.
+  const int blocksPerLevel[3] = { 108, 200, 300 };
+  vtkNew<vtkAMRInformation> info;
+  info->Initialize(3, blocksPerLevel);
+  info->SetGridDescription(VTK_XYZ_GRID);
+  const double origin[3] = { -1.0, 2.0, 0.5 };
+  info->SetOrigin(origin);
+  double h[3] = { 1.0, 1.0, 1.0 };
+  for (unsigned int level = 0; level < 3; ++level)
+    {
+    info->SetSpacing(level, h);
+    h[0] /= 2.0;
+    h[1] /= 2.0;
+    h[2] /= 2.0;
+    }
+  for (int k = 0, id = 0; k < 3; ++k)
+    {
+    for (int j = 0; j < 6; ++j)
+      {
+      for (int i = 0; i < 6; ++i, ++id)
+        {
+        const int lo[3] = { 8 * i, 8 * j, 8 * k };
+        const int hi[3] = { 8 * i + 7, 8 * j + 7, 8 * k + 7 };
+        info->SetAMRBox(0, id, vtkAMRBox(lo, hi));
+        }
+      }
+    }
+  for (unsigned int id = 1; id < 200; ++id)
+    {
+    SetRandomBox(info.GetPointer(), 1, id, 48, 12);
+    }
+  for (unsigned int id = 0; id < 300; ++id)
+    {
+    SetRandomBox(info.GetPointer(), 2, id, 96, 16);
+    }
+  info->GenerateParentChildInformation();
+
+  // Random points around the domain and corners of the boxes.
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (int p = 0; p < 3000; ++p)
+    {
+    points->InsertNextPoint(vtkMath::Random(origin[0] - 2, origin[0] + 50),
+                            vtkMath::Random(origin[1] - 2, origin[1] + 50),
+                            vtkMath::Random(origin[2] - 2, origin[2] + 26));
+    }
+  for (unsigned int level = 0; level < 3; ++level)
+    {
+    for (unsigned int id = 1; id < info->GetNumberOfDataSets(level); id += 7)
+      {
+      double bb[6];
+      info->GetBounds(level, id, bb);
+      points->InsertNextPoint(bb[0], bb[2], bb[4]);
+      points->InsertNextPoint(bb[1], bb[3], bb[5]);
+      }
+    }
+
+  TEST_ASSERT(!info->HasBlockLocator(), "Locator built too early");
+  vtkIdType numFound[3] = { 0, 0, 0 };
+  for (vtkIdType p = 0; p < points->GetNumberOfPoints(); ++p)
+    {
+    double q[3];
+    points->GetPoint(p, q);
+    for (unsigned int level = 0; level < 3; ++level)
+      {
+      unsigned int expectedId = 0, gridId = 0;
+      bool expected = LinearFindGridAtLevel(info.GetPointer(), q, level,
+                                            expectedId);
+      bool found = info->FindGrid(q, static_cast<int>(level), gridId);
+      TEST_ASSERT(found == expected && (!found || gridId == expectedId),
+                  "Bad grid at level " << level << " for point " << p);
+      numFound[level] += found ? 1 : 0;
+
+      int expectedCell = -1, cell = -1;
+      expected = false;
+      for (expectedId = 0; !expected &&
+             expectedId < info->GetNumberOfDataSets(level); ++expectedId)
+        {
+        expected = info->FindCell(q, level, expectedId, expectedCell);
+        }
+      found = info->FindGridCell(q, level, gridId, cell);
+      TEST_ASSERT(found == expected &&
+                  (!found || (gridId == expectedId - 1 && cell == expectedCell)),
+                  "Bad cell at level " << level << " for point " << p);
+      }
+
+    unsigned int expectedLevel = 0, expectedId = 0, level = 0, gridId = 0;
+    bool expected = LinearFindHighestGrid(info.GetPointer(), q,
+                                          expectedLevel, expectedId);
+    bool found = info->FindGrid(q, level, gridId);
+    TEST_ASSERT(found == expected && (!found || (level == expectedLevel &&
+                                                 gridId == expectedId)),
+                "Bad highest level grid for point " << p);
+    }
+  TEST_ASSERT(info->HasBlockLocator(), "Locator not built");
+  TEST_ASSERT(numFound[0] > 1000 && numFound[1] > 100 && numFound[2] > 100,
+              "Too few points inside the grids");
+
+  // Batched queries.
+  vtkNew<vtkIntArray> levels;
+  vtkNew<vtkUnsignedIntArray> gridIds;
+  info->FindGrids(points.GetPointer(), levels.GetPointer(),
+                  gridIds.GetPointer());
+  TEST_ASSERT(levels->GetNumberOfTuples() == points->GetNumberOfPoints() &&
+              gridIds->GetNumberOfTuples() == points->GetNumberOfPoints(),
+              "Bad number of batched results");
+  for (vtkIdType p = 0; p < points->GetNumberOfPoints(); ++p)
+    {
+    double q[3];
+    points->GetPoint(p, q);
+    unsigned int expectedLevel = 0, expectedId = 0;
+    bool expected = LinearFindHighestGrid(info.GetPointer(), q,
+                                          expectedLevel, expectedId);
+    TEST_ASSERT(expected ? (levels->GetValue(p) ==
+                            static_cast<int>(expectedLevel) &&
+                            gridIds->GetValue(p) == expectedId)
+                : levels->GetValue(p) == -1,
+                "Bad batched grid for point " << p);
+    }
+
+  // Queries after the invalid box becomes a large one.
+  const int lo[3] = { 40, 40, 0 };
+  const int hi[3] = { 89, 89, 40 };
+  info->SetAMRBox(1, 0, vtkAMRBox(lo, hi));
+  TEST_ASSERT(!info->HasBlockLocator(), "Locator not reset");
+  vtkIdType numMoved = 0;
+  for (vtkIdType p = 0; p < points->GetNumberOfPoints(); ++p)
+    {
+    double q[3];
+    points->GetPoint(p, q);
+    unsigned int expectedId = 0, gridId = 0;
+    bool expected = LinearFindGridAtLevel(info.GetPointer(), q, 1, expectedId);
+    bool found = info->FindGrid(q, 1, gridId);
+    TEST_ASSERT(found == expected && (!found || gridId == expectedId),
+                "Bad grid after SetAMRBox for point " << p);
+    numMoved += (found && gridId == 0) ? 1 : 0;
+    }
+  TEST_ASSERT(numMoved > 0, "Moved box not found");
+
+  return EXIT_SUCCESS;
+}
@@ -15,9 +15,13 @@
 
 #include "vtkMath.h"
 #include "vtkBoundingBox.h"
+#include "vtkCellArray.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkSmartPointer.h"
 
 #include <limits>
+#include <vector>
 
 #define TestBoundingBoxFailMacro(b,msg) if(!(b)){std::cerr <<msg<<std::endl;return EXIT_FAILURE;}
 
@@ -79,5 +83,64 @@ int TestBoundingBox(int,char *[])
     vtkBoundingBox bbox(bb);
     TestBoundingBoxFailMacro(!bbox.IsValid(), "Bounding box from invalid bounds Failed!");
     }
+    {
+    // Enough points to be processed in parallel, every other one used.
+    const vtkIdType numPts = 200001;
+    std::vector<unsigned char> uses(numPts);
+    int types[3] = {VTK_FLOAT, VTK_DOUBLE, VTK_INT};
+    for (int t = 0; t < 3; ++t)
+      {
+      vtkSmartPointer<vtkPoints> pts = vtkSmartPointer<vtkPoints>::New();
+      pts->SetDataType(types[t]);
+      pts->SetNumberOfPoints(numPts);
+      for (vtkIdType i = 0; i < numPts; ++i)
+        {
+        pts->SetPoint(i, i - 1000, -i, i % 7);
+        uses[i] = (i % 2 == 0 && i < numPts - 1) ? 1 : 0;
+        }
+      double bb[6];
+      vtkBoundingBox::ComputeBounds(pts, NULL, bb);
+      TestBoundingBoxFailMacro(bb[0] == -1000 && bb[1] == numPts - 1001 &&
+                               bb[2] == -(numPts - 1) && bb[3] == 0 &&
+                               bb[4] == 0 && bb[5] == 6,
+                               "ComputeBounds of all points Failed!");
+      vtkBoundingBox::ComputeBounds(pts, &uses[0], bb);
+      TestBoundingBoxFailMacro(bb[0] == -1000 && bb[1] == numPts - 1003 &&
+                               bb[2] == -(numPts - 3) && bb[3] == 0 &&
+                               bb[4] == 0 && bb[5] == 6,
+                               "ComputeBounds of used points Failed!");
+      std::fill(uses.begin(), uses.end(), 0);
+      vtkBoundingBox::ComputeBounds(pts, &uses[0], bb);
+      TestBoundingBoxFailMacro(!vtkBoundingBox::IsValid(bb),
+                               "ComputeBounds without used points Failed!");
+      }
+    }
+    {
+    // Poly data bounds only include the points of the cells.
+    vtkSmartPointer<vtkPoints> pts = vtkSmartPointer<vtkPoints>::New();
+    pts->InsertNextPoint(0, 0, 0);
+    pts->InsertNextPoint(1, 2, 3);
+    pts->InsertNextPoint(100, 100, 100);
+    vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New();
+    vtkIdType line[2] = {0, 1};
+    lines->InsertNextCell(2, line);
+    vtkSmartPointer<vtkPolyData> pd = vtkSmartPointer<vtkPolyData>::New();
+    pd->SetPoints(pts);
+    pd->SetLines(lines);
+    double *bb = pd->GetBounds();
+    TestBoundingBoxFailMacro(bb[0] == 0 && bb[1] == 1 && bb[3] == 2 &&
+                             bb[5] == 3, "Poly data bounds Failed!");
+    pts->SetPoint(1, -1, 2, 3);
+    pts->Modified();
+    bb = pd->GetBounds();
+    TestBoundingBoxFailMacro(bb[0] == -1 && bb[1] == 0,
+                             "Poly data bounds after points change Failed!");
+    line[1] = 2;
+    lines->InsertNextCell(2, line);
+    lines->Modified();
+    bb = pd->GetBounds();
+    TestBoundingBoxFailMacro(bb[1] == 100,
+                             "Poly data bounds after cells change Failed!");
+    }
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,332 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellArrayOffsets.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the offsets/connectivity storage of vtkCellArray, and its use by
+// vtkPolyData and vtkUnstructuredGrid.
+
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTypeInt32Array.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return false;                                                     \
+    }
+
+namespace
+{
+const int NumberOfCells = 50;
+
+// Cell i has 1 + i % 5 points, with ids starting at 7 * i.
+vtkIdType CellSize(vtkIdType i)
+{
+  return 1 + i % 5;
+}
+
+vtkIdType CellPoint(vtkIdType i, vtkIdType j)
+{
+  return 7 * i + j;
+}
+
+void FillCells(vtkCellArray *ca, bool incremental)
+{
+  vtkIdType pts[5];
+  for (vtkIdType i = 0; i < NumberOfCells; ++i)
+    {
+    vtkIdType npts = CellSize(i);
+    for (vtkIdType j = 0; j < npts; ++j)
+      {
+      pts[j] = CellPoint(i, j);
+      }
+    if (incremental)
+      {
+      // Over-estimate the size and fix it afterwards.
+      ca->InsertNextCell(5);
+      for (vtkIdType j = 0; j < npts; ++j)
+        {
+        ca->InsertCellPoint(pts[j]);
+        }
+      ca->UpdateCellCount(static_cast<int>(npts));
+      }
+    else
+      {
+      ca->InsertNextCell(npts, pts);
+      }
+    }
+}
+
+bool CheckCells(vtkCellArray *ca, const char *name)
+{
+  TEST_ASSERT(ca->GetNumberOfCells() == NumberOfCells,
+              name << ": bad number of cells " << ca->GetNumberOfCells());
+  vtkIdType entries = 0;
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType i = 0; i < NumberOfCells; ++i)
+    {
+    entries += CellSize(i) + 1;
+    TEST_ASSERT(ca->GetCellSize(i) == CellSize(i),
+                name << ": bad size of cell " << i);
+    ca->GetCellAtId(i, ids.GetPointer());
+    TEST_ASSERT(ids->GetNumberOfIds() == CellSize(i),
+                name << ": bad cell " << i);
+    for (vtkIdType j = 0; j < CellSize(i); ++j)
+      {
+      TEST_ASSERT(ids->GetId(j) == CellPoint(i, j),
+                  name << ": bad point " << j << " of cell " << i);
+      }
+    }
+  TEST_ASSERT(ca->GetNumberOfConnectivityEntries() == entries,
+              name << ": bad number of entries");
+  TEST_ASSERT(ca->GetMaxCellSize() == 5, name << ": bad max cell size");
+
+  // Traversal, and access by the traversal location.
+  vtkIdType npts, *pts;
+  vtkIdType i = 0;
+  for (ca->InitTraversal(); ca->GetNextCell(npts, pts); ++i)
+    {
+    TEST_ASSERT(npts == CellSize(i) && pts[npts - 1] == CellPoint(i, npts - 1),
+                name << ": bad traversal of cell " << i);
+    vtkIdType loc = ca->GetTraversalLocation(npts);
+    const vtkIdType *cpts;
+    ca->GetCell(loc, npts, cpts, ids.GetPointer());
+    TEST_ASSERT(npts == CellSize(i) && cpts[0] == CellPoint(i, 0),
+                name << ": bad cell at traversal location " << loc);
+    }
+  TEST_ASSERT(i == NumberOfCells, name << ": bad traversal");
+
+  // The legacy export.
+  vtkIdTypeArray *data = ca->GetData();
+  TEST_ASSERT(data->GetNumberOfTuples() == entries,
+              name << ": bad legacy export");
+  vtkIdType loc = 0;
+  for (i = 0; i < NumberOfCells; ++i)
+    {
+    TEST_ASSERT(data->GetValue(loc) == CellSize(i) &&
+                data->GetValue(loc + 1) == CellPoint(i, 0),
+                name << ": bad legacy export of cell " << i);
+    loc += CellSize(i) + 1;
+    }
+  return true;
+}
+
+bool TestCellArray()
+{
+  vtkNew<vtkCellArray> legacy;
+  FillCells(legacy.GetPointer(), false);
+  if (!CheckCells(legacy.GetPointer(), "legacy"))
+    {
+    return false;
+    }
+
+  const bool use32Bit[] = { false, true };
+  const bool incremental[] = { false, true };
+  for (int b = 0; b < 2; ++b)
+    {
+    for (int inc = 0; inc < 2; ++inc)
+      {
+      vtkNew<vtkCellArray> ca;
+      ca->SetStorageModeToOffsets();
+      ca->SetUse32BitStorage(use32Bit[b]);
+      FillCells(ca.GetPointer(), incremental[inc]);
+      if (!CheckCells(ca.GetPointer(), use32Bit[b] ? "offsets 32" : "offsets"))
+        {
+        return false;
+        }
+      TEST_ASSERT(ca->GetOffsetsArray()->GetNumberOfTuples() ==
+                  NumberOfCells + 1, "Bad offsets array");
+
+      // Reverse and replace by location.
+      ca->ReverseCell(3);
+      vtkNew<vtkIdList> ids;
+      ca->GetCellAtId(3, ids.GetPointer());
+      TEST_ASSERT(ids->GetId(0) == CellPoint(3, 3) &&
+                  ids->GetId(3) == CellPoint(3, 0), "Bad ReverseCell");
+      vtkIdType pts[4] = { CellPoint(3, 0), CellPoint(3, 1), CellPoint(3, 2),
+                           CellPoint(3, 3) };
+      ca->ReplaceCell(3, 4, pts);
+
+      // Conversion to the legacy storage and back.
+      ca->SetStorageModeToLegacy();
+      if (!CheckCells(ca.GetPointer(), "converted to legacy"))
+        {
+        return false;
+        }
+      ca->SetStorageModeToOffsets();
+      if (!CheckCells(ca.GetPointer(), "converted to offsets"))
+        {
+        return false;
+        }
+
+      vtkNew<vtkCellArray> copy;
+      copy->DeepCopy(ca.GetPointer());
+      if (!CheckCells(copy.GetPointer(), "deep copy"))
+        {
+        return false;
+        }
+      }
+    }
+
+  // Arrays defined by the user.
+  vtkNew<vtkTypeInt32Array> offsets;
+  vtkNew<vtkTypeInt32Array> conn;
+  offsets->InsertNextValue(0);
+  for (vtkIdType i = 0; i < NumberOfCells; ++i)
+    {
+    for (vtkIdType j = 0; j < CellSize(i); ++j)
+      {
+      conn->InsertNextValue(static_cast<int>(CellPoint(i, j)));
+      }
+    offsets->InsertNextValue(conn->GetNumberOfTuples());
+    }
+  vtkNew<vtkCellArray> shared;
+  TEST_ASSERT(shared->SetData(offsets.GetPointer(), conn.GetPointer()),
+              "SetData failed");
+  TEST_ASSERT(shared->GetConnectivityArray() == conn.GetPointer(),
+              "SetData copied the arrays");
+  if (!CheckCells(shared.GetPointer(), "shared"))
+    {
+    return false;
+    }
+
+#if VTK_SIZEOF_ID_TYPE == 8
+  // Ids that do not fit in 32 bits widen the storage.
+  TEST_ASSERT(!shared->IsStorageShareable(), "Expected 32 bit storage");
+  vtkIdType big[2] = { 1, vtkIdType(1) << 40 };
+  shared->InsertNextCell(2, big);
+  TEST_ASSERT(shared->IsStorageShareable() && !shared->GetUse32BitStorage(),
+              "Storage was not widened");
+  vtkNew<vtkIdList> ids;
+  shared->GetCellAtId(NumberOfCells, ids.GetPointer());
+  TEST_ASSERT(ids->GetNumberOfIds() == 2 && ids->GetId(1) == big[1],
+              "Bad cell after widening");
+  TEST_ASSERT(shared->GetCellSize(NumberOfCells - 1) ==
+              CellSize(NumberOfCells - 1), "Cells lost by widening");
+#endif
+  return true;
+}
+
+// Quads (0,1,2,3), (7,8,9,10), ...
+void FillQuads(vtkCellArray *ca)
+{
+  for (vtkIdType i = 0; i < NumberOfCells; ++i)
+    {
+    vtkIdType pts[4] = { CellPoint(i, 0), CellPoint(i, 1), CellPoint(i, 2),
+                         CellPoint(i, 3) };
+    ca->InsertNextCell(4, pts);
+    }
+}
+
+bool CheckDataSet(vtkDataSet *ds, const char *name)
+{
+  vtkNew<vtkGenericCell> cell;
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType i = 0; i < NumberOfCells; ++i)
+    {
+    ds->GetCellPoints(i, ids.GetPointer());
+    TEST_ASSERT(ids->GetNumberOfIds() == 4 && ids->GetId(2) == CellPoint(i, 2),
+                name << ": bad points of cell " << i);
+    vtkIdType npts;
+    const vtkIdType *pts;
+    ds->GetCellPoints(i, npts, pts, ids.GetPointer());
+    TEST_ASSERT(npts == 4 && pts[3] == CellPoint(i, 3),
+                name << ": bad point pointer of cell " << i);
+    ds->GetCell(i, cell.GetPointer());
+    TEST_ASSERT(cell->GetCellType() == VTK_QUAD &&
+                cell->GetPointId(3) == CellPoint(i, 3) &&
+                cell->GetPoints()->GetPoint(1)[0] == CellPoint(i, 1),
+                name << ": bad generic cell " << i);
+    double bounds[6];
+    ds->GetCellBounds(i, bounds);
+    TEST_ASSERT(bounds[0] == CellPoint(i, 0) && bounds[1] == CellPoint(i, 3),
+                name << ": bad bounds of cell " << i);
+    }
+  return true;
+}
+
+bool TestDataSets()
+{
+  vtkNew<vtkPoints> points;
+  for (vtkIdType i = 0; i < 7 * NumberOfCells; ++i)
+    {
+    points->InsertNextPoint(static_cast<double>(i), 0.0, 0.0);
+    }
+
+  for (int b = 0; b < 2; ++b)
+    {
+    vtkNew<vtkCellArray> polys;
+    polys->SetStorageModeToOffsets();
+    polys->SetUse32BitStorage(b == 1);
+    FillQuads(polys.GetPointer());
+
+    vtkNew<vtkPolyData> pd;
+    pd->SetPoints(points.GetPointer());
+    pd->SetPolys(polys.GetPointer());
+    pd->BuildCells();
+    if (!CheckDataSet(pd.GetPointer(), "vtkPolyData"))
+      {
+      return false;
+      }
+    TEST_ASSERT(polys->GetStorageMode() == vtkCellArray::OFFSETS_STORAGE,
+                "vtkPolyData changed the storage");
+    pd->ReplaceCellPoint(5, CellPoint(5, 1), 0);
+    vtkNew<vtkIdList> ids;
+    pd->GetCellPoints(5, ids.GetPointer());
+    TEST_ASSERT(ids->GetId(1) == 0, "Bad ReplaceCellPoint");
+    vtkIdType *cell;
+    pd->GetCell(6, cell);
+    TEST_ASSERT(cell[0] == 4 && cell[1] == CellPoint(6, 0),
+                "Bad vtkPolyData::GetCell");
+
+    vtkNew<vtkUnstructuredGrid> ug;
+    ug->SetPoints(points.GetPointer());
+    ug->Allocate(4 * NumberOfCells);
+    ug->GetCells()->SetStorageModeToOffsets();
+    ug->GetCells()->SetUse32BitStorage(b == 1);
+    for (vtkIdType i = 0; i < NumberOfCells; ++i)
+      {
+      vtkIdType pts[4] = { CellPoint(i, 0), CellPoint(i, 1), CellPoint(i, 2),
+                           CellPoint(i, 3) };
+      ug->InsertNextCell(VTK_QUAD, 4, pts);
+      }
+    if (!CheckDataSet(ug.GetPointer(), "vtkUnstructuredGrid"))
+      {
+      return false;
+      }
+    TEST_ASSERT(ug->GetCells()->GetStorageMode() ==
+                vtkCellArray::OFFSETS_STORAGE,
+                "vtkUnstructuredGrid changed the storage");
+    }
+  return true;
+}
+}
+
+int TestCellArrayOffsets(int, char *[])
+{
+  if (!TestCellArray() || !TestDataSets())
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
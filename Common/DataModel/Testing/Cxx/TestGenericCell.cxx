@@ -96,6 +96,36 @@ int TestGenericCell(int , char *[])
       }
     }
 
+  // Alternating between types reuses the cached cells.
+  cell->SetCellTypeToTetra();
+  vtkCell *tetra = cell->GetRepresentativeCell();
+  cell->SetCellTypeToHexahedron();
+  vtkCell *hexahedron = cell->GetRepresentativeCell();
+  for(int i=0; i<10; ++i)
+    {
+    cell->SetCellTypeToTetra();
+    if( cell->GetRepresentativeCell() != tetra
+     || cell->Points != tetra->Points || cell->PointIds != tetra->PointIds )
+      {
+      cerr << "Tetra not reused" << endl;
+      ++rval;
+      }
+    cell->SetCellTypeToHexahedron();
+    if( cell->GetRepresentativeCell() != hexahedron
+     || cell->GetNumberOfPoints() != 8 )
+      {
+      cerr << "Hexahedron not reused" << endl;
+      ++rval;
+      }
+    }
+  cell->ReleaseCachedCells();
+  if( cell->GetRepresentativeCell() != hexahedron
+   || cell->GetCellType() != VTK_HEXAHEDRON )
+    {
+    cerr << "Current cell released" << endl;
+    ++rval;
+    }
+
   cell->Delete();
 
   return rval;
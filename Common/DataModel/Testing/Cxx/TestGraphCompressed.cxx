@@ -0,0 +1,201 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGraphCompressed.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that graphs with a compressed adjacency have the same edges as
+// the mutable graphs they are built from, and that they are converted back
+// to adjacency lists when modified.
+
+#include "vtkAdjacentVertexIterator.h"
+#include "vtkDirectedGraph.h"
+#include "vtkEdgeListIterator.h"
+#include "vtkInEdgeIterator.h"
+#include "vtkMath.h"
+#include "vtkMutableDirectedGraph.h"
+#include "vtkMutableUndirectedGraph.h"
+#include "vtkNew.h"
+#include "vtkOutEdgeIterator.h"
+#include "vtkSmartPointer.h"
+#include "vtkUndirectedGraph.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+namespace
+{
+// Random edges, with parallel edges, loops and isolated vertices.
+void AddRandomEdges(vtkGraph *g, vtkIdType numVerts, vtkIdType numEdges)
+{
+  vtkMutableDirectedGraph *dg = vtkMutableDirectedGraph::SafeDownCast(g);
+  vtkMutableUndirectedGraph *ug = vtkMutableUndirectedGraph::SafeDownCast(g);
+  if (dg)
+    {
+    dg->SetNumberOfVertices(numVerts);
+    }
+  else
+    {
+    ug->SetNumberOfVertices(numVerts);
+    }
+  for (vtkIdType e = 0; e < numEdges; ++e)
+    {
+    vtkIdType u = static_cast<vtkIdType>(vtkMath::Random(0, numVerts - 10));
+    vtkIdType v = e % 7 ? static_cast<vtkIdType>(
+      vtkMath::Random(0, numVerts - 10)) : u;
+    if (dg)
+      {
+      dg->AddEdge(u, v);
+      }
+    else
+      {
+      ug->AddEdge(u, v);
+      }
+    }
+}
+
+// Compare the edges of g with those of the expected graph.
+int CompareGraphs(vtkGraph *g, vtkGraph *expected)
+{
+  TEST_ASSERT(g->GetNumberOfVertices() == expected->GetNumberOfVertices() &&
+              g->GetNumberOfEdges() == expected->GetNumberOfEdges(),
+              "Bad graph size");
+  vtkNew<vtkOutEdgeIterator> out, expectedOut;
+  vtkNew<vtkInEdgeIterator> in, expectedIn;
+  vtkNew<vtkAdjacentVertexIterator> adj;
+  for (vtkIdType v = 0; v < g->GetNumberOfVertices(); ++v)
+    {
+    TEST_ASSERT(g->GetOutDegree(v) == expected->GetOutDegree(v) &&
+                g->GetInDegree(v) == expected->GetInDegree(v) &&
+                g->GetDegree(v) == expected->GetDegree(v),
+                "Bad degree of vertex " << v);
+    g->GetOutEdges(v, out.GetPointer());
+    g->GetAdjacentVertices(v, adj.GetPointer());
+    expected->GetOutEdges(v, expectedOut.GetPointer());
+    for (vtkIdType i = 0; expectedOut->HasNext(); ++i)
+      {
+      vtkOutEdgeType e = expectedOut->Next();
+      TEST_ASSERT(out->HasNext() && adj->HasNext(),
+                  "Missing out edge of vertex " << v);
+      vtkOutEdgeType oe = out->Next();
+      vtkOutEdgeType ie = g->GetOutEdge(v, i);
+      TEST_ASSERT(oe.Id == e.Id && oe.Target == e.Target &&
+                  ie.Id == e.Id && ie.Target == e.Target &&
+                  adj->Next() == e.Target, "Bad out edge of vertex " << v);
+      }
+    TEST_ASSERT(!out->HasNext(), "Extra out edge of vertex " << v);
+    g->GetInEdges(v, in.GetPointer());
+    expected->GetInEdges(v, expectedIn.GetPointer());
+    for (vtkIdType i = 0; expectedIn->HasNext(); ++i)
+      {
+      vtkInEdgeType e = expectedIn->Next();
+      TEST_ASSERT(in->HasNext(), "Missing in edge of vertex " << v);
+      vtkInEdgeType oe = in->Next();
+      vtkInEdgeType ie = g->GetInEdge(v, i);
+      TEST_ASSERT(oe.Id == e.Id && oe.Source == e.Source &&
+                  ie.Id == e.Id && ie.Source == e.Source,
+                  "Bad in edge of vertex " << v);
+      }
+    TEST_ASSERT(!in->HasNext(), "Extra in edge of vertex " << v);
+    }
+
+  vtkNew<vtkEdgeListIterator> edges;
+  g->GetEdges(edges.GetPointer());
+  vtkIdType numEdges = 0;
+  while (edges->HasNext())
+    {
+    vtkEdgeType e = edges->Next();
+    TEST_ASSERT(e.Source == expected->GetSourceVertex(e.Id) &&
+                e.Target == expected->GetTargetVertex(e.Id) &&
+                g->GetSourceVertex(e.Id) == e.Source &&
+                g->GetTargetVertex(e.Id) == e.Target,
+                "Bad edge " << e.Id);
+    ++numEdges;
+    }
+  TEST_ASSERT(numEdges == expected->GetNumberOfEdges(),
+              "Bad number of listed edges");
+  return EXIT_SUCCESS;
+}
+}
+
+int TestGraphCompressed(int, char *[])
+{
+  vtkMath::RandomSeed(2016);
+  const vtkIdType numVerts = 2000, numEdges = 10000;
+
+  // Directed graph. The compressed copy must not depend on the lists of the
+  // mutable graph.
+  vtkSmartPointer<vtkMutableDirectedGraph> mdg =
+    vtkSmartPointer<vtkMutableDirectedGraph>::New();
+  AddRandomEdges(mdg, numVerts, numEdges);
+  vtkNew<vtkMutableDirectedGraph> reference;
+  reference->DeepCopy(mdg);
+  vtkNew<vtkDirectedGraph> dg;
+  TEST_ASSERT(dg->CheckedCompressedCopy(mdg) && dg->IsCompressed() &&
+              !mdg->IsCompressed(), "Compression of a directed graph failed");
+  mdg = NULL;
+  if (CompareGraphs(dg.GetPointer(), reference.GetPointer()) != EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Undirected graph.
+  vtkNew<vtkMutableUndirectedGraph> mug;
+  AddRandomEdges(mug.GetPointer(), numVerts, numEdges);
+  vtkNew<vtkUndirectedGraph> ug;
+  TEST_ASSERT(!dg->CheckedCompressedCopy(mug.GetPointer()),
+              "Undirected graph compressed to a directed graph");
+  TEST_ASSERT(ug->CheckedCompressedCopy(mug.GetPointer()) &&
+              ug->IsCompressed(), "Compression of an undirected graph failed");
+  if (CompareGraphs(ug.GetPointer(), mug.GetPointer()) != EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Compressed graphs copy their compressed adjacency.
+  vtkNew<vtkDirectedGraph> copy;
+  copy->ShallowCopy(dg.GetPointer());
+  TEST_ASSERT(copy->IsCompressed() && copy->IsSameStructure(dg.GetPointer()),
+              "Shallow copy not compressed");
+  vtkNew<vtkDirectedGraph> recompressed;
+  TEST_ASSERT(recompressed->CheckedCompressedCopy(dg.GetPointer()) &&
+              recompressed->IsSameStructure(dg.GetPointer()),
+              "Compressed graph compressed again");
+
+  // A modification converts the adjacency back to lists, without changing
+  // the compressed graph.
+  vtkNew<vtkMutableDirectedGraph> modified;
+  TEST_ASSERT(modified->CheckedShallowCopy(dg.GetPointer()) &&
+              modified->IsCompressed(), "Copy to a mutable graph failed");
+  modified->AddEdge(numVerts - 1, 0);
+  reference->AddEdge(numVerts - 1, 0);
+  TEST_ASSERT(!modified->IsCompressed() && dg->IsCompressed() &&
+              dg->GetNumberOfEdges() == numEdges,
+              "Modification of a compressed graph failed");
+  if (CompareGraphs(modified.GetPointer(), reference.GetPointer()) !=
+      EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+  copy->Initialize();
+  TEST_ASSERT(!copy->IsCompressed() && copy->GetNumberOfVertices() == 0 &&
+              dg->GetNumberOfVertices() == numVerts,
+              "Initialization of a compressed graph failed");
+
+  return EXIT_SUCCESS;
+}
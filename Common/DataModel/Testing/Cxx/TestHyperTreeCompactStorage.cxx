@@ -0,0 +1,194 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestHyperTreeCompactStorage.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the numbering, the navigation and the memory footprint of the
+// compact hyper trees, and the traversal of the trees of a hyper tree grid
+// with lightweight super cursors.
+
+#include "vtkDoubleArray.h"
+#include "vtkHyperTree.h"
+#include "vtkHyperTreeCursor.h"
+#include "vtkHyperTreeGrid.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+namespace
+{
+// Subdivide all leaves down to the given level.
+void SubdivideUniformly(vtkHyperTree *tree, vtkHyperTreeCursor *cursor,
+                        int level)
+{
+  if (cursor->GetCurrentLevel() == level)
+    {
+    return;
+    }
+  if (cursor->IsLeaf())
+    {
+    tree->SubdivideLeaf(cursor);
+    }
+  for (int child = 0; child < cursor->GetNumberOfChildren(); ++child)
+    {
+    cursor->ToChild(child);
+    SubdivideUniformly(tree, cursor, level);
+    cursor->ToParent();
+    }
+}
+
+// Count the leaves reached with a super cursor.
+vtkIdType CountLeaves(vtkHyperTreeGrid *grid,
+                      vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor *sc)
+{
+  if (sc->GetCursor(0)->IsLeaf())
+    {
+    return 1;
+    }
+  vtkIdType count = 0;
+  for (unsigned int child = 0; child < grid->GetNumberOfChildren(); ++child)
+    {
+    vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor childCursor;
+    grid->InitializeSuperCursorChild(sc, &childCursor, child);
+    count += CountLeaves(grid, &childCursor);
+    }
+  return count;
+}
+}
+
+int TestHyperTreeCompactStorage(int, char *[])
+{
+  // A quadtree: the children of the k-th subdivided vertex are numbered
+  // from 1 + 4 * k.
+  vtkHyperTree *tree = vtkHyperTree::CreateInstance(2, 2);
+  vtkHyperTreeCursor *cursor = tree->NewCursor();
+  cursor->ToRoot();
+  TEST_ASSERT(cursor->IsRoot() && cursor->IsLeaf() &&
+              cursor->GetNodeId() == 0 && tree->GetNumberOfLeaves() == 1,
+              "Bad initial tree");
+
+  tree->SubdivideLeaf(cursor);
+  TEST_ASSERT(!cursor->IsLeaf() && cursor->IsTerminalNode() &&
+              tree->GetNumberOfLeaves() == 5 &&
+              tree->GetNumberOfLevels() == 2, "Bad root subdivision");
+  cursor->ToChild(2);
+  tree->SubdivideLeaf(cursor);
+  cursor->ToChild(3);
+  TEST_ASSERT(cursor->GetNodeId() == 8 && cursor->IsLeaf() &&
+              cursor->GetChildIndex() == 3 &&
+              cursor->GetCurrentLevel() == 2 &&
+              cursor->GetIndex(0) == 1 && cursor->GetIndex(1) == 3,
+              "Bad child " << cursor->GetNodeId());
+  cursor->ToParent();
+  TEST_ASSERT(cursor->GetNodeId() == 3 && cursor->GetChildIndex() == 2 &&
+              cursor->IsTerminalNode(), "Bad parent " << cursor->GetNodeId());
+  cursor->ToParent();
+  TEST_ASSERT(cursor->IsRoot() && !cursor->IsTerminalNode() &&
+              tree->GetNumberOfLeaves() == 9 &&
+              tree->GetNumberOfNodes() == 2 &&
+              tree->GetNumberOfLevels() == 3, "Bad tree");
+
+  // Navigation without cursor, as done by the hyper tree grid cursors.
+  vtkIdType index = 0;
+  bool isLeaf = true;
+  tree->FindChildParameters(2, index, isLeaf);
+  TEST_ASSERT(index == 3 && !isLeaf, "Bad first child parameters");
+  tree->FindChildParameters(3, index, isLeaf);
+  TEST_ASSERT(index == 8 && isLeaf, "Bad second child parameters");
+
+  // Random access to a node from its indices.
+  int indices[2] = { 1, 3 };
+  cursor->MoveToNode(indices, 2);
+  TEST_ASSERT(cursor->Found() && cursor->GetNodeId() == 8, "Bad MoveToNode");
+  indices[0] = 3;
+  cursor->MoveToNode(indices, 2);
+  TEST_ASSERT(!cursor->Found() && cursor->GetNodeId() == 4,
+              "Bad MoveToNode to a missing node");
+  cursor->Delete();
+  tree->Delete();
+
+  // An uniform octree takes little more than 4 bytes per vertex.
+  const int level = 6;
+  tree = vtkHyperTree::CreateInstance(2, 3);
+  cursor = tree->NewCursor();
+  cursor->ToRoot();
+  SubdivideUniformly(tree, cursor, level);
+  vtkIdType numberOfVertices = 1;
+  for (int l = 0, n = 1; l < level; ++l)
+    {
+    n *= 8;
+    numberOfVertices += n;
+    }
+  TEST_ASSERT(tree->GetNumberOfLeaves() == numberOfVertices &&
+              tree->GetNumberOfLevels() == level + 1, "Bad uniform octree");
+  TEST_ASSERT(tree->GetActualMemorySize() <= numberOfVertices * 5 / 1024,
+              "Too much memory: " << tree->GetActualMemorySize() << " KiB");
+  cursor->Delete();
+  tree->Delete();
+
+  // Trees of a grid, each traversed with a super cursor.
+  vtkNew<vtkHyperTreeGrid> grid;
+  unsigned int gridSize[3] = { 3, 2, 1 };
+  grid->SetGridSize(gridSize);
+  grid->SetDimension(2);
+  grid->SetBranchFactor(3);
+  vtkNew<vtkDoubleArray> x, y, z;
+  for (int i = 0; i <= 3; ++i)
+    {
+    x->InsertNextValue(i);
+    }
+  y->InsertNextValue(0.);
+  y->InsertNextValue(1.);
+  y->InsertNextValue(2.);
+  z->InsertNextValue(0.);
+  z->InsertNextValue(1.);
+  grid->SetXCoordinates(x.GetPointer());
+  grid->SetYCoordinates(y.GetPointer());
+  grid->SetZCoordinates(z.GetPointer());
+  grid->GenerateTrees();
+  for (vtkIdType t = 0; t < 6; ++t)
+    {
+    cursor = grid->NewCursor(t);
+    cursor->ToRoot();
+    for (vtkIdType l = 0; l < t % 3; ++l)
+      {
+      grid->SubdivideLeaf(cursor, t);
+      cursor->ToChild(4);
+      }
+    cursor->Delete();
+    }
+
+  vtkNew<vtkIdList> trees;
+  grid->GetTreeIndices(trees.GetPointer());
+  TEST_ASSERT(trees->GetNumberOfIds() == 6, "Bad number of trees");
+  grid->GenerateSuperCursorTraversalTable();
+  for (vtkIdType t = 0; t < trees->GetNumberOfIds(); ++t)
+    {
+    TEST_ASSERT(trees->GetId(t) == t, "Bad tree index " << t);
+    vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor superCursor;
+    grid->InitializeSuperCursor(&superCursor, t);
+    vtkIdType leaves = CountLeaves(grid.GetPointer(), &superCursor);
+    TEST_ASSERT(leaves == 1 + 8 * (t % 3),
+                "Bad number of leaves " << leaves << " in tree " << t);
+    }
+
+  return EXIT_SUCCESS;
+}
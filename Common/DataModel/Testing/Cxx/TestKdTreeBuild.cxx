@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestKdTreeBuild.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkKdTree balances large point sets, whose top regions are
+// split in parallel, and that the cells of a data set are assigned to the
+// regions containing their centers.
+
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkKdTree.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+namespace
+{
+bool InBounds(const double bounds[6], const double x[3])
+{
+  return x[0] >= bounds[0] && x[0] <= bounds[1] &&
+         x[1] >= bounds[2] && x[1] <= bounds[3] &&
+         x[2] >= bounds[4] && x[2] <= bounds[5];
+}
+}
+
+int TestKdTreeBuild(int, char *[])
+{
+  // Random points, without ties, split into 2^10 regions.
+  vtkMath::RandomSeed(1618);
+  vtkNew<vtkPoints> points;
+  const vtkIdType numPoints = 300001;
+  points->SetNumberOfPoints(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    points->SetPoint(i, vtkMath::Random(-1.0, 1.0), vtkMath::Random(-2.0, 2.0),
+                     vtkMath::Random(0.0, 0.5));
+    }
+
+  vtkNew<vtkKdTree> tree;
+  tree->SetMinCells(0);
+  tree->SetMaxLevel(10);
+  tree->BuildLocatorFromPoints(points.GetPointer());
+  TEST_ASSERT(tree->GetNumberOfRegions() == 1024,
+              "Bad number of regions " << tree->GetNumberOfRegions());
+
+  // Median splits give regions of the same size, give or take one point.
+  vtkIdType minSize = numPoints, maxSize = 0, total = 0;
+  double bounds[6], x[3];
+  for (int r = 0; r < tree->GetNumberOfRegions(); ++r)
+    {
+    vtkIdTypeArray *ids = tree->GetPointsInRegion(r);
+    const vtkIdType size = ids->GetNumberOfTuples();
+    minSize = size < minSize ? size : minSize;
+    maxSize = size > maxSize ? size : maxSize;
+    total += size;
+    tree->GetRegionBounds(r, bounds);
+    for (vtkIdType i = 0; i < size; ++i)
+      {
+      points->GetPoint(ids->GetValue(i), x);
+      TEST_ASSERT(InBounds(bounds, x), "Point " << ids->GetValue(i)
+                  << " outside of its region " << r);
+      }
+    }
+  TEST_ASSERT(total == numPoints, "Regions hold " << total << " points");
+  TEST_ASSERT(maxSize - minSize <= 1,
+              "Unbalanced regions of " << minSize << " to " << maxSize);
+
+  // The closest points match a brute force search.
+  for (int q = 0; q < 200; ++q)
+    {
+    double y[3] = { vtkMath::Random(-1.0, 1.0), vtkMath::Random(-2.0, 2.0),
+                    vtkMath::Random(0.0, 0.5) };
+    double dist2;
+    vtkIdType closest = tree->FindClosestPoint(y, dist2);
+    double best = VTK_DOUBLE_MAX;
+    for (vtkIdType i = 0; i < numPoints; ++i)
+      {
+      points->GetPoint(i, x);
+      best = std::min(best, vtkMath::Distance2BetweenPoints(x, y));
+      }
+    points->GetPoint(closest, x);
+    TEST_ASSERT(vtkMath::Distance2BetweenPoints(x, y) == best,
+                "Bad closest point of query " << q);
+    }
+
+  // The cells of an image, whose centers have many equal coordinates.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(81, 61, 41);
+  vtkNew<vtkKdTree> cellTree;
+  cellTree->SetDataSet(image.GetPointer());
+  cellTree->SetNumberOfRegionsOrMore(64);
+  cellTree->BuildLocator();
+  TEST_ASSERT(cellTree->GetNumberOfRegions() >= 64,
+              "Too few cell regions " << cellTree->GetNumberOfRegions());
+
+  int *regions = cellTree->AllGetRegionContainingCell();
+  const vtkIdType numCells = image->GetNumberOfCells();
+  int ijk[3];
+  for (vtkIdType i = 0; i < numCells; ++i)
+    {
+    ijk[0] = static_cast<int>(i % 80);
+    ijk[1] = static_cast<int>((i / 80) % 60);
+    ijk[2] = static_cast<int>(i / (80 * 60));
+    double center[3] = { ijk[0] + 0.5, ijk[1] + 0.5, ijk[2] + 0.5 };
+    cellTree->GetRegionBounds(regions[i], bounds);
+    TEST_ASSERT(InBounds(bounds, center),
+                "Cell " << i << " outside of its region " << regions[i]);
+    }
+
+  return EXIT_SUCCESS;
+}
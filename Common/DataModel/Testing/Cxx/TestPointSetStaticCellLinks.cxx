@@ -0,0 +1,148 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPointSetStaticCellLinks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the static cell links cached on point sets against vtkCellLinks,
+// for poly data mixing all the cell types, and their rebuild once the data
+// set is modified.
+
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLinks.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+namespace
+{
+// Compare the links of all the points, in order.
+bool SameLinks(vtkPolyData *pd, vtkStaticCellLinks *links)
+{
+  vtkNew<vtkCellLinks> expected;
+  expected->Allocate(pd->GetNumberOfPoints());
+  expected->BuildLinks(pd);
+  for (vtkIdType ptId = 0; ptId < pd->GetNumberOfPoints(); ++ptId)
+    {
+    vtkIdType ncells = expected->GetNcells(ptId);
+    if (links->GetNumberOfCells(ptId) != ncells)
+      {
+      return false;
+      }
+    const vtkIdType *cells = links->GetCells(ptId);
+    for (vtkIdType i = 0; i < ncells; ++i)
+      {
+      if (cells[i] != expected->GetCells(ptId)[i])
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestPointSetStaticCellLinks(int, char *[])
+{
+  // A 100x100 grid of points, used by vertices, lines, quads and strips.
+  const int n = 100;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < n; ++j)
+    {
+    for (int i = 0; i < n; ++i)
+      {
+      points->InsertNextPoint(i, j, 0.0);
+      }
+    }
+  vtkNew<vtkCellArray> verts, lines, polys, strips;
+  vtkMath::RandomSeed(4142);
+  for (int k = 0; k < 2000; ++k)
+    {
+    vtkIdType p = static_cast<vtkIdType>(vtkMath::Random(0.0, n * n)) % (n * n);
+    verts->InsertNextCell(1, &p);
+    }
+  for (int j = 0; j < n - 1; ++j)
+    {
+    for (int i = 0; i < n - 1; ++i)
+      {
+      vtkIdType p = i + n * j;
+      vtkIdType line[2] = { p, p + 1 };
+      vtkIdType quad[4] = { p, p + 1, p + n + 1, p + n };
+      lines->InsertNextCell(2, line);
+      polys->InsertNextCell(4, quad);
+      }
+    }
+  vtkIdType strip[2 * n];
+  for (int i = 0; i < n; ++i)
+    {
+    strip[2 * i] = i;
+    strip[2 * i + 1] = i + n;
+    }
+  strips->InsertNextCell(2 * n, strip);
+
+  vtkNew<vtkPolyData> pd;
+  pd->SetPoints(points.GetPointer());
+  pd->SetVerts(verts.GetPointer());
+  pd->SetLines(lines.GetPointer());
+  pd->SetPolys(polys.GetPointer());
+  pd->SetStrips(strips.GetPointer());
+
+  vtkStaticCellLinks *links = pd->GetStaticCellLinks();
+  TEST_ASSERT(links != NULL, "No links");
+  TEST_ASSERT(SameLinks(pd.GetPointer(), links), "Bad links");
+  TEST_ASSERT(pd->GetStaticCellLinks() == links, "Links are not cached");
+
+  // The quads sharing the edge of an inner point and its right neighbor.
+  vtkNew<vtkIdList> neighbors;
+  vtkIdType p = 50 + n * 50;
+  vtkIdType quadId = 2000 + (n - 1) * (n - 1) + 50 + (n - 1) * 50;
+  links->GetCellEdgeNeighbors(quadId, p, p + 1, neighbors.GetPointer());
+  TEST_ASSERT(neighbors->GetNumberOfIds() == 2 &&
+              neighbors->GetId(0) == 2000 + 50 + (n - 1) * 50 &&
+              neighbors->GetId(1) == quadId - (n - 1),
+              "Bad edge neighbors " << neighbors->GetNumberOfIds());
+
+  // Points used by no cell, then new cells: the links are rebuilt.
+  points->InsertNextPoint(-1.0, -1.0, 0.0);
+  points->InsertNextPoint(-2.0, -1.0, 0.0);
+  vtkIdType tri[3] = { 0, 1, n * n + 1 };
+  polys->InsertNextCell(3, tri);
+  pd->SetPolys(polys.GetPointer());
+  pd->Modified();
+  pd->DeleteCells();
+  links = pd->GetStaticCellLinks();
+  TEST_ASSERT(links->GetNumberOfCells(n * n) == 0 &&
+              links->GetNumberOfCells(n * n + 1) == 1,
+              "Links are not rebuilt");
+  TEST_ASSERT(SameLinks(pd.GetPointer(), links), "Bad rebuilt links");
+
+  // Without cells.
+  vtkNew<vtkPolyData> empty;
+  empty->SetPoints(points.GetPointer());
+  links = empty->GetStaticCellLinks();
+  TEST_ASSERT(links->GetNumberOfCells(0) == 0 &&
+              links->GetNumberOfCells(n * n + 1) == 0, "Bad empty links");
+
+  return EXIT_SUCCESS;
+}
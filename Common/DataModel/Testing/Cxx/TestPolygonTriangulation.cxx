@@ -0,0 +1,143 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolygonTriangulation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the triangulation of large concave polygons by the grid based ear
+// cut of vtkPolygon, and by the original one for a medium polygon.
+
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolygon.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+namespace
+{
+// A comb with teeth of random lengths in the z = 0 plane, rotated to the
+// plane of normal (1, 2, 3). The bases of the teeth are not aligned, as
+// the ear cuts cannot triangulate the collinear vertices left at the end.
+void MakeComb(vtkPolygon *polygon, int numTeeth)
+{
+  std::vector<double> uv;
+  for (int i = 0; i < numTeeth; ++i)
+    {
+    double length = vtkMath::Random(1.0, 10.0);
+    uv.push_back(i);
+    uv.push_back(vtkMath::Random(-0.1, 0.1));
+    uv.push_back(i + vtkMath::Random(0.4, 0.6));
+    uv.push_back(length);
+    }
+  uv.push_back(numTeeth);
+  uv.push_back(0.0);
+  uv.push_back(numTeeth);
+  uv.push_back(-1.0);
+  uv.push_back(0.0);
+  uv.push_back(-1.0);
+
+  double n[3] = { 1.0, 2.0, 3.0 }, u[3], v[3];
+  vtkMath::Normalize(n);
+  vtkMath::Perpendiculars(n, u, v, 0.3);
+  vtkIdType numPts = static_cast<vtkIdType>(uv.size() / 2);
+  polygon->GetPointIds()->SetNumberOfIds(numPts);
+  polygon->GetPoints()->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+      {
+      x[j] = uv[2 * i] * u[j] + uv[2 * i + 1] * v[j] + 5.0 * n[j];
+      }
+    polygon->GetPointIds()->SetId(i, i);
+    polygon->GetPoints()->SetPoint(i, x);
+    }
+}
+
+// The triangles must have the orientation of the polygon and cover its
+// area.
+int CheckTriangulation(vtkPolygon *polygon, vtkIdList *tris)
+{
+  vtkIdType numPts = polygon->GetNumberOfPoints();
+  TEST_ASSERT(tris->GetNumberOfIds() == 3 * (numPts - 2),
+              "Bad number of triangles " << tris->GetNumberOfIds() / 3);
+  double n[3];
+  vtkPolygon::ComputeNormal(polygon->GetPoints(), n);
+  double area = 0.0;
+  for (vtkIdType t = 0; t < tris->GetNumberOfIds(); t += 3)
+    {
+    double x0[3], x1[3], x2[3], v1[3], v2[3], c[3];
+    polygon->GetPoints()->GetPoint(tris->GetId(t), x0);
+    polygon->GetPoints()->GetPoint(tris->GetId(t + 1), x1);
+    polygon->GetPoints()->GetPoint(tris->GetId(t + 2), x2);
+    for (int j = 0; j < 3; ++j)
+      {
+      v1[j] = x1[j] - x0[j];
+      v2[j] = x2[j] - x0[j];
+      }
+    vtkMath::Cross(v1, v2, c);
+    double a = 0.5 * vtkMath::Dot(c, n);
+    TEST_ASSERT(a > 0.0, "Inverted triangle " << t / 3);
+    area += a;
+    }
+  double expected = polygon->ComputeArea();
+  TEST_ASSERT(fabs(area - expected) < 1e-6 * expected,
+              "Bad area " << area << " instead of " << expected);
+  return EXIT_SUCCESS;
+}
+}
+
+int TestPolygonTriangulation(int, char *[])
+{
+  vtkMath::RandomSeed(1234);
+  vtkNew<vtkPolygon> polygon;
+  TEST_ASSERT(polygon->GetFastTriangulationThreshold() == 64,
+              "Bad default threshold");
+
+  // Both methods triangulate a medium polygon.
+  MakeComb(polygon.GetPointer(), 200);
+  vtkNew<vtkIdList> fast;
+  TEST_ASSERT(polygon->Triangulate(fast.GetPointer()),
+              "Fast triangulation failed");
+  if (CheckTriangulation(polygon.GetPointer(), fast.GetPointer()) !=
+      EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+  polygon->SetFastTriangulationThreshold(VTK_INT_MAX);
+  vtkNew<vtkIdList> original;
+  TEST_ASSERT(polygon->Triangulate(original.GetPointer()),
+              "Original triangulation failed");
+  if (CheckTriangulation(polygon.GetPointer(), original.GetPointer()) !=
+      EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A polygon too large for the original method.
+  polygon->SetFastTriangulationThreshold(64);
+  MakeComb(polygon.GetPointer(), 25000);
+  TEST_ASSERT(polygon->Triangulate(fast.GetPointer()),
+              "Fast triangulation of the large polygon failed");
+  return CheckTriangulation(polygon.GetPointer(), fast.GetPointer());
+}
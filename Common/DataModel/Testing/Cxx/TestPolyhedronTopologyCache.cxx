@@ -0,0 +1,244 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyhedronTopologyCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the polyhedron cells of an unstructured grid with a cached
+// polyhedral topology have the same faces and edges, and contour the same,
+// as when their topology is derived from their face streams.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyhedron.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+namespace
+{
+const int Size = 4;
+
+vtkIdType PointId(int i, int j, int k)
+{
+  return i + (Size + 1) * (j + (Size + 1) * k);
+}
+
+// A lattice of cubes as polyhedra, with a tetrahedron after each of them.
+// The point ids of the cells are rotated so that the canonical ids differ
+// from the order of the points in the faces.
+void MakeGrid(vtkUnstructuredGrid *grid, double shift)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  for (int k = 0; k <= Size; ++k)
+    {
+    for (int j = 0; j <= Size; ++j)
+      {
+      for (int i = 0; i <= Size; ++i)
+        {
+        points->InsertNextPoint(i, j, k);
+        scalars->InsertNextValue(i + 2.0 * j + 3.0 * k + shift);
+        }
+      }
+    }
+  grid->Initialize();
+  grid->Allocate();
+  grid->SetPoints(points.GetPointer());
+  grid->GetPointData()->SetScalars(scalars.GetPointer());
+
+  const int corners[8][3] = { {0,0,0}, {1,0,0}, {1,1,0}, {0,1,0},
+                              {0,0,1}, {1,0,1}, {1,1,1}, {0,1,1} };
+  const int faces[6][4] = { {0,3,2,1}, {4,5,6,7}, {0,1,5,4},
+                            {1,2,6,5}, {2,3,7,6}, {3,0,4,7} };
+  for (int k = 0; k < Size; ++k)
+    {
+    for (int j = 0; j < Size; ++j)
+      {
+      for (int i = 0; i < Size; ++i)
+        {
+        vtkIdType ids[8];
+        for (int c = 0; c < 8; ++c)
+          {
+          ids[c] = PointId(i + corners[c][0], j + corners[c][1],
+                           k + corners[c][2]);
+          }
+        int rotation = (i + j + k) % 8;
+        vtkIdType cellIds[8];
+        for (int c = 0; c < 8; ++c)
+          {
+          cellIds[c] = ids[(c + rotation) % 8];
+          }
+        vtkIdType stream[30];
+        for (int f = 0; f < 6; ++f)
+          {
+          stream[5 * f] = 4;
+          for (int c = 0; c < 4; ++c)
+            {
+            stream[5 * f + 1 + c] = ids[faces[f][c]];
+            }
+          }
+        grid->InsertNextCell(VTK_POLYHEDRON, 8, cellIds, 6, stream);
+        vtkIdType tet[4] = { ids[0], ids[1], ids[3], ids[4] };
+        grid->InsertNextCell(VTK_TETRA, 4, tet);
+        }
+      }
+    }
+}
+
+// Compare the polyhedra of the grid with and without cache.
+int Compare(vtkUnstructuredGrid *grid)
+{
+  vtkNew<vtkGenericCell> generic;
+  vtkNew<vtkPolyhedron> reference;
+  vtkDataArray *scalars = grid->GetPointData()->GetScalars();
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+    {
+    if (grid->GetCellType(cellId) != VTK_POLYHEDRON)
+      {
+      continue;
+      }
+    grid->SetCachePolyhedronTopology(false);
+    grid->GetCell(cellId, generic.GetPointer());
+    reference->DeepCopy(generic.GetPointer());
+    reference->SetFaces(generic->GetFaces());
+    reference->Initialize();
+
+    grid->SetCachePolyhedronTopology(true);
+    for (int pass = 0; pass < 2; ++pass)
+      {
+      vtkCell *cell;
+      if (pass == 0)
+        {
+        cell = grid->GetCell(cellId);
+        }
+      else
+        {
+        grid->GetCell(cellId, generic.GetPointer());
+        cell = generic->GetRepresentativeCell();
+        }
+      vtkPolyhedron *polyhedron = vtkPolyhedron::SafeDownCast(cell);
+      TEST_ASSERT(polyhedron, "Not a polyhedron");
+      TEST_ASSERT(polyhedron->GetNumberOfFaces() == 6 &&
+                  polyhedron->GetNumberOfEdges() == 12 &&
+                  reference->GetNumberOfEdges() == 12,
+                  "Bad topology of cell " << cellId);
+      for (int e = 0; e < 12; ++e)
+        {
+        vtkCell *edge = polyhedron->GetEdge(e);
+        vtkCell *expected = reference->GetEdge(e);
+        TEST_ASSERT(edge->GetPointId(0) == expected->GetPointId(0) &&
+                    edge->GetPointId(1) == expected->GetPointId(1),
+                    "Bad edge " << e << " of cell " << cellId);
+        }
+      for (int f = 0; f < 6; ++f)
+        {
+        vtkCell *face = polyhedron->GetFace(f);
+        vtkCell *expected = reference->GetFace(f);
+        for (int i = 0; i < 4; ++i)
+          {
+          double x[3], y[3];
+          face->GetPoints()->GetPoint(i, x);
+          expected->GetPoints()->GetPoint(i, y);
+          TEST_ASSERT(face->GetPointId(i) == expected->GetPointId(i) &&
+                      x[0] == y[0] && x[1] == y[1] && x[2] == y[2],
+                      "Bad face " << f << " of cell " << cellId);
+          }
+        }
+
+      // Contour near the middle of the cell, away from its vertices. The
+      // scalars are given in the canonical order, as the filters do.
+      vtkNew<vtkDoubleArray> cellScalars;
+      double value = 0.123;
+      for (int i = 0; i < 8; ++i)
+        {
+        double s = scalars->GetTuple1(polyhedron->GetPointId(i));
+        cellScalars->InsertNextValue(s);
+        value += s / 8.0;
+        }
+      vtkIdType numPts[2], numPolys[2];
+      for (int c = 0; c < 2; ++c)
+        {
+        vtkPolyhedron *contoured = c == 0 ? polyhedron : reference.GetPointer();
+        vtkNew<vtkPoints> outPoints;
+        vtkNew<vtkMergePoints> locator;
+        double bounds[6] = { -1, Size + 1, -1, Size + 1, -1, Size + 1 };
+        locator->InitPointInsertion(outPoints.GetPointer(), bounds);
+        vtkNew<vtkCellArray> verts, lines, polys;
+        vtkNew<vtkPointData> outPd;
+        vtkNew<vtkCellData> inCd, outCd;
+        contoured->Contour(value, cellScalars.GetPointer(), locator.GetPointer(),
+                           verts.GetPointer(), lines.GetPointer(),
+                           polys.GetPointer(), grid->GetPointData(),
+                           outPd.GetPointer(), inCd.GetPointer(), cellId,
+                           outCd.GetPointer());
+        numPts[c] = outPoints->GetNumberOfPoints();
+        numPolys[c] = polys->GetNumberOfCells();
+        }
+      TEST_ASSERT(numPts[0] == numPts[1] && numPolys[0] == numPolys[1] &&
+                  numPolys[0] > 0, "Bad contour of cell " << cellId);
+      }
+    }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestPolyhedronTopologyCache(int, char *[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  TEST_ASSERT(!grid->GetCachePolyhedronTopology(), "Cache on by default");
+  MakeGrid(grid.GetPointer(), 0.0);
+  if (Compare(grid.GetPointer()) != EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The cache follows the changes of the cells.
+  unsigned long size = grid->GetActualMemorySize();
+  MakeGrid(grid.GetPointer(), 0.5);
+  vtkIdType ids[8], stream[30];
+  for (int i = 0; i < 8; ++i)
+    {
+    ids[i] = PointId(Size - i % 2, Size - (i / 2) % 2, Size - i / 4);
+    }
+  const int faces[6][4] = { {0,2,3,1}, {4,5,7,6}, {0,1,5,4},
+                            {1,3,7,5}, {3,2,6,7}, {2,0,4,6} };
+  for (int f = 0; f < 6; ++f)
+    {
+    stream[5 * f] = 4;
+    for (int c = 0; c < 4; ++c)
+      {
+      stream[5 * f + 1 + c] = ids[faces[f][c]];
+      }
+    }
+  grid->InsertNextCell(VTK_POLYHEDRON, 8, ids, 6, stream);
+  if (Compare(grid.GetPointer()) != EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+  TEST_ASSERT(grid->GetActualMemorySize() >= size, "Cache not accounted");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,237 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the queries of vtkStaticCellLocator against the cells of an image,
+// whose cell ids are known, and a flat triangle mesh.
+
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLocator.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+namespace
+{
+// Locate points of the image from several threads and count the errors.
+class FindImageCells
+{
+public:
+  vtkStaticCellLocator *Locator;
+  const std::vector<double> &Points;
+  const std::vector<vtkIdType> &Expected;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<int> Errors;
+
+  FindImageCells(vtkStaticCellLocator *loc, const std::vector<double> &pts,
+                 const std::vector<vtkIdType> &expected) :
+    Locator(loc), Points(pts), Expected(expected)
+    {
+    }
+
+  void Initialize()
+    {
+    this->Errors.Local() = 0;
+    }
+
+  void operator()(vtkIdType i, vtkIdType end)
+    {
+    vtkGenericCell *cell = this->Cell.Local();
+    int &errors = this->Errors.Local();
+    double x[3], pcoords[3], weights[8];
+    for ( ; i < end; ++i )
+      {
+      x[0] = this->Points[3*i];
+      x[1] = this->Points[3*i+1];
+      x[2] = this->Points[3*i+2];
+      if (this->Locator->FindCell(x, 0.0, cell, pcoords, weights) !=
+          this->Expected[i])
+        {
+        ++errors;
+        }
+      }
+    }
+
+  void Reduce()
+    {
+    }
+};
+}
+
+int TestStaticCellLocator(int, char *[])
+{
+  // A 20x20x20 cell image with cells of width 0.1, from (-1,-1,-1).
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(21, 21, 21);
+  image->SetOrigin(-1.0, -1.0, -1.0);
+  image->SetSpacing(0.1, 0.1, 0.1);
+
+  vtkNew<vtkStaticCellLocator> locator;
+  locator->SetDataSet(image.GetPointer());
+  locator->SetNumberOfCellsPerNode(5);
+  locator->BuildLocator();
+  TEST_ASSERT(locator->GetNumberOfBins() > 1000 &&
+              locator->GetNumberOfBins() < 2500,
+              "Bad number of bins " << locator->GetNumberOfBins());
+
+  // Random points, away from the cell faces, and their cells.
+  const vtkIdType numPoints = 10000;
+  std::vector<double> points(3 * numPoints);
+  std::vector<vtkIdType> expected(numPoints);
+  vtkMath::RandomSeed(31415);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    int ijk[3];
+    for (int j = 0; j < 3; ++j)
+      {
+      ijk[j] = static_cast<int>(vtkMath::Random(0.0, 20.0)) % 20;
+      points[3*i+j] = -1.0 + 0.1 * (ijk[j] + vtkMath::Random(0.05, 0.95));
+      }
+    expected[i] = ijk[0] + 20 * (ijk[1] + 20 * ijk[2]);
+    }
+
+  vtkNew<vtkGenericCell> cell;
+  double pcoords[3], weights[8];
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    double *x = &points[3*i];
+    vtkIdType cellId =
+      locator->FindCell(x, 0.0, cell.GetPointer(), pcoords, weights);
+    TEST_ASSERT(cellId == expected[i],
+                "Point " << i << " found in cell " << cellId << " instead of "
+                << expected[i]);
+    double sum = 0.0;
+    for (int j = 0; j < 8; ++j)
+      {
+      sum += weights[j];
+      }
+    TEST_ASSERT(fabs(sum - 1.0) < 1e-6, "Bad weights of point " << i);
+    }
+
+  // Points outside the image are only found within the tolerance.
+  double outside[3] = { 1.05, 0.01, 0.01 };
+  TEST_ASSERT(locator->FindCell(outside, 0.0, cell.GetPointer(), pcoords,
+                                weights) == -1, "Found an outside point");
+  vtkIdType cellId = locator->FindCell(outside, 0.01, cell.GetPointer(),
+                                       pcoords, weights);
+  TEST_ASSERT(cellId == 19 + 20 * (10 + 20 * 10),
+              "Outside point within tolerance found in " << cellId);
+
+  // The same queries from several threads.
+  FindImageCells finder(locator.GetPointer(), points, expected);
+  vtkSMPTools::For(0, numPoints, finder);
+  int errors = 0;
+  for (vtkSMPThreadLocal<int>::iterator it = finder.Errors.begin();
+       it != finder.Errors.end(); ++it)
+    {
+    errors += *it;
+    }
+  TEST_ASSERT(errors == 0, errors << " errors in threaded FindCell");
+
+  // A ray along x enters the image at its first cell.
+  double p1[3] = { -2.0, 0.01, 0.01 }, p2[3] = { 2.0, 0.01, 0.01 };
+  double t, x[3];
+  int subId;
+  TEST_ASSERT(locator->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId,
+                                         cellId, cell.GetPointer()),
+              "Ray misses the image");
+  TEST_ASSERT(fabs(t - 0.25) < 1e-6 && fabs(x[0] + 1.0) < 1e-6 &&
+              cellId == 20 * (10 + 20 * 10) &&
+              cell->GetCellType() == VTK_VOXEL,
+              "Bad ray intersection t=" << t << " cell " << cellId);
+
+  // Rays the other way and past the image.
+  TEST_ASSERT(locator->IntersectWithLine(p2, p1, 0.0, t, x, pcoords, subId,
+                                         cellId, cell.GetPointer()) &&
+              fabs(t - 0.25) < 1e-6 && cellId == 19 + 20 * (10 + 20 * 10),
+              "Bad reverse ray intersection " << cellId);
+  double p3[3] = { -2.0, 1.5, 0.0 };
+  TEST_ASSERT(!locator->IntersectWithLine(p1, p3, 0.0, t, x, pcoords, subId,
+                                          cellId, cell.GetPointer()),
+              "Ray outside the image intersects it");
+
+  vtkNew<vtkIdList> cells;
+  double bbox[6] = { -0.95, -0.85, -0.95, -0.95, -0.95, -0.95 };
+  locator->FindCellsWithinBounds(bbox, cells.GetPointer());
+  TEST_ASSERT(cells->GetNumberOfIds() == 2 && cells->GetId(0) == 0 &&
+              cells->GetId(1) == 1,
+              "Bad cells within bounds " << cells->GetNumberOfIds());
+  locator->FindCellsAlongLine(p1, p2, 0.0, cells.GetPointer());
+  TEST_ASSERT(cells->GetNumberOfIds() >= 20, "Too few cells along line");
+
+  // A flat mesh of 2x50x50 triangles in z = 0. The locator must not divide
+  // the z direction.
+  vtkNew<vtkPoints> meshPoints;
+  for (int j = 0; j <= 50; ++j)
+    {
+    for (int i = 0; i <= 50; ++i)
+      {
+      meshPoints->InsertNextPoint(0.02 * i, 0.02 * j, 0.0);
+      }
+    }
+  vtkNew<vtkCellArray> tris;
+  for (int j = 0; j < 50; ++j)
+    {
+    for (int i = 0; i < 50; ++i)
+      {
+      vtkIdType p = i + 51 * j;
+      vtkIdType t1[3] = { p, p + 1, p + 52 };
+      vtkIdType t2[3] = { p, p + 52, p + 51 };
+      tris->InsertNextCell(3, t1);
+      tris->InsertNextCell(3, t2);
+      }
+    }
+  vtkNew<vtkPolyData> mesh;
+  mesh->SetPoints(meshPoints.GetPointer());
+  mesh->SetPolys(tris.GetPointer());
+
+  vtkNew<vtkStaticCellLocator> meshLocator;
+  meshLocator->SetDataSet(mesh.GetPointer());
+  meshLocator->BuildLocator();
+  int *divs = meshLocator->GetDivisions();
+  TEST_ASSERT(divs[2] == 1 && divs[0] == divs[1] && divs[0] > 10,
+              "Bad divisions " << divs[0] << " " << divs[1] << " " << divs[2]);
+
+  double q1[3] = { 0.515, 0.505, 1.0 }, q2[3] = { 0.515, 0.505, -1.0 };
+  TEST_ASSERT(meshLocator->IntersectWithLine(q1, q2, 1e-6, t, x, pcoords,
+                                             subId, cellId,
+                                             cell.GetPointer()) &&
+              fabs(t - 0.5) < 1e-6 && cellId == 2 * (25 + 50 * 25) &&
+              cell->GetCellType() == VTK_TRIANGLE,
+              "Bad mesh intersection t=" << t << " cell " << cellId);
+
+  double y[3] = { 0.515, 0.505, 0.0 };
+  TEST_ASSERT(meshLocator->FindCell(y, 1e-12, cell.GetPointer(), pcoords,
+                                    weights) == cellId,
+              "Bad mesh cell");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticPointLocatorQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the batched queries of vtkStaticPointLocator return the same
+// points as the single point queries.
+
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+int TestStaticPointLocatorQueries(int, char *[])
+{
+  vtkMath::RandomSeed(2718);
+  vtkNew<vtkPoints> points;
+  const vtkIdType numPoints = 20000;
+  points->SetNumberOfPoints(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    points->SetPoint(i, vtkMath::Random(-1.0, 1.0), vtkMath::Random(-1.0, 1.0),
+                     vtkMath::Random(-0.2, 0.2));
+    }
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points.GetPointer());
+
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(polyData.GetPointer());
+  locator->BuildLocator();
+
+  // Queries partly outside the points.
+  vtkNew<vtkPoints> queries;
+  const vtkIdType numQueries = 5000;
+  queries->SetNumberOfPoints(numQueries);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+    {
+    queries->SetPoint(i, vtkMath::Random(-1.2, 1.2),
+                      vtkMath::Random(-1.2, 1.2), vtkMath::Random(-0.5, 0.5));
+    }
+
+  vtkNew<vtkIdTypeArray> closest;
+  locator->FindClosestPoints(queries.GetPointer(), closest.GetPointer());
+  TEST_ASSERT(closest->GetNumberOfTuples() == numQueries,
+              "Bad number of closest points");
+  for (vtkIdType i = 0; i < numQueries; ++i)
+    {
+    TEST_ASSERT(closest->GetValue(i) ==
+                locator->FindClosestPoint(queries->GetPoint(i)),
+                "Bad closest point of query " << i);
+    }
+
+  const int N = 7;
+  vtkNew<vtkIdTypeArray> nClosest;
+  vtkNew<vtkIdList> ids;
+  locator->FindClosestNPoints(N, queries.GetPointer(), nClosest.GetPointer());
+  TEST_ASSERT(nClosest->GetNumberOfComponents() == N &&
+              nClosest->GetNumberOfTuples() == numQueries,
+              "Bad closest N points layout");
+  for (vtkIdType i = 0; i < numQueries; ++i)
+    {
+    locator->FindClosestNPoints(N, queries->GetPoint(i), ids.GetPointer());
+    for (int j = 0; j < N; ++j)
+      {
+      TEST_ASSERT(nClosest->GetValue(N * i + j) == ids->GetId(j),
+                  "Bad closest N points of query " << i);
+      }
+    }
+
+  const double R = 0.05;
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> within;
+  locator->FindPointsWithinRadius(R, queries.GetPointer(),
+                                  offsets.GetPointer(), within.GetPointer());
+  TEST_ASSERT(offsets->GetNumberOfTuples() == numQueries + 1 &&
+              offsets->GetValue(0) == 0 &&
+              offsets->GetValue(numQueries) == within->GetNumberOfTuples(),
+              "Bad radius offsets");
+  vtkIdType numFound = 0;
+  for (vtkIdType i = 0; i < numQueries; ++i)
+    {
+    locator->FindPointsWithinRadius(R, queries->GetPoint(i), ids.GetPointer());
+    std::vector<vtkIdType> expected(ids->GetPointer(0),
+                                    ids->GetPointer(0) + ids->GetNumberOfIds());
+    std::vector<vtkIdType> found(
+      within->GetPointer(0) + offsets->GetValue(i),
+      within->GetPointer(0) + offsets->GetValue(i + 1));
+    std::sort(expected.begin(), expected.end());
+    std::sort(found.begin(), found.end());
+    TEST_ASSERT(expected == found, "Bad points within radius of query " << i);
+    numFound += static_cast<vtkIdType>(found.size());
+    }
+  TEST_ASSERT(numFound > numQueries, "Too few points within radius");
+
+  // Fewer points than N are padded.
+  vtkNew<vtkPoints> fewPoints;
+  fewPoints->InsertNextPoint(0.0, 0.0, 0.0);
+  fewPoints->InsertNextPoint(1.0, 0.0, 0.0);
+  vtkNew<vtkPolyData> fewPolyData;
+  fewPolyData->SetPoints(fewPoints.GetPointer());
+  vtkNew<vtkStaticPointLocator> fewLocator;
+  fewLocator->SetDataSet(fewPolyData.GetPointer());
+  fewLocator->FindClosestNPoints(3, fewPoints.GetPointer(),
+                                 nClosest.GetPointer());
+  TEST_ASSERT(nClosest->GetValue(0) == 0 && nClosest->GetValue(1) == 1 &&
+              nClosest->GetValue(2) == -1 && nClosest->GetValue(3) == 1 &&
+              nClosest->GetValue(5) == -1, "Bad padded closest N points");
+
+  return EXIT_SUCCESS;
+}
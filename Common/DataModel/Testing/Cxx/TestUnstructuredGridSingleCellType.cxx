@@ -0,0 +1,257 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestUnstructuredGridSingleCellType.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that unstructured grids with the single cell type storage give the
+// same cells as with the general storage, and their switch to the general
+// storage.
+
+#include "vtkCellArray.h"
+#include "vtkCellIterator.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return false;                                                     \
+    }
+
+namespace
+{
+// Compare the cells of two grids, through all the access methods.
+bool SameCells(vtkUnstructuredGrid *grid, vtkUnstructuredGrid *expected)
+{
+  TEST_ASSERT(grid->GetNumberOfCells() == expected->GetNumberOfCells(),
+              "Bad number of cells " << grid->GetNumberOfCells());
+  vtkNew<vtkIdList> ids, expectedIds;
+  vtkNew<vtkGenericCell> cell;
+  double bounds[6], expectedBounds[6];
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+    {
+    TEST_ASSERT(grid->GetCellType(cellId) == expected->GetCellType(cellId),
+                "Bad type of cell " << cellId);
+    grid->GetCellPoints(cellId, ids.GetPointer());
+    expected->GetCellPoints(cellId, expectedIds.GetPointer());
+    TEST_ASSERT(ids->GetNumberOfIds() == expectedIds->GetNumberOfIds(),
+                "Bad size of cell " << cellId);
+    vtkIdType npts;
+    const vtkIdType *pts;
+    grid->GetCellPoints(cellId, npts, pts, ids.GetPointer());
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      TEST_ASSERT(pts[i] == expectedIds->GetId(i),
+                  "Bad points of cell " << cellId);
+      }
+    grid->GetCell(cellId, cell.GetPointer());
+    TEST_ASSERT(cell->GetCellType() == expected->GetCellType(cellId) &&
+                cell->GetPointId(npts - 1) == expectedIds->GetId(npts - 1),
+                "Bad generic cell " << cellId);
+    TEST_ASSERT(grid->GetCell(cellId)->GetPointId(0) == expectedIds->GetId(0),
+                "Bad cell " << cellId);
+    grid->GetCellBounds(cellId, bounds);
+    expected->GetCellBounds(cellId, expectedBounds);
+    for (int i = 0; i < 6; ++i)
+      {
+      TEST_ASSERT(bounds[i] == expectedBounds[i],
+                  "Bad bounds of cell " << cellId);
+      }
+    }
+
+  // Skip some of the cells during the traversal.
+  vtkSmartPointer<vtkCellIterator> iter =
+    vtkSmartPointer<vtkCellIterator>::Take(grid->NewCellIterator());
+  vtkIdType numCells = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+    {
+    vtkIdType cellId = iter->GetCellId();
+    TEST_ASSERT(cellId == numCells++, "Bad iterator cell id " << cellId);
+    TEST_ASSERT(iter->GetCellType() == expected->GetCellType(cellId),
+                "Bad iterator type of cell " << cellId);
+    if (cellId % 3 == 0)
+      {
+      expected->GetCellPoints(cellId, expectedIds.GetPointer());
+      TEST_ASSERT(iter->GetPointIds()->GetNumberOfIds() ==
+                  expectedIds->GetNumberOfIds() &&
+                  iter->GetPointIds()->GetId(2) == expectedIds->GetId(2),
+                  "Bad iterator points of cell " << cellId);
+      }
+    }
+  TEST_ASSERT(numCells == expected->GetNumberOfCells(),
+              "Bad iterator number of cells " << numCells);
+  return true;
+}
+
+bool TestSingleCellType(int storageMode)
+{
+  // A 10x10x10 grid of hexahedra.
+  const int n = 11;
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < n; ++k)
+    {
+    for (int j = 0; j < n; ++j)
+      {
+      for (int i = 0; i < n; ++i)
+        {
+        points->InsertNextPoint(i, j + 0.1 * i, k);
+        }
+      }
+    }
+  vtkNew<vtkCellArray> hexes;
+  hexes->SetStorageMode(storageMode);
+  vtkNew<vtkUnstructuredGrid> expected;
+  expected->SetPoints(points.GetPointer());
+  expected->Allocate((n - 1) * (n - 1) * (n - 1));
+  for (int k = 0; k < n - 1; ++k)
+    {
+    for (int j = 0; j < n - 1; ++j)
+      {
+      for (int i = 0; i < n - 1; ++i)
+        {
+        vtkIdType p = i + n * (j + n * k);
+        vtkIdType hex[8] = { p, p + 1, p + n + 1, p + n, p + n * n,
+                             p + n * n + 1, p + n * n + n + 1, p + n * n + n };
+        hexes->InsertNextCell(8, hex);
+        expected->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        }
+      }
+    }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points.GetPointer());
+  grid->SetCells(VTK_HEXAHEDRON, hexes.GetPointer());
+  TEST_ASSERT(grid->GetSingleCellType() == VTK_HEXAHEDRON &&
+              grid->GetSingleCellSize() == 8, "No single cell type storage");
+  TEST_ASSERT(grid->IsHomogeneous() == 1, "Not homogeneous");
+  TEST_ASSERT(grid->GetActualMemorySize() < expected->GetActualMemorySize(),
+              "No memory saved");
+  if (!SameCells(grid.GetPointer(), expected.GetPointer()))
+    {
+    return false;
+    }
+
+  // Copies keep the storage.
+  vtkNew<vtkUnstructuredGrid> shallow, deep;
+  shallow->ShallowCopy(grid.GetPointer());
+  deep->DeepCopy(grid.GetPointer());
+  TEST_ASSERT(shallow->GetSingleCellType() == VTK_HEXAHEDRON &&
+              deep->GetSingleCellType() == VTK_HEXAHEDRON,
+              "Copies lost the single cell type storage");
+  if (!SameCells(deep.GetPointer(), expected.GetPointer()))
+    {
+    return false;
+    }
+
+  // The types and locations arrays switch to the general storage.
+  vtkUnsignedCharArray *types = shallow->GetCellTypesArray();
+  TEST_ASSERT(shallow->GetSingleCellType() == -1 && types &&
+              types->GetNumberOfTuples() == grid->GetNumberOfCells() &&
+              types->GetValue(5) == VTK_HEXAHEDRON &&
+              shallow->GetCellLocationsArray()->GetValue(5) ==
+              (storageMode == vtkCellArray::OFFSETS_STORAGE ? 5 : 5 * 9),
+              "Bad built types and locations");
+  if (!SameCells(shallow.GetPointer(), expected.GetPointer()))
+    {
+    return false;
+    }
+
+  // Inserting cells of the same type keeps the storage, another type
+  // switches to the general storage.
+  vtkIdType hex[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  vtkIdType tri[3] = { 0, 1, 2 };
+  vtkIdType hexId = deep->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+  expected->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+  TEST_ASSERT(hexId == expected->GetNumberOfCells() - 1 &&
+              deep->GetSingleCellType() == VTK_HEXAHEDRON,
+              "Bad insertion of a cell of the same type");
+  vtkIdType triId = deep->InsertNextCell(VTK_TRIANGLE, 3, tri);
+  expected->InsertNextCell(VTK_TRIANGLE, 3, tri);
+  TEST_ASSERT(triId == hexId + 1 && deep->GetSingleCellType() == -1,
+              "Bad insertion of a cell of another type");
+  return SameCells(deep.GetPointer(), expected.GetPointer());
+}
+
+bool TestAllocateSingleCellType()
+{
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 100; ++i)
+    {
+    points->InsertNextPoint(i, i % 7, i % 3);
+    }
+  vtkNew<vtkUnstructuredGrid> grid, expected;
+  grid->SetPoints(points.GetPointer());
+  expected->SetPoints(points.GetPointer());
+  grid->AllocateSingleCellType(VTK_TETRA, 4, 50);
+  expected->Allocate(50);
+  vtkNew<vtkIdList> tet;
+  tet->SetNumberOfIds(4);
+  for (vtkIdType i = 0; i < 96; ++i)
+    {
+    for (vtkIdType j = 0; j < 4; ++j)
+      {
+      tet->SetId(j, i + j);
+      }
+    grid->InsertNextCell(VTK_TETRA, tet.GetPointer());
+    expected->InsertNextCell(VTK_TETRA, tet.GetPointer());
+    }
+  TEST_ASSERT(grid->GetSingleCellType() == VTK_TETRA &&
+              grid->GetSingleCellSize() == 4, "Bad allocated storage");
+  vtkNew<vtkIdTypeArray> ids;
+  grid->GetIdsOfCellsOfType(VTK_TETRA, ids.GetPointer());
+  TEST_ASSERT(ids->GetNumberOfTuples() == 96 && ids->GetValue(95) == 95,
+              "Bad ids of cells of type");
+  if (!SameCells(grid.GetPointer(), expected.GetPointer()))
+    {
+    return false;
+    }
+
+  // Cells of the same type with another size.
+  vtkIdType pts[5] = { 0, 1, 2, 3, 4 };
+  grid->InsertNextCell(VTK_POLYGON, 5, pts);
+  grid->InsertNextCell(VTK_POLYGON, 4, pts);
+  TEST_ASSERT(grid->GetSingleCellType() == -1 &&
+              grid->GetCellType(96) == VTK_POLYGON &&
+              grid->GetCellType(95) == VTK_TETRA, "Bad switch of storage");
+
+  // Cells of different sizes keep the general storage.
+  vtkNew<vtkCellArray> polygons;
+  polygons->InsertNextCell(5, pts);
+  polygons->InsertNextCell(4, pts);
+  grid->SetCells(VTK_POLYGON, polygons.GetPointer());
+  TEST_ASSERT(grid->GetSingleCellType() == -1 &&
+              grid->GetCellTypesArray()->GetNumberOfTuples() == 2,
+              "Bad storage of polygons");
+  return true;
+}
+}
+
+int TestUnstructuredGridSingleCellType(int, char *[])
+{
+  if (!TestSingleCellType(vtkCellArray::LEGACY_STORAGE) ||
+      !TestSingleCellType(vtkCellArray::OFFSETS_STORAGE) ||
+      !TestAllocateSingleCellType())
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -21,7 +21,11 @@
 #include "vtkBoundingBox.h"
 #include "vtkAMRBox.h"
 #include "vtkDoubleArray.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <set>
 
 vtkStandardNewMacro(vtkAMRInformation);
@@ -131,6 +135,177 @@ namespace
   };
 };
 
+//----------------------------------------------------------------------------
+// Uniform bins over the boxes of each level, in world coordinates. Each box
+// is listed, in increasing id order, in all the bins its closed bounds
+// overlap, so that the grids of a bin are the only ones of the level that
+// may contain a point of the bin, and are tested in the order of a linear
+// scan of the level.
+class vtkAMRInformationBlockLocator
+{
+public:
+  struct LevelBins
+  {
+    double Min[3];
+    double Max[3];
+    double Width[3];
+    int Dims[3];
+    std::vector<vtkIdType> Offsets; // Offsets[bin] to Offsets[bin+1] in Ids
+    std::vector<unsigned int> Ids;
+
+    LevelBins()
+    {
+      for (int i = 0; i < 3; i++)
+        {
+        this->Min[i] = 0.0;
+        this->Max[i] = -1.0;
+        this->Width[i] = 1.0;
+        this->Dims[i] = 1;
+        }
+    }
+
+    int GetBinIndex(int axis, double x) const
+    {
+      int i = static_cast<int>(floor((x - this->Min[axis]) / this->Width[axis]));
+      return i < 0 ? 0 : (i >= this->Dims[axis] ? this->Dims[axis] - 1 : i);
+    }
+
+    vtkIdType GetBin(int i, int j, int k) const
+    {
+      return k + static_cast<vtkIdType>(this->Dims[2]) *
+        (j + static_cast<vtkIdType>(this->Dims[1]) * i);
+    }
+  };
+
+  std::vector<LevelBins> Levels;
+
+  // Return the grids of level that may contain q, in increasing order.
+  const unsigned int* GetCandidates(unsigned int level, const double q[3],
+                                    vtkIdType& n) const
+  {
+    n = 0;
+    if (level >= this->Levels.size())
+      {
+      return NULL;
+      }
+    const LevelBins& bins = this->Levels[level];
+    int ijk[3];
+    for (int i = 0; i < 3; i++)
+      {
+      // also rejects NaN coordinates
+      if (!(q[i] >= bins.Min[i] && q[i] <= bins.Max[i]))
+        {
+        return NULL;
+        }
+      ijk[i] = bins.GetBinIndex(i, q[i]);
+      }
+    vtkIdType bin = bins.GetBin(ijk[0], ijk[1], ijk[2]);
+    n = bins.Offsets[bin + 1] - bins.Offsets[bin];
+    return n > 0 ? &bins.Ids[bins.Offsets[bin]] : NULL;
+  }
+};
+
+namespace
+{
+  // Compute the bounds of the boxes of a level, and flag the empty ones.
+  class BlockBoundsWorker
+  {
+  public:
+    vtkAMRInformation* Info;
+    unsigned int Level;
+    std::vector<double>* Bounds;
+    std::vector<char>* Valid;
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType id = begin; id < end; id++)
+        {
+        double* bb = &(*this->Bounds)[6 * id];
+        unsigned int gridId = static_cast<unsigned int>(id);
+        bool valid = !this->Info->GetAMRBox(this->Level, gridId).IsInvalid();
+        if (valid)
+          {
+          this->Info->GetBounds(this->Level, gridId, bb);
+          for (int i = 0; i < 3; i++)
+            {
+            valid = valid && (bb[2 * i] <= bb[2 * i + 1]);
+            }
+          }
+        (*this->Valid)[id] = valid ? 1 : 0;
+        }
+    }
+  };
+
+  // Count (when Fill is false) or list the boxes of the slabs of bins
+  // [begin, end) along x. The bins of a slab are contiguous, so slabs are
+  // processed independently.
+  class BlockBinningWorker
+  {
+  public:
+    vtkAMRInformationBlockLocator::LevelBins* Bins;
+    const std::vector<int>* Ranges; // 6 bin indices per box
+    const std::vector<char>* Valid;
+    std::vector<vtkIdType>* Counts;
+    bool Fill;
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      vtkAMRInformationBlockLocator::LevelBins& bins = *this->Bins;
+      vtkIdType numBoxes = static_cast<vtkIdType>(this->Valid->size());
+      for (vtkIdType id = 0; id < numBoxes; id++)
+        {
+        if (!(*this->Valid)[id])
+          {
+          continue;
+          }
+        const int* r = &(*this->Ranges)[6 * id];
+        int lo = r[0] > begin ? r[0] : static_cast<int>(begin);
+        int hi = r[1] < end - 1 ? r[1] : static_cast<int>(end - 1);
+        for (int i = lo; i <= hi; i++)
+          {
+          for (int j = r[2]; j <= r[3]; j++)
+            {
+            for (int k = r[4]; k <= r[5]; k++)
+              {
+              vtkIdType bin = bins.GetBin(i, j, k);
+              if (this->Fill)
+                {
+                bins.Ids[bins.Offsets[bin] + (*this->Counts)[bin]] =
+                  static_cast<unsigned int>(id);
+                }
+              (*this->Counts)[bin]++;
+              }
+            }
+          }
+        }
+    }
+  };
+
+  // Locate a batch of points, see vtkAMRInformation::FindGrids
+  class FindGridsWorker
+  {
+  public:
+    vtkAMRInformation* Info;
+    vtkPoints* Points;
+    vtkIntArray* Levels;
+    vtkUnsignedIntArray* GridIds;
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      double q[3];
+      for (vtkIdType i = begin; i < end; i++)
+        {
+        this->Points->GetPoint(i, q);
+        unsigned int level = 0;
+        unsigned int gridId = 0;
+        bool found = this->Info->FindGrid(q, level, gridId);
+        this->Levels->SetValue(i, found ? static_cast<int>(level) : -1);
+        this->GridIds->SetValue(i, found ? gridId : 0);
+        }
+    }
+  };
+}
+
 //----------------------------------------------------------------------------
 
 vtkAMRInformation::vtkAMRInformation(): NumBlocks(1,0)
@@ -149,10 +324,13 @@ vtkAMRInformation::vtkAMRInformation(): NumBlocks(1,0)
   this->Bounds[3] = VTK_DOUBLE_MIN;
   this->Bounds[4] = VTK_DOUBLE_MAX;
   this->Bounds[5] = VTK_DOUBLE_MIN;
+
+  this->BlockLocator = NULL;
 }
 
 vtkAMRInformation::~vtkAMRInformation()
 {
+  delete this->BlockLocator;
 }
 
 void vtkAMRInformation::PrintSelf(ostream& os, vtkIndent indent)
@@ -286,6 +464,8 @@ void vtkAMRInformation::Initialize(int numLevels,  const int* blocksPerLevel)
     vtkErrorMacro("Number of levels must be at least 0: "<<numLevels);
     return;
     }
+  this->ResetBlockLocator();
+
   // allocate boxes
   this->NumBlocks.resize(numLevels+1,0);
   for(unsigned int i=0; i<static_cast<unsigned int>(numLevels);i++)
@@ -335,6 +515,7 @@ void vtkAMRInformation::SetAMRBox(unsigned int level, unsigned int id, const vtk
 {
   unsigned int index = this->GetIndex(level,id);
   this->Boxes[index] = box;
+  this->ResetBlockLocator();
   if(this->HasSpacing(level)) //has valid spacing
     {
     this->UpdateBounds(level,id);
@@ -386,6 +567,7 @@ double* vtkAMRInformation::GetOrigin()
 
 void vtkAMRInformation::SetOrigin(const double* origin)
 {
+  this->ResetBlockLocator();
   for(int d=0; d<3; d++)
     {
     this->Origin[d] = origin[d];
@@ -587,6 +769,7 @@ void vtkAMRInformation::SetSpacing(unsigned int level, const double* h)
       }
     }
   this->Spacing->SetTuple(level, h);
+  this->ResetBlockLocator();
 }
 
 void vtkAMRInformation::GenerateBlockLevel()
@@ -615,8 +798,12 @@ void vtkAMRInformation::GenerateBlockLevel()
 
 void vtkAMRInformation::GetBounds(unsigned int level, unsigned int id, double* bb)
 {
+  // Copy the spacing rather than use the tuple buffer of the array, so that
+  // bounds can be computed by concurrent threads
+  double h[3];
+  this->Spacing->GetTuple(level,h);
   const vtkAMRBox& box = this->Boxes[this->GetIndex(level,id)];
-  vtkAMRBox::GetBounds(box, this->Origin, this->Spacing->GetTuple(level), bb);
+  vtkAMRBox::GetBounds(box, this->Origin, h, bb);
 }
 
 const vtkAMRBox& vtkAMRInformation::GetAMRBox(unsigned int level, unsigned int id) const
@@ -902,6 +1089,7 @@ void vtkAMRInformation::UpdateBounds(const int level, const int id)
 
 void vtkAMRInformation::DeepCopy(vtkAMRInformation *other)
 {
+  this->ResetBlockLocator();
   this->GridDescription = other->GridDescription;
   memcpy(this->Origin, other->Origin, sizeof(double)*3);
   this->Boxes = other->Boxes;
@@ -957,43 +1145,254 @@ bool vtkAMRInformation::FindGrid(double q[3], unsigned int& level, unsigned int&
   unsigned int maxLevels = this->GetNumberOfLevels();
   for(level=0; level<maxLevels;level++)
     {
-    unsigned int n;
-    unsigned int *children = this->GetChildren(level, gridId,n);
-    if (children == NULL)
+    if (!this->FindChildGrid(q, level, gridId))
       {
       break;
       }
-    unsigned int i;
-    for (i = 0; i < n; i++)
+    }
+  return true;
+}
+
+bool vtkAMRInformation::FindChildGrid(double q[3], unsigned int level, unsigned int& gridId)
+{
+  // The first child of gridId that contains q, in the order of the children
+  // list, is the first grid of the next level that contains q and has
+  // gridId among its parents.
+  vtkIdType n;
+  const unsigned int* candidates = this->BlockLocator->GetCandidates(level+1, q, n);
+  for (vtkIdType i = 0; i < n; i++)
+    {
+    double bb[6];
+    this->GetBounds(level+1, candidates[i], bb);
+    if (Inside(q,bb))
       {
-      double bb[6];
-      this->GetBounds(level+1, children[i],bb);
-      if(Inside(q,bb))
+      unsigned int numParents;
+      unsigned int* parents = this->GetParents(level+1, candidates[i], numParents);
+      for (unsigned int p = 0; p < numParents; p++)
         {
-        gridId = children[i];
-        break;
+        if (parents[p] == gridId)
+          {
+          gridId = candidates[i];
+          return true;
+          }
         }
       }
-    if(i>=n)
-      {
-      break;
-      }
     }
-  return true;
+  return false;
 }
 
 bool vtkAMRInformation::FindGrid(double q[3], int level, unsigned int& gridId)
 {
-  for(unsigned int i = 0; i < this->GetNumberOfDataSets(level); i++ )
+  if (level < 0 || this->GetNumberOfDataSets(level) == 0)
+    {
+    return false;
+    }
+  if (!this->HasBlockLocator())
+    {
+    this->GenerateBlockLocator();
+    }
+  vtkIdType n;
+  const unsigned int* candidates = this->BlockLocator->GetCandidates(level, q, n);
+  for (vtkIdType i = 0; i < n; i++)
     {
     double gbounds[6];
-    this->GetBounds(level,i,gbounds);
-    bool inside = Inside(q,gbounds);
-    if(inside)
+    this->GetBounds(level,candidates[i],gbounds);
+    if (Inside(q,gbounds))
       {
-      gridId = i;
+      gridId = candidates[i];
       return true;
       }
     }
   return false;
 }
+
+bool vtkAMRInformation::FindGridCell(double q[3], unsigned int level,
+                                     unsigned int& gridId, int& cellIdx)
+{
+  if (this->GetNumberOfDataSets(level) == 0)
+    {
+    return false;
+    }
+  if (!this->HasBlockLocator())
+    {
+    this->GenerateBlockLocator();
+    }
+  vtkIdType n;
+  const unsigned int* candidates = this->BlockLocator->GetCandidates(level, q, n);
+  for (vtkIdType i = 0; i < n; i++)
+    {
+    if (this->FindCell(q, level, candidates[i], cellIdx))
+      {
+      gridId = candidates[i];
+      return true;
+      }
+    }
+  return false;
+}
+
+void vtkAMRInformation::FindGrids(vtkPoints* points, vtkIntArray* levels,
+                                  vtkUnsignedIntArray* gridIds)
+{
+  vtkIdType numPts = points->GetNumberOfPoints();
+  levels->SetNumberOfComponents(1);
+  levels->SetNumberOfTuples(numPts);
+  gridIds->SetNumberOfComponents(1);
+  gridIds->SetNumberOfTuples(numPts);
+  if (this->GetNumberOfLevels() == 0 || this->GetNumberOfDataSets(0) == 0)
+    {
+    levels->FillComponent(0, -1);
+    gridIds->FillComponent(0, 0);
+    return;
+    }
+
+  // Generate the auxiliary information up front, so that the queries
+  // only read it
+  if (!this->HasChildrenInformation())
+    {
+    this->GenerateParentChildInformation();
+    }
+  if (!this->HasBlockLocator())
+    {
+    this->GenerateBlockLocator();
+    }
+
+  FindGridsWorker worker;
+  worker.Info = this;
+  worker.Points = points;
+  worker.Levels = levels;
+  worker.GridIds = gridIds;
+  vtkSMPTools::For(0, numPts, worker);
+}
+
+bool vtkAMRInformation::HasBlockLocator()
+{
+  return this->BlockLocator != NULL;
+}
+
+void vtkAMRInformation::ResetBlockLocator()
+{
+  delete this->BlockLocator;
+  this->BlockLocator = NULL;
+}
+
+void vtkAMRInformation::GenerateBlockLocator()
+{
+  this->ResetBlockLocator();
+  vtkAMRInformationBlockLocator* locator = new vtkAMRInformationBlockLocator;
+  unsigned int numLevels = this->GetNumberOfLevels();
+  locator->Levels.resize(numLevels);
+  for (unsigned int level = 0; level < numLevels; level++)
+    {
+    vtkAMRInformationBlockLocator::LevelBins& bins = locator->Levels[level];
+    vtkIdType numBoxes = this->GetNumberOfDataSets(level);
+    if (numBoxes == 0 || !this->HasSpacing(level))
+      {
+      bins.Offsets.resize(2, 0);
+      continue;
+      }
+
+    // 1. Bounds of the boxes, in parallel
+    std::vector<double> bounds(6 * numBoxes);
+    std::vector<char> valid(numBoxes);
+    BlockBoundsWorker boundsWorker;
+    boundsWorker.Info = this;
+    boundsWorker.Level = level;
+    boundsWorker.Bounds = &bounds;
+    boundsWorker.Valid = &valid;
+    vtkSMPTools::For(0, numBoxes, boundsWorker);
+
+    // 2. Bins of about the average box size over the union of the boxes,
+    // with at most a few bins per box
+    vtkIdType numValid = 0;
+    double totalSize[3] = { 0.0, 0.0, 0.0 };
+    for (int i = 0; i < 3; i++)
+      {
+      bins.Min[i] = VTK_DOUBLE_MAX;
+      bins.Max[i] = -VTK_DOUBLE_MAX;
+      }
+    for (vtkIdType id = 0; id < numBoxes; id++)
+      {
+      if (!valid[id])
+        {
+        continue;
+        }
+      numValid++;
+      const double* bb = &bounds[6 * id];
+      for (int i = 0; i < 3; i++)
+        {
+        bins.Min[i] = std::min(bins.Min[i], bb[2 * i]);
+        bins.Max[i] = std::max(bins.Max[i], bb[2 * i + 1]);
+        totalSize[i] += bb[2 * i + 1] - bb[2 * i];
+        }
+      }
+    if (numValid == 0)
+      {
+      bins.Offsets.resize(2, 0);
+      continue;
+      }
+    for (int i = 0; i < 3; i++)
+      {
+      double range = bins.Max[i] - bins.Min[i];
+      double size = totalSize[i] / numValid;
+      bins.Dims[i] = 1;
+      if (range > 0.0 && size > 0.0)
+        {
+        bins.Dims[i] = static_cast<int>(
+          std::min(ceil(range / size), static_cast<double>(numValid)));
+        }
+      }
+    const double maxNumberOfBins = 4.0 * numValid;
+    while (static_cast<double>(bins.Dims[0]) * bins.Dims[1] * bins.Dims[2] >
+           maxNumberOfBins)
+      {
+      int axis = bins.Dims[0] >= bins.Dims[1] ? 0 : 1;
+      axis = bins.Dims[axis] >= bins.Dims[2] ? axis : 2;
+      bins.Dims[axis] = (bins.Dims[axis] + 1) / 2;
+      }
+    for (int i = 0; i < 3; i++)
+      {
+      double range = bins.Max[i] - bins.Min[i];
+      bins.Width[i] = range > 0.0 ? range / bins.Dims[i] : 1.0;
+      }
+
+    // 3. Bins overlapped by each box. The bin index is monotonic in the
+    // coordinate, so a point inside a box falls in one of its bins.
+    std::vector<int> ranges(6 * numBoxes, 0);
+    for (vtkIdType id = 0; id < numBoxes; id++)
+      {
+      if (valid[id])
+        {
+        const double* bb = &bounds[6 * id];
+        for (int i = 0; i < 3; i++)
+          {
+          ranges[6 * id + 2 * i] = bins.GetBinIndex(i, bb[2 * i]);
+          ranges[6 * id + 2 * i + 1] = bins.GetBinIndex(i, bb[2 * i + 1]);
+          }
+        }
+      }
+
+    // 4. Count, then list the boxes of each bin, in parallel over the
+    // slabs of bins along x
+    vtkIdType numBins = bins.GetBin(bins.Dims[0], 0, 0);
+    std::vector<vtkIdType> counts(numBins, 0);
+    BlockBinningWorker binningWorker;
+    binningWorker.Bins = &bins;
+    binningWorker.Ranges = &ranges;
+    binningWorker.Valid = &valid;
+    binningWorker.Counts = &counts;
+    binningWorker.Fill = false;
+    vtkSMPTools::For(0, bins.Dims[0], 1, binningWorker);
+
+    bins.Offsets.resize(numBins + 1);
+    bins.Offsets[0] = 0;
+    for (vtkIdType bin = 0; bin < numBins; bin++)
+      {
+      bins.Offsets[bin + 1] = bins.Offsets[bin] + counts[bin];
+      counts[bin] = 0;
+      }
+    bins.Ids.resize(bins.Offsets[numBins]);
+    binningWorker.Fill = true;
+    vtkSMPTools::For(0, bins.Dims[0], 1, binningWorker);
+    }
+  this->BlockLocator = locator;
+}
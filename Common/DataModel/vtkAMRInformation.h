@@ -40,7 +40,9 @@ typedef std::vector<vtkAMRBox> vtkAMRBoxList;
 class vtkUnsignedIntArray;
 class vtkIntArray;
 class vtkDoubleArray;
+class vtkPoints;
 class vtkAMRIndexIterator;
+class vtkAMRInformationBlockLocator;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAMRInformation : public vtkObject
 {
@@ -198,6 +200,29 @@ public:
   //Given a point q, find the highest level grid that contains it.
   bool FindGrid(double q[3], unsigned int& level, unsigned int& gridId);
 
+  // Description:
+  // Find the first grid at the given level for which FindCell() succeeds
+  // and set gridId and cellIdx accordingly. The result is the one of
+  // calling FindCell() on all the grids of the level in order.
+  bool FindGridCell(double q[3], unsigned int level, unsigned int& gridId,
+                    int& cellIdx);
+
+  // Description:
+  // Batched version of FindGrid(q, level, gridId): for each point, set the
+  // level and the id of the highest level grid that contains it, or -1 and 0
+  // if no grid contains it. The points are processed in parallel.
+  void FindGrids(vtkPoints* points, vtkIntArray* levels,
+                 vtkUnsignedIntArray* gridIds);
+
+  // Description:
+  // Build the block locator, a per-level binning of the boxes used by the
+  // FindGrid methods to test only the grids that may contain a point
+  // instead of all the grids of a level. It is generated on demand by
+  // these methods and dropped when the boxes, the origin or the spacing
+  // change. The per-level bins are filled in parallel.
+  void GenerateBlockLocator();
+  bool HasBlockLocator();
+
   // Description:
   // Returns internal arrays.
   const std::vector<int>& GetNumBlocks() const
@@ -222,6 +247,8 @@ public:
   void CalculateParentChildRelationShip( unsigned int level,
                                         std::vector<std::vector<unsigned int> >& children,
                                         std::vector<std::vector<unsigned int> >& parents );
+  void ResetBlockLocator();
+  bool FindChildGrid(double q[3], unsigned int level, unsigned int& gridId);
 
   //-------------------------------------------------------------------------
   // Essential information that determines an AMR structure. Must be copied
@@ -244,6 +271,9 @@ public:
   //parent child information
   std::vector<std::vector<std::vector<unsigned int> > > AllChildren;
   std::vector<std::vector<std::vector<unsigned int> > > AllParents;
+
+  //bins of the boxes of each level, for point location
+  vtkAMRInformationBlockLocator* BlockLocator;
 };
 
 #endif
@@ -15,9 +15,130 @@
 #include "vtkBoundingBox.h"
 #include "vtkMath.h"
 #include "vtkPlane.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
+namespace
+{
+// Bounds of float or double points stored as x,y,z triples, reduced over
+// the threads. The loops without ptUses have no branch but the min/max so
+// that they can be vectorized.
+template <class T>
+class PointBoundsWorker
+{
+public:
+  PointBoundsWorker(const T *points, const unsigned char *uses)
+    : Points(points), Uses(uses)
+  {
+    vtkBoundingBox empty;
+    empty.GetBounds(this->Bounds);
+  }
+
+  void Initialize()
+  {
+    double *b = this->LocalBounds.Local().Bounds;
+    for (int i = 0; i < 6; i += 2)
+      {
+      b[i] = VTK_DOUBLE_MAX;
+      b[i + 1] = VTK_DOUBLE_MIN;
+      }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double *b = this->LocalBounds.Local().Bounds;
+    double xMin = b[0], xMax = b[1], yMin = b[2], yMax = b[3];
+    double zMin = b[4], zMax = b[5];
+    const T *x = this->Points + 3 * begin;
+    if (this->Uses)
+      {
+      for (vtkIdType i = begin; i < end; ++i, x += 3)
+        {
+        if (this->Uses[i])
+          {
+          xMin = x[0] < xMin ? x[0] : xMin;
+          xMax = x[0] > xMax ? x[0] : xMax;
+          yMin = x[1] < yMin ? x[1] : yMin;
+          yMax = x[1] > yMax ? x[1] : yMax;
+          zMin = x[2] < zMin ? x[2] : zMin;
+          zMax = x[2] > zMax ? x[2] : zMax;
+          }
+        }
+      }
+    else
+      {
+      for (vtkIdType i = begin; i < end; ++i, x += 3)
+        {
+        xMin = x[0] < xMin ? x[0] : xMin;
+        xMax = x[0] > xMax ? x[0] : xMax;
+        yMin = x[1] < yMin ? x[1] : yMin;
+        yMax = x[1] > yMax ? x[1] : yMax;
+        zMin = x[2] < zMin ? x[2] : zMin;
+        zMax = x[2] > zMax ? x[2] : zMax;
+        }
+      }
+    b[0] = xMin; b[1] = xMax; b[2] = yMin; b[3] = yMax;
+    b[4] = zMin; b[5] = zMax;
+  }
+
+  void Reduce()
+  {
+    typename vtkSMPThreadLocal<LocalBoundsType>::iterator itr;
+    for (itr = this->LocalBounds.begin(); itr != this->LocalBounds.end();
+         ++itr)
+      {
+      for (int i = 0; i < 6; i += 2)
+        {
+        this->Bounds[i] = std::min(this->Bounds[i], (*itr).Bounds[i]);
+        this->Bounds[i + 1] = std::max(this->Bounds[i + 1],
+                                       (*itr).Bounds[i + 1]);
+        }
+      }
+  }
+
+  double Bounds[6];
+
+private:
+  struct LocalBoundsType
+  {
+    double Bounds[6];
+  };
+
+  const T *Points;
+  const unsigned char *Uses;
+  vtkSMPThreadLocal<LocalBoundsType> LocalBounds;
+};
+
+// Points of this count and above are processed in parallel.
+const vtkIdType ParallelBoundsThreshold = 65536;
+
+template <class T>
+void ComputePointBounds(const T *points, vtkIdType numPts,
+                        const unsigned char *uses, double bounds[6])
+{
+  PointBoundsWorker<T> worker(points, uses);
+  if (numPts >= ParallelBoundsThreshold)
+    {
+    vtkSMPTools::For(0, numPts, worker);
+    }
+  else
+    {
+    worker.Initialize();
+    worker(0, numPts);
+    worker.Reduce();
+    }
+  for (int i = 0; i < 6; ++i)
+    {
+    bounds[i] = worker.Bounds[i];
+    }
+}
+}
+
 // ---------------------------------------------------------------------------
 namespace
 {
@@ -465,3 +586,46 @@ bool vtkBoundingBox::IntersectPlane(double origin[3],double normal[3])
 
   return true;
 }
+
+// ---------------------------------------------------------------------------
+void vtkBoundingBox::ComputeBounds(vtkPoints *pts,
+                                   const unsigned char *ptUses,
+                                   double bounds[6])
+{
+  vtkBoundingBox box;
+  box.GetBounds(bounds);
+  const vtkIdType numPts = pts ? pts->GetNumberOfPoints() : 0;
+  if (numPts == 0)
+    {
+    return;
+    }
+
+  vtkDataArray *data = pts->GetData();
+  if (data->HasStandardMemoryLayout() && data->GetNumberOfComponents() == 3)
+    {
+    if (data->GetDataType() == VTK_FLOAT)
+      {
+      ComputePointBounds(static_cast<float*>(data->GetVoidPointer(0)),
+                         numPts, ptUses, bounds);
+      return;
+      }
+    if (data->GetDataType() == VTK_DOUBLE)
+      {
+      ComputePointBounds(static_cast<double*>(data->GetVoidPointer(0)),
+                         numPts, ptUses, bounds);
+      return;
+      }
+    }
+
+  // Other point types and layouts, one point at a time.
+  double x[3];
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    if (!ptUses || ptUses[i])
+      {
+      pts->GetPoint(i, x);
+      box.AddPoint(x);
+      }
+    }
+  box.GetBounds(bounds);
+}
@@ -26,6 +26,8 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkCommonDataModelModule.h" // For export macro
 #include "vtkSystemIncludes.h"
 
+class vtkPoints;
+
 class VTKCOMMONDATAMODEL_EXPORT vtkBoundingBox
 {
 public:
@@ -181,6 +183,14 @@ public:
              double sy,
              double sz);
 
+  // Description:
+  // Compute the bounds of the points whose entry in ptUses is not zero, or
+  // of all the points if ptUses is NULL. Float and double points are
+  // processed in parallel with vtkSMPTools. If no point is used, bounds is
+  // set to the initialized (invalid) state of the box, see IsValid().
+  static void ComputeBounds(vtkPoints *pts, const unsigned char *ptUses,
+                            double bounds[6]);
+
 protected:
   double MinPnt[3], MaxPnt[3];
 };
@@ -52,6 +52,10 @@ public:
   // Evaluate the gradient of the box.
   void EvaluateGradient(double x[3], double n[3]);
 
+  // Description:
+  // Return true; the box is read-only during evaluation.
+  virtual bool CanEvaluateInParallel() { return true; }
+
   // Description:
   // Set / get the bounding box using various methods.
   void SetXMin(double p[3]);
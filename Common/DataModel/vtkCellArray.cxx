@@ -14,9 +14,168 @@
 =========================================================================*/
 #include "vtkCellArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkTypeInt32Array.h"
+
+#include <algorithm>
 
 vtkStandardNewMacro(vtkCellArray);
 
+//----------------------------------------------------------------------------
+// Helpers for the offsets storage, templated over the type of the offsets
+// and connectivity (vtkIdType or vtkTypeInt32).
+namespace
+{
+template <typename T>
+vtkDataArrayTemplate<T> *vtkCellArrayCast(vtkDataArray *array, T *)
+{
+  return static_cast<vtkDataArrayTemplate<T>*>(array);
+}
+
+// Copy the point ids of a cell, converting them to vtkIdType.
+template <typename T>
+vtkIdType vtkCellArrayGetCell(vtkDataArray *offsetsArray,
+                              vtkDataArray *connArray, vtkIdType cellId,
+                              vtkIdList *ptIds)
+{
+  const T *offsets = vtkCellArrayCast(offsetsArray, static_cast<T*>(0))->
+    GetPointer(0);
+  const T *conn = vtkCellArrayCast(connArray, static_cast<T*>(0))->
+    GetPointer(0);
+  vtkIdType begin = offsets[cellId];
+  vtkIdType npts = offsets[cellId+1] - begin;
+  ptIds->SetNumberOfIds(npts);
+  std::copy(conn + begin, conn + begin + npts, ptIds->GetPointer(0));
+  return npts;
+}
+
+template <typename T>
+void vtkCellArrayInsertCell(vtkDataArray *offsetsArray,
+                            vtkDataArray *connArray, vtkIdType npts,
+                            const vtkIdType *pts)
+{
+  vtkDataArrayTemplate<T> *conn =
+    vtkCellArrayCast(connArray, static_cast<T*>(0));
+  vtkIdType begin = conn->GetMaxId() + 1;
+  T *ptr = conn->WritePointer(begin, npts);
+  for (vtkIdType i = 0; i < npts; i++)
+    {
+    ptr[i] = static_cast<T>(pts[i]);
+    }
+  vtkCellArrayCast(offsetsArray, static_cast<T*>(0))->InsertNextValue(
+    static_cast<T>(begin + npts));
+}
+
+template <typename T>
+void vtkCellArrayReplaceCell(vtkDataArray *offsetsArray,
+                             vtkDataArray *connArray, vtkIdType cellId,
+                             int npts, const vtkIdType *pts)
+{
+  const T *offsets = vtkCellArrayCast(offsetsArray, static_cast<T*>(0))->
+    GetPointer(0);
+  T *conn = vtkCellArrayCast(connArray, static_cast<T*>(0))->
+    GetPointer(offsets[cellId]);
+  for (int i = 0; i < npts; i++)
+    {
+    conn[i] = static_cast<T>(pts[i]);
+    }
+}
+
+template <typename T>
+void vtkCellArrayReverseCell(vtkDataArray *offsetsArray,
+                             vtkDataArray *connArray, vtkIdType cellId)
+{
+  const T *offsets = vtkCellArrayCast(offsetsArray, static_cast<T*>(0))->
+    GetPointer(0);
+  T *conn = vtkCellArrayCast(connArray, static_cast<T*>(0))->GetPointer(0);
+  std::reverse(conn + offsets[cellId], conn + offsets[cellId+1]);
+}
+
+template <typename T>
+int vtkCellArrayGetMaxCellSize(vtkDataArray *offsetsArray,
+                               vtkIdType numCells)
+{
+  const T *offsets = vtkCellArrayCast(offsetsArray, static_cast<T*>(0))->
+    GetPointer(0);
+  vtkIdType maxSize = 0;
+  for (vtkIdType i = 0; i < numCells; i++)
+    {
+    maxSize = std::max(maxSize, static_cast<vtkIdType>(offsets[i+1] -
+                                                       offsets[i]));
+    }
+  return static_cast<int>(maxSize);
+}
+
+// Write the cells in the (n,id1,id2,...,idn, ...) layout.
+template <typename T>
+void vtkCellArrayExportLegacy(vtkDataArray *offsetsArray,
+                              vtkDataArray *connArray, vtkIdType numCells,
+                              vtkIdTypeArray *cells)
+{
+  const T *offsets = vtkCellArrayCast(offsetsArray, static_cast<T*>(0))->
+    GetPointer(0);
+  const T *conn = vtkCellArrayCast(connArray, static_cast<T*>(0))->
+    GetPointer(0);
+  cells->SetNumberOfValues(offsets[numCells] + numCells);
+  vtkIdType *ptr = cells->GetPointer(0);
+  for (vtkIdType i = 0; i < numCells; i++)
+    {
+    *ptr++ = offsets[i+1] - offsets[i];
+    ptr = std::copy(conn + offsets[i], conn + offsets[i+1], ptr);
+    }
+}
+
+// Fill the offsets storage from cells in the legacy layout.
+template <typename T>
+void vtkCellArrayImportLegacy(vtkIdTypeArray *cells, vtkIdType numCells,
+                              vtkDataArray *offsetsArray,
+                              vtkDataArray *connArray)
+{
+  const vtkIdType *ptr = cells->GetPointer(0);
+  T *offsets = vtkCellArrayCast(offsetsArray, static_cast<T*>(0))->
+    WritePointer(0, numCells + 1);
+  T *conn = vtkCellArrayCast(connArray, static_cast<T*>(0))->
+    WritePointer(0, cells->GetMaxId() + 1 - numCells);
+  offsets[0] = 0;
+  for (vtkIdType i = 0; i < numCells; i++)
+    {
+    vtkIdType npts = *ptr++;
+    offsets[i+1] = static_cast<T>(offsets[i] + npts);
+    for (vtkIdType j = 0; j < npts; j++)
+      {
+      *conn++ = static_cast<T>(*ptr++);
+      }
+    }
+}
+
+// Convert between the 32 bit and vtkIdType offsets storage.
+template <typename TIn, typename TOut>
+void vtkCellArrayConvert(vtkDataArray *input, vtkDataArray *output)
+{
+  vtkDataArrayTemplate<TIn> *in =
+    vtkCellArrayCast(input, static_cast<TIn*>(0));
+  vtkIdType size = in->GetMaxId() + 1;
+  const TIn *inPtr = in->GetPointer(0);
+  TOut *outPtr = vtkCellArrayCast(output, static_cast<TOut*>(0))->
+    WritePointer(0, size);
+  for (vtkIdType i = 0; i < size; i++)
+    {
+    outPtr[i] = static_cast<TOut>(inPtr[i]);
+    }
+}
+
+vtkDataArray *vtkCellArrayNewArray(bool use32Bit)
+{
+  if (use32Bit)
+    {
+    return vtkTypeInt32Array::New();
+    }
+  return vtkIdTypeArray::New();
+}
+
+// Largest offset or point id of the 32 bit storage.
+const vtkIdType vtkCellArrayMax32 = VTK_INT_MAX;
+}
+
 //----------------------------------------------------------------------------
 vtkCellArray::vtkCellArray()
 {
@@ -24,6 +183,11 @@ vtkCellArray::vtkCellArray()
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->StorageMode = LEGACY_STORAGE;
+  this->Use32BitStorage = false;
+  this->Offsets = NULL;
+  this->Connectivity = NULL;
+  this->TempCell = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -35,7 +199,19 @@ void vtkCellArray::DeepCopy (vtkCellArray *ca)
     return;
     }
 
-  this->Ia->DeepCopy(ca->Ia);
+  if (ca->StorageMode == OFFSETS_STORAGE)
+    {
+    this->Ia->Initialize();
+    this->ReleaseOffsetsStorage();
+    this->CreateOffsetsStorage(ca->Use32BitStorage);
+    this->Offsets->DeepCopy(ca->Offsets);
+    this->Connectivity->DeepCopy(ca->Connectivity);
+    }
+  else
+    {
+    this->ReleaseOffsetsStorage();
+    this->Ia->DeepCopy(ca->Ia);
+    }
   this->NumberOfCells = ca->NumberOfCells;
   this->InsertLocation = ca->InsertLocation;
   this->TraversalLocation = ca->TraversalLocation;
@@ -45,22 +221,468 @@ void vtkCellArray::DeepCopy (vtkCellArray *ca)
 vtkCellArray::~vtkCellArray()
 {
   this->Ia->Delete();
+  this->ReleaseOffsetsStorage();
+  if (this->TempCell)
+    {
+    this->TempCell->Delete();
+    }
 }
 
 //----------------------------------------------------------------------------
 void vtkCellArray::Initialize()
 {
   this->Ia->Initialize();
+  if (this->Offsets)
+    {
+    this->Offsets->Initialize();
+    this->Offsets->InsertNextTuple1(0);
+    this->Connectivity->Initialize();
+    }
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
 }
 
+//----------------------------------------------------------------------------
+// Create empty offsets and connectivity arrays and switch to the offsets
+// storage. The current cells are not converted.
+void vtkCellArray::CreateOffsetsStorage(bool use32Bit)
+{
+#if VTK_SIZEOF_ID_TYPE == 4
+  use32Bit = false;
+#endif
+  this->ReleaseOffsetsStorage();
+  this->StorageMode = OFFSETS_STORAGE;
+  this->Use32BitStorage = use32Bit;
+  this->Offsets = vtkCellArrayNewArray(use32Bit);
+  this->Offsets->InsertNextTuple1(0);
+  this->Connectivity = vtkCellArrayNewArray(use32Bit);
+}
+
+//----------------------------------------------------------------------------
+// Switch to the legacy storage. The current cells are not converted.
+void vtkCellArray::ReleaseOffsetsStorage()
+{
+  if (this->Offsets)
+    {
+    this->Offsets->Delete();
+    this->Offsets = NULL;
+    this->Connectivity->Delete();
+    this->Connectivity = NULL;
+    }
+  this->StorageMode = LEGACY_STORAGE;
+  this->Use32BitStorage = false;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::SetStorageMode(int mode)
+{
+  mode = (mode == OFFSETS_STORAGE ? OFFSETS_STORAGE : LEGACY_STORAGE);
+  if (mode == this->StorageMode)
+    {
+    return;
+    }
+
+  if (mode == OFFSETS_STORAGE)
+    {
+    this->CreateOffsetsStorage(false);
+    vtkCellArrayImportLegacy<vtkIdType>(this->Ia, this->NumberOfCells,
+                                        this->Offsets, this->Connectivity);
+    this->Ia->Initialize();
+    this->InsertLocation = this->Connectivity->GetMaxId() + 1;
+    }
+  else
+    {
+    this->ExportLegacyFormat(this->Ia);
+    this->ReleaseOffsetsStorage();
+    this->InsertLocation = this->Ia->GetMaxId() + 1;
+    }
+  this->TraversalLocation = 0;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::SetUse32BitStorage(bool use32Bit)
+{
+#if VTK_SIZEOF_ID_TYPE == 4
+  use32Bit = false;
+#endif
+  if (use32Bit == this->Use32BitStorage ||
+      this->StorageMode != OFFSETS_STORAGE)
+    {
+    return;
+    }
+
+  vtkDataArray *offsets = vtkCellArrayNewArray(use32Bit);
+  vtkDataArray *conn = vtkCellArrayNewArray(use32Bit);
+  if (use32Bit)
+    {
+    // Check that the cells fit in 32 bits.
+    double range[2];
+    this->Connectivity->GetRange(range, 0);
+    if (this->Offsets->GetTuple1(this->NumberOfCells) > vtkCellArrayMax32 ||
+        range[1] > vtkCellArrayMax32)
+      {
+      offsets->Delete();
+      conn->Delete();
+      return;
+      }
+    vtkCellArrayConvert<vtkIdType, vtkTypeInt32>(this->Offsets, offsets);
+    vtkCellArrayConvert<vtkIdType, vtkTypeInt32>(this->Connectivity, conn);
+    }
+  else
+    {
+    vtkCellArrayConvert<vtkTypeInt32, vtkIdType>(this->Offsets, offsets);
+    vtkCellArrayConvert<vtkTypeInt32, vtkIdType>(this->Connectivity, conn);
+    }
+  this->Offsets->Delete();
+  this->Connectivity->Delete();
+  this->Offsets = offsets;
+  this->Connectivity = conn;
+  this->Use32BitStorage = use32Bit;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkCellArray::SetData(vtkDataArray *offsets, vtkDataArray *connectivity)
+{
+  if (!offsets || !connectivity || offsets->GetNumberOfTuples() < 1)
+    {
+    return false;
+    }
+  bool use32Bit;
+  if (vtkIdTypeArray::SafeDownCast(offsets) &&
+      vtkIdTypeArray::SafeDownCast(connectivity))
+    {
+    use32Bit = false;
+    }
+#if VTK_SIZEOF_ID_TYPE == 8
+  else if (vtkTypeInt32Array::SafeDownCast(offsets) &&
+           vtkTypeInt32Array::SafeDownCast(connectivity))
+    {
+    use32Bit = true;
+    }
+#endif
+  else
+    {
+    vtkErrorMacro("Offsets and connectivity must both be vtkIdTypeArray"
+#if VTK_SIZEOF_ID_TYPE == 8
+                  " or both vtkTypeInt32Array"
+#endif
+                  ".");
+    return false;
+    }
+
+  this->Ia->Initialize();
+  this->ReleaseOffsetsStorage();
+  this->StorageMode = OFFSETS_STORAGE;
+  this->Use32BitStorage = use32Bit;
+  this->Offsets = offsets;
+  this->Offsets->Register(this);
+  this->Connectivity = connectivity;
+  this->Connectivity->Register(this);
+  this->NumberOfCells = offsets->GetNumberOfTuples() - 1;
+  this->InsertLocation = connectivity->GetMaxId() + 1;
+  this->TraversalLocation = 0;
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::Allocate(const vtkIdType sz, const int ext)
+{
+  if (this->StorageMode == OFFSETS_STORAGE)
+    {
+    // The connectivity is a bit smaller than the legacy estimate; the
+    // offsets grow as needed.
+    return this->Connectivity->Allocate(sz, ext);
+    }
+  return this->Ia->Allocate(sz,ext);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetSize()
+{
+  if (this->StorageMode == OFFSETS_STORAGE)
+    {
+    return this->Offsets->GetSize() + this->Connectivity->GetSize();
+    }
+  return this->Ia->GetSize();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetNumberOfConnectivityEntries()
+{
+  if (this->StorageMode == OFFSETS_STORAGE)
+    {
+    return this->Connectivity->GetMaxId() + 1 + this->NumberOfCells;
+    }
+  return this->Ia->GetMaxId()+1;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::Squeeze()
+{
+  if (this->StorageMode == OFFSETS_STORAGE)
+    {
+    this->Offsets->Squeeze();
+    this->Connectivity->Squeeze();
+    }
+  this->Ia->Squeeze();
+}
+
+//----------------------------------------------------------------------------
+vtkIdTypeArray* vtkCellArray::GetData()
+{
+  if (this->StorageMode == OFFSETS_STORAGE)
+    {
+    this->ExportLegacyFormat(this->Ia);
+    }
+  return this->Ia;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ExportLegacyFormat(vtkIdTypeArray *cells)
+{
+  if (this->Use32BitStorage)
+    {
+    vtkCellArrayExportLegacy<vtkTypeInt32>(this->Offsets, this->Connectivity,
+                                           this->NumberOfCells, cells);
+    }
+  else
+    {
+    vtkCellArrayExportLegacy<vtkIdType>(this->Offsets, this->Connectivity,
+                                        this->NumberOfCells, cells);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::InsertNextOffsetsCell(vtkIdType npts,
+                                              const vtkIdType* pts)
+{
+  if (this->Use32BitStorage)
+    {
+    bool fits = this->Connectivity->GetMaxId() + 1 + npts <= vtkCellArrayMax32;
+    for (vtkIdType i = 0; fits && i < npts; i++)
+      {
+      fits = pts[i] <= vtkCellArrayMax32;
+      }
+    if (!fits)
+      {
+      this->SetUse32BitStorage(false);
+      }
+    }
+  if (this->Use32BitStorage)
+    {
+    vtkCellArrayInsertCell<vtkTypeInt32>(this->Offsets, this->Connectivity,
+                                         npts, pts);
+    }
+  else
+    {
+    vtkCellArrayInsertCell<vtkIdType>(this->Offsets, this->Connectivity,
+                                      npts, pts);
+    }
+  this->InsertLocation = this->Connectivity->GetMaxId() + 1;
+  return this->NumberOfCells++;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::InsertNextOffsetsCell(int npts)
+{
+  if (this->Use32BitStorage &&
+      this->InsertLocation + npts > vtkCellArrayMax32)
+    {
+    this->SetUse32BitStorage(false);
+    }
+  // The points are appended by InsertCellPoint().
+  this->InsertLocation = this->Connectivity->GetMaxId() + 1;
+  this->Offsets->InsertNextTuple1(this->InsertLocation + npts);
+  return this->NumberOfCells++;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::InsertOffsetsCellPoint(vtkIdType id)
+{
+  if (this->Use32BitStorage && id > vtkCellArrayMax32)
+    {
+    this->SetUse32BitStorage(false);
+    }
+  if (this->Use32BitStorage)
+    {
+    static_cast<vtkTypeInt32Array*>(this->Connectivity)->InsertValue(
+      this->InsertLocation++, static_cast<vtkTypeInt32>(id));
+    }
+  else
+    {
+    static_cast<vtkIdTypeArray*>(this->Connectivity)->InsertValue(
+      this->InsertLocation++, id);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::UpdateOffsetsCellCount(int npts)
+{
+  vtkIdType end =
+    static_cast<vtkIdType>(this->Offsets->GetTuple1(this->NumberOfCells-1)) +
+    npts;
+  this->Offsets->SetTuple1(this->NumberOfCells, end);
+  this->Connectivity->SetNumberOfTuples(end);
+  this->InsertLocation = end;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetOffsetsCell(vtkIdType cellId, vtkIdType &npts,
+                                  vtkIdType* &pts)
+{
+  if (this->Use32BitStorage)
+    {
+    if (!this->TempCell)
+      {
+      this->TempCell = vtkIdList::New();
+      }
+    npts = vtkCellArrayGetCell<vtkTypeInt32>(this->Offsets,
+      this->Connectivity, cellId, this->TempCell);
+    pts = this->TempCell->GetPointer(0);
+    }
+  else
+    {
+    const vtkIdType *offsets =
+      static_cast<vtkIdTypeArray*>(this->Offsets)->GetPointer(0);
+    npts = offsets[cellId+1] - offsets[cellId];
+    pts = static_cast<vtkIdTypeArray*>(this->Connectivity)->GetPointer(
+      offsets[cellId]);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ReverseOffsetsCell(vtkIdType cellId)
+{
+  if (this->Use32BitStorage)
+    {
+    vtkCellArrayReverseCell<vtkTypeInt32>(this->Offsets, this->Connectivity,
+                                          cellId);
+    }
+  else
+    {
+    vtkCellArrayReverseCell<vtkIdType>(this->Offsets, this->Connectivity,
+                                       cellId);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ReplaceOffsetsCell(vtkIdType cellId, int npts,
+                                      const vtkIdType *pts)
+{
+  if (this->Use32BitStorage)
+    {
+    bool fits = true;
+    for (int i = 0; fits && i < npts; i++)
+      {
+      fits = pts[i] <= vtkCellArrayMax32;
+      }
+    if (!fits)
+      {
+      this->SetUse32BitStorage(false);
+      }
+    }
+  if (this->Use32BitStorage)
+    {
+    vtkCellArrayReplaceCell<vtkTypeInt32>(this->Offsets, this->Connectivity,
+                                          cellId, npts, pts);
+    }
+  else
+    {
+    vtkCellArrayReplaceCell<vtkIdType>(this->Offsets, this->Connectivity,
+                                       cellId, npts, pts);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Location of a cell of the legacy storage, found by traversing the
+// previous cells.
+vtkIdType vtkCellArray::GetLegacyLocation(vtkIdType cellId)
+{
+  const vtkIdType *cells = this->Ia->GetPointer(0);
+  vtkIdType loc = 0;
+  for (vtkIdType i = 0; i < cellId; i++)
+    {
+    loc += cells[loc] + 1;
+    }
+  return loc;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetCellSize(vtkIdType cellId)
+{
+  if (this->StorageMode == OFFSETS_STORAGE)
+    {
+    return static_cast<vtkIdType>(this->Offsets->GetTuple1(cellId+1) -
+                                  this->Offsets->GetTuple1(cellId));
+    }
+  return this->Ia->GetValue(this->GetLegacyLocation(cellId));
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdList *ptIds)
+{
+  if (this->StorageMode == OFFSETS_STORAGE)
+    {
+    this->GetCell(cellId, ptIds);
+    }
+  else
+    {
+    this->GetCell(this->GetLegacyLocation(cellId), ptIds);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType &npts,
+                               const vtkIdType* &pts, vtkIdList *ptIds)
+{
+  if (this->StorageMode == OFFSETS_STORAGE)
+    {
+    this->GetCell(cellId, npts, pts, ptIds);
+    }
+  else
+    {
+    this->GetCell(this->GetLegacyLocation(cellId), npts, pts, ptIds);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts,
+                           const vtkIdType* &pts, vtkIdList *ptIds)
+{
+  if (this->Use32BitStorage)
+    {
+    npts = vtkCellArrayGetCell<vtkTypeInt32>(this->Offsets,
+      this->Connectivity, loc, ptIds);
+    pts = ptIds->GetPointer(0);
+    }
+  else
+    {
+    vtkIdType *ppts;
+    this->GetCell(loc, npts, ppts);
+    pts = ppts;
+    }
+}
+
 //----------------------------------------------------------------------------
 // Returns the size of the largest cell. The size is the number of points
 // defining the cell.
 int vtkCellArray::GetMaxCellSize()
 {
+  if (this->StorageMode == OFFSETS_STORAGE)
+    {
+    if (this->Use32BitStorage)
+      {
+      return vtkCellArrayGetMaxCellSize<vtkTypeInt32>(this->Offsets,
+                                                      this->NumberOfCells);
+      }
+    return vtkCellArrayGetMaxCellSize<vtkIdType>(this->Offsets,
+                                                 this->NumberOfCells);
+    }
+
   int i, npts=0, maxSize=0;
 
   for (i=0; i<this->Ia->GetMaxId(); i+=(npts+1))
@@ -80,6 +702,7 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
   if ( cells && cells != this->Ia )
     {
     this->Modified();
+    this->ReleaseOffsetsStorage();
     this->Ia->Delete();
     this->Ia = cells;
     this->Ia->Register(this);
@@ -93,7 +716,13 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
 //----------------------------------------------------------------------------
 unsigned long vtkCellArray::GetActualMemorySize()
 {
-  return this->Ia->GetActualMemorySize();
+  unsigned long size = this->Ia->GetActualMemorySize();
+  if (this->StorageMode == OFFSETS_STORAGE)
+    {
+    size += this->Offsets->GetActualMemorySize() +
+      this->Connectivity->GetActualMemorySize();
+    }
+  return size;
 }
 
 //----------------------------------------------------------------------------
@@ -115,6 +744,21 @@ int vtkCellArray::GetNextCell(vtkIdList *pts)
 //----------------------------------------------------------------------------
 void vtkCellArray::GetCell(vtkIdType loc, vtkIdList *pts)
 {
+  if (this->StorageMode == OFFSETS_STORAGE)
+    {
+    if (this->Use32BitStorage)
+      {
+      vtkCellArrayGetCell<vtkTypeInt32>(this->Offsets, this->Connectivity,
+                                        loc, pts);
+      }
+    else
+      {
+      vtkCellArrayGetCell<vtkIdType>(this->Offsets, this->Connectivity,
+                                     loc, pts);
+      }
+    return;
+    }
+
   vtkIdType npts = this->Ia->GetValue(loc++);
   vtkIdType *ppts = this->Ia->GetPointer(loc);
   pts->SetNumberOfIds(npts);
@@ -132,4 +776,8 @@ void vtkCellArray::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Cells: " << this->NumberOfCells << endl;
   os << indent << "Insert Location: " << this->InsertLocation << endl;
   os << indent << "Traversal Location: " << this->TraversalLocation << endl;
+  os << indent << "Storage Mode: "
+     << (this->StorageMode == OFFSETS_STORAGE ? "Offsets" : "Legacy") << endl;
+  os << indent << "Use 32 Bit Storage: "
+     << (this->Use32BitStorage ? "On" : "Off") << endl;
 }
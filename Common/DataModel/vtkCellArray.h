@@ -26,6 +26,14 @@
 // using the vtkCellTypes and vtkCellLinks objects to extend the definition of
 // the data structure.
 //
+// Alternatively, the cells can be kept in two arrays (see SetStorageMode()):
+// an offsets array (o0=0,o1,...,on) with one more value than the number of
+// cells, and a connectivity array with the point ids of all the cells, where
+// the points of cell i are connectivity[oi] ... connectivity[o(i+1)-1].
+// This layout supports O(1) random access to the cells and their traversal
+// in parallel, and it may use 32 bit integers to halve the memory used by
+// large meshes.
+//
 // .SECTION See Also
 // vtkCellTypes vtkCellLinks
 
@@ -48,10 +56,56 @@ public:
   // Instantiate cell array (connectivity list).
   static vtkCellArray *New();
 
+  // Description:
+  // Layouts of the cells, see SetStorageMode().
+  enum StorageModes
+  {
+    LEGACY_STORAGE = 0,
+    OFFSETS_STORAGE = 1
+  };
+
+  // Description:
+  // Select how the cells are stored. LEGACY_STORAGE (the default) is the
+  // (n,id1,id2,...,idn, ...) list. OFFSETS_STORAGE keeps separate offsets
+  // and connectivity arrays (see GetOffsetsArray()). The cells already in
+  // the array are converted. With OFFSETS_STORAGE, the "locations" taken or
+  // returned by GetCell(), ReverseCell(), ReplaceCell(),
+  // GetInsertLocation() and GetTraversalLocation() are cell ids, so that
+  // vtkPolyData and vtkUnstructuredGrid access cells in O(1) in both modes.
+  void SetStorageMode(int mode);
+  vtkGetMacro(StorageMode, int);
+  void SetStorageModeToLegacy()
+    {this->SetStorageMode(LEGACY_STORAGE);}
+  void SetStorageModeToOffsets()
+    {this->SetStorageMode(OFFSETS_STORAGE);}
+
+  // Description:
+  // With OFFSETS_STORAGE, store the offsets and the connectivity as 32 bit
+  // integers (vtkTypeInt32Array) rather than vtkIdType. The storage is
+  // converted back to vtkIdType if a point id or the size of the
+  // connectivity does not fit in 32 bits; GetUse32BitStorage() then returns
+  // false. This has no effect when vtkIdType is a 32 bit type.
+  void SetUse32BitStorage(bool use32Bit);
+  vtkGetMacro(Use32BitStorage, bool);
+  void Use32BitStorageOn()
+    {this->SetUse32BitStorage(true);}
+  void Use32BitStorageOff()
+    {this->SetUse32BitStorage(false);}
+
+  // Description:
+  // Return true if the point ids are stored as vtkIdType, so that the
+  // methods returning a vtkIdType pointer to the points of a cell
+  // (GetNextCell(), GetCell()) point into the cell array. Otherwise (32 bit
+  // storage) the ids are copied into a buffer of the cell array, which is
+  // valid until the next call: these methods are then not thread safe, and
+  // writing through the returned pointer does not modify the cell. Use the
+  // methods taking a vtkIdList instead.
+  bool IsStorageShareable()
+    {return !this->Use32BitStorage;}
+
   // Description:
   // Allocate memory and set the size to extend by.
-  int Allocate(const vtkIdType sz, const int ext=1000)
-    {return this->Ia->Allocate(sz,ext);}
+  int Allocate(const vtkIdType sz, const int ext=1000);
 
   // Description:
   // Free any memory and reset to an empty state.
@@ -96,15 +150,15 @@ public:
 
   // Description:
   // Get the size of the allocated connectivity array.
-  vtkIdType GetSize()
-    {return this->Ia->GetSize();}
+  vtkIdType GetSize();
 
   // Description:
   // Get the total number of entries (i.e., data values) in the connectivity
   // array. This may be much less than the allocated size (i.e., return value
-  // from GetSize().)
-  vtkIdType GetNumberOfConnectivityEntries()
-    {return this->Ia->GetMaxId()+1;}
+  // from GetSize().) With OFFSETS_STORAGE, this is the number of entries of
+  // the equivalent legacy array (i.e., the number of point ids plus the
+  // number of cells).
+  vtkIdType GetNumberOfConnectivityEntries();
 
   // Description:
   // Internal method used to retrieve a cell given an offset into
@@ -116,6 +170,24 @@ public:
   // the internal array.
   void GetCell(vtkIdType loc, vtkIdList* pts);
 
+  // Description:
+  // Thread safe version of GetCell(loc, npts, pts). If the storage is not
+  // shareable (see IsStorageShareable()), the ids are copied into ptIds and
+  // pts points to them; ptIds may be NULL otherwise.
+  void GetCell(vtkIdType loc, vtkIdType &npts, const vtkIdType* &pts,
+               vtkIdList *ptIds);
+
+  // Description:
+  // Random access to the cells by cell id: get the number of points of a
+  // cell, or its point ids. The ids are copied into ptIds, or, for the
+  // second method, only when the storage is not shareable. These methods
+  // are thread safe. They take constant time with OFFSETS_STORAGE, and
+  // require a traversal of the previous cells with LEGACY_STORAGE.
+  vtkIdType GetCellSize(vtkIdType cellId);
+  void GetCellAtId(vtkIdType cellId, vtkIdList *ptIds);
+  void GetCellAtId(vtkIdType cellId, vtkIdType &npts, const vtkIdType* &pts,
+                   vtkIdList *ptIds);
+
   // Description:
   // Insert a cell object. Return the cell id of the cell.
   vtkIdType InsertNextCell(vtkCell *cell);
@@ -151,7 +223,10 @@ public:
   // Computes the current insertion location within the internal array.
   // Used in conjunction with GetCell(int loc,...).
   vtkIdType GetInsertLocation(int npts)
-    {return (this->InsertLocation - npts - 1);};
+    {
+    return (this->StorageMode == OFFSETS_STORAGE ? this->NumberOfCells - 1 :
+            this->InsertLocation - npts - 1);
+    };
 
   // Description:
   // Get/Set the current traversal location.
@@ -164,7 +239,10 @@ public:
   // Computes the current traversal location within the internal array. Used
   // in conjunction with GetCell(int loc,...).
   vtkIdType GetTraversalLocation(vtkIdType npts)
-    {return(this->TraversalLocation-npts-1);}
+    {
+    return (this->StorageMode == OFFSETS_STORAGE ? this->TraversalLocation - 1 :
+            this->TraversalLocation - npts - 1);
+    }
 
   // Description:
   // Special method inverts ordering of current cell. Must be called
@@ -181,14 +259,16 @@ public:
   int GetMaxCellSize();
 
   // Description:
-  // Get pointer to array of cell data.
+  // Get pointer to array of cell data. With OFFSETS_STORAGE, the cells are
+  // exported to an array in the legacy layout at each call: the pointer
+  // is for reading only, until the cells are modified.
   vtkIdType *GetPointer()
-    {return this->Ia->GetPointer(0);}
+    {return this->GetData()->GetPointer(0);}
 
   // Description:
   // Get pointer to data array for purpose of direct writes of data. Size is the
   // total storage consumed by the cell array. ncells is the number of cells
-  // represented in the array.
+  // represented in the array. This switches to LEGACY_STORAGE.
   vtkIdType *WritePointer(const vtkIdType ncells, const vtkIdType size);
 
   // Description:
@@ -198,17 +278,36 @@ public:
   // referring these cells becomes invalid (for example, if BuildCells() has
   // been called see vtkPolyData).  The traversal location is reset to the
   // beginning of the list; the insertion location is set to the end of the
-  // list.
+  // list. This switches to LEGACY_STORAGE.
   void SetCells(vtkIdType ncells, vtkIdTypeArray *cells);
 
+  // Description:
+  // Define the cells with OFFSETS_STORAGE from an offsets array (starting at
+  // 0, with one more value than the number of cells) and a connectivity
+  // array. The arrays are used directly, not copied; they must both be
+  // vtkIdTypeArray, or both vtkTypeInt32Array (32 bit storage). The same
+  // caveats as SetCells() apply. Return false if the arrays are not
+  // supported.
+  bool SetData(vtkDataArray *offsets, vtkDataArray *connectivity);
+
+  // Description:
+  // Return the offsets and connectivity arrays of OFFSETS_STORAGE, or NULL
+  // with LEGACY_STORAGE. They are vtkIdTypeArray, or vtkTypeInt32Array when
+  // GetUse32BitStorage() is true.
+  vtkDataArray *GetOffsetsArray()
+    {return this->Offsets;}
+  vtkDataArray *GetConnectivityArray()
+    {return this->Connectivity;}
+
   // Description:
   // Perform a deep copy (no reference counting) of the given cell array.
   void DeepCopy(vtkCellArray *ca);
 
   // Description:
-  // Return the underlying data as a data array.
-  vtkIdTypeArray* GetData()
-    {return this->Ia;}
+  // Return the underlying data as a data array. With OFFSETS_STORAGE, it is
+  // an export of the cells in the legacy layout, rebuilt at each call.
+  // Modifying it does not modify the cells.
+  vtkIdTypeArray* GetData();
 
   // Description:
   // Reuse list. Reset to initial condition.
@@ -216,8 +315,7 @@ public:
 
   // Description:
   // Reclaim any extra memory.
-  void Squeeze()
-    {this->Ia->Squeeze();}
+  void Squeeze();
 
   // Description:
   // Return the memory in kibibytes (1024 bytes) consumed by this cell array. Used to
@@ -237,6 +335,25 @@ protected:
   vtkIdType TraversalLocation;   //keep track of traversal position
   vtkIdTypeArray *Ia;
 
+  // Offsets storage; the offsets have NumberOfCells+1 values.
+  int StorageMode;
+  bool Use32BitStorage;
+  vtkDataArray *Offsets;
+  vtkDataArray *Connectivity;
+  vtkIdList *TempCell; // copy of a cell of the 32 bit storage
+
+  vtkIdType InsertNextOffsetsCell(vtkIdType npts, const vtkIdType* pts);
+  vtkIdType InsertNextOffsetsCell(int npts);
+  void InsertOffsetsCellPoint(vtkIdType id);
+  void UpdateOffsetsCellCount(int npts);
+  void GetOffsetsCell(vtkIdType cellId, vtkIdType &npts, vtkIdType* &pts);
+  void ReverseOffsetsCell(vtkIdType cellId);
+  void ReplaceOffsetsCell(vtkIdType cellId, int npts, const vtkIdType *pts);
+  vtkIdType GetLegacyLocation(vtkIdType cellId);
+  void CreateOffsetsStorage(bool use32Bit);
+  void ReleaseOffsetsStorage();
+  void ExportLegacyFormat(vtkIdTypeArray *cells);
+
 private:
   vtkCellArray(const vtkCellArray&);  // Not implemented.
   void operator=(const vtkCellArray&);  // Not implemented.
@@ -247,6 +364,11 @@ private:
 inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
                                               const vtkIdType* pts)
 {
+  if ( this->StorageMode == OFFSETS_STORAGE )
+    {
+    return this->InsertNextOffsetsCell(npts, pts);
+    }
+
   vtkIdType i = this->Ia->GetMaxId() + 1;
   vtkIdType *ptr = this->Ia->WritePointer(i, npts+1);
 
@@ -264,6 +386,11 @@ inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 {
+  if ( this->StorageMode == OFFSETS_STORAGE )
+    {
+    return this->InsertNextOffsetsCell(npts);
+    }
+
   this->InsertLocation = this->Ia->InsertNextValue(npts) + 1;
   this->NumberOfCells++;
 
@@ -273,12 +400,24 @@ inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::InsertCellPoint(vtkIdType id)
 {
+  if ( this->StorageMode == OFFSETS_STORAGE )
+    {
+    this->InsertOffsetsCellPoint(id);
+    return;
+    }
+
   this->Ia->InsertValue(this->InsertLocation++, id);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::UpdateCellCount(int npts)
 {
+  if ( this->StorageMode == OFFSETS_STORAGE )
+    {
+    this->UpdateOffsetsCellCount(npts);
+    return;
+    }
+
   this->Ia->SetValue(this->InsertLocation-npts-1, npts);
 }
 
@@ -302,11 +441,29 @@ inline void vtkCellArray::Reset()
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
   this->Ia->Reset();
+  if ( this->Offsets )
+    {
+    this->Offsets->Reset();
+    this->Offsets->InsertNextTuple1(0);
+    this->Connectivity->Reset();
+    }
 }
 
 //----------------------------------------------------------------------------
 inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 {
+  if ( this->StorageMode == OFFSETS_STORAGE )
+    {
+    if ( this->TraversalLocation < this->NumberOfCells )
+      {
+      this->GetOffsetsCell(this->TraversalLocation++, npts, pts);
+      return 1;
+      }
+    npts=0;
+    pts=0;
+    return 0;
+    }
+
   if ( this->Ia->GetMaxId() >= 0 &&
        this->TraversalLocation <= this->Ia->GetMaxId() )
     {
@@ -324,6 +481,12 @@ inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 inline void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts,
                                   vtkIdType* &pts)
 {
+  if ( this->StorageMode == OFFSETS_STORAGE )
+    {
+    this->GetOffsetsCell(loc, npts, pts);
+    return;
+    }
+
   npts = this->Ia->GetValue(loc++);
   pts  = this->Ia->GetPointer(loc);
 }
@@ -331,6 +494,12 @@ inline void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts,
 //----------------------------------------------------------------------------
 inline void vtkCellArray::ReverseCell(vtkIdType loc)
 {
+  if ( this->StorageMode == OFFSETS_STORAGE )
+    {
+    this->ReverseOffsetsCell(loc);
+    return;
+    }
+
   int i;
   vtkIdType tmp;
   vtkIdType npts=this->Ia->GetValue(loc);
@@ -347,6 +516,12 @@ inline void vtkCellArray::ReverseCell(vtkIdType loc)
 inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
                                       const vtkIdType *pts)
 {
+  if ( this->StorageMode == OFFSETS_STORAGE )
+    {
+    this->ReplaceOffsetsCell(loc, npts, pts);
+    return;
+    }
+
   vtkIdType *oldPts=this->Ia->GetPointer(loc+1);
   for (int i=0; i < npts; i++)
     {
@@ -358,6 +533,7 @@ inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
 inline vtkIdType *vtkCellArray::WritePointer(const vtkIdType ncells,
                                              const vtkIdType size)
 {
+  this->ReleaseOffsetsStorage();
   this->NumberOfCells = ncells;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
@@ -57,6 +57,10 @@ public:
   // Evaluate cylinder function gradient.
   void EvaluateGradient(double x[3], double g[3]);
 
+  // Description:
+  // Return true, see vtkImplicitFunction::CanEvaluateInParallel().
+  virtual bool CanEvaluateInParallel() { return true; }
+
   // Description:
   // Set/Get the cylinder radius.
   vtkSetMacro(Radius,double);
@@ -51,6 +51,7 @@
 
 #include "vtkType.h" //Required for vtkIdType
 #include "vtkDataArray.h" //required for constructor of the vtkDataArrayFunctor
+#include "vtkSOADataArrayTemplate.h" //Required for structure-of-arrays access
 #include <map> //Required for the storage of template params to runtime params
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -66,11 +67,32 @@ struct vtkDataArrayDispatcherPointer
   vtkIdType NumberOfComponents;
   ValueType* RawPointer;
 
+  // Set when the array is a vtkSOADataArrayTemplate. In that case RawPointer
+  // is only valid for single component arrays (it is NULL otherwise, to avoid
+  // building an interleaved copy); use GetValue or the component buffers of
+  // SOAArray instead.
+  vtkSOADataArrayTemplate<ValueType>* SOAArray;
+
   explicit vtkDataArrayDispatcherPointer(vtkDataArray* array):
     NumberOfTuples(array->GetNumberOfTuples()),
     NumberOfComponents(array->GetNumberOfComponents()),
-    RawPointer(static_cast<ValueType*>(array->GetVoidPointer(0)))
-    {}
+    RawPointer(NULL),
+    SOAArray(vtkSOADataArrayTemplate<ValueType>::FastDownCast(array))
+    {
+    if (!this->SOAArray || this->NumberOfComponents == 1)
+      {
+      this->RawPointer = static_cast<ValueType*>(array->GetVoidPointer(0));
+      }
+    }
+
+  // Description:
+  // Return component comp of tuple tupleIdx, whatever the memory layout.
+  ValueType GetValue(vtkIdType tupleIdx, int comp) const
+    {
+    return this->RawPointer ?
+      this->RawPointer[tupleIdx * this->NumberOfComponents + comp] :
+      this->SOAArray->GetTypedComponent(tupleIdx, comp);
+    }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
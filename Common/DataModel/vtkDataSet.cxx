@@ -25,9 +25,13 @@
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredData.h"
+#include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
 #include <cmath>
 
 
@@ -96,36 +100,85 @@ vtkCellIterator *vtkDataSet::NewCellIterator()
   return iter;
 }
 
+namespace
+{
+// Bounds of the points of a data set, through the thread safe
+// GetPoint(id, x), reduced over the threads.
+class DataSetBoundsWorker
+{
+public:
+  DataSetBoundsWorker(vtkDataSet *ds) : DataSet(ds) {}
+
+  void Initialize()
+  {
+    double *b = this->LocalBounds.Local().Bounds;
+    b[0] = b[2] = b[4] = VTK_DOUBLE_MAX;
+    b[1] = b[3] = b[5] = -VTK_DOUBLE_MAX;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double *b = this->LocalBounds.Local().Bounds;
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->DataSet->GetPoint(i, x);
+      for (int j = 0; j < 3; ++j)
+        {
+        b[2*j] = x[j] < b[2*j] ? x[j] : b[2*j];
+        b[2*j+1] = x[j] > b[2*j+1] ? x[j] : b[2*j+1];
+        }
+      }
+  }
+
+  void Reduce()
+  {
+    this->Bounds[0] = this->Bounds[2] = this->Bounds[4] = VTK_DOUBLE_MAX;
+    this->Bounds[1] = this->Bounds[3] = this->Bounds[5] = -VTK_DOUBLE_MAX;
+    vtkSMPThreadLocal<LocalBoundsType>::iterator itr;
+    for (itr = this->LocalBounds.begin(); itr != this->LocalBounds.end();
+         ++itr)
+      {
+      for (int j = 0; j < 3; ++j)
+        {
+        this->Bounds[2*j] = std::min(this->Bounds[2*j], (*itr).Bounds[2*j]);
+        this->Bounds[2*j+1] =
+          std::max(this->Bounds[2*j+1], (*itr).Bounds[2*j+1]);
+        }
+      }
+  }
+
+  double Bounds[6];
+
+private:
+  struct LocalBoundsType
+  {
+    double Bounds[6];
+  };
+
+  vtkDataSet *DataSet;
+  vtkSMPThreadLocal<LocalBoundsType> LocalBounds;
+};
+}
+
 //----------------------------------------------------------------------------
 // Compute the data bounding box from data points.
 void vtkDataSet::ComputeBounds()
 {
-  int j;
-  vtkIdType i;
-  double *x;
-
   if ( this->GetMTime() > this->ComputeTime )
     {
-    if (this->GetNumberOfPoints())
+    const vtkIdType numPts = this->GetNumberOfPoints();
+    if (numPts)
       {
-      x = this->GetPoint(0);
-      this->Bounds[0] = this->Bounds[1] = x[0];
-      this->Bounds[2] = this->Bounds[3] = x[1];
-      this->Bounds[4] = this->Bounds[5] = x[2];
-      for (i=1; i<this->GetNumberOfPoints(); i++)
+      // GetPoint(id, x) is thread safe once it has been called from a
+      // single thread.
+      double x[3];
+      this->GetPoint(0, x);
+      DataSetBoundsWorker worker(this);
+      vtkSMPTools::For(0, numPts, worker);
+      for (int i = 0; i < 6; ++i)
         {
-        x = this->GetPoint(i);
-        for (j=0; j<3; j++)
-          {
-          if ( x[j] < this->Bounds[2*j] )
-            {
-            this->Bounds[2*j] = x[j];
-            }
-          if ( x[j] > this->Bounds[2*j+1] )
-            {
-            this->Bounds[2*j+1] = x[j];
-            }
-          }
+        this->Bounds[i] = worker.Bounds[i];
         }
       }
     else
@@ -266,6 +319,55 @@ unsigned long int vtkDataSet::GetMTime()
   return ( mtime > result ? mtime : result );
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkDataSet::GetGeometryMTime()
+{
+  return this->vtkObject::GetMTime();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkDataSet::GetTopologyMTime()
+{
+  unsigned long mtime, result;
+
+  result = this->vtkObject::GetMTime();
+
+  vtkUnsignedCharArray *ghosts = this->GetPointGhostArray();
+  if ( ghosts )
+    {
+    mtime = ghosts->GetMTime();
+    result = ( mtime > result ? mtime : result );
+    }
+
+  ghosts = this->GetCellGhostArray();
+  if ( ghosts )
+    {
+    mtime = ghosts->GetMTime();
+    result = ( mtime > result ? mtime : result );
+    }
+
+  return result;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkDataSet::GetAttributesMTime()
+{
+  unsigned long mtime, result;
+
+  result = this->PointData->GetMTime();
+
+  mtime = this->CellData->GetMTime();
+  result = ( mtime > result ? mtime : result );
+
+  if ( this->FieldData )
+    {
+    mtime = this->FieldData->GetMTime();
+    result = ( mtime > result ? mtime : result );
+    }
+
+  return result;
+}
+
 //----------------------------------------------------------------------------
 vtkCell *vtkDataSet::FindAndGetCell (double x[3], vtkCell *cell,
                                      vtkIdType cellId, double tol2, int& subId,
@@ -283,6 +385,21 @@ vtkCell *vtkDataSet::FindAndGetCell (double x[3], vtkCell *cell,
   return cell;
 }
 
+//----------------------------------------------------------------------------
+void vtkDataSet::BuildFindCellStructures()
+{
+  this->ComputeBounds();
+  this->GetPointGhostArray();
+  this->GetCellGhostArray();
+
+  if ( this->GetNumberOfCells() > 0 )
+    {
+    vtkGenericCell *cell = vtkGenericCell::New();
+    this->GetCell(0, cell);
+    cell->Delete();
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkDataSet::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
                                   vtkIdList *cellIds)
@@ -308,6 +425,15 @@ void vtkDataSet::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
   otherCells->Delete();
 }
 
+//----------------------------------------------------------------------------
+void vtkDataSet::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                               const vtkIdType*& pts, vtkIdList *ptIds)
+{
+  this->GetCellPoints(cellId, ptIds);
+  npts = ptIds->GetNumberOfIds();
+  pts = ptIds->GetPointer(0);
+}
+
 //----------------------------------------------------------------------------
 void vtkDataSet::GetCellTypes(vtkCellTypes *types)
 {
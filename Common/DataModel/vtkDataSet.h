@@ -142,6 +142,18 @@ public:
   // THE DATASET IS NOT MODIFIED
   virtual void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds) = 0;
 
+  // Description:
+  // Topological inquiry to get points defining cell, without copying them
+  // when possible. On return, pts points to the npts point ids of the cell.
+  // Datasets that store the cell connectivity explicitly (vtkPolyData,
+  // vtkUnstructuredGrid) return a pointer into their connectivity;
+  // otherwise, the ids are copied into ptIds and pts points into ptIds. As
+  // a result, pts is valid until ptIds or the dataset is modified. This
+  // method has the same thread safety as GetCellPoints(cellId, ptIds) when
+  // each thread uses its own ptIds.
+  virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                             const vtkIdType*& pts, vtkIdList *ptIds);
+
   // Description:
   // Topological inquiry to get cells using point.
   // THIS METHOD IS THREAD SAFE IF FIRST CALLED FROM A SINGLE THREAD AND
@@ -190,12 +202,22 @@ public:
   // multithreaded applications. A vtkGenericCell must be passed in
   // to be used in internal calls that might be made to GetCell()
   // THIS METHOD IS THREAD SAFE IF FIRST CALLED FROM A SINGLE THREAD AND
-  // THE DATASET IS NOT MODIFIED
+  // THE DATASET IS NOT MODIFIED. vtkImageData, vtkRectilinearGrid,
+  // vtkStructuredGrid, vtkPolyData and vtkUnstructuredGrid keep all their
+  // scratch in the vtkGenericCell, so once BuildFindCellStructures() has
+  // been called each thread only needs its own vtkGenericCell and weights.
   virtual vtkIdType FindCell(double x[3], vtkCell *cell,
                              vtkGenericCell *gencell, vtkIdType cellId,
                              double tol2, int& subId, double pcoords[3],
                              double *weights) = 0;
 
+  // Description:
+  // Build the structures that FindCell(), GetCell(cellId, gencell) and
+  // GetPointCells() otherwise build on first use (bounds, point locator,
+  // cells, links, ghost arrays...). Call it from a single thread before
+  // calling the above FindCell() concurrently.
+  virtual void BuildFindCellStructures();
+
   // Description:
   // Locate the cell that contains a point and return the cell. Also returns
   // the subcell id, parametric coordinates and weights for subsequent
@@ -212,6 +234,23 @@ public:
   // THIS METHOD IS THREAD SAFE
   unsigned long int GetMTime();
 
+  // Description:
+  // Return the modification time of the geometry of this dataset (its
+  // points, coordinates, origin or spacing), ignoring its attributes.
+  // Together with GetTopologyMTime() and GetAttributesMTime() this lets
+  // filters tell whether only the point, cell or field data changed.
+  virtual unsigned long GetGeometryMTime();
+
+  // Description:
+  // Return the modification time of the topology of this dataset (its
+  // cells), ignoring its attributes. Ghost arrays count as topology since
+  // they blank points and cells.
+  virtual unsigned long GetTopologyMTime();
+
+  // Description:
+  // Return the modification time of the point, cell and field data.
+  unsigned long GetAttributesMTime();
+
   // Description:
   // Return a pointer to this dataset's cell data.
   // THIS METHOD IS THREAD SAFE
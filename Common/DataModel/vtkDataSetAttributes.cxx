@@ -774,13 +774,15 @@ void vtkDataSetAttributes::RemoveArray(int index)
 void vtkDataSetAttributes::CopyData(vtkDataSetAttributes* fromPd,
                                     vtkIdType fromId, vtkIdType toId)
 {
-  int i;
-  for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End();
-      i=this->RequiredArrays.NextIndex())
+  // Index the list rather than iterate over it, so that several threads
+  // can copy distinct tuples at once.
+  int numRequired = this->RequiredArrays.GetListSize();
+  for (int j = 0; j < numRequired; ++j)
     {
+    int i = this->RequiredArrays.GetIndex(j);
     this->CopyTuple(fromPd->Data[i], this->Data[this->TargetIndices[i]],
                     fromId, toId);
-  }
+    }
 }
 
 //--------------------------------------------------------------------------
@@ -832,10 +834,10 @@ void vtkDataSetAttributes::InterpolatePoint(vtkDataSetAttributes *fromPd,
                                             vtkIdType toId, vtkIdList *ptIds,
                                             double *weights)
 {
-  int i;
-  for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End();
-      i=this->RequiredArrays.NextIndex())
+  int numRequired = this->RequiredArrays.GetListSize();
+  for (int j = 0; j < numRequired; ++j)
     {
+    int i = this->RequiredArrays.GetIndex(j);
     vtkAbstractArray* fromArray = this->Data[this->TargetIndices[i]];
     fromArray->InterpolateTuple(toId, ptIds, fromPd->Data[i], weights);
     }
@@ -850,10 +852,10 @@ void vtkDataSetAttributes::InterpolateEdge(vtkDataSetAttributes *fromPd,
                                            vtkIdType toId, vtkIdType p1,
                                            vtkIdType p2, double t)
 {
-  int i;
-  for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End();
-      i=this->RequiredArrays.NextIndex())
+  int numRequired = this->RequiredArrays.GetListSize();
+  for (int j = 0; j < numRequired; ++j)
     {
+    int i = this->RequiredArrays.GetIndex(j);
     vtkAbstractArray* fromArray = fromPd->Data[i];
     vtkAbstractArray* toArray = this->Data[this->TargetIndices[i]];
 
@@ -360,6 +360,13 @@ public:
       {
         return this->List[this->Position];
       }
+    // Return the index at the given position in the list. Unlike the
+    // iteration methods, this does not modify the iterator, so it can be
+    // used from several threads at once.
+    int GetIndex(int position) const
+      {
+        return this->List[position];
+      }
     int BeginIndex()
       {
         this->Position = -1;
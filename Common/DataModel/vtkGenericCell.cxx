@@ -59,13 +59,38 @@ vtkStandardNewMacro(vtkGenericCell);
 // Construct cell.
 vtkGenericCell::vtkGenericCell()
 {
+  for (int i = 0; i < VTK_NUMBER_OF_CELL_TYPES; ++i)
+    {
+    this->CellCache[i] = NULL;
+    }
   this->Cell = vtkEmptyCell::New();
+  this->CellCache[VTK_EMPTY_CELL] = this->Cell;
 }
 
 //----------------------------------------------------------------------------
 vtkGenericCell::~vtkGenericCell()
 {
-  this->Cell->Delete();
+  // The current cell is one of the cached cells
+  for (int i = 0; i < VTK_NUMBER_OF_CELL_TYPES; ++i)
+    {
+    if (this->CellCache[i])
+      {
+      this->CellCache[i]->Delete();
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkGenericCell::ReleaseCachedCells()
+{
+  for (int i = 0; i < VTK_NUMBER_OF_CELL_TYPES; ++i)
+    {
+    if (this->CellCache[i] && this->CellCache[i] != this->Cell)
+      {
+      this->CellCache[i]->Delete();
+      this->CellCache[i] = NULL;
+      }
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -355,25 +380,37 @@ vtkCell *vtkGenericCell::InstantiateCell(int cellType)
 
 //----------------------------------------------------------------------------
 // Set the type of dereferenced cell. Checks to see whether cell type
-// has changed and creates a new cell only if necessary.
+// has changed and creates a new cell only if there is none of this type
+// in the cache.
 void vtkGenericCell::SetCellType(int cellType)
 {
   if ( this->Cell->GetCellType() != cellType )
     {
-    this->Points->UnRegister(this);
-    this->PointIds->UnRegister(this);
-    this->PointIds = NULL;
-    this->Cell->Delete();
-
-    vtkCell *cell = vtkGenericCell::InstantiateCell(cellType);
+    vtkCell *cell = NULL;
+    if ( cellType >= 0 && cellType < VTK_NUMBER_OF_CELL_TYPES )
+      {
+      cell = this->CellCache[cellType];
+      if ( !cell )
+        {
+        cell = vtkGenericCell::InstantiateCell(cellType);
+        this->CellCache[cellType] = cell;
+        }
+      }
 
     if( !cell )
       {
       vtkErrorMacro( << "Unsupported cell type: " << cellType
                      << " Setting to vtkEmptyCell" );
-      cell = vtkEmptyCell::New();
+      cell = this->CellCache[VTK_EMPTY_CELL];
+      if ( !cell )
+        {
+        cell = vtkEmptyCell::New();
+        this->CellCache[VTK_EMPTY_CELL] = cell;
+        }
       }
 
+    this->Points->UnRegister(this);
+    this->PointIds->UnRegister(this);
     this->Cell = cell;
     this->Points = this->Cell->Points;
     this->Points->Register(this);
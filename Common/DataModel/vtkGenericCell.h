@@ -20,6 +20,13 @@
 // like any type of cell, it just dereferences an internal representation.
 // The SetCellType() methods use \#define constants; these are defined in
 // the file vtkCellType.h.
+//
+// The concrete cells are created on demand and kept in a per-type cache
+// until the generic cell is deleted, so that alternating between the cell
+// types of a mixed mesh does not allocate. Since a vtkGenericCell is not
+// shared between threads, vtkSMPThreadLocalObject<vtkGenericCell> is the
+// natural pool of cells for the functors of vtkSMPTools: each thread gets
+// its own generic cell, with its own cache, on first use.
 
 // .SECTION See Also
 // vtkCell vtkDataSet
@@ -103,6 +110,8 @@ public:
   // dereferencing an internal instance of a concrete cell type. When
   // you set the cell type, you are resetting a pointer to an internal
   // cell which is then used for computation.
+  // The cells of the previous types are kept for later use; their points
+  // and point ids are not reset.
   void SetCellType(int cellType);
   void SetCellTypeToEmptyCell() {this->SetCellType(VTK_EMPTY_CELL);}
   void SetCellTypeToVertex() {this->SetCellType(VTK_VERTEX);}
@@ -147,11 +156,20 @@ public:
   // Instantiate a new vtkCell based on it's cell type value
   static vtkCell* InstantiateCell(int cellType);
 
+  // Description:
+  // Get the concrete cell currently dereferenced.
+  vtkCell *GetRepresentativeCell() { return this->Cell; }
+
+  // Description:
+  // Delete the cached cells of the types other than the current one.
+  void ReleaseCachedCells();
+
 protected:
   vtkGenericCell();
   ~vtkGenericCell();
 
   vtkCell *Cell;
+  vtkCell *CellCache[VTK_NUMBER_OF_CELL_TYPES];
 
 private:
   vtkGenericCell(const vtkGenericCell&);  // Not implemented.
@@ -242,6 +242,14 @@ unsigned long int vtkGraph::GetMTime()
 //----------------------------------------------------------------------------
 void vtkGraph::Initialize()
 {
+  if (this->Internals->Compressed)
+    {
+    // Start from empty lists rather than decompressing the adjacency.
+    vtkGraphInternals *internals = vtkGraphInternals::New();
+    internals->UsingPedigreeIds = this->Internals->UsingPedigreeIds;
+    this->SetInternals(internals);
+    internals->Delete();
+    }
   this->ForceOwnership();
   Superclass::Initialize();
   this->EdgeData->Initialize();
@@ -290,7 +298,10 @@ vtkOutEdgeType vtkGraph::GetOutEdge(vtkIdType v, vtkIdType i)
 
   if (i < this->GetOutDegree(v))
     {
-    return this->Internals->Adjacency[index].OutEdges[i];
+    const vtkOutEdgeType *edges;
+    vtkIdType nedges;
+    this->Internals->GetOutEdges(index, edges, nedges);
+    return edges[i];
     }
   vtkErrorMacro("Out edge index out of bounds");
   return vtkOutEdgeType();
@@ -321,15 +332,7 @@ void vtkGraph::GetOutEdges(vtkIdType v, const vtkOutEdgeType *& edges, vtkIdType
     index = helper->GetVertexIndex(v);
     }
 
-  nedges = this->Internals->Adjacency[index].OutEdges.size();
-  if (nedges > 0)
-    {
-    edges = &(this->Internals->Adjacency[index].OutEdges[0]);
-    }
-  else
-    {
-    edges = 0;
-    }
+  this->Internals->GetOutEdges(index, edges, nedges);
 }
 
 //----------------------------------------------------------------------------
@@ -347,7 +350,10 @@ vtkIdType vtkGraph::GetOutDegree(vtkIdType v)
 
     index = helper->GetVertexIndex(v);
     }
-  return this->Internals->Adjacency[index].OutEdges.size();
+  const vtkOutEdgeType *edges;
+  vtkIdType nedges;
+  this->Internals->GetOutEdges(index, edges, nedges);
+  return nedges;
 }
 
 //----------------------------------------------------------------------------
@@ -367,8 +373,12 @@ vtkIdType vtkGraph::GetDegree(vtkIdType v)
     index = helper->GetVertexIndex(v);
     }
 
-  return this->Internals->Adjacency[index].InEdges.size() +
-         this->Internals->Adjacency[index].OutEdges.size();
+  const vtkOutEdgeType *outEdges;
+  const vtkInEdgeType *inEdges;
+  vtkIdType nout, nin;
+  this->Internals->GetOutEdges(index, outEdges, nout);
+  this->Internals->GetInEdges(index, inEdges, nin);
+  return nin + nout;
 }
 
 //----------------------------------------------------------------------------
@@ -407,7 +417,10 @@ vtkInEdgeType vtkGraph::GetInEdge(vtkIdType v, vtkIdType i)
 
   if (i < this->GetInDegree(v))
     {
-    return this->Internals->Adjacency[index].InEdges[i];
+    const vtkInEdgeType *edges;
+    vtkIdType nedges;
+    this->Internals->GetInEdges(index, edges, nedges);
+    return edges[i];
     }
   vtkErrorMacro("In edge index out of bounds");
   return vtkInEdgeType();
@@ -439,15 +452,7 @@ void vtkGraph::GetInEdges(vtkIdType v, const vtkInEdgeType *& edges, vtkIdType &
     index = helper->GetVertexIndex(v);
     }
 
-  nedges = this->Internals->Adjacency[index].InEdges.size();
-  if (nedges > 0)
-    {
-    edges = &(this->Internals->Adjacency[index].InEdges[0]);
-    }
-  else
-    {
-    edges = 0;
-    }
+  this->Internals->GetInEdges(index, edges, nedges);
 }
 
 //----------------------------------------------------------------------------
@@ -467,7 +472,10 @@ vtkIdType vtkGraph::GetInDegree(vtkIdType v)
     index = helper->GetVertexIndex(v);
     }
 
-  return this->Internals->Adjacency[index].InEdges.size();
+  const vtkInEdgeType *edges;
+  vtkIdType nedges;
+  this->Internals->GetInEdges(index, edges, nedges);
+  return nedges;
 }
 
 //----------------------------------------------------------------------------
@@ -516,7 +524,7 @@ void vtkGraph::GetVertices(vtkVertexListIterator *it)
 //----------------------------------------------------------------------------
 vtkIdType vtkGraph::GetNumberOfVertices()
 {
-  return this->Internals->Adjacency.size();
+  return this->Internals->GetNumberOfVertices();
 }
 
 //----------------------------------------------------------------------------
@@ -600,6 +608,39 @@ bool vtkGraph::CheckedDeepCopy(vtkGraph *g)
   return valid;
 }
 
+//----------------------------------------------------------------------------
+bool vtkGraph::CheckedCompressedCopy(vtkGraph *g)
+{
+  if (!g)
+    {
+    return false;
+    }
+  if (g->DistributedHelper)
+    {
+    vtkErrorMacro("Cannot compress the adjacency of a distributed graph.");
+    return false;
+    }
+  bool valid = this->IsStructureValid(g);
+  if (valid)
+    {
+    this->CopyInternal(g, false);
+    if (!this->Internals->Compressed)
+      {
+      vtkGraphInternals *internals = vtkGraphInternals::New();
+      internals->Compress(g->Internals);
+      this->SetInternals(internals);
+      internals->Delete();
+      }
+    }
+  return valid;
+}
+
+//----------------------------------------------------------------------------
+bool vtkGraph::IsCompressed()
+{
+  return this->Internals->Compressed;
+}
+
 //----------------------------------------------------------------------------
 void vtkGraph::ShallowCopy(vtkDataObject *obj)
 {
@@ -1771,10 +1812,17 @@ void vtkGraph::ForceOwnership()
     {
     vtkGraphInternals *internals = vtkGraphInternals::New();
     internals->Adjacency = this->Internals->Adjacency;
+    internals->Compressed = this->Internals->Compressed;
+    internals->OutOffsets = this->Internals->OutOffsets;
+    internals->CompressedOutEdges = this->Internals->CompressedOutEdges;
+    internals->InOffsets = this->Internals->InOffsets;
+    internals->CompressedInEdges = this->Internals->CompressedInEdges;
     internals->NumberOfEdges = this->Internals->NumberOfEdges;
     this->SetInternals(internals);
     internals->Delete();
     }
+  // The adjacency lists are modified in place.
+  this->Internals->Decompress();
   if (this->EdgePoints && this->EdgePoints->GetReferenceCount() > 1)
     {
     vtkGraphEdgePoints *oldEdgePoints = this->EdgePoints;
@@ -1815,19 +1863,24 @@ vtkIdType vtkGraph::GetNumberOfElements(int type)
 void vtkGraph::Dump()
 {
   cout << "vertex adjacency:" << endl;
-  for (size_t v = 0; v < this->Internals->Adjacency.size(); ++v)
+  for (vtkIdType v = 0; v < this->Internals->GetNumberOfVertices(); ++v)
     {
+    const vtkOutEdgeType *outEdges;
+    const vtkInEdgeType *inEdges;
+    vtkIdType nout, nin;
+    this->Internals->GetOutEdges(v, outEdges, nout);
+    this->Internals->GetInEdges(v, inEdges, nin);
     cout << v << " (out): ";
-    for (size_t eind = 0; eind < this->Internals->Adjacency[v].OutEdges.size(); ++eind)
+    for (vtkIdType eind = 0; eind < nout; ++eind)
       {
-      cout << "[" << this->Internals->Adjacency[v].OutEdges[eind].Id
-           << "," << this->Internals->Adjacency[v].OutEdges[eind].Target << "]";
+      cout << "[" << outEdges[eind].Id
+           << "," << outEdges[eind].Target << "]";
       }
     cout << " (in): ";
-    for (size_t eind = 0; eind < this->Internals->Adjacency[v].InEdges.size(); ++eind)
+    for (vtkIdType eind = 0; eind < nin; ++eind)
       {
-      cout << "[" << this->Internals->Adjacency[v].InEdges[eind].Id
-           << "," << this->Internals->Adjacency[v].InEdges[eind].Source << "]";
+      cout << "[" << inEdges[eind].Id
+           << "," << inEdges[eind].Source << "]";
       }
     cout << endl;
     }
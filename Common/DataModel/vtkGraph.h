@@ -461,6 +461,23 @@ public:
   // returns false.
   virtual bool CheckedDeepCopy(vtkGraph *g);
 
+  // Description:
+  // Performs the same operation as CheckedShallowCopy(), but stores the
+  // adjacency of this graph in compressed sparse row form: the out and in
+  // edges of all the vertices are kept in two contiguous arrays, which takes
+  // much less memory than the per-vertex lists for large graphs and is
+  // faster to traverse with the edge iterators. g is not modified, and may
+  // be deleted afterwards to release its lists. The first modification of
+  // the structure of this graph, e.g. once copied to a mutable graph,
+  // converts its adjacency back to lists. Distributed graphs cannot be
+  // compressed.
+  virtual bool CheckedCompressedCopy(vtkGraph *g);
+
+  // Description:
+  // Whether the adjacency of this graph is in compressed sparse row form.
+  // See CheckedCompressedCopy().
+  bool IsCompressed();
+
   // Description:
   // Reclaim unused memory.
   virtual void Squeeze();
@@ -685,6 +702,7 @@ protected:
   friend class vtkEdgeListIterator;
   friend class vtkInEdgeIterator;
   friend class vtkOutEdgeIterator;
+  friend class vtkGraphFrontier;
   friend class boost::vtk_edge_iterator;
   friend class boost::vtk_in_edge_pointer_iterator;
   friend class boost::vtk_out_edge_pointer_iterator;
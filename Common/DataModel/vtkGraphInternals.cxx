@@ -21,6 +21,8 @@
 #include "vtkDistributedGraphHelper.h"
 #include "vtkObjectFactory.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkGraphInternals);
 
 //----------------------------------------------------------------------------
@@ -29,6 +31,7 @@ vtkGraphInternals::vtkGraphInternals()
   this->NumberOfEdges = 0;
   this->LastRemoteEdgeId = -1;
   this->UsingPedigreeIds = false;
+  this->Compressed = false;
 }
 
 //----------------------------------------------------------------------------
@@ -36,6 +39,81 @@ vtkGraphInternals::~vtkGraphInternals()
 {
 }
 
+//----------------------------------------------------------------------------
+void vtkGraphInternals::Compress(vtkGraphInternals *source)
+{
+  vtkIdType numVerts = source->GetNumberOfVertices();
+  std::vector<vtkIdType> outOffsets(numVerts + 1);
+  std::vector<vtkIdType> inOffsets(numVerts + 1);
+  outOffsets[0] = inOffsets[0] = 0;
+  for (vtkIdType v = 0; v < numVerts; ++v)
+    {
+    vtkIdType nout, nin;
+    const vtkOutEdgeType *outEdges;
+    const vtkInEdgeType *inEdges;
+    source->GetOutEdges(v, outEdges, nout);
+    source->GetInEdges(v, inEdges, nin);
+    outOffsets[v + 1] = outOffsets[v] + nout;
+    inOffsets[v + 1] = inOffsets[v] + nin;
+    }
+
+  std::vector<vtkOutEdgeType> compressedOutEdges(outOffsets[numVerts]);
+  std::vector<vtkInEdgeType> compressedInEdges(inOffsets[numVerts]);
+  for (vtkIdType v = 0; v < numVerts; ++v)
+    {
+    vtkIdType nout, nin;
+    const vtkOutEdgeType *outEdges;
+    const vtkInEdgeType *inEdges;
+    source->GetOutEdges(v, outEdges, nout);
+    source->GetInEdges(v, inEdges, nin);
+    std::copy(outEdges, outEdges + nout,
+              compressedOutEdges.begin() + outOffsets[v]);
+    std::copy(inEdges, inEdges + nin,
+              compressedInEdges.begin() + inOffsets[v]);
+    }
+  if (inOffsets[numVerts] == 0)
+    {
+    inOffsets.clear();
+    }
+
+  // Swap rather than assign, so that the memory of the lists is released.
+  std::vector<vtkVertexAdjacencyList>().swap(this->Adjacency);
+  this->OutOffsets.swap(outOffsets);
+  this->CompressedOutEdges.swap(compressedOutEdges);
+  this->InOffsets.swap(inOffsets);
+  this->CompressedInEdges.swap(compressedInEdges);
+  this->NumberOfEdges = source->NumberOfEdges;
+  this->UsingPedigreeIds = source->UsingPedigreeIds;
+  this->Compressed = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkGraphInternals::Decompress()
+{
+  if (!this->Compressed)
+    {
+    return;
+    }
+  vtkIdType numVerts = this->GetNumberOfVertices();
+  std::vector<vtkVertexAdjacencyList> adjacency(numVerts);
+  for (vtkIdType v = 0; v < numVerts; ++v)
+    {
+    vtkIdType nout, nin;
+    const vtkOutEdgeType *outEdges;
+    const vtkInEdgeType *inEdges;
+    this->GetOutEdges(v, outEdges, nout);
+    this->GetInEdges(v, inEdges, nin);
+    adjacency[v].OutEdges.assign(outEdges, outEdges + nout);
+    adjacency[v].InEdges.assign(inEdges, inEdges + nin);
+    }
+  this->Adjacency.swap(adjacency);
+  std::vector<vtkIdType>().swap(this->OutOffsets);
+  std::vector<vtkOutEdgeType>().swap(this->CompressedOutEdges);
+  std::vector<vtkIdType>().swap(this->InOffsets);
+  std::vector<vtkInEdgeType>().swap(this->CompressedInEdges);
+  this->Compressed = false;
+}
+
 //----------------------------------------------------------------------------
 void vtkGraphInternals::RemoveEdgeFromOutList(vtkIdType e, std::vector<vtkOutEdgeType>& outEdges)
 {
@@ -53,6 +53,18 @@ public:
   //BTX
   vtkTypeMacro(vtkGraphInternals, vtkObject);
   std::vector<vtkVertexAdjacencyList> Adjacency;
+
+  // Description:
+  // Compressed sparse row form of the adjacency, used instead of Adjacency
+  // when Compressed is true. The out edges of vertex v are
+  // CompressedOutEdges[OutOffsets[v]] to CompressedOutEdges[OutOffsets[v+1]],
+  // excluded, and likewise for the in edges. InOffsets is empty when no
+  // vertex has in edges, as in undirected graphs.
+  bool Compressed;
+  std::vector<vtkIdType> OutOffsets;
+  std::vector<vtkOutEdgeType> CompressedOutEdges;
+  std::vector<vtkIdType> InOffsets;
+  std::vector<vtkInEdgeType> CompressedInEdges;
   //ETX
   vtkIdType NumberOfEdges;
 
@@ -67,6 +79,61 @@ public:
   // vtkMutableDirectedGraph.
   bool UsingPedigreeIds;
 
+  // Description:
+  // The number of vertices, in either form of the adjacency.
+  vtkIdType GetNumberOfVertices()
+    {
+    return this->Compressed ?
+      static_cast<vtkIdType>(this->OutOffsets.size()) - 1 :
+      static_cast<vtkIdType>(this->Adjacency.size());
+    }
+
+  //BTX
+  // Description:
+  // The out and in edges of the vertex at index v, in either form of the
+  // adjacency. edges is NULL when nedges is 0.
+  void GetOutEdges(vtkIdType v, const vtkOutEdgeType *& edges,
+                   vtkIdType & nedges)
+    {
+    if (this->Compressed)
+      {
+      nedges = this->OutOffsets[v + 1] - this->OutOffsets[v];
+      edges = nedges ? &this->CompressedOutEdges[this->OutOffsets[v]] : 0;
+      }
+    else
+      {
+      nedges = static_cast<vtkIdType>(this->Adjacency[v].OutEdges.size());
+      edges = nedges ? &this->Adjacency[v].OutEdges[0] : 0;
+      }
+    }
+  void GetInEdges(vtkIdType v, const vtkInEdgeType *& edges,
+                  vtkIdType & nedges)
+    {
+    if (this->Compressed)
+      {
+      nedges = this->InOffsets.empty() ? 0 :
+        this->InOffsets[v + 1] - this->InOffsets[v];
+      edges = nedges ? &this->CompressedInEdges[this->InOffsets[v]] : 0;
+      }
+    else
+      {
+      nedges = static_cast<vtkIdType>(this->Adjacency[v].InEdges.size());
+      edges = nedges ? &this->Adjacency[v].InEdges[0] : 0;
+      }
+    }
+  //ETX
+
+  // Description:
+  // Stores the adjacency of source in compressed sparse row form in this
+  // object, and copies its number of edges. The adjacency lists of this
+  // object are released.
+  void Compress(vtkGraphInternals *source);
+
+  // Description:
+  // Converts the compressed adjacency back to adjacency lists, so that
+  // the graph can be modified. Does nothing if it is not compressed.
+  void Decompress();
+
   //BTX
   // Description:
   // Convenience method for removing an edge from an out edge list.
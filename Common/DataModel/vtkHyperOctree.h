@@ -310,6 +310,7 @@ public:
   virtual void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds);
   virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
                              vtkIdType* &pts);
+  using vtkDataSet::GetCellPoints;
 
   // Description:
   // Topological inquiry to get cells using point.
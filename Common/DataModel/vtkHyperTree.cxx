@@ -17,9 +17,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkHyperTreeCursor.h"
 #include "vtkObjectFactory.h"
 
-#include <deque>
 #include <vector>
-#include <map>
 
 #include <cassert>
 
@@ -27,7 +25,6 @@ PURPOSE.  See the above copyright notice for more information.
 // The template value N describes the number of children to binary and
 // ternary trees.
 template<int N> class vtkCompactHyperTree;
-template<int N> class vtkCompactHyperTreeNode;
 
 template<int N> class vtkCompactHyperTreeCursor : public vtkHyperTreeCursor
 {
@@ -79,12 +76,7 @@ public:
   //---------------------------------------------------------------------------
   virtual bool IsTerminalNode()
   {
-    bool result = ! this->Leaf;
-    if( result )
-      {
-      vtkCompactHyperTreeNode<N>* node = this->Tree->GetNode( this->Index );
-      result = node->IsTerminalNode();
-      }
+    bool result = ! this->Leaf && this->Tree->IsTerminalNode( this->Index );
     // A=>B: notA or B
     assert( "post: compatible" && ( ! result || ! this->Leaf) );
     return result;
@@ -93,28 +85,26 @@ public:
   //---------------------------------------------------------------------------
   virtual bool IsRoot()
   {
-    return ( ! this->Leaf && this->Index == 0 )
-      || ( this->Leaf && ! this->Index && this->Tree->GetLeafParentSize() == 1 );
+    return this->Index == 0;
   }
 
   //---------------------------------------------------------------------------
   virtual int GetCurrentLevel()
   {
-    int result = this->GetChildHistorySize();
-    assert( "post: positive_result" && result >= 0 );
-    return result;
+    assert( "post: positive_result" && this->Level >= 0 );
+    return this->Level;
   }
 
   //---------------------------------------------------------------------------
   // Description:
   // Return the child number of the current node relative to its parent.
+  // Siblings have consecutive indices, so this is deduced from the index.
   // \pre not_root: !IsRoot().
   // \post valid_range: result >= 0 && result<GetNumberOfChildren()
   virtual int GetChildIndex()
   {
-    assert( "post: valid_range" && this->ChildIndex >= 0 &&
-      this->ChildIndex < GetNumberOfChildren() );
-    return this->ChildIndex;
+    assert( "pre: not_root" && ! this->IsRoot() );
+    return static_cast<int>( ( this->Index - 1 ) % N );
   }
 
   //---------------------------------------------------------------------------
@@ -123,10 +113,9 @@ public:
   // \post is_root: IsRoot()
   virtual void ToRoot()
   {
-    this->ChildHistory.clear();
-    this->Leaf = ( this->Tree->GetLeafParentSize() == 1 );
-    this->Index = this->Leaf ? 0 : 1;
-    this->ChildIndex = 0;
+    this->Index = 0;
+    this->Level = 0;
+    this->Leaf = this->Tree->IsLeaf( 0 );
     memset( this->Indices, 0, 3 * sizeof(int) );
   }
 
@@ -135,13 +124,9 @@ public:
   virtual void ToParent()
   {
     assert( "pre: not_root" && !IsRoot() );
-    this->Index = this->Leaf ?
-      this->Tree->GetLeafParent( this->Index ) :
-      this->Tree->GetNode( this->Index )->GetParent();
-
+    this->Index = this->Tree->GetParent( this->Index );
     this->Leaf = false;
-    this->ChildIndex = this->ChildHistory.back(); // top()
-    this->ChildHistory.pop_back();
+    -- this->Level;
 
     for ( unsigned int i = 0; i < this->Dimension;  ++ i )
       {
@@ -158,11 +143,9 @@ public:
     assert( "pre: valid_child" && child >= 0
       && child < this->GetNumberOfChildren() );
 
-    vtkCompactHyperTreeNode<N>* node = this->Tree->GetNode( this->Index );
-    this->ChildHistory.push_back( this->ChildIndex );
-    this->ChildIndex = child;
-    this->Index = node->GetChild( child );
-    this->Leaf = node->IsChildLeaf( child );
+    this->Index = this->Tree->GetElderChild( this->Index ) + child;
+    this->Leaf = this->Tree->IsLeaf( this->Index );
+    ++ this->Level;
 
     int tmpChild = child;
     int branchFactor = this->Tree->GetBranchFactor();
@@ -192,9 +175,8 @@ public:
       static_cast<vtkCompactHyperTreeCursor<N> *>( other );
 
     this->Index = o->Index;
-    this->ChildIndex = o->ChildIndex;
+    this->Level = o->Level;
     this->Leaf = o->Leaf;
-    this->ChildHistory = o->ChildHistory; // use assignment operator
     memcpy( this->Indices, o->Indices, 3 * sizeof(int) );
 
     assert( "post: equal" && this->IsEqual(other) );
@@ -214,9 +196,8 @@ public:
       static_cast<vtkCompactHyperTreeCursor<N> *>( other );
 
     bool result = this->Index == o->Index
-      && this->ChildIndex == o->ChildIndex
-      && this->Leaf == o->Leaf
-      && this->ChildHistory == o->ChildHistory;
+      && this->Level == o->Level
+      && this->Leaf == o->Leaf;
 
     for ( unsigned int i = 0; result && i < this->Dimension; ++ i )
       {
@@ -315,7 +296,7 @@ public:
         {
         int digit = tmpIndices[i] / mask;
         tmpIndices[i] -= digit*mask;
-        child *= child * this->Tree->GetBranchFactor() + digit;
+        child = child * this->Tree->GetBranchFactor() + digit;
         -- i;
         }
       this->ToChild( child );
@@ -332,38 +313,12 @@ public:
   }
 
   //---------------------------------------------------------------------------
-  // NB: Public only for the vtkCompactHyperTreeCursor.
+  // NB: Public only for the vtkCompactHyperTree.
   void SetIsLeaf( bool value )
   {
     this->Leaf = value;
   }
 
-  //---------------------------------------------------------------------------
-  void SetChildIndex(int childIndex )
-  {
-    assert( "pre: valid_range" && childIndex >= 0
-      && childIndex<GetNumberOfChildren() );
-    this->ChildIndex = childIndex;
-    assert( "post: is_set" && childIndex==GetChildIndex() );
-  }
-
-  //---------------------------------------------------------------------------
-  // Description:
-  // Public only for vtkCompactHyperTree.
-  void SetIndex( vtkIdType index )
-  {
-    assert( "pre: positive_index" && index >= 0 );
-    this->Index = index;
-  }
-
-  //---------------------------------------------------------------------------
-  // Description:
-  // Public only for vtkCompactHyperTree.
-  vtkIdType GetChildHistorySize()
-  {
-    return static_cast<vtkIdType>( this->ChildHistory.size() );
-  }
-
 protected:
   //---------------------------------------------------------------------------
   vtkCompactHyperTreeCursor()
@@ -388,26 +343,24 @@ protected:
       }
     this->Tree = 0;
     this->Index = 0;
+    this->Level = 0;
+    this->IsFound = false;
     this->Leaf = false;
-    this->ChildIndex = 0;
     memset( this->Indices, 0, 3 * sizeof(int) );
   }
 
   vtkCompactHyperTree<N> *Tree;
   unsigned char Dimension;
 
-  // Index either in the Nodes or Parents (if leaf)
+  // Index of the current vertex in the tree
   vtkIdType Index;
 
-  // Number of current node as a child
-  int ChildIndex;
+  // Depth of the current vertex, the root being at level 0
+  int Level;
 
   bool IsFound;
   bool Leaf;
 
-  // A stack, but stack does not have clear()
-  std::deque<int> ChildHistory;
-
   // Index in each dimension of the current node, as if the tree at the current
   // level were a uniform grid. Default to 3 dimensions, use only those needed
   int Indices[3];
@@ -417,176 +370,17 @@ private:
   void operator=(const vtkCompactHyperTreeCursor<N> &);    // Not implemented.
 };
 
-// We could use a 4 byte int, but the internals are completely hidden.
-class vtkHyperTreeLeafFlags
-{
-public:
-  vtkHyperTreeLeafFlags()
-  { // Unused bits are set to 1.
-    for ( int i = 0; i < 4; ++ i )
-      {
-      this->Flags[i] = 0xFF;
-      }
-  }
-
-  // True if all chilren are leaves.
-  bool IsTerminal()
-  {
-    // Unused bits are set to 1.
-    return this->Flags[0] == 0xFF
-      && this->Flags[1] == 0xFF
-      && this->Flags[2] == 0xFF;
-  }
-
-  void SetLeafFlag(int idx, bool val)
-  {
-    assert( "Valid child idx" && idx >= 0 && idx < 32);
-    int i = 0;
-    while ( idx >= 8 )
-      {
-      ++ i;
-      idx -= 8;
-      }
-    unsigned char mask = 1 << idx;
-    this->Flags[i] = val ?
-      ( this->Flags[i] | mask ) : ( this->Flags[i] & (mask ^ 0xFF) );
-  }
-
-  bool GetLeafFlag(int idx)
-  {
-    assert( "Valid child idx" && idx >= 0 && idx < 32);
-    int i = 0;
-    while ( idx >= 8 )
-      {
-      ++ i;
-      idx -= 8;
-      }
-    unsigned char mask = 1 << idx;
-    return ( mask & this->Flags[i] ) == mask;
-  }
-
-  void PrintSelf(ostream& os, int numChildren)
-  {
-    assert( "Number of children" && numChildren >= 0 && numChildren < 32);
-    int childIdx = 0;
-    int byteIdx = 0;
-    unsigned char mask = 1;
-    while ( childIdx < numChildren )
-      {
-      os << ( ( this->Flags[byteIdx] & mask ) == mask );
-      ++childIdx;
-      if ( mask == 128 )
-        {
-        mask = 1;
-        ++byteIdx;
-        }
-      else
-        {
-        mask <<= 1;
-        }
-      }
-    os << endl;
-  }
-
-private:
-  unsigned char Flags[4];
-};
-
 // Description:
-// A node of the Tree which is not a leaf.
-// Expected template values: 4, 8, 9, 27.
-template<int N> class vtkCompactHyperTreeNode
-{
-public:
-  //---------------------------------------------------------------------------
-  // Description:
-  // See GetParent().
-  void SetParent(vtkIdType parent)
-  {
-    assert( "pre: positive_parent" && parent >= 0 );
-    this->Parent = parent;
-    assert( "post: is_set" && parent == this->GetParent() );
-  }
-
-  //---------------------------------------------------------------------------
-  // Description:
-  // Return the index of the parent node of the current node in the
-  // nodes array of the hyperTree.
-  int GetParent()
-  {
-    assert( "post: positive_result" && this->Parent >= 0 );
-    return this->Parent;
-  }
-
-  //---------------------------------------------------------------------------
-  // Description:
-  // See GetLeafFlags()
-  void SetLeafFlag( vtkIdType childIdx, bool flag )
-  {
-    this->LeafFlags.SetLeafFlag( childIdx, flag );
-  }
-
-  //---------------------------------------------------------------------------
-  // Description
-  // Are children all leaves?
-  bool IsTerminalNode()
-  {
-    return this->LeafFlags.IsTerminal();
-  }
-
-  //---------------------------------------------------------------------------
-  // Description:
-  // Is the `i'-th child of the node a leaf ?
-  bool IsChildLeaf( int i )
-  {
-    assert( "pre: valid_range" && i >= 0 && i < N );
-    return this->LeafFlags.GetLeafFlag( i );
-  }
-
-  //---------------------------------------------------------------------------
-  // Description:
-  // See GetChild().
-  void SetChild( int i, int child )
-  {
-    assert( "pre: valid_range" && i >= 0 && i < N);
-    assert( "pre: positive_child" && child >= 0 );
-    this->Children[i] = child;
-    assert( "post: is_set" && child == this->GetChild( i ) );
-  }
-
-  //---------------------------------------------------------------------------
-  // Description:
-  // Return the index of of the 'i'-th child. If the result of
-  // IsChildLeaf( i ) is true, the index points to an element in the LeafParent
-  // and Attribute arrays of the hyperTree class. If not, the index points to
-  // an element in the Nodes array of the hyperTree class.
-  int GetChild( int i )
-  {
-    assert( "pre: valid_range" && i >= 0 && i < N);
-    assert( "post: positive_result" && this->Children[i] >= 0 );
-    return this->Children[i];
-  }
-
-  //---------------------------------------------------------------------------
-  void PrintSelf( ostream& os, vtkIndent indent )
-  {
-    os << indent << "Parent=" << this->Parent << endl;
-    os << indent << "LeafFlags= ";
-    this->LeafFlags.PrintSelf( os, N );
-
-    for( int i = 0; i < N; ++ i )
-      {
-      os << indent << this->Children[i] << endl;
-      }
-  }
-
-protected:
-  //---------------------------------------------------------------------------
-  int Parent; // index
-  vtkHyperTreeLeafFlags LeafFlags;
-  int Children[N];
-};
-
+// A tree whose vertices are numbered in the order of subdivision: the root
+// is vertex 0 and the N children of the k-th subdivided leaf are the
+// consecutive vertices 1+k*N to 1+k*N+N-1. The topology is then stored with
+// two arrays of 32 bit indices only:
+// - ParentToElderChild, indexed by vertex, gives the first child of each
+// subdivided vertex, or 0 for a leaf. Leaves past the end of the array are
+// not stored.
+// - ElderChildIndexToParent gives the parent of each group of N siblings.
+// The tree takes less than 5 bytes per vertex and no per-node object.
+// Expected template values: 2, 3, 4, 8, 9, 27.
 template<int N> class vtkCompactHyperTree : public vtkHyperTree
 {
 public:
@@ -605,20 +399,9 @@ public:
   // Restore the initial state: only one node and one leaf: the root.
   virtual void Initialize()
   {
-    this->Nodes.resize( 1 );
-    this->Nodes[0].SetParent( 0 );
-    for ( int i = 0; i < N; ++ i )
-      {
-      // It is assumed that the root is a special node with only one child.
-      // The other children flags are irrelevant, but set them as nodes for
-      // no good reason.
-      this->Nodes[0].SetLeafFlag( i, i == 0 ); // First child is a leaf
-      this->Nodes[0].SetChild( i, 0 );
-      }
-    this->LeafParent.resize( 1 );
-    this->LeafParent[0] = 0;
+    this->ParentToElderChild.clear();
+    this->ElderChildIndexToParent.clear();
     this->NumberOfLevels = 1;
-    this->NumberOfNodes = 1;
     this->GlobalIndexTable.clear();
     this->GlobalIndexStart = 0;
   }
@@ -637,15 +420,18 @@ public:
   }
 
   //---------------------------------------------------------------------------
+  // Description:
+  // Return the number of vertices of the tree, that is the size of the
+  // attribute arrays indexed by vertex.
   virtual vtkIdType GetNumberOfLeaves()
   {
-    return this->NumberOfNodes;
+    return this->GetNumberOfIndex();
   }
 
   //---------------------------------------------------------------------------
   virtual vtkIdType GetNumberOfIndex()
   {
-    return static_cast<vtkIdType>( this->LeafParent.size() );
+    return 1 + N * static_cast<vtkIdType>( this->ElderChildIndexToParent.size() );
   }
 
   //---------------------------------------------------------------------------
@@ -662,7 +448,7 @@ public:
       this->GlobalIndexTable.resize( local + 1 );
       }
     this->GlobalIndexTable[ local ] = global;
-    if ( local == 0 && this->LeafParent.size() == 1 )
+    if ( local == 0 && this->ElderChildIndexToParent.empty() )
       {
       SetGlobalIndexFromLocal( 1, global );
       }
@@ -688,36 +474,61 @@ public:
 
   //---------------------------------------------------------------------------
   // Description:
+  // Return the number of subdivided vertices.
+  virtual vtkIdType GetNumberOfNodes()
+  {
+    return static_cast<vtkIdType>( this->ElderChildIndexToParent.size() );
+  }
+
+  //---------------------------------------------------------------------------
+  // Description:
+  // Is the given vertex a leaf?
   // Public only for the vtkCompactHyperTreeCursor.
-  vtkCompactHyperTreeNode<N>* GetNode( int nodeIdx )
+  bool IsLeaf( vtkIdType index )
   {
-    assert( "pre: valid_range" && nodeIdx >= 0
-      && nodeIdx < this->GetNumberOfNodes() );
-    return &this->Nodes[nodeIdx];
+    assert( "pre: valid_range" && index >= 0
+      && index < this->GetNumberOfIndex() );
+    return index >= static_cast<vtkIdType>( this->ParentToElderChild.size() )
+      || this->ParentToElderChild[index] == 0;
   }
 
   //---------------------------------------------------------------------------
   // Description:
+  // Return the index of the first child of the given subdivided vertex.
   // Public only for the vtkCompactHyperTreeCursor.
-  // NB: Cursor (index ) appears to be different between nodes and leaves.
-  // Different arrays => overlapping indexes.
-  // I am changing the name for clarity.
-  // This really returns the nodeIdx of the leafs parent.
-  int GetLeafParent( int leafIdx )
+  vtkIdType GetElderChild( vtkIdType index )
   {
-    assert( "pre: valid_range" && leafIdx >= 0
-      && leafIdx < this->GetNumberOfIndex() );
-    assert( "post: valid_result" && this->LeafParent[leafIdx] >= 0
-      && this->LeafParent[leafIdx] < this->GetNumberOfNodes() );
-    return this->LeafParent[leafIdx];
+    assert( "pre: not_leaf" && ! this->IsLeaf( index ) );
+    return static_cast<vtkIdType>( this->ParentToElderChild[index] );
   }
 
   //---------------------------------------------------------------------------
-  // NB: Public only for the vtkCompactHyperTreeCursor.
-  virtual vtkIdType GetNumberOfNodes()
+  // Description:
+  // Return the index of the parent of the given vertex.
+  // Public only for the vtkCompactHyperTreeCursor.
+  vtkIdType GetParent( vtkIdType index )
+  {
+    assert( "pre: not_root" && index > 0
+      && index < this->GetNumberOfIndex() );
+    return static_cast<vtkIdType>(
+      this->ElderChildIndexToParent[( index - 1 ) / N] );
+  }
+
+  //---------------------------------------------------------------------------
+  // Description:
+  // Are all the children of the given subdivided vertex leaves?
+  // Public only for the vtkCompactHyperTreeCursor.
+  bool IsTerminalNode( vtkIdType index )
   {
-    assert( "post: not_empty" && this->Nodes.size() > 0 );
-    return static_cast<vtkIdType>( this->Nodes.size() );
+    vtkIdType child = this->GetElderChild( index );
+    for ( int i = 0; i < N; ++ i, ++ child )
+      {
+      if ( ! this->IsLeaf( child ) )
+        {
+        return false;
+        }
+      }
+    return true;
   }
 
   //---------------------------------------------------------------------------
@@ -730,45 +541,28 @@ public:
     vtkCompactHyperTreeCursor<N>* cursor =
       static_cast<vtkCompactHyperTreeCursor<N> *>(leafCursor);
 
+    // The new children follow all the existing vertices.
+    vtkIdType elderChild = this->GetNumberOfIndex();
+    if ( elderChild + N - 1 > static_cast<vtkIdType>( VTK_UNSIGNED_INT_MAX ) )
+      {
+      vtkErrorMacro( "Too many vertices, cannot subdivide." );
+      return;
+      }
+
     // The leaf becomes a node and is not anymore a leaf
     cursor->SetIsLeaf( false ); // let the cursor know about that change.
     vtkIdType nodeIndex = cursor->GetNodeId();
-
-    // Nodes get constructed with leaf flags set to 1.
-    if ( this->GetNumberOfNodes() <= nodeIndex )
+    if ( static_cast<vtkIdType>( this->ParentToElderChild.size() ) <= nodeIndex )
       {
-      this->Nodes.resize( nodeIndex + 1 );
+      this->ParentToElderChild.resize( nodeIndex + 1, 0 );
       }
-    vtkIdType parentNodeIdx = this->LeafParent[nodeIndex];
-    this->Nodes[nodeIndex].SetParent( parentNodeIdx );
-
-    // Change the parent: it has one less child as a leaf
-    vtkCompactHyperTreeNode<N>& parent = this->Nodes[parentNodeIdx];
-
-    // New nodes index in parents children array.
-    int idx = cursor->GetChildIndex();
-    parent.SetLeafFlag( idx, false );
-    parent.SetChild( idx, static_cast<int>( nodeIndex ) );
-
-    // The first new child
-    // Recycle the leaf index we are deleting because it became a node.
-    // This avoids messy leaf parent array issues.
-    this->NumberOfNodes += N;
-    // The other (N) new children.
-    size_t nextLeaf = this->LeafParent.size();
-    this->LeafParent.resize( nextLeaf + N );
-    for ( int i = 0; i < N; ++ i, ++ nextLeaf )
-      {
-      this->Nodes[nodeIndex].SetChild( i, static_cast<int>( nextLeaf ) );
-      this->LeafParent[nextLeaf] = nodeIndex;
-      this->Nodes[nodeIndex].SetLeafFlag( i, true );
-      }
-
-    // Update the number of leaves per level.
-    vtkIdType level = cursor->GetChildHistorySize();
+    this->ParentToElderChild[nodeIndex] =
+      static_cast<unsigned int>( elderChild );
+    this->ElderChildIndexToParent.push_back(
+      static_cast<unsigned int>( nodeIndex ) );
 
     // Add the new leaves to the number of leaves at the next level.
-    if ( level + 1 == this->NumberOfLevels ) // >=
+    if ( cursor->GetCurrentLevel() + 1 == this->NumberOfLevels ) // >=
       {
       // We have a new level.
       ++ this->NumberOfLevels;
@@ -776,10 +570,15 @@ public:
   }
 
   //---------------------------------------------------------------------------
-  // NB: Bad interface: This is really GetNumberOfLeaves.
-  vtkIdType GetLeafParentSize()
+  // Description:
+  // Find the index and the leaf flag of a child of the subdivided vertex
+  // index, without creating a cursor.
+  virtual void FindChildParameters( int child, vtkIdType& index,
+                                    bool& isLeaf )
   {
-    return static_cast<int>( this->LeafParent.size() );
+    assert( "pre: valid_child" && child >= 0 && child < N );
+    index = this->GetElderChild( index ) + child;
+    isLeaf = this->IsLeaf( index );
   }
 
   //---------------------------------------------------------------------------
@@ -790,17 +589,19 @@ public:
     os << indent << "Dimension=" << this->Dimension << endl;
     os << indent << "BranchFactor=" << this->BranchFactor << endl;
 
-    os << indent << "Nodes=" << this->Nodes.size() << endl;
-    for ( unsigned int i = 0; i < this->Nodes.size(); ++ i )
+    os << indent << "ParentToElderChild="
+       << this->ParentToElderChild.size() << endl;
+    for ( unsigned int i = 0; i < this->ParentToElderChild.size(); ++ i )
       {
-      this->Nodes[i].PrintSelf( os, indent );
+      os << this->ParentToElderChild[i] << " ";
       }
     os << endl;
 
-    os << indent << "LeafParent="<<this->LeafParent.size() << endl;
-    for ( unsigned int i = 0; i < this->LeafParent.size(); ++ i )
+    os << indent << "ElderChildIndexToParent="
+       << this->ElderChildIndexToParent.size() << endl;
+    for ( unsigned int i = 0; i < this->ElderChildIndexToParent.size(); ++ i )
       {
-      os << this->LeafParent[i] << " ";
+      os << this->ElderChildIndexToParent[i] << " ";
       }
     os << endl;
   }
@@ -811,8 +612,8 @@ public:
   // Ignore the attribute array because its size is added by the data set.
   unsigned int GetActualMemorySize()
   {
-    size_t size = sizeof(vtkIdType) * this->LeafParent.size() +
-      sizeof(vtkCompactHyperTreeNode<N>) * this->Nodes.size() +
+    size_t size = sizeof(unsigned int) * this->ParentToElderChild.size() +
+      sizeof(unsigned int) * this->ElderChildIndexToParent.size() +
       sizeof(vtkIdType) * this->GlobalIndexTable.size();
     return static_cast<unsigned int>( size / 1024 );
   }
@@ -889,15 +690,14 @@ protected:
   int Dimension;
   double Scale[3];
   vtkIdType NumberOfLevels;
-  vtkIdType NumberOfNodes;
 
   vtkIdType GlobalIndexStart;
 
-  // Storage for non-leaf tree nodes
-  std::vector<vtkCompactHyperTreeNode<N> > Nodes;
+  // Storage of the first child of each subdivided vertex, 0 for leaves
+  std::vector<unsigned int> ParentToElderChild;
 
-  // Storage to record the parent of each leaf
-  std::vector<vtkIdType> LeafParent;
+  // Storage of the parent of each group of siblings
+  std::vector<unsigned int> ElderChildIndexToParent;
 
   // Storage to record the local to global id mapping
   std::vector<vtkIdType> GlobalIndexTable;
@@ -947,43 +747,8 @@ vtkHyperTree* vtkHyperTree::CreateInstance( unsigned int factor,
 }
 
 //-----------------------------------------------------------------------------
-void vtkHyperTree::FindChildParameters( int child, vtkIdType& index, bool& isLeaf )
+void vtkHyperTree::FindChildParameters( int, vtkIdType&, bool& )
 {
-#define GetNodeParametersMacro( _N_ )                                              \
-  {                                                                                \
-  vtkCompactHyperTree<_N_>* tree = static_cast<vtkCompactHyperTree<_N_>*>( this ); \
-  vtkCompactHyperTreeNode<_N_>* node = tree->GetNode( static_cast<int>(index) );   \
-  index = static_cast<vtkIdType>(node->GetChild( child ));                         \
-  isLeaf = node->IsChildLeaf( child );                                             \
-  return;                                                                          \
-  }
-
-  switch ( this->GetDimension() )
-    {
-    case 3:
-      switch ( this->GetBranchFactor() )
-        {
-        case 2: GetNodeParametersMacro( 8 );
-        case 3: GetNodeParametersMacro( 27 );
-        } // case 3
-      break;
-    case 2:
-      switch ( this->GetBranchFactor() )
-        {
-        case 2: GetNodeParametersMacro( 4 );
-        case 3: GetNodeParametersMacro( 9 );
-        } // case 2
-      break;
-    case 1:
-      switch ( this->GetBranchFactor() )
-        {
-        case 2: GetNodeParametersMacro( 2 );
-        case 3: GetNodeParametersMacro( 3 );
-        } // case 1
-      break;
-    }
-
-#undef GetNodeParametersMacro
-
-  vtkGenericWarningMacro( "Bad branching factor " << this->GetBranchFactor() );
+  vtkWarningMacro( "FindChildParameters is not implemented by "
+                   << this->GetClassName() );
 }
@@ -49,6 +49,10 @@
 //
 // This is an abstract class used as a superclass by a templated compact class.
 // All methods are pure virtual. This is done to hide templates.
+// The compact class numbers the vertices in the order of subdivision, the
+// N children of a node being consecutive, and stores the topology with one
+// 32 bit index per vertex and one per group of siblings, with no per-node
+// object.
 //
 // .SECTION Case with 2^n children
 // * 3D case (octree)
@@ -164,9 +168,13 @@ public:
                                        unsigned int dimension );
 
   // Description:
-  // Find the Index, Parent Index and IsLeaf() parameters of a child for hypertree.
+  // Replace index, the index of a node, by the index of its child-th child
+  // and set isLeaf to true if this child is a leaf. This is how lightweight
+  // cursors such as the ones of vtkHyperTreeGrid descend a tree without
+  // allocating a vtkHyperTreeCursor.
   // This is done to hide templates.
-  virtual void FindChildParameters( int, vtkIdType&, bool& );
+  virtual void FindChildParameters( int child, vtkIdType& index,
+                                    bool& isLeaf );
 
   // Description:
   // Set the start global index for the current tree.
@@ -24,6 +24,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkGenericCell.h"
 #include "vtkHyperTree.h"
 #include "vtkHyperTreeCursor.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationDoubleVectorKey.h"
@@ -56,10 +57,16 @@ vtkCxxSetObjectMacro( vtkHyperTreeGrid, YCoordinates, vtkDataArray );
 vtkCxxSetObjectMacro( vtkHyperTreeGrid, ZCoordinates, vtkDataArray );
 
 // Helpers to quickly fetch a HT at a given index or iterator
-#define GetHTGHyperTreeAtIndexMacro( _obj_, _index_ )             \
-  ( static_cast<vtkHyperTree*>(                                   \
-  _obj_->HyperTrees.find( _index_ ) != _obj_->HyperTrees.end() ?  \
-  _obj_->HyperTrees[ _index_ ] : 0 ) )
+// Look up a tree without inserting, so that concurrent lookups are safe
+static vtkHyperTree* vtkHyperTreeGridFindTree(
+  const std::map<vtkIdType, vtkHyperTree*>& trees, vtkIdType index )
+{
+  std::map<vtkIdType, vtkHyperTree*>::const_iterator it = trees.find( index );
+  return it != trees.end() ? it->second : 0;
+}
+
+#define GetHTGHyperTreeAtIndexMacro( _obj_, _index_ ) \
+  vtkHyperTreeGridFindTree( _obj_->HyperTrees, _index_ )
 
 #define GetHyperTreeAtIndexMacro( _index_ ) \
   GetHTGHyperTreeAtIndexMacro( this, _index_ )
@@ -458,6 +465,18 @@ void vtkHyperTreeGrid::InitializeTreeIterator( vtkHyperTreeIterator& it )
   it.Initialize( this );
 }
 
+//-----------------------------------------------------------------------------
+void vtkHyperTreeGrid::GetTreeIndices( vtkIdList* indices )
+{
+  indices->Reset();
+  indices->Allocate( static_cast<vtkIdType>( this->HyperTrees.size() ) );
+  std::map<vtkIdType, vtkHyperTree*>::iterator it = this->HyperTrees.begin();
+  for ( ; it != this->HyperTrees.end(); ++ it )
+    {
+    indices->InsertNextId( it->first );
+    }
+}
+
 //-----------------------------------------------------------------------------
 vtkHyperTreeCursor* vtkHyperTreeGrid::NewCursor( vtkIdType id )
 {
@@ -1070,18 +1089,20 @@ void vtkHyperTreeGrid::InitializeSuperCursor( vtkHyperTreeGridSuperCursor* sc,
                                               vtkIdType index )
 {
   // Location and size of the middle cursor/node
+  // NB: GetComponent() rather than GetTuple1() so that trees can be
+  // processed by several threads at the same time
   double origin[3] =
     {
-    this->XCoordinates->GetTuple1( i ),
-    this->YCoordinates->GetTuple1( j ),
-    this->ZCoordinates->GetTuple1( k )
+    this->XCoordinates->GetComponent( i, 0 ),
+    this->YCoordinates->GetComponent( j, 0 ),
+    this->ZCoordinates->GetComponent( k, 0 )
     };
 
   double extreme[3] =
     {
-    this->XCoordinates->GetTuple1( i + 1 ),
-    this->YCoordinates->GetTuple1( j + 1 ),
-    this->ZCoordinates->GetTuple1( k + 1 )
+    this->XCoordinates->GetComponent( i + 1, 0 ),
+    this->YCoordinates->GetComponent( j + 1, 0 ),
+    this->ZCoordinates->GetComponent( k + 1, 0 )
     };
 
   memcpy( sc->Origin, origin, 3 * sizeof( double ) );
@@ -50,6 +50,7 @@ class vtkCellLinks;
 class vtkCollection;
 class vtkDataArray;
 class vtkDataSetAttributes;
+class vtkIdList;
 class vtkIdTypeArray;
 class vtkLine;
 class vtkPixel;
@@ -293,6 +294,13 @@ public:
   // Initialize an iterator to browse level 0 trees.
   void InitializeTreeIterator( vtkHyperTreeIterator& );
 
+  // Description:
+  // Fill indices with the indices of the level 0 trees, in the order of
+  // vtkHyperTreeIterator. Once GenerateSuperCursorTraversalTable() has been
+  // called, distinct trees can be traversed with super cursors by several
+  // threads at the same time, e.g. with vtkSMPTools over these indices.
+  void GetTreeIndices( vtkIdList* indices );
+
   // Description:
   // Convenience method returns largest cell size in dataset. This is generally
   // used to allocate memory for supporting data structures.
@@ -78,6 +78,7 @@ public:
   virtual void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
     {vtkStructuredData::GetCellPoints(cellId,ptIds,this->DataDescription,
                                       this->GetDimensions());}
+  using vtkDataSet::GetCellPoints;
   virtual void GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
     {vtkStructuredData::GetPointCells(ptId,cellIds,this->GetDimensions());}
   virtual void ComputeBounds();
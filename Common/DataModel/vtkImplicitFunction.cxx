@@ -16,6 +16,8 @@
 
 #include "vtkMath.h"
 #include "vtkAbstractTransform.h"
+#include "vtkDataArray.h"
+#include "vtkSMPTools.h"
 #include "vtkTransform.h"
 
 vtkCxxSetObjectMacro(vtkImplicitFunction,Transform,vtkAbstractTransform);
@@ -72,6 +74,78 @@ double vtkImplicitFunction::FunctionValue(const double x[3])
   */
 }
 
+namespace
+{
+// Evaluates the function over a range of points. The transform, if any, is
+// updated beforehand so that the threads only read it.
+class vtkImplicitFunctionValues
+{
+public:
+  vtkImplicitFunction *Function;
+  vtkAbstractTransform *Transform;
+  vtkDataArray *Input;
+  vtkDataArray *Output;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    double x[3], pt[3], value;
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Input->GetTuple(i, x);
+      if (this->Transform)
+        {
+        this->Transform->InternalTransformPoint(x, pt);
+        value = this->Function->EvaluateFunction(pt);
+        }
+      else
+        {
+        value = this->Function->EvaluateFunction(x);
+        }
+      this->Output->SetTuple(i, &value);
+      }
+    }
+};
+
+bool IsArrayThreadSafe(vtkDataArray *array)
+{
+  return array->GetDataType() != VTK_BIT && array->HasStandardMemoryLayout();
+}
+}
+
+// Evaluate function at the points of an array, in parallel when possible.
+void vtkImplicitFunction::FunctionValue(vtkDataArray *input,
+                                        vtkDataArray *output)
+{
+  vtkIdType numPts = input->GetNumberOfTuples();
+  output->SetNumberOfComponents(1);
+  output->SetNumberOfTuples(numPts);
+  if (input->GetNumberOfComponents() != 3)
+    {
+    vtkErrorMacro("Expected points with 3 components, got "
+                  << input->GetNumberOfComponents());
+    return;
+    }
+
+  if (this->Transform)
+    {
+    this->Transform->Update();
+    }
+  vtkImplicitFunctionValues values;
+  values.Function = this;
+  values.Transform = this->Transform;
+  values.Input = input;
+  values.Output = output;
+  if (this->CanEvaluateInParallel() &&
+      IsArrayThreadSafe(input) && IsArrayThreadSafe(output))
+    {
+    vtkSMPTools::For(0, numPts, values);
+    }
+  else
+    {
+    values(0, numPts);
+    }
+}
+
 // Evaluate function gradient at position x-y-z and pass back vector. Point
 // x[3] is transformed through transform (if provided).
 void vtkImplicitFunction::FunctionGradient(const double x[3], double g[3])
@@ -51,6 +51,7 @@
 #include "vtkObject.h"
 
 class vtkAbstractTransform;
+class vtkDataArray;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkImplicitFunction : public vtkObject
 {
@@ -70,6 +71,20 @@ public:
   double FunctionValue(double x, double y, double z) {
     double xyz[3] = {x, y, z}; return this->FunctionValue(xyz); };
 
+  // Description:
+  // Evaluate the function at each point of input, an array of 3-component
+  // tuples, and store the values in output, which is resized to hold one
+  // value per point. The points are evaluated in parallel with vtkSMPTools
+  // when CanEvaluateInParallel() returns true and both arrays support
+  // concurrent access, and serially otherwise.
+  void FunctionValue(vtkDataArray *input, vtkDataArray *output);
+
+  // Description:
+  // Return true if EvaluateFunction() may be called from several threads
+  // at once, i.e. it only reads the parameters of the function. The
+  // default is false; subclasses that qualify override it.
+  virtual bool CanEvaluateInParallel() { return false; }
+
   // Description:
   // Evaluate function gradient at position x-y-z and pass back vector. Point
   // x[3] is transformed through transform (if provided).
@@ -41,6 +41,11 @@
 #include "vtkUniformGrid.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkCallbackCommand.h"
+#include "vtkGenericCell.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 
 #ifdef _MSC_VER
 #pragma warning ( disable : 4100 )
@@ -50,6 +55,7 @@
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 
 // Timing data ---------------------------------------------
@@ -61,6 +67,179 @@
 static char dots[MSGSIZE] = "...........................................................";
 static char msg[MSGSIZE];
 
+//-----------------------------------------------------------------------------
+namespace
+{
+// Intervals with fewer values are selected serially.
+const int KD_PARALLEL_SELECT_SIZE = 65536;
+// The number of values in each block of the parallel partition.
+const int KD_PARTITION_BLOCK_SIZE = 16384;
+// The number of pivot samples of the parallel selection.
+const int KD_SELECT_SAMPLE_SIZE = 1024;
+// The number of subtrees that are divided concurrently.
+const size_t KD_PARALLEL_SUBTREES = 64;
+
+//-----------------------------------------------------------------------------
+// Compute the centers of the cells of a data set from several threads.
+class ComputeCenters
+{
+public:
+  vtkDataSet *DataSet;
+  float *Centers;
+  int MaxCellSize;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double> > Weights;
+
+  ComputeCenters(vtkDataSet *set, float *centers) :
+    DataSet(set), Centers(centers), MaxCellSize(set->GetMaxCellSize())
+    {
+    }
+
+  void Initialize()
+    {
+    this->Weights.Local().resize(this->MaxCellSize > 0 ? this->MaxCellSize : 1);
+    }
+
+  void operator()(vtkIdType j, vtkIdType end)
+    {
+    vtkGenericCell *cell = this->Cell.Local();
+    double *weights = &this->Weights.Local()[0];
+    double pcoords[3];
+    for ( ; j < end; j++)
+      {
+      double center[3] = { 0.0, 0.0, 0.0 };
+      this->DataSet->GetCell(j, cell);
+      int subId = cell->GetParametricCenter(pcoords);
+      cell->EvaluateLocation(subId, pcoords, center, weights);
+      float *cptr = this->Centers + 3*j;
+      cptr[0] = static_cast<float>(center[0]);
+      cptr[1] = static_cast<float>(center[1]);
+      cptr[2] = static_cast<float>(center[2]);
+      }
+    }
+
+  void Reduce()
+    {
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Count the values of each block of an interval that are less than, and
+// equal to, the pivot.
+class PartitionCount
+{
+public:
+  const float *X;
+  int Dim;
+  int N;
+  float T;
+  int *Less;
+  int *Equal;
+
+  PartitionCount(const float *x, int dim, int n, float t, int *less, int *equal) :
+    X(x), Dim(dim), N(n), T(t), Less(less), Equal(equal)
+    {
+    }
+
+  void operator()(vtkIdType b, vtkIdType end)
+    {
+    for ( ; b < end; b++)
+      {
+      const int first = static_cast<int>(b) * KD_PARTITION_BLOCK_SIZE;
+      const int last = std::min(first + KD_PARTITION_BLOCK_SIZE, this->N);
+      int less = 0, equal = 0;
+      for (int i = first; i < last; i++)
+        {
+        const float v = this->X[3*i + this->Dim];
+        less += (v < this->T);
+        equal += (v == this->T);
+        }
+      this->Less[b] = less;
+      this->Equal[b] = equal;
+      }
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Copy the values of each block to the less, equal and greater parts of
+// the output, at the offsets of the block.
+class PartitionScatter
+{
+public:
+  const float *X;
+  const int *Ids;
+  int Dim;
+  int N;
+  float T;
+  const int *Offsets; // 3 offsets per block
+  float *XOut;
+  int *IdsOut;
+
+  PartitionScatter(const float *x, const int *ids, int dim, int n, float t,
+                   const int *offsets, float *xOut, int *idsOut) :
+    X(x), Ids(ids), Dim(dim), N(n), T(t), Offsets(offsets), XOut(xOut),
+    IdsOut(idsOut)
+    {
+    }
+
+  void operator()(vtkIdType b, vtkIdType end)
+    {
+    for ( ; b < end; b++)
+      {
+      const int first = static_cast<int>(b) * KD_PARTITION_BLOCK_SIZE;
+      const int last = std::min(first + KD_PARTITION_BLOCK_SIZE, this->N);
+      int next[3] = { this->Offsets[3*b], this->Offsets[3*b+1],
+                      this->Offsets[3*b+2] };
+      for (int i = first; i < last; i++)
+        {
+        const float v = this->X[3*i + this->Dim];
+        const int part = (v < this->T) ? 0 : ((v == this->T) ? 1 : 2);
+        const int o = next[part]++;
+        this->XOut[3*o] = this->X[3*i];
+        this->XOut[3*o+1] = this->X[3*i+1];
+        this->XOut[3*o+2] = this->X[3*i+2];
+        if (this->Ids)
+          {
+          this->IdsOut[o] = this->Ids[i];
+          }
+        }
+      }
+    }
+};
+}
+
+//-----------------------------------------------------------------------------
+// Divide the subtrees of several regions concurrently. The regions own
+// disjoint intervals of the point array.
+class vtkKdTreeDivideRegions
+{
+public:
+  struct Region
+    {
+    vtkKdNode *Node;
+    float *Centers;
+    int *Ids;
+    int Level;
+    };
+
+  vtkKdTree *Tree;
+  const std::vector<Region> &Regions;
+
+  vtkKdTreeDivideRegions(vtkKdTree *tree, const std::vector<Region> &regions) :
+    Tree(tree), Regions(regions)
+    {
+    }
+
+  void operator()(vtkIdType i, vtkIdType end)
+    {
+    for ( ; i < end; i++)
+      {
+      const Region &r = this->Regions[i];
+      this->Tree->DivideRegion(r.Node, r.Centers, r.Ids, r.Level);
+      }
+    }
+};
+
 //-----------------------------------------------------------------------------
 static void LastInputDeletedCallback(vtkObject *, unsigned long,
                                      void *_self, void *)
@@ -618,70 +797,41 @@ float *vtkKdTree::ComputeCellCenters(vtkDataSet *set)
     return NULL;
     }
 
-  int maxCellSize = 0;
+  // The centers are computed from several threads, so the cell structures
+  // of each data set are built first, by getting one cell.
+  vtkNew<vtkGenericCell> cell;
 
   if (set)
     {
-    maxCellSize = set->GetMaxCellSize();
-    }
-  else
-    {
-    vtkCollectionSimpleIterator cookie;
-    this->DataSets->InitTraversal(cookie);
-    for (vtkDataSet *iset = this->DataSets->GetNextDataSet(cookie);
-         iset != NULL; iset = this->DataSets->GetNextDataSet(cookie))
-      {
-      int cellSize = iset->GetMaxCellSize();
-      maxCellSize = (cellSize > maxCellSize) ? cellSize : maxCellSize;
-      }
-    }
-
-  double *weights = new double [maxCellSize];
-
-  float *cptr = center;
-  double dcenter[3];
-
-  if (set)
-    {
-    for (int j=0; j<totalCells; j++)
-      {
-      this->ComputeCellCenter(set->GetCell(j), dcenter, weights);
-      cptr[0] = static_cast<float>(dcenter[0]);
-      cptr[1] = static_cast<float>(dcenter[1]);
-      cptr[2] = static_cast<float>(dcenter[2]);
-      cptr += 3;
-      if (j%1000 == 0)
-        {
-        this->UpdateSubOperationProgress(static_cast<double>(j)/totalCells);
-        }
-      }
+    set->GetCell(0, cell.GetPointer());
+    ComputeCenters centers(set, center);
+    vtkSMPTools::For(0, totalCells, centers);
     }
   else
     {
+    float *cptr = center;
+    int cellsSoFar = 0;
     vtkCollectionSimpleIterator cookie;
     this->DataSets->InitTraversal(cookie);
     for (vtkDataSet *iset = this->DataSets->GetNextDataSet(cookie);
          iset != NULL; iset = this->DataSets->GetNextDataSet(cookie))
       {
       int nCells = iset->GetNumberOfCells();
-
-      for (int j=0; j<nCells; j++)
+      if (nCells == 0)
         {
-        this->ComputeCellCenter(iset->GetCell(j), dcenter, weights);
-        cptr[0] = static_cast<float>(dcenter[0]);
-        cptr[1] = static_cast<float>(dcenter[1]);
-        cptr[2] = static_cast<float>(dcenter[2]);
-        cptr += 3;
-        if (j%1000 == 0)
-          {
-          this->UpdateSubOperationProgress(static_cast<double>(j)/totalCells);
-          }
+        continue;
         }
+
+      iset->GetCell(0, cell.GetPointer());
+      ComputeCenters centers(iset, cptr);
+      vtkSMPTools::For(0, nCells, centers);
+
+      cptr += 3 * nCells;
+      cellsSoFar += nCells;
+      this->UpdateSubOperationProgress(static_cast<double>(cellsSoFar)/totalCells);
       }
     }
 
-  delete [] weights;
-
   this->UpdateSubOperationProgress(1.0);
   return center;
 }
@@ -895,7 +1045,7 @@ void vtkKdTree::BuildLocator()
 
     this->ProgressOffset += this->ProgressScale;
     this->ProgressScale = 0.7;
-    this->DivideRegion(kd, ptarray, NULL, 0);
+    this->DivideRegionInParallel(kd, ptarray, NULL);
 
     TIMERDONE("Build tree");
 
@@ -1223,6 +1373,61 @@ int vtkKdTree::DivideTest(int size, int level)
 }
 //----------------------------------------------------------------------------
 int vtkKdTree::DivideRegion(vtkKdNode *kd, float *c1, int *ids, int level)
+{
+  if (!this->SplitRegion(kd, c1, ids, level))
+    {
+    return 0;
+    }
+
+  int nleft = kd->GetLeft()->GetNumberOfPoints();
+
+  int *leftIds  = ids;
+  int *rightIds = ids ? ids + nleft : NULL;
+
+  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
+
+  this->DivideRegion(kd->GetRight(), c1 + nleft*3, rightIds, level + 1);
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkKdTree::DivideRegionInParallel(vtkKdNode *kd, float *c1, int *ids)
+{
+  typedef vtkKdTreeDivideRegions::Region Region;
+
+  // Split the top levels breadth first, the large regions are split with
+  // a parallel selection. What remains are independent subtrees.
+  std::vector<Region> regions;
+  Region top = { kd, c1, ids, 0 };
+  regions.push_back(top);
+
+  size_t first = 0;
+  while ((first < regions.size()) &&
+         (regions.size() - first < KD_PARALLEL_SUBTREES))
+    {
+    Region r = regions[first++];
+    if (!this->SplitRegion(r.Node, r.Centers, r.Ids, r.Level))
+      {
+      continue;
+      }
+
+    int nleft = r.Node->GetLeft()->GetNumberOfPoints();
+
+    Region left = { r.Node->GetLeft(), r.Centers, r.Ids, r.Level + 1 };
+    Region right = { r.Node->GetRight(), r.Centers + nleft*3,
+                     r.Ids ? r.Ids + nleft : NULL, r.Level + 1 };
+    regions.push_back(left);
+    regions.push_back(right);
+    }
+  regions.erase(regions.begin(), regions.begin() + first);
+
+  vtkKdTreeDivideRegions divider(this, regions);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(regions.size()), 1, divider);
+}
+
+//----------------------------------------------------------------------------
+int vtkKdTree::SplitRegion(vtkKdNode *kd, float *c1, int *ids, int level)
 {
   int ok = this->DivideTest(kd->GetNumberOfPoints(), level);
 
@@ -1282,16 +1487,7 @@ int vtkKdTree::DivideRegion(vtkKdNode *kd, float *c1, int *ids, int level)
     return 0;   // unable to divide region further
     }
 
-  int nleft = kd->GetLeft()->GetNumberOfPoints();
-
-  int *leftIds  = ids;
-  int *rightIds = ids ? ids + nleft : NULL;
-
-  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
-
-  this->DivideRegion(kd->GetRight(), c1 + nleft*3, rightIds, level + 1);
-
-  return 0;
+  return 1;
 }
 
 //----------------------------------------------------------------------------
@@ -1400,7 +1596,14 @@ int vtkKdTree::Select(int dim, float *c1, int *ids, int nvals, double &coord)
   int mid = nvals / 2;
   int right = nvals -1;
 
-  vtkKdTree::_Select(dim, c1, ids, left, right, mid);
+  if (nvals >= KD_PARALLEL_SELECT_SIZE)
+    {
+    vtkKdTree::ParallelSelect(dim, c1, ids, left, right, mid);
+    }
+  else
+    {
+    vtkKdTree::_Select(dim, c1, ids, left, right, mid);
+    }
 
   // We need to be careful in the case where the "mid"
   // value is repeated several times in the array.  We
@@ -1464,6 +1667,91 @@ float vtkKdTree::FindMaxLeftHalf(int dim, float *c1, int K)
   return max;
 }
 
+//----------------------------------------------------------------------------
+// Narrow [L,R] down to the values around X[K] with three-way partitions
+// about a pivot estimated from a sample of the interval, until the
+// interval is small enough for _Select. The values less than the pivot
+// come first, then those equal to it, then those greater, as required by
+// Select.
+void vtkKdTree::ParallelSelect(int dim, float *X, int *ids,
+                               int L, int R, int K)
+{
+  std::vector<float> sample(KD_SELECT_SAMPLE_SIZE);
+  std::vector<float> xbuf;
+  std::vector<int> idbuf;
+
+  while (R - L + 1 >= KD_PARALLEL_SELECT_SIZE)
+    {
+    const int N = R - L + 1;
+    float *XL = X + 3*L;
+    int *idsL = ids ? ids + L : NULL;
+
+    for (int i = 0; i < KD_SELECT_SAMPLE_SIZE; i++)
+      {
+      vtkIdType s = static_cast<vtkIdType>(i) * N / KD_SELECT_SAMPLE_SIZE;
+      sample[i] = XL[3*s + dim];
+      }
+    const int rank = static_cast<int>(
+      static_cast<double>(K - L) * KD_SELECT_SAMPLE_SIZE / N);
+    std::nth_element(sample.begin(), sample.begin() + rank, sample.end());
+    const float T = sample[rank];
+
+    const int nblocks = (N + KD_PARTITION_BLOCK_SIZE - 1) / KD_PARTITION_BLOCK_SIZE;
+    std::vector<int> less(nblocks), equal(nblocks), offsets(3*nblocks);
+    PartitionCount count(XL, dim, N, T, &less[0], &equal[0]);
+    vtkSMPTools::For(0, nblocks, 1, count);
+
+    int nLess = 0, nEqual = 0;
+    for (int b = 0; b < nblocks; b++)
+      {
+      nLess += less[b];
+      nEqual += equal[b];
+      }
+    int o[3] = { 0, nLess, nLess + nEqual };
+    for (int b = 0; b < nblocks; b++)
+      {
+      const int size = std::min(KD_PARTITION_BLOCK_SIZE,
+                                N - b * KD_PARTITION_BLOCK_SIZE);
+      offsets[3*b] = o[0];
+      offsets[3*b+1] = o[1];
+      offsets[3*b+2] = o[2];
+      o[0] += less[b];
+      o[1] += equal[b];
+      o[2] += size - less[b] - equal[b];
+      }
+
+    xbuf.resize(3*N);
+    if (ids)
+      {
+      idbuf.resize(N);
+      }
+    PartitionScatter scatter(XL, idsL, dim, N, T, &offsets[0], &xbuf[0],
+                             ids ? &idbuf[0] : NULL);
+    vtkSMPTools::For(0, nblocks, 1, scatter);
+    std::copy(xbuf.begin(), xbuf.begin() + 3*N, XL);
+    if (ids)
+      {
+      std::copy(idbuf.begin(), idbuf.begin() + N, idsL);
+      }
+
+    // The pivot is one of the values, so the interval always shrinks
+    if (K < L + nLess)
+      {
+      R = L + nLess - 1;
+      }
+    else if (K < L + nLess + nEqual)
+      {
+      return;
+      }
+    else
+      {
+      L = L + nLess + nEqual;
+      }
+    }
+
+  vtkKdTree::_Select(dim, X, ids, L, R, K);
+}
+
 //----------------------------------------------------------------------------
 // Note: The indices (L, R, X) into the point array should be vtkIdTypes rather
 // than ints, but this change causes the k-d tree build time to double.
@@ -1849,7 +2137,7 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints **ptArrays, int numPtArrays)
 
   TIMER("Build tree");
 
-  this->DivideRegion(kd, points, ptIds, 0);
+  this->DivideRegionInParallel(kd, points, ptIds);
 
   this->SetActualLevel();
   this->BuildRegionList();
@@ -47,6 +47,12 @@
 //     tolerance, or you can use FindPoint and FindClosestPoint to
 //     locate points in the original set that the tree was built from.
 //
+//     The cell centers are computed, and the tree is built, in parallel
+//     with vtkSMPTools. The large regions at the top of the tree are
+//     split with a parallel median selection, and the subtrees below them
+//     are then built concurrently. The decomposition is the same as with
+//     a serial build.
+//
 // .SECTION See Also
 //      vtkLocator vtkCellLocator vtkPKdTree
 
@@ -68,9 +74,11 @@ class vtkKdNode;
 class vtkBSPCuts;
 class vtkBSPIntersections;
 class vtkDataSetCollection;
+class vtkKdTreeDivideRegions;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkKdTree : public vtkLocator
 {
+friend class vtkKdTreeDivideRegions;
 public:
   vtkTypeMacro(vtkKdTree, vtkLocator);
   void PrintSelf(ostream& os, vtkIndent indent);
@@ -680,6 +688,13 @@ protected:
 
   int DivideRegion(vtkKdNode *kd, float *c1, int *ids, int nlevels);
 
+  // Split the region kd once, return 1 if it was divided.
+  int SplitRegion(vtkKdNode *kd, float *c1, int *ids, int level);
+
+  // Same as DivideRegion(kd, c1, ids, 0), but the subtrees below the top
+  // levels are divided concurrently.
+  void DivideRegionInParallel(vtkKdNode *kd, float *c1, int *ids);
+
   void DoMedianFind(vtkKdNode *kd, float *c1, int *ids, int d1, int d2, int d3);
 
   void SelfRegister(vtkKdNode *kd);
@@ -760,6 +775,10 @@ protected:
   static float FindMaxLeftHalf(int dim, float *c1, int K);
   static void _Select(int dim, float *X, int *ids, int L, int R, int K);
 
+  // Same arrangement as _Select for large intervals, partitioning the
+  // interval around sampled pivots in parallel.
+  static void ParallelSelect(int dim, float *X, int *ids, int L, int R, int K);
+
 //BTX
   static int ComputeLevel(vtkKdNode *kd);
   static int SelfOrder(int id, vtkKdNode *kd);
@@ -169,6 +169,7 @@ public:
   void GetCell(vtkIdType cellId, vtkGenericCell *cell);
   int GetCellType(vtkIdType cellId);
   void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds);
+  using vtkUnstructuredGridBase::GetCellPoints;
   vtkCellIterator* NewCellIterator();
   void GetPointCells(vtkIdType ptId, vtkIdList *cellIds);
   int GetMaxCellSize();
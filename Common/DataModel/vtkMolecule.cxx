@@ -73,6 +73,7 @@ void vtkMolecule::Initialize()
   // Electronic data
   this->ElectronicData = NULL;
 
+  this->TopologyTime.Modified();
   this->Modified();
 }
 
@@ -130,6 +131,7 @@ vtkAtom vtkMolecule::AppendAtom(unsigned short atomicNumber,
   (void)coordID;
   assert("point ids synced with vertex ids" && coordID == id);
 
+  this->TopologyTime.Modified();
   this->Modified();
   return vtkAtom(this, id);
 }
@@ -167,6 +169,7 @@ void vtkMolecule::SetAtomAtomicNumber(vtkIdType id, unsigned short atomicNum)
   assert(atomicNums);
 
   atomicNums->SetValue(id, atomicNum);
+  this->TopologyTime.Modified();
   this->Modified();
 }
 
@@ -225,6 +228,7 @@ vtkBond vtkMolecule::AppendBond(const vtkIdType atom1, const vtkIdType atom2,
 
   vtkIdType id = edgeType.Id;
   bondOrders->InsertValue(id, order);
+  this->TopologyTime.Modified();
   this->Modified();
   return vtkBond(this, id, atom1, atom2);
 }
@@ -254,6 +258,7 @@ void vtkMolecule::SetBondOrder(vtkIdType bondId, unsigned short order)
 
   assert(bondOrders);
 
+  this->TopologyTime.Modified();
   this->Modified();
   return bondOrders->SetValue(bondId, order);
 }
@@ -305,6 +310,22 @@ vtkUnsignedShortArray * vtkMolecule::GetAtomicNumberArray()
   return atomicNums;
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkMolecule::GetTopologyMTime()
+{
+  unsigned long mtime = this->TopologyTime.GetMTime();
+  vtkDataArray *arrays[2] = { this->GetVertexData()->GetScalars(),
+                              this->GetEdgeData()->GetScalars() };
+  for (int i = 0; i < 2; ++i)
+    {
+    if (arrays[i] && arrays[i]->GetMTime() > mtime)
+      {
+      mtime = arrays[i]->GetMTime();
+      }
+    }
+  return mtime;
+}
+
 //----------------------------------------------------------------------------
 vtkIdType vtkMolecule::GetNumberOfBonds()
 {
@@ -377,6 +398,7 @@ void vtkMolecule::CopyStructureInternal(vtkMolecule *m, bool deep)
     {
     this->Superclass::ShallowCopy(m);
     }
+  this->TopologyTime.Modified();
   }
 
 //----------------------------------------------------------------------------
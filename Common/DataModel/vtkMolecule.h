@@ -74,6 +74,7 @@
 #include "vtkBond.h" // Simple proxy class dependent on vtkMolecule
 //ETX
 #include "vtkVector.h" // Small templated vector convenience class
+#include "vtkTimeStamp.h" // For TopologyTime
 
 class vtkPlane;
 class vtkAbstractElectronicData;
@@ -182,6 +183,13 @@ public:
   vtkPoints * GetAtomicPositionArray();
   vtkUnsignedShortArray * GetAtomicNumberArray();
 
+  // Description:
+  // Return the last time the atomic numbers or the bonds changed. Moving
+  // atoms does not change it, so mappers can keep what depends on the
+  // elements and the bonds between the frames of a trajectory. Code that
+  // writes the raw atomic number array must call Modified() on it.
+  unsigned long GetTopologyMTime();
+
 //BTX
   // Description:
   // Set/Get the AbstractElectronicData-subclassed object for this molecule.
@@ -271,6 +279,7 @@ public:
   friend class vtkBond;
 
   vtkAbstractElectronicData *ElectronicData;
+  vtkTimeStamp TopologyTime;
 
 private:
   vtkMolecule(const vtkMolecule&);    // Not implemented.
@@ -80,6 +80,8 @@ public:
   // Description:
   // vtkPath doesn't use cells, this method just clears ptIds.
   void GetCellPoints(vtkIdType, vtkIdList *ptIds);
+  // Re-use any superclass signatures that we don't override.
+  using vtkPointSet::GetCellPoints;
 
   // Description:
   // vtkPath doesn't use cells, this method just clears cellIds.
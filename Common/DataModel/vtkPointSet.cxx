@@ -23,6 +23,7 @@
 #include "vtkPointSetCellIterator.h"
 
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinks.h"
 #define VTK_CREATE(type, name) \
   vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
@@ -35,6 +36,7 @@ vtkPointSet::vtkPointSet ()
 {
   this->Points = NULL;
   this->Locator = NULL;
+  this->StaticCellLinks = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -47,6 +49,11 @@ vtkPointSet::~vtkPointSet ()
     this->Locator->UnRegister(this);
     this->Locator = NULL;
     }
+  if ( this->StaticCellLinks )
+    {
+    this->StaticCellLinks->Delete();
+    this->StaticCellLinks = NULL;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -86,7 +93,30 @@ void vtkPointSet::Initialize()
     {
     this->Locator->Initialize();
     }
+  if ( this->StaticCellLinks )
+    {
+    this->StaticCellLinks->Delete();
+    this->StaticCellLinks = NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkStaticCellLinks *vtkPointSet::GetStaticCellLinks()
+{
+  if ( !this->StaticCellLinks )
+    {
+    this->StaticCellLinks = vtkStaticCellLinks::New();
+    }
+  else if ( this->GetMTime() <= this->StaticCellLinksTime )
+    {
+    return this->StaticCellLinks;
+    }
+
+  this->StaticCellLinks->BuildLinks(this);
+  this->StaticCellLinksTime.Modified();
+  return this->StaticCellLinks;
 }
+
 //----------------------------------------------------------------------------
 void vtkPointSet::ComputeBounds()
 {
@@ -94,7 +124,13 @@ void vtkPointSet::ComputeBounds()
 
   if ( this->Points )
     {
-    if ( this->GetMTime() >= this->ComputeTime )
+    // Only the points change the bounds, not the point or cell data.
+    unsigned long mtime = this->vtkObject::GetMTime();
+    if ( this->Points->GetMTime() > mtime )
+      {
+      mtime = this->Points->GetMTime();
+      }
+    if ( mtime >= this->ComputeTime )
       {
       bounds = this->Points->GetBounds();
       for (int i=0; i<6; i++)
@@ -126,6 +162,19 @@ unsigned long int vtkPointSet::GetMTime()
   return dsTime;
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkPointSet::GetGeometryMTime()
+{
+  unsigned long mtime = this->vtkDataSet::GetGeometryMTime();
+
+  if ( this->Points && this->Points->GetMTime() > mtime )
+    {
+    mtime = this->Points->GetMTime();
+    }
+
+  return mtime;
+}
+
 //----------------------------------------------------------------------------
 vtkIdType vtkPointSet::FindPoint(double x[3])
 {
@@ -326,6 +375,36 @@ vtkIdType vtkPointSet::FindCell(double x[3], vtkCell *cell,
   return -1;
 }
 
+//----------------------------------------------------------------------------
+void vtkPointSet::BuildFindCellStructures()
+{
+  this->Superclass::BuildFindCellStructures();
+
+  if ( !this->Points || this->Points->GetNumberOfPoints() < 1)
+    {
+    return;
+    }
+
+  if ( !this->Locator )
+    {
+    this->Locator = vtkPointLocator::New();
+    this->Locator->Register(this);
+    this->Locator->Delete();
+    this->Locator->SetDataSet(this);
+    }
+  if ( this->Points->GetMTime() > this->Locator->GetMTime() )
+    {
+    this->Locator->SetDataSet(this);
+    }
+  this->Locator->BuildLocator();
+
+  if ( this->GetNumberOfCells() > 0 )
+    {
+    VTK_CREATE(vtkIdList, cellIds);
+    this->GetPointCells(0, cellIds);
+    }
+}
+
 //----------------------------------------------------------------------------
 vtkCellIterator *vtkPointSet::NewCellIterator()
 {
@@ -435,6 +514,7 @@ void vtkPointSet::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Points: " << this->GetNumberOfPoints() << "\n";
   os << indent << "Point Coordinates: " << this->Points << "\n";
   os << indent << "Locator: " << this->Locator << "\n";
+  os << indent << "Static Cell Links: " << this->StaticCellLinks << "\n";
 }
 
 //----------------------------------------------------------------------------
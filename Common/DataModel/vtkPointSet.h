@@ -32,6 +32,7 @@
 #include "vtkPoints.h" // Needed for inline methods
 
 class vtkPointLocator;
+class vtkStaticCellLinks;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkPointSet : public vtkDataSet
 {
@@ -63,6 +64,11 @@ public:
                              double tol2, int& subId, double pcoords[3],
                              double *weights);
 
+  // Description:
+  // Also build the point locator used by FindCell() and the links from the
+  // points to the cells.
+  void BuildFindCellStructures();
+
   // Description:
   // Return an iterator that traverses the cells in this data set.
   vtkCellIterator* NewCellIterator();
@@ -71,6 +77,18 @@ public:
   // Get MTime which also considers its vtkPoints MTime.
   unsigned long GetMTime();
 
+  // Description:
+  // Get the geometry MTime, which considers the vtkPoints MTime.
+  virtual unsigned long GetGeometryMTime();
+
+  // Description:
+  // Return links from the points to the cells using them, built in parallel
+  // on first use and rebuilt once the data set is modified. The links are
+  // owned by the data set and must not be changed; the cells of each point
+  // are in increasing order. Calling this method from several threads at
+  // once is only safe once the links are up to date.
+  vtkStaticCellLinks *GetStaticCellLinks();
+
   // Description:
   // Compute the (X, Y, Z)  bounds of the data.
   void ComputeBounds();
@@ -116,6 +134,8 @@ protected:
 
   vtkPoints *Points;
   vtkPointLocator *Locator;
+  vtkStaticCellLinks *StaticCellLinks;
+  vtkTimeStamp StaticCellLinksTime;
 
   virtual void ReportReferences(vtkGarbageCollector*);
 private:
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkPolyData.h"
 
+#include "vtkBoundingBox.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCriticalSection.h"
@@ -36,6 +37,9 @@
 
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkPolyData);
 
 //----------------------------------------------------------------------------
@@ -339,7 +343,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
 void vtkPolyData::GetCell(vtkIdType cellId, vtkGenericCell *cell)
 {
   int             i, loc;
-  vtkIdType       *pts=0;
+  const vtkIdType *pts=0;
   vtkIdType       numPts;
   unsigned char   type;
   double           x[3];
@@ -356,48 +360,48 @@ void vtkPolyData::GetCell(vtkIdType cellId, vtkGenericCell *cell)
     {
     case VTK_VERTEX:
       cell->SetCellTypeToVertex();
-      this->Verts->GetCell(loc,numPts,pts);
+      this->Verts->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLY_VERTEX:
       cell->SetCellTypeToPolyVertex();
-      this->Verts->GetCell(loc,numPts,pts);
+      this->Verts->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
 
     case VTK_LINE:
       cell->SetCellTypeToLine();
-      this->Lines->GetCell(loc,numPts,pts);
+      this->Lines->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLY_LINE:
       cell->SetCellTypeToPolyLine();
-      this->Lines->GetCell(loc,numPts,pts);
+      this->Lines->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
 
     case VTK_TRIANGLE:
       cell->SetCellTypeToTriangle();
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_QUAD:
       cell->SetCellTypeToQuad();
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLYGON:
       cell->SetCellTypeToPolygon();
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
 
     case VTK_TRIANGLE_STRIP:
       cell->SetCellTypeToTriangleStrip();
-      this->Strips->GetCell(loc,numPts,pts);
+      this->Strips->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
@@ -495,9 +499,11 @@ void vtkPolyData::CopyCells(vtkPolyData *pd, vtkIdList *idList,
 void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
 {
   int i, loc;
-  vtkIdType *pts, numPts;
+  const vtkIdType *pts;
+  vtkIdType numPts;
   unsigned char type;
   double x[3];
+  vtkCellArray *cells;
 
   if ( !this->Cells )
     {
@@ -511,22 +517,22 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
     {
     case VTK_VERTEX:
     case VTK_POLY_VERTEX:
-      this->Verts->GetCell(loc,numPts,pts);
+      cells = this->Verts;
       break;
 
     case VTK_LINE:
     case VTK_POLY_LINE:
-      this->Lines->GetCell(loc,numPts,pts);
+      cells = this->Lines;
       break;
 
     case VTK_TRIANGLE:
     case VTK_QUAD:
     case VTK_POLYGON:
-      this->Polys->GetCell(loc,numPts,pts);
+      cells = this->Polys;
       break;
 
     case VTK_TRIANGLE_STRIP:
-      this->Strips->GetCell(loc,numPts,pts);
+      cells = this->Strips;
       break;
 
     default:
@@ -535,6 +541,14 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
       return;
     }
 
+  // 32 bit cell arrays copy the point ids; keep this method thread safe.
+  vtkSmartPointer<vtkIdList> ptIds;
+  if ( !cells->IsStorageShareable() )
+    {
+    ptIds = vtkSmartPointer<vtkIdList>::New();
+    }
+  cells->GetCell(loc,numPts,pts,ptIds);
+
   // carefully compute the bounds
   if (numPts)
     {
@@ -563,10 +577,42 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
 }
 
 
+//----------------------------------------------------------------------------
+unsigned long vtkPolyData::GetTopologyMTime()
+{
+  unsigned long mtime = this->vtkPointSet::GetTopologyMTime();
+
+  mtime = std::max(mtime, this->GetVerts()->GetMTime());
+  mtime = std::max(mtime, this->GetLines()->GetMTime());
+  mtime = std::max(mtime, this->GetPolys()->GetMTime());
+  mtime = std::max(mtime, this->GetStrips()->GetMTime());
+
+  return mtime;
+}
+
 //----------------------------------------------------------------------------
 void vtkPolyData::ComputeBounds()
 {
-  if (this->GetMTime() > this->ComputeTime)
+  vtkCellArray *cella[4];
+
+  cella[0] = this->GetVerts();
+  cella[1] = this->GetLines();
+  cella[2] = this->GetPolys();
+  cella[3] = this->GetStrips();
+
+  // Only the points and the cells change the bounds, not the point or cell
+  // data.
+  unsigned long mtime = this->vtkObject::GetMTime();
+  if (this->Points && this->Points->GetMTime() > mtime)
+    {
+    mtime = this->Points->GetMTime();
+    }
+  for (int t = 0; t < 4; t++)
+    {
+    mtime = std::max(mtime, cella[t]->GetMTime());
+    }
+
+  if (mtime > this->ComputeTime)
     {
     // If there are no cells, but there are points, back to the
     // bounds of the points set.
@@ -576,42 +622,28 @@ void vtkPolyData::ComputeBounds()
       return;
       }
 
-    int t, i;
+    // Mark the points used by the cells, then compute their bounds in
+    // parallel.
+    const vtkIdType numPts = this->GetNumberOfPoints();
+    std::vector<unsigned char> uses(numPts, 0);
     vtkIdType *pts = 0;
     vtkIdType npts = 0;
-    double x[3];
-
-    vtkCellArray *cella[4];
-
-    cella[0] = this->GetVerts();
-    cella[1] = this->GetLines();
-    cella[2] = this->GetPolys();
-    cella[3] = this->GetStrips();
-
-    // carefully compute the bounds
-    int doneOne = 0;
-    this->Bounds[0] = this->Bounds[2] = this->Bounds[4] =  VTK_DOUBLE_MAX;
-    this->Bounds[1] = this->Bounds[3] = this->Bounds[5] = -VTK_DOUBLE_MAX;
-
-    // Iterate over cells's points
-    for (t = 0; t < 4; t++)
+    for (int t = 0; t < 4; t++)
       {
       for (cella[t]->InitTraversal(); cella[t]->GetNextCell(npts,pts); )
         {
-        for (i = 0;  i < npts; i++)
+        for (vtkIdType i = 0;  i < npts; i++)
           {
-          this->Points->GetPoint( pts[i], x );
-          this->Bounds[0] = (x[0] < this->Bounds[0] ? x[0] : this->Bounds[0]);
-          this->Bounds[1] = (x[0] > this->Bounds[1] ? x[0] : this->Bounds[1]);
-          this->Bounds[2] = (x[1] < this->Bounds[2] ? x[1] : this->Bounds[2]);
-          this->Bounds[3] = (x[1] > this->Bounds[3] ? x[1] : this->Bounds[3]);
-          this->Bounds[4] = (x[2] < this->Bounds[4] ? x[2] : this->Bounds[4]);
-          this->Bounds[5] = (x[2] > this->Bounds[5] ? x[2] : this->Bounds[5]);
-          doneOne = 1;
+          uses[pts[i]] = 1;
           }
         }
       }
-    if (!doneOne)
+
+    if (numPts > 0)
+      {
+      vtkBoundingBox::ComputeBounds(this->Points, &uses[0], this->Bounds);
+      }
+    if (numPts == 0 || !vtkBoundingBox::IsValid(this->Bounds))
       {
       vtkMath::UninitializeBounds(this->Bounds);
       }
@@ -918,6 +950,63 @@ void vtkPolyData::DeleteCells()
     }
 }
 
+//----------------------------------------------------------------------------
+// Helpers of BuildCells(): cell type from the number of points of a cell
+// for each cell array, and the location of the cells.
+namespace
+{
+struct vtkPolyDataVertType
+{
+  unsigned char operator()(vtkIdType npts) const
+    {return npts > 1 ? VTK_POLY_VERTEX : VTK_VERTEX;}
+};
+
+struct vtkPolyDataLineType
+{
+  unsigned char operator()(vtkIdType npts) const
+    {return npts > 2 ? VTK_POLY_LINE : VTK_LINE;}
+};
+
+struct vtkPolyDataPolyType
+{
+  unsigned char operator()(vtkIdType npts) const
+    {return npts == 3 ? VTK_TRIANGLE : npts == 4 ? VTK_QUAD : VTK_POLYGON;}
+};
+
+struct vtkPolyDataStripType
+{
+  unsigned char operator()(vtkIdType) const
+    {return VTK_TRIANGLE_STRIP;}
+};
+
+template <typename TypeOf>
+void vtkPolyDataLocateCells(vtkCellArray *cells, int *pLocs,
+                            unsigned char *pTypes, TypeOf typeOf)
+{
+  vtkIdType nCells = cells->GetNumberOfCells();
+  if (cells->GetStorageMode() == vtkCellArray::OFFSETS_STORAGE)
+    {
+    // The location of a cell is its index in the cell array.
+    for (vtkIdType i = 0; i < nCells; ++i)
+      {
+      pLocs[i] = static_cast<int>(i);
+      pTypes[i] = typeOf(cells->GetCellSize(i));
+      }
+    return;
+    }
+
+  const vtkIdType *pCells = nCells ? cells->GetPointer() : NULL;
+  vtkIdType nextCellPts = 0;
+  for (vtkIdType i = 0; i < nCells; ++i)
+    {
+    vtkIdType numCellPts = pCells[nextCellPts];
+    pLocs[i] = nextCellPts;
+    pTypes[i] = typeOf(numCellPts);
+    nextCellPts += numCellPts + 1;
+    }
+}
+}
+
 //----------------------------------------------------------------------------
 // Create data structure that allows random access of cells.
 void vtkPolyData::BuildCells()
@@ -948,82 +1037,16 @@ void vtkPolyData::BuildCells()
   int *pLocs = locs->WritePointer(0, nCells);
 
   // record locations and type of each cell.
-  // verts
-  vtkIdType numCellPts;
-  vtkIdType nextCellPts;
-  if (nVerts)
-    {
-    vtkIdType *pVerts = vertCells->GetData()->GetPointer(0);
-    numCellPts = pVerts[0];
-    nextCellPts = numCellPts + 1;
-    pLocs[0] = 0;
-    pTypes[0] = numCellPts > 1 ? VTK_POLY_VERTEX : VTK_VERTEX;
-    for (vtkIdType i = 1; i < nVerts; ++i)
-      {
-      numCellPts = pVerts[nextCellPts];
-      pLocs[i] = nextCellPts;
-      pTypes[i] = numCellPts > 1 ? VTK_POLY_VERTEX : VTK_VERTEX;
-      nextCellPts += numCellPts + 1;
-      }
-    pLocs += nVerts;
-    pTypes += nVerts;
-    }
-
-  // lines
-  if (nLines)
-    {
-    vtkIdType *pLines = lineCells->GetData()->GetPointer(0);
-    numCellPts = pLines[0];
-    pLocs[0] = 0;
-    pTypes[0] = numCellPts > 2 ? VTK_POLY_LINE : VTK_LINE;
-    nextCellPts = numCellPts + 1;
-    for (vtkIdType i = 1; i < nLines; ++i)
-      {
-      numCellPts = pLines[nextCellPts];
-      pLocs[i] = nextCellPts;
-      pTypes[i] = numCellPts > 2 ? VTK_POLY_LINE : VTK_LINE;
-      nextCellPts += numCellPts + 1;
-      }
-    pLocs += nLines;
-    pTypes += nLines;
-    }
-
-  // polys
-  if (nPolys)
-    {
-    vtkIdType *pPolys = polyCells->GetData()->GetPointer(0);
-    numCellPts = pPolys[0];
-    pLocs[0] = 0;
-    pTypes[0] = numCellPts == 3 ? VTK_TRIANGLE :
-      numCellPts == 4 ? VTK_QUAD : VTK_POLYGON;
-    nextCellPts = numCellPts + 1;
-    for (vtkIdType i = 1; i < nPolys; ++i)
-      {
-      numCellPts = pPolys[nextCellPts];
-      pLocs[i] = nextCellPts;
-      pTypes[i] = numCellPts == 3 ? VTK_TRIANGLE :
-        numCellPts == 4 ? VTK_QUAD : VTK_POLYGON;
-      nextCellPts += numCellPts + 1;
-      }
-    pLocs += nPolys;
-    pTypes += nPolys;
-    }
-
-  // strips
-  if (nStrips)
-    {
-    std::fill_n(pTypes, nStrips, VTK_TRIANGLE_STRIP);
-    vtkIdType *pStrips = stripCells->GetData()->GetPointer(0);
-    numCellPts = pStrips[0];
-    pLocs[0] = 0;
-    nextCellPts = numCellPts + 1;
-    for (vtkIdType i = 1; i < nStrips; ++i)
-      {
-      numCellPts = pStrips[nextCellPts];
-      pLocs[i] = nextCellPts;
-      nextCellPts += numCellPts + 1;
-      }
-    }
+  vtkPolyDataLocateCells(vertCells, pLocs, pTypes, vtkPolyDataVertType());
+  pLocs += nVerts;
+  pTypes += nVerts;
+  vtkPolyDataLocateCells(lineCells, pLocs, pTypes, vtkPolyDataLineType());
+  pLocs += nLines;
+  pTypes += nLines;
+  vtkPolyDataLocateCells(polyCells, pLocs, pTypes, vtkPolyDataPolyType());
+  pLocs += nPolys;
+  pTypes += nPolys;
+  vtkPolyDataLocateCells(stripCells, pLocs, pTypes, vtkPolyDataStripType());
 
   // set up the cell types data structure
   this->Cells = vtkCellTypes::New();
@@ -1078,21 +1101,52 @@ void vtkPolyData::BuildLinks(int initialSize)
 // Copy a cells point ids into list provided. (Less efficient.)
 void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
 {
-  vtkIdType i;
-  vtkIdType *pts, npts;
+  vtkIdType npts;
+  const vtkIdType *pts;
 
-  ptIds->Reset();
+  this->vtkPolyData::GetCellPoints(cellId, npts, pts, ptIds);
+  if (pts != ptIds->GetPointer(0))
+    {
+    ptIds->SetNumberOfIds(npts);
+    std::copy(pts, pts + npts, ptIds->GetPointer(0));
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                                const vtkIdType*& pts, vtkIdList *ptIds)
+{
   if ( this->Cells == NULL )
     {
     this->BuildCells();
     }
 
-  this->vtkPolyData::GetCellPoints(cellId, npts, pts);
-  ptIds->InsertId (npts-1,pts[npts-1]);
-  for (i=0; i<npts-1; i++)
+  vtkCellArray *cells;
+  switch (this->Cells->GetCellType(cellId))
     {
-    ptIds->SetId(i,pts[i]);
+    case VTK_VERTEX: case VTK_POLY_VERTEX:
+      cells = this->Verts;
+      break;
+
+    case VTK_LINE: case VTK_POLY_LINE:
+      cells = this->Lines;
+      break;
+
+    case VTK_TRIANGLE: case VTK_QUAD: case VTK_POLYGON:
+      cells = this->Polys;
+      break;
+
+    case VTK_TRIANGLE_STRIP:
+      cells = this->Strips;
+      break;
+
+    default:
+      ptIds->Reset();
+      npts = 0;
+      pts = ptIds->GetPointer(0);
+      return;
     }
+  cells->GetCell(this->Cells->GetCellLocation(cellId), npts, pts, ptIds);
 }
 
 //----------------------------------------------------------------------------
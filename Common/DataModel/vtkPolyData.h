@@ -110,6 +110,12 @@ public:
   // Copy a cells point ids into list provided. (Less efficient.)
   void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds);
 
+  // Description:
+  // Get the point ids of a cell without copying them, unless the cell
+  // array stores 32 bit ids (see vtkDataSet). Builds the cells if needed.
+  void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                     const vtkIdType*& pts, vtkIdList *ptIds);
+
   // Description:
   // Efficient method to obtain cells using a particular point. Make sure that
   // routine BuildLinks() has been called.
@@ -119,6 +125,11 @@ public:
   // Compute the (X, Y, Z)  bounds of the data.
   void ComputeBounds();
 
+  // Description:
+  // Get the topology MTime, which considers the MTime of the vertex,
+  // line, polygon and strip cell arrays.
+  virtual unsigned long GetTopologyMTime();
+
   // Description:
   // Recover extra allocated memory when creating data whose initial size
   // is unknown. Examples include using the InsertNextCell() method, or
@@ -268,7 +279,10 @@ public:
   // Get a pointer to the cell, ie [npts pid1 .. pidn]. More efficient
   // because pointer points directly to cell array internals and this
   // is not a virtual call. However, this requires that cells have been
-  // built (with BuildCells()). The cell type is returned.
+  // built (with BuildCells()). The cell type is returned. With cell arrays
+  // using vtkCellArray::OFFSETS_STORAGE, the pointer refers to an export of
+  // the cells built by the call, which is much slower; prefer
+  // GetCellPoints().
   unsigned char GetCell(vtkIdType cellId, vtkIdType* &pts);
 
   // Description:
@@ -596,6 +610,14 @@ inline void vtkPolyData::ReplaceCellPoint(vtkIdType cellId, vtkIdType oldPtId,
     if ( verts[i] == oldPtId )
       {
       verts[i] = newPtId; // this is very nasty! direct write!
+      // 32 bit cell arrays returned a copy of the cell.
+      if ( (this->Verts && !this->Verts->IsStorageShareable()) ||
+           (this->Lines && !this->Lines->IsStorageShareable()) ||
+           (this->Polys && !this->Polys->IsStorageShareable()) ||
+           (this->Strips && !this->Strips->IsStorageShareable()) )
+        {
+        this->ReplaceCell(cellId, static_cast<int>(nverts), verts);
+        }
       return;
       }
     }
@@ -663,7 +685,12 @@ inline unsigned char vtkPolyData::GetCell(
       cell = NULL;
       return 0;
     }
-  int loc = this->Cells->GetCellLocation(cellId);
+  vtkIdType loc = this->Cells->GetCellLocation(cellId);
+  if (cells->GetStorageMode() == vtkCellArray::OFFSETS_STORAGE)
+    {
+    // Location of the cell in the exported legacy layout.
+    loc += static_cast<vtkIdType>(cells->GetOffsetsArray()->GetTuple1(loc));
+    }
   cell = cells->GetData()->GetPointer(loc);
   return type;
 }
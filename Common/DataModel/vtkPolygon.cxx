@@ -30,6 +30,10 @@
 #include "vtkIncrementalPointLocator.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 vtkStandardNewMacro(vtkPolygon);
 
 //----------------------------------------------------------------------------
@@ -47,6 +51,7 @@ vtkPolygon::vtkPolygon()
   this->SuccessfulTriangulation = 0;
   this->Normal[0] = this->Normal[1] = this->Normal[2] = 0.0;
   this->UseMVCInterpolation = false;
+  this->FastTriangulationThreshold = 64;
 }
 
 //----------------------------------------------------------------------------
@@ -1250,6 +1255,12 @@ int vtkPolyVertexList::CanRemoveVertex(int id, double tolerance)
 // long as the polygon edges do not self intersect).
 int vtkPolygon::EarCutTriangulation ()
 {
+  // Large polygons test the ears against a grid of their reflex vertices
+  if ( this->PointIds->GetNumberOfIds() >= this->FastTriangulationThreshold )
+    {
+    return this->FastEarCutTriangulation();
+    }
+
   vtkPolyVertexList poly(this->PointIds, this->Points,
                          this->Tolerance*this->Tolerance);
   vtkLocalPolyVertex *vtx;
@@ -1314,6 +1325,254 @@ int vtkPolygon::EarCutTriangulation ()
 }
 
 
+//----------------------------------------------------------------------------
+// Uniform grid of the reflex vertices of a polygon, in 2D coordinates of
+// its plane, to find the vertices that may lie inside an ear. The cells
+// keep the vertices that become convex; they are skipped by the queries.
+// The vertices whose ear was found to contain a reflex vertex are recorded
+// with it, to be queued again when it becomes convex.
+class vtkPolyVertexGrid { //structure to support fast triangulation
+public:
+  vtkPolyVertexGrid(vtkPolyVertexList *poly, const double u[3],
+                    const double v[3]);
+
+  void Insert(vtkLocalPolyVertex *vtx);
+  int IsEar(vtkLocalPolyVertex *vtx, int &blocker);
+  void Update(vtkLocalPolyVertex *vtx, vtkPriorityQueue *queue);
+
+  vtkPolyVertexList *Poly;
+  std::vector<double> UV;
+  std::vector<char> InGrid;
+  std::vector<std::vector<int> > Blocked;
+  double Bounds[4];
+  int Dimensions[2];
+  double InverseSize[2];
+  std::vector<std::vector<int> > Cells;
+
+protected:
+  void GetCell(const double *uv, int ij[2])
+  {
+    for (int i = 0; i < 2; ++i)
+      {
+      ij[i] = static_cast<int>((uv[i] - this->Bounds[2*i]) *
+                               this->InverseSize[i]);
+      ij[i] = std::max(0, std::min(ij[i], this->Dimensions[i] - 1));
+      }
+  }
+
+  // > 0 when c is on the left of ab
+  static double Cross(const double *a, const double *b, const double *c)
+  {
+    return (b[0] - a[0])*(c[1] - a[1]) - (b[1] - a[1])*(c[0] - a[0]);
+  }
+};
+
+//----------------------------------------------------------------------------
+// The vertex measures must have been computed. u and v span the plane of
+// the polygon, with u x v along its normal, so that the polygon is
+// counterclockwise in (u,v) coordinates.
+vtkPolyVertexGrid::vtkPolyVertexGrid(vtkPolyVertexList *poly,
+                                     const double u[3], const double v[3])
+{
+  this->Poly = poly;
+  int numIds = 0;
+  int i;
+  vtkLocalPolyVertex *vtx;
+  for (i=0, vtx=poly->Head; i < poly->NumberOfVerts; i++, vtx=vtx->next)
+    {
+    numIds = std::max(numIds, vtx->id + 1);
+    }
+  this->UV.resize(2 * numIds);
+  this->InGrid.resize(numIds, 0);
+  this->Blocked.resize(numIds);
+
+  this->Bounds[0] = this->Bounds[2] = VTK_DOUBLE_MAX;
+  this->Bounds[1] = this->Bounds[3] = -VTK_DOUBLE_MAX;
+  int numReflex = 0;
+  for (i=0, vtx=poly->Head; i < poly->NumberOfVerts; i++, vtx=vtx->next)
+    {
+    double *uv = &this->UV[2 * vtx->id];
+    uv[0] = vtkMath::Dot(vtx->x, u);
+    uv[1] = vtkMath::Dot(vtx->x, v);
+    this->Bounds[0] = std::min(this->Bounds[0], uv[0]);
+    this->Bounds[1] = std::max(this->Bounds[1], uv[0]);
+    this->Bounds[2] = std::min(this->Bounds[2], uv[1]);
+    this->Bounds[3] = std::max(this->Bounds[3], uv[1]);
+    numReflex += (vtx->measure > 0.0 ? 0 : 1);
+    }
+
+  // About one reflex vertex per cell, with square cells
+  double width = std::max(this->Bounds[1] - this->Bounds[0], VTK_DBL_MIN);
+  double height = std::max(this->Bounds[3] - this->Bounds[2], VTK_DBL_MIN);
+  double n = std::max(numReflex, 1);
+  double size = sqrt(width * height / n);
+  this->Dimensions[0] = static_cast<int>(std::min(width / size, n)) + 1;
+  this->Dimensions[1] = static_cast<int>(std::min(height / size, n)) + 1;
+  this->InverseSize[0] = this->Dimensions[0] / width;
+  this->InverseSize[1] = this->Dimensions[1] / height;
+  this->Cells.resize(this->Dimensions[0] * this->Dimensions[1]);
+
+  for (i=0, vtx=poly->Head; i < poly->NumberOfVerts; i++, vtx=vtx->next)
+    {
+    if ( vtx->measure <= 0.0 )
+      {
+      this->Insert(vtx);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPolyVertexGrid::Insert(vtkLocalPolyVertex *vtx)
+{
+  if ( !this->InGrid[vtx->id] )
+    {
+    int ij[2];
+    this->GetCell(&this->UV[2 * vtx->id], ij);
+    this->Cells[ij[0] + ij[1] * this->Dimensions[0]].push_back(vtx->id);
+    this->InGrid[vtx->id] = 1;
+    }
+}
+
+//----------------------------------------------------------------------------
+// Update the grid and the queue after the measure of vtx was recomputed.
+void vtkPolyVertexGrid::Update(vtkLocalPolyVertex *vtx,
+                               vtkPriorityQueue *queue)
+{
+  if ( vtx->measure <= 0.0 )
+    {
+    this->Insert(vtx);
+    return;
+    }
+
+  std::vector<int> &blocked = this->Blocked[vtx->id];
+  for (size_t k = 0; k < blocked.size(); ++k)
+    {
+    vtkLocalPolyVertex *other = this->Poly->Array + blocked[k];
+    if ( other->next->previous == other && other->measure > 0.0 )
+      {
+      queue->DeleteId(other->id);
+      queue->Insert(other->measure, other->id);
+      }
+    }
+  blocked.clear();
+}
+
+//----------------------------------------------------------------------------
+// returns != 0 if the convex vertex can be removed, that is if no
+// reflex vertex of the polygon lies inside or on its ear. For a simple
+// polygon, this is equivalent to the test of CanRemoveVertex(). Otherwise
+// blocker is set to one of the vertices inside the ear.
+int vtkPolyVertexGrid::IsEar(vtkLocalPolyVertex *vtx, int &blocker)
+{
+  if ( this->Poly->NumberOfVerts <= 3 )
+    {
+    return 1;
+    }
+
+  const double *a = &this->UV[2 * vtx->previous->id];
+  const double *b = &this->UV[2 * vtx->id];
+  const double *c = &this->UV[2 * vtx->next->id];
+  double bb[4];
+  bb[0] = std::min(a[0], std::min(b[0], c[0]));
+  bb[1] = std::max(a[0], std::max(b[0], c[0]));
+  bb[2] = std::min(a[1], std::min(b[1], c[1]));
+  bb[3] = std::max(a[1], std::max(b[1], c[1]));
+  const double lo[2] = { bb[0], bb[2] };
+  const double hi[2] = { bb[1], bb[3] };
+  int ijLo[2], ijHi[2];
+  this->GetCell(lo, ijLo);
+  this->GetCell(hi, ijHi);
+
+  vtkLocalPolyVertex *array = this->Poly->Array;
+  for (int j = ijLo[1]; j <= ijHi[1]; ++j)
+    {
+    for (int i = ijLo[0]; i <= ijHi[0]; ++i)
+      {
+      const std::vector<int> &cell = this->Cells[i + j * this->Dimensions[0]];
+      for (size_t k = 0; k < cell.size(); ++k)
+        {
+        vtkLocalPolyVertex *other = array + cell[k];
+        const double *p = &this->UV[2 * cell[k]];
+        // Cut vertices are skipped: their neighbors no longer point
+        // back to them.
+        if ( other == vtx || other == vtx->previous || other == vtx->next ||
+             other->measure > 0.0 || other->next->previous != other ||
+             p[0] < bb[0] || p[0] > bb[1] || p[1] < bb[2] || p[1] > bb[3] )
+          {
+          continue;
+          }
+        if ( Cross(a, b, p) >= 0.0 && Cross(b, c, p) >= 0.0 &&
+             Cross(c, a, p) >= 0.0 )
+          {
+          blocker = cell[k];
+          return 0;
+          }
+        }
+      }
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Same ear cut as EarCutTriangulation(), the ears being tested with a
+// vtkPolyVertexGrid. The vertices whose ear cannot be cut are queued again
+// when the reflex vertex that prevented it becomes convex, instead of only
+// when one of their neighbors is cut.
+int vtkPolygon::FastEarCutTriangulation()
+{
+  vtkPolyVertexList poly(this->PointIds, this->Points,
+                         this->Tolerance*this->Tolerance);
+  vtkLocalPolyVertex *vtx;
+  int i, id;
+
+  if ( ! poly.ComputeNormal() )
+    {
+    return (this->SuccessfulTriangulation=0);
+    }
+
+  vtkPriorityQueue *VertexQueue = vtkPriorityQueue::New();
+  VertexQueue->Allocate(poly.NumberOfVerts);
+  for (i=0, vtx=poly.Head; i < poly.NumberOfVerts; i++, vtx=vtx->next)
+    {
+    if ( poly.ComputeMeasure(vtx) > 0.0 )
+      {
+      VertexQueue->Insert(vtx->measure, vtx->id);
+      }
+    }
+
+  double u[3], v[3];
+  vtkMath::Perpendiculars(poly.Normal, u, v, 0.0);
+  vtkPolyVertexGrid grid(&poly, u, v);
+
+  int numInQueue;
+  while ( poly.NumberOfVerts > 2 &&
+          (numInQueue=VertexQueue->GetNumberOfItems()) > 0)
+    {
+    id = VertexQueue->Pop();
+    vtx = poly.Array + id;
+    int blocker = -1;
+    if ( numInQueue == poly.NumberOfVerts || grid.IsEar(vtx, blocker) )
+      {
+      vtkLocalPolyVertex *previous = vtx->previous, *next = vtx->next;
+      poly.RemoveVertex(id,this->Tris,VertexQueue);
+      grid.Update(previous, VertexQueue);
+      grid.Update(next, VertexQueue);
+      }
+    else
+      {
+      grid.Blocked[blocker].push_back(id);
+      }
+    }
+
+  VertexQueue->Delete();
+
+  if ( poly.NumberOfVerts > 2 ) //couldn't triangulate
+    {
+    return (this->SuccessfulTriangulation=0);
+    }
+  return (this->SuccessfulTriangulation=1);
+}
+
 //----------------------------------------------------------------------------
 int vtkPolygon::CellBoundary(int vtkNotUsed(subId), double pcoords[3],
                              vtkIdList *pts)
@@ -1861,6 +2120,8 @@ void vtkPolygon::PrintSelf(ostream& os, vtkIndent indent)
     this->SuccessfulTriangulation << "\n";
   os << indent << "UseMVCInterpolation: " <<
     this->UseMVCInterpolation << "\n";
+  os << indent << "FastTriangulationThreshold: " <<
+    this->FastTriangulationThreshold << "\n";
   os << indent << "Normal: (" << this->Normal[0] << ", "
      << this->Normal[1] << ", " << this->Normal[2] << ")\n";
   os << indent << "Tris:\n";
@@ -138,6 +138,16 @@ public:
   // three-group defines one triangle.
   int Triangulate(vtkIdList *outTris);
 
+  // Description:
+  // Set/Get the number of points from which polygons are triangulated by
+  // testing the ears against a uniform grid of the reflex vertices, in about
+  // O(n log n) operations, rather than against all the edges of the
+  // polygon, in O(n^2). Both methods cut the ears with the smallest angles
+  // first, and are equivalent for simple polygons. The default is 64 points,
+  // so that small polygons are triangulated as before.
+  vtkSetClampMacro(FastTriangulationThreshold, int, 3, VTK_INT_MAX);
+  vtkGetMacro(FastTriangulationThreshold, int);
+
   // Description:
   // Same as Triangulate(vtkIdList *outTris)
   // but with a first pass to split the polygon into non-degenerate polygons.
@@ -204,6 +214,8 @@ protected:
   // for interpolation. The parameter is false by default.
   bool     UseMVCInterpolation;
 
+  int      FastTriangulationThreshold;
+
   // Helper methods for triangulation------------------------------
   // Description:
   // A fast triangulation method. Uses recursive divide and
@@ -212,6 +224,12 @@ protected:
   // Points and PointIds).
   int EarCutTriangulation();
 
+  // Description:
+  // The ear cut of EarCutTriangulation(), with the reflex vertices sorted
+  // in a grid to test the ears. Used for polygons of at least
+  // FastTriangulationThreshold points.
+  int FastEarCutTriangulation();
+
 private:
   vtkPolygon(const vtkPolygon&);  // Not implemented.
   void operator=(const vtkPolygon&);  // Not implemented.
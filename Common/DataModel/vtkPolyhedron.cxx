@@ -39,6 +39,7 @@
 #include "vtkDataArray.h"
 #include "vtkType.h"
 
+#include <cstring>
 #include <map>
 #include <vector>
 #include <set>
@@ -1347,9 +1348,11 @@ vtkPolyhedron::vtkPolyhedron()
   this->GlobalFaces = vtkIdTypeArray::New();
   this->FaceLocations = vtkIdTypeArray::New();
   this->PointIdMap = new vtkPointIdMap;
+  this->PointIdMapGenerated = 0;
 
   this->EdgesGenerated = 0;
   this->EdgeTable = vtkEdgeTable::New();
+  this->EdgeTableGenerated = 0;
   this->Edges = vtkIdTypeArray::New();
   this->Edges->SetNumberOfComponents(2);
 
@@ -1496,21 +1499,15 @@ ComputePositionFromParametricCoordinate(double pc[3], double x[3])
 // points, point ids, and faces have been loaded.
 void vtkPolyhedron::Initialize()
 {
-  // Clear out any remaining memory.
+  // Clear out any remaining memory. The map from the point ids to their
+  // canonical ids is only built when the faces or the edges are derived
+  // from the faces in global ids.
   this->PointIdMap->clear();
-
-  // We need to create a reverse map from the point ids to their canonical cell
-  // ids. This is a fancy way of saying that we have to be able to rapidly go
-  // from a PointId[i] to the location i in the cell.
-  vtkIdType i, id, numPointIds = this->PointIds->GetNumberOfIds();
-  for (i=0; i < numPointIds; ++i)
-    {
-    id = this->PointIds->GetId(i);
-    (*this->PointIdMap)[id] = i;
-    }
+  this->PointIdMapGenerated = 0;
 
   // Edges have to be reset
   this->EdgesGenerated = 0;
+  this->EdgeTableGenerated = 0;
   this->EdgeTable->Reset();
   this->Edges->Reset();
   this->Faces->Reset();
@@ -1531,6 +1528,26 @@ void vtkPolyhedron::Initialize()
   this->LocatorConstructed = 0;
 }
 
+//----------------------------------------------------------------------------
+// We need to create a reverse map from the point ids to their canonical cell
+// ids. This is a fancy way of saying that we have to be able to rapidly go
+// from a PointId[i] to the location i in the cell.
+void vtkPolyhedron::GeneratePointIdMap()
+{
+  if ( this->PointIdMapGenerated )
+    {
+    return;
+    }
+
+  vtkIdType i, id, numPointIds = this->PointIds->GetNumberOfIds();
+  for (i=0; i < numPointIds; ++i)
+    {
+    id = this->PointIds->GetId(i);
+    (*this->PointIdMap)[id] = i;
+    }
+  this->PointIdMapGenerated = 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkPolyhedron::GetNumberOfEdges()
 {
@@ -1580,7 +1597,19 @@ int vtkPolyhedron::GenerateEdges()
 {
   if ( this->EdgesGenerated )
     {
-    return this->Edges->GetNumberOfTuples();
+    // Edges given by SetCanonicalTopology(): fill the table on demand
+    vtkIdType numEdges = this->Edges->GetNumberOfTuples();
+    if ( ! this->EdgeTableGenerated )
+      {
+      vtkIdType *edges = this->Edges->GetPointer(0);
+      this->EdgeTable->InitEdgeInsertion(this->Points->GetNumberOfPoints());
+      for (vtkIdType e=0; e < numEdges; ++e)
+        {
+        this->EdgeTable->InsertEdge(edges[2*e],edges[2*e+1]);
+        }
+      this->EdgeTableGenerated = 1;
+      }
+    return numEdges;
     }
 
   //check the number of faces and return if there aren't any
@@ -1596,6 +1625,7 @@ int vtkPolyhedron::GenerateEdges()
   vtkIdType *face = faces + 1;
   vtkIdType fid, i, edge[2], npts;
 
+  this->GeneratePointIdMap();
   this->EdgeTable->InitEdgeInsertion(this->Points->GetNumberOfPoints());
   for (fid=0; fid < nfaces; ++fid)
     {
@@ -1615,6 +1645,7 @@ int vtkPolyhedron::GenerateEdges()
 
   // Okay all done
   this->EdgesGenerated = 1;
+  this->EdgeTableGenerated = 1;
   return this->Edges->GetNumberOfTuples();
 }
 
@@ -1650,6 +1681,7 @@ void vtkPolyhedron::GenerateFaces()
 
   // Basically we just run through the faces and change the global ids to the
   // canonical ids using the PointIdMap.
+  this->GeneratePointIdMap();
   this->Faces->SetNumberOfTuples(this->GlobalFaces->GetNumberOfTuples());
   vtkIdType *gFaces = this->GlobalFaces->GetPointer(0);
   vtkIdType *faces = this->Faces->GetPointer(0);
@@ -1687,18 +1719,19 @@ vtkCell *vtkPolyhedron::GetFace(int faceId)
   this->GenerateFaces();
 
   // Okay load up the polygon
-  vtkIdType i, p, loc = this->FaceLocations->GetValue(faceId);
+  vtkIdType i, loc = this->FaceLocations->GetValue(faceId);
   vtkIdType *face = this->GlobalFaces->GetPointer(loc);
+  vtkIdType *canonicalFace = this->Faces->GetPointer(loc);
 
   this->Polygon->PointIds->SetNumberOfIds(face[0]);
   this->Polygon->Points->SetNumberOfPoints(face[0]);
 
-  // grab faces in global id space
+  // grab faces in global id space, and their points from the canonical ids
   for (i=0; i < face[0]; ++i)
     {
     this->Polygon->PointIds->SetId(i,face[i+1]);
-    p = (*this->PointIdMap)[face[i+1]];
-    this->Polygon->Points->SetPoint(i,this->Points->GetPoint(p));
+    this->Polygon->Points->SetPoint(i,
+                                    this->Points->GetPoint(canonicalFace[i+1]));
     }
 
   return this->Polygon;
@@ -1720,24 +1753,64 @@ void vtkPolyhedron::SetFaces(vtkIdType *faces)
   vtkIdType nfaces = faces[0];
   this->FaceLocations->SetNumberOfValues(nfaces);
 
-  this->GlobalFaces->InsertNextValue(nfaces);
-  vtkIdType *face = faces + 1;
   vtkIdType faceLoc = 1;
-  vtkIdType i, fid, npts;
+  vtkIdType fid;
 
   for (fid=0; fid < nfaces; ++fid)
     {
-    npts = face[0];
-    this->GlobalFaces->InsertNextValue(npts);
-    for (i=1; i<=npts; ++i)
-      {
-      this->GlobalFaces->InsertNextValue(face[i]);
-      }
     this->FaceLocations->SetValue(fid,faceLoc);
-
-    faceLoc += face[0] + 1;
-    face = faces + faceLoc;
+    faceLoc += faces[faceLoc] + 1;
     } //for all faces
+
+  // The face stream is copied as is
+  this->GlobalFaces->SetNumberOfValues(faceLoc);
+  memcpy(this->GlobalFaces->GetPointer(0), faces, faceLoc*sizeof(vtkIdType));
+}
+
+//----------------------------------------------------------------------------
+void vtkPolyhedron::GetCanonicalTopology(vtkIdTypeArray *topology)
+{
+  this->GenerateFaces();
+  this->GenerateEdges();
+
+  vtkIdType numFaceIds = this->Faces->GetNumberOfTuples();
+  vtkIdType numEdges = this->Edges->GetNumberOfTuples();
+  vtkIdType *ptr = topology->WritePointer(topology->GetNumberOfTuples(),
+                                          numFaceIds + 1 + 2*numEdges);
+  if ( numFaceIds > 0 )
+    {
+    memcpy(ptr, this->Faces->GetPointer(0), numFaceIds*sizeof(vtkIdType));
+    }
+  ptr[numFaceIds] = numEdges;
+  if ( numEdges > 0 )
+    {
+    memcpy(ptr + numFaceIds + 1, this->Edges->GetPointer(0),
+           2*numEdges*sizeof(vtkIdType));
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPolyhedron::SetCanonicalTopology(const vtkIdType *topology)
+{
+  // Same layout as the faces in global ids
+  vtkIdType numFaceIds = this->GlobalFaces->GetNumberOfTuples();
+  this->Faces->SetNumberOfTuples(numFaceIds);
+  if ( numFaceIds > 0 )
+    {
+    memcpy(this->Faces->GetPointer(0), topology,
+           numFaceIds*sizeof(vtkIdType));
+    }
+  this->FacesGenerated = 1;
+
+  vtkIdType numEdges = topology[numFaceIds];
+  this->Edges->SetNumberOfTuples(numEdges);
+  if ( numEdges > 0 )
+    {
+    memcpy(this->Edges->GetPointer(0), topology + numFaceIds + 1,
+           2*numEdges*sizeof(vtkIdType));
+    }
+  this->EdgesGenerated = 1;
+  this->EdgeTableGenerated = 0;
 }
 
 //----------------------------------------------------------------------------
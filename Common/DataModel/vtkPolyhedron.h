@@ -199,6 +199,19 @@ public:
   // Construct polydata if no one exist, then return this->PolyData
   vtkPolyData* GetPolyData();
 
+  // Description:
+  // Append the topology of the initialized cell, in canonical point ids
+  // (0,1,...,npts-1), to topology: the faces in the format of SetFaces(),
+  // followed by the number of edges and their pairs of point ids.
+  void GetCanonicalTopology(vtkIdTypeArray *topology);
+
+  // Description:
+  // Use a topology returned by GetCanonicalTopology() for the same cell
+  // instead of deriving the faces and edges from the faces given to
+  // SetFaces(). Must be called after Initialize(); the topology is copied.
+  // This is how vtkUnstructuredGrid reuses its cached polyhedral topology.
+  void SetCanonicalTopology(const vtkIdType *topology);
+
 protected:
   vtkPolyhedron();
   ~vtkPolyhedron();
@@ -218,11 +231,14 @@ protected:
   // the cell point ids are (0,1,...,npts-1). The PointIdMap maps global point id
   // back to these canonoical point ids.
   vtkPointIdMap  *PointIdMap;
+  int             PointIdMapGenerated;
+  void            GeneratePointIdMap();
 
   // If edges are needed. Note that the edge numbering is in
   // canonical space.
   int             EdgesGenerated; //true/false
   vtkEdgeTable   *EdgeTable; //keep track of all edges
+  int             EdgeTableGenerated; //false for edges given as topology
   vtkIdTypeArray *Edges; //edge pairs kept in this list, in canonical id space
   int             GenerateEdges(); //method populates the edge table and edge array
 
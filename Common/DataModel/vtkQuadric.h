@@ -44,6 +44,10 @@ public:
   // Evaluate the gradient to the quadric equation.
   void EvaluateGradient(double x[3], double g[3]);
 
+  // Description:
+  // Return true since only the coefficients are read during evaluation.
+  virtual bool CanEvaluateInParallel() { return true; }
+
   // Description
   // Set / get the 10 coefficients of the quadric equation.
   void SetCoefficients(double a[10]);
@@ -730,6 +730,24 @@ int vtkRectilinearGrid::GetCellType(vtkIdType vtkNotUsed(cellId))
     }
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkRectilinearGrid::GetGeometryMTime()
+{
+  unsigned long mtime = this->vtkDataSet::GetGeometryMTime();
+  vtkDataArray *coords[3] =
+    { this->XCoordinates, this->YCoordinates, this->ZCoordinates };
+
+  for (int i = 0; i < 3; ++i)
+    {
+    if ( coords[i] && coords[i]->GetMTime() > mtime )
+      {
+      mtime = coords[i]->GetMTime();
+      }
+    }
+
+  return mtime;
+}
+
 //----------------------------------------------------------------------------
 void vtkRectilinearGrid::ComputeBounds()
 {
@@ -88,10 +88,12 @@ public:
   void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
     {vtkStructuredData::GetCellPoints(cellId,ptIds,this->DataDescription,
                                       this->Dimensions);}
+  using vtkDataSet::GetCellPoints;
   void GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
     {vtkStructuredData::GetPointCells(ptId,cellIds,this->Dimensions);}
   void ComputeBounds();
   int GetMaxCellSize() {return 8;}; //voxel is the largest
+  virtual unsigned long GetGeometryMTime();
   void GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
                         vtkIdList *cellIds);
 
@@ -24,7 +24,9 @@
 // topological information. This class is a faster implementation of
 // vtkCellLinks. However, it cannot be incrementally constructed; it is meant
 // to be constructed once (statically) and must be rebuilt if the cells
-// change.
+// change. The links are built in parallel and the cells using each point
+// are listed in increasing order. vtkPointSet::GetStaticCellLinks() returns
+// links cached on the data set.
 
 // .SECTION Caveats
 // This is a drop-in replacement for vtkCellLinks using static link
@@ -47,6 +49,7 @@
 
 class vtkDataSet;
 class vtkCellArray;
+class vtkIdList;
 
 
 class VTKCOMMONDATAMODEL_EXPORT vtkStaticCellLinks : public vtkAbstractCellLinks
@@ -79,6 +82,12 @@ public:
   const vtkIdType *GetCells(vtkIdType ptId)
     {return this->Impl->GetCells(ptId);}
 
+  // Description:
+  // Get the ids of the cells using the edge (p1,p2), excluding cellId.
+  void GetCellEdgeNeighbors(vtkIdType cellId, vtkIdType p1, vtkIdType p2,
+                            vtkIdList *cellIds)
+    {this->Impl->GetCellEdgeNeighbors(cellId,p1,p2,cellIds);}
+
   // Description:
   // Make sure any previously created links are cleaned up.
   void Initialize()
@@ -24,7 +24,8 @@
 // topological information. This class is a faster implementation of
 // vtkCellLinks. However, it cannot be incrementally constructed; it is meant
 // to be constructed once (statically) and must be rebuilt if the cells
-// change.
+// change. The links are built in parallel (via vtkSMPTools), and the cells
+// using each point are listed in increasing order.
 //
 // This is a templated implementation for vtkStaticCellLinks. The reason for
 // the templating is to gain performance and reduce memory by using smaller
@@ -46,6 +47,7 @@ class vtkDataSet;
 class vtkPolyData;
 class vtkUnstructuredGrid;
 class vtkCellArray;
+class vtkIdList;
 
 
 template <typename TIds>
@@ -94,6 +96,11 @@ public:
       return this->Links + this->Offsets[ptId];
     }
 
+  // Description:
+  // Get the ids of the cells using the edge (p1,p2), excluding cellId.
+  void GetCellEdgeNeighbors(vtkIdType cellId, vtkIdType p1, vtkIdType p2,
+                            vtkIdList *cellIds);
+
 protected:
   // The various templated data members
   TIds LinksSize;
@@ -19,255 +19,240 @@
 
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
+#include "vtkIdList.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
 //----------------------------------------------------------------------------
-// Note: this class is a faster, serial version of vtkCellLinks. Future work
-// to parallelize this class is possible. This includes:
-// = using a parallel prefix sum operation
-// = using atomics to update counts (i.e., number of cells using a point)
+// The links are built in parallel. Each cell writes (point id, cell id)
+// pairs at its offset in the link array, then the pairs are sorted by point
+// id with a stable radix sort. As a result the cells of each point are in
+// increasing order, as with vtkCellLinks, whatever the number of threads.
 
 //----------------------------------------------------------------------------
-// Clean up any previously allocated memory
-template <typename TIds> void vtkStaticCellLinksTemplate<TIds>::
-Initialize()
+// Count the points of each cell.
+template <typename TIds>
+class vtkStaticCellLinksCount
 {
-  if ( this->Links )
+public:
+  vtkDataSet *DataSet;
+  TIds *CellSizes;
+  vtkSMPThreadLocalObject<vtkIdList> PtIds;
+
+  vtkStaticCellLinksCount(vtkDataSet *ds, TIds *cellSizes) :
+    DataSet(ds), CellSizes(cellSizes)
     {
-    delete [] this->Links;
-    this->Links = NULL;
     }
-  if ( this->Offsets )
+
+  void operator()(vtkIdType cellId, vtkIdType end)
     {
-    delete [] this->Offsets;
-    this->Offsets = NULL;
+    vtkIdList *ptIds = this->PtIds.Local();
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for ( ; cellId < end; ++cellId )
+      {
+      this->DataSet->GetCellPoints(cellId, npts, pts, ptIds);
+      this->CellSizes[cellId] = static_cast<TIds>(npts);
+      }
     }
-}
+};
 
 //----------------------------------------------------------------------------
-// Build the link list array for any dataset type. Specialized methods are
-// used for dataset types that use vtkCellArrays to represent cells.
-template <typename TIds> void vtkStaticCellLinksTemplate<TIds>::
-BuildLinks(vtkDataSet *ds)
+// Write the (point id, cell id) pairs of each cell at its offset.
+template <typename TIds>
+class vtkStaticCellLinksInsert
 {
-  // Use a fast path if polydata or unstructured grid
-  if ( ds->GetDataObjectType() == VTK_POLY_DATA )
+public:
+  vtkDataSet *DataSet;
+  const TIds *CellOffsets;
+  TIds *PointIds;
+  TIds *Links;
+  vtkSMPThreadLocalObject<vtkIdList> PtIds;
+
+  vtkStaticCellLinksInsert(vtkDataSet *ds, const TIds *cellOffsets,
+                           TIds *pointIds, TIds *links) :
+    DataSet(ds), CellOffsets(cellOffsets), PointIds(pointIds), Links(links)
     {
-    return this->BuildLinks(static_cast<vtkPolyData*>(ds));
     }
 
-  else if ( ds->GetDataObjectType() == VTK_UNSTRUCTURED_GRID )
-    {
-    return this->BuildLinks(static_cast<vtkUnstructuredGrid*>(ds));
-    }
-
-  // Any other type of dataset. Generally this is not called as datasets have
-  // their own, more efficient ways of getting similar information.
-  // Make sure that we clear out previous allocation.
-  this->NumCells = ds->GetNumberOfCells();
-  this->NumPts = ds->GetNumberOfPoints();
-
-  vtkIdType npts, ptId;
-  vtkIdType cellId, j;
-  vtkIdList *cellPts = vtkIdList::New();
-
-  // Traverse data to determine number of uses of each point. Also count the
-  // number of links to allocate.
-  this->Offsets = new TIds[this->NumPts+1];
-  std::fill_n(this->Offsets, this->NumPts, 0);
-
-  for (this->LinksSize=0, cellId=0; cellId < this->NumCells; cellId++)
+  void operator()(vtkIdType cellId, vtkIdType end)
     {
-    ds->GetCellPoints(cellId,cellPts);
-    npts = cellPts->GetNumberOfIds();
-    for (j=0; j < npts; j++)
+    vtkIdList *ptIds = this->PtIds.Local();
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for ( ; cellId < end; ++cellId )
       {
-      this->Offsets[cellPts->GetId(j)]++;
-      this->LinksSize++;
+      this->DataSet->GetCellPoints(cellId, npts, pts, ptIds);
+      TIds *ids = this->PointIds + this->CellOffsets[cellId];
+      TIds *links = this->Links + this->CellOffsets[cellId];
+      for (vtkIdType i=0; i < npts; ++i)
+        {
+        ids[i] = static_cast<TIds>(pts[i]);
+        links[i] = static_cast<TIds>(cellId);
+        }
       }
     }
+};
 
-  // Allocate space for links. Perform prefix sum.
-  this->Links = new TIds[this->LinksSize+1];
-  this->Links[this->LinksSize] = this->NumPts;
+//----------------------------------------------------------------------------
+// Find the start of the run of each point in the sorted point ids. Points
+// used by no cell start where the next point does.
+template <typename TIds>
+class vtkStaticCellLinksOffsets
+{
+public:
+  const TIds *PointIds;
+  TIds *Offsets;
 
-  for ( ptId=0; ptId < this->NumPts; ++ptId )
+  vtkStaticCellLinksOffsets(const TIds *pointIds, TIds *offsets) :
+    PointIds(pointIds), Offsets(offsets)
     {
-    npts = this->Offsets[ptId+1];
-    this->Offsets[ptId+1] = this->Offsets[ptId] + npts;
     }
 
-  // Now build the links. The summation from the prefix sum indicates where
-  // the cells are to be inserted. Each time a cell is inserted, the offset
-  // is decremented. In the end, the offset array is also constructed as it
-  // points to the beginning of each cell run.
-  for ( cellId=0; cellId < this->NumCells; ++cellId )
+  void operator()(vtkIdType i, vtkIdType end)
     {
-    ds->GetCellPoints(cellId,cellPts);
-    npts = cellPts->GetNumberOfIds();
-    for (j=0; j<npts; ++j)
+    for ( ; i < end; ++i )
       {
-      ptId = cellPts->GetId(j);
-      this->Offsets[ptId]--;
-      this->Links[this->Offsets[ptId]] = cellId;
+      TIds ptId = this->PointIds[i];
+      TIds prevId = (i > 0 ? this->PointIds[i-1] : -1);
+      for (TIds p=prevId+1; p <= ptId; ++p)
+        {
+        this->Offsets[p] = static_cast<TIds>(i);
+        }
       }
     }
-  this->Offsets[this->NumPts] = this->LinksSize;
+};
 
-  cellPts->Delete();
+//----------------------------------------------------------------------------
+// Clean up any previously allocated memory
+template <typename TIds> void vtkStaticCellLinksTemplate<TIds>::
+Initialize()
+{
+  if ( this->Links )
+    {
+    delete [] this->Links;
+    this->Links = NULL;
+    }
+  if ( this->Offsets )
+    {
+    delete [] this->Offsets;
+    this->Offsets = NULL;
+    }
+  this->LinksSize = 0;
+  this->NumPts = 0;
+  this->NumCells = 0;
 }
 
 //----------------------------------------------------------------------------
-// Build the link list array for unstructured grids
+// Build the link list array for any dataset type. All the datasets are
+// traversed with GetCellPoints(), which points into the connectivity of
+// vtkPolyData and vtkUnstructuredGrid.
 template <typename TIds> void vtkStaticCellLinksTemplate<TIds>::
-BuildLinks(vtkUnstructuredGrid *ugrid)
+BuildLinks(vtkDataSet *ds)
 {
-  // Basic information about the grid
-  this->NumCells = ugrid->GetNumberOfCells();
-  this->NumPts = ugrid->GetNumberOfPoints();
+  // Make sure that we clear out previous allocation.
+  this->Initialize();
 
-  // We're going to get into the guts of the class
-  vtkCellArray *cellArray = ugrid->GetCells();
-  const vtkIdType *cells = cellArray->GetPointer();
+  const vtkIdType numCells = ds->GetNumberOfCells();
+  const vtkIdType numPts = ds->GetNumberOfPoints();
+  this->NumCells = static_cast<TIds>(numCells);
+  this->NumPts = static_cast<TIds>(numPts);
 
-  // I love this trick: the size of the Links array is equal to
-  // the size of the cell array, minus the number of cells.
+  // GetCellPoints() is thread safe once called from a single thread, which
+  // builds the cells of vtkPolyData.
+  vtkIdList *cellPts = vtkIdList::New();
+  if ( numCells > 0 )
+    {
+    vtkIdType npts;
+    const vtkIdType *pts;
+    ds->GetCellPoints(0, npts, pts, cellPts);
+    }
+  cellPts->Delete();
+
+  // Prefix sum of the cell sizes: where the links of each cell go
+  TIds *cellOffsets = new TIds[numCells+1];
+  vtkStaticCellLinksCount<TIds> count(ds, cellOffsets);
+  vtkSMPTools::For(0, numCells, count);
   this->LinksSize =
-    cellArray->GetNumberOfConnectivityEntries() - this->NumCells;
+    vtkSMPTools::ExclusiveScan(cellOffsets, cellOffsets+numCells,
+                               cellOffsets, static_cast<TIds>(0));
+  cellOffsets[numCells] = this->LinksSize;
 
   // Extra one allocated to simplify later pointer manipulation
   this->Links = new TIds[this->LinksSize+1];
   this->Links[this->LinksSize] = this->NumPts;
-  this->Offsets = new TIds[this->NumPts+1];
-  std::fill_n(this->Offsets, this->NumPts, 0);
+  this->Offsets = new TIds[numPts+1];
 
-  // Now create the links.
-  vtkIdType npts, cellId, ptId;
-  const vtkIdType *cell=cells;
-  int i;
+  TIds *pointIds = new TIds[this->LinksSize];
+  vtkStaticCellLinksInsert<TIds> insert(ds, cellOffsets, pointIds, this->Links);
+  vtkSMPTools::For(0, numCells, insert);
+  delete [] cellOffsets;
 
-  // Count number of point uses
-  for ( cellId=0; cellId < this->NumCells; ++cellId )
-    {
-    npts = *cell++;
-    for (i=0; i<npts; ++i)
-      {
-      this->Offsets[*cell++]++;
-      }
-    }
+  vtkSMPTools::RadixSort(pointIds, pointIds+this->LinksSize, this->Links);
 
-  // Perform prefix sum
-  for ( ptId=0; ptId < this->NumPts; ++ptId )
+  vtkStaticCellLinksOffsets<TIds> offsets(pointIds, this->Offsets);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(this->LinksSize), offsets);
+  TIds ptId = (this->LinksSize > 0 ? pointIds[this->LinksSize-1] + 1 : 0);
+  for ( ; ptId <= this->NumPts; ++ptId )
     {
-    npts = this->Offsets[ptId+1];
-    this->Offsets[ptId+1] = this->Offsets[ptId] + npts;
+    this->Offsets[ptId] = this->LinksSize;
     }
 
-  // Now build the links. The summation from the prefix sum indicates where
-  // the cells are to be inserted. Each time a cell is inserted, the offset
-  // is decremented. In the end, the offset array is also constructed as it
-  // points to the beginning of each cell run.
-  for ( cell=cells, cellId=0; cellId < this->NumCells; ++cellId )
-    {
-    npts = *cell++;
-    for (i=0; i<npts; ++i)
-      {
-      this->Offsets[*cell]--;
-      this->Links[this->Offsets[*cell++]] = cellId;
-      }
-    }
-  this->Offsets[this->NumPts] = this->LinksSize;
+  delete [] pointIds;
+}
+
+//----------------------------------------------------------------------------
+// Build the link list array for unstructured grids
+template <typename TIds> void vtkStaticCellLinksTemplate<TIds>::
+BuildLinks(vtkUnstructuredGrid *ugrid)
+{
+  this->BuildLinks(static_cast<vtkDataSet*>(ugrid));
 }
 
 //----------------------------------------------------------------------------
-// Build the link list array for poly data. This is more complex because there
-// are potentially fout different cell arrays to contend with.
+// Build the link list array for poly data.
 template <typename TIds> void vtkStaticCellLinksTemplate<TIds>::
 BuildLinks(vtkPolyData *pd)
 {
-  // Basic information about the grid
-  this->NumCells = pd->GetNumberOfCells();
-  this->NumPts = pd->GetNumberOfPoints();
+  this->BuildLinks(static_cast<vtkDataSet*>(pd));
+}
 
-  vtkCellArray *cellArrays[4];
-  vtkIdType numCells[4];
-  vtkIdType sizes[4];
-  int i, j;
+//----------------------------------------------------------------------------
+// The cells of each point are sorted, so the cells using both points of the
+// edge are found by merging the two lists.
+template <typename TIds> void vtkStaticCellLinksTemplate<TIds>::
+GetCellEdgeNeighbors(vtkIdType cellId, vtkIdType p1, vtkIdType p2,
+                     vtkIdList *cellIds)
+{
+  cellIds->Reset();
 
-  cellArrays[0] = pd->GetVerts();
-  cellArrays[1] = pd->GetLines();
-  cellArrays[2] = pd->GetPolys();
-  cellArrays[3] = pd->GetStrips();
+  const TIds *c1 = this->GetCells(p1);
+  const TIds *end1 = c1 + this->GetNumberOfCells(p1);
+  const TIds *c2 = this->GetCells(p2);
+  const TIds *end2 = c2 + this->GetNumberOfCells(p2);
 
-  for (i=0; i<4; ++i)
+  while ( c1 != end1 && c2 != end2 )
     {
-    if ( cellArrays[i] != NULL )
+    if ( *c1 < *c2 )
       {
-      numCells[i] = cellArrays[i]->GetNumberOfCells();
-      sizes[i] = cellArrays[i]->GetNumberOfConnectivityEntries() - numCells[i];
+      ++c1;
       }
-    else
+    else if ( *c2 < *c1 )
       {
-      numCells[i] = 0;
-      sizes[i] = 0;
+      ++c2;
       }
-    }//for the four polydata arrays
-
-  // Allocate
-  this->LinksSize = sizes[0] + sizes[1] + sizes[2] + sizes[3];
-  this->Links = new TIds[this->LinksSize+1];
-  this->Links[this->LinksSize] = this->NumPts;
-  this->Offsets = new TIds[this->NumPts+1];
-  this->Offsets[this->NumPts] = this->LinksSize;
-  std::fill_n(this->Offsets, this->NumPts, 0);
-
-  // Now create the links.
-  vtkIdType npts, cellId, CellId, ptId;
-  const vtkIdType *cell;
-
-  // Visit the four arrays
-  for ( CellId=0, j=0; j < 4; ++j )
-    {
-    // Count number of point uses
-    cell = cellArrays[j]->GetPointer();
-    for ( cellId=0; cellId < numCells[j]; ++cellId )
+    else
       {
-      npts = *cell++;
-      for (i=0; i<npts; ++i)
+      if ( *c1 != cellId )
         {
-        this->Offsets[CellId+(*cell++)]++;
+        cellIds->InsertNextId(*c1);
         }
+      ++c1;
+      ++c2;
       }
-    CellId += numCells[j];
-    } //for each of the four polydata cell arrays
-
-  // Perform prefix sum
-  for ( ptId=0; ptId < this->NumPts; ++ptId )
-    {
-    npts = this->Offsets[ptId+1];
-    this->Offsets[ptId+1] = this->Offsets[ptId] + npts;
     }
-
-  // Now build the links. The summation from the prefix sum indicates where
-  // the cells are to be inserted. Each time a cell is inserted, the offset
-  // is decremented. In the end, the offset array is also constructed as it
-  // points to the beginning of each cell run.
-  for ( CellId=0, j=0; j < 4; ++j )
-    {
-    cell = cellArrays[j]->GetPointer();
-    for ( cellId=0; cellId < numCells[j]; ++cellId )
-      {
-      npts = *cell++;
-      for (i=0; i<npts; ++i)
-        {
-        this->Offsets[*cell]--;
-        this->Links[this->Offsets[*cell++]] = CellId+cellId;
-        }
-      }
-    CellId += numCells[j];
-    }//for each of the four polydata arrays
-  this->Offsets[this->NumPts] = this->LinksSize;
 }
 
 #endif
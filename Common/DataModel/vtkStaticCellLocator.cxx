@@ -0,0 +1,1313 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStaticCellLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+vtkStandardNewMacro(vtkStaticCellLocator);
+
+//-----------------------------------------------------------------------------
+// The following code supports threaded cell locator construction. The locator
+// is assumed to be constructed once (i.e., it does not allow incremental cell
+// insertion). The algorithm proceeds in four steps:
+// 1) The bounds of all cells are computed in parallel, and the number of bins
+// that each cell bounding box overlaps is counted.
+// 2) A prefix sum of the counts gives each cell its range in a "fragment"
+// array, which is then filled in parallel with (cell id, bin index) pairs.
+// 3) vtkSMPTools::RadixSort() sorts the fragments on the bin index. This
+// creates contiguous runs of cells that overlap the same bin.
+// 4) The bin offsets into the sorted fragments are found in parallel with a
+// binary search for the beginning of each run.
+
+namespace
+{
+// Clip the segment p1 + t*d, t in [t0,t1], against bounds. Return false if
+// the segment misses the bounds.
+bool ClipSegment(const double bounds[6], const double p1[3], const double d[3],
+                 double &t0, double &t1)
+{
+  for (int i = 0; i < 3; ++i)
+    {
+    if (d[i] == 0.0)
+      {
+      if (p1[i] < bounds[2*i] || p1[i] > bounds[2*i+1])
+        {
+        return false;
+        }
+      continue;
+      }
+    double ta = (bounds[2*i] - p1[i]) / d[i];
+    double tb = (bounds[2*i+1] - p1[i]) / d[i];
+    if (ta > tb)
+      {
+      std::swap(ta, tb);
+      }
+    t0 = (ta > t0 ? ta : t0);
+    t1 = (tb < t1 ? tb : t1);
+    if (t0 > t1)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// Return whether x lies in bounds enlarged by tol.
+inline bool InsideBounds(const double x[3], const double b[6], double tol)
+{
+  return (x[0] >= b[0] - tol && x[0] <= b[1] + tol &&
+          x[1] >= b[2] - tol && x[1] <= b[3] + tol &&
+          x[2] >= b[4] - tol && x[2] <= b[5] + tol);
+}
+
+//-----------------------------------------------------------------------------
+// Return the squared distance from x to bounds, zero inside.
+inline double Distance2ToBounds(const double x[3], const double b[6])
+{
+  double dist2 = 0.0;
+  for (int i = 0; i < 3; ++i)
+    {
+    double d = (x[i] < b[2*i] ? b[2*i] - x[i] :
+                (x[i] > b[2*i+1] ? x[i] - b[2*i+1] : 0.0));
+    dist2 += d * d;
+    }
+  return dist2;
+}
+
+//-----------------------------------------------------------------------------
+// Compute the bounds of cells through the thread safe GetCellPoints() and
+// GetPoint(). Cells without points get invalid bounds.
+class ComputeCellBounds
+{
+public:
+  vtkDataSet *DataSet;
+  double (*Bounds)[6];
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+
+  ComputeCellBounds(vtkDataSet *ds, double (*bounds)[6]) :
+    DataSet(ds), Bounds(bounds)
+    {
+    }
+
+  void operator()(vtkIdType cellId, vtkIdType end)
+    {
+    vtkIdList *ids = this->CellIds.Local();
+    double x[3];
+    for ( ; cellId < end; ++cellId )
+      {
+      double *b = this->Bounds[cellId];
+      this->DataSet->GetCellPoints(cellId, ids);
+      vtkIdType numIds = ids->GetNumberOfIds();
+      b[0] = b[2] = b[4] = VTK_DOUBLE_MAX;
+      b[1] = b[3] = b[5] = -VTK_DOUBLE_MAX;
+      for (vtkIdType i = 0; i < numIds; ++i)
+        {
+        this->DataSet->GetPoint(ids->GetId(i), x);
+        for (int j = 0; j < 3; ++j)
+          {
+          b[2*j] = (x[j] < b[2*j] ? x[j] : b[2*j]);
+          b[2*j+1] = (x[j] > b[2*j+1] ? x[j] : b[2*j+1]);
+          }
+        }
+      }
+    }
+};
+}
+
+//-----------------------------------------------------------------------------
+// The binned cells. This is just a PIMPLd wrapper around the templated class
+// that does the real work.
+class vtkCellBinner
+{
+public:
+  vtkStaticCellLocator *Locator; //locator
+  vtkDataSet *DataSet;
+  vtkIdType NumCells; //the number of cells to bin
+  vtkIdType NumFragments; //the number of (cell,bin) pairs
+  vtkIdType NumBins;
+  double (*CellBounds)[6];
+
+  // These are internal data members used for performance reasons
+  int Divisions[3];
+  double Bounds[6];
+  double H[3];
+  double fX, fY, fZ, bX, bY, bZ;
+  vtkIdType xD, yD, zD, xyD;
+
+  // Construction
+  vtkCellBinner(vtkStaticCellLocator *loc, vtkIdType numCells,
+                vtkIdType numBins)
+    {
+      this->Locator = loc;
+      this->DataSet = loc->GetDataSet();
+      this->NumCells = numCells;
+      this->NumFragments = 0;
+      this->NumBins = numBins;
+      this->CellBounds = loc->CellBounds;
+      loc->GetDivisions(this->Divisions);
+
+      // Setup internal data members for more efficient processing.
+      for (int i = 0; i < 3; ++i)
+        {
+        this->H[i] = loc->H[i];
+        this->Bounds[2*i] = loc->Bounds[2*i];
+        this->Bounds[2*i+1] = loc->Bounds[2*i+1];
+        }
+      this->fX = 1.0 / loc->H[0];
+      this->fY = 1.0 / loc->H[1];
+      this->fZ = 1.0 / loc->H[2];
+      this->bX = this->Bounds[0];
+      this->bY = this->Bounds[2];
+      this->bZ = this->Bounds[4];
+      this->xD = this->Divisions[0];
+      this->yD = this->Divisions[1];
+      this->zD = this->Divisions[2];
+      this->xyD = this->Divisions[0] * this->Divisions[1];
+    }
+
+  // Virtuals for templated subclasses
+  virtual ~vtkCellBinner() {}
+  virtual void BuildLocator(const vtkIdType *cellOffsets) = 0;
+  virtual vtkIdType GetNumberOfIds(vtkIdType binNum) = 0;
+  virtual void GetIds(vtkIdType binNum, vtkIdList *cells) = 0;
+  virtual vtkIdType FindCell(double x[3], double tol2, vtkGenericCell *cell,
+                             double pcoords[3], double *weights) = 0;
+  virtual int IntersectWithLine(double p1[3], double p2[3], double tol,
+                                double& t, double x[3], double pcoords[3],
+                                int &subId, vtkIdType &cellId,
+                                vtkGenericCell *cell) = 0;
+  virtual void FindCellsWithinBounds(double *bbox, vtkIdList *cells) = 0;
+  virtual void FindCellsAlongLine(double p1[3], double p2[3],
+                                  vtkIdList *cells) = 0;
+  virtual vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                                 double closestPoint[3],
+                                                 vtkGenericCell *cell,
+                                                 vtkIdType &cellId,
+                                                 int &subId, double &dist2,
+                                                 int &inside) = 0;
+
+  //-----------------------------------------------------------------------------
+  // Inlined for performance. These function invocations must be called after
+  // BuildLocator() is invoked, otherwise the output is indeterminate.
+  void GetBinIndices(const double *x, int ijk[3]) const
+    {
+    // Compute bin index. Make sure it lies within range of locator.
+    ijk[0] = static_cast<int>(((x[0] - bX) * fX));
+    ijk[1] = static_cast<int>(((x[1] - bY) * fY));
+    ijk[2] = static_cast<int>(((x[2] - bZ) * fZ));
+
+    ijk[0] = (ijk[0] < 0 ? 0 : (ijk[0] >= xD ? xD-1 : ijk[0]));
+    ijk[1] = (ijk[1] < 0 ? 0 : (ijk[1] >= yD ? yD-1 : ijk[1]));
+    ijk[2] = (ijk[2] < 0 ? 0 : (ijk[2] >= zD ? zD-1 : ijk[2]));
+    }
+
+  //-----------------------------------------------------------------------------
+  vtkIdType GetBinIndex(const double *x) const
+    {
+    int ijk[3];
+    this->GetBinIndices(x, ijk);
+    return ijk[0] + ijk[1]*xD + ijk[2]*xyD;
+    }
+
+  //-----------------------------------------------------------------------------
+  // Return the range of bins overlapped by a cell, or false if the cell has
+  // no points.
+  bool GetCellBins(vtkIdType cellId, int ijkMin[3], int ijkMax[3]) const
+    {
+    const double *b = this->CellBounds[cellId];
+    if (b[0] > b[1])
+      {
+      return false;
+      }
+    double x[3];
+    x[0] = b[0]; x[1] = b[2]; x[2] = b[4];
+    this->GetBinIndices(x, ijkMin);
+    x[0] = b[1]; x[1] = b[3]; x[2] = b[5];
+    this->GetBinIndices(x, ijkMax);
+    return true;
+    }
+
+  //-----------------------------------------------------------------------------
+  // Walk of the bins crossed by a line segment, in the order of the line
+  // parameter (3D digital differential analyzer).
+  struct LineWalk
+    {
+    int IJK[3];
+    int Step[3];
+    double TMax[3]; // parameter at which the walk enters the next bin
+    double TDelta[3]; // parameter span of a bin
+    double TEnd; // parameter at which the segment leaves the locator
+    };
+
+  // Start a walk along p1 + t*(p2 - p1), t in [0,1]. Return false if the
+  // segment misses the locator.
+  bool StartLine(const double p1[3], const double p2[3], LineWalk &w) const
+    {
+    double d[3], t0 = 0.0, t1 = 1.0;
+    for (int i = 0; i < 3; ++i)
+      {
+      d[i] = p2[i] - p1[i];
+      }
+    if (!ClipSegment(this->Bounds, p1, d, t0, t1))
+      {
+      return false;
+      }
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+      {
+      x[i] = p1[i] + t0 * d[i];
+      }
+    this->GetBinIndices(x, w.IJK);
+    for (int i = 0; i < 3; ++i)
+      {
+      if (d[i] > 0.0)
+        {
+        w.Step[i] = 1;
+        w.TMax[i] =
+          (this->Bounds[2*i] + (w.IJK[i] + 1) * this->H[i] - p1[i]) / d[i];
+        w.TDelta[i] = this->H[i] / d[i];
+        }
+      else if (d[i] < 0.0)
+        {
+        w.Step[i] = -1;
+        w.TMax[i] = (this->Bounds[2*i] + w.IJK[i] * this->H[i] - p1[i]) / d[i];
+        w.TDelta[i] = -this->H[i] / d[i];
+        }
+      else
+        {
+        w.Step[i] = 0;
+        w.TMax[i] = VTK_DOUBLE_MAX;
+        w.TDelta[i] = VTK_DOUBLE_MAX;
+        }
+      }
+    w.TEnd = t1;
+    return true;
+    }
+
+  // Move to the next bin. Return false at the end of the segment.
+  bool NextBin(LineWalk &w) const
+    {
+    int axis = (w.TMax[0] < w.TMax[1] ? 0 : 1);
+    axis = (w.TMax[2] < w.TMax[axis] ? 2 : axis);
+    if (w.TMax[axis] > w.TEnd)
+      {
+      return false;
+      }
+    w.IJK[axis] += w.Step[axis];
+    if (w.IJK[axis] < 0 || w.IJK[axis] >= this->Divisions[axis])
+      {
+      return false;
+      }
+    w.TMax[axis] += w.TDelta[axis];
+    return true;
+    }
+
+  // Parameter at which the walk leaves the current bin.
+  static double BinExit(const LineWalk &w)
+    {
+    return std::min(w.TMax[0], std::min(w.TMax[1], w.TMax[2]));
+    }
+
+  vtkIdType GetBinIndex(const LineWalk &w) const
+    {
+    return w.IJK[0] + w.IJK[1]*xD + w.IJK[2]*xyD;
+    }
+
+  void GenerateRepresentation(vtkPolyData *pd);
+};
+
+//-----------------------------------------------------------------------------
+// Add the six faces of the non-empty bins to pd.
+void vtkCellBinner::GenerateRepresentation(vtkPolyData *pd)
+{
+  vtkPoints *pts = vtkPoints::New();
+  vtkCellArray *polys = vtkCellArray::New();
+  static const int faces[6][4] = { {0,2,6,4}, {1,3,7,5}, {0,1,5,4},
+                                   {2,3,7,6}, {0,1,3,2}, {4,5,7,6} };
+
+  for (int k = 0; k < this->Divisions[2]; ++k)
+    {
+    for (int j = 0; j < this->Divisions[1]; ++j)
+      {
+      for (int i = 0; i < this->Divisions[0]; ++i)
+        {
+        if (this->GetNumberOfIds(i + j*this->xD + k*this->xyD) == 0)
+          {
+          continue;
+          }
+        vtkIdType corners[8];
+        for (int c = 0; c < 8; ++c)
+          {
+          corners[c] = pts->InsertNextPoint(
+            this->bX + (i + (c & 1)) * this->H[0],
+            this->bY + (j + ((c >> 1) & 1)) * this->H[1],
+            this->bZ + (k + ((c >> 2) & 1)) * this->H[2]);
+          }
+        for (int f = 0; f < 6; ++f)
+          {
+          vtkIdType ids[4];
+          for (int c = 0; c < 4; ++c)
+            {
+            ids[c] = corners[faces[f][c]];
+            }
+          polys->InsertNextCell(4, ids);
+          }
+        }
+      }
+    }
+
+  pd->SetPoints(pts);
+  pts->Delete();
+  pd->SetPolys(polys);
+  polys->Delete();
+  pd->Squeeze();
+}
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// The following tuple is what is sorted in the map. Note that it is templated
+// because depending on the number of cells / fragments to process we may want
+// to use vtkIdType. Otherwise for performance reasons it's best to use an int.
+template <typename TIds>
+class CellFragment
+{
+public:
+  TIds CellId; //originating cell id
+  TIds BinId; //i-j-k index into bin space
+};
+
+template <typename TIds>
+struct FragmentBinLess
+{
+  bool operator()(const CellFragment<TIds> &f, vtkIdType bin) const
+    {
+    return f.BinId < bin;
+    }
+};
+}
+
+//-----------------------------------------------------------------------------
+// This templated class manages the creation of the static locator
+// structures. It also implements the operator() functors which are supplied
+// to vtkSMPTools for threaded processing.
+template <typename TIds>
+class CellBinner : public vtkCellBinner
+{
+public:
+  CellFragment<TIds> *Map; //the map to be sorted
+  TIds               *Offsets; //offsets for each bin into the map
+
+  // Construction
+  CellBinner(vtkStaticCellLocator *loc, vtkIdType numCells,
+             vtkIdType numBins, vtkIdType numFragments) :
+    vtkCellBinner(loc, numCells, numBins)
+    {
+      this->NumFragments = numFragments;
+      this->Map = new CellFragment<TIds>[numFragments+1];
+      this->Offsets = new TIds[numBins+1];
+    }
+
+  // Release allocated memory
+  virtual ~CellBinner()
+    {
+      delete [] this->Map;
+      delete [] this->Offsets;
+    }
+
+  // The number of cell ids in a bin is determined by computing the
+  // difference between the offsets into the sorted fragments array.
+  virtual vtkIdType GetNumberOfIds(vtkIdType binNum)
+    {
+      return (this->Offsets[binNum+1] - this->Offsets[binNum]);
+    }
+
+  // Given a bin number, return the cell fragments in that bin.
+  const CellFragment<TIds> *GetFragments(vtkIdType binNum)
+    {
+      return this->Map + this->Offsets[binNum];
+    }
+
+  // Given a bin number, return the cell ids in that bin.
+  virtual void GetIds(vtkIdType binNum, vtkIdList *cells)
+    {
+      const CellFragment<TIds> *ids = this->GetFragments(binNum);
+      vtkIdType numIds = this->GetNumberOfIds(binNum);
+      cells->SetNumberOfIds(numIds);
+      for (vtkIdType i=0; i < numIds; i++)
+        {
+        cells->SetId(i,ids[i].CellId);
+        }
+    }
+
+  // Templated implementations of the locator
+  virtual vtkIdType FindCell(double x[3], double tol2, vtkGenericCell *cell,
+                             double pcoords[3], double *weights);
+  virtual int IntersectWithLine(double p1[3], double p2[3], double tol,
+                                double& t, double x[3], double pcoords[3],
+                                int &subId, vtkIdType &cellId,
+                                vtkGenericCell *cell);
+  virtual void FindCellsWithinBounds(double *bbox, vtkIdList *cells);
+  virtual void FindCellsAlongLine(double p1[3], double p2[3],
+                                  vtkIdList *cells);
+  virtual vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                                 double closestPoint[3],
+                                                 vtkGenericCell *cell,
+                                                 vtkIdType &cellId,
+                                                 int &subId, double &dist2,
+                                                 int &inside);
+
+  // The state of a closest point search.
+  struct ClosestPointSearch
+    {
+    const double *X;
+    vtkGenericCell *Cell;
+    std::vector<double> Weights;
+    double MinDist2;
+    vtkIdType CellId;
+    vtkIdType Loaded; // the cell currently held by Cell
+    int SubId;
+    int Inside;
+    double ClosestPoint[3];
+    };
+
+  // Evaluate the cells of a bin that may be closer than the closest cell
+  // found so far.
+  void SearchBin(vtkIdType binId, ClosestPointSearch &search);
+
+  // Fill the fragments of each cell, starting at the offsets given by the
+  // prefix sum of the bin counts.
+  class MapCells
+    {
+    public:
+      CellBinner<TIds> *Binner;
+      const vtkIdType *CellOffsets;
+
+      MapCells(CellBinner<TIds> *binner, const vtkIdType *offsets) :
+        Binner(binner), CellOffsets(offsets)
+        {
+        }
+
+      void operator()(vtkIdType cellId, vtkIdType end)
+        {
+        int ijkMin[3], ijkMax[3];
+        const vtkIdType xD = this->Binner->xD, xyD = this->Binner->xyD;
+        for ( ; cellId < end; ++cellId )
+          {
+          if (!this->Binner->GetCellBins(cellId, ijkMin, ijkMax))
+            {
+            continue;
+            }
+          CellFragment<TIds> *f =
+            this->Binner->Map + this->CellOffsets[cellId];
+          for (int k = ijkMin[2]; k <= ijkMax[2]; ++k)
+            {
+            for (int j = ijkMin[1]; j <= ijkMax[1]; ++j)
+              {
+              for (int i = ijkMin[0]; i <= ijkMax[0]; ++i, ++f)
+                {
+                f->CellId = static_cast<TIds>(cellId);
+                f->BinId = static_cast<TIds>(i + j*xD + k*xyD);
+                }
+              }
+            }
+          }
+        }
+    };
+
+  // Find the beginning of the run of each bin in the sorted fragments.
+  class MapOffsets
+    {
+    public:
+      CellBinner<TIds> *Binner;
+
+      MapOffsets(CellBinner<TIds> *binner) : Binner(binner)
+        {
+        }
+
+      void operator()(vtkIdType bin, vtkIdType end)
+        {
+        const CellFragment<TIds> *begin = this->Binner->Map;
+        const CellFragment<TIds> *last =
+          begin + this->Binner->NumFragments;
+        // The runs are sorted, so each search starts at the previous run.
+        const CellFragment<TIds> *f = std::lower_bound(
+          begin, last, bin, FragmentBinLess<TIds>());
+        for ( ; bin < end; ++bin )
+          {
+          f = std::lower_bound(f, last, bin, FragmentBinLess<TIds>());
+          this->Binner->Offsets[bin] = static_cast<TIds>(f - begin);
+          }
+        }
+    };
+
+  // Build the map and other structures to support locator operations
+  virtual void BuildLocator(const vtkIdType *cellOffsets)
+    {
+      // Place each cell in the bins its bounding box overlaps
+      MapCells mapper(this, cellOffsets);
+      vtkSMPTools::For(0, this->NumCells, mapper);
+
+      // Now gather the cells into contiguous runs in bins
+      vtkSMPTools::RadixSort(this->Map, this->Map + this->NumFragments,
+                             &CellFragment<TIds>::BinId);
+
+      // Build the offsets into the Map, one more than the number of bins to
+      // simplify traversal.
+      MapOffsets offMapper(this);
+      vtkSMPTools::For(0, this->NumBins + 1, offMapper);
+    }
+};
+
+//-----------------------------------------------------------------------------
+template <typename TIds> vtkIdType CellBinner<TIds>::
+FindCell(double x[3], double tol2, vtkGenericCell *cell, double pcoords[3],
+         double *weights)
+{
+  const double tol = sqrt(tol2);
+  if (!InsideBounds(x, this->Bounds, tol))
+    {
+    return -1;
+    }
+
+  // Search the bin the point is in. Cells of neighbor bins may be within the
+  // tolerance but do not contain the point.
+  vtkIdType binId = this->GetBinIndex(x);
+  const CellFragment<TIds> *ids = this->GetFragments(binId);
+  const vtkIdType numIds = this->GetNumberOfIds(binId);
+  vtkIdType closest = -1;
+  double minDist2 = VTK_DOUBLE_MAX;
+  double closestPoint[3], dist2;
+  int subId;
+  for (vtkIdType i = 0; i < numIds; ++i)
+    {
+    vtkIdType cellId = ids[i].CellId;
+    if (!InsideBounds(x, this->CellBounds[cellId], tol))
+      {
+      continue;
+      }
+    this->DataSet->GetCell(cellId, cell);
+    int inside = cell->EvaluatePosition(x, closestPoint, subId, pcoords,
+                                        dist2, weights);
+    if (inside == 1)
+      {
+      return cellId;
+      }
+    if (inside == 0 && dist2 <= tol2 && dist2 < minDist2)
+      {
+      closest = cellId;
+      minDist2 = dist2;
+      }
+    }
+
+  // No cell contains the point, return the closest one within tolerance.
+  if (closest >= 0)
+    {
+    this->DataSet->GetCell(closest, cell);
+    cell->EvaluatePosition(x, closestPoint, subId, pcoords, dist2, weights);
+    }
+  return closest;
+}
+
+//-----------------------------------------------------------------------------
+template <typename TIds> int CellBinner<TIds>::
+IntersectWithLine(double p1[3], double p2[3], double tol, double& t,
+                  double x[3], double pcoords[3], int &subId,
+                  vtkIdType &cellId, vtkGenericCell *cell)
+{
+  cellId = -1;
+  LineWalk walk;
+  if (!this->StartLine(p1, p2, walk))
+    {
+    return 0;
+    }
+
+  double d[3] = { p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2] };
+  double tHit, xHit[3], pcHit[3];
+  int subHit;
+  vtkIdType loaded = -1;
+  t = VTK_DOUBLE_MAX;
+  do
+    {
+    vtkIdType binId = this->GetBinIndex(walk);
+    const CellFragment<TIds> *ids = this->GetFragments(binId);
+    const vtkIdType numIds = this->GetNumberOfIds(binId);
+    for (vtkIdType i = 0; i < numIds; ++i)
+      {
+      vtkIdType id = ids[i].CellId;
+      if (id == cellId)
+        {
+        continue;
+        }
+      // Skip the cells whose bounds the segment misses, or only meets
+      // beyond the current hit.
+      double b[6], t0 = 0.0, t1 = 1.0;
+      const double *cb = this->CellBounds[id];
+      for (int j = 0; j < 6; j += 2)
+        {
+        b[j] = cb[j] - tol;
+        b[j+1] = cb[j+1] + tol;
+        }
+      if (!ClipSegment(b, p1, d, t0, t1) || t0 > t)
+        {
+        continue;
+        }
+      this->DataSet->GetCell(id, cell);
+      loaded = id;
+      if (cell->IntersectWithLine(p1, p2, tol, tHit, xHit, pcHit, subHit) &&
+          tHit < t)
+        {
+        t = tHit;
+        cellId = id;
+        subId = subHit;
+        for (int j = 0; j < 3; ++j)
+          {
+          x[j] = xHit[j];
+          pcoords[j] = pcHit[j];
+          }
+        }
+      }
+    // The hits beyond this bin are farther than a hit within it.
+    if (cellId >= 0 && t <= BinExit(walk))
+      {
+      break;
+      }
+    }
+  while (this->NextBin(walk));
+
+  if (cellId < 0)
+    {
+    return 0;
+    }
+  if (loaded != cellId)
+    {
+    this->DataSet->GetCell(cellId, cell);
+    }
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+template <typename TIds> void CellBinner<TIds>::
+FindCellsWithinBounds(double *bbox, vtkIdList *cells)
+{
+  cells->Reset();
+  if (bbox[1] < this->Bounds[0] || bbox[0] > this->Bounds[1] ||
+      bbox[3] < this->Bounds[2] || bbox[2] > this->Bounds[3] ||
+      bbox[5] < this->Bounds[4] || bbox[4] > this->Bounds[5])
+    {
+    return;
+    }
+
+  int ijkMin[3], ijkMax[3];
+  double x[3];
+  x[0] = bbox[0]; x[1] = bbox[2]; x[2] = bbox[4];
+  this->GetBinIndices(x, ijkMin);
+  x[0] = bbox[1]; x[1] = bbox[3]; x[2] = bbox[5];
+  this->GetBinIndices(x, ijkMax);
+
+  std::vector<vtkIdType> found;
+  for (int k = ijkMin[2]; k <= ijkMax[2]; ++k)
+    {
+    for (int j = ijkMin[1]; j <= ijkMax[1]; ++j)
+      {
+      for (int i = ijkMin[0]; i <= ijkMax[0]; ++i)
+        {
+        vtkIdType binId = i + j*this->xD + k*this->xyD;
+        const CellFragment<TIds> *ids = this->GetFragments(binId);
+        const vtkIdType numIds = this->GetNumberOfIds(binId);
+        for (vtkIdType c = 0; c < numIds; ++c)
+          {
+          const double *b = this->CellBounds[ids[c].CellId];
+          if (b[0] <= bbox[1] && b[1] >= bbox[0] &&
+              b[2] <= bbox[3] && b[3] >= bbox[2] &&
+              b[4] <= bbox[5] && b[5] >= bbox[4])
+            {
+            found.push_back(ids[c].CellId);
+            }
+          }
+        }
+      }
+    }
+
+  std::sort(found.begin(), found.end());
+  found.erase(std::unique(found.begin(), found.end()), found.end());
+  cells->SetNumberOfIds(static_cast<vtkIdType>(found.size()));
+  std::copy(found.begin(), found.end(), cells->GetPointer(0));
+}
+
+//-----------------------------------------------------------------------------
+template <typename TIds> void CellBinner<TIds>::
+FindCellsAlongLine(double p1[3], double p2[3], vtkIdList *cells)
+{
+  cells->Reset();
+  LineWalk walk;
+  if (!this->StartLine(p1, p2, walk))
+    {
+    return;
+    }
+
+  std::vector<vtkIdType> found;
+  do
+    {
+    vtkIdType binId = this->GetBinIndex(walk);
+    const CellFragment<TIds> *ids = this->GetFragments(binId);
+    const vtkIdType numIds = this->GetNumberOfIds(binId);
+    for (vtkIdType c = 0; c < numIds; ++c)
+      {
+      found.push_back(ids[c].CellId);
+      }
+    }
+  while (this->NextBin(walk));
+
+  std::sort(found.begin(), found.end());
+  found.erase(std::unique(found.begin(), found.end()), found.end());
+  cells->SetNumberOfIds(static_cast<vtkIdType>(found.size()));
+  std::copy(found.begin(), found.end(), cells->GetPointer(0));
+}
+
+//-----------------------------------------------------------------------------
+template <typename TIds> void CellBinner<TIds>::
+SearchBin(vtkIdType binId, ClosestPointSearch &search)
+{
+  const CellFragment<TIds> *ids = this->GetFragments(binId);
+  const vtkIdType numIds = this->GetNumberOfIds(binId);
+  double point[3], pcoords[3], dist2;
+  int subId;
+  for (vtkIdType i = 0; i < numIds; ++i)
+    {
+    vtkIdType id = ids[i].CellId;
+    const double *b = this->CellBounds[id];
+    if (id == search.CellId || b[0] > b[1] ||
+        Distance2ToBounds(search.X, b) > search.MinDist2)
+      {
+      continue;
+      }
+    this->DataSet->GetCell(id, search.Cell);
+    search.Loaded = id;
+    size_t numPts = static_cast<size_t>(search.Cell->GetNumberOfPoints());
+    if (search.Weights.size() < numPts)
+      {
+      search.Weights.resize(numPts);
+      }
+    int inside = search.Cell->EvaluatePosition(
+      const_cast<double*>(search.X), point, subId, pcoords, dist2,
+      &search.Weights[0]);
+    if (inside != -1 && (dist2 < search.MinDist2 ||
+                         (search.CellId < 0 && dist2 <= search.MinDist2)))
+      {
+      search.MinDist2 = dist2;
+      search.CellId = id;
+      search.SubId = subId;
+      search.Inside = inside;
+      for (int j = 0; j < 3; ++j)
+        {
+        search.ClosestPoint[j] = point[j];
+        }
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// The bins are searched in shells of increasing size around the bin of x.
+// The search stops when the closest cell found is closer than all the bins
+// outside the shells searched so far: the cells in these bins, and no
+// others, may still be closer.
+template <typename TIds> vtkIdType CellBinner<TIds>::
+FindClosestPointWithinRadius(double x[3], double radius,
+                             double closestPoint[3], vtkGenericCell *cell,
+                             vtkIdType &cellId, int &subId, double &dist2,
+                             int &inside)
+{
+  ClosestPointSearch search;
+  search.X = x;
+  search.Cell = cell;
+  search.Weights.resize(VTK_CELL_SIZE);
+  search.MinDist2 = radius * radius;
+  search.CellId = -1;
+  search.Loaded = -1;
+  search.SubId = 0;
+  search.Inside = 0;
+
+  int ijk[3];
+  this->GetBinIndices(x, ijk);
+  for (int level = 0; ; ++level)
+    {
+    int lo[3], hi[3];
+    for (int i = 0; i < 3; ++i)
+      {
+      lo[i] = std::max(ijk[i] - level, 0);
+      hi[i] = std::min(ijk[i] + level, this->Divisions[i] - 1);
+      }
+
+    // Visit the bins at this level: all of them on the faces of the shell
+    // in k or j, and otherwise only the two ends of the rows in i.
+    for (int k = lo[2]; k <= hi[2]; ++k)
+      {
+      for (int j = lo[1]; j <= hi[1]; ++j)
+        {
+        vtkIdType row = j * this->xD + k * this->xyD;
+        if (std::abs(k - ijk[2]) == level || std::abs(j - ijk[1]) == level)
+          {
+          for (int i = lo[0]; i <= hi[0]; ++i)
+            {
+            this->SearchBin(row + i, search);
+            }
+          }
+        else
+          {
+          if (ijk[0] - level >= 0)
+            {
+            this->SearchBin(row + ijk[0] - level, search);
+            }
+          if (ijk[0] + level < this->Divisions[0])
+            {
+            this->SearchBin(row + ijk[0] + level, search);
+            }
+          }
+        }
+      }
+
+    // Bound the distance to the bins that are still to be searched.
+    double outside2 = VTK_DOUBLE_MAX;
+    for (int i = 0; i < 3; ++i)
+      {
+      if (lo[i] > 0)
+        {
+        double d = std::max(x[i] - (this->Bounds[2*i] + lo[i] * this->H[i]),
+                            0.0);
+        outside2 = std::min(outside2, d * d);
+        }
+      if (hi[i] < this->Divisions[i] - 1)
+        {
+        double d = std::max(
+          this->Bounds[2*i] + (hi[i] + 1) * this->H[i] - x[i], 0.0);
+        outside2 = std::min(outside2, d * d);
+        }
+      }
+    if (outside2 == VTK_DOUBLE_MAX || search.MinDist2 <= outside2)
+      {
+      break;
+      }
+    }
+
+  cellId = search.CellId;
+  if (cellId < 0)
+    {
+    return 0;
+    }
+  if (search.Loaded != cellId)
+    {
+    this->DataSet->GetCell(cellId, cell);
+    }
+  subId = search.SubId;
+  dist2 = search.MinDist2;
+  inside = search.Inside;
+  for (int i = 0; i < 3; ++i)
+    {
+    closestPoint[i] = search.ClosestPoint[i];
+    }
+  return 1;
+}
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Count the bins overlapped by each cell.
+class CountCellBins
+{
+public:
+  const vtkCellBinner *Binner;
+  vtkIdType *Counts;
+
+  CountCellBins(const vtkCellBinner *binner, vtkIdType *counts) :
+    Binner(binner), Counts(counts)
+    {
+    }
+
+  void operator()(vtkIdType cellId, vtkIdType end)
+    {
+    int ijkMin[3], ijkMax[3];
+    for ( ; cellId < end; ++cellId )
+      {
+      this->Counts[cellId] =
+        this->Binner->GetCellBins(cellId, ijkMin, ijkMax) ?
+        static_cast<vtkIdType>(ijkMax[0] - ijkMin[0] + 1) *
+        (ijkMax[1] - ijkMin[1] + 1) * (ijkMax[2] - ijkMin[2] + 1) : 0;
+      }
+    }
+};
+
+//-----------------------------------------------------------------------------
+// A binner that only counts the bins of the cells, used before the size of
+// the fragment ids is known.
+class CountingBinner : public vtkCellBinner
+{
+public:
+  CountingBinner(vtkStaticCellLocator *loc, vtkIdType numCells,
+                 vtkIdType numBins) : vtkCellBinner(loc, numCells, numBins)
+    {
+    }
+  virtual void BuildLocator(const vtkIdType *) {}
+  virtual vtkIdType GetNumberOfIds(vtkIdType) { return 0; }
+  virtual void GetIds(vtkIdType, vtkIdList *) {}
+  virtual vtkIdType FindCell(double *, double, vtkGenericCell *, double *,
+                             double *) { return -1; }
+  virtual int IntersectWithLine(double *, double *, double, double&,
+                                double *, double *, int &, vtkIdType &,
+                                vtkGenericCell *) { return 0; }
+  virtual void FindCellsWithinBounds(double *, vtkIdList *) {}
+  virtual void FindCellsAlongLine(double *, double *, vtkIdList *) {}
+  virtual vtkIdType FindClosestPointWithinRadius(double *, double, double *,
+                                                 vtkGenericCell *,
+                                                 vtkIdType &, int &,
+                                                 double &, int &)
+    { return 0; }
+};
+}
+
+//-----------------------------------------------------------------------------
+// Construct with automatic computation of divisions, averaging
+// 10 cells per bin.
+vtkStaticCellLocator::vtkStaticCellLocator()
+{
+  this->NumberOfCellsPerNode = 10;
+  this->Divisions[0] = this->Divisions[1] = this->Divisions[2] = 50;
+  this->H[0] = this->H[1] = this->H[2] = 0.0;
+  this->Bounds[0] = this->Bounds[2] = this->Bounds[4] = 0.0;
+  this->Bounds[1] = this->Bounds[3] = this->Bounds[5] = 1.0;
+  this->Binner = NULL;
+}
+
+//-----------------------------------------------------------------------------
+vtkStaticCellLocator::~vtkStaticCellLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::Initialize()
+{
+  this->FreeSearchStructure();
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::FreeSearchStructure()
+{
+  if ( this->Binner )
+    {
+    delete this->Binner;
+    this->Binner = NULL;
+    }
+  this->FreeCellBounds();
+}
+
+//-----------------------------------------------------------------------------
+//  Method to form subdivision of space based on the cells provided and
+//  subject to the constraints of NumberOfCellsPerNode. The result is
+//  directly addressable and of uniform subdivision.
+//
+void vtkStaticCellLocator::BuildLocator()
+{
+  vtkIdType numCells;
+  int ndivs[3];
+  int i;
+
+  if ( (this->Binner != NULL) && (this->UseExistingSearchStructure ||
+       ((this->BuildTime > this->MTime)
+        && (this->BuildTime > this->DataSet->GetMTime()))) )
+    {
+    return;
+    }
+
+  vtkDebugMacro( << "Binning cells..." );
+  this->Level = 1; //only single lowest level - from superclass
+
+  if ( !this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1 )
+    {
+    vtkErrorMacro( << "No cells to locate");
+    return;
+    }
+
+  //  Make sure the appropriate data is available
+  //
+  this->FreeSearchStructure();
+
+  //  Size the root bin. The bins are shaped after the bounds: the widths of
+  //  the bins are about the same in all directions, and the directions in
+  //  which the data set is flat are not divided.
+  //
+  double *bounds = this->DataSet->GetBounds();
+  double width[3], volume = 1.0;
+  int numDims = 0;
+  for (i=0; i<3; i++)
+    {
+    this->Bounds[2*i] = bounds[2*i];
+    this->Bounds[2*i+1] = bounds[2*i+1];
+    width[i] = this->Bounds[2*i+1] - this->Bounds[2*i];
+    if ( width[i] > 0.0 )
+      {
+      volume *= width[i];
+      numDims++;
+      }
+    else //prevent zero width
+      {
+      width[i] = 0.0;
+      this->Bounds[2*i+1] = this->Bounds[2*i] + 1.0;
+      }
+    }
+
+  if ( this->Automatic )
+    {
+    double numBins = static_cast<double>(numCells) /
+      this->NumberOfCellsPerNode;
+    numBins = (numBins < 1.0 ? 1.0 : numBins);
+    double h = (numDims > 0 ?
+                pow(volume / numBins, 1.0 / numDims) : 1.0);
+    for (i=0; i<3; i++)
+      {
+      ndivs[i] = (width[i] > 0.0 ?
+                  static_cast<int>(ceil(width[i] / h - 1.0e-6)) : 1);
+      }
+    }
+  else
+    {
+    for (i=0; i<3; i++)
+      {
+      ndivs[i] = static_cast<int>(this->Divisions[i]);
+      }
+    }
+
+  // Clamp the i-j-k coords withing allowable range. We clamp the upper range
+  // because we want the total number of bins to lie within an "int" value.
+  for (i=0; i<3; i++)
+    {
+    ndivs[i] = (ndivs[i] < 1 ? 1 : (ndivs[i] <= 1290 ? ndivs[i] : 1290));
+    this->Divisions[i] = ndivs[i];
+    }
+  vtkIdType numBins = static_cast<vtkIdType>(ndivs[0]) * ndivs[1] * ndivs[2];
+
+  //  Compute width of bin in three directions
+  //
+  for (i=0; i<3; i++)
+    {
+    this->H[i] = (this->Bounds[2*i+1] - this->Bounds[2*i]) / ndivs[i] ;
+    }
+
+  // The data set methods used in parallel are thread safe once they have
+  // been called from a single thread.
+  vtkIdList *ids = vtkIdList::New();
+  this->DataSet->GetCellPoints(0, ids);
+  ids->Delete();
+  double x[3];
+  this->DataSet->GetPoint(0, x);
+  this->DataSet->GetCell(0, this->GenericCell);
+
+  // Compute the bounds of the cells and count their bins
+  //
+  this->CellBounds = new double[numCells][6];
+  ComputeCellBounds boundsComputer(this->DataSet, this->CellBounds);
+  vtkSMPTools::For(0, numCells, boundsComputer);
+
+  std::vector<vtkIdType> cellOffsets(numCells);
+  CountingBinner counter(this, numCells, numBins);
+  CountCellBins countBins(&counter, &cellOffsets[0]);
+  vtkSMPTools::For(0, numCells, countBins);
+  vtkIdType numFragments = vtkSMPTools::ExclusiveScan(
+    cellOffsets.begin(), cellOffsets.end(), cellOffsets.begin(),
+    static_cast<vtkIdType>(0));
+
+  // Instantiate the locator. The type is related to the maximun cell id and
+  // number of fragments. This is done for performance (e.g., the sort is
+  // faster) and significant memory savings.
+  //
+  if ( numCells >= VTK_INT_MAX || numFragments >= VTK_INT_MAX )
+    {
+    this->Binner = new CellBinner<vtkIdType>(this, numCells, numBins,
+                                             numFragments);
+    }
+  else
+    {
+    this->Binner = new CellBinner<int>(this, numCells, numBins,
+                                       numFragments);
+    }
+
+  // Actually construct the locator
+  this->Binner->BuildLocator(&cellOffsets[0]);
+
+  this->BuildTime.Modified();
+}
+
+//-----------------------------------------------------------------------------
+// These methods satisfy the vtkAbstractCellLocator API. The implementation is
+// with the templated CellBinner class.
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkStaticCellLocator::
+FindCell(double x[3], double tol2, vtkGenericCell *cell, double pcoords[3],
+         double *weights)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Binner )
+    {
+    return -1;
+    }
+  return this->Binner->FindCell(x, tol2, cell, pcoords, weights);
+}
+
+//-----------------------------------------------------------------------------
+int vtkStaticCellLocator::
+IntersectWithLine(double p1[3], double p2[3], double tol, double& t,
+                  double x[3], double pcoords[3], int &subId,
+                  vtkIdType &cellId, vtkGenericCell *cell)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Binner )
+    {
+    cellId = -1;
+    return 0;
+    }
+  return this->Binner->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId,
+                                         cellId, cell);
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::
+FindCellsWithinBounds(double *bbox, vtkIdList *cells)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Binner )
+    {
+    cells->Reset();
+    return;
+    }
+  this->Binner->FindCellsWithinBounds(bbox, cells);
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::
+FindCellsAlongLine(double p1[3], double p2[3], double vtkNotUsed(tolerance),
+                   vtkIdList *cells)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Binner )
+    {
+    cells->Reset();
+    return;
+    }
+  this->Binner->FindCellsAlongLine(p1, p2, cells);
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::
+FindClosestPoint(double x[3], double closestPoint[3], vtkGenericCell *cell,
+                 vtkIdType &cellId, int &subId, double& dist2)
+{
+  int inside;
+  this->FindClosestPointWithinRadius(x, VTK_DOUBLE_MAX, closestPoint, cell,
+                                     cellId, subId, dist2, inside);
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkStaticCellLocator::
+FindClosestPointWithinRadius(double x[3], double radius,
+                             double closestPoint[3], vtkGenericCell *cell,
+                             vtkIdType &cellId, int &subId, double& dist2,
+                             int &inside)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Binner )
+    {
+    cellId = -1;
+    return 0;
+    }
+  return this->Binner->FindClosestPointWithinRadius(
+    x, radius, closestPoint, cell, cellId, subId, dist2, inside);
+}
+
+//-----------------------------------------------------------------------------
+bool vtkStaticCellLocator::InsideCellBounds(double x[3], vtkIdType cellId)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->CellBounds )
+    {
+    return this->Superclass::InsideCellBounds(x, cellId);
+    }
+  return InsideBounds(x, this->CellBounds[cellId], 0.0);
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::
+GenerateRepresentation(int vtkNotUsed(level), vtkPolyData *pd)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Binner )
+    {
+    return;
+    }
+  this->Binner->GenerateRepresentation(pd);
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkStaticCellLocator::GetNumberOfBins()
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  return ( this->Binner ? this->Binner->NumBins : 0 );
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkStaticCellLocator::GetNumberOfCellsInBin(vtkIdType bNum)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  return ( this->Binner ? this->Binner->GetNumberOfIds(bNum) : 0 );
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::GetBinCellIds(vtkIdType bNum, vtkIdList *cells)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Binner )
+    {
+    cells->Reset();
+    return;
+    }
+  this->Binner->GetIds(bNum, cells);
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Divisions: (" << this->Divisions[0] << ", "
+     << this->Divisions[1] << ", " << this->Divisions[2] << ")\n";
+  os << indent << "Bounds: (" << this->Bounds[0] << ", "
+     << this->Bounds[1] << ", " << this->Bounds[2] << ", "
+     << this->Bounds[3] << ", " << this->Bounds[4] << ", "
+     << this->Bounds[5] << ")\n";
+}
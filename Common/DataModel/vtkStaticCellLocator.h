@@ -0,0 +1,169 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticCellLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStaticCellLocator - quickly locate cells in 3-space
+// .SECTION Description
+// vtkStaticCellLocator is a spatial search object to quickly locate cells
+// in 3D. It divides the bounds of the data set into a regular array of
+// cuboid bins, and keeps the list of the cells whose bounding box
+// overlaps each bin. Typical operations are finding the cell that contains
+// a point and intersecting a line with the cells.
+//
+// vtkStaticCellLocator is the cell counterpart of vtkStaticPointLocator.
+// It is built in parallel (via vtkSMPTools) and supports one-time static
+// construction only: the locator is rebuilt from scratch when the data set
+// is modified. The bins are sized from the average number of cells per bin
+// (NumberOfCellsPerNode) and shaped after the bounds of the data set, so
+// that flat data sets are not refined along their thin direction.
+//
+// .SECTION Caveats
+// Once BuildLocator() has been called from a single thread, FindCell(),
+// IntersectWithLine(), FindCellsWithinBounds(), FindCellsAlongLine(),
+// FindClosestPoint() and FindClosestPointWithinRadius() may be called
+// concurrently, as long as each thread provides its own vtkGenericCell,
+// weights and id list. The signatures that do not take a vtkGenericCell
+// use an internal one and are not thread safe.
+//
+// .SECTION See Also
+// vtkStaticPointLocator vtkCellLocator vtkCellTreeLocator
+// vtkAbstractCellLocator
+
+#ifndef vtkStaticCellLocator_h
+#define vtkStaticCellLocator_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkAbstractCellLocator.h"
+
+class vtkCellBinner;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkStaticCellLocator : public vtkAbstractCellLocator
+{
+friend class vtkCellBinner;
+public:
+  // Description:
+  // Construct with automatic computation of divisions, averaging
+  // 10 cells per bin.
+  static vtkStaticCellLocator *New();
+
+  // Description:
+  // Standard type and print methods.
+  vtkTypeMacro(vtkStaticCellLocator,vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set the number of divisions in x-y-z directions. If the Automatic data
+  // member is enabled, the Divisions are set according to the
+  // NumberOfCellsPerNode data member.
+  vtkSetVector3Macro(Divisions,int);
+  vtkGetVectorMacro(Divisions,int,3);
+
+  // Re-use any superclass signatures that we don't override.
+  using vtkAbstractCellLocator::IntersectWithLine;
+  using vtkAbstractCellLocator::FindClosestPoint;
+  using vtkAbstractCellLocator::FindClosestPointWithinRadius;
+  using vtkAbstractCellLocator::FindCell;
+
+  // Description:
+  // Find the cell containing x, or if there is none, the closest cell
+  // whose distance to x is at most sqrt(tol2). Returns -1 if no cell is
+  // found. The cell, parametric coordinates and weights are those of the
+  // returned cell. Thread safe once BuildLocator() has been called.
+  virtual vtkIdType FindCell(double x[3], double tol2, vtkGenericCell *cell,
+                             double pcoords[3], double *weights);
+
+  // Description:
+  // Return the intersection of the finite line (p1,p2) with the cells that
+  // is closest to p1, and the cell that was intersected. Returns 0 if the
+  // line intersects no cell. Thread safe once BuildLocator() has been
+  // called.
+  virtual int IntersectWithLine(double p1[3], double p2[3], double tol,
+                                double& t, double x[3], double pcoords[3],
+                                int &subId, vtkIdType &cellId,
+                                vtkGenericCell *cell);
+
+  // Description:
+  // Return the unique ids of the cells whose bounding box overlaps the
+  // given bounding box. Thread safe once BuildLocator() has been called.
+  virtual void FindCellsWithinBounds(double *bbox, vtkIdList *cells);
+
+  // Description:
+  // Return the unique ids of the cells in the bins crossed by the finite
+  // line (p1,p2). Thread safe once BuildLocator() has been called.
+  virtual void FindCellsAlongLine(double p1[3], double p2[3],
+                                  double tolerance, vtkIdList *cells);
+
+  // Description:
+  // Return the closest point to x on the cells, with the id of the cell
+  // holding it, its sub id and its squared distance to x. The bins are
+  // searched outwards from the bin of x until no unsearched bin can hold a
+  // closer cell. Thread safe once BuildLocator() has been called.
+  virtual void FindClosestPoint(double x[3], double closestPoint[3],
+                                vtkGenericCell *cell, vtkIdType &cellId,
+                                int &subId, double& dist2);
+
+  // Description:
+  // Same as FindClosestPoint(), restricted to the cells within radius of
+  // x. Returns 0, with cellId set to -1, if there is none. inside is set
+  // when x is inside the returned cell. Thread safe once BuildLocator()
+  // has been called.
+  virtual vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                                 double closestPoint[3],
+                                                 vtkGenericCell *cell,
+                                                 vtkIdType &cellId,
+                                                 int &subId, double& dist2,
+                                                 int &inside);
+
+  // Description:
+  // Quickly test if a point is inside the bounds of a cell, using the cell
+  // bounds computed by BuildLocator().
+  virtual bool InsideCellBounds(double x[3], vtkIdType cellId);
+
+  // Description:
+  // See vtkLocator and vtkAbstractCellLocator interface documentation.
+  // These methods are not thread safe.
+  virtual void Initialize();
+  virtual void FreeSearchStructure();
+  virtual void BuildLocator();
+  virtual void GenerateRepresentation(int level, vtkPolyData *pd);
+
+  // Description:
+  // Return the number of bins of the locator.
+  vtkIdType GetNumberOfBins();
+
+  // Description:
+  // Given a bin number bNum between 0 <= bNum < this->GetNumberOfBins(),
+  // return the number of cells that overlap the bin.
+  vtkIdType GetNumberOfCellsInBin(vtkIdType bNum);
+
+  // Description:
+  // Given a bin number bNum between 0 <= bNum < this->GetNumberOfBins(),
+  // return the ids of the cells that overlap the bin. The user must
+  // provide an instance of vtkIdList to contain the result.
+  void GetBinCellIds(vtkIdType bNum, vtkIdList *cells);
+
+protected:
+  vtkStaticCellLocator();
+  virtual ~vtkStaticCellLocator();
+
+  double Bounds[6]; // Bounding box of the whole dataset
+  int Divisions[3]; // Number of sub-divisions in x-y-z directions
+  double H[3]; // Width of each bin in x-y-z directions
+  vtkCellBinner *Binner; // Lists of cell ids in each bin
+
+private:
+  vtkStaticCellLocator(const vtkStaticCellLocator&);  // Not implemented.
+  void operator=(const vtkStaticCellLocator&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,224 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticEdgeLocatorTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStaticEdgeLocatorTemplate - group duplicate edges given as
+// pairs of point ids (template implementation)
+
+// .SECTION Description
+// vtkStaticEdgeLocatorTemplate takes a list of edges, each defined by two
+// point ids and carrying some data (for example the id of the cell that
+// produced it), and groups the equal edges together. It is a static
+// replacement for vtkEdgeTable: instead of inserting the edges one at a
+// time, all the edges are generated first (typically in parallel, one
+// chunk of cells per thread) and then sorted with vtkSMPTools::RadixSort
+// so that the edges with the same end points are contiguous. The sort is
+// stable, so the duplicates of an edge stay in the order in which they
+// were given, and the first one of each group is the first occurrence of
+// the edge.
+//
+// The edges are sorted on their smallest point id, then on their largest
+// point id. Each group of equal edges can then be accessed with
+// GetNumberOfEdges(), GetEdgeOffsets() and GetEdges(), and an edge can be
+// looked up with IsInsertedEdge().
+
+// .SECTION See Also
+// vtkEdgeTable vtkStaticCellLinksTemplate vtkSMPTools
+
+#ifndef vtkStaticEdgeLocatorTemplate_h
+#define vtkStaticEdgeLocatorTemplate_h
+
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+// Description:
+// An edge with the point ids V0 <= V1 and some associated data.
+template <typename TId, typename TData>
+struct vtkEdgeTuple
+{
+  TId V0;
+  TId V1;
+  TData Data;
+
+  vtkEdgeTuple() {}
+  vtkEdgeTuple(TId v0, TId v1, TData data) : V0(v0), V1(v1), Data(data)
+  {
+    if (this->V0 > this->V1)
+      {
+      std::swap(this->V0, this->V1);
+      }
+  }
+
+  bool operator==(const vtkEdgeTuple &e) const
+  {
+    return this->V0 == e.V0 && this->V1 == e.V1;
+  }
+
+  bool operator<(const vtkEdgeTuple &e) const
+  {
+    return this->V0 < e.V0 || (this->V0 == e.V0 && this->V1 < e.V1);
+  }
+};
+
+template <typename TId, typename TData>
+class vtkStaticEdgeLocatorTemplate
+{
+public:
+  typedef vtkEdgeTuple<TId, TData> EdgeTupleType;
+
+  // Description:
+  // Construct an empty locator. MergeEdges() does the work.
+  vtkStaticEdgeLocatorTemplate() : NumEdges(0), Edges(NULL) {}
+
+  // Description:
+  // Sort the numEdges edges in place so that equal edges are contiguous,
+  // and find the groups of equal edges. The edges must stay alive while
+  // the locator is used. Return the number of distinct edges.
+  vtkIdType MergeEdges(vtkIdType numEdges, EdgeTupleType *edges);
+
+  // Description:
+  // Return the number of distinct edges found by MergeEdges().
+  vtkIdType GetNumberOfEdges() const
+  {
+    return static_cast<vtkIdType>(this->EdgeOffsets.size()) - 1;
+  }
+
+  // Description:
+  // Return the offsets of the groups of equal edges into the sorted
+  // edges: the i-th distinct edge is duplicated over the sorted edges
+  // [offsets[i], offsets[i+1]). There are GetNumberOfEdges()+1 offsets.
+  const vtkIdType *GetEdgeOffsets() const
+  {
+    return &this->EdgeOffsets[0];
+  }
+
+  // Description:
+  // Return the sorted edges.
+  const EdgeTupleType *GetEdges() const
+  {
+    return this->Edges;
+  }
+
+  // Description:
+  // Return the index of the distinct edge (v0,v1), in either order, or -1
+  // if it was not given to MergeEdges().
+  vtkIdType IsInsertedEdge(TId v0, TId v1) const;
+
+private:
+  vtkIdType NumEdges;
+  EdgeTupleType *Edges;
+  std::vector<vtkIdType> EdgeOffsets;
+
+  // Marks the sorted edges which start a group of equal edges.
+  class MarkFirstEdges
+  {
+  public:
+    const EdgeTupleType *Edges;
+    vtkIdType *First;
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+        {
+        this->First[i] = (i == 0 || !(this->Edges[i] == this->Edges[i-1]));
+        }
+    }
+  };
+
+  // Records the start of each group from the scanned marks.
+  class RecordOffsets
+  {
+  public:
+    const EdgeTupleType *Edges;
+    const vtkIdType *GroupIds;
+    vtkIdType *Offsets;
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+        {
+        if (i == 0 || !(this->Edges[i] == this->Edges[i-1]))
+          {
+          this->Offsets[this->GroupIds[i]] = i;
+          }
+        }
+    }
+  };
+};
+
+//----------------------------------------------------------------------------
+template <typename TId, typename TData>
+vtkIdType vtkStaticEdgeLocatorTemplate<TId, TData>::
+MergeEdges(vtkIdType numEdges, EdgeTupleType *edges)
+{
+  this->NumEdges = numEdges;
+  this->Edges = edges;
+  this->EdgeOffsets.assign(1, 0);
+  if (numEdges < 1)
+    {
+    return 0;
+    }
+
+  // Two stable passes sort the edges on (V0,V1) and keep the duplicates in
+  // their original order.
+  vtkSMPTools::RadixSort(edges, edges + numEdges, &EdgeTupleType::V1);
+  vtkSMPTools::RadixSort(edges, edges + numEdges, &EdgeTupleType::V0);
+
+  std::vector<vtkIdType> groupIds(numEdges);
+  MarkFirstEdges mark;
+  mark.Edges = edges;
+  mark.First = &groupIds[0];
+  vtkSMPTools::For(0, numEdges, mark);
+  vtkIdType numGroups = vtkSMPTools::ExclusiveScan(
+    groupIds.begin(), groupIds.end(), groupIds.begin(), vtkIdType(0));
+
+  this->EdgeOffsets.resize(numGroups + 1);
+  RecordOffsets offsets;
+  offsets.Edges = edges;
+  offsets.GroupIds = &groupIds[0];
+  offsets.Offsets = &this->EdgeOffsets[0];
+  vtkSMPTools::For(0, numEdges, offsets);
+  this->EdgeOffsets[numGroups] = numEdges;
+
+  return numGroups;
+}
+
+//----------------------------------------------------------------------------
+template <typename TId, typename TData>
+vtkIdType vtkStaticEdgeLocatorTemplate<TId, TData>::
+IsInsertedEdge(TId v0, TId v1) const
+{
+  if (this->NumEdges < 1)
+    {
+    return -1;
+    }
+  EdgeTupleType key(v0, v1, TData());
+  const EdgeTupleType *begin = this->Edges;
+  const EdgeTupleType *end = begin + this->NumEdges;
+  const EdgeTupleType *edge = std::lower_bound(begin, end, key);
+  if (edge == end || !(*edge == key))
+    {
+    return -1;
+    }
+
+  // Find the group starting at this edge.
+  vtkIdType offset = static_cast<vtkIdType>(edge - this->Edges);
+  return static_cast<vtkIdType>(
+    std::lower_bound(this->EdgeOffsets.begin(), this->EdgeOffsets.end(),
+                     offset) - this->EdgeOffsets.begin());
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkStaticEdgeLocatorTemplate.h
@@ -16,13 +16,19 @@
 
 #include "vtkCellArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkStaticPointLocator);
 
 // There are stack-allocated bucket neighbor lists. This is the initial
@@ -36,9 +42,9 @@ static const int VTK_INITIAL_BUCKET_SIZE=1000;
 // 1) All points are assigned a bucket index (combined i-j-k bucket location).
 // The index is computed in parallel. This requires a one time allocation of an
 // index array (which is also associated with the originating point ids).
-// 2) vtkSMPTools::Sort() is used to sort the index array. Note that the sort
-// carries along the point ids as well. This creates contiguous runs of points
-// all resident in the same bucket.
+// 2) vtkSMPTools::RadixSort() is used to sort the index array on the bucket
+// index. Note that the sort carries along the point ids as well. This creates
+// contiguous runs of points all resident in the same bucket.
 // 3) The bucket offsets are updated to refer to the right entry location into
 // the sorted point ids array. This enables quick access, and an indirect count
 // of the number of points in each bucket.
@@ -480,8 +486,21 @@ public:
                                          double inputDataLength, double& dist2);
   void FindClosestNPoints(int N, const double x[3], vtkIdList *result);
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList *result);
+  template <typename TInserter>
+  void ForPointsWithinRadius(double R, const double x[3], TInserter &inserter);
   void GenerateRepresentation(int vtkNotUsed(level), vtkPolyData *pd);
 
+  // Batched queries
+  void SortQueries(vtkPoints *queries,
+                   std::vector<LocatorTuple<vtkIdType> > &order);
+  void FindClosestPoints(vtkPoints *queries, vtkIdType *closest);
+  void FindClosestNPoints(int N, vtkPoints *queries, vtkIdType *result);
+  void FindPointsWithinRadius(double R, vtkPoints *queries,
+                              vtkIdTypeArray *offsets, vtkIdTypeArray *ids);
+
+  // Point merging
+  void MergePoints(double tol, vtkIdType *mergeMap);
+
   // Internal methods
   void GetOverlappingBuckets(NeighborBuckets* buckets, const double x[3],
                              const int ijk[3], double dist, int level);
@@ -644,7 +663,8 @@ public:
 
       // Now gather the points into contiguous runs in buckets
       //
-      vtkSMPTools::Sort(this->Map, this->Map + this->NumPts);
+      vtkSMPTools::RadixSort(this->Map, this->Map + this->NumPts,
+                             &LocatorTuple<TIds>::Bucket);
 
       // Build the offsets into the Map. The offsets are the positions of
       // each bucket into the sorted list. They mark the beginning of the
@@ -1045,9 +1065,40 @@ FindClosestNPoints(int N, const double x[3], vtkIdList *result)
   delete [] res;
 }
 
+//-----------------------------------------------------------------------------
+namespace
+{
+// Appends the ids found by BucketList::ForPointsWithinRadius() to a list.
+struct IdListInserter
+{
+  vtkIdList *List;
+  IdListInserter(vtkIdList *list) : List(list) {}
+  void operator()(vtkIdType ptId) { this->List->InsertNextId(ptId); }
+};
+
+struct IdVectorInserter
+{
+  std::vector<vtkIdType> &Ids;
+  IdVectorInserter(std::vector<vtkIdType> &ids) : Ids(ids) {}
+  void operator()(vtkIdType ptId) { this->Ids.push_back(ptId); }
+};
+}
+
 //-----------------------------------------------------------------------------
 template <typename TIds> void BucketList<TIds>::
 FindPointsWithinRadius(double R, const double x[3], vtkIdList *result)
+{
+  // Clear out previous results
+  result->Reset();
+
+  IdListInserter inserter(result);
+  this->ForPointsWithinRadius(R, x, inserter);
+}
+
+//-----------------------------------------------------------------------------
+// Pass the ids of the points within radius R of x to inserter.
+template <typename TIds> template <typename TInserter> void BucketList<TIds>::
+ForPointsWithinRadius(double R, const double x[3], TInserter &inserter)
 {
   int i, j;
   double dist2;
@@ -1068,9 +1119,6 @@ FindPointsWithinRadius(double R, const double x[3], vtkIdList *result)
   // add the original bucket
   buckets.InsertNextBucket(ijk);
 
-  // Clear out previous results
-  result->Reset();
-
   // Add points within radius
   for (i=0; i<buckets.GetNumberOfNeighbors(); i++)
     {
@@ -1087,7 +1135,7 @@ FindPointsWithinRadius(double R, const double x[3], vtkIdList *result)
         dist2 = vtkMath::Distance2BetweenPoints(x,pt);
         if (dist2 <= R2)
           {
-          result->InsertNextId(ptId);
+          inserter(ptId);
           }
         }
       }
@@ -1317,6 +1365,387 @@ GenerateRepresentation(int vtkNotUsed(level), vtkPolyData *pd)
 // Here is the VTK class proper. It's implemented with the templated
 // BucketList class.
 
+//-----------------------------------------------------------------------------
+// The following code supports the batched queries. The query points are
+// first sorted on the bucket they fall in, with the same map and sort as the
+// locator itself. The queries are then processed in this order in parallel,
+// so that consecutive queries of a thread visit the same buckets and points.
+namespace
+{
+class MapQueries
+{
+public:
+  const vtkBucketList *BList;
+  vtkPoints *Queries;
+  LocatorTuple<vtkIdType> *Order;
+
+  MapQueries(const vtkBucketList *blist, vtkPoints *queries,
+             LocatorTuple<vtkIdType> *order) :
+    BList(blist), Queries(queries), Order(order)
+    {
+    }
+
+  void operator()(vtkIdType q, vtkIdType end)
+    {
+    double x[3];
+    LocatorTuple<vtkIdType> *t = this->Order + q;
+    for ( ; q < end; ++q, ++t )
+      {
+      this->Queries->GetPoint(q, x);
+      t->PtId = q;
+      t->Bucket = this->BList->GetBucketIndex(x);
+      }
+    }
+};
+
+template <typename TIds>
+class ClosestPointQueries
+{
+public:
+  BucketList<TIds> *BList;
+  vtkPoints *Queries;
+  const LocatorTuple<vtkIdType> *Order;
+  vtkIdType *Closest;
+
+  ClosestPointQueries(BucketList<TIds> *blist, vtkPoints *queries,
+                      const LocatorTuple<vtkIdType> *order,
+                      vtkIdType *closest) :
+    BList(blist), Queries(queries), Order(order), Closest(closest)
+    {
+    }
+
+  void operator()(vtkIdType i, vtkIdType end)
+    {
+    double x[3];
+    for ( ; i < end; ++i )
+      {
+      vtkIdType q = this->Order[i].PtId;
+      this->Queries->GetPoint(q, x);
+      this->Closest[q] = this->BList->FindClosestPoint(x);
+      }
+    }
+};
+
+template <typename TIds>
+class ClosestNPointsQueries
+{
+public:
+  BucketList<TIds> *BList;
+  int N;
+  vtkPoints *Queries;
+  const LocatorTuple<vtkIdType> *Order;
+  vtkIdType *Result;
+  vtkSMPThreadLocalObject<vtkIdList> Lists;
+
+  ClosestNPointsQueries(BucketList<TIds> *blist, int n, vtkPoints *queries,
+                        const LocatorTuple<vtkIdType> *order,
+                        vtkIdType *result) :
+    BList(blist), N(n), Queries(queries), Order(order), Result(result)
+    {
+    }
+
+  void operator()(vtkIdType i, vtkIdType end)
+    {
+    vtkIdList *list = this->Lists.Local();
+    double x[3];
+    for ( ; i < end; ++i )
+      {
+      vtkIdType q = this->Order[i].PtId;
+      this->Queries->GetPoint(q, x);
+      this->BList->FindClosestNPoints(this->N, x, list);
+      vtkIdType *out = this->Result + q*this->N;
+      vtkIdType numIds = list->GetNumberOfIds();
+      std::copy(list->GetPointer(0), list->GetPointer(0) + numIds, out);
+      std::fill(out + numIds, out + this->N, -1);
+      }
+    }
+};
+
+// The points found by a thread, appended in the order of its queries.
+struct RadiusResults
+{
+  std::vector<vtkIdType> Ids;
+  std::vector<vtkIdType> Queries;
+  std::vector<vtkIdType> Starts;
+};
+
+template <typename TIds>
+class RadiusQueries
+{
+public:
+  BucketList<TIds> *BList;
+  double R;
+  vtkPoints *Queries;
+  const LocatorTuple<vtkIdType> *Order;
+  vtkIdType *Counts;
+  vtkSMPThreadLocal<RadiusResults> Results;
+
+  RadiusQueries(BucketList<TIds> *blist, double radius, vtkPoints *queries,
+                const LocatorTuple<vtkIdType> *order, vtkIdType *counts) :
+    BList(blist), R(radius), Queries(queries), Order(order), Counts(counts)
+    {
+    }
+
+  void operator()(vtkIdType i, vtkIdType end)
+    {
+    RadiusResults &results = this->Results.Local();
+    IdVectorInserter inserter(results.Ids);
+    double x[3];
+    for ( ; i < end; ++i )
+      {
+      vtkIdType q = this->Order[i].PtId;
+      vtkIdType start = static_cast<vtkIdType>(results.Ids.size());
+      this->Queries->GetPoint(q, x);
+      this->BList->ForPointsWithinRadius(this->R, x, inserter);
+      this->Counts[q] = static_cast<vtkIdType>(results.Ids.size()) - start;
+      results.Queries.push_back(q);
+      results.Starts.push_back(start);
+      }
+    }
+};
+
+// Copy the points found by each thread to their place in the output.
+class CopyRadiusResults
+{
+public:
+  const std::vector<RadiusResults*> &Results;
+  const vtkIdType *Offsets;
+  vtkIdType *Ids;
+
+  CopyRadiusResults(const std::vector<RadiusResults*> &results,
+                    const vtkIdType *offsets, vtkIdType *ids) :
+    Results(results), Offsets(offsets), Ids(ids)
+    {
+    }
+
+  void operator()(vtkIdType r, vtkIdType end)
+    {
+    for ( ; r < end; ++r )
+      {
+      const RadiusResults *results = this->Results[r];
+      for (size_t i = 0; i < results->Queries.size(); ++i)
+        {
+        vtkIdType q = results->Queries[i];
+        std::vector<vtkIdType>::const_iterator first =
+          results->Ids.begin() + results->Starts[i];
+        std::copy(first, first + (this->Offsets[q+1] - this->Offsets[q]),
+                  this->Ids + this->Offsets[q]);
+        }
+      }
+    }
+};
+}
+
+//-----------------------------------------------------------------------------
+template <typename TIds> void BucketList<TIds>::
+SortQueries(vtkPoints *queries, std::vector<LocatorTuple<vtkIdType> > &order)
+{
+  vtkIdType numQueries = queries->GetNumberOfPoints();
+  order.resize(numQueries);
+  if ( numQueries < 1 )
+    {
+    return;
+    }
+  MapQueries mapper(this, queries, &order[0]);
+  vtkSMPTools::For(0, numQueries, mapper);
+  vtkSMPTools::RadixSort(&order[0], &order[0] + numQueries,
+                         &LocatorTuple<vtkIdType>::Bucket);
+}
+
+//-----------------------------------------------------------------------------
+template <typename TIds> void BucketList<TIds>::
+FindClosestPoints(vtkPoints *queries, vtkIdType *closest)
+{
+  std::vector<LocatorTuple<vtkIdType> > order;
+  this->SortQueries(queries, order);
+  if ( order.empty() )
+    {
+    return;
+    }
+  ClosestPointQueries<TIds> finder(this, queries, &order[0], closest);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(order.size()), finder);
+}
+
+//-----------------------------------------------------------------------------
+template <typename TIds> void BucketList<TIds>::
+FindClosestNPoints(int N, vtkPoints *queries, vtkIdType *result)
+{
+  std::vector<LocatorTuple<vtkIdType> > order;
+  this->SortQueries(queries, order);
+  if ( order.empty() )
+    {
+    return;
+    }
+  ClosestNPointsQueries<TIds> finder(this, N, queries, &order[0], result);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(order.size()), finder);
+}
+
+//-----------------------------------------------------------------------------
+template <typename TIds> void BucketList<TIds>::
+FindPointsWithinRadius(double R, vtkPoints *queries, vtkIdTypeArray *offsets,
+                       vtkIdTypeArray *ids)
+{
+  vtkIdType numQueries = queries->GetNumberOfPoints();
+  vtkIdType *off = offsets->GetPointer(0);
+  std::vector<LocatorTuple<vtkIdType> > order;
+  this->SortQueries(queries, order);
+  if ( order.empty() )
+    {
+    off[0] = 0;
+    ids->SetNumberOfTuples(0);
+    return;
+    }
+
+  // Find the points, counting them per query, then place each query's run
+  // after the runs of the previous queries.
+  RadiusQueries<TIds> finder(this, R, queries, &order[0], off);
+  vtkSMPTools::For(0, numQueries, finder);
+  off[numQueries] = vtkSMPTools::ExclusiveScan(off, off + numQueries, off,
+                                               static_cast<vtkIdType>(0));
+
+  ids->SetNumberOfTuples(off[numQueries]);
+  std::vector<RadiusResults*> results;
+  for (vtkSMPThreadLocal<RadiusResults>::iterator it =
+         finder.Results.begin(); it != finder.Results.end(); ++it)
+    {
+    results.push_back(&(*it));
+    }
+  CopyRadiusResults copier(results, off, ids->GetPointer(0));
+  vtkSMPTools::For(0, static_cast<vtkIdType>(results.size()), copier);
+}
+
+//-----------------------------------------------------------------------------
+namespace
+{
+// Merges the coincident points of each bucket. The points of a bucket are
+// sorted by id (the sort is stable), so the first coincident point kept in
+// the bucket is the one with the lowest id.
+template <typename TIds>
+class MergeCoincidentPoints
+{
+public:
+  BucketList<TIds> *BList;
+  vtkIdType *MergeMap;
+
+  MergeCoincidentPoints(BucketList<TIds> *blist, vtkIdType *mergeMap) :
+    BList(blist), MergeMap(mergeMap)
+    {
+    }
+
+  void operator()(vtkIdType bucket, vtkIdType end)
+    {
+    double x[3], y[3];
+    for ( ; bucket < end; ++bucket )
+      {
+      const LocatorTuple<TIds> *ids = this->BList->GetIds(bucket);
+      vtkIdType numIds = this->BList->GetNumberOfIds(bucket);
+      for (vtkIdType i=0; i < numIds; ++i)
+        {
+        vtkIdType ptId = ids[i].PtId;
+        this->MergeMap[ptId] = ptId;
+        this->BList->DataSet->GetPoint(ptId, x);
+        for (vtkIdType j=0; j < i; ++j)
+          {
+          vtkIdType keptId = ids[j].PtId;
+          if ( this->MergeMap[keptId] == keptId )
+            {
+            this->BList->DataSet->GetPoint(keptId, y);
+            if ( x[0] == y[0] && x[1] == y[1] && x[2] == y[2] )
+              {
+              this->MergeMap[ptId] = keptId;
+              break;
+              }
+            }
+          }
+        }
+      }
+    }
+};
+
+// Keeps the lowest id passed by BucketList::ForPointsWithinRadius(), among
+// the ids lower than Limit that satisfy the merge map condition.
+struct LowestIdInserter
+{
+  const vtkIdType *MergeMap; // NULL to accept any id
+  vtkIdType Limit;
+  vtkIdType Id;
+  LowestIdInserter(const vtkIdType *mergeMap, vtkIdType limit) :
+    MergeMap(mergeMap), Limit(limit), Id(limit) {}
+  void operator()(vtkIdType ptId)
+    {
+    if ( ptId < this->Id &&
+         (!this->MergeMap || this->MergeMap[ptId] == ptId) )
+      {
+      this->Id = ptId;
+      }
+    }
+};
+
+// Finds the lowest id of the points within the tolerance of each point.
+template <typename TIds>
+class LowestIdWithinTolerance
+{
+public:
+  BucketList<TIds> *BList;
+  double Tol;
+  vtkIdType *MergeMap;
+
+  LowestIdWithinTolerance(BucketList<TIds> *blist, double tol,
+                          vtkIdType *mergeMap) :
+    BList(blist), Tol(tol), MergeMap(mergeMap)
+    {
+    }
+
+  void operator()(vtkIdType ptId, vtkIdType end)
+    {
+    double x[3];
+    for ( ; ptId < end; ++ptId )
+      {
+      LowestIdInserter inserter(NULL, ptId);
+      this->BList->DataSet->GetPoint(ptId, x);
+      this->BList->ForPointsWithinRadius(this->Tol, x, inserter);
+      this->MergeMap[ptId] = inserter.Id;
+      }
+    }
+};
+}
+
+//-----------------------------------------------------------------------------
+// Points are processed in increasing id order: a point that is not merged
+// yet is kept, and absorbs the points within tol that are not merged yet.
+// Coincident points fall in the same bucket, so that exact merging is
+// independent per bucket. With a tolerance, the point a point merges to is
+// the lowest kept point within tol. The lowest point within tol is found
+// in parallel; when it is kept it is the answer (any lower kept point
+// within tol would have been found instead). Otherwise, only then, the
+// serial pass searches the neighborhood again for the lowest kept point.
+template <typename TIds> void BucketList<TIds>::
+MergePoints(double tol, vtkIdType *mergeMap)
+{
+  if ( tol <= 0.0 )
+    {
+    MergeCoincidentPoints<TIds> merger(this, mergeMap);
+    vtkSMPTools::For(0, this->NumBuckets, merger);
+    return;
+    }
+
+  LowestIdWithinTolerance<TIds> finder(this, tol, mergeMap);
+  vtkSMPTools::For(0, this->NumPts, finder);
+
+  double x[3];
+  for (vtkIdType ptId=0; ptId < this->NumPts; ++ptId)
+    {
+    vtkIdType lowestId = mergeMap[ptId];
+    if ( lowestId != ptId && mergeMap[lowestId] != lowestId )
+      {
+      LowestIdInserter inserter(mergeMap, ptId);
+      this->DataSet->GetPoint(ptId, x);
+      this->ForPointsWithinRadius(tol, x, inserter);
+      mergeMap[ptId] = inserter.Id;
+      }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Construct with automatic computation of divisions, averaging
 // 5 points per bucket.
@@ -1559,6 +1988,111 @@ FindPointsWithinRadius(double R, const double x[3], vtkIdList *result)
     }
 }
 
+//-----------------------------------------------------------------------------
+void vtkStaticPointLocator::
+FindClosestPoints(vtkPoints *queries, vtkIdTypeArray *closest)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  closest->SetNumberOfComponents(1);
+  closest->SetNumberOfTuples(queries->GetNumberOfPoints());
+  if ( !this->Buckets )
+    {
+    closest->FillComponent(0, -1);
+    return;
+    }
+
+  if ( this->LargeIds )
+    {
+    static_cast<BucketList<vtkIdType>*>(this->Buckets)->
+      FindClosestPoints(queries,closest->GetPointer(0));
+    }
+  else
+    {
+    static_cast<BucketList<int>*>(this->Buckets)->
+      FindClosestPoints(queries,closest->GetPointer(0));
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticPointLocator::
+FindClosestNPoints(int N, vtkPoints *queries, vtkIdTypeArray *result)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( N < 1 )
+    {
+    result->Initialize();
+    return;
+    }
+  result->SetNumberOfComponents(N);
+  result->SetNumberOfTuples(queries->GetNumberOfPoints());
+  if ( !this->Buckets )
+    {
+    std::fill_n(result->GetPointer(0),
+                static_cast<vtkIdType>(N) * queries->GetNumberOfPoints(), -1);
+    return;
+    }
+
+  if ( this->LargeIds )
+    {
+    static_cast<BucketList<vtkIdType>*>(this->Buckets)->
+      FindClosestNPoints(N,queries,result->GetPointer(0));
+    }
+  else
+    {
+    static_cast<BucketList<int>*>(this->Buckets)->
+      FindClosestNPoints(N,queries,result->GetPointer(0));
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticPointLocator::
+FindPointsWithinRadius(double R, vtkPoints *queries, vtkIdTypeArray *offsets,
+                       vtkIdTypeArray *ids)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfTuples(queries->GetNumberOfPoints() + 1);
+  ids->SetNumberOfComponents(1);
+  if ( !this->Buckets )
+    {
+    offsets->FillComponent(0, 0);
+    ids->SetNumberOfTuples(0);
+    return;
+    }
+
+  if ( this->LargeIds )
+    {
+    static_cast<BucketList<vtkIdType>*>(this->Buckets)->
+      FindPointsWithinRadius(R,queries,offsets,ids);
+    }
+  else
+    {
+    static_cast<BucketList<int>*>(this->Buckets)->
+      FindPointsWithinRadius(R,queries,offsets,ids);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticPointLocator::MergePoints(double tol, vtkIdType *mergeMap)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Buckets )
+    {
+    return;
+    }
+
+  if ( this->LargeIds )
+    {
+    static_cast<BucketList<vtkIdType>*>(this->Buckets)->
+      MergePoints(tol,mergeMap);
+    }
+  else
+    {
+    static_cast<BucketList<int>*>(this->Buckets)->
+      MergePoints(tol,mergeMap);
+    }
+}
+
 //-----------------------------------------------------------------------------
 void vtkStaticPointLocator::
 GenerateRepresentation(int level, vtkPolyData *pd)
@@ -49,6 +49,8 @@
 #include "vtkAbstractPointLocator.h"
 
 class vtkIdList;
+class vtkIdTypeArray;
+class vtkPoints;
 class vtkBucketList;
 
 
@@ -123,6 +125,38 @@ public:
   virtual void FindPointsWithinRadius(double R, const double x[3],
                                       vtkIdList *result);
 
+  // Description:
+  // Batched versions of the queries above, for many query points at once.
+  // The queries are sorted on the bucket they fall in, so that consecutive
+  // queries visit the same buckets, and executed in parallel (via
+  // vtkSMPTools). No vtkIdList is allocated per query.
+  //
+  // FindClosestPoints() sets value i of closest to the id of the point
+  // closest to query point i. FindClosestNPoints() sets tuple i of result,
+  // which has N components, to the closest N points of query point i,
+  // sorted from closest to farthest and padded with -1 when the data set
+  // has less than N points.
+  // FindPointsWithinRadius() returns the points within radius R of query
+  // point i as ids[offsets[i]] to ids[offsets[i+1]-1] (compressed sparse
+  // row layout), not sorted in any specific manner. The output arrays are
+  // resized as needed. These methods must not be called concurrently with
+  // themselves or the methods above from several threads.
+  void FindClosestPoints(vtkPoints *queries, vtkIdTypeArray *closest);
+  void FindClosestNPoints(int N, vtkPoints *queries, vtkIdTypeArray *result);
+  void FindPointsWithinRadius(double R, vtkPoints *queries,
+                              vtkIdTypeArray *offsets, vtkIdTypeArray *ids);
+
+  // Description:
+  // Merge the points that lie within distance tol of each other. The points
+  // are considered in increasing id order: a point not merged yet is kept
+  // and absorbs the points within tol that are not merged yet. On return,
+  // mergeMap[i] is the id of the kept point that point i merges to (i
+  // itself for the kept points); mergeMap must hold one entry per point.
+  // With tol == 0, only coincident points are merged, bucket by bucket in
+  // parallel. Otherwise the neighborhoods are searched in parallel, and a
+  // serial pass resolves the points whose merge groups overlap.
+  void MergePoints(double tol, vtkIdType *mergeMap);
+
   // Description:
   // See vtkLocator and vtkAbstractPointLocator interface documentation.
   // These methods are not thread safe.
@@ -295,7 +295,8 @@ void vtkStructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
     }
 
   // Update dimensions
-  this->GetDimensions();
+  int dims[3];
+  this->GetDimensions(dims);
 
   switch (this->DataDescription)
     {
@@ -328,11 +329,11 @@ void vtkStructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
 
     case VTK_XY_PLANE:
       cell->SetCellTypeToQuad();
-      i = cellId % (this->Dimensions[0]-1);
-      j = cellId / (this->Dimensions[0]-1);
-      idx = i + j*this->Dimensions[0];
+      i = cellId % (dims[0]-1);
+      j = cellId / (dims[0]-1);
+      idx = i + j*dims[0];
       offset1 = 1;
-      offset2 = this->Dimensions[0];
+      offset2 = dims[0];
 
       cell->PointIds->SetId(0,idx);
       cell->PointIds->SetId(1,idx+offset1);
@@ -342,11 +343,11 @@ void vtkStructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
 
     case VTK_YZ_PLANE:
       cell->SetCellTypeToQuad();
-      j = cellId % (this->Dimensions[1]-1);
-      k = cellId / (this->Dimensions[1]-1);
-      idx = j + k*this->Dimensions[1];
+      j = cellId % (dims[1]-1);
+      k = cellId / (dims[1]-1);
+      idx = j + k*dims[1];
       offset1 = 1;
-      offset2 = this->Dimensions[1];
+      offset2 = dims[1];
 
       cell->PointIds->SetId(0,idx);
       cell->PointIds->SetId(1,idx+offset1);
@@ -356,11 +357,11 @@ void vtkStructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
 
     case VTK_XZ_PLANE:
       cell->SetCellTypeToQuad();
-      i = cellId % (this->Dimensions[0]-1);
-      k = cellId / (this->Dimensions[0]-1);
-      idx = i + k*this->Dimensions[0];
+      i = cellId % (dims[0]-1);
+      k = cellId / (dims[0]-1);
+      idx = i + k*dims[0];
       offset1 = 1;
-      offset2 = this->Dimensions[0];
+      offset2 = dims[0];
 
       cell->PointIds->SetId(0,idx);
       cell->PointIds->SetId(1,idx+offset1);
@@ -370,13 +371,13 @@ void vtkStructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
 
     case VTK_XYZ_GRID:
       cell->SetCellTypeToHexahedron();
-      d01 = this->Dimensions[0]*this->Dimensions[1];
-      i = cellId % (this->Dimensions[0] - 1);
-      j = (cellId / (this->Dimensions[0] - 1)) % (this->Dimensions[1] - 1);
-      k = cellId / ((this->Dimensions[0] - 1) * (this->Dimensions[1] - 1));
-      idx = i+ j*this->Dimensions[0] + k*d01;
+      d01 = dims[0]*dims[1];
+      i = cellId % (dims[0] - 1);
+      j = (cellId / (dims[0] - 1)) % (dims[1] - 1);
+      k = cellId / ((dims[0] - 1) * (dims[1] - 1));
+      idx = i+ j*dims[0] + k*d01;
       offset1 = 1;
-      offset2 = this->Dimensions[0];
+      offset2 = dims[0];
 
       cell->PointIds->SetId(0,idx);
       cell->PointIds->SetId(1,idx+offset1);
@@ -423,7 +424,8 @@ void vtkStructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
   vtkMath::UninitializeBounds(bounds);
 
   // Update dimensions
-  this->GetDimensions();
+  int dims[3];
+  this->GetDimensions(dims);
 
   switch (this->DataDescription)
     {
@@ -453,27 +455,27 @@ void vtkStructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
     case VTK_XZ_PLANE:
       if (this->DataDescription == VTK_XY_PLANE)
         {
-        i = cellId % (this->Dimensions[0]-1);
-        j = cellId / (this->Dimensions[0]-1);
-        idx = i + j*this->Dimensions[0];
+        i = cellId % (dims[0]-1);
+        j = cellId / (dims[0]-1);
+        idx = i + j*dims[0];
         offset1 = 1;
-        offset2 = this->Dimensions[0];
+        offset2 = dims[0];
         }
       else if (this->DataDescription == VTK_YZ_PLANE)
         {
-        j = cellId % (this->Dimensions[1]-1);
-        k = cellId / (this->Dimensions[1]-1);
-        idx = j + k*this->Dimensions[1];
+        j = cellId % (dims[1]-1);
+        k = cellId / (dims[1]-1);
+        idx = j + k*dims[1];
         offset1 = 1;
-        offset2 = this->Dimensions[1];
+        offset2 = dims[1];
         }
       else if (this->DataDescription == VTK_XZ_PLANE)
         {
-        i = cellId % (this->Dimensions[0]-1);
-        k = cellId / (this->Dimensions[0]-1);
-        idx = i + k*this->Dimensions[0];
+        i = cellId % (dims[0]-1);
+        k = cellId / (dims[0]-1);
+        idx = i + k*dims[0];
         offset1 = 1;
-        offset2 = this->Dimensions[0];
+        offset2 = dims[0];
         }
 
       this->Points->GetPoint(idx, x);
@@ -493,13 +495,13 @@ void vtkStructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
       break;
 
     case VTK_XYZ_GRID:
-      d01 = this->Dimensions[0]*this->Dimensions[1];
-      i = cellId % (this->Dimensions[0] - 1);
-      j = (cellId / (this->Dimensions[0] - 1)) % (this->Dimensions[1] - 1);
-      k = cellId / ((this->Dimensions[0] - 1) * (this->Dimensions[1] - 1));
-      idx = i+ j*this->Dimensions[0] + k*d01;
+      d01 = dims[0]*dims[1];
+      i = cellId % (dims[0] - 1);
+      j = (cellId / (dims[0] - 1)) % (dims[1] - 1);
+      k = cellId / ((dims[0] - 1) * (dims[1] - 1));
+      idx = i+ j*dims[0] + k*d01;
       offset1 = 1;
-      offset2 = this->Dimensions[0];
+      offset2 = dims[0];
 
       this->Points->GetPoint(idx, x);
       bounds[0] = bounds[1] = x[0];
@@ -598,9 +600,11 @@ unsigned char vtkStructuredGrid::IsPointVisible(vtkIdType pointId)
 //----------------------------------------------------------------------------
 void vtkStructuredGrid::GetCellDims( int cellDims[3] )
 {
+  int dims[3];
+  this->GetDimensions(dims);
   for( int i=0; i < 3; ++i )
     {
-    cellDims[i] = ( (this->Dimensions[i]-1) < 1)? 1 : this->Dimensions[i]-1;
+    cellDims[i] = ( (dims[i]-1) < 1)? 1 : dims[i]-1;
     }
 }
 
@@ -620,12 +624,13 @@ unsigned char vtkStructuredGrid::IsCellVisible(vtkIdType cellId)
     }
 
   // Update dimensions
-  this->GetDimensions();
+  int dims[3];
+  this->GetDimensions(dims);
 
   int numIds=0;
   vtkIdType ptIds[8];
   int iMin, iMax, jMin, jMax, kMin, kMax;
-  vtkIdType d01 = this->Dimensions[0]*this->Dimensions[1];
+  vtkIdType d01 = dims[0]*dims[1];
   iMin = iMax = jMin = jMax = kMin = kMax = 0;
 
   switch (this->DataDescription)
@@ -635,85 +640,85 @@ unsigned char vtkStructuredGrid::IsCellVisible(vtkIdType cellId)
 
     case VTK_SINGLE_POINT: // cellId can only be = 0
       numIds = 1;
-      ptIds[0] = iMin + jMin*this->Dimensions[0] + kMin*d01;
+      ptIds[0] = iMin + jMin*dims[0] + kMin*d01;
       break;
 
     case VTK_X_LINE:
       iMin = cellId;
       iMax = cellId + 1;
       numIds = 2;
-      ptIds[0] = iMin + jMin*this->Dimensions[0] + kMin*d01;
-      ptIds[1] = iMax + jMin*this->Dimensions[0] + kMin*d01;
+      ptIds[0] = iMin + jMin*dims[0] + kMin*d01;
+      ptIds[1] = iMax + jMin*dims[0] + kMin*d01;
       break;
 
     case VTK_Y_LINE:
       jMin = cellId;
       jMax = cellId + 1;
       numIds = 2;
-      ptIds[0] = iMin + jMin*this->Dimensions[0] + kMin*d01;
-      ptIds[1] = iMin + jMax*this->Dimensions[0] + kMin*d01;
+      ptIds[0] = iMin + jMin*dims[0] + kMin*d01;
+      ptIds[1] = iMin + jMax*dims[0] + kMin*d01;
       break;
 
     case VTK_Z_LINE:
       kMin = cellId;
       kMax = cellId + 1;
       numIds = 2;
-      ptIds[0] = iMin + jMin*this->Dimensions[0] + kMin*d01;
-      ptIds[1] = iMin + jMin*this->Dimensions[0] + kMax*d01;
+      ptIds[0] = iMin + jMin*dims[0] + kMin*d01;
+      ptIds[1] = iMin + jMin*dims[0] + kMax*d01;
       break;
 
     case VTK_XY_PLANE:
-      iMin = cellId % (this->Dimensions[0]-1);
+      iMin = cellId % (dims[0]-1);
       iMax = iMin + 1;
-      jMin = cellId / (this->Dimensions[0]-1);
+      jMin = cellId / (dims[0]-1);
       jMax = jMin + 1;
       numIds = 4;
-      ptIds[0] = iMin + jMin*this->Dimensions[0] + kMin*d01;
-      ptIds[1] = iMax + jMin*this->Dimensions[0] + kMin*d01;
-      ptIds[2] = iMax + jMax*this->Dimensions[0] + kMin*d01;
-      ptIds[3] = iMin + jMax*this->Dimensions[0] + kMin*d01;
+      ptIds[0] = iMin + jMin*dims[0] + kMin*d01;
+      ptIds[1] = iMax + jMin*dims[0] + kMin*d01;
+      ptIds[2] = iMax + jMax*dims[0] + kMin*d01;
+      ptIds[3] = iMin + jMax*dims[0] + kMin*d01;
       break;
 
     case VTK_YZ_PLANE:
-      jMin = cellId % (this->Dimensions[1]-1);
+      jMin = cellId % (dims[1]-1);
       jMax = jMin + 1;
-      kMin = cellId / (this->Dimensions[1]-1);
+      kMin = cellId / (dims[1]-1);
       kMax = kMin + 1;
       numIds = 4;
-      ptIds[0] = iMin + jMin*this->Dimensions[0] + kMin*d01;
-      ptIds[1] = iMin + jMax*this->Dimensions[0] + kMin*d01;
-      ptIds[2] = iMin + jMax*this->Dimensions[0] + kMax*d01;
-      ptIds[3] = iMin + jMin*this->Dimensions[0] + kMax*d01;
+      ptIds[0] = iMin + jMin*dims[0] + kMin*d01;
+      ptIds[1] = iMin + jMax*dims[0] + kMin*d01;
+      ptIds[2] = iMin + jMax*dims[0] + kMax*d01;
+      ptIds[3] = iMin + jMin*dims[0] + kMax*d01;
       break;
 
     case VTK_XZ_PLANE:
-      iMin = cellId % (this->Dimensions[0]-1);
+      iMin = cellId % (dims[0]-1);
       iMax = iMin + 1;
-      kMin = cellId / (this->Dimensions[0]-1);
+      kMin = cellId / (dims[0]-1);
       kMax = kMin + 1;
       numIds = 4;
-      ptIds[0] = iMin + jMin*this->Dimensions[0] + kMin*d01;
-      ptIds[1] = iMax + jMin*this->Dimensions[0] + kMin*d01;
-      ptIds[2] = iMax + jMin*this->Dimensions[0] + kMax*d01;
-      ptIds[3] = iMin + jMin*this->Dimensions[0] + kMax*d01;
+      ptIds[0] = iMin + jMin*dims[0] + kMin*d01;
+      ptIds[1] = iMax + jMin*dims[0] + kMin*d01;
+      ptIds[2] = iMax + jMin*dims[0] + kMax*d01;
+      ptIds[3] = iMin + jMin*dims[0] + kMax*d01;
       break;
 
     case VTK_XYZ_GRID:
-      iMin = cellId % (this->Dimensions[0] - 1);
+      iMin = cellId % (dims[0] - 1);
       iMax = iMin + 1;
-      jMin = (cellId / (this->Dimensions[0] - 1)) % (this->Dimensions[1] - 1);
+      jMin = (cellId / (dims[0] - 1)) % (dims[1] - 1);
       jMax = jMin + 1;
-      kMin = cellId / ((this->Dimensions[0] - 1) * (this->Dimensions[1] - 1));
+      kMin = cellId / ((dims[0] - 1) * (dims[1] - 1));
       kMax = kMin + 1;
       numIds = 8;
-      ptIds[0] = iMin + jMin*this->Dimensions[0] + kMin*d01;
-      ptIds[1] = iMax + jMin*this->Dimensions[0] + kMin*d01;
-      ptIds[2] = iMax + jMax*this->Dimensions[0] + kMin*d01;
-      ptIds[3] = iMin + jMax*this->Dimensions[0] + kMin*d01;
-      ptIds[4] = iMin + jMin*this->Dimensions[0] + kMax*d01;
-      ptIds[5] = iMax + jMin*this->Dimensions[0] + kMax*d01;
-      ptIds[6] = iMax + jMax*this->Dimensions[0] + kMax*d01;
-      ptIds[7] = iMin + jMax*this->Dimensions[0] + kMax*d01;
+      ptIds[0] = iMin + jMin*dims[0] + kMin*d01;
+      ptIds[1] = iMax + jMin*dims[0] + kMin*d01;
+      ptIds[2] = iMax + jMax*dims[0] + kMin*d01;
+      ptIds[3] = iMin + jMax*dims[0] + kMin*d01;
+      ptIds[4] = iMin + jMin*dims[0] + kMax*d01;
+      ptIds[5] = iMax + jMin*dims[0] + kMax*d01;
+      ptIds[6] = iMax + jMax*dims[0] + kMax*d01;
+      ptIds[7] = iMin + jMax*dims[0] + kMax*d01;
       break;
     }
 
@@ -747,10 +752,11 @@ void vtkStructuredGrid::SetDimensions(int dim[3])
 void vtkStructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
 {
   // Update dimensions
-  this->GetDimensions();
+  int dims[3];
+  this->GetDimensions(dims);
 
   int iMin, iMax, jMin, jMax, kMin, kMax;
-  vtkIdType d01 = this->Dimensions[0]*this->Dimensions[1];
+  vtkIdType d01 = dims[0]*dims[1];
 
   ptIds->Reset();
   iMin = iMax = jMin = jMax = kMin = kMax = 0;
@@ -762,85 +768,85 @@ void vtkStructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
 
     case VTK_SINGLE_POINT: // cellId can only be = 0
       ptIds->SetNumberOfIds(1);
-      ptIds->SetId(0, iMin + jMin*this->Dimensions[0] + kMin*d01);
+      ptIds->SetId(0, iMin + jMin*dims[0] + kMin*d01);
       break;
 
     case VTK_X_LINE:
       iMin = cellId;
       iMax = cellId + 1;
       ptIds->SetNumberOfIds(2);
-      ptIds->SetId(0, iMin + jMin*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(1, iMax + jMin*this->Dimensions[0] + kMin*d01);
+      ptIds->SetId(0, iMin + jMin*dims[0] + kMin*d01);
+      ptIds->SetId(1, iMax + jMin*dims[0] + kMin*d01);
       break;
 
     case VTK_Y_LINE:
       jMin = cellId;
       jMax = cellId + 1;
       ptIds->SetNumberOfIds(2);
-      ptIds->SetId(0, iMin + jMin*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(1, iMin + jMax*this->Dimensions[0] + kMin*d01);
+      ptIds->SetId(0, iMin + jMin*dims[0] + kMin*d01);
+      ptIds->SetId(1, iMin + jMax*dims[0] + kMin*d01);
       break;
 
     case VTK_Z_LINE:
       kMin = cellId;
       kMax = cellId + 1;
       ptIds->SetNumberOfIds(2);
-      ptIds->SetId(0, iMin + jMin*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(1, iMin + jMin*this->Dimensions[0] + kMax*d01);
+      ptIds->SetId(0, iMin + jMin*dims[0] + kMin*d01);
+      ptIds->SetId(1, iMin + jMin*dims[0] + kMax*d01);
       break;
 
     case VTK_XY_PLANE:
-      iMin = cellId % (this->Dimensions[0]-1);
+      iMin = cellId % (dims[0]-1);
       iMax = iMin + 1;
-      jMin = cellId / (this->Dimensions[0]-1);
+      jMin = cellId / (dims[0]-1);
       jMax = jMin + 1;
       ptIds->SetNumberOfIds(4);
-      ptIds->SetId(0, iMin + jMin*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(1, iMax + jMin*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(2, iMax + jMax*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(3, iMin + jMax*this->Dimensions[0] + kMin*d01);
+      ptIds->SetId(0, iMin + jMin*dims[0] + kMin*d01);
+      ptIds->SetId(1, iMax + jMin*dims[0] + kMin*d01);
+      ptIds->SetId(2, iMax + jMax*dims[0] + kMin*d01);
+      ptIds->SetId(3, iMin + jMax*dims[0] + kMin*d01);
       break;
 
     case VTK_YZ_PLANE:
-      jMin = cellId % (this->Dimensions[1]-1);
+      jMin = cellId % (dims[1]-1);
       jMax = jMin + 1;
-      kMin = cellId / (this->Dimensions[1]-1);
+      kMin = cellId / (dims[1]-1);
       kMax = kMin + 1;
       ptIds->SetNumberOfIds(4);
-      ptIds->SetId(0, iMin + jMin*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(1, iMin + jMax*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(2, iMin + jMax*this->Dimensions[0] + kMax*d01);
-      ptIds->SetId(3, iMin + jMin*this->Dimensions[0] + kMax*d01);
+      ptIds->SetId(0, iMin + jMin*dims[0] + kMin*d01);
+      ptIds->SetId(1, iMin + jMax*dims[0] + kMin*d01);
+      ptIds->SetId(2, iMin + jMax*dims[0] + kMax*d01);
+      ptIds->SetId(3, iMin + jMin*dims[0] + kMax*d01);
       break;
 
     case VTK_XZ_PLANE:
-      iMin = cellId % (this->Dimensions[0]-1);
+      iMin = cellId % (dims[0]-1);
       iMax = iMin + 1;
-      kMin = cellId / (this->Dimensions[0]-1);
+      kMin = cellId / (dims[0]-1);
       kMax = kMin + 1;
       ptIds->SetNumberOfIds(4);
-      ptIds->SetId(0, iMin + jMin*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(1, iMax + jMin*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(2, iMax + jMin*this->Dimensions[0] + kMax*d01);
-      ptIds->SetId(3, iMin + jMin*this->Dimensions[0] + kMax*d01);
+      ptIds->SetId(0, iMin + jMin*dims[0] + kMin*d01);
+      ptIds->SetId(1, iMax + jMin*dims[0] + kMin*d01);
+      ptIds->SetId(2, iMax + jMin*dims[0] + kMax*d01);
+      ptIds->SetId(3, iMin + jMin*dims[0] + kMax*d01);
       break;
 
     case VTK_XYZ_GRID:
-      iMin = cellId % (this->Dimensions[0] - 1);
+      iMin = cellId % (dims[0] - 1);
       iMax = iMin + 1;
-      jMin = (cellId / (this->Dimensions[0] - 1)) % (this->Dimensions[1] - 1);
+      jMin = (cellId / (dims[0] - 1)) % (dims[1] - 1);
       jMax = jMin + 1;
-      kMin = cellId / ((this->Dimensions[0] - 1) * (this->Dimensions[1] - 1));
+      kMin = cellId / ((dims[0] - 1) * (dims[1] - 1));
       kMax = kMin + 1;
       ptIds->SetNumberOfIds(8);
-      ptIds->SetId(0, iMin + jMin*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(1, iMax + jMin*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(2, iMax + jMax*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(3, iMin + jMax*this->Dimensions[0] + kMin*d01);
-      ptIds->SetId(4, iMin + jMin*this->Dimensions[0] + kMax*d01);
-      ptIds->SetId(5, iMax + jMin*this->Dimensions[0] + kMax*d01);
-      ptIds->SetId(6, iMax + jMax*this->Dimensions[0] + kMax*d01);
-      ptIds->SetId(7, iMin + jMax*this->Dimensions[0] + kMax*d01);
+      ptIds->SetId(0, iMin + jMin*dims[0] + kMin*d01);
+      ptIds->SetId(1, iMax + jMin*dims[0] + kMin*d01);
+      ptIds->SetId(2, iMax + jMax*dims[0] + kMin*d01);
+      ptIds->SetId(3, iMin + jMax*dims[0] + kMin*d01);
+      ptIds->SetId(4, iMin + jMin*dims[0] + kMax*d01);
+      ptIds->SetId(5, iMax + jMin*dims[0] + kMax*d01);
+      ptIds->SetId(6, iMax + jMax*dims[0] + kMax*d01);
+      ptIds->SetId(7, iMin + jMax*dims[0] + kMax*d01);
       break;
     }
 }
@@ -903,6 +909,8 @@ void vtkStructuredGrid::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
                                          vtkIdList *cellIds)
 {
   int numPtIds=ptIds->GetNumberOfIds();
+  int dims[3];
+  this->GetDimensions(dims);
 
   // Use special methods for speed
   switch (numPtIds)
@@ -912,8 +920,7 @@ void vtkStructuredGrid::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
       return;
 
     case 1: case 2: case 4: //vertex, edge, face neighbors
-      vtkStructuredData::GetCellNeighbors(cellId, ptIds,
-                                          cellIds, this->GetDimensions());
+      vtkStructuredData::GetCellNeighbors(cellId, ptIds, cellIds, dims);
       break;
 
     default:
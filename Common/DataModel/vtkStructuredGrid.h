@@ -79,9 +79,12 @@ public:
   int GetCellType(vtkIdType cellId);
   vtkIdType GetNumberOfCells();
   void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds);
+  using vtkPointSet::GetCellPoints;
   void GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
     {
-      vtkStructuredData::GetPointCells(ptId,cellIds,this->GetDimensions());
+      int dims[3];
+      this->GetDimensions(dims);
+      vtkStructuredData::GetPointCells(ptId,cellIds,dims);
     }
   void Initialize();
   int GetMaxCellSize() {return 8;}; //hexahedron is the largest
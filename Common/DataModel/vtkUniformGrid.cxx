@@ -450,7 +450,8 @@ vtkIdType vtkUniformGrid::FindCell(double x[3], vtkCell *vtkNotUsed(cell),
                                    double *weights)
 {
   int loc[3];
-  int *dims = this->GetDimensions();
+  int dims[3];
+  this->GetDimensions(dims);
 
   if ( this->ComputeStructuredCoordinates(x, loc, pcoords) == 0 )
     {
@@ -857,7 +858,8 @@ unsigned char vtkUniformGrid::IsCellVisible(vtkIdType cellId)
     }
 
   int iMin, iMax, jMin, jMax, kMin, kMax;
-  int *dims = this->GetDimensions();
+  int dims[3];
+  this->GetDimensions(dims);
 
   iMin = iMax = jMin = jMax = kMin = kMax = 0;
 
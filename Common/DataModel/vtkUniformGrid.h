@@ -65,6 +65,7 @@ public:
   virtual void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
     {vtkStructuredData::GetCellPoints(cellId,ptIds,this->GetDataDescription(),
                                       this->GetDimensions());}
+  using vtkImageData::GetCellPoints;
   virtual void GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
     {vtkStructuredData::GetPointCells(ptId,cellIds,this->GetDimensions());}
   virtual void Initialize();
@@ -46,6 +46,7 @@
 #include "vtkQuadraticQuad.h"
 #include "vtkQuadraticTetra.h"
 #include "vtkQuadraticTriangle.h"
+#include "vtkSmartPointer.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleStrip.h"
@@ -62,6 +63,7 @@
 #include "vtkBiQuadraticQuadraticHexahedron.h"
 #include "vtkBiQuadraticTriangle.h"
 
+#include <cstring>
 #include <set>
 
 vtkStandardNewMacro(vtkUnstructuredGrid);
@@ -118,6 +120,13 @@ vtkUnstructuredGrid::vtkUnstructuredGrid ()
   this->Faces = NULL;
   this->FaceLocations = NULL;
 
+  this->SingleCellType = -1;
+  this->SingleCellSize = 0;
+
+  this->CachePolyhedronTopology = false;
+  this->PolyhedronTopology = NULL;
+  this->PolyhedronTopologyLocations = NULL;
+
   this->Allocate(1000,1000);
 }
 
@@ -126,6 +135,8 @@ vtkUnstructuredGrid::vtkUnstructuredGrid ()
 // inserting any cells into object.
 void vtkUnstructuredGrid::Allocate (vtkIdType numCells, int extSize)
 {
+  this->ReleasePolyhedronTopology();
+
   if ( numCells < 1 )
     {
     numCells = 1000;
@@ -161,6 +172,127 @@ void vtkUnstructuredGrid::Allocate (vtkIdType numCells, int extSize)
   this->Locations->Allocate(numCells,extSize);
   this->Locations->Register(this);
   this->Locations->Delete();
+
+  this->SingleCellType = -1;
+  this->SingleCellSize = 0;
+}
+
+//----------------------------------------------------------------------------
+// Allocate memory space for cells of a single type and size. The cell types
+// and locations are implicit.
+void vtkUnstructuredGrid::AllocateSingleCellType(int type, int npts,
+                                                 vtkIdType numCells)
+{
+  this->ReleasePolyhedronTopology();
+
+  if ( type == VTK_POLYHEDRON || npts < 0 )
+    {
+    vtkErrorMacro(<< "No single cell type storage for cell type " << type
+                  << " with " << npts << " points");
+    this->Allocate(numCells);
+    return;
+    }
+  if ( numCells < 1 )
+    {
+    numCells = 1000;
+    }
+
+  if ( this->Connectivity )
+    {
+    this->Connectivity->UnRegister(this);
+    }
+  this->Connectivity = vtkCellArray::New();
+  this->Connectivity->Allocate(
+    this->Connectivity->EstimateSize(numCells,npts));
+  this->Connectivity->Register(this);
+  this->Connectivity->Delete();
+
+  if ( this->Types )
+    {
+    this->Types->UnRegister(this);
+    this->Types = NULL;
+    }
+  if ( this->Locations )
+    {
+    this->Locations->UnRegister(this);
+    this->Locations = NULL;
+    }
+  if ( this->Faces )
+    {
+    this->Faces->UnRegister(this);
+    this->Faces = NULL;
+    }
+  if ( this->FaceLocations )
+    {
+    this->FaceLocations->UnRegister(this);
+    this->FaceLocations = NULL;
+    }
+
+  this->SingleCellType = type;
+  this->SingleCellSize = npts;
+}
+
+//----------------------------------------------------------------------------
+// With the legacy layout, the cells of the single cell type storage are
+// npts+1 entries apart; with OFFSETS_STORAGE, locations are cell ids.
+inline vtkIdType vtkUnstructuredGrid::GetCellLocation(vtkIdType cellId)
+{
+  if ( this->SingleCellType < 0 )
+    {
+    return this->Locations->GetValue(cellId);
+    }
+  return (this->Connectivity->GetStorageMode() ==
+          vtkCellArray::OFFSETS_STORAGE ? cellId :
+          cellId * (this->SingleCellSize + 1));
+}
+
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::BuildTypesAndLocations()
+{
+  vtkIdType numCells = this->GetNumberOfCells();
+
+  vtkUnsignedCharArray *types = vtkUnsignedCharArray::New();
+  types->SetNumberOfValues(numCells);
+  if ( numCells > 0 )
+    {
+    memset(types->GetPointer(0), this->SingleCellType, numCells);
+    }
+  vtkIdTypeArray *locations = vtkIdTypeArray::New();
+  locations->SetNumberOfValues(numCells);
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+    locations->SetValue(cellId, this->GetCellLocation(cellId));
+    }
+
+  this->Types = types;
+  this->Types->Register(this);
+  this->Types->Delete();
+  this->Locations = locations;
+  this->Locations->Register(this);
+  this->Locations->Delete();
+
+  this->SingleCellType = -1;
+  this->SingleCellSize = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkUnsignedCharArray* vtkUnstructuredGrid::GetCellTypesArray()
+{
+  if ( this->SingleCellType >= 0 )
+    {
+    this->BuildTypesAndLocations();
+    }
+  return this->Types;
+}
+
+//----------------------------------------------------------------------------
+vtkIdTypeArray* vtkUnstructuredGrid::GetCellLocationsArray()
+{
+  if ( this->SingleCellType >= 0 )
+    {
+    this->BuildTypesAndLocations();
+    }
+  return this->Locations;
 }
 
 //----------------------------------------------------------------------------
@@ -329,10 +461,30 @@ int vtkUnstructuredGrid::GetGhostLevel()
   return this->Information->Get(vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS());
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkUnstructuredGrid::GetTopologyMTime()
+{
+  unsigned long mtime = this->vtkPointSet::GetTopologyMTime();
+  vtkObject *topology[5] = { this->Connectivity, this->Types,
+    this->Locations, this->Faces, this->FaceLocations };
+
+  for (int i = 0; i < 5; ++i)
+    {
+    if ( topology[i] && topology[i]->GetMTime() > mtime )
+      {
+      mtime = topology[i]->GetMTime();
+      }
+    }
+
+  return mtime;
+}
+
 //----------------------------------------------------------------------------
 // Copy the geometric and topological structure of an input unstructured grid.
 void vtkUnstructuredGrid::CopyStructure(vtkDataSet *ds)
 {
+  this->ReleasePolyhedronTopology();
+
   // If ds is a vtkUnstructuredGrid, do a shallow copy of the cell data.
   if (vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(ds))
     {
@@ -413,6 +565,9 @@ void vtkUnstructuredGrid::CopyStructure(vtkDataSet *ds)
         this->FaceLocations->Register(this);
         }
       }
+
+    this->SingleCellType = ug->SingleCellType;
+    this->SingleCellSize = ug->SingleCellSize;
     }
 
   this->Superclass::CopyStructure(ds);
@@ -456,6 +611,78 @@ void vtkUnstructuredGrid::Cleanup()
     this->FaceLocations->UnRegister(this);
     this->FaceLocations = NULL;
     }
+
+  this->SingleCellType = -1;
+  this->SingleCellSize = 0;
+
+  this->ReleasePolyhedronTopology();
+}
+
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::ReleasePolyhedronTopology()
+{
+  if ( this->PolyhedronTopology )
+    {
+    this->PolyhedronTopology->Delete();
+    this->PolyhedronTopology = NULL;
+    }
+  if ( this->PolyhedronTopologyLocations )
+    {
+    this->PolyhedronTopologyLocations->Delete();
+    this->PolyhedronTopologyLocations = NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::BuildPolyhedronTopology()
+{
+  this->ReleasePolyhedronTopology();
+  this->PolyhedronTopology = vtkIdTypeArray::New();
+  this->PolyhedronTopologyLocations = vtkIdTypeArray::New();
+
+  vtkIdType numCells = this->GetNumberOfCells();
+  this->PolyhedronTopologyLocations->SetNumberOfValues(numCells);
+  vtkIdType *locations = this->PolyhedronTopologyLocations->GetPointer(0);
+  vtkNew<vtkPolyhedron> polyhedron;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    if ( this->GetCellType(cellId) != VTK_POLYHEDRON )
+      {
+      locations[cellId] = -1;
+      continue;
+      }
+
+    // Only the point ids and the faces matter for the topology
+    this->Connectivity->GetCell(this->GetCellLocation(cellId),
+                                polyhedron->PointIds);
+    polyhedron->Points->SetNumberOfPoints(
+      polyhedron->PointIds->GetNumberOfIds());
+    polyhedron->SetFaces(this->GetFaces(cellId));
+    polyhedron->Initialize();
+    locations[cellId] = this->PolyhedronTopology->GetNumberOfTuples();
+    polyhedron->GetCanonicalTopology(this->PolyhedronTopology);
+    }
+  this->PolyhedronTopologyTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+// The cache is released when the cells are replaced or modified through
+// the grid; it is also out of date when cells were inserted, or when the
+// connectivity or the faces were modified directly.
+vtkIdType *vtkUnstructuredGrid::GetPolyhedronTopology(vtkIdType cellId)
+{
+  if ( !this->PolyhedronTopology ||
+       this->PolyhedronTopologyLocations->GetNumberOfTuples() !=
+       this->GetNumberOfCells() ||
+       this->PolyhedronTopologyTime < this->Connectivity->GetMTime() ||
+       (this->Faces &&
+        this->PolyhedronTopologyTime < this->Faces->GetMTime()) )
+    {
+    this->BuildPolyhedronTopology();
+    }
+
+  vtkIdType loc = this->PolyhedronTopologyLocations->GetValue(cellId);
+  return loc < 0 ? NULL : this->PolyhedronTopology->GetPointer(loc);
 }
 
 //----------------------------------------------------------------------------
@@ -476,9 +703,10 @@ void vtkUnstructuredGrid::Initialize()
 //----------------------------------------------------------------------------
 int vtkUnstructuredGrid::GetCellType(vtkIdType cellId)
 {
-
-  vtkDebugMacro(<< "Returning cell type " << static_cast<int>(this->Types->GetValue(cellId)));
-  return static_cast<int>(this->Types->GetValue(cellId));
+  int cellType = (this->SingleCellType >= 0 ? this->SingleCellType :
+                  static_cast<int>(this->Types->GetValue(cellId)));
+  vtkDebugMacro(<< "Returning cell type " << cellType);
+  return cellType;
 }
 
 //----------------------------------------------------------------------------
@@ -489,11 +717,12 @@ vtkCell *vtkUnstructuredGrid::GetCell(vtkIdType cellId)
   vtkCell *cell = NULL;
   vtkIdType *pts, numPts;
 
-  loc = this->Locations->GetValue(cellId);
+  loc = this->GetCellLocation(cellId);
   vtkDebugMacro(<< "location = " <<  loc);
   this->Connectivity->GetCell(loc,numPts,pts);
 
-  int cellType = static_cast<int>(this->Types->GetValue(cellId));
+  int cellType = (this->SingleCellType >= 0 ? this->SingleCellType :
+                  static_cast<int>(this->Types->GetValue(cellId)));
   switch (cellType)
     {
     case VTK_VERTEX:
@@ -797,6 +1026,15 @@ vtkCell *vtkUnstructuredGrid::GetCell(vtkIdType cellId)
     cell->Initialize();
     }
 
+  if ( cell == this->Polyhedron && this->CachePolyhedronTopology )
+    {
+    vtkIdType *topology = this->GetPolyhedronTopology(cellId);
+    if ( topology )
+      {
+      this->Polyhedron->SetCanonicalTopology(topology);
+      }
+    }
+
   return cell;
 }
 
@@ -804,17 +1042,14 @@ vtkCell *vtkUnstructuredGrid::GetCell(vtkIdType cellId)
 void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
 {
   vtkIdType loc;
-  vtkIdType *pts, numPts;
 
-  int cellType = static_cast<int>(this->Types->GetValue(cellId));
+  int cellType = (this->SingleCellType >= 0 ? this->SingleCellType :
+                  static_cast<int>(this->Types->GetValue(cellId)));
   cell->SetCellType(cellType);
 
-  loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
-
-  cell->PointIds->SetNumberOfIds(numPts);
+  loc = this->GetCellLocation(cellId);
+  this->Connectivity->GetCell(loc,cell->PointIds);
 
-  std::copy(pts, pts + numPts, cell->PointIds->GetPointer(0));
   this->Points->GetPoints(cell->PointIds, cell->Points);
 
   // Explicit face representation
@@ -829,6 +1064,16 @@ void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
     {
     cell->Initialize();
     }
+
+  if ( cellType == VTK_POLYHEDRON && this->CachePolyhedronTopology )
+    {
+    vtkIdType *topology = this->GetPolyhedronTopology(cellId);
+    if ( topology )
+      {
+      static_cast<vtkPolyhedron*>(cell->GetRepresentativeCell())->
+        SetCanonicalTopology(topology);
+      }
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -839,10 +1084,17 @@ void vtkUnstructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
   vtkIdType i;
   vtkIdType loc;
   double x[3];
-  vtkIdType *pts, numPts;
+  const vtkIdType *pts;
+  vtkIdType numPts;
 
-  loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
+  // 32 bit cell arrays copy the point ids; keep this method thread safe.
+  vtkSmartPointer<vtkIdList> ptIds;
+  if ( !this->Connectivity->IsStorageShareable() )
+    {
+    ptIds = vtkSmartPointer<vtkIdList>::New();
+    }
+  loc = this->GetCellLocation(cellId);
+  this->Connectivity->GetCell(loc,numPts,pts,ptIds);
 
   // carefully compute the bounds
   if (numPts)
@@ -899,6 +1151,16 @@ vtkIdType vtkUnstructuredGrid::GetNumberOfCells()
 // polyhedron cells.
 vtkIdType vtkUnstructuredGrid::InsertNextCell(int type, vtkIdList *ptIds)
 {
+  if (this->SingleCellType >= 0)
+    {
+    if (type == this->SingleCellType &&
+        ptIds->GetNumberOfIds() == this->SingleCellSize)
+      {
+      return this->Connectivity->InsertNextCell(ptIds);
+      }
+    this->BuildTypesAndLocations();
+    }
+
   if (type == VTK_POLYHEDRON)
     {
     // For polyhedron cell, input ptIds is of format:
@@ -933,6 +1195,15 @@ vtkIdType vtkUnstructuredGrid::InsertNextCell(int type, vtkIdList *ptIds)
 vtkIdType vtkUnstructuredGrid::InsertNextCell(int type, vtkIdType npts,
                                               vtkIdType *ptIds)
 {
+  if (this->SingleCellType >= 0)
+    {
+    if (type == this->SingleCellType && npts == this->SingleCellSize)
+      {
+      return this->Connectivity->InsertNextCell(npts,ptIds);
+      }
+    this->BuildTypesAndLocations();
+    }
+
   if (type != VTK_POLYHEDRON)
     {
     // insert connectivity
@@ -971,13 +1242,14 @@ vtkIdType vtkUnstructuredGrid::InsertNextCell(int type, vtkIdType npts,
         }
       }
 
-    // insert cell location
-    this->Locations->InsertNextValue(this->Connectivity->GetData()->GetMaxId()+1);
     // insert face location
     this->FaceLocations->InsertNextValue(this->Faces->GetMaxId()+1);
     // insert cell connectivity and faces stream
     vtkUnstructuredGrid::DecomposeAPolyhedronCell(
         npts, ptIds, realnpts, this->Connectivity, this->Faces);
+    // insert cell location
+    this->Locations->InsertNextValue(
+      this->Connectivity->GetInsertLocation(realnpts));
     }
 
   return this->Types->InsertNextValue(static_cast<unsigned char>(type));
@@ -991,6 +1263,11 @@ vtkIdType vtkUnstructuredGrid::
 InsertNextCell(int type, vtkIdType npts, vtkIdType *pts,
                vtkIdType nfaces, vtkIdType *faces)
 {
+  if (this->SingleCellType >= 0)
+    {
+    this->BuildTypesAndLocations();
+    }
+
   // Insert connectivity (points that make up polyhedron)
   this->Connectivity->InsertNextCell(npts,pts);
 
@@ -1044,6 +1321,11 @@ int vtkUnstructuredGrid::InitializeFacesRepresentation(vtkIdType numPrevCells)
     return 0;
     }
 
+  if (this->SingleCellType >= 0)
+    {
+    this->BuildTypesAndLocations();
+    }
+
   this->Faces = vtkIdTypeArray::New();
   this->Faces->Allocate(this->Types->GetSize());
 
@@ -1077,6 +1359,25 @@ vtkIdType *vtkUnstructuredGrid::GetFaces(vtkIdType cellId)
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::SetCells(int type, vtkCellArray *cells)
 {
+  // Cells of the same size use the single cell type storage.
+  if (type != VTK_POLYHEDRON && cells->GetNumberOfCells() > 0)
+    {
+    vtkIdType cellSize = -1, npts, *pts;
+    bool sameSize = true;
+    for (cells->InitTraversal(); sameSize && cells->GetNextCell(npts,pts); )
+      {
+      cellSize = (cellSize < 0 ? npts : cellSize);
+      sameSize = (npts == cellSize);
+      }
+    if (sameSize)
+      {
+      this->SetCells(NULL, NULL, cells, NULL, NULL);
+      this->SingleCellType = type;
+      this->SingleCellSize = cellSize;
+      return;
+      }
+    }
+
   int *types = new int [cells->GetNumberOfCells()];
   for (vtkIdType i = 0; i < cells->GetNumberOfCells(); i++)
     {
@@ -1234,6 +1535,11 @@ void vtkUnstructuredGrid::SetCells(vtkUnsignedCharArray *cellTypes,
                                    vtkIdTypeArray *faceLocations,
                                    vtkIdTypeArray *faces)
 {
+  this->ReleasePolyhedronTopology();
+
+  this->SingleCellType = -1;
+  this->SingleCellSize = 0;
+
   if ( this->Connectivity )
     {
     this->Connectivity->UnRegister(this);
@@ -1304,17 +1610,18 @@ void vtkUnstructuredGrid::BuildLinks()
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
 {
-  vtkIdType i, loc;
-  vtkIdType *pts, numPts;
-
-  loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
-  ptIds->SetNumberOfIds(numPts);
-  for (i=0; i<numPts; i++)
-    {
-    ptIds->SetId(i,pts[i]);
-    }
+  vtkIdType loc = this->GetCellLocation(cellId);
+  this->Connectivity->GetCell(loc,ptIds);
+}
 
+//----------------------------------------------------------------------------
+// Point ids of a cell without a copy, unless the connectivity is 32 bit.
+void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                                        const vtkIdType*& pts,
+                                        vtkIdList *ptIds)
+{
+  vtkIdType loc = this->GetCellLocation(cellId);
+  this->Connectivity->GetCell(loc,npts,pts,ptIds);
 }
 
 //----------------------------------------------------------------------------
@@ -1325,7 +1632,7 @@ void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
 {
   vtkIdType loc;
 
-  loc = this->Locations->GetValue(cellId);
+  loc = this->GetCellLocation(cellId);
 
   this->Connectivity->GetCell(loc,npts,pts);
 }
@@ -1418,6 +1725,8 @@ vtkCellIterator *vtkUnstructuredGrid::NewCellIterator()
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::Reset()
 {
+  this->ReleasePolyhedronTopology();
+
   if ( this->Connectivity )
     {
     this->Connectivity->Reset();
@@ -1514,7 +1823,9 @@ void vtkUnstructuredGrid::ReplaceCell(vtkIdType cellId, int npts,
 {
   vtkIdType loc;
 
-  loc = this->Locations->GetValue(cellId);
+  this->ReleasePolyhedronTopology();
+
+  loc = this->GetCellLocation(cellId);
   this->Connectivity->ReplaceCell(loc,npts,pts);
 }
 
@@ -1572,12 +1883,20 @@ unsigned long vtkUnstructuredGrid::GetActualMemorySize()
     size += this->FaceLocations->GetActualMemorySize();
     }
 
+  if ( this->PolyhedronTopology )
+    {
+    size += this->PolyhedronTopology->GetActualMemorySize();
+    size += this->PolyhedronTopologyLocations->GetActualMemorySize();
+    }
+
   return size;
 }
 
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::ShallowCopy(vtkDataObject *dataObject)
 {
+  this->ReleasePolyhedronTopology();
+
   if (vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(dataObject))
     {
     // I do not know if this is correct but.
@@ -1641,6 +1960,9 @@ void vtkUnstructuredGrid::ShallowCopy(vtkDataObject *dataObject)
       {
       this->FaceLocations->Register(this);
       }
+
+    this->SingleCellType = grid->SingleCellType;
+    this->SingleCellSize = grid->SingleCellSize;
     }
   else if (vtkUnstructuredGridBase *ugb =
            vtkUnstructuredGridBase::SafeDownCast(dataObject))
@@ -1666,6 +1988,8 @@ void vtkUnstructuredGrid::ShallowCopy(vtkDataObject *dataObject)
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::DeepCopy(vtkDataObject *dataObject)
 {
+  this->ReleasePolyhedronTopology();
+
   vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(dataObject);
 
   if ( grid != NULL )
@@ -1740,6 +2064,9 @@ void vtkUnstructuredGrid::DeepCopy(vtkDataObject *dataObject)
       this->FaceLocations->Delete();
       }
 
+    this->SingleCellType = grid->SingleCellType;
+    this->SingleCellSize = grid->SingleCellSize;
+
     // Skip the unstructured grid base implementation, as it uses a less
     // efficient method of copying cell data.
     this->vtkUnstructuredGridBase::Superclass::DeepCopy(grid);
@@ -1766,6 +2093,10 @@ void vtkUnstructuredGrid::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Pieces: " << this->GetNumberOfPieces() << endl;
   os << indent << "Piece: " << this->GetPiece() << endl;
   os << indent << "Ghost Level: " << this->GetGhostLevel() << endl;
+  os << indent << "Single Cell Type: " << this->SingleCellType << endl;
+  os << indent << "Single Cell Size: " << this->SingleCellSize << endl;
+  os << indent << "Cache Polyhedron Topology: "
+     << (this->CachePolyhedronTopology ? "On" : "Off") << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -1846,6 +2177,11 @@ void vtkUnstructuredGrid::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
 //----------------------------------------------------------------------------
 int vtkUnstructuredGrid::IsHomogeneous()
 {
+  if (this->SingleCellType >= 0)
+    {
+    return (this->GetNumberOfCells() > 0 ? 1 : 0);
+    }
+
   unsigned char type;
   if (this->Types && this->Types->GetMaxId() >= 0)
     {
@@ -1866,6 +2202,18 @@ int vtkUnstructuredGrid::IsHomogeneous()
 // Fill container with indices of cells which match given type.
 void vtkUnstructuredGrid::GetIdsOfCellsOfType(int type, vtkIdTypeArray *array)
 {
+  if (this->SingleCellType >= 0)
+    {
+    if (type == this->SingleCellType)
+      {
+      for (vtkIdType cellId = 0; cellId < this->GetNumberOfCells(); cellId++)
+        {
+        array->InsertNextValue(cellId);
+        }
+      }
+    return;
+    }
+
   for (int cellId = 0; cellId < this->GetNumberOfCells(); cellId++)
     {
     if (static_cast<int>(Types->GetValue(cellId)) == type)
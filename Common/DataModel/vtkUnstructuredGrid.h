@@ -89,6 +89,25 @@ public:
   // extSize is no longer used.
   virtual void Allocate(vtkIdType numCells=1000, int extSize=1000);
 
+  // Description:
+  // Allocate storage for cells all of the same type (other than
+  // VTK_POLYHEDRON) and number of points. With this single cell type
+  // storage, the grid keeps no cell types and cell locations arrays: the
+  // type of a cell and its location in the connectivity follow from its
+  // id, so that GetCell(), GetCellType() and GetCellPoints() reduce to index
+  // arithmetic. Inserting a cell of another type or size, or calling
+  // GetCellTypesArray() or GetCellLocationsArray(), switches to the general
+  // storage. SetCells(int type, vtkCellArray *cells) also selects this
+  // storage when all the cells have the same number of points.
+  void AllocateSingleCellType(int type, int npts, vtkIdType numCells=1000);
+
+  // Description:
+  // With single cell type storage, return the type and the number of points
+  // of all the cells; otherwise return -1 and 0. Filters may use this to
+  // select kernels specialized for one cell type.
+  vtkGetMacro(SingleCellType, int);
+  vtkGetMacro(SingleCellSize, vtkIdType);
+
   // Description:
   // Insert/create cell in object by type and list of point ids defining
   // cell topology. Most cells require just a type which implicitly defines
@@ -124,6 +143,11 @@ public:
   // Standard vtkDataSet methods; see vtkDataSet.h for documentation.
   void Reset();
   virtual void CopyStructure(vtkDataSet *ds);
+
+  // Description:
+  // Get the topology MTime, which considers the MTime of the connectivity,
+  // cell types and locations, and polyhedron faces.
+  virtual unsigned long GetTopologyMTime();
   vtkIdType GetNumberOfCells();
   virtual vtkCell *GetCell(vtkIdType cellId);
   virtual void GetCell(vtkIdType cellId, vtkGenericCell *cell);
@@ -133,8 +157,14 @@ public:
   vtkCellIterator* NewCellIterator();
 
   int GetCellType(vtkIdType cellId);
-  vtkUnsignedCharArray* GetCellTypesArray() { return this->Types; }
-  vtkIdTypeArray* GetCellLocationsArray() { return this->Locations; }
+
+  // Description:
+  // Get the cell types array and the locations of the cells in the
+  // connectivity. With single cell type storage, these arrays are built at
+  // the first call and the grid switches to the general storage.
+  vtkUnsignedCharArray* GetCellTypesArray();
+  vtkIdTypeArray* GetCellLocationsArray();
+
   void Squeeze();
   void Initialize();
   int GetMaxCellSize();
@@ -142,6 +172,8 @@ public:
   vtkCellLinks *GetCellLinks() {return this->Links;};
   virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
                              vtkIdType* &pts);
+  virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                             const vtkIdType*& pts, vtkIdList *ptIds);
 
   // Description:
   // Get the face stream of a polyhedron cell in the following format:
@@ -248,6 +280,18 @@ public:
   vtkIdTypeArray* GetFaces(){return this->Faces;};
   vtkIdTypeArray* GetFaceLocations(){return this->FaceLocations;};
 
+  // Description:
+  // Set/Get whether the faces and edges of the polyhedron cells, in
+  // canonical point ids, are derived once for the whole grid and kept,
+  // instead of being rebuilt from the face stream by each GetCell(). The
+  // cache is built by BuildPolyhedronTopology() or by the first GetCell()
+  // of a polyhedron after the grid changed; call it before using
+  // GetCell(vtkIdType, vtkGenericCell*) from several threads. Off by default.
+  vtkSetMacro(CachePolyhedronTopology, bool);
+  vtkGetMacro(CachePolyhedronTopology, bool);
+  vtkBooleanMacro(CachePolyhedronTopology, bool);
+  void BuildPolyhedronTopology();
+
   // Description:
   // Special function used by vtkUnstructuredGridReader.
   // By default vtkUnstructuredGrid does not contain face information, which is
@@ -369,12 +413,37 @@ protected:
   vtkIdTypeArray *Faces;
   vtkIdTypeArray *FaceLocations;
 
+  // Type and number of points of all the cells with single cell type
+  // storage, in which case Types and Locations are NULL. SingleCellType is
+  // -1 with the general storage.
+  int SingleCellType;
+  vtkIdType SingleCellSize;
+
+  // Topology of the polyhedron cells in the format of
+  // vtkPolyhedron::GetCanonicalTopology(), and its location for each cell
+  // (-1 for the other cells). Both are NULL until the cache is built.
+  bool CachePolyhedronTopology;
+  vtkIdTypeArray *PolyhedronTopology;
+  vtkIdTypeArray *PolyhedronTopologyLocations;
+  vtkTimeStamp PolyhedronTopologyTime;
+
 private:
   // Hide these from the user and the compiler.
   vtkUnstructuredGrid(const vtkUnstructuredGrid&);  // Not implemented.
   void operator=(const vtkUnstructuredGrid&);  // Not implemented.
 
   void Cleanup();
+
+  // Location of a cell in the connectivity, for both storages.
+  vtkIdType GetCellLocation(vtkIdType cellId);
+
+  // Build the cell types and locations arrays of the single cell type
+  // storage, and switch to the general storage.
+  void BuildTypesAndLocations();
+
+  // The cached topology of a polyhedron cell, built if out of date.
+  vtkIdType *GetPolyhedronTopology(vtkIdType cellId);
+  void ReleasePolyhedronTopology();
 };
 
 #endif
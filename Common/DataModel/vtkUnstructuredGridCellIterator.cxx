@@ -34,10 +34,10 @@ void vtkUnstructuredGridCellIterator::PrintSelf(ostream &os, vtkIndent indent)
   // interpreting them as strings.
   os << indent << "CellTypeBegin: "
      << static_cast<void*>(this->CellTypeBegin) << endl;
-  os << indent << "CellTypePtr: "
-     << static_cast<void*>(this->CellTypePtr) << endl;
-  os << indent << "CellTypeEnd: "
-     << static_cast<void*>(this->CellTypeEnd) << endl;
+  os << indent << "CellId: " << this->CellId << endl;
+  os << indent << "NumberOfCells: " << this->NumberOfCells << endl;
+  os << indent << "SingleCellType: " << this->SingleCellType << endl;
+  os << indent << "SingleCellSize: " << this->SingleCellSize << endl;
   os << indent << "ConnectivityBegin: " << this->ConnectivityBegin << endl;
   os << indent << "ConnectivityPtr: " << this->ConnectivityPtr << endl;
   os << indent << "FacesBegin: " << this->FacesBegin<< endl;
@@ -52,17 +52,23 @@ void vtkUnstructuredGridCellIterator::PrintSelf(ostream &os, vtkIndent indent)
 void vtkUnstructuredGridCellIterator::SetUnstructuredGrid(
     vtkUnstructuredGrid *ug)
 {
-  // If the unstructured grid has not been initialized yet, these may not exist:
-  vtkUnsignedCharArray *cellTypeArray = ug ? ug->GetCellTypesArray() : NULL;
+  // If the unstructured grid has not been initialized yet, these may not exist.
+  // Grids with a single cell type have no cell types array.
+  bool singleCellType = ug && ug->GetSingleCellType() >= 0;
+  vtkUnsignedCharArray *cellTypeArray =
+    ug && !singleCellType ? ug->GetCellTypesArray() : NULL;
   vtkCellArray *cellArray = ug ? ug->GetCells() : NULL;
   vtkPoints *points = ug ? ug->GetPoints() : NULL;
 
-  if (ug && cellTypeArray && cellArray && points)
+  if (ug && (cellTypeArray || singleCellType) && cellArray && points)
     {
     // Cell types
-    this->CellTypeBegin = this->CellTypeEnd = this->CellTypePtr
-        = cellTypeArray ? cellTypeArray->GetPointer(0) : NULL;
-    this->CellTypeEnd += cellTypeArray ? cellTypeArray->GetNumberOfTuples() : 0;
+    this->CellTypeBegin = cellTypeArray ? cellTypeArray->GetPointer(0) : NULL;
+    this->CellId = 0;
+    this->NumberOfCells = cellTypeArray ? cellTypeArray->GetNumberOfTuples() :
+      cellArray->GetNumberOfCells();
+    this->SingleCellType = ug->GetSingleCellType();
+    this->SingleCellSize = ug->GetSingleCellSize();
 
     // CellArray
     this->ConnectivityBegin = this->ConnectivityPtr = cellArray->GetPointer();
@@ -88,8 +94,10 @@ void vtkUnstructuredGridCellIterator::SetUnstructuredGrid(
   else
     {
     this->CellTypeBegin = NULL;
-    this->CellTypePtr = NULL;
-    this->CellTypeEnd = NULL;
+    this->CellId = 0;
+    this->NumberOfCells = 0;
+    this->SingleCellType = -1;
+    this->SingleCellSize = 0;
     this->FacesBegin = NULL;
     this->FacesLocsBegin = NULL;
     this->FacesLocsPtr = NULL;
@@ -107,6 +115,13 @@ void vtkUnstructuredGridCellIterator::CatchUpSkippedCells()
   // catch up on skipped cells -- cache misses make incrementing Connectivity
   // in IncrementToNextCell() too expensive, so we delay it until here. Special
   // cases are used for 0 or 1 skipped cells to reduce the number of jumps.
+  // Cells of a single type and size are skipped at once.
+  if (!this->CellTypeBegin)
+    {
+    this->ConnectivityPtr += this->SkippedCells * (this->SingleCellSize + 1);
+    this->SkippedCells = 0;
+    return;
+    }
   switch (this->SkippedCells)
     {
     default:
@@ -130,19 +145,19 @@ void vtkUnstructuredGridCellIterator::CatchUpSkippedCells()
 //------------------------------------------------------------------------------
 bool vtkUnstructuredGridCellIterator::IsDoneWithTraversal()
 {
-  return this->CellTypePtr >= this->CellTypeEnd;
+  return this->CellId >= this->NumberOfCells;
 }
 
 //------------------------------------------------------------------------------
 vtkIdType vtkUnstructuredGridCellIterator::GetCellId()
 {
-  return static_cast<vtkIdType>(this->CellTypePtr - this->CellTypeBegin);
+  return this->CellId;
 }
 
 //------------------------------------------------------------------------------
 void vtkUnstructuredGridCellIterator::IncrementToNextCell()
 {
-  ++this->CellTypePtr;
+  ++this->CellId;
 
   // Bookkeeping for ConnectivityPtr
   ++this->SkippedCells;
@@ -156,8 +171,10 @@ void vtkUnstructuredGridCellIterator::IncrementToNextCell()
 vtkUnstructuredGridCellIterator::vtkUnstructuredGridCellIterator()
   : vtkCellIterator(),
     CellTypeBegin(NULL),
-    CellTypePtr(NULL),
-    CellTypeEnd(NULL),
+    CellId(0),
+    NumberOfCells(0),
+    SingleCellType(-1),
+    SingleCellSize(0),
     ConnectivityBegin(NULL),
     ConnectivityPtr(NULL),
     FacesBegin(NULL),
@@ -176,7 +193,7 @@ vtkUnstructuredGridCellIterator::~vtkUnstructuredGridCellIterator()
 //------------------------------------------------------------------------------
 void vtkUnstructuredGridCellIterator::ResetToFirstCell()
 {
-  this->CellTypePtr = this->CellTypeBegin;
+  this->CellId = 0;
   this->FacesLocsPtr = this->FacesLocsBegin;
   this->ConnectivityPtr = this->ConnectivityBegin;
   this->SkippedCells = 0;
@@ -185,7 +202,8 @@ void vtkUnstructuredGridCellIterator::ResetToFirstCell()
 //------------------------------------------------------------------------------
 void vtkUnstructuredGridCellIterator::FetchCellType()
 {
-  this->CellType = *this->CellTypePtr;
+  this->CellType = (this->CellTypeBegin ?
+                    this->CellTypeBegin[this->CellId] : this->SingleCellType);
 }
 
 //------------------------------------------------------------------------------
@@ -52,9 +52,13 @@ protected:
   friend class vtkUnstructuredGrid;
   void SetUnstructuredGrid(vtkUnstructuredGrid *ug);
 
+  // CellTypeBegin is NULL with the single cell type storage of the grid,
+  // whose cells all have SingleCellType and SingleCellSize points.
   unsigned char *CellTypeBegin;
-  unsigned char *CellTypePtr;
-  unsigned char *CellTypeEnd;
+  vtkIdType CellId;
+  vtkIdType NumberOfCells;
+  int SingleCellType;
+  vtkIdType SingleCellSize;
 
   vtkIdType *ConnectivityBegin;
   vtkIdType *ConnectivityPtr;
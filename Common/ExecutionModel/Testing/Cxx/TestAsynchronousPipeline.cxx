@@ -0,0 +1,164 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAsynchronousPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkAsynchronousPipeline updates a pipeline in a worker
+// thread, publishes the outputs of the updates that succeed and keeps the
+// previous output when an update is cancelled.
+
+#include "vtkAsynchronousPipeline.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+// A source of points that takes a millisecond per batch of 10 points and
+// stops when aborted.
+class vtkSlowPointSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkSlowPointSource *New();
+  vtkTypeMacro(vtkSlowPointSource, vtkPolyDataAlgorithm);
+  vtkSetMacro(NumberOfPoints, int);
+
+protected:
+  vtkSlowPointSource() : NumberOfPoints(100)
+  {
+    this->SetNumberOfInputPorts(0);
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+                  vtkInformationVector* outputVector)
+  {
+    vtkPolyData *output = vtkPolyData::GetData(outputVector);
+    vtkNew<vtkPoints> points;
+    for (int i = 0; i < this->NumberOfPoints && !this->GetAbortExecute(); ++i)
+      {
+      if (i % 10 == 0)
+        {
+        this->UpdateProgress(static_cast<double>(i) / this->NumberOfPoints);
+        vtksys::SystemTools::Delay(1);
+        }
+      points->InsertNextPoint(i, 0, 0);
+      }
+    output->SetPoints(points.GetPointer());
+    return 1;
+  }
+
+  int NumberOfPoints;
+
+private:
+  vtkSlowPointSource(const vtkSlowPointSource&);  // Not implemented.
+  void operator=(const vtkSlowPointSource&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkSlowPointSource);
+
+// The number of points of the published output.
+static vtkIdType PublishedPoints(vtkAsynchronousPipeline *executive)
+{
+  vtkPolyData *output =
+    vtkPolyData::SafeDownCast(executive->GetPublishedOutputData(0));
+  return output ? output->GetNumberOfPoints() : -1;
+}
+
+int TestAsynchronousPipeline(int, char *[])
+{
+  vtkNew<vtkSlowPointSource> source;
+  vtkNew<vtkElevationFilter> elevation;
+  vtkNew<vtkAsynchronousPipeline> executive;
+  elevation->SetExecutive(executive.GetPointer());
+  elevation->SetInputConnection(source->GetOutputPort());
+
+  TEST_ASSERT(executive->GetUpdateStatus() ==
+              vtkAsynchronousPipeline::UPDATE_NOT_STARTED &&
+              !executive->GetPublishedOutputData(0) &&
+              !executive->WaitForUpdate(), "Bad initial state");
+
+  // Poll the update until it is done.
+  TEST_ASSERT(executive->StartUpdate(), "Update not started");
+  TEST_ASSERT(!executive->StartUpdate(), "Two updates started");
+  while (executive->IsUpdateRunning())
+    {
+    TEST_ASSERT(!executive->GetPublishedOutputData(0),
+                "Output published while running");
+    vtksys::SystemTools::Delay(1);
+    }
+  TEST_ASSERT(executive->GetUpdateStatus() ==
+              vtkAsynchronousPipeline::UPDATE_SUCCEEDED &&
+              executive->WaitForUpdate(), "Update failed");
+  TEST_ASSERT(PublishedPoints(executive.GetPointer()) == 100 &&
+              executive->GetPublishedOutputData(0) !=
+              elevation->GetOutput() &&
+              executive->GetUpdateProgress() == 1.0, "Bad published output");
+
+  // The published output does not change while the next update executes.
+  vtkDataObject *published = executive->GetPublishedOutputData(0);
+  source->SetNumberOfPoints(2000);
+  TEST_ASSERT(executive->StartUpdate(), "Second update not started");
+  TEST_ASSERT(executive->GetPublishedOutputData(0) == published &&
+              PublishedPoints(executive.GetPointer()) == 100,
+              "Published output changed while running");
+  TEST_ASSERT(executive->WaitForUpdate() &&
+              PublishedPoints(executive.GetPointer()) == 2000,
+              "Second output not published");
+
+  // A cancelled update keeps the previous output, and the next update
+  // executes the aborted algorithms again.
+  source->SetNumberOfPoints(3000);
+  TEST_ASSERT(executive->StartUpdate(), "Third update not started");
+  while (source->GetProgress() <= 0.0 || source->GetProgress() >= 1.0)
+    {
+    vtksys::SystemTools::Delay(1);
+    }
+  executive->CancelUpdate();
+  TEST_ASSERT(!executive->WaitForUpdate() &&
+              executive->GetUpdateStatus() ==
+              vtkAsynchronousPipeline::UPDATE_CANCELLED,
+              "Update not cancelled");
+  TEST_ASSERT(PublishedPoints(executive.GetPointer()) == 2000,
+              "Cancelled output published");
+  TEST_ASSERT(!source->GetAbortExecute() && !elevation->GetAbortExecute(),
+              "Abort flags left set");
+  elevation->Update();
+  TEST_ASSERT(elevation->GetOutput()->GetNumberOfPoints() == 3000,
+              "Aborted algorithms not executed again");
+
+  // Cancelling before the source reports progress.
+  source->SetNumberOfPoints(400);
+  TEST_ASSERT(executive->StartUpdate(), "Fourth update not started");
+  executive->CancelUpdate();
+  TEST_ASSERT(!executive->WaitForUpdate() &&
+              PublishedPoints(executive.GetPointer()) == 2000,
+              "Early cancelled output published");
+  TEST_ASSERT(executive->StartUpdate() && executive->WaitForUpdate() &&
+              PublishedPoints(executive.GetPointer()) == 400,
+              "Update after cancel failed");
+  return EXIT_SUCCESS;
+}
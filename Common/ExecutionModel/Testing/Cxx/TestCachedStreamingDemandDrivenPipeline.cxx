@@ -0,0 +1,164 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCachedStreamingDemandDrivenPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkCachedStreamingDemandDrivenPipeline with a memory limit
+// satisfies the time steps already requested without executing the
+// algorithm, evicts the least recently used outputs, and is emptied when
+// the algorithm is modified.
+
+#include "vtkCachedStreamingDemandDrivenPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+// A source with time steps 0 to 4 whose points are at x = time.
+class vtkTimePointSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTimePointSource *New();
+  vtkTypeMacro(vtkTimePointSource, vtkPolyDataAlgorithm);
+  vtkGetMacro(NumberOfExecutions, int);
+
+protected:
+  vtkTimePointSource() : NumberOfExecutions(0)
+  {
+    this->SetNumberOfInputPorts(0);
+  }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+                         vtkInformationVector* outputVector)
+  {
+    vtkInformation *outInfo = outputVector->GetInformationObject(0);
+    double steps[5] = { 0, 1, 2, 3, 4 };
+    double range[2] = { 0, 4 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps, 5);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+                  vtkInformationVector* outputVector)
+  {
+    ++this->NumberOfExecutions;
+    vtkInformation *outInfo = outputVector->GetInformationObject(0);
+    vtkPolyData *output = vtkPolyData::GetData(outputVector);
+    double time =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    vtkNew<vtkPoints> points;
+    for (int i = 0; i < 10000; ++i)
+      {
+      points->InsertNextPoint(time, i, 0);
+      }
+    output->SetPoints(points.GetPointer());
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+
+  int NumberOfExecutions;
+
+private:
+  vtkTimePointSource(const vtkTimePointSource&);  // Not implemented.
+  void operator=(const vtkTimePointSource&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkTimePointSource);
+
+// Update the source for the time step and check the output.
+static bool UpdateTime(vtkTimePointSource *source, double time)
+{
+  source->UpdateTimeStep(time);
+  vtkPolyData *output = source->GetOutput();
+  return output->GetNumberOfPoints() == 10000 &&
+    output->GetPoint(0)[0] == time &&
+    output->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) == time;
+}
+
+int TestCachedStreamingDemandDrivenPipeline(int, char *[])
+{
+  vtkNew<vtkTimePointSource> source;
+  vtkNew<vtkCachedStreamingDemandDrivenPipeline> executive;
+  executive->SetCacheMemoryLimit(1000000);
+  source->SetExecutive(executive.GetPointer());
+
+  // Going back to the time steps already loaded does not execute.
+  for (int t = 0; t < 3; ++t)
+    {
+    TEST_ASSERT(UpdateTime(source.GetPointer(), t), "Bad output");
+    }
+  TEST_ASSERT(source->GetNumberOfExecutions() == 3 &&
+              executive->GetNumberOfCachedOutputs() == 3 &&
+              executive->GetCacheMisses() == 3 &&
+              executive->GetCacheHits() == 0, "Bad first pass");
+  for (int t = 2; t >= 0; --t)
+    {
+    TEST_ASSERT(UpdateTime(source.GetPointer(), t), "Bad cached output");
+    }
+  TEST_ASSERT(source->GetNumberOfExecutions() == 3 &&
+              executive->GetCacheHits() == 3, "Cached outputs not used");
+
+  // The same request again is satisfied by the output itself.
+  TEST_ASSERT(UpdateTime(source.GetPointer(), 0), "Bad output");
+  TEST_ASSERT(executive->GetCacheHits() == 3 &&
+              executive->GetCacheMisses() == 3, "Output not reused");
+
+  // Modifying the source empties the cache.
+  source->Modified();
+  TEST_ASSERT(UpdateTime(source.GetPointer(), 1), "Bad modified output");
+  TEST_ASSERT(source->GetNumberOfExecutions() == 4 &&
+              executive->GetNumberOfCachedOutputs() == 1,
+              "Cache not emptied");
+
+  // A limit for two outputs evicts the least recently used one.
+  unsigned long size = executive->GetCacheMemorySize();
+  TEST_ASSERT(size > 0, "Bad memory size");
+  executive->SetCacheMemoryLimit(2 * size);
+  TEST_ASSERT(UpdateTime(source.GetPointer(), 0), "Bad output");
+  TEST_ASSERT(UpdateTime(source.GetPointer(), 1), "Bad output");
+  TEST_ASSERT(UpdateTime(source.GetPointer(), 2), "Bad output");
+  TEST_ASSERT(source->GetNumberOfExecutions() == 6 &&
+              executive->GetNumberOfCachedOutputs() == 2 &&
+              executive->GetCacheMemorySize() <= 2 * size,
+              "Bad eviction");
+  TEST_ASSERT(UpdateTime(source.GetPointer(), 1), "Bad output");
+  TEST_ASSERT(source->GetNumberOfExecutions() == 6, "Recent output evicted");
+  TEST_ASSERT(UpdateTime(source.GetPointer(), 0), "Bad output");
+  TEST_ASSERT(source->GetNumberOfExecutions() == 7, "Old output kept");
+
+  // Outputs larger than the limit are not cached.
+  executive->SetCacheMemoryLimit(size / 2);
+  TEST_ASSERT(executive->GetNumberOfCachedOutputs() == 0, "Cache not shrunk");
+  TEST_ASSERT(UpdateTime(source.GetPointer(), 3), "Bad output");
+  TEST_ASSERT(executive->GetNumberOfCachedOutputs() == 0 &&
+              executive->GetCacheMemorySize() == 0, "Large output cached");
+
+  executive->ResetCacheStatistics();
+  executive->ClearCache();
+  TEST_ASSERT(executive->GetCacheHits() == 0 &&
+              executive->GetCacheMisses() == 0, "Statistics not reset");
+  return EXIT_SUCCESS;
+}
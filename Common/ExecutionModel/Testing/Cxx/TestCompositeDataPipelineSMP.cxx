@@ -0,0 +1,205 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompositeDataPipelineSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the blocks of a composite input are executed concurrently
+// only by the algorithms that declare it, largest blocks first, and that
+// the outputs keep the structure of the input.
+
+#include "vtkAtomicTypes.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSMPTools.h"
+#include "vtkThreadedCompositeDataPipeline.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+// Copies its input and stamps it with the rank of its execution.
+class vtkTestBlockFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTestBlockFilter *New();
+  vtkTypeMacro(vtkTestBlockFilter, vtkPolyDataAlgorithm);
+
+  void SetThreadSafe(bool safe)
+  {
+    this->GetInformation()->Set(
+      vtkCompositeDataPipeline::CAN_EXECUTE_BLOCKS_CONCURRENTLY(), safe ? 1 : 0);
+  }
+
+  vtkAtomicIdType NumberOfExecutions;
+  vtkAtomicIdType NumberOfParallelExecutions;
+
+protected:
+  vtkTestBlockFilter() : NumberOfExecutions(0), NumberOfParallelExecutions(0) {}
+
+  int RequestData(vtkInformation *, vtkInformationVector **inputVector,
+                  vtkInformationVector *outputVector)
+  {
+    vtkPolyData *input = vtkPolyData::GetData(inputVector[0]);
+    vtkPolyData *output = vtkPolyData::GetData(outputVector);
+    output->ShallowCopy(input);
+    vtkNew<vtkIdTypeArray> rank;
+    rank->SetName("Rank");
+    rank->InsertNextValue(this->NumberOfExecutions++);
+    output->GetFieldData()->Initialize();
+    output->GetFieldData()->AddArray(rank.GetPointer());
+    if (vtkSMPTools::IsParallelScope())
+      {
+      ++this->NumberOfParallelExecutions;
+      }
+    return 1;
+  }
+
+private:
+  vtkTestBlockFilter(const vtkTestBlockFilter&);  // Not implemented.
+  void operator=(const vtkTestBlockFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkTestBlockFilter);
+
+static const int NumberOfBlocks = 24;
+
+// The number of points of block i, or 0 for the empty block.
+static int BlockSize(int i)
+{
+  return i == 5 ? 0 : 1 + (i * 7) % NumberOfBlocks;
+}
+
+// Execute the filter through executive and check the outputs. When serial,
+// the blocks must be executed in order; when ordered, they must be executed
+// by decreasing size.
+static int TestExecution(vtkMultiBlockDataSet *input,
+                         vtkCompositeDataPipeline *executive, bool threadSafe,
+                         bool parallel, bool ordered)
+{
+  vtkNew<vtkTestBlockFilter> filter;
+  filter->SetExecutive(executive);
+  filter->SetThreadSafe(threadSafe);
+  filter->SetInputData(input);
+  filter->Update();
+
+  vtkMultiBlockDataSet *output =
+    vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  TEST_ASSERT(output && output->GetNumberOfBlocks() == NumberOfBlocks,
+              "Bad output structure");
+  TEST_ASSERT(filter->NumberOfExecutions == NumberOfBlocks - 1,
+              "Bad number of executions " << filter->NumberOfExecutions);
+  TEST_ASSERT(filter->NumberOfParallelExecutions ==
+              (parallel ? NumberOfBlocks - 1 : 0),
+              "Bad number of parallel executions "
+              << filter->NumberOfParallelExecutions);
+
+  std::vector<bool> executed(NumberOfBlocks, false);
+  vtkIdType previousSize = VTK_ID_MAX;
+  for (vtkIdType rank = 0; rank < NumberOfBlocks - 1; ++rank)
+    {
+    for (int i = 0; i < NumberOfBlocks; ++i)
+      {
+      vtkPolyData *block = vtkPolyData::SafeDownCast(output->GetBlock(i));
+      if (i == 5)
+        {
+        TEST_ASSERT(!block, "Block " << i << " should be empty");
+        continue;
+        }
+      TEST_ASSERT(block && block->GetNumberOfPoints() == BlockSize(i),
+                  "Bad block " << i);
+      vtkIdTypeArray *ranks = vtkIdTypeArray::SafeDownCast(
+        block->GetFieldData()->GetArray("Rank"));
+      TEST_ASSERT(ranks, "Missing rank in block " << i);
+      if (ranks->GetValue(0) != rank)
+        {
+        continue;
+        }
+      TEST_ASSERT(!executed[i], "Block " << i << " executed twice");
+      executed[i] = true;
+      TEST_ASSERT(parallel || rank == (i < 5 ? i : i - 1),
+                  "Block " << i << " executed out of order");
+      TEST_ASSERT(!ordered || BlockSize(i) <= previousSize,
+                  "Block " << i << " executed before a larger block");
+      previousSize = BlockSize(i);
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+int TestCompositeDataPipelineSMP(int, char *[])
+{
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetNumberOfBlocks(NumberOfBlocks);
+  for (int i = 0; i < NumberOfBlocks; ++i)
+    {
+    if (BlockSize(i) == 0)
+      {
+      continue;
+      }
+    vtkNew<vtkPoints> points;
+    for (int p = 0; p < BlockSize(i); ++p)
+      {
+      points->InsertNextPoint(i, p, 0.0);
+      }
+    vtkNew<vtkPolyData> block;
+    block->SetPoints(points.GetPointer());
+    input->SetBlock(i, block.GetPointer());
+    }
+
+  // The blocks are scheduled by decreasing size; with more than one thread
+  // the order of execution is not deterministic.
+  const bool ordered = vtkSMPTools::GetEstimatedNumberOfThreads() == 1;
+
+  vtkNew<vtkCompositeDataPipeline> serial;
+  TEST_ASSERT(!serial->GetEnableSMP(), "EnableSMP should be off by default");
+  if (TestExecution(input.GetPointer(), serial.GetPointer(), true, false,
+                    false) != EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkCompositeDataPipeline> smp;
+  smp->EnableSMPOn();
+  if (TestExecution(input.GetPointer(), smp.GetPointer(), false, false,
+                    false) != EXIT_SUCCESS ||
+      TestExecution(input.GetPointer(), smp.GetPointer(), true, true,
+                    ordered) != EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkCompositeDataPipeline::SetGlobalDefaultEnableSMP(true);
+  vtkNew<vtkCompositeDataPipeline> global;
+  vtkCompositeDataPipeline::SetGlobalDefaultEnableSMP(false);
+  TEST_ASSERT(global->GetEnableSMP(), "Global default not applied");
+
+  // The threaded pipeline does not need the declaration.
+  vtkNew<vtkThreadedCompositeDataPipeline> threaded;
+  return TestExecution(input.GetPointer(), threaded.GetPointer(), false, true,
+                       ordered);
+}
@@ -0,0 +1,179 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConcurrentPipelineBranches.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the independent branches of the inputs of vtkAppendPolyData
+// are updated concurrently with the same result as sequentially, that a
+// source shared by two branches executes once, and that NON_REENTRANT()
+// sources execute one at a time.
+
+#include "vtkAppendPolyData.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSimpleCriticalSection.h"
+#include "vtkSmartPointer.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+// The number of sources executing, the largest number seen and the
+// number of executions.
+static vtkSimpleCriticalSection CountLock;
+static int Running = 0;
+static int MaxRunning = 0;
+static int Executions = 0;
+
+static void ResetCounts()
+{
+  Running = 0;
+  MaxRunning = 0;
+  Executions = 0;
+}
+
+// A source of points that takes a few milliseconds to execute.
+class vtkCountingPointSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkCountingPointSource *New();
+  vtkTypeMacro(vtkCountingPointSource, vtkPolyDataAlgorithm);
+  vtkSetMacro(NumberOfPoints, int);
+
+protected:
+  vtkCountingPointSource() : NumberOfPoints(100)
+  {
+    this->SetNumberOfInputPorts(0);
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+                  vtkInformationVector* outputVector)
+  {
+    CountLock.Lock();
+    ++Executions;
+    if (++Running > MaxRunning)
+      {
+      MaxRunning = Running;
+      }
+    CountLock.Unlock();
+
+    vtkPolyData *output = vtkPolyData::GetData(outputVector);
+    vtkNew<vtkPoints> points;
+    for (int i = 0; i < this->NumberOfPoints; ++i)
+      {
+      points->InsertNextPoint(i, 0, 0);
+      }
+    output->SetPoints(points.GetPointer());
+    vtksys::SystemTools::Delay(5);
+
+    CountLock.Lock();
+    --Running;
+    CountLock.Unlock();
+    return 1;
+  }
+
+  int NumberOfPoints;
+
+private:
+  vtkCountingPointSource(const vtkCountingPointSource&);  // Not implemented.
+  void operator=(const vtkCountingPointSource&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkCountingPointSource);
+
+int TestConcurrentPipelineBranches(int, char *[])
+{
+  const int numBranches = 8;
+  std::vector<vtkSmartPointer<vtkCountingPointSource> > sources;
+  vtkNew<vtkAppendPolyData> append;
+  vtkCompositeDataPipeline* executive =
+    vtkCompositeDataPipeline::SafeDownCast(append->GetExecutive());
+  TEST_ASSERT(executive && !executive->GetConcurrentBranches(),
+              "Concurrent branches enabled by default");
+  executive->ConcurrentBranchesOn();
+
+  int numPoints = 0;
+  for (int i = 0; i < numBranches; ++i)
+    {
+    vtkSmartPointer<vtkCountingPointSource> source =
+      vtkSmartPointer<vtkCountingPointSource>::New();
+    source->SetNumberOfPoints(100 * (i + 1));
+    numPoints += 100 * (i + 1);
+    vtkNew<vtkElevationFilter> elevation;
+    elevation->SetInputConnection(source->GetOutputPort());
+    append->AddInputConnection(elevation->GetOutputPort());
+    sources.push_back(source);
+    }
+
+  ResetCounts();
+  append->Update();
+  TEST_ASSERT(append->GetOutput()->GetNumberOfPoints() == numPoints,
+              "Bad number of points");
+  TEST_ASSERT(Executions == numBranches, "Bad number of executions");
+  std::cout << "Largest number of concurrent sources: " << MaxRunning
+            << std::endl;
+
+  // Only the modified branch executes again.
+  ResetCounts();
+  sources[3]->SetNumberOfPoints(10);
+  append->Update();
+  TEST_ASSERT(Executions == 1 &&
+              append->GetOutput()->GetNumberOfPoints() == numPoints - 390,
+              "Bad update of a single branch");
+
+  // A source shared by two connections is a single branch: it executes
+  // once.
+  vtkNew<vtkElevationFilter> shared1;
+  vtkNew<vtkElevationFilter> shared2;
+  shared1->SetInputConnection(sources[0]->GetOutputPort());
+  shared2->SetInputConnection(sources[0]->GetOutputPort());
+  append->AddInputConnection(shared1->GetOutputPort());
+  append->AddInputConnection(shared2->GetOutputPort());
+  ResetCounts();
+  sources[0]->Modified();
+  append->Update();
+  TEST_ASSERT(Executions == 1 &&
+              append->GetOutput()->GetNumberOfPoints() == numPoints - 390 + 200,
+              "Bad update of a shared source");
+
+  // Non-reentrant sources execute one at a time.
+  for (int i = 0; i < numBranches; ++i)
+    {
+    sources[i]->GetInformation()->Set(
+      vtkDemandDrivenPipeline::NON_REENTRANT(), 1);
+    sources[i]->Modified();
+    }
+  ResetCounts();
+  append->Update();
+  TEST_ASSERT(Executions == numBranches && MaxRunning == 1,
+              "Non-reentrant sources executed concurrently");
+  TEST_ASSERT(append->GetOutput()->GetNumberOfPoints() == numPoints - 390 + 200,
+              "Bad number of points with non-reentrant sources");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExecutionProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkExecutionProfiler records the passes of the algorithms of
+// a pipeline only while started, with the sizes of the data passes and
+// the memory allocated by each algorithm, and writes them as a trace.
+
+#include "vtkElevationFilter.h"
+#include "vtkExecutionProfiler.h"
+#include "vtkNew.h"
+#include "vtkSphereSource.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+// The first event of the class for the request, or -1.
+static vtkIdType FindEvent(vtkExecutionProfiler *profiler,
+                           const char *className, const char *request)
+{
+  for (vtkIdType i = 0; i < profiler->GetNumberOfEvents(); ++i)
+    {
+    if (strcmp(profiler->GetEventClassName(i), className) == 0 &&
+        strcmp(profiler->GetEventRequest(i), request) == 0)
+      {
+      return i;
+      }
+    }
+  return -1;
+}
+
+int TestExecutionProfiler(int, char *[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+
+  vtkNew<vtkExecutionProfiler> profiler;
+  TEST_ASSERT(!vtkExecutionProfiler::GetActiveProfiler() &&
+              !profiler->IsRecording(), "Profiler recording by default");
+  elevation->Update();
+  TEST_ASSERT(profiler->GetNumberOfEvents() == 0, "Events recorded");
+
+  profiler->Start();
+  TEST_ASSERT(vtkExecutionProfiler::GetActiveProfiler() ==
+              profiler.GetPointer(), "Profiler not active");
+  sphere->Modified();
+  elevation->Update();
+  profiler->Stop();
+
+  vtkIdType source = FindEvent(profiler.GetPointer(), "vtkSphereSource",
+                               "REQUEST_DATA");
+  vtkIdType filter = FindEvent(profiler.GetPointer(), "vtkElevationFilter",
+                               "REQUEST_DATA");
+  TEST_ASSERT(source >= 0 && filter > source, "Missing data passes");
+  TEST_ASSERT(FindEvent(profiler.GetPointer(), "vtkElevationFilter",
+                        "REQUEST_UPDATE_EXTENT") >= 0 &&
+              FindEvent(profiler.GetPointer(), "vtkSphereSource",
+                        "REQUEST_INFORMATION") >= 0, "Missing passes");
+  unsigned long outputSize = sphere->GetOutput()->GetActualMemorySize();
+  TEST_ASSERT(profiler->GetEventInputSize(source) == 0 &&
+              profiler->GetEventOutputSize(source) == outputSize &&
+              profiler->GetEventInputSize(filter) == outputSize &&
+              profiler->GetEventOutputSize(filter) ==
+              elevation->GetOutput()->GetActualMemorySize(),
+              "Bad data sizes");
+  TEST_ASSERT(profiler->GetEventMemoryDelta(filter) > 0,
+              "Bad memory delta");
+  for (vtkIdType i = 0; i < profiler->GetNumberOfEvents(); ++i)
+    {
+    TEST_ASSERT(profiler->GetEventStartTime(i) >= 0.0 &&
+                profiler->GetEventDuration(i) >= 0.0 &&
+                profiler->GetEventThread(i) == 0, "Bad event " << i);
+    }
+  TEST_ASSERT(profiler->GetEventStartTime(filter) >=
+              profiler->GetEventStartTime(source) +
+              profiler->GetEventDuration(source), "Bad event order");
+
+  std::ostringstream trace;
+  profiler->WriteTrace(trace);
+  TEST_ASSERT(trace.str().find("{\"traceEvents\":[") == 0 &&
+              trace.str().find("\"name\":\"vtkSphereSource\"") !=
+              std::string::npos &&
+              trace.str().find("\"cat\":\"REQUEST_DATA\"") !=
+              std::string::npos, "Bad trace");
+
+  // Stopped, the profiler does not record.
+  vtkIdType numEvents = profiler->GetNumberOfEvents();
+  sphere->Modified();
+  elevation->Update();
+  TEST_ASSERT(profiler->GetNumberOfEvents() == numEvents &&
+              !vtkExecutionProfiler::GetActiveProfiler(),
+              "Events recorded after stop");
+  profiler->Clear();
+  TEST_ASSERT(profiler->GetNumberOfEvents() == 0, "Events not cleared");
+
+  // The arrays allocated by each algorithm are counted when tracking.
+  TEST_ASSERT(profiler->GetAllocatedSize(sphere.GetPointer()) == 0,
+              "Allocations counted without tracking");
+  profiler->TrackAllocationsOn();
+  profiler->Start();
+  sphere->Modified();
+  elevation->Update();
+  profiler->Stop();
+  vtkTypeInt64 sphereSize = profiler->GetAllocatedSize(sphere.GetPointer());
+  vtkTypeInt64 elevationSize =
+    profiler->GetAllocatedSize(elevation.GetPointer());
+  TEST_ASSERT(sphereSize > 0 && elevationSize > 0 &&
+              elevationSize < sphereSize, "Bad allocated sizes");
+  TEST_ASSERT(profiler->GetPipelineAllocatedSize(elevation.GetPointer()) ==
+              sphereSize + elevationSize &&
+              profiler->GetPipelineAllocatedSize(sphere.GetPointer()) ==
+              sphereSize, "Bad pipeline allocated size");
+  TEST_ASSERT(profiler->GetTotalAllocatedSize() >= sphereSize + elevationSize &&
+              profiler->GetPeakTotalAllocatedSize() >=
+              profiler->GetTotalAllocatedSize(), "Bad total allocated size");
+  filter = FindEvent(profiler.GetPointer(), "vtkElevationFilter",
+                     "REQUEST_DATA");
+  TEST_ASSERT(filter >= 0 &&
+              profiler->GetEventAllocatedSize(filter) == elevationSize,
+              "Bad event allocated size");
+  std::ostringstream trackedTrace;
+  profiler->WriteTrace(trackedTrace);
+  TEST_ASSERT(trackedTrace.str().find("\"allocated_kib\":") !=
+              std::string::npos &&
+              trackedTrace.str().find("\"ph\":\"C\"") != std::string::npos,
+              "Allocations missing from the trace");
+  return EXIT_SUCCESS;
+}
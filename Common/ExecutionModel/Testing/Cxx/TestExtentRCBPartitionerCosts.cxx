@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExtentRCBPartitionerCosts.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkExtentRCBPartitioner balances the cost of the partitions
+// when given per-cell costs or a coarse cost grid.
+
+#include "vtkDoubleArray.h"
+#include "vtkExtentRCBPartitioner.h"
+#include "vtkNew.h"
+
+#include <algorithm>
+
+namespace
+{
+
+const int N = 64;
+
+// Cells with i < 8 are 100 times more expensive than the others.
+double CellCost(int i, int)
+{
+  return i < 8 ? 100.0 : 1.0;
+}
+
+// Returns the ratio of the most to the least expensive partition.
+double GetImbalance(vtkExtentRCBPartitioner *partitioner)
+{
+  double minCost = VTK_DOUBLE_MAX;
+  double maxCost = 0.0;
+  double total = 0.0;
+  for (int p = 0; p < partitioner->GetNumExtents(); ++p)
+    {
+    int ext[6];
+    partitioner->GetPartitionExtent(p, ext);
+    double cost = 0.0;
+    for (int j = ext[2]; j < ext[3]; ++j)
+      {
+      for (int i = ext[0]; i < ext[1]; ++i)
+        {
+        cost += CellCost(i, j);
+        }
+      }
+    minCost = std::min(minCost, cost);
+    maxCost = std::max(maxCost, cost);
+    total += cost;
+    }
+
+  double expected = 0.0;
+  for (int j = 0; j < N; ++j)
+    {
+    for (int i = 0; i < N; ++i)
+      {
+      expected += CellCost(i, j);
+      }
+    }
+  if (total != expected)
+    {
+    cerr << "Partitions cover a cost of " << total << " instead of "
+         << expected << endl;
+    return VTK_DOUBLE_MAX;
+    }
+  return minCost > 0.0 ? maxCost / minCost : VTK_DOUBLE_MAX;
+}
+
+}
+
+int TestExtentRCBPartitionerCosts(int, char *[])
+{
+  int rval = EXIT_SUCCESS;
+
+  vtkNew<vtkDoubleArray> cellCosts;
+  for (int j = 0; j < N; ++j)
+    {
+    for (int i = 0; i < N; ++i)
+      {
+      cellCosts->InsertNextValue(CellCost(i, j));
+      }
+    }
+
+  // Equal volumes are badly imbalanced.
+  vtkNew<vtkExtentRCBPartitioner> partitioner;
+  partitioner->SetGlobalExtent(0, N, 0, N, 0, 0);
+  partitioner->SetNumberOfPartitions(4);
+  partitioner->Partition();
+  double uniform = GetImbalance(partitioner.GetPointer());
+  if (uniform < 2.0)
+    {
+    cerr << "Expected imbalanced partitions without costs, got a ratio of "
+         << uniform << endl;
+    rval = EXIT_FAILURE;
+    }
+
+  // One cost per cell.
+  partitioner->SetGlobalExtent(0, N, 0, N, 0, 0);
+  partitioner->SetCellCosts(cellCosts.GetPointer());
+  partitioner->Partition();
+  double perCell = GetImbalance(partitioner.GetPointer());
+  if (partitioner->GetNumExtents() != 4 || perCell > 1.2)
+    {
+    cerr << "Per-cell costs: " << partitioner->GetNumExtents()
+         << " partitions, cost ratio of " << perCell << endl;
+    rval = EXIT_FAILURE;
+    }
+
+  // A coarse grid of 8 x 8 blocks of 8 x 8 cells giving the same costs.
+  vtkNew<vtkDoubleArray> blockCosts;
+  for (int j = 0; j < 8; ++j)
+    {
+    for (int i = 0; i < 8; ++i)
+      {
+      blockCosts->InsertNextValue(64.0 * CellCost(8 * i, 8 * j));
+      }
+    }
+  int dims[3] = { 8, 8, 1 };
+  partitioner->SetCosts(blockCosts.GetPointer(), dims);
+  partitioner->Partition();
+  double coarse = GetImbalance(partitioner.GetPointer());
+  if (partitioner->GetNumExtents() != 4 || coarse > 1.2)
+    {
+    cerr << "Coarse costs: " << partitioner->GetNumExtents()
+         << " partitions, cost ratio of " << coarse << endl;
+    rval = EXIT_FAILURE;
+    }
+
+  return rval;
+}
@@ -0,0 +1,151 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedImageAlgorithmSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the SMP execution of vtkThreadedImageAlgorithm covers the
+// output extent exactly once with every split mode.
+
+#include "vtkAtomicTypes.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkThreadedImageAlgorithm.h"
+
+#include <cstdlib>
+#include <iostream>
+
+class vtkTestIncrementFilter : public vtkThreadedImageAlgorithm
+{
+public:
+  static vtkTestIncrementFilter *New();
+  vtkTypeMacro(vtkTestIncrementFilter, vtkThreadedImageAlgorithm);
+
+  vtkAtomicIdType NumberOfPoints;
+  vtkAtomicIdType NumberOfPieces;
+
+protected:
+  vtkTestIncrementFilter() : NumberOfPoints(0), NumberOfPieces(0) {}
+
+  void ThreadedRequestData(vtkInformation *, vtkInformationVector **,
+                           vtkInformationVector *, vtkImageData ***inData,
+                           vtkImageData **outData, int ext[6], int)
+  {
+    for (int k = ext[4]; k <= ext[5]; ++k)
+      {
+      for (int j = ext[2]; j <= ext[3]; ++j)
+        {
+        int *in = static_cast<int*>(
+          inData[0][0]->GetScalarPointer(ext[0], j, k));
+        int *out = static_cast<int*>(outData[0]->GetScalarPointer(ext[0], j, k));
+        for (int i = ext[0]; i <= ext[1]; ++i)
+          {
+          *out++ = *in++ + 1;
+          }
+        }
+      }
+    this->NumberOfPoints += static_cast<vtkIdType>(ext[1] - ext[0] + 1) *
+      (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1);
+    ++this->NumberOfPieces;
+  }
+
+private:
+  vtkTestIncrementFilter(const vtkTestIncrementFilter&);  // Not implemented.
+  void operator=(const vtkTestIncrementFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkTestIncrementFilter);
+
+static bool TestExtent(const int dims[3], int splitMode, bool smp)
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(dims[0], dims[1], dims[2]);
+  image->AllocateScalars(VTK_INT, 1);
+  int *values = static_cast<int*>(image->GetScalarPointer());
+  vtkIdType numberOfPoints = image->GetNumberOfPoints();
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+    values[i] = static_cast<int>(i);
+    }
+
+  vtkNew<vtkTestIncrementFilter> filter;
+  filter->SetInputData(image.GetPointer());
+  filter->SetEnableSMP(smp);
+  filter->SetSplitMode(splitMode);
+  filter->SetDesiredBytesPerPiece(1024);
+  filter->Update();
+
+  vtkImageData *output = filter->GetOutput();
+  int *result = static_cast<int*>(output->GetScalarPointer());
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+    if (result[i] != values[i] + 1)
+      {
+      std::cerr << "Point " << i << " was not computed (mode " << splitMode
+                << ", SMP " << smp << ")." << std::endl;
+      return false;
+      }
+    }
+  if (filter->NumberOfPoints.load() != numberOfPoints)
+    {
+    std::cerr << "Pieces overlap (mode " << splitMode << ", SMP " << smp
+              << "): " << filter->NumberOfPoints.load() << " points for "
+              << numberOfPoints << std::endl;
+    return false;
+    }
+  if (smp && numberOfPoints * 4 >= 4 * 1024 &&
+      filter->NumberOfPieces.load() < 4)
+    {
+    std::cerr << "Extent was not split into small pieces (mode "
+              << splitMode << "): " << filter->NumberOfPieces.load()
+              << std::endl;
+    return false;
+    }
+  return true;
+}
+
+int TestThreadedImageAlgorithmSMP(int, char *[])
+{
+  const int dims[][3] = {
+    { 64, 48, 20 }, { 300, 200, 1 }, { 5000, 1, 1 }, { 1, 1, 1 } };
+
+  for (int mode = vtkThreadedImageAlgorithm::SLAB;
+       mode <= vtkThreadedImageAlgorithm::BLOCK; ++mode)
+    {
+    for (size_t d = 0; d < sizeof(dims) / sizeof(dims[0]); ++d)
+      {
+      if (!TestExtent(dims[d], mode, true) ||
+          !TestExtent(dims[d], mode, false))
+        {
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // Block mode splits all axes and respects the minimum piece size.
+  vtkNew<vtkTestIncrementFilter> filter;
+  filter->SetSplitModeToBlock();
+  int ext[6] = { 0, 63, 0, 63, 0, 63 };
+  int splitExt[6];
+  int total = filter->SplitExtent(splitExt, ext, 0, 64);
+  if (total != 64 || splitExt[1] - splitExt[0] + 1 < 16 ||
+      splitExt[3] - splitExt[2] + 1 != 16 || splitExt[5] - splitExt[4] + 1 != 16)
+    {
+    std::cerr << "Bad block split: " << total << " pieces, first ("
+              << splitExt[0] << ", " << splitExt[1] << ", "
+              << splitExt[2] << ", " << splitExt[3] << ", "
+              << splitExt[4] << ", " << splitExt[5] << ")" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,317 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsynchronousPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAsynchronousPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkAtomicTypes.h"
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkDataObject.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <vector>
+
+vtkStandardNewMacro(vtkAsynchronousPipeline);
+
+//----------------------------------------------------------------------------
+class vtkAsynchronousPipelineInternals
+{
+public:
+  vtkNew<vtkMultiThreader> Threader;
+  int ThreadId;
+  int Port;
+  vtkAtomicInt32 Status;
+  vtkAtomicInt32 Cancelled;
+
+  // The algorithms of the pipeline being updated, and the tags of the
+  // observers that abort them when the update is cancelled.
+  std::vector<vtkAlgorithm*> Algorithms;
+  std::vector<unsigned long> Tags;
+  vtkNew<vtkCallbackCommand> AbortCommand;
+
+  // The outputs published by the worker and not yet swapped in, and those
+  // returned to the application.
+  vtkSimpleCriticalSection Lock;
+  std::vector<vtkSmartPointer<vtkDataObject> > Pending;
+  std::vector<vtkSmartPointer<vtkDataObject> > Published;
+
+  // The algorithm and all the algorithms upstream of it, once each.
+  void CollectAlgorithms(vtkAlgorithm *algorithm)
+  {
+    if (!algorithm ||
+        std::find(this->Algorithms.begin(), this->Algorithms.end(),
+                  algorithm) != this->Algorithms.end())
+      {
+      return;
+      }
+    this->Algorithms.push_back(algorithm);
+    for (int port = 0; port < algorithm->GetNumberOfInputPorts(); ++port)
+      {
+      for (int i = 0; i < algorithm->GetNumberOfInputConnections(port); ++i)
+        {
+        this->CollectAlgorithms(algorithm->GetInputAlgorithm(port, i));
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// The executives reset the abort flag of an algorithm before it executes,
+// and then report its progress: abort it there if the update is cancelled.
+static void vtkAsynchronousPipelineAbort(vtkObject *caller, unsigned long,
+                                         void *clientData, void *)
+{
+  vtkAsynchronousPipelineInternals *internals =
+    static_cast<vtkAsynchronousPipelineInternals*>(clientData);
+  vtkAlgorithm *algorithm = static_cast<vtkAlgorithm*>(caller);
+  if (internals->Cancelled && !algorithm->GetAbortExecute())
+    {
+    algorithm->SetAbortExecute(1);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkAsynchronousPipeline::vtkAsynchronousPipeline()
+{
+  this->Internals = new vtkAsynchronousPipelineInternals;
+  this->Internals->ThreadId = -1;
+  this->Internals->Port = 0;
+  this->Internals->Status = UPDATE_NOT_STARTED;
+  this->Internals->Cancelled = 0;
+  this->Internals->AbortCommand->SetCallback(vtkAsynchronousPipelineAbort);
+  this->Internals->AbortCommand->SetClientData(this->Internals);
+}
+
+//----------------------------------------------------------------------------
+vtkAsynchronousPipeline::~vtkAsynchronousPipeline()
+{
+  if (this->Internals->ThreadId >= 0)
+    {
+    this->CancelUpdate();
+    this->WaitForUpdate();
+    }
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+int vtkAsynchronousPipeline::StartUpdate(int port)
+{
+  if (this->IsUpdateRunning())
+    {
+    return 0;
+    }
+  vtkAlgorithm *algorithm = this->GetAlgorithm();
+  if (!algorithm)
+    {
+    vtkErrorMacro("No algorithm to update.");
+    return 0;
+    }
+  if (port < 0 || port >= algorithm->GetNumberOfOutputPorts())
+    {
+    vtkErrorMacro("Attempt to update output port " << port << " of "
+                  << algorithm->GetClassName() << ", which has "
+                  << algorithm->GetNumberOfOutputPorts() << " ports.");
+    return 0;
+    }
+
+  // The worker keeps the algorithm and thus this executive alive.
+  algorithm->Register(this);
+
+  vtkAsynchronousPipelineInternals *internals = this->Internals;
+  internals->Algorithms.clear();
+  internals->Tags.clear();
+  internals->CollectAlgorithms(algorithm);
+  for (size_t i = 0; i < internals->Algorithms.size(); ++i)
+    {
+    internals->Tags.push_back(internals->Algorithms[i]->AddObserver(
+      vtkCommand::ProgressEvent, internals->AbortCommand.GetPointer()));
+    }
+
+  internals->Port = port;
+  internals->Cancelled = 0;
+  internals->Status = UPDATE_RUNNING;
+  internals->ThreadId = internals->Threader->SpawnThread(
+    &vtkAsynchronousPipeline::UpdateThread, this);
+  if (internals->ThreadId < 0)
+    {
+    vtkErrorMacro("Could not start the update thread.");
+    internals->Status = UPDATE_FAILED;
+    for (size_t i = 0; i < internals->Algorithms.size(); ++i)
+      {
+      internals->Algorithms[i]->RemoveObserver(internals->Tags[i]);
+      }
+    algorithm->UnRegister(this);
+    return 0;
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkAsynchronousPipeline::UpdateThread(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  static_cast<vtkAsynchronousPipeline*>(info->UserData)->ExecuteUpdate();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousPipeline::ExecuteUpdate()
+{
+  vtkAsynchronousPipelineInternals *internals = this->Internals;
+  int port = internals->Port;
+  int result = this->Update(port);
+
+  for (size_t i = 0; i < internals->Algorithms.size(); ++i)
+    {
+    internals->Algorithms[i]->RemoveObserver(internals->Tags[i]);
+    }
+
+  if (internals->Cancelled)
+    {
+    // The outputs of the aborted algorithms are marked as generated:
+    // modify the algorithms so that the next update executes them again.
+    for (size_t i = 0; i < internals->Algorithms.size(); ++i)
+      {
+      vtkAlgorithm *algorithm = internals->Algorithms[i];
+      if (algorithm->GetAbortExecute())
+        {
+        algorithm->SetAbortExecute(0);
+        algorithm->Modified();
+        }
+      }
+    internals->Status = UPDATE_CANCELLED;
+    return;
+    }
+  if (!result)
+    {
+    internals->Status = UPDATE_FAILED;
+    return;
+    }
+
+  // Publish a copy of the output, which the next update does not change.
+  vtkSmartPointer<vtkDataObject> copy;
+  if (vtkDataObject *output = this->GetOutputData(port))
+    {
+    copy.TakeReference(output->NewInstance());
+    copy->ShallowCopy(output);
+    }
+  internals->Lock.Lock();
+  if (static_cast<int>(internals->Pending.size()) <= port)
+    {
+    internals->Pending.resize(port + 1);
+    }
+  internals->Pending[port] = copy;
+  internals->Lock.Unlock();
+  internals->Status = UPDATE_SUCCEEDED;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousPipeline::FinishUpdate()
+{
+  vtkAsynchronousPipelineInternals *internals = this->Internals;
+  if (internals->ThreadId >= 0 && internals->Status != UPDATE_RUNNING)
+    {
+    internals->Threader->TerminateThread(internals->ThreadId);
+    internals->ThreadId = -1;
+    this->GetAlgorithm()->UnRegister(this);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkAsynchronousPipeline::WaitForUpdate()
+{
+  vtkAsynchronousPipelineInternals *internals = this->Internals;
+  if (internals->ThreadId >= 0)
+    {
+    // Joins the thread, whether or not it finished.
+    internals->Threader->TerminateThread(internals->ThreadId);
+    internals->ThreadId = -1;
+    this->GetAlgorithm()->UnRegister(this);
+    }
+  return internals->Status == UPDATE_SUCCEEDED ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousPipeline::CancelUpdate()
+{
+  vtkAsynchronousPipelineInternals *internals = this->Internals;
+  if (internals->Status != UPDATE_RUNNING)
+    {
+    return;
+    }
+  internals->Cancelled = 1;
+  // Abort the algorithms executing now; the others are aborted as they
+  // start.
+  for (size_t i = 0; i < internals->Algorithms.size(); ++i)
+    {
+    internals->Algorithms[i]->SetAbortExecute(1);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkAsynchronousPipeline::GetUpdateStatus()
+{
+  this->FinishUpdate();
+  return this->Internals->Status;
+}
+
+//----------------------------------------------------------------------------
+bool vtkAsynchronousPipeline::IsUpdateRunning()
+{
+  return this->GetUpdateStatus() == UPDATE_RUNNING;
+}
+
+//----------------------------------------------------------------------------
+double vtkAsynchronousPipeline::GetUpdateProgress()
+{
+  vtkAlgorithm *algorithm = this->GetAlgorithm();
+  return algorithm ? algorithm->GetProgress() : 0.0;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkAsynchronousPipeline::GetPublishedOutputData(int port)
+{
+  vtkAsynchronousPipelineInternals *internals = this->Internals;
+  if (port < 0)
+    {
+    return NULL;
+    }
+  internals->Lock.Lock();
+  if (port < static_cast<int>(internals->Pending.size()) &&
+      internals->Pending[port])
+    {
+    if (static_cast<int>(internals->Published.size()) <= port)
+      {
+      internals->Published.resize(port + 1);
+      }
+    internals->Published[port] = internals->Pending[port];
+    internals->Pending[port] = NULL;
+    }
+  internals->Lock.Unlock();
+  return port < static_cast<int>(internals->Published.size()) ?
+    internals->Published[port].GetPointer() : NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "UpdateStatus: " << this->Internals->Status << endl;
+}
@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsynchronousPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkAsynchronousPipeline - Executive that updates in a worker thread
+// .SECTION Description
+// vtkAsynchronousPipeline updates the pipeline of its algorithm in a worker
+// thread, so that an application can keep rendering and handling events
+// while a long update executes. StartUpdate() returns immediately; the
+// executive is the handle of the update: poll it with IsUpdateRunning()
+// and GetUpdateProgress(), wait for it with WaitForUpdate(), or cancel it
+// with CancelUpdate(), which aborts the algorithms of the pipeline.
+//
+// The outputs of an update that succeeded are published: a shallow copy of
+// each output is swapped in by GetPublishedOutputData(). The published data
+// does not change while the next update executes, and it is kept when an
+// update is cancelled or fails, so a consumer (for example a mapper given
+// the published data with SetInputData()) shows the previous result until
+// the next one is complete.
+//
+// While an update is running, the worker thread owns the pipeline: the
+// application must not modify or update the algorithms it contains, nor
+// access their outputs, until IsUpdateRunning() returns false.
+//
+// .SECTION Caveats
+// Cancelling relies on the algorithms checking GetAbortExecute() while they
+// execute; an algorithm that does not check it runs to completion, and the
+// algorithms downstream of it are aborted as they start. The outputs of
+// the aborted algorithms are discarded; they execute again on the next
+// update.
+//
+// .SECTION See Also
+// vtkCompositeDataPipeline vtkAlgorithm::SetAbortExecute
+
+#ifndef vtkAsynchronousPipeline_h
+#define vtkAsynchronousPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+#include "vtkMultiThreader.h" // For VTK_THREAD_RETURN_TYPE
+
+class vtkAsynchronousPipelineInternals;
+class vtkDataObject;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkAsynchronousPipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkAsynchronousPipeline* New();
+  vtkTypeMacro(vtkAsynchronousPipeline,vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // The states of an update.
+  enum UpdateStatus
+  {
+    UPDATE_NOT_STARTED = 0,
+    UPDATE_RUNNING,
+    UPDATE_SUCCEEDED,
+    UPDATE_FAILED,
+    UPDATE_CANCELLED
+  };
+
+  // Description:
+  // Start updating the given output port in a worker thread. Returns 0
+  // without starting if an update is already running or if there is no
+  // algorithm.
+  int StartUpdate(int port = 0);
+
+  // Description:
+  // Wait for the update to finish. Returns 1 if it succeeded and 0 if it
+  // failed, was cancelled or was not started.
+  int WaitForUpdate();
+
+  // Description:
+  // Cancel the running update. The update is finished when WaitForUpdate()
+  // returns or IsUpdateRunning() returns false.
+  void CancelUpdate();
+
+  // Description:
+  // The state of the last update, one of the UpdateStatus values.
+  int GetUpdateStatus();
+  bool IsUpdateRunning();
+
+  // Description:
+  // The progress of the algorithm of the executive, between 0 and 1. The
+  // algorithms upstream of it execute while it is still 0.
+  double GetUpdateProgress();
+
+  // Description:
+  // The output of the port published by the last update that succeeded, or
+  // NULL. The data stays valid until the next call that publishes a more
+  // recent output of the port. Call it from the thread that starts the
+  // updates.
+  vtkDataObject* GetPublishedOutputData(int port);
+
+protected:
+  vtkAsynchronousPipeline();
+  ~vtkAsynchronousPipeline();
+
+  // Executed by the worker thread.
+  void ExecuteUpdate();
+  static VTK_THREAD_RETURN_TYPE UpdateThread(void *arg);
+
+  // Join the worker thread of a finished update.
+  void FinishUpdate();
+
+  vtkAsynchronousPipelineInternals* Internals;
+
+private:
+  vtkAsynchronousPipeline(const vtkAsynchronousPipeline&);  // Not implemented.
+  void operator=(const vtkAsynchronousPipeline&);  // Not implemented.
+};
+
+#endif
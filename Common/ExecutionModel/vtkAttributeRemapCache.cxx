@@ -0,0 +1,222 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAttributeRemapCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAttributeRemapCache.h"
+
+#include "vtkAbstractArray.h"
+#include "vtkCellData.h"
+#include "vtkDataSet.h"
+#include "vtkIdTypeArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+
+vtkStandardNewMacro(vtkAttributeRemapCache);
+
+//----------------------------------------------------------------------------
+vtkAttributeRemapCache::vtkAttributeRemapCache()
+{
+  this->PointsPassed = false;
+  this->CellsPassed = false;
+  this->Valid = false;
+  this->Input = NULL;
+  this->NumberOfRemaps = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkAttributeRemapCache::~vtkAttributeRemapCache()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkAttributeRemapCache::Initialize()
+{
+  this->Mesh = NULL;
+  this->PointMap = vtkSmartPointer<vtkIdTypeArray>::New();
+  this->CellMap = vtkSmartPointer<vtkIdTypeArray>::New();
+  this->Dependency = NULL;
+  this->PointsPassed = false;
+  this->CellsPassed = false;
+  this->Valid = true;
+  this->Input = NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkAttributeRemapCache::RecordPoint(vtkIdType outId, vtkIdType inId)
+{
+  if (inId < 0)
+    {
+    this->Valid = false;
+    return;
+    }
+  this->PointMap->InsertValue(outId, inId);
+}
+
+//----------------------------------------------------------------------------
+void vtkAttributeRemapCache::RecordCell(vtkIdType outId, vtkIdType inId)
+{
+  if (inId < 0)
+    {
+    this->Valid = false;
+    return;
+    }
+  this->CellMap->InsertValue(outId, inId);
+}
+
+//----------------------------------------------------------------------------
+void vtkAttributeRemapCache::PassPoints()
+{
+  this->PointsPassed = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkAttributeRemapCache::PassCells()
+{
+  this->CellsPassed = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkAttributeRemapCache::SetPointMap(vtkIdTypeArray *map)
+{
+  this->PointMap = map;
+}
+
+//----------------------------------------------------------------------------
+void vtkAttributeRemapCache::SetCellMap(vtkIdTypeArray *map)
+{
+  this->CellMap = map;
+}
+
+//----------------------------------------------------------------------------
+vtkIdTypeArray *vtkAttributeRemapCache::GetPointMap()
+{
+  return this->PointMap.GetPointer();
+}
+
+//----------------------------------------------------------------------------
+vtkIdTypeArray *vtkAttributeRemapCache::GetCellMap()
+{
+  return this->CellMap.GetPointer();
+}
+
+//----------------------------------------------------------------------------
+void vtkAttributeRemapCache::Finish(vtkDataSet *input, vtkDataSet *output,
+                                    vtkAbstractArray *dependency)
+{
+  // Every output point and cell must map to exactly one input point or
+  // cell, and those must still exist.
+  vtkIdType numPts = output->GetNumberOfPoints();
+  vtkIdType numCells = output->GetNumberOfCells();
+  if (this->Valid && !this->PointsPassed)
+    {
+    this->Valid = (this->PointMap &&
+                   this->PointMap->GetNumberOfTuples() == numPts &&
+                   (numPts == 0 ||
+                    this->PointMap->GetValueRange()[0] >= 0));
+    }
+  if (this->Valid && !this->CellsPassed)
+    {
+    this->Valid = (this->CellMap &&
+                   this->CellMap->GetNumberOfTuples() == numCells &&
+                   (numCells == 0 ||
+                    this->CellMap->GetValueRange()[0] >= 0));
+    }
+  if (!this->Valid)
+    {
+    this->Mesh = NULL;
+    return;
+    }
+
+  this->Mesh.TakeReference(output->NewInstance());
+  this->Mesh->CopyStructure(output);
+  this->Input = input;
+  this->Dependency = dependency;
+  this->FinishTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkAttributeRemapCache::CanRemap(vtkDataSet *input,
+                                      unsigned long algorithmMTime,
+                                      vtkAbstractArray *dependency)
+{
+  if (!this->Valid || !this->Mesh || input != this->Input ||
+      dependency != this->Dependency.GetPointer())
+    {
+    return false;
+    }
+  unsigned long finishTime = this->FinishTime.GetMTime();
+  return (algorithmMTime < finishTime &&
+          input->GetGeometryMTime() < finishTime &&
+          input->GetTopologyMTime() < finishTime &&
+          (!dependency || dependency->GetMTime() < finishTime));
+}
+
+//----------------------------------------------------------------------------
+void vtkAttributeRemapCache::Remap(vtkDataSet *input, vtkDataSet *output)
+{
+  output->CopyStructure(this->Mesh);
+
+  if (this->PointsPassed)
+    {
+    output->GetPointData()->PassData(input->GetPointData());
+    }
+  else
+    {
+    vtkAttributeRemapCache::RemapAttributes(
+      input->GetPointData(), output->GetPointData(), this->PointMap,
+      this->Mesh->GetNumberOfPoints());
+    }
+
+  if (this->CellsPassed)
+    {
+    output->GetCellData()->PassData(input->GetCellData());
+    }
+  else
+    {
+    vtkAttributeRemapCache::RemapAttributes(
+      input->GetCellData(), output->GetCellData(), this->CellMap,
+      this->Mesh->GetNumberOfCells());
+    }
+
+  this->NumberOfRemaps++;
+}
+
+//----------------------------------------------------------------------------
+void vtkAttributeRemapCache::RemapAttributes(vtkDataSetAttributes *in,
+                                             vtkDataSetAttributes *out,
+                                             vtkIdTypeArray *map,
+                                             vtkIdType numTuples)
+{
+  // Same copy rules as the filters using this class.
+  out->CopyGlobalIdsOn();
+  out->CopyAllocate(in, numTuples);
+  const vtkIdType *inIds = map->GetPointer(0);
+  for (vtkIdType i = 0; i < numTuples; ++i)
+    {
+    out->CopyData(in, inIds[i], i);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkAttributeRemapCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Valid: " << (this->Valid && this->Mesh ? "Yes" : "No")
+     << "\n";
+  os << indent << "Points Passed: " << (this->PointsPassed ? "On" : "Off")
+     << "\n";
+  os << indent << "Cells Passed: " << (this->CellsPassed ? "On" : "Off")
+     << "\n";
+  os << indent << "Number Of Remaps: " << this->NumberOfRemaps << "\n";
+}
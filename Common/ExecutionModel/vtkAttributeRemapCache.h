@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAttributeRemapCache.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkAttributeRemapCache - re-map attributes over a cached output mesh
+// .SECTION Description
+// vtkAttributeRemapCache is a helper class for filters whose output mesh
+// depends only on the geometry and topology of their input, and whose
+// output point and cell data are copied from input points and cells
+// (vtkDataSetSurfaceFilter, vtkGeometryFilter or vtkThreshold for
+// instance). While executing, such a filter records which input point
+// and cell each output point and cell was copied from. Once done, it
+// calls Finish() to keep a shallow copy of the output mesh.
+//
+// When the filter executes again because only the input attributes
+// changed (see vtkDataSet::GetGeometryMTime(),
+// vtkDataSet::GetTopologyMTime()), CanRemap() returns true and Remap()
+// restores the cached mesh and copies the new attributes onto it, which
+// is much cheaper than extracting the mesh again.
+//
+// Output points that were interpolated rather than copied cannot be
+// re-mapped. Recording a negative input id disables the cache until the
+// next execution.
+
+// .SECTION See Also
+// vtkDataSet vtkDataSetAttributes
+
+#ifndef vtkAttributeRemapCache_h
+#define vtkAttributeRemapCache_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+#include "vtkSmartPointer.h" // For the cached mesh and maps
+
+class vtkAbstractArray;
+class vtkDataSet;
+class vtkDataSetAttributes;
+class vtkIdTypeArray;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkAttributeRemapCache : public vtkObject
+{
+public:
+  static vtkAttributeRemapCache *New();
+  vtkTypeMacro(vtkAttributeRemapCache,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Discard the cached mesh and start recording a new execution.
+  void Initialize();
+
+  // Description:
+  // Record that output point outId is a copy of input point inId. A
+  // negative inId marks a point that cannot be re-mapped.
+  void RecordPoint(vtkIdType outId, vtkIdType inId);
+
+  // Description:
+  // Record that output cell outId is a copy of input cell inId.
+  void RecordCell(vtkIdType outId, vtkIdType inId);
+
+  // Description:
+  // Record that the output points (cells) are the input points (cells)
+  // in the same order, as when the point (cell) data is passed.
+  void PassPoints();
+  void PassCells();
+
+  // Description:
+  // Use an existing array of input point (cell) ids, one per output
+  // point (cell), as map. The array is referenced, not copied.
+  void SetPointMap(vtkIdTypeArray *map);
+  void SetCellMap(vtkIdTypeArray *map);
+  vtkIdTypeArray *GetPointMap();
+  vtkIdTypeArray *GetCellMap();
+
+  // Description:
+  // Finish recording and keep a shallow copy of the mesh of output.
+  // dependency is an optional input array the output mesh depends on,
+  // for instance the scalars a threshold is applied to; the cache is
+  // invalidated when it is modified.
+  void Finish(vtkDataSet *input, vtkDataSet *output,
+              vtkAbstractArray *dependency = NULL);
+
+  // Description:
+  // Return true if Remap() can produce the output for this input. That
+  // is the case when input is the data set given to Finish(), its
+  // geometry and topology did not change since, neither did the
+  // dependency, and the algorithm was not modified since (pass its
+  // MTime).
+  bool CanRemap(vtkDataSet *input, unsigned long algorithmMTime,
+                vtkAbstractArray *dependency = NULL);
+
+  // Description:
+  // Restore the cached mesh into output and copy the point and cell data
+  // of input onto it.
+  void Remap(vtkDataSet *input, vtkDataSet *output);
+
+  // Description:
+  // Number of times Remap() was invoked since this object was created.
+  vtkGetMacro(NumberOfRemaps,int);
+
+protected:
+  vtkAttributeRemapCache();
+  ~vtkAttributeRemapCache();
+
+  static void RemapAttributes(vtkDataSetAttributes *in,
+                              vtkDataSetAttributes *out,
+                              vtkIdTypeArray *map, vtkIdType numTuples);
+
+  vtkSmartPointer<vtkDataSet> Mesh;
+  vtkSmartPointer<vtkIdTypeArray> PointMap;
+  vtkSmartPointer<vtkIdTypeArray> CellMap;
+  vtkSmartPointer<vtkAbstractArray> Dependency;
+  bool PointsPassed;
+  bool CellsPassed;
+  bool Valid;
+  vtkDataSet *Input; // only compared, never dereferenced
+  vtkTimeStamp FinishTime;
+  int NumberOfRemaps;
+
+private:
+  vtkAttributeRemapCache(const vtkAttributeRemapCache&);  // Not implemented.
+  void operator=(const vtkAttributeRemapCache&);  // Not implemented.
+};
+
+#endif
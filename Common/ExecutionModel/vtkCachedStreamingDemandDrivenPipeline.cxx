@@ -24,9 +24,114 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+
+#include <list>
 
 vtkStandardNewMacro(vtkCachedStreamingDemandDrivenPipeline);
 
+//----------------------------------------------------------------------------
+// The request an output was produced for.
+struct vtkCachedStreamingDemandDrivenPipelineKey
+{
+  int Port;
+  int Piece;
+  int NumberOfPieces;
+  int GhostLevels;
+  bool HasExtent;
+  int Extent[6];
+  bool HasTime;
+  double Time;
+
+  vtkCachedStreamingDemandDrivenPipelineKey(int port, vtkInformation* outInfo)
+  {
+    this->Port = port;
+    this->Piece = outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    this->NumberOfPieces = outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    this->GhostLevels = outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+    this->HasExtent =
+      outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()) != 0;
+    for (int i = 0; i < 6; ++i)
+      {
+      this->Extent[i] = 0;
+      }
+    if (this->HasExtent)
+      {
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
+                   this->Extent);
+      }
+    this->HasTime =
+      outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()) != 0;
+    this->Time = this->HasTime ?
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()) : 0.0;
+  }
+
+  bool operator==(const vtkCachedStreamingDemandDrivenPipelineKey& other) const
+  {
+    if (this->Port != other.Port || this->Piece != other.Piece ||
+        this->NumberOfPieces != other.NumberOfPieces ||
+        this->GhostLevels != other.GhostLevels ||
+        this->HasExtent != other.HasExtent || this->HasTime != other.HasTime ||
+        (this->HasTime && this->Time != other.Time))
+      {
+      return false;
+      }
+    for (int i = 0; this->HasExtent && i < 6; ++i)
+      {
+      if (this->Extent[i] != other.Extent[i])
+        {
+        return false;
+        }
+      }
+    return true;
+  }
+};
+
+//----------------------------------------------------------------------------
+// An output cached for a request, with the information of the data object.
+struct vtkCachedStreamingDemandDrivenPipelineEntry
+{
+  vtkCachedStreamingDemandDrivenPipelineEntry(
+    const vtkCachedStreamingDemandDrivenPipelineKey& key) : Key(key) {}
+
+  vtkCachedStreamingDemandDrivenPipelineKey Key;
+  vtkSmartPointer<vtkDataObject> Data;
+  vtkSmartPointer<vtkInformation> DataInformation;
+  unsigned long Size;
+  unsigned long Time;
+};
+
+//----------------------------------------------------------------------------
+class vtkCachedStreamingDemandDrivenPipelineInternals
+{
+public:
+  typedef std::list<vtkCachedStreamingDemandDrivenPipelineEntry> EntriesType;
+
+  // The most recently used first.
+  EntriesType Entries;
+  unsigned long MemorySize;
+
+  EntriesType::iterator Find(
+    const vtkCachedStreamingDemandDrivenPipelineKey& key)
+  {
+    EntriesType::iterator it = this->Entries.begin();
+    while (it != this->Entries.end() && !(it->Key == key))
+      {
+      ++it;
+      }
+    return it;
+  }
+
+  void Erase(EntriesType::iterator it)
+  {
+    this->MemorySize -= it->Size;
+    this->Entries.erase(it);
+  }
+};
+
 
 //----------------------------------------------------------------------------
 vtkCachedStreamingDemandDrivenPipeline
@@ -35,6 +140,12 @@ vtkCachedStreamingDemandDrivenPipeline
   this->CacheSize = 0;
   this->Data = NULL;
   this->Times = NULL;
+  this->CacheMemoryLimit = 0;
+  this->CacheHits = 0;
+  this->CacheMisses = 0;
+  this->CachedStreamingDemandDrivenInternal =
+    new vtkCachedStreamingDemandDrivenPipelineInternals;
+  this->CachedStreamingDemandDrivenInternal->MemorySize = 0;
 
   this->SetCacheSize(10);
 }
@@ -44,6 +155,7 @@ vtkCachedStreamingDemandDrivenPipeline
 ::~vtkCachedStreamingDemandDrivenPipeline()
 {
   this->SetCacheSize(0);
+  delete this->CachedStreamingDemandDrivenInternal;
 }
 
 //----------------------------------------------------------------------------
@@ -94,6 +206,172 @@ void vtkCachedStreamingDemandDrivenPipeline
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "CacheSize: " << this->CacheSize << "\n";
+  os << indent << "CacheMemoryLimit: " << this->CacheMemoryLimit << "\n";
+  os << indent << "CacheHits: " << this->CacheHits << "\n";
+  os << indent << "CacheMisses: " << this->CacheMisses << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedStreamingDemandDrivenPipeline::SetCacheMemoryLimit(
+  unsigned long limit)
+{
+  if (limit == this->CacheMemoryLimit)
+    {
+    return;
+    }
+  this->CacheMemoryLimit = limit;
+  this->EvictCachedOutputs(limit);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkCachedStreamingDemandDrivenPipeline::GetNumberOfCachedOutputs()
+{
+  return static_cast<int>(
+    this->CachedStreamingDemandDrivenInternal->Entries.size());
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkCachedStreamingDemandDrivenPipeline::GetCacheMemorySize()
+{
+  return this->CachedStreamingDemandDrivenInternal->MemorySize;
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedStreamingDemandDrivenPipeline::ResetCacheStatistics()
+{
+  this->CacheHits = 0;
+  this->CacheMisses = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedStreamingDemandDrivenPipeline::ClearCache()
+{
+  this->EvictCachedOutputs(0);
+  for (int i = 0; i < this->CacheSize; ++i)
+    {
+    if (this->Data[i])
+      {
+      this->Data[i]->Delete();
+      this->Data[i] = NULL;
+      this->Times[i] = 0;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedStreamingDemandDrivenPipeline::EvictCachedOutputs(
+  unsigned long limit)
+{
+  vtkCachedStreamingDemandDrivenPipelineInternals* internal =
+    this->CachedStreamingDemandDrivenInternal;
+  while (!internal->Entries.empty() && internal->MemorySize > limit)
+    {
+    internal->Erase(--internal->Entries.end());
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkCachedStreamingDemandDrivenPipeline
+::NeedToExecuteDataFromCache(int outputPort,
+                             vtkInformationVector** inInfoVec,
+                             vtkInformationVector* outInfoVec)
+{
+  vtkCachedStreamingDemandDrivenPipelineInternals* internal =
+    this->CachedStreamingDemandDrivenInternal;
+
+  // Release the outputs produced before the pipeline was modified.
+  unsigned long pmt = this->GetPipelineMTime();
+  vtkCachedStreamingDemandDrivenPipelineInternals::EntriesType::iterator it =
+    internal->Entries.begin();
+  while (it != internal->Entries.end())
+    {
+    vtkCachedStreamingDemandDrivenPipelineInternals::EntriesType::iterator
+      next = it;
+    ++next;
+    if (it->Time < pmt)
+      {
+      internal->Erase(it);
+      }
+    it = next;
+    }
+
+  // The current output may already satisfy the request.
+  if (!this->Superclass::NeedToExecuteData(outputPort, inInfoVec, outInfoVec))
+    {
+    return 0;
+    }
+  if (this->vtkDemandDrivenPipeline::NeedToExecuteData(outputPort,
+                                                       inInfoVec, outInfoVec) ||
+      this->ContinueExecuting)
+    {
+    return 1;
+    }
+
+  vtkInformation* outInfo = outInfoVec->GetInformationObject(outputPort);
+  it = internal->Find(
+    vtkCachedStreamingDemandDrivenPipelineKey(outputPort, outInfo));
+  if (it != internal->Entries.end())
+    {
+    // Pass the cached output to the output, and check that it satisfies
+    // the keys of the request that are not part of the cache key.
+    vtkDataObject* dataObject = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    dataObject->ShallowCopy(it->Data);
+    dataObject->GetInformation()->Copy(it->DataInformation);
+    dataObject->DataHasBeenGenerated();
+    if (!this->Superclass::NeedToExecuteData(outputPort,
+                                             inInfoVec, outInfoVec))
+      {
+      internal->Entries.splice(internal->Entries.begin(), internal->Entries,
+                               it);
+      ++this->CacheHits;
+      return 0;
+      }
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedStreamingDemandDrivenPipeline
+::CacheOutputs(vtkInformationVector* outInfoVec)
+{
+  vtkCachedStreamingDemandDrivenPipelineInternals* internal =
+    this->CachedStreamingDemandDrivenInternal;
+  for (int i = 0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+    {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    vtkDataObject* dataObject = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (!dataObject || outInfo->Get(DATA_NOT_GENERATED()))
+      {
+      continue;
+      }
+
+    vtkCachedStreamingDemandDrivenPipelineKey key(i, outInfo);
+    vtkCachedStreamingDemandDrivenPipelineInternals::EntriesType::iterator it =
+      internal->Find(key);
+    if (it != internal->Entries.end())
+      {
+      internal->Erase(it);
+      }
+
+    vtkCachedStreamingDemandDrivenPipelineEntry entry(key);
+    entry.Data.TakeReference(dataObject->NewInstance());
+    entry.Data->ShallowCopy(dataObject);
+    entry.DataInformation = vtkSmartPointer<vtkInformation>::New();
+    entry.DataInformation->Copy(dataObject->GetInformation());
+    entry.Size = entry.Data->GetActualMemorySize();
+    entry.Time = dataObject->GetUpdateTime();
+
+    // An output larger than the limit would evict all the others.
+    if (entry.Size > this->CacheMemoryLimit)
+      {
+      continue;
+      }
+    this->EvictCachedOutputs(this->CacheMemoryLimit - entry.Size);
+    internal->Entries.push_front(entry);
+    internal->MemorySize += entry.Size;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -110,6 +388,11 @@ int vtkCachedStreamingDemandDrivenPipeline
                                                inInfoVec, outInfoVec);
     }
 
+  if (this->CacheMemoryLimit > 0)
+    {
+    return this->NeedToExecuteDataFromCache(outputPort, inInfoVec, outInfoVec);
+    }
+
   // Does the superclass want to execute? We must skip our direct superclass
   // because it looks at update extents but does not know about the cache
   if(this->vtkDemandDrivenPipeline::NeedToExecuteData(outputPort,
@@ -231,6 +514,17 @@ int vtkCachedStreamingDemandDrivenPipeline
               vtkInformationVector** inInfoVec,
               vtkInformationVector* outInfoVec)
 {
+  if (this->CacheMemoryLimit > 0)
+    {
+    ++this->CacheMisses;
+    int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+    if (result)
+      {
+      this->CacheOutputs(outInfoVec);
+      }
+    return result;
+    }
+
   // only works for one in one out algorithms
   if (request->Get(FROM_OUTPUT_PORT()) != 0)
     {
@@ -12,9 +12,36 @@
      PURPOSE.  See the above copyright notice for more information.
 
 =========================================================================*/
-// .NAME vtkCachedStreamingDemandDrivenPipeline -
+// .NAME vtkCachedStreamingDemandDrivenPipeline - Executive caching outputs
 // .SECTION Description
-// vtkCachedStreamingDemandDrivenPipeline
+// vtkCachedStreamingDemandDrivenPipeline keeps outputs of previous updates
+// of its algorithm to satisfy later requests without executing it, nor
+// updating its inputs.
+//
+// By default it keeps the last CacheSize images, and satisfies the
+// requests whose update extent is inside the extent of one of them (see
+// vtkImageCacheFilter).
+//
+// When CacheMemoryLimit is not 0, it caches the outputs of any type
+// instead, keyed on the request they were produced for: the output port,
+// the piece, number of pieces and ghost levels, the update extent and the
+// update time step. A cached output satisfies a request only if the
+// pipeline does not need to execute with it, so the keys that decide
+// themselves whether to execute (see vtkInformationKey::NeedToExecute())
+// are honored as well. Outputs are kept until their total memory size,
+// as reported by vtkDataObject::GetActualMemorySize(), exceeds the limit;
+// the least recently used ones are evicted first. Any modification of the
+// algorithm or of the pipeline upstream of it, for example of the array
+// selection of a reader, empties the cache.
+//
+// The executive can be set on any algorithm, for example on a
+// vtkPassThrough placed after a reader of a time series, so that going
+// back to a time step already loaded does not execute the reader again.
+//
+// .SECTION Caveats
+// Cached outputs are shallow copies of the outputs: an algorithm that
+// modifies the arrays of its previous output in place instead of
+// allocating new ones modifies the cached outputs as well.
 
 #ifndef vtkCachedStreamingDemandDrivenPipeline_h
 #define vtkCachedStreamingDemandDrivenPipeline_h
@@ -41,6 +68,30 @@ public:
   void SetCacheSize(int size);
   vtkGetMacro(CacheSize, int);
 
+  // Description:
+  // The memory size, in kibibytes, of the outputs cached for the requests
+  // they were produced for. When it is 0, the default, the outputs are
+  // cached by update extent in CacheSize images instead.
+  void SetCacheMemoryLimit(unsigned long limit);
+  vtkGetMacro(CacheMemoryLimit, unsigned long);
+
+  // Description:
+  // The number and the memory size, in kibibytes, of the outputs cached
+  // while CacheMemoryLimit is not 0.
+  int GetNumberOfCachedOutputs();
+  unsigned long GetCacheMemorySize();
+
+  // Description:
+  // The number of requests satisfied from the cache and of those that
+  // executed the algorithm while CacheMemoryLimit is not 0.
+  vtkGetMacro(CacheHits, vtkIdType);
+  vtkGetMacro(CacheMisses, vtkIdType);
+  void ResetCacheStatistics();
+
+  // Description:
+  // Release all the cached outputs.
+  void ClearCache();
+
 protected:
   vtkCachedStreamingDemandDrivenPipeline();
   ~vtkCachedStreamingDemandDrivenPipeline();
@@ -52,11 +103,28 @@ protected:
                           vtkInformationVector** inInfoVec,
                           vtkInformationVector* outInfoVec);
 
+  // Satisfy the request for the output port from the cached outputs.
+  // Returns 1 if it needs to execute.
+  int NeedToExecuteDataFromCache(int outputPort,
+                                 vtkInformationVector** inInfoVec,
+                                 vtkInformationVector* outInfoVec);
+
+  // Cache the outputs generated for the request.
+  void CacheOutputs(vtkInformationVector* outInfoVec);
+
+  // Evict the least recently used outputs until the memory size of the
+  // outputs is at most limit.
+  void EvictCachedOutputs(unsigned long limit);
+
   int CacheSize;
 
   vtkDataObject **Data;
   unsigned long *Times;
 
+  unsigned long CacheMemoryLimit;
+  vtkIdType CacheHits;
+  vtkIdType CacheMisses;
+
 private:
   vtkCachedStreamingDemandDrivenPipelineInternals* CachedStreamingDemandDrivenInternal;
 private:
@@ -16,7 +16,10 @@ PURPOSE.  See the above copyright notice for more information.
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkAtomic.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkDebugLeaks.h"
+#include "vtkExecutionProfiler.h"
 #include "vtkImageData.h"
 #include "vtkInformationDoubleKey.h"
 #include "vtkInformationExecutivePortKey.h"
@@ -30,14 +33,21 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkInformationStringKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPProgressObserver.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredGrid.h"
 #include "vtkTrivialProducer.h"
 #include "vtkUniformGrid.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkCompositeDataPipeline);
 
 vtkInformationKeyMacro(vtkCompositeDataPipeline, LOAD_REQUESTED_BLOCKS, Integer);
@@ -46,12 +56,230 @@ vtkInformationKeyMacro(vtkCompositeDataPipeline, UPDATE_COMPOSITE_INDICES, Integ
 vtkInformationKeyMacro(vtkCompositeDataPipeline, DATA_COMPOSITE_INDICES, IntegerVector);
 vtkInformationKeyMacro(vtkCompositeDataPipeline, SUPPRESS_RESET_PI, Integer);
 vtkInformationKeyMacro(vtkCompositeDataPipeline, BLOCK_AMOUNT_OF_DETAIL,Double);
+vtkInformationKeyMacro(vtkCompositeDataPipeline, CAN_EXECUTE_BLOCKS_CONCURRENTLY, Integer);
+
+static bool vtkCompositeDataPipelineGlobalDefaultEnableSMP = false;
+
+//----------------------------------------------------------------------------
+namespace
+{
+  vtkInformationVector** Clone(vtkInformationVector** src, int n)
+  {
+    vtkInformationVector** dst = new vtkInformationVector*[n];
+    for(int i=0; i<n; ++i)
+      {
+      dst[i] = vtkInformationVector::New();
+      dst[i]->Copy(src[i],1);
+      }
+    return dst;
+  }
+
+  void DeleteAll(vtkInformationVector** dst, int n)
+  {
+    for(int i=0; i<n; ++i)
+      {
+      dst[i]->Delete();
+      }
+    delete []dst;
+  }
+
+  // An estimate of the work needed to process a block
+  double BlockWeight(vtkDataObject* dobj)
+  {
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(dobj);
+    if (ds)
+      {
+      return static_cast<double>(ds->GetNumberOfPoints()) +
+        static_cast<double>(ds->GetNumberOfCells());
+      }
+    return static_cast<double>(dobj->GetActualMemorySize());
+  }
+
+  // Orders the blocks by decreasing weight
+  class BlockWeightGreater
+  {
+  public:
+    const std::vector<double>* Weights;
+    bool operator()(vtkIdType a, vtkIdType b) const
+    {
+      return (*this->Weights)[a] > (*this->Weights)[b];
+    }
+  };
+}
+
+//----------------------------------------------------------------------------
+// Copies of the pipeline information of the executive, used as the
+// prototype of the information of each thread.
+class vtkCompositeDataPipelineBlockData: public vtkObjectBase
+{
+public:
+  vtkTypeMacro(vtkCompositeDataPipelineBlockData, vtkObjectBase);
+  vtkInformationVector** In;
+  vtkInformationVector* Out;
+  int InSize;
+
+  static vtkCompositeDataPipelineBlockData* New()
+  {
+    // This is required everytime we're implementing our own New() to avoid
+    // "Deleting unknown object" warning from vtkDebugLeaks.
+#ifdef VTK_DEBUG_LEAKS
+    vtkDebugLeaks::ConstructClass("vtkCompositeDataPipelineBlockData");
+#endif
+    return new vtkCompositeDataPipelineBlockData();
+  }
+
+  void Construct(vtkInformationVector** inInfoVec,
+                 int inInfoVecSize,
+                 vtkInformationVector* outInfoVec)
+  {
+    this->InSize  = inInfoVecSize;
+    this->In = Clone(inInfoVec, inInfoVecSize);
+    this->Out = vtkInformationVector::New();
+    this->Out->Copy(outInfoVec,1);
+  }
+
+  ~vtkCompositeDataPipelineBlockData()
+  {
+    if (this->In)
+      {
+      DeleteAll(this->In, this->InSize);
+      }
+    if (this->Out)
+      {
+      this->Out->Delete();
+      }
+  }
+
+protected:
+  vtkCompositeDataPipelineBlockData():
+    In(NULL),
+    Out(NULL),
+    InSize(0)
+  {
+  }
+};
+
+//----------------------------------------------------------------------------
+// Executes the blocks with vtkSMPTools. Every thread works on its own copy
+// of the pipeline information and takes the next block of Order, a list of
+// the blocks by decreasing weight, until all blocks are processed. The
+// threads thus stay busy whatever the sizes of the blocks and the
+// partitioning of the back-end.
+class vtkCompositeDataPipelineExecuteBlocks
+{
+public:
+  vtkCompositeDataPipelineExecuteBlocks(vtkCompositeDataPipeline* exec,
+                                        vtkInformationVector** inInfoVec,
+                                        vtkInformationVector* outInfoVec,
+                                        int compositePort,
+                                        int connection,
+                                        vtkInformation* request,
+                                        const std::vector<vtkDataObject*>& inObjs,
+                                        std::vector<vtkDataObject*>& outObjs,
+                                        const std::vector<vtkIdType>& order)
+    : Exec(exec),
+      CompositePort(compositePort),
+      Connection(connection),
+      Request(request),
+      InObjs(inObjs),
+      OutObjs(outObjs),
+      Order(order)
+  {
+    this->NextBlock = 0;
+    int numInputPorts = this->Exec->GetNumberOfInputPorts();
+    this->InfoPrototype =
+      vtkSmartPointer<vtkCompositeDataPipelineBlockData>::New();
+    this->InfoPrototype->Construct(inInfoVec, numInputPorts, outInfoVec);
+  }
+
+  ~vtkCompositeDataPipelineExecuteBlocks()
+  {
+    vtkSMPThreadLocal<vtkInformationVector**>::iterator itr1 =
+      this->InInfoVecs.begin();
+    vtkSMPThreadLocal<vtkInformationVector**>::iterator end1 =
+      this->InInfoVecs.end();
+    while (itr1 != end1)
+      {
+      DeleteAll(*itr1, this->InfoPrototype->InSize);
+      ++itr1;
+      }
+
+    vtkSMPThreadLocal<vtkInformationVector*>::iterator itr2 =
+      this->OutInfoVecs.begin();
+    vtkSMPThreadLocal<vtkInformationVector*>::iterator end2 =
+      this->OutInfoVecs.end();
+    while (itr2 != end2)
+      {
+      (*itr2)->Delete();
+      ++itr2;
+      }
+  }
+
+  void Initialize()
+  {
+    vtkInformationVector**& inInfoVec = this->InInfoVecs.Local();
+    vtkInformationVector*& outInfoVec = this->OutInfoVecs.Local();
+
+    inInfoVec = Clone(this->InfoPrototype->In, this->InfoPrototype->InSize);
+    outInfoVec = vtkInformationVector::New();
+    outInfoVec->Copy(this->InfoPrototype->Out, 1);
+
+    vtkInformation*& request = this->Requests.Local();
+    request->Copy(this->Request, 1);
+  }
+
+  void operator() (vtkIdType, vtkIdType)
+  {
+    vtkInformationVector** inInfoVec = this->InInfoVecs.Local();
+    vtkInformationVector* outInfoVec = this->OutInfoVecs.Local();
+    vtkInformation* request = this->Requests.Local();
+
+    vtkInformation* inInfo =
+      inInfoVec[this->CompositePort]->GetInformationObject(this->Connection);
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(0);
+
+    const vtkIdType numBlocks = static_cast<vtkIdType>(this->Order.size());
+    vtkIdType next;
+    while ((next = this->NextBlock++) < numBlocks)
+      {
+      vtkIdType i = this->Order[next];
+      this->OutObjs[i] =
+        this->Exec->ExecuteSimpleAlgorithmForBlock(inInfoVec,
+                                                   outInfoVec,
+                                                   inInfo,
+                                                   outInfo,
+                                                   request,
+                                                   this->InObjs[i]);
+      }
+  }
+
+  void Reduce()
+  {
+  }
+
+protected:
+  vtkCompositeDataPipeline* Exec;
+  vtkSmartPointer<vtkCompositeDataPipelineBlockData> InfoPrototype;
+  int CompositePort;
+  int Connection;
+  vtkInformation* Request;
+  const std::vector<vtkDataObject*>& InObjs;
+  std::vector<vtkDataObject*>& OutObjs;
+  const std::vector<vtkIdType>& Order;
+  vtkAtomic<vtkIdType> NextBlock;
+
+  vtkSMPThreadLocal<vtkInformationVector**> InInfoVecs;
+  vtkSMPThreadLocal<vtkInformationVector*> OutInfoVecs;
+  vtkSMPThreadLocalObject<vtkInformation> Requests;
+};
 
 
 //----------------------------------------------------------------------------
 vtkCompositeDataPipeline::vtkCompositeDataPipeline()
 {
   this->InLocalLoop = 0;
+  this->EnableSMP = vtkCompositeDataPipelineGlobalDefaultEnableSMP;
+  this->InConcurrentBlockExecution = false;
   this->InformationCache = vtkInformation::New();
 
   this->GenericRequest = vtkInformation::New();
@@ -277,6 +505,57 @@ bool vtkCompositeDataPipeline::ShouldIterateOverInput(vtkInformationVector** inI
   return false;
 }
 
+//----------------------------------------------------------------------------
+void vtkCompositeDataPipeline::SetGlobalDefaultEnableSMP(bool enable)
+{
+  vtkCompositeDataPipelineGlobalDefaultEnableSMP = enable;
+}
+
+//----------------------------------------------------------------------------
+bool vtkCompositeDataPipeline::GetGlobalDefaultEnableSMP()
+{
+  return vtkCompositeDataPipelineGlobalDefaultEnableSMP;
+}
+
+//----------------------------------------------------------------------------
+bool vtkCompositeDataPipeline::CanExecuteBlocksConcurrently()
+{
+  return this->EnableSMP && this->Algorithm &&
+    this->Algorithm->GetInformation()->Get(CAN_EXECUTE_BLOCKS_CONCURRENTLY());
+}
+
+//----------------------------------------------------------------------------
+int vtkCompositeDataPipeline::CallAlgorithm(vtkInformation* request,
+                                            int direction,
+                                            vtkInformationVector** inInfo,
+                                            vtkInformationVector* outInfo)
+{
+  if (!this->InConcurrentBlockExecution)
+    {
+    return this->Superclass::CallAlgorithm(request, direction, inInfo, outInfo);
+    }
+
+  // Same as the superclass, without marking the executive as being in the
+  // algorithm, which other threads do at the same time.
+  this->CopyDefaultInformation(request, direction, inInfo, outInfo);
+  vtkExecutionProfiler* profiler = vtkExecutionProfiler::GetActiveProfiler();
+  vtkIdType event = profiler ?
+    profiler->BeginRequest(this->Algorithm, request, inInfo, outInfo) : -1;
+  int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
+  if(profiler)
+    {
+    profiler->EndRequest(event, outInfo);
+    }
+  if(!result)
+    {
+    vtkErrorMacro("Algorithm " << this->Algorithm->GetClassName()
+                  << "(" << this->Algorithm
+                  << ") returned failure for request: "
+                  << *request);
+    }
+  return result;
+}
+
 //----------------------------------------------------------------------------
 void vtkCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* iter,
                                            vtkInformationVector** inInfoVec,
@@ -286,6 +565,48 @@ void vtkCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* iter,
                                            vtkInformation* request,
                                            vtkCompositeDataSet* compositeOutput)
 {
+  if (this->CanExecuteBlocksConcurrently())
+    {
+    // from input data objects  itr -> (inObjs, indices)
+    // inObjs are the non-null objects that we will loop over.
+    // indices map the input objects to inObjs
+    std::vector<vtkDataObject*> inObjs;
+    std::vector<int> indices;
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+      vtkDataObject* dobj = iter->GetCurrentDataObject();
+      if (dobj)
+        {
+        inObjs.push_back(dobj);
+        indices.push_back(static_cast<int>(inObjs.size())-1);
+        }
+      else
+        {
+        indices.push_back(-1);
+        }
+      }
+
+    if (inObjs.size() > 1)
+      {
+      std::vector<vtkDataObject*> outObjs(inObjs.size(), NULL);
+      this->ExecuteBlocksConcurrently(inInfoVec, outInfoVec, compositePort,
+                                      connection, request, inObjs, outObjs);
+
+      int i = 0;
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+           iter->GoToNextItem(), i++)
+        {
+        int j = indices[i];
+        if (j >= 0 && outObjs[j])
+          {
+          compositeOutput->SetDataSet(iter, outObjs[j]);
+          outObjs[j]->FastDelete();
+          }
+        }
+      return;
+      }
+    }
+
   vtkInformation* inInfo  =inInfoVec[compositePort]->GetInformationObject(connection);
   vtkInformation* outInfo = outInfoVec->GetInformationObject(0); //assumed to be 0
 
@@ -313,6 +634,52 @@ void vtkCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* iter,
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkCompositeDataPipeline::ExecuteBlocksConcurrently(
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec,
+  int compositePort,
+  int connection,
+  vtkInformation* request,
+  const std::vector<vtkDataObject*>& inObjs,
+  std::vector<vtkDataObject*>& outObjs)
+{
+  // Start with the largest blocks, so that the small ones fill the gaps at
+  // the end. Blocks of equal weights keep their order.
+  const vtkIdType numBlocks = static_cast<vtkIdType>(inObjs.size());
+  std::vector<double> weights(numBlocks);
+  std::vector<vtkIdType> order(numBlocks);
+  for (vtkIdType i = 0; i < numBlocks; ++i)
+    {
+    weights[i] = BlockWeight(inObjs[i]);
+    order[i] = i;
+    }
+  BlockWeightGreater greater;
+  greater.Weights = &weights;
+  std::stable_sort(order.begin(), order.end(), greater);
+
+  vtkCompositeDataPipelineExecuteBlocks executeBlocks(this,
+                                                      inInfoVec,
+                                                      outInfoVec,
+                                                      compositePort,
+                                                      connection,
+                                                      request,
+                                                      inObjs, outObjs,
+                                                      order);
+
+  // One task per thread, each of them pulls blocks until none is left
+  vtkIdType numTasks = vtkSMPTools::GetEstimatedNumberOfThreads();
+  numTasks = std::max(static_cast<vtkIdType>(1), std::min(numTasks, numBlocks));
+
+  vtkSmartPointer<vtkProgressObserver> origPo(this->Algorithm->GetProgressObserver());
+  vtkNew<vtkSMPProgressObserver> po;
+  this->Algorithm->SetProgressObserver(po.GetPointer());
+  this->InConcurrentBlockExecution = true;
+  vtkSMPTools::For(0, numTasks, 1, executeBlocks);
+  this->InConcurrentBlockExecution = false;
+  this->Algorithm->SetProgressObserver(origPo);
+}
+
 //----------------------------------------------------------------------------
 // Execute a simple (non-composite-aware) filter multiple times, once per
 // block. Collect the result in a composite dataset that is of the same
@@ -679,6 +1046,12 @@ int vtkCompositeDataPipeline::ForwardUpstream(vtkInformation* request)
     return 1;
     }
 
+  int result = 1;
+  if(this->ForwardUpstreamConcurrently(request, result))
+    {
+    return result;
+    }
+
   if (!this->Algorithm->ModifyRequest(request, BeforeForward))
     {
     return 0;
@@ -686,7 +1059,6 @@ int vtkCompositeDataPipeline::ForwardUpstream(vtkInformation* request)
   int port = request->Get(FROM_OUTPUT_PORT());
 
   // Forward the request upstream through all input connections.
-  int result = 1;
   for(int i=0; i < this->GetNumberOfInputPorts(); ++i)
     {
     int nic = this->Algorithm->GetNumberOfInputConnections(i);
@@ -1067,5 +1439,6 @@ void vtkCompositeDataPipeline::MarkOutputsGenerated(
 void vtkCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On" : "Off") << endl;
 }
 
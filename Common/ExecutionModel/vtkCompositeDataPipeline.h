@@ -35,8 +35,14 @@
 // it will invoke the  vtkStreamingDemandDrivenPipeline passes in a loop,
 // passing a different block each time and will collect the results in a
 // composite dataset.
+//
+// When EnableSMP is on and the simple filter declares that it can process
+// blocks concurrently by setting CAN_EXECUTE_BLOCKS_CONCURRENTLY() in its
+// information, the blocks are executed with vtkSMPTools instead, largest
+// blocks first, each thread taking the next block as soon as it is done
+// with the previous one.
 // .SECTION See also
-//  vtkCompositeDataSet
+//  vtkCompositeDataSet vtkThreadedCompositeDataPipeline
 
 #ifndef vtkCompositeDataPipeline_h
 #define vtkCompositeDataPipeline_h
@@ -44,6 +50,8 @@
 #include "vtkCommonExecutionModelModule.h" // For export macro
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vector> // For ExecuteBlocksConcurrently
+
 class vtkCompositeDataSet;
 class vtkCompositeDataIterator;
 class vtkInformationDoubleKey;
@@ -104,6 +112,39 @@ public:
   // *** THIS IS AN EXPERIMENTAL FEATURE. IT MAY CHANGE WITHOUT NOTICE ***
   static vtkInformationDoubleKey* BLOCK_AMOUNT_OF_DETAIL();
 
+  // Description:
+  // CAN_EXECUTE_BLOCKS_CONCURRENTLY is a key placed in the information of
+  // a simple (not composite data aware) algorithm, see
+  // vtkAlgorithm::GetInformation(), to declare that its REQUEST_DATA_OBJECT,
+  // REQUEST_INFORMATION, REQUEST_UPDATE_EXTENT and REQUEST_DATA passes are
+  // re-entrant: they only read the state of the algorithm and store
+  // everything else in the information and data objects they are given.
+  // The blocks of a composite input can then be executed concurrently.
+  static vtkInformationIntegerKey* CAN_EXECUTE_BLOCKS_CONCURRENTLY();
+
+  // Description:
+  // Enable/Disable the concurrent execution of the blocks of a composite
+  // input by algorithms that declare CAN_EXECUTE_BLOCKS_CONCURRENTLY().
+  // Progress is then reported through a vtkSMPProgressObserver. The
+  // default is given by GlobalDefaultEnableSMP.
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+
+  // Description:
+  // Set the value EnableSMP is initialized with in the executives created
+  // afterwards. The default is false.
+  static void SetGlobalDefaultEnableSMP(bool enable);
+  static bool GetGlobalDefaultEnableSMP();
+
+  // Description:
+  // An API to CallAlgorithm that allows you to pass in the info objects to
+  // be used. While blocks are executed concurrently, it does not update
+  // the state of the executive.
+  virtual int CallAlgorithm(vtkInformation* request, int direction,
+                            vtkInformationVector** inInfo,
+                            vtkInformationVector* outInfo);
+
 protected:
   vtkCompositeDataPipeline();
   ~vtkCompositeDataPipeline();
@@ -161,6 +202,28 @@ protected:
                            vtkInformation* request,
                            vtkCompositeDataSet* compositeOutput);
 
+  // Description:
+  // Execute the simple algorithm on the given non-null blocks with
+  // vtkSMPTools and store the outputs in outObjs, in the same order.
+  void ExecuteBlocksConcurrently(vtkInformationVector** inInfoVec,
+                                 vtkInformationVector* outInfoVec,
+                                 int compositePort,
+                                 int connection,
+                                 vtkInformation* request,
+                                 const std::vector<vtkDataObject*>& inObjs,
+                                 std::vector<vtkDataObject*>& outObjs);
+
+  // Description:
+  // Return whether ExecuteEach() can execute the blocks concurrently: true
+  // when EnableSMP is on and the algorithm declares
+  // CAN_EXECUTE_BLOCKS_CONCURRENTLY().
+  virtual bool CanExecuteBlocksConcurrently();
+
+  bool EnableSMP;
+
+  // True while the blocks are executed concurrently
+  bool InConcurrentBlockExecution;
+
   vtkDataObject* ExecuteSimpleAlgorithmForBlock(
     vtkInformationVector** inInfoVec,
     vtkInformationVector* outInfoVec,
@@ -220,6 +283,7 @@ protected:
 private:
   vtkCompositeDataPipeline(const vtkCompositeDataPipeline&);  // Not implemented.
   void operator=(const vtkCompositeDataPipeline&);  // Not implemented.
+  friend class vtkCompositeDataPipelineExecuteBlocks;
 };
 
 #endif
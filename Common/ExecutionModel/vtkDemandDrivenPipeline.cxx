@@ -32,9 +32,15 @@
 #include "vtkInformationUnsignedLongKey.h"
 #include "vtkInformationVector.h"
 #include "vtkInstantiator.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkSimpleCriticalSection.h"
+#include "vtkSmartPointer.h"
 
+#include <algorithm>
+#include <set>
 #include <vector>
 
 vtkStandardNewMacro(vtkDemandDrivenPipeline);
@@ -45,6 +51,139 @@ vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_DATA, Request);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_DATA_NOT_GENERATED, Request);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_DATA_OBJECT, Request);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_INFORMATION, Request);
+vtkInformationKeyMacro(vtkDemandDrivenPipeline, NON_REENTRANT, Integer);
+
+static bool vtkDemandDrivenPipelineGlobalDefaultConcurrentBranches = false;
+
+//----------------------------------------------------------------------------
+namespace
+{
+  // Serializes the REQUEST_DATA passes of the NON_REENTRANT() algorithms.
+  // It is recursive, since such an algorithm may update an internal
+  // pipeline that contains another one.
+  class SerialLock
+  {
+  public:
+    SerialLock() : Owner(vtkMultiThreaderIDType()), Depth(0) {}
+
+    void Lock()
+    {
+      if (!this->IsHeldByCurrentThread())
+        {
+        this->Mutex.Lock();
+        this->Owner = vtkMultiThreader::GetCurrentThreadID();
+        }
+      ++this->Depth;
+    }
+
+    void Unlock()
+    {
+      if (--this->Depth == 0)
+        {
+        this->Owner = vtkMultiThreaderIDType();
+        this->Mutex.Unlock();
+        }
+    }
+
+    bool IsHeldByCurrentThread()
+    {
+      return this->Depth > 0 &&
+        vtkMultiThreader::ThreadsEqual(
+          this->Owner, vtkMultiThreader::GetCurrentThreadID()) != 0;
+    }
+
+  private:
+    vtkSimpleCriticalSection Mutex;
+    vtkMultiThreaderIDType Owner;
+    int Depth;
+  };
+
+  SerialLock NonReentrantLock;
+
+  // Add the executive and all the executives upstream of it to upstream.
+  void CollectUpstream(vtkExecutive* e, std::set<vtkExecutive*>& upstream)
+  {
+    if (!e || !upstream.insert(e).second)
+      {
+      return;
+      }
+    for (int i = 0; i < e->GetNumberOfInputPorts(); ++i)
+      {
+      for (int j = 0; j < e->GetNumberOfInputConnections(i); ++j)
+        {
+        CollectUpstream(e->GetInputExecutive(i, j), upstream);
+        }
+      }
+  }
+
+  bool Intersect(const std::set<vtkExecutive*>& a,
+                 const std::set<vtkExecutive*>& b)
+  {
+    const std::set<vtkExecutive*>& small = a.size() < b.size() ? a : b;
+    const std::set<vtkExecutive*>& large = a.size() < b.size() ? b : a;
+    for (std::set<vtkExecutive*>::const_iterator it = small.begin();
+         it != small.end(); ++it)
+      {
+      if (large.find(*it) != large.end())
+        {
+        return true;
+        }
+      }
+    return false;
+  }
+
+  // The input connections whose upstream pipelines share executives, and
+  // all these executives.
+  struct Branch
+  {
+    std::vector<vtkExecutive*> Producers;
+    std::vector<int> ProducerPorts;
+    std::set<vtkExecutive*> Upstream;
+  };
+}
+
+//----------------------------------------------------------------------------
+// Each task forwards a copy of the request to the producers of a branch.
+class vtkDemandDrivenPipelineUpdateBranches
+{
+public:
+  vtkDemandDrivenPipelineUpdateBranches(vtkInformation* request,
+                                        const std::vector<Branch>& branches,
+                                        std::vector<int>& results)
+    : Request(request), Branches(branches), Results(results)
+  {
+  }
+
+  void operator() (vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType b = begin; b < end; ++b)
+      {
+      const Branch& branch = this->Branches[b];
+      vtkSmartPointer<vtkInformation> request =
+        vtkSmartPointer<vtkInformation>::New();
+      request->Copy(this->Request);
+      int result = 1;
+      for (size_t c = 0; c < branch.Producers.size(); ++c)
+        {
+        vtkExecutive* e = branch.Producers[c];
+        request->Set(vtkExecutive::FROM_OUTPUT_PORT(),
+                     branch.ProducerPorts[c]);
+        if (!e->ProcessRequest(request,
+                               e->GetInputInformation(),
+                               e->GetOutputInformation()))
+          {
+          result = 0;
+          }
+        }
+      this->Results[b] = result;
+      }
+  }
+
+private:
+  vtkInformation* Request;
+  const std::vector<Branch>& Branches;
+  std::vector<int>& Results;
+};
 
 //----------------------------------------------------------------------------
 vtkDemandDrivenPipeline::vtkDemandDrivenPipeline()
@@ -53,6 +192,8 @@ vtkDemandDrivenPipeline::vtkDemandDrivenPipeline()
   this->DataObjectRequest = 0;
   this->DataRequest = 0;
   this->PipelineMTime = 0;
+  this->ConcurrentBranches =
+    vtkDemandDrivenPipelineGlobalDefaultConcurrentBranches;
 }
 
 //----------------------------------------------------------------------------
@@ -77,6 +218,20 @@ void vtkDemandDrivenPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "PipelineMTime: " << this->PipelineMTime << "\n";
+  os << indent << "ConcurrentBranches: "
+     << (this->ConcurrentBranches ? "On" : "Off") << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkDemandDrivenPipeline::SetGlobalDefaultConcurrentBranches(bool enable)
+{
+  vtkDemandDrivenPipelineGlobalDefaultConcurrentBranches = enable;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDemandDrivenPipeline::GetGlobalDefaultConcurrentBranches()
+{
+  return vtkDemandDrivenPipelineGlobalDefaultConcurrentBranches;
 }
 
 
@@ -270,8 +425,19 @@ int vtkDemandDrivenPipeline::ProcessRequest(vtkInformation* request,
         return 0;
         }
 
-      // Request data from the algorithm.
+      // Request data from the algorithm, one non-reentrant algorithm at
+      // a time.
+      bool serialize =
+        this->Algorithm->GetInformation()->Get(NON_REENTRANT()) != 0;
+      if(serialize)
+        {
+        NonReentrantLock.Lock();
+        }
       result = this->ExecuteData(request,inInfoVec,outInfoVec);
+      if(serialize)
+        {
+        NonReentrantLock.Unlock();
+        }
 
       // Data are now up to date.
       this->DataTime.Modified();
@@ -294,6 +460,99 @@ int vtkDemandDrivenPipeline::ProcessRequest(vtkInformation* request,
   return this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
 }
 
+//----------------------------------------------------------------------------
+int vtkDemandDrivenPipeline::ForwardUpstream(vtkInformation* request)
+{
+  int result;
+  if(this->ForwardUpstreamConcurrently(request, result))
+    {
+    return result;
+    }
+  return this->Superclass::ForwardUpstream(request);
+}
+
+//----------------------------------------------------------------------------
+bool vtkDemandDrivenPipeline::ForwardUpstreamConcurrently(
+  vtkInformation* request, int& result)
+{
+  // A NON_REENTRANT() algorithm updating an internal pipeline holds the
+  // lock that the branches would wait for.
+  if(!this->ConcurrentBranches || this->SharedInputInformation ||
+     !request->Has(REQUEST_DATA()) ||
+     NonReentrantLock.IsHeldByCurrentThread())
+    {
+    return false;
+    }
+
+  // Group the input connections into branches, merging the branches whose
+  // upstream pipelines share an executive.
+  std::vector<Branch> branches;
+  for(int i=0; i < this->GetNumberOfInputPorts(); ++i)
+    {
+    int nic = this->Algorithm->GetNumberOfInputConnections(i);
+    vtkInformationVector* inVector = this->GetInputInformation()[i];
+    for(int j=0; j < nic; ++j)
+      {
+      vtkInformation* info = inVector->GetInformationObject(j);
+      vtkExecutive* e;
+      int producerPort;
+      vtkExecutive::PRODUCER()->Get(info,e,producerPort);
+      if(!e)
+        {
+        continue;
+        }
+      Branch branch;
+      branch.Producers.push_back(e);
+      branch.ProducerPorts.push_back(producerPort);
+      CollectUpstream(e, branch.Upstream);
+      for(size_t b=0; b < branches.size();)
+        {
+        if(Intersect(branches[b].Upstream, branch.Upstream))
+          {
+          branches[b].Producers.insert(branches[b].Producers.end(),
+                                       branch.Producers.begin(),
+                                       branch.Producers.end());
+          branches[b].ProducerPorts.insert(branches[b].ProducerPorts.end(),
+                                           branch.ProducerPorts.begin(),
+                                           branch.ProducerPorts.end());
+          branches[b].Upstream.insert(branch.Upstream.begin(),
+                                      branch.Upstream.end());
+          branch.Producers.swap(branches[b].Producers);
+          branch.ProducerPorts.swap(branches[b].ProducerPorts);
+          branch.Upstream.swap(branches[b].Upstream);
+          branches.erase(branches.begin() + b);
+          }
+        else
+          {
+          ++b;
+          }
+        }
+      branches.push_back(branch);
+      }
+    }
+  if(branches.size() < 2)
+    {
+    return false;
+    }
+
+  if (!this->Algorithm->ModifyRequest(request, BeforeForward))
+    {
+    result = 0;
+    return true;
+    }
+
+  std::vector<int> results(branches.size(), 1);
+  vtkDemandDrivenPipelineUpdateBranches functor(request, branches, results);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(branches.size()), 1, functor);
+  result = std::find(results.begin(), results.end(), 0) == results.end();
+
+  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+    {
+    result = 0;
+    }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkDemandDrivenPipeline::ResetPipelineInformation(int,
                                                        vtkInformation*)
@@ -17,6 +17,20 @@
 // vtkDemandDrivenPipeline is an executive that will execute an
 // algorithm only when its outputs are out-of-date with respect to its
 // inputs.
+//
+// When ConcurrentBranches is on, the executive forwards REQUEST_DATA to
+// the independent branches of its inputs concurrently with vtkSMPTools.
+// Two input connections are in the same branch when their upstream
+// pipelines share an executive; the connections of a branch are updated
+// one after the other. Algorithms that cannot execute while
+// another algorithm executes, for example readers using a library that is
+// not thread safe, declare it by setting NON_REENTRANT() in their
+// information: their REQUEST_DATA passes are then executed one at a time.
+//
+// .SECTION Caveats
+// While branches are updated concurrently, the observers of the
+// algorithms of the branches, for example of their progress events, are
+// invoked from the threads of the vtkSMPTools back-end.
 
 #ifndef vtkDemandDrivenPipeline_h
 #define vtkDemandDrivenPipeline_h
@@ -138,6 +152,28 @@ public:
   // @ingroup InformationKeys
   static vtkInformationIntegerKey* DATA_NOT_GENERATED();
 
+  // Description:
+  // Key placed in the information of an algorithm, see
+  // vtkAlgorithm::GetInformation(), to declare that its REQUEST_DATA pass
+  // must not execute concurrently with the REQUEST_DATA pass of another
+  // algorithm declaring it. See ConcurrentBranches.
+  // @ingroup InformationKeys
+  static vtkInformationIntegerKey* NON_REENTRANT();
+
+  // Description:
+  // Enable/Disable forwarding REQUEST_DATA to the independent branches of
+  // the inputs concurrently. The default is given by
+  // GlobalDefaultConcurrentBranches.
+  vtkSetMacro(ConcurrentBranches, bool);
+  vtkGetMacro(ConcurrentBranches, bool);
+  vtkBooleanMacro(ConcurrentBranches, bool);
+
+  // Description:
+  // Set the value ConcurrentBranches is initialized with in the executives
+  // created afterwards. The default is false.
+  static void SetGlobalDefaultConcurrentBranches(bool enable);
+  static bool GetGlobalDefaultConcurrentBranches();
+
   // Description:
   // Create (New) and return a data object of the given type.
   // This is here for backwards compatibility. Use
@@ -159,6 +195,17 @@ protected:
                           vtkInformationVector** inInfo,
                           vtkInformationVector* outInfo);
 
+  // Forward REQUEST_DATA to the independent branches of the inputs
+  // concurrently when ConcurrentBranches is on.
+  virtual int ForwardUpstream(vtkInformation* request);
+
+  // Description:
+  // Forward the request concurrently to the independent branches of the
+  // inputs and store the result in result. Returns false without doing
+  // anything when the request is not REQUEST_DATA, ConcurrentBranches is
+  // off, the inputs are shared or form less than two branches, or when
+  // called while a NON_REENTRANT() algorithm executes.
+  bool ForwardUpstreamConcurrently(vtkInformation* request, int& result);
 
   // Reset the pipeline update values in the given output information object.
   virtual void ResetPipelineInformation(int, vtkInformation*);
@@ -212,6 +259,8 @@ protected:
   vtkTimeStamp InformationTime;
   vtkTimeStamp DataTime;
 
+  bool ConcurrentBranches;
+
 //BTX
   friend class vtkCompositeDataPipeline;
 //ETX
@@ -0,0 +1,546 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkExecutionProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkExecutionProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkDemandDrivenPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
+#include "vtkTimerLog.h"
+#include "vtkTrackingDataArrayAllocator.h"
+
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkExecutionProfiler);
+
+static vtkExecutionProfiler *vtkExecutionProfilerActive = NULL;
+
+//----------------------------------------------------------------------------
+struct vtkExecutionProfilerEvent
+{
+  std::string ClassName;
+  std::string Algorithm;
+  std::string Request;
+  double StartTime;
+  double EndTime;
+  int Thread;
+  bool DataRequest;
+  unsigned long InputSize;
+  unsigned long OutputSizeBefore;
+  unsigned long OutputSize;
+  bool Tracked;
+  const void *Owner;
+  vtkTypeInt64 Allocated;
+  vtkTypeInt64 TotalAllocated;
+  std::string Arguments;
+};
+
+class vtkExecutionProfilerInternals
+{
+public:
+  vtkSimpleCriticalSection Lock;
+  std::vector<vtkExecutionProfilerEvent> Events;
+  std::vector<vtkMultiThreaderIDType> Threads;
+  double Origin;
+  bool Recording;
+
+  // Add the event if recording, timing its start. Returns its id or -1.
+  vtkIdType Add(vtkExecutionProfilerEvent& event)
+  {
+    vtkMultiThreaderIDType thread = vtkMultiThreader::GetCurrentThreadID();
+    this->Lock.Lock();
+    if (!this->Recording)
+      {
+      this->Lock.Unlock();
+      return -1;
+      }
+    event.Thread = this->GetThread(thread);
+    event.StartTime = vtkTimerLog::GetUniversalTime() - this->Origin;
+    event.EndTime = event.StartTime;
+    vtkIdType id = static_cast<vtkIdType>(this->Events.size());
+    this->Events.push_back(event);
+    this->Lock.Unlock();
+    return id;
+  }
+
+  // Number the thread in the order they are seen. Called with the lock.
+  int GetThread(vtkMultiThreaderIDType id)
+  {
+    for (size_t i = 0; i < this->Threads.size(); ++i)
+      {
+      if (vtkMultiThreader::ThreadsEqual(this->Threads[i], id))
+        {
+        return static_cast<int>(i);
+        }
+      }
+    this->Threads.push_back(id);
+    return static_cast<int>(this->Threads.size()) - 1;
+  }
+};
+
+//----------------------------------------------------------------------------
+// The memory size of the data objects of the information vector.
+static unsigned long vtkExecutionProfilerSize(vtkInformationVector *infoVec)
+{
+  unsigned long size = 0;
+  for (int i = 0; infoVec && i < infoVec->GetNumberOfInformationObjects(); ++i)
+    {
+    vtkDataObject *data =
+      infoVec->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+    if (data)
+      {
+      size += data->GetActualMemorySize();
+      }
+    }
+  return size;
+}
+
+// JSON string, with the quotes and backslashes escaped.
+static std::string vtkExecutionProfilerQuote(const std::string& s)
+{
+  std::string quoted = "\"";
+  for (size_t i = 0; i < s.size(); ++i)
+    {
+    if (s[i] == '"' || s[i] == '\\')
+      {
+      quoted += '\\';
+      }
+    quoted += s[i];
+    }
+  return quoted + "\"";
+}
+
+//----------------------------------------------------------------------------
+vtkExecutionProfiler::vtkExecutionProfiler()
+{
+  this->Internals = new vtkExecutionProfilerInternals;
+  this->Internals->Origin = 0.0;
+  this->Internals->Recording = false;
+  this->Tracker = NULL;
+  this->TrackAllocations = 0;
+  this->ProcessId = 0;
+  this->ClockOffset = 0.0;
+}
+
+//----------------------------------------------------------------------------
+vtkExecutionProfiler::~vtkExecutionProfiler()
+{
+  this->Stop();
+  // The arrays allocated while tracking keep the tracker alive.
+  if (this->Tracker)
+    {
+    this->Tracker->Delete();
+    }
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::Start()
+{
+  if (vtkExecutionProfilerActive == this)
+    {
+    return;
+    }
+  if (vtkExecutionProfilerActive)
+    {
+    vtkExecutionProfilerActive->Stop();
+    }
+  this->Internals->Lock.Lock();
+  if (this->Internals->Events.empty())
+    {
+    this->Internals->Origin = vtkTimerLog::GetUniversalTime();
+    }
+  this->Internals->Recording = true;
+  this->Internals->Lock.Unlock();
+  if (this->TrackAllocations)
+    {
+    if (!this->Tracker)
+      {
+      this->Tracker = vtkTrackingDataArrayAllocator::New();
+      }
+    this->Tracker->Start();
+    }
+  vtkExecutionProfilerActive = this;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::Stop()
+{
+  if (vtkExecutionProfilerActive == this)
+    {
+    vtkExecutionProfilerActive = NULL;
+    }
+  this->Internals->Lock.Lock();
+  this->Internals->Recording = false;
+  this->Internals->Lock.Unlock();
+  if (this->Tracker)
+    {
+    this->Tracker->Stop();
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkExecutionProfiler::IsRecording()
+{
+  return vtkExecutionProfilerActive == this;
+}
+
+//----------------------------------------------------------------------------
+vtkExecutionProfiler *vtkExecutionProfiler::GetActiveProfiler()
+{
+  return vtkExecutionProfilerActive;
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::Clear()
+{
+  this->Internals->Lock.Lock();
+  this->Internals->Events.clear();
+  this->Internals->Threads.clear();
+  this->Internals->Origin = vtkTimerLog::GetUniversalTime();
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkExecutionProfiler::BeginRequest(vtkAlgorithm *algorithm,
+                                             vtkInformation *request,
+                                             vtkInformationVector **inInfo,
+                                             vtkInformationVector *outInfo)
+{
+  vtkExecutionProfilerEvent event;
+  event.ClassName = algorithm->GetClassName();
+  std::ostringstream address;
+  address << algorithm;
+  event.Algorithm = address.str();
+
+  // The pass is given by the request key of the request.
+  if (vtkInformationRequestKey *key = request->GetRequest())
+    {
+    event.Request = key->GetName();
+    }
+
+  event.DataRequest = request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()) != 0;
+  event.InputSize = 0;
+  event.OutputSizeBefore = 0;
+  if (event.DataRequest)
+    {
+    for (int port = 0; inInfo && port < algorithm->GetNumberOfInputPorts();
+         ++port)
+      {
+      event.InputSize += vtkExecutionProfilerSize(inInfo[port]);
+      }
+    event.OutputSizeBefore = vtkExecutionProfilerSize(outInfo);
+    }
+  event.OutputSize = event.OutputSizeBefore;
+  event.Tracked = event.DataRequest && this->Tracker &&
+    this->Tracker->IsTracking();
+  event.Owner = algorithm;
+  event.Allocated = 0;
+  event.TotalAllocated = 0;
+
+  vtkIdType id = this->Internals->Add(event);
+  if (id >= 0 && event.Tracked)
+    {
+    this->Tracker->BeginOwner(algorithm);
+    }
+  return id;
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::EndRequest(vtkIdType id, vtkInformationVector *outInfo)
+{
+  double endTime = vtkTimerLog::GetUniversalTime();
+  this->Internals->Lock.Lock();
+  if (id >= 0 && id < static_cast<vtkIdType>(this->Internals->Events.size()))
+    {
+    vtkExecutionProfilerEvent& event = this->Internals->Events[id];
+    event.EndTime = endTime - this->Internals->Origin;
+    if (event.DataRequest)
+      {
+      event.OutputSize = vtkExecutionProfilerSize(outInfo);
+      }
+    if (event.Tracked)
+      {
+      this->Tracker->EndOwner();
+      event.Allocated = this->Tracker->GetAllocatedSize(event.Owner);
+      event.TotalAllocated = this->Tracker->GetAllocatedSize();
+      }
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkExecutionProfiler::BeginEvent(const char *name,
+                                           const char *category)
+{
+  vtkExecutionProfilerEvent event;
+  event.ClassName = name ? name : "";
+  event.Request = category ? category : "";
+  event.DataRequest = false;
+  event.InputSize = 0;
+  event.OutputSizeBefore = 0;
+  event.OutputSize = 0;
+  event.Tracked = false;
+  event.Owner = NULL;
+  event.Allocated = 0;
+  event.TotalAllocated = 0;
+  return this->Internals->Add(event);
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::AddEventArgument(vtkIdType id, const char *name,
+                                            vtkTypeInt64 value)
+{
+  if (id < 0 || !name)
+    {
+    return;
+    }
+  std::ostringstream argument;
+  argument << "," << vtkExecutionProfilerQuote(name) << ":" << value;
+  this->Internals->Lock.Lock();
+  if (id < static_cast<vtkIdType>(this->Internals->Events.size()))
+    {
+    this->Internals->Events[id].Arguments += argument.str();
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::EndEvent(vtkIdType id)
+{
+  double endTime = vtkTimerLog::GetUniversalTime();
+  this->Internals->Lock.Lock();
+  if (id >= 0 && id < static_cast<vtkIdType>(this->Internals->Events.size()))
+    {
+    this->Internals->Events[id].EndTime = endTime - this->Internals->Origin;
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+double vtkExecutionProfiler::GetTimeOrigin()
+{
+  return this->Internals->Origin;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkExecutionProfiler::GetNumberOfEvents()
+{
+  return static_cast<vtkIdType>(this->Internals->Events.size());
+}
+
+//----------------------------------------------------------------------------
+const char *vtkExecutionProfiler::GetEventClassName(vtkIdType event)
+{
+  return this->Internals->Events[event].ClassName.c_str();
+}
+
+//----------------------------------------------------------------------------
+const char *vtkExecutionProfiler::GetEventRequest(vtkIdType event)
+{
+  return this->Internals->Events[event].Request.c_str();
+}
+
+//----------------------------------------------------------------------------
+double vtkExecutionProfiler::GetEventStartTime(vtkIdType event)
+{
+  return this->Internals->Events[event].StartTime;
+}
+
+//----------------------------------------------------------------------------
+double vtkExecutionProfiler::GetEventDuration(vtkIdType event)
+{
+  const vtkExecutionProfilerEvent& e = this->Internals->Events[event];
+  return e.EndTime - e.StartTime;
+}
+
+//----------------------------------------------------------------------------
+int vtkExecutionProfiler::GetEventThread(vtkIdType event)
+{
+  return this->Internals->Events[event].Thread;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkExecutionProfiler::GetEventInputSize(vtkIdType event)
+{
+  return this->Internals->Events[event].InputSize;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkExecutionProfiler::GetEventOutputSize(vtkIdType event)
+{
+  return this->Internals->Events[event].OutputSize;
+}
+
+//----------------------------------------------------------------------------
+long vtkExecutionProfiler::GetEventMemoryDelta(vtkIdType event)
+{
+  const vtkExecutionProfilerEvent& e = this->Internals->Events[event];
+  return static_cast<long>(e.OutputSize) - static_cast<long>(e.OutputSizeBefore);
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkExecutionProfiler::GetEventAllocatedSize(vtkIdType event)
+{
+  return this->Internals->Events[event].Allocated;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkExecutionProfiler::GetEventTotalAllocatedSize(vtkIdType event)
+{
+  return this->Internals->Events[event].TotalAllocated;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkExecutionProfiler::GetAllocatedSize(vtkAlgorithm *algorithm)
+{
+  return this->Tracker ? this->Tracker->GetAllocatedSize(algorithm) : 0;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkExecutionProfiler::GetPeakAllocatedSize(vtkAlgorithm *algorithm)
+{
+  return this->Tracker ? this->Tracker->GetPeakAllocatedSize(algorithm) : 0;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkExecutionProfiler::GetPipelineAllocatedSize(vtkAlgorithm *sink)
+{
+  if (!this->Tracker || !sink)
+    {
+    return 0;
+    }
+  vtkTypeInt64 size = 0;
+  std::set<vtkAlgorithm*> visited;
+  std::vector<vtkAlgorithm*> stack(1, sink);
+  visited.insert(sink);
+  while (!stack.empty())
+    {
+    vtkAlgorithm *algorithm = stack.back();
+    stack.pop_back();
+    size += this->Tracker->GetAllocatedSize(algorithm);
+    for (int port = 0; port < algorithm->GetNumberOfInputPorts(); ++port)
+      {
+      for (int i = 0; i < algorithm->GetNumberOfInputConnections(port); ++i)
+        {
+        vtkAlgorithm *input = algorithm->GetInputAlgorithm(port, i);
+        if (input && visited.insert(input).second)
+          {
+          stack.push_back(input);
+          }
+        }
+      }
+    }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkExecutionProfiler::GetTotalAllocatedSize()
+{
+  return this->Tracker ? this->Tracker->GetAllocatedSize() : 0;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkExecutionProfiler::GetPeakTotalAllocatedSize()
+{
+  return this->Tracker ? this->Tracker->GetPeakAllocatedSize() : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkExecutionProfiler::WriteTrace(const char *fileName)
+{
+  ofstream os(fileName);
+  if (!os)
+    {
+    vtkErrorMacro("Could not open " << (fileName ? fileName : "(null)"));
+    return 0;
+    }
+  this->WriteTrace(os);
+  return os.good() ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::WriteTrace(ostream& os)
+{
+  os << "{\"traceEvents\":[";
+  this->WriteTraceEvents(os);
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::WriteTraceEvents(ostream& os)
+{
+  this->Internals->Lock.Lock();
+  for (size_t i = 0; i < this->Internals->Events.size(); ++i)
+    {
+    const vtkExecutionProfilerEvent& e = this->Internals->Events[i];
+    os << (i ? ",\n" : "\n")
+       << "{\"name\":" << vtkExecutionProfilerQuote(e.ClassName)
+       << ",\"cat\":" << vtkExecutionProfilerQuote(e.Request)
+       << ",\"ph\":\"X\",\"pid\":" << this->ProcessId
+       << ",\"tid\":" << e.Thread
+       << ",\"ts\":"
+       << static_cast<vtkTypeInt64>((e.StartTime + this->ClockOffset) * 1e6)
+       << ",\"dur\":" << static_cast<vtkTypeInt64>((e.EndTime - e.StartTime) * 1e6)
+       << ",\"args\":{";
+    if (!e.Algorithm.empty())
+      {
+      os << "\"algorithm\":" << vtkExecutionProfilerQuote(e.Algorithm);
+      }
+    if (e.DataRequest)
+      {
+      os << ",\"input_kib\":" << e.InputSize
+         << ",\"output_kib\":" << e.OutputSize
+         << ",\"memory_delta_kib\":"
+         << static_cast<long>(e.OutputSize) - static_cast<long>(e.OutputSizeBefore);
+      }
+    if (e.Tracked)
+      {
+      os << ",\"allocated_kib\":" << e.Allocated / 1024;
+      }
+    // The arguments of the events without an algorithm start with a comma.
+    os << (e.Algorithm.empty() && !e.Arguments.empty() ?
+           e.Arguments.substr(1) : e.Arguments) << "}}";
+    if (e.Tracked)
+      {
+      os << ",\n{\"name\":\"allocated\",\"ph\":\"C\",\"pid\":" << this->ProcessId
+         << ",\"ts\":"
+         << static_cast<vtkTypeInt64>((e.EndTime + this->ClockOffset) * 1e6)
+         << ",\"args\":{\"kib\":" << e.TotalAllocated / 1024 << "}}";
+      }
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Recording: " << (this->IsRecording() ? "On" : "Off") << endl;
+  os << indent << "NumberOfEvents: " << this->GetNumberOfEvents() << endl;
+  os << indent << "TrackAllocations: " << this->TrackAllocations << endl;
+  os << indent << "ProcessId: " << this->ProcessId << endl;
+  os << indent << "ClockOffset: " << this->ClockOffset << endl;
+}
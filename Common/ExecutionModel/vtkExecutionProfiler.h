@@ -0,0 +1,197 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkExecutionProfiler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkExecutionProfiler - Record the requests executed by all pipelines
+// .SECTION Description
+// While started, vtkExecutionProfiler records every request that an
+// executive invokes on its algorithm: the class of the algorithm, the pass
+// (REQUEST_DATA_OBJECT, REQUEST_INFORMATION, REQUEST_UPDATE_EXTENT,
+// REQUEST_DATA...), the wall clock time and the thread of the execution.
+// For the REQUEST_DATA passes it also records the memory size of the inputs
+// and of the outputs, and how much the outputs grew during the request.
+// The events can be written as a Chrome trace, which chrome://tracing and
+// other trace viewers display as a timeline.
+//
+// Unlike vtkExecutionTimer, which observes one filter, the profiler sees
+// the whole pipeline, including the blocks of composite data sets executed
+// concurrently. When no profiler is started, the executives only check for
+// one before each request.
+//
+// Other code can record its own events with BeginEvent() and EndEvent();
+// vtkMPICommunicator records its communications this way. The ProcessId
+// and ClockOffset let the traces of several processes be merged into one,
+// as vtkMPIEventLog does.
+//
+// With TrackAllocations on, the profiler also counts the memory of the
+// data arrays allocated by each algorithm while it executes its
+// REQUEST_DATA pass, with a vtkTrackingDataArrayAllocator. This is the
+// memory the algorithm holds, its outputs mostly, rather than the growth
+// of its outputs, and it can be summed over a pipeline.
+//
+// .SECTION See Also
+// vtkExecutionTimer vtkTimerLog vtkTrackingDataArrayAllocator
+
+#ifndef vtkExecutionProfiler_h
+#define vtkExecutionProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkAlgorithm;
+class vtkInformation;
+class vtkInformationVector;
+class vtkExecutionProfilerInternals;
+class vtkTrackingDataArrayAllocator;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkExecutionProfiler : public vtkObject
+{
+public:
+  static vtkExecutionProfiler *New();
+  vtkTypeMacro(vtkExecutionProfiler, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Start or stop recording the requests of all the executives. One
+  // profiler records at a time: starting a profiler stops the one that was
+  // recording. Stop the profiler before deleting it while pipelines are
+  // executing in other threads.
+  void Start();
+  void Stop();
+  bool IsRecording();
+
+  // Description:
+  // The profiler that is recording, or NULL.
+  static vtkExecutionProfiler *GetActiveProfiler();
+
+  // Description:
+  // Count the memory of the data arrays allocated by the algorithms. It
+  // takes effect at the next Start(), and the counts are kept when the
+  // profiler stops. Every allocation takes a lock while tracking. Initial
+  // value is off.
+  vtkSetMacro(TrackAllocations, int);
+  vtkGetMacro(TrackAllocations, int);
+  vtkBooleanMacro(TrackAllocations, int);
+
+  // Description:
+  // The bytes of the data arrays allocated by the algorithm during its
+  // REQUEST_DATA passes that are still held, and the largest value it
+  // reached. These are 0 unless allocations were tracked.
+  vtkTypeInt64 GetAllocatedSize(vtkAlgorithm *algorithm);
+  vtkTypeInt64 GetPeakAllocatedSize(vtkAlgorithm *algorithm);
+
+  // Description:
+  // The bytes allocated by the sink and by all the algorithms upstream of
+  // it, each counted once.
+  vtkTypeInt64 GetPipelineAllocatedSize(vtkAlgorithm *sink);
+
+  // Description:
+  // The bytes of all the data arrays allocated while tracking that are
+  // still held, whichever code allocated them, and the largest value it
+  // reached.
+  vtkTypeInt64 GetTotalAllocatedSize();
+  vtkTypeInt64 GetPeakTotalAllocatedSize();
+
+  // Description:
+  // Remove the recorded events. The times of the next events are relative
+  // to this call, or to the first start of the profiler.
+  void Clear();
+
+  // Description:
+  // Access the recorded events, in the order their requests started. The
+  // times are in seconds, the sizes are in kibibytes as given by
+  // vtkDataObject::GetActualMemorySize(), and the threads are numbered in
+  // the order they were first seen. The sizes are 0 for the other passes
+  // than REQUEST_DATA.
+  vtkIdType GetNumberOfEvents();
+  const char *GetEventClassName(vtkIdType event);
+  const char *GetEventRequest(vtkIdType event);
+  double GetEventStartTime(vtkIdType event);
+  double GetEventDuration(vtkIdType event);
+  int GetEventThread(vtkIdType event);
+  unsigned long GetEventInputSize(vtkIdType event);
+  unsigned long GetEventOutputSize(vtkIdType event);
+  long GetEventMemoryDelta(vtkIdType event);
+
+  // Description:
+  // The bytes held by the algorithm of the event, and by all the
+  // algorithms, at the end of a REQUEST_DATA pass. These are 0 for the
+  // other passes and when allocations are not tracked.
+  vtkTypeInt64 GetEventAllocatedSize(vtkIdType event);
+  vtkTypeInt64 GetEventTotalAllocatedSize(vtkIdType event);
+
+  // Description:
+  // Write the events in the Chrome trace event format, as complete events
+  // with their sizes as arguments. When allocations are tracked, the total
+  // is also written as a counter at the end of each REQUEST_DATA pass. Returns 0 if the file cannot be written.
+  int WriteTrace(const char *fileName);
+  void WriteTrace(ostream& os);
+
+  // Description:
+  // Write the events only, separated by commas, without the enclosing
+  // object. The events of several profilers written this way can be joined
+  // with commas in the traceEvents array of one trace.
+  void WriteTraceEvents(ostream& os);
+
+  // Description:
+  // The process id of the events in the trace. Initial value is 0.
+  vtkSetMacro(ProcessId, int);
+  vtkGetMacro(ProcessId, int);
+
+  // Description:
+  // Seconds added to the times of the events in the trace, so that the
+  // traces of processes whose clocks differ share the same time origin.
+  // Initial value is 0.
+  vtkSetMacro(ClockOffset, double);
+  vtkGetMacro(ClockOffset, double);
+
+  // Description:
+  // The vtkTimerLog::GetUniversalTime() at which the times of the events
+  // start.
+  double GetTimeOrigin();
+
+  // Description:
+  // Record an event that is not a pipeline request, such as a
+  // communication. The name and category are shown by the trace viewers,
+  // and integer arguments may be attached to the event before it ends.
+  // BeginEvent() returns -1 when the profiler is not recording; the other
+  // methods ignore that event. These are thread safe.
+  vtkIdType BeginEvent(const char *name, const char *category);
+  void AddEventArgument(vtkIdType event, const char *name, vtkTypeInt64 value);
+  void EndEvent(vtkIdType event);
+
+  // Description:
+  // Called by the executives around the requests they invoke on their
+  // algorithm. BeginRequest() returns the event to pass to EndRequest().
+  // These are thread safe.
+  vtkIdType BeginRequest(vtkAlgorithm *algorithm, vtkInformation *request,
+                         vtkInformationVector **inInfo,
+                         vtkInformationVector *outInfo);
+  void EndRequest(vtkIdType event, vtkInformationVector *outInfo);
+
+protected:
+  vtkExecutionProfiler();
+  ~vtkExecutionProfiler();
+
+  vtkExecutionProfilerInternals *Internals;
+  vtkTrackingDataArrayAllocator *Tracker;
+  int TrackAllocations;
+  int ProcessId;
+  double ClockOffset;
+
+private:
+  vtkExecutionProfiler(const vtkExecutionProfiler&);  // Not implemented.
+  void operator=(const vtkExecutionProfiler&);  // Not implemented.
+};
+
+#endif
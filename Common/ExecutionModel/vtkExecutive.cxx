@@ -17,6 +17,7 @@
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
 #include "vtkDataObject.h"
+#include "vtkExecutionProfiler.h"
 #include "vtkGarbageCollector.h"
 #include "vtkInformation.h"
 #include "vtkInformationExecutivePortKey.h"
@@ -771,9 +772,16 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
   // Invoke the request on the algorithm.
+  vtkExecutionProfiler* profiler = vtkExecutionProfiler::GetActiveProfiler();
+  vtkIdType event = profiler ?
+    profiler->BeginRequest(this->Algorithm, request, inInfo, outInfo) : -1;
   this->InAlgorithm = 1;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
   this->InAlgorithm = 0;
+  if(profiler)
+    {
+    profiler->EndRequest(event, outInfo);
+    }
 
   // If the algorithm failed report it now.
   if(!result)
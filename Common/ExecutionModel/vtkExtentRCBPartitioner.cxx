@@ -14,6 +14,7 @@
  =========================================================================*/
 
 #include "vtkExtentRCBPartitioner.h"
+#include "vtkDataArray.h"
 #include "vtkObjectFactory.h"
 #include "vtkMath.h"
 #include "vtkPriorityQueue.h"
@@ -34,10 +35,13 @@ vtkExtentRCBPartitioner::vtkExtentRCBPartitioner()
   this->DuplicateNodes       = 1;
   this->ExtentIsPartitioned  = false;
   this->DataDescription      = VTK_EMPTY;
+  this->Costs                = NULL;
   for( int i=0; i < 3; ++i )
     {
     this->GlobalExtent[ i*2   ] = 0;
     this->GlobalExtent[ i*2+1 ] = 0;
+    this->CostDimensions[ i ]  = -1;
+    this->CostTableDimensions[ i ] = 0;
     }
 }
 
@@ -45,6 +49,40 @@ vtkExtentRCBPartitioner::vtkExtentRCBPartitioner()
 vtkExtentRCBPartitioner::~vtkExtentRCBPartitioner()
 {
   this->PartitionExtents.clear();
+  if( this->Costs != NULL )
+    {
+    this->Costs->UnRegister( this );
+    }
+}
+
+//------------------------------------------------------------------------------
+void vtkExtentRCBPartitioner::SetCosts(vtkDataArray *costs, const int dims[3])
+{
+  this->Reset();
+  if( costs != this->Costs )
+    {
+    if( this->Costs != NULL )
+      {
+      this->Costs->UnRegister( this );
+      }
+    this->Costs = costs;
+    if( this->Costs != NULL )
+      {
+      this->Costs->Register( this );
+      }
+    }
+  for( int i=0; i < 3; ++i )
+    {
+    this->CostDimensions[ i ] = dims[ i ];
+    }
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkExtentRCBPartitioner::SetCellCosts(vtkDataArray *costs)
+{
+  int dims[3] = { -1, -1, -1 };
+  this->SetCosts( costs, dims );
 }
 
 //------------------------------------------------------------------------------
@@ -54,6 +92,7 @@ void vtkExtentRCBPartitioner::PrintSelf( std::ostream &oss, vtkIndent indent )
   oss << "Number of partitions: " << this->NumberOfPartitions << endl;
   oss << "Number of extents: " << this->NumExtents << endl;
   oss << "Number of ghost layers: " << this->NumberOfGhostLayers << endl;
+  oss << "Costs: " << this->Costs << endl;
   oss << "Global Extent: ";
   for( int i=0; i < 6; ++i )
     {
@@ -81,12 +120,21 @@ void vtkExtentRCBPartitioner::Partition()
     return;
     }
 
-  // STEP 1: Insert the global extent to the workQueue
+  // STEP 1: Insert the global extent to the workQueue. With costs, the
+  // most expensive extent is split first, otherwise the largest.
+  bool useCosts = this->BuildCostTable();
   vtkPriorityQueue *wrkQueue = vtkPriorityQueue::New();
   assert( "pre: work queue is NULL" && (wrkQueue != NULL) );
 
   this->AddExtent( this->GlobalExtent );
-  wrkQueue->Insert( this->GetNumberOfNodes( this->GlobalExtent), 0);
+  if( useCosts )
+    {
+    wrkQueue->Insert( -this->GetCost( this->GlobalExtent ), 0 );
+    }
+  else
+    {
+    wrkQueue->Insert( this->GetNumberOfNodes( this->GlobalExtent), 0);
+    }
 
   int ex[6]; // temporary buffer to store the current extent
   int s1[6]; // temporary buffer to store the sub-extent s1
@@ -95,6 +143,21 @@ void vtkExtentRCBPartitioner::Partition()
   // STEP 2: Loop until number of partitions is attained
   while( this->NumExtents < this->NumberOfPartitions )
     {
+    if( useCosts )
+      {
+      vtkIdType extentIdx = wrkQueue->Pop( 0 );
+      this->GetExtent( extentIdx, ex );
+      int ldim = this->GetLongestDimension( ex );
+
+      this->SplitExtentByCost( ex, s1, s2, ldim );
+      this->ReplaceExtent(extentIdx, s1);
+      this->AddExtent(s2);
+
+      wrkQueue->Insert( -this->GetCost( s1 ),extentIdx );
+      wrkQueue->Insert( -this->GetCost( s2 ),this->NumExtents-1);
+      continue;
+      }
+
     vtkIdType extentIdx = wrkQueue->Pop(wrkQueue->GetNumberOfItems()-1);
     this->GetExtent( extentIdx, ex );
     int ldim = this->GetLongestDimension( ex );
@@ -109,6 +172,7 @@ void vtkExtentRCBPartitioner::Partition()
 
   // STEP 3: Clear priority data-structures
   wrkQueue->Delete();
+  this->CostTable.clear();
 
   // STEP 4: Loop through all the extents and add ghost layers
   if( this->NumberOfGhostLayers > 0 )
@@ -238,6 +302,186 @@ void vtkExtentRCBPartitioner::SplitExtent(
 
 }
 
+//------------------------------------------------------------------------------
+void vtkExtentRCBPartitioner::SplitExtentByCost(
+    int parent[6], int s1[6], int s2[6], int splitDimension )
+{
+  int minIdx = 2*(splitDimension-1);
+  int maxIdx = minIdx+1;
+
+  // At least a cell is needed on each side of the split.
+  if( parent[maxIdx]-parent[minIdx] < 2 )
+    {
+    this->SplitExtent( parent, s1, s2, splitDimension );
+    return;
+    }
+
+  for( int i=0; i < 6; ++i )
+    {
+    s1[ i ] = s2[ i ] = parent[ i ];
+    }
+
+  // The cost of the lower half grows with the split node: find the first
+  // node where it reaches half of the total, then keep it or the previous
+  // node, whichever is closer.
+  double target = 0.5*this->GetCost( parent );
+  int lo = parent[minIdx]+1;
+  int hi = parent[maxIdx]-1;
+  while( lo < hi )
+    {
+    int mid = lo + (hi-lo)/2;
+    s1[ maxIdx ] = mid;
+    if( this->GetCost( s1 ) < target )
+      {
+      lo = mid+1;
+      }
+    else
+      {
+      hi = mid;
+      }
+    }
+  int split = lo;
+  if( split > parent[minIdx]+1 )
+    {
+    s1[ maxIdx ] = split;
+    double above = this->GetCost( s1 ) - target;
+    s1[ maxIdx ] = split-1;
+    double below = target - this->GetCost( s1 );
+    if( below < above )
+      {
+      --split;
+      }
+    }
+
+  s1[ maxIdx ] = split;
+  s2[ minIdx ] = ( this->DuplicateNodes == 1 )? split : split+1;
+}
+
+//------------------------------------------------------------------------------
+bool vtkExtentRCBPartitioner::BuildCostTable()
+{
+  this->CostTable.clear();
+  if( this->Costs == NULL )
+    {
+    return false;
+    }
+
+  int dims[3];
+  vtkIdType numBlocks = 1;
+  for( int i=0; i < 3; ++i )
+    {
+    int numCells = this->GlobalExtent[2*i+1]-this->GlobalExtent[2*i];
+    dims[ i ] = ( this->CostDimensions[i] < 0 )?
+        std::max( numCells, 1 ) : this->CostDimensions[ i ];
+    numBlocks *= dims[ i ];
+    }
+  if( numBlocks < 1 || this->Costs->GetNumberOfTuples() != numBlocks )
+    {
+    vtkErrorMacro( "Expected " << numBlocks << " costs, got "
+                   << this->Costs->GetNumberOfTuples()
+                   << ", partitioning by number of nodes." );
+    return false;
+    }
+
+  int sx = dims[0]+1;
+  int sy = dims[1]+1;
+  int sz = dims[2]+1;
+  this->CostTable.assign( static_cast<size_t>(sx)*sy*sz, 0.0 );
+  double *S = &this->CostTable[0];
+  vtkIdType blockIdx = 0;
+  for( int k=1; k < sz; ++k )
+    {
+    for( int j=1; j < sy; ++j )
+      {
+      for( int i=1; i < sx; ++i, ++blockIdx )
+        {
+        size_t idx = (static_cast<size_t>(k)*sy+j)*sx+i;
+        S[idx] = this->Costs->GetComponent( blockIdx, 0 )
+               + S[idx-1] + S[idx-sx] + S[idx-sx*sy]
+               - S[idx-1-sx] - S[idx-1-sx*sy] - S[idx-sx-sx*sy]
+               + S[idx-1-sx-sx*sy];
+        }
+      }
+    }
+  for( int i=0; i < 3; ++i )
+    {
+    this->CostTableDimensions[ i ] = dims[ i ];
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+double vtkExtentRCBPartitioner::GetSummedCost( double x, double y, double z )
+{
+  // The summed cost is multilinear within each block since the cost of a
+  // block is spread evenly over it, so trilinear interpolation is exact.
+  double p[3] = { x, y, z };
+  int i0[3];
+  double t[3];
+  for( int i=0; i < 3; ++i )
+    {
+    int dim = this->CostTableDimensions[ i ];
+    p[ i ] = std::min( std::max( p[i], 0.0 ), static_cast<double>(dim) );
+    i0[ i ] = std::min( static_cast<int>( p[i] ), dim-1 );
+    t[ i ] = p[ i ]-i0[ i ];
+    }
+
+  int sx = this->CostTableDimensions[0]+1;
+  int sy = this->CostTableDimensions[1]+1;
+  const double *S = &this->CostTable[0];
+  double value = 0.0;
+  for( int c=0; c < 8; ++c )
+    {
+    int di = c & 1;
+    int dj = (c >> 1) & 1;
+    int dk = (c >> 2) & 1;
+    double w = ( di? t[0] : 1.0-t[0] )*
+               ( dj? t[1] : 1.0-t[1] )*
+               ( dk? t[2] : 1.0-t[2] );
+    if( w != 0.0 )
+      {
+      size_t idx =
+        (static_cast<size_t>(i0[2]+dk)*sy+(i0[1]+dj))*sx+(i0[0]+di);
+      value += w*S[ idx ];
+      }
+    }
+  return( value );
+}
+
+//------------------------------------------------------------------------------
+double vtkExtentRCBPartitioner::GetCost( int ext[6] )
+{
+  // Position of the bounds of the cells of ext in cost block coordinates.
+  double lo[3];
+  double hi[3];
+  for( int i=0; i < 3; ++i )
+    {
+    int numCells = this->GlobalExtent[2*i+1]-this->GlobalExtent[2*i];
+    int dim      = this->CostTableDimensions[ i ];
+    if( numCells <= 0 )
+      {
+      lo[ i ] = 0.0;
+      hi[ i ] = dim;
+      }
+    else
+      {
+      lo[ i ] = static_cast<double>(ext[2*i]-this->GlobalExtent[2*i])*
+                dim/numCells;
+      hi[ i ] = static_cast<double>(ext[2*i+1]-this->GlobalExtent[2*i])*
+                dim/numCells;
+      }
+    }
+
+  return( this->GetSummedCost( hi[0], hi[1], hi[2] )
+        - this->GetSummedCost( lo[0], hi[1], hi[2] )
+        - this->GetSummedCost( hi[0], lo[1], hi[2] )
+        - this->GetSummedCost( hi[0], hi[1], lo[2] )
+        + this->GetSummedCost( lo[0], lo[1], hi[2] )
+        + this->GetSummedCost( lo[0], hi[1], lo[2] )
+        + this->GetSummedCost( hi[0], lo[1], lo[2] )
+        - this->GetSummedCost( lo[0], lo[1], lo[2] ) );
+}
+
 //------------------------------------------------------------------------------
 void vtkExtentRCBPartitioner::ExtendGhostLayers( int ext[6] )
 {
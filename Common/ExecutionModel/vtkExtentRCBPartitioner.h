@@ -17,6 +17,11 @@
 // .SECTION Description
 //  This method partitions a global extent to N partitions where N is a user
 //  supplied parameter.
+//
+//  By default the extent is bisected into partitions with about the same
+//  number of nodes. When the cost of processing the cells varies across
+//  the extent, a per-cell cost field, or a coarser cost grid, can be given
+//  instead; the bisections then balance the total cost of the partitions.
 
 #ifndef vtkExtentRCBPartitioner_h
 #define vtkExtentRCBPartitioner_h
@@ -27,6 +32,8 @@
 #include <cassert>  // For assert
 #include <string> // For std::string
 
+class vtkDataArray;
+
 class VTKCOMMONEXECUTIONMODEL_EXPORT vtkExtentRCBPartitioner : public vtkObject
 {
   public:
@@ -77,6 +84,21 @@ class VTKCOMMONEXECUTIONMODEL_EXPORT vtkExtentRCBPartitioner : public vtkObject
     // Returns the number of extents.
     vtkGetMacro(NumExtents,int);
 
+    // Description:
+    // Set the cost of a coarse grid of dims[0] x dims[1] x dims[2] blocks
+    // covering the cells of the global extent uniformly, i varying
+    // fastest. The cost of a block is spread evenly over the cells it
+    // covers. Collapsed directions of the global extent count as one cell.
+    // Partitions are then balanced by total cost rather than by number of
+    // nodes. Set NULL (the default) to balance the number of nodes.
+    void SetCosts(vtkDataArray *costs, const int dims[3]);
+
+    // Description:
+    // Set one cost per cell of the global extent, i varying fastest. This
+    // is SetCosts() with a block per cell.
+    void SetCellCosts(vtkDataArray *costs);
+    vtkGetObjectMacro(Costs,vtkDataArray);
+
     // Description:
     // Partitions the extent
     void Partition();
@@ -141,6 +163,26 @@ class VTKCOMMONEXECUTIONMODEL_EXPORT vtkExtentRCBPartitioner : public vtkObject
      // Splits the extent along the given dimension.
      void SplitExtent(int parent[6],int s1[6],int s2[6],int splitDimension);
 
+     // Description:
+     // Splits the extent along the given dimension so that both halves have
+     // about the same cost.
+     void SplitExtentByCost(
+         int parent[6],int s1[6],int s2[6],int splitDimension);
+
+     // Description:
+     // Builds the summed cost table from the costs. Returns false if there
+     // are no costs, or if they do not match their dimensions.
+     bool BuildCostTable();
+
+     // Description:
+     // Returns the total cost of the cells of the given extent.
+     double GetCost( int ext[6] );
+
+     // Description:
+     // Returns the summed cost table interpolated at the given position, in
+     // cost block coordinates.
+     double GetSummedCost( double x, double y, double z );
+
      // Description:
      // Returns the total number of extents. It's always the 2^N where
      // N is the number of subdivisions.
@@ -179,8 +221,16 @@ class VTKCOMMONEXECUTIONMODEL_EXPORT vtkExtentRCBPartitioner : public vtkObject
 
      bool ExtentIsPartitioned;
 
+     vtkDataArray *Costs;
+     int CostDimensions[3]; // -1 for one cost per cell
+
      // BTX
      std::vector<int> PartitionExtents;
+
+     // Sum of the costs of the blocks below each corner of the cost grid,
+     // of size (CostTableDimensions+1) along each direction.
+     std::vector<double> CostTable;
+     int CostTableDimensions[3];
      // ETX
 
   private:
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkImageInPlaceFilter.h"
 
+#include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -73,8 +74,29 @@ int vtkImageInPlaceFilter::RequestData(
   else
     {
     output->SetExtent(outExt);
-    output->AllocateScalars(outInfo);
-    this->CopyData(input,output,outExt);
+    int *dataExt = input->GetExtent();
+    vtkDataArray *inScalars = input->GetPointData()->GetScalars();
+    if (inScalars &&
+        dataExt[0] == outExt[0] && dataExt[1] == outExt[1] &&
+        dataExt[2] == outExt[2] && dataExt[3] == outExt[3] &&
+        dataExt[4] == outExt[4] && dataExt[5] == outExt[5] &&
+        inScalars->GetDataType() == vtkImageData::GetScalarType(outInfo) &&
+        inScalars->GetNumberOfComponents() ==
+        vtkImageData::GetNumberOfScalarComponents(outInfo))
+      {
+      // Share the input scalars, they are copied only when the filter
+      // modifies them.
+      vtkDataArray *outScalars = inScalars->NewInstance();
+      outScalars->ShallowCopy(inScalars);
+      outScalars->SetName(inScalars->GetName());
+      output->GetPointData()->SetScalars(outScalars);
+      outScalars->Delete();
+      }
+    else
+      {
+      output->AllocateScalars(outInfo);
+      this->CopyData(input,output,outExt);
+      }
     }
 
   return 1;
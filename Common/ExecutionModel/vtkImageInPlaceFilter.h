@@ -17,7 +17,9 @@
 // vtkImageInPlaceFilter is a filter super class that
 // operates directly on the input region.  The data is copied
 // if the requested region has different extent than the input region
-// or some other object is referencing the input region.
+// or some other object is referencing the input region. In the latter
+// case the scalars are shared copy-on-write (see
+// vtkDataArray::ShallowCopy()), and copied only when actually modified.
 
 
 #ifndef vtkImageInPlaceFilter_h
@@ -21,6 +21,10 @@
 // algorithm implement all pipeline passes in a re-entrant way. It should
 // store/retrieve all state changes using input and output information
 // objects, which are unique to each thread.
+//
+// Unlike vtkCompositeDataPipeline with EnableSMP on, it executes the blocks
+// concurrently whether or not the algorithm declares
+// CAN_EXECUTE_BLOCKS_CONCURRENTLY().
 
 #ifndef vtkThreadedCompositeDataPipeline_h
 #define vtkThreadedCompositeDataPipeline_h
@@ -48,18 +52,11 @@ class VTKCOMMONEXECUTIONMODEL_EXPORT vtkThreadedCompositeDataPipeline : public v
  protected:
   vtkThreadedCompositeDataPipeline();
   ~vtkThreadedCompositeDataPipeline();
-  virtual void ExecuteEach(vtkCompositeDataIterator* iter,
-                           vtkInformationVector** inInfoVec,
-                           vtkInformationVector* outInfoVec,
-                           int compositePort,
-                           int connection,
-                           vtkInformation* request,
-                           vtkCompositeDataSet* compositeOutput);
+  virtual bool CanExecuteBlocksConcurrently();
 
  private:
   vtkThreadedCompositeDataPipeline(const vtkThreadedCompositeDataPipeline&);  // Not implemented.
   void operator=(const vtkThreadedCompositeDataPipeline&);  // Not implemented.
-  friend class ProcessBlock;
 };
 
 #endif
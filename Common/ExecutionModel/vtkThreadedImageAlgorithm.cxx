@@ -23,14 +23,26 @@
 #include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+
+// Initial value of EnableSMP
+static bool vtkThreadedImageAlgorithmGlobalDefaultEnableSMP = false;
 
 //----------------------------------------------------------------------------
 vtkThreadedImageAlgorithm::vtkThreadedImageAlgorithm()
 {
   this->Threader = vtkMultiThreader::New();
   this->NumberOfThreads = this->Threader->GetNumberOfThreads();
+
+  this->EnableSMP = vtkThreadedImageAlgorithmGlobalDefaultEnableSMP;
+  this->DesiredBytesPerPiece = 65536;
+  this->MinimumPieceSize[0] = 16;
+  this->MinimumPieceSize[1] = 1;
+  this->MinimumPieceSize[2] = 1;
+  this->SplitMode = SLAB;
 }
 
 //----------------------------------------------------------------------------
@@ -45,6 +57,28 @@ void vtkThreadedImageAlgorithm::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On\n" : "Off\n");
+  os << indent << "DesiredBytesPerPiece: "
+     << this->DesiredBytesPerPiece << "\n";
+  os << indent << "MinimumPieceSize: ("
+     << this->MinimumPieceSize[0] << ", "
+     << this->MinimumPieceSize[1] << ", "
+     << this->MinimumPieceSize[2] << ")\n";
+  os << indent << "SplitMode: "
+     << (this->SplitMode == SLAB ? "Slab\n" :
+         (this->SplitMode == BEAM ? "Beam\n" : "Block\n"));
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadedImageAlgorithm::SetGlobalDefaultEnableSMP(bool enable)
+{
+  vtkThreadedImageAlgorithmGlobalDefaultEnableSMP = enable;
+}
+
+//----------------------------------------------------------------------------
+bool vtkThreadedImageAlgorithm::GetGlobalDefaultEnableSMP()
+{
+  return vtkThreadedImageAlgorithmGlobalDefaultEnableSMP;
 }
 
 struct vtkImageThreadStruct
@@ -79,6 +113,12 @@ int vtkThreadedImageAlgorithm::SplitExtent(int splitExt[6],
   // start with same extent
   memcpy(splitExt, startExt, 6 * sizeof(int));
 
+  if (this->SplitMode == BEAM || this->SplitMode == BLOCK)
+    {
+    return this->SplitExtentIntoBlocks(splitExt, startExt, num, total,
+                                       this->SplitMode == BEAM ? 2 : 3);
+    }
+
   splitAxis = 2;
   min = startExt[4];
   max = startExt[5];
@@ -120,23 +160,89 @@ int vtkThreadedImageAlgorithm::SplitExtent(int splitExt[6],
   return maxThreadIdUsed + 1;
 }
 
-
-// this mess is really a simple function. All it does is call
-// the ThreadedExecute method after setting the correct
-// extent for this thread. Its just a pain to calculate
-// the correct extent.
-static VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
+//----------------------------------------------------------------------------
+// Split the last numberOfAxes axes that are not flat into a grid of at most
+// total pieces.
+// The axis with the largest pieces is divided further until no axis can be
+// divided without exceeding total pieces or going below MinimumPieceSize.
+int vtkThreadedImageAlgorithm::SplitExtentIntoBlocks(int splitExt[6],
+                                                     int startExt[6],
+                                                     int num, int total,
+                                                     int numberOfAxes)
 {
-  vtkImageThreadStruct *str;
-  int ext[6], splitExt[6], total;
-  int threadId, threadCount;
+  int size[3];
+  int divisions[3] = { 1, 1, 1 };
+  int maxDivisions[3] = { 1, 1, 1 };
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    size[axis] = startExt[2*axis+1] - startExt[2*axis] + 1;
+    if (size[axis] <= 0)
+      {
+      // empty extent so cannot split
+      return 1;
+      }
+    }
+  for (int axis = 2; axis >= 0 && numberOfAxes > 0; --axis)
+    {
+    if (size[axis] > 1)
+      {
+      int minSize = std::max(this->MinimumPieceSize[axis], 1);
+      maxDivisions[axis] = std::max(size[axis] / minSize, 1);
+      --numberOfAxes;
+      }
+    }
 
-  threadId = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->ThreadID;
-  threadCount = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->NumberOfThreads;
+  vtkIdType numPieces = 1;
+  for (;;)
+    {
+    int bestAxis = -1;
+    double bestSize = 0.0;
+    for (int axis = 2; axis >= 0; --axis)
+      {
+      double pieceSize = static_cast<double>(size[axis]) / divisions[axis];
+      if (divisions[axis] < maxDivisions[axis] && pieceSize > bestSize &&
+          numPieces / divisions[axis] * (divisions[axis] + 1) <= total)
+        {
+        bestAxis = axis;
+        bestSize = pieceSize;
+        }
+      }
+    if (bestAxis < 0)
+      {
+      break;
+      }
+    numPieces = numPieces / divisions[bestAxis] * (divisions[bestAxis] + 1);
+    ++divisions[bestAxis];
+    }
 
-  str = static_cast<vtkImageThreadStruct *>
-    (static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
+  // pieces are numbered with X varying fastest
+  if (num < numPieces)
+    {
+    int index = num;
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      vtkIdType i = index % divisions[axis];
+      index /= divisions[axis];
+      splitExt[2*axis] = startExt[2*axis] +
+        static_cast<int>(size[axis] * i / divisions[axis]);
+      splitExt[2*axis+1] = startExt[2*axis] +
+        static_cast<int>(size[axis] * (i + 1) / divisions[axis]) - 1;
+      }
+    }
+
+  vtkDebugMacro("  Split Piece: ( " <<splitExt[0]<< ", " <<splitExt[1]<< ", "
+                << splitExt[2] << ", " << splitExt[3] << ", "
+                << splitExt[4] << ", " << splitExt[5] << ")");
+
+  return static_cast<int>(numPieces);
+}
 
+//----------------------------------------------------------------------------
+// Get the extent the filter executes on: the update extent of the output
+// the request comes from or, without output, of the first input.
+static bool vtkThreadedImageAlgorithmGetExtent(vtkImageThreadStruct *str,
+                                               int ext[6])
+{
   // if we have an output
   if (str->Filter->GetNumberOfOutputPorts())
     {
@@ -148,41 +254,51 @@ static VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *ar
     // update directly, for now an error
     if (outputPort == -1)
       {
-      return VTK_THREAD_RETURN_VALUE;
+      return false;
       }
 
     // get the update extent from the output port
     vtkInformation *outInfo =
       str->OutputsInfo->GetInformationObject(outputPort);
-    int updateExtent[6];
-    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
-                 updateExtent);
-    memcpy(ext,updateExtent, sizeof(int)*6);
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), ext);
+    return true;
     }
-  else
+
+  // if there is no output, then use UE from input, use the first input
+  for (int inPort = 0; inPort < str->Filter->GetNumberOfInputPorts(); ++inPort)
     {
-    // if there is no output, then use UE from input, use the first input
-    int inPort;
-    bool found = false;
-    for (inPort = 0; inPort < str->Filter->GetNumberOfInputPorts(); ++inPort)
-      {
-      if (str->Filter->GetNumberOfInputConnections(inPort))
-        {
-        int updateExtent[6];
-        str->InputsInfo[inPort]
-          ->GetInformationObject(0)
-          ->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
-                updateExtent);
-        memcpy(ext,updateExtent, sizeof(int)*6);
-        found = true;
-        break;
-        }
-      }
-    if (!found)
+    if (str->Filter->GetNumberOfInputConnections(inPort))
       {
-      return VTK_THREAD_RETURN_VALUE;
+      str->InputsInfo[inPort]
+        ->GetInformationObject(0)
+        ->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), ext);
+      return true;
       }
     }
+  return false;
+}
+
+
+// this mess is really a simple function. All it does is call
+// the ThreadedExecute method after setting the correct
+// extent for this thread. Its just a pain to calculate
+// the correct extent.
+static VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
+{
+  vtkImageThreadStruct *str;
+  int ext[6], splitExt[6], total;
+  int threadId, threadCount;
+
+  threadId = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->ThreadID;
+  threadCount = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->NumberOfThreads;
+
+  str = static_cast<vtkImageThreadStruct *>
+    (static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
+
+  if (!vtkThreadedImageAlgorithmGetExtent(str, ext))
+    {
+    return VTK_THREAD_RETURN_VALUE;
+    }
 
   // execute the actual method with appropriate extent
   // first find out how many pieces extent can be split into.
@@ -213,6 +329,103 @@ static VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *ar
 }
 
 
+//----------------------------------------------------------------------------
+// Executes a range of pieces for vtkSMPTools::For.
+class vtkThreadedImageAlgorithmFunctor
+{
+public:
+  vtkThreadedImageAlgorithmFunctor(vtkImageThreadStruct *str,
+                                   const int extent[6], vtkIdType pieces)
+    : Str(str), Pieces(pieces)
+  {
+    memcpy(this->Extent, extent, 6 * sizeof(int));
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    this->Str->Filter->SMPRequestData(this->Str->Request,
+                                      this->Str->InputsInfo,
+                                      this->Str->OutputsInfo,
+                                      this->Str->Inputs, this->Str->Outputs,
+                                      begin, end, this->Pieces, this->Extent);
+  }
+
+private:
+  vtkImageThreadStruct *Str;
+  int Extent[6];
+  vtkIdType Pieces;
+};
+
+//----------------------------------------------------------------------------
+// Number of pieces of DesiredBytesPerPiece bytes of scalars in the extent,
+// as split by SplitExtent.
+vtkIdType vtkThreadedImageAlgorithm::GetNumberOfSMPPieces(
+  vtkImageData ***inData, vtkImageData **outData, int extent[6])
+{
+  vtkIdType numberOfPoints = 1;
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    numberOfPoints *= std::max(extent[2*axis+1] - extent[2*axis] + 1, 0);
+    }
+  if (numberOfPoints == 0)
+    {
+    return 0;
+    }
+
+  vtkImageData *image = NULL;
+  if (outData && outData[0])
+    {
+    image = outData[0];
+    }
+  else if (inData && inData[0] && inData[0][0])
+    {
+    image = inData[0][0];
+    }
+  vtkIdType bytesPerPoint = 1;
+  if (image)
+    {
+    bytesPerPoint = std::max(
+      image->GetScalarSize() * image->GetNumberOfScalarComponents(), 1);
+    }
+
+  vtkIdType pieces = numberOfPoints * bytesPerPoint /
+    this->DesiredBytesPerPiece;
+  pieces = std::min(std::max(pieces, static_cast<vtkIdType>(1)),
+                    static_cast<vtkIdType>(VTK_INT_MAX));
+
+  int splitExt[6];
+  return this->SplitExtent(splitExt, extent, 0, static_cast<int>(pieces));
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadedImageAlgorithm::SMPRequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector,
+  vtkImageData ***inData,
+  vtkImageData **outData,
+  vtkIdType begin, vtkIdType end,
+  vtkIdType pieces, int extent[6])
+{
+  for (vtkIdType piece = begin; piece < end; ++piece)
+    {
+    int splitExt[6] = { 0, -1, 0, -1, 0, -1 };
+    int total = this->SplitExtent(splitExt, extent, static_cast<int>(piece),
+                                  static_cast<int>(pieces));
+
+    // skip pieces the extent could not be split into and empty pieces
+    if (piece < total &&
+        splitExt[1] >= splitExt[0] &&
+        splitExt[3] >= splitExt[2] &&
+        splitExt[5] >= splitExt[4])
+      {
+      this->ThreadedRequestData(request, inputVector, outputVector,
+                                inData, outData, splitExt,
+                                static_cast<int>(piece));
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 // This is the superclasses style of Execute method.  Convert it into
 // an imaging style Execute method.
@@ -285,13 +498,32 @@ int vtkThreadedImageAlgorithm::RequestData(
     this->CopyAttributeData(str.Inputs[0][0],str.Outputs[0],inputVector);
     }
 
-  this->Threader->SetNumberOfThreads(this->NumberOfThreads);
-  this->Threader->SetSingleMethod(vtkThreadedImageAlgorithmThreadedExecute, &str);
-
   // always shut off debugging to avoid threading problems with GetMacros
   bool debug = this->Debug;
   this->Debug = false;
-  this->Threader->SingleMethodExecute();
+
+  if (this->EnableSMP)
+    {
+    int extent[6];
+    vtkIdType pieces = 0;
+    if (vtkThreadedImageAlgorithmGetExtent(&str, extent))
+      {
+      pieces = this->GetNumberOfSMPPieces(str.Inputs, str.Outputs, extent);
+      }
+    if (pieces > 0)
+      {
+      vtkThreadedImageAlgorithmFunctor functor(&str, extent, pieces);
+      vtkSMPTools::For(0, pieces, functor);
+      }
+    }
+  else
+    {
+    this->Threader->SetNumberOfThreads(this->NumberOfThreads);
+    this->Threader->SetSingleMethod(vtkThreadedImageAlgorithmThreadedExecute,
+                                    &str);
+    this->Threader->SingleMethodExecute();
+    }
+
   this->Debug = debug;
 
   // free up the arrays
@@ -19,6 +19,12 @@
 // into smaller extents so that the vtkImageData limits are observed. It
 // also provides support for multithreading. If you don't need any of this
 // functionality, consider using vtkSimpleImageToImageAlgorithm instead.
+//
+// By default, the output extent is split into one piece per thread and the
+// pieces are executed with vtkMultiThreader. When EnableSMP is on, the
+// extent is instead split into many small pieces (see DesiredBytesPerPiece
+// and SplitMode) that are scheduled with vtkSMPTools, which balances the
+// load dynamically and uses the SMP back-end VTK was configured with.
 // .SECTION See also
 // vtkSimpleImageToImageAlgorithm
 
@@ -41,7 +47,9 @@ public:
   // If the subclass does not define an Execute method, then the task
   // will be broken up, multiple threads will be spawned, and each thread
   // will call this method. It is public so that the thread functions
-  // can call this method.
+  // can call this method. When EnableSMP is on, threadId is the index of
+  // the piece, which can be larger than NumberOfThreads, and several
+  // pieces can be executed by the same thread.
   virtual void ThreadedRequestData(vtkInformation *request,
                                    vtkInformationVector **inputVector,
                                    vtkInformationVector *outputVector,
@@ -59,6 +67,51 @@ public:
   vtkSetClampMacro( NumberOfThreads, int, 1, VTK_MAX_THREADS );
   vtkGetMacro( NumberOfThreads, int );
 
+  // Description:
+  // Enable/Disable the execution of the pieces with vtkSMPTools instead of
+  // vtkMultiThreader. The default is given by GlobalDefaultEnableSMP.
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+
+  // Description:
+  // Set the value EnableSMP is initialized with in the filters created
+  // afterwards. The default is false.
+  static void SetGlobalDefaultEnableSMP(bool enable);
+  static bool GetGlobalDefaultEnableSMP();
+
+  // Description:
+  // The size, in bytes of output scalars, of the pieces the extent is split
+  // into when EnableSMP is on. Smaller pieces balance the load better but
+  // add overhead. The default is 65536 bytes.
+  vtkSetClampMacro(DesiredBytesPerPiece, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(DesiredBytesPerPiece, vtkIdType);
+
+  // Description:
+  // The minimum size along each axis of the pieces created by the Beam and
+  // Block split modes. The default is (16, 1, 1), so that rows are not
+  // split into pieces smaller than a few cache lines.
+  vtkSetVector3Macro(MinimumPieceSize, int);
+  vtkGetVector3Macro(MinimumPieceSize, int);
+
+  // Description:
+  // Set how SplitExtent() splits the extent. Slab mode, the default,
+  // splits along the last axis that can be split. Beam mode splits evenly
+  // along the last two axes that can be split (Z and Y for a volume), and
+  // Block mode along all three axes. Beam and Block modes create compact
+  // pieces when EnableSMP is on and many pieces are needed.
+  enum SplitModeEnum
+  {
+    SLAB = 0,
+    BEAM = 1,
+    BLOCK = 2
+  };
+  vtkSetClampMacro(SplitMode, int, SLAB, BLOCK);
+  void SetSplitModeToSlab() { this->SetSplitMode(SLAB); }
+  void SetSplitModeToBeam() { this->SetSplitMode(BEAM); }
+  void SetSplitModeToBlock() { this->SetSplitMode(BLOCK); }
+  vtkGetMacro(SplitMode, int);
+
   // Description:
   // Putting this here until I merge graphics and imaging streaming.
   virtual int SplitExtent(int splitExt[6], int startExt[6],
@@ -71,6 +124,31 @@ protected:
   vtkMultiThreader *Threader;
   int NumberOfThreads;
 
+  bool EnableSMP;
+  vtkIdType DesiredBytesPerPiece;
+  int MinimumPieceSize[3];
+  int SplitMode;
+
+  // Description:
+  // Execute ThreadedRequestData for the pieces [begin, end) of the
+  // extent split into the given number of pieces. Called by the
+  // vtkSMPTools functor when EnableSMP is on.
+  virtual void SMPRequestData(vtkInformation *request,
+                              vtkInformationVector **inputVector,
+                              vtkInformationVector *outputVector,
+                              vtkImageData ***inData,
+                              vtkImageData **outData,
+                              vtkIdType begin, vtkIdType end,
+                              vtkIdType pieces, int extent[6]);
+
+  // Description:
+  // Return the number of pieces SMPRequestData splits the extent into,
+  // from DesiredBytesPerPiece and the scalar size of the first output or,
+  // without output, of the first input.
+  virtual vtkIdType GetNumberOfSMPPieces(vtkImageData ***inData,
+                                         vtkImageData **outData,
+                                         int extent[6]);
+
   // Description:
   // This is called by the superclass.
   // This is the method you should override.
@@ -79,6 +157,12 @@ protected:
                           vtkInformationVector* outputVector);
 
 private:
+  // Split in Beam and Block modes.
+  int SplitExtentIntoBlocks(int splitExt[6], int startExt[6], int num,
+                            int total, int numberOfAxes);
+
+  friend class vtkThreadedImageAlgorithmFunctor;
+
   vtkThreadedImageAlgorithm(const vtkThreadedImageAlgorithm&);  // Not implemented.
   void operator=(const vtkThreadedImageAlgorithm&);  // Not implemented.
 };
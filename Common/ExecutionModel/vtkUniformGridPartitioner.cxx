@@ -16,6 +16,7 @@
 #include "vtkUniformGridPartitioner.h"
 #include "vtkObjectFactory.h"
 #include "vtkIndent.h"
+#include "vtkCellData.h"
 #include "vtkExtentRCBPartitioner.h"
 #include "vtkUniformGrid.h"
 #include "vtkMultiBlockDataSet.h"
@@ -35,12 +36,13 @@ vtkUniformGridPartitioner::vtkUniformGridPartitioner()
   this->NumberOfPartitions  = 2;
   this->NumberOfGhostLayers = 0;
   this->DuplicateNodes      = 1;
+  this->CostArrayName       = NULL;
 }
 
 //------------------------------------------------------------------------------
 vtkUniformGridPartitioner::~vtkUniformGridPartitioner()
 {
-
+  this->SetCostArrayName( NULL );
 }
 
 //------------------------------------------------------------------------------
@@ -50,6 +52,8 @@ void vtkUniformGridPartitioner::PrintSelf(std::ostream &oss, vtkIndent indent)
   oss << "NumberOfPartitions: " << this->NumberOfPartitions << std::endl;
   oss << "NumberOfGhostLayers: " << this->NumberOfGhostLayers << std::endl;
   oss << "DuplicateNodes: " << this->DuplicateNodes << std::endl;
+  oss << "CostArrayName: "
+      << (this->CostArrayName ? this->CostArrayName : "(none)") << std::endl;
 }
 
 //------------------------------------------------------------------------------
@@ -110,6 +114,13 @@ int vtkUniformGridPartitioner::RequestData(
     extentPartitioner->DuplicateNodesOff();
     }
 
+  // Balance the partitions by the cost of the cells when available.
+  if( this->CostArrayName != NULL )
+    {
+    extentPartitioner->SetCellCosts(
+        grd->GetCellData()->GetArray( this->CostArrayName ) );
+    }
+
   // STEP 4: Partition
   extentPartitioner->Partition();
 
@@ -56,6 +56,13 @@ class VTKCOMMONEXECUTIONMODEL_EXPORT vtkUniformGridPartitioner :
       vtkSetMacro(DuplicateNodes,int);
       vtkBooleanMacro(DuplicateNodes,int);
 
+      // Description:
+      // Set/Get the name of a cell data array holding the cost of processing
+      // each cell. When set, the partitions are balanced by total cost instead
+      // of by number of nodes. Default is NULL.
+      vtkSetStringMacro(CostArrayName);
+      vtkGetStringMacro(CostArrayName);
+
   protected:
     vtkUniformGridPartitioner();
     virtual ~vtkUniformGridPartitioner();
@@ -69,6 +76,7 @@ class VTKCOMMONEXECUTIONMODEL_EXPORT vtkUniformGridPartitioner :
     int NumberOfPartitions;
     int NumberOfGhostLayers;
     int DuplicateNodes;
+    char *CostArrayName;
   private:
     vtkUniformGridPartitioner(const vtkUniformGridPartitioner &); // Not implemented
     void operator=(const vtkUniformGridPartitioner &); // Not implemented
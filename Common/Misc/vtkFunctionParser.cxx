@@ -15,7 +15,9 @@
 #include "vtkFunctionParser.h"
 #include "vtkObjectFactory.h"
 
+#include <algorithm>
 #include <cctype>
+#include <vector>
 
 vtkStandardNewMacro(vtkFunctionParser);
 
@@ -902,6 +904,526 @@ bool vtkFunctionParser::Evaluate()
   return true;
 }
 
+//-----------------------------------------------------------------------------
+// Apply f to the n values of a block of the stack.
+static void vtkFunctionParserApply(double *a, int n, double (*f)(double))
+{
+  for (int i = 0; i < n; i++)
+    {
+    a[i] = f(a[i]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Apply f to the n values of a block of the stack that are in its domain.
+// The other values are replaced, or flagged as invalid if replacement is
+// off.
+static void vtkFunctionParserApplyChecked(double *a, int n,
+                                          double (*f)(double),
+                                          bool (*inDomain)(double),
+                                          int replace, double replacement,
+                                          unsigned char *invalid)
+{
+  for (int i = 0; i < n; i++)
+    {
+    if (!inDomain(a[i]))
+      {
+      if (replace)
+        {
+        a[i] = replacement;
+        }
+      else
+        {
+        invalid[i] = 1;
+        }
+      }
+    else
+      {
+      a[i] = f(a[i]);
+      }
+    }
+}
+
+// The domains checked by Evaluate().
+static bool vtkFunctionParserIsPositive(double x) { return !(x <= 0); }
+static bool vtkFunctionParserIsNonNegative(double x) { return !(x < 0); }
+static bool vtkFunctionParserIsInUnitRange(double x)
+{
+  return !(x < -1 || x > 1);
+}
+
+//-----------------------------------------------------------------------------
+static double vtkFunctionParserLog(double x) { return log(x); }
+static double vtkFunctionParserLog10(double x) { return log10(x); }
+static double vtkFunctionParserSqrt(double x) { return sqrt(x); }
+static double vtkFunctionParserAsin(double x) { return asin(x); }
+static double vtkFunctionParserAcos(double x) { return acos(x); }
+static double vtkFunctionParserFabs(double x) { return fabs(x); }
+static double vtkFunctionParserExp(double x) { return exp(x); }
+static double vtkFunctionParserCeil(double x) { return ceil(x); }
+static double vtkFunctionParserFloor(double x) { return floor(x); }
+static double vtkFunctionParserSin(double x) { return sin(x); }
+static double vtkFunctionParserCos(double x) { return cos(x); }
+static double vtkFunctionParserTan(double x) { return tan(x); }
+static double vtkFunctionParserAtan(double x) { return atan(x); }
+static double vtkFunctionParserSinh(double x) { return sinh(x); }
+static double vtkFunctionParserCosh(double x) { return cosh(x); }
+static double vtkFunctionParserTanh(double x) { return tanh(x); }
+
+//-----------------------------------------------------------------------------
+// The byte code is run once per block instead of once per value: each
+// entry of the stack holds the numValues values of the block, and each
+// operation is a loop over them. The operations and their order are those
+// of Evaluate(), so the results are the same.
+int vtkFunctionParser::EvaluateBlock(int numValues,
+                                     const double *const *scalarValues,
+                                     const double *const *vectorValues,
+                                     double *result)
+{
+  if (this->FunctionMTime.GetMTime() > this->ParseMTime.GetMTime())
+    {
+    if (this->Parse() == 0)
+      {
+      return -1;
+      }
+    }
+  if (numValues < 1 || this->StackSize < 1)
+    {
+    return 0;
+    }
+
+  const int n = numValues;
+  std::vector<double> stackBlocks(static_cast<size_t>(this->StackSize) * n);
+  std::vector<unsigned char> invalid(n, 0);
+  double *stack = &stackBlocks[0];
+  int stackPosition = -1;
+  int numImmediatesProcessed = 0;
+  int i;
+
+  // The block of the stack entry k.
+#define VTK_BLOCK(k) (stack + (k) * n)
+
+  for (int numBytesProcessed = 0; numBytesProcessed < this->ByteCodeSize;
+       numBytesProcessed++)
+    {
+    // The top of the stack and the entry below, when there are.
+    double *a = VTK_BLOCK(stackPosition > 0 ? stackPosition : 0);
+    double *b = VTK_BLOCK(stackPosition > 0 ? stackPosition - 1 : 0);
+    switch (this->ByteCode[numBytesProcessed])
+      {
+      case VTK_PARSER_IMMEDIATE:
+        {
+        double value = this->Immediates[numImmediatesProcessed++];
+        a = VTK_BLOCK(++stackPosition);
+        for (i = 0; i < n; i++)
+          {
+          a[i] = value;
+          }
+        break;
+        }
+      case VTK_PARSER_UNARY_MINUS:
+        for (i = 0; i < n; i++)
+          {
+          a[i] = -a[i];
+          }
+        break;
+      case VTK_PARSER_UNARY_PLUS:
+        break;
+      case VTK_PARSER_ADD:
+        for (i = 0; i < n; i++)
+          {
+          b[i] += a[i];
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_SUBTRACT:
+        for (i = 0; i < n; i++)
+          {
+          b[i] -= a[i];
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_MULTIPLY:
+        for (i = 0; i < n; i++)
+          {
+          b[i] *= a[i];
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_DIVIDE:
+        for (i = 0; i < n; i++)
+          {
+          if (a[i] == 0)
+            {
+            if (this->ReplaceInvalidValues)
+              {
+              b[i] = this->ReplacementValue;
+              }
+            else
+              {
+              invalid[i] = 1;
+              }
+            }
+          else
+            {
+            b[i] /= a[i];
+            }
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_POWER:
+        for (i = 0; i < n; i++)
+          {
+          b[i] = pow(b[i], a[i]);
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_ABSOLUTE_VALUE:
+        vtkFunctionParserApply(a, n, vtkFunctionParserFabs);
+        break;
+      case VTK_PARSER_EXPONENT:
+        vtkFunctionParserApply(a, n, vtkFunctionParserExp);
+        break;
+      case VTK_PARSER_CEILING:
+        vtkFunctionParserApply(a, n, vtkFunctionParserCeil);
+        break;
+      case VTK_PARSER_FLOOR:
+        vtkFunctionParserApply(a, n, vtkFunctionParserFloor);
+        break;
+      case VTK_PARSER_LOGARITHM:
+      case VTK_PARSER_LOGARITHME:
+        vtkFunctionParserApplyChecked(a, n, vtkFunctionParserLog,
+                                      vtkFunctionParserIsPositive,
+                                      this->ReplaceInvalidValues,
+                                      this->ReplacementValue, &invalid[0]);
+        break;
+      case VTK_PARSER_LOGARITHM10:
+        vtkFunctionParserApplyChecked(a, n, vtkFunctionParserLog10,
+                                      vtkFunctionParserIsPositive,
+                                      this->ReplaceInvalidValues,
+                                      this->ReplacementValue, &invalid[0]);
+        break;
+      case VTK_PARSER_SQUARE_ROOT:
+        vtkFunctionParserApplyChecked(a, n, vtkFunctionParserSqrt,
+                                      vtkFunctionParserIsNonNegative,
+                                      this->ReplaceInvalidValues,
+                                      this->ReplacementValue, &invalid[0]);
+        break;
+      case VTK_PARSER_SINE:
+        vtkFunctionParserApply(a, n, vtkFunctionParserSin);
+        break;
+      case VTK_PARSER_COSINE:
+        vtkFunctionParserApply(a, n, vtkFunctionParserCos);
+        break;
+      case VTK_PARSER_TANGENT:
+        vtkFunctionParserApply(a, n, vtkFunctionParserTan);
+        break;
+      case VTK_PARSER_ARCSINE:
+        vtkFunctionParserApplyChecked(a, n, vtkFunctionParserAsin,
+                                      vtkFunctionParserIsInUnitRange,
+                                      this->ReplaceInvalidValues,
+                                      this->ReplacementValue, &invalid[0]);
+        break;
+      case VTK_PARSER_ARCCOSINE:
+        vtkFunctionParserApplyChecked(a, n, vtkFunctionParserAcos,
+                                      vtkFunctionParserIsInUnitRange,
+                                      this->ReplaceInvalidValues,
+                                      this->ReplacementValue, &invalid[0]);
+        break;
+      case VTK_PARSER_ARCTANGENT:
+        vtkFunctionParserApply(a, n, vtkFunctionParserAtan);
+        break;
+      case VTK_PARSER_HYPERBOLIC_SINE:
+        vtkFunctionParserApply(a, n, vtkFunctionParserSinh);
+        break;
+      case VTK_PARSER_HYPERBOLIC_COSINE:
+        vtkFunctionParserApply(a, n, vtkFunctionParserCosh);
+        break;
+      case VTK_PARSER_HYPERBOLIC_TANGENT:
+        vtkFunctionParserApply(a, n, vtkFunctionParserTanh);
+        break;
+      case VTK_PARSER_MIN:
+        for (i = 0; i < n; i++)
+          {
+          if (a[i] < b[i])
+            {
+            b[i] = a[i];
+            }
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_MAX:
+        for (i = 0; i < n; i++)
+          {
+          if (a[i] > b[i])
+            {
+            b[i] = a[i];
+            }
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_CROSS:
+        {
+        double *ux = VTK_BLOCK(stackPosition - 5);
+        double *uy = VTK_BLOCK(stackPosition - 4);
+        double *uz = VTK_BLOCK(stackPosition - 3);
+        const double *vx = VTK_BLOCK(stackPosition - 2);
+        const double *vy = VTK_BLOCK(stackPosition - 1);
+        const double *vz = VTK_BLOCK(stackPosition);
+        for (i = 0; i < n; i++)
+          {
+          double x = uy[i]*vz[i] - uz[i]*vy[i];
+          double y = uz[i]*vx[i] - ux[i]*vz[i];
+          double z = ux[i]*vy[i] - uy[i]*vx[i];
+          ux[i] = x;
+          uy[i] = y;
+          uz[i] = z;
+          }
+        stackPosition -= 3;
+        break;
+        }
+      case VTK_PARSER_SIGN:
+        for (i = 0; i < n; i++)
+          {
+          a[i] = (a[i] < 0 ? -1 : (a[i] == 0 ? 0 : 1));
+          }
+        break;
+      case VTK_PARSER_VECTOR_UNARY_MINUS:
+        for (i = 0; i < 3 * n; i++)
+          {
+          VTK_BLOCK(stackPosition - 2)[i] = -VTK_BLOCK(stackPosition - 2)[i];
+          }
+        break;
+      case VTK_PARSER_VECTOR_UNARY_PLUS:
+        break;
+      case VTK_PARSER_DOT_PRODUCT:
+        {
+        double *ux = VTK_BLOCK(stackPosition - 5);
+        const double *uy = VTK_BLOCK(stackPosition - 4);
+        const double *uz = VTK_BLOCK(stackPosition - 3);
+        const double *vx = VTK_BLOCK(stackPosition - 2);
+        const double *vy = VTK_BLOCK(stackPosition - 1);
+        const double *vz = VTK_BLOCK(stackPosition);
+        for (i = 0; i < n; i++)
+          {
+          double x = ux[i] * vx[i];
+          double y = uy[i] * vy[i];
+          double z = uz[i] * vz[i];
+          ux[i] = x + y + z;
+          }
+        stackPosition -= 5;
+        break;
+        }
+      case VTK_PARSER_VECTOR_ADD:
+        {
+        double *u = VTK_BLOCK(stackPosition - 5);
+        const double *v = VTK_BLOCK(stackPosition - 2);
+        for (i = 0; i < 3 * n; i++)
+          {
+          u[i] += v[i];
+          }
+        stackPosition -= 3;
+        break;
+        }
+      case VTK_PARSER_VECTOR_SUBTRACT:
+        {
+        double *u = VTK_BLOCK(stackPosition - 5);
+        const double *v = VTK_BLOCK(stackPosition - 2);
+        for (i = 0; i < 3 * n; i++)
+          {
+          u[i] -= v[i];
+          }
+        stackPosition -= 3;
+        break;
+        }
+      case VTK_PARSER_SCALAR_TIMES_VECTOR:
+        {
+        // The scalar is below the vector: shift the product down by one.
+        double *s = VTK_BLOCK(stackPosition - 3);
+        double *v = VTK_BLOCK(stackPosition - 2);
+        for (i = 0; i < n; i++)
+          {
+          double scale = s[i];
+          s[i] = v[i] * scale;
+          v[i] = v[i+n] * scale;
+          v[i+n] = v[i+2*n] * scale;
+          }
+        stackPosition--;
+        break;
+        }
+      case VTK_PARSER_VECTOR_TIMES_SCALAR:
+        {
+        double *v = VTK_BLOCK(stackPosition - 3);
+        for (i = 0; i < n; i++)
+          {
+          v[i] *= a[i];
+          v[i+n] *= a[i];
+          v[i+2*n] *= a[i];
+          }
+        stackPosition--;
+        break;
+        }
+      case VTK_PARSER_VECTOR_OVER_SCALAR:
+        {
+        double *v = VTK_BLOCK(stackPosition - 3);
+        for (i = 0; i < n; i++)
+          {
+          v[i] /= a[i];
+          v[i+n] /= a[i];
+          v[i+2*n] /= a[i];
+          }
+        stackPosition--;
+        break;
+        }
+      case VTK_PARSER_MAGNITUDE:
+        {
+        double *x = VTK_BLOCK(stackPosition - 2);
+        for (i = 0; i < n; i++)
+          {
+          x[i] = sqrt(pow(x[i+2*n], 2) + pow(x[i+n], 2) + pow(x[i], 2));
+          }
+        stackPosition -= 2;
+        break;
+        }
+      case VTK_PARSER_NORMALIZE:
+        {
+        double *x = VTK_BLOCK(stackPosition - 2);
+        for (i = 0; i < n; i++)
+          {
+          double magnitude =
+            sqrt(pow(x[i+2*n], 2) + pow(x[i+n], 2) + pow(x[i], 2));
+          if (magnitude != 0)
+            {
+            x[i] /= magnitude;
+            x[i+n] /= magnitude;
+            x[i+2*n] /= magnitude;
+            }
+          }
+        break;
+        }
+      case VTK_PARSER_IHAT:
+      case VTK_PARSER_JHAT:
+      case VTK_PARSER_KHAT:
+        {
+        int axis = this->ByteCode[numBytesProcessed] - VTK_PARSER_IHAT;
+        double *x = VTK_BLOCK(stackPosition + 1);
+        for (i = 0; i < 3 * n; i++)
+          {
+          x[i] = (i / n == axis ? 1 : 0);
+          }
+        stackPosition += 3;
+        break;
+        }
+      case VTK_PARSER_LESS_THAN:
+        for (i = 0; i < n; i++)
+          {
+          b[i] = (b[i] < a[i]);
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_GREATER_THAN:
+        for (i = 0; i < n; i++)
+          {
+          b[i] = (b[i] > a[i]);
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_EQUAL_TO:
+        for (i = 0; i < n; i++)
+          {
+          b[i] = (b[i] == a[i]);
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_AND:
+        for (i = 0; i < n; i++)
+          {
+          b[i] = (b[i] && a[i]);
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_OR:
+        for (i = 0; i < n; i++)
+          {
+          b[i] = (b[i] || a[i]);
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_IF:
+        {
+        // The condition is on top of the value if true, itself on top of
+        // the value if false where the result goes.
+        double *valFalse = VTK_BLOCK(stackPosition - 2);
+        for (i = 0; i < n; i++)
+          {
+          if (a[i] != 0.0)
+            {
+            valFalse[i] = b[i];
+            }
+          }
+        stackPosition -= 2;
+        break;
+        }
+      case VTK_PARSER_VECTOR_IF:
+        {
+        double *valFalse = VTK_BLOCK(stackPosition - 6);
+        const double *valTrue = VTK_BLOCK(stackPosition - 3);
+        for (i = 0; i < n; i++)
+          {
+          if (a[i] != 0.0)
+            {
+            valFalse[i] = valTrue[i];
+            valFalse[i+n] = valTrue[i+n];
+            valFalse[i+2*n] = valTrue[i+2*n];
+            }
+          }
+        stackPosition -= 4;
+        break;
+        }
+      default:
+        {
+        int variable =
+          this->ByteCode[numBytesProcessed] - VTK_PARSER_BEGIN_VARIABLES;
+        if (variable < this->NumberOfScalarVariables)
+          {
+          a = VTK_BLOCK(++stackPosition);
+          std::copy(scalarValues[variable], scalarValues[variable] + n, a);
+          }
+        else
+          {
+          int vectorNum = variable - this->NumberOfScalarVariables;
+          for (int j = 0; j < 3; j++)
+            {
+            a = VTK_BLOCK(++stackPosition);
+            std::copy(vectorValues[3*vectorNum+j],
+                      vectorValues[3*vectorNum+j] + n, a);
+            }
+          }
+        }
+      }
+    }
+#undef VTK_BLOCK
+
+  if (stackPosition != 0 && stackPosition != 2)
+    {
+    return -1;
+    }
+
+  // Write the results, one tuple after the other.
+  int numComponents = stackPosition + 1;
+  int numInvalid = 0;
+  for (i = 0; i < n; i++)
+    {
+    for (int j = 0; j < numComponents; j++)
+      {
+      result[numComponents*i+j] =
+        invalid[i] ? VTK_PARSER_ERROR_RESULT : stack[j*n+i];
+      }
+    numInvalid += invalid[i];
+    }
+  return numInvalid;
+}
+
 //-----------------------------------------------------------------------------
 int vtkFunctionParser::IsScalarResult()
 {
@@ -159,6 +159,23 @@ public:
     double *r = this->GetVectorResult();
     result[0] = r[0]; result[1] = r[1]; result[2] = r[2]; };
 
+  // Description:
+  // Evaluate the function for numValues sets of variable values at once,
+  // without changing the values of the variables. scalarValues[i] points
+  // to the numValues values of the i-th scalar variable, and
+  // vectorValues[3*i+j] to the numValues values of the j-th component of
+  // the i-th vector variable. The results are written to result one after
+  // the other, with 1 or 3 components depending on the result type. The
+  // values for which the function cannot be evaluated, such as sqrt(-2)
+  // when ReplaceInvalidValues is off, get VTK_PARSER_ERROR_RESULT. Return
+  // their number, or -1 if the function is not valid. Each operation of
+  // the function is applied to all the values in a loop, which is much
+  // faster than evaluating them one at a time. Once the function has been
+  // parsed, e.g. by IsScalarResult(), this may be called concurrently by
+  // several threads.
+  int EvaluateBlock(int numValues, const double *const *scalarValues,
+                    const double *const *vectorValues, double *result);
+
   // Description:
   // Set the value of a scalar variable.  If a variable with this name
   // exists, then its value will be set to the new value.  If there is not
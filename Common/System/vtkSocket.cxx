@@ -583,6 +583,45 @@ int vtkSocket::Send(const void* data, int length)
 #endif
 }
 
+//-----------------------------------------------------------------------------
+int vtkSocket::SetSendBufferSize(int size)
+{
+  return this->SetBufferSize(size, 1);
+}
+
+//-----------------------------------------------------------------------------
+int vtkSocket::SetReceiveBufferSize(int size)
+{
+  return this->SetBufferSize(size, 0);
+}
+
+//-----------------------------------------------------------------------------
+int vtkSocket::SetBufferSize(int size, int send)
+{
+#ifndef VTK_SOCKET_FAKE_API
+  if (!this->GetConnected())
+    {
+    vtkErrorMacro("Not connected.");
+    return 0;
+    }
+  int iErr;
+  vtkRestartInterruptedSystemCallMacro(
+    setsockopt(this->SocketDescriptor, SOL_SOCKET,
+      send ? SO_SNDBUF : SO_RCVBUF, (char*)&size, sizeof(size)),
+    iErr);
+  if (iErr == vtkSocketErrorReturnMacro)
+    {
+    vtkSocketErrorMacro(vtkErrnoMacro, "Socket error in call to setsockopt.");
+    return 0;
+    }
+  return 1;
+#else
+  static_cast<void>(size);
+  static_cast<void>(send);
+  return 0;
+#endif
+}
+
 //-----------------------------------------------------------------------------
 int vtkSocket::Receive(void* data, int length, int readFully/*=1*/)
 {
@@ -54,6 +54,14 @@ public:
   // vtkCommand::ErrorEvent is raised.
   int Receive(void* data, int length, int readFully=1);
 
+  // Description:
+  // Set the size of the kernel send/receive buffers of the socket
+  // (SO_SNDBUF/SO_RCVBUF). Larger buffers keep more data in flight on
+  // links with a high bandwidth-delay product. The socket must be
+  // connected. Returns 1 on success, 0 on error.
+  int SetSendBufferSize(int size);
+  int SetReceiveBufferSize(int size);
+
   // Description:
   // Provides access to  the internal socket descriptor. This is valid only when
   // GetConnected() returns true.
@@ -108,6 +116,11 @@ protected:
   // Connect to a server socket. Returns 0 on success, -1 on error.
   int Connect(int socketdescriptor, const char* hostname, int port);
 
+  // Description:
+  // Sets SO_SNDBUF when send is non-zero, SO_RCVBUF otherwise.
+  // Returns 1 on success, 0 on error.
+  int SetBufferSize(int size, int send);
+
   // Description:
   // Returns the port to which the socket is connected.
   // 0 on error.
@@ -14,6 +14,7 @@
 
 #include "vtkMolecule.h"
 #include "vtkNew.h"
+#include "vtkUnsignedShortArray.h"
 #include "vtkVector.h"
 #include "vtkVectorOperators.h"
 
@@ -122,11 +123,59 @@ bool MoleculeExampleCode2()
   return errors == 0;
 }
 
+// Moving atoms must leave the topology time as is, while changing the
+// elements or the bonds must update it.
+bool MoleculeTopologyMTime()
+{
+  vtkNew<vtkMolecule> mol;
+  vtkAtom h1 = mol->AppendAtom(1, 0.0, 0.0, -0.5);
+  vtkAtom h2 = mol->AppendAtom(1, 0.0, 0.0,  0.5);
+  vtkBond b  = mol->AppendBond(h1, h2, 1);
+  int errors(0);
+
+  unsigned long topologyTime = mol->GetTopologyMTime();
+  h1.SetPosition(0.0, 0.0, -0.6);
+  if (mol->GetTopologyMTime() != topologyTime ||
+      mol->GetMTime() <= topologyTime)
+    {
+    cout << "Error moving an atom changed the topology time." << endl;
+    ++errors;
+    }
+
+  h2.SetAtomicNumber(8);
+  if (mol->GetTopologyMTime() <= topologyTime)
+    {
+    cout << "Error changing an element kept the topology time." << endl;
+    ++errors;
+    }
+
+  topologyTime = mol->GetTopologyMTime();
+  mol->SetBondOrder(b.GetId(), 2);
+  if (mol->GetTopologyMTime() <= topologyTime)
+    {
+    cout << "Error changing a bond order kept the topology time." << endl;
+    ++errors;
+    }
+
+  topologyTime = mol->GetTopologyMTime();
+  mol->GetAtomicNumberArray()->SetValue(0, 6);
+  mol->GetAtomicNumberArray()->Modified();
+  if (mol->GetTopologyMTime() <= topologyTime)
+    {
+    cout << "Error changing the atomic number array kept the topology time."
+         << endl;
+    ++errors;
+    }
+
+  return errors == 0;
+}
+
 int TestMolecule(int, char * [])
 {
   // Check that the example code given in the molecule docs compiles:
   bool test1 = MoleculeExampleCode1();
   bool test2 = MoleculeExampleCode2();
+  bool test3 = MoleculeTopologyMTime();
 
-  return (test1 && test2) ? 0 : 1;
+  return (test1 && test2 && test3) ? 0 : 1;
 }
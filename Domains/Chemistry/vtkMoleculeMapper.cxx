@@ -123,6 +123,10 @@ vtkMoleculeMapper::vtkMoleculeMapper()
 
   // Force the glyph data to be generated on the next render:
   this->GlyphDataInitialized = false;
+  this->GlyphMolecule = NULL;
+  this->GlyphNumberOfAtoms = 0;
+  this->GlyphNumberOfBonds = 0;
+  this->GlyphTopologyMTime = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -312,12 +316,28 @@ void vtkMoleculeMapper::UpdateGlyphPolyData()
 {
   vtkMolecule *molecule = this->GetInput();
 
+  // When only the atoms moved, as between the frames of a trajectory, the
+  // glyph arrays that depend on the elements and the bonds are kept.
+  bool positionsOnly = this->GlyphDataInitialized &&
+    molecule == this->GlyphMolecule &&
+    molecule->GetNumberOfAtoms() == this->GlyphNumberOfAtoms &&
+    molecule->GetNumberOfBonds() == this->GlyphNumberOfBonds &&
+    molecule->GetTopologyMTime() <= this->GlyphTopologyMTime;
+
   if (!this->GlyphDataInitialized || (
         (molecule->GetMTime() > this->AtomGlyphPolyData->GetMTime() ||
          this->GetMTime() > this->AtomGlyphPolyData->GetMTime()) &&
         this->RenderAtoms))
     {
-    this->UpdateAtomGlyphPolyData();
+    if (positionsOnly &&
+        this->GetMTime() <= this->AtomGlyphPolyData->GetMTime())
+      {
+      this->UpdateAtomGlyphPositions();
+      }
+    else
+      {
+      this->UpdateAtomGlyphPolyData();
+      }
     }
 
   if (!this->GlyphDataInitialized || (
@@ -325,10 +345,22 @@ void vtkMoleculeMapper::UpdateGlyphPolyData()
          this->GetMTime() > this->BondGlyphPolyData->GetMTime()) &&
         this->RenderBonds))
     {
-    this->UpdateBondGlyphPolyData();
+    if (positionsOnly &&
+        this->GetMTime() <= this->BondGlyphPolyData->GetMTime())
+      {
+      this->UpdateBondGlyphPositions();
+      }
+    else
+      {
+      this->UpdateBondGlyphPolyData();
+      }
     }
 
   this->GlyphDataInitialized = true;
+  this->GlyphMolecule = molecule;
+  this->GlyphNumberOfAtoms = molecule->GetNumberOfAtoms();
+  this->GlyphNumberOfBonds = molecule->GetNumberOfBonds();
+  this->GlyphTopologyMTime = molecule->GetTopologyMTime();
 }
 
 //----------------------------------------------------------------------------
@@ -382,6 +414,85 @@ void vtkMoleculeMapper::UpdateAtomGlyphPolyData()
   this->AtomGlyphMapper->SetScaleArray("Scale Factors");
 }
 
+//----------------------------------------------------------------------------
+// The atom glyphs are placed at the atomic positions, nothing else moves
+void vtkMoleculeMapper::UpdateAtomGlyphPositions()
+{
+  this->AtomGlyphPolyData->SetPoints(
+    this->GetInput()->GetAtomicPositionArray());
+  this->AtomGlyphPolyData->Modified();
+}
+
+//----------------------------------------------------------------------------
+namespace
+{
+// Compute the normalized direction and the length of a bond, the center of
+// its first cylinder, and the step to the center of the next one when
+// multicylinders show the bond order.
+void vtkMoleculeMapperGetBondFrame(const vtkVector3f &pos1,
+                                   const vtkVector3f &pos2,
+                                   unsigned short bondOrder,
+                                   bool useMultiCylinders, float deltaLength,
+                                   vtkVector3f &bondVec, float &bondLength,
+                                   vtkVector3f &cylinderCenter,
+                                   vtkVector3f &delta)
+{
+  // Unit z vector -- used for multicylinder orientation
+  const static vtkVector3f unitZ (0.0, 0.0, 1.0);
+  // The initial displacement when generating a multibond
+  vtkVector3f initialDisp;
+  initialDisp.Set(0.0, 0.0, 0.0);
+  delta.Set(0.0, 0.0, 0.0);
+
+  // - Normalized vector in direction of bond
+  bondVec = pos2 - pos1;
+  bondLength = bondVec.Normalize();
+  // - Center of bond for translation
+  // TODO vtkVector scalar multiplication
+//    bondCenter = (pos1 + pos2) * 0.5;
+  vtkVector3f bondCenter;
+  bondCenter[0] = (pos1[0] + pos2[0]) * 0.5;
+  bondCenter[1] = (pos1[1] + pos2[1]) * 0.5;
+  bondCenter[2] = (pos1[2] + pos2[2]) * 0.5;
+  // end vtkVector TODO
+
+  // Set up delta step vector and bond radius from bond order:
+  if (useMultiCylinders)
+    {
+    switch (bondOrder)
+      {
+      case 1:
+      default:
+        break;
+      case 2:
+        // TODO vtkVector scalar multiplication
+//        delta = bondVec.Cross(unitZ).Normalized() * deltaLength;
+//        initialDisp = delta * (-0.5);
+        delta = bondVec.Cross(unitZ).Normalized();
+        delta[0] *= deltaLength;
+        delta[1] *= deltaLength;
+        delta[2] *= deltaLength;
+        initialDisp.Set(delta[0]*(-0.5), delta[1]*(-0.5), delta[2]*(-0.5));
+        // End vtkVector TODO
+        break;
+      case 3:
+        // TODO vtkVector scalar multiplication, negation
+//        delta = bondVec.Cross(unitZ).Normalized() * deltaLength;
+//        initialDisp = -delta;
+        delta = bondVec.Cross(unitZ).Normalized();
+        delta[0] *= deltaLength;
+        delta[1] *= deltaLength;
+        delta[2] *= deltaLength;
+        initialDisp.Set(-delta[0], -delta[1], -delta[2]);
+        // End vtkVector TODO
+        break;
+      }
+    }
+
+  cylinderCenter = bondCenter + initialDisp;
+}
+}
+
 //----------------------------------------------------------------------------
 // Generate position, scale, and orientation vectors for each bond cylinder
 void vtkMoleculeMapper::UpdateBondGlyphPolyData()
@@ -496,12 +607,6 @@ void vtkMoleculeMapper::UpdateBondGlyphPolyData()
   const float deltaLength = this->BondRadius * 2.6;
   // Vector between centers cylinders in a multibond:
   vtkVector3f delta;
-  delta.Set(0.0, 0.0, 0.0);
-  // The initial displacement when generating a multibond
-  vtkVector3f initialDisp;
-  initialDisp.Set(0.0, 0.0, 0.0);
-  // The geometric center of the bond
-  vtkVector3f bondCenter;
   // The center of the current cylinder
   vtkVector3f cylinderCenter;
   // Used in DiscreteByAtom color mode:
@@ -512,8 +617,6 @@ void vtkMoleculeMapper::UpdateBondGlyphPolyData()
   unsigned short atomicNumbers[2];
   // Normalized vector pointing along bond from begin->end atom
   vtkVector3f bondVec;
-  // Unit z vector -- used for multicylinder orientation
-  const static vtkVector3f unitZ (0.0, 0.0, 1.0);
   // Can't use InsertNextTuple(unsigned char *) in a
   // vtkUnsignedCharArray. This float array is used instead.
   // Initialize with bondColor for SingleColor mode
@@ -534,51 +637,10 @@ void vtkMoleculeMapper::UpdateBondGlyphPolyData()
     atomicNumbers[1] = bond.GetEndAtom().GetAtomicNumber();
 
     // Compute additional bond info
-    // - Normalized vector in direction of bond
-    bondVec = pos2 - pos1;
-    bondLength = bondVec.Normalize();
-    // - Center of bond for translation
-    // TODO vtkVector scalar multiplication
-//    bondCenter = (pos1 + pos2) * 0.5;
-    bondCenter[0] = (pos1[0] + pos2[0]) * 0.5;
-    bondCenter[1] = (pos1[1] + pos2[1]) * 0.5;
-    bondCenter[2] = (pos1[2] + pos2[2]) * 0.5;
-    // end vtkVector TODO
-
-    // Set up delta step vector and bond radius from bond order:
-    if (this->UseMultiCylindersForBonds)
-      {
-      switch (bondOrder)
-        {
-        case 1:
-        default:
-          delta.Set(0.0, 0.0, 0.0);
-          initialDisp.Set(0.0, 0.0, 0.0);
-          break;
-        case 2:
-          // TODO vtkVector scalar multiplication
-//          delta = bondVec.Cross(unitZ).Normalized() * deltaLength;
-//          initialDisp = delta * (-0.5);
-          delta = bondVec.Cross(unitZ).Normalized();
-          delta[0] *= deltaLength;
-          delta[1] *= deltaLength;
-          delta[2] *= deltaLength;
-          initialDisp.Set(delta[0]*(-0.5), delta[1]*(-0.5), delta[2]*(-0.5));
-          // End vtkVector TODO
-          break;
-        case 3:
-          // TODO vtkVector scalar multiplication, negation
-//          delta = bondVec.Cross(unitZ).Normalized() * deltaLength;
-//          initialDisp = -delta;
-          delta = bondVec.Cross(unitZ).Normalized();
-          delta[0] *= deltaLength;
-          delta[1] *= deltaLength;
-          delta[2] *= deltaLength;
-          initialDisp.Set(-delta[0], -delta[1], -delta[2]);
-          // End vtkVector TODO
-          break;
-        }
-      }
+    vtkMoleculeMapperGetBondFrame(pos1, pos2, bondOrder,
+                                  this->UseMultiCylindersForBonds,
+                                  deltaLength, bondVec, bondLength,
+                                  cylinderCenter, delta);
 
     // Set up cylinder scale factors
     switch (this->BondColorMode)
@@ -592,15 +654,6 @@ void vtkMoleculeMapper::UpdateBondGlyphPolyData()
         break;
       }
 
-    if (this->UseMultiCylindersForBonds)
-      {
-      cylinderCenter = bondCenter + initialDisp;
-      }
-    else
-      {
-      cylinderCenter = bondCenter;
-      }
-
     // For each bond order, add a point to the glyph points, translate
     // by delta, and repeat.
     for (unsigned short iter = 0; iter < bondOrder; ++iter)
@@ -680,6 +733,89 @@ void vtkMoleculeMapper::UpdateBondGlyphPolyData()
   this->BondGlyphMapper->UseSelectionIdsOn();
 }
 
+//----------------------------------------------------------------------------
+// Move the bond cylinders in place. The molecule has the same bonds and the
+// mapper the same settings as when the arrays were generated, so the
+// cylinders come in the same order.
+void vtkMoleculeMapper::UpdateBondGlyphPositions()
+{
+  vtkMolecule *molecule = this->GetInput();
+  const vtkIdType numBonds = molecule->GetNumberOfBonds();
+
+  vtkPoints *cylCenters = this->BondGlyphPolyData->GetPoints();
+  vtkFloatArray *cylScales = vtkFloatArray::SafeDownCast(
+    this->BondGlyphPolyData->GetPointData()->GetArray("Scale Factors"));
+  vtkFloatArray *orientationVectors = vtkFloatArray::SafeDownCast(
+    this->BondGlyphPolyData->GetPointData()->GetArray("Orientation Vectors"));
+  if (!cylCenters || !cylScales || !orientationVectors)
+    {
+    this->UpdateBondGlyphPolyData();
+    return;
+    }
+
+  const float deltaLength = this->BondRadius * 2.6;
+  float bondLength;
+  vtkVector3f bondVec;
+  vtkVector3f cylinderCenter;
+  vtkVector3f halfCylinderCenter;
+  vtkVector3f delta;
+  vtkIdType cylInd = 0;
+
+  for (vtkIdType bondInd = 0; bondInd < numBonds; ++bondInd)
+    {
+    vtkBond bond = molecule->GetBond(bondInd);
+    unsigned short bondOrder = bond.GetOrder();
+    vtkMoleculeMapperGetBondFrame(bond.GetBeginAtom().GetPosition(),
+                                  bond.GetEndAtom().GetPosition(), bondOrder,
+                                  this->UseMultiCylindersForBonds,
+                                  deltaLength, bondVec, bondLength,
+                                  cylinderCenter, delta);
+
+    for (unsigned short iter = 0; iter < bondOrder; ++iter)
+      {
+      switch (this->BondColorMode)
+        {
+        case SingleColor:
+          cylCenters->SetPoint(cylInd, cylinderCenter.GetData());
+          cylScales->SetTuple3(cylInd, bondLength, this->BondRadius,
+                               this->BondRadius);
+          orientationVectors->SetTuple(cylInd++, bondVec.GetData());
+          break;
+        default:
+        case DiscreteByAtom:
+          const float quarterLength = 0.25 * bondLength;
+          for (int side = -1; side <= 1; side += 2)
+            {
+            halfCylinderCenter[0] = cylinderCenter[0] +
+                side * (bondVec[0] * quarterLength);
+            halfCylinderCenter[1] = cylinderCenter[1] +
+                side * (bondVec[1] * quarterLength);
+            halfCylinderCenter[2] = cylinderCenter[2] +
+                side * (bondVec[2] * quarterLength);
+            cylCenters->SetPoint(cylInd, halfCylinderCenter.GetData());
+            cylScales->SetTuple3(cylInd, 0.5 * bondLength, this->BondRadius,
+                                 this->BondRadius);
+            orientationVectors->SetTuple(cylInd++, bondVec.GetData());
+            }
+        }
+
+      // Prepare for next multicylinder
+      if (this->UseMultiCylindersForBonds && bondOrder != 1)
+        {
+        cylinderCenter[0] += delta[0];
+        cylinderCenter[1] += delta[1];
+        cylinderCenter[2] += delta[2];
+        }
+      }
+    }
+
+  // Only these arrays changed, the glyph mappers rely on it
+  cylCenters->Modified();
+  cylScales->Modified();
+  orientationVectors->Modified();
+  this->BondGlyphPolyData->Modified();
+}
+
 //----------------------------------------------------------------------------
 void vtkMoleculeMapper::ReleaseGraphicsResources(vtkWindow *w)
 {
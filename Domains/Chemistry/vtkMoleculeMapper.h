@@ -16,7 +16,8 @@
 //
 // .SECTION Description
 // vtkMoleculeMapper uses glyphs (display lists) to quickly render a
-// molecule.
+// molecule. When only the atoms move between two renders, as when playing a
+// trajectory, the glyphs are moved in place instead of being regenerated.
 
 #ifndef vtkMoleculeMapper_h
 #define vtkMoleculeMapper_h
@@ -245,6 +246,17 @@ protected:
   virtual void UpdateAtomGlyphPolyData();
   virtual void UpdateBondGlyphPolyData();
 
+  // Description:
+  // Move the glyphs when only the atomic positions changed since they were
+  // generated, keeping their scalars and selection ids. The molecule and
+  // its topology time at that point are cached to tell.
+  virtual void UpdateAtomGlyphPositions();
+  virtual void UpdateBondGlyphPositions();
+  vtkMolecule *GlyphMolecule;
+  vtkIdType GlyphNumberOfAtoms;
+  vtkIdType GlyphNumberOfBonds;
+  unsigned long GlyphTopologyMTime;
+
   // Description:
   // Internal mappers
   vtkNew<vtkGlyph3DMapper> AtomGlyphMapper;
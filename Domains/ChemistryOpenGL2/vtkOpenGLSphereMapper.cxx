@@ -276,6 +276,26 @@ void vtkOpenGLSphereMapperCreateVBO(float * points, vtkIdType numPts,
   VBO->VertexCount = numPts*3;
   return;
 }
+
+// rewrite the positions of a VBO made by vtkOpenGLSphereMapperCreateVBO
+void vtkOpenGLSphereMapperUpdateVBOPositions(float *points, vtkIdType numPts,
+              vtkOpenGLVertexBufferObject *VBO)
+{
+  size_t blockSize = VBO->Stride / sizeof(float);
+  std::vector<float>::iterator it = VBO->PackedVBO.begin();
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    float *pointPtr = points + i*3;
+    for (int j = 0; j < 3; ++j)
+      {
+      it[0] = pointPtr[0];
+      it[1] = pointPtr[1];
+      it[2] = pointPtr[2];
+      it += blockSize;
+      }
+    }
+  VBO->Upload(VBO->PackedVBO, vtkOpenGLBufferObject::ArrayBuffer);
+}
 }
 
 //-------------------------------------------------------------------------
@@ -296,7 +316,7 @@ bool vtkOpenGLSphereMapper::GetNeedToRebuildBufferObjects(
 //-------------------------------------------------------------------------
 void vtkOpenGLSphereMapper::BuildBufferObjects(
   vtkRenderer *vtkNotUsed(ren),
-  vtkActor *vtkNotUsed(act))
+  vtkActor *act)
 {
   vtkPolyData *poly = this->CurrentInput;
 
@@ -305,6 +325,22 @@ void vtkOpenGLSphereMapper::BuildBufferObjects(
     return;
     }
 
+  // When only the points moved since the last build, as between the frames
+  // of a trajectory, the colors and radii in the buffer are still right.
+  vtkIdType numPts = poly->GetPoints()->GetNumberOfPoints();
+  if (numPts > 0 &&
+      this->VBO->VertexCount == static_cast<size_t>(numPts*3) &&
+      this->VBOBuildTime > this->GetMTime() &&
+      this->VBOBuildTime > act->GetMTime() &&
+      this->VBOBuildTime > poly->GetPointData()->GetMTime())
+    {
+    vtkOpenGLSphereMapperUpdateVBOPositions(
+      static_cast<float *>(poly->GetPoints()->GetVoidPointer(0)),
+      numPts, this->VBO);
+    this->VBOBuildTime.Modified();
+    return;
+    }
+
   // For vertex coloring, this sets this->Colors as side effect.
   // For texture map coloring, this sets ColorCoordinates
   // and ColorTextureMap as a side effect.
@@ -483,6 +483,36 @@ void vtkOpenGLStickMapperCreateVBO(float * points, vtkIdType numPts,
   VBO->VertexCount = numPts*6;
   return;
 }
+
+// rewrite the positions, orientations and sizes of a VBO made by
+// vtkOpenGLStickMapperCreateVBO
+void vtkOpenGLStickMapperUpdateVBOPositions(float * points, vtkIdType numPts,
+              float *orients,
+              float *sizes,
+              vtkOpenGLVertexBufferObject *VBO)
+{
+  size_t blockSize = VBO->Stride / sizeof(float);
+  std::vector<float>::iterator it = VBO->PackedVBO.begin();
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    float *pointPtr = points + i*3;
+    float *orientPtr = orients + i*3;
+    float radius = sizes[i*3+1];
+    float length = sizes[i*3];
+    for (int j = 0; j < 6; ++j)
+      {
+      it[0] = pointPtr[0];
+      it[1] = pointPtr[1];
+      it[2] = pointPtr[2];
+      it[4] = orientPtr[0]*length;
+      it[5] = orientPtr[1]*length;
+      it[6] = orientPtr[2]*length;
+      it[8] = radius;
+      it += blockSize;
+      }
+    }
+  VBO->Upload(VBO->PackedVBO, vtkOpenGLBufferObject::ArrayBuffer);
+}
 }
 
 size_t vtkOpenGLStickMapperCreateTriangleIndexBuffer(
@@ -528,7 +558,7 @@ bool vtkOpenGLStickMapper::GetNeedToRebuildBufferObjects(
 
 //-------------------------------------------------------------------------
 void vtkOpenGLStickMapper::BuildBufferObjects(vtkRenderer *ren,
-  vtkActor *vtkNotUsed(act))
+  vtkActor *act)
 {
   vtkPolyData *poly = this->CurrentInput;
 
@@ -537,6 +567,41 @@ void vtkOpenGLStickMapper::BuildBufferObjects(vtkRenderer *ren,
     return;
     }
 
+  vtkHardwareSelector* selector = ren->GetSelector();
+  bool picking = (ren->GetRenderWindow()->GetIsPicking() || selector != NULL);
+
+  // When only the sticks moved since the last build, as between the frames
+  // of a trajectory, the colors, selection ids and indices are still right.
+  vtkIdType numPts = poly->GetPoints()->GetNumberOfPoints();
+  vtkDataArray *orients = poly->GetPointData()->GetArray(this->OrientationArray);
+  vtkDataArray *sizes = poly->GetPointData()->GetArray(this->ScaleArray);
+  bool positionsOnly = numPts > 0 &&
+    this->VBO->VertexCount == static_cast<size_t>(numPts*6) &&
+    this->VBO->Stride == static_cast<int>((picking ? 10 : 9)*sizeof(float)) &&
+    this->VBOBuildTime > this->GetMTime() &&
+    this->VBOBuildTime > act->GetMTime() &&
+    this->VBOBuildTime > this->SelectionStateChanged;
+  for (int i = 0; positionsOnly &&
+       i < poly->GetPointData()->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = poly->GetPointData()->GetArray(i);
+    if (array && array != orients && array != sizes)
+      {
+      positionsOnly = this->VBOBuildTime > array->GetMTime();
+      }
+    }
+  if (positionsOnly)
+    {
+    vtkOpenGLStickMapperUpdateVBOPositions(
+      static_cast<float *>(poly->GetPoints()->GetVoidPointer(0)),
+      numPts,
+      static_cast<float *>(orients->GetVoidPointer(0)),
+      static_cast<float *>(sizes->GetVoidPointer(0)),
+      this->VBO);
+    this->VBOBuildTime.Modified();
+    return;
+    }
+
   // For vertex coloring, this sets this->Colors as side effect.
   // For texture map coloring, this sets ColorCoordinates
   // and ColorTextureMap as a side effect.
@@ -545,9 +610,6 @@ void vtkOpenGLStickMapper::BuildBufferObjects(vtkRenderer *ren,
   // then the scalars do not have to be regenerted.
   this->MapScalars(1.0);
 
-  vtkHardwareSelector* selector = ren->GetSelector();
-  bool picking = (ren->GetRenderWindow()->GetIsPicking() || selector != NULL);
-
   // Iterate through all of the different types in the polydata, building OpenGLs
   // and IBOs as appropriate for each type.
   vtkOpenGLStickMapperCreateVBO(
@@ -555,8 +617,8 @@ void vtkOpenGLStickMapper::BuildBufferObjects(vtkRenderer *ren,
     poly->GetPoints()->GetNumberOfPoints(),
     this->Colors ? (unsigned char *)this->Colors->GetVoidPointer(0) : NULL,
     this->Colors ? this->Colors->GetNumberOfComponents() : 0,
-    static_cast<float *>(poly->GetPointData()->GetArray(this->OrientationArray)->GetVoidPointer(0)),
-    static_cast<float *>(poly->GetPointData()->GetArray(this->ScaleArray)->GetVoidPointer(0)),
+    static_cast<float *>(orients->GetVoidPointer(0)),
+    static_cast<float *>(sizes->GetVoidPointer(0)),
     picking ?
       static_cast<vtkIdType *>(poly->GetPointData()->GetArray(this->SelectionIdArray)->GetVoidPointer(0))
       : NULL,
@@ -41,6 +41,10 @@ public:
   // Convenience method to set the array to select with
   vtkSetStringMacro(SelectionIdArray);
 
+  // Description:
+  // The sticks write their own selection ids, one pass at a time.
+  virtual bool GetSupportsSinglePassSelection() { return false; }
+
 protected:
   vtkOpenGLStickMapper();
   ~vtkOpenGLStickMapper();
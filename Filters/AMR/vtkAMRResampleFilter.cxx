@@ -411,20 +411,16 @@ bool vtkAMRResampleFilter::SearchForDonorGridAtLevel(
 
   vtkTimerLog::MarkStartEvent( oss.str().c_str() );
 
-  for(donorGridId = 0; donorGridId < amrds->GetNumberOfDataSets(level); ++donorGridId )
+  // The block locator of the meta data only tests the grids whose bounds
+  // may contain q, and finds the same grid as a scan of the level
+  donorCellIdx = -1;
+  this->NumberOfBlocksTestedForLevel++;
+  if(amrds->GetAMRInfo()->FindGridCell(q, level, donorGridId, donorCellIdx))
     {
-    donorCellIdx = -1;
-    this->NumberOfBlocksTestedForLevel++;
-    if(amrds->GetAMRInfo()->FindCell(q, level,donorGridId,donorCellIdx))
-     {
-     assert( "pre: donorCellIdx is invalid" &&
-             (donorCellIdx >= 0));//  &&
-             // (donorCellIdx < donorGrid->GetNumberOfCells()) );
-     vtkTimerLog::MarkEndEvent( oss.str().c_str() );
-     return true;
-     } // END if
-
-    } // END for all data at level
+    assert( "pre: donorCellIdx is invalid" && (donorCellIdx >= 0) );
+    vtkTimerLog::MarkEndEvent( oss.str().c_str() );
+    return true;
+    } // END if
 
 
   // No suitable grid is found at the requested level, set donorGrid to NULL
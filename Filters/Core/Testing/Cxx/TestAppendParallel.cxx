@@ -0,0 +1,216 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAppendParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkAppendPolyData and vtkAppendFilter give the same output
+// with AppendInParallel on as with it off, and that merging the points
+// keeps the geometry of the cells and the point attributes.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+
+const int NumberOfPieces = 3;
+const int Res = 4;
+
+// A Res x Res grid of points from x = 3 * piece with verts, a line, quads
+// and a strip, so that consecutive pieces share a column of points.
+vtkSmartPointer<vtkPolyData> MakePiece(int piece)
+{
+  vtkSmartPointer<vtkPolyData> pd = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("PointValues");
+  for (int j = 0; j < Res; ++j)
+    {
+    for (int i = 0; i < Res; ++i)
+      {
+      double x = (Res - 1) * piece + i;
+      points->InsertNextPoint(x, j, 0.0);
+      pointValues->InsertNextValue(x + 10.0 * j);
+      }
+    }
+  pd->SetPoints(points.GetPointer());
+  pd->GetPointData()->SetScalars(pointValues.GetPointer());
+
+  vtkNew<vtkCellArray> verts, lines, polys, strips;
+  vtkIdType ids[4];
+  ids[0] = piece;
+  verts->InsertNextCell(1, ids);
+  ids[0] = Res * Res - 1;
+  verts->InsertNextCell(1, ids);
+  ids[0] = 0; ids[1] = Res + 1; ids[2] = 2 * Res + 2;
+  lines->InsertNextCell(3, ids);
+  for (int j = 0; j < Res - 1; ++j)
+    {
+    for (int i = 0; i < Res - 1; ++i)
+      {
+      ids[0] = j * Res + i;
+      ids[1] = ids[0] + 1;
+      ids[2] = ids[1] + Res;
+      ids[3] = ids[0] + Res;
+      polys->InsertNextCell(4, ids);
+      }
+    }
+  ids[0] = 0; ids[1] = Res; ids[2] = 1; ids[3] = Res + 1;
+  strips->InsertNextCell(4, ids);
+  pd->SetVerts(verts.GetPointer());
+  pd->SetLines(lines.GetPointer());
+  pd->SetPolys(polys.GetPointer());
+  pd->SetStrips(strips.GetPointer());
+
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("CellValues");
+  for (vtkIdType i = 0; i < pd->GetNumberOfCells(); ++i)
+    {
+    cellValues->InsertNextValue(100.0 * piece + i);
+    }
+  pd->GetCellData()->AddArray(cellValues.GetPointer());
+  return pd;
+}
+
+bool SameArrays(vtkDataArray *expected, vtkDataArray *output)
+{
+  if (!expected || !output ||
+      expected->GetNumberOfTuples() != output->GetNumberOfTuples())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+    {
+    if (expected->GetComponent(i, 0) != output->GetComponent(i, 0))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Compares the cells of two datasets through the coordinates and the
+// attribute of their points, so that the point ids may differ.
+bool SameCells(vtkDataSet *expected, vtkDataSet *output, const char *what)
+{
+  if (expected->GetNumberOfCells() != output->GetNumberOfCells())
+    {
+    cerr << what << ": different number of cells" << endl;
+    return false;
+    }
+  vtkDataArray *values = expected->GetPointData()->GetArray("PointValues");
+  vtkDataArray *outValues = output->GetPointData()->GetArray("PointValues");
+  if (!values || !outValues ||
+      !SameArrays(expected->GetCellData()->GetArray("CellValues"),
+                  output->GetCellData()->GetArray("CellValues")))
+    {
+    cerr << what << ": different cell data" << endl;
+    return false;
+    }
+  vtkNew<vtkIdList> ptIds, outPtIds;
+  for (vtkIdType cellId = 0; cellId < expected->GetNumberOfCells(); ++cellId)
+    {
+    expected->GetCellPoints(cellId, ptIds.GetPointer());
+    output->GetCellPoints(cellId, outPtIds.GetPointer());
+    if (expected->GetCellType(cellId) != output->GetCellType(cellId) ||
+        ptIds->GetNumberOfIds() != outPtIds->GetNumberOfIds())
+      {
+      cerr << what << ": different cell " << cellId << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+      double x[3], outX[3];
+      expected->GetPoint(ptIds->GetId(i), x);
+      output->GetPoint(outPtIds->GetId(i), outX);
+      if (x[0] != outX[0] || x[1] != outX[1] || x[2] != outX[2] ||
+          values->GetComponent(ptIds->GetId(i), 0) !=
+          outValues->GetComponent(outPtIds->GetId(i), 0))
+        {
+        cerr << what << ": different points in cell " << cellId << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+// Checks the output of the parallel append against the serial one, then
+// with merged points.
+template <class T>
+bool CheckAppend(T *append, const char *what)
+{
+  append->AppendInParallelOff();
+  append->Update();
+  vtkSmartPointer<vtkDataSet> expected;
+  expected.TakeReference(append->GetOutput()->NewInstance());
+  expected->DeepCopy(append->GetOutput());
+
+  append->AppendInParallelOn();
+  append->Update();
+  vtkDataSet *output = append->GetOutput();
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+      !SameArrays(vtkPointSet::SafeDownCast(expected)->GetPoints()->GetData(),
+                  vtkPointSet::SafeDownCast(output)->GetPoints()->GetData()) ||
+      !SameArrays(expected->GetPointData()->GetScalars(),
+                  output->GetPointData()->GetScalars()))
+    {
+    cerr << what << ": different points" << endl;
+    return false;
+    }
+  if (!SameCells(expected, output, what))
+    {
+    return false;
+    }
+
+  append->MergePointsOn();
+  append->Update();
+  output = append->GetOutput();
+  vtkIdType numMerged = NumberOfPieces * Res * Res - (NumberOfPieces - 1) * Res;
+  if (output->GetNumberOfPoints() != numMerged)
+    {
+    cerr << what << ": wrong number of merged points" << endl;
+    return false;
+    }
+  return SameCells(expected, output, what);
+}
+
+}
+
+int TestAppendParallel(int, char *[])
+{
+  vtkNew<vtkAppendPolyData> appendPolyData;
+  vtkNew<vtkAppendFilter> appendFilter;
+  for (int piece = 0; piece < NumberOfPieces; ++piece)
+    {
+    vtkSmartPointer<vtkPolyData> pd = MakePiece(piece);
+    appendPolyData->AddInputData(pd);
+    appendFilter->AddInputData(pd);
+    }
+  if (!CheckAppend(appendPolyData.GetPointer(), "vtkAppendPolyData") ||
+      !CheckAppend(appendFilter.GetPointer(), "vtkAppendFilter"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,164 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestArrayCalculatorBlocks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkArrayCalculator produces the same results with
+// EvaluateInParallel on as with it off, for scalar and vector functions of
+// arrays and coordinates, with and without replacement of invalid values.
+
+#include "vtkArrayCalculator.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <cmath>
+
+namespace
+{
+
+const vtkIdType NumberOfPoints = 5000;
+
+void MakeInput(vtkPolyData *input)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> s;
+  vtkNew<vtkFloatArray> v;
+  vtkNew<vtkIntArray> n;
+  s->SetName("s");
+  v->SetName("v");
+  v->SetNumberOfComponents(3);
+  n->SetName("n");
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+    {
+    double t = 0.01 * i;
+    points->InsertNextPoint(cos(t), sin(t), 0.001 * i);
+    s->InsertNextValue(sin(3.0 * t) - 0.2);
+    v->InsertNextTuple3(t, 1.0 - t, 0.5 * cos(t));
+    n->InsertNextValue(static_cast<int>(i % 7) - 3);
+    }
+  input->SetPoints(points.GetPointer());
+  input->GetPointData()->AddArray(s.GetPointer());
+  input->GetPointData()->AddArray(v.GetPointer());
+  input->GetPointData()->AddArray(n.GetPointer());
+}
+
+bool Check(vtkArrayCalculator *calc, const char *function)
+{
+  calc->SetFunction(function);
+  calc->EvaluateInParallelOff();
+  calc->Update();
+  vtkNew<vtkDoubleArray> expected;
+  expected->DeepCopy(
+    calc->GetOutput()->GetPointData()->GetArray("Result"));
+
+  calc->EvaluateInParallelOn();
+  calc->Update();
+  vtkDataArray *result =
+    calc->GetOutput()->GetPointData()->GetArray("Result");
+  if (!result ||
+      result->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+      result->GetNumberOfComponents() != expected->GetNumberOfComponents())
+    {
+    cerr << function << ": different result arrays" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < result->GetNumberOfTuples(); ++i)
+    {
+    for (int j = 0; j < result->GetNumberOfComponents(); ++j)
+      {
+      double a = expected->GetComponent(i, j);
+      double b = result->GetComponent(i, j);
+      if (a != b && !(vtkMath::IsNan(a) && vtkMath::IsNan(b)))
+        {
+        cerr << function << ": different value at tuple " << i
+             << ", " << a << " instead of " << b << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+}
+
+int TestArrayCalculatorBlocks(int, char *[])
+{
+  vtkNew<vtkPolyData> input;
+  MakeInput(input.GetPointer());
+
+  vtkNew<vtkArrayCalculator> calc;
+  calc->SetInputData(input.GetPointer());
+  calc->SetResultArrayName("Result");
+  calc->SetBlockSize(300);
+  calc->AddScalarArrayName("s");
+  calc->AddScalarArrayName("n");
+  calc->AddVectorArrayName("v");
+  calc->AddVectorVariable("w", "v", 2, 0, 1);
+  calc->AddCoordinateScalarVariable("x", 0);
+  calc->AddCoordinateScalarVariable("z", 2);
+  calc->AddCoordinateVectorVariable("p");
+
+  const char *scalarFunctions[] =
+    {
+    "s*x + n^2 - abs(z)/(1+s*s)",
+    "exp(-s)*cos(x) + atan(z) - sign(n)*min(s,x) + max(z,n)",
+    "if((s > 0) | (x < 0), mag(v), p.w) + if(n = 0, 1, 0)",
+    "p.v + mag(cross(v,w)) + floor(s*10) - ceil(x*3)",
+    "sqrt(s) + ln(x) + log10(n) + asin(s*2)"
+    };
+  const char *vectorFunctions[] =
+    {
+    "s*v + x*iHat - n*jHat + w",
+    "cross(v,p) + norm(w) - if(s>0, p, 2*v)",
+    "sqrt(s)*v + ln(z)*p"
+    };
+
+  calc->SetResultArrayType(VTK_DOUBLE);
+  for (int i = 0; i < 4; ++i)
+    {
+    if (!Check(calc.GetPointer(), scalarFunctions[i]))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  for (int i = 0; i < 2; ++i)
+    {
+    if (!Check(calc.GetPointer(), vectorFunctions[i]))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  // The functions of the last kind are invalid for some of the tuples,
+  // which are replaced the same way by both paths.
+  calc->ReplaceInvalidValuesOn();
+  calc->SetReplacementValue(-1.0);
+  if (!Check(calc.GetPointer(), scalarFunctions[4]) ||
+      !Check(calc.GetPointer(), vectorFunctions[2]))
+    {
+    return EXIT_FAILURE;
+    }
+
+  calc->SetResultArrayType(VTK_FLOAT);
+  if (!Check(calc.GetPointer(), scalarFunctions[1]))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
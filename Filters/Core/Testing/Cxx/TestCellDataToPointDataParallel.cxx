@@ -0,0 +1,319 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellDataToPointDataParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the averages of vtkCellDataToPointData and vtkPointDataToCellData,
+// which visit the cells of the points through static links in parallel,
+// against averages computed cell by cell. The inputs have points used by
+// no cell and cells using a point twice.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellDataToPointData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointDataToCellData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+const int Res = 20;
+
+vtkIdType PointId(int i, int j)
+{
+  return i + (Res + 1) * j;
+}
+
+// A grid of points, with an unused point at the end.
+void BuildPoints(vtkPointSet *data)
+{
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= Res; ++j)
+    {
+    for (int i = 0; i <= Res; ++i)
+      {
+      points->InsertNextPoint(i, j, 0.0);
+      }
+    }
+  points->InsertNextPoint(-1.0, -1.0, 0.0);
+  data->SetPoints(points.GetPointer());
+}
+
+// Random cell and point arrays of doubles and integers.
+void AddArrays(vtkDataSet *data)
+{
+  vtkNew<vtkDoubleArray> cellVectors;
+  cellVectors->SetName("Vectors");
+  cellVectors->SetNumberOfComponents(3);
+  vtkNew<vtkIntArray> cellInts;
+  cellInts->SetName("Ints");
+  for (vtkIdType i = 0; i < data->GetNumberOfCells(); ++i)
+    {
+    cellVectors->InsertNextTuple3(vtkMath::Random(-1.0, 1.0),
+                                  vtkMath::Random(-1.0, 1.0),
+                                  vtkMath::Random(-1.0, 1.0));
+    cellInts->InsertNextValue(static_cast<int>(vtkMath::Random(-100, 100)));
+    }
+  data->GetCellData()->AddArray(cellVectors.GetPointer());
+  data->GetCellData()->AddArray(cellInts.GetPointer());
+
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("Scalars");
+  vtkNew<vtkIntArray> pointInts;
+  pointInts->SetName("PointInts");
+  for (vtkIdType i = 0; i < data->GetNumberOfPoints(); ++i)
+    {
+    pointScalars->InsertNextValue(vtkMath::Random(-1.0, 1.0));
+    pointInts->InsertNextValue(static_cast<int>(vtkMath::Random(-100, 100)));
+    }
+  data->GetPointData()->AddArray(pointScalars.GetPointer());
+  data->GetPointData()->AddArray(pointInts.GetPointer());
+}
+
+// Quads, with a triangle that uses one of its points twice.
+void BuildUnstructuredGrid(vtkUnstructuredGrid *grid)
+{
+  BuildPoints(grid);
+  grid->Allocate(Res * Res + 1);
+  for (int j = 0; j < Res; ++j)
+    {
+    for (int i = 0; i < Res; ++i)
+      {
+      vtkIdType quad[4] = { PointId(i, j), PointId(i + 1, j),
+                            PointId(i + 1, j + 1), PointId(i, j + 1) };
+      grid->InsertNextCell(VTK_QUAD, 4, quad);
+      }
+    }
+  vtkIdType triangle[3] = { PointId(1, 1), PointId(2, 2), PointId(1, 1) };
+  grid->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+  AddArrays(grid);
+}
+
+// Vertices, lines and polygons on the same points.
+void BuildPolyData(vtkPolyData *polyData)
+{
+  BuildPoints(polyData);
+  vtkNew<vtkCellArray> verts, lines, polys;
+  for (int j = 0; j < Res; ++j)
+    {
+    vtkIdType vert = PointId(j, j);
+    verts->InsertNextCell(1, &vert);
+    vtkIdType line[2] = { PointId(0, j), PointId(Res, j) };
+    lines->InsertNextCell(2, line);
+    for (int i = 0; i < Res; ++i)
+      {
+      vtkIdType quad[4] = { PointId(i, j), PointId(i + 1, j),
+                            PointId(i + 1, j + 1), PointId(i, j + 1) };
+      polys->InsertNextCell(4, quad);
+      }
+    }
+  vtkIdType triangle[3] = { PointId(3, 3), PointId(3, 3), PointId(4, 5) };
+  polys->InsertNextCell(3, triangle);
+  polyData->SetVerts(verts.GetPointer());
+  polyData->SetLines(lines.GetPointer());
+  polyData->SetPolys(polys.GetPointer());
+  AddArrays(polyData);
+}
+
+// Rounds as vtkDataArray::InterpolateTuple() does.
+double Round(double x)
+{
+  return x >= 0.0 ? floor(x + 0.5) : ceil(x - 0.5);
+}
+
+bool Same(double expected, double value)
+{
+  return fabs(expected - value) <= 1e-12 * (1.0 + fabs(expected));
+}
+
+// Unstructured grids sum the cell values and divide them in the type of
+// the array.
+bool CheckUnstructuredGrid(vtkUnstructuredGrid *grid)
+{
+  vtkNew<vtkCellDataToPointData> c2p;
+  c2p->SetInputData(grid);
+  c2p->Update();
+  vtkPointData *pd = c2p->GetOutput()->GetPointData();
+  vtkDoubleArray *vectors =
+    vtkDoubleArray::SafeDownCast(pd->GetArray("Vectors"));
+  vtkIntArray *ints = vtkIntArray::SafeDownCast(pd->GetArray("Ints"));
+  if (!vectors || !ints)
+    {
+    cerr << "Unstructured grid: missing arrays" << endl;
+    return false;
+    }
+
+  vtkIdType numPts = grid->GetNumberOfPoints();
+  std::vector<double> sums(3 * numPts, 0.0);
+  std::vector<int> intSums(numPts, 0);
+  std::vector<unsigned int> counts(numPts, 0);
+  vtkDataArray *cellVectors = grid->GetCellData()->GetArray("Vectors");
+  vtkDataArray *cellInts = grid->GetCellData()->GetArray("Ints");
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+    {
+    grid->GetCellPoints(cellId, pts.GetPointer());
+    for (vtkIdType i = 0; i < pts->GetNumberOfIds(); ++i)
+      {
+      vtkIdType ptId = pts->GetId(i);
+      for (int c = 0; c < 3; ++c)
+        {
+        sums[3 * ptId + c] += cellVectors->GetComponent(cellId, c);
+        }
+      intSums[ptId] += static_cast<int>(cellInts->GetTuple1(cellId));
+      ++counts[ptId];
+      }
+    }
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+    int n = counts[ptId] ? static_cast<int>(counts[ptId]) : 1;
+    bool same = ints->GetValue(ptId) == intSums[ptId] / n;
+    for (int c = 0; same && c < 3; ++c)
+      {
+      same = Same(sums[3 * ptId + c] / n, vectors->GetComponent(ptId, c));
+      }
+    if (!same)
+      {
+      cerr << "Unstructured grid: bad point " << ptId << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// Other data sets interpolate the values with equal weights, rounding
+// integers, and null the points used by no cell.
+bool CheckPolyData(vtkPolyData *polyData)
+{
+  vtkNew<vtkCellDataToPointData> c2p;
+  c2p->SetInputData(polyData);
+  c2p->Update();
+  vtkPointData *pd = c2p->GetOutput()->GetPointData();
+  vtkDataArray *vectors = pd->GetArray("Vectors");
+  vtkDataArray *ints = pd->GetArray("Ints");
+  if (!vectors || !ints ||
+      vectors->GetNumberOfTuples() != polyData->GetNumberOfPoints())
+    {
+    cerr << "Polygonal data: missing arrays" << endl;
+    return false;
+    }
+
+  vtkIdType numPts = polyData->GetNumberOfPoints();
+  std::vector<std::vector<vtkIdType> > pointCells(numPts);
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType cellId = 0; cellId < polyData->GetNumberOfCells(); ++cellId)
+    {
+    polyData->GetCellPoints(cellId, pts.GetPointer());
+    for (vtkIdType i = 0; i < pts->GetNumberOfIds(); ++i)
+      {
+      pointCells[pts->GetId(i)].push_back(cellId);
+      }
+    }
+  vtkDataArray *cellVectors = polyData->GetCellData()->GetArray("Vectors");
+  vtkDataArray *cellInts = polyData->GetCellData()->GetArray("Ints");
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+    size_t n = pointCells[ptId].size();
+    double weight = n ? 1.0 / n : 0.0;
+    double expected[4] = { 0.0, 0.0, 0.0, 0.0 };
+    for (size_t i = 0; i < n; ++i)
+      {
+      vtkIdType cellId = pointCells[ptId][i];
+      for (int c = 0; c < 3; ++c)
+        {
+        expected[c] += weight * cellVectors->GetComponent(cellId, c);
+        }
+      expected[3] += weight * cellInts->GetTuple1(cellId);
+      }
+    bool same = ints->GetTuple1(ptId) == Round(expected[3]);
+    for (int c = 0; same && c < 3; ++c)
+      {
+      same = Same(expected[c], vectors->GetComponent(ptId, c));
+      }
+    if (!same)
+      {
+      cerr << "Polygonal data: bad point " << ptId << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// The cells interpolate the values of their points with equal weights.
+bool CheckPointDataToCellData(vtkDataSet *data, const char *what)
+{
+  vtkNew<vtkPointDataToCellData> p2c;
+  p2c->SetInputData(data);
+  p2c->Update();
+  vtkCellData *cd = p2c->GetOutput()->GetCellData();
+  vtkDataArray *scalars = cd->GetArray("Scalars");
+  vtkDataArray *ints = cd->GetArray("PointInts");
+  if (!scalars || !ints ||
+      scalars->GetNumberOfTuples() != data->GetNumberOfCells())
+    {
+    cerr << what << ": missing arrays" << endl;
+    return false;
+    }
+
+  vtkDataArray *pointScalars = data->GetPointData()->GetArray("Scalars");
+  vtkDataArray *pointInts = data->GetPointData()->GetArray("PointInts");
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType cellId = 0; cellId < data->GetNumberOfCells(); ++cellId)
+    {
+    data->GetCellPoints(cellId, pts.GetPointer());
+    double weight = 1.0 / pts->GetNumberOfIds();
+    double expected = 0.0, expectedInt = 0.0;
+    for (vtkIdType i = 0; i < pts->GetNumberOfIds(); ++i)
+      {
+      expected += weight * pointScalars->GetTuple1(pts->GetId(i));
+      expectedInt += weight * pointInts->GetTuple1(pts->GetId(i));
+      }
+    if (!Same(expected, scalars->GetTuple1(cellId)) ||
+        ints->GetTuple1(cellId) != Round(expectedInt))
+      {
+      cerr << what << ": bad cell " << cellId << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int TestCellDataToPointDataParallel(int, char *[])
+{
+  vtkMath::RandomSeed(1234);
+  vtkNew<vtkUnstructuredGrid> grid;
+  BuildUnstructuredGrid(grid.GetPointer());
+  vtkNew<vtkPolyData> polyData;
+  BuildPolyData(polyData.GetPointer());
+
+  if (!CheckUnstructuredGrid(grid.GetPointer()) ||
+      !CheckPolyData(polyData.GetPointer()) ||
+      !CheckPointDataToCellData(grid.GetPointer(), "Unstructured grid") ||
+      !CheckPointDataToCellData(polyData.GetPointer(), "Polygonal data"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
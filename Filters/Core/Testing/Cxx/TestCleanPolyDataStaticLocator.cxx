@@ -0,0 +1,185 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCleanPolyDataStaticLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkCleanPolyData merges the points and converts the degenerate
+// cells the same way with UseStaticLocator on as with the default locator.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCleanPolyData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <cmath>
+
+namespace
+{
+
+const int Res = 60;
+
+// Appends a point near (x, y) and returns its id.
+vtkIdType AddPoint(vtkPoints *points, vtkDoubleArray *xs, double x, double y,
+                   double jitter)
+{
+  double p[3] = { x + vtkMath::Random(-jitter, jitter),
+                  y + vtkMath::Random(-jitter, jitter), 0.0 };
+  xs->InsertNextValue(p[0]);
+  return points->InsertNextPoint(p);
+}
+
+// A grid of quads that do not share their points, and a few cells that
+// degenerate once their points are merged with those of the grid.
+void BuildInput(vtkPolyData *input, double jitter)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataType(VTK_DOUBLE);
+  vtkNew<vtkDoubleArray> xs;
+  xs->SetName("X");
+  vtkNew<vtkCellArray> verts, lines, polys, strips;
+  vtkIdType ids[4];
+  for (int j = 0; j < Res; ++j)
+    {
+    for (int i = 0; i < Res; ++i)
+      {
+      ids[0] = AddPoint(points.GetPointer(), xs.GetPointer(), i, j, jitter);
+      ids[1] = AddPoint(points.GetPointer(), xs.GetPointer(), i+1, j, jitter);
+      ids[2] = AddPoint(points.GetPointer(), xs.GetPointer(), i+1, j+1,
+                        jitter);
+      ids[3] = AddPoint(points.GetPointer(), xs.GetPointer(), i, j+1, jitter);
+      polys->InsertNextCell(4, ids);
+      }
+    }
+  for (int k = 0; k < 4; ++k)
+    {
+    ids[k] = AddPoint(points.GetPointer(), xs.GetPointer(), 2, 2, jitter);
+    }
+  verts->InsertNextCell(2, ids);
+  lines->InsertNextCell(2, ids);
+  polys->InsertNextCell(4, ids);
+  polys->InsertNextCell(3, ids);
+  strips->InsertNextCell(4, ids);
+  ids[1] = AddPoint(points.GetPointer(), xs.GetPointer(), 3, 3, jitter);
+  ids[2] = AddPoint(points.GetPointer(), xs.GetPointer(), 3, 4, jitter);
+  polys->InsertNextCell(4, ids);
+  strips->InsertNextCell(4, ids);
+  lines->InsertNextCell(3, ids);
+
+  input->SetPoints(points.GetPointer());
+  input->GetPointData()->AddArray(xs.GetPointer());
+  input->SetVerts(verts.GetPointer());
+  input->SetLines(lines.GetPointer());
+  input->SetPolys(polys.GetPointer());
+  input->SetStrips(strips.GetPointer());
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+    {
+    cellIds->InsertNextValue(i);
+    }
+  input->GetCellData()->AddArray(cellIds.GetPointer());
+}
+
+// Compares the cells of the two outputs, which must be in the same order,
+// through the coordinates of their points.
+bool Compare(vtkPolyData *expected, vtkPolyData *output, double tol,
+             const char *what)
+{
+  if (expected->GetNumberOfPoints() != output->GetNumberOfPoints() ||
+      expected->GetNumberOfVerts() != output->GetNumberOfVerts() ||
+      expected->GetNumberOfLines() != output->GetNumberOfLines() ||
+      expected->GetNumberOfPolys() != output->GetNumberOfPolys() ||
+      expected->GetNumberOfStrips() != output->GetNumberOfStrips())
+    {
+    cerr << what << ": " << output->GetNumberOfPoints() << " points and "
+         << output->GetNumberOfVerts() << "/" << output->GetNumberOfLines()
+         << "/" << output->GetNumberOfPolys() << "/"
+         << output->GetNumberOfStrips() << " cells instead of "
+         << expected->GetNumberOfPoints() << " and "
+         << expected->GetNumberOfVerts() << "/"
+         << expected->GetNumberOfLines() << "/"
+         << expected->GetNumberOfPolys() << "/"
+         << expected->GetNumberOfStrips() << endl;
+    return false;
+    }
+
+  vtkDataArray *expectedIds = expected->GetCellData()->GetArray("CellIds");
+  vtkDataArray *outputIds = output->GetCellData()->GetArray("CellIds");
+  vtkDataArray *xs = output->GetPointData()->GetArray("X");
+  vtkNew<vtkIdList> expectedPts, outputPts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+    {
+    expected->GetCellPoints(cellId, expectedPts.GetPointer());
+    output->GetCellPoints(cellId, outputPts.GetPointer());
+    if (!outputIds || outputIds->GetTuple1(cellId) !=
+        expectedIds->GetTuple1(cellId) ||
+        expectedPts->GetNumberOfIds() != outputPts->GetNumberOfIds())
+      {
+      cerr << what << ": bad cell " << cellId << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < outputPts->GetNumberOfIds(); ++i)
+      {
+      double x[3], y[3];
+      expected->GetPoint(expectedPts->GetId(i), x);
+      output->GetPoint(outputPts->GetId(i), y);
+      if (sqrt(vtkMath::Distance2BetweenPoints(x, y)) > 2.0 * tol ||
+          !xs || xs->GetTuple1(outputPts->GetId(i)) != y[0])
+        {
+        cerr << what << ": bad point " << i << " in cell " << cellId
+             << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool Check(double jitter, double tol, const char *what)
+{
+  vtkNew<vtkPolyData> input;
+  BuildInput(input.GetPointer(), jitter);
+
+  vtkNew<vtkCleanPolyData> clean;
+  clean->SetInputData(input.GetPointer());
+  clean->ToleranceIsAbsoluteOn();
+  clean->SetAbsoluteTolerance(tol);
+  clean->Update();
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(clean->GetOutput());
+
+  clean->UseStaticLocatorOn();
+  clean->Update();
+  return expected->GetNumberOfPoints() == (Res + 1) * (Res + 1) &&
+    Compare(expected.GetPointer(), clean->GetOutput(), tol, what);
+}
+
+}
+
+int TestCleanPolyDataStaticLocator(int, char *[])
+{
+  vtkMath::RandomSeed(5678);
+  if (!Check(0.0, 0.0, "Coincident points") ||
+      !Check(0.01, 0.05, "Points within tolerance"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
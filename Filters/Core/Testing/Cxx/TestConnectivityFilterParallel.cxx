@@ -0,0 +1,302 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConnectivityFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkConnectivityFilter and vtkPolyDataConnectivityFilter
+// extract the same regions with LabelRegionsInParallel on as with the wave
+// front traversal, in all extraction modes, with and without scalar
+// connectivity. Points are compared through their input ids since their
+// order differs.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+namespace
+{
+
+const int Res = 100;
+
+// A grid of quads, inserted in random order so that connected cells have
+// distant ids, with a few isolated vertices, a line, a degenerate triangle
+// and an unused point. Scalars make several blobs.
+void BuildInput(vtkPolyData *input)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  for (int j = 0; j <= Res; ++j)
+    {
+    for (int i = 0; i <= Res; ++i)
+      {
+      points->InsertNextPoint(i, j, 0.0);
+      scalars->InsertNextValue(sin(0.21 * i) * cos(0.17 * j));
+      }
+    }
+  vtkIdType extra = points->InsertNextPoint(-5.0, -5.0, 0.0);
+  scalars->InsertNextValue(0.5);
+  vtkIdType unused = points->InsertNextPoint(-9.0, -9.0, 0.0);
+  scalars->InsertNextValue(0.5);
+  for (vtkIdType i = 0; i <= unused; ++i)
+    {
+    pointIds->InsertNextValue(i);
+    }
+
+  std::vector<int> order(Res * Res);
+  for (int i = 0; i < Res * Res; ++i)
+    {
+    order[i] = i;
+    }
+  for (int i = Res * Res - 1; i > 0; --i)
+    {
+    int k = static_cast<int>(vtkMath::Random(0.0, i + 1.0)) % (i + 1);
+    std::swap(order[i], order[k]);
+    }
+  vtkNew<vtkCellArray> verts, lines, polys;
+  for (int n = 0; n < Res * Res; ++n)
+    {
+    int i = order[n] % Res, j = order[n] / Res;
+    vtkIdType quad[4] = { i + j * (Res + 1), i + 1 + j * (Res + 1),
+                          i + 1 + (j + 1) * (Res + 1), i + (j + 1) * (Res + 1) };
+    polys->InsertNextCell(4, quad);
+    }
+  vtkIdType tri[3] = { extra, 0, extra };
+  polys->InsertNextCell(3, tri);
+  vtkIdType line[2] = { extra, Res };
+  lines->InsertNextCell(2, line);
+  for (vtkIdType i = 0; i < 5; ++i)
+    {
+    vtkIdType vert = i * 17 + 3;
+    verts->InsertNextCell(1, &vert);
+    }
+  verts->InsertNextCell(1, &extra);
+
+  input->SetPoints(points.GetPointer());
+  input->GetPointData()->SetScalars(scalars.GetPointer());
+  input->GetPointData()->AddArray(pointIds.GetPointer());
+  input->SetVerts(verts.GetPointer());
+  input->SetLines(lines.GetPointer());
+  input->SetPolys(polys.GetPointer());
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+    {
+    cellIds->InsertNextValue(i);
+    }
+  input->GetCellData()->AddArray(cellIds.GetPointer());
+}
+
+void BuildGrid(vtkPolyData *input, vtkUnstructuredGrid *grid)
+{
+  grid->SetPoints(input->GetPoints());
+  grid->GetPointData()->ShallowCopy(input->GetPointData());
+  grid->GetCellData()->ShallowCopy(input->GetCellData());
+  grid->Allocate(input->GetNumberOfCells());
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+    {
+    input->GetCellPoints(i, ptIds.GetPointer());
+    grid->InsertNextCell(input->GetCellType(i), ptIds.GetPointer());
+    }
+}
+
+// Compares the cells, through the input ids of their points, and the
+// region ids of the points and cells.
+bool Compare(vtkDataSet *expected, vtkDataSet *output, const char *what)
+{
+  if (expected->GetNumberOfPoints() != output->GetNumberOfPoints() ||
+      expected->GetNumberOfCells() != output->GetNumberOfCells())
+    {
+    cerr << what << ": " << output->GetNumberOfPoints() << " points and "
+         << output->GetNumberOfCells() << " cells instead of "
+         << expected->GetNumberOfPoints() << " and "
+         << expected->GetNumberOfCells() << endl;
+    return false;
+    }
+
+  vtkDataArray *expectedIds = expected->GetPointData()->GetArray("PointIds");
+  vtkDataArray *outputIds = output->GetPointData()->GetArray("PointIds");
+  vtkDataArray *expectedRegions = expected->GetPointData()->GetArray("RegionId");
+  vtkDataArray *outputRegions = output->GetPointData()->GetArray("RegionId");
+  std::map<vtkIdType, vtkIdType> regions;
+  for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); ++i)
+    {
+    regions[static_cast<vtkIdType>(expectedIds->GetTuple1(i))] =
+      static_cast<vtkIdType>(expectedRegions->GetTuple1(i));
+    }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    vtkIdType id = static_cast<vtkIdType>(outputIds->GetTuple1(i));
+    if ((i > 0 && id <= outputIds->GetTuple1(i - 1)) ||
+        regions.find(id) == regions.end() ||
+        regions[id] != outputRegions->GetTuple1(i))
+      {
+      cerr << what << ": bad point " << i << endl;
+      return false;
+      }
+    }
+
+  vtkDataArray *expectedCellIds = expected->GetCellData()->GetArray("CellIds");
+  vtkDataArray *outputCellIds = output->GetCellData()->GetArray("CellIds");
+  vtkNew<vtkIdList> expectedPts, outputPts;
+  for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+    {
+    expected->GetCellPoints(i, expectedPts.GetPointer());
+    output->GetCellPoints(i, outputPts.GetPointer());
+    bool same = expectedCellIds->GetTuple1(i) == outputCellIds->GetTuple1(i) &&
+      expectedPts->GetNumberOfIds() == outputPts->GetNumberOfIds();
+    for (vtkIdType j = 0; same && j < outputPts->GetNumberOfIds(); ++j)
+      {
+      same = expectedIds->GetTuple1(expectedPts->GetId(j)) ==
+        outputIds->GetTuple1(outputPts->GetId(j));
+      }
+    if (!same)
+      {
+      cerr << what << ": bad cell " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+bool SameSizes(vtkIdTypeArray *expected, vtkIdTypeArray *output,
+               const char *what)
+{
+  bool same = expected->GetNumberOfTuples() == output->GetNumberOfTuples();
+  for (vtkIdType i = 0; same && i < output->GetNumberOfTuples(); ++i)
+    {
+    same = expected->GetValue(i) == output->GetValue(i);
+    }
+  if (!same)
+    {
+    cerr << what << ": different region sizes" << endl;
+    }
+  return same;
+}
+
+// Sets up extraction mode of filter, a vtkConnectivityFilter or a
+// vtkPolyDataConnectivityFilter.
+template <class T>
+void SetMode(T *filter, int mode, bool scalars)
+{
+  filter->SetExtractionMode(mode);
+  filter->ColorRegionsOn();
+  filter->SetScalarConnectivity(scalars);
+  filter->SetScalarRange(-0.2, 0.6);
+  filter->InitializeSeedList();
+  filter->InitializeSpecifiedRegionList();
+  if (mode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
+    {
+    filter->AddSeed(0);
+    filter->AddSeed(Res * (Res + 1) / 2);
+    }
+  else if (mode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
+    {
+    filter->AddSeed(7);
+    filter->AddSeed(Res * Res);
+    filter->AddSeed(Res * Res / 3);
+    }
+  filter->AddSpecifiedRegion(0);
+  filter->AddSpecifiedRegion(2);
+  filter->AddSpecifiedRegion(5);
+  filter->SetClosestPoint(Res / 2.0, Res / 3.0, 0.0);
+}
+
+template <class T, class D>
+bool Check(T *filter, D *input, int mode, bool scalars, const char *what)
+{
+  filter->SetInputData(input);
+  SetMode(filter, mode, scalars);
+  filter->LabelRegionsInParallelOff();
+  filter->Update();
+  vtkNew<D> expected;
+  expected->DeepCopy(filter->GetOutput());
+  vtkNew<vtkIdTypeArray> expectedSizes;
+  expectedSizes->DeepCopy(filter->GetRegionSizes());
+
+  filter->LabelRegionsInParallelOn();
+  filter->Update();
+  if (!Compare(expected.GetPointer(), filter->GetOutput(), what) ||
+      !SameSizes(expectedSizes.GetPointer(), filter->GetRegionSizes(), what))
+    {
+    cerr << "  in mode " << filter->GetExtractionModeAsString()
+         << (scalars ? " with scalar connectivity" : "") << endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+// vtkConnectivityFilter does not expose its region sizes.
+class vtkTestConnectivityFilter : public vtkConnectivityFilter
+{
+public:
+  static vtkTestConnectivityFilter *New();
+  vtkTypeMacro(vtkTestConnectivityFilter, vtkConnectivityFilter);
+  vtkIdTypeArray *GetRegionSizes() { return this->RegionSizes; }
+};
+vtkStandardNewMacro(vtkTestConnectivityFilter);
+
+int TestConnectivityFilterParallel(int, char *[])
+{
+  vtkMath::RandomSeed(1234);
+  vtkNew<vtkPolyData> polyData;
+  BuildInput(polyData.GetPointer());
+  vtkNew<vtkUnstructuredGrid> grid;
+  BuildGrid(polyData.GetPointer(), grid.GetPointer());
+
+  vtkNew<vtkTestConnectivityFilter> connectivity;
+  vtkNew<vtkPolyDataConnectivityFilter> polyConnectivity;
+  for (int mode = VTK_EXTRACT_POINT_SEEDED_REGIONS;
+       mode <= VTK_EXTRACT_CLOSEST_POINT_REGION; ++mode)
+    {
+    for (int scalars = 0; scalars < 2; ++scalars)
+      {
+      polyConnectivity->FullScalarConnectivityOff();
+      if (!Check(connectivity.GetPointer(), grid.GetPointer(), mode,
+                 scalars != 0, "vtkConnectivityFilter") ||
+          !Check(polyConnectivity.GetPointer(), polyData.GetPointer(), mode,
+                 scalars != 0, "vtkPolyDataConnectivityFilter"))
+        {
+        return EXIT_FAILURE;
+        }
+      polyConnectivity->FullScalarConnectivityOn();
+      if (scalars && !Check(polyConnectivity.GetPointer(),
+                            polyData.GetPointer(), mode, true,
+                            "Full scalar connectivity"))
+        {
+        return EXIT_FAILURE;
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,183 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestContourFilterParallelDispatch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkContourFilter and vtkCutter produce the same surfaces, with
+// the same point arrays, with UseParallelAlgorithms on as with it off, on
+// image data, rectilinear grids and structured grids.
+
+#include "vtkContourFilter.h"
+#include "vtkCutter.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkMassProperties.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTriangleFilter.h"
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+
+double SurfaceArea(vtkPolyData *surface)
+{
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputData(surface);
+  vtkNew<vtkMassProperties> properties;
+  properties->SetInputConnection(triangles->GetOutputPort());
+  properties->Update();
+  return properties->GetSurfaceArea();
+}
+
+bool SameSurfaces(vtkPolyData *expected, vtkPolyData *output,
+                  const char *what)
+{
+  if (expected->GetNumberOfPolys() == 0 ||
+      expected->GetNumberOfPoints() != output->GetNumberOfPoints())
+    {
+    cerr << what << ": different number of points" << endl;
+    return false;
+    }
+  double bounds[6], outBounds[6];
+  expected->GetBounds(bounds);
+  output->GetBounds(outBounds);
+  for (int i = 0; i < 6; ++i)
+    {
+    if (std::abs(bounds[i] - outBounds[i]) > 1.0e-4)
+      {
+      cerr << what << ": different bounds" << endl;
+      return false;
+      }
+    }
+  double area = SurfaceArea(expected);
+  if (std::abs(area - SurfaceArea(output)) > 1.0e-4 * area)
+    {
+    cerr << what << ": different area" << endl;
+    return false;
+    }
+  vtkPointData *pd = expected->GetPointData();
+  vtkPointData *outPD = output->GetPointData();
+  for (int i = 0; i < pd->GetNumberOfArrays(); ++i)
+    {
+    const char *name = pd->GetArrayName(i);
+    if (name && std::string(name) != "cutScalars" && !outPD->GetArray(name))
+      {
+      cerr << what << ": missing array " << name << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+template <class T>
+bool Check(T *filter, const char *what)
+{
+  filter->UseParallelAlgorithmsOff();
+  filter->Update();
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(filter->GetOutput());
+
+  filter->UseParallelAlgorithmsOn();
+  filter->Update();
+  return SameSurfaces(expected.GetPointer(), filter->GetOutput(), what);
+}
+
+bool CheckInput(vtkDataSet *input, const char *what)
+{
+  vtkNew<vtkContourFilter> contour;
+  contour->SetInputData(input);
+  contour->GenerateValues(3, 120.0, 220.0);
+  if (!Check(contour.GetPointer(), what))
+    {
+    return false;
+    }
+
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.3, -0.2, 0.1);
+  plane->SetNormal(1.0, 2.0, -0.5);
+  vtkNew<vtkCutter> cutter;
+  cutter->SetInputData(input);
+  cutter->SetCutFunction(plane.GetPointer());
+  cutter->SetValue(0, 1.5);
+  return Check(cutter.GetPointer(), what);
+}
+
+}
+
+int TestContourFilterParallelDispatch(int, char *[])
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-12, 12, -12, 12, -12, 12);
+  wavelet->Update();
+  vtkImageData *image = wavelet->GetOutput();
+  if (!CheckInput(image, "Image data"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Grids with the same points and an extra point array to interpolate.
+  int *ext = image->GetExtent();
+  vtkNew<vtkDoubleArray> extra;
+  extra->SetName("Extra");
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    double *x = image->GetPoint(i);
+    extra->InsertNextValue(x[0] * x[1] - x[2]);
+    }
+
+  vtkNew<vtkRectilinearGrid> rgrid;
+  rgrid->SetExtent(ext);
+  vtkNew<vtkDoubleArray> coords[3];
+  for (int i = 0; i < 3; ++i)
+    {
+    for (int j = ext[2*i]; j <= ext[2*i+1]; ++j)
+      {
+      coords[i]->InsertNextValue(j);
+      }
+    }
+  rgrid->SetXCoordinates(coords[0].GetPointer());
+  rgrid->SetYCoordinates(coords[1].GetPointer());
+  rgrid->SetZCoordinates(coords[2].GetPointer());
+  rgrid->GetPointData()->SetScalars(image->GetPointData()->GetScalars());
+  rgrid->GetPointData()->AddArray(extra.GetPointer());
+  if (!CheckInput(rgrid.GetPointer(), "Rectilinear grid"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkStructuredGrid> sgrid;
+  sgrid->SetExtent(ext);
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    points->SetPoint(i, image->GetPoint(i));
+    }
+  sgrid->SetPoints(points.GetPointer());
+  sgrid->GetPointData()->SetScalars(image->GetPointData()->GetScalars());
+  sgrid->GetPointData()->AddArray(extra.GetPointer());
+  if (!CheckInput(sgrid.GetPointer(), "Structured grid"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -103,6 +103,55 @@ bool TestUnstructured()
   return true;
 }
 
+bool TestUnstructuredScalarTree()
+{
+  vtkSmartPointer<vtkRTAnalyticSource> imageSource = vtkSmartPointer<vtkRTAnalyticSource>::New();
+  imageSource->SetWholeExtent(-4,4,-4,4,-4,4);
+
+  vtkSmartPointer<vtkDataSetTriangleFilter> tetraFilter = vtkSmartPointer<vtkDataSetTriangleFilter>::New();
+  tetraFilter->SetInputConnection(imageSource->GetOutputPort());
+
+  vtkSmartPointer<vtkPlane> p3d = vtkSmartPointer<vtkPlane>::New();
+  p3d->SetOrigin(0,0,0);
+  p3d->SetNormal(1,1,1);
+
+  vtkSmartPointer<vtkCutter> reference = vtkSmartPointer<vtkCutter>::New();
+  reference->SetCutFunction(p3d);
+  reference->SetInputConnection(0, tetraFilter->GetOutputPort());
+
+  vtkSmartPointer<vtkCutter> cutter = vtkSmartPointer<vtkCutter>::New();
+  cutter->SetCutFunction(p3d);
+  cutter->SetInputConnection(0, tetraFilter->GetOutputPort());
+  cutter->UseScalarTreeOn();
+
+  // Change the cut values, then the cut function; the scalar tree must
+  // follow both.
+  for(int i=0; i<4; i++)
+    {
+    if(i==3)
+      {
+      p3d->SetNormal(1,0,0);
+      }
+    double value = -2.0 + i;
+    reference->SetValue(0, value);
+    reference->SetValue(1, value + 0.5);
+    cutter->SetValue(0, value);
+    cutter->SetValue(1, value + 0.5);
+    reference->Update();
+    cutter->Update();
+    if(!cutter->GetScalarTree() ||
+       cutter->GetOutput()->GetNumberOfCells() == 0 ||
+       cutter->GetOutput()->GetNumberOfCells() !=
+       reference->GetOutput()->GetNumberOfCells() ||
+       cutter->GetOutput()->GetNumberOfPoints() !=
+       reference->GetOutput()->GetNumberOfPoints())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
 int TestCutter(int, char *[])
 {
   for(int type=0; type<2; type++)
@@ -120,5 +169,11 @@ int TestCutter(int, char *[])
     return EXIT_FAILURE;
     }
 
+  if(!TestUnstructuredScalarTree())
+    {
+    cerr<<"Cutting Unstructured with a scalar tree failed"<<endl;
+    return EXIT_FAILURE;
+    }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,138 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelaunaySpatialInsertionOrder.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkDelaunay3D and vtkDelaunay2D triangulate random points the
+// same way with SpatialInsertionOrder on as in input order: the Delaunay
+// triangulation of points in general position is unique, so the number of
+// cells and their total size must match.
+
+#include "vtkCellArray.h"
+#include "vtkDelaunay2D.h"
+#include "vtkDelaunay3D.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTetra.h"
+#include "vtkTriangle.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+
+double TotalVolume(vtkUnstructuredGrid *grid)
+{
+  double volume = 0.0;
+  double p[4][3];
+  vtkIdType npts, *pts;
+  vtkCellArray *cells = grid->GetCells();
+  for (cells->InitTraversal(); cells->GetNextCell(npts, pts); )
+    {
+    for (int i = 0; i < 4; ++i)
+      {
+      grid->GetPoint(pts[i], p[i]);
+      }
+    volume += fabs(vtkTetra::ComputeVolume(p[0], p[1], p[2], p[3]));
+    }
+  return volume;
+}
+
+double TotalArea(vtkPolyData *polyData)
+{
+  double area = 0.0;
+  double p[3][3];
+  vtkIdType npts, *pts;
+  vtkCellArray *polys = polyData->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); )
+    {
+    for (int i = 0; i < 3; ++i)
+      {
+      polyData->GetPoint(pts[i], p[i]);
+      }
+    area += vtkTriangle::TriangleArea(p[0], p[1], p[2]);
+    }
+  return area;
+}
+
+bool Check(vtkIdType numCells, double size, vtkIdType expectedCells,
+           double expectedSize, const char *what)
+{
+  if (expectedCells == 0 || numCells != expectedCells ||
+      fabs(size - expectedSize) > 1e-9 * expectedSize)
+    {
+    cerr << what << ": " << numCells << " cells of total size " << size
+         << " instead of " << expectedCells << " cells of total size "
+         << expectedSize << endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+int TestDelaunaySpatialInsertionOrder(int, char *[])
+{
+  vtkMath::RandomSeed(1234);
+  vtkNew<vtkPoints> points3D, points2D;
+  for (int i = 0; i < 5000; ++i)
+    {
+    points3D->InsertNextPoint(vtkMath::Random(-1.0, 1.0),
+                              vtkMath::Random(-1.0, 1.0),
+                              vtkMath::Random(-1.0, 1.0));
+    }
+  for (int i = 0; i < 20000; ++i)
+    {
+    points2D->InsertNextPoint(vtkMath::Random(-1.0, 1.0),
+                              vtkMath::Random(-1.0, 1.0), 0.0);
+    }
+
+  vtkNew<vtkPolyData> input3D;
+  input3D->SetPoints(points3D.GetPointer());
+  vtkNew<vtkDelaunay3D> delaunay3D;
+  delaunay3D->SetInputData(input3D.GetPointer());
+  delaunay3D->SetTolerance(0.0);
+  delaunay3D->Update();
+  vtkIdType expectedTetras = delaunay3D->GetOutput()->GetNumberOfCells();
+  double expectedVolume = TotalVolume(delaunay3D->GetOutput());
+
+  delaunay3D->SpatialInsertionOrderOn();
+  delaunay3D->Update();
+  if (!Check(delaunay3D->GetOutput()->GetNumberOfCells(),
+             TotalVolume(delaunay3D->GetOutput()), expectedTetras,
+             expectedVolume, "vtkDelaunay3D"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkPolyData> input2D;
+  input2D->SetPoints(points2D.GetPointer());
+  vtkNew<vtkDelaunay2D> delaunay2D;
+  delaunay2D->SetInputData(input2D.GetPointer());
+  delaunay2D->SetTolerance(0.0);
+  delaunay2D->Update();
+  vtkIdType expectedTriangles = delaunay2D->GetOutput()->GetNumberOfPolys();
+  double expectedArea = TotalArea(delaunay2D->GetOutput());
+
+  delaunay2D->SpatialInsertionOrderOn();
+  delaunay2D->Update();
+  if (!Check(delaunay2D->GetOutput()->GetNumberOfPolys(),
+             TotalArea(delaunay2D->GetOutput()), expectedTriangles,
+             expectedArea, "vtkDelaunay2D"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestFlyingEdgesSingleSweep.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkFlyingEdges3D produces exactly the same points, triangles,
+// scalars, normals and gradients with SingleSweep on as with it off, for
+// several contour values over a sub-extent of a wavelet.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkFlyingEdges3D.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+
+namespace
+{
+
+bool SameArrays(vtkDataArray *expected, vtkDataArray *output,
+                const char *what)
+{
+  if (!expected || !output ||
+      expected->GetNumberOfTuples() != output->GetNumberOfTuples() ||
+      expected->GetNumberOfComponents() != output->GetNumberOfComponents())
+    {
+    cerr << what << ": different arrays" << endl;
+    return false;
+    }
+  int numComps = output->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < output->GetNumberOfTuples(); ++i)
+    {
+    for (int j = 0; j < numComps; ++j)
+      {
+      if (expected->GetComponent(i, j) != output->GetComponent(i, j))
+        {
+        cerr << what << ": different value at tuple " << i << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool SameOutputs(vtkPolyData *expected, vtkPolyData *output)
+{
+  if (expected->GetNumberOfPolys() == 0 ||
+      expected->GetNumberOfPolys() != output->GetNumberOfPolys())
+    {
+    cerr << "Different number of triangles" << endl;
+    return false;
+    }
+  vtkIdType npts, *pts, outNpts, *outPts;
+  vtkCellArray *polys = expected->GetPolys();
+  vtkCellArray *outPolys = output->GetPolys();
+  for (polys->InitTraversal(), outPolys->InitTraversal();
+       polys->GetNextCell(npts, pts) && outPolys->GetNextCell(outNpts, outPts);)
+    {
+    if (npts != 3 || outNpts != 3 || pts[0] != outPts[0] ||
+        pts[1] != outPts[1] || pts[2] != outPts[2])
+      {
+      cerr << "Different triangles" << endl;
+      return false;
+      }
+    }
+  vtkPointData *pd = expected->GetPointData();
+  vtkPointData *outPD = output->GetPointData();
+  return SameArrays(expected->GetPoints()->GetData(),
+                    output->GetPoints()->GetData(), "Points") &&
+    SameArrays(pd->GetScalars(), outPD->GetScalars(), "Scalars") &&
+    SameArrays(pd->GetNormals(), outPD->GetNormals(), "Normals") &&
+    SameArrays(pd->GetArray("Gradients"), outPD->GetArray("Gradients"),
+               "Gradients");
+}
+
+}
+
+int TestFlyingEdgesSingleSweep(int, char *[])
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-30, 31, -25, 33, -28, 29);
+  wavelet->SetCenter(0.0, 0.0, 0.0);
+
+  vtkNew<vtkFlyingEdges3D> flyingEdges;
+  flyingEdges->SetInputConnection(wavelet->GetOutputPort());
+  flyingEdges->GenerateValues(10, 90.0, 250.0);
+  flyingEdges->ComputeNormalsOn();
+  flyingEdges->ComputeGradientsOn();
+  flyingEdges->ComputeScalarsOn();
+  int extent[6] = { -20, 31, -25, 20, -10, 29 };
+  flyingEdges->UpdateExtent(extent);
+
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(flyingEdges->GetOutput());
+
+  flyingEdges->SingleSweepOn();
+  flyingEdges->UpdateExtent(extent);
+  if (!SameOutputs(expected.GetPointer(), flyingEdges->GetOutput()))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,276 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGlyph3DOutput.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the points, normals, cells and attributes of the glyphs of
+// vtkGlyph3D against glyphs transformed with vtkTransform.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkGlyph3D.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTransform.h"
+
+#include <cmath>
+
+namespace
+{
+
+const vtkIdType NumberOfPoints = 3000;
+
+// Random points, with vectors of which some are along x and some are null.
+void BuildInput(vtkPolyData *input)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Ids");
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+    {
+    points->InsertNextPoint(vtkMath::Random(-10.0, 10.0),
+                            vtkMath::Random(-10.0, 10.0),
+                            vtkMath::Random(-10.0, 10.0));
+    double v[3] = { vtkMath::Random(-1.0, 1.0), vtkMath::Random(-1.0, 1.0),
+                    vtkMath::Random(-1.0, 1.0) };
+    if (i % 7 == 0)
+      {
+      v[1] = v[2] = 0.0;
+      }
+    else if (i % 11 == 0)
+      {
+      v[0] = v[1] = v[2] = 0.0;
+      }
+    vectors->InsertNextTuple(v);
+    scalars->InsertNextValue(vtkMath::Random(0.1, 1.0));
+    ids->InsertNextValue(i);
+    }
+  input->SetPoints(points.GetPointer());
+  input->GetPointData()->SetVectors(vectors.GetPointer());
+  input->GetPointData()->SetScalars(scalars.GetPointer());
+  input->GetPointData()->AddArray(ids.GetPointer());
+}
+
+// Transforms the points and normals of source as glyph of input point
+// inPtId, as documented.
+void ExpectedGlyph(vtkPolyData *input, vtkIdType inPtId, vtkPolyData *source,
+                   double scaleFactor, vtkTransform *sourceTransform,
+                   vtkPoints *points, vtkDoubleArray *normals)
+{
+  double x[3], v[3];
+  input->GetPoint(inPtId, x);
+  input->GetPointData()->GetVectors()->GetTuple(inPtId, v);
+  double s = input->GetPointData()->GetScalars()->GetTuple1(inPtId);
+  double vMag = vtkMath::Norm(v);
+
+  vtkNew<vtkTransform> trans;
+  trans->Translate(x);
+  if (vMag > 0.0)
+    {
+    if (v[1] == 0.0 && v[2] == 0.0)
+      {
+      if (v[0] < 0.0)
+        {
+        trans->RotateWXYZ(180.0, 0, 1, 0);
+        }
+      }
+    else
+      {
+      trans->RotateWXYZ(180.0, (v[0] + vMag) / 2.0, v[1] / 2.0, v[2] / 2.0);
+      }
+    }
+  trans->Scale(s * scaleFactor, s * scaleFactor, s * scaleFactor);
+
+  points->Reset();
+  normals->Reset();
+  vtkNew<vtkPoints> sourcePoints;
+  sourceTransform->TransformPoints(source->GetPoints(),
+                                   sourcePoints.GetPointer());
+  trans->TransformPoints(sourcePoints.GetPointer(), points);
+  trans->TransformNormals(source->GetPointData()->GetNormals(), normals);
+}
+
+bool CheckGlyphs(vtkPolyData *input, vtkPolyData *source,
+                 vtkTransform *sourceTransform, vtkPolyData *output)
+{
+  vtkIdType numSourcePts = source->GetNumberOfPoints();
+  vtkIdType numSourceCells = source->GetNumberOfCells();
+  if (output->GetNumberOfPoints() != NumberOfPoints * numSourcePts ||
+      output->GetNumberOfPolys() != NumberOfPoints * numSourceCells)
+    {
+    cerr << "Glyphs: " << output->GetNumberOfPoints() << " points and "
+         << output->GetNumberOfPolys() << " polygons" << endl;
+    return false;
+    }
+
+  vtkDataArray *normals = output->GetPointData()->GetNormals();
+  vtkDataArray *pointIds =
+    output->GetPointData()->GetArray("InputPointIds");
+  vtkDataArray *ids = output->GetPointData()->GetArray("Ids");
+  vtkDataArray *cellIds = output->GetCellData()->GetArray("Ids");
+  vtkDataArray *scalars = output->GetPointData()->GetScalars();
+  vtkDataArray *vectors = output->GetPointData()->GetVectors();
+  if (!normals || !pointIds || !ids || !cellIds || !scalars || !vectors)
+    {
+    cerr << "Glyphs: missing attributes" << endl;
+    return false;
+    }
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> expectedNormals;
+  expectedNormals->SetNumberOfComponents(3);
+  vtkNew<vtkIdList> sourceCell, cell;
+  for (vtkIdType inPtId = 0; inPtId < NumberOfPoints; inPtId += 13)
+    {
+    ExpectedGlyph(input, inPtId, source, 0.5, sourceTransform,
+                  points.GetPointer(), expectedNormals.GetPointer());
+    double s = input->GetPointData()->GetScalars()->GetTuple1(inPtId);
+    double v[3];
+    input->GetPointData()->GetVectors()->GetTuple(inPtId, v);
+    for (vtkIdType i = 0; i < numSourcePts; ++i)
+      {
+      vtkIdType ptId = inPtId * numSourcePts + i;
+      double x[3], y[3], n[3], m[3], w[3];
+      points->GetPoint(i, x);
+      output->GetPoint(ptId, y);
+      expectedNormals->GetTuple(i, n);
+      normals->GetTuple(ptId, m);
+      vectors->GetTuple(ptId, w);
+      if (vtkMath::Distance2BetweenPoints(x, y) > 1e-8 ||
+          vtkMath::Distance2BetweenPoints(n, m) > 1e-8 ||
+          vtkMath::Distance2BetweenPoints(v, w) > 1e-12 ||
+          fabs(scalars->GetTuple1(ptId) - s) > 1e-6 ||
+          pointIds->GetTuple1(ptId) != inPtId ||
+          ids->GetTuple1(ptId) != inPtId)
+        {
+        cerr << "Glyphs: bad point " << i << " of glyph " << inPtId << endl;
+        return false;
+        }
+      }
+    for (vtkIdType i = 0; i < numSourceCells; ++i)
+      {
+      vtkIdType cellId = inPtId * numSourceCells + i;
+      source->GetCellPoints(i, sourceCell.GetPointer());
+      output->GetCellPoints(cellId, cell.GetPointer());
+      bool same = cell->GetNumberOfIds() == sourceCell->GetNumberOfIds() &&
+        cellIds->GetTuple1(cellId) == inPtId;
+      for (vtkIdType j = 0; same && j < cell->GetNumberOfIds(); ++j)
+        {
+        same = cell->GetId(j) == sourceCell->GetId(j) + inPtId * numSourcePts;
+        }
+      if (!same)
+        {
+        cerr << "Glyphs: bad cell " << i << " of glyph " << inPtId << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+// Indexes two sources with the scalars: each glyph must come from the
+// source of its scalar.
+bool CheckIndexing(vtkPolyData *input)
+{
+  vtkNew<vtkSphereSource> coarse, fine;
+  coarse->SetThetaResolution(4);
+  coarse->SetPhiResolution(3);
+  fine->SetThetaResolution(12);
+  fine->SetPhiResolution(8);
+
+  vtkNew<vtkGlyph3D> glyph;
+  glyph->SetInputData(input);
+  glyph->SetSourceConnection(0, coarse->GetOutputPort());
+  glyph->SetSourceConnection(1, fine->GetOutputPort());
+  glyph->SetIndexModeToScalar();
+  glyph->SetRange(0.0, 1.0);
+  glyph->GeneratePointIdsOn();
+  glyph->Update();
+  coarse->Update();
+  fine->Update();
+
+  vtkPolyData *output = glyph->GetOutput();
+  vtkDataArray *pointIds = output->GetPointData()->GetArray("InputPointIds");
+  vtkDataArray *scalars = input->GetPointData()->GetScalars();
+  vtkIdType ptId = 0, cellId = 0;
+  for (vtkIdType inPtId = 0; inPtId < NumberOfPoints; ++inPtId)
+    {
+    vtkPolyData *source = scalars->GetTuple1(inPtId) < 0.5 ?
+      coarse->GetOutput() : fine->GetOutput();
+    for (vtkIdType i = 0; i < source->GetNumberOfPoints(); ++i, ++ptId)
+      {
+      if (!pointIds || ptId >= output->GetNumberOfPoints() ||
+          pointIds->GetTuple1(ptId) != inPtId)
+        {
+        cerr << "Indexing: bad point " << ptId << endl;
+        return false;
+        }
+      }
+    cellId += source->GetNumberOfCells();
+    }
+  if (ptId != output->GetNumberOfPoints() ||
+      cellId != output->GetNumberOfPolys() ||
+      output->GetPointData()->GetNormals()->GetNumberOfTuples() != ptId)
+    {
+    cerr << "Indexing: " << output->GetNumberOfPoints() << " points and "
+         << output->GetNumberOfPolys() << " polygons instead of " << ptId
+         << " and " << cellId << endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+int TestGlyph3DOutput(int, char *[])
+{
+  vtkMath::RandomSeed(4321);
+  vtkNew<vtkPolyData> input;
+  BuildInput(input.GetPointer());
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(8);
+  sphere->SetPhiResolution(6);
+  sphere->Update();
+
+  vtkNew<vtkTransform> sourceTransform;
+  sourceTransform->Translate(0.5, 0.0, 0.0);
+  sourceTransform->Scale(2.0, 1.0, 1.0);
+
+  vtkNew<vtkGlyph3D> glyph;
+  glyph->SetInputData(input.GetPointer());
+  glyph->SetSourceConnection(sphere->GetOutputPort());
+  glyph->SetSourceTransform(sourceTransform.GetPointer());
+  glyph->SetScaleFactor(0.5);
+  glyph->GeneratePointIdsOn();
+  glyph->FillCellDataOn();
+  glyph->Update();
+  if (!CheckGlyphs(input.GetPointer(), sphere->GetOutput(),
+                   sourceTransform.GetPointer(), glyph->GetOutput()) ||
+      !CheckIndexing(input.GetPointer()))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,301 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGridFlyingEdges.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test vtkGridFlyingEdges3D and vtkGridFlyingEdgesPlaneCutter. On grids
+// with the points of a wavelet image, the contours must match those of
+// vtkFlyingEdges3D. On a stretched rectilinear grid and a sheared
+// structured grid, the contours of a linear field must lie on planes and
+// have its gradient, and the cut must lie on the plane and interpolate the
+// attributes.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFlyingEdges3D.h"
+#include "vtkGridFlyingEdges3D.h"
+#include "vtkGridFlyingEdgesPlaneCutter.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkStructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+
+const int Res = 12;
+
+bool CloseArrays(vtkDataArray *expected, vtkDataArray *output,
+                 double tolerance, const char *what)
+{
+  if (!expected || !output ||
+      expected->GetNumberOfTuples() != output->GetNumberOfTuples() ||
+      expected->GetNumberOfComponents() != output->GetNumberOfComponents())
+    {
+    cerr << what << ": different arrays" << endl;
+    return false;
+    }
+  int numComps = output->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < output->GetNumberOfTuples(); ++i)
+    {
+    for (int j = 0; j < numComps; ++j)
+      {
+      if (std::abs(expected->GetComponent(i, j) -
+                   output->GetComponent(i, j)) > tolerance)
+        {
+        cerr << what << ": different value at tuple " << i << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool SameContours(vtkPolyData *expected, vtkPolyData *output,
+                  const char *what)
+{
+  if (expected->GetNumberOfPolys() == 0 ||
+      expected->GetNumberOfPolys() != output->GetNumberOfPolys())
+    {
+    cerr << what << ": different number of triangles" << endl;
+    return false;
+    }
+  vtkIdType npts, *pts, outNpts, *outPts;
+  vtkCellArray *polys = expected->GetPolys();
+  vtkCellArray *outPolys = output->GetPolys();
+  for (polys->InitTraversal(), outPolys->InitTraversal();
+       polys->GetNextCell(npts, pts) && outPolys->GetNextCell(outNpts, outPts);)
+    {
+    if (npts != outNpts || pts[0] != outPts[0] || pts[1] != outPts[1] ||
+        pts[2] != outPts[2])
+      {
+      cerr << what << ": different triangles" << endl;
+      return false;
+      }
+    }
+  vtkPointData *pd = expected->GetPointData();
+  vtkPointData *outPD = output->GetPointData();
+  return CloseArrays(expected->GetPoints()->GetData(),
+                     output->GetPoints()->GetData(), 1.0e-4, what) &&
+    CloseArrays(pd->GetScalars(), outPD->GetScalars(), 0.0, what) &&
+    CloseArrays(pd->GetNormals(), outPD->GetNormals(), 1.0e-4, what);
+}
+
+// Contours rectilinear and structured grids with the points and scalars of
+// a wavelet, and compares to the contours of the wavelet.
+bool TestWavelet()
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-Res, Res, -Res, Res, -Res, Res);
+  wavelet->Update();
+  vtkImageData *image = wavelet->GetOutput();
+  int *ext = image->GetExtent();
+
+  vtkNew<vtkRectilinearGrid> rgrid;
+  rgrid->SetExtent(ext);
+  vtkNew<vtkDoubleArray> coords[3];
+  for (int i = 0; i < 3; ++i)
+    {
+    for (int j = ext[2*i]; j <= ext[2*i+1]; ++j)
+      {
+      coords[i]->InsertNextValue(j);
+      }
+    }
+  rgrid->SetXCoordinates(coords[0].GetPointer());
+  rgrid->SetYCoordinates(coords[1].GetPointer());
+  rgrid->SetZCoordinates(coords[2].GetPointer());
+  rgrid->GetPointData()->SetScalars(image->GetPointData()->GetScalars());
+
+  vtkNew<vtkStructuredGrid> sgrid;
+  sgrid->SetExtent(ext);
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    points->SetPoint(i, image->GetPoint(i));
+    }
+  sgrid->SetPoints(points.GetPointer());
+  sgrid->GetPointData()->SetScalars(image->GetPointData()->GetScalars());
+
+  vtkNew<vtkFlyingEdges3D> expected;
+  expected->SetInputData(image);
+  expected->GenerateValues(4, 100.0, 250.0);
+  expected->Update();
+
+  vtkNew<vtkGridFlyingEdges3D> contour;
+  contour->GenerateValues(4, 100.0, 250.0);
+  contour->SetInputData(rgrid.GetPointer());
+  contour->Update();
+  if (!SameContours(expected->GetOutput(), contour->GetOutput(),
+                    "Rectilinear grid"))
+    {
+    return false;
+    }
+  contour->SetInputData(sgrid.GetPointer());
+  contour->Update();
+  return SameContours(expected->GetOutput(), contour->GetOutput(),
+                      "Structured grid");
+}
+
+// Fills the point data of grid with the linear field a.x, which is the
+// contoured array and also an attribute to interpolate.
+void AddLinearField(vtkDataSet *grid, const double a[3])
+{
+  vtkNew<vtkDoubleArray> field, attribute;
+  field->SetName("Field");
+  attribute->SetName("Attribute");
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+    {
+    double *x = grid->GetPoint(i);
+    field->InsertNextValue(vtkMath::Dot(a, x));
+    attribute->InsertNextValue(vtkMath::Dot(a, x));
+    }
+  grid->GetPointData()->SetScalars(field.GetPointer());
+  grid->GetPointData()->AddArray(attribute.GetPointer());
+}
+
+// Checks that the contours of the linear field a.x lie on the planes
+// a.x = value and have the gradient a and the interpolated attribute.
+bool CheckLinearContours(vtkDataSet *grid, const double a[3],
+                         const char *what)
+{
+  vtkNew<vtkGridFlyingEdges3D> contour;
+  contour->SetInputData(grid);
+  contour->GenerateValues(3, -2.0, 2.0);
+  contour->ComputeGradientsOn();
+  contour->InterpolateAttributesOn();
+  contour->Update();
+  vtkPolyData *output = contour->GetOutput();
+  vtkDataArray *scalars = output->GetPointData()->GetScalars();
+  vtkDataArray *gradients = output->GetPointData()->GetArray("Gradients");
+  vtkDataArray *attribute = output->GetPointData()->GetArray("Attribute");
+  if (output->GetNumberOfPolys() == 0 || !scalars || !gradients ||
+      !attribute || output->GetPointData()->GetArray("Field") != scalars)
+    {
+    cerr << what << ": missing output" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    double *x = output->GetPoint(i);
+    double value = scalars->GetComponent(i, 0);
+    double *g = gradients->GetTuple3(i);
+    if (std::abs(vtkMath::Dot(a, x) - value) > 1.0e-4 ||
+        std::abs(attribute->GetComponent(i, 0) - value) > 1.0e-4 ||
+        std::abs(g[0] - a[0]) > 1.0e-4 || std::abs(g[1] - a[1]) > 1.0e-4 ||
+        std::abs(g[2] - a[2]) > 1.0e-4)
+      {
+      cerr << what << ": wrong contour point " << i << endl;
+      return false;
+      }
+    }
+
+  // Cut with the plane a.x = 1.
+  vtkNew<vtkPlane> plane;
+  plane->SetNormal(a[0], a[1], a[2]);
+  double norm = vtkMath::Norm(a);
+  plane->SetOrigin(a[0] / (norm * norm), a[1] / (norm * norm),
+                   a[2] / (norm * norm));
+  vtkNew<vtkGridFlyingEdgesPlaneCutter> cutter;
+  cutter->SetInputData(grid);
+  cutter->SetPlane(plane.GetPointer());
+  cutter->ComputeNormalsOn();
+  cutter->Update();
+  output = cutter->GetOutput();
+  attribute = output->GetPointData()->GetArray("Attribute");
+  if (output->GetNumberOfPolys() == 0 || !attribute ||
+      !output->GetPointData()->GetNormals() ||
+      output->GetPointData()->GetArray("vtkGridFlyingEdgesPlaneCutterDistance"))
+    {
+    cerr << what << ": wrong cut arrays" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    double *x = output->GetPoint(i);
+    if (std::abs(vtkMath::Dot(a, x) - 1.0) > 1.0e-4 ||
+        std::abs(attribute->GetComponent(i, 0) - 1.0) > 1.0e-4)
+      {
+      cerr << what << ": wrong cut point " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// A rectilinear grid with stretched coordinates, and a structured grid
+// made of sheared and rotated hexahedra.
+bool TestLinearField()
+{
+  double a[3] = { 0.6, -0.3, 0.2 };
+
+  vtkNew<vtkRectilinearGrid> rgrid;
+  rgrid->SetExtent(0, Res, 2, Res + 4, -Res, 0);
+  vtkNew<vtkDoubleArray> coords[3];
+  for (int i = 0; i < 3; ++i)
+    {
+    for (int j = 0; j <= Res; ++j)
+      {
+      coords[i]->InsertNextValue(-4.0 + 0.06 * (i + 1) * j * j);
+      }
+    }
+  rgrid->SetXCoordinates(coords[0].GetPointer());
+  rgrid->SetYCoordinates(coords[1].GetPointer());
+  rgrid->SetZCoordinates(coords[2].GetPointer());
+  AddLinearField(rgrid.GetPointer(), a);
+  if (!CheckLinearContours(rgrid.GetPointer(), a, "Rectilinear grid"))
+    {
+    return false;
+    }
+
+  vtkNew<vtkStructuredGrid> sgrid;
+  sgrid->SetExtent(0, Res, 0, Res, 0, Res);
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= Res; ++k)
+    {
+    for (int j = 0; j <= Res; ++j)
+      {
+      for (int i = 0; i <= Res; ++i)
+        {
+        double angle = 0.05 * k;
+        double u = -3.0 + 0.5 * i + 0.2 * j;
+        double v = -3.0 + 0.5 * j;
+        points->InsertNextPoint(u * cos(angle) - v * sin(angle),
+                                u * sin(angle) + v * cos(angle),
+                                -3.0 + 0.5 * k + 0.1 * i);
+        }
+      }
+    }
+  sgrid->SetPoints(points.GetPointer());
+  AddLinearField(sgrid.GetPointer(), a);
+  return CheckLinearContours(sgrid.GetPointer(), a, "Structured grid");
+}
+
+}
+
+int TestGridFlyingEdges(int, char *[])
+{
+  if (!TestWavelet() || !TestLinearField())
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
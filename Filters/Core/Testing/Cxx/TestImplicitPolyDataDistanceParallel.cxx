@@ -0,0 +1,201 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitPolyDataDistanceParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkStaticCellLocator finds the same closest points as a brute
+// force search, and that vtkImplicitPolyDataDistance, evaluated point by
+// point and on a whole array at once, gives the signed distance to the
+// surface of a cube.
+
+#include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkImplicitPolyDataDistance.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLocator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+const int Resolution = 8;
+
+// The surface of the cube [-1,1]^3, made of quads sharing their points and
+// oriented outwards.
+void MakeCube(vtkPolyData *cube)
+{
+  const int n = Resolution;
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= n; ++k)
+    {
+    for (int j = 0; j <= n; ++j)
+      {
+      for (int i = 0; i <= n; ++i)
+        {
+        points->InsertNextPoint(-1.0 + 2.0 * i / n, -1.0 + 2.0 * j / n,
+                                -1.0 + 2.0 * k / n);
+        }
+      }
+    }
+
+  vtkNew<vtkCellArray> quads;
+  for (int a = 0; a < 3; ++a)
+    {
+    int b = (a + 1) % 3;
+    int c = (a + 2) % 3;
+    for (int side = 0; side <= n; side += n)
+      {
+      for (int v = 0; v < n; ++v)
+        {
+        for (int u = 0; u < n; ++u)
+          {
+          int corners[4][2] = { {u, v}, {u + 1, v}, {u + 1, v + 1},
+                                {u, v + 1} };
+          vtkIdType quad[4];
+          for (int q = 0; q < 4; ++q)
+            {
+            int ijk[3];
+            ijk[a] = side;
+            ijk[b] = corners[q][0];
+            ijk[c] = corners[q][1];
+            quad[side ? q : 3 - q] =
+              ijk[0] + (n + 1) * (ijk[1] + (n + 1) * ijk[2]);
+            }
+          quads->InsertNextCell(4, quad);
+          }
+        }
+      }
+    }
+  cube->SetPoints(points.GetPointer());
+  cube->SetPolys(quads.GetPointer());
+}
+
+double SignedDistance(const double x[3])
+{
+  double outside = 0.0;
+  double inside = -VTK_DOUBLE_MAX;
+  for (int i = 0; i < 3; ++i)
+    {
+    double q = std::abs(x[i]) - 1.0;
+    outside += std::max(q, 0.0) * std::max(q, 0.0);
+    inside = std::max(inside, q);
+    }
+  return sqrt(outside) + std::min(inside, 0.0);
+}
+
+// Points around and inside the cube, off its surface.
+void MakeProbes(vtkDoubleArray *probes)
+{
+  probes->SetNumberOfComponents(3);
+  for (int i = 0; i < 2000; ++i)
+    {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+      {
+      x[j] = -2.5 + 5.0 * ((i * (7 + 4 * j) + 3 * j) % 101) / 101.0 +
+        0.013 * j;
+      }
+    probes->InsertNextTuple(x);
+    }
+}
+
+}
+
+int TestImplicitPolyDataDistanceParallel(int, char *[])
+{
+  vtkNew<vtkPolyData> cube;
+  MakeCube(cube.GetPointer());
+  vtkNew<vtkDoubleArray> probes;
+  MakeProbes(probes.GetPointer());
+
+  // The closest points of the locator against a brute force search.
+  vtkNew<vtkStaticCellLocator> locator;
+  locator->SetDataSet(cube.GetPointer());
+  locator->SetNumberOfCellsPerNode(2);
+  locator->AutomaticOn();
+  locator->BuildLocator();
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType i = 0; i < probes->GetNumberOfTuples(); ++i)
+    {
+    double x[3], closest[3], dist2;
+    vtkIdType cellId;
+    int subId;
+    probes->GetTuple(i, x);
+    locator->FindClosestPoint(x, closest, cell.GetPointer(), cellId, subId,
+                              dist2);
+
+    double minDist2 = VTK_DOUBLE_MAX;
+    for (vtkIdType j = 0; j < cube->GetNumberOfCells(); ++j)
+      {
+      double p[3], pcoords[3], d2, weights[4];
+      int sub;
+      cube->GetCell(j)->EvaluatePosition(x, p, sub, pcoords, d2, weights);
+      minDist2 = std::min(minDist2, d2);
+      }
+    if (cellId < 0 || std::abs(dist2 - minDist2) > 1.0e-9 ||
+        std::abs(vtkMath::Distance2BetweenPoints(x, closest) - dist2) >
+        1.0e-9)
+      {
+      cerr << "Wrong closest point for point " << i << endl;
+      return EXIT_FAILURE;
+      }
+
+    int inside;
+    double radius = 0.5 * sqrt(minDist2);
+    if (locator->FindClosestPointWithinRadius(x, radius, closest,
+                                              cell.GetPointer(), cellId,
+                                              subId, dist2, inside) &&
+        minDist2 > 0.0)
+      {
+      cerr << "Closest point found beyond radius for point " << i << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // The signed distance, point by point and on the whole array.
+  vtkNew<vtkImplicitPolyDataDistance> distance;
+  distance->SetInput(cube.GetPointer());
+  if (!distance->CanEvaluateInParallel())
+    {
+    cerr << "The distance cannot be evaluated in parallel" << endl;
+    return EXIT_FAILURE;
+    }
+  vtkNew<vtkDoubleArray> values;
+  distance->FunctionValue(probes.GetPointer(), values.GetPointer());
+  if (values->GetNumberOfTuples() != probes->GetNumberOfTuples())
+    {
+    cerr << "Wrong number of values" << endl;
+    return EXIT_FAILURE;
+    }
+  for (vtkIdType i = 0; i < probes->GetNumberOfTuples(); ++i)
+    {
+    double x[3];
+    probes->GetTuple(i, x);
+    double expected = SignedDistance(x);
+    double value = distance->EvaluateFunction(x);
+    if (std::abs(value - expected) > 1.0e-9 ||
+        values->GetValue(i) != value)
+      {
+      cerr << "Wrong distance for point " << i << ": " << values->GetValue(i)
+           << " and " << value << " instead of " << expected << endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,229 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMaskPointsParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkMaskPoints with SampleInParallel on strides like the serial
+// filter, and that its random modes draw samples of the expected sizes,
+// with the data of the sampled points, that only depend on the seed.
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMaskPoints.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <cmath>
+#include <set>
+#include <vector>
+
+namespace
+{
+
+const vtkIdType NumberOfPoints = 200000;
+
+// Ids of the input points of the output, checking their coordinates
+bool GetSample(vtkMaskPoints *mask, vtkPolyData *input,
+               std::vector<vtkIdType> &ids, const char *what)
+{
+  mask->Update();
+  vtkPolyData *output = mask->GetOutput();
+  vtkIdTypeArray *origIds = vtkIdTypeArray::SafeDownCast(
+    output->GetPointData()->GetArray("OriginalIds"));
+  vtkIdType numPts = output->GetNumberOfPoints();
+  if (!origIds || origIds->GetNumberOfTuples() != numPts)
+    {
+    cerr << what << ": missing point data" << endl;
+    return false;
+    }
+  ids.resize(numPts);
+  for (vtkIdType k = 0; k < numPts; ++k)
+    {
+    ids[k] = origIds->GetValue(k);
+    double x[3], y[3];
+    output->GetPoint(k, x);
+    input->GetPoint(ids[k], y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+      cerr << what << ": point " << k << " is not input point " << ids[k]
+           << endl;
+      return false;
+      }
+    }
+  if (mask->GetGenerateVertices() &&
+      output->GetVerts()->GetNumberOfConnectivityEntries() != numPts + 1)
+    {
+    cerr << what << ": wrong vertices" << endl;
+    return false;
+    }
+  return true;
+}
+
+bool IsIncreasing(const std::vector<vtkIdType> &ids)
+{
+  for (size_t k = 1; k < ids.size(); ++k)
+    {
+    if (ids[k] <= ids[k - 1])
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+bool TestStride(vtkMaskPoints *mask, vtkPolyData *input)
+{
+  const vtkIdType maxPts[] = { 1000, VTK_ID_MAX };
+  for (int m = 0; m < 2; ++m)
+    {
+    mask->RandomModeOff();
+    mask->SetOnRatio(7);
+    mask->SetOffset(3);
+    mask->SetMaximumNumberOfPoints(maxPts[m]);
+    std::vector<vtkIdType> expected, ids;
+    mask->SampleInParallelOff();
+    if (!GetSample(mask, input, expected, "serial stride"))
+      {
+      return false;
+      }
+    mask->SampleInParallelOn();
+    if (!GetSample(mask, input, ids, "parallel stride"))
+      {
+      return false;
+      }
+    if (ids != expected)
+      {
+      cerr << "Parallel striding differs from serial striding" << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+bool TestRandomMode(vtkMaskPoints *mask, vtkPolyData *input, int type)
+{
+  const vtkIdType maxPts = 5000;
+  mask->SampleInParallelOn();
+  mask->RandomModeOn();
+  mask->SetRandomModeType(type);
+  mask->SetOnRatio(2);
+  mask->SetOffset(type == 0 ? 100 : 0);
+  mask->SetMaximumNumberOfPoints(maxPts);
+
+  std::vector<vtkIdType> ids, again, other;
+  mask->SetRandomSeed(17);
+  if (!GetSample(mask, input, ids, "random sample") ||
+      !GetSample(mask, input, again, "same random sample"))
+    {
+    return false;
+    }
+  mask->SetRandomSeed(18);
+  if (!GetSample(mask, input, other, "other random sample"))
+    {
+    return false;
+    }
+  if (ids != again || ids == other)
+    {
+    cerr << "Mode " << type << ": samples do not follow the seed" << endl;
+    return false;
+    }
+
+  std::set<vtkIdType> distinct(ids.begin(), ids.end());
+  if (static_cast<vtkIdType>(distinct.size()) != static_cast<vtkIdType>(ids.size()))
+    {
+    cerr << "Mode " << type << ": repeated points" << endl;
+    return false;
+    }
+  if (type == 0)
+    {
+    // One point in NumberOfPoints / maxPts on average, from the offset on
+    if (!IsIncreasing(ids) || ids.empty() || ids[0] < 100 ||
+        static_cast<vtkIdType>(ids.size()) > maxPts ||
+        static_cast<double>(ids.size()) < 0.95 * maxPts)
+      {
+      cerr << "Mode 0: unexpected sample of " << ids.size() << " points"
+           << endl;
+      return false;
+      }
+    }
+  else if (static_cast<vtkIdType>(ids.size()) != maxPts ||
+           (type == 1 && !IsIncreasing(ids)))
+    {
+    cerr << "Mode " << type << ": unexpected sample of " << ids.size()
+         << " points" << endl;
+    return false;
+    }
+
+  if (type == 1)
+    {
+    // A uniform sample has about as many points in both halves of the ids
+    vtkIdType low = 0;
+    for (size_t k = 0; k < ids.size(); ++k)
+      {
+      low += ids[k] < NumberOfPoints / 2 ? 1 : 0;
+      }
+    if (fabs(low - 0.5 * maxPts) > 0.05 * maxPts)
+      {
+      cerr << "Mode 1: " << low << " points in the first half" << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int TestMaskPointsParallel(int, char *[])
+{
+  vtkMath::RandomSeed(1234);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(NumberOfPoints);
+  vtkNew<vtkIdTypeArray> origIds;
+  origIds->SetName("OriginalIds");
+  origIds->SetNumberOfTuples(NumberOfPoints);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(NumberOfPoints);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+    {
+    points->SetPoint(i, vtkMath::Random(), vtkMath::Random(),
+                     vtkMath::Random());
+    origIds->SetValue(i, i);
+    scalars->SetValue(i, vtkMath::Random());
+    }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points.GetPointer());
+  input->GetPointData()->AddArray(origIds.GetPointer());
+  input->GetPointData()->SetScalars(scalars.GetPointer());
+
+  vtkNew<vtkMaskPoints> mask;
+  mask->SetInputData(input.GetPointer());
+  mask->GenerateVerticesOn();
+
+  if (!TestStride(mask.GetPointer(), input.GetPointer()))
+    {
+    return EXIT_FAILURE;
+    }
+  for (int type = 0; type < 3; ++type)
+    {
+    if (!TestRandomMode(mask.GetPointer(), input.GetPointer(), type))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,152 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataNormals.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the point and cell normals of vtkPolyDataNormals on a smooth
+// sphere and on a cube whose corners are split along the sharp edges.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+
+namespace
+{
+
+// Returns whether the normals of the points point away from the origin,
+// at least as much as the cosine given.
+bool CheckPointNormals(vtkPolyData *output, double minCos, const char *what)
+{
+  vtkDataArray *normals = output->GetPointData()->GetNormals();
+  if (!normals || normals->GetNumberOfTuples() != output->GetNumberOfPoints())
+    {
+    cerr << what << ": missing point normals" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    double x[3], n[3];
+    output->GetPoint(i, x);
+    normals->GetTuple(i, n);
+    vtkMath::Normalize(x);
+    if (fabs(vtkMath::Norm(n) - 1.0) > 1e-5 || vtkMath::Dot(x, n) < minCos)
+      {
+      cerr << what << ": bad normal (" << n[0] << ", " << n[1] << ", "
+           << n[2] << ") at point " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int TestPolyDataNormals(int, char *[])
+{
+  // A smooth sphere: no point is split and the normals are radial.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(128);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+  vtkIdType numSpherePts = sphere->GetOutput()->GetNumberOfPoints();
+
+  vtkNew<vtkPolyDataNormals> normals;
+  normals->SetInputConnection(sphere->GetOutputPort());
+  normals->ComputeCellNormalsOn();
+  normals->Update();
+  if (normals->GetOutput()->GetNumberOfPoints() != numSpherePts ||
+      !CheckPointNormals(normals->GetOutput(), 0.99, "Sphere"))
+    {
+    return EXIT_FAILURE;
+    }
+  vtkDataArray *cellNormals = normals->GetOutput()->GetCellData()->GetNormals();
+  if (!cellNormals || cellNormals->GetNumberOfTuples() !=
+      normals->GetOutput()->GetNumberOfCells())
+    {
+    cerr << "Sphere: missing cell normals" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // A cube centered on the origin, with shared corners and some faces
+  // ordered inwards.
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < 2; ++k)
+    {
+    for (int j = 0; j < 2; ++j)
+      {
+      for (int i = 0; i < 2; ++i)
+        {
+        points->InsertNextPoint(2 * i - 1, 2 * j - 1, 2 * k - 1);
+        }
+      }
+    }
+  const vtkIdType faces[6][4] = { {0,2,3,1}, {4,5,7,6}, {0,1,5,4},
+                                  {2,6,7,3}, {1,3,7,5}, {0,4,6,2} };
+  vtkNew<vtkCellArray> polys;
+  for (int f = 0; f < 6; ++f)
+    {
+    vtkIdType face[4];
+    for (int i = 0; i < 4; ++i)
+      {
+      face[i] = faces[f][f % 2 ? 3 - i : i];
+      }
+    polys->InsertNextCell(4, face);
+    }
+  vtkNew<vtkPolyData> cube;
+  cube->SetPoints(points.GetPointer());
+  cube->SetPolys(polys.GetPointer());
+
+  // Each corner is split in three points with the normals of the faces.
+  normals->SetInputData(cube.GetPointer());
+  normals->AutoOrientNormalsOn();
+  normals->Update();
+  vtkPolyData *output = normals->GetOutput();
+  if (output->GetNumberOfPoints() != 24 ||
+      !CheckPointNormals(output, 0.5, "Cube"))
+    {
+    cerr << "Cube: " << output->GetNumberOfPoints() << " points" << endl;
+    return EXIT_FAILURE;
+    }
+  vtkDataArray *pointNormals = output->GetPointData()->GetNormals();
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    double n[3];
+    pointNormals->GetTuple(i, n);
+    if (fabs(n[0]) + fabs(n[1]) + fabs(n[2]) > 1.0 + 1e-5)
+      {
+      cerr << "Cube: normal of point " << i << " is not a face normal"
+           << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Without splitting, the normals of the corners are averaged.
+  normals->SplittingOff();
+  normals->Update();
+  output = normals->GetOutput();
+  if (output->GetNumberOfPoints() != 8 ||
+      !CheckPointNormals(output, 0.99, "Unsplit cube"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
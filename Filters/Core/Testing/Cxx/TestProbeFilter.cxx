@@ -20,6 +20,21 @@
 #include "vtkDataSet.h"
 #include "vtkPointData.h"
 #include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStructuredGrid.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 // Gets the number of points the probe filter counted as valid.
 // The parameter should be the output of the probe filter
@@ -85,9 +100,198 @@ int TestProbeFilterThreshold()
   return (validIgnore == 2) ? 0 : 1;
 }
 
-// Currently only tests the ComputeThreshold and Threshold.  Other tests
-// should be added
+// Tests that probing with a cell locator prototype gives the same values as
+// probing with the FindCell() of the source
+int TestProbeFilterCellLocator()
+{
+  vtkNew< vtkImageData > image;
+  image->SetDimensions(11, 11, 11);
+  image->SetSpacing(0.1, 0.1, 0.1);
+  vtkNew< vtkDoubleArray > scalars;
+  scalars->SetName("xyz");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    double *x = image->GetPoint(i);
+    scalars->SetValue(i, x[0] + 2 * x[1] + 3 * x[2]);
+    }
+  image->GetPointData()->SetScalars(scalars.GetPointer());
+
+  vtkNew< vtkLineSource > line;
+  line->SetPoint1(-0.5, 0.13, 0.37);
+  line->SetPoint2(1.5, 0.83, 0.51);
+  line->SetResolution(100);
+
+  vtkNew< vtkProbeFilter > probe;
+  vtkNew< vtkStaticCellLocator > locator;
+  probe->SetInputConnection(line->GetOutputPort());
+  probe->SetSourceData(image.GetPointer());
+  probe->SetCellLocatorPrototype(locator.GetPointer());
+  probe->Update();
+
+  vtkDataSet *output = probe->GetOutput();
+  vtkDataArray *values = output->GetPointData()->GetArray("xyz");
+  int numValid = GetNumberOfValidPoints(output);
+  if (numValid < 40 || numValid > 60)
+    {
+    return 1;
+    }
+  vtkDataArray *mask = output->GetPointData()->GetScalars("vtkValidPointMask");
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    if (mask->GetVariantValue(i).ToDouble() != 1)
+      {
+      continue;
+      }
+    double *x = output->GetPoint(i);
+    if (fabs(values->GetComponent(i, 0) - (x[0] + 2 * x[1] + 3 * x[2])) >
+        1e-6)
+      {
+      return 1;
+      }
+    }
+  return 0;
+}
+
+// Checks the values probed, in parallel, in a structured grid and in an
+// unstructured grid holding its cells. Points are kept away from the grid
+// boundary, where the tolerance decides whether they are found.
+int TestProbeFilterParallel()
+{
+  const int n = 21;
+  vtkNew< vtkPoints > gridPoints;
+  vtkNew< vtkDoubleArray > scalars;
+  scalars->SetName("xyz");
+  for (int k = 0; k < n; ++k)
+    {
+    for (int j = 0; j < n; ++j)
+      {
+      for (int i = 0; i < n; ++i)
+        {
+        // A sheared grid, over which the probed field stays linear.
+        double x[3] = { 0.05 * i + 0.01 * j, 0.05 * j, 0.05 * k };
+        gridPoints->InsertNextPoint(x);
+        scalars->InsertNextValue(x[0] + 2 * x[1] + 3 * x[2]);
+        }
+      }
+    }
+
+  vtkNew< vtkStructuredGrid > sgrid;
+  sgrid->SetDimensions(n, n, n);
+  sgrid->SetPoints(gridPoints.GetPointer());
+  sgrid->GetPointData()->SetScalars(scalars.GetPointer());
+
+  vtkNew< vtkUnstructuredGrid > ugrid;
+  ugrid->SetPoints(gridPoints.GetPointer());
+  ugrid->GetPointData()->SetScalars(scalars.GetPointer());
+  ugrid->Allocate(sgrid->GetNumberOfCells());
+  vtkNew< vtkIdList > ptIds;
+  for (vtkIdType cellId = 0; cellId < sgrid->GetNumberOfCells(); ++cellId)
+    {
+    sgrid->GetCellPoints(cellId, ptIds.GetPointer());
+    ugrid->InsertNextCell(VTK_HEXAHEDRON, ptIds.GetPointer());
+    }
+
+  vtkMath::RandomSeed(5772);
+  vtkNew< vtkPoints > probePoints;
+  std::vector<bool> inside;
+  while (probePoints->GetNumberOfPoints() < 20000)
+    {
+    double y = vtkMath::Random(-0.2, 1.2);
+    double x[3] = { vtkMath::Random(-0.2, 1.4) + 0.2 * y, y,
+                    vtkMath::Random(-0.2, 1.2) };
+    double u = x[0] - 0.2 * x[1];
+    double d = std::min(std::min(std::min(u, 1.0 - u),
+                                 std::min(x[1], 1.0 - x[1])),
+                        std::min(x[2], 1.0 - x[2]));
+    if (fabs(d) > 0.01)
+      {
+      probePoints->InsertNextPoint(x);
+      inside.push_back(d > 0.0);
+      }
+    }
+  vtkNew< vtkPolyData > input;
+  input->SetPoints(probePoints.GetPointer());
+
+  vtkDataSet *sources[2] = { sgrid.GetPointer(), ugrid.GetPointer() };
+  for (int s = 0; s < 2; ++s)
+    {
+    vtkNew< vtkProbeFilter > probe;
+    probe->SetInputData(input.GetPointer());
+    probe->SetSourceData(sources[s]);
+    probe->Update();
+
+    vtkDataSet *output = probe->GetOutput();
+    vtkDataArray *values = output->GetPointData()->GetArray("xyz");
+    vtkDataArray *mask =
+      output->GetPointData()->GetScalars("vtkValidPointMask");
+    vtkIdType numInside = 0;
+    for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+      {
+      double *x = output->GetPoint(i);
+      if ((mask->GetVariantValue(i).ToDouble() == 1) != inside[i])
+        {
+        return 1;
+        }
+      if (inside[i])
+        {
+        ++numInside;
+        if (fabs(values->GetComponent(i, 0) -
+                 (x[0] + 2 * x[1] + 3 * x[2])) > 1e-6)
+          {
+          return 1;
+          }
+        }
+      else if (values->GetComponent(i, 0) != 0.0)
+        {
+        return 1;
+        }
+      }
+    if (probe->GetValidPoints()->GetNumberOfTuples() != numInside)
+      {
+      return 1;
+      }
+    }
+
+  // A rectilinear grid inside the sources is probed in parallel too.
+  vtkNew< vtkDoubleArray > coords[3];
+  for (int i = 0; i < 30; ++i)
+    {
+    coords[0]->InsertNextValue(0.3 + 0.02 * i);
+    coords[1]->InsertNextValue(0.1 + 0.027 * i);
+    coords[2]->InsertNextValue(0.1 + 0.027 * i);
+    }
+  vtkNew< vtkRectilinearGrid > rgrid;
+  rgrid->SetDimensions(30, 30, 30);
+  rgrid->SetXCoordinates(coords[0].GetPointer());
+  rgrid->SetYCoordinates(coords[1].GetPointer());
+  rgrid->SetZCoordinates(coords[2].GetPointer());
+  vtkNew< vtkProbeFilter > probe;
+  probe->SetInputData(rgrid.GetPointer());
+  probe->SetSourceData(ugrid.GetPointer());
+  probe->Update();
+  vtkDataSet *output = probe->GetOutput();
+  vtkDataArray *values = output->GetPointData()->GetArray("xyz");
+  if (probe->GetValidPoints()->GetNumberOfTuples() !=
+      rgrid->GetNumberOfPoints())
+    {
+    return 1;
+    }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    output->GetPoint(i, x);
+    if (fabs(values->GetComponent(i, 0) - (x[0] + 2 * x[1] + 3 * x[2])) >
+        1e-6)
+      {
+      return 1;
+      }
+    }
+  return 0;
+}
+
 int TestProbeFilter(int, char*[])
 {
-  return TestProbeFilterThreshold();
+  return TestProbeFilterThreshold() || TestProbeFilterCellLocator() ||
+    TestProbeFilterParallel();
 }
@@ -0,0 +1,244 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricClusteringParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkQuadricClustering produces the same output with
+// BinPolygonsInParallel on as with it off, with the options changing how
+// the polygons are binned and output.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricClustering.h"
+
+#include <cmath>
+
+namespace
+{
+
+const int Res = 120;
+
+// A wavy surface made of quads, triangles and pentagons, with duplicated
+// polygons, degenerate polygons, a few vertices and a line.
+void BuildInput(vtkPolyData *input)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (int j = 0; j <= Res; ++j)
+    {
+    for (int i = 0; i <= Res; ++i)
+      {
+      double z = 3.0 * sin(0.13 * i) * cos(0.07 * j);
+      points->InsertNextPoint(i + 0.3 * sin(0.5 * j), j, z);
+      scalars->InsertNextValue(z);
+      }
+    }
+
+  vtkNew<vtkCellArray> verts, lines, polys;
+  for (int j = 0; j < Res; ++j)
+    {
+    for (int i = 0; i < Res; ++i)
+      {
+      vtkIdType p0 = i + j * (Res + 1);
+      vtkIdType quad[4] = { p0, p0 + 1, p0 + Res + 2, p0 + Res + 1 };
+      switch ((i * 7 + j * 3) % 4)
+        {
+        case 0:
+          {
+          vtkIdType t0[3] = { quad[0], quad[1], quad[2] };
+          vtkIdType t1[3] = { quad[0], quad[2], quad[3] };
+          polys->InsertNextCell(3, t0);
+          polys->InsertNextCell(3, t1);
+          }
+          break;
+        case 1:
+          if (i + 1 < Res)
+            {
+            vtkIdType pentagon[5] = { quad[0], quad[1], quad[1] + 1,
+                                      quad[2] + 1, quad[2] };
+            polys->InsertNextCell(5, pentagon);
+            }
+          polys->InsertNextCell(4, quad);
+          break;
+        default:
+          polys->InsertNextCell(4, quad);
+        }
+      }
+    }
+  vtkIdType edge[2] = { 0, Res };
+  polys->InsertNextCell(2, edge);
+  vtkIdType tri[3] = { 5, 6, 7 };
+  polys->InsertNextCell(3, tri);
+  lines->InsertNextCell(2, edge);
+  for (vtkIdType i = 0; i < 5; ++i)
+    {
+    vtkIdType vert = i * 301 + 17;
+    verts->InsertNextCell(1, &vert);
+    }
+
+  input->SetPoints(points.GetPointer());
+  input->GetPointData()->SetScalars(scalars.GetPointer());
+  input->SetVerts(verts.GetPointer());
+  input->SetLines(lines.GetPointer());
+  input->SetPolys(polys.GetPointer());
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+    {
+    cellIds->InsertNextValue(i);
+    }
+  input->GetCellData()->SetScalars(cellIds.GetPointer());
+}
+
+bool SameArrays(vtkDataArray *a, vtkDataArray *b)
+{
+  if (!a && !b)
+    {
+    return true;
+    }
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+      {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool Check(vtkQuadricClustering *clustering, const char *what)
+{
+  clustering->BinPolygonsInParallelOff();
+  clustering->Update();
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(clustering->GetOutput());
+
+  clustering->BinPolygonsInParallelOn();
+  clustering->Update();
+  vtkPolyData *output = clustering->GetOutput();
+
+  if (expected->GetNumberOfPolys() == 0)
+    {
+    cerr << what << ": no output triangles" << endl;
+    return false;
+    }
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+      output->GetNumberOfVerts() != expected->GetNumberOfVerts() ||
+      output->GetNumberOfLines() != expected->GetNumberOfLines() ||
+      output->GetNumberOfPolys() != expected->GetNumberOfPolys())
+    {
+    cerr << what << ": " << output->GetNumberOfPoints() << " points and "
+         << output->GetNumberOfCells() << " cells instead of "
+         << expected->GetNumberOfPoints() << " and "
+         << expected->GetNumberOfCells() << endl;
+    return false;
+    }
+  if (!SameArrays(expected->GetPoints()->GetData(),
+                  output->GetPoints()->GetData()) ||
+      !SameArrays(expected->GetPointData()->GetScalars(),
+                  output->GetPointData()->GetScalars()) ||
+      !SameArrays(expected->GetCellData()->GetScalars(),
+                  output->GetCellData()->GetScalars()))
+    {
+    cerr << what << ": different points or attributes" << endl;
+    return false;
+    }
+  vtkNew<vtkIdList> expectedPts, outputPts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+    {
+    expected->GetCellPoints(cellId, expectedPts.GetPointer());
+    output->GetCellPoints(cellId, outputPts.GetPointer());
+    bool same = expectedPts->GetNumberOfIds() == outputPts->GetNumberOfIds();
+    for (vtkIdType i = 0; same && i < outputPts->GetNumberOfIds(); ++i)
+      {
+      same = expectedPts->GetId(i) == outputPts->GetId(i);
+      }
+    if (!same)
+      {
+      cerr << what << ": different cell " << cellId << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int TestQuadricClusteringParallel(int, char *[])
+{
+  vtkNew<vtkPolyData> input;
+  BuildInput(input.GetPointer());
+
+  vtkNew<vtkQuadricClustering> clustering;
+  clustering->SetInputData(input.GetPointer());
+  clustering->AutoAdjustNumberOfDivisionsOff();
+  clustering->SetNumberOfDivisions(37, 41, 5);
+  clustering->CopyCellDataOn();
+  if (!Check(clustering.GetPointer(), "Default"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  clustering->UseInternalTrianglesOff();
+  if (!Check(clustering.GetPointer(), "Without internal triangles"))
+    {
+    return EXIT_FAILURE;
+    }
+  clustering->UseInternalTrianglesOn();
+
+  clustering->PreventDuplicateCellsOff();
+  if (!Check(clustering.GetPointer(), "With duplicate cells"))
+    {
+    return EXIT_FAILURE;
+    }
+  clustering->PreventDuplicateCellsOn();
+
+  clustering->UseInputPointsOn();
+  if (!Check(clustering.GetPointer(), "Input points"))
+    {
+    return EXIT_FAILURE;
+    }
+  clustering->UseInputPointsOff();
+
+  clustering->UseFeatureEdgesOn();
+  clustering->UseFeaturePointsOn();
+  if (!Check(clustering.GetPointer(), "Feature edges"))
+    {
+    return EXIT_FAILURE;
+    }
+  clustering->UseFeatureEdgesOff();
+
+  clustering->SetDivisionOrigin(-0.5, -0.5, -4.0);
+  clustering->SetDivisionSpacing(1.7, 2.3, 1.1);
+  if (!Check(clustering.GetPointer(), "Division spacing"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
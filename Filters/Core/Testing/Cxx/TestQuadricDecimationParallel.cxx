@@ -0,0 +1,198 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricDecimationParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkQuadricDecimation produces the same output with
+// ComputeQuadricsInParallel on as with it off, with and without the
+// attribute error metric, and that vtkQuadricDecimation and vtkDecimatePro
+// produce valid triangles and about the same reduction with
+// UseIndexedPriorityQueue on. Ties are broken differently by the two
+// queues, so the outputs are not compared.
+
+#include "vtkCellArray.h"
+#include "vtkDecimatePro.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+
+#include <cmath>
+
+namespace
+{
+
+const int Res = 80;
+
+// A wavy triangulated surface with scalars, so that many edges have the
+// same cost on its flat border.
+void BuildInput(vtkPolyData *input)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (int j = 0; j <= Res; ++j)
+    {
+    for (int i = 0; i <= Res; ++i)
+      {
+      double z = (i < 10) ? 0.0 : 2.0 * sin(0.15 * i) * cos(0.11 * j);
+      points->InsertNextPoint(i, j, z);
+      scalars->InsertNextValue(cos(0.05 * i * j));
+      }
+    }
+
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < Res; ++j)
+    {
+    for (int i = 0; i < Res; ++i)
+      {
+      vtkIdType p0 = i + j * (Res + 1);
+      vtkIdType t0[3] = { p0, p0 + 1, p0 + Res + 2 };
+      vtkIdType t1[3] = { p0, p0 + Res + 2, p0 + Res + 1 };
+      polys->InsertNextCell(3, t0);
+      polys->InsertNextCell(3, t1);
+      }
+    }
+
+  input->SetPoints(points.GetPointer());
+  input->GetPointData()->SetScalars(scalars.GetPointer());
+  input->SetPolys(polys.GetPointer());
+}
+
+bool SameOutputs(vtkPolyData *expected, vtkPolyData *output)
+{
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+      output->GetNumberOfCells() != expected->GetNumberOfCells())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    double x[3], y[3];
+    expected->GetPoint(i, x);
+    output->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+      return false;
+      }
+    }
+  vtkNew<vtkIdList> expectedPts, outputPts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+    {
+    expected->GetCellPoints(cellId, expectedPts.GetPointer());
+    output->GetCellPoints(cellId, outputPts.GetPointer());
+    bool same = expectedPts->GetNumberOfIds() == outputPts->GetNumberOfIds();
+    for (vtkIdType i = 0; same && i < outputPts->GetNumberOfIds(); ++i)
+      {
+      same = expectedPts->GetId(i) == outputPts->GetId(i);
+      }
+    if (!same)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+bool CheckQuadrics(vtkQuadricDecimation *decimation, const char *what)
+{
+  decimation->ComputeQuadricsInParallelOff();
+  decimation->Update();
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(decimation->GetOutput());
+
+  decimation->ComputeQuadricsInParallelOn();
+  decimation->Update();
+  if (expected->GetNumberOfPolys() == 0 ||
+      !SameOutputs(expected.GetPointer(), decimation->GetOutput()))
+    {
+    cerr << what << ": different output with parallel quadrics" << endl;
+    return false;
+    }
+  return true;
+}
+
+// Runs filter with both queues and checks that the output is made of valid
+// triangles and of about the same number of triangles.
+template <class T>
+bool CheckQueues(T *filter, vtkIdType numTris, const char *what)
+{
+  filter->UseIndexedPriorityQueueOff();
+  filter->Update();
+  vtkIdType expectedTris = filter->GetOutput()->GetNumberOfPolys();
+
+  filter->UseIndexedPriorityQueueOn();
+  filter->Update();
+  vtkPolyData *output = filter->GetOutput();
+  vtkIdType numPts = output->GetNumberOfPoints();
+  vtkIdType npts, *pts;
+  vtkCellArray *polys = output->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); )
+    {
+    if (npts != 3 || pts[0] == pts[1] || pts[1] == pts[2] ||
+        pts[0] == pts[2] || pts[0] >= numPts || pts[1] >= numPts ||
+        pts[2] >= numPts)
+      {
+      cerr << what << ": invalid triangle" << endl;
+      return false;
+      }
+    }
+  vtkIdType difference = output->GetNumberOfPolys() - expectedTris;
+  if (expectedTris == numTris || difference > numTris / 20 ||
+      -difference > numTris / 20)
+    {
+    cerr << what << ": " << output->GetNumberOfPolys()
+         << " triangles instead of about " << expectedTris << endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+int TestQuadricDecimationParallel(int, char *[])
+{
+  vtkNew<vtkPolyData> input;
+  BuildInput(input.GetPointer());
+  vtkIdType numTris = input->GetNumberOfPolys();
+
+  vtkNew<vtkQuadricDecimation> decimation;
+  decimation->SetInputData(input.GetPointer());
+  decimation->SetTargetReduction(0.8);
+  if (!CheckQuadrics(decimation.GetPointer(), "Geometric error"))
+    {
+    return EXIT_FAILURE;
+    }
+  decimation->AttributeErrorMetricOn();
+  if (!CheckQuadrics(decimation.GetPointer(), "Attribute error"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  if (!CheckQueues(decimation.GetPointer(), numTris, "vtkQuadricDecimation"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkDecimatePro> decimatePro;
+  decimatePro->SetInputData(input.GetPointer());
+  decimatePro->SetTargetReduction(0.7);
+  decimatePro->PreserveTopologyOn();
+  if (!CheckQueues(decimatePro.GetPointer(), numTris, "vtkDecimatePro"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestResampleToImageParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkResampleToImage, whose cells are rasterized on the grid in
+// parallel, interpolates a linear field exactly on a tetrahedral mesh, takes
+// the cell data from a cell containing each point, and hides the points
+// that were not probed and the cells using them.
+
+#include "vtkCell.h"
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkResampleToImage.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+
+double Field(const double x[3])
+{
+  return x[0] + 2.0 * x[1] - 3.0 * x[2];
+}
+
+}
+
+int TestResampleToImageParallel(int, char *[])
+{
+  // A tetrahedral mesh of a box with a linear field and the cell ids.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 12, 0, 9, 0, 7);
+  image->SetSpacing(0.5, 0.7, 1.1);
+  vtkNew<vtkDoubleArray> field;
+  field->SetName("Field");
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    image->GetPoint(i, x);
+    field->InsertNextValue(Field(x));
+    }
+  image->GetPointData()->SetScalars(field.GetPointer());
+
+  vtkNew<vtkDataSetTriangleFilter> tetra;
+  tetra->SetInputData(image.GetPointer());
+  tetra->Update();
+  vtkUnstructuredGrid *mesh = tetra->GetOutput();
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < mesh->GetNumberOfCells(); ++i)
+    {
+    cellIds->InsertNextValue(i);
+    }
+  mesh->GetCellData()->AddArray(cellIds.GetPointer());
+
+  vtkNew<vtkResampleToImage> resample;
+  resample->SetInputDataObject(mesh);
+  resample->SetSamplingDimensions(37, 41, 29);
+  resample->Update();
+  vtkImageData *output = resample->GetOutput();
+
+  vtkDataArray *values = output->GetPointData()->GetArray("Field");
+  vtkDataArray *ids = output->GetPointData()->GetArray("CellIds");
+  vtkCharArray *mask = vtkCharArray::SafeDownCast(
+    output->GetPointData()->GetArray("vtkValidPointMask"));
+  vtkUnsignedCharArray *pointGhosts = output->GetPointGhostArray();
+  vtkUnsignedCharArray *cellGhosts = output->GetCellGhostArray();
+  if (!values || !ids || !mask || !pointGhosts || !cellGhosts)
+    {
+    cerr << "Missing output arrays" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkIdType numPoints = output->GetNumberOfPoints();
+  vtkIdType numValid = 0;
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    bool hidden =
+      (pointGhosts->GetValue(i) & vtkDataSetAttributes::HIDDENPOINT) != 0;
+    if (hidden == (mask->GetValue(i) != 0))
+      {
+      cerr << "Wrong point ghost at point " << i << endl;
+      return EXIT_FAILURE;
+      }
+    if (!mask->GetValue(i))
+      {
+      continue;
+      }
+    ++numValid;
+
+    double x[3];
+    output->GetPoint(i, x);
+    if (std::abs(values->GetComponent(i, 0) - Field(x)) > 1.0e-9)
+      {
+      cerr << "Wrong value at point " << i << endl;
+      return EXIT_FAILURE;
+      }
+
+    double closestPoint[3], pcoords[3], dist2, weights[4];
+    int subId;
+    vtkCell *cell = mesh->GetCell(
+      static_cast<vtkIdType>(ids->GetComponent(i, 0)));
+    if (!cell->EvaluatePosition(x, closestPoint, subId, pcoords, dist2,
+                                weights) || dist2 != 0.0)
+      {
+      cerr << "Point " << i << " is not in its cell" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+  if (numValid < numPoints * 9 / 10)
+    {
+    cerr << "Only " << numValid << " of " << numPoints
+         << " points were probed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkIdList> cellPoints;
+  for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+    {
+    output->GetCellPoints(i, cellPoints.GetPointer());
+    bool hidden = false;
+    for (vtkIdType j = 0; j < cellPoints->GetNumberOfIds(); ++j)
+      {
+      hidden = hidden || !mask->GetValue(cellPoints->GetId(j));
+      }
+    if (hidden !=
+        ((cellGhosts->GetValue(i) & vtkDataSetAttributes::HIDDENPOINT) != 0))
+      {
+      cerr << "Wrong cell ghost at cell " << i << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Sampling beyond the mesh leaves points hidden.
+  resample->UseInputBoundsOff();
+  resample->SetSamplingBounds(-1.0, 4.0, 1.0, 8.0, 2.0, 3.0);
+  resample->SetSamplingDimensions(30, 20, 3);
+  resample->Update();
+  output = resample->GetOutput();
+  mask = vtkCharArray::SafeDownCast(
+    output->GetPointData()->GetArray("vtkValidPointMask"));
+  numValid = 0;
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    numValid += (mask->GetValue(i) ? 1 : 0);
+    }
+  if (numValid == 0 || numValid == output->GetNumberOfPoints())
+    {
+    cerr << "Wrong number of probed points: " << numValid << endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
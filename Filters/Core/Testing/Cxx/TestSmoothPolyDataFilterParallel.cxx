@@ -0,0 +1,186 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSmoothPolyDataFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkSmoothPolyDataFilter and vtkWindowedSincPolyDataFilter
+// produce exactly the same points with SmoothInParallel on as with it off,
+// on a mesh with boundaries, feature edges, a non-manifold fin, strips,
+// lines and vertices.
+
+#include "vtkCellArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmoothPolyDataFilter.h"
+#include "vtkWindowedSincPolyDataFilter.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+
+const int Res = 60;
+
+void BuildInput(vtkPolyData *input, int dataType)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataType(dataType);
+  for (int j = 0; j <= Res; ++j)
+    {
+    for (int i = 0; i <= Res; ++i)
+      {
+      // A ridge along i == Res / 2, plus some noise.
+      double z = 0.3 * std::abs(i - Res / 2) + vtkMath::Random(-0.2, 0.2);
+      points->InsertNextPoint(i + vtkMath::Random(-0.2, 0.2), j, z);
+      }
+    }
+
+  vtkNew<vtkCellArray> verts, lines, polys, strips;
+  for (int j = 0; j < Res; ++j)
+    {
+    for (int i = 0; i < Res; ++i)
+      {
+      vtkIdType p0 = i + j * (Res + 1);
+      if (j < Res / 2)
+        {
+        vtkIdType quad[4] = { p0, p0 + 1, p0 + Res + 2, p0 + Res + 1 };
+        polys->InsertNextCell(4, quad);
+        }
+      else if (i == 0)
+        {
+        // One strip per row.
+        strips->InsertNextCell(2 * (Res + 1));
+        for (int k = 0; k <= Res; ++k)
+          {
+          strips->InsertCellPoint(p0 + k + Res + 1);
+          strips->InsertCellPoint(p0 + k);
+          }
+        }
+      }
+    }
+
+  // A fin along a row of the mesh, making non-manifold edges.
+  vtkIdType first = points->GetNumberOfPoints();
+  for (int i = 0; i <= Res; ++i)
+    {
+    points->InsertNextPoint(i, Res / 4, 2.0 + vtkMath::Random(-0.2, 0.2));
+    }
+  for (int i = 0; i < Res; ++i)
+    {
+    vtkIdType p0 = i + (Res / 4) * (Res + 1);
+    vtkIdType quad[4] = { p0, p0 + 1, first + i + 1, first + i };
+    polys->InsertNextCell(4, quad);
+    }
+
+  // A free line and a line across the mesh, and a few vertices.
+  vtkIdType line[5] = { 3, 4 + Res, 5 + 2 * Res, 6 + 3 * Res, 7 + 4 * Res };
+  lines->InsertNextCell(5, line);
+  for (int k = 0; k < 5; ++k)
+    {
+    line[k] = points->InsertNextPoint(k, -1.0 - 0.1 * k * k, 0.0);
+    }
+  lines->InsertNextCell(5, line);
+  for (vtkIdType k = 0; k < 4; ++k)
+    {
+    vtkIdType vert = 97 * k + 11;
+    verts->InsertNextCell(1, &vert);
+    }
+
+  input->SetPoints(points.GetPointer());
+  input->SetVerts(verts.GetPointer());
+  input->SetLines(lines.GetPointer());
+  input->SetPolys(polys.GetPointer());
+  input->SetStrips(strips.GetPointer());
+}
+
+bool SamePoints(vtkPolyData *expected, vtkPolyData *output, const char *what)
+{
+  if (expected->GetNumberOfPoints() != output->GetNumberOfPoints())
+    {
+    cerr << what << ": different number of points" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    double x[3], y[3];
+    expected->GetPoint(i, x);
+    output->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+      cerr << what << ": different point " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+template <class T>
+bool Check(T *filter, const char *what)
+{
+  filter->SmoothInParallelOff();
+  filter->Update();
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(filter->GetOutput());
+
+  filter->SmoothInParallelOn();
+  filter->Update();
+  return SamePoints(expected.GetPointer(), filter->GetOutput(), what);
+}
+
+}
+
+int TestSmoothPolyDataFilterParallel(int, char *[])
+{
+  vtkMath::RandomSeed(4321);
+  int dataTypes[2] = { VTK_FLOAT, VTK_DOUBLE };
+  for (int t = 0; t < 2; ++t)
+    {
+    vtkNew<vtkPolyData> input;
+    BuildInput(input.GetPointer(), dataTypes[t]);
+
+    vtkNew<vtkSmoothPolyDataFilter> smooth;
+    smooth->SetInputData(input.GetPointer());
+    smooth->SetNumberOfIterations(30);
+    smooth->SetRelaxationFactor(0.2);
+    if (!Check(smooth.GetPointer(), "vtkSmoothPolyDataFilter"))
+      {
+      return EXIT_FAILURE;
+      }
+    smooth->FeatureEdgeSmoothingOn();
+    smooth->BoundarySmoothingOff();
+    smooth->SetConvergence(0.001);
+    if (!Check(smooth.GetPointer(), "vtkSmoothPolyDataFilter with features"))
+      {
+      return EXIT_FAILURE;
+      }
+
+    vtkNew<vtkWindowedSincPolyDataFilter> sinc;
+    sinc->SetInputData(input.GetPointer());
+    sinc->SetNumberOfIterations(15);
+    if (!Check(sinc.GetPointer(), "vtkWindowedSincPolyDataFilter"))
+      {
+      return EXIT_FAILURE;
+      }
+    sinc->FeatureEdgeSmoothingOn();
+    sinc->NonManifoldSmoothingOn();
+    sinc->NormalizeCoordinatesOn();
+    if (!Check(sinc.GetPointer(),
+               "vtkWindowedSincPolyDataFilter with features"))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
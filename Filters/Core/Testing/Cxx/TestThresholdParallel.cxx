@@ -0,0 +1,227 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThresholdParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkThreshold extracts the expected cells, points and
+// attributes in all its modes, on an input large enough to be processed
+// by several threads.
+
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+const int Dim = 40;
+const double Lower = 0.3;
+const double Upper = 0.6;
+
+struct Mode
+{
+  const char *Name;
+  bool UsePoints;
+  int AllScalars;
+  int Continuous;
+  int ComponentMode;
+};
+
+bool InRange(double s)
+{
+  return s >= Lower && s <= Upper;
+}
+
+bool KeepValue(vtkDataArray *scalars, vtkIdType id, int componentMode)
+{
+  bool c0 = InRange(scalars->GetComponent(id, 0));
+  bool c1 = InRange(scalars->GetComponent(id, 1));
+  switch (componentMode)
+    {
+    case VTK_COMPONENT_MODE_USE_ALL:
+      return c0 && c1;
+    case VTK_COMPONENT_MODE_USE_ANY:
+      return c0 || c1;
+    default:
+      return c1;
+    }
+}
+
+bool KeepCell(vtkImageData *image, vtkIdType cellId, vtkIdList *ptIds,
+              const Mode &mode)
+{
+  if (!mode.UsePoints)
+    {
+    return KeepValue(image->GetCellData()->GetArray("CellScalars"), cellId,
+                     mode.ComponentMode);
+    }
+  vtkDataArray *scalars = image->GetPointData()->GetArray("PointScalars");
+  image->GetCellPoints(cellId, ptIds);
+  if (mode.Continuous)
+    {
+    // Only used with the selected component.
+    double minS = VTK_DOUBLE_MAX, maxS = -VTK_DOUBLE_MAX;
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+      double s = scalars->GetComponent(ptIds->GetId(i), 1);
+      minS = std::min(minS, s);
+      maxS = std::max(maxS, s);
+      }
+    return !(Lower > maxS || Upper < minS);
+    }
+  bool all = true, any = false;
+  for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+    {
+    bool keep = KeepValue(scalars, ptIds->GetId(i), mode.ComponentMode);
+    all = all && keep;
+    any = any || keep;
+    }
+  return mode.AllScalars ? all : any;
+}
+
+bool Check(vtkImageData *image, const Mode &mode)
+{
+  vtkNew<vtkThreshold> threshold;
+  threshold->SetInputData(image);
+  threshold->SetInputArrayToProcess(0, 0, 0, mode.UsePoints ?
+    vtkDataObject::FIELD_ASSOCIATION_POINTS :
+    vtkDataObject::FIELD_ASSOCIATION_CELLS,
+    mode.UsePoints ? "PointScalars" : "CellScalars");
+  threshold->ThresholdBetween(Lower, Upper);
+  threshold->SetAllScalars(mode.AllScalars);
+  threshold->SetUseContinuousCellRange(mode.Continuous);
+  threshold->SetComponentMode(mode.ComponentMode);
+  threshold->SetSelectedComponent(1);
+  threshold->Update();
+  vtkUnstructuredGrid *output = threshold->GetOutput();
+
+  // The expected cells, in input order, and their points.
+  std::vector<vtkIdType> cells;
+  std::vector<char> usedPoints(image->GetNumberOfPoints(), 0);
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < image->GetNumberOfCells(); ++cellId)
+    {
+    if (KeepCell(image, cellId, ptIds.GetPointer(), mode))
+      {
+      cells.push_back(cellId);
+      image->GetCellPoints(cellId, ptIds.GetPointer());
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+        {
+        usedPoints[ptIds->GetId(i)] = 1;
+        }
+      }
+    }
+  vtkIdType numPoints = std::count(usedPoints.begin(), usedPoints.end(), 1);
+  if (cells.empty() ||
+      output->GetNumberOfCells() != static_cast<vtkIdType>(cells.size()) ||
+      output->GetNumberOfPoints() != numPoints)
+    {
+    cerr << mode.Name << ": " << output->GetNumberOfCells() << " cells and "
+         << output->GetNumberOfPoints() << " points instead of "
+         << cells.size() << " and " << numPoints << endl;
+    return false;
+    }
+
+  // The points and cells keep the input order and their attributes.
+  vtkDataArray *inPointScalars =
+    image->GetPointData()->GetArray("PointScalars");
+  vtkDataArray *outPointScalars =
+    output->GetPointData()->GetArray("PointScalars");
+  vtkIdType lastId = -1;
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    output->GetPoint(i, x);
+    vtkIdType id = image->FindPoint(x);
+    if (id <= lastId || !usedPoints[id] || !outPointScalars ||
+        outPointScalars->GetComponent(i, 1) !=
+        inPointScalars->GetComponent(id, 1))
+      {
+      cerr << mode.Name << ": bad point " << i << endl;
+      return false;
+      }
+    lastId = id;
+    }
+  vtkDataArray *inCellScalars = image->GetCellData()->GetArray("CellScalars");
+  vtkDataArray *outCellScalars =
+    output->GetCellData()->GetArray("CellScalars");
+  for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+    {
+    output->GetCellPoints(i, ptIds.GetPointer());
+    if (!outCellScalars || ptIds->GetNumberOfIds() != 8 ||
+        outCellScalars->GetComponent(i, 0) !=
+        inCellScalars->GetComponent(cells[i], 0))
+      {
+      cerr << mode.Name << ": bad cell " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int TestThresholdParallel(int, char *[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Dim, Dim, Dim);
+
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  pointScalars->SetNumberOfComponents(2);
+  pointScalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    image->GetPoint(i, x);
+    pointScalars->SetComponent(i, 0, x[0] / Dim);
+    pointScalars->SetComponent(i, 1, (x[1] + x[2]) / (2.0 * Dim));
+    }
+  image->GetPointData()->AddArray(pointScalars.GetPointer());
+
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  cellScalars->SetNumberOfComponents(2);
+  cellScalars->SetNumberOfTuples(image->GetNumberOfCells());
+  for (vtkIdType i = 0; i < image->GetNumberOfCells(); ++i)
+    {
+    cellScalars->SetComponent(i, 0, ((i * 104729) % 1000) / 1000.0);
+    cellScalars->SetComponent(i, 1, (i % 10) / 10.0);
+    }
+  image->GetCellData()->AddArray(cellScalars.GetPointer());
+
+  const Mode modes[] = {
+    { "All scalars", true, 1, 0, VTK_COMPONENT_MODE_USE_SELECTED },
+    { "Any scalar", true, 0, 0, VTK_COMPONENT_MODE_USE_SELECTED },
+    { "Continuous range", true, 0, 1, VTK_COMPONENT_MODE_USE_SELECTED },
+    { "All components", true, 0, 0, VTK_COMPONENT_MODE_USE_ALL },
+    { "Any component", true, 1, 0, VTK_COMPONENT_MODE_USE_ANY },
+    { "Cell scalars", false, 1, 0, VTK_COMPONENT_MODE_USE_SELECTED },
+    { "Any cell component", false, 1, 0, VTK_COMPONENT_MODE_USE_ANY }
+  };
+  for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); ++i)
+    {
+    if (!Check(image.GetPointer(), modes[i]))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,223 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTriangleStripParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkTriangleFilter produces the same cells and cell data with
+// TriangulateInParallel on as with it off, and that the strips of
+// vtkStripper with StripInParallel on hold the same triangles as those
+// made by the serial pass.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStripper.h"
+#include "vtkTriangleFilter.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+const int Res = 60;
+
+// A grid of quads, with a row of pentagons, a strip, a poly-line and a few
+// vertices, and the cell ids as cell data.
+void MakeMesh(vtkPolyData *mesh)
+{
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= Res; ++j)
+    {
+    for (int i = 0; i <= Res; ++i)
+      {
+      points->InsertNextPoint(i, j, 0.01 * i * j);
+      }
+    }
+  vtkNew<vtkCellArray> verts, lines, polys, strips;
+  for (vtkIdType i = 0; i < 5; ++i)
+    {
+    verts->InsertNextCell(1, &i);
+    }
+  vtkIdType line[4] = { 0, 1, 2, Res + 3 };
+  lines->InsertNextCell(4, line);
+  for (vtkIdType j = 0; j < Res - 2; ++j)
+    {
+    for (vtkIdType i = 0; i < Res; ++i)
+      {
+      vtkIdType quad[4] = { j * (Res + 1) + i, j * (Res + 1) + i + 1,
+                            (j + 1) * (Res + 1) + i + 1,
+                            (j + 1) * (Res + 1) + i };
+      polys->InsertNextCell(4, quad);
+      }
+    }
+  vtkIdType row = (Res - 2) * (Res + 1);
+  for (vtkIdType i = 0; i < Res; i += 2)
+    {
+    vtkIdType pentagon[5] = { row + i, row + i + 1, row + i + 2,
+                              row + Res + 1 + i + 2, row + Res + 1 + i };
+    polys->InsertNextCell(5, pentagon);
+    }
+  row += Res + 1;
+  strips->InsertNextCell(2 * (Res + 1));
+  for (vtkIdType i = 0; i <= Res; ++i)
+    {
+    strips->InsertCellPoint(row + Res + 1 + i);
+    strips->InsertCellPoint(row + i);
+    }
+  mesh->SetPoints(points.GetPointer());
+  mesh->SetVerts(verts.GetPointer());
+  mesh->SetLines(lines.GetPointer());
+  mesh->SetPolys(polys.GetPointer());
+  mesh->SetStrips(strips.GetPointer());
+
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Ids");
+  for (vtkIdType i = 0; i < mesh->GetNumberOfCells(); ++i)
+    {
+    ids->InsertNextValue(i);
+    }
+  mesh->GetCellData()->AddArray(ids.GetPointer());
+}
+
+bool SameCells(vtkCellArray *expected, vtkCellArray *output)
+{
+  if (expected->GetNumberOfCells() != output->GetNumberOfCells() ||
+      expected->GetNumberOfConnectivityEntries() !=
+      output->GetNumberOfConnectivityEntries())
+    {
+    return false;
+    }
+  vtkIdTypeArray *data = expected->GetData();
+  vtkIdTypeArray *outData = output->GetData();
+  for (vtkIdType i = 0; i < data->GetNumberOfTuples(); ++i)
+    {
+    if (data->GetValue(i) != outData->GetValue(i))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+bool TestTriangleFilter(vtkPolyData *mesh)
+{
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputData(mesh);
+  triangles->Update();
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(triangles->GetOutput());
+
+  triangles->TriangulateInParallelOn();
+  triangles->Update();
+  vtkPolyData *output = triangles->GetOutput();
+  if (!SameCells(expected->GetVerts(), output->GetVerts()) ||
+      !SameCells(expected->GetLines(), output->GetLines()) ||
+      !SameCells(expected->GetPolys(), output->GetPolys()) ||
+      output->GetNumberOfStrips() != 0)
+    {
+    cerr << "Different cells with TriangulateInParallel on" << endl;
+    return false;
+    }
+  vtkIdTypeArray *ids = vtkIdTypeArray::SafeDownCast(
+    expected->GetCellData()->GetArray("Ids"));
+  vtkIdTypeArray *outIds = vtkIdTypeArray::SafeDownCast(
+    output->GetCellData()->GetArray("Ids"));
+  if (!ids || !outIds ||
+      ids->GetNumberOfTuples() != outIds->GetNumberOfTuples())
+    {
+    cerr << "Different cell data with TriangulateInParallel on" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < ids->GetNumberOfTuples(); ++i)
+    {
+    if (ids->GetValue(i) != outIds->GetValue(i))
+      {
+      cerr << "Different cell data at cell " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// Collects the non-degenerate triangles of the strips, with sorted points.
+typedef std::vector<std::vector<vtkIdType> > TriangleList;
+
+void GetTriangles(vtkCellArray *strips, TriangleList &triangles)
+{
+  vtkIdType npts, *pts;
+  for (strips->InitTraversal(); strips->GetNextCell(npts, pts);)
+    {
+    for (vtkIdType i = 2; i < npts; ++i)
+      {
+      std::vector<vtkIdType> tri(pts + i - 2, pts + i + 1);
+      std::sort(tri.begin(), tri.end());
+      if (tri[0] != tri[1] && tri[1] != tri[2])
+        {
+        triangles.push_back(tri);
+        }
+      }
+    }
+  std::sort(triangles.begin(), triangles.end());
+}
+
+bool TestStripper(vtkPolyData *mesh)
+{
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputData(mesh);
+  triangles->PassVertsOff();
+  triangles->PassLinesOff();
+
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputConnection(triangles->GetOutputPort());
+  stripper->PassThroughCellIdsOn();
+  stripper->Update();
+  TriangleList expected;
+  GetTriangles(stripper->GetOutput()->GetStrips(), expected);
+  vtkIdType numIds = stripper->GetOutput()->GetFieldData()->
+    GetArray("vtkOriginalCellIds")->GetNumberOfTuples();
+
+  stripper->StripInParallelOn();
+  stripper->Update();
+  vtkPolyData *output = stripper->GetOutput();
+  TriangleList result;
+  GetTriangles(output->GetStrips(), result);
+  if (result != expected || output->GetNumberOfPolys() != 0)
+    {
+    cerr << "Different triangles with StripInParallel on" << endl;
+    return false;
+    }
+  if (output->GetFieldData()->GetArray("vtkOriginalCellIds")->
+      GetNumberOfTuples() != numIds)
+    {
+    cerr << "Different original cell ids with StripInParallel on" << endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+int TestTriangleStripParallel(int, char *[])
+{
+  vtkNew<vtkPolyData> mesh;
+  MakeMesh(mesh.GetPointer());
+  if (!TestTriangleFilter(mesh.GetPointer()) ||
+      !TestStripper(mesh.GetPointer()))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
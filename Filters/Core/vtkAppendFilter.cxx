@@ -15,23 +15,32 @@
 #include "vtkAppendFilter.h"
 
 #include "vtkBoundingBox.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCell.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDataSetCollection.h"
 #include "vtkExecutive.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalOctreePointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <set>
 #include <string>
+#include <vector>
 
 vtkStandardNewMacro(vtkAppendFilter);
 
@@ -41,6 +50,7 @@ vtkAppendFilter::vtkAppendFilter()
   this->InputList = NULL;
   this->MergePoints = 0;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->AppendInParallel = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -200,6 +210,13 @@ int vtkAppendFilter::RequestData(
     newPts->SetDataType(VTK_DOUBLE);
     }
 
+  if (this->AppendInParallel &&
+      this->AppendInParallelData(inputs, inputVector, reallyMergePoints,
+                                 newPts, output))
+    {
+    return 1;
+    }
+
   // If we aren't merging points, we need to allocate the points here.
   if (!reallyMergePoints)
     {
@@ -334,6 +351,293 @@ int vtkAppendFilter::RequestData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+bool vtkAppendFilterIsArrayThreadSafe(vtkAbstractArray *array)
+{
+  vtkDataArray *dataArray = vtkDataArray::SafeDownCast(array);
+  return dataArray && dataArray->GetDataType() != VTK_BIT &&
+    dataArray->HasStandardMemoryLayout();
+}
+
+// Returns the input holding element id of the concatenated inputs, given
+// the exclusive prefix sums of the numbers of elements of the inputs.
+int vtkAppendFilterFindInput(const std::vector<vtkIdType> &offsets,
+                             vtkIdType id)
+{
+  return static_cast<int>(std::upper_bound(offsets.begin(), offsets.end(),
+                                           id) - offsets.begin()) - 1;
+}
+
+// Copies the points of the inputs. Output point i is the point
+// OriginalIds[i] of the concatenated inputs, or point i when OriginalIds is
+// NULL; OriginalIds is increasing.
+struct vtkAppendFilterCopyPoints
+{
+  const std::vector<vtkDataSet*> *Inputs;
+  const std::vector<vtkIdType> *Offsets;
+  const vtkIdType *OriginalIds;
+  vtkPoints *OutPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const std::vector<vtkIdType> &offsets = *this->Offsets;
+    vtkIdType id = this->OriginalIds ? this->OriginalIds[begin] : begin;
+    int idx = vtkAppendFilterFindInput(offsets, id);
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      id = this->OriginalIds ? this->OriginalIds[ptId] : ptId;
+      while (id >= offsets[idx+1])
+        {
+        ++idx;
+        }
+      (*this->Inputs)[idx]->GetPoint(id - offsets[idx], x);
+      this->OutPoints->SetPoint(ptId, x);
+      }
+  }
+};
+
+// Marks the points kept by the merging.
+struct vtkAppendFilterMarkKept
+{
+  const vtkIdType *MergeMap;
+  vtkIdType *Marks;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      this->Marks[ptId] = (this->MergeMap[ptId] == ptId ? 1 : 0);
+      }
+  }
+};
+
+// Numbers the kept points from the prefix sums of their marks, records the
+// point each kept point comes from, and replaces the merge map by the
+// output id of each point.
+struct vtkAppendFilterNumberPoints
+{
+  vtkIdType *MergeMap;
+  const vtkIdType *Scanned;
+  vtkIdType *OriginalIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      vtkIdType keptId = this->MergeMap[ptId];
+      if (keptId == ptId)
+        {
+        this->OriginalIds[this->Scanned[ptId]] = ptId;
+        }
+      this->MergeMap[ptId] = this->Scanned[keptId];
+      }
+  }
+};
+
+// Stores the type of the cells of the concatenated inputs and, in
+// Locations, their size in the connectivity. With Connectivity set,
+// writes the cells at their Locations instead, with the point ids offset by
+// the first point of their input and mapped through PointMap when given.
+struct vtkAppendFilterCopyCells
+{
+  const std::vector<vtkDataSet*> *Inputs;
+  const std::vector<vtkIdType> *Offsets;
+  const std::vector<vtkIdType> *PointOffsets;
+  const vtkIdType *PointMap;
+  unsigned char *Types;
+  vtkIdType *Locations;
+  vtkIdType *Connectivity;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const std::vector<vtkIdType> &offsets = *this->Offsets;
+    vtkIdList *ptIds = this->CellPoints.Local();
+    int idx = vtkAppendFilterFindInput(offsets, begin);
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      while (cellId >= offsets[idx+1])
+        {
+        ++idx;
+        }
+      vtkDataSet *input = (*this->Inputs)[idx];
+      vtkIdType inCellId = cellId - offsets[idx];
+      input->GetCellPoints(inCellId, ptIds);
+      vtkIdType npts = ptIds->GetNumberOfIds();
+      if (!this->Connectivity)
+        {
+        this->Types[cellId] =
+          static_cast<unsigned char>(input->GetCellType(inCellId));
+        this->Locations[cellId] = npts + 1;
+        continue;
+        }
+      vtkIdType ptOffset = (*this->PointOffsets)[idx];
+      vtkIdType *cell = this->Connectivity + this->Locations[cellId];
+      *cell++ = npts;
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        vtkIdType ptId = ptIds->GetId(i) + ptOffset;
+        *cell++ = this->PointMap ? this->PointMap[ptId] : ptId;
+        }
+      }
+  }
+};
+
+// Copies the tuples of the input arrays to the output arrays. Output tuple
+// i comes from tuple OriginalIds[i] of the concatenated inputs, or tuple i
+// when OriginalIds is NULL; OriginalIds is increasing.
+struct vtkAppendFilterCopyArrays
+{
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkAbstractArray*> Destinations;
+  // The source arrays of each input, one per destination array.
+  std::vector<vtkAbstractArray*> Sources;
+  const vtkIdType *OriginalIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    size_t numArrays = this->Destinations.size();
+    vtkIdType id = this->OriginalIds ? this->OriginalIds[begin] : begin;
+    int idx = vtkAppendFilterFindInput(this->Offsets, id);
+    for (vtkIdType outId = begin; outId < end; ++outId)
+      {
+      id = this->OriginalIds ? this->OriginalIds[outId] : outId;
+      while (id >= this->Offsets[idx+1])
+        {
+        ++idx;
+        }
+      for (size_t i = 0; i < numArrays; ++i)
+        {
+        this->Destinations[i]->SetTuple(outId, id - this->Offsets[idx],
+          this->Sources[idx * numArrays + i]);
+        }
+      }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+// The points and cells of every input have their place in the output
+// computed up front, and are then copied in parallel.
+int vtkAppendFilter::AppendInParallelData(vtkDataSetCollection* inputs,
+                                          vtkInformationVector **inputVector,
+                                          bool mergePoints, vtkPoints* newPts,
+                                          vtkUnstructuredGrid* output)
+{
+  int numInputs = inputs->GetNumberOfItems();
+  std::vector<vtkDataSet*> dataSets(numInputs);
+  std::vector<vtkIdType> ptOffsets(numInputs + 1, 0);
+  std::vector<vtkIdType> cellOffsets(numInputs + 1, 0);
+  for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
+    {
+    vtkDataSet* dataSet = inputs->GetItem(inputIndex);
+    vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(dataSet);
+    if (ug && ug->GetFaces())
+      {
+      return 0;
+      }
+    dataSets[inputIndex] = dataSet;
+    ptOffsets[inputIndex+1] =
+      ptOffsets[inputIndex] + dataSet->GetNumberOfPoints();
+    cellOffsets[inputIndex+1] =
+      cellOffsets[inputIndex] + dataSet->GetNumberOfCells();
+    }
+  vtkIdType totalNumPts = ptOffsets[numInputs];
+  vtkIdType totalNumCells = cellOffsets[numInputs];
+
+  vtkDebugMacro(<<"Appending data together in parallel");
+
+  // Build the cells of the inputs from a single thread first.
+  vtkNew<vtkIdList> cellPtIds;
+  for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
+    {
+    if (dataSets[inputIndex]->GetNumberOfCells() > 0)
+      {
+      dataSets[inputIndex]->GetCellType(0);
+      dataSets[inputIndex]->GetCellPoints(0, cellPtIds.GetPointer());
+      }
+    }
+
+  // Copy the points, then merge them if requested: pointMap maps the
+  // concatenated input points to the output points, and originalIds the
+  // output points back.
+  vtkAppendFilterCopyPoints copyPoints =
+    { &dataSets, &ptOffsets, NULL, newPts };
+  std::vector<vtkIdType> pointMap;
+  std::vector<vtkIdType> originalIds;
+  newPts->SetNumberOfPoints(totalNumPts);
+  vtkSMPTools::For(0, totalNumPts, copyPoints);
+  if (mergePoints)
+    {
+    vtkNew<vtkPolyData> merged;
+    merged->SetPoints(newPts);
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(merged.GetPointer());
+    locator->BuildLocator();
+    pointMap.resize(totalNumPts);
+    locator->MergePoints(0.0, &pointMap[0]);
+
+    std::vector<vtkIdType> scanned(totalNumPts);
+    vtkAppendFilterMarkKept mark = { &pointMap[0], &scanned[0] };
+    vtkSMPTools::For(0, totalNumPts, mark);
+    vtkIdType numNewPts = vtkSMPTools::ExclusiveScan(scanned.begin(),
+      scanned.end(), scanned.begin(), static_cast<vtkIdType>(0));
+    originalIds.resize(numNewPts);
+    vtkAppendFilterNumberPoints number =
+      { &pointMap[0], &scanned[0], &originalIds[0] };
+    vtkSMPTools::For(0, totalNumPts, number);
+
+    copyPoints.OriginalIds = &originalIds[0];
+    newPts->SetNumberOfPoints(numNewPts);
+    vtkSMPTools::For(0, numNewPts, copyPoints);
+    }
+  this->UpdateProgress(0.25);
+
+  // Size the cells, locate them in the connectivity, and copy them.
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(totalNumCells);
+  vtkNew<vtkIdTypeArray> locations;
+  locations->SetNumberOfValues(totalNumCells);
+  vtkAppendFilterCopyCells copyCells;
+  copyCells.Inputs = &dataSets;
+  copyCells.Offsets = &cellOffsets;
+  copyCells.PointOffsets = &ptOffsets;
+  copyCells.PointMap = mergePoints ? &pointMap[0] : NULL;
+  copyCells.Types = types->GetPointer(0);
+  copyCells.Locations = locations->GetPointer(0);
+  copyCells.Connectivity = NULL;
+  vtkSMPTools::For(0, totalNumCells, copyCells);
+  vtkIdType connectivitySize = vtkSMPTools::ExclusiveScan(
+    copyCells.Locations, copyCells.Locations + totalNumCells,
+    copyCells.Locations, static_cast<vtkIdType>(0));
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(connectivitySize);
+  copyCells.Connectivity = connectivity->GetPointer(0);
+  vtkSMPTools::For(0, totalNumCells, copyCells);
+  vtkNew<vtkCellArray> cells;
+  cells->SetCells(totalNumCells, connectivity.GetPointer());
+  output->SetCells(types.GetPointer(), locations.GetPointer(),
+                   cells.GetPointer());
+  this->UpdateProgress(0.5);
+
+  // Now copy the array data
+  this->AppendArrays(vtkDataObject::POINT, inputVector, NULL, output,
+                     newPts->GetNumberOfPoints(),
+                     mergePoints ? &originalIds[0] : NULL);
+  this->UpdateProgress(0.75);
+  this->AppendArrays(vtkDataObject::CELL, inputVector, NULL, output,
+                     totalNumCells);
+  this->UpdateProgress(1.0);
+
+  output->SetPoints(newPts);
+  output->Squeeze();
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 vtkDataSetCollection* vtkAppendFilter::GetNonEmptyInputs(vtkInformationVector ** inputVector)
 {
@@ -365,7 +669,8 @@ void vtkAppendFilter::AppendArrays(int attributesType,
                                    vtkInformationVector **inputVector,
                                    vtkIdType* globalIds,
                                    vtkUnstructuredGrid* output,
-                                   vtkIdType totalNumberOfElements)
+                                   vtkIdType totalNumberOfElements,
+                                   const vtkIdType* originalIds)
 {
   // Check if attributesType is supported
   if (attributesType != vtkDataObject::POINT && attributesType != vtkDataObject::CELL)
@@ -564,6 +869,67 @@ void vtkAppendFilter::AppendArrays(int attributesType,
   //////////////////////////////////////////////////////////////
   // Phase 4 - Copy data
   //////////////////////////////////////////////////////////////
+  if (this->AppendInParallel)
+    {
+    vtkAppendFilterCopyArrays copy;
+    copy.OriginalIds = originalIds;
+    for (std::set<std::string>::iterator it = dataArrayNames.begin(); it != dataArrayNames.end(); ++it)
+      {
+      copy.Destinations.push_back(outputData->GetAbstractArray(it->c_str()));
+      }
+    for (int attribute = 0; attribute < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attribute)
+      {
+      if (attributeNeedsNullArray[attribute])
+        {
+        copy.Destinations.push_back(outputData->GetAbstractAttribute(attribute));
+        }
+      }
+    bool threadSafe = true;
+    copy.Offsets.push_back(0);
+    for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
+      {
+      vtkDataSet* dataSet = inputs->GetItem(inputIndex);
+      vtkDataSetAttributes* inputData = dataSet->GetAttributes(attributesType);
+      for (std::set<std::string>::iterator it = dataArrayNames.begin(); it != dataArrayNames.end(); ++it)
+        {
+        copy.Sources.push_back(inputData->GetAbstractArray(it->c_str()));
+        }
+      for (int attribute = 0; attribute < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attribute)
+        {
+        if (attributeNeedsNullArray[attribute])
+          {
+          copy.Sources.push_back(inputData->GetAbstractAttribute(attribute));
+          }
+        }
+      copy.Offsets.push_back(copy.Offsets.back() +
+        (attributesType == vtkDataObject::POINT ?
+         dataSet->GetNumberOfPoints() : dataSet->GetNumberOfCells()));
+      }
+    for (size_t i = 0; i < copy.Destinations.size(); ++i)
+      {
+      threadSafe = threadSafe &&
+        vtkAppendFilterIsArrayThreadSafe(copy.Destinations[i]);
+      }
+    for (size_t i = 0; i < copy.Sources.size(); ++i)
+      {
+      threadSafe = threadSafe &&
+        vtkAppendFilterIsArrayThreadSafe(copy.Sources[i]);
+      }
+    if (totalNumberOfElements == 0 || copy.Destinations.empty())
+      {
+      return;
+      }
+    if (threadSafe)
+      {
+      vtkSMPTools::For(0, totalNumberOfElements, copy);
+      }
+    else
+      {
+      copy(0, totalNumberOfElements);
+      }
+    return;
+    }
+
   vtkIdType offset = 0;
   for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
     {
@@ -662,4 +1028,6 @@ void vtkAppendFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "MergePoints:" << (this->MergePoints?"On":"Off") << "\n";
   os << indent << "OutputPointsPrecision: "
      << this->OutputPointsPrecision << "\n";
+  os << indent << "AppendInParallel:"
+     << (this->AppendInParallel?"On":"Off") << "\n";
 }
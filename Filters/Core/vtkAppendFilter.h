@@ -20,6 +20,10 @@
 // and appended only if all datasets have the point attributes available.
 // (For example, if one dataset has scalars but another does not, scalars will
 // not be appended.)
+//
+// With AppendInParallel on, the points, the cells and the attributes of all
+// the inputs are copied in parallel at offsets computed up front, and
+// MergePoints uses a vtkStaticPointLocator.
 
 // .SECTION See Also
 // vtkAppendPolyData
@@ -32,6 +36,7 @@
 
 class vtkDataSetAttributes;
 class vtkDataSetCollection;
+class vtkPoints;
 
 class VTKFILTERSCORE_EXPORT vtkAppendFilter : public vtkUnstructuredGridAlgorithm
 {
@@ -63,6 +68,16 @@ public:
 
   vtkBooleanMacro(MergePoints,int);
 
+  // Description:
+  // Copy the points, the cells and the attributes of the inputs in
+  // parallel. Coincident points are then merged with a
+  // vtkStaticPointLocator, and a merged point takes the attributes of the
+  // first of its coincident points rather than the last. Inputs with
+  // polyhedra are appended serially. Off by default.
+  vtkSetMacro(AppendInParallel,int);
+  vtkGetMacro(AppendInParallel,int);
+  vtkBooleanMacro(AppendInParallel,int);
+
   // Description:
   // Remove a dataset from the list of data to append.
   void RemoveInputData(vtkDataSet *in);
@@ -98,6 +113,7 @@ protected:
   int MergePoints;
 
   int OutputPointsPrecision;
+  int AppendInParallel;
 
 private:
   vtkAppendFilter(const vtkAppendFilter&);  // Not implemented.
@@ -107,11 +123,22 @@ private:
   // Caller must delete the returned vtkDataSetCollection.
   vtkDataSetCollection* GetNonEmptyInputs(vtkInformationVector ** inputVector);
 
+  // Append the points and cells of the inputs in parallel. Return 0,
+  // leaving the output as is, when an input has polyhedra.
+  int AppendInParallelData(vtkDataSetCollection* inputs,
+                           vtkInformationVector **inputVector,
+                           bool mergePoints, vtkPoints* newPts,
+                           vtkUnstructuredGrid* output);
+
+  // Copy the arrays of the inputs. Element i of the input data goes to
+  // globalIds[i] when given; with AppendInParallel, output element i
+  // comes from input element originalIds[i] when given.
   void AppendArrays(int attributesType,
                     vtkInformationVector **inputVector,
                     vtkIdType* globalIds,
                     vtkUnstructuredGrid* output,
-                    vtkIdType totalNumberOfElements);
+                    vtkIdType totalNumberOfElements,
+                    const vtkIdType* originalIds = NULL);
 };
 
 
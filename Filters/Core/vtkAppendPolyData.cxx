@@ -19,14 +19,20 @@
 #include "vtkCellData.h"
 #include "vtkDataArrayIteratorMacro.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTrivialProducer.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkAppendPolyData);
 
 //----------------------------------------------------------------------------
@@ -35,6 +41,8 @@ vtkAppendPolyData::vtkAppendPolyData()
   this->ParallelStreaming = 0;
   this->UserManagedInputs = 0;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->AppendInParallel = 0;
+  this->MergePoints = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -151,6 +159,11 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output,
   vtkIdType npts = 0;
   vtkIdType ptId, cellId;
 
+  if (this->AppendInParallel || this->MergePoints)
+    {
+    return this->ExecuteAppendInParallel(output, inputs, numInputs);
+    }
+
   vtkDebugMacro(<<"Appending polydata");
 
   // loop over all data sets, checking to see what point data is available.
@@ -593,6 +606,469 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output,
   return 1;
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+bool vtkAppendPolyDataAreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(i));
+    if (!array || array->GetDataType() == VTK_BIT ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+vtkCellArray *vtkAppendPolyDataGetCells(vtkPolyData *pd, int type)
+{
+  switch (type)
+    {
+    case 0:
+      return pd->GetVerts();
+    case 1:
+      return pd->GetLines();
+    case 2:
+      return pd->GetPolys();
+    default:
+      return pd->GetStrips();
+    }
+}
+
+// Where the points and cells of each input go in the output. The offsets
+// are exclusive prefix sums over the inputs, followed by the total. The
+// inputs with points are indexed as in the point field list, and the
+// inputs with cells as in the cell field list.
+struct vtkAppendPolyDataLayout
+{
+  std::vector<vtkPolyData*> PointInputs;
+  std::vector<vtkIdType> PointOffsets;
+  std::vector<vtkPolyData*> CellInputs;
+  std::vector<vtkIdType> CellPointOffsets;
+  std::vector<vtkIdType> CellOffsets;
+  // For each of the verts, lines, polys and strips.
+  std::vector<vtkIdType> TypeCellOffsets[4];
+  std::vector<vtkIdType> TypeConnectivityOffsets[4];
+  vtkIdType TypeFirstCell[4];
+
+  int FindInput(const std::vector<vtkIdType> &offsets, vtkIdType id) const
+  {
+    return static_cast<int>(std::upper_bound(offsets.begin(), offsets.end(),
+                                             id) - offsets.begin()) - 1;
+  }
+};
+
+// Copies the points and/or the point data of the inputs to the output.
+// Output point i is the point OriginalIds[i] of the concatenated inputs,
+// or point i when OriginalIds is NULL; OriginalIds is increasing.
+struct vtkAppendPolyDataCopyPoints
+{
+  const vtkAppendPolyDataLayout *Layout;
+  const vtkIdType *OriginalIds;
+  vtkPoints *OutPoints;
+  vtkPointData *OutPD;
+  vtkDataSetAttributes::FieldList *List;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const std::vector<vtkIdType> &offsets = this->Layout->PointOffsets;
+    vtkIdType id = this->OriginalIds ? this->OriginalIds[begin] : begin;
+    int idx = this->Layout->FindInput(offsets, id);
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      id = this->OriginalIds ? this->OriginalIds[ptId] : ptId;
+      while (id >= offsets[idx+1])
+        {
+        ++idx;
+        }
+      vtkPolyData *input = this->Layout->PointInputs[idx];
+      vtkIdType inPtId = id - offsets[idx];
+      if (this->OutPoints)
+        {
+        input->GetPoints()->GetPoint(inPtId, x);
+        this->OutPoints->SetPoint(ptId, x);
+        }
+      if (this->OutPD)
+        {
+        this->OutPD->CopyData(*this->List, input->GetPointData(), idx,
+                              inPtId, ptId);
+        }
+      }
+  }
+};
+
+// Copies the cells of each input to the four output cell arrays, adding
+// the point offset of the input to the point ids, then mapping them through
+// PointMap when points are merged.
+struct vtkAppendPolyDataCopyCells
+{
+  const vtkAppendPolyDataLayout *Layout;
+  const vtkIdType *PointMap;
+  vtkIdType *Connectivity[4];
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType idx = begin; idx < end; ++idx)
+      {
+      vtkPolyData *input = this->Layout->CellInputs[idx];
+      vtkIdType ptOffset = this->Layout->CellPointOffsets[idx];
+      for (int type = 0; type < 4; ++type)
+        {
+        vtkCellArray *cells = vtkAppendPolyDataGetCells(input, type);
+        vtkIdType size = cells->GetNumberOfConnectivityEntries();
+        if (size == 0)
+          {
+          continue;
+          }
+        const vtkIdType *pSrc = cells->GetPointer();
+        const vtkIdType *pEnd = pSrc + size;
+        vtkIdType *pDest = this->Connectivity[type] +
+          this->Layout->TypeConnectivityOffsets[type][idx];
+        while (pSrc < pEnd)
+          {
+          vtkIdType npts = *pSrc++;
+          *pDest++ = npts;
+          for (vtkIdType i = 0; i < npts; ++i)
+            {
+            vtkIdType ptId = *pSrc++ + ptOffset;
+            *pDest++ = this->PointMap ? this->PointMap[ptId] : ptId;
+            }
+          }
+        }
+      }
+  }
+};
+
+// Copies the cell data of the concatenated input cells to their output
+// cells, which are ordered by cell array first.
+struct vtkAppendPolyDataCopyCellData
+{
+  const vtkAppendPolyDataLayout *Layout;
+  vtkCellData *OutCD;
+  vtkDataSetAttributes::FieldList *List;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const vtkAppendPolyDataLayout *layout = this->Layout;
+    const std::vector<vtkIdType> &offsets = layout->CellOffsets;
+    int idx = layout->FindInput(offsets, begin);
+    for (vtkIdType id = begin; id < end; ++id)
+      {
+      while (id >= offsets[idx+1])
+        {
+        ++idx;
+        }
+      vtkIdType cellId = id - offsets[idx];
+      vtkIdType first = 0;
+      int type = 0;
+      for (; type < 3; ++type)
+        {
+        vtkIdType numCells = layout->TypeCellOffsets[type][idx+1] -
+          layout->TypeCellOffsets[type][idx];
+        if (cellId < first + numCells)
+          {
+          break;
+          }
+        first += numCells;
+        }
+      vtkIdType outCellId = layout->TypeFirstCell[type] +
+        layout->TypeCellOffsets[type][idx] + cellId - first;
+      this->OutCD->CopyData(*this->List,
+                            layout->CellInputs[idx]->GetCellData(), idx,
+                            cellId, outCellId);
+      }
+  }
+};
+
+// Numbers the points kept by the merging in increasing order from the
+// prefix sums of their marks, records the point that each kept point comes
+// from, and replaces the merge map by the output id of each point.
+struct vtkAppendPolyDataNumberPoints
+{
+  vtkIdType *MergeMap;
+  const vtkIdType *Scanned;
+  vtkIdType *OriginalIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      vtkIdType keptId = this->MergeMap[ptId];
+      if (keptId == ptId)
+        {
+        this->OriginalIds[this->Scanned[ptId]] = ptId;
+        }
+      this->MergeMap[ptId] = this->Scanned[keptId];
+      }
+  }
+};
+
+// Marks the points kept by the merging.
+struct vtkAppendPolyDataMarkKept
+{
+  const vtkIdType *MergeMap;
+  vtkIdType *Marks;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      this->Marks[ptId] = (this->MergeMap[ptId] == ptId ? 1 : 0);
+      }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+// The output offsets of the points and cells of every input are computed
+// first, so that the inputs can then be copied in parallel.
+int vtkAppendPolyData::ExecuteAppendInParallel(vtkPolyData* output,
+  vtkPolyData* inputs[], int numInputs)
+{
+  vtkDebugMacro(<<"Appending polydata in parallel");
+
+  vtkAppendPolyDataLayout layout;
+  vtkIdType numPts = 0, numCells = 0;
+  bool mergePoints = this->MergePoints != 0;
+  int idx, type;
+  for (idx = 0; idx < numInputs; ++idx)
+    {
+    vtkPolyData *ds = inputs[idx];
+    if (ds == NULL)
+      {
+      continue;
+      }
+    if (ds->GetNumberOfPoints() > 0)
+      {
+      layout.PointInputs.push_back(ds);
+      layout.PointOffsets.push_back(numPts);
+      }
+    if (ds->GetNumberOfCells() > 0)
+      {
+      layout.CellInputs.push_back(ds);
+      layout.CellPointOffsets.push_back(numPts);
+      layout.CellOffsets.push_back(numCells);
+      numCells += ds->GetNumberOfCells();
+      }
+    numPts += ds->GetNumberOfPoints();
+    if (mergePoints && ds->HasAnyGhostCells())
+      {
+      vtkDebugMacro(<< "Ghost cells present, so points will not be merged");
+      mergePoints = false;
+      }
+    }
+  layout.PointOffsets.push_back(numPts);
+  layout.CellOffsets.push_back(numCells);
+
+  if (numPts < 1 || numCells < 1)
+    {
+    vtkDebugMacro(<<"No data to append!");
+    return 1;
+    }
+
+  // Locate the cells of each input in the four output cell arrays.
+  int numPointInputs = static_cast<int>(layout.PointInputs.size());
+  int numCellInputs = static_cast<int>(layout.CellInputs.size());
+  vtkIdType firstCell = 0;
+  for (type = 0; type < 4; ++type)
+    {
+    layout.TypeCellOffsets[type].resize(numCellInputs + 1);
+    layout.TypeConnectivityOffsets[type].resize(numCellInputs + 1);
+    vtkIdType typeCells = 0, typeSize = 0;
+    for (idx = 0; idx < numCellInputs; ++idx)
+      {
+      vtkCellArray *cells =
+        vtkAppendPolyDataGetCells(layout.CellInputs[idx], type);
+      layout.TypeCellOffsets[type][idx] = typeCells;
+      layout.TypeConnectivityOffsets[type][idx] = typeSize;
+      typeCells += cells->GetNumberOfCells();
+      typeSize += cells->GetNumberOfConnectivityEntries();
+      }
+    layout.TypeCellOffsets[type][numCellInputs] = typeCells;
+    layout.TypeConnectivityOffsets[type][numCellInputs] = typeSize;
+    layout.TypeFirstCell[type] = firstCell;
+    firstCell += typeCells;
+    }
+
+  // Intersect the attributes of the inputs.
+  vtkDataSetAttributes::FieldList ptList(numPointInputs);
+  vtkDataSetAttributes::FieldList cellList(numCellInputs);
+  for (idx = 0; idx < numPointInputs; ++idx)
+    {
+    if (idx == 0)
+      {
+      ptList.InitializeFieldList(layout.PointInputs[idx]->GetPointData());
+      }
+    else
+      {
+      ptList.IntersectFieldList(layout.PointInputs[idx]->GetPointData());
+      }
+    }
+  for (idx = 0; idx < numCellInputs; ++idx)
+    {
+    if (idx == 0)
+      {
+      cellList.InitializeFieldList(layout.CellInputs[idx]->GetCellData());
+      }
+    else
+      {
+      cellList.IntersectFieldList(layout.CellInputs[idx]->GetCellData());
+      }
+    }
+  this->UpdateProgress(0.10);
+
+  // The output points have the highest type of the input points, unless
+  // a precision is requested.
+  int pointType = VTK_FLOAT;
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+    {
+    pointType = layout.PointInputs[0]->GetPoints()->GetDataType();
+    for (idx = 1; idx < numPointInputs; ++idx)
+      {
+      pointType = std::max(pointType,
+        layout.PointInputs[idx]->GetPoints()->GetDataType());
+      }
+    }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+    {
+    pointType = VTK_DOUBLE;
+    }
+
+  vtkPointData *outputPD = output->GetPointData();
+  vtkCellData *outputCD = output->GetCellData();
+  vtkAppendPolyDataCopyPoints copyPoints;
+  copyPoints.Layout = &layout;
+  copyPoints.OriginalIds = NULL;
+  copyPoints.OutPoints = NULL;
+  copyPoints.OutPD = NULL;
+  copyPoints.List = &ptList;
+
+  // Merge the points: pointMap maps the concatenated input points to the
+  // output points, and originalIds the output points back.
+  std::vector<vtkIdType> pointMap;
+  std::vector<vtkIdType> originalIds;
+  vtkIdType numNewPts = numPts;
+  if (mergePoints)
+    {
+    vtkPoints *allPts = vtkPoints::New(pointType);
+    allPts->SetNumberOfPoints(numPts);
+    copyPoints.OutPoints = allPts;
+    vtkSMPTools::For(0, numPts, copyPoints);
+
+    vtkPolyData *merged = vtkPolyData::New();
+    merged->SetPoints(allPts);
+    vtkStaticPointLocator *locator = vtkStaticPointLocator::New();
+    locator->SetDataSet(merged);
+    locator->BuildLocator();
+    pointMap.resize(numPts);
+    locator->MergePoints(0.0, &pointMap[0]);
+    locator->Delete();
+    merged->Delete();
+    allPts->Delete();
+
+    std::vector<vtkIdType> scanned(numPts);
+    vtkAppendPolyDataMarkKept mark = { &pointMap[0], &scanned[0] };
+    vtkSMPTools::For(0, numPts, mark);
+    numNewPts = vtkSMPTools::ExclusiveScan(scanned.begin(), scanned.end(),
+      scanned.begin(), static_cast<vtkIdType>(0));
+    originalIds.resize(numNewPts);
+    vtkAppendPolyDataNumberPoints number =
+      { &pointMap[0], &scanned[0], &originalIds[0] };
+    vtkSMPTools::For(0, numPts, number);
+    copyPoints.OriginalIds = &originalIds[0];
+    }
+  this->UpdateProgress(0.25);
+
+  // Copy the points and the point data.
+  vtkPoints *newPts = vtkPoints::New(pointType);
+  newPts->SetNumberOfPoints(numNewPts);
+  outputPD->CopyAllocate(ptList, numNewPts);
+  outputPD->SetNumberOfTuples(numNewPts);
+  bool parallelPD = vtkAppendPolyDataAreArraysThreadSafe(outputPD);
+  for (idx = 0; idx < numPointInputs && parallelPD; ++idx)
+    {
+    parallelPD = vtkAppendPolyDataAreArraysThreadSafe(
+      layout.PointInputs[idx]->GetPointData());
+    }
+  copyPoints.OutPoints = newPts;
+  copyPoints.OutPD = parallelPD ? outputPD : NULL;
+  vtkSMPTools::For(0, numNewPts, copyPoints);
+  if (!parallelPD)
+    {
+    copyPoints.OutPoints = NULL;
+    copyPoints.OutPD = outputPD;
+    copyPoints(0, numNewPts);
+    }
+  output->SetPoints(newPts);
+  newPts->Delete();
+  this->UpdateProgress(0.5);
+
+  // Copy the cells, one input per task.
+  vtkCellArray *newCells[4];
+  vtkAppendPolyDataCopyCells copyCells;
+  copyCells.Layout = &layout;
+  copyCells.PointMap = mergePoints ? &pointMap[0] : NULL;
+  for (type = 0; type < 4; ++type)
+    {
+    vtkIdType size = layout.TypeConnectivityOffsets[type][numCellInputs];
+    vtkIdTypeArray *cells = vtkIdTypeArray::New();
+    cells->SetNumberOfValues(size);
+    copyCells.Connectivity[type] = cells->GetPointer(0);
+    newCells[type] = vtkCellArray::New();
+    newCells[type]->SetCells(layout.TypeCellOffsets[type][numCellInputs],
+                             cells);
+    cells->Delete();
+    }
+  vtkSMPTools::For(0, numCellInputs, 1, copyCells);
+  this->UpdateProgress(0.75);
+
+  // Copy the cell data.
+  outputCD->CopyAllocate(cellList, numCells);
+  outputCD->SetNumberOfTuples(numCells);
+  bool parallelCD = vtkAppendPolyDataAreArraysThreadSafe(outputCD);
+  for (idx = 0; idx < numCellInputs && parallelCD; ++idx)
+    {
+    parallelCD = vtkAppendPolyDataAreArraysThreadSafe(
+      layout.CellInputs[idx]->GetCellData());
+    }
+  vtkAppendPolyDataCopyCellData copyCD = { &layout, outputCD, &cellList };
+  if (parallelCD)
+    {
+    vtkSMPTools::For(0, numCells, copyCD);
+    }
+  else
+    {
+    copyCD(0, numCells);
+    }
+
+  if (newCells[0]->GetNumberOfCells() > 0)
+    {
+    output->SetVerts(newCells[0]);
+    }
+  if (newCells[1]->GetNumberOfCells() > 0)
+    {
+    output->SetLines(newCells[1]);
+    }
+  if (newCells[2]->GetNumberOfCells() > 0)
+    {
+    output->SetPolys(newCells[2]);
+    }
+  if (newCells[3]->GetNumberOfCells() > 0)
+    {
+    output->SetStrips(newCells[3]);
+    }
+  for (type = 0; type < 4; ++type)
+    {
+    newCells[type]->Delete();
+    }
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 // This method is much too long, and has to be broken up!
 // Append data sets into single polygonal data set.
@@ -605,7 +1081,7 @@ int vtkAppendPolyData::RequestData(vtkInformation *vtkNotUsed(request),
   vtkPolyData *output = vtkPolyData::GetData(outputVector, 0);
 
   int numInputs = inputVector[0]->GetNumberOfInformationObjects();
-  if (numInputs == 1)
+  if (numInputs == 1 && !this->MergePoints)
     {
     output->ShallowCopy(vtkPolyData::GetData(inputVector[0], 0));
     return 1;
@@ -708,6 +1184,10 @@ void vtkAppendPolyData::PrintSelf(ostream& os, vtkIndent indent)
   os << "UserManagedInputs:" << (this->UserManagedInputs?"On":"Off") << endl;
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision
      << endl;
+  os << indent << "AppendInParallel: "
+     << (this->AppendInParallel ? "On" : "Off") << endl;
+  os << indent << "MergePoints: " << (this->MergePoints ? "On" : "Off")
+     << endl;
 }
 
 //----------------------------------------------------------------------------
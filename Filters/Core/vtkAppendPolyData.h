@@ -99,6 +99,25 @@ public:
   vtkSetMacro(OutputPointsPrecision,int);
   vtkGetMacro(OutputPointsPrecision,int);
 
+  // Description:
+  // Copy the points, the cells and the attributes of the inputs in
+  // parallel. The output is the same as with the serial append, but the
+  // point and cell attributes are copied together through the field lists
+  // rather than with the specialized attribute copies. Off by default.
+  vtkSetMacro(AppendInParallel,int);
+  vtkGetMacro(AppendInParallel,int);
+  vtkBooleanMacro(AppendInParallel,int);
+
+  // Description:
+  // Merge the coincident points of the inputs, including the points
+  // repeated within an input. A point takes the attributes of the first of
+  // its coincident points. The points are merged with a
+  // vtkStaticPointLocator by the parallel append, whether AppendInParallel
+  // is on or not, and only if no input has ghost cells. Off by default.
+  vtkSetMacro(MergePoints,int);
+  vtkGetMacro(MergePoints,int);
+  vtkBooleanMacro(MergePoints,int);
+
 //BTX
   int ExecuteAppend(vtkPolyData* output,
     vtkPolyData* inputs[], int numInputs);
@@ -110,6 +129,8 @@ protected:
   // Flag for selecting parallel streaming behavior
   int ParallelStreaming;
   int OutputPointsPrecision;
+  int AppendInParallel;
+  int MergePoints;
 
   // Usual data generation method
   virtual int RequestData(vtkInformation *,
@@ -122,6 +143,10 @@ protected:
   void AppendData(vtkDataArray *dest, vtkDataArray *src, vtkIdType offset);
 
 
+  // Append the inputs in parallel, optionally merging their points.
+  int ExecuteAppendInParallel(vtkPolyData* output,
+                              vtkPolyData* inputs[], int numInputs);
+
   // An efficient way to append cells.
   vtkIdType *AppendCells(vtkIdType *pDest, vtkCellArray *src,
                          vtkIdType offset);
@@ -26,10 +26,130 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkArrayCalculator);
 
+namespace
+{
+// Where the values of a variable of the function parser, or of one
+// component of a vector variable, come from: a component of an array, a
+// coordinate of the points, or a constant value.
+struct vtkArrayCalculatorSource
+{
+  vtkDataArray *Array;
+  int Component;
+  bool Coordinate;
+  double Value;
+};
+
+bool vtkArrayCalculatorIsArrayThreadSafe(vtkDataArray *array)
+{
+  return !array || (array->GetDataType() != VTK_BIT &&
+                    array->HasStandardMemoryLayout());
+}
+
+// Evaluates the function on blocks of tuples: gathers the values of the
+// variables for the tuples of a block, evaluates the function for all of
+// them at once, and writes the results.
+class vtkArrayCalculatorEvaluate
+{
+public:
+  vtkFunctionParser *Parser;
+  std::vector<vtkArrayCalculatorSource> Sources;
+  int NumberOfScalarVariables;
+  int NumberOfVectorVariables;
+  vtkDataSet *DataSet;
+  vtkGraph *Graph;
+  bool UsePoints;
+  int BlockSize;
+  vtkDataArray *Result;
+  vtkSMPThreadLocal<std::vector<double> > Values;
+  vtkSMPThreadLocal<vtkIdType> NumberOfInvalidTuples;
+
+  vtkArrayCalculatorEvaluate() : NumberOfInvalidTuples(0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const int blockSize = this->BlockSize;
+    const int numSources = static_cast<int>(this->Sources.size());
+    std::vector<double> &values = this->Values.Local();
+    // The values of the sources, then the coordinates and the results.
+    values.resize(static_cast<size_t>(numSources + 6) * blockSize);
+    double *coordinates = &values[numSources * blockSize];
+    double *result = coordinates + 3 * blockSize;
+    std::vector<const double*> pointers(numSources + 1);
+    for (int k = 0; k < numSources; k++)
+      {
+      pointers[k] = &values[k * blockSize];
+      }
+    const double *const *scalarValues = &pointers[0];
+    const double *const *vectorValues =
+      &pointers[0] + this->NumberOfScalarVariables;
+    int numComponents = this->Result->GetNumberOfComponents();
+    vtkIdType &numInvalid = this->NumberOfInvalidTuples.Local();
+
+    double x[3];
+    for (vtkIdType start = begin; start < end; start += blockSize)
+      {
+      int n = static_cast<int>(std::min<vtkIdType>(blockSize, end - start));
+      if (this->UsePoints)
+        {
+        for (int i = 0; i < n; i++)
+          {
+          if (this->DataSet)
+            {
+            this->DataSet->GetPoint(start + i, x);
+            }
+          else
+            {
+            this->Graph->GetPoint(start + i, x);
+            }
+          coordinates[i] = x[0];
+          coordinates[i + blockSize] = x[1];
+          coordinates[i + 2 * blockSize] = x[2];
+          }
+        }
+      for (int k = 0; k < numSources; k++)
+        {
+        const vtkArrayCalculatorSource &source = this->Sources[k];
+        double *column = &values[k * blockSize];
+        if (source.Array)
+          {
+          for (int i = 0; i < n; i++)
+            {
+            column[i] = source.Array->GetComponent(start + i,
+                                                   source.Component);
+            }
+          }
+        else if (source.Coordinate)
+          {
+          std::copy(coordinates + source.Component * blockSize,
+                    coordinates + source.Component * blockSize + n, column);
+          }
+        else
+          {
+          std::fill(column, column + n, source.Value);
+          }
+        }
+
+      int blockInvalid = this->Parser->EvaluateBlock(n, scalarValues,
+                                                     vectorValues, result);
+      numInvalid += (blockInvalid < 0 ? n : blockInvalid);
+      for (int i = 0; i < n; i++)
+        {
+        this->Result->SetTuple(start + i, result + numComponents * i);
+        }
+      }
+  }
+};
+}
+
 vtkArrayCalculator::vtkArrayCalculator()
 {
   this->FunctionParser = vtkFunctionParser::New();
@@ -58,6 +178,9 @@ vtkArrayCalculator::vtkArrayCalculator()
   this->ReplacementValue = 0.0;
 
   this->ResultArrayType=VTK_DOUBLE;
+
+  this->EvaluateInParallel = 0;
+  this->BlockSize = 1024;
 }
 
 vtkArrayCalculator::~vtkArrayCalculator()
@@ -453,63 +576,77 @@ int vtkArrayCalculator::RequestData(
     resultArray->SetTuple(0, this->FunctionParser->GetVectorResult());
     }
 
-  for (i = 1; i < numTuples; i++)
+  if (this->EvaluateInParallel)
     {
-    for (j = 0; j < this->NumberOfScalarArrays; j++)
+    vtkIdType numInvalid = this->EvaluateBlocks(
+      inFD, dsInput, graphInput, attributeDataType == POINT_DATA, 1,
+      numTuples, resultArray);
+    if (numInvalid > 0)
       {
-      currentArray = inFD->GetArray(this->ScalarArrayNames[j]);
-      if(currentArray)
-        {
-        this->FunctionParser->
-          SetScalarVariableValue(
-            j, currentArray->GetComponent(i, this->SelectedScalarComponents[j]));
-        }
-      }
-    for (j = 0; j < this->NumberOfVectorArrays; j++)
-      {
-      currentArray = inFD->GetArray(this->VectorArrayNames[j]);
-      this->FunctionParser->
-        SetVectorVariableValue(
-          j, currentArray->GetComponent(i, this->SelectedVectorComponents[j][0]),
-          currentArray->GetComponent(
-            i, this->SelectedVectorComponents[j][1]),
-          currentArray->GetComponent(i, this->SelectedVectorComponents[j][2]));
+      vtkErrorMacro("Could not evaluate the function for " << numInvalid
+                    << " tuples.");
       }
-    if(attributeDataType == POINT_DATA)
+    }
+  else
+    {
+    for (i = 1; i < numTuples; i++)
       {
-      double* pt = 0;
-      if (dsInput)
+      for (j = 0; j < this->NumberOfScalarArrays; j++)
         {
-        pt = dsInput->GetPoint(i);
+        currentArray = inFD->GetArray(this->ScalarArrayNames[j]);
+        if(currentArray)
+          {
+          this->FunctionParser->
+            SetScalarVariableValue(
+              j, currentArray->GetComponent(i, this->SelectedScalarComponents[j]));
+          }
         }
-      else
+      for (j = 0; j < this->NumberOfVectorArrays; j++)
         {
-        pt = graphInput->GetPoint(i);
+        currentArray = inFD->GetArray(this->VectorArrayNames[j]);
+        this->FunctionParser->
+          SetVectorVariableValue(
+            j, currentArray->GetComponent(i, this->SelectedVectorComponents[j][0]),
+            currentArray->GetComponent(
+              i, this->SelectedVectorComponents[j][1]),
+            currentArray->GetComponent(i, this->SelectedVectorComponents[j][2]));
         }
-      for (j = 0; j < this->NumberOfCoordinateScalarArrays; j++)
+      if(attributeDataType == POINT_DATA)
         {
-        this->FunctionParser->
-          SetScalarVariableValue(
-            j+this->NumberOfScalarArrays, pt[this->SelectedCoordinateScalarComponents[j]]);
+        double* pt = 0;
+        if (dsInput)
+          {
+          pt = dsInput->GetPoint(i);
+          }
+        else
+          {
+          pt = graphInput->GetPoint(i);
+          }
+        for (j = 0; j < this->NumberOfCoordinateScalarArrays; j++)
+          {
+          this->FunctionParser->
+            SetScalarVariableValue(
+              j+this->NumberOfScalarArrays, pt[this->SelectedCoordinateScalarComponents[j]]);
+          }
+        for (j = 0; j < this->NumberOfCoordinateVectorArrays; j++)
+          {
+          this->FunctionParser->
+            SetVectorVariableValue(
+              j+this->NumberOfVectorArrays,
+              pt[this->SelectedCoordinateVectorComponents[j][0]],
+              pt[this->SelectedCoordinateVectorComponents[j][1]],
+              pt[this->SelectedCoordinateVectorComponents[j][2]]);
+          }
         }
-      for (j = 0; j < this->NumberOfCoordinateVectorArrays; j++)
+      if (resultType == SCALAR_RESULT)
         {
-        this->FunctionParser->
-          SetVectorVariableValue(
-            j+this->NumberOfVectorArrays,
-            pt[this->SelectedCoordinateVectorComponents[j][0]],
-            pt[this->SelectedCoordinateVectorComponents[j][1]],
-            pt[this->SelectedCoordinateVectorComponents[j][2]]);
+        scalarResult[0] = this->FunctionParser->GetScalarResult();
+        resultArray->SetTuple(i, scalarResult);
+        }
+      else
+        {
+        resultArray->SetTuple(i, this->FunctionParser->GetVectorResult());
         }
-      }
-    if (resultType == SCALAR_RESULT)
-      {
-      scalarResult[0] = this->FunctionParser->GetScalarResult();
-      resultArray->SetTuple(i, scalarResult);
-      }
-    else
-      {
-      resultArray->SetTuple(i, this->FunctionParser->GetVectorResult());
       }
     }
 
@@ -587,6 +724,101 @@ int vtkArrayCalculator::RequestData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// The variables of the function parser are set by index in the same way as
+// in the serial loop of RequestData(): the scalar arrays then the
+// coordinate scalars, and the vector arrays then the coordinate vectors.
+// The other variables keep their current value.
+vtkIdType vtkArrayCalculator::EvaluateBlocks(vtkFieldData *inFD,
+                                             vtkDataSet *dsInput,
+                                             vtkGraph *graphInput,
+                                             int usePoints,
+                                             vtkIdType begin, vtkIdType end,
+                                             vtkDataArray *resultArray)
+{
+  vtkFunctionParser *parser = this->FunctionParser;
+  vtkArrayCalculatorEvaluate evaluate;
+  evaluate.Parser = parser;
+  evaluate.NumberOfScalarVariables = parser->GetNumberOfScalarVariables();
+  evaluate.NumberOfVectorVariables = parser->GetNumberOfVectorVariables();
+  evaluate.DataSet = dsInput;
+  evaluate.Graph = graphInput;
+  evaluate.UsePoints = false;
+  evaluate.BlockSize = this->BlockSize;
+  evaluate.Result = resultArray;
+  bool threadSafe = vtkArrayCalculatorIsArrayThreadSafe(resultArray);
+
+  vtkArrayCalculatorSource source;
+  for (int k = 0; k < evaluate.NumberOfScalarVariables; k++)
+    {
+    source.Array = NULL;
+    source.Component = 0;
+    source.Coordinate = false;
+    source.Value = parser->GetScalarVariableValue(k);
+    int coordinate = k - this->NumberOfScalarArrays;
+    if (k < this->NumberOfScalarArrays)
+      {
+      source.Array = inFD->GetArray(this->ScalarArrayNames[k]);
+      source.Component = this->SelectedScalarComponents[k];
+      }
+    else if (usePoints && coordinate < this->NumberOfCoordinateScalarArrays)
+      {
+      source.Coordinate = true;
+      source.Component = this->SelectedCoordinateScalarComponents[coordinate];
+      evaluate.UsePoints = true;
+      }
+    threadSafe = threadSafe && vtkArrayCalculatorIsArrayThreadSafe(source.Array);
+    evaluate.Sources.push_back(source);
+    }
+  for (int k = 0; k < evaluate.NumberOfVectorVariables; k++)
+    {
+    double *value = parser->GetVectorVariableValue(k);
+    int coordinate = k - this->NumberOfVectorArrays;
+    for (int c = 0; c < 3; c++)
+      {
+      source.Array = NULL;
+      source.Component = 0;
+      source.Coordinate = false;
+      source.Value = value[c];
+      if (k < this->NumberOfVectorArrays)
+        {
+        source.Array = inFD->GetArray(this->VectorArrayNames[k]);
+        source.Component = this->SelectedVectorComponents[k][c];
+        }
+      else if (usePoints &&
+               coordinate < this->NumberOfCoordinateVectorArrays)
+        {
+        source.Coordinate = true;
+        source.Component =
+          this->SelectedCoordinateVectorComponents[coordinate][c];
+        evaluate.UsePoints = true;
+        }
+      threadSafe = threadSafe &&
+        vtkArrayCalculatorIsArrayThreadSafe(source.Array);
+      evaluate.Sources.push_back(source);
+      }
+    }
+
+  if (threadSafe)
+    {
+    vtkSMPTools::For(begin, end, this->BlockSize, evaluate);
+    }
+  else
+    {
+    evaluate(begin, end);
+    }
+
+  vtkIdType numInvalid = 0;
+  for (vtkSMPThreadLocal<vtkIdType>::iterator iter =
+         evaluate.NumberOfInvalidTuples.begin();
+       iter != evaluate.NumberOfInvalidTuples.end(); ++iter)
+    {
+    numInvalid += *iter;
+    }
+  return numInvalid;
+}
+
+//----------------------------------------------------------------------------
 void vtkArrayCalculator::SetFunction(const char* function)
 {
   if (this->Function && function &&
@@ -1204,4 +1436,7 @@ void vtkArrayCalculator::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Replace Invalid Values: "
      << (this->ReplaceInvalidValues ? "On" : "Off") << endl;
   os << indent << "Replacement Value: " << this->ReplacementValue << endl;
+  os << indent << "Evaluate In Parallel: "
+     << (this->EvaluateInParallel ? "On" : "Off") << endl;
+  os << indent << "Block Size: " << this->BlockSize << endl;
 }
@@ -52,6 +52,10 @@
 // tuple-wise (i.e., tuple-by-tuple). The user must specify which arrays to use as
 // vectors and/or scalars, and the name of the output data array.
 //
+// When EvaluateInParallel is on, the function is evaluated on blocks of
+// tuples with vtkFunctionParser::EvaluateBlock(), in parallel with
+// vtkSMPTools. The results are the same.
+//
 // .SECTION See Also
 // vtkFunctionParser
 
@@ -61,7 +65,11 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkDataSetAlgorithm.h"
 
+class vtkDataArray;
+class vtkDataSet;
+class vtkFieldData;
 class vtkFunctionParser;
+class vtkGraph;
 
 #define VTK_ATTRIBUTE_MODE_DEFAULT 0
 #define VTK_ATTRIBUTE_MODE_USE_POINT_DATA 1
@@ -217,6 +225,23 @@ public:
   vtkSetMacro(ReplacementValue,double);
   vtkGetMacro(ReplacementValue,double);
 
+  // Description:
+  // When EvaluateInParallel is on, the tuples are split into blocks of
+  // BlockSize tuples, the variables of a block are gathered from the
+  // arrays and each operation of the function is applied to the whole
+  // block at once. The blocks are evaluated in parallel. Instead of one
+  // error per tuple that cannot be evaluated, a single error gives their
+  // number. The default is Off.
+  vtkSetMacro(EvaluateInParallel,int);
+  vtkGetMacro(EvaluateInParallel,int);
+  vtkBooleanMacro(EvaluateInParallel,int);
+
+  // Description:
+  // The number of tuples evaluated at once when EvaluateInParallel is on.
+  // The default is 1024.
+  vtkSetClampMacro(BlockSize,int,1,VTK_INT_MAX);
+  vtkGetMacro(BlockSize,int);
+
 protected:
   vtkArrayCalculator();
   ~vtkArrayCalculator();
@@ -250,6 +275,20 @@ protected:
   int     NumberOfCoordinateVectorArrays;
 
   int     ResultArrayType;
+
+  int     EvaluateInParallel;
+  int     BlockSize;
+
+  // Description:
+  // Evaluate the function for the tuples [begin,end) of the arrays of inFD
+  // into resultArray, block by block. The coordinate variables are taken
+  // from the points of dsInput or graphInput if usePoints is true. Return
+  // the number of tuples that could not be evaluated.
+  vtkIdType EvaluateBlocks(vtkFieldData *inFD, vtkDataSet *dsInput,
+                           vtkGraph *graphInput, int usePoints,
+                           vtkIdType begin, vtkIdType end,
+                           vtkDataArray *resultArray);
+
 private:
   vtkArrayCalculator(const vtkArrayCalculator&);  // Not implemented.
   void operator=(const vtkArrayCalculator&);  // Not implemented.
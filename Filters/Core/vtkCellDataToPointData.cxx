@@ -23,13 +23,18 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkStructuredGrid.h"
-#include "vtkUnsignedIntArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
 #include <functional>
+#include <vector>
 
 #define VTK_MAX_CELLS_PER_POINT 4096
 
@@ -117,45 +122,155 @@ void vtkCellDataToPointData::PrintSelf(ostream& os, vtkIndent indent)
 // provided so that coverage test can cover this function.
 namespace
 {
+  // Averages the values of the cells using each point of [pid, end). The
+  // cells are visited through the static links in increasing order, once
+  // per use of the point, and the values are summed and divided in the type
+  // of the array. Each thread writes its own points.
   template <typename T>
-  void __spread (vtkUnstructuredGrid* const src, vtkUnsignedIntArray* const num,
-             vtkDataArray* const srcarray, vtkDataArray* const dstarray,
-             vtkIdType ncells, vtkIdType npoints, vtkIdType ncomps)
+  class vtkCellDataToPointDataAverage
   {
-    T const* const srcptr = static_cast<T const*>(srcarray->GetVoidPointer(0));
-    T      * const dstptr = static_cast<T      *>(dstarray->GetVoidPointer(0));
+  public:
+    vtkStaticCellLinks* Links;
+    T const* Src;
+    T* Dst;
+    vtkIdType NumComps;
 
-    // zero initialization
-    std::fill_n(dstptr, npoints*ncomps, T(0));
+    void operator()(vtkIdType pid, vtkIdType end)
+    {
+      vtkIdType const ncomps = this->NumComps;
+      T* dstbeg = this->Dst + pid*ncomps;
+      for (; pid < end; ++pid, dstbeg += ncomps)
+        {
+        // zero initialization
+        std::fill_n(dstbeg, ncomps, T(0));
+
+        // accumulate cell data to point data <==> point_data += cell_data
+        vtkIdType const ncells = this->Links->GetNumberOfCells(pid);
+        vtkIdType const* const cells = this->Links->GetCells(pid);
+        for (vtkIdType i = 0; i < ncells; ++i)
+          {
+          T const* const srcbeg = this->Src + cells[i]*ncomps;
+          std::transform(srcbeg,srcbeg+ncomps,dstbeg,dstbeg,std::plus<T>());
+          }
+
+        // guard against divide by zero
+        if (unsigned int const denum = static_cast<unsigned int>(ncells))
+          {
+          // divide point data by the number of cells using it <==>
+          // point_data /= denum
+          std::transform(dstbeg, dstbeg+ncomps, dstbeg,
+            std::bind2nd(std::divides<T>(), denum));
+          }
+        }
+    }
+  };
+
+  template <typename T>
+  void __average (vtkStaticCellLinks* const links,
+                  vtkDataArray* const srcarray, vtkDataArray* const dstarray,
+                  vtkIdType npoints, vtkIdType ncomps)
+  {
+    vtkCellDataToPointDataAverage<T> average;
+    average.Links = links;
+    average.Src = static_cast<T const*>(srcarray->GetVoidPointer(0));
+    average.Dst = static_cast<T*>(dstarray->GetVoidPointer(0));
+    average.NumComps = ncomps;
+    vtkSMPTools::For(0, npoints, average);
+  }
 
-    // accumulate
-    T const* srcbeg = srcptr;
-    vtkNew<vtkIdList> pids;
-    for (vtkIdType cid = 0; cid < ncells; ++cid, srcbeg += ncomps)
+  // Presizes the arrays that InterpolateAllocate() added to the point data,
+  // so that InterpolatePoint() writes distinct tuples in place from several
+  // threads. The arrays passed from the input already have all their
+  // tuples. Returns false, leaving the arrays alone, when one of the new
+  // arrays cannot be written that way.
+  bool vtkCellDataToPointDataPresizeArrays(vtkPointData* pd,
+                                           vtkIdType npoints)
+  {
+    for (int i = 0; i < pd->GetNumberOfArrays(); ++i)
       {
-      src->GetCellPoints(cid, pids.GetPointer());
-      for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
+      vtkAbstractArray* const aa = pd->GetAbstractArray(i);
+      vtkDataArray* const da = vtkDataArray::SafeDownCast(aa);
+      if (aa->GetNumberOfTuples() < npoints &&
+          (!da || da->GetDataType() == VTK_BIT ||
+           !da->HasStandardMemoryLayout()))
         {
-        T* const dstbeg = dstptr + pids->GetId(i)*ncomps;
-        // accumulate cell data to point data <==> point_data += cell_data
-        std::transform(srcbeg,srcbeg+ncomps,dstbeg,dstbeg,std::plus<T>());
+        return false;
         }
       }
+    for (int i = 0; i < pd->GetNumberOfArrays(); ++i)
+      {
+      vtkAbstractArray* const aa = pd->GetAbstractArray(i);
+      if (aa->GetNumberOfTuples() < npoints)
+        {
+        aa->SetNumberOfTuples(npoints);
+        }
+      }
+    return true;
+  }
 
-    // average
-    T* dstbeg = dstptr;
-    for (vtkIdType pid = 0; pid < npoints; ++pid, dstbeg += ncomps)
+  // InterpolatePoint() reads the input arrays through GetVoidPointer(),
+  // which first copies values shared with other arrays. Do it once here, as
+  // the first point of a serial loop would, rather than from the threads.
+  void vtkCellDataToPointDataUnshareArrays(vtkCellData *inCD)
+  {
+    for (int i = 0; i < inCD->GetNumberOfArrays(); ++i)
       {
-      // guard against divide by zero
-      if (unsigned int const denum = num->GetValue(pid))
+      vtkDataArray *da = inCD->GetArray(i);
+      if ( da && da->HasStandardMemoryLayout() )
         {
-        // divide point data by the number of cells using it <==>
-        // point_data /= denum
-        std::transform(dstbeg, dstbeg+ncomps, dstbeg,
-          std::bind2nd(std::divides<T>(), denum));
+        da->GetVoidPointer(0);
         }
       }
   }
+
+  // Interpolates the cell data of the cells using each point, found
+  // through the static links, like the serial loop of interpolatePointData.
+  // The points to null are collected per thread: vtkPointData::NullPoint()
+  // walks the arrays with a shared iterator.
+  class vtkCellDataToPointDataInterpolate
+  {
+  public:
+    vtkStaticCellLinks* Links;
+    vtkCellData* InCD;
+    vtkPointData* OutPD;
+
+    vtkSMPThreadLocalObject<vtkIdList> CellIds;
+    vtkSMPThreadLocal<std::vector<double> > Weights;
+    vtkSMPThreadLocal<std::vector<vtkIdType> > NullPoints;
+
+    void Initialize()
+    {
+      this->CellIds.Local()->Allocate(VTK_MAX_CELLS_PER_POINT);
+      this->Weights.Local().resize(VTK_MAX_CELLS_PER_POINT);
+    }
+
+    void operator()(vtkIdType ptId, vtkIdType end)
+    {
+      vtkIdList* const cellIds = this->CellIds.Local();
+      std::vector<double>& weights = this->Weights.Local();
+      for (; ptId < end; ++ptId)
+        {
+        vtkIdType const numCells = this->Links->GetNumberOfCells(ptId);
+        if ( numCells > 0 && numCells < VTK_MAX_CELLS_PER_POINT )
+          {
+          vtkIdType const* const cells = this->Links->GetCells(ptId);
+          cellIds->SetNumberOfIds(numCells);
+          std::copy(cells, cells + numCells, cellIds->GetPointer(0));
+          std::fill_n(weights.begin(), numCells, 1.0 / numCells);
+          this->OutPD->InterpolatePoint(this->InCD, ptId, cellIds,
+                                        &weights[0]);
+          }
+        else
+          {
+          this->NullPoints.Local().push_back(ptId);
+          }
+        }
+    }
+
+    void Reduce()
+    {
+    }
+  };
 }
 
 //----------------------------------------------------------------------------
@@ -177,22 +292,9 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
     return 1;
     }
 
-  // count the number of cells associated with each point
-  vtkSmartPointer<vtkUnsignedIntArray> num
-    = vtkSmartPointer<vtkUnsignedIntArray>::New();
-  num->SetNumberOfComponents(1);
-  num->SetNumberOfTuples(npoints);
-  std::fill_n(num->GetPointer(0), npoints, 0u);
-  vtkNew<vtkIdList> pids;
-  for (vtkIdType cid = 0; cid < ncells; ++cid)
-    {
-    src->GetCellPoints(cid, pids.GetPointer());
-    for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
-      {
-      vtkIdType const pid = pids->GetId(i);
-      num->SetValue(pid, num->GetValue(pid)+1);
-      }
-    }
+  // The static links give the cells using each point, so that the points
+  // are averaged independently of each other, in parallel.
+  vtkStaticCellLinks* const links = src->GetStaticCellLinks();
 
   // First, copy the input to the output as a starting point
   dst->CopyStructure(src);
@@ -257,7 +359,7 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
     switch (srcarray->GetDataType())
       {
       vtkTemplateMacro
-        (__spread<VTK_TT>(src,num,srcarray,dstarray,ncells,npoints,ncomps));
+        (__average<VTK_TT>(links,srcarray,dstarray,npoints,ncomps));
       }
     }
 
@@ -285,6 +387,39 @@ void vtkCellDataToPointData::interpolatePointData(vtkDataSet *input,
 
   std::vector<double> weights(VTK_MAX_CELLS_PER_POINT);
 
+  // Unstructured data sets use their (read-only) static links rather than
+  // building editable links on the input.
+  vtkStaticCellLinks *links = NULL;
+  if ( vtkPolyData::SafeDownCast(input) ||
+       vtkUnstructuredGrid::SafeDownCast(input) )
+    {
+    links = static_cast<vtkPointSet*>(input)->GetStaticCellLinks();
+    }
+
+  // Interpolate the points in parallel when the new arrays can be written
+  // from several threads.
+  if ( links && vtkCellDataToPointDataPresizeArrays(outPD, numPts) )
+    {
+    vtkCellDataToPointDataUnshareArrays(inCD);
+
+    vtkCellDataToPointDataInterpolate interpolate;
+    interpolate.Links = links;
+    interpolate.InCD = inCD;
+    interpolate.OutPD = outPD;
+    vtkSMPTools::For(0, numPts, interpolate);
+
+    vtkSMPThreadLocal<std::vector<vtkIdType> >::iterator itr;
+    for (itr = interpolate.NullPoints.begin();
+         itr != interpolate.NullPoints.end(); ++itr)
+      {
+      for (size_t i = 0; i < itr->size(); ++i)
+        {
+        outPD->NullPoint((*itr)[i]);
+        }
+      }
+    return;
+    }
+
   int abort = 0;
   vtkIdType progressInterval = numPts / 20 + 1;
   for (vtkIdType ptId = 0; ptId < numPts && !abort; ptId++)
@@ -295,7 +430,17 @@ void vtkCellDataToPointData::interpolatePointData(vtkDataSet *input,
       abort = GetAbortExecute();
       }
 
-    input->GetPointCells(ptId, cellIds.GetPointer());
+    if ( links )
+      {
+      vtkIdType ncells = links->GetNumberOfCells(ptId);
+      const vtkIdType *cells = links->GetCells(ptId);
+      cellIds->SetNumberOfIds(ncells);
+      std::copy(cells, cells + ncells, cellIds->GetPointer(0));
+      }
+    else
+      {
+      input->GetPointCells(ptId, cellIds.GetPointer());
+      }
     vtkIdType numCells = cellIds->GetNumberOfIds();
 
     if ( numCells > 0 && numCells < VTK_MAX_CELLS_PER_POINT )
@@ -19,6 +19,10 @@
 // points). The method of transformation is based on averaging the data
 // values of all cells using a particular point. Optionally, the input cell
 // data can be passed through to the output as well.
+//
+// For vtkUnstructuredGrid and vtkPolyData inputs the cells of each point
+// come from the static cell links of the input, and the points are
+// averaged in parallel with vtkSMPTools.
 
 // .SECTION Caveats
 // This filter is an abstract filter, that is, the output is an abstract type
@@ -15,6 +15,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkCenterOfMass.h"
 
 #include "vtkPointSet.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkDoubleArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -34,6 +35,33 @@ vtkCenterOfMass::vtkCenterOfMass()
   this->SetNumberOfOutputPorts(0);
 }
 
+namespace
+{
+// Sum of the (optionally weighted) points. Templated over the accessor types
+// so that the point coordinates are read in their native type, see
+// vtkDataArrayAccessor.
+template <class PointAccessor, class WeightAccessor>
+void SumPoints(PointAccessor points, WeightAccessor *weights, vtkIdType n,
+               double center[3], double &weightTotal)
+{
+  double sum[3] = { 0.0, 0.0, 0.0 };
+  double total = 0.0;
+  for (vtkIdType i = 0; i < n; i++)
+    {
+    const double weight =
+      weights ? static_cast<double>(weights->Get(i, 0)) : 1.0;
+    total += weight;
+    sum[0] += weight * static_cast<double>(points.Get(i, 0));
+    sum[1] += weight * static_cast<double>(points.Get(i, 1));
+    sum[2] += weight * static_cast<double>(points.Get(i, 2));
+    }
+  center[0] = sum[0];
+  center[1] = sum[1];
+  center[2] = sum[2];
+  weightTotal = total;
+}
+}
+
 void vtkCenterOfMass::ComputeCenterOfMass(
   vtkPoints* points, vtkDataArray *scalars, double center[3])
 {
@@ -45,44 +73,25 @@ void vtkCenterOfMass::ComputeCenterOfMass(
 
   assert("pre: no points" && n > 0);
 
-  if(scalars)
-    {
-    // If weights are to be used
-    double weightTotal = 0.0;
-
-    assert("pre: wrong array size" && scalars->GetNumberOfTuples() == n);
-
-    for(vtkIdType i = 0; i < n; i++)
-      {
-      double point[3];
-      points->GetPoint(i, point);
+  vtkDataArrayAccessor<vtkDataArray> weights(scalars);
+  vtkDataArrayAccessor<vtkDataArray> *weightsPtr = scalars ? &weights : NULL;
+  double weightTotal = 0.0;
 
-      double weight = scalars->GetComponent(0, i);
-      weightTotal += weight;
+  // If weights are to be used
+  assert("pre: wrong array size" &&
+         (!scalars || scalars->GetNumberOfTuples() == n));
 
-      vtkMath::MultiplyScalar(point, weight);
-      vtkMath::Add(center, point, center);
-      }
-
-    assert("pre: sum of weights must be positive" && weightTotal > 0.0);
-
-    if (weightTotal > 0.0)
-      {
-      vtkMath::MultiplyScalar(center, 1.0/weightTotal);
-      }
-    }
-  else
+  switch (points->GetData()->GetDataType())
     {
-    // No weights
-    for(vtkIdType i = 0; i < n; i++)
-      {
-      double point[3];
-      points->GetPoint(i, point);
+    vtkDataArrayAccessorMacro(points->GetData(),
+      SumPoints(vtkDAAccessor, weightsPtr, n, center, weightTotal));
+    }
 
-      vtkMath::Add(center, point, center);
-      }
+  assert("pre: sum of weights must be positive" && weightTotal > 0.0);
 
-    vtkMath::MultiplyScalar(center, 1.0/n);
+  if (weightTotal > 0.0)
+    {
+    vtkMath::MultiplyScalar(center, 1.0/weightTotal);
     }
 }
 
@@ -16,15 +16,24 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkMergePoints.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkIncrementalPointLocator.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkCleanPolyData);
 
 //---------------------------------------------------------------------------
@@ -46,6 +55,7 @@ vtkCleanPolyData::vtkCleanPolyData()
   this->Locator = NULL;
   this->PieceInvariant = 1;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->UseStaticLocator = 0;
 }
 
 //--------------------------------------------------------------------------
@@ -113,6 +123,305 @@ int vtkCleanPolyData::RequestUpdateExtent(
   return 1;
 }
 
+//--------------------------------------------------------------------------
+namespace
+{
+bool vtkCleanPolyDataAreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(i));
+    if (!array || array->GetDataType() == VTK_BIT ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// The cell arrays of the output, in the order of the output cells.
+enum
+{
+  vtkCleanPolyDataVerts = 0,
+  vtkCleanPolyDataLines = 1,
+  vtkCleanPolyDataPolys = 2,
+  vtkCleanPolyDataStrips = 3,
+  vtkCleanPolyDataDropped = -1
+};
+
+// Applies the merging to the points of a cell and decides which output
+// cell array receives it, with the same rules as the incremental path.
+struct vtkCleanPolyDataCellRules
+{
+  vtkIdType FirstLine;
+  vtkIdType FirstPoly;
+  vtkIdType FirstStrip;
+  int ConvertLinesToPoints;
+  int ConvertPolysToLines;
+  int ConvertStripsToPolys;
+
+  int Apply(vtkIdType cellId, vtkIdType npts, const vtkIdType *pts,
+            const vtkIdType *mergeMap, vtkIdType *updatedPts,
+            vtkIdType &numNewPts) const
+  {
+    numNewPts = 0;
+    if (cellId < this->FirstLine)
+      {
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        updatedPts[numNewPts++] = mergeMap[pts[i]];
+        }
+      return numNewPts > 0 ? vtkCleanPolyDataVerts : vtkCleanPolyDataDropped;
+      }
+
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      vtkIdType ptId = mergeMap[pts[i]];
+      if (i == 0 || ptId != updatedPts[numNewPts-1])
+        {
+        updatedPts[numNewPts++] = ptId;
+        }
+      }
+
+    int cellClass;
+    if (cellId < this->FirstPoly)
+      {
+      cellClass = vtkCleanPolyDataLines;
+      }
+    else if (cellId < this->FirstStrip)
+      {
+      if (numNewPts > 2 && updatedPts[0] == updatedPts[numNewPts-1])
+        {
+        numNewPts--;
+        }
+      cellClass = vtkCleanPolyDataPolys;
+      }
+    else
+      {
+      cellClass = vtkCleanPolyDataStrips;
+      if (numNewPts <= 3 && this->ConvertStripsToPolys)
+        {
+        cellClass = vtkCleanPolyDataPolys;
+        }
+      }
+    if (cellClass == vtkCleanPolyDataPolys &&
+        numNewPts <= 2 && this->ConvertPolysToLines)
+      {
+      cellClass = vtkCleanPolyDataLines;
+      }
+    if (cellClass == vtkCleanPolyDataLines &&
+        numNewPts <= 1 && this->ConvertLinesToPoints)
+      {
+      cellClass = (numNewPts == 1 ? vtkCleanPolyDataVerts :
+                   vtkCleanPolyDataDropped);
+      }
+    return cellClass;
+  }
+};
+
+// Calls OperateOnPoint() on all the input points.
+struct vtkCleanPolyDataOperateOnPoints
+{
+  vtkCleanPolyData *Self;
+  vtkPoints *InPoints;
+  vtkPoints *OutPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3], newx[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      this->InPoints->GetPoint(ptId, x);
+      this->Self->OperateOnPoint(x, newx);
+      this->OutPoints->SetPoint(ptId, newx);
+      }
+  }
+};
+
+// Classifies the cells, stores the connectivity size of the kept cells,
+// and marks their (merged) points as used. Several threads may store 1 for
+// the same point.
+struct vtkCleanPolyDataClassifyCells
+{
+  vtkPolyData *Input;
+  const vtkIdType *MergeMap;
+  vtkCleanPolyDataCellRules Rules;
+  signed char *Classes;
+  vtkIdType *Sizes;
+  vtkIdType *UsedPoints;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+  vtkSMPThreadLocal<std::vector<vtkIdType> > UpdatedPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellPtIds = this->CellPoints.Local();
+    std::vector<vtkIdType> &updatedPts = this->UpdatedPoints.Local();
+    const vtkIdType *pts;
+    vtkIdType npts, numNewPts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Input->GetCellPoints(cellId, npts, pts, cellPtIds);
+      updatedPts.resize(npts + 1);
+      int cellClass = this->Rules.Apply(cellId, npts, pts, this->MergeMap,
+                                        &updatedPts[0], numNewPts);
+      this->Classes[cellId] = static_cast<signed char>(cellClass);
+      this->Sizes[cellId] = numNewPts + 1;
+      for (vtkIdType i = 0; i < numNewPts; ++i)
+        {
+        this->UsedPoints[updatedPts[i]] = 1;
+        }
+      }
+  }
+};
+
+// Sets Values[i] to Sizes[i] (or 1 when Sizes is NULL) for the cells going
+// to the cell array Class, and to 0 for the others.
+struct vtkCleanPolyDataSelectCells
+{
+  const signed char *Classes;
+  int Class;
+  const vtkIdType *Sizes;
+  vtkIdType *Values;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Values[cellId] = (this->Classes[cellId] != this->Class ? 0 :
+                              (this->Sizes ? this->Sizes[cellId] : 1));
+      }
+  }
+};
+
+// Sets Out[i] to Base + Scanned[i] for the cells going to the cell array
+// Class.
+struct vtkCleanPolyDataAssignCells
+{
+  const signed char *Classes;
+  int Class;
+  const vtkIdType *Scanned;
+  vtkIdType Base;
+  vtkIdType *Out;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      if (this->Classes[cellId] == this->Class)
+        {
+        this->Out[cellId] = this->Base + this->Scanned[cellId];
+        }
+      }
+  }
+};
+
+// Writes the kept cells at their location in their output cell array.
+struct vtkCleanPolyDataFillCells
+{
+  vtkPolyData *Input;
+  const vtkIdType *MergeMap;
+  const vtkIdType *PointMap;
+  vtkCleanPolyDataCellRules Rules;
+  const signed char *Classes;
+  const vtkIdType *Locations;
+  vtkIdType *Connectivity[4];
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+  vtkSMPThreadLocal<std::vector<vtkIdType> > UpdatedPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellPtIds = this->CellPoints.Local();
+    std::vector<vtkIdType> &updatedPts = this->UpdatedPoints.Local();
+    const vtkIdType *pts;
+    vtkIdType npts, numNewPts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      int cellClass = this->Classes[cellId];
+      if (cellClass == vtkCleanPolyDataDropped)
+        {
+        continue;
+        }
+      this->Input->GetCellPoints(cellId, npts, pts, cellPtIds);
+      updatedPts.resize(npts + 1);
+      this->Rules.Apply(cellId, npts, pts, this->MergeMap, &updatedPts[0],
+                        numNewPts);
+      vtkIdType *cell =
+        this->Connectivity[cellClass] + this->Locations[cellId];
+      *cell++ = numNewPts;
+      for (vtkIdType i = 0; i < numNewPts; ++i)
+        {
+        *cell++ = this->PointMap[updatedPts[i]];
+        }
+      }
+  }
+};
+
+// Records the input point of each output point, from the prefix sums of
+// the used marks.
+struct vtkCleanPolyDataOriginalIds
+{
+  const vtkIdType *PointMap;
+  vtkIdType *OriginalIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      if (this->PointMap[ptId + 1] > this->PointMap[ptId])
+        {
+        this->OriginalIds[this->PointMap[ptId]] = ptId;
+        }
+      }
+  }
+};
+
+// Copies the kept points and their attributes.
+struct vtkCleanPolyDataCopyPoints
+{
+  vtkPoints *InPoints;
+  vtkPoints *OutPoints;
+  vtkPointData *InPD;
+  vtkPointData *OutPD;
+  const vtkIdType *OriginalIds;
+  bool CopyData;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      this->InPoints->GetPoint(this->OriginalIds[ptId], x);
+      this->OutPoints->SetPoint(ptId, x);
+      if (this->CopyData)
+        {
+        this->OutPD->CopyData(this->InPD, this->OriginalIds[ptId], ptId);
+        }
+      }
+  }
+};
+
+// Copies the attributes of the kept cells to their output cell.
+struct vtkCleanPolyDataCopyCellData
+{
+  vtkCellData *InCD;
+  vtkCellData *OutCD;
+  const signed char *Classes;
+  const vtkIdType *OutIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      if (this->Classes[cellId] != vtkCleanPolyDataDropped)
+        {
+        this->OutCD->CopyData(this->InCD, cellId, this->OutIds[cellId]);
+        }
+      }
+  }
+};
+}
+
 //--------------------------------------------------------------------------
 int vtkCleanPolyData::RequestData(
   vtkInformation *vtkNotUsed(request),
@@ -138,6 +447,10 @@ int vtkCleanPolyData::RequestData(
     vtkDebugMacro(<<"No data to Operate On!");
     return 1;
     }
+  if ( this->UseStaticLocator )
+    {
+    return this->MergeWithStaticLocator(input, output);
+    }
   vtkIdType *updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   vtkIdType numNewPts;
@@ -594,6 +907,229 @@ int vtkCleanPolyData::RequestData(
   return 1;
 }
 
+//--------------------------------------------------------------------------
+// Parallel path: the points are merged with a vtkStaticPointLocator, then
+// the cells are classified in a first pass, located in their output cell
+// array from prefix sums, and written in a second pass.
+int vtkCleanPolyData::MergeWithStaticLocator(vtkPolyData *input,
+                                             vtkPolyData *output)
+{
+  vtkPoints *inPts = input->GetPoints();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkPointData *inputPD = input->GetPointData();
+  vtkCellData *inputCD = input->GetCellData();
+  vtkPointData *outputPD = output->GetPointData();
+  vtkCellData *outputCD = output->GetCellData();
+
+  // The points, as operated on, in the output precision.
+  vtkPoints *opPts = inPts->NewInstance();
+  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+    {
+    opPts->SetDataType(inPts->GetDataType());
+    }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+    {
+    opPts->SetDataType(VTK_FLOAT);
+    }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+    {
+    opPts->SetDataType(VTK_DOUBLE);
+    }
+  opPts->SetNumberOfPoints(numPts);
+  vtkCleanPolyDataOperateOnPoints operate = { this, inPts, opPts };
+  vtkSMPTools::For(0, numPts, operate);
+
+  // Merge the points: mergeMap maps each point to the point it merges to.
+  std::vector<vtkIdType> mergeMap(numPts);
+  if ( this->PointMerging )
+    {
+    double tol = (this->ToleranceIsAbsolute ? this->AbsoluteTolerance :
+                  this->Tolerance*input->GetLength());
+    vtkPolyData *merged = vtkPolyData::New();
+    merged->SetPoints(opPts);
+    vtkStaticPointLocator *locator = vtkStaticPointLocator::New();
+    locator->SetDataSet(merged);
+    locator->BuildLocator();
+    locator->MergePoints(tol, &mergeMap[0]);
+    locator->Delete();
+    merged->Delete();
+    }
+  else
+    {
+    for (vtkIdType ptId=0; ptId < numPts; ptId++)
+      {
+      mergeMap[ptId] = ptId;
+      }
+    }
+  this->UpdateProgress(0.25);
+
+  // Classify the cells. Build the cells of the input from a single thread
+  // first.
+  vtkCleanPolyDataCellRules rules;
+  rules.FirstLine = input->GetNumberOfVerts();
+  rules.FirstPoly = rules.FirstLine + input->GetNumberOfLines();
+  rules.FirstStrip = rules.FirstPoly + input->GetNumberOfPolys();
+  rules.ConvertLinesToPoints = this->ConvertLinesToPoints;
+  rules.ConvertPolysToLines = this->ConvertPolysToLines;
+  rules.ConvertStripsToPolys = this->ConvertStripsToPolys;
+  if ( numCells > 0 )
+    {
+    vtkIdList *cellPts = vtkIdList::New();
+    input->GetCellPoints(0, cellPts);
+    cellPts->Delete();
+    }
+
+  std::vector<signed char> classes(numCells);
+  std::vector<vtkIdType> locations(numCells + 1);
+  std::vector<vtkIdType> pointMap(numPts + 1, 0);
+  vtkCleanPolyDataClassifyCells classify;
+  classify.Input = input;
+  classify.MergeMap = &mergeMap[0];
+  classify.Rules = rules;
+  classify.Classes = numCells ? &classes[0] : NULL;
+  classify.Sizes = &locations[0];
+  classify.UsedPoints = &pointMap[0];
+  vtkSMPTools::For(0, numCells, classify);
+  this->UpdateProgress(0.5);
+
+  // Number the used points in increasing order, and copy them.
+  vtkIdType numNewPts = vtkSMPTools::ExclusiveScan(pointMap.begin(),
+    pointMap.begin() + numPts, pointMap.begin(), static_cast<vtkIdType>(0));
+  pointMap[numPts] = numNewPts;
+  std::vector<vtkIdType> originalIds(numNewPts + 1);
+  vtkCleanPolyDataOriginalIds record = { &pointMap[0], &originalIds[0] };
+  vtkSMPTools::For(0, numPts, record);
+
+  vtkPoints *newPts = opPts->NewInstance();
+  newPts->SetDataType(opPts->GetDataType());
+  newPts->SetNumberOfPoints(numNewPts);
+  outputPD->CopyAllocate(inputPD, numNewPts);
+  bool parallelPD = vtkCleanPolyDataAreArraysThreadSafe(inputPD);
+  if ( parallelPD )
+    {
+    outputPD->SetNumberOfTuples(numNewPts);
+    }
+  vtkCleanPolyDataCopyPoints copyPoints =
+    { opPts, newPts, inputPD, outputPD, &originalIds[0], parallelPD };
+  vtkSMPTools::For(0, numNewPts, copyPoints);
+  if ( !parallelPD )
+    {
+    for (vtkIdType ptId=0; ptId < numNewPts; ptId++)
+      {
+      outputPD->CopyData(inputPD, originalIds[ptId], ptId);
+      }
+    }
+  output->SetPoints(newPts);
+  newPts->Delete();
+  opPts->Delete();
+
+  // Locate the cells in their output cell array: the output cell ids follow
+  // the verts, lines, polys and strips order, and each array keeps the
+  // order of the input cells.
+  std::vector<vtkIdType> outIds(numCells);
+  std::vector<vtkIdType> scanned(numCells);
+  vtkCellArray *newCells[4];
+  vtkIdType *connectivity[4];
+  vtkIdType numNewCells = 0;
+  for (int cellClass=0; cellClass < 4; cellClass++)
+    {
+    newCells[cellClass] = NULL;
+    connectivity[cellClass] = NULL;
+    if ( numCells == 0 )
+      {
+      continue;
+      }
+    vtkCleanPolyDataSelectCells select =
+      { &classes[0], cellClass, NULL, &scanned[0] };
+    vtkSMPTools::For(0, numCells, select);
+    vtkIdType numClassCells = vtkSMPTools::ExclusiveScan(scanned.begin(),
+      scanned.end(), scanned.begin(), static_cast<vtkIdType>(0));
+    if ( numClassCells == 0 )
+      {
+      continue;
+      }
+    vtkCleanPolyDataAssignCells assignIds =
+      { &classes[0], cellClass, &scanned[0], numNewCells, &outIds[0] };
+    vtkSMPTools::For(0, numCells, assignIds);
+    numNewCells += numClassCells;
+
+    select.Sizes = &locations[0];
+    vtkSMPTools::For(0, numCells, select);
+    vtkIdType size = vtkSMPTools::ExclusiveScan(scanned.begin(),
+      scanned.end(), scanned.begin(), static_cast<vtkIdType>(0));
+    vtkCleanPolyDataAssignCells assignLocations =
+      { &classes[0], cellClass, &scanned[0], 0, &locations[0] };
+    vtkSMPTools::For(0, numCells, assignLocations);
+
+    vtkIdTypeArray *cells = vtkIdTypeArray::New();
+    cells->SetNumberOfValues(size);
+    connectivity[cellClass] = cells->GetPointer(0);
+    newCells[cellClass] = vtkCellArray::New();
+    newCells[cellClass]->SetCells(numClassCells, cells);
+    cells->Delete();
+    }
+
+  vtkCleanPolyDataFillCells fill;
+  fill.Input = input;
+  fill.MergeMap = &mergeMap[0];
+  fill.PointMap = &pointMap[0];
+  fill.Rules = rules;
+  fill.Classes = numCells ? &classes[0] : NULL;
+  fill.Locations = &locations[0];
+  std::copy(connectivity, connectivity + 4, fill.Connectivity);
+  vtkSMPTools::For(0, numCells, fill);
+  this->UpdateProgress(0.75);
+
+  outputCD->CopyAllocate(inputCD, numNewCells);
+  if ( vtkCleanPolyDataAreArraysThreadSafe(inputCD) )
+    {
+    outputCD->SetNumberOfTuples(numNewCells);
+    vtkCleanPolyDataCopyCellData copyCD =
+      { inputCD, outputCD, fill.Classes, numCells ? &outIds[0] : NULL };
+    vtkSMPTools::For(0, numCells, copyCD);
+    }
+  else
+    {
+    for (vtkIdType cellId=0; cellId < numCells; cellId++)
+      {
+      if ( classes[cellId] != vtkCleanPolyDataDropped )
+        {
+        outputCD->CopyData(inputCD, cellId, outIds[cellId]);
+        }
+      }
+    }
+
+  vtkDebugMacro(<<"Removed " << numPts - numNewPts << " points and "
+                << numCells - numNewCells << " cells");
+
+  if ( newCells[vtkCleanPolyDataVerts] )
+    {
+    output->SetVerts(newCells[vtkCleanPolyDataVerts]);
+    }
+  if ( newCells[vtkCleanPolyDataLines] )
+    {
+    output->SetLines(newCells[vtkCleanPolyDataLines]);
+    }
+  if ( newCells[vtkCleanPolyDataPolys] )
+    {
+    output->SetPolys(newCells[vtkCleanPolyDataPolys]);
+    }
+  if ( newCells[vtkCleanPolyDataStrips] )
+    {
+    output->SetStrips(newCells[vtkCleanPolyDataStrips]);
+    }
+  for (int cellClass=0; cellClass < 4; cellClass++)
+    {
+    if ( newCells[cellClass] )
+      {
+      newCells[cellClass]->Delete();
+      }
+    }
+
+  return 1;
+}
+
 //--------------------------------------------------------------------------
 // Method manages creation of locators. It takes into account the potential
 // change of tolerance (zero to non-zero).
@@ -675,6 +1211,8 @@ void vtkCleanPolyData::PrintSelf(ostream& os, vtkIndent indent)
      << (this->PieceInvariant ? "On\n" : "Off\n");
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision
      << "\n";
+  os << indent << "UseStaticLocator: "
+     << (this->UseStaticLocator ? "On\n" : "Off\n");
 }
 
 //--------------------------------------------------------------------------
@@ -43,6 +43,11 @@
 // Note that merging of points can be disabled. In this case, a point locator
 // will not be used, and points that are not used by any cells will be
 // eliminated, but never merged.
+//
+// With UseStaticLocator on, the points are instead merged with a
+// vtkStaticPointLocator and the cells are rewritten with vtkSMPTools, which
+// scales to very large inputs. The merging then follows the point ids
+// rather than the order of the cells (see UseStaticLocator).
 
 // .SECTION Caveats
 // Merging points can alter topology, including introducing non-manifold
@@ -161,6 +166,19 @@ public:
   vtkSetMacro(OutputPointsPrecision,int);
   vtkGetMacro(OutputPointsPrecision,int);
 
+  // Description:
+  // Set/Get whether the points are merged in parallel with a
+  // vtkStaticPointLocator instead of being inserted one at a time into
+  // Locator. Each point is then merged to the lowest point id within the
+  // tolerance that is not merged itself (see
+  // vtkStaticPointLocator::MergePoints()), and the output points keep the
+  // order of the input points instead of the order in which the cells use
+  // them. OperateOnPoint() is called from several threads in this mode.
+  // The cells are converted as in the default mode. Off by default.
+  vtkSetMacro(UseStaticLocator,int);
+  vtkGetMacro(UseStaticLocator,int);
+  vtkBooleanMacro(UseStaticLocator,int);
+
 protected:
   vtkCleanPolyData();
  ~vtkCleanPolyData();
@@ -169,6 +187,9 @@ protected:
   virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
   virtual int RequestUpdateExtent(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
 
+  // Parallel implementation of RequestData() used with UseStaticLocator.
+  int MergeWithStaticLocator(vtkPolyData *input, vtkPolyData *output);
+
   int   PointMerging;
   double Tolerance;
   double AbsoluteTolerance;
@@ -180,6 +201,7 @@ protected:
 
   int PieceInvariant;
   int OutputPointsPrecision;
+  int UseStaticLocator;
 private:
   vtkCleanPolyData(const vtkCleanPolyData&);  // Not implemented.
   void operator=(const vtkCleanPolyData&);  // Not implemented.
@@ -16,6 +16,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityLabeler.h"
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -26,9 +27,13 @@
 #include "vtkPointData.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkIdTypeArray.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkConnectivityFilter);
 
 // Construct with default extraction mode to extract largest regions.
@@ -44,6 +49,8 @@ vtkConnectivityFilter::vtkConnectivityFilter()
 
   this->ClosestPoint[0] = this->ClosestPoint[1] = this->ClosestPoint[2] = 0.0;
 
+  this->LabelRegionsInParallel = 0;
+
   this->CellScalars = vtkFloatArray::New();
   this->CellScalars->Allocate(8);
 
@@ -55,6 +62,7 @@ vtkConnectivityFilter::vtkConnectivityFilter()
 
   this->NewScalars = 0;
   this->NewCellScalars = 0;
+  this->Links = 0;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 }
@@ -181,11 +189,47 @@ int vtkConnectivityFilter::RequestData(
 
   this->CellIds = vtkIdList::New();
   this->CellIds->Allocate(8, VTK_CELL_SIZE);
+
+  // Unstructured data sets are traversed with their (read-only) static
+  // links rather than building editable links on the input.
+  if ( vtkPolyData::SafeDownCast(input) ||
+       vtkUnstructuredGrid::SafeDownCast(input) )
+    {
+    this->Links = static_cast<vtkPointSet*>(input)->GetStaticCellLinks();
+    }
   this->PointIds = vtkIdList::New();
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
 
+  // The parallel union-find replaces the traversal when requested.
+  vtkConnectivityLabeler *labeler = NULL;
+  if ( this->LabelRegionsInParallel && this->Links )
+    {
+    labeler = new vtkConnectivityLabeler(static_cast<vtkPointSet*>(input));
+    if ( this->InScalars )
+      {
+      labeler->SetScalarCriterion(this->InScalars, this->ScalarRange, false);
+      }
+    }
+
   if ( this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
   this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
+  this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION &&
+  labeler )
+    { //label all cells, the first largest region is extracted
+    this->RegionNumber = labeler->LabelAllRegions(this->Visited,
+                                                  this->RegionSizes);
+    for (i=0; i < this->RegionNumber; i++)
+      {
+      if ( this->RegionSizes->GetValue(i) > maxCellsInRegion )
+        {
+        maxCellsInRegion = this->RegionSizes->GetValue(i);
+        largestRegionId = i;
+        }
+      }
+    this->UpdateProgress (0.9);
+    }
+  else if ( this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+  this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
   this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION )
     { //visit all cells marking with region number
     for (cellId=0; cellId < numCells; cellId++)
@@ -225,7 +269,7 @@ int vtkConnectivityFilter::RequestData(
         pt = this->Seeds->GetId(i);
         if ( pt >= 0 )
           {
-          input->GetPointCells(pt,this->CellIds);
+          this->GetPointCells(input,pt,this->CellIds);
           for (j=0; j < this->CellIds->GetNumberOfIds(); j++)
             {
             this->Wave->InsertNextId(this->CellIds->GetId(j));
@@ -258,7 +302,7 @@ int vtkConnectivityFilter::RequestData(
           minDist2 = dist2;
           }
         }
-      input->GetPointCells(minId,this->CellIds);
+      this->GetPointCells(input,minId,this->CellIds);
       for (j=0; j < this->CellIds->GetNumberOfIds(); j++)
         {
         this->Wave->InsertNextId(this->CellIds->GetId(j));
@@ -267,11 +311,30 @@ int vtkConnectivityFilter::RequestData(
     this->UpdateProgress (0.5);
 
     //mark all seeded regions
-    this->TraverseAndMark (input);
+    if ( labeler )
+      {
+      this->NumCellsInRegion = labeler->LabelSeededRegion(this->Wave,
+                                                          this->Visited);
+      }
+    else
+      {
+      this->TraverseAndMark (input);
+      }
     this->RegionSizes->InsertValue(this->RegionNumber,this->NumCellsInRegion);
     this->UpdateProgress (0.9);
     }
 
+  // The union-find does not number the points: they are numbered in the
+  // order of their ids.
+  if ( labeler )
+    {
+    std::copy(this->Visited, this->Visited + numCells,
+              this->NewCellScalars->GetPointer(0));
+    this->PointNumber = labeler->MapPoints(this->Visited, this->PointMap,
+                                           this->NewScalars->GetPointer(0));
+    delete labeler;
+    }
+
   vtkDebugMacro (<<"Extracted " << this->RegionNumber << " region(s)");
   this->Wave->Delete();
   this->Wave2->Delete();
@@ -418,6 +481,7 @@ int vtkConnectivityFilter::RequestData(
   delete [] this->PointMap;
   this->PointIds->Delete();
   this->CellIds->Delete();
+  this->Links = 0;
   output->Squeeze();
   vtkDataArray* outScalars = 0;
   if (this->ColorRegions && (outScalars=output->GetPointData()->GetScalars()))
@@ -439,6 +503,26 @@ int vtkConnectivityFilter::RequestData(
 }
 
 
+// Get the cells using a point, through the static links when available.
+//
+void vtkConnectivityFilter::GetPointCells(vtkDataSet *input, vtkIdType ptId,
+                                          vtkIdList *cellIds)
+{
+  if ( !this->Links )
+    {
+    input->GetPointCells(ptId, cellIds);
+    return;
+    }
+
+  vtkIdType ncells = this->Links->GetNumberOfCells(ptId);
+  const vtkIdType *cells = this->Links->GetCells(ptId);
+  cellIds->SetNumberOfIds(ncells);
+  for (vtkIdType i=0; i < ncells; i++)
+    {
+    cellIds->SetId(i, cells[i]);
+    }
+}
+
 // Mark current cell as visited and assign region number.  Note:
 // traversal occurs across shared vertices.
 //
@@ -469,7 +553,7 @@ void vtkConnectivityFilter::TraverseAndMark (vtkDataSet *input)
                                        this->RegionNumber);
             }
 
-          input->GetPointCells(ptId,this->CellIds);
+          this->GetPointCells(input,ptId,this->CellIds);
 
           // check connectivity criterion (geometric + scalar)
           numCells = this->CellIds->GetNumberOfIds();
@@ -597,5 +681,7 @@ void vtkConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision
      << "\n";
+  os << indent << "Label Regions In Parallel: "
+     << (this->LabelRegionsInParallel ? "On\n" : "Off\n");
 }
 
@@ -62,6 +62,7 @@ class vtkFloatArray;
 class vtkIdList;
 class vtkIdTypeArray;
 class vtkIntArray;
+class vtkStaticCellLinks;
 
 class VTKFILTERSCORE_EXPORT vtkConnectivityFilter : public vtkUnstructuredGridAlgorithm
 {
@@ -152,6 +153,17 @@ public:
   vtkSetMacro(OutputPointsPrecision,int);
   vtkGetMacro(OutputPointsPrecision,int);
 
+  // Description:
+  // Turn on/off labeling the regions of vtkPolyData and vtkUnstructuredGrid
+  // inputs with a parallel union-find over the cells (see
+  // vtkConnectivityLabeler) instead of the serial wave front traversal.
+  // Cells get the same region ids and the output cells are the same, but
+  // the output points are ordered by input point id rather than in the
+  // order the traversal reaches them. Off by default.
+  vtkSetMacro(LabelRegionsInParallel,int);
+  vtkGetMacro(LabelRegionsInParallel,int);
+  vtkBooleanMacro(LabelRegionsInParallel,int);
+
 protected:
   vtkConnectivityFilter();
   ~vtkConnectivityFilter();
@@ -172,6 +184,8 @@ protected:
   int ScalarConnectivity;
   double ScalarRange[2];
 
+  int LabelRegionsInParallel;
+
   void TraverseAndMark(vtkDataSet *input);
 
 private:
@@ -190,6 +204,9 @@ private:
   vtkIdList *Wave2;
   vtkIdList *PointIds;
   vtkIdList *CellIds;
+  vtkStaticCellLinks *Links;
+
+  void GetPointCells(vtkDataSet *input, vtkIdType ptId, vtkIdList *cellIds);
 private:
   vtkConnectivityFilter(const vtkConnectivityFilter&);  // Not implemented.
   void operator=(const vtkConnectivityFilter&);  // Not implemented.
@@ -0,0 +1,739 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectivityLabeler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkConnectivityLabeler.h"
+
+#include "vtkAtomic.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkPointSet.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+// Root of x, halving the path on the way. Roots are linked under the lowest
+// one, so that parent[x] <= x and the root of a tree is its lowest cell id.
+inline vtkIdType vtkConnectivityLabelerFind(vtkIdType *parent, vtkIdType x)
+{
+  while (parent[x] != x)
+    {
+    parent[x] = parent[parent[x]];
+    x = parent[x];
+    }
+  return x;
+}
+
+inline void vtkConnectivityLabelerUnite(vtkIdType *parent, vtkIdType a,
+                                        vtkIdType b)
+{
+  a = vtkConnectivityLabelerFind(parent, a);
+  b = vtkConnectivityLabelerFind(parent, b);
+  if (a < b)
+    {
+    parent[b] = a;
+    }
+  else if (b < a)
+    {
+    parent[a] = b;
+    }
+}
+
+// Two connected cells of different blocks, and the level of the merge tree
+// at which their blocks are first in the same group: the number of bits of
+// the xor of the block indices.
+struct vtkConnectivityLabelerEdge
+{
+  vtkIdType Cell;
+  vtkIdType Neighbor;
+  int Level;
+
+  bool operator<(const vtkConnectivityLabelerEdge& other) const
+    {
+    return this->Level < other.Level;
+    }
+};
+
+// Contiguous blocks of cells. At level l of the merge tree, group g is made
+// of blocks [g << l, (g + 1) << l).
+struct vtkConnectivityLabelerBlocks
+{
+  vtkIdType NumberOfCells;
+  vtkIdType BlockSize;
+  vtkIdType NumberOfBlocks;
+  int NumberOfLevels;
+
+  vtkConnectivityLabelerBlocks(vtkIdType numCells)
+    {
+    int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+    vtkIdType numBlocks = 8 * static_cast<vtkIdType>(numThreads > 0 ?
+                                                     numThreads : 1);
+    this->NumberOfCells = numCells;
+    this->BlockSize = std::max(static_cast<vtkIdType>(1024),
+                               (numCells + numBlocks - 1) / numBlocks);
+    this->NumberOfBlocks =
+      (numCells + this->BlockSize - 1) / this->BlockSize;
+    this->NumberOfLevels = this->GetLevel(0, this->NumberOfBlocks - 1);
+    }
+
+  vtkIdType GetBegin(vtkIdType block) const
+    {
+    return block * this->BlockSize;
+    }
+  vtkIdType GetEnd(vtkIdType block) const
+    {
+    return std::min(this->NumberOfCells, (block + 1) * this->BlockSize);
+    }
+  vtkIdType GetBlock(vtkIdType cellId) const
+    {
+    return cellId / this->BlockSize;
+    }
+  static int GetLevel(vtkIdType block1, vtkIdType block2)
+    {
+    int level = 0;
+    for (vtkIdType x = block1 ^ block2; x; x >>= 1)
+      {
+      ++level;
+      }
+    return level;
+    }
+};
+
+// Flag the cells meeting the scalar criterion.
+class vtkConnectivityLabelerValidCells
+{
+public:
+  vtkDataSet *Input;
+  vtkDataArray *Scalars;
+  const double *Range;
+  bool Full;
+  unsigned char *Valid;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+
+  void Initialize()
+    {
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdList *ptIds = this->PointIds.Local();
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+      double range[2] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        double s = this->Scalars->GetComponent(pts[i], 0);
+        range[0] = std::min(range[0], s);
+        range[1] = std::max(range[1], s);
+        }
+      if (this->Full)
+        {
+        this->Valid[cellId] =
+          range[0] >= this->Range[0] && range[1] <= this->Range[1];
+        }
+      else
+        {
+        this->Valid[cellId] =
+          range[1] >= this->Range[0] && range[0] <= this->Range[1];
+        }
+      }
+    }
+
+  void Reduce()
+    {
+    }
+};
+
+// Unite the valid cells of each block sharing a point, and collect the
+// connections to the cells of later blocks. Each cell is connected to the
+// next valid cell of each of its points, which chains all the valid cells
+// using a point.
+class vtkConnectivityLabelerUniteBlocks
+{
+public:
+  vtkDataSet *Input;
+  vtkStaticCellLinks *Links;
+  const unsigned char *Valid;
+  vtkIdType *Parent;
+  const vtkConnectivityLabelerBlocks *Blocks;
+  std::vector<vtkConnectivityLabelerEdge> *Edges;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+
+  void Initialize()
+    {
+    }
+
+  void operator()(vtkIdType beginBlock, vtkIdType endBlock)
+    {
+    vtkIdList *ptIds = this->PointIds.Local();
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+      {
+      vtkIdType begin = this->Blocks->GetBegin(block);
+      vtkIdType end = this->Blocks->GetEnd(block);
+      std::vector<vtkConnectivityLabelerEdge>& edges = this->Edges[block];
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+        {
+        this->Parent[cellId] = cellId;
+        }
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+        {
+        if (this->Valid && !this->Valid[cellId])
+          {
+          continue;
+          }
+        this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+        for (vtkIdType i = 0; i < npts; ++i)
+          {
+          vtkIdType ncells = this->Links->GetNumberOfCells(pts[i]);
+          const vtkIdType *cells = this->Links->GetCells(pts[i]);
+          const vtkIdType *next =
+            std::upper_bound(cells, cells + ncells, cellId);
+          while (next != cells + ncells && this->Valid && !this->Valid[*next])
+            {
+            ++next;
+            }
+          if (next == cells + ncells)
+            {
+            continue;
+            }
+          if (*next < end)
+            {
+            vtkConnectivityLabelerUnite(this->Parent, cellId, *next);
+            }
+          else
+            {
+            vtkConnectivityLabelerEdge edge;
+            edge.Cell = cellId;
+            edge.Neighbor = *next;
+            edge.Level = vtkConnectivityLabelerBlocks::GetLevel(
+              block, this->Blocks->GetBlock(*next));
+            edges.push_back(edge);
+            }
+          }
+        }
+      std::sort(edges.begin(), edges.end());
+      }
+    }
+
+  void Reduce()
+    {
+    }
+};
+
+// Unite the cells connected across the two halves of each group of blocks
+// of a level of the merge tree. The trees of a group only contain cells of
+// the group, so groups are merged concurrently.
+class vtkConnectivityLabelerMergeGroups
+{
+public:
+  vtkIdType *Parent;
+  const vtkConnectivityLabelerBlocks *Blocks;
+  const std::vector<vtkConnectivityLabelerEdge> *Edges;
+  int Level;
+
+  void operator()(vtkIdType beginGroup, vtkIdType endGroup) const
+    {
+    vtkConnectivityLabelerEdge key;
+    key.Level = this->Level;
+    for (vtkIdType group = beginGroup; group < endGroup; ++group)
+      {
+      vtkIdType begin = group << this->Level;
+      vtkIdType end = std::min(this->Blocks->NumberOfBlocks,
+        begin + (static_cast<vtkIdType>(1) << (this->Level - 1)));
+      for (vtkIdType block = begin; block < end; ++block)
+        {
+        const std::vector<vtkConnectivityLabelerEdge>& edges =
+          this->Edges[block];
+        std::vector<vtkConnectivityLabelerEdge>::const_iterator edge =
+          std::lower_bound(edges.begin(), edges.end(), key);
+        for (; edge != edges.end() && edge->Level == this->Level; ++edge)
+          {
+          vtkConnectivityLabelerUnite(this->Parent, edge->Cell,
+                                      edge->Neighbor);
+          }
+        }
+      }
+    }
+};
+
+// Copy the roots of the complete forest, which is only read.
+class vtkConnectivityLabelerRoots
+{
+public:
+  const vtkIdType *Parent;
+  vtkIdType *Roots;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      vtkIdType x = cellId;
+      while (this->Parent[x] != x)
+        {
+        x = this->Parent[x];
+        }
+      this->Roots[cellId] = x;
+      }
+    }
+};
+
+// For each valid cell, the lowest invalid cell sharing one of its points,
+// or the number of cells.
+class vtkConnectivityLabelerInvalidNeighbors
+{
+public:
+  vtkDataSet *Input;
+  vtkStaticCellLinks *Links;
+  const unsigned char *Valid;
+  vtkIdType NumberOfCells;
+  vtkIdType *Neighbors;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+
+  void Initialize()
+    {
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdList *ptIds = this->PointIds.Local();
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      vtkIdType lowest = this->NumberOfCells;
+      if (this->Valid[cellId])
+        {
+        this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+        for (vtkIdType i = 0; i < npts; ++i)
+          {
+          vtkIdType ncells = this->Links->GetNumberOfCells(pts[i]);
+          const vtkIdType *cells = this->Links->GetCells(pts[i]);
+          for (vtkIdType j = 0; j < ncells && cells[j] < lowest; ++j)
+            {
+            if (!this->Valid[cells[j]])
+              {
+              lowest = cells[j];
+              }
+            }
+          }
+        }
+      this->Neighbors[cellId] = lowest;
+      }
+    }
+
+  void Reduce()
+    {
+    }
+};
+
+// A cell starts a region of the wave front traversal when it is invalid,
+// or when it is the lowest cell of its component and no lower invalid cell
+// is connected to the component (which would have reached it first).
+class vtkConnectivityLabelerOwners
+{
+public:
+  const vtkIdType *Roots;
+  const vtkIdType *Neighbors; // lowest invalid neighbor of each root
+  const unsigned char *Valid;
+  vtkIdType *Owners;
+
+  vtkIdType GetOwner(vtkIdType cellId) const
+    {
+    if (!this->Valid)
+      {
+      return this->Roots[cellId];
+      }
+    if (!this->Valid[cellId])
+      {
+      return cellId;
+      }
+    vtkIdType root = this->Roots[cellId];
+    return std::min(root, this->Neighbors[root]);
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Owners[cellId] = this->GetOwner(cellId) == cellId ? 1 : 0;
+      }
+    }
+};
+
+// Replace the roots by the region numbers, the scanned owner flags of the
+// owners, and count the cells of each region.
+class vtkConnectivityLabelerNumberRegions
+{
+public:
+  vtkConnectivityLabelerOwners Owners;
+  const vtkIdType *Numbers;
+  vtkIdType *RegionIds;
+  vtkAtomic<vtkIdType> *Sizes;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      vtkIdType region = this->Numbers[this->Owners.GetOwner(cellId)];
+      this->RegionIds[cellId] = region;
+      ++this->Sizes[region];
+      }
+    }
+};
+
+// Keep the seed cells and the valid cells of the flagged components.
+class vtkConnectivityLabelerSeededCells
+{
+public:
+  const vtkIdType *Flags;
+  const unsigned char *Valid;
+  vtkIdType *RegionIds;
+  vtkSMPThreadLocal<vtkIdType> Counts;
+  vtkIdType Count;
+
+  void Initialize()
+    {
+    this->Counts.Local() = 0;
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdType& count = this->Counts.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      bool seeded = (this->Flags[cellId] & 2) != 0 ||
+        ((!this->Valid || this->Valid[cellId]) &&
+         (this->Flags[this->RegionIds[cellId]] & 1) != 0);
+      this->RegionIds[cellId] = seeded ? 0 : -1;
+      count += seeded ? 1 : 0;
+      }
+    }
+
+  void Reduce()
+    {
+    this->Count = 0;
+    vtkSMPThreadLocal<vtkIdType>::iterator iter;
+    for (iter = this->Counts.begin(); iter != this->Counts.end(); ++iter)
+      {
+      this->Count += *iter;
+      }
+    }
+};
+
+// Lowest region of the cells using each point, or -1.
+class vtkConnectivityLabelerPointRegions
+{
+public:
+  vtkStaticCellLinks *Links;
+  const vtkIdType *RegionIds;
+  vtkIdType *PointMap;
+  vtkIdType *Used;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      vtkIdType ncells = this->Links->GetNumberOfCells(ptId);
+      const vtkIdType *cells = this->Links->GetCells(ptId);
+      vtkIdType region = -1;
+      for (vtkIdType i = 0; i < ncells; ++i)
+        {
+        vtkIdType r = this->RegionIds[cells[i]];
+        if (r >= 0 && (region < 0 || r < region))
+          {
+          region = r;
+          }
+        }
+      this->PointMap[ptId] = region;
+      this->Used[ptId] = region >= 0 ? 1 : 0;
+      }
+    }
+};
+
+class vtkConnectivityLabelerMapPoints
+{
+public:
+  const vtkIdType *NewIds;
+  vtkIdType *PointMap;
+  vtkIdType *PointRegionIds;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      if (this->PointMap[ptId] >= 0)
+        {
+        this->PointRegionIds[this->NewIds[ptId]] = this->PointMap[ptId];
+        this->PointMap[ptId] = this->NewIds[ptId];
+        }
+      }
+    }
+};
+
+}
+
+//----------------------------------------------------------------------------
+vtkConnectivityLabeler::vtkConnectivityLabeler(vtkPointSet *input)
+{
+  this->Input = input;
+  this->NumberOfCells = input->GetNumberOfCells();
+  this->NumberOfPoints = input->GetNumberOfPoints();
+  this->Links = input->GetStaticCellLinks();
+  this->Scalars = NULL;
+  this->ScalarRange[0] = 0.0;
+  this->ScalarRange[1] = 1.0;
+  this->FullScalarRange = false;
+  this->Valid = NULL;
+  this->Parent = new vtkIdType[this->NumberOfCells];
+
+  // Cells of polygonal data are built on first access.
+  if (this->NumberOfCells > 0)
+    {
+    vtkIdList *ptIds = vtkIdList::New();
+    vtkIdType npts;
+    const vtkIdType *pts;
+    input->GetCellPoints(0, npts, pts, ptIds);
+    ptIds->Delete();
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkConnectivityLabeler::~vtkConnectivityLabeler()
+{
+  delete [] this->Valid;
+  delete [] this->Parent;
+}
+
+//----------------------------------------------------------------------------
+void vtkConnectivityLabeler::SetScalarCriterion(vtkDataArray *scalars,
+                                                const double range[2],
+                                                bool full)
+{
+  this->Scalars = scalars;
+  this->ScalarRange[0] = range[0];
+  this->ScalarRange[1] = range[1];
+  this->FullScalarRange = full;
+}
+
+//----------------------------------------------------------------------------
+void vtkConnectivityLabeler::InsertPointCells(vtkIdType ptId,
+                                              vtkIdList *cellIds)
+{
+  vtkIdType ncells = this->Links->GetNumberOfCells(ptId);
+  const vtkIdType *cells = this->Links->GetCells(ptId);
+  for (vtkIdType i = 0; i < ncells; ++i)
+    {
+    cellIds->InsertNextId(cells[i]);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkConnectivityLabeler::LabelComponents(vtkIdType *roots)
+{
+  delete [] this->Valid;
+  this->Valid = NULL;
+  if (this->Scalars)
+    {
+    this->Valid = new unsigned char[this->NumberOfCells];
+    vtkConnectivityLabelerValidCells valid;
+    valid.Input = this->Input;
+    valid.Scalars = this->Scalars;
+    valid.Range = this->ScalarRange;
+    valid.Full = this->FullScalarRange;
+    valid.Valid = this->Valid;
+    vtkSMPTools::For(0, this->NumberOfCells, valid);
+    }
+
+  vtkConnectivityLabelerBlocks blocks(this->NumberOfCells);
+  std::vector<std::vector<vtkConnectivityLabelerEdge> >
+    edges(blocks.NumberOfBlocks);
+  vtkConnectivityLabelerUniteBlocks unite;
+  unite.Input = this->Input;
+  unite.Links = this->Links;
+  unite.Valid = this->Valid;
+  unite.Parent = this->Parent;
+  unite.Blocks = &blocks;
+  unite.Edges = edges.empty() ? NULL : &edges[0];
+  vtkSMPTools::For(0, blocks.NumberOfBlocks, 1, unite);
+
+  vtkConnectivityLabelerMergeGroups merge;
+  merge.Parent = this->Parent;
+  merge.Blocks = &blocks;
+  merge.Edges = unite.Edges;
+  for (int level = 1; level <= blocks.NumberOfLevels; ++level)
+    {
+    vtkIdType groupSize = static_cast<vtkIdType>(1) << level;
+    merge.Level = level;
+    vtkSMPTools::For(0, (blocks.NumberOfBlocks + groupSize - 1) / groupSize,
+                     1, merge);
+    }
+
+  vtkConnectivityLabelerRoots rootsFunctor;
+  rootsFunctor.Parent = this->Parent;
+  rootsFunctor.Roots = roots;
+  vtkSMPTools::For(0, this->NumberOfCells, rootsFunctor);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkConnectivityLabeler::LabelAllRegions(vtkIdType *regionIds,
+                                                  vtkIdTypeArray *regionSizes)
+{
+  regionSizes->Reset();
+  if (this->NumberOfCells < 1)
+    {
+    return 0;
+    }
+  this->LabelComponents(regionIds);
+
+  // The forest is no longer needed: it receives the lowest invalid neighbor
+  // of the components, folded onto their roots (roots are lower than the
+  // other cells of their component, so they are reached first).
+  vtkIdType *neighbors = this->Parent;
+  if (this->Valid)
+    {
+    vtkConnectivityLabelerInvalidNeighbors invalid;
+    invalid.Input = this->Input;
+    invalid.Links = this->Links;
+    invalid.Valid = this->Valid;
+    invalid.NumberOfCells = this->NumberOfCells;
+    invalid.Neighbors = neighbors;
+    vtkSMPTools::For(0, this->NumberOfCells, invalid);
+    for (vtkIdType cellId = 0; cellId < this->NumberOfCells; ++cellId)
+      {
+      vtkIdType root = regionIds[cellId];
+      if (this->Valid[cellId] && neighbors[cellId] < neighbors[root])
+        {
+        neighbors[root] = neighbors[cellId];
+        }
+      }
+    }
+
+  // Regions are numbered in the order of the cells starting them.
+  vtkIdType *numbers = new vtkIdType[this->NumberOfCells];
+  vtkConnectivityLabelerOwners owners;
+  owners.Roots = regionIds;
+  owners.Neighbors = neighbors;
+  owners.Valid = this->Valid;
+  owners.Owners = numbers;
+  vtkSMPTools::For(0, this->NumberOfCells, owners);
+  vtkIdType numRegions = vtkSMPTools::ExclusiveScan(
+    numbers, numbers + this->NumberOfCells, numbers,
+    static_cast<vtkIdType>(0));
+
+  vtkAtomic<vtkIdType> *sizes = new vtkAtomic<vtkIdType>[numRegions];
+  vtkConnectivityLabelerNumberRegions number;
+  number.Owners = owners;
+  number.Numbers = numbers;
+  number.RegionIds = regionIds;
+  number.Sizes = sizes;
+  vtkSMPTools::For(0, this->NumberOfCells, number);
+
+  regionSizes->SetNumberOfValues(numRegions);
+  for (vtkIdType region = 0; region < numRegions; ++region)
+    {
+    regionSizes->SetValue(region, sizes[region]);
+    }
+  delete [] sizes;
+  delete [] numbers;
+  return numRegions;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkConnectivityLabeler::LabelSeededRegion(vtkIdList *seedCells,
+                                                    vtkIdType *regionIds)
+{
+  if (this->NumberOfCells < 1)
+    {
+    return 0;
+    }
+  this->LabelComponents(regionIds);
+
+  // Flag the seeds (2) and the components they reach (1, on the root).
+  vtkIdType *flags = this->Parent;
+  vtkSMPTools::Fill(flags, flags + this->NumberOfCells,
+                    static_cast<vtkIdType>(0));
+  vtkIdList *ptIds = vtkIdList::New();
+  vtkIdType npts;
+  const vtkIdType *pts;
+  for (vtkIdType i = 0; i < seedCells->GetNumberOfIds(); ++i)
+    {
+    vtkIdType seed = seedCells->GetId(i);
+    if (seed < 0 || seed >= this->NumberOfCells)
+      {
+      continue;
+      }
+    flags[seed] |= 2;
+    this->Input->GetCellPoints(seed, npts, pts, ptIds);
+    for (vtkIdType j = 0; j < npts; ++j)
+      {
+      vtkIdType ncells = this->Links->GetNumberOfCells(pts[j]);
+      const vtkIdType *cells = this->Links->GetCells(pts[j]);
+      for (vtkIdType k = 0; k < ncells; ++k)
+        {
+        if (!this->Valid || this->Valid[cells[k]])
+          {
+          flags[regionIds[cells[k]]] |= 1;
+          }
+        }
+      }
+    }
+  ptIds->Delete();
+
+  vtkConnectivityLabelerSeededCells seeded;
+  seeded.Flags = flags;
+  seeded.Valid = this->Valid;
+  seeded.RegionIds = regionIds;
+  vtkSMPTools::For(0, this->NumberOfCells, seeded);
+  return seeded.Count;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkConnectivityLabeler::MapPoints(const vtkIdType *regionIds,
+                                            vtkIdType *pointMap,
+                                            vtkIdType *pointRegionIds)
+{
+  if (this->NumberOfPoints < 1)
+    {
+    return 0;
+    }
+  vtkIdType *newIds = new vtkIdType[this->NumberOfPoints];
+  vtkConnectivityLabelerPointRegions regions;
+  regions.Links = this->Links;
+  regions.RegionIds = regionIds;
+  regions.PointMap = pointMap;
+  regions.Used = newIds;
+  vtkSMPTools::For(0, this->NumberOfPoints, regions);
+  vtkIdType numPts = vtkSMPTools::ExclusiveScan(
+    newIds, newIds + this->NumberOfPoints, newIds, static_cast<vtkIdType>(0));
+
+  vtkConnectivityLabelerMapPoints map;
+  map.NewIds = newIds;
+  map.PointMap = pointMap;
+  map.PointRegionIds = pointRegionIds;
+  vtkSMPTools::For(0, this->NumberOfPoints, map);
+  delete [] newIds;
+  return numPts;
+}
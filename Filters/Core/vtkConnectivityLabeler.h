@@ -0,0 +1,107 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectivityLabeler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkConnectivityLabeler - label connected regions of cells in parallel
+// .SECTION Description
+// vtkConnectivityLabeler is a utility class used by the connectivity filters
+// to label the regions of cells sharing points of a vtkPolyData or a
+// vtkUnstructuredGrid in parallel (via vtkSMPTools). The regions are
+// numbered as the wave front traversal of the filters numbers them, and
+// the scalar connectivity criterion of the filters is supported.
+//
+// Labels are computed with a union-find over the cells, through the static
+// cell links of the data set. The cells are split in contiguous blocks
+// united independently, then neighboring groups of blocks are merged up a
+// binary tree; each merge only touches the cells of its group, so no lock
+// nor atomic operation is needed and the result does not depend on the
+// number of threads.
+// .SECTION See Also
+// vtkConnectivityFilter vtkPolyDataConnectivityFilter
+
+#ifndef vtkConnectivityLabeler_h
+#define vtkConnectivityLabeler_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkType.h" // For vtkIdType
+
+class vtkDataArray;
+class vtkDataSet;
+class vtkIdList;
+class vtkIdTypeArray;
+class vtkPointSet;
+class vtkStaticCellLinks;
+
+class VTKFILTERSCORE_EXPORT vtkConnectivityLabeler
+{
+public:
+  // Description:
+  // The input must be a vtkPolyData or a vtkUnstructuredGrid. Its static
+  // cell links and its cells are built, if needed, by the constructor.
+  vtkConnectivityLabeler(vtkPointSet *input);
+  ~vtkConnectivityLabeler();
+
+  // Description:
+  // Only connect the cells whose point scalars (first component) overlap
+  // range or, when full is true, lie in range. Other cells only belong to
+  // the region they start, as with the ScalarConnectivity of the filters.
+  void SetScalarCriterion(vtkDataArray *scalars, const double range[2],
+                          bool full);
+
+  // Description:
+  // Append the ids of the cells using point ptId to cellIds.
+  void InsertPointCells(vtkIdType ptId, vtkIdList *cellIds);
+
+  // Description:
+  // Set regionIds to the region number of each cell and regionSizes to the
+  // number of cells of each region. Return the number of regions.
+  vtkIdType LabelAllRegions(vtkIdType *regionIds, vtkIdTypeArray *regionSizes);
+
+  // Description:
+  // Set regionIds to 0 for the seed cells and the cells connected to them,
+  // and to -1 for the other cells. Return the number of cells of region 0.
+  vtkIdType LabelSeededRegion(vtkIdList *seedCells, vtkIdType *regionIds);
+
+  // Description:
+  // Number the points of the cells with a non-negative region id in
+  // increasing order of their ids. pointMap receives the new id of each
+  // point (-1 for the others) and pointRegionIds, indexed by new id, the
+  // lowest region id of the cells using the point. Return the number of
+  // points.
+  vtkIdType MapPoints(const vtkIdType *regionIds, vtkIdType *pointMap,
+                      vtkIdType *pointRegionIds);
+
+private:
+  // Not implemented
+  vtkConnectivityLabeler(const vtkConnectivityLabeler&);
+  vtkConnectivityLabeler& operator=(const vtkConnectivityLabeler&);
+
+  // Set roots[cellId] to the lowest cell id of the connected cells meeting
+  // the scalar criterion (or to cellId for the other cells).
+  void LabelComponents(vtkIdType *roots);
+
+  vtkDataSet *Input;
+  vtkStaticCellLinks *Links;
+  vtkIdType NumberOfCells;
+  vtkIdType NumberOfPoints;
+
+  vtkDataArray *Scalars;
+  double ScalarRange[2];
+  bool FullScalarRange;
+  unsigned char *Valid; // cells meeting the scalar criterion
+
+  vtkIdType *Parent; // union-find forest, then scratch space
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkConnectivityLabeler.h
@@ -21,8 +21,10 @@
 #include "vtkContourGrid.h"
 #include "vtkContourValues.h"
 #include "vtkCutter.h"
+#include "vtkFlyingEdges3D.h"
 #include "vtkGarbageCollector.h"
 #include "vtkGenericCell.h"
+#include "vtkGridFlyingEdges3D.h"
 #include "vtkGridSynchronizedTemplates3D.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -35,6 +37,7 @@
 #include "vtkPolyDataNormals.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearSynchronizedTemplates.h"
+#include "vtkSMPTools.h"
 #include "vtkSpanSpace.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
@@ -50,6 +53,41 @@
 vtkStandardNewMacro(vtkContourFilter);
 vtkCxxSetObjectMacro(vtkContourFilter,ScalarTree,vtkScalarTree);
 
+namespace
+{
+// Whether the flying edges filters may contour input in parallel with the
+// same output arrays as the synchronized templates filters, which also
+// generate polygons and copy the cell data.
+bool vtkContourFilterCanUseFlyingEdges(vtkContourFilter *self,
+                                       vtkDataSet *input,
+                                       vtkDataArray *scalars)
+{
+  return self->GetUseParallelAlgorithms() &&
+    vtkSMPTools::GetEstimatedNumberOfThreads() > 1 &&
+    self->GetGenerateTriangles() && scalars->HasStandardMemoryLayout() &&
+    input->GetCellData()->GetNumberOfArrays() == 0;
+}
+
+// The grids are contoured over their whole extent, and their point data is
+// interpolated.
+bool vtkContourFilterCanUseGridFlyingEdges(vtkContourFilter *self,
+                                           vtkDataSet *input,
+                                           const int *inExt,
+                                           const int *uExt,
+                                           vtkDataArray *scalars)
+{
+  for (int i = 0; i < 6; ++i)
+    {
+    if (inExt[i] != uExt[i])
+      {
+      return false;
+      }
+    }
+  return vtkContourFilterCanUseFlyingEdges(self, input, scalars) &&
+    self->GetOutputPointsPrecision() == vtkAlgorithm::DEFAULT_PRECISION;
+}
+}
+
 //-----------------------------------------------------------------------------
 // Construct object with initial range (0,1) and single contour value
 // of 0.0.
@@ -72,11 +110,14 @@ vtkContourFilter::vtkContourFilter()
   this->OutputPointsPrecision = DEFAULT_PRECISION;
 
   this->GenerateTriangles = 1;
+  this->UseParallelAlgorithms = 0;
 
   this->SynchronizedTemplates2D = vtkSynchronizedTemplates2D::New();
   this->SynchronizedTemplates3D = vtkSynchronizedTemplates3D::New();
   this->GridSynchronizedTemplates = vtkGridSynchronizedTemplates3D::New();
   this->RectilinearSynchronizedTemplates = vtkRectilinearSynchronizedTemplates::New();
+  this->FlyingEdges3D = vtkFlyingEdges3D::New();
+  this->GridFlyingEdges3D = vtkGridFlyingEdges3D::New();
 
   this->InternalProgressCallbackCommand = vtkCallbackCommand::New();
   this->InternalProgressCallbackCommand->SetCallback(
@@ -91,6 +132,10 @@ vtkContourFilter::vtkContourFilter()
                                                this->InternalProgressCallbackCommand);
   this->RectilinearSynchronizedTemplates->AddObserver(vtkCommand::ProgressEvent,
                                                       this->InternalProgressCallbackCommand);
+  this->FlyingEdges3D->AddObserver(vtkCommand::ProgressEvent,
+                                   this->InternalProgressCallbackCommand);
+  this->GridFlyingEdges3D->AddObserver(vtkCommand::ProgressEvent,
+                                       this->InternalProgressCallbackCommand);
 
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
@@ -115,6 +160,8 @@ vtkContourFilter::~vtkContourFilter()
   this->SynchronizedTemplates3D->Delete();
   this->GridSynchronizedTemplates->Delete();
   this->RectilinearSynchronizedTemplates->Delete();
+  this->FlyingEdges3D->Delete();
+  this->GridFlyingEdges3D->Delete();
   this->InternalProgressCallbackCommand->Delete();
 }
 
@@ -318,6 +365,24 @@ int vtkContourFilter::RequestData(
       return
         this->SynchronizedTemplates2D->ProcessRequest(request,inputVector,outputVector);
       }
+    else if ( dim == 3 &&
+              input->GetPointData()->GetNumberOfArrays() == 1 &&
+              vtkContourFilterCanUseFlyingEdges(this, input, inScalars) )
+      {
+      this->FlyingEdges3D->SetNumberOfContours(numContours);
+      for (i=0; i < numContours; i++)
+        {
+        this->FlyingEdges3D->SetValue(i,values[i]);
+        }
+      this->FlyingEdges3D->SetComputeNormals(this->ComputeNormals);
+      this->FlyingEdges3D->SetComputeGradients(this->ComputeGradients);
+      this->FlyingEdges3D->SetComputeScalars(this->ComputeScalars);
+      this->FlyingEdges3D->SetArrayComponent(this->GetArrayComponent());
+      this->FlyingEdges3D->
+        SetInputArrayToProcess(0,this->GetInputArrayInformation(0));
+
+      return this->FlyingEdges3D->ProcessRequest(request,inputVector,outputVector);
+      }
     else if ( dim == 3 )
       {
       this->SynchronizedTemplates3D->SetNumberOfContours(numContours);
@@ -343,6 +408,13 @@ int vtkContourFilter::RequestData(
     // if 3D
     if (uExt[0] < uExt[1] && uExt[2] < uExt[3] && uExt[4] < uExt[5])
       {
+      if (vtkContourFilterCanUseGridFlyingEdges(
+            this, input, vtkRectilinearGrid::SafeDownCast(input)->GetExtent(),
+            uExt, inScalars))
+        {
+        return this->ExecuteGridFlyingEdges(this->GetArrayComponent(),request,
+                                            inputVector,outputVector);
+        }
       this->RectilinearSynchronizedTemplates->SetNumberOfContours(numContours);
       for (i=0; i < numContours; i++)
         {
@@ -366,6 +438,12 @@ int vtkContourFilter::RequestData(
     // if 3D
     if (uExt[0] < uExt[1] && uExt[2] < uExt[3] && uExt[4] < uExt[5])
       {
+      if (vtkContourFilterCanUseGridFlyingEdges(
+            this, input, vtkStructuredGrid::SafeDownCast(input)->GetExtent(),
+            uExt, inScalars))
+        {
+        return this->ExecuteGridFlyingEdges(0,request,inputVector,outputVector);
+        }
       this->GridSynchronizedTemplates->SetNumberOfContours(numContours);
       for (i=0; i < numContours; i++)
         {
@@ -713,12 +791,37 @@ void vtkContourFilter::CreateDefaultLocator()
     }
 }
 
+//-----------------------------------------------------------------------------
+// Contour a 3D rectilinear or structured grid with vtkGridFlyingEdges3D.
+int vtkContourFilter::ExecuteGridFlyingEdges(int arrayComponent,
+                                             vtkInformation* request,
+                                             vtkInformationVector** inputVector,
+                                             vtkInformationVector* outputVector)
+{
+  int numContours = this->ContourValues->GetNumberOfContours();
+  this->GridFlyingEdges3D->SetNumberOfContours(numContours);
+  for (int i=0; i < numContours; i++)
+    {
+    this->GridFlyingEdges3D->SetValue(i,this->ContourValues->GetValue(i));
+    }
+  this->GridFlyingEdges3D->SetComputeNormals(this->ComputeNormals);
+  this->GridFlyingEdges3D->SetComputeGradients(this->ComputeGradients);
+  this->GridFlyingEdges3D->SetComputeScalars(this->ComputeScalars);
+  this->GridFlyingEdges3D->SetArrayComponent(arrayComponent);
+  this->GridFlyingEdges3D->InterpolateAttributesOn();
+  this->GridFlyingEdges3D->
+    SetInputArrayToProcess(0,this->GetInputArrayInformation(0));
+  return this->GridFlyingEdges3D->
+    ProcessRequest(request,inputVector,outputVector);
+}
+
 //-----------------------------------------------------------------------------
 void vtkContourFilter::SetArrayComponent( int comp )
 {
   this->SynchronizedTemplates2D->SetArrayComponent( comp );
   this->SynchronizedTemplates3D->SetArrayComponent( comp );
   this->RectilinearSynchronizedTemplates->SetArrayComponent( comp );
+  this->FlyingEdges3D->SetArrayComponent( comp );
 }
 
 //-----------------------------------------------------------------------------
@@ -782,6 +885,8 @@ void vtkContourFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Precision of the output points: "
      << this->OutputPointsPrecision << "\n";
+  os << indent << "Use Parallel Algorithms: "
+     << (this->UseParallelAlgorithms ? "On\n" : "Off\n");
 }
 
 //----------------------------------------------------------------------------
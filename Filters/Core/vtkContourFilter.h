@@ -55,6 +55,8 @@ class vtkSynchronizedTemplates2D;
 class vtkSynchronizedTemplates3D;
 class vtkGridSynchronizedTemplates3D;
 class vtkRectilinearSynchronizedTemplates;
+class vtkFlyingEdges3D;
+class vtkGridFlyingEdges3D;
 class vtkCallbackCommand;
 
 class VTKFILTERSCORE_EXPORT vtkContourFilter : public vtkPolyDataAlgorithm
@@ -152,6 +154,20 @@ public:
   vtkGetMacro(GenerateTriangles,int);
   vtkBooleanMacro(GenerateTriangles,int);
 
+  // Description:
+  // Set/Get whether 3D vtkImageData, vtkRectilinearGrid and
+  // vtkStructuredGrid inputs are contoured with the parallel flying edges
+  // filters (vtkFlyingEdges3D and vtkGridFlyingEdges3D) instead of the
+  // synchronized templates filters, when vtkSMPTools runs on more than one
+  // thread and the output keeps the same arrays: GenerateTriangles is on,
+  // the input has no cell data, the precision of the output points is the
+  // default one, and, for images, the contoured array is the only point
+  // array. The surfaces are the same, but their points are ordered
+  // differently. Off by default.
+  vtkSetMacro(UseParallelAlgorithms,int);
+  vtkGetMacro(UseParallelAlgorithms,int);
+  vtkBooleanMacro(UseParallelAlgorithms,int);
+
   // Description:
   // Set/get the desired precision for the output types. See the documentation
   // for the vtkAlgorithm::Precision enum for an explanation of the available
@@ -173,6 +189,13 @@ protected:
                                   vtkInformationVector*);
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  // Description:
+  // Contour a 3D rectilinear or structured grid with GridFlyingEdges3D,
+  // contouring the given component of the scalars.
+  int ExecuteGridFlyingEdges(int arrayComponent, vtkInformation* request,
+                             vtkInformationVector** inputVector,
+                             vtkInformationVector* outputVector);
+
   vtkContourValues *ContourValues;
   int ComputeNormals;
   int ComputeGradients;
@@ -182,11 +205,14 @@ protected:
   vtkScalarTree *ScalarTree;
   int OutputPointsPrecision;
   int GenerateTriangles;
+  int UseParallelAlgorithms;
 
   vtkSynchronizedTemplates2D *SynchronizedTemplates2D;
   vtkSynchronizedTemplates3D *SynchronizedTemplates3D;
   vtkGridSynchronizedTemplates3D *GridSynchronizedTemplates;
   vtkRectilinearSynchronizedTemplates *RectilinearSynchronizedTemplates;
+  vtkFlyingEdges3D *FlyingEdges3D;
+  vtkGridFlyingEdges3D *GridFlyingEdges3D;
   vtkCallbackCommand *InternalProgressCallbackCommand;
 
   static void InternalProgressCallbackFunction(vtkObject *caller,
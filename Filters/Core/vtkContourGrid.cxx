@@ -32,6 +32,7 @@
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnstructuredGridBase.h"
+#include "vtkUnstructuredGrid.h"
 #include "vtkCutter.h"
 #include "vtkMergePoints.h"
 #include "vtkPointLocator.h"
@@ -234,9 +235,21 @@ void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
     unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
     vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
     int dimensionality;
+    // Grids of a single cell type need one pass only.
+    vtkUnstructuredGrid *ugrid = vtkUnstructuredGrid::SafeDownCast(input);
+    int singleCellType = (ugrid ? ugrid->GetSingleCellType() : -1);
+    if (singleCellType >= VTK_NUMBER_OF_CELL_TYPES)
+      {
+      singleCellType = -1;
+      }
     // We skip 0d cells (points), because they cannot be cut (generate no data).
     for (dimensionality = 1; dimensionality <= 3; ++dimensionality)
       {
+      if (singleCellType >= 0 &&
+          cellTypeDimensions[singleCellType] != dimensionality)
+        {
+        continue;
+        }
       // Loop over all cells; get scalar values for all cell points
       // and process each cell.
       //
@@ -415,15 +428,17 @@ int vtkContourGrid::RequestData(
     return 1;
     }
 
-  // Create scalar tree if necessary and if requested
+  // Create scalar tree if necessary and if requested. The tree is kept
+  // so that it is only rebuilt when the input changes, not when the
+  // contour values do.
   int useScalarTree = this->GetUseScalarTree();
+  if ( useScalarTree && this->ScalarTree == NULL )
+    {
+    this->ScalarTree = vtkSimpleScalarTree::New();
+    }
   vtkScalarTree *scalarTree = this->ScalarTree;
   if ( useScalarTree )
     {
-    if ( scalarTree == NULL )
-      {
-      scalarTree = vtkSimpleScalarTree::New();
-      }
     scalarTree->SetDataSet(input);
     scalarTree->SetScalars(inScalars);
     }
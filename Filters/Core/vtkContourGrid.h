@@ -118,6 +118,10 @@ public:
   // Description:
   // Specify the instance of vtkScalarTree to use. If not specified
   // and UseScalarTree is enabled, then a vtkSimpleScalarTree will be used.
+  // A vtkSpanSpace may be used instead; it is built in parallel and
+  // scales better to large grids. The tree is retained between
+  // executions and only rebuilt when the input changes, so changing
+  // the contour values does not pay for a new tree.
   void SetScalarTree(vtkScalarTree *sTree);
   vtkGetObjectMacro(ScalarTree,vtkScalarTree);
 
@@ -22,12 +22,15 @@
 #include "vtkDoubleArray.h"
 #include "vtkDataArrayIteratorMacro.h"
 #include "vtkFloatArray.h"
+#include "vtkFlyingEdgesPlaneCutter.h"
 #include "vtkGenericCell.h"
+#include "vtkGridFlyingEdgesPlaneCutter.h"
 #include "vtkGridSynchronizedTemplates3D.h"
 #include "vtkImageData.h"
 #include "vtkImplicitFunction.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMath.h"
 #include "vtkMergePoints.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
@@ -36,6 +39,7 @@
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearSynchronizedTemplates.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
@@ -44,16 +48,19 @@
 #include "vtkUnstructuredGridBase.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkIncrementalPointLocator.h"
+#include "vtkSpanSpace.h"
 #include "vtkTimerLog.h"
 #include "vtkSmartPointer.h"
 #include "vtkContourHelper.h"
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkCutter);
 vtkCxxSetObjectMacro(vtkCutter,CutFunction,vtkImplicitFunction);
 vtkCxxSetObjectMacro(vtkCutter,Locator,vtkIncrementalPointLocator)
+vtkCxxSetObjectMacro(vtkCutter,ScalarTree,vtkScalarTree)
 
 //----------------------------------------------------------------------------
 // Construct with user-specified implicit function; initial value of 0.0; and
@@ -67,11 +74,16 @@ vtkCutter::vtkCutter(vtkImplicitFunction *cf)
   this->Locator = NULL;
   this->GenerateTriangles = 1;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->UseScalarTree = 0;
+  this->ScalarTree = NULL;
+  this->UseParallelAlgorithms = 0;
 
   this->SynchronizedTemplates3D = vtkSynchronizedTemplates3D::New();
   this->SynchronizedTemplatesCutter3D = vtkSynchronizedTemplatesCutter3D::New();
   this->GridSynchronizedTemplates = vtkGridSynchronizedTemplates3D::New();
   this->RectilinearSynchronizedTemplates = vtkRectilinearSynchronizedTemplates::New();
+  this->FlyingEdgesPlaneCutter = vtkFlyingEdgesPlaneCutter::New();
+  this->GridFlyingEdgesPlaneCutter = vtkGridFlyingEdgesPlaneCutter::New();
 }
 
 //----------------------------------------------------------------------------
@@ -80,11 +92,14 @@ vtkCutter::~vtkCutter()
   this->ContourValues->Delete();
   this->SetCutFunction(NULL);
   this->SetLocator(NULL);
+  this->SetScalarTree(NULL);
 
   this->SynchronizedTemplates3D->Delete();
   this->SynchronizedTemplatesCutter3D->Delete();
   this->GridSynchronizedTemplates->Delete();
   this->RectilinearSynchronizedTemplates->Delete();
+  this->FlyingEdgesPlaneCutter->Delete();
+  this->GridFlyingEdgesPlaneCutter->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -107,6 +122,45 @@ unsigned long vtkCutter::GetMTime()
   return mTime;
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Whether the input may be cut by the flying edges plane cutters. If so,
+// plane is set to the cut plane moved to the cut value.
+bool vtkCutterCanUseFlyingEdges(vtkCutter *self, vtkDataSet *input,
+                                vtkPlane *plane)
+{
+  vtkPlane *cutPlane = vtkPlane::SafeDownCast(self->GetCutFunction());
+  if (!self->GetUseParallelAlgorithms() ||
+      vtkSMPTools::GetEstimatedNumberOfThreads() < 2 || !cutPlane ||
+      cutPlane->GetTransform() || self->GetNumberOfContours() != 1 ||
+      !self->GetGenerateTriangles() ||
+      input->GetCellData()->GetNumberOfArrays() > 0)
+    {
+    return false;
+    }
+
+  // Points where the plane function is value lie on the plane moved by
+  // value / |n| along its normal n.
+  double origin[3], normal[3];
+  cutPlane->GetOrigin(origin);
+  cutPlane->GetNormal(normal);
+  double norm2 = vtkMath::Dot(normal, normal);
+  if (norm2 == 0.0)
+    {
+    return false;
+    }
+  double value = self->GetValue(0);
+  for (int i = 0; i < 3; ++i)
+    {
+    origin[i] += value * normal[i] / norm2;
+    }
+  plane->SetOrigin(origin);
+  plane->SetNormal(normal);
+  return true;
+}
+}
+
 //----------------------------------------------------------------------------
 void vtkCutter::StructuredPointsCutter(vtkDataSet *dataSetInput,
                                        vtkPolyData *thisOutput,
@@ -125,6 +179,21 @@ void vtkCutter::StructuredPointsCutter(vtkDataSet *dataSetInput,
 
   int numContours = this->GetNumberOfContours();
 
+  // for one plane we may use the flying edges plane cutter, which runs in
+  // parallel and only interpolates the scalars
+  vtkPointData *inPD = input->GetPointData();
+  vtkNew<vtkPlane> plane;
+  if (inPD->GetNumberOfArrays() == 1 && inPD->GetScalars() &&
+      inPD->GetScalars()->GetNumberOfComponents() == 1 &&
+      vtkCutterCanUseFlyingEdges(this, input, plane.GetPointer()))
+    {
+    this->FlyingEdgesPlaneCutter->SetPlane(plane.GetPointer());
+    this->FlyingEdgesPlaneCutter->ComputeNormalsOff();
+    this->FlyingEdgesPlaneCutter->ProcessRequest(request,inputVector,outputVector);
+    this->FlyingEdgesPlaneCutter->SetPlane(NULL);
+    return;
+    }
+
   // for one contour we use the SyncTempCutter which is faster and has a
   // smaller memory footprint
   if (numContours == 1)
@@ -227,6 +296,11 @@ void vtkCutter::StructuredGridCutter(vtkDataSet *dataSetInput,
     return;
     }
 
+  if (this->GridFlyingEdgesCutter(input, thisOutput))
+    {
+    return;
+    }
+
   vtkFloatArray *cutScalars = vtkFloatArray::New();
   cutScalars->SetName("cutScalars");
 
@@ -274,6 +348,30 @@ void vtkCutter::StructuredGridCutter(vtkDataSet *dataSetInput,
   contourData->Delete();
 }
 
+//----------------------------------------------------------------------------
+// Cut a 3D structured or rectilinear grid with the flying edges plane cutter
+// if it produces the same arrays, and return whether it did.
+bool vtkCutter::GridFlyingEdgesCutter(vtkDataSet *input,
+                                      vtkPolyData *thisOutput)
+{
+  vtkNew<vtkPlane> plane;
+  if (this->GenerateCutScalars ||
+      this->OutputPointsPrecision != DEFAULT_PRECISION ||
+      !vtkCutterCanUseFlyingEdges(this, input, plane.GetPointer()))
+    {
+    return false;
+    }
+
+  this->GridFlyingEdgesPlaneCutter->SetInputData(input);
+  this->GridFlyingEdgesPlaneCutter->SetPlane(plane.GetPointer());
+  this->GridFlyingEdgesPlaneCutter->ComputeNormalsOff();
+  this->GridFlyingEdgesPlaneCutter->InterpolateAttributesOn();
+  this->GridFlyingEdgesPlaneCutter->Update();
+  thisOutput->ShallowCopy(this->GridFlyingEdgesPlaneCutter->GetOutput());
+  this->GridFlyingEdgesPlaneCutter->SetInputData(NULL);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkCutter::RectilinearGridCutter(vtkDataSet *dataSetInput,
                                       vtkPolyData *thisOutput)
@@ -287,6 +385,11 @@ void vtkCutter::RectilinearGridCutter(vtkDataSet *dataSetInput,
     return;
     }
 
+  if (this->GridFlyingEdgesCutter(input, thisOutput))
+    {
+    return;
+    }
+
   vtkFloatArray *cutScalars = vtkFloatArray::New();
   cutScalars->SetNumberOfTuples(numPts);
   cutScalars->SetName("cutScalars");
@@ -723,7 +826,7 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
   vtkDoubleArray *cellScalars;
   vtkCellArray *newVerts, *newLines, *newPolys;
   vtkPoints *newPoints;
-  vtkDoubleArray *cutScalars;
+  vtkSmartPointer<vtkDoubleArray> cutScalars;
   double value, s;
   vtkIdType estimatedSize, numCells=input->GetNumberOfCells();
   vtkIdType numPts=input->GetNumberOfPoints();
@@ -780,8 +883,33 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
   newLines->Allocate(estimatedSize,estimatedSize/2);
   newPolys = vtkCellArray::New();
   newPolys->Allocate(estimatedSize,estimatedSize/2);
-  cutScalars = vtkDoubleArray::New();
-  cutScalars->SetNumberOfTuples(numPts);
+
+  // When a scalar tree is used, the cut scalars it was built over are
+  // reused as long as neither the input nor the cut function changed.
+  int useScalarTree =
+    (this->UseScalarTree && this->SortBy == VTK_SORT_BY_VALUE);
+  if ( useScalarTree )
+    {
+    if ( this->ScalarTree == NULL )
+      {
+      this->ScalarTree = vtkSpanSpace::New();
+      }
+    vtkDoubleArray *treeScalars =
+      vtkDoubleArray::SafeDownCast(this->ScalarTree->GetScalars());
+    if ( treeScalars && this->ScalarTree->GetDataSet() == input &&
+         treeScalars->GetNumberOfTuples() == numPts &&
+         this->CutScalarsTime > input->GetMTime() &&
+         this->CutScalarsTime > this->CutFunction->GetMTime() )
+      {
+      cutScalars = treeScalars;
+      }
+    }
+  int evaluateCutFunction = (cutScalars.GetPointer() == NULL);
+  if ( evaluateCutFunction )
+    {
+    cutScalars = vtkSmartPointer<vtkDoubleArray>::New();
+    cutScalars->SetNumberOfTuples(numPts);
+    }
 
   // Interpolate data along edge. If generating cut scalars, do necessary setup
   if ( this->GenerateCutScalars )
@@ -807,10 +935,26 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
 
   // Loop over all points evaluating scalar function at each point
   //
-  for ( i=0; i < numPts; i++ )
+  if ( evaluateCutFunction )
     {
-    s = this->CutFunction->FunctionValue(input->GetPoint(i));
-    cutScalars->SetComponent(i,0,s);
+    for ( i=0; i < numPts; i++ )
+      {
+      s = this->CutFunction->FunctionValue(input->GetPoint(i));
+      cutScalars->SetComponent(i,0,s);
+      }
+    if ( useScalarTree )
+      {
+      this->ScalarTree->SetDataSet(input);
+      this->ScalarTree->SetScalars(cutScalars);
+      this->CutScalarsTime.Modified();
+      }
+    }
+  if ( useScalarTree )
+    {
+    // A tree is of no use (and a span space cannot be built) when the
+    // cut function is constant over the input.
+    double *cutRange = cutScalars->GetRange();
+    useScalarTree = (cutRange[1] > cutRange[0]);
     }
 
   // Compute some information for progress methods
@@ -897,6 +1041,66 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
       } // for all contour values
     } // sort by cell
 
+  else if ( useScalarTree ) // SORT_BY_VALUE with a scalar tree:
+    {
+    // Same ordering requirements as below: lower dimensional cells first.
+    // The candidate cells of each cut value are gathered once from the
+    // tree and then visited once per dimension.
+    unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+    vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
+    std::vector<std::vector<vtkIdType> > candidates(numContours);
+    const vtkIdType *batch;
+    vtkIdType numBatches, numBatchCells, batchNum;
+    for (iter=0; iter < numContours; ++iter)
+      {
+      this->ScalarTree->InitTraversal(contourValues[iter]);
+      numBatches = this->ScalarTree->GetNumberOfCellBatches();
+      for (batchNum=0; batchNum < numBatches; ++batchNum)
+        {
+        batch = this->ScalarTree->GetCellBatch(batchNum, numBatchCells);
+        if ( batch )
+          {
+          candidates[iter].insert(candidates[iter].end(),
+                                  batch, batch+numBatchCells);
+          }
+        }
+      }
+
+    vtkIdType cellId;
+    int cellType, dimensionality;
+    std::vector<vtkIdType>::iterator cellIdIter;
+    for (dimensionality = 1; dimensionality <= 3; ++dimensionality)
+      {
+      for (iter=0; iter < numContours && !abortExecute; ++iter)
+        {
+        if ( dimensionality == 3 )
+          {
+          this->UpdateProgress(static_cast<double>(iter)/numContours);
+          abortExecute = this->GetAbortExecute();
+          }
+        value = contourValues[iter];
+        for (cellIdIter = candidates[iter].begin();
+             cellIdIter != candidates[iter].end(); ++cellIdIter)
+          {
+          cellId = *cellIdIter;
+          cellType = input->GetCellType(cellId);
+          if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
+            {
+            vtkErrorMacro("Unknown cell type " << cellType);
+            continue;
+            }
+          if (cellTypeDimensions[cellType] != dimensionality)
+            {
+            continue;
+            }
+          input->GetCell(cellId, cell.GetPointer());
+          cutScalars->GetTuples(cell->GetPointIds(), cellScalars);
+          helper.Contour(cell.GetPointer(), value, cellScalars, cellId);
+          } // for all candidate cells
+        } // for all contour values
+      } // for all dimensions (1,2,3).
+    } // sort by value with a scalar tree
+
   else // SORT_BY_VALUE:
     {
     // Three passes over the cells to process lower dimensional cells first.
@@ -996,7 +1200,6 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
   // polys we've created, take care to reclaim memory.
   //
   cellScalars->Delete();
-  cutScalars->Delete();
 
   if ( this->GenerateCutScalars )
     {
@@ -1083,4 +1286,18 @@ void vtkCutter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Precision of the output points: "
      << this->OutputPointsPrecision << "\n";
+
+  os << indent << "Use Scalar Tree: "
+     << (this->UseScalarTree ? "On\n" : "Off\n");
+  if ( this->ScalarTree )
+    {
+    os << indent << "Scalar Tree: " << this->ScalarTree << "\n";
+    }
+  else
+    {
+    os << indent << "Scalar Tree: (none)\n";
+    }
+
+  os << indent << "Use Parallel Algorithms: "
+     << (this->UseParallelAlgorithms ? "On\n" : "Off\n");
 }
@@ -52,10 +52,13 @@
 
 class vtkImplicitFunction;
 class vtkIncrementalPointLocator;
+class vtkScalarTree;
 class vtkSynchronizedTemplates3D;
 class vtkSynchronizedTemplatesCutter3D;
 class vtkGridSynchronizedTemplates3D;
 class vtkRectilinearSynchronizedTemplates;
+class vtkFlyingEdgesPlaneCutter;
+class vtkGridFlyingEdgesPlaneCutter;
 
 class VTKFILTERSCORE_EXPORT vtkCutter : public vtkPolyDataAlgorithm
 {
@@ -172,6 +175,24 @@ public:
     {this->SetSortBy(VTK_SORT_BY_CELL);}
   const char *GetSortByAsString();
 
+  // Description:
+  // Enable the use of a scalar tree to accelerate cutting unstructured
+  // grids. The cut function is evaluated at the points once and a scalar
+  // tree is built over the resulting cut scalars. Both are retained
+  // until the input or the cut function changes, so that changing only
+  // the cut values does not visit every cell again. This costs one
+  // double per input point plus the tree itself. The tree is only used
+  // when sorting by value.
+  vtkSetMacro(UseScalarTree,int);
+  vtkGetMacro(UseScalarTree,int);
+  vtkBooleanMacro(UseScalarTree,int);
+
+  // Description:
+  // Specify the instance of vtkScalarTree to use. If not specified and
+  // UseScalarTree is enabled, then a vtkSpanSpace will be used.
+  virtual void SetScalarTree(vtkScalarTree*);
+  vtkGetObjectMacro(ScalarTree,vtkScalarTree);
+
   // Description:
   // Create default locator. Used to create one when none is specified. The
   // locator is used to merge coincident points.
@@ -190,6 +211,22 @@ public:
   vtkSetClampMacro(OutputPointsPrecision, int, SINGLE_PRECISION, DEFAULT_PRECISION);
   vtkGetMacro(OutputPointsPrecision, int);
 
+  // Description:
+  // Set/Get whether 3D vtkImageData, vtkRectilinearGrid and
+  // vtkStructuredGrid inputs cut by a single plane are cut with the parallel
+  // flying edges plane cutters (vtkFlyingEdgesPlaneCutter and
+  // vtkGridFlyingEdgesPlaneCutter). They are only used when vtkSMPTools
+  // runs on more than one thread, the plane has no transform, there is a
+  // single cut value, GenerateTriangles is on, the input has no cell data,
+  // and the output keeps the same point arrays: for images the point data
+  // must be single component scalars only, and for grids GenerateCutScalars
+  // must be off and the output points precision must be the default one.
+  // The cut surfaces are the same, but their points are ordered
+  // differently. Off by default.
+  vtkSetMacro(UseParallelAlgorithms,int);
+  vtkGetMacro(UseParallelAlgorithms,int);
+  vtkBooleanMacro(UseParallelAlgorithms,int);
+
 protected:
   vtkCutter(vtkImplicitFunction *cf=NULL);
   ~vtkCutter();
@@ -204,6 +241,7 @@ protected:
                               vtkInformationVector *);
   void StructuredGridCutter(vtkDataSet *, vtkPolyData *);
   void RectilinearGridCutter(vtkDataSet *, vtkPolyData *);
+  bool GridFlyingEdgesCutter(vtkDataSet *, vtkPolyData *);
   vtkImplicitFunction *CutFunction;
   int GenerateTriangles;
 
@@ -211,12 +249,21 @@ protected:
   vtkSynchronizedTemplatesCutter3D *SynchronizedTemplatesCutter3D;
   vtkGridSynchronizedTemplates3D *GridSynchronizedTemplates;
   vtkRectilinearSynchronizedTemplates *RectilinearSynchronizedTemplates;
+  vtkFlyingEdgesPlaneCutter *FlyingEdgesPlaneCutter;
+  vtkGridFlyingEdgesPlaneCutter *GridFlyingEdgesPlaneCutter;
 
   vtkIncrementalPointLocator *Locator;
   int SortBy;
   vtkContourValues *ContourValues;
   int GenerateCutScalars;
   int OutputPointsPrecision;
+
+  int UseScalarTree;
+  vtkScalarTree *ScalarTree;
+  vtkTimeStamp CutScalarsTime;
+
+  int UseParallelAlgorithms;
+
 private:
   vtkCutter(const vtkCutter&);  // Not implemented.
   void operator=(const vtkCutter&);  // Not implemented.
@@ -22,6 +22,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
 #include "vtkPolyData.h"
+#include "vtkIndexedPriorityQueue.h"
 #include "vtkPriorityQueue.h"
 #include "vtkTriangle.h"
 #include "vtkCellArray.h"
@@ -85,8 +86,10 @@ vtkDecimatePro::vtkDecimatePro()
   this->BoundaryVertexDeletion = 1;
   this->InflectionPointRatio = 10.0;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->UseIndexedPriorityQueue = 0;
 
   this->Queue = NULL;
+  this->IndexedQueue = NULL;
   this->VertexError = NULL;
 
   this->Mesh = NULL;
@@ -96,10 +99,7 @@ vtkDecimatePro::vtkDecimatePro()
 vtkDecimatePro::~vtkDecimatePro()
 {
   this->InflectionPoints->Delete();
-  if ( this->Queue )
-    {
-    this->Queue->Delete();
-    }
+  this->DeleteQueue();
   if ( this->VertexError )
     {
     this->VertexError->Delete();
@@ -1510,8 +1510,36 @@ void vtkDecimatePro::InitializeQueue(vtkIdType numPts)
     numPts = static_cast<vtkIdType>(numPts*1.25);
     }
 
-  this->Queue = vtkPriorityQueue::New();
-  this->Queue->Allocate(numPts, static_cast<vtkIdType>(0.25*numPts));
+  if ( this->UseIndexedPriorityQueue )
+    {
+    this->IndexedQueue = vtkIndexedPriorityQueue::New();
+    this->IndexedQueue->Allocate(numPts);
+    }
+  else
+    {
+    this->Queue = vtkPriorityQueue::New();
+    this->Queue->Allocate(numPts, static_cast<vtkIdType>(0.25*numPts));
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkDecimatePro::QueueInsert(double error, vtkIdType ptId)
+{
+  if ( this->IndexedQueue )
+    {
+    this->IndexedQueue->Insert(error, ptId);
+    }
+  else
+    {
+    this->Queue->Insert(error, ptId);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkDecimatePro::QueuePop(double &error)
+{
+  return this->IndexedQueue ? this->IndexedQueue->Pop(error) :
+    this->Queue->Pop(0, error);
 }
 
 //----------------------------------------------------------------------------
@@ -1520,11 +1548,11 @@ int vtkDecimatePro::Pop(double &error)
   vtkIdType ptId;
 
   // Try returning what's in queue
-  if ( (ptId = this->Queue->Pop(0, error)) >= 0 )
+  if ( (ptId = this->QueuePop(error)) >= 0 )
     {
     if ( error > this->Error )
       {
-      this->Queue->Reset();
+      this->Reset();
       }
     else
       {
@@ -1549,11 +1577,11 @@ int vtkDecimatePro::Pop(double &error)
       this->Insert(ptId);
       }
 
-    if ( (ptId = this->Queue->Pop(0, error)) >= 0 )
+    if ( (ptId = this->QueuePop(error)) >= 0 )
       {
       if ( error > this->Error )
         {
-        this->Queue->Reset();
+        this->Reset();
         }
       else
         {
@@ -1574,11 +1602,11 @@ int vtkDecimatePro::Pop(double &error)
       this->Insert(ptId);
       }
 
-    if ( (ptId = this->Queue->Pop(0, error)) >= 0 )
+    if ( (ptId = this->QueuePop(error)) >= 0 )
       {
       if ( error > this->Error )
         {
-        this->Queue->Reset();
+        this->Reset();
         }
       else
         {
@@ -1641,7 +1669,7 @@ void vtkDecimatePro::Insert(vtkIdType ptId, double error)
           {
             error += this->VertexError->GetValue(ptId);
           }
-        this->Queue->Insert(error,ptId);
+        this->QueueInsert(error,ptId);
         }
 
       // Type is complex so we break it up (if splitting allowed). A
@@ -1678,7 +1706,7 @@ void vtkDecimatePro::Insert(vtkIdType ptId, double error)
       {
         error += this->VertexError->GetValue(ptId);
       }
-    this->Queue->Insert(error,ptId);
+    this->QueueInsert(error,ptId);
     }
 }
 
@@ -1705,18 +1733,31 @@ void vtkDecimatePro::DeleteQueue()
     this->Queue->Delete();
     }
   this->Queue=NULL;
+  if (this->IndexedQueue)
+    {
+    this->IndexedQueue->Delete();
+    }
+  this->IndexedQueue=NULL;
 }
 
 //----------------------------------------------------------------------------
 double vtkDecimatePro::DeleteId(vtkIdType id)
 {
-  return this->Queue->DeleteId(id);
+  return this->IndexedQueue ? this->IndexedQueue->DeleteId(id) :
+    this->Queue->DeleteId(id);
 }
 
 //----------------------------------------------------------------------------
 void vtkDecimatePro::Reset()
 {
-  this->Queue->Reset();
+  if (this->IndexedQueue)
+    {
+    this->IndexedQueue->Reset();
+    }
+  else
+    {
+    this->Queue->Reset();
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -1752,4 +1793,6 @@ void vtkDecimatePro::PrintSelf(ostream& os, vtkIndent indent)
      << this->GetNumberOfInflectionPoints() << "\n";
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Use Indexed Priority Queue: "
+     << (this->UseIndexedPriorityQueue ? "On\n" : "Off\n");
 }
@@ -82,6 +82,7 @@
 #include "vtkCell.h" // Needed for VTK_CELL_SIZE
 
 class vtkDoubleArray;
+class vtkIndexedPriorityQueue;
 class vtkPriorityQueue;
 
 class VTKFILTERSCORE_EXPORT vtkDecimatePro : public vtkPolyDataAlgorithm
@@ -236,6 +237,15 @@ public:
   vtkSetMacro(OutputPointsPrecision,int);
   vtkGetMacro(OutputPointsPrecision,int);
 
+  // Description:
+  // Order the vertices with a vtkIndexedPriorityQueue rather than a
+  // vtkPriorityQueue. This is faster on large meshes, but vertices of equal
+  // error (e.g., on planar regions) are deleted in a different order, so
+  // the output may differ slightly. Off by default.
+  vtkSetMacro(UseIndexedPriorityQueue,int);
+  vtkGetMacro(UseIndexedPriorityQueue,int);
+  vtkBooleanMacro(UseIndexedPriorityQueue,int);
+
 protected:
   vtkDecimatePro();
   ~vtkDecimatePro();
@@ -257,6 +267,7 @@ protected:
   double InflectionPointRatio;
   vtkDoubleArray *InflectionPoints;
   int OutputPointsPrecision;
+  int UseIndexedPriorityQueue;
 
   // to replace a static object
   vtkIdList *Neighbors;
@@ -350,8 +361,11 @@ private:
   int Pop(double &error);
   double DeleteId(vtkIdType id);
   void Reset();
+  void QueueInsert(double error, vtkIdType ptId);
+  vtkIdType QueuePop(double &error);
 
   vtkPriorityQueue *Queue;
+  vtkIndexedPriorityQueue *IndexedQueue;
   vtkDoubleArray *VertexError;
 
   VertexArray *V;
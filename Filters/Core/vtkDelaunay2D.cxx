@@ -25,6 +25,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangle.h"
 #include "vtkTransform.h"
@@ -43,6 +44,7 @@ vtkDelaunay2D::vtkDelaunay2D()
   this->Tolerance = 0.00001;
   this->BoundingTriangulation = 0;
   this->Offset = 1.0;
+  this->SpatialInsertionOrder = 0;
   this->Transform = NULL;
   this->ProjectionPlaneMode = VTK_DELAUNAY_XY_PLANE;
 
@@ -271,6 +273,94 @@ void vtkDelaunay2D::CheckEdge(vtkIdType ptId, double x[3], vtkIdType p1,
   neighbors->Delete();
 }
 
+namespace
+{
+
+// Spreads the 16 low bits of v to every other bit.
+vtkTypeUInt32 SpreadBits(vtkTypeUInt32 v)
+{
+  v &= 0xffff;
+  v = (v | (v << 8)) & 0x00ff00ff;
+  v = (v | (v << 4)) & 0x0f0f0f0f;
+  v = (v | (v << 2)) & 0x33333333;
+  v = (v | (v << 1)) & 0x55555555;
+  return v;
+}
+
+// Returns the BRIO round of a point, counted from the last one, drawn from
+// a hash of the point id: half of the points are in the last round, a
+// quarter in the one before, and so on.
+vtkTypeUInt32 InsertionRound(vtkIdType ptId)
+{
+  vtkTypeUInt32 h = static_cast<vtkTypeUInt32>(ptId);
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  vtkTypeUInt32 round = 0;
+  for ( ; (h & 1) && round < 31; h >>= 1)
+    {
+    round++;
+    }
+  return round;
+}
+
+// Computes the insertion keys of the points: the round in the high bits and
+// the Morton code of the x-y coordinates on a 65536^2 grid in the low bits.
+class InsertionKeys
+{
+public:
+  const double *Points;
+  double Origin[2];
+  double Scale[2];
+  vtkTypeUInt64 *Keys;
+  vtkIdType *Ids;
+
+  void operator()(vtkIdType ptId, vtkIdType end)
+    {
+    vtkTypeUInt32 ij[2];
+    for ( ; ptId < end; ++ptId)
+      {
+      const double *x = this->Points + 3*ptId;
+      for (int i = 0; i < 2; ++i)
+        {
+        double t = (x[i] - this->Origin[i]) * this->Scale[i];
+        ij[i] = static_cast<vtkTypeUInt32>(t < 0.0 ? 0.0 :
+                                           (t > 65535.0 ? 65535.0 : t));
+        }
+      vtkTypeUInt64 round = 31 - InsertionRound(ptId);
+      this->Keys[ptId] = (round << 32) | SpreadBits(ij[0]) |
+        (SpreadBits(ij[1]) << 1);
+      this->Ids[ptId] = ptId;
+      }
+    }
+};
+
+// Orders the first numPts points of the raw coordinates in a biased
+// randomized insertion order.
+void ComputeInsertionOrder(const double *points, vtkIdType numPts,
+                           const double bounds[6],
+                           std::vector<vtkIdType> &order)
+{
+  order.resize(numPts);
+  std::vector<vtkTypeUInt64> keys(numPts);
+  InsertionKeys insertionKeys;
+  insertionKeys.Points = points;
+  for (int i = 0; i < 2; ++i)
+    {
+    double length = bounds[2*i+1] - bounds[2*i];
+    insertionKeys.Origin[i] = bounds[2*i];
+    insertionKeys.Scale[i] = (length > 0.0 ? 65536.0 / length : 0.0);
+    }
+  insertionKeys.Keys = &keys[0];
+  insertionKeys.Ids = &order[0];
+  vtkSMPTools::For(0, numPts, insertionKeys);
+  vtkSMPTools::RadixSort(&keys[0], &keys[0] + numPts, &order[0]);
+}
+
+}
+
 // 2D Delaunay triangulation. Steps are as follows:
 //   1. For each point
 //   2. Find triangle point is in
@@ -300,7 +390,7 @@ int vtkDelaunay2D::RequestData(
   vtkPolyData *output = vtkPolyData::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPoints, i;
+  vtkIdType numPoints, i, n;
   vtkIdType numTriangles = 0;
   vtkIdType ptId, tri[4], nei[3];
   vtkIdType p1 = 0;
@@ -425,6 +515,12 @@ int vtkDelaunay2D::RequestData(
   this->Points =
     static_cast<vtkDoubleArray *>(points->GetData())->GetPointer(0);
 
+  std::vector<vtkIdType> order;
+  if ( this->SpatialInsertionOrder )
+    {
+    ComputeInsertionOrder(this->Points, numPoints, bounds, order);
+    }
+
   triangles = vtkCellArray::New();
   triangles->Allocate(triangles->EstimateSize(2*numPoints,3));
 
@@ -452,8 +548,9 @@ int vtkDelaunay2D::RequestData(
   // satisfy criterion have their edges swapped. This continues recursively
   // until all triangles have been shown to be Delaunay.
   //
-  for (ptId=0; ptId < numPoints; ptId++)
+  for (n=0; n < numPoints; n++)
     {
+    ptId = (order.empty() ? n : order[n]);
     this->GetPoint(ptId,x);
     nei[0] = (-1); //where we are coming from...nowhere initially
 
@@ -534,10 +631,10 @@ int vtkDelaunay2D::RequestData(
       tri[0] = 0; //no triangle found
       }
 
-    if ( ! (ptId % 1000) )
+    if ( ! (n % 1000) )
       {
-      vtkDebugMacro(<<"point #" << ptId);
-      this->UpdateProgress (static_cast<double>(ptId)/numPoints);
+      vtkDebugMacro(<<"point #" << n);
+      this->UpdateProgress (static_cast<double>(n)/numPoints);
       if (this->GetAbortExecute())
         {
         break;
@@ -1549,4 +1646,6 @@ void vtkDelaunay2D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Bounding Triangulation: "
      << (this->BoundingTriangulation ? "On\n" : "Off\n");
+  os << indent << "Spatial Insertion Order: "
+     << (this->SpatialInsertionOrder ? "On\n" : "Off\n");
 }
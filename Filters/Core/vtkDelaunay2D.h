@@ -100,7 +100,8 @@
 // criterion). The choice of triangulation (as implemented by
 // this algorithm) depends on the order of the input points. The first three
 // points will form a triangle; other degenerate points will not break
-// this triangle.
+// this triangle. With SpatialInsertionOrder on, the points are not inserted
+// in input order, and degenerate points may be triangulated differently.
 //
 // Points that are coincident (or nearly so) may be discarded by the algorithm.
 // This is because the Delaunay triangulation requires unique input points.
@@ -196,6 +197,17 @@ public:
   vtkGetMacro(BoundingTriangulation,int);
   vtkBooleanMacro(BoundingTriangulation,int);
 
+  // Description:
+  // Boolean controls whether the points are inserted in a biased randomized
+  // insertion order (BRIO): in rounds of doubling size drawn at random, each
+  // round sorted along a Morton curve of the (transformed) x-y coordinates.
+  // The walk to the triangle containing a point starts from the last
+  // triangle created, so it is short in this order, which makes large point
+  // sets triangulate much faster. Off by default.
+  vtkSetMacro(SpatialInsertionOrder,int);
+  vtkGetMacro(SpatialInsertionOrder,int);
+  vtkBooleanMacro(SpatialInsertionOrder,int);
+
   // Description:
   // Set / get the transform which is applied to points to generate a
   // 2D problem.  This maps a 3D dataset into a 2D dataset where
@@ -226,6 +238,7 @@ protected:
   double Tolerance;
   int BoundingTriangulation;
   double Offset;
+  int SpatialInsertionOrder;
 
   vtkAbstractTransform *Transform;
 
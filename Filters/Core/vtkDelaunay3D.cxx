@@ -23,11 +23,14 @@
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkIncrementalPointLocator.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkDelaunay3D);
 
 //--------------------------------------------------------------------------
@@ -125,6 +128,102 @@ vtkDelaunayTetra *vtkTetraArray::Resize(vtkIdType sz)
   return this->Array;
 }
 
+namespace
+{
+
+// Spreads the 10 low bits of v to every third bit.
+vtkTypeUInt32 SpreadBits(vtkTypeUInt32 v)
+{
+  v &= 0x3ff;
+  v = (v | (v << 16)) & 0x030000ff;
+  v = (v | (v << 8)) & 0x0300f00f;
+  v = (v | (v << 4)) & 0x030c30c3;
+  v = (v | (v << 2)) & 0x09249249;
+  return v;
+}
+
+// Returns the BRIO round of a point, counted from the last one: a point is
+// in the last round with probability 1/2, in the one before with
+// probability 1/4, and so on. The rounds are drawn from a hash of the point
+// id, so that the order is the same from one run to the next.
+vtkTypeUInt32 InsertionRound(vtkIdType ptId)
+{
+  vtkTypeUInt32 h = static_cast<vtkTypeUInt32>(ptId);
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  vtkTypeUInt32 round = 0;
+  for ( ; (h & 1) && round < 31; h >>= 1)
+    {
+    round++;
+    }
+  return round;
+}
+
+// Computes the insertion keys of the points: the round in the high bits,
+// for the earlier rounds to come first, and the Morton code of the point on
+// a 1024^3 grid over the bounds in the low bits.
+class InsertionKeys
+{
+public:
+  vtkPoints *Points;
+  double Origin[3];
+  double Scale[3];
+  vtkTypeUInt64 *Keys;
+  vtkIdType *Ids;
+
+  void operator()(vtkIdType ptId, vtkIdType end)
+    {
+    double x[3];
+    vtkTypeUInt32 ijk[3];
+    for ( ; ptId < end; ++ptId)
+      {
+      this->Points->GetPoint(ptId, x);
+      for (int i = 0; i < 3; ++i)
+        {
+        double t = (x[i] - this->Origin[i]) * this->Scale[i];
+        ijk[i] = static_cast<vtkTypeUInt32>(t < 0.0 ? 0.0 :
+                                            (t > 1023.0 ? 1023.0 : t));
+        }
+      vtkTypeUInt64 round = 31 - InsertionRound(ptId);
+      this->Keys[ptId] = (round << 32) | SpreadBits(ijk[0]) |
+        (SpreadBits(ijk[1]) << 1) | (SpreadBits(ijk[2]) << 2);
+      this->Ids[ptId] = ptId;
+      }
+    }
+};
+
+// Orders the points in a biased randomized insertion order, so that the
+// enclosing tetrahedron of a point is a few steps away from the last
+// tetrahedron created, while the first points are spread over the bounds.
+void ComputeInsertionOrder(vtkPoints *points, std::vector<vtkIdType> &order)
+{
+  vtkIdType numPts = points->GetNumberOfPoints();
+  order.resize(numPts);
+  if (numPts == 0)
+    {
+    return;
+    }
+  double bounds[6];
+  points->GetBounds(bounds);
+  std::vector<vtkTypeUInt64> keys(numPts);
+  InsertionKeys insertionKeys;
+  insertionKeys.Points = points;
+  for (int i = 0; i < 3; ++i)
+    {
+    double length = bounds[2*i+1] - bounds[2*i];
+    insertionKeys.Origin[i] = bounds[2*i];
+    insertionKeys.Scale[i] = (length > 0.0 ? 1024.0 / length : 0.0);
+    }
+  insertionKeys.Keys = &keys[0];
+  insertionKeys.Ids = &order[0];
+  vtkSMPTools::For(0, numPts, insertionKeys);
+  vtkSMPTools::RadixSort(&keys[0], &keys[0] + numPts, &order[0]);
+}
+
+}
 
 // vtkDelaunay3D methods
 //
@@ -143,8 +242,10 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->BoundingTriangulation = 0;
   this->Offset = 2.5;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->SpatialInsertionOrder = 0;
   this->Locator = NULL;
   this->TetraArray = NULL;
+  this->LastTetra = -1;
 
   // added for performance
   this->Tetras = vtkIdList::New();
@@ -208,26 +309,37 @@ vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3],
     return 0;
     }
 
-  closestPoint = locator->FindClosestInsertedPoint(x);
-  vtkCellLinks *links = Mesh->GetCellLinks();
-  int numCells = links->GetNcells(closestPoint);
-  vtkIdType *cells = links->GetCells(closestPoint);
-  if ( numCells <= 0 ) //shouldn't happen
-    {
-    this->NumberOfDegeneracies++;
-    return 0;
-    }
-  else
+  // In spatial order, the last tetra created is close to the point. Walk
+  // from there, and only fall back to the closest point if the walk fails.
+  tetraId = -1;
+  if ( this->SpatialInsertionOrder && this->LastTetra >= 0 )
     {
-    tetraId = cells[0];
+    tetraId = this->FindTetra(Mesh,xd,this->LastTetra,0);
     }
 
-  // Okay, walk towards the containing tetrahedron
-  tetraId = this->FindTetra(Mesh,xd,tetraId,0);
   if ( tetraId < 0 )
     {
-    this->NumberOfDegeneracies++;
-    return 0;
+    closestPoint = locator->FindClosestInsertedPoint(x);
+    vtkCellLinks *links = Mesh->GetCellLinks();
+    int numCells = links->GetNcells(closestPoint);
+    vtkIdType *cells = links->GetCells(closestPoint);
+    if ( numCells <= 0 ) //shouldn't happen
+      {
+      this->NumberOfDegeneracies++;
+      return 0;
+      }
+    else
+      {
+      tetraId = cells[0];
+      }
+
+    // Okay, walk towards the containing tetrahedron
+    tetraId = this->FindTetra(Mesh,xd,tetraId,0);
+    if ( tetraId < 0 )
+      {
+      this->NumberOfDegeneracies++;
+      return 0;
+      }
     }
 
   // Initialize the list of tetras who contain the point according
@@ -329,7 +441,7 @@ int vtkDelaunay3D::FindTetra(vtkUnstructuredGrid *Mesh, double x[3],
 {
   double p[4][3];
   double b[4];
-  vtkTetra *tetra;
+  vtkIdType *tetraPts, npts;
   int neg = 0;
   int j, numNeg;
   double negValue;
@@ -340,10 +452,13 @@ int vtkDelaunay3D::FindTetra(vtkUnstructuredGrid *Mesh, double x[3],
     return -1;
     }
 
-  tetra = static_cast<vtkTetra *>(Mesh->GetCell(tetraId));
+  // read the points directly rather than through a cell, this is called
+  // several times per inserted point
+  Mesh->GetCellPoints(tetraId, npts, tetraPts);
+  vtkPoints *points = Mesh->GetPoints();
   for ( j=0; j < 4; j++ ) //load the points
     {
-    tetra->Points->GetPoint(j,p[j]);
+    points->GetPoint(tetraPts[j],p[j]);
     }
 
   vtkTetra::BarycentricCoords(x, p[0], p[1], p[2], p[3], b);
@@ -369,28 +484,28 @@ int vtkDelaunay3D::FindTetra(vtkUnstructuredGrid *Mesh, double x[3],
     }
 
   // okay, march towards the most negative direction
-  int p1 = 0, p2 = 0, p3 = 0;
+  vtkIdType p1 = 0, p2 = 0, p3 = 0;
   switch (neg)
     {
     case 0:
-      p1 = tetra->PointIds->GetId(1);
-      p2 = tetra->PointIds->GetId(2);
-      p3 = tetra->PointIds->GetId(3);
+      p1 = tetraPts[1];
+      p2 = tetraPts[2];
+      p3 = tetraPts[3];
       break;
     case 1:
-      p1 = tetra->PointIds->GetId(0);
-      p2 = tetra->PointIds->GetId(2);
-      p3 = tetra->PointIds->GetId(3);
+      p1 = tetraPts[0];
+      p2 = tetraPts[2];
+      p3 = tetraPts[3];
       break;
     case 2:
-      p1 = tetra->PointIds->GetId(0);
-      p2 = tetra->PointIds->GetId(1);
-      p3 = tetra->PointIds->GetId(3);
+      p1 = tetraPts[0];
+      p2 = tetraPts[1];
+      p3 = tetraPts[3];
       break;
     case 3:
-      p1 = tetra->PointIds->GetId(0);
-      p2 = tetra->PointIds->GetId(1);
-      p3 = tetra->PointIds->GetId(2);
+      p1 = tetraPts[0];
+      p2 = tetraPts[1];
+      p3 = tetraPts[2];
       break;
     }
   vtkIdType nei;
@@ -484,20 +599,27 @@ int vtkDelaunay3D::RequestData(
   Mesh = this->InitPointInsertion(center, this->Offset*tol,
                                   numPoints, points);
 
+  std::vector<vtkIdType> order;
+  if ( this->SpatialInsertionOrder )
+    {
+    ComputeInsertionOrder(inPoints, order);
+    }
+
   // Insert each point into triangulation. Points laying "inside"
   // of tetra cause tetra to be deleted, leaving a void with bounding
   // faces. Combination of point and each face is used to form new
   // tetrahedra.
-  for (ptId=0; ptId < numPoints; ptId++)
+  for (i=0; i < numPoints; i++)
     {
+    ptId = (order.empty() ? i : order[i]);
     inPoints->GetPoint(ptId,x);
 
     this->InsertPoint(Mesh, points, ptId, x, holeTetras);
 
-    if ( ! (ptId % 250) )
+    if ( ! (i % 250) )
       {
-      vtkDebugMacro(<<"point #" << ptId);
-      this->UpdateProgress (static_cast<double>(ptId)/numPoints);
+      vtkDebugMacro(<<"point #" << i);
+      this->UpdateProgress (static_cast<double>(i)/numPoints);
       if (this->GetAbortExecute())
         {
         break;
@@ -789,7 +911,17 @@ vtkUnstructuredGrid *vtkDelaunay3D::InitPointInsertion(double center[3],
     {
     this->CreateDefaultLocator();
     }
-  this->Locator->InitPointInsertion(points,bounds);
+  if ( this->SpatialInsertionOrder )
+    {
+    // An automatic locator gets buckets of a few points whatever the
+    // number of points, rather than its fixed divisions.
+    this->Locator->InitPointInsertion(points,bounds,numPtsToInsert+6);
+    }
+  else
+    {
+    this->Locator->InitPointInsertion(points,bounds);
+    }
+  this->LastTetra = -1;
 
   //create bounding octahedron: 6 points & 4 tetra
   x[0] = center[0] - length;
@@ -932,6 +1064,7 @@ void vtkDelaunay3D::InsertPoint(vtkUnstructuredGrid *Mesh, vtkPoints *points,
         }
 
       this->InsertTetra(Mesh, points, tetraId);
+      this->LastTetra = tetraId;
 
       }//for each face
 
@@ -1037,6 +1170,8 @@ void vtkDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Bounding Triangulation: "
      << (this->BoundingTriangulation ? "On\n" : "Off\n");
+  os << indent << "Spatial Insertion Order: "
+     << (this->SpatialInsertionOrder ? "On\n" : "Off\n");
 
   if ( this->Locator )
     {
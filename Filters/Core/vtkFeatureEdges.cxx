@@ -22,6 +22,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleStrip.h"
 #include "vtkUnsignedCharArray.h"
@@ -29,9 +30,244 @@
 #include "vtkCellData.h"
 #include "vtkPointData.h"
 #include "vtkIncrementalPointLocator.h"
+#include "vtkIdTypeArray.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
+
+#include <vector>
 
 vtkStandardNewMacro(vtkFeatureEdges);
 
+namespace
+{
+typedef vtkEdgeTuple<vtkIdType, vtkIdType> vtkFeatureEdgesTuple;
+
+bool vtkFeatureEdgesAreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(i));
+    if (!array || array->GetDataType() == VTK_BIT ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Counts the edges of each polygon and computes its normal if needed. With
+// Offsets set, generates the edges at the scanned offsets instead; the data
+// of an edge tuple is the index of its segment.
+class vtkFeatureEdgesPolygonEdges
+{
+public:
+  vtkPolyData *Mesh;
+  vtkIdType *Offsets;
+  float *Normals;
+  bool Generate;
+  vtkIdType *Segments;
+  vtkIdType *CellIds;
+  vtkFeatureEdgesTuple *Edges;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType npts, *pts;
+    double n[3];
+    vtkPoints *points = this->Mesh->GetPoints();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Mesh->GetCellPoints(cellId, npts, pts);
+      if (!this->Generate)
+        {
+        this->Offsets[cellId] = npts;
+        if (this->Normals)
+          {
+          vtkPolygon::ComputeNormal(points, static_cast<int>(npts), pts, n);
+          this->Normals[3*cellId] = static_cast<float>(n[0]);
+          this->Normals[3*cellId+1] = static_cast<float>(n[1]);
+          this->Normals[3*cellId+2] = static_cast<float>(n[2]);
+          }
+        continue;
+        }
+      vtkIdType seg = this->Offsets[cellId];
+      for (vtkIdType i = 0; i < npts; ++i, ++seg)
+        {
+        this->Segments[2*seg] = pts[i];
+        this->Segments[2*seg+1] = pts[(i+1)%npts];
+        this->CellIds[seg] = cellId;
+        this->Edges[seg] = vtkFeatureEdgesTuple(pts[i], pts[(i+1)%npts], seg);
+        }
+      }
+  }
+};
+
+// Classifies the segments of each group of equal edges as the serial path
+// does with the cell edge neighbors: the cells of a group are sorted, so
+// the neighbors of a segment are the other distinct cells of its group.
+class vtkFeatureEdgesClassify
+{
+public:
+  vtkFeatureEdges *Filter;
+  const vtkFeatureEdgesTuple *Edges;
+  const vtkIdType *EdgeOffsets;
+  const vtkIdType *CellIds;
+  const float *Normals;
+  double CosAngle;
+  const unsigned char *Ghosts;
+  vtkIdType *Emit;
+  float *Scalars;
+  vtkIdType *UsedPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    int boundary = this->Filter->GetBoundaryEdges();
+    int nonManifold = this->Filter->GetNonManifoldEdges();
+    int feature = this->Filter->GetFeatureEdges();
+    int manifold = this->Filter->GetManifoldEdges();
+    for (vtkIdType e = begin; e < end; ++e)
+      {
+      vtkIdType first = this->EdgeOffsets[e];
+      vtkIdType last = this->EdgeOffsets[e+1] - 1;
+      vtkIdType firstCell = this->CellIds[this->Edges[first].Data];
+      vtkIdType lastCell = this->CellIds[this->Edges[last].Data];
+      vtkIdType numNei = 0;
+      for (vtkIdType k = first + 1; k <= last; ++k)
+        {
+        if (this->CellIds[this->Edges[k].Data] !=
+            this->CellIds[this->Edges[k-1].Data])
+          {
+          numNei++;
+          }
+        }
+
+      for (vtkIdType k = first; k <= last; ++k)
+        {
+        vtkIdType seg = this->Edges[k].Data;
+        vtkIdType cellId = this->CellIds[seg];
+        vtkIdType nei = (cellId == firstCell ? lastCell : firstCell);
+        bool emit = false;
+        float scalar = 0.0f;
+        if (boundary && numNei < 1)
+          {
+          emit = true;
+          }
+        else if (nonManifold && numNei > 1)
+          {
+          emit = (cellId == firstCell);
+          scalar = 0.222222f;
+          }
+        else if (feature && numNei == 1 && nei > cellId)
+          {
+          const float *n1 = this->Normals + 3*cellId;
+          const float *n2 = this->Normals + 3*nei;
+          emit = (static_cast<double>(n1[0]) * n2[0] +
+                  static_cast<double>(n1[1]) * n2[1] +
+                  static_cast<double>(n1[2]) * n2[2] <= this->CosAngle);
+          scalar = 0.444444f;
+          }
+        else if (manifold && numNei == 1 && nei > cellId)
+          {
+          emit = true;
+          scalar = 0.666667f;
+          }
+        if (emit && this->Ghosts &&
+            this->Ghosts[cellId] & vtkDataSetAttributes::DUPLICATECELL)
+          {
+          emit = false;
+          }
+        this->Emit[seg] = (emit ? 1 : 0);
+        this->Scalars[seg] = scalar;
+        if (emit)
+          {
+          this->UsedPoints[this->Edges[k].V0] = 1;
+          this->UsedPoints[this->Edges[k].V1] = 1;
+          }
+        }
+      }
+  }
+};
+
+// Records the input id of each used point.
+class vtkFeatureEdgesOriginalIds
+{
+public:
+  const vtkIdType *PointMap;
+  vtkIdType *OriginalIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      if (this->PointMap[ptId] < this->PointMap[ptId+1])
+        {
+        this->OriginalIds[this->PointMap[ptId]] = ptId;
+        }
+      }
+  }
+};
+
+// Gathers the used input points and their data.
+class vtkFeatureEdgesCopyPoints
+{
+public:
+  vtkPoints *InPoints;
+  const vtkIdType *OriginalIds;
+  vtkPoints *OutPoints;
+  vtkPointData *InPD;
+  vtkPointData *OutPD;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      vtkIdType inId = this->OriginalIds[ptId];
+      this->InPoints->GetPoint(inId, x);
+      this->OutPoints->SetPoint(ptId, x);
+      this->OutPD->CopyData(this->InPD, inId, ptId);
+      }
+  }
+};
+
+// Writes the emitted segments as lines with the data of their cell and
+// their edge type.
+class vtkFeatureEdgesCopyLines
+{
+public:
+  const vtkIdType *Segments;
+  const vtkIdType *CellIds;
+  const vtkIdType *LineIds;
+  const vtkIdType *PointMap;
+  const float *Scalars;
+  vtkIdType *Connectivity;
+  float *OutScalars;
+  vtkCellData *InCD;
+  vtkCellData *OutCD;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType seg = begin; seg < end; ++seg)
+      {
+      vtkIdType lineId = this->LineIds[seg];
+      if (lineId == this->LineIds[seg+1])
+        {
+        continue;
+        }
+      vtkIdType *line = this->Connectivity + 3*lineId;
+      line[0] = 2;
+      line[1] = this->PointMap[this->Segments[2*seg]];
+      line[2] = this->PointMap[this->Segments[2*seg+1]];
+      this->OutCD->CopyData(this->InCD, this->CellIds[seg], lineId);
+      if (this->OutScalars)
+        {
+        this->OutScalars[lineId] = this->Scalars[seg];
+        }
+      }
+  }
+};
+}
+
 // Construct object with feature angle = 30; all types of edges, except
 // manifold edges, are extracted and colored.
 vtkFeatureEdges::vtkFeatureEdges()
@@ -44,6 +280,7 @@ vtkFeatureEdges::vtkFeatureEdges()
   this->Coloring = 1;
   this->Locator = NULL;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->ExtractInParallel = 0;
 }
 
 vtkFeatureEdges::~vtkFeatureEdges()
@@ -76,6 +313,7 @@ int vtkFeatureEdges::RequestData(
   vtkFloatArray *newScalars = NULL;
   vtkCellArray *newLines;
   vtkPolyData *Mesh;
+  vtkStaticCellLinks *links;
   int i;
   vtkIdType j, numNei, cellId;
   vtkIdType numBEdges, numNonManifoldEdges, numFedges, numManifoldEdges;
@@ -156,7 +394,15 @@ int vtkFeatureEdges::RequestData(
     newPolys = inPolys;
     Mesh->SetPolys(newPolys);
     }
-  Mesh->BuildLinks();
+
+  if ( this->ExtractInParallel )
+    {
+    int ret = this->ExtractEdgesInParallel(input, Mesh, ghosts, output);
+    Mesh->Delete();
+    return ret;
+    }
+
+  links = Mesh->GetStaticCellLinks();
 
   // Allocate storage for lines/points (arbitrary allocation sizes)
   //
@@ -237,7 +483,7 @@ int vtkFeatureEdges::RequestData(
       p1 = pts[i];
       p2 = pts[(i+1)%npts];
 
-      Mesh->GetCellEdgeNeighbors(cellId,p1,p2, neighbors);
+      links->GetCellEdgeNeighbors(cellId,p1,p2, neighbors);
       numNei = neighbors->GetNumberOfIds();
 
       if ( this->BoundaryEdges && numNei < 1 )
@@ -380,6 +626,166 @@ int vtkFeatureEdges::RequestData(
   return 1;
 }
 
+// Generate the edges of all the polygons in parallel, sort them to find the
+// polygons using each edge, and classify and write the edges in the order
+// of the serial path.
+int vtkFeatureEdges::ExtractEdgesInParallel(vtkPolyData *input,
+                                            vtkPolyData *mesh,
+                                            unsigned char *ghosts,
+                                            vtkPolyData *output)
+{
+  vtkPoints *inPts = input->GetPoints();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numPolys = mesh->GetNumberOfCells();
+  vtkPointData *pd = input->GetPointData(), *outPD = output->GetPointData();
+  vtkCellData *cd = input->GetCellData(), *outCD = output->GetCellData();
+  mesh->BuildCells();
+
+  std::vector<vtkIdType> offsets(numPolys + 1, 0);
+  std::vector<float> normals;
+  if ( this->FeatureEdges )
+    {
+    normals.resize(3*numPolys);
+    }
+  vtkFeatureEdgesPolygonEdges polygonEdges;
+  polygonEdges.Mesh = mesh;
+  polygonEdges.Offsets = &offsets[0];
+  polygonEdges.Normals = normals.empty() ? NULL : &normals[0];
+  polygonEdges.Generate = false;
+  vtkSMPTools::For(0, numPolys, polygonEdges);
+  vtkIdType numSegments = vtkSMPTools::ExclusiveScan(
+    offsets.begin(), offsets.end() - 1, offsets.begin(), vtkIdType(0));
+  if ( numSegments < 1 )
+    {
+    return 1;
+    }
+
+  std::vector<vtkIdType> segments(2*numSegments);
+  std::vector<vtkIdType> cellIds(numSegments);
+  std::vector<vtkFeatureEdgesTuple> edges(numSegments);
+  polygonEdges.Generate = true;
+  polygonEdges.Segments = &segments[0];
+  polygonEdges.CellIds = &cellIds[0];
+  polygonEdges.Edges = &edges[0];
+  vtkSMPTools::For(0, numPolys, polygonEdges);
+
+  vtkStaticEdgeLocatorTemplate<vtkIdType, vtkIdType> locator;
+  vtkIdType numEdges = locator.MergeEdges(numSegments, &edges[0]);
+
+  // After the scans, segment i is a line if lineIds[i] < lineIds[i+1], and
+  // point i is used if pointMap[i] < pointMap[i+1].
+  std::vector<vtkIdType> lineIds(numSegments + 1, 0);
+  std::vector<vtkIdType> pointMap(numPts + 1, 0);
+  std::vector<float> scalars(numSegments);
+  vtkFeatureEdgesClassify classify;
+  classify.Filter = this;
+  classify.Edges = locator.GetEdges();
+  classify.EdgeOffsets = locator.GetEdgeOffsets();
+  classify.CellIds = &cellIds[0];
+  classify.Normals = polygonEdges.Normals;
+  classify.CosAngle = cos( vtkMath::RadiansFromDegrees( this->FeatureAngle ) );
+  classify.Ghosts = ghosts;
+  classify.Emit = &lineIds[0];
+  classify.Scalars = &scalars[0];
+  classify.UsedPoints = &pointMap[0];
+  vtkSMPTools::For(0, numEdges, classify);
+  vtkIdType numLines = vtkSMPTools::ExclusiveScan(
+    lineIds.begin(), lineIds.end() - 1, lineIds.begin(), vtkIdType(0));
+  lineIds[numSegments] = numLines;
+  vtkIdType numNewPts = vtkSMPTools::ExclusiveScan(
+    pointMap.begin(), pointMap.end() - 1, pointMap.begin(), vtkIdType(0));
+  pointMap[numPts] = numNewPts;
+
+  std::vector<vtkIdType> originalIds(numNewPts + 1);
+  vtkFeatureEdgesOriginalIds original;
+  original.PointMap = &pointMap[0];
+  original.OriginalIds = &originalIds[0];
+  vtkSMPTools::For(0, numPts, original);
+
+  // Set the desired precision for the points in the output.
+  vtkPoints *newPts = vtkPoints::New();
+  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+    {
+    newPts->SetDataType(inPts->GetDataType());
+    }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+    {
+    newPts->SetDataType(VTK_FLOAT);
+    }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+    {
+    newPts->SetDataType(VTK_DOUBLE);
+    }
+  newPts->SetNumberOfPoints(numNewPts);
+  outPD->CopyAllocate(pd, numNewPts);
+  outPD->SetNumberOfTuples(numNewPts);
+  vtkFeatureEdgesCopyPoints copyPoints;
+  copyPoints.InPoints = inPts;
+  copyPoints.OriginalIds = &originalIds[0];
+  copyPoints.OutPoints = newPts;
+  copyPoints.InPD = pd;
+  copyPoints.OutPD = outPD;
+  if ( vtkFeatureEdgesAreArraysThreadSafe(pd) &&
+       vtkFeatureEdgesAreArraysThreadSafe(outPD) )
+    {
+    vtkSMPTools::For(0, numNewPts, copyPoints);
+    }
+  else
+    {
+    copyPoints(0, numNewPts);
+    }
+
+  vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+  connectivity->SetNumberOfValues(3*numLines);
+  vtkFloatArray *newScalars = NULL;
+  if ( this->Coloring )
+    {
+    newScalars = vtkFloatArray::New();
+    newScalars->SetName("Edge Types");
+    newScalars->SetNumberOfTuples(numLines);
+    }
+  outCD->CopyAllocate(cd, numLines);
+  outCD->SetNumberOfTuples(numLines);
+  vtkFeatureEdgesCopyLines copyLines;
+  copyLines.Segments = &segments[0];
+  copyLines.CellIds = &cellIds[0];
+  copyLines.LineIds = &lineIds[0];
+  copyLines.PointMap = &pointMap[0];
+  copyLines.Scalars = &scalars[0];
+  copyLines.Connectivity = connectivity->GetPointer(0);
+  copyLines.OutScalars = newScalars ? newScalars->GetPointer(0) : NULL;
+  copyLines.InCD = cd;
+  copyLines.OutCD = outCD;
+  if ( vtkFeatureEdgesAreArraysThreadSafe(cd) &&
+       vtkFeatureEdgesAreArraysThreadSafe(outCD) )
+    {
+    vtkSMPTools::For(0, numSegments, copyLines);
+    }
+  else
+    {
+    copyLines(0, numSegments);
+    }
+
+  vtkCellArray *newLines = vtkCellArray::New();
+  newLines->SetCells(numLines, connectivity);
+  connectivity->Delete();
+
+  vtkDebugMacro(<<"Created " << numLines << " edges");
+
+  output->SetPoints(newPts);
+  newPts->Delete();
+  output->SetLines(newLines);
+  newLines->Delete();
+  if ( this->Coloring )
+    {
+    int idx = outCD->AddArray(newScalars);
+    outCD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+    newScalars->Delete();
+    }
+
+  return 1;
+}
+
 void vtkFeatureEdges::CreateDefaultLocator()
 {
   if ( this->Locator == NULL )
@@ -468,4 +874,6 @@ void vtkFeatureEdges::PrintSelf(ostream& os, vtkIndent indent)
     }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Extract In Parallel: "
+     << (this->ExtractInParallel ? "On\n" : "Off\n");
 }
@@ -23,6 +23,13 @@
 // combination. Edges may also be "colored" (i.e., scalar values assigned)
 // based on edge type. The cell coloring is assigned to the cell data of
 // the extracted edges.
+//
+// When ExtractInParallel is on, the polygon edges are generated and sorted
+// in parallel (see vtkStaticEdgeLocatorTemplate), and the cells using each
+// edge are found from the groups of equal edges instead of the cell links.
+// The output lines are the same and in the same order, but the locator is
+// not used: the output points are the input points used by the lines, in
+// input order.
 
 // .SECTION Caveats
 // To see the coloring of the liens you may have to set the ScalarMode
@@ -107,6 +114,12 @@ public:
   vtkSetMacro(OutputPointsPrecision,int);
   vtkGetMacro(OutputPointsPrecision,int);
 
+  // Description:
+  // Turn on/off the parallel extraction of the edges. The default is off.
+  vtkSetMacro(ExtractInParallel,int);
+  vtkGetMacro(ExtractInParallel,int);
+  vtkBooleanMacro(ExtractInParallel,int);
+
 protected:
   vtkFeatureEdges();
   ~vtkFeatureEdges();
@@ -122,7 +135,13 @@ protected:
   int ManifoldEdges;
   int Coloring;
   int OutputPointsPrecision;
+  int ExtractInParallel;
   vtkIncrementalPointLocator *Locator;
+
+  // Extract the edges of the polygons of mesh, which holds the polygons
+  // and triangulated strips of input, with vtkSMPTools.
+  int ExtractEdgesInParallel(vtkPolyData *input, vtkPolyData *mesh,
+                             unsigned char *ghosts, vtkPolyData *output);
 private:
   vtkFeatureEdges(const vtkFeatureEdges&);  // Not implemented.
   void operator=(const vtkFeatureEdges&);  // Not implemented.
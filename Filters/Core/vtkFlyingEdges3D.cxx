@@ -29,6 +29,7 @@
 #include "vtkSMPTools.h"
 
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkFlyingEdges3D);
 
@@ -377,12 +378,112 @@ public:
         }
     };
 
+
+  // The passes of a single sweep over the volume for several contour values.
+  // Algos holds one algorithm instance (i.e., edge cases and meta data) per
+  // contour value. Each row, and then each slice, is processed for all the
+  // values before moving on, so the scalars are read from memory once.
+  template <class TT> class SweepPass1
+    {
+    public:
+      vtkFlyingEdges3DAlgorithm<TT> *Algos;
+      const double *Values;
+      int NumberOfValues;
+      SweepPass1(vtkFlyingEdges3DAlgorithm<TT> *algos, const double *values,
+                 int numValues)
+        {this->Algos = algos; this->Values = values;
+         this->NumberOfValues = numValues;}
+      void  operator()(vtkIdType slice, vtkIdType end)
+        {
+        vtkFlyingEdges3DAlgorithm<TT> *algo = this->Algos;
+        vtkIdType row;
+        TT *rowPtr, *slicePtr = algo->Scalars + slice*algo->Inc2;
+        for ( ; slice < end; ++slice )
+          {
+          for (row=0, rowPtr=slicePtr; row < algo->Dims[1]; ++row)
+            {
+            for (int v=0; v < this->NumberOfValues; ++v)
+              {
+              this->Algos[v].ProcessXEdge(this->Values[v], rowPtr, row, slice);
+              }
+            rowPtr += algo->Inc1;
+            }//for all rows in this slice
+          slicePtr += algo->Inc2;
+          }//for all slices in this batch
+        }
+    };
+  template <class TT> class SweepPass2
+    {
+    public:
+      vtkFlyingEdges3DAlgorithm<TT> *Algos;
+      int NumberOfValues;
+      SweepPass2(vtkFlyingEdges3DAlgorithm<TT> *algos, int numValues)
+        {this->Algos = algos; this->NumberOfValues = numValues;}
+      void  operator()(vtkIdType slice, vtkIdType end)
+        {
+        for ( ; slice < end; ++slice)
+          {
+          for (int v=0; v < this->NumberOfValues; ++v)
+            {
+            for ( vtkIdType row=0; row < (this->Algos->Dims[1]-1); ++row)
+              {
+              this->Algos[v].ProcessYZEdges(row, slice);
+              }//for all rows in this slice
+            }//for all values
+          }//for all slices in this batch
+        }
+    };
+  template <class TT> class SweepPass4
+    {
+    public:
+      vtkFlyingEdges3DAlgorithm<TT> *Algos;
+      const double *Values;
+      int NumberOfValues;
+      SweepPass4(vtkFlyingEdges3DAlgorithm<TT> *algos, const double *values,
+                 int numValues)
+        {this->Algos = algos; this->Values = values;
+         this->NumberOfValues = numValues;}
+      void  operator()(vtkIdType slice, vtkIdType end)
+        {
+        vtkFlyingEdges3DAlgorithm<TT> *algo = this->Algos;
+        vtkIdType row;
+        TT *rowPtr, *slicePtr = algo->Scalars + slice*algo->Inc2;
+        for ( ; slice < end; ++slice )
+          {
+          for (int v=0; v < this->NumberOfValues; ++v)
+            {
+            vtkFlyingEdges3DAlgorithm<TT> *vAlgo = this->Algos + v;
+            vtkIdType *eMD0 = vAlgo->EdgeMetaData + slice*6*algo->Dims[1];
+            vtkIdType *eMD1 = eMD0 + 6*algo->Dims[1];
+            if ( eMD1[3] > eMD0[3] ) //there are triangle primitives!
+              {
+              for (row=0, rowPtr=slicePtr; row < algo->Dims[1]-1; ++row)
+                {
+                vAlgo->GenerateOutput(this->Values[v], rowPtr, row, slice);
+                rowPtr += algo->Inc1;
+                }//for all rows in this slice
+              }//if there are triangles
+            }//for all values
+          slicePtr += algo->Inc2;
+          }//for all slices in this batch
+        }
+    };
+
   // Interface between VTK and templated functions
   static void Contour(vtkFlyingEdges3D *self, vtkImageData *input,
                       int extent[6], vtkIdType *incs, T *scalars,
                       vtkPoints *newPts, vtkCellArray *newTris,
                       vtkDataArray *newScalars,vtkFloatArray *newNormals,
                       vtkFloatArray *newGradients);
+
+  // Contour all the values in a single sweep, see
+  // vtkFlyingEdges3D::SetSingleSweep(). algo is set up for the volume.
+  static void ContourAllValues(vtkFlyingEdges3DAlgorithm<T> &algo,
+                               const double *values, int numContours,
+                               vtkPoints *newPts, vtkCellArray *newTris,
+                               vtkDataArray *newScalars,
+                               vtkFloatArray *newNormals,
+                               vtkFloatArray *newGradients);
 };
 
 //----------------------------------------------------------------------------
@@ -1104,6 +1205,14 @@ Contour(vtkFlyingEdges3D *self, vtkImageData *input, int extent[6],
   algo.Dims[2] = algo.Max2 - algo.Min2 + 1;
   algo.NumberOfEdges = algo.Dims[1]*algo.Dims[2];
   algo.SliceOffset = (algo.Dims[0]-1) * algo.Dims[1];
+
+  if ( numContours > 1 && self->GetSingleSweep() )
+    {
+    ContourAllValues(algo, values, numContours, newPts, newTris, newScalars,
+                     newNormals, newGradients);
+    return;
+    }
+
   algo.XCases = new unsigned char [(algo.Dims[0]-1)*algo.NumberOfEdges];
 
   // Also allocate the characterization (metadata) array for the x edges.
@@ -1217,6 +1326,116 @@ Contour(vtkFlyingEdges3D *self, vtkImageData *input, int extent[6],
   delete [] algo.EdgeMetaData;
 }
 
+//----------------------------------------------------------------------------
+// Same as the loop over the contour values of Contour(), with each pass
+// done for all the values at once. The prefix sum visits the values in
+// order, so the points and triangles are numbered as in Contour().
+template <class T> void vtkFlyingEdges3DAlgorithm<T>::
+ContourAllValues(vtkFlyingEdges3DAlgorithm<T> &algo, const double *values,
+                 int numContours, vtkPoints *newPts, vtkCellArray *newTris,
+                 vtkDataArray *newScalars, vtkFloatArray *newNormals,
+                 vtkFloatArray *newGradients)
+{
+  vtkIdType vidx, row, slice, *eMD, zInc;
+  vtkIdType numXPts, numYPts, numZPts, numTris;
+  vtkIdType numOutXPts=0, numOutYPts=0, numOutZPts=0, numOutTris=0;
+
+  // One copy of the algorithm per value, each with its own x-edge cases and
+  // edge meta data.
+  std::vector<vtkFlyingEdges3DAlgorithm<T> > algos(numContours, algo);
+  for (vidx = 0; vidx < numContours; vidx++)
+    {
+    algos[vidx].XCases =
+      new unsigned char [(algo.Dims[0]-1)*algo.NumberOfEdges];
+    algos[vidx].EdgeMetaData = new vtkIdType [algo.NumberOfEdges*6];
+    }
+
+  // PASS 1 and PASS 2 for all the values.
+  SweepPass1<T> pass1(&algos[0],values,numContours);
+  vtkSMPTools::For(0,algo.Dims[2], pass1);
+  SweepPass2<T> pass2(&algos[0],numContours);
+  vtkSMPTools::For(0,algo.Dims[2]-1, pass2);
+
+  // PASS 3: count the points and triangles of each value in turn.
+  std::vector<vtkIdType> valuePts(numContours+1, 0);
+  for (vidx = 0; vidx < numContours; vidx++)
+    {
+    vtkIdType startPts = numOutXPts + numOutYPts + numOutZPts;
+    for (slice=0; slice < algo.Dims[2]; ++slice)
+      {
+      zInc = slice * algo.Dims[1];
+      for (row=0; row < algo.Dims[1]; ++row)
+        {
+        eMD = algos[vidx].EdgeMetaData + (zInc+row)*6;
+        numXPts = eMD[0];
+        numYPts = eMD[1];
+        numZPts = eMD[2];
+        numTris = eMD[3];
+        eMD[0] = numOutXPts + numOutYPts + numOutZPts;
+        eMD[1] = eMD[0] + numXPts;
+        eMD[2] = eMD[1] + numYPts;
+        eMD[3] = numOutTris;
+        numOutXPts += numXPts;
+        numOutYPts += numYPts;
+        numOutZPts += numZPts;
+        numOutTris += numTris;
+        }
+      }
+    valuePts[vidx] = startPts;
+    }
+  vtkIdType totalPts = numOutXPts + numOutYPts + numOutZPts;
+  valuePts[numContours] = totalPts;
+
+  // Output can now be allocated, once for all the values.
+  if ( totalPts > 0 )
+    {
+    newPts->GetData()->WriteVoidPointer(0,3*totalPts);
+    newTris->WritePointer(numOutTris,4*numOutTris);
+    T *outScalars = NULL;
+    if (newScalars)
+      {
+      newScalars->WriteVoidPointer(0,totalPts);
+      outScalars = static_cast<T*>(newScalars->GetVoidPointer(0));
+      for (vidx = 0; vidx < numContours; vidx++)
+        {
+        std::fill(outScalars+valuePts[vidx], outScalars+valuePts[vidx+1],
+                  static_cast<T>(values[vidx]));
+        }
+      }
+    float *outGradients = NULL, *outNormals = NULL;
+    if (newGradients)
+      {
+      newGradients->WriteVoidPointer(0,3*totalPts);
+      outGradients = static_cast<float*>(newGradients->GetVoidPointer(0));
+      }
+    if (newNormals)
+      {
+      newNormals->WriteVoidPointer(0,3*totalPts);
+      outNormals = static_cast<float*>(newNormals->GetVoidPointer(0));
+      }
+    for (vidx = 0; vidx < numContours; vidx++)
+      {
+      algos[vidx].NewPoints = static_cast<float*>(newPts->GetVoidPointer(0));
+      algos[vidx].NewTris = static_cast<vtkIdType*>(newTris->GetPointer());
+      algos[vidx].NewScalars = outScalars;
+      algos[vidx].NewGradients = outGradients;
+      algos[vidx].NewNormals = outNormals;
+      algos[vidx].NeedGradients = (outGradients || outNormals);
+      }
+
+    // PASS 4 for all the values, slice by slice.
+    SweepPass4<T> pass4(&algos[0],values,numContours);
+    vtkSMPTools::For(0,algo.Dims[2]-1, pass4);
+    }
+
+  // Clean up and return
+  for (vidx = 0; vidx < numContours; vidx++)
+    {
+    delete [] algos[vidx].XCases;
+    delete [] algos[vidx].EdgeMetaData;
+    }
+}
+
 //----------------------------------------------------------------------------
 // Here is the VTK class proper.
 // Construct object with a single contour value of 0.0.
@@ -1226,6 +1445,7 @@ vtkFlyingEdges3D::vtkFlyingEdges3D()
   this->ComputeNormals = 1;
   this->ComputeGradients = 0;
   this->ComputeScalars = 1;
+  this->SingleSweep = 0;
   this->ArrayComponent = 0;
 
   // by default process active point scalars
@@ -1422,5 +1642,6 @@ void vtkFlyingEdges3D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Compute Normals: " << (this->ComputeNormals ? "On\n" : "Off\n");
   os << indent << "Compute Gradients: " << (this->ComputeGradients ? "On\n" : "Off\n");
   os << indent << "Compute Scalars: " << (this->ComputeScalars ? "On\n" : "Off\n");
+  os << indent << "Single Sweep: " << (this->SingleSweep ? "On\n" : "Off\n");
   os << indent << "ArrayComponent: " << this->ArrayComponent << endl;
 }
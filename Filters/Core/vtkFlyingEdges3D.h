@@ -100,6 +100,18 @@ public:
   vtkGetMacro(ComputeScalars,int);
   vtkBooleanMacro(ComputeScalars,int);
 
+  // Description:
+  // Set/Get whether multiple contour values are processed in a single sweep
+  // over the volume rather than in one sweep per value. Each row of the
+  // volume is then classified for all the values, and the points, gradients
+  // and normals of all the values are generated slice by slice, while the
+  // slice is in cache. The output is the same, but the edge cases of all the
+  // values are kept at once (one byte per voxel and per value). Off by
+  // default.
+  vtkSetMacro(SingleSweep,int);
+  vtkGetMacro(SingleSweep,int);
+  vtkBooleanMacro(SingleSweep,int);
+
   // Description:
   // Set a particular contour value at contour number i. The index i ranges
   // between 0<=i<NumberOfContours.
@@ -157,6 +169,7 @@ protected:
   int ComputeNormals;
   int ComputeGradients;
   int ComputeScalars;
+  int SingleSweep;
   int ArrayComponent;
   vtkContourValues *ContourValues;
 
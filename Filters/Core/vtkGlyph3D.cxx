@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkGlyph3D.h"
 
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCell.h"
 #include "vtkFloatArray.h"
@@ -26,6 +27,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -33,9 +35,327 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
 
+//----------------------------------------------------------------------------
+namespace
+{
+bool vtkGlyph3DIsArrayThreadSafe(vtkAbstractArray *array)
+{
+  vtkDataArray *dataArray = vtkDataArray::SafeDownCast(array);
+  return dataArray && dataArray->GetDataType() != VTK_BIT &&
+    dataArray->HasStandardMemoryLayout();
+}
+
+bool vtkGlyph3DAreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    if (!vtkGlyph3DIsArrayThreadSafe(fd->GetAbstractArray(i)))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Returns which cell array of source holds its cells (0 to 3 for the verts,
+// lines, polys and strips), -1 if it has no cells and 4 if they are spread
+// over several arrays.
+int vtkGlyph3DGetSourceCells(vtkPolyData *source, vtkCellArray *&cells)
+{
+  vtkCellArray *arrays[4] = { source->GetVerts(), source->GetLines(),
+                              source->GetPolys(), source->GetStrips() };
+  int kind = -1;
+  for (int i = 0; i < 4; ++i)
+    {
+    if (arrays[i] && arrays[i]->GetNumberOfCells() > 0)
+      {
+      if (kind >= 0)
+        {
+        return 4;
+        }
+      kind = i;
+      cells = arrays[i];
+      }
+    }
+  return kind;
+}
+
+// A glyph source, with its points moved by the source transform.
+struct vtkGlyph3DSource
+{
+  vtkGlyph3DSource() : Source(NULL), NumberOfPoints(0), NumberOfCells(0),
+    ConnectivitySize(0), Connectivity(NULL) {}
+
+  vtkPolyData *Source;
+  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfCells;
+  vtkIdType ConnectivitySize;
+  const vtkIdType *Connectivity;
+  std::vector<double> Points;
+  std::vector<double> Normals;
+};
+
+// Glyphs the input points of ranges of Chunk points: the glyphs of a chunk
+// start at the offsets counted before the chunk.
+struct vtkGlyph3DGenerateGlyphs
+{
+  static const vtkIdType Chunk = 1024;
+
+  vtkDataSet *Input;
+  vtkIdType NumberOfPoints;
+  const int *SourceIndices;
+  const vtkGlyph3DSource *Sources;
+  const vtkIdType *PointOffsets;
+  const vtkIdType *CellOffsets;
+  const vtkIdType *ConnectivityOffsets;
+
+  vtkDataArray *InSScalars;
+  vtkDataArray *InCScalars;
+  vtkDataArray *InVectors; // vectors or normals, if they orient the glyphs
+  int Scaling;
+  int ScaleMode;
+  int ColorMode;
+  double ScaleFactor;
+  double Range[2];
+  double Den;
+  int Orient;
+  int Clamping;
+
+  float *NewPts;
+  float *NewVectors;
+  float *NewNormals;
+  vtkDataArray *NewScalars;
+  float *NewTCoords;
+  int NumberOfTCoordComponents;
+  const double *SourceTCoords;
+  vtkIdType *PointIds;
+  vtkPointData *InPD;
+  vtkPointData *OutPD;
+  vtkCellData *OutCD;
+  vtkIdType *Connectivity;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3], v[3], vMag = 0.0, s = 0.0, scale[3], rotation[3][3], q[3];
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+      vtkIdType ptOffset = this->PointOffsets[chunk];
+      vtkIdType cellOffset = this->CellOffsets[chunk];
+      vtkIdType connOffset = this->ConnectivityOffsets[chunk];
+      vtkIdType lastPtId = std::min((chunk + 1) * Chunk, this->NumberOfPoints);
+      for (vtkIdType inPtId = chunk * Chunk; inPtId < lastPtId; ++inPtId)
+        {
+        int index = this->SourceIndices[inPtId];
+        if (index < 0)
+          {
+          continue;
+          }
+        const vtkGlyph3DSource &source = this->Sources[index];
+        vtkIdType numSourcePts = source.NumberOfPoints;
+
+        // Get the scalar and vector data, as the serial code does
+        scale[0] = scale[1] = scale[2] = 1.0;
+        if (this->InSScalars)
+          {
+          s = this->InSScalars->GetComponent(inPtId, 0);
+          if (this->ScaleMode == VTK_SCALE_BY_SCALAR ||
+              this->ScaleMode == VTK_DATA_SCALING_OFF)
+            {
+            scale[0] = scale[1] = scale[2] = s;
+            }
+          }
+        if (this->InVectors)
+          {
+          v[0] = v[1] = v[2] = 0.0;
+          this->InVectors->GetTuple(inPtId, v);
+          vMag = vtkMath::Norm(v);
+          if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+            {
+            scale[0] = v[0];
+            scale[1] = v[1];
+            scale[2] = v[2];
+            }
+          else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+            {
+            scale[0] = scale[1] = scale[2] = vMag;
+            }
+          }
+        if (this->Clamping)
+          {
+          for (int j = 0; j < 3; ++j)
+            {
+            scale[j] = (scale[j] < this->Range[0] ? this->Range[0] :
+                        (scale[j] > this->Range[1] ? this->Range[1] :
+                         scale[j]));
+            scale[j] = (scale[j] - this->Range[0]) / this->Den;
+            }
+          }
+
+        // Attributes that do not depend on the glyph transform
+        for (vtkIdType i = 0; i < numSourcePts; ++i)
+          {
+          vtkIdType ptId = ptOffset + i;
+          if (this->NewVectors)
+            {
+            for (int j = 0; j < 3; ++j)
+              {
+              this->NewVectors[3 * ptId + j] = static_cast<float>(v[j]);
+              }
+            }
+          if (this->NewScalars)
+            {
+            if (this->ColorMode == VTK_COLOR_BY_SCALAR)
+              {
+              this->NewScalars->SetTuple(ptId, inPtId, this->InCScalars);
+              }
+            else if (this->ColorMode == VTK_COLOR_BY_SCALE)
+              {
+              this->NewScalars->SetComponent(ptId, 0, scale[0]);
+              }
+            else
+              {
+              this->NewScalars->SetComponent(ptId, 0, vMag);
+              }
+            }
+          if (this->NewTCoords)
+            {
+            int numComps = this->NumberOfTCoordComponents;
+            for (int j = 0; j < numComps; ++j)
+              {
+              this->NewTCoords[numComps * ptId + j] =
+                static_cast<float>(this->SourceTCoords[numComps * i + j]);
+              }
+            }
+          if (this->PointIds)
+            {
+            this->PointIds[ptId] = inPtId;
+            }
+          if (this->InPD)
+            {
+            this->OutPD->CopyData(this->InPD, inPtId, ptId);
+            }
+          }
+        if (this->OutCD)
+          {
+          for (vtkIdType i = 0; i < source.NumberOfCells; ++i)
+            {
+            this->OutCD->CopyData(this->InPD, inPtId, cellOffset + i);
+            }
+          }
+
+        // Glyph transform: translation to the point, rotation onto the
+        // vector and scaling, applied in reverse order.
+        rotation[0][0] = rotation[1][1] = rotation[2][2] = 1.0;
+        rotation[0][1] = rotation[0][2] = rotation[1][0] = 0.0;
+        rotation[1][2] = rotation[2][0] = rotation[2][1] = 0.0;
+        if (this->InVectors && this->Orient && vMag > 0.0)
+          {
+          if (v[1] == 0.0 && v[2] == 0.0)
+            {
+            if (v[0] < 0) // 180 degrees around y
+              {
+              rotation[0][0] = rotation[2][2] = -1.0;
+              }
+            }
+          else
+            {
+            // 180 degrees around the bisector n of v and x: 2 n n^T - I
+            double n[3] = { (v[0] + vMag) / 2.0, v[1] / 2.0, v[2] / 2.0 };
+            vtkMath::Normalize(n);
+            for (int j = 0; j < 3; ++j)
+              {
+              for (int k = 0; k < 3; ++k)
+                {
+                rotation[j][k] = 2.0 * n[j] * n[k] - (j == k ? 1.0 : 0.0);
+                }
+              }
+            }
+          }
+        if (this->Scaling)
+          {
+          for (int j = 0; j < 3; ++j)
+            {
+            scale[j] = (this->ScaleMode == VTK_DATA_SCALING_OFF ?
+                        this->ScaleFactor : scale[j] * this->ScaleFactor);
+            if (scale[j] == 0.0)
+              {
+              scale[j] = 1.0e-10;
+              }
+            }
+          }
+        else
+          {
+          scale[0] = scale[1] = scale[2] = 1.0;
+          }
+
+        this->Input->GetPoint(inPtId, x);
+        const double *p = &source.Points[0];
+        float *newPt = this->NewPts + 3 * ptOffset;
+        for (vtkIdType i = 0; i < numSourcePts; ++i, p += 3, newPt += 3)
+          {
+          q[0] = scale[0] * p[0];
+          q[1] = scale[1] * p[1];
+          q[2] = scale[2] * p[2];
+          for (int j = 0; j < 3; ++j)
+            {
+            newPt[j] = static_cast<float>(
+              rotation[j][0] * q[0] + rotation[j][1] * q[1] +
+              rotation[j][2] * q[2] + x[j]);
+            }
+          }
+
+        // normals are transformed by the inverse transpose of the matrix
+        if (this->NewNormals)
+          {
+          const double *n = &source.Normals[0];
+          float *newNormal = this->NewNormals + 3 * ptOffset;
+          for (vtkIdType i = 0; i < numSourcePts; ++i, n += 3, newNormal += 3)
+            {
+            double m[3];
+            q[0] = n[0] / scale[0];
+            q[1] = n[1] / scale[1];
+            q[2] = n[2] / scale[2];
+            for (int j = 0; j < 3; ++j)
+              {
+              m[j] = rotation[j][0] * q[0] + rotation[j][1] * q[1] +
+                rotation[j][2] * q[2];
+              }
+            vtkMath::Normalize(m);
+            newNormal[0] = static_cast<float>(m[0]);
+            newNormal[1] = static_cast<float>(m[1]);
+            newNormal[2] = static_cast<float>(m[2]);
+            }
+          }
+
+        // Copy the topology, shifted to the points of the glyph
+        const vtkIdType *cell = source.Connectivity;
+        const vtkIdType *cellEnd = cell + source.ConnectivitySize;
+        vtkIdType *newCell = this->Connectivity + connOffset;
+        while (cell < cellEnd)
+          {
+          vtkIdType npts = *cell++;
+          *newCell++ = npts;
+          for (vtkIdType i = 0; i < npts; ++i)
+            {
+            *newCell++ = *cell++ + ptOffset;
+            }
+          }
+
+        ptOffset += numSourcePts;
+        cellOffset += source.NumberOfCells;
+        connOffset += source.ConnectivitySize;
+        }
+      }
+  }
+};
+}
+
 //----------------------------------------------------------------------------
 // Construct object with scaling on, scaling mode is by scalar value,
 // scale factor = 1.0, the range is (0,1), orient geometry is on, and
@@ -403,12 +723,230 @@ bool vtkGlyph3D::Execute(
   transformedSourcePts->SetDataTypeToDouble();
   transformedSourcePts->Allocate(numSourcePts);
 
-  // Traverse all Input points, transforming Source points and copying
-  // point attributes.
+  // Glyph in parallel when the glyphs can be written at offsets known
+  // beforehand. This needs the cells of all the sources in the same cell
+  // array (verts, lines, polys or strips), so that the output cells keep
+  // the serial order, and attribute arrays that can be written from
+  // several threads.
+  vtkDataArray *array3D = NULL;
+  if ( haveVectors )
+    {
+    array3D = this->VectorMode == VTK_USE_NORMAL? inNormals : inVectors;
+    }
+  bool parallel = (!array3D || array3D->GetNumberOfComponents() <= 3) &&
+    (!pd || vtkGlyph3DAreArraysThreadSafe(pd)) &&
+    (!newScalars || (vtkGlyph3DIsArrayThreadSafe(newScalars) &&
+                     (this->ColorMode != VTK_COLOR_BY_SCALAR ||
+                      vtkGlyph3DIsArrayThreadSafe(inCScalars))));
+  int cellsKind = -1;
+  int numGlyphSources =
+    (this->IndexMode != VTK_INDEXING_OFF ? numberOfSources : 1);
+  std::vector<vtkGlyph3DSource> glyphSources(numGlyphSources);
+  for (i=0; parallel && i < numGlyphSources; i++)
+    {
+    vtkPolyData *glyphSource = (this->IndexMode != VTK_INDEXING_OFF ?
+                                this->GetSource(i, sourceVector) : source);
+    vtkGlyph3DSource &glyph = glyphSources[i];
+    glyph.Source = glyphSource;
+    if ( !glyphSource )
+      {
+      continue;
+      }
+    vtkCellArray *cells = NULL;
+    int kind = vtkGlyph3DGetSourceCells(glyphSource, cells);
+    if ( kind > 3 || (kind >= 0 && cellsKind >= 0 && kind != cellsKind) )
+      {
+      parallel = false;
+      break;
+      }
+    if ( kind >= 0 )
+      {
+      cellsKind = kind;
+      glyph.Connectivity = cells->GetPointer();
+      glyph.ConnectivitySize = cells->GetNumberOfConnectivityEntries();
+      }
+    glyph.NumberOfCells = glyphSource->GetNumberOfCells();
+    glyph.NumberOfPoints = glyphSource->GetNumberOfPoints();
+    glyph.Points.resize(3*glyph.NumberOfPoints);
+    for (vtkIdType j=0; j < glyph.NumberOfPoints; j++)
+      {
+      glyphSource->GetPoint(j, x);
+      if (this->SourceTransform)
+        {
+        this->SourceTransform->TransformPoint(x, x);
+        }
+      std::copy(x, x + 3, &glyph.Points[3*j]);
+      }
+    if ( haveNormals )
+      {
+      vtkDataArray *normals = glyphSource->GetPointData()->GetNormals();
+      glyph.Normals.resize(3*glyph.NumberOfPoints);
+      for (vtkIdType j=0; j < glyph.NumberOfPoints; j++)
+        {
+        normals->GetTuple(j, &glyph.Normals[3*j]);
+        }
+      }
+    }
+
+  if ( parallel )
+    {
+    // Select the source of each point and count the output of the points
+    // before each chunk of points.
+    const vtkIdType chunk = vtkGlyph3DGenerateGlyphs::Chunk;
+    vtkIdType numChunks = (numPts + chunk - 1) / chunk;
+    std::vector<int> sourceIndices(numPts, -1);
+    std::vector<vtkIdType> ptOffsets(numChunks, 0);
+    std::vector<vtkIdType> cellOffsets(numChunks, 0);
+    std::vector<vtkIdType> connOffsets(numChunks, 0);
+    vtkIdType numNewPts = 0, numNewCells = 0, connSize = 0;
+    for (inPtId=0; inPtId < numPts; inPtId++)
+      {
+      if ( ! (inPtId % chunk) )
+        {
+        ptOffsets[inPtId / chunk] = numNewPts;
+        cellOffsets[inPtId / chunk] = numNewCells;
+        connOffsets[inPtId / chunk] = connSize;
+        }
+      if ( ! (inPtId % 10000) )
+        {
+        this->UpdateProgress(0.5*inPtId/numPts);
+        if (this->GetAbortExecute())
+          {
+          break;
+          }
+        }
+
+      int index = 0;
+      if ( this->IndexMode != VTK_INDEXING_OFF )
+        {
+        if ( this->IndexMode == VTK_INDEXING_BY_SCALAR )
+          {
+          value = inSScalars->GetComponent(inPtId, 0);
+          }
+        else
+          {
+          v[0] = v[1] = v[2] = 0.0;
+          array3D->GetTuple(inPtId, v);
+          value = vtkMath::Norm(v);
+          }
+        index = static_cast<int>((value - this->Range[0])*numberOfSources / den);
+        index = (index < 0 ? 0 :
+                (index >= numberOfSources ? (numberOfSources-1) : index));
+        }
+      if ( !glyphSources[index].Source ||
+           (inGhostLevels &&
+            inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT) ||
+           (inputUG && !inputUG->IsPointVisible(inPtId)) ||
+           !this->IsPointVisible(input, inPtId) )
+        {
+        continue;
+        }
+      sourceIndices[inPtId] = index;
+      numNewPts += glyphSources[index].NumberOfPoints;
+      numNewCells += glyphSources[index].NumberOfCells;
+      connSize += glyphSources[index].ConnectivitySize;
+      }
+
+    newPts->SetNumberOfPoints(numNewPts);
+    outputPD->SetNumberOfTuples(numNewPts);
+    if ( pd && this->FillCellData )
+      {
+      outputCD->SetNumberOfTuples(numNewCells);
+      }
+    if ( newScalars )
+      {
+      newScalars->SetNumberOfTuples(numNewPts);
+      }
+    if ( newVectors )
+      {
+      newVectors->SetNumberOfTuples(numNewPts);
+      }
+    if ( newNormals )
+      {
+      newNormals->SetNumberOfTuples(numNewPts);
+      }
+    std::vector<double> tcoords;
+    if ( haveTCoords )
+      {
+      int numComps = sourceTCoords->GetNumberOfComponents();
+      newTCoords->SetNumberOfTuples(numNewPts);
+      tcoords.resize(numComps*numSourcePts);
+      for (i=0; i < numSourcePts; i++)
+        {
+        sourceTCoords->GetTuple(i, &tcoords[numComps*i]);
+        }
+      }
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->SetNumberOfTuples(connSize);
+
+    vtkGlyph3DGenerateGlyphs generate;
+    generate.Input = input;
+    generate.NumberOfPoints = numPts;
+    generate.SourceIndices = &sourceIndices[0];
+    generate.Sources = &glyphSources[0];
+    generate.PointOffsets = &ptOffsets[0];
+    generate.CellOffsets = &cellOffsets[0];
+    generate.ConnectivityOffsets = &connOffsets[0];
+    generate.InSScalars = inSScalars;
+    generate.InCScalars = inCScalars;
+    generate.InVectors = array3D;
+    generate.Scaling = this->Scaling;
+    generate.ScaleMode = this->ScaleMode;
+    generate.ColorMode = this->ColorMode;
+    generate.ScaleFactor = this->ScaleFactor;
+    generate.Range[0] = this->Range[0];
+    generate.Range[1] = this->Range[1];
+    generate.Den = den;
+    generate.Orient = this->Orient;
+    generate.Clamping = this->Clamping;
+    generate.NewPts =
+      static_cast<vtkFloatArray *>(newPts->GetData())->GetPointer(0);
+    generate.NewVectors = newVectors ?
+      static_cast<vtkFloatArray *>(newVectors)->GetPointer(0) : NULL;
+    generate.NewNormals = newNormals ?
+      static_cast<vtkFloatArray *>(newNormals)->GetPointer(0) : NULL;
+    generate.NewScalars = newScalars;
+    generate.NewTCoords = newTCoords ?
+      static_cast<vtkFloatArray *>(newTCoords)->GetPointer(0) : NULL;
+    generate.NumberOfTCoordComponents =
+      newTCoords ? newTCoords->GetNumberOfComponents() : 0;
+    generate.SourceTCoords = tcoords.empty() ? NULL : &tcoords[0];
+    generate.PointIds = pointIds ? pointIds->GetPointer(0) : NULL;
+    generate.InPD = pd;
+    generate.OutPD = outputPD;
+    generate.OutCD = (pd && this->FillCellData) ? outputCD : NULL;
+    generate.Connectivity = connectivity->GetPointer(0);
+    vtkSMPTools::For(0, numChunks, 1, generate);
+
+    // The cells were allocated for InsertNextCell(): replace them.
+    output->DeleteCells();
+    if ( cellsKind >= 0 )
+      {
+      vtkNew<vtkCellArray> cells;
+      cells->SetCells(numNewCells, connectivity.GetPointer());
+      switch (cellsKind)
+        {
+        case 0:
+          output->SetVerts(cells.GetPointer());
+          break;
+        case 1:
+          output->SetLines(cells.GetPointer());
+          break;
+        case 2:
+          output->SetPolys(cells.GetPointer());
+          break;
+        default:
+          output->SetStrips(cells.GetPointer());
+        }
+      }
+    }
+
+  // Otherwise traverse all Input points, transforming Source points and
+  // copying point attributes.
   //
   ptIncr=0;
   cellIncr=0;
-  for (inPtId=0; inPtId < numPts; inPtId++)
+  for (inPtId=0; !parallel && inPtId < numPts; inPtId++)
     {
     scalex = scaley = scalez = 1.0;
     if ( ! (inPtId % 10000) )
@@ -65,6 +65,12 @@
 // color scalars by using the SetInputArrayToProcess methods in
 // vtkAlgorithm. The first array is scalars, the next vectors, the next
 // normals and finally color scalars.
+//
+// The glyphs are generated in parallel (via vtkSMPTools) when the cells of
+// every source lie in a single cell array of the same type (all polygons,
+// for instance) and the point data arrays of the input have a standard
+// memory layout. The output is then the same as the serial one, except
+// that the points are transformed without the intermediate vtkTransform.
 
 // .SECTION See Also
 // vtkTensorGlyph
@@ -0,0 +1,597 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGridFlyingEdges3D.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkGridFlyingEdges3D.h"
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkFloatArray.h"
+#include "vtkFlyingEdges3D.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+vtkStandardNewMacro(vtkGridFlyingEdges3D);
+
+namespace
+{
+// The points of a structured grid, or the coordinates of a rectilinear
+// grid copied to double precision, so that they can be read from several
+// threads.
+class vtkGridFlyingEdgesGeometry
+{
+public:
+  vtkPoints *Points;
+  std::vector<double> Coordinates[3];
+  vtkIdType Dims[3];
+
+  void GetPoint(const vtkIdType ijk[3], double x[3]) const
+  {
+    if (this->Points)
+      {
+      this->Points->GetPoint(
+        ijk[0] + this->Dims[0] * (ijk[1] + this->Dims[1] * ijk[2]), x);
+      }
+    else
+      {
+      x[0] = this->Coordinates[0][ijk[0]];
+      x[1] = this->Coordinates[1][ijk[1]];
+      x[2] = this->Coordinates[2][ijk[2]];
+      }
+  }
+
+  // The two points of the difference along axis at point ijk, central in
+  // the interior and one-sided on the boundary as in vtkFlyingEdges3D, and
+  // the factor of the difference.
+  double GetStencil(const vtkIdType ijk[3], int axis,
+                    vtkIdType lo[3], vtkIdType hi[3]) const
+  {
+    for (int a = 0; a < 3; ++a)
+      {
+      lo[a] = hi[a] = ijk[a];
+      }
+    if (ijk[axis] == 0)
+      {
+      ++hi[axis];
+      return 1.0;
+      }
+    if (ijk[axis] >= this->Dims[axis] - 1)
+      {
+      --lo[axis];
+      return 1.0;
+      }
+    --lo[axis];
+    ++hi[axis];
+    return 0.5;
+  }
+};
+
+// The inputs and outputs of vtkGridFlyingEdgesMapPoints, whatever the type
+// of the scalars.
+struct vtkGridFlyingEdgesMapParams
+{
+  const vtkGridFlyingEdgesGeometry *Geometry;
+  const float *IndexPoints;
+  int Min[3];
+  int NumberOfComponents;
+  int Component;
+  float *NewFloatPoints;
+  double *NewDoublePoints;
+  float *NewGradients;
+  float *NewNormals;
+  vtkIdType *EdgeIds;
+  double *EdgeWeights;
+};
+
+// Maps the points generated by vtkFlyingEdges3D in the index space of the
+// grid to the grid. A point generated on the edge between the grid points
+// v0 and v1 is at v0 + t (v1 - v0) in index space, with a single fractional
+// coordinate along the edge.
+template <class T>
+class vtkGridFlyingEdgesMapPoints : public vtkGridFlyingEdgesMapParams
+{
+public:
+  const T *Scalars;
+
+  double GetScalar(const vtkIdType ijk[3]) const
+  {
+    const vtkIdType *dims = this->Geometry->Dims;
+    return static_cast<double>(this->Scalars[
+      (ijk[0] + dims[0] * (ijk[1] + dims[1] * ijk[2])) *
+      this->NumberOfComponents + this->Component]);
+  }
+
+  // The gradient of the scalars at a grid point, solved from its
+  // derivatives along the three index axes and the Jacobian of the grid.
+  void ComputeGradient(const vtkIdType ijk[3], double g[3]) const
+  {
+    double jacobian[3][3], gIndex[3], x0[3], x1[3];
+    vtkIdType lo[3], hi[3];
+    for (int a = 0; a < 3; ++a)
+      {
+      double factor = this->Geometry->GetStencil(ijk, a, lo, hi);
+      this->Geometry->GetPoint(lo, x0);
+      this->Geometry->GetPoint(hi, x1);
+      for (int c = 0; c < 3; ++c)
+        {
+        jacobian[a][c] = factor * (x1[c] - x0[c]);
+        }
+      gIndex[a] = factor * (this->GetScalar(hi) - this->GetScalar(lo));
+      }
+    if (vtkMath::Determinant3x3(jacobian) == 0.0)
+      {
+      g[0] = g[1] = g[2] = 0.0;
+      return;
+      }
+    double inverse[3][3];
+    vtkMath::Invert3x3(jacobian, inverse);
+    vtkMath::Multiply3x3(inverse, gIndex, g);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const vtkIdType *dims = this->Geometry->Dims;
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      const float *p = this->IndexPoints + 3 * ptId;
+      vtkIdType ijk0[3], ijk1[3];
+      int axis = -1;
+      double t = 0.0;
+      for (int a = 0; a < 3; ++a)
+        {
+        double r = p[a] - this->Min[a];
+        double f = std::floor(r);
+        ijk0[a] = static_cast<vtkIdType>(f);
+        if (r > f && axis < 0)
+          {
+          axis = a;
+          t = r - f;
+          }
+        ijk1[a] = ijk0[a];
+        }
+      if (axis >= 0)
+        {
+        ++ijk1[axis];
+        }
+
+      double x0[3], x1[3], x[3];
+      this->Geometry->GetPoint(ijk0, x0);
+      this->Geometry->GetPoint(ijk1, x1);
+      for (int c = 0; c < 3; ++c)
+        {
+        x[c] = x0[c] + t * (x1[c] - x0[c]);
+        }
+      if (this->NewDoublePoints)
+        {
+        std::copy(x, x + 3, this->NewDoublePoints + 3 * ptId);
+        }
+      else
+        {
+        float *xPtr = this->NewFloatPoints + 3 * ptId;
+        xPtr[0] = static_cast<float>(x[0]);
+        xPtr[1] = static_cast<float>(x[1]);
+        xPtr[2] = static_cast<float>(x[2]);
+        }
+
+      if (this->NewGradients || this->NewNormals)
+        {
+        double g0[3], g1[3], g[3];
+        this->ComputeGradient(ijk0, g0);
+        this->ComputeGradient(ijk1, g1);
+        for (int c = 0; c < 3; ++c)
+          {
+          g[c] = g0[c] + t * (g1[c] - g0[c]);
+          }
+        if (this->NewGradients)
+          {
+          float *gPtr = this->NewGradients + 3 * ptId;
+          gPtr[0] = static_cast<float>(g[0]);
+          gPtr[1] = static_cast<float>(g[1]);
+          gPtr[2] = static_cast<float>(g[2]);
+          }
+        if (this->NewNormals)
+          {
+          float *n = this->NewNormals + 3 * ptId;
+          n[0] = static_cast<float>(-g[0]);
+          n[1] = static_cast<float>(-g[1]);
+          n[2] = static_cast<float>(-g[2]);
+          vtkMath::Normalize(n);
+          }
+        }
+
+      if (this->EdgeIds)
+        {
+        this->EdgeIds[2 * ptId] =
+          ijk0[0] + dims[0] * (ijk0[1] + dims[1] * ijk0[2]);
+        this->EdgeIds[2 * ptId + 1] =
+          ijk1[0] + dims[0] * (ijk1[1] + dims[1] * ijk1[2]);
+        this->EdgeWeights[ptId] = t;
+        }
+      }
+  }
+};
+
+template <class T>
+void vtkGridFlyingEdgesMap(const vtkGridFlyingEdgesMapParams& params,
+                           const T *scalars, vtkIdType numPts)
+{
+  vtkGridFlyingEdgesMapPoints<T> map;
+  static_cast<vtkGridFlyingEdgesMapParams&>(map) = params;
+  map.Scalars = scalars;
+  vtkSMPTools::For(0, numPts, map);
+}
+
+// Interpolates the point attributes of the input along the edges of the
+// output points.
+class vtkGridFlyingEdgesInterpolate
+{
+public:
+  vtkPointData *InPD;
+  vtkPointData *OutPD;
+  const vtkIdType *EdgeIds;
+  const double *EdgeWeights;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      this->OutPD->InterpolateEdge(this->InPD, ptId, this->EdgeIds[2 * ptId],
+                                   this->EdgeIds[2 * ptId + 1],
+                                   this->EdgeWeights[ptId]);
+      }
+  }
+};
+
+// Arrays whose tuples may be read, or written at distinct presized ids, from
+// several threads.
+bool vtkGridFlyingEdgesAreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(i));
+    if (!array || array->GetDataType() == VTK_BIT ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+//----------------------------------------------------------------------------
+// Construct object with a single contour value of 0.0.
+vtkGridFlyingEdges3D::vtkGridFlyingEdges3D()
+{
+  this->ContourValues = vtkContourValues::New();
+  this->ComputeNormals = 1;
+  this->ComputeGradients = 0;
+  this->ComputeScalars = 1;
+  this->InterpolateAttributes = 0;
+  this->ArrayComponent = 0;
+
+  // by default process active point scalars
+  this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
+                               vtkDataSetAttributes::SCALARS);
+}
+
+//----------------------------------------------------------------------------
+vtkGridFlyingEdges3D::~vtkGridFlyingEdges3D()
+{
+  this->ContourValues->Delete();
+}
+
+//----------------------------------------------------------------------------
+// Overload standard modified time function. If contour values are modified,
+// then this object is modified as well.
+unsigned long vtkGridFlyingEdges3D::GetMTime()
+{
+  unsigned long mTime=this->Superclass::GetMTime();
+  unsigned long mTime2=this->ContourValues->GetMTime();
+  return ( mTime2 > mTime ? mTime2 : mTime );
+}
+
+//----------------------------------------------------------------------------
+int vtkGridFlyingEdges3D::RequestUpdateExtent(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  // These require extra ghost levels
+  if (this->ComputeGradients || this->ComputeNormals)
+    {
+    vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+    vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+    int ghostLevels;
+    ghostLevels =
+      outInfo->Get(
+        vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(),
+                ghostLevels + 1);
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkGridFlyingEdges3D::RequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkDebugMacro(<< "Executing 3D grid contour");
+
+  // get the info objects
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  // get the input and output
+  vtkDataSet *input = vtkDataSet::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkPolyData *output = vtkPolyData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkStructuredGrid *sgrid = vtkStructuredGrid::SafeDownCast(input);
+  vtkRectilinearGrid *rgrid = vtkRectilinearGrid::SafeDownCast(input);
+
+  // to be safe recompute the update extent
+  this->RequestUpdateExtent(request,inputVector,outputVector);
+  vtkDataArray *inScalars = this->GetInputArrayToProcess(0,inputVector);
+
+  int ext[6];
+  if (sgrid)
+    {
+    sgrid->GetExtent(ext);
+    }
+  else
+    {
+    rgrid->GetExtent(ext);
+    }
+  if ( ext[0] >= ext[1] || ext[2] >= ext[3] || ext[4] >= ext[5] )
+    {
+    vtkDebugMacro(<<"3D grid contours requires 3D data");
+    return 0;
+    }
+  if (sgrid && !sgrid->GetPoints())
+    {
+    vtkDebugMacro(<<"No points for contouring.");
+    return 0;
+    }
+
+  if (inScalars == NULL)
+    {
+    vtkDebugMacro("No scalars for contouring.");
+    return 0;
+    }
+  int numComps = inScalars->GetNumberOfComponents();
+
+  if (this->ArrayComponent >= numComps)
+    {
+    vtkErrorMacro("Scalars have " << numComps << " components. "
+                  "ArrayComponent must be smaller than " << numComps);
+    return 0;
+    }
+
+  // The grid has the topology of an image of the same extent. Contour it
+  // in index space, where the image has unit spacing.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(ext);
+  image->GetPointData()->SetScalars(inScalars);
+
+  vtkNew<vtkFlyingEdges3D> contour;
+  contour->SetInputData(image.GetPointer());
+  int numContours = this->ContourValues->GetNumberOfContours();
+  contour->SetNumberOfContours(numContours);
+  for (int i = 0; i < numContours; ++i)
+    {
+    contour->SetValue(i, this->ContourValues->GetValue(i));
+    }
+  contour->ComputeNormalsOff();
+  contour->ComputeGradientsOff();
+  contour->SetComputeScalars(this->ComputeScalars);
+  contour->SetArrayComponent(this->ArrayComponent);
+  contour->Update();
+  vtkPolyData *indexOutput = contour->GetOutput();
+  vtkIdType numPts = indexOutput->GetNumberOfPoints();
+
+  // Now map the points to the grid.
+  vtkGridFlyingEdgesGeometry geometry;
+  geometry.Points = NULL;
+  int pointsType = VTK_FLOAT;
+  for (int i = 0; i < 3; ++i)
+    {
+    geometry.Dims[i] = ext[2*i+1] - ext[2*i] + 1;
+    }
+  if (sgrid)
+    {
+    geometry.Points = sgrid->GetPoints();
+    pointsType = geometry.Points->GetDataType();
+    }
+  else
+    {
+    vtkDataArray *coords[3] = { rgrid->GetXCoordinates(),
+                                rgrid->GetYCoordinates(),
+                                rgrid->GetZCoordinates() };
+    for (int i = 0; i < 3; ++i)
+      {
+      geometry.Coordinates[i].resize(geometry.Dims[i]);
+      for (vtkIdType j = 0; j < geometry.Dims[i]; ++j)
+        {
+        geometry.Coordinates[i][j] = coords[i]->GetComponent(j, 0);
+        }
+      if (coords[i]->GetDataType() == VTK_DOUBLE)
+        {
+        pointsType = VTK_DOUBLE;
+        }
+      }
+    }
+
+  vtkPoints *newPts = vtkPoints::New();
+  newPts->SetDataType(pointsType == VTK_DOUBLE ? VTK_DOUBLE : VTK_FLOAT);
+  newPts->SetNumberOfPoints(numPts);
+  vtkFloatArray *newNormals = NULL;
+  vtkFloatArray *newGradients = NULL;
+  if (this->ComputeNormals)
+    {
+    newNormals = vtkFloatArray::New();
+    newNormals->SetNumberOfComponents(3);
+    newNormals->SetNumberOfTuples(numPts);
+    newNormals->SetName("Normals");
+    }
+  if (this->ComputeGradients)
+    {
+    newGradients = vtkFloatArray::New();
+    newGradients->SetNumberOfComponents(3);
+    newGradients->SetNumberOfTuples(numPts);
+    newGradients->SetName("Gradients");
+    }
+  std::vector<vtkIdType> edgeIds;
+  std::vector<double> edgeWeights;
+  if (this->InterpolateAttributes)
+    {
+    edgeIds.resize(2 * numPts);
+    edgeWeights.resize(numPts);
+    }
+
+  if (numPts > 0)
+    {
+    vtkGridFlyingEdgesMapParams map;
+    map.Geometry = &geometry;
+    map.IndexPoints = static_cast<float*>(
+      indexOutput->GetPoints()->GetVoidPointer(0));
+    map.Min[0] = ext[0];
+    map.Min[1] = ext[2];
+    map.Min[2] = ext[4];
+    map.NumberOfComponents = numComps;
+    map.Component = this->ArrayComponent;
+    map.NewFloatPoints = NULL;
+    map.NewDoublePoints = NULL;
+    if (pointsType == VTK_DOUBLE)
+      {
+      map.NewDoublePoints = static_cast<double*>(newPts->GetVoidPointer(0));
+      }
+    else
+      {
+      map.NewFloatPoints = static_cast<float*>(newPts->GetVoidPointer(0));
+      }
+    map.NewGradients = newGradients ? newGradients->GetPointer(0) : NULL;
+    map.NewNormals = newNormals ? newNormals->GetPointer(0) : NULL;
+    map.EdgeIds = edgeIds.empty() ? NULL : &edgeIds[0];
+    map.EdgeWeights = edgeWeights.empty() ? NULL : &edgeWeights[0];
+
+    switch (inScalars->GetDataType())
+      {
+      vtkTemplateMacro(vtkGridFlyingEdgesMap(
+        map, static_cast<const VTK_TT*>(inScalars->GetVoidPointer(0)),
+        numPts));
+      }
+    }
+
+  vtkDebugMacro(<<"Created: "
+                << numPts << " points, "
+                << indexOutput->GetNumberOfPolys() << " triangles");
+
+  output->SetPoints(newPts);
+  newPts->Delete();
+  output->SetPolys(indexOutput->GetPolys());
+
+  vtkPointData *outPD = output->GetPointData();
+  if (this->InterpolateAttributes)
+    {
+    vtkPointData *inPD = input->GetPointData();
+    outPD->InterpolateAllocate(inPD, numPts);
+    if (inScalars->GetName())
+      {
+      outPD->CopyFieldOff(inScalars->GetName());
+      }
+    if (inScalars == inPD->GetScalars())
+      {
+      outPD->CopyScalarsOff();
+      }
+    vtkGridFlyingEdgesInterpolate interpolate;
+    interpolate.InPD = inPD;
+    interpolate.OutPD = outPD;
+    interpolate.EdgeIds = edgeIds.empty() ? NULL : &edgeIds[0];
+    interpolate.EdgeWeights = edgeWeights.empty() ? NULL : &edgeWeights[0];
+    if (vtkGridFlyingEdgesAreArraysThreadSafe(inPD))
+      {
+      outPD->SetNumberOfTuples(numPts);
+      vtkSMPTools::For(0, numPts, interpolate);
+      }
+    else
+      {
+      interpolate(0, numPts);
+      }
+    }
+
+  vtkDataArray *newScalars = indexOutput->GetPointData()->GetScalars();
+  if (this->ComputeScalars && newScalars)
+    {
+    int idx = outPD->AddArray(newScalars);
+    outPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+    }
+
+  if (newNormals)
+    {
+    int idx = outPD->AddArray(newNormals);
+    outPD->SetActiveAttribute(idx, vtkDataSetAttributes::NORMALS);
+    newNormals->Delete();
+    }
+
+  if (newGradients)
+    {
+    int idx = outPD->AddArray(newGradients);
+    outPD->SetActiveAttribute(idx, vtkDataSetAttributes::VECTORS);
+    newGradients->Delete();
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkGridFlyingEdges3D::FillInputPortInformation(int, vtkInformation *info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkStructuredGrid");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkRectilinearGrid");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkGridFlyingEdges3D::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  this->ContourValues->PrintSelf(os,indent.GetNextIndent());
+
+  os << indent << "Compute Normals: " << (this->ComputeNormals ? "On\n" : "Off\n");
+  os << indent << "Compute Gradients: " << (this->ComputeGradients ? "On\n" : "Off\n");
+  os << indent << "Compute Scalars: " << (this->ComputeScalars ? "On\n" : "Off\n");
+  os << indent << "Interpolate Attributes: "
+     << (this->InterpolateAttributes ? "On\n" : "Off\n");
+  os << indent << "ArrayComponent: " << this->ArrayComponent << endl;
+}
@@ -0,0 +1,171 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGridFlyingEdges3D.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkGridFlyingEdges3D - generate isosurface from 3D rectilinear or
+// structured grids
+// .SECTION Description
+// vtkGridFlyingEdges3D extends the flying edges algorithm of
+// vtkFlyingEdges3D to vtkRectilinearGrid (points given by three coordinate
+// arrays) and vtkStructuredGrid (explicit points) inputs. The topology of
+// these grids is the topology of an image, so the four passes of flying
+// edges are run on the point indices of the grid, exactly as for a volume
+// of unit spacing. Each output point then lies on a single edge of the
+// grid, and a final parallel pass maps it from index space to the grid:
+// the point is interpolated between the two end points of its edge, and
+// the gradient is computed at both end points through the inverse of the
+// Jacobian of the grid (central differences of the scalars and of the
+// point coordinates, one-sided on the boundary) and interpolated.
+//
+// Optionally, all the point attributes of the input are interpolated to the
+// output points.
+
+// .SECTION Caveats
+// This filter is specialized to 3D grids. This implementation can produce
+// degenerate triangles (i.e., zero-area triangles). The output points are
+// located from their single precision position in index space, so their
+// relative precision along the edge decreases slowly with the grid
+// dimensions.
+//
+// This class has been threaded with vtkSMPTools. Using TBB or other
+// non-sequential type (set in the CMake variable
+// VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+
+// .SECTION See Also
+// vtkFlyingEdges3D vtkGridFlyingEdgesPlaneCutter
+// vtkRectilinearSynchronizedTemplates vtkGridSynchronizedTemplates3D
+
+#ifndef vtkGridFlyingEdges3D_h
+#define vtkGridFlyingEdges3D_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkContourValues.h" // Passes calls through
+
+class VTKFILTERSCORE_EXPORT vtkGridFlyingEdges3D : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkGridFlyingEdges3D *New();
+  vtkTypeMacro(vtkGridFlyingEdges3D,vtkPolyDataAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Because we delegate to vtkContourValues.
+  unsigned long int GetMTime();
+
+  // Description:
+  // Set/Get the computation of normals. Normal computation is fairly
+  // expensive in both time and storage. If the output data will be processed
+  // by filters that modify topology or geometry, it may be wise to turn
+  // Normals and Gradients off.
+  vtkSetMacro(ComputeNormals,int);
+  vtkGetMacro(ComputeNormals,int);
+  vtkBooleanMacro(ComputeNormals,int);
+
+  // Description:
+  // Set/Get the computation of gradients. Gradient computation is fairly
+  // expensive in both time and storage. Note that if ComputeNormals is on,
+  // gradients will have to be calculated, but will not be stored in the
+  // output dataset. If the output data will be processed by filters that
+  // modify topology or geometry, it may be wise to turn Normals and
+  // Gradients off.
+  vtkSetMacro(ComputeGradients,int);
+  vtkGetMacro(ComputeGradients,int);
+  vtkBooleanMacro(ComputeGradients,int);
+
+  // Description:
+  // Set/Get the computation of scalars.
+  vtkSetMacro(ComputeScalars,int);
+  vtkGetMacro(ComputeScalars,int);
+  vtkBooleanMacro(ComputeScalars,int);
+
+  // Description:
+  // Set/Get the interpolation of the point attributes of the input, other
+  // than the contoured array, to the output points. Off by default.
+  vtkSetMacro(InterpolateAttributes,int);
+  vtkGetMacro(InterpolateAttributes,int);
+  vtkBooleanMacro(InterpolateAttributes,int);
+
+  // Description:
+  // Set a particular contour value at contour number i. The index i ranges
+  // between 0<=i<NumberOfContours.
+  void SetValue(int i, double value) {this->ContourValues->SetValue(i,value);}
+
+  // Description:
+  // Get the ith contour value.
+  double GetValue(int i) {return this->ContourValues->GetValue(i);}
+
+  // Description:
+  // Get a pointer to an array of contour values. There will be
+  // GetNumberOfContours() values in the list.
+  double *GetValues() {return this->ContourValues->GetValues();}
+
+  // Description:
+  // Fill a supplied list with contour values. There will be
+  // GetNumberOfContours() values in the list. Make sure you allocate
+  // enough memory to hold the list.
+  void GetValues(double *contourValues) {
+    this->ContourValues->GetValues(contourValues);}
+
+  // Description:
+  // Set the number of contours to place into the list. You only really
+  // need to use this method to reduce list size. The method SetValue()
+  // will automatically increase list size as needed.
+  void SetNumberOfContours(int number) {
+    this->ContourValues->SetNumberOfContours(number);}
+
+  // Description:
+  // Get the number of contours in the list of contour values.
+  int GetNumberOfContours() {
+    return this->ContourValues->GetNumberOfContours();}
+
+  // Description:
+  // Generate numContours equally spaced contour values between specified
+  // range. Contour values will include min/max range values.
+  void GenerateValues(int numContours, double range[2]) {
+    this->ContourValues->GenerateValues(numContours, range);}
+
+  // Description:
+  // Generate numContours equally spaced contour values between specified
+  // range. Contour values will include min/max range values.
+  void GenerateValues(int numContours, double rangeStart, double rangeEnd)
+    {this->ContourValues->GenerateValues(numContours, rangeStart, rangeEnd);}
+
+  // Description:
+  // Set/get which component of the scalar array to contour on; defaults to 0.
+  vtkSetMacro(ArrayComponent, int);
+  vtkGetMacro(ArrayComponent, int);
+
+protected:
+  vtkGridFlyingEdges3D();
+  ~vtkGridFlyingEdges3D();
+
+  int ComputeNormals;
+  int ComputeGradients;
+  int ComputeScalars;
+  int InterpolateAttributes;
+  int ArrayComponent;
+  vtkContourValues *ContourValues;
+
+  virtual int RequestData(vtkInformation *, vtkInformationVector **,
+                          vtkInformationVector *);
+  virtual int RequestUpdateExtent(vtkInformation *, vtkInformationVector **,
+                                  vtkInformationVector *);
+  virtual int FillInputPortInformation(int port, vtkInformation *info);
+
+private:
+  vtkGridFlyingEdges3D(const vtkGridFlyingEdges3D&);  // Not implemented.
+  void operator=(const vtkGridFlyingEdges3D&);  // Not implemented.
+};
+
+#endif
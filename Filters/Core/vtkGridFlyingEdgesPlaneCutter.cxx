@@ -0,0 +1,254 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGridFlyingEdgesPlaneCutter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkGridFlyingEdgesPlaneCutter.h"
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkGridFlyingEdges3D.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredGrid.h"
+
+#include <vector>
+
+vtkStandardNewMacro(vtkGridFlyingEdgesPlaneCutter);
+vtkCxxSetObjectMacro(vtkGridFlyingEdgesPlaneCutter,Plane,vtkPlane);
+
+namespace
+{
+// Evaluates the signed distance to the plane at the points of a structured
+// grid, or at the points of a rectilinear grid as the sum of the distances
+// along each axis, computed once per coordinate.
+class vtkGridFlyingEdgesPlaneDistance
+{
+public:
+  vtkPoints *Points;
+  std::vector<double> AxisDistances[3];
+  vtkIdType Dims[2];
+  double Origin[3];
+  double Normal[3];
+  double *Distances;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      if (this->Points)
+        {
+        this->Points->GetPoint(ptId, x);
+        this->Distances[ptId] = this->Normal[0] * (x[0] - this->Origin[0]) +
+          this->Normal[1] * (x[1] - this->Origin[1]) +
+          this->Normal[2] * (x[2] - this->Origin[2]);
+        }
+      else
+        {
+        vtkIdType i = ptId % this->Dims[0];
+        vtkIdType j = (ptId / this->Dims[0]) % this->Dims[1];
+        vtkIdType k = ptId / (this->Dims[0] * this->Dims[1]);
+        this->Distances[ptId] = this->AxisDistances[0][i] +
+          this->AxisDistances[1][j] + this->AxisDistances[2][k];
+        }
+      }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+// Construct object with a default plane.
+vtkGridFlyingEdgesPlaneCutter::vtkGridFlyingEdgesPlaneCutter()
+{
+  this->Plane = vtkPlane::New();
+  this->ComputeNormals = 0;
+  this->InterpolateAttributes = 1;
+}
+
+//----------------------------------------------------------------------------
+vtkGridFlyingEdgesPlaneCutter::~vtkGridFlyingEdgesPlaneCutter()
+{
+  this->SetPlane(NULL);
+}
+
+//----------------------------------------------------------------------------
+// Overload standard modified time function. If the plane definition is modified,
+// then this object is modified as well.
+unsigned long vtkGridFlyingEdgesPlaneCutter::GetMTime()
+{
+  unsigned long mTime=this->Superclass::GetMTime();
+  if ( this->Plane != NULL )
+    {
+    unsigned long mTime2=this->Plane->GetMTime();
+    return ( mTime2 > mTime ? mTime2 : mTime );
+    }
+  else
+    {
+    return mTime;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkGridFlyingEdgesPlaneCutter::RequestData(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkDebugMacro(<< "Executing grid plane cutter");
+
+  // get the info objects
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  // get the input and output
+  vtkDataSet *input = vtkDataSet::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkPolyData *output = vtkPolyData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkStructuredGrid *sgrid = vtkStructuredGrid::SafeDownCast(input);
+  vtkRectilinearGrid *rgrid = vtkRectilinearGrid::SafeDownCast(input);
+
+  if (this->Plane == NULL)
+    {
+    vtkErrorMacro("A plane must be specified");
+    return 0;
+    }
+
+  int ext[6];
+  if (sgrid)
+    {
+    sgrid->GetExtent(ext);
+    }
+  else
+    {
+    rgrid->GetExtent(ext);
+    }
+  if ( ext[0] >= ext[1] || ext[2] >= ext[3] || ext[4] >= ext[5] )
+    {
+    vtkDebugMacro(<<"Cutting requires 3D data");
+    return 0;
+    }
+  if (sgrid && !sgrid->GetPoints())
+    {
+    vtkDebugMacro(<<"No points to cut");
+    return 0;
+    }
+
+  // Evaluate the distance to the plane at the grid points.
+  vtkGridFlyingEdgesPlaneDistance distance;
+  distance.Points = NULL;
+  this->Plane->GetOrigin(distance.Origin);
+  this->Plane->GetNormal(distance.Normal);
+  vtkMath::Normalize(distance.Normal);
+  distance.Dims[0] = ext[1] - ext[0] + 1;
+  distance.Dims[1] = ext[3] - ext[2] + 1;
+  if (sgrid)
+    {
+    distance.Points = sgrid->GetPoints();
+    }
+  else
+    {
+    vtkDataArray *coords[3] = { rgrid->GetXCoordinates(),
+                                rgrid->GetYCoordinates(),
+                                rgrid->GetZCoordinates() };
+    for (int i = 0; i < 3; ++i)
+      {
+      vtkIdType numCoords = ext[2*i+1] - ext[2*i] + 1;
+      distance.AxisDistances[i].resize(numCoords);
+      for (vtkIdType j = 0; j < numCoords; ++j)
+        {
+        distance.AxisDistances[i][j] = distance.Normal[i] *
+          (coords[i]->GetComponent(j, 0) - distance.Origin[i]);
+        }
+      }
+    }
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> distances;
+  distances->SetName("vtkGridFlyingEdgesPlaneCutterDistance");
+  distances->SetNumberOfTuples(numPts);
+  distance.Distances = distances->GetPointer(0);
+  vtkSMPTools::For(0, numPts, distance);
+
+  // Contour the distance at zero.
+  vtkSmartPointer<vtkDataSet> grid;
+  grid.TakeReference(input->NewInstance());
+  grid->ShallowCopy(input);
+  grid->GetPointData()->AddArray(distances.GetPointer());
+
+  vtkNew<vtkGridFlyingEdges3D> contour;
+  contour->SetInputData(grid);
+  contour->SetInputArrayToProcess(0, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_POINTS, distances->GetName());
+  contour->SetValue(0, 0.0);
+  contour->ComputeNormalsOff();
+  contour->ComputeGradientsOff();
+  contour->ComputeScalarsOff();
+  contour->SetInterpolateAttributes(this->InterpolateAttributes);
+  contour->Update();
+  output->ShallowCopy(contour->GetOutput());
+
+  if (this->ComputeNormals)
+    {
+    vtkIdType numOutPts = output->GetNumberOfPoints();
+    vtkNew<vtkFloatArray> newNormals;
+    newNormals->SetNumberOfComponents(3);
+    newNormals->SetNumberOfTuples(numOutPts);
+    newNormals->SetName("Normals");
+    float *n = newNormals->GetPointer(0);
+    for (vtkIdType i = 0; i < numOutPts; ++i, n += 3)
+      {
+      n[0] = static_cast<float>(distance.Normal[0]);
+      n[1] = static_cast<float>(distance.Normal[1]);
+      n[2] = static_cast<float>(distance.Normal[2]);
+      }
+    int idx = output->GetPointData()->AddArray(newNormals.GetPointer());
+    output->GetPointData()->SetActiveAttribute(idx,
+                                               vtkDataSetAttributes::NORMALS);
+    }
+
+  vtkDebugMacro(<<"Created: "
+                << output->GetNumberOfPoints() << " points, "
+                << output->GetNumberOfPolys() << " triangles");
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkGridFlyingEdgesPlaneCutter::FillInputPortInformation(int,
+                                                            vtkInformation *info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkStructuredGrid");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkRectilinearGrid");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkGridFlyingEdgesPlaneCutter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Plane: " << this->Plane << "\n";
+  os << indent << "Compute Normals: " << (this->ComputeNormals ? "On\n" : "Off\n");
+  os << indent << "Interpolate Attributes: "
+     << (this->InterpolateAttributes ? "On\n" : "Off\n");
+}
@@ -0,0 +1,99 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGridFlyingEdgesPlaneCutter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkGridFlyingEdgesPlaneCutter - cut a rectilinear or structured grid
+// with a plane and generate a polygonal cut surface
+// .SECTION Description
+// vtkGridFlyingEdgesPlaneCutter cuts a 3D vtkRectilinearGrid or
+// vtkStructuredGrid with a single plane using flying edges. Unlike in a
+// volume, the grid edges are not aligned with the axes, so the signed
+// distance to the plane is first evaluated at all the grid points in
+// parallel, and its zero isosurface is extracted with vtkGridFlyingEdges3D.
+// The point attributes of the input are interpolated to the cut surface.
+//
+// For more information see vtkFlyingEdges3D and/or the paper "Flying Edges:
+// A High-Performance Scalable Isocontouring Algorithm" by Schroeder,
+// Maynard, Geveci. Proc. of LDAV 2015. Chicago, IL.
+
+// .SECTION Caveats
+// This filter is specialized to 3D grids. This implementation can produce
+// degenerate triangles (i.e., zero-area triangles).
+//
+// This class has been threaded with vtkSMPTools. Using TBB or other
+// non-sequential type (set in the CMake variable
+// VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+
+// .SECTION See Also
+// vtkFlyingEdgesPlaneCutter vtkGridFlyingEdges3D vtkCutter
+
+#ifndef vtkGridFlyingEdgesPlaneCutter_h
+#define vtkGridFlyingEdgesPlaneCutter_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkPolyDataAlgorithm.h"
+
+class vtkPlane;
+
+class VTKFILTERSCORE_EXPORT vtkGridFlyingEdgesPlaneCutter : public vtkPolyDataAlgorithm
+{
+public:
+  // Description:
+  // Standard construction and print methods.
+  static vtkGridFlyingEdgesPlaneCutter *New();
+  vtkTypeMacro(vtkGridFlyingEdgesPlaneCutter,vtkPolyDataAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // The modified time depends on the delegated cut plane.
+  unsigned long int GetMTime();
+
+  // Description
+  // Specify the plane (an implicit function) to perform the cutting. The
+  // definition of the plane (its origin and normal) is controlled via this
+  // instance of vtkPlane.
+  virtual void SetPlane(vtkPlane*);
+  vtkGetObjectMacro(Plane,vtkPlane);
+
+  // Description:
+  // Set/Get the computation of normals. The normal generated is simply the
+  // cut plane normal. By default this is disabled.
+  vtkSetMacro(ComputeNormals,int);
+  vtkGetMacro(ComputeNormals,int);
+  vtkBooleanMacro(ComputeNormals,int);
+
+  // Description:
+  // Set/Get the interpolation of the point attributes of the input to the
+  // cut surface. On by default.
+  vtkSetMacro(InterpolateAttributes,int);
+  vtkGetMacro(InterpolateAttributes,int);
+  vtkBooleanMacro(InterpolateAttributes,int);
+
+protected:
+  vtkGridFlyingEdgesPlaneCutter();
+  ~vtkGridFlyingEdgesPlaneCutter();
+
+  vtkPlane *Plane;
+  int ComputeNormals;
+  int InterpolateAttributes;
+
+  virtual int RequestData(vtkInformation *, vtkInformationVector **,
+                          vtkInformationVector *);
+  virtual int FillInputPortInformation(int port, vtkInformation *info);
+
+private:
+  vtkGridFlyingEdgesPlaneCutter(const vtkGridFlyingEdgesPlaneCutter&);  // Not implemented.
+  void operator=(const vtkGridFlyingEdgesPlaneCutter&);  // Not implemented.
+};
+
+#endif
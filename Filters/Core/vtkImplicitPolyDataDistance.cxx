@@ -15,12 +15,14 @@
 #include "vtkImplicitPolyDataDistance.h"
 
 #include "vtkCellData.h"
-#include "vtkCellLocator.h"
+#include "vtkDataArray.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkStaticCellLocator.h"
 #include "vtkTriangleFilter.h"
 #include "vtkSmartPointer.h"
 
@@ -68,8 +70,7 @@ void vtkImplicitPolyDataDistance::SetInput(vtkPolyData* input)
     this->CreateDefaultLocator();
     this->Locator->SetDataSet(this->Input);
     this->Locator->SetTolerance(this->Tolerance);
-    this->Locator->SetNumberOfCellsPerBucket(10);
-    this->Locator->CacheCellBoundsOn();
+    this->Locator->SetNumberOfCellsPerNode(10);
     this->Locator->AutomaticOn();
     this->Locator->BuildLocator();
     }
@@ -105,10 +106,22 @@ void vtkImplicitPolyDataDistance::CreateDefaultLocator()
 {
   if ( this->Locator == NULL)
     {
-    this->Locator = vtkCellLocator::New();
+    this->Locator = vtkStaticCellLocator::New();
     }
 }
 
+//-----------------------------------------------------------------------------
+bool vtkImplicitPolyDataDistance::CanEvaluateInParallel()
+{
+  if ( this->Input == NULL || this->Input->GetNumberOfCells() == 0 )
+    {
+    return false;
+    }
+  vtkDataArray *cnorms = this->Input->GetCellData()->GetNormals();
+  return cnorms == NULL ||
+    (cnorms->GetDataType() != VTK_BIT && cnorms->HasStandardMemoryLayout());
+}
+
 //-----------------------------------------------------------------------------
 double vtkImplicitPolyDataDistance::EvaluateFunction(double x[3])
 {
@@ -166,8 +179,7 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
     }
 
   // Get point id of closest point in data set.
-  vtkSmartPointer<vtkGenericCell> cell =
-    vtkSmartPointer<vtkGenericCell>::New();
+  vtkGenericCell *cell = this->Cells.Local();
   this->Locator->FindClosestPoint(x, p, cell, cellId, subId, vlen2);
 
   if (cellId != -1)	// point located
@@ -183,7 +195,10 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
     double dist2, weights[3], pcoords[3], awnorm[3] = {0, 0, 0};
     cell->EvaluatePosition(p, closestPoint, subId, pcoords, dist2, weights);
 
-    vtkIdList* idList = vtkIdList::New();
+    vtkIdList* idList = this->NeighborIds.Local();
+    vtkIdList* ptIds = this->PointIds.Local();
+    vtkIdType npts;
+    const vtkIdType *pts;
     int count = 0;
     for (int i = 0; i < 3; i++)
       {
@@ -236,7 +251,10 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
           }
         else
           {
-          vtkPolygon::ComputeNormal(this->Input->GetCell(idList->GetId(i))->GetPoints(), norm);
+          this->Input->GetCellPoints(idList->GetId(i), npts, pts, ptIds);
+          vtkPolygon::ComputeNormal(this->Input->GetPoints(),
+                                    static_cast<int>(npts),
+                                    const_cast<vtkIdType*>(pts), norm);
           }
         awnorm[0] += norm[0];
         awnorm[1] += norm[1];
@@ -271,25 +289,28 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
       for (int i = 0; i < idList->GetNumberOfIds(); i++)
         {
         double norm[3];
+        this->Input->GetCellPoints(idList->GetId(i), npts, pts, ptIds);
         if ( cnorms )
           {
           cnorms->GetTuple(idList->GetId(i), norm);
           }
         else
           {
-          vtkPolygon::ComputeNormal(this->Input->GetCell(idList->GetId(i))->GetPoints(), norm);
+          vtkPolygon::ComputeNormal(this->Input->GetPoints(),
+                                    static_cast<int>(npts),
+                                    const_cast<vtkIdType*>(pts), norm);
           }
 
         // Compute angle at point a
-        int b = this->Input->GetCell(idList->GetId(i))->GetPointId(0);
-        int c = this->Input->GetCell(idList->GetId(i))->GetPointId(1);
+        vtkIdType b = pts[0];
+        vtkIdType c = pts[1];
         if (a == b)
           {
-          b = this->Input->GetCell(idList->GetId(i))->GetPointId(2);
+          b = pts[2];
           }
         else if (a == c)
           {
-          c = this->Input->GetCell(idList->GetId(i))->GetPointId(2);
+          c = pts[2];
           }
         double pa[3], pb[3], pc[3];
         this->Input->GetPoint(a, pa);
@@ -305,7 +326,6 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
         }
       vtkMath::Normalize(awnorm);
       }
-    idList->Delete();
 
     // sign(dist) = dot(grad, cell normal)
     if (ret == 0)
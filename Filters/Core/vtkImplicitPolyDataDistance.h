@@ -33,14 +33,22 @@
 // by Cory Quammen, Chris Weigle C., Russ Taylor
 // http://hdl.handle.net/10380/3262
 // http://www.midasjournal.org/browse/publication/797
+//
+// The closest points are found with a vtkStaticCellLocator, and the
+// evaluation only reads the input, so that the function may be evaluated
+// from several threads at once, for example by the batched
+// vtkImplicitFunction::FunctionValue(vtkDataArray*, vtkDataArray*).
 
 #ifndef vtkImplicitPolyDataDistance_h
 #define vtkImplicitPolyDataDistance_h
 
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkImplicitFunction.h"
+#include "vtkSMPThreadLocalObject.h" // For the thread local scratch objects
 
-class vtkCellLocator;
+class vtkAbstractCellLocator;
+class vtkGenericCell;
+class vtkIdList;
 class vtkPolyData;
 
 class VTKFILTERSCORE_EXPORT vtkImplicitPolyDataDistance : public vtkImplicitFunction
@@ -66,6 +74,11 @@ public:
   // Evaluate plane equation of nearest triangle to point x[3] and provides closest point on an input vtkPolyData.
   double EvaluateFunctionAndGetClosestPoint (double x[3], double closestPoint[3]);
 
+  // Description:
+  // Return true once an input has been set, unless its cell normals do not
+  // support concurrent reads. See vtkImplicitFunction::CanEvaluateInParallel().
+  virtual bool CanEvaluateInParallel();
+
   // Description:
   // Set the input vtkPolyData used for the implicit function
   // evaluation.  Passes input through an internal instance of
@@ -112,7 +125,12 @@ protected:
   double Tolerance;
 
   vtkPolyData *Input;
-  vtkCellLocator *Locator;
+  vtkAbstractCellLocator *Locator;
+
+  // Scratch objects of the evaluation, one per thread.
+  vtkSMPThreadLocalObject<vtkGenericCell> Cells;
+  vtkSMPThreadLocalObject<vtkIdList> NeighborIds;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
 
 private:
   vtkImplicitPolyDataDistance(const vtkImplicitPolyDataDistance&);  // Not implemented.
@@ -16,14 +16,22 @@
 
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
+#include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
 #include <cstdlib>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkMaskPoints);
 
@@ -39,6 +47,8 @@ vtkMaskPoints::vtkMaskPoints()
   this->RandomModeType = 0;
   this->ProportionalMaximumNumberOfPoints = 0;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->SampleInParallel = 0;
+  this->RandomSeed = 1;
 }
 
 inline double d_rand()
@@ -210,6 +220,477 @@ static void SortAndSample(vtkPoints* points, vtkPointData* data,
     }
 }
 
+namespace
+{
+// Number of points counted or selected by a thread at a time. The blocks
+// are fixed so that the output does not depend on the number of threads.
+const vtkIdType vtkMaskPointsBlockSize = 65536;
+
+inline vtkTypeUInt64 vtkMaskPointsUInt64(vtkTypeUInt32 high,
+                                         vtkTypeUInt32 low)
+{
+  return (static_cast<vtkTypeUInt64>(high) << 32) | low;
+}
+
+// Counter-based random numbers: the SplitMix64 finalizer applied to the
+// seed and the counter, e.g. a point id.
+inline vtkTypeUInt64 vtkMaskPointsHash(vtkTypeUInt64 seed,
+                                       vtkTypeUInt64 counter)
+{
+  vtkTypeUInt64 z = seed +
+    (counter + 1) * vtkMaskPointsUInt64(0x9e3779b9U, 0x7f4a7c15U);
+  z ^= z >> 30;
+  z *= vtkMaskPointsUInt64(0xbf58476dU, 0x1ce4e5b9U);
+  z ^= z >> 27;
+  z *= vtkMaskPointsUInt64(0x94d049bbU, 0x133111ebU);
+  z ^= z >> 31;
+  return z;
+}
+
+// Uniform number in [0, 1) from the 53 high bits of a hash
+inline double vtkMaskPointsUniform(vtkTypeUInt64 hash)
+{
+  return static_cast<double>(hash >> 11) / 9007199254740992.0;
+}
+
+bool vtkMaskPointsAreArraysThreadSafe(vtkPointData *pd)
+{
+  for (int i = 0; i < pd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(pd->GetAbstractArray(i));
+    if (!array || array->GetDataType() == VTK_BIT ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Every OnRatio point from Offset on
+struct vtkMaskPointsStride
+{
+  vtkIdType Offset;
+  vtkIdType OnRatio;
+  vtkIdType *Ids;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType k = begin; k < end; ++k)
+      {
+      this->Ids[k] = this->Offset + k * this->OnRatio;
+      }
+  }
+};
+
+// Points from Offset on kept independently with the given probability
+struct vtkMaskPointsBernoulli
+{
+  vtkTypeUInt64 Seed;
+  vtkIdType Offset;
+  double Probability;
+
+  bool operator()(vtkIdType i) const
+  {
+    return i >= this->Offset && vtkMaskPointsUniform(
+      vtkMaskPointsHash(this->Seed, i)) < this->Probability;
+  }
+};
+
+// Points whose (key, id) is at most the one of the last sampled point
+struct vtkMaskPointsSmallestKeys
+{
+  vtkTypeUInt64 Seed;
+  vtkTypeUInt64 Key;
+  vtkIdType Id;
+
+  bool operator()(vtkIdType i) const
+  {
+    vtkTypeUInt64 key = vtkMaskPointsHash(this->Seed, i);
+    return key < this->Key || (key == this->Key && i <= this->Id);
+  }
+};
+
+// First pass: count the kept points of each block
+template <class Predicate>
+struct vtkMaskPointsCount
+{
+  const Predicate *Keep;
+  vtkIdType NumberOfPoints;
+  vtkIdType *Counts;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType b = begin; b < end; ++b)
+      {
+      vtkIdType last = std::min((b + 1) * vtkMaskPointsBlockSize,
+                                this->NumberOfPoints);
+      vtkIdType count = 0;
+      for (vtkIdType i = b * vtkMaskPointsBlockSize; i < last; ++i)
+        {
+        count += (*this->Keep)(i) ? 1 : 0;
+        }
+      this->Counts[b] = count;
+      }
+  }
+};
+
+// Second pass: write the ids of the kept points of each block from its
+// offset, up to MaximumNumberOfIds
+template <class Predicate>
+struct vtkMaskPointsFill
+{
+  const Predicate *Keep;
+  vtkIdType NumberOfPoints;
+  const vtkIdType *Offsets;
+  vtkIdType MaximumNumberOfIds;
+  vtkIdType *Ids;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType b = begin; b < end; ++b)
+      {
+      vtkIdType last = std::min((b + 1) * vtkMaskPointsBlockSize,
+                                this->NumberOfPoints);
+      vtkIdType out = this->Offsets[b];
+      for (vtkIdType i = b * vtkMaskPointsBlockSize;
+           i < last && out < this->MaximumNumberOfIds; ++i)
+        {
+        if ((*this->Keep)(i))
+          {
+          this->Ids[out++] = i;
+          }
+        }
+      }
+  }
+};
+
+// Select, in increasing order, the first maxIds points that are kept
+template <class Predicate>
+void vtkMaskPointsSelect(const Predicate &keep, vtkIdType numPts,
+                         vtkIdType maxIds, vtkIdList *ids)
+{
+  vtkIdType numBlocks =
+    (numPts + vtkMaskPointsBlockSize - 1) / vtkMaskPointsBlockSize;
+  std::vector<vtkIdType> offsets(numBlocks + 1, 0);
+  vtkMaskPointsCount<Predicate> count = { &keep, numPts, &offsets[0] };
+  vtkSMPTools::For(0, numBlocks, 1, count);
+  vtkIdType total = vtkSMPTools::ExclusiveScan(
+    offsets.begin(), offsets.end() - 1, offsets.begin(),
+    static_cast<vtkIdType>(0));
+
+  ids->SetNumberOfIds(std::min(total, maxIds));
+  vtkMaskPointsFill<Predicate> fill =
+    { &keep, numPts, &offsets[0], ids->GetNumberOfIds(), ids->GetPointer(0) };
+  vtkSMPTools::For(0, numBlocks, 1, fill);
+}
+
+// Histogram of the 16 high bits of the random keys of the points
+struct vtkMaskPointsKeyHistogram
+{
+  vtkTypeUInt64 Seed;
+  vtkSMPThreadLocal<std::vector<vtkIdType> > Counts;
+
+  void Initialize()
+  {
+    this->Counts.Local().assign(1 << 16, 0);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<vtkIdType> &counts = this->Counts.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      ++counts[vtkMaskPointsHash(this->Seed, i) >> 48];
+      }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+// Keys and ids of the points whose key falls in one bucket of the histogram
+struct vtkMaskPointsBucketKeys
+{
+  vtkTypeUInt64 Seed;
+  vtkTypeUInt64 Bucket;
+  vtkSMPThreadLocal<std::vector<std::pair<vtkTypeUInt64, vtkIdType> > > Keys;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<std::pair<vtkTypeUInt64, vtkIdType> > &keys =
+      this->Keys.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkTypeUInt64 key = vtkMaskPointsHash(this->Seed, i);
+      if ((key >> 48) == this->Bucket)
+        {
+        keys.push_back(std::make_pair(key, i));
+        }
+      }
+  }
+};
+
+struct vtkMaskPointsGatherCoordinates
+{
+  vtkDataSet *Input;
+  double *Coordinates;
+  vtkIdType *Order;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Input->GetPoint(i, this->Coordinates + 3 * i);
+      this->Order[i] = i;
+      }
+  }
+};
+
+struct vtkMaskPointsCompareCoordinates
+{
+  const double *Coordinates;
+  int Axis;
+
+  bool operator()(vtkIdType a, vtkIdType b) const
+  {
+    return this->Coordinates[3 * a + this->Axis] <
+      this->Coordinates[3 * b + this->Axis];
+  }
+};
+
+// Range of points to sample Size times, whose samples are written from
+// OutStart on
+struct vtkMaskPointsStratum
+{
+  vtkIdType Start;
+  vtkIdType End;
+  vtkIdType Size;
+  vtkIdType OutStart;
+};
+
+// Split the strata of one level like SortAndSample() does, with random
+// numbers drawn from the depth and the start of each stratum. Each stratum
+// writes its two halves, or its samples when it is not split.
+struct vtkMaskPointsStratify
+{
+  const double *Coordinates;
+  vtkIdType *Order;
+  vtkIdType *Ids;
+  vtkTypeUInt64 Seed;
+  int Depth;
+  const vtkMaskPointsStratum *Strata;
+  vtkMaskPointsStratum *Children;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType s = begin; s < end; ++s)
+      {
+      const vtkMaskPointsStratum &stratum = this->Strata[s];
+      vtkMaskPointsStratum &left = this->Children[2 * s];
+      vtkMaskPointsStratum &right = this->Children[2 * s + 1];
+      left.Size = right.Size = 0;
+      vtkIdType n = stratum.End - stratum.Start;
+      vtkTypeUInt64 key = vtkMaskPointsHash(this->Seed, stratum.Start);
+
+      if (stratum.Size >= n)
+        {
+        std::copy(this->Order + stratum.Start, this->Order + stratum.End,
+                  this->Ids + stratum.OutStart);
+        continue;
+        }
+      if (stratum.Size < 2)
+        {
+        if (stratum.Size == 1)
+          {
+          vtkIdType pick = static_cast<vtkIdType>(
+            vtkMaskPointsHash(key, 0) % static_cast<vtkTypeUInt64>(n));
+          this->Ids[stratum.OutStart] = this->Order[stratum.Start + pick];
+          }
+        continue;
+        }
+
+      // Median split, the bigger half being random for odd sizes
+      vtkIdType half = stratum.Start + n / 2;
+      int bigger = 0;
+      if (n % 2)
+        {
+        bigger = (vtkMaskPointsHash(key, 1) & 1) ? 1 : 2;
+        half += bigger == 1 ? 1 : 0;
+        }
+      vtkMaskPointsCompareCoordinates compare =
+        { this->Coordinates, this->Depth % 3 };
+      std::nth_element(this->Order + stratum.Start, this->Order + half,
+                       this->Order + stratum.End, compare);
+
+      // The bigger half, or a random one, takes the odd sample
+      vtkIdType leftSize = stratum.Size / 2;
+      if (stratum.Size % 2 &&
+          (bigger == 1 ||
+           (!bigger && (vtkMaskPointsHash(key, 2) & 1))))
+        {
+        ++leftSize;
+        }
+      left.Start = stratum.Start;
+      left.End = half;
+      left.Size = leftSize;
+      left.OutStart = stratum.OutStart;
+      right.Start = half;
+      right.End = stratum.End;
+      right.Size = stratum.Size - leftSize;
+      right.OutStart = stratum.OutStart + leftSize;
+      }
+  }
+};
+
+// Copy the selected points, and their data when outPD is given, to the
+// presized output
+struct vtkMaskPointsCopy
+{
+  vtkDataSet *Input;
+  vtkPointData *InPD;
+  vtkPoints *Points;
+  vtkPointData *OutPD;
+  const vtkIdType *Ids;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    double x[3];
+    for (vtkIdType k = begin; k < end; ++k)
+      {
+      this->Input->GetPoint(this->Ids[k], x);
+      this->Points->SetPoint(k, x);
+      if (this->OutPD)
+        {
+        this->OutPD->CopyData(this->InPD, this->Ids[k], k);
+        }
+      }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+void vtkMaskPoints::SelectPointsInParallel(vtkDataSet *input,
+                                           vtkIdType numNewPts,
+                                           vtkIdType localMaxPts,
+                                           vtkIdList *ids)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkTypeUInt64 seed = vtkMaskPointsHash(
+    static_cast<vtkTypeUInt32>(this->RandomSeed),
+    static_cast<vtkTypeUInt64>(this->InternalGetLocalProcessId()));
+
+  // GetPoint() is thread safe once called from a single thread
+  double x[3];
+  input->GetPoint(0, x);
+
+  if (!this->RandomMode ||
+      (this->RandomModeType == 1 && localMaxPts >= numPts))
+    {
+    vtkMaskPointsStride stride = { this->Offset, this->OnRatio, 0 };
+    vtkIdType numStrides = 0;
+    if (!this->RandomMode)
+      {
+      // As many points as the serial loop, which stops once an id reaches
+      // localMaxPts
+      numStrides = this->Offset < numPts ?
+        (numPts - this->Offset - 1) / this->OnRatio + 1 : 0;
+      numStrides = std::min(numStrides, localMaxPts + 1);
+      }
+    else
+      {
+      // The whole input is the sample
+      stride.Offset = 0;
+      stride.OnRatio = 1;
+      numStrides = numPts;
+      }
+    ids->SetNumberOfIds(numStrides);
+    stride.Ids = ids->GetPointer(0);
+    vtkSMPTools::For(0, numStrides, stride);
+    }
+  else if (this->RandomModeType == 0)
+    {
+    // The mean of the serial random strides
+    double meanStride =
+      static_cast<double>(numPts) / this->OnRatio > localMaxPts ?
+      static_cast<double>(numPts) / localMaxPts : this->OnRatio;
+    vtkMaskPointsBernoulli keep = { seed, this->Offset, 1.0 / meanStride };
+    vtkMaskPointsSelect(keep, numPts, localMaxPts, ids);
+    }
+  else if (this->RandomModeType == 1)
+    {
+    // Find the bucket of the histogram of the keys that holds the
+    // localMaxPts-th smallest key, then that key among the bucket ones
+    vtkMaskPointsKeyHistogram histogram;
+    histogram.Seed = seed;
+    vtkSMPTools::For(0, numPts, histogram);
+    std::vector<vtkIdType> counts(1 << 16, 0);
+    for (vtkSMPThreadLocal<std::vector<vtkIdType> >::iterator it =
+           histogram.Counts.begin(); it != histogram.Counts.end(); ++it)
+      {
+      for (size_t b = 0; b < counts.size(); ++b)
+        {
+        counts[b] += (*it)[b];
+        }
+      }
+    vtkIdType rank = localMaxPts;
+    vtkTypeUInt64 bucket = 0;
+    while (rank > counts[bucket])
+      {
+      rank -= counts[bucket++];
+      }
+
+    vtkMaskPointsBucketKeys bucketKeys;
+    bucketKeys.Seed = seed;
+    bucketKeys.Bucket = bucket;
+    vtkSMPTools::For(0, numPts, bucketKeys);
+    std::vector<std::pair<vtkTypeUInt64, vtkIdType> > keys;
+    for (vtkSMPThreadLocal<std::vector<std::pair<vtkTypeUInt64, vtkIdType> > >
+           ::iterator it = bucketKeys.Keys.begin();
+         it != bucketKeys.Keys.end(); ++it)
+      {
+      keys.insert(keys.end(), it->begin(), it->end());
+      }
+    std::nth_element(keys.begin(), keys.begin() + (rank - 1), keys.end());
+
+    vtkMaskPointsSmallestKeys keep =
+      { seed, keys[rank - 1].first, keys[rank - 1].second };
+    vtkMaskPointsSelect(keep, numPts, localMaxPts, ids);
+    }
+  else
+    {
+    // Spatially stratified sample of a permutation of the point ids
+    std::vector<double> coordinates(3 * numPts);
+    std::vector<vtkIdType> order(numPts);
+    vtkMaskPointsGatherCoordinates gather =
+      { input, &coordinates[0], &order[0] };
+    vtkSMPTools::For(0, numPts, gather);
+
+    vtkIdType numSamples = std::min(numNewPts, numPts);
+    ids->SetNumberOfIds(numSamples);
+    vtkMaskPointsStratum root = { 0, numPts, numSamples, 0 };
+    std::vector<vtkMaskPointsStratum> strata(1, root);
+    std::vector<vtkMaskPointsStratum> children;
+    for (int depth = 0; !strata.empty(); ++depth)
+      {
+      children.resize(2 * strata.size());
+      vtkMaskPointsStratify stratify =
+        { &coordinates[0], &order[0], ids->GetPointer(0),
+          vtkMaskPointsHash(seed, depth), depth, &strata[0], &children[0] };
+      vtkSMPTools::For(0, static_cast<vtkIdType>(strata.size()), 1, stratify);
+
+      strata.clear();
+      for (size_t c = 0; c < children.size(); ++c)
+        {
+        if (children[c].Size > 0)
+          {
+          strata.push_back(children[c]);
+          }
+        }
+      }
+    }
+}
 
 unsigned long vtkMaskPoints::GetLocalSampleSize(vtkIdType numPts, int np)
 {
@@ -383,7 +864,40 @@ int vtkMaskPoints::RequestData(
 
   // Traverse points and copy
   vtkIdType progressInterval=numPts/20 +1;
-  if ( this->RandomMode ) // random modes
+  if ( this->SampleInParallel )
+    {
+    vtkNew<vtkIdList> ids;
+    this->SelectPointsInParallel(input, numNewPts, localMaxPts,
+                                 ids.GetPointer());
+    vtkIdType numSelected = ids->GetNumberOfIds();
+
+    newPts->SetNumberOfPoints(numSelected);
+    bool parallelData = vtkMaskPointsAreArraysThreadSafe(outputPD);
+    if (parallelData)
+      {
+      outputPD->SetNumberOfTuples(numSelected);
+      }
+    vtkMaskPointsCopy copy = { input, pd, newPts,
+                               parallelData ? outputPD : 0,
+                               ids->GetPointer(0) };
+    vtkSMPTools::For(0, numSelected, copy);
+    if (!parallelData)
+      {
+      for (vtkIdType k = 0; k < numSelected; ++k)
+        {
+        outputPD->CopyData(pd, ids->GetId(k), k);
+        }
+      }
+    id = numSelected - 1;
+
+    // PARALLEL CODE
+    // keep the barrier of the serial stratified sampling
+    if (this->RandomMode && this->RandomModeType == 2)
+      {
+      this->InternalBarrier();
+      }
+    }
+  else if ( this->RandomMode ) // random modes
     {
     if(this->RandomModeType == 0)
       {
@@ -573,7 +1087,7 @@ int vtkMaskPoints::RequestData(
     }
 
   // Generate vertices if requested
-  if ( this->GenerateVertices )
+  if ( this->GenerateVertices && id >= 0 )
     {
     vtkCellArray *verts = vtkCellArray::New();
     if (this->SingleVertexPerCell)
@@ -644,4 +1158,7 @@ void vtkMaskPoints::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Output Points Precision: "
      << this->GetOutputPointsPrecision() << "\n";
+  os << indent << "Sample In Parallel: "
+     << (this->GetSampleInParallel() ? "On\n" : "Off\n");
+  os << indent << "Random Seed: " << this->GetRandomSeed() << "\n";
 }
@@ -31,6 +31,8 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+class vtkIdList;
+
 class VTKFILTERSCORE_EXPORT vtkMaskPoints : public vtkPolyDataAlgorithm
 {
 public:
@@ -122,6 +124,30 @@ public:
   vtkSetMacro(OutputPointsPrecision,int);
   vtkGetMacro(OutputPointsPrecision,int);
 
+  // Description:
+  // When on, the points are selected and copied in parallel (via
+  // vtkSMPTools). Striding selects the same points as the serial filter.
+  // The random modes draw counter-based random numbers from RandomSeed
+  // instead of the global generator, so that the sample only depends on
+  // the seed and not on the number of threads:
+  // 0 - each point from Offset on is kept with the probability of the
+  //     serial random strides, up to the maximum number of points;
+  // 1 - the points with the smallest random keys make a uniform random
+  //     sample of exactly the maximum number of points, in input order;
+  // 2 - the strata are split level by level, the strata of a level in
+  //     parallel.
+  // Off by default.
+  vtkSetMacro(SampleInParallel,int);
+  vtkGetMacro(SampleInParallel,int);
+  vtkBooleanMacro(SampleInParallel,int);
+
+  // Description:
+  // Seed of the random numbers used by the random modes when
+  // SampleInParallel is on. vtkPMaskPoints combines it with the process id.
+  // Default is 1.
+  vtkSetMacro(RandomSeed,int);
+  vtkGetMacro(RandomSeed,int);
+
 protected:
   vtkMaskPoints();
   ~vtkMaskPoints() {}
@@ -139,6 +165,8 @@ protected:
   int RandomModeType; // choose the random sampling mode
   int ProportionalMaximumNumberOfPoints;
   int OutputPointsPrecision;
+  int SampleInParallel;
+  int RandomSeed;
 
   virtual void InternalScatter(unsigned long*, unsigned long *, int, int) {}
   virtual void InternalGather(unsigned long*, unsigned long*, int, int) {}
@@ -147,6 +175,12 @@ protected:
   virtual void InternalBarrier() {}
   unsigned long GetLocalSampleSize(vtkIdType, int);
 
+  // Description:
+  // Select the ids of the points to pass, in the order of the output, with
+  // the parallel implementation of the current mode.
+  void SelectPointsInParallel(vtkDataSet *input, vtkIdType numNewPts,
+                              vtkIdType localMaxPts, vtkIdList *ids);
+
 private:
   vtkMaskPoints(const vtkMaskPoints&);  // Not implemented.
   void operator=(const vtkMaskPoints&);  // Not implemented.
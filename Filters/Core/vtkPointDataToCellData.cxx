@@ -15,15 +15,114 @@
 #include "vtkPointDataToCellData.h"
 
 #include "vtkCellData.h"
+#include "vtkDataArray.h"
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkPointDataToCellData);
 
+namespace
+{
+  // Presizes the arrays that InterpolateAllocate() added to the cell data,
+  // so that InterpolatePoint() writes distinct tuples in place from several
+  // threads. Returns false, leaving the arrays alone, when one of the new
+  // arrays cannot be written that way.
+  bool vtkPointDataToCellDataPresizeArrays(vtkCellData *cd,
+                                           vtkIdType numCells)
+  {
+    for (int i = 0; i < cd->GetNumberOfArrays(); ++i)
+      {
+      vtkAbstractArray *aa = cd->GetAbstractArray(i);
+      vtkDataArray *da = vtkDataArray::SafeDownCast(aa);
+      if ( aa->GetNumberOfTuples() < numCells &&
+           (!da || da->GetDataType() == VTK_BIT ||
+            !da->HasStandardMemoryLayout()) )
+        {
+        return false;
+        }
+      }
+    for (int i = 0; i < cd->GetNumberOfArrays(); ++i)
+      {
+      vtkAbstractArray *aa = cd->GetAbstractArray(i);
+      if ( aa->GetNumberOfTuples() < numCells )
+        {
+        aa->SetNumberOfTuples(numCells);
+        }
+      }
+    return true;
+  }
+
+  // InterpolatePoint() reads the input arrays through GetVoidPointer(),
+  // which first copies values shared with other arrays. Do it once here, as
+  // the first point of a serial loop would, rather than from the threads.
+  void vtkPointDataToCellDataUnshareArrays(vtkPointData *inPD)
+  {
+    for (int i = 0; i < inPD->GetNumberOfArrays(); ++i)
+      {
+      vtkDataArray *da = inPD->GetArray(i);
+      if ( da && da->HasStandardMemoryLayout() )
+        {
+        da->GetVoidPointer(0);
+        }
+      }
+  }
+
+  // Averages the point data of the points of each cell into the cell data.
+  // Each thread has its own point ids and weights and writes its own cells.
+  class vtkPointDataToCellDataInterpolate
+  {
+  public:
+    vtkDataSet *Input;
+    vtkPointData *InPD;
+    vtkCellData *OutCD;
+    int MaxCellSize;
+
+    vtkSMPThreadLocalObject<vtkIdList> CellPts;
+    vtkSMPThreadLocal<std::vector<double> > Weights;
+
+    void Initialize()
+    {
+      this->CellPts.Local()->Allocate(this->MaxCellSize);
+      this->Weights.Local().resize(this->MaxCellSize);
+    }
+
+    void operator()(vtkIdType cellId, vtkIdType end)
+    {
+      vtkIdList *cellPts = this->CellPts.Local();
+      std::vector<double> &weights = this->Weights.Local();
+      for ( ; cellId < end; ++cellId )
+        {
+        this->Input->GetCellPoints(cellId, cellPts);
+        vtkIdType numPts = cellPts->GetNumberOfIds();
+        if ( numPts > 0 )
+          {
+          if ( static_cast<size_t>(numPts) > weights.size() )
+            {
+            weights.resize(numPts);
+            }
+          std::fill_n(weights.begin(), numPts, 1.0 / numPts);
+          this->OutCD->InterpolatePoint(this->InPD, cellId, cellPts,
+                                        &weights[0]);
+          }
+        }
+    }
+
+    void Reduce()
+    {
+    }
+  };
+}
+
 //----------------------------------------------------------------------------
 // Instantiate object so that point data is not passed to output.
 vtkPointDataToCellData::vtkPointDataToCellData()
@@ -80,9 +179,26 @@ int vtkPointDataToCellData::RequestData(
   // It's weird, but it works.
   outCD->InterpolateAllocate(inPD,numCells);
 
+  // Interpolate the cells in parallel when the new arrays can be written
+  // from several threads. GetCellPoints() is thread safe once called from a
+  // single thread, which builds the cells of vtkPolyData.
+  bool parallel = vtkPointDataToCellDataPresizeArrays(outCD, numCells);
+  if ( parallel )
+    {
+    input->GetCellPoints(0, cellPts);
+    vtkPointDataToCellDataUnshareArrays(inPD);
+
+    vtkPointDataToCellDataInterpolate interpolate;
+    interpolate.Input = input;
+    interpolate.InPD = inPD;
+    interpolate.OutCD = outCD;
+    interpolate.MaxCellSize = maxCellSize;
+    vtkSMPTools::For(0, numCells, interpolate);
+    }
+
   int abort=0;
   vtkIdType progressInterval=numCells/20 + 1;
-  for (cellId=0; cellId < numCells && !abort; cellId++)
+  for (cellId=0; !parallel && cellId < numCells && !abort; cellId++)
     {
     if ( !(cellId % progressInterval) )
       {
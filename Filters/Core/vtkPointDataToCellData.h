@@ -19,6 +19,8 @@
 // The method of transformation is based on averaging the data
 // values of all points defining a particular cell. Optionally, the input point
 // data can be passed through to the output as well.
+// The cells are averaged in parallel with vtkSMPTools when all the new cell
+// arrays are data arrays that can be written from several threads.
 
 // .SECTION Caveats
 // This filter is an abstract filter, that is, the output is an abstract type
@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCell.h"
+#include "vtkConnectivityLabeler.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -58,6 +59,7 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
   this->VisitedPointIds = vtkIdList::New();
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->LabelRegionsInParallel = 0;
 }
 
 vtkPolyDataConnectivityFilter::~vtkPolyDataConnectivityFilter()
@@ -131,11 +133,27 @@ int vtkPolyDataConnectivityFilter::RequestData(
       }
     }
 
-  // Build cell structure
+  // Build cell structure. The parallel union-find uses the static links of
+  // the input instead.
   //
-  this->Mesh = vtkPolyData::New();
-  this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
+  vtkConnectivityLabeler *labeler = NULL;
+  if ( this->LabelRegionsInParallel )
+    {
+    labeler = new vtkConnectivityLabeler(input);
+    if ( this->InScalars )
+      {
+      labeler->SetScalarCriterion(this->InScalars, this->ScalarRange,
+                                  this->FullScalarConnectivity != 0);
+      }
+    this->Mesh = input;
+    this->Mesh->Register(this);
+    }
+  else
+    {
+    this->Mesh = vtkPolyData::New();
+    this->Mesh->CopyStructure(input);
+    this->Mesh->BuildLinks();
+    }
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
@@ -188,6 +206,23 @@ int vtkPolyDataConnectivityFilter::RequestData(
 
   if ( this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
   this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
+  this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION &&
+  labeler )
+    { //label all cells, the first largest region is extracted
+    this->RegionNumber = labeler->LabelAllRegions(this->Visited,
+                                                  this->RegionSizes);
+    for (i=0; i < this->RegionNumber; i++)
+      {
+      if ( this->RegionSizes->GetValue(i) > maxCellsInRegion )
+        {
+        maxCellsInRegion = this->RegionSizes->GetValue(i);
+        largestRegionId = i;
+        }
+      }
+    this->UpdateProgress (0.9);
+    }
+  else if ( this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+  this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
   this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION )
     { //visit all cells marking with region number
     for (cellId=0; cellId < numCells; cellId++)
@@ -220,7 +255,29 @@ int vtkPolyDataConnectivityFilter::RequestData(
     {
     this->NumCellsInRegion = 0;
 
-    if ( this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS )
+    // The union-find takes the seed cells in CellIds.
+    if ( labeler && this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS )
+      {
+      for (i=0; i < this->Seeds->GetNumberOfIds(); i++)
+        {
+        if ( (pt=this->Seeds->GetId(i)) >= 0 )
+          {
+          labeler->InsertPointCells(pt, this->CellIds);
+          }
+        }
+      }
+    else if ( labeler &&
+              this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS )
+      {
+      for (i=0; i < this->Seeds->GetNumberOfIds(); i++)
+        {
+        if ( (cellId=this->Seeds->GetId(i)) >= 0 )
+          {
+          this->CellIds->InsertNextId(cellId);
+          }
+        }
+      }
+    else if ( this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS )
       {
       for (i=0; i < this->Seeds->GetNumberOfIds(); i++)
         {
@@ -260,20 +317,44 @@ int vtkPolyDataConnectivityFilter::RequestData(
           minDist2 = dist2;
           }
         }
-      this->Mesh->GetPointCells(minId,ncells,cells);
-      for (unsigned short j=0; j < ncells; ++j)
+      if ( labeler )
         {
-        this->Wave.push_back(cells[j]);
+        labeler->InsertPointCells(minId, this->CellIds);
+        }
+      else
+        {
+        this->Mesh->GetPointCells(minId,ncells,cells);
+        for (unsigned short j=0; j < ncells; ++j)
+          {
+          this->Wave.push_back(cells[j]);
+          }
         }
       }
     this->UpdateProgress (0.5);
 
     //mark all seeded regions
-    this->TraverseAndMark ();
+    if ( labeler )
+      {
+      this->NumCellsInRegion = labeler->LabelSeededRegion(this->CellIds,
+                                                          this->Visited);
+      }
+    else
+      {
+      this->TraverseAndMark ();
+      }
     this->RegionSizes->InsertValue(this->RegionNumber,this->NumCellsInRegion);
     this->UpdateProgress (0.9);
     }//else extracted seeded cells
 
+  // The union-find does not number the points: they are numbered in the
+  // order of their ids.
+  if ( labeler )
+    {
+    this->PointNumber = labeler->MapPoints(this->Visited, this->PointMap,
+      vtkIdTypeArray::SafeDownCast(this->NewScalars)->GetPointer(0));
+    delete labeler;
+    }
+
   vtkDebugMacro (<<"Extracted " << this->RegionNumber << " region(s)");
 
   // Now that points and cells have been marked, traverse these lists pulling
@@ -428,7 +509,7 @@ int vtkPolyDataConnectivityFilter::RequestData(
 
   delete [] this->Visited;
   delete [] this->PointMap;
-  this->Mesh->Delete();
+  this->Mesh->UnRegister(this);
   output->Squeeze();
   this->CellIds->Delete();
   this->PointIds->Delete();
@@ -661,4 +742,6 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
     }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Label Regions In Parallel: "
+     << (this->LabelRegionsInParallel ? "On\n" : "Off\n");
 }
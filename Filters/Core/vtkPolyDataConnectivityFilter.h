@@ -180,6 +180,17 @@ public:
   vtkSetMacro(OutputPointsPrecision,int);
   vtkGetMacro(OutputPointsPrecision,int);
 
+  // Description:
+  // Turn on/off labeling the regions with a parallel union-find over the
+  // cells (see vtkConnectivityLabeler) instead of the serial wave front
+  // traversal, which also avoids building the cell links of a copy of the
+  // input. The regions and the output cells are the same, but the output
+  // points are ordered by input point id rather than in traversal order.
+  // Off by default.
+  vtkSetMacro(LabelRegionsInParallel,int);
+  vtkGetMacro(LabelRegionsInParallel,int);
+  vtkBooleanMacro(LabelRegionsInParallel,int);
+
 protected:
   vtkPolyDataConnectivityFilter();
   ~vtkPolyDataConnectivityFilter();
@@ -224,6 +235,7 @@ protected:
 
   int MarkVisitedPointIds;
   int OutputPointsPrecision;
+  int LabelRegionsInParallel;
 
 private:
   vtkPolyDataConnectivityFilter(const vtkPolyDataConnectivityFilter&);  // Not implemented.
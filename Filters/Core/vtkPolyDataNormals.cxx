@@ -23,10 +23,17 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkPolygon.h"
 #include "vtkTriangleStrip.h"
 #include "vtkPriorityQueue.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkPolyDataNormals);
 
 // Construct with feature angle=30, splitting and consistency turned on,
@@ -49,6 +56,7 @@ vtkPolyDataNormals::vtkPolyDataNormals()
   this->CellIds = 0;
   this->Map = 0;
   this->OldMesh = 0;
+  this->OldLinks = 0;
   this->NewMesh = 0;
   this->Visited = 0;
   this->PolyNormals = 0;
@@ -58,6 +66,217 @@ vtkPolyDataNormals::vtkPolyDataNormals()
 #define VTK_CELL_NOT_VISITED     0
 #define VTK_CELL_VISITED         1
 
+namespace
+{
+// A cell whose point PointId, at position Spot, is replaced by the
+// duplicate of the point for the region Region.
+struct vtkPolyDataNormalsSplit
+{
+  vtkIdType PointId;
+  vtkIdType CellId;
+  vtkIdType Spot;
+  int Region;
+};
+
+bool vtkPolyDataNormalsAreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(i));
+    if (!array || array->GetDataType() == VTK_BIT ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Computes the normal of each polygon.
+struct vtkPolyDataNormalsPolyNormals
+{
+  vtkPolyData *Mesh;
+  vtkPoints *Points;
+  float *Normals;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType npts, *pts;
+    double n[3];
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Mesh->GetCellPoints(cellId, npts, pts);
+      vtkPolygon::ComputeNormal(this->Points, npts, pts, n);
+      this->Normals[3 * cellId] = static_cast<float>(n[0]);
+      this->Normals[3 * cellId + 1] = static_cast<float>(n[1]);
+      this->Normals[3 * cellId + 2] = static_cast<float>(n[2]);
+      }
+  }
+};
+
+// Replaces the split points in the cells and records the duplicates in the
+// map of the new points to the input points. Each buffer holds the splits
+// of distinct points, and thus writes distinct entries.
+struct vtkPolyDataNormalsApplySplits
+{
+  std::vector<std::vector<vtkPolyDataNormalsSplit>*> Buffers;
+  vtkPolyData *Mesh;
+  const vtkIdType *Offsets;
+  vtkIdType NumberOfPoints;
+  vtkIdList *Map;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType npts, *pts;
+    for (vtkIdType b = begin; b < end; ++b)
+      {
+      const std::vector<vtkPolyDataNormalsSplit> &splits = *this->Buffers[b];
+      for (size_t i = 0; i < splits.size(); ++i)
+        {
+        const vtkPolyDataNormalsSplit &split = splits[i];
+        vtkIdType replacementPoint = this->NumberOfPoints +
+          this->Offsets[split.PointId] + split.Region - 1;
+        this->Map->SetId(replacementPoint, split.PointId);
+        this->Mesh->GetCellPoints(split.CellId, npts, pts);
+        pts[split.Spot] = replacementPoint; // direct write into the cells
+        }
+      }
+  }
+};
+
+// Copies the input points and their attributes to the new points.
+struct vtkPolyDataNormalsCopyPoints
+{
+  vtkPoints *InPoints;
+  vtkPoints *OutPoints;
+  vtkPointData *InPD;
+  vtkPointData *OutPD;
+  vtkIdList *Map;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      vtkIdType oldId = this->Map->GetId(ptId);
+      this->InPoints->GetPoint(oldId, x);
+      this->OutPoints->SetPoint(ptId, x);
+      this->OutPD->CopyData(this->InPD, oldId, ptId);
+      }
+  }
+};
+
+// Averages the normals of the polygons using each (possibly split) point.
+// The polygons are gathered from the links of the input point, so that the
+// sums are made in the same order as a serial accumulation over the
+// polygons.
+struct vtkPolyDataNormalsPointNormals
+{
+  vtkPolyData *Mesh;
+  vtkStaticCellLinks *Links;
+  vtkIdList *Map;
+  const float *PolyNormals;
+  float *Normals;
+  double FlipDirection;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType npts, *pts;
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      vtkIdType oldId = this->Map ? this->Map->GetId(ptId) : ptId;
+      vtkIdType ncells = this->Links->GetNumberOfCells(oldId);
+      const vtkIdType *cells = this->Links->GetCells(oldId);
+      float *n = this->Normals + 3 * ptId;
+      n[0] = n[1] = n[2] = 0.0f;
+      for (vtkIdType j = 0; j < ncells; ++j)
+        {
+        const float *polyNormal = this->PolyNormals + 3 * cells[j];
+        this->Mesh->GetCellPoints(cells[j], npts, pts);
+        for (vtkIdType i = 0; i < npts; ++i)
+          {
+          if (pts[i] == ptId)
+            {
+            n[0] += polyNormal[0];
+            n[1] += polyNormal[1];
+            n[2] += polyNormal[2];
+            }
+          }
+        }
+      const double length =
+        sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) * this->FlipDirection;
+      if (length != 0.0)
+        {
+        n[0] /= length;
+        n[1] /= length;
+        n[2] /= length;
+        }
+      }
+  }
+};
+}
+
+// Labels the regions around each point and records the cells whose point
+// is replaced by a duplicate in per-thread buffers.
+class vtkPolyDataNormalsMarkRegions
+{
+public:
+  vtkPolyDataNormals *Self;
+  vtkIdType *NumberOfSplits;
+  vtkSMPThreadLocal<std::vector<vtkPolyDataNormalsSplit> > Splits;
+  vtkSMPThreadLocal<std::vector<int> > Regions;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<vtkPolyDataNormalsSplit> &splits = this->Splits.Local();
+    std::vector<int> &regions = this->Regions.Local();
+    vtkIdList *cellIds = this->CellIds.Local();
+    vtkStaticCellLinks *links = this->Self->OldLinks;
+    vtkIdType npts, *pts;
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      this->NumberOfSplits[ptId] = 0;
+      vtkIdType ncells = links->GetNumberOfCells(ptId);
+      if ( ncells <= 1 )
+        {
+        continue; //point does not need to be further disconnected
+        }
+      regions.resize(ncells);
+      int numRegions = this->Self->MarkRegions(ptId, &regions[0], cellIds);
+      if ( numRegions <= 1 )
+        {
+        continue; //a single region, no splitting ever required
+        }
+      this->NumberOfSplits[ptId] = numRegions - 1;
+
+      // For all cells not in the first region, the ptId is replaced with
+      // a new ptId, which is a duplicate of the first point, but
+      // disconnected topologically.
+      const vtkIdType *cells = links->GetCells(ptId);
+      for (vtkIdType j = 0; j < ncells; ++j)
+        {
+        if ( regions[j] > 0 )
+          {
+          vtkPolyDataNormalsSplit split;
+          split.PointId = ptId;
+          split.CellId = cells[j];
+          split.Region = regions[j];
+          this->Self->NewMesh->GetCellPoints(cells[j], npts, pts);
+          for (split.Spot = 0; split.Spot < npts; ++split.Spot)
+            {
+            if ( pts[split.Spot] == ptId )
+              {
+              break;
+              }
+            }
+          splits.push_back(split);
+          }
+        }
+      }
+  }
+};
+
 // Generate normals for polygon meshes
 int vtkPolyDataNormals::RequestData(
   vtkInformation *vtkNotUsed(request),
@@ -90,7 +309,7 @@ int vtkPolyDataNormals::RequestData(
   vtkCellData *outCD;
   double n[3];
   vtkCellArray *newPolys;
-  vtkIdType ptId, oldId;
+  vtkIdType ptId;
 
   vtkDebugMacro(<<"Generating surface normals");
 
@@ -149,7 +368,7 @@ int vtkPolyDataNormals::RequestData(
     this->OldMesh->SetPolys(inPolys);
     polys = inPolys;
     }
-  this->OldMesh->BuildLinks();
+  this->OldLinks = this->OldMesh->GetStaticCellLinks();
   this->UpdateProgress(0.10);
 
   pd = input->GetPointData();
@@ -162,6 +381,9 @@ int vtkPolyDataNormals::RequestData(
   // create a copy because we're modifying it
   newPolys = vtkCellArray::New();
   newPolys->DeepCopy(polys);
+  // the point ids of the cells are rewritten in place, and read from
+  // several threads: they must be stored as vtkIdType
+  newPolys->Use32BitStorageOff();
   this->NewMesh->SetPolys(newPolys);
   this->NewMesh->BuildCells(); //builds connectivity
 
@@ -199,8 +421,8 @@ int vtkPolyDataNormals::RequestData(
     // the mesh. Report bugs/issues to cvolpe@ara.com.
     int foundLeftmostCell;
     vtkIdType leftmostCellID=-1, currentPointID, currentCellID;
-    vtkIdType *leftmostCells;
-    unsigned short nleftmostCells;
+    const vtkIdType *leftmostCells;
+    vtkIdType nleftmostCells;
     vtkIdType *cellPts;
     vtkIdType nCellPts;
     int cIdx;
@@ -233,7 +455,8 @@ int vtkPolyDataNormals::RequestData(
       // at that point
       do {
         currentPointID = leftmostPoints->Pop();
-        this->OldMesh->GetPointCells(currentPointID, nleftmostCells, leftmostCells);
+        nleftmostCells = this->OldLinks->GetNumberOfCells(currentPointID);
+        leftmostCells = this->OldLinks->GetCells(currentPointID);
         bestNormalAbsXComponent = 0.0;
         bestReverseFlag = 0;
         for (cIdx = 0; cIdx < nleftmostCells; cIdx++)
@@ -323,20 +546,11 @@ int vtkPolyDataNormals::RequestData(
   this->PolyNormals->SetName("Normals");
   this->PolyNormals->SetNumberOfTuples(numPolys);
 
-  for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts);
-       cellId++ )
-    {
-    if ((cellId % 1000) == 0)
-      {
-      this->UpdateProgress (0.333 + 0.333 * (double) cellId / (double) numPolys);
-      if (this->GetAbortExecute())
-        {
-        break;
-        }
-      }
-    vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-    this->PolyNormals->SetTuple(cellId,n);
-    }
+  float *fPolyNormals = this->PolyNormals->WritePointer(0, 3 * numPolys);
+  vtkPolyDataNormalsPolyNormals polyNormals =
+    { this->NewMesh, inPts, fPolyNormals };
+  vtkSMPTools::For(0, numPolys, polyNormals);
+  this->UpdateProgress(0.5);
 
   // Split mesh if sharp features
   if ( this->Splitting )
@@ -349,19 +563,37 @@ int vtkPolyDataNormals::RequestData(
     //  Splitting will create new points.  We have to create index array
     // to map new points into old points.
     //
+    //  The regions around the points are labeled in parallel. The
+    //  duplicates of a point are numbered after those of the previous
+    //  points, from the prefix sums of the number of duplicates.
+    //
+    std::vector<vtkIdType> offsets(numPts);
+    vtkPolyDataNormalsMarkRegions markRegions;
+    markRegions.Self = this;
+    markRegions.NumberOfSplits = &offsets[0];
+    vtkSMPTools::For(0, numPts, markRegions);
+    numNewPts = numPts + vtkSMPTools::ExclusiveScan(offsets.begin(),
+      offsets.end(), offsets.begin(), static_cast<vtkIdType>(0));
+
     this->Map = vtkIdList::New();
-    this->Map->SetNumberOfIds(numPts);
+    this->Map->SetNumberOfIds(numNewPts);
     for (i=0; i < numPts; i++)
       {
       this->Map->SetId(i,i);
       }
-
-    for (ptId=0; ptId < numPts; ptId++)
+    vtkPolyDataNormalsApplySplits applySplits;
+    vtkSMPThreadLocal<std::vector<vtkPolyDataNormalsSplit> >::iterator
+      splitsIter = markRegions.Splits.begin();
+    for ( ; splitsIter != markRegions.Splits.end(); ++splitsIter)
       {
-      this->MarkAndSplit(ptId);
-      }//for all input points
-
-    numNewPts = this->Map->GetNumberOfIds();
+      applySplits.Buffers.push_back(&*splitsIter);
+      }
+    applySplits.Mesh = this->NewMesh;
+    applySplits.Offsets = &offsets[0];
+    applySplits.NumberOfPoints = numPts;
+    applySplits.Map = this->Map;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(applySplits.Buffers.size()),
+                     1, applySplits);
 
     vtkDebugMacro(<<"Created " << numNewPts-numPts << " new points");
 
@@ -395,13 +627,17 @@ int vtkPolyDataNormals::RequestData(
       }
 
     newPts->SetNumberOfPoints(numNewPts);
-    for (ptId=0; ptId < numNewPts; ptId++)
+    vtkPolyDataNormalsCopyPoints copyPoints =
+      { inPts, newPts, pd, outPD, this->Map };
+    if (vtkPolyDataNormalsAreArraysThreadSafe(pd))
       {
-      oldId = this->Map->GetId(ptId);
-      newPts->SetPoint(ptId,inPts->GetPoint(oldId));
-      outPD->CopyData(pd,oldId,ptId);
+      outPD->SetNumberOfTuples(numNewPts);
+      vtkSMPTools::For(0, numNewPts, copyPoints);
+      }
+    else
+      {
+      copyPoints(0, numNewPts);
       }
-    this->Map->Delete();
     } //splitting
 
   else //no splitting, so no new points
@@ -432,36 +668,21 @@ int vtkPolyDataNormals::RequestData(
   newNormals->SetNumberOfTuples(numNewPts);
   newNormals->SetName("Normals");
   float *fNormals = newNormals->WritePointer(0, 3 * numNewPts);
-  std::fill_n(fNormals, 3 * numNewPts, 0);
-
-  float *fPolyNormals = this->PolyNormals->WritePointer(0, 3 * numPolys);
 
   if (this->ComputePointNormals)
     {
-    for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);
-         ++cellId)
-      {
-      for (i = 0; i < npts; ++i)
-        {
-        fNormals[3 * pts[i]] += fPolyNormals[3 * cellId];
-        fNormals[3 * pts[i] + 1] += fPolyNormals[3 * cellId + 1];
-        fNormals[3 * pts[i] + 2] += fPolyNormals[3 * cellId + 2];
-        }
-      }
-
-    for (i = 0; i < numNewPts; ++i)
-      {
-      const double length = sqrt(fNormals[3 * i] * fNormals[3 * i] +
-                                 fNormals[3 * i + 1] * fNormals[3 * i + 1] +
-                                 fNormals[3 * i + 2] * fNormals[3 * i + 2]
-                                 ) * flipDirection;
-      if (length != 0.0)
-        {
-        fNormals[3 * i] /= length;
-        fNormals[3 * i + 1] /= length;
-        fNormals[3 * i + 2] /= length;
-        }
-      }
+    vtkPolyDataNormalsPointNormals pointNormals =
+      { this->NewMesh, this->OldLinks, this->Splitting ? this->Map : NULL,
+        fPolyNormals, fNormals, flipDirection };
+    vtkSMPTools::For(0, numNewPts, pointNormals);
+    }
+  else
+    {
+    std::fill_n(fNormals, 3 * numNewPts, 0);
+    }
+  if (this->Splitting)
+    {
+    this->Map->Delete();
     }
 
   //  Update ourselves.  If no new nodes have been created (i.e., no
@@ -500,6 +721,7 @@ int vtkPolyDataNormals::RequestData(
   output->SetLines(input->GetLines());
 
   this->OldMesh->Delete();
+  this->OldLinks = 0;
   this->NewMesh->Delete();
 
   return 1;
@@ -527,7 +749,7 @@ void vtkPolyDataNormals::TraverseAndOrder (void)
 
       for (j = 0, j1 = 1; j < npts; ++j, (j1 = (++j1 < npts) ? j1 : 0)) //for each edge neighbor
         {
-        this->OldMesh->GetCellEdgeNeighbors(cellId, pts[j], pts[j1], this->CellIds);
+        this->OldLinks->GetCellEdgeNeighbors(cellId, pts[j], pts[j1], this->CellIds);
 
         //  Check the direction of the neighbor ordering.  Should be
         //  consistent with us (i.e., if we are n1->n2,
@@ -575,21 +797,19 @@ void vtkPolyDataNormals::TraverseAndOrder (void)
 }
 
 //
-//  Mark polygons around vertex.  Create new vertex (if necessary) and
-//  replace (i.e., split mesh).
+//  Mark polygons around vertex with the regions separated by feature
+//  edges. The caller creates the new vertices (if necessary).
 //
-void vtkPolyDataNormals::MarkAndSplit (vtkIdType ptId)
+int vtkPolyDataNormals::MarkRegions(vtkIdType ptId, int *regions,
+                                    vtkIdList *cellIds)
 {
-  int i,j;
+  int i;
+  vtkIdType j;
 
-  // Get the cells using this point and make sure that we have to do something
-  unsigned short ncells;
-  vtkIdType *cells;
-  this->OldMesh->GetPointCells(ptId,ncells,cells);
-  if ( ncells <= 1 )
-    {
-    return; //point does not need to be further disconnected
-    }
+  // Get the cells using this point. They are listed in increasing order,
+  // which locates the label of a cell.
+  vtkIdType ncells = this->OldLinks->GetNumberOfCells(ptId);
+  const vtkIdType *cells = this->OldLinks->GetCells(ptId);
 
   // Start moving around the "cycle" of points using the point. Label
   // each point as requiring a visit. Then label each subregion of cells
@@ -599,25 +819,27 @@ void vtkPolyDataNormals::MarkAndSplit (vtkIdType ptId)
   // replaces the current point ptId in the polygons connectivity array.
   //
   // Start by initializing the cells as unvisited
-  for (i=0; i<ncells; i++)
+  for (j=0; j<ncells; j++)
     {
-    this->Visited[cells[i]] = -1;
+    regions[j] = -1;
     }
 
-  // Loop over all cells and mark the region that each is in.
+  // Loop over all cells and mark the region that each is in. The cells
+  // are read from the new mesh: reordering them for consistency does not
+  // change the neighbors of a point.
   //
   vtkIdType numPts;
   vtkIdType *pts;
   int numRegions = 0;
-  vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
+  vtkIdType spot, neiPt[2], nei, cellId, neiCellId, neiIdx;
   double thisNormal[3], neiNormal[3];
   for (j=0; j<ncells; j++) //for all cells connected to point
     {
-    if ( this->Visited[cells[j]] < 0 ) //for all unvisited cells
+    if ( regions[j] < 0 ) //for all unvisited cells
       {
-      this->Visited[cells[j]] = numRegions;
+      regions[j] = numRegions;
       //okay, mark all the cells connected to this seed cell and using ptId
-      this->OldMesh->GetCellPoints(cells[j],numPts,pts);
+      this->NewMesh->GetCellPoints(cells[j],numPts,pts);
 
       //find the two edges
       for (spot=0; spot < numPts; spot++)
@@ -650,9 +872,10 @@ void vtkPolyDataNormals::MarkAndSplit (vtkIdType ptId)
         nei = neiPt[i];
         while ( cellId >= 0 ) //while we can grow this region
           {
-          this->OldMesh->GetCellEdgeNeighbors(cellId,ptId,nei,this->CellIds);
-          if ( this->CellIds->GetNumberOfIds() == 1 &&
-               this->Visited[(neiCellId=this->CellIds->GetId(0))] < 0 )
+          this->OldLinks->GetCellEdgeNeighbors(cellId,ptId,nei,cellIds);
+          if ( cellIds->GetNumberOfIds() == 1 &&
+               regions[(neiIdx = std::lower_bound(cells, cells + ncells,
+                 neiCellId=cellIds->GetId(0)) - cells)] < 0 )
             {
             this->PolyNormals->GetTuple(cellId, thisNormal);
             this->PolyNormals->GetTuple(neiCellId, neiNormal);
@@ -660,9 +883,9 @@ void vtkPolyDataNormals::MarkAndSplit (vtkIdType ptId)
             if ( vtkMath::Dot(thisNormal,neiNormal) > CosAngle )
               {
               //visit and arrange to visit next edge neighbor
-              this->Visited[neiCellId] = numRegions;
+              regions[neiIdx] = numRegions;
               cellId = neiCellId;
-              this->OldMesh->GetCellPoints(cellId,numPts,pts);
+              this->NewMesh->GetCellPoints(cellId,numPts,pts);
 
               for (spot=0; spot < numPts; spot++)
                 {
@@ -701,38 +924,7 @@ void vtkPolyDataNormals::MarkAndSplit (vtkIdType ptId)
       }//if cell is unvisited
     }//for all cells connected to point ptId
 
-  if ( numRegions <=1 )
-    {
-    return; //a single region, no splitting ever required
-    }
-
-  // Okay, for all cells not in the first region, the ptId is
-  // replaced with a new ptId, which is a duplicate of the first
-  // point, but disconnected topologically.
-  //
-  vtkIdType lastId = this->Map->GetNumberOfIds();
-  vtkIdType replacementPoint;
-  for (j=0; j<ncells; j++)
-    {
-    if (this->Visited[cells[j]] > 0 ) //replace point if splitting needed
-      {
-      replacementPoint = lastId + this->Visited[cells[j]] - 1;
-
-      this->Map->InsertId(replacementPoint, ptId);
-
-      this->NewMesh->GetCellPoints(cells[j],numPts,pts);
-      for (i=0; i < numPts; i++)
-        {
-        if ( pts[i] == ptId )
-          {
-          pts[i] = replacementPoint; // this is very nasty! direct write!
-          break;
-          }
-        }//replace ptId with split point
-      }//if not in first regions and requiring splitting
-    }//for all cells connected to ptId
-
-  return;
+  return numRegions;
 }
 
 void vtkPolyDataNormals::PrintSelf(ostream& os, vtkIndent indent)
@@ -36,6 +36,11 @@
 // averaging them at shared points. When sharp edges are present, the edges
 // are split and new points generated to prevent blurry edges (due to
 // Gouraud shading).
+//
+// The polygon normals, the splitting of the points on sharp edges and the
+// averaging at the points are computed with vtkSMPTools. The consistent
+// reordering of the polygons propagates from polygon to polygon and stays
+// serial.
 
 // .SECTION Caveats
 // Normals are computed only for polygons and triangle strips. Normals are
@@ -53,6 +58,7 @@
 class vtkFloatArray;
 class vtkIdList;
 class vtkPolyData;
+class vtkStaticCellLinks;
 
 class VTKFILTERSCORE_EXPORT vtkPolyDataNormals : public vtkPolyDataAlgorithm
 {
@@ -159,6 +165,7 @@ private:
   vtkIdList *CellIds;
   vtkIdList *Map;
   vtkPolyData *OldMesh;
+  vtkStaticCellLinks *OldLinks;
   vtkPolyData *NewMesh;
   int *Visited;
   vtkFloatArray *PolyNormals;
@@ -168,10 +175,16 @@ private:
   // checked and properly ordered polygons.
   void TraverseAndOrder(void);
 
-  // Check the point id give to see whether it lies on a feature
-  // edge. If so, split the point (i.e., duplicate it) to topologically
-  // separate the mesh.
-  void MarkAndSplit(vtkIdType ptId);
+  // Label the cells using the point ptId with the regions they form when
+  // the mesh is cut along the feature edges through ptId: one label per
+  // cell, in the order of the links of ptId. Returns the number of
+  // regions; the point is split (i.e., duplicated) when there are several.
+  // Only reads the meshes, so several points can be labeled at once.
+  int MarkRegions(vtkIdType ptId, int *regions, vtkIdList *cellIds);
+
+  //BTX
+  friend class vtkPolyDataNormalsMarkRegions;
+  //ETX
 
 private:
   vtkPolyDataNormals(const vtkPolyDataNormals&);  // Not implemented.
@@ -14,9 +14,11 @@
 =========================================================================*/
 #include "vtkProbeFilter.h"
 
+#include "vtkAbstractCellLocator.h"
 #include "vtkCell.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
+#include "vtkGenericCell.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -24,11 +26,23 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPointSet.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStructuredGrid.h"
+#include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <vector>
 
 vtkStandardNewMacro(vtkProbeFilter);
+vtkCxxSetObjectMacro(vtkProbeFilter, CellLocatorPrototype, vtkAbstractCellLocator);
 
 class vtkProbeFilter::vtkVectorOfArrays :
   public std::vector<vtkDataArray*>
@@ -57,6 +71,7 @@ vtkProbeFilter::vtkProbeFilter()
   this->PassFieldArrays = 1;
   this->Tolerance = 1.0;
   this->ComputeTolerance = 1;
+  this->CellLocatorPrototype = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -74,6 +89,7 @@ vtkProbeFilter::~vtkProbeFilter()
 
   delete this->PointList;
   delete this->CellList;
+  this->SetCellLocatorPrototype(NULL);
 }
 
 //----------------------------------------------------------------------------
@@ -266,6 +282,305 @@ void vtkProbeFilter::Probe(vtkDataSet *input, vtkDataSet *source,
   this->DoProbing(input, 0, source, output);
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Arrays whose tuples may be read, or written at distinct presized ids, from
+// several threads.
+bool AreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(i));
+    if (!array || array->GetDataType() == VTK_BIT ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// The data sets whose FindCell() and GetCell() with a vtkGenericCell keep
+// all their scratch in the cell.
+bool HasThreadSafeCells(vtkDataSet *source)
+{
+  return vtkImageData::SafeDownCast(source) ||
+    vtkRectilinearGrid::SafeDownCast(source) ||
+    vtkStructuredGrid::SafeDownCast(source) ||
+    vtkPolyData::SafeDownCast(source) ||
+    vtkUnstructuredGrid::SafeDownCast(source);
+}
+
+// The sources above, and the locators whose FindCell() is thread safe.
+bool CanProbeInParallel(vtkDataSet *input, vtkDataSet *source,
+                        vtkAbstractCellLocator *locator, vtkPointData *outPD)
+{
+  // The input points are read from several threads.
+  vtkPointSet *inputPointSet = vtkPointSet::SafeDownCast(input);
+  if (inputPointSet)
+    {
+    if (!inputPointSet->GetPoints() ||
+        !inputPointSet->GetPoints()->GetData()->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  else if (!vtkRectilinearGrid::SafeDownCast(input))
+    {
+    return false;
+    }
+
+  if (locator)
+    {
+    if (!vtkStaticCellLocator::SafeDownCast(locator))
+      {
+      return false;
+      }
+    }
+  else if (!HasThreadSafeCells(source))
+    {
+    return false;
+    }
+
+  return AreArraysThreadSafe(outPD) &&
+    AreArraysThreadSafe(source->GetPointData()) &&
+    AreArraysThreadSafe(source->GetCellData());
+}
+
+// Spreads the 10 low bits of v to every third bit.
+unsigned int SpreadBits(unsigned int v)
+{
+  v &= 0x3ff;
+  v = (v | (v << 16)) & 0x030000ff;
+  v = (v | (v << 8)) & 0x0300f00f;
+  v = (v | (v << 4)) & 0x030c30c3;
+  v = (v | (v << 2)) & 0x09249249;
+  return v;
+}
+
+// Computes the Morton code of the points on a 1024^3 grid over the bounds.
+class MortonCodes
+{
+public:
+  vtkPointSet *Input;
+  double Origin[3];
+  double Scale[3];
+  unsigned int *Codes;
+  vtkIdType *Ids;
+
+  void operator()(vtkIdType ptId, vtkIdType end)
+    {
+    double x[3];
+    unsigned int ijk[3];
+    for ( ; ptId < end; ++ptId)
+      {
+      this->Input->GetPoint(ptId, x);
+      for (int i = 0; i < 3; ++i)
+        {
+        double t = (x[i] - this->Origin[i]) * this->Scale[i];
+        ijk[i] = static_cast<unsigned int>(t < 0.0 ? 0.0 :
+                                           (t > 1023.0 ? 1023.0 : t));
+        }
+      this->Codes[ptId] = SpreadBits(ijk[0]) | (SpreadBits(ijk[1]) << 1) |
+        (SpreadBits(ijk[2]) << 2);
+      this->Ids[ptId] = ptId;
+      }
+    }
+};
+
+// Orders the points of a point set along a Morton (Z-order) curve, so that
+// the points probed one after the other, and those probed by a thread, are
+// close to each other and find their cells in the same parts of the source.
+void SortPointsSpatially(vtkPointSet *input, std::vector<vtkIdType> &order)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  order.resize(numPts);
+  if (numPts == 0)
+    {
+    return;
+    }
+  double bounds[6];
+  input->GetBounds(bounds);
+  std::vector<unsigned int> codes(numPts);
+  MortonCodes morton;
+  morton.Input = input;
+  for (int i = 0; i < 3; ++i)
+    {
+    double length = bounds[2*i+1] - bounds[2*i];
+    morton.Origin[i] = bounds[2*i];
+    morton.Scale[i] = (length > 0.0 ? 1024.0 / length : 0.0);
+    }
+  morton.Codes = &codes[0];
+  morton.Ids = &order[0];
+  vtkSMPTools::For(0, numPts, morton);
+  vtkSMPTools::RadixSort(&codes[0], &codes[0] + numPts, &order[0]);
+}
+
+// Probe the points of a range, in the given order (if any). Hits are
+// flagged, rather than appended to the valid points, so that the points
+// stay in order.
+class ProbePoints
+{
+public:
+  vtkDataSet *Input;
+  const vtkIdType *Order;
+  vtkDataSet *Source;
+  vtkAbstractCellLocator *Locator;
+  vtkDataSetAttributes::FieldList *PointList;
+  int SrcIdx;
+  vtkPointData *OutPD;
+  const std::vector<vtkDataArray*> &InCellArrays;
+  const std::vector<vtkDataArray*> &OutCellArrays;
+  const char *Mask;
+  char *Hits;
+  double Tol2;
+  int MaxCellSize;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double> > Weights;
+
+  ProbePoints(vtkDataSet *input, const vtkIdType *order, vtkDataSet *source,
+              vtkAbstractCellLocator *locator,
+              vtkDataSetAttributes::FieldList *pointList, int srcIdx,
+              vtkPointData *outPD,
+              const std::vector<vtkDataArray*> &inCellArrays,
+              const std::vector<vtkDataArray*> &outCellArrays,
+              const char *mask, char *hits, double tol2) :
+    Input(input), Order(order), Source(source), Locator(locator), PointList(pointList),
+    SrcIdx(srcIdx), OutPD(outPD), InCellArrays(inCellArrays),
+    OutCellArrays(outCellArrays), Mask(mask), Hits(hits), Tol2(tol2)
+    {
+      this->MaxCellSize = std::max(source->GetMaxCellSize(), 1);
+    }
+
+  void Initialize()
+    {
+    this->Weights.Local().resize(this->MaxCellSize);
+    }
+
+  void operator()(vtkIdType i, vtkIdType end)
+    {
+    vtkGenericCell *cell = this->Cell.Local();
+    double *weights = &this->Weights.Local()[0];
+    vtkPointData *pd = this->Source->GetPointData();
+    double x[3], pcoords[3], closestPoint[3], dist2;
+    int subId;
+
+    for ( ; i < end; ++i)
+      {
+      vtkIdType ptId = (this->Order ? this->Order[i] : i);
+      if (this->Mask[ptId] == static_cast<char>(1))
+        {
+        continue;
+        }
+
+      this->Input->GetPoint(ptId, x);
+      vtkIdType cellId;
+      if (this->Locator)
+        {
+        cellId = this->Locator->FindCell(x, this->Tol2, cell, pcoords,
+                                         weights);
+        }
+      else
+        {
+        cellId = this->Source->FindCell(x, NULL, cell, -1, this->Tol2,
+                                        subId, pcoords, weights);
+        if (cellId >= 0)
+          {
+          this->Source->GetCell(cellId, cell);
+          }
+        }
+      if (cellId < 0)
+        {
+        continue;
+        }
+
+      // See ProbeEmptyPoints() for this check against the cell size.
+      cell->EvaluatePosition(x, closestPoint, subId, pcoords, dist2, weights);
+      if (dist2 > cell->GetLength2() * 0.01)
+        {
+        continue;
+        }
+
+      this->OutPD->InterpolatePoint(*this->PointList, pd, this->SrcIdx, ptId,
+                                    cell->PointIds, weights);
+      for (size_t i = 0; i < this->InCellArrays.size(); ++i)
+        {
+        if (this->InCellArrays[i])
+          {
+          this->OutPD->CopyTuple(this->InCellArrays[i],
+                                 this->OutCellArrays[i], cellId, ptId);
+          }
+        }
+      this->Hits[ptId] = 1;
+      }
+    }
+
+  void Reduce()
+    {
+    }
+};
+}
+
+//----------------------------------------------------------------------------
+void vtkProbeFilter::ProbeEmptyPointsInParallel(vtkDataSet *input,
+  int srcIdx, vtkDataSet *source, vtkAbstractCellLocator *locator,
+  double tol2, vtkDataSet *output)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData *outPD = output->GetPointData();
+  char* maskArray = this->MaskPoints->GetPointer(0);
+
+  // The lazily built structures of the source are built here, and the output
+  // arrays sized, so that the threads only read the source and write the
+  // tuples of their own points.
+  if (!locator)
+    {
+    source->BuildFindCellStructures();
+    }
+  outPD->SetNumberOfTuples(numPts);
+
+  std::vector<vtkDataArray*> inCellArrays;
+  vtkCellData *cd = source->GetCellData();
+  vtkVectorOfArrays::iterator iter;
+  for (iter = this->CellArrays->begin(); iter != this->CellArrays->end();
+    ++iter)
+    {
+    inCellArrays.push_back(cd->GetArray((*iter)->GetName()));
+    }
+
+  // Point sets are probed along a space filling curve. The points of
+  // structured inputs are already in a coherent order.
+  std::vector<vtkIdType> order;
+  vtkPointSet *inputPointSet = vtkPointSet::SafeDownCast(input);
+  if (inputPointSet && !vtkStructuredGrid::SafeDownCast(input))
+    {
+    SortPointsSpatially(inputPointSet, order);
+    }
+
+  std::vector<char> hits(numPts, 0);
+  ProbePoints probe(input, order.empty() ? NULL : &order[0], source, locator, this->PointList, srcIdx, outPD,
+                    inCellArrays, *this->CellArrays, maskArray,
+                    hits.empty() ? NULL : &hits[0], tol2);
+  vtkSMPTools::For(0, numPts, probe);
+  this->UpdateProgress(0.9);
+
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+    if (hits[ptId])
+      {
+      this->ValidPoints->InsertNextValue(ptId);
+      this->NumberOfValidPoints++;
+      maskArray[ptId] = static_cast<char>(1);
+      }
+    else if (maskArray[ptId] != static_cast<char>(1) && this->UseNullPoint)
+      {
+      outPD->NullPoint(ptId);
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
   int srcIdx,
@@ -333,6 +648,34 @@ void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
     tol2 = this->Tolerance * this->Tolerance;
     }
 
+  // Use a locator built from the prototype if one is given, rather than the
+  // data set's own FindCell().
+  vtkAbstractCellLocator *locator = NULL;
+  vtkGenericCell *gcell = NULL;
+  if (this->CellLocatorPrototype)
+    {
+    locator = this->CellLocatorPrototype->NewInstance();
+    locator->SetDataSet(source);
+    locator->BuildLocator();
+    gcell = vtkGenericCell::New();
+    }
+
+  if (CanProbeInParallel(input, source, locator, outPD))
+    {
+    this->ProbeEmptyPointsInParallel(input, srcIdx, source, locator, tol2,
+                                     output);
+    if (locator)
+      {
+      locator->Delete();
+      gcell->Delete();
+      }
+    if (mcs>256)
+      {
+      delete [] weights;
+      }
+    return;
+    }
+
   // Loop over all input points, interpolating source data
   //
   int abort=0;
@@ -356,10 +699,25 @@ void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
     input->GetPoint(ptId, x);
 
     // Find the cell that contains xyz and get it
-    vtkIdType cellId = source->FindCell(x,NULL,-1,tol2,subId,pcoords,weights);
+    vtkIdType cellId;
+    if (locator)
+      {
+      cellId = locator->FindCell(x,tol2,gcell,pcoords,weights);
+      }
+    else
+      {
+      cellId = source->FindCell(x,NULL,-1,tol2,subId,pcoords,weights);
+      }
     if (cellId >= 0)
       {
-      cell = source->GetCell(cellId);
+      if (locator)
+        {
+        cell = gcell;
+        }
+      else
+        {
+        cell = source->GetCell(cellId);
+        }
       // If we found a cell, let's make sure that the point is within
       // a certain size of the cell when it is slightly outside.
       // The tolerance check above is based on the bounds of the whole
@@ -409,6 +767,11 @@ void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
       }
     }
 
+  if (locator)
+    {
+    locator->Delete();
+    gcell->Delete();
+    }
   if (mcs>256)
     {
     delete [] weights;
@@ -441,6 +804,15 @@ static void GetPointIdsInRange(double rangeMin, double rangeMax, double start,
 void vtkProbeFilter::ProbePointsImageData(vtkImageData *input,
   int srcIdx, vtkDataSet *source, vtkImageData *output)
 {
+  if (HasThreadSafeCells(source) &&
+      AreArraysThreadSafe(output->GetPointData()) &&
+      AreArraysThreadSafe(source->GetPointData()) &&
+      AreArraysThreadSafe(source->GetCellData()))
+    {
+    this->ProbePointsImageDataInParallel(input, srcIdx, source, output);
+    return;
+    }
+
   double pcoords[3], *weights;
   double fastweights[256];
   std::vector<double> dynamicweights;
@@ -582,6 +954,268 @@ void vtkProbeFilter::ProbePointsImageData(vtkImageData *input,
     }
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Finds the range of grid points along each axis within the bounds of each
+// cell of the source.
+class RasterizeCellBounds
+{
+public:
+  vtkDataSet *Source;
+  double Start[3];
+  double Spacing[3];
+  int Dimensions[3];
+  int *IdxBounds;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  void operator()(vtkIdType cellId, vtkIdType end)
+    {
+    vtkGenericCell *cell = this->Cell.Local();
+    double cellBounds[6];
+    for ( ; cellId < end; ++cellId)
+      {
+      this->Source->GetCell(cellId, cell);
+      cell->GetBounds(cellBounds);
+      int *idxBounds = this->IdxBounds + 6 * cellId;
+      for (int i = 0; i < 3; ++i)
+        {
+        GetPointIdsInRange(cellBounds[2*i], cellBounds[2*i+1], this->Start[i],
+          this->Spacing[i], this->Dimensions[i], idxBounds[2*i],
+          idxBounds[2*i+1]);
+        }
+      }
+    }
+};
+
+// Probes the grid points of slabs, one index thick along the slab axis,
+// with the cells whose bounds cover each slab. The cells are visited in
+// increasing order of ids, so that a point inside several cells gets the
+// values of the last one, as with the serial loop over the cells.
+class ProbeSlabs
+{
+public:
+  vtkDataSet *Source;
+  vtkDataSetAttributes::FieldList *PointList;
+  int SrcIdx;
+  vtkPointData *OutPD;
+  const std::vector<vtkDataArray*> *InCellArrays;
+  const std::vector<vtkDataArray*> *OutCellArrays;
+  char *Mask;
+  double Start[3];
+  double Spacing[3];
+  int Dimensions[3];
+  int Axis;
+  const int *IdxBounds;
+  const vtkIdType *SlabOffsets;
+  const vtkIdType *SlabCells;
+  int MaxCellSize;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double> > Weights;
+
+  void Initialize()
+    {
+    this->Weights.Local().resize(this->MaxCellSize);
+    }
+
+  void operator()(vtkIdType slab, vtkIdType end)
+    {
+    vtkGenericCell *cell = this->Cell.Local();
+    double *weights = &this->Weights.Local()[0];
+    vtkPointData *pd = this->Source->GetPointData();
+    const int *dim = this->Dimensions;
+    double p[3], pcoords[3], closestPoint[3], dist2;
+    int subId, range[6];
+
+    for ( ; slab < end; ++slab)
+      {
+      for (vtkIdType c = this->SlabOffsets[slab];
+           c < this->SlabOffsets[slab+1]; ++c)
+        {
+        vtkIdType cellId = this->SlabCells[c];
+        this->Source->GetCell(cellId, cell);
+        std::copy(this->IdxBounds + 6 * cellId,
+                  this->IdxBounds + 6 * cellId + 6, range);
+        range[2*this->Axis] = range[2*this->Axis+1] = static_cast<int>(slab);
+
+        int numCellPts = cell->GetNumberOfPoints();
+        for (int iz = range[4]; iz <= range[5]; iz++)
+          {
+          p[2] = this->Start[2] + iz * this->Spacing[2];
+          for (int iy = range[2]; iy <= range[3]; iy++)
+            {
+            p[1] = this->Start[1] + iy * this->Spacing[1];
+            for (int ix = range[0]; ix <= range[1]; ix++)
+              {
+              p[0] = this->Start[0] + ix * this->Spacing[0];
+
+              // The same inside test as ProbePointsImageData().
+              int inside = cell->EvaluatePosition(p, closestPoint, subId,
+                                                  pcoords, dist2, weights);
+              for (int k = 0; k < numCellPts && inside; k++)
+                {
+                if (weights[k] < 0)
+                  {
+                  inside = 0;
+                  }
+                }
+              if (!inside || dist2 != 0)
+                {
+                continue;
+                }
+
+              vtkIdType ptId = ix + dim[0] *
+                (iy + static_cast<vtkIdType>(dim[1]) * iz);
+              this->OutPD->InterpolatePoint(*this->PointList, pd,
+                                            this->SrcIdx, ptId,
+                                            cell->PointIds, weights);
+              for (size_t i = 0; i < this->InCellArrays->size(); ++i)
+                {
+                if ((*this->InCellArrays)[i])
+                  {
+                  this->OutPD->CopyTuple((*this->InCellArrays)[i],
+                                         (*this->OutCellArrays)[i],
+                                         cellId, ptId);
+                  }
+                }
+              this->Mask[ptId] = static_cast<char>(1);
+              }
+            }
+          }
+        }
+      }
+    }
+
+  void Reduce()
+    {
+    }
+};
+}
+
+//----------------------------------------------------------------------------
+void vtkProbeFilter::ProbePointsImageDataInParallel(vtkImageData *input,
+  int srcIdx, vtkDataSet *source, vtkImageData *output)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData *outPD = output->GetPointData();
+  char* maskArray = this->MaskPoints->GetPointer(0);
+
+  double spacing[3];
+  input->GetSpacing(spacing);
+  int extent[6];
+  input->GetExtent(extent);
+  int dim[3];
+  input->GetDimensions(dim);
+  double start[3];
+  input->GetOrigin(start);
+  start[0] += static_cast<double>(extent[0]) * spacing[0];
+  start[1] += static_cast<double>(extent[2]) * spacing[1];
+  start[2] += static_cast<double>(extent[4]) * spacing[2];
+
+  // The lazily built cells of the source are built here, and the output
+  // arrays sized, so that the threads only read the source and write the
+  // tuples of their own points.
+  source->BuildFindCellStructures();
+  outPD->SetNumberOfTuples(numPts);
+
+  std::vector<vtkDataArray*> inCellArrays;
+  vtkCellData *cd = source->GetCellData();
+  vtkVectorOfArrays::iterator iter;
+  for (iter = this->CellArrays->begin(); iter != this->CellArrays->end();
+    ++iter)
+    {
+    inCellArrays.push_back(cd->GetArray((*iter)->GetName()));
+    }
+
+  // Rasterize the bounds of the cells in index space.
+  vtkIdType numSrcCells = source->GetNumberOfCells();
+  std::vector<int> idxBounds(6 * numSrcCells);
+  RasterizeCellBounds rasterize;
+  rasterize.Source = source;
+  std::copy(start, start + 3, rasterize.Start);
+  std::copy(spacing, spacing + 3, rasterize.Spacing);
+  std::copy(dim, dim + 3, rasterize.Dimensions);
+  rasterize.IdxBounds = idxBounds.empty() ? NULL : &idxBounds[0];
+  vtkSMPTools::For(0, numSrcCells, rasterize);
+  this->UpdateProgress(0.2);
+
+  // Slice the grid across its longest axis and list, for each slab, the
+  // cells covering it in increasing order of ids.
+  int axis = 0;
+  for (int i = 1; i < 3; ++i)
+    {
+    if (dim[i] > dim[axis])
+      {
+      axis = i;
+      }
+    }
+  std::vector<vtkIdType> slabOffsets(dim[axis] + 1, 0);
+  vtkIdType cellId;
+  for (cellId = 0; cellId < numSrcCells; ++cellId)
+    {
+    int *bounds = &idxBounds[6 * cellId];
+    if (bounds[1] < bounds[0] || bounds[3] < bounds[2] ||
+        bounds[5] < bounds[4])
+      {
+      bounds[2*axis+1] = bounds[2*axis] - 1;
+      continue;
+      }
+    for (int slab = bounds[2*axis]; slab <= bounds[2*axis+1]; ++slab)
+      {
+      ++slabOffsets[slab + 1];
+      }
+    }
+  for (int slab = 0; slab < dim[axis]; ++slab)
+    {
+    slabOffsets[slab + 1] += slabOffsets[slab];
+    }
+  std::vector<vtkIdType> slabCells(slabOffsets[dim[axis]]);
+  std::vector<vtkIdType> slabEnds(slabOffsets.begin(), slabOffsets.end() - 1);
+  for (cellId = 0; cellId < numSrcCells; ++cellId)
+    {
+    const int *bounds = &idxBounds[6 * cellId];
+    for (int slab = bounds[2*axis]; slab <= bounds[2*axis+1]; ++slab)
+      {
+      slabCells[slabEnds[slab]++] = cellId;
+      }
+    }
+
+  ProbeSlabs probe;
+  probe.Source = source;
+  probe.PointList = this->PointList;
+  probe.SrcIdx = srcIdx;
+  probe.OutPD = outPD;
+  probe.InCellArrays = &inCellArrays;
+  probe.OutCellArrays = this->CellArrays;
+  probe.Mask = maskArray;
+  std::copy(start, start + 3, probe.Start);
+  std::copy(spacing, spacing + 3, probe.Spacing);
+  std::copy(dim, dim + 3, probe.Dimensions);
+  probe.Axis = axis;
+  probe.IdxBounds = rasterize.IdxBounds;
+  probe.SlabOffsets = &slabOffsets[0];
+  probe.SlabCells = slabCells.empty() ? NULL : &slabCells[0];
+  probe.MaxCellSize = std::max(source->GetMaxCellSize(), 1);
+  vtkSMPTools::For(0, dim[axis], 1, probe);
+  this->UpdateProgress(0.9);
+
+  // populate ValidPoints
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    if (maskArray[i])
+      {
+      this->ValidPoints->InsertNextValue(i);
+      this->NumberOfValidPoints++;
+      }
+    else if (this->UseNullPoint)
+      {
+      outPD->NullPoint(i);
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkProbeFilter::RequestInformation(
   vtkInformation *vtkNotUsed(request),
@@ -739,4 +1373,6 @@ void vtkProbeFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ValidPoints: " << this->ValidPoints << "\n";
   os << indent << "PassFieldArrays: "
      << (this->PassFieldArrays? "On" : " Off") << "\n";
+  os << indent << "CellLocatorPrototype: " << this->CellLocatorPrototype
+     << "\n";
 }
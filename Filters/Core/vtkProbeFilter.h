@@ -39,6 +39,7 @@
 #include "vtkDataSetAlgorithm.h"
 #include "vtkDataSetAttributes.h" // needed for vtkDataSetAttributes::FieldList
 
+class vtkAbstractCellLocator;
 class vtkIdTypeArray;
 class vtkCharArray;
 class vtkMaskPoints;
@@ -127,6 +128,15 @@ public:
   vtkBooleanMacro(ComputeTolerance, bool);
   vtkGetMacro(ComputeTolerance, bool);
 
+  // Description:
+  // Set/Get the prototype of the cell locator used to find the cells of
+  // the source that contain the probe points. When set, a new instance of
+  // the prototype is built on each source, e.g. a vtkStaticCellLocator
+  // for large unstructured sources. When NULL (the default), the
+  // vtkDataSet::FindCell() of the source is used.
+  virtual void SetCellLocatorPrototype(vtkAbstractCellLocator*);
+  vtkGetObjectMacro(CellLocatorPrototype, vtkAbstractCellLocator);
+
 //BTX
 protected:
   vtkProbeFilter();
@@ -141,6 +151,8 @@ protected:
   double Tolerance;
   bool ComputeTolerance;
 
+  vtkAbstractCellLocator *CellLocatorPrototype;
+
   virtual int RequestData(vtkInformation *, vtkInformationVector **,
     vtkInformationVector *);
   virtual int RequestInformation(vtkInformation *, vtkInformationVector **,
@@ -197,6 +209,17 @@ private:
   // A faster implementation for vtkImageData input.
   void ProbePointsImageData(vtkImageData *input, int srcIdx, vtkDataSet *source,
     vtkImageData *output);
+  // The same as ProbePointsImageData(), with vtkSMPTools, for the sources
+  // whose GetCell() is thread safe. The grid is split in slabs of points
+  // that are probed concurrently, each by the cells covering it.
+  void ProbePointsImageDataInParallel(vtkImageData *input, int srcIdx,
+    vtkDataSet *source, vtkImageData *output);
+  // The same as ProbeEmptyPoints(), with vtkSMPTools, for the sources and
+  // locators whose FindCell() is thread safe. The points of point sets are
+  // probed in the order of a space filling curve.
+  void ProbeEmptyPointsInParallel(vtkDataSet *input, int srcIdx,
+    vtkDataSet *source, vtkAbstractCellLocator *locator, double tol2,
+    vtkDataSet *output);
 
   class vtkVectorOfArrays;
   vtkVectorOfArrays* CellArrays;
@@ -24,10 +24,16 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkTriangle.h"
 #include <vtksys/hash_set.hxx> // keep track of inserted triangles
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkQuadricClustering);
 
 //----------------------------------------------------------------------------
@@ -38,6 +44,226 @@ struct vtkQuadricClusteringIdTypeHash {
 class vtkQuadricClusteringCellSet : public vtksys::hash_set<vtkIdType, vtkQuadricClusteringIdTypeHash> {};
 typedef vtkQuadricClusteringCellSet::iterator vtkQuadricClusteringCellSetIterator;
 
+namespace
+{
+// The nine coefficients of the quadric of a triangle stored in the bins.
+void vtkQuadricClusteringTriangleQuadric(double *pt0, double *pt1,
+                                         double *pt2, double quadric[9])
+{
+  double quadric4x4[4][4];
+  vtkTriangle::ComputeQuadric(pt0, pt1, pt2, quadric4x4);
+  quadric[0] = quadric4x4[0][0];
+  quadric[1] = quadric4x4[0][1];
+  quadric[2] = quadric4x4[0][2];
+  quadric[3] = quadric4x4[0][3];
+  quadric[4] = quadric4x4[1][1];
+  quadric[5] = quadric4x4[1][2];
+  quadric[6] = quadric4x4[1][3];
+  quadric[7] = quadric4x4[2][2];
+  quadric[8] = quadric4x4[2][3];
+}
+
+// A triangle corner, numbered 3 * triangle id + corner, and its bin.
+struct vtkQuadricClusteringCorner
+{
+  vtkIdType Bin;
+  vtkIdType Corner;
+};
+
+// A triangle whose corners lie in three different bins, i.e., a candidate
+// output triangle. Key holds the bins in increasing order.
+struct vtkQuadricClusteringTriangle
+{
+  vtkIdType Bins[3];
+  vtkIdType Key[3];
+  vtkIdType Triangle;
+  vtkIdType Polygon;
+
+  bool operator<(const vtkQuadricClusteringTriangle& other) const
+  {
+    if (this->Key[0] != other.Key[0])
+      {
+      return this->Key[0] < other.Key[0];
+      }
+    if (this->Key[1] != other.Key[1])
+      {
+      return this->Key[1] < other.Key[1];
+      }
+    if (this->Key[2] != other.Key[2])
+      {
+      return this->Key[2] < other.Key[2];
+      }
+    return this->Triangle < other.Triangle;
+  }
+};
+
+bool vtkQuadricClusteringSameBins(const vtkQuadricClusteringTriangle& a,
+                                  const vtkQuadricClusteringTriangle& b)
+{
+  return a.Key[0] == b.Key[0] && a.Key[1] == b.Key[1] && a.Key[2] == b.Key[2];
+}
+
+// Fan triangulation of the polygons shared by the parallel passes: the
+// polygons are accessed through their locations in the cell array, and
+// their triangles are numbered by an exclusive scan of their counts.
+struct vtkQuadricClusteringFans
+{
+  vtkCellArray *Polys;
+  vtkPoints *Points;
+  const vtkIdType *Locations;
+  const vtkIdType *TriangleOffsets; // one more than the number of polygons
+  vtkIdType NumberOfPolygons;
+
+  vtkIdType GetPolygon(vtkIdType triId) const
+  {
+    return static_cast<vtkIdType>(
+      std::upper_bound(this->TriangleOffsets,
+                       this->TriangleOffsets + this->NumberOfPolygons + 1,
+                       triId) - this->TriangleOffsets) - 1;
+  }
+
+  // Same quadric as the serial path computes for triangle triId.
+  void GetQuadric(vtkIdType triId, vtkIdList *cellPoints,
+                  double quadric[9]) const
+  {
+    vtkIdType polyId = this->GetPolygon(triId);
+    vtkIdType j = triId - this->TriangleOffsets[polyId];
+    vtkIdType npts;
+    const vtkIdType *pts;
+    this->Polys->GetCell(this->Locations[polyId], npts, pts, cellPoints);
+    double pt0[3], pt1[3], pt2[3];
+    this->Points->GetPoint(pts[0], pt0);
+    this->Points->GetPoint(pts[j+1], pt1);
+    this->Points->GetPoint(pts[j+2], pt2);
+    vtkQuadricClusteringTriangleQuadric(pt0, pt1, pt2, quadric);
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+// Hashes the corners of the triangles of a range of polygons, and gathers
+// the triangles spanning three bins. The corners of the triangles ignored
+// by UseInternalTriangles get the bin NumberOfBins, which sorts last.
+class vtkQuadricClusteringBinTriangles
+{
+public:
+  vtkQuadricClustering *Self;
+  vtkQuadricClusteringFans Fans;
+  vtkIdType NumberOfBins;
+  vtkQuadricClusteringCorner *Corners;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+  vtkSMPThreadLocal<std::vector<vtkQuadricClusteringTriangle> > Triangles;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellPoints = this->CellPoints.Local();
+    std::vector<vtkQuadricClusteringTriangle>& triangles =
+      this->Triangles.Local();
+    vtkIdType npts;
+    const vtkIdType *pts;
+    double x[3];
+    vtkIdType binIds[3];
+    for (vtkIdType polyId = begin; polyId < end; ++polyId)
+      {
+      this->Fans.Polys->GetCell(this->Fans.Locations[polyId], npts, pts,
+                                cellPoints);
+      if (npts < 3)
+        {
+        continue;
+        }
+      vtkIdType triId = this->Fans.TriangleOffsets[polyId];
+      this->Fans.Points->GetPoint(pts[0], x);
+      binIds[0] = this->Self->HashPoint(x);
+      for (vtkIdType j = 0; j < npts-2; ++j, ++triId)
+        {
+        this->Fans.Points->GetPoint(pts[j+1], x);
+        binIds[1] = this->Self->HashPoint(x);
+        this->Fans.Points->GetPoint(pts[j+2], x);
+        binIds[2] = this->Self->HashPoint(x);
+        bool distinct = binIds[0] != binIds[1] && binIds[0] != binIds[2] &&
+          binIds[1] != binIds[2];
+        bool ignored = !distinct && this->Self->UseInternalTriangles == 0;
+        vtkQuadricClusteringCorner *corners = this->Corners + 3 * triId;
+        for (int i = 0; i < 3; ++i)
+          {
+          corners[i].Bin = ignored ? this->NumberOfBins : binIds[i];
+          corners[i].Corner = 3 * triId + i;
+          }
+        if (distinct)
+          {
+          vtkQuadricClusteringTriangle triangle;
+          for (int i = 0; i < 3; ++i)
+            {
+            triangle.Bins[i] = triangle.Key[i] = binIds[i];
+            }
+          std::sort(triangle.Key, triangle.Key + 3);
+          triangle.Triangle = triId;
+          triangle.Polygon = polyId;
+          triangles.push_back(triangle);
+          }
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Adds the quadrics of the triangles to the bins, given the corners sorted
+// by bin. Each run of corners of a bin is handled by the thread owning its
+// first corner, in the order of the corners, as AddTriangle() would. The
+// first corner of the bins without output vertex yet is recorded so that
+// vertex ids can be given in the serial order.
+class vtkQuadricClusteringAccumulateQuadrics
+{
+public:
+  vtkQuadricClustering *Self;
+  vtkQuadricClusteringFans Fans;
+  vtkIdType NumberOfBins;
+  const vtkQuadricClusteringCorner *Corners;
+  vtkIdType NumberOfCorners;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+  vtkSMPThreadLocal<std::vector<vtkQuadricClusteringCorner> > NewBins;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellPoints = this->CellPoints.Local();
+    std::vector<vtkQuadricClusteringCorner>& newBins = this->NewBins.Local();
+    double quadric[9];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType binId = this->Corners[i].Bin;
+      if (binId == this->NumberOfBins)
+        {
+        break;
+        }
+      if (i > 0 && this->Corners[i-1].Bin == binId)
+        {
+        continue;
+        }
+      vtkQuadricClustering::PointQuadric& bin = this->Self->QuadricArray[binId];
+      if (bin.VertexId == -1)
+        {
+        newBins.push_back(this->Corners[i]);
+        }
+      if (bin.Dimension > 2)
+        {
+        bin.Dimension = 2;
+        this->Self->InitializeQuadric(bin.Quadric);
+        }
+      if (bin.Dimension != 2)
+        { // Points and segments supercede triangles.
+        continue;
+        }
+      for (vtkIdType k = i;
+           k < this->NumberOfCorners && this->Corners[k].Bin == binId; ++k)
+        {
+        this->Fans.GetQuadric(this->Corners[k].Corner / 3, cellPoints,
+                              quadric);
+        this->Self->AddQuadric(binId, quadric);
+        }
+      }
+  }
+};
+
 
 //----------------------------------------------------------------------------
 // Construct with default NumberOfDivisions to 50, DivisionSpacing to 1
@@ -76,6 +302,7 @@ vtkQuadricClustering::vtkQuadricClustering()
   this->PreventDuplicateCells = 1;
   this->CellSet = NULL;
   this->NumberOfBins = 0;
+  this->BinPolygonsInParallel = 1;
 
   this->OutputTriangleArray = NULL;
   this->OutputLines = NULL;
@@ -355,7 +582,11 @@ void vtkQuadricClustering::Append(vtkPolyData *pd)
   this->UpdateProgress(.60);
 
   inputPolys = pd->GetPolys();
-  if (inputPolys)
+  if (inputPolys && this->BinPolygonsInParallel)
+    {
+    this->AddPolygonsInParallel(inputPolys, inputPoints, pd, output);
+    }
+  else if (inputPolys)
     {
     this->AddPolygons(inputPolys, inputPoints, 1, pd, output);
     }
@@ -409,6 +640,140 @@ void vtkQuadricClustering::AddPolygons(vtkCellArray *polys, vtkPoints *points,
     }//for all polygons
 }
 
+//----------------------------------------------------------------------------
+void vtkQuadricClustering::AddPolygonsInParallel(vtkCellArray *polys,
+                                                 vtkPoints *points,
+                                                 vtkPolyData *input,
+                                                 vtkPolyData *output)
+{
+  vtkIdType numPolys = polys->GetNumberOfCells();
+  if (numPolys == 0)
+    {
+    return;
+    }
+
+  // Locate the polygons (the cell array can only be traversed serially)
+  // and number their fan triangles.
+  std::vector<vtkIdType> locations(numPolys);
+  std::vector<vtkIdType> triOffsets(numPolys + 1);
+  vtkIdType npts = 0;
+  vtkIdType *ptIds = 0;
+  polys->InitTraversal();
+  for (vtkIdType polyId = 0; polys->GetNextCell(npts, ptIds); ++polyId)
+    {
+    locations[polyId] = polys->GetTraversalLocation(npts);
+    triOffsets[polyId] = npts > 2 ? npts - 2 : 0;
+    }
+  vtkIdType numTris = vtkSMPTools::ExclusiveScan(
+    triOffsets.begin(), triOffsets.begin() + numPolys, triOffsets.begin(),
+    static_cast<vtkIdType>(0));
+  triOffsets[numPolys] = numTris;
+  if (numTris == 0)
+    {
+    this->InCellCount += numPolys;
+    return;
+    }
+
+  vtkQuadricClusteringFans fans;
+  fans.Polys = polys;
+  fans.Points = points;
+  fans.Locations = &locations[0];
+  fans.TriangleOffsets = &triOffsets[0];
+  fans.NumberOfPolygons = numPolys;
+  vtkIdType numBins = static_cast<vtkIdType>(this->NumberOfDivisions[0]) *
+    this->NumberOfDivisions[1] * this->NumberOfDivisions[2];
+
+  // Hash the triangle corners, then sort them by bin. The sort is stable,
+  // so the corners of a bin remain in the order of the serial traversal.
+  std::vector<vtkQuadricClusteringCorner> corners(3 * numTris);
+  vtkQuadricClusteringBinTriangles binTriangles;
+  binTriangles.Self = this;
+  binTriangles.Fans = fans;
+  binTriangles.NumberOfBins = numBins;
+  binTriangles.Corners = &corners[0];
+  vtkSMPTools::For(0, numPolys, binTriangles);
+  vtkSMPTools::RadixSort(&corners[0], &corners[0] + corners.size(),
+                         &vtkQuadricClusteringCorner::Bin);
+
+  vtkQuadricClusteringAccumulateQuadrics accumulate;
+  accumulate.Self = this;
+  accumulate.Fans = fans;
+  accumulate.NumberOfBins = numBins;
+  accumulate.Corners = &corners[0];
+  accumulate.NumberOfCorners = 3 * numTris;
+  vtkSMPTools::For(0, 3 * numTris, accumulate);
+  this->UpdateProgress(.7);
+
+  // Number the new output vertices in the order of their first corner.
+  std::vector<vtkQuadricClusteringCorner> newBins;
+  vtkSMPThreadLocal<std::vector<vtkQuadricClusteringCorner> >::iterator
+    binsIter = accumulate.NewBins.begin();
+  for (; binsIter != accumulate.NewBins.end(); ++binsIter)
+    {
+    newBins.insert(newBins.end(), binsIter->begin(), binsIter->end());
+    }
+  if (!newBins.empty())
+    {
+    vtkSMPTools::RadixSort(&newBins[0], &newBins[0] + newBins.size(),
+                           &vtkQuadricClusteringCorner::Corner);
+    }
+  for (size_t i = 0; i < newBins.size(); ++i)
+    {
+    this->QuadricArray[newBins[i].Bin].VertexId = this->NumberOfBinsUsed++;
+    }
+  std::vector<vtkQuadricClusteringCorner>().swap(corners);
+
+  // Keep the first of the triangles spanning the same bins, then output
+  // the remaining ones in the serial order. Triangles may still duplicate
+  // the ones of previous Append() calls, hence the check of the cell set.
+  std::vector<vtkQuadricClusteringTriangle> triangles;
+  vtkSMPThreadLocal<std::vector<vtkQuadricClusteringTriangle> >::iterator
+    trisIter = binTriangles.Triangles.begin();
+  for (; trisIter != binTriangles.Triangles.end(); ++trisIter)
+    {
+    triangles.insert(triangles.end(), trisIter->begin(), trisIter->end());
+    }
+  if (this->PreventDuplicateCells)
+    {
+    vtkSMPTools::Sort(triangles.begin(), triangles.end());
+    triangles.erase(std::unique(triangles.begin(), triangles.end(),
+                                vtkQuadricClusteringSameBins),
+                    triangles.end());
+    }
+  if (!triangles.empty())
+    {
+    vtkSMPTools::RadixSort(&triangles[0], &triangles[0] + triangles.size(),
+                           &vtkQuadricClusteringTriangle::Triangle);
+    }
+
+  vtkIdType triPtIds[3];
+  for (size_t i = 0; i < triangles.size(); ++i)
+    {
+    const vtkQuadricClusteringTriangle& triangle = triangles[i];
+    if (this->PreventDuplicateCells)
+      {
+      vtkIdType idx = triangle.Key[0] + this->NumberOfBins*triangle.Key[1] +
+        this->NumberOfBins*this->NumberOfBins*triangle.Key[2];
+      if (this->CellSet->find(idx) != this->CellSet->end())
+        {
+        continue;
+        }
+      this->CellSet->insert(idx);
+      }
+    for (int j = 0; j < 3; ++j)
+      {
+      triPtIds[j] = this->QuadricArray[triangle.Bins[j]].VertexId;
+      }
+    this->OutputTriangleArray->InsertNextCell(3, triPtIds);
+    if (this->CopyCellData && input)
+      {
+      output->GetCellData()->CopyData(input->GetCellData(),
+        this->InCellCount + triangle.Polygon, this->OutCellCount++);
+      }
+    }
+  this->InCellCount += numPolys;
+}
+
 //----------------------------------------------------------------------------
 void vtkQuadricClustering::AddStrips(vtkCellArray *strips, vtkPoints *points,
                                      int geometryFlag,
@@ -481,17 +846,8 @@ void vtkQuadricClustering::AddTriangle(vtkIdType *binIds, double *pt0, double *p
     }
 
   // Compute the quadric.
-  double quadric[9], quadric4x4[4][4];
-  vtkTriangle::ComputeQuadric(pt0, pt1, pt2, quadric4x4);
-  quadric[0] = quadric4x4[0][0];
-  quadric[1] = quadric4x4[0][1];
-  quadric[2] = quadric4x4[0][2];
-  quadric[3] = quadric4x4[0][3];
-  quadric[4] = quadric4x4[1][1];
-  quadric[5] = quadric4x4[1][2];
-  quadric[6] = quadric4x4[1][3];
-  quadric[7] = quadric4x4[2][2];
-  quadric[8] = quadric4x4[2][3];
+  double quadric[9];
+  vtkQuadricClusteringTriangleQuadric(pt0, pt1, pt2, quadric);
 
   // Add the quadric to each of the three corner bins.
   for (int i = 0; i < 3; ++i)
@@ -1580,5 +1936,7 @@ void vtkQuadricClustering::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Prevent Duplicate Cells : "
      << (this->PreventDuplicateCells ? "On\n" : "Off\n");
+  os << indent << "Bin Polygons In Parallel: "
+     << (this->BinPolygonsInParallel ? "On\n" : "Off\n");
 }
 
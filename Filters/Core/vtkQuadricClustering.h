@@ -214,6 +214,16 @@ public:
   vtkGetMacro(PreventDuplicateCells,int);
   vtkBooleanMacro(PreventDuplicateCells,int);
 
+  // Description:
+  // When on (the default), the polygons given to Append() are binned, their
+  // quadrics accumulated and the output triangles deduplicated in parallel
+  // (via vtkSMPTools). The output is identical to the serial one, but about
+  // 100 bytes of temporary memory are used per triangle. Vertices, lines
+  // and triangle strips are always processed serially.
+  vtkSetMacro(BinPolygonsInParallel,int);
+  vtkGetMacro(BinPolygonsInParallel,int);
+  vtkBooleanMacro(BinPolygonsInParallel,int);
+
 protected:
   vtkQuadricClustering();
   ~vtkQuadricClustering();
@@ -240,6 +250,14 @@ protected:
   void AddTriangle(vtkIdType *binIds, double *pt0, double *pt1, double *pt2,
                    int geometeryFlag, vtkPolyData *input, vtkPolyData *output);
 
+  // Description:
+  // Parallel version of AddPolygons() with the geometry flag on. The
+  // triangle corners are sorted by bin so that each bin accumulates its
+  // quadrics in the serial order, and the output triangles are
+  // deduplicated by sorting their bins.
+  void AddPolygonsInParallel(vtkCellArray *polys, vtkPoints *points,
+                             vtkPolyData *input, vtkPolyData *output);
+
   // Description:
   // Add edges to the quadric array.  If geometry flag is on then
   // edges are added to the output.
@@ -298,6 +316,8 @@ protected:
   vtkQuadricClusteringCellSet *CellSet; //PIMPLd stl set for tracking inserted cells
   vtkIdType NumberOfBins;
 
+  int BinPolygonsInParallel;
+
   // Used internally.
   // can be smaller than user values when input numb er of points is small.
   int NumberOfDivisions[3];
@@ -350,6 +370,11 @@ protected:
   int InCellCount;
   int OutCellCount;
 
+  //BTX
+  friend class vtkQuadricClusteringBinTriangles;
+  friend class vtkQuadricClusteringAccumulateQuadrics;
+  //ETX
+
 private:
   vtkQuadricClustering(const vtkQuadricClustering&);  // Not implemented.
   void operator=(const vtkQuadricClustering&);  // Not implemented.
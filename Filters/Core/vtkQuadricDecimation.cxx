@@ -46,6 +46,7 @@
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
+#include "vtkIndexedPriorityQueue.h"
 #include "vtkMath.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -53,8 +54,13 @@
 #include "vtkPolyData.h"
 #include "vtkPointData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkQuadricDecimation);
 
 
@@ -63,6 +69,7 @@ vtkQuadricDecimation::vtkQuadricDecimation()
 {
   this->Edges = vtkEdgeTable::New();
   this->EdgeCosts = vtkPriorityQueue::New();
+  this->IndexedEdgeCosts = NULL;
   this->EndPoint1List = vtkIdList::New();
   this->EndPoint2List = vtkIdList::New();
   this->ErrorQuadrics = NULL;
@@ -85,6 +92,9 @@ vtkQuadricDecimation::vtkQuadricDecimation()
   this->TCoordsWeight = 0.1;
   this->TensorsWeight = 0.1;
 
+  this->UseIndexedPriorityQueue = 0;
+  this->ComputeQuadricsInParallel = 0;
+
   this->ActualReduction = 0.0;
 }
 
@@ -93,6 +103,10 @@ vtkQuadricDecimation::~vtkQuadricDecimation()
 {
   this->Edges->Delete();
   this->EdgeCosts->Delete();
+  if (this->IndexedEdgeCosts)
+    {
+    this->IndexedEdgeCosts->Delete();
+    }
   this->EndPoint1List->Delete();
   this->EndPoint2List->Delete();
   this->TargetPoints->Delete();
@@ -241,7 +255,22 @@ int vtkQuadricDecimation::RequestData(
 
   vtkDebugMacro(<<"Computing Edges");
   this->Edges->InitEdgeInsertion(numPts, 1); // storing edge id as attribute
-  this->EdgeCosts->Allocate(this->Mesh->GetPolys()->GetNumberOfCells() * 3);
+  if (this->UseIndexedPriorityQueue)
+    {
+    if (!this->IndexedEdgeCosts)
+      {
+      this->IndexedEdgeCosts = vtkIndexedPriorityQueue::New();
+      }
+    this->IndexedEdgeCosts->Allocate(
+      this->Mesh->GetPolys()->GetNumberOfCells() * 3);
+    }
+  else
+    {
+    this->EdgeCosts->Allocate(this->Mesh->GetPolys()->GetNumberOfCells() * 3);
+    }
+  // Most edges are shared by two triangles.
+  this->EndPoint1List->Allocate(this->Mesh->GetNumberOfCells() * 3 / 2 + 1);
+  this->EndPoint2List->Allocate(this->Mesh->GetNumberOfCells() * 3 / 2 + 1);
   for (i = 0; i <  this->Mesh->GetNumberOfCells(); i++)
     {
     this->Mesh->GetCellPoints(i, npts, pts);
@@ -270,6 +299,7 @@ int vtkQuadricDecimation::RequestData(
     }
   x = new double [3+this->NumberOfComponents];
   this->CollapseCellIds = vtkIdList::New();
+  this->ChangedEdges = vtkIdList::New();
   this->TempX = new double [3+this->NumberOfComponents];
   this->TempQuad = new double[11 + 4 * this->NumberOfComponents];
 
@@ -299,7 +329,7 @@ int vtkQuadricDecimation::RequestData(
       {
       cost = this->ComputeCost(i, x);
       }
-    this->EdgeCosts->Insert(cost, i);
+    this->InsertEdgeCost(cost, i);
     this->TargetPoints->InsertTuple(i, x);
     }
   this->UpdateProgress(0.20);
@@ -307,7 +337,7 @@ int vtkQuadricDecimation::RequestData(
   // Okay collapse edges until desired reduction is reached
   this->ActualReduction = 0.0;
   this->NumberOfEdgeCollapses = 0;
-  edgeId = this->EdgeCosts->Pop(0,cost);
+  edgeId = this->PopEdgeCost(cost);
 
   int abort = 0;
   while ( !abort && edgeId >= 0 && cost < VTK_DOUBLE_MAX &&
@@ -330,9 +360,9 @@ int vtkQuadricDecimation::RequestData(
       vtkDebugMacro(<<"Poor placement detected " << edgeId << " " <<  cost);
       // return the point to the queue but with the max cost so that
       // when it is recomputed it will be reconsidered
-      this->EdgeCosts->Insert(VTK_DOUBLE_MAX, edgeId);
+      this->InsertEdgeCost(VTK_DOUBLE_MAX, edgeId);
 
-      edgeId = this->EdgeCosts->Pop(0, cost);
+      edgeId = this->PopEdgeCost(cost);
       continue;
       }
 
@@ -351,7 +381,7 @@ int vtkQuadricDecimation::RequestData(
     // Update the output triangles.
     numDeletedTris += this->CollapseEdge(endPtIds[0], endPtIds[1]);
     this->ActualReduction = (double) numDeletedTris / numTris;
-    edgeId = this->EdgeCosts->Pop(0, cost);
+    edgeId = this->PopEdgeCost(cost);
     }
 
   vtkDebugMacro(<<"Number Of Edge Collapses: "
@@ -365,6 +395,7 @@ int vtkQuadricDecimation::RequestData(
   delete [] this->ErrorQuadrics;
   delete [] x;
   this->CollapseCellIds->Delete();
+  this->ChangedEdges->Delete();
   delete [] this->TempX;
   delete [] this->TempQuad;
   delete [] this->TempB;
@@ -406,14 +437,11 @@ int vtkQuadricDecimation::RequestData(
 }
 
 //----------------------------------------------------------------------------
-void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
+int vtkQuadricDecimation::ComputeTriangleQuadric(const vtkIdType *pts,
+                                                 double *QEM, double &weight)
 {
   vtkPolyData *input = this->Mesh;
-  double *QEM;
-  vtkIdType ptId;
-  int i, j;
-  vtkCellArray *polys;
-  vtkIdType npts, *pts=NULL;
+  int i;
   double point0[3], point1[3], point2[3];
   double n[3];
   double tempP1[3], tempP2[3],  d, triArea2;
@@ -425,6 +453,136 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
   A[2] = data+8;
   A[3] = data+12;
 
+  input->GetPoint(pts[0], point0);
+  input->GetPoint(pts[1], point1);
+  input->GetPoint(pts[2], point2);
+  for (i = 0; i < 3; i++)
+    {
+    tempP1[i] = point1[i] - point0[i];
+    tempP2[i] = point2[i] - point0[i];
+    }
+  vtkMath::Cross(tempP1, tempP2, n);
+  triArea2 = vtkMath::Normalize(n);
+  //triArea2 = (triArea2 * triArea2 * 0.25);
+  triArea2 = triArea2 * 0.5;
+  // I am unsure whether this should be squared or not??
+  d = -vtkMath::Dot(n, point0);
+  // could possible add in angle weights??
+
+  // set the geometric part of the QEM
+  QEM[0] = n[0] * n[0];
+  QEM[1] = n[0] * n[1];
+  QEM[2] = n[0] * n[2];
+  QEM[3] = d * n[0];
+
+  QEM[4] = n[1] * n[1];
+  QEM[5] = n[1] * n[2];
+  QEM[6] = d * n[1];
+
+  QEM[7] = n[2] * n[2];
+  QEM[8] = d * n[2];
+
+  QEM[9] = d * d;
+  QEM[10] = 1;
+
+  if (this->AttributeErrorMetric)
+    {
+    for (i = 0; i < 3; i++)
+      {
+      A[0][i] = point0[i];
+      A[1][i] = point1[i];
+      A[2][i] = point2[i];
+      A[3][i] = n[i];
+      }
+    A[0][3] =  A[1][3] = A[2][3] = 1;
+    A[3][3] = 0;
+
+    // should handle poorly condition matrix better
+    if (vtkMath::LUFactorLinearSystem(A, index, 4))
+      {
+      for (i = 0; i < this->NumberOfComponents; i++)
+        {
+        x[3] = 0;
+        if (i < this->AttributeComponents[0])
+          {
+          x[0] = input->GetPointData()->GetScalars()->GetComponent(pts[0], i) *  this->AttributeScale[0];
+          x[1] = input->GetPointData()->GetScalars()->GetComponent(pts[1], i) *  this->AttributeScale[0];
+          x[2] = input->GetPointData()->GetScalars()->GetComponent(pts[2], i) *  this->AttributeScale[0];
+          }
+        else if (i < this->AttributeComponents[1])
+          {
+          x[0] = input->GetPointData()->GetVectors()->GetComponent(pts[0], i - this->AttributeComponents[0]) *  this->AttributeScale[1];
+          x[1] = input->GetPointData()->GetVectors()->GetComponent(pts[1], i - this->AttributeComponents[0]) *  this->AttributeScale[1];
+          x[2] = input->GetPointData()->GetVectors()->GetComponent(pts[2], i - this->AttributeComponents[0]) *  this->AttributeScale[1];
+          }
+        else if (i < this->AttributeComponents[2])
+          {
+          x[0] = input->GetPointData()->GetNormals()->GetComponent(pts[0], i - this->AttributeComponents[1]) *  this->AttributeScale[2];
+          x[1] = input->GetPointData()->GetNormals()->GetComponent(pts[1], i - this->AttributeComponents[1]) *  this->AttributeScale[2];
+          x[2] = input->GetPointData()->GetNormals()->GetComponent(pts[2], i - this->AttributeComponents[1]) *  this->AttributeScale[2];
+          }
+        else if (i < this->AttributeComponents[3])
+          {
+          x[0] = input->GetPointData()->GetTCoords()->GetComponent(pts[0], i - this->AttributeComponents[2]) *  this->AttributeScale[3];
+          x[1] = input->GetPointData()->GetTCoords()->GetComponent(pts[1], i - this->AttributeComponents[2])*  this->AttributeScale[3];
+          x[2] = input->GetPointData()->GetTCoords()->GetComponent(pts[2], i - this->AttributeComponents[2])*  this->AttributeScale[3];
+          }
+        else if (i < this->AttributeComponents[4])
+          {
+          x[0] = input->GetPointData()->GetTensors()->GetComponent(pts[0], i - this->AttributeComponents[3])*  this->AttributeScale[4];
+          x[1] = input->GetPointData()->GetTensors()->GetComponent(pts[1], i - this->AttributeComponents[3])*  this->AttributeScale[4];
+          x[2] = input->GetPointData()->GetTensors()->GetComponent(pts[2], i - this->AttributeComponents[3])*  this->AttributeScale[4];
+          }
+        vtkMath::LUSolveLinearSystem(A, index, x, 4);
+
+        // add in the contribution of this element into the QEM
+        QEM[0] += x[0] * x[0];
+        QEM[1] += x[0] * x[1];
+        QEM[2] += x[0] * x[2];
+        QEM[3] += x[3] * x[0];
+
+        QEM[4] += x[1] * x[1];
+        QEM[5] += x[1] * x[2];
+        QEM[6] += x[3] * x[1];
+
+        QEM[7] += x[2] * x[2];
+        QEM[8] += x[3] * x[2];
+
+        QEM[9] += x[3] * x[3];
+
+        QEM[11+i*4] = -x[0];
+        QEM[12+i*4] = -x[1];
+        QEM[13+i*4] = -x[2];
+        QEM[14+i*4] = -x[3];
+        }
+      }
+    else
+      {
+      weight = triArea2;
+      return 0;
+      }
+    }
+
+  weight = triArea2;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
+{
+  double *QEM;
+  vtkIdType ptId;
+  int i, j;
+  vtkCellArray *polys;
+  vtkIdType npts, *pts=NULL;
+  double triArea2;
+
+  if (this->ComputeQuadricsInParallel)
+    {
+    this->InitializeQuadricsInParallel(numPts);
+    return;
+    }
+
   // allocate local QEM sparce matrix
   QEM = new double[11 + 4 * this->NumberOfComponents];
 
@@ -439,132 +597,152 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
       }
     }
 
-  polys = input->GetPolys();
+  polys = this->Mesh->GetPolys();
   // compute the QEM for each face
   for (polys->InitTraversal(); polys->GetNextCell(npts, pts); )
     {
-    input->GetPoint(pts[0], point0);
-    input->GetPoint(pts[1], point1);
-    input->GetPoint(pts[2], point2);
-    for (i = 0; i < 3; i++)
+    if (!this->ComputeTriangleQuadric(pts, QEM, triArea2))
       {
-      tempP1[i] = point1[i] - point0[i];
-      tempP2[i] = point2[i] - point0[i];
+      vtkErrorMacro(<<"Unable to factor attribute matrix!");
       }
-    vtkMath::Cross(tempP1, tempP2, n);
-    triArea2 = vtkMath::Normalize(n);
-    //triArea2 = (triArea2 * triArea2 * 0.25);
-    triArea2 = triArea2 * 0.5;
-    // I am unsure whether this should be squared or not??
-    d = -vtkMath::Dot(n, point0);
-    // could possible add in angle weights??
-
-    // set the geometric part of the QEM
-    QEM[0] = n[0] * n[0];
-    QEM[1] = n[0] * n[1];
-    QEM[2] = n[0] * n[2];
-    QEM[3] = d * n[0];
-
-    QEM[4] = n[1] * n[1];
-    QEM[5] = n[1] * n[2];
-    QEM[6] = d * n[1];
-
-    QEM[7] = n[2] * n[2];
-    QEM[8] = d * n[2];
-
-    QEM[9] = d * d;
-    QEM[10] = 1;
 
-    if (this->AttributeErrorMetric)
+    // add the QEM to all point of the face
+    for (i = 0; i < 3; i++)
       {
-      for (i = 0; i < 3; i++)
+      for (j = 0; j < 11 + 4 * this->NumberOfComponents; j++)
         {
-        A[0][i] = point0[i];
-        A[1][i] = point1[i];
-        A[2][i] = point2[i];
-        A[3][i] = n[i];
+        this->ErrorQuadrics[pts[i]].Quadric[j] += QEM[j] * triArea2;
         }
-      A[0][3] =  A[1][3] = A[2][3] = 1;
-      A[3][3] = 0;
-
-      // should handle poorly condition matrix better
-      if (vtkMath::LUFactorLinearSystem(A, index, 4))
-        {
-        for (i = 0; i < this->NumberOfComponents; i++)
-          {
-          x[3] = 0;
-          if (i < this->AttributeComponents[0])
-            {
-            x[0] = input->GetPointData()->GetScalars()->GetComponent(pts[0], i) *  this->AttributeScale[0];
-            x[1] = input->GetPointData()->GetScalars()->GetComponent(pts[1], i) *  this->AttributeScale[0];
-            x[2] = input->GetPointData()->GetScalars()->GetComponent(pts[2], i) *  this->AttributeScale[0];
-            }
-          else if (i < this->AttributeComponents[1])
-            {
-            x[0] = input->GetPointData()->GetVectors()->GetComponent(pts[0], i - this->AttributeComponents[0]) *  this->AttributeScale[1];
-            x[1] = input->GetPointData()->GetVectors()->GetComponent(pts[1], i - this->AttributeComponents[0]) *  this->AttributeScale[1];
-            x[2] = input->GetPointData()->GetVectors()->GetComponent(pts[2], i - this->AttributeComponents[0]) *  this->AttributeScale[1];
-            }
-          else if (i < this->AttributeComponents[2])
-            {
-            x[0] = input->GetPointData()->GetNormals()->GetComponent(pts[0], i - this->AttributeComponents[1]) *  this->AttributeScale[2];
-            x[1] = input->GetPointData()->GetNormals()->GetComponent(pts[1], i - this->AttributeComponents[1]) *  this->AttributeScale[2];
-            x[2] = input->GetPointData()->GetNormals()->GetComponent(pts[2], i - this->AttributeComponents[1]) *  this->AttributeScale[2];
-            }
-          else if (i < this->AttributeComponents[3])
-            {
-            x[0] = input->GetPointData()->GetTCoords()->GetComponent(pts[0], i - this->AttributeComponents[2]) *  this->AttributeScale[3];
-            x[1] = input->GetPointData()->GetTCoords()->GetComponent(pts[1], i - this->AttributeComponents[2])*  this->AttributeScale[3];
-            x[2] = input->GetPointData()->GetTCoords()->GetComponent(pts[2], i - this->AttributeComponents[2])*  this->AttributeScale[3];
-            }
-          else if (i < this->AttributeComponents[4])
-            {
-            x[0] = input->GetPointData()->GetTensors()->GetComponent(pts[0], i - this->AttributeComponents[3])*  this->AttributeScale[4];
-            x[1] = input->GetPointData()->GetTensors()->GetComponent(pts[1], i - this->AttributeComponents[3])*  this->AttributeScale[4];
-            x[2] = input->GetPointData()->GetTensors()->GetComponent(pts[2], i - this->AttributeComponents[3])*  this->AttributeScale[4];
-            }
-          vtkMath::LUSolveLinearSystem(A, index, x, 4);
-
-          // add in the contribution of this element into the QEM
-          QEM[0] += x[0] * x[0];
-          QEM[1] += x[0] * x[1];
-          QEM[2] += x[0] * x[2];
-          QEM[3] += x[3] * x[0];
+      }
+    }//for all triangles
 
-          QEM[4] += x[1] * x[1];
-          QEM[5] += x[1] * x[2];
-          QEM[6] += x[3] * x[1];
+  delete [] QEM;
+}
 
-          QEM[7] += x[2] * x[2];
-          QEM[8] += x[3] * x[2];
+//----------------------------------------------------------------------------
+// Computes the weighted quadric of each triangle into Quadrics, and counts
+// the triangles whose attribute matrix could not be factored.
+class vtkQuadricDecimationTriangleQuadrics
+{
+public:
+  vtkQuadricDecimation *Self;
+  double *Quadrics;
+  int Size;
+  vtkSMPThreadLocal<std::vector<double> > QEM;
+  vtkSMPThreadLocal<vtkIdType> NumberOfFailures;
+
+  vtkQuadricDecimationTriangleQuadrics(vtkQuadricDecimation *self,
+                                       double *quadrics, int size)
+    : Self(self), Quadrics(quadrics), Size(size)
+  {
+  }
 
-          QEM[9] += x[3] * x[3];
+  void Initialize()
+  {
+    this->QEM.Local().assign(this->Size, 0.0);
+    this->NumberOfFailures.Local() = 0;
+  }
 
-          QEM[11+i*4] = -x[0];
-          QEM[12+i*4] = -x[1];
-          QEM[13+i*4] = -x[2];
-          QEM[14+i*4] = -x[3];
-          }
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkPolyData *mesh = this->Self->Mesh;
+    double *QEM = &this->QEM.Local()[0];
+    vtkIdType& numberOfFailures = this->NumberOfFailures.Local();
+    vtkIdType npts, *pts;
+    double weight;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      mesh->GetCellPoints(cellId, npts, pts);
+      if (!this->Self->ComputeTriangleQuadric(pts, QEM, weight))
+        {
+        // The serial traversal keeps the attribute terms of the previous
+        // triangle here, which is not defined across threads.
+        std::fill(QEM + 11, QEM + this->Size, 0.0);
+        ++numberOfFailures;
         }
-      else
+      double *quadric = this->Quadrics + cellId * this->Size;
+      for (int j = 0; j < this->Size; ++j)
         {
-        vtkErrorMacro(<<"Unable to factor attribute matrix!");
+        quadric[j] = QEM[j] * weight;
         }
       }
+  }
 
-      // add the QEM to all point of the face
-    for (i = 0; i < 3; i++)
+  void Reduce()
+  {
+  }
+};
+
+namespace
+{
+// Sums the quadrics of the triangles using each point, in increasing order
+// of triangle like the serial traversal, so that the sums are the same.
+class vtkQuadricDecimationPointQuadrics
+{
+public:
+  vtkPolyData *Mesh;
+  const double *Quadrics;
+  int Size;
+  double **PointQuadrics;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    unsigned short ncells;
+    vtkIdType *cells;
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
       {
-      for (j = 0; j < 11 + 4 * this->NumberOfComponents; j++)
+      double *quadric = this->PointQuadrics[ptId];
+      std::fill(quadric, quadric + this->Size, 0.0);
+      this->Mesh->GetPointCells(ptId, ncells, cells);
+      for (unsigned short i = 0; i < ncells; ++i)
         {
-        this->ErrorQuadrics[pts[i]].Quadric[j] += QEM[j] * triArea2;
+        const double *triangle = this->Quadrics + cells[i] * this->Size;
+        for (int j = 0; j < this->Size; ++j)
+          {
+          quadric[j] += triangle[j];
+          }
         }
       }
-    }//for all triangles
-
-  delete [] QEM;
+  }
+};
 }
 
+//----------------------------------------------------------------------------
+void vtkQuadricDecimation::InitializeQuadricsInParallel(vtkIdType numPts)
+{
+  int size = 11 + 4 * this->NumberOfComponents;
+  vtkIdType numTris = this->Mesh->GetNumberOfCells();
+  std::vector<double> quadrics(numTris * size);
+
+  vtkQuadricDecimationTriangleQuadrics triangleQuadrics(
+    this, quadrics.empty() ? NULL : &quadrics[0], size);
+  vtkSMPTools::For(0, numTris, triangleQuadrics);
+  vtkIdType numFailures = 0;
+  for (vtkSMPThreadLocal<vtkIdType>::iterator iter =
+         triangleQuadrics.NumberOfFailures.begin();
+       iter != triangleQuadrics.NumberOfFailures.end(); ++iter)
+    {
+    numFailures += *iter;
+    }
+  if (numFailures > 0)
+    {
+    vtkErrorMacro(<<"Unable to factor attribute matrix of " << numFailures
+                  << " triangles!");
+    }
+
+  std::vector<double*> pointQuadrics(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+    {
+    pointQuadrics[ptId] = this->ErrorQuadrics[ptId].Quadric =
+      new double[size];
+    }
+  vtkQuadricDecimationPointQuadrics sum;
+  sum.Mesh = this->Mesh;
+  sum.Quadrics = triangleQuadrics.Quadrics;
+  sum.Size = size;
+  sum.PointQuadrics = pointQuadrics.empty() ? NULL : &pointQuadrics[0];
+  vtkSMPTools::For(0, numPts, sum);
+}
 
 void vtkQuadricDecimation::AddBoundaryConstraints(void)
 {
@@ -702,10 +880,30 @@ void vtkQuadricDecimation::FindAffectedEdges(vtkIdType p1Id, vtkIdType p2Id,
     }
 }
 
-// FIXME: memory allocation clean up
+//----------------------------------------------------------------------------
+void vtkQuadricDecimation::InsertEdgeCost(double cost, vtkIdType edgeId)
+{
+  if (this->UseIndexedPriorityQueue)
+    {
+    this->IndexedEdgeCosts->Insert(cost, edgeId);
+    }
+  else
+    {
+    this->EdgeCosts->Insert(cost, edgeId);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkQuadricDecimation::PopEdgeCost(double &cost)
+{
+  return this->UseIndexedPriorityQueue ?
+    this->IndexedEdgeCosts->Pop(cost) : this->EdgeCosts->Pop(0, cost);
+}
+
+//----------------------------------------------------------------------------
 void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 {
-  vtkIdList *changedEdges = vtkIdList::New();
+  vtkIdList *changedEdges = this->ChangedEdges;
   vtkIdType i, edgeId, edge[2];
   double cost;
 
@@ -723,7 +921,14 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 
     // Remove all affected edges from the priority queue.
     // This does not include collapsed edge.
-    this->EdgeCosts->DeleteId(changedEdges->GetId(i));
+    if (this->UseIndexedPriorityQueue)
+      {
+      this->IndexedEdgeCosts->DeleteId(changedEdges->GetId(i));
+      }
+    else
+      {
+      this->EdgeCosts->DeleteId(changedEdges->GetId(i));
+      }
 
     // Determine the new set of edges
     if (edge[0] == pt1Id)
@@ -743,7 +948,7 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
           {
           cost = this->ComputeCost(edgeId, this->TempX);
           }
-        this->EdgeCosts->Insert(cost, edgeId);
+        this->InsertEdgeCost(cost, edgeId);
         this->TargetPoints->InsertTuple(edgeId, this->TempX);
         }
       }
@@ -764,7 +969,7 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
           {
           cost = this->ComputeCost(edgeId, this->TempX);
           }
-        this->EdgeCosts->Insert(cost, edgeId);
+        this->InsertEdgeCost(cost, edgeId);
         this->TargetPoints->InsertTuple(edgeId, this->TempX);
         }
       }
@@ -778,13 +983,10 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
         {
         cost = this->ComputeCost(changedEdges->GetId(i), this->TempX);
         }
-      this->EdgeCosts->Insert(cost, changedEdges->GetId(i));
+      this->InsertEdgeCost(cost, changedEdges->GetId(i));
       this->TargetPoints->InsertTuple(changedEdges->GetId(i), this->TempX);
       }
     }
-
-  changedEdges->Delete();
-  return;
 }
 
 //----------------------------------------------------------------------------
@@ -1373,4 +1575,9 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Normals Weight: " << this->NormalsWeight << "\n";
   os << indent << "TCoords Weight: " << this->TCoordsWeight << "\n";
   os << indent << "Tensors Weight: " << this->TensorsWeight << "\n";
+
+  os << indent << "Use Indexed Priority Queue: "
+     << (this->UseIndexedPriorityQueue ? "On\n" : "Off\n");
+  os << indent << "Compute Quadrics In Parallel: "
+     << (this->ComputeQuadricsInParallel ? "On\n" : "Off\n");
 }
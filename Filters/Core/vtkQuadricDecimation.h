@@ -58,6 +58,7 @@
 
 class vtkEdgeTable;
 class vtkIdList;
+class vtkIndexedPriorityQueue;
 class vtkPointData;
 class vtkPriorityQueue;
 class vtkDoubleArray;
@@ -125,6 +126,24 @@ public:
   // filter has executed.
   vtkGetMacro(ActualReduction, double);
 
+  // Description:
+  // Order the edges with a vtkIndexedPriorityQueue rather than a
+  // vtkPriorityQueue. This is much faster on large meshes, but edges of
+  // equal cost are collapsed in a different order, so the output may
+  // differ. Off by default.
+  vtkSetMacro(UseIndexedPriorityQueue, int);
+  vtkGetMacro(UseIndexedPriorityQueue, int);
+  vtkBooleanMacro(UseIndexedPriorityQueue, int);
+
+  // Description:
+  // Compute the initial quadrics of the triangles in parallel with
+  // vtkSMPTools. The quadric of each point is then summed in the same order
+  // as in serial, so the output is the same. This needs temporary storage
+  // for the quadric of every triangle, hence it is off by default.
+  vtkSetMacro(ComputeQuadricsInParallel, int);
+  vtkGetMacro(ComputeQuadricsInParallel, int);
+  vtkBooleanMacro(ComputeQuadricsInParallel, int);
+
 protected:
   vtkQuadricDecimation();
   ~vtkQuadricDecimation();
@@ -139,6 +158,14 @@ protected:
   // Description:
   // Compute quadric for all vertices
   void InitializeQuadrics(vtkIdType numPts);
+  void InitializeQuadricsInParallel(vtkIdType numPts);
+
+  // Description:
+  // Compute the quadric of the triangle pts into QEM, and its weight (half
+  // its area). Return 0 if the attribute part of the quadric could not be
+  // computed.
+  int ComputeTriangleQuadric(const vtkIdType *pts, double *QEM,
+                             double &weight);
 
   // Description:
   // Free boundary edges are weighted
@@ -175,6 +202,11 @@ protected:
   void ComputeNumberOfComponents(void);
   void UpdateEdgeData(vtkIdType ptoId, vtkIdType pt1Id);
 
+  // Description:
+  // Access the edge queue, whichever its kind.
+  void InsertEdgeCost(double cost, vtkIdType edgeId);
+  vtkIdType PopEdgeCost(double &cost);
+
   // Description:
   // Helper function to set and get the point and it's attributes as an array
   void SetPointAttributeArray(vtkIdType ptId, const double *x);
@@ -201,11 +233,15 @@ protected:
   double TCoordsWeight;
   double TensorsWeight;
 
+  int UseIndexedPriorityQueue;
+  int ComputeQuadricsInParallel;
+
   int               NumberOfEdgeCollapses;
   vtkEdgeTable     *Edges;
   vtkIdList        *EndPoint1List;
   vtkIdList        *EndPoint2List;
   vtkPriorityQueue *EdgeCosts;
+  vtkIndexedPriorityQueue *IndexedEdgeCosts;
   vtkDoubleArray   *TargetPoints;
   int               NumberOfComponents;
   vtkPolyData      *Mesh;
@@ -223,12 +259,17 @@ protected:
 
   // Temporary variables for performance
   vtkIdList *CollapseCellIds;
+  vtkIdList *ChangedEdges;
   double *TempX;
   double *TempQuad;
   double *TempB;
   double **TempA;
   double *TempData;
 
+  //BTX
+  friend class vtkQuadricDecimationTriangleQuadrics;
+  //ETX
+
 private:
   vtkQuadricDecimation(const vtkQuadricDecimation&);  // Not implemented.
   void operator=(const vtkQuadricDecimation&);  // Not implemented.
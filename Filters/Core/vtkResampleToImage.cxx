@@ -14,8 +14,8 @@
 =========================================================================*/
 #include "vtkResampleToImage.h"
 
+#include "vtkAbstractCellLocator.h"
 #include "vtkCharArray.h"
-#include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -23,6 +23,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkProbeFilter.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
 
@@ -30,6 +31,8 @@
 
 
 vtkObjectFactoryNewMacro(vtkResampleToImage);
+vtkCxxSetObjectMacro(vtkResampleToImage, CellLocatorPrototype,
+                     vtkAbstractCellLocator);
 
 //----------------------------------------------------------------------------
 vtkResampleToImage::vtkResampleToImage()
@@ -42,11 +45,13 @@ vtkResampleToImage::vtkResampleToImage()
   this->SamplingBounds[1] = this->SamplingBounds[3] = this->SamplingBounds[5] = 1;
   this->SamplingDimensions[0] = this->SamplingDimensions[1] =
   this->SamplingDimensions[2] = 10;
+  this->CellLocatorPrototype = NULL;
 }
 
 //----------------------------------------------------------------------------
 vtkResampleToImage::~vtkResampleToImage()
 {
+  this->SetCellLocatorPrototype(NULL);
 }
 
 //----------------------------------------------------------------------------
@@ -131,6 +136,76 @@ int vtkResampleToImage::FillOutputPortInformation(int vtkNotUsed(port),
   return 1;
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Hides the points that were not probed.
+class BlankPoints
+{
+public:
+  const char *Mask;
+  unsigned char *PointGhosts;
+
+  void operator()(vtkIdType ptId, vtkIdType end)
+    {
+    for ( ; ptId < end; ++ptId)
+      {
+      if (!this->Mask[ptId])
+        {
+        this->PointGhosts[ptId] |= vtkDataSetAttributes::HIDDENPOINT;
+        }
+      }
+    }
+};
+
+// Hides the cells using a point that was not probed. The points of a cell
+// are found from its structured coordinates, so that each cell is only
+// written by one thread.
+class BlankCells
+{
+public:
+  const char *Mask;
+  unsigned char *CellGhosts;
+  int Dimensions[3];
+
+  void operator()(vtkIdType cellId, vtkIdType end)
+    {
+    const int *dim = this->Dimensions;
+    vtkIdType cellDims[3];
+    int steps[3];
+    for (int i = 0; i < 3; ++i)
+      {
+      cellDims[i] = (dim[i] > 1 ? dim[i] - 1 : 1);
+      steps[i] = (dim[i] > 1 ? 1 : 0);
+      }
+    vtkIdType sliceSize = static_cast<vtkIdType>(dim[0]) * dim[1];
+
+    for ( ; cellId < end; ++cellId)
+      {
+      vtkIdType i = cellId % cellDims[0];
+      vtkIdType j = (cellId / cellDims[0]) % cellDims[1];
+      vtkIdType k = cellId / (cellDims[0] * cellDims[1]);
+      vtkIdType ptId = i + j * dim[0] + k * sliceSize;
+      bool hidden = false;
+      for (int dk = 0; dk <= steps[2] && !hidden; ++dk)
+        {
+        for (int dj = 0; dj <= steps[1] && !hidden; ++dj)
+          {
+          for (int di = 0; di <= steps[0] && !hidden; ++di)
+            {
+            hidden = !this->Mask[ptId + di + dj * dim[0] + dk * sliceSize];
+            }
+          }
+        }
+      if (hidden)
+        {
+        this->CellGhosts[cellId] |= vtkDataSetAttributes::HIDDENPOINT;
+        }
+      }
+    }
+};
+}
+
 //----------------------------------------------------------------------------
 void vtkResampleToImage::SetBlankPointsAndCells(vtkImageData *data,
                                                 const char *maskArrayName)
@@ -145,27 +220,23 @@ void vtkResampleToImage::SetBlankPointsAndCells(vtkImageData *data,
   vtkCharArray *maskArray = vtkCharArray::SafeDownCast(pd->GetArray(maskArrayName));
   char *mask = maskArray->GetPointer(0);
 
-  vtkNew<vtkIdList> pointCells;
-  pointCells->Allocate(8);
-
   vtkIdType numPoints = data->GetNumberOfPoints();
-  for (vtkIdType i = 0; i < numPoints; ++i)
+  vtkIdType numCells = data->GetNumberOfCells();
+  if (numPoints < 1)
     {
-    if (!mask[i])
-      {
-      pointGhostArray->SetValue(i, pointGhostArray->GetValue(i) |
-                                   vtkDataSetAttributes::HIDDENPOINT);
-
-      data->GetPointCells(i, pointCells.GetPointer());
-      vtkIdType numCells = pointCells->GetNumberOfIds();
-      for (vtkIdType j = 0; j < numCells; ++j)
-        {
-        vtkIdType cellId = pointCells->GetId(j);
-        cellGhostArray->SetValue(cellId, cellGhostArray->GetValue(cellId) |
-                                         vtkDataSetAttributes::HIDDENPOINT);
-        }
-      }
+    return;
     }
+
+  BlankPoints blankPoints;
+  blankPoints.Mask = mask;
+  blankPoints.PointGhosts = pointGhostArray->GetPointer(0);
+  vtkSMPTools::For(0, numPoints, blankPoints);
+
+  BlankCells blankCells;
+  blankCells.Mask = mask;
+  blankCells.CellGhosts = cellGhostArray->GetPointer(0);
+  data->GetDimensions(blankCells.Dimensions);
+  vtkSMPTools::For(0, numCells, blankCells);
 }
 
 //----------------------------------------------------------------------------
@@ -218,6 +289,7 @@ int vtkResampleToImage::RequestData(vtkInformation *vtkNotUsed(request),
   vtkNew<vtkProbeFilter> prober;
   prober->SetInputData(structure.GetPointer());
   prober->SetSourceData(input);
+  prober->SetCellLocatorPrototype(this->CellLocatorPrototype);
   prober->Update();
 
   const char *maskArrayName = prober->GetValidPointMaskArrayName();
@@ -243,4 +315,6 @@ void vtkResampleToImage::PrintSelf(ostream& os, vtkIndent indent)
      << this->SamplingDimensions[0] << " x "
      << this->SamplingDimensions[1] << " x "
      << this->SamplingDimensions[2] << endl;
+  os << indent << "CellLocatorPrototype " << this->CellLocatorPrototype
+     << endl;
 }
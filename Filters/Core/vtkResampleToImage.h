@@ -16,6 +16,9 @@
 // .SECTION Description
 // vtkPResampleToImage is a filter that resamples the input dataset on
 // a uniform grid. It internally uses vtkProbeFilter to do the probing.
+// As the sampling points form a grid, the probe visits the cells of the
+// input and samples the grid points within their bounds, in parallel with
+// vtkSMPTools for the data sets whose cells can be read concurrently.
 // .SECTION See Also
 // vtkProbeFilter
 
@@ -25,6 +28,7 @@
 #include "vtkAlgorithm.h"
 #include "vtkFiltersCoreModule.h" // For export macro
 
+class vtkAbstractCellLocator;
 class vtkDataSet;
 class vtkImageData;
 
@@ -54,6 +58,13 @@ public:
   vtkSetVector3Macro(SamplingDimensions, int);
   vtkGetVector3Macro(SamplingDimensions, int);
 
+  // Description:
+  // Set/Get the prototype of the cell locator used to find the cells of the
+  // input that contain the sampling points, see
+  // vtkProbeFilter::SetCellLocatorPrototype(). NULL by default.
+  virtual void SetCellLocatorPrototype(vtkAbstractCellLocator*);
+  vtkGetObjectMacro(CellLocatorPrototype, vtkAbstractCellLocator);
+
   // Description:
   // Get the output data for this algorithm.
   vtkImageData* GetOutput();
@@ -80,6 +91,7 @@ protected:
   bool UseInputBounds;
   double SamplingBounds[6];
   int SamplingDimensions[3];
+  vtkAbstractCellLocator *CellLocatorPrototype;
 
 private:
   vtkResampleToImage(const vtkResampleToImage&);  // Not implemented.
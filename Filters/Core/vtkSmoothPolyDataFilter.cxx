@@ -25,10 +25,15 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
 
@@ -129,6 +134,7 @@ vtkSmoothPolyDataFilter::vtkSmoothPolyDataFilter()
   this->GenerateErrorVectors = 0;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->SmoothInParallel = 1;
 
   this->SmoothPoints = NULL;
 
@@ -279,6 +285,239 @@ template<typename T> void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
   vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
 }
 
+// Moves the points of one level of the schedule of
+// vtkSPDF_MovePointsInParallel. Previous holds the coordinates at the start
+// of the iteration and Current the coordinates once moved. A point reads its
+// lower neighbors from Current and the others from Previous, which is what
+// the in-place sweep of vtkSPDF_MovePoints sees.
+template<typename T> class vtkSPDF_MoveLevel
+{
+public:
+  const vtkIdType *Order;
+  vtkMeshVertexPtr Verts;
+  const T *Previous;
+  T *Current;
+  T Factor;
+  vtkSMPThreadLocal<T> MaxDist;
+
+  vtkSPDF_MoveLevel() : MaxDist(0.0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    T& maxDist = this->MaxDist.Local();
+    for (vtkIdType n = begin; n < end; ++n)
+      {
+      vtkIdType i = this->Order[n];
+      vtkIdList *edges = this->Verts[i].edges;
+      vtkIdType npts = edges->GetNumberOfIds();
+      const vtkIdType *edgeIdPtr = edges->GetPointer(0);
+      T dist, deltaX[3];
+      deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+      for (vtkIdType j = 0; j < npts; ++j)
+        {
+        const T *y = (edgeIdPtr[j] < i ? this->Current : this->Previous) +
+          3 * edgeIdPtr[j];
+        for (unsigned short k = 0; k < 3; ++k)
+          {
+          deltaX[k] += y[k];
+          }
+        }
+
+      const T *x = this->Previous + 3 * i;
+      T *xNew = this->Current + 3 * i;
+      for (unsigned short k = 0; k < 3; ++k)
+        {
+        T coord = x[k];
+        coord += this->Factor * (deltaX[k] / npts - coord);
+        xNew[k] = coord;
+        }
+      if ((dist = vtkMath::Norm(deltaX)) > maxDist)
+        {
+        maxDist = dist;
+        }
+      }
+  }
+};
+
+// Same as vtkSPDF_MovePoints without a source, with the same results. Each
+// point depends on its lower neighbors that move, so points are grouped in
+// levels of points that only depend on points of lower levels, and each
+// level is moved in parallel.
+template<typename T> void vtkSPDF_MovePointsInParallel(
+  vtkSPDF_InternalParams<T>& params)
+{
+  vtkIdType numPts = params.numPts;
+  vtkMeshVertexPtr verts = params.vertexPtr;
+  std::vector<vtkIdType> levels(numPts, -1);
+  vtkIdType numLevels = 0;
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    if (verts[i].type != VTK_FIXED_VERTEX && verts[i].edges != NULL &&
+        verts[i].edges->GetNumberOfIds() > 0)
+      {
+      vtkIdType level = 0;
+      vtkIdType npts = verts[i].edges->GetNumberOfIds();
+      const vtkIdType *edgeIdPtr = verts[i].edges->GetPointer(0);
+      for (vtkIdType j = 0; j < npts; ++j)
+        {
+        if (edgeIdPtr[j] < i && levels[edgeIdPtr[j]] >= level)
+          {
+          level = levels[edgeIdPtr[j]] + 1;
+          }
+        }
+      levels[i] = level;
+      numLevels = std::max(numLevels, level + 1);
+      }
+    }
+
+  // Sort the moving points by level.
+  std::vector<vtkIdType> levelOffsets(numLevels + 1, 0);
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    if (levels[i] >= 0)
+      {
+      ++levelOffsets[levels[i] + 1];
+      }
+    }
+  for (vtkIdType level = 0; level < numLevels; ++level)
+    {
+    levelOffsets[level + 1] += levelOffsets[level];
+    }
+  std::vector<vtkIdType> order(levelOffsets[numLevels] + 1);
+  std::vector<vtkIdType> next(levelOffsets.begin(), levelOffsets.end() - 1);
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    if (levels[i] >= 0)
+      {
+      order[next[levels[i]]++] = i;
+      }
+    }
+
+  T* coords = static_cast<T*>(params.newPts->GetVoidPointer(0));
+  std::vector<T> buffer(coords, coords + 3 * numPts);
+  T* previous = coords;
+  T* current = buffer.empty() ? NULL : &buffer[0];
+
+  int iterationNumber = 0;
+  for (T maxDist = std::numeric_limits<T>::max();
+       maxDist > params.conv && iterationNumber < params.numberOfIterations;
+       ++iterationNumber)
+    {
+    if (iterationNumber && !(iterationNumber % 5))
+      {
+      params.spdf->UpdateProgress(0.5 + 0.5*iterationNumber / params.numberOfIterations);
+      if (params.spdf->GetAbortExecute())
+        {
+        break;
+        }
+      }
+
+    vtkSPDF_MoveLevel<T> move;
+    move.Order = &order[0];
+    move.Verts = verts;
+    move.Previous = previous;
+    move.Current = current;
+    move.Factor = params.factor;
+    for (vtkIdType level = 0; level < numLevels; ++level)
+      {
+      vtkSMPTools::For(levelOffsets[level], levelOffsets[level + 1], move);
+      }
+    maxDist = 0.0;
+    for (typename vtkSMPThreadLocal<T>::iterator iter = move.MaxDist.begin();
+         iter != move.MaxDist.end(); ++iter)
+      {
+      maxDist = std::max(maxDist, *iter);
+      }
+    std::swap(previous, current);
+    }
+
+  if (previous != coords)
+    {
+    std::copy(previous, previous + 3 * numPts, coords);
+    }
+
+  vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
+}
+
+// Classifies the edges of the polygons of Mesh for the topological
+// analysis. For each edge of each cell, in order, Codes holds the kind of
+// vertex the edge makes of its end points, or -1 if the edge was already
+// visited from another cell.
+class vtkSPDF_ClassifyEdges
+{
+public:
+  vtkPolyData *Mesh;
+  vtkPoints *Points;
+  const vtkIdType *Offsets;
+  signed char *Codes;
+  int FeatureEdgeSmoothing;
+  double CosFeatureAngle;
+  vtkSMPThreadLocalObject<vtkIdList> Neighbors;
+
+  void Initialize()
+  {
+    this->Neighbors.Local()->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *neighbors = this->Neighbors.Local();
+    vtkIdType npts, *pts, numNeiPts, *neiPts, nei;
+    double normal[3], neiNormal[3];
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Mesh->GetCellPoints(cellId, npts, pts);
+      signed char *codes = this->Codes + this->Offsets[cellId];
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        this->Mesh->GetCellEdgeNeighbors(cellId, pts[i], pts[(i+1)%npts],
+                                         neighbors);
+        vtkIdType numNei = neighbors->GetNumberOfIds();
+
+        codes[i] = VTK_SIMPLE_VERTEX;
+        if ( numNei == 0 )
+          {
+          codes[i] = VTK_BOUNDARY_EDGE_VERTEX;
+          }
+        else if ( numNei >= 2 )
+          {
+          // check to make sure that this edge hasn't been marked already
+          vtkIdType j;
+          for (j = 0; j < numNei && neighbors->GetId(j) > cellId; ++j)
+            {
+            }
+          if ( j >= numNei )
+            {
+            codes[i] = VTK_FEATURE_EDGE_VERTEX;
+            }
+          }
+        else if ( (nei = neighbors->GetId(0)) > cellId )
+          {
+          if (this->FeatureEdgeSmoothing)
+            {
+            vtkPolygon::ComputeNormal(this->Points,npts,pts,normal);
+            this->Mesh->GetCellPoints(nei,numNeiPts,neiPts);
+            vtkPolygon::ComputeNormal(this->Points,numNeiPts,neiPts,neiNormal);
+
+            if (vtkMath::Dot(normal,neiNormal) <= this->CosFeatureAngle)
+              {
+              codes[i] = VTK_FEATURE_EDGE_VERTEX;
+              }
+            }
+          }
+        else // a visited edge
+          {
+          codes[i] = -1;
+          }
+        }
+      }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
 }// namespace
 
 int vtkSmoothPolyDataFilter::RequestData(
@@ -308,6 +547,7 @@ int vtkSmoothPolyDataFilter::RequestData(
   vtkIdType npts = 0;
   vtkIdType *pts = 0;
   vtkIdType p1, p2;
+  int edge;
   double conv;
   double x1[3], x2[3], x3[3], l1[3], l2[3];
   double CosFeatureAngle; //Cosine of angle between adjacent polys
@@ -427,14 +667,6 @@ int vtkSmoothPolyDataFilter::RequestData(
     { //build cell structure
     vtkCellArray *polys;
     vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    vtkIdType *neiPts;
-    double normal[3], neiNormal[3];
-    vtkIdList *neighbors;
-
-    neighbors = vtkIdList::New();
-    neighbors->Allocate(VTK_CELL_SIZE);
 
     inMesh = vtkPolyData::New();
     inMesh->SetPoints(inPts);
@@ -454,10 +686,38 @@ int vtkSmoothPolyDataFilter::RequestData(
     polys = Mesh->GetPolys();
     this->UpdateProgress(0.375);
 
+    // Look up the neighbors of all the edges first, possibly in parallel.
+    // Marking the vertices depends on the order of the edges and is done
+    // serially below.
+    vtkIdType numMeshCells = polys->GetNumberOfCells();
+    std::vector<vtkIdType> offsets(numMeshCells + 1, 0);
     for (cellId=0, polys->InitTraversal(); polys->GetNextCell(npts,pts);
     cellId++)
       {
-      for (i=0; i < npts; i++)
+      offsets[cellId+1] = offsets[cellId] + npts;
+      }
+    std::vector<signed char> edgeCodes(offsets[numMeshCells] + 1);
+    vtkSPDF_ClassifyEdges classify;
+    classify.Mesh = Mesh;
+    classify.Points = inPts;
+    classify.Offsets = &offsets[0];
+    classify.Codes = &edgeCodes[0];
+    classify.FeatureEdgeSmoothing = this->FeatureEdgeSmoothing;
+    classify.CosFeatureAngle = CosFeatureAngle;
+    if (this->SmoothInParallel)
+      {
+      vtkSMPTools::For(0, numMeshCells, classify);
+      }
+    else
+      {
+      classify.Initialize();
+      classify(0, numMeshCells);
+      }
+    const signed char *code = &edgeCodes[0];
+
+    for (polys->InitTraversal(); polys->GetNextCell(npts,pts); )
+      {
+      for (i=0; i < npts; i++, code++)
         {
         p1 = pts[i];
         p2 = pts[(i+1)%npts];
@@ -473,49 +733,11 @@ int vtkSmoothPolyDataFilter::RequestData(
           Verts[p2].edges->Allocate(16,6);
           }
 
-        Mesh->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
-        numNei = neighbors->GetNumberOfIds();
-
-        edge = VTK_SIMPLE_VERTEX;
-        if ( numNei == 0 )
-          {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-
-        else if ( numNei >= 2 )
-          {
-          // check to make sure that this edge hasn't been marked already
-          for (j=0; j < numNei; j++)
-            {
-            if ( neighbors->GetId(j) < cellId )
-              {
-              break;
-              }
-            }
-          if ( j >= numNei )
-            {
-            edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-
-        else if ( numNei == 1 && (nei=neighbors->GetId(0)) > cellId )
-          {
-          if (this->FeatureEdgeSmoothing)
-            {
-            vtkPolygon::ComputeNormal(inPts,npts,pts,normal);
-            Mesh->GetCellPoints(nei,numNeiPts,neiPts);
-            vtkPolygon::ComputeNormal(inPts,numNeiPts,neiPts,neiNormal);
-
-            if (vtkMath::Dot(normal,neiNormal) <= CosFeatureAngle)
-              {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-              }
-            }
-          }
-        else // a visited edge; skip rest of analysis
+        if ( *code < 0 ) // a visited edge; skip rest of analysis
           {
           continue;
           }
+        edge = *code;
 
         if ( edge && Verts[p1].type == VTK_SIMPLE_VERTEX )
           {
@@ -555,8 +777,6 @@ int vtkSmoothPolyDataFilter::RequestData(
 
     inMesh->Delete();
     if (toTris) {toTris->Delete();}
-
-    neighbors->Delete();
     }//if strips or polys
 
   this->UpdateProgress(0.50);
@@ -686,7 +906,14 @@ int vtkSmoothPolyDataFilter::RequestData(
                                               Verts, source, this->SmoothPoints,
                                               w, cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    if (this->SmoothInParallel && !source)
+      {
+      vtkSPDF_MovePointsInParallel(params);
+      }
+    else
+      {
+      vtkSPDF_MovePoints(params);
+      }
     }
   else
     {
@@ -695,7 +922,14 @@ int vtkSmoothPolyDataFilter::RequestData(
                                              static_cast<float>(conv), numPts, Verts,
                                              source, this->SmoothPoints, w, cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    if (this->SmoothInParallel && !source)
+      {
+      vtkSPDF_MovePointsInParallel(params);
+      }
+    else
+      {
+      vtkSPDF_MovePoints(params);
+      }
     }
 
   if ( source )
@@ -805,4 +1039,5 @@ void vtkSmoothPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
     }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Smooth In Parallel: " << (this->SmoothInParallel ? "On\n" : "Off\n");
 }
@@ -178,6 +178,17 @@ public:
   vtkSetMacro(OutputPointsPrecision,int);
   vtkGetMacro(OutputPointsPrecision,int);
 
+  // Description:
+  // Turn on/off the use of vtkSMPTools to analyze the topology and to
+  // smooth the points. Each iteration moves the points in place, so that a
+  // point sees the new position of its neighbors of lower id; points are
+  // moved in parallel in groups that do not depend on each other, and the
+  // output is the same as in serial. Smoothing constrained by a source is
+  // always serial. On by default.
+  vtkSetMacro(SmoothInParallel,int);
+  vtkGetMacro(SmoothInParallel,int);
+  vtkBooleanMacro(SmoothInParallel,int);
+
 protected:
   vtkSmoothPolyDataFilter();
   ~vtkSmoothPolyDataFilter() {}
@@ -195,6 +206,7 @@ protected:
   int GenerateErrorScalars;
   int GenerateErrorVectors;
   int OutputPointsPrecision;
+  int SmoothInParallel;
 
   vtkSmoothPoints *SmoothPoints;
 private:
@@ -25,6 +25,7 @@ vtkStreamerBase::vtkStreamerBase()
 {
   this->NumberOfPasses = 1;
   this->CurrentIndex = 0;
+  this->RestartRequested = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -63,6 +64,13 @@ int vtkStreamerBase::ProcessRequest(vtkInformation* request,
   return this->Superclass::ProcessRequest(request, inputVector, outputVector);
 }
 
+//-----------------------------------------------------------------------------
+void vtkStreamerBase::RestartStreaming(unsigned int numberOfPasses)
+{
+  this->NumberOfPasses = numberOfPasses > 0 ? numberOfPasses : 1;
+  this->RestartRequested = true;
+}
+
 //-----------------------------------------------------------------------------
 int vtkStreamerBase::RequestData(vtkInformation *request,
                                  vtkInformationVector **inputVector,
@@ -71,10 +79,19 @@ int vtkStreamerBase::RequestData(vtkInformation *request,
   if (!this->ExecutePass(inputVector, outputVector))
     {
     request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
+    this->RestartRequested = false;
     return 0;
     }
 
-  this->CurrentIndex++;
+  if (this->RestartRequested)
+    {
+    this->RestartRequested = false;
+    this->CurrentIndex = 0;
+    }
+  else
+    {
+    this->CurrentIndex++;
+    }
 
   if (  this->CurrentIndex < this->NumberOfPasses )
     {
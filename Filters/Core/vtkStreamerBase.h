@@ -81,8 +81,15 @@ protected:
     return 1;
   }
 
+  // Description:
+  // Called from ExecutePass() to discard the passes done so far and start
+  // streaming again with a new number of passes. The pass just executed
+  // does not count, and CurrentIndex is 0 for the next pass.
+  void RestartStreaming(unsigned int numberOfPasses);
+
   unsigned int NumberOfPasses;
   unsigned int CurrentIndex;
+  bool RestartRequested;
 
 private:
   vtkStreamerBase(const vtkStreamerBase &); // Not implemented.
@@ -24,9 +24,179 @@
 #include "vtkCellData.h"
 #include "vtkPolyData.h"
 #include "vtkIdTypeArray.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkStripper);
 
+namespace
+{
+// Computes the centroid coordinate of the triangles of the mesh along an
+// axis, and marks the other cells with the partition -1.
+class vtkStripperCentroids
+{
+public:
+  vtkPolyData *Mesh;
+  int Axis;
+  double *Keys;
+  int *Partitions;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType npts, *pts;
+    double x[3];
+    vtkPoints *points = this->Mesh->GetPoints();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      if (this->Mesh->GetCellType(cellId) != VTK_TRIANGLE)
+        {
+        this->Partitions[cellId] = -1;
+        continue;
+        }
+      this->Mesh->GetCellPoints(cellId, npts, pts);
+      double key = 0.0;
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        points->GetPoint(pts[i], x);
+        key += x[this->Axis];
+        }
+      this->Keys[cellId] = key / npts;
+      this->Partitions[cellId] = 0;
+      }
+  }
+};
+
+// Assigns the triangles to the slab containing their centroid.
+class vtkStripperPartition
+{
+public:
+  const double *Keys;
+  const std::vector<double> *Thresholds;
+  int *Partitions;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      if (this->Partitions[cellId] >= 0)
+        {
+        this->Partitions[cellId] = static_cast<int>(
+          std::upper_bound(this->Thresholds->begin(), this->Thresholds->end(),
+                           this->Keys[cellId]) - this->Thresholds->begin());
+        }
+      }
+  }
+};
+
+// Grows triangle strips within each partition, marching only across the
+// unvisited triangles of the same partition, as the serial pass does. The
+// triangles without such a neighbor are left unvisited for the serial pass.
+class vtkStripperStripPartitions
+{
+public:
+  vtkPolyData *Mesh;
+  char *Visited;
+  const int *Partitions;
+  const std::vector<vtkIdType> *PartitionOffsets;
+  const std::vector<vtkIdType> *PartitionCells;
+  int MaximumLength;
+  std::vector<std::vector<vtkIdType> > *Strips;
+  std::vector<std::vector<vtkIdType> > *StripCells;
+  std::vector<int> *LongestStrips;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocal<std::vector<vtkIdType> > Points;
+
+  bool IsFree(vtkIdType cellId, int partition)
+  {
+    return this->Partitions[cellId] == partition && !this->Visited[cellId];
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellIds = this->CellIds.Local();
+    std::vector<vtkIdType> &pts = this->Points.Local();
+    pts.resize(this->MaximumLength + 2);
+    vtkIdType numTriPts, *triPts, neighbor = -1;
+    for (vtkIdType p = begin; p < end; ++p)
+      {
+      int partition = static_cast<int>(p);
+      std::vector<vtkIdType> &strips = (*this->Strips)[p];
+      std::vector<vtkIdType> &stripCells = (*this->StripCells)[p];
+      int &longestStrip = (*this->LongestStrips)[p];
+      for (vtkIdType c = (*this->PartitionOffsets)[p];
+           c < (*this->PartitionOffsets)[p+1]; ++c)
+        {
+        vtkIdType cellId = (*this->PartitionCells)[c];
+        if (this->Visited[cellId])
+          {
+          continue;
+          }
+        this->Visited[cellId] = 1;
+        this->Mesh->GetCellPoints(cellId, numTriPts, triPts);
+        int i;
+        for (i = 0; i < 3; ++i)
+          {
+          pts[1] = triPts[i];
+          pts[2] = triPts[(i+1)%3];
+          this->Mesh->GetCellEdgeNeighbors(cellId, pts[1], pts[2], cellIds);
+          if (cellIds->GetNumberOfIds() > 0 &&
+              this->IsFree(neighbor = cellIds->GetId(0), partition))
+            {
+            pts[0] = triPts[(i+2)%3];
+            break;
+            }
+          }
+        if (i >= 3)
+          {
+          this->Visited[cellId] = 0;
+          continue;
+          }
+
+        int numPts = 3;
+        stripCells.push_back(cellId);
+        while (neighbor >= 0)
+          {
+          this->Visited[neighbor] = 1;
+          this->Mesh->GetCellPoints(neighbor, numTriPts, triPts);
+          stripCells.push_back(neighbor);
+          for (i = 0; i < 3; ++i)
+            {
+            if (triPts[i] != pts[numPts-2] && triPts[i] != pts[numPts-1])
+              {
+              break;
+              }
+            }
+          if (i < 3)
+            {
+            pts[numPts] = triPts[i];
+            this->Mesh->GetCellEdgeNeighbors(neighbor, pts[numPts],
+                                             pts[numPts-1], cellIds);
+            numPts++;
+            }
+          if (numPts > longestStrip)
+            {
+            longestStrip = numPts;
+            }
+          if (cellIds->GetNumberOfIds() <= 0 ||
+              !this->IsFree(neighbor = cellIds->GetId(0), partition) ||
+              numPts >= (this->MaximumLength+2))
+            {
+            strips.push_back(numPts);
+            strips.insert(strips.end(), pts.begin(), pts.begin() + numPts);
+            neighbor = -1;
+            }
+          }
+        }
+      }
+  }
+};
+}
+
 // Construct object with MaximumLength set to 1000.
 vtkStripper::vtkStripper()
 {
@@ -35,6 +205,138 @@ vtkStripper::vtkStripper()
   this->PassThroughCellIds = 0;
   this->PassThroughPointIds = 0;
   this->JoinContiguousSegments = 0;
+  this->StripInParallel = 0;
+}
+
+// Split the triangles of the mesh into slabs holding about the same number
+// of triangles along the longest axis of its bounds, and grow strips within
+// the slabs in parallel. The strips are appended in slab order.
+void vtkStripper::StripTrianglesInParallel(vtkPolyData *mesh, char *visited,
+                                           vtkCellArray *newStrips,
+                                           vtkCellData *cd,
+                                           vtkFieldData *newfdStrips,
+                                           vtkIdTypeArray *origStripIds,
+                                           vtkIdType &numStrips,
+                                           int &longestStrip)
+{
+  vtkIdType numCells = mesh->GetNumberOfCells();
+  double bounds[6];
+  mesh->GetBounds(bounds);
+  int axis = 0;
+  for (int i = 1; i < 3; ++i)
+    {
+    if (bounds[2*i+1] - bounds[2*i] > bounds[2*axis+1] - bounds[2*axis])
+      {
+      axis = i;
+      }
+    }
+
+  // Prime the cell structure before the threads read it.
+  vtkIdType npts, *pts;
+  mesh->GetCellPoints(0, npts, pts);
+
+  std::vector<double> keys(numCells);
+  std::vector<int> partitions(numCells);
+  vtkStripperCentroids centroids;
+  centroids.Mesh = mesh;
+  centroids.Axis = axis;
+  centroids.Keys = &keys[0];
+  centroids.Partitions = &partitions[0];
+  vtkSMPTools::For(0, numCells, centroids);
+
+  vtkIdType numTris = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    numTris += (partitions[cellId] >= 0 ? 1 : 0);
+    }
+  vtkIdType numPartitions = std::min(
+    static_cast<vtkIdType>(4 * vtkSMPTools::GetEstimatedNumberOfThreads()),
+    numTris / 1000 + 1);
+  if (numPartitions < 2)
+    {
+    return;
+    }
+
+  // Pick the slab thresholds among a regular sample of the centroids.
+  std::vector<double> samples;
+  vtkIdType stride = numCells / (64 * numPartitions) + 1;
+  for (vtkIdType cellId = 0; cellId < numCells; cellId += stride)
+    {
+    if (partitions[cellId] >= 0)
+      {
+      samples.push_back(keys[cellId]);
+      }
+    }
+  std::sort(samples.begin(), samples.end());
+  std::vector<double> thresholds;
+  for (vtkIdType p = 1; p < numPartitions && !samples.empty(); ++p)
+    {
+    thresholds.push_back(samples[p * samples.size() / numPartitions]);
+    }
+  vtkStripperPartition partition;
+  partition.Keys = &keys[0];
+  partition.Thresholds = &thresholds;
+  partition.Partitions = &partitions[0];
+  vtkSMPTools::For(0, numCells, partition);
+
+  // Bucket the triangles by slab, in increasing cell id order.
+  std::vector<vtkIdType> offsets(numPartitions + 1, 0);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    if (partitions[cellId] >= 0)
+      {
+      offsets[partitions[cellId] + 1]++;
+      }
+    }
+  for (vtkIdType p = 0; p < numPartitions; ++p)
+    {
+    offsets[p+1] += offsets[p];
+    }
+  std::vector<vtkIdType> cells(numTris);
+  std::vector<vtkIdType> next(offsets.begin(), offsets.end() - 1);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    if (partitions[cellId] >= 0)
+      {
+      cells[next[partitions[cellId]]++] = cellId;
+      }
+    }
+
+  std::vector<std::vector<vtkIdType> > strips(numPartitions);
+  std::vector<std::vector<vtkIdType> > stripCells(numPartitions);
+  std::vector<int> longestStrips(numPartitions, 0);
+  vtkStripperStripPartitions stripper;
+  stripper.Mesh = mesh;
+  stripper.Visited = visited;
+  stripper.Partitions = &partitions[0];
+  stripper.PartitionOffsets = &offsets;
+  stripper.PartitionCells = &cells;
+  stripper.MaximumLength = this->MaximumLength;
+  stripper.Strips = &strips;
+  stripper.StripCells = &stripCells;
+  stripper.LongestStrips = &longestStrips;
+  vtkSMPTools::For(0, numPartitions, 1, stripper);
+
+  for (vtkIdType p = 0; p < numPartitions; ++p)
+    {
+    for (size_t i = 0; i < strips[p].size(); i += strips[p][i] + 1)
+      {
+      newStrips->InsertNextCell(strips[p][i], &strips[p][i+1]);
+      numStrips++;
+      }
+    for (size_t i = 0; i < stripCells[p].size(); ++i)
+      {
+      if (newfdStrips)
+        {
+        newfdStrips->InsertNextTuple(stripCells[p][i], cd);
+        }
+      if (origStripIds)
+        {
+        origStripIds->InsertNextValue(stripCells[p][i]);
+        }
+      }
+    longestStrip = std::max(longestStrip, longestStrips[p]);
+    }
 }
 
 int vtkStripper::RequestData(
@@ -227,6 +529,15 @@ int vtkStripper::RequestData(
   longestStrip = 0; numStrips = 0;
   longestLine = 0; numLines = 0;
 
+  // Strip the triangles within spatial partitions first. The serial pass
+  // then strips the remaining triangles across the partition boundaries.
+  if ( this->StripInParallel && inPolys->GetNumberOfCells() > 0 &&
+       vtkSMPTools::GetEstimatedNumberOfThreads() > 1 )
+    {
+    this->StripTrianglesInParallel(mesh, visited, newStrips, cd, newfdStrips,
+                                   origStripIds, numStrips, longestStrip);
+    }
+
   int cellType;
   int abort=0;
   vtkIdType progressInterval=numCells/20 + 1;
@@ -741,4 +1052,5 @@ void vtkStripper::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PassThroughCellIds: " << this->PassThroughCellIds << endl;
   os << indent << "PassThroughPointIds: " << this->PassThroughPointIds << endl;
   os << indent << "JoinContiguousSegments: " << this->JoinContiguousSegments << endl;
+  os << indent << "StripInParallel: " << this->StripInParallel << endl;
 }
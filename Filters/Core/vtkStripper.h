@@ -41,6 +41,11 @@
 //    This is the cell data for the cell formed by (j-2, j-1, j) in
 //    the input.
 // The field data order is same as cell data i.e. (verts,line,polys,tsrips).
+//
+// When StripInParallel is on, the triangles are first split into slabs
+// along the longest axis of the bounds, and strips are grown within each
+// slab in parallel. The triangles left alone in their slab are then
+// stripped together across the slab boundaries by the serial pass.
 
 // .SECTION Caveats
 // If triangle strips or poly-lines exist in the input data they will
@@ -57,6 +62,11 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+class vtkCellArray;
+class vtkCellData;
+class vtkFieldData;
+class vtkIdTypeArray;
+
 class VTKFILTERSCORE_EXPORT vtkStripper : public vtkPolyDataAlgorithm
 {
 public:
@@ -106,6 +116,15 @@ public:
   vtkGetMacro(JoinContiguousSegments,int);
   vtkBooleanMacro(JoinContiguousSegments,int);
 
+  // Description:
+  // If on, the triangle strips are grown in parallel within spatial
+  // partitions of the triangles before the serial pass. The strips differ
+  // from those of the serial pass, and are usually a little shorter. The
+  // default is off.
+  vtkSetMacro(StripInParallel,int);
+  vtkGetMacro(StripInParallel,int);
+  vtkBooleanMacro(StripInParallel,int);
+
 protected:
   vtkStripper();
   ~vtkStripper() {}
@@ -118,6 +137,15 @@ protected:
   int PassThroughCellIds;
   int PassThroughPointIds;
   int JoinContiguousSegments;
+  int StripInParallel;
+
+  // Grow triangle strips in parallel within spatial partitions of the
+  // triangles of mesh, marking their triangles as visited.
+  void StripTrianglesInParallel(vtkPolyData *mesh, char *visited,
+                                vtkCellArray *newStrips, vtkCellData *cd,
+                                vtkFieldData *newfdStrips,
+                                vtkIdTypeArray *origStripIds,
+                                vtkIdType &numStrips, int &longestStrip);
 
 private:
   vtkStripper(const vtkStripper&);  // Not implemented.
@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
+#include "vtkCompositeDataPipeline.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdListCollection.h"
@@ -60,6 +61,10 @@ vtkSynchronizedTemplates3D::vtkSynchronizedTemplates3D()
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
                                vtkDataSetAttributes::SCALARS);
+
+  // The passes only use the information and data objects they are given
+  this->GetInformation()->Set(
+    vtkCompositeDataPipeline::CAN_EXECUTE_BLOCKS_CONCURRENTLY(), 1);
 }
 
 //----------------------------------------------------------------------------
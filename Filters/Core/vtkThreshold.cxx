@@ -14,18 +14,25 @@
 =========================================================================*/
 #include "vtkThreshold.h"
 
-#include "vtkCell.h"
+#include "vtkAttributeRemapCache.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkMath.h"
 
 #include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkThreshold);
 
@@ -47,10 +54,13 @@ vtkThreshold::vtkThreshold()
                                vtkDataSetAttributes::SCALARS);
 
   this->UseContinuousCellRange = 0;
+  this->CacheMesh = 0;
+  this->MeshCache = vtkAttributeRemapCache::New();
 }
 
 vtkThreshold::~vtkThreshold()
 {
+  this->MeshCache->Delete();
 }
 
 // Criterion is cells whose scalars are less or equal to lower threshold.
@@ -90,6 +100,217 @@ void vtkThreshold::ThresholdBetween(double lower, double upper)
     }
 }
 
+// Marks the cells satisfying the threshold criterion with 1 in CellMap and
+// their points with 1 in PointMap. Several threads may store 1 for the same
+// point.
+class vtkThresholdEvaluateCells
+{
+public:
+  vtkThreshold *Self;
+  vtkDataSet *Input;
+  vtkDataArray *Scalars;
+  bool UsePointScalars;
+  vtkIdType *CellMap;
+  vtkIdType *PointMap;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellPtIds = this->CellPoints.Local();
+    const vtkIdType *cellPts;
+    vtkIdType numCellPts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      // Only the connectivity is needed: avoid building the cell. Empty
+      // (e.g. blanked) cells are never extracted.
+      if (this->Input->GetCellType(cellId) == VTK_EMPTY_CELL)
+        {
+        continue;
+        }
+      this->Input->GetCellPoints(cellId, numCellPts, cellPts, cellPtIds);
+      if (numCellPts > 0 &&
+          this->Self->KeepCell(this->Scalars, this->UsePointScalars, cellId,
+                               cellPts, numCellPts))
+        {
+        this->CellMap[cellId] = 1;
+        for (vtkIdType i = 0; i < numCellPts; ++i)
+          {
+          this->PointMap[cellPts[i]] = 1;
+          }
+        }
+      }
+  }
+};
+
+namespace
+{
+bool vtkThresholdIsArrayThreadSafe(vtkAbstractArray *array)
+{
+  vtkDataArray *dataArray = vtkDataArray::SafeDownCast(array);
+  return dataArray && dataArray->GetDataType() != VTK_BIT &&
+    dataArray->HasStandardMemoryLayout();
+}
+
+bool vtkThresholdAreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    if (!vtkThresholdIsArrayThreadSafe(fd->GetAbstractArray(i)))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Records the original ids of the marked points or cells from the prefix
+// sums of their marks: element i is marked when Map[i + 1] > Map[i].
+struct vtkThresholdOriginalIds
+{
+  const vtkIdType *Map;
+  vtkIdType *OriginalIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      if (this->Map[i + 1] > this->Map[i])
+        {
+        this->OriginalIds[this->Map[i]] = i;
+        }
+      }
+  }
+};
+
+// Turns the marks (0 or 1) of the n elements of map, which holds n + 1
+// values, into the new ids of the marked elements and fills originalIds.
+// Returns the number of marked elements.
+vtkIdType vtkThresholdBuildMap(vtkIdType *map, vtkIdType n,
+                               vtkIdTypeArray *originalIds)
+{
+  vtkIdType numMarked =
+    vtkSMPTools::ExclusiveScan(map, map + n, map, static_cast<vtkIdType>(0));
+  map[n] = numMarked;
+  originalIds->SetNumberOfTuples(numMarked);
+  vtkThresholdOriginalIds record = { map, originalIds->GetPointer(0) };
+  vtkSMPTools::For(0, n, record);
+  return numMarked;
+}
+
+// Copies the extracted points.
+struct vtkThresholdCopyPoints
+{
+  vtkDataSet *Input;
+  const vtkIdType *OriginalIds;
+  vtkPoints *Points;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Input->GetPoint(this->OriginalIds[i], x);
+      this->Points->SetPoint(i, x);
+      }
+  }
+};
+
+// Stores the connectivity size and the type of the extracted cells.
+struct vtkThresholdCellSizes
+{
+  vtkDataSet *Input;
+  const vtkIdType *OriginalIds;
+  vtkIdType *Sizes;
+  unsigned char *Types;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellPtIds = this->CellPoints.Local();
+    const vtkIdType *cellPts;
+    vtkIdType numCellPts;
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Input->GetCellPoints(this->OriginalIds[i], numCellPts, cellPts,
+                                 cellPtIds);
+      this->Sizes[i] = numCellPts + 1;
+      this->Types[i] = static_cast<unsigned char>(
+        this->Input->GetCellType(this->OriginalIds[i]));
+      }
+  }
+};
+
+// Fills the connectivity of the extracted cells from their locations.
+struct vtkThresholdCellConnectivity
+{
+  vtkDataSet *Input;
+  const vtkIdType *OriginalIds;
+  const vtkIdType *PointMap;
+  const vtkIdType *Locations;
+  vtkIdType *Connectivity;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellPtIds = this->CellPoints.Local();
+    const vtkIdType *cellPts;
+    vtkIdType numCellPts;
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Input->GetCellPoints(this->OriginalIds[i], numCellPts, cellPts,
+                                 cellPtIds);
+      vtkIdType *cell = this->Connectivity + this->Locations[i];
+      *cell++ = numCellPts;
+      for (vtkIdType j = 0; j < numCellPts; ++j)
+        {
+        *cell++ = this->PointMap[cellPts[j]];
+        }
+      }
+  }
+};
+
+// Copies the tuples of the extracted points or cells into presized arrays.
+struct vtkThresholdCopyTuples
+{
+  vtkDataSetAttributes *In;
+  vtkDataSetAttributes *Out;
+  const vtkIdType *OriginalIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Out->CopyData(this->In, this->OriginalIds[i], i);
+      }
+  }
+};
+
+// Copies the attributes of the extracted points or cells, in parallel when
+// all the arrays can be written from several threads.
+void vtkThresholdCopyAttributes(vtkDataSetAttributes *in,
+                                vtkDataSetAttributes *out,
+                                vtkIdTypeArray *originalIds)
+{
+  vtkIdType n = originalIds->GetNumberOfTuples();
+  const vtkIdType *ids = originalIds->GetPointer(0);
+  out->CopyGlobalIdsOn();
+  out->CopyAllocate(in, n);
+  if (vtkThresholdAreArraysThreadSafe(in))
+    {
+    out->SetNumberOfTuples(n);
+    vtkThresholdCopyTuples copy = { in, out, ids };
+    vtkSMPTools::For(0, n, copy);
+    }
+  else
+    {
+    for (vtkIdType i = 0; i < n; ++i)
+      {
+      out->CopyData(in, ids[i], i);
+      }
+    }
+}
+}
+
 int vtkThreshold::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **inputVector,
@@ -105,17 +326,13 @@ int vtkThreshold::RequestData(
   vtkUnstructuredGrid *output = vtkUnstructuredGrid::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType cellId, newCellId;
-  vtkIdList *cellPts, *pointMap;
-  vtkIdList *newCellPts;
-  vtkCell *cell;
+  vtkIdList *cellPtIds, *newCellPts;
+  const vtkIdType *cellPts;
+  vtkIdType numCellPts, numPts, numCells;
+  int cellType;
   vtkPoints *newPoints;
-  int i, ptId, newId, numPts;
-  int numCellPts;
-  double x[3];
   vtkPointData *pd=input->GetPointData(), *outPD=output->GetPointData();
   vtkCellData *cd=input->GetCellData(), *outCD=output->GetCellData();
-  int keepCell;
 
   vtkDebugMacro(<< "Executing threshold filter");
 
@@ -133,14 +350,73 @@ int vtkThreshold::RequestData(
     return 1;
     }
 
-  outPD->CopyGlobalIdsOn();
-  outPD->CopyAllocate(pd);
-  outCD->CopyGlobalIdsOn();
-  outCD->CopyAllocate(cd);
+  // When only attributes other than the thresholded array changed, the
+  // cells extracted last time are still right.
+  if (this->CacheMesh &&
+      this->MeshCache->CanRemap(input, this->GetMTime(), inScalars))
+    {
+    vtkDebugMacro(<< "Remapping attributes onto the cached mesh");
+    this->MeshCache->Remap(input, output);
+    return 1;
+    }
+  vtkAttributeRemapCache *cache = NULL;
+  this->MeshCache->Initialize();
+  if (this->CacheMesh)
+    {
+    cache = this->MeshCache;
+    }
 
   numPts = input->GetNumberOfPoints();
-  output->Allocate(input->GetNumberOfCells());
+  numCells = input->GetNumberOfCells();
+
+  // The arrays read and written by several threads must be accessed
+  // through their values: vtkDataArray::GetComponent() and GetTuple() of
+  // other layouts use a buffer of the array.
+  bool inParallel = vtkThresholdIsArrayThreadSafe(inScalars);
 
+  // GetCellPoints() and GetCellType() are thread safe once called from a
+  // single thread.
+  cellPtIds = vtkIdList::New();
+  if (numCells > 0)
+    {
+    input->GetCellPoints(0, cellPtIds);
+    input->GetCellType(0);
+    }
+
+  // are we using pointScalars?
+  int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
+  bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
+
+  // First pass: mark the cells satisfying the threshold criterion and
+  // their points.
+  std::vector<vtkIdType> cellMap(numCells + 1, 0);
+  std::vector<vtkIdType> pointMap(numPts + 1, 0);
+  vtkThresholdEvaluateCells evaluate;
+  evaluate.Self = this;
+  evaluate.Input = input;
+  evaluate.Scalars = inScalars;
+  evaluate.UsePointScalars = usePointScalars;
+  evaluate.CellMap = &cellMap[0];
+  evaluate.PointMap = &pointMap[0];
+  if (inParallel)
+    {
+    vtkSMPTools::For(0, numCells, evaluate);
+    }
+  else
+    {
+    evaluate(0, numCells);
+    }
+
+  // The new ids are the prefix sums of the marks.
+  vtkNew<vtkIdTypeArray> originalPointIds;
+  vtkIdType numNewPts = vtkThresholdBuildMap(&pointMap[0], numPts,
+                                             originalPointIds.GetPointer());
+  vtkNew<vtkIdTypeArray> originalCellIds;
+  vtkIdType numNewCells = vtkThresholdBuildMap(&cellMap[0], numCells,
+                                               originalCellIds.GetPointer());
+  const vtkIdType *cellIds = originalCellIds->GetPointer(0);
+
+  // Second pass: fill the output.
   newPoints = vtkPoints::New();
 
   // set precision for the points in the output
@@ -165,108 +441,133 @@ int vtkThreshold::RequestData(
     newPoints->SetDataType(VTK_DOUBLE);
     }
 
-  newPoints->Allocate(numPts);
-
-  pointMap = vtkIdList::New(); //maps old point ids into new
-  pointMap->SetNumberOfIds(numPts);
-  for (i=0; i < numPts; i++)
-    {
-    pointMap->SetId(i,-1);
-    }
-
-  newCellPts = vtkIdList::New();
-
-  // are we using pointScalars?
-  int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
-  bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
+  newPoints->SetNumberOfPoints(numNewPts);
+  vtkThresholdCopyPoints copyPoints =
+    { input, originalPointIds->GetPointer(0), newPoints };
+  vtkSMPTools::For(0, numNewPts, copyPoints);
+  output->SetPoints(newPoints);
+  newPoints->Delete();
 
-  // Check that the scalars of each cell satisfy the threshold criterion
-  for (cellId=0; cellId < input->GetNumberOfCells(); cellId++)
+  vtkUnstructuredGrid *inputUG = vtkUnstructuredGrid::SafeDownCast(input);
+  if (inputUG && inputUG->GetFaces())
     {
-    cell = input->GetCell(cellId);
-    cellPts = cell->GetPointIds();
-    numCellPts = cell->GetNumberOfPoints();
-
-    if ( usePointScalars )
+    // special handling for polyhedron cells: their face streams are
+    // inserted one cell at a time
+    newCellPts = vtkIdList::New();
+    output->Allocate(numNewCells);
+    for (vtkIdType i = 0; i < numNewCells; ++i)
       {
-      if (this->AllScalars)
+      cellType = input->GetCellType(cellIds[i]);
+      if (cellType == VTK_POLYHEDRON)
         {
-        keepCell = 1;
-        for ( i=0; keepCell && (i < numCellPts); i++)
-          {
-          ptId = cellPts->GetId(i);
-          keepCell = this->EvaluateComponents( inScalars, ptId );
-          }
+        inputUG->GetFaceStream(cellIds[i], newCellPts);
+        vtkUnstructuredGrid::ConvertFaceStreamPointIds(newCellPts,
+                                                       &pointMap[0]);
         }
       else
         {
-        if(!this->UseContinuousCellRange)
+        input->GetCellPoints(cellIds[i], numCellPts, cellPts, cellPtIds);
+        newCellPts->SetNumberOfIds(numCellPts);
+        for (vtkIdType j = 0; j < numCellPts; ++j)
           {
-          keepCell = 0;
-          for ( i=0; (!keepCell) && (i < numCellPts); i++)
-            {
-            ptId = cellPts->GetId(i);
-            keepCell = this->EvaluateComponents( inScalars, ptId );
-            }
-          }
-        else
-          {
-          keepCell = this->EvaluateCell(inScalars, cellPts, numCellPts);
+          newCellPts->SetId(j, pointMap[cellPts[j]]);
           }
         }
+      output->InsertNextCell(cellType, newCellPts);
       }
-    else //use cell scalars
+    newCellPts->Delete();
+    }
+  else
+    {
+    vtkNew<vtkIdTypeArray> locations;
+    vtkNew<vtkUnsignedCharArray> types;
+    locations->SetNumberOfTuples(numNewCells);
+    types->SetNumberOfTuples(numNewCells);
+    vtkThresholdCellSizes sizes;
+    sizes.Input = input;
+    sizes.OriginalIds = cellIds;
+    sizes.Sizes = locations->GetPointer(0);
+    sizes.Types = types->GetPointer(0);
+    vtkSMPTools::For(0, numNewCells, sizes);
+    vtkIdType connectivitySize = vtkSMPTools::ExclusiveScan(
+      locations->GetPointer(0), locations->GetPointer(0) + numNewCells,
+      locations->GetPointer(0), static_cast<vtkIdType>(0));
+
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->SetNumberOfTuples(connectivitySize);
+    vtkThresholdCellConnectivity fill;
+    fill.Input = input;
+    fill.OriginalIds = cellIds;
+    fill.PointMap = &pointMap[0];
+    fill.Locations = locations->GetPointer(0);
+    fill.Connectivity = connectivity->GetPointer(0);
+    vtkSMPTools::For(0, numNewCells, fill);
+
+    vtkNew<vtkCellArray> cells;
+    cells->SetCells(numNewCells, connectivity.GetPointer());
+    output->SetCells(types.GetPointer(), locations.GetPointer(),
+                     cells.GetPointer());
+    }
+  cellPtIds->Delete();
+
+  vtkThresholdCopyAttributes(pd, outPD, originalPointIds.GetPointer());
+  vtkThresholdCopyAttributes(cd, outCD, originalCellIds.GetPointer());
+
+  vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells()
+                << " number of cells.");
+
+  if (cache)
+    {
+    cache->SetPointMap(originalPointIds.GetPointer());
+    cache->SetCellMap(originalCellIds.GetPointer());
+    cache->Finish(input, output, inScalars);
+    }
+
+  return 1;
+}
+
+int vtkThreshold::KeepCell( vtkDataArray *scalars, bool usePointScalars,
+                            vtkIdType cellId, const vtkIdType* cellPts,
+                            vtkIdType numCellPts )
+{
+  int keepCell;
+  int i;
+
+  if ( usePointScalars )
+    {
+    if (this->AllScalars)
       {
-      keepCell = this->EvaluateComponents( inScalars, cellId );
+      keepCell = 1;
+      for ( i=0; keepCell && (i < numCellPts); i++)
+        {
+        keepCell = this->EvaluateComponents( scalars, cellPts[i] );
+        }
       }
-
-    if (  numCellPts > 0 && keepCell )
+    else
       {
-      // satisfied thresholding (also non-empty cell, i.e. not VTK_EMPTY_CELL)
-      for (i=0; i < numCellPts; i++)
+      if(!this->UseContinuousCellRange)
         {
-        ptId = cellPts->GetId(i);
-        if ( (newId = pointMap->GetId(ptId)) < 0 )
+        keepCell = 0;
+        for ( i=0; (!keepCell) && (i < numCellPts); i++)
           {
-          input->GetPoint(ptId, x);
-          newId = newPoints->InsertNextPoint(x);
-          pointMap->SetId(ptId,newId);
-          outPD->CopyData(pd,ptId,newId);
+          keepCell = this->EvaluateComponents( scalars, cellPts[i] );
           }
-        newCellPts->InsertId(i,newId);
         }
-      // special handling for polyhedron cells
-      if (vtkUnstructuredGrid::SafeDownCast(input) &&
-          input->GetCellType(cellId) == VTK_POLYHEDRON)
+      else
         {
-        newCellPts->Reset();
-        vtkUnstructuredGrid::SafeDownCast(input)->
-          GetFaceStream(cellId, newCellPts);
-        vtkUnstructuredGrid::ConvertFaceStreamPointIds(
-          newCellPts, pointMap->GetPointer(0));
+        keepCell = this->EvaluateCell(scalars, cellPts,
+                                      static_cast<int>(numCellPts));
         }
-      newCellId = output->InsertNextCell(cell->GetCellType(),newCellPts);
-      outCD->CopyData(cd,cellId,newCellId);
-      newCellPts->Reset();
-      } // satisfied thresholding
-    } // for all cells
-
-  vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells()
-                << " number of cells.");
-
-  // now clean up / update ourselves
-  pointMap->Delete();
-  newCellPts->Delete();
-
-  output->SetPoints(newPoints);
-  newPoints->Delete();
-
-  output->Squeeze();
-
-  return 1;
+      }
+    }
+  else //use cell scalars
+    {
+    keepCell = this->EvaluateComponents( scalars, cellId );
+    }
+  return keepCell;
 }
 
-int vtkThreshold::EvaluateCell( vtkDataArray *scalars,vtkIdList* cellPts, int numCellPts )
+int vtkThreshold::EvaluateCell( vtkDataArray *scalars, const vtkIdType* cellPts, int numCellPts )
 {
   int c(0);
   int numComp = scalars->GetNumberOfComponents();
@@ -295,12 +596,12 @@ int vtkThreshold::EvaluateCell( vtkDataArray *scalars,vtkIdList* cellPts, int nu
   return keepCell;
 }
 
-int vtkThreshold::EvaluateCell( vtkDataArray *scalars, int c, vtkIdList* cellPts, int numCellPts )
+int vtkThreshold::EvaluateCell( vtkDataArray *scalars, int c, const vtkIdType* cellPts, int numCellPts )
 {
   double minScalar=DBL_MAX, maxScalar=DBL_MIN;
   for (int i=0; i < numCellPts; i++)
     {
-    int ptId = cellPts->GetId(i);
+    vtkIdType ptId = cellPts[i];
     double s = scalars->GetComponent(ptId,c);
     minScalar = std::min(s,minScalar);
     maxScalar = std::max(s,maxScalar);
@@ -450,4 +751,5 @@ void vtkThreshold::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Precision of the output points: "
      << this->OutputPointsPrecision << "\n";
   os << indent << "Use Continuous Cell Range: "<<this->UseContinuousCellRange<<endl;
+  os << indent << "Cache Mesh: " << (this->CacheMesh ? "On" : "Off") << endl;
 }
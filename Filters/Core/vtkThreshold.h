@@ -27,6 +27,10 @@
 //
 // By default only the first scalar value is used in the decision. Use the ComponentMode
 // and SelectedComponent ivars to control this behavior.
+//
+// The cells are evaluated, and the output points, cells and attributes
+// filled, with vtkSMPTools when the arrays involved can be accessed from
+// several threads. The output points are in the order of the input points.
 
 // .SECTION See Also
 // vtkThresholdPoints vtkThresholdTextureCoords
@@ -46,6 +50,7 @@
 #define VTK_COMPONENT_MODE_USE_ALL         1
 #define VTK_COMPONENT_MODE_USE_ANY         2
 
+class vtkAttributeRemapCache;
 class vtkDataArray;
 class vtkIdList;
 
@@ -135,6 +140,17 @@ public:
   vtkGetMacro(UseContinuousCellRange,int);
   vtkBooleanMacro(UseContinuousCellRange,int);
 
+  // Description:
+  // If this is on (default is off), the extracted cells are cached. When
+  // only the input attributes change afterwards, except for the array
+  // being thresholded, the cached cells are reused and the attributes are
+  // copied onto them instead of thresholding the input again. This
+  // speeds up coloring by a changing field, at the cost of keeping the
+  // output mesh and the maps to the input points and cells.
+  vtkSetMacro(CacheMesh,int);
+  vtkGetMacro(CacheMesh,int);
+  vtkBooleanMacro(CacheMesh,int);
+
   // Description:
   // Set the data type of the output points (See the data types defined in
   // vtkType.h). The default data type is float.
@@ -171,6 +187,8 @@ protected:
   int    SelectedComponent;
   int OutputPointsPrecision;
   int UseContinuousCellRange;
+  int CacheMesh;
+  vtkAttributeRemapCache *MeshCache;
 
   //BTX
   int (vtkThreshold::*ThresholdFunction)(double s);
@@ -182,8 +200,19 @@ protected:
                                ( s <= this->UpperThreshold ? 1 : 0 ) : 0 );};
 
   int EvaluateComponents( vtkDataArray *scalars, vtkIdType id );
-  int EvaluateCell( vtkDataArray *scalars, vtkIdList* cellPts, int numCellPts );
-  int EvaluateCell( vtkDataArray *scalars, int c, vtkIdList* cellPts, int numCellPts );
+  int EvaluateCell( vtkDataArray *scalars, const vtkIdType* cellPts, int numCellPts );
+  int EvaluateCell( vtkDataArray *scalars, int c, const vtkIdType* cellPts, int numCellPts );
+
+  // Description:
+  // Return whether the cell satisfies the threshold criterion, given the
+  // ids of its points. Safe to call from several threads when the scalars
+  // can be read concurrently.
+  int KeepCell( vtkDataArray *scalars, bool usePointScalars, vtkIdType cellId,
+                const vtkIdType* cellPts, vtkIdType numCellPts );
+
+  //BTX
+  friend class vtkThresholdEvaluateCells;
+  //ETX
 private:
   vtkThreshold(const vtkThreshold&);  // Not implemented.
   void operator=(const vtkThreshold&);  // Not implemented.
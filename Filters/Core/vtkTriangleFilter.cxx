@@ -16,16 +16,334 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangleStrip.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkTriangleFilter);
 
+namespace
+{
+bool vtkTriangleFilterAreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(i));
+    if (!array || array->GetDataType() == VTK_BIT ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+enum
+{
+  vtkTriangleFilterVerts = 0,
+  vtkTriangleFilterLines = 1,
+  vtkTriangleFilterPolys = 2,
+  vtkTriangleFilterStrips = 3
+};
+
+// Converts the cells of one input cell array. The counting pass stores the
+// number of output cells of each input cell in Counts; polygons are
+// triangulated in this pass and their triangles kept in Triangles, from the
+// upper bound 3 * TriangleOffsets[i] on. Once Counts holds the prefix sums
+// of the counts, the filling pass (Connectivity set) writes the output cells
+// of input cell i from Counts[i] on and copies their cell data.
+struct vtkTriangleFilterConvertCells
+{
+  int Type;
+  const vtkIdType *InConnectivity;
+  const vtkIdType *Locations;
+  vtkPoints *Points;
+  vtkIdType *Counts;
+  const vtkIdType *TriangleOffsets;
+  vtkIdType *Triangles;
+  vtkIdType *Connectivity;
+  vtkIdType OutOffset;
+  vtkIdType FirstInCell;
+  vtkIdType FirstOutCell;
+  vtkCellData *InCD;
+  vtkCellData *OutCD;
+  vtkSMPThreadLocalObject<vtkPolygon> Polygons;
+  vtkSMPThreadLocalObject<vtkIdList> TriIds;
+
+  vtkIdType Triangulate(vtkIdType npts, const vtkIdType *pts, vtkIdType *tris)
+  {
+    if (npts == 3)
+      {
+      std::copy(pts, pts + 3, tris);
+      return 1;
+      }
+    if (npts == 0)
+      {
+      return 0;
+      }
+    vtkPolygon *poly = this->Polygons.Local();
+    vtkIdList *ptIds = this->TriIds.Local();
+    double x[3];
+    poly->PointIds->SetNumberOfIds(npts);
+    poly->Points->SetNumberOfPoints(npts);
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      poly->PointIds->SetId(i, pts[i]);
+      this->Points->GetPoint(pts[i], x);
+      poly->Points->SetPoint(i, x);
+      }
+    poly->Triangulate(ptIds);
+    vtkIdType numTris = ptIds->GetNumberOfIds() / 3;
+    for (vtkIdType i = 0; i < 3 * numTris; ++i)
+      {
+      tris[i] = poly->PointIds->GetId(ptIds->GetId(i));
+      }
+    return numTris;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      const vtkIdType *cell = this->InConnectivity + this->Locations[cellId];
+      vtkIdType npts = cell[0];
+      const vtkIdType *pts = cell + 1;
+      if (!this->Connectivity)
+        {
+        switch (this->Type)
+          {
+          case vtkTriangleFilterVerts:
+            this->Counts[cellId] = npts;
+            break;
+          case vtkTriangleFilterLines:
+            this->Counts[cellId] = (npts > 1 ? npts - 1 : 0);
+            break;
+          case vtkTriangleFilterPolys:
+            this->Counts[cellId] = this->Triangulate(npts, pts,
+              this->Triangles + 3 * this->TriangleOffsets[cellId]);
+            break;
+          default:
+            this->Counts[cellId] = (npts > 2 ? npts - 2 : 0);
+          }
+        continue;
+        }
+
+      vtkIdType outId = this->Counts[cellId];
+      vtkIdType numOut = this->Counts[cellId+1] - outId;
+      int size = (this->Type < vtkTriangleFilterPolys ? this->Type + 2 : 4);
+      for (vtkIdType i = 0; i < numOut; ++i)
+        {
+        vtkIdType *outCell = this->Connectivity +
+          size * (this->OutOffset + outId + i);
+        outCell[0] = size - 1;
+        if (this->Type == vtkTriangleFilterPolys)
+          {
+          const vtkIdType *tri =
+            this->Triangles + 3 * (this->TriangleOffsets[cellId] + i);
+          std::copy(tri, tri + 3, outCell + 1);
+          }
+        else if (this->Type == vtkTriangleFilterStrips)
+          {
+          // flip the ordering of every other triangle for consistency
+          outCell[1] = pts[i % 2 ? i + 1 : i];
+          outCell[2] = pts[i % 2 ? i : i + 1];
+          outCell[3] = pts[i+2];
+          }
+        else
+          {
+          std::copy(pts + i, pts + i + size - 1, outCell + 1);
+          }
+        if (this->OutCD)
+          {
+          this->OutCD->CopyData(this->InCD, this->FirstInCell + cellId,
+                                this->FirstOutCell + outId + i);
+          }
+        }
+      }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+int vtkTriangleFilter::TriangulateCellsInParallel(vtkPolyData *input,
+                                                  vtkPolyData *output)
+{
+  vtkCellData *inCD=input->GetCellData();
+  vtkCellData *outCD=output->GetCellData();
+  vtkCellArray *inCells[4] = { input->GetVerts(), input->GetLines(),
+                               input->GetPolys(), input->GetStrips() };
+  bool convert[4] = { this->PassVerts != 0, this->PassLines != 0, true, true };
+
+  // Locate the input cells in their connectivity, and bound the number of
+  // triangles of the polygons.
+  std::vector<vtkIdType> locations[4];
+  std::vector<vtkIdType> counts[4];
+  std::vector<vtkIdType> triangleOffsets;
+  vtkIdType firstInCell[4];
+  vtkIdType numInCells = 0;
+  int type;
+  for (type = 0; type < 4; ++type)
+    {
+    vtkIdType numCells = inCells[type]->GetNumberOfCells();
+    firstInCell[type] = numInCells;
+    numInCells += numCells;
+    if (!convert[type] || numCells == 0)
+      {
+      continue;
+      }
+    locations[type].resize(numCells);
+    counts[type].resize(numCells + 1);
+    if (type == vtkTriangleFilterPolys)
+      {
+      triangleOffsets.resize(numCells + 1);
+      }
+    const vtkIdType *conn = inCells[type]->GetPointer();
+    vtkIdType loc = 0, numTris = 0;
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+      locations[type][cellId] = loc;
+      if (type == vtkTriangleFilterPolys)
+        {
+        triangleOffsets[cellId] = numTris;
+        numTris += (conn[loc] > 2 ? conn[loc] - 2 : 0);
+        }
+      loc += conn[loc] + 1;
+      }
+    if (type == vtkTriangleFilterPolys)
+      {
+      triangleOffsets[numCells] = numTris;
+      }
+    }
+
+  // Count the output cells of each input cell.
+  std::vector<vtkIdType> triangles(3 * (triangleOffsets.empty() ? 0 :
+                                        triangleOffsets.back()) + 1);
+  vtkTriangleFilterConvertCells converters[4];
+  vtkIdType numOutCells[4];
+  for (type = 0; type < 4; ++type)
+    {
+    vtkTriangleFilterConvertCells &converter = converters[type];
+    converter.Type = type;
+    converter.InConnectivity = inCells[type]->GetPointer();
+    converter.Points = input->GetPoints();
+    converter.TriangleOffsets =
+      triangleOffsets.empty() ? NULL : &triangleOffsets[0];
+    converter.Triangles = &triangles[0];
+    converter.Connectivity = NULL;
+    converter.FirstInCell = firstInCell[type];
+    converter.InCD = inCD;
+    converter.OutCD = NULL;
+    numOutCells[type] = 0;
+    if (locations[type].empty())
+      {
+      continue;
+      }
+    vtkIdType numCells = static_cast<vtkIdType>(locations[type].size());
+    converter.Locations = &locations[type][0];
+    converter.Counts = &counts[type][0];
+    vtkSMPTools::For(0, numCells, converter);
+    numOutCells[type] = vtkSMPTools::ExclusiveScan(counts[type].begin(),
+      counts[type].begin() + numCells, counts[type].begin(),
+      static_cast<vtkIdType>(0));
+    counts[type][numCells] = numOutCells[type];
+    }
+  this->UpdateProgress(0.5);
+
+  // Allocate the output: the triangles of the strips follow those of the
+  // polygons in the polys.
+  vtkIdType numOutVerts = numOutCells[vtkTriangleFilterVerts];
+  vtkIdType numOutLines = numOutCells[vtkTriangleFilterLines];
+  vtkIdType numOutTris = numOutCells[vtkTriangleFilterPolys] +
+    numOutCells[vtkTriangleFilterStrips];
+  vtkIdType numOut = numOutVerts + numOutLines + numOutTris;
+  vtkIdType *connectivity[3] = { NULL, NULL, NULL };
+  vtkIdType numOutType[3] = { numOutVerts, numOutLines, numOutTris };
+  for (type = 0; type < 3; ++type)
+    {
+    bool present = (type == vtkTriangleFilterPolys ?
+      inCells[vtkTriangleFilterPolys]->GetNumberOfCells() > 0 ||
+      inCells[vtkTriangleFilterStrips]->GetNumberOfCells() > 0 :
+      convert[type] && inCells[type]->GetNumberOfCells() > 0);
+    if (!present)
+      {
+      continue;
+      }
+    vtkIdTypeArray *cells = vtkIdTypeArray::New();
+    cells->SetNumberOfValues((type + 2) * numOutType[type]);
+    connectivity[type] = cells->GetPointer(0);
+    vtkCellArray *newCells = vtkCellArray::New();
+    newCells->SetCells(numOutType[type], cells);
+    cells->Delete();
+    if (type == vtkTriangleFilterVerts)
+      {
+      output->SetVerts(newCells);
+      }
+    else if (type == vtkTriangleFilterLines)
+      {
+      output->SetLines(newCells);
+      }
+    else
+      {
+      output->SetPolys(newCells);
+      }
+    newCells->Delete();
+    }
+
+  outCD->CopyAllocate(inCD, numOut);
+  outCD->SetNumberOfTuples(numOut);
+  bool parallelCD = vtkTriangleFilterAreArraysThreadSafe(inCD) &&
+    vtkTriangleFilterAreArraysThreadSafe(outCD);
+
+  // Fill the output cells and their cell data.
+  vtkIdType firstOutCell[4] = { 0, numOutVerts, numOutVerts + numOutLines,
+    numOutVerts + numOutLines + numOutCells[vtkTriangleFilterPolys] };
+  for (type = 0; type < 4; ++type)
+    {
+    if (locations[type].empty())
+      {
+      continue;
+      }
+    vtkTriangleFilterConvertCells &converter = converters[type];
+    converter.Connectivity =
+      connectivity[std::min(type, static_cast<int>(vtkTriangleFilterPolys))];
+    converter.OutOffset = (type == vtkTriangleFilterStrips ?
+                           numOutCells[vtkTriangleFilterPolys] : 0);
+    converter.FirstOutCell = firstOutCell[type];
+    converter.OutCD = outCD;
+    vtkIdType numCells = static_cast<vtkIdType>(locations[type].size());
+    if (parallelCD)
+      {
+      vtkSMPTools::For(0, numCells, converter);
+      }
+    else
+      {
+      converter(0, numCells);
+      }
+    }
+
+  // Update output
+  output->SetPoints(input->GetPoints());
+  output->GetPointData()->PassData(input->GetPointData());
+
+  vtkDebugMacro(<<"Converted " << numInCells
+                << "input cells to "
+                << numOut
+                <<" output cells");
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
 int vtkTriangleFilter::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **inputVector,
@@ -53,6 +371,11 @@ int vtkTriangleFilter::RequestData(
   vtkCellArray *cells, *newCells;
   vtkPoints *inPts=input->GetPoints();
 
+  if ( this->TriangulateInParallel )
+    {
+    return this->TriangulateCellsInParallel(input, output);
+    }
+
   int abort=0;
   updateInterval = numCells/100 + 1;
   outCD->CopyAllocate(inCD,numCells);
@@ -245,5 +568,7 @@ void vtkTriangleFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Pass Verts: " << (this->PassVerts ? "On\n" : "Off\n");
   os << indent << "Pass Lines: " << (this->PassLines ? "On\n" : "Off\n");
+  os << indent << "Triangulate In Parallel: "
+     << (this->TriangulateInParallel ? "On\n" : "Off\n");
 
 }
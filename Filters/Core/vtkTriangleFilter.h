@@ -18,6 +18,10 @@
 // strips.  It also generates line segments from polylines unless PassLines
 // is off, and generates individual vertex cells from vtkVertex point lists
 // unless PassVerts is off.
+//
+// With TriangulateInParallel on, the output cells of every input cell are
+// counted (polygons are triangulated) in parallel, and the output is then
+// filled in parallel at offsets computed from these counts.
 
 #ifndef vtkTriangleFilter_h
 #define vtkTriangleFilter_h
@@ -50,15 +54,26 @@ public:
   vtkSetMacro(PassLines,int);
   vtkGetMacro(PassLines,int);
 
+  // Description:
+  // Turn on/off converting the cells in parallel (default: off). The output
+  // is the same as with the serial conversion.
+  vtkBooleanMacro(TriangulateInParallel,int);
+  vtkSetMacro(TriangulateInParallel,int);
+  vtkGetMacro(TriangulateInParallel,int);
+
 protected:
-  vtkTriangleFilter() : PassVerts(1), PassLines(1) {}
+  vtkTriangleFilter() : PassVerts(1), PassLines(1), TriangulateInParallel(0) {}
   ~vtkTriangleFilter() {}
 
   // Usual data generation method
   int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
 
+  // Convert the cells of the input in parallel.
+  int TriangulateCellsInParallel(vtkPolyData *input, vtkPolyData *output);
+
   int PassVerts;
   int PassLines;
+  int TriangulateInParallel;
 private:
   vtkTriangleFilter(const vtkTriangleFilter&);  // Not implemented.
   void operator=(const vtkTriangleFilter&);  // Not implemented.
@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkMath.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -24,6 +25,15 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <vector>
 
 vtkStandardNewMacro(vtkTubeFilter);
 
@@ -49,6 +59,7 @@ vtkTubeFilter::vtkTubeFilter()
   this->TextureLength = 1.0;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->GenerateInParallel = 0;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
@@ -215,62 +226,73 @@ int vtkTubeFilter::RequestData(
   //  triangle strips. Texture coordinates are optionally generated.
   //
   this->Theta = 2.0*vtkMath::Pi() / this->NumberOfSides;
-  vtkPolyLine *lineNormalGenerator = vtkPolyLine::New();
-  // the line cellIds start after the last vert cellId
-  inCellId = input->GetNumberOfVerts();
-  for (inLines->InitTraversal();
-       inLines->GetNextCell(npts,pts) && !abort; inCellId++)
+  if ( this->GenerateInParallel &&
+       vtkSMPTools::GetEstimatedNumberOfThreads() > 1 )
     {
-    this->UpdateProgress((double)inCellId/numLines);
-    abort = this->GetAbortExecute();
-
-    if (npts < 2)
+    this->GenerateTubesInParallel(input,inScalars,range,inVectors,maxSpeed,
+                                  inNormals,generateNormals,newPts,newNormals,
+                                  newTCoords,newStrips,outPD,outCD);
+    }
+  else
+    {
+    vtkPolyLine *lineNormalGenerator = vtkPolyLine::New();
+    // the line cellIds start after the last vert cellId
+    inCellId = input->GetNumberOfVerts();
+    for (inLines->InitTraversal();
+         inLines->GetNextCell(npts,pts) && !abort; inCellId++)
       {
-      vtkWarningMacro(<< "Less than two points in line!");
-      continue; //skip tubing this polyline
-      }
+      this->UpdateProgress((double)inCellId/numLines);
+      abort = this->GetAbortExecute();
 
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
-      {
-      singlePolyline->Reset(); //avoid instantiation
-      singlePolyline->InsertNextCell(npts,pts);
-      if ( !lineNormalGenerator->GenerateSlidingNormals(inPts,singlePolyline,
-                                                        inNormals) )
+      if (npts < 2)
         {
-        vtkWarningMacro("Could not generate normals for line. "
-                        "Skipping to next.");
+        vtkWarningMacro(<< "Less than two points in line!");
         continue; //skip tubing this polyline
         }
-      }
 
-    // Generate the points around the polyline. The tube is not stripped
-    // if the polyline is bad.
-    //
-    if ( !this->GeneratePoints(offset,npts,pts,inPts,newPts,pd,outPD,
-                               newNormals,inScalars,range,inVectors,
-                               maxSpeed,inNormals) )
-      {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; //skip tubing this polyline
-      }
+      // If necessary calculate normals, each polyline calculates its
+      // normals independently, avoiding conflicts at shared vertices.
+      if (generateNormals)
+        {
+        singlePolyline->Reset(); //avoid instantiation
+        singlePolyline->InsertNextCell(npts,pts);
+        if ( !lineNormalGenerator->GenerateSlidingNormals(inPts,singlePolyline,
+                                                          inNormals) )
+          {
+          vtkWarningMacro("Could not generate normals for line. "
+                          "Skipping to next.");
+          continue; //skip tubing this polyline
+          }
+        }
 
-    // Generate the strips for this polyline (including caps)
-    //
-    this->GenerateStrips(offset,npts,pts,inCellId,cd,outCD,newStrips);
+      // Generate the points around the polyline. The tube is not stripped
+      // if the polyline is bad.
+      //
+      if ( !this->GeneratePoints(offset,npts,pts,inPts,newPts,pd,outPD,
+                                 newNormals,inScalars,range,inVectors,
+                                 maxSpeed,inNormals) )
+        {
+        vtkWarningMacro(<< "Could not generate points!");
+        continue; //skip tubing this polyline
+        }
 
-    // Generate the texture coordinates for this polyline
-    //
-    if ( newTCoords )
-      {
-      this->GenerateTextureCoords(offset,npts,pts,inPts,inScalars,newTCoords);
-      }
+      // Generate the strips for this polyline (including caps)
+      //
+      this->GenerateStrips(offset,npts,pts,inCellId,cd,outCD,newStrips);
+
+      // Generate the texture coordinates for this polyline
+      //
+      if ( newTCoords )
+        {
+        this->GenerateTextureCoords(offset,npts,pts,inPts,inScalars,newTCoords);
+        }
 
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset,npts);
+      // Compute the new offset for the next polyline
+      offset = this->ComputeOffset(offset,npts);
 
-    }//for all polylines
+      }//for all polylines
+    lineNormalGenerator->Delete();
+    }
 
   singlePolyline->Delete();
 
@@ -301,7 +323,6 @@ int vtkTubeFilter::RequestData(
 
   outPD->SetNormals(newNormals);
   newNormals->Delete();
-  lineNormalGenerator->Delete();
 
   output->Squeeze();
 
@@ -316,6 +337,23 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset,
                                   vtkDataArray *inScalars, double range[2],
                                   vtkDataArray *inVectors, double maxSpeed,
                                   vtkDataArray *inNormals)
+{
+  return this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD,
+                              newNormals, inScalars, range, inVectors,
+                              maxSpeed, inNormals, pts);
+}
+
+// The normal of the j-th point of the line is the tuple normalIds[j] of
+// inNormals. The point data is not copied when outPD is NULL.
+int vtkTubeFilter::GeneratePoints(vtkIdType offset,
+                                  vtkIdType npts, vtkIdType *pts,
+                                  vtkPoints *inPts, vtkPoints *newPts,
+                                  vtkPointData *pd, vtkPointData *outPD,
+                                  vtkFloatArray *newNormals,
+                                  vtkDataArray *inScalars, double range[2],
+                                  vtkDataArray *inVectors, double maxSpeed,
+                                  vtkDataArray *inNormals,
+                                  vtkIdType *normalIds)
 {
   vtkIdType j;
   int i, k;
@@ -331,6 +369,7 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset,
   double nP[3];
   double sFactor=1.0;
   double normal[3];
+  double v[3];
   vtkIdType ptId=offset;
 
   // Use "averaged" segment to create beveled effect.
@@ -374,7 +413,7 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset,
         }
       }
 
-    inNormals->GetTuple(pts[j], n);
+    inNormals->GetTuple(normalIds[j], n);
 
     if ( vtkMath::Normalize(sNext) == 0.0 )
       {
@@ -433,8 +472,8 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset,
       }
     else if ( inVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR )
       {
-      sFactor =
-        sqrt((double)maxSpeed/vtkMath::Norm(inVectors->GetTuple(pts[j])));
+      inVectors->GetTuple(pts[j], v);
+      sFactor = sqrt((double)maxSpeed/vtkMath::Norm(v));
       if ( sFactor > this->RadiusFactor )
         {
         sFactor = this->RadiusFactor;
@@ -464,7 +503,10 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset,
           }
         newPts->InsertPoint(ptId,s);
         newNormals->InsertTuple(ptId,normal);
-        outPD->CopyData(pd,pts[j],ptId);
+        if (outPD)
+          {
+          outPD->CopyData(pd,pts[j],ptId);
+          }
         ptId++;
         }//for each side
       }
@@ -491,10 +533,13 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset,
           }
         newPts->InsertPoint(ptId,s);
         newNormals->InsertTuple(ptId,n_right);
-        outPD->CopyData(pd,pts[j],ptId);
         newPts->InsertPoint(ptId+1,s);
         newNormals->InsertTuple(ptId+1,n_left);
-        outPD->CopyData(pd,pts[j],ptId+1);
+        if (outPD)
+          {
+          outPD->CopyData(pd,pts[j],ptId);
+          outPD->CopyData(pd,pts[j],ptId+1);
+          }
         ptId += 2;
         }//for each side
       }//else separate vertices
@@ -517,7 +562,10 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset,
       newPts->GetPoint(offset+k,s);
       newPts->InsertPoint(ptId,s);
       newNormals->InsertTuple(ptId,startCapNorm);
-      outPD->CopyData(pd,pts[0],ptId);
+      if (outPD)
+        {
+        outPD->CopyData(pd,pts[0],ptId);
+        }
       ptId++;
       }
     //the end cap
@@ -531,7 +579,10 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset,
       newPts->GetPoint(endOffset+k,s);
       newPts->InsertPoint(ptId,s);
       newNormals->InsertTuple(ptId,endCapNorm);
-      outPD->CopyData(pd,pts[npts-1],ptId);
+      if (outPD)
+        {
+        outPD->CopyData(pd,pts[npts-1],ptId);
+        }
       ptId++;
       }
     }//if capping
@@ -557,7 +608,10 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
       i1 = k % this->NumberOfSides;
       i2 = (k+1) % this->NumberOfSides;
       outCellId = newStrips->InsertNextCell(npts*2);
-      outCD->CopyData(cd,inCellId,outCellId);
+      if (outCD)
+        {
+        outCD->CopyData(cd,inCellId,outCellId);
+        }
       for (i=0; i < npts; i++)
         {
         i3 = i*this->NumberOfSides;
@@ -574,7 +628,10 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
       i1 = 2*(k % this->NumberOfSides) + 1;
       i2 = 2*((k+1) % this->NumberOfSides);
       outCellId = newStrips->InsertNextCell(npts*2);
-      outCD->CopyData(cd,inCellId,outCellId);
+      if (outCD)
+        {
+        outCD->CopyData(cd,inCellId,outCellId);
+        }
       for (i=0; i < npts; i++)
         {
         i3 = i*2*this->NumberOfSides;
@@ -598,7 +655,10 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
 
     //The start cap
     outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd,inCellId,outCellId);
+    if (outCD)
+      {
+      outCD->CopyData(cd,inCellId,outCellId);
+      }
     newStrips->InsertCellPoint(startIdx);
     newStrips->InsertCellPoint(startIdx+1);
     for (i1=this->NumberOfSides-1, i2=2, k=0; k<(this->NumberOfSides-2); k++)
@@ -620,7 +680,10 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
     //The end cap - reversed order to be consistent with normal
     startIdx += this->NumberOfSides;
     outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd,inCellId,outCellId);
+    if (outCD)
+      {
+      outCD->CopyData(cd,inCellId,outCellId);
+      }
     newStrips->InsertCellPoint(startIdx);
     newStrips->InsertCellPoint(startIdx+this->NumberOfSides-1);
     for (i1=this->NumberOfSides-2, i2=1, k=0; k<(this->NumberOfSides-2); k++)
@@ -665,10 +728,10 @@ void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset,
     }
   if ( this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS )
     {
-    s0 = inScalars->GetTuple1(pts[0]);
+    s0 = inScalars->GetComponent(pts[0],0);
     for (i=1; i < npts; i++)
       {
-      s = inScalars->GetTuple1(pts[i]);
+      s = inScalars->GetComponent(pts[i],0);
       tc = (s - s0) / this->TextureLength;
       for ( k=0; k < numSides; k++)
         {
@@ -757,6 +820,382 @@ vtkIdType vtkTubeFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
   return offset;
 }
 
+namespace
+{
+// The tubes of a contiguous range of lines, in line order, generated into
+// arrays local to a thread. The points are numbered from the start of the
+// chunk. PointIds holds the input point of each tube point and CellIds the
+// input cell of each strip, to copy the attributes afterwards.
+struct vtkTubeFilterChunk
+{
+  vtkIdType Begin;
+  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfSkippedLines;
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkFloatArray> Normals;
+  vtkSmartPointer<vtkFloatArray> TCoords;
+  vtkSmartPointer<vtkCellArray> Strips;
+  std::vector<vtkIdType> PointIds;
+  std::vector<vtkIdType> CellIds;
+};
+
+bool vtkTubeFilterChunkLess(const vtkTubeFilterChunk *a,
+                            const vtkTubeFilterChunk *b)
+{
+  return a->Begin < b->Begin;
+}
+
+bool vtkTubeFilterAreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(i));
+    if (!array || array->GetDataType() == VTK_BIT ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Copies the chunks into the output at their offsets, shifting the point
+// ids of the strips, and copies the attributes of the input.
+class vtkTubeFilterCopy
+{
+public:
+  const std::vector<const vtkTubeFilterChunk*> *Chunks;
+  const std::vector<vtkIdType> *PointOffsets;
+  const std::vector<vtkIdType> *CellOffsets;
+  const std::vector<vtkIdType> *ConnectivityOffsets;
+  char *Points;
+  int PointSize;
+  float *Normals;
+  float *TCoords;
+  vtkIdType *Connectivity;
+  vtkPointData *InPD;
+  vtkPointData *OutPD;
+  vtkCellData *InCD;
+  vtkCellData *OutCD;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType c = begin; c < end; ++c)
+      {
+      const vtkTubeFilterChunk *chunk = (*this->Chunks)[c];
+      vtkIdType ptOffset = (*this->PointOffsets)[c];
+      vtkIdType numPts = chunk->NumberOfPoints;
+      if (numPts > 0)
+        {
+        memcpy(this->Points + 3 * ptOffset * this->PointSize,
+               chunk->Points->GetVoidPointer(0),
+               3 * numPts * this->PointSize);
+        memcpy(this->Normals + 3 * ptOffset,
+               chunk->Normals->GetPointer(0), 3 * numPts * sizeof(float));
+        if (this->TCoords)
+          {
+          memcpy(this->TCoords + 2 * ptOffset,
+                 chunk->TCoords->GetPointer(0), 2 * numPts * sizeof(float));
+          }
+        }
+      for (vtkIdType i = 0; i < numPts; ++i)
+        {
+        this->OutPD->CopyData(this->InPD, chunk->PointIds[i], ptOffset + i);
+        }
+
+      vtkIdType *conn =
+        this->Connectivity + (*this->ConnectivityOffsets)[c];
+      const vtkIdType *strips = chunk->Strips->GetPointer();
+      vtkIdType numCells = static_cast<vtkIdType>(chunk->CellIds.size());
+      vtkIdType cellOffset = (*this->CellOffsets)[c];
+      for (vtkIdType i = 0; i < numCells; ++i)
+        {
+        vtkIdType npts = *strips++;
+        *conn++ = npts;
+        for (vtkIdType j = 0; j < npts; ++j)
+          {
+          *conn++ = *strips++ + ptOffset;
+          }
+        this->OutCD->CopyData(this->InCD, chunk->CellIds[i], cellOffset + i);
+        }
+      }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+// Generates the tubes of a range of lines into a new chunk of the calling
+// thread, with the helper methods of the filter, and skips the lines that
+// the serial path skips.
+class vtkTubeFilterGenerate
+{
+public:
+  vtkTubeFilter *Filter;
+  vtkPoints *InPts;
+  const vtkIdType *Lines;
+  const vtkIdType *Locations;
+  vtkIdType FirstCellId;
+  vtkPointData *InPD;
+  vtkCellData *InCD;
+  vtkDataArray *InScalars;
+  double *Range;
+  vtkDataArray *InVectors;
+  double MaxSpeed;
+  vtkDataArray *InNormals;
+  int GenerateNormals;
+  int PointsType;
+  bool GenerateTCoords;
+  vtkSMPThreadLocal<std::list<vtkTubeFilterChunk> > Chunks;
+  std::vector<const vtkTubeFilterChunk*> SortedChunks;
+
+  // A copy of the current line with its own point ids, so that its normals
+  // are generated independently from the lines sharing its points.
+  vtkSMPThreadLocalObject<vtkPoints> LinePoints;
+  vtkSMPThreadLocalObject<vtkCellArray> Line;
+  vtkSMPThreadLocalObject<vtkFloatArray> LineNormals;
+  vtkSMPThreadLocal<std::vector<vtkIdType> > LineIds;
+
+  void Initialize()
+  {
+    this->LinePoints.Local()->SetDataType(VTK_DOUBLE);
+    this->LineNormals.Local()->SetNumberOfComponents(3);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkTubeFilter *filter = this->Filter;
+    vtkPoints *linePoints = this->LinePoints.Local();
+    vtkCellArray *line = this->Line.Local();
+    vtkFloatArray *lineNormals = this->LineNormals.Local();
+    std::vector<vtkIdType> &lineIds = this->LineIds.Local();
+    std::list<vtkTubeFilterChunk> &chunks = this->Chunks.Local();
+    chunks.push_back(vtkTubeFilterChunk());
+    vtkTubeFilterChunk &chunk = chunks.back();
+    chunk.Begin = begin;
+    chunk.NumberOfSkippedLines = 0;
+    chunk.Points = vtkSmartPointer<vtkPoints>::New();
+    chunk.Points->SetDataType(this->PointsType);
+    chunk.Normals = vtkSmartPointer<vtkFloatArray>::New();
+    chunk.Normals->SetNumberOfComponents(3);
+    if (this->GenerateTCoords)
+      {
+      chunk.TCoords = vtkSmartPointer<vtkFloatArray>::New();
+      chunk.TCoords->SetNumberOfComponents(2);
+      }
+    chunk.Strips = vtkSmartPointer<vtkCellArray>::New();
+
+    int numSides = filter->NumberOfSides;
+    if (!filter->SidesShareVertices)
+      {
+      numSides *= 2;
+      }
+    vtkIdType offset = 0;
+    double x[3];
+    for (vtkIdType lineId = begin; lineId < end; ++lineId)
+      {
+      vtkIdType npts = this->Lines[this->Locations[lineId]];
+      vtkIdType *pts =
+        const_cast<vtkIdType*>(this->Lines + this->Locations[lineId] + 1);
+      if (npts < 2)
+        {
+        ++chunk.NumberOfSkippedLines;
+        continue;
+        }
+
+      vtkDataArray *normals = this->InNormals;
+      vtkIdType *normalIds = pts;
+      if (this->GenerateNormals)
+        {
+        linePoints->SetNumberOfPoints(npts);
+        lineIds.resize(npts);
+        for (vtkIdType i = 0; i < npts; ++i)
+          {
+          this->InPts->GetPoint(pts[i], x);
+          linePoints->SetPoint(i, x);
+          lineIds[i] = i;
+          }
+        line->Reset();
+        line->InsertNextCell(npts, &lineIds[0]);
+        if (!vtkPolyLine::GenerateSlidingNormals(linePoints, line,
+                                                 lineNormals))
+          {
+          ++chunk.NumberOfSkippedLines;
+          continue;
+          }
+        normals = lineNormals;
+        normalIds = &lineIds[0];
+        }
+
+      if (!filter->GeneratePoints(offset, npts, pts, this->InPts,
+                                  chunk.Points, this->InPD, NULL,
+                                  chunk.Normals, this->InScalars,
+                                  this->Range, this->InVectors,
+                                  this->MaxSpeed, normals, normalIds))
+        {
+        continue;
+        }
+      filter->GenerateStrips(offset, npts, pts, this->FirstCellId + lineId,
+                             this->InCD, NULL, chunk.Strips);
+      chunk.CellIds.resize(chunk.Strips->GetNumberOfCells(),
+                           this->FirstCellId + lineId);
+      if (chunk.TCoords)
+        {
+        filter->GenerateTextureCoords(offset, npts, pts, this->InPts,
+                                      this->InScalars, chunk.TCoords);
+        }
+
+      chunk.PointIds.resize(offset);
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        chunk.PointIds.insert(chunk.PointIds.end(), numSides, pts[i]);
+        }
+      if (filter->Capping)
+        {
+        chunk.PointIds.insert(chunk.PointIds.end(), filter->NumberOfSides,
+                              pts[0]);
+        chunk.PointIds.insert(chunk.PointIds.end(), filter->NumberOfSides,
+                              pts[npts-1]);
+        }
+      offset = filter->ComputeOffset(offset, npts);
+      }
+    chunk.NumberOfPoints = offset;
+  }
+
+  // Gathers the chunks of all the threads in line order.
+  void Reduce()
+  {
+    this->SortedChunks.clear();
+    for (vtkSMPThreadLocal<std::list<vtkTubeFilterChunk> >::iterator
+           iter = this->Chunks.begin(); iter != this->Chunks.end(); ++iter)
+      {
+      for (std::list<vtkTubeFilterChunk>::const_iterator
+             chunk = iter->begin(); chunk != iter->end(); ++chunk)
+        {
+        this->SortedChunks.push_back(&(*chunk));
+        }
+      }
+    std::sort(this->SortedChunks.begin(), this->SortedChunks.end(),
+              vtkTubeFilterChunkLess);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Generate the tubes of ranges of lines in parallel, each into its own
+// chunk, then copy the chunks into the output in line order. The output
+// is the same as the serial one.
+void vtkTubeFilter::GenerateTubesInParallel(vtkPolyData *input,
+                                            vtkDataArray *inScalars,
+                                            double range[2],
+                                            vtkDataArray *inVectors,
+                                            double maxSpeed,
+                                            vtkDataArray *inNormals,
+                                            int generateNormals,
+                                            vtkPoints *newPts,
+                                            vtkFloatArray *newNormals,
+                                            vtkFloatArray *newTCoords,
+                                            vtkCellArray *newStrips,
+                                            vtkPointData *outPD,
+                                            vtkCellData *outCD)
+{
+  vtkPointData *pd = input->GetPointData();
+  vtkCellData *cd = input->GetCellData();
+  vtkCellArray *inLines = input->GetLines();
+  vtkIdType numLines = inLines->GetNumberOfCells();
+
+  // The location of each line in the connectivity.
+  std::vector<vtkIdType> locations(numLines);
+  const vtkIdType *lines = inLines->GetPointer();
+  vtkIdType loc = 0;
+  for (vtkIdType i = 0; i < numLines; ++i)
+    {
+    locations[i] = loc;
+    loc += lines[loc] + 1;
+    }
+
+  vtkTubeFilterGenerate generate;
+  generate.Filter = this;
+  generate.InPts = input->GetPoints();
+  generate.Lines = lines;
+  generate.Locations = &locations[0];
+  generate.FirstCellId = input->GetNumberOfVerts();
+  generate.InPD = pd;
+  generate.InCD = cd;
+  generate.InScalars = inScalars;
+  generate.Range = range;
+  generate.InVectors = inVectors;
+  generate.MaxSpeed = maxSpeed;
+  generate.InNormals = inNormals;
+  generate.GenerateNormals = generateNormals;
+  generate.PointsType = newPts->GetDataType();
+  generate.GenerateTCoords = (newTCoords != NULL);
+  vtkSMPTools::For(0, numLines, generate);
+  const std::vector<const vtkTubeFilterChunk*> &chunks =
+    generate.SortedChunks;
+
+  vtkIdType numChunks = static_cast<vtkIdType>(chunks.size());
+  std::vector<vtkIdType> pointOffsets(numChunks + 1, 0);
+  std::vector<vtkIdType> cellOffsets(numChunks + 1, 0);
+  std::vector<vtkIdType> connOffsets(numChunks + 1, 0);
+  vtkIdType numSkipped = 0;
+  for (vtkIdType c = 0; c < numChunks; ++c)
+    {
+    const vtkTubeFilterChunk *chunk = chunks[c];
+    pointOffsets[c+1] = pointOffsets[c] + chunk->NumberOfPoints;
+    cellOffsets[c+1] = cellOffsets[c] +
+      static_cast<vtkIdType>(chunk->CellIds.size());
+    connOffsets[c+1] = connOffsets[c] +
+      chunk->Strips->GetNumberOfConnectivityEntries();
+    numSkipped += chunk->NumberOfSkippedLines;
+    }
+  if (numSkipped > 0)
+    {
+    vtkWarningMacro(<< "Skipped " << numSkipped << " lines with less than "
+                    "two points or without normals");
+    }
+
+  vtkIdType numNewPts = pointOffsets[numChunks];
+  vtkIdType numNewCells = cellOffsets[numChunks];
+  newPts->SetNumberOfPoints(numNewPts);
+  newNormals->SetNumberOfTuples(numNewPts);
+  if (newTCoords)
+    {
+    newTCoords->SetNumberOfTuples(numNewPts);
+    }
+  outPD->SetNumberOfTuples(numNewPts);
+  outCD->SetNumberOfTuples(numNewCells);
+  vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+  connectivity->SetNumberOfValues(connOffsets[numChunks]);
+
+  vtkTubeFilterCopy copy;
+  copy.Chunks = &chunks;
+  copy.PointOffsets = &pointOffsets;
+  copy.CellOffsets = &cellOffsets;
+  copy.ConnectivityOffsets = &connOffsets;
+  copy.Points = static_cast<char*>(newPts->GetVoidPointer(0));
+  copy.PointSize = newPts->GetData()->GetDataTypeSize();
+  copy.Normals = newNormals->GetPointer(0);
+  copy.TCoords = newTCoords ? newTCoords->GetPointer(0) : NULL;
+  copy.Connectivity = connectivity->GetPointer(0);
+  copy.InPD = pd;
+  copy.OutPD = outPD;
+  copy.InCD = cd;
+  copy.OutCD = outCD;
+  if (vtkTubeFilterAreArraysThreadSafe(pd) &&
+      vtkTubeFilterAreArraysThreadSafe(outPD) &&
+      vtkTubeFilterAreArraysThreadSafe(cd) &&
+      vtkTubeFilterAreArraysThreadSafe(outCD))
+    {
+    vtkSMPTools::For(0, numChunks, 1, copy);
+    }
+  else
+    {
+    copy(0, numChunks);
+    }
+
+  newStrips->SetCells(numNewCells, connectivity);
+  connectivity->Delete();
+}
+
 // Description:
 // Return the method of varying tube radius descriptive character string.
 const char *vtkTubeFilter::GetVaryRadiusAsString(void)
@@ -825,4 +1264,6 @@ void vtkTubeFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Texture Length: " << this->TextureLength << endl;
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision
      << endl;
+  os << indent << "Generate In Parallel: "
+     << (this->GenerateInParallel ? "On\n" : "Off\n");
 }
@@ -31,6 +31,10 @@
 // This filter is typically used to create thick or dramatic lines. Another
 // common use is to combine this filter with vtkStreamTracer to generate
 // streamtubes.
+//
+// When GenerateInParallel is on, the tubes of the lines are generated in
+// parallel with vtkSMPTools and copied into the output in line order, so
+// the output is the same as with it off.
 
 // .SECTION Caveats
 // The number of tube sides must be greater than 3. If you wish to use fewer
@@ -185,6 +189,16 @@ public:
   vtkSetMacro(OutputPointsPrecision,int);
   vtkGetMacro(OutputPointsPrecision,int);
 
+  // Description:
+  // Turn on/off generating the tubes in parallel. Each thread generates
+  // the points, normals, texture coordinates and strips of a range of
+  // lines on its own, and the ranges are then copied into the output at
+  // their offsets. Worthwhile with many lines, such as streamlines.
+  // Default is off.
+  vtkSetMacro(GenerateInParallel,int);
+  vtkGetMacro(GenerateInParallel,int);
+  vtkBooleanMacro(GenerateInParallel,int);
+
 protected:
   vtkTubeFilter();
   ~vtkTubeFilter() {}
@@ -204,6 +218,7 @@ protected:
   int Offset;  //control the generation of the sides
   int GenerateTCoords; //control texture coordinate generation
   int OutputPointsPrecision;
+  int GenerateInParallel;
   double TextureLength; //this length is mapped to [0,1) texture space
 
   // Helper methods
@@ -213,6 +228,12 @@ protected:
                      vtkFloatArray *newNormals, vtkDataArray *inScalars,
                      double range[2], vtkDataArray *inVectors, double maxNorm,
                      vtkDataArray *inNormals);
+  int GeneratePoints(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
+                     vtkPoints *inPts, vtkPoints *newPts,
+                     vtkPointData *pd, vtkPointData *outPD,
+                     vtkFloatArray *newNormals, vtkDataArray *inScalars,
+                     double range[2], vtkDataArray *inVectors, double maxNorm,
+                     vtkDataArray *inNormals, vtkIdType *normalIds);
   void GenerateStrips(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
                       vtkIdType inCellId, vtkCellData *cd, vtkCellData *outCD,
                       vtkCellArray *newStrips);
@@ -221,9 +242,25 @@ protected:
                             vtkFloatArray *newTCoords);
   vtkIdType ComputeOffset(vtkIdType offset,vtkIdType npts);
 
+  // Description:
+  // Generate the tubes of all the lines in parallel into the output
+  // arrays, which are allocated but empty.
+  void GenerateTubesInParallel(vtkPolyData *input, vtkDataArray *inScalars,
+                               double range[2], vtkDataArray *inVectors,
+                               double maxSpeed, vtkDataArray *inNormals,
+                               int generateNormals, vtkPoints *newPts,
+                               vtkFloatArray *newNormals,
+                               vtkFloatArray *newTCoords,
+                               vtkCellArray *newStrips,
+                               vtkPointData *outPD, vtkCellData *outCD);
+
   // Helper data members
   double Theta;
 
+//BTX
+  friend class vtkTubeFilterGenerate;
+//ETX
+
 private:
   vtkTubeFilter(const vtkTubeFilter&);  // Not implemented.
   void operator=(const vtkTubeFilter&);  // Not implemented.
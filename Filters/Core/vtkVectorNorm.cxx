@@ -15,6 +15,7 @@
 #include "vtkVectorNorm.h"
 
 #include "vtkCellData.h"
+#include "vtkDataArrayIteratorMacro.h"
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
@@ -28,22 +29,23 @@
 vtkStandardNewMacro(vtkVectorNorm);
 
 
-// The heart of the algorithm plus interface to the SMP tools. Double templated
-// over point and scalar types.
-template <class TV>
+// The heart of the algorithm plus interface to the SMP tools. Templated over
+// the vector value type and the iterator used to traverse the vectors (a raw
+// pointer for standard arrays, see vtkDataArrayIteratorMacro).
+template <class TV, class TI>
 class vtkVectorNormAlgorithm
 {
 public:
   vtkIdType Num;
   double Max;
-  const TV *Vectors;
+  TI Vectors;
   float *Scalars;
 
   // Constructor
   vtkVectorNormAlgorithm();
 
   // Interface between VTK and templated functions.
-  static void Norm(vtkVectorNorm *self, vtkIdType num, TV *vectors,
+  static void Norm(vtkVectorNorm *self, vtkIdType num, TI vectors,
                    float *scalars);
 
   // Interface dot product computation to SMP tools.
@@ -52,17 +54,18 @@ public:
     public:
       vtkVectorNormAlgorithm *Algo;
       vtkSMPThreadLocal<double> Max;
-      NormOp(vtkVectorNormAlgorithm<T> *algo) :
+      NormOp(vtkVectorNormAlgorithm<T,TI> *algo) :
         Algo(algo), Max(VTK_DOUBLE_MIN) {}
       void  operator() (vtkIdType k, vtkIdType end)
         {
         double &max = this->Max.Local();
-        const T *v = this->Algo->Vectors + 3*k;
+        TI v = this->Algo->Vectors + 3*k;
         float *s = this->Algo->Scalars + k;
         for ( ; k < end; ++k)
           {
+          const T v0 = v[0], v1 = v[1], v2 = v[2];
           *s = static_cast<float>(
-            sqrt( static_cast<double>(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]) ) );
+            sqrt( static_cast<double>(v0*v0 + v1*v1 + v2*v2) ) );
           max = ( *s > max ? *s : max );
           s++;
           v += 3;
@@ -75,7 +78,7 @@ public:
     {
     public:
       vtkVectorNormAlgorithm *Algo;
-      MapOp(vtkVectorNormAlgorithm<T> *algo)
+      MapOp(vtkVectorNormAlgorithm<T,TI> *algo)
         { this->Algo = algo; }
       void  operator() (vtkIdType k, vtkIdType end)
         {
@@ -91,8 +94,8 @@ public:
 
 //----------------------------------------------------------------------------
 // Initialized mainly to eliminate compiler warnings.
-template <class TV> vtkVectorNormAlgorithm<TV>::
-vtkVectorNormAlgorithm():Vectors(NULL),Scalars(NULL)
+template <class TV, class TI> vtkVectorNormAlgorithm<TV,TI>::
+vtkVectorNormAlgorithm():Vectors(),Scalars(NULL)
 {
   this->Num = 0;
   this->Max = 0.0;
@@ -100,11 +103,11 @@ vtkVectorNormAlgorithm():Vectors(NULL),Scalars(NULL)
 
 //----------------------------------------------------------------------------
 // Templated class is glue between VTK and templated algorithms.
-template <class TV> void vtkVectorNormAlgorithm<TV>::
-Norm(vtkVectorNorm *self, vtkIdType num, TV *vectors, float *scalars)
+template <class TV, class TI> void vtkVectorNormAlgorithm<TV,TI>::
+Norm(vtkVectorNorm *self, vtkIdType num, TI vectors, float *scalars)
 {
   // Populate data into local storage
-  vtkVectorNormAlgorithm<TV> algo;
+  vtkVectorNormAlgorithm<TV,TI> algo;
 
   algo.Num = num;
   algo.Vectors = vectors;
@@ -231,16 +234,18 @@ int vtkVectorNorm::RequestData(
 
 
 //----------------------------------------------------------------------------
-// All this does it wrap up templated code.
+// All this does it wrap up templated code. The vectors are traversed with
+// iterators so that arrays with a non-standard memory layout (e.g.
+// vtkSOADataArrayTemplate) are read in place.
 void vtkVectorNorm::
 GenerateScalars(vtkIdType num, vtkDataArray *v, vtkFloatArray *s)
 {
   float *scalars = static_cast<float*>(s->GetVoidPointer(0));
-  void *vectors = v->GetVoidPointer(0);
   switch ( v->GetDataType() )
     {
-    vtkTemplateMacro(vtkVectorNormAlgorithm<VTK_TT>::
-                     Norm(this,num,(VTK_TT*)vectors,scalars));
+    vtkDataArrayIteratorMacro(v,
+      (vtkVectorNormAlgorithm<vtkDAValueType,vtkDAIteratorType>::
+       Norm(this,num,vtkDABegin,scalars)));
 
     default:
       break;
@@ -24,9 +24,13 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkWindowedSincPolyDataFilter);
 
 // Construct object with number of iterations 20; passband .1;
@@ -50,6 +54,8 @@ vtkWindowedSincPolyDataFilter::vtkWindowedSincPolyDataFilter()
   this->GenerateErrorVectors = 0;
 
   this->NormalizeCoordinates = 0;
+
+  this->SmoothInParallel = 1;
 }
 
 #define VTK_SIMPLE_VERTEX 0
@@ -64,6 +70,214 @@ typedef struct _vtkMeshVertex
   vtkIdList *edges; // connected edges (list of connected point ids)
 } vtkMeshVertex, *vtkMeshVertexPtr;
 
+namespace
+{
+
+// Finds the neighbors of every edge of the polygons of Mesh and stores
+// what kind of vertex the edge makes of its end points in Codes (one entry
+// per edge, cell after cell), or -1 for an edge seen from a lower cell.
+class vtkWindowedSincClassifyEdges
+{
+public:
+  vtkPolyData *Mesh;
+  vtkPoints *Points;
+  const vtkIdType *Offsets;
+  signed char *Codes;
+  int FeatureEdgeSmoothing;
+  int NonManifoldSmoothing;
+  double CosFeatureAngle;
+  vtkSMPThreadLocalObject<vtkIdList> Neighbors;
+
+  void Initialize()
+  {
+    this->Neighbors.Local()->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *neighbors = this->Neighbors.Local();
+    vtkIdType npts, *pts, numNeiPts, *neiPts, nei;
+    double normal[3], neiNormal[3];
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Mesh->GetCellPoints(cellId, npts, pts);
+      signed char *codes = this->Codes + this->Offsets[cellId];
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        this->Mesh->GetCellEdgeNeighbors(cellId, pts[i], pts[(i+1)%npts],
+                                         neighbors);
+        vtkIdType numNei = neighbors->GetNumberOfIds();
+
+        codes[i] = VTK_SIMPLE_VERTEX;
+        if ( numNei == 0 )
+          {
+          codes[i] = VTK_BOUNDARY_EDGE_VERTEX;
+          }
+        else if ( numNei >= 2 )
+          {
+          // non-manifold case, check nonmanifold smoothing state
+          if (!this->NonManifoldSmoothing)
+            {
+            // check to make sure that this edge hasn't been marked already
+            vtkIdType j;
+            for (j = 0; j < numNei && neighbors->GetId(j) > cellId; ++j)
+              {
+              }
+            if ( j >= numNei )
+              {
+              codes[i] = VTK_FEATURE_EDGE_VERTEX;
+              }
+            }
+          }
+        else if ( (nei = neighbors->GetId(0)) > cellId )
+          {
+          if (this->FeatureEdgeSmoothing)
+            {
+            vtkPolygon::ComputeNormal(this->Points,npts,pts,normal);
+            this->Mesh->GetCellPoints(nei,numNeiPts,neiPts);
+            vtkPolygon::ComputeNormal(this->Points,numNeiPts,neiPts,neiNormal);
+
+            if ( vtkMath::Dot(normal,neiNormal) <= this->CosFeatureAngle )
+              {
+              codes[i] = VTK_FEATURE_EDGE_VERTEX;
+              }
+            }
+          }
+        else // a visited edge
+          {
+          codes[i] = -1;
+          }
+        }
+      }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+// Performs an iteration of the windowed sinc interpolation over a range of
+// points. A point reads the arrays of the previous iterations at its
+// neighbors and only writes its own entries of the others, so all the
+// points of an iteration are independent. Coordinates are single precision
+// and are computed in double precision, as through vtkPoints.
+class vtkWindowedSincIteration
+{
+public:
+  vtkMeshVertexPtr Verts;
+  const float *Zero;
+  float *One;
+  float *Two;
+  float *Three;
+  const double *C;
+  int IterationNumber;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3], y[3], deltaX[3];
+    vtkIdType i, j, npts;
+    int k;
+
+    for (i=begin; i<end; i++)
+      {
+      if ( this->Verts[i].edges == NULL ||
+           (npts = this->Verts[i].edges->GetNumberOfIds()) == 0 )
+        {
+        // point is not allowed to move, just use the old point...
+        // (zero out the Laplacian). Later iterations only need to zero the
+        // new Laplacian, the others being zero since the first one.
+        for (k=0; k<3; k++)
+          {
+          if (this->IterationNumber == 1)
+            {
+            this->One[3*i+k] = 0.0f;
+            this->Three[3*i+k] = this->Zero[3*i+k];
+            }
+          else
+            {
+            this->Two[3*i+k] = 0.0f;
+            }
+          }
+        continue;
+        }
+
+      const vtkIdType *edgeIds = this->Verts[i].edges->GetPointer(0);
+      if (this->IterationNumber == 1)
+        {
+        for (k=0; k<3; k++)
+          {
+          x[k] = this->Zero[3*i+k]; //use current points
+          deltaX[k] = 0.0;
+          }
+
+        // calculate the negative of the laplacian
+        for (j=0; j<npts; j++) //for all connected points
+          {
+          for (k=0; k<3; k++)
+            {
+            y[k] = this->Zero[3*edgeIds[j]+k];
+            deltaX[k] += (x[k] - y[k]) / npts;
+            }
+          }
+        // newPts[one] = newPts[zero] - 0.5 newPts[one]
+        for (k=0; k<3; k++)
+          {
+          deltaX[k] = x[k] - 0.5*deltaX[k];
+          this->One[3*i+k] = static_cast<float>(deltaX[k]);
+          }
+
+        // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
+        for (k=0; k < 3; k++)
+          {
+          deltaX[k] = this->C[0]*x[k] + this->C[1]*deltaX[k];
+          this->Three[3*i+k] = (this->Verts[i].type == VTK_FIXED_VERTEX) ?
+            this->Zero[3*i+k] : static_cast<float>(deltaX[k]);
+          }
+        }
+      else
+        {
+        double p_x0[3], p_x1[3];
+        for (k=0; k<3; k++)
+          {
+          p_x0[k] = this->Zero[3*i+k]; //use current points
+          p_x1[k] = this->One[3*i+k];
+          deltaX[k] = 0.0;
+          }
+
+        // calculate the negative laplacian of x1
+        for (j=0; j<npts; j++)
+          {
+          for (k=0; k<3; k++)
+            {
+            y[k] = this->One[3*edgeIds[j]+k];
+            deltaX[k] += (p_x1[k] - y[k]) / npts;
+            }
+          }//for all connected points
+
+        // Taubin:  x2 = (x1 - x0) + (x1 - x2)
+        for (k=0; k<3; k++)
+          {
+          deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
+          this->Two[3*i+k] = static_cast<float>(deltaX[k]);
+          }
+
+        // smooth the vertex (x3 = x3 + cj x2)
+        if (this->Verts[i].type != VTK_FIXED_VERTEX)
+          {
+          for (k=0;k<3;k++)
+            {
+            double p_x3 = this->Three[3*i+k];
+            this->Three[3*i+k] = static_cast<float>(
+              p_x3 + this->C[this->IterationNumber] * deltaX[k]);
+            }
+          }
+        }
+      }//for all points
+  }
+};
+
+}
+
 int vtkWindowedSincPolyDataFilter::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **inputVector,
@@ -84,7 +298,7 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   vtkIdType npts = 0;
   vtkIdType *pts = 0;
   vtkIdType p1, p2;
-  double x[3], y[3], deltaX[3], xNew[3];
+  int edge;
   double x1[3], x2[3], x3[3], l1[3], l2[3];
   double CosFeatureAngle; //Cosine of angle between adjacent polys
   double CosEdgeAngle; // Cosine of angle between adjacent edges
@@ -98,7 +312,7 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   vtkMeshVertexPtr Verts;
 
   // variables specific to windowed sinc interpolation
-  double theta_pb, k_pb, sigma, p_x0[3], p_x1[3], p_x3[3];
+  double theta_pb, k_pb, sigma;
   double *w, *c, *cprime;
   int zero, one, two, three;
 
@@ -221,18 +435,11 @@ int vtkWindowedSincPolyDataFilter::RequestData(
     { //build cell structure
     vtkCellArray *polys;
     vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    vtkIdType *neiPts;
-    double normal[3], neiNormal[3];
-    vtkIdList *neighbors;
 
     inMesh = vtkPolyData::New();
     inMesh->SetPoints(inPts);
     inMesh->SetPolys(inPolys);
     Mesh = inMesh;
-    neighbors = vtkIdList::New();
-    neighbors->Allocate(VTK_CELL_SIZE);
 
     if ( (numStrips = inStrips->GetNumberOfCells()) > 0 )
       { // convert data to triangles
@@ -246,10 +453,38 @@ int vtkWindowedSincPolyDataFilter::RequestData(
     Mesh->BuildLinks(); //to do neighborhood searching
     polys = Mesh->GetPolys();
 
+    // The neighbors of the edges are independent of each other and are
+    // looked up first; the vertices are then marked in order.
+    vtkIdType numMeshCells = polys->GetNumberOfCells();
+    std::vector<vtkIdType> offsets(numMeshCells + 1, 0);
     for (cellId=0, polys->InitTraversal(); polys->GetNextCell(npts,pts);
          cellId++)
       {
-      for (i=0; i < npts; i++)
+      offsets[cellId+1] = offsets[cellId] + npts;
+      }
+    std::vector<signed char> edgeCodes(offsets[numMeshCells] + 1);
+    vtkWindowedSincClassifyEdges classify;
+    classify.Mesh = Mesh;
+    classify.Points = inPts;
+    classify.Offsets = &offsets[0];
+    classify.Codes = &edgeCodes[0];
+    classify.FeatureEdgeSmoothing = this->FeatureEdgeSmoothing;
+    classify.NonManifoldSmoothing = this->NonManifoldSmoothing;
+    classify.CosFeatureAngle = CosFeatureAngle;
+    if (this->SmoothInParallel)
+      {
+      vtkSMPTools::For(0, numMeshCells, classify);
+      }
+    else
+      {
+      classify.Initialize();
+      classify(0, numMeshCells);
+      }
+    const signed char *code = &edgeCodes[0];
+
+    for (polys->InitTraversal(); polys->GetNextCell(npts,pts); )
+      {
+      for (i=0; i < npts; i++, code++)
         {
         p1 = pts[i];
         p2 = pts[(i+1)%npts];
@@ -267,53 +502,11 @@ int vtkWindowedSincPolyDataFilter::RequestData(
           // Verts[p2].edges = new vtkIdList(6,6);
           }
 
-        Mesh->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
-        numNei = neighbors->GetNumberOfIds();
-
-        edge = VTK_SIMPLE_VERTEX;
-        if ( numNei == 0 )
-          {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-
-        else if ( numNei >= 2 )
-          {
-          // non-manifold case, check nonmanifold smoothing state
-          if (!this->NonManifoldSmoothing)
-            {
-            // check to make sure that this edge hasn't been marked already
-            for (j=0; j < numNei; j++)
-              {
-              if ( neighbors->GetId(j) < cellId )
-                {
-                break;
-                }
-              }
-            if ( j >= numNei )
-              {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-              }
-            }
-          }
-
-        else if ( numNei == 1 && (nei=neighbors->GetId(0)) > cellId )
-          {
-          if (this->FeatureEdgeSmoothing)
-            {
-            vtkPolygon::ComputeNormal(inPts,npts,pts,normal);
-            Mesh->GetCellPoints(nei,numNeiPts,neiPts);
-            vtkPolygon::ComputeNormal(inPts,numNeiPts,neiPts,neiNormal);
-
-            if ( vtkMath::Dot(normal,neiNormal) <= CosFeatureAngle )
-              {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-              }
-            }
-          }
-        else // a visited edge; skip rest of analysis
+        if ( *code < 0 ) // a visited edge; skip rest of analysis
           {
           continue;
           }
+        edge = *code;
 
         if ( edge && Verts[p1].type == VTK_SIMPLE_VERTEX )
           {
@@ -356,7 +549,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(
       {
       toTris->Delete();
       }
-    neighbors->Delete();
     }//if strips or polys
 
   this->UpdateProgress(0.50);
@@ -490,9 +682,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   c = new double[this->NumberOfIterations+1];
   cprime = new double[this->NumberOfIterations+1];
 
-  double zerovector[3];
-  zerovector[0] = zerovector[1] = zerovector[2] = 0.0;
-
   //
   // Calculate the weights and the Chebychev coefficients c.
   //
@@ -578,54 +767,25 @@ int vtkWindowedSincPolyDataFilter::RequestData(
     vtkErrorMacro(<< "An optimal offset for the smoothing filter could not be found.  Unpredictable smoothing/shrinkage may result.");
     }
 
+  // The points are single precision, see vtkWindowedSincIteration.
+  vtkWindowedSincIteration iteration;
+  iteration.Verts = Verts;
+  iteration.C = c;
+
   // first iteration
-  for (i=0; i<numPts; i++)
+  iteration.Zero = static_cast<float*>(newPts[zero]->GetVoidPointer(0));
+  iteration.One = static_cast<float*>(newPts[one]->GetVoidPointer(0));
+  iteration.Two = static_cast<float*>(newPts[two]->GetVoidPointer(0));
+  iteration.Three = static_cast<float*>(newPts[three]->GetVoidPointer(0));
+  iteration.IterationNumber = 1;
+  if (this->SmoothInParallel)
     {
-    if ( Verts[i].edges != NULL &&
-         (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
-      {
-      // point is allowed to move
-      newPts[zero]->GetPoint(i, x); //use current points
-      deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-
-      // calculate the negative of the laplacian
-      for (j=0; j<npts; j++) //for all connected points
-        {
-        newPts[zero]->GetPoint(Verts[i].edges->GetId(j), y);
-        for (k=0; k<3; k++)
-          {
-          deltaX[k] += (x[k] - y[k]) / npts;
-          }
-        }
-      // newPts[one] = newPts[zero] - 0.5 newPts[one]
-      for (k=0; k<3; k++)
-        {
-        deltaX[k] = x[k] - 0.5*deltaX[k];
-        }
-      newPts[one]->SetPoint(i, deltaX);
-
-      // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
-      for (k=0; k < 3; k++)
-        {
-        deltaX[k] = c[0]*x[k] + c[1]*deltaX[k];
-        }
-      if (Verts[i].type == VTK_FIXED_VERTEX)
-        {
-        newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-        }
-      else
-        {
-        newPts[three]->SetPoint(i, deltaX);
-        }
-      }//if can move point
-    else
-      {
-      // point is not allowed to move, just use the old point...
-      // (zero out the Laplacian)
-      newPts[one]->SetPoint(i, zerovector);
-      newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-      }
-    }//for all points
+    vtkSMPTools::For(0, numPts, iteration);
+    }
+  else
+    {
+    iteration(0, numPts);
+    }
 
   // for the rest of the iterations
   for ( iterationNumber=2;
@@ -641,53 +801,18 @@ int vtkWindowedSincPolyDataFilter::RequestData(
         }
       }
 
-    for (i=0; i<numPts; i++)
+    iteration.Zero = static_cast<float*>(newPts[zero]->GetVoidPointer(0));
+    iteration.One = static_cast<float*>(newPts[one]->GetVoidPointer(0));
+    iteration.Two = static_cast<float*>(newPts[two]->GetVoidPointer(0));
+    iteration.IterationNumber = iterationNumber;
+    if (this->SmoothInParallel)
       {
-      if ( Verts[i].edges != NULL &&
-           (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
-        {
-        // point is allowed to move
-        newPts[zero]->GetPoint(i, p_x0); //use current points
-        newPts[one]->GetPoint(i, p_x1);
-
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-
-        // calculate the negative laplacian of x1
-        for (j=0; j<npts; j++)
-          {
-          newPts[one]->GetPoint(Verts[i].edges->GetId(j), y);
-          for (k=0; k<3; k++)
-            {
-            deltaX[k] += (p_x1[k] - y[k]) / npts;
-            }
-          }//for all connected points
-
-        // Taubin:  x2 = (x1 - x0) + (x1 - x2)
-        for (k=0; k<3; k++)
-          {
-          deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
-          }
-        newPts[two]->SetPoint(i, deltaX);
-
-        // smooth the vertex (x3 = x3 + cj x2)
-        newPts[three]->GetPoint(i, p_x3);
-        for (k=0;k<3;k++)
-          {
-          xNew[k] = p_x3[k] + c[iterationNumber] * deltaX[k];
-          }
-        if (Verts[i].type != VTK_FIXED_VERTEX)
-          {
-          newPts[three]->SetPoint(i,xNew);
-          }
-        }//if can move point
-      else
-        {
-        // point is not allowed to move, just use the old point...
-        // (zero out the Laplacian)
-        newPts[one]->SetPoint(i, zerovector);
-        newPts[two]->SetPoint(i, zerovector);
-        }
-      }//for all points
+      vtkSMPTools::For(0, numPts, iteration);
+      }
+    else
+      {
+      iteration(0, numPts);
+      }
 
     // update the pointers. three is always three. all other pointers
     // shift by one and wrap.
@@ -806,4 +931,5 @@ void vtkWindowedSincPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Nonmanifold Smoothing: " << (this->NonManifoldSmoothing ? "On\n" : "Off\n");
   os << indent << "Generate Error Scalars: " << (this->GenerateErrorScalars ? "On\n" : "Off\n");
   os << indent << "Generate Error Vectors: " << (this->GenerateErrorVectors ? "On\n" : "Off\n");
+  os << indent << "Smooth In Parallel: " << (this->SmoothInParallel ? "On\n" : "Off\n");
 }
@@ -218,6 +218,15 @@ public:
   vtkGetMacro(GenerateErrorVectors,int);
   vtkBooleanMacro(GenerateErrorVectors,int);
 
+  // Description:
+  // Turn on/off the use of vtkSMPTools to find the neighbors of the edges
+  // and to run the iterations. The points of an iteration only depend on
+  // the previous iterations, so the output is the same either way. The
+  // default is on.
+  vtkSetMacro(SmoothInParallel,int);
+  vtkGetMacro(SmoothInParallel,int);
+  vtkBooleanMacro(SmoothInParallel,int);
+
  protected:
   vtkWindowedSincPolyDataFilter();
   ~vtkWindowedSincPolyDataFilter() {}
@@ -234,6 +243,7 @@ public:
   int GenerateErrorScalars;
   int GenerateErrorVectors;
   int NormalizeCoordinates;
+  int SmoothInParallel;
 private:
   vtkWindowedSincPolyDataFilter(const vtkWindowedSincPolyDataFilter&);  // Not implemented.
   void operator=(const vtkWindowedSincPolyDataFilter&);  // Not implemented.
@@ -0,0 +1,207 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExtractEdgesParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkExtractEdges and vtkFeatureEdges produce the same lines, in
+// the same order and with the same attributes, with ExtractInParallel on as
+// with it off.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkExtractEdges.h"
+#include "vtkFeatureEdges.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <cmath>
+
+namespace
+{
+
+// Compares the lines of two outputs by the coordinates and the point data
+// of their end points, and by their cell data.
+bool SameLines(vtkPolyData *expected, vtkPolyData *output, const char *what)
+{
+  if (expected->GetNumberOfLines() == 0 ||
+      expected->GetNumberOfLines() != output->GetNumberOfLines())
+    {
+    cerr << what << ": different number of lines" << endl;
+    return false;
+    }
+  vtkDataArray *scalars = expected->GetPointData()->GetScalars();
+  vtkDataArray *outScalars = output->GetPointData()->GetScalars();
+  vtkDataArray *cellScalars = expected->GetCellData()->GetScalars();
+  vtkDataArray *outCellScalars = output->GetCellData()->GetScalars();
+  if (!scalars || !outScalars || !cellScalars || !outCellScalars)
+    {
+    cerr << what << ": missing attributes" << endl;
+    return false;
+    }
+  vtkCellArray *lines = expected->GetLines();
+  vtkCellArray *outLines = output->GetLines();
+  vtkIdType npts, *pts, outNpts, *outPts;
+  vtkIdType lineId = 0;
+  for (lines->InitTraversal(), outLines->InitTraversal();
+       lines->GetNextCell(npts, pts) && outLines->GetNextCell(outNpts, outPts);
+       ++lineId)
+    {
+    if (npts != 2 || outNpts != 2)
+      {
+      cerr << what << ": line " << lineId << " is not a segment" << endl;
+      return false;
+      }
+    for (int i = 0; i < 2; ++i)
+      {
+      double x[3], y[3];
+      expected->GetPoint(pts[i], x);
+      output->GetPoint(outPts[i], y);
+      if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+          scalars->GetComponent(pts[i], 0) !=
+          outScalars->GetComponent(outPts[i], 0))
+        {
+        cerr << what << ": different point in line " << lineId << endl;
+        return false;
+        }
+      }
+    if (cellScalars->GetComponent(lineId, 0) !=
+        outCellScalars->GetComponent(lineId, 0))
+      {
+      cerr << what << ": different cell data in line " << lineId << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+template <class T>
+bool Check(T *filter, const char *what)
+{
+  filter->ExtractInParallelOff();
+  filter->Update();
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(filter->GetOutput());
+
+  filter->ExtractInParallelOn();
+  filter->Update();
+  return SameLines(expected.GetPointer(), filter->GetOutput(), what);
+}
+
+void AddAttributes(vtkDataSet *data)
+{
+  vtkNew<vtkDoubleArray> pointValues, cellValues;
+  pointValues->SetName("PointValues");
+  for (vtkIdType i = 0; i < data->GetNumberOfPoints(); ++i)
+    {
+    double *x = data->GetPoint(i);
+    pointValues->InsertNextValue(x[0] - 2.0 * x[1] + 3.0 * x[2]);
+    }
+  cellValues->SetName("CellValues");
+  for (vtkIdType i = 0; i < data->GetNumberOfCells(); ++i)
+    {
+    cellValues->InsertNextValue(i);
+    }
+  data->GetPointData()->SetScalars(pointValues.GetPointer());
+  data->GetCellData()->SetScalars(cellValues.GetPointer());
+}
+
+// A folded grid of quads and triangles with a boundary, a crease, and a
+// fin of two triangles on one edge making it non-manifold.
+void MakeSurface(vtkPolyData *surface)
+{
+  const int res = 20;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= res; ++j)
+    {
+    for (int i = 0; i <= res; ++i)
+      {
+      points->InsertNextPoint(i, j, std::abs(i - res / 2));
+      }
+    }
+  vtkNew<vtkCellArray> polys;
+  for (vtkIdType j = 0; j < res; ++j)
+    {
+    for (vtkIdType i = 0; i < res; ++i)
+      {
+      vtkIdType p0 = j * (res + 1) + i;
+      vtkIdType quad[4] = { p0, p0 + 1, p0 + res + 2, p0 + res + 1 };
+      if ((i + j) % 3 == 0)
+        {
+        polys->InsertNextCell(3, quad);
+        vtkIdType tri[3] = { p0, quad[2], quad[3] };
+        polys->InsertNextCell(3, tri);
+        }
+      else
+        {
+        polys->InsertNextCell(4, quad);
+        }
+      }
+    }
+  vtkIdType fin = points->InsertNextPoint(3.0, 3.5, 10.0);
+  vtkIdType edge[2] = { 3 * (res + 1) + 3, 4 * (res + 1) + 3 };
+  vtkIdType tri[3] = { edge[0], edge[1], fin };
+  polys->InsertNextCell(3, tri);
+  fin = points->InsertNextPoint(3.0, 3.5, -10.0);
+  tri[2] = fin;
+  polys->InsertNextCell(3, tri);
+
+  surface->SetPoints(points.GetPointer());
+  surface->SetPolys(polys.GetPointer());
+  AddAttributes(surface);
+}
+
+}
+
+int TestExtractEdgesParallel(int, char *[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 7, 0, 5, 0, 4);
+  image->SetSpacing(0.5, 1.0, 2.0);
+  AddAttributes(image.GetPointer());
+  vtkNew<vtkExtractEdges> extract;
+  extract->SetInputData(image.GetPointer());
+  if (!Check(extract.GetPointer(), "vtkExtractEdges on image data"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkPolyData> surface;
+  MakeSurface(surface.GetPointer());
+  extract->SetInputData(surface.GetPointer());
+  if (!Check(extract.GetPointer(), "vtkExtractEdges on polygons"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkFeatureEdges> features;
+  features->SetInputData(surface.GetPointer());
+  features->ColoringOff();
+  features->SetFeatureAngle(20.0);
+  if (!Check(features.GetPointer(), "vtkFeatureEdges"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  features->FeatureEdgesOff();
+  features->BoundaryEdgesOff();
+  features->ManifoldEdgesOn();
+  if (!Check(features.GetPointer(), "vtkFeatureEdges manifold edges"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
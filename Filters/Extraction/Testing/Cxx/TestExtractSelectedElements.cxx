@@ -0,0 +1,368 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExtractSelectedElements.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the unstructured grids extracted by the ids, thresholds and
+// frustum selections hold the points and cells marked by the insidedness
+// arrays of the same selections with PreserveTopology on.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkExtractSelectedFrustum.h"
+#include "vtkExtractSelectedIds.h"
+#include "vtkExtractSelectedThresholds.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSelection.h"
+#include "vtkSelectionNode.h"
+#include "vtkSignedCharArray.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+namespace
+{
+const int Size = 12;
+
+// An image with point and cell scalars, and the same cells as hexahedra
+// and polyhedra in an unstructured grid.
+void MakeInputs(vtkImageData *image, vtkUnstructuredGrid *grid)
+{
+  image->SetDimensions(Size, Size, Size);
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    image->GetPoint(i, x);
+    pointScalars->InsertNextValue(x[0] * x[0] + 2.0 * x[1] - x[2]);
+    }
+  image->GetPointData()->SetScalars(pointScalars.GetPointer());
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  for (vtkIdType i = 0; i < image->GetNumberOfCells(); ++i)
+    {
+    cellScalars->InsertNextValue((i * 37) % 101);
+    }
+  image->GetCellData()->SetScalars(cellScalars.GetPointer());
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    points->SetPoint(i, image->GetPoint(i));
+    }
+  grid->SetPoints(points.GetPointer());
+  grid->Allocate(image->GetNumberOfCells());
+  const int hex[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
+  const int faces[6][4] = { {0,3,2,1}, {4,5,6,7}, {0,1,5,4},
+                            {1,2,6,5}, {2,3,7,6}, {3,0,4,7} };
+  vtkNew<vtkIdList> voxel;
+  for (vtkIdType cellId = 0; cellId < image->GetNumberOfCells(); ++cellId)
+    {
+    image->GetCellPoints(cellId, voxel.GetPointer());
+    vtkIdType ids[8], stream[30];
+    for (int i = 0; i < 8; ++i)
+      {
+      ids[i] = voxel->GetId(hex[i]);
+      }
+    if (cellId % 7)
+      {
+      grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+      continue;
+      }
+    for (int f = 0; f < 6; ++f)
+      {
+      stream[5 * f] = 4;
+      for (int i = 0; i < 4; ++i)
+        {
+        stream[5 * f + 1 + i] = ids[faces[f][i]];
+        }
+      }
+    grid->InsertNextCell(VTK_POLYHEDRON, 8, ids, 6, stream);
+    }
+  grid->GetPointData()->ShallowCopy(image->GetPointData());
+  grid->GetCellData()->ShallowCopy(image->GetCellData());
+}
+
+vtkSmartPointer<vtkSelection> MakeSelection(int contentType, int fieldType,
+                                            vtkAbstractArray *list,
+                                            int containingCells, int inverse)
+{
+  vtkSmartPointer<vtkSelection> selection =
+    vtkSmartPointer<vtkSelection>::New();
+  vtkNew<vtkSelectionNode> node;
+  node->SetContentType(contentType);
+  node->SetFieldType(fieldType);
+  node->SetSelectionList(list);
+  node->GetProperties()->Set(vtkSelectionNode::CONTAINING_CELLS(),
+                             containingCells);
+  node->GetProperties()->Set(vtkSelectionNode::INVERSE(), inverse);
+  selection->AddNode(node.GetPointer());
+  return selection;
+}
+
+vtkSmartPointer<vtkDataSet> Run(vtkExtractSelectionBase *filter,
+                                vtkDataSet *input, vtkSelection *selection,
+                                bool preserveTopology)
+{
+  filter->SetInputData(0, input);
+  if (selection)
+    {
+    filter->SetInputData(1, selection);
+    }
+  filter->SetPreserveTopology(preserveTopology);
+  filter->Update();
+  vtkDataSet *output = vtkDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  vtkSmartPointer<vtkDataSet> copy;
+  copy.TakeReference(output->NewInstance());
+  copy->DeepCopy(output);
+  return copy;
+}
+
+// Extract with and without PreserveTopology and compare the extracted grid
+// with the insidedness arrays. Returns the number of extracted cells, or
+// -1 on failure.
+vtkIdType Check(vtkExtractSelectionBase *filter, vtkDataSet *input,
+                vtkSelection *selection, bool extractCells)
+{
+  vtkSmartPointer<vtkDataSet> marked = Run(filter, input, selection, true);
+  vtkSmartPointer<vtkDataSet> extracted = Run(filter, input, selection, false);
+  vtkUnstructuredGrid *output = vtkUnstructuredGrid::SafeDownCast(extracted);
+  vtkSignedCharArray *pointIn = vtkSignedCharArray::SafeDownCast(
+    marked->GetPointData()->GetArray("vtkInsidedness"));
+  vtkSignedCharArray *cellIn = vtkSignedCharArray::SafeDownCast(
+    marked->GetCellData()->GetArray("vtkInsidedness"));
+  if (!output || !pointIn || (extractCells && !cellIn))
+    {
+    std::cerr << "Missing output or insidedness arrays" << std::endl;
+    return -1;
+    }
+
+  // The points marked, and with cells those of the marked cells.
+  std::vector<bool> expected(input->GetNumberOfPoints());
+  vtkIdType numExpected = 0;
+  vtkNew<vtkIdList> cellPts;
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+    {
+    expected[i] = pointIn->GetValue(i) > 0;
+    }
+  for (vtkIdType i = 0; extractCells && i < input->GetNumberOfCells(); ++i)
+    {
+    if (cellIn->GetValue(i) > 0)
+      {
+      input->GetCellPoints(i, cellPts.GetPointer());
+      for (vtkIdType j = 0; j < cellPts->GetNumberOfIds(); ++j)
+        {
+        expected[cellPts->GetId(j)] = true;
+        }
+      }
+    }
+  numExpected = std::count(expected.begin(), expected.end(), true);
+
+  vtkIdTypeArray *pointIds = vtkIdTypeArray::SafeDownCast(
+    output->GetPointData()->GetArray("vtkOriginalPointIds"));
+  vtkDataArray *pointScalars = output->GetPointData()->GetArray("PointScalars");
+  if (output->GetNumberOfPoints() != numExpected || !pointIds ||
+      !pointScalars)
+    {
+    std::cerr << output->GetNumberOfPoints() << " points extracted instead of "
+              << numExpected << std::endl;
+    return -1;
+    }
+  vtkDataArray *inPointScalars = input->GetPointData()->GetArray("PointScalars");
+  for (vtkIdType i = 0; i < numExpected; ++i)
+    {
+    vtkIdType id = pointIds->GetValue(i);
+    double x[3], y[3];
+    output->GetPoint(i, x);
+    input->GetPoint(id, y);
+    if (!expected[id] || (i > 0 && id <= pointIds->GetValue(i - 1)) ||
+        x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+        pointScalars->GetTuple1(i) != inPointScalars->GetTuple1(id))
+      {
+      std::cerr << "Bad point " << i << std::endl;
+      return -1;
+      }
+    }
+
+  if (!extractCells)
+    {
+    for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+      {
+      output->GetCellPoints(i, cellPts.GetPointer());
+      if (output->GetCellType(i) != VTK_VERTEX ||
+          cellPts->GetNumberOfIds() != 1 || cellPts->GetId(0) != i)
+        {
+        std::cerr << "Bad vertex " << i << std::endl;
+        return -1;
+        }
+      }
+    return output->GetNumberOfCells() == numExpected ? 0 : -1;
+    }
+
+  vtkIdType numCells = 0;
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+    {
+    numCells += cellIn->GetValue(i) > 0 ? 1 : 0;
+    }
+  vtkIdTypeArray *cellIds = vtkIdTypeArray::SafeDownCast(
+    output->GetCellData()->GetArray("vtkOriginalCellIds"));
+  vtkDataArray *cellScalars = output->GetCellData()->GetArray("CellScalars");
+  if (output->GetNumberOfCells() != numCells || !cellIds || !cellScalars)
+    {
+    std::cerr << output->GetNumberOfCells() << " cells extracted instead of "
+              << numCells << std::endl;
+    return -1;
+    }
+  vtkDataArray *inCellScalars = input->GetCellData()->GetArray("CellScalars");
+  vtkNew<vtkIdList> inCellPts;
+  for (vtkIdType i = 0; i < numCells; ++i)
+    {
+    vtkIdType id = cellIds->GetValue(i);
+    output->GetCellPoints(i, cellPts.GetPointer());
+    input->GetCellPoints(id, inCellPts.GetPointer());
+    std::vector<vtkIdType> ids, inIds;
+    for (vtkIdType j = 0; j < cellPts->GetNumberOfIds(); ++j)
+      {
+      ids.push_back(pointIds->GetValue(cellPts->GetId(j)));
+      }
+    for (vtkIdType j = 0; j < inCellPts->GetNumberOfIds(); ++j)
+      {
+      inIds.push_back(inCellPts->GetId(j));
+      }
+    if (output->GetCellType(i) == VTK_POLYHEDRON)
+      {
+      std::sort(ids.begin(), ids.end());
+      std::sort(inIds.begin(), inIds.end());
+      }
+    if (cellIn->GetValue(id) <= 0 || (i > 0 && id <= cellIds->GetValue(i - 1)) ||
+        output->GetCellType(i) != input->GetCellType(id) || ids != inIds ||
+        cellScalars->GetTuple1(i) != inCellScalars->GetTuple1(id))
+      {
+      std::cerr << "Bad cell " << i << std::endl;
+      return -1;
+      }
+    }
+  return numCells;
+}
+
+int TestInput(vtkDataSet *input)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+
+  // Thresholds on the cell values, on the point values, and on the point
+  // values of the cells.
+  vtkNew<vtkExtractSelectedThresholds> thresholds;
+  vtkNew<vtkDoubleArray> cellRange;
+  cellRange->SetName("CellScalars");
+  cellRange->InsertNextValue(20.0);
+  cellRange->InsertNextValue(60.0);
+  vtkIdType selected = Check(thresholds.GetPointer(), input,
+    MakeSelection(vtkSelectionNode::THRESHOLDS, vtkSelectionNode::CELL,
+                  cellRange.GetPointer(), 0, 0), true);
+  TEST_ASSERT(selected > 0 && selected < numCells, "Bad cell thresholds");
+  vtkSmartPointer<vtkDataSet> inverse = Run(thresholds.GetPointer(), input,
+    MakeSelection(vtkSelectionNode::THRESHOLDS, vtkSelectionNode::CELL,
+                  cellRange.GetPointer(), 0, 1), false);
+  TEST_ASSERT(inverse->GetNumberOfCells() + selected == numCells,
+              "Bad inverse cell thresholds");
+
+  vtkNew<vtkDoubleArray> pointRange;
+  pointRange->SetName("PointScalars");
+  pointRange->InsertNextValue(10.0);
+  pointRange->InsertNextValue(30.0);
+  TEST_ASSERT(Check(thresholds.GetPointer(), input,
+    MakeSelection(vtkSelectionNode::THRESHOLDS, vtkSelectionNode::POINT,
+                  pointRange.GetPointer(), 0, 0), false) == 0,
+    "Bad point thresholds");
+  selected = Check(thresholds.GetPointer(), input,
+    MakeSelection(vtkSelectionNode::THRESHOLDS, vtkSelectionNode::POINT,
+                  pointRange.GetPointer(), 1, 0), true);
+  TEST_ASSERT(selected > 0 && selected < numCells,
+              "Bad point thresholds of cells");
+
+  // Ids of cells and of points.
+  vtkNew<vtkExtractSelectedIds> ids;
+  vtkNew<vtkIdTypeArray> cellIds;
+  for (vtkIdType i = 0; i < numCells; i += 3)
+    {
+    cellIds->InsertNextValue(i);
+    }
+  selected = Check(ids.GetPointer(), input,
+    MakeSelection(vtkSelectionNode::INDICES, vtkSelectionNode::CELL,
+                  cellIds.GetPointer(), 0, 0), true);
+  TEST_ASSERT(selected == cellIds->GetNumberOfTuples(), "Bad cell ids");
+  vtkNew<vtkIdTypeArray> pointIds;
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); i += 50)
+    {
+    pointIds->InsertNextValue(i);
+    }
+  TEST_ASSERT(Check(ids.GetPointer(), input,
+    MakeSelection(vtkSelectionNode::INDICES, vtkSelectionNode::POINT,
+                  pointIds.GetPointer(), 0, 0), false) == 0,
+    "Bad point ids");
+  selected = Check(ids.GetPointer(), input,
+    MakeSelection(vtkSelectionNode::INDICES, vtkSelectionNode::POINT,
+                  pointIds.GetPointer(), 1, 0), true);
+  TEST_ASSERT(selected > 0 && selected < numCells, "Bad point ids of cells");
+
+  // A frustum across the input, looking down the z axis.
+  vtkNew<vtkExtractSelectedFrustum> frustum;
+  double vertices[32] = { 2.5, 2.5, 20.0, 1.0,    0.5, 0.5, -10.0, 1.0,
+                          2.5, 6.5, 20.0, 1.0,    0.5, 8.5, -10.0, 1.0,
+                          6.5, 2.5, 20.0, 1.0,    8.5, 0.5, -10.0, 1.0,
+                          6.5, 6.5, 20.0, 1.0,    8.5, 8.5, -10.0, 1.0 };
+  frustum->CreateFrustum(vertices);
+  frustum->SetFieldType(vtkSelectionNode::CELL);
+  selected = Check(frustum.GetPointer(), input, NULL, true);
+  TEST_ASSERT(selected > 0 && selected < numCells, "Bad frustum cells");
+  frustum->SetFieldType(vtkSelectionNode::POINT);
+  TEST_ASSERT(Check(frustum.GetPointer(), input, NULL, false) == 0,
+              "Bad frustum points");
+  frustum->SetContainingCells(1);
+  selected = Check(frustum.GetPointer(), input, NULL, true);
+  TEST_ASSERT(selected > 0 && selected < numCells,
+              "Bad frustum points of cells");
+  return EXIT_SUCCESS;
+}
+}
+
+int TestExtractSelectedElements(int, char *[])
+{
+  vtkNew<vtkImageData> image;
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeInputs(image.GetPointer(), grid.GetPointer());
+  if (TestInput(image.GetPointer()) != EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+  return TestInput(grid.GetPointer());
+}
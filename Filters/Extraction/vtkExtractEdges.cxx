@@ -26,14 +26,242 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkIncrementalPointLocator.h"
+#include "vtkIdTypeArray.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
+
+#include <algorithm>
+#include <list>
+#include <vector>
 
 vtkStandardNewMacro(vtkExtractEdges);
 
+namespace
+{
+typedef vtkEdgeTuple<vtkIdType, vtkIdType> vtkExtractEdgesTuple;
+
+bool vtkExtractEdgesAreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(i));
+    if (!array || array->GetDataType() == VTK_BIT ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// The edge segments generated by a contiguous range of cells, in cell
+// order: the end points of each segment and the cell that produced it.
+struct vtkExtractEdgesChunk
+{
+  vtkIdType Begin;
+  std::vector<vtkIdType> Segments;
+  std::vector<vtkIdType> CellIds;
+};
+
+bool vtkExtractEdgesChunkLess(const vtkExtractEdgesChunk *a,
+                              const vtkExtractEdgesChunk *b)
+{
+  return a->Begin < b->Begin;
+}
+
+// Generates the edge segments of the cells, tessellating the higher-order
+// edges as the serial path does.
+class vtkExtractEdgesGenerate
+{
+public:
+  vtkDataSet *Input;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkIdList> EdgeIds;
+  vtkSMPThreadLocalObject<vtkPoints> EdgePts;
+  vtkSMPThreadLocal<std::list<vtkExtractEdgesChunk> > Chunks;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell *cell = this->Cell.Local();
+    vtkIdList *edgeIds = this->EdgeIds.Local();
+    vtkPoints *edgePts = this->EdgePts.Local();
+    std::list<vtkExtractEdgesChunk> &chunks = this->Chunks.Local();
+    chunks.push_back(vtkExtractEdgesChunk());
+    vtkExtractEdgesChunk &chunk = chunks.back();
+    chunk.Begin = begin;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Input->GetCell(cellId, cell);
+      int numCellEdges = cell->GetNumberOfEdges();
+      for (int edgeNum = 0; edgeNum < numCellEdges; ++edgeNum)
+        {
+        vtkCell *edge = cell->GetEdge(edgeNum);
+        if (!edge->IsLinear())
+          {
+          edge->Triangulate(0, edgeIds, edgePts);
+          for (vtkIdType i = 0; i < edgeIds->GetNumberOfIds() / 2; ++i)
+            {
+            chunk.Segments.push_back(edgeIds->GetId(2*i));
+            chunk.Segments.push_back(edgeIds->GetId(2*i+1));
+            chunk.CellIds.push_back(cellId);
+            }
+          }
+        else
+          {
+          vtkIdList *ids = edge->PointIds;
+          for (vtkIdType i = 1; i < ids->GetNumberOfIds(); ++i)
+            {
+            chunk.Segments.push_back(ids->GetId(i-1));
+            chunk.Segments.push_back(ids->GetId(i));
+            chunk.CellIds.push_back(cellId);
+            }
+          }
+        }
+      }
+  }
+};
+
+// Copies the chunks into the global arrays of segments and edge tuples,
+// where the data of a tuple is the index of its segment.
+class vtkExtractEdgesGather
+{
+public:
+  const std::vector<const vtkExtractEdgesChunk*> *Chunks;
+  const std::vector<vtkIdType> *Offsets;
+  vtkIdType *Segments;
+  vtkIdType *CellIds;
+  vtkExtractEdgesTuple *Edges;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType c = begin; c < end; ++c)
+      {
+      const vtkExtractEdgesChunk *chunk = (*this->Chunks)[c];
+      vtkIdType offset = (*this->Offsets)[c];
+      vtkIdType numSegments = static_cast<vtkIdType>(chunk->CellIds.size());
+      for (vtkIdType i = 0; i < numSegments; ++i)
+        {
+        vtkIdType seg = offset + i;
+        this->Segments[2*seg] = chunk->Segments[2*i];
+        this->Segments[2*seg+1] = chunk->Segments[2*i+1];
+        this->CellIds[seg] = chunk->CellIds[i];
+        this->Edges[seg] = vtkExtractEdgesTuple(chunk->Segments[2*i],
+                                                chunk->Segments[2*i+1], seg);
+        }
+      }
+  }
+};
+
+// Keeps the first segment of each group of equal edges, and marks its
+// points as used.
+class vtkExtractEdgesMarkKept
+{
+public:
+  const vtkExtractEdgesTuple *Edges;
+  const vtkIdType *EdgeOffsets;
+  vtkIdType *Kept;
+  vtkIdType *UsedPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType e = begin; e < end; ++e)
+      {
+      const vtkExtractEdgesTuple &edge = this->Edges[this->EdgeOffsets[e]];
+      this->Kept[edge.Data] = 1;
+      this->UsedPoints[edge.V0] = 1;
+      this->UsedPoints[edge.V1] = 1;
+      }
+  }
+};
+
+// Records the input id of each used point.
+class vtkExtractEdgesOriginalIds
+{
+public:
+  const vtkIdType *PointMap;
+  vtkIdType *OriginalIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      if (this->PointMap[ptId] < this->PointMap[ptId+1])
+        {
+        this->OriginalIds[this->PointMap[ptId]] = ptId;
+        }
+      }
+  }
+};
+
+// Gathers the used input points and their data.
+class vtkExtractEdgesCopyPoints
+{
+public:
+  vtkDataSet *Input;
+  const vtkIdType *OriginalIds;
+  vtkPoints *OutPoints;
+  vtkPointData *InPD;
+  vtkPointData *OutPD;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      vtkIdType inId = this->OriginalIds[ptId];
+      this->Input->GetPoint(inId, x);
+      this->OutPoints->SetPoint(ptId, x);
+      if (this->OutPD)
+        {
+        this->OutPD->CopyData(this->InPD, inId, ptId);
+        }
+      }
+  }
+};
+
+// Writes the kept segments as lines, oriented as their first occurrence,
+// with the data of the cell that produced it.
+class vtkExtractEdgesCopyLines
+{
+public:
+  const vtkIdType *Segments;
+  const vtkIdType *CellIds;
+  const vtkIdType *LineIds;
+  const vtkIdType *PointMap;
+  vtkIdType *Connectivity;
+  vtkCellData *InCD;
+  vtkCellData *OutCD;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType seg = begin; seg < end; ++seg)
+      {
+      vtkIdType lineId = this->LineIds[seg];
+      if (lineId == this->LineIds[seg+1])
+        {
+        continue;
+        }
+      vtkIdType *line = this->Connectivity + 3*lineId;
+      line[0] = 2;
+      line[1] = this->PointMap[this->Segments[2*seg]];
+      line[2] = this->PointMap[this->Segments[2*seg+1]];
+      if (this->OutCD)
+        {
+        this->OutCD->CopyData(this->InCD, this->CellIds[seg], lineId);
+        }
+      }
+  }
+};
+}
+
 //----------------------------------------------------------------------------
 // Construct object.
 vtkExtractEdges::vtkExtractEdges()
 {
   this->Locator = NULL;
+  this->ExtractInParallel = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -87,6 +315,11 @@ int vtkExtractEdges::RequestData(
     return 1;
     }
 
+  if ( this->ExtractInParallel )
+    {
+    return this->ExtractEdgesInParallel(input, output);
+    }
+
   // Set up processing
   //
   edgeTable = vtkEdgeTable::New();
@@ -208,6 +441,153 @@ int vtkExtractEdges::RequestData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Generate the edge segments of all the cells in parallel, in cell order,
+// sort them to find the first occurrence of each edge, and write these as
+// lines in the order in which the serial path inserts them.
+int vtkExtractEdges::ExtractEdgesInParallel(vtkDataSet *input,
+                                            vtkPolyData *output)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+
+  // Build the cell structure of the input before the threads query it.
+  vtkGenericCell *cell = vtkGenericCell::New();
+  input->GetCell(0, cell);
+  cell->Delete();
+
+  vtkExtractEdgesGenerate generate;
+  generate.Input = input;
+  vtkSMPTools::For(0, numCells, generate);
+
+  std::vector<const vtkExtractEdgesChunk*> chunks;
+  for (vtkSMPThreadLocal<std::list<vtkExtractEdgesChunk> >::iterator
+         iter = generate.Chunks.begin(); iter != generate.Chunks.end(); ++iter)
+    {
+    for (std::list<vtkExtractEdgesChunk>::const_iterator chunk = iter->begin();
+         chunk != iter->end(); ++chunk)
+      {
+      chunks.push_back(&(*chunk));
+      }
+    }
+  std::sort(chunks.begin(), chunks.end(), vtkExtractEdgesChunkLess);
+  vtkIdType numChunks = static_cast<vtkIdType>(chunks.size());
+  std::vector<vtkIdType> offsets(numChunks + 1, 0);
+  for (vtkIdType c = 0; c < numChunks; ++c)
+    {
+    offsets[c+1] = offsets[c] +
+      static_cast<vtkIdType>(chunks[c]->CellIds.size());
+    }
+  vtkIdType numSegments = offsets[numChunks];
+  if (numSegments < 1)
+    {
+    return 1;
+    }
+
+  std::vector<vtkIdType> segments(2*numSegments);
+  std::vector<vtkIdType> cellIds(numSegments);
+  std::vector<vtkExtractEdgesTuple> edges(numSegments);
+  vtkExtractEdgesGather gather;
+  gather.Chunks = &chunks;
+  gather.Offsets = &offsets;
+  gather.Segments = &segments[0];
+  gather.CellIds = &cellIds[0];
+  gather.Edges = &edges[0];
+  vtkSMPTools::For(0, numChunks, 1, gather);
+  for (vtkSMPThreadLocal<std::list<vtkExtractEdgesChunk> >::iterator
+         iter = generate.Chunks.begin(); iter != generate.Chunks.end(); ++iter)
+    {
+    iter->clear();
+    }
+
+  // Sort the edges. The first segment of each group of equal edges is the
+  // first occurrence of the edge, which becomes a line.
+  vtkStaticEdgeLocatorTemplate<vtkIdType, vtkIdType> locator;
+  vtkIdType numEdges = locator.MergeEdges(numSegments, &edges[0]);
+
+  // After the scans, segment i is kept if lineIds[i] < lineIds[i+1], and
+  // point i is used if pointMap[i] < pointMap[i+1].
+  std::vector<vtkIdType> lineIds(numSegments + 1, 0);
+  std::vector<vtkIdType> pointMap(numPts + 1, 0);
+  vtkExtractEdgesMarkKept mark;
+  mark.Edges = locator.GetEdges();
+  mark.EdgeOffsets = locator.GetEdgeOffsets();
+  mark.Kept = &lineIds[0];
+  mark.UsedPoints = &pointMap[0];
+  vtkSMPTools::For(0, numEdges, mark);
+  vtkSMPTools::ExclusiveScan(lineIds.begin(), lineIds.end(),
+                             lineIds.begin(), vtkIdType(0));
+  vtkSMPTools::ExclusiveScan(pointMap.begin(), pointMap.end(),
+                             pointMap.begin(), vtkIdType(0));
+  vtkIdType numNewPts = pointMap[numPts];
+
+  std::vector<vtkIdType> originalIds(numNewPts);
+  vtkExtractEdgesOriginalIds original;
+  original.PointMap = &pointMap[0];
+  original.OriginalIds = &originalIds[0];
+  vtkSMPTools::For(0, numPts, original);
+
+  vtkPointData *pd = input->GetPointData();
+  vtkPointData *outPD = output->GetPointData();
+  vtkCellData *cd = input->GetCellData();
+  vtkCellData *outCD = output->GetCellData();
+
+  vtkPoints *newPts = vtkPoints::New();
+  newPts->SetNumberOfPoints(numNewPts);
+  outPD->CopyAllocate(pd, numNewPts);
+  outPD->SetNumberOfTuples(numNewPts);
+  vtkExtractEdgesCopyPoints copyPoints;
+  copyPoints.Input = input;
+  copyPoints.OriginalIds = &originalIds[0];
+  copyPoints.OutPoints = newPts;
+  copyPoints.InPD = pd;
+  copyPoints.OutPD = outPD;
+  if (vtkExtractEdgesAreArraysThreadSafe(pd) &&
+      vtkExtractEdgesAreArraysThreadSafe(outPD))
+    {
+    vtkSMPTools::For(0, numNewPts, copyPoints);
+    }
+  else
+    {
+    copyPoints(0, numNewPts);
+    }
+
+  vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+  connectivity->SetNumberOfValues(3*numEdges);
+  outCD->CopyAllocate(cd, numEdges);
+  outCD->SetNumberOfTuples(numEdges);
+  vtkExtractEdgesCopyLines copyLines;
+  copyLines.Segments = &segments[0];
+  copyLines.CellIds = &cellIds[0];
+  copyLines.LineIds = &lineIds[0];
+  copyLines.PointMap = &pointMap[0];
+  copyLines.Connectivity = connectivity->GetPointer(0);
+  copyLines.InCD = cd;
+  copyLines.OutCD = outCD;
+  if (vtkExtractEdgesAreArraysThreadSafe(cd) &&
+      vtkExtractEdgesAreArraysThreadSafe(outCD))
+    {
+    vtkSMPTools::For(0, numSegments, copyLines);
+    }
+  else
+    {
+    copyLines(0, numSegments);
+    }
+
+  vtkCellArray *newLines = vtkCellArray::New();
+  newLines->SetCells(numEdges, connectivity);
+  connectivity->Delete();
+
+  vtkDebugMacro(<<"Created " << numEdges << " edges");
+
+  output->SetPoints(newPts);
+  newPts->Delete();
+  output->SetLines(newLines);
+  newLines->Delete();
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 // Specify a spatial locator for merging points. By
 // default an instance of vtkMergePoints is used.
@@ -261,6 +641,8 @@ void vtkExtractEdges::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "Locator: (none)\n";
     }
+  os << indent << "Extract In Parallel: "
+     << (this->ExtractInParallel ? "On\n" : "Off\n");
 }
 
 //----------------------------------------------------------------------------
@@ -16,6 +16,13 @@
 // .SECTION Description
 // vtkExtractEdges is a filter to extract edges from a dataset. Edges
 // are extracted as lines or polylines.
+//
+// When ExtractInParallel is on, the edges of the cells are generated in
+// parallel and the duplicate edges are removed by sorting them (see
+// vtkStaticEdgeLocatorTemplate) instead of inserting them one by one into
+// a vtkEdgeTable. The output lines are the same, in the same order, but
+// the locator is not used: the output points are the input points used by
+// the edges, in input order, and coincident input points are not merged.
 
 // .SECTION See Also
 // vtkFeatureEdges
@@ -26,6 +33,7 @@
 #include "vtkFiltersExtractionModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+class vtkDataSet;
 class vtkIncrementalPointLocator;
 
 class VTKFILTERSEXTRACTION_EXPORT vtkExtractEdges : public vtkPolyDataAlgorithm
@@ -49,6 +57,12 @@ public:
   // Return MTime also considering the locator.
   unsigned long GetMTime();
 
+  // Description:
+  // Turn on/off the parallel extraction of the edges. The default is off.
+  vtkSetMacro(ExtractInParallel,int);
+  vtkGetMacro(ExtractInParallel,int);
+  vtkBooleanMacro(ExtractInParallel,int);
+
 protected:
   vtkExtractEdges();
   ~vtkExtractEdges();
@@ -58,7 +72,11 @@ protected:
 
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  // Extract the edges with vtkSMPTools and a sort of the edges.
+  int ExtractEdgesInParallel(vtkDataSet *input, vtkPolyData *output);
+
   vtkIncrementalPointLocator *Locator;
+  int ExtractInParallel;
 private:
   vtkExtractEdges(const vtkExtractEdges&);  // Not implemented.
   void operator=(const vtkExtractEdges&);  // Not implemented.
@@ -17,6 +17,7 @@
 #include "vtkCell.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkImplicitFunction.h"
@@ -25,6 +26,8 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkSmartPointer.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -146,13 +149,32 @@ int vtkExtractGeometry::RequestData(
   outputCD->CopyAllocate(cd);
   vtkFloatArray *newScalars = NULL;
 
-  if ( ! this->ExtractBoundaryCells )
+  // Evaluate the implicit function at all the points at once when they are
+  // stored explicitly, which may be done in parallel.
+  vtkDoubleArray *values = vtkDoubleArray::New();
+  vtkPointSet *pointSet = vtkPointSet::SafeDownCast(input);
+  if ( pointSet && pointSet->GetPoints() )
+    {
+    this->ImplicitFunction->FunctionValue(pointSet->GetPoints()->GetData(),
+                                          values);
+    }
+  else
     {
+    values->SetNumberOfValues(numPts);
     for ( ptId=0; ptId < numPts; ptId++ )
       {
       input->GetPoint(ptId, x);
-      if ( (this->ImplicitFunction->FunctionValue(x)*multiplier) < 0.0 )
+      values->SetValue(ptId, this->ImplicitFunction->FunctionValue(x));
+      }
+    }
+
+  if ( ! this->ExtractBoundaryCells )
+    {
+    for ( ptId=0; ptId < numPts; ptId++ )
+      {
+      if ( (values->GetValue(ptId)*multiplier) < 0.0 )
         {
+        input->GetPoint(ptId, x);
         newId = newPts->InsertNextPoint(x);
         pointMap[ptId] = newId;
         outputPD->CopyData(pd,ptId,newId);
@@ -168,11 +190,11 @@ int vtkExtractGeometry::RequestData(
 
     for (ptId=0; ptId < numPts; ptId++ )
       {
-      input->GetPoint(ptId, x);
-      val = this->ImplicitFunction->FunctionValue(x) * multiplier;
+      val = values->GetValue(ptId) * multiplier;
       newScalars->SetValue(ptId, val);
       }
     }
+  values->Delete();
 
   // Now loop over all cells to see whether they are inside implicit
   // function (or on boundary if ExtractBoundaryCells is on).
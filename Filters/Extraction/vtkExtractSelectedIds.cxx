@@ -753,27 +753,24 @@ int vtkExtractSelectedIds::ExtractCells(
   idxArray->Delete();
   labelArray->Delete();
 
-  if (!passThrough)
+  if (!passThrough && output->GetDataObjectType() == VTK_POLY_DATA)
     {
     vtkIdType *pointMap = new vtkIdType[numPts]; // maps old point ids into new
     vtkExtractSelectedIdsCopyPoints(input, output,
       pointInArray->GetPointer(0), pointMap);
     this->UpdateProgress(0.75);
-    if (output->GetDataObjectType() == VTK_POLY_DATA)
-      {
-      vtkExtractSelectedIdsCopyCells<vtkPolyData>(input,
-        vtkPolyData::SafeDownCast(output),
-        cellInArray->GetPointer(0), pointMap);
-      }
-    else
-      {
-      vtkExtractSelectedIdsCopyCells<vtkUnstructuredGrid>(input,
-        vtkUnstructuredGrid::SafeDownCast(output),
-        cellInArray->GetPointer(0), pointMap);
-      }
+    vtkExtractSelectedIdsCopyCells<vtkPolyData>(input,
+      vtkPolyData::SafeDownCast(output),
+      cellInArray->GetPointer(0), pointMap);
     delete [] pointMap;
     this->UpdateProgress(1.0);
     }
+  else if (!passThrough)
+    {
+    this->ExtractElements(input, pointInArray->GetPointer(0),
+      cellInArray->GetPointer(0), vtkUnstructuredGrid::SafeDownCast(output));
+    this->UpdateProgress(1.0);
+    }
 
   output->Squeeze();
 
@@ -951,7 +948,7 @@ int vtkExtractSelectedIds::ExtractPoints(
   idxArray->Delete();
   labelArray->Delete();
 
-  if (!passThrough)
+  if (!passThrough && output->GetDataObjectType() == VTK_POLY_DATA)
     {
     vtkIdType *pointMap = new vtkIdType[numPts]; // maps old point ids into new
     vtkExtractSelectedIdsCopyPoints(input, output,
@@ -959,46 +956,33 @@ int vtkExtractSelectedIds::ExtractPoints(
     this->UpdateProgress(0.75);
     if (containingCells)
       {
-      if (output->GetDataObjectType() == VTK_POLY_DATA)
-        {
-        vtkExtractSelectedIdsCopyCells<vtkPolyData>(input,
-          vtkPolyData::SafeDownCast(output), cellInArray->GetPointer(0),
-          pointMap);
-        }
-      else
-        {
-        vtkExtractSelectedIdsCopyCells<vtkUnstructuredGrid>(input,
-          vtkUnstructuredGrid::SafeDownCast(output),
-          cellInArray->GetPointer(0), pointMap);
-        }
+      vtkExtractSelectedIdsCopyCells<vtkPolyData>(input,
+        vtkPolyData::SafeDownCast(output), cellInArray->GetPointer(0),
+        pointMap);
       }
     else
       {
       numPts = output->GetNumberOfPoints();
-      if (output->GetDataObjectType() == VTK_POLY_DATA)
+      vtkPolyData* outputPD = vtkPolyData::SafeDownCast(output);
+      vtkCellArray *newVerts = vtkCellArray::New();
+      newVerts->Allocate(newVerts->EstimateSize(numPts,1));
+      for (i = 0; i < numPts; ++i)
         {
-        vtkPolyData* outputPD = vtkPolyData::SafeDownCast(output);
-        vtkCellArray *newVerts = vtkCellArray::New();
-        newVerts->Allocate(newVerts->EstimateSize(numPts,1));
-        for (i = 0; i < numPts; ++i)
-          {
-          newVerts->InsertNextCell(1, &i);
-          }
-        outputPD->SetVerts(newVerts);
-        newVerts->Delete();
-        }
-      else
-        {
-        vtkUnstructuredGrid* outputUG = vtkUnstructuredGrid::SafeDownCast(output);
-        outputUG->Allocate(numPts);
-        for (i = 0; i < numPts; ++i)
-          {
-          outputUG->InsertNextCell(VTK_VERTEX, 1, &i);
-          }
+        newVerts->InsertNextCell(1, &i);
         }
+      outputPD->SetVerts(newVerts);
+      newVerts->Delete();
       }
-      this->UpdateProgress(1.0);
-      delete [] pointMap;
+    this->UpdateProgress(1.0);
+    delete [] pointMap;
+    }
+  else if (!passThrough)
+    {
+    // without containing cells, a vertex is made for each point
+    this->ExtractElements(input, pointInArray->GetPointer(0),
+      containingCells ? cellInArray->GetPointer(0) : NULL,
+      vtkUnstructuredGrid::SafeDownCast(output));
+    this->UpdateProgress(1.0);
     }
   output->Squeeze();
   return 1;
@@ -27,15 +27,126 @@
 #include "vtkSelection.h"
 #include "vtkSelectionNode.h"
 #include "vtkSignedCharArray.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
 #include "vtkThreshold.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkExtractSelectedThresholds);
 
+namespace
+{
+// Marks the cells, and their points when thresholding by point values, that
+// satisfy the threshold criterion.
+struct vtkExtractSelectedThresholdsCells
+{
+  vtkDataSet *Input;
+  vtkDataArray *Scalars;
+  int ComponentNumber;
+  vtkDataArray *Limits;
+  int UsePointScalars;
+  int Inverse;
+  int PassThrough;
+  signed char Flag;
+  signed char *PointInside;
+  signed char *CellInside;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellPts = this->CellPoints.Local();
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      this->Input->GetCellPoints(cellId, cellPts);
+      vtkIdType numCellPts = cellPts->GetNumberOfIds();
+      int keepCell;
+
+      // BUG: This code misses the case where the threshold is contained
+      // completely within the cell but none of its points are inside
+      // the range.  Consider as an example the threshold range [1, 2]
+      // with a cell [0, 3].
+      if (this->UsePointScalars)
+        {
+        keepCell = 0;
+        int totalAbove = 0;
+        int totalBelow = 0;
+        for (vtkIdType i = 0;
+             (i < numCellPts) && (this->PassThrough || !keepCell);
+             i++)
+          {
+          int above = 0;
+          int below = 0;
+          vtkIdType ptId = cellPts->GetId(i);
+          int inside = vtkExtractSelectedThresholds::EvaluateValue(
+            this->Scalars, this->ComponentNumber, ptId, this->Limits,
+            &above, &below, NULL);
+          totalAbove += above;
+          totalBelow += below;
+          // Have we detected a cell that straddles the threshold?
+          if ((!inside) && (totalAbove && totalBelow))
+            {
+            inside = 1;
+            }
+          if (this->PassThrough && (inside ^ this->Inverse))
+            {
+            // Cells sharing the point store the same value.
+            this->PointInside[ptId] = this->Flag;
+            this->CellInside[cellId] = this->Flag;
+            }
+          keepCell |= inside;
+          }
+        }
+      else //use cell scalars
+        {
+        keepCell = vtkExtractSelectedThresholds::EvaluateValue(
+          this->Scalars, this->ComponentNumber, cellId, this->Limits);
+        if (this->PassThrough && (keepCell ^ this->Inverse))
+          {
+          this->CellInside[cellId] = this->Flag;
+          }
+        }
+
+      if (!this->PassThrough &&
+          (numCellPts > 0) &&
+          (keepCell + this->Inverse == 1)) // Poor man's XOR
+        {
+        // satisfied thresholding (also non-empty cell, i.e. not VTK_EMPTY_CELL)
+        this->CellInside[cellId] = this->Flag;
+        }
+      }
+  }
+};
+
+// Marks the points that satisfy the threshold criterion.
+struct vtkExtractSelectedThresholdsPoints
+{
+  vtkDataArray *Scalars;
+  int ComponentNumber;
+  vtkDataArray *Limits;
+  int Inverse;
+  signed char Flag;
+  signed char *PointInside;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      int keepPoint = vtkExtractSelectedThresholds::EvaluateValue(
+        this->Scalars, this->ComponentNumber, ptId, this->Limits);
+      if (keepPoint ^ this->Inverse)
+        {
+        this->PointInside[ptId] = this->Flag;
+        }
+      }
+  }
+};
+}
+
 //----------------------------------------------------------------------------
 vtkExtractSelectedThresholds::vtkExtractSelectedThresholds()
 {
@@ -222,182 +333,73 @@ int vtkExtractSelectedThresholds::ExtractCells(
     comp_no = sel->GetProperties()->Get(vtkSelectionNode::COMPONENT_NUMBER());
     }
 
-  vtkIdType cellId, newCellId;
-  vtkIdList *cellPts, *pointMap = NULL;
-  vtkIdList *newCellPts = NULL;
-  vtkCell *cell = 0;
-  vtkPoints *newPoints = 0;
-  vtkIdType i, ptId, newId, numPts, numCells;
-  vtkIdType numCellPts;
-  double x[3];
-
-  vtkPointData *pd=input->GetPointData(), *outPD=output->GetPointData();
-  vtkCellData *cd=input->GetCellData(), *outCD=output->GetCellData();
-  int keepCell;
-
-
-  outPD->CopyGlobalIdsOn();
-  outPD->CopyAllocate(pd);
-  outCD->CopyGlobalIdsOn();
-  outCD->CopyAllocate(cd);
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
 
-  numPts = input->GetNumberOfPoints();
-  numCells = input->GetNumberOfCells();
+  vtkPointData *outPD = output->GetPointData();
+  vtkCellData *outCD = output->GetCellData();
 
-  vtkDataSet *outputDS = output;
-  vtkSignedCharArray *pointInArray = NULL;
-  vtkSignedCharArray *cellInArray = NULL;
+  // The points and cells are marked in the insidedness arrays; without
+  // passThrough, those marked positive are then extracted.
+  signed char flag = inverse ? 1 : -1;
+  if (!passThrough)
+    {
+    flag = -1;
+    }
 
-  vtkUnstructuredGrid *outputUG = NULL;
-  vtkIdTypeArray *originalCellIds = NULL;
-  vtkIdTypeArray *originalPointIds = NULL;
+  vtkSmartPointer<vtkSignedCharArray> pointInArray =
+    vtkSmartPointer<vtkSignedCharArray>::New();
+  pointInArray->SetNumberOfComponents(1);
+  pointInArray->SetNumberOfTuples(numPts);
+  std::fill(pointInArray->GetPointer(0), pointInArray->GetPointer(0) + numPts,
+            flag);
 
-  signed char flag = inverse ? 1 : -1;
+  vtkSmartPointer<vtkSignedCharArray> cellInArray =
+    vtkSmartPointer<vtkSignedCharArray>::New();
+  cellInArray->SetNumberOfComponents(1);
+  cellInArray->SetNumberOfTuples(numCells);
+  std::fill(cellInArray->GetPointer(0), cellInArray->GetPointer(0) + numCells,
+            flag);
 
   if (passThrough)
     {
-    outputDS->ShallowCopy(input);
+    output->ShallowCopy(input);
 
-    pointInArray = vtkSignedCharArray::New();
-    pointInArray->SetNumberOfComponents(1);
-    pointInArray->SetNumberOfTuples(numPts);
-    for (i=0; i < numPts; i++)
-      {
-      pointInArray->SetValue(i, flag);
-      }
     pointInArray->SetName("vtkInsidedness");
     outPD->AddArray(pointInArray);
     outPD->SetScalars(pointInArray);
 
-    cellInArray = vtkSignedCharArray::New();
-    cellInArray->SetNumberOfComponents(1);
-    cellInArray->SetNumberOfTuples(numCells);
-    for (i=0; i < numCells; i++)
-      {
-      cellInArray->SetValue(i, flag);
-      }
     cellInArray->SetName("vtkInsidedness");
     outCD->AddArray(cellInArray);
     outCD->SetScalars(cellInArray);
     }
-  else
-    {
-    outputUG = vtkUnstructuredGrid::SafeDownCast(output);
-    outputUG->Allocate(input->GetNumberOfCells());
-    newPoints = vtkPoints::New();
-    newPoints->Allocate(numPts);
-
-    pointMap = vtkIdList::New(); //maps old point ids into new
-    pointMap->SetNumberOfIds(numPts);
-    for (i=0; i < numPts; i++)
-      {
-      pointMap->SetId(i,-1);
-      }
-
-    newCellPts = vtkIdList::New();
-
-    originalCellIds = vtkIdTypeArray::New();
-    originalCellIds->SetName("vtkOriginalCellIds");
-    originalCellIds->SetNumberOfComponents(1);
-    outCD->AddArray(originalCellIds);
-
-    originalPointIds = vtkIdTypeArray::New();
-    originalPointIds->SetName("vtkOriginalPointIds");
-    originalPointIds->SetNumberOfComponents(1);
-    outPD->AddArray(originalPointIds);
-    originalPointIds->Delete();
-    }
 
   flag = -flag;
 
-  // Check that the scalars of each cell satisfy the threshold criterion
-  for (cellId=0; cellId < input->GetNumberOfCells(); cellId++)
+  // Check that the scalars of each cell satisfy the threshold criterion.
+  // GetCellPoints() is thread safe once called from a single thread.
+  if (numCells > 0)
     {
-    cell = input->GetCell(cellId);
-    cellPts = cell->GetPointIds();
-    numCellPts = cell->GetNumberOfPoints();
-
-    // BUG: This code misses the case where the threshold is contained
-    // completely within the cell but none of its points are inside
-    // the range.  Consider as an example the threshold range [1, 2]
-    // with a cell [0, 3].
-    if ( usePointScalars )
-      {
-      keepCell = 0;
-      int totalAbove = 0;
-      int totalBelow = 0;
-      for ( i=0;
-            (i < numCellPts) && (passThrough || !keepCell);
-            i++)
-        {
-        int above = 0;
-        int below = 0;
-        ptId = cellPts->GetId(i);
-        int inside = this->EvaluateValue(
-          inScalars, comp_no, ptId, lims, &above, &below, NULL);
-        totalAbove += above;
-        totalBelow += below;
-        // Have we detected a cell that straddles the threshold?
-        if ((!inside) && (totalAbove && totalBelow))
-          {
-          inside = 1;
-          }
-        if (passThrough && (inside ^ inverse))
-          {
-          pointInArray->SetValue(ptId, flag);
-          cellInArray->SetValue(cellId, flag);
-          }
-        keepCell |= inside;
-        }
-      }
-    else //use cell scalars
-      {
-      keepCell = this->EvaluateValue(inScalars, comp_no, cellId, lims);
-      if (passThrough && (keepCell ^ inverse))
-        {
-        cellInArray->SetValue(cellId, flag);
-        }
-      }
-
-    if (  !passThrough &&
-          (numCellPts > 0) &&
-          (keepCell + inverse == 1) ) // Poor man's XOR
-      {
-      // satisfied thresholding (also non-empty cell, i.e. not VTK_EMPTY_CELL)
-      originalCellIds->InsertNextValue(cellId);
-
-      for (i=0; i < numCellPts; i++)
-        {
-        ptId = cellPts->GetId(i);
-        if ( (newId = pointMap->GetId(ptId)) < 0 )
-          {
-          input->GetPoint(ptId, x);
-          newId = newPoints->InsertNextPoint(x);
-          pointMap->SetId(ptId,newId);
-          outPD->CopyData(pd,ptId,newId);
-          originalPointIds->InsertNextValue(ptId);
-          }
-        newCellPts->InsertId(i,newId);
-        }
-      newCellId = outputUG->InsertNextCell(cell->GetCellType(),newCellPts);
-      outCD->CopyData(cd,cellId,newCellId);
-      newCellPts->Reset();
-      } // satisfied thresholding
-    } // for all cells
-
-  // now clean up / update ourselves
-  if (passThrough)
-    {
-    pointInArray->Delete();
-    cellInArray->Delete();
+    vtkSmartPointer<vtkIdList> cellPts = vtkSmartPointer<vtkIdList>::New();
+    input->GetCellPoints(0, cellPts);
     }
-  else
+  vtkExtractSelectedThresholdsCells functor;
+  functor.Input = input;
+  functor.Scalars = inScalars;
+  functor.ComponentNumber = comp_no;
+  functor.Limits = lims;
+  functor.UsePointScalars = usePointScalars;
+  functor.Inverse = inverse;
+  functor.PassThrough = passThrough;
+  functor.Flag = flag;
+  functor.PointInside = pointInArray->GetPointer(0);
+  functor.CellInside = cellInArray->GetPointer(0);
+  vtkSMPTools::For(0, numCells, functor);
+
+  if (!passThrough)
     {
-    outputUG->SetPoints(newPoints);
-    newPoints->Delete();
-    pointMap->Delete();
-    newCellPts->Delete();
-    originalCellIds->Delete();
+    this->ExtractElements(input, NULL, cellInArray->GetPointer(0),
+                          vtkUnstructuredGrid::SafeDownCast(output));
     }
 
   output->Squeeze();
@@ -467,82 +469,45 @@ int vtkExtractSelectedThresholds::ExtractPoints(
     }
 
   vtkIdType numPts = input->GetNumberOfPoints();
-  vtkPointData *inputPD = input->GetPointData();
   vtkPointData *outPD = output->GetPointData();
 
-  vtkDataSet *outputDS = output;
-  vtkSignedCharArray *pointInArray = NULL;
-
-  vtkUnstructuredGrid * outputUG = NULL;
-  vtkPoints *newPts = vtkPoints::New();
-
-  vtkIdTypeArray* originalPointIds = 0;
-
+  // The points are marked in the insidedness array; without passThrough,
+  // those marked positive are then extracted.
   signed char flag = inverse ? 1 : -1;
+  if (!passThrough)
+    {
+    flag = -1;
+    }
+
+  vtkSmartPointer<vtkSignedCharArray> pointInArray =
+    vtkSmartPointer<vtkSignedCharArray>::New();
+  pointInArray->SetNumberOfComponents(1);
+  pointInArray->SetNumberOfTuples(numPts);
+  std::fill(pointInArray->GetPointer(0), pointInArray->GetPointer(0) + numPts,
+            flag);
 
   if (passThrough)
     {
-    outputDS->ShallowCopy(input);
+    output->ShallowCopy(input);
 
-    pointInArray = vtkSignedCharArray::New();
-    pointInArray->SetNumberOfComponents(1);
-    pointInArray->SetNumberOfTuples(numPts);
-    for (vtkIdType i=0; i < numPts; i++)
-      {
-      pointInArray->SetValue(i, flag);
-      }
     pointInArray->SetName("vtkInsidedness");
     outPD->AddArray(pointInArray);
     outPD->SetScalars(pointInArray);
     }
-  else
-    {
-    outputUG = vtkUnstructuredGrid::SafeDownCast(output);
-    outputUG->Allocate(numPts);
-
-    newPts->Allocate(numPts);
-    outputUG->SetPoints(newPts);
-
-    outPD->CopyGlobalIdsOn();
-    outPD->CopyAllocate(inputPD);
-
-    originalPointIds = vtkIdTypeArray::New();
-    originalPointIds->SetNumberOfComponents(1);
-    originalPointIds->SetName("vtkOriginalPointIds");
-    outPD->AddArray(originalPointIds);
-    originalPointIds->Delete();
-    }
 
   flag = -flag;
 
-  vtkIdType outPtCnt = 0;
-  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
-    {
-    int keepPoint = this->EvaluateValue( inScalars, comp_no, ptId, lims );
-    if (keepPoint ^ inverse)
-      {
-      if (passThrough)
-        {
-        pointInArray->SetValue(ptId, flag);
-        }
-      else
-        {
-        double X[4];
-        input->GetPoint(ptId, X);
-        newPts->InsertNextPoint(X);
-        outPD->CopyData(inputPD, ptId, outPtCnt);
-        originalPointIds->InsertNextValue(ptId);
-        outputUG->InsertNextCell(VTK_VERTEX, 1, &outPtCnt);
-        outPtCnt++;
-        }
-      }
-    }
+  vtkExtractSelectedThresholdsPoints functor =
+    { inScalars, comp_no, lims, inverse, flag, pointInArray->GetPointer(0) };
+  vtkSMPTools::For(0, numPts, functor);
 
-  if (passThrough)
+  if (!passThrough)
     {
-    pointInArray->Delete();
+    // produce a new vtk_vertex cell for each accepted point
+    this->ExtractElements(input, pointInArray->GetPointer(0), NULL,
+                          vtkUnstructuredGrid::SafeDownCast(output));
     }
-  newPts->Delete();
+
   output->Squeeze();
   return 1;
 }
@@ -719,7 +684,8 @@ int vtkExtractSelectedThresholds::EvaluateValue(
     {
     // use magnitude.
     int numComps = scalars->GetNumberOfComponents();
-    const double *tuple = scalars->GetTuple(id);
+    std::vector<double> tuple(numComps);
+    scalars->GetTuple(id, &tuple[0]);
     for (int cc=0; cc < numComps; cc++)
       {
       value += tuple[cc]*tuple[cc];
@@ -755,7 +721,8 @@ int vtkExtractSelectedThresholds::EvaluateValue(
     {
     // use magnitude.
     int numComps = scalars->GetNumberOfComponents();
-    const double *tuple = scalars->GetTuple(id);
+    std::vector<double> tuple(numComps);
+    scalars->GetTuple(id, &tuple[0]);
     for (int cc=0; cc < numComps; cc++)
       {
       value += tuple[cc]*tuple[cc];
@@ -29,6 +29,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkSetGet.h"
 #include "vtkFloatArray.h"
+#include "vtkIntArray.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include <cassert>
@@ -378,6 +379,63 @@ int TestStreaklineFilter()
 }
 
 
+// Many particles are advected together: check that they come out in seed
+// order, each where it ends when traced alone.
+int TestParticleTracerMany()
+{
+  vtkNew<TestTimeSource> imageSource;
+  imageSource->SetBoundingBox(-1,1,-1,1,-1,1);
+
+  const int numSeeds = 100;
+  vtkNew<vtkPoints> points;
+  for(int i=0; i<numSeeds; i++)
+    {
+    points->InsertNextPoint(0.05+0.004*i, -0.4+0.008*i, 0.1);
+    }
+  vtkNew<vtkPolyData> seeds;
+  seeds->SetPoints(points.GetPointer());
+
+  vtkNew<vtkParticleTracer> filter;
+  filter->SetInputConnection(0,imageSource->GetOutputPort());
+  filter->SetInputData(1,seeds.GetPointer());
+  filter->SetStartTime(0.0);
+  filter->SetTerminationTime(3.0);
+  filter->Update();
+
+  vtkPolyData* out = filter->GetOutput();
+  EXPECT(out->GetNumberOfPoints()==numSeeds,"Wrong # of particles: "<<out->GetNumberOfPoints());
+  vtkIntArray* injectedIds = vtkIntArray::SafeDownCast(out->GetPointData()->GetArray("InjectedPointId"));
+  EXPECT(injectedIds!=NULL,"Missing injected point ids");
+  for(int i=0; i<numSeeds; i++)
+    {
+    EXPECT(injectedIds->GetValue(i)==i,"Wrong particle order at "<<i);
+    }
+
+  for(int i=0; i<numSeeds; i+=11)
+    {
+    vtkNew<vtkPoints> point;
+    point->InsertNextPoint(points->GetPoint(i));
+    vtkNew<vtkPolyData> seed;
+    seed->SetPoints(point.GetPointer());
+
+    vtkNew<vtkParticleTracer> single;
+    single->SetInputConnection(0,imageSource->GetOutputPort());
+    single->SetInputData(1,seed.GetPointer());
+    single->SetStartTime(0.0);
+    single->SetTerminationTime(3.0);
+    single->Update();
+    EXPECT(single->GetOutput()->GetNumberOfPoints()==1,"Wrong # of particles");
+
+    double p[3],q[3];
+    out->GetPoint(i,p);
+    single->GetOutput()->GetPoint(0,q);
+    EXPECT(vtkMath::Distance2BetweenPoints(p,q)<1e-20,"Wrong position of particle "<<i);
+    }
+
+  return EXIT_SUCCESS;
+}
+
+
 int TestParticleTracers(int, char*[])
 {
   vtkPoints* pts(NULL);
@@ -464,6 +522,7 @@ int TestParticleTracers(int, char*[])
 
   EXPECT(TestParticlePathFilter()==EXIT_SUCCESS,"");
   EXPECT(TestStreaklineFilter()==EXIT_SUCCESS,"");
+  EXPECT(TestParticleTracerMany()==EXIT_SUCCESS,"");
 
   return EXIT_SUCCESS;
 }
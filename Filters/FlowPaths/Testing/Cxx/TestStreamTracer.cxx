@@ -23,6 +23,11 @@
 #include "vtkPointData.h"
 #include "vtkSmartPointer.h"
 #include "vtkDoubleArray.h"
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkUnstructuredGrid.h"
 #include <cassert>
 
 int TestFieldNames(int, char*[])
@@ -104,9 +109,120 @@ int TestFieldNames(int, char*[])
   return EXIT_SUCCESS;
 }
 
+// Several seeds are integrated in parallel: check that the streamlines are
+// in seed order and the same as when each seed is traced on its own.
+int TestSeedOrder(vtkDataSet* input, int interpolatorType)
+{
+  vtkNew<vtkPolyData> seeds;
+  vtkNew<vtkPoints> seedPoints;
+  for(int j=-4; j<=4; j+=2)
+    {
+    for(int i=-8; i<=8; i+=4)
+      {
+      seedPoints->InsertNextPoint(i, j, 0.5*j);
+      }
+    }
+  seeds->SetPoints(seedPoints.GetPointer());
+
+  vtkNew<vtkStreamTracer> tracer;
+  tracer->SetInputData(input);
+  tracer->SetSourceData(seeds.GetPointer());
+  tracer->SetInterpolatorType(interpolatorType);
+  tracer->SetMaximumPropagation(20.0);
+  tracer->Update();
+  vtkPolyData* traces = tracer->GetOutput();
+  vtkDataArray* seedIds = traces->GetCellData()->GetArray("SeedIds");
+  if(!seedIds || traces->GetNumberOfLines() < 2)
+    {
+    cerr << "Missing streamlines" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkPolyData> seed;
+  vtkNew<vtkPoints> seedPoint;
+  seedPoint->SetNumberOfPoints(1);
+  seed->SetPoints(seedPoint.GetPointer());
+  vtkNew<vtkStreamTracer> seedTracer;
+  seedTracer->SetInputData(input);
+  seedTracer->SetSourceData(seed.GetPointer());
+  seedTracer->SetInterpolatorType(interpolatorType);
+  seedTracer->SetMaximumPropagation(20.0);
+
+  vtkNew<vtkIdList> pts, seedPts;
+  vtkIdType lastSeedId = -1;
+  for(vtkIdType cellId=0; cellId<traces->GetNumberOfCells(); cellId++)
+    {
+    vtkIdType seedId = static_cast<vtkIdType>(seedIds->GetTuple1(cellId));
+    if(seedId <= lastSeedId)
+      {
+      cerr << "Streamline " << cellId << " is out of order" << endl;
+      return EXIT_FAILURE;
+      }
+    lastSeedId = seedId;
+
+    seedPoint->SetPoint(0, seedPoints->GetPoint(seedId));
+    seed->Modified();
+    seedTracer->Update();
+    vtkPolyData* seedTrace = seedTracer->GetOutput();
+    traces->GetCellPoints(cellId, pts.GetPointer());
+    if(seedTrace->GetNumberOfCells() != 1)
+      {
+      cerr << "No streamline from seed " << seedId << endl;
+      return EXIT_FAILURE;
+      }
+    seedTrace->GetCellPoints(0, seedPts.GetPointer());
+    if(pts->GetNumberOfIds() != seedPts->GetNumberOfIds())
+      {
+      cerr << "Streamline " << cellId << " has " << pts->GetNumberOfIds()
+           << " points instead of " << seedPts->GetNumberOfIds() << endl;
+      return EXIT_FAILURE;
+      }
+    for(vtkIdType i=0; i<pts->GetNumberOfIds(); i++)
+      {
+      double x[3], y[3];
+      traces->GetPoint(pts->GetId(i), x);
+      seedTrace->GetPoint(seedPts->GetId(i), y);
+      if(x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+        {
+        cerr << "Streamline " << cellId << " differs at point " << i << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
+
+int TestSeedOrder(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-10,10,-10,10,-10,10);
+
+  vtkNew<vtkImageGradient> gradient;
+  gradient->SetDimensionality(3);
+  gradient->SetInputConnection(source->GetOutputPort());
+  gradient->Update();
+  vtkImageData* image = vtkImageData::SafeDownCast(gradient->GetOutputDataObject(0));
+  image->GetPointData()->SetActiveVectors("RTDataGradient");
+
+  vtkNew<vtkAppendFilter> toGrid;
+  toGrid->SetInputData(image);
+  toGrid->Update();
+  vtkUnstructuredGrid* grid = toGrid->GetOutput();
+
+  if(TestSeedOrder(image, vtkStreamTracer::INTERPOLATOR_WITH_DATASET_POINT_LOCATOR)
+     || TestSeedOrder(grid, vtkStreamTracer::INTERPOLATOR_WITH_DATASET_POINT_LOCATOR)
+     || TestSeedOrder(grid, vtkStreamTracer::INTERPOLATOR_WITH_CELL_LOCATOR))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
+
 int TestStreamTracer(int n, char* a[])
 {
   int numFailures(0);
   numFailures += TestFieldNames(n,a);
+  numFailures += TestSeedOrder(n,a);
   return numFailures;
 }
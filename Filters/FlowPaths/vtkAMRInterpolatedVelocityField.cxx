@@ -1,79 +1,17 @@
 #include "vtkAMRInterpolatedVelocityField.h"
+#include "vtkAMRInformation.h"
 #include "vtkObjectFactory.h"
 #include "vtkUniformGrid.h"
 #include "vtkOverlappingAMR.h"
 #include <cassert>
 //----------------------------------------------------------------------------
-namespace
-{
-  bool Inside(double q[3], double gbounds[6])
-  {
-    if ((q[0] < gbounds[0]) || (q[0] > gbounds[1]) ||
-        (q[1] < gbounds[2]) || (q[1] > gbounds[3]) ||
-        (q[2] < gbounds[4]) || (q[2] > gbounds[5]))
-      {
-      return false;
-      }
-    else
-      {
-      return true;
-      }
-  }
-
-  bool FindInLevel(double q[3], vtkOverlappingAMR *amrds, int level, unsigned int& gridId)
-  {
-    for(unsigned int i = 0; i < amrds->GetNumberOfDataSets(level); i++ )
-      {
-      double gbounds[6];
-      amrds->GetBounds(level,i,gbounds);
-      bool inside = Inside(q,gbounds);
-      if(inside)
-        {
-        gridId = i;
-        return true;
-        }
-      }
-    return false;
-  }
-
-
-};
-
 bool vtkAMRInterpolatedVelocityField::FindGrid(double q[3],vtkOverlappingAMR *amrds,
                                                unsigned int& level, unsigned int& gridId)
 {
-  if (!FindInLevel(q, amrds, 0,gridId))
-    {
-    return false;
-    }
-
-  unsigned int maxLevels = amrds->GetNumberOfLevels();
-  for(level=0; level<maxLevels;level++)
-    {
-    unsigned int n;
-    unsigned int *children = amrds->GetChildren(level, gridId,n);
-    if (children == NULL)
-      {
-      break;
-      }
-    unsigned int i;
-    for (i = 0; i < n; i++)
-      {
-      double bb[6];
-      amrds->GetBounds(level+1, children[i],bb);
-      if(Inside(q,bb))
-        {
-        gridId = children[i];
-        break;
-        }
-      }
-    if(i>=n)
-      {
-      break;
-      }
-    }
-  return true;
+  // The AMR meta data locates the grids with its per-level block locator
+  return amrds->GetAMRInfo()->FindGrid(q, level, gridId);
 }
+
 vtkStandardNewMacro(vtkAMRInterpolatedVelocityField);
 
 
@@ -172,6 +172,38 @@ vtkGenericCell *vtkCachingInterpolatedVelocityField::GetLastCell()
   return NULL;
 }
 //---------------------------------------------------------------------------
+void vtkCachingInterpolatedVelocityField::BuildFindCellStructures()
+{
+  for (size_t i=0; i<this->CacheList.size(); i++)
+    {
+    IVFDataSetInfo &data = this->CacheList[i];
+    if (data.BSPTree)
+      {
+      // a lazy locator would be built by the first thread to query it
+      data.BSPTree->LazyEvaluationOff();
+      data.BSPTree->BuildLocator();
+      }
+    else if (data.DataSet)
+      {
+      data.DataSet->BuildFindCellStructures();
+      }
+    }
+}
+//---------------------------------------------------------------------------
+void vtkCachingInterpolatedVelocityField::ShareDataSets(
+  vtkCachingInterpolatedVelocityField *other)
+{
+  this->SetVectorsSelection(other->VectorsSelection);
+  this->CacheList = other->CacheList;
+  for (size_t i=0; i<this->CacheList.size(); i++)
+    {
+    this->CacheList[i].Cell = vtkSmartPointer<vtkGenericCell>::New();
+    }
+  this->Weights.assign(other->Weights.size(), 0.0);
+  this->ClearLastCellInfo();
+  this->LastCacheIndex = 0;
+}
+//---------------------------------------------------------------------------
 // Evaluate {u,v,w} at {x,y,z,t}
 int vtkCachingInterpolatedVelocityField::FunctionValues(double* x, double* f)
 {
@@ -150,6 +150,17 @@ protected:
   bool InterpolatePoint(vtkCachingInterpolatedVelocityField *inCIVF,
                         vtkPointData *outPD, vtkIdType outIndex);
   vtkGenericCell *GetLastCell();
+
+  // Description:
+  // Build the cell locators and the search structures of the data sets,
+  // so that the instances sharing them through ShareDataSets() can be
+  // evaluated concurrently. Call it from a single thread.
+  void BuildFindCellStructures();
+
+  // Description:
+  // Use the data sets, velocity arrays and cell locators of other, with
+  // cells and caches of our own.
+  void ShareDataSets(vtkCachingInterpolatedVelocityField *other);
 //ETX
 
 private:
@@ -264,6 +264,35 @@ void vtkCellLocatorInterpolatedVelocityField::AddDataSet( vtkDataSet * dataset )
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkCellLocatorInterpolatedVelocityField::BuildFindCellStructures()
+{
+  this->Superclass::BuildFindCellStructures();
+
+  for ( size_t i = 0; i < this->CellLocators->size(); i ++ )
+    {
+    vtkAbstractCellLocator * locator = ( *this->CellLocators )[i].GetPointer();
+    if ( locator )
+      {
+      // a lazy locator would be built by the first FindCell(), from
+      // whichever thread calls it
+      locator->LazyEvaluationOff();
+      locator->BuildLocator();
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkCompositeInterpolatedVelocityField *
+vtkCellLocatorInterpolatedVelocityField::NewThreadInstance()
+{
+  vtkCellLocatorInterpolatedVelocityField * instance =
+    static_cast< vtkCellLocatorInterpolatedVelocityField * >
+      ( this->Superclass::NewThreadInstance() );
+  *instance->CellLocators = *this->CellLocators;
+  return instance;
+}
+
 //----------------------------------------------------------------------------
 void vtkCellLocatorInterpolatedVelocityField::CopyParameters
   ( vtkAbstractInterpolatedVelocityField * from )
@@ -89,6 +89,12 @@ public:
   // DOES NOT CHANGE THE REFERENCE COUNT OF dataset FOR THREAD SAFETY REASONS.
   virtual void AddDataSet( vtkDataSet * dataset );
 
+  // Description:
+  // Also build the cell locators of the datasets, which the instances
+  // returned by NewThreadInstance() share with this one.
+  virtual void BuildFindCellStructures();
+  virtual vtkCompositeInterpolatedVelocityField * NewThreadInstance();
+
   // Description:
   // Evaluate the velocity field f at point (x, y, z).
   virtual int FunctionValues( double * x, double * f );
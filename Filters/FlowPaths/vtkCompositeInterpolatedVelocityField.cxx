@@ -38,6 +38,37 @@ vtkCompositeInterpolatedVelocityField::~vtkCompositeInterpolatedVelocityField()
   this->DataSets = NULL;
 }
 
+void vtkCompositeInterpolatedVelocityField::BuildFindCellStructures()
+{
+  for ( size_t i = 0; i < this->DataSets->size(); i ++ )
+    {
+    if ( ( *this->DataSets )[i] )
+      {
+      ( *this->DataSets )[i]->BuildFindCellStructures();
+      }
+    }
+}
+
+vtkCompositeInterpolatedVelocityField *
+vtkCompositeInterpolatedVelocityField::NewThreadInstance()
+{
+  vtkCompositeInterpolatedVelocityField * instance = this->NewInstance();
+  instance->CopyParameters( this );
+  instance->SelectVectors( this->VectorsType, this->VectorsSelection );
+  instance->NormalizeVector = this->NormalizeVector;
+  instance->ForceSurfaceTangentVector = this->ForceSurfaceTangentVector;
+  instance->SurfaceDataset = this->SurfaceDataset;
+
+  // share the datasets without the per-dataset work of AddDataSet()
+  *instance->DataSets = *this->DataSets;
+  delete[] instance->Weights;
+  instance->WeightsSize = this->WeightsSize;
+  instance->Weights = this->WeightsSize > 0 ?
+    new double[this->WeightsSize] : NULL;
+
+  return instance;
+}
+
 void vtkCompositeInterpolatedVelocityField::PrintSelf( ostream & os, vtkIndent indent )
 {
   this->Superclass::PrintSelf( os, indent );
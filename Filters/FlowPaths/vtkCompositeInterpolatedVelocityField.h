@@ -102,6 +102,19 @@ public:
   // dataset FOR THREAD SAFETY REASONS.
   virtual void AddDataSet( vtkDataSet * dataset ) = 0;
 
+  // Description:
+  // Build the search structures of the datasets (see
+  // vtkDataSet::BuildFindCellStructures()) so that they can be searched
+  // from several threads at once. Call it from a single thread, before
+  // using the instances returned by NewThreadInstance().
+  virtual void BuildFindCellStructures();
+
+  // Description:
+  // Create an instance of the same class, with the same parameters and
+  // datasets as this one, to evaluate the velocity field from another
+  // thread. The datasets and their search structures are shared, not
+  // copied. The caller is responsible for deleting the instance.
+  virtual vtkCompositeInterpolatedVelocityField * NewThreadInstance();
 
 protected:
   vtkCompositeInterpolatedVelocityField();
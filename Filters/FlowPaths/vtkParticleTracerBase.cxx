@@ -34,6 +34,8 @@
 #include "vtkRungeKutta2.h"
 #include "vtkRungeKutta4.h"
 #include "vtkRungeKutta45.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTemporalInterpolatedVelocityField.h"
@@ -41,6 +43,7 @@
 
 #include <functional>
 #include <algorithm>
+#include <utility>
 #ifdef DEBUGPARTICLETRACE
 #define Assert(x) assert(x)
 #define PRINT(x) cout<<__LINE__<<": "<<x<<endl;
@@ -95,6 +98,139 @@ namespace
 
     return -1;
   }
+
+  // Sets Indices[Offsets[i]] to i for the particles i that passed a test.
+  struct vtkParticleTracerBaseCompact
+  {
+    const int *Passed;
+    const int *Offsets;
+    int *Indices;
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i=begin; i<end; i++)
+        {
+        if (this->Passed[i])
+          {
+          this->Indices[this->Offsets[i]] = static_cast<int>(i);
+          }
+        }
+    }
+  };
+
+  bool vtkParticleTracerBaseIndexLess(
+    const std::pair<vtkIdType, ParticleInformation> &a,
+    const std::pair<vtkIdType, ParticleInformation> &b)
+  {
+    return a.first < b.first;
+  }
+};
+
+//---------------------------------------------------------------------------
+// Classifies candidate seed points, each thread with its own copy of the
+// interpolator. Passed[i] is set to 1 if candidate i lies in our data.
+class vtkParticleTracerBaseTestParticles
+{
+public:
+  vtkParticleTracerBase *Self;
+  ParticleInformation *Candidates;
+  int *Passed;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkTemporalInterpolatedVelocityField> >
+    Interpolators;
+
+  void Initialize()
+  {
+    this->Interpolators.Local().TakeReference(
+      this->Self->Interpolator->NewThreadInstance());
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkTemporalInterpolatedVelocityField *interpolator =
+      this->Interpolators.Local();
+    for (vtkIdType i=begin; i<end; i++)
+      {
+      ParticleInformation &info = this->Candidates[i];
+      double *pos = &info.CurrentPosition.x[0];
+      this->Passed[i] = 0;
+      // if outside bounds, reject instantly
+      if (this->Self->InsideBounds(pos))
+        {
+        // since this is first test, avoid bad cache tests
+        interpolator->ClearCache();
+        info.LocationState = interpolator->TestPoint(pos);
+        if (info.LocationState!=ID_OUTSIDE_ALL)
+          {
+          // get the cached ids and datasets from the TestPoint call
+          interpolator->GetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
+          this->Passed[i] = 1;
+          }
+        }
+      }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+//---------------------------------------------------------------------------
+// Advects the particles of a pass, each thread with its own interpolator and
+// integrator. The particles that are kept are updated in the list, the
+// others are saved in Departed so that the list keeps their previous state.
+class vtkParticleTracerBaseAdvectParticles
+{
+public:
+  struct LocalData
+  {
+    vtkSmartPointer<vtkTemporalInterpolatedVelocityField> Interpolator;
+    vtkSmartPointer<vtkInitialValueProblemSolver> Integrator;
+    std::vector<std::pair<vtkIdType, ParticleInformation> > Departed;
+  };
+
+  vtkParticleTracerBase *Self;
+  vtkInitialValueProblemSolver *Integrator;
+  const ParticleListIterator *Particles;
+  double CurrentTime;
+  double TargetTime;
+  char *Status;
+  double *Velocities;
+  vtkSMPThreadLocal<LocalData> Locals;
+
+  void Initialize()
+  {
+    LocalData &local = this->Locals.Local();
+    local.Interpolator.TakeReference(
+      this->Self->Interpolator->NewThreadInstance());
+    local.Integrator.TakeReference(this->Integrator->NewInstance());
+    local.Integrator->SetFunctionSet(local.Interpolator);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    LocalData &local = this->Locals.Local();
+    for (vtkIdType i=begin; i<end; i++)
+      {
+      ParticleInformation info = *this->Particles[i];
+      int status = this->Self->AdvectParticle(
+        info, this->CurrentTime, this->TargetTime, local.Integrator,
+        local.Interpolator, this->Velocities + 3*i);
+      this->Status[i] = static_cast<char>(status);
+      if (status==vtkParticleTracerBase::PARTICLE_LOST ||
+          status==vtkParticleTracerBase::PARTICLE_LEFT_DOMAIN)
+        {
+        local.Departed.push_back(std::make_pair(i, info));
+        }
+      else
+        {
+        *this->Particles[i] = info;
+        }
+      }
+  }
+
+  void Reduce()
+  {
+  }
 };
 
 //---------------------------------------------------------------------------
@@ -605,29 +741,34 @@ void vtkParticleTracerBase::TestParticles(
   vtkParticleTracerBaseNamespace::ParticleVector &candidates,
   std::vector<int> &passed)
 {
-  int i = 0;
-  for (ParticleIterator it=candidates.begin(); it!=candidates.end(); ++it, ++i)
+  vtkIdType numCandidates = static_cast<vtkIdType>(candidates.size());
+  if (numCandidates==0)
     {
-    ParticleInformation &info = (*it);
-    double *pos = &info.CurrentPosition.x[0];
-    // if outside bounds, reject instantly
-    if (this->InsideBounds(pos))
-      {
-      // since this is first test, avoid bad cache tests
-      this->Interpolator->ClearCache();
-      info.LocationState = this->Interpolator->TestPoint(pos);
-      if (info.LocationState==ID_OUTSIDE_ALL /*|| location==ID_OUTSIDE_T0*/)
-        {
-        // can't really use this particle.
-        vtkDebugMacro(<< "TestParticles rejected particle");
-        }
-      else
-        {
-        // get the cached ids and datasets from the TestPoint call
-        this->Interpolator->GetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
-        passed.push_back(i);
-        }
-      }
+    return;
+    }
+
+  std::vector<int> inside(numCandidates), offsets(numCandidates);
+  this->Interpolator->BuildFindCellStructures();
+  vtkParticleTracerBaseTestParticles test;
+  test.Self = this;
+  test.Candidates = &candidates[0];
+  test.Passed = &inside[0];
+  vtkSMPTools::For(0, numCandidates, test);
+
+  // append the indices of the candidates that passed, in order
+  int numPassed = vtkSMPTools::ExclusiveScan(
+    inside.begin(), inside.end(), offsets.begin(), 0);
+  vtkDebugMacro(<< "TestParticles rejected " << numCandidates-numPassed
+                << " particles");
+  size_t start = passed.size();
+  passed.resize(start + numPassed);
+  if (numPassed > 0)
+    {
+    vtkParticleTracerBaseCompact compact;
+    compact.Passed = &inside[0];
+    compact.Offsets = &offsets[0];
+    compact.Indices = &passed[start];
+    vtkSMPTools::For(0, numCandidates, compact);
     }
 }
 
@@ -854,7 +995,6 @@ vtkPolyData* vtkParticleTracerBase::Execute(vtkInformationVector** inputVector)
     {
     ParticleListIterator  it_first = this->ParticleHistories.begin();
     ParticleListIterator  it_last  = this->ParticleHistories.end();
-    ParticleListIterator  it_next;
 
     //
     // Perform mulitple passes. The number of passes is equal to one more than
@@ -864,19 +1004,7 @@ vtkPolyData* vtkParticleTracerBase::Execute(vtkInformationVector** inputVector)
     while(continueExecuting)
       {
       vtkDebugMacro(<<"Begin Pass " << pass << " with " << this->ParticleHistories.size() << " Particles");
-      for (ParticleListIterator it=it_first; it!=it_last;)
-        {
-        // Keep the 'next' iterator handy because if a particle is terminated
-        // or leaves the domain, the 'current' iterator will be deleted.
-        it_next = it;
-        it_next++;
-        this->IntegrateParticle(it, from, this->CurrentTimeValue, integrator);
-        if (this->GetAbortExecute())
-          {
-          break;
-          }
-        it = it_next;
-        }
+      this->IntegrateParticles(it_first, it_last, from, this->CurrentTimeValue, integrator);
       // Particles might have been deleted during the first pass as they move
       // out of domain or age. Before adding any new particles that are sent
       // to us, we must know the starting point ready for the next pass
@@ -1059,17 +1187,26 @@ int vtkParticleTracerBase::RequestData(
 void vtkParticleTracerBase::IntegrateParticle(
   ParticleListIterator &it, double currenttime, double targettime,
   vtkInitialValueProblemSolver* integrator)
+{
+  ParticleInformation previous = (*it);
+  double velocity[3];
+  int status = this->AdvectParticle(
+    *it, currenttime, targettime, integrator, this->Interpolator, velocity);
+  this->CommitParticle(it, previous, status, velocity, false);
+}
+
+//---------------------------------------------------------------------------
+int vtkParticleTracerBase::AdvectParticle(
+  ParticleInformation &info, double currenttime, double targettime,
+  vtkInitialValueProblemSolver* integrator,
+  vtkTemporalInterpolatedVelocityField *interpolator, double velocity[3])
 {
   double epsilon = (targettime-currenttime)/100.0;
-  double velocity[3], point1[4], point2[4] = {0.0, 0.0, 0.0, 0.0};
+  double point1[4], point2[4] = {0.0, 0.0, 0.0, 0.0};
   double minStep=0, maxStep=0;
   double stepWanted, stepTaken=0.0;
   int substeps = 0;
 
-  ParticleInformation &info = (*it);
-  ParticleInformation previous = (*it);
-  bool particle_good = true;
-
   info.ErrorCode = 0;
 
   // Get the Initial point {x,y,z,t}
@@ -1078,128 +1215,160 @@ void vtkParticleTracerBase::IntegrateParticle(
   if(currenttime==targettime)
     {
     Assert(point1[3]==currenttime);
+    // nothing to integrate, locate the particle for its scalars
+    interpolator->SetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
+    info.LocationState = interpolator->TestPoint(info.CurrentPosition.x);
+    interpolator->GetLastGoodVelocity(velocity);
+    interpolator->GetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
+    return PARTICLE_NOT_ADVECTED;
+    }
+
+  Assert (point1[3]>=(currenttime-epsilon) && point1[3]<=(targettime+epsilon));
+
+  //
+  // begin interpolation between available time values, if the particle has
+  // a cached cell ID and dataset - try to use it,
+  //
+  if(this->AllFixedGeometry)
+    {
+    interpolator->SetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
     }
   else
     {
-    Assert (point1[3]>=(currenttime-epsilon) && point1[3]<=(targettime+epsilon));
+    interpolator->ClearCache();
+    }
 
+  double delT = (targettime-currenttime) * this->IntegrationStep;
+  epsilon = delT*1E-3;
+
+  while (point1[3] < (targettime-epsilon))
+    {
     //
-    // begin interpolation between available time values, if the particle has
-    // a cached cell ID and dataset - try to use it,
+    // Here beginneth the real work
     //
-    if(this->AllFixedGeometry)
+    double error = 0;
+
+    // If, with the next step, propagation will be larger than
+    // max, reduce it so that it is (approximately) equal to max.
+    stepWanted = delT;
+    if ( (point1[3] + stepWanted) > targettime )
       {
-      this->Interpolator->SetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
+      stepWanted = targettime - point1[3];
+      maxStep = stepWanted;
       }
-    else
+
+    // Calculate the next step using the integrator provided.
+    // If the next point is out of bounds, send it to another process
+    if (integrator->ComputeNextStep(
+          point1, point2, point1[3], stepWanted,
+          stepTaken, minStep, maxStep,
+          this->MaximumError, error) != 0)
       {
-      this->Interpolator->ClearCache();
+      // if the particle is sent, remove it from the list
+      info.ErrorCode = 1;
+      if (!this->RetryWithPush(interpolator, info, point1, delT, substeps))
+        {
+        return PARTICLE_LOST;
+        }
+      // particle was not sent, retry saved it, so copy info back
+      substeps++;
+      memcpy(point1, &info.CurrentPosition, sizeof(Position));
       }
+    else // success, increment position/time
+      {
+      substeps++;
 
-    double delT = (targettime-currenttime) * this->IntegrationStep;
-    epsilon = delT*1E-3;
+      // increment the particle time
+      point2[3] = point1[3] + stepTaken;
+      info.age += stepTaken;
+      info.SimulationTime += stepTaken;
+
+      // Point is valid. Insert it.
+      memcpy(&info.CurrentPosition, point2, sizeof(Position));
+      memcpy(point1, point2, sizeof(Position));
+      }
 
-    while (point1[3] < (targettime-epsilon))
+    // If the solver is adaptive and the next time step (delT.Interval)
+    // that the solver wants to use is smaller than minStep or larger
+    // than maxStep, re-adjust it. This has to be done every step
+    // because minStep and maxStep can change depending on the Cell
+    // size (unless it is specified in time units)
+    if (integrator->IsAdaptive())
       {
-      //
-      // Here beginneth the real work
-      //
-      double error = 0;
-
-      // If, with the next step, propagation will be larger than
-      // max, reduce it so that it is (approximately) equal to max.
-      stepWanted = delT;
-      if ( (point1[3] + stepWanted) > targettime )
-        {
-        stepWanted = targettime - point1[3];
-        maxStep = stepWanted;
-        }
+      // code removed. Put it back when this is stable
+      }
+    }
 
-      // Calculate the next step using the integrator provided.
-      // If the next point is out of bounds, send it to another process
-      if (integrator->ComputeNextStep(
-            point1, point2, point1[3], stepWanted,
-            stepTaken, minStep, maxStep,
-            this->MaximumError, error) != 0)
-        {
-        // if the particle is sent, remove it from the list
-        info.ErrorCode = 1;
-        if (!this->RetryWithPush(info, point1, delT, substeps))
-          {
-          if(previous.PointId <0 && previous.TailPointId < 0)
-            {
-            vtkErrorMacro("the particle should have been added");
-            }
-          else
-            {
-            this->SendParticleToAnotherProcess(info,previous, this->ParticlePointData);
-            }
-          this->ParticleHistories.erase(it);
-          particle_good = false;
-          break;
-          }
-        else
-          {
-          // particle was not sent, retry saved it, so copy info back
-          substeps++;
-          memcpy(point1, &info.CurrentPosition, sizeof(Position));
-          }
-        }
-      else // success, increment position/time
-        {
-        substeps++;
+#ifdef DEBUGPARTICLETRACE
+  double eps = (this->GetCacheDataTime(1)-this->GetCacheDataTime(0))/100;
+  Assert (point1[3]>=(this->GetCacheDataTime(0)-eps) && point1[3]<=(this->GetCacheDataTime(1)+eps));
+#endif
+
+  // The integration succeeded, but check the computed final position
+  // is actually inside the domain (the intermediate steps taken inside
+  // the integrator were ok, but the final step may just pass out)
+  // if it moves out, we can't interpolate scalars, so we must send it away
+  info.LocationState = interpolator->TestPoint(info.CurrentPosition.x);
+  interpolator->GetLastGoodVelocity(velocity);
+  if (info.LocationState==ID_OUTSIDE_ALL)
+    {
+    info.ErrorCode = 2;
+    return PARTICLE_LEFT_DOMAIN;
+    }
 
-        // increment the particle time
-        point2[3] = point1[3] + stepTaken;
-        info.age += stepTaken;
-        info.SimulationTime += stepTaken;
+  //
+  // store the last Cell Ids and dataset indices for next time particle is updated
+  //
+  interpolator->GetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
+  return PARTICLE_ADVECTED;
+}
 
-        // Point is valid. Insert it.
-        memcpy(&info.CurrentPosition, point2, sizeof(Position));
-        memcpy(point1, point2, sizeof(Position));
-        }
+//---------------------------------------------------------------------------
+void vtkParticleTracerBase::CommitParticle(
+  ParticleListIterator &it, ParticleInformation &previous, int status,
+  double velocity[3], bool restoreInterpolator)
+{
+  ParticleInformation &info = (*it);
+  bool particle_good = true;
 
-      // If the solver is adaptive and the next time step (delT.Interval)
-      // that the solver wants to use is smaller than minStep or larger
-      // than maxStep, re-adjust it. This has to be done every step
-      // because minStep and maxStep can change depending on the Cell
-      // size (unless it is specified in time units)
-      if (integrator->IsAdaptive())
-        {
-        // code removed. Put it back when this is stable
-        }
+  if (status==PARTICLE_LOST)
+    {
+    if(previous.PointId <0 && previous.TailPointId < 0)
+      {
+      vtkErrorMacro("the particle should have been added");
       }
-
-    if (particle_good)
+    else
       {
-      // The integration succeeded, but check the computed final position
-      // is actually inside the domain (the intermediate steps taken inside
-      // the integrator were ok, but the final step may just pass out)
-      // if it moves out, we can't interpolate scalars, so we must send it away
-      info.LocationState = this->Interpolator->TestPoint(info.CurrentPosition.x);
-      if (info.LocationState==ID_OUTSIDE_ALL)
-        {
-        info.ErrorCode = 2;
-        // if the particle is sent, remove it from the list
-        if (this->SendParticleToAnotherProcess(info,previous,this->OutputPointData))
-          {
-          this->ParticleHistories.erase(it);
-          particle_good = false;
-          }
-        }
+      this->SendParticleToAnotherProcess(info,previous, this->ParticlePointData);
+      }
+    this->ParticleHistories.erase(it);
+    particle_good = false;
+    }
+  else if (status==PARTICLE_LEFT_DOMAIN)
+    {
+    // if the particle is sent, remove it from the list
+    if (this->SendParticleToAnotherProcess(info,previous,this->OutputPointData))
+      {
+      this->ParticleHistories.erase(it);
+      particle_good = false;
       }
+    else
+      {
+      // the particle is kept outside of the data, without a cached cell
+      info.CachedCellId[0] = info.CachedCellId[1] = -1;
+      info.CachedDataSetId[0] = info.CachedDataSetId[1] = 0;
+      }
+    }
 
-    // Has this particle stagnated
-    //
-    if (particle_good)
+  // Has this particle stagnated
+  //
+  if (particle_good && status!=PARTICLE_NOT_ADVECTED)
+    {
+    info.speed = vtkMath::Norm(velocity);
+    if (info.speed <= this->TerminalSpeed)
       {
-      this->Interpolator->GetLastGoodVelocity(velocity);
-      info.speed = vtkMath::Norm(velocity);
-      if (it->speed <= this->TerminalSpeed)
-        {
-        this->ParticleHistories.erase(it);
-        particle_good = false;
-        }
+      this->ParticleHistories.erase(it);
+      particle_good = false;
       }
     }
 
@@ -1207,14 +1376,16 @@ void vtkParticleTracerBase::IntegrateParticle(
   // We got this far without error :
   // Insert the point into the output
   // Create any new scalars and interpolate existing ones
-  // Cache cell ids and datasets
   //
   if (particle_good)
     {
-    //
-    // store the last Cell Ids and dataset indices for next time particle is updated
-    //
-    this->Interpolator->GetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
+    if (restoreInterpolator)
+      {
+      // the particle was advected by another interpolator: locate it again,
+      // starting from its cell, for AddParticle() to interpolate the scalars
+      this->Interpolator->SetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
+      this->Interpolator->TestPoint(info.CurrentPosition.x);
+      }
     //
     info.TimeStepAge += 1;
     //
@@ -1226,11 +1397,72 @@ void vtkParticleTracerBase::IntegrateParticle(
     {
     this->Interpolator->ClearCache();
     }
+}
 
-#ifdef DEBUGPARTICLETRACE
-  double eps = (this->GetCacheDataTime(1)-this->GetCacheDataTime(0))/100;
-  Assert (point1[3]>=(this->GetCacheDataTime(0)-eps) && point1[3]<=(this->GetCacheDataTime(1)+eps));
-#endif
+//---------------------------------------------------------------------------
+void vtkParticleTracerBase::IntegrateParticles(
+  ParticleListIterator first, ParticleListIterator last,
+  double currenttime, double targettime,
+  vtkInitialValueProblemSolver* integrator)
+{
+  // The particles of the pass, in list order. Erasing some of them from the
+  // list leaves the iterators to the others valid.
+  std::vector<ParticleListIterator> particles;
+  for (ParticleListIterator it=first; it!=last; ++it)
+    {
+    particles.push_back(it);
+    }
+  vtkIdType numParticles = static_cast<vtkIdType>(particles.size());
+  if (numParticles < 2)
+    {
+    for (vtkIdType i=0; i<numParticles && !this->GetAbortExecute(); i++)
+      {
+      this->IntegrateParticle(particles[i], currenttime, targettime, integrator);
+      }
+    return;
+    }
+
+  std::vector<char> status(numParticles);
+  std::vector<double> velocities(3*numParticles);
+
+  this->Interpolator->BuildFindCellStructures();
+  vtkParticleTracerBaseAdvectParticles advect;
+  advect.Self = this;
+  advect.Integrator = integrator;
+  advect.Particles = &particles[0];
+  advect.CurrentTime = currenttime;
+  advect.TargetTime = targettime;
+  advect.Status = &status[0];
+  advect.Velocities = &velocities[0];
+  vtkSMPTools::For(0, numParticles, advect);
+
+  std::vector<std::pair<vtkIdType, ParticleInformation> > departed;
+  vtkSMPThreadLocal<vtkParticleTracerBaseAdvectParticles::LocalData>::iterator
+    local;
+  for (local = advect.Locals.begin(); local != advect.Locals.end(); ++local)
+    {
+    departed.insert(departed.end(),
+                    local->Departed.begin(), local->Departed.end());
+    }
+  std::sort(departed.begin(), departed.end(), vtkParticleTracerBaseIndexLess);
+
+  size_t nextDeparted = 0;
+  for (vtkIdType i=0; i<numParticles && !this->GetAbortExecute(); i++)
+    {
+    if (status[i]==PARTICLE_LOST || status[i]==PARTICLE_LEFT_DOMAIN)
+      {
+      // the list still holds the particle as it was before the pass
+      ParticleInformation previous = *particles[i];
+      *particles[i] = departed[nextDeparted++].second;
+      this->CommitParticle(particles[i], previous, status[i],
+                           &velocities[3*i], true);
+      }
+    else
+      {
+      this->CommitParticle(particles[i], *particles[i], status[i],
+                           &velocities[3*i], true);
+      }
+    }
 }
 
 //---------------------------------------------------------------------------
@@ -1447,12 +1679,13 @@ void vtkParticleTracerBase::CreateProtoPD(vtkDataObject* input)
 
 //---------------------------------------------------------------------------
 bool vtkParticleTracerBase::RetryWithPush(
+  vtkTemporalInterpolatedVelocityField *interpolator,
   ParticleInformation &info,  double* point1,double delT, int substeps)
 {
   double velocity[3];
-  this->Interpolator->ClearCache();
+  interpolator->ClearCache();
 
-  info.LocationState = this->Interpolator->TestPoint(point1);
+  info.LocationState = interpolator->TestPoint(point1);
 
   if (info.LocationState==ID_OUTSIDE_ALL)
     {
@@ -1461,7 +1694,7 @@ bool vtkParticleTracerBase::RetryWithPush(
     // send the particle 'as is' and hope it lands in another process
     if (substeps>0)
       {
-      this->Interpolator->GetLastGoodVelocity(velocity);
+      interpolator->GetLastGoodVelocity(velocity);
       }
     else
       {
@@ -1472,19 +1705,19 @@ bool vtkParticleTracerBase::RetryWithPush(
   else if (info.LocationState==ID_OUTSIDE_T0)
     {
     // the particle left the volume but can be tested at T2, so use the velocity at T2
-    this->Interpolator->GetLastGoodVelocity(velocity);
+    interpolator->GetLastGoodVelocity(velocity);
     info.ErrorCode = 4;
     }
   else if (info.LocationState==ID_OUTSIDE_T1)
     {
     // the particle left the volume but can be tested at T1, so use the velocity at T1
-    this->Interpolator->GetLastGoodVelocity(velocity);
+    interpolator->GetLastGoodVelocity(velocity);
     info.ErrorCode = 5;
     }
   else
     {
     // The test returned INSIDE_ALL, so test failed near start of integration,
-    this->Interpolator->GetLastGoodVelocity(velocity);
+    interpolator->GetLastGoodVelocity(velocity);
     }
 
   // try adding a one increment push to the particle to get over a rotating/moving boundary
@@ -1494,7 +1727,7 @@ bool vtkParticleTracerBase::RetryWithPush(
     }
 
   info.CurrentPosition.x[3] += delT;
-  info.LocationState = this->Interpolator->TestPoint(info.CurrentPosition.x);
+  info.LocationState = interpolator->TestPoint(info.CurrentPosition.x);
   info.age += delT;
   info.SimulationTime += delT; // = this->GetCurrentTimeValue();
 
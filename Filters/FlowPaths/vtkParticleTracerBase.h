@@ -18,6 +18,12 @@
 // in a vector field. Note that the input vtkPointData structure must
 // be identical on all datasets.
 //
+// The particles of a pass are advected together: each thread (see
+// vtkSMPTools) integrates a range of them with its own copy of the
+// interpolator, starting from the cell cached by each particle, and the
+// results are then added to the output in the order of the particle list.
+// Seed points are classified the same way before injection.
+//
 // .SECTION See Also
 // vtkRibbonFilter vtkRuledSurfaceFilter vtkInitialValueProblemSolver
 // vtkRungeKutta2 vtkRungeKutta4 vtkRungeKutta45 vtkStreamTracer
@@ -348,6 +354,16 @@ public:
     double currenttime, double terminationtime,
     vtkInitialValueProblemSolver* integrator);
 
+  // Description : Integrate the particles from first to last (excluded)
+  // between the two times supplied. The particles are advected in
+  // parallel, then kept, sent or removed, and added to the output in
+  // list order, as successive calls to IntegrateParticle() would do.
+  void IntegrateParticles(
+    vtkParticleTracerBaseNamespace::ParticleListIterator first,
+    vtkParticleTracerBaseNamespace::ParticleListIterator last,
+    double currenttime, double terminationtime,
+    vtkInitialValueProblemSolver* integrator);
+
   // if the particle is added to send list, then returns value is 1,
   // if it is kept on this process after a retry return value is 0
   virtual bool SendParticleToAnotherProcess(
@@ -435,8 +451,34 @@ public:
   // first order integration though so it may introduce a bit extra error compared
   // to the integrator that is used.
   bool RetryWithPush(
+    vtkTemporalInterpolatedVelocityField *interpolator,
     vtkParticleTracerBaseNamespace::ParticleInformation &info, double* point1,double delT, int subSteps);
 
+  // Description:
+  // The two halves of IntegrateParticle(). AdvectParticle() moves the
+  // particle to the termination time with the given integrator and
+  // interpolator, and returns one of the ParticleStatus values. It only
+  // modifies info, so that it can run for several particles at once.
+  // CommitParticle() then sends, removes or adds the particle to the
+  // output. When restoreInterpolator is true, the state of Interpolator is
+  // first recomputed from the cell cached by the particle.
+  enum ParticleStatus
+  {
+    PARTICLE_ADVECTED,
+    PARTICLE_NOT_ADVECTED,
+    PARTICLE_LEFT_DOMAIN,
+    PARTICLE_LOST
+  };
+  int AdvectParticle(
+    vtkParticleTracerBaseNamespace::ParticleInformation &info,
+    double currenttime, double terminationtime,
+    vtkInitialValueProblemSolver* integrator,
+    vtkTemporalInterpolatedVelocityField *interpolator, double velocity[3]);
+  void CommitParticle(
+    vtkParticleTracerBaseNamespace::ParticleListIterator &it,
+    vtkParticleTracerBaseNamespace::ParticleInformation &previous,
+    int status, double velocity[3], bool restoreInterpolator);
+
   bool SetTerminationTimeNoModify(double t);
 
   //Parameters of tracing
@@ -517,6 +559,8 @@ public:
 
   friend class ParticlePathFilterInternal;
   friend class StreaklineFilterInternal;
+  friend class vtkParticleTracerBaseAdvectParticles;
+  friend class vtkParticleTracerBaseTestParticles;
 
   static const double Epsilon;
 };
@@ -45,8 +45,11 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkRungeKutta2.h"
 #include "vtkRungeKutta4.h"
 #include "vtkRungeKutta45.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
 #include <vector>
 
 vtkObjectFactoryNewMacro(vtkStreamTracer)
@@ -656,512 +659,843 @@ int vtkStreamTracer::CheckInputs(vtkAbstractInterpolatedVelocityField*& func,
   return VTK_OK;
 }
 
-void vtkStreamTracer::Integrate(vtkPointData *input0Data,
-                                vtkPolyData* output,
-                                vtkDataArray* seedSource,
-                                vtkIdList* seedIds,
-                                vtkIntArray* integrationDirections,
-                                double lastPoint[3],
-                                vtkAbstractInterpolatedVelocityField* func,
-                                int maxCellSize,
-                                int vecType,
-                                const char *vecName,
-                                double& inPropagation,
-                                vtkIdType& inNumSteps,
-                                double &inIntegrationTime)
+//---------------------------------------------------------------------------
+// Integrates the streamlines of seeds one at a time, with its own
+// interpolator, integrator and scratch space, and appends their points to
+// its own buffers. Integrate() uses a single one, that writes the point data
+// of the output directly, or one per thread.
+class vtkStreamTracerSeedIntegrator
 {
-  int i;
-  vtkIdType numLines = seedIds->GetNumberOfIds();
-  double propagation = inPropagation;
-  vtkIdType numSteps = inNumSteps;
-  double integrationTime = inIntegrationTime;
-
-  // Useful pointers
-  vtkDataSetAttributes* outputPD = output->GetPointData();
-  vtkDataSetAttributes* outputCD = output->GetCellData();
-  vtkPointData* inputPD;
-  vtkDataSet* input;
-  vtkDataArray* inVectors;
+public:
+  // The streamline of one seed: points FirstPoint to
+  // FirstPoint + NumberOfPoints - 1 of Points and PointData.
+  struct Trace
+  {
+    vtkIdType Seed;
+    vtkIdType FirstPoint;
+    vtkIdType NumberOfPoints;
+    int ReasonForTermination;
+    double Propagation;
+    vtkIdType NumberOfSteps;
+    double IntegrationTime;
+    bool HasLastPoint;
+    double LastPoint[3];
+    vtkPoints *Points;
+    vtkDataSetAttributes *PointData;
+  };
+
+  vtkStreamTracer *Self;
+  vtkAbstractInterpolatedVelocityField *Func;
+  vtkInterpolatedVelocityField *SurfaceFunc;
+  vtkInitialValueProblemSolver *Integrator;
+  vtkGenericCell *Cell;
+  double *Weights;
+  vtkDoubleArray *CellVectors;
+
+  vtkDataArray *SeedSource;
+  vtkIdList *SeedIds;
+  vtkIntArray *IntegrationDirections;
+  int VecType;
+  const char *VecName;
+  bool Threaded;
+
+  vtkPoints *Points;
+  vtkDataSetAttributes *PointData;
+  vtkDoubleArray *Time;
+  vtkDoubleArray *VelocityVectors;
+  vtkDoubleArray *Vorticity;
+  vtkDoubleArray *Rotation;
+  vtkDoubleArray *AngularVel;
+  std::vector<Trace> Traces;
+
+  // Initial values for the next seed integrated.
+  double Propagation;
+  vtkIdType NumberOfSteps;
+  double IntegrationTime;
+
+  bool Aborted;
+
+  vtkStreamTracerSeedIntegrator(vtkStreamTracer *self,
+                                vtkAbstractInterpolatedVelocityField *func,
+                                vtkDataSetAttributes *pointData,
+                                vtkDataArray *seedSource, vtkIdList *seedIds,
+                                vtkIntArray *integrationDirections,
+                                int maxCellSize, int vecType,
+                                const char *vecName, bool threaded)
+  {
+    this->Self = self;
+    this->Func = func;
+    this->Func->Register(NULL);
+    this->SurfaceFunc = NULL;
+    if (self->SurfaceStreamlines)
+      {
+      this->SurfaceFunc = vtkInterpolatedVelocityField::SafeDownCast(func);
+      }
+    this->Integrator = self->GetIntegrator()->NewInstance();
+    this->Integrator->SetFunctionSet(func);
+    this->Cell = vtkGenericCell::New();
+    this->Weights = maxCellSize > 0 ? new double[maxCellSize] : NULL;
+
+    this->SeedSource = seedSource;
+    this->SeedIds = seedIds;
+    this->IntegrationDirections = integrationDirections;
+    this->VecType = vecType;
+    this->VecName = vecName;
+    this->Threaded = threaded;
+
+    // Since we do not know what the total number of points
+    // will be, we do not allocate any. This is important for
+    // cases where a lot of streamers are used at once. If we
+    // were to allocate any points here, potentially, we can
+    // waste a lot of memory if a lot of streamers are used.
+    this->Points = vtkPoints::New();
+    this->PointData = pointData;
+    this->PointData->Register(NULL);
+
+    // We will keep track of integration time in this array
+    this->Time = vtkDoubleArray::New();
+    this->Time->SetName("IntegrationTime");
+
+    this->VelocityVectors = NULL;
+    if (vecType != vtkDataObject::POINT)
+      {
+      this->VelocityVectors = vtkDoubleArray::New();
+      this->VelocityVectors->SetName(vecName);
+      this->VelocityVectors->SetNumberOfComponents(3);
+      }
+    this->CellVectors = NULL;
+    this->Vorticity = NULL;
+    this->Rotation = NULL;
+    this->AngularVel = NULL;
+    if (self->ComputeVorticity)
+      {
+      this->CellVectors = vtkDoubleArray::New();
+      this->CellVectors->SetNumberOfComponents(3);
+      this->CellVectors->Allocate(3*VTK_CELL_SIZE);
 
-  int direction=1;
+      this->Vorticity = vtkDoubleArray::New();
+      this->Vorticity->SetName("Vorticity");
+      this->Vorticity->SetNumberOfComponents(3);
 
-  if (this->GetIntegrator() == 0)
-    {
-    vtkErrorMacro("No integrator is specified.");
-    return;
-    }
-
-  double* weights = 0;
-  if ( maxCellSize > 0 )
-    {
-    weights = new double[maxCellSize];
-    }
+      this->Rotation = vtkDoubleArray::New();
+      this->Rotation->SetName("Rotation");
 
-  // Used in GetCell()
-  vtkGenericCell* cell = vtkGenericCell::New();
+      this->AngularVel = vtkDoubleArray::New();
+      this->AngularVel->SetName("AngularVelocity");
+      }
 
-  // Create a new integrator, the type is the same as Integrator
-  vtkInitialValueProblemSolver* integrator =
-    this->GetIntegrator()->NewInstance();
-  integrator->SetFunctionSet(func);
+    this->Propagation = 0;
+    this->NumberOfSteps = 0;
+    this->IntegrationTime = 0;
+    this->Aborted = false;
+  }
 
-  // Check Surface option
-  vtkInterpolatedVelocityField* surfaceFunc = NULL;
-  if (this->SurfaceStreamlines == true)
-    {
-    surfaceFunc = vtkInterpolatedVelocityField::SafeDownCast(func);
-    if (surfaceFunc == NULL)
+  ~vtkStreamTracerSeedIntegrator()
+  {
+    this->Func->UnRegister(NULL);
+    this->Integrator->Delete();
+    this->Cell->Delete();
+    delete[] this->Weights;
+    this->Points->Delete();
+    this->PointData->UnRegister(NULL);
+    this->Time->Delete();
+    if (this->VelocityVectors)
       {
-        vtkWarningMacro(<< "Surface Streamlines works only with Point Locator "
-                           "Interpolated Velocity Field, setting it off");
-        this->SetSurfaceStreamlines(false);
+      this->VelocityVectors->Delete();
       }
-    else
+    if (this->Vorticity)
       {
-      surfaceFunc->SetForceSurfaceTangentVector(true);
-      surfaceFunc->SetSurfaceDataset(true);
+      this->CellVectors->Delete();
+      this->Vorticity->Delete();
+      this->Rotation->Delete();
+      this->AngularVel->Delete();
       }
-    }
+  }
 
-  // Since we do not know what the total number of points
-  // will be, we do not allocate any. This is important for
-  // cases where a lot of streamers are used at once. If we
-  // were to allocate any points here, potentially, we can
-  // waste a lot of memory if a lot of streamers are used.
-  // Always insert the first point
-  vtkPoints* outputPoints = vtkPoints::New();
-  vtkCellArray* outputLines = vtkCellArray::New();
+  // Adds the integration time, velocity and vorticity arrays to the point
+  // data, once all the seeds are integrated.
+  void AddPointArrays()
+  {
+    this->PointData->AddArray(this->Time);
+    if (this->VelocityVectors)
+      {
+      this->PointData->AddArray(this->VelocityVectors);
+      }
+    if (this->Vorticity)
+      {
+      this->PointData->AddArray(this->Vorticity);
+      this->PointData->AddArray(this->Rotation);
+      this->PointData->AddArray(this->AngularVel);
+      }
+  }
 
-  // We will keep track of integration time in this array
-  vtkDoubleArray* time = vtkDoubleArray::New();
-  time->SetName("IntegrationTime");
+  // Integrates the streamline of seed currentLine. Nothing is recorded for
+  // the seeds outside of the domain, and the initial propagation, number of
+  // steps and integration time are then kept for the next seed.
+  void IntegrateSeed(vtkIdType currentLine);
+};
 
-  // This array explains why the integration stopped
-  vtkIntArray* retVals = vtkIntArray::New();
-  retVals->SetName("ReasonForTermination");
+void vtkStreamTracerSeedIntegrator::IntegrateSeed(vtkIdType currentLine)
+{
+  vtkStreamTracer *self = this->Self;
+  vtkAbstractInterpolatedVelocityField *func = this->Func;
+  vtkGenericCell *cell = this->Cell;
+  vtkIdType numLines = this->SeedIds->GetNumberOfIds();
+  double propagation = this->Propagation;
+  vtkIdType numSteps = this->NumberOfSteps;
+  double integrationTime = this->IntegrationTime;
 
-  vtkIntArray* sids = vtkIntArray::New();
-  sids->SetName("SeedIds");
+  vtkPointData* inputPD;
+  vtkDataSet* input;
+  vtkDataArray* inVectors;
+  int direction=1;
+  int i;
 
-  vtkSmartPointer<vtkDoubleArray> velocityVectors;
-  if(vecType != vtkDataObject::POINT)
+  if (!this->Threaded)
     {
-    velocityVectors = vtkSmartPointer<vtkDoubleArray>::New();
-    velocityVectors->SetName(vecName);
-    velocityVectors->SetNumberOfComponents(3);
+    double progress = static_cast<double>(currentLine)/numLines;
+    self->UpdateProgress(progress);
     }
-  vtkDoubleArray* cellVectors = 0;
-  vtkDoubleArray* vorticity = 0;
-  vtkDoubleArray* rotation = 0;
-  vtkDoubleArray* angularVel = 0;
-  if (this->ComputeVorticity)
+
+  switch (this->IntegrationDirections->GetValue(currentLine))
     {
-    cellVectors = vtkDoubleArray::New();
-    cellVectors->SetNumberOfComponents(3);
-    cellVectors->Allocate(3*VTK_CELL_SIZE);
+    case vtkStreamTracer::FORWARD:
+      direction = 1;
+      break;
+    case vtkStreamTracer::BACKWARD:
+      direction = -1;
+      break;
+    }
 
-    vorticity = vtkDoubleArray::New();
-    vorticity->SetName("Vorticity");
-    vorticity->SetNumberOfComponents(3);
+  // temporary variables used in the integration
+  double point1[3], point2[3], pcoords[3], vort[3], omega;
+  double velocity[3];
+  vtkIdType index;
 
-    rotation = vtkDoubleArray::New();
-    rotation->SetName("Rotation");
+  // Clear the last cell to avoid starting a search from
+  // the last point in the streamline
+  func->ClearLastCellId();
 
-    angularVel = vtkDoubleArray::New();
-    angularVel->SetName("AngularVelocity");
+  // Initial point
+  this->SeedSource->GetTuple(this->SeedIds->GetId(currentLine), point1);
+  memcpy(point2, point1, 3*sizeof(double));
+  if (!func->FunctionValues(point1, velocity))
+    {
+    return;
     }
 
-  // We will interpolate all point attributes of the input on each point of
-  // the output (unless they are turned off). Note that we are using only
-  // the first input, if there are more than one, the attributes have to match.
-  //
-  // Note: We have to use a specific value (safe to employ the maximum number
-  //       of steps) as the size of the initial memory allocation here. The
-  //       use of the default argument might incur a crash problem (due to
-  //       "insufficient memory") in the parallel mode. This is the case when
-  //       a streamline intensely shuttles between two processes in an exactly
-  //       interleaving fashion --- only one point is produced on each process
-  //       (and actually two points, after point duplication, are saved to a
-  //       vtkPolyData in vtkDistributedStreamTracer::NoBlockProcessTask) and
-  //       as a consequence a large number of such small vtkPolyData objects
-  //       are needed to represent a streamline, consuming up the memory before
-  //       the intermediate memory is timely released.
-  outputPD->InterpolateAllocate( input0Data,
-                                 this->MaximumNumberOfSteps );
-
-  vtkIdType numPtsTotal=0;
-  double velocity[3];
-
-  int shouldAbort = 0;
+  if ( propagation >= self->MaximumPropagation ||
+       numSteps    >  self->MaximumNumberOfSteps)
+    {
+    return;
+    }
 
-  for(int currentLine = 0; currentLine < numLines; currentLine++)
+  Trace trace;
+  trace.Seed = currentLine;
+  trace.HasLastPoint = false;
+  trace.Points = this->Points;
+  trace.PointData = this->PointData;
+  trace.NumberOfPoints = 1;
+  vtkIdType nextPoint = this->Points->InsertNextPoint(point1);
+  trace.FirstPoint = nextPoint;
+  double lastInsertedPoint[3];
+  this->Points->GetPoint(nextPoint, lastInsertedPoint);
+  this->Time->InsertNextValue(integrationTime);
+
+  // We will always pass an arc-length step size to the integrator.
+  // If the user specifies a step size in cell length unit, we will
+  // have to convert it to arc length.
+  vtkStreamTracer::IntervalInformation stepSize;  // either positive or negative
+  stepSize.Unit  = vtkStreamTracer::LENGTH_UNIT;
+  stepSize.Interval = 0;
+  vtkStreamTracer::IntervalInformation aStep; // always positive
+  aStep.Unit = vtkStreamTracer::LENGTH_UNIT;
+  double step, minStep=0, maxStep=0;
+  double stepTaken;
+  double speed;
+  double cellLength;
+  int retVal=vtkStreamTracer::OUT_OF_LENGTH, tmp;
+
+  // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
+  input = func->GetLastDataSet();
+  inputPD = input->GetPointData();
+  inVectors =
+    input->GetAttributesAsFieldData(this->VecType)->GetArray(this->VecName);
+  // Convert intervals to arc-length unit
+  input->GetCell(func->GetLastCellId(), cell);
+  cellLength = sqrt(static_cast<double>(cell->GetLength2()));
+  speed = vtkMath::Norm(velocity);
+  // Never call conversion methods if speed == 0
+  if ( speed != 0.0 )
     {
+    self->ConvertIntervals( stepSize.Interval, minStep, maxStep,
+                            direction, cellLength );
+    }
 
-    double progress = static_cast<double>(currentLine)/numLines;
-    this->UpdateProgress(progress);
+  // Interpolate all point attributes on first point
+  func->GetLastWeights(this->Weights);
+  InterpolatePoint(this->PointData, inputPD, nextPoint, cell->PointIds,
+                   this->Weights, self->HasMatchingPointAttributes);
+  if (this->VelocityVectors)
+    {
+    this->VelocityVectors->InsertNextTuple(velocity);
+    }
 
-    switch (integrationDirections->GetValue(currentLine))
+  // Compute vorticity if required
+  // This can be used later for streamribbon generation.
+  if (self->ComputeVorticity)
+    {
+    if(this->VecType == vtkDataObject::POINT)
       {
-      case FORWARD:
-        direction = 1;
-        break;
-      case BACKWARD:
-        direction = -1;
-        break;
+      inVectors->GetTuples(cell->PointIds, this->CellVectors);
+      func->GetLastLocalCoordinates(pcoords);
+      self->CalculateVorticity(cell, pcoords, this->CellVectors, vort);
       }
+    else
+      {
+      vort[0] = 0;
+      vort[1] = 0;
+      vort[2] = 0;
+      }
+    this->Vorticity->InsertNextTuple(vort);
+    // rotation
+    // local rotation = vorticity . unit tangent ( i.e. velocity/speed )
+    if (speed != 0.0)
+      {
+      omega = vtkMath::Dot(vort, velocity);
+      omega /= speed;
+      omega *= self->RotationScale;
+      }
+    else
+      {
+      omega = 0.0;
+      }
+    this->AngularVel->InsertNextValue(omega);
+    this->Rotation->InsertNextValue(0.0);
+    }
 
-    // temporary variables used in the integration
-    double point1[3], point2[3], pcoords[3], vort[3], omega;
-    vtkIdType index, numPts=0;
+  double error = 0;
 
-    // Clear the last cell to avoid starting a search from
-    // the last point in the streamline
-    func->ClearLastCellId();
+  // Integrate until the maximum propagation length is reached,
+  // maximum number of steps is reached or until a boundary is encountered.
+  // Begin Integration
+  while ( propagation < self->MaximumPropagation )
+    {
 
-    // Initial point
-    seedSource->GetTuple(seedIds->GetId(currentLine), point1);
-    memcpy(point2, point1, 3*sizeof(double));
-    if (!func->FunctionValues(point1, velocity))
+    if (numSteps > self->MaximumNumberOfSteps)
       {
-      continue;
+      retVal = vtkStreamTracer::OUT_OF_STEPS;
+      break;
       }
 
-    if ( propagation >= this->MaximumPropagation ||
-         numSteps    >  this->MaximumNumberOfSteps)
+    if ( numSteps++ % 1000 == 1 )
       {
-      continue;
-      }
+      if (!this->Threaded)
+        {
+        double progress =
+          ( currentLine + propagation / self->MaximumPropagation ) / numLines;
+        self->UpdateProgress(progress);
+        }
 
-    numPts++;
-    numPtsTotal++;
-    vtkIdType nextPoint = outputPoints->InsertNextPoint(point1);
-    double lastInsertedPoint[3];
-    outputPoints->GetPoint(nextPoint, lastInsertedPoint);
-    time->InsertNextValue(integrationTime);
-
-    // We will always pass an arc-length step size to the integrator.
-    // If the user specifies a step size in cell length unit, we will
-    // have to convert it to arc length.
-    IntervalInformation stepSize;  // either positive or negative
-    stepSize.Unit  = LENGTH_UNIT;
-    stepSize.Interval = 0;
-    IntervalInformation aStep; // always positive
-    aStep.Unit = LENGTH_UNIT;
-    double step, minStep=0, maxStep=0;
-    double stepTaken;
-    double speed;
-    double cellLength;
-    int retVal=OUT_OF_LENGTH, tmp;
+      if (self->GetAbortExecute())
+        {
+        this->Aborted = true;
+        return;
+        }
+      }
 
-    // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
-    input = func->GetLastDataSet();
-    inputPD = input->GetPointData();
-    inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
-    // Convert intervals to arc-length unit
-    input->GetCell(func->GetLastCellId(), cell);
-    cellLength = sqrt(static_cast<double>(cell->GetLength2()));
-    speed = vtkMath::Norm(velocity);
     // Never call conversion methods if speed == 0
-    if ( speed != 0.0 )
+    if ( (speed == 0) || (speed <= self->TerminalSpeed) )
       {
-      this->ConvertIntervals( stepSize.Interval, minStep, maxStep,
-                              direction, cellLength );
+      retVal = vtkStreamTracer::STAGNATION;
+      break;
       }
 
-    // Interpolate all point attributes on first point
-    func->GetLastWeights(weights);
-    InterpolatePoint(outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
-    if(vecType != vtkDataObject::POINT)
-      {
-      velocityVectors->InsertNextTuple(velocity);
-      }
+    // If, with the next step, propagation will be larger than
+    // max, reduce it so that it is (approximately) equal to max.
+    aStep.Interval = fabs( stepSize.Interval );
 
-    // Compute vorticity if required
-    // This can be used later for streamribbon generation.
-    if (this->ComputeVorticity)
+    if ( ( propagation + aStep.Interval ) > self->MaximumPropagation )
       {
-      if(vecType == vtkDataObject::POINT)
+      aStep.Interval = self->MaximumPropagation - propagation;
+      if ( stepSize.Interval >= 0 )
         {
-        inVectors->GetTuples(cell->PointIds, cellVectors);
-        func->GetLastLocalCoordinates(pcoords);
-        vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
+        stepSize.Interval = vtkStreamTracer::ConvertToLength( aStep, cellLength );
         }
       else
         {
-        vort[0] = 0;
-        vort[1] = 0;
-        vort[2] = 0;
+        stepSize.Interval = vtkStreamTracer::ConvertToLength( aStep, cellLength ) * ( -1.0 );
         }
-      vorticity->InsertNextTuple(vort);
-      // rotation
-      // local rotation = vorticity . unit tangent ( i.e. velocity/speed )
-      if (speed != 0.0)
+      maxStep = stepSize.Interval;
+      }
+    if (!this->Threaded)
+      {
+      self->LastUsedStepSize = stepSize.Interval;
+      }
+
+    // Calculate the next step using the integrator provided
+    // Break if the next point is out of bounds.
+    func->SetNormalizeVector( true );
+    tmp = this->Integrator->ComputeNextStep( point1, point2, 0, stepSize.Interval,
+                                             stepTaken, minStep, maxStep,
+                                             self->MaximumError, error );
+    func->SetNormalizeVector( false );
+    if ( tmp != 0 )
+      {
+      retVal = tmp;
+      trace.HasLastPoint = true;
+      memcpy(trace.LastPoint, point2, 3*sizeof(double));
+      break;
+      }
+
+    // This is the next starting point
+    if (self->SurfaceStreamlines && this->SurfaceFunc != NULL)
+      {
+      if (this->SurfaceFunc->SnapPointOnCell(point2, point1) != 1)
         {
-        omega = vtkMath::Dot(vort, velocity);
-        omega /= speed;
-        omega *= this->RotationScale;
+        retVal = vtkStreamTracer::OUT_OF_DOMAIN;
+        trace.HasLastPoint = true;
+        memcpy(trace.LastPoint, point2, 3 * sizeof(double));
+        break;
         }
-      else
+      }
+    else
+      {
+      for (i = 0; i < 3; i++)
         {
-        omega = 0.0;
+        point1[i] = point2[i];
         }
-      angularVel->InsertNextValue(omega);
-      rotation->InsertNextValue(0.0);
       }
 
-    double error = 0;
+    // Interpolate the velocity at the next point
+    if ( !func->FunctionValues(point2, velocity) )
+      {
+      retVal = vtkStreamTracer::OUT_OF_DOMAIN;
+      trace.HasLastPoint = true;
+      memcpy(trace.LastPoint, point2, 3*sizeof(double));
+      break;
+      }
 
-    // Integrate until the maximum propagation length is reached,
-    // maximum number of steps is reached or until a boundary is encountered.
-    // Begin Integration
-    while ( propagation < this->MaximumPropagation )
+    // It is not enough to use the starting point for stagnation calculation
+    // Use average speed to check if it is below stagnation threshold
+    double speed2 = vtkMath::Norm(velocity);
+    if ( (speed+speed2)/2 <= self->TerminalSpeed )
       {
+      retVal = vtkStreamTracer::STAGNATION;
+      break;
+      }
 
-      if (numSteps > this->MaximumNumberOfSteps)
-        {
-        retVal = OUT_OF_STEPS;
-        break;
-        }
+    integrationTime += stepTaken / speed;
+    // Calculate propagation (using the same units as MaximumPropagation
+    propagation += fabs( stepSize.Interval );
 
-      if ( numSteps++ % 1000 == 1 )
-        {
-        progress =
-          ( currentLine + propagation / this->MaximumPropagation ) / numLines;
-        this->UpdateProgress(progress);
+    // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
+    input = func->GetLastDataSet();
+    inputPD = input->GetPointData();
+    inVectors =
+      input->GetAttributesAsFieldData(this->VecType)->GetArray(this->VecName);
 
-        if (this->GetAbortExecute())
-          {
-          shouldAbort = 1;
-          break;
-          }
-        }
+    // Calculate cell length and speed to be used in unit conversions
+    input->GetCell(func->GetLastCellId(), cell);
+    cellLength = sqrt(static_cast<double>(cell->GetLength2()));
+    speed = speed2;
 
-      // Never call conversion methods if speed == 0
-      if ( (speed == 0) || (speed <= this->TerminalSpeed) )
+    // Check if conversion to float will produce a point in same place
+    float convertedPoint[3];
+    for (i = 0; i < 3; i++)
+      {
+      convertedPoint[i] = point1[i];
+      }
+    if (lastInsertedPoint[0] != convertedPoint[0] ||
+        lastInsertedPoint[1] != convertedPoint[1] ||
+        lastInsertedPoint[2] != convertedPoint[2])
+      {
+      // Point is valid. Insert it.
+      trace.NumberOfPoints++;
+      nextPoint = this->Points->InsertNextPoint(point1);
+      this->Points->GetPoint(nextPoint, lastInsertedPoint);
+      this->Time->InsertNextValue(integrationTime);
+
+      // Interpolate all point attributes on current point
+      func->GetLastWeights(this->Weights);
+      InterpolatePoint(this->PointData, inputPD, nextPoint, cell->PointIds,
+                       this->Weights, self->HasMatchingPointAttributes);
+
+      if (this->VelocityVectors)
         {
-        retVal = STAGNATION;
-        break;
+        this->VelocityVectors->InsertNextTuple(velocity);
         }
-
-      // If, with the next step, propagation will be larger than
-      // max, reduce it so that it is (approximately) equal to max.
-      aStep.Interval = fabs( stepSize.Interval );
-
-      if ( ( propagation + aStep.Interval ) > this->MaximumPropagation )
+      // Compute vorticity if required
+      // This can be used later for streamribbon generation.
+      if (self->ComputeVorticity)
         {
-        aStep.Interval = this->MaximumPropagation - propagation;
-        if ( stepSize.Interval >= 0 )
+        if(this->VecType == vtkDataObject::POINT)
           {
-          stepSize.Interval = this->ConvertToLength( aStep, cellLength );
+          inVectors->GetTuples(cell->PointIds, this->CellVectors);
+          func->GetLastLocalCoordinates(pcoords);
+          self->CalculateVorticity(cell, pcoords, this->CellVectors, vort);
           }
         else
           {
-          stepSize.Interval = this->ConvertToLength( aStep, cellLength ) * ( -1.0 );
+          vort[0] = 0;
+          vort[1] = 0;
+          vort[2] = 0;
           }
-        maxStep = stepSize.Interval;
-        }
-      this->LastUsedStepSize = stepSize.Interval;
-
-      // Calculate the next step using the integrator provided
-      // Break if the next point is out of bounds.
-      func->SetNormalizeVector( true );
-      tmp = integrator->ComputeNextStep( point1, point2, 0, stepSize.Interval,
-                                         stepTaken, minStep, maxStep,
-                                         this->MaximumError, error );
-      func->SetNormalizeVector( false );
-      if ( tmp != 0 )
-        {
-        retVal = tmp;
-        memcpy(lastPoint, point2, 3*sizeof(double));
-        break;
+        this->Vorticity->InsertNextTuple(vort);
+        // rotation
+        // angular velocity = vorticity . unit tangent ( i.e. velocity/speed )
+        // rotation = sum ( angular velocity * stepSize )
+        omega = vtkMath::Dot(vort, velocity);
+        omega /= speed;
+        omega *= self->RotationScale;
+        index = this->AngularVel->InsertNextValue(omega);
+        this->Rotation->InsertNextValue(
+          this->Rotation->GetValue(index-1) +
+          (this->AngularVel->GetValue(index-1) + omega)/2 *
+          (integrationTime - this->Time->GetValue(index-1)));
         }
+      }
 
-      // This is the next starting point
-      if (this->SurfaceStreamlines && surfaceFunc != NULL)
+    // Never call conversion methods if speed == 0
+    if ( (speed == 0) || (speed <= self->TerminalSpeed) )
+      {
+      retVal = vtkStreamTracer::STAGNATION;
+      break;
+      }
+
+    // Convert all intervals to arc length
+    self->ConvertIntervals( step, minStep, maxStep, direction, cellLength );
+
+
+    // If the solver is adaptive and the next step size (stepSize.Interval)
+    // that the solver wants to use is smaller than minStep or larger
+    // than maxStep, re-adjust it. This has to be done every step
+    // because minStep and maxStep can change depending on the cell
+    // size (unless it is specified in arc-length unit)
+    if (this->Integrator->IsAdaptive())
+      {
+      if (fabs(stepSize.Interval) < fabs(minStep))
         {
-        if (surfaceFunc->SnapPointOnCell(point2, point1) != 1)
-          {
-          retVal = OUT_OF_DOMAIN;
-          memcpy(lastPoint, point2, 3 * sizeof(double));
-          break;
-          }
+        stepSize.Interval = fabs( minStep ) *
+                              stepSize.Interval / fabs( stepSize.Interval );
         }
-      else
+      else if (fabs(stepSize.Interval) > fabs(maxStep))
         {
-        for (i = 0; i < 3; i++)
-          {
-          point1[i] = point2[i];
-          }
+        stepSize.Interval = fabs( maxStep ) *
+                              stepSize.Interval / fabs( stepSize.Interval );
         }
+      }
+    else
+      {
+      stepSize.Interval = step;
+      }
 
-      // Interpolate the velocity at the next point
-      if ( !func->FunctionValues(point2, velocity) )
-        {
-        retVal = OUT_OF_DOMAIN;
-        memcpy(lastPoint, point2, 3*sizeof(double));
-        break;
-        }
+    // End Integration
+    }
 
-      // It is not enough to use the starting point for stagnation calculation
-      // Use average speed to check if it is below stagnation threshold
-      double speed2 = vtkMath::Norm(velocity);
-      if ( (speed+speed2)/2 <= this->TerminalSpeed )
-        {
-        retVal = STAGNATION;
-        break;
-        }
+  trace.ReasonForTermination = retVal;
+  trace.Propagation = propagation;
+  trace.NumberOfSteps = numSteps;
+  trace.IntegrationTime = integrationTime;
+  this->Traces.push_back(trace);
+
+  // Initialize these to 0 before starting the next line.
+  // The values passed to Integrate() are only used for the first line.
+  this->Propagation = 0;
+  this->NumberOfSteps = 0;
+  this->IntegrationTime = 0;
+}
 
-      integrationTime += stepTaken / speed;
-      // Calculate propagation (using the same units as MaximumPropagation
-      propagation += fabs( stepSize.Interval );
+namespace
+{
+// Integrates the seeds of a range with the integrator of the calling thread.
+// Each thread evaluates the velocity field with its own copy of the
+// interpolator.
+class vtkStreamTracerIntegrateSeeds
+{
+public:
+  vtkStreamTracer *Self;
+  vtkCompositeInterpolatedVelocityField *Func;
+  vtkPointData *InputPD;
+  vtkIdType MaximumNumberOfSteps;
+  vtkDataArray *SeedSource;
+  vtkIdList *SeedIds;
+  vtkIntArray *IntegrationDirections;
+  int MaxCellSize;
+  int VecType;
+  const char *VecName;
+  vtkSMPThreadLocal<vtkStreamTracerSeedIntegrator*> Integrators;
+
+  void Initialize()
+  {
+    vtkCompositeInterpolatedVelocityField *func = this->Func->NewThreadInstance();
+    vtkPointData *pointData = vtkPointData::New();
+    // See Integrate() for the size of the allocation
+    pointData->InterpolateAllocate(this->InputPD, this->MaximumNumberOfSteps);
+    this->Integrators.Local() = new vtkStreamTracerSeedIntegrator(
+      this->Self, func, pointData, this->SeedSource, this->SeedIds,
+      this->IntegrationDirections, this->MaxCellSize, this->VecType,
+      this->VecName, true);
+    func->Delete();
+    pointData->Delete();
+  }
 
-      // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
-      input = func->GetLastDataSet();
-      inputPD = input->GetPointData();
-      inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkStreamTracerSeedIntegrator *integrator = this->Integrators.Local();
+    for (vtkIdType currentLine = begin;
+         currentLine < end && !integrator->Aborted; ++currentLine)
+      {
+      integrator->IntegrateSeed(currentLine);
+      }
+  }
 
-      // Calculate cell length and speed to be used in unit conversions
-      input->GetCell(func->GetLastCellId(), cell);
-      cellLength = sqrt(static_cast<double>(cell->GetLength2()));
-      speed = speed2;
+  void Reduce()
+  {
+  }
+};
 
-      // Check if conversion to float will produce a point in same place
-      float convertedPoint[3];
-      for (i = 0; i < 3; i++)
-        {
-        convertedPoint[i] = point1[i];
-        }
-      if (lastInsertedPoint[0] != convertedPoint[0] ||
-          lastInsertedPoint[1] != convertedPoint[1] ||
-          lastInsertedPoint[2] != convertedPoint[2])
-        {
-        // Point is valid. Insert it.
-        numPts++;
-        numPtsTotal++;
-        nextPoint = outputPoints->InsertNextPoint(point1);
-        outputPoints->GetPoint(nextPoint, lastInsertedPoint);
-        time->InsertNextValue(integrationTime);
-
-        // Interpolate all point attributes on current point
-        func->GetLastWeights(weights);
-        InterpolatePoint(outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
-
-        if(vecType != vtkDataObject::POINT)
-          {
-          velocityVectors->InsertNextTuple(velocity);
-          }
-        // Compute vorticity if required
-        // This can be used later for streamribbon generation.
-        if (this->ComputeVorticity)
-          {
-          if(vecType == vtkDataObject::POINT)
-            {
-            inVectors->GetTuples(cell->PointIds, cellVectors);
-            func->GetLastLocalCoordinates(pcoords);
-            vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
-            }
-          else
-            {
-            vort[0] = 0;
-            vort[1] = 0;
-            vort[2] = 0;
-            }
-          vorticity->InsertNextTuple(vort);
-          // rotation
-          // angular velocity = vorticity . unit tangent ( i.e. velocity/speed )
-          // rotation = sum ( angular velocity * stepSize )
-          omega = vtkMath::Dot(vort, velocity);
-          omega /= speed;
-          omega *= this->RotationScale;
-          index = angularVel->InsertNextValue(omega);
-          rotation->InsertNextValue(rotation->GetValue(index-1) +
-                                    (angularVel->GetValue(index-1) + omega)/2 *
-                                    (integrationTime - time->GetValue(index-1)));
-          }
-        }
+bool vtkStreamTracerSeedLess(const vtkStreamTracerSeedIntegrator::Trace *a,
+                             const vtkStreamTracerSeedIntegrator::Trace *b)
+{
+  return a->Seed < b->Seed;
+}
+
+bool vtkStreamTracerAreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(i));
+    if (!array || array->GetDataType() == VTK_BIT ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  return true;
+}
 
-      // Never call conversion methods if speed == 0
-      if ( (speed == 0) || (speed <= this->TerminalSpeed) )
+// Copies the points of the traces, in seed order, from the buffers of the
+// threads to the output.
+struct vtkStreamTracerCopyTraces
+{
+  const vtkStreamTracerSeedIntegrator::Trace * const *Traces;
+  const vtkIdType *Offsets;
+  vtkPoints *Points;
+  vtkDataSetAttributes *PointData;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType t = begin; t < end; ++t)
+      {
+      const vtkStreamTracerSeedIntegrator::Trace *trace = this->Traces[t];
+      for (vtkIdType i = 0; i < trace->NumberOfPoints; ++i)
         {
-        retVal = STAGNATION;
-        break;
+        trace->Points->GetPoint(trace->FirstPoint + i, x);
+        this->Points->SetPoint(this->Offsets[t] + i, x);
+        this->PointData->CopyData(trace->PointData, trace->FirstPoint + i,
+                                  this->Offsets[t] + i);
         }
+      }
+  }
+};
+}
 
-      // Convert all intervals to arc length
-      this->ConvertIntervals( step, minStep, maxStep, direction, cellLength );
+void vtkStreamTracer::Integrate(vtkPointData *input0Data,
+                                vtkPolyData* output,
+                                vtkDataArray* seedSource,
+                                vtkIdList* seedIds,
+                                vtkIntArray* integrationDirections,
+                                double lastPoint[3],
+                                vtkAbstractInterpolatedVelocityField* func,
+                                int maxCellSize,
+                                int vecType,
+                                const char *vecName,
+                                double& inPropagation,
+                                vtkIdType& inNumSteps,
+                                double &inIntegrationTime)
+{
+  vtkIdType numLines = seedIds->GetNumberOfIds();
 
+  // Useful pointers
+  vtkDataSetAttributes* outputPD = output->GetPointData();
+  vtkDataSetAttributes* outputCD = output->GetCellData();
 
-      // If the solver is adaptive and the next step size (stepSize.Interval)
-      // that the solver wants to use is smaller than minStep or larger
-      // than maxStep, re-adjust it. This has to be done every step
-      // because minStep and maxStep can change depending on the cell
-      // size (unless it is specified in arc-length unit)
-      if (integrator->IsAdaptive())
-        {
-        if (fabs(stepSize.Interval) < fabs(minStep))
-          {
-          stepSize.Interval = fabs( minStep ) *
-                                stepSize.Interval / fabs( stepSize.Interval );
-          }
-        else if (fabs(stepSize.Interval) > fabs(maxStep))
-          {
-          stepSize.Interval = fabs( maxStep ) *
-                                stepSize.Interval / fabs( stepSize.Interval );
-          }
-        }
-      else
-        {
-        stepSize.Interval = step;
-        }
+  if (this->GetIntegrator() == 0)
+    {
+    vtkErrorMacro("No integrator is specified.");
+    return;
+    }
 
-      // End Integration
+  // Check Surface option
+  vtkInterpolatedVelocityField* surfaceFunc = NULL;
+  if (this->SurfaceStreamlines == true)
+    {
+    surfaceFunc = vtkInterpolatedVelocityField::SafeDownCast(func);
+    if (surfaceFunc == NULL)
+      {
+        vtkWarningMacro(<< "Surface Streamlines works only with Point Locator "
+                           "Interpolated Velocity Field, setting it off");
+        this->SetSurfaceStreamlines(false);
       }
-
-    if (shouldAbort)
+    else
       {
-      break;
+      surfaceFunc->SetForceSurfaceTangentVector(true);
+      surfaceFunc->SetSurfaceDataset(true);
       }
+    }
 
-    if (numPts > 1)
+  // The seeds are integrated in parallel when the interpolator can be
+  // copied for each thread, and the first seed starts from scratch (as in
+  // RequestData()). Each thread appends its streamlines to its own buffers,
+  // which are then gathered in seed order.
+  vtkCompositeInterpolatedVelocityField* compositeFunc =
+    vtkCompositeInterpolatedVelocityField::SafeDownCast(func);
+  bool threaded = numLines > 1 && compositeFunc &&
+    !this->SurfaceStreamlines && this->HasMatchingPointAttributes &&
+    inPropagation == 0 && inNumSteps == 0 && inIntegrationTime == 0;
+
+  std::vector<vtkStreamTracerSeedIntegrator*> integrators;
+  if (threaded)
+    {
+    compositeFunc->BuildFindCellStructures();
+    vtkStreamTracerIntegrateSeeds integrateSeeds;
+    integrateSeeds.Self = this;
+    integrateSeeds.Func = compositeFunc;
+    integrateSeeds.InputPD = input0Data;
+    integrateSeeds.MaximumNumberOfSteps = this->MaximumNumberOfSteps;
+    integrateSeeds.SeedSource = seedSource;
+    integrateSeeds.SeedIds = seedIds;
+    integrateSeeds.IntegrationDirections = integrationDirections;
+    integrateSeeds.MaxCellSize = maxCellSize;
+    integrateSeeds.VecType = vecType;
+    integrateSeeds.VecName = vecName;
+    // streamlines differ widely in length: hand out the seeds one at a time
+    vtkSMPTools::For(0, numLines, 1, integrateSeeds);
+    vtkSMPThreadLocal<vtkStreamTracerSeedIntegrator*>::iterator iter;
+    for (iter = integrateSeeds.Integrators.begin();
+         iter != integrateSeeds.Integrators.end(); ++iter)
       {
-      outputLines->InsertNextCell(numPts);
-      for (i=numPtsTotal-numPts; i<numPtsTotal; i++)
-        {
-        outputLines->InsertCellPoint(i);
-        }
-      retVals->InsertNextValue(retVal);
-      sids->InsertNextValue(seedIds->GetId(currentLine));
+      integrators.push_back(*iter);
       }
+    }
+  else
+    {
+    // We will interpolate all point attributes of the input on each point of
+    // the output (unless they are turned off). Note that we are using only
+    // the first input, if there are more than one, the attributes have to match.
+    //
+    // Note: We have to use a specific value (safe to employ the maximum number
+    //       of steps) as the size of the initial memory allocation here. The
+    //       use of the default argument might incur a crash problem (due to
+    //       "insufficient memory") in the parallel mode. This is the case when
+    //       a streamline intensely shuttles between two processes in an exactly
+    //       interleaving fashion --- only one point is produced on each process
+    //       (and actually two points, after point duplication, are saved to a
+    //       vtkPolyData in vtkDistributedStreamTracer::NoBlockProcessTask) and
+    //       as a consequence a large number of such small vtkPolyData objects
+    //       are needed to represent a streamline, consuming up the memory before
+    //       the intermediate memory is timely released.
+    outputPD->InterpolateAllocate( input0Data,
+                                   this->MaximumNumberOfSteps );
+
+    vtkStreamTracerSeedIntegrator* integrator =
+      new vtkStreamTracerSeedIntegrator(this, func, outputPD, seedSource,
+                                        seedIds, integrationDirections,
+                                        maxCellSize, vecType, vecName, false);
+    integrator->Propagation = inPropagation;
+    integrator->NumberOfSteps = inNumSteps;
+    integrator->IntegrationTime = inIntegrationTime;
+    for (vtkIdType currentLine = 0;
+         currentLine < numLines && !integrator->Aborted; currentLine++)
+      {
+      integrator->IntegrateSeed(currentLine);
+      }
+    integrators.push_back(integrator);
+    }
 
-    // Initialize these to 0 before starting the next line.
-    // The values passed in the function call are only used
-    // for the first line.
-    inPropagation = propagation;
-    inNumSteps = numSteps;
-    inIntegrationTime = integrationTime;
+  // Gather the streamlines in seed order
+  bool shouldAbort = false;
+  std::vector<const vtkStreamTracerSeedIntegrator::Trace*> traces;
+  size_t t;
+  for (size_t i = 0; i < integrators.size(); i++)
+    {
+    shouldAbort = shouldAbort || integrators[i]->Aborted;
+    for (t = 0; t < integrators[i]->Traces.size(); t++)
+      {
+      traces.push_back(&integrators[i]->Traces[t]);
+      }
+    }
+  std::sort(traces.begin(), traces.end(), vtkStreamTracerSeedLess);
 
-    propagation = 0;
-    numSteps = 0;
-    integrationTime = 0;
+  std::vector<vtkIdType> offsets(traces.size() + 1, 0);
+  for (t = 0; t < traces.size(); t++)
+    {
+    offsets[t + 1] = offsets[t] + traces[t]->NumberOfPoints;
     }
+  vtkIdType numPts = offsets[traces.size()];
 
   if (!shouldAbort)
     {
-    // Create the output polyline
-    output->SetPoints(outputPoints);
-    outputPD->AddArray(time);
-    if(vecType != vtkDataObject::POINT)
+    for (size_t i = 0; i < integrators.size(); i++)
       {
-      outputPD->AddArray(velocityVectors);
+      integrators[i]->AddPointArrays();
       }
-    if (vorticity)
+
+    vtkPoints* outputPoints;
+    if (threaded)
+      {
+      outputPoints = vtkPoints::New();
+      outputPoints->SetNumberOfPoints(numPts);
+      vtkDataSetAttributes* buffersPD = integrators[0]->PointData;
+      outputPD->CopyAllocate(buffersPD, numPts);
+      vtkStreamTracerCopyTraces copyTraces =
+        { traces.empty() ? NULL : &traces[0], &offsets[0], outputPoints,
+          outputPD };
+      vtkIdType numTraces = static_cast<vtkIdType>(traces.size());
+      if (vtkStreamTracerAreArraysThreadSafe(buffersPD))
+        {
+        outputPD->SetNumberOfTuples(numPts);
+        vtkSMPTools::For(0, numTraces, copyTraces);
+        }
+      else
+        {
+        copyTraces(0, numTraces);
+        }
+      }
+    else
       {
-      outputPD->AddArray(vorticity);
-      outputPD->AddArray(rotation);
-      outputPD->AddArray(angularVel);
+      // the single integrator wrote the point data of the output
+      outputPoints = integrators[0]->Points;
+      outputPoints->Register(this);
       }
 
-    vtkIdType numPts = outputPoints->GetNumberOfPoints();
+    vtkCellArray* outputLines = vtkCellArray::New();
+
+    // This array explains why the integration stopped
+    vtkIntArray* retVals = vtkIntArray::New();
+    retVals->SetName("ReasonForTermination");
+
+    vtkIntArray* sids = vtkIntArray::New();
+    sids->SetName("SeedIds");
+
+    for (t = 0; t < traces.size(); t++)
+      {
+      if (traces[t]->NumberOfPoints > 1)
+        {
+        outputLines->InsertNextCell(traces[t]->NumberOfPoints);
+        for (vtkIdType i = offsets[t]; i < offsets[t + 1]; i++)
+          {
+          outputLines->InsertCellPoint(i);
+          }
+        retVals->InsertNextValue(traces[t]->ReasonForTermination);
+        sids->InsertNextValue(seedIds->GetId(traces[t]->Seed));
+        }
+      }
+
+    // Create the output polyline
+    output->SetPoints(outputPoints);
     if ( numPts > 1 )
       {
       // Assign geometry and attributes
@@ -1174,32 +1508,29 @@ void vtkStreamTracer::Integrate(vtkPointData *input0Data,
       outputCD->AddArray(retVals);
       outputCD->AddArray(sids);
       }
+
+    retVals->Delete();
+    sids->Delete();
+    outputPoints->UnRegister(this);
+    outputLines->Delete();
     }
 
-  if (vorticity)
+  // The values of the last streamline integrated are returned
+  for (t = 0; t < traces.size(); t++)
     {
-    vorticity->Delete();
-    rotation->Delete();
-    angularVel->Delete();
+    inPropagation = traces[t]->Propagation;
+    inNumSteps = traces[t]->NumberOfSteps;
+    inIntegrationTime = traces[t]->IntegrationTime;
+    if (traces[t]->HasLastPoint)
+      {
+      memcpy(lastPoint, traces[t]->LastPoint, 3*sizeof(double));
+      }
     }
 
-  if (cellVectors)
+  for (size_t i = 0; i < integrators.size(); i++)
     {
-    cellVectors->Delete();
+    delete integrators[i];
     }
-  retVals->Delete();
-  sids->Delete();
-
-  outputPoints->Delete();
-  outputLines->Delete();
-
-  time->Delete();
-
-
-  integrator->Delete();
-  cell->Delete();
-
-  delete[] weights;
 
   output->Squeeze();
   return;
@@ -67,6 +67,14 @@
 // a source object, traces will be generated from each point in the source
 // that is inside the dataset.
 //
+// When the velocity field is interpolated by a vtkInterpolatedVelocityField
+// or a vtkCellLocatorInterpolatedVelocityField (i.e., unless the input is a
+// vtkOverlappingAMR), the streamlines of the seeds are integrated in
+// parallel (via vtkSMPTools). Each thread evaluates the field with its own
+// copy of the interpolator, and the cell locators are shared. The output is
+// the same as with a serial integration: the streamlines are in the order
+// of their seeds. Surface streamlines are integrated serially.
+//
 // .SECTION See Also
 // vtkRibbonFilter vtkRuledSurfaceFilter vtkInitialValueProblemSolver
 // vtkRungeKutta2 vtkRungeKutta4 vtkRungeKutta45 vtkTemporalStreamTracer
@@ -400,6 +408,9 @@ protected:
   bool HasMatchingPointAttributes; //does the point data in the multiblocks have the same attributes?
 
   friend class PStreamTracerUtils;
+//BTX
+  friend class vtkStreamTracerSeedIntegrator;
+//ETX
 
 private:
   vtkStreamTracer(const vtkStreamTracer&);  // Not implemented.
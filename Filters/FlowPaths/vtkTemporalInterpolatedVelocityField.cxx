@@ -150,6 +150,27 @@ void vtkTemporalInterpolatedVelocityField::AdvanceOneTimeStep()
     }
 }
 //---------------------------------------------------------------------------
+void vtkTemporalInterpolatedVelocityField::BuildFindCellStructures()
+{
+  this->IVF[0]->BuildFindCellStructures();
+  this->IVF[1]->BuildFindCellStructures();
+}
+//---------------------------------------------------------------------------
+vtkTemporalInterpolatedVelocityField *
+vtkTemporalInterpolatedVelocityField::NewThreadInstance()
+{
+  vtkTemporalInterpolatedVelocityField *ivf =
+    vtkTemporalInterpolatedVelocityField::New();
+  for (int T=0; T<2; T++)
+    {
+    ivf->IVF[T]->ShareDataSets(this->IVF[T]);
+    ivf->Times[T] = this->Times[T];
+    }
+  ivf->ScaleCoeff     = this->ScaleCoeff;
+  ivf->StaticDataSets = this->StaticDataSets;
+  return ivf;
+}
+//---------------------------------------------------------------------------
 void vtkTemporalInterpolatedVelocityField::ShowCacheResults()
 {
   vtkErrorMacro(<< ")\n"
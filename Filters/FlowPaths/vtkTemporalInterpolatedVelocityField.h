@@ -29,7 +29,7 @@
 //
 // .SECTION Caveats
 // vtkTemporalInterpolatedVelocityField is probably not thread safe.
-// A new instance should be created by each thread.
+// A new instance should be created by each thread, see NewThreadInstance().
 //
 // Datasets are added in lists. The list for T1 must be idential to that for T0
 // in structure/topology and dataset order, and any datasets marked as static,
@@ -133,6 +133,19 @@ public:
 
   void AdvanceOneTimeStep();
 
+  // Description:
+  // Build the cell locators and search structures of the data sets of
+  // both times, so that the instances returned by NewThreadInstance() can
+  // be evaluated concurrently. Call it from a single thread once the data
+  // sets have been set.
+  void BuildFindCellStructures();
+
+  // Description:
+  // Return a new instance, owned by the caller, that shares the data sets,
+  // velocity arrays and cell locators of this one but keeps its own cached
+  // cells and weights, for use by another thread.
+  vtkTemporalInterpolatedVelocityField *NewThreadInstance();
+
 protected:
   vtkTemporalInterpolatedVelocityField();
   ~vtkTemporalInterpolatedVelocityField();
@@ -17,10 +17,17 @@
 #include "vtkPointData.h"
 
 #include "vtkCellTreeLocator.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
 #include "vtkNew.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSphereSource.h"
 
+#include <vector>
+
 #include "vtkDebugLeaks.h"
 
 int TestWithCachedCellBoundsParameter(int cachedCellBounds)
@@ -98,9 +105,134 @@ int TestWithCachedCellBoundsParameter(int cachedCellBounds)
   return EXIT_SUCCESS;
 }
 
+// Locate points from several threads, each with its own cell and traversal
+// stack, and count the points found in the wrong cell.
+class FindCellsInThreads
+{
+public:
+  vtkCellTreeLocator *Locator;
+  const std::vector<double> &Points;
+  const std::vector<vtkIdType> &Expected;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<vtkCellTreeLocator::vtkTraversalStack> Stack;
+  vtkSMPThreadLocal<int> Errors;
+
+  FindCellsInThreads(vtkCellTreeLocator *locator, const std::vector<double> &points,
+                     const std::vector<vtkIdType> &expected) :
+    Locator(locator), Points(points), Expected(expected)
+  {
+  }
+
+  void Initialize()
+  {
+    this->Errors.Local() = 0;
+  }
+
+  void operator()(vtkIdType i, vtkIdType end)
+  {
+    vtkGenericCell *cell = this->Cell.Local();
+    vtkCellTreeLocator::vtkTraversalStack &stack = this->Stack.Local();
+    int &errors = this->Errors.Local();
+    double pcoords[3], weights[8];
+    for ( ; i < end; ++i )
+      {
+      if (this->Locator->FindCell(&this->Points[3*i], cell, pcoords, weights,
+                                  &stack) != this->Expected[i])
+        {
+        ++errors;
+        }
+      }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+int TestThreadSafeQueries()
+{
+  // An image with enough cells for the parallel build of the tree.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(61, 61, 41);
+  image->SetOrigin(-1.0, -1.0, -1.0);
+  image->SetSpacing(0.1, 0.1, 0.1);
+
+  vtkNew<vtkCellTreeLocator> locator;
+  locator->SetDataSet(image.GetPointer());
+  locator->CacheCellBoundsOn();
+  locator->BuildLocator();
+
+  // Random points away from the faces of the cells
+  const vtkIdType numPoints = 20000;
+  std::vector<double> points(3 * numPoints);
+  std::vector<vtkIdType> expected(numPoints);
+  const int dims[3] = { 60, 60, 40 };
+  vtkMath::RandomSeed(4242);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    int ijk[3];
+    for (int j = 0; j < 3; ++j)
+      {
+      ijk[j] = static_cast<int>(vtkMath::Random(0.0, dims[j])) % dims[j];
+      points[3*i+j] = -1.0 + 0.1 * (ijk[j] + vtkMath::Random(0.05, 0.95));
+      }
+    expected[i] = ijk[0] + dims[0] * (ijk[1] + dims[1] * ijk[2]);
+    }
+
+  vtkNew<vtkGenericCell> cell;
+  vtkCellTreeLocator::vtkTraversalStack stack;
+  double pcoords[3], weights[8];
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    vtkIdType cellId = locator->FindCell(&points[3*i], cell.GetPointer(),
+                                         pcoords, weights, &stack);
+    if (cellId != expected[i] ||
+        locator->FindCell(&points[3*i], 0.0, cell.GetPointer(), pcoords,
+                          weights) != cellId)
+      {
+      vtkGenericWarningMacro("ERROR: point " << i << " found in cell "
+                             << cellId << " instead of " << expected[i]);
+      return EXIT_FAILURE;
+      }
+    }
+
+  FindCellsInThreads finder(locator.GetPointer(), points, expected);
+  vtkSMPTools::For(0, numPoints, finder);
+  int errors = 0;
+  for (vtkSMPThreadLocal<int>::iterator it = finder.Errors.begin();
+       it != finder.Errors.end(); ++it)
+    {
+    errors += *it;
+    }
+  if (errors != 0)
+    {
+    vtkGenericWarningMacro("ERROR: " << errors << " errors in threaded FindCell");
+    return EXIT_FAILURE;
+    }
+
+  // Rays along x hit the first cell of their row, with or without a cell.
+  double p1[3] = { -2.0, 0.01, 0.01 }, p2[3] = { 6.0, 0.01, 0.01 };
+  double t, x[3];
+  int subId;
+  vtkIdType cellId = -1, legacyId = -1;
+  if (!locator->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId, cellId,
+                                  cell.GetPointer(), &stack) ||
+      !locator->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId, legacyId) ||
+      cellId != legacyId || cellId != dims[0] * (10 + dims[1] * 10) ||
+      cell->GetCellType() != VTK_VOXEL)
+    {
+    vtkGenericWarningMacro("ERROR: bad ray intersection " << cellId << " "
+                           << legacyId);
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
+
 int CellTreeLocator( int vtkNotUsed(argc), char *vtkNotUsed(argv)[] )
 {
   int retVal = TestWithCachedCellBoundsParameter(0);
   retVal += TestWithCachedCellBoundsParameter(1);
+  retVal += TestThreadSafeQueries();
   return retVal;
 }
@@ -0,0 +1,141 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestIntersectionPolyDataFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkIntersectionPolyDataFilter and
+// vtkBooleanOperationPolyDataFilter produce the same outputs with
+// IntersectInParallel on as with it off.
+
+#include "vtkBooleanOperationPolyDataFilter.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkIntersectionPolyDataFilter.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+
+namespace
+{
+
+bool SameArrays(vtkDataArray *expected, vtkDataArray *output,
+                const char *what)
+{
+  if (!expected && !output)
+    {
+    return true;
+    }
+  if (!expected || !output ||
+      expected->GetNumberOfTuples() != output->GetNumberOfTuples() ||
+      expected->GetNumberOfComponents() != output->GetNumberOfComponents())
+    {
+    cerr << what << ": different arrays" << endl;
+    return false;
+    }
+  int numComps = expected->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+    {
+    for (int j = 0; j < numComps; ++j)
+      {
+      if (expected->GetComponent(i, j) != output->GetComponent(i, j))
+        {
+        cerr << what << ": different value at tuple " << i << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool SameOutputs(vtkPolyData *expected, vtkPolyData *output,
+                 const char *what)
+{
+  if (expected->GetNumberOfCells() == 0 ||
+      expected->GetNumberOfCells() != output->GetNumberOfCells())
+    {
+    cerr << what << ": different number of cells" << endl;
+    return false;
+    }
+  return SameArrays(expected->GetPoints()->GetData(),
+                    output->GetPoints()->GetData(), what) &&
+    SameArrays(expected->GetLines()->GetData(),
+               output->GetLines()->GetData(), what) &&
+    SameArrays(expected->GetPolys()->GetData(),
+               output->GetPolys()->GetData(), what) &&
+    SameArrays(expected->GetPointData()->GetNormals(),
+               output->GetPointData()->GetNormals(), what) &&
+    SameArrays(expected->GetCellData()->GetArray("Input0CellID"),
+               output->GetCellData()->GetArray("Input0CellID"), what);
+}
+
+// Runs the filter serially then in parallel and compares the outputs.
+template <class T>
+bool Check(T *filter, int numOutputs, const char *what)
+{
+  filter->IntersectInParallelOff();
+  filter->Update();
+  vtkNew<vtkPolyData> expected[3];
+  for (int i = 0; i < numOutputs; ++i)
+    {
+    expected[i]->DeepCopy(filter->GetOutput(i));
+    }
+
+  filter->IntersectInParallelOn();
+  filter->Update();
+  for (int i = 0; i < numOutputs; ++i)
+    {
+    if (!SameOutputs(expected[i].GetPointer(), filter->GetOutput(i), what))
+      {
+      cerr << "Output " << i << " differs" << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int TestIntersectionPolyDataFilterParallel(int, char *[])
+{
+  vtkNew<vtkSphereSource> sphere0;
+  sphere0->SetCenter(0.0, 0.0, 0.0);
+  sphere0->SetRadius(2.0);
+  sphere0->SetPhiResolution(41);
+  sphere0->SetThetaResolution(37);
+
+  vtkNew<vtkSphereSource> sphere1;
+  sphere1->SetCenter(1.0, 0.3, 0.2);
+  sphere1->SetRadius(2.0);
+  sphere1->SetPhiResolution(43);
+  sphere1->SetThetaResolution(39);
+
+  vtkNew<vtkIntersectionPolyDataFilter> intersection;
+  intersection->SetInputConnection(0, sphere0->GetOutputPort());
+  intersection->SetInputConnection(1, sphere1->GetOutputPort());
+  if (!Check(intersection.GetPointer(), 3, "vtkIntersectionPolyDataFilter"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkBooleanOperationPolyDataFilter> boolean;
+  boolean->SetInputConnection(0, sphere0->GetOutputPort());
+  boolean->SetInputConnection(1, sphere1->GetOutputPort());
+  boolean->SetOperationToDifference();
+  if (!Check(boolean.GetPointer(), 1, "vtkBooleanOperationPolyDataFilter"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
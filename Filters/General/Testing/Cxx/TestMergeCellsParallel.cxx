@@ -0,0 +1,228 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMergeCellsParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkMergeCells with MergeInParallel on merges overlapping pieces
+// of a grid like the serial merge, when joining the global point and cell
+// ids and when merging coincident points with a locator.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMergeCells.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vector>
+
+namespace
+{
+
+const int NumberOfPieces = 4;
+const int CellDims[3] = { 40, 10, 5 };
+
+// Piece k of the grid, which overlaps the previous one by a layer of cells
+vtkImageData *MakePiece(int k)
+{
+  vtkImageData *image = vtkImageData::New();
+  int x0 = k > 0 ? 10 * k - 1 : 0;
+  image->SetExtent(x0, 10 * k + 10, 0, CellDims[1], 0, CellDims[2]);
+
+  vtkIdType numPts = image->GetNumberOfPoints();
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("GlobalNodeIds");
+  pointIds->SetNumberOfTuples(numPts);
+  vtkNew<vtkDoubleArray> elevation;
+  elevation->SetName("Elevation");
+  elevation->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    double x[3];
+    image->GetPoint(i, x);
+    int ijk[3] = { static_cast<int>(x[0]), static_cast<int>(x[1]),
+                   static_cast<int>(x[2]) };
+    pointIds->SetValue(i, ijk[0] + (CellDims[0] + 1) *
+                       (ijk[1] + (CellDims[1] + 1) * ijk[2]));
+    elevation->SetValue(i, x[0] + 2.0 * x[1] + 3.0 * x[2]);
+    }
+  image->GetPointData()->SetGlobalIds(pointIds.GetPointer());
+  image->GetPointData()->SetScalars(elevation.GetPointer());
+
+  vtkIdType numCells = image->GetNumberOfCells();
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("GlobalCellIds");
+  cellIds->SetNumberOfTuples(numCells);
+  vtkNew<vtkFloatArray> values;
+  values->SetName("CellValues");
+  values->SetNumberOfTuples(numCells);
+  int dims[3];
+  image->GetDimensions(dims);
+  for (vtkIdType c = 0; c < numCells; ++c)
+    {
+    int i = static_cast<int>(c % (dims[0] - 1)) + x0;
+    int j = static_cast<int>((c / (dims[0] - 1)) % (dims[1] - 1));
+    int l = static_cast<int>(c / ((dims[0] - 1) * (dims[1] - 1)));
+    vtkIdType gid = i + CellDims[0] * (j + CellDims[1] * l);
+    cellIds->SetValue(c, gid);
+    values->SetValue(c, 0.5f * gid);
+    }
+  image->GetCellData()->SetGlobalIds(cellIds.GetPointer());
+  image->GetCellData()->SetScalars(values.GetPointer());
+  return image;
+}
+
+vtkUnstructuredGrid *Merge(vtkImageData **pieces, bool useGlobalIds,
+                           bool parallel)
+{
+  vtkUnstructuredGrid *ugrid = vtkUnstructuredGrid::New();
+  vtkNew<vtkMergeCells> merge;
+  merge->SetUnstructuredGrid(ugrid);
+  vtkIdType numPts = 0, numCells = 0;
+  for (int k = 0; k < NumberOfPieces; ++k)
+    {
+    numPts += pieces[k]->GetNumberOfPoints();
+    numCells += pieces[k]->GetNumberOfCells();
+    }
+  merge->SetTotalNumberOfDataSets(NumberOfPieces);
+  merge->SetTotalNumberOfPoints(numPts);
+  merge->SetTotalNumberOfCells(numCells);
+  merge->SetUseGlobalIds(useGlobalIds);
+  merge->SetUseGlobalCellIds(useGlobalIds);
+  merge->SetPointMergeTolerance(0.0);
+  merge->SetMergeInParallel(parallel);
+  for (int k = 0; k < NumberOfPieces; ++k)
+    {
+    merge->MergeDataSet(pieces[k]);
+    }
+  merge->Finish();
+  return ugrid;
+}
+
+bool SameArrays(vtkFieldData *expected, vtkFieldData *output,
+                const char *what)
+{
+  if (expected->GetNumberOfArrays() != output->GetNumberOfArrays())
+    {
+    cerr << what << ": different numbers of arrays" << endl;
+    return false;
+    }
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+    {
+    vtkDataArray *e = expected->GetArray(a);
+    vtkDataArray *o = output->GetArray(e->GetName());
+    if (!o || o->GetNumberOfTuples() != e->GetNumberOfTuples())
+      {
+      cerr << what << ": array " << e->GetName() << " differs" << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < e->GetNumberOfTuples(); ++i)
+      {
+      if (e->GetTuple1(i) != o->GetTuple1(i))
+        {
+        cerr << what << ": array " << e->GetName() << " differs at " << i
+             << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool SameGrids(vtkUnstructuredGrid *expected, vtkUnstructuredGrid *output,
+               const char *what)
+{
+  if (expected->GetNumberOfPoints() != output->GetNumberOfPoints() ||
+      expected->GetNumberOfCells() != output->GetNumberOfCells())
+    {
+    cerr << what << ": " << output->GetNumberOfPoints() << " points and "
+         << output->GetNumberOfCells() << " cells instead of "
+         << expected->GetNumberOfPoints() << " and "
+         << expected->GetNumberOfCells() << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); ++i)
+    {
+    double x[3], y[3];
+    expected->GetPoint(i, x);
+    output->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+      cerr << what << ": point " << i << " differs" << endl;
+      return false;
+      }
+    }
+  vtkNew<vtkIdList> e;
+  vtkNew<vtkIdList> o;
+  for (vtkIdType c = 0; c < expected->GetNumberOfCells(); ++c)
+    {
+    expected->GetCellPoints(c, e.GetPointer());
+    output->GetCellPoints(c, o.GetPointer());
+    bool same = expected->GetCellType(c) == output->GetCellType(c) &&
+      e->GetNumberOfIds() == o->GetNumberOfIds();
+    for (vtkIdType i = 0; same && i < e->GetNumberOfIds(); ++i)
+      {
+      same = e->GetId(i) == o->GetId(i);
+      }
+    if (!same)
+      {
+      cerr << what << ": cell " << c << " differs" << endl;
+      return false;
+      }
+    }
+  return SameArrays(expected->GetPointData(), output->GetPointData(), what) &&
+    SameArrays(expected->GetCellData(), output->GetCellData(), what);
+}
+
+}
+
+int TestMergeCellsParallel(int, char *[])
+{
+  vtkImageData *pieces[NumberOfPieces];
+  for (int k = 0; k < NumberOfPieces; ++k)
+    {
+    pieces[k] = MakePiece(k);
+    }
+
+  bool ok = true;
+  const char *what[2] = { "locator merge", "global id merge" };
+  for (int useGlobalIds = 0; ok && useGlobalIds < 2; ++useGlobalIds)
+    {
+    vtkUnstructuredGrid *expected = Merge(pieces, useGlobalIds != 0, false);
+    vtkUnstructuredGrid *output = Merge(pieces, useGlobalIds != 0, true);
+    ok = SameGrids(expected, output, what[useGlobalIds]);
+
+    // The overlaps are merged in both cases, and with global cell ids the
+    // duplicated cells are dropped
+    vtkIdType numPts = (CellDims[0] + 1) * (CellDims[1] + 1) * (CellDims[2] + 1);
+    vtkIdType numCells = CellDims[0] * CellDims[1] * CellDims[2];
+    if (ok && (output->GetNumberOfPoints() != numPts ||
+               (useGlobalIds && output->GetNumberOfCells() != numCells)))
+      {
+      cerr << what[useGlobalIds] << ": overlaps are not merged" << endl;
+      ok = false;
+      }
+    expected->Delete();
+    output->Delete();
+    }
+
+  for (int k = 0; k < NumberOfPieces; ++k)
+    {
+    pieces[k]->Delete();
+    }
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
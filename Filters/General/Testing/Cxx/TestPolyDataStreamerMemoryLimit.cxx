@@ -0,0 +1,75 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataStreamerMemoryLimit.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkPolyDataStreamer chooses enough stream divisions to keep
+// each piece within its memory limit, and produces the same cells as
+// when not streaming.
+
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataStreamer.h"
+#include "vtkSphereSource.h"
+
+int TestPolyDataStreamerMemoryLimit(int, char *[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(512);
+  sphere->SetPhiResolution(512);
+  sphere->Update();
+  vtkIdType numCells = sphere->GetOutput()->GetNumberOfCells();
+  unsigned long size = sphere->GetOutput()->GetActualMemorySize();
+
+  vtkNew<vtkPolyDataStreamer> streamer;
+  streamer->SetInputConnection(sphere->GetOutputPort());
+  streamer->SetNumberOfStreamDivisions(2);
+  streamer->SetMemoryLimit(size / 8);
+  streamer->Update();
+
+  int divisions = streamer->GetNumberOfStreamDivisions();
+  if (divisions < 8)
+    {
+    cerr << "Expected at least 8 stream divisions for a memory limit of "
+         << size / 8 << " KiB, got " << divisions << endl;
+    return EXIT_FAILURE;
+    }
+  if (streamer->GetOutput()->GetNumberOfCells() != numCells)
+    {
+    cerr << "Expected " << numCells << " cells, got "
+         << streamer->GetOutput()->GetNumberOfCells() << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The next update starts from the size measured by this one.
+  streamer->Modified();
+  streamer->Update();
+  if (streamer->GetNumberOfStreamDivisions() < 8 ||
+      streamer->GetOutput()->GetNumberOfCells() != numCells)
+    {
+    cerr << "Wrong output when streaming again" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Without a limit the number of divisions is used as is.
+  streamer->SetMemoryLimit(0);
+  streamer->SetNumberOfStreamDivisions(3);
+  streamer->Update();
+  if (streamer->GetNumberOfStreamDivisions() != 3 ||
+      streamer->GetOutput()->GetNumberOfCells() != numCells)
+    {
+    cerr << "Wrong output with a fixed number of divisions" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,263 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTableBasedClipDataSetParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that the parallel clipping of large unstructured grids by
+// vtkTableBasedClipDataSet gives the same cells and points as the serial
+// clipping, up to ordering, and that culling the cells outside of the box
+// in vtkBoxClipDataSet does not change its output.
+
+#include "vtkBitArray.h"
+#include "vtkBoxClipDataSet.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphere.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTableBasedClipDataSet.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+const int N = 30;
+
+vtkIdType PointId(int i, int j, int k)
+{
+  return i + (N + 1) * (j + (N + 1) * k);
+}
+
+// A grid of N^3 hexahedra with a point and a cell array.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid()
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataType(VTK_DOUBLE);
+  vtkNew<vtkDoubleArray> distance;
+  distance->SetName("Distance");
+  for (int k = 0; k <= N; ++k)
+    {
+    for (int j = 0; j <= N; ++j)
+      {
+      for (int i = 0; i <= N; ++i)
+        {
+        points->InsertNextPoint(i, j, k);
+        distance->InsertNextValue(i + 0.5 * j + 0.25 * k);
+        }
+      }
+    }
+
+  vtkSmartPointer<vtkUnstructuredGrid> grid =
+    vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points.GetPointer());
+  grid->GetPointData()->AddArray(distance.GetPointer());
+  grid->Allocate(N * N * N);
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (int k = 0; k < N; ++k)
+    {
+    for (int j = 0; j < N; ++j)
+      {
+      for (int i = 0; i < N; ++i)
+        {
+        vtkIdType ids[8] = {
+          PointId(i, j, k), PointId(i + 1, j, k),
+          PointId(i + 1, j + 1, k), PointId(i, j + 1, k),
+          PointId(i, j, k + 1), PointId(i + 1, j, k + 1),
+          PointId(i + 1, j + 1, k + 1), PointId(i, j + 1, k + 1) };
+        cellIds->InsertNextValue(grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids));
+        }
+      }
+    }
+  grid->GetCellData()->AddArray(cellIds.GetPointer());
+  return grid;
+}
+
+// The points with their interpolated distance, sorted.
+std::vector<double> SortedPoints(vtkUnstructuredGrid *grid)
+{
+  vtkDataArray *distance = grid->GetPointData()->GetArray("Distance");
+  std::vector<double> values;
+  std::vector<std::vector<double> > points(grid->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    grid->GetPoint(i, x);
+    points[i].assign(x, x + 3);
+    points[i].push_back(distance ? distance->GetTuple1(i) : 0.0);
+    }
+  std::sort(points.begin(), points.end());
+  for (size_t i = 0; i < points.size(); ++i)
+    {
+    values.insert(values.end(), points[i].begin(), points[i].end());
+    }
+  return values;
+}
+
+// The cells as sorted lists of point coordinates with their cell type and
+// source cell, sorted.
+std::vector<std::vector<double> > SortedCells(vtkUnstructuredGrid *grid)
+{
+  vtkDataArray *cellIds = grid->GetCellData()->GetArray("CellIds");
+  std::vector<std::vector<double> > cells(grid->GetNumberOfCells());
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType c = 0; c < grid->GetNumberOfCells(); ++c)
+    {
+    grid->GetCellPoints(c, ptIds.GetPointer());
+    std::vector<std::vector<double> > points(ptIds->GetNumberOfIds());
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+      double x[3];
+      grid->GetPoint(ptIds->GetId(i), x);
+      points[i].assign(x, x + 3);
+      }
+    std::sort(points.begin(), points.end());
+    cells[c].push_back(grid->GetCellType(c));
+    cells[c].push_back(cellIds ? cellIds->GetTuple1(c) : -1.0);
+    for (size_t i = 0; i < points.size(); ++i)
+      {
+      cells[c].insert(cells[c].end(), points[i].begin(), points[i].end());
+      }
+    }
+  std::sort(cells.begin(), cells.end());
+  return cells;
+}
+
+bool SameOutput(vtkUnstructuredGrid *a, vtkUnstructuredGrid *b,
+                const char *what)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfCells() != b->GetNumberOfCells())
+    {
+    cerr << what << ": " << a->GetNumberOfPoints() << " points and "
+         << a->GetNumberOfCells() << " cells instead of "
+         << b->GetNumberOfPoints() << " points and "
+         << b->GetNumberOfCells() << " cells" << endl;
+    return false;
+    }
+  if (a->GetNumberOfCells() == 0)
+    {
+    cerr << what << ": empty output" << endl;
+    return false;
+    }
+  if (SortedPoints(a) != SortedPoints(b))
+    {
+    cerr << what << ": different points" << endl;
+    return false;
+    }
+  if (SortedCells(a) != SortedCells(b))
+    {
+    cerr << what << ": different cells" << endl;
+    return false;
+    }
+  return true;
+}
+
+bool TestTableBasedClip(vtkUnstructuredGrid *grid, vtkUnstructuredGrid *serial,
+                        bool insideOut)
+{
+  // Clip with scalars.
+  vtkNew<vtkTableBasedClipDataSet> clipper;
+  clipper->SetInputData(grid);
+  clipper->SetInputArrayToProcess(0, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_POINTS, "Distance");
+  clipper->SetValue(20.3);
+  clipper->SetInsideOut(insideOut);
+  clipper->Update();
+
+  vtkNew<vtkTableBasedClipDataSet> serialClipper;
+  serialClipper->SetInputData(serial);
+  serialClipper->SetInputArrayToProcess(0, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_POINTS, "Distance");
+  serialClipper->SetValue(20.3);
+  serialClipper->SetInsideOut(insideOut);
+  serialClipper->Update();
+
+  if (!SameOutput(clipper->GetOutput(), serialClipper->GetOutput(),
+                  "Clip by scalars"))
+    {
+    return false;
+    }
+
+  // Clip with an implicit function, which yields centroid points in the
+  // cut hexahedra.
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(N / 2.0, N / 2.0, N / 2.0);
+  sphere->SetRadius(N / 3.0);
+  clipper->SetClipFunction(sphere.GetPointer());
+  serialClipper->SetClipFunction(sphere.GetPointer());
+  clipper->Update();
+  serialClipper->Update();
+  return SameOutput(clipper->GetOutput(), serialClipper->GetOutput(),
+                    "Clip by function");
+}
+
+}
+
+int TestTableBasedClipDataSetParallel(int, char *[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid();
+
+  // A bit array cannot be written from several threads, which keeps the
+  // clipping of this copy serial.
+  vtkNew<vtkUnstructuredGrid> serial;
+  serial->DeepCopy(grid);
+  vtkNew<vtkBitArray> bits;
+  bits->SetName("Bits");
+  bits->SetNumberOfTuples(grid->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+    {
+    bits->SetValue(i, i % 2);
+    }
+  serial->GetPointData()->AddArray(bits.GetPointer());
+
+  if (!TestTableBasedClip(grid, serial.GetPointer(), false) ||
+      !TestTableBasedClip(grid, serial.GetPointer(), true))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The same hexahedra in a structured grid are clipped by box without
+  // culling.
+  vtkNew<vtkStructuredGrid> structured;
+  structured->SetDimensions(N + 1, N + 1, N + 1);
+  structured->SetPoints(grid->GetPoints());
+  structured->GetPointData()->ShallowCopy(grid->GetPointData());
+  structured->GetCellData()->ShallowCopy(grid->GetCellData());
+
+  vtkNew<vtkBoxClipDataSet> boxClip;
+  boxClip->SetInputData(grid);
+  boxClip->SetOrientation(0);
+  boxClip->SetBoxClip(3.5, 9.25, 2.0, 30.0, -1.0, 12.5);
+  boxClip->Update();
+  vtkNew<vtkBoxClipDataSet> structuredBoxClip;
+  structuredBoxClip->SetInputData(structured.GetPointer());
+  structuredBoxClip->SetOrientation(0);
+  structuredBoxClip->SetBoxClip(3.5, 9.25, 2.0, 30.0, -1.0, 12.5);
+  structuredBoxClip->Update();
+  if (!SameOutput(boxClip->GetOutput(), structuredBoxClip->GetOutput(),
+                  "Box clip"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
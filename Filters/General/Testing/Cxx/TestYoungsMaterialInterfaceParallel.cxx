@@ -0,0 +1,234 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestYoungsMaterialInterfaceParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkYoungsMaterialInterface produces the same interfaces with
+// ReconstructInParallel on as with it off, on 2D and 3D blocks of three
+// materials, with and without FillMaterial.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkYoungsMaterialInterface.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+double Clamp(double x)
+{
+  return std::max(0.0, std::min(1.0, x));
+}
+
+// A block of n^dim cells split between a sphere, a slab along x and the
+// rest, with the normals of the interfaces and some point and cell data.
+void MakeBlock(vtkImageData *block, int n, int dim)
+{
+  block->SetExtent(0, n, 0, n, 0, dim == 3 ? n : 0);
+  block->SetSpacing(1.0 / n, 1.0 / n, 1.0 / n);
+
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("PointValues");
+  for (vtkIdType i = 0; i < block->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    block->GetPoint(i, x);
+    pointValues->InsertNextValue(x[0] + 2.0 * x[1] - x[2]);
+    }
+  block->GetPointData()->AddArray(pointValues.GetPointer());
+
+  const char *names[3] = { "Fraction0", "Fraction1", "Fraction2" };
+  const char *normalNames[3] = { "Normal0", "Normal1", "Normal2" };
+  vtkNew<vtkDoubleArray> fractions[3];
+  vtkNew<vtkDoubleArray> normals[3];
+  for (int m = 0; m < 3; ++m)
+    {
+    fractions[m]->SetName(names[m]);
+    normals[m]->SetName(normalNames[m]);
+    normals[m]->SetNumberOfComponents(3);
+    }
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+
+  double center[3] = { 0.45, 0.5, dim == 3 ? 0.55 : 0.0 };
+  double width = 2.0 / n;
+  for (vtkIdType c = 0; c < block->GetNumberOfCells(); ++c)
+    {
+    double pcoords[3] = { 0.5, 0.5, 0.5 }, x[3], weights[8];
+    int subId = 0;
+    block->GetCell(c)->EvaluateLocation(subId, pcoords, x, weights);
+
+    double d[3] = { x[0] - center[0], x[1] - center[1], x[2] - center[2] };
+    double f0 = Clamp(0.5 + (0.3 - vtkMath::Norm(d)) / width);
+    double f1 = (1.0 - f0) * Clamp(0.5 + (x[0] - 0.6) / width);
+    fractions[0]->InsertNextValue(f0);
+    fractions[1]->InsertNextValue(f1);
+    fractions[2]->InsertNextValue(1.0 - f0 - f1);
+    normals[0]->InsertNextTuple3(-d[0], -d[1], -d[2]);
+    normals[1]->InsertNextTuple3(1.0, 0.0, 0.0);
+    normals[2]->InsertNextTuple3(0.0, 0.0, 0.0);
+    cellIds->InsertNextValue(static_cast<int>(c));
+    }
+  for (int m = 0; m < 3; ++m)
+    {
+    block->GetCellData()->AddArray(fractions[m].GetPointer());
+    block->GetCellData()->AddArray(normals[m].GetPointer());
+    }
+  block->GetCellData()->AddArray(cellIds.GetPointer());
+}
+
+bool SameArrays(vtkDataArray *expected, vtkDataArray *output)
+{
+  if (!expected || !output ||
+      expected->GetNumberOfTuples() != output->GetNumberOfTuples() ||
+      expected->GetNumberOfComponents() != output->GetNumberOfComponents())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+    {
+    for (int j = 0; j < expected->GetNumberOfComponents(); ++j)
+      {
+      if (expected->GetComponent(i, j) != output->GetComponent(i, j))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool SameGrids(vtkUnstructuredGrid *expected, vtkUnstructuredGrid *output)
+{
+  if (!expected || !output)
+    {
+    return expected == output;
+    }
+  if (expected->GetNumberOfCells() != output->GetNumberOfCells() ||
+      !SameArrays(expected->GetPoints()->GetData(),
+                  output->GetPoints()->GetData()) ||
+      !SameArrays(expected->GetCells()->GetData(),
+                  output->GetCells()->GetData()) ||
+      !SameArrays(expected->GetCellTypesArray(),
+                  output->GetCellTypesArray()) ||
+      !SameArrays(expected->GetPointData()->GetArray("PointValues"),
+                  output->GetPointData()->GetArray("PointValues")) ||
+      !SameArrays(expected->GetCellData()->GetArray("CellIds"),
+                  output->GetCellData()->GetArray("CellIds")))
+    {
+    return false;
+    }
+  return true;
+}
+
+bool Check(vtkYoungsMaterialInterface *youngs, const char *what)
+{
+  youngs->ReconstructInParallelOff();
+  youngs->Update();
+  vtkNew<vtkMultiBlockDataSet> expected;
+  expected->DeepCopy(youngs->GetOutput());
+
+  youngs->ReconstructInParallelOn();
+  youngs->Update();
+  vtkMultiBlockDataSet *output = youngs->GetOutput();
+
+  vtkIdType numCells = 0;
+  for (unsigned int m = 0; m < expected->GetNumberOfBlocks(); ++m)
+    {
+    vtkMultiBlockDataSet *expectedMat =
+      vtkMultiBlockDataSet::SafeDownCast(expected->GetBlock(m));
+    vtkMultiBlockDataSet *outputMat =
+      vtkMultiBlockDataSet::SafeDownCast(output->GetBlock(m));
+    if (!expectedMat || !outputMat ||
+        expectedMat->GetNumberOfBlocks() != outputMat->GetNumberOfBlocks())
+      {
+      cerr << what << ": different blocks for material " << m << endl;
+      return false;
+      }
+    for (unsigned int d = 0; d < expectedMat->GetNumberOfBlocks(); ++d)
+      {
+      vtkUnstructuredGrid *expectedGrid =
+        vtkUnstructuredGrid::SafeDownCast(expectedMat->GetBlock(d));
+      if (!SameGrids(expectedGrid,
+                     vtkUnstructuredGrid::SafeDownCast(outputMat->GetBlock(d))))
+        {
+        cerr << what << ": different output for material " << m
+             << " in domain " << d << endl;
+        return false;
+        }
+      numCells += expectedGrid ? expectedGrid->GetNumberOfCells() : 0;
+      }
+    }
+  if (numCells == 0)
+    {
+    cerr << what << ": no interface" << endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+int TestYoungsMaterialInterfaceParallel(int, char *[])
+{
+  vtkNew<vtkImageData> block2D;
+  MakeBlock(block2D.GetPointer(), 80, 2);
+  vtkNew<vtkImageData> block3D;
+  MakeBlock(block3D.GetPointer(), 24, 3);
+
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetNumberOfBlocks(2);
+  input->SetBlock(0, block2D.GetPointer());
+  input->SetBlock(1, block3D.GetPointer());
+
+  vtkNew<vtkYoungsMaterialInterface> youngs;
+  youngs->SetInputData(input.GetPointer());
+  youngs->SetNumberOfMaterials(3);
+  for (int m = 0; m < 3; ++m)
+    {
+    char volume[] = "Fraction0";
+    char normal[] = "Normal0";
+    volume[8] = normal[6] = static_cast<char>('0' + m);
+    youngs->SetMaterialVolumeFractionArray(m, volume);
+    youngs->SetMaterialNormalArray(m, normal);
+    }
+  youngs->SetVolumeFractionRange(0.001, 0.999);
+
+  if (!Check(youngs.GetPointer(), "interfaces"))
+    {
+    return EXIT_FAILURE;
+    }
+  youngs->FillMaterialOn();
+  if (!Check(youngs.GetPointer(), "filled materials"))
+    {
+    return EXIT_FAILURE;
+    }
+  youngs->OnionPeelOn();
+  if (!Check(youngs.GetPointer(), "onion peel"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -35,6 +35,7 @@ vtkBooleanOperationPolyDataFilter::vtkBooleanOperationPolyDataFilter() :
   this->Tolerance = 1e-6;
   this->Operation = VTK_UNION;
   this->ReorientDifferenceCells = 1;
+  this->IntersectInParallel = 0;
 
   this->SetNumberOfInputPorts(2);
   this->SetNumberOfOutputPorts(2);
@@ -110,6 +111,7 @@ int vtkBooleanOperationPolyDataFilter::RequestData(vtkInformation*        vtkNot
     (1, this->GetInputConnection(1, 0));
   PolyDataIntersection->SplitFirstOutputOn();
   PolyDataIntersection->SplitSecondOutputOn();
+  PolyDataIntersection->SetIntersectInParallel(this->IntersectInParallel);
   PolyDataIntersection->Update();
 
   outputIntersection->CopyStructure(PolyDataIntersection->GetOutput());
@@ -252,6 +254,7 @@ void vtkBooleanOperationPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
     }
   os << "\n";
   os << indent << "ReorientDifferenceCells: " << this->ReorientDifferenceCells << "\n";
+  os << indent << "IntersectInParallel: " << this->IntersectInParallel << "\n";
 }
 
 //-----------------------------------------------------------------------------
@@ -82,6 +82,14 @@ public:
   vtkSetMacro(Tolerance, double);
   vtkGetMacro(Tolerance, double);
 
+  // Description:
+  // Compute the intersection of the inputs in parallel, see
+  // vtkIntersectionPolyDataFilter::SetIntersectInParallel(). Defaults to
+  // off.
+  vtkSetMacro(IntersectInParallel, int);
+  vtkGetMacro(IntersectInParallel, int);
+  vtkBooleanMacro(IntersectInParallel, int);
+
 protected:
   vtkBooleanOperationPolyDataFilter();
   ~vtkBooleanOperationPolyDataFilter();
@@ -121,6 +129,10 @@ private:
   // Determines if cells from the intersection surface should be
   // reversed in the difference surface.
   int ReorientDifferenceCells;
+
+  // Description:
+  // Whether the intersection is computed in parallel.
+  int IntersectInParallel;
 };
 
 #endif
@@ -30,6 +30,8 @@
 #include "vtkMergePoints.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkIdList.h"
@@ -160,6 +162,62 @@ vtkUnstructuredGrid *vtkBoxClipDataSet::GetClippedOutput()
     this->GetExecutive()->GetOutputData(1));
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Flags the cells whose points all lie strictly outside the same face of an
+// axis aligned box. ClipBox() and its 2D, 1D and 0D variants output nothing
+// for these cells, so the serial loop can skip them.
+class vtkBoxClipCullCells
+{
+public:
+  vtkUnstructuredGrid *Input;
+  const double (*Bounds)[2];
+  unsigned char *Culled;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+
+  void Initialize()
+    {
+    }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+    {
+    vtkIdList *ptIds = this->PointIds.Local();
+    for ( ; cellId < endCellId; cellId++)
+      {
+      vtkIdType npts;
+      const vtkIdType *pts;
+      this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+
+      int outside[6] = {1, 1, 1, 1, 1, 1};
+      for (vtkIdType i = 0; i < npts; i++)
+        {
+        double x[3];
+        this->Input->GetPoint(pts[i], x);
+        for (int j = 0; j < 3; j++)
+          {
+          if (x[j] >= this->Bounds[j][0])
+            {
+            outside[2*j] = 0;
+            }
+          if (x[j] <= this->Bounds[j][1])
+            {
+            outside[2*j+1] = 0;
+            }
+          }
+        }
+      this->Culled[cellId] = npts > 0 &&
+        (outside[0] || outside[1] || outside[2] ||
+         outside[3] || outside[4] || outside[5]);
+      }
+    }
+
+  void Reduce()
+    {
+    }
+};
+}
+
 //----------------------------------------------------------------------------
 //
 // Clip by box
@@ -296,6 +354,23 @@ int vtkBoxClipDataSet::RequestData(vtkInformation *vtkNotUsed(request),
 
   unsigned int orientation = this->GetOrientation();   //Test if there is a transformation
 
+  // With an axis aligned box, find the cells outside of the box in parallel
+  // beforehand. The cells that are clipped go through the locator and stay
+  // serial.
+  std::vector<unsigned char> culled;
+  vtkUnstructuredGrid *inputUG = vtkUnstructuredGrid::SafeDownCast(input);
+  if (!orientation && !this->GenerateClippedOutput && numCells > 0 &&
+      inputUG && inputUG->GetPoints() &&
+      inputUG->GetPoints()->GetData()->HasStandardMemoryLayout())
+    {
+    culled.resize(numCells);
+    vtkBoxClipCullCells cull;
+    cull.Input = inputUG;
+    cull.Bounds = this->BoundBoxClip;
+    cull.Culled = &culled[0];
+    vtkSMPTools::For(0, numCells, cull);
+    }
+
   //clock_t init_tmp = clock();
   for (cellId=0; cellId < numCells && !abort; cellId++)
     {
@@ -305,6 +380,11 @@ int vtkBoxClipDataSet::RequestData(vtkInformation *vtkNotUsed(request),
       abort = this->GetAbortExecute();
       }
 
+    if (!culled.empty() && culled[cellId])
+      {
+      continue;
+      }
+
     input->GetCell(cellId,cell);
     cellPts = cell->GetPoints();
     npts = cellPts->GetNumberOfPoints();
@@ -29,6 +29,12 @@
 #include "vtkPolyData.h"
 #include "vtkBoundingBox.h"
 #include "vtkPointData.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 
 vtkStandardNewMacro(vtkCellTreeLocator);
 
@@ -36,7 +42,10 @@ namespace
 {
   const double EPSILON_= 1E-8;
   enum { POS_X, NEG_X, POS_Y, NEG_Y, POS_Z, NEG_Z };
-  #define CELLTREE_MAX_DEPTH 32
+  // Nodes with fewer cells are split without threads.
+  const vtkIdType CELLTREE_PARALLEL_SIZE = 65536;
+  // The number of subtrees that are grown in parallel.
+  const size_t CELLTREE_PARALLEL_SUBTREES = 64;
 }
 
 // -------------------------------------------------------------------------
@@ -117,8 +126,7 @@ class vtkCellPointTraversal
 {
   private:
     const vtkCellTreeLocator::vtkCellTree& m_ct;
-    unsigned int    m_stack[CELLTREE_MAX_DEPTH];
-    unsigned int*   m_sp; // stack pointer
+    std::vector<unsigned int>& m_stack; // caller supplied, so that queries can run concurrently
     const float*    m_pos; //3-D coordinates of the points
     vtkCellPointTraversal(const vtkCellPointTraversal&); // Not implemented
     void operator=(vtkCellPointTraversal&); // Not implemented
@@ -129,23 +137,25 @@ class vtkCellPointTraversal
     friend class vtkCellTreeBuilder;
 
   public:
-    vtkCellPointTraversal( const vtkCellTreeLocator::vtkCellTree& ct, const float* pos ) :
-        m_ct(ct), m_pos(pos)
+    vtkCellPointTraversal( const vtkCellTreeLocator::vtkCellTree& ct, const float* pos,
+                           std::vector<unsigned int>& stack ) :
+        m_ct(ct), m_stack(stack), m_pos(pos)
           {
-          this->m_stack[0] = 0; // first element is set to zero
-          this->m_sp = this->m_stack + 1; //this points to the second element of the stack
+          this->m_stack.clear();
+          this->m_stack.push_back(0); // start at the root
           }
 
         const vtkCellTreeLocator::vtkCellTreeNode* Next()  // this returns n (the location in the CellTree) if it is a leaf or 0 if the point doesn't contain in the data domain
           {
           while( true )
             {
-            if( this->m_sp == this->m_stack ) //This means the point is not within the domain
+            if( this->m_stack.empty() ) //This means the point is not within the domain
               {
               return 0;
               }
 
-            const vtkCellTreeLocator::vtkCellTreeNode* n = &this->m_ct.Nodes.front() + *(--this->m_sp);
+            const vtkCellTreeLocator::vtkCellTreeNode* n = &this->m_ct.Nodes.front() + this->m_stack.back();
+            this->m_stack.pop_back();
 
             if( n->IsLeaf() )
               {
@@ -162,22 +172,22 @@ class vtkCellPointTraversal
               {
               if( n->GetLeftMaxValue()-p < p-n->GetRightMinValue() )
                 {
-                *(this->m_sp++) = left;
-                *(this->m_sp++) = left+1;
+                this->m_stack.push_back(left);
+                this->m_stack.push_back(left+1);
                 }
               else
                 {
-                *(this->m_sp++) = left+1;
-                *(this->m_sp++) = left;
+                this->m_stack.push_back(left+1);
+                this->m_stack.push_back(left);
                 }
               }
             else if( l )
               {
-              *(this->m_sp++) = left;
+              this->m_stack.push_back(left);
               }
             else if( r )
               {
-              *(this->m_sp++) = left+1;
+              this->m_stack.push_back(left+1);
               }
             }
           }
@@ -250,9 +260,67 @@ class vtkCellTreeBuilder
       };
 
 
+    typedef vtkCellTreeLocator::vtkCellTreeNode Node;
+    static const int nbuckets = 6;
+
     // -------------------------------------------------------------------------
+    // Compute the bounds of the cells from their points, in parallel. The
+    // data set methods used are thread safe once they have been called from
+    // a single thread. Cell bounds are also stored in CellBounds if given.
 
-    void FindMinMax( const PerCell* begin, const PerCell* end,
+    class ComputeCellBounds
+      {
+      public:
+        vtkDataSet *DataSet;
+        PerCell *Cells;
+        double (*CellBounds)[6];
+        vtkSMPThreadLocalObject<vtkIdList> CellIds;
+
+        ComputeCellBounds( vtkDataSet *ds, PerCell *cells, double (*cellBounds)[6] ) :
+          DataSet(ds), Cells(cells), CellBounds(cellBounds)
+          {
+          }
+
+        void operator()( vtkIdType i, vtkIdType end )
+          {
+          vtkIdList *ids = this->CellIds.Local();
+          double bounds[6], x[3];
+          for( ; i<end; ++i )
+            {
+            this->DataSet->GetCellPoints( i, ids );
+            const vtkIdType numIds = ids->GetNumberOfIds();
+            if( numIds == 0 )
+              {
+              vtkMath::UninitializeBounds( bounds );
+              }
+            for( vtkIdType j=0; j<numIds; ++j )
+              {
+              this->DataSet->GetPoint( ids->GetId(j), x );
+              for( int d=0; d<3; ++d )
+                {
+                if( j == 0 || x[d] < bounds[2*d] )    bounds[2*d] = x[d];
+                if( j == 0 || x[d] > bounds[2*d+1] )  bounds[2*d+1] = x[d];
+                }
+              }
+
+            PerCell &pc = this->Cells[i];
+            pc.Ind = i;
+            for( int d=0; d<3; ++d )
+              {
+              pc.Min[d] = bounds[2*d+0];
+              pc.Max[d] = bounds[2*d+1];
+              }
+            if( this->CellBounds )
+              {
+              std::copy( bounds, bounds+6, this->CellBounds[i] );
+              }
+            }
+          }
+      };
+
+    // -------------------------------------------------------------------------
+
+    static void FindMinMaxSerial( const PerCell* begin, const PerCell* end,
       float* min, float* max )
       {
       if( begin == end )
@@ -277,29 +345,73 @@ class vtkCellTreeBuilder
         }
       }
 
-    // -------------------------------------------------------------------------
-
-    void Split( unsigned int index, float min[3], float max[3] )
+    class FindMinMaxFunctor
       {
-      unsigned int start = this->m_nodes[index].Start();
-      unsigned int size  = this->m_nodes[index].Size();
+      public:
+        const PerCell *Begin;
+        vtkSMPThreadLocal<std::vector<float> > MinMax;
 
-      if( size < this->m_leafsize )
+        FindMinMaxFunctor( const PerCell *begin ) : Begin(begin)
+          {
+          }
+
+        void Initialize()
+          {
+          std::vector<float> &mm = this->MinMax.Local();
+          mm.resize(6);
+          std::fill( mm.begin(), mm.begin()+3, std::numeric_limits<float>::max() );
+          std::fill( mm.begin()+3, mm.end(), -std::numeric_limits<float>::max() );
+          }
+
+        void operator()( vtkIdType i, vtkIdType end )
+          {
+          std::vector<float> &mm = this->MinMax.Local();
+          float min[3], max[3];
+          FindMinMaxSerial( this->Begin+i, this->Begin+end, min, max );
+          for( unsigned int d=0; d<3; ++d )
+            {
+            if( min[d] < mm[d] )    mm[d] = min[d];
+            if( max[d] > mm[3+d] )  mm[3+d] = max[d];
+            }
+          }
+
+        void Reduce()
+          {
+          }
+      };
+
+    static void FindMinMax( const PerCell* begin, const PerCell* end,
+      float* min, float* max )
+      {
+      if( end - begin < CELLTREE_PARALLEL_SIZE )
         {
+        FindMinMaxSerial( begin, end, min, max );
         return;
         }
 
-      PerCell* begin = &(this->m_pc[start]);
-      PerCell* end   = &(this->m_pc[0])+start + size;
-      PerCell* mid = begin;
-
-      const int nbuckets = 6;
-
-      const float ext[3] = { max[0]-min[0], max[1]-min[1], max[2]-min[2] };
-      const float iext[3] = { nbuckets/ext[0], nbuckets/ext[1], nbuckets/ext[2] };
+      FindMinMaxFunctor functor( begin );
+      vtkSMPTools::For( 0, end - begin, functor );
+      typedef vtkSMPThreadLocal<std::vector<float> >::iterator MinMaxIterator;
+      MinMaxIterator it = functor.MinMax.begin();
+      std::copy( it->begin(), it->begin()+3, min );
+      std::copy( it->begin()+3, it->end(), max );
+      for( ++it; it != functor.MinMax.end(); ++it )
+        {
+        for( unsigned int d=0; d<3; ++d )
+          {
+          if( (*it)[d] < min[d] )    min[d] = (*it)[d];
+          if( (*it)[3+d] > max[d] )  max[d] = (*it)[3+d];
+          }
+        }
+      }
 
-      Bucket b[3][nbuckets];
+    // -------------------------------------------------------------------------
+    // Add the cells to the buckets of each dimension. The buckets only hold
+    // counts and bounds, so they can be filled by several threads and merged.
 
+    static void FillBuckets( const PerCell* begin, const PerCell* end,
+      const float min[3], const float iext[3], Bucket b[3][nbuckets] )
+      {
       for( const PerCell* pc=begin; pc!=end; ++pc )
         {
         for( unsigned int d=0; d<3; ++d )
@@ -320,6 +432,88 @@ class vtkCellTreeBuilder
           b[d][ind].Add( pc->Min[d], pc->Max[d] );
           }
         }
+      }
+
+    class FillBucketsFunctor
+      {
+      public:
+        const PerCell *Begin;
+        const float *Min;
+        const float *IExt;
+        vtkSMPThreadLocal<std::vector<Bucket> > Buckets;
+
+        FillBucketsFunctor( const PerCell *begin, const float *min, const float *iext ) :
+          Begin(begin), Min(min), IExt(iext)
+          {
+          }
+
+        void Initialize()
+          {
+          this->Buckets.Local().assign( 3*nbuckets, Bucket() );
+          }
+
+        void operator()( vtkIdType i, vtkIdType end )
+          {
+          Bucket (*b)[nbuckets] =
+            reinterpret_cast<Bucket (*)[nbuckets]>( &this->Buckets.Local()[0] );
+          FillBuckets( this->Begin+i, this->Begin+end, this->Min, this->IExt, b );
+          }
+
+        void Reduce()
+          {
+          }
+      };
+
+    // -------------------------------------------------------------------------
+    // Split a node in two children, appended to nodes, and return the bounds
+    // of the children. Return false if the node is small enough to be a
+    // leaf. Only the cells of the node are reordered, so the nodes of
+    // disjoint subtrees can be split concurrently.
+
+    bool SplitNode( std::vector<Node>& nodes, unsigned int index,
+      const float min[3], const float max[3],
+      float lmin[3], float lmax[3], float rmin[3], float rmax[3] )
+      {
+      unsigned int start = nodes[index].Start();
+      unsigned int size  = nodes[index].Size();
+
+      if( size < this->m_leafsize )
+        {
+        return false;
+        }
+
+      PerCell* begin = &(this->m_pc[start]);
+      PerCell* end   = &(this->m_pc[0])+start + size;
+      PerCell* mid = begin;
+
+      const float ext[3] = { max[0]-min[0], max[1]-min[1], max[2]-min[2] };
+      const float iext[3] = { nbuckets/ext[0], nbuckets/ext[1], nbuckets/ext[2] };
+
+      Bucket b[3][nbuckets];
+
+      if( size < CELLTREE_PARALLEL_SIZE )
+        {
+        FillBuckets( begin, end, min, iext, b );
+        }
+      else
+        {
+        FillBucketsFunctor functor( begin, min, iext );
+        vtkSMPTools::For( 0, size, functor );
+        typedef vtkSMPThreadLocal<std::vector<Bucket> >::iterator BucketsIterator;
+        for( BucketsIterator it = functor.Buckets.begin(); it != functor.Buckets.end(); ++it )
+          {
+          for( unsigned int d=0; d<3; ++d )
+            {
+            for( int n=0; n<nbuckets; ++n )
+              {
+              const Bucket& lb = (*it)[d*nbuckets+n];
+              b[d][n].Cnt += lb.Cnt;
+              if( lb.Min < b[d][n].Min )    b[d][n].Min = lb.Min;
+              if( lb.Max > b[d][n].Max )    b[d][n].Max = lb.Max;
+              }
+            }
+          }
+        }
 
       float cost = std::numeric_limits<float>::max();
       float plane = VTK_FLOAT_MIN; // bad value in case it doesn't get setx
@@ -388,86 +582,152 @@ class vtkCellTreeBuilder
         std::nth_element( begin, mid, end, CenterOrder( dim ) );
         }
 
-      float lmin[3], lmax[3], rmin[3], rmax[3];
-
       FindMinMax( begin, mid, lmin, lmax );
       FindMinMax( mid,   end, rmin, rmax );
 
       float clip[2] = { lmax[dim], rmin[dim]};
 
-      vtkCellTreeLocator::vtkCellTreeNode child[2];
+      Node child[2];
       child[0].MakeLeaf( begin - &(this->m_pc[0]), mid-begin );
       child[1].MakeLeaf( mid   - &(this->m_pc[0]), end-mid );
 
-      this->m_nodes[index].MakeNode( (int)m_nodes.size(), dim, clip );
-      this->m_nodes.insert( m_nodes.end(), child, child+2 );
-
-      Split( this->m_nodes[index].GetLeftChildIndex(), lmin, lmax );
-      Split( this->m_nodes[index].GetRightChildIndex(), rmin, rmax );
+      nodes[index].MakeNode( (int)nodes.size(), dim, clip );
+      nodes.insert( nodes.end(), child, child+2 );
+      return true;
       }
 
-  public:
-
-    vtkCellTreeBuilder()
-      {
-      this->m_buckets =  5;
-      this->m_leafsize = 8;
-      }
+    // -------------------------------------------------------------------------
 
-    void Build( vtkCellTreeLocator *ctl, vtkCellTreeLocator::vtkCellTree& ct, vtkDataSet* ds )
+    void Split( std::vector<Node>& nodes, unsigned int index,
+      const float min[3], const float max[3] )
       {
-      const vtkIdType size = ds->GetNumberOfCells();
-      if( size > std::numeric_limits<vtkIdType>::max() )
+      float lmin[3], lmax[3], rmin[3], rmax[3];
+      if( !this->SplitNode( nodes, index, min, max, lmin, lmax, rmin, rmax ) )
         {
-        vtkGenericWarningMacro("Too many cells.");
+        return;
         }
-      double cellBounds[6];
-      this->m_pc.resize(size);
 
-      float min[3] =
-        {
-        std::numeric_limits<float>::max(),
-        std::numeric_limits<float>::max(),
-        std::numeric_limits<float>::max()
-        };
+      Split( nodes, nodes[index].GetLeftChildIndex(), lmin, lmax );
+      Split( nodes, nodes[index].GetRightChildIndex(), rmin, rmax );
+      }
 
-      float max[3] =
-        {
-        -std::numeric_limits<float>::max(),
-        -std::numeric_limits<float>::max(),
-        -std::numeric_limits<float>::max(),
-        };
+    // -------------------------------------------------------------------------
+    // A node that remains to be split, and its bounds.
 
-      for( vtkIdType i=0; i<size; ++i )
-        {
-        this->m_pc[i].Ind = i;
+    struct PendingNode
+      {
+      unsigned int Index;
+      float Min[3];
+      float Max[3];
+      };
 
-        double *boundsPtr = cellBounds;
-        if (ctl->CellBounds)
+    // Grow the subtrees of the pending nodes in parallel, each in its own
+    // array of nodes whose first node is the subtree root.
+    class SplitSubtrees
+      {
+      public:
+        vtkCellTreeBuilder *Builder;
+        const std::vector<PendingNode> &Pending;
+        std::vector<std::vector<Node> > &Subtrees;
+
+        SplitSubtrees( vtkCellTreeBuilder *builder, const std::vector<PendingNode> &pending,
+          std::vector<std::vector<Node> > &subtrees ) :
+          Builder(builder), Pending(pending), Subtrees(subtrees)
           {
-          boundsPtr = ctl->CellBounds[i];
           }
-        else
+
+        void operator()( vtkIdType i, vtkIdType end )
           {
-          ds->GetCellBounds(i, boundsPtr);
+          for( ; i<end; ++i )
+            {
+            const PendingNode& p = this->Pending[i];
+            std::vector<Node>& nodes = this->Subtrees[i];
+            nodes.push_back( this->Builder->m_nodes[p.Index] );
+            this->Builder->Split( nodes, 0, p.Min, p.Max );
+            }
           }
+      };
+
+    // -------------------------------------------------------------------------
+    // Split the root breadth first until there are enough subtrees to keep
+    // the threads busy, then grow the subtrees in parallel and append them
+    // to m_nodes. The splits do not depend on the order in which the nodes
+    // are split, so the tree is the same as in a serial build.
 
-        for( int d=0; d<3; ++d )
+    void SplitTree( const float min[3], const float max[3] )
+      {
+      std::vector<PendingNode> pending(1);
+      pending[0].Index = 0;
+      std::copy( min, min+3, pending[0].Min );
+      std::copy( max, max+3, pending[0].Max );
+
+      size_t first = 0;
+      while( first < pending.size() &&
+             pending.size() - first < CELLTREE_PARALLEL_SUBTREES &&
+             this->m_nodes[pending[first].Index].Size() >= CELLTREE_PARALLEL_SIZE )
+        {
+        PendingNode p = pending[first++];
+        PendingNode l, r;
+        if( this->SplitNode( this->m_nodes, p.Index, p.Min, p.Max, l.Min, l.Max, r.Min, r.Max ) )
           {
-          this->m_pc[i].Min[d] = boundsPtr[2*d+0];
-          this->m_pc[i].Max[d] = boundsPtr[2*d+1];
+          l.Index = this->m_nodes[p.Index].GetLeftChildIndex();
+          r.Index = this->m_nodes[p.Index].GetRightChildIndex();
+          pending.push_back( l );
+          pending.push_back( r );
+          }
+        }
+      pending.erase( pending.begin(), pending.begin()+first );
 
-          if( this->m_pc[i].Min[d] < min[d] )
-            {
-            min[d] = this->m_pc[i].Min[d];
-            }
+      std::vector<std::vector<Node> > subtrees( pending.size() );
+      SplitSubtrees splitter( this, pending, subtrees );
+      vtkSMPTools::For( 0, static_cast<vtkIdType>(pending.size()), 1, splitter );
 
-          if( this->m_pc[i].Max[d] > max[d] )  /// This can be m_pc[i].max[d] instead of min
+      // Local node j > 0 of a subtree is appended at base+j-1.
+      for( size_t i=0; i<pending.size(); ++i )
+        {
+        std::vector<Node>& nodes = subtrees[i];
+        const unsigned int base = static_cast<unsigned int>( this->m_nodes.size() );
+        for( size_t j=0; j<nodes.size(); ++j )
+          {
+          if( nodes[j].IsNode() )
             {
-            max[d] = this->m_pc[i].Max[d];
+            nodes[j].SetChildren( nodes[j].GetLeftChildIndex() + base - 1 );
             }
           }
+        this->m_nodes[pending[i].Index] = nodes[0];
+        this->m_nodes.insert( this->m_nodes.end(), nodes.begin()+1, nodes.end() );
+        }
+      }
+
+  public:
+
+    vtkCellTreeBuilder()
+      {
+      this->m_buckets =  5;
+      this->m_leafsize = 8;
+      }
+
+    void Build( vtkCellTreeLocator *ctl, vtkCellTreeLocator::vtkCellTree& ct, vtkDataSet* ds )
+      {
+      const vtkIdType size = ds->GetNumberOfCells();
+      if( size > std::numeric_limits<unsigned int>::max() )
+        {
+        vtkGenericWarningMacro("Too many cells.");
         }
+      this->m_pc.resize(size);
+
+      // Call the data set methods used by the threads once, so that they
+      // are thread safe.
+      vtkNew<vtkIdList> ids;
+      double x[3];
+      ds->GetCellPoints( 0, ids.GetPointer() );
+      ds->GetPoint( 0, x );
+
+      ComputeCellBounds bounds( ds, &this->m_pc[0], ctl->CellBounds );
+      vtkSMPTools::For( 0, size, bounds );
+
+      float min[3], max[3];
+      FindMinMax( &this->m_pc[0], &this->m_pc[0]+size, min, max );
 
       ct.DataBBox[0] = min[0];
       ct.DataBBox[1] = max[0];
@@ -480,7 +740,7 @@ class vtkCellTreeBuilder
       root.MakeLeaf( 0, size );
       this->m_nodes.push_back( root );
 
-      Split( 0, min, max );
+      SplitTree( min, max );
 
       ct.Nodes.resize( this->m_nodes.size() );
       ct.Nodes[0] = this->m_nodes[0];
@@ -505,7 +765,7 @@ class vtkCellTreeBuilder
 
       ct.Leaves.resize( size );
 
-      for( int i=0; i<size; ++i )
+      for( vtkIdType i=0; i<size; ++i )
         {
         ct.Leaves[i] = this->m_pc[i].Ind;
         }
@@ -522,8 +782,6 @@ class vtkCellTreeBuilder
 
 //----------------------------------------------------------------------------
 
-typedef std::stack<vtkCellTreeLocator::vtkCellTreeNode*, std::vector<vtkCellTreeLocator::vtkCellTreeNode*> > nodeStack;
-
 vtkCellTreeLocator::vtkCellTreeLocator( )
 {
   this->NumberOfCellsPerNode = 8;
@@ -586,9 +844,10 @@ void vtkCellTreeLocator::BuildLocatorInternal()
     return;
     }
   //
+  // The cell bounds are computed by the builder
   if (this->CacheCellBounds)
     {
-    this->StoreCellBounds();
+    this->CellBounds = new double[this->DataSet->GetNumberOfCells()][6];
     }
   //
   this->Tree = new vtkCellTree;
@@ -617,14 +876,25 @@ vtkIdType vtkCellTreeLocator::FindCell( double pos[3], double , vtkGenericCell *
     return -1;
     }
 
+  vtkTraversalStack stack;
+  return this->FindCell( pos, cell, pcoords, weights, &stack );
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellTreeLocator::FindCell( const double pos[3], vtkGenericCell *cell, double pcoords[3],
+                                        double* weights, vtkTraversalStack *stack ) const
+{
+  if( this->Tree == 0 )
+    {
+    return -1;
+    }
+
   double dist2;
   int subId;
 
   const float _pos[3] = { static_cast<float>(pos[0]), static_cast<float>(pos[1]),
                           static_cast<float>(pos[2]) };
-  vtkCellPointTraversal pt( *(this->Tree), _pos );
-
-  //bool found = false;
+  vtkCellPointTraversal pt( *(this->Tree), _pos, stack->Nodes );
 
   while( const vtkCellTreeNode* n = pt.Next() )
     {
@@ -634,7 +904,7 @@ vtkIdType vtkCellTreeLocator::FindCell( double pos[3], double , vtkGenericCell *
     for( ; begin!=end; ++begin )
       {
       this->DataSet->GetCell(*begin, cell);
-      if( cell->EvaluatePosition(pos, NULL, subId, pcoords, dist2, weights)==1 )
+      if( cell->EvaluatePosition(const_cast<double*>(pos), NULL, subId, pcoords, dist2, weights)==1 )
         {
         return *begin;
         }
@@ -697,6 +967,26 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3],
 int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol,
   double& t, double x[3], double pcoords[3],
   int &subId, vtkIdType &cellIds)
+{
+  this->BuildLocatorIfNeeded();
+
+  vtkTraversalStack stack;
+  return this->IntersectWithLineInternal(p1, p2, tol, t, x, pcoords, subId,
+                                         cellIds, NULL, &stack);
+}
+
+int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
+  double& t, double x[3], double pcoords[3],
+  int &subId, vtkIdType &cellId, vtkGenericCell *cell,
+  vtkTraversalStack *stack) const
+{
+  return this->IntersectWithLineInternal(p1, p2, tol, t, x, pcoords, subId,
+                                         cellId, cell, stack);
+}
+
+int vtkCellTreeLocator::IntersectWithLineInternal(const double p1[3], const double p2[3],
+  double tol, double& t, double x[3], double pcoords[3], int &subId,
+  vtkIdType &cellIds, vtkGenericCell *cell, vtkTraversalStack *stack) const
 {
   //
   vtkCellTreeNode  *node, *near, *far;
@@ -705,7 +995,10 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
 
   double cellBounds[6];
 
-  this->BuildLocatorIfNeeded();
+  if (!this->Tree)
+    {
+    return false;
+    }
 
   // Does ray pass through root BBox
   tmin = 0; tmax = 1;
@@ -715,9 +1008,15 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
     return false;
     }
   // Ok, setup a stack and various params
-  nodeStack  ns;
+  std::vector<unsigned int>& ns = stack->Nodes;
+  ns.clear();
+  vtkCellTreeNode* root = &this->Tree->Nodes.front();
   double    closest_intersection = VTK_FLOAT_MAX;
   bool     HIT = false;
+  // The id of the cell held by cell, if any
+  vtkIdType loadedId = -1;
+  double cellPcoords[3];
+  int cellSubId;
   // setup our axis optimized ray box edge stuff
   int axis = getDominantAxis(ray_vec);
   double (*_getMinDist)(const double origin[3], const double dir[3], const double B[6]);
@@ -735,12 +1034,11 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
   //
   // OK, lets walk the tree and find intersections
   //
-  vtkCellTreeNode* n = &this->Tree->Nodes.front();
-  ns.push(n);
+  ns.push_back(0);
   while (!ns.empty())
     {
-    node = ns.top();
-    ns.pop();
+    node = root + ns.back();
+    ns.pop_back();
     // We do as few tests on the way down as possible, because our BBoxes
     // can be quite tight and we want to reject as many boxes as possible without
     // testing them at all - mainly because we quickly get to a leaf node and
@@ -759,7 +1057,7 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
       // (we still need to test Mid because it may overlap slightly)
       if(mustCheck)
         {
-        ns.push(far);
+        ns.push_back(static_cast<unsigned int>(far - root));
         node = near;
         }
       else if ((tDist > tmax) || (tDist <= 0) )
@@ -769,13 +1067,13 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
       // if the distance to the far edge of the near box is < tmin, no need to test near box
       else if (tDist < tmin)
         {
-        ns.push(near);
+        ns.push_back(static_cast<unsigned int>(near - root));
         node = far;
         }
       // All the child nodes may be candidates, keep near, push far then mid
       else
         {
-        ns.push(far);
+        ns.push_back(static_cast<unsigned int>(far - root));
         node = near;
         }
       }
@@ -797,6 +1095,12 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
         {
         boundsPtr = this->CellBounds[cell_ID];
         }
+      else if (cell)
+        {
+        this->DataSet->GetCell(cell_ID, cell);
+        loadedId = cell_ID;
+        cell->GetBounds(cellBounds);
+        }
       else
         {
         this->DataSet->GetCellBounds(cell_ID, cellBounds);
@@ -809,7 +1113,24 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
       ctmin = _tmin; ctmax = _tmax;
       if (this->RayMinMaxT(boundsPtr, p1, ray_vec, ctmin, ctmax))
         {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        int hit;
+        if (cell)
+          {
+          if (loadedId != cell_ID)
+            {
+            this->DataSet->GetCell(cell_ID, cell);
+            loadedId = cell_ID;
+            }
+          hit = cell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2),
+                                        tol, t_hit, ipt, cellPcoords, cellSubId);
+          }
+        else
+          {
+          // Subclasses may override the cell test, which is not const
+          hit = const_cast<vtkCellTreeLocator*>(this)->IntersectCellInternal(
+            cell_ID, p1, p2, tol, t_hit, ipt, cellPcoords, cellSubId);
+          }
+        if (hit)
           {
           if (t_hit<closest_intersection)
             {
@@ -819,6 +1140,10 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
             x[0] = ipt[0];
             x[1] = ipt[1];
             x[2] = ipt[2];
+            pcoords[0] = cellPcoords[0];
+            pcoords[1] = cellPcoords[1];
+            pcoords[2] = cellPcoords[2];
+            subId = cellSubId;
             }
 
 
@@ -830,6 +1155,10 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
   if (HIT)
     {
     t = closest_intersection;
+    if (cell && loadedId != cellIds)
+      {
+      this->DataSet->GetCell(cellIds, cell);
+      }
     }
   //
   return HIT;
@@ -839,7 +1168,7 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
 bool vtkCellTreeLocator::RayMinMaxT(const double origin[3],
   const double dir[3],
   double &rTmin,
-  double &rTmax)
+  double &rTmax) const
 {
   double tT;
   // X-Axis
@@ -999,7 +1328,7 @@ bool vtkCellTreeLocator::RayMinMaxT(const double bounds[6],
   const double origin[3],
   const double dir[3],
   double &rTmin,
-  double &rTmax)
+  double &rTmax) const
 {
   double tT;
   // X-Axis
@@ -1143,7 +1472,7 @@ bool vtkCellTreeLocator::RayMinMaxT(const double bounds[6],
   return (true);
 }
 //----------------------------------------------------------------------------
-int vtkCellTreeLocator::getDominantAxis(const double dir[3])
+int vtkCellTreeLocator::getDominantAxis(const double dir[3]) const
 {
   double tX = (dir[0]>0) ? dir[0] : -dir[0];
   double tY = (dir[1]>0) ? dir[1] : -dir[1];
@@ -1166,7 +1495,7 @@ void vtkCellTreeLocator::Classify(const double origin[3],
   const double dir[3],
   double &rDist,
   vtkCellTreeNode *&near, vtkCellTreeNode *&parent,
-  vtkCellTreeNode *&far, int& mustCheck)
+  vtkCellTreeNode *&far, int& mustCheck) const
 {
   double tOriginToDivPlane = parent->GetLeftMaxValue() - origin[parent->GetDimension()];
   double tOriginToDivPlane2 = parent->GetRightMinValue() - origin[parent->GetDimension()];
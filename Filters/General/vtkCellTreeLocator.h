@@ -27,7 +27,10 @@
 // avtCellLocatorBIH class in the VisIT Visualization Tool
 
 // .SECTION Caveats
-//
+// The tree is built in parallel with vtkSMPTools. Once BuildLocator() has
+// been called, the FindCell() and IntersectWithLine() signatures that take
+// a vtkTraversalStack may be called concurrently, as long as each thread
+// provides its own vtkGenericCell, weights and vtkTraversalStack.
 
 // .SECTION See Also
 // vtkLocator vtkCellLocator vtkModifiedBSPTree
@@ -49,6 +52,7 @@ class VTKFILTERSGENERAL_EXPORT vtkCellTreeLocator : public vtkAbstractCellLocato
   public:
     class vtkCellTree;
     class vtkCellTreeNode;
+    class vtkTraversalStack;
 
     vtkTypeMacro(vtkCellTreeLocator,vtkAbstractCellLocator);
     void PrintSelf(ostream& os, vtkIndent indent);
@@ -72,6 +76,21 @@ class VTKFILTERSGENERAL_EXPORT vtkCellTreeLocator : public vtkAbstractCellLocato
                                       int &subId, vtkIdType &cellId,
                                       vtkGenericCell *cell);
 
+    // Description:
+    // Thread safe versions of FindCell() and IntersectWithLine(). They use
+    // the caller supplied cell and traversal stack instead of the state of
+    // the locator, and do not build the locator: BuildLocator() must have
+    // been called first, even if LazyEvaluation is on. The cell holds the
+    // found cell on return.
+    vtkIdType FindCell(const double pos[3], vtkGenericCell *cell,
+                       double pcoords[3], double* weights,
+                       vtkTraversalStack *stack) const;
+    int IntersectWithLine(const double p1[3], const double p2[3], double tol,
+                          double& t, double x[3], double pcoords[3],
+                          int &subId, vtkIdType &cellId,
+                          vtkGenericCell *cell,
+                          vtkTraversalStack *stack) const;
+
     // Description:
     // Return a list of unique cell ids inside of a given bounding box. The
     // user must provide the vtkIdList to populate. This method returns data
@@ -185,6 +204,16 @@ class VTKFILTERSGENERAL_EXPORT vtkCellTreeLocator : public vtkAbstractCellLocato
         unsigned int Start() const;
         unsigned int Size() const;
     };
+
+    // Description:
+    // The indices of the nodes that remain to be visited by a query. Each
+    // thread querying the locator concurrently needs its own stack, which
+    // can be reused from one query to the next.
+    class VTKFILTERSGENERAL_EXPORT vtkTraversalStack
+    {
+      public:
+        std::vector<unsigned int> Nodes;
+    };
 //ETX
 
 protected:
@@ -195,22 +224,22 @@ protected:
   bool RayMinMaxT(const double origin[3],
     const double dir[3],
     double &rTmin,
-    double &rTmax);
+    double &rTmax) const;
 
   bool RayMinMaxT(const double bounds[6],
     const double origin[3],
     const double dir[3],
     double &rTmin,
-    double &rTmax);
+    double &rTmax) const;
 
-  int getDominantAxis(const double dir[3]);
+  int getDominantAxis(const double dir[3]) const;
 
   // Order nodes as near/far relative to ray
   void Classify(const double origin[3],
     const double dir[3],
     double &rDist,
     vtkCellTreeNode *&near, vtkCellTreeNode *&mid,
-    vtkCellTreeNode *&far, int &mustCheck);
+    vtkCellTreeNode *&far, int &mustCheck) const;
 
   // From vtkModifiedBSPTRee
   // We provide a function which does the cell/ray test so that
@@ -225,6 +254,13 @@ protected:
     double pcoords[3],
     int &subId);
 
+  // Walk the tree along the line. Without a cell, the cells are tested with
+  // IntersectCellInternal(), otherwise with the given cell, which is left
+  // holding the intersected cell.
+  int IntersectWithLineInternal(const double p1[3], const double p2[3],
+    double tol, double& t, double x[3], double pcoords[3], int &subId,
+    vtkIdType &cellId, vtkGenericCell *cell, vtkTraversalStack *stack) const;
+
 
     int NumberOfBuckets;
 
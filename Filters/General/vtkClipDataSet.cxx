@@ -321,10 +321,20 @@ int vtkClipDataSet::RequestData(
       {
       inPD->SetScalars(tmpScalars);
       }
-    for ( i=0; i < numPts; i++ )
+    vtkPointSet *inputPointSet = vtkPointSet::SafeDownCast(input);
+    if ( inputPointSet && inputPointSet->GetPoints() )
+      {
+      // evaluated in parallel when the function allows it
+      this->ClipFunction->FunctionValue(
+        inputPointSet->GetPoints()->GetData(), tmpScalars);
+      }
+    else
       {
-      s = this->ClipFunction->FunctionValue(input->GetPoint(i));
-      tmpScalars->SetTuple1(i,s);
+      for ( i=0; i < numPts; i++ )
+        {
+        s = this->ClipFunction->FunctionValue(input->GetPoint(i));
+        tmpScalars->SetTuple1(i,s);
+        }
       }
     clipScalars = tmpScalars;
     }
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkDistancePolyDataFilter.h"
 
+#include "vtkCell.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
 #include "vtkImplicitPolyDataDistance.h"
@@ -21,6 +22,7 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangle.h"
 
@@ -90,22 +92,12 @@ void vtkDistancePolyDataFilter::GetPolyDataDistance(vtkPolyData* mesh, vtkPolyDa
   vtkImplicitPolyDataDistance* imp = vtkImplicitPolyDataDistance::New();
   imp->SetInput( src );
 
-  // Calculate distance from points.
-  int numPts = mesh->GetNumberOfPoints();
-
+  // Calculate distance from points. The points are evaluated all at once,
+  // in parallel since the implicit function only reads its input.
   vtkDoubleArray* pointArray = vtkDoubleArray::New();
   pointArray->SetName( "Distance" );
-  pointArray->SetNumberOfComponents( 1 );
-  pointArray->SetNumberOfTuples( numPts );
-
-  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
-    {
-    double pt[3];
-    mesh->GetPoint( ptId, pt );
-    double val = imp->EvaluateFunction( pt );
-    double dist = SignedDistance ? (NegateDistance ? -val : val) : fabs(val);
-    pointArray->SetValue( ptId, dist );
-    }
+  imp->FunctionValue( mesh->GetPoints()->GetData(), pointArray );
+  this->ApplySign( pointArray );
 
   mesh->GetPointData()->AddArray( pointArray );
   pointArray->Delete();
@@ -114,10 +106,9 @@ void vtkDistancePolyDataFilter::GetPolyDataDistance(vtkPolyData* mesh, vtkPolyDa
   // Calculate distance from cell centers.
   int numCells = mesh->GetNumberOfCells();
 
-  vtkDoubleArray* cellArray = vtkDoubleArray::New();
-  cellArray->SetName( "Distance" );
-  cellArray->SetNumberOfComponents( 1 );
-  cellArray->SetNumberOfTuples( numCells );
+  vtkDoubleArray* centers = vtkDoubleArray::New();
+  centers->SetNumberOfComponents( 3 );
+  centers->SetNumberOfTuples( numCells );
 
   for (vtkIdType cellId = 0; cellId < numCells; cellId++)
     {
@@ -127,12 +118,15 @@ void vtkDistancePolyDataFilter::GetPolyDataDistance(vtkPolyData* mesh, vtkPolyDa
 
     cell->GetParametricCenter( pcoords );
     cell->EvaluateLocation( subId, pcoords, x, weights );
-
-    double val = imp->EvaluateFunction( x );
-    double dist = SignedDistance ? (NegateDistance ? -val : val) : fabs(val);
-    cellArray->SetValue( cellId, dist );
+    centers->SetTuple( cellId, x );
     }
 
+  vtkDoubleArray* cellArray = vtkDoubleArray::New();
+  cellArray->SetName( "Distance" );
+  imp->FunctionValue( centers, cellArray );
+  centers->Delete();
+  this->ApplySign( cellArray );
+
   mesh->GetCellData()->AddArray( cellArray );
   cellArray->Delete();
   mesh->GetCellData()->SetActiveScalars("Distance");
@@ -142,6 +136,18 @@ void vtkDistancePolyDataFilter::GetPolyDataDistance(vtkPolyData* mesh, vtkPolyDa
   vtkDebugMacro(<<"End vtkDistancePolyDataFilter::GetPolyDataDistance");
 }
 
+//-----------------------------------------------------------------------------
+void vtkDistancePolyDataFilter::ApplySign(vtkDoubleArray* distances)
+{
+  vtkIdType numValues = distances->GetNumberOfTuples();
+  for (vtkIdType i = 0; i < numValues; i++)
+    {
+    double val = distances->GetValue( i );
+    distances->SetValue( i, this->SignedDistance ?
+                         (this->NegateDistance ? -val : val) : fabs(val) );
+    }
+}
+
 //-----------------------------------------------------------------------------
 vtkPolyData* vtkDistancePolyDataFilter::GetSecondDistanceOutput()
 {
@@ -38,6 +38,8 @@
 #include "vtkFiltersGeneralModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+class vtkDoubleArray;
+
 class VTKFILTERSGENERAL_EXPORT vtkDistancePolyDataFilter : public vtkPolyDataAlgorithm
 {
 public:
@@ -80,6 +82,11 @@ protected:
   virtual int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
   void GetPolyDataDistance(vtkPolyData*, vtkPolyData*);
 
+  // Description:
+  // Turn the signed distances into the requested ones, according to
+  // SignedDistance and NegateDistance.
+  void ApplySign(vtkDoubleArray*);
+
 private:
   vtkDistancePolyDataFilter(const vtkDistancePolyDataFilter&); // Not implemented
   void operator=(const vtkDistancePolyDataFilter&); // Not implemented
@@ -338,17 +338,14 @@ int vtkExtractSelectedFrustum::RequestData(
     return 1;
     }
 
-  vtkIdType ptId, numPts, newPointId;
-  vtkIdType numCells, cellId, newCellId, numCellPts;
-  vtkIdType *pointMap;
+  vtkIdType ptId, numPts;
+  vtkIdType numCells, cellId, numCellPts;
   vtkCell *cell;
   vtkIdList *cellPts;
-  vtkIdList *newCellPts;
   int isect;
 
   vtkSignedCharArray *pointInArray = vtkSignedCharArray::New();
   vtkSignedCharArray *cellInArray = vtkSignedCharArray::New();
-  vtkPoints *newPts = vtkPoints::New();
 
   /*
   int NUMCELLS = 0;
@@ -361,80 +358,46 @@ int vtkExtractSelectedFrustum::RequestData(
   vtkDataSet *outputDS = vtkDataSet::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkPointData *pd = input->GetPointData();
-  vtkCellData *cd = input->GetCellData();
   vtkPointData *outputPD = outputDS->GetPointData();
   vtkCellData *outputCD = outputDS->GetCellData();
 
   numPts = input->GetNumberOfPoints();
   numCells = input->GetNumberOfCells();
-  pointMap = new vtkIdType[numPts]; // maps old point ids into new
-  newCellPts = vtkIdList::New();
-  newCellPts->Allocate(VTK_CELL_SIZE);
-
-  vtkIdTypeArray *originalCellIds = NULL;
-  vtkIdTypeArray *originalPointIds = NULL;
 
   signed char flag = this->InsideOut ? 1 : -1;
 
+  //the points and cells are marked in the insidedness arrays; without
+  //PreserveTopology, those marked positive are then extracted
+  signed char outside = this->PreserveTopology ? flag : -1;
+  signed char inside = -outside;
+
+  pointInArray->SetNumberOfComponents(1);
+  pointInArray->SetNumberOfTuples(numPts);
+  for (i=0; i < numPts; i++)
+    {
+    pointInArray->SetValue(i, outside);
+    }
+
+  cellInArray->SetNumberOfComponents(1);
+  cellInArray->SetNumberOfTuples(numCells);
+  for (i=0; i < numCells; i++)
+    {
+    cellInArray->SetValue(i, outside);
+    }
+
   if (this->PreserveTopology)
     {
     //the output is a copy of the input, with two new arrays defined
     outputDS->ShallowCopy(input);
 
-    pointInArray->SetNumberOfComponents(1);
-    pointInArray->SetNumberOfTuples(numPts);
-    for (i=0; i < numPts; i++)
-      {
-      pointInArray->SetValue(i, flag);
-      }
     pointInArray->SetName("vtkInsidedness");
     outputPD->AddArray(pointInArray);
     outputPD->SetScalars(pointInArray);
 
-    cellInArray->SetNumberOfComponents(1);
-    cellInArray->SetNumberOfTuples(numCells);
-    for (i=0; i < numCells; i++)
-      {
-      cellInArray->SetValue(i, flag);
-      }
     cellInArray->SetName("vtkInsidedness");
     outputCD->AddArray(cellInArray);
     outputCD->SetScalars(cellInArray);
     }
-  else
-    {
-    //the output is a new unstructured grid
-    outputUG->Allocate(numCells/4); //allocate storage for geometry/topology
-    newPts->Allocate(numPts/4,numPts);
-    outputPD->SetCopyGlobalIds(1);
-    outputPD->CopyFieldOff("vtkOriginalPointIds");
-    outputPD->CopyAllocate(pd);
-
-    if ((this->FieldType == vtkSelectionNode::CELL)
-        ||
-        this->PreserveTopology
-        ||
-        this->ContainingCells
-      )
-      {
-      outputCD->SetCopyGlobalIds(1);
-      outputCD->CopyFieldOff("vtkOriginalCellIds");
-      outputCD->CopyAllocate(cd);
-
-      originalCellIds = vtkIdTypeArray::New();
-      originalCellIds->SetNumberOfComponents(1);
-      originalCellIds->SetName("vtkOriginalCellIds");
-      outputCD->AddArray(originalCellIds);
-      originalCellIds->Delete();
-      }
-
-    originalPointIds = vtkIdTypeArray::New();
-    originalPointIds->SetNumberOfComponents(1);
-    originalPointIds->SetName("vtkOriginalPointIds");
-    outputPD->AddArray(originalPointIds);
-    originalPointIds->Delete();
-    }
 
   flag = -flag;
 
@@ -448,12 +411,6 @@ int vtkExtractSelectedFrustum::RequestData(
 
     updateInterval = numCells/1000 + 1;
 
-    //initialize all points to say not looked at
-    for (ptId=0; ptId < numPts; ptId++)
-      {
-      pointMap[ptId] = -1;
-      }
-
     /*
     timer->StopTimer();
     cerr << "  PTINIT " << timer->GetElapsedTime() << endl;
@@ -472,7 +429,6 @@ int vtkExtractSelectedFrustum::RequestData(
       cell = input->GetCell(cellId);
       cellPts = cell->GetPointIds();
       numCellPts = cell->GetNumberOfPoints();
-      newCellPts->Reset();
 
       isect = this->ABoxFrustumIsect(bounds, cell);
       if ((isect == 1 && flag == 1) || (isect == 0 && flag == -1))
@@ -484,49 +440,9 @@ int vtkExtractSelectedFrustum::RequestData(
         //intersects, put all of the points inside
         for (i=0; i < numCellPts; i++)
           {
-          ptId = cellPts->GetId(i);
-          newPointId = pointMap[ptId];
-          if (newPointId < 0)
-            {
-            /*
-            NUMPTS++;
-            */
-
-            input->GetPoint(ptId, x);
-            if (this->PreserveTopology)
-              {
-              pointInArray->SetValue(ptId, flag);
-              newPointId = ptId;
-              }
-            else
-              {
-              newPointId = newPts->InsertNextPoint(x);
-              outputPD->CopyData(pd,ptId,newPointId);
-              originalPointIds->InsertNextValue(ptId);
-              }
-            pointMap[ptId] = newPointId;
-            }
-          newCellPts->InsertId(i,newPointId);
-          }
-
-        if (this->PreserveTopology)
-          {
-          cellInArray->SetValue(cellId, flag);
-          }
-        else
-          {
-          // special handling for polyhedron cells
-          if (vtkUnstructuredGrid::SafeDownCast(input) &&
-              cell->GetCellType() == VTK_POLYHEDRON)
-            {
-            newCellPts->Reset();
-            vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(cellId, newCellPts);
-            vtkUnstructuredGrid::ConvertFaceStreamPointIds(newCellPts, pointMap);
-            }
-          newCellId = outputUG->InsertNextCell(cell->GetCellType(),newCellPts);
-          outputCD->CopyData(cd,cellId,newCellId);
-          originalCellIds->InsertNextValue(cellId);
+          pointInArray->SetValue(cellPts->GetId(i), inside);
           }
+        cellInArray->SetValue(cellId, inside);
         }
 
       /*
@@ -551,7 +467,7 @@ int vtkExtractSelectedFrustum::RequestData(
     //there could be some points that are not used by any cell
     for (ptId = 0; ptId < numPts; ptId++)
       {
-      if (pointMap[ptId] == -1) //point wasn't attached to a cell
+      if (pointInArray->GetValue(ptId) != inside) //point wasn't attached to a cell
         {
         input->GetPoint(ptId,x);
         if ((this->Frustum->EvaluateFunction(x) * flag) < 0.0)
@@ -559,16 +475,7 @@ int vtkExtractSelectedFrustum::RequestData(
           /*
           NUMPTS++;
           */
-          if (this->PreserveTopology)
-            {
-            pointInArray->SetValue(ptId, flag);
-            }
-          else
-            {
-            newPointId = newPts->InsertNextPoint(x);
-            outputPD->CopyData(pd,ptId,newPointId);
-            originalPointIds->InsertNextValue(ptId);
-            }
+          pointInArray->SetValue(ptId, inside);
           }
         }
       }
@@ -590,24 +497,12 @@ int vtkExtractSelectedFrustum::RequestData(
           }
 
       input->GetPoint(ptId,x);
-      pointMap[ptId] = -1;
       if ((this->Frustum->EvaluateFunction(x) * flag) < 0.0)
         {
         /*
         NUMPTS++;
         */
-        if (this->PreserveTopology)
-          {
-          newPointId = ptId;
-          pointInArray->SetValue(ptId,flag);
-          }
-        else
-          {
-          newPointId = newPts->InsertNextPoint(x);
-          outputPD->CopyData(pd,ptId,newPointId);
-          originalPointIds->InsertNextValue(ptId);
-          }
-        pointMap[ptId] = newPointId;
+        pointInArray->SetValue(ptId,inside);
         }
       }
 
@@ -617,104 +512,24 @@ int vtkExtractSelectedFrustum::RequestData(
     timer->StartTimer();
     */
 
-    if (this->PreserveTopology)
-      {
-      //we have already created a copy of the input and marked points as
-      //being in or not
-      if (this->ContainingCells)
-        {
-        //mark the cells that have at least one point inside as being in
-        for (cellId = 0;  cellId < numCells; cellId++)
-          {
-          cell = input->GetCell(cellId);
-          cellPts = cell->GetPointIds();
-          numCellPts = cell->GetNumberOfPoints();
-          for (i=0; i < numCellPts; i++)
-            {
-            ptId = cellPts->GetId(i);
-            newPointId = pointMap[ptId];
-            if ( newPointId >= 0 )
-              {
-              cellInArray->SetValue(cellId,flag);
-              break;
-              }
-            }
-          }
-        }
-      }
-    else
+    if (this->ContainingCells)
       {
-      if (this->ContainingCells)
+      //mark the cells that have at least one point inside as being in
+      cellPts = vtkIdList::New();
+      for (cellId = 0;  cellId < numCells; cellId++)
         {
-        vtkIdType *pointMap2 = new vtkIdType[numPts]; // maps old point ids into new
-        memcpy(pointMap2, pointMap, numPts*sizeof(vtkIdType));
-
-        //run through cells and accept those with any point inside
-        for (cellId = 0;  cellId < numCells; cellId++)
+        input->GetCellPoints(cellId, cellPts);
+        numCellPts = cellPts->GetNumberOfIds();
+        for (i=0; i < numCellPts; i++)
           {
-          cell = input->GetCell(cellId);
-          cellPts = cell->GetPointIds();
-          numCellPts = cell->GetNumberOfPoints();
-          newCellPts->Reset();
-
-          isect = 0;
-          for (i=0; i < numCellPts; i++)
-            {
-            ptId = cellPts->GetId(i);
-            newPointId = pointMap[ptId];
-            if ( newPointId >= 0 )
-              {
-              isect=1;
-              break; //this cell won't be inserted
-              }
-            }
-          if (isect)
+          if (pointInArray->GetValue(cellPts->GetId(i)) == inside)
             {
-            for (i=0; i < numCellPts; i++)
-              {
-              ptId = cellPts->GetId(i);
-              newPointId = pointMap[ptId];
-              if ( newPointId < 0 )
-                {
-                //this vertex wasn't inside
-                newPointId = pointMap2[ptId];
-                if (newPointId < 0)
-                  {
-                  //we haven't encountered it before, add it and remember
-                  input->GetPoint(ptId,x);
-                  newPointId = newPts->InsertNextPoint(x);
-                  outputPD->CopyData(pd,ptId,newPointId);
-                  originalPointIds->InsertNextValue(ptId);
-                  pointMap2[ptId] = newPointId;
-                  }
-                }
-              newCellPts->InsertId(i,newPointId);
-              }
-            // special handling for polyhedron cells
-            if (vtkUnstructuredGrid::SafeDownCast(input) &&
-                cell->GetCellType() == VTK_POLYHEDRON)
-              {
-              newCellPts->Reset();
-              vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(cellId, newCellPts);
-              vtkUnstructuredGrid::ConvertFaceStreamPointIds(newCellPts, pointMap2);
-              }
-            newCellId = outputUG->InsertNextCell(cell->GetCellType(),newCellPts);
-            outputCD->CopyData(cd,cellId,newCellId);
-            originalCellIds->InsertNextValue(cellId);
+            cellInArray->SetValue(cellId,inside);
+            break;
             }
           }
-        delete[] pointMap2;
-        }
-      else
-        {
-        //produce a new vtk_vertex cell for each accepted point
-        for (ptId = 0; ptId < newPts->GetNumberOfPoints(); ptId++)
-          {
-          newCellPts->Reset();
-          newCellPts->InsertId(0, ptId);
-          outputUG->InsertNextCell(VTK_VERTEX, newCellPts);
-          }
         }
+      cellPts->Delete();
       }
     }
 
@@ -733,17 +548,20 @@ int vtkExtractSelectedFrustum::RequestData(
   cerr << "}" << endl;
   */
 
-  // Update ourselves and release memory
-  delete [] pointMap;
-  newCellPts->Delete();
-  pointInArray->Delete();
-  cellInArray->Delete();
-
+  //without PreserveTopology, the output is a new unstructured grid; when
+  //no cells are selected, a vertex is made for each point inside
   if (!this->PreserveTopology)
     {
-    outputUG->SetPoints(newPts);
+    bool extractCells = this->FieldType == vtkSelectionNode::CELL ||
+      this->ContainingCells;
+    this->ExtractElements(input, pointInArray->GetPointer(0),
+                          extractCells ? cellInArray->GetPointer(0) : NULL,
+                          outputUG);
     }
-  newPts->Delete();
+
+  // Update ourselves and release memory
+  pointInArray->Delete();
+  cellInArray->Delete();
   outputDS->Squeeze();
 
 
@@ -14,14 +14,301 @@
 =========================================================================*/
 #include "vtkExtractSelectionBase.h"
 
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
 #include "vtkGraph.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPointSet.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+const vtkIdType BlockSize = 65536;
+
+// Sums the values of each block.
+struct vtkExtractSelectionBlockSums
+{
+  const vtkIdType *Values;
+  vtkIdType NumberOfValues;
+  vtkIdType *Sums;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+      {
+      vtkIdType last = std::min((block + 1) * BlockSize, this->NumberOfValues);
+      vtkIdType sum = 0;
+      for (vtkIdType i = block * BlockSize; i < last; ++i)
+        {
+        sum += this->Values[i];
+        }
+      this->Sums[block] = sum;
+      }
+  }
+};
+
+// Replaces the values of each block by their exclusive prefix sums, starting
+// from the offset of the block.
+struct vtkExtractSelectionBlockScans
+{
+  vtkIdType *Values;
+  vtkIdType NumberOfValues;
+  const vtkIdType *Offsets;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+      {
+      vtkIdType last = std::min((block + 1) * BlockSize, this->NumberOfValues);
+      vtkIdType sum = this->Offsets[block];
+      for (vtkIdType i = block * BlockSize; i < last; ++i)
+        {
+        vtkIdType value = this->Values[i];
+        this->Values[i] = sum;
+        sum += value;
+        }
+      }
+  }
+};
+
+// Replaces the values by their exclusive prefix sums and returns their total.
+vtkIdType vtkExtractSelectionPrefixSums(vtkIdType *values, vtkIdType n)
+{
+  vtkIdType numBlocks = (n + BlockSize - 1) / BlockSize;
+  std::vector<vtkIdType> offsets(numBlocks + 1, 0);
+  vtkExtractSelectionBlockSums sums = { values, n, &offsets[0] + 1 };
+  vtkSMPTools::For(0, numBlocks, 1, sums);
+  for (vtkIdType block = 0; block < numBlocks; ++block)
+    {
+    offsets[block + 1] += offsets[block];
+    }
+  vtkExtractSelectionBlockScans scans = { values, n, &offsets[0] };
+  vtkSMPTools::For(0, numBlocks, 1, scans);
+  return offsets[numBlocks];
+}
+
+// Initializes the map of the points or cells to 1 for the selected ones,
+// 0 for the others.
+struct vtkExtractSelectionMarkInside
+{
+  const signed char *Inside;
+  vtkIdType *Map;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Map[i] = (this->Inside && this->Inside[i] > 0) ? 1 : 0;
+      }
+  }
+};
+
+// Marks the points of the selected cells. Several threads may store 1 for
+// the same point.
+struct vtkExtractSelectionMarkCellPoints
+{
+  vtkDataSet *Input;
+  const signed char *CellInside;
+  vtkIdType *PointMap;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellPts = this->CellPoints.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      if (this->CellInside[cellId] > 0)
+        {
+        this->Input->GetCellPoints(cellId, cellPts);
+        for (vtkIdType i = 0; i < cellPts->GetNumberOfIds(); ++i)
+          {
+          this->PointMap[cellPts->GetId(i)] = 1;
+          }
+        }
+      }
+  }
+};
+
+// Records the original ids of the selected points or cells from the prefix
+// sums of their marks: element i is selected when Map[i + 1] > Map[i].
+struct vtkExtractSelectionOriginalIds
+{
+  const vtkIdType *Map;
+  vtkIdType *OriginalIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      if (this->Map[i + 1] > this->Map[i])
+        {
+        this->OriginalIds[this->Map[i]] = i;
+        }
+      }
+  }
+};
+
+// Sets the map of the unselected points or cells to -1.
+struct vtkExtractSelectionClearUnselected
+{
+  vtkIdType *Map;
+  const vtkIdType *OriginalIds;
+  vtkIdType NumberOfSelectedIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType newId = this->Map[i];
+      if (newId >= this->NumberOfSelectedIds || this->OriginalIds[newId] != i)
+        {
+        this->Map[i] = -1;
+        }
+      }
+  }
+};
+
+// Turns the marks (0 or 1) of the n elements of map, which holds n + 1
+// values, into the new ids of the selected elements and fills originalIds.
+// Returns the number of selected elements.
+vtkIdType vtkExtractSelectionBuildMap(vtkIdType *map, vtkIdType n,
+                                      vtkIdTypeArray *originalIds)
+{
+  vtkIdType numSelected = vtkExtractSelectionPrefixSums(map, n);
+  map[n] = numSelected;
+  originalIds->SetNumberOfTuples(numSelected);
+  vtkExtractSelectionOriginalIds record = { map, originalIds->GetPointer(0) };
+  vtkSMPTools::For(0, n, record);
+  vtkExtractSelectionClearUnselected clear =
+    { map, originalIds->GetPointer(0), numSelected };
+  vtkSMPTools::For(0, n, clear);
+  return numSelected;
+}
+
+// Copies the selected points.
+struct vtkExtractSelectionCopyPoints
+{
+  vtkDataSet *Input;
+  const vtkIdType *OriginalIds;
+  vtkPoints *Points;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Input->GetPoint(this->OriginalIds[i], x);
+      this->Points->SetPoint(i, x);
+      }
+  }
+};
+
+// Stores the connectivity size and the type of the selected cells.
+struct vtkExtractSelectionCellSizes
+{
+  vtkDataSet *Input;
+  const vtkIdType *OriginalIds;
+  vtkIdType *Sizes;
+  unsigned char *Types;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellPts = this->CellPoints.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Input->GetCellPoints(this->OriginalIds[i], cellPts);
+      this->Sizes[i] = cellPts->GetNumberOfIds() + 1;
+      this->Types[i] =
+        static_cast<unsigned char>(this->Input->GetCellType(this->OriginalIds[i]));
+      }
+  }
+};
+
+// Fills the connectivity of the selected cells from their locations.
+struct vtkExtractSelectionCellConnectivity
+{
+  vtkDataSet *Input;
+  const vtkIdType *OriginalIds;
+  const vtkIdType *PointMap;
+  const vtkIdType *Locations;
+  vtkIdType *Connectivity;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellPts = this->CellPoints.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Input->GetCellPoints(this->OriginalIds[i], cellPts);
+      vtkIdType *cell = this->Connectivity + this->Locations[i];
+      vtkIdType npts = cellPts->GetNumberOfIds();
+      *cell++ = npts;
+      for (vtkIdType j = 0; j < npts; ++j)
+        {
+        *cell++ = this->PointMap[cellPts->GetId(j)];
+        }
+      }
+  }
+};
+
+// One vertex per point.
+struct vtkExtractSelectionVertices
+{
+  vtkIdType *Connectivity;
+  vtkIdType *Locations;
+  unsigned char *Types;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Connectivity[2 * i] = 1;
+      this->Connectivity[2 * i + 1] = i;
+      this->Locations[i] = 2 * i;
+      this->Types[i] = VTK_VERTEX;
+      }
+  }
+};
+
+// Copies the attributes of the selected elements.
+void vtkExtractSelectionCopyAttributes(vtkDataSetAttributes *in,
+                                       vtkDataSetAttributes *out,
+                                       vtkIdTypeArray *originalIds)
+{
+  vtkIdType n = originalIds->GetNumberOfTuples();
+  out->SetCopyGlobalIds(1);
+  out->CopyFieldOff(originalIds->GetName());
+  out->CopyAllocate(in, n);
+  vtkNew<vtkIdList> fromIds;
+  vtkNew<vtkIdList> toIds;
+  fromIds->SetNumberOfIds(n);
+  toIds->SetNumberOfIds(n);
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    fromIds->SetId(i, originalIds->GetValue(i));
+    toIds->SetId(i, i);
+    }
+  out->CopyData(in, fromIds.GetPointer(), toIds.GetPointer());
+  out->AddArray(originalIds);
+}
+}
+
 //----------------------------------------------------------------------------
 vtkExtractSelectionBase::vtkExtractSelectionBase()
 {
@@ -122,6 +409,142 @@ int vtkExtractSelectionBase::RequestDataObject(
   return 0;
 }
 
+//----------------------------------------------------------------------------
+void vtkExtractSelectionBase::ExtractElements(vtkDataSet *input,
+                                              const signed char *pointInside,
+                                              const signed char *cellInside,
+                                              vtkUnstructuredGrid *output)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+  output->Initialize();
+
+  // GetCellPoints() and GetCellType() are thread safe once called from a
+  // single thread.
+  vtkNew<vtkIdList> cellPts;
+  if (numCells > 0)
+    {
+    input->GetCellPoints(0, cellPts.GetPointer());
+    input->GetCellType(0);
+    }
+
+  // The points: the selected ones and those of the selected cells.
+  std::vector<vtkIdType> pointMap(numPts + 1);
+  vtkExtractSelectionMarkInside markPoints = { pointInside, &pointMap[0] };
+  vtkSMPTools::For(0, numPts, markPoints);
+  if (cellInside)
+    {
+    vtkExtractSelectionMarkCellPoints markCellPoints;
+    markCellPoints.Input = input;
+    markCellPoints.CellInside = cellInside;
+    markCellPoints.PointMap = &pointMap[0];
+    vtkSMPTools::For(0, numCells, markCellPoints);
+    }
+  vtkNew<vtkIdTypeArray> originalPointIds;
+  originalPointIds->SetName("vtkOriginalPointIds");
+  vtkIdType numNewPts = vtkExtractSelectionBuildMap(
+    &pointMap[0], numPts, originalPointIds.GetPointer());
+
+  vtkNew<vtkPoints> newPts;
+  if (vtkPointSet *pointSet = vtkPointSet::SafeDownCast(input))
+    {
+    if (pointSet->GetPoints())
+      {
+      newPts->SetDataType(pointSet->GetPoints()->GetDataType());
+      }
+    }
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkExtractSelectionCopyPoints copyPoints =
+    { input, originalPointIds->GetPointer(0), newPts.GetPointer() };
+  vtkSMPTools::For(0, numNewPts, copyPoints);
+  output->SetPoints(newPts.GetPointer());
+  vtkExtractSelectionCopyAttributes(input->GetPointData(),
+                                    output->GetPointData(),
+                                    originalPointIds.GetPointer());
+
+  vtkNew<vtkCellArray> cells;
+  vtkNew<vtkIdTypeArray> connectivity;
+  vtkNew<vtkIdTypeArray> locations;
+  vtkNew<vtkUnsignedCharArray> types;
+  if (!cellInside)
+    {
+    connectivity->SetNumberOfTuples(2 * numNewPts);
+    locations->SetNumberOfTuples(numNewPts);
+    types->SetNumberOfTuples(numNewPts);
+    vtkExtractSelectionVertices vertices = { connectivity->GetPointer(0),
+      locations->GetPointer(0), types->GetPointer(0) };
+    vtkSMPTools::For(0, numNewPts, vertices);
+    cells->SetCells(numNewPts, connectivity.GetPointer());
+    output->SetCells(types.GetPointer(), locations.GetPointer(),
+                     cells.GetPointer());
+    return;
+    }
+
+  // The cells.
+  std::vector<vtkIdType> cellMap(numCells + 1);
+  vtkExtractSelectionMarkInside markCells = { cellInside, &cellMap[0] };
+  vtkSMPTools::For(0, numCells, markCells);
+  vtkNew<vtkIdTypeArray> originalCellIds;
+  originalCellIds->SetName("vtkOriginalCellIds");
+  vtkIdType numNewCells = vtkExtractSelectionBuildMap(
+    &cellMap[0], numCells, originalCellIds.GetPointer());
+  const vtkIdType *cellIds = originalCellIds->GetPointer(0);
+
+  vtkUnstructuredGrid *inputUG = vtkUnstructuredGrid::SafeDownCast(input);
+  if (inputUG && inputUG->GetFaces())
+    {
+    // Polyhedra need their face streams, inserted one by one.
+    output->Allocate(numNewCells);
+    for (vtkIdType i = 0; i < numNewCells; ++i)
+      {
+      int cellType = input->GetCellType(cellIds[i]);
+      if (cellType == VTK_POLYHEDRON)
+        {
+        inputUG->GetFaceStream(cellIds[i], cellPts.GetPointer());
+        vtkUnstructuredGrid::ConvertFaceStreamPointIds(cellPts.GetPointer(),
+                                                       &pointMap[0]);
+        }
+      else
+        {
+        input->GetCellPoints(cellIds[i], cellPts.GetPointer());
+        for (vtkIdType j = 0; j < cellPts->GetNumberOfIds(); ++j)
+          {
+          cellPts->SetId(j, pointMap[cellPts->GetId(j)]);
+          }
+        }
+      output->InsertNextCell(cellType, cellPts.GetPointer());
+      }
+    }
+  else
+    {
+    locations->SetNumberOfTuples(numNewCells);
+    types->SetNumberOfTuples(numNewCells);
+    vtkExtractSelectionCellSizes sizes;
+    sizes.Input = input;
+    sizes.OriginalIds = cellIds;
+    sizes.Sizes = locations->GetPointer(0);
+    sizes.Types = types->GetPointer(0);
+    vtkSMPTools::For(0, numNewCells, sizes);
+    vtkIdType connectivitySize =
+      vtkExtractSelectionPrefixSums(locations->GetPointer(0), numNewCells);
+
+    connectivity->SetNumberOfTuples(connectivitySize);
+    vtkExtractSelectionCellConnectivity fill;
+    fill.Input = input;
+    fill.OriginalIds = cellIds;
+    fill.PointMap = &pointMap[0];
+    fill.Locations = locations->GetPointer(0);
+    fill.Connectivity = connectivity->GetPointer(0);
+    vtkSMPTools::For(0, numNewCells, fill);
+    cells->SetCells(numNewCells, connectivity.GetPointer());
+    output->SetCells(types.GetPointer(), locations.GetPointer(),
+                     cells.GetPointer());
+    }
+  vtkExtractSelectionCopyAttributes(input->GetCellData(),
+                                    output->GetCellData(),
+                                    originalCellIds.GetPointer());
+}
+
 //----------------------------------------------------------------------------
 void vtkExtractSelectionBase::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -24,6 +24,9 @@
 #include "vtkFiltersGeneralModule.h" // For export macro
 #include "vtkDataObjectAlgorithm.h"
 
+class vtkDataSet;
+class vtkUnstructuredGrid;
+
 class VTKFILTERSGENERAL_EXPORT vtkExtractSelectionBase : public vtkDataObjectAlgorithm
 {
 public:
@@ -42,6 +45,8 @@ public:
   // This flag tells the extraction filter not to convert the selected
   // output into an unstructured grid, but instead to produce a vtkInsidedness
   // array and add it to the input dataset. Default value is false(0).
+  // The output then shares the geometry of the input, which makes it the
+  // mode of choice to only highlight the selection.
   vtkSetMacro(PreserveTopology, int);
   vtkGetMacro(PreserveTopology, int);
   vtkBooleanMacro(PreserveTopology, int);
@@ -59,6 +64,19 @@ protected:
 
   virtual int FillInputPortInformation(int port, vtkInformation* info);
 
+  // Description:
+  // Copies to output the points and the cells of input whose insidedness
+  // is positive, with their attributes and vtkOriginalPointIds and
+  // vtkOriginalCellIds arrays. The points of the extracted cells are always
+  // extracted; pointInside may be NULL to extract only those. When
+  // cellInside is NULL, a vertex is generated for each extracted point
+  // instead. The points and the cells keep their order: their new ids are
+  // the prefix sums of the insidedness, which lets the points and the cells
+  // be copied in parallel with vtkSMPTools.
+  void ExtractElements(vtkDataSet *input, const signed char *pointInside,
+                       const signed char *cellInside,
+                       vtkUnstructuredGrid *output);
+
   int PreserveTopology;
 private:
   vtkExtractSelectionBase(const vtkExtractSelectionBase&); // Not implemented.
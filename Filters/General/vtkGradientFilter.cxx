@@ -25,6 +25,7 @@
 #include "vtkCellDataToPointData.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -35,7 +36,11 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
@@ -755,97 +760,195 @@ int vtkGradientFilter::ComputeRegularGridGradient(
 
 namespace {
 //-----------------------------------------------------------------------------
+  // Computes the gradient at point from the cells using it, averaged over
+  // those cells, and the quantities derived from it. g and values are
+  // scratch buffers.
   template<class data_type>
-  void ComputePointGradientsUG(
-    vtkDataSet *structure, data_type *array, data_type *gradients,
-    int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
-    data_type* divergence)
+  void ComputePointGradient(
+    vtkDataSet *structure, vtkIdType point, vtkIdType numCellNeighbors,
+    const vtkIdType *cellIds, vtkGenericCell *cell, data_type *array,
+    int numberOfInputComponents, std::vector<data_type> &g,
+    std::vector<double> &values, data_type *gradients, data_type* vorticity,
+    data_type* qCriterion, data_type* divergence)
   {
-    vtkNew<vtkIdList> currentPoint;
-    currentPoint->SetNumberOfIds(1);
-    vtkNew<vtkIdList> cellsOnPoint;
-
-    vtkIdType numpts = structure->GetNumberOfPoints();
-
     int numberOfOutputComponents = 3*numberOfInputComponents;
-    std::vector<data_type> g(numberOfOutputComponents);
+    double pointcoords[3];
+    structure->GetPoint(point, pointcoords);
 
-    for (vtkIdType point = 0; point < numpts; point++)
+    for(int i=0;i<numberOfOutputComponents;i++)
       {
-      currentPoint->SetId(0, point);
-      double pointcoords[3];
-      structure->GetPoint(point, pointcoords);
-      // Get all cells touching this point.
-      structure->GetCellNeighbors(-1, currentPoint.GetPointer(),
-                                  cellsOnPoint.GetPointer());
-      vtkIdType numCellNeighbors = cellsOnPoint->GetNumberOfIds();
-      vtkIdType numValidCellNeighbors = 0;
-
-      for(int i=0;i<numberOfOutputComponents;i++)
-        {
-        g[i] = 0;
-        }
+      g[i] = 0;
+      }
 
-      // Iterate on all cells and find all points connected to current point
-      // by an edge.
-      for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
+    // Iterate on all cells and find all points connected to current point
+    // by an edge.
+    for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
+      {
+      structure->GetCell(cellIds[neighbor], cell);
+      int subId;
+      double parametricCoord[3];
+      if(GetCellParametricData(point, pointcoords, cell,
+                               subId, parametricCoord))
         {
-        vtkCell *cell = structure->GetCell(cellsOnPoint->GetId(neighbor));
-        int subId;
-        double parametricCoord[3];
-        if(GetCellParametricData(point, pointcoords, cell,
-                                 subId, parametricCoord))
+        int NumberOfCellPoints = cell->GetNumberOfPoints();
+        if(static_cast<size_t>(NumberOfCellPoints) > values.size())
+          {
+          values.resize(NumberOfCellPoints);
+          }
+        for(int InputComponent=0;InputComponent<numberOfInputComponents;InputComponent++)
           {
-          numValidCellNeighbors++;
-          for(int InputComponent=0;InputComponent<numberOfInputComponents;InputComponent++)
+          // Get values of Array at cell points.
+          for (int i = 0; i < NumberOfCellPoints; i++)
             {
-            int NumberOfCellPoints = cell->GetNumberOfPoints();
-            std::vector<double> values(NumberOfCellPoints);
-            // Get values of Array at cell points.
-            for (int i = 0; i < NumberOfCellPoints; i++)
-              {
-              values[i] = static_cast<double>(
-                array[cell->GetPointId(i)*numberOfInputComponents+InputComponent]);
-              }
+            values[i] = static_cast<double>(
+              array[cell->GetPointId(i)*numberOfInputComponents+InputComponent]);
+            }
 
-            double derivative[3];
-            // Get derivative of cell at point.
-            cell->Derivatives(subId, parametricCoord, &values[0], 1, derivative);
+          double derivative[3];
+          // Get derivative of cell at point.
+          cell->Derivatives(subId, parametricCoord, &values[0], 1, derivative);
 
-            g[InputComponent*3] += static_cast<data_type>(derivative[0]);
-            g[InputComponent*3+1] += static_cast<data_type>(derivative[1]);
-            g[InputComponent*3+2] += static_cast<data_type>(derivative[2]);
-            } // iterating over Components
-          } // if(GetCellParametricData())
-        } // iterating over neighbors
+          g[InputComponent*3] += static_cast<data_type>(derivative[0]);
+          g[InputComponent*3+1] += static_cast<data_type>(derivative[1]);
+          g[InputComponent*3+2] += static_cast<data_type>(derivative[2]);
+          } // iterating over Components
+        } // if(GetCellParametricData())
+      } // iterating over neighbors
 
-      if (numCellNeighbors > 0)
+    if (numCellNeighbors > 0)
+      {
+      for(int i=0;i<numberOfOutputComponents;i++)
         {
-        for(int i=0;i<3*numberOfInputComponents;i++)
-          {
-          g[i] /= numCellNeighbors;
-          }
+        g[i] /= numCellNeighbors;
         }
+      }
 
-      if(vorticity)
+    if(vorticity)
+      {
+      ComputeVorticityFromGradient(&g[0], vorticity+3*point);
+      }
+    if(qCriterion)
+      {
+      ComputeQCriterionFromGradient(&g[0], qCriterion+point);
+      }
+    if(divergence)
+      {
+      ComputeDivergenceFromGradient(&g[0], divergence+point);
+      }
+    if(gradients)
+      {
+      for(int i=0;i<numberOfOutputComponents;i++)
         {
-        ComputeVorticityFromGradient(&g[0], vorticity+3*point);
+        gradients[point*numberOfOutputComponents+i] = g[i];
         }
-      if(qCriterion)
+      }
+  }
+
+//-----------------------------------------------------------------------------
+  // Computes the point gradients of a polygonal or unstructured data set in
+  // parallel. The cells of each point come from the static links of the
+  // data set, which are read-only once built; each thread has its own
+  // cell and scratch buffers. Every point is written by one thread only.
+  template<class data_type>
+  class ComputePointGradientsUGFunctor
+  {
+  public:
+    vtkPointSet *Structure;
+    vtkStaticCellLinks *Links;
+    data_type *Array;
+    int NumberOfInputComponents;
+    data_type *Gradients;
+    data_type *Vorticity;
+    data_type *QCriterion;
+    data_type *Divergence;
+
+    vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+    vtkSMPThreadLocal<std::vector<data_type> > G;
+    vtkSMPThreadLocal<std::vector<double> > Values;
+
+    void Initialize()
+    {
+      this->G.Local().resize(3*this->NumberOfInputComponents);
+      this->Values.Local().resize(8);
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      vtkGenericCell *cell = this->Cell.Local();
+      std::vector<data_type> &g = this->G.Local();
+      std::vector<double> &values = this->Values.Local();
+      for (vtkIdType point = begin; point < end; point++)
         {
-        ComputeQCriterionFromGradient(&g[0], qCriterion+point);
+        ComputePointGradient(
+          this->Structure, point, this->Links->GetNumberOfCells(point),
+          this->Links->GetCells(point), cell, this->Array,
+          this->NumberOfInputComponents, g, values, this->Gradients,
+          this->Vorticity, this->QCriterion, this->Divergence);
         }
-      if(divergence)
+    }
+
+    void Reduce()
+    {
+    }
+  };
+
+//-----------------------------------------------------------------------------
+  template<class data_type>
+  void ComputePointGradientsUG(
+    vtkDataSet *structure, data_type *array, data_type *gradients,
+    int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
+    data_type* divergence)
+  {
+    vtkIdType numpts = structure->GetNumberOfPoints();
+
+    vtkPolyData *polyData = vtkPolyData::SafeDownCast(structure);
+    vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(structure);
+    if (polyData || grid)
+      {
+      // Build the lazily created structures that GetCell() would otherwise
+      // build from several threads at once.
+      vtkPointSet *pointSet = static_cast<vtkPointSet*>(structure);
+      if (polyData && polyData->GetNumberOfCells() > 0)
         {
-        ComputeDivergenceFromGradient(&g[0], divergence+point);
+        polyData->GetCellType(0);
         }
-      if(gradients)
+      if (grid && grid->GetCachePolyhedronTopology() && grid->GetFaces())
         {
-        for(int i=0;i<numberOfOutputComponents;i++)
-          {
-          gradients[point*numberOfOutputComponents+i] = g[i];
-          }
+        grid->BuildPolyhedronTopology();
         }
+
+      ComputePointGradientsUGFunctor<data_type> functor;
+      functor.Structure = pointSet;
+      functor.Links = pointSet->GetStaticCellLinks();
+      functor.Array = array;
+      functor.NumberOfInputComponents = numberOfInputComponents;
+      functor.Gradients = gradients;
+      functor.Vorticity = vorticity;
+      functor.QCriterion = qCriterion;
+      functor.Divergence = divergence;
+      vtkSMPTools::For(0, numpts, functor);
+      return;
+      }
+
+    vtkNew<vtkIdList> currentPoint;
+    currentPoint->SetNumberOfIds(1);
+    vtkNew<vtkIdList> cellsOnPoint;
+    vtkNew<vtkGenericCell> cell;
+
+    std::vector<data_type> g(3*numberOfInputComponents);
+    std::vector<double> values(8);
+
+    for (vtkIdType point = 0; point < numpts; point++)
+      {
+      currentPoint->SetId(0, point);
+      // Get all cells touching this point.
+      structure->GetCellNeighbors(-1, currentPoint.GetPointer(),
+                                  cellsOnPoint.GetPointer());
+      ComputePointGradient(
+        structure, point, cellsOnPoint->GetNumberOfIds(),
+        cellsOnPoint->GetPointer(0), cell.GetPointer(), array,
+        numberOfInputComponents, g, values, gradients, vorticity, qCriterion,
+        divergence);
       }  // iterating over points in grid
   }
 
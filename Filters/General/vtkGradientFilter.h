@@ -29,6 +29,12 @@
 // output tuple will be {du/dx, du/dy, du/dz, dv/dx, dv/dy, dv/dz, dw/dx,
 // dw/dy, dw/dz} for an input array {u, v, w}. There are also the options
 // to additionally compute the vorticity and Q criterion of a vector field.
+//
+// Point gradients of polygonal and unstructured data are computed in
+// parallel with vtkSMPTools, visiting the cells of each point through the
+// static cell links of the input (see vtkPointSet::GetStaticCellLinks()).
+// Gradient, divergence, vorticity and Q criterion are all computed in the
+// same pass over the points.
 
 #ifndef vtkGradientFilter_h
 #define vtkGradientFilter_h
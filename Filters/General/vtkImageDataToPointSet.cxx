@@ -25,6 +25,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStructuredGrid.h"
+#include "vtkStructuredPointArray.h"
 
 #include "vtkNew.h"
 
@@ -33,6 +34,7 @@ vtkStandardNewMacro(vtkImageDataToPointSet);
 //-------------------------------------------------------------------------
 vtkImageDataToPointSet::vtkImageDataToPointSet()
 {
+  this->ImplicitPoints = 1;
 }
 
 vtkImageDataToPointSet::~vtkImageDataToPointSet()
@@ -42,6 +44,8 @@ vtkImageDataToPointSet::~vtkImageDataToPointSet()
 void vtkImageDataToPointSet::PrintSelf(ostream &os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ImplicitPoints: " << this->ImplicitPoints << endl;
 }
 
 //-------------------------------------------------------------------------
@@ -72,6 +76,23 @@ int vtkImageDataToPointSet::CopyStructure(vtkStructuredGrid *outData,
   outData->SetExtent(extent);
 
   vtkNew<vtkPoints> points;
+  if (this->ImplicitPoints)
+    {
+    // The coordinates are computed on access from the axes of the image.
+    int dims[3];
+    double start[3];
+    inData->GetDimensions(dims);
+    for (int axis = 0; axis < 3; axis++)
+      {
+      start[axis] = origin[axis] + spacing[axis]*extent[2*axis];
+      }
+    vtkNew<vtkStructuredPointArray<double> > coords;
+    coords->SetUniformAxes(dims, start, spacing);
+    points->SetData(coords.GetPointer());
+    outData->SetPoints(points.GetPointer());
+    return 1;
+    }
+
   points->SetDataTypeToDouble();
   points->SetNumberOfPoints(inData->GetNumberOfPoints());
 
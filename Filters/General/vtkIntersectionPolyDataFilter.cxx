@@ -26,6 +26,8 @@
 #include "vtkPlane.h"
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSortDataArray.h"
 #include "vtkTransform.h"
@@ -33,6 +35,7 @@
 
 #include <map>
 #include <queue>
+#include <vector>
 
 //----------------------------------------------------------------------------
 // Helper typedefs and data structure.
@@ -49,6 +52,18 @@ typedef struct _CellEdgeLine {
 typedef std::multimap< vtkIdType, CellEdgeLineType > PointEdgeMapType;
 typedef PointEdgeMapType::iterator                   PointEdgeMapIteratorType;
 
+// An intersection line between a cell of each mesh, before its points are
+// merged.
+typedef struct _IntersectionSegment {
+  vtkIdType CellId0;
+  vtkIdType CellId1;
+  double    Pt0[3];
+  double    Pt1[3];
+} IntersectionSegmentType;
+
+typedef std::vector< IntersectionSegmentType > SegmentVectorType;
+typedef std::pair< vtkOBBNode*, vtkOBBNode* >   NodePairType;
+
 
 //----------------------------------------------------------------------------
 // Private implementation to hide STL.
@@ -62,15 +77,51 @@ public:
   static int FindTriangleIntersections(vtkOBBNode *node0, vtkOBBNode *node1,
                                        vtkMatrix4x4 *transform, void *arg);
 
+  // Records the pairs of overlapping leaf nodes, whose triangles are
+  // intersected later by IntersectNodePairs().
+  static int CollectNodePairs(vtkOBBNode *node0, vtkOBBNode *node1,
+                              vtkMatrix4x4 *transform, void *arg);
+
+  // Intersects the triangles of the recorded node pairs in parallel, then
+  // adds the intersection lines in the order of the pairs.
+  void IntersectNodePairs();
+
+  // Appends the intersection segments between the triangles of two nodes
+  // to segments. Thread safe, given an id list per thread.
+  void IntersectNodes(vtkOBBNode *node0, vtkOBBNode *node1,
+                      vtkMatrix4x4 *transform, SegmentVectorType &segments,
+                      vtkIdList *ptIds0, vtkIdList *ptIds1);
+
+  // Adds an intersection line, merging its points with those of the
+  // previous lines.
+  void AddSegment(const IntersectionSegmentType &segment);
+
   int SplitMesh(int inputIndex, vtkPolyData *output,
                 vtkPolyData *intersectionLines);
 
+  // Split the cells with vtkSMPTools in SplitMesh().
+  bool InParallel;
+
+  // Overlapping leaf nodes collected by CollectNodePairs().
+  std::vector< NodePairType > NodePairs;
+  vtkMatrix4x4 *NodeTransform;
+
+  class IntersectPairsFunctor;
+  class SplitCellsFunctor;
+
 protected:
 
+  // Thread safe once the cells, links and bounds of input are built.
   vtkCellArray* SplitCell(vtkPolyData *input, vtkIdType cellId,
                           vtkIdType *cellPts, IntersectionMapType *map,
                           vtkPolyData *interLines);
 
+  // Returns whether the cell or one of its edge neighbors is split by an
+  // intersection line.
+  bool NeedsSplit(vtkPolyData *input, vtkIdType cellId, vtkIdType npts,
+                  vtkIdType *pts, IntersectionMapType *map,
+                  vtkIdList *edgeNeighbors);
+
   void AddToPointEdgeMap(int index, vtkIdType ptId, double x[3],
                          vtkPolyData *mesh, vtkIdType cellId,
                          vtkIdType edgeId, vtkIdType lineId,
@@ -115,7 +166,8 @@ protected:
 
 //----------------------------------------------------------------------------
 vtkIntersectionPolyDataFilter::Impl::Impl() :
-  OBBTree1(0), IntersectionLines(0), PointMerger(0)
+  InParallel(false), NodeTransform(0), OBBTree1(0), IntersectionLines(0),
+  PointMerger(0)
 {
   for (int i = 0; i < 2; i++)
     {
@@ -145,16 +197,41 @@ int vtkIntersectionPolyDataFilter::Impl
   vtkIntersectionPolyDataFilter::Impl *info =
     reinterpret_cast<vtkIntersectionPolyDataFilter::Impl*>(arg);
 
-  vtkPolyData     *mesh0                = info->Mesh[0];
-  vtkPolyData     *mesh1                = info->Mesh[1];
-  vtkOBBTree      *obbTree1             = info->OBBTree1;
-  vtkCellArray    *intersectionLines    = info->IntersectionLines;
-  vtkIdTypeArray  *intersectionCellIds0 = info->CellIds[0];
-  vtkIdTypeArray  *intersectionCellIds1 = info->CellIds[1];
-  vtkPointLocator *pointMerger          = info->PointMerger;
+  vtkSmartPointer< vtkIdList > ptIds0 = vtkSmartPointer< vtkIdList >::New();
+  vtkSmartPointer< vtkIdList > ptIds1 = vtkSmartPointer< vtkIdList >::New();
+  SegmentVectorType segments;
+  info->IntersectNodes(node0, node1, transform, segments, ptIds0, ptIds1);
+  for (size_t i = 0; i < segments.size(); i++)
+    {
+    info->AddSegment(segments[i]);
+    }
+
+  return static_cast<int>(segments.size());
+}
+
+//----------------------------------------------------------------------------
+int vtkIntersectionPolyDataFilter::Impl
+::CollectNodePairs(vtkOBBNode *node0, vtkOBBNode *node1,
+                   vtkMatrix4x4 *transform, void *arg)
+{
+  vtkIntersectionPolyDataFilter::Impl *info =
+    reinterpret_cast<vtkIntersectionPolyDataFilter::Impl*>(arg);
+  info->NodePairs.push_back(std::make_pair(node0, node1));
+  info->NodeTransform = transform;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl
+::IntersectNodes(vtkOBBNode *node0, vtkOBBNode *node1,
+                 vtkMatrix4x4 *transform, SegmentVectorType &segments,
+                 vtkIdList *ptIds0, vtkIdList *ptIds1)
+{
+  vtkPolyData     *mesh0                = this->Mesh[0];
+  vtkPolyData     *mesh1                = this->Mesh[1];
+  vtkOBBTree      *obbTree1             = this->OBBTree1;
 
   int numCells0 = node0->Cells->GetNumberOfIds();
-  int retval = 0;
 
   for (vtkIdType id0 = 0; id0 < numCells0; id0++)
     {
@@ -163,8 +240,9 @@ int vtkIntersectionPolyDataFilter::Impl
 
     if (type0 == VTK_TRIANGLE)
       {
-      vtkIdType npts0, *triPtIds0;
-      mesh0->GetCellPoints(cellId0, npts0, triPtIds0);
+      vtkIdType npts0;
+      const vtkIdType *triPtIds0;
+      mesh0->GetCellPoints(cellId0, npts0, triPtIds0, ptIds0);
       double triPts0[3][3];
       for (vtkIdType id = 0; id < npts0; id++)
         {
@@ -182,10 +260,10 @@ int vtkIntersectionPolyDataFilter::Impl
           if (type1 == VTK_TRIANGLE)
             {
             // See if the two cells actually intersect. If they do,
-            // add an entry into the intersection maps and add an
-            // intersection line.
-            vtkIdType npts1, *triPtIds1;
-            mesh1->GetCellPoints(cellId1, npts1, triPtIds1);
+            // record the intersection line.
+            vtkIdType npts1;
+            const vtkIdType *triPtIds1;
+            mesh1->GetCellPoints(cellId1, npts1, triPtIds1, ptIds1);
 
             double triPts1[3][3];
             for (vtkIdType id = 0; id < npts1; id++)
@@ -194,12 +272,12 @@ int vtkIntersectionPolyDataFilter::Impl
               }
 
             int coplanar = 0;
-            double outpt0[3], outpt1[3];
+            IntersectionSegmentType segment;
             int intersects =
               vtkIntersectionPolyDataFilter::TriangleTriangleIntersection
               (triPts0[0], triPts0[1], triPts0[2],
                triPts1[0], triPts1[1], triPts1[2],
-               coplanar, outpt0, outpt1);
+               coplanar, segment.Pt0, segment.Pt1);
 
             if ( coplanar )
               {
@@ -209,52 +287,163 @@ int vtkIntersectionPolyDataFilter::Impl
               }
 
             if ( intersects &&
-                 ( outpt0[0] != outpt1[0] ||
-                   outpt0[1] != outpt1[1] ||
-                   outpt0[2] != outpt1[2] ) )
+                 ( segment.Pt0[0] != segment.Pt1[0] ||
+                   segment.Pt0[1] != segment.Pt1[1] ||
+                   segment.Pt0[2] != segment.Pt1[2] ) )
               {
-              vtkIdType lineId = intersectionLines->GetNumberOfCells();
-              intersectionLines->InsertNextCell(2);
-
-              vtkIdType ptId0, ptId1;
-              pointMerger->InsertUniquePoint(outpt0, ptId0);
-              pointMerger->InsertUniquePoint(outpt1, ptId1);
-              intersectionLines->InsertCellPoint(ptId0);
-              intersectionLines->InsertCellPoint(ptId1);
-
-              intersectionCellIds0->InsertNextValue(cellId0);
-              intersectionCellIds1->InsertNextValue(cellId1);
-
-              info->PointCellIds[0]->InsertValue( ptId0, cellId0 );
-              info->PointCellIds[0]->InsertValue( ptId1, cellId0 );
-              info->PointCellIds[1]->InsertValue( ptId0, cellId1 );
-              info->PointCellIds[1]->InsertValue( ptId1, cellId1 );
-
-              info->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
-              info->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
-
-              // Check which edges of cellId0 and cellId1 outpt0 and
-              // outpt1 are on, if any.
-              for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
-                {
-                info->AddToPointEdgeMap(0, ptId0, outpt0, mesh0, cellId0,
-                                        edgeId, lineId, triPtIds0);
-                info->AddToPointEdgeMap(0, ptId1, outpt1, mesh0, cellId0,
-                                        edgeId, lineId, triPtIds0);
-                info->AddToPointEdgeMap(1, ptId0, outpt0, mesh1, cellId1,
-                                        edgeId, lineId, triPtIds1);
-                info->AddToPointEdgeMap(1, ptId1, outpt1, mesh1, cellId1,
-                                        edgeId, lineId, triPtIds1);
-                }
-              retval++;
+              segment.CellId0 = cellId0;
+              segment.CellId1 = cellId1;
+              segments.push_back(segment);
               }
             }
           }
         }
       }
     }
+}
 
-  return retval;
+//----------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl
+::AddSegment(const IntersectionSegmentType &segment)
+{
+  vtkIdType cellId0 = segment.CellId0;
+  vtkIdType cellId1 = segment.CellId1;
+  double outpt0[3] = { segment.Pt0[0], segment.Pt0[1], segment.Pt0[2] };
+  double outpt1[3] = { segment.Pt1[0], segment.Pt1[1], segment.Pt1[2] };
+
+  // Add an entry into the intersection maps and add an intersection line.
+  vtkIdType lineId = this->IntersectionLines->GetNumberOfCells();
+  this->IntersectionLines->InsertNextCell(2);
+
+  vtkIdType ptId0, ptId1;
+  this->PointMerger->InsertUniquePoint(outpt0, ptId0);
+  this->PointMerger->InsertUniquePoint(outpt1, ptId1);
+  this->IntersectionLines->InsertCellPoint(ptId0);
+  this->IntersectionLines->InsertCellPoint(ptId1);
+
+  this->CellIds[0]->InsertNextValue(cellId0);
+  this->CellIds[1]->InsertNextValue(cellId1);
+
+  this->PointCellIds[0]->InsertValue( ptId0, cellId0 );
+  this->PointCellIds[0]->InsertValue( ptId1, cellId0 );
+  this->PointCellIds[1]->InsertValue( ptId0, cellId1 );
+  this->PointCellIds[1]->InsertValue( ptId1, cellId1 );
+
+  this->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
+  this->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
+
+  vtkIdType npts, *pts, triPtIds0[3], triPtIds1[3];
+  this->Mesh[0]->GetCellPoints(cellId0, npts, pts);
+  std::copy(pts, pts + 3, triPtIds0);
+  this->Mesh[1]->GetCellPoints(cellId1, npts, pts);
+  std::copy(pts, pts + 3, triPtIds1);
+
+  // Check which edges of cellId0 and cellId1 outpt0 and
+  // outpt1 are on, if any.
+  for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
+    {
+    this->AddToPointEdgeMap(0, ptId0, outpt0, this->Mesh[0], cellId0,
+                            edgeId, lineId, triPtIds0);
+    this->AddToPointEdgeMap(0, ptId1, outpt1, this->Mesh[0], cellId0,
+                            edgeId, lineId, triPtIds0);
+    this->AddToPointEdgeMap(1, ptId0, outpt0, this->Mesh[1], cellId1,
+                            edgeId, lineId, triPtIds1);
+    this->AddToPointEdgeMap(1, ptId1, outpt1, this->Mesh[1], cellId1,
+                            edgeId, lineId, triPtIds1);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Intersects the triangles of the pairs of nodes, each pair into its own
+// vector of segments.
+class vtkIntersectionPolyDataFilter::Impl::IntersectPairsFunctor
+{
+public:
+  vtkIntersectionPolyDataFilter::Impl *Info;
+  SegmentVectorType *Segments;
+  vtkSMPThreadLocalObject<vtkIdList> PtIds0;
+  vtkSMPThreadLocalObject<vtkIdList> PtIds1;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *ptIds0 = this->PtIds0.Local();
+    vtkIdList *ptIds1 = this->PtIds1.Local();
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      this->Info->IntersectNodes(this->Info->NodePairs[i].first,
+                                 this->Info->NodePairs[i].second,
+                                 this->Info->NodeTransform,
+                                 this->Segments[i], ptIds0, ptIds1);
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Splits the given cells, each into its own cell array.
+class vtkIntersectionPolyDataFilter::Impl::SplitCellsFunctor
+{
+public:
+  vtkIntersectionPolyDataFilter::Impl *Info;
+  vtkPolyData *Input;
+  IntersectionMapType *Map;
+  vtkPolyData *Lines;
+  const vtkIdType *CellIds;
+  vtkIdType *CellPts; // 3 per cell
+  vtkCellArray **SplitCells;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      this->SplitCells[i] = this->Info->SplitCell
+        (this->Input, this->CellIds[i], this->CellPts + 3*i, this->Map,
+         this->Lines);
+      }
+  }
+};
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Builds the OBB trees of the two meshes at the same time.
+class BuildTreesFunctor
+{
+public:
+  vtkOBBTree *Trees[2];
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      this->Trees[i]->BuildLocator();
+      }
+  }
+};
+
+}
+
+//----------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::IntersectNodePairs()
+{
+  vtkIdType numPairs = static_cast<vtkIdType>(this->NodePairs.size());
+  std::vector< SegmentVectorType > segments(numPairs);
+  if ( numPairs > 0 )
+    {
+    IntersectPairsFunctor intersect;
+    intersect.Info = this;
+    intersect.Segments = &segments[0];
+    vtkSMPTools::For(0, numPairs, intersect);
+    }
+
+  for (vtkIdType i = 0; i < numPairs; i++)
+    {
+    for (size_t j = 0; j < segments[i].size(); j++)
+      {
+      this->AddSegment(segments[i][j]);
+      }
+    }
+  this->NodePairs.clear();
 }
 
 
@@ -340,8 +529,44 @@ int vtkIntersectionPolyDataFilter::Impl
       vtkSmartPointer< vtkIdList >::New();
     vtkIdType nptsX = 0;
     vtkIdType *pts = 0;
-    vtkSmartPointer< vtkIdList > cellsToCheck =
-      vtkSmartPointer< vtkIdList >::New();
+
+    // Split the cells up front, in parallel, if requested. They are then
+    // added in order below. The bounds of the input are computed first as
+    // they are read by SplitCell().
+    std::vector< vtkIdType > splitCellIds, splitCellPts;
+    std::vector< vtkCellArray* > splitCellsList;
+    size_t nextSplit = 0;
+    if ( this->InParallel )
+      {
+      input->GetBounds();
+      for (cells->InitTraversal(); cells->GetNextCell(nptsX, pts); cellIdX++)
+        {
+        if ( nptsX == 3 &&
+             this->NeedsSplit(input, cellIdX, nptsX, pts, intersectionMap,
+                              edgeNeighbors) )
+          {
+          splitCellIds.push_back(cellIdX);
+          splitCellPts.insert(splitCellPts.end(), pts, pts + 3);
+          }
+        }
+      cellIdX = 0;
+
+      splitCellsList.resize(splitCellIds.size(), NULL);
+      if ( !splitCellIds.empty() )
+        {
+        SplitCellsFunctor split;
+        split.Info = this;
+        split.Input = input;
+        split.Map = intersectionMap;
+        split.Lines = splitLines;
+        split.CellIds = &splitCellIds[0];
+        split.CellPts = &splitCellPts[0];
+        split.SplitCells = &splitCellsList[0];
+        vtkSMPTools::For(0, static_cast<vtkIdType>(splitCellIds.size()),
+                         split);
+        }
+      }
+
     for (cells->InitTraversal(); cells->GetNextCell(nptsX, pts); cellIdX++)
       {
       if ( nptsX != 3 )
@@ -351,35 +576,12 @@ int vtkIntersectionPolyDataFilter::Impl
         continue;
         }
 
-      cellsToCheck->Reset();
-      cellsToCheck->Allocate(nptsX+1);
-      cellsToCheck->InsertNextId(cellIdX);
-
-      // Collect the cells relevant for splitting this cell.  If the
-      // cell is in the intersection map, split. If not, one of its
-      // edges may be split by an intersection line that splits a
-      // neighbor cell. Mark the cell as needing a split if this is
-      // the case.
-      bool needsSplit = intersectionMap->find( cellIdX ) != intersectionMap->end();
-      for (vtkIdType ptId = 0; ptId < nptsX; ptId++)
-        {
-        vtkIdType pt0Id = pts[ptId];
-        vtkIdType pt1Id = pts[(ptId+1) % nptsX];
-        edgeNeighbors->Reset();
-        input->GetCellEdgeNeighbors(cellIdX, pt0Id, pt1Id, edgeNeighbors);
-        for (vtkIdType nbr = 0; nbr < edgeNeighbors->GetNumberOfIds(); nbr++)
-          {
-          vtkIdType nbrId = edgeNeighbors->GetId(nbr);
-          cellsToCheck->InsertNextId(nbrId);
-
-          if ( intersectionMap->find( nbrId ) != intersectionMap->end() )
-            {
-            needsSplit = true;
-            }
-          } // for (vtkIdType nbr = 0; ...
-        } // for (vtkIdType pt = 0; ...
-
       // Splitting occurs here
+      bool needsSplit = ( this->InParallel ?
+        ( nextSplit < splitCellIds.size() &&
+          splitCellIds[nextSplit] == cellIdX ) :
+        this->NeedsSplit(input, cellIdX, nptsX, pts, intersectionMap,
+                         edgeNeighbors) );
       if ( !needsSplit )
         {
         // Just insert the cell and copy the cell data
@@ -388,8 +590,9 @@ int vtkIntersectionPolyDataFilter::Impl
         }
       else
         {
-        vtkCellArray *splitCells = this->SplitCell
-          (input, cellIdX, pts, intersectionMap, splitLines);
+        vtkCellArray *splitCells = ( this->InParallel ?
+          splitCellsList[nextSplit++] :
+          this->SplitCell(input, cellIdX, pts, intersectionMap, splitLines) );
 
         double pt0[3], pt1[3], pt2[3], normal[3];
         points->GetPoint(pts[0], pt0);
@@ -433,6 +636,35 @@ int vtkIntersectionPolyDataFilter::Impl
   return 1;
 }
 
+//----------------------------------------------------------------------------
+bool vtkIntersectionPolyDataFilter::Impl
+::NeedsSplit(vtkPolyData *input, vtkIdType cellId, vtkIdType npts,
+             vtkIdType *pts, IntersectionMapType *map,
+             vtkIdList *edgeNeighbors)
+{
+  // If the cell is in the intersection map, split. If not, one of its
+  // edges may be split by an intersection line that splits a neighbor
+  // cell. Mark the cell as needing a split if this is the case.
+  if ( map->find( cellId ) != map->end() )
+    {
+    return true;
+    }
+  for (vtkIdType ptId = 0; ptId < npts; ptId++)
+    {
+    vtkIdType pt0Id = pts[ptId];
+    vtkIdType pt1Id = pts[(ptId+1) % npts];
+    edgeNeighbors->Reset();
+    input->GetCellEdgeNeighbors(cellId, pt0Id, pt1Id, edgeNeighbors);
+    for (vtkIdType nbr = 0; nbr < edgeNeighbors->GetNumberOfIds(); nbr++)
+      {
+      if ( map->find( edgeNeighbors->GetId(nbr) ) != map->end() )
+        {
+        return true;
+        }
+      }
+    }
+  return false;
+}
 
 //----------------------------------------------------------------------------
 vtkCellArray* vtkIntersectionPolyDataFilter::Impl
@@ -471,13 +703,17 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl
   // point IDs from the cell are not stored here.
   std::map< vtkIdType, vtkIdType > ptIdMap;
 
+  vtkSmartPointer< vtkIdList > linePtIdList =
+    vtkSmartPointer< vtkIdList >::New();
   IntersectionMapIteratorType iterLower = map->lower_bound( cellId );
   IntersectionMapIteratorType iterUpper = map->upper_bound( cellId );
   while ( iterLower != iterUpper )
     {
     vtkIdType lineId = iterLower->second;
-    vtkIdType nLinePts, *linePtIds;
-    interLines->GetLines()->GetCell( 3*lineId, nLinePts, linePtIds );
+    vtkIdType nLinePts;
+    const vtkIdType *linePtIds;
+    interLines->GetLines()->GetCell( 3*lineId, nLinePts, linePtIds,
+                                     linePtIdList );
     lines->InsertNextCell(2);
     for (vtkIdType i = 0; i < nLinePts; i++)
       {
@@ -531,8 +767,10 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl
       while ( iterLower != iterUpper )
         {
         vtkIdType lineId = iterLower->second;
-        vtkIdType nLinePts, *linePtIds;
-        interLines->GetLines()->GetCell( 3*lineId, nLinePts, linePtIds );
+        vtkIdType nLinePts;
+        const vtkIdType *linePtIds;
+        interLines->GetLines()->GetCell( 3*lineId, nLinePts, linePtIds,
+                                         linePtIdList );
         for (vtkIdType k = 0; k < nLinePts; k++)
           {
           double t, closestPt[3];
@@ -892,7 +1130,7 @@ vtkStandardNewMacro(vtkIntersectionPolyDataFilter);
 
 //----------------------------------------------------------------------------
 vtkIntersectionPolyDataFilter::vtkIntersectionPolyDataFilter()
-  : SplitFirstOutput(1), SplitSecondOutput(1)
+  : SplitFirstOutput(1), SplitSecondOutput(1), IntersectInParallel(0)
 {
   this->SetNumberOfInputPorts(2);
   this->SetNumberOfOutputPorts(3);
@@ -910,6 +1148,7 @@ void vtkIntersectionPolyDataFilter::PrintSelf(ostream &os, vtkIndent indent)
 
   os << indent << "SplitFirstOutput: " << this->SplitFirstOutput << "\n";
   os << indent << "SplitSecondOutput: " << this->SplitSecondOutput << "\n";
+  os << indent << "IntersectInParallel: " << this->IntersectInParallel << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -1108,7 +1347,6 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation*        vtkNotUsed
   obbTree0->SetMaxLevel(1000000);
   obbTree0->SetTolerance(1e-6);
   obbTree0->AutomaticOn();
-  obbTree0->BuildLocator();
 
   vtkSmartPointer< vtkOBBTree > obbTree1 = vtkSmartPointer< vtkOBBTree >::New();
   obbTree1->SetDataSet(mesh1);
@@ -1116,7 +1354,23 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation*        vtkNotUsed
   obbTree1->SetMaxLevel(1000000);
   obbTree1->SetTolerance(1e-6);
   obbTree1->AutomaticOn();
-  obbTree1->BuildLocator();
+
+  if ( this->IntersectInParallel )
+    {
+    // The cells are built before the trees are, so that they can be read
+    // from several threads later on.
+    mesh0->BuildCells();
+    mesh1->BuildCells();
+    BuildTreesFunctor build;
+    build.Trees[0] = obbTree0;
+    build.Trees[1] = obbTree1;
+    vtkSMPTools::For(0, 2, 1, build);
+    }
+  else
+    {
+    obbTree0->BuildLocator();
+    obbTree1->BuildLocator();
+    }
 
   // Set up the structure for determining exact triangle-triangle
   // intersections.
@@ -1124,6 +1378,7 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation*        vtkNotUsed
   impl->Mesh[0]  = mesh0;
   impl->Mesh[1]  = mesh1;
   impl->OBBTree1 = obbTree1;
+  impl->InParallel = ( this->IntersectInParallel != 0 );
 
   vtkSmartPointer< vtkCellArray > lines = vtkSmartPointer< vtkCellArray >::New();
   outputIntersection->SetLines(lines);
@@ -1168,10 +1423,22 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation*        vtkNotUsed
   pointMerger->InitPointInsertion(outputIntersection->GetPoints(), bounds0);
   impl->PointMerger = pointMerger;
 
-  // This performs the triangle intersection search
-  obbTree0->IntersectWithOBBTree
-    (obbTree1, 0, vtkIntersectionPolyDataFilter::Impl::FindTriangleIntersections,
-     impl);
+  // This performs the triangle intersection search. In parallel, the
+  // overlapping nodes are collected first and their triangles are
+  // intersected afterwards.
+  if ( this->IntersectInParallel )
+    {
+    obbTree0->IntersectWithOBBTree
+      (obbTree1, 0, vtkIntersectionPolyDataFilter::Impl::CollectNodePairs,
+       impl);
+    impl->IntersectNodePairs();
+    }
+  else
+    {
+    obbTree0->IntersectWithOBBTree
+      (obbTree1, 0, vtkIntersectionPolyDataFilter::Impl::FindTriangleIntersections,
+       impl);
+    }
 
   // Split the first output if so desired
   if ( this->SplitFirstOutput )
@@ -55,6 +55,15 @@ public:
   vtkSetMacro(SplitSecondOutput, int);
   vtkBooleanMacro(SplitSecondOutput, int);
 
+  // Description:
+  // If on, the OBB trees of the two inputs are built at the same time, the
+  // triangles of the overlapping tree nodes are intersected in parallel,
+  // and so are the cells split along the intersection lines. The output
+  // is the same as with it off. Defaults to off.
+  vtkGetMacro(IntersectInParallel, int);
+  vtkSetMacro(IntersectInParallel, int);
+  vtkBooleanMacro(IntersectInParallel, int);
+
   // Description:
   // Given two triangles defined by points (p1, q1, r1) and (p2, q2,
   // r2), returns whether the two triangles intersect. If they do,
@@ -78,6 +87,7 @@ private:
 
   int SplitFirstOutput;
   int SplitSecondOutput;
+  int IntersectInParallel;
 
   class Impl;
 };
@@ -36,19 +36,360 @@
 #include "vtkDataArray.h"
 #include "vtkMergePoints.h"
 #include "vtkKdTree.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
+#include <vtksys/hash_map.hxx>
 #include <cstdlib>
+#include <cstring>
 #include <map>
 #include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkMergeCells);
 
 vtkCxxSetObjectMacro(vtkMergeCells, UnstructuredGrid, vtkUnstructuredGrid);
 
+struct vtkMergeCellsIdHash
+{
+  size_t operator()(vtkIdType id) const
+  {
+    return static_cast<size_t>(id);
+  }
+};
+
 class vtkMergeCellsSTLCloak
 {
 public:
-  std::map<vtkIdType, vtkIdType> IdTypeMap;
+  typedef vtksys::hash_map<vtkIdType, vtkIdType, vtkMergeCellsIdHash> MapType;
+  MapType IdTypeMap;
+};
+
+namespace
+{
+void vtkMergeCellsSetNumberOfTuples(vtkFieldData *fd, vtkIdType n)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    fd->GetAbstractArray(i)->SetNumberOfTuples(n);
+    }
+}
+
+bool vtkMergeCellsAreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(i));
+    if (!array || array->GetDataType() == VTK_BIT ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+template <class T>
+struct vtkMergeCellsGatherIds
+{
+  const T *Ids;
+  vtkIdType *Keys;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Keys[i] = static_cast<vtkIdType>(this->Ids[i]);
+      }
+  }
+};
+
+template <class T>
+void vtkMergeCellsGatherIdsTemplate(const T *ids, vtkIdType n,
+                                    vtkIdType *keys)
+{
+  vtkMergeCellsGatherIds<T> gather = { ids, keys };
+  vtkSMPTools::For(0, n, gather);
+}
+
+// Copy n global ids of any integral type to keys
+void vtkMergeCellsGetGlobalIds(vtkDataArray *da, vtkIdType n,
+                               std::vector<vtkIdType> &keys)
+{
+  keys.resize(n);
+  if (n == 0)
+    {
+    return;
+    }
+  switch (da->GetDataType())
+    {
+    vtkTemplateMacro(vtkMergeCellsGatherIdsTemplate(
+      static_cast<VTK_TT*>(da->GetVoidPointer(0)), n, &keys[0]));
+    }
+}
+
+// Passes over the keys sorted with their original index, one run of
+// equal keys being handled by the thread holding its first key. The first
+// pass marks the first occurrences of the keys missing from the map, the
+// second numbers them from the prefix sums of the marks.
+struct vtkMergeCellsJoinRuns
+{
+  const vtkIdType *Sorted;
+  const vtkIdType *Order;
+  vtkIdType NumberOfKeys;
+  const vtkMergeCellsSTLCloak::MapType *Map;
+  vtkIdType *NewMarks;
+  vtkIdType NextId;
+  vtkIdType *Ids;
+  char *IsNew;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      if (i > 0 && this->Sorted[i] == this->Sorted[i - 1])
+        {
+        continue;
+        }
+      vtkIdType first = this->Order[i];
+      vtkMergeCellsSTLCloak::MapType::const_iterator it =
+        this->Map->find(this->Sorted[i]);
+      if (!this->Ids)
+        {
+        this->NewMarks[first] = it == this->Map->end() ? 1 : 0;
+        continue;
+        }
+      vtkIdType id;
+      if (it == this->Map->end())
+        {
+        id = this->NextId + this->NewMarks[first];
+        this->IsNew[first] = 1;
+        }
+      else
+        {
+        id = it->second;
+        }
+      for (vtkIdType j = i;
+           j < this->NumberOfKeys && this->Sorted[j] == this->Sorted[i]; ++j)
+        {
+        this->Ids[this->Order[j]] = id;
+        }
+      }
+  }
+};
+
+struct vtkMergeCellsIota
+{
+  vtkIdType *Values;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Values[i] = i;
+      }
+  }
+};
+
+// Join keys with the ones of map: ids[i] is the id of keys[i] in map, or
+// for a new key a new id numbered from nextId in the order of the first
+// occurrences, which is the numbering of the serial insertions. isNew[i]
+// is 1 for these first occurrences, which are added to map. Returns the
+// number of new keys.
+vtkIdType vtkMergeCellsJoin(const std::vector<vtkIdType> &keys,
+                            vtkMergeCellsSTLCloak::MapType &map,
+                            vtkIdType nextId, vtkIdType *ids, char *isNew)
+{
+  vtkIdType n = static_cast<vtkIdType>(keys.size());
+  memset(isNew, 0, n);
+  if (n == 0)
+    {
+    return 0;
+    }
+  std::vector<vtkIdType> sorted(keys);
+  std::vector<vtkIdType> order(n);
+  vtkMergeCellsIota iota = { &order[0] };
+  vtkSMPTools::For(0, n, iota);
+  vtkSMPTools::RadixSort(&sorted[0], &sorted[0] + n, &order[0]);
+
+  std::vector<vtkIdType> newMarks(n, 0);
+  vtkMergeCellsJoinRuns runs =
+    { &sorted[0], &order[0], n, &map, &newMarks[0], nextId, NULL, isNew };
+  vtkSMPTools::For(0, n, runs);
+  vtkIdType numNew = vtkSMPTools::ExclusiveScan(newMarks.begin(),
+    newMarks.end(), newMarks.begin(), static_cast<vtkIdType>(0));
+  runs.Ids = ids;
+  vtkSMPTools::For(0, n, runs);
+
+  map.resize(map.size() + numNew);
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    if (isNew[i])
+      {
+      map.insert(vtkMergeCellsSTLCloak::MapType::value_type(keys[i], ids[i]));
+      }
+    }
+  return numNew;
+}
+
+// Copy the points of two data sets one after the other
+struct vtkMergeCellsConcatenatePoints
+{
+  vtkPoints *First;
+  vtkIdType NumberOfFirstPoints;
+  vtkDataSet *Second;
+  vtkPoints *Points;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      if (i < this->NumberOfFirstPoints)
+        {
+        this->First->GetPoint(i, x);
+        }
+      else
+        {
+        this->Second->GetPoint(i - this->NumberOfFirstPoints, x);
+        }
+      this->Points->SetPoint(i, x);
+      }
+  }
+};
+
+// Number the points of the second set that are kept by the merge map,
+// from the prefix sums of their marks, and map the others to the point
+// they merge to
+struct vtkMergeCellsNumberMerged
+{
+  const vtkIdType *MergeMap;
+  vtkIdType NumberOfFirstPoints;
+  vtkIdType *Scanned;
+  vtkIdType *IdMap;
+  char *IsNew;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    vtkIdType n0 = this->NumberOfFirstPoints;
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType kept = this->MergeMap[n0 + i];
+      if (!this->IdMap)
+        {
+        this->Scanned[i] = kept == n0 + i ? 1 : 0;
+        continue;
+        }
+      this->IsNew[i] = kept == n0 + i ? 1 : 0;
+      this->IdMap[i] = kept < n0 ? kept : n0 + this->Scanned[kept - n0];
+      }
+  }
+};
+
+// Copy the new points of a data set, and their data when Parallel is set
+struct vtkMergeCellsCopyPoints
+{
+  vtkDataSet *Set;
+  const vtkIdType *IdMap;
+  const char *IsNew;
+  vtkIdType NumberOfPoints;
+  vtkPoints *Points;
+  vtkDataSetAttributes::FieldList *List;
+  vtkPointData *InPD;
+  vtkPointData *OutPD;
+  int Index;
+  bool Parallel;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      if (this->IdMap && !this->IsNew[i])
+        {
+        continue;
+        }
+      vtkIdType newId = this->IdMap ? this->IdMap[i] : this->NumberOfPoints + i;
+      this->Set->GetPoint(i, x);
+      this->Points->SetPoint(newId, x);
+      if (this->Parallel)
+        {
+        this->OutPD->CopyData(*this->List, this->InPD, this->Index, i, newId);
+        }
+      }
+  }
+};
+
+// Size the kept cells of a data set, or with Connectivity set, write them
+// mapped through IdMap at their place in the merged grid
+struct vtkMergeCellsCopyCells
+{
+  vtkDataSet *Set;
+  const char *Kept;
+  const vtkIdType *IdMap;
+  vtkIdType NumberOfPoints;
+  vtkIdType *Sizes;
+  unsigned char *InTypes;
+  // Destination of the cells: Sizes then holds their offsets in the new
+  // connectivity, and CellIndices the ids of the kept cells
+  const vtkIdType *CellIndices;
+  vtkIdType FirstCell;
+  vtkIdType FirstLocation;
+  vtkIdType *Connectivity;
+  vtkIdType *Locations;
+  unsigned char *Types;
+  vtkDataSetAttributes::FieldList *List;
+  vtkCellData *InCD;
+  vtkCellData *OutCD;
+  int Index;
+  bool Parallel;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *ptIds = this->CellPoints.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      if (this->Kept && !this->Kept[cellId])
+        {
+        if (!this->Connectivity)
+          {
+          this->Sizes[cellId] = 0;
+          }
+        continue;
+        }
+      this->Set->GetCellPoints(cellId, ptIds);
+      vtkIdType npts = ptIds->GetNumberOfIds();
+      if (!this->Connectivity)
+        {
+        this->Sizes[cellId] = npts + 1;
+        this->InTypes[cellId] =
+          static_cast<unsigned char>(this->Set->GetCellType(cellId));
+        continue;
+        }
+      vtkIdType newCellId = this->FirstCell +
+        (this->CellIndices ? this->CellIndices[cellId] : cellId);
+      vtkIdType location = this->FirstLocation + this->Sizes[cellId];
+      this->Locations[newCellId] = location;
+      this->Types[newCellId] = this->InTypes[cellId];
+      vtkIdType *cell = this->Connectivity + location;
+      *cell++ = npts;
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        vtkIdType ptId = ptIds->GetId(i);
+        *cell++ = this->IdMap ? this->IdMap[ptId] : this->NumberOfPoints + ptId;
+        }
+      if (this->Parallel)
+        {
+        this->OutCD->CopyData(*this->List, this->InCD, this->Index, cellId,
+                              newCellId);
+        }
+      }
+  }
 };
+}
 
 vtkMergeCells::vtkMergeCells()
 {
@@ -61,6 +402,7 @@ vtkMergeCells::vtkMergeCells()
 
   this->PointMergeTolerance = 10e-4;
   this->MergeDuplicatePoints = 1;
+  this->MergeInParallel = 0;
 
   this->InputIsUGrid = 0;
   this->InputIsPointSet = 0;
@@ -161,6 +503,14 @@ int vtkMergeCells::MergeDataSet(vtkDataSet *set)
     return 0;
     }
 
+  // Polyhedra and their faces are left to the serial merge
+  vtkUnstructuredGrid *setUgrid = vtkUnstructuredGrid::SafeDownCast(set);
+  if (this->MergeInParallel && !ugrid->GetFaces() &&
+      !(setUgrid && setUgrid->GetFaces()))
+    {
+    return this->MergeDataSetInParallel(set);
+    }
+
   if (this->MergeDuplicatePoints)
     {
     if (this->UseGlobalIds)   // faster by far
@@ -230,6 +580,191 @@ int vtkMergeCells::MergeDataSet(vtkDataSet *set)
 
   return 0;
 }
+
+int vtkMergeCells::MergeDataSetInParallel(vtkDataSet *set)
+{
+  vtkUnstructuredGrid *ugrid = this->UnstructuredGrid;
+  vtkPointData *pointArrays = set->GetPointData();
+  vtkIdType numPoints = set->GetNumberOfPoints();
+
+  // Build the lazy structures of the data set before threading
+  double x[3];
+  if (numPoints > 0)
+    {
+    set->GetPoint(0, x);
+    }
+
+  std::vector<char> isNew(numPoints + 1, 1);
+  vtkIdType *idMap = NULL;
+  if (this->MergeDuplicatePoints)
+    {
+    if (this->UseGlobalIds)
+      {
+      idMap = this->MapPointsToIdsUsingGlobalIdsInParallel(set, &isNew[0]);
+      }
+    else
+      {
+      idMap = this->MapPointsToIdsUsingLocatorInParallel(set, &isNew[0]);
+      }
+    }
+  vtkIdType numNewPoints = numPoints;
+  if (idMap)
+    {
+    numNewPoints = static_cast<vtkIdType>(
+      std::count(isNew.begin(), isNew.begin() + numPoints, 1));
+    }
+  vtkIdType nextPt = this->NumberOfPoints + numNewPoints;
+
+  vtkPointData *outPD = ugrid->GetPointData();
+  bool parallelPD = vtkMergeCellsAreArraysThreadSafe(pointArrays) &&
+    vtkMergeCellsAreArraysThreadSafe(outPD);
+  if (parallelPD)
+    {
+    vtkMergeCellsSetNumberOfTuples(outPD, nextPt);
+    }
+
+  vtkPoints *pts = ugrid->GetPoints();
+  vtkMergeCellsCopyPoints copyPoints = { set, idMap, &isNew[0],
+    this->NumberOfPoints, pts, this->ptList, pointArrays, outPD,
+    this->nextGrid, parallelPD };
+  vtkSMPTools::For(0, numPoints, copyPoints);
+  if (!parallelPD)
+    {
+    // The new ids increase with the old ones, as in the serial merge
+    for (vtkIdType oldPtId = 0; oldPtId < numPoints; oldPtId++)
+      {
+      if (isNew[oldPtId])
+        {
+        outPD->CopyData(*this->ptList, pointArrays, this->nextGrid, oldPtId,
+          idMap ? idMap[oldPtId] : this->NumberOfPoints + oldPtId);
+        }
+      }
+    }
+
+  pts->Modified();   // so that subsequent GetBounds will be correct
+
+  vtkIdType numCells = this->AddNewCellsInParallel(set, idMap);
+
+  delete [] idMap;
+
+  this->NumberOfPoints = nextPt;
+  this->NumberOfCells = numCells;
+
+  this->nextGrid++;
+
+  return 0;
+}
+
+vtkIdType vtkMergeCells::AddNewCellsInParallel(vtkDataSet *set,
+                                               vtkIdType *idMap)
+{
+  vtkUnstructuredGrid *ugrid = this->UnstructuredGrid;
+  vtkCellData *cellArrays = set->GetCellData();
+  vtkIdType numCells = set->GetNumberOfCells();
+  vtkIdType numOldCells = ugrid->GetNumberOfCells();
+
+  // Build the lazy structures of the data set before threading
+  vtkNew<vtkIdList> cellPoints;
+  set->GetCellPoints(0, cellPoints.GetPointer());
+  set->GetCellType(0);
+
+  // Skip the cells whose global id was already merged. The ids the join
+  // gives to the new cells are their ranks offset by the size of the map.
+  std::vector<char> kept;
+  std::vector<vtkIdType> cellIds;
+  vtkIdType numNewCells = numCells;
+  vtkIdType firstCell = numOldCells;
+  if (this->GlobalCellIdAccessStart(set))
+    {
+    std::vector<vtkIdType> keys;
+    vtkMergeCellsGetGlobalIds(cellArrays->GetGlobalIds(), numCells, keys);
+    kept.resize(numCells);
+    cellIds.resize(numCells);
+    vtkMergeCellsSTLCloak::MapType &map = this->GlobalCellIdMap->IdTypeMap;
+    vtkIdType nextCellId = static_cast<vtkIdType>(map.size());
+    numNewCells = vtkMergeCellsJoin(keys, map, nextCellId, &cellIds[0],
+                                    &kept[0]);
+    firstCell -= nextCellId;
+    }
+
+  std::vector<vtkIdType> sizes(numCells);
+  std::vector<unsigned char> inTypes(numCells);
+  vtkCellData *outCD = ugrid->GetCellData();
+  bool parallelCD = vtkMergeCellsAreArraysThreadSafe(cellArrays) &&
+    vtkMergeCellsAreArraysThreadSafe(outCD);
+
+  vtkMergeCellsCopyCells copyCells;
+  copyCells.Set = set;
+  copyCells.Kept = kept.empty() ? NULL : &kept[0];
+  copyCells.IdMap = idMap;
+  copyCells.NumberOfPoints = this->NumberOfPoints;
+  copyCells.Sizes = &sizes[0];
+  copyCells.InTypes = &inTypes[0];
+  copyCells.CellIndices = cellIds.empty() ? NULL : &cellIds[0];
+  copyCells.FirstCell = firstCell;
+  copyCells.Connectivity = NULL;
+  copyCells.List = this->cellList;
+  copyCells.InCD = cellArrays;
+  copyCells.OutCD = outCD;
+  copyCells.Index = this->nextGrid;
+  copyCells.Parallel = parallelCD;
+  vtkSMPTools::For(0, numCells, copyCells);
+  vtkIdType newSize = vtkSMPTools::ExclusiveScan(sizes.begin(), sizes.end(),
+    sizes.begin(), static_cast<vtkIdType>(0));
+
+  // Copy the cells merged so far, then append the new ones
+  vtkIdType oldSize = 0;
+  if (numOldCells > 0)
+    {
+    oldSize = ugrid->GetCells()->GetNumberOfConnectivityEntries();
+    }
+  vtkIdType numTotalCells = numOldCells + numNewCells;
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfTuples(oldSize + newSize);
+  vtkNew<vtkIdTypeArray> locations;
+  locations->SetNumberOfTuples(numTotalCells);
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfTuples(numTotalCells);
+  if (numOldCells > 0)
+    {
+    memcpy(connectivity->GetPointer(0),
+           ugrid->GetCells()->GetData()->GetPointer(0),
+           oldSize * sizeof(vtkIdType));
+    memcpy(locations->GetPointer(0),
+           ugrid->GetCellLocationsArray()->GetPointer(0),
+           numOldCells * sizeof(vtkIdType));
+    memcpy(types->GetPointer(0), ugrid->GetCellTypesArray()->GetPointer(0),
+           numOldCells);
+    }
+
+  if (parallelCD)
+    {
+    vtkMergeCellsSetNumberOfTuples(outCD, numTotalCells);
+    }
+  copyCells.FirstLocation = oldSize;
+  copyCells.Connectivity = connectivity->GetPointer(0);
+  copyCells.Locations = locations->GetPointer(0);
+  copyCells.Types = types->GetPointer(0);
+  vtkSMPTools::For(0, numCells, copyCells);
+  if (!parallelCD)
+    {
+    for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+      {
+      if (kept.empty() || kept[cellId])
+        {
+        outCD->CopyData(*this->cellList, cellArrays, this->nextGrid, cellId,
+          firstCell + (cellIds.empty() ? cellId : cellIds[cellId]));
+        }
+      }
+    }
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetCells(numTotalCells, connectivity.GetPointer());
+  ugrid->SetCells(types.GetPointer(), locations.GetPointer(),
+                  cells.GetPointer());
+
+  return numTotalCells;
+}
 vtkIdType vtkMergeCells::AddNewCellsDataSet(vtkDataSet *set, vtkIdType *idMap)
 {
   vtkIdType oldCellId, id, newPtId, newCellId = 0, oldPtId;
@@ -262,10 +797,10 @@ vtkIdType vtkMergeCells::AddNewCellsDataSet(vtkDataSet *set, vtkIdType *idMap)
       {
       vtkIdType globalId = this->GlobalCellIdAccessGetId(oldCellId);
 
-      std::pair<std::map<vtkIdType, vtkIdType>::iterator, bool> inserted =
+      std::pair<vtkMergeCellsSTLCloak::MapType::iterator, bool> inserted =
 
         this->GlobalCellIdMap->IdTypeMap.insert(
-           std::map<vtkIdType, vtkIdType>::value_type(globalId, nextCellId));
+           vtkMergeCellsSTLCloak::MapType::value_type(globalId, nextCellId));
 
       if (inserted.second)
         {
@@ -348,10 +883,10 @@ vtkIdType vtkMergeCells::AddNewCellsUnstructuredGrid(vtkDataSet *set,
         {
         vtkIdType globalId = this->GlobalCellIdAccessGetId(id);
 
-        std::pair<std::map<vtkIdType, vtkIdType>::iterator, bool> inserted =
+        std::pair<vtkMergeCellsSTLCloak::MapType::iterator, bool> inserted =
 
         this->GlobalCellIdMap->IdTypeMap.insert(
-            std::map<vtkIdType, vtkIdType>::value_type(globalId, nextLocalId));
+            vtkMergeCellsSTLCloak::MapType::value_type(globalId, nextLocalId));
 
         if (inserted.second)
           {
@@ -608,10 +1143,10 @@ vtkIdType *vtkMergeCells::MapPointsToIdsUsingGlobalIds(vtkDataSet *set)
     {
     vtkIdType globalId = this->GlobalNodeIdAccessGetId(oldId);
 
-    std::pair<std::map<vtkIdType, vtkIdType>::iterator, bool> inserted =
+    std::pair<vtkMergeCellsSTLCloak::MapType::iterator, bool> inserted =
 
       this->GlobalIdMap->IdTypeMap.insert(
-         std::map<vtkIdType, vtkIdType>::value_type(globalId, nextNewLocalId));
+         vtkMergeCellsSTLCloak::MapType::value_type(globalId, nextNewLocalId));
 
     if (inserted.second)
       {
@@ -632,6 +1167,29 @@ vtkIdType *vtkMergeCells::MapPointsToIdsUsingGlobalIds(vtkDataSet *set)
   return idMap;
 }
 
+// Join the global node ids with the ones merged so far
+
+vtkIdType *vtkMergeCells::MapPointsToIdsUsingGlobalIdsInParallel(
+  vtkDataSet *set, char *isNew)
+{
+  if (!this->GlobalNodeIdAccessStart(set))
+    {
+    vtkErrorMacro("global id array is not available");
+    return NULL;
+    }
+
+  vtkIdType npoints = set->GetNumberOfPoints();
+  std::vector<vtkIdType> keys;
+  vtkMergeCellsGetGlobalIds(set->GetPointData()->GetGlobalIds(), npoints,
+                            keys);
+
+  vtkIdType *idMap = new vtkIdType [npoints];
+  vtkMergeCellsSTLCloak::MapType &map = this->GlobalIdMap->IdTypeMap;
+  vtkMergeCellsJoin(keys, map, static_cast<vtkIdType>(map.size()), idMap,
+                    isNew);
+  return idMap;
+}
+
 // Use a spatial locator to filter out duplicate points and map
 // the new Ids to their Ids in the merged grid.
 
@@ -831,6 +1389,49 @@ vtkIdType *vtkMergeCells::MapPointsToIdsUsingLocator(vtkDataSet *set)
 
   return idMap;
 }
+// Merge the points merged so far and the new ones with a static point
+// locator. The points merged so far come first and are kept, and the new
+// points that are kept are numbered after them in increasing id order.
+
+vtkIdType *vtkMergeCells::MapPointsToIdsUsingLocatorInParallel(
+  vtkDataSet *set, char *isNew)
+{
+  vtkIdType npoints0 = this->NumberOfPoints;
+  vtkIdType npoints1 = set->GetNumberOfPoints();
+  vtkIdType npoints = npoints0 + npoints1;
+  if (npoints1 == 0)
+    {
+    return NULL;
+    }
+
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(npoints);
+  vtkMergeCellsConcatenatePoints concatenate =
+    { this->UnstructuredGrid->GetPoints(), npoints0, set,
+      points.GetPointer() };
+  vtkSMPTools::For(0, npoints, concatenate);
+
+  vtkNew<vtkPolyData> pd;
+  pd->SetPoints(points.GetPointer());
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(pd.GetPointer());
+  locator->BuildLocator();
+  std::vector<vtkIdType> mergeMap(npoints);
+  locator->MergePoints(this->PointMergeTolerance, &mergeMap[0]);
+
+  std::vector<vtkIdType> scanned(npoints1);
+  vtkIdType *idMap = new vtkIdType [npoints1];
+  vtkMergeCellsNumberMerged number =
+    { &mergeMap[0], npoints0, &scanned[0], NULL, isNew };
+  vtkSMPTools::For(0, npoints1, number);
+  vtkSMPTools::ExclusiveScan(scanned.begin(), scanned.end(), scanned.begin(),
+                             static_cast<vtkIdType>(0));
+  number.IdMap = idMap;
+  vtkSMPTools::For(0, npoints1, number);
+  return idMap;
+}
+
 //-------------------------------------------------------------------------
 // Help with the complex business of efficient access to the node ID arrays.
 // The array was given to us by the user, and we don't know the data type or
@@ -917,6 +1518,7 @@ void vtkMergeCells::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "PointMergeTolerance: " << this->PointMergeTolerance << endl;
   os << indent << "MergeDuplicatePoints: " << this->MergeDuplicatePoints << endl;
+  os << indent << "MergeInParallel: " << this->MergeInParallel << endl;
   os << indent << "InputIsUGrid: " << this->InputIsUGrid << endl;
   os << indent << "InputIsPointSet: " << this->InputIsPointSet << endl;
   os << indent << "UnstructuredGrid: " << this->UnstructuredGrid << endl;
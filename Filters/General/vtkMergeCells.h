@@ -126,6 +126,18 @@ public:
   vtkSetMacro(TotalNumberOfDataSets, int);
   vtkGetMacro(TotalNumberOfDataSets, int);
 
+  // Description:
+  //    When on, each DataSet is merged in parallel (via vtkSMPTools).
+  //    Global point and cell ids are joined with the ones seen so far by
+  //    sorting them, and without global point ids the points are merged
+  //    with a vtkStaticPointLocator.  The cells are then renumbered and
+  //    appended in parallel.  With global ids, or with a zero tolerance,
+  //    the result is the same as the serial one.  Off by default.
+
+  vtkSetMacro(MergeInParallel, int);
+  vtkGetMacro(MergeInParallel, int);
+  vtkBooleanMacro(MergeInParallel, int);
+
   // Description:
   //    Provide a DataSet to be merged in to the final UnstructuredGrid.
   //    This call returns after the merge has completed.  Be sure to call
@@ -155,6 +167,13 @@ private:
   vtkIdType AddNewCellsUnstructuredGrid(vtkDataSet *set, vtkIdType *idMap);
   vtkIdType AddNewCellsDataSet(vtkDataSet *set, vtkIdType *idMap);
 
+  int MergeDataSetInParallel(vtkDataSet *set);
+  vtkIdType *MapPointsToIdsUsingGlobalIdsInParallel(vtkDataSet *set,
+                                                    char *isNew);
+  vtkIdType *MapPointsToIdsUsingLocatorInParallel(vtkDataSet *set,
+                                                  char *isNew);
+  vtkIdType AddNewCellsInParallel(vtkDataSet *set, vtkIdType *idMap);
+
   vtkIdType GlobalCellIdAccessGetId(vtkIdType idx);
   int GlobalCellIdAccessStart(vtkDataSet *set);
   vtkIdType GlobalNodeIdAccessGetId(vtkIdType idx);
@@ -178,6 +197,7 @@ private:
 
   float PointMergeTolerance;
   int MergeDuplicatePoints;
+  int MergeInParallel;
 
   char InputIsUGrid;
   char InputIsPointSet;
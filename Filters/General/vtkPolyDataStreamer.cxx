@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkPolyDataStreamer.h"
 
+#include "vtkAbstractArray.h"
 #include "vtkAppendPolyData.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
@@ -23,8 +24,49 @@
 #include "vtkPolyData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <cmath>
+
 vtkStandardNewMacro(vtkPolyDataStreamer);
 
+// Upper bound on the number of passes chosen to fit the memory limit.
+static const unsigned int VTK_MAXIMUM_NUMBER_OF_PASSES = 1 << 16;
+
+//----------------------------------------------------------------------------
+// Size, in kibibytes, of the arrays described in the point and cell data
+// vectors of info, for those that advertise their number of tuples.
+static double vtkPolyDataStreamerAdvertisedSize(vtkInformation *info)
+{
+  vtkInformationVector *fieldVectors[2] =
+    { info->Get(vtkDataObject::POINT_DATA_VECTOR()),
+      info->Get(vtkDataObject::CELL_DATA_VECTOR()) };
+  double size = 0.0;
+  for (int i = 0; i < 2; ++i)
+    {
+    vtkInformationVector *fields = fieldVectors[i];
+    int numFields = fields ? fields->GetNumberOfInformationObjects() : 0;
+    for (int j = 0; j < numFields; ++j)
+      {
+      vtkInformation *field = fields->GetInformationObject(j);
+      if (!field->Has(vtkDataObject::FIELD_NUMBER_OF_TUPLES()) ||
+          !field->Has(vtkDataObject::FIELD_ARRAY_TYPE()))
+        {
+        continue;
+        }
+      int numComponents = 1;
+      if (field->Has(vtkDataObject::FIELD_NUMBER_OF_COMPONENTS()))
+        {
+        numComponents =
+          field->Get(vtkDataObject::FIELD_NUMBER_OF_COMPONENTS());
+        }
+      size += static_cast<double>(
+        field->Get(vtkDataObject::FIELD_NUMBER_OF_TUPLES())) *
+        numComponents * vtkAbstractArray::GetDataTypeSize(
+          field->Get(vtkDataObject::FIELD_ARRAY_TYPE()));
+      }
+    }
+  return size / 1024.0;
+}
+
 //----------------------------------------------------------------------------
 vtkPolyDataStreamer::vtkPolyDataStreamer()
 {
@@ -33,6 +75,10 @@ vtkPolyDataStreamer::vtkPolyDataStreamer()
 
   this->NumberOfPasses = 2;
   this->ColorByPiece = 0;
+  this->MemoryLimit = 0;
+  this->EstimatedSize = 0;
+  this->MaximumPieceSize = 0;
+  this->RefinedPieceSize = 0;
 
   this->Append = vtkAppendPolyData::New();
 }
@@ -71,6 +117,14 @@ int vtkPolyDataStreamer::RequestUpdateExtent(
   int outNumPieces = outInfo->Get(
     vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
 
+  // Choose the number of passes when a new update starts. Once streaming
+  // restarted with more passes, keep them.
+  if (this->MemoryLimit > 0 && this->CurrentIndex == 0 &&
+      this->RefinedPieceSize == 0)
+    {
+    this->NumberOfPasses = this->EstimateNumberOfPasses(inInfo, outInfo);
+    }
+
   inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
               outPiece * this->NumberOfPasses + this->CurrentIndex);
   inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
@@ -91,6 +145,37 @@ int vtkPolyDataStreamer::ExecutePass(
   vtkPolyData *input = vtkPolyData::SafeDownCast(
     inInfo->Get(vtkDataObject::DATA_OBJECT()));
 
+  // When the piece does not fit in the memory limit, start again with
+  // smaller pieces, unless the previous refinement did not make the pieces
+  // noticeably smaller (the input may not be able to split its data).
+  if (this->MemoryLimit > 0)
+    {
+    unsigned long size = input->GetActualMemorySize();
+    if (size > this->MemoryLimit &&
+        this->NumberOfPasses < VTK_MAXIMUM_NUMBER_OF_PASSES &&
+        (this->RefinedPieceSize == 0 || size < 0.8 * this->RefinedPieceSize))
+      {
+      double factor = ceil(static_cast<double>(size) / this->MemoryLimit);
+      double passes = this->NumberOfPasses * (factor > 2.0 ? factor : 2.0);
+      unsigned int numPasses = VTK_MAXIMUM_NUMBER_OF_PASSES;
+      if (passes < VTK_MAXIMUM_NUMBER_OF_PASSES)
+        {
+        numPasses = static_cast<unsigned int>(passes);
+        }
+      vtkDebugMacro("Piece of " << size << " KiB exceeds the memory limit, "
+                    "streaming again in " << numPasses << " passes");
+      this->RefinedPieceSize = size;
+      this->MaximumPieceSize = 0;
+      this->Append->RemoveAllInputConnections(0);
+      this->RestartStreaming(numPasses);
+      return 1;
+      }
+    if (size > this->MaximumPieceSize)
+      {
+      this->MaximumPieceSize = size;
+      }
+    }
+
   vtkPolyData *copy  = vtkPolyData::New();
   copy->ShallowCopy(input);
   this->Append->AddInputData(copy);
@@ -132,9 +217,49 @@ int vtkPolyDataStreamer::PostExecute(
   this->Append->RemoveAllInputConnections(0);
   this->Append->GetOutput()->Initialize();
 
+  // Remember the size of the data for the next update.
+  if (this->MemoryLimit > 0)
+    {
+    this->EstimatedSize = this->MaximumPieceSize * this->NumberOfPasses;
+    }
+  this->MaximumPieceSize = 0;
+  this->RefinedPieceSize = 0;
   return 1;
 }
 
+//----------------------------------------------------------------------------
+unsigned int vtkPolyDataStreamer::EstimateNumberOfPasses(
+  vtkInformation *inInfo, vtkInformation *outInfo)
+{
+  double size = this->EstimatedSize;
+  if (size == 0.0)
+    {
+    // The advertised sizes are those of the whole data set, of which the
+    // requested output piece is a fraction.
+    int outNumPieces = outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    size = vtkPolyDataStreamerAdvertisedSize(inInfo) /
+      (outNumPieces > 1 ? outNumPieces : 1);
+    }
+  if (size == 0.0)
+    {
+    // Nothing known yet: start from the current number of passes and
+    // refine while streaming.
+    return this->NumberOfPasses;
+    }
+
+  double numPasses = ceil(size / this->MemoryLimit);
+  if (numPasses < 1.0)
+    {
+    return 1;
+    }
+  if (numPasses > VTK_MAXIMUM_NUMBER_OF_PASSES)
+    {
+    return VTK_MAXIMUM_NUMBER_OF_PASSES;
+    }
+  return static_cast<unsigned int>(numPasses);
+}
+
 //----------------------------------------------------------------------------
 void vtkPolyDataStreamer::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -142,6 +267,7 @@ void vtkPolyDataStreamer::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "NumberOfStreamDivisions: " << this->NumberOfPasses << endl;
   os << indent << "ColorByPiece: " << this->ColorByPiece << endl;
+  os << indent << "MemoryLimit: " << this->MemoryLimit << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -21,6 +21,12 @@
 // these do not fit in the memory, it is possible to make the vtkPolyDataMapper
 // stream. Since the mapper will render each piece separately, all the
 // polygons do not have to stored in memory.
+//
+// Instead of a fixed number of stream divisions, a memory limit can be
+// given. The number of divisions is then estimated from the size of the
+// data the input advertises in its information (as the XML readers do)
+// or measured during the previous update, and it is increased while
+// streaming whenever a piece turns out to be larger than the limit.
 // .SECTION Note
 // The output may be slightly different if the pipeline does not handle
 // ghost cells properly (i.e. you might see seames between the pieces).
@@ -51,6 +57,15 @@ public:
     return this->NumberOfPasses;
   }
 
+  // Description:
+  // Set / Get the memory limit, in kibibytes (1024 bytes), of each input
+  // piece. When it is 0 (the default) the number of stream divisions is
+  // used as is. Otherwise the number of stream divisions is chosen so that
+  // each piece fits in the limit, and only serves as the initial guess
+  // when nothing is known about the size of the input.
+  vtkSetMacro(MemoryLimit, unsigned long);
+  vtkGetMacro(MemoryLimit, unsigned long);
+
   // Description:
   // By default, this option is off.  When it is on, cell scalars are generated
   // based on which piece they are in.
@@ -75,7 +90,22 @@ protected:
   virtual int PostExecute(vtkInformationVector **inputVector,
                           vtkInformationVector *outputVector);
 
+  // Description:
+  // Return the number of passes needed to stream the input within the
+  // memory limit, from the size measured during the previous update or
+  // advertised by the input.
+  unsigned int EstimateNumberOfPasses(vtkInformation *inInfo,
+                                      vtkInformation *outInfo);
+
   int ColorByPiece;
+  unsigned long MemoryLimit;
+
+  // Sizes in kibibytes of the whole output piece estimated after the
+  // previous update, of the largest piece of the current update and of
+  // the piece that caused the current update to be restarted.
+  unsigned long EstimatedSize;
+  unsigned long MaximumPieceSize;
+  unsigned long RefinedPieceSize;
 private:
   vtkPolyDataStreamer(const vtkPolyDataStreamer&);  // Not implemented.
   void operator=(const vtkPolyDataStreamer&);  // Not implemented.
@@ -25,6 +25,7 @@
 #include "vtkPointData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkStructuredGrid.h"
+#include "vtkStructuredPointArray.h"
 
 #include "vtkNew.h"
 
@@ -33,6 +34,7 @@ vtkStandardNewMacro(vtkRectilinearGridToPointSet);
 //-------------------------------------------------------------------------
 vtkRectilinearGridToPointSet::vtkRectilinearGridToPointSet()
 {
+  this->ImplicitPoints = 1;
 }
 
 vtkRectilinearGridToPointSet::~vtkRectilinearGridToPointSet()
@@ -42,6 +44,8 @@ vtkRectilinearGridToPointSet::~vtkRectilinearGridToPointSet()
 void vtkRectilinearGridToPointSet::PrintSelf(ostream &os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ImplicitPoints: " << this->ImplicitPoints << endl;
 }
 
 //-------------------------------------------------------------------------
@@ -70,6 +74,21 @@ int vtkRectilinearGridToPointSet::CopyStructure(vtkStructuredGrid *outData,
   outData->SetExtent(extent);
 
   vtkNew<vtkPoints> points;
+  if (this->ImplicitPoints)
+    {
+    // The coordinates are computed on access from the axes of the grid.
+    vtkNew<vtkStructuredPointArray<double> > coords;
+    coords->SetAxes(xcoord, ycoord, zcoord);
+    if (coords->GetNumberOfTuples() != inData->GetNumberOfPoints())
+      {
+      vtkErrorMacro(<< "Coordinates do not match the extent");
+      return 0;
+      }
+    points->SetData(coords.GetPointer());
+    outData->SetPoints(points.GetPointer());
+    return 1;
+    }
+
   points->SetDataTypeToDouble();
   points->SetNumberOfPoints(inData->GetNumberOfPoints());
 
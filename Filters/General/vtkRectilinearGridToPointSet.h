@@ -45,6 +45,16 @@ public:
 
   static vtkRectilinearGridToPointSet *New();
 
+  // Description:
+  // When on, which is the default, the points of the output are held by a
+  // vtkStructuredPointArray, which computes the coordinates on access from
+  // the axes of the input instead of storing them. Turn it off to output
+  // an explicit array of double coordinates, for downstream code that uses
+  // raw pointers to the points.
+  vtkSetMacro(ImplicitPoints, int);
+  vtkGetMacro(ImplicitPoints, int);
+  vtkBooleanMacro(ImplicitPoints, int);
+
 protected:
   vtkRectilinearGridToPointSet();
   ~vtkRectilinearGridToPointSet();
@@ -55,6 +65,8 @@ protected:
 
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  int ImplicitPoints;
+
 private:
   vtkRectilinearGridToPointSet(const vtkRectilinearGridToPointSet &); // Not implemented
   void operator=(const vtkRectilinearGridToPointSet &);         // Not implemented
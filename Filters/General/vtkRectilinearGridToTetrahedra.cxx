@@ -25,6 +25,7 @@
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkStructuredPointArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkVoxel.h"
 
@@ -216,7 +217,6 @@ void vtkRectilinearGridToTetrahedra::GridToTetMesh(vtkRectilinearGrid *RectGrid,
   switch (tetraPerCell)
     {
     case (VTK_VOXEL_TO_5_TET):
-      NodePoints->Allocate(numPts);
       TetList->Allocate(numPts*5*5,numPts);
     break;
     case (VTK_VOXEL_TO_5_AND_12_TET):
@@ -226,10 +226,25 @@ void vtkRectilinearGridToTetrahedra::GridToTetMesh(vtkRectilinearGrid *RectGrid,
     break;
     }
 
-  // Start by copying over the points
-  for(i=0;i<numPts;i++)
+  if (tetraPerCell == VTK_VOXEL_TO_5_TET || tetraPerCell == VTK_VOXEL_TO_6_TET)
     {
-    NodePoints->InsertNextPoint(RectGrid->GetPoint(i));
+    // No center point is added: the points are the points of the grid,
+    // computed on access from its coordinates.
+    vtkStructuredPointArray<float> *GridPoints =
+      vtkStructuredPointArray<float>::New();
+    GridPoints->SetAxes(RectGrid->GetXCoordinates(),
+                        RectGrid->GetYCoordinates(),
+                        RectGrid->GetZCoordinates());
+    NodePoints->SetData(GridPoints);
+    GridPoints->Delete();
+    }
+  else
+    {
+    // Start by copying over the points
+    for(i=0;i<numPts;i++)
+      {
+      NodePoints->InsertNextPoint(RectGrid->GetPoint(i));
+      }
     }
 
   // If they want, we can add Scalar Data
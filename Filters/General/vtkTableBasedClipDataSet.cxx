@@ -57,9 +57,20 @@
 #include "vtkRectilinearGrid.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 
 #include "vtkTableBasedClipCases.h"
 
+#include <algorithm>
+#include <vector>
+
+// The unstructured grids with at least this many cells are clipped in
+// parallel.
+#define VTK_TABLE_BASED_CLIP_PARALLEL_CELLS 10000
+
 vtkStandardNewMacro( vtkTableBasedClipDataSet );
 vtkCxxSetObjectMacro( vtkTableBasedClipDataSet, ClipFunction, vtkImplicitFunction );
 
@@ -87,6 +98,8 @@ public:
   int      GetTotalNumberOfPoints() const;
   int      GetNumberOfLists() const;
   int      GetList( int, const TableBasedClipperPointEntry *& ) const;
+  const TableBasedClipperPointEntry & GetPoint( int idx ) const
+           { return list[ idx / pointsPerList ][ idx % pointsPerList ]; }
 
 protected:
   int      currentList;
@@ -611,6 +624,22 @@ class  vtkTableBasedClipperVolumeFromVolume :
                                 vtkUnstructuredGrid *, int *, double *,
                                 double *, double * );
 
+    // Merge the volumes built by several threads from the same input point
+    // set into one output. Points shared by the volumes, input points or
+    // points on the same edge, are output once.
+    static void ConstructDataSet
+                ( std::vector< vtkTableBasedClipperVolumeFromVolume * > &,
+                  vtkDataSet *, vtkUnstructuredGrid *, double * );
+
+    int      GetNumberOfPrevPoints() const { return numPrevPts; }
+    int      GetNumberOfShapeLists() const { return nshapes; }
+    const vtkTableBasedClipperShapeList * GetShapeList( int i ) const
+             { return shapes[i]; }
+    const vtkTableBasedClipperPointList & GetPointList() const
+             { return pt_list; }
+    const vtkTableBasedClipperCentroidPointList & GetCentroidList() const
+             { return centroid_list; }
+
     int      AddCentroidPoint( int n, int * p )
              { return -1 - centroid_list.AddPoint( n, p ); }
 
@@ -651,6 +680,7 @@ class  vtkTableBasedClipperVolumeFromVolume :
     void         ConstructDataSet
                  ( vtkDataSet *, vtkUnstructuredGrid *,
                    TableBasedClipperCommonPointsStructure & );
+    void         SetOutputPointsDataType( vtkPoints *, vtkDataSet * );
 };
 
 
@@ -1288,26 +1318,7 @@ void vtkTableBasedClipperVolumeFromVolume::
   vtkPoints * outPts = vtkPoints::New();
 
   // set precision for the points in the output
-  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
-    {
-    vtkPointSet *inputPointSet = vtkPointSet::SafeDownCast(input);
-    if(inputPointSet)
-      {
-      outPts->SetDataType(inputPointSet->GetPoints()->GetDataType());
-      }
-    else
-      {
-      outPts->SetDataType(VTK_FLOAT);
-      }
-    }
-  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-    {
-    outPts->SetDataType(VTK_FLOAT);
-    }
-  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
-    {
-    outPts->SetDataType(VTK_DOUBLE);
-    }
+  this->SetOutputPointsDataType( outPts, input );
 
   int centroidStart  = numUsed + pt_list.GetTotalNumberOfPoints();
   int nOutPts        = centroidStart + centroid_list.GetTotalNumberOfPoints();
@@ -1582,6 +1593,523 @@ void vtkTableBasedClipperVolumeFromVolume::
   delete [] ptLookup;
 }
 
+// ---- parallel merge of the volumes built by several threads (begin)
+void vtkTableBasedClipperVolumeFromVolume::SetOutputPointsDataType
+  ( vtkPoints * outPts, vtkDataSet * input )
+{
+  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+    {
+    vtkPointSet *inputPointSet = vtkPointSet::SafeDownCast(input);
+    if(inputPointSet)
+      {
+      outPts->SetDataType(inputPointSet->GetPoints()->GetDataType());
+      }
+    else
+      {
+      outPts->SetDataType(VTK_FLOAT);
+      }
+    }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+    {
+    outPts->SetDataType(VTK_FLOAT);
+    }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+    {
+    outPts->SetDataType(VTK_DOUBLE);
+    }
+}
+
+namespace
+{
+// An edge point of one of the volumes, keyed by its edge.
+struct TableBasedClipperEdgeRef
+{
+  vtkTypeUInt64 Key;
+  int           Volume;
+  int           Local;
+};
+
+typedef std::vector< vtkTableBasedClipperVolumeFromVolume * >
+        TableBasedClipperVolumes;
+
+// The state shared by the passes of the merge. An id of volume v, as stored
+// in its shape and centroid lists, maps to an output point id with MapId().
+struct TableBasedClipperMergeState
+{
+  int                          NumPrevPts;
+  vtkIdType                    CentroidStart;
+  std::vector< vtkIdType >     PtLookup;        // input point -> output
+  std::vector< vtkIdType >     CentroidOffsets; // per volume
+  std::vector< std::vector< vtkIdType > > EdgeMaps; // per volume
+  std::vector< TableBasedClipperEdgeRef > Edges; // sorted by key
+  std::vector< vtkIdType >     UniqueEdges;     // output edge -> Edges
+
+  vtkIdType MapId( int v, int id ) const
+    {
+    if ( id < 0 )
+      {
+      return this->CentroidStart + this->CentroidOffsets[v] - 1 - id;
+      }
+    if ( id >= this->NumPrevPts )
+      {
+      return this->EdgeMaps[v][ id - this->NumPrevPts ];
+      }
+    return this->PtLookup[id];
+    }
+};
+
+// Functors of the parallel merge. Each writes distinct, presized points,
+// tuples and cells of the output.
+
+// Collect the edge points of the volumes with their keys.
+struct TableBasedClipperGatherEdges
+{
+  const TableBasedClipperVolumes    & Volumes;
+  const std::vector< vtkIdType >    & Offsets;
+  TableBasedClipperMergeState       & State;
+
+  void operator()( vtkIdType v, vtkIdType endV ) const
+    {
+    vtkTypeUInt64 numPrevPts = this->State.NumPrevPts;
+    for ( ; v < endV; v ++ )
+      {
+      const vtkTableBasedClipperPointList & ptList = this->Volumes[v]->GetPointList();
+      TableBasedClipperEdgeRef * ref = &this->State.Edges[ this->Offsets[v] ];
+      int nLists = ptList.GetNumberOfLists();
+      int local  = 0;
+      for ( int l = 0; l < nLists; l ++ )
+        {
+        const TableBasedClipperPointEntry * pe_list = NULL;
+        int nPts = ptList.GetList( l, pe_list );
+        for ( int j = 0; j < nPts; j ++, local ++, ref ++ )
+          {
+          ref->Key    = pe_list[j].ptIds[0] * numPrevPts + pe_list[j].ptIds[1];
+          ref->Volume = static_cast< int >( v );
+          ref->Local  = local;
+          }
+        }
+      }
+    }
+};
+
+// Give the sorted edge points their output ids; equal edges share one.
+struct TableBasedClipperNumberEdges
+{
+  TableBasedClipperMergeState & State;
+  const std::vector< vtkIdType > & EdgeIds;
+  vtkIdType NumUsed;
+
+  void operator()( vtkIdType e, vtkIdType endE ) const
+    {
+    for ( ; e < endE; e ++ )
+      {
+      const TableBasedClipperEdgeRef & ref = this->State.Edges[e];
+      vtkIdType edgeId = this->EdgeIds[e];
+      this->State.EdgeMaps[ ref.Volume ][ ref.Local ] = this->NumUsed + edgeId;
+      if ( e == 0 || this->State.Edges[ e - 1 ].Key != ref.Key )
+        {
+        this->State.UniqueEdges[ edgeId ] = e;
+        }
+      }
+    }
+};
+
+// Copy the input points used by the output.
+struct TableBasedClipperCopyPoints
+{
+  const TableBasedClipperMergeState & State;
+  const std::vector< unsigned char > & Used;
+  const double * Points;
+  vtkPoints    * OutPts;
+  vtkPointData * InPD;
+  vtkPointData * OutPD;
+  vtkIntArray  * OrigNodes;
+  vtkIntArray  * NewOrigNodes;
+
+  void operator()( vtkIdType i, vtkIdType end ) const
+    {
+    for ( ; i < end; i ++ )
+      {
+      if ( !this->Used[i] )
+        {
+        continue;
+        }
+      vtkIdType ptId = this->State.PtLookup[i];
+      this->OutPts->SetPoint( ptId, this->Points + 3 * i );
+      this->OutPD->CopyData( this->InPD, i, ptId );
+      if ( this->NewOrigNodes )
+        {
+        int nc = this->OrigNodes->GetNumberOfComponents();
+        for ( int c = 0; c < nc; c ++ )
+          {
+          this->NewOrigNodes->SetValue
+            ( ptId * nc + c, this->OrigNodes->GetValue( i * nc + c ) );
+          }
+        }
+      }
+    }
+};
+
+// Interpolate the points along the edges.
+struct TableBasedClipperInterpolateEdges
+{
+  const TableBasedClipperVolumes    & Volumes;
+  const TableBasedClipperMergeState & State;
+  vtkIdType      NumUsed;
+  const double * Points;
+  vtkPoints    * OutPts;
+  vtkPointData * InPD;
+  vtkPointData * OutPD;
+  vtkIntArray  * OrigNodes;
+  vtkIntArray  * NewOrigNodes;
+
+  void operator()( vtkIdType e, vtkIdType endE ) const
+    {
+    for ( ; e < endE; e ++ )
+      {
+      const TableBasedClipperEdgeRef & ref =
+        this->State.Edges[ this->State.UniqueEdges[e] ];
+      const TableBasedClipperPointEntry & pe =
+        this->Volumes[ ref.Volume ]->GetPointList().GetPoint( ref.Local );
+      const double * pt1 = this->Points + 3 * pe.ptIds[0];
+      const double * pt2 = this->Points + 3 * pe.ptIds[1];
+      double p  = pe.percent;
+      double bp = 1.0 - p;
+      double pt[3];
+      pt[0] = pt1[0] * p + pt2[0] * bp;
+      pt[1] = pt1[1] * p + pt2[1] * bp;
+      pt[2] = pt1[2] * p + pt2[2] * bp;
+
+      vtkIdType ptIdx = this->NumUsed + e;
+      this->OutPts->SetPoint( ptIdx, pt );
+      this->OutPD->InterpolateEdge
+        ( this->InPD, ptIdx, pe.ptIds[0], pe.ptIds[1], bp );
+      if ( this->NewOrigNodes )
+        {
+        int nc = this->OrigNodes->GetNumberOfComponents();
+        vtkIdType id = ( bp <= 0.5 ? pe.ptIds[0] : pe.ptIds[1] );
+        for ( int c = 0; c < nc; c ++ )
+          {
+          this->NewOrigNodes->SetValue
+            ( ptIdx * nc + c, this->OrigNodes->GetValue( id * nc + c ) );
+          }
+        }
+      }
+    }
+};
+
+// Compute the centroid points. Centroids may depend on earlier centroids
+// of the same volume, so each volume is processed in order.
+struct TableBasedClipperInterpolateCentroids
+{
+  const TableBasedClipperVolumes    & Volumes;
+  const TableBasedClipperMergeState & State;
+  vtkPoints    * OutPts;
+  vtkPointData * OutPD;
+  vtkIntArray  * NewOrigNodes;
+
+  void operator()( vtkIdType v, vtkIdType endV ) const
+    {
+    vtkIdList * idList = vtkIdList::New();
+    for ( ; v < endV; v ++ )
+      {
+      const vtkTableBasedClipperCentroidPointList & centroids =
+        this->Volumes[v]->GetCentroidList();
+      vtkIdType ptIdx = this->State.CentroidStart +
+                        this->State.CentroidOffsets[v];
+      int nLists = centroids.GetNumberOfLists();
+      for ( int l = 0; l < nLists; l ++ )
+        {
+        const TableBasedClipperCentroidPointEntry * ce_list = NULL;
+        int nPts = centroids.GetList( l, ce_list );
+        for ( int j = 0; j < nPts; j ++, ptIdx ++ )
+          {
+          const TableBasedClipperCentroidPointEntry & ce = ce_list[j];
+          idList->SetNumberOfIds( ce.nPts );
+          double weights[8];
+          double pt[3] = { 0.0, 0.0, 0.0 };
+          double weight_factor = 1.0 / ce.nPts;
+          for ( int k = 0; k < ce.nPts; k ++ )
+            {
+            double x[3];
+            vtkIdType id = this->State.MapId
+                           ( static_cast< int >( v ), ce.ptIds[k] );
+            weights[k] = weight_factor;
+            idList->SetId( k, id );
+            this->OutPts->GetPoint( id, x );
+            pt[0] += x[0];
+            pt[1] += x[1];
+            pt[2] += x[2];
+            }
+          pt[0] *= weight_factor;
+          pt[1] *= weight_factor;
+          pt[2] *= weight_factor;
+
+          this->OutPts->SetPoint( ptIdx, pt );
+          this->OutPD->InterpolatePoint( this->OutPD, ptIdx, idList, weights );
+          if ( this->NewOrigNodes )
+            {
+            // these 'created' nodes have no original designation
+            int nc = this->NewOrigNodes->GetNumberOfComponents();
+            for ( int c = 0; c < nc; c ++ )
+              {
+              this->NewOrigNodes->SetValue( ptIdx * nc + c, -1 );
+              }
+            }
+          }
+        }
+      }
+    idList->Delete();
+    }
+};
+
+// Write the cells of each volume at their offsets, shape by shape.
+struct TableBasedClipperCopyCells
+{
+  const TableBasedClipperVolumes    & Volumes;
+  const TableBasedClipperMergeState & State;
+  const std::vector< vtkIdType >    & CellOffsets; // [shape][volume]
+  const std::vector< vtkIdType >    & ConnOffsets; // [shape][volume]
+  vtkIdType     * Conn;
+  vtkIdType     * Locations;
+  unsigned char * Types;
+  vtkCellData   * InCD;
+  vtkCellData   * OutCD;
+
+  void operator()( vtkIdType v, vtkIdType endV ) const
+    {
+    size_t numVolumes = this->Volumes.size();
+    for ( ; v < endV; v ++ )
+      {
+      vtkTableBasedClipperVolumeFromVolume * vfv = this->Volumes[v];
+      for ( int i = 0; i < vfv->GetNumberOfShapeLists(); i ++ )
+        {
+        const vtkTableBasedClipperShapeList * shapes = vfv->GetShapeList( i );
+        int shapesize = shapes->GetShapeSize();
+        unsigned char vtk_type =
+          static_cast< unsigned char >( shapes->GetVTKType() );
+        vtkIdType cellId = this->CellOffsets[ i * numVolumes + v ];
+        vtkIdType loc    = this->ConnOffsets[ i * numVolumes + v ];
+        vtkIdType * nl   = this->Conn + loc;
+        int nlists = shapes->GetNumberOfLists();
+        for ( int j = 0; j < nlists; j ++ )
+          {
+          const int * list;
+          int listSize = shapes->GetList( j, list );
+          for ( int k = 0; k < listSize; k ++ )
+            {
+            this->OutCD->CopyData( this->InCD, list[0], cellId );
+            this->Locations[ cellId ] = loc;
+            this->Types[ cellId ] = vtk_type;
+            *nl ++ = shapesize;
+            for ( int l = 0; l < shapesize; l ++ )
+              {
+              *nl ++ = this->State.MapId
+                       ( static_cast< int >( v ), list[ l + 1 ] );
+              }
+            list += shapesize + 1;
+            loc  += shapesize + 1;
+            cellId ++;
+            }
+          }
+        }
+      }
+    }
+};
+}
+
+void vtkTableBasedClipperVolumeFromVolume::ConstructDataSet
+  ( std::vector< vtkTableBasedClipperVolumeFromVolume * > & volumes,
+    vtkDataSet * input, vtkUnstructuredGrid * output, double * pts_ptr )
+{
+  vtkIdType numVolumes = static_cast< vtkIdType >( volumes.size() );
+  if ( numVolumes == 0 )
+    {
+    return;
+    }
+  int numPrevPts = volumes[0]->GetNumberOfPrevPoints();
+  int nshapes    = volumes[0]->GetNumberOfShapeLists();
+
+  vtkPointData * inPD  = input->GetPointData();
+  vtkCellData  * inCD  = input->GetCellData();
+  vtkPointData * outPD = output->GetPointData();
+  vtkCellData  * outCD = output->GetCellData();
+
+  TableBasedClipperMergeState state;
+  state.NumPrevPts = numPrevPts;
+
+  //
+  // Number the input points used by the output in the order of the input.
+  //
+  std::vector< unsigned char > used( numPrevPts, 0 );
+  for ( vtkIdType v = 0; v < numVolumes; v ++ )
+    {
+    for ( int i = 0; i < nshapes; i ++ )
+      {
+      const vtkTableBasedClipperShapeList * shapes = volumes[v]->GetShapeList( i );
+      int nlists = shapes->GetNumberOfLists();
+      int npts_per_shape = shapes->GetShapeSize();
+      for ( int j = 0; j < nlists; j ++ )
+        {
+        const int * list;
+        int listSize = shapes->GetList( j, list );
+        for ( int k = 0; k < listSize; k ++ )
+          {
+          list ++; // skip the cell id entry
+          for ( int l = 0; l < npts_per_shape; l ++, list ++ )
+            {
+            if ( *list >= 0 && *list < numPrevPts )
+              {
+              used[ *list ] = 1;
+              }
+            }
+          }
+        }
+      }
+    }
+  state.PtLookup.resize( numPrevPts );
+  vtkIdType numUsed = vtkSMPTools::ExclusiveScan
+    ( used.begin(), used.end(), state.PtLookup.begin(), vtkIdType( 0 ) );
+
+  //
+  // Merge the edge points: sort them by edge, then number the distinct edges.
+  //
+  std::vector< vtkIdType > edgeOffsets( numVolumes );
+  state.EdgeMaps.resize( numVolumes );
+  vtkIdType numEdgeRefs = 0;
+  for ( vtkIdType v = 0; v < numVolumes; v ++ )
+    {
+    int n = volumes[v]->GetPointList().GetTotalNumberOfPoints();
+    edgeOffsets[v] = numEdgeRefs;
+    state.EdgeMaps[v].resize( n );
+    numEdgeRefs += n;
+    }
+  state.Edges.resize( numEdgeRefs );
+  TableBasedClipperGatherEdges gatherEdges = { volumes, edgeOffsets, state };
+  vtkSMPTools::For( 0, numVolumes, 1, gatherEdges );
+  vtkIdType numEdges = 0;
+  if ( numEdgeRefs > 0 )
+    {
+    TableBasedClipperEdgeRef * edges = &state.Edges[0];
+    vtkSMPTools::RadixSort( edges, edges + numEdgeRefs,
+                            &TableBasedClipperEdgeRef::Key );
+
+    std::vector< vtkIdType > edgeIds( numEdgeRefs );
+    edgeIds[0] = 0;
+    for ( vtkIdType e = 1; e < numEdgeRefs; e ++ )
+      {
+      edgeIds[e] = ( edges[e].Key != edges[ e - 1 ].Key ? 1 : 0 );
+      }
+    vtkSMPTools::InclusiveScan( edgeIds.begin(), edgeIds.end(),
+                                edgeIds.begin() );
+    numEdges = edgeIds[ numEdgeRefs - 1 ] + 1;
+    state.UniqueEdges.resize( numEdges );
+    TableBasedClipperNumberEdges numberEdges = { state, edgeIds, numUsed };
+    vtkSMPTools::For( 0, numEdgeRefs, numberEdges );
+    }
+
+  //
+  // The centroid points follow, volume after volume.
+  //
+  state.CentroidStart = numUsed + numEdges;
+  state.CentroidOffsets.resize( numVolumes );
+  vtkIdType numCentroids = 0;
+  for ( vtkIdType v = 0; v < numVolumes; v ++ )
+    {
+    state.CentroidOffsets[v] = numCentroids;
+    numCentroids += volumes[v]->GetCentroidList().GetTotalNumberOfPoints();
+    }
+  vtkIdType nOutPts = state.CentroidStart + numCentroids;
+
+  //
+  // Set up the output points and point data, presized so that the threads
+  // write distinct tuples.
+  //
+  vtkPoints * outPts = vtkPoints::New();
+  volumes[0]->SetOutputPointsDataType( outPts, input );
+  outPts->SetNumberOfPoints( nOutPts );
+  outPD->CopyAllocate( inPD, nOutPts );
+  outPD->SetNumberOfTuples( nOutPts );
+
+  vtkIntArray * newOrigNodes = NULL;
+  vtkIntArray * origNodes = vtkIntArray::SafeDownCast
+                (  inPD->GetArray( "avtOriginalNodeNumbers" )  );
+  if ( origNodes != NULL )
+    {
+    newOrigNodes = vtkIntArray::New();
+    newOrigNodes->SetNumberOfComponents( origNodes->GetNumberOfComponents() );
+    newOrigNodes->SetNumberOfTuples( nOutPts );
+    newOrigNodes->SetName( origNodes->GetName() );
+    }
+
+  TableBasedClipperCopyPoints copyPoints = { state, used, pts_ptr, outPts, inPD,
+                                      outPD, origNodes, newOrigNodes };
+  vtkSMPTools::For( 0, numPrevPts, copyPoints );
+  TableBasedClipperInterpolateEdges interpolateEdges = { volumes, state, numUsed,
+    pts_ptr, outPts, inPD, outPD, origNodes, newOrigNodes };
+  vtkSMPTools::For( 0, numEdges, interpolateEdges );
+  TableBasedClipperInterpolateCentroids interpolateCentroids = { volumes, state,
+    outPts, outPD, newOrigNodes };
+  vtkSMPTools::For( 0, numVolumes, 1, interpolateCentroids );
+
+  output->SetPoints( outPts );
+  outPts->Delete();
+
+  if ( newOrigNodes )
+    {
+    // AddArray will overwrite an already existing array with
+    // the same name, exactly what we want here.
+    outPD->AddArray( newOrigNodes );
+    newOrigNodes->Delete();
+    }
+
+  //
+  // Now the cells, grouped by shape as in the serial case, and within a
+  // shape by volume.
+  //
+  std::vector< vtkIdType > cellOffsets( nshapes * numVolumes );
+  std::vector< vtkIdType > connOffsets( nshapes * numVolumes );
+  vtkIdType ncells    = 0;
+  vtkIdType conn_size = 0;
+  for ( int i = 0; i < nshapes; i ++ )
+    {
+    for ( vtkIdType v = 0; v < numVolumes; v ++ )
+      {
+      const vtkTableBasedClipperShapeList * shapes = volumes[v]->GetShapeList( i );
+      vtkIdType ns = shapes->GetTotalNumberOfShapes();
+      cellOffsets[ i * numVolumes + v ] = ncells;
+      connOffsets[ i * numVolumes + v ] = conn_size;
+      ncells    += ns;
+      conn_size += ( shapes->GetShapeSize() + 1 ) * ns;
+      }
+    }
+
+  outCD->CopyAllocate( inCD, ncells );
+  outCD->SetNumberOfTuples( ncells );
+
+  vtkIdTypeArray * nlist = vtkIdTypeArray::New();
+  nlist->SetNumberOfValues( conn_size );
+  vtkUnsignedCharArray * cellTypes = vtkUnsignedCharArray::New();
+  cellTypes->SetNumberOfValues( ncells );
+  vtkIdTypeArray * cellLocations = vtkIdTypeArray::New();
+  cellLocations->SetNumberOfValues( ncells );
+
+  TableBasedClipperCopyCells copyCells = { volumes, state, cellOffsets, connOffsets,
+    nlist->GetPointer( 0 ), cellLocations->GetPointer( 0 ),
+    cellTypes->GetPointer( 0 ), inCD, outCD };
+  vtkSMPTools::For( 0, numVolumes, 1, copyCells );
+
+  vtkCellArray * cells = vtkCellArray::New();
+  cells->SetCells( ncells, nlist );
+  nlist->Delete();
+
+  output->SetCells( cellTypes, cellLocations, cells );
+  cellTypes->Delete();
+  cellLocations->Delete();
+  cells->Delete();
+}
+// ---- parallel merge of the volumes built by several threads (end)
+
 inline void GetPoint( double * pt, const double * X, const double * Y,
                       const double * Z, const int * dims, const int & index )
 {
@@ -1810,10 +2338,21 @@ int vtkTableBasedClipDataSet::RequestData( vtkInformation * vtkNotUsed( request
       cpyInput->GetPointData()->SetScalars( pScalars );
       }
 
-    for ( i = 0; i < numbPnts; i ++ )
+    vtkPointSet * pointSet = vtkPointSet::SafeDownCast( cpyInput );
+    if ( pointSet && pointSet->GetPoints() )
+      {
+      // in parallel if the clip function allows it
+      this->ClipFunction->FunctionValue
+                          ( pointSet->GetPoints()->GetData(), pScalars );
+      }
+    else
       {
-      double s = this->ClipFunction->FunctionValue(  cpyInput->GetPoint( i )  );
-      pScalars->SetTuple1( i, s );
+      for ( i = 0; i < numbPnts; i ++ )
+        {
+        double s = this->ClipFunction->FunctionValue
+                                      (  cpyInput->GetPoint( i )  );
+        pScalars->SetTuple1( i, s );
+        }
       }
 
     clipAray = pScalars;
@@ -3024,349 +3563,475 @@ void vtkTableBasedClipDataSet::ClipStructuredGridData( vtkDataSet * inputGrd,
 }
 
 //-----------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
-     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
+// Clip one cell with the case tables and add the resulting shapes and points
+// to vfv. Return false, without clipping, for the cell types the tables do
+// not cover. Used by both the serial and the parallel unstructured grid paths.
+static bool vtkTableBasedClipperClipCell
+  ( vtkTableBasedClipperVolumeFromVolume * vfv, int cellId, int cellType,
+    vtkIdType numbPnts, const vtkIdType * pntIndxs,
+    vtkDataArray * clipAray, double isoValue, int insideOut )
 {
-  vtkUnstructuredGrid * unstruct = vtkUnstructuredGrid::SafeDownCast( inputGrd );
+  switch ( cellType )
+    {
+    case VTK_TETRA:
+    case VTK_PYRAMID:
+    case VTK_WEDGE:
+    case VTK_HEXAHEDRON:
+    case VTK_VOXEL:
+    case VTK_TRIANGLE:
+    case VTK_QUAD:
+    case VTK_PIXEL:
+    case VTK_LINE:
+    case VTK_VERTEX:
+         break;
+
+    default:
+         return false;
+    }
 
-  vtkIdType   i, j;
-  vtkIdType   numbPnts = 0;
-  int         numCants = 0; // number of cells not clipped by this filter
-  int         numCells = unstruct->GetNumberOfCells();
+  vtkIdType j;
+  int    caseIndx = 0;
+  double grdDiffs[8];
 
-  // volume from volume
-  vtkTableBasedClipperVolumeFromVolume   * visItVFV = new
-  vtkTableBasedClipperVolumeFromVolume(
-      this->OutputPointsPrecision, unstruct->GetNumberOfPoints(),
-      int(   pow(  double( numCells ), double( 0.6667f )  )   ) * 5 + 100    );
+  for ( j = numbPnts-1; j >= 0; j -- )
+    {
+    grdDiffs[j] = clipAray->GetComponent( pntIndxs[j], 0 ) - isoValue;
+    caseIndx   += (  ( grdDiffs[j] >= 0.0 ) ? 1 : 0  );
+    caseIndx  <<= (  1 - ( !j )  );
+    }
 
-  // the stuffs that can not be clipped by this filter
-  vtkUnstructuredGrid * specials = vtkUnstructuredGrid::New();
-  specials->SetPoints( unstruct->GetPoints() );
-  specials->GetPointData()->ShallowCopy( unstruct->GetPointData() );
-  specials->Allocate( numCells );
+  int               startIdx = 0;
+  int               nOutputs = 0;
+  typedef const int EDGEIDXS[2];
+  EDGEIDXS        * edgeVtxs = NULL;
+  unsigned char   * thisCase = NULL;
 
-  for ( i = 0; i < numCells; i ++ )
+  // start index, split case, number of output, and vertices from edges
+  switch ( cellType )
     {
-    int         cellType = unstruct->GetCellType( i );
-    vtkIdType * pntIndxs = NULL;
-    unstruct->GetCellPoints( i, numbPnts, pntIndxs );
+    case VTK_TETRA:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesTet[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[ caseIndx ];
+      edgeVtxs = ( EDGEIDXS * )
+                 vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
+      break;
 
-    bool     bCanClip = false;
-    switch ( cellType )
-      {
-      case VTK_TETRA:
-      case VTK_PYRAMID:
-      case VTK_WEDGE:
-      case VTK_HEXAHEDRON:
-      case VTK_VOXEL:
-      case VTK_TRIANGLE:
-      case VTK_QUAD:
-      case VTK_PIXEL:
-      case VTK_LINE:
-      case VTK_VERTEX:
-           bCanClip = true;
-           break;
+    case VTK_PYRAMID:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesPyr[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[ caseIndx ];
+      edgeVtxs = ( EDGEIDXS * )
+                 vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
+      break;
 
-      default:
-           bCanClip = false;
-           break;
-      }
+    case VTK_WEDGE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesWdg[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[ caseIndx ];
+      edgeVtxs = ( EDGEIDXS * )
+                 vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
+      break;
 
-    if ( bCanClip )
-      {
-      int    caseIndx = 0;
-      double grdDiffs[8];
+    case VTK_HEXAHEDRON:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesHex[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[ caseIndx ];
+      edgeVtxs = ( EDGEIDXS * )
+                 vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
+      break;
 
-      for ( j = numbPnts-1; j >= 0; j -- )
-        {
-        grdDiffs[j] = clipAray->GetComponent( pntIndxs[j], 0 ) - isoValue;
-        caseIndx   += (  ( grdDiffs[j] >= 0.0 ) ? 1 : 0  );
-        caseIndx  <<= (  1 - ( !j )  );
-        }
+    case VTK_VOXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVox[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesVox[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVox[ caseIndx ];
+      edgeVtxs = ( EDGEIDXS * )
+                 vtkTableBasedClipperTriangulationTables::VoxVerticesFromEdges;
+      break;
 
-      int               startIdx = 0;
-      int               nOutputs = 0;
-      typedef const int EDGEIDXS[2];
-      EDGEIDXS        * edgeVtxs = NULL;
-      unsigned char   * thisCase = NULL;
+    case VTK_TRIANGLE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesTri[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[ caseIndx ];
+      edgeVtxs = ( EDGEIDXS * )
+                 vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
+      break;
 
-      // start index, split case, number of output, and vertices from edges
-      switch ( cellType )
-        {
-        case VTK_TETRA:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[ caseIndx ];
-          thisCase =&vtkTableBasedClipperClipTables::ClipShapesTet[ startIdx ];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[ caseIndx ];
-          edgeVtxs = ( EDGEIDXS * )
-                     vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
-          break;
+    case VTK_QUAD:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesQua[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[ caseIndx ];
+      edgeVtxs = ( EDGEIDXS * )
+                 vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
+      break;
 
-        case VTK_PYRAMID:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[ caseIndx ];
-          thisCase =&vtkTableBasedClipperClipTables::ClipShapesPyr[ startIdx ];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[ caseIndx ];
-          edgeVtxs = ( EDGEIDXS * )
-                     vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
-          break;
+    case VTK_PIXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPix[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesPix[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPix[ caseIndx ];
+      edgeVtxs = ( EDGEIDXS * )
+                 vtkTableBasedClipperTriangulationTables::PixelVerticesFromEdges;
+      break;
 
-        case VTK_WEDGE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[ caseIndx ];
-          thisCase =&vtkTableBasedClipperClipTables::ClipShapesWdg[ startIdx ];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[ caseIndx ];
-          edgeVtxs = ( EDGEIDXS * )
-                     vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
-          break;
+    case VTK_LINE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesLin[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[ caseIndx ];
+      edgeVtxs = ( EDGEIDXS * )
+                 vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
+      break;
 
-        case VTK_HEXAHEDRON:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[ caseIndx ];
-          thisCase =&vtkTableBasedClipperClipTables::ClipShapesHex[ startIdx ];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[ caseIndx ];
-          edgeVtxs = ( EDGEIDXS * )
-                     vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
-          break;
+    case VTK_VERTEX:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVtx[ caseIndx ];
+      thisCase =&vtkTableBasedClipperClipTables::ClipShapesVtx[ startIdx ];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVtx[ caseIndx ];
+      edgeVtxs = NULL;
+      break;
+    }
 
-        case VTK_VOXEL:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesVox[ caseIndx ];
-          thisCase =&vtkTableBasedClipperClipTables::ClipShapesVox[ startIdx ];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVox[ caseIndx ];
-          edgeVtxs = ( EDGEIDXS * )
-                     vtkTableBasedClipperTriangulationTables::VoxVerticesFromEdges;
-          break;
+  int   intrpIds[4];
+  for ( j = 0; j < nOutputs; j ++ )
+    {
+    int      nCellPts = 0;
+    int      theColor = -1;
+    int      intrpIdx = -1;
+    unsigned char theShape = *thisCase ++;
 
-        case VTK_TRIANGLE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[ caseIndx ];
-          thisCase =&vtkTableBasedClipperClipTables::ClipShapesTri[ startIdx ];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[ caseIndx ];
-          edgeVtxs = ( EDGEIDXS * )
-                     vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
-          break;
+    // number of points and color
+    switch ( theShape )
+      {
+      case ST_HEX:
+        nCellPts = 8;
+        theColor = *thisCase ++;
+        break;
+
+      case ST_WDG:
+        nCellPts = 6;
+        theColor = *thisCase ++;
+        break;
+
+      case ST_PYR:
+        nCellPts = 5;
+        theColor = *thisCase ++;
+        break;
+
+      case ST_TET:
+        nCellPts = 4;
+        theColor = *thisCase ++;
+        break;
+
+      case ST_QUA:
+        nCellPts = 4;
+        theColor = *thisCase ++;
+        break;
+
+      case ST_TRI:
+        nCellPts = 3;
+        theColor = *thisCase ++;
+        break;
+
+      case ST_LIN:
+        nCellPts = 2;
+        theColor = *thisCase ++;
+        break;
+
+      case ST_VTX:
+        nCellPts = 1;
+        theColor = *thisCase ++;
+        break;
+
+      case ST_PNT:
+        intrpIdx = *thisCase ++;
+        theColor = *thisCase ++;
+        nCellPts = *thisCase ++;
+        break;
 
-        case VTK_QUAD:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[ caseIndx ];
-          thisCase =&vtkTableBasedClipperClipTables::ClipShapesQua[ startIdx ];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[ caseIndx ];
-          edgeVtxs = ( EDGEIDXS * )
-                     vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
-          break;
+      default:
+        vtkGenericWarningMacro( << "An invalid output shape was found "
+                       << "in the ClipCases." << endl );
+      }
 
-        case VTK_PIXEL:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesPix[ caseIndx ];
-          thisCase =&vtkTableBasedClipperClipTables::ClipShapesPix[ startIdx ];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPix[ caseIndx ];
-          edgeVtxs = ( EDGEIDXS * )
-                     vtkTableBasedClipperTriangulationTables::PixelVerticesFromEdges;
-          break;
+    if ( (!insideOut && theColor == COLOR0 ) ||
+         ( insideOut && theColor == COLOR1 )
+       )
+      {
+      // We don't want this one; it's the wrong side.
+      thisCase += nCellPts;
+      continue;
+      }
 
-        case VTK_LINE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[ caseIndx ];
-          thisCase =&vtkTableBasedClipperClipTables::ClipShapesLin[ startIdx ];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[ caseIndx ];
-          edgeVtxs = ( EDGEIDXS * )
-                     vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
-          break;
+    int   shapeIds[8];
+    for ( int p = 0; p < nCellPts; p ++ )
+      {
+      unsigned char pntIndex = *thisCase ++;
 
-        case VTK_VERTEX:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesVtx[ caseIndx ];
-          thisCase =&vtkTableBasedClipperClipTables::ClipShapesVtx[ startIdx ];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVtx[ caseIndx ];
-          edgeVtxs = NULL;
-          break;
+      if ( pntIndex <= P7 )
+        {
+        // We know pt P0 must be >P0 since we already
+        // assume P0 == 0.  This is why we do not
+        // bother subtracting P0 from pt here.
+        shapeIds[p] = pntIndxs[ pntIndex ];
         }
-
-      int   intrpIds[4];
-      for ( j = 0; j < nOutputs; j ++ )
+      else
+      if ( pntIndex >= EA && pntIndex <= EL )
         {
-        int      nCellPts = 0;
-        int      theColor = -1;
-        int      intrpIdx = -1;
-        unsigned char theShape = *thisCase ++;
-
-        // number of points and color
-        switch ( theShape )
-          {
-          case ST_HEX:
-            nCellPts = 8;
-            theColor = *thisCase ++;
-            break;
-
-          case ST_WDG:
-            nCellPts = 6;
-            theColor = *thisCase ++;
-            break;
-
-          case ST_PYR:
-            nCellPts = 5;
-            theColor = *thisCase ++;
-            break;
-
-          case ST_TET:
-            nCellPts = 4;
-            theColor = *thisCase ++;
-            break;
-
-          case ST_QUA:
-            nCellPts = 4;
-            theColor = *thisCase ++;
-            break;
-
-          case ST_TRI:
-            nCellPts = 3;
-            theColor = *thisCase ++;
-            break;
-
-          case ST_LIN:
-            nCellPts = 2;
-            theColor = *thisCase ++;
-            break;
-
-          case ST_VTX:
-            nCellPts = 1;
-            theColor = *thisCase ++;
-            break;
-
-          case ST_PNT:
-            intrpIdx = *thisCase ++;
-            theColor = *thisCase ++;
-            nCellPts = *thisCase ++;
-            break;
-
-          default:
-            vtkErrorMacro( << "An invalid output shape was found "
-                           << "in the ClipCases." << endl );
-          }
-
-        if ( (!this->InsideOut && theColor == COLOR0 ) ||
-             ( this->InsideOut && theColor == COLOR1 )
-           )
+        int  pt1Index = edgeVtxs[ pntIndex-EA ][0];
+        int  pt2Index = edgeVtxs[ pntIndex-EA ][1];
+        if ( pt2Index < pt1Index )
           {
-          // We don't want this one; it's the wrong side.
-          thisCase += nCellPts;
-          continue;
+          int temp = pt2Index;
+          pt2Index = pt1Index;
+          pt1Index = temp;
           }
+        double pt1ToPt2 = grdDiffs[ pt2Index ] - grdDiffs[ pt1Index ];
+        double pt1ToIso = 0.0 - grdDiffs[ pt1Index ];
+        double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
 
-        int   shapeIds[8];
-        for ( int p = 0; p < nCellPts; p ++ )
-          {
-          unsigned char pntIndex = *thisCase ++;
-
-          if ( pntIndex <= P7 )
-            {
-            // We know pt P0 must be >P0 since we already
-            // assume P0 == 0.  This is why we do not
-            // bother subtracting P0 from pt here.
-            shapeIds[p] = pntIndxs[ pntIndex ];
-            }
-          else
-          if ( pntIndex >= EA && pntIndex <= EL )
-            {
-            int  pt1Index = edgeVtxs[ pntIndex-EA ][0];
-            int  pt2Index = edgeVtxs[ pntIndex-EA ][1];
-            if ( pt2Index < pt1Index )
-              {
-              int temp = pt2Index;
-              pt2Index = pt1Index;
-              pt1Index = temp;
-              }
-            double pt1ToPt2 = grdDiffs[ pt2Index ] - grdDiffs[ pt1Index ];
-            double pt1ToIso = 0.0 - grdDiffs[ pt1Index ];
-            double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
+        int    pntIndx1 = pntIndxs[ pt1Index ];
+        int    pntIndx2 = pntIndxs[ pt2Index ];
 
-            int    pntIndx1 = pntIndxs[ pt1Index ];
-            int    pntIndx2 = pntIndxs[ pt2Index ];
+        shapeIds[p] = vfv->AddPoint( pntIndx1, pntIndx2, p1Weight );
+        }
+      else
+      if ( pntIndex >= N0 && pntIndex <= N3 )
+        {
+        shapeIds[p] = intrpIds[ pntIndex - N0 ];
+        }
+      else
+        {
+        vtkGenericWarningMacro( << "An invalid output point value was found "
+                       << "in the ClipCases." << endl );
+        }
+      }
 
-            shapeIds[p] = visItVFV->AddPoint( pntIndx1, pntIndx2, p1Weight );
-            }
-          else
-          if ( pntIndex >= N0 && pntIndex <= N3 )
-            {
-            shapeIds[p] = intrpIds[ pntIndex - N0 ];
-            }
-          else
-            {
-            vtkErrorMacro( << "An invalid output point value was found "
-                           << "in the ClipCases." << endl );
-            }
-          }
+    switch ( theShape )
+      {
+      case ST_HEX:
+        vfv->AddHex( cellId, shapeIds[0], shapeIds[1],
+                             shapeIds[2], shapeIds[3], shapeIds[4],
+                             shapeIds[5], shapeIds[6], shapeIds[7] );
+        break;
+
+      case ST_WDG:
+        vfv->AddWedge( cellId, shapeIds[0], shapeIds[1], shapeIds[2],
+                               shapeIds[3], shapeIds[4], shapeIds[5] );
+        break;
+
+      case ST_PYR:
+        vfv->AddPyramid( cellId, shapeIds[0], shapeIds[1],
+                                 shapeIds[2], shapeIds[3], shapeIds[4] );
+        break;
+
+      case ST_TET:
+        vfv->AddTet( cellId, shapeIds[0], shapeIds[1],
+                             shapeIds[2], shapeIds[3] );
+        break;
+
+      case ST_QUA:
+        vfv->AddQuad( cellId, shapeIds[0], shapeIds[1],
+                              shapeIds[2], shapeIds[3] );
+        break;
+
+      case ST_TRI:
+        vfv->AddTri( cellId, shapeIds[0], shapeIds[1], shapeIds[2] );
+        break;
+
+      case ST_LIN:
+        vfv->AddLine( cellId, shapeIds[0], shapeIds[1] );
+        break;
+
+      case ST_VTX:
+        vfv->AddVertex( cellId, shapeIds[0] );
+        break;
+
+      case ST_PNT:
+        intrpIds[ intrpIdx ] = vfv->AddCentroidPoint
+                                         ( nCellPts, shapeIds );
+        break;
+      }
+    }
 
-        switch ( theShape )
-          {
-          case ST_HEX:
-            visItVFV->AddHex( i, shapeIds[0], shapeIds[1],
-                                 shapeIds[2], shapeIds[3], shapeIds[4],
-                                 shapeIds[5], shapeIds[6], shapeIds[7] );
-            break;
+  edgeVtxs = NULL;
+  thisCase = NULL;
 
-          case ST_WDG:
-            visItVFV->AddWedge( i, shapeIds[0], shapeIds[1], shapeIds[2],
-                                   shapeIds[3], shapeIds[4], shapeIds[5] );
-            break;
+  return true;
+}
 
-          case ST_PYR:
-            visItVFV->AddPyramid( i, shapeIds[0], shapeIds[1],
-                                     shapeIds[2], shapeIds[3], shapeIds[4] );
-            break;
+//-----------------------------------------------------------------------------
+namespace
+{
+// Point and cell arrays whose tuples may be read, or written at distinct
+// presized ids, from several threads.
+bool AreArraysThreadSafe( vtkFieldData * fd )
+{
+  for ( int i = 0; i < fd->GetNumberOfArrays(); i ++ )
+    {
+    vtkDataArray * array = vtkDataArray::SafeDownCast
+                           (  fd->GetAbstractArray( i )  );
+    if ( !array || array->GetDataType() == VTK_BIT ||
+         !array->HasStandardMemoryLayout() )
+      {
+      return false;
+      }
+    }
+  return true;
+}
 
-          case ST_TET:
-            visItVFV->AddTet( i, shapeIds[0], shapeIds[1],
-                                 shapeIds[2], shapeIds[3] );
-            break;
+// Clips ranges of cells into one vtkTableBasedClipperVolumeFromVolume per
+// thread. The cells that the tables do not cover are collected per thread.
+class vtkTableBasedClipperClipCells
+{
+public:
+  vtkUnstructuredGrid * Input;
+  vtkDataArray        * ClipArray;
+  double                IsoValue;
+  int                   InsideOut;
+  int                   Precision;
+  int                   PtSizeGuess;
+
+  vtkSMPThreadLocal< vtkTableBasedClipperVolumeFromVolume * > Volumes;
+  vtkSMPThreadLocal< std::vector< vtkIdType > > Specials;
+  vtkSMPThreadLocalObject< vtkIdList > CellPointIds;
+
+  vtkTableBasedClipperClipCells( vtkUnstructuredGrid * input,
+    vtkDataArray * clipAray, double isoValue, int insideOut, int precision,
+    int ptSizeGuess ) : Input( input ), ClipArray( clipAray ),
+    IsoValue( isoValue ), InsideOut( insideOut ), Precision( precision ),
+    PtSizeGuess( ptSizeGuess ), Volumes( NULL )
+    {
+    }
 
-          case ST_QUA:
-            visItVFV->AddQuad( i, shapeIds[0], shapeIds[1],
-                                  shapeIds[2], shapeIds[3] );
-            break;
+  void Initialize()
+    {
+    this->Volumes.Local() = new vtkTableBasedClipperVolumeFromVolume
+      ( this->Precision, this->Input->GetNumberOfPoints(), this->PtSizeGuess );
+    }
 
-          case ST_TRI:
-            visItVFV->AddTri( i, shapeIds[0], shapeIds[1], shapeIds[2] );
-            break;
+  void operator()( vtkIdType cellId, vtkIdType endCellId )
+    {
+    vtkTableBasedClipperVolumeFromVolume * vfv = this->Volumes.Local();
+    std::vector< vtkIdType > & specials = this->Specials.Local();
+    vtkIdList * ptIds = this->CellPointIds.Local();
 
-          case ST_LIN:
-            visItVFV->AddLine( i, shapeIds[0], shapeIds[1] );
-            break;
+    for ( ; cellId < endCellId; cellId ++ )
+      {
+      vtkIdType         numbPnts = 0;
+      const vtkIdType * pntIndxs = NULL;
+      int cellType = this->Input->GetCellType( cellId );
+      this->Input->GetCellPoints( cellId, numbPnts, pntIndxs, ptIds );
+      if (  !vtkTableBasedClipperClipCell( vfv, cellId, cellType, numbPnts,
+              pntIndxs, this->ClipArray, this->IsoValue, this->InsideOut )  )
+        {
+        specials.push_back( cellId );
+        }
+      }
+    }
 
-          case ST_VTX:
-            visItVFV->AddVertex( i, shapeIds[0] );
-            break;
+  void Reduce()
+    {
+    }
+};
+}
 
-          case ST_PNT:
-            intrpIds[ intrpIdx ] = visItVFV->AddCentroidPoint
-                                             ( nCellPts, shapeIds );
-            break;
-          }
-        }
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
+     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
+{
+  vtkUnstructuredGrid * unstruct = vtkUnstructuredGrid::SafeDownCast( inputGrd );
 
-      edgeVtxs = NULL;
-      thisCase = NULL;
+  vtkIdType   i;
+  vtkIdType   numbPnts = 0;
+  int         numCells = unstruct->GetNumberOfCells();
+  int         ptSizeGuess =
+              int(   pow(  double( numCells ), double( 0.6667f )  )   ) * 5 + 100;
+
+  // Large grids are clipped in parallel when all the arrays involved can be
+  // accessed concurrently. Each thread clips its cells into its own volume
+  // from volume, and the volumes are merged by ConstructDataSet().
+  bool inParallel = numCells >= VTK_TABLE_BASED_CLIP_PARALLEL_CELLS &&
+    unstruct->GetPoints() &&
+    unstruct->GetPoints()->GetData()->HasStandardMemoryLayout() &&
+    clipAray->GetDataType() != VTK_BIT &&
+    clipAray->HasStandardMemoryLayout() &&
+    AreArraysThreadSafe( unstruct->GetPointData() ) &&
+    AreArraysThreadSafe( unstruct->GetCellData() );
+
+  // volume(s) from volume, and the ids of the cells that can not be clipped
+  // by this filter
+  vtkTableBasedClipperVolumeFromVolume * visItVFV = NULL;
+  std::vector< vtkTableBasedClipperVolumeFromVolume * > visItVFVs;
+  std::vector< vtkIdType > cantIds;
+
+  if ( inParallel )
+    {
+    int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+    vtkTableBasedClipperClipCells clipper( unstruct, clipAray, isoValue,
+      this->InsideOut, this->OutputPointsPrecision,
+      ptSizeGuess / ( numThreads > 1 ? numThreads : 1 ) + 100 );
+    vtkSMPTools::For( 0, numCells, clipper );
+
+    vtkSMPThreadLocal< vtkTableBasedClipperVolumeFromVolume * >::iterator
+      vIter = clipper.Volumes.begin();
+    for ( ; vIter != clipper.Volumes.end(); ++ vIter )
+      {
+      visItVFVs.push_back( *vIter );
       }
-    else if (cellType == VTK_POLYHEDRON)
+    vtkSMPThreadLocal< std::vector< vtkIdType > >::iterator
+      sIter = clipper.Specials.begin();
+    for ( ; sIter != clipper.Specials.end(); ++ sIter )
       {
-      if ( numCants == 0 )
+      cantIds.insert( cantIds.end(), sIter->begin(), sIter->end() );
+      }
+    std::sort( cantIds.begin(), cantIds.end() );
+    }
+  else
+    {
+    visItVFV = new vtkTableBasedClipperVolumeFromVolume(
+      this->OutputPointsPrecision, unstruct->GetNumberOfPoints(), ptSizeGuess );
+
+    for ( i = 0; i < numCells; i ++ )
+      {
+      int         cellType = unstruct->GetCellType( i );
+      vtkIdType * pntIndxs = NULL;
+      unstruct->GetCellPoints( i, numbPnts, pntIndxs );
+
+      if (  !vtkTableBasedClipperClipCell( visItVFV, i, cellType, numbPnts,
+              pntIndxs, clipAray, isoValue, this->InsideOut )  )
         {
-          specials->GetCellData()
-                  ->CopyAllocate( unstruct->GetCellData(), numCells );
+        cantIds.push_back( i );
         }
+      pntIndxs = NULL;
+      }
+    }
+
+  // the stuffs that can not be clipped by this filter
+  int numCants = static_cast< int >( cantIds.size() );
+  vtkUnstructuredGrid * specials = vtkUnstructuredGrid::New();
+  specials->SetPoints( unstruct->GetPoints() );
+  specials->GetPointData()->ShallowCopy( unstruct->GetPointData() );
+  specials->Allocate( numCants > 0 ? numCants : 1 );
+  if ( numCants > 0 )
+    {
+    specials->GetCellData()->CopyAllocate( unstruct->GetCellData(), numCants );
+    }
+
+  for ( int c = 0; c < numCants; c ++ )
+    {
+    vtkIdType cellId   = cantIds[c];
+    int       cellType = unstruct->GetCellType( cellId );
+    if ( cellType == VTK_POLYHEDRON )
+      {
       vtkIdType nfaces, *facePtIds;
-      unstruct->GetFaceStream(i, nfaces, facePtIds);
-      specials->InsertNextCell(cellType, nfaces, facePtIds);
-      specials->GetCellData()
-              ->CopyData( unstruct->GetCellData(), i, numCants );
-      numCants ++;
+      unstruct->GetFaceStream( cellId, nfaces, facePtIds );
+      specials->InsertNextCell( cellType, nfaces, facePtIds );
       }
     else
       {
-      if ( numCants == 0 )
-        {
-          specials->GetCellData()
-                  ->CopyAllocate( unstruct->GetCellData(), numCells );
-        }
+      vtkIdType * pntIndxs = NULL;
+      unstruct->GetCellPoints( cellId, numbPnts, pntIndxs );
       specials->InsertNextCell( cellType, numbPnts, pntIndxs );
-      specials->GetCellData()
-              ->CopyData( unstruct->GetCellData(), i, numCants );
-      numCants ++;
       }
-
-    pntIndxs = NULL;
+    specials->GetCellData()->CopyData( unstruct->GetCellData(), cellId, c );
     }
 
   int         toDelete = 0;
@@ -3388,6 +4053,21 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
     }
   inputPts = NULL;
 
+  // the clipped cells, as one data set
+  vtkUnstructuredGrid * visItGrd = outputUG;
+  if ( numCants > 0 )
+    {
+    visItGrd = vtkUnstructuredGrid::New();
+    }
+  if ( inParallel )
+    {
+    vtkTableBasedClipperVolumeFromVolume::ConstructDataSet
+      ( visItVFVs, unstruct, visItGrd, theCords );
+    }
+  else
+    {
+    visItVFV->ConstructDataSet( unstruct, visItGrd, theCords );
+    }
 
   // the stuff that can not be clipped
   if ( numCants > 0 )
@@ -3395,9 +4075,6 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
     vtkUnstructuredGrid * vtkUGrid  = vtkUnstructuredGrid::New();
     this->ClipDataSet( specials, clipAray, vtkUGrid );
 
-    vtkUnstructuredGrid * visItGrd = vtkUnstructuredGrid::New();
-    visItVFV->ConstructDataSet( unstruct, visItGrd, theCords );
-
     vtkAppendFilter * appender = vtkAppendFilter::New();
     appender->AddInputData( vtkUGrid );
     appender->AddInputData( visItGrd );
@@ -3410,15 +4087,15 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
     vtkUGrid->Delete();
     appender = NULL;
     vtkUGrid = NULL;
-    visItGrd = NULL;
-    }
-  else
-    {
-    visItVFV->ConstructDataSet( unstruct, outputUG, theCords );
     }
+  visItGrd = NULL;
 
   specials->Delete();
   delete visItVFV;
+  for ( size_t v = 0; v < visItVFVs.size(); v ++ )
+    {
+    delete visItVFVs[v];
+    }
   if ( toDelete )
     {
     delete [] theCords;
@@ -36,6 +36,7 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
@@ -72,75 +73,124 @@ inline void vtkTemporalStatisticsInitializeStdDev(T *outArray,
 }
 
 //-----------------------------------------------------------------------------
+// Accumulate one time step into the statistics that are computed, in a
+// single pass over the values. The outputs that are not computed are NULL.
+//
+// standard deviation one-pass algorithm from
+// http://www.cs.berkeley.edu/~mhoemmen/cs194/Tutorials/variance.pdf
+// this is numerically stable! It uses the average up to the previous time
+// step, so the sum of squares is updated before the average.
 template<class T>
-inline void vtkTemporalStatisticsAccumulateAverage(const T *inArray,
-                                                   T *outArray,
-                                                   vtkIdType arraySize)
-{
-  for (vtkIdType i = 0; i < arraySize; i++)
-    {
-    outArray[i] += inArray[i];
-    }
-}
+struct vtkTemporalStatisticsAccumulate
+{
+  const T *InArray;
+  T *Average;
+  T *Minimum;
+  T *Maximum;
+  T *StdDev;
+  int Pass;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const T *inArray = this->InArray;
+    T *average = this->Average;
+    T *minimum = this->Minimum;
+    T *maximum = this->Maximum;
+    T *stdDev = this->StdDev;
+    const double pass = this->Pass;
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      const T value = inArray[i];
+      if (stdDev)
+        {
+        double temp = value - average[i]/pass;
+        stdDev[i] = stdDev[i] + static_cast<T>(pass*temp*temp/(pass+1));
+        }
+      if (average)
+        {
+        average[i] += value;
+        }
+      if (minimum && minimum[i] > value)
+        {
+        minimum[i] = value;
+        }
+      if (maximum && maximum[i] < value)
+        {
+        maximum[i] = value;
+        }
+      }
+  }
+};
 
+//-----------------------------------------------------------------------------
 template<class T>
-inline void vtkTemporalStatisticsAccumulateMinimum(const T *inArray,
-                                                   T *outArray,
-                                                   vtkIdType arraySize)
+struct vtkTemporalStatisticsFinishAverage
 {
-  for (vtkIdType i = 0; i < arraySize; i++)
-    {
-    if (outArray[i] > inArray[i]) outArray[i] = inArray[i];
-    }
-}
+  T *OutArray;
+  int SumSize;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    T *outArray = this->OutArray;
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      outArray[i] /= this->SumSize;
+      }
+  }
+};
 
 template<class T>
-inline void vtkTemporalStatisticsAccumulateMaximum(const T *inArray,
-                                                   T *outArray,
-                                                   vtkIdType arraySize)
+struct vtkTemporalStatisticsFinishStdDev
 {
-  for (vtkIdType i = 0; i < arraySize; i++)
-    {
-    if (outArray[i] < inArray[i]) outArray[i] = inArray[i];
-    }
-}
+  T *OutArray;
+  int SumSize;
 
-// standard deviation one-pass algorithm from
-// http://www.cs.berkeley.edu/~mhoemmen/cs194/Tutorials/variance.pdf
-// this is numerically stable!
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    T *outArray = this->OutArray;
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      outArray[i] =
+        static_cast<T>(sqrt(static_cast<double>(outArray[i])/this->SumSize));
+      }
+  }
+};
+
+//-----------------------------------------------------------------------------
 template<class T>
-inline void vtkTemporalStatisticsAccumulateStdDev(
-  const T *inArray, T *outArray, const T *previousAverage,
-  vtkIdType arraySize, int pass)
+inline void vtkTemporalStatisticsAccumulateArrays(
+  vtkDataArray *inArray, vtkDataArray *average, vtkDataArray *minimum,
+  vtkDataArray *maximum, vtkDataArray *stdDev, int pass, T *)
 {
-  for (vtkIdType i = 0; i < arraySize; i++)
-    {
-    double temp = inArray[i]-previousAverage[i]/static_cast<double>(pass);
-    outArray[i] = outArray[i] + static_cast<T>(
-      pass*temp*temp/static_cast<double>(pass+1) );
-    }
+  vtkTemporalStatisticsAccumulate<T> accumulate = {
+    static_cast<const T*>(inArray->GetVoidPointer(0)),
+    average ? static_cast<T*>(average->GetVoidPointer(0)) : NULL,
+    minimum ? static_cast<T*>(minimum->GetVoidPointer(0)) : NULL,
+    maximum ? static_cast<T*>(maximum->GetVoidPointer(0)) : NULL,
+    stdDev ? static_cast<T*>(stdDev->GetVoidPointer(0)) : NULL,
+    pass };
+  vtkSMPTools::For(0, inArray->GetNumberOfComponents()*
+                   inArray->GetNumberOfTuples(), accumulate);
 }
 
-//-----------------------------------------------------------------------------
 template<class T>
-inline void vtkTemporalStatisticsFinishAverage(T *outArray, vtkIdType arraySize,
-                                               int sumSize)
+inline void vtkTemporalStatisticsFinishAverageArray(vtkDataArray *outArray,
+                                                    int sumSize, T *)
 {
-  for (vtkIdType i = 0; i < arraySize; i++)
-    {
-    outArray[i] /= sumSize;
-    }
+  vtkTemporalStatisticsFinishAverage<T> finish = {
+    static_cast<T*>(outArray->GetVoidPointer(0)), sumSize };
+  vtkSMPTools::For(0, outArray->GetNumberOfComponents()*
+                   outArray->GetNumberOfTuples(), finish);
 }
 
 template<class T>
-inline void vtkTemporalStatisticsFinishStdDev(T *outArray,
-                                              vtkIdType arraySize, int sumSize)
+inline void vtkTemporalStatisticsFinishStdDevArray(vtkDataArray *outArray,
+                                                   int sumSize, T *)
 {
-  for (vtkIdType i = 0; i < arraySize; i++)
-    {
-    outArray[i] =
-      static_cast<T>(sqrt(static_cast<double>(outArray[i])/sumSize));
-    }
+  vtkTemporalStatisticsFinishStdDev<T> finish = {
+    static_cast<T*>(outArray->GetVoidPointer(0)), sumSize };
+  vtkSMPTools::For(0, outArray->GetNumberOfComponents()*
+                   outArray->GetNumberOfTuples(), finish);
 }
 
 //=============================================================================
@@ -529,76 +579,34 @@ void vtkTemporalStatistics::AccumulateArrays(vtkFieldData *inFd,
   for (int i = 0; i < numArrays; i++)
     {
     vtkDataArray *inArray = inFd->GetArray(i);
-    vtkDataArray *outArray;
     if (!inArray) continue;
 
-    outArray = this->GetArray(outFd, inArray, AVERAGE_SUFFIX);
-    if (outArray)
-      {
-
-
-      vtkDataArray* stdevOutArray =
-        this->GetArray(outFd, inArray, STANDARD_DEVIATION_SUFFIX);
-      if (stdevOutArray)
+    // The standard deviation needs the average.
+    vtkDataArray *average = this->GetArray(outFd, inArray, AVERAGE_SUFFIX);
+    vtkDataArray *stdDev = average ?
+      this->GetArray(outFd, inArray, STANDARD_DEVIATION_SUFFIX) : NULL;
+    vtkDataArray *minimum = this->GetArray(outFd, inArray, MINIMUM_SUFFIX);
+    vtkDataArray *maximum = this->GetArray(outFd, inArray, MAXIMUM_SUFFIX);
+    if (!average && !minimum && !maximum)
       {
-      switch (inArray->GetDataType())
-        {
-        // standard deviation must be called before average since the one-pass
-        // algorithm uses the average up to the previous time step
-        vtkTemplateMacro(vtkTemporalStatisticsAccumulateStdDev(
-                           static_cast<const VTK_TT*>(inArray->GetVoidPointer(0)),
-                           static_cast<VTK_TT*>(stdevOutArray->GetVoidPointer(0)),
-                           static_cast<const VTK_TT*>(outArray->GetVoidPointer(0)),
-                           inArray->GetNumberOfComponents()*inArray->GetNumberOfTuples(),
-                           this->CurrentTimeIndex));
-        }
-      // Alert change in data.
-      stdevOutArray->DataChanged();
+      continue;
       }
 
-
-
-
-      switch (inArray->GetDataType())
-        {
-        vtkTemplateMacro(vtkTemporalStatisticsAccumulateAverage(
-                        static_cast<const VTK_TT*>(inArray->GetVoidPointer(0)),
-                        static_cast<VTK_TT*>(outArray->GetVoidPointer(0)),
-                        inArray->GetNumberOfComponents()
-                        *inArray->GetNumberOfTuples()));
-        }
-      // Alert change in data.
-      outArray->DataChanged();
-      }
-
-    outArray = this->GetArray(outFd, inArray, MINIMUM_SUFFIX);
-    if (outArray)
+    switch (inArray->GetDataType())
       {
-      switch (inArray->GetDataType())
-        {
-        vtkTemplateMacro(vtkTemporalStatisticsAccumulateMinimum(
-                        static_cast<const VTK_TT*>(inArray->GetVoidPointer(0)),
-                        static_cast<VTK_TT*>(outArray->GetVoidPointer(0)),
-                        inArray->GetNumberOfComponents()
-                           *inArray->GetNumberOfTuples()));
-        }
-      // Alert change in data.
-      outArray->DataChanged();
+      vtkTemplateMacro(vtkTemporalStatisticsAccumulateArrays(
+                         inArray, average, minimum, maximum, stdDev,
+                         this->CurrentTimeIndex, static_cast<VTK_TT*>(0)));
       }
 
-    outArray = this->GetArray(outFd, inArray, MAXIMUM_SUFFIX);
-    if (outArray)
+    // Alert change in data.
+    vtkDataArray *outArrays[4] = { average, minimum, maximum, stdDev };
+    for (int j = 0; j < 4; j++)
       {
-      switch (inArray->GetDataType())
+      if (outArrays[j])
         {
-        vtkTemplateMacro(vtkTemporalStatisticsAccumulateMaximum(
-                        static_cast<const VTK_TT*>(inArray->GetVoidPointer(0)),
-                        static_cast<VTK_TT*>(outArray->GetVoidPointer(0)),
-                        inArray->GetNumberOfComponents()
-                         *inArray->GetNumberOfTuples()));
+        outArrays[j]->DataChanged();
         }
-      // Alert change in data.
-      outArray->DataChanged();
       }
     }
 }
@@ -677,11 +685,9 @@ void vtkTemporalStatistics::FinishArrays(vtkFieldData *inFd,
       {
       switch (inArray->GetDataType())
         {
-        vtkTemplateMacro(vtkTemporalStatisticsFinishAverage(
-                            static_cast<VTK_TT*>(outArray->GetVoidPointer(0)),
-                            inArray->GetNumberOfComponents()
-                             *inArray->GetNumberOfTuples(),
-                            this->CurrentTimeIndex));
+        vtkTemplateMacro(vtkTemporalStatisticsFinishAverageArray(
+                           outArray, this->CurrentTimeIndex,
+                           static_cast<VTK_TT*>(0)));
         }
       }
     vtkDataArray *avgArray = outArray;
@@ -702,11 +708,9 @@ void vtkTemporalStatistics::FinishArrays(vtkFieldData *inFd,
         {
         switch (inArray->GetDataType())
           {
-          vtkTemplateMacro(vtkTemporalStatisticsFinishStdDev(
-                     static_cast<VTK_TT*>(outArray->GetVoidPointer(0)),
-                     inArray->GetNumberOfComponents()
-                      *inArray->GetNumberOfTuples(),
-                     this->CurrentTimeIndex));
+          vtkTemplateMacro(vtkTemporalStatisticsFinishStdDevArray(
+                             outArray, this->CurrentTimeIndex,
+                             static_cast<VTK_TT*>(0)));
           }
         if (!this->ComputeAverage)
           {
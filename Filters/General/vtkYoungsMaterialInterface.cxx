@@ -23,6 +23,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkObjectFactory.h"
 #include "vtkCell.h"
 #include "vtkEmptyCell.h"
+#include "vtkGenericCell.h"
 #include "vtkPolygon.h"
 #include "vtkConvexPointSet.h"
 #include "vtkDataSet.h"
@@ -43,6 +44,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkIdList.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkSmartPointer.h"
+#include "vtkSMPTools.h"
 
 #ifndef DBG_ASSERT
 #define DBG_ASSERT(c) (void)0
@@ -124,9 +126,16 @@ public:
 
 
 
+struct vtkYoungsMaterialInterface_Chunk;
+
 class vtkYoungsMaterialInterfaceInternals
 {
 public:
+  // Reconstructs the interfaces of a chunk of cells processed in parallel.
+  static void ProcessChunk( vtkYoungsMaterialInterface* self,
+                            vtkYoungsMaterialInterface_Block* block,
+                            vtkYoungsMaterialInterface_Chunk* chunk );
+
   struct MaterialDescription
   {
 private:
@@ -218,6 +227,7 @@ vtkYoungsMaterialInterface::vtkYoungsMaterialInterface()
   this->Internals = new vtkYoungsMaterialInterfaceInternals;
   this->MaterialBlockMapping = vtkSmartPointer<vtkIntArray>::New();
   this->UseAllBlocks = true;
+  this->ReconstructInParallel = 0;
 
   vtkDebugMacro(<<"vtkYoungsMaterialInterface::vtkYoungsMaterialInterface() ok\n");
 }
@@ -243,6 +253,7 @@ void vtkYoungsMaterialInterface::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "VolumeFractionRange: [" << this->VolumeFractionRange[0] << ";" << this->VolumeFractionRange[1] <<"]\n";
   os << indent << "NumberOfDomains" << this->NumberOfDomains <<"\n";
   os << indent << "UseAllBlocks:" << this->UseAllBlocks << "\n";
+  os << indent << "ReconstructInParallel: " << this->ReconstructInParallel << "\n";
 }
 
 void vtkYoungsMaterialInterface::SetNumberOfMaterials(int n)
@@ -430,6 +441,49 @@ struct vtkYoungsMaterialInterface_IndexedValue
   inline bool operator < ( const vtkYoungsMaterialInterface_IndexedValue& iv ) const { return value < iv.value; }
 };
 
+// maps the input points copied to a material output to their output ids.
+// dense over the points of a block, sparse for the chunks of cells
+// processed in parallel, which only touch a few of them.
+class vtkYoungsMaterialInterface_PointMap
+{
+public:
+  vtkYoungsMaterialInterface_PointMap() : UseDense(true) {}
+
+  void Initialize( vtkIdType nPoints, bool dense )
+    {
+    this->UseDense = dense;
+    this->Dense.assign( dense ? nPoints : 0, -1 );
+    this->Sparse.clear();
+    }
+
+  vtkIdType Find( vtkIdType ptId ) const
+    {
+    if( this->UseDense )
+      {
+      return this->Dense[ptId];
+      }
+    std::map<vtkIdType,vtkIdType>::const_iterator it = this->Sparse.find( ptId );
+    return ( it != this->Sparse.end() ) ? it->second : -1;
+    }
+
+  void Set( vtkIdType ptId, vtkIdType id )
+    {
+    if( this->UseDense )
+      {
+      this->Dense[ptId] = id;
+      }
+    else
+      {
+      this->Sparse[ptId] = id;
+      }
+    }
+
+private:
+  bool UseDense;
+  std::vector<vtkIdType> Dense;
+  std::map<vtkIdType,vtkIdType> Sparse;
+};
+
 struct vtkYoungsMaterialInterface_Mat
 {
   // input
@@ -446,15 +500,160 @@ struct vtkYoungsMaterialInterface_Mat
   vtkIdType cellCount;
   vtkIdType cellArrayCount;
   vtkIdType pointCount;
-  vtkIdType* pointMap;
+  vtkYoungsMaterialInterface_PointMap pointMap;
+  bool recordPointSources;
 
   // output
   std::vector<unsigned char> cellTypes;
   std::vector<vtkIdType> cells;
-  vtkDataArray** outCellArrays;
+  std::vector<vtkIdType> cellSources; // input cell of each output cell
+  std::vector<vtkIdType> pointSources; // input point copied to each output point, or -1
   vtkDataArray** outPointArrays; // last point array is point coords
+
+  inline void addPointSource( vtkIdType ptId )
+    {
+    if( this->recordPointSources )
+      {
+      this->pointSources.push_back( ptId );
+      }
+    }
+};
+
+// input of a block, shared by all its cells
+struct vtkYoungsMaterialInterface_Block
+{
+  vtkDataSet* input;
+  vtkIdType nPoints;
+  int nmat;
+  int nPointData; // last point array is point coords
+  int pointDataComponents;
+  vtkDataArray** inPointArrays;
+  int* pointArrayOffset;
+};
+
+// temporary objects and statistics of a sequence of cells
+struct vtkYoungsMaterialInterface_Workspace
+{
+  vtkGenericCell* genericCell;
+  vtkIdList* ptIds;
+  vtkPoints* pts;
+  vtkConvexPointSet* cpsCell;
+  std::vector<double> interpolatedValues;
+  std::vector<vtkYoungsMaterialInterface_IndexedValue> matOrdering;
+  std::vector< std::pair<int,vtkIdType> > prevPointsMap;
+
+  // debug statistics
+  vtkIdType primaryTriangulationFailed;
+  vtkIdType triangulationFailed;
+  vtkIdType nullNormal;
+  vtkIdType noInterfaceFound;
+
+  vtkYoungsMaterialInterface_Workspace( int nmat, int pointDataComponents )
+    : interpolatedValues( vtkYoungsMaterialInterface::MAX_CELL_POINTS * pointDataComponents ),
+      matOrdering( nmat ),
+      primaryTriangulationFailed(0), triangulationFailed(0), nullNormal(0), noInterfaceFound(0)
+    {
+    this->genericCell = vtkGenericCell::New();
+    this->ptIds = vtkIdList::New();
+    this->pts = vtkPoints::New();
+    this->cpsCell = vtkConvexPointSet::New();
+    this->prevPointsMap.reserve( vtkYoungsMaterialInterface::MAX_CELL_POINTS * nmat );
+    }
+
+  ~vtkYoungsMaterialInterface_Workspace()
+    {
+    this->genericCell->Delete();
+    this->ptIds->Delete();
+    this->pts->Delete();
+    this->cpsCell->Delete();
+    }
+
+  void AddStatistics( const vtkYoungsMaterialInterface_Workspace& ws )
+    {
+    this->primaryTriangulationFailed += ws.primaryTriangulationFailed;
+    this->triangulationFailed += ws.triangulationFailed;
+    this->nullNormal += ws.nullNormal;
+    this->noInterfaceFound += ws.noInterfaceFound;
+    }
+
+private:
+  vtkYoungsMaterialInterface_Workspace( const vtkYoungsMaterialInterface_Workspace& ); // Not implemented
+  void operator=( const vtkYoungsMaterialInterface_Workspace& ); // Not implemented
+};
+
+// a range of cells processed in parallel, with its own material outputs
+struct vtkYoungsMaterialInterface_Chunk
+{
+  vtkIdType begin;
+  vtkIdType end;
+  int nPointData;
+  std::vector<vtkYoungsMaterialInterface_Mat> Mats;
+  vtkYoungsMaterialInterface_Workspace workspace;
+
+  vtkYoungsMaterialInterface_Chunk( vtkYoungsMaterialInterface_Block* block,
+                                    vtkYoungsMaterialInterface_Mat* blockMats,
+                                    vtkIdType b, vtkIdType e )
+    : begin(b), end(e), nPointData( block->nPointData ), Mats( blockMats, blockMats + block->nmat ),
+      workspace( block->nmat, block->pointDataComponents )
+    {
+    for( int m = 0; m < block->nmat; ++ m )
+      {
+      vtkYoungsMaterialInterface_Mat& mat = this->Mats[m];
+      mat.pointCount = 0;
+      mat.cellCount = 0;
+      mat.cellArrayCount = 0;
+      mat.pointMap.Initialize( block->nPoints, false );
+      mat.recordPointSources = true;
+      mat.outPointArrays = new vtkDataArray* [ block->nPointData ];
+      for( int i = 0; i < block->nPointData; ++ i )
+        {
+        mat.outPointArrays[i] = blockMats[m].outPointArrays[i]->NewInstance();
+        mat.outPointArrays[i]->SetNumberOfComponents( blockMats[m].outPointArrays[i]->GetNumberOfComponents() );
+        }
+      }
+    }
+
+  ~vtkYoungsMaterialInterface_Chunk()
+    {
+    for( size_t m = 0; m < this->Mats.size(); ++ m )
+      {
+      for( int i = 0; i < this->nPointData; ++ i )
+        {
+        this->Mats[m].outPointArrays[i]->Delete();
+        }
+      delete [] this->Mats[m].outPointArrays;
+      }
+    }
+};
+
+struct vtkYoungsMaterialInterface_ChunkFunctor
+{
+  vtkYoungsMaterialInterface* Self;
+  vtkYoungsMaterialInterface_Block* Block;
+  std::vector<vtkYoungsMaterialInterface_Chunk*>& Chunks;
+
+  vtkYoungsMaterialInterface_ChunkFunctor( vtkYoungsMaterialInterface* self,
+                                           vtkYoungsMaterialInterface_Block* block,
+                                           std::vector<vtkYoungsMaterialInterface_Chunk*>& chunks )
+    : Self(self), Block(block), Chunks(chunks) {}
+
+  void operator()( vtkIdType begin, vtkIdType end ) const
+    {
+    for( vtkIdType k = begin; k < end; ++ k )
+      {
+      vtkYoungsMaterialInterfaceInternals::ProcessChunk( this->Self, this->Block, this->Chunks[k] );
+      }
+    }
 };
 
+void vtkYoungsMaterialInterfaceInternals::ProcessChunk(
+  vtkYoungsMaterialInterface* self,
+  vtkYoungsMaterialInterface_Block* block,
+  vtkYoungsMaterialInterface_Chunk* chunk )
+{
+  self->ProcessCells( block, &chunk->Mats[0], chunk->begin, chunk->end, &chunk->workspace );
+}
+
 
 static inline void vtkYoungsMaterialInterface_GetPointData(
                                                            int nPointData,
@@ -759,16 +958,9 @@ int vtkYoungsMaterialInterface::RequestData(
         Mats[m].cellCount = 0;
         Mats[m].cellArrayCount = 0;
 
-        Mats[m].outCellArrays = new vtkDataArray* [ nCellData ];
-        for( int i = 0; i < nCellData; ++ i )
-          {
-          Mats[m].outCellArrays[i] = vtkDataArray::CreateDataArray( inCellArrays[i]->GetDataType() );
-          Mats[m].outCellArrays[i]->SetName( inCellArrays[i]->GetName() );
-          Mats[m].outCellArrays[i]->SetNumberOfComponents( inCellArrays[i]->GetNumberOfComponents() );
-          }
-
         Mats[m].numberOfPoints = 0;
         Mats[m].pointCount = 0;
+        Mats[m].recordPointSources = false;
         Mats[m].outPointArrays = new vtkDataArray* [ nPointData ];
 
         for( int i = 0;i<(nPointData-1);i++)
@@ -783,805 +975,940 @@ int vtkYoungsMaterialInterface::RequestData(
         }
       }
 
-      // --------------- per material number of interfaces estimation ------------
-      for(vtkIdType c=0;c<nCells;c++)
+      // --------------------------- core computation --------------------------
+      vtkYoungsMaterialInterface_Block block;
+      block.input = input;
+      block.nPoints = nPoints;
+      block.nmat = nmat;
+      block.nPointData = nPointData;
+      block.pointDataComponents = pointDataComponents;
+      block.inPointArrays = inPointArrays;
+      block.pointArrayOffset = pointArrayOffset;
+
+      vtkYoungsMaterialInterface_Workspace workspace( nmat, pointDataComponents );
+      if( this->ReconstructInParallel )
         {
-        vtkCell* vtkcell = input->GetCell(c);
-        int cellDim = vtkcell->GetCellDimension();
-        int np = vtkcell->GetNumberOfPoints();
-        int nf = vtkcell->GetNumberOfFaces();
-
-        for(int m=0;m<nmat;m++)
+        this->ProcessCellsInParallel( &block, Mats, &workspace );
+        }
+      else
+        {
+        // --------------- per material number of interfaces estimation ------------
+        for(vtkIdType c=0;c<nCells;c++)
           {
-          double fraction = ( Mats[m].fractionArray != 0 ) ? Mats[m].fractionArray->GetTuple1(c) : 0;
-          if( this->CellProduceInterface(cellDim,np,fraction,this->VolumeFractionRange[0],this->VolumeFractionRange[1]) )
+          vtkCell* vtkcell = input->GetCell(c);
+          int cellDim = vtkcell->GetCellDimension();
+          int np = vtkcell->GetNumberOfPoints();
+          int nf = vtkcell->GetNumberOfFaces();
+
+          for(int m=0;m<nmat;m++)
             {
-            if( cellDim == 2 )
-              {
-              Mats[m].numberOfPoints += 2;
-              }
-            else
+            double fraction = ( Mats[m].fractionArray != 0 ) ? Mats[m].fractionArray->GetTuple1(c) : 0;
+            if( this->CellProduceInterface(cellDim,np,fraction,this->VolumeFractionRange[0],this->VolumeFractionRange[1]) )
               {
-              Mats[m].numberOfPoints += nf;
-              }
-            if( this->FillMaterial )
-              {
-              Mats[m].numberOfPoints += np-1;
+              if( cellDim == 2 )
+                {
+                Mats[m].numberOfPoints += 2;
+                }
+              else
+                {
+                Mats[m].numberOfPoints += nf;
+                }
+              if( this->FillMaterial )
+                {
+                Mats[m].numberOfPoints += np-1;
+                }
+              Mats[m].numberOfCells ++;
               }
-            Mats[m].numberOfCells ++;
             }
           }
-        }
 
-      // allocation of output arrays
-      for(int m=0;m<nmat;m++)
-        {
-        vtkDebugMacro(<<"Mat #"<<m<<" : cells="<<Mats[m].numberOfCells<<", points="<<Mats[m].numberOfPoints<<", FillMaterial="<<this->FillMaterial<<"\n");
-        for(int i = 0;i<nCellData;i++)
-          {
-          Mats[m].outCellArrays[i]->Allocate( Mats[m].numberOfCells * Mats[m].outCellArrays[i]->GetNumberOfComponents() );
-          }
-        for(int i = 0;i<nPointData;i++)
+        // allocation of output arrays
+        for(int m=0;m<nmat;m++)
           {
-          Mats[m].outPointArrays[i]->Allocate( Mats[m].numberOfPoints * Mats[m].outPointArrays[i]->GetNumberOfComponents() );
+          vtkDebugMacro(<<"Mat #"<<m<<" : cells="<<Mats[m].numberOfCells<<", points="<<Mats[m].numberOfPoints<<", FillMaterial="<<this->FillMaterial<<"\n");
+          for(int i = 0;i<nPointData;i++)
+            {
+            Mats[m].outPointArrays[i]->Allocate( Mats[m].numberOfPoints * Mats[m].outPointArrays[i]->GetNumberOfComponents() );
+            }
+          Mats[m].cellTypes.reserve( Mats[m].numberOfCells );
+          Mats[m].cells.reserve( Mats[m].numberOfCells + Mats[m].numberOfPoints );
+          Mats[m].cellSources.reserve( Mats[m].numberOfCells );
+          Mats[m].pointMap.Initialize( nPoints, true );
           }
-        Mats[m].cellTypes.reserve( Mats[m].numberOfCells );
-        Mats[m].cells.reserve( Mats[m].numberOfCells + Mats[m].numberOfPoints );
-        Mats[m].pointMap = new vtkIdType[ nPoints ];
-        for(vtkIdType i = 0;i<nPoints;i++) { Mats[m].pointMap[i] = -1;}
-        }
 
-      // --------------------------- core computation --------------------------
-      vtkIdList *ptIds = vtkIdList::New();
-      vtkPoints *pts = vtkPoints::New();
-      vtkConvexPointSet* cpsCell = vtkConvexPointSet::New();
+        this->ProcessCells( &block, Mats, 0, nCells, &workspace );
+        }
 
-      double* interpolatedValues = new double[ MAX_CELL_POINTS * pointDataComponents ];
-      vtkYoungsMaterialInterface_IndexedValue * matOrdering = new vtkYoungsMaterialInterface_IndexedValue[nmat];
+      debugStats_PrimaryTriangulationfailed += workspace.primaryTriangulationFailed;
+      debugStats_Triangulationfailed += workspace.triangulationFailed;
+      debugStats_NullNormal += workspace.nullNormal;
+      debugStats_NoInterfaceFound += workspace.noInterfaceFound;
 
-      std::vector< std::pair<int,vtkIdType> > prevPointsMap;
-      prevPointsMap.reserve( MAX_CELL_POINTS*nmat );
+      delete [] pointArrayOffset;
+      delete [] inPointArrays;
 
-      for(vtkIdType ci = 0;ci<nCells;ci++)
+      // finish output creation
+      //       output->SetNumberOfBlocks( nmat );
+      for( int m=0;m<nmat;m++)
         {
-        int interfaceEdges[MAX_CELL_POINTS*2];
-        double interfaceWeights[MAX_CELL_POINTS];
-        int nInterfaceEdges;
+        if( Mats[m].cellCount>0 && Mats[m].pointCount>0 )
+          {
+          vtkDebugMacro(<<"Mat #"<<m<<" : cellCount="<<Mats[m].cellCount<<", numberOfCells="<<Mats[m].numberOfCells<<", pointCount="<<Mats[m].pointCount<<", numberOfPoints="<<Mats[m].numberOfPoints<<"\n");
+          }
 
-        int insidePointIds[MAX_CELL_POINTS];
-        int nInsidePoints;
+        vtkSmartPointer<vtkUnstructuredGrid> ugOutput = vtkSmartPointer<vtkUnstructuredGrid>::New();
 
-        int outsidePointIds[MAX_CELL_POINTS];
-        int nOutsidePoints;
+        // set points
+        Mats[m].outPointArrays[nPointData-1]->Squeeze();
+        vtkPoints* points = vtkPoints::New();
+        points->SetDataTypeToDouble();
+        points->SetNumberOfPoints( Mats[m].pointCount );
+        points->SetData( Mats[m].outPointArrays[nPointData-1] );
+        Mats[m].outPointArrays[nPointData-1]->Delete();
+        ugOutput->SetPoints( points );
+        points->Delete();
 
-        int outCellPointIds[MAX_CELL_POINTS];
-        int nOutCellPoints;
+        // set cell connectivity
+        vtkIdTypeArray* cellArrayData = vtkIdTypeArray::New();
+        cellArrayData->SetNumberOfValues( Mats[m].cellArrayCount );
+        vtkIdType* cellArrayDataPtr = cellArrayData->WritePointer(0,Mats[m].cellArrayCount);
+        for(vtkIdType i = 0;i<Mats[m].cellArrayCount;i++) cellArrayDataPtr[i] = Mats[m].cells[i];
 
-        double referenceVolume = 1.0;
-        double normal[3];
-        bool normaleNulle = false;
+        vtkCellArray* cellArray = vtkCellArray::New();
+        cellArray->SetCells( Mats[m].cellCount , cellArrayData );
+        cellArrayData->Delete();
 
-        prevPointsMap.clear();
+        // set cell types
+        vtkUnsignedCharArray *cellTypes = vtkUnsignedCharArray::New();
+        cellTypes->SetNumberOfValues( Mats[m].cellCount );
+        unsigned char* cellTypesPtr = cellTypes->WritePointer(0,Mats[m].cellCount);
+        for(vtkIdType i = 0;i<Mats[m].cellCount;i++) cellTypesPtr[i] = Mats[m].cellTypes[i];
 
-        // sort materials
-        int nEffectiveMat = 0;
-        for(int mi = 0;mi<nmat;mi++)
+        // set cell locations
+        vtkIdTypeArray* cellLocations = vtkIdTypeArray::New();
+        cellLocations->SetNumberOfValues( Mats[m].cellCount );
+        vtkIdType counter = 0;
+        for(vtkIdType i = 0;i<Mats[m].cellCount;i++)
           {
-          matOrdering[mi].index = mi;
-          matOrdering[mi].value = ( Mats[mi].orderingArray != 0 ) ? Mats[mi].orderingArray->GetTuple1(ci) : 0.0;
-
-          double fraction = ( Mats[mi].fractionArray != 0 ) ? Mats[mi].fractionArray->GetTuple1(ci) : 0;
-          if( this->UseFractionAsDistance || fraction>this->VolumeFractionRange[0] ) nEffectiveMat++;
+          cellLocations->SetValue(i,counter);
+          counter += Mats[m].cells[counter] + 1;
           }
-        std::stable_sort( matOrdering , matOrdering+nmat );
-
-        // read cell information for the first iteration
-        // a temporary cell will then be generated after each iteration for the next one.
-        vtkCell* vtkcell = input->GetCell(ci);
-        CellInfo cell;
-        cell.dim = vtkcell->GetCellDimension();
-        cell.np = vtkcell->GetNumberOfPoints();
-        cell.nf = vtkcell->GetNumberOfFaces();
-        cell.type = vtkcell->GetCellType();
-
-        /* copy points and point ids to lacal arrays.
-           IMPORTANT NOTE : A negative point id refers to a point in the previous material.
-           the material number and real point id can be found through the prevPointsMap. */
-        for(int p=0;p<cell.np;p++)
+
+        // attach conectivity arrays to data set
+        ugOutput->SetCells( cellTypes, cellLocations, cellArray );
+        cellArray->Delete();
+        cellTypes->Delete();
+        cellLocations->Delete();
+
+        // attach point arrays
+        for(int i = 0;i<nPointData-1;i++)
           {
-          cell.pointIds[p] = vtkcell->GetPointId(p);
-          DBG_ASSERT( cell.pointIds[p]>=0 && cell.pointIds[p]<nPoints );
-          vtkcell->GetPoints()->GetPoint( p , cell.points[p] );
+          Mats[m].outPointArrays[i]->Squeeze();
+          ugOutput->GetPointData()->AddArray( Mats[m].outPointArrays[i] );
+          Mats[m].outPointArrays[i]->Delete();
           }
 
-        /* Triangulate cell.
-           IMPORTANT NOTE: triangulation is given with mesh point ids (not local cell ids)
-           and are translated to cell local point ids. */
-        cell.needTriangulation = false;
-        cell.triangulationOk = ( vtkcell->Triangulate(ci,ptIds,pts) != 0 );
-        cell.ntri = 0;
-        if( cell.triangulationOk )
+        // attach cell arrays, copied from the input cell of each output cell
+        for(int i = 0;i<nCellData;i++)
           {
-          cell.ntri = ptIds->GetNumberOfIds() / (cell.dim+1);
-          for(int i = 0;i<(cell.ntri*(cell.dim+1));i++)
+          vtkDataArray* outCellArray = vtkDataArray::CreateDataArray( inCellArrays[i]->GetDataType() );
+          outCellArray->SetName( inCellArrays[i]->GetName() );
+          outCellArray->SetNumberOfComponents( inCellArrays[i]->GetNumberOfComponents() );
+          outCellArray->SetNumberOfTuples( Mats[m].cellCount );
+          for(vtkIdType c = 0;c<Mats[m].cellCount;c++)
             {
-            vtkIdType j = std::find( cell.pointIds , cell.pointIds+cell.np , ptIds->GetId(i) ) - cell.pointIds;
-            DBG_ASSERT( j>=0 && j<cell.np );
-            cell.triangulation[i] = j;
+            outCellArray->SetTuple( c, Mats[m].cellSources[c], inCellArrays[i] );
             }
+          ugOutput->GetCellData()->AddArray( outCellArray );
+          outCellArray->Delete();
           }
-        else
+
+        delete [] Mats[m].outPointArrays;
+
+        // activate attributes similarly to input
+        for ( int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; ++ i )
           {
-          debugStats_PrimaryTriangulationfailed ++;
-          vtkWarningMacro(<<"Triangulation failed on primary cell\n");
+          vtkDataArray* attr = input->GetCellData()->GetAttribute(i);
+          if( attr!=0 )
+            {
+            ugOutput->GetCellData()->SetActiveAttribute(attr->GetName(),i);
+            }
           }
-
-        // get 3D cell edges.
-        if( cell.dim == 3 )
+        for ( int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; ++ i )
           {
-          vtkCell3D* cell3D = vtkCell3D::SafeDownCast( vtkcell );
-          cell.nEdges = vtkcell->GetNumberOfEdges();
-          for(int i = 0;i<cell.nEdges;i++)
+          vtkDataArray* attr = input->GetPointData()->GetAttribute(i);
+          if( attr!=0 )
             {
-            int tmp[4];
-            int * edgePoints = tmp;
-            cell3D->GetEdgePoints(i,edgePoints);
-            cell.edges[i][0] = edgePoints[0];
-            DBG_ASSERT( cell.edges[i][0]>=0 && cell.edges[i][0]<cell.np );
-            cell.edges[i][1] = edgePoints[1];
-            DBG_ASSERT( cell.edges[i][1]>=0 && cell.edges[i][1]<cell.np );
+            ugOutput->GetPointData()->SetActiveAttribute(attr->GetName(),i);
             }
           }
 
-        // For debugging : ensure that we don't read anything from cell, but only from previously filled arrays
-        vtkcell = 0;
-
-        int processedEfectiveMat = 0;
-
-        // Loop for each material. Current cell is iteratively cut.
-        for(int mi = 0;mi<nmat;mi++)
+        // add material data set to multiblock output
+        if( ugOutput && ugOutput->GetNumberOfCells()>0 )
           {
-          int m = this->ReverseMaterialOrder ? matOrdering[nmat-1-mi].index : matOrdering[mi].index;
+          int domain = inputsPerMaterial[m];
+          outputBlocks[ domain * nmat + m ] = ugOutput;
+          ++ inputsPerMaterial[m];
+          }
+        }
+      delete [] Mats;
+      delete [] inCellArrays;
+    } // Iterate over input blocks
 
-          // Get volume fraction and interface plane normal from input arrays
-          double fraction = ( Mats[m].fractionArray != 0 ) ? Mats[m].fractionArray->GetTuple1(ci) : 0;
+  delete [] inputsPerMaterial;
 
-          // Normalize remaining volume fraction
-          fraction = (referenceVolume>0) ? (fraction/referenceVolume) : 0.0;
+  if ( debugStats_PrimaryTriangulationfailed )
+    {
+    vtkDebugMacro(<<"PrimaryTriangulationfailed "<<debugStats_PrimaryTriangulationfailed<<"\n");
+    }
+  if ( debugStats_Triangulationfailed )
+    {
+    vtkDebugMacro(<<"Triangulationfailed "<<debugStats_Triangulationfailed<<"\n");
+    }
+  if ( debugStats_NullNormal )
+    {
+    vtkDebugMacro(<<"NullNormal "<<debugStats_NullNormal<<"\n");
+    }
+  if( debugStats_NoInterfaceFound )
+    {
+    vtkDebugMacro(<<"NoInterfaceFound "<<debugStats_NoInterfaceFound<<"\n");
+    }
 
-          if( this->CellProduceInterface(cell.dim,cell.np,fraction,this->VolumeFractionRange[0],this->VolumeFractionRange[1]) )
-            {
-            CellInfo nextCell; // empty cell by default
-            int interfaceCellType = VTK_EMPTY_CELL;
+  // Build final composite output. also tagging blocks with their associated Id
+  vtkDebugMacro(<<this->NumberOfDomains<<" Domains, "<<nmat<<" Materials\n");
 
-            if( ( ! mi ) || ( ! this->OnionPeel ) )
-              {
-              normal[0]=0; normal[1]=0; normal[2]=0;
+  output->SetNumberOfBlocks(0);
+  output->SetNumberOfBlocks(nmat);
 
-              if( Mats[m].normalArray != 0 ) Mats[m].normalArray->GetTuple(ci,normal);
-              if( Mats[m].normalXArray != 0 ) normal[0] = Mats[m].normalXArray->GetTuple1(ci);
-              if( Mats[m].normalYArray != 0 ) normal[1] = Mats[m].normalYArray->GetTuple1(ci);
-              if( Mats[m].normalZArray != 0 ) normal[2] = Mats[m].normalZArray->GetTuple1(ci);
+  for ( int m = 0; m < nmat; ++ m )
+    {
+    vtkMultiBlockDataSet* matBlock = vtkMultiBlockDataSet::New();
+    matBlock->SetNumberOfBlocks(this->NumberOfDomains);
+    output->SetBlock(m, matBlock);
+    matBlock->Delete();
+    }
 
-              // work-around for degenerated normals
-              if( vtkMath::Norm(normal) == 0.0 ) // should it be <EPSILON ?
-                {
-                debugStats_NullNormal ++;
-                normaleNulle=true;
-                normal[0]=1.0;
-                normal[1]=0.0;
-                normal[2]=0.0;
-                }
-              else
-                {
-                vtkMath::Normalize( normal );
-                }
-              if( this->InverseNormal )
-                {
-                normal[0] = -normal[0];
-                normal[1] = -normal[1];
-                normal[2] = -normal[2];
-                }
-              }
+  int blockIndex=0;
+  for( std::map<int,vtkSmartPointer<vtkUnstructuredGrid> >::iterator it=outputBlocks.begin();
+       it!=outputBlocks.end(); ++ it, ++ blockIndex )
+    {
+    if( it->second->GetNumberOfCells() > 0 )
+      {
+      int mat = it->first % nmat;
+      int dom = it->first / nmat;
+      vtkMultiBlockDataSet* matBlock = vtkMultiBlockDataSet::SafeDownCast(output->GetBlock(mat));
+      matBlock->SetBlock(dom,it->second);
+      }
+    }
 
-            // count how many materials we've processed so far
-            if( fraction > this->VolumeFractionRange[0] )
-              {
-              processedEfectiveMat ++;
-              }
+  return 1;
+}
 
-            // -= case where the entire input cell is passed through =-
-            if( ( !this->UseFractionAsDistance && fraction>this->VolumeFractionRange[1] && this->FillMaterial ) || ( this->UseFractionAsDistance && normaleNulle ) )
-              {
-              interfaceCellType = cell.type;
-              //Mats[m].cellTypes.push_back( cell.type );
-              nOutCellPoints = nInsidePoints = cell.np;
-              nInterfaceEdges = 0;
-              nOutsidePoints = 0;
-              for(int p=0;p<cell.np;p++) { outCellPointIds[p] = insidePointIds[p] = p;}
-              // remaining volume is an empty cell (nextCell is left as is)
-              }
+//-----------------------------------------------------------------------------
+void vtkYoungsMaterialInterface::ProcessCells(
+  vtkYoungsMaterialInterface_Block* block,
+  vtkYoungsMaterialInterface_Mat* Mats,
+  vtkIdType begin, vtkIdType end,
+  vtkYoungsMaterialInterface_Workspace* ws )
+{
+  // names used by GET_POINT_DATA
+  vtkDataSet* input = block->input;
+  int nmat = block->nmat;
+  int nPointData = block->nPointData;
+  vtkDataArray** inPointArrays = block->inPointArrays;
+  std::vector< std::pair<int,vtkIdType> >& prevPointsMap = ws->prevPointsMap;
+
+  int pointDataComponents = block->pointDataComponents;
+  int* pointArrayOffset = block->pointArrayOffset;
+  vtkIdList* ptIds = ws->ptIds;
+  vtkPoints* pts = ws->pts;
+  vtkConvexPointSet* cpsCell = ws->cpsCell;
+  double* interpolatedValues = &ws->interpolatedValues[0];
+  vtkYoungsMaterialInterface_IndexedValue* matOrdering = &ws->matOrdering[0];
+
+  for(vtkIdType ci = begin;ci<end;ci++)
+    {
+    int interfaceEdges[MAX_CELL_POINTS*2];
+    double interfaceWeights[MAX_CELL_POINTS];
+    int nInterfaceEdges;
 
-            // -= case where the entire cell is ignored =-
+    int insidePointIds[MAX_CELL_POINTS];
+    int nInsidePoints;
 
-            else if ( !this->UseFractionAsDistance && ( fraction<this->VolumeFractionRange[0] || (fraction>this->VolumeFractionRange[1] && !this->FillMaterial) || !cell.triangulationOk ) )
-              {
-              interfaceCellType = VTK_EMPTY_CELL;
-              //Mats[m].cellTypes.push_back( VTK_EMPTY_CELL );
+    int outsidePointIds[MAX_CELL_POINTS];
+    int nOutsidePoints;
 
-              nOutCellPoints = 0;
-              nInterfaceEdges = 0;
-              nInsidePoints = 0;
-              nOutsidePoints = 0;
+    int outCellPointIds[MAX_CELL_POINTS];
+    int nOutCellPoints;
 
-              // remaining volume is the same cell
-              nextCell = cell;
+    double referenceVolume = 1.0;
+    double normal[3];
+    bool normaleNulle = false;
 
-              if( !cell.triangulationOk )
-                {
-                debugStats_Triangulationfailed ++;
-                vtkWarningMacro(<<"Cell triangulation failed\n");
-                }
-              }
+    prevPointsMap.clear();
 
-            // -= 2D case =-
-            else if( cell.dim == 2 )
-              {
-              int nRemCellPoints;
-              int remCellPointIds[MAX_CELL_POINTS];
+    // sort materials
+    int nEffectiveMat = 0;
+    for(int mi = 0;mi<nmat;mi++)
+      {
+      matOrdering[mi].index = mi;
+      matOrdering[mi].value = ( Mats[mi].orderingArray != 0 ) ? Mats[mi].orderingArray->GetTuple1(ci) : 0.0;
 
-              int triangles[MAX_CELL_POINTS][3];
-              for(int i = 0;i<cell.ntri;i++) for(int j = 0;j<3;j++)
-                {
-                triangles[i][j] = cell.triangulation[i*3+j];
-                DBG_ASSERT( triangles[i][j]>=0 && triangles[i][j]<cell.np );
-                }
+      double fraction = ( Mats[mi].fractionArray != 0 ) ? Mats[mi].fractionArray->GetTuple1(ci) : 0;
+      if( this->UseFractionAsDistance || fraction>this->VolumeFractionRange[0] ) nEffectiveMat++;
+      }
+    std::stable_sort( matOrdering , matOrdering+nmat );
+
+    // read cell information for the first iteration
+    // a temporary cell will then be generated after each iteration for the next one.
+    input->GetCell(ci,ws->genericCell);
+    vtkCell* vtkcell = ws->genericCell->GetRepresentativeCell();
+    CellInfo cell;
+    cell.dim = vtkcell->GetCellDimension();
+    cell.np = vtkcell->GetNumberOfPoints();
+    cell.nf = vtkcell->GetNumberOfFaces();
+    cell.type = vtkcell->GetCellType();
+
+    /* copy points and point ids to lacal arrays.
+       IMPORTANT NOTE : A negative point id refers to a point in the previous material.
+       the material number and real point id can be found through the prevPointsMap. */
+    for(int p=0;p<cell.np;p++)
+      {
+      cell.pointIds[p] = vtkcell->GetPointId(p);
+      DBG_ASSERT( cell.pointIds[p]>=0 && cell.pointIds[p]<nPoints );
+      vtkcell->GetPoints()->GetPoint( p , cell.points[p] );
+      }
 
-              bool interfaceFound = vtkYoungsMaterialInterfaceCellCut::cellInterfaceD(
-                                                                                      cell.points, cell.np,
-                                                                                      triangles, cell.ntri,
-                                                                                      fraction, normal,
-                                                                                      this->AxisSymetric != 0,
-                                                                                      this->UseFractionAsDistance != 0,
-                                                                                      interfaceEdges, interfaceWeights,
-                                                                                      nOutCellPoints, outCellPointIds,
-                                                                                      nRemCellPoints, remCellPointIds );
-
-              if( interfaceFound )
-                {
-                nInterfaceEdges = 2;
-                interfaceCellType = this->FillMaterial ? VTK_POLYGON : VTK_LINE;
-                //Mats[m].cellTypes.push_back( this->FillMaterial ? VTK_POLYGON : VTK_LINE );
-
-                // remaining volume is a polygon
-                nextCell.dim = 2;
-                nextCell.np = nRemCellPoints;
-                nextCell.nf = nRemCellPoints;
-                nextCell.type = VTK_POLYGON;
-
-                // build polygon triangulation for next iteration
-                nextCell.ntri = nextCell.np-2;
-                for(int i = 0;i<nextCell.ntri;i++)
-                  {
-                  nextCell.triangulation[i*3+0] = 0;
-                  nextCell.triangulation[i*3+1] = i+1;
-                  nextCell.triangulation[i*3+2] = i+2;
-                  }
-                nextCell.triangulationOk = true;
-                nextCell.needTriangulation = false;
+    /* Triangulate cell.
+       IMPORTANT NOTE: triangulation is given with mesh point ids (not local cell ids)
+       and are translated to cell local point ids. */
+    cell.needTriangulation = false;
+    cell.triangulationOk = ( vtkcell->Triangulate(ci,ptIds,pts) != 0 );
+    cell.ntri = 0;
+    if( cell.triangulationOk )
+      {
+      cell.ntri = ptIds->GetNumberOfIds() / (cell.dim+1);
+      for(int i = 0;i<(cell.ntri*(cell.dim+1));i++)
+        {
+        vtkIdType j = std::find( cell.pointIds , cell.pointIds+cell.np , ptIds->GetId(i) ) - cell.pointIds;
+        DBG_ASSERT( j>=0 && j<cell.np );
+        cell.triangulation[i] = j;
+        }
+      }
+    else
+      {
+      ws->primaryTriangulationFailed ++;
+      vtkWarningMacro(<<"Triangulation failed on primary cell\n");
+      }
 
-                // populate prevPointsMap and next iteration cell point ids
-                int ni = 0;
-                for(int i = 0;i<nRemCellPoints;i++)
-                  {
-                  vtkIdType id = remCellPointIds[i];
-                  if( id < 0 )
-                    {
-                    id = - (int)( prevPointsMap.size() + 1 );
-                    DBG_ASSERT( (-id-1) == prevPointsMap.size() );
-                    prevPointsMap.push_back( std::make_pair( m , Mats[m].pointCount+ni ) ); // intersection points will be added first
-                    ni++;
-                    }
-                  else
-                    {
-                    DBG_ASSERT( id>=0 && id<cell.np );
-                    id = cell.pointIds[ id ];
-                    }
-                  nextCell.pointIds[i] = id;
-                  }
-                DBG_ASSERT( ni == nInterfaceEdges );
+    // get 3D cell edges.
+    if( cell.dim == 3 )
+      {
+      vtkCell3D* cell3D = vtkCell3D::SafeDownCast( vtkcell );
+      cell.nEdges = vtkcell->GetNumberOfEdges();
+      for(int i = 0;i<cell.nEdges;i++)
+        {
+        int tmp[4];
+        int * edgePoints = tmp;
+        cell3D->GetEdgePoints(i,edgePoints);
+        cell.edges[i][0] = edgePoints[0];
+        DBG_ASSERT( cell.edges[i][0]>=0 && cell.edges[i][0]<cell.np );
+        cell.edges[i][1] = edgePoints[1];
+        DBG_ASSERT( cell.edges[i][1]>=0 && cell.edges[i][1]<cell.np );
+        }
+      }
 
-                // filter out points inside material volume
-                nInsidePoints = 0;
-                for(int i = 0;i<nOutCellPoints;i++)
-                  {
-                  if( outCellPointIds[i] >= 0 ) insidePointIds[nInsidePoints++] = outCellPointIds[i];
-                  }
+    // For debugging : ensure that we don't read anything from cell, but only from previously filled arrays
+    vtkcell = 0;
 
-                if( ! this->FillMaterial ) // keep only interface points
+    int processedEfectiveMat = 0;
 
-                  {
-                  int n = 0;
-                  for(int i = 0;i<nOutCellPoints;i++)
-                    {
-                    if( outCellPointIds[i] < 0 ) outCellPointIds[n++] = outCellPointIds[i];
-                    }
-                  nOutCellPoints = n;
-                  }
+    // Loop for each material. Current cell is iteratively cut.
+    for(int mi = 0;mi<nmat;mi++)
+      {
+      int m = this->ReverseMaterialOrder ? matOrdering[nmat-1-mi].index : matOrdering[mi].index;
+
+      // Get volume fraction and interface plane normal from input arrays
+      double fraction = ( Mats[m].fractionArray != 0 ) ? Mats[m].fractionArray->GetTuple1(ci) : 0;
+
+      // Normalize remaining volume fraction
+      fraction = (referenceVolume>0) ? (fraction/referenceVolume) : 0.0;
+
+      if( this->CellProduceInterface(cell.dim,cell.np,fraction,this->VolumeFractionRange[0],this->VolumeFractionRange[1]) )
+        {
+        CellInfo nextCell; // empty cell by default
+        int interfaceCellType = VTK_EMPTY_CELL;
+
+        if( ( ! mi ) || ( ! this->OnionPeel ) )
+          {
+          normal[0]=0; normal[1]=0; normal[2]=0;
+
+          if( Mats[m].normalArray != 0 ) Mats[m].normalArray->GetTuple(ci,normal);
+          if( Mats[m].normalXArray != 0 ) normal[0] = Mats[m].normalXArray->GetTuple1(ci);
+          if( Mats[m].normalYArray != 0 ) normal[1] = Mats[m].normalYArray->GetTuple1(ci);
+          if( Mats[m].normalZArray != 0 ) normal[2] = Mats[m].normalZArray->GetTuple1(ci);
+
+          // work-around for degenerated normals
+          if( vtkMath::Norm(normal) == 0.0 ) // should it be <EPSILON ?
+            {
+            ws->nullNormal ++;
+            normaleNulle=true;
+            normal[0]=1.0;
+            normal[1]=0.0;
+            normal[2]=0.0;
+            }
+          else
+            {
+            vtkMath::Normalize( normal );
+            }
+          if( this->InverseNormal )
+            {
+            normal[0] = -normal[0];
+            normal[1] = -normal[1];
+            normal[2] = -normal[2];
+            }
+          }
+
+        // count how many materials we've processed so far
+        if( fraction > this->VolumeFractionRange[0] )
+          {
+          processedEfectiveMat ++;
+          }
+
+        // -= case where the entire input cell is passed through =-
+        if( ( !this->UseFractionAsDistance && fraction>this->VolumeFractionRange[1] && this->FillMaterial ) || ( this->UseFractionAsDistance && normaleNulle ) )
+          {
+          interfaceCellType = cell.type;
+          //Mats[m].cellTypes.push_back( cell.type );
+          nOutCellPoints = nInsidePoints = cell.np;
+          nInterfaceEdges = 0;
+          nOutsidePoints = 0;
+          for(int p=0;p<cell.np;p++) { outCellPointIds[p] = insidePointIds[p] = p;}
+          // remaining volume is an empty cell (nextCell is left as is)
+          }
+
+        // -= case where the entire cell is ignored =-
+
+        else if ( !this->UseFractionAsDistance && ( fraction<this->VolumeFractionRange[0] || (fraction>this->VolumeFractionRange[1] && !this->FillMaterial) || !cell.triangulationOk ) )
+          {
+          interfaceCellType = VTK_EMPTY_CELL;
+          //Mats[m].cellTypes.push_back( VTK_EMPTY_CELL );
+
+          nOutCellPoints = 0;
+          nInterfaceEdges = 0;
+          nInsidePoints = 0;
+          nOutsidePoints = 0;
+
+          // remaining volume is the same cell
+          nextCell = cell;
+
+          if( !cell.triangulationOk )
+            {
+            ws->triangulationFailed ++;
+            vtkWarningMacro(<<"Cell triangulation failed\n");
+            }
+          }
+
+        // -= 2D case =-
+        else if( cell.dim == 2 )
+          {
+          int nRemCellPoints;
+          int remCellPointIds[MAX_CELL_POINTS];
+
+          int triangles[MAX_CELL_POINTS][3];
+          for(int i = 0;i<cell.ntri;i++) for(int j = 0;j<3;j++)
+            {
+            triangles[i][j] = cell.triangulation[i*3+j];
+            DBG_ASSERT( triangles[i][j]>=0 && triangles[i][j]<cell.np );
+            }
+
+          bool interfaceFound = vtkYoungsMaterialInterfaceCellCut::cellInterfaceD(
+                                                                                  cell.points, cell.np,
+                                                                                  triangles, cell.ntri,
+                                                                                  fraction, normal,
+                                                                                  this->AxisSymetric != 0,
+                                                                                  this->UseFractionAsDistance != 0,
+                                                                                  interfaceEdges, interfaceWeights,
+                                                                                  nOutCellPoints, outCellPointIds,
+                                                                                  nRemCellPoints, remCellPointIds );
+
+          if( interfaceFound )
+            {
+            nInterfaceEdges = 2;
+            interfaceCellType = this->FillMaterial ? VTK_POLYGON : VTK_LINE;
+            //Mats[m].cellTypes.push_back( this->FillMaterial ? VTK_POLYGON : VTK_LINE );
+
+            // remaining volume is a polygon
+            nextCell.dim = 2;
+            nextCell.np = nRemCellPoints;
+            nextCell.nf = nRemCellPoints;
+            nextCell.type = VTK_POLYGON;
+
+            // build polygon triangulation for next iteration
+            nextCell.ntri = nextCell.np-2;
+            for(int i = 0;i<nextCell.ntri;i++)
+              {
+              nextCell.triangulation[i*3+0] = 0;
+              nextCell.triangulation[i*3+1] = i+1;
+              nextCell.triangulation[i*3+2] = i+2;
+              }
+            nextCell.triangulationOk = true;
+            nextCell.needTriangulation = false;
+
+            // populate prevPointsMap and next iteration cell point ids
+            int ni = 0;
+            for(int i = 0;i<nRemCellPoints;i++)
+              {
+              vtkIdType id = remCellPointIds[i];
+              if( id < 0 )
+                {
+                id = - (int)( prevPointsMap.size() + 1 );
+                DBG_ASSERT( (-id-1) == prevPointsMap.size() );
+                prevPointsMap.push_back( std::make_pair( m , Mats[m].pointCount+ni ) ); // intersection points will be added first
+                ni++;
                 }
               else
                 {
-                vtkWarningMacro(<<"no interface found for cell "<<ci<<", mi="<<mi<<", m="<<m<<", frac="<<fraction<<"\n");
-                nInterfaceEdges = 0;
-                nOutCellPoints = 0;
-                nInsidePoints = 0;
-                nOutsidePoints = 0;
-                interfaceCellType = VTK_EMPTY_CELL;
-                //Mats[m].cellTypes.push_back( VTK_EMPTY_CELL );
-                // remaining volume is the original cell left unmodified
-                nextCell = cell;
+                DBG_ASSERT( id>=0 && id<cell.np );
+                id = cell.pointIds[ id ];
                 }
+              nextCell.pointIds[i] = id;
               }
+            DBG_ASSERT( ni == nInterfaceEdges );
 
-            // -= 3D case =-
+            // filter out points inside material volume
+            nInsidePoints = 0;
+            for(int i = 0;i<nOutCellPoints;i++)
+              {
+              if( outCellPointIds[i] >= 0 ) insidePointIds[nInsidePoints++] = outCellPointIds[i];
+              }
+
+            if( ! this->FillMaterial ) // keep only interface points
 
-            else
               {
-              int tetras[MAX_CELL_POINTS][4];
-              for(int i = 0;i<cell.ntri;i++) for(int j = 0;j<4;j++)
+              int n = 0;
+              for(int i = 0;i<nOutCellPoints;i++)
                 {
-                tetras[i][j] = cell.triangulation[i*4+j];
+                if( outCellPointIds[i] < 0 ) outCellPointIds[n++] = outCellPointIds[i];
                 }
+              nOutCellPoints = n;
+              }
+            }
+          else
+            {
+            vtkWarningMacro(<<"no interface found for cell "<<ci<<", mi="<<mi<<", m="<<m<<", frac="<<fraction<<"\n");
+            nInterfaceEdges = 0;
+            nOutCellPoints = 0;
+            nInsidePoints = 0;
+            nOutsidePoints = 0;
+            interfaceCellType = VTK_EMPTY_CELL;
+            //Mats[m].cellTypes.push_back( VTK_EMPTY_CELL );
+            // remaining volume is the original cell left unmodified
+            nextCell = cell;
+            }
+          }
 
-              // compute innterface polygon
-              vtkYoungsMaterialInterfaceCellCut::cellInterface3D(
-                                                                 cell.np, cell.points,
-                                                                 cell.nEdges, cell.edges,
-                                                                 cell.ntri, tetras,
-                                                                 fraction, normal,
-                                                                 this->UseFractionAsDistance != 0,
-                                                                 nInterfaceEdges, interfaceEdges, interfaceWeights,
-                                                                 nInsidePoints, insidePointIds,
-                                                                 nOutsidePoints, outsidePointIds );
-
-              if( nInterfaceEdges>cell.nf || nInterfaceEdges<3 ) // degenerated case, considered as null interface
-                {
-                debugStats_NoInterfaceFound ++;
-                vtkDebugMacro(<<"no interface found for cell "<<ci<<", mi="<<mi<<", m="<<m<<", frac="<<fraction<<"\n");
-                nInterfaceEdges = 0;
-                nOutCellPoints = 0;
-                nInsidePoints = 0;
-                nOutsidePoints = 0;
-                interfaceCellType = VTK_EMPTY_CELL;
-                //Mats[m].cellTypes.push_back( VTK_EMPTY_CELL );
-
-                // in this case, next iteration cell is the same
-                nextCell = cell;
-                }
-              else
-                {
-                nOutCellPoints = 0;
+        // -= 3D case =-
 
-                for(int e = 0;e<nInterfaceEdges;e++)
-                  {
-                  outCellPointIds[nOutCellPoints++] = -e -1;
-                  }
+        else
+          {
+          int tetras[MAX_CELL_POINTS][4];
+          for(int i = 0;i<cell.ntri;i++) for(int j = 0;j<4;j++)
+            {
+            tetras[i][j] = cell.triangulation[i*4+j];
+            }
 
-                if(this->FillMaterial)
-                  {
-                  interfaceCellType = VTK_CONVEX_POINT_SET;
-                  //Mats[m].cellTypes.push_back( VTK_CONVEX_POINT_SET );
-                  for(int p=0;p<nInsidePoints;p++)
-                    {
-                    outCellPointIds[nOutCellPoints++] = insidePointIds[p];
-                    }
-                  }
-                else
-                  {
-                  interfaceCellType = VTK_POLYGON;
-                  //Mats[m].cellTypes.push_back( VTK_POLYGON );
-                  }
+          // compute innterface polygon
+          vtkYoungsMaterialInterfaceCellCut::cellInterface3D(
+                                                             cell.np, cell.points,
+                                                             cell.nEdges, cell.edges,
+                                                             cell.ntri, tetras,
+                                                             fraction, normal,
+                                                             this->UseFractionAsDistance != 0,
+                                                             nInterfaceEdges, interfaceEdges, interfaceWeights,
+                                                             nInsidePoints, insidePointIds,
+                                                             nOutsidePoints, outsidePointIds );
+
+          if( nInterfaceEdges>cell.nf || nInterfaceEdges<3 ) // degenerated case, considered as null interface
+            {
+            ws->noInterfaceFound ++;
+            vtkDebugMacro(<<"no interface found for cell "<<ci<<", mi="<<mi<<", m="<<m<<", frac="<<fraction<<"\n");
+            nInterfaceEdges = 0;
+            nOutCellPoints = 0;
+            nInsidePoints = 0;
+            nOutsidePoints = 0;
+            interfaceCellType = VTK_EMPTY_CELL;
+            //Mats[m].cellTypes.push_back( VTK_EMPTY_CELL );
+
+            // in this case, next iteration cell is the same
+            nextCell = cell;
+            }
+          else
+            {
+            nOutCellPoints = 0;
 
-                // NB: Remaining volume is a convex point set
-                // IMPORTANT NOTE: next iteration cell cannot be entirely built right now.
-                // in this particular case we'll finish it at the end of the material loop.
-                // If no other material remains to be processed, then skip this step.
-                if( mi < ( nmat - 1 ) && processedEfectiveMat < nEffectiveMat )
-                  {
-                  nextCell.type = VTK_CONVEX_POINT_SET;
-                  nextCell.np = nInterfaceEdges + nOutsidePoints;
-                  vtkcell = cpsCell;
-                  vtkcell->Points->Reset();
-                  vtkcell->PointIds->Reset();
-                  vtkcell->Points->SetNumberOfPoints( nextCell.np );
-                  vtkcell->PointIds->SetNumberOfIds( nextCell.np );
-                  for(int i = 0;i<nextCell.np;i++)
-                    {
-                    vtkcell->PointIds->SetId( i, i );
-                    }
-                  // nf, ntri and triangulation have to be computed later on, when point coords are computed
-                  nextCell.needTriangulation = true;
-                  }
+            for(int e = 0;e<nInterfaceEdges;e++)
+              {
+              outCellPointIds[nOutCellPoints++] = -e -1;
+              }
 
-                for(int i = 0;i<nInterfaceEdges;i++)
-                  {
-                  vtkIdType id = - (int) ( prevPointsMap.size() + 1 );
-                  DBG_ASSERT( (-id-1) == prevPointsMap.size() );
-                  // Interpolated points will be added consecutively
-                  prevPointsMap.push_back( std::make_pair( m , Mats[m].pointCount+i ) );
-                  nextCell.pointIds[i] = id;
-                  }
-                for(int i = 0;i<nOutsidePoints;i++)
-                  {
-                  nextCell.pointIds[nInterfaceEdges+i] = cell.pointIds[ outsidePointIds[i] ];
-                  }
+            if(this->FillMaterial)
+              {
+              interfaceCellType = VTK_CONVEX_POINT_SET;
+              //Mats[m].cellTypes.push_back( VTK_CONVEX_POINT_SET );
+              for(int p=0;p<nInsidePoints;p++)
+                {
+                outCellPointIds[nOutCellPoints++] = insidePointIds[p];
                 }
+              }
+            else
+              {
+              interfaceCellType = VTK_POLYGON;
+              //Mats[m].cellTypes.push_back( VTK_POLYGON );
+              }
 
-              // check correctness of next cell's point ids
+            // NB: Remaining volume is a convex point set
+            // IMPORTANT NOTE: next iteration cell cannot be entirely built right now.
+            // in this particular case we'll finish it at the end of the material loop.
+            // If no other material remains to be processed, then skip this step.
+            if( mi < ( nmat - 1 ) && processedEfectiveMat < nEffectiveMat )
+              {
+              nextCell.type = VTK_CONVEX_POINT_SET;
+              nextCell.np = nInterfaceEdges + nOutsidePoints;
+              vtkcell = cpsCell;
+              vtkcell->Points->Reset();
+              vtkcell->PointIds->Reset();
+              vtkcell->Points->SetNumberOfPoints( nextCell.np );
+              vtkcell->PointIds->SetNumberOfIds( nextCell.np );
               for(int i = 0;i<nextCell.np;i++)
                 {
-                DBG_ASSERT( ( nextCell.pointIds[i]<0 && (-nextCell.pointIds[i]-1)<prevPointsMap.size() ) || ( nextCell.pointIds[i]>=0 && nextCell.pointIds[i]<nPoints ) );
+                vtkcell->PointIds->SetId( i, i );
                 }
-              } // End 3D case
+              // nf, ntri and triangulation have to be computed later on, when point coords are computed
+              nextCell.needTriangulation = true;
+              }
 
-            //  create output cell
-            if( interfaceCellType != VTK_EMPTY_CELL )
+            for(int i = 0;i<nInterfaceEdges;i++)
+              {
+              vtkIdType id = - (int) ( prevPointsMap.size() + 1 );
+              DBG_ASSERT( (-id-1) == prevPointsMap.size() );
+              // Interpolated points will be added consecutively
+              prevPointsMap.push_back( std::make_pair( m , Mats[m].pointCount+i ) );
+              nextCell.pointIds[i] = id;
+              }
+            for(int i = 0;i<nOutsidePoints;i++)
               {
+              nextCell.pointIds[nInterfaceEdges+i] = cell.pointIds[ outsidePointIds[i] ];
+              }
+            }
 
-              // set type of cell
-              Mats[m].cellTypes.push_back( interfaceCellType );
+          // check correctness of next cell's point ids
+          for(int i = 0;i<nextCell.np;i++)
+            {
+            DBG_ASSERT( ( nextCell.pointIds[i]<0 && (-nextCell.pointIds[i]-1)<prevPointsMap.size() ) || ( nextCell.pointIds[i]>=0 && nextCell.pointIds[i]<nPoints ) );
+            }
+          } // End 3D case
 
-              // interpolate point values for cut edges
-              for(int e = 0;e<nInterfaceEdges;e++)
-                {
-                double t = interfaceWeights[e];
-                for(int p=0;p<nPointData;p++)
-                  {
-                  double v0[16];
-                  double v1[16];
-                  int nc = Mats[m].outPointArrays[p]->GetNumberOfComponents();
-                  int ep0 = cell.pointIds[ interfaceEdges[e*2+0] ];
-                  int ep1 = cell.pointIds[ interfaceEdges[e*2+1] ];
-                  GET_POINT_DATA( p , ep0 , v0 );
-                  GET_POINT_DATA( p , ep1 , v1 );
-                  for(int c=0;c<nc;c++)
-                    {
-                    interpolatedValues[ e*pointDataComponents + pointArrayOffset[p] + c ] = v0[c] + t * ( v1[c] - v0[c] );
-                    }
-                  }
-                }
+        //  create output cell
+        if( interfaceCellType != VTK_EMPTY_CELL )
+          {
 
-              // copy point values
-              for(int e = 0;e<nInterfaceEdges;e++)
-                {
-                for(int a = 0;a<nPointData;a++)
-                  {
-                  DBG_ASSERT( nptId == Mats[m].outPointArrays[a]->GetNumberOfTuples() );
-                  Mats[m].outPointArrays[a]->InsertNextTuple( interpolatedValues + e*pointDataComponents + pointArrayOffset[a] );
-                  }
-                }
-              int pointsCopied = 0;
-              int prevMatInterfToBeAdded = 0;
-              if( this->FillMaterial )
+          // set type of cell
+          Mats[m].cellTypes.push_back( interfaceCellType );
+
+          // interpolate point values for cut edges
+          for(int e = 0;e<nInterfaceEdges;e++)
+            {
+            double t = interfaceWeights[e];
+            for(int p=0;p<nPointData;p++)
+              {
+              double v0[16];
+              double v1[16];
+              int nc = Mats[m].outPointArrays[p]->GetNumberOfComponents();
+              int ep0 = cell.pointIds[ interfaceEdges[e*2+0] ];
+              int ep1 = cell.pointIds[ interfaceEdges[e*2+1] ];
+              GET_POINT_DATA( p , ep0 , v0 );
+              GET_POINT_DATA( p , ep1 , v1 );
+              for(int c=0;c<nc;c++)
                 {
-                for(int p=0;p<nInsidePoints;p++)
-                  {
-                  vtkIdType ptId = cell.pointIds[ insidePointIds[p] ];
-                  if( ptId>=0 )
-                    {
-                    if( Mats[m].pointMap[ptId] == -1 )
-                      {
-                      vtkIdType nptId = Mats[m].pointCount + nInterfaceEdges + pointsCopied;
-                      Mats[m].pointMap[ptId] = nptId;
-                      pointsCopied++;
-                      for(int a = 0;a<nPointData;a++)
-                        {
-                        DBG_ASSERT( nptId == Mats[m].outPointArrays[a]->GetNumberOfTuples() );
-                        double tuple[16];
-                        GET_POINT_DATA( a, ptId, tuple );
-                        Mats[m].outPointArrays[a]->InsertNextTuple( tuple );
-                        }
-                      }
-                    }
-                  else
-                    {
-                    prevMatInterfToBeAdded++;
-                    }
-                  }
+                interpolatedValues[ e*pointDataComponents + pointArrayOffset[p] + c ] = v0[c] + t * ( v1[c] - v0[c] );
                 }
+              }
+            }
 
-              // Populate connectivity array and add extra points from previous
-              // edge intersections that are used but not inserted yet
-              int prevMatInterfAdded = 0;
-              Mats[m].cells.push_back( nOutCellPoints ); Mats[m].cellArrayCount++;
-              for( int p = 0; p < nOutCellPoints; ++ p )
+          // copy point values
+          for(int e = 0;e<nInterfaceEdges;e++)
+            {
+            for(int a = 0;a<nPointData;a++)
+              {
+              DBG_ASSERT( nptId == Mats[m].outPointArrays[a]->GetNumberOfTuples() );
+              Mats[m].outPointArrays[a]->InsertNextTuple( interpolatedValues + e*pointDataComponents + pointArrayOffset[a] );
+              }
+            Mats[m].addPointSource( -1 );
+            }
+          int pointsCopied = 0;
+          int prevMatInterfToBeAdded = 0;
+          if( this->FillMaterial )
+            {
+            for(int p=0;p<nInsidePoints;p++)
+              {
+              vtkIdType ptId = cell.pointIds[ insidePointIds[p] ];
+              if( ptId>=0 )
                 {
-                int nptId;
-                int pointIndex = outCellPointIds[p];
-                if( pointIndex >= 0 )
+                if( Mats[m].pointMap.Find(ptId) == -1 )
                   {
-                  // An original point is encountered (not an edge intersection)
-                  DBG_ASSERT( pointIndex>=0 && pointIndex<cell.np );
-                  int ptId = cell.pointIds[ pointIndex ];
-                  if( ptId >= 0 )
-                    {
-                    // Interface from a previous iteration
-                    DBG_ASSERT( ptId>=0 && ptId<nPoints );
-                    nptId = Mats[m].pointMap[ptId];
-                    }
-                  else
+                  vtkIdType nptId = Mats[m].pointCount + nInterfaceEdges + pointsCopied;
+                  Mats[m].pointMap.Set(ptId,nptId);
+                  Mats[m].addPointSource( ptId );
+                  pointsCopied++;
+                  for(int a = 0;a<nPointData;a++)
                     {
-                    nptId = Mats[m].pointCount + nInterfaceEdges + pointsCopied + prevMatInterfAdded;
-                    prevMatInterfAdded++;
-                    for(int a = 0;a<nPointData;a++)
-                      {
-                      DBG_ASSERT( nptId == Mats[m].outPointArrays[a]->GetNumberOfTuples() );
-                      double tuple[16];
-                      GET_POINT_DATA( a, ptId, tuple );
-                      Mats[m].outPointArrays[a]->InsertNextTuple( tuple );
-                      }
+                    DBG_ASSERT( nptId == Mats[m].outPointArrays[a]->GetNumberOfTuples() );
+                    double tuple[16];
+                    GET_POINT_DATA( a, ptId, tuple );
+                    Mats[m].outPointArrays[a]->InsertNextTuple( tuple );
                     }
                   }
-                else
-                  {
-                  int interfaceIndex = -pointIndex - 1;
-                  DBG_ASSERT( interfaceIndex>=0 && interfaceIndex<nInterfaceEdges );
-                  nptId = Mats[m].pointCount + interfaceIndex;
-                  }
-                DBG_ASSERT( nptId>=0 && nptId<(Mats[m].pointCount+nInterfaceEdges+pointsCopied+prevMatInterfToBeAdded) );
-                Mats[m].cells.push_back( nptId ); Mats[m].cellArrayCount++;
                 }
-
-              Mats[m].pointCount += nInterfaceEdges + pointsCopied + prevMatInterfAdded;
-
-              // Copy cell arrays
-              for(int a = 0;a<nCellData;a++)
+              else
                 {
-                Mats[m].outCellArrays[a]->InsertNextTuple( inCellArrays[a]->GetTuple(ci) );
+                prevMatInterfToBeAdded++;
                 }
-              Mats[m].cellCount ++;
-
-              // Check for equivalence between counters and container sizes
-              DBG_ASSERT( Mats[m].cellCount == Mats[m].cellTypes.size() );
-              DBG_ASSERT( Mats[m].cellArrayCount == Mats[m].cells.size() );
+              }
+            }
 
-              // Populate next iteration cell point coordinates
-              for(int i = 0;i<nextCell.np;i++)
+          // Populate connectivity array and add extra points from previous
+          // edge intersections that are used but not inserted yet
+          int prevMatInterfAdded = 0;
+          Mats[m].cells.push_back( nOutCellPoints ); Mats[m].cellArrayCount++;
+          for( int p = 0; p < nOutCellPoints; ++ p )
+            {
+            int nptId;
+            int pointIndex = outCellPointIds[p];
+            if( pointIndex >= 0 )
+              {
+              // An original point is encountered (not an edge intersection)
+              DBG_ASSERT( pointIndex>=0 && pointIndex<cell.np );
+              int ptId = cell.pointIds[ pointIndex ];
+              if( ptId >= 0 )
                 {
-                DBG_ASSERT( ( nextCell.pointIds[i]<0 && (-nextCell.pointIds[i]-1)<prevPointsMap.size() ) || ( nextCell.pointIds[i]>=0 && nextCell.pointIds[i]<nPoints ) );
-                GET_POINT_DATA( (nPointData-1) , nextCell.pointIds[i] , nextCell.points[i] );
+                // Interface from a previous iteration
+                DBG_ASSERT( ptId>=0 && ptId<nPoints );
+                nptId = Mats[m].pointMap.Find(ptId);
                 }
-
-              // for the convex point set, we need to first compute point coords before triangulation (no fixed topology)
-              if( nextCell.needTriangulation && mi<(nmat-1) && processedEfectiveMat<nEffectiveMat )
+              else
                 {
-                //                       for(int myi = 0;myi<nextCell.np;myi++)
-                //                       {
-                //                                cerr<<"p["<<myi<<"]=("<<nextCell.points[myi][0]<<','<<nextCell.points[myi][1]<<','<<nextCell.points[myi][2]<<") ";
-                //                       }
-                //                       cerr<<endl;
-
-                vtkcell->Initialize();
-                nextCell.nf = vtkcell->GetNumberOfFaces();
-                if( nextCell.dim == 3 )
-                  {
-                  vtkCell3D* cell3D = vtkCell3D::SafeDownCast( vtkcell );
-                  nextCell.nEdges = vtkcell->GetNumberOfEdges();
-                  for(int i = 0;i<nextCell.nEdges;i++)
-                    {
-                    int tmp[4];
-                    int * edgePoints = tmp;
-                    cell3D->GetEdgePoints(i,edgePoints);
-                    nextCell.edges[i][0] = edgePoints[0];
-                    DBG_ASSERT( nextCell.edges[i][0]>=0 && nextCell.edges[i][0]<nextCell.np );
-                    nextCell.edges[i][1] = edgePoints[1];
-                    DBG_ASSERT( nextCell.edges[i][1]>=0 && nextCell.edges[i][1]<nextCell.np );
-                    }
-                  }
-                nextCell.triangulationOk = ( vtkcell->Triangulate(ci,ptIds,pts) != 0 );
-                nextCell.ntri = 0;
-                if( nextCell.triangulationOk )
-                  {
-                  nextCell.ntri = ptIds->GetNumberOfIds() / (nextCell.dim+1);
-                  for(int i = 0;i<(nextCell.ntri*(nextCell.dim+1));i++)
-                    {
-                    vtkIdType j = ptIds->GetId(i); // cell ids have been set with local ids
-                    DBG_ASSERT( j>=0 && j<nextCell.np );
-                    nextCell.triangulation[i] = j;
-                    }
-                  }
-                else
+                nptId = Mats[m].pointCount + nInterfaceEdges + pointsCopied + prevMatInterfAdded;
+                prevMatInterfAdded++;
+                Mats[m].addPointSource( -1 );
+                for(int a = 0;a<nPointData;a++)
                   {
-                  debugStats_Triangulationfailed ++;
-                  vtkWarningMacro(<<"Triangulation failed. Info: cell "<<ci<<", material "<<mi<<", np="<<nextCell.np<<", nf="<<nextCell.nf<<", ne="<<nextCell.nEdges<<"\n");
+                  DBG_ASSERT( nptId == Mats[m].outPointArrays[a]->GetNumberOfTuples() );
+                  double tuple[16];
+                  GET_POINT_DATA( a, ptId, tuple );
+                  Mats[m].outPointArrays[a]->InsertNextTuple( tuple );
                   }
-                nextCell.needTriangulation = false;
-                vtkcell = 0;
                 }
-
-              // switch to next cell
-              cell = nextCell;
-
-              } // end of 'interface was found'
-
+              }
             else
               {
-              vtkcell = 0;
+              int interfaceIndex = -pointIndex - 1;
+              DBG_ASSERT( interfaceIndex>=0 && interfaceIndex<nInterfaceEdges );
+              nptId = Mats[m].pointCount + interfaceIndex;
               }
+            DBG_ASSERT( nptId>=0 && nptId<(Mats[m].pointCount+nInterfaceEdges+pointsCopied+prevMatInterfToBeAdded) );
+            Mats[m].cells.push_back( nptId ); Mats[m].cellArrayCount++;
+            }
 
-            } // end of 'cell is ok'
+          Mats[m].pointCount += nInterfaceEdges + pointsCopied + prevMatInterfAdded;
 
-//                      else // cell is ignored
-//                      {
-//                              //vtkWarningMacro(<<"ignoring cell #"<<ci<<", m="<<m<<", mi="<<mi<<", frac="<<fraction<<"\n");
-//                      }
+          // Cell arrays are copied from the input cell when the output is built
+          Mats[m].cellSources.push_back( ci );
+          Mats[m].cellCount ++;
 
-          // update reference volume
-          referenceVolume -= fraction;
+          // Check for equivalence between counters and container sizes
+          DBG_ASSERT( Mats[m].cellCount == Mats[m].cellTypes.size() );
+          DBG_ASSERT( Mats[m].cellArrayCount == Mats[m].cells.size() );
 
-          } // for materials
+          // Populate next iteration cell point coordinates
+          for(int i = 0;i<nextCell.np;i++)
+            {
+            DBG_ASSERT( ( nextCell.pointIds[i]<0 && (-nextCell.pointIds[i]-1)<prevPointsMap.size() ) || ( nextCell.pointIds[i]>=0 && nextCell.pointIds[i]<nPoints ) );
+            GET_POINT_DATA( (nPointData-1) , nextCell.pointIds[i] , nextCell.points[i] );
+            }
 
-        } // for cells
-      delete [] pointArrayOffset;
-      delete [] inPointArrays;
-      delete [] inCellArrays;
+          // for the convex point set, we need to first compute point coords before triangulation (no fixed topology)
+          if( nextCell.needTriangulation && mi<(nmat-1) && processedEfectiveMat<nEffectiveMat )
+            {
+            //                       for(int myi = 0;myi<nextCell.np;myi++)
+            //                       {
+            //                                cerr<<"p["<<myi<<"]=("<<nextCell.points[myi][0]<<','<<nextCell.points[myi][1]<<','<<nextCell.points[myi][2]<<") ";
+            //                       }
+            //                       cerr<<endl;
+
+            vtkcell->Initialize();
+            nextCell.nf = vtkcell->GetNumberOfFaces();
+            if( nextCell.dim == 3 )
+              {
+              vtkCell3D* cell3D = vtkCell3D::SafeDownCast( vtkcell );
+              nextCell.nEdges = vtkcell->GetNumberOfEdges();
+              for(int i = 0;i<nextCell.nEdges;i++)
+                {
+                int tmp[4];
+                int * edgePoints = tmp;
+                cell3D->GetEdgePoints(i,edgePoints);
+                nextCell.edges[i][0] = edgePoints[0];
+                DBG_ASSERT( nextCell.edges[i][0]>=0 && nextCell.edges[i][0]<nextCell.np );
+                nextCell.edges[i][1] = edgePoints[1];
+                DBG_ASSERT( nextCell.edges[i][1]>=0 && nextCell.edges[i][1]<nextCell.np );
+                }
+              }
+            nextCell.triangulationOk = ( vtkcell->Triangulate(ci,ptIds,pts) != 0 );
+            nextCell.ntri = 0;
+            if( nextCell.triangulationOk )
+              {
+              nextCell.ntri = ptIds->GetNumberOfIds() / (nextCell.dim+1);
+              for(int i = 0;i<(nextCell.ntri*(nextCell.dim+1));i++)
+                {
+                vtkIdType j = ptIds->GetId(i); // cell ids have been set with local ids
+                DBG_ASSERT( j>=0 && j<nextCell.np );
+                nextCell.triangulation[i] = j;
+                }
+              }
+            else
+              {
+              ws->triangulationFailed ++;
+              vtkWarningMacro(<<"Triangulation failed. Info: cell "<<ci<<", material "<<mi<<", np="<<nextCell.np<<", nf="<<nextCell.nf<<", ne="<<nextCell.nEdges<<"\n");
+              }
+            nextCell.needTriangulation = false;
+            vtkcell = 0;
+            }
 
-      ptIds->Delete();
-      pts->Delete();
-      cpsCell->Delete();
-      delete [] interpolatedValues;
-      delete [] matOrdering;
+          // switch to next cell
+          cell = nextCell;
 
-      // finish output creation
-      //       output->SetNumberOfBlocks( nmat );
-      for( int m=0;m<nmat;m++)
-        {
-        if( Mats[m].cellCount>0 && Mats[m].pointCount>0 )
+          } // end of 'interface was found'
+
+        else
           {
-          vtkDebugMacro(<<"Mat #"<<m<<" : cellCount="<<Mats[m].cellCount<<", numberOfCells="<<Mats[m].numberOfCells<<", pointCount="<<Mats[m].pointCount<<", numberOfPoints="<<Mats[m].numberOfPoints<<"\n");
+          vtkcell = 0;
           }
 
-        delete [] Mats[m].pointMap;
-
-        vtkSmartPointer<vtkUnstructuredGrid> ugOutput = vtkSmartPointer<vtkUnstructuredGrid>::New();
-
-        // set points
-        Mats[m].outPointArrays[nPointData-1]->Squeeze();
-        vtkPoints* points = vtkPoints::New();
-        points->SetDataTypeToDouble();
-        points->SetNumberOfPoints( Mats[m].pointCount );
-        points->SetData( Mats[m].outPointArrays[nPointData-1] );
-        Mats[m].outPointArrays[nPointData-1]->Delete();
-        ugOutput->SetPoints( points );
-        points->Delete();
-
-        // set cell connectivity
-        vtkIdTypeArray* cellArrayData = vtkIdTypeArray::New();
-        cellArrayData->SetNumberOfValues( Mats[m].cellArrayCount );
-        vtkIdType* cellArrayDataPtr = cellArrayData->WritePointer(0,Mats[m].cellArrayCount);
-        for(vtkIdType i = 0;i<Mats[m].cellArrayCount;i++) cellArrayDataPtr[i] = Mats[m].cells[i];
+        } // end of 'cell is ok'
 
-        vtkCellArray* cellArray = vtkCellArray::New();
-        cellArray->SetCells( Mats[m].cellCount , cellArrayData );
-        cellArrayData->Delete();
+//                      else // cell is ignored
+//                      {
+//                              //vtkWarningMacro(<<"ignoring cell #"<<ci<<", m="<<m<<", mi="<<mi<<", frac="<<fraction<<"\n");
+//                      }
 
-        // set cell types
-        vtkUnsignedCharArray *cellTypes = vtkUnsignedCharArray::New();
-        cellTypes->SetNumberOfValues( Mats[m].cellCount );
-        unsigned char* cellTypesPtr = cellTypes->WritePointer(0,Mats[m].cellCount);
-        for(vtkIdType i = 0;i<Mats[m].cellCount;i++) cellTypesPtr[i] = Mats[m].cellTypes[i];
+      // update reference volume
+      referenceVolume -= fraction;
 
-        // set cell locations
-        vtkIdTypeArray* cellLocations = vtkIdTypeArray::New();
-        cellLocations->SetNumberOfValues( Mats[m].cellCount );
-        vtkIdType counter = 0;
-        for(vtkIdType i = 0;i<Mats[m].cellCount;i++)
-          {
-          cellLocations->SetValue(i,counter);
-          counter += Mats[m].cells[counter] + 1;
-          }
+      } // for materials
 
-        // attach conectivity arrays to data set
-        ugOutput->SetCells( cellTypes, cellLocations, cellArray );
-        cellArray->Delete();
-        cellTypes->Delete();
-        cellLocations->Delete();
+    } // for cells
+}
 
-        // attach point arrays
-        for(int i = 0;i<nPointData-1;i++)
-          {
-          Mats[m].outPointArrays[i]->Squeeze();
-          ugOutput->GetPointData()->AddArray( Mats[m].outPointArrays[i] );
-          Mats[m].outPointArrays[i]->Delete();
-          }
+//-----------------------------------------------------------------------------
+void vtkYoungsMaterialInterface::ProcessCellsInParallel(
+  vtkYoungsMaterialInterface_Block* block,
+  vtkYoungsMaterialInterface_Mat* Mats,
+  vtkYoungsMaterialInterface_Workspace* ws )
+{
+  // a few chunks per thread balance the load, the cells of a chunk being
+  // processed in order as in the serial path
+  const vtkIdType minCellsPerChunk = 1000;
+  vtkIdType nCells = block->input->GetNumberOfCells();
+  vtkIdType nChunks = std::min( nCells / minCellsPerChunk + 1,
+    static_cast<vtkIdType>( 4 * vtkSMPTools::GetEstimatedNumberOfThreads() ) );
+  nChunks = std::max( nChunks, static_cast<vtkIdType>(1) );
+
+  // make sure the cells are built before the threads query them
+  if( nCells > 0 )
+    {
+    block->input->GetCell( 0, ws->genericCell );
+    }
 
-        // attach cell arrays
-        for(int i = 0;i<nCellData;i++)
-          {
-          Mats[m].outCellArrays[i]->Squeeze();
-          ugOutput->GetCellData()->AddArray( Mats[m].outCellArrays[i] );
-          Mats[m].outCellArrays[i]->Delete();
-          }
+  std::vector<vtkYoungsMaterialInterface_Chunk*> chunks( nChunks );
+  for( vtkIdType k = 0; k < nChunks; ++ k )
+    {
+    chunks[k] = new vtkYoungsMaterialInterface_Chunk(
+      block, Mats, nCells * k / nChunks, nCells * ( k + 1 ) / nChunks );
+    }
+  vtkYoungsMaterialInterface_ChunkFunctor functor( this, block, chunks );
+  vtkSMPTools::For( 0, nChunks, 1, functor );
 
-        delete [] Mats[m].outCellArrays;
-        delete [] Mats[m].outPointArrays;
+  // merge the chunks in order. The input points copied by several chunks
+  // are only kept the first time, as in the serial path.
+  for( int m = 0; m < block->nmat; ++ m )
+    {
+    vtkYoungsMaterialInterface_Mat& mat = Mats[m];
+    vtkIdType nOutCells = 0;
+    vtkIdType nOutPoints = 0;
+    vtkIdType nOutValues = 0;
+    for( vtkIdType k = 0; k < nChunks; ++ k )
+      {
+      nOutCells += chunks[k]->Mats[m].cellCount;
+      nOutPoints += chunks[k]->Mats[m].pointCount;
+      nOutValues += chunks[k]->Mats[m].cellArrayCount;
+      }
+    mat.numberOfCells = nOutCells;
+    mat.numberOfPoints = nOutPoints;
+    for( int i = 0; i < block->nPointData; ++ i )
+      {
+      mat.outPointArrays[i]->Allocate( nOutPoints * mat.outPointArrays[i]->GetNumberOfComponents() );
+      }
+    mat.cellTypes.reserve( nOutCells );
+    mat.cellSources.reserve( nOutCells );
+    mat.cells.reserve( nOutValues );
+    mat.pointMap.Initialize( block->nPoints, true );
 
-        // activate attributes similarly to input
-        for ( int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; ++ i )
+    std::vector<vtkIdType> newIds;
+    for( vtkIdType k = 0; k < nChunks; ++ k )
+      {
+      vtkYoungsMaterialInterface_Mat& chunkMat = chunks[k]->Mats[m];
+      newIds.resize( chunkMat.pointCount );
+      for( vtkIdType p = 0; p < chunkMat.pointCount; ++ p )
+        {
+        vtkIdType ptId = chunkMat.pointSources[p];
+        vtkIdType id = ( ptId >= 0 ) ? mat.pointMap.Find( ptId ) : -1;
+        if( id == -1 )
           {
-          vtkDataArray* attr = input->GetCellData()->GetAttribute(i);
-          if( attr!=0 )
+          id = mat.pointCount ++;
+          for( int a = 0; a < block->nPointData; ++ a )
             {
-            ugOutput->GetCellData()->SetActiveAttribute(attr->GetName(),i);
+            mat.outPointArrays[a]->InsertNextTuple( p, chunkMat.outPointArrays[a] );
             }
-          }
-        for ( int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; ++ i )
-          {
-          vtkDataArray* attr = input->GetPointData()->GetAttribute(i);
-          if( attr!=0 )
+          if( ptId >= 0 )
             {
-            ugOutput->GetPointData()->SetActiveAttribute(attr->GetName(),i);
+            mat.pointMap.Set( ptId, id );
             }
           }
+        newIds[p] = id;
+        }
 
-        // add material data set to multiblock output
-        if( ugOutput && ugOutput->GetNumberOfCells()>0 )
+      for( vtkIdType i = 0; i < chunkMat.cellArrayCount; )
+        {
+        vtkIdType npts = chunkMat.cells[i ++];
+        mat.cells.push_back( npts );
+        for( vtkIdType j = 0; j < npts; ++ j, ++ i )
           {
-          int domain = inputsPerMaterial[m];
-          outputBlocks[ domain * nmat + m ] = ugOutput;
-          ++ inputsPerMaterial[m];
+          vtkIdType id = chunkMat.cells[i];
+          mat.cells.push_back( ( id >= 0 ) ? newIds[id] : id );
           }
         }
-      delete [] Mats;
-    } // Iterate over input blocks
-
-  delete [] inputsPerMaterial;
-
-  if ( debugStats_PrimaryTriangulationfailed )
-    {
-    vtkDebugMacro(<<"PrimaryTriangulationfailed "<<debugStats_PrimaryTriangulationfailed<<"\n");
-    }
-  if ( debugStats_Triangulationfailed )
-    {
-    vtkDebugMacro(<<"Triangulationfailed "<<debugStats_Triangulationfailed<<"\n");
-    }
-  if ( debugStats_NullNormal )
-    {
-    vtkDebugMacro(<<"NullNormal "<<debugStats_NullNormal<<"\n");
-    }
-  if( debugStats_NoInterfaceFound )
-    {
-    vtkDebugMacro(<<"NoInterfaceFound "<<debugStats_NoInterfaceFound<<"\n");
-    }
-
-  // Build final composite output. also tagging blocks with their associated Id
-  vtkDebugMacro(<<this->NumberOfDomains<<" Domains, "<<nmat<<" Materials\n");
-
-  output->SetNumberOfBlocks(0);
-  output->SetNumberOfBlocks(nmat);
-
-  for ( int m = 0; m < nmat; ++ m )
-    {
-    vtkMultiBlockDataSet* matBlock = vtkMultiBlockDataSet::New();
-    matBlock->SetNumberOfBlocks(this->NumberOfDomains);
-    output->SetBlock(m, matBlock);
-    matBlock->Delete();
+      mat.cellArrayCount += chunkMat.cellArrayCount;
+      mat.cellTypes.insert( mat.cellTypes.end(), chunkMat.cellTypes.begin(), chunkMat.cellTypes.end() );
+      mat.cellSources.insert( mat.cellSources.end(), chunkMat.cellSources.begin(), chunkMat.cellSources.end() );
+      mat.cellCount += chunkMat.cellCount;
+      }
     }
 
-  int blockIndex=0;
-  for( std::map<int,vtkSmartPointer<vtkUnstructuredGrid> >::iterator it=outputBlocks.begin();
-       it!=outputBlocks.end(); ++ it, ++ blockIndex )
+  for( vtkIdType k = 0; k < nChunks; ++ k )
     {
-    if( it->second->GetNumberOfCells() > 0 )
-      {
-      int mat = it->first % nmat;
-      int dom = it->first / nmat;
-      vtkMultiBlockDataSet* matBlock = vtkMultiBlockDataSet::SafeDownCast(output->GetBlock(mat));
-      matBlock->SetBlock(dom,it->second);
-      }
+    ws->AddStatistics( chunks[k]->workspace );
+    delete chunks[k];
     }
-
-  return 1;
 }
 
 #undef GET_POINT_DATA
@@ -40,6 +40,9 @@ class vtkIntArray;
 class vtkInformation;
 class vtkInformationVector;
 class vtkYoungsMaterialInterfaceInternals;
+struct vtkYoungsMaterialInterface_Block;
+struct vtkYoungsMaterialInterface_Mat;
+struct vtkYoungsMaterialInterface_Workspace;
 
 class VTKFILTERSGENERAL_EXPORT vtkYoungsMaterialInterface : public vtkMultiBlockDataSetAlgorithm
 {
@@ -105,6 +108,14 @@ public:
   vtkGetMacro(UseAllBlocks,bool);
   vtkBooleanMacro(UseAllBlocks,bool);
 
+  // Description:
+  // When on, the cells of each input block are processed in parallel, in
+  // chunks whose outputs are then merged in cell order, so that the output
+  // is the same as with the option off. Off by default.
+  vtkSetMacro(ReconstructInParallel,int);
+  vtkGetMacro(ReconstructInParallel,int);
+  vtkBooleanMacro(ReconstructInParallel,int);
+
   // Description:
   // Only meaningfull for LOVE software. returns the maximum number of blocks conatining the same material
   vtkGetMacro(NumberOfDomains,int);
@@ -161,6 +172,22 @@ protected:
 
   int CellProduceInterface( int dim, int np, double fraction, double minFrac, double maxFrac );
 
+  // Description:
+  // Reconstructs the interfaces of the cells [begin,end) of a block,
+  // appending them to the per-material outputs Mats.
+  void ProcessCells( vtkYoungsMaterialInterface_Block* block,
+                     vtkYoungsMaterialInterface_Mat* Mats,
+                     vtkIdType begin, vtkIdType end,
+                     vtkYoungsMaterialInterface_Workspace* ws );
+
+  // Description:
+  // Same as ProcessCells() over all the cells of a block, with chunks of
+  // cells processed in parallel into their own outputs, which are merged
+  // into Mats afterwards.
+  void ProcessCellsInParallel( vtkYoungsMaterialInterface_Block* block,
+                               vtkYoungsMaterialInterface_Mat* Mats,
+                               vtkYoungsMaterialInterface_Workspace* ws );
+
   // Description:
   // Read-Write Properties
   int FillMaterial;
@@ -174,6 +201,7 @@ protected:
   vtkSmartPointer<vtkIntArray> MaterialBlockMapping;
 //ETX
   bool UseAllBlocks;
+  int ReconstructInParallel;
 
   // Description:
   // Read only properties
@@ -183,6 +211,8 @@ protected:
   // Internal data structures
   vtkYoungsMaterialInterfaceInternals* Internals;
 
+  friend class vtkYoungsMaterialInterfaceInternals;
+
 private:
   vtkYoungsMaterialInterface(const vtkYoungsMaterialInterface&); // Not implemented
   void operator=(const vtkYoungsMaterialInterface&); // Not implemented
@@ -0,0 +1,306 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetSurfaceFaceHash.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkDataSetSurfaceFilter extracts the same surface from
+// unstructured grids with HashFacesInParallel on as with it off, for
+// linear cells of several types and for quadratic cells with and without
+// subdivision.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace
+{
+
+const int Res = 12;
+
+vtkIdType PointId(int i, int j, int k)
+{
+  return i + (Res + 1) * (j + (Res + 1) * k);
+}
+
+// A block of cells on a grid of points, with scalars on the points and
+// cells. Cells are hexahedra, wedges, tetrahedra, voxels and pyramids,
+// plus a line and a quad on the boundary.
+void BuildLinearGrid(vtkUnstructuredGrid *grid)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  for (int k = 0; k <= Res; ++k)
+    {
+    for (int j = 0; j <= Res; ++j)
+      {
+      for (int i = 0; i <= Res; ++i)
+        {
+        points->InsertNextPoint(i, j, k);
+        pointScalars->InsertNextValue(i + 2 * j + 3 * k);
+        }
+      }
+    }
+  grid->SetPoints(points.GetPointer());
+  grid->GetPointData()->SetScalars(pointScalars.GetPointer());
+  grid->Allocate(6 * Res * Res * Res);
+
+  for (int k = 0; k < Res; ++k)
+    {
+    for (int j = 0; j < Res; ++j)
+      {
+      for (int i = 0; i < Res; ++i)
+        {
+        vtkIdType p[8] = { PointId(i, j, k), PointId(i + 1, j, k),
+                           PointId(i + 1, j + 1, k), PointId(i, j + 1, k),
+                           PointId(i, j, k + 1), PointId(i + 1, j, k + 1),
+                           PointId(i + 1, j + 1, k + 1),
+                           PointId(i, j + 1, k + 1) };
+        switch ((i + j + k) % 4)
+          {
+          case 0:
+            grid->InsertNextCell(VTK_HEXAHEDRON, 8, p);
+            break;
+          case 1:
+            {
+            vtkIdType w0[6] = { p[0], p[1], p[3], p[4], p[5], p[7] };
+            vtkIdType w1[6] = { p[1], p[2], p[3], p[5], p[6], p[7] };
+            grid->InsertNextCell(VTK_WEDGE, 6, w0);
+            grid->InsertNextCell(VTK_WEDGE, 6, w1);
+            }
+            break;
+          case 2:
+            {
+            vtkIdType t[5][4] = { { p[0], p[1], p[3], p[4] },
+                                  { p[1], p[2], p[3], p[6] },
+                                  { p[1], p[4], p[5], p[6] },
+                                  { p[3], p[4], p[6], p[7] },
+                                  { p[1], p[3], p[4], p[6] } };
+            for (int n = 0; n < 5; ++n)
+              {
+              grid->InsertNextCell(VTK_TETRA, 4, t[n]);
+              }
+            }
+            break;
+          default:
+            {
+            vtkIdType v[8] = { p[0], p[1], p[3], p[2], p[4], p[5], p[7],
+                               p[6] };
+            grid->InsertNextCell(VTK_VOXEL, 8, v);
+            }
+          }
+        }
+      }
+    }
+  vtkIdType pyramid[5] = { PointId(0, 0, Res), PointId(1, 0, Res),
+                           PointId(1, 1, Res), PointId(0, 1, Res),
+                           PointId(0, 0, Res) };
+  pyramid[4] = points->InsertNextPoint(0.5, 0.5, Res + 1);
+  pointScalars->InsertNextValue(-1.0);
+  grid->InsertNextCell(VTK_PYRAMID, 5, pyramid);
+  vtkIdType line[2] = { PointId(0, 0, 0), PointId(Res, 0, 0) };
+  grid->InsertNextCell(VTK_LINE, 2, line);
+  vtkIdType quad[4] = { PointId(0, 0, 0), PointId(0, 1, 0),
+                        PointId(1, 1, 0), PointId(1, 0, 0) };
+  grid->InsertNextCell(VTK_QUAD, 4, quad);
+
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+    {
+    cellScalars->InsertNextValue(i);
+    }
+  grid->GetCellData()->SetScalars(cellScalars.GetPointer());
+}
+
+// A block of quadratic hexahedra sharing their edge midpoints.
+void BuildQuadraticGrid(vtkUnstructuredGrid *grid)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  for (int k = 0; k <= Res; ++k)
+    {
+    for (int j = 0; j <= Res; ++j)
+      {
+      for (int i = 0; i <= Res; ++i)
+        {
+        points->InsertNextPoint(i, j, k);
+        pointScalars->InsertNextValue(i * j + k);
+        }
+      }
+    }
+  grid->Allocate(Res * Res * Res);
+
+  const int edges[12][2] = { {0,1}, {1,2}, {2,3}, {3,0}, {4,5}, {5,6},
+                             {6,7}, {7,4}, {0,4}, {1,5}, {2,6}, {3,7} };
+  std::map<std::pair<vtkIdType, vtkIdType>, vtkIdType> midpoints;
+  for (int k = 0; k < Res; ++k)
+    {
+    for (int j = 0; j < Res; ++j)
+      {
+      for (int i = 0; i < Res; ++i)
+        {
+        vtkIdType p[20] = { PointId(i, j, k), PointId(i + 1, j, k),
+                            PointId(i + 1, j + 1, k), PointId(i, j + 1, k),
+                            PointId(i, j, k + 1), PointId(i + 1, j, k + 1),
+                            PointId(i + 1, j + 1, k + 1),
+                            PointId(i, j + 1, k + 1) };
+        for (int e = 0; e < 12; ++e)
+          {
+          vtkIdType a = p[edges[e][0]], b = p[edges[e][1]];
+          std::pair<vtkIdType, vtkIdType> edge(std::min(a, b),
+                                               std::max(a, b));
+          if (midpoints.find(edge) == midpoints.end())
+            {
+            double x[3], y[3];
+            points->GetPoint(a, x);
+            points->GetPoint(b, y);
+            midpoints[edge] = points->InsertNextPoint(
+              0.5 * (x[0] + y[0]), 0.5 * (x[1] + y[1]), 0.5 * (x[2] + y[2]));
+            pointScalars->InsertNextValue(-e);
+            }
+          p[8 + e] = midpoints[edge];
+          }
+        grid->InsertNextCell(VTK_QUADRATIC_HEXAHEDRON, 20, p);
+        }
+      }
+    }
+  grid->SetPoints(points.GetPointer());
+  grid->GetPointData()->SetScalars(pointScalars.GetPointer());
+}
+
+bool SameArrays(vtkDataArray *a, vtkDataArray *b)
+{
+  if (!a && !b)
+    {
+    return true;
+    }
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+      {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+// Extracts the surface of grid with the serial and the parallel face hash,
+// and compares the outputs.
+bool Check(vtkUnstructuredGrid *grid, int subdivisionLevel,
+           vtkIdType expectedPolys, const char *what)
+{
+  vtkNew<vtkDataSetSurfaceFilter> surface;
+  surface->SetInputData(grid);
+  surface->SetNonlinearSubdivisionLevel(subdivisionLevel);
+  surface->PassThroughCellIdsOn();
+  surface->PassThroughPointIdsOn();
+  surface->HashFacesInParallelOff();
+  surface->Update();
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(surface->GetOutput());
+
+  surface->HashFacesInParallelOn();
+  surface->Update();
+  vtkPolyData *output = surface->GetOutput();
+
+  if (expectedPolys >= 0 && expected->GetNumberOfPolys() != expectedPolys)
+    {
+    cerr << what << ": " << expected->GetNumberOfPolys()
+         << " polygons instead of " << expectedPolys << endl;
+    return false;
+    }
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+      output->GetNumberOfCells() != expected->GetNumberOfCells() ||
+      output->GetNumberOfPolys() != expected->GetNumberOfPolys() ||
+      output->GetNumberOfLines() != expected->GetNumberOfLines())
+    {
+    cerr << what << ": " << output->GetNumberOfPoints() << " points and "
+         << output->GetNumberOfCells() << " cells instead of "
+         << expected->GetNumberOfPoints() << " and "
+         << expected->GetNumberOfCells() << endl;
+    return false;
+    }
+  if (!SameArrays(expected->GetPoints()->GetData(),
+                  output->GetPoints()->GetData()) ||
+      !SameArrays(expected->GetPointData()->GetScalars(),
+                  output->GetPointData()->GetScalars()) ||
+      !SameArrays(expected->GetCellData()->GetScalars(),
+                  output->GetCellData()->GetScalars()) ||
+      !SameArrays(expected->GetPointData()->GetArray("vtkOriginalPointIds"),
+                  output->GetPointData()->GetArray("vtkOriginalPointIds")) ||
+      !SameArrays(expected->GetCellData()->GetArray("vtkOriginalCellIds"),
+                  output->GetCellData()->GetArray("vtkOriginalCellIds")))
+    {
+    cerr << what << ": different points or attributes" << endl;
+    return false;
+    }
+  vtkNew<vtkIdList> expectedPts, outputPts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+    {
+    expected->GetCellPoints(cellId, expectedPts.GetPointer());
+    output->GetCellPoints(cellId, outputPts.GetPointer());
+    bool same = expectedPts->GetNumberOfIds() == outputPts->GetNumberOfIds();
+    for (vtkIdType i = 0; same && i < outputPts->GetNumberOfIds(); ++i)
+      {
+      same = expectedPts->GetId(i) == outputPts->GetId(i);
+      }
+    if (!same)
+      {
+      cerr << what << ": different cell " << cellId << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int TestDataSetSurfaceFaceHash(int, char *[])
+{
+  vtkNew<vtkUnstructuredGrid> linear;
+  BuildLinearGrid(linear.GetPointer());
+  vtkNew<vtkUnstructuredGrid> quadratic;
+  BuildQuadraticGrid(quadratic.GetPointer());
+
+  // Inside the linear block, faces split differently by the cells on each
+  // side remain in the surface, hence no expected number of polygons.
+  if (!Check(linear.GetPointer(), 1, -1, "Linear cells") ||
+      !Check(quadratic.GetPointer(), 0, 6 * Res * Res, "Quadratic cells") ||
+      !Check(quadratic.GetPointer(), 1, -1, "Subdivided quadratic cells") ||
+      !Check(quadratic.GetPointer(), 2, -1,
+             "Quadratic cells subdivided twice"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,250 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSurfaceMeshCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkDataSetSurfaceFilter, vtkGeometryFilter and vtkThreshold
+// reuse their output mesh when only the input attributes change, and
+// extract it again when the input geometry changes.
+
+#include <iostream>
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkGeometryFilter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+
+// Two hexahedra side by side, with a point and a cell scalar.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid()
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid =
+    vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  for (int k = 0; k < 2; ++k)
+    {
+    for (int j = 0; j < 2; ++j)
+      {
+      for (int i = 0; i < 3; ++i)
+        {
+        points->InsertNextPoint(i, j, k);
+        }
+      }
+    }
+  grid->SetPoints(points);
+  grid->Allocate(2);
+  for (vtkIdType i = 0; i < 2; ++i)
+    {
+    vtkIdType pts[8] = { i, i + 1, i + 4, i + 3,
+                         i + 6, i + 7, i + 10, i + 9 };
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+    }
+
+  vtkSmartPointer<vtkDoubleArray> pointScalars =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  pointScalars->SetName("PointScalars");
+  vtkSmartPointer<vtkDoubleArray> cellScalars =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  cellScalars->SetName("CellScalars");
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+    {
+    pointScalars->InsertNextValue(i);
+    }
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+    {
+    cellScalars->InsertNextValue(i);
+    }
+  grid->GetPointData()->SetScalars(pointScalars);
+  grid->GetCellData()->AddArray(cellScalars);
+  return grid;
+}
+
+// Scale the point scalars of grid, changing its attributes only.
+void ScaleAttributes(vtkUnstructuredGrid *grid, double factor)
+{
+  vtkDoubleArray *array = vtkDoubleArray::SafeDownCast(
+    grid->GetPointData()->GetArray("PointScalars"));
+  for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+    {
+    array->SetValue(i, factor * i);
+    }
+  array->Modified();
+}
+
+// Check that the point scalars of output are those of the input points
+// given by originalIds.
+bool CheckAttributes(vtkDataSet *output, vtkIdTypeArray *originalIds,
+                     double factor)
+{
+  vtkDataArray *array = output->GetPointData()->GetArray("PointScalars");
+  if (!array || !originalIds ||
+      array->GetNumberOfTuples() != output->GetNumberOfPoints() ||
+      originalIds->GetNumberOfTuples() != output->GetNumberOfPoints())
+    {
+    std::cerr << "Missing or truncated point data" << std::endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    if (array->GetTuple1(i) != factor * originalIds->GetValue(i))
+      {
+      std::cerr << "Wrong value at point " << i << ": "
+                << array->GetTuple1(i) << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+bool TestSurfaceFilter()
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid();
+  vtkSmartPointer<vtkDataSetSurfaceFilter> surface =
+    vtkSmartPointer<vtkDataSetSurfaceFilter>::New();
+  surface->SetInputData(grid);
+  surface->PassThroughPointIdsOn();
+  surface->CacheMeshOn();
+  surface->Update();
+
+  vtkPolyData *output = surface->GetOutput();
+  vtkCellArray *polys = output->GetPolys();
+  if (output->GetNumberOfCells() != 10)
+    {
+    std::cerr << "Expected 10 faces, got " << output->GetNumberOfCells()
+              << std::endl;
+    return false;
+    }
+
+  ScaleAttributes(grid, 2.0);
+  surface->Update();
+  if (output->GetPolys() != polys)
+    {
+    std::cerr << "The surface was extracted again" << std::endl;
+    return false;
+    }
+  if (output->GetCellData()->GetArray("vtkOriginalCellIds") ||
+      output->GetCellData()->GetArray("vtkSurfaceCacheCellIds") ||
+      !output->GetCellData()->GetArray("CellScalars"))
+    {
+    std::cerr << "Wrong cell arrays" << std::endl;
+    return false;
+    }
+  if (!CheckAttributes(output, vtkIdTypeArray::SafeDownCast(
+        output->GetPointData()->GetArray("vtkOriginalPointIds")), 2.0))
+    {
+    return false;
+    }
+
+  grid->GetPoints()->SetPoint(0, -1.0, 0.0, 0.0);
+  grid->GetPoints()->Modified();
+  surface->Update();
+  if (output->GetPolys() == polys)
+    {
+    std::cerr << "The surface was not extracted again" << std::endl;
+    return false;
+    }
+  return true;
+}
+
+bool TestGeometryFilter()
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid();
+  vtkSmartPointer<vtkGeometryFilter> geometry =
+    vtkSmartPointer<vtkGeometryFilter>::New();
+  geometry->SetInputData(grid);
+  geometry->CacheMeshOn();
+  geometry->Update();
+
+  vtkPolyData *output = geometry->GetOutput();
+  vtkCellArray *polys = output->GetPolys();
+
+  ScaleAttributes(grid, 3.0);
+  geometry->Update();
+  if (output->GetPolys() != polys)
+    {
+    std::cerr << "The geometry was extracted again" << std::endl;
+    return false;
+    }
+  vtkDataArray *array = output->GetPointData()->GetArray("PointScalars");
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    if (array->GetTuple1(i) != 3.0 * i)
+      {
+      std::cerr << "Wrong value at point " << i << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+bool TestThreshold()
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid();
+  vtkSmartPointer<vtkThreshold> threshold =
+    vtkSmartPointer<vtkThreshold>::New();
+  threshold->SetInputData(grid);
+  threshold->SetInputArrayToProcess(0, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_CELLS, "CellScalars");
+  threshold->ThresholdByUpper(0.5);
+  threshold->CacheMeshOn();
+  threshold->Update();
+
+  vtkUnstructuredGrid *output = threshold->GetOutput();
+  vtkCellArray *cells = output->GetCells();
+  if (output->GetNumberOfCells() != 1)
+    {
+    std::cerr << "Expected 1 cell, got " << output->GetNumberOfCells()
+              << std::endl;
+    return false;
+    }
+
+  ScaleAttributes(grid, 4.0);
+  threshold->Update();
+  if (output->GetCells() != cells ||
+      output->GetPointData()->GetArray("PointScalars")->GetTuple1(0) != 4.0)
+    {
+    std::cerr << "The attributes were not re-mapped" << std::endl;
+    return false;
+    }
+
+  // Changing the thresholded array must threshold again.
+  grid->GetCellData()->GetArray("CellScalars")->SetTuple1(0, 1.0);
+  grid->GetCellData()->GetArray("CellScalars")->Modified();
+  threshold->Update();
+  if (output->GetNumberOfCells() != 2)
+    {
+    std::cerr << "The threshold was not applied again" << std::endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+int TestSurfaceMeshCache(int, char *[])
+{
+  if (!TestSurfaceFilter() || !TestGeometryFilter() || !TestThreshold())
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkDataSetSurfaceFilter.h"
 
+#include "vtkAttributeRemapCache.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
@@ -29,6 +30,9 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPyramid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -47,6 +51,7 @@
 
 #include <algorithm>
 #include <vtksys/hash_map.hxx>
+#include <vector>
 
 #include <cassert>
 
@@ -99,6 +104,433 @@ protected:
   MapType Map;
 };
 
+//----------------------------------------------------------------------------
+namespace
+{
+// The faces of the 3D cells, in the order the InsertXXXInHash() methods
+// would receive them, with their points in the order these methods store.
+enum vtkSurfaceFaceKind
+{
+  vtkSurfaceTriangle,
+  vtkSurfaceQuad,
+  vtkSurfacePolygon
+};
+
+struct vtkSurfaceFaces
+{
+  std::vector<vtkIdType> Ids;
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> CellIds;
+  std::vector<unsigned char> Kinds;
+
+  void AddFace(int kind, vtkIdType cellId)
+  {
+    this->Offsets.push_back(static_cast<vtkIdType>(this->Ids.size()));
+    this->CellIds.push_back(cellId);
+    this->Kinds.push_back(static_cast<unsigned char>(kind));
+  }
+
+  // Same order as InsertTriInHash().
+  void AddTriangle(vtkIdType a, vtkIdType b, vtkIdType c, vtkIdType cellId)
+  {
+    this->AddFace(vtkSurfaceTriangle, cellId);
+    if (b < a && b < c)
+      {
+      std::swap(a, b);
+      std::swap(b, c);
+      }
+    else if (c < a && c < b)
+      {
+      std::swap(a, c);
+      std::swap(b, c);
+      }
+    this->Ids.push_back(a);
+    this->Ids.push_back(b);
+    this->Ids.push_back(c);
+  }
+
+  // Same order as InsertQuadInHash().
+  void AddQuad(vtkIdType a, vtkIdType b, vtkIdType c, vtkIdType d,
+               vtkIdType cellId)
+  {
+    this->AddFace(vtkSurfaceQuad, cellId);
+    vtkIdType ids[4] = { a, b, c, d };
+    int first = 0;
+    if (b < a && b < c && b < d)
+      {
+      first = 1;
+      }
+    else if (c < a && c < b && c < d)
+      {
+      first = 2;
+      }
+    else if (d < a && d < b && d < c)
+      {
+      first = 3;
+      }
+    for (int i = 0; i < 4; ++i)
+      {
+      this->Ids.push_back(ids[(first + i) % 4]);
+      }
+  }
+
+  // Same order as InsertPolygonInHash().
+  void AddPolygon(const vtkIdType *ids, int numPts, vtkIdType cellId)
+  {
+    this->AddFace(vtkSurfacePolygon, cellId);
+    int first = 0;
+    for (int i = 0; i < numPts; ++i)
+      {
+      if (ids[i] < ids[first])
+        {
+        first = i;
+        }
+      }
+    for (int i = 0; i < numPts; ++i)
+      {
+      this->Ids.push_back(ids[(first + i) % numPts]);
+      }
+  }
+
+  vtkIdType GetNumberOfFaces() const
+  {
+    return static_cast<vtkIdType>(this->Offsets.size());
+  }
+};
+
+// Whether face a, hashed by the method of its kind, matches face b of the
+// same bin, as this method decides it.
+bool vtkSurfaceFacesMatch(int kind, const vtkIdType *a, vtkIdType numA,
+                          const vtkIdType *b, vtkIdType numB)
+{
+  if (kind == vtkSurfaceQuad)
+    {
+    return numB == 4 && a[2] == b[2] &&
+      ((a[1] == b[1] && a[3] == b[3]) || (a[1] == b[3] && a[3] == b[1]));
+    }
+  if (kind == vtkSurfaceTriangle)
+    {
+    return numB == 3 &&
+      ((a[1] == b[1] && a[2] == b[2]) || (a[1] == b[2] && a[2] == b[1]));
+    }
+  if (numA != numB || a[0] != b[0])
+    {
+    return false;
+    }
+  if (a[1] == b[1])
+    {
+    for (vtkIdType i = 2; i < numA; ++i)
+      {
+      if (a[i] != b[i])
+        {
+        return false;
+        }
+      }
+    }
+  else
+    {
+    for (vtkIdType i = 1; i < numA; ++i)
+      {
+      if (a[numA - i] != b[i])
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+// Extracts the faces of the 3D cells of chunks of Chunk cells, and marks
+// these cells as hashed.
+struct vtkSurfaceExtractFaces
+{
+  static const vtkIdType Chunk = 1024;
+
+  vtkUnstructuredGrid *Input;
+  vtkIdType NumberOfCells;
+  int NonlinearSubdivisionLevel;
+  vtkSurfaceFaces *Faces;
+  unsigned char *Hashed;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkIdList> Pts;
+  vtkSMPThreadLocalObject<vtkIdList> Neighbors;
+  vtkSMPThreadLocalObject<vtkPoints> Coords;
+  vtkSMPThreadLocal<vtkIdType> UnknownFaces;
+
+  void Initialize()
+  {
+    this->UnknownFaces.Local() = 0;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+      vtkIdType endCellId =
+        std::min((chunk + 1) * Chunk, this->NumberOfCells);
+      for (vtkIdType cellId = chunk * Chunk; cellId < endCellId; ++cellId)
+        {
+        this->Hashed[cellId] = this->ExtractFaces(cellId, this->Faces[chunk]);
+        }
+      }
+  }
+
+  // The same faces as UnstructuredGridExecute() inserts in the hash.
+  unsigned char ExtractFaces(vtkIdType cellId, vtkSurfaceFaces &faces)
+  {
+    vtkIdType npts, *ids;
+    switch (this->Input->GetCellType(cellId))
+      {
+      case VTK_VERTEX:
+      case VTK_POLY_VERTEX:
+      case VTK_LINE:
+      case VTK_POLY_LINE:
+      case VTK_PIXEL:
+      case VTK_QUAD:
+      case VTK_TRIANGLE:
+      case VTK_POLYGON:
+      case VTK_TRIANGLE_STRIP:
+      case VTK_QUADRATIC_TRIANGLE:
+      case VTK_BIQUADRATIC_TRIANGLE:
+      case VTK_QUADRATIC_QUAD:
+      case VTK_QUADRATIC_LINEAR_QUAD:
+      case VTK_BIQUADRATIC_QUAD:
+      case VTK_QUADRATIC_POLYGON:
+        return 0;
+
+      case VTK_HEXAHEDRON:
+        this->Input->GetCellPoints(cellId, npts, ids);
+        faces.AddQuad(ids[0], ids[1], ids[5], ids[4], cellId);
+        faces.AddQuad(ids[0], ids[3], ids[2], ids[1], cellId);
+        faces.AddQuad(ids[0], ids[4], ids[7], ids[3], cellId);
+        faces.AddQuad(ids[1], ids[2], ids[6], ids[5], cellId);
+        faces.AddQuad(ids[2], ids[3], ids[7], ids[6], cellId);
+        faces.AddQuad(ids[4], ids[5], ids[6], ids[7], cellId);
+        return 1;
+
+      case VTK_VOXEL:
+        this->Input->GetCellPoints(cellId, npts, ids);
+        faces.AddQuad(ids[0], ids[1], ids[5], ids[4], cellId);
+        faces.AddQuad(ids[0], ids[2], ids[3], ids[1], cellId);
+        faces.AddQuad(ids[0], ids[4], ids[6], ids[2], cellId);
+        faces.AddQuad(ids[1], ids[3], ids[7], ids[5], cellId);
+        faces.AddQuad(ids[2], ids[6], ids[7], ids[3], cellId);
+        faces.AddQuad(ids[4], ids[5], ids[7], ids[6], cellId);
+        return 1;
+
+      case VTK_TETRA:
+        this->Input->GetCellPoints(cellId, npts, ids);
+        faces.AddTriangle(ids[0], ids[1], ids[3], cellId);
+        faces.AddTriangle(ids[0], ids[2], ids[1], cellId);
+        faces.AddTriangle(ids[0], ids[3], ids[2], cellId);
+        faces.AddTriangle(ids[1], ids[2], ids[3], cellId);
+        return 1;
+
+      case VTK_PENTAGONAL_PRISM:
+        this->Input->GetCellPoints(cellId, npts, ids);
+        faces.AddQuad(ids[0], ids[1], ids[6], ids[5], cellId);
+        faces.AddQuad(ids[1], ids[2], ids[7], ids[6], cellId);
+        faces.AddQuad(ids[2], ids[3], ids[8], ids[7], cellId);
+        faces.AddQuad(ids[3], ids[4], ids[9], ids[8], cellId);
+        faces.AddQuad(ids[4], ids[0], ids[5], ids[9], cellId);
+        faces.AddPolygon(ids, 5, cellId);
+        faces.AddPolygon(ids + 5, 5, cellId);
+        return 1;
+
+      case VTK_HEXAGONAL_PRISM:
+        this->Input->GetCellPoints(cellId, npts, ids);
+        faces.AddQuad(ids[0], ids[1], ids[7], ids[6], cellId);
+        faces.AddQuad(ids[1], ids[2], ids[8], ids[7], cellId);
+        faces.AddQuad(ids[2], ids[3], ids[9], ids[8], cellId);
+        faces.AddQuad(ids[3], ids[4], ids[10], ids[9], cellId);
+        faces.AddQuad(ids[4], ids[5], ids[11], ids[10], cellId);
+        faces.AddQuad(ids[5], ids[0], ids[6], ids[11], cellId);
+        faces.AddPolygon(ids, 6, cellId);
+        faces.AddPolygon(ids + 6, 6, cellId);
+        return 1;
+
+      default:
+        break;
+      }
+
+    // Other cells: only the 3D ones have their faces hashed.
+    vtkGenericCell *cell = this->Cell.Local();
+    this->Input->GetCell(cellId, cell);
+    if (cell->GetCellDimension() != 3)
+      {
+      return 0;
+      }
+    int numFaces = cell->GetNumberOfFaces();
+    for (int j = 0; j < numFaces; ++j)
+      {
+      vtkCell *face = cell->GetFace(j);
+      vtkIdList *faceIds = face->PointIds;
+      if (cell->IsLinear())
+        {
+        if (faceIds->GetNumberOfIds() == 4)
+          {
+          faces.AddQuad(faceIds->GetId(0), faceIds->GetId(1),
+                        faceIds->GetId(2), faceIds->GetId(3), cellId);
+          }
+        else if (faceIds->GetNumberOfIds() == 3)
+          {
+          faces.AddTriangle(faceIds->GetId(0), faceIds->GetId(1),
+                            faceIds->GetId(2), cellId);
+          }
+        else
+          {
+          faces.AddPolygon(faceIds->GetPointer(0),
+                           faceIds->GetNumberOfIds(), cellId);
+          }
+        continue;
+        }
+
+      // Nonlinear cell: only the faces without neighbor are hashed.
+      vtkIdList *neighbors = this->Neighbors.Local();
+      this->Input->GetCellNeighbors(cellId, faceIds, neighbors);
+      if (neighbors->GetNumberOfIds() > 0)
+        {
+        continue;
+        }
+      if (this->NonlinearSubdivisionLevel >= 1)
+        {
+        vtkIdList *pts = this->Pts.Local();
+        face->Triangulate(0, pts, this->Coords.Local());
+        for (vtkIdType i = 0; i < pts->GetNumberOfIds(); i += 3)
+          {
+          faces.AddTriangle(pts->GetId(i), pts->GetId(i + 1),
+                            pts->GetId(i + 2), cellId);
+          }
+        }
+      else
+        {
+        switch (face->GetCellType())
+          {
+          case VTK_QUADRATIC_TRIANGLE:
+            faces.AddTriangle(faceIds->GetId(0), faceIds->GetId(1),
+                              faceIds->GetId(2), cellId);
+            break;
+          case VTK_QUADRATIC_QUAD:
+          case VTK_BIQUADRATIC_QUAD:
+          case VTK_QUADRATIC_LINEAR_QUAD:
+            faces.AddQuad(faceIds->GetId(0), faceIds->GetId(1),
+                          faceIds->GetId(2), faceIds->GetId(3), cellId);
+            break;
+          default:
+            ++this->UnknownFaces.Local();
+            break;
+          }
+        }
+      }
+    return 1;
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+// Gathers the faces of the chunks in arrays indexed by face, keyed by the
+// bin of each face in the hash: its smallest point id.
+struct vtkSurfaceGatherFaces
+{
+  vtkSurfaceFaces *Faces;
+  const vtkIdType *FaceOffsets;
+  const vtkIdType *IdOffsets;
+  vtkIdType *Ids;
+  vtkIdType *Offsets;
+  vtkIdType *CellIds;
+  unsigned char *Kinds;
+  vtkIdType *Bins;
+  vtkIdType *Order;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+      vtkSurfaceFaces &faces = this->Faces[chunk];
+      vtkIdType faceId = this->FaceOffsets[chunk];
+      vtkIdType idOffset = this->IdOffsets[chunk];
+      std::copy(faces.Ids.begin(), faces.Ids.end(), this->Ids + idOffset);
+      for (vtkIdType i = 0; i < faces.GetNumberOfFaces(); ++i, ++faceId)
+        {
+        this->Offsets[faceId] = idOffset + faces.Offsets[i];
+        this->CellIds[faceId] = faces.CellIds[i];
+        this->Kinds[faceId] = faces.Kinds[i];
+        this->Bins[faceId] = this->Ids[this->Offsets[faceId]];
+        this->Order[faceId] = faceId;
+        }
+      // release the memory of the chunk
+      std::vector<vtkIdType>().swap(faces.Ids);
+      std::vector<vtkIdType>().swap(faces.Offsets);
+      std::vector<vtkIdType>().swap(faces.CellIds);
+      std::vector<unsigned char>().swap(faces.Kinds);
+      }
+  }
+};
+
+// Resolves the faces of whole bins, the faces of a bin being sorted in
+// insertion order: a face is visible if no other face of the bin matches
+// it, as when it is the only one left visible in the hash.
+struct vtkSurfaceResolveFaces
+{
+  vtkIdType NumberOfFaces;
+  const vtkIdType *Bins;
+  const vtkIdType *Order;
+  const vtkIdType *Ids;
+  const vtkIdType *Offsets;
+  const unsigned char *Kinds;
+  unsigned char *Visible;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    // Bins that start before begin belong to the previous range.
+    vtkIdType first = begin;
+    while (first > 0 && first < this->NumberOfFaces &&
+           this->Bins[first] == this->Bins[first - 1])
+      {
+      ++first;
+      }
+    std::vector<vtkIdType> hashed;
+    while (first < end)
+      {
+      vtkIdType last = first;
+      while (last < this->NumberOfFaces &&
+             this->Bins[last] == this->Bins[first])
+        {
+        ++last;
+        }
+      hashed.clear();
+      for (vtkIdType i = first; i < last; ++i)
+        {
+        vtkIdType face = this->Order[i];
+        const vtkIdType *ids = this->Ids + this->Offsets[face];
+        vtkIdType numPts = this->Offsets[face + 1] - this->Offsets[face];
+        this->Visible[i] = 1;
+        for (size_t j = 0; j < hashed.size(); ++j)
+          {
+          vtkIdType other = this->Order[hashed[j]];
+          if (vtkSurfaceFacesMatch(this->Kinds[face], ids, numPts,
+                                   this->Ids + this->Offsets[other],
+                                   this->Offsets[other + 1] -
+                                   this->Offsets[other]))
+            {
+            this->Visible[hashed[j]] = 0;
+            this->Visible[i] = 0;
+            break;
+            }
+          }
+        if (this->Visible[i])
+          {
+          hashed.push_back(i);
+          }
+        }
+      first = last;
+      }
+  }
+};
+}
+
 vtkStandardNewMacro(vtkDataSetSurfaceFilter);
 
 //----------------------------------------------------------------------------
@@ -128,6 +560,11 @@ vtkDataSetSurfaceFilter::vtkDataSetSurfaceFilter()
   this->OriginalPointIdsName = NULL;
 
   this->NonlinearSubdivisionLevel = 1;
+
+  this->CacheMesh = 0;
+  this->MeshCache = vtkAttributeRemapCache::New();
+
+  this->HashFacesInParallel = 1;
 }
 
 //----------------------------------------------------------------------------
@@ -144,10 +581,91 @@ vtkDataSetSurfaceFilter::~vtkDataSetSurfaceFilter()
     }
   this->SetOriginalCellIdsName(NULL);
   this->SetOriginalPointIdsName(NULL);
+  this->MeshCache->Delete();
 }
 
 //----------------------------------------------------------------------------
 int vtkDataSetSurfaceFilter::RequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  if (!this->CacheMesh)
+    {
+    return this->ExtractSurface(request, inputVector, outputVector);
+    }
+
+  vtkDataSet *input = vtkDataSet::GetData(inputVector[0]);
+  vtkPolyData *output = vtkPolyData::GetData(outputVector);
+  vtkAttributeRemapCache *cache = this->MeshCache;
+
+  if (cache->CanRemap(input, this->GetMTime()))
+    {
+    vtkDebugMacro(<<"Re-mapping attributes onto the cached surface");
+    cache->Remap(input, output);
+    if (this->PassThroughCellIds && !this->UseStrips)
+      {
+      output->GetCellData()->AddArray(cache->GetCellMap());
+      }
+    if (this->PassThroughPointIds)
+      {
+      output->GetPointData()->AddArray(cache->GetPointMap());
+      }
+    return 1;
+    }
+
+  // The original ids computed for PassThroughCellIds and
+  // PassThroughPointIds are the maps the cache needs. Compute them under
+  // private names when they were not requested. The ivars are changed
+  // directly so that the filter is not modified.
+  char cellIdsName[] = "vtkSurfaceCacheCellIds";
+  char pointIdsName[] = "vtkSurfaceCachePointIds";
+  int passThroughCellIds = this->PassThroughCellIds;
+  int passThroughPointIds = this->PassThroughPointIds;
+  char *originalCellIdsName = this->OriginalCellIdsName;
+  char *originalPointIdsName = this->OriginalPointIdsName;
+  if (!passThroughCellIds)
+    {
+    this->PassThroughCellIds = 1;
+    this->OriginalCellIdsName = cellIdsName;
+    }
+  if (!passThroughPointIds)
+    {
+    this->PassThroughPointIds = 1;
+    this->OriginalPointIdsName = pointIdsName;
+    }
+
+  cache->Initialize();
+  int retVal = this->ExtractSurface(request, inputVector, outputVector);
+
+  const char *cellName = this->GetOriginalCellIdsName();
+  const char *pointName = this->GetOriginalPointIdsName();
+  cache->SetCellMap(vtkIdTypeArray::SafeDownCast(
+    output->GetCellData()->GetAbstractArray(cellName)));
+  cache->SetPointMap(vtkIdTypeArray::SafeDownCast(
+    output->GetPointData()->GetAbstractArray(pointName)));
+  if (!this->GetAbortExecute())
+    {
+    cache->Finish(input, output);
+    }
+  if (!passThroughCellIds)
+    {
+    output->GetCellData()->RemoveArray(cellName);
+    }
+  if (!passThroughPointIds)
+    {
+    output->GetPointData()->RemoveArray(pointName);
+    }
+
+  this->PassThroughCellIds = passThroughCellIds;
+  this->PassThroughPointIds = passThroughPointIds;
+  this->OriginalCellIdsName = originalCellIdsName;
+  this->OriginalPointIdsName = originalPointIdsName;
+  return retVal;
+}
+
+//----------------------------------------------------------------------------
+int vtkDataSetSurfaceFilter::ExtractSurface(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **inputVector,
   vtkInformationVector *outputVector)
@@ -1060,6 +1578,9 @@ int vtkDataSetSurfaceFilter::DataSetExecute(vtkDataSet *input,
   double x[3];
   vtkIdList *cellIds;
   vtkIdList *pts;
+  vtkIdList *cellPtIds;
+  const vtkIdType *cellPts;
+  vtkIdType numCellPts;
   vtkPoints *newPts;
   vtkIdType ptId, pt;
   int npts;
@@ -1094,6 +1615,7 @@ int vtkDataSetSurfaceFilter::DataSetExecute(vtkDataSet *input,
 
   cellIds = vtkIdList::New();
   pts = vtkIdList::New();
+  cellPtIds = vtkIdList::New();
 
   vtkDebugMacro(<<"Executing geometry filter");
 
@@ -1126,11 +1648,37 @@ int vtkDataSetSurfaceFilter::DataSetExecute(vtkDataSet *input,
       abort = this->GetAbortExecute();
       }
 
-    input->GetCell(cellId,cell);
     if (mayBlank && !sgridInput->IsCellVisible(cellId))
       {
       continue;
       }
+
+    // Linear 0D, 1D and 2D cells are copied from their connectivity,
+    // without building the cell.
+    int cellType = input->GetCellType(cellId);
+    switch (cellType)
+      {
+      case VTK_VERTEX: case VTK_POLY_VERTEX: case VTK_LINE:
+      case VTK_POLY_LINE: case VTK_TRIANGLE: case VTK_TRIANGLE_STRIP:
+      case VTK_POLYGON: case VTK_PIXEL: case VTK_QUAD:
+        input->GetCellPoints(cellId, numCellPts, cellPts, cellPtIds);
+        pts->Reset();
+        for ( i=0; i < numCellPts; i++)
+          {
+          ptId = cellPts[i];
+          input->GetPoint(ptId, x);
+          pt = newPts->InsertNextPoint(x);
+          outputPD->CopyData(pd,ptId,pt);
+          this->RecordOrigPointId(pt, ptId);
+          pts->InsertId(i,pt);
+          }
+        newCellId = output->InsertNextCell(cellType, pts);
+        outputCD->CopyData(cd,cellId,newCellId);
+        this->RecordOrigCellId(newCellId, cellId);
+        continue;
+      }
+
+    input->GetCell(cellId,cell);
     switch (cell->GetCellDimension())
       {
       // create new points and then cell
@@ -1216,6 +1764,7 @@ int vtkDataSetSurfaceFilter::DataSetExecute(vtkDataSet *input,
 
   cellIds->Delete();
   pts->Delete();
+  cellPtIds->Delete();
 
   return 1;
 }
@@ -1291,6 +1840,9 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "NonlinearSubdivisionLevel: "
      << this->NonlinearSubdivisionLevel << endl;
+  os << indent << "CacheMesh: " << (this->CacheMesh ? "On\n" : "Off\n");
+  os << indent << "HashFacesInParallel: "
+     << (this->HashFacesInParallel ? "On\n" : "Off\n");
 }
 
 //========================================================================
@@ -1403,6 +1955,8 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   vtkDoubleArray *parametricCoords2;
   vtkIdList *outPts;
   vtkIdList *outPts2;
+  // Neighbors of the faces of nonlinear 3D cells.
+  vtkIdList *cellIds;
 
   pts = vtkIdList::New();
   coords = vtkPoints::New();
@@ -1410,6 +1964,7 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   parametricCoords2 = vtkDoubleArray::New();
   outPts = vtkIdList::New();
   outPts2 = vtkIdList::New();
+  cellIds = vtkIdList::New();
   // might not be necessary to set the data type for coords
   // but certainly safer to do so
   coords->SetDataType(input->GetPoints()->GetData()->GetDataType());
@@ -1454,7 +2009,21 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
     }
 
   // First insert all points.  Points have to come first in poly data.
-  for (cellIter->InitTraversal(); !cellIter->IsDoneWithTraversal();
+  // Grids of a single cell type other than vertices have none.
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(input);
+  int singleCellType = grid ? grid->GetSingleCellType() : -1;
+  bool hasVerts = (singleCellType < 0 || singleCellType == VTK_VERTEX ||
+                   singleCellType == VTK_POLY_VERTEX);
+
+  // Hash the faces of the 3D cells of unstructured grids up front, in
+  // parallel. The loop below skips the cells whose faces are hashed.
+  std::vector<unsigned char> hashed;
+  if (this->HashFacesInParallel && grid && numCells > 0)
+    {
+    hashed.resize(numCells);
+    this->InsertFacesInHash(grid, &hashed[0]);
+    }
+  for (cellIter->InitTraversal(); hasVerts && !cellIter->IsDoneWithTraversal();
        cellIter->GoToNextCell())
     {
     cellType = cellIter->GetCellType();
@@ -1500,6 +2069,10 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
       progressCount = 0;
       }
     progressCount++;
+    if (!hashed.empty() && hashed[cellId])
+      {
+      continue;
+      }
 
     cellType = cellIter->GetCellType();
     switch (cellType)
@@ -1663,7 +2236,6 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
             }
           else //3D nonlinear cell
             {
-            vtkIdList *cellIds = vtkIdList::New();
             int numFaces = cell->GetNumberOfFaces();
             for (j=0; j < numFaces; j++)
               {
@@ -1706,7 +2278,6 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
                   } // subdivision level
                 } // cell has ids
               } // for faces
-            cellIds->Delete();
             } //3d cell
           } //nonlinear cell
         } // default switch case
@@ -1965,6 +2536,7 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   parametricCoords2->Delete();
   outPts->Delete();
   outPts2->Delete();
+  cellIds->Delete();
 
   output->SetPoints(newPts);
   newPts->Delete();
@@ -2271,6 +2843,115 @@ void vtkDataSetSurfaceFilter::InsertPolygonInHash(vtkIdType* ids,
   delete [] tab;
 }
 
+//----------------------------------------------------------------------------
+void vtkDataSetSurfaceFilter::InsertFacesInHash(vtkUnstructuredGrid *input,
+                                                unsigned char *hashed)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType chunk = vtkSurfaceExtractFaces::Chunk;
+  vtkIdType numChunks = (numCells + chunk - 1) / chunk;
+
+  // GetCellNeighbors(), used for the nonlinear 3D cells, builds the links
+  // on demand: build them now rather than from several threads.
+  for (vtkIdType cellId = 0; !input->GetCellLinks() && cellId < numCells;
+       ++cellId)
+    {
+    int cellType = input->GetCellType(cellId);
+    if (!vtkCellTypes::IsLinear(cellType) &&
+        cellType != VTK_QUADRATIC_EDGE && cellType != VTK_CUBIC_LINE &&
+        cellType != VTK_QUADRATIC_TRIANGLE &&
+        cellType != VTK_BIQUADRATIC_TRIANGLE &&
+        cellType != VTK_QUADRATIC_QUAD &&
+        cellType != VTK_QUADRATIC_LINEAR_QUAD &&
+        cellType != VTK_BIQUADRATIC_QUAD &&
+        cellType != VTK_QUADRATIC_POLYGON)
+      {
+      input->BuildLinks();
+      }
+    }
+
+  // Extract the faces of chunks of cells in cell order, which is the
+  // insertion order of the serial hashing.
+  std::vector<vtkSurfaceFaces> faces(numChunks);
+  vtkSurfaceExtractFaces extract;
+  extract.Input = input;
+  extract.NumberOfCells = numCells;
+  extract.NonlinearSubdivisionLevel = this->NonlinearSubdivisionLevel;
+  extract.Faces = &faces[0];
+  extract.Hashed = hashed;
+  vtkSMPTools::For(0, numChunks, extract);
+
+  vtkIdType unknownFaces = 0;
+  for (vtkSMPThreadLocal<vtkIdType>::iterator it =
+         extract.UnknownFaces.begin(); it != extract.UnknownFaces.end(); ++it)
+    {
+    unknownFaces += *it;
+    }
+  if (unknownFaces > 0)
+    {
+    vtkWarningMacro(<< "Encountered unknown nonlinear face.");
+    }
+
+  std::vector<vtkIdType> faceOffsets(numChunks), idOffsets(numChunks);
+  vtkIdType numFaces = 0, numIds = 0;
+  for (vtkIdType i = 0; i < numChunks; ++i)
+    {
+    faceOffsets[i] = numFaces;
+    idOffsets[i] = numIds;
+    numFaces += faces[i].GetNumberOfFaces();
+    numIds += static_cast<vtkIdType>(faces[i].Ids.size());
+    }
+  if (numFaces == 0)
+    {
+    return;
+    }
+
+  // Sort the faces on their bin, keeping the insertion order in each bin.
+  std::vector<vtkIdType> ids(numIds), offsets(numFaces + 1);
+  std::vector<vtkIdType> cellIds(numFaces), bins(numFaces), order(numFaces);
+  std::vector<unsigned char> kinds(numFaces);
+  vtkSurfaceGatherFaces gather = { &faces[0], &faceOffsets[0],
+    &idOffsets[0], &ids[0], &offsets[0], &cellIds[0], &kinds[0], &bins[0],
+    &order[0] };
+  vtkSMPTools::For(0, numChunks, gather);
+  offsets[numFaces] = numIds;
+  vtkSMPTools::RadixSort(&bins[0], &bins[0] + numFaces, &order[0]);
+
+  std::vector<unsigned char> visible(numFaces);
+  vtkSurfaceResolveFaces resolve = { numFaces, &bins[0], &order[0], &ids[0],
+    &offsets[0], &kinds[0], &visible[0] };
+  vtkSMPTools::For(0, numFaces, resolve);
+
+  // Insert the visible faces, at the end of their bin.
+  vtkFastGeomQuad **end = NULL;
+  vtkIdType bin = -1;
+  for (vtkIdType i = 0; i < numFaces; ++i)
+    {
+    if (!visible[i])
+      {
+      continue;
+      }
+    if (bins[i] != bin)
+      {
+      bin = bins[i];
+      end = this->QuadHash + bin;
+      while (*end)
+        {
+        end = &((*end)->Next);
+        }
+      }
+    vtkIdType face = order[i];
+    int numPts = static_cast<int>(offsets[face + 1] - offsets[face]);
+    vtkFastGeomQuad *quad = this->NewFastGeomQuad(numPts);
+    quad->Next = NULL;
+    quad->SourceId = cellIds[face];
+    std::copy(&ids[offsets[face]], &ids[offsets[face]] + numPts,
+              quad->ptArray);
+    *end = quad;
+    end = &(quad->Next);
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkDataSetSurfaceFilter::InitFastGeomQuadAllocation(vtkIdType numberOfCells)
 {
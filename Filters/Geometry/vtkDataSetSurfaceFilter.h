@@ -29,8 +29,10 @@
 #include "vtkPolyDataAlgorithm.h"
 
 
+class vtkAttributeRemapCache;
 class vtkPointData;
 class vtkPoints;
+class vtkUnstructuredGrid;
 class vtkIdTypeArray;
 
 //BTX
@@ -112,6 +114,27 @@ public:
   vtkSetMacro(NonlinearSubdivisionLevel, int);
   vtkGetMacro(NonlinearSubdivisionLevel, int);
 
+  // Description:
+  // If this is on (default is off), the extracted surface is cached along
+  // with the original point and cell ids. When only the input attributes
+  // change afterwards, the cached surface is reused and the attributes are
+  // copied onto it instead of extracting the surface again. The cache is
+  // not used when UseStrips is on.
+  vtkSetMacro(CacheMesh, int);
+  vtkGetMacro(CacheMesh, int);
+  vtkBooleanMacro(CacheMesh, int);
+
+  // Description:
+  // If this is on (the default), the faces of the 3D cells of unstructured
+  // grids are extracted and matched in parallel (via vtkSMPTools), then the
+  // visible ones are inserted in the face hash in the order the serial
+  // insertion would leave them, so that the output does not change.
+  // InsertQuadInHash(), InsertTriInHash() and InsertPolygonInHash() are not
+  // called for these faces: subclasses overriding them should turn this off.
+  vtkSetMacro(HashFacesInParallel, int);
+  vtkGetMacro(HashFacesInParallel, int);
+  vtkBooleanMacro(HashFacesInParallel, int);
+
   // Description:
   // Direct access methods that can be used to use the this class as an
   // algorithm without using it as a filter.
@@ -161,6 +184,9 @@ protected:
   virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  // Extract the surface of the input, ignoring the mesh cache.
+  int ExtractSurface(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
+
 
   // Helper methods.
 
@@ -196,6 +222,9 @@ protected:
                        vtkIdType sourceId, vtkIdType faceId = -1);
   virtual void InsertPolygonInHash(vtkIdType* ids, int numpts,
                            vtkIdType sourceId);
+  // Insert the faces of the 3D cells of input in the hash, extracting and
+  // matching them in parallel, and set hashed[cellId] to 1 for these cells.
+  void InsertFacesInHash(vtkUnstructuredGrid *input, unsigned char *hashed);
   void InitQuadHashTraversal();
   vtkFastGeomQuad *GetNextVisibleQuadFromHash();
 
@@ -245,6 +274,11 @@ protected:
 
   int NonlinearSubdivisionLevel;
 
+  int CacheMesh;
+  vtkAttributeRemapCache *MeshCache;
+
+  int HashFacesInParallel;
+
 private:
   vtkDataSetSurfaceFilter(const vtkDataSetSurfaceFilter&);  // Not implemented.
   void operator=(const vtkDataSetSurfaceFilter&);  // Not implemented.
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkGeometryFilter.h"
 
+#include "vtkAttributeRemapCache.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkGenericCell.h"
@@ -63,12 +64,16 @@ vtkGeometryFilter::vtkGeometryFilter()
 
   this->Merging = 1;
   this->Locator = NULL;
+
+  this->CacheMesh = 0;
+  this->MeshCache = vtkAttributeRemapCache::New();
 }
 
 //----------------------------------------------------------------------------
 vtkGeometryFilter::~vtkGeometryFilter()
 {
   this->SetLocator(NULL);
+  this->MeshCache->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -154,16 +159,30 @@ int vtkGeometryFilter::RequestData(
     return 1;
     }
 
+  // Only the attributes changed since the last execution: copy them onto
+  // the mesh extracted then.
+  if (this->CacheMesh && this->MeshCache->CanRemap(input, this->GetMTime()))
+    {
+    vtkDebugMacro(<<"Re-mapping attributes onto the cached mesh");
+    this->MeshCache->Remap(input, output);
+    return 1;
+    }
+  this->MeshCache->Initialize();
+  vtkAttributeRemapCache *cache = this->CacheMesh ? this->MeshCache : NULL;
+
   switch (input->GetDataObjectType())
     {
     case  VTK_POLY_DATA:
       this->PolyDataExecute(input, output);
+      this->FinishMeshCache(input, output);
       return 1;
     case  VTK_UNSTRUCTURED_GRID:
       this->UnstructuredGridExecute(input, output);
+      this->FinishMeshCache(input, output);
       return 1;
     case VTK_STRUCTURED_GRID:
       this->StructuredGridExecute(input, output, outInfo);
+      this->FinishMeshCache(input, output);
       return 1;
     }
 
@@ -300,16 +319,28 @@ int vtkGeometryFilter::RequestData(
               if ( this->Merging && this->Locator->InsertUniquePoint(x, pt) )
                 {
                 outputPD->CopyData(pd,ptId,pt);
+                if (cache)
+                  {
+                  cache->RecordPoint(pt,ptId);
+                  }
                 }
               else if (!this->Merging)
                 {
                 pt = newPts->InsertNextPoint(x);
                 outputPD->CopyData(pd,ptId,pt);
+                if (cache)
+                  {
+                  cache->RecordPoint(pt,ptId);
+                  }
                 }
               pts->InsertId(i,pt);
               }
             newCellId = output->InsertNextCell(cell->GetCellType(), pts);
             outputCD->CopyData(cd,cellId,newCellId);
+            if (cache)
+              {
+              cache->RecordCell(newCellId,cellId);
+              }
             break;
 
           case 3:
@@ -330,16 +361,28 @@ int vtkGeometryFilter::RequestData(
                   if (this->Merging && this->Locator->InsertUniquePoint(x, pt) )
                     {
                     outputPD->CopyData(pd,ptId,pt);
+                    if (cache)
+                      {
+                      cache->RecordPoint(pt,ptId);
+                      }
                     }
                   else if (!this->Merging)
                     {
                     pt = newPts->InsertNextPoint(x);
                     outputPD->CopyData(pd,ptId,pt);
+                    if (cache)
+                      {
+                      cache->RecordPoint(pt,ptId);
+                      }
                     }
                   pts->InsertId(i,pt);
                   }
                 newCellId = output->InsertNextCell(face->GetCellType(), pts);
                 outputCD->CopyData(cd,cellId,newCellId);
+                if (cache)
+                  {
+                  cache->RecordCell(newCellId,cellId);
+                  }
                 }
               }
             break;
@@ -368,9 +411,22 @@ int vtkGeometryFilter::RequestData(
   pts->Delete();
   delete [] cellVis;
 
+  this->FinishMeshCache(input, output);
+
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Keep the mesh just extracted when caching is on, unless the execution
+// was interrupted.
+void vtkGeometryFilter::FinishMeshCache(vtkDataSet *input, vtkPolyData *output)
+{
+  if (this->CacheMesh && !this->GetAbortExecute())
+    {
+    this->MeshCache->Finish(input, output);
+    }
+}
+
 //----------------------------------------------------------------------------
 // Specify a spatial locator for merging points. By
 // default an instance of vtkMergePoints is used.
@@ -420,6 +476,7 @@ void vtkGeometryFilter::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "Locator: (none)\n";
     }
+  os << indent << "Cache Mesh: " << (this->CacheMesh ? "On\n" : "Off\n");
 }
 
 //----------------------------------------------------------------------------
@@ -484,17 +541,27 @@ void vtkGeometryFilter::PolyDataExecute(vtkDataSet *dataSetInput,
     allVisible = 0;
     }
 
+  vtkAttributeRemapCache *cache = this->CacheMesh ? this->MeshCache : NULL;
   if ( allVisible ) //just pass input to output
     {
     output->CopyStructure(input);
     outputPD->PassData(pd);
     outputCD->PassData(cd);
+    if (cache)
+      {
+      cache->PassPoints();
+      cache->PassCells();
+      }
     return;
     }
 
   // Always pass point data
   output->SetPoints(p);
   outputPD->PassData(pd);
+  if (cache)
+    {
+    cache->PassPoints();
+    }
 
   // Allocate
   //
@@ -555,6 +622,10 @@ void vtkGeometryFilter::PolyDataExecute(vtkDataSet *dataSetInput,
       type = input->GetCellType(cellId);
       newCellId = output->InsertNextCell(type,npts,pts);
       outputCD->CopyData(cd,cellId,newCellId);
+      if (cache)
+        {
+        cache->RecordCell(newCellId,cellId);
+        }
       } //if visible
     } //for all cells
 
@@ -641,6 +712,11 @@ void vtkGeometryFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   // Just pass points through, never merge
   output->SetPoints(input->GetPoints());
   outputPD->PassData(pd);
+  vtkAttributeRemapCache *cache = this->CacheMesh ? this->MeshCache : NULL;
+  if (cache)
+    {
+    cache->PassPoints();
+    }
 
   outputCD->CopyGlobalIdsOn();
   outputCD->CopyAllocate(cd,numCells,numCells/2);
@@ -1043,24 +1119,40 @@ void vtkGeometryFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   for ( size_t i = 0; i < size; ++i )
     {
     outputCD->CopyData(cd, vertCellIds[i], i );
+    if (cache)
+      {
+      cache->RecordCell(static_cast<vtkIdType>(i), vertCellIds[i]);
+      }
     }
   offset += size;
   size = lineCellIds.size();
   for ( size_t i = 0; i < size; ++i )
     {
     outputCD->CopyData(cd, lineCellIds[i], i+offset );
+    if (cache)
+      {
+      cache->RecordCell(static_cast<vtkIdType>(i+offset), lineCellIds[i]);
+      }
     }
   offset += size;
   size = polyCellIds.size();
   for ( size_t i = 0; i < size; ++i )
     {
     outputCD->CopyData(cd, polyCellIds[i], i+offset );
+    if (cache)
+      {
+      cache->RecordCell(static_cast<vtkIdType>(i+offset), polyCellIds[i]);
+      }
     }
   offset += size;
   size = stripCellIds.size();
   for ( size_t i = 0; i < size; ++i )
     {
     outputCD->CopyData(cd, stripCellIds[i], i+offset );
+    if (cache)
+      {
+      cache->RecordCell(static_cast<vtkIdType>(i+offset), stripCellIds[i]);
+      }
     }
 
   output->Squeeze();
@@ -1174,6 +1266,11 @@ void vtkGeometryFilter::StructuredGridExecute(vtkDataSet *dataSetInput,
   outputPD->PassData(pd);
   outputCD->CopyGlobalIdsOn();
   outputCD->CopyAllocate(cd,numCells,numCells/2);
+  vtkAttributeRemapCache *cache = this->CacheMesh ? this->MeshCache : NULL;
+  if (cache)
+    {
+    cache->PassPoints();
+    }
 
   cells = vtkCellArray::New();
   cells->Allocate(numCells,numCells/2);
@@ -1206,6 +1303,10 @@ void vtkGeometryFilter::StructuredGridExecute(vtkDataSet *dataSetInput,
         case 0: case 1: case 2:
           newCellId = cells->InsertNextCell(cell);
           outputCD->CopyData(cd,cellId,newCellId);
+          if (cache)
+            {
+            cache->RecordCell(newCellId,cellId);
+            }
           break;
 
         case 3: //must be hexahedron
@@ -1229,6 +1330,10 @@ void vtkGeometryFilter::StructuredGridExecute(vtkDataSet *dataSetInput,
                 cells->InsertCellPoint(facePts[faceVerts[i]]);
                 }
               outputCD->CopyData(cd,cellId,newCellId);
+              if (cache)
+                {
+                cache->RecordCell(newCellId,cellId);
+                }
               }
             }
           break;
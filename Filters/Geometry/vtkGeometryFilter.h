@@ -52,6 +52,7 @@
 #include "vtkFiltersGeometryModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+class vtkAttributeRemapCache;
 class vtkIncrementalPointLocator;
 
 class VTKFILTERSGEOMETRY_EXPORT vtkGeometryFilter : public vtkPolyDataAlgorithm
@@ -127,6 +128,15 @@ public:
   // Create default locator. Used to create one when none is specified.
   void CreateDefaultLocator();
 
+  // Description:
+  // If this is on (default is off), the extracted surface is cached. When
+  // only the input attributes change afterwards, the cached surface is
+  // reused and the attributes are copied onto it instead of extracting
+  // the surface again.
+  vtkSetMacro(CacheMesh,int);
+  vtkGetMacro(CacheMesh,int);
+  vtkBooleanMacro(CacheMesh,int);
+
   // Description:
   // Return the MTime also considering the locator.
   unsigned long GetMTime();
@@ -143,6 +153,7 @@ protected:
   void UnstructuredGridExecute(vtkDataSet *, vtkPolyData *);
   void StructuredGridExecute(vtkDataSet *, vtkPolyData *, vtkInformation *);
   int RequestUpdateExtent(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
+  void FinishMeshCache(vtkDataSet *, vtkPolyData *);
 
   vtkIdType PointMaximum;
   vtkIdType PointMinimum;
@@ -155,6 +166,9 @@ protected:
 
   int Merging;
   vtkIncrementalPointLocator *Locator;
+
+  int CacheMesh;
+  vtkAttributeRemapCache *MeshCache;
 private:
   vtkGeometryFilter(const vtkGeometryFilter&);  // Not implemented.
   void operator=(const vtkGeometryFilter&);  // Not implemented.
@@ -15,6 +15,7 @@
 #include "vtkRectilinearGridPartitioner.h"
 
 // VTK includes
+#include "vtkCellData.h"
 #include "vtkDoubleArray.h"
 #include "vtkExtentRCBPartitioner.h"
 #include "vtkIndent.h"
@@ -37,6 +38,7 @@ vtkRectilinearGridPartitioner::vtkRectilinearGridPartitioner()
   this->NumberOfPartitions  = 2;
   this->NumberOfGhostLayers = 0;
   this->DuplicateNodes = 1;
+  this->CostArrayName = NULL;
   this->SetNumberOfInputPorts(1);
   this->SetNumberOfOutputPorts(1);
 }
@@ -44,7 +46,7 @@ vtkRectilinearGridPartitioner::vtkRectilinearGridPartitioner()
 //------------------------------------------------------------------------------
 vtkRectilinearGridPartitioner::~vtkRectilinearGridPartitioner()
 {
-
+  this->SetCostArrayName( NULL );
 }
 
 //------------------------------------------------------------------------------
@@ -54,6 +56,8 @@ void vtkRectilinearGridPartitioner::PrintSelf(
   this->Superclass::PrintSelf( oss, indent );
   oss << "NumberOfPartitions: " << this->NumberOfPartitions << std::endl;
   oss << "NumberOfGhostLayers: " << this->NumberOfGhostLayers << std::endl;
+  oss << "CostArrayName: "
+      << (this->CostArrayName ? this->CostArrayName : "(none)") << std::endl;
 }
 
 //------------------------------------------------------------------------------
@@ -149,6 +153,13 @@ int vtkRectilinearGridPartitioner::RequestData(
     extentPartitioner->DuplicateNodesOff();
     }
 
+  // Balance the partitions by the cost of the cells when available.
+  if( this->CostArrayName != NULL )
+    {
+    extentPartitioner->SetCellCosts(
+        grd->GetCellData()->GetArray( this->CostArrayName ) );
+    }
+
   // STEP 4: Partition
   extentPartitioner->Partition();
 
@@ -15,6 +15,7 @@
 #include "vtkStructuredGridPartitioner.h"
 #include "vtkObjectFactory.h"
 #include "vtkIndent.h"
+#include "vtkCellData.h"
 #include "vtkExtentRCBPartitioner.h"
 #include "vtkStructuredGrid.h"
 #include "vtkStructuredData.h"
@@ -35,6 +36,7 @@ vtkStructuredGridPartitioner::vtkStructuredGridPartitioner()
   this->NumberOfPartitions  = 2;
   this->NumberOfGhostLayers = 0;
   this->DuplicateNodes      = 1;
+  this->CostArrayName       = NULL;
   this->SetNumberOfInputPorts(1);
   this->SetNumberOfOutputPorts(1);
 }
@@ -42,7 +44,7 @@ vtkStructuredGridPartitioner::vtkStructuredGridPartitioner()
 //------------------------------------------------------------------------------
 vtkStructuredGridPartitioner::~vtkStructuredGridPartitioner()
 {
-
+  this->SetCostArrayName( NULL );
 }
 
 //------------------------------------------------------------------------------
@@ -53,6 +55,8 @@ void vtkStructuredGridPartitioner::PrintSelf(
   oss << "NumberOfPartitions: " << this->NumberOfPartitions << std::endl;
   oss << "NumberOfGhostLayers: " << this->NumberOfGhostLayers << std::endl;
   oss << "DuplicateNodes: " << this->DuplicateNodes << std::endl;
+  oss << "CostArrayName: "
+      << (this->CostArrayName ? this->CostArrayName : "(none)") << std::endl;
 }
 
 //------------------------------------------------------------------------------
@@ -145,6 +149,13 @@ int vtkStructuredGridPartitioner::RequestData(
     extentPartitioner->DuplicateNodesOff();
     }
 
+  // Balance the partitions by the cost of the cells when available.
+  if( this->CostArrayName != NULL )
+    {
+    extentPartitioner->SetCellCosts(
+        grd->GetCellData()->GetArray( this->CostArrayName ) );
+    }
+
   // STEP 4: Partition
   extentPartitioner->Partition();
 
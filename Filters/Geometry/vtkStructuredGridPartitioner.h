@@ -59,6 +59,13 @@ public:
   vtkSetMacro(DuplicateNodes,int);
   vtkBooleanMacro(DuplicateNodes,int);
 
+  // Description:
+  // Set/Get the name of a cell data array holding the cost of processing
+  // each cell. When set, the partitions are balanced by total cost instead
+  // of by number of nodes. Default is NULL.
+  vtkSetStringMacro(CostArrayName);
+  vtkGetStringMacro(CostArrayName);
+
 protected:
   vtkStructuredGridPartitioner();
   virtual ~vtkStructuredGridPartitioner();
@@ -76,6 +83,7 @@ protected:
   int NumberOfPartitions;
   int NumberOfGhostLayers;
   int DuplicateNodes;
+  char *CostArrayName;
 
 private:
   vtkStructuredGridPartitioner(const vtkStructuredGridPartitioner &); // Not implemented
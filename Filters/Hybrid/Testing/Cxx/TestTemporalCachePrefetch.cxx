@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTemporalCachePrefetch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkTemporalDataSetCache prefetches the time steps following
+// the one delivered, so that playing them does not execute its input.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTemporalDataSetCache.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+// A source with time steps 0 to 9 whose point is at x = time.
+class vtkTemporalPointSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTemporalPointSource *New();
+  vtkTypeMacro(vtkTemporalPointSource, vtkPolyDataAlgorithm);
+  vtkGetMacro(NumberOfExecutions, int);
+
+protected:
+  vtkTemporalPointSource() : NumberOfExecutions(0)
+  {
+    this->SetNumberOfInputPorts(0);
+  }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+                         vtkInformationVector* outputVector)
+  {
+    vtkInformation *outInfo = outputVector->GetInformationObject(0);
+    double steps[10];
+    for (int i = 0; i < 10; ++i)
+      {
+      steps[i] = i;
+      }
+    double range[2] = { 0, 9 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps, 10);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+                  vtkInformationVector* outputVector)
+  {
+    ++this->NumberOfExecutions;
+    vtkInformation *outInfo = outputVector->GetInformationObject(0);
+    vtkPolyData *output = vtkPolyData::GetData(outputVector);
+    double time =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    vtkNew<vtkPoints> points;
+    points->InsertNextPoint(time, 0, 0);
+    output->SetPoints(points.GetPointer());
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+
+  int NumberOfExecutions;
+
+private:
+  vtkTemporalPointSource(const vtkTemporalPointSource&);  // Not implemented.
+  void operator=(const vtkTemporalPointSource&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkTemporalPointSource);
+
+// Update the cache for the time step and check the output.
+static bool UpdateTime(vtkTemporalDataSetCache *cache, double time)
+{
+  cache->UpdateTimeStep(time);
+  vtkPolyData *output = vtkPolyData::SafeDownCast(cache->GetOutputDataObject(0));
+  return output && output->GetNumberOfPoints() == 1 &&
+    output->GetPoint(0)[0] == time;
+}
+
+int TestTemporalCachePrefetch(int, char *[])
+{
+  vtkNew<vtkTemporalPointSource> source;
+  vtkNew<vtkTemporalDataSetCache> cache;
+  cache->SetInputConnection(source->GetOutputPort());
+  cache->SetCacheSize(10);
+  cache->PrefetchOn();
+  cache->SetPrefetchLookahead(2);
+
+  // Delivering a time step prefetches the two following ones.
+  TEST_ASSERT(UpdateTime(cache.GetPointer(), 0), "Bad output");
+  cache->WaitForPrefetch();
+  TEST_ASSERT(!cache->IsPrefetching(), "Prefetch still running");
+  TEST_ASSERT(source->GetNumberOfExecutions() == 3, "Time steps not prefetched");
+
+  // Playing them does not execute the source, and prefetches the next
+  // time steps not cached yet.
+  TEST_ASSERT(UpdateTime(cache.GetPointer(), 1), "Bad prefetched output");
+  TEST_ASSERT(UpdateTime(cache.GetPointer(), 2), "Bad prefetched output");
+  cache->WaitForPrefetch();
+  TEST_ASSERT(source->GetNumberOfExecutions() == 5, "Bad prefetch");
+  for (int t = 3; t < 10; ++t)
+    {
+    TEST_ASSERT(UpdateTime(cache.GetPointer(), t), "Bad playback output");
+    }
+  cache->WaitForPrefetch();
+  TEST_ASSERT(source->GetNumberOfExecutions() == 10,
+              "Time steps executed more than once");
+
+  // Without prefetch, only the requested time steps execute.
+  source->Modified();
+  cache->PrefetchOff();
+  TEST_ASSERT(UpdateTime(cache.GetPointer(), 4), "Bad output");
+  TEST_ASSERT(!cache->IsPrefetching() &&
+              source->GetNumberOfExecutions() == 11, "Unexpected prefetch");
+  return EXIT_SUCCESS;
+}
@@ -14,8 +14,10 @@
 =========================================================================*/
 #include "vtkTemporalDataSetCache.h"
 
+#include "vtkAtomicTypes.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkCompositeDataPipeline.h"
@@ -23,17 +25,79 @@
 #include "vtkCompositeDataIterator.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
 #include <vector>
 
 //---------------------------------------------------------------------------
 vtkStandardNewMacro(vtkTemporalDataSetCache);
 
+//----------------------------------------------------------------------------
+class vtkTemporalDataSetCachePrefetch
+{
+public:
+  vtkTemporalDataSetCachePrefetch() : ThreadId(-1), Port(0)
+  {
+    this->Stop = 0;
+    this->Running = 0;
+  }
+
+  vtkNew<vtkMultiThreader> Threader;
+  int ThreadId;
+
+  // The time steps to prefetch, selected when a time step is delivered,
+  // and the output of the input algorithm that produces them.
+  std::vector<double> Times;
+  vtkSmartPointer<vtkStreamingDemandDrivenPipeline> Executive;
+  int Port;
+
+  vtkAtomicInt32 Stop;
+  vtkAtomicInt32 Running;
+};
+
+//----------------------------------------------------------------------------
+// The default executive, which starts the prefetch once a request for data
+// is complete: until then it may access the information of the input.
+class vtkTemporalDataSetCachePipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkTemporalDataSetCachePipeline* New();
+  vtkTypeMacro(vtkTemporalDataSetCachePipeline, vtkCompositeDataPipeline);
+
+  virtual int ProcessRequest(vtkInformation* request,
+                             vtkInformationVector** inInfoVec,
+                             vtkInformationVector* outInfoVec)
+  {
+    int result = this->Superclass::ProcessRequest(request, inInfoVec,
+                                                  outInfoVec);
+    vtkTemporalDataSetCache* cache =
+      vtkTemporalDataSetCache::SafeDownCast(this->GetAlgorithm());
+    if (result && cache && request->Has(REQUEST_DATA()))
+      {
+      cache->StartPrefetch();
+      }
+    return result;
+  }
+
+protected:
+  vtkTemporalDataSetCachePipeline() {}
+  ~vtkTemporalDataSetCachePipeline() {}
+
+private:
+  vtkTemporalDataSetCachePipeline(const vtkTemporalDataSetCachePipeline&);  // Not implemented.
+  void operator=(const vtkTemporalDataSetCachePipeline&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkTemporalDataSetCachePipeline);
+
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 vtkTemporalDataSetCache::vtkTemporalDataSetCache()
 {
   this->CacheSize = 10;
+  this->Prefetch = 0;
+  this->PrefetchLookahead = 1;
+  this->Prefetcher = new vtkTemporalDataSetCachePrefetch;
   this->SetNumberOfInputPorts(1);
   this->SetNumberOfOutputPorts(1);
 }
@@ -41,6 +105,8 @@ vtkTemporalDataSetCache::vtkTemporalDataSetCache()
 //----------------------------------------------------------------------------
 vtkTemporalDataSetCache::~vtkTemporalDataSetCache()
 {
+  this->WaitForPrefetch();
+  delete this->Prefetcher;
   CacheType::iterator pos = this->Cache.begin();
   for (; pos != this->Cache.end();)
     {
@@ -54,6 +120,9 @@ int vtkTemporalDataSetCache::ProcessRequest(
   vtkInformationVector** inputVector,
   vtkInformationVector* outputVector)
 {
+  // the prefetch thread may be using the cache
+  this->WaitForPrefetch();
+
   // create the output
   if(request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
     {
@@ -103,6 +172,162 @@ void vtkTemporalDataSetCache::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "Prefetch: " << this->Prefetch << endl;
+  os << indent << "PrefetchLookahead: " << this->PrefetchLookahead << endl;
+}
+
+//----------------------------------------------------------------------------
+vtkExecutive* vtkTemporalDataSetCache::CreateDefaultExecutive()
+{
+  return vtkTemporalDataSetCachePipeline::New();
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalDataSetCache::ComputePipelineMTime(
+  vtkInformation* request,
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec,
+  int requestFromOutputPort,
+  unsigned long* mtime)
+{
+  // the executive visits the input next
+  this->WaitForPrefetch();
+  return this->Superclass::ComputePipelineMTime(request, inInfoVec, outInfoVec,
+                                                requestFromOutputPort, mtime);
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalDataSetCache::ModifyRequest(vtkInformation* request, int when)
+{
+  // the executive forwards the request to the input next
+  if (when == vtkExecutive::BeforeForward)
+    {
+    this->WaitForPrefetch();
+    }
+  return this->Superclass::ModifyRequest(request, when);
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::WaitForPrefetch()
+{
+  vtkTemporalDataSetCachePrefetch* prefetcher = this->Prefetcher;
+  if (prefetcher->ThreadId >= 0)
+    {
+    prefetcher->Stop = 1;
+    prefetcher->Threader->TerminateThread(prefetcher->ThreadId);
+    prefetcher->ThreadId = -1;
+    prefetcher->Executive = NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkTemporalDataSetCache::IsPrefetching()
+{
+  vtkTemporalDataSetCachePrefetch* prefetcher = this->Prefetcher;
+  return prefetcher->ThreadId >= 0 && prefetcher->Running;
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::StartPrefetch()
+{
+  vtkTemporalDataSetCachePrefetch* prefetcher = this->Prefetcher;
+  if (!this->Prefetch || prefetcher->Times.empty() ||
+      prefetcher->ThreadId >= 0)
+    {
+    return;
+    }
+
+  // The executive of the input would release the data being cached.
+  int port;
+  vtkAlgorithm* input = this->GetInputAlgorithm(0, 0, port);
+  vtkStreamingDemandDrivenPipeline* executive = input ?
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(input->GetExecutive()) :
+    NULL;
+  if (!executive || executive->GetReleaseDataFlag(port) ||
+      vtkDataObject::GetGlobalReleaseDataFlag())
+    {
+    prefetcher->Times.clear();
+    return;
+    }
+
+  prefetcher->Executive = executive;
+  prefetcher->Port = port;
+  prefetcher->Stop = 0;
+  prefetcher->Running = 1;
+  prefetcher->ThreadId = prefetcher->Threader->SpawnThread(
+    &vtkTemporalDataSetCache::PrefetchThread, this);
+  if (prefetcher->ThreadId < 0)
+    {
+    vtkErrorMacro("Could not start the prefetch thread.");
+    prefetcher->Running = 0;
+    prefetcher->Executive = NULL;
+    prefetcher->Times.clear();
+    }
+}
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkTemporalDataSetCache::PrefetchThread(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  static_cast<vtkTemporalDataSetCache*>(info->UserData)->ExecutePrefetch();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::ExecutePrefetch()
+{
+  vtkTemporalDataSetCachePrefetch* prefetcher = this->Prefetcher;
+  vtkStreamingDemandDrivenPipeline* executive = prefetcher->Executive;
+  vtkInformation* outInfo =
+    executive->GetOutputInformation(prefetcher->Port);
+  for (size_t i = 0; i < prefetcher->Times.size() && !prefetcher->Stop; ++i)
+    {
+    double time = prefetcher->Times[i];
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), time);
+    if (!executive->Update(prefetcher->Port))
+      {
+      break;
+      }
+    vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (data)
+      {
+      this->AddToCache(time, data, data->GetUpdateTime());
+      }
+    }
+  prefetcher->Times.clear();
+  prefetcher->Running = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::AddToCache(double time, vtkDataObject* data,
+                                         unsigned long stamp)
+{
+  // if the cache is full, get rid of the oldest data in the cache
+  if (this->Cache.size() >= static_cast<unsigned long>(this->CacheSize))
+    {
+    CacheType::iterator pos = this->Cache.begin();
+    CacheType::iterator oldestpos = this->Cache.begin();
+    for (; pos != this->Cache.end(); ++pos)
+      {
+      if (pos->second.first < oldestpos->second.first)
+        {
+        oldestpos = pos;
+        }
+      }
+    // if no old data and no room then we are done
+    if (oldestpos->second.first >= stamp)
+      {
+      return;
+      }
+    oldestpos->second.second->UnRegister(this);
+    this->Cache.erase(oldestpos);
+    }
+
+  vtkDataObject* cachedData = data->NewInstance();
+  cachedData->ShallowCopy(data);
+  this->Cache[time] =
+    std::pair<unsigned long, vtkDataObject *>(stamp, cachedData);
 }
 //----------------------------------------------------------------------------
 void vtkTemporalDataSetCache::SetCacheSize(int size)
@@ -113,6 +338,8 @@ void vtkTemporalDataSetCache::SetCacheSize(int size)
     return;
     }
 
+  this->WaitForPrefetch();
+
   // if growing the cache, there is no need to do anything
   this->CacheSize = size;
   if (this->Cache.size() <= static_cast<unsigned long>(size))
@@ -324,41 +551,31 @@ int vtkTemporalDataSetCache::RequestData(
   // size add the requested data to the cache first
   if(input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
     {
-
-// is the input time not already in the cache?
-    CacheType::iterator pos1 = this->Cache.find(inTime);
-    if (pos1 == this->Cache.end())
+    // is the input time not already in the cache?
+    if (this->Cache.find(inTime) == this->Cache.end())
       {
-      // if we have room in the Cache then just add the new data
-      if (this->Cache.size() < static_cast<unsigned long>(this->CacheSize))
-        {
-        vtkDataObject* cachedData  = input->NewInstance();
-        cachedData->ShallowCopy(input);
+      this->AddToCache(inTime, input, outputUpdateTime);
+      }
+    }
 
-        this->Cache[inTime] =
-          std::pair<unsigned long, vtkDataObject *>
-          (outputUpdateTime, cachedData);
-        }
-      // no room in the cache, we need to get rid of something
-      else
+  // select the time steps that follow the requested one and that are not
+  // cached yet, the executive starts prefetching them when we are done
+  this->Prefetcher->Times.clear();
+  if (this->Prefetch &&
+      inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+    {
+    double *timeSteps =
+      inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    int numTimeSteps =
+      inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    int lookahead = std::min(this->PrefetchLookahead, this->CacheSize - 1);
+    double *next = std::upper_bound(timeSteps, timeSteps + numTimeSteps,
+                                    upTime);
+    for (int i = 0; next + i < timeSteps + numTimeSteps && i < lookahead; ++i)
+      {
+      if (this->Cache.find(next[i]) == this->Cache.end())
         {
-        // get rid of the oldest data in the cache
-        CacheType::iterator pos2 = this->Cache.begin();
-        CacheType::iterator oldestpos = this->Cache.begin();
-        for (; pos2 != this->Cache.end(); ++pos2)
-          {
-          if (pos2->second.first < oldestpos->second.first)
-            {
-            oldestpos = pos2;
-            }
-          }
-        //was there old data?
-        if (oldestpos->second.first < outputUpdateTime)
-          {
-          oldestpos->second.second->UnRegister(this);
-          this->Cache.erase(oldestpos);
-          }
-        // if no old data and no room then we are done
+        this->Prefetcher->Times.push_back(next[i]);
         }
       }
     }
@@ -16,6 +16,20 @@
 // .SECTION Description
 // vtkTemporalDataSetCache cache time step requests of a temporal dataset,
 // when cached data is requested it is returned using a shallow copy.
+//
+// When Prefetch is on, each time a time step is delivered the cache
+// updates its input for the PrefetchLookahead time steps that follow it
+// in a background thread, and caches them. During the playback of a time
+// series the next time steps are then read while the current one is
+// processed and rendered downstream.
+//
+// While a prefetch runs, the background thread owns the pipeline upstream
+// of the cache: the application must not modify, update or access the
+// outputs of the algorithms it contains. Requests going through the cache
+// stop the prefetch after the time step being read and wait for it, as
+// does WaitForPrefetch(). Prefetching is disabled when another executive
+// than the default one is set on the cache, or when the input releases
+// its data.
 // .SECTION Thanks
 // Ken Martin (Kitware) and John Bidiscombe of
 // CSCS - Swiss National Supercomputing Centre
@@ -31,8 +45,11 @@
 #include "vtkFiltersHybridModule.h" // For export macro
 
 #include "vtkAlgorithm.h"
+#include "vtkMultiThreader.h" // For VTK_THREAD_RETURN_TYPE
 #include <map> // used for the cache
 
+class vtkTemporalDataSetCachePrefetch;
+
 class VTKFILTERSHYBRID_EXPORT vtkTemporalDataSetCache : public vtkAlgorithm
 {
 public:
@@ -46,11 +63,44 @@ public:
   void SetCacheSize(int size);
   vtkGetMacro(CacheSize,int);
 
+  // Description:
+  // Enable/Disable prefetching the time steps following the one
+  // delivered in a background thread. Off by default.
+  vtkSetMacro(Prefetch, int);
+  vtkGetMacro(Prefetch, int);
+  vtkBooleanMacro(Prefetch, int);
+
+  // Description:
+  // The number of time steps prefetched after the one delivered. At most
+  // CacheSize - 1 time steps are prefetched. The default is 1.
+  vtkSetClampMacro(PrefetchLookahead, int, 1, VTK_INT_MAX);
+  vtkGetMacro(PrefetchLookahead, int);
+
+  // Description:
+  // Stop the running prefetch once the time step it reads is cached, and
+  // wait for it.
+  void WaitForPrefetch();
+
+  // Description:
+  // Return whether a prefetch is running.
+  bool IsPrefetching();
+
+  // Description:
+  // see vtkAlgorithm for details
+  virtual int ComputePipelineMTime(vtkInformation* request,
+                                   vtkInformationVector** inInfoVec,
+                                   vtkInformationVector* outInfoVec,
+                                   int requestFromOutputPort,
+                                   unsigned long* mtime);
+  virtual int ModifyRequest(vtkInformation* request, int when);
+
 protected:
   vtkTemporalDataSetCache();
   ~vtkTemporalDataSetCache();
 
   int CacheSize;
+  int Prefetch;
+  int PrefetchLookahead;
 
 //BTX
   typedef std::map<double,std::pair<unsigned long,vtkDataObject *> >
@@ -58,6 +108,23 @@ protected:
   CacheType Cache;
 //ETX
 
+  // Add a shallow copy of the data to the cache, evicting the entry with
+  // the oldest time stamp if the cache is full.
+  void AddToCache(double time, vtkDataObject* data, unsigned long stamp);
+
+  // Start prefetching the time steps selected by RequestData(), called by
+  // the executive once the request for data is complete.
+  void StartPrefetch();
+
+  // Executed by the prefetch thread.
+  void ExecutePrefetch();
+  static VTK_THREAD_RETURN_TYPE PrefetchThread(void *arg);
+
+  // Create the executive that starts the prefetch.
+  virtual vtkExecutive* CreateDefaultExecutive();
+
+  vtkTemporalDataSetCachePrefetch* Prefetcher;
+
 
   // Description:
   // see vtkAlgorithm for details
@@ -80,6 +147,8 @@ protected:
                           vtkInformationVector *);
 
 private:
+  friend class vtkTemporalDataSetCachePipeline;
+
   vtkTemporalDataSetCache(const vtkTemporalDataSetCache&);  // Not implemented.
   void operator=(const vtkTemporalDataSetCache&);  // Not implemented.
 };
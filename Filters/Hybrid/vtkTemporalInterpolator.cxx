@@ -24,12 +24,14 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkMultiBlockDataSet.h"
 
 #include <algorithm>
+#include <cstring>
 #include <vector>
 
 vtkStandardNewMacro(vtkTemporalInterpolator);
@@ -570,12 +572,15 @@ vtkDataSet *vtkTemporalInterpolator
                         << " because the number of tuples/components"
                         << " in each time step are different");
         }
-      // allocate double for output if input is double - otherwise float
-      vtkDataArray *outarray =
-        this->InterpolateDataArray(ratio, &arrays[0],
-                                   arrays[0]->GetNumberOfTuples());
-      output->GetCellData()->AddArray(outarray);
-      outarray->Delete();
+      else
+        {
+        // allocate double for output if input is double - otherwise float
+        vtkDataArray *outarray =
+          this->InterpolateDataArray(ratio, &arrays[0],
+                                     arrays[0]->GetNumberOfTuples());
+        output->GetCellData()->AddArray(outarray);
+        outarray->Delete();
+        }
       }
     else
       {
@@ -590,6 +595,31 @@ vtkDataSet *vtkTemporalInterpolator
 }
 
 
+//----------------------------------------------------------------------------
+// Blend the values of two arrays of the same type into a third.
+template <class T>
+struct vtkTemporalInterpolatorBlend
+{
+  const T *InData0;
+  const T *InData1;
+  T *OutData;
+  double Ratio;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const double oneMinusRatio = 1.0 - this->Ratio;
+    const double ratio = this->Ratio;
+    const T *inData0 = this->InData0;
+    const T *inData1 = this->InData1;
+    T *outData = this->OutData;
+    for (vtkIdType idx = begin; idx < end; ++idx)
+      {
+      outData[idx] = static_cast<T>(inData0[idx]*oneMinusRatio +
+                                    inData1[idx]*ratio);
+      }
+  }
+};
+
 //----------------------------------------------------------------------------
 // This templated function executes the filter for any type of data.
 template <class T>
@@ -598,23 +628,39 @@ void vtkTemporalInterpolatorExecute(vtkTemporalInterpolator *,
                                     vtkDataArray *output,
                                     vtkDataArray **arrays,
                                     int numComp,
-                                    int numTuple,
+                                    vtkIdType numTuple,
                                     T *)
 {
-  T *outData = static_cast<T*>(output->GetVoidPointer(0));
-  T *inData0 = static_cast<T*>(arrays[0]->GetVoidPointer(0));
-  T *inData1 = static_cast<T*>(arrays[1]->GetVoidPointer(0));
-
-  double oneMinusRatio = 1.0 - ratio;
+  vtkTemporalInterpolatorBlend<T> blend = {
+    static_cast<T*>(arrays[0]->GetVoidPointer(0)),
+    static_cast<T*>(arrays[1]->GetVoidPointer(0)),
+    static_cast<T*>(output->GetVoidPointer(0)),
+    ratio };
+  vtkSMPTools::For(0, numTuple*numComp, blend);
+}
 
-  unsigned long idx;
-  for (idx = 0; idx < static_cast<unsigned long>(numTuple*numComp); ++idx)
+//----------------------------------------------------------------------------
+// Whether the two arrays hold the same values, in which case there is
+// nothing to interpolate. Data that does not change over time is often
+// shared by the time steps, or read again with the same bytes.
+static bool vtkTemporalInterpolatorSameValues(vtkDataArray **arrays,
+                                              vtkIdType N)
+{
+  if (arrays[0] == arrays[1])
     {
-    *outData = static_cast<T>((*inData0)*oneMinusRatio + (*inData1)*ratio);
-    outData++;
-    inData0++;
-    inData1++;
-  }
+    return true;
+    }
+  if (arrays[0]->GetDataType() != arrays[1]->GetDataType() ||
+      arrays[0]->GetDataType() == VTK_BIT ||
+      !arrays[0]->HasStandardMemoryLayout() ||
+      !arrays[1]->HasStandardMemoryLayout())
+    {
+    return false;
+    }
+  size_t size = static_cast<size_t>(N) *
+    arrays[0]->GetNumberOfComponents() * arrays[0]->GetDataTypeSize();
+  return size == 0 || memcmp(arrays[0]->GetVoidPointer(0),
+                             arrays[1]->GetVoidPointer(0), size) == 0;
 }
 
 
@@ -622,6 +668,15 @@ void vtkTemporalInterpolatorExecute(vtkTemporalInterpolator *,
 vtkDataArray *vtkTemporalInterpolator
 ::InterpolateDataArray(double ratio, vtkDataArray **arrays, vtkIdType N)
 {
+  //
+  // Identical arrays are passed as they are
+  //
+  if (vtkTemporalInterpolatorSameValues(arrays, N))
+    {
+    arrays[0]->Register(this);
+    return arrays[0];
+    }
+
   //
   // Create the output
   //
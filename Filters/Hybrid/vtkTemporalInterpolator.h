@@ -135,7 +135,9 @@ protected:
 
   // Description:
   // Interpolate a single vtkDataArray. Called from the Interpolation routine
-  // on the points and pointdata/celldata
+  // on the points and pointdata/celldata. When both arrays hold the same
+  // values, the first one is returned with a new reference instead of a
+  // blended copy.
   virtual vtkDataArray *InterpolateDataArray(double ratio,
                                              vtkDataArray **arrays,
                                              vtkIdType N);
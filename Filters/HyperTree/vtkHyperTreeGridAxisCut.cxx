@@ -19,6 +19,7 @@
 #include "vtkCellData.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkHyperTreeGrid.h"
+#include "vtkHyperTreeGridCellBuffer.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -137,21 +138,10 @@ void vtkHyperTreeGridAxisCut::ProcessTrees()
   this->Points = vtkPoints::New();
   this->Cells = vtkCellArray::New();
 
-  // Iterate over all hyper trees
-  vtkIdType index;
-  vtkHyperTreeGrid::vtkHyperTreeIterator it;
-  this->Input->InitializeTreeIterator( it );
-  while ( it.GetNextTree( index ) )
-    {
-    // Storage for super cursors
-    vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor superCursor;
-
-    // Initialize center cursor
-    this->Input->InitializeSuperCursor( &superCursor, index );
-
-    // Traverse and populate dual recursively
-    this->RecursiveProcessTree( &superCursor );
-    } // it
+  // Traverse all hyper trees in parallel, one quad per cut leaf
+  vtkHyperTreeGridProcessTrees( this->Input, this,
+    &vtkHyperTreeGridAxisCut::RecursiveProcessTree, 4, false,
+    this->Points, this->Cells, this->InData, this->OutData );
 
   // Set output geometry and topology
   this->Output->SetPoints( this->Points );
@@ -166,29 +156,28 @@ void vtkHyperTreeGridAxisCut::ProcessTrees()
 //----------------------------------------------------------------------------
 void vtkHyperTreeGridAxisCut::AddFace( vtkIdType inId, double* origin,
                                        double* size, double offset0,
-                                       int axis0, int axis1, int axis2 )
+                                       int axis0, int axis1, int axis2,
+                                       vtkHyperTreeGridCellBuffer* buffer )
 {
   // Generate 4 points
   double pt[3];
   memcpy( pt, origin, 3 * sizeof(double) );
   pt[axis0] += size[axis0] * offset0;
 
-  // Storage for cell IDs
-  vtkIdType ids[4];
-  ids[0] = this->Points->InsertNextPoint( pt );
+  buffer->InsertNextPoint( pt );
   pt[axis1] += size[axis1];
-  ids[1] = this->Points->InsertNextPoint( pt );
+  buffer->InsertNextPoint( pt );
   pt[axis2] += size[axis2];
-  ids[2] = this->Points->InsertNextPoint( pt );
+  buffer->InsertNextPoint( pt );
   pt[axis1] = origin[axis1];
-  ids[3] = this->Points->InsertNextPoint( pt );
+  buffer->InsertNextPoint( pt );
 
-  vtkIdType outId = this->Cells->InsertNextCell( 4, ids );
-  this->OutData->CopyData( this->InData, inId, outId );
+  buffer->InsertNextCell( inId );
 }
 
 //----------------------------------------------------------------------------
-void vtkHyperTreeGridAxisCut::RecursiveProcessTree( void* sc )
+void vtkHyperTreeGridAxisCut::RecursiveProcessTree( void* sc,
+                                                    vtkHyperTreeGridCellBuffer* buffer )
 {
   vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor* superCursor =
     static_cast<vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor*>( sc );
@@ -199,7 +188,7 @@ void vtkHyperTreeGridAxisCut::RecursiveProcessTree( void* sc )
   if ( cursor0->IsLeaf() )
     {
     // Cursor is a leaf
-    ProcessLeaf3D( sc );
+    ProcessLeaf3D( sc, buffer );
     }
   else
     {
@@ -209,13 +198,14 @@ void vtkHyperTreeGridAxisCut::RecursiveProcessTree( void* sc )
       {
       vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor newSuperCursor;
       this->Input->InitializeSuperCursorChild( superCursor,&newSuperCursor, child );
-      this->RecursiveProcessTree( &newSuperCursor );
+      this->RecursiveProcessTree( &newSuperCursor, buffer );
       }
     }
 }
 
 //----------------------------------------------------------------------------
-void vtkHyperTreeGridAxisCut::ProcessLeaf3D( void* sc )
+void vtkHyperTreeGridAxisCut::ProcessLeaf3D( void* sc,
+                                             vtkHyperTreeGridCellBuffer* buffer )
 {
   // Get cursor at super cursor center
   vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor* superCursor =
@@ -263,5 +253,5 @@ void vtkHyperTreeGridAxisCut::ProcessLeaf3D( void* sc )
     }
 
   this->AddFace( inId, superCursor->Origin, superCursor->Size, k,
-    this->PlaneNormalAxis, axis1, axis2 );
+    this->PlaneNormalAxis, axis1, axis2, buffer );
 }
@@ -36,6 +36,7 @@
 class vtkCellArray;
 class vtkDataSetAttributes;
 class vtkHyperTreeGrid;
+class vtkHyperTreeGridCellBuffer;
 class vtkPoints;
 
 class VTKFILTERSHYPERTREE_EXPORT vtkHyperTreeGridAxisCut : public vtkPolyDataAlgorithm
@@ -63,10 +64,14 @@ protected:
   virtual int FillInputPortInformation( int, vtkInformation* );
 
   void ProcessTrees();
-  void RecursiveProcessTree( void* );
-  void ProcessLeaf3D( void* );
+  // Description:
+  // Generate the cut of a tree, or a subtree, into buffer. Different
+  // trees can be processed at the same time by different threads.
+  void RecursiveProcessTree( void*, vtkHyperTreeGridCellBuffer* buffer );
+  void ProcessLeaf3D( void*, vtkHyperTreeGridCellBuffer* buffer );
   void AddFace( vtkIdType inId, double* origin, double* size,
-                double offset0, int axis0, int axis1, int axis2 );
+                double offset0, int axis0, int axis1, int axis2,
+                vtkHyperTreeGridCellBuffer* buffer );
 
   int PlaneNormalAxis;
   double PlanePosition;
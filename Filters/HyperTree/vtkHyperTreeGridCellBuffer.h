@@ -0,0 +1,340 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHyperTreeGridCellBuffer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkHyperTreeGridCellBuffer - Cells generated from a block of trees
+//
+// .SECTION Description
+// Private helper of the hyper tree grid filters that generate one cell of
+// fixed size, with its own points, per visited leaf or face.
+// vtkHyperTreeGridProcessTrees() splits the level 0 trees of the input into
+// blocks of consecutive trees holding about as many leaves, traverses the
+// blocks in parallel with vtkSMPTools, each into its own
+// vtkHyperTreeGridCellBuffer, and then copies the buffers in parallel to
+// their ranges of the presized output, in block order. The output is thus
+// the same as the one of a serial traversal, whatever the number of threads.
+
+#ifndef vtkHyperTreeGridCellBuffer_h
+#define vtkHyperTreeGridCellBuffer_h
+
+#include "vtkCellArray.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkHyperTree.h"
+#include "vtkHyperTreeGrid.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm> // For std::lower_bound
+#include <vector> // For point and cell storage
+
+class vtkHyperTreeGridCellBuffer
+{
+public:
+  vtkHyperTreeGridCellBuffer()
+    : CellSize( 0 ), NumberOfCellsWithoutData( 0 )
+  {
+  }
+
+  // Description:
+  // Set the number of points of all cells, at most 8.
+  void SetCellSize( int size )
+  {
+    this->CellSize = size;
+  }
+
+  // Description:
+  // Reserve storage for numCells cells, e.g. from the number of leaves of
+  // the trees of the block.
+  void Reserve( vtkIdType numCells )
+  {
+    this->Coordinates.reserve( 3 * this->CellSize * numCells );
+    this->InputIds.reserve( numCells );
+  }
+
+  // Description:
+  // Add a point to the cell being built. The coordinates are stored as
+  // float, the type of the output points.
+  void InsertNextPoint( const double pt[3] )
+  {
+    this->Coordinates.push_back( static_cast<float>( pt[0] ) );
+    this->Coordinates.push_back( static_cast<float>( pt[1] ) );
+    this->Coordinates.push_back( static_cast<float>( pt[2] ) );
+  }
+
+  // Description:
+  // Close the cell made of the last CellSize points. Its data is copied
+  // from the input point data at inId, unless inId is negative.
+  void InsertNextCell( vtkIdType inId )
+  {
+    this->InputIds.push_back( inId );
+    if ( inId < 0 )
+      {
+      ++ this->NumberOfCellsWithoutData;
+      }
+  }
+
+  vtkIdType GetNumberOfCells()
+  {
+    return static_cast<vtkIdType>( this->InputIds.size() );
+  }
+
+  vtkIdType GetNumberOfCellsWithoutData()
+  {
+    return this->NumberOfCellsWithoutData;
+  }
+
+  // Description:
+  // Write the cells to the output, as cells firstCell and above of a
+  // presized output, each with new points. The connectivity array holds
+  // CellSize + 1 ids per cell.
+  void CopyGeometry( vtkIdType firstCell, vtkPoints* points,
+                     vtkIdType* connectivity )
+  {
+    const float* pt = this->Coordinates.empty() ? 0 : &this->Coordinates[0];
+    vtkIdType ptId = firstCell * this->CellSize;
+    vtkIdType* cell = connectivity + firstCell * ( this->CellSize + 1 );
+    vtkIdType numCells = this->GetNumberOfCells();
+    for ( vtkIdType c = 0; c < numCells; ++ c )
+      {
+      *cell++ = this->CellSize;
+      for ( int i = 0; i < this->CellSize; ++ i, pt += 3, ++ ptId )
+        {
+        points->SetPoint( ptId, pt );
+        *cell++ = ptId;
+        }
+      }
+  }
+
+  // Description:
+  // Copy the data of the cells to the output, as cells firstCell and above.
+  void CopyData( vtkIdType firstCell, vtkDataSetAttributes* inData,
+                 vtkDataSetAttributes* outData )
+  {
+    vtkIdType numCells = this->GetNumberOfCells();
+    for ( vtkIdType c = 0; c < numCells; ++ c )
+      {
+      if ( this->InputIds[c] >= 0 )
+        {
+        outData->CopyData( inData, this->InputIds[c], firstCell + c );
+        }
+      }
+  }
+
+protected:
+  int CellSize;
+  vtkIdType NumberOfCellsWithoutData;
+  std::vector<float> Coordinates;
+  std::vector<vtkIdType> InputIds;
+};
+
+//-----------------------------------------------------------------------------
+// Traverse the blocks of trees of a filter; used by vtkHyperTreeGridProcessTrees
+template <class Filter>
+class vtkHyperTreeGridProcessTreesFunctor
+{
+public:
+  typedef void ( Filter::*ProcessTreeMethod )( void*,
+                                               vtkHyperTreeGridCellBuffer* );
+
+  vtkHyperTreeGrid* Input;
+  Filter* Self;
+  ProcessTreeMethod Process;
+  const std::vector<vtkIdType>* Trees;
+  // Prefix sums of the numbers of leaves of the trees
+  const std::vector<vtkIdType>* Leaves;
+  // First tree of each block, and the number of trees at the end
+  const std::vector<vtkIdType>* FirstTrees;
+  bool ReserveLeaves;
+  std::vector<vtkHyperTreeGridCellBuffer>* Buffers;
+
+  void operator()( vtkIdType begin, vtkIdType end )
+  {
+    for ( vtkIdType block = begin; block < end; ++ block )
+      {
+      vtkIdType first = ( *this->FirstTrees )[block];
+      vtkIdType last = ( *this->FirstTrees )[block + 1];
+      vtkHyperTreeGridCellBuffer& buffer = ( *this->Buffers )[block];
+      if ( this->ReserveLeaves )
+        {
+        buffer.Reserve( ( *this->Leaves )[last] - ( *this->Leaves )[first] );
+        }
+      for ( vtkIdType t = first; t < last; ++ t )
+        {
+        // Storage for super cursors
+        vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor superCursor;
+
+        // Initialize center cursor
+        this->Input->InitializeSuperCursor( &superCursor,
+                                            ( *this->Trees )[t] );
+
+        // Traverse and populate the block buffer recursively
+        ( this->Self->*this->Process )( &superCursor, &buffer );
+        }
+      }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Write the buffers to their ranges of the presized output; used by
+// vtkHyperTreeGridProcessTrees
+class vtkHyperTreeGridMergeBuffersFunctor
+{
+public:
+  std::vector<vtkHyperTreeGridCellBuffer>* Buffers;
+  const std::vector<vtkIdType>* FirstCells;
+  vtkPoints* Points;
+  vtkIdType* Connectivity;
+  vtkDataSetAttributes* InData;
+  vtkDataSetAttributes* OutData;
+
+  void operator()( vtkIdType begin, vtkIdType end )
+  {
+    for ( vtkIdType block = begin; block < end; ++ block )
+      {
+      vtkHyperTreeGridCellBuffer& buffer = ( *this->Buffers )[block];
+      vtkIdType firstCell = ( *this->FirstCells )[block];
+      buffer.CopyGeometry( firstCell, this->Points, this->Connectivity );
+      if ( this->OutData )
+        {
+        buffer.CopyData( firstCell, this->InData, this->OutData );
+        }
+      }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Whether all the arrays of data can be written from several threads once
+// presized
+inline bool vtkHyperTreeGridAreArraysThreadSafe( vtkDataSetAttributes* data )
+{
+  for ( int i = 0; i < data->GetNumberOfArrays(); ++ i )
+    {
+    vtkDataArray* array = vtkDataArray::SafeDownCast( data->GetAbstractArray( i ) );
+    if ( ! array || array->GetDataType() == VTK_BIT
+         || ! array->HasStandardMemoryLayout() )
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// Call the process method of self on the super cursor of each level 0 tree
+// of input, in parallel, and write the generated cells of cellSize points
+// to points and cells in the order of the trees. When the filter generates
+// at most one cell per leaf, reserveLeaves presizes the buffers from the
+// numbers of leaves of the trees.
+// \pre GenerateSuperCursorTraversalTable() was called on input.
+template <class Filter>
+void vtkHyperTreeGridProcessTrees(
+  vtkHyperTreeGrid* input, Filter* self,
+  typename vtkHyperTreeGridProcessTreesFunctor<Filter>::ProcessTreeMethod process,
+  int cellSize, bool reserveLeaves, vtkPoints* points, vtkCellArray* cells,
+  vtkDataSetAttributes* inData, vtkDataSetAttributes* outData )
+{
+  // Level 0 trees in index order, with the prefix sums of their leaves
+  std::vector<vtkIdType> trees;
+  std::vector<vtkIdType> leaves( 1, 0 );
+  vtkHyperTreeGrid::vtkHyperTreeIterator it;
+  input->InitializeTreeIterator( it );
+  vtkIdType index;
+  while ( vtkHyperTree* tree = it.GetNextTree( index ) )
+    {
+    trees.push_back( index );
+    leaves.push_back( leaves.back() + tree->GetNumberOfLeaves() );
+    }
+  vtkIdType numTrees = static_cast<vtkIdType>( trees.size() );
+  if ( numTrees == 0 )
+    {
+    return;
+    }
+
+  // More blocks than threads, cut where the leaves are evenly shared since
+  // the sizes of trees vary
+  const vtkIdType maxNumberOfBlocks = 1024;
+  vtkIdType numBlocks =
+    numTrees < maxNumberOfBlocks ? numTrees : maxNumberOfBlocks;
+  vtkIdType numLeaves = leaves.back();
+  std::vector<vtkIdType> firstTrees( numBlocks + 1, numTrees );
+  firstTrees[0] = 0;
+  for ( vtkIdType b = 1; b < numBlocks; ++ b )
+    {
+    vtkIdType t = static_cast<vtkIdType>(
+      std::lower_bound( leaves.begin(), leaves.end(), numLeaves * b / numBlocks )
+      - leaves.begin() );
+    firstTrees[b] = std::max( firstTrees[b - 1], t );
+    }
+
+  std::vector<vtkHyperTreeGridCellBuffer> buffers( numBlocks );
+  for ( vtkIdType b = 0; b < numBlocks; ++ b )
+    {
+    buffers[b].SetCellSize( cellSize );
+    }
+
+  vtkHyperTreeGridProcessTreesFunctor<Filter> functor;
+  functor.Input = input;
+  functor.Self = self;
+  functor.Process = process;
+  functor.Trees = &trees;
+  functor.Leaves = &leaves;
+  functor.FirstTrees = &firstTrees;
+  functor.ReserveLeaves = reserveLeaves;
+  functor.Buffers = &buffers;
+  vtkSMPTools::For( 0, numBlocks, 1, functor );
+
+  // Place the blocks in order
+  std::vector<vtkIdType> firstCells( numBlocks + 1, 0 );
+  vtkIdType numCellsWithoutData = 0;
+  for ( vtkIdType b = 0; b < numBlocks; ++ b )
+    {
+    firstCells[b + 1] = firstCells[b] + buffers[b].GetNumberOfCells();
+    numCellsWithoutData += buffers[b].GetNumberOfCellsWithoutData();
+    }
+  vtkIdType numCells = firstCells[numBlocks];
+
+  // Presize the output and write the blocks in parallel. Cell data is
+  // copied in parallel too when every cell has some and all arrays allow it.
+  points->SetNumberOfPoints( numCells * cellSize );
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfTuples( numCells * ( cellSize + 1 ) );
+  bool parallelData = numCellsWithoutData == 0
+    && vtkHyperTreeGridAreArraysThreadSafe( outData );
+  if ( parallelData )
+    {
+    outData->SetNumberOfTuples( numCells );
+    }
+
+  vtkHyperTreeGridMergeBuffersFunctor merge;
+  merge.Buffers = &buffers;
+  merge.FirstCells = &firstCells;
+  merge.Points = points;
+  merge.Connectivity = connectivity->GetPointer( 0 );
+  merge.InData = inData;
+  merge.OutData = parallelData ? outData : 0;
+  vtkSMPTools::For( 0, numBlocks, 1, merge );
+  cells->SetCells( numCells, connectivity.GetPointer() );
+
+  if ( ! parallelData )
+    {
+    for ( vtkIdType b = 0; b < numBlocks; ++ b )
+      {
+      buffers[b].CopyData( firstCells[b], inData, outData );
+      }
+    }
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkHyperTreeGridCellBuffer.h
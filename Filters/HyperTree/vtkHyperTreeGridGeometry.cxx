@@ -20,6 +20,7 @@
 #include "vtkDataSetAttributes.h"
 #include "vtkExtentTranslator.h"
 #include "vtkHyperTreeGrid.h"
+#include "vtkHyperTreeGridCellBuffer.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -106,25 +107,18 @@ void vtkHyperTreeGridGeometry::ProcessTrees()
   this->Points = vtkPoints::New();
   this->Cells = vtkCellArray::New();
 
-  // Iterate over all hyper trees
-  vtkIdType index;
-  vtkHyperTreeGrid::vtkHyperTreeIterator it;
-  this->Input->InitializeTreeIterator( it );
-  while ( it.GetNextTree( index ) )
-    {
-    // Storage for super cursors
-    vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor superCursor;
-
-    // Initialize center cursor
-    this->Input->InitializeSuperCursor( &superCursor, index );
-
-    // Traverse and populate dual recursively
-    this->RecursiveProcessTree( &superCursor );
-    } // it
+  // Traverse all hyper trees in parallel, one 2-point line per leaf in 1D
+  // and one quad per face otherwise. Only in 3D can a leaf have several
+  // faces, but most leaves have none there.
+  unsigned int dimension = this->Input->GetDimension();
+  vtkHyperTreeGridProcessTrees( this->Input, this,
+    &vtkHyperTreeGridGeometry::RecursiveProcessTree,
+    dimension == 1 ? 2 : 4, dimension < 3,
+    this->Points, this->Cells, this->InData, this->OutData );
 
   // Set output geometry and topology
   this->Output->SetPoints( this->Points );
-  if ( this->Input->GetDimension() == 1  )
+  if ( dimension == 1 )
     {
     this->Output->SetLines( this->Cells );
     }
@@ -140,7 +134,8 @@ void vtkHyperTreeGridGeometry::ProcessTrees()
 }
 
 //----------------------------------------------------------------------------
-void vtkHyperTreeGridGeometry::RecursiveProcessTree( void* sc )
+void vtkHyperTreeGridGeometry::RecursiveProcessTree( void* sc,
+                                                     vtkHyperTreeGridCellBuffer* buffer )
 {
   // Get cursor at super cursor center
   vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor* superCursor =
@@ -151,13 +146,13 @@ void vtkHyperTreeGridGeometry::RecursiveProcessTree( void* sc )
     switch ( this->Input->GetDimension() )
       {
       case 1:
-        ProcessLeaf1D( sc );
+        ProcessLeaf1D( sc, buffer );
         break;
       case 2:
-        ProcessLeaf2D( sc );
+        ProcessLeaf2D( sc, buffer );
         break;
       case 3:
-        ProcessLeaf3D( sc );
+        ProcessLeaf3D( sc, buffer );
         break;
       }
     }
@@ -169,30 +164,31 @@ void vtkHyperTreeGridGeometry::RecursiveProcessTree( void* sc )
       {
       vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor newSuperCursor;
       this->Input->InitializeSuperCursorChild( superCursor, &newSuperCursor, child );
-      this->RecursiveProcessTree( &newSuperCursor );
+      this->RecursiveProcessTree( &newSuperCursor, buffer );
       }
     }
 }
 
 //----------------------------------------------------------------------------
-void vtkHyperTreeGridGeometry::ProcessLeaf1D( void* sc )
+void vtkHyperTreeGridGeometry::ProcessLeaf1D( void* sc,
+                                              vtkHyperTreeGridCellBuffer* buffer )
 {
   vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor* superCursor =
     static_cast<vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor*>( sc );
 
   // In 1D the geometry is composed of edges
-  vtkIdType ids[2];
-  ids[0] = this->Points->InsertNextPoint( superCursor->Origin );
+  buffer->InsertNextPoint( superCursor->Origin );
   double pt[3];
   pt[0] = superCursor->Origin[0] + superCursor->Size[0];
   pt[1] = superCursor->Origin[1];
   pt[2] = superCursor->Origin[2];
-  ids[1] = this->Points->InsertNextPoint( pt );
-  this->Cells->InsertNextCell( 2, ids );
+  buffer->InsertNextPoint( pt );
+  buffer->InsertNextCell( -1 );
 }
 
 //----------------------------------------------------------------------------
-void vtkHyperTreeGridGeometry::ProcessLeaf2D( void* sc )
+void vtkHyperTreeGridGeometry::ProcessLeaf2D( void* sc,
+                                              vtkHyperTreeGridCellBuffer* buffer )
 {
   // Get cursor at super cursor center
   vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor* superCursor =
@@ -204,12 +200,14 @@ void vtkHyperTreeGridGeometry::ProcessLeaf2D( void* sc )
   // In 2D all unmasked faces are generated
   if ( id0 >= 0 && ! this->Input->GetMaterialMask()->GetValue( id0 ) )
     {
-    this->AddFace( id0, superCursor->Origin, superCursor->Size, 0, 2 );
+    this->AddFace( id0, superCursor->Origin, superCursor->Size, 0, 2,
+                   buffer );
     }
 }
 
 //----------------------------------------------------------------------------
-void vtkHyperTreeGridGeometry::ProcessLeaf3D( void* sc )
+void vtkHyperTreeGridGeometry::ProcessLeaf3D( void* sc,
+                                              vtkHyperTreeGridCellBuffer* buffer )
 {
   // Get cursor at super cursor center
   vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor* superCursor =
@@ -245,7 +243,8 @@ void vtkHyperTreeGridGeometry::ProcessLeaf3D( void* sc )
 
           if ( id >=0 && ! matMask->GetValue( id ) )
             {
-            this->AddFace( id0, superCursor->Origin, superCursor->Size, o, f );
+            this->AddFace( id0, superCursor->Origin, superCursor->Size, o, f,
+                           buffer );
             }
           }
         }
@@ -256,7 +255,8 @@ void vtkHyperTreeGridGeometry::ProcessLeaf3D( void* sc )
           ||
           ( cursor->IsLeaf() && matMask->GetValue( id ) ) )
           {
-          this->AddFace( id0, superCursor->Origin, superCursor->Size, o, f );
+          this->AddFace( id0, superCursor->Origin, superCursor->Size, o, f,
+                         buffer );
           }
         }
       } // o
@@ -266,7 +266,8 @@ void vtkHyperTreeGridGeometry::ProcessLeaf3D( void* sc )
 //----------------------------------------------------------------------------
 void vtkHyperTreeGridGeometry::AddFace( vtkIdType inId,
                                         double* origin, double* size,
-                                        int offset, int orientation )
+                                        int offset, int orientation,
+                                        vtkHyperTreeGridCellBuffer* buffer )
 {
   // Initialize point
   double pt[3];
@@ -277,26 +278,21 @@ void vtkHyperTreeGridGeometry::AddFace( vtkIdType inId,
     pt[orientation] += size[orientation];
     }
 
-  // Storage for face vertices
-  vtkIdType ids[4];
-
   // Create origin vertex
-  ids[0] = this->Points->InsertNextPoint( pt );
+  buffer->InsertNextPoint( pt );
 
   // Create other face vertices depending on orientation
   int axis1 = ( orientation == 0 ) ? 1 : 0;
   int axis2 = ( orientation == 2 ) ? 1 : 2;
 
   pt[axis1] += size[axis1];
-  ids[1] = this->Points->InsertNextPoint( pt );
+  buffer->InsertNextPoint( pt );
   pt[axis2] += size[axis2];
-  ids[2] = this->Points->InsertNextPoint( pt );
+  buffer->InsertNextPoint( pt );
   pt[axis1] = origin[axis1];
-  ids[3] = this->Points->InsertNextPoint( pt );
-
-  // Insert face
-  vtkIdType outId = this->Cells->InsertNextCell( 4, ids );
+  buffer->InsertNextPoint( pt );
 
-  // Copy face data from that of the cell from which it comes
-  this->OutData->CopyData( this->InData, inId, outId );
+  // Insert face, whose data is copied from that of the cell from which it
+  // comes
+  buffer->InsertNextCell( inId );
 }
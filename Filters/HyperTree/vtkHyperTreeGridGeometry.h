@@ -31,6 +31,7 @@
 class vtkCellArray;
 class vtkDataSetAttributes;
 class vtkHyperTreeGrid;
+class vtkHyperTreeGridCellBuffer;
 class vtkPoints;
 
 class VTKFILTERSHYPERTREE_EXPORT vtkHyperTreeGridGeometry : public vtkPolyDataAlgorithm
@@ -49,12 +50,16 @@ protected:
   virtual int FillInputPortInformation( int, vtkInformation* );
 
   void ProcessTrees();
-  void RecursiveProcessTree( void* );
-  void ProcessLeaf1D( void* );
-  void ProcessLeaf2D( void* );
-  void ProcessLeaf3D( void* );
+  // Description:
+  // Generate the faces of a tree, or a subtree, into buffer. Different
+  // trees can be processed at the same time by different threads.
+  void RecursiveProcessTree( void*, vtkHyperTreeGridCellBuffer* buffer );
+  void ProcessLeaf1D( void*, vtkHyperTreeGridCellBuffer* buffer );
+  void ProcessLeaf2D( void*, vtkHyperTreeGridCellBuffer* buffer );
+  void ProcessLeaf3D( void*, vtkHyperTreeGridCellBuffer* buffer );
   void AddFace( vtkIdType inId, double* origin, double* size,
-                int offset, int orientation );
+                int offset, int orientation,
+                vtkHyperTreeGridCellBuffer* buffer );
 
   vtkHyperTreeGrid* Input;
   vtkPolyData* Output;
@@ -19,6 +19,7 @@
 #include "vtkCellData.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkHyperTreeGrid.h"
+#include "vtkHyperTreeGridCellBuffer.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -190,21 +191,11 @@ void vtkHyperTreeGridToUnstructuredGrid::ProcessTrees()
   this->Points = vtkPoints::New();
   this->Cells = vtkCellArray::New();
 
-  // Iterate over all hyper trees
-  vtkIdType index;
-  vtkHyperTreeGrid::vtkHyperTreeIterator it;
-  it.Initialize( this->Input );
-  while ( it.GetNextTree( index ) )
-    {
-    // Storage for super cursors
-    vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor superCursor;
-
-    // Initialize center cursor
-    this->Input->InitializeSuperCursor( &superCursor, index );
-
-    // Traverse and populate dual recursively
-    this->RecursiveProcessTree( &superCursor );
-  }
+  // Traverse all hyper trees in parallel, one cell per unmasked leaf
+  vtkHyperTreeGridProcessTrees( this->Input, this,
+    &vtkHyperTreeGridToUnstructuredGrid::RecursiveProcessTree,
+    static_cast<int>( this->CellSize ), true,
+    this->Points, this->Cells, this->InData, this->OutData );
 
   // Set output geometry and topology
   this->Output->SetPoints( this->Points );
@@ -232,15 +223,13 @@ void vtkHyperTreeGridToUnstructuredGrid::ProcessTrees()
 //----------------------------------------------------------------------------
 void vtkHyperTreeGridToUnstructuredGrid::AddCell( vtkIdType inId,
                                                   double* origin,
-                                                  double* size )
+                                                  double* size,
+                                                  vtkHyperTreeGridCellBuffer* buffer )
 {
   // Generate 2^d points
   double pt[3];
   memcpy( pt, origin, 3 * sizeof(double) );
-
-  // Storage for cell IDs
-  vtkIdType ids[8];
-  ids[0] = this->Points->InsertNextPoint( pt );
+  buffer->InsertNextPoint( pt );
 
   for ( unsigned int i = 1; i < this->CellSize; ++ i )
     {
@@ -248,15 +237,15 @@ void vtkHyperTreeGridToUnstructuredGrid::AddCell( vtkIdType inId,
       {
       pt[j] = origin[j] + this->Coefficients[i * this->Dimension + j] * size[j];
       }
-    ids[i] = this->Points->InsertNextPoint( pt );
+    buffer->InsertNextPoint( pt );
     }
 
-  vtkIdType outId = this->Cells->InsertNextCell( this->CellSize, ids );
-  this->OutData->CopyData( this->InData, inId, outId );
+  buffer->InsertNextCell( inId );
 }
 
 //----------------------------------------------------------------------------
-void vtkHyperTreeGridToUnstructuredGrid::RecursiveProcessTree( void* sc )
+void vtkHyperTreeGridToUnstructuredGrid::RecursiveProcessTree( void* sc,
+                                                               vtkHyperTreeGridCellBuffer* buffer )
 {
   // Get cursor at super cursor center
   vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor* superCursor =
@@ -271,7 +260,7 @@ void vtkHyperTreeGridToUnstructuredGrid::RecursiveProcessTree( void* sc )
     if ( ! this->Input->GetMaterialMask()->GetValue( inId ) )
       {
       // Create cell
-      this->AddCell( inId, superCursor->Origin, superCursor->Size );
+      this->AddCell( inId, superCursor->Origin, superCursor->Size, buffer );
       }
     }
   else
@@ -282,7 +271,7 @@ void vtkHyperTreeGridToUnstructuredGrid::RecursiveProcessTree( void* sc )
       {
       vtkHyperTreeGrid::vtkHyperTreeGridSuperCursor newSuperCursor;
       this->Input->InitializeSuperCursorChild( superCursor,&newSuperCursor, child );
-      this->RecursiveProcessTree( &newSuperCursor );
+      this->RecursiveProcessTree( &newSuperCursor, buffer );
       }
     }
 }
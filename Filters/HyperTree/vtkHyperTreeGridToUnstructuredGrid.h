@@ -38,6 +38,7 @@
 class vtkCellArray;
 class vtkDataSetAttributes;
 class vtkHyperTreeGrid;
+class vtkHyperTreeGridCellBuffer;
 class vtkPoints;
 
 class VTKFILTERSHYPERTREE_EXPORT vtkHyperTreeGridToUnstructuredGrid : public vtkUnstructuredGridAlgorithm
@@ -59,8 +60,12 @@ protected:
   virtual int FillInputPortInformation( int, vtkInformation* );
 
   void ProcessTrees();
-  void RecursiveProcessTree( void* );
-  void AddCell( vtkIdType inId, double* origin, double* size );
+  // Description:
+  // Generate the cells of a tree, or a subtree, into buffer. Different
+  // trees can be processed at the same time by different threads.
+  void RecursiveProcessTree( void*, vtkHyperTreeGridCellBuffer* buffer );
+  void AddCell( vtkIdType inId, double* origin, double* size,
+                vtkHyperTreeGridCellBuffer* buffer );
 
   vtkHyperTreeGrid* Input;
   vtkUnstructuredGrid* Output;
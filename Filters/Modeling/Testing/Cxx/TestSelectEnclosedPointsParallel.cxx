@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSelectEnclosedPointsParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkSelectEnclosedPoints classifies the points of a grid around
+// a sphere correctly, serially and in parallel, with and without the voxel
+// cache, and that the parallel classification does not change from one
+// run to the next.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSelectEnclosedPoints.h"
+#include "vtkSphereSource.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+
+namespace
+{
+
+// Checks the marks of the points away from the surface of the unit sphere,
+// which are set inside it unless InsideOut is on, and returns a copy of all
+// of them.
+bool Check(vtkSelectEnclosedPoints *select, vtkUnsignedCharArray *marks,
+           const char *what)
+{
+  select->Update();
+  vtkDataSet *output = select->GetOutput();
+  vtkDataArray *selected =
+    output->GetPointData()->GetArray("SelectedPoints");
+  if (!selected ||
+      selected->GetNumberOfTuples() != output->GetNumberOfPoints())
+    {
+    cerr << what << ": missing marks" << endl;
+    return false;
+    }
+  marks->DeepCopy(selected);
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    output->GetPoint(i, x);
+    double r = sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+    if (std::abs(r - 1.0) > 0.05 &&
+        (marks->GetValue(i) != 0) !=
+        ((r < 1.0) != (select->GetInsideOut() != 0)))
+      {
+      cerr << what << ": wrong mark at point " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int TestSelectEnclosedPointsParallel(int, char *[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(1.0);
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+
+  vtkNew<vtkImageData> grid;
+  grid->SetExtent(0, 30, 0, 30, 0, 30);
+  grid->SetOrigin(-1.5, -1.5, -1.5);
+  grid->SetSpacing(0.1, 0.1, 0.1);
+
+  vtkNew<vtkSelectEnclosedPoints> select;
+  select->SetInputData(grid.GetPointer());
+  select->SetSurfaceConnection(sphere->GetOutputPort());
+
+  vtkNew<vtkUnsignedCharArray> serial, parallel, again, cached;
+  if (!Check(select.GetPointer(), serial.GetPointer(), "serial"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  select->SelectInParallelOn();
+  if (!Check(select.GetPointer(), parallel.GetPointer(), "parallel"))
+    {
+    return EXIT_FAILURE;
+    }
+  select->Modified();
+  if (!Check(select.GetPointer(), again.GetPointer(), "parallel again"))
+    {
+    return EXIT_FAILURE;
+    }
+  for (vtkIdType i = 0; i < parallel->GetNumberOfTuples(); ++i)
+    {
+    if (parallel->GetValue(i) != again->GetValue(i))
+      {
+      cerr << "The parallel marks differ between runs at point " << i
+           << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  select->SetVoxelCacheResolution(8);
+  if (!Check(select.GetPointer(), cached.GetPointer(), "parallel cache"))
+    {
+    return EXIT_FAILURE;
+    }
+  select->SelectInParallelOff();
+  select->InsideOutOn();
+  if (!Check(select.GetPointer(), cached.GetPointer(), "serial cache"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
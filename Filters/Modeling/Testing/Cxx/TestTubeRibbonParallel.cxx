@@ -0,0 +1,193 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTubeRibbonParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkTubeFilter and vtkRibbonFilter produce the same points,
+// strips and attributes with GenerateInParallel on as with it off, on
+// lines sharing points and with lines that are skipped.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRibbonFilter.h"
+#include "vtkTubeFilter.h"
+
+#include <cmath>
+
+namespace
+{
+
+bool SameArrays(vtkDataArray *expected, vtkDataArray *output,
+                const char *what)
+{
+  if (!expected && !output)
+    {
+    return true;
+    }
+  if (!expected || !output ||
+      expected->GetNumberOfTuples() != output->GetNumberOfTuples() ||
+      expected->GetNumberOfComponents() != output->GetNumberOfComponents())
+    {
+    cerr << what << ": different arrays" << endl;
+    return false;
+    }
+  int numComps = expected->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+    {
+    for (int j = 0; j < numComps; ++j)
+      {
+      if (expected->GetComponent(i, j) != output->GetComponent(i, j))
+        {
+        cerr << what << ": different value at tuple " << i << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool SameOutputs(vtkPolyData *expected, vtkPolyData *output,
+                 const char *what)
+{
+  if (expected->GetNumberOfStrips() == 0 ||
+      expected->GetNumberOfStrips() != output->GetNumberOfStrips())
+    {
+    cerr << what << ": different number of strips" << endl;
+    return false;
+    }
+  vtkPointData *pd = expected->GetPointData();
+  vtkPointData *outPD = output->GetPointData();
+  vtkCellData *cd = expected->GetCellData();
+  vtkCellData *outCD = output->GetCellData();
+  return SameArrays(expected->GetPoints()->GetData(),
+                    output->GetPoints()->GetData(), what) &&
+    SameArrays(expected->GetStrips()->GetData(),
+               output->GetStrips()->GetData(), what) &&
+    SameArrays(pd->GetNormals(), outPD->GetNormals(), what) &&
+    SameArrays(pd->GetTCoords(), outPD->GetTCoords(), what) &&
+    SameArrays(pd->GetScalars(), outPD->GetScalars(), what) &&
+    SameArrays(cd->GetScalars(), outCD->GetScalars(), what);
+}
+
+template <class T>
+bool Check(T *filter, const char *what)
+{
+  filter->GenerateInParallelOff();
+  filter->Update();
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(filter->GetOutput());
+
+  filter->GenerateInParallelOn();
+  filter->Update();
+  return SameOutputs(expected.GetPointer(), filter->GetOutput(), what);
+}
+
+// Helices around the z axis that all start at the same point, a line with
+// a single point and a line with coincident points, which are not tubed.
+void MakeLines(vtkPolyData *lines)
+{
+  const int numHelices = 200;
+  const int numSteps = 40;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> cells;
+  vtkIdType start = points->InsertNextPoint(0.0, 0.0, 0.0);
+  for (int h = 0; h < numHelices; ++h)
+    {
+    double radius = 1.0 + 0.01 * h;
+    double phase = 0.1 * h;
+    cells->InsertNextCell(numSteps + 1);
+    cells->InsertCellPoint(start);
+    for (int i = 1; i <= numSteps; ++i)
+      {
+      double angle = phase + 0.3 * i;
+      cells->InsertCellPoint(points->InsertNextPoint(
+        radius * cos(angle), radius * sin(angle), 0.1 * i));
+      }
+    if (h == numHelices / 3)
+      {
+      cells->InsertNextCell(1, &start);
+      }
+    if (h == numHelices / 2)
+      {
+      vtkIdType coincident[3] = { start, start + 1, start + 1 };
+      cells->InsertNextCell(3, coincident);
+      }
+    }
+  lines->SetPoints(points.GetPointer());
+  lines->SetLines(cells.GetPointer());
+
+  vtkNew<vtkDoubleArray> pointValues, cellValues;
+  pointValues->SetName("PointValues");
+  for (vtkIdType i = 0; i < lines->GetNumberOfPoints(); ++i)
+    {
+    double *x = lines->GetPoint(i);
+    pointValues->InsertNextValue(1.0 + x[2] + 0.1 * x[0]);
+    }
+  cellValues->SetName("CellValues");
+  for (vtkIdType i = 0; i < lines->GetNumberOfCells(); ++i)
+    {
+    cellValues->InsertNextValue(i);
+    }
+  lines->GetPointData()->SetScalars(pointValues.GetPointer());
+  lines->GetCellData()->SetScalars(cellValues.GetPointer());
+}
+
+}
+
+int TestTubeRibbonParallel(int, char *[])
+{
+  vtkNew<vtkPolyData> lines;
+  MakeLines(lines.GetPointer());
+
+  vtkNew<vtkTubeFilter> tubes;
+  tubes->SetInputData(lines.GetPointer());
+  tubes->SetRadius(0.05);
+  tubes->SetNumberOfSides(7);
+  if (!Check(tubes.GetPointer(), "vtkTubeFilter"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  tubes->SidesShareVerticesOff();
+  tubes->CappingOn();
+  tubes->SetOnRatio(2);
+  tubes->SetVaryRadiusToVaryRadiusByScalar();
+  tubes->SetGenerateTCoordsToNormalizedLength();
+  if (!Check(tubes.GetPointer(), "vtkTubeFilter with options"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkRibbonFilter> ribbons;
+  ribbons->SetInputData(lines.GetPointer());
+  ribbons->SetWidth(0.05);
+  ribbons->VaryWidthOn();
+  ribbons->SetGenerateTCoordsToUseLength();
+  if (!Check(ribbons.GetPointer(), "vtkRibbonFilter"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  ribbons->UseDefaultNormalOn();
+  if (!Check(ribbons.GetPointer(), "vtkRibbonFilter with default normal"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkMath.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -25,6 +26,15 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <vector>
 
 vtkStandardNewMacro(vtkRibbonFilter);
 
@@ -44,6 +54,7 @@ vtkRibbonFilter::vtkRibbonFilter()
 
   this->GenerateTCoords = 0;
   this->TextureLength = 1.0;
+  this->GenerateInParallel = 0;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
@@ -181,58 +192,69 @@ int vtkRibbonFilter::RequestData(
   //  triangle strips. Texture coordinates are optionally generated.
   //
   this->Theta = vtkMath::RadiansFromDegrees( this->Angle );
-  vtkPolyLine *lineNormalGenerator = vtkPolyLine::New();
-  for (inCellId=0, inLines->InitTraversal();
-       inLines->GetNextCell(npts,pts) && !abort; inCellId++)
+  if ( this->GenerateInParallel &&
+       vtkSMPTools::GetEstimatedNumberOfThreads() > 1 )
     {
-    this->UpdateProgress((double)inCellId/numLines);
-    abort = this->GetAbortExecute();
-
-    if (npts < 2)
+    this->GenerateRibbonsInParallel(input,inScalars,range,inNormals,
+                                    generateNormals,newPts,newNormals,
+                                    newTCoords,newStrips,outPD,outCD);
+    }
+  else
+    {
+    vtkPolyLine *lineNormalGenerator = vtkPolyLine::New();
+    for (inCellId=0, inLines->InitTraversal();
+         inLines->GetNextCell(npts,pts) && !abort; inCellId++)
       {
-      vtkWarningMacro(<< "Less than two points in line!");
-      continue; //skip tubing this polyline
-      }
+      this->UpdateProgress((double)inCellId/numLines);
+      abort = this->GetAbortExecute();
 
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
-      {
-      singlePolyline->Reset(); //avoid instantiation
-      singlePolyline->InsertNextCell(npts,pts);
-      if ( !lineNormalGenerator->GenerateSlidingNormals(inPts,singlePolyline,
-                                                        inNormals) )
+      if (npts < 2)
         {
-        vtkWarningMacro(<< "No normals for line!");
+        vtkWarningMacro(<< "Less than two points in line!");
         continue; //skip tubing this polyline
         }
-      }
 
-    // Generate the points around the polyline. The strip is not created
-    // if the polyline is bad.
-    //
-    if ( !this->GeneratePoints(offset,npts,pts,inPts,newPts,pd,outPD,
-                               newNormals,inScalars,range,inNormals) )
-      {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; //skip ribboning this polyline
-      }
+      // If necessary calculate normals, each polyline calculates its
+      // normals independently, avoiding conflicts at shared vertices.
+      if (generateNormals)
+        {
+        singlePolyline->Reset(); //avoid instantiation
+        singlePolyline->InsertNextCell(npts,pts);
+        if ( !lineNormalGenerator->GenerateSlidingNormals(inPts,singlePolyline,
+                                                          inNormals) )
+          {
+          vtkWarningMacro(<< "No normals for line!");
+          continue; //skip tubing this polyline
+          }
+        }
 
-    // Generate the strip for this polyline
-    //
-    this->GenerateStrip(offset,npts,pts,inCellId,cd,outCD,newStrips);
+      // Generate the points around the polyline. The strip is not created
+      // if the polyline is bad.
+      //
+      if ( !this->GeneratePoints(offset,npts,pts,inPts,newPts,pd,outPD,
+                                 newNormals,inScalars,range,inNormals) )
+        {
+        vtkWarningMacro(<< "Could not generate points!");
+        continue; //skip ribboning this polyline
+        }
 
-    // Generate the texture coordinates for this polyline
-    //
-    if ( newTCoords )
-      {
-      this->GenerateTextureCoords(offset,npts,pts,inPts,inScalars,newTCoords);
-      }
+      // Generate the strip for this polyline
+      //
+      this->GenerateStrip(offset,npts,pts,inCellId,cd,outCD,newStrips);
+
+      // Generate the texture coordinates for this polyline
+      //
+      if ( newTCoords )
+        {
+        this->GenerateTextureCoords(offset,npts,pts,inPts,inScalars,newTCoords);
+        }
 
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset,npts);
+      // Compute the new offset for the next polyline
+      offset = this->ComputeOffset(offset,npts);
 
-    }//for all polylines
+      }//for all polylines
+    lineNormalGenerator->Delete();
+    }
 
   singlePolyline->Delete();
 
@@ -257,7 +279,6 @@ int vtkRibbonFilter::RequestData(
 
   outPD->SetNormals(newNormals);
   newNormals->Delete();
-  lineNormalGenerator->Delete();
 
   output->Squeeze();
 
@@ -271,6 +292,21 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset,
                                   vtkFloatArray *newNormals,
                                   vtkDataArray *inScalars, double range[2],
                                   vtkDataArray *inNormals)
+{
+  return this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD,
+                              newNormals, inScalars, range, inNormals, pts);
+}
+
+// The normal of the j-th point of the line is the tuple normalIds[j] of
+// inNormals. The point data is not copied when outPD is NULL.
+int vtkRibbonFilter::GeneratePoints(vtkIdType offset,
+                                  vtkIdType npts, vtkIdType *pts,
+                                  vtkPoints *inPts, vtkPoints *newPts,
+                                  vtkPointData *pd, vtkPointData *outPD,
+                                  vtkFloatArray *newNormals,
+                                  vtkDataArray *inScalars, double range[2],
+                                  vtkDataArray *inNormals,
+                                  vtkIdType *normalIds)
 {
   vtkIdType j;
   int i;
@@ -323,7 +359,7 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset,
         }
       }
 
-    inNormals->GetTuple(pts[j], n);
+    inNormals->GetTuple(normalIds[j], n);
 
     if ( vtkMath::Normalize(sNext) == 0.0 )
       {
@@ -389,12 +425,14 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset,
       }
     newPts->InsertPoint(ptId,sm);
     newNormals->InsertTuple(ptId,nP);
-    outPD->CopyData(pd,pts[j],ptId);
-    ptId++;
-    newPts->InsertPoint(ptId,sp);
-    newNormals->InsertTuple(ptId,nP);
-    outPD->CopyData(pd,pts[j],ptId);
-    ptId++;
+    newPts->InsertPoint(ptId+1,sp);
+    newNormals->InsertTuple(ptId+1,nP);
+    if (outPD)
+      {
+      outPD->CopyData(pd,pts[j],ptId);
+      outPD->CopyData(pd,pts[j],ptId+1);
+      }
+    ptId += 2;
     }//for all points in polyline
 
   return 1;
@@ -409,7 +447,10 @@ void vtkRibbonFilter::GenerateStrip(vtkIdType offset, vtkIdType npts,
   vtkIdType i, idx, outCellId;
 
   outCellId = newStrips->InsertNextCell(npts*2);
-  outCD->CopyData(cd,inCellId,outCellId);
+  if (outCD)
+    {
+    outCD->CopyData(cd,inCellId,outCellId);
+    }
   for (i=0; i < npts; i++)
     {
     idx = 2*i;
@@ -436,10 +477,10 @@ void vtkRibbonFilter::GenerateTextureCoords(vtkIdType offset,
     }
   if ( this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars)
     {
-    s0 = inScalars->GetTuple1(pts[0]);
+    s0 = inScalars->GetComponent(pts[0],0);
     for (i=1; i < npts; i++)
       {
-      s = inScalars->GetTuple1(pts[i]);
+      s = inScalars->GetComponent(pts[i],0);
       tc = (s - s0) / this->TextureLength;
       for ( k=0; k < 2; k++)
         {
@@ -496,6 +537,354 @@ vtkIdType vtkRibbonFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
   return offset;
 }
 
+namespace
+{
+// The ribbons of a contiguous range of lines, in line order, generated into
+// arrays local to a thread. The points are numbered from the start of the
+// chunk. PointIds holds the input point of each tube point and CellIds the
+// input cell of each strip, to copy the attributes afterwards.
+struct vtkRibbonFilterChunk
+{
+  vtkIdType Begin;
+  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfSkippedLines;
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkFloatArray> Normals;
+  vtkSmartPointer<vtkFloatArray> TCoords;
+  vtkSmartPointer<vtkCellArray> Strips;
+  std::vector<vtkIdType> PointIds;
+  std::vector<vtkIdType> CellIds;
+};
+
+bool vtkRibbonFilterChunkLess(const vtkRibbonFilterChunk *a,
+                            const vtkRibbonFilterChunk *b)
+{
+  return a->Begin < b->Begin;
+}
+
+bool vtkRibbonFilterAreArraysThreadSafe(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(i));
+    if (!array || array->GetDataType() == VTK_BIT ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Copies the chunks into the output at their offsets, shifting the point
+// ids of the strips, and copies the attributes of the input.
+class vtkRibbonFilterCopy
+{
+public:
+  const std::vector<const vtkRibbonFilterChunk*> *Chunks;
+  const std::vector<vtkIdType> *PointOffsets;
+  const std::vector<vtkIdType> *CellOffsets;
+  const std::vector<vtkIdType> *ConnectivityOffsets;
+  char *Points;
+  int PointSize;
+  float *Normals;
+  float *TCoords;
+  vtkIdType *Connectivity;
+  vtkPointData *InPD;
+  vtkPointData *OutPD;
+  vtkCellData *InCD;
+  vtkCellData *OutCD;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType c = begin; c < end; ++c)
+      {
+      const vtkRibbonFilterChunk *chunk = (*this->Chunks)[c];
+      vtkIdType ptOffset = (*this->PointOffsets)[c];
+      vtkIdType numPts = chunk->NumberOfPoints;
+      if (numPts > 0)
+        {
+        memcpy(this->Points + 3 * ptOffset * this->PointSize,
+               chunk->Points->GetVoidPointer(0),
+               3 * numPts * this->PointSize);
+        memcpy(this->Normals + 3 * ptOffset,
+               chunk->Normals->GetPointer(0), 3 * numPts * sizeof(float));
+        if (this->TCoords)
+          {
+          memcpy(this->TCoords + 2 * ptOffset,
+                 chunk->TCoords->GetPointer(0), 2 * numPts * sizeof(float));
+          }
+        }
+      for (vtkIdType i = 0; i < numPts; ++i)
+        {
+        this->OutPD->CopyData(this->InPD, chunk->PointIds[i], ptOffset + i);
+        }
+
+      vtkIdType *conn =
+        this->Connectivity + (*this->ConnectivityOffsets)[c];
+      const vtkIdType *strips = chunk->Strips->GetPointer();
+      vtkIdType numCells = static_cast<vtkIdType>(chunk->CellIds.size());
+      vtkIdType cellOffset = (*this->CellOffsets)[c];
+      for (vtkIdType i = 0; i < numCells; ++i)
+        {
+        vtkIdType npts = *strips++;
+        *conn++ = npts;
+        for (vtkIdType j = 0; j < npts; ++j)
+          {
+          *conn++ = *strips++ + ptOffset;
+          }
+        this->OutCD->CopyData(this->InCD, chunk->CellIds[i], cellOffset + i);
+        }
+      }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+// Generates the ribbons of a range of lines into a new chunk of the calling
+// thread, with the helper methods of the filter, and skips the lines that
+// the serial path skips.
+class vtkRibbonFilterGenerate
+{
+public:
+  vtkRibbonFilter *Filter;
+  vtkPoints *InPts;
+  const vtkIdType *Lines;
+  const vtkIdType *Locations;
+  vtkPointData *InPD;
+  vtkCellData *InCD;
+  vtkDataArray *InScalars;
+  double *Range;
+  vtkDataArray *InNormals;
+  int GenerateNormals;
+  int PointsType;
+  bool GenerateTCoords;
+  vtkSMPThreadLocal<std::list<vtkRibbonFilterChunk> > Chunks;
+
+  // A copy of the current line with its own point ids, so that its normals
+  // are generated independently from the lines sharing its points.
+  vtkSMPThreadLocalObject<vtkPoints> LinePoints;
+  vtkSMPThreadLocalObject<vtkCellArray> Line;
+  vtkSMPThreadLocalObject<vtkFloatArray> LineNormals;
+  vtkSMPThreadLocal<std::vector<vtkIdType> > LineIds;
+
+  void Initialize()
+  {
+    this->LinePoints.Local()->SetDataType(VTK_DOUBLE);
+    this->LineNormals.Local()->SetNumberOfComponents(3);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkRibbonFilter *filter = this->Filter;
+    vtkPoints *linePoints = this->LinePoints.Local();
+    vtkCellArray *line = this->Line.Local();
+    vtkFloatArray *lineNormals = this->LineNormals.Local();
+    std::vector<vtkIdType> &lineIds = this->LineIds.Local();
+    std::list<vtkRibbonFilterChunk> &chunks = this->Chunks.Local();
+    chunks.push_back(vtkRibbonFilterChunk());
+    vtkRibbonFilterChunk &chunk = chunks.back();
+    chunk.Begin = begin;
+    chunk.NumberOfSkippedLines = 0;
+    chunk.Points = vtkSmartPointer<vtkPoints>::New();
+    chunk.Points->SetDataType(this->PointsType);
+    chunk.Normals = vtkSmartPointer<vtkFloatArray>::New();
+    chunk.Normals->SetNumberOfComponents(3);
+    if (this->GenerateTCoords)
+      {
+      chunk.TCoords = vtkSmartPointer<vtkFloatArray>::New();
+      chunk.TCoords->SetNumberOfComponents(2);
+      }
+    chunk.Strips = vtkSmartPointer<vtkCellArray>::New();
+
+    vtkIdType offset = 0;
+    double x[3];
+    for (vtkIdType lineId = begin; lineId < end; ++lineId)
+      {
+      vtkIdType npts = this->Lines[this->Locations[lineId]];
+      vtkIdType *pts =
+        const_cast<vtkIdType*>(this->Lines + this->Locations[lineId] + 1);
+      if (npts < 2)
+        {
+        ++chunk.NumberOfSkippedLines;
+        continue;
+        }
+
+      vtkDataArray *normals = this->InNormals;
+      vtkIdType *normalIds = pts;
+      if (this->GenerateNormals)
+        {
+        linePoints->SetNumberOfPoints(npts);
+        lineIds.resize(npts);
+        for (vtkIdType i = 0; i < npts; ++i)
+          {
+          this->InPts->GetPoint(pts[i], x);
+          linePoints->SetPoint(i, x);
+          lineIds[i] = i;
+          }
+        line->Reset();
+        line->InsertNextCell(npts, &lineIds[0]);
+        if (!vtkPolyLine::GenerateSlidingNormals(linePoints, line,
+                                                     lineNormals))
+          {
+          ++chunk.NumberOfSkippedLines;
+          continue;
+          }
+        normals = lineNormals;
+        normalIds = &lineIds[0];
+        }
+
+      if (!filter->GeneratePoints(offset, npts, pts, this->InPts,
+                                  chunk.Points, this->InPD, NULL,
+                                  chunk.Normals, this->InScalars,
+                                  this->Range, normals, normalIds))
+        {
+        continue;
+        }
+      filter->GenerateStrip(offset, npts, pts, lineId, this->InCD, NULL,
+                            chunk.Strips);
+      chunk.CellIds.resize(chunk.Strips->GetNumberOfCells(), lineId);
+      if (chunk.TCoords)
+        {
+        filter->GenerateTextureCoords(offset, npts, pts, this->InPts,
+                                      this->InScalars, chunk.TCoords);
+        }
+
+      chunk.PointIds.resize(offset);
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        chunk.PointIds.insert(chunk.PointIds.end(), 2, pts[i]);
+        }
+      offset = filter->ComputeOffset(offset, npts);
+      }
+    chunk.NumberOfPoints = offset;
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+//----------------------------------------------------------------------------
+// Generate the ribbons of ranges of lines in parallel, each into its own
+// chunk, then copy the chunks into the output in line order. The output
+// is the same as the serial one.
+void vtkRibbonFilter::GenerateRibbonsInParallel(vtkPolyData *input,
+                                                vtkDataArray *inScalars,
+                                                double range[2],
+                                                vtkDataArray *inNormals,
+                                                int generateNormals,
+                                                vtkPoints *newPts,
+                                                vtkFloatArray *newNormals,
+                                                vtkFloatArray *newTCoords,
+                                                vtkCellArray *newStrips,
+                                                vtkPointData *outPD,
+                                                vtkCellData *outCD)
+{
+  vtkPointData *pd = input->GetPointData();
+  vtkCellData *cd = input->GetCellData();
+  vtkCellArray *inLines = input->GetLines();
+  vtkIdType numLines = inLines->GetNumberOfCells();
+
+  // The location of each line in the connectivity.
+  std::vector<vtkIdType> locations(numLines);
+  const vtkIdType *lines = inLines->GetPointer();
+  vtkIdType loc = 0;
+  for (vtkIdType i = 0; i < numLines; ++i)
+    {
+    locations[i] = loc;
+    loc += lines[loc] + 1;
+    }
+
+  vtkRibbonFilterGenerate generate;
+  generate.Filter = this;
+  generate.InPts = input->GetPoints();
+  generate.Lines = lines;
+  generate.Locations = &locations[0];
+  generate.InPD = pd;
+  generate.InCD = cd;
+  generate.InScalars = inScalars;
+  generate.Range = range;
+  generate.InNormals = inNormals;
+  generate.GenerateNormals = generateNormals;
+  generate.PointsType = newPts->GetDataType();
+  generate.GenerateTCoords = (newTCoords != NULL);
+  vtkSMPTools::For(0, numLines, generate);
+
+  std::vector<const vtkRibbonFilterChunk*> chunks;
+  for (vtkSMPThreadLocal<std::list<vtkRibbonFilterChunk> >::iterator
+         iter = generate.Chunks.begin(); iter != generate.Chunks.end(); ++iter)
+    {
+    for (std::list<vtkRibbonFilterChunk>::const_iterator chunk = iter->begin();
+         chunk != iter->end(); ++chunk)
+      {
+      chunks.push_back(&(*chunk));
+      }
+    }
+  std::sort(chunks.begin(), chunks.end(), vtkRibbonFilterChunkLess);
+
+  vtkIdType numChunks = static_cast<vtkIdType>(chunks.size());
+  std::vector<vtkIdType> pointOffsets(numChunks + 1, 0);
+  std::vector<vtkIdType> cellOffsets(numChunks + 1, 0);
+  std::vector<vtkIdType> connOffsets(numChunks + 1, 0);
+  vtkIdType numSkipped = 0;
+  for (vtkIdType c = 0; c < numChunks; ++c)
+    {
+    const vtkRibbonFilterChunk *chunk = chunks[c];
+    pointOffsets[c+1] = pointOffsets[c] + chunk->NumberOfPoints;
+    cellOffsets[c+1] = cellOffsets[c] +
+      static_cast<vtkIdType>(chunk->CellIds.size());
+    connOffsets[c+1] = connOffsets[c] +
+      chunk->Strips->GetNumberOfConnectivityEntries();
+    numSkipped += chunk->NumberOfSkippedLines;
+    }
+  if (numSkipped > 0)
+    {
+    vtkWarningMacro(<< "Skipped " << numSkipped << " lines with less than "
+                    "two points or without normals");
+    }
+
+  vtkIdType numNewPts = pointOffsets[numChunks];
+  vtkIdType numNewCells = cellOffsets[numChunks];
+  newPts->SetNumberOfPoints(numNewPts);
+  newNormals->SetNumberOfTuples(numNewPts);
+  if (newTCoords)
+    {
+    newTCoords->SetNumberOfTuples(numNewPts);
+    }
+  outPD->SetNumberOfTuples(numNewPts);
+  outCD->SetNumberOfTuples(numNewCells);
+  vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+  connectivity->SetNumberOfValues(connOffsets[numChunks]);
+
+  vtkRibbonFilterCopy copy;
+  copy.Chunks = &chunks;
+  copy.PointOffsets = &pointOffsets;
+  copy.CellOffsets = &cellOffsets;
+  copy.ConnectivityOffsets = &connOffsets;
+  copy.Points = static_cast<char*>(newPts->GetVoidPointer(0));
+  copy.PointSize = newPts->GetData()->GetDataTypeSize();
+  copy.Normals = newNormals->GetPointer(0);
+  copy.TCoords = newTCoords ? newTCoords->GetPointer(0) : NULL;
+  copy.Connectivity = connectivity->GetPointer(0);
+  copy.InPD = pd;
+  copy.OutPD = outPD;
+  copy.InCD = cd;
+  copy.OutCD = outCD;
+  if (vtkRibbonFilterAreArraysThreadSafe(outPD) &&
+      vtkRibbonFilterAreArraysThreadSafe(outCD))
+    {
+    vtkSMPTools::For(0, numChunks, 1, copy);
+    }
+  else
+    {
+    copy(0, numChunks);
+    }
+
+  newStrips->SetCells(numNewCells, connectivity);
+  connectivity->Delete();
+}
+
 // Description:
 // Return the method of generating the texture coordinates.
 const char *vtkRibbonFilter::GetGenerateTCoordsAsString(void)
@@ -535,5 +924,7 @@ void vtkRibbonFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Generate TCoords: "
      << this->GetGenerateTCoordsAsString() << endl;
   os << indent << "Texture Length: " << this->TextureLength << endl;
+  os << indent << "Generate In Parallel: "
+     << (this->GenerateInParallel ? "On\n" : "Off\n");
 }
 
@@ -21,6 +21,10 @@
 // the local line segment. An offset angle can be specified to rotate the
 // ribbon with respect to the normal.
 //
+// When GenerateInParallel is on, the ribbons of the lines are generated in
+// parallel with vtkSMPTools and copied into the output in line order, so
+// the output is the same as with it off.
+//
 // .SECTION Caveats
 // The input line must not have duplicate points, or normals at points that
 // are parallel to the incoming/outgoing line segments. (Duplicate points
@@ -121,6 +125,14 @@ public:
   vtkSetClampMacro(TextureLength,double,0.000001,VTK_INT_MAX);
   vtkGetMacro(TextureLength,double);
 
+  // Description:
+  // Turn on/off generating the ribbons in parallel. Each thread generates
+  // the ribbons of a range of lines, which are then copied into the output
+  // at their offsets. The default is Off.
+  vtkSetMacro(GenerateInParallel,int);
+  vtkGetMacro(GenerateInParallel,int);
+  vtkBooleanMacro(GenerateInParallel,int);
+
 protected:
   vtkRibbonFilter();
   ~vtkRibbonFilter();
@@ -134,6 +146,7 @@ protected:
   int UseDefaultNormal;
   int GenerateTCoords; //control texture coordinate generation
   double TextureLength; //this length is mapped to [0,1) texture space
+  int GenerateInParallel;
 
   // Helper methods
   int GeneratePoints(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
@@ -141,6 +154,12 @@ protected:
                      vtkPointData *pd, vtkPointData *outPD,
                      vtkFloatArray *newNormals, vtkDataArray *inScalars,
                      double range[2], vtkDataArray *inNormals);
+  int GeneratePoints(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
+                     vtkPoints *inPts, vtkPoints *newPts,
+                     vtkPointData *pd, vtkPointData *outPD,
+                     vtkFloatArray *newNormals, vtkDataArray *inScalars,
+                     double range[2], vtkDataArray *inNormals,
+                     vtkIdType *normalIds);
   void GenerateStrip(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
                      vtkIdType inCellId, vtkCellData *cd, vtkCellData *outCD,
                      vtkCellArray *newStrips);
@@ -149,9 +168,24 @@ protected:
                              vtkFloatArray *newTCoords);
   vtkIdType ComputeOffset(vtkIdType offset,vtkIdType npts);
 
+  // Description:
+  // Generate the ribbons of all the lines in parallel into the output
+  // arrays, which are allocated but empty.
+  void GenerateRibbonsInParallel(vtkPolyData *input, vtkDataArray *inScalars,
+                                 double range[2], vtkDataArray *inNormals,
+                                 int generateNormals, vtkPoints *newPts,
+                                 vtkFloatArray *newNormals,
+                                 vtkFloatArray *newTCoords,
+                                 vtkCellArray *newStrips,
+                                 vtkPointData *outPD, vtkCellData *outCD);
+
   // Helper data members
   double Theta;
 
+//BTX
+  friend class vtkRibbonFilterGenerate;
+//ETX
+
 private:
   vtkRibbonFilter(const vtkRibbonFilter&);  // Not implemented.
   void operator=(const vtkRibbonFilter&);  // Not implemented.
@@ -25,13 +25,261 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkExecutive.h"
 #include "vtkFeatureEdges.h"
-#include "vtkCellLocator.h"
+#include "vtkStaticCellLocator.h"
 #include "vtkGenericCell.h"
 #include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
 #include "vtkGarbageCollector.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
 
 vtkStandardNewMacro(vtkSelectEnclosedPoints);
 
+#define VTK_MAX_ITER 10    //Maximum iterations for ray-firing
+#define VTK_VOTE_THRESHOLD 3
+
+namespace
+{
+
+// The search structures of the enclosing surface.
+struct EnclosingSurface
+{
+  vtkPolyData *Surface;
+  vtkStaticCellLocator *Locator;
+  double Bounds[6];
+  double Length;
+  double Tolerance; // absolute
+
+  void Set(vtkPolyData *surface, vtkStaticCellLocator *locator,
+           const double bounds[6], double length, double tolerance)
+  {
+    this->Surface = surface;
+    this->Locator = locator;
+    std::copy(bounds, bounds + 6, this->Bounds);
+    this->Length = length;
+    this->Tolerance = tolerance*length;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Classify x by casting random rays, see vtkSelectEnclosedPoints::
+// IsInsideSurface(). The rays are drawn from sequence, or from vtkMath when
+// it is NULL. Thread safe with a sequence, a cell and an id list per thread.
+int CastRays(const EnclosingSurface &s, const double x[3], vtkIdList *cellIds,
+             vtkGenericCell *cell, vtkMinimalStandardRandomSequence *sequence)
+{
+  // do a quick bounds check
+  if ( x[0] < s.Bounds[0] || x[0] > s.Bounds[1] ||
+       x[1] < s.Bounds[2] || x[1] > s.Bounds[3] ||
+       x[2] < s.Bounds[4] || x[2] > s.Bounds[5])
+    {
+    return 0;
+    }
+
+  double rayMag, ray[3], xray[3], t, pcoords[3], xint[3];
+  double p[3] = { x[0], x[1], x[2] };
+  int i, numInts, iterNumber, deltaVotes, subId;
+  vtkIdType idx, numCells;
+
+  for (deltaVotes = 0, iterNumber = 1;
+       (iterNumber < VTK_MAX_ITER) && (abs(deltaVotes) < VTK_VOTE_THRESHOLD);
+       iterNumber++)
+    {
+    //  Define a random ray to fire.
+    rayMag = 0.0;
+    while (rayMag == 0.0 )
+      {
+      for (i=0; i<3; i++)
+        {
+        if ( sequence )
+          {
+          ray[i] = sequence->GetRangeValue(-1.0,1.0);
+          sequence->Next();
+          }
+        else
+          {
+          ray[i] = vtkMath::Random(-1.0,1.0);
+          }
+        }
+      rayMag = vtkMath::Norm(ray);
+      }
+
+    // The ray must be appropriately sized wrt the bounding box. (It has to go
+    // all the way through the bounding box.)
+    for (i=0; i<3; i++)
+      {
+      xray[i] = x[i] + (s.Length/rayMag)*ray[i];
+      }
+
+    // Retrieve the candidate cells from the locator
+    s.Locator->FindCellsAlongLine(p,xray,s.Tolerance,cellIds);
+
+    // Intersect the line with each of the candidate cells
+    numInts = 0;
+    numCells = cellIds->GetNumberOfIds();
+    for ( idx=0; idx < numCells; idx++ )
+      {
+      s.Surface->GetCell(cellIds->GetId(idx), cell);
+      if ( cell->IntersectWithLine(p, xray, s.Tolerance, t, xint, pcoords,
+                                   subId) )
+        {
+        numInts++;
+        }
+      } //for all candidate cells
+
+    // Count the result
+    if ( (numInts % 2) == 0)
+      {
+      --deltaVotes;
+      }
+    else
+      {
+      ++deltaVotes;
+      }
+    } //try another ray
+
+  //   If the number of votes is positive, the point is inside
+  //
+  return ( deltaVotes < 0 ? 0 : 1 );
+}
+
+//----------------------------------------------------------------------------
+// Seed the random sequence of a point or a voxel from its id.
+inline void SeedSequence(vtkMinimalStandardRandomSequence *sequence,
+                         vtkIdType id)
+{
+  sequence->SetSeed(static_cast<int>(id % 2147483646) + 1);
+}
+
+// The voxels of the cache, over the bounds of the surface.
+struct VoxelCache
+{
+  int Resolution;
+  double Origin[3];
+  double Spacing[3];
+  const unsigned char *States;
+
+  void Setup(const double bounds[6], int resolution)
+  {
+    this->Resolution = resolution;
+    for (int i = 0; i < 3; ++i)
+      {
+      this->Origin[i] = bounds[2*i];
+      this->Spacing[i] = (bounds[2*i+1] - bounds[2*i]) / resolution;
+      }
+    this->States = NULL;
+  }
+
+  int GetIndex(const double x[3]) const
+  {
+    int ijk[3];
+    for (int i = 0; i < 3; ++i)
+      {
+      ijk[i] = (this->Spacing[i] > 0.0 ?
+                static_cast<int>((x[i] - this->Origin[i]) / this->Spacing[i]) :
+                0);
+      ijk[i] = std::min(std::max(ijk[i], 0), this->Resolution - 1);
+      }
+    return ijk[0] + this->Resolution * (ijk[1] + this->Resolution * ijk[2]);
+  }
+
+  void GetBounds(int index, double bounds[6]) const
+  {
+    int ijk[3] = { index % this->Resolution,
+                   (index / this->Resolution) % this->Resolution,
+                   index / (this->Resolution * this->Resolution) };
+    for (int i = 0; i < 3; ++i)
+      {
+      bounds[2*i] = this->Origin[i] + ijk[i] * this->Spacing[i];
+      bounds[2*i+1] = bounds[2*i] + this->Spacing[i];
+      }
+  }
+};
+
+// Classifies the voxels of the cache.
+class ClassifyVoxels
+{
+public:
+  const EnclosingSurface *Surface;
+  const VoxelCache *Cache;
+  unsigned char *States;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkMinimalStandardRandomSequence> Sequence;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellIds = this->CellIds.Local();
+    vtkGenericCell *cell = this->Cell.Local();
+    vtkMinimalStandardRandomSequence *sequence = this->Sequence.Local();
+    double tol = this->Surface->Tolerance;
+    for (vtkIdType v = begin; v < end; ++v)
+      {
+      double bounds[6], center[3];
+      this->Cache->GetBounds(static_cast<int>(v), bounds);
+      for (int i = 0; i < 3; ++i)
+        {
+        center[i] = 0.5 * (bounds[2*i] + bounds[2*i+1]);
+        bounds[2*i] -= tol;
+        bounds[2*i+1] += tol;
+        }
+      this->Surface->Locator->FindCellsWithinBounds(bounds, cellIds);
+      if ( cellIds->GetNumberOfIds() > 0 )
+        {
+        this->States[v] = 2;
+        }
+      else
+        {
+        SeedSequence(sequence, v);
+        this->States[v] = static_cast<unsigned char>(
+          CastRays(*this->Surface, center, cellIds, cell, sequence));
+        }
+      }
+  }
+};
+
+// Marks the input points, each with its own random sequence.
+class SelectPoints
+{
+public:
+  vtkDataSet *Input;
+  const EnclosingSurface *Surface;
+  const VoxelCache *Cache;
+  unsigned char Inside;
+  unsigned char Outside;
+  unsigned char *Marks;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkMinimalStandardRandomSequence> Sequence;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *cellIds = this->CellIds.Local();
+    vtkGenericCell *cell = this->Cell.Local();
+    vtkMinimalStandardRandomSequence *sequence = this->Sequence.Local();
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      this->Input->GetPoint(ptId, x);
+      int state = 2;
+      if ( this->Cache )
+        {
+        state = this->Cache->States[this->Cache->GetIndex(x)];
+        }
+      if ( state == 2 )
+        {
+        SeedSequence(sequence, ptId);
+        state = CastRays(*this->Surface, x, cellIds, cell, sequence);
+        }
+      this->Marks[ptId] = (state ? this->Inside : this->Outside);
+      }
+  }
+};
+
+}
+
 //----------------------------------------------------------------------------
 // Construct object.
 vtkSelectEnclosedPoints::vtkSelectEnclosedPoints()
@@ -41,10 +289,12 @@ vtkSelectEnclosedPoints::vtkSelectEnclosedPoints()
   this->CheckSurface = 0;
   this->InsideOut = 0;
   this->Tolerance = 0.001;
+  this->SelectInParallel = 0;
+  this->VoxelCacheResolution = 0;
 
   this->InsideOutsideArray = NULL;
 
-  this->CellLocator = vtkCellLocator::New();
+  this->CellLocator = vtkStaticCellLocator::New();
   this->CellIds = vtkIdList::New();
   this->Cell = vtkGenericCell::New();
 }
@@ -59,7 +309,7 @@ vtkSelectEnclosedPoints::~vtkSelectEnclosedPoints()
 
   if ( this->CellLocator )
     {
-    vtkCellLocator *loc = this->CellLocator;
+    vtkStaticCellLocator *loc = this->CellLocator;
     this->CellLocator = NULL;
     loc->Delete();
     }
@@ -113,27 +363,54 @@ int vtkSelectEnclosedPoints::RequestData(
   vtkIdType ptId;
   double x[3];
 
-  int abort=0;
-  vtkIdType progressInterval=numPts/20+1;
-  for ( ptId=0; ptId < numPts && !abort; ptId++ )
+  // Classify the voxels of the cache, if requested
+  vtkUnsignedCharArray *voxels = NULL;
+  VoxelCache cache;
+  if ( this->VoxelCacheResolution > 0 )
     {
-    if ( ! (ptId % progressInterval) ) //manage progress / early abort
+    voxels = vtkUnsignedCharArray::New();
+    this->BuildVoxelCache(voxels);
+    cache.Setup(this->Bounds, this->VoxelCacheResolution);
+    cache.States = voxels->GetPointer(0);
+    }
+
+  if ( this->SelectInParallel && numPts > 0 )
+    {
+    this->SelectPointsInParallel(input, voxels, marks);
+    }
+  else
+    {
+    int abort=0;
+    vtkIdType progressInterval=numPts/20+1;
+    for ( ptId=0; ptId < numPts && !abort; ptId++ )
       {
-      this->UpdateProgress ((double)ptId / numPts);
-      abort = this->GetAbortExecute();
-      }
+      if ( ! (ptId % progressInterval) ) //manage progress / early abort
+        {
+        this->UpdateProgress ((double)ptId / numPts);
+        abort = this->GetAbortExecute();
+        }
 
-    input->GetPoint(ptId,x);
+      input->GetPoint(ptId,x);
 
-    if ( this->IsInsideSurface(x) )
-      {
-      marks->SetValue(ptId,(this->InsideOut?0:1));
-      }
-    else
-      {
-      marks->SetValue(ptId,(this->InsideOut?1:0));
+      int state = (voxels ? cache.States[cache.GetIndex(x)] : 2);
+      if ( state == 2 )
+        {
+        state = this->IsInsideSurface(x);
+        }
+      if ( state )
+        {
+        marks->SetValue(ptId,(this->InsideOut?0:1));
+        }
+      else
+        {
+        marks->SetValue(ptId,(this->InsideOut?1:0));
+        }
       }
     }
+  if ( voxels )
+    {
+    voxels->Delete();
+    }
 
   // Copy all the input geometry and data to the output.
   output->CopyStructure(input);
@@ -183,18 +460,77 @@ void vtkSelectEnclosedPoints::Initialize(vtkPolyData *surface)
 {
   if ( ! this->CellLocator )
     {
-    this->CellLocator = vtkCellLocator::New();
+    this->CellLocator = vtkStaticCellLocator::New();
     }
 
   this->Surface = surface;
   surface->GetBounds(this->Bounds);
   this->Length = surface->GetLength();
 
-  // Set up structures for acceleration ray casting
+  // Set up structures for acceleration ray casting. The cells are built
+  // now so that they may be read from several threads.
+  if ( surface->NeedToBuildCells() )
+    {
+    surface->BuildCells();
+    }
   this->CellLocator->SetDataSet(surface);
   this->CellLocator->BuildLocator();
 }
 
+//----------------------------------------------------------------------------
+void vtkSelectEnclosedPoints::BuildVoxelCache(vtkUnsignedCharArray *voxels)
+{
+  int res = this->VoxelCacheResolution;
+  vtkIdType numVoxels = static_cast<vtkIdType>(res) * res * res;
+  voxels->SetNumberOfValues(numVoxels);
+
+  EnclosingSurface surface;
+  surface.Set(this->Surface, this->CellLocator, this->Bounds, this->Length,
+              this->Tolerance);
+
+  VoxelCache cache;
+  cache.Setup(this->Bounds, res);
+
+  ClassifyVoxels classify;
+  classify.Surface = &surface;
+  classify.Cache = &cache;
+  classify.States = voxels->GetPointer(0);
+  if ( this->SelectInParallel )
+    {
+    vtkSMPTools::For(0, numVoxels, classify);
+    }
+  else
+    {
+    classify(0, numVoxels);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkSelectEnclosedPoints::SelectPointsInParallel(
+  vtkDataSet *input, vtkUnsignedCharArray *voxels, vtkUnsignedCharArray *marks)
+{
+  EnclosingSurface surface;
+  surface.Set(this->Surface, this->CellLocator, this->Bounds, this->Length,
+              this->Tolerance);
+
+  VoxelCache cache;
+  if ( voxels )
+    {
+    cache.Setup(this->Bounds, this->VoxelCacheResolution);
+    cache.States = voxels->GetPointer(0);
+    }
+
+  SelectPoints select;
+  select.Input = input;
+  select.Surface = &surface;
+  select.Cache = (voxels ? &cache : NULL);
+  select.Inside = (this->InsideOut ? 0 : 1);
+  select.Outside = (this->InsideOut ? 1 : 0);
+  select.Marks = marks->GetPointer(0);
+  vtkSMPTools::For(0, input->GetNumberOfPoints(), select);
+  this->UpdateProgress(1.0);
+}
+
 //----------------------------------------------------------------------------
 int vtkSelectEnclosedPoints::IsInside(vtkIdType inputPtId)
 {
@@ -219,20 +555,9 @@ int vtkSelectEnclosedPoints::IsInsideSurface(double x, double y, double z)
   return this->IsInsideSurface(xyz);
 }
 
-
-#define VTK_MAX_ITER 10    //Maximum iterations for ray-firing
-#define VTK_VOTE_THRESHOLD 3
 //----------------------------------------------------------------------------
 int vtkSelectEnclosedPoints::IsInsideSurface(double x[3])
 {
-  // do a quick bounds check
-  if ( x[0] < this->Bounds[0] || x[0] > this->Bounds[1] ||
-       x[1] < this->Bounds[2] || x[1] > this->Bounds[3] ||
-       x[2] < this->Bounds[4] || x[2] > this->Bounds[5])
-    {
-    return 0;
-    }
-
   //  Perform in/out by shooting random rays. Multiple rays are fired
   //  to improve accuracy of the result.
   //
@@ -246,62 +571,10 @@ int vtkSelectEnclosedPoints::IsInsideSurface(double x[3])
   //  equals the defined variable VTK_VOTE_THRESHOLD, then the
   //  appropriate "in" or "out" status is returned.
   //
-  double rayMag, ray[3], xray[3], t, pcoords[3], xint[3];
-  int i, numInts, iterNumber, deltaVotes, subId;
-  vtkIdType idx, numCells;
-  double tol = this->Tolerance*this->Length;
-
-  for (deltaVotes = 0, iterNumber = 1;
-       (iterNumber < VTK_MAX_ITER) && (abs(deltaVotes) < VTK_VOTE_THRESHOLD);
-       iterNumber++)
-    {
-    //  Define a random ray to fire.
-    rayMag = 0.0;
-    while (rayMag == 0.0 )
-      {
-      for (i=0; i<3; i++)
-        {
-        ray[i] = vtkMath::Random(-1.0,1.0);
-        }
-      rayMag = vtkMath::Norm(ray);
-      }
-
-    // The ray must be appropriately sized wrt the bounding box. (It has to go
-    // all the way through the bounding box.)
-    for (i=0; i<3; i++)
-      {
-      xray[i] = x[i] + (this->Length/rayMag)*ray[i];
-      }
-
-    // Retrieve the candidate cells from the locator
-    this->CellLocator->FindCellsAlongLine(x,xray,tol,this->CellIds);
-
-    // Intersect the line with each of the candidate cells
-    numInts = 0;
-    numCells = this->CellIds->GetNumberOfIds();
-    for ( idx=0; idx < numCells; idx++ )
-      {
-      this->Surface->GetCell(this->CellIds->GetId(idx), this->Cell);
-      if ( this->Cell->IntersectWithLine(x, xray, tol, t, xint, pcoords, subId) )
-        {
-        numInts++;
-        }
-      } //for all candidate cells
-
-    // Count the result
-    if ( (numInts % 2) == 0)
-      {
-      --deltaVotes;
-      }
-    else
-      {
-      ++deltaVotes;
-      }
-    } //try another ray
-
-  //   If the number of votes is positive, the point is inside
-  //
-  return ( deltaVotes < 0 ? 0 : 1 );
+  EnclosingSurface surface;
+  surface.Set(this->Surface, this->CellLocator, this->Bounds, this->Length,
+              this->Tolerance);
+  return CastRays(surface, x, this->CellIds, this->Cell, NULL);
 }
 
 #undef VTK_MAX_ITER
@@ -385,5 +658,11 @@ void vtkSelectEnclosedPoints::PrintSelf(ostream& os, vtkIndent indent)
      << (this->InsideOut ? "On\n" : "Off\n");
 
   os << indent << "Tolerance: " << this->Tolerance << "\n";
+
+  os << indent << "Select In Parallel: "
+     << (this->SelectInParallel ? "On\n" : "Off\n");
+
+  os << indent << "Voxel Cache Resolution: "
+     << this->VoxelCacheResolution << "\n";
 }
 
@@ -22,6 +22,14 @@
 //
 // After running the filter, it is possible to query it as to whether a point
 // is inside/outside by invoking the IsInside(ptId) method.
+//
+// The points may be classified in parallel (SelectInParallel). Each point
+// then casts its rays from its own random sequence, seeded with its id, so
+// that the result does not depend on the scheduling of the threads. A
+// coarse grid of voxels covering the surface may also be classified first
+// (VoxelCacheResolution): the points in the voxels that the surface does
+// not cross take the classification of their voxel, and only the points
+// near the surface cast rays.
 
 // .SECTION Caveats
 // The filter assumes that the surface is closed and manifold. A boolean flag
@@ -43,7 +51,7 @@
 #include "vtkDataSetAlgorithm.h"
 
 class vtkUnsignedCharArray;
-class vtkCellLocator;
+class vtkStaticCellLocator;
 class vtkIdList;
 class vtkGenericCell;
 
@@ -98,6 +106,22 @@ public:
   vtkSetClampMacro(Tolerance,double,0.0,VTK_FLOAT_MAX);
   vtkGetMacro(Tolerance,double);
 
+  // Description:
+  // Classify the input points in parallel with vtkSMPTools. Off by
+  // default.
+  vtkSetMacro(SelectInParallel,int);
+  vtkGetMacro(SelectInParallel,int);
+  vtkBooleanMacro(SelectInParallel,int);
+
+  // Description:
+  // Specify the number of voxels along each axis of the bounds of the
+  // surface used to cache the inside/outside classification. The voxels
+  // that no cell of the surface overlaps are classified once from their
+  // center, and the points they contain are not tested individually. The
+  // default, 0, disables the cache.
+  vtkSetClampMacro(VoxelCacheResolution,int,0,1024);
+  vtkGetMacro(VoxelCacheResolution,int);
+
   // Description:
   // This is a backdoor that can be used to test many points for containment.
   // First initialize the instance, then repeated calls to IsInsideSurface()
@@ -115,18 +139,30 @@ protected:
   int    CheckSurface;
   int    InsideOut;
   double Tolerance;
+  int    SelectInParallel;
+  int    VoxelCacheResolution;
 
   int IsSurfaceClosed(vtkPolyData *surface);
   vtkUnsignedCharArray *InsideOutsideArray;
 
   // Internal structures for accelerating the intersection test
-  vtkCellLocator *CellLocator;
+  vtkStaticCellLocator *CellLocator;
   vtkIdList      *CellIds;
   vtkGenericCell *Cell;
   vtkPolyData    *Surface;
   double          Bounds[6];
   double          Length;
 
+  // Classify the voxels of the cache (see VoxelCacheResolution) once the
+  // search structures are initialized: 0 outside, 1 inside, and 2 when the
+  // surface may cross the voxel.
+  void BuildVoxelCache(vtkUnsignedCharArray *voxels);
+
+  // Mark the points of the input in parallel, with the voxel cache if not
+  // NULL.
+  void SelectPointsInParallel(vtkDataSet *input, vtkUnsignedCharArray *voxels,
+                              vtkUnsignedCharArray *marks);
+
   virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
   virtual int FillInputPortInformation(int, vtkInformation *);
 
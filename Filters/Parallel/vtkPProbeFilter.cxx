@@ -23,12 +23,57 @@
 #include "vtkPointData.h"
 #include "vtkCellData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkPProbeFilter);
 
 vtkCxxSetObjectMacro(vtkPProbeFilter, Controller, vtkMultiProcessController);
 
+namespace
+{
+// Copies the tuples of the points probed by a remote process into the
+// local output. Each point is written once, so the points can be split
+// among threads when the arrays allow concurrent tuple writes.
+class vtkPProbeFilterMergeRemote
+{
+public:
+  const char *Mask;
+  std::vector<vtkDataArray*> OutArrays;
+  std::vector<vtkDataArray*> RemoteArrays;
+
+  void operator()(vtkIdType pointId, vtkIdType end)
+  {
+    for ( ; pointId < end; ++pointId)
+      {
+      if (this->Mask[pointId] == 1)
+        {
+        for (size_t k = 0; k < this->OutArrays.size(); ++k)
+          {
+          this->OutArrays[k]->SetTuple(pointId, pointId,
+                                       this->RemoteArrays[k]);
+          }
+        }
+      }
+  }
+
+  bool IsThreadSafe() const
+  {
+    for (size_t k = 0; k < this->OutArrays.size(); ++k)
+      {
+      if (this->OutArrays[k]->GetDataType() == VTK_BIT ||
+          !this->OutArrays[k]->HasStandardMemoryLayout())
+        {
+        return false;
+        }
+      }
+    return true;
+  }
+};
+}
+
 //----------------------------------------------------------------------------
 vtkPProbeFilter::vtkPProbeFilter()
 {
@@ -83,7 +128,6 @@ int vtkPProbeFilter::RequestData(vtkInformation *request,
     vtkPointData *pointData = output->GetPointData();
     vtkIdType i;
     vtkIdType k;
-    vtkIdType pointId;
     for (i = 1; i < numProcs; i++)
       {
       this->Controller->Receive(&numRemoteValidPoints, 1, i, PROBE_COMMUNICATION_TAG);
@@ -110,21 +154,28 @@ int vtkPProbeFilter::RequestData(vtkInformation *request,
           }
         else if (maskArray)
           {
-          for (pointId=0; pointId < numRemotePoints; ++pointId)
+          // Match the arrays by name once, rather than for every point.
+          vtkPProbeFilterMergeRemote merge;
+          merge.Mask = maskArray->GetPointer(0);
+          for (k = 0; k < pointData->GetNumberOfArrays(); ++k)
             {
-            if (maskArray->GetValue(pointId) == 1)
+            vtkDataArray *oaa = pointData->GetArray(k);
+            vtkDataArray *raa = oaa ?
+              remotePointData->GetArray(oaa->GetName()) : NULL;
+            if (raa != NULL)
               {
-              for (k = 0; k < pointData->GetNumberOfArrays(); ++k)
-                {
-                vtkAbstractArray *oaa = pointData->GetArray(k);
-                vtkAbstractArray *raa = remotePointData->GetArray(oaa->GetName());
-                if (raa != NULL)
-                  {
-                  oaa->SetTuple(pointId, pointId, raa);
-                  }
-                }
+              merge.OutArrays.push_back(oaa);
+              merge.RemoteArrays.push_back(raa);
               }
             }
+          if (merge.IsThreadSafe())
+            {
+            vtkSMPTools::For(0, numRemotePoints, merge);
+            }
+          else
+            {
+            merge(0, numRemotePoints);
+            }
           }
         }
       }
@@ -79,8 +79,13 @@ double* vtkPResampleFilter::CalculateBounds(vtkDataSet* input)
       localBoundsMin[i] = localBounds[2*i];
       localBoundsMax[i] = localBounds[2*i+1];
       }
-    this->Controller->AllReduce(localBoundsMin, globalBoundsMin, 3, vtkCommunicator::MIN_OP);
-    this->Controller->AllReduce(localBoundsMax, globalBoundsMax, 3, vtkCommunicator::MAX_OP);
+    // Both reductions are in flight at once.
+    vtkCommunicator::CollectiveRequest requests[2];
+    this->Controller->IAllReduce(localBoundsMin, globalBoundsMin, 3,
+                                 vtkCommunicator::MIN_OP, requests[0]);
+    this->Controller->IAllReduce(localBoundsMax, globalBoundsMax, 3,
+                                 vtkCommunicator::MAX_OP, requests[1]);
+    vtkCommunicator::WaitAll(2, requests);
     for (int i=0; i<3; i++)
       {
       if (globalBoundsMin[i] <= globalBoundsMax[i])
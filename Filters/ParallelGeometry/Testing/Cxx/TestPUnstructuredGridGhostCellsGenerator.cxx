@@ -220,6 +220,29 @@ int TestPUnstructuredGridGhostCellsGenerator(int argc, char* argv[])
       }
     }
 
+  // Check that a second ghost level adds cells, with and without global ids
+  vtkIdType oneLevelNbCells = outGrids[0]->GetNumberOfCells();
+  for (int step = 0; step < 2; ++step)
+    {
+    ghostGenerator->SetUseGlobalPointIds(step == 0 ? 1 : 0);
+    ghostGenerator->UpdatePiece(rankId, nbRanks, 2);
+    vtkUnstructuredGrid* outGrid = ghostGenerator->GetOutput();
+    if (outGrid->GetNumberOfCells() <= oneLevelNbCells)
+      {
+      vtkMPIUtilities::Printf(controller.Get(),
+        "Two ghost levels do not add cells to one ghost level at step %d!\n",
+        step);
+      ret = EXIT_FAILURE;
+      }
+    if (outGrid->GetInformation()->Get(
+          vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS()) != 2)
+      {
+      vtkMPIUtilities::Printf(controller.Get(),
+        "Wrong number of ghost levels at step %d!\n", step);
+      ret = EXIT_FAILURE;
+      }
+    }
+
   outGrids[0]->Delete();
   outGrids[1]->Delete();
 
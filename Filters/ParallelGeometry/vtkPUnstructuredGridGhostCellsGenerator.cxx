@@ -34,47 +34,12 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <vtksys/hash_map.hxx>
+
+#include <algorithm>
 #include <map>
-#include <set>
 #include <vector>
 
-//----------------------------------------------------------------------------
-// Helpers
-namespace
-{
-template<class T>
-bool AllGatherV(vtkMultiProcessController* controller,
-                const T* localV,
-                vtkIdType localSize,
-                std::vector<T>& globalV,
-                std::vector<vtkIdType>& sizes,
-                std::vector<vtkIdType>& offsets)
-{
-  int nbOfRanks = controller->GetNumberOfProcesses();
-  sizes.resize(nbOfRanks);
-  int ret = controller->AllGather(&localSize, &sizes[0], 1);
-  if (ret == 0)
-    {
-    vtkErrorWithObjectMacro(controller, << "Communication error!");
-    return false;
-    }
-  vtkIdType count = 0;
-  offsets.resize(nbOfRanks);
-  for (int i = 0; i < nbOfRanks; i++)
-    {
-    offsets[i] = count;
-    count += sizes[i];
-    }
-  globalV.resize(count);
-  if (count > 0)
-    {
-    controller->AllGatherV(localSize > 0 ? localV : 0,
-      &globalV[0], localSize, &sizes[0], &offsets[0]);
-    }
-  return true;
-}
-}
-
 //----------------------------------------------------------------------------
 // Internal data structures
 
@@ -110,21 +75,44 @@ public:
   int CommStep;
 };
 
+// Surface points exchanged with one neighbor rank: global ids, or
+// coordinates when global ids are not used.
+struct vtkUGGCGSurfacePointsInfo
+{
+  int Rank;
+  std::vector<vtkIdType> SendIds;
+  std::vector<double> SendPoints;
+  std::vector<vtkIdType> RecvIds;
+  std::vector<double> RecvPoints;
+  vtkIdType SendLen;
+  vtkIdType RecvLen;
+};
+
+struct vtkUGGCGIdHash
+{
+  size_t operator()(vtkIdType id) const
+    {
+    return static_cast<size_t>(id);
+    }
+};
+
 // Communication arrays
 struct vtkPUnstructuredGridGhostCellsGenerator::vtkInternals
 {
   // For global ids
-  std::map<vtkIdType, vtkIdType> GlobalToLocalPointIdMap;
-  std::vector<vtkIdType> AllGlobalIdsOfSurfacePoints;
+  vtksys::hash_map<vtkIdType, vtkIdType, vtkUGGCGIdHash> GlobalToLocalPointIdMap;
+  std::vector<vtkIdType> GlobalIdsOfSurfacePoints;
 
   // For point coordinates
   vtkNew<vtkMergePoints> LocalPoints;
   std::vector<vtkIdType> LocalPointsMap;
-  std::vector<double> AllPointsOfSurfacePoints;
+  vtkNew<vtkPoints> SurfacePoints;
 
-  std::vector<vtkIdType> AllSizes;
-  std::vector<vtkIdType> AllOffsets;
-  std::map<int, std::set<vtkIdType> > NeighborRanksCells;
+  // Bounds of the surface points of every rank
+  std::vector<double> AllBounds;
+  std::vector<vtkUGGCGSurfacePointsInfo> Neighbors;
+
+  std::map<int, std::vector<vtkIdType> > NeighborRanksCells;
   std::map<int, CommDataInfo> CommData;
   vtkUnstructuredGridBase* Input;
 
@@ -134,8 +122,22 @@ struct vtkPUnstructuredGridGhostCellsGenerator::vtkInternals
 
 static const int UGGCG_SIZE_EXCHANGE_TAG = 9000;
 static const int UGGCG_DATA_EXCHANGE_TAG = 9001;
+static const int UGGCG_POINTS_SIZE_EXCHANGE_TAG = 9002;
+static const int UGGCG_POINTS_DATA_EXCHANGE_TAG = 9003;
 static const char* UGGCG_GLOBAL_POINT_IDS = "GlobalNodeIds";
 
+//----------------------------------------------------------------------------
+// Helpers
+namespace
+{
+inline bool PointInBounds(const double p[3], const double bounds[6])
+{
+  return p[0] >= bounds[0] && p[0] <= bounds[1] &&
+         p[1] >= bounds[2] && p[1] <= bounds[3] &&
+         p[2] >= bounds[4] && p[2] <= bounds[5];
+}
+}
+
 //----------------------------------------------------------------------------
 
 vtkStandardNewMacro(vtkPUnstructuredGridGhostCellsGenerator)
@@ -252,10 +254,14 @@ int vtkPUnstructuredGridGhostCellsGenerator::RequestData(
     {
     this->Internals->InputGlobalPointIds = NULL;
     }
-  this->ExtractAndReduceSurfacePoints();
-  this->UpdateProgress(0.3);
+  this->ExtractSurfacePoints();
+  this->UpdateProgress(0.2);
+
+  this->FindNeighborRanks();
+  this->ExchangeSurfacePoints();
+  this->UpdateProgress(0.4);
 
-  this->ComputeSharedPoints();
+  this->ComputeSharedPoints(ghostLevels);
   this->UpdateProgress(0.6);
 
   this->ExtractAndSendGhostCells();
@@ -264,7 +270,8 @@ int vtkPUnstructuredGridGhostCellsGenerator::RequestData(
   this->ReceiveAndMergeGhostCells(output);
   this->UpdateProgress(1.0);
 
-  output->GetInformation()->Set(vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS(), 1);
+  output->GetInformation()->Set(
+    vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS(), ghostLevels);
 
   this->Controller->Barrier();
 
@@ -279,8 +286,9 @@ int vtkPUnstructuredGridGhostCellsGenerator::RequestData(
 }
 
 //-----------------------------------------------------------------------------
-// Step 1: Extract surface geometry and all reduce global ids of surface points
-void vtkPUnstructuredGridGhostCellsGenerator::ExtractAndReduceSurfacePoints()
+// Step 1: Extract surface geometry and save the global ids or coordinates of
+// the surface points
+void vtkPUnstructuredGridGhostCellsGenerator::ExtractSurfacePoints()
 {
   // Extract boundary cells and points with the surface filter
   vtkNew<vtkDataSetSurfaceFilter> surfaceFilter;
@@ -297,12 +305,31 @@ void vtkPUnstructuredGridGhostCellsGenerator::ExtractAndReduceSurfacePoints()
   vtkIdTypeArray* surfaceOriginalPointIds = vtkIdTypeArray::SafeDownCast(
     surface->GetPointData()->GetArray(surfaceFilter->GetOriginalPointIdsName()));
 
+  // The bounds of the surface points tell the other ranks whether they may
+  // share points with this one; an empty surface gets empty bounds.
+  double bounds[6] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX,
+                       -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+  if (nbSurfacePoints > 0)
+    {
+    surface->GetPoints()->GetBounds(bounds);
+    }
+  this->Internals->AllBounds.resize(6 * this->NumRanks);
+  if (!this->Controller->AllGather(bounds, &this->Internals->AllBounds[0], 6))
+    {
+    vtkErrorMacro(<< "Communication error!");
+    }
+
+  vtkPoints* inputPoints = this->Internals->Input->GetPoints();
+  vtkPoints* surfacePoints = this->Internals->SurfacePoints.Get();
+  surfacePoints->SetDataTypeToDouble();
+  surfacePoints->Allocate(nbSurfacePoints);
+
   if (this->Internals->InputGlobalPointIds)
     {
-    std::vector<vtkIdType> globalIdsOfSurfacePoints;
-    globalIdsOfSurfacePoints.reserve(nbSurfacePoints);
+    this->Internals->GlobalIdsOfSurfacePoints.reserve(nbSurfacePoints);
 
-    // Browse surface cells and save global and local ids of cell points
+    // Browse surface cells and save global and local ids of cell points.
+    // The coordinates are kept to select the points sent to each neighbor.
     while (surfaceCells->GetNextCell(npts, pts))
       {
       for (vtkIdType i = 0; i < npts; i++)
@@ -311,35 +338,25 @@ void vtkPUnstructuredGridGhostCellsGenerator::ExtractAndReduceSurfacePoints()
         vtkIdType globalPtId = static_cast<vtkIdType>(
           this->Internals->InputGlobalPointIds->GetTuple1(origPtId));
 
-        if (this->Internals->GlobalToLocalPointIdMap.find(globalPtId) ==
-          this->Internals->GlobalToLocalPointIdMap.end())
+        if (this->Internals->GlobalToLocalPointIdMap.insert(
+              std::make_pair(globalPtId, origPtId)).second)
           {
-          this->Internals->GlobalToLocalPointIdMap[globalPtId] = origPtId;
-          globalIdsOfSurfacePoints.push_back(globalPtId);
+          this->Internals->GlobalIdsOfSurfacePoints.push_back(globalPtId);
+          surfacePoints->InsertNextPoint(inputPoints->GetPoint(origPtId));
           }
         }
       }
-
-    // Now reduce surface point global ids on ALL ranks
-    ::AllGatherV(this->Controller, &globalIdsOfSurfacePoints[0],
-      globalIdsOfSurfacePoints.size(),
-      this->Internals->AllGlobalIdsOfSurfacePoints,
-      this->Internals->AllSizes, this->Internals->AllOffsets);
     }
   else
     {
     // We can't use global ids, so we will process point coordinates instead
-    vtkPoints* inputPoints = this->Internals->Input->GetPoints();
-    vtkNew<vtkPoints> surfacePoints;
-    surfacePoints->SetDataTypeToDouble();
-    surfacePoints->Allocate(nbSurfacePoints);
-    double bounds[6] = { 0., 1., 0., 1., 0., 1. };
-    if (surface->GetPoints())
+    double locatorBounds[6] = { 0., 1., 0., 1., 0., 1. };
+    if (nbSurfacePoints > 0)
       {
-      surface->GetPoints()->GetBounds(bounds);
+      std::copy(bounds, bounds + 6, locatorBounds);
       }
     this->Internals->LocalPoints->InitPointInsertion(
-      surfacePoints.Get(), bounds);
+      surfacePoints, locatorBounds);
     this->Internals->LocalPointsMap.reserve(nbSurfacePoints);
 
     // Browse surface cells and push point coordinates to the locator
@@ -363,41 +380,163 @@ void vtkPUnstructuredGridGhostCellsGenerator::ExtractAndReduceSurfacePoints()
           }
         }
       }
-
-    // Now reduce surface point coordinates on ALL ranks
-    ::AllGatherV(this->Controller,
-      (double*)surfacePoints->GetVoidPointer(0),
-      surfacePoints->GetNumberOfPoints() * 3,
-      this->Internals->AllPointsOfSurfacePoints,
-      this->Internals->AllSizes, this->Internals->AllOffsets);
     }
 }
 
-//---------------------------------------------------------------------------
-// Step 2: browse global ids/point coordinates of other ranks and check if some
-// are duplicated locally.
-// For each neighbor rank, save the ids of the cells adjacent to the surface
-// points shared, those cells are the ghost cells we will send them.
-void vtkPUnstructuredGridGhostCellsGenerator::ComputeSharedPoints()
+//-----------------------------------------------------------------------------
+// Step 2: the ranks whose surface bounds overlap ours are the only ones which
+// may share points with us. As a shared point lies in the bounds of both
+// ranks, the relation is symmetric.
+void vtkPUnstructuredGridGhostCellsGenerator::FindNeighborRanks()
 {
-  vtkNew<vtkIdList> cellIdsList;
+  const double* bounds = &this->Internals->AllBounds[6 * this->RankId];
   for (int i = 0; i < this->NumRanks; i++)
     {
-    if (i == this->RankId)
+    const double* other = &this->Internals->AllBounds[6 * i];
+    if (i == this->RankId ||
+        bounds[0] > other[1] || other[0] > bounds[1] ||
+        bounds[2] > other[3] || other[2] > bounds[3] ||
+        bounds[4] > other[5] || other[4] > bounds[5])
+      {
+      continue;
+      }
+    vtkUGGCGSurfacePointsInfo info;
+    info.Rank = i;
+    info.SendLen = 0;
+    info.RecvLen = 0;
+    this->Internals->Neighbors.push_back(info);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Step 3: send to each neighbor rank the surface points that lie in its
+// bounds, and receive its own.
+void vtkPUnstructuredGridGhostCellsGenerator::ExchangeSurfacePoints()
+{
+  vtkMPICommunicator* com =
+    vtkMPICommunicator::SafeDownCast(this->Controller->GetCommunicator());
+  std::vector<vtkUGGCGSurfacePointsInfo>& neighbors = this->Internals->Neighbors;
+  int nbNeighbors = static_cast<int>(neighbors.size());
+  if (nbNeighbors == 0)
+    {
+    return;
+    }
+  bool useIds = this->Internals->InputGlobalPointIds != 0;
+  vtkPoints* surfacePoints = this->Internals->SurfacePoints.Get();
+  vtkIdType nbSurfacePoints = surfacePoints->GetNumberOfPoints();
+
+  std::vector<vtkMPICommunicator::Request> sendReqs(2 * nbNeighbors);
+  std::vector<vtkMPICommunicator::Request> recvReqs(nbNeighbors);
+  int nbSendReqs = 0;
+  for (int n = 0; n < nbNeighbors; n++)
+    {
+    vtkUGGCGSurfacePointsInfo& info = neighbors[n];
+    const double* bounds = &this->Internals->AllBounds[6 * info.Rank];
+    for (vtkIdType i = 0; i < nbSurfacePoints; i++)
+      {
+      double p[3];
+      surfacePoints->GetPoint(i, p);
+      if (!::PointInBounds(p, bounds))
+        {
+        continue;
+        }
+      if (useIds)
+        {
+        info.SendIds.push_back(this->Internals->GlobalIdsOfSurfacePoints[i]);
+        }
+      else
+        {
+        info.SendPoints.insert(info.SendPoints.end(), p, p + 3);
+        }
+      }
+    info.SendLen = useIds ? static_cast<vtkIdType>(info.SendIds.size()) :
+      static_cast<vtkIdType>(info.SendPoints.size());
+
+    com->NoBlockReceive(&info.RecvLen, 1, info.Rank,
+      UGGCG_POINTS_SIZE_EXCHANGE_TAG, recvReqs[n]);
+    com->NoBlockSend(&info.SendLen, 1, info.Rank,
+      UGGCG_POINTS_SIZE_EXCHANGE_TAG, sendReqs[nbSendReqs++]);
+    if (info.SendLen == 0)
+      {
+      continue;
+      }
+    if (useIds)
+      {
+      com->NoBlockSend(&info.SendIds[0], info.SendLen, info.Rank,
+        UGGCG_POINTS_DATA_EXCHANGE_TAG, sendReqs[nbSendReqs++]);
+      }
+    else
+      {
+      com->NoBlockSend(&info.SendPoints[0], info.SendLen, info.Rank,
+        UGGCG_POINTS_DATA_EXCHANGE_TAG, sendReqs[nbSendReqs++]);
+      }
+    }
+  com->WaitAll(nbNeighbors, &recvReqs[0]);
+
+  int nbRecvReqs = 0;
+  for (int n = 0; n < nbNeighbors; n++)
+    {
+    vtkUGGCGSurfacePointsInfo& info = neighbors[n];
+    if (info.RecvLen == 0)
       {
       continue;
       }
-    for (vtkIdType j = 0, idx = this->Internals->AllOffsets[i];
-         j < this->Internals->AllSizes[i]; j++, idx++)
+    if (useIds)
+      {
+      info.RecvIds.resize(info.RecvLen);
+      com->NoBlockReceive(&info.RecvIds[0], info.RecvLen, info.Rank,
+        UGGCG_POINTS_DATA_EXCHANGE_TAG, recvReqs[nbRecvReqs++]);
+      }
+    else
+      {
+      info.RecvPoints.resize(info.RecvLen);
+      com->NoBlockReceive(&info.RecvPoints[0], info.RecvLen, info.Rank,
+        UGGCG_POINTS_DATA_EXCHANGE_TAG, recvReqs[nbRecvReqs++]);
+      }
+    }
+  if (nbRecvReqs > 0)
+    {
+    com->WaitAll(nbRecvReqs, &recvReqs[0]);
+    }
+  com->WaitAll(nbSendReqs, &sendReqs[0]);
+}
+
+//---------------------------------------------------------------------------
+// Step 4: browse global ids/point coordinates received from the neighbor
+// ranks and check if some are duplicated locally.
+// For each neighbor rank, save the ids of the cells within ghostLevels of the
+// surface points shared, those cells are the ghost cells we will send them.
+// All the levels are gathered here so that they are sent in a single round.
+void vtkPUnstructuredGridGhostCellsGenerator::ComputeSharedPoints(
+  int ghostLevels)
+{
+  vtkUnstructuredGridBase* input = this->Internals->Input;
+  std::vector<vtkUGGCGSurfacePointsInfo>& neighbors = this->Internals->Neighbors;
+  int nbNeighbors = static_cast<int>(neighbors.size());
+
+  // Points and cells are marked with the index of the last neighbor which
+  // visited them, so the marks need not be cleared between neighbors.
+  std::vector<int> pointMarks(input->GetNumberOfPoints(), -1);
+  std::vector<int> cellMarks(input->GetNumberOfCells(), -1);
+  std::vector<vtkIdType> frontPoints;
+  std::vector<vtkIdType> frontCells;
+  vtkNew<vtkIdList> idList;
+
+  for (int n = 0; n < nbNeighbors; n++)
+    {
+    vtkUGGCGSurfacePointsInfo& info = neighbors[n];
+    frontPoints.clear();
+    vtkIdType nbRecvPoints = this->Internals->InputGlobalPointIds ?
+      info.RecvLen : info.RecvLen / 3;
+    for (vtkIdType j = 0; j < nbRecvPoints; j++)
       {
       vtkIdType localPointId = -1;
       if (this->Internals->InputGlobalPointIds)
         {
         // Check if this point exists locally from its global ids, if so
         // get its local id.
-        vtkIdType gid = this->Internals->AllGlobalIdsOfSurfacePoints[idx];
-        std::map<vtkIdType, vtkIdType>::iterator iter =
-          this->Internals->GlobalToLocalPointIdMap.find(gid);
+        vtksys::hash_map<vtkIdType, vtkIdType, vtkUGGCGIdHash>::iterator iter =
+          this->Internals->GlobalToLocalPointIdMap.find(info.RecvIds[j]);
         if (iter != this->Internals->GlobalToLocalPointIdMap.end())
           {
           localPointId = iter->second;
@@ -407,50 +546,84 @@ void vtkPUnstructuredGridGhostCellsGenerator::ComputeSharedPoints()
         {
         // Check if this point exists locally from its coordinates, if so
         // get its local id.
-        double *p = &this->Internals->AllPointsOfSurfacePoints[idx];
-        localPointId = this->Internals->LocalPoints->IsInsertedPoint(p);
-
+        localPointId =
+          this->Internals->LocalPoints->IsInsertedPoint(&info.RecvPoints[3 * j]);
         if (localPointId != -1)
           {
           localPointId = this->Internals->LocalPointsMap[localPointId];
           }
-        idx += 2; // jump to next coordinates
-        j += 2;
         }
 
-      if (localPointId != -1)
+      if (localPointId != -1 && pointMarks[localPointId] != n)
+        {
+        // Current rank also has a copy of this point
+        pointMarks[localPointId] = n;
+        frontPoints.push_back(localPointId);
+        }
+      }
+
+    // Walk the cells level by level from the shared points
+    std::vector<vtkIdType> cellsToShare;
+    for (int level = 0; level < ghostLevels && !frontPoints.empty(); level++)
+      {
+      frontCells.clear();
+      for (std::size_t i = 0; i < frontPoints.size(); i++)
+        {
+        input->GetPointCells(frontPoints[i], idList.Get());
+        for (vtkIdType k = 0; k < idList->GetNumberOfIds(); k++)
+          {
+          vtkIdType cellId = idList->GetId(k);
+          if (cellMarks[cellId] != n)
+            {
+            cellMarks[cellId] = n;
+            frontCells.push_back(cellId);
+            }
+          }
+        }
+      cellsToShare.insert(cellsToShare.end(), frontCells.begin(), frontCells.end());
+
+      frontPoints.clear();
+      if (level + 1 == ghostLevels)
         {
-        // Current rank also has a copy of this global point
-        cellIdsList->Reset();
-        // Get the cells connected to this point
-        this->Internals->Input->GetPointCells(localPointId, cellIdsList.Get());
-        vtkIdType nbIds = cellIdsList->GetNumberOfIds();
-        // Add those cells to the list of cells to send to this rank
-        for (vtkIdType k = 0; k < nbIds; k++)
+        break;
+        }
+      for (std::size_t i = 0; i < frontCells.size(); i++)
+        {
+        input->GetCellPoints(frontCells[i], idList.Get());
+        for (vtkIdType k = 0; k < idList->GetNumberOfIds(); k++)
           {
-          this->Internals->NeighborRanksCells[i].insert(cellIdsList->GetId(k));
+          vtkIdType ptId = idList->GetId(k);
+          if (pointMarks[ptId] != n)
+            {
+            pointMarks[ptId] = n;
+            frontPoints.push_back(ptId);
+            }
           }
         }
       }
+
+    if (!cellsToShare.empty())
+      {
+      std::sort(cellsToShare.begin(), cellsToShare.end());
+      this->Internals->NeighborRanksCells[info.Rank].swap(cellsToShare);
+      }
     }
 
-  // Release memory of all reduced arrays
-  this->Internals->AllGlobalIdsOfSurfacePoints.resize(0);
-  this->Internals->AllPointsOfSurfacePoints.resize(0);
-  this->Internals->AllSizes.resize(0);
-  this->Internals->AllOffsets.resize(0);
+  // Release memory of the exchanged points
+  this->Internals->Neighbors.clear();
+  this->Internals->AllBounds.clear();
   // Now we know our neighbors and which points we have in common and the
   // ghost cells to share.
 }
 
 //-----------------------------------------------------------------------------
-// Step 3: extract and send the ghost cells to the neighbor ranks
+// Step 5: extract and send the ghost cells to the neighbor ranks
 void vtkPUnstructuredGridGhostCellsGenerator::ExtractAndSendGhostCells()
 {
   vtkNew<vtkIdList> cellIdsList;
   vtkNew<vtkExtractCells> extractCells;
   extractCells->SetInputData(this->Internals->Input);
-  std::map<int, std::set<vtkIdType> >::iterator iter =
+  std::map<int, std::vector<vtkIdType> >::iterator iter =
     this->Internals->NeighborRanksCells.begin();
 
   vtkMPICommunicator* com =
@@ -460,12 +633,11 @@ void vtkPUnstructuredGridGhostCellsGenerator::ExtractAndSendGhostCells()
   for (; iter != this->Internals->NeighborRanksCells.end(); ++iter)
     {
     int toRank = iter->first;
-    std::set<vtkIdType>& cellsToShare = iter->second;
-    cellIdsList->SetNumberOfIds(cellsToShare.size());
-    std::set<vtkIdType>::iterator sIter = cellsToShare.begin();
-    for (vtkIdType i = 0; sIter != cellsToShare.end(); ++sIter, i++)
+    std::vector<vtkIdType>& cellsToShare = iter->second;
+    cellIdsList->SetNumberOfIds(static_cast<vtkIdType>(cellsToShare.size()));
+    for (std::size_t i = 0; i < cellsToShare.size(); i++)
       {
-      cellIdsList->SetId(i, *sIter);
+      cellIdsList->SetId(static_cast<vtkIdType>(i), cellsToShare[i]);
       }
     extractCells->SetCellList(cellIdsList.Get());
     extractCells->Update();
@@ -486,7 +658,7 @@ void vtkPUnstructuredGridGhostCellsGenerator::ExtractAndSendGhostCells()
 }
 
 //-----------------------------------------------------------------------------
-// Step 4: receive the ghost cells from the neighbor ranks and merge them
+// Step 6: receive the ghost cells from the neighbor ranks and merge them
 // to the local grid.
 void vtkPUnstructuredGridGhostCellsGenerator::ReceiveAndMergeGhostCells(
   vtkUnstructuredGrid *output)
@@ -505,7 +677,7 @@ void vtkPUnstructuredGridGhostCellsGenerator::ReceiveAndMergeGhostCells(
   neighborGrids.reserve(nbNeighbors);
 
   // First create requests to receive the size of the mesh to receive
-  std::map<int, std::set<vtkIdType> >::iterator iter;
+  std::map<int, std::vector<vtkIdType> >::iterator iter;
   for (iter = this->Internals->NeighborRanksCells.begin();
     iter != this->Internals->NeighborRanksCells.end(); ++iter)
     {
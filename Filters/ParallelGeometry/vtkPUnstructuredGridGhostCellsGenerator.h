@@ -20,11 +20,16 @@
 // This filter generate ghost cells for distributed a unstructured grid in
 // parallel - using MPI asynchronous communications.
 // The filter can take benefit of the input grid point global ids to perform.
+// All the requested ghost levels are extracted locally and sent to each
+// neighbor processor in a single message.
 //
 // .SECTION Caveats
 //  <ul>
-//    <li> A step of 'all reduce' (each processor send/receive data to/from
-//         all other processors.
+//    <li> Only the bounds of the surface points are gathered on all
+//         processors; the surface points themselves are exchanged between
+//         processors whose bounds overlap. </li>
+//    <li> With several ghost levels, the ghost cells only come from the
+//         processors sharing points with the local grid. </li>
 //    <li> The code currently assumes one grid per rank. </li>
 //    <li> PointData and CellData must match across partitions/processes. </li>
 //  </ul>
@@ -88,9 +93,13 @@ protected:
   virtual int RequestData(vtkInformation *, vtkInformationVector **,
     vtkInformationVector *);
 
-  void ExtractAndReduceSurfacePoints();
+  void ExtractSurfacePoints();
 
-  void ComputeSharedPoints();
+  void FindNeighborRanks();
+
+  void ExchangeSurfacePoints();
+
+  void ComputeSharedPoints(int ghostLevels);
 
   void ExtractAndSendGhostCells();
 
@@ -16,7 +16,9 @@
 // .SECTION Description
 // To satisfy a request, this filter calls update on its input
 // many times with smaller update extents.  All processing up stream
-// streams smaller pieces.
+// streams smaller pieces. The number of pieces is chosen so that the
+// size estimated by vtkPipelineSize for the whole upstream pipeline fits
+// in the memory limit (50 mebibytes by default).
 
 #ifndef vtkMemoryLimitImageDataStreamer_h
 #define vtkMemoryLimitImageDataStreamer_h
@@ -32,21 +34,15 @@ public:
   vtkTypeMacro(vtkMemoryLimitImageDataStreamer,vtkImageDataStreamer);
   void PrintSelf(ostream& os, vtkIndent indent);
 
-  // Description:
-  // Set / Get the memory limit in kibibytes (1024 bytes).
-  vtkSetMacro(MemoryLimit, unsigned long);
-  vtkGetMacro(MemoryLimit, unsigned long);
-
-  // See the vtkAlgorithm for a desciption of what these do
-  int ProcessRequest(vtkInformation*,
-                     vtkInformationVector**,
-                     vtkInformationVector*);
-
 protected:
   vtkMemoryLimitImageDataStreamer();
   ~vtkMemoryLimitImageDataStreamer() {}
 
-  unsigned long  MemoryLimit;
+  // Description:
+  // Double the number of divisions until the pipeline size fits.
+  virtual int ComputeNumberOfStreamDivisions(vtkInformation *inInfo,
+                                             int outExt[6]);
+
 private:
   vtkMemoryLimitImageDataStreamer(const vtkMemoryLimitImageDataStreamer&);  // Not implemented.
   void operator=(const vtkMemoryLimitImageDataStreamer&);  // Not implemented.
@@ -0,0 +1,157 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDistributedDataAllToAll.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME TestDistributedDataAllToAll.cxx -- Tests the all-to-all
+// redistribution of vtkDistributedDataFilter.
+//
+// .SECTION Description
+//  Every process has a slab of an image. The slabs are redistributed with
+//  and without UseAllToAllRedistribution, and the grids must have the same
+//  numbers of points and cells, with point and cell arrays that still match
+//  their coordinates.
+
+#include "vtkCellData.h"
+#include "vtkDistributedDataFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+double PointValue(const double x[3])
+{
+  return x[0] + 100.0 * x[1] + 10000.0 * x[2];
+}
+
+//------------------------------------------------------------------------------
+bool CheckGrid(vtkUnstructuredGrid *grid)
+{
+  vtkDataArray *pointValues = grid->GetPointData()->GetArray("PointValue");
+  vtkDataArray *cellValues = grid->GetCellData()->GetArray("CellValue");
+  if (!pointValues || !cellValues)
+    {
+    cerr << "The arrays were not redistributed" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    grid->GetPoint(i, x);
+    if (pointValues->GetTuple1(i) != PointValue(x))
+      {
+      cerr << "Wrong value at point " << i << endl;
+      return false;
+      }
+    }
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+    {
+    double bounds[6];
+    grid->GetCellBounds(i, bounds);
+    double x[3] = { bounds[0], bounds[2], bounds[4] };
+    if (cellValues->GetTuple1(i) != PointValue(x))
+      {
+      cerr << "Wrong value at cell " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDistributedDataAllToAll(int argc, char *argv[])
+{
+  vtkMPIController *controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv, 0);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int numProcs = controller->GetNumberOfProcesses();
+  int rank = controller->GetLocalProcessId();
+
+  // Each process has 4 layers of 8x8 cells; the slabs share their
+  // boundary points.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 8, 0, 8, 4 * rank, 4 * (rank + 1));
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("PointValue");
+  pointValues->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    pointValues->SetValue(i, PointValue(image->GetPoint(i)));
+    }
+  image->GetPointData()->SetScalars(pointValues.GetPointer());
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("CellValue");
+  cellValues->SetNumberOfTuples(image->GetNumberOfCells());
+  for (vtkIdType i = 0; i < image->GetNumberOfCells(); ++i)
+    {
+    double bounds[6];
+    image->GetCellBounds(i, bounds);
+    double x[3] = { bounds[0], bounds[2], bounds[4] };
+    cellValues->SetValue(i, PointValue(x));
+    }
+  image->GetCellData()->AddArray(cellValues.GetPointer());
+
+  int retVal = 1;
+  vtkIdType counts[2][2];
+  for (int allToAll = 0; allToAll < 2; ++allToAll)
+    {
+    vtkNew<vtkDistributedDataFilter> dd;
+    dd->SetInputData(image.GetPointer());
+    dd->SetController(controller);
+    dd->SetUseAllToAllRedistribution(allToAll);
+    dd->Update();
+    vtkUnstructuredGrid *grid =
+      vtkUnstructuredGrid::SafeDownCast(dd->GetOutput());
+    if (!grid || !CheckGrid(grid))
+      {
+      cerr << "Redistribution failed on process " << rank
+           << (allToAll ? " with all-to-all" : "") << endl;
+      retVal = 0;
+      continue;
+      }
+    counts[allToAll][0] = grid->GetNumberOfPoints();
+    counts[allToAll][1] = grid->GetNumberOfCells();
+    }
+
+  if (retVal && (counts[0][0] != counts[1][0] || counts[0][1] != counts[1][1]))
+    {
+    cerr << "Process " << rank << " has " << counts[1][0] << " points and "
+         << counts[1][1] << " cells instead of " << counts[0][0] << " and "
+         << counts[0][1] << endl;
+    retVal = 0;
+    }
+
+  vtkIdType numCells = retVal ? counts[1][1] : 0;
+  vtkIdType totalCells = 0;
+  controller->AllReduce(&numCells, &totalCells, 1, vtkCommunicator::SUM_OP);
+  if (rank == 0 && totalCells != 8 * 8 * 4 * numProcs)
+    {
+    cerr << "Redistributed " << totalCells << " cells instead of "
+         << 8 * 8 * 4 * numProcs << endl;
+    retVal = 0;
+    }
+
+  int allPassed = 0;
+  controller->AllReduce(&retVal, &allPassed, 1, vtkCommunicator::MIN_OP);
+
+  vtkMultiProcessController::SetGlobalController(NULL);
+  controller->Finalize();
+  controller->Delete();
+
+  return allPassed ? 0 : 1;
+}
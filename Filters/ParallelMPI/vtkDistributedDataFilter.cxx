@@ -46,6 +46,8 @@
 #include "vtkPlane.h"
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPointSet.h"
 #include "vtkSmartPointer.h"
 #include "vtkSocketController.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -55,6 +57,10 @@
 
 #include "vtkMPIController.h"
 
+#include <vtksys/hash_map.hxx>
+
+#include <sstream>
+#include <string>
 #include <vector>
 
 
@@ -122,6 +128,8 @@ vtkDistributedDataFilter::vtkDistributedDataFilter()
 
   this->UseMinimalMemory = 0;
 
+  this->UseAllToAllRedistribution = 0;
+
   this->UserCuts = 0;
   this->Internals = new vtkDistributedDataFilter::vtkInternals();
 }
@@ -2546,9 +2554,20 @@ vtkUnstructuredGrid *vtkDistributedDataFilter::MPIRedistribute(vtkDataSet *in,
     deleteDataSet = DeleteYes;
     }
 
-  vtkUnstructuredGrid *myNewGrid =
-    this->ExchangeMergeSubGrids(procCellLists, numLists, DeleteNo,
-       in, deleteDataSet, DuplicateCellsNo, GhostCellsNo, 0x0012);
+  vtkUnstructuredGrid *myNewGrid = NULL;
+
+  if (this->UseAllToAllRedistribution)
+    {
+    myNewGrid = this->AllToAllRedistribute(procCellLists, numLists, in,
+                                           deleteDataSet);
+    }
+
+  if (myNewGrid == NULL)
+    {
+    myNewGrid =
+      this->ExchangeMergeSubGrids(procCellLists, numLists, DeleteNo,
+         in, deleteDataSet, DuplicateCellsNo, GhostCellsNo, 0x0012);
+    }
 
   for (proc = 0; proc < nprocs; proc++)
     {
@@ -2568,6 +2587,484 @@ vtkUnstructuredGrid *vtkDistributedDataFilter::MPIRedistribute(vtkDataSet *in,
   return myNewGrid;
 }
 
+//-------------------------------------------------------------------------
+namespace
+{
+// Append raw bytes to a send buffer.
+void vtkDistributedDataFilterPack(std::vector<char> &buf, const void *data,
+                                  size_t size)
+{
+  if (size > 0)
+    {
+    const char *bytes = static_cast<const char *>(data);
+    buf.insert(buf.end(), bytes, bytes + size);
+    }
+}
+
+// Points are joined on their exact coordinates when there are no global
+// point ids.
+struct vtkDistributedDataFilterPointKey
+{
+  double X[3];
+  bool operator==(const vtkDistributedDataFilterPointKey &other) const
+    {
+    return this->X[0] == other.X[0] && this->X[1] == other.X[1] &&
+      this->X[2] == other.X[2];
+    }
+};
+
+struct vtkDistributedDataFilterPointHash
+{
+  size_t operator()(const vtkDistributedDataFilterPointKey &key) const
+    {
+    size_t hash = 0;
+    for (int i = 0; i < 3; ++i)
+      {
+      // Adding 0 turns -0 into 0, which compares equal.
+      double x = key.X[i] + 0.0;
+      unsigned char bytes[sizeof(double)];
+      memcpy(bytes, &x, sizeof(double));
+      for (size_t j = 0; j < sizeof(double); ++j)
+        {
+        hash = hash * 31 + bytes[j];
+        }
+      }
+    return hash;
+    }
+};
+
+struct vtkDistributedDataFilterIdHash
+{
+  size_t operator()(vtkIdType id) const
+    {
+    return static_cast<size_t>(id);
+    }
+};
+
+// Whether the arrays can be sent as raw tuples, and a description of them
+// that must match on all processes.
+bool vtkDistributedDataFilterDescribeArrays(vtkFieldData *fd,
+                                            std::ostringstream &description)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = fd->GetArray(i);
+    if (!array || array->GetDataType() == VTK_BIT)
+      {
+      return false;
+      }
+    description << (array->GetName() ? array->GetName() : "") << ";"
+                << array->GetDataType() << ";"
+                << array->GetNumberOfComponents() << ";";
+    }
+  description << "|";
+  return true;
+}
+
+// Add empty arrays like those of the input, with the same active
+// attributes.
+void vtkDistributedDataFilterCopyArrayLayout(vtkDataSetAttributes *in,
+                                             vtkDataSetAttributes *out,
+                                             vtkIdType numTuples)
+{
+  int attributes[vtkDataSetAttributes::NUM_ATTRIBUTES];
+  in->GetAttributeIndices(attributes);
+  for (int i = 0; i < in->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *array = in->GetArray(i);
+    vtkDataArray *newArray = array->NewInstance();
+    newArray->SetName(array->GetName());
+    newArray->SetNumberOfComponents(array->GetNumberOfComponents());
+    newArray->SetNumberOfTuples(numTuples);
+    out->AddArray(newArray);
+    newArray->Delete();
+    }
+  for (int a = 0; a < vtkDataSetAttributes::NUM_ATTRIBUTES; ++a)
+    {
+    if (attributes[a] >= 0)
+      {
+      out->SetActiveAttribute(attributes[a], a);
+      }
+    }
+}
+
+// Copy the tuples of an array that were packed for a process.
+const char *vtkDistributedDataFilterUnpackTuples(const char *buf,
+                                                 vtkDataArray *array,
+                                                 const vtkIdType *ids,
+                                                 vtkIdType numIds)
+{
+  size_t tupleSize = array->GetNumberOfComponents() *
+    array->GetDataTypeSize();
+  int numComps = array->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < numIds; ++i, buf += tupleSize)
+    {
+    if (ids[i] >= 0)
+      {
+      memcpy(array->GetVoidPointer(ids[i] * numComps), buf, tupleSize);
+      }
+    }
+  return buf;
+}
+}
+
+//-------------------------------------------------------------------------
+vtkUnstructuredGrid *vtkDistributedDataFilter::AllToAllRedistribute(
+  vtkIdList ***cellIds, int *numLists, vtkDataSet *in, int deleteDataSet)
+{
+  int proc;
+  int nprocs = this->NumProcesses;
+
+  vtkPointData *inPD = in->GetPointData();
+  vtkCellData *inCD = in->GetCellData();
+  vtkIdTypeArray *globalIds =
+    vtkIdTypeArray::SafeDownCast(inPD->GetGlobalIds());
+
+  // All processes must be able to pack their data, with the same arrays,
+  // or all of them use the sub grid exchange.
+
+  std::ostringstream description;
+  description << (globalIds != NULL) << "|";
+  int canPack = vtkDistributedDataFilterDescribeArrays(inPD, description) &&
+    vtkDistributedDataFilterDescribeArrays(inCD, description);
+  vtkUnstructuredGrid *inGrid = vtkUnstructuredGrid::SafeDownCast(in);
+  if (inGrid && inGrid->GetFaces())
+    {
+    canPack = 0;
+    }
+  std::string text = description.str();
+  unsigned int hash = 2166136261u;
+  for (size_t i = 0; i < text.size(); ++i)
+    {
+    hash = (hash ^ static_cast<unsigned char>(text[i])) * 16777619u;
+    }
+  int check[2] = { canPack, static_cast<int>(hash & 0x7fffffff) };
+  int minCheck[2];
+  int maxCheck[2];
+  this->Controller->AllReduce(check, minCheck, 2, vtkCommunicator::MIN_OP);
+  this->Controller->AllReduce(check, maxCheck, 2, vtkCommunicator::MAX_OP);
+  if (!minCheck[0] || minCheck[1] != maxCheck[1])
+    {
+    vtkDebugMacro(<< "Redistributing with sub grids instead of all-to-all");
+    return NULL;
+    }
+
+  // Pack the points, cells and arrays for each process in one buffer.  For
+  // each process: the numbers of points, cells and connectivity entries,
+  // the point coordinates, the global point ids if any, the cell types,
+  // the connectivity as (npts, ids...) referring to the points packed, and
+  // the tuples of the point then cell arrays.
+
+  std::vector<char> sendBuf;
+  std::vector<vtkIdType> sendLengths(nprocs, 0);
+  std::vector<vtkIdType> sendOffsets(nprocs, 0);
+  std::vector<vtkIdType> pointMap(in->GetNumberOfPoints(), -1);
+  std::vector<vtkIdType> cells;
+  std::vector<vtkIdType> points;
+  std::vector<vtkIdType> connectivity;
+  std::vector<unsigned char> types;
+  vtkIdList *ptIds = vtkIdList::New();
+
+  for (proc = 0; proc < nprocs; proc++)
+    {
+    sendOffsets[proc] = static_cast<vtkIdType>(sendBuf.size());
+
+    cells.clear();
+    for (int list = 0; list < numLists[proc]; list++)
+      {
+      vtkIdList *ids = cellIds[proc][list];
+      for (vtkIdType i = 0; ids && i < ids->GetNumberOfIds(); i++)
+        {
+        cells.push_back(ids->GetId(i));
+        }
+      }
+    std::sort(cells.begin(), cells.end());
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+    points.clear();
+    connectivity.clear();
+    types.resize(cells.size());
+    for (size_t c = 0; c < cells.size(); c++)
+      {
+      types[c] = static_cast<unsigned char>(in->GetCellType(cells[c]));
+      in->GetCellPoints(cells[c], ptIds);
+      connectivity.push_back(ptIds->GetNumberOfIds());
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); i++)
+        {
+        vtkIdType ptId = ptIds->GetId(i);
+        if (pointMap[ptId] < 0)
+          {
+          pointMap[ptId] = static_cast<vtkIdType>(points.size());
+          points.push_back(ptId);
+          }
+        connectivity.push_back(pointMap[ptId]);
+        }
+      }
+
+    vtkIdType header[3] = { static_cast<vtkIdType>(points.size()),
+                            static_cast<vtkIdType>(cells.size()),
+                            static_cast<vtkIdType>(connectivity.size()) };
+    vtkDistributedDataFilterPack(sendBuf, header, sizeof(header));
+    for (size_t i = 0; i < points.size(); i++)
+      {
+      double x[3];
+      in->GetPoint(points[i], x);
+      vtkDistributedDataFilterPack(sendBuf, x, sizeof(x));
+      pointMap[points[i]] = -1;
+      }
+    if (globalIds)
+      {
+      for (size_t i = 0; i < points.size(); i++)
+        {
+        vtkDistributedDataFilterPack(sendBuf,
+          globalIds->GetPointer(points[i]), sizeof(vtkIdType));
+        }
+      }
+    if (!cells.empty())
+      {
+      vtkDistributedDataFilterPack(sendBuf, &types[0], types.size());
+      vtkDistributedDataFilterPack(sendBuf, &connectivity[0],
+        connectivity.size() * sizeof(vtkIdType));
+      }
+    for (int a = 0; a < inPD->GetNumberOfArrays(); a++)
+      {
+      vtkDataArray *array = inPD->GetArray(a);
+      int numComps = array->GetNumberOfComponents();
+      size_t tupleSize = numComps * array->GetDataTypeSize();
+      for (size_t i = 0; i < points.size(); i++)
+        {
+        vtkDistributedDataFilterPack(sendBuf,
+          array->GetVoidPointer(points[i] * numComps), tupleSize);
+        }
+      }
+    for (int a = 0; a < inCD->GetNumberOfArrays(); a++)
+      {
+      vtkDataArray *array = inCD->GetArray(a);
+      int numComps = array->GetNumberOfComponents();
+      size_t tupleSize = numComps * array->GetDataTypeSize();
+      for (size_t i = 0; i < cells.size(); i++)
+        {
+        vtkDistributedDataFilterPack(sendBuf,
+          array->GetVoidPointer(cells[i] * numComps), tupleSize);
+        }
+      }
+
+    sendLengths[proc] =
+      static_cast<vtkIdType>(sendBuf.size()) - sendOffsets[proc];
+    }
+  ptIds->Delete();
+  std::vector<vtkIdType>().swap(pointMap);
+  std::vector<vtkIdType>().swap(cells);
+  std::vector<vtkIdType>().swap(points);
+  std::vector<vtkIdType>().swap(connectivity);
+
+  // The received grid gets the arrays of the input, which are the same on
+  // all processes.
+
+  vtkUnstructuredGrid *newGrid = vtkUnstructuredGrid::New();
+  vtkDistributedDataFilterCopyArrayLayout(inPD, newGrid->GetPointData(), 0);
+  vtkDistributedDataFilterCopyArrayLayout(inCD, newGrid->GetCellData(), 0);
+  vtkPoints *newPoints = vtkPoints::New();
+  vtkPointSet *inPointSet = vtkPointSet::SafeDownCast(in);
+  if (inPointSet && inPointSet->GetPoints())
+    {
+    newPoints->SetDataType(inPointSet->GetPoints()->GetDataType());
+    }
+
+  if (deleteDataSet)
+    {
+    in->Delete();
+    }
+
+  // Exchange the buffer sizes, then the buffers.
+
+  std::vector<vtkIdType> ones(nprocs, 1);
+  std::vector<vtkIdType> ranks(nprocs);
+  for (proc = 0; proc < nprocs; proc++)
+    {
+    ranks[proc] = proc;
+    }
+  std::vector<vtkIdType> recvLengths(nprocs, 0);
+  this->Controller->AllToAllV(&sendLengths[0], &recvLengths[0],
+                              &ones[0], &ranks[0], &ones[0], &ranks[0]);
+
+  std::vector<vtkIdType> recvOffsets(nprocs, 0);
+  vtkIdType recvSize = 0;
+  for (proc = 0; proc < nprocs; proc++)
+    {
+    recvOffsets[proc] = recvSize;
+    recvSize += recvLengths[proc];
+    }
+  std::vector<char> recvBuf(recvSize > 0 ? recvSize : 1);
+  if (sendBuf.empty())
+    {
+    sendBuf.resize(1);
+    }
+  int ok = this->Controller->AllToAllV(&sendBuf[0], &recvBuf[0],
+                                       &sendLengths[0], &sendOffsets[0],
+                                       &recvLengths[0], &recvOffsets[0]);
+  std::vector<char>().swap(sendBuf);
+  if (!ok)
+    {
+    vtkErrorMacro(<< "All-to-all exchange of the cells failed");
+    }
+
+  // Size the grid for all the cells and, at most, all the points received.
+
+  vtkIdType maxPoints = 0;
+  vtkIdType maxCells = 0;
+  vtkIdType maxConnectivity = 0;
+  for (proc = 0; ok && proc < nprocs; proc++)
+    {
+    if (recvLengths[proc] > 0)
+      {
+      vtkIdType header[3];
+      memcpy(header, &recvBuf[recvOffsets[proc]], sizeof(header));
+      maxPoints += header[0];
+      maxCells += header[1];
+      maxConnectivity += header[2];
+      }
+    }
+
+  vtkPointData *outPD = newGrid->GetPointData();
+  vtkCellData *outCD = newGrid->GetCellData();
+  newPoints->SetNumberOfPoints(maxPoints);
+  for (int a = 0; a < outPD->GetNumberOfArrays(); a++)
+    {
+    outPD->GetArray(a)->SetNumberOfTuples(maxPoints);
+    }
+  for (int a = 0; a < outCD->GetNumberOfArrays(); a++)
+    {
+    outCD->GetArray(a)->SetNumberOfTuples(maxCells);
+    }
+  newGrid->Allocate(maxCells, maxConnectivity);
+
+  // Merge the points with a hash join on their global ids, or on their
+  // coordinates, and insert the cells.
+
+  typedef vtksys::hash_map<vtkIdType, vtkIdType,
+    vtkDistributedDataFilterIdHash> IdMapType;
+  typedef vtksys::hash_map<vtkDistributedDataFilterPointKey, vtkIdType,
+    vtkDistributedDataFilterPointHash> PointMapType;
+  IdMapType idMap;
+  PointMapType pointMapByCoords;
+  vtkIdType numPoints = 0;
+  vtkIdType numCells = 0;
+  std::vector<vtkIdType> localIds;
+  std::vector<vtkIdType> newIds;
+  std::vector<vtkIdType> cellIdsReceived;
+  std::vector<vtkIdType> ids;
+
+  for (proc = 0; ok && proc < nprocs; proc++)
+    {
+    if (recvLengths[proc] <= 0)
+      {
+      continue;
+      }
+    const char *buf = &recvBuf[recvOffsets[proc]];
+    vtkIdType header[3];
+    memcpy(header, buf, sizeof(header));
+    buf += sizeof(header);
+    vtkIdType npts = header[0];
+    vtkIdType ncells = header[1];
+    vtkIdType nconn = header[2];
+
+    const char *coords = buf;
+    buf += npts * 3 * sizeof(double);
+    const char *gids = buf;
+    if (globalIds)
+      {
+      buf += npts * sizeof(vtkIdType);
+      }
+
+    // New points get the next ids; the tuples of points already merged
+    // are skipped when unpacking the arrays.
+    localIds.resize(npts > 0 ? npts : 1);
+    newIds.resize(npts > 0 ? npts : 1);
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      vtkDistributedDataFilterPointKey key;
+      memcpy(key.X, coords + i * 3 * sizeof(double), sizeof(key.X));
+      vtkIdType id = numPoints;
+      bool inserted;
+      if (globalIds)
+        {
+        vtkIdType gid;
+        memcpy(&gid, gids + i * sizeof(vtkIdType), sizeof(vtkIdType));
+        std::pair<IdMapType::iterator, bool> result =
+          idMap.insert(IdMapType::value_type(gid, id));
+        inserted = result.second;
+        id = result.first->second;
+        }
+      else
+        {
+        std::pair<PointMapType::iterator, bool> result =
+          pointMapByCoords.insert(PointMapType::value_type(key, id));
+        inserted = result.second;
+        id = result.first->second;
+        }
+      localIds[i] = id;
+      newIds[i] = inserted ? id : -1;
+      if (inserted)
+        {
+        newPoints->SetPoint(id, key.X);
+        numPoints++;
+        }
+      }
+
+    const unsigned char *cellTypes =
+      reinterpret_cast<const unsigned char *>(buf);
+    buf += ncells;
+    const char *conn = buf;
+    buf += nconn * sizeof(vtkIdType);
+    vtkIdType pos = 0;
+    for (vtkIdType c = 0; c < ncells; c++)
+      {
+      vtkIdType n;
+      memcpy(&n, conn + pos * sizeof(vtkIdType), sizeof(vtkIdType));
+      ids.resize(n > 0 ? n : 1);
+      memcpy(&ids[0], conn + (pos + 1) * sizeof(vtkIdType),
+             n * sizeof(vtkIdType));
+      for (vtkIdType i = 0; i < n; i++)
+        {
+        ids[i] = localIds[ids[i]];
+        }
+      newGrid->InsertNextCell(cellTypes[c], n, &ids[0]);
+      pos += n + 1;
+      }
+
+    for (int a = 0; a < outPD->GetNumberOfArrays(); a++)
+      {
+      buf = vtkDistributedDataFilterUnpackTuples(buf, outPD->GetArray(a),
+                                                 &newIds[0], npts);
+      }
+    cellIdsReceived.resize(ncells > 0 ? ncells : 1);
+    for (vtkIdType c = 0; c < ncells; c++)
+      {
+      cellIdsReceived[c] = numCells + c;
+      }
+    for (int a = 0; a < outCD->GetNumberOfArrays(); a++)
+      {
+      buf = vtkDistributedDataFilterUnpackTuples(buf, outCD->GetArray(a),
+                                                 &cellIdsReceived[0], ncells);
+      }
+    numCells += ncells;
+    }
+
+  newPoints->SetNumberOfPoints(numPoints);
+  newPoints->Squeeze();
+  newGrid->SetPoints(newPoints);
+  newPoints->Delete();
+  for (int a = 0; a < outPD->GetNumberOfArrays(); a++)
+    {
+    outPD->GetArray(a)->SetNumberOfTuples(numPoints);
+    outPD->GetArray(a)->Squeeze();
+    }
+  newGrid->Squeeze();
+
+  return newGrid;
+}
+
 //-------------------------------------------------------------------------
 char *vtkDistributedDataFilter::MarshallDataSet(vtkUnstructuredGrid *extractedGrid, int &len)
 {
@@ -4587,4 +5084,6 @@ void vtkDistributedDataFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Timing: " << this->Timing << endl;
   os << indent << "UseMinimalMemory: " << this->UseMinimalMemory << endl;
+  os << indent << "UseAllToAllRedistribution: "
+     << this->UseAllToAllRedistribution << endl;
 }
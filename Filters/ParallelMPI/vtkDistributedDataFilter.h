@@ -207,6 +207,19 @@ public:
   vtkGetMacro(UseMinimalMemory, int);
   vtkSetMacro(UseMinimalMemory, int);
 
+  // Description:
+  //  Redistribute the cells with a single all-to-all exchange of packed
+  //  points, connectivity and attribute arrays, instead of marshalling a
+  //  sub grid for each process and merging the grids received.  Points
+  //  are merged by global id when the input has global point ids, else
+  //  by their exact coordinates.  Data sets with polyhedra, or whose
+  //  arrays differ between processes, fall back to the sub grid exchange.
+  //  Off by default.
+
+  vtkBooleanMacro(UseAllToAllRedistribution, int);
+  vtkGetMacro(UseAllToAllRedistribution, int);
+  vtkSetMacro(UseAllToAllRedistribution, int);
+
 
   // Description:
   //  Turn on collection of timing data
@@ -359,6 +372,15 @@ private:
   // ?
   vtkIdList **GetCellIdsForProcess(int proc, int *nlists);
 
+  // Description:
+  // Redistribute the cells listed for each process with one all-to-all
+  // exchange, and build my grid from the buffers received.  Returns NULL,
+  // on all processes, if the data set can not be sent this way.  Deletes
+  // the data set once packed if deleteDataSet is set.
+  vtkUnstructuredGrid *AllToAllRedistribute(vtkIdList ***cellIds,
+                                            int *numLists, vtkDataSet *in,
+                                            int deleteDataSet);
+
   // Description:
   // Fills in the Source and Target arrays which contain a schedule to allow
   // each processor to talk to every other.
@@ -550,6 +572,8 @@ private:
 
   int UseMinimalMemory;
 
+  int UseAllToAllRedistribution;
+
   vtkBSPCuts* UserCuts;
 
   vtkDistributedDataFilter(const vtkDistributedDataFilter&); // Not implemented
@@ -32,6 +32,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkObjectFactory.h"
 #include "vtkMath.h"
 #include "vtkMultiProcessController.h"
+#include "vtkQuantileSketch.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariantArray.h"
@@ -405,6 +406,32 @@ bool vtkPOrderStatistics::Reduce( vtkIdTypeArray* card_g,
     histogram[x] += c;
     }
 
+  // When sketches are used, summarize the reduced histogram again so that
+  // its size stays bounded whatever the number of processes
+  if ( this->UseSketch )
+    {
+    vtkQuantileSketch* sketch = vtkQuantileSketch::New();
+    sketch->SetCompression( this->SketchCompression );
+    for ( std::map<double,vtkIdType>::iterator hit = histogram.begin();
+          hit != histogram.end(); ++ hit )
+      {
+      sketch->AddValue( hit->first, hit->second );
+      }
+
+    nRow_g = sketch->GetNumberOfCentroids();
+    dVals_g->SetNumberOfTuples( nRow_g );
+    card_g->SetNumberOfTuples( nRow_g );
+    for ( vtkIdType r = 0; r < nRow_g; ++ r )
+      {
+      sketch->GetCentroid( r, x, c );
+      dVals_g->SetTuple1( r, x );
+      card_g->SetValue( r, c );
+      }
+    sketch->Delete();
+
+    return false;
+    }
+
   // Now resize global histogram arrays to reduced size
   nRow_g = static_cast<vtkIdType>( histogram.size() );
   dVals_g->SetNumberOfTuples( nRow_g );
@@ -0,0 +1,140 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPMergePoints.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPMergePoints.h"
+#include "vtkSMPTools.h"
+
+#include <vector>
+
+const int resolution = 50;
+
+// Each cell of a resolution^3 grid inserts its 8 corners, so that the
+// inner grid points are inserted by up to 8 threads.
+class vtkInsertCornersFunctor
+{
+public:
+  vtkSMPMergePoints* Locator;
+  vtkIdType* Ids;
+  int* Inserted;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cell = begin; cell < end; cell++)
+      {
+      int i = cell % resolution;
+      int j = (cell / resolution) % resolution;
+      int k = cell / (resolution * resolution);
+      for (int corner = 0; corner < 8; corner++)
+        {
+        double x[3] = { static_cast<double>(i + (corner & 1)),
+                        static_cast<double>(j + ((corner >> 1) & 1)),
+                        static_cast<double>(k + ((corner >> 2) & 1)) };
+        this->Inserted[8*cell + corner] =
+          this->Locator->InsertUniquePointConcurrently(x, this->Ids[8*cell + corner]);
+        }
+      }
+  }
+};
+
+int TestSMPMergePoints(int, char *[])
+{
+  const vtkIdType numCells = resolution * resolution * resolution;
+  const vtkIdType numPts =
+    (resolution + 1) * (resolution + 1) * (resolution + 1);
+  const double bounds[6] = { 0, resolution, 0, resolution, 0, resolution };
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkSMPMergePoints> locator;
+  locator->InitPointInsertion(points.GetPointer(), bounds, numPts);
+  points->Resize(numPts);
+  locator->InitializeConcurrentInsertion();
+
+  std::vector<vtkIdType> ids(8*numCells);
+  std::vector<int> inserted(8*numCells);
+  vtkInsertCornersFunctor functor;
+  functor.Locator = locator.GetPointer();
+  functor.Ids = &ids[0];
+  functor.Inserted = &inserted[0];
+  vtkSMPTools::For(0, numCells, functor);
+  locator->FixSizeOfPointArray();
+
+  if (points->GetNumberOfPoints() != numPts)
+    {
+    cerr << "Expected " << numPts << " points, got "
+         << points->GetNumberOfPoints() << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Every grid point is inserted once, and all its insertions get its id.
+  std::vector<vtkIdType> gridIds(numPts, -1);
+  vtkIdType numInserted = 0;
+  for (vtkIdType cell = 0; cell < numCells; cell++)
+    {
+    for (int corner = 0; corner < 8; corner++)
+      {
+      vtkIdType id = ids[8*cell + corner];
+      numInserted += inserted[8*cell + corner];
+      if (id < 0 || id >= numPts)
+        {
+        cerr << "Bad point id " << id << endl;
+        return EXIT_FAILURE;
+        }
+      double x[3];
+      points->GetPoint(id, x);
+      vtkIdType gridId = static_cast<vtkIdType>(x[0]) +
+        (resolution + 1) * (static_cast<vtkIdType>(x[1]) +
+                            (resolution + 1) * static_cast<vtkIdType>(x[2]));
+      if (gridIds[gridId] < 0)
+        {
+        gridIds[gridId] = id;
+        }
+      else if (gridIds[gridId] != id)
+        {
+        cerr << "Point " << x[0] << " " << x[1] << " " << x[2]
+             << " was inserted twice" << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+  if (numInserted != numPts)
+    {
+    cerr << "Expected " << numPts << " insertions, got " << numInserted
+         << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Points that do not fit in the allocated points are not inserted.
+  vtkNew<vtkPoints> fewPoints;
+  locator->InitPointInsertion(fewPoints.GetPointer(), bounds, 2);
+  fewPoints->Resize(2);
+  locator->InitializeConcurrentInsertion();
+  vtkIdType id;
+  double x[3] = { 0.0, 0.0, 0.0 };
+  for (int i = 0; i < 3; i++)
+    {
+    x[0] = i;
+    locator->InsertUniquePointConcurrently(x, id);
+    }
+  locator->FixSizeOfPointArray();
+  if (id != -1 || fewPoints->GetNumberOfPoints() != 2)
+    {
+    cerr << "Insertion past the allocated points did not fail" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
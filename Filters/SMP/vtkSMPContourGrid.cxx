@@ -36,7 +36,7 @@
 #include "vtkSMPMergePolyDataHelper.h"
 #include "vtkInformationVector.h"
 #include "vtkDemandDrivenPipeline.h"
-#include "vtkSimpleScalarTree.h"
+#include "vtkSpanSpace.h"
 
 #include "vtkTimerLog.h"
 
@@ -87,6 +87,7 @@ public:
 
   vtkUnstructuredGrid* Input;
   vtkDataArray* InScalars;
+  vtkScalarTree* ScalarTree;
 
   vtkDataObject* Output;
 
@@ -106,11 +107,13 @@ public:
   vtkContourGridFunctor(vtkSMPContourGrid* filter,
                         vtkUnstructuredGrid* input,
                         vtkDataArray* inScalars,
+                        vtkScalarTree* scalarTree,
                         int numValues,
                         double* values,
                         vtkDataObject* output) : Filter(filter),
                                                  Input(input),
                                                  InScalars(inScalars),
+                                                 ScalarTree(scalarTree),
                                                  Output(output),
                                                  NumValues(numValues),
                                                  Values(values)
@@ -145,7 +148,9 @@ public:
   void Initialize()
   {
     // Initialize thread local object before any processing happens.
-    // This gets called once per thread.
+    // This gets called once per thread and per vtkSMPTools::For(), which
+    // is invoked once for each contour value when a scalar tree is used.
+    // The thread local output must survive across these invocations.
 
     vtkPointLocator* locator;
     vtkPolyData* output;
@@ -154,6 +159,10 @@ public:
     vtkIdList* polyOffsets;
 
     vtkLocalDataType& localData = this->LocalData.Local();
+    if (localData.Output)
+      {
+      return;
+      }
 
     localData.Output = vtkPolyData::New();
     output = localData.Output;
@@ -269,9 +278,10 @@ public:
     T range[2];
     vtkIdType cellid;
 
-    // If UseScalarTree is enabled at this point, we assume that a scalar
-    // tree has been computed and thus the way cells are traversed changes.
-    if ( ! this->Filter->GetUseScalarTree() )
+    // If a scalar tree is provided, we assume that it has been traversed
+    // to the current contour value and thus the way cells are traversed
+    // changes.
+    if ( ! this->ScalarTree )
       {
       // This code assumes no scalar tree, thus it checks scalar range prior
       // to invoking contour.
@@ -361,7 +371,7 @@ public:
       // The begin / end parameters to this function represent batches of candidate
       // cells.
       vtkIdType numCellsContoured=0;
-      vtkScalarTree *scalarTree = this->Filter->GetScalarTree();
+      vtkScalarTree *scalarTree = this->ScalarTree;
       const vtkIdType *cellIds;
       vtkIdType numCells;
       for ( vtkIdType batchNum=begin; batchNum < end; ++batchNum)
@@ -417,6 +427,13 @@ public:
   }//operator()
 
   void Reduce()
+  {
+    // Nothing to do here. vtkSMPTools::For() calls this after each pass
+    // but, when a scalar tree is used, there is one pass per contour
+    // value. Finalize() is invoked once all passes are done.
+  }
+
+  void Finalize()
   {
     // Create the final multi-block dataset
 
@@ -467,19 +484,20 @@ void DoContour(vtkSMPContourGrid* filter,
                vtkUnstructuredGrid* input,
                vtkIdType numCells,
                vtkDataArray* inScalars,
+               vtkScalarTree* scalarTree,
                int numContours,
                double* values,
                vtkDataObject* output)
 {
   // Contour in parallel; create the processing functor
-  vtkContourGridFunctor<T> functor(filter, input, inScalars, numContours, values, output);
+  vtkContourGridFunctor<T> functor(filter, input, inScalars, scalarTree,
+                                   numContours, values, output);
 
   // If a scalar tree is used, then the way in which cells are iterated over changes.
   // With a scalar tree, batches of candidate cells are provided. Without one, then all
   // cells are iterated over one by one.
-  if ( filter->GetUseScalarTree() )
+  if ( scalarTree )
     {//process in threaded using scalar tree
-    vtkScalarTree *scalarTree = filter->GetScalarTree();
     vtkIdType numBatches;
     for (int i=0; i < numContours; ++i)
       {
@@ -495,6 +513,7 @@ void DoContour(vtkSMPContourGrid* filter,
     {//process all cells in parallel manner
     vtkSMPTools::For(0, numCells, functor);
     }
+  functor.Finalize();
 
   // Now process the output from the separate threads. Merging may or may not be
   // required.
@@ -587,15 +606,18 @@ int vtkSMPContourGrid::RequestData(
 
   vtkIdType numCells = input->GetNumberOfCells();
 
-  // Create scalar tree if necessary and if requested
-  int useScalarTree = this->GetUseScalarTree();
-  vtkScalarTree *scalarTree = this->ScalarTree;
-  if ( useScalarTree )
+  // Create scalar tree if necessary and if requested. A span space is
+  // used by default since it is built in parallel and hands out its
+  // candidate cells in batches. The tree is retained so that changing
+  // the contour values does not rebuild it.
+  vtkScalarTree *scalarTree = NULL;
+  if ( this->UseScalarTree )
     {
-    if ( scalarTree == NULL )
+    if ( this->ScalarTree == NULL )
       {
-      scalarTree = vtkSimpleScalarTree::New();
+      this->ScalarTree = vtkSpanSpace::New();
       }
+    scalarTree = this->ScalarTree;
     scalarTree->SetDataSet(input);
     scalarTree->SetScalars(inScalars);
     }
@@ -603,11 +625,13 @@ int vtkSMPContourGrid::RequestData(
   // Actually execute the contouring operation
   if (inScalars->GetDataType() == VTK_FLOAT)
     {
-    DoContour<float>(this, input, numCells, inScalars, numContours, values, output);
+    DoContour<float>(this, input, numCells, inScalars, scalarTree,
+                     numContours, values, output);
     }
   else if(inScalars->GetDataType() == VTK_DOUBLE)
     {
-    DoContour<double>(this, input, numCells, inScalars, numContours, values, output);
+    DoContour<double>(this, input, numCells, inScalars, scalarTree,
+                      numContours, values, output);
     }
 
   return 1;
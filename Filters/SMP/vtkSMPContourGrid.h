@@ -15,7 +15,9 @@
 // .NAME vtkSMPContourGrid - a subclass of vtkContourGrid that works in parallel
 // vtkSMPContourGrid performs the same functionaliy as vtkContourGrid but does
 // it using multiple threads. This will probably be merged with vtkContourGrid
-// in the future.
+// in the future. When UseScalarTree is enabled and no scalar tree is
+// specified, a vtkSpanSpace is created and retained; candidate cells are
+// then processed in parallel, one batch at a time.
 
 #ifndef vtkSMPContourGrid_h
 #define vtkSMPContourGrid_h
@@ -18,6 +18,7 @@
 #include "vtkIdList.h"
 #include "vtkObjectFactory.h"
 #include "vtkFloatArray.h"
+#include "vtkDoubleArray.h"
 #include "vtkPointData.h"
 
 //------------------------------------------------------------------------------
@@ -26,11 +27,15 @@ vtkStandardNewMacro(vtkSMPMergePoints)
 //------------------------------------------------------------------------------
 vtkSMPMergePoints::vtkSMPMergePoints()
 {
+  this->BucketLocks = 0;
+  this->NumberOfBucketLocks = 0;
+  this->MaxNumberOfPoints = -1;
 }
 
 //------------------------------------------------------------------------------
 vtkSMPMergePoints::~vtkSMPMergePoints()
 {
+  delete [] this->BucketLocks;
 }
 
 //------------------------------------------------------------------------------
@@ -43,6 +48,7 @@ void vtkSMPMergePoints::PrintSelf(ostream &os, vtkIndent indent)
 void vtkSMPMergePoints::InitializeMerge()
 {
   this->AtomicInsertionId = this->InsertionPointId;
+  this->MaxNumberOfPoints = -1;
 }
 
 //------------------------------------------------------------------------------
@@ -171,5 +177,156 @@ void vtkSMPMergePoints::Merge(vtkSMPMergePoints* locator,
 //------------------------------------------------------------------------------
 void vtkSMPMergePoints::FixSizeOfPointArray()
 {
-  this->Points->SetNumberOfPoints(this->AtomicInsertionId);
+  vtkIdType numPts = this->AtomicInsertionId;
+  // Failed concurrent insertions still took an id.
+  if ( this->MaxNumberOfPoints >= 0 && numPts > this->MaxNumberOfPoints )
+    {
+    numPts = this->MaxNumberOfPoints;
+    }
+  this->Points->SetNumberOfPoints(numPts);
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPMergePoints::InitializeConcurrentInsertion()
+{
+  this->AtomicInsertionId = this->InsertionPointId;
+  this->MaxNumberOfPoints = this->Points->GetData()->GetSize() / 3;
+  if ( this->NumberOfBucketLocks != this->NumberOfBuckets )
+    {
+    delete [] this->BucketLocks;
+    this->BucketLocks = new vtkAtomicInt32[this->NumberOfBuckets];
+    this->NumberOfBucketLocks = this->NumberOfBuckets;
+    }
+}
+
+//------------------------------------------------------------------------------
+namespace
+{
+// vtkAtomic has no compare-and-swap, so the bin locks spin on the
+// increment: the thread that raises the count from 0 owns the bin.
+inline void vtkSMPMergePointsLockBucket(vtkAtomicInt32 &lock)
+{
+  for (;;)
+    {
+    while ( lock != 0 )
+      {
+      }
+    if ( ++lock == 1 )
+      {
+      return;
+      }
+    --lock;
+    }
+}
+
+template <class T>
+vtkIdType vtkSMPMergePointsFindPoint(const T *pts, const vtkIdType *ids,
+                                     vtkIdType numIds, const double x[3])
+{
+  const T p[3] =
+    { static_cast<T>(x[0]), static_cast<T>(x[1]), static_cast<T>(x[2]) };
+  for ( vtkIdType i = 0; i < numIds; i++ )
+    {
+    const T *pt = pts + 3*ids[i];
+    if ( p[0] == pt[0] && p[1] == pt[1] && p[2] == pt[2] )
+      {
+      return ids[i];
+      }
+    }
+  return -1;
+}
+
+template <class T>
+inline void vtkSMPMergePointsStorePoint(T *pts, vtkIdType ptId,
+                                        const double x[3])
+{
+  T *pt = pts + 3*ptId;
+  pt[0] = static_cast<T>(x[0]);
+  pt[1] = static_cast<T>(x[1]);
+  pt[2] = static_cast<T>(x[2]);
+}
+}
+
+//------------------------------------------------------------------------------
+int vtkSMPMergePoints::InsertUniquePointConcurrently(const double x[3],
+                                                     vtkIdType &ptId)
+{
+  vtkIdType idx = this->GetBucketIndex(x);
+  vtkAtomicInt32 &lock = this->BucketLocks[idx];
+  vtkSMPMergePointsLockBucket(lock);
+
+  vtkIdList *bucket = this->HashTable[idx];
+  vtkDataArray *dataArray = this->Points->GetData();
+  if ( bucket )
+    {
+    // Only the points of this bin are read, and they were all written by
+    // threads that held its lock.
+    vtkIdType *idArray = bucket->GetPointer(0);
+    vtkIdType nbOfIds = bucket->GetNumberOfIds();
+    vtkIdType existingId = -1;
+    switch ( dataArray->GetDataType() )
+      {
+      case VTK_FLOAT:
+        existingId = vtkSMPMergePointsFindPoint(
+          static_cast<vtkFloatArray*>(dataArray)->GetPointer(0),
+          idArray, nbOfIds, x);
+        break;
+      case VTK_DOUBLE:
+        existingId = vtkSMPMergePointsFindPoint(
+          static_cast<vtkDoubleArray*>(dataArray)->GetPointer(0),
+          idArray, nbOfIds, x);
+        break;
+      default:
+        for ( vtkIdType i = 0; i < nbOfIds && existingId < 0; i++ )
+          {
+          double pt[3];
+          dataArray->GetTuple( idArray[i], pt );
+          if ( x[0] == pt[0] && x[1] == pt[1] && x[2] == pt[2] )
+            {
+            existingId = idArray[i];
+            }
+          }
+      }
+    if ( existingId >= 0 )
+      {
+      --lock;
+      ptId = existingId;
+      return 0;
+      }
+    }
+
+  // point has to be added
+  ptId = this->AtomicInsertionId++;
+  if ( ptId >= this->MaxNumberOfPoints )
+    {
+    --lock;
+    ptId = -1;
+    return -1;
+    }
+  if ( !bucket )
+    {
+    bucket = vtkIdList::New();
+    bucket->Allocate( this->NumberOfPointsPerBucket/2,
+                      this->NumberOfPointsPerBucket/3 );
+    this->HashTable[idx] = bucket;
+    }
+  // The coordinates are written in place: SetTuple() would reset the
+  // caches of the array from many threads.
+  switch ( dataArray->GetDataType() )
+    {
+    case VTK_FLOAT:
+      vtkSMPMergePointsStorePoint(
+        static_cast<vtkFloatArray*>(dataArray)->GetPointer(0), ptId, x);
+      break;
+    case VTK_DOUBLE:
+      vtkSMPMergePointsStorePoint(
+        static_cast<vtkDoubleArray*>(dataArray)->GetPointer(0), ptId, x);
+      break;
+    default:
+      dataArray->SetTuple( ptId, x );
+    }
+  bucket->InsertNextId( ptId );
+  --lock;
+
+  return 1;
 }
@@ -24,6 +24,16 @@
 //  - Allocate points with outLocator->GetPoints()->Resize(numPts) (numPts should be >= total number of points)
 //  - Do bunch of merging with outLocator->Merge(inLocator[i], ...) (this can be done in parallel as long as no two bins are done at the same time)
 //  - Fix the size of points with outLocator->FixSizeOfPointArray()
+//
+// Points can also be merged as they are generated, without thread local
+// locators, with InsertUniquePointConcurrently(), which many threads can
+// call at the same time:
+//  - Initialize with locator->InitPointInsertion(points, bounds, estNumPts)
+//  - Allocate points with points->Resize(numPts) (numPts should be >= total number of points)
+//  - Initialize with locator->InitializeConcurrentInsertion()
+//  - Insert points from any thread with locator->InsertUniquePointConcurrently(x, id)
+//  - Fix the size of points with locator->FixSizeOfPointArray()
+// The ids of the points depend on the order in which threads insert them.
 
 #ifndef vtkSMPMergePoints_h
 #define vtkSMPMergePoints_h
@@ -69,6 +79,21 @@ public:
   //  - Fix the size of points with outLocator->FixSizeOfPointArray()
   void FixSizeOfPointArray();
 
+  // Description:
+  // This should be called from 1 thread after InitPointInsertion() and
+  // after the points array is allocated, before any call to
+  // InsertUniquePointConcurrently().
+  void InitializeConcurrentInsertion();
+
+  // Description:
+  // Thread safe version of InsertUniquePoint(). Threads only wait for each
+  // other when they insert into the same bin, and the ids are handed out
+  // atomically. Returns 1 if the point was inserted, 0 if it was already
+  // there, with its id in ptId. The points array does not grow: a point
+  // that does not fit in the allocated points is not inserted, and -1 is
+  // returned.
+  int InsertUniquePointConcurrently(const double x[3], vtkIdType &ptId);
+
   // Description:
   // Returns the biggest id in the locator.
   vtkIdType GetMaxId()
@@ -101,6 +126,11 @@ protected:
 
   vtkAtomicIdType AtomicInsertionId;
 
+  // One lock per bin for the concurrent insertion.
+  vtkAtomicInt32 *BucketLocks;
+  vtkIdType NumberOfBucketLocks;
+  vtkIdType MaxNumberOfPoints;
+
 private:
   vtkSMPMergePoints(const vtkSMPMergePoints&); // Not implemented
   void operator=(const vtkSMPMergePoints&); // Not implemented
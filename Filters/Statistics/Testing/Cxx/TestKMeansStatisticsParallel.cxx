@@ -0,0 +1,167 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestKMeansStatisticsParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkKMeansStatistics learns the same clusters and assesses the
+// same memberships with ClusterInParallel on as with it off, on separated
+// Gaussian blobs stored in double and float columns.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkKMeansStatistics.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkStatisticsAlgorithm.h"
+#include "vtkTable.h"
+
+#include <cmath>
+#include <sstream>
+
+namespace
+{
+
+const int nDim = 6;
+
+bool SameColumns(vtkTable *expected, vtkTable *output, const char *what)
+{
+  if (expected->GetNumberOfRows() != output->GetNumberOfRows() ||
+      expected->GetNumberOfColumns() != output->GetNumberOfColumns())
+    {
+    cerr << what << ": different table sizes" << endl;
+    return false;
+    }
+  for (vtkIdType c = 0; c < expected->GetNumberOfColumns(); ++c)
+    {
+    vtkDataArray *e = vtkDataArray::SafeDownCast(expected->GetColumn(c));
+    vtkDataArray *o = vtkDataArray::SafeDownCast(output->GetColumn(c));
+    if (!e || !o)
+      {
+      continue;
+      }
+    for (vtkIdType r = 0; r < expected->GetNumberOfRows(); ++r)
+      {
+      double x = e->GetTuple1(r), y = o->GetTuple1(r);
+      if (fabs(x - y) > 1e-9 * (1.0 + fabs(x)))
+        {
+        cerr << what << ": " << expected->GetColumnName(c) << " differs in row "
+             << r << ": " << x << " <> " << y << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+}
+
+int TestKMeansStatisticsParallel(int, char *[])
+{
+  vtkMath::RandomSeed(4242);
+
+  // Five blobs far apart from each other
+  const int nBlobs = 5;
+  const int nVals = 20000;
+  vtkNew<vtkTable> inputData;
+  for (int c = 0; c < nDim; ++c)
+    {
+    std::ostringstream colName;
+    colName << "coord " << c;
+    vtkDataArray *column = c % 2 ? static_cast<vtkDataArray*>(vtkFloatArray::New())
+                                 : static_cast<vtkDataArray*>(vtkDoubleArray::New());
+    column->SetName(colName.str().c_str());
+    column->SetNumberOfTuples(nVals);
+    for (int r = 0; r < nVals; ++r)
+      {
+      int blob = r % nBlobs;
+      column->SetTuple1(r, 10.0 * ((blob + c) % nBlobs) + vtkMath::Gaussian());
+      }
+    inputData->AddColumn(column);
+    column->Delete();
+    }
+
+  // Two runs, seeded with one observation of each blob and with three
+  // observations respectively
+  vtkNew<vtkTable> paramData;
+  vtkNew<vtkIdTypeArray> paramCluster;
+  paramCluster->SetName("K");
+  const int seeds[] = { 0, 1, 2, 3, 4, 100, 201, 302 };
+  const int numClusters[] = { 5, 5, 5, 5, 5, 3, 3, 3 };
+  for (int i = 0; i < 8; ++i)
+    {
+    paramCluster->InsertNextValue(numClusters[i]);
+    }
+  paramData->AddColumn(paramCluster.GetPointer());
+  for (int c = 0; c < nDim; ++c)
+    {
+    vtkNew<vtkDoubleArray> paramArray;
+    paramArray->SetName(inputData->GetColumnName(c));
+    for (int i = 0; i < 8; ++i)
+      {
+      paramArray->InsertNextValue(inputData->GetValue(seeds[i], c).ToDouble());
+      }
+    paramData->AddColumn(paramArray.GetPointer());
+    }
+
+  vtkNew<vtkKMeansStatistics> kms;
+  kms->SetInputData(vtkStatisticsAlgorithm::INPUT_DATA, inputData.GetPointer());
+  kms->SetInputData(vtkStatisticsAlgorithm::LEARN_PARAMETERS, paramData.GetPointer());
+  for (int c = 0; c < nDim; ++c)
+    {
+    kms->SetColumnStatus(inputData->GetColumnName(c), 1);
+    }
+  kms->RequestSelectedColumns();
+  kms->SetLearnOption(true);
+  kms->SetDeriveOption(true);
+  kms->SetAssessOption(true);
+  kms->SetTolerance(0.0001);
+
+  kms->ClusterInParallelOff();
+  kms->Update();
+  vtkNew<vtkMultiBlockDataSet> expectedModel;
+  expectedModel->DeepCopy(kms->GetOutputDataObject(vtkStatisticsAlgorithm::OUTPUT_MODEL));
+  vtkNew<vtkTable> expectedData;
+  expectedData->DeepCopy(kms->GetOutput(vtkStatisticsAlgorithm::OUTPUT_DATA));
+
+  kms->ClusterInParallelOn();
+  kms->Update();
+  vtkMultiBlockDataSet *outputModel = vtkMultiBlockDataSet::SafeDownCast(
+    kms->GetOutputDataObject(vtkStatisticsAlgorithm::OUTPUT_MODEL));
+
+  vtkTable *expectedCenters = vtkTable::SafeDownCast(expectedModel->GetBlock(0));
+  if (!SameColumns(expectedCenters,
+                   vtkTable::SafeDownCast(outputModel->GetBlock(0)), "learned centers") ||
+      !SameColumns(vtkTable::SafeDownCast(expectedModel->GetBlock(1)),
+                   vtkTable::SafeDownCast(outputModel->GetBlock(1)), "ranked runs") ||
+      !SameColumns(expectedData.GetPointer(),
+                   kms->GetOutput(vtkStatisticsAlgorithm::OUTPUT_DATA), "assessment"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The first run must have found the five blobs
+  for (vtkIdType r = 0; r < nBlobs; ++r)
+    {
+    if (expectedCenters->GetValueByName(r, "Cardinality").ToInt() != nVals / nBlobs)
+      {
+      cerr << "Cluster " << r << " of the first run has "
+           << expectedCenters->GetValueByName(r, "Cardinality").ToInt()
+           << " members instead of " << nVals / nBlobs << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
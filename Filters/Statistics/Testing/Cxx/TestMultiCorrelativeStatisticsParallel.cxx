@@ -0,0 +1,162 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMultiCorrelativeStatisticsParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkMultiCorrelativeStatistics and vtkPCAStatistics compute the
+// same models and assessments with ComputeInParallel on as with it off, on
+// correlated columns of several types.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiCorrelativeStatistics.h"
+#include "vtkNew.h"
+#include "vtkPCAStatistics.h"
+#include "vtkStatisticsAlgorithm.h"
+#include "vtkTable.h"
+
+#include <cmath>
+
+namespace
+{
+
+bool SameTables(vtkTable *expected, vtkTable *output, const char *what)
+{
+  if (!expected || !output ||
+      expected->GetNumberOfRows() != output->GetNumberOfRows() ||
+      expected->GetNumberOfColumns() != output->GetNumberOfColumns())
+    {
+    cerr << what << ": different tables" << endl;
+    return false;
+    }
+  for (vtkIdType c = 0; c < expected->GetNumberOfColumns(); ++c)
+    {
+    vtkDataArray *e = vtkDataArray::SafeDownCast(expected->GetColumn(c));
+    vtkDataArray *o = vtkDataArray::SafeDownCast(output->GetColumn(c));
+    if (!e || !o)
+      {
+      continue;
+      }
+    for (vtkIdType r = 0; r < expected->GetNumberOfRows(); ++r)
+      {
+      double x = e->GetTuple1(r), y = o->GetTuple1(r);
+      if (fabs(x - y) > 1e-8 * (1.0 + fabs(x)))
+        {
+        cerr << what << ": " << expected->GetColumnName(c) << " differs in row "
+             << r << ": " << x << " <> " << y << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool Check(vtkMultiCorrelativeStatistics *stats, const char *what)
+{
+  stats->ComputeInParallelOff();
+  stats->Update();
+  vtkNew<vtkMultiBlockDataSet> expectedModel;
+  expectedModel->DeepCopy(
+    stats->GetOutputDataObject(vtkStatisticsAlgorithm::OUTPUT_MODEL));
+  vtkNew<vtkTable> expectedData;
+  expectedData->DeepCopy(stats->GetOutput(vtkStatisticsAlgorithm::OUTPUT_DATA));
+
+  stats->ComputeInParallelOn();
+  stats->Update();
+  vtkMultiBlockDataSet *outputModel = vtkMultiBlockDataSet::SafeDownCast(
+    stats->GetOutputDataObject(vtkStatisticsAlgorithm::OUTPUT_MODEL));
+  if (expectedModel->GetNumberOfBlocks() != outputModel->GetNumberOfBlocks())
+    {
+    cerr << what << ": different numbers of models" << endl;
+    return false;
+    }
+  for (unsigned int b = 0; b < expectedModel->GetNumberOfBlocks(); ++b)
+    {
+    if (!SameTables(vtkTable::SafeDownCast(expectedModel->GetBlock(b)),
+                    vtkTable::SafeDownCast(outputModel->GetBlock(b)), what))
+      {
+      return false;
+      }
+    }
+  return SameTables(expectedData.GetPointer(),
+                    stats->GetOutput(vtkStatisticsAlgorithm::OUTPUT_DATA), what);
+}
+
+}
+
+int TestMultiCorrelativeStatisticsParallel(int, char *[])
+{
+  vtkMath::RandomSeed(2015);
+
+  // Correlated metrics with a large offset, stored as double, float and int
+  const vtkIdType nVals = 100000;
+  vtkNew<vtkDoubleArray> m0;
+  m0->SetName("Metric 0");
+  vtkNew<vtkFloatArray> m1;
+  m1->SetName("Metric 1");
+  vtkNew<vtkIntArray> m2;
+  m2->SetName("Metric 2");
+  vtkNew<vtkDoubleArray> m3;
+  m3->SetName("Metric 3");
+  for (vtkIdType i = 0; i < nVals; ++i)
+    {
+    double x = vtkMath::Gaussian(1000.0, 2.0);
+    double y = vtkMath::Gaussian();
+    m0->InsertNextValue(x);
+    m1->InsertNextValue(static_cast<float>(0.5 * x + y));
+    m2->InsertNextValue(static_cast<int>(floor(10.0 * y)));
+    m3->InsertNextValue(x - 3.0 * y + vtkMath::Gaussian());
+    }
+  vtkNew<vtkTable> inputData;
+  inputData->AddColumn(m0.GetPointer());
+  inputData->AddColumn(m1.GetPointer());
+  inputData->AddColumn(m2.GetPointer());
+  inputData->AddColumn(m3.GetPointer());
+
+  vtkNew<vtkMultiCorrelativeStatistics> mcs;
+  vtkNew<vtkPCAStatistics> pcas;
+  vtkMultiCorrelativeStatistics *algorithms[2] = { mcs.GetPointer(), pcas.GetPointer() };
+  for (int a = 0; a < 2; ++a)
+    {
+    vtkMultiCorrelativeStatistics *stats = algorithms[a];
+    stats->SetInputData(vtkStatisticsAlgorithm::INPUT_DATA, inputData.GetPointer());
+    stats->SetColumnStatus("Metric 0", 1);
+    stats->SetColumnStatus("Metric 1", 1);
+    stats->SetColumnStatus("Metric 2", 1);
+    stats->RequestSelectedColumns();
+    stats->ResetAllColumnStates();
+    stats->SetColumnStatus("Metric 0", 1);
+    stats->SetColumnStatus("Metric 3", 1);
+    stats->RequestSelectedColumns();
+    stats->SetLearnOption(true);
+    stats->SetDeriveOption(true);
+    stats->SetAssessOption(true);
+    stats->SetTestOption(false);
+    }
+
+  if (!Check(mcs.GetPointer(), "multicorrelative statistics") ||
+      !Check(pcas.GetPointer(), "PCA statistics"))
+    {
+    return EXIT_FAILURE;
+    }
+  pcas->SetBasisScheme(vtkPCAStatistics::FIXED_BASIS_SIZE);
+  pcas->SetFixedBasisSize(2);
+  if (!Check(pcas.GetPointer(), "PCA statistics on a partial basis"))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,242 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStatisticsSketches.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the accuracy and the merging of vtkQuantileSketch and
+// vtkCardinalitySketch, and the quartiles of vtkOrderStatistics when its
+// histograms are replaced by sketches, in one pass and in streaming mode.
+
+#include "vtkCardinalitySketch.h"
+#include "vtkDoubleArray.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkOrderStatistics.h"
+#include "vtkQuantileSketch.h"
+#include "vtkStatisticsAlgorithm.h"
+#include "vtkStdString.h"
+#include "vtkStreamingStatistics.h"
+#include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+
+// Rank of x among sorted values, as a fraction of their number
+double Rank(const std::vector<double>& sorted, double x)
+{
+  return static_cast<double>(std::lower_bound(sorted.begin(), sorted.end(), x)
+                             - sorted.begin()) / sorted.size();
+}
+
+bool TestQuantileSketch()
+{
+  const int n = 100000;
+  vtkMath::RandomSeed(1234);
+  std::vector<double> values(n);
+  vtkNew<vtkQuantileSketch> sketch;
+  vtkNew<vtkQuantileSketch> halves[2];
+  for (int i = 0; i < n; ++i)
+    {
+    values[i] = vtkMath::Gaussian(10.0, 3.0);
+    sketch->AddValue(values[i]);
+    halves[i % 2]->AddValue(values[i]);
+    }
+  std::vector<double> sorted(values);
+  std::sort(sorted.begin(), sorted.end());
+
+  halves[0]->Merge(halves[1].GetPointer());
+  vtkQuantileSketch* sketches[2] = { sketch.GetPointer(), halves[0].GetPointer() };
+  for (int s = 0; s < 2; ++s)
+    {
+    if (sketches[s]->GetTotalWeight() != n)
+      {
+      cerr << "Wrong total weight " << sketches[s]->GetTotalWeight() << endl;
+      return false;
+      }
+    if (sketches[s]->GetNumberOfCentroids() > 2 * sketches[s]->GetCompression() + 2)
+      {
+      cerr << "Too many centroids: " << sketches[s]->GetNumberOfCentroids() << endl;
+      return false;
+      }
+    if (sketches[s]->GetQuantile(0.0) != sorted.front() ||
+        sketches[s]->GetQuantile(1.0) != sorted.back())
+      {
+      cerr << "Extrema are not exact" << endl;
+      return false;
+      }
+    const double qs[] = { 0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999 };
+    for (int i = 0; i < 9; ++i)
+      {
+      double rank = Rank(sorted, sketches[s]->GetQuantile(qs[i]));
+      if (fabs(rank - qs[i]) > 0.01)
+        {
+        cerr << "Quantile " << qs[i] << " has rank " << rank << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool TestCardinalitySketch()
+{
+  const int n = 200000;
+  vtkNew<vtkCardinalitySketch> numbers;
+  vtkNew<vtkCardinalitySketch> halves[2];
+  vtkNew<vtkCardinalitySketch> strings;
+  for (int i = 0; i < n; ++i)
+    {
+    // Every value is added twice, once as an int and once as a double
+    numbers->AddValue(static_cast<double>(i));
+    numbers->AddValue(static_cast<double>(static_cast<float>(i)));
+    halves[i % 2]->AddValue(static_cast<double>(i));
+    if (i < 5000)
+      {
+      std::ostringstream s;
+      s << "value" << i;
+      strings->AddValue(vtkStdString(s.str()));
+      strings->AddValue(vtkStdString(s.str()));
+      }
+    }
+
+  double estimate = numbers->GetEstimate();
+  if (fabs(estimate - n) > 0.05 * n)
+    {
+    cerr << "Distinct numbers estimated to " << estimate << endl;
+    return false;
+    }
+  estimate = strings->GetEstimate();
+  if (fabs(estimate - 5000) > 0.05 * 5000)
+    {
+    cerr << "Distinct strings estimated to " << estimate << endl;
+    return false;
+    }
+
+  if (!halves[0]->Merge(halves[1].GetPointer()) ||
+      halves[0]->GetEstimate() != numbers->GetEstimate())
+    {
+    cerr << "Merged sketch differs from the whole one" << endl;
+    return false;
+    }
+
+  vtkNew<vtkUnsignedCharArray> registers;
+  numbers->GetRegisters(registers.GetPointer());
+  vtkNew<vtkCardinalitySketch> copy;
+  if (!copy->SetRegisters(registers.GetPointer()) ||
+      copy->GetEstimate() != numbers->GetEstimate())
+    {
+    cerr << "Registers do not round-trip" << endl;
+    return false;
+    }
+  copy->SetPrecision(10);
+  if (copy->Merge(numbers.GetPointer()) || copy->GetEstimate() != 0.0)
+    {
+    cerr << "Sketches of different precisions were merged" << endl;
+    return false;
+    }
+  return true;
+}
+
+vtkTable* MakeTable(int n, int offset)
+{
+  vtkDoubleArray* values = vtkDoubleArray::New();
+  values->SetName("Values");
+  for (int i = 0; i < n; ++i)
+    {
+    // Many distinct values, distributed as sqrt of uniform ones
+    values->InsertNextValue(sqrt((i + offset) * 0.618034 -
+                                 floor((i + offset) * 0.618034)));
+    }
+  vtkTable* table = vtkTable::New();
+  table->AddColumn(values);
+  values->Delete();
+  return table;
+}
+
+bool CheckQuartiles(vtkMultiBlockDataSet* model, const char* what,
+                    vtkIdType maxRows)
+{
+  vtkTable* histogram = vtkTable::SafeDownCast(model->GetBlock(0));
+  unsigned int nBlocks = model->GetNumberOfBlocks();
+  vtkTable* quantiles = vtkTable::SafeDownCast(model->GetBlock(nBlocks - 1));
+  if (!histogram || !quantiles || histogram->GetNumberOfRows() > maxRows)
+    {
+    cerr << what << ": histogram is missing or too large" << endl;
+    return false;
+    }
+
+  // Quantiles of sqrt(U) are sqrt(q)
+  for (vtkIdType r = 0; r < quantiles->GetNumberOfRows(); ++r)
+    {
+    double q = static_cast<double>(r) / (quantiles->GetNumberOfRows() - 1);
+    double x = quantiles->GetValueByName(r, "Values").ToDouble();
+    if (fabs(x - sqrt(q)) > 0.025)
+      {
+      cerr << what << ": quantile " << q << " is " << x << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+bool TestOrderStatisticsSketch()
+{
+  const int n = 50000;
+  vtkTable* table = MakeTable(n, 0);
+  vtkNew<vtkOrderStatistics> os;
+  os->SetInputData(vtkStatisticsAlgorithm::INPUT_DATA, table);
+  os->AddColumn("Values");
+  os->SetUseSketch(true);
+  os->Update();
+  table->Delete();
+  if (!CheckQuartiles(vtkMultiBlockDataSet::SafeDownCast(
+        os->GetOutputDataObject(vtkStatisticsAlgorithm::OUTPUT_MODEL)),
+                      "order statistics", 1000))
+    {
+    return false;
+    }
+
+  vtkNew<vtkOrderStatistics> streamed;
+  streamed->AddColumn("Values");
+  streamed->SetUseSketch(true);
+  vtkNew<vtkStreamingStatistics> streaming;
+  streaming->SetStatisticsAlgorithm(streamed.GetPointer());
+  for (int chunk = 0; chunk < 10; ++chunk)
+    {
+    table = MakeTable(n / 10, chunk * n / 10);
+    streaming->SetInputData(table);
+    streaming->Update();
+    table->Delete();
+    }
+  return CheckQuartiles(vtkMultiBlockDataSet::SafeDownCast(
+    streaming->GetOutputDataObject(vtkStreamingStatistics::OUTPUT_MODEL)),
+                        "streaming statistics", 1000);
+}
+
+}
+
+int TestStatisticsSketches(int, char *[])
+{
+  if (!TestQuantileSketch() || !TestCardinalitySketch() ||
+      !TestOrderStatisticsSketch())
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
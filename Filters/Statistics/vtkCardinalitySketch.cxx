@@ -0,0 +1,232 @@
+/*=========================================================================
+
+Program:   Visualization Toolkit
+Module:    vtkCardinalitySketch.cxx
+
+Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+All rights reserved.
+See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCardinalitySketch.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkStdString.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkVariant.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+vtkStandardNewMacro(vtkCardinalitySketch);
+
+namespace
+{
+
+inline vtkTypeUInt64 MakeUInt64( vtkTypeUInt32 high, vtkTypeUInt32 low )
+{
+  return ( static_cast<vtkTypeUInt64>( high ) << 32 ) | low;
+}
+
+// Finalizer of the SplitMix64 generator, which spreads the bits of its
+// argument over the whole result.
+inline vtkTypeUInt64 Mix( vtkTypeUInt64 z )
+{
+  z ^= z >> 30;
+  z *= MakeUInt64( 0xbf58476dU, 0x1ce4e5b9U );
+  z ^= z >> 27;
+  z *= MakeUInt64( 0x94d049bbU, 0x133111ebU );
+  z ^= z >> 31;
+  return z;
+}
+
+}
+
+// ----------------------------------------------------------------------
+vtkCardinalitySketch::vtkCardinalitySketch()
+{
+  this->Precision = 12;
+  this->Registers = new unsigned char[1 << this->Precision];
+  this->Initialize();
+}
+
+// ----------------------------------------------------------------------
+vtkCardinalitySketch::~vtkCardinalitySketch()
+{
+  delete [] this->Registers;
+}
+
+// ----------------------------------------------------------------------
+void vtkCardinalitySketch::PrintSelf( ostream &os, vtkIndent indent )
+{
+  this->Superclass::PrintSelf( os, indent );
+  os << indent << "Precision: " << this->Precision << endl;
+}
+
+// ----------------------------------------------------------------------
+void vtkCardinalitySketch::SetPrecision( int precision )
+{
+  precision = std::max( 4, std::min( 18, precision ) );
+  if ( precision == this->Precision )
+    {
+    return;
+    }
+
+  this->Precision = precision;
+  delete [] this->Registers;
+  this->Registers = new unsigned char[1 << this->Precision];
+  this->Initialize();
+  this->Modified();
+}
+
+// ----------------------------------------------------------------------
+void vtkCardinalitySketch::Initialize()
+{
+  memset( this->Registers, 0, static_cast<size_t>( 1 ) << this->Precision );
+}
+
+// ----------------------------------------------------------------------
+void vtkCardinalitySketch::AddValue( double x )
+{
+  // Equal numbers must hash equally whatever their bits
+  if ( x == 0. )
+    {
+    x = 0.;
+    }
+  vtkTypeUInt64 bits;
+  memcpy( &bits, &x, sizeof( bits ) );
+  this->AddHash( Mix( bits ) );
+}
+
+// ----------------------------------------------------------------------
+void vtkCardinalitySketch::AddValue( const vtkStdString& s )
+{
+  // 64 bits FNV-1a, mixed since its high bits are poorly distributed
+  vtkTypeUInt64 h = MakeUInt64( 0xcbf29ce4U, 0x84222325U );
+  const vtkTypeUInt64 prime = MakeUInt64( 0x00000100U, 0x000001b3U );
+  for ( size_t i = 0; i < s.size(); ++ i )
+    {
+    h ^= static_cast<unsigned char>( s[i] );
+    h *= prime;
+    }
+  this->AddHash( Mix( h ) );
+}
+
+// ----------------------------------------------------------------------
+void vtkCardinalitySketch::AddValue( const vtkVariant& v )
+{
+  if ( v.IsNumeric() )
+    {
+    this->AddValue( v.ToDouble() );
+    }
+  else
+    {
+    this->AddValue( v.ToString() );
+    }
+}
+
+// ----------------------------------------------------------------------
+void vtkCardinalitySketch::AddHash( vtkTypeUInt64 hash )
+{
+  int p = this->Precision;
+  vtkTypeUInt64 index = hash >> ( 64 - p );
+  vtkTypeUInt64 rest = hash << p;
+
+  // Position of the first set bit among the 64 - p remaining ones
+  unsigned char rank = 1;
+  while ( rank <= 64 - p && ! ( rest & MakeUInt64( 0x80000000U, 0U ) ) )
+    {
+    rest <<= 1;
+    ++ rank;
+    }
+  unsigned char& reg = this->Registers[index];
+  reg = std::max( reg, rank );
+}
+
+// ----------------------------------------------------------------------
+bool vtkCardinalitySketch::Merge( vtkCardinalitySketch* other )
+{
+  if ( ! other || other->Precision != this->Precision )
+    {
+    return false;
+    }
+
+  int m = 1 << this->Precision;
+  for ( int i = 0; i < m; ++ i )
+    {
+    this->Registers[i] = std::max( this->Registers[i], other->Registers[i] );
+    }
+  return true;
+}
+
+// ----------------------------------------------------------------------
+double vtkCardinalitySketch::GetEstimate()
+{
+  int m = 1 << this->Precision;
+  double sum = 0.;
+  int zeros = 0;
+  for ( int i = 0; i < m; ++ i )
+    {
+    sum += ldexp( 1., - this->Registers[i] );
+    zeros += ( this->Registers[i] == 0 ) ? 1 : 0;
+    }
+
+  double alpha;
+  switch ( m )
+    {
+    case 16:
+      alpha = .673;
+      break;
+    case 32:
+      alpha = .697;
+      break;
+    case 64:
+      alpha = .709;
+      break;
+    default:
+      alpha = .7213 / ( 1. + 1.079 / m );
+      break;
+    }
+  double estimate = alpha * m * m / sum;
+
+  // Linear counting is more accurate for small cardinalities. With 64 bits
+  // hashes no correction is needed for large ones.
+  if ( estimate <= 2.5 * m && zeros )
+    {
+    estimate = m * log( static_cast<double>( m ) / zeros );
+    }
+  return estimate;
+}
+
+// ----------------------------------------------------------------------
+void vtkCardinalitySketch::GetRegisters( vtkUnsignedCharArray* registers )
+{
+  if ( ! registers )
+    {
+    return;
+    }
+
+  int m = 1 << this->Precision;
+  registers->SetNumberOfComponents( 1 );
+  registers->SetNumberOfTuples( m );
+  memcpy( registers->GetPointer( 0 ), this->Registers, m );
+}
+
+// ----------------------------------------------------------------------
+bool vtkCardinalitySketch::SetRegisters( vtkUnsignedCharArray* registers )
+{
+  int m = 1 << this->Precision;
+  if ( ! registers || registers->GetNumberOfTuples() != m
+       || registers->GetNumberOfComponents() != 1 )
+    {
+    return false;
+    }
+
+  memcpy( this->Registers, registers->GetPointer( 0 ), m );
+  return true;
+}
@@ -0,0 +1,98 @@
+/*=========================================================================
+
+Program:   Visualization Toolkit
+Module:    vtkCardinalitySketch.h
+
+Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+All rights reserved.
+See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkCardinalitySketch - A mergeable estimate of the number of distinct values
+//
+// .SECTION Description
+// vtkCardinalitySketch estimates the number of distinct values of a stream
+// with a HyperLogLog sketch: each value is hashed to 64 bits, the first
+// Precision bits select one of 2^Precision registers, and the register
+// keeps the largest number of leading zeros seen in the remaining bits.
+// The relative standard error of the estimate is about
+// 1.04/sqrt(2^Precision), i.e. 1.6% with the default precision of 12,
+// for 4 KiB of registers whatever the number of values.
+//
+// Two sketches of the same precision are merged by taking the maximum of
+// their registers, which can also be done on the arrays returned by
+// GetRegisters() with a maximum reduction across processes.
+//
+// .SECTION See Also
+// vtkQuantileSketch vtkContingencyStatistics
+
+#ifndef vtkCardinalitySketch_h
+#define vtkCardinalitySketch_h
+
+#include "vtkFiltersStatisticsModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkStdString;
+class vtkUnsignedCharArray;
+class vtkVariant;
+
+class VTKFILTERSSTATISTICS_EXPORT vtkCardinalitySketch : public vtkObject
+{
+public:
+  vtkTypeMacro(vtkCardinalitySketch, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+  static vtkCardinalitySketch* New();
+
+  // Description:
+  // Set/Get the number of bits used to select the registers, between 4 and
+  // 18. Setting it clears the sketch. Default is 12.
+  virtual void SetPrecision( int );
+  vtkGetMacro( Precision, int );
+
+  // Description:
+  // Remove all the values from the sketch.
+  void Initialize();
+
+  // Description:
+  // Add a value. Numbers are hashed from their value as a double, so that
+  // the same number stored in arrays of different types is counted once.
+  void AddValue( double x );
+  void AddValue( const vtkStdString& s );
+  void AddValue( const vtkVariant& v );
+
+  // Description:
+  // Add a value from its 64 bits hash, which must be uniformly distributed.
+  void AddHash( vtkTypeUInt64 hash );
+
+  // Description:
+  // Merge another sketch of the same precision into this one.
+  // Returns false if the precisions differ.
+  bool Merge( vtkCardinalitySketch* other );
+
+  // Description:
+  // Estimate the number of distinct values added to the sketch.
+  double GetEstimate();
+
+  // Description:
+  // Copy the registers to an array, or replace them by the values of an
+  // array of 2^Precision values, e.g. after a reduction across processes.
+  void GetRegisters( vtkUnsignedCharArray* registers );
+  bool SetRegisters( vtkUnsignedCharArray* registers );
+
+protected:
+  vtkCardinalitySketch();
+  ~vtkCardinalitySketch();
+
+  int Precision;
+  unsigned char* Registers;
+
+private:
+  vtkCardinalitySketch(const vtkCardinalitySketch&); // Not implemented
+  void operator=(const vtkCardinalitySketch&);   // Not implemented
+};
+
+#endif
@@ -41,6 +41,8 @@ vtkComputeQuartiles::vtkComputeQuartiles()
     vtkDataObject::FIELD_ASSOCIATION_POINTS_THEN_CELLS,
     vtkDataSetAttributes::SCALARS);
   this->FieldAssociation = -1;
+  this->UseSketch = false;
+  this->SketchCompression = 100.;
 }
 
 //-----------------------------------------------------------------------------
@@ -52,6 +54,8 @@ vtkComputeQuartiles::~vtkComputeQuartiles()
 void vtkComputeQuartiles::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+  os << indent << "UseSketch: " << this->UseSketch << endl;
+  os << indent << "SketchCompression: " << this->SketchCompression << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -163,6 +167,8 @@ void vtkComputeQuartiles::ComputeTable(vtkDataObject* input,
   vtkNew<vtkTable> inDescStats;
   vtkNew<vtkOrderStatistics> os;
   os->SetInputData(vtkStatisticsAlgorithm::INPUT_DATA, inDescStats.GetPointer());
+  os->SetUseSketch(this->UseSketch);
+  os->SetSketchCompression(this->SketchCompression);
 
   for (int i = 0; i < field->GetNumberOfArrays(); i++)
     {
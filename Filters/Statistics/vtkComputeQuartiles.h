@@ -47,6 +47,21 @@ public:
   vtkTypeMacro(vtkComputeQuartiles, vtkTableAlgorithm);
   void PrintSelf(ostream& os, vtkIndent indent);
 
+  // Description:
+  // Set/Get whether the quartiles are estimated from a bounded size sketch
+  // of each array instead of its exact histogram, which is much faster and
+  // lighter on arrays with many distinct values.
+  // See vtkOrderStatistics::SetUseSketch(). Default is false.
+  vtkSetMacro(UseSketch, bool);
+  vtkGetMacro(UseSketch, bool);
+  vtkBooleanMacro(UseSketch, bool);
+
+  // Description:
+  // Set/Get the compression of the sketches, when UseSketch is on.
+  // Default is 100.
+  vtkSetMacro(SketchCompression, double);
+  vtkGetMacro(SketchCompression, double);
+
 protected:
   vtkComputeQuartiles();
   ~vtkComputeQuartiles();
@@ -60,6 +75,8 @@ protected:
   void ComputeTable(vtkDataObject*, vtkTable*, vtkIdType);
 
   int FieldAssociation;
+  bool UseSketch;
+  double SketchCompression;
 
 private:
   void operator=(const vtkComputeQuartiles&); // Not implemented
@@ -12,7 +12,8 @@ public:
   vtkKMeansAssessFunctor() { }
   virtual ~vtkKMeansAssessFunctor();
   virtual void operator () ( vtkDoubleArray* result, vtkIdType row );
-  bool Initialize( vtkTable *inData, vtkTable *reqModel, vtkKMeansDistanceFunctor *distFunc );
+  bool Initialize( vtkTable *inData, vtkTable *reqModel, vtkKMeansDistanceFunctor *distFunc,
+                   bool inParallel = false );
   int GetNumberOfRuns() { return NumRuns; }
 };
 
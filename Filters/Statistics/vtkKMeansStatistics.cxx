@@ -13,7 +13,10 @@
 #include "vtkVariantArray.h"
 #include "vtkIntArray.h"
 #include "vtkIdTypeArray.h"
+#include "vtkSMPTools.h"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <vector>
 #include <sstream>
@@ -21,6 +24,188 @@
 vtkStandardNewMacro(vtkKMeansStatistics);
 vtkCxxSetObjectMacro(vtkKMeansStatistics,DistanceFunctor,vtkKMeansDistanceFunctor);
 
+namespace
+{
+
+// Squared Euclidean distance between two points with contiguous coordinates,
+// as computed by the default distance functor.
+inline double SquaredDistance( const double* a, const double* b, vtkIdType dim )
+{
+  double d = 0.;
+  for ( vtkIdType i = 0; i < dim; ++ i )
+    {
+    double t = a[i] - b[i];
+    d += t * t;
+    }
+  return d;
+}
+
+// Index of the closest of the centers [begin,end), the first one winning ties
+// as in the generic path.
+inline vtkIdType ClosestCenter( const double* x, const double* centers,
+                                vtkIdType begin, vtkIdType end, vtkIdType dim,
+                                double& minDistance )
+{
+  vtkIdType closest = begin;
+  minDistance = SquaredDistance( centers + begin * dim, x, dim );
+  for ( vtkIdType j = begin + 1; j < end; ++ j )
+    {
+    double d = SquaredDistance( centers + j * dim, x, dim );
+    if ( d < minDistance )
+      {
+      minDistance = d;
+      closest = j;
+      }
+    }
+  return closest;
+}
+
+// Whether the numeric path applies: the distances must be those of the default
+// functor, and all the columns single component data arrays.
+bool CanUseNumericPath( vtkKMeansDistanceFunctor* dfunc, vtkTable* table,
+                        vtkIdType firstCol = 0 )
+{
+  if ( ! dfunc || strcmp( dfunc->GetClassName(), "vtkKMeansDistanceFunctor" ) )
+    {
+    return false;
+    }
+  for ( vtkIdType c = firstCol; c < table->GetNumberOfColumns(); ++ c )
+    {
+    vtkDataArray* col = vtkDataArray::SafeDownCast( table->GetColumn( c ) );
+    if ( ! col || col->GetNumberOfComponents() != 1 )
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Copy the columns of a table, from firstCol on, into a row-major matrix.
+void GatherColumns( vtkTable* table, vtkIdType firstCol, std::vector<double>& matrix )
+{
+  vtkIdType dim = table->GetNumberOfColumns() - firstCol;
+  vtkIdType nRow = table->GetNumberOfRows();
+  matrix.resize( nRow * dim );
+  for ( vtkIdType c = 0; c < dim; ++ c )
+    {
+    vtkDataArray* col = vtkDataArray::SafeDownCast( table->GetColumn( firstCol + c ) );
+    for ( vtkIdType r = 0; r < nRow; ++ r )
+      {
+      matrix[r * dim + c] = col->GetTuple1( r );
+      }
+    }
+}
+
+// Assign the observations of blocks [begin,end) to their closest center for all
+// the runs still computed, and accumulate per block the membership changes of
+// each run and the cardinality, error and coordinate sums of each center.
+class vtkKMeansAssignFunctor
+{
+public:
+  const double* Data;
+  vtkIdType NumberOfObservations;
+  vtkIdType Dimension;
+  vtkIdType BlockSize;
+  const double* Centers;
+  vtkIdType NumberOfCenters;
+  int NumberOfRuns;
+  const vtkIdType* StartRunID;
+  const vtkIdType* EndRunID;
+  const int* ComputeRun;
+  vtkIdType* ClusterMemberID;
+
+  // Partial results, indexed by block first
+  vtkIdType* Changes;
+  vtkIdType* Counts;
+  double* Errors;
+  double* Sums;
+
+  void operator()( vtkIdType begin, vtkIdType end ) const
+  {
+    vtkIdType dim = this->Dimension;
+    vtkIdType nCenters = this->NumberOfCenters;
+    for ( vtkIdType block = begin; block < end; ++ block )
+      {
+      vtkIdType* changes = this->Changes + block * this->NumberOfRuns;
+      vtkIdType* counts = this->Counts + block * nCenters;
+      double* errors = this->Errors + block * nCenters;
+      double* sums = this->Sums + block * nCenters * dim;
+      std::fill( changes, changes + this->NumberOfRuns, 0 );
+      std::fill( counts, counts + nCenters, 0 );
+      std::fill( errors, errors + nCenters, 0. );
+      std::fill( sums, sums + nCenters * dim, 0. );
+
+      vtkIdType last = std::min( ( block + 1 ) * this->BlockSize,
+                                 this->NumberOfObservations );
+      for ( vtkIdType obs = block * this->BlockSize; obs < last; ++ obs )
+        {
+        const double* x = this->Data + obs * dim;
+        for ( int runID = 0; runID < this->NumberOfRuns; ++ runID )
+          {
+          if ( ! this->ComputeRun[runID]
+               || this->StartRunID[runID] >= this->EndRunID[runID] )
+            {
+            continue;
+            }
+          double minDistance;
+          vtkIdType j = ClosestCenter( x, this->Centers, this->StartRunID[runID],
+                                       this->EndRunID[runID], dim, minDistance );
+          vtkIdType localMemberID = j - this->StartRunID[runID];
+          vtkIdType& memberID = this->ClusterMemberID[obs * this->NumberOfRuns + runID];
+          if ( memberID != localMemberID )
+            {
+            ++ changes[runID];
+            memberID = localMemberID;
+            }
+          ++ counts[j];
+          errors[j] += minDistance;
+          double* sum = sums + j * dim;
+          for ( vtkIdType c = 0; c < dim; ++ c )
+            {
+            sum[c] += x[c];
+            }
+          }
+        }
+      }
+  }
+};
+
+// Find the closest center of each observation of [begin,end) for all runs.
+class vtkKMeansAssessNumericFunctor
+{
+public:
+  const double* Data;
+  vtkIdType Dimension;
+  const double* Centers;
+  int NumberOfRuns;
+  const vtkIdType* StartRunID;
+  const vtkIdType* EndRunID;
+  double* Distances;
+  vtkIdType* ClusterMemberIDs;
+
+  void operator()( vtkIdType begin, vtkIdType end ) const
+  {
+    for ( vtkIdType obs = begin; obs < end; ++ obs )
+      {
+      const double* x = this->Data + obs * this->Dimension;
+      for ( int runID = 0; runID < this->NumberOfRuns; ++ runID )
+        {
+        if ( this->StartRunID[runID] >= this->EndRunID[runID] )
+          {
+          continue;
+          }
+        double minDistance;
+        vtkIdType j = ClosestCenter( x, this->Centers, this->StartRunID[runID],
+                                     this->EndRunID[runID], this->Dimension, minDistance );
+        this->ClusterMemberIDs[obs * this->NumberOfRuns + runID] = j - this->StartRunID[runID];
+        this->Distances[obs * this->NumberOfRuns + runID] = minDistance;
+        }
+      }
+  }
+};
+
+}
+
 // ----------------------------------------------------------------------
 vtkKMeansStatistics::vtkKMeansStatistics()
 {
@@ -32,6 +217,7 @@ vtkKMeansStatistics::vtkKMeansStatistics()
   this->KValuesArrayName = 0;
   this->SetKValuesArrayName( "K" );
   this->MaxNumIterations = 50;
+  this->ClusterInParallel = 0;
   this->DistanceFunctor = vtkKMeansDistanceFunctor::New();
 }
 
@@ -53,6 +239,7 @@ void vtkKMeansStatistics::PrintSelf( ostream& os, vtkIndent indent )
                << "\"\n";
   os << indent << "MaxNumIterations: " << this->MaxNumIterations << endl;
   os << indent << "Tolerance: " << this->Tolerance << endl;
+  os << indent << "ClusterInParallel: " << this->ClusterInParallel << endl;
   os << indent << "DistanceFunctor: " << this->DistanceFunctor << endl;
 }
 
@@ -382,6 +569,36 @@ void vtkKMeansStatistics::Learn( vtkTable* inData,
   clusterMemberID->FillComponent( 0, -1 );
 
 
+  // Gather the observations once when the numeric path applies, and split them into
+  // a bounded number of fixed blocks, whose partial sums are added in order
+  vtkIdType dim = dataElements->GetNumberOfColumns();
+  bool numericPath = this->ClusterInParallel &&
+    dim == curClusterElements->GetNumberOfColumns() &&
+    CanUseNumericPath( this->DistanceFunctor, dataElements ) &&
+    CanUseNumericPath( this->DistanceFunctor, newClusterElements );
+  std::vector<double> dataMatrix;
+  std::vector<double> centers;
+  std::vector<vtkIdType> blockChanges;
+  std::vector<vtkIdType> blockCounts;
+  std::vector<double> blockErrors;
+  std::vector<double> blockSums;
+  vtkIdType blockSize = 1;
+  vtkIdType numBlocks = 0;
+  if ( numericPath )
+    {
+    GatherColumns( dataElements, 0, dataMatrix );
+    vtkIdType maxBlocks = std::max( static_cast<vtkIdType>( 1 ),
+                                    std::min( static_cast<vtkIdType>( 256 ),
+                                              ( 1 << 24 ) / ( numToAllocate * dim + 1 ) ) );
+    blockSize = std::max( static_cast<vtkIdType>( 1024 ),
+                          ( numObservations + maxBlocks - 1 ) / maxBlocks );
+    numBlocks = ( numObservations + blockSize - 1 ) / blockSize;
+    blockChanges.resize( numBlocks * numRuns );
+    blockCounts.resize( numBlocks * numToAllocate );
+    blockErrors.resize( numBlocks * numToAllocate );
+    blockSums.resize( numBlocks * numToAllocate * dim );
+    }
+
   // Iterate until new cluster centers have converged OR we have reached a max number of iterations
   do
     {
@@ -402,60 +619,129 @@ void vtkKMeansStatistics::Learn( vtkTable* inData,
         }
       }
 
-    // Find minimum distance between each observation and each cluster center,
-    // then assign the observation to the nearest cluster.
-    vtkIdType localMemberID, offsetLocalMemberID;
-    double minDistance, curDistance;
-    for ( vtkIdType observation = 0; observation < dataElements->GetNumberOfRows(); observation++ )
+    if ( numericPath )
       {
-      for( int runID = 0; runID < numRuns; runID++)
+      // Assign the observations by blocks in parallel, then add the partial
+      // results of the blocks in order
+      GatherColumns( curClusterElements, 0, centers );
+      vtkKMeansAssignFunctor assign;
+      assign.Data = numObservations ? &dataMatrix[0] : 0;
+      assign.NumberOfObservations = numObservations;
+      assign.Dimension = dim;
+      assign.BlockSize = blockSize;
+      assign.Centers = &centers[0];
+      assign.NumberOfCenters = numToAllocate;
+      assign.NumberOfRuns = numRuns;
+      assign.StartRunID = startRunID->GetPointer( 0 );
+      assign.EndRunID = endRunID->GetPointer( 0 );
+      assign.ComputeRun = computeRun->GetPointer( 0 );
+      assign.ClusterMemberID = clusterMemberID->GetPointer( 0 );
+      assign.Changes = numBlocks ? &blockChanges[0] : 0;
+      assign.Counts = numBlocks ? &blockCounts[0] : 0;
+      assign.Errors = numBlocks ? &blockErrors[0] : 0;
+      assign.Sums = numBlocks ? &blockSums[0] : 0;
+      vtkSMPTools::For( 0, numBlocks, 1, assign );
+
+      std::vector<double> sum( dim );
+      for ( int runID = 0; runID < numRuns; ++ runID )
         {
-        if(computeRun->GetValue( runID ))
+        if ( ! computeRun->GetValue( runID ) )
+          {
+          continue;
+          }
+        vtkIdType numChanges = 0;
+        for ( vtkIdType b = 0; b < numBlocks; ++ b )
+          {
+          numChanges += blockChanges[b * numRuns + runID];
+          }
+        numMembershipChanges->SetValue( runID, numChanges );
+
+        for ( vtkIdType j = startRunID->GetValue( runID ); j < endRunID->GetValue( runID ); ++ j )
           {
-          vtkIdType runStartIdx = startRunID->GetValue( runID );
-          vtkIdType runEndIdx = endRunID->GetValue( runID );
-          if ( runStartIdx >= runEndIdx )
+          vtkIdType cardinality = 0;
+          double err = 0.;
+          std::fill( sum.begin(), sum.end(), 0. );
+          for ( vtkIdType b = 0; b < numBlocks; ++ b )
             {
-            continue;
+            cardinality += blockCounts[b * numToAllocate + j];
+            err += blockErrors[b * numToAllocate + j];
+            const double* blockSum = &blockSums[( b * numToAllocate + j ) * dim];
+            for ( vtkIdType c = 0; c < dim; ++ c )
+              {
+              sum[c] += blockSum[c];
+              }
             }
-          vtkIdType j = runStartIdx;
-          localMemberID = 0;
-          offsetLocalMemberID = runStartIdx;
-          (*this->DistanceFunctor)( minDistance,
-            curClusterElements->GetRow( j ),
-            dataElements->GetRow( observation ) );
-          curDistance = minDistance;
-          ++ j;
-          for( /* no init */; j < runEndIdx; j ++ )
+          numDataElementsInCluster->SetValue( j, cardinality );
+          error->SetValue( j, err );
+          if ( cardinality )
             {
-            (*this->DistanceFunctor)( curDistance,
-              curClusterElements->GetRow( j ),
-              dataElements->GetRow( observation ) );
-            if( curDistance < minDistance )
+            for ( vtkIdType c = 0; c < dim; ++ c )
               {
-              minDistance = curDistance;
-              localMemberID = j - runStartIdx;
-              offsetLocalMemberID = j;
+              vtkDataArray::SafeDownCast( newClusterElements->GetColumn( c ) )
+                ->SetTuple1( j, sum[c] / cardinality );
               }
             }
-          // We've located the nearest cluster center. Has it changed since the last iteration?
-          if ( clusterMemberID->GetValue( observation*numRuns+runID) != localMemberID )
+          }
+        }
+      }
+    else
+      {
+      // Find minimum distance between each observation and each cluster center,
+      // then assign the observation to the nearest cluster.
+      vtkIdType localMemberID, offsetLocalMemberID;
+      double minDistance, curDistance;
+      for ( vtkIdType observation = 0; observation < dataElements->GetNumberOfRows(); observation++ )
+        {
+        for( int runID = 0; runID < numRuns; runID++)
+          {
+          if(computeRun->GetValue( runID ))
             {
-            numMembershipChanges->SetValue( runID, numMembershipChanges->GetValue( runID ) + 1 );
-            clusterMemberID->SetValue( observation*numRuns+runID, localMemberID );
+            vtkIdType runStartIdx = startRunID->GetValue( runID );
+            vtkIdType runEndIdx = endRunID->GetValue( runID );
+            if ( runStartIdx >= runEndIdx )
+              {
+              continue;
+              }
+            vtkIdType j = runStartIdx;
+            localMemberID = 0;
+            offsetLocalMemberID = runStartIdx;
+            (*this->DistanceFunctor)( minDistance,
+              curClusterElements->GetRow( j ),
+              dataElements->GetRow( observation ) );
+            curDistance = minDistance;
+            ++ j;
+            for( /* no init */; j < runEndIdx; j ++ )
+              {
+              (*this->DistanceFunctor)( curDistance,
+                curClusterElements->GetRow( j ),
+                dataElements->GetRow( observation ) );
+              if( curDistance < minDistance )
+                {
+                minDistance = curDistance;
+                localMemberID = j - runStartIdx;
+                offsetLocalMemberID = j;
+                }
+              }
+            // We've located the nearest cluster center. Has it changed since the last iteration?
+            if ( clusterMemberID->GetValue( observation*numRuns+runID) != localMemberID )
+              {
+              numMembershipChanges->SetValue( runID, numMembershipChanges->GetValue( runID ) + 1 );
+              clusterMemberID->SetValue( observation*numRuns+runID, localMemberID );
+              }
+            // Give the distance functor a chance to modify any derived quantities used to
+            // change the cluster centers between iterations, now that we know which cluster
+            // center the observation is assigned to.
+            vtkIdType newCardinality = numDataElementsInCluster->GetValue( offsetLocalMemberID ) + 1;
+            numDataElementsInCluster->SetValue( offsetLocalMemberID, newCardinality );
+            this->DistanceFunctor->PairwiseUpdate( newClusterElements, offsetLocalMemberID,
+              dataElements->GetRow( observation ), 1, newCardinality );
+            // Update the error for this cluster center to account for this observation.
+            error->SetValue( offsetLocalMemberID, error->GetValue( offsetLocalMemberID ) + minDistance );
             }
-          // Give the distance functor a chance to modify any derived quantities used to
-          // change the cluster centers between iterations, now that we know which cluster
-          // center the observation is assigned to.
-          vtkIdType newCardinality = numDataElementsInCluster->GetValue( offsetLocalMemberID ) + 1;
-          numDataElementsInCluster->SetValue( offsetLocalMemberID, newCardinality );
-          this->DistanceFunctor->PairwiseUpdate( newClusterElements, offsetLocalMemberID,
-            dataElements->GetRow( observation ), 1, newCardinality );
-          // Update the error for this cluster center to account for this observation.
-          error->SetValue( offsetLocalMemberID, error->GetValue( offsetLocalMemberID ) + minDistance );
           }
         }
       }
+
     // update cluster centers
     this->UpdateClusterCenters( newClusterElements, curClusterElements, numMembershipChanges,
                                 numDataElementsInCluster, error, startRunID, endRunID, computeRun );
@@ -692,14 +978,19 @@ void vtkKMeansStatistics::Assess( vtkTable* inData,
       }
     }
 
-  // Assess each entry of the column
+  // Assess each entry of the column, writing directly into the columns just added
+  std::vector<vtkDataArray*> assessColumns( nv * numRuns );
+  for ( vtkIdType j = 0; j < nv * numRuns; ++ j )
+    {
+    assessColumns[j] = vtkDataArray::SafeDownCast( outData->GetColumnByName( names[j] ) );
+    }
   vtkDoubleArray* assessResult = vtkDoubleArray::New();
   for ( vtkIdType r = 0; r < nRow; ++ r )
     {
     (*dfunc)( assessResult, r );
     for ( vtkIdType j = 0; j < nv * numRuns; ++ j )
       {
-      outData->SetValueByName( r, names[j], assessResult->GetValue( j ) );
+      assessColumns[j]->SetTuple1( r, assessResult->GetValue( j ) );
       }
     }
   assessResult->Delete();
@@ -731,7 +1022,8 @@ void vtkKMeansStatistics::SelectAssessFunctor( vtkTable* inData,
 
   vtkKMeansAssessFunctor* kmfunc = vtkKMeansAssessFunctor::New();
 
-  if ( ! kmfunc->Initialize( inData, reqModel, this->DistanceFunctor ) )
+  if ( ! kmfunc->Initialize( inData, reqModel, this->DistanceFunctor,
+                             this->ClusterInParallel != 0 ) )
     {
     delete kmfunc;
     return;
@@ -755,7 +1047,8 @@ vtkKMeansAssessFunctor::~vtkKMeansAssessFunctor()
 // ----------------------------------------------------------------------
 bool vtkKMeansAssessFunctor::Initialize( vtkTable* inData,
                                          vtkTable* inModel,
-                                         vtkKMeansDistanceFunctor* dfunc )
+                                         vtkKMeansDistanceFunctor* dfunc,
+                                         bool inParallel )
 {
   vtkIdType numObservations = inData->GetNumberOfRows();
   vtkTable* dataElements = vtkTable::New();
@@ -787,36 +1080,60 @@ bool vtkKMeansAssessFunctor::Initialize( vtkTable* inData,
   this->Distances->SetNumberOfValues( numObservations * this->NumRuns );
   this->ClusterMemberIDs->SetNumberOfValues( numObservations * this->NumRuns );
 
-  // find minimum distance between each data object and cluster center
-  for ( vtkIdType observation = 0; observation < numObservations; ++ observation )
+  if ( inParallel && numObservations && this->NumRuns
+       && dataElements->GetNumberOfColumns() == curClusterElements->GetNumberOfColumns()
+       && CanUseNumericPath( dfunc, dataElements )
+       && CanUseNumericPath( dfunc, curClusterElements ) )
     {
-    for( int runID = 0; runID < this->NumRuns; ++ runID )
+    std::vector<double> dataMatrix;
+    std::vector<double> centers;
+    GatherColumns( dataElements, 0, dataMatrix );
+    GatherColumns( curClusterElements, 0, centers );
+
+    vtkKMeansAssessNumericFunctor assess;
+    assess.Data = &dataMatrix[0];
+    assess.Dimension = dataElements->GetNumberOfColumns();
+    assess.Centers = centers.empty() ? 0 : &centers[0];
+    assess.NumberOfRuns = this->NumRuns;
+    assess.StartRunID = startRunID->GetPointer( 0 );
+    assess.EndRunID = endRunID->GetPointer( 0 );
+    assess.Distances = this->Distances->GetPointer( 0 );
+    assess.ClusterMemberIDs = this->ClusterMemberIDs->GetPointer( 0 );
+    vtkSMPTools::For( 0, numObservations, assess );
+    }
+  else
+    {
+    // find minimum distance between each data object and cluster center
+    for ( vtkIdType observation = 0; observation < numObservations; ++ observation )
       {
-      vtkIdType runStartIdx = startRunID->GetValue( runID );
-      vtkIdType runEndIdx = endRunID->GetValue( runID );
-      if ( runStartIdx >= runEndIdx )
-        {
-        continue;
-        }
-      // Find the closest cluster center to the observation across all centers in the runID-th run.
-      vtkIdType j = runStartIdx;
-      double minDistance;
-      double curDistance;
-      (*dfunc)( minDistance, curClusterElements->GetRow( j ), dataElements->GetRow( observation ) );
-      vtkIdType localMemberID = 0;
-      for( /* no init */; j < runEndIdx; ++ j )
+      for( int runID = 0; runID < this->NumRuns; ++ runID )
         {
-        (*dfunc)( curDistance, curClusterElements->GetRow( j ), dataElements->GetRow( observation ) );
-        if ( curDistance < minDistance )
+        vtkIdType runStartIdx = startRunID->GetValue( runID );
+        vtkIdType runEndIdx = endRunID->GetValue( runID );
+        if ( runStartIdx >= runEndIdx )
+          {
+          continue;
+          }
+        // Find the closest cluster center to the observation across all centers in the runID-th run.
+        vtkIdType j = runStartIdx;
+        double minDistance;
+        double curDistance;
+        (*dfunc)( minDistance, curClusterElements->GetRow( j ), dataElements->GetRow( observation ) );
+        vtkIdType localMemberID = 0;
+        for( /* no init */; j < runEndIdx; ++ j )
           {
-          minDistance = curDistance;
-          localMemberID = j - runStartIdx;
+          (*dfunc)( curDistance, curClusterElements->GetRow( j ), dataElements->GetRow( observation ) );
+          if ( curDistance < minDistance )
+            {
+            minDistance = curDistance;
+            localMemberID = j - runStartIdx;
+            }
           }
+        this->ClusterMemberIDs->SetValue( observation * this->NumRuns + runID, localMemberID );
+        this->Distances->SetValue( observation * this->NumRuns + runID, minDistance );
         }
-      this->ClusterMemberIDs->SetValue( observation * this->NumRuns + runID, localMemberID );
-      this->Distances->SetValue( observation * this->NumRuns + runID, minDistance );
       }
-   }
+    }
 
   dataElements->Delete();
   curClusterElements->Delete();
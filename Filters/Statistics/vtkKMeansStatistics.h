@@ -85,6 +85,14 @@ PURPOSE.  See the above copyright notice for more information.
 // computes the sum of the squares of the Euclidean distance between two objects is provided
 // (vtkKMeansDistanceFunctor). The default distance functor can be overridden to use alternative distance metrics.
 //
+// When ClusterInParallel is on, the default distance functor is used and all the
+// requested columns are numeric, the observations are copied once into a contiguous
+// matrix of doubles and the assignment of observations to cluster centers, as well as
+// the accumulation of the new centers, are done by several threads with vtkSMPTools.
+// Partial sums are accumulated over fixed blocks of observations and added in order,
+// so that the result does not depend on the number of threads. Distributed runs keep
+// combining the local centers through UpdateClusterCenters.
+//
 // .SECTION Thanks
 // Thanks to Janine Bennett, David Thompson, and Philippe Pebay of
 // Sandia National Laboratories for implementing this class.
@@ -136,6 +144,15 @@ public:
   vtkSetMacro( Tolerance, double );
   vtkGetMacro( Tolerance, double );
 
+  // Description:
+  // Set/get whether the Learn and Assess options use the multithreaded path for
+  // numeric columns described above. Otherwise, or when the path does not apply,
+  // distances are evaluated one observation at a time by the distance functor.
+  // Default is 0.
+  vtkSetMacro( ClusterInParallel, int );
+  vtkGetMacro( ClusterInParallel, int );
+  vtkBooleanMacro( ClusterInParallel, int );
+
   // Description:
   // Given a collection of models, calculate aggregate model
   // NB: not implemented
@@ -241,6 +258,9 @@ protected:
   // This is the percentage of data elements that swap cluster IDs
   double Tolerance;
   // Description:
+  // Whether to use the multithreaded path for numeric columns.
+  int ClusterInParallel;
+  // Description:
   // This is the Distance functor.  The default is Euclidean distance, however this can be overridden.
   vtkKMeansDistanceFunctor* DistanceFunctor;
 
@@ -11,11 +11,14 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOrderStatistics.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStatisticsAlgorithmPrivate.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <sstream>
@@ -34,6 +37,7 @@ vtkMultiCorrelativeStatistics::vtkMultiCorrelativeStatistics()
   this->AssessNames->SetNumberOfValues( 1 );
   this->AssessNames->SetValue( 0, "d^2" ); // Squared Mahalanobis distance
   this->MedianAbsoluteDeviation = false;
+  this->ComputeInParallel = false;
 }
 
 // ----------------------------------------------------------------------
@@ -45,6 +49,8 @@ vtkMultiCorrelativeStatistics::~vtkMultiCorrelativeStatistics()
 void vtkMultiCorrelativeStatistics::PrintSelf( ostream& os, vtkIndent indent )
 {
   this->Superclass::PrintSelf( os, indent );
+  os << indent << "MedianAbsoluteDeviation: " << this->MedianAbsoluteDeviation << endl;
+  os << indent << "ComputeInParallel: " << this->ComputeInParallel << endl;
 }
 
 // ----------------------------------------------------------------------
@@ -108,17 +114,23 @@ static void vtkMultiCorrelativeTransposeTriangular( std::vector<double>& a, vtkI
 
 // ----------------------------------------------------------------------
 void vtkMultiCorrelativeAssessFunctor::operator () ( vtkDoubleArray* result, vtkIdType row )
+{
+  result->SetNumberOfValues( 1 );
+  this->Evaluate( row, &this->Tuple[0], result->GetPointer( 0 ) );
+}
+
+// ----------------------------------------------------------------------
+void vtkMultiCorrelativeAssessFunctor::Evaluate( vtkIdType row, double* x, double* result ) const
 {
   vtkIdType m = static_cast<vtkIdType>( this->Columns.size() );
   vtkIdType i, j;
-  this->Tuple = this->EmptyTuple; // initialize Tuple to 0.0
-  double* x = &this->Tuple[0];
+  std::fill( x, x + m, 0. ); // initialize tuple to 0.0
   double* y;
-  double* ci = &this->Factor[0];
+  const double* ci = &this->Factor[0];
   double v;
   for ( i = 0; i < m; ++ i )
     {
-    v = this->Columns[i]->GetTuple( row )[0] - this->Center[i];
+    v = this->Columns[i]->GetComponent( row, 0 ) - this->Center[i];
     y = x + i;
     for ( j = i; j < m; ++ j, ++ ci, ++ y )
       {
@@ -132,10 +144,240 @@ void vtkMultiCorrelativeAssessFunctor::operator () ( vtkDoubleArray* result, vtk
     r += (*y) * (*y);
     }
 
-  result->SetNumberOfValues( 1 );
   // To report cumulance values instead of relative deviation, use this:
-  // result->SetValue( 0, exp( -0.5 * r ) * pow( 0.5 * r, 0.5 * m - 2.0 ) * ( 0.5 * ( r + m ) - 1.0 ) / this->Normalization );
-  result->SetValue( 0, r );
+  // result[0] = exp( -0.5 * r ) * pow( 0.5 * r, 0.5 * m - 2.0 ) * ( 0.5 * ( r + m ) - 1.0 ) / this->Normalization;
+  result[0] = r;
+}
+
+// ----------------------------------------------------------------------
+// Copy the first component of rows [begin,end) of a column into a buffer.
+template <typename T>
+static void vtkMultiCorrelativeGather( const T* values, int nComp,
+                                       vtkIdType begin, vtkIdType end, double* out )
+{
+  for ( vtkIdType i = begin; i < end; ++ i, ++ out )
+    {
+    *out = static_cast<double>( values[i * nComp] );
+    }
+}
+
+// ----------------------------------------------------------------------
+// Cardinality, means and centered sums of products of pairs of columns for a
+// set of rows, as stored in the primary statistics column by Learn.
+class vtkMultiCorrelativeMoments
+{
+public:
+  double N;
+  std::vector<double> Mean;
+  std::vector<double> Comoment;
+
+  void Initialize( vtkIdType m, vtkIdType nPairs )
+  {
+    this->N = 0.;
+    this->Mean.assign( m, 0. );
+    this->Comoment.assign( nPairs, 0. );
+  }
+
+  // Add the moments of another set of rows, with the pairwise update formulas
+  // from Philippe's SAND2008-6212 report
+  void Combine( const vtkMultiCorrelativeMoments& other,
+                const std::vector<vtkIdType>& pairU,
+                const std::vector<vtkIdType>& pairV )
+  {
+    if ( other.N == 0. )
+      {
+      return;
+      }
+    if ( this->N == 0. )
+      {
+      *this = other;
+      return;
+      }
+    double n = this->N + other.N;
+    double prodFactor = this->N * other.N / n;
+    vtkIdType m = static_cast<vtkIdType>( this->Mean.size() );
+    std::vector<double> delta( m );
+    for ( vtkIdType j = 0; j < m; ++ j )
+      {
+      delta[j] = other.Mean[j] - this->Mean[j];
+      }
+    for ( size_t p = 0; p < this->Comoment.size(); ++ p )
+      {
+      this->Comoment[p] += other.Comoment[p]
+        + delta[pairU[p]] * delta[pairV[p]] * prodFactor;
+      }
+    for ( vtkIdType j = 0; j < m; ++ j )
+      {
+      this->Mean[j] += delta[j] * other.N / n;
+      }
+    this->N = n;
+  }
+};
+
+// ----------------------------------------------------------------------
+// Compute the moments of blocks of rows. Each block is processed by chunks
+// whose values are gathered into contiguous centered columns, so that the sums
+// of products are plain dot products.
+class vtkMultiCorrelativeMomentsFunctor
+{
+public:
+  const std::vector<vtkDataArray*>* Columns;
+  std::vector<void*> Pointers;
+  const std::vector<vtkIdType>* PairU;
+  const std::vector<vtkIdType>* PairV;
+  vtkIdType NumberOfRows;
+  vtkIdType BlockSize;
+  std::vector<vtkMultiCorrelativeMoments>* Blocks;
+
+  void operator()( vtkIdType begin, vtkIdType end ) const
+  {
+    const vtkIdType chunkSize = 1024;
+    vtkIdType m = static_cast<vtkIdType>( this->Columns->size() );
+    std::vector<double> values( m * chunkSize );
+    vtkMultiCorrelativeMoments chunk;
+    for ( vtkIdType b = begin; b < end; ++ b )
+      {
+      vtkMultiCorrelativeMoments& block = ( *this->Blocks )[b];
+      block.Initialize( m, static_cast<vtkIdType>( this->PairU->size() ) );
+      vtkIdType last = std::min( ( b + 1 ) * this->BlockSize, this->NumberOfRows );
+      for ( vtkIdType first = b * this->BlockSize; first < last; first += chunkSize )
+        {
+        vtkIdType n = std::min( chunkSize, last - first );
+        chunk.Initialize( m, static_cast<vtkIdType>( this->PairU->size() ) );
+        chunk.N = static_cast<double>( n );
+        for ( vtkIdType j = 0; j < m; ++ j )
+          {
+          vtkDataArray* col = ( *this->Columns )[j];
+          double* x = &values[j * chunkSize];
+          switch ( this->Pointers[j] ? col->GetDataType() : VTK_VOID )
+            {
+            vtkTemplateMacro( vtkMultiCorrelativeGather(
+              static_cast<VTK_TT*>( this->Pointers[j] ),
+              col->GetNumberOfComponents(), first, first + n, x ) );
+            default:
+              for ( vtkIdType i = 0; i < n; ++ i )
+                {
+                x[i] = col->GetComponent( first + i, 0 );
+                }
+            }
+          double sum = 0.;
+          for ( vtkIdType i = 0; i < n; ++ i )
+            {
+            sum += x[i];
+            }
+          double mean = sum / n;
+          for ( vtkIdType i = 0; i < n; ++ i )
+            {
+            x[i] -= mean;
+            }
+          chunk.Mean[j] = mean;
+          }
+        for ( size_t p = 0; p < this->PairU->size(); ++ p )
+          {
+          const double* u = &values[( *this->PairU )[p] * chunkSize];
+          const double* v = &values[( *this->PairV )[p] * chunkSize];
+          double dot = 0.;
+          for ( vtkIdType i = 0; i < n; ++ i )
+            {
+            dot += u[i] * v[i];
+            }
+          chunk.Comoment[p] = dot;
+          }
+        block.Combine( chunk, *this->PairU, *this->PairV );
+        }
+      }
+  }
+};
+
+// ----------------------------------------------------------------------
+// Compute the means and centered sums of products of all rows with several
+// threads, storing them as Learn does. Blocks are combined pairwise in a fixed
+// order so that the result does not depend on the number of threads.
+static void vtkMultiCorrelativeParallelMoments( std::vector<vtkDataArray*>& colPtrs,
+                                                const std::vector<vtkIdType>& pairU,
+                                                const std::vector<vtkIdType>& pairV,
+                                                vtkIdType nRow,
+                                                double* rv )
+{
+  vtkIdType m = static_cast<vtkIdType>( colPtrs.size() );
+  vtkIdType nPairs = static_cast<vtkIdType>( pairU.size() );
+  if ( ! nRow )
+    {
+    return;
+    }
+
+  // Bound the number of blocks, and therefore the memory used by their moments
+  vtkIdType maxBlocks = std::max( static_cast<vtkIdType>( 1 ),
+                                  std::min( static_cast<vtkIdType>( 1024 ),
+                                            ( 1 << 24 ) / ( m + nPairs + 1 ) ) );
+  vtkIdType blockSize = std::max( static_cast<vtkIdType>( 4096 ),
+                                  ( nRow + maxBlocks - 1 ) / maxBlocks );
+  vtkIdType nBlocks = ( nRow + blockSize - 1 ) / blockSize;
+  std::vector<vtkMultiCorrelativeMoments> blocks( nBlocks );
+
+  vtkMultiCorrelativeMomentsFunctor functor;
+  functor.Columns = &colPtrs;
+  for ( vtkIdType j = 0; j < m; ++ j )
+    {
+    // Values are read directly from arrays with a standard memory layout
+    vtkDataArray* col = colPtrs[j];
+    functor.Pointers.push_back( col->HasStandardMemoryLayout() ?
+                                col->GetVoidPointer( 0 ) : 0 );
+    }
+  functor.PairU = &pairU;
+  functor.PairV = &pairV;
+  functor.NumberOfRows = nRow;
+  functor.BlockSize = blockSize;
+  functor.Blocks = &blocks;
+  vtkSMPTools::For( 0, nBlocks, 1, functor );
+
+  // Pairwise reduction of the blocks
+  for ( vtkIdType stride = 1; stride < nBlocks; stride *= 2 )
+    {
+    for ( vtkIdType b = 0; b + stride < nBlocks; b += 2 * stride )
+      {
+      blocks[b].Combine( blocks[b + stride], pairU, pairV );
+      }
+    }
+
+  std::copy( blocks[0].Mean.begin(), blocks[0].Mean.end(), rv );
+  std::copy( blocks[0].Comoment.begin(), blocks[0].Comoment.end(), rv + m );
+}
+
+// ----------------------------------------------------------------------
+// Assess rows [begin,end) with a thread safe assessment functor.
+class vtkMultiCorrelativeAssessRows
+{
+public:
+  const vtkMultiCorrelativeAssessFunctor* Functor;
+  std::vector<double*> Results;
+  vtkSMPThreadLocal<std::vector<double> > Tuple;
+
+  void operator()( vtkIdType begin, vtkIdType end )
+  {
+    std::vector<double>& tuple = this->Tuple.Local();
+    tuple.resize( this->Functor->Columns.size() + 1 );
+    int nv = this->Functor->GetNumberOfResults();
+    std::vector<double> result( nv );
+    for ( vtkIdType r = begin; r < end; ++ r )
+      {
+      this->Functor->Evaluate( r, &tuple[0], nv ? &result[0] : 0 );
+      for ( int v = 0; v < nv; ++ v )
+        {
+        this->Results[v][r] = result[v];
+        }
+      }
+  }
+};
+
+// ----------------------------------------------------------------------
+void vtkMultiCorrelativeAssessFunctor::EvaluateInParallel( const std::vector<double*>& results,
+                                                           vtkIdType nRow ) const
+{
+  vtkMultiCorrelativeAssessRows rows;
+  rows.Functor = this;
+  rows.Results = results;
+  vtkSMPTools::For( 0, nRow, rows );
 }
 
 // ----------------------------------------------------------------------
@@ -447,6 +689,17 @@ void vtkMultiCorrelativeStatistics::Learn( vtkTable* inData,
       *x = MADTable->GetValue(1, l+1).ToDouble();
       }
     }
+  else if ( this->ComputeInParallel )
+    {
+    std::vector<vtkIdType> pairU;
+    std::vector<vtkIdType> pairV;
+    for ( cpIt = colPairs.begin(); cpIt != colPairs.end(); ++ cpIt )
+      {
+      pairU.push_back( cpIt->first.first );
+      pairV.push_back( cpIt->first.second );
+      }
+    vtkMultiCorrelativeParallelMoments( colPtrs, pairU, pairV, nRow, rv );
+    }
   else
     {
     // Iterate over rows
@@ -708,6 +961,7 @@ void vtkMultiCorrelativeStatistics::Assess( vtkTable* inData,
     // Create the outData columns
     int nv = this->AssessNames->GetNumberOfValues();
     vtkStdString* names = new vtkStdString[nv];
+    std::vector<double*> results;
     for ( int v = 0; v < nv; ++ v )
       {
       std::ostringstream assessColName;
@@ -730,21 +984,28 @@ void vtkMultiCorrelativeStatistics::Assess( vtkTable* inData,
       assessValues->SetNumberOfTuples( nRow );
       outData->AddColumn( assessValues );
       assessValues->Delete();
+      results.push_back( assessValues->GetPointer( 0 ) );
       }
 
     // Assess each entry of the column
-    vtkDoubleArray* assessResult = vtkDoubleArray::New();
-    for ( vtkIdType r = 0; r < nRow; ++ r )
+    if ( this->ComputeInParallel && mcfunc->GetNumberOfResults() == nv )
       {
-      (*dfunc)( assessResult, r );
-      for ( int v = 0; v < nv; ++ v )
+      mcfunc->EvaluateInParallel( results, nRow );
+      }
+    else
+      {
+      vtkDoubleArray* assessResult = vtkDoubleArray::New();
+      for ( vtkIdType r = 0; r < nRow; ++ r )
         {
-        outData->SetValueByName( r, names[v], assessResult->GetValue( v ) );
+        (*dfunc)( assessResult, r );
+        for ( int v = 0; v < nv; ++ v )
+          {
+          outData->SetValueByName( r, names[v], assessResult->GetValue( v ) );
+          }
         }
+      assessResult->Delete();
       }
 
-    assessResult->Delete();
-
     delete dfunc;
     delete [] names;
     }
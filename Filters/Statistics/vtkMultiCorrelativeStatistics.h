@@ -66,6 +66,12 @@ PURPOSE.  See the above copyright notice for more information.
 //   deviation of each observation in port INPUT_DATA's table according to the linear
 //   correlations implied by each table in port INPUT_MODEL.
 //
+// When ComputeInParallel is on, Learn splits the rows into a bounded number of
+// blocks whose means and centered sums of products are computed by several
+// threads with vtkSMPTools from typed column values, then combined pairwise with
+// the same update formulas as Aggregate. Assess then evaluates the rows with
+// several threads too.
+//
 // .SECTION Thanks
 // Thanks to Philippe Pebay, Jackson Mayo, and David Thompson of
 // Sandia National Laboratories for implementing this class.
@@ -103,6 +109,15 @@ public:
   vtkGetMacro( MedianAbsoluteDeviation, bool );
   vtkBooleanMacro( MedianAbsoluteDeviation, bool );
 
+  // Description:
+  // If set to true, the covariance sums of Learn and the assessment of each row
+  // are computed with several threads. The sums then differ from the serial ones
+  // by rounding only. Not used for the Median Absolute Deviation matrix.
+  // Default is false.
+  vtkSetMacro( ComputeInParallel, bool );
+  vtkGetMacro( ComputeInParallel, bool );
+  vtkBooleanMacro( ComputeInParallel, bool );
+
 protected:
   vtkMultiCorrelativeStatistics();
   ~vtkMultiCorrelativeStatistics();
@@ -148,6 +163,7 @@ protected:
   virtual vtkOrderStatistics* CreateOrderStatisticsInstance();
 
   bool MedianAbsoluteDeviation;
+  bool ComputeInParallel;
 
 private:
   vtkMultiCorrelativeStatistics( const vtkMultiCorrelativeStatistics& ); // Not implemented
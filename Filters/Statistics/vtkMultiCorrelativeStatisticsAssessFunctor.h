@@ -25,6 +25,15 @@ public:
 
   virtual void operator () ( vtkDoubleArray* result, vtkIdType row );
 
+  // Number of values assessed per row, and thread safe evaluation of them for
+  // one row, given scratch space for GetNumberOfColumns() values.
+  virtual int GetNumberOfResults() const { return 1; }
+  virtual void Evaluate( vtkIdType row, double* tuple, double* result ) const;
+
+  // Evaluate rows [0,nRow) with several threads, storing the v-th result of
+  // each row into results[v].
+  void EvaluateInParallel( const std::vector<double*>& results, vtkIdType nRow ) const;
+
   vtkIdType GetNumberOfColumns() { return static_cast<vtkIdType>( this->Columns.size() ); }
   vtkDataArray* GetColumn( vtkIdType colIdx ) { return this->Columns[colIdx]; }
 
@@ -22,6 +22,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkOrderStatistics.h"
 #include "vtkStatisticsAlgorithmPrivate.h"
 
+#include "vtkDataObjectCollection.h"
 #include "vtkDoubleArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
@@ -29,6 +30,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkObjectFactory.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkQuantileSketch.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariantArray.h"
@@ -40,6 +42,97 @@ PURPOSE.  See the above copyright notice for more information.
 
 vtkStandardNewMacro(vtkOrderStatistics);
 
+namespace
+{
+
+// Typed access to the values of histogram tables
+inline double HistogramValue( vtkDataArray* vals, vtkIdType r )
+{
+  return vals->GetTuple1( r );
+}
+
+inline vtkStdString HistogramValue( vtkStringArray* vals, vtkIdType r )
+{
+  return vals->GetValue( r );
+}
+
+inline vtkVariant HistogramValue( vtkVariantArray* vals, vtkIdType r )
+{
+  return vals->GetValue( r );
+}
+
+// Sum the cardinalities of a histogram table into a histogram
+template <typename TArray, typename TValue>
+bool AccumulateHistogram( vtkTable* histogramTab,
+                          std::map<TValue,vtkIdType>& histogram )
+{
+  TArray* vals = TArray::SafeDownCast( histogramTab->GetColumnByName( "Value" ) );
+  vtkIdTypeArray* card = vtkIdTypeArray::SafeDownCast( histogramTab->GetColumnByName( "Cardinality" ) );
+  if ( ! vals || ! card )
+    {
+    return false;
+    }
+
+  for ( vtkIdType r = 0; r < histogramTab->GetNumberOfRows(); ++ r )
+    {
+    histogram[HistogramValue( vals, r )] += card->GetValue( r );
+    }
+  return true;
+}
+
+// Create a histogram table with a value column of the given type
+vtkTable* NewHistogramTable( vtkAbstractArray* valueCol )
+{
+  vtkTable* histogramTab = vtkTable::New();
+  valueCol->SetName( "Value" );
+  histogramTab->AddColumn( valueCol );
+  valueCol->Delete();
+
+  vtkIdTypeArray* idTypeCol = vtkIdTypeArray::New();
+  idTypeCol->SetName( "Cardinality" );
+  histogramTab->AddColumn( idTypeCol );
+  idTypeCol->Delete();
+
+  return histogramTab;
+}
+
+// Store a histogram into a histogram table
+template <typename TValue>
+void StoreHistogram( const std::map<TValue,vtkIdType>& histogram,
+                     vtkTable* histogramTab )
+{
+  vtkVariantArray* row = vtkVariantArray::New();
+  row->SetNumberOfValues( 2 );
+  for ( typename std::map<TValue,vtkIdType>::const_iterator mit = histogram.begin();
+        mit != histogram.end(); ++ mit  )
+    {
+    row->SetValue( 0, mit->first );
+    row->SetValue( 1, mit->second );
+    histogramTab->InsertNextRow( row );
+    }
+  row->Delete();
+}
+
+// Store the centroids of a sketch into a histogram table
+void StoreSketch( vtkQuantileSketch* sketch, vtkTable* histogramTab )
+{
+  vtkDataArray* vals = vtkDataArray::SafeDownCast( histogramTab->GetColumnByName( "Value" ) );
+  vtkIdTypeArray* card = vtkIdTypeArray::SafeDownCast( histogramTab->GetColumnByName( "Cardinality" ) );
+  vtkIdType nCentroids = sketch->GetNumberOfCentroids();
+  vals->SetNumberOfTuples( nCentroids );
+  card->SetNumberOfTuples( nCentroids );
+  for ( vtkIdType i = 0; i < nCentroids; ++ i )
+    {
+    double mean;
+    vtkIdType weight;
+    sketch->GetCentroid( i, mean, weight );
+    vals->SetTuple1( i, mean );
+    card->SetValue( i, weight );
+    }
+}
+
+}
+
 // ----------------------------------------------------------------------
 vtkOrderStatistics::vtkOrderStatistics()
 {
@@ -47,6 +140,8 @@ vtkOrderStatistics::vtkOrderStatistics()
   this->NumberOfIntervals = 4; // By default, calculate 5-points statistics
   this->Quantize = false; // By default, do not force quantization
   this->MaximumHistogramSize = 1000; // A large value by default
+  this->UseSketch = false; // By default, keep exact histograms
+  this->SketchCompression = 100.;
   // Number of primary tables is variable
   this->NumberOfPrimaryTables = -1;
 
@@ -67,6 +162,8 @@ void vtkOrderStatistics::PrintSelf( ostream &os, vtkIndent indent )
   os << indent << "QuantileDefinition: " << this->QuantileDefinition << endl;
   os << indent << "Quantize: " << this->Quantize << endl;
   os << indent << "MaximumHistogramSize: " << this->MaximumHistogramSize << endl;
+  os << indent << "UseSketch: " << this->UseSketch << endl;
+  os << indent << "SketchCompression: " << this->SketchCompression << endl;
 }
 
 // ----------------------------------------------------------------------
@@ -191,7 +288,22 @@ void vtkOrderStatistics::Learn( vtkTable* inData,
     idTypeCol->Delete();
 
     // Switch depending on data type
-    if ( vals->IsA("vtkDataArray") )
+    if ( vals->IsA("vtkDataArray") && this->UseSketch )
+      {
+      // Downcast column to data array for efficient data access
+      vtkDataArray* dvals = vtkDataArray::SafeDownCast( vals );
+
+      // Summarize the values by a sketch instead of an exact histogram
+      vtkQuantileSketch* sketch = vtkQuantileSketch::New();
+      sketch->SetCompression( this->SketchCompression );
+      for ( vtkIdType r = 0; r < nRow; ++ r )
+        {
+        sketch->AddValue( dvals->GetTuple1( r ) );
+        }
+      StoreSketch( sketch, histogramTab );
+      sketch->Delete();
+      } // if ( vals->IsA("vtkDataArray") && this->UseSketch )
+    else if ( vals->IsA("vtkDataArray") )
       {
       // Downcast column to data array for efficient data access
       vtkDataArray* dvals = vtkDataArray::SafeDownCast( vals );
@@ -310,6 +422,143 @@ void vtkOrderStatistics::Learn( vtkTable* inData,
   return;
 }
 
+// ----------------------------------------------------------------------
+void vtkOrderStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
+                                    vtkMultiBlockDataSet* outMeta )
+{
+  if ( ! inMetaColl || ! outMeta )
+    {
+    return;
+    }
+
+  // Collect the histogram tables of each variable, skipping the tables
+  // appended by Derive
+  std::vector<vtkStdString> varNames;
+  std::map<vtkStdString,std::vector<vtkTable*> > histogramTabs;
+  vtkCollectionSimpleIterator it;
+  inMetaColl->InitTraversal( it );
+  while ( vtkDataObject* inMetaDO = inMetaColl->GetNextDataObject( it ) )
+    {
+    vtkMultiBlockDataSet* inMeta = vtkMultiBlockDataSet::SafeDownCast( inMetaDO );
+    if ( ! inMeta )
+      {
+      return;
+      }
+
+    for ( unsigned int b = 0; b < inMeta->GetNumberOfBlocks(); ++ b )
+      {
+      vtkTable* histogramTab = vtkTable::SafeDownCast( inMeta->GetBlock( b ) );
+      if ( ! histogramTab || ! inMeta->HasMetaData( b ) )
+        {
+        continue;
+        }
+
+      vtkStdString varName = inMeta->GetMetaData( b )->Get( vtkCompositeDataSet::NAME() );
+      if ( varName == "Cardinalities" || varName == "Quantiles" )
+        {
+        continue;
+        }
+
+      if ( histogramTabs.find( varName ) == histogramTabs.end() )
+        {
+        varNames.push_back( varName );
+        }
+      histogramTabs[varName].push_back( histogramTab );
+      }
+    }
+
+  // Calculate all aggregated histograms before replacing the output model,
+  // which may be one of the input ones
+  std::vector<vtkTable*> aggregatedTabs;
+  for ( std::vector<vtkStdString>::iterator vit = varNames.begin();
+        vit != varNames.end(); ++ vit )
+    {
+    std::vector<vtkTable*>& tabs = histogramTabs[*vit];
+    vtkAbstractArray* vals = tabs[0]->GetColumnByName( "Value" );
+    vtkTable* aggregatedTab = 0;
+    bool ok = true;
+
+    if ( vals && vals->IsA("vtkDataArray") )
+      {
+      std::map<double,vtkIdType> histogram;
+      for ( size_t t = 0; t < tabs.size(); ++ t )
+        {
+        ok = ok && AccumulateHistogram<vtkDataArray>( tabs[t], histogram );
+        }
+
+      aggregatedTab = NewHistogramTable( vtkDoubleArray::New() );
+      if ( this->UseSketch )
+        {
+        vtkQuantileSketch* sketch = vtkQuantileSketch::New();
+        sketch->SetCompression( this->SketchCompression );
+        for ( std::map<double,vtkIdType>::iterator mit = histogram.begin();
+              mit != histogram.end(); ++ mit )
+          {
+          sketch->AddValue( mit->first, mit->second );
+          }
+        StoreSketch( sketch, aggregatedTab );
+        sketch->Delete();
+        }
+      else
+        {
+        StoreHistogram( histogram, aggregatedTab );
+        }
+      }
+    else if ( vals && vals->IsA("vtkStringArray") )
+      {
+      std::map<vtkStdString,vtkIdType> histogram;
+      for ( size_t t = 0; t < tabs.size(); ++ t )
+        {
+        ok = ok && AccumulateHistogram<vtkStringArray>( tabs[t], histogram );
+        }
+      aggregatedTab = NewHistogramTable( vtkStringArray::New() );
+      StoreHistogram( histogram, aggregatedTab );
+      }
+    else if ( vals && vals->IsA("vtkVariantArray") )
+      {
+      std::map<vtkVariant,vtkIdType> histogram;
+      for ( size_t t = 0; t < tabs.size(); ++ t )
+        {
+        ok = ok && AccumulateHistogram<vtkVariantArray>( tabs[t], histogram );
+        }
+      aggregatedTab = NewHistogramTable( vtkVariantArray::New() );
+      StoreHistogram( histogram, aggregatedTab );
+      }
+    else
+      {
+      ok = false;
+      }
+
+    if ( ! ok )
+      {
+      vtkWarningMacro( "Histograms of variable "
+                       << vit->c_str()
+                       << " do not match. Cannot aggregate models." );
+      if ( aggregatedTab )
+        {
+        aggregatedTab->Delete();
+        }
+      for ( size_t t = 0; t < aggregatedTabs.size(); ++ t )
+        {
+        aggregatedTabs[t]->Delete();
+        }
+      return;
+      }
+    aggregatedTabs.push_back( aggregatedTab );
+    }
+
+  // Replace the output model by the aggregated histograms
+  unsigned int nBlocks = static_cast<unsigned int>( aggregatedTabs.size() );
+  outMeta->SetNumberOfBlocks( 0 );
+  outMeta->SetNumberOfBlocks( nBlocks );
+  for ( unsigned int b = 0; b < nBlocks; ++ b )
+    {
+    outMeta->GetMetaData( b )->Set( vtkCompositeDataSet::NAME(), varNames[b] );
+    outMeta->SetBlock( b, aggregatedTabs[b] );
+    aggregatedTabs[b]->Delete();
+    }
+}
+
 // ----------------------------------------------------------------------
 void vtkOrderStatistics::Derive( vtkMultiBlockDataSet* inMeta )
 {
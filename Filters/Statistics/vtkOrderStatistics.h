@@ -32,6 +32,12 @@ PURPOSE.  See the above copyright notice for more information.
 // * Test: calculate Kolmogorov-Smirnov goodness-of-fit statistic between CDF based on
 //   model quantiles, and empirical CDF
 //
+// When UseSketch is on, the histograms of numeric variables are replaced by
+// the centroids of a vtkQuantileSketch, so that the size of the model does
+// not grow with the number of distinct values, and models learned from
+// successive pieces of data can be aggregated, e.g. by vtkStreamingStatistics,
+// in bounded memory.
+//
 // .SECTION Thanks
 // Thanks to Philippe Pebay and David Thompson from Sandia National Laboratories
 // for implementing this class.
@@ -86,6 +92,22 @@ public:
   vtkSetMacro( MaximumHistogramSize, vtkIdType );
   vtkGetMacro( MaximumHistogramSize, vtkIdType );
 
+  // Description:
+  // Set/Get whether the histograms of numeric variables are summarized by a
+  // vtkQuantileSketch. Their Value and Cardinality columns then hold the
+  // means and weights of the centroids of the sketch, whose number is about
+  // twice the SketchCompression at most, and the quantiles derived from
+  // them are approximate, except for the extrema. The histograms of other
+  // types stay exact. Default is false.
+  vtkSetMacro( UseSketch, bool );
+  vtkGetMacro( UseSketch, bool );
+
+  // Description:
+  // Set/Get the compression of the sketches used when UseSketch is on.
+  // Default is 100.
+  vtkSetMacro( SketchCompression, double );
+  vtkGetMacro( SketchCompression, double );
+
   // Description:
   // Get the quantile definition.
   vtkIdType GetQuantileDefinition() { return static_cast<vtkIdType>( this->QuantileDefinition ); }
@@ -99,10 +121,10 @@ public:
                              vtkVariant value );
 
   // Description:
-  // Given a collection of models, calculate aggregate model
-  // NB: not implemented
+  // Given a collection of models, calculate aggregate model: the histograms
+  // of each variable are summed, and summarized again when UseSketch is on.
   virtual void Aggregate( vtkDataObjectCollection*,
-                          vtkMultiBlockDataSet* ) { return; };
+                          vtkMultiBlockDataSet* );
 
 protected:
   vtkOrderStatistics();
@@ -144,6 +166,8 @@ protected:
   QuantileDefinitionType QuantileDefinition;
   bool Quantize;
   vtkIdType MaximumHistogramSize;
+  bool UseSketch;
+  double SketchCompression;
 
 private:
   vtkOrderStatistics(const vtkOrderStatistics&); // Not implemented
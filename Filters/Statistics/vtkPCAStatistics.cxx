@@ -206,6 +206,9 @@ public:
 
   virtual void operator () ( vtkDoubleArray* result, vtkIdType row );
 
+  virtual int GetNumberOfResults() const { return static_cast<int>( this->BasisSize ); }
+  virtual void Evaluate( vtkIdType row, double* tuple, double* result ) const;
+
   std::vector<double> EigenValues;
   std::vector<std::vector<double> > EigenVectors;
   vtkIdType BasisSize;
@@ -336,25 +339,31 @@ bool vtkPCAAssessFunctor::InitializePCA( vtkTable* inData,
 // ----------------------------------------------------------------------
 void vtkPCAAssessFunctor::operator () ( vtkDoubleArray* result, vtkIdType row )
 {
-  vtkIdType i;
   result->SetNumberOfValues( this->BasisSize );
-  std::vector<std::vector<double> >::iterator it;
-  vtkIdType m = this->GetNumberOfColumns();
+  this->Evaluate( row, &this->Tuple[0], result->GetPointer( 0 ) );
+}
+
+// ----------------------------------------------------------------------
+void vtkPCAAssessFunctor::Evaluate( vtkIdType row, double* tuple, double* result ) const
+{
+  vtkIdType i;
+  std::vector<std::vector<double> >::const_iterator it;
+  vtkIdType m = static_cast<vtkIdType>( this->Columns.size() );
   for ( i = 0; i < m; ++ i )
     {
-    this->Tuple[i] = this->Columns[i]->GetTuple( row )[0] - this->Center[i];
+    tuple[i] = this->Columns[i]->GetComponent( row, 0 ) - this->Center[i];
     }
   i = 0;
   for ( it = this->EigenVectors.begin(); it != this->EigenVectors.end(); ++ it, ++ i )
     {
     double cv = 0.;
-    std::vector<double>::iterator tvit;
-    std::vector<double>::iterator evit = this->Tuple.begin();
+    std::vector<double>::const_iterator tvit;
+    const double* evit = tuple;
     for ( tvit = it->begin(); tvit != it->end(); ++ tvit, ++ evit )
       {
       cv += (*evit) * (*tvit);
       }
-    result->SetValue( i, cv );
+    result[i] = cv;
     }
 }
 
@@ -1042,6 +1051,14 @@ void vtkPCAStatistics::Assess( vtkTable* inData,
       assessValues.push_back( arr->GetPointer( 0 ) );
       }
 
+    if ( this->ComputeInParallel )
+      {
+      // Project the rows onto the basis with several threads
+      pcafunc->EvaluateInParallel( assessValues, nRow );
+      delete dfunc;
+      continue;
+      }
+
     // Something to hold assessed values for a single input datum
     vtkDoubleArray* singleResult = vtkDoubleArray::New();
     // Loop over all the input data and assess each datum:
@@ -0,0 +1,287 @@
+/*=========================================================================
+
+Program:   Visualization Toolkit
+Module:    vtkQuantileSketch.cxx
+
+Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+All rights reserved.
+See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkQuantileSketch.h"
+
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+vtkStandardNewMacro(vtkQuantileSketch);
+
+// ----------------------------------------------------------------------
+class vtkQuantileSketchInternals
+{
+public:
+  struct Centroid
+  {
+    double Mean;
+    vtkIdType Weight;
+
+    bool operator < ( const Centroid& other ) const
+    {
+      return this->Mean < other.Mean;
+    }
+  };
+
+  vtkQuantileSketchInternals()
+  {
+    this->Initialize();
+  }
+
+  void Initialize()
+  {
+    this->Centroids.clear();
+    this->Buffer.clear();
+    this->TotalWeight = 0;
+    this->Minimum = 0.;
+    this->Maximum = 0.;
+  }
+
+  // Scale function of the t-digest, mapping quantiles to a space where
+  // centroids span at most one unit.
+  static double Scale( double q, double compression )
+  {
+    return compression / ( 2. * vtkMath::Pi() ) * asin( 2. * q - 1. );
+  }
+
+  std::vector<Centroid> Centroids;
+  std::vector<Centroid> Buffer;
+  vtkIdType TotalWeight;
+  double Minimum;
+  double Maximum;
+};
+
+// ----------------------------------------------------------------------
+vtkQuantileSketch::vtkQuantileSketch()
+{
+  this->Compression = 100.;
+  this->Internals = new vtkQuantileSketchInternals;
+}
+
+// ----------------------------------------------------------------------
+vtkQuantileSketch::~vtkQuantileSketch()
+{
+  delete this->Internals;
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::PrintSelf( ostream &os, vtkIndent indent )
+{
+  this->Superclass::PrintSelf( os, indent );
+  os << indent << "Compression: " << this->Compression << endl;
+  os << indent << "TotalWeight: " << this->Internals->TotalWeight << endl;
+  os << indent << "NumberOfCentroids: " << this->Internals->Centroids.size()
+     << " (+" << this->Internals->Buffer.size() << " buffered)" << endl;
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::Initialize()
+{
+  this->Internals->Initialize();
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::AddValue( double x, vtkIdType weight )
+{
+  if ( weight <= 0 )
+    {
+    return;
+    }
+
+  vtkQuantileSketchInternals* internals = this->Internals;
+  if ( ! internals->TotalWeight )
+    {
+    internals->Minimum = x;
+    internals->Maximum = x;
+    }
+  else
+    {
+    internals->Minimum = std::min( internals->Minimum, x );
+    internals->Maximum = std::max( internals->Maximum, x );
+    }
+  internals->TotalWeight += weight;
+
+  vtkQuantileSketchInternals::Centroid c;
+  c.Mean = x;
+  c.Weight = weight;
+  internals->Buffer.push_back( c );
+
+  // Buffer values so that sorting is amortized over many of them
+  if ( internals->Buffer.size() >= static_cast<size_t>( 5. * this->Compression ) )
+    {
+    this->Compress();
+    }
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::Merge( vtkQuantileSketch* other )
+{
+  if ( ! other || other == this )
+    {
+    return;
+    }
+
+  other->Compress();
+  std::vector<vtkQuantileSketchInternals::Centroid>& centroids =
+    other->Internals->Centroids;
+  for ( size_t i = 0; i < centroids.size(); ++ i )
+    {
+    this->AddValue( centroids[i].Mean, centroids[i].Weight );
+    }
+
+  // The extrema of the other sketch are exact even if it has merged them
+  if ( other->Internals->TotalWeight )
+    {
+    this->Internals->Minimum = std::min( this->Internals->Minimum, other->Internals->Minimum );
+    this->Internals->Maximum = std::max( this->Internals->Maximum, other->Internals->Maximum );
+    }
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::Compress()
+{
+  vtkQuantileSketchInternals* internals = this->Internals;
+  if ( internals->Buffer.empty() )
+    {
+    return;
+    }
+
+  std::vector<vtkQuantileSketchInternals::Centroid> all;
+  all.reserve( internals->Centroids.size() + internals->Buffer.size() );
+  all.insert( all.end(), internals->Centroids.begin(), internals->Centroids.end() );
+  all.insert( all.end(), internals->Buffer.begin(), internals->Buffer.end() );
+  internals->Buffer.clear();
+
+  // Stable so that the result does not depend on the sort implementation
+  std::stable_sort( all.begin(), all.end() );
+
+  std::vector<vtkQuantileSketchInternals::Centroid>& out = internals->Centroids;
+  out.clear();
+  size_t n = all.size();
+  if ( n <= 2 )
+    {
+    out = all;
+    return;
+    }
+
+  // Merge neighbors as long as they span at most one unit of the scale
+  // function. The first and last centroids are kept apart, so that the
+  // extrema stay exact.
+  double inv_N = 1. / static_cast<double>( internals->TotalWeight );
+  out.push_back( all[0] );
+  double wSoFar = static_cast<double>( all[0].Weight );
+  vtkQuantileSketchInternals::Centroid cur = all[1];
+  for ( size_t i = 2; i < n - 1; ++ i )
+    {
+    double q0 = wSoFar * inv_N;
+    double q2 = ( wSoFar + cur.Weight + all[i].Weight ) * inv_N;
+    if ( vtkQuantileSketchInternals::Scale( q2, this->Compression )
+         - vtkQuantileSketchInternals::Scale( q0, this->Compression ) <= 1. )
+      {
+      vtkIdType w = cur.Weight + all[i].Weight;
+      cur.Mean += ( all[i].Mean - cur.Mean ) * all[i].Weight / static_cast<double>( w );
+      cur.Weight = w;
+      }
+    else
+      {
+      out.push_back( cur );
+      wSoFar += cur.Weight;
+      cur = all[i];
+      }
+    }
+  out.push_back( cur );
+  out.push_back( all[n - 1] );
+}
+
+// ----------------------------------------------------------------------
+vtkIdType vtkQuantileSketch::GetNumberOfCentroids()
+{
+  this->Compress();
+  return static_cast<vtkIdType>( this->Internals->Centroids.size() );
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::GetCentroid( vtkIdType i, double& mean, vtkIdType& weight )
+{
+  this->Compress();
+  const vtkQuantileSketchInternals::Centroid& c = this->Internals->Centroids[i];
+  mean = c.Mean;
+  weight = c.Weight;
+}
+
+// ----------------------------------------------------------------------
+vtkIdType vtkQuantileSketch::GetTotalWeight()
+{
+  return this->Internals->TotalWeight;
+}
+
+// ----------------------------------------------------------------------
+double vtkQuantileSketch::GetMinimum()
+{
+  return this->Internals->Minimum;
+}
+
+// ----------------------------------------------------------------------
+double vtkQuantileSketch::GetMaximum()
+{
+  return this->Internals->Maximum;
+}
+
+// ----------------------------------------------------------------------
+double vtkQuantileSketch::GetQuantile( double q )
+{
+  this->Compress();
+  vtkQuantileSketchInternals* internals = this->Internals;
+  std::vector<vtkQuantileSketchInternals::Centroid>& centroids = internals->Centroids;
+  if ( centroids.empty() )
+    {
+    return 0.;
+    }
+
+  double N = static_cast<double>( internals->TotalWeight );
+  double target = q * N;
+  if ( target <= 0. )
+    {
+    return internals->Minimum;
+    }
+  if ( target >= N )
+    {
+    return internals->Maximum;
+    }
+
+  // Interpolate linearly between the centers of the centroids, the
+  // extrema being at both ends of the range
+  double prevPos = 0.;
+  double prevValue = internals->Minimum;
+  double cum = 0.;
+  for ( size_t i = 0; i < centroids.size(); ++ i )
+    {
+    double pos = cum + .5 * centroids[i].Weight;
+    if ( target < pos )
+      {
+      double t = ( pos > prevPos ) ? ( target - prevPos ) / ( pos - prevPos ) : 0.;
+      return prevValue + t * ( centroids[i].Mean - prevValue );
+      }
+    cum += centroids[i].Weight;
+    prevPos = pos;
+    prevValue = centroids[i].Mean;
+    }
+
+  double t = ( N > prevPos ) ? ( target - prevPos ) / ( N - prevPos ) : 1.;
+  return prevValue + t * ( internals->Maximum - prevValue );
+}
@@ -0,0 +1,110 @@
+/*=========================================================================
+
+Program:   Visualization Toolkit
+Module:    vtkQuantileSketch.h
+
+Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+All rights reserved.
+See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkQuantileSketch - A mergeable summary for approximate quantiles
+//
+// .SECTION Description
+// vtkQuantileSketch summarizes a stream of weighted values as a t-digest:
+// a sorted list of centroids (mean, weight) whose weights are kept small
+// near both tails of the distribution and larger around the median, so
+// that quantiles are estimated with a relative accuracy which is best
+// where it is the most needed. The number of centroids is bounded by a
+// small multiple of the compression, independently of the number of
+// values added. The smallest and the largest values are never merged with
+// other ones, so that the extrema are exact.
+//
+// Sketches are merged with Merge(), or by adding the centroids of one to
+// another as weighted values, which allows to reduce them across threads,
+// processes, or successive pieces of streamed data. The total weight is
+// preserved exactly by all the operations.
+//
+// .SECTION See Also
+// vtkOrderStatistics vtkCardinalitySketch
+
+#ifndef vtkQuantileSketch_h
+#define vtkQuantileSketch_h
+
+#include "vtkFiltersStatisticsModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkQuantileSketchInternals;
+
+class VTKFILTERSSTATISTICS_EXPORT vtkQuantileSketch : public vtkObject
+{
+public:
+  vtkTypeMacro(vtkQuantileSketch, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+  static vtkQuantileSketch* New();
+
+  // Description:
+  // Set/Get the compression, which bounds the number of centroids to about
+  // twice its value. Larger values give more accurate quantiles. Changing
+  // it does not affect the centroids already computed until the next
+  // compression. Default is 100.
+  vtkSetClampMacro( Compression, double, 10., 100000. );
+  vtkGetMacro( Compression, double );
+
+  // Description:
+  // Remove all the values from the sketch.
+  void Initialize();
+
+  // Description:
+  // Add a value with the given weight, which must be positive.
+  void AddValue( double x, vtkIdType weight = 1 );
+
+  // Description:
+  // Add all the centroids of another sketch to this one.
+  void Merge( vtkQuantileSketch* other );
+
+  // Description:
+  // Merge the values added since the last compression into the centroids.
+  // This is done automatically when needed.
+  void Compress();
+
+  // Description:
+  // Get the number of centroids, after compressing the sketch, and the
+  // mean and weight of each of them, sorted by increasing mean.
+  vtkIdType GetNumberOfCentroids();
+  void GetCentroid( vtkIdType i, double& mean, vtkIdType& weight );
+
+  // Description:
+  // Get the total weight of the values added to the sketch.
+  vtkIdType GetTotalWeight();
+
+  // Description:
+  // Get the smallest and largest values added to the sketch. These are 0
+  // when the sketch is empty.
+  double GetMinimum();
+  double GetMaximum();
+
+  // Description:
+  // Estimate the q-quantile of the values, for q in [0,1], by linear
+  // interpolation between the centroids. Returns 0 when the sketch is
+  // empty.
+  double GetQuantile( double q );
+
+protected:
+  vtkQuantileSketch();
+  ~vtkQuantileSketch();
+
+  double Compression;
+
+  vtkQuantileSketchInternals* Internals;
+
+private:
+  vtkQuantileSketch(const vtkQuantileSketch&); // Not implemented
+  void operator=(const vtkQuantileSketch&);   // Not implemented
+};
+
+#endif
@@ -16,6 +16,7 @@
 #include <cstring>
 
 #include <algorithm>
+#include <deque>
 #include <iterator>
 #include <limits>
 #include <map>
@@ -23,6 +24,9 @@
 #include <sstream>
 #include <vector>
 
+#include <vtkConditionVariable.h>
+#include <vtkMultiThreader.h>
+#include <vtkMutexLock.h>
 #include <vtkType.h>
 
 #include <adios.h>
@@ -122,9 +126,16 @@ int Writer::InitContext::RefCount = 0;
 struct Writer::WriterImpl
 {
   WriterImpl()
-  : Group(-1)
+  : Group(-1), Comm(MPI_COMM_NULL), Asynchronous(false), MaxPendingSteps(1),
+    Threader(vtkMultiThreader::New()), ThreadId(-1), Stop(false),
+    Failed(false)
   { }
 
+  ~WriterImpl()
+  {
+    this->Threader->Delete();
+  }
+
   struct ScalarInfo
   {
     ScalarInfo(const std::string& path, ADIOS_DATATYPES type)
@@ -181,7 +192,44 @@ struct Writer::WriterImpl
     const void* Value;
   };
 
+  // The values of a committed time step.  A step written in the background
+  // owns copies of its arrays, so that the caller may change them at once.
+  struct Step
+  {
+    Step(const std::string& fileName, bool append)
+    : FileName(fileName), Append(append), GroupSize(0)
+    { }
+
+    ~Step()
+    {
+      for(size_t i = 0; i < this->Scalars.size(); ++i)
+        {
+        delete this->Scalars[i];
+        }
+      for(size_t i = 0; i < this->Arrays.size(); ++i)
+        {
+        delete this->Arrays[i];
+        }
+      for(size_t i = 0; i < this->Buffers.size(); ++i)
+        {
+        delete [] this->Buffers[i];
+        }
+    }
+
+    const std::string FileName;
+    const bool Append;
+    uint64_t GroupSize;
+    std::vector<const ScalarValue*> Scalars;
+    std::vector<const ArrayValue*> Arrays;
+    std::vector<char*> Buffers;
+  };
+
+  static void WriteStep(const Step& step, MPI_Comm comm);
+  static VTK_THREAD_RETURN_TYPE WriteSteps(void *arg);
+  void StopThread();
+
   int64_t Group;
+  MPI_Comm Comm;
 
   std::map<std::string, const ScalarInfo*> ScalarRegistry;
   std::map<std::string, const ArrayInfo*> ArrayRegistry;
@@ -190,6 +238,20 @@ struct Writer::WriterImpl
 
   std::vector<const ScalarValue*> ScalarsToWrite;
   std::vector<const ArrayValue*> ArraysToWrite;
+
+  // The steps committed and not yet written by the background thread, the
+  // first one being written.  StepsChanged is signaled when a step is
+  // added or written.
+  bool Asynchronous;
+  int MaxPendingSteps;
+  vtkMultiThreader *Threader;
+  int ThreadId;
+  vtkSimpleMutexLock StepsLock;
+  vtkSimpleConditionVariable StepsChanged;
+  std::deque<Step*> Steps;
+  bool Stop;
+  bool Failed;
+  std::string Error;
 };
 template<>
 uint64_t Writer::WriterImpl::ScalarValueT<std::complex<float> >::GetInt()
@@ -217,6 +279,8 @@ Writer::Writer(ADIOS::TransportMethod transport,
 {
   int err;
 
+  this->Impl->Comm = this->Ctx->Comm;
+
   err = adios_declare_group(&this->Impl->Group, "VTK", "", adios_flag_yes);
   WriteError::TestEq(0, err);
 
@@ -228,6 +292,9 @@ Writer::Writer(ADIOS::TransportMethod transport,
 //----------------------------------------------------------------------------
 Writer::~Writer()
 {
+  // The pending steps are written before ADIOS may be finalized
+  this->Impl->StopThread();
+
   std::map<std::string, const WriterImpl::ScalarInfo*>::const_iterator s;
   for(s = this->Impl->ScalarRegistry.begin();
       s != this->Impl->ScalarRegistry.end();
@@ -408,7 +475,9 @@ void Writer::WriteArray(const std::string& path, const void* val)
 //----------------------------------------------------------------------------
 void Writer::Commit(const std::string& fName, bool app)
 {
-  uint64_t groupSize = 0;
+  this->ThrowPendingError();
+
+  WriterImpl::Step *step = new WriterImpl::Step(fName, app);
 
   // Step 1: Preprocessing
 
@@ -418,8 +487,9 @@ void Writer::Commit(const std::string& fName, bool app)
       svi != this->Impl->ScalarsToWrite.end();
       ++svi)
     {
-    groupSize += this->Impl->ScalarRegistry[(*svi)->Path]->Size;
+    step->GroupSize += this->Impl->ScalarRegistry[(*svi)->Path]->Size;
     }
+  step->Scalars.swap(this->Impl->ScalarsToWrite);
 
   // Add the array sizes and filter out empties
   for(std::vector<const WriterImpl::ArrayValue*>::iterator avi =
@@ -446,30 +516,80 @@ void Writer::Commit(const std::string& fName, bool app)
           di->ValueI : this->Impl->IntegralScalars[di->ValueS];
         }
       }
-    groupSize += numElements * ai->ElementSize;
+    size_t numBytes = numElements * ai->ElementSize;
+    step->GroupSize += numBytes;
+
+    if(this->Impl->Asynchronous)
+      {
+      // Snapshot the values, which belong to the caller
+      char *buffer = new char[numBytes];
+      if(numBytes > 0)
+        {
+        std::memcpy(buffer, (*avi)->Value, numBytes);
+        }
+      step->Buffers.push_back(buffer);
+      step->Arrays.push_back(new WriterImpl::ArrayValue((*avi)->Path, buffer));
+      delete *avi;
+      }
+    else
+      {
+      step->Arrays.push_back(*avi);
+      }
     }
+  this->Impl->ArraysToWrite.clear();
 
+  if(!this->Impl->Asynchronous)
+    {
+    try
+      {
+      WriterImpl::WriteStep(*step, this->Ctx->Comm);
+      }
+    catch(...)
+      {
+      delete step;
+      throw;
+      }
+    delete step;
+    return;
+    }
+
+  // Wait for a free slot, which bounds the memory held by the snapshots
+  WriterImpl *impl = this->Impl;
+  impl->StepsLock.Lock();
+  while(static_cast<int>(impl->Steps.size()) >= impl->MaxPendingSteps)
+    {
+    impl->StepsChanged.Wait(impl->StepsLock);
+    }
+  impl->Steps.push_back(step);
+  impl->StepsChanged.Broadcast();
+  impl->StepsLock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void Writer::WriterImpl::WriteStep(const Step& step, MPI_Comm comm)
+{
   int err;
 
   // Step 2. Set the buffer size in MB with the full knowledge of the dynamic
   // group size.  Ask for 10% over the group size to account for extra metadata
-  int bufSize = (groupSize * 1.1)/(1024*1024) + 1;
+  int bufSize = (step.GroupSize * 1.1)/(1024*1024) + 1;
   err = adios_allocate_buffer(ADIOS_BUFFER_ALLOC_LATER, bufSize);
   WriteError::TestEq(0, err);
 
   // Step 3. Open the file for writing
   int64_t file;
-  err = adios_open(&file, "VTK", fName.c_str(), app?"a":"w", this->Ctx->Comm);
+  err = adios_open(&file, "VTK", step.FileName.c_str(),
+    step.Append?"a":"w", comm);
   WriteError::TestEq(0, err);
 
   uint64_t totalSize;
-  err = adios_group_size(file, groupSize, &totalSize);
+  err = adios_group_size(file, step.GroupSize, &totalSize);
   WriteError::TestEq(0, err);
 
   // Step 4: Write scalars
-  for(std::vector<const WriterImpl::ScalarValue*>::iterator svi =
-        this->Impl->ScalarsToWrite.begin();
-      svi != this->Impl->ScalarsToWrite.end();
+  for(std::vector<const ScalarValue*>::const_iterator svi =
+        step.Scalars.begin();
+      svi != step.Scalars.end();
       ++svi)
     {
     err = adios_write(file, (*svi)->Path.c_str(),
@@ -478,9 +598,9 @@ void Writer::Commit(const std::string& fName, bool app)
     }
 
   // Step 5: Write Arrays
-  for(std::vector<const WriterImpl::ArrayValue*>::iterator avi =
-        this->Impl->ArraysToWrite.begin();
-      avi != this->Impl->ArraysToWrite.end();
+  for(std::vector<const ArrayValue*>::const_iterator avi =
+        step.Arrays.begin();
+      avi != step.Arrays.end();
       ++avi)
     {
     err = adios_write(file, (*avi)->Path.c_str(),
@@ -490,25 +610,148 @@ void Writer::Commit(const std::string& fName, bool app)
 
   // Step 6. Close the file and commit the writes to ADIOS
   adios_close(file);
+}
 
-  // Step 7. Cleanup
-  for(std::vector<const WriterImpl::ScalarValue*>::iterator svi =
-        this->Impl->ScalarsToWrite.begin();
-      svi != this->Impl->ScalarsToWrite.end();
-      ++svi)
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE Writer::WriterImpl::WriteSteps(void *arg)
+{
+  WriterImpl *impl = static_cast<WriterImpl*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg)->UserData);
+
+  impl->StepsLock.Lock();
+  for(;;)
     {
-    delete *svi;
+    while(impl->Steps.empty() && !impl->Stop)
+      {
+      impl->StepsChanged.Wait(impl->StepsLock);
+      }
+    if(impl->Steps.empty())
+      {
+      break;
+      }
+
+    // The step stays queued while it is written so that it counts as pending
+    Step *step = impl->Steps.front();
+    impl->StepsLock.Unlock();
+
+    bool failed = false;
+    std::string error;
+    try
+      {
+      WriteStep(*step, impl->Comm);
+      }
+    catch(const WriteError &err)
+      {
+      failed = true;
+      error = err.what();
+      }
+    delete step;
+
+    impl->StepsLock.Lock();
+    impl->Steps.pop_front();
+    if(failed && !impl->Failed)
+      {
+      impl->Failed = true;
+      impl->Error = error;
+      }
+    impl->StepsChanged.Broadcast();
     }
-  this->Impl->ScalarsToWrite.clear();
+  impl->StepsLock.Unlock();
 
-  for(std::vector<const WriterImpl::ArrayValue*>::iterator avi =
-        this->Impl->ArraysToWrite.begin();
-      avi != this->Impl->ArraysToWrite.end();
-      ++avi)
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void Writer::WriterImpl::StopThread()
+{
+  if(this->ThreadId < 0)
     {
-    delete *avi;
+    return;
+    }
+
+  // The thread writes the remaining steps before it exits
+  this->StepsLock.Lock();
+  this->Stop = true;
+  this->StepsChanged.Broadcast();
+  this->StepsLock.Unlock();
+
+  this->Threader->TerminateThread(this->ThreadId);
+  this->ThreadId = -1;
+  this->Stop = false;
+}
+
+//----------------------------------------------------------------------------
+bool Writer::SetAsynchronous(bool async, int maxPendingSteps)
+{
+  if(!async)
+    {
+    this->Impl->StopThread();
+    this->Impl->Asynchronous = false;
+    return true;
+    }
+
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  if(provided < MPI_THREAD_MULTIPLE)
+    {
+    return false;
+    }
+
+  this->Impl->StepsLock.Lock();
+  this->Impl->MaxPendingSteps = std::max(maxPendingSteps, 1);
+  this->Impl->StepsChanged.Broadcast();
+  this->Impl->StepsLock.Unlock();
+
+  if(this->Impl->ThreadId < 0)
+    {
+    this->Impl->ThreadId = this->Impl->Threader->SpawnThread(
+      &WriterImpl::WriteSteps, this->Impl);
+    if(this->Impl->ThreadId < 0)
+      {
+      return false;
+      }
+    }
+  this->Impl->Asynchronous = true;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int Writer::GetNumberOfPendingSteps()
+{
+  this->Impl->StepsLock.Lock();
+  int numSteps = static_cast<int>(this->Impl->Steps.size());
+  this->Impl->StepsLock.Unlock();
+  return numSteps;
+}
+
+//----------------------------------------------------------------------------
+void Writer::WaitForCommits()
+{
+  this->Impl->StepsLock.Lock();
+  while(!this->Impl->Steps.empty())
+    {
+    this->Impl->StepsChanged.Wait(this->Impl->StepsLock);
+    }
+  this->Impl->StepsLock.Unlock();
+
+  this->ThrowPendingError();
+}
+
+//----------------------------------------------------------------------------
+void Writer::ThrowPendingError()
+{
+  this->Impl->StepsLock.Lock();
+  bool failed = this->Impl->Failed;
+  std::string error = this->Impl->Error;
+  this->Impl->Failed = false;
+  this->Impl->Error.clear();
+  this->Impl->StepsLock.Unlock();
+
+  if(failed)
+    {
+    throw WriteError(error.empty() ?
+      std::string("Asynchronous commit failed") : error);
     }
-  this->Impl->ArraysToWrite.clear();
 }
 
 } // End namespace
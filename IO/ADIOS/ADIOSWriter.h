@@ -94,9 +94,28 @@ public:
   void WriteArray(const std::string& path, const void* val);
 
   // Description:
-  // Perform all writes for the current time step
+  // Perform all writes for the current time step.  When asynchronous, the
+  // enqueued arrays are copied and written by a background thread, and the
+  // call only blocks while maxPendingSteps steps are still being written.
   void Commit(const std::string& fileName, bool append = false);
 
+  // Description:
+  // Write the committed steps in a background thread, keeping at most
+  // maxPendingSteps of them in memory.  This requires MPI to be initialized
+  // with MPI_THREAD_MULTIPLE, since ADIOS then calls MPI from that thread;
+  // false is returned and the writes stay synchronous otherwise.
+  bool SetAsynchronous(bool async, int maxPendingSteps = 1);
+
+  // Description:
+  // The number of committed steps not yet written
+  int GetNumberOfPendingSteps();
+
+  // Description:
+  // Block until all the committed steps are written.  An error raised while
+  // writing one of them in the background is thrown here or by the next
+  // Commit.
+  void WaitForCommits();
+
 private:
   struct InitContext;
   InitContext *Ctx;
@@ -107,6 +126,7 @@ private:
   void DefineAttribute(const std::string& path, ADIOS_DATATYPES adiosType,
     const std::string& value);
   int DefineScalar(const std::string& path, ADIOS_DATATYPES adiosType);
+  void ThrowPendingError();
 };
 
 }
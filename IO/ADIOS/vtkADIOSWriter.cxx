@@ -61,7 +61,8 @@ vtkADIOSWriter::vtkADIOSWriter()
   CurrentStep(-1), Controller(NULL),
   Writer(NULL),
   NumberOfPieces(-1), RequestPiece(-1), NumberOfGhostLevels(-1),
-  WriteAllTimeSteps(false), TimeSteps(), CurrentTimeStepIndex(-1)
+  WriteAllTimeSteps(false), AsynchronousWrite(false), MaxPendingSteps(1),
+  TimeSteps(), CurrentTimeStepIndex(-1)
 {
   std::memset(this->RequestExtent, 0, 6*sizeof(int));
   this->SetNumberOfInputPorts(1);
@@ -84,6 +85,9 @@ void vtkADIOSWriter::PrintSelf(std::ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
   os << indent << "FileName: " << (this->FileName ? this->FileName : "(null)")
      << std::endl;
+  os << indent << "AsynchronousWrite: " << this->AsynchronousWrite
+     << std::endl;
+  os << indent << "MaxPendingSteps: " << this->MaxPendingSteps << std::endl;
 }
 
 //----------------------------------------------------------------------------
@@ -121,6 +125,32 @@ void vtkADIOSWriter::SetController(vtkMultiProcessController *controller)
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkADIOSWriter::GetNumberOfPendingSteps()
+{
+  return this->Writer ? this->Writer->GetNumberOfPendingSteps() : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkADIOSWriter::WaitForWrites()
+{
+  if(!this->Writer)
+    {
+    return 1;
+    }
+
+  try
+    {
+    this->Writer->WaitForCommits();
+    }
+  catch(const ADIOS::WriteError &err)
+    {
+    vtkErrorMacro(<< err.what());
+    return 0;
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 template<typename T>
 bool vtkADIOSWriter::DefineAndWrite(vtkDataObject *input)
@@ -232,6 +262,12 @@ int vtkADIOSWriter::ProcessRequest(vtkInformation* request,
     this->Writer = new ADIOS::Writer(
       static_cast<ADIOS::TransportMethod>(this->TransportMethod),
       this->TransportMethodArguments ? this->TransportMethodArguments : "");
+    if(this->AsynchronousWrite &&
+       !this->Writer->SetAsynchronous(true, this->MaxPendingSteps))
+      {
+      vtkWarningMacro("Asynchronous writes need MPI_THREAD_MULTIPLE; "
+        "writing synchronously");
+      }
     }
 
   return this->Superclass::ProcessRequest(request, input, output);
@@ -103,6 +103,34 @@ public:
   vtkGetMacro(WriteAllTimeSteps, bool);
   vtkBooleanMacro(WriteAllTimeSteps, bool);
 
+  // Description:
+  // When on, each step is copied and written by a background thread, so
+  // that the pipeline returns as soon as the copy is made.  Requires MPI
+  // initialized with MPI_THREAD_MULTIPLE; otherwise a warning is issued and
+  // steps are written synchronously.  Must be set before the first write.
+  // Default is OFF.
+  vtkSetMacro(AsynchronousWrite, bool);
+  vtkGetMacro(AsynchronousWrite, bool);
+  vtkBooleanMacro(AsynchronousWrite, bool);
+
+  // Description:
+  // The number of steps an asynchronous writer keeps in memory.  A write
+  // blocks while that many steps are still being written, which bounds the
+  // memory used by the copies.  Default is 1: one step is written while the
+  // next is being produced.
+  vtkSetClampMacro(MaxPendingSteps, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaxPendingSteps, int);
+
+  // Description:
+  // The number of steps written asynchronously and not yet complete.  An in
+  // situ pipeline may skip a step rather than wait when it is not zero.
+  int GetNumberOfPendingSteps();
+
+  // Description:
+  // Block until all the steps written asynchronously are complete.  Returns
+  // 0 if one of them failed.
+  int WaitForWrites();
+
   // Description:
   // Set the MPI controller.
   void SetController(vtkMultiProcessController*);
@@ -180,6 +208,8 @@ protected:
   int RequestPiece;
   int NumberOfGhostLevels;
   bool WriteAllTimeSteps;
+  bool AsynchronousWrite;
+  int MaxPendingSteps;
   std::vector<double> TimeSteps;
   int CurrentTimeStepIndex;
   int RequestExtent[6];
@@ -0,0 +1,125 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompressedDataArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkCompressedDataArrayTemplate gives back the values of the
+// compressed array, whether blocks compress or not and whatever the order
+// of the accesses.
+
+#include "vtkCompressedDataArrayTemplate.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                        \
+  if (!(cond))                                                        \
+    {                                                                 \
+    std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;     \
+    return EXIT_FAILURE;                                              \
+    }
+
+int TestCompressedDataArray(int, char *[])
+{
+  // Smooth values, which compress well.
+  const vtkIdType numTuples = 100003;
+  vtkNew<vtkFloatArray> source;
+  source->SetName("Smooth");
+  source->SetNumberOfComponents(3);
+  source->SetNumberOfTuples(numTuples);
+  for (vtkIdType i = 0; i < numTuples; ++i)
+    {
+    source->SetTuple3(i, static_cast<float>(i % 100), 1.f,
+                      static_cast<float>(sin(0.001 * i)));
+    }
+
+  typedef vtkCompressedDataArrayTemplate<float> CompressedFloats;
+  vtkNew<CompressedFloats> array;
+  array->SetBlockSize(1000);
+  array->SetCacheSize(2);
+  TEST_ASSERT(array->CompressArray(source.GetPointer()), "Cannot compress");
+  TEST_ASSERT(array->GetNumberOfTuples() == numTuples &&
+              array->GetNumberOfComponents() == 3 &&
+              array->GetNumberOfBlocks() == 101 &&
+              strcmp(array->GetName(), "Smooth") == 0,
+              "Bad array layout");
+  TEST_ASSERT(array->GetCompressedSize() <
+              static_cast<vtkIdType>(numTuples * 3 * sizeof(float)) / 2,
+              "Smooth values do not compress: " << array->GetCompressedSize());
+
+  for (vtkIdType i = 0; i < numTuples * 3; ++i)
+    {
+    TEST_ASSERT(array->GetValue(i) == source->GetValue(i),
+                "Bad value at " << i);
+    }
+
+  // Random accesses go through block evictions.
+  vtkMath::RandomSeed(1234);
+  float tuple[3];
+  for (int i = 0; i < 10000; ++i)
+    {
+    vtkIdType t = static_cast<vtkIdType>(vtkMath::Random(0, numTuples));
+    t = t < numTuples ? t : numTuples - 1;
+    double *d = array->GetTuple(t);
+    array->GetTupleValue(t, tuple);
+    for (int c = 0; c < 3; ++c)
+      {
+      TEST_ASSERT(d[c] == source->GetComponent(t, c) &&
+                  tuple[c] == source->GetComponent(t, c),
+                  "Bad tuple " << t);
+      }
+    }
+  TEST_ASSERT(array->LookupTypedValue(1.f) == 1 &&
+              array->LookupValue(vtkVariant(99.f)) == 99 * 3,
+              "Bad lookup");
+
+  // Values of another type, in blocks that do not compress.
+  vtkNew<vtkIntArray> noise;
+  noise->SetNumberOfTuples(50000);
+  for (vtkIdType i = 0; i < noise->GetNumberOfTuples(); ++i)
+    {
+    noise->SetValue(i, static_cast<int>(vtkMath::Random(-1e9, 1e9)));
+    }
+  vtkNew<CompressedFloats> noisy;
+  noisy->DeepCopy(noise.GetPointer());
+  TEST_ASSERT(noisy->GetNumberOfTuples() == 50000, "Bad noisy array size");
+  for (vtkIdType i = 50000 - 1; i >= 0; --i)
+    {
+    TEST_ASSERT(noisy->GetValue(i) == static_cast<float>(noise->GetValue(i)),
+                "Bad noisy value at " << i);
+    }
+
+  // New instances made by filters are regular arrays that can be written to.
+  vtkDataArray *base = array.GetPointer();
+  vtkSmartPointer<vtkDataArray> copy;
+  copy.TakeReference(base->NewInstance());
+  TEST_ASSERT(vtkFloatArray::SafeDownCast(copy) != NULL,
+              "NewInstance is not a vtkFloatArray");
+  copy->DeepCopy(array.GetPointer());
+  TEST_ASSERT(copy->GetNumberOfTuples() == numTuples &&
+              copy->GetComponent(numTuples - 1, 0) ==
+              source->GetComponent(numTuples - 1, 0),
+              "Bad copy of the compressed array");
+
+  array->Initialize();
+  TEST_ASSERT(array->GetNumberOfTuples() == 0 &&
+              array->GetCompressedSize() == 0, "Initialize left values");
+
+  return EXIT_SUCCESS;
+}
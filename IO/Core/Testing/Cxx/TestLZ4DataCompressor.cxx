@@ -0,0 +1,111 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLZ4DataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkLZ4DataCompressor restores random, repetitive and tiny
+// buffers at all levels, that it decodes a block of the LZ4 format, and
+// that it rejects corrupt blocks.
+
+#include "vtkLZ4DataCompressor.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+bool RoundTrip(vtkLZ4DataCompressor *compressor,
+               const std::vector<unsigned char> &data, const char *what)
+{
+  size_t size = data.size();
+  std::vector<unsigned char> compressed(
+    compressor->GetMaximumCompressionSpace(size) + 1);
+  std::vector<unsigned char> uncompressed(size + 1);
+  size_t compressedSize = compressor->Compress(
+    size ? &data[0] : 0, size, &compressed[0], compressed.size());
+  if (compressedSize == 0 ||
+      compressor->Uncompress(&compressed[0], compressedSize,
+                             &uncompressed[0], size) != size ||
+      (size && memcmp(&data[0], &uncompressed[0], size) != 0))
+    {
+    cerr << what << " of " << size << " bytes at level "
+         << compressor->GetCompressionLevel() << " is not restored" << endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+int TestLZ4DataCompressor(int, char *[])
+{
+  vtkNew<vtkLZ4DataCompressor> compressor;
+
+  // literals "abc", a match of 7 bytes at offset 3, and literals "bcabc"
+  const unsigned char block[] = { 0x33, 'a', 'b', 'c', 0x03, 0x00,
+                                  0x50, 'b', 'c', 'a', 'b', 'c' };
+  unsigned char text[16];
+  if (compressor->Uncompress(block, sizeof(block), text, 15) != 15 ||
+      memcmp(text, "abcabcabcabcabc", 15) != 0)
+    {
+    cerr << "The LZ4 block is not decoded" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // corrupt blocks: an offset beyond the start, and a truncated block
+  const unsigned char badOffset[] = { 0x10, 'a', 0x05, 0x00 };
+  vtkObject::GlobalWarningDisplayOff();
+  bool accepted =
+    compressor->Uncompress(badOffset, sizeof(badOffset), text, 5) != 0 ||
+    compressor->Uncompress(block, 9, text, 15) != 0;
+  vtkObject::GlobalWarningDisplayOn();
+  if (accepted)
+    {
+    cerr << "A corrupt LZ4 block is accepted" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkMath::RandomSeed(91);
+  for (int level = 1; level <= 9; level += 2)
+    {
+    compressor->SetCompressionLevel(level);
+    for (size_t size = 1; size < 40; ++size)
+      {
+      std::vector<unsigned char> data(size, 'x');
+      if (!RoundTrip(compressor.GetPointer(), data, "Tiny buffer"))
+        {
+        return EXIT_FAILURE;
+        }
+      }
+
+    const size_t size = 200000;
+    std::vector<unsigned char> noise(size), symbols(size), runs(size);
+    for (size_t i = 0; i < size; ++i)
+      {
+      noise[i] = static_cast<unsigned char>(vtkMath::Random(0.0, 256.0));
+      symbols[i] = static_cast<unsigned char>(vtkMath::Random(0.0, 4.0));
+      runs[i] = ((i / 1000) % 2 ? static_cast<unsigned char>(i % 13) :
+                 noise[i]);
+      }
+    if (!RoundTrip(compressor.GetPointer(), noise, "Noise") ||
+        !RoundTrip(compressor.GetPointer(), symbols, "Symbols") ||
+        !RoundTrip(compressor.GetPointer(), runs, "Runs"))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
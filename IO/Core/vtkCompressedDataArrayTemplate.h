@@ -0,0 +1,195 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompressedDataArrayTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkCompressedDataArrayTemplate - Read only data array stored as
+// compressed blocks.
+//
+// .SECTION Description
+// vtkCompressedDataArrayTemplate keeps the values of another data array as
+// independently compressed blocks of BlockSize tuples, using a
+// vtkDataCompressor (vtkZLibDataCompressor by default). Blocks are
+// decompressed on demand into a small cache of the CacheSize most recently
+// used blocks, so that data sets kept resident for a long time, such as
+// the time steps of a cache, use less memory at the cost of occasional
+// decompression. Blocks that do not compress are stored as they are.
+//
+// The values are set with CompressArray() or DeepCopy(); the array is read
+// only otherwise. NewInstance() returns a regular array of the same type,
+// so filters that create output arrays from this one are not affected.
+//
+// .SECTION Caveats
+// Reading values modifies the block cache, so an array must not be read
+// from several threads at the same time. References returned by
+// GetValueReference() and the pointer returned by GetTuple() are only
+// valid until the next access to another block.
+
+#ifndef vtkCompressedDataArrayTemplate_h
+#define vtkCompressedDataArrayTemplate_h
+
+#include "vtkMappedDataArray.h"
+
+#include "vtkTypeTemplate.h" // For templated vtkObject API
+#include "vtkObjectFactory.h" // for vtkStandardNewMacro
+
+#include <vector> // For block storage
+
+class vtkDataCompressor;
+
+template <class Scalar>
+class vtkCompressedDataArrayTemplate:
+    public vtkTypeTemplate<vtkCompressedDataArrayTemplate<Scalar>,
+                           vtkMappedDataArray<Scalar> >
+{
+public:
+  vtkMappedDataArrayNewInstanceMacro(vtkCompressedDataArrayTemplate<Scalar>)
+  static vtkCompressedDataArrayTemplate *New();
+  virtual void PrintSelf(ostream &os, vtkIndent indent);
+
+  // Description:
+  // Set/Get the compressor used by the next call to CompressArray(). A
+  // vtkZLibDataCompressor is created if none was set. The compressor must
+  // not be changed while values compressed with it are in use.
+  void SetCompressor(vtkDataCompressor *compressor);
+  vtkDataCompressor *GetCompressor() { return this->Compressor; }
+
+  // Description:
+  // Set/Get the number of tuples of a block, used by the next call to
+  // CompressArray(). Larger blocks compress better but take longer to
+  // decompress on a cache miss. The default is 8192.
+  void SetBlockSize(vtkIdType size);
+  vtkIdType GetBlockSize() { return this->BlockSize; }
+
+  // Description:
+  // Set/Get the number of decompressed blocks that are kept. The default
+  // is 4.
+  void SetCacheSize(int size);
+  int GetCacheSize() { return this->CacheSize; }
+
+  // Description:
+  // Compress the values of source, converting them to Scalar. Returns 1 on
+  // success and 0 if source cannot be compressed, leaving the array
+  // empty.
+  int CompressArray(vtkDataArray *source);
+
+  // Description:
+  // Return the number of blocks and the size in bytes of the compressed
+  // values.
+  vtkIdType GetNumberOfBlocks();
+  vtkIdType GetCompressedSize();
+
+  // Description:
+  // Return the memory in kibibytes used by the compressed values and the
+  // decompressed blocks.
+  unsigned long GetActualMemorySize();
+
+  // Reimplemented virtuals -- see superclasses for descriptions:
+  void Initialize();
+  void GetTuples(vtkIdList *ptIds, vtkAbstractArray *output);
+  void GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *output);
+  void Squeeze();
+  vtkArrayIterator *NewIterator();
+  vtkIdType LookupValue(vtkVariant value);
+  void LookupValue(vtkVariant value, vtkIdList *ids);
+  vtkVariant GetVariantValue(vtkIdType idx);
+  void ClearLookup();
+  double* GetTuple(vtkIdType i);
+  void GetTuple(vtkIdType i, double *tuple);
+  vtkIdType LookupTypedValue(Scalar value);
+  void LookupTypedValue(Scalar value, vtkIdList *ids);
+  Scalar GetValue(vtkIdType idx);
+  Scalar& GetValueReference(vtkIdType idx);
+  void GetTupleValue(vtkIdType idx, Scalar *t);
+
+  // Description:
+  // Compress the values of the given array, see CompressArray().
+  void DeepCopy(vtkAbstractArray *aa);
+  void DeepCopy(vtkDataArray *da);
+
+  // Description:
+  // This container is read only -- this method does nothing but print a
+  // warning.
+  int Allocate(vtkIdType sz, vtkIdType ext);
+  int Resize(vtkIdType numTuples);
+  void SetNumberOfTuples(vtkIdType number);
+  void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source);
+  void SetTuple(vtkIdType i, const float *source);
+  void SetTuple(vtkIdType i, const double *source);
+  void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source);
+  void InsertTuple(vtkIdType i, const float *source);
+  void InsertTuple(vtkIdType i, const double *source);
+  void InsertTuples(vtkIdList *dstIds, vtkIdList *srcIds,
+                    vtkAbstractArray *source);
+  void InsertTuples(vtkIdType dstStart, vtkIdType n, vtkIdType srcStart,
+                    vtkAbstractArray* source);
+  vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray *source);
+  vtkIdType InsertNextTuple(const float *source);
+  vtkIdType InsertNextTuple(const double *source);
+  void InterpolateTuple(vtkIdType i, vtkIdList *ptIndices,
+                        vtkAbstractArray* source,  double* weights);
+  void InterpolateTuple(vtkIdType i, vtkIdType id1, vtkAbstractArray *source1,
+                        vtkIdType id2, vtkAbstractArray *source2, double t);
+  void SetVariantValue(vtkIdType idx, vtkVariant value);
+  void InsertVariantValue(vtkIdType idx, vtkVariant value);
+  void RemoveTuple(vtkIdType id);
+  void RemoveFirstTuple();
+  void RemoveLastTuple();
+  void SetTupleValue(vtkIdType i, const Scalar *t);
+  void InsertTupleValue(vtkIdType i, const Scalar *t);
+  vtkIdType InsertNextTupleValue(const Scalar *t);
+  void SetValue(vtkIdType idx, Scalar value);
+  vtkIdType InsertNextValue(Scalar v);
+  void InsertValue(vtkIdType idx, Scalar v);
+
+protected:
+  vtkCompressedDataArrayTemplate();
+  ~vtkCompressedDataArrayTemplate();
+
+  vtkDataCompressor *Compressor;
+  vtkIdType BlockSize;
+  int CacheSize;
+
+  // Number of tuples per block of the current values.
+  vtkIdType CompressedBlockSize;
+  // The compressed blocks, one after the other. Block i is stored from
+  // BlockOffsets[i] to BlockOffsets[i + 1].
+  std::vector<unsigned char> CompressedData;
+  std::vector<size_t> BlockOffsets;
+
+  // A decompressed block.
+  struct CacheEntry
+  {
+    vtkIdType Block;
+    unsigned long LastUse;
+    std::vector<Scalar> Values;
+  };
+  std::vector<CacheEntry> Cache;
+  size_t LastEntry;
+  unsigned long UseCounter;
+
+  // Return the values of the given block, decompressing it if needed.
+  Scalar *GetBlock(vtkIdType block);
+
+private:
+  vtkCompressedDataArrayTemplate(const vtkCompressedDataArrayTemplate &); // Not implemented.
+  void operator=(const vtkCompressedDataArrayTemplate &); // Not implemented.
+
+  vtkIdType Lookup(const Scalar &val, vtkIdType startIndex);
+  double *TempDoubleArray;
+};
+
+#include "vtkCompressedDataArrayTemplate.txx"
+
+#endif //vtkCompressedDataArrayTemplate_h
+
+// VTK-HeaderTest-Exclude: vtkCompressedDataArrayTemplate.h
@@ -0,0 +1,741 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompressedDataArrayTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkCompressedDataArrayTemplate.h"
+
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkVariant.h"
+#include "vtkVariantCast.h"
+#include "vtkZLibDataCompressor.h"
+
+#include <algorithm>
+#include <cstring>
+
+//------------------------------------------------------------------------------
+// Can't use vtkStandardNewMacro on a templated class.
+template <class Scalar> vtkCompressedDataArrayTemplate<Scalar> *
+vtkCompressedDataArrayTemplate<Scalar>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkCompressedDataArrayTemplate<Scalar>)
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->vtkCompressedDataArrayTemplate<Scalar>::Superclass::PrintSelf(
+        os, indent);
+
+  os << indent << "Compressor: " << this->Compressor << "\n";
+  os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "CacheSize: " << this->CacheSize << "\n";
+  os << indent << "Number of blocks: " << this->GetNumberOfBlocks() << "\n";
+  os << indent << "Compressed size: " << this->GetCompressedSize() << "\n";
+  os << indent << "Cached blocks: " << this->Cache.size() << "\n";
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::SetCompressor(vtkDataCompressor *compressor)
+{
+  if (this->Compressor == compressor)
+    {
+    return;
+    }
+  if (this->Compressor)
+    {
+    this->Compressor->UnRegister(this);
+    }
+  this->Compressor = compressor;
+  if (this->Compressor)
+    {
+    this->Compressor->Register(this);
+    }
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::SetBlockSize(vtkIdType size)
+{
+  size = std::max(size, static_cast<vtkIdType>(1));
+  if (this->BlockSize != size)
+    {
+    this->BlockSize = size;
+    this->Modified();
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::SetCacheSize(int size)
+{
+  size = std::max(size, 1);
+  if (this->CacheSize != size)
+    {
+    this->CacheSize = size;
+    if (this->Cache.size() > static_cast<size_t>(size))
+      {
+      this->Cache.clear();
+      this->LastEntry = 0;
+      }
+    this->Modified();
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> int vtkCompressedDataArrayTemplate<Scalar>
+::CompressArray(vtkDataArray *source)
+{
+  this->Initialize();
+  if (!source)
+    {
+    return 0;
+    }
+  if (!this->Compressor)
+    {
+    vtkZLibDataCompressor *compressor = vtkZLibDataCompressor::New();
+    this->SetCompressor(compressor);
+    compressor->Delete();
+    }
+
+  const int numComps = source->GetNumberOfComponents();
+  const vtkIdType numTuples = source->GetNumberOfTuples();
+  const vtkIdType numValues = numTuples * numComps;
+  const bool sameType = source->GetDataType() == this->GetDataType() &&
+    source->HasStandardMemoryLayout();
+  const Scalar *sourceValues = sameType ?
+    static_cast<Scalar*>(source->GetVoidPointer(0)) : NULL;
+
+  const vtkIdType valuesPerBlock = this->BlockSize * numComps;
+  const size_t maxBlockBytes = sizeof(Scalar) * valuesPerBlock;
+  std::vector<Scalar> values;
+  std::vector<unsigned char> compressed(
+    this->Compressor->GetMaximumCompressionSpace(maxBlockBytes));
+  this->BlockOffsets.push_back(0);
+  for (vtkIdType first = 0; first < numValues; first += valuesPerBlock)
+    {
+    const vtkIdType count = std::min(valuesPerBlock, numValues - first);
+    const Scalar *block = sourceValues + first;
+    if (!sourceValues)
+      {
+      values.resize(count);
+      for (vtkIdType i = 0; i < count; ++i)
+        {
+        values[i] = static_cast<Scalar>(
+          source->GetComponent((first + i) / numComps, (first + i) % numComps));
+        }
+      block = &values[0];
+      }
+
+    const unsigned char *bytes = reinterpret_cast<const unsigned char*>(block);
+    const size_t rawSize = sizeof(Scalar) * count;
+    size_t size = this->Compressor->Compress(
+      bytes, rawSize, &compressed[0], compressed.size());
+    if (size > 0 && size < rawSize)
+      {
+      bytes = &compressed[0];
+      }
+    else
+      {
+      // Stored as is: a block whose stored size is its raw size is raw.
+      size = rawSize;
+      }
+    this->CompressedData.insert(this->CompressedData.end(), bytes,
+                                bytes + size);
+    this->BlockOffsets.push_back(this->CompressedData.size());
+    }
+
+  // Give back the room reserved while compressing.
+  std::vector<unsigned char>(this->CompressedData).swap(this->CompressedData);
+
+  this->CompressedBlockSize = this->BlockSize;
+  this->NumberOfComponents = numComps;
+  this->Size = numValues;
+  this->MaxId = numValues - 1;
+  this->TempDoubleArray = new double [numComps];
+  this->SetName(source->GetName());
+  this->Modified();
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkCompressedDataArrayTemplate<Scalar>
+::GetNumberOfBlocks()
+{
+  return this->BlockOffsets.empty() ? 0 :
+    static_cast<vtkIdType>(this->BlockOffsets.size() - 1);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkCompressedDataArrayTemplate<Scalar>
+::GetCompressedSize()
+{
+  return static_cast<vtkIdType>(this->CompressedData.size());
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> unsigned long vtkCompressedDataArrayTemplate<Scalar>
+::GetActualMemorySize()
+{
+  size_t size = this->CompressedData.capacity() +
+    this->BlockOffsets.capacity() * sizeof(size_t);
+  for (size_t i = 0; i < this->Cache.size(); ++i)
+    {
+    size += this->Cache[i].Values.capacity() * sizeof(Scalar);
+    }
+  return static_cast<unsigned long>(size / 1024 + 1);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar *vtkCompressedDataArrayTemplate<Scalar>
+::GetBlock(vtkIdType block)
+{
+  // Most accesses are sequential and hit the block used last.
+  if (this->LastEntry < this->Cache.size() &&
+      this->Cache[this->LastEntry].Block == block)
+    {
+    return &this->Cache[this->LastEntry].Values[0];
+    }
+
+  ++this->UseCounter;
+  size_t entry = 0;
+  for (; entry < this->Cache.size(); ++entry)
+    {
+    if (this->Cache[entry].Block == block)
+      {
+      this->Cache[entry].LastUse = this->UseCounter;
+      this->LastEntry = entry;
+      return &this->Cache[entry].Values[0];
+      }
+    }
+
+  // Miss: use a new entry or evict the least recently used one.
+  if (this->Cache.size() < static_cast<size_t>(this->CacheSize))
+    {
+    this->Cache.push_back(CacheEntry());
+    entry = this->Cache.size() - 1;
+    }
+  else
+    {
+    entry = 0;
+    for (size_t i = 1; i < this->Cache.size(); ++i)
+      {
+      if (this->Cache[i].LastUse < this->Cache[entry].LastUse)
+        {
+        entry = i;
+        }
+      }
+    }
+
+  CacheEntry &e = this->Cache[entry];
+  const vtkIdType valuesPerBlock =
+    this->CompressedBlockSize * this->NumberOfComponents;
+  const vtkIdType first = block * valuesPerBlock;
+  const vtkIdType count = std::min(valuesPerBlock, this->MaxId + 1 - first);
+  const size_t rawSize = sizeof(Scalar) * count;
+  const unsigned char *data = &this->CompressedData[0] +
+    this->BlockOffsets[block];
+  const size_t size = this->BlockOffsets[block + 1] -
+    this->BlockOffsets[block];
+  e.Block = block;
+  e.LastUse = this->UseCounter;
+  e.Values.resize(count);
+  unsigned char *values = reinterpret_cast<unsigned char*>(&e.Values[0]);
+  if (size == rawSize)
+    {
+    memcpy(values, data, rawSize);
+    }
+  else if (this->Compressor->Uncompress(data, size, values, rawSize) !=
+           rawSize)
+    {
+    vtkErrorMacro("Cannot uncompress block " << block);
+    std::fill(e.Values.begin(), e.Values.end(), Scalar());
+    }
+  this->LastEntry = entry;
+  return &e.Values[0];
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::Initialize()
+{
+  this->CompressedData.clear();
+  this->BlockOffsets.clear();
+  this->Cache.clear();
+  this->LastEntry = 0;
+  this->CompressedBlockSize = this->BlockSize;
+
+  delete [] this->TempDoubleArray;
+  this->TempDoubleArray = NULL;
+
+  this->MaxId = -1;
+  this->Size = 0;
+  this->NumberOfComponents = 1;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::GetTuples(vtkIdList *ptIds, vtkAbstractArray *output)
+{
+  vtkDataArray *da = vtkDataArray::FastDownCast(output);
+  if (!da)
+    {
+    vtkWarningMacro(<<"Input is not a vtkDataArray");
+    return;
+    }
+
+  if (da->GetNumberOfComponents() != this->GetNumberOfComponents())
+    {
+    vtkWarningMacro(<<"Incorrect number of components in input array.");
+    return;
+    }
+
+  const vtkIdType numPoints = ptIds->GetNumberOfIds();
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    da->SetTuple(i, this->GetTuple(ptIds->GetId(i)));
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *output)
+{
+  vtkDataArray *da = vtkDataArray::FastDownCast(output);
+  if (!da)
+    {
+    vtkErrorMacro(<<"Input is not a vtkDataArray");
+    return;
+    }
+
+  if (da->GetNumberOfComponents() != this->GetNumberOfComponents())
+    {
+    vtkErrorMacro(<<"Incorrect number of components in input array.");
+    return;
+    }
+
+  for (vtkIdType daTupleId = 0; p1 <= p2; ++p1)
+    {
+    da->SetTuple(daTupleId++, this->GetTuple(p1));
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::Squeeze()
+{
+  this->Cache.clear();
+  this->LastEntry = 0;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkArrayIterator*
+vtkCompressedDataArrayTemplate<Scalar>::NewIterator()
+{
+  vtkErrorMacro(<<"Not implemented.");
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkCompressedDataArrayTemplate<Scalar>
+::LookupValue(vtkVariant value)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  if (valid)
+    {
+    return this->Lookup(val, 0);
+    }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::LookupValue(vtkVariant value, vtkIdList *ids)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  ids->Reset();
+  if (valid)
+    {
+    vtkIdType index = 0;
+    while ((index = this->Lookup(val, index)) >= 0)
+      {
+      ids->InsertNextId(index);
+      ++index;
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkVariant vtkCompressedDataArrayTemplate<Scalar>
+::GetVariantValue(vtkIdType idx)
+{
+  return vtkVariant(this->GetValue(idx));
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::ClearLookup()
+{
+  // no-op, no fast lookup implemented.
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> double* vtkCompressedDataArrayTemplate<Scalar>
+::GetTuple(vtkIdType i)
+{
+  this->GetTuple(i, this->TempDoubleArray);
+  return this->TempDoubleArray;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::GetTuple(vtkIdType i, double *tuple)
+{
+  const Scalar *values = this->GetBlock(i / this->CompressedBlockSize) +
+    (i % this->CompressedBlockSize) * this->NumberOfComponents;
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    tuple[comp] = static_cast<double>(values[comp]);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkCompressedDataArrayTemplate<Scalar>
+::LookupTypedValue(Scalar value)
+{
+  return this->Lookup(value, 0);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::LookupTypedValue(Scalar value, vtkIdList *ids)
+{
+  ids->Reset();
+  vtkIdType index = 0;
+  while ((index = this->Lookup(value, index)) >= 0)
+    {
+    ids->InsertNextId(index);
+    ++index;
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar vtkCompressedDataArrayTemplate<Scalar>
+::GetValue(vtkIdType idx)
+{
+  return this->GetValueReference(idx);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar& vtkCompressedDataArrayTemplate<Scalar>
+::GetValueReference(vtkIdType idx)
+{
+  const vtkIdType valuesPerBlock =
+    this->CompressedBlockSize * this->NumberOfComponents;
+  return this->GetBlock(idx / valuesPerBlock)[idx % valuesPerBlock];
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::GetTupleValue(vtkIdType tupleId, Scalar *tuple)
+{
+  const Scalar *values =
+    this->GetBlock(tupleId / this->CompressedBlockSize) +
+    (tupleId % this->CompressedBlockSize) * this->NumberOfComponents;
+  std::copy(values, values + this->NumberOfComponents, tuple);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::DeepCopy(vtkAbstractArray *aa)
+{
+  if (aa == this)
+    {
+    return;
+    }
+  vtkDataArray *da = vtkDataArray::FastDownCast(aa);
+  if (!da)
+    {
+    vtkErrorMacro(<<"Input is not a vtkDataArray");
+    return;
+    }
+  this->CompressArray(da);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::DeepCopy(vtkDataArray *da)
+{
+  if (da != this)
+    {
+    this->CompressArray(da);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> int vtkCompressedDataArrayTemplate<Scalar>
+::Allocate(vtkIdType, vtkIdType)
+{
+  vtkErrorMacro("Read only container.")
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> int vtkCompressedDataArrayTemplate<Scalar>
+::Resize(vtkIdType)
+{
+  vtkErrorMacro("Read only container.")
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::SetNumberOfTuples(vtkIdType)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::SetTuple(vtkIdType, vtkIdType, vtkAbstractArray *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::SetTuple(vtkIdType, const float *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::SetTuple(vtkIdType, const double *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType, vtkIdType, vtkAbstractArray *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType, const float *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType, const double *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::InsertTuples(vtkIdList *, vtkIdList *, vtkAbstractArray *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::InsertTuples(vtkIdType, vtkIdType, vtkIdType, vtkAbstractArray *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkCompressedDataArrayTemplate<Scalar>
+::InsertNextTuple(vtkIdType, vtkAbstractArray *)
+{
+  vtkErrorMacro("Read only container.")
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkCompressedDataArrayTemplate<Scalar>
+::InsertNextTuple(const float *)
+{
+  vtkErrorMacro("Read only container.")
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkCompressedDataArrayTemplate<Scalar>
+::InsertNextTuple(const double *)
+{
+  vtkErrorMacro("Read only container.")
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::InterpolateTuple(vtkIdType, vtkIdList *, vtkAbstractArray *, double *)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::InterpolateTuple(vtkIdType, vtkIdType, vtkAbstractArray*, vtkIdType,
+                   vtkAbstractArray*, double)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::SetVariantValue(vtkIdType, vtkVariant)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::InsertVariantValue(vtkIdType, vtkVariant)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::RemoveTuple(vtkIdType)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::RemoveFirstTuple()
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::RemoveLastTuple()
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::SetTupleValue(vtkIdType, const Scalar*)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::InsertTupleValue(vtkIdType, const Scalar*)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkCompressedDataArrayTemplate<Scalar>
+::InsertNextTupleValue(const Scalar *)
+{
+  vtkErrorMacro("Read only container.")
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::SetValue(vtkIdType, Scalar)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkCompressedDataArrayTemplate<Scalar>
+::InsertNextValue(Scalar)
+{
+  vtkErrorMacro("Read only container.")
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkCompressedDataArrayTemplate<Scalar>
+::InsertValue(vtkIdType, Scalar)
+{
+  vtkErrorMacro("Read only container.")
+  return;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkCompressedDataArrayTemplate<Scalar>
+::vtkCompressedDataArrayTemplate()
+  : Compressor(NULL), BlockSize(8192), CacheSize(4), CompressedBlockSize(8192),
+    LastEntry(0), UseCounter(0), TempDoubleArray(NULL)
+{
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkCompressedDataArrayTemplate<Scalar>
+::~vtkCompressedDataArrayTemplate()
+{
+  if (this->Compressor)
+    {
+    this->Compressor->UnRegister(this);
+    }
+  delete [] this->TempDoubleArray;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkCompressedDataArrayTemplate<Scalar>
+::Lookup(const Scalar &val, vtkIdType index)
+{
+  while (index <= this->MaxId)
+    {
+    if (this->GetValue(index) == val)
+      {
+      return index;
+      }
+    ++index;
+    }
+  return -1;
+}
@@ -0,0 +1,328 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLZ4DataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLZ4DataCompressor.h"
+#include "vtkObjectFactory.h"
+#include "vtkType.h"
+
+#include <cstring>
+#include <vector>
+
+vtkStandardNewMacro(vtkLZ4DataCompressor);
+
+// A block is a sequence of literals followed by a match, the last
+// sequence having only literals.  For the reference decoder, the last
+// match must start 12 bytes before the end of the block at the latest,
+// and the last 5 bytes must be literals.
+#define VTK_LZ4_MIN_MATCH 4
+#define VTK_LZ4_MATCH_START_LIMIT 12
+#define VTK_LZ4_LAST_LITERALS 5
+#define VTK_LZ4_MAX_OFFSET 65535
+#define VTK_LZ4_HASH_BITS 16
+
+//----------------------------------------------------------------------------
+static inline vtkTypeUInt32 vtkLZ4Read32(const unsigned char* p)
+{
+  vtkTypeUInt32 v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+//----------------------------------------------------------------------------
+static inline int vtkLZ4Hash(vtkTypeUInt32 v)
+{
+  return static_cast<int>((v * 2654435761U) >> (32 - VTK_LZ4_HASH_BITS));
+}
+
+//----------------------------------------------------------------------------
+// Write a length that did not fit in its 4 bits of the token
+static inline unsigned char* vtkLZ4WriteLength(unsigned char* op,
+                                               size_t length)
+{
+  while (length >= 255)
+    {
+    *op++ = 255;
+    length -= 255;
+    }
+  *op++ = static_cast<unsigned char>(length);
+  return op;
+}
+
+//----------------------------------------------------------------------------
+// Write the literals from anchor to ip, then the match if matchLength is
+// not zero.
+static unsigned char* vtkLZ4WriteSequence(unsigned char* op,
+                                          const unsigned char* anchor,
+                                          const unsigned char* ip,
+                                          size_t offset, size_t matchLength)
+{
+  size_t literals = ip - anchor;
+  unsigned char* token = op++;
+  *token = static_cast<unsigned char>((literals < 15 ? literals : 15) << 4);
+  if (literals >= 15)
+    {
+    op = vtkLZ4WriteLength(op, literals - 15);
+    }
+  memcpy(op, anchor, literals);
+  op += literals;
+
+  if (matchLength)
+    {
+    *op++ = static_cast<unsigned char>(offset & 0xff);
+    *op++ = static_cast<unsigned char>(offset >> 8);
+    size_t code = matchLength - VTK_LZ4_MIN_MATCH;
+    *token |= static_cast<unsigned char>(code < 15 ? code : 15);
+    if (code >= 15)
+      {
+      op = vtkLZ4WriteLength(op, code - 15);
+      }
+    }
+  return op;
+}
+
+//----------------------------------------------------------------------------
+vtkLZ4DataCompressor::vtkLZ4DataCompressor()
+{
+  this->CompressionLevel = 1;
+}
+
+//----------------------------------------------------------------------------
+vtkLZ4DataCompressor::~vtkLZ4DataCompressor()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkLZ4DataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkLZ4DataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+                                     size_t uncompressedSize,
+                                     unsigned char* compressedData,
+                                     size_t compressionSpace)
+{
+  if (compressionSpace < this->GetMaximumCompressionSpace(uncompressedSize))
+    {
+    vtkErrorMacro("LZ4 compression needs " <<
+                  this->GetMaximumCompressionSpace(uncompressedSize) <<
+                  " bytes of output space, only " << compressionSpace <<
+                  " were given.");
+    return 0;
+    }
+
+  const unsigned char* base = uncompressedData;
+  const unsigned char* ip = base;
+  const unsigned char* anchor = base;
+  unsigned char* op = compressedData;
+
+  // The last position of a match start, and the end of the matches
+  if (uncompressedSize > VTK_LZ4_MATCH_START_LIMIT)
+    {
+    const unsigned char* matchStartLimit =
+      base + uncompressedSize - VTK_LZ4_MATCH_START_LIMIT;
+    const unsigned char* matchLimit =
+      base + uncompressedSize - VTK_LZ4_LAST_LITERALS;
+
+    // The last position of each hash, and for levels above 1 the previous
+    // position with the same hash for the positions of the window
+    int maxAttempts = 1 << (this->CompressionLevel - 1);
+    std::vector<vtkTypeInt64> head(static_cast<size_t>(1) << VTK_LZ4_HASH_BITS,
+                                   -1);
+    std::vector<vtkTypeInt64> chain;
+    if (maxAttempts > 1)
+      {
+      chain.resize(VTK_LZ4_MAX_OFFSET + 1);
+      }
+
+    while (ip < matchStartLimit)
+      {
+      vtkTypeInt64 pos = ip - base;
+      vtkTypeUInt32 sequence = vtkLZ4Read32(ip);
+      int hash = vtkLZ4Hash(sequence);
+      vtkTypeInt64 candidate = head[hash];
+      head[hash] = pos;
+      if (maxAttempts > 1)
+        {
+        chain[pos & VTK_LZ4_MAX_OFFSET] = candidate;
+        }
+
+      // the longest match among the candidates of the window
+      size_t bestLength = 0;
+      vtkTypeInt64 bestPos = 0;
+      for (int attempt = 0; attempt < maxAttempts &&
+             candidate >= 0 && pos - candidate <= VTK_LZ4_MAX_OFFSET;
+           attempt++)
+        {
+        const unsigned char* match = base + candidate;
+        if (vtkLZ4Read32(match) == sequence)
+          {
+          size_t length = VTK_LZ4_MIN_MATCH;
+          while (ip + length < matchLimit && match[length] == ip[length])
+            {
+            length++;
+            }
+          if (length > bestLength)
+            {
+            bestLength = length;
+            bestPos = candidate;
+            }
+          }
+        if (maxAttempts == 1)
+          {
+          break;
+          }
+        vtkTypeInt64 previous = chain[candidate & VTK_LZ4_MAX_OFFSET];
+        if (previous >= candidate)
+          {
+          break;
+          }
+        candidate = previous;
+        }
+
+      if (bestLength < VTK_LZ4_MIN_MATCH)
+        {
+        // at level 1, move faster through data that does not compress
+        ip += (maxAttempts == 1 ? 1 + ((ip - anchor) >> 6) : 1);
+        continue;
+        }
+
+      op = vtkLZ4WriteSequence(op, anchor, ip,
+                               static_cast<size_t>(pos - bestPos),
+                               bestLength);
+
+      // remember the positions of the match for the next matches
+      if (maxAttempts > 1)
+        {
+        for (size_t i = 1; i < bestLength && ip + i < matchStartLimit; i++)
+          {
+          vtkTypeInt64 p = pos + static_cast<vtkTypeInt64>(i);
+          int h = vtkLZ4Hash(vtkLZ4Read32(base + p));
+          chain[p & VTK_LZ4_MAX_OFFSET] = head[h];
+          head[h] = p;
+          }
+        }
+      ip += bestLength;
+      anchor = ip;
+      }
+    }
+
+  // the last literals
+  op = vtkLZ4WriteSequence(op, anchor, base + uncompressedSize, 0, 0);
+  return static_cast<size_t>(op - compressedData);
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkLZ4DataCompressor::UncompressBuffer(unsigned char const* compressedData,
+                                       size_t compressedSize,
+                                       unsigned char* uncompressedData,
+                                       size_t uncompressedSize)
+{
+  const unsigned char* ip = compressedData;
+  const unsigned char* iend = compressedData + compressedSize;
+  unsigned char* op = uncompressedData;
+  unsigned char* oend = uncompressedData + uncompressedSize;
+
+  while (ip < iend)
+    {
+    unsigned int token = *ip++;
+
+    // the literals
+    size_t length = token >> 4;
+    if (length == 15)
+      {
+      unsigned int byte = 255;
+      while (byte == 255 && ip < iend)
+        {
+        byte = *ip++;
+        length += byte;
+        }
+      }
+    if (length > static_cast<size_t>(iend - ip) ||
+        length > static_cast<size_t>(oend - op))
+      {
+      vtkErrorMacro("LZ4 data is corrupt: literals overflow the buffers.");
+      return 0;
+      }
+    memcpy(op, ip, length);
+    ip += length;
+    op += length;
+    if (ip == iend)
+      {
+      break;
+      }
+
+    // the match
+    if (iend - ip < 2)
+      {
+      vtkErrorMacro("LZ4 data is corrupt: truncated match offset.");
+      return 0;
+      }
+    size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - uncompressedData))
+      {
+      vtkErrorMacro("LZ4 data is corrupt: match offset out of range.");
+      return 0;
+      }
+    length = token & 15;
+    if (length == 15)
+      {
+      unsigned int byte = 255;
+      while (byte == 255 && ip < iend)
+        {
+        byte = *ip++;
+        length += byte;
+        }
+      }
+    length += VTK_LZ4_MIN_MATCH;
+    if (length > static_cast<size_t>(oend - op))
+      {
+      vtkErrorMacro("LZ4 data is corrupt: match overflows the output.");
+      return 0;
+      }
+
+    // matches may overlap their own output
+    const unsigned char* match = op - offset;
+    for (size_t i = 0; i < length; i++)
+      {
+      op[i] = match[i];
+      }
+    op += length;
+    }
+
+  // Make sure the output size matched that expected.
+  if (op != oend)
+    {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected " << uncompressedSize << " and got "
+                  << (op - uncompressedData));
+    return 0;
+    }
+
+  return uncompressedSize;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkLZ4DataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  // Incompressible data grows by one byte per 255 literals, plus a token.
+  return size + size/255 + 16;
+}
@@ -0,0 +1,74 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLZ4DataCompressor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkLZ4DataCompressor - Data compression in the LZ4 block format.
+// .SECTION Description
+// vtkLZ4DataCompressor provides a concrete vtkDataCompressor class that
+// compresses each block to the LZ4 block format, which the reference
+// LZ4 library decodes with LZ4_decompress_safe.  LZ4 only encodes
+// repeated byte sequences, without entropy coding, so that it compresses
+// several times faster than zlib and uncompresses faster still, for
+// somewhat larger output.
+
+#ifndef vtkLZ4DataCompressor_h
+#define vtkLZ4DataCompressor_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkDataCompressor.h"
+
+class VTKIOCORE_EXPORT vtkLZ4DataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkLZ4DataCompressor,vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent);
+  static vtkLZ4DataCompressor* New();
+
+  // Description:
+  // Get the maximum space that may be needed to store data of the
+  // given uncompressed size after compression.  This is the minimum
+  // size of the output buffer that can be passed to the four-argument
+  // Compress method.
+  size_t GetMaximumCompressionSpace(size_t size);
+
+  // Description:
+  // Get/Set the compression level, from 1 (the default, fastest) to 9.
+  // Level 1 compares each position with the last position that shared
+  // its first four bytes, and skips ahead faster through data that does
+  // not compress.  Each higher level doubles the number of earlier
+  // positions that are compared to find the longest match.
+  vtkSetClampMacro(CompressionLevel, int, 1, 9);
+  vtkGetMacro(CompressionLevel, int);
+
+protected:
+  vtkLZ4DataCompressor();
+  ~vtkLZ4DataCompressor();
+
+  int CompressionLevel;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData,
+                        size_t uncompressedSize,
+                        unsigned char* compressedData,
+                        size_t compressionSpace);
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData,
+                          size_t compressedSize,
+                          unsigned char* uncompressedData,
+                          size_t uncompressedSize);
+private:
+  vtkLZ4DataCompressor(const vtkLZ4DataCompressor&);  // Not implemented.
+  void operator=(const vtkLZ4DataCompressor&);  // Not implemented.
+};
+
+#endif
@@ -25,10 +25,13 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <sys/stat.h>
+#include <algorithm>
 #include <cctype>
 #include <string>
 #include <vector>
@@ -46,8 +49,109 @@ class vtkEnSightGoldBinaryReader::FileOffsetMapInternal
     typedef std::map<MapKey, MapValue>::value_type value_type;
 
     std::map<MapKey, MapValue> Map;
+
+    // The number of time steps of the geometry files, which takes a scan of
+    // the whole file to count.
+    std::map<MapKey, int> NumberOfTimeSteps;
 };
 
+namespace
+{
+// The values of a part of a variable file per node.
+struct vtkEnSightGoldBinaryNodePart
+{
+  // The offset of the first record, after the "coordinates" or "block" line.
+  vtkTypeInt64 Offset;
+  int NumberOfPoints;
+  vtkFloatArray *Array;
+};
+
+// Reads and decodes whole parts of a variable file per node, with a file
+// stream for each thread so that the parts are independent.
+class ReadNodeParts
+{
+public:
+  const char *FileName;
+  bool Fortran;
+  bool LittleEndian;
+  int NumberOfPlanes;
+  const int *PlaneComponents;
+  const std::vector<vtkEnSightGoldBinaryNodePart> *Parts;
+  std::vector<char> Failed;
+  vtkSMPThreadLocal<ifstream *> Files;
+
+  ReadNodeParts() : Files(NULL) {}
+
+  ~ReadNodeParts()
+  {
+    for (vtkSMPThreadLocal<ifstream *>::iterator it = this->Files.begin();
+         it != this->Files.end(); ++it)
+      {
+      delete *it;
+      }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    ifstream *&file = this->Files.Local();
+    if (!file)
+      {
+      file = new ifstream(this->FileName, ios::in | ios::binary);
+      }
+    if (!file->is_open())
+      {
+      std::fill(this->Failed.begin() + begin, this->Failed.begin() + end, 1);
+      return;
+      }
+
+    std::vector<float> values;
+    for (vtkIdType index = begin; index < end; ++index)
+      {
+      const vtkEnSightGoldBinaryNodePart &part = (*this->Parts)[index];
+      const int numPts = part.NumberOfPoints;
+      const int numComps = part.Array->GetNumberOfComponents();
+      float *array = part.Array->GetPointer(0);
+      values.resize(numPts);
+
+      file->clear();
+      file->seekg(part.Offset, ios::beg);
+      for (int plane = 0; plane < this->NumberOfPlanes; ++plane)
+        {
+        // Fortran records are enclosed by their 4 byte length
+        if (this->Fortran)
+          {
+          file->seekg(4, ios::cur);
+          }
+        if (!file->read(reinterpret_cast<char*>(&values[0]),
+                        sizeof(float)*numPts))
+          {
+          this->Failed[index] = 1;
+          break;
+          }
+        if (this->Fortran)
+          {
+          file->seekg(4, ios::cur);
+          }
+        if (this->LittleEndian)
+          {
+          vtkByteSwap::Swap4LERange(&values[0], numPts);
+          }
+        else
+          {
+          vtkByteSwap::Swap4BERange(&values[0], numPts);
+          }
+
+        float *component = array + this->PlaneComponents[plane];
+        for (int i = 0; i < numPts; ++i)
+          {
+          component[i*numComps] = values[i];
+          }
+        }
+      }
+  }
+};
+}
+
 
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
@@ -63,6 +167,7 @@ vtkEnSightGoldBinaryReader::vtkEnSightGoldBinaryReader()
   this->Fortran = 0;
   this->NodeIdsListed = 0;
   this->ElementIdsListed = 0;
+  this->ReadPartsInParallel = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -258,17 +363,30 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
     return 0;
     }
 
-  //this will close the file, so we need to reinitialize it
-  int numberOfTimeStepsInFile=this->CountTimeSteps();
-
-  if (!this->InitializeFile(fileName))
-  {
-  return 0;
-  }
-
-
   if (this->UseFileSets)
     {
+    // Counting the time steps reads through the whole file, so that it is
+    // done once per file.
+    int numberOfTimeStepsInFile;
+    std::map<std::string, int>::const_iterator counted =
+      this->FileOffsets->NumberOfTimeSteps.find(fileName);
+    if (counted != this->FileOffsets->NumberOfTimeSteps.end())
+      {
+      numberOfTimeStepsInFile = counted->second;
+      }
+    else
+      {
+      //this will close the file, so we need to reinitialize it
+      numberOfTimeStepsInFile = this->CountTimeSteps();
+      this->FileOffsets->NumberOfTimeSteps[fileName] =
+        numberOfTimeStepsInFile;
+
+      if (!this->InitializeFile(fileName))
+        {
+        return 0;
+        }
+      }
+
     if (numberOfTimeStepsInFile>1)
       {
       this->AddFileIndexToCache(fileName);
@@ -1432,6 +1550,20 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
     return 1;
     }
 
+  if (this->ReadPartsInParallel)
+    {
+    int result = this->ReadPartsPerNode(sfilename.c_str(), description,
+      compositeOutput, 1, &component, numberOfComponents, component != 0,
+      vtkDataSetAttributes::SCALARS);
+    if (this->IFile)
+      {
+      this->IFile->close();
+      delete this->IFile;
+      this->IFile = NULL;
+      }
+    return result;
+    }
+
   lineRead = this->ReadLine(line);
   while (lineRead && strncmp(line, "part", 4) == 0)
     {
@@ -1631,6 +1763,21 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
     return 1;
     }
 
+  if (this->ReadPartsInParallel)
+    {
+    const int planeComponents[3] = { 0, 1, 2 };
+    int result = this->ReadPartsPerNode(sfilename.c_str(), description,
+      compositeOutput, 3, planeComponents, 3, false,
+      vtkDataSetAttributes::VECTORS);
+    if (this->IFile)
+      {
+      this->IFile->close();
+      delete this->IFile;
+      this->IFile = NULL;
+      }
+    return result;
+    }
+
   lineRead = this->ReadLine(line);
   while (lineRead && strncmp(line, "part", 4) == 0)
     {
@@ -1773,6 +1920,22 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
     }
 
   this->ReadLine(line); // skip the description line
+
+  if (this->ReadPartsInParallel)
+    {
+    // The file stores the xy, yz and xz components in the order 12, 13, 23
+    const int planeComponents[6] = { 0, 1, 2, 3, 5, 4 };
+    int result = this->ReadPartsPerNode(sfilename.c_str(), description,
+      compositeOutput, 6, planeComponents, 6, false, -1);
+    if (this->IFile)
+      {
+      this->IFile->close();
+      delete this->IFile;
+      this->IFile = NULL;
+      }
+    return result;
+    }
+
   lineRead = this->ReadLine(line);
 
   while (lineRead && strncmp(line, "part", 4) == 0)
@@ -1840,6 +2003,104 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::ReadPartsPerNode(
+  const char* fileName, const char* description,
+  vtkMultiBlockDataSet *compositeOutput, int numberOfPlanes,
+  const int* planeComponents, int numberOfComponents, bool reuse,
+  int attribute)
+{
+  char line[80];
+  int partId, realId, numPts, lineRead;
+  std::vector<vtkEnSightGoldBinaryNodePart> parts;
+  std::vector<vtkDataSet*> outputs;
+
+  // Index the parts, seeking over their values
+  lineRead = this->ReadLine(line);
+  while (lineRead && strncmp(line, "part", 4) == 0)
+    {
+    this->ReadPartId(&partId);
+    partId--; // EnSight starts #ing with 1.
+    realId = this->InsertNewPartId(partId);
+    vtkDataSet *output = this->GetDataSetFromBlock(compositeOutput, realId);
+    numPts = output->GetNumberOfPoints();
+    // If the part has no points, then only the part number is listed in
+    // the variable file.
+    if (numPts)
+      {
+      this->ReadLine(line); // "coordinates" or "block"
+      vtkEnSightGoldBinaryNodePart part;
+      part.Offset = this->IFile->tellg();
+      part.NumberOfPoints = numPts;
+      part.Array = reuse ? vtkFloatArray::SafeDownCast(
+        output->GetPointData()->GetArray(description)) : NULL;
+      if (part.Array && part.Array->GetNumberOfTuples() == numPts &&
+          part.Array->GetNumberOfComponents() == numberOfComponents)
+        {
+        part.Array->Register(this);
+        }
+      else
+        {
+        part.Array = vtkFloatArray::New();
+        part.Array->SetNumberOfComponents(numberOfComponents);
+        part.Array->SetNumberOfTuples(numPts);
+        part.Array->SetName(description);
+        }
+      parts.push_back(part);
+      outputs.push_back(output);
+
+      vtkTypeInt64 recordSize =
+        static_cast<vtkTypeInt64>(sizeof(float))*numPts +
+        (this->Fortran ? 8 : 0);
+      this->IFile->seekg(numberOfPlanes*recordSize, ios::cur);
+      }
+
+    this->IFile->peek();
+    if (this->IFile->eof())
+      {
+      break;
+      }
+    lineRead = this->ReadLine(line);
+    }
+
+  ReadNodeParts functor;
+  functor.FileName = fileName;
+  functor.Fortran = this->Fortran != 0;
+  functor.LittleEndian = this->ByteOrder == FILE_LITTLE_ENDIAN;
+  functor.NumberOfPlanes = numberOfPlanes;
+  functor.PlaneComponents = planeComponents;
+  functor.Parts = &parts;
+  functor.Failed.resize(parts.size(), 0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(parts.size()), functor);
+
+  int result = 1;
+  for (size_t i = 0; i < parts.size(); ++i)
+    {
+    if (functor.Failed[i])
+      {
+      vtkErrorMacro("Cannot read the values of part " << i << " of "
+                    << fileName);
+      result = 0;
+      break;
+      }
+    }
+
+  for (size_t i = 0; i < parts.size(); ++i)
+    {
+    if (result)
+      {
+      vtkPointData *pointData = outputs[i]->GetPointData();
+      pointData->AddArray(parts[i].Array);
+      if (attribute >= 0 && !pointData->GetAttribute(attribute))
+        {
+        pointData->SetActiveAttribute(description, attribute);
+        }
+      }
+    parts[i].Array->Delete();
+    }
+  return result;
+}
+
 //----------------------------------------------------------------------------
 int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
   const char* fileName, const char* description, int timeStep,
@@ -4241,6 +4502,7 @@ int vtkEnSightGoldBinaryReader::ReadFloatArray(float *result,
 void vtkEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+  os << indent << "ReadPartsInParallel: " << this->ReadPartsInParallel << endl;
 }
 
 // Seeks the IFile to the cached timestep nearest the target timestep.
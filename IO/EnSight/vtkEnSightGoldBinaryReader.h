@@ -50,6 +50,14 @@ public:
   vtkTypeMacro(vtkEnSightGoldBinaryReader, vtkEnSightReader);
   virtual void PrintSelf(ostream& os, vtkIndent indent);
 
+  // Description:
+  // When on, the parts of the variable files per node are read and decoded
+  // in parallel, each thread reading whole parts through its own file
+  // stream.  Default is off.
+  vtkSetMacro(ReadPartsInParallel, int);
+  vtkGetMacro(ReadPartsInParallel, int);
+  vtkBooleanMacro(ReadPartsInParallel, int);
+
 protected:
   vtkEnSightGoldBinaryReader();
   ~vtkEnSightGoldBinaryReader();
@@ -117,6 +125,20 @@ protected:
   virtual int ReadTensorsPerElement(const char* fileName, const char* description,
     int timeStep, vtkMultiBlockDataSet *output);
 
+  // Description:
+  // Read the parts of a variable file per node, positioned at the first
+  // "part" line, in parallel.  Each part holds numberOfPlanes records of
+  // one float per point, and the record i is stored in the component
+  // planeComponents[i] of the array.  If reuse is set, the array already
+  // made for the description is filled instead of a new one, as for the
+  // imaginary part of complex scalars.  The new arrays are made the active
+  // attribute (see vtkDataSetAttributes::AttributeTypes) when there is none
+  // yet, unless attribute is -1.  Returns 0 if an error occurred.
+  int ReadPartsPerNode(const char* fileName, const char* description,
+    vtkMultiBlockDataSet *output, int numberOfPlanes,
+    const int* planeComponents, int numberOfComponents, bool reuse,
+    int attribute);
+
   // Description:
   // Read an unstructured part (partId) from the geometry file and create a
   // vtkUnstructuredGrid output.  Return 0 if EOF reached. Return -1 if
@@ -212,6 +234,8 @@ protected:
   FileOffsetMapInternal *FileOffsets;
   //ETX
 
+  int ReadPartsInParallel;
+
 private:
   int SizeOfInt;
   vtkEnSightGoldBinaryReader(const vtkEnSightGoldBinaryReader&);  // Not implemented.
@@ -0,0 +1,108 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusIICache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkExodusIICache counts the bytes of its arrays exactly, drops
+// the least recently used arrays only when an insertion exceeds its
+// capacity, and counts hits, misses and evictions.
+
+#include "vtkDoubleArray.h"
+#include "vtkExodusIICache.h"
+#include "vtkNew.h"
+
+namespace
+{
+
+// An array of 64 KiB.
+vtkDoubleArray *MakeArray()
+{
+  vtkDoubleArray *array = vtkDoubleArray::New();
+  array->SetNumberOfTuples(8192);
+  return array;
+}
+
+bool Check(bool condition, const char *what)
+{
+  if (!condition)
+    {
+    cerr << what << endl;
+    }
+  return condition;
+}
+
+}
+
+int TestExodusIICache(int, char *[])
+{
+  vtkNew<vtkExodusIICache> cache;
+  cache->SetCacheCapacity(0.25); // four arrays
+
+  for (int time = 0; time < 4; ++time)
+    {
+    vtkExodusIICacheKey key(time, 1, 0, 0);
+    vtkDoubleArray *array = MakeArray();
+    cache->Insert(key, array);
+    array->Delete();
+    }
+  if (!Check(cache->GetSize() == 4 * 65536, "Wrong size of four arrays") ||
+      !Check(cache->GetSpaceLeft() == 0., "Wrong space left") ||
+      !Check(cache->GetEvictions() == 0, "An array is dropped too early"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // time 0 becomes the most recently used, so that time 1 is dropped
+  vtkExodusIICacheKey first(0, 1, 0, 0);
+  vtkExodusIICacheKey second(1, 1, 0, 0);
+  vtkExodusIICacheKey fifth(4, 1, 0, 0);
+  if (!Check(cache->Find(first) != 0, "Time 0 is not found"))
+    {
+    return EXIT_FAILURE;
+    }
+  vtkDoubleArray *array = MakeArray();
+  cache->Insert(fifth, array);
+  array->Delete();
+  if (!Check(cache->GetEvictions() == 1, "Wrong number of evictions") ||
+      !Check(cache->GetSize() == 4 * 65536, "Wrong size after eviction") ||
+      !Check(cache->Find(second) == 0, "Time 1 is not dropped") ||
+      !Check(cache->Find(first) != 0, "Time 0 is dropped") ||
+      !Check(cache->Find(fifth) != 0, "Time 4 is not found") ||
+      !Check(cache->GetHits() == 3, "Wrong number of hits") ||
+      !Check(cache->GetMisses() == 1, "Wrong number of misses"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // replacing an array with a smaller one gives back the difference
+  vtkDoubleArray *small = vtkDoubleArray::New();
+  small->SetNumberOfTuples(1024);
+  cache->Insert(first, small);
+  small->Delete();
+  if (!Check(cache->GetSize() == 3 * 65536 + 8192, "Wrong replaced size") ||
+      !Check(cache->Invalidate(fifth) == 1, "Time 4 is not invalidated") ||
+      !Check(cache->GetSize() == 2 * 65536 + 8192, "Wrong invalidated size"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  cache->ResetStatistics();
+  cache->Clear();
+  if (!Check(cache->GetSize() == 0, "The cache is not empty") ||
+      !Check(cache->GetHits() == 0 && cache->GetMisses() == 0 &&
+             cache->GetEvictions() == 0, "The statistics are not reset"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
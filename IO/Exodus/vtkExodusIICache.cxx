@@ -9,9 +9,23 @@
 #define VTK_EXO_PRT_KEY( ckey ) \
   "(" << ckey.Time << ", " << ckey.ObjectType << ", " << ckey.ObjectId << ", " << ckey.ArrayId << ")"
 #define VTK_EXO_PRT_ARR( cval ) \
-  " [" << cval << "," <<  (cval ? cval->GetActualMemorySize() / 1024. : 0.) << "/" << this->Size << "/" << this->Capacity << "]"
+  " [" << cval << "," <<  vtkExodusIICacheArraySize( cval ) << "/" << this->Size << "/" << this->Capacity << "]"
 #define VTK_EXO_PRT_ARR2( cval ) \
-  " [" << cval << ", " <<  (cval ? cval->GetActualMemorySize() / 1024. : 0.) << "]"
+  " [" << cval << ", " <<  vtkExodusIICacheArraySize( cval ) << "]"
+
+// The number of bytes allocated by an array.
+static vtkTypeInt64 vtkExodusIICacheArraySize( vtkDataArray* arr )
+{
+  return arr ?
+    static_cast<vtkTypeInt64>( arr->GetSize() ) * arr->GetDataTypeSize() : 0;
+}
+
+// Convert a size in MiB to bytes, clamping negative sizes to zero.
+static vtkTypeInt64 vtkExodusIICacheBytes( double sizeInMiB )
+{
+  return sizeInMiB > 0. ?
+    static_cast<vtkTypeInt64>( sizeInMiB * 1048576. ) : 0;
+}
 
 #if 0
 static void printCache( vtkExodusIICacheSet& cache, vtkExodusIICacheLRU& lru )
@@ -35,11 +49,13 @@ static void printCache( vtkExodusIICacheSet& cache, vtkExodusIICacheLRU& lru )
 vtkExodusIICacheEntry::vtkExodusIICacheEntry()
 {
   this->Value = 0;
+  this->Bytes = 0;
 }
 
 vtkExodusIICacheEntry::vtkExodusIICacheEntry( vtkDataArray* arr )
 {
   this->Value = arr;
+  this->Bytes = vtkExodusIICacheArraySize( arr );
   if ( arr )
     this->Value->Register( 0 );
 }
@@ -52,6 +68,7 @@ vtkExodusIICacheEntry::~vtkExodusIICacheEntry()
 vtkExodusIICacheEntry::vtkExodusIICacheEntry( const vtkExodusIICacheEntry& other )
 {
   this->Value = other.Value;
+  this->Bytes = other.Bytes;
   if ( this->Value )
     this->Value->Register( 0 );
 }
@@ -69,8 +86,11 @@ vtkStandardNewMacro(vtkExodusIICache);
 
 vtkExodusIICache::vtkExodusIICache()
 {
-  this->Size = 0.;
-  this->Capacity = 2.;
+  this->Size = 0;
+  this->Capacity = vtkExodusIICacheBytes( 2. );
+  this->Hits = 0;
+  this->Misses = 0;
+  this->Evictions = 0;
 }
 
 vtkExodusIICache::~vtkExodusIICache()
@@ -81,8 +101,11 @@ vtkExodusIICache::~vtkExodusIICache()
 void vtkExodusIICache::PrintSelf( ostream& os, vtkIndent indent )
 {
   this->Superclass::PrintSelf( os, indent );
-  os << indent << "Capacity: " << this->Capacity << " MiB\n";
-  os << indent << "Size: " << this->Size << " MiB\n";
+  os << indent << "Capacity: " << this->Capacity << " bytes\n";
+  os << indent << "Size: " << this->Size << " bytes\n";
+  os << indent << "Hits: " << this->Hits << "\n";
+  os << indent << "Misses: " << this->Misses << "\n";
+  os << indent << "Evictions: " << this->Evictions << "\n";
   os << indent << "Cache: " << &this->Cache << " (" << this->Cache.size() << ")\n";
   os << indent << "LRU: " << &this->LRU << "\n";
 }
@@ -93,57 +116,51 @@ void vtkExodusIICache::Clear()
   this->ReduceToSize( 0. );
 }
 
+void vtkExodusIICache::ResetStatistics()
+{
+  this->Hits = 0;
+  this->Misses = 0;
+  this->Evictions = 0;
+}
+
 void vtkExodusIICache::SetCacheCapacity( double sizeInMiB )
 {
-  if ( sizeInMiB == this->Capacity )
+  vtkTypeInt64 capacity = vtkExodusIICacheBytes( sizeInMiB );
+  if ( capacity == this->Capacity )
     return;
 
-  if ( this->Size > sizeInMiB )
+  if ( this->Size > capacity )
     {
     this->ReduceToSize( sizeInMiB );
     }
 
-  this->Capacity =  sizeInMiB < 0 ? 0 : sizeInMiB;
+  this->Capacity = capacity;
+}
+
+vtkTypeInt64 vtkExodusIICache::DropLeastRecentlyUsed()
+{
+  vtkExodusIICacheRef cit( this->LRU.back() );
+  vtkTypeInt64 bytes = cit->second->Bytes;
+#ifdef VTK_EXO_DBG_CACHE
+  cout << "Dropping " << VTK_EXO_PRT_KEY( cit->first ) << VTK_EXO_PRT_ARR( cit->second->Value ) << "\n";
+#endif // VTK_EXO_DBG_CACHE
+  this->Size -= bytes;
+  delete cit->second;
+  this->Cache.erase( cit );
+  this->LRU.pop_back();
+  return bytes;
 }
 
 int vtkExodusIICache::ReduceToSize( double newSize )
 {
+  vtkTypeInt64 newBytes = vtkExodusIICacheBytes( newSize );
   int deletedSomething = 0;
-  while ( this->Size > newSize && ! this->LRU.empty() )
+  while ( this->Size > newBytes && ! this->LRU.empty() )
     {
-    vtkExodusIICacheRef cit( this->LRU.back() );
-    vtkDataArray* arr = cit->second->Value;
-    if ( arr )
+    if ( this->DropLeastRecentlyUsed() > 0 )
       {
       deletedSomething = 1;
-      double arrSz = (double) arr->GetActualMemorySize() / 1024.;
-      this->Size -= arrSz;
-#ifdef VTK_EXO_DBG_CACHE
-      cout << "Dropping " << VTK_EXO_PRT_KEY( cit->first ) << VTK_EXO_PRT_ARR( arr ) << "\n";
-#endif // VTK_EXO_DBG_CACHE
-      if ( this->Size <= 0 )
-        {
-        if ( this->Cache.size() == 0 )
-          this->Size = 0.;
-        else
-          this->RecomputeSize(); // oops, FP roundoff
-        }
-      }
-    else
-      {
-#ifdef VTK_EXO_DBG_CACHE
-      cout << "Dropping " << VTK_EXO_PRT_KEY( cit->first ) << VTK_EXO_PRT_ARR( arr ) << "\n";
-#endif // VTK_EXO_DBG_CACHE
       }
-
-    delete cit->second;
-    this->Cache.erase( cit );
-    this->LRU.pop_back();
-    }
-
-  if ( this->Cache.size() == 0 )
-    {
-    this->Size = 0;
     }
 
   return deletedSomething;
@@ -151,7 +168,7 @@ int vtkExodusIICache::ReduceToSize( double newSize )
 
 void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
 {
-  double vsize = value ? value->GetActualMemorySize() / 1024. : 0.;
+  vtkTypeInt64 vsize = vtkExodusIICacheArraySize( value );
 
   vtkExodusIICacheRef it = this->Cache.find( key );
   if ( it != this->Cache.end() )
@@ -159,26 +176,38 @@ void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
     if ( it->second->Value == value )
       return;
 
-    // Remove existing array and put in our new one.
-    this->Size -= vsize;
-    if ( this->Size <= 0 )
+    // Remove existing array and put in our new one, which is made most
+    // recently used first so that making space cannot drop it.
+    this->Size -= it->second->Bytes;
+    this->LRU.erase( it->second->LRUEntry );
+    it->second->LRUEntry = this->LRU.insert( this->LRU.begin(), it );
+    if ( it->second->Value )
       {
-      this->RecomputeSize();
+      it->second->Value->Delete();
       }
-    this->ReduceToSize( this->Capacity - vsize );
-    it->second->Value->Delete();
     it->second->Value = value;
-    it->second->Value->Register( 0 ); // Since we re-use the cache entry, the constructor's Register won't get called.
+    if ( value )
+      {
+      value->Register( 0 ); // Since we re-use the cache entry, the constructor's Register won't get called.
+      }
+    it->second->Bytes = vsize;
+    while ( this->Size + vsize > this->Capacity && this->LRU.size() > 1 )
+      {
+      this->DropLeastRecentlyUsed();
+      ++this->Evictions;
+      }
     this->Size += vsize;
 #ifdef VTK_EXO_DBG_CACHE
     cout << "Replacing " << VTK_EXO_PRT_KEY( it->first ) << VTK_EXO_PRT_ARR( value ) << "\n";
 #endif // VTK_EXO_DBG_CACHE
-    this->LRU.erase( it->second->LRUEntry );
-    it->second->LRUEntry = this->LRU.insert( this->LRU.begin(), it );
     }
   else
     {
-    this->ReduceToSize( this->Capacity - vsize );
+    while ( this->Size + vsize > this->Capacity && ! this->LRU.empty() )
+      {
+      this->DropLeastRecentlyUsed();
+      ++this->Evictions;
+      }
     std::pair<const vtkExodusIICacheKey,vtkExodusIICacheEntry*> entry( key, new vtkExodusIICacheEntry(value) );
     std::pair<vtkExodusIICacheSet::iterator, bool> iret = this->Cache.insert( entry );
     this->Size += vsize;
@@ -197,11 +226,13 @@ vtkDataArray*& vtkExodusIICache::Find( vtkExodusIICacheKey key )
   vtkExodusIICacheRef it = this->Cache.find( key );
   if ( it != this->Cache.end() )
     {
+    ++this->Hits;
     this->LRU.erase( it->second->LRUEntry );
     it->second->LRUEntry = this->LRU.insert( this->LRU.begin(), it );
     return it->second->Value;
     }
 
+  ++this->Misses;
   dummy = 0;
   return dummy;
 }
@@ -215,21 +246,9 @@ int vtkExodusIICache::Invalidate( vtkExodusIICacheKey key )
     cout << "Dropping " << VTK_EXO_PRT_KEY( it->first ) << VTK_EXO_PRT_ARR( it->second->Value ) << "\n";
 #endif // VTK_EXO_DBG_CACHE
     this->LRU.erase( it->second->LRUEntry );
-    if ( it->second->Value )
-      {
-      this->Size -= it->second->Value->GetActualMemorySize() / 1024.;
-      }
+    this->Size -= it->second->Bytes;
     delete it->second;
     this->Cache.erase( it );
-
-    if ( this->Size <= 0 )
-      {
-      if ( this->Cache.size() == 0 )
-        this->Size = 0.;
-      else
-        this->RecomputeSize(); // oops, FP roundoff
-      }
-
     return 1;
     }
   return 0;
@@ -252,22 +271,11 @@ int vtkExodusIICache::Invalidate( vtkExodusIICacheKey key, vtkExodusIICacheKey p
     cout << "Dropping " << VTK_EXO_PRT_KEY( it->first ) << VTK_EXO_PRT_ARR( it->second->Value ) << "\n";
 #endif // VTK_EXO_DBG_CACHE
     this->LRU.erase( it->second->LRUEntry );
-    if ( it->second->Value )
-      {
-      this->Size -= it->second->Value->GetActualMemorySize() / 1024.;
-      }
+    this->Size -= it->second->Bytes;
     vtkExodusIICacheRef tmpIt = it++;
     delete tmpIt->second;
     this->Cache.erase( tmpIt );
 
-    if ( this->Size <= 0 )
-      {
-      if ( this->Cache.size() == 0 )
-        this->Size = 0.;
-      else
-        this->RecomputeSize(); // oops, FP roundoff
-      }
-
     ++nDropped;
     }
   return nDropped;
@@ -275,13 +283,10 @@ int vtkExodusIICache::Invalidate( vtkExodusIICacheKey key, vtkExodusIICacheKey p
 
 void vtkExodusIICache::RecomputeSize()
 {
-  this->Size = 0.;
+  this->Size = 0;
   vtkExodusIICacheRef it;
   for ( it = this->Cache.begin(); it != this->Cache.end(); ++it )
     {
-    if ( it->second->Value )
-      {
-      this->Size += (double)it->second->Value->GetActualMemorySize() / 1024.;
-      }
+    this->Size += it->second->Bytes;
     }
 }
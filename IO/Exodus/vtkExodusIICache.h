@@ -120,6 +120,8 @@ public:
 
 protected:
   vtkDataArray* Value;
+  /// The number of bytes allocated by Value when it was inserted.
+  vtkTypeInt64 Bytes;
   vtkExodusIICacheLRURef LRUEntry;
 
   friend class vtkExodusIICache;
@@ -144,7 +146,22 @@ public:
     * The result is in MiB.
     */
   double GetSpaceLeft()
-    { return this->Capacity - this->Size; }
+    { return ( this->Capacity - this->Size ) / 1048576.; }
+
+  /// The capacity and the current size of the cache in bytes.
+  vtkGetMacro(Capacity,vtkTypeInt64);
+  vtkGetMacro(Size,vtkTypeInt64);
+
+  /** The number of calls to Find() that returned an array (hits) or
+    * that did not (misses) since the cache was created or the statistics
+    * were reset, and the number of arrays dropped to make space (evictions).
+    */
+  vtkGetMacro(Hits,vtkTypeInt64);
+  vtkGetMacro(Misses,vtkTypeInt64);
+  vtkGetMacro(Evictions,vtkTypeInt64);
+
+  /// Set the hit, miss and eviction counts to zero.
+  void ResetStatistics();
 
   /** Remove cache entries until the size of the cache is at or below the given size.
     * Returns a nonzero value if deletions were required.
@@ -186,14 +203,24 @@ protected:
   ~vtkExodusIICache();
 
 
-  /// Avoid (some) FP problems
+  /// Sum the sizes of the entries into Size.
   void RecomputeSize();
 
-  /// The capacity of the cache (i.e., the maximum size of all arrays it contains) in MiB.
-  double Capacity;
+  /// Remove the least recently used entry, returning its size in bytes.
+  vtkTypeInt64 DropLeastRecentlyUsed();
+
+  /// The capacity of the cache (i.e., the maximum size of all arrays it contains) in bytes.
+  vtkTypeInt64 Capacity;
+
+  /** The current size of the cache (i.e., the size of the all the arrays it currently contains) in bytes.
+    * Sizes are counted exactly, so that entries are dropped only when an
+    * insertion would really exceed the capacity.
+    */
+  vtkTypeInt64 Size;
 
-  /// The current size of the cache (i.e., the size of the all the arrays it currently contains) in MiB.
-  double Size;
+  vtkTypeInt64 Hits;
+  vtkTypeInt64 Misses;
+  vtkTypeInt64 Evictions;
 
   //BTX
   /** A least-recently-used (LRU) cache to hold arrays.
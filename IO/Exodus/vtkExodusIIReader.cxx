@@ -6360,6 +6360,21 @@ double vtkExodusIIReader::GetCacheSize()
   return this->Metadata->GetCacheSize();
 }
 
+vtkTypeInt64 vtkExodusIIReader::GetCacheHits()
+{
+  return this->Metadata->GetCache()->GetHits();
+}
+
+vtkTypeInt64 vtkExodusIIReader::GetCacheMisses()
+{
+  return this->Metadata->GetCache()->GetMisses();
+}
+
+void vtkExodusIIReader::ResetCacheStatistics()
+{
+  this->Metadata->GetCache()->ResetStatistics();
+}
+
 void vtkExodusIIReader::SetSqueezePoints(bool sp)
 {
   this->Metadata->SetSqueezePoints(sp ? 1 : 0);
@@ -666,6 +666,14 @@ public:
   // Get the size of the cache in MiB.
   double GetCacheSize();
 
+  // Description:
+  // Get the number of arrays found in the cache (hits) and read from the
+  // file because they were not (misses) since the statistics were last
+  // reset, e.g. to choose a CacheSize large enough for an animation.
+  vtkTypeInt64 GetCacheHits();
+  vtkTypeInt64 GetCacheMisses();
+  void ResetCacheStatistics();
+
   // Description:
   // Should the reader output only points used by elements in the output mesh,
   // or all the points. Outputting all the points is much faster since the
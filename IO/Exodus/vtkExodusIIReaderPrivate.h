@@ -77,6 +77,9 @@ public:
   /// Get the size of the cache in MiB.
   vtkGetMacro(CacheSize, double);
 
+  /// Get the cache of arrays, e.g. for its hit and miss counts.
+  vtkExodusIICache* GetCache() { return this->Cache; }
+
   /** Return the number of time steps in the open file.
     * You must have called RequestInformation() before
     * invoking this member function.
@@ -0,0 +1,96 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestFFMPEGWriterBackground.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that a movie encoded in the background with a short frame queue
+// is the movie encoded as the frames are written.
+
+#include "vtkFFMPEGWriter.h"
+#include "vtkImageCast.h"
+#include "vtkImageMandelbrotSource.h"
+#include "vtkImageMapToColors.h"
+#include "vtkLookupTable.h"
+#include "vtkNew.h"
+#include "vtksys/SystemTools.hxx"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+
+std::string ReadFile(const char *fileName)
+{
+  std::ifstream file(fileName, std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+}
+
+}
+
+int TestFFMPEGWriterBackground(int, char *[])
+{
+  vtkNew<vtkImageMandelbrotSource> fractal;
+  fractal->SetWholeExtent(0, 159, 0, 119, 0, 0);
+  fractal->SetOriginCX(-1.75, -1.25, 0, 0);
+  fractal->SetSizeCX(2.5, 2.5, 2, 1.5);
+
+  vtkNew<vtkImageCast> cast;
+  cast->SetInputConnection(fractal->GetOutputPort());
+  cast->SetOutputScalarTypeToUnsignedChar();
+
+  vtkNew<vtkLookupTable> table;
+  vtkNew<vtkImageMapToColors> colorize;
+  colorize->SetOutputFormatToRGB();
+  colorize->SetLookupTable(table.GetPointer());
+  colorize->SetInputConnection(cast->GetOutputPort());
+
+  const char *fileNames[2] = { "TestFFMPEGWriterForeground.avi",
+                               "TestFFMPEGWriterBackground.avi" };
+  for (int background = 0; background < 2; ++background)
+    {
+    vtkNew<vtkFFMPEGWriter> writer;
+    writer->SetInputConnection(colorize->GetOutputPort());
+    writer->SetFileName(fileNames[background]);
+    writer->SetEncodeInBackground(background != 0);
+    writer->SetMaxPendingFrames(3);
+    writer->Start();
+    for (int cc = 2; cc < 40; ++cc)
+      {
+      fractal->SetMaximumNumberOfIterations(cc);
+      table->SetTableRange(0, cc);
+      table->SetNumberOfColors(cc);
+      table->ForceBuild();
+      writer->Write();
+      }
+    writer->End();
+    if (writer->GetErrorCode())
+      {
+      cerr << "Error writing " << fileNames[background] << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  std::string foreground = ReadFile(fileNames[0]);
+  std::string background = ReadFile(fileNames[1]);
+  vtksys::SystemTools::RemoveFile(fileNames[0]);
+  vtksys::SystemTools::RemoveFile(fileNames[1]);
+  if (foreground.empty() || foreground != background)
+    {
+    cerr << "The movie encoded in the background differs" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -19,6 +19,12 @@
 #include "vtkObjectFactory.h"
 #include "vtkErrorCode.h"
 #include "vtkFFMPEGConfig.h"
+#include "vtkConditionVariable.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+
+#include <deque>
+#include <vector>
 
 extern "C" {
 #ifdef VTK_FFMPEG_HAS_OLD_HEADER
@@ -54,12 +60,20 @@ public:
 
   int Start();
   int Write(vtkImageData *id);
-  void End();
+  int End();
 
   int Dim[2];
   int FrameRate;
 
 private:
+  // Converts a frame of packed RGB rows, top row first, to the pixel
+  // format of the codec and encodes it.
+  int Encode(AVPicture *rgb);
+
+  // The background thread encodes the queued frames in order until it is
+  // asked to stop and the queue is empty.
+  static VTK_THREAD_RETURN_TYPE EncodeFrames(void *arg);
+  int StopEncoding();
 
   vtkFFMPEGWriter *Writer;
 
@@ -77,8 +91,25 @@ private:
   AVFrame *rgbInput;
   AVFrame *yuvOutput;
 
+#ifndef VTK_FFMPEG_HAS_IMG_CONVERT
+  SwsContext *convertContext;
+#endif
+
   int openedFile;
   int closedFile;
+
+  // The frames written and not yet encoded, the first one being encoded,
+  // and the buffers of the encoded frames kept for the next ones.
+  // FramesChanged is signaled when a frame is queued or encoded.
+  int maxPendingFrames;
+  vtkMultiThreader *threader;
+  int threadId;
+  vtkSimpleMutexLock framesLock;
+  vtkSimpleConditionVariable framesChanged;
+  std::deque<unsigned char*> frames;
+  std::vector<unsigned char*> freeFrames;
+  bool stop;
+  bool failed;
 };
 
 //---------------------------------------------------------------------------
@@ -99,11 +130,20 @@ vtkFFMPEGWriterInternal::vtkFFMPEGWriterInternal(vtkFFMPEGWriter *creator)
 #endif
   this->rgbInput = NULL;
   this->yuvOutput = NULL;
+#ifndef VTK_FFMPEG_HAS_IMG_CONVERT
+  this->convertContext = NULL;
+#endif
 
   this->openedFile = 0;
   this->closedFile = 1;
 
   this->FrameRate = 25;
+
+  this->maxPendingFrames = 1;
+  this->threader = vtkMultiThreader::New();
+  this->threadId = -1;
+  this->stop = false;
+  this->failed = false;
 }
 
 //---------------------------------------------------------------------------
@@ -113,6 +153,7 @@ vtkFFMPEGWriterInternal::~vtkFFMPEGWriterInternal()
     {
     this->End();
     }
+  this->threader->Delete();
 }
 
 //---------------------------------------------------------------------------
@@ -307,6 +348,19 @@ int vtkFFMPEGWriterInternal::Start()
   //The yuv buffer should get deleted when this->yuv_input is.
   avpicture_fill((AVPicture *)this->yuvOutput, yuv, c->pix_fmt, c->width, c->height);
 
+#ifndef VTK_FFMPEG_HAS_IMG_CONVERT
+  //the conversion context only depends on the size and the formats, so
+  //it is shared by all the frames
+  this->convertContext = sws_getContext(
+    c->width, c->height, PIX_FMT_RGB24,
+    c->width, c->height, c->pix_fmt,
+    SWS_BICUBIC, NULL, NULL, NULL);
+  if (!this->convertContext)
+    {
+    vtkGenericWarningMacro(<< "swscale context initialization failed");
+    return 0;
+    }
+#endif
 
   //Finally, open the file and start it off.
 #if LIBAVFORMAT_VERSION_MAJOR < 54
@@ -325,6 +379,20 @@ int vtkFFMPEGWriterInternal::Start()
 #else
   avformat_write_header(this->avFormatContext, NULL);
 #endif
+
+  if (this->Writer->GetEncodeInBackground())
+    {
+    this->maxPendingFrames = this->Writer->GetMaxPendingFrames();
+    this->stop = false;
+    this->failed = false;
+    this->threadId = this->threader->SpawnThread(
+      &vtkFFMPEGWriterInternal::EncodeFrames, this);
+    if (this->threadId < 0)
+      {
+      vtkGenericWarningMacro(<< "Could not start the encoding thread, "
+                             << "frames are encoded as they are written.");
+      }
+    }
   return 1;
 }
 
@@ -334,44 +402,77 @@ int vtkFFMPEGWriterInternal::Write(vtkImageData *id)
   this->Writer->GetInputAlgorithm(0, 0)->UpdateWholeExtent();
 
   AVCodecContext *cc = this->avStream->codec;
-
-  //copy the image from the input to the RGB buffer while flipping Y
   unsigned char *rgb = (unsigned char*)id->GetScalarPointer();
-  unsigned char *src;
+  const int rowSize = cc->width * 3;
+
+  if (this->threadId < 0)
+    {
+    //copy the image from the input to the RGB buffer while flipping Y
+    unsigned char *src;
+    for (int y = 0; y < cc->height; y++)
+      {
+      src = rgb + (cc->height-y-1) * rowSize; //flip Y
+      unsigned char *dest =
+        &this->rgbInput->data[0][y*this->rgbInput->linesize[0]];
+      memcpy((void*)dest, (void*)src, rowSize);
+      }
+    return this->Encode((AVPicture *)this->rgbInput);
+    }
+
+  //wait for room in the queue, then copy the image to a free buffer while
+  //flipping Y, so that the input can change as soon as this returns
+  unsigned char *frame = NULL;
+  this->framesLock.Lock();
+  while (!this->failed &&
+         static_cast<int>(this->frames.size()) >= this->maxPendingFrames)
+    {
+    this->framesChanged.Wait(this->framesLock);
+    }
+  if (!this->failed && !this->freeFrames.empty())
+    {
+    frame = this->freeFrames.back();
+    this->freeFrames.pop_back();
+    }
+  bool hasFailed = this->failed;
+  this->framesLock.Unlock();
+  if (hasFailed)
+    {
+    return 0;
+    }
+  if (!frame)
+    {
+    frame = new unsigned char[rowSize * cc->height];
+    }
   for (int y = 0; y < cc->height; y++)
     {
-    src = rgb + (cc->height-y-1) * cc->width * 3; //flip Y
-    unsigned char *dest =
-      &this->rgbInput->data[0][y*this->rgbInput->linesize[0]];
-    memcpy((void*)dest, (void*)src, cc->width*3);
+    memcpy(frame + y * rowSize, rgb + (cc->height-y-1) * rowSize, rowSize);
     }
 
+  this->framesLock.Lock();
+  this->frames.push_back(frame);
+  this->framesChanged.Broadcast();
+  this->framesLock.Unlock();
+  return 1;
+}
+
+//---------------------------------------------------------------------------
+int vtkFFMPEGWriterInternal::Encode(AVPicture *rgb)
+{
+  AVCodecContext *cc = this->avStream->codec;
+
   //convert that to YUV for input to the codec
 #ifdef VTK_FFMPEG_HAS_IMG_CONVERT
   img_convert((AVPicture *)this->yuvOutput, cc->pix_fmt,
-              (AVPicture *)this->rgbInput, PIX_FMT_RGB24,
+              rgb, PIX_FMT_RGB24,
               cc->width, cc->height);
 #else
   //convert that to YUV for input to the codec
-  SwsContext* convert_ctx = sws_getContext(
-    cc->width, cc->height, PIX_FMT_RGB24,
-    cc->width, cc->height, cc->pix_fmt,
-    SWS_BICUBIC, NULL, NULL, NULL);
-
-  if(convert_ctx == NULL)
-    {
-    vtkGenericWarningMacro(<< "swscale context initialization failed");
-    return 0;
-    }
-
-  int result = sws_scale(convert_ctx,
-    this->rgbInput->data, this->rgbInput->linesize,
+  int result = sws_scale(this->convertContext,
+    rgb->data, rgb->linesize,
     0, cc->height,
     this->yuvOutput->data, this->yuvOutput->linesize
     );
 
-  sws_freeContext(convert_ctx);
-
   if(!result)
     {
     vtkGenericWarningMacro(<< "sws_scale() failed");
@@ -442,8 +543,86 @@ int vtkFFMPEGWriterInternal::Write(vtkImageData *id)
 }
 
 //---------------------------------------------------------------------------
-void vtkFFMPEGWriterInternal::End()
+VTK_THREAD_RETURN_TYPE vtkFFMPEGWriterInternal::EncodeFrames(void *arg)
 {
+  vtkFFMPEGWriterInternal *self = static_cast<vtkFFMPEGWriterInternal*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg)->UserData);
+  AVCodecContext *cc = self->avStream->codec;
+
+  self->framesLock.Lock();
+  for (;;)
+    {
+    while (self->frames.empty() && !self->stop)
+      {
+      self->framesChanged.Wait(self->framesLock);
+      }
+    if (self->frames.empty())
+      {
+      break;
+      }
+    unsigned char *frame = self->frames.front();
+    bool hasFailed = self->failed;
+    self->framesLock.Unlock();
+
+    //once a frame failed, the next ones are dropped
+    int encoded = 0;
+    if (!hasFailed)
+      {
+      AVPicture rgb;
+      avpicture_fill(&rgb, frame, PIX_FMT_RGB24, cc->width, cc->height);
+      encoded = self->Encode(&rgb);
+      }
+
+    self->framesLock.Lock();
+    self->frames.pop_front();
+    self->freeFrames.push_back(frame);
+    if (!encoded)
+      {
+      self->failed = true;
+      }
+    self->framesChanged.Broadcast();
+    }
+  self->framesLock.Unlock();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//---------------------------------------------------------------------------
+int vtkFFMPEGWriterInternal::StopEncoding()
+{
+  if (this->threadId < 0)
+    {
+    return 1;
+    }
+
+  //the thread encodes the frames left in the queue before it exits
+  this->framesLock.Lock();
+  this->stop = true;
+  this->framesChanged.Broadcast();
+  this->framesLock.Unlock();
+  this->threader->TerminateThread(this->threadId);
+  this->threadId = -1;
+
+  for (size_t i = 0; i < this->freeFrames.size(); ++i)
+    {
+    delete [] this->freeFrames[i];
+    }
+  this->freeFrames.clear();
+  return this->failed ? 0 : 1;
+}
+
+//---------------------------------------------------------------------------
+int vtkFFMPEGWriterInternal::End()
+{
+  int result = this->StopEncoding();
+
+#ifndef VTK_FFMPEG_HAS_IMG_CONVERT
+  if (this->convertContext)
+    {
+    sws_freeContext(this->convertContext);
+    this->convertContext = NULL;
+    }
+#endif
+
   if (this->yuvOutput)
     {
     av_free(this->yuvOutput->data[0]);
@@ -499,6 +678,7 @@ void vtkFFMPEGWriterInternal::End()
     }
 
   this->closedFile = 1;
+  return result;
 }
 
 
@@ -514,6 +694,8 @@ vtkFFMPEGWriter::vtkFFMPEGWriter()
   this->Rate = 25;
   this->BitRate = 0;
   this->BitRateTolerance = 0;
+  this->EncodeInBackground = false;
+  this->MaxPendingFrames = 2;
 }
 
 //---------------------------------------------------------------------------
@@ -613,7 +795,12 @@ void vtkFFMPEGWriter::Write()
 //---------------------------------------------------------------------------
 void vtkFFMPEGWriter::End()
 {
-  this->Internals->End();
+  if (!this->Internals->End() && !this->Error)
+    {
+    vtkErrorMacro("Error storing image.");
+    this->Error = 1;
+    this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+    }
 
   delete this->Internals;
   this->Internals = 0;
@@ -628,4 +815,7 @@ void vtkFFMPEGWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Rate: " << this->Rate << endl;
   os << indent << "BitRate: " << this->BitRate << endl;
   os << indent << "BitRateTolerance: " << this->BitRateTolerance << endl;
+  os << indent << "EncodeInBackground: "
+     << (this->EncodeInBackground?"true":"false") << endl;
+  os << indent << "MaxPendingFrames: " << this->MaxPendingFrames << endl;
 }
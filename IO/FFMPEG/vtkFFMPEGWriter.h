@@ -78,6 +78,24 @@ public:
   vtkSetMacro(BitRateTolerance, int);
   vtkGetMacro(BitRateTolerance, int);
 
+  // Description:
+  // Turns on or off (the default) encoding in a background thread.
+  // When on, Write() only copies the frame to a queue, and the colour
+  // conversion and the encoding are done by the thread, in order.
+  // End() waits for the queued frames to be written. An error found
+  // while encoding a frame is reported by the next Write() or by End().
+  // Must be set before the first Write() of a movie.
+  vtkSetMacro(EncodeInBackground, bool);
+  vtkGetMacro(EncodeInBackground, bool);
+  vtkBooleanMacro(EncodeInBackground, bool);
+
+  // Description:
+  // Set/Get the number of frames that may wait for encoding in the
+  // background, counting the one being encoded. Write() blocks while the
+  // queue is full. 2 by default.
+  vtkSetClampMacro(MaxPendingFrames, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaxPendingFrames, int);
+
 protected:
   vtkFFMPEGWriter();
   ~vtkFFMPEGWriter();
@@ -90,6 +108,8 @@ protected:
   int BitRate;
   int BitRateTolerance;
   bool Compression;
+  bool EncodeInBackground;
+  int MaxPendingFrames;
 
 private:
   vtkFFMPEGWriter(const vtkFFMPEGWriter&); // Not implemented
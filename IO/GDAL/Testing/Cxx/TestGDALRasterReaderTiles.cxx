@@ -0,0 +1,124 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGDALRasterReaderTiles.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that the parts of a raster asked for by update extents, read with
+// and without the tile cache, give the pixels of the whole raster.
+
+#include "vtkGDALRasterReader.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkTIFFWriter.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <string>
+
+namespace
+{
+
+bool CompareExtent(vtkImageData *expected, vtkGDALRasterReader *reader,
+                   int *extent, const char *what)
+{
+  reader->UpdateExtent(extent);
+  vtkImageData *read = reader->GetOutput();
+  int *readExtent = read->GetExtent();
+  for (int i = 0; i < 4; ++i)
+    {
+    if (readExtent[i] != extent[i])
+      {
+      cerr << what << ": wrong extent" << endl;
+      return false;
+      }
+    }
+  for (int y = extent[2]; y <= extent[3]; ++y)
+    {
+    for (int x = extent[0]; x <= extent[1]; ++x)
+      {
+      if (read->GetScalarComponentAsDouble(x, y, 0, 0) !=
+          expected->GetScalarComponentAsDouble(x, y, 0, 0))
+        {
+        cerr << what << ": pixel (" << x << ", " << y << ") differs" << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+}
+
+int TestGDALRasterReaderTiles(int argc, char *argv[])
+{
+  char *tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/GDALRasterReaderTiles.tif";
+  delete [] tempDir;
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(300, 200, 1);
+  vtkNew<vtkUnsignedCharArray> scalars;
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    scalars->SetValue(i, static_cast<unsigned char>((11 * i + i / 300) % 251));
+    }
+  image->GetPointData()->SetScalars(scalars.GetPointer());
+  vtkNew<vtkTIFFWriter> writer;
+  writer->SetInputData(image.GetPointer());
+  writer->SetFileName(fileName.c_str());
+  writer->Write();
+
+  vtkNew<vtkGDALRasterReader> wholeReader;
+  wholeReader->SetFileName(fileName.c_str());
+  wholeReader->Update();
+  vtkImageData *expected = wholeReader->GetOutput();
+  if (!expected->GetPointData()->GetScalars() ||
+      expected->GetNumberOfPoints() != 300 * 200)
+    {
+    cerr << "Wrong whole raster" << endl;
+    return EXIT_FAILURE;
+    }
+
+  int first[6] = { 37, 250, 11, 160, 0, 0 };
+  int panned[6] = { 101, 299, 60, 199, 0, 0 };
+  vtkNew<vtkGDALRasterReader> reader;
+  reader->SetFileName(fileName.c_str());
+  if (!CompareExtent(expected, reader.GetPointer(), first, "Update extent") ||
+      !CompareExtent(expected, reader.GetPointer(), panned, "Panned extent"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  reader->SetTileCacheCapacity(0.05);
+  reader->SetTileSize(64);
+  if (!CompareExtent(expected, reader.GetPointer(), first, "Tiles") ||
+      !CompareExtent(expected, reader.GetPointer(), panned, "Cached tiles"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // without overviews, the full resolution raster is reduced
+  reader->UseOverviewsOn();
+  reader->SetTargetDimensions(150, 100);
+  reader->Update();
+  if (reader->GetOverviewLevel() != 0 ||
+      reader->GetOutput()->GetNumberOfPoints() <= 0)
+    {
+    cerr << "Wrong reduced raster" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
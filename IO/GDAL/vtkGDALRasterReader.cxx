@@ -42,8 +42,13 @@
 #include <ogr_spatialref.h>
 
 // C/C++ includes
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <list>
+#include <map>
 #include <vector>
 
 vtkStandardNewMacro(vtkGDALRasterReader);
@@ -84,12 +89,62 @@ public:
 
   const double* GetGeoCornerPoints();
 
+  int SelectOverviewLevel(GDALRasterBand* band) const;
+  CPLErr ReadBand(GDALRasterBand* band, GByte* buffer);
+  const GByte* GetTile(GDALRasterBand* levelBand, int bandNumber, int level,
+                       int tileX, int tileY);
+  void ReleaseTiles();
+
   int NumberOfBands;
   int NumberOfBytesPerPixel;
 
   int SourceOffset[2];
   int SourceDimensions[2];
 
+  // Window of the raster read by ReadData, and the size and position of
+  // the image it is decoded to within the target grid.
+  int ReadOffset[2];
+  int ReadDimensions[2];
+  int DestOffset[2];
+  int DestDimensions[2];
+
+  // Decoded tiles, most recently used first.
+  struct TileKey
+  {
+    int Band;
+    int Level;
+    int X;
+    int Y;
+
+    bool operator<(const TileKey& other) const
+      {
+      if (this->Band != other.Band)
+        {
+        return this->Band < other.Band;
+        }
+      if (this->Level != other.Level)
+        {
+        return this->Level < other.Level;
+        }
+      if (this->Y != other.Y)
+        {
+        return this->Y < other.Y;
+        }
+      return this->X < other.X;
+      }
+  };
+  typedef std::list<TileKey> TileListType;
+  struct Tile
+  {
+    std::vector<GByte> Data;
+    TileListType::iterator Use;
+  };
+  typedef std::map<TileKey, Tile> TileMapType;
+  TileMapType Tiles;
+  TileListType TileUse;
+  size_t TileBytes;
+  int CachedTileSize;
+
   std::string PrevReadFileName;
 
   GDALDataset* GDALData;
@@ -113,6 +168,8 @@ vtkGDALRasterReader::vtkGDALRasterReaderInternal::vtkGDALRasterReaderInternal(
   vtkGDALRasterReader* reader) :
   NumberOfBands(0),
   NumberOfBytesPerPixel(0),
+  TileBytes(0),
+  CachedTileSize(0),
   GDALData(0),
   TargetDataType(GDT_Byte),
   BadCornerPoint(-1),
@@ -120,10 +177,15 @@ vtkGDALRasterReader::vtkGDALRasterReaderInternal::vtkGDALRasterReaderInternal(
   UniformGridData(0),
   Reader(reader)
 {
-  this->SourceOffset[0] = 0;
-  this->SourceOffset[1] = 0;
-  this->SourceDimensions[0] = 0;
-  this->SourceDimensions[1] = 0;
+  for (int i = 0; i < 2; ++i)
+    {
+    this->SourceOffset[i] = 0;
+    this->SourceDimensions[i] = 0;
+    this->ReadOffset[i] = 0;
+    this->ReadDimensions[i] = 0;
+    this->DestOffset[i] = 0;
+    this->DestDimensions[i] = 0;
+    }
 
   for (int i = 0; i < 8; ++i)
     {
@@ -198,6 +260,13 @@ void vtkGDALRasterReader::vtkGDALRasterReaderInternal::ReadData(
     return;
     }
 
+  if (this->Reader->TileCacheCapacity <= 0.0 ||
+      this->Reader->TileSize != this->CachedTileSize)
+    {
+    this->ReleaseTiles();
+    }
+  this->CachedTileSize = this->Reader->TileSize;
+
   for (int i = 1; i <= this->NumberOfBands; ++i)
     {
     GDALRasterBand* rasterBand = this->GDALData->GetRasterBand(i);
@@ -330,105 +399,46 @@ void vtkGDALRasterReader::vtkGDALRasterReaderInternal::GenericReadData()
       }
     }
 
-  const int& destWidth = this->Reader->TargetDimensions[0];
-  const int& destHeight = this->Reader->TargetDimensions[1];
-
-  // GDAL top left is at 0,0
-  const int& windowX = this->SourceOffset[0];
-  const int& windowY = this->SourceOffset[1];
-  const int& windowWidth = this->SourceDimensions[0];
-  const int& windowHeight = this->SourceDimensions[1];
+  const int& destWidth = this->DestDimensions[0];
+  const int& destHeight = this->DestDimensions[1];
 
   const int& pixelSpace = this->NumberOfBytesPerPixel;
-  const int lineSpace = destWidth * pixelSpace;
   const int bandSpace = destWidth * destHeight * this->NumberOfBytesPerPixel;
-  CPLErr err;
+  CPLErr err = CE_None;
 
   // TODO: Support other band types
+  GDALRasterBand* bands[4] = { 0, 0, 0, 0 };
+  int numberOfComponents = 0;
   if (redBand && greenBand && blueBand)
     {
-    if (alphaBand)
-      {
-      this->Reader->SetNumberOfScalarComponents(4);
-      rawUniformGridData.resize(4 * destWidth * destHeight * pixelSpace);
-
-      err = redBand->RasterIO(
-              GF_Read, windowX, windowY,  windowWidth, windowHeight,
-              static_cast<void*>(reinterpret_cast<GByte*>(&rawUniformGridData[0]) +
-              0 * bandSpace), destWidth, destHeight,
-              this->TargetDataType, pixelSpace, lineSpace);
-      err = greenBand->RasterIO(
-              GF_Read, windowX, windowY,  windowWidth, windowHeight,
-              static_cast<void*>(reinterpret_cast<GByte*>(&rawUniformGridData[0]) +
-              1 * bandSpace), destWidth, destHeight,
-              this->TargetDataType, pixelSpace, lineSpace);
-      err = blueBand->RasterIO(
-              GF_Read, windowX, windowY,  windowWidth, windowHeight,
-              static_cast<void*>(reinterpret_cast<GByte*>(&rawUniformGridData[0]) +
-              2 * bandSpace), destWidth, destHeight,
-              this->TargetDataType, pixelSpace, lineSpace);
-      err = alphaBand->RasterIO(
-              GF_Read, windowX, windowY,  windowWidth, windowHeight,
-              static_cast<void*>(reinterpret_cast<GByte*>(&rawUniformGridData[0]) +
-              3 * bandSpace), destWidth, destHeight,
-              this->TargetDataType, pixelSpace, lineSpace);
-      }
-    else
-      {
-      this->Reader->SetNumberOfScalarComponents(3);
-      rawUniformGridData.resize(3 * destWidth * destHeight * pixelSpace);
-
-      err = redBand->RasterIO(
-              GF_Read, windowX, windowY,  windowWidth, windowHeight,
-              static_cast<void*>(reinterpret_cast<GByte*>(&rawUniformGridData[0]) +
-              0 * bandSpace), destWidth, destHeight,
-              this->TargetDataType, 0, 0);
-      err = greenBand->RasterIO(GF_Read, windowX, windowY,  windowWidth, windowHeight,
-              static_cast<void*>(reinterpret_cast<GByte*>(&rawUniformGridData[0]) +
-              1 * bandSpace), destWidth, destHeight,
-              this->TargetDataType, 0,0);
-      err = blueBand->RasterIO(GF_Read, windowX, windowY,  windowWidth, windowHeight,
-              static_cast<void*>(reinterpret_cast<GByte*>(&rawUniformGridData[0]) +
-              2 * bandSpace), destWidth, destHeight,
-              this->TargetDataType, 0,0);
-      }
+    bands[numberOfComponents++] = redBand;
+    bands[numberOfComponents++] = greenBand;
+    bands[numberOfComponents++] = blueBand;
     }
   else if (greyBand)
     {
-    if (alphaBand)
-      {
-      // Luminance alpha
-      this->Reader->SetNumberOfScalarComponents(2);
-      rawUniformGridData.resize(2 * destWidth * destHeight * pixelSpace);
-
-      err = greyBand->RasterIO(
-              GF_Read, windowX, windowY,  windowWidth, windowHeight,
-              static_cast<void*>(reinterpret_cast<GByte*>(&rawUniformGridData[0]) +
-              0 * bandSpace), destWidth, destHeight,
-              this->TargetDataType, pixelSpace, lineSpace);
-      err =  alphaBand->RasterIO(
-               GF_Read, windowX, windowY,  windowWidth, windowHeight,
-               static_cast<void*>(reinterpret_cast<GByte*>(&rawUniformGridData[0]) +
-               1 * bandSpace), destWidth, destHeight,
-               this->TargetDataType, pixelSpace, lineSpace);
-      }
-    else
-      {
-      // Luminance
-      this->Reader->SetNumberOfScalarComponents(1);
-      rawUniformGridData.resize(destWidth * destHeight * pixelSpace);
-      err = greyBand->RasterIO(
-              GF_Read, windowX, windowY,  windowWidth, windowHeight,
-              static_cast<void*>(reinterpret_cast<GByte*>(&rawUniformGridData[0]) +
-              0 * bandSpace), destWidth, destHeight,
-              this->TargetDataType, pixelSpace, lineSpace);
-      }
+    // Luminance
+    bands[numberOfComponents++] = greyBand;
     }
   else
     {
     std::cerr << "Unknown raster band type \n";
     return;
     }
+  if (alphaBand)
+    {
+    bands[numberOfComponents++] = alphaBand;
+    }
+
+  this->Reader->OverviewLevel = this->SelectOverviewLevel(bands[0]);
+  this->Reader->SetNumberOfScalarComponents(numberOfComponents);
+  rawUniformGridData.resize(
+    numberOfComponents * destWidth * destHeight * pixelSpace);
+  for (int c = 0; c < numberOfComponents && err == CE_None; ++c)
+    {
+    err = this->ReadBand(bands[c],
+      reinterpret_cast<GByte*>(&rawUniformGridData[0]) + c * bandSpace);
+    }
   ((void)err);//unused
   assert(err == CE_None);
 
@@ -438,7 +448,9 @@ void vtkGDALRasterReader::vtkGDALRasterReaderInternal::GenericReadData()
                          1};
 
   // Set meta data on the image
-  this->UniformGridData->SetExtent(0, (destWidth - 1), 0, (destHeight - 1), 0, 0);
+  this->UniformGridData->SetExtent(
+    this->DestOffset[0], this->DestOffset[0] + destWidth - 1,
+    this->DestOffset[1], this->DestOffset[1] + destHeight - 1, 0, 0);
   this->UniformGridData->SetSpacing(geoSpacing[0], geoSpacing[1], geoSpacing[2]);
   this->UniformGridData->SetOrigin(d[0], d[1], 0);
   this->Convert<VTK_TYPE, RAW_TYPE>(rawUniformGridData, destWidth, destHeight);
@@ -447,10 +459,171 @@ void vtkGDALRasterReader::vtkGDALRasterReaderInternal::GenericReadData()
 //----------------------------------------------------------------------------
 void vtkGDALRasterReader::vtkGDALRasterReaderInternal::ReleaseData()
 {
+  this->ReleaseTiles();
   delete this->GDALData;
   this->GDALData = 0;
 }
 
+//-----------------------------------------------------------------------------
+int vtkGDALRasterReader::vtkGDALRasterReaderInternal::SelectOverviewLevel(
+  GDALRasterBand* band) const
+{
+  if (!this->Reader->UseOverviews || !band)
+    {
+    return 0;
+    }
+
+  // The reduction of the window asked for by the target dimensions.
+  const double factor = std::min(
+    static_cast<double>(this->ReadDimensions[0]) / this->DestDimensions[0],
+    static_cast<double>(this->ReadDimensions[1]) / this->DestDimensions[1]);
+
+  // Take the coarsest overview that is not coarser than asked for, with
+  // some tolerance for overviews whose sizes are rounded down.
+  int level = 0;
+  double levelFactor = 1.0;
+  for (int i = 0; i < band->GetOverviewCount(); ++i)
+    {
+    GDALRasterBand* overview = band->GetOverview(i);
+    if (!overview || overview->GetXSize() <= 0)
+      {
+      continue;
+      }
+    double overviewFactor =
+      static_cast<double>(this->Reader->RasterDimensions[0]) /
+      overview->GetXSize();
+    if (overviewFactor > levelFactor && overviewFactor <= 1.01 * factor)
+      {
+      level = i + 1;
+      levelFactor = overviewFactor;
+      }
+    }
+  return level;
+}
+
+//-----------------------------------------------------------------------------
+CPLErr vtkGDALRasterReader::vtkGDALRasterReaderInternal::ReadBand(
+  GDALRasterBand* band, GByte* buffer)
+{
+  int level = this->Reader->OverviewLevel;
+  GDALRasterBand* levelBand = (level > 0) ? band->GetOverview(level - 1) : band;
+  if (!levelBand)
+    {
+    level = 0;
+    levelBand = band;
+    }
+
+  // The window in the pixels of the level.
+  const int levelWidth = levelBand->GetXSize();
+  const int levelHeight = levelBand->GetYSize();
+  const double scaleX =
+    static_cast<double>(levelWidth) / this->Reader->RasterDimensions[0];
+  const double scaleY =
+    static_cast<double>(levelHeight) / this->Reader->RasterDimensions[1];
+  const int x0 = std::min(levelWidth - 1,
+    static_cast<int>(floor(this->ReadOffset[0] * scaleX)));
+  const int y0 = std::min(levelHeight - 1,
+    static_cast<int>(floor(this->ReadOffset[1] * scaleY)));
+  const int width = std::max(1, std::min(levelWidth, static_cast<int>(
+    ceil((this->ReadOffset[0] + this->ReadDimensions[0]) * scaleX))) - x0);
+  const int height = std::max(1, std::min(levelHeight, static_cast<int>(
+    ceil((this->ReadOffset[1] + this->ReadDimensions[1]) * scaleY))) - y0);
+
+  const int* dest = this->DestDimensions;
+  if (this->Reader->TileCacheCapacity <= 0.0)
+    {
+    return levelBand->RasterIO(GF_Read, x0, y0, width, height, buffer,
+                               dest[0], dest[1], this->TargetDataType, 0, 0);
+    }
+
+  // Sample the nearest pixels of the window from the cached tiles.
+  const int tileSize = this->CachedTileSize;
+  const int pixelSize = this->NumberOfBytesPerPixel;
+  const int bandNumber = band->GetBand();
+  for (int j = 0; j < dest[1]; ++j)
+    {
+    const int y = y0 + static_cast<int>((j + 0.5) * height / dest[1]);
+    const GByte* tile = 0;
+    int tileX = -1;
+    for (int i = 0; i < dest[0]; ++i)
+      {
+      const int x = x0 + static_cast<int>((i + 0.5) * width / dest[0]);
+      if (x / tileSize != tileX)
+        {
+        tileX = x / tileSize;
+        tile = this->GetTile(levelBand, bandNumber, level, tileX, y / tileSize);
+        if (!tile)
+          {
+          return CE_Failure;
+          }
+        }
+      memcpy(buffer, tile + ((y % tileSize) * tileSize + x % tileSize) *
+             pixelSize, pixelSize);
+      buffer += pixelSize;
+      }
+    }
+  return CE_None;
+}
+
+//-----------------------------------------------------------------------------
+const GByte* vtkGDALRasterReader::vtkGDALRasterReaderInternal::GetTile(
+  GDALRasterBand* levelBand, int bandNumber, int level, int tileX, int tileY)
+{
+  TileKey key;
+  key.Band = bandNumber;
+  key.Level = level;
+  key.X = tileX;
+  key.Y = tileY;
+  TileMapType::iterator found = this->Tiles.find(key);
+  if (found != this->Tiles.end())
+    {
+    this->TileUse.splice(this->TileUse.begin(), this->TileUse,
+                         found->second.Use);
+    return &found->second.Data[0];
+    }
+
+  // Tiles at the right and bottom borders are partly filled.
+  const int tileSize = this->CachedTileSize;
+  const int pixelSize = this->NumberOfBytesPerPixel;
+  const int x = tileX * tileSize;
+  const int y = tileY * tileSize;
+  const int width = std::min(tileSize, levelBand->GetXSize() - x);
+  const int height = std::min(tileSize, levelBand->GetYSize() - y);
+  std::vector<GByte> data(
+    static_cast<size_t>(tileSize) * tileSize * pixelSize);
+  if (levelBand->RasterIO(GF_Read, x, y, width, height, &data[0],
+                          width, height, this->TargetDataType,
+                          pixelSize, tileSize * pixelSize) != CE_None)
+    {
+    return 0;
+    }
+
+  Tile& tile = this->Tiles[key];
+  tile.Data.swap(data);
+  this->TileUse.push_front(key);
+  tile.Use = this->TileUse.begin();
+  this->TileBytes += tile.Data.size();
+
+  // Drop the least recently used tiles, but never the one just read.
+  const double capacity = this->Reader->TileCacheCapacity * 1048576.0;
+  while (this->TileBytes > capacity && this->TileUse.size() > 1)
+    {
+    TileMapType::iterator last = this->Tiles.find(this->TileUse.back());
+    this->TileBytes -= last->second.Data.size();
+    this->Tiles.erase(last);
+    this->TileUse.pop_back();
+    }
+  return &tile.Data[0];
+}
+
+//-----------------------------------------------------------------------------
+void vtkGDALRasterReader::vtkGDALRasterReaderInternal::ReleaseTiles()
+{
+  this->Tiles.clear();
+  this->TileUse.clear();
+  this->TileBytes = 0;
+}
+
 //-----------------------------------------------------------------------------
 template <typename VTK_TYPE, typename RAW_TYPE>
 void vtkGDALRasterReader::vtkGDALRasterReaderInternal::Convert(
@@ -595,6 +768,10 @@ void vtkGDALRasterReader::PrintSelf(std::ostream& os, vtkIndent indent)
     this->TargetDimensions[0] << indent << this->TargetDimensions[1] << "\n";
   os << indent << "TargetDimensions: " <<
     this->RasterDimensions[0] << indent << this->RasterDimensions[1] << "\n";
+  os << indent << "UseOverviews: " << this->UseOverviews << "\n";
+  os << indent << "OverviewLevel: " << this->OverviewLevel << "\n";
+  os << indent << "TileCacheCapacity: " << this->TileCacheCapacity << "\n";
+  os << indent << "TileSize: " << this->TileSize << "\n";
   os << indent << "DomainMetaData: " << this->DomainMetaData << "\n";
   os << indent << "DriverShortName: " << this->DriverShortName << "\n";
   os << indent << "DriverLongName: " << this->DriverLongName << "\n";
@@ -647,6 +824,11 @@ vtkGDALRasterReader::vtkGDALRasterReader() : vtkImageReader2(),
 
   this->RasterDimensions[0] = -1;
   this->RasterDimensions[1] = -1;
+
+  this->UseOverviews = 0;
+  this->OverviewLevel = 0;
+  this->TileCacheCapacity = 0.0;
+  this->TileSize = 256;
 }
 
 //-----------------------------------------------------------------------------
@@ -729,6 +911,43 @@ int vtkGDALRasterReader::RequestData(vtkInformation* vtkNotUsed(request),
     vtkWarningMacro( << "Invalid target dimensions")
     }
 
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  if (!outInfo)
+    {
+    return 0;
+    }
+
+  // Read the part of the data extent that is asked for, at the resolution
+  // of the target dimensions.
+  int updateExtent[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), updateExtent);
+  for (int i = 0; i < 2; ++i)
+    {
+    int first = this->DataExtent[2 * i];
+    int last = this->DataExtent[2 * i + 1];
+    if (updateExtent[2 * i] > updateExtent[2 * i + 1])
+      {
+      updateExtent[2 * i] = first;
+      updateExtent[2 * i + 1] = last;
+      }
+    updateExtent[2 * i] = vtkMath::ClampValue(updateExtent[2 * i], first, last);
+    updateExtent[2 * i + 1] =
+      vtkMath::ClampValue(updateExtent[2 * i + 1], first, last);
+
+    int sourceDimension = std::max(1, this->Implementation->SourceDimensions[i]);
+    int targetDimension = this->TargetDimensions[i] > 0 ?
+      this->TargetDimensions[i] : sourceDimension;
+    double scale = static_cast<double>(targetDimension) / sourceDimension;
+    int offset = updateExtent[2 * i] - first;
+    int dimension = updateExtent[2 * i + 1] - updateExtent[2 * i] + 1;
+    this->Implementation->ReadOffset[i] =
+      this->Implementation->SourceOffset[i] + offset;
+    this->Implementation->ReadDimensions[i] = dimension;
+    this->Implementation->DestOffset[i] = vtkMath::Floor(offset * scale);
+    this->Implementation->DestDimensions[i] =
+      std::max(1, vtkMath::Round(dimension * scale));
+    }
+
   this->Implementation->ReadData(this->FileName);
   if (!this->Implementation->GDALData)
     {
@@ -780,12 +999,6 @@ int vtkGDALRasterReader::RequestData(vtkInformation* vtkNotUsed(request),
 
   // Check if file has been changed here.
   // If changed then throw the vtxId time and load a new one.
-  vtkInformation* outInfo = outputVector->GetInformationObject(0);
-  if (!outInfo)
-    {
-    return 0;
-    }
-
   vtkDataObject* dataObj = outInfo->Get(vtkDataObject::DATA_OBJECT());
   if (!dataObj)
     {
@@ -67,6 +67,32 @@ public:
   // Get raster width and heigth
   vtkGetVector2Macro(RasterDimensions, int);
 
+  // Description:
+  // When on, read the GDAL overview whose resolution best matches the
+  // target dimensions rather than reducing the full resolution raster.
+  // Off by default.
+  vtkSetMacro(UseOverviews, int);
+  vtkGetMacro(UseOverviews, int);
+  vtkBooleanMacro(UseOverviews, int);
+
+  // Description:
+  // Return the overview level used by the last read, 0 being the full
+  // resolution raster.
+  vtkGetMacro(OverviewLevel, int);
+
+  // Description:
+  // Set the capacity, in MiB, of the cache of decoded tiles kept between
+  // updates, so that panning or zooming over a raster only decodes the
+  // tiles that were not read before.  0, the default, disables the cache.
+  vtkSetClampMacro(TileCacheCapacity, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(TileCacheCapacity, double);
+
+  // Description:
+  // Set the width and height, in pixels, of the cached tiles.  256 by
+  // default.
+  vtkSetClampMacro(TileSize, int, 16, VTK_INT_MAX);
+  vtkGetMacro(TileSize, int);
+
   //BTX
   // Description:
   // Return metadata as reported by GDAL
@@ -106,6 +132,10 @@ protected:
 protected:
   int TargetDimensions[2];
   int RasterDimensions[2];
+  int UseOverviews;
+  int OverviewLevel;
+  double TileCacheCapacity;
+  int TileSize;
   std::string Projection;
   std::string DomainMetaData;
   std::string DriverShortName;
@@ -0,0 +1,108 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOpenFOAMReaderParallelFields.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that the fields of an OpenFOAM case read with ReadFieldsInParallel
+// are the fields read one file at a time.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkOpenFOAMReader.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+
+bool CompareData(vtkFieldData *expected, vtkFieldData *read)
+{
+  if (read->GetNumberOfArrays() != expected->GetNumberOfArrays())
+    {
+    cerr << "Wrong number of arrays" << endl;
+    return false;
+    }
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+    {
+    vtkDataArray *expectedArray = expected->GetArray(a);
+    vtkDataArray *readArray = read->GetArray(expectedArray->GetName());
+    if (!readArray ||
+        readArray->GetNumberOfTuples() != expectedArray->GetNumberOfTuples() ||
+        readArray->GetNumberOfComponents() !=
+        expectedArray->GetNumberOfComponents())
+      {
+      cerr << "Wrong array " << expectedArray->GetName() << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < expectedArray->GetNumberOfTuples(); ++i)
+      {
+      for (int c = 0; c < expectedArray->GetNumberOfComponents(); ++c)
+        {
+        if (readArray->GetComponent(i, c) != expectedArray->GetComponent(i, c))
+          {
+          cerr << expectedArray->GetName() << " differs at tuple " << i
+               << endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+}
+
+int TestOpenFOAMReaderParallelFields(int argc, char *argv[])
+{
+  char *fileName = vtkTestUtilities::ExpandDataFileName(
+    argc, argv, "Data/OpenFOAM/cavity/cavity.foam");
+
+  vtkNew<vtkOpenFOAMReader> serialReader;
+  serialReader->SetFileName(fileName);
+  vtkNew<vtkOpenFOAMReader> reader;
+  reader->SetFileName(fileName);
+  reader->ReadFieldsInParallelOn();
+  delete [] fileName;
+
+  double times[2] = { 0.5, 2.5 };
+  for (int t = 0; t < 2; ++t)
+    {
+    for (int createPointData = 0; createPointData < 2; ++createPointData)
+      {
+      serialReader->SetCreateCellToPoint(createPointData);
+      serialReader->UpdateTimeStep(times[t]);
+      reader->SetCreateCellToPoint(createPointData);
+      reader->UpdateTimeStep(times[t]);
+      vtkUnstructuredGrid *expected = vtkUnstructuredGrid::SafeDownCast(
+        serialReader->GetOutput()->GetBlock(0));
+      vtkUnstructuredGrid *read = vtkUnstructuredGrid::SafeDownCast(
+        reader->GetOutput()->GetBlock(0));
+      if (!expected || !read ||
+          expected->GetCellData()->GetNumberOfArrays() == 0)
+        {
+        cerr << "No internal mesh at time " << times[t] << endl;
+        return EXIT_FAILURE;
+        }
+      if (!CompareData(expected->GetCellData(), read->GetCellData()) ||
+          !CompareData(expected->GetPointData(), read->GetPointData()))
+        {
+        cerr << "Wrong fields at time " << times[t] << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -80,6 +80,7 @@
 #include "vtkPolygon.h"
 #include "vtkPyramid.h"
 #include "vtkQuad.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -142,6 +143,8 @@ template <typename T> struct vtkFoamReadValue;
 struct vtkFoamEntryValue;
 struct vtkFoamEntry;
 struct vtkFoamDict;
+struct vtkFoamFieldFile;
+class vtkFoamFieldFileReader;
 
 //-----------------------------------------------------------------------------
 // class vtkOpenFOAMReaderPrivate
@@ -171,6 +174,8 @@ public:
       const vtkStdString &, vtkOpenFOAMReaderPrivate *);
 
 private:
+  friend class vtkFoamFieldFileReader;
+
   struct vtkFoamBoundaryEntry
     {
     enum bt
@@ -317,12 +322,13 @@ private:
   void ConstructDimensions(vtkStdString *, vtkFoamDict *);
   bool ReadFieldFile(vtkFoamIOobject *, vtkFoamDict *, const vtkStdString &,
       vtkDataArraySelection *);
+  void ReadFieldFiles(std::vector<vtkFoamFieldFile *> &);
   vtkFloatArray *FillField(vtkFoamEntry *, int, vtkFoamIOobject *,
       const vtkStdString &);
   void GetVolFieldAtTimeStep(vtkUnstructuredGrid *, vtkMultiBlockDataSet *,
-      const vtkStdString &);
+      const vtkStdString &, vtkFoamFieldFile *);
   void GetPointFieldAtTimeStep(vtkUnstructuredGrid *, vtkMultiBlockDataSet *,
-      const vtkStdString &);
+      const vtkStdString &, vtkFoamFieldFile *);
   void AddArrayToFieldData(vtkDataSetAttributes *, vtkDataArray *,
       const vtkStdString &);
 
@@ -809,6 +815,9 @@ private:
   void ThrowUnexpectedNondigitCharExecption(const int c);
   void ThrowUnexpectedTokenException(const char, const int c);
   int ReadNext();
+  void SkipBufferedSpaces();
+  bool ScanIntValue(int &value);
+  bool ScanFloatValue(float &value);
 
   void PutBack(const int c)
   {
@@ -1557,10 +1566,173 @@ int vtkFoamFile::ReadNext()
   return *this->Superclass::BufPtr++;
 }
 
+// fast exponent multiplication!
+static inline double vtkFoamExponentScale(int eval)
+{
+  double scale = 1.0;
+  while (eval >= 64)
+    {
+    scale *= 1.0e+64;
+    eval -= 64;
+    }
+  while (eval >= 16)
+    {
+    scale *= 1.0e+16;
+    eval -= 16;
+    }
+  while (eval >= 4)
+    {
+    scale *= 1.0e+4;
+    eval -= 4;
+    }
+  while (eval >= 1)
+    {
+    scale *= 1.0e+1;
+    eval -= 1;
+    }
+  return scale;
+}
+
+// skips the white spaces in the buffer, counting the lines
+void vtkFoamFile::SkipBufferedSpaces()
+{
+  unsigned char *ptr = this->Superclass::BufPtr;
+  while (ptr < this->Superclass::BufEndPtr && isspace(*ptr))
+    {
+    if (*ptr == '\n')
+      {
+      ++this->Superclass::LineNumber;
+#if VTK_FOAMFILE_RECOGNIZE_LINEHEAD
+      this->Superclass::WasNewline = true;
+#endif
+      }
+    ++ptr;
+    }
+  this->Superclass::BufPtr = ptr;
+}
+
+// scans an integer value directly in the buffer, sparing the end of
+// buffer check of Getc() for each character. returns false, leaving the
+// buffer at the start of the value, when the value may continue past the
+// end of the buffer or does not start with a digit, so that
+// ReadIntValue() goes on character by character.
+bool vtkFoamFile::ScanIntValue(int &value)
+{
+  this->SkipBufferedSpaces();
+  unsigned char *ptr = this->Superclass::BufPtr;
+  const unsigned char *const endPtr = this->Superclass::BufEndPtr;
+  const bool negative = (ptr < endPtr && *ptr == 45); // '-' == 45
+  if (ptr < endPtr && (negative || *ptr == 43)) // '+' == 43
+    {
+    ++ptr;
+    }
+  if (ptr >= endPtr || !isdigit(*ptr))
+    {
+    return false;
+    }
+
+  int num = 0;
+  do
+    {
+    num = 10 * num + *ptr - 48; // '0' == 48
+    }
+  while (++ptr < endPtr && isdigit(*ptr));
+  if (ptr >= endPtr)
+    {
+    return false;
+    }
+
+  this->Superclass::BufPtr = ptr;
+  value = negative ? -num : num;
+  return true;
+}
+
+// the same as ScanIntValue() for a floating point value
+bool vtkFoamFile::ScanFloatValue(float &value)
+{
+  this->SkipBufferedSpaces();
+  unsigned char *ptr = this->Superclass::BufPtr;
+  const unsigned char *const endPtr = this->Superclass::BufEndPtr;
+  const bool negative = (ptr < endPtr && *ptr == 45); // '-' == 45
+  if (ptr < endPtr && (negative || *ptr == 43)) // '+' == 43
+    {
+    ++ptr;
+    }
+  if (ptr >= endPtr || !isdigit(*ptr))
+    {
+    return false;
+    }
+
+  // read integer part
+  double num = 0.0;
+  do
+    {
+    num = num * 10.0 + (*ptr - 48); // '0' == 48
+    }
+  while (++ptr < endPtr && isdigit(*ptr));
+
+  // read decimal part
+  if (ptr < endPtr && *ptr == 46) // '.' == 46
+    {
+    double divisor = 1.0;
+    while (++ptr < endPtr && isdigit(*ptr))
+      {
+      num = num * 10.0 + (*ptr - 48);
+      divisor *= 10.0;
+      }
+    num /= divisor;
+    }
+
+  // read exponent part
+  if (ptr < endPtr && (*ptr == 69 || *ptr == 101)) // 'E' == 69, 'e' == 101
+    {
+    int esign = 1;
+    if (++ptr < endPtr && *ptr == 45) // '-'
+      {
+      esign = -1;
+      ++ptr;
+      }
+    else if (ptr < endPtr && *ptr == 43) // '+'
+      {
+      ++ptr;
+      }
+
+    int eval = 0;
+    while (ptr < endPtr && isdigit(*ptr))
+      {
+      eval = eval * 10 + (*ptr++ - 48);
+      }
+
+    const double scale = vtkFoamExponentScale(eval);
+    if (esign < 0)
+      {
+      num /= scale;
+      }
+    else
+      {
+      num *= scale;
+      }
+    }
+  if (ptr >= endPtr)
+    {
+    return false;
+    }
+
+  this->Superclass::BufPtr = ptr;
+  value = static_cast<float>(negative ? -num : num);
+  return true;
+}
+
 // specialized for reading an integer value.
 // not using the standard strtol() for speed reason.
 int vtkFoamFile::ReadIntValue()
 {
+  int value;
+  if (this->ScanIntValue(value))
+    {
+    return value;
+    }
+
   // skip prepending invalid chars
   // expanded the outermost loop in nextTokenHead() for performance
   int c;
@@ -1625,6 +1797,12 @@ int vtkFoamFile::ReadIntValue()
 // ParaView3/VTK/Utilities/vtksqlite/vtk_sqlite3.c
 float vtkFoamFile::ReadFloatValue()
 {
+  float value;
+  if (this->ScanFloatValue(value))
+    {
+    return value;
+    }
+
   // skip prepending invalid chars
   // expanded the outermost loop in nextTokenHead() for performance
   int c;
@@ -1688,7 +1866,6 @@ float vtkFoamFile::ReadFloatValue()
     {
     int esign = 1;
     int eval = 0;
-    double scale = 1.0;
 
     c = this->Getc();
     if (c == 45) // '-'
@@ -1707,27 +1884,7 @@ float vtkFoamFile::ReadFloatValue()
       c = this->Getc();
       }
 
-    // fast exponent multiplication!
-    while (eval >= 64)
-      {
-      scale *= 1.0e+64;
-      eval -= 64;
-      }
-    while (eval >= 16)
-      {
-      scale *= 1.0e+16;
-      eval -= 16;
-      }
-    while (eval >= 4)
-      {
-      scale *= 1.0e+4;
-      eval -= 4;
-      }
-    while (eval >= 1)
-      {
-      scale *= 1.0e+1;
-      eval -= 1;
-      }
+    const double scale = vtkFoamExponentScale(eval);
 
     if (esign < 0)
       {
@@ -3674,6 +3831,51 @@ void vtkFoamEntry::Read(vtkFoamIOobject& io)
     }
 }
 
+//-----------------------------------------------------------------------------
+// struct vtkFoamFieldFile
+// a field file that is read ahead of the conversion of its values, so
+// that the field files of a time step can be parsed concurrently.
+struct vtkFoamFieldFile
+{
+  vtkStdString Name;
+  vtkDataArraySelection *Selection;
+  vtkFoamIOobject IO;
+  vtkFoamDict Dict;
+  bool IsRead;
+
+  vtkFoamFieldFile(const vtkStdString &casePath, const vtkStdString &name,
+      vtkDataArraySelection *selection) :
+    Name(name), Selection(selection), IO(casePath), Dict(), IsRead(false)
+  {
+  }
+};
+
+//-----------------------------------------------------------------------------
+// class vtkFoamFieldFileReader
+// reads a range of field files for vtkSMPTools.
+class vtkFoamFieldFileReader
+{
+public:
+  vtkFoamFieldFileReader(vtkOpenFOAMReaderPrivate *reader,
+      std::vector<vtkFoamFieldFile *> &files) :
+    Reader(reader), Files(files)
+  {
+  }
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      vtkFoamFieldFile &file = *this->Files[i];
+      file.IsRead = this->Reader->ReadFieldFile(&file.IO, &file.Dict,
+          file.Name, file.Selection);
+      }
+  }
+
+private:
+  vtkOpenFOAMReaderPrivate *Reader;
+  std::vector<vtkFoamFieldFile *> &Files;
+};
+
 //-----------------------------------------------------------------------------
 // vtkOpenFOAMReaderPrivate constructor and destructor
 vtkOpenFOAMReaderPrivate::vtkOpenFOAMReaderPrivate()
@@ -6506,6 +6708,15 @@ bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject *ioPtr,
   return true;
 }
 
+//-----------------------------------------------------------------------------
+// read field files concurrently
+void vtkOpenFOAMReaderPrivate::ReadFieldFiles(
+    std::vector<vtkFoamFieldFile *> &files)
+{
+  vtkFoamFieldFileReader reader(this, files);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(files.size()), 1, reader);
+}
+
 //-----------------------------------------------------------------------------
 vtkFloatArray *vtkOpenFOAMReaderPrivate::FillField(vtkFoamEntry *entryPtr,
     int nElements, vtkFoamIOobject *ioPtr, const vtkStdString &fieldType)
@@ -6740,15 +6951,23 @@ void vtkOpenFOAMReaderPrivate::ConstructDimensions(vtkStdString *dimString,
 //-----------------------------------------------------------------------------
 void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(
     vtkUnstructuredGrid *internalMesh, vtkMultiBlockDataSet *boundaryMesh,
-    const vtkStdString &varName)
+    const vtkStdString &varName, vtkFoamFieldFile *file)
 {
-  vtkFoamIOobject io(this->CasePath);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(&io, &dict, varName,
-      this->Parent->CellDataArraySelection))
+  // read the file here unless it has been read ahead
+  vtkFoamFieldFile ownFile(this->CasePath, varName,
+      this->Parent->CellDataArraySelection);
+  if (file == NULL)
+    {
+    file = &ownFile;
+    file->IsRead = this->ReadFieldFile(&file->IO, &file->Dict, varName,
+        file->Selection);
+    }
+  if (!file->IsRead)
     {
     return;
     }
+  vtkFoamIOobject &io = file->IO;
+  vtkFoamDict &dict = file->Dict;
 
   if (io.GetClassName().substr(0, 3) != "vol")
     {
@@ -7092,15 +7311,23 @@ void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(
 // read point field at a timestep
 void vtkOpenFOAMReaderPrivate::GetPointFieldAtTimeStep(
     vtkUnstructuredGrid *internalMesh, vtkMultiBlockDataSet *boundaryMesh,
-    const vtkStdString &varName)
+    const vtkStdString &varName, vtkFoamFieldFile *file)
 {
-  vtkFoamIOobject io(this->CasePath);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(&io, &dict, varName,
-      this->Parent->PointDataArraySelection))
+  // read the file here unless it has been read ahead
+  vtkFoamFieldFile ownFile(this->CasePath, varName,
+      this->Parent->PointDataArraySelection);
+  if (file == NULL)
+    {
+    file = &ownFile;
+    file->IsRead = this->ReadFieldFile(&file->IO, &file->Dict, varName,
+        file->Selection);
+    }
+  if (!file->IsRead)
     {
     return;
     }
+  vtkFoamIOobject &io = file->IO;
+  vtkFoamDict &dict = file->Dict;
 
   if (io.GetClassName().substr(0, 5) != "point")
     {
@@ -8006,20 +8233,49 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet *output,
           bm->GetPointData()->Initialize();
           }
         }
-      // read field data variables into Internal/Boundary meshes
-      for (int i = 0; i < (int)this->VolFieldFiles->GetNumberOfValues(); i++)
+      // parse all the field files ahead of their conversion when they
+      // are read in parallel, otherwise one by one to keep memory low
+      const int nVolFields = (int)this->VolFieldFiles->GetNumberOfValues();
+      const int nPointFields =
+          (int)this->PointFieldFiles->GetNumberOfValues();
+      std::vector<vtkFoamFieldFile *> fieldFiles;
+      if (this->Parent->GetReadFieldsInParallel())
+        {
+        for (int i = 0; i < nVolFields; i++)
+          {
+          fieldFiles.push_back(new vtkFoamFieldFile(this->CasePath,
+              this->VolFieldFiles->GetValue(i),
+              this->Parent->CellDataArraySelection));
+          }
+        for (int i = 0; i < nPointFields; i++)
+          {
+          fieldFiles.push_back(new vtkFoamFieldFile(this->CasePath,
+              this->PointFieldFiles->GetValue(i),
+              this->Parent->PointDataArraySelection));
+          }
+        this->ReadFieldFiles(fieldFiles);
+        }
+
+      // read field data variables into Internal/Boundary meshes, freeing
+      // the files read ahead once converted
+      for (int i = 0; i < nVolFields; i++)
         {
+        vtkFoamFieldFile *file = fieldFiles.empty() ? NULL : fieldFiles[i];
         this->GetVolFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh,
-            this->VolFieldFiles->GetValue(i));
+            this->VolFieldFiles->GetValue(i), file);
+        delete file;
         this->Parent->UpdateProgress(0.5 + 0.25 * ((float)(i + 1)
-            / ((float)this->VolFieldFiles->GetNumberOfValues() + 0.0001)));
+            / ((float)nVolFields + 0.0001)));
         }
-      for (int i = 0; i < (int)this->PointFieldFiles->GetNumberOfValues(); i++)
+      for (int i = 0; i < nPointFields; i++)
         {
+        vtkFoamFieldFile *file =
+            fieldFiles.empty() ? NULL : fieldFiles[nVolFields + i];
         this->GetPointFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh,
-            this->PointFieldFiles->GetValue(i));
+            this->PointFieldFiles->GetValue(i), file);
+        delete file;
         this->Parent->UpdateProgress(0.75 + 0.125 * ((float)(i + 1)
-            / ((float)this->PointFieldFiles->GetNumberOfValues() + 0.0001)));
+            / ((float)nPointFields + 0.0001)));
         }
       }
     // read lagrangian mesh and fields
@@ -8159,6 +8415,9 @@ vtkOpenFOAMReader::vtkOpenFOAMReader()
   this->ReadZones = 0; // turned off by default
   this->ReadZonesOld = 0;
 
+  // for parsing the field files of a time step concurrently
+  this->ReadFieldsInParallel = 0; // turned off by default
+
   // determine if time directories are to be listed according to controlDict
   this->ListTimeStepsByControlDict = 0;
   this->ListTimeStepsByControlDictOld = 0;
@@ -8172,6 +8431,7 @@ vtkOpenFOAMReader::vtkOpenFOAMReader()
 
   this->CurrentReaderIndex = 0;
   this->NumberOfReaders = 0;
+  this->ProgressSuspended = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -8213,6 +8473,8 @@ void vtkOpenFOAMReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PositionsIsIn13Format: " << this->PositionsIsIn13Format
       << endl;
   os << indent << "ReadZones: " << this->ReadZones << endl;
+  os << indent << "ReadFieldsInParallel: " << this->ReadFieldsInParallel
+      << endl;
   os << indent << "ListTimeStepsByControlDict: "
       << this->ListTimeStepsByControlDict << endl;
   os << indent << "AddDimensionsToArrayNames: "
@@ -8679,6 +8941,10 @@ void vtkOpenFOAMReader::UpdateStatus()
 //-----------------------------------------------------------------------------
 void vtkOpenFOAMReader::UpdateProgress(double amount)
 {
+  if (this->Parent->ProgressSuspended)
+    {
+    return;
+    }
   this->vtkAlgorithm::UpdateProgress((static_cast<double>(this->Parent->CurrentReaderIndex)
       + amount) / static_cast<double>(this->Parent->NumberOfReaders));
 }
@@ -40,6 +40,7 @@
 
 #include "vtkIOGeometryModule.h" // For export macro
 #include "vtkMultiBlockDataSetAlgorithm.h"
+#include "vtkAtomicTypes.h" // For the index of the active reader
 
 class vtkCollection;
 class vtkCharArray;
@@ -219,6 +220,15 @@ public:
   vtkGetMacro(ReadZones, int);
   vtkBooleanMacro(ReadZones, int);
 
+  // Description:
+  // Set/Get whether the field files of a time step are parsed
+  // concurrently before their values are added to the meshes. This holds
+  // all the parsed fields of a time step in memory at once. Off by
+  // default.
+  vtkSetMacro(ReadFieldsInParallel, int);
+  vtkGetMacro(ReadFieldsInParallel, int);
+  vtkBooleanMacro(ReadFieldsInParallel, int);
+
   void SetRefresh() { this->Refresh = true; this->Modified(); }
 
   void SetParent(vtkOpenFOAMReader *parent) { this->Parent = parent; }
@@ -250,6 +260,9 @@ protected:
   // for reading point/face/cell-Zones
   int ReadZones;
 
+  // for parsing field files concurrently
+  int ReadFieldsInParallel;
+
   // determine if time directories are listed according to controlDict
   int ListTimeStepsByControlDict;
 
@@ -286,8 +299,11 @@ protected:
 
   // number of reader instances
   int NumberOfReaders;
-  // index of the active reader
-  int CurrentReaderIndex;
+  // index of the active reader, counted by readers that may run
+  // concurrently in vtkPOpenFOAMReader
+  vtkAtomicInt32 CurrentReaderIndex;
+  // set while vtkPOpenFOAMReader updates its readers concurrently
+  bool ProgressSuspended;
 
   vtkOpenFOAMReader();
   ~vtkOpenFOAMReader();
@@ -0,0 +1,151 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageReader2Series.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that a series of PNG, JPEG and TIFF files read with
+// ReadSeriesInParallel gives the image read one file at a time, for the
+// whole extent and for a part of it.
+
+#include "vtkImageData.h"
+#include "vtkImageReader2.h"
+#include "vtkImageWriter.h"
+#include "vtkJPEGReader.h"
+#include "vtkJPEGWriter.h"
+#include "vtkNew.h"
+#include "vtkPNGReader.h"
+#include "vtkPNGWriter.h"
+#include "vtkPointData.h"
+#include "vtkStringArray.h"
+#include "vtkTestUtilities.h"
+#include "vtkTIFFReader.h"
+#include "vtkTIFFWriter.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstdio>
+#include <string>
+
+namespace
+{
+
+bool CompareImages(vtkImageData *expected, vtkImageData *read, int *extent)
+{
+  for (int z = extent[4]; z <= extent[5]; ++z)
+    {
+    for (int y = extent[2]; y <= extent[3]; ++y)
+      {
+      for (int x = extent[0]; x <= extent[1]; ++x)
+        {
+        for (int c = 0; c < expected->GetNumberOfScalarComponents(); ++c)
+          {
+          if (read->GetScalarComponentAsDouble(x, y, z, c) !=
+              expected->GetScalarComponentAsDouble(x, y, z, c))
+            {
+            cerr << "Pixel (" << x << ", " << y << ", " << z
+                 << ") differs" << endl;
+            return false;
+            }
+          }
+        }
+      }
+    }
+  return true;
+}
+
+bool TestSeries(vtkImageData *image, vtkImageWriter *writer,
+                vtkImageReader2 *serialReader, vtkImageReader2 *reader,
+                const std::string &prefix, const char *extension)
+{
+  std::string pattern = std::string("%s_%d.") + extension;
+  writer->SetInputData(image);
+  writer->SetFilePrefix(prefix.c_str());
+  writer->SetFilePattern(pattern.c_str());
+  writer->SetFileDimensionality(2);
+  writer->Write();
+
+  int *dims = image->GetDimensions();
+  vtkNew<vtkStringArray> fileNames;
+  for (int z = 0; z < dims[2]; ++z)
+    {
+    char name[1024];
+    sprintf(name, pattern.c_str(), prefix.c_str(), z);
+    fileNames->InsertNextValue(name);
+    }
+
+  serialReader->SetFileNames(fileNames.GetPointer());
+  serialReader->Update();
+  vtkImageData *expected = serialReader->GetOutput();
+  reader->SetFileNames(fileNames.GetPointer());
+  reader->ReadSeriesInParallelOn();
+  reader->Update();
+  int *extent = expected->GetExtent();
+  if (!reader->GetOutput()->GetPointData()->GetScalars() ||
+      !CompareImages(expected, reader->GetOutput(), extent))
+    {
+    cerr << "Wrong " << extension << " series" << endl;
+    return false;
+    }
+
+  int subExtent[6] = { 5, 30, 3, 20, 1, 4 };
+  reader->UpdateExtent(subExtent);
+  if (!CompareImages(expected, reader->GetOutput(), subExtent))
+    {
+    cerr << "Wrong part of the " << extension << " series" << endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+int TestImageReader2Series(int argc, char *argv[])
+{
+  char *tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string prefix = std::string(tempDir) + "/ImageReader2Series";
+  delete [] tempDir;
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(41, 27, 7);
+  vtkNew<vtkUnsignedCharArray> scalars;
+  scalars->SetNumberOfComponents(3);
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < 3 * image->GetNumberOfPoints(); ++i)
+    {
+    scalars->SetValue(i, static_cast<unsigned char>((13 * i) % 253));
+    }
+  image->GetPointData()->SetScalars(scalars.GetPointer());
+
+  vtkNew<vtkPNGWriter> pngWriter;
+  vtkNew<vtkPNGReader> pngSerialReader;
+  vtkNew<vtkPNGReader> pngReader;
+  vtkNew<vtkJPEGWriter> jpegWriter;
+  vtkNew<vtkJPEGReader> jpegSerialReader;
+  vtkNew<vtkJPEGReader> jpegReader;
+  vtkNew<vtkTIFFWriter> tiffWriter;
+  vtkNew<vtkTIFFReader> tiffSerialReader;
+  vtkNew<vtkTIFFReader> tiffReader;
+  if (!TestSeries(image.GetPointer(), pngWriter.GetPointer(),
+                  pngSerialReader.GetPointer(), pngReader.GetPointer(),
+                  prefix, "png") ||
+      !TestSeries(image.GetPointer(), jpegWriter.GetPointer(),
+                  jpegSerialReader.GetPointer(), jpegReader.GetPointer(),
+                  prefix, "jpg") ||
+      !TestSeries(image.GetPointer(), tiffWriter.GetPointer(),
+                  tiffSerialReader.GetPointer(), tiffReader.GetPointer(),
+                  prefix, "tif"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
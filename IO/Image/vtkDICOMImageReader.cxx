@@ -20,6 +20,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkErrorCode.h"
+#include "vtkStringArray.h"
 
 #include <vector>
 #include <string>
@@ -296,6 +297,28 @@ void vtkDICOMImageReader::ExecuteDataWithInformation(vtkDataObject *output,
   else if (this->DICOMFileNames->size() > 0)
     {
     vtkDebugMacro( << "Multiple files (" << static_cast<int>(this->DICOMFileNames->size()) << ")");
+
+    // Each file of the extent is read by its own reader, which flips its
+    // rows as above.
+    int *ext = data->GetExtent();
+    if (this->ReadSeriesInParallel && ext[5] > ext[4] &&
+        ext[5] - this->DataExtent[4] <
+        static_cast<int>(this->DICOMFileNames->size()))
+      {
+      vtkStringArray *fileNames = vtkStringArray::New();
+      for (int z = ext[4]; z <= ext[5]; ++z)
+        {
+        fileNames->InsertNextValue(
+          (*this->DICOMFileNames)[z - this->DataExtent[4]]);
+        }
+      if (!this->ReadSlicesInParallel(data, fileNames))
+        {
+        this->SetErrorCode( vtkErrorCode::FileFormatError );
+        }
+      fileNames->Delete();
+      return;
+      }
+
     this->Parser->ClearAllDICOMTagCallbacks();
     this->AppHelper->Clear();
     this->AppHelper->RegisterCallbacks(this->Parser);
@@ -16,17 +16,22 @@
 
 #include "vtkByteSwap.h"
 #include "vtkDataArray.h"
+#include "vtkFileMappedDataArrayAllocator.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkErrorCode.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 
 #include <sys/stat.h>
 
+#include <cstring>
+#include <vector>
+
 vtkStandardNewMacro(vtkImageReader2);
 
 #ifdef read
@@ -65,6 +70,8 @@ vtkImageReader2::vtkImageReader2()
 
   this->MemoryBuffer = NULL;
   this->MemoryBufferLength = 0;
+  this->MemoryMapping = 0;
+  this->ReadSeriesInParallel = 0;
 
   this->HeaderSize = 0;
   this->ManualHeaderSize = 0;
@@ -416,6 +423,10 @@ void vtkImageReader2::PrintSelf(ostream& os, vtkIndent indent)
     (this->FileLowerLeft ? "On\n" : "Off\n");
 
   os << indent << "Swap Bytes: " << (this->SwapBytes ? "On\n" : "Off\n");
+  os << indent << "MemoryMapping: "
+     << (this->MemoryMapping ? "On\n" : "Off\n");
+  os << indent << "ReadSeriesInParallel: "
+     << (this->ReadSeriesInParallel ? "On\n" : "Off\n");
 
   os << indent << "DataIncrements: (" << this->DataIncrements[0];
   for (idx = 1; idx < 2; ++idx)
@@ -772,6 +783,11 @@ void vtkImageReader2Update(vtkImageReader2 *self, vtkImageData *data, OT *outPtr
 void vtkImageReader2::ExecuteDataWithInformation(vtkDataObject *output,
                                                  vtkInformation *outInfo)
 {
+  if (this->MemoryMapping && this->MapOutputData(output, outInfo))
+    {
+    return;
+    }
+
   vtkImageData *data = this->AllocateOutputData(output, outInfo);
 
   void *ptr;
@@ -803,6 +819,195 @@ void vtkImageReader2::ExecuteDataWithInformation(vtkDataObject *output,
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkImageReader2::MapOutputData(vtkDataObject *output,
+                                   vtkInformation *outInfo)
+{
+  vtkImageData *data = vtkImageData::SafeDownCast(output);
+  if (!data || this->MemoryBuffer || this->FileDimensionality != 3 ||
+      !this->FileLowerLeft || (!this->FileName && !this->FilePattern))
+    {
+    return 0;
+    }
+
+  // Only whole slices are contiguous in the file.
+  int *ext = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT());
+  if (ext[0] != this->DataExtent[0] || ext[1] != this->DataExtent[1] ||
+      ext[2] != this->DataExtent[2] || ext[3] != this->DataExtent[3] ||
+      ext[4] < this->DataExtent[4] || ext[5] > this->DataExtent[5] ||
+      ext[4] > ext[5])
+    {
+    return 0;
+    }
+
+  this->ComputeDataIncrements();
+  this->ComputeInternalFileName(0);
+  vtkTypeInt64 offset = static_cast<vtkTypeInt64>(this->GetHeaderSize(0)) +
+    static_cast<vtkTypeInt64>(ext[4] - this->DataExtent[4]) *
+    static_cast<vtkTypeInt64>(this->DataIncrements[2]);
+  vtkIdType numberOfTuples =
+    static_cast<vtkIdType>(ext[1] - ext[0] + 1) *
+    static_cast<vtkIdType>(ext[3] - ext[2] + 1) *
+    static_cast<vtkIdType>(ext[5] - ext[4] + 1);
+  bool swap = this->GetSwapBytes() &&
+    vtkAbstractArray::GetDataTypeSize(this->DataScalarType) > 1;
+  vtkDataArray *scalars = vtkFileMappedDataArrayAllocator::MapArray(
+    this->InternalFileName, offset, this->DataScalarType,
+    this->NumberOfScalarComponents, numberOfTuples,
+    vtkFileMappedDataArrayAllocator::COPY_ON_WRITE,
+    swap ? vtkFileMappedDataArrayAllocator::SEQUENTIAL :
+    vtkFileMappedDataArrayAllocator::NORMAL);
+  if (!scalars)
+    {
+    return 0;
+    }
+
+  if (swap)
+    {
+    vtkByteSwap::SwapVoidRange(
+      scalars->GetVoidPointer(0),
+      static_cast<size_t>(numberOfTuples * this->NumberOfScalarComponents),
+      static_cast<size_t>(scalars->GetDataTypeSize()));
+    }
+  data->SetExtent(ext);
+  scalars->SetName("ImageFile");
+  data->GetPointData()->SetScalars(scalars);
+  scalars->Delete();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+namespace
+{
+
+// Updates the readers of the slices of a series and copies their outputs
+// into the slices of Data. Each slice is written by a single thread.
+class vtkImageReader2ReadSlices
+{
+public:
+  vtkImageReader2 **Readers;
+  vtkImageData *Data;
+  int *Extent;
+  std::vector<char> Failed;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    int *ext = this->Extent;
+    int numComponents = this->Data->GetNumberOfScalarComponents();
+    size_t rowSize = static_cast<size_t>(ext[1] - ext[0] + 1) *
+      numComponents * this->Data->GetScalarSize();
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkImageReader2 *reader = this->Readers[i];
+      reader->Update();
+      vtkImageData *slice = reader->GetOutput();
+      int *sliceExt = slice->GetExtent();
+      if (reader->GetErrorCode() != vtkErrorCode::NoError ||
+          !slice->GetPointData()->GetScalars() ||
+          slice->GetScalarType() != this->Data->GetScalarType() ||
+          slice->GetNumberOfScalarComponents() != numComponents ||
+          sliceExt[0] > ext[0] || sliceExt[1] < ext[1] ||
+          sliceExt[2] > ext[2] || sliceExt[3] < ext[3])
+        {
+        this->Failed[i] = 1;
+        }
+      else
+        {
+        int z = ext[4] + static_cast<int>(i);
+        for (int y = ext[2]; y <= ext[3]; ++y)
+          {
+          memcpy(this->Data->GetScalarPointer(ext[0], y, z),
+                 slice->GetScalarPointer(ext[0], y, sliceExt[4]), rowSize);
+          }
+        }
+      slice->ReleaseData();
+      }
+  }
+};
+
+}
+
+//----------------------------------------------------------------------------
+int vtkImageReader2::ReadFileSeriesInParallel(vtkImageData *data)
+{
+  int *ext = data->GetExtent();
+  if (!this->ReadSeriesInParallel || this->MemoryBuffer ||
+      this->FileDimensionality != 2 || ext[5] <= ext[4] ||
+      (this->FileName && !this->FileNames))
+    {
+    return 0;
+    }
+
+  vtkStringArray *fileNames = vtkStringArray::New();
+  for (int z = ext[4]; z <= ext[5]; ++z)
+    {
+    this->ComputeInternalFileName(z);
+    if (!this->InternalFileName)
+      {
+      fileNames->Delete();
+      return 0;
+      }
+    fileNames->InsertNextValue(this->InternalFileName);
+    }
+  if (!this->ReadSlicesInParallel(data, fileNames))
+    {
+    this->SetErrorCode(vtkErrorCode::FileFormatError);
+    }
+  fileNames->Delete();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageReader2::ReadSlicesInParallel(vtkImageData *data,
+                                          vtkStringArray *fileNames)
+{
+  int *ext = data->GetExtent();
+  vtkIdType numSlices = ext[5] - ext[4] + 1;
+  if (!data->GetPointData()->GetScalars() ||
+      fileNames->GetNumberOfValues() < numSlices)
+    {
+    return 0;
+    }
+
+  // The readers are set up here, as only this class may call
+  // CopySettingsToSliceReader, and updated by the threads.
+  std::vector<vtkImageReader2 *> readers(numSlices);
+  for (vtkIdType i = 0; i < numSlices; ++i)
+    {
+    readers[i] = this->NewInstance();
+    this->CopySettingsToSliceReader(readers[i]);
+    readers[i]->SetFileName(fileNames->GetValue(i).c_str());
+    }
+
+  vtkImageReader2ReadSlices functor;
+  functor.Readers = &readers[0];
+  functor.Data = data;
+  functor.Extent = ext;
+  functor.Failed.resize(numSlices, 0);
+  vtkSMPTools::For(0, numSlices, functor);
+
+  int result = 1;
+  for (vtkIdType i = 0; i < numSlices; ++i)
+    {
+    if (functor.Failed[i] && result)
+      {
+      vtkErrorMacro("Could not read slice " << ext[4] + i << " from "
+                    << fileNames->GetValue(i));
+      result = 0;
+      }
+    readers[i]->Delete();
+    }
+  this->UpdateProgress(1.0);
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageReader2::CopySettingsToSliceReader(vtkImageReader2 *reader)
+{
+  reader->SetFileLowerLeft(this->FileLowerLeft);
+  reader->SetSwapBytes(this->SwapBytes);
+}
+
 //----------------------------------------------------------------------------
 void vtkImageReader2::SetMemoryBuffer(void *membuf)
 {
@@ -206,6 +206,28 @@ public:
   vtkGetMacro(FileLowerLeft, int);
   vtkSetMacro(FileLowerLeft, int);
 
+  // Description:
+  // When on, the scalars are mapped from the file instead of being read,
+  // so that their pages are only loaded when accessed. This applies when
+  // the data is a single three dimensional file stored from the lower
+  // left corner and whole slices are requested; other requests, and
+  // subclasses that decode their files, are read as usual. The mapping is
+  // copy on write: the file is never modified. Off by default.
+  vtkSetMacro(MemoryMapping, int);
+  vtkGetMacro(MemoryMapping, int);
+  vtkBooleanMacro(MemoryMapping, int);
+
+  // Description:
+  // When on, the files of a series of two dimensional files (FileNames,
+  // FilePattern or FilePrefix) are decoded in parallel, each by its own
+  // reader into its slice of the output. This applies to the readers of
+  // self describing files: vtkPNGReader, vtkJPEGReader, vtkTIFFReader and
+  // vtkDICOMImageReader. vtkTIFFReader also decodes the rows of tiles of a
+  // tiled file in parallel. Off by default.
+  vtkSetMacro(ReadSeriesInParallel, int);
+  vtkGetMacro(ReadSeriesInParallel, int);
+  vtkBooleanMacro(ReadSeriesInParallel, int);
+
   // Description:
   // Set/Get the internal file name
   virtual void ComputeInternalFileName(int slice);
@@ -255,6 +277,9 @@ protected:
   void *MemoryBuffer;
   vtkIdType MemoryBufferLength;
 
+  int MemoryMapping;
+  int ReadSeriesInParallel;
+
   ifstream *File;
   unsigned long DataIncrements[4];
   int DataExtent[6];
@@ -277,6 +302,26 @@ protected:
   virtual void ExecuteInformation();
   virtual void ExecuteDataWithInformation(vtkDataObject *data, vtkInformation *outInfo);
   virtual void ComputeDataIncrements();
+
+  // Map the requested extent of the file as the output scalars, see
+  // MemoryMapping. Returns 0 if the data must be read instead.
+  int MapOutputData(vtkDataObject *data, vtkInformation *outInfo);
+
+  // Read each slice of the output extent of data from the file of the
+  // series for that slice, in parallel, see ReadSeriesInParallel. Returns
+  // 0 if the data must be read one file at a time instead.
+  int ReadFileSeriesInParallel(vtkImageData *data);
+
+  // Read the slices of the output extent of data in parallel, the first
+  // one from fileNames[0] and so on. Each file is read by a new instance
+  // of this class, set up with CopySettingsToSliceReader, and must give an
+  // image of the output scalar type that covers the extent. Returns 0 on
+  // failure.
+  int ReadSlicesInParallel(vtkImageData *data, vtkStringArray *fileNames);
+
+  // Copy the settings that affect the decoding of a file to a reader of a
+  // single file of the series.
+  virtual void CopySettingsToSliceReader(vtkImageReader2 *reader);
 private:
   vtkImageReader2(const vtkImageReader2&);  // Not implemented.
   void operator=(const vtkImageReader2&);  // Not implemented.
@@ -377,6 +377,11 @@ void vtkJPEGReader::ExecuteDataWithInformation(vtkDataObject *output,
 
   data->GetPointData()->GetScalars()->SetName("JPEGImage");
 
+  if (this->ReadFileSeriesInParallel(data))
+    {
+    return;
+    }
+
   // Call the correct templated function for the output
   void *outPtr;
 
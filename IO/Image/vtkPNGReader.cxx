@@ -420,6 +420,11 @@ void vtkPNGReader::ExecuteDataWithInformation(vtkDataObject *output,
 
   this->ComputeDataIncrements();
 
+  if (this->ReadFileSeriesInParallel(data))
+    {
+    return;
+    }
+
   // Call the correct templated function for the output
   void *outPtr;
 
@@ -19,12 +19,15 @@
 #include "vtkPointData.h"
 #include "vtkErrorCode.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 
 #include "vtksys/SystemTools.hxx"
 
 #include <sys/stat.h>
 #include <string>
 #include <algorithm>
+#include <vector>
 
 extern "C" {
 #include "vtk_tiff.h"
@@ -137,6 +140,79 @@ bool ReadTemplatedImage(T* out, Flip flip,
     }
   return true;
 }
+
+// Reads the full tiles of the rows of tiles of a tiled file, with a file
+// handle and a tile buffer for each thread, as libtiff handles cannot be
+// shared between threads.
+class ReadTileRows
+{
+public:
+  const char *FileName;
+  unsigned char *Volume;
+  unsigned int Width;
+  unsigned int Height;
+  unsigned int TileWidth;
+  unsigned int TileHeight;
+  unsigned int PixelSize;
+  unsigned int NumberOfColumns;
+  bool Flip;
+  std::vector<char> Failed;
+  vtkSMPThreadLocal<TIFF *> Images;
+
+  ReadTileRows() : Images(NULL) {}
+
+  ~ReadTileRows()
+  {
+    for (vtkSMPThreadLocal<TIFF *>::iterator it = this->Images.begin();
+         it != this->Images.end(); ++it)
+      {
+      if (*it)
+        {
+        TIFFClose(*it);
+        }
+      }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    TIFF *&image = this->Images.Local();
+    if (!image)
+      {
+      image = TIFFOpen(this->FileName, "r");
+      }
+    if (!image)
+      {
+      std::fill(this->Failed.begin() + begin, this->Failed.begin() + end, 1);
+      return;
+      }
+    std::vector<unsigned char> tile(TIFFTileSize(image));
+    for (vtkIdType index = begin; index < end; ++index)
+      {
+      const unsigned int row = static_cast<unsigned int>(index) *
+        this->TileHeight;
+      const unsigned int r = this->Flip ?
+        this->Height - row - this->TileHeight : row;
+      for (unsigned int c = 0; c < this->NumberOfColumns; ++c)
+        {
+        const unsigned int col = c * this->TileWidth;
+        if (TIFFReadTile(image, &tile[0], col, r, 0, 0) < 0)
+          {
+          this->Failed[index] = 1;
+          break;
+          }
+        for (unsigned int yy = 0; yy < this->TileHeight; ++yy)
+          {
+          const unsigned int y = this->Flip ? this->TileHeight +
+            this->Height % this->TileHeight - yy - 1 : yy;
+          memcpy(this->Volume +
+                 ((row + y) * this->Width + col) * this->PixelSize,
+                 &tile[yy * this->TileWidth * this->PixelSize],
+                 this->TileWidth * this->PixelSize);
+          }
+        }
+      }
+  }
+};
 }
 
 //-------------------------------------------------------------------------
@@ -724,6 +800,16 @@ void vtkTIFFReader::ExecuteDataWithInformation(vtkDataObject *output,
   data->GetExtent(this->OutputExtent);
   data->GetIncrements(this->OutputIncrements);
 
+  // A series of single page, untiled files
+  if (this->InternalImage->NumberOfPages <= 1 &&
+      this->InternalImage->NumberOfTiles == 0 &&
+      this->ReadFileSeriesInParallel(data))
+    {
+    this->InternalImage->Clean();
+    data->GetPointData()->GetScalars()->SetName("Tiff Scalars");
+    return;
+    }
+
   // Call the correct templated function for the input
   void *outPtr = data->GetScalarPointer();
 
@@ -737,6 +823,17 @@ void vtkTIFFReader::ExecuteDataWithInformation(vtkDataObject *output,
   data->GetPointData()->GetScalars()->SetName("Tiff Scalars");
 }
 
+//----------------------------------------------------------------------------
+void vtkTIFFReader::CopySettingsToSliceReader(vtkImageReader2 *reader)
+{
+  this->Superclass::CopySettingsToSliceReader(reader);
+  vtkTIFFReader *tiffReader = vtkTIFFReader::SafeDownCast(reader);
+  if (tiffReader && this->OrientationTypeSpecifiedFlag)
+    {
+    tiffReader->SetOrientationType(this->OrientationType);
+    }
+}
+
 //----------------------------------------------------------------------------
 unsigned int vtkTIFFReader::GetFormat()
 {
@@ -975,33 +1072,62 @@ void vtkTIFFReader::ReadTiles(void* buffer)
   const bool colMultiple = (width % tileWidth == 0 ) ? true : false;
   const bool flip = this->InternalImage->Orientation != ORIENTATION_TOPLEFT;
 
-  for (unsigned int slice = 0; slice < this->InternalImage->NumberOfPages;
-       ++slice)
+  if (this->ReadSeriesInParallel && this->InternalImage->NumberOfPages == 1)
     {
-    for (unsigned int row = 0;
-         row < (rowMultiple ? height : height - tileHeight);
-         row += tileHeight)
+    ReadTileRows functor;
+    functor.FileName = this->InternalFileName;
+    functor.Volume = volume;
+    functor.Width = width;
+    functor.Height = height;
+    functor.TileWidth = tileWidth;
+    functor.TileHeight = tileHeight;
+    functor.PixelSize = pixelSize;
+    functor.NumberOfColumns = width / tileWidth;
+    functor.Flip = flip;
+    vtkIdType numberOfRows = height / tileHeight;
+    functor.Failed.resize(numberOfRows, 0);
+    vtkSMPTools::For(0, numberOfRows, functor);
+    for (vtkIdType index = 0; index < numberOfRows; ++index)
       {
-      const unsigned int r = flip ? height - row - tileHeight : row;
-      for (unsigned int col = 0;
-           col < (colMultiple ? width : width - tileWidth);
-           col += tileWidth)
+      if (functor.Failed[index])
         {
-        if (TIFFReadTile(this->InternalImage->Image, tile, col, r, slice, 0) < 0)
-          {
-          vtkErrorMacro(<< "Cannot read tile : "<< r << "," << col << " from file");
-          delete [] tile;
-          return;
-          }
-        // Currently not using tile depth
-        unsigned int zz = 0;
-        for (unsigned int yy = 0; yy < tileHeight; ++yy)
+        vtkErrorMacro(<< "Cannot read the tiles of row "
+                      << index * tileHeight << " from file");
+        delete [] tile;
+        return;
+        }
+      }
+    }
+  else
+    {
+    for (unsigned int slice = 0; slice < this->InternalImage->NumberOfPages;
+         ++slice)
+      {
+      for (unsigned int row = 0;
+           row < (rowMultiple ? height : height - tileHeight);
+           row += tileHeight)
+        {
+        const unsigned int r = flip ? height - row - tileHeight : row;
+        for (unsigned int col = 0;
+             col < (colMultiple ? width : width - tileWidth);
+             col += tileWidth)
           {
-          const unsigned int y = flip ? tileHeight + height % tileHeight - yy - 1 : yy;
-          memcpy (
-            volume + (((slice + zz) * height + row + y) * width + col) * pixelSize,
-            tile + (zz * tileHeight + yy) * tileWidth * pixelSize,
-            tileWidth * pixelSize);
+          if (TIFFReadTile(this->InternalImage->Image, tile, col, r, slice, 0) < 0)
+            {
+            vtkErrorMacro(<< "Cannot read tile : "<< r << "," << col << " from file");
+            delete [] tile;
+            return;
+            }
+          // Currently not using tile depth
+          unsigned int zz = 0;
+          for (unsigned int yy = 0; yy < tileHeight; ++yy)
+            {
+            const unsigned int y = flip ? tileHeight + height % tileHeight - yy - 1 : yy;
+            memcpy (
+              volume + (((slice + zz) * height + row + y) * width + col) * pixelSize,
+              tile + (zz * tileHeight + yy) * tileWidth * pixelSize,
+              tileWidth * pixelSize);
+            }
           }
         }
       }
@@ -91,6 +91,7 @@ protected:
 
   virtual void ExecuteInformation();
   virtual void ExecuteDataWithInformation(vtkDataObject *out, vtkInformation *outInfo);
+  virtual void CopySettingsToSliceReader(vtkImageReader2 *reader);
 
 private:
   vtkTIFFReader(const vtkTIFFReader&);  // Not implemented.
@@ -0,0 +1,118 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelimitedTextReaderParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that text parsed in parallel chunks gives the table parsed serially:
+// quoted fields, escape sequences, short records, blank lines and numeric
+// columns, with and without headers and a maximum number of records.
+
+#include "vtkAbstractArray.h"
+#include "vtkDelimitedTextReader.h"
+#include "vtkNew.h"
+#include "vtkTable.h"
+#include "vtkVariant.h"
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+bool CompareTables(vtkTable* expected, vtkTable* read)
+{
+  if(read->GetNumberOfColumns() != expected->GetNumberOfColumns() ||
+     read->GetNumberOfRows() != expected->GetNumberOfRows())
+    {
+    cerr << "Read " << read->GetNumberOfRows() << " x "
+         << read->GetNumberOfColumns() << " instead of "
+         << expected->GetNumberOfRows() << " x "
+         << expected->GetNumberOfColumns() << endl;
+    return false;
+    }
+  for(vtkIdType c = 0; c < expected->GetNumberOfColumns(); ++c)
+    {
+    vtkAbstractArray* column = expected->GetColumn(c);
+    vtkAbstractArray* readColumn = read->GetColumn(c);
+    if(std::string(column->GetName()) != readColumn->GetName() ||
+       std::string(column->GetClassName()) != readColumn->GetClassName())
+      {
+      cerr << "Column " << c << " is a " << readColumn->GetClassName()
+           << " named " << readColumn->GetName() << " instead of a "
+           << column->GetClassName() << " named " << column->GetName()
+           << endl;
+      return false;
+      }
+    for(vtkIdType r = 0; r < expected->GetNumberOfRows(); ++r)
+      {
+      if(read->GetValue(r, c).ToString() != expected->GetValue(r, c).ToString())
+        {
+        cerr << "Value (" << r << ", " << c << ") is '"
+             << read->GetValue(r, c).ToString() << "' instead of '"
+             << expected->GetValue(r, c).ToString() << "'" << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+}
+
+int TestDelimitedTextReaderParallel(int, char*[])
+{
+  std::ostringstream text;
+  text << "id,value,ratio,label,note\r\n";
+  for(int i = 0; i < 20000; ++i)
+    {
+    text << i << "," << (i * 7) % 1000 - 500 << "," << i * 0.25 << ",";
+    switch(i % 6)
+      {
+      case 0: text << "\"quoted, with comma\",plain"; break;
+      case 1: text << "esc\\tape\\,d,\"a\"\"b\""; break;
+      case 2: text << ",  padded  "; break;
+      case 3: text << "short"; break;
+      case 4: text << "\"open quote, ends at line"; break;
+      default: text << "x" << i << ",\\\\"; break;
+      }
+    text << (i % 11 == 0 ? "\n\n   \n" : "\r\n");
+    }
+  text << "last,1,2.5,no,newline";
+  const std::string input = text.str();
+
+  for(int mode = 0; mode < 4; ++mode)
+    {
+    vtkNew<vtkDelimitedTextReader> serial;
+    vtkNew<vtkDelimitedTextReader> parallel;
+    vtkDelimitedTextReader* readers[2] = { serial.GetPointer(),
+                                           parallel.GetPointer() };
+    for(int r = 0; r < 2; ++r)
+      {
+      readers[r]->SetReadFromInputString(1);
+      readers[r]->SetInputString(input);
+      readers[r]->SetHaveHeaders(mode != 1);
+      readers[r]->SetDetectNumericColumns(mode >= 2);
+      readers[r]->SetTrimWhitespacePriorToNumericConversion(mode == 3);
+      readers[r]->SetMaxRecords(mode == 3 ? 12345 : 0);
+      readers[r]->SetMergeConsecutiveDelimiters(mode == 1);
+      readers[r]->SetParseInParallel(r == 1);
+      readers[r]->Update();
+      }
+    if(!CompareTables(serial->GetOutput(), parallel->GetOutput()))
+      {
+      cerr << "Wrong table in mode " << mode << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
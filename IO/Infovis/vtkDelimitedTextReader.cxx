@@ -21,16 +21,20 @@
 #include "vtkDelimitedTextReader.h"
 #include "vtkCommand.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 #include "vtkUnicodeStringArray.h"
 #include "vtkStringArray.h"
 #include "vtkStringToNumeric.h"
+#include "vtkVariant.h"
 
 #include "vtkTextCodec.h"
 #include "vtkTextCodecFactory.h"
@@ -354,6 +358,324 @@ private:
   vtkUnicodeString::value_type WithinString;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// Chunked parsing
+
+/// A piece of ASCII text that starts at the beginning of a record, and the
+/// fields of its records once it is parsed.
+struct DelimitedTextChunk
+{
+  DelimitedTextChunk() :
+    Begin(0),
+    End(0),
+    NonASCII(false),
+    PendingEscape(false)
+  {
+  }
+
+  const char* Begin;
+  const char* End;
+  std::vector<std::string> Fields;
+  // For each record, the index one past its last field in Fields
+  std::vector<size_t> RecordEnds;
+  bool NonASCII;
+  bool PendingEscape;
+};
+
+/// Parses chunks of text with the rules of DelimitedTextIterator.  Record
+/// delimiters end quoted strings there, so a chunk that starts after a record
+/// delimiter is parsed as the serial parser would, unless an escape character
+/// is left pending at the end of the previous chunk.
+class DelimitedTextChunkParser
+{
+public:
+  DelimitedTextChunkParser(
+    DelimitedTextChunk* chunks,
+    vtkIdType number_of_chunks,
+    const bool* record_delimiters,
+    const bool* field_delimiters,
+    const bool* string_delimiters,
+    const bool* whitespace,
+    bool merge_cons_delimiters,
+    bool use_string_delimiter) :
+    Chunks(chunks),
+    NumberOfChunks(number_of_chunks),
+    RecordDelimiters(record_delimiters),
+    FieldDelimiters(field_delimiters),
+    StringDelimiters(string_delimiters),
+    Whitespace(whitespace),
+    MergeConsDelims(merge_cons_delimiters),
+    UseStringDelimiter(use_string_delimiter)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for(vtkIdType i = begin; i < end; ++i)
+      {
+      this->Parse(this->Chunks[i], i == this->NumberOfChunks - 1);
+      }
+  }
+
+private:
+  void Parse(DelimitedTextChunk& chunk, bool last_chunk) const
+  {
+    std::string field;
+    bool record_adjacent = true;
+    bool escape = false;
+    char within_string = 0;
+    for(const char* c = chunk.Begin; c != chunk.End; ++c)
+      {
+      const unsigned char value = static_cast<unsigned char>(*c);
+      if(value > 0x7f)
+        {
+        chunk.NonASCII = true;
+        return;
+        }
+
+      if(record_adjacent &&
+        (this->RecordDelimiters[value] || this->Whitespace[value]))
+        {
+        continue;
+        }
+      record_adjacent = false;
+
+      if(this->RecordDelimiters[value])
+        {
+        chunk.Fields.push_back(field);
+        chunk.RecordEnds.push_back(chunk.Fields.size());
+        field.clear();
+        record_adjacent = true;
+        within_string = 0;
+        continue;
+        }
+
+      if(!within_string && this->FieldDelimiters[value])
+        {
+        if(!(field.empty() && this->MergeConsDelims))
+          {
+          chunk.Fields.push_back(field);
+          field.clear();
+          }
+        continue;
+        }
+
+      if(!escape && value == '\\')
+        {
+        escape = true;
+        continue;
+        }
+
+      if(escape)
+        {
+        switch(value)
+          {
+          case '0': break;
+          case 'a': field += '\a'; break;
+          case 'b': field += '\b'; break;
+          case 't': field += '\t'; break;
+          case 'n': field += '\n'; break;
+          case 'v': field += '\v'; break;
+          case 'f': field += '\f'; break;
+          case 'r': field += '\r'; break;
+          default: field += *c; break;
+          }
+        escape = false;
+        continue;
+        }
+
+      if(!within_string && this->StringDelimiters[value] &&
+        this->UseStringDelimiter)
+        {
+        within_string = *c;
+        field.clear();
+        continue;
+        }
+
+      if(within_string && within_string == *c && this->UseStringDelimiter)
+        {
+        within_string = 0;
+        continue;
+        }
+
+      field += *c;
+      }
+
+    // The last record may not end with a record delimiter ...
+    if(last_chunk)
+      {
+      if(!field.empty())
+        {
+        const unsigned char value =
+          static_cast<unsigned char>(field[field.size() - 1]);
+        if(!this->RecordDelimiters[value] && !this->Whitespace[value])
+          {
+          chunk.Fields.push_back(field);
+          }
+        }
+      size_t record_start =
+        chunk.RecordEnds.empty() ? 0 : chunk.RecordEnds.back();
+      if(chunk.Fields.size() > record_start)
+        {
+        chunk.RecordEnds.push_back(chunk.Fields.size());
+        }
+      }
+    chunk.PendingEscape = escape;
+  }
+
+  DelimitedTextChunk* Chunks;
+  vtkIdType NumberOfChunks;
+  const bool* RecordDelimiters;
+  const bool* FieldDelimiters;
+  const bool* StringDelimiters;
+  const bool* Whitespace;
+  bool MergeConsDelims;
+  bool UseStringDelimiter;
+};
+
+/// The fields of a record of a parsed chunk.
+struct DelimitedTextRecord
+{
+  const std::string* Fields;
+  size_t NumberOfFields;
+};
+
+/// Builds the columns of the output from the parsed records, detecting the
+/// numeric columns as vtkStringToNumeric does.
+class DelimitedTextColumnBuilder
+{
+public:
+  DelimitedTextColumnBuilder(
+    const DelimitedTextRecord* rows,
+    vtkIdType number_of_rows,
+    vtkAbstractArray** columns,
+    bool detect_numeric_columns,
+    bool force_double,
+    bool trim_whitespace,
+    int default_integer_value,
+    double default_double_value) :
+    Rows(rows),
+    NumberOfRows(number_of_rows),
+    Columns(columns),
+    DetectNumericColumns(detect_numeric_columns),
+    ForceDouble(force_double),
+    TrimWhitespace(trim_whitespace),
+    DefaultIntegerValue(default_integer_value),
+    DefaultDoubleValue(default_double_value)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for(vtkIdType column = begin; column < end; ++column)
+      {
+      vtkAbstractArray* array = NULL;
+      if(this->DetectNumericColumns)
+        {
+        array = this->BuildNumericColumn(static_cast<size_t>(column));
+        }
+      if(!array)
+        {
+        vtkStringArray* strings = vtkStringArray::New();
+        strings->SetNumberOfValues(this->NumberOfRows);
+        for(vtkIdType row = 0; row < this->NumberOfRows; ++row)
+          {
+          strings->SetValue(row, this->GetField(row, column));
+          }
+        array = strings;
+        }
+      this->Columns[column] = array;
+      }
+  }
+
+private:
+  std::string GetField(vtkIdType row, size_t column) const
+  {
+    const DelimitedTextRecord& record = this->Rows[row];
+    return column < record.NumberOfFields ?
+      record.Fields[column] : std::string();
+  }
+
+  std::string GetNumericField(vtkIdType row, size_t column) const
+  {
+    std::string str = this->GetField(row, column);
+    if(this->TrimWhitespace)
+      {
+      size_t startPos = str.find_first_not_of(" \n\t\r");
+      if(startPos == std::string::npos)
+        {
+        return std::string();
+        }
+      size_t endPos = str.find_last_not_of(" \n\t\r");
+      str = str.substr(startPos, endPos-startPos+1);
+      }
+    return str;
+  }
+
+  vtkAbstractArray* BuildNumericColumn(size_t column) const
+  {
+    bool ok = true;
+    if(!this->ForceDouble && this->NumberOfRows > 0)
+      {
+      vtkIntArray* ints = vtkIntArray::New();
+      ints->SetNumberOfTuples(this->NumberOfRows);
+      for(vtkIdType row = 0; ok && row < this->NumberOfRows; ++row)
+        {
+        std::string str = this->GetNumericField(row, column);
+        ints->SetValue(row, str.empty() ? this->DefaultIntegerValue :
+          vtkVariant(str).ToInt(&ok));
+        }
+      if(ok)
+        {
+        return ints;
+        }
+      ints->Delete();
+      }
+
+    ok = true;
+    vtkDoubleArray* doubles = vtkDoubleArray::New();
+    doubles->SetNumberOfTuples(this->NumberOfRows);
+    for(vtkIdType row = 0; ok && row < this->NumberOfRows; ++row)
+      {
+      std::string str = this->GetNumericField(row, column);
+      doubles->SetValue(row, str.empty() ? this->DefaultDoubleValue :
+        vtkVariant(str).ToDouble(&ok));
+      }
+    if(ok)
+      {
+      return doubles;
+      }
+    doubles->Delete();
+    return NULL;
+  }
+
+  const DelimitedTextRecord* Rows;
+  vtkIdType NumberOfRows;
+  vtkAbstractArray** Columns;
+  bool DetectNumericColumns;
+  bool ForceDouble;
+  bool TrimWhitespace;
+  int DefaultIntegerValue;
+  double DefaultDoubleValue;
+};
+
+// Marks the ASCII code points of delimiters in a table, returns false if one
+// of them is not ASCII.
+bool MarkDelimiters(const vtkUnicodeString& delimiters, bool* table)
+{
+  std::fill(table, table + 128, false);
+  for(vtkUnicodeString::const_iterator i = delimiters.begin();
+      i != delimiters.end(); ++i)
+    {
+    if(*i > 0x7f)
+      {
+      return false;
+      }
+    table[*i] = true;
+    }
+  return true;
+}
+
 } // End anonymous namespace
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -384,6 +706,8 @@ vtkDelimitedTextReader::vtkDelimitedTextReader() :
   this->SetPedigreeIdArrayName("id");
   this->GeneratePedigreeIds = true;
   this->OutputPedigreeIds = false;
+  this->PackStringColumns = false;
+  this->ParseInParallel = false;
   this->UnicodeOutputArrays = false;
   this->FieldDelimiterCharacters = 0;
   this->SetFieldDelimiterCharacters(",");
@@ -457,6 +781,10 @@ void vtkDelimitedTextReader::PrintSelf(ostream& os, vtkIndent indent)
     << this->PedigreeIdArrayName << endl;
   os << indent << "OutputPedigreeIds: "
     << (this->OutputPedigreeIds? "true" : "false") << endl;
+  os << indent << "PackStringColumns: "
+    << (this->PackStringColumns? "true" : "false") << endl;
+  os << indent << "ParseInParallel: "
+    << (this->ParseInParallel? "true" : "false") << endl;
 }
 
 void vtkDelimitedTextReader::SetInputString(const char *in)
@@ -569,6 +897,148 @@ vtkStdString vtkDelimitedTextReader::GetLastError()
   return this->LastError;
 }
 
+bool vtkDelimitedTextReader::ReadTableInParallel(istream& input,
+                                                 vtkTable* output)
+{
+  bool record_delimiters[128];
+  bool field_delimiters[128];
+  bool string_delimiters[128];
+  bool whitespace[128];
+  if(!MarkDelimiters(this->UnicodeRecordDelimiters, record_delimiters) ||
+     !MarkDelimiters(this->UnicodeFieldDelimiters, field_delimiters) ||
+     !MarkDelimiters(this->UnicodeStringDelimiters, string_delimiters) ||
+     !MarkDelimiters(this->UnicodeWhitespace, whitespace) ||
+     this->UnicodeEscapeCharacter != vtkUnicodeString::from_utf8("\\"))
+    {
+    return false;
+    }
+
+  input.seekg(0, ios::end);
+  const std::streamoff total_bytes = input.tellg();
+  input.seekg(0, ios::beg);
+  if(total_bytes < 0)
+    {
+    return false;
+    }
+  std::vector<char> text(static_cast<size_t>(total_bytes));
+  if(!text.empty())
+    {
+    input.read(&text[0], total_bytes);
+    if(input.gcount() != total_bytes)
+      {
+      return false;
+      }
+    }
+  const char* const text_begin = text.empty() ? NULL : &text[0];
+  const char* const text_end = text_begin + text.size();
+
+  // Cut the text into chunks of at least 64 KiB, each one starting after a
+  // record delimiter ...
+  const size_t min_chunk_size = 65536;
+  const size_t max_chunks = 4096;
+  const size_t number_of_chunks =
+    std::max<size_t>(1, std::min(text.size() / min_chunk_size, max_chunks));
+  std::vector<DelimitedTextChunk> chunks;
+  const char* chunk_begin = text_begin;
+  for(size_t i = 1; i <= number_of_chunks && chunk_begin != text_end; ++i)
+    {
+    const char* chunk_end = text_end;
+    if(i < number_of_chunks)
+      {
+      chunk_end = std::max(chunk_begin + 1,
+        text_begin + (text.size() / number_of_chunks) * i);
+      while(chunk_end != text_end)
+        {
+        const unsigned char value = static_cast<unsigned char>(chunk_end[-1]);
+        if(value <= 0x7f && record_delimiters[value])
+          {
+          break;
+          }
+        ++chunk_end;
+        }
+      }
+    DelimitedTextChunk chunk;
+    chunk.Begin = chunk_begin;
+    chunk.End = chunk_end;
+    chunks.push_back(chunk);
+    chunk_begin = chunk_end;
+    }
+  if(chunks.empty())
+    {
+    DelimitedTextChunk chunk;
+    chunk.Begin = chunk.End = text_begin;
+    chunks.push_back(chunk);
+    }
+
+  const vtkIdType numChunks = static_cast<vtkIdType>(chunks.size());
+  DelimitedTextChunkParser parser(&chunks[0], numChunks, record_delimiters,
+    field_delimiters, string_delimiters, whitespace,
+    this->MergeConsecutiveDelimiters, this->UseStringDelimiter);
+  vtkSMPTools::For(0, numChunks, 1, parser);
+
+  // ... and gather their records, falling back to the serial parser for
+  // non-ASCII text or an escape character left pending between chunks.
+  std::vector<DelimitedTextRecord> records;
+  for(vtkIdType i = 0; i < numChunks; ++i)
+    {
+    const DelimitedTextChunk& chunk = chunks[i];
+    if(chunk.NonASCII || (chunk.PendingEscape && i < numChunks - 1))
+      {
+      return false;
+      }
+    size_t record_start = 0;
+    for(size_t r = 0; r < chunk.RecordEnds.size(); ++r)
+      {
+      DelimitedTextRecord record;
+      record.Fields = &chunk.Fields[record_start];
+      record.NumberOfFields = chunk.RecordEnds[r] - record_start;
+      records.push_back(record);
+      record_start = chunk.RecordEnds[r];
+      }
+    }
+  const vtkIdType max_record_index =
+    this->HaveHeaders ? this->MaxRecords + 1 : this->MaxRecords;
+  if(this->MaxRecords &&
+    static_cast<vtkIdType>(records.size()) > max_record_index)
+    {
+    records.resize(max_record_index);
+    }
+  if(records.empty())
+    {
+    return true;
+    }
+
+  // The first record gives the columns ...
+  const size_t number_of_columns = records[0].NumberOfFields;
+  const size_t first_row = this->HaveHeaders ? 1 : 0;
+  const vtkIdType number_of_rows =
+    static_cast<vtkIdType>(records.size() - first_row);
+  std::vector<vtkAbstractArray*> columns(number_of_columns,
+    static_cast<vtkAbstractArray*>(NULL));
+  DelimitedTextColumnBuilder builder(number_of_rows ? &records[first_row] : NULL,
+    number_of_rows, &columns[0], this->DetectNumericColumns,
+    this->ForceDouble, this->TrimWhitespacePriorToNumericConversion,
+    this->DefaultIntegerValue, this->DefaultDoubleValue);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(number_of_columns), 1, builder);
+
+  for(size_t i = 0; i != number_of_columns; ++i)
+    {
+    if(this->HaveHeaders)
+      {
+      columns[i]->SetName(records[0].Fields[i].c_str());
+      }
+    else
+      {
+      std::stringstream buffer;
+      buffer << "Field " << i;
+      columns[i]->SetName(buffer.str().c_str());
+      }
+    output->AddColumn(columns[i]);
+    columns[i]->Delete();
+    }
+  return true;
+}
+
 int vtkDelimitedTextReader::RequestData(
   vtkInformation*,
   vtkInformationVector**,
@@ -624,6 +1094,7 @@ int vtkDelimitedTextReader::RequestData(
 
     vtkStdString character_set;
     vtkTextCodec* transCodec = NULL;
+    bool parsed_in_parallel = false;
 
     if(this->UnicodeCharacterSet)
       {
@@ -643,33 +1114,46 @@ int vtkDelimitedTextReader::RequestData(
       this->UnicodeStringDelimiters =
         vtkUnicodeString::from_utf8(tstring);
       this->UnicodeOutputArrays = false;
-      transCodec = vtkTextCodecFactory::CodecToHandle(*input_stream_pt);
+      if(this->ParseInParallel)
+        {
+        parsed_in_parallel =
+          this->ReadTableInParallel(*input_stream_pt, output_table);
+        input_stream_pt->clear();
+        input_stream_pt->seekg(0, ios::beg);
+        }
+      if(!parsed_in_parallel)
+        {
+        transCodec = vtkTextCodecFactory::CodecToHandle(*input_stream_pt);
+        }
       }
 
-    if (NULL == transCodec)
+    if (!parsed_in_parallel)
       {
-      // should this use the locale instead??
-      return 1;
-      }
-
-    DelimitedTextIterator iterator(
-      this->MaxRecords,
-      this->UnicodeRecordDelimiters,
-      this->UnicodeFieldDelimiters,
-      this->UnicodeStringDelimiters,
-      this->UnicodeWhitespace,
-      this->UnicodeEscapeCharacter,
-      this->HaveHeaders,
-      this->UnicodeOutputArrays,
-      this->MergeConsecutiveDelimiters,
-      this->UseStringDelimiter,
-      output_table);
-
-    vtkTextCodec::OutputIterator& outIter = iterator;
+      if (NULL == transCodec)
+        {
+        // should this use the locale instead??
+        return 1;
+        }
 
-    transCodec->ToUnicode(*input_stream_pt, outIter);
-    iterator.ReachedEndOfInput();
-    transCodec->Delete();
+      DelimitedTextIterator iterator(
+        this->MaxRecords,
+        this->UnicodeRecordDelimiters,
+        this->UnicodeFieldDelimiters,
+        this->UnicodeStringDelimiters,
+        this->UnicodeWhitespace,
+        this->UnicodeEscapeCharacter,
+        this->HaveHeaders,
+        this->UnicodeOutputArrays,
+        this->MergeConsecutiveDelimiters,
+        this->UseStringDelimiter,
+        output_table);
+
+      vtkTextCodec::OutputIterator& outIter = iterator;
+
+      transCodec->ToUnicode(*input_stream_pt, outIter);
+      iterator.ReachedEndOfInput();
+      transCodec->Delete();
+      }
 
     if(this->OutputPedigreeIds)
       {
@@ -703,7 +1187,8 @@ int vtkDelimitedTextReader::RequestData(
       }
     }
 
-    if (this->DetectNumericColumns && !this->UnicodeOutputArrays)
+    if (this->DetectNumericColumns && !this->UnicodeOutputArrays &&
+        !parsed_in_parallel)
       {
       vtkStringToNumeric* converter = vtkStringToNumeric::New();
       converter->SetForceDouble(this->ForceDouble);
@@ -719,6 +1204,19 @@ int vtkDelimitedTextReader::RequestData(
       converter->Delete();
       }
 
+    if (this->PackStringColumns)
+      {
+      for (vtkIdType i = 0; i < output_table->GetNumberOfColumns(); ++i)
+        {
+        vtkStringArray* column =
+          vtkStringArray::SafeDownCast(output_table->GetColumn(i));
+        if (column)
+          {
+          column->Pack(1);
+          }
+        }
+      }
+
     }
   catch(std::exception& e)
     {
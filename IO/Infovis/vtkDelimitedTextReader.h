@@ -241,6 +241,27 @@ public:
   vtkGetMacro(OutputPedigreeIds, bool);
   vtkBooleanMacro(OutputPedigreeIds, bool);
 
+  // Description:
+  // If on, the vtkStringArray columns of the output are packed and
+  // dictionary encoded (see vtkStringArray::Pack), which saves memory
+  // for columns of short or repeated strings. Defaults to off.
+  vtkSetMacro(PackStringColumns, bool);
+  vtkGetMacro(PackStringColumns, bool);
+  vtkBooleanMacro(PackStringColumns, bool);
+
+  // Description:
+  // If on, ASCII input read without a UnicodeCharacterSet is split into
+  // chunks after record delimiters and the chunks are parsed concurrently
+  // with vtkSMPTools. With DetectNumericColumns, the numeric columns are
+  // then written directly into vtkIntArray or vtkDoubleArray, by the rules
+  // of vtkStringToNumeric, instead of going through vtkStringArray.
+  // Fields, quoted strings and escape sequences are split as in the serial
+  // parser. Input with non-ASCII characters or with delimiters the chunked
+  // parser cannot handle is read serially. Defaults to off.
+  vtkSetMacro(ParseInParallel, bool);
+  vtkGetMacro(ParseInParallel, bool);
+  vtkBooleanMacro(ParseInParallel, bool);
+
   // Description:
   // Returns a human-readable description of the most recent error, if any.
   // Otherwise, returns an empty string.  Note that the result is only valid
@@ -264,6 +285,12 @@ protected:
     vtkInformationVector**,
     vtkInformationVector*);
 
+  // Description:
+  // Parses the whole input in chunks into the columns of the output.
+  // Returns false, leaving the output untouched, when the input must be
+  // parsed serially.
+  bool ReadTableInParallel(istream& input, vtkTable* output);
+
   char* FileName;
   int ReadFromInputString;
   char *InputString;
@@ -289,6 +316,8 @@ protected:
   char* PedigreeIdArrayName;
   bool GeneratePedigreeIds;
   bool OutputPedigreeIds;
+  bool PackStringColumns;
+  bool ParseInParallel;
   vtkStdString LastError;
   vtkTypeUInt32 ReplacementCharacter;
 
@@ -26,11 +26,13 @@
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
+#include <map>
 #include <vector>
 #include <list>
 
@@ -470,6 +472,7 @@ vtkLSDynaPartCollection::vtkLSDynaPartCollection()
   this->Storage = NULL;
   this->MinIds = NULL;
   this->MaxIds = NULL;
+  this->DecodeInParallel = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -489,6 +492,8 @@ void vtkLSDynaPartCollection::PrintSelf(ostream &os, vtkIndent indent)
 
   //number of parts
   os << indent << "Number of Parts: " << this->GetNumberOfParts() << std::endl;
+  os << indent << "DecodeInParallel: "
+     << (this->DecodeInParallel ? "On" : "Off") << std::endl;
 
   //print self for each part
   this->Storage->PrintSelf(os,indent.GetNextIndent());
@@ -649,6 +654,43 @@ void vtkLSDynaPartCollection::FillCellProperties(double *buffer,
   this->FillCellArray(buffer,type,startId,numCells,numPropertiesInCell);
 }
 
+namespace
+{
+  //copies the runs of cells of a chunk into their parts, one part per task.
+  //The runs of a part are kept in file order, as each part appends the
+  //values of its cells to its arrays.
+  template<typename T>
+  class FillPartCellProperties
+  {
+  public:
+    typedef std::vector<std::pair<T*,vtkIdType> > Runs;
+
+    FillPartCellProperties(vtkLSDynaPart **parts, const Runs *runs,
+                           const vtkIdType& numPropertiesInCell):
+      Parts(parts), PartRuns(runs), NumPropertiesInCell(numPropertiesInCell)
+    {
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end) const
+    {
+      for(vtkIdType i=begin; i < end; ++i)
+        {
+        const Runs &runs = this->PartRuns[i];
+        for(size_t r=0; r < runs.size(); ++r)
+          {
+          this->Parts[i]->ReadCellProperties(runs[r].first,runs[r].second,
+                                             this->NumPropertiesInCell);
+          }
+        }
+    }
+
+  protected:
+    vtkLSDynaPart **Parts;
+    const Runs *PartRuns;
+    vtkIdType NumPropertiesInCell;
+  };
+}
+
 //-----------------------------------------------------------------------------
 template<typename T>
 void vtkLSDynaPartCollection::FillCellArray(T *buffer,
@@ -659,6 +701,9 @@ void vtkLSDynaPartCollection::FillCellArray(T *buffer,
   T* loc = buffer;
   vtkIdType size, globalStartId;
   vtkLSDynaPart *part;
+  std::vector<vtkLSDynaPart*> parts;
+  std::vector<typename FillPartCellProperties<T>::Runs> runs;
+  std::map<vtkLSDynaPart*,size_t> partIndex;
   this->Storage->InitCellIteration(type,startId);
   while(this->Storage->GetNextCellPart(globalStartId,size,part))
     {
@@ -669,12 +714,30 @@ void vtkLSDynaPartCollection::FillCellArray(T *buffer,
       break;
       }
     vtkIdType is = end - start;
-    if(part)
+    if(part && !this->DecodeInParallel)
       {
       part->ReadCellProperties(loc,is,numPropertiesInCell);
       }
+    else if(part)
+      {
+      //a material can own several runs of cells, so group them by part
+      std::map<vtkLSDynaPart*,size_t>::iterator it = partIndex.find(part);
+      if(it == partIndex.end())
+        {
+        it = partIndex.insert(std::make_pair(part,parts.size())).first;
+        parts.push_back(part);
+        runs.resize(parts.size());
+        }
+      runs[it->second].push_back(std::make_pair(loc,is));
+      }
     loc += is * numPropertiesInCell;
     }
+
+  if(!parts.empty())
+    {
+    FillPartCellProperties<T> fill(&parts[0],&runs[0],numPropertiesInCell);
+    vtkSMPTools::For(0,static_cast<vtkIdType>(parts.size()),fill);
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -917,6 +980,63 @@ namespace
     }
 }
 
+namespace
+{
+  //copies the points of a chunk that each part of a range uses into the part
+  template<typename T>
+  class ReadPartPointProperties
+  {
+  public:
+    ReadPartPointProperties(vtkLSDynaPart **parts, T *buffer,
+                            const vtkIdType& numTuples,
+                            const vtkIdType& numComps,
+                            const vtkIdType& offset):
+      Parts(parts), Buffer(buffer), NumTuples(numTuples), NumComps(numComps),
+      Offset(offset)
+    {
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end) const
+    {
+      for(vtkIdType i=begin; i < end; ++i)
+        {
+        this->Parts[i]->ReadPointBasedProperty(this->Buffer,this->NumTuples,
+                                               this->NumComps,this->Offset);
+        }
+    }
+
+  protected:
+    vtkLSDynaPart **Parts;
+    T *Buffer;
+    vtkIdType NumTuples;
+    vtkIdType NumComps;
+    vtkIdType Offset;
+  };
+
+  template<typename T>
+  void ReadPointChunk(std::list<vtkLSDynaPart*>::iterator first,
+                      std::list<vtkLSDynaPart*>::iterator last,
+                      T *buf, const vtkIdType& numTuples,
+                      const vtkIdType& numComps, const vtkIdType& offset,
+                      bool inParallel)
+  {
+    if(!inParallel)
+      {
+      for(;first!=last;++first)
+        {
+        (*first)->ReadPointBasedProperty(buf,numTuples,numComps,offset);
+        }
+      return;
+      }
+    std::vector<vtkLSDynaPart*> parts(first,last);
+    if(!parts.empty())
+      {
+      ReadPartPointProperties<T> read(&parts[0],buf,numTuples,numComps,offset);
+      vtkSMPTools::For(0,static_cast<vtkIdType>(parts.size()),read);
+      }
+  }
+}
+
 //-----------------------------------------------------------------------------
 template<typename T>
 void vtkLSDynaPartCollection::FillPointProperty(const vtkIdType& numTuples,
@@ -969,22 +1089,17 @@ void vtkLSDynaPartCollection::FillPointProperty(const vtkIdType& numTuples,
       partIt = sortedParts.begin();
       }
 
-    while(partIt!=sortedParts.end())
-      {
-      //only read the points which have a point that lies within this section
-      //so we stop once the min is larger than our max id
-      (*partIt)->ReadPointBasedProperty(buf,numPointsToRead,numComps,offset);
-      ++partIt;
-      }
+    //only read the points which have a point that lies within this section
+    //so we stop once the min is larger than our max id
+    ReadPointChunk(partIt,sortedParts.end(),buf,numPointsToRead,numComps,
+                   offset,this->DecodeInParallel);
     }
   if(leftOver>0 && !sortedParts.empty())
     {
     p->Fam.BufferChunk(LSDynaFamily::Float, leftOver*numComps);
     buf = p->Fam.GetBufferAs<T>();
-    for (partIt = sortedParts.begin(); partIt!=sortedParts.end();++partIt)
-      {
-      (*partIt)->ReadPointBasedProperty(buf,leftOver,numComps,offset);
-      }
+    ReadPointChunk(sortedParts.begin(),sortedParts.end(),buf,leftOver,
+                   numComps,offset,this->DecodeInParallel);
     }
   p->Fam.SkipWords(numPointsToSkipEnd * numComps);
 }
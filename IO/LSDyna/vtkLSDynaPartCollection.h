@@ -127,12 +127,20 @@ public:
     this->FillCellUserIdArray(buffer,type,startId,numCells);
     }
 
+  //Description:
+  //When on, the state values of a buffered chunk are copied into the
+  //parts concurrently, one part per task. Parts own their arrays, so
+  //no two tasks write to the same memory. Off by default.
+  vtkSetMacro(DecodeInParallel,bool);
+  vtkGetMacro(DecodeInParallel,bool);
+
 protected:
   vtkLSDynaPartCollection();
   ~vtkLSDynaPartCollection();
 
   vtkIdType* MinIds;
   vtkIdType* MaxIds;
+  bool DecodeInParallel;
 
   //Builds up the basic meta information needed for topology storage
   void BuildPartInfo();
@@ -529,6 +529,7 @@ vtkLSDynaReader::vtkLSDynaReader()
   this->DeformedMesh = 1;
   this->RemoveDeletedCells = 1;
   this->DeletedCellsAsGhostArray = 0;
+  this->DecodeStatesInParallel = 0;
   this->InputDeck = 0;
   this->Parts = NULL;
 }
@@ -561,6 +562,8 @@ void vtkLSDynaReader::PrintSelf( ostream &os, vtkIndent indent )
     }
   os << indent << "Show Deleted Cells as Ghost Cells: "<<
         (this->DeletedCellsAsGhostArray ? "On" : "Off") << endl;
+  os << indent << "DecodeStatesInParallel: "
+     << (this->DecodeStatesInParallel ? "On" : "Off") << endl;
 
   os << indent << "Dimensionality: " << this->GetDimensionality() << endl;
   os << indent << "Nodes: " << this->GetNumberOfNodes() << endl;
@@ -3556,6 +3559,10 @@ int vtkLSDynaReader::RequestData(
 
   //Read in the topology information for caching
   this->ReadTopology();
+  if(this->Parts)
+    {
+    this->Parts->SetDecodeInParallel(this->DecodeStatesInParallel != 0);
+    }
 
   // Adapted element parent list
   // This isn't even implemented by LS-Dyna yet
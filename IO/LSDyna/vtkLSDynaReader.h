@@ -426,6 +426,16 @@ public:
   vtkGetMacro(DeletedCellsAsGhostArray,int);
   vtkBooleanMacro(DeletedCellsAsGhostArray,int);
 
+  // Description:
+  // Should the values of each time state be copied into the parts
+  // concurrently? The file is still read one chunk at a time; only the
+  // distribution of a chunk among the parts is done in parallel, with
+  // vtkSMPTools. The topology is read once and reused by all the states.
+  // By default, this is false.
+  vtkSetMacro(DecodeStatesInParallel,int);
+  vtkGetMacro(DecodeStatesInParallel,int);
+  vtkBooleanMacro(DecodeStatesInParallel,int);
+
   // Description:
   // The name of the input deck corresponding to the current database.
   // This is used to determine the part names associated with each material ID.
@@ -470,6 +480,11 @@ protected:
   int RemoveDeletedCells;
   int DeletedCellsAsGhostArray;
 
+  // Description:
+  // Should the state values be distributed among the parts in parallel?
+  // By default, this is false.
+  int DecodeStatesInParallel;
+
   // Description:
   // The range of time steps available within a database.
   // Only valid after UpdateInformation() is called on the reader.
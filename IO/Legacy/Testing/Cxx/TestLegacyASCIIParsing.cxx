@@ -0,0 +1,175 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyASCIIParsing.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that the values of an ASCII legacy file, written in various
+// formats and separated by various white space, are read as the values
+// parsed one by one with a stream in the classic locale.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+
+#include <cmath>
+#include <cstdio>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Append the tokens of values to text and their values to expected.
+template <class T>
+void AddValues(std::ostringstream &text, std::vector<T> &expected,
+               const std::vector<std::string> &tokens)
+{
+  for (size_t i = 0; i < tokens.size(); ++i)
+    {
+    std::istringstream in(tokens[i]);
+    in.imbue(std::locale::classic());
+    T value;
+    in >> value;
+    expected.push_back(value);
+    text << tokens[i] << ((i % 7 == 6) ? "\n" : (i % 5 == 4) ? " \t " : " ");
+    }
+  text << "\n";
+}
+
+template <class T>
+bool Compare(vtkDataArray *array, const std::vector<T> &expected,
+             const char *what)
+{
+  vtkIdType numValues = array ? array->GetNumberOfTuples() *
+    array->GetNumberOfComponents() : 0;
+  if (numValues != static_cast<vtkIdType>(expected.size()))
+    {
+    cerr << what << " has " << numValues << " values instead of "
+         << expected.size() << endl;
+    return false;
+    }
+  T *values = static_cast<T *>(array->GetVoidPointer(0));
+  for (vtkIdType i = 0; i < numValues; ++i)
+    {
+    if (values[i] != expected[i])
+      {
+      cerr << what << " value " << i << " is " << values[i] << " instead of "
+           << expected[i] << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int TestLegacyASCIIParsing(int, char *[])
+{
+  const int numPoints = 20000;
+  const char *formats[] = { "%.9g", "%.17g", "%g", "%e", "%.3f", "%.12E" };
+  vtkMath::RandomSeed(95);
+
+  std::vector<std::string> reals;
+  std::vector<std::string> integers;
+  std::vector<std::string> bytes;
+  char token[64];
+  for (int i = 0; i < 3 * numPoints; ++i)
+    {
+    double value = vtkMath::Random(-1.0, 1.0) *
+      pow(10.0, floor(vtkMath::Random(-20.0, 20.0)));
+    sprintf(token, formats[i % 6], value);
+    reals.push_back(token);
+    }
+  const char *special[] = { "0", "-0", "+5", "1.5e-38", "1e-30", ".5",
+                            "-.25e1", "1.", "12345678901234567890",
+                            "3.4028234e38" };
+  for (int i = 0; i < 10; ++i)
+    {
+    reals[17 * i] = special[i];
+    }
+  for (int i = 0; i < numPoints; ++i)
+    {
+    sprintf(token, "%d",
+            static_cast<int>(vtkMath::Random(-2147483647.0, 2147483647.0)));
+    integers.push_back(token);
+    sprintf(token, (i % 3 ? "%d" : "+%d"),
+            static_cast<int>(vtkMath::Random(0.0, 256.0)));
+    bytes.push_back(token);
+    }
+  integers[3] = "-2147483648";
+  integers[4] = "2147483647";
+
+  std::ostringstream text;
+  std::vector<float> points;
+  std::vector<double> doubles;
+  std::vector<int> ints;
+  std::vector<int> byteValues;
+  text << "# vtk DataFile Version 3.0\nASCII parsing\nASCII\n"
+       << "DATASET POLYDATA\nPOINTS " << numPoints << " float\n";
+  AddValues(text, points, reals);
+  text << "VERTICES " << numPoints << " " << 2 * numPoints << "\n";
+  for (int i = 0; i < numPoints; ++i)
+    {
+    text << "1 " << i << "\n";
+    }
+  text << "POINT_DATA " << numPoints << "\nFIELD FieldData 3\n"
+       << "Doubles 3 " << numPoints << " double\n";
+  AddValues(text, doubles, reals);
+  text << "Ints 1 " << numPoints << " int\n";
+  AddValues(text, ints, integers);
+  text << "Bytes 1 " << numPoints << " unsigned_char\n";
+  AddValues(text, byteValues, bytes);
+
+  vtkNew<vtkPolyDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(text.str());
+  reader->Update();
+  vtkPolyData *output = reader->GetOutput();
+  if (!output->GetPoints() ||
+      !Compare(output->GetPoints()->GetData(), points, "Points") ||
+      !Compare(output->GetPointData()->GetArray("Doubles"), doubles,
+               "Doubles") ||
+      !Compare(output->GetPointData()->GetArray("Ints"), ints, "Ints"))
+    {
+    return EXIT_FAILURE;
+    }
+  if (output->GetVerts()->GetNumberOfCells() != numPoints)
+    {
+    cerr << "Wrong number of vertices" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkDataArray *read = output->GetPointData()->GetArray("Bytes");
+  if (!read || read->GetNumberOfTuples() != numPoints)
+    {
+    cerr << "No bytes read" << endl;
+    return EXIT_FAILURE;
+    }
+  for (int i = 0; i < numPoints; ++i)
+    {
+    if (read->GetTuple1(i) != byteValues[i])
+      {
+      cerr << "Byte " << i << " is " << read->GetTuple1(i) << " instead of "
+           << byteValues[i] << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
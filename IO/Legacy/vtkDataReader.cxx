@@ -21,6 +21,7 @@
 #include "vtkDoubleArray.h"
 #include "vtkErrorCode.h"
 #include "vtkFieldData.h"
+#include "vtkFileMappedDataArrayAllocator.h"
 #include "vtkFloatArray.h"
 #include "vtkGraph.h"
 #include "vtkIdTypeArray.h"
@@ -35,6 +36,8 @@
 #include "vtkPointSet.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkShortArray.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
@@ -49,7 +52,11 @@
 
 #include "vtkTypeUInt64Array.h"
 
+#include <algorithm>
 #include <cctype>
+#include <limits>
+#include <locale>
+#include <vector>
 #include <sys/stat.h>
 
 // I need a safe way to read a line of arbitrary length.  It exists on
@@ -87,6 +94,7 @@ vtkDataReader::vtkDataReader()
   this->InputStringLength = 0;
   this->InputStringPos = 0;
   this->ReadFromInputString = 0;
+  this->MemoryMapping = 0;
   this->IS = NULL;
   this->Header = NULL;
 
@@ -1335,27 +1343,362 @@ int vtkReadBinaryData(istream *IS, T *data, int numTuples, int numComp)
   return 1;
 }
 
-// General templated function to read data of various types.
+// The type of the values parsed for each type of array.  Characters are
+// written to ASCII files as integers.
+template <class T> struct vtkDataReaderASCIIType { typedef T Type; };
+template <> struct vtkDataReaderASCIIType<char> { typedef int Type; };
+template <> struct vtkDataReaderASCIIType<unsigned char> { typedef int Type; };
+
+// Parse a value of the text the way the stream does in the classic
+// locale, for the tokens that the fast parsers below do not handle.
 template <class T>
-int vtkReadASCIIData(vtkDataReader *self, T *data, int numTuples, int numComp)
+static bool vtkDataReaderParseSlow(const char *first, const char *last,
+                                   T &value)
+{
+  std::istringstream in(std::string(first, last));
+  in.imbue(std::locale::classic());
+  in >> value;
+  return !in.fail() && in.peek() == EOF;
+}
+
+// Parse an integer of at most 18 digits.
+template <class T>
+static bool vtkDataReaderParseValue(const char *first, const char *last,
+                                    T &value)
+{
+  const char *p = first;
+  bool negative = false;
+  if (p != last && (*p == '-' || *p == '+'))
+    {
+    negative = (*p++ == '-');
+    }
+  if (p == last || last - p > 18 ||
+      (negative && !std::numeric_limits<T>::is_signed))
+    {
+    return vtkDataReaderParseSlow(first, last, value);
+    }
+  vtkTypeUInt64 magnitude = 0;
+  for (; p != last; ++p)
+    {
+    unsigned int digit = static_cast<unsigned char>(*p) - '0';
+    if (digit > 9)
+      {
+      return vtkDataReaderParseSlow(first, last, value);
+      }
+    magnitude = magnitude * 10 + digit;
+    }
+  if (negative)
+    {
+    vtkTypeInt64 v = -static_cast<vtkTypeInt64>(magnitude);
+    if (v < static_cast<vtkTypeInt64>(std::numeric_limits<T>::min()))
+      {
+      return vtkDataReaderParseSlow(first, last, value);
+      }
+    value = static_cast<T>(v);
+    }
+  else
+    {
+    if (magnitude > static_cast<vtkTypeUInt64>(std::numeric_limits<T>::max()))
+      {
+      return vtkDataReaderParseSlow(first, last, value);
+      }
+    value = static_cast<T>(magnitude);
+    }
+  return true;
+}
+
+// Parse a real number whose decimal mantissa and power of ten are both
+// exact in type F, so that a single multiplication or division rounds
+// the value correctly.
+template <class F>
+static bool vtkDataReaderParseReal(const char *first, const char *last,
+                                   F &value, const F *powers, int maxPower,
+                                   vtkTypeUInt64 maxMantissa)
+{
+  const char *p = first;
+  bool negative = false;
+  if (p != last && (*p == '-' || *p == '+'))
+    {
+    negative = (*p++ == '-');
+    }
+  vtkTypeUInt64 mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool any = false;
+  for (; p != last && isdigit(*p); ++p)
+    {
+    digits += (mantissa != 0 || *p != '0');
+    mantissa = mantissa * 10 + (*p - '0');
+    any = true;
+    }
+  if (p != last && *p == '.')
+    {
+    for (++p; p != last && isdigit(*p); ++p)
+      {
+      digits += (mantissa != 0 || *p != '0');
+      mantissa = mantissa * 10 + (*p - '0');
+      --exponent;
+      any = true;
+      }
+    }
+  if (any && p != last && (*p == 'e' || *p == 'E'))
+    {
+    ++p;
+    int sign = 1;
+    if (p != last && (*p == '-' || *p == '+'))
+      {
+      sign = (*p++ == '-') ? -1 : 1;
+      }
+    int e = 0;
+    const char *start = p;
+    for (; p != last && isdigit(*p) && e < 10000; ++p)
+      {
+      e = e * 10 + (*p - '0');
+      }
+    exponent += sign * e;
+    any = (p != start);
+    }
+  if (!any || p != last || digits > 19 || mantissa > maxMantissa ||
+      exponent < -maxPower || exponent > maxPower)
+    {
+    return vtkDataReaderParseSlow(first, last, value);
+    }
+  F v = static_cast<F>(mantissa);
+  v = (exponent < 0 ? v / powers[-exponent] : v * powers[exponent]);
+  value = (negative ? -v : v);
+  return true;
+}
+
+static bool vtkDataReaderParseValue(const char *first, const char *last,
+                                    float &value)
 {
-  int i, j;
+  static const float powers[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f,
+                                  1e7f, 1e8f, 1e9f, 1e10f };
+  return vtkDataReaderParseReal(first, last, value, powers, 10,
+                                static_cast<vtkTypeUInt64>(1) << 24);
+}
 
-  for (i=0; i<numTuples; i++)
+static bool vtkDataReaderParseValue(const char *first, const char *last,
+                                    double &value)
+{
+  static const double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                   1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14,
+                                   1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21,
+                                   1e22 };
+  return vtkDataReaderParseReal(first, last, value, powers, 22,
+                                static_cast<vtkTypeUInt64>(1) << 53);
+}
+
+// Copy the next count tokens of the stream to text, each followed by a
+// null character, and their starts to starts.  The characters are taken
+// from the stream buffer, which leaves the stream after the last token
+// like operator>> does.  Return the number of tokens copied.
+static vtkIdType vtkDataReaderReadTokens(istream *IS, vtkIdType count,
+                                         std::vector<char> &text,
+                                         std::vector<size_t> &starts)
+{
+  text.clear();
+  starts.clear();
+  if (!IS->good())
     {
-    for (j=0; j<numComp; j++)
+    return 0;
+    }
+  typedef std::char_traits<char> traits;
+  std::streambuf *buffer = IS->rdbuf();
+  int c = buffer->sgetc();
+  vtkIdType n = 0;
+  while (n < count)
+    {
+    while (c != traits::eof() && isspace(c))
+      {
+      c = buffer->snextc();
+      }
+    if (c == traits::eof())
+      {
+      break;
+      }
+    starts.push_back(text.size());
+    do
       {
-      if ( !self->Read(data++) )
+      text.push_back(static_cast<char>(c));
+      c = buffer->snextc();
+      }
+    while (c != traits::eof() && !isspace(c));
+    text.push_back('\0');
+    ++n;
+    }
+  if (c == traits::eof())
+    {
+    IS->setstate(ios::eofbit);
+    }
+  return n;
+}
+
+// Parse the tokens copied by vtkDataReaderReadTokens into the array.
+template <class T>
+class vtkDataReaderParseFunctor
+{
+public:
+  vtkDataReaderParseFunctor(const std::vector<char> &text,
+                            const std::vector<size_t> &starts, T *data)
+    : Text(text), Starts(starts), Data(data), Failed(0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    typename vtkDataReaderASCIIType<T>::Type value;
+    const char *text = &this->Text[0];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      size_t next = (static_cast<size_t>(i + 1) < this->Starts.size() ?
+                     this->Starts[i + 1] : this->Text.size());
+      if (!vtkDataReaderParseValue(text + this->Starts[i], text + next - 1,
+                                   value))
         {
-        vtkGenericWarningMacro(<<"Error reading ascii data. Possible mismatch of "
-          "datasize with declaration.");
-        return 0;
+        this->Failed.Local() = 1;
+        return;
         }
+      this->Data[i] = static_cast<T>(value);
+      }
+  }
+
+  bool Succeeded()
+  {
+    for (vtkSMPThreadLocal<int>::iterator it = this->Failed.begin();
+         it != this->Failed.end(); ++it)
+      {
+      if (*it)
+        {
+        return false;
+        }
+      }
+    return true;
+  }
+
+private:
+  const std::vector<char> &Text;
+  const std::vector<size_t> &Starts;
+  T *Data;
+  vtkSMPThreadLocal<int> Failed;
+};
+
+// General templated function to read data of various types.  The tokens
+// are copied from the stream by batches and parsed in parallel, without
+// the locale of the stream.
+template <class T>
+int vtkReadASCIIData(vtkDataReader *self, T *data, int numTuples, int numComp)
+{
+  const vtkIdType numValues = static_cast<vtkIdType>(numTuples) * numComp;
+  const vtkIdType batchSize = 1 << 20;
+  std::vector<char> text;
+  std::vector<size_t> starts;
+  for (vtkIdType first = 0; first < numValues; first += batchSize)
+    {
+    vtkIdType count = std::min(numValues - first, batchSize);
+    bool success = (vtkDataReaderReadTokens(self->GetIStream(), count, text,
+                                            starts) == count);
+    if (success)
+      {
+      vtkDataReaderParseFunctor<T> functor(text, starts, data + first);
+      vtkSMPTools::For(0, count, 4096, functor);
+      success = functor.Succeeded();
+      }
+    if (!success)
+      {
+      self->GetIStream()->setstate(ios::failbit);
+      vtkGenericWarningMacro(<<"Error reading ascii data. Possible mismatch of "
+        "datasize with declaration.");
+      return 0;
       }
     }
   return 1;
 }
 
+// Map a binary array instead of reading it when the file allows it.
+vtkDataArray *vtkDataReader::MapBinaryArray(const char *type, int numTuples,
+                                            int numComp)
+{
+  if (!this->MemoryMapping || this->FileType != VTK_BINARY ||
+      this->ReadFromInputString || !this->FileName ||
+      numTuples < 1 || numComp < 1)
+    {
+    return NULL;
+    }
+
+  // Only types whose size does not depend on the platform that wrote the
+  // file.
+  int dataType;
+  if (!strcmp(type, "char") || !strcmp(type, "signed_char"))
+    {
+    dataType = VTK_CHAR;
+    }
+  else if (!strcmp(type, "unsigned_char"))
+    {
+    dataType = VTK_UNSIGNED_CHAR;
+    }
+  else if (!strcmp(type, "short"))
+    {
+    dataType = VTK_SHORT;
+    }
+  else if (!strcmp(type, "unsigned_short"))
+    {
+    dataType = VTK_UNSIGNED_SHORT;
+    }
+  else if (!strcmp(type, "int"))
+    {
+    dataType = VTK_INT;
+    }
+  else if (!strcmp(type, "unsigned_int"))
+    {
+    dataType = VTK_UNSIGNED_INT;
+    }
+  else if (!strcmp(type, "float"))
+    {
+    dataType = VTK_FLOAT;
+    }
+  else if (!strcmp(type, "double"))
+    {
+    dataType = VTK_DOUBLE;
+    }
+  else
+    {
+    return NULL;
+    }
+
+  // The values start after the end of the current line.
+  std::streampos start = this->IS->tellg();
+  char line[256];
+  this->IS->getline(line, 256);
+  std::streampos position = this->IS->tellg();
+  if (start == std::streampos(-1) || position == std::streampos(-1))
+    {
+    this->IS->clear();
+    this->IS->seekg(start);
+    return NULL;
+    }
+
+  vtkDataArray *array = vtkFileMappedDataArrayAllocator::MapArray(
+    this->FileName, static_cast<vtkTypeInt64>(position), dataType, numComp,
+    numTuples, vtkFileMappedDataArrayAllocator::COPY_ON_WRITE);
+  if (!array)
+    {
+    this->IS->seekg(start);
+    return NULL;
+    }
+
+  const vtkIdType numValues = static_cast<vtkIdType>(numTuples) * numComp;
+  const int size = array->GetDataTypeSize();
+  this->IS->seekg(position + static_cast<std::streamoff>(numValues * size));
+#ifndef VTK_WORDS_BIGENDIAN
+  if (size > 1)
+    {
+    vtkByteSwap::SwapVoidRange(array->GetVoidPointer(0),
+                               static_cast<size_t>(numValues),
+                               static_cast<size_t>(size));
+    }
+#endif
+  return array;
+}
+
 // Decription:
 // Read data array. Return pointer to array object if successful read;
 // otherwise return NULL. Note: this method instantiates a reference counted
@@ -1367,7 +1710,13 @@ vtkAbstractArray *vtkDataReader::ReadArray(const char *dataType, int numTuples,
   char *type=strdup(dataType);
   type=this->LowerCase(type);
 
-  vtkAbstractArray *array;
+  vtkAbstractArray *array = this->MapBinaryArray(type, numTuples, numComp);
+  if (array)
+    {
+    free(type);
+    return array;
+    }
+
   if ( ! strncmp(type, "bit", 3) )
     {
     array = vtkBitArray::New();
@@ -2579,7 +2928,6 @@ int vtkDataReader::ReadLutData(vtkDataSetAttributes *a)
 int vtkDataReader::ReadCells(int size, int *data)
 {
   char line[256];
-  int i;
 
   if ( this->FileType == VTK_BINARY)
     {
@@ -2596,14 +2944,11 @@ int vtkDataReader::ReadCells(int size, int *data)
     }
   else // ascii
     {
-    for (i=0; i<size; i++)
+    if (!vtkReadASCIIData(this, data, size, 1))
       {
-      if (!this->Read(data+i))
-        {
-        vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: "
-                      << (this->FileName?this->FileName:"(Null FileName)"));
-        return 0;
-        }
+      vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: "
+                    << (this->FileName?this->FileName:"(Null FileName)"));
+      return 0;
       }
     }
 
@@ -3135,6 +3480,7 @@ void vtkDataReader::PrintSelf(ostream& os, vtkIndent indent)
     }
 
   os << indent << "ReadFromInputString: " << (this->ReadFromInputString ? "On\n" : "Off\n");
+  os << indent << "MemoryMapping: " << (this->MemoryMapping ? "On\n" : "Off\n");
   if ( this->InputString )
     {
     os << indent << "Input String: " << this->InputString << "\n";
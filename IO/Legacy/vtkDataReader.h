@@ -35,6 +35,7 @@
 
 class vtkAbstractArray;
 class vtkCharArray;
+class vtkDataArray;
 class vtkDataSet;
 class vtkDataSetAttributes;
 class vtkFieldData;
@@ -111,6 +112,18 @@ public:
   vtkGetMacro(ReadFromInputString,int);
   vtkBooleanMacro(ReadFromInputString,int);
 
+  // Description:
+  // When on, binary arrays of fixed size types read from a file are mapped
+  // from it instead of being copied, so that their pages are only loaded
+  // when accessed. Arrays that cannot be mapped, because they are not
+  // aligned in the file for instance, are read as usual. The mapping is
+  // copy on write: the file is never modified. On little endian machines
+  // the values of multibyte types are swapped in place, which loads them
+  // all. Off by default.
+  vtkSetMacro(MemoryMapping,int);
+  vtkGetMacro(MemoryMapping,int);
+  vtkBooleanMacro(MemoryMapping,int);
+
   // Description:
   // Get the type of file (ASCII or BINARY). Returned value only valid
   // after file has been read.
@@ -363,6 +376,7 @@ protected:
   char *ScalarLut;
 
   int ReadFromInputString;
+  int MemoryMapping;
   char *InputString;
   int InputStringLength;
   int InputStringPos;
@@ -383,6 +397,10 @@ protected:
   int ReadPedigreeIds(vtkDataSetAttributes *a, int num);
   int ReadEdgeFlags(vtkDataSetAttributes *a, int num);
 
+  // Map a binary array from the file instead of reading it, see
+  // MemoryMapping. Returns NULL if the array must be read.
+  vtkDataArray *MapBinaryArray(const char *type, int numTuples, int numComp);
+
   int ReadDataSetData(vtkDataSet *ds);
 
   // This supports getting additional information from vtk files
@@ -913,6 +913,46 @@ vtkMySQLQuery::DataValue(vtkIdType column)
     }
 }
 
+// ----------------------------------------------------------------------
+
+bool
+vtkMySQLQuery::DataInteger(vtkIdType column, vtkTypeInt64& value)
+{
+  if (!this->IsActive() || column < 0 || column >= this->GetNumberOfFields() ||
+      !this->Internals->CurrentRow[column])
+    {
+    return false;
+    }
+  switch (this->GetFieldType(column))
+    {
+    case VTK_INT:
+    case VTK_SHORT:
+    case VTK_LONG:
+    case VTK_UNSIGNED_LONG:
+      return ParseInteger(this->Internals->CurrentRow[column],
+        static_cast<size_t>(this->Internals->CurrentLengths[column]), value);
+
+    default:
+      return false;
+    }
+}
+
+// ----------------------------------------------------------------------
+
+bool
+vtkMySQLQuery::DataText(vtkIdType column, vtkStdString& value)
+{
+  if (!this->IsActive() || column < 0 || column >= this->GetNumberOfFields() ||
+      !this->Internals->CurrentRow[column] ||
+      this->GetFieldType(column) != VTK_STRING)
+    {
+    return false;
+    }
+  value.assign(this->Internals->CurrentRow[column],
+               static_cast<size_t>(this->Internals->CurrentLengths[column]));
+  return true;
+}
+
 
 // ----------------------------------------------------------------------
 
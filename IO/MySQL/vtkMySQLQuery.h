@@ -146,6 +146,12 @@ protected:
   vtkMySQLQuery();
   ~vtkMySQLQuery();
 
+  // Description:
+  // Take integers and strings straight from the text of the current row.
+  // Reals are left to DataValue(), which parses them with a stream.
+  bool DataInteger(vtkIdType c, vtkTypeInt64& value);
+  bool DataText(vtkIdType c, vtkStdString& value);
+
   vtkSetStringMacro(LastErrorText);
 
 private:
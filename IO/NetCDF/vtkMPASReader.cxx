@@ -71,6 +71,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkDataArraySelection.h"
 #include "vtkDataObject.h"
 #include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationDoubleVectorKey.h"
 #include "vtkInformationVector.h"
@@ -79,6 +80,9 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -187,6 +191,10 @@ public:
   // Set of dimensions currently used by the selected arrays:
   vtkNew<vtkStringArray> extraDims;
   vtkTimeStamp extraDimTime;
+
+  // Points and cells of the output, which do not depend on the time step.
+  // Reset whenever the file or a setting changes.
+  vtkSmartPointer<vtkUnstructuredGrid> geometry;
 };
 
 bool vtkMPASReader::Internal::isExtraDim(const string &name)
@@ -385,6 +393,7 @@ void vtkMPASReader::DestroyData()
 
   this->Internals->cellArrays.clear();
   this->Internals->pointArrays.clear();
+  this->Internals->geometry = NULL;
 
   free(this->CellMap);
   this->CellMap = NULL;
@@ -444,6 +453,7 @@ void vtkMPASReader::ReleaseNcData()
   this->PointDataArraySelection->RemoveAllArrays();
   this->CellDataArraySelection->RemoveAllArrays();
   this->UpdateDimensions(true); // Reset extra dimension list.
+  this->Internals->geometry = NULL;
 
   free(this->PointX);
   this->PointX = NULL;
@@ -573,11 +583,24 @@ int vtkMPASReader::RequestData(vtkInformation *vtkNotUsed(reqInfo),
   vtkUnstructuredGrid *output = vtkUnstructuredGrid::SafeDownCast(
       outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  this->DestroyData();
-  if (!this->ReadAndOutputGrid())
+  // Only the variables are read again when the time step changes.  Any
+  // other change runs RequestInformation, which drops the geometry.
+  this->Internals->cellArrays.clear();
+  this->Internals->pointArrays.clear();
+  if (this->Internals->geometry)
+    {
+    output->CopyStructure(this->Internals->geometry);
+    }
+  else
     {
     this->DestroyData();
-    return 0;
+    if (!this->ReadAndOutputGrid())
+      {
+      this->DestroyData();
+      return 0;
+      }
+    this->Internals->geometry = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    this->Internals->geometry->CopyStructure(output);
     }
 
   // Collect the time step requested
@@ -1563,88 +1586,220 @@ int vtkMPASReader::EliminateXWrap()
 
 
 //----------------------------------------------------------------------------
-//  Add points to vtk data structures
+//  Functors computing the points and cells of the output in parallel
 //----------------------------------------------------------------------------
 
-void vtkMPASReader::OutputPoints()
-{
-  vtkUnstructuredGrid* output = this->GetOutput();
-
-  double adjustedLayerThickness = this->IsAtmosphere
-      ? static_cast<double>(-this->LayerThickness)
-      : static_cast<double>(this->LayerThickness);
-
-
-  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-  points->Allocate(this->MaximumPoints);
-  output->SetPoints(points);
-
-  for (int j = 0; j < this->CurrentExtraPoint; j++ )
-    {
-    double x, y, z;
+namespace {
 
-    switch (this->Geometry)
+// Computes the column of MaximumNVertLevels+1 points (or the single point)
+// of each dual grid point.
+class OutputPointsFunctor
+{
+public:
+  const double *PointX;
+  const double *PointY;
+  const double *PointZ;
+  float *Points;
+  bool Spherical;
+  bool Projected;
+  bool Multilayer;
+  int NumberOfLevels;
+  double LayerThickness;
+  vtkSMPThreadLocal<int> Failed;
+
+  OutputPointsFunctor() : Failed(0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    int &failed = this->Failed.Local();
+    const int levels = this->Multilayer ? this->NumberOfLevels : 1;
+    float *point = this->Points + 3 * begin * levels;
+    for (vtkIdType j = begin; j < end; j++)
       {
-      case vtkMPASReader::Planar:
-      case vtkMPASReader::Spherical:
-        x = this->PointX[j];
-        y = this->PointY[j];
-        z = this->PointZ[j];
-        break;
-
-      case vtkMPASReader::Projected:
-        x = this->PointX[j] * 180.0 / vtkMath::Pi();
-        y = this->PointY[j] * 180.0 / vtkMath::Pi();
+      double x = this->PointX[j];
+      double y = this->PointY[j];
+      double z = this->PointZ[j];
+      if (this->Projected)
+        {
+        x = x * 180.0 / vtkMath::Pi();
+        y = y * 180.0 / vtkMath::Pi();
         z = 0.0;
-        break;
+        }
 
-      default:
-        vtkErrorMacro("Unrecognized geometry type (" << this->Geometry << ").");
-        return;
-      }
+      if (!this->Multilayer)
+        {
+        point[0] = static_cast<float>(x);
+        point[1] = static_cast<float>(y);
+        point[2] = static_cast<float>(z);
+        point += 3;
+        continue;
+        }
 
-    if (!this->ShowMultilayerView)
-      {
-      points->InsertNextPoint(x, y, z);
-      }
-    else
-      {
       double rho=0.0, rholevel=0.0, theta=0.0, phi=0.0;
       int retval = -1;
 
-      if (this->Geometry == Spherical)
+      if (this->Spherical)
         {
         if ((x != 0.0) || (y != 0.0) || (z != 0.0))
           {
           retval = CartesianToSpherical(x, y, z, &rho, &phi, &theta);
           if (retval)
             {
-            vtkWarningMacro("Can't create point for layered view.");
+            failed = 1;
             }
           }
         }
 
-      for (int levelNum = 0; levelNum < this->MaximumNVertLevels+1; levelNum++)
+      for (int levelNum = 0; levelNum < levels; levelNum++)
         {
-        if (this->Geometry == Spherical)
+        if (this->Spherical)
           {
           if (!retval && ((x != 0.0) || (y != 0.0) || (z != 0.0)))
             {
-            rholevel = rho - (adjustedLayerThickness * levelNum);
+            rholevel = rho - (this->LayerThickness * levelNum);
             retval = SphericalToCartesian(rholevel, phi, theta, &x, &y, &z);
             if (retval)
               {
-              vtkWarningMacro("Can't create point for layered view.");
+              failed = 1;
               }
             }
           }
         else
           {
-          z = -levelNum * adjustedLayerThickness;
+          z = -levelNum * this->LayerThickness;
+          }
+        point[0] = static_cast<float>(x);
+        point[1] = static_cast<float>(y);
+        point[2] = static_cast<float>(z);
+        point += 3;
+        }
+      }
+  }
+};
+
+// Fills the connectivity of the MaximumNVertLevels cells (or the single
+// cell) of each dual grid cell, each stored as its number of points
+// followed by the point ids.
+class OutputCellsFunctor
+{
+public:
+  const int *Connections;
+  const int *OrigConnections;
+  const int *CellMap;
+  const int *MaximumLevelPoint;
+  vtkIdType *Cells;
+  int NumberOfOriginalCells;
+  int PointsPerCell;
+  bool IncludeTopography;
+  bool Multilayer;
+  int MaximumNVertLevels;
+  int VerticalLevel;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const int ppc = this->PointsPerCell;
+    const int pointsPerPolygon = this->Multilayer ? 2 * ppc : ppc;
+    const int levels = this->Multilayer ? this->MaximumNVertLevels : 1;
+    vtkIdType *cell = this->Cells + (pointsPerPolygon + 1) * levels * begin;
+    for (vtkIdType j = begin; j < end; j++)
+      {
+      const int *conns = this->Connections + j * ppc;
+
+      int minLevel = 0;
+      if (this->IncludeTopography)
+        {
+        // check if it is a mirror cell, if so, get original
+        const int *connections = this->OrigConnections +
+          ((j >= this->NumberOfOriginalCells) ?
+           this->CellMap[j - this->NumberOfOriginalCells] : j) * ppc;
+
+        // Take the min of the MaximumLevelPoint of each point
+        minLevel = this->MaximumLevelPoint[connections[0]];
+        for (int k = 1; k < ppc; k++)
+          {
+          minLevel = min(minLevel, this->MaximumLevelPoint[connections[k]]);
+          }
+        }
+
+      for (int levelNum = 0; levelNum < levels; levelNum++)
+        {
+        cell[0] = pointsPerPolygon;
+        vtkIdType *polygon = cell + 1;
+        cell += pointsPerPolygon + 1;
+
+        // Cells below the topography have all their points set to zero.
+        int level = this->Multilayer ? levelNum : this->VerticalLevel;
+        if (this->IncludeTopography && ((minLevel-1) < level))
+          {
+          std::fill(polygon, polygon + pointsPerPolygon, 0);
+          }
+        else if (!this->Multilayer)
+          {
+          std::copy(conns, conns + ppc, polygon);
+          }
+        else
+          {
+          for (int k = 0; k < ppc; k++)
+            {
+            polygon[k] = (conns[k]*(this->MaximumNVertLevels+1)) + levelNum;
+            polygon[k+ppc] = polygon[k] + 1;
+            }
           }
-        points->InsertNextPoint(x, y, z);
         }
       }
+  }
+};
+
+} // end anon namespace
+
+//----------------------------------------------------------------------------
+//  Add points to vtk data structures
+//----------------------------------------------------------------------------
+
+void vtkMPASReader::OutputPoints()
+{
+  vtkUnstructuredGrid* output = this->GetOutput();
+
+  if (this->Geometry != vtkMPASReader::Planar &&
+      this->Geometry != vtkMPASReader::Spherical &&
+      this->Geometry != vtkMPASReader::Projected)
+    {
+    vtkErrorMacro("Unrecognized geometry type (" << this->Geometry << ").");
+    return;
+    }
+
+  double adjustedLayerThickness = this->IsAtmosphere
+      ? static_cast<double>(-this->LayerThickness)
+      : static_cast<double>(this->LayerThickness);
+
+  int numberOfLevels = this->MaximumNVertLevels + 1;
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(this->ShowMultilayerView ?
+    static_cast<vtkIdType>(this->CurrentExtraPoint) * numberOfLevels :
+    static_cast<vtkIdType>(this->CurrentExtraPoint));
+  output->SetPoints(points);
+
+  OutputPointsFunctor functor;
+  functor.PointX = this->PointX;
+  functor.PointY = this->PointY;
+  functor.PointZ = this->PointZ;
+  functor.Points = static_cast<float*>(points->GetVoidPointer(0));
+  functor.Spherical = (this->Geometry == vtkMPASReader::Spherical);
+  functor.Projected = (this->Geometry == vtkMPASReader::Projected);
+  functor.Multilayer = this->ShowMultilayerView;
+  functor.NumberOfLevels = numberOfLevels;
+  functor.LayerThickness = adjustedLayerThickness;
+  vtkSMPTools::For(0, this->CurrentExtraPoint, functor);
+
+  for (vtkSMPThreadLocal<int>::iterator it = functor.Failed.begin();
+       it != functor.Failed.end(); ++it)
+    {
+    if (*it)
+      {
+      vtkWarningMacro("Can't create point for layered view.");
+      break;
+      }
     }
 
   if (this->PointX)
@@ -1819,10 +1974,7 @@ void vtkMPASReader::OutputCells()
   vtkDebugMacro(<< "In OutputCells..." << endl);
   vtkUnstructuredGrid* output = GetOutput();
 
-  output->Allocate(this->MaximumCells, this->MaximumCells);
-
   int cellType = GetCellType();
-  int val;
 
   int pointsPerPolygon;
   if (this->ShowMultilayerView)
@@ -1840,106 +1992,32 @@ void vtkMPASReader::OutputCells()
      << " LayerThickness: " << LayerThickness << " ProjectLatLon: "
      << ProjectLatLon << " ShowMultilayerView: " << ShowMultilayerView);
 
-  std::vector<vtkIdType> polygon(pointsPerPolygon);
-
-  for (int j = 0; j < this->CurrentExtraCell ; j++)
+  vtkIdType numCells = this->CurrentExtraCell;
+  if (this->ShowMultilayerView)
     {
-
-    int* conns;
-    if (this->Geometry == Spherical)
-      {
-      conns = this->OrigConnections + (j * this->PointsPerCell);
-      }
-    else
-      {
-      conns = this->ModConnections + (j * this->PointsPerCell);
-      }
-
-    int minLevel= 0;
-
-    if (this->IncludeTopography)
-      {
-      int* connections;
-
-      //check if it is a mirror cell, if so, get original
-      if (j >= this->NumberOfCells + this->CellOffset)
-        {
-        int origCellNum = *(this->CellMap + (j - this->NumberOfCells - this->CellOffset));
-        connections = this->OrigConnections + (origCellNum*this->PointsPerCell);
-        }
-      else
-        {
-        connections = this->OrigConnections + (j * this->PointsPerCell);
-        }
-
-      minLevel = this->MaximumLevelPoint[connections[0]];
-
-      // Take the min of the this->MaximumLevelPoint of each point
-      for (int k = 1; k < this->PointsPerCell; k++)
-        {
-        minLevel = min(minLevel, this->MaximumLevelPoint[connections[k]]);
-        }
-      }
-
-    // singlelayer
-    if (!this->ShowMultilayerView)
-      {
-      // If that min is greater than or equal to this output level,
-      // include the cell, otherwise set all points to zero.
-
-      if (this->IncludeTopography && ((minLevel-1) < this->GetVerticalLevel()))
-        {
-        //cerr << "Setting all points to zero" << endl;
-        val = 0;
-        for (int k = 0; k < this->PointsPerCell; k++)
-          {
-          polygon[k] = val;
-          }
-        }
-      else
-        {
-        for (int k = 0; k < this->PointsPerCell; k++)
-          {
-          polygon[k] = conns[k];
-          }
-        }
-      output->InsertNextCell(cellType, pointsPerPolygon, &polygon[0]);
-
-      }
-    else
-      { // multilayer
-      // for each level, write the cell
-      for (int levelNum = 0; levelNum < this->MaximumNVertLevels; levelNum++)
-        {
-        if (this->IncludeTopography && ((minLevel-1) < levelNum))
-          {
-          // setting all points to zero
-          val = 0;
-          for (int k = 0; k < pointsPerPolygon; k++)
-            {
-            polygon[k] = val;
-            }
-          }
-        else
-          {
-          for (int k = 0; k < this->PointsPerCell; k++)
-            {
-            val = (conns[k]*(this->MaximumNVertLevels+1)) + levelNum;
-            polygon[k] = val;
-            }
-
-          for (int k = 0; k < this->PointsPerCell; k++)
-            {
-            val = (conns[k]*(this->MaximumNVertLevels+1)) + levelNum + 1;
-            polygon[k+this->PointsPerCell] = val;
-            }
-          }
-        //vtkDebugMacro
-        //("InsertingCell j: " << j << " level: " << levelNum << endl);
-        output->InsertNextCell(cellType, pointsPerPolygon, &polygon[0]);
-        }
-      }
-    }
+    numCells *= this->MaximumNVertLevels;
+    }
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(numCells * (pointsPerPolygon + 1));
+
+  OutputCellsFunctor functor;
+  functor.Connections = (this->Geometry == Spherical) ?
+    this->OrigConnections : this->ModConnections;
+  functor.OrigConnections = this->OrigConnections;
+  functor.CellMap = this->CellMap;
+  functor.MaximumLevelPoint = this->MaximumLevelPoint;
+  functor.Cells = connectivity->GetPointer(0);
+  functor.NumberOfOriginalCells = this->NumberOfCells + this->CellOffset;
+  functor.PointsPerCell = this->PointsPerCell;
+  functor.IncludeTopography = this->IncludeTopography;
+  functor.Multilayer = this->ShowMultilayerView;
+  functor.MaximumNVertLevels = this->MaximumNVertLevels;
+  functor.VerticalLevel = this->IncludeTopography ? this->GetVerticalLevel() : 0;
+  vtkSMPTools::For(0, this->CurrentExtraCell, functor);
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetCells(numCells, connectivity.GetPointer());
+  output->SetCells(cellType, cells.GetPointer());
 
   free(this->ModConnections); this->ModConnections = NULL;
   free(this->OrigConnections); this->OrigConnections = NULL;
@@ -37,6 +37,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkStructuredGrid.h"
+#include "vtkTimerLog.h"
 
 #include "vtkSmartPointer.h"
 #define VTK_CREATE(type, name) \
@@ -75,8 +76,39 @@ public:
      this->ArrayUnits[arrayName] = unit;
   }
   std::map<std::string,std::string> ArrayUnits;
+  // Seconds spent loading each variable in the last RequestData.
+  std::map<std::string,double> ReadTimes;
 };
 
+//=============================================================================
+// Give a chunked variable a chunk cache of a single chunk.  The whole
+// requested region is read with one call, which decompresses each chunk it
+// touches once, so a larger cache would only hold memory until the file is
+// closed.
+static void SetChunkCacheToOneChunk(int ncFD, int varId, nc_type type,
+                                    int numDims)
+{
+#ifdef VTK_NETCDF_USE_NETCDF4
+  int storage;
+  size_t chunkSizes[NC_MAX_VAR_DIMS];
+  size_t typeSize;
+  if (   (nc_inq_var_chunking(ncFD, varId, &storage, chunkSizes) != NC_NOERR)
+      || (storage != NC_CHUNKED)
+      || (nc_inq_type(ncFD, type, NULL, &typeSize) != NC_NOERR) )
+    {
+    return;
+    }
+  size_t chunkBytes = typeSize;
+  for (int i = 0; i < numDims; i++)
+    {
+    chunkBytes *= chunkSizes[i];
+    }
+  nc_set_var_chunk_cache(ncFD, varId, chunkBytes, 1, 1.0f);
+#else
+  (void)ncFD; (void)varId; (void)type; (void)numDims;
+#endif
+}
+
 //=============================================================================
 static int NetCDFTypeToVTKType(nc_type type)
 {
@@ -103,6 +135,9 @@ vtkNetCDFReader::vtkNetCDFReader()
 {
   this->SetNumberOfInputPorts(0);
 
+  // The netCDF library is not thread safe.
+  this->GetInformation()->Set(vtkDemandDrivenPipeline::NON_REENTRANT(), 1);
+
   this->FileName = NULL;
   this->ReplaceFillValueWithNan = 0;
 
@@ -432,6 +467,7 @@ int vtkNetCDFReader::RequestData(vtkInformation *vtkNotUsed(request),
   CALL_NETCDF(nc_open(this->FileName, NC_NOWRITE, &ncFD));
 
   // Iterate over arrays and load selected ones.
+  this->Private->ReadTimes.clear();
   int numArrays = this->VariableArraySelection->GetNumberOfArrays();
   for (int arrayIndex = 0; arrayIndex < numArrays; arrayIndex++)
     {
@@ -439,7 +475,10 @@ int vtkNetCDFReader::RequestData(vtkInformation *vtkNotUsed(request),
 
     const char *name = this->VariableArraySelection->GetArrayName(arrayIndex);
 
+    double startTime = vtkTimerLog::GetUniversalTime();
     if (!this->LoadVariable(ncFD, name, time, output)) return 0;
+    this->Private->ReadTimes[name]
+      = vtkTimerLog::GetUniversalTime() - startTime;
     }
 
   CALL_NETCDF(nc_close(ncFD));
@@ -818,8 +857,11 @@ int vtkNetCDFReader::LoadVariable(int ncFD, const char *varName, double time,
   dataArray->SetNumberOfComponents(1);
   dataArray->SetNumberOfTuples(arraySize);
 
-  // Read the array from the file.
-  CALL_NETCDF(nc_get_vars(ncFD, varId, start, count, NULL,
+  // Read the array from the file.  Without strides nc_get_vars reads one row
+  // at a time, locating (and for netCDF-4, decompressing) a chunk per row,
+  // so the whole hyperslab is read with nc_get_vara instead.
+  SetChunkCacheToOneChunk(ncFD, varId, ncType, numDims + timeIndexOffset);
+  CALL_NETCDF(nc_get_vara(ncFD, varId, start, count,
                           dataArray->GetVoidPointer(0)));
 
   // Check for a fill value.
@@ -901,3 +943,11 @@ std::string vtkNetCDFReader::QueryArrayUnits(const char* name)
 {
   return this->Private->ArrayUnits[name].c_str();
 }
+
+//-----------------------------------------------------------------------------
+double vtkNetCDFReader::GetVariableReadTime(const char* name)
+{
+  std::map<std::string,double>::const_iterator it
+    = this->Private->ReadTimes.find(name);
+  return (it != this->Private->ReadTimes.end()) ? it->second : 0.0;
+}
@@ -125,6 +125,11 @@ public:
   // Get units attached to a particular array in the netcdf file.
   std::string QueryArrayUnits(const char *ArrayName);
 
+  // Description:
+  // Get the number of seconds spent reading the given variable during the
+  // last update, or 0 if it was not read.
+  double GetVariableReadTime(const char *ArrayName);
+
 protected:
   vtkNetCDFReader();
   ~vtkNetCDFReader();
@@ -894,6 +894,63 @@ vtkODBCQuery::DataValue(vtkIdType column)
 
 // ----------------------------------------------------------------------
 
+bool
+vtkODBCQuery::DataInteger(vtkIdType column, vtkTypeInt64& value)
+{
+  if (!this->IsActive() || column < 0 || column >= this->GetNumberOfFields())
+    {
+    return false;
+    }
+  const vtkVariant &cached = this->Internals->CurrentRow->GetValue(column);
+  if (cached.IsChar() || cached.IsSignedChar() || cached.IsUnsignedChar() ||
+      cached.IsShort() || cached.IsUnsignedShort() ||
+      cached.IsInt() || cached.IsUnsignedInt() ||
+      cached.IsLong() || cached.IsLongLong())
+    {
+    value = cached.ToTypeInt64();
+    return true;
+    }
+  return false;
+}
+
+// ----------------------------------------------------------------------
+
+bool
+vtkODBCQuery::DataReal(vtkIdType column, double& value)
+{
+  if (!this->IsActive() || column < 0 || column >= this->GetNumberOfFields())
+    {
+    return false;
+    }
+  const vtkVariant &cached = this->Internals->CurrentRow->GetValue(column);
+  if (cached.IsFloat() || cached.IsDouble())
+    {
+    value = cached.ToDouble();
+    return true;
+    }
+  return false;
+}
+
+// ----------------------------------------------------------------------
+
+bool
+vtkODBCQuery::DataText(vtkIdType column, vtkStdString& value)
+{
+  if (!this->IsActive() || column < 0 || column >= this->GetNumberOfFields())
+    {
+    return false;
+    }
+  const vtkVariant &cached = this->Internals->CurrentRow->GetValue(column);
+  if (cached.IsString())
+    {
+    value = cached.ToString();
+    return true;
+    }
+  return false;
+}
+
+// ----------------------------------------------------------------------
+
 void
 vtkODBCQuery::ClearCurrentRow()
 {
@@ -141,6 +141,12 @@ protected:
   vtkODBCQuery();
   ~vtkODBCQuery();
 
+  // Description:
+  // Take integers, reals and strings from the cached row in place.
+  bool DataInteger(vtkIdType c, vtkTypeInt64& value);
+  bool DataReal(vtkIdType c, double& value);
+  bool DataText(vtkIdType c, vtkStdString& value);
+
   vtkSetStringMacro(LastErrorText);
   vtkSetStringMacro(QueryText);
   vtkGetStringMacro(QueryText);
@@ -0,0 +1,183 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPLYReaderBinary.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that the binary PLY files of both byte orders, whose vertices and
+// faces are read in bulk, give the same output as the ASCII file read
+// element by element: points, texture coordinates, point and face colors
+// and polygons.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkPLYReader.h"
+#include "vtkPLYWriter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <string>
+
+namespace
+{
+
+bool CompareArrays(vtkDataArray *expected, vtkDataArray *read,
+                   const char *what)
+{
+  if (!expected || !read ||
+      read->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+      read->GetNumberOfComponents() != expected->GetNumberOfComponents())
+    {
+    cerr << what << " has the wrong size" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < expected->GetNumberOfComponents(); ++c)
+      {
+      if (read->GetComponent(i, c) != expected->GetComponent(i, c))
+        {
+        cerr << what << " differs at tuple " << i << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool ComparePolys(vtkCellArray *expected, vtkCellArray *read)
+{
+  if (read->GetNumberOfCells() != expected->GetNumberOfCells())
+    {
+    cerr << "Wrong number of polygons" << endl;
+    return false;
+    }
+  vtkIdType npts, *pts, nreadPts, *readPts;
+  expected->InitTraversal();
+  read->InitTraversal();
+  while (expected->GetNextCell(npts, pts))
+    {
+    read->GetNextCell(nreadPts, readPts);
+    if (nreadPts != npts)
+      {
+      cerr << "Wrong polygon size" << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      if (readPts[i] != pts[i])
+        {
+        cerr << "Wrong polygon point" << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+}
+
+int TestPLYReaderBinary(int argc, char *argv[])
+{
+  char *tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/PLYReaderBinary.ply";
+  delete [] tempDir;
+
+  // A sphere with texture coordinates, point colors and face colors.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(60);
+  sphere->SetPhiResolution(40);
+  sphere->Update();
+  vtkNew<vtkPolyData> input;
+  input->ShallowCopy(sphere->GetOutput());
+  input->GetPointData()->SetNormals(0);
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkNew<vtkFloatArray> tcoords;
+  tcoords->SetNumberOfComponents(2);
+  tcoords->SetNumberOfTuples(numPts);
+  vtkNew<vtkUnsignedCharArray> pointColors;
+  pointColors->SetNumberOfComponents(3);
+  pointColors->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    double x[3];
+    input->GetPoint(i, x);
+    tcoords->SetTuple2(i, 0.5 * (x[0] + 1.0), 0.25 * (x[1] + x[2]));
+    pointColors->SetTuple3(i, i % 256, (3 * i) % 256, (7 * i) % 256);
+    }
+  input->GetPointData()->SetTCoords(tcoords.GetPointer());
+  input->GetPointData()->SetScalars(pointColors.GetPointer());
+  vtkNew<vtkUnsignedCharArray> cellColors;
+  cellColors->SetNumberOfComponents(3);
+  cellColors->SetNumberOfTuples(numCells);
+  for (vtkIdType i = 0; i < numCells; ++i)
+    {
+    cellColors->SetTuple3(i, (5 * i) % 256, 255 - i % 256, 17);
+    }
+  input->GetCellData()->SetScalars(cellColors.GetPointer());
+
+  vtkNew<vtkPLYWriter> writer;
+  writer->SetInputData(input.GetPointer());
+  writer->SetFileName(fileName.c_str());
+  vtkNew<vtkPolyData> expected;
+  for (int mode = 0; mode < 3; ++mode)
+    {
+    if (mode == 0)
+      {
+      writer->SetFileTypeToASCII();
+      }
+    else
+      {
+      writer->SetFileTypeToBinary();
+      writer->SetDataByteOrder(mode == 1 ? VTK_LITTLE_ENDIAN : VTK_BIG_ENDIAN);
+      }
+    writer->Write();
+
+    vtkNew<vtkPLYReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    vtkPolyData *output = reader->GetOutput();
+    if (mode == 0)
+      {
+      expected->DeepCopy(output);
+      if (output->GetNumberOfPoints() != numPts ||
+          output->GetNumberOfPolys() != numCells)
+        {
+        cerr << "Wrong ASCII file" << endl;
+        return EXIT_FAILURE;
+        }
+      continue;
+      }
+    if (!CompareArrays(expected->GetPoints()->GetData(),
+                       output->GetPoints()->GetData(), "Points") ||
+        !CompareArrays(expected->GetPointData()->GetTCoords(),
+                       output->GetPointData()->GetTCoords(), "TCoords") ||
+        !CompareArrays(expected->GetPointData()->GetScalars(),
+                       output->GetPointData()->GetScalars(), "Point RGB") ||
+        !CompareArrays(expected->GetCellData()->GetArray("RGB"),
+                       output->GetCellData()->GetArray("RGB"), "Cell RGB") ||
+        !ComparePolys(expected->GetPolys(), output->GetPolys()))
+      {
+      cerr << "Wrong binary file of byte order " << mode << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -14,19 +14,25 @@
 =========================================================================*/
 #include "vtkPLYReader.h"
 
+#include "vtkByteSwap.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkPointData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPLY.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstddef>
+#include <cstring>
+#include <vector>
 
 vtkStandardNewMacro(vtkPLYReader);
 
@@ -62,6 +68,371 @@ typedef struct _plyFace {
   int *verts;             // vertex index list
 } plyFace;
 
+// Binary elements whose properties have a fixed size are read in blocks
+// of records, which are decoded in parallel.  The faces are read in the
+// same way, the sizes of their lists giving the offsets of their cells.
+static const int vtkPLYReaderTypeSize[] = { 0, 1, 2, 4, 4, 1, 2, 4, 1, 4, 4, 8 };
+static const size_t vtkPLYReaderBlockSize = 1 << 24;
+
+// A scalar property read in bulk: its offset in the records (or after the
+// list of the faces), its type in the file and where its values go.
+struct vtkPLYReaderProperty
+{
+  int Offset;
+  bool AfterList;
+  int Type;
+  float *Floats;
+  unsigned char *Bytes;
+  int Stride;
+};
+
+// Return the value of a PLY type at p, converted as by get_binary_item.
+template <class T>
+static inline T vtkPLYReaderGetValue(const unsigned char *p, int type,
+                                     bool bigEndian)
+{
+  switch (type)
+    {
+    case PLY_CHAR:
+      return static_cast<T>(static_cast<signed char>(*p));
+    case PLY_UCHAR:
+    case PLY_UINT8:
+      return static_cast<T>(*p);
+    case PLY_SHORT:
+      {
+      vtkTypeInt16 value;
+      memcpy(&value, p, sizeof(value));
+      if (bigEndian) { vtkByteSwap::Swap2BE(&value); }
+      else { vtkByteSwap::Swap2LE(&value); }
+      return static_cast<T>(value);
+      }
+    case PLY_USHORT:
+      {
+      vtkTypeUInt16 value;
+      memcpy(&value, p, sizeof(value));
+      if (bigEndian) { vtkByteSwap::Swap2BE(&value); }
+      else { vtkByteSwap::Swap2LE(&value); }
+      return static_cast<T>(value);
+      }
+    case PLY_INT:
+    case PLY_INT32:
+      {
+      vtkTypeInt32 value;
+      memcpy(&value, p, sizeof(value));
+      if (bigEndian) { vtkByteSwap::Swap4BE(&value); }
+      else { vtkByteSwap::Swap4LE(&value); }
+      return static_cast<T>(value);
+      }
+    case PLY_UINT:
+      {
+      vtkTypeUInt32 value;
+      memcpy(&value, p, sizeof(value));
+      if (bigEndian) { vtkByteSwap::Swap4BE(&value); }
+      else { vtkByteSwap::Swap4LE(&value); }
+      return static_cast<T>(value);
+      }
+    case PLY_FLOAT:
+    case PLY_FLOAT32:
+      {
+      vtkTypeFloat32 value;
+      memcpy(&value, p, sizeof(value));
+      if (bigEndian) { vtkByteSwap::Swap4BE(&value); }
+      else { vtkByteSwap::Swap4LE(&value); }
+      return static_cast<T>(value);
+      }
+    case PLY_DOUBLE:
+      {
+      vtkTypeFloat64 value;
+      memcpy(&value, p, sizeof(value));
+      if (bigEndian) { vtkByteSwap::Swap8BE(&value); }
+      else { vtkByteSwap::Swap8LE(&value); }
+      return static_cast<T>(value);
+      }
+    }
+  return T(0);
+}
+
+static inline void vtkPLYReaderStore(const unsigned char *p,
+                                     const vtkPLYReaderProperty &prop,
+                                     vtkIdType index, bool bigEndian)
+{
+  if (prop.Floats)
+    {
+    prop.Floats[index * prop.Stride] =
+      vtkPLYReaderGetValue<float>(p, prop.Type, bigEndian);
+    }
+  else
+    {
+    prop.Bytes[index * prop.Stride] = static_cast<unsigned char>(
+      vtkPLYReaderGetValue<int>(p, prop.Type, bigEndian));
+    }
+}
+
+// Compute the offsets of the properties of an element, from the start of
+// its records or, after its list, from the end of the list, and the sizes
+// before and after the list.  Return the index of the list property, -1
+// if there is none, or -2 if there are several.
+static int vtkPLYReaderLayout(PlyElement *elem, std::vector<int> &offsets,
+                              int sizes[2])
+{
+  int list = -1;
+  sizes[0] = sizes[1] = 0;
+  offsets.resize(elem->nprops);
+  for (int i = 0; i < elem->nprops; ++i)
+    {
+    PlyProperty *prop = elem->props[i];
+    if (prop->is_list)
+      {
+      if (list != -1)
+        {
+        return -2;
+        }
+      list = i;
+      offsets[i] = sizes[0];
+      continue;
+      }
+    int &size = sizes[list == -1 ? 0 : 1];
+    offsets[i] = size;
+    size += vtkPLYReaderTypeSize[prop->external_type];
+    }
+  return list;
+}
+
+// Add the scalar property of the element with the given name to props.
+static void vtkPLYReaderAddProperty(PlyElement *elem, const char *name,
+                                    const std::vector<int> &offsets,
+                                    int list, float *floats,
+                                    unsigned char *bytes, int stride,
+                                    std::vector<vtkPLYReaderProperty> &props)
+{
+  int index;
+  PlyProperty *prop = vtkPLY::find_property(elem, name, &index);
+  if (!prop || prop->is_list)
+    {
+    return;
+    }
+  vtkPLYReaderProperty bulk;
+  bulk.Offset = offsets[index];
+  bulk.AfterList = (list >= 0 && index > list);
+  bulk.Type = prop->external_type;
+  bulk.Floats = floats;
+  bulk.Bytes = bytes;
+  bulk.Stride = stride;
+  props.push_back(bulk);
+}
+
+// Decode a block of vertex records.
+class vtkPLYReaderVertexFunctor
+{
+public:
+  vtkPLYReaderVertexFunctor(const unsigned char *records, int recordSize,
+                            vtkIdType first,
+                            const std::vector<vtkPLYReaderProperty> &props,
+                            bool bigEndian)
+    : Records(records), RecordSize(recordSize), First(first), Props(props),
+      BigEndian(bigEndian) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const unsigned char *record = this->Records + i * this->RecordSize;
+      for (size_t p = 0; p < this->Props.size(); ++p)
+        {
+        vtkPLYReaderStore(record + this->Props[p].Offset, this->Props[p],
+                          this->First + i, this->BigEndian);
+        }
+      }
+  }
+
+private:
+  const unsigned char *Records;
+  int RecordSize;
+  vtkIdType First;
+  const std::vector<vtkPLYReaderProperty> &Props;
+  bool BigEndian;
+};
+
+// Decode a block of face records, whose starts in the block were found
+// while computing the offsets of their cells.
+class vtkPLYReaderFaceFunctor
+{
+public:
+  vtkPLYReaderFaceFunctor(const unsigned char *block,
+                          const std::vector<size_t> &starts,
+                          vtkIdType first, const vtkIdType *offsets,
+                          vtkIdType *ids, int listOffset, int countSize,
+                          int indexType,
+                          const std::vector<vtkPLYReaderProperty> &props,
+                          bool bigEndian)
+    : Block(block), Starts(starts), First(first), Offsets(offsets), Ids(ids),
+      ListOffset(listOffset), CountSize(countSize), IndexType(indexType),
+      Props(props), BigEndian(bigEndian) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const int indexSize = vtkPLYReaderTypeSize[this->IndexType];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const unsigned char *record = this->Block + this->Starts[i];
+      const unsigned char *list = record + this->ListOffset + this->CountSize;
+      vtkIdType face = this->First + i;
+      vtkIdType count = this->Offsets[face + 1] - this->Offsets[face];
+      vtkIdType *ids =
+        this->Ids + (this->Offsets[face] - this->Offsets[this->First]);
+      for (vtkIdType j = 0; j < count; ++j)
+        {
+        ids[j] = vtkPLYReaderGetValue<int>(list + j * indexSize,
+                                           this->IndexType, this->BigEndian);
+        }
+      const unsigned char *afterList = list + count * indexSize;
+      for (size_t p = 0; p < this->Props.size(); ++p)
+        {
+        const vtkPLYReaderProperty &prop = this->Props[p];
+        vtkPLYReaderStore((prop.AfterList ? afterList : record) + prop.Offset,
+                          prop, face, this->BigEndian);
+        }
+      }
+  }
+
+private:
+  const unsigned char *Block;
+  const std::vector<size_t> &Starts;
+  vtkIdType First;
+  const vtkIdType *Offsets;
+  vtkIdType *Ids;
+  int ListOffset;
+  int CountSize;
+  int IndexType;
+  const std::vector<vtkPLYReaderProperty> &Props;
+  bool BigEndian;
+};
+
+// Read the records of a binary element without list in blocks.
+static bool vtkPLYReaderReadVertices(PlyFile *ply, int recordSize,
+                                     vtkIdType numVertices,
+                                     const std::vector<vtkPLYReaderProperty> &props)
+{
+  const bool bigEndian = (ply->file_type == PLY_BINARY_BE);
+  const vtkIdType blockRecords = std::max(
+    static_cast<vtkIdType>(1),
+    static_cast<vtkIdType>(vtkPLYReaderBlockSize / recordSize));
+  std::vector<unsigned char> block(blockRecords * recordSize);
+  for (vtkIdType first = 0; first < numVertices; first += blockRecords)
+    {
+    vtkIdType n = std::min(blockRecords, numVertices - first);
+    if (fread(&block[0], recordSize, n, ply->fp) != static_cast<size_t>(n))
+      {
+      return false;
+      }
+    vtkPLYReaderVertexFunctor functor(&block[0], recordSize, first, props,
+                                      bigEndian);
+    vtkSMPTools::For(0, n, functor);
+    }
+  return true;
+}
+
+// Read the faces of a binary element whose only list is the list of
+// vertex indices into polys.
+static bool vtkPLYReaderReadFaces(PlyFile *ply, PlyElement *elem, int list,
+                                  const int sizes[2], vtkIdType numFaces,
+                                  const std::vector<vtkPLYReaderProperty> &props,
+                                  vtkCellArray *polys)
+{
+  const bool bigEndian = (ply->file_type == PLY_BINARY_BE);
+  const int countType = elem->props[list]->count_external;
+  const int indexType = elem->props[list]->external_type;
+  const int countSize = vtkPLYReaderTypeSize[countType];
+  const size_t fixedSize = sizes[0] + countSize + sizes[1];
+  const size_t indexSize = vtkPLYReaderTypeSize[indexType];
+
+  vtkSmartPointer<vtkIdTypeArray> offsets =
+    vtkSmartPointer<vtkIdTypeArray>::New();
+  offsets->SetNumberOfTuples(numFaces + 1);
+  vtkIdType *offs = offsets->GetPointer(0);
+  offs[0] = 0;
+  vtkSmartPointer<vtkIdTypeArray> connectivity =
+    vtkSmartPointer<vtkIdTypeArray>::New();
+
+  std::vector<unsigned char> block(vtkPLYReaderBlockSize);
+  std::vector<size_t> starts;
+  size_t filled = 0;
+  vtkIdType face = 0;
+  while (face < numFaces)
+    {
+    size_t numRead = fread(&block[filled], 1, block.size() - filled, ply->fp);
+    filled += numRead;
+
+    // Find the complete records of the block, and the offsets of their
+    // cells from the sizes of their lists.
+    starts.clear();
+    size_t position = 0;
+    vtkIdType numIds = offs[face];
+    while (face + static_cast<vtkIdType>(starts.size()) < numFaces &&
+           position + fixedSize <= filled)
+      {
+      int count = vtkPLYReaderGetValue<int>(&block[position + sizes[0]],
+                                            countType, bigEndian);
+      size_t size = fixedSize + static_cast<size_t>(count) * indexSize;
+      if (count < 0)
+        {
+        return false;
+        }
+      if (position + size > filled)
+        {
+        break;
+        }
+      starts.push_back(position);
+      numIds += count;
+      offs[face + starts.size()] = numIds;
+      position += size;
+      }
+    if (starts.empty())
+      {
+      if (numRead == 0)
+        {
+        return false;
+        }
+      if (filled == block.size())
+        {
+        block.resize(2 * block.size());
+        }
+      continue;
+      }
+
+    vtkIdType n = static_cast<vtkIdType>(starts.size());
+    vtkIdType *ids = connectivity->WritePointer(offs[face],
+                                                numIds - offs[face]);
+    vtkPLYReaderFaceFunctor functor(&block[0], starts, face, offs, ids,
+                                    sizes[0], countSize, indexType, props,
+                                    bigEndian);
+    vtkSMPTools::For(0, n, functor);
+    face += n;
+
+    // Keep the start of the next record.
+    std::copy(block.begin() + position, block.begin() + filled, block.begin());
+    filled -= position;
+    }
+
+  // Leave the file at the end of the faces.
+  if (filled > 0 && fseek(ply->fp, -static_cast<long>(filled), SEEK_CUR) != 0)
+    {
+    return false;
+    }
+  return polys->SetData(offsets, connectivity);
+}
+
+// Free the element names and close the file after an error.
+static void vtkPLYReaderClose(PlyFile *ply, char **elist, int nelems)
+{
+  for (int i = 0; i < nelems; i++)
+    {
+    free(elist[i]);
+    }
+  free(elist);
+  vtkPLY::ply_close(ply);
+}
+
 int vtkPLYReader::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **vtkNotUsed(inputVector),
@@ -227,7 +598,12 @@ int vtkPLYReader::RequestData(
     {
     //get the description of the first element */
     elemName = elist[i];
-    vtkPLY::ply_get_element_description (ply, elemName, &numElems, &nprops);
+    elem = vtkPLY::ply_get_element_description (ply, elemName, &numElems,
+                                                &nprops);
+    std::vector<int> offsets;
+    int sizes[2];
+    int list = (elem && fileType != PLY_ASCII ?
+                vtkPLYReaderLayout(elem, offsets, sizes) : -2);
 
     // if we're on vertex elements, read them in
     if ( elemName && !strcmp ("vertex", elemName) )
@@ -238,6 +614,55 @@ int vtkPLYReader::RequestData(
       pts->SetDataTypeToFloat();
       pts->SetNumberOfPoints(numPts);
 
+      if ( list == -1 )
+        {
+        // Read the binary vertices in bulk
+        std::vector<vtkPLYReaderProperty> props;
+        float *x = static_cast<float *>(pts->GetVoidPointer(0));
+        vtkPLYReaderAddProperty(elem, "x", offsets, list, x, 0, 3, props);
+        vtkPLYReaderAddProperty(elem, "y", offsets, list, x + 1, 0, 3, props);
+        vtkPLYReaderAddProperty(elem, "z", offsets, list, x + 2, 0, 3, props);
+        if ( TexCoordsPointsAvailable )
+          {
+          TexCoordsPoints->SetNumberOfTuples(numPts);
+          float *tex = TexCoordsPoints->GetPointer(0);
+          vtkPLYReaderAddProperty(elem, vertProps[3].name, offsets, list,
+                                  tex, 0, 2, props);
+          vtkPLYReaderAddProperty(elem, vertProps[4].name, offsets, list,
+                                  tex + 1, 0, 2, props);
+          }
+        if ( NormalPointsAvailable )
+          {
+          Normals->SetNumberOfTuples(numPts);
+          float *n = Normals->GetPointer(0);
+          vtkPLYReaderAddProperty(elem, "nx", offsets, list, n, 0, 3, props);
+          vtkPLYReaderAddProperty(elem, "ny", offsets, list, n + 1, 0, 3, props);
+          vtkPLYReaderAddProperty(elem, "nz", offsets, list, n + 2, 0, 3, props);
+          }
+        if ( RGBPointsAvailable )
+          {
+          RGBPoints->SetNumberOfTuples(numPts);
+          unsigned char *rgb = RGBPoints->GetPointer(0);
+          vtkPLYReaderAddProperty(elem, "red", offsets, list, 0, rgb, 3, props);
+          vtkPLYReaderAddProperty(elem, "green", offsets, list, 0, rgb + 1, 3,
+                                  props);
+          vtkPLYReaderAddProperty(elem, "blue", offsets, list, 0, rgb + 2, 3,
+                                  props);
+          }
+        if ( !vtkPLYReaderReadVertices(ply, sizes[0], numPts, props) )
+          {
+          vtkErrorMacro(<<"Could not read the vertices");
+          pts->Delete();
+          vtkPLYReaderClose(ply, elist, nelems);
+          return 0;
+          }
+        output->SetPoints(pts);
+        pts->Delete();
+        free(elist[i]);
+        elist[i] = NULL;
+        continue;
+        }
+
       // Setup to read the PLY elements
       vtkPLY::ply_get_property (ply, elemName, &vertProps[0]);
       vtkPLY::ply_get_property (ply, elemName, &vertProps[1]);
@@ -293,6 +718,42 @@ int vtkPLYReader::RequestData(
       // Create a polygonal array
       numPolys = numElems;
       vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
+
+      if ( list >= 0 &&
+           !strcmp(elem->props[list]->name, "vertex_indices") )
+        {
+        // Read the binary faces in bulk
+        std::vector<vtkPLYReaderProperty> props;
+        if ( intensityAvailable )
+          {
+          intensity->SetNumberOfTuples(numPolys);
+          vtkPLYReaderAddProperty(elem, "intensity", offsets, list, 0,
+                                  intensity->GetPointer(0), 1, props);
+          }
+        if ( RGBCellsAvailable )
+          {
+          RGBCells->SetNumberOfComponents(3);
+          RGBCells->SetNumberOfTuples(numPolys);
+          unsigned char *rgb = RGBCells->GetPointer(0);
+          vtkPLYReaderAddProperty(elem, "red", offsets, list, 0, rgb, 3, props);
+          vtkPLYReaderAddProperty(elem, "green", offsets, list, 0, rgb + 1, 3,
+                                  props);
+          vtkPLYReaderAddProperty(elem, "blue", offsets, list, 0, rgb + 2, 3,
+                                  props);
+          }
+        if ( !vtkPLYReaderReadFaces(ply, elem, list, sizes, numPolys, props,
+                                    polys) )
+          {
+          vtkErrorMacro(<<"Could not read the faces");
+          vtkPLYReaderClose(ply, elist, nelems);
+          return 0;
+          }
+        output->SetPolys(polys);
+        free(elist[i]);
+        elist[i] = NULL;
+        continue;
+        }
+
       polys->Allocate(polys->EstimateSize(numPolys,3),numPolys/2);
       plyFace face;
       vtkIdType vtkVerts[256];
@@ -302,8 +763,7 @@ int vtkPLYReader::RequestData(
       if ( intensityAvailable )
         {
         vtkPLY::ply_get_property (ply, elemName, &faceProps[1]);
-        RGBCells->SetNumberOfComponents(1);
-        RGBCells->SetNumberOfTuples(numPolys);
+        intensity->SetNumberOfTuples(numPolys);
         }
       if ( RGBCellsAvailable )
         {
@@ -30,11 +30,40 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 
+#include <vector>
+
+namespace
+{
+
+// updates a range of sub-readers for vtkSMPTools
+class vtkPOpenFOAMReaderUpdater
+{
+public:
+  vtkPOpenFOAMReaderUpdater(const std::vector<vtkOpenFOAMReader *>& readers)
+    : Readers(readers)
+    {
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Readers[i]->Update();
+      }
+    }
+
+private:
+  const std::vector<vtkOpenFOAMReader *>& Readers;
+};
+
+}
+
 vtkStandardNewMacro(vtkPOpenFOAMReader);
 vtkCxxSetObjectMacro(vtkPOpenFOAMReader, Controller, vtkMultiProcessController);
 
@@ -55,6 +84,7 @@ vtkPOpenFOAMReader::vtkPOpenFOAMReader()
     }
   this->CaseType = RECONSTRUCTED_CASE;
   this->MTimeOld = 0;
+  this->ReadProcessorsInParallel = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -72,6 +102,8 @@ void vtkPOpenFOAMReader::PrintSelf(ostream &os, vtkIndent indent)
   os << indent << "Number of Processes: " << this->NumProcesses << endl;
   os << indent << "Process Id: " << this->ProcessId << endl;
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "ReadProcessorsInParallel: "
+     << this->ReadProcessorsInParallel << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -331,6 +363,7 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
     // append->AppendFieldDataOn();
 
     vtkOpenFOAMReader *reader;
+    std::vector<vtkOpenFOAMReader *> readers;
     this->Superclass::CurrentReaderIndex = 0;
     this->Superclass::Readers->InitTraversal();
     while ((reader
@@ -348,6 +381,7 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
       if (reader->MakeMetaDataAtTimeStep(false))
         {
         append->AddInputConnection(reader->GetOutputPort());
+        readers.push_back(reader);
         }
       }
 
@@ -362,6 +396,17 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
       {
       // reader->RequestInformation() and RequestData() are called
       // for all reader instances without setting UPDATE_TIME_STEPS
+      if (this->ReadProcessorsInParallel && readers.size() > 1)
+        {
+        // the sub-readers are then up to date when append updates them.
+        // they share the progress of "this", which is not reported from
+        // the threads
+        this->Superclass::ProgressSuspended = true;
+        vtkPOpenFOAMReaderUpdater updater(readers);
+        vtkSMPTools::For(0, static_cast<vtkIdType>(readers.size()), 1,
+                         updater);
+        this->Superclass::ProgressSuspended = false;
+        }
       append->Update();
       output->ShallowCopy(append->GetOutput());
       }
@@ -53,6 +53,14 @@ public:
   virtual void SetController(vtkMultiProcessController *);
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
 
+  // Description:
+  // Set and get whether the processor subdirectories assigned to this
+  // process are read concurrently by threads. No progress is reported
+  // while they are read. Off by default.
+  vtkSetMacro(ReadProcessorsInParallel, int);
+  vtkGetMacro(ReadProcessorsInParallel, int);
+  vtkBooleanMacro(ReadProcessorsInParallel, int);
+
 protected:
   vtkPOpenFOAMReader();
   ~vtkPOpenFOAMReader();
@@ -68,6 +76,7 @@ private:
   unsigned long MTimeOld;
   int NumProcesses;
   int ProcessId;
+  int ReadProcessorsInParallel;
 
   vtkPOpenFOAMReader(const vtkPOpenFOAMReader &); // Not implemented.
   void operator=(const vtkPOpenFOAMReader &); // Not implemented.
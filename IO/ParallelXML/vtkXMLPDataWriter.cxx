@@ -24,10 +24,94 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <fstream>
 #include <sstream>
+#include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 vtkCxxSetObjectMacro(vtkXMLPDataWriter, Controller, vtkMultiProcessController);
+
+//----------------------------------------------------------------------------
+// The shared file is made of the prologue and the elements of the data
+// set up to the first Piece, the Piece elements of all processes, the
+// middle up to the start of the appended data, the appended data of all
+// processes and the trailer.  The prologue, middle and trailer are those
+// of the first piece written by the first process that has pieces.
+class vtkXMLPDataWriterSharedFile
+{
+public:
+  vtkXMLPDataWriterSharedFile() : Failed(0), HasFrame(0) {}
+  void Clear()
+    {
+    this->Failed = 0;
+    this->HasFrame = 0;
+    this->Prologue.clear();
+    this->Pieces.clear();
+    this->Middle.clear();
+    this->Data.clear();
+    this->Trailer.clear();
+    }
+  int Failed;
+  int HasFrame;
+  std::string Prologue;
+  std::string Pieces;
+  std::string Middle;
+  std::string Data;
+  std::string Trailer;
+};
+
+//----------------------------------------------------------------------------
+// Add shift to the offset attribute of the DataArray and Array elements
+// of xml.  The writer reserved space after each offset, so that the
+// larger value overwrites the spaces that follow it.
+static bool vtkXMLPDataWriterShiftOffsets(std::string& xml, vtkTypeInt64 shift)
+{
+  if (shift == 0)
+    {
+    return true;
+    }
+  const std::string attribute = " offset=\"";
+  size_t pos = 0;
+  while ((pos = xml.find('<', pos)) != std::string::npos)
+    {
+    size_t end = xml.find('>', pos);
+    if (end == std::string::npos)
+      {
+      break;
+      }
+    if (xml.compare(pos, 11, "<DataArray ") == 0 ||
+        xml.compare(pos, 7, "<Array ") == 0)
+      {
+      size_t first = xml.find(attribute, pos);
+      if (first != std::string::npos && first < end)
+        {
+        first += attribute.size();
+        size_t last = xml.find('"', first);
+        size_t spaceEnd = last + 1;
+        while (spaceEnd < end && xml[spaceEnd] == ' ')
+          {
+          ++spaceEnd;
+          }
+        vtkTypeInt64 offset = 0;
+        std::istringstream in(xml.substr(first, last - first));
+        in >> offset;
+        std::ostringstream out;
+        out << offset + shift << '"';
+        std::string value = out.str();
+        if (in.fail() || value.size() > spaceEnd - first)
+          {
+          return false;
+          }
+        value.resize(spaceEnd - first, ' ');
+        xml.replace(first, value.size(), value);
+        }
+      }
+    pos = end;
+    }
+  return true;
+}
 //----------------------------------------------------------------------------
 vtkXMLPDataWriter::vtkXMLPDataWriter()
 {
@@ -36,6 +120,7 @@ vtkXMLPDataWriter::vtkXMLPDataWriter()
   this->NumberOfPieces = 1;
   this->GhostLevel = 0;
   this->WriteSummaryFile = 1;
+  this->WriteSharedFile = 0;
 
   this->PathName = 0;
   this->FileNameBase = 0;
@@ -54,6 +139,7 @@ vtkXMLPDataWriter::vtkXMLPDataWriter()
   this->ContinuingExecution = false;
   this->CurrentPiece = -1;
   this->PieceWrittenFlags = NULL;
+  this->SharedFile = new vtkXMLPDataWriterSharedFile;
 }
 
 //----------------------------------------------------------------------------
@@ -64,6 +150,7 @@ vtkXMLPDataWriter::~vtkXMLPDataWriter()
   delete [] this->FileNameExtension;
   delete [] this->PieceFileNameExtension;
   delete [] this->PieceWrittenFlags;
+  delete this->SharedFile;
   this->SetController(0);
   this->ProgressObserver->Delete();
 }
@@ -77,6 +164,7 @@ void vtkXMLPDataWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EndPiece: " << this->EndPiece << "\n";
   os << indent << "GhostLevel: " << this->GhostLevel << "\n";
   os << indent << "WriteSummaryFile: " << this->WriteSummaryFile << "\n";
+  os << indent << "WriteSharedFile: " << this->WriteSharedFile << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -165,6 +253,7 @@ int vtkXMLPDataWriter::WriteInternal()
 
     // Prepare the extension.
     this->SetupPieceFileNameExtension();
+    this->SharedFile->Clear();
     }
 
   // Write the current piece.
@@ -181,15 +270,31 @@ int vtkXMLPDataWriter::WriteInternal()
     {
     if (!this->WritePiece(this->CurrentPiece))
       {
-      vtkErrorMacro("Ran out of disk space; deleting file(s) already written");
-      this->DeleteFiles();
-      return 0;
+      if (this->WriteSharedFile)
+        {
+        // The other processes still wait for this one in WriteSharedPieces.
+        this->SharedFile->Failed = 1;
+        }
+      else
+        {
+        vtkErrorMacro("Ran out of disk space; deleting file(s) already written");
+        this->DeleteFiles();
+        return 0;
+        }
       }
     this->PieceWrittenFlags[this->CurrentPiece] = static_cast<unsigned char>(0x1);
     }
 
+  // Write the pieces of all processes to the shared file.
+  if (the_end && this->WriteSharedFile)
+    {
+    if (!this->WriteSharedPieces())
+      {
+      return 0;
+      }
+    }
   // Write the summary file if requested.
-  if (the_end && this->WriteSummaryFile)
+  else if (the_end && this->WriteSummaryFile)
     {
     // Decide whether to write the summary file.
     bool writeSummaryLocally = (this->Controller == NULL || this->Controller->GetLocalProcessId() == 0);
@@ -381,9 +486,16 @@ int vtkXMLPDataWriter::WritePiece(int index)
   vtkXMLWriter* pWriter = this->CreatePieceWriter(index);
   pWriter->AddObserver(vtkCommand::ProgressEvent, this->ProgressObserver);
 
-  char* fileName = this->CreatePieceFileName(index, this->PathName);
-  pWriter->SetFileName(fileName);
-  delete [] fileName;
+  if (this->WriteSharedFile)
+    {
+    pWriter->WriteToOutputStringOn();
+    }
+  else
+    {
+    char* fileName = this->CreatePieceFileName(index, this->PathName);
+    pWriter->SetFileName(fileName);
+    delete [] fileName;
+    }
 
   // Copy the writer settings.
   pWriter->SetDebug(this->Debug);
@@ -397,6 +509,10 @@ int vtkXMLPDataWriter::WritePiece(int index)
   // Write the piece.
   int result = pWriter->Write();
   this->SetErrorCode(pWriter->GetErrorCode());
+  if (result && this->WriteSharedFile)
+    {
+    result = this->AddSharedPiece(pWriter->GetOutputString());
+    }
 
   // Cleanup.
   pWriter->RemoveObserver(this->ProgressObserver);
@@ -405,6 +521,170 @@ int vtkXMLPDataWriter::WritePiece(int index)
   return result;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLPDataWriter::AddSharedPiece(const std::string& piece)
+{
+  // The Piece elements end before the appended data, if any.
+  const std::string dataTrailer = "\n  </AppendedData>\n</VTKFile>\n";
+  size_t headEnd = piece.find("<AppendedData");
+  size_t pieceStart = piece.find("<Piece");
+  size_t pieceEnd = piece.rfind("</Piece>", headEnd);
+  size_t dataStart = piece.size();
+  size_t dataEnd = piece.size();
+  if (headEnd != std::string::npos)
+    {
+    dataStart = piece.find('_', headEnd) + 1;
+    dataEnd = piece.size() - dataTrailer.size();
+    }
+  if (pieceStart == std::string::npos || pieceEnd == std::string::npos ||
+      pieceEnd < pieceStart || dataStart == 0 || dataEnd < dataStart ||
+      (headEnd != std::string::npos &&
+       piece.compare(dataEnd, dataTrailer.size(), dataTrailer) != 0))
+    {
+    vtkErrorMacro("Cannot find the pieces in the file written for piece "
+                  << this->CurrentPiece << ".");
+    return 0;
+    }
+  pieceStart = piece.rfind('\n', pieceStart) + 1;
+  pieceEnd = piece.find('\n', pieceEnd) + 1;
+
+  // The appended data of the piece follows that of the earlier pieces.
+  std::string pieces = piece.substr(pieceStart, pieceEnd - pieceStart);
+  if (!vtkXMLPDataWriterShiftOffsets(
+        pieces, static_cast<vtkTypeInt64>(this->SharedFile->Data.size())))
+    {
+    vtkErrorMacro("No space to move the appended data offsets of piece "
+                  << this->CurrentPiece << ".");
+    return 0;
+    }
+  if (!this->SharedFile->HasFrame)
+    {
+    this->SharedFile->HasFrame = 1;
+    this->SharedFile->Prologue = piece.substr(0, pieceStart);
+    this->SharedFile->Middle = piece.substr(pieceEnd, dataStart - pieceEnd);
+    this->SharedFile->Trailer = piece.substr(dataEnd);
+    }
+  this->SharedFile->Pieces += pieces;
+  this->SharedFile->Data.append(piece, dataStart, dataEnd - dataStart);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLPDataWriter::WriteSharedPieces()
+{
+  // Gather the sizes of the parts of each process.  The positions of its
+  // Piece elements and appended data are the sums over the processes
+  // before it.
+  vtkXMLPDataWriterSharedFile* parts = this->SharedFile;
+  int numProcs = 1;
+  int myId = 0;
+  if (this->Controller)
+    {
+    numProcs = this->Controller->GetNumberOfProcesses();
+    myId = this->Controller->GetLocalProcessId();
+    }
+  vtkTypeInt64 sizes[5] = { parts->HasFrame,
+                            static_cast<vtkTypeInt64>(parts->Prologue.size()),
+                            static_cast<vtkTypeInt64>(parts->Pieces.size()),
+                            static_cast<vtkTypeInt64>(parts->Middle.size()),
+                            static_cast<vtkTypeInt64>(parts->Data.size()) };
+  std::vector<vtkTypeInt64> allSizes(5 * numProcs);
+  if (numProcs > 1)
+    {
+    this->Controller->AllGather(sizes, &allSizes[0], 5);
+    }
+  else
+    {
+    std::copy(sizes, sizes + 5, allSizes.begin());
+    }
+
+  int frameId = -1;
+  vtkTypeInt64 piecesPosition = 0;
+  vtkTypeInt64 piecesSize = 0;
+  vtkTypeInt64 dataShift = 0;
+  vtkTypeInt64 dataSize = 0;
+  for (int i = 0; i < numProcs; ++i)
+    {
+    const vtkTypeInt64* procSizes = &allSizes[5 * i];
+    if (frameId < 0 && procSizes[0])
+      {
+      frameId = i;
+      }
+    if (i == myId)
+      {
+      piecesPosition = piecesSize;
+      dataShift = dataSize;
+      }
+    piecesSize += procSizes[2];
+    dataSize += procSizes[4];
+    }
+  if (frameId < 0)
+    {
+    vtkErrorMacro("No process has a piece to write to " << this->FileName);
+    return 0;
+    }
+  vtkTypeInt64 prologueSize = allSizes[5 * frameId + 1];
+  vtkTypeInt64 middlePosition = prologueSize + piecesSize;
+  vtkTypeInt64 dataPosition = middlePosition + allSizes[5 * frameId + 3];
+  piecesPosition += prologueSize;
+
+  int success = !parts->Failed;
+  if (!vtkXMLPDataWriterShiftOffsets(parts->Pieces, dataShift))
+    {
+    vtkErrorMacro("No space to move the appended data offsets.");
+    success = 0;
+    }
+
+  // The first process creates the file, then each process writes its
+  // parts at their positions.
+  if (myId == 0)
+    {
+    std::ofstream file(this->FileName, ios::out | ios::binary | ios::trunc);
+    success = success && file.good();
+    }
+  if (numProcs > 1)
+    {
+    this->Controller->Barrier();
+    }
+  if (parts->HasFrame)
+    {
+    std::fstream file(this->FileName, ios::in | ios::out | ios::binary);
+    if (myId == frameId)
+      {
+      file.write(parts->Prologue.data(), parts->Prologue.size());
+      file.seekp(middlePosition);
+      file.write(parts->Middle.data(), parts->Middle.size());
+      file.seekp(dataPosition + dataSize);
+      file.write(parts->Trailer.data(), parts->Trailer.size());
+      }
+    file.seekp(piecesPosition);
+    file.write(parts->Pieces.data(), parts->Pieces.size());
+    file.seekp(dataPosition + dataShift);
+    file.write(parts->Data.data(), parts->Data.size());
+    file.close();
+    success = success && !file.fail();
+    }
+  parts->Clear();
+
+  int allSuccess = success;
+  if (numProcs > 1)
+    {
+    this->Controller->AllReduce(&success, &allSuccess, 1,
+                                vtkCommunicator::MIN_OP);
+    }
+  if (!allSuccess)
+    {
+    vtkErrorMacro("Ran out of disk space; deleting file " << this->FileName);
+    this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+    if (myId == 0)
+      {
+      this->DeleteAFile(this->FileName);
+      }
+    return 0;
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLPDataWriter::ProgressCallbackFunction(vtkObject* caller,
                                                  unsigned long,
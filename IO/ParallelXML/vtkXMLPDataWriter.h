@@ -18,6 +18,8 @@
 // writers.  It provides functionality needed for writing parallel
 // formats, such as the selection of which writer writes the summary
 // file and what range of pieces are assigned to each serial writer.
+// With WriteSharedFile on, the pieces of all processes are instead
+// written together into one file of the serial format.
 
 #ifndef vtkXMLPDataWriter_h
 #define vtkXMLPDataWriter_h
@@ -27,6 +29,7 @@
 
 class vtkCallbackCommand;
 class vtkMultiProcessController;
+class vtkXMLPDataWriterSharedFile;
 
 class VTKIOPARALLELXML_EXPORT vtkXMLPDataWriter : public vtkXMLWriter
 {
@@ -60,6 +63,22 @@ public:
   vtkGetMacro(WriteSummaryFile, int);
   vtkBooleanMacro(WriteSummaryFile, int);
 
+  // Description:
+  // Get/Set whether the pieces of all processes are written into the
+  // single file FileName, in the serial format of the data set (.vtu,
+  // .vtp, .vti...) with one Piece element per piece, instead of one file
+  // per piece and a summary file.  Each process writes its pieces to
+  // memory, the positions of the pieces and of their appended data in
+  // the file are computed from the sizes of the pieces of the processes
+  // before it, and then every process writes its own part of the file.
+  // The serial XML readers read the file and distribute its pieces among
+  // the pieces requested from them.  This avoids creating a file per
+  // process on file systems where creating files is expensive.  It is
+  // off by default, and time steps are not supported in this mode.
+  vtkSetMacro(WriteSharedFile, int);
+  vtkGetMacro(WriteSharedFile, int);
+  vtkBooleanMacro(WriteSharedFile, int);
+
   // Description:
   // Controller used to communicate data type of blocks.
   // By default, the global controller is used. If you want another
@@ -113,6 +132,7 @@ protected:
   int NumberOfPieces;
   int GhostLevel;
   int WriteSummaryFile;
+  int WriteSharedFile;
 
   char* PathName;
   char* FileNameBase;
@@ -136,6 +156,12 @@ private:
   // Method used to delete all written files.
   void DeleteFiles();
 
+  // Description:
+  // Add the file written for a piece to memory in WriteSharedFile mode,
+  // then write the pieces of all processes to the shared file.
+  int AddSharedPiece(const std::string& piece);
+  int WriteSharedPieces();
+
   // Description:
   // Initializes PieceFileNameExtension.
   void SetupPieceFileNameExtension();
@@ -149,6 +175,9 @@ private:
 
   // Flags used to keep track of which pieces were written out.
   unsigned char *PieceWrittenFlags;
+
+  // The parts of the shared file written by this process.
+  vtkXMLPDataWriterSharedFile* SharedFile;
 };
 
 #endif
@@ -193,6 +193,83 @@ vtkVariant vtkPostgreSQLQuery::DataValue( vtkIdType column )
 } // end of DataValue(int column)
 
 
+// ----------------------------------------------------------------------
+
+bool vtkPostgreSQLQuery::IsValueAvailable( vtkIdType column )
+{
+  return this->IsActive() &&
+    column >= 0 && column < this->GetNumberOfFields() &&
+    this->QueryInternals->CurrentRow >= 0 &&
+    !PQgetisnull(this->QueryInternals->QueryResults,
+                 this->QueryInternals->CurrentRow,
+                 column);
+}
+
+// ----------------------------------------------------------------------
+
+bool vtkPostgreSQLQuery::DataInteger( vtkIdType column, vtkTypeInt64& value )
+{
+  if (!this->IsValueAvailable(column))
+    {
+    return false;
+    }
+
+  int colType = this->GetFieldType( column );
+  if (colType != VTK_SHORT && colType != VTK_UNSIGNED_SHORT &&
+      colType != VTK_INT && colType != VTK_UNSIGNED_INT &&
+      colType != VTK_LONG && colType != VTK_LONG_LONG)
+    {
+    return false;
+    }
+
+  if (this->IsColumnBinary(column))
+    {
+    value = this->DataValue(column).ToTypeInt64();
+    return true;
+    }
+
+  // The server writes integers in decimal as text.
+  const char *rawData = this->GetColumnRawData(column);
+  return ParseInteger(rawData, strlen(rawData), value);
+}
+
+// ----------------------------------------------------------------------
+
+bool vtkPostgreSQLQuery::DataReal( vtkIdType column, double& value )
+{
+  if (!this->IsValueAvailable(column))
+    {
+    return false;
+    }
+
+  bool isBinary = this->IsColumnBinary(column);
+  const char *rawData = this->GetColumnRawData(column);
+  switch (this->GetFieldType( column ))
+    {
+    case VTK_FLOAT:
+      value = ConvertStringToFloat(isBinary, rawData).ToDouble();
+      return true;
+    case VTK_DOUBLE:
+      value = ConvertStringToDouble(isBinary, rawData).ToDouble();
+      return true;
+    default:
+      return false;
+    }
+}
+
+// ----------------------------------------------------------------------
+
+bool vtkPostgreSQLQuery::DataText( vtkIdType column, vtkStdString& value )
+{
+  if (!this->IsValueAvailable(column) ||
+      this->GetFieldType( column ) != VTK_STRING)
+    {
+    return false;
+    }
+  value.assign(this->GetColumnRawData(column));
+  return true;
+}
+
 // ----------------------------------------------------------------------
 vtkPostgreSQLQuery::vtkPostgreSQLQuery()
 {
@@ -109,6 +109,14 @@ protected:
   bool IsColumnBinary(int whichColumn);
   const char *GetColumnRawData(int whichColumn);
 
+  // Description:
+  // Convert the integers, reals and strings of the results without a
+  // vtkVariant per value.  Null values are left to DataValue().
+  bool DataInteger(vtkIdType c, vtkTypeInt64& value);
+  bool DataReal(vtkIdType c, double& value);
+  bool DataText(vtkIdType c, vtkStdString& value);
+  bool IsValueAvailable(vtkIdType c);
+
   bool TransactionInProgress;
   char *LastErrorText;
   int CurrentRow;
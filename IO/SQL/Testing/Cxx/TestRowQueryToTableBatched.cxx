@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestRowQueryToTableBatched.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkRowQueryToTable fetching rows in batches gives the table
+// filled one row at a time, for integers, reals, text, blobs and nulls,
+// also when the values of a column are not all of the same kind.
+
+#include "vtkAbstractArray.h"
+#include "vtkNew.h"
+#include "vtkRowQueryToTable.h"
+#include "vtkSQLiteDatabase.h"
+#include "vtkSQLQuery.h"
+#include "vtkTable.h"
+#include "vtkVariant.h"
+
+#include <sstream>
+
+int TestRowQueryToTableBatched(int, char *[])
+{
+  vtkSQLiteDatabase* db = vtkSQLiteDatabase::SafeDownCast(
+    vtkSQLDatabase::CreateFromURL("sqlite://:memory:"));
+  if (!db || !db->Open("", vtkSQLiteDatabase::USE_EXISTING))
+    {
+    cerr << "Couldn't open an in-memory database" << endl;
+    if (db)
+      {
+      db->Delete();
+      }
+    return EXIT_FAILURE;
+    }
+
+  vtkSQLQuery* query = db->GetQueryInstance();
+  query->SetQuery("CREATE TABLE batch (id INTEGER, weight REAL, "
+                  "name TEXT, data BLOB, mixed)");
+  query->Execute();
+  query->BeginTransaction();
+  for (int i = 0; i < 2345; ++i)
+    {
+    std::ostringstream sql;
+    sql << "INSERT INTO batch VALUES (" << (i % 97 ? i - 1000 : 0)
+        << ", " << (i % 89 ? vtkVariant(0.25 * i).ToString() : "NULL")
+        << ", 'name " << i << "', x'" << std::hex << 16 + i % 200
+        << std::dec << "', ";
+    switch (i % 4)
+      {
+      case 0: sql << i; break;
+      case 1: sql << 1.5 * i; break;
+      case 2: sql << "'" << 3 * i << "'"; break;
+      default: sql << "NULL"; break;
+      }
+    sql << ")";
+    query->SetQuery(sql.str().c_str());
+    if (!query->Execute())
+      {
+      cerr << "Couldn't insert row " << i << endl;
+      query->Delete();
+      db->Delete();
+      return EXIT_FAILURE;
+      }
+    }
+  query->CommitTransaction();
+
+  query->SetQuery("SELECT * FROM batch");
+  vtkNew<vtkRowQueryToTable> serial;
+  serial->SetQuery(query);
+  serial->Update();
+  vtkNew<vtkTable> expected;
+  expected->DeepCopy(serial->GetOutput());
+
+  int status = EXIT_SUCCESS;
+  int batches[] = { 1, 100, 1000, 5000 };
+  for (int b = 0; b < 4 && status == EXIT_SUCCESS; ++b)
+    {
+    vtkNew<vtkRowQueryToTable> batched;
+    batched->SetQuery(query);
+    batched->SetRowsPerFetch(batches[b]);
+    batched->Update();
+    vtkTable* output = batched->GetOutput();
+    if (output->GetNumberOfRows() != 2345 ||
+        output->GetNumberOfRows() != expected->GetNumberOfRows() ||
+        output->GetNumberOfColumns() != expected->GetNumberOfColumns())
+      {
+      cerr << "Wrong size with " << batches[b] << " rows per fetch" << endl;
+      status = EXIT_FAILURE;
+      break;
+      }
+    for (vtkIdType col = 0; col < output->GetNumberOfColumns(); ++col)
+      {
+      if (output->GetColumn(col)->GetDataType() !=
+          expected->GetColumn(col)->GetDataType())
+        {
+        cerr << "Wrong type of column " << col << endl;
+        status = EXIT_FAILURE;
+        }
+      for (vtkIdType row = 0; row < output->GetNumberOfRows(); ++row)
+        {
+        vtkVariant value = output->GetValue(row, col);
+        vtkVariant expectedValue = expected->GetValue(row, col);
+        if (value.ToString() != expectedValue.ToString())
+          {
+          cerr << "Row " << row << " column " << col << " is "
+               << value.ToString() << " instead of "
+               << expectedValue.ToString() << " with " << batches[b]
+               << " rows per fetch" << endl;
+          status = EXIT_FAILURE;
+          break;
+          }
+        }
+      }
+    }
+
+  query->Delete();
+  db->Delete();
+  return status;
+}
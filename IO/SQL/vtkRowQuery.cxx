@@ -22,9 +22,45 @@
 #include "vtkObjectFactory.h"
 #include "vtkStdString.h"
 #include "algorithm"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkTypedDataArray.h"
 #include "vtkVariantArray.h"
 
 #include <cctype>
+#include <vector>
+
+namespace
+{
+
+// Whether values go straight into a column of the data type of array.
+bool IsNumericColumn(vtkDataArray* array)
+{
+  if (!array || array->GetNumberOfComponents() != 1 ||
+      array->GetArrayType() != vtkAbstractArray::DataArrayTemplate)
+    {
+    return false;
+    }
+  switch (array->GetDataType())
+    {
+    vtkTemplateMacro(
+      return vtkTypedDataArray<VTK_TT>::FastDownCast(array) != NULL);
+    }
+  return false;
+}
+
+template <class ValueType>
+void InsertNumber(vtkDataArray* array, vtkIdType row, ValueType value)
+{
+  switch (array->GetDataType())
+    {
+    vtkTemplateMacro(
+      static_cast<vtkTypedDataArray<VTK_TT>*>(array)->InsertValue(
+        row, static_cast<VTK_TT>(value)));
+    }
+}
+
+}
 
 
 vtkRowQuery::vtkRowQuery()
@@ -85,6 +121,115 @@ int vtkRowQuery::GetFieldIndex(char* name)
 }
 
 
+bool vtkRowQuery::DataInteger(vtkIdType, vtkTypeInt64&)
+{
+  return false;
+}
+
+bool vtkRowQuery::DataReal(vtkIdType, double&)
+{
+  return false;
+}
+
+bool vtkRowQuery::DataText(vtkIdType, vtkStdString&)
+{
+  return false;
+}
+
+bool vtkRowQuery::ParseInteger(const char* text, size_t length,
+                               vtkTypeInt64& value)
+{
+  const char* end = text + length;
+  bool negative = (length > 0 && *text == '-');
+  if (negative || (length > 0 && *text == '+'))
+    {
+    ++text;
+    }
+  if (text == end || end - text > 18)
+    {
+    return false;
+    }
+  vtkTypeInt64 result = 0;
+  for (; text != end; ++text)
+    {
+    if (*text < '0' || *text > '9')
+      {
+      return false;
+      }
+    result = 10 * result + (*text - '0');
+    }
+  value = negative ? -result : result;
+  return true;
+}
+
+vtkIdType vtkRowQuery::NextRows(vtkIdType numberOfRows, vtkTable* table)
+{
+  int numFields = this->GetNumberOfFields();
+  if (!table || table->GetNumberOfColumns() != numFields)
+    {
+    vtkErrorMacro("NextRows() needs a table with one column per field.");
+    return 0;
+    }
+
+  // Look the columns up once for the whole batch.
+  std::vector<vtkDataArray*> numbers(numFields);
+  std::vector<vtkStringArray*> strings(numFields);
+  bool allNative = true;
+  for (int col = 0; col < numFields; col++)
+    {
+    vtkAbstractArray* column = table->GetColumn(col);
+    vtkDataArray* data = vtkDataArray::SafeDownCast(column);
+    vtkStringArray* text = vtkStringArray::SafeDownCast(column);
+    numbers[col] = IsNumericColumn(data) ? data : NULL;
+    strings[col] =
+      (text && text->GetNumberOfComponents() == 1) ? text : NULL;
+    allNative = allNative && (numbers[col] || strings[col]);
+    }
+
+  vtkIdType start = table->GetNumberOfRows();
+  vtkIdType rows = 0;
+  vtkTypeInt64 integer;
+  double real;
+  vtkStdString str;
+  while (rows < numberOfRows && this->NextRow())
+    {
+    vtkIdType row = start + rows;
+    if (!allNative)
+      {
+      table->InsertNextBlankRow();
+      }
+    for (int col = 0; col < numFields; col++)
+      {
+      if (numbers[col])
+        {
+        if (this->DataInteger(col, integer))
+          {
+          InsertNumber(numbers[col], row, integer);
+          continue;
+          }
+        if (this->DataReal(col, real))
+          {
+          InsertNumber(numbers[col], row, real);
+          continue;
+          }
+        InsertNumber(numbers[col], row, 0);
+        }
+      else if (strings[col])
+        {
+        if (this->DataText(col, str))
+          {
+          strings[col]->InsertValue(row, str);
+          continue;
+          }
+        strings[col]->InsertValue(row, vtkStdString());
+        }
+      table->SetValue(row, col, this->DataValue(col));
+      }
+    ++rows;
+    }
+  return rows;
+}
+
 bool vtkRowQuery::NextRow(vtkVariantArray* rowArray)
 {
   if (!this->NextRow())
@@ -40,6 +40,9 @@
 //
 // DataValue() - Extract a single data value from the current row.
 //
+// NextRows() - Advances the query results by up to a given number of rows
+//              and appends their values to the columns of a table.
+//
 // .SECTION Thanks
 // Thanks to Andrew Wilson from Sandia National Laboratories for his work
 // on the database classes.
@@ -53,6 +56,8 @@
 #include "vtkIOSQLModule.h" // For export macro
 #include "vtkObject.h"
 
+class vtkStdString;
+class vtkTable;
 class vtkVariant;
 class vtkVariantArray;
 
@@ -101,6 +106,17 @@ public:
   // Also, fill array with row values.
   bool NextRow(vtkVariantArray* rowArray);
 
+  // Description:
+  // Advance up to numberOfRows rows and append their values to table,
+  // whose columns must be the fields of the query in order, as
+  // vtkRowQueryToTable sets them up.  Return the number of rows appended,
+  // which is less than numberOfRows only past the end of the results.
+  // The values are converted as vtkTable::SetValue() converts them, but
+  // the values that DataInteger(), DataReal() or DataText() give go
+  // straight into the single-component numeric and string columns,
+  // without a vtkVariant or a lookup of the column per value.
+  virtual vtkIdType NextRows(vtkIdType numberOfRows, vtkTable* table);
+
   // Description:
   // Return data in current row, field c
   virtual vtkVariant DataValue(vtkIdType c) = 0;
@@ -127,6 +143,24 @@ public:
 protected:
   vtkRowQuery();
   ~vtkRowQuery();
+
+  // Description:
+  // Native access to field c of the current row for NextRows().  Each
+  // returns false, which is the default, when the value is not of that
+  // kind or is null, and NextRows() then converts DataValue() instead.
+  // Subclasses override them to read the values of their results in place.
+  virtual bool DataInteger(vtkIdType c, vtkTypeInt64& value);
+  virtual bool DataReal(vtkIdType c, double& value);
+  virtual bool DataText(vtkIdType c, vtkStdString& value);
+
+  // Description:
+  // Parse the length characters of text as an optional sign followed by
+  // at most 18 decimal digits, which is how database servers write their
+  // integers as text.  Return false for anything else, so that the value
+  // can be converted by the vtkVariant rules instead.
+  static bool ParseInteger(const char* text, size_t length,
+                           vtkTypeInt64& value);
+
   bool CaseSensitiveFieldNames;
 private:
   vtkRowQuery(const vtkRowQuery &); // Not implemented.
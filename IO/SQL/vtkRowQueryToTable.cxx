@@ -37,6 +37,7 @@ vtkRowQueryToTable::vtkRowQueryToTable()
 {
   this->SetNumberOfInputPorts(0);
   this->Query = NULL;
+  this->RowsPerFetch = 0;
 }
 
 vtkRowQueryToTable::~vtkRowQueryToTable()
@@ -56,6 +57,7 @@ void vtkRowQueryToTable::PrintSelf(ostream& os, vtkIndent indent)
     {
     this->Query->PrintSelf(os, indent.GetNextIndent());
     }
+  os << indent << "RowsPerFetch: " << this->RowsPerFetch << endl;
 }
 
 vtkCxxSetObjectMacro(vtkRowQueryToTable, Query, vtkRowQuery);
@@ -143,6 +145,24 @@ int vtkRowQueryToTable::RequestData(
   // Fill the table
   int numRows = 0;
   float progressGuess = 0;
+  if (this->RowsPerFetch > 0)
+    {
+    vtkIdType fetched;
+    do
+      {
+      fetched = this->Query->NextRows(this->RowsPerFetch, output);
+
+      // Update progress every 100 rows, as below
+      int previousHundreds = numRows / 100;
+      numRows += static_cast<int>(fetched);
+      if (numRows / 100 != previousHundreds)
+        {
+        progressGuess = ((numRows/100)%100)*.01;
+        this->UpdateProgress(progressGuess);
+        }
+      } while (fetched == this->RowsPerFetch);
+    return 1;
+    }
   vtkVariantArray* rowArray = vtkVariantArray::New();
   while (this->Query->NextRow(rowArray))
     {
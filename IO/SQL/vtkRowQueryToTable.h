@@ -52,6 +52,14 @@ public:
   void SetQuery(vtkRowQuery* query);
   vtkGetObjectMacro(Query, vtkRowQuery);
 
+  // Description:
+  // Number of rows fetched at a time with vtkRowQuery::NextRows(), which
+  // fills the typed columns of the output without going through a
+  // vtkVariantArray per row.  The default, 0, fetches the rows one at a
+  // time with vtkRowQuery::NextRow().
+  vtkSetClampMacro(RowsPerFetch, int, 0, VTK_INT_MAX);
+  vtkGetMacro(RowsPerFetch, int);
+
   // Description:
   // Update the modified time based on the query.
   unsigned long GetMTime();
@@ -61,6 +69,7 @@ protected:
   ~vtkRowQueryToTable();
 
   vtkRowQuery* Query;
+  int RowsPerFetch;
 
   int RequestData(
     vtkInformation*,
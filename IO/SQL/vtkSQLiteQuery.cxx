@@ -396,6 +396,56 @@ vtkVariant vtkSQLiteQuery::DataValue(vtkIdType column)
     }
 }
 
+// ----------------------------------------------------------------------
+bool vtkSQLiteQuery::DataInteger(vtkIdType column, vtkTypeInt64& value)
+{
+  if (!this->IsActive() || column < 0 || column >= this->GetNumberOfFields() ||
+      vtk_sqlite3_column_type(this->Statement, column) != VTK_SQLITE_INTEGER)
+    {
+    return false;
+    }
+  // The same value as DataValue() gives
+  value = vtk_sqlite3_column_int(this->Statement, column);
+  return true;
+}
+
+// ----------------------------------------------------------------------
+bool vtkSQLiteQuery::DataReal(vtkIdType column, double& value)
+{
+  if (!this->IsActive() || column < 0 || column >= this->GetNumberOfFields() ||
+      vtk_sqlite3_column_type(this->Statement, column) != VTK_SQLITE_FLOAT)
+    {
+    return false;
+    }
+  value = vtk_sqlite3_column_double(this->Statement, column);
+  return true;
+}
+
+// ----------------------------------------------------------------------
+bool vtkSQLiteQuery::DataText(vtkIdType column, vtkStdString& value)
+{
+  if (!this->IsActive() || column < 0 || column >= this->GetNumberOfFields())
+    {
+    return false;
+    }
+  switch (vtk_sqlite3_column_type(this->Statement, column))
+    {
+    case VTK_SQLITE_TEXT:
+      value.assign(reinterpret_cast<const char*>(
+        vtk_sqlite3_column_text(this->Statement, column)));
+      return true;
+
+    case VTK_SQLITE_BLOB:
+      value.assign(
+        static_cast<const char*>(vtk_sqlite3_column_blob(this->Statement, column)),
+        vtk_sqlite3_column_bytes(this->Statement, column));
+      return true;
+
+    default:
+      return false;
+    }
+}
+
 // ----------------------------------------------------------------------
 const char * vtkSQLiteQuery::GetLastErrorText()
 {
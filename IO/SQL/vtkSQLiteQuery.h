@@ -149,6 +149,12 @@ protected:
   vtkSQLiteQuery();
   ~vtkSQLiteQuery();
 
+  // Description:
+  // Read integers, reals, text and blobs straight from the statement.
+  bool DataInteger(vtkIdType c, vtkTypeInt64& value);
+  bool DataReal(vtkIdType c, double& value);
+  bool DataText(vtkIdType c, vtkStdString& value);
+
   vtkSetStringMacro(LastErrorText);
 
 private:
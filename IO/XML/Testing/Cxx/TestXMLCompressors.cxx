@@ -0,0 +1,112 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompressors.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that image data written with each compressor type of vtkXMLWriter,
+// in binary and appended modes, is read back by vtkXMLImageDataReader,
+// which finds the compressor in the header of the file.  The blocks
+// compressed and uncompressed in parallel must give the same file and
+// the same values.
+
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cmath>
+#include <string>
+
+int TestXMLCompressors(int, char *[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(64, 48, 16);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    scalars->SetValue(i, static_cast<float>(floor(10.0 * sin(0.01 * i))));
+    }
+  image->GetPointData()->SetScalars(scalars.GetPointer());
+
+  const char *names[3] = { 0, "vtkZLibDataCompressor", "vtkLZ4DataCompressor" };
+  for (int type = vtkXMLWriter::NONE; type <= vtkXMLWriter::LZ4; ++type)
+    {
+    for (int appended = 0; appended < 2; ++appended)
+      {
+      std::string serialOutput;
+      for (int parallel = 0; parallel < 2; ++parallel)
+        {
+        vtkNew<vtkXMLImageDataWriter> writer;
+        writer->SetInputData(image.GetPointer());
+        writer->WriteToOutputStringOn();
+        writer->SetCompressorType(type);
+        writer->SetBlockSize(4096);
+        writer->SetCompressInParallel(parallel);
+        if (appended)
+          {
+          writer->SetDataModeToAppended();
+          }
+        else
+          {
+          writer->SetDataModeToBinary();
+          }
+        writer->Write();
+        std::string output = writer->GetOutputString();
+        if (names[type] &&
+            output.find(std::string("compressor=\"") + names[type]) ==
+            std::string::npos)
+          {
+          cerr << "No " << names[type] << " in the header" << endl;
+          return EXIT_FAILURE;
+          }
+        if (!parallel)
+          {
+          serialOutput = output;
+          }
+        else if (output != serialOutput)
+          {
+          cerr << "Compressor type " << type << ": the parallel compression "
+               << "writes another file" << endl;
+          return EXIT_FAILURE;
+          }
+
+        vtkNew<vtkXMLImageDataReader> reader;
+        reader->ReadFromInputStringOn();
+        reader->SetInputString(output);
+        reader->SetUncompressInParallel(parallel);
+        reader->Update();
+        vtkDataArray *read =
+          reader->GetOutput()->GetPointData()->GetArray("Scalars");
+        if (!read ||
+            read->GetNumberOfTuples() != scalars->GetNumberOfTuples())
+          {
+          cerr << "Compressor type " << type << ": no scalars read" << endl;
+          return EXIT_FAILURE;
+          }
+        for (vtkIdType i = 0; i < read->GetNumberOfTuples(); ++i)
+          {
+          if (read->GetTuple1(i) != scalars->GetValue(i))
+            {
+            cerr << "Compressor type " << type << ": wrong value at " << i
+                 << endl;
+            return EXIT_FAILURE;
+            }
+          }
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
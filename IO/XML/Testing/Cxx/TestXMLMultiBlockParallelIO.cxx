@@ -0,0 +1,193 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLMultiBlockParallelIO.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that a nested multi-block dataset written and read with the leaf
+// files in parallel gives the tree written and read one leaf at a time,
+// also when two leaves share a dataset.
+
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLMultiBlockDataReader.h"
+#include "vtkXMLMultiBlockDataWriter.h"
+
+#include <string>
+
+namespace
+{
+
+bool CompareLeaves(vtkDataSet *expected, vtkDataSet *read)
+{
+  if (!expected || !read)
+    {
+    return !expected && !read;
+    }
+  if (read->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+      read->GetNumberOfCells() != expected->GetNumberOfCells() ||
+      read->GetPointData()->GetNumberOfArrays() !=
+      expected->GetPointData()->GetNumberOfArrays())
+    {
+    return false;
+    }
+  for (int a = 0; a < expected->GetPointData()->GetNumberOfArrays(); ++a)
+    {
+    vtkDataArray *array = expected->GetPointData()->GetArray(a);
+    vtkDataArray *readArray =
+      read->GetPointData()->GetArray(array->GetName());
+    if (!readArray)
+      {
+      return false;
+      }
+    for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+      {
+      for (int c = 0; c < array->GetNumberOfComponents(); ++c)
+        {
+        if (readArray->GetComponent(i, c) != array->GetComponent(i, c))
+          {
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+bool CompareTrees(vtkDataObject *expected, vtkDataObject *read)
+{
+  vtkMultiBlockDataSet *block = vtkMultiBlockDataSet::SafeDownCast(expected);
+  vtkMultiPieceDataSet *pieces = vtkMultiPieceDataSet::SafeDownCast(expected);
+  if (block || pieces)
+    {
+    vtkMultiBlockDataSet *readBlock = vtkMultiBlockDataSet::SafeDownCast(read);
+    vtkMultiPieceDataSet *readPieces =
+      vtkMultiPieceDataSet::SafeDownCast(read);
+    if (block && readBlock &&
+        readBlock->GetNumberOfBlocks() == block->GetNumberOfBlocks())
+      {
+      for (unsigned int b = 0; b < block->GetNumberOfBlocks(); ++b)
+        {
+        if (!CompareTrees(block->GetBlock(b), readBlock->GetBlock(b)))
+          {
+          return false;
+          }
+        }
+      return true;
+      }
+    if (pieces && readPieces &&
+        readPieces->GetNumberOfPieces() == pieces->GetNumberOfPieces())
+      {
+      for (unsigned int p = 0; p < pieces->GetNumberOfPieces(); ++p)
+        {
+        if (!CompareLeaves(pieces->GetPiece(p), readPieces->GetPiece(p)))
+          {
+          return false;
+          }
+        }
+      return true;
+      }
+    return false;
+    }
+  return CompareLeaves(vtkDataSet::SafeDownCast(expected),
+                       vtkDataSet::SafeDownCast(read));
+}
+
+vtkImageData *MakeImage(int size)
+{
+  vtkImageData *image = vtkImageData::New();
+  image->SetDimensions(size, size + 1, 3);
+  vtkNew<vtkUnsignedCharArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    scalars->SetValue(i, static_cast<unsigned char>((size * i) % 251));
+    }
+  image->GetPointData()->SetScalars(scalars.GetPointer());
+  return image;
+}
+
+}
+
+int TestXMLMultiBlockParallelIO(int argc, char *argv[])
+{
+  char *tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string serialName = std::string(tempDir) + "/MultiBlockSerial.vtm";
+  std::string parallelName = std::string(tempDir) + "/MultiBlockParallel.vtm";
+  delete [] tempDir;
+
+  // Blocks of images, a piece of spheres, an empty block and a sphere
+  // that is also the first piece.
+  vtkNew<vtkMultiBlockDataSet> tree;
+  vtkNew<vtkMultiBlockDataSet> images;
+  for (unsigned int b = 0; b < 20; ++b)
+    {
+    vtkImageData *image = MakeImage(5 + b);
+    images->SetBlock(b, image);
+    image->Delete();
+    }
+  tree->SetBlock(0, images.GetPointer());
+  vtkNew<vtkMultiPieceDataSet> spheres;
+  for (unsigned int p = 0; p < 6; ++p)
+    {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetThetaResolution(8 + 2 * p);
+    sphere->SetCenter(p, 0, 0);
+    sphere->Update();
+    vtkNew<vtkPolyData> poly;
+    poly->ShallowCopy(sphere->GetOutput());
+    spheres->SetPiece(p, poly.GetPointer());
+    }
+  tree->SetBlock(1, spheres.GetPointer());
+  tree->SetBlock(2, 0);
+  tree->SetBlock(3, spheres->GetPiece(0));
+
+  vtkNew<vtkXMLMultiBlockDataWriter> writer;
+  writer->SetInputData(tree.GetPointer());
+  writer->SetFileName(serialName.c_str());
+  writer->Write();
+  writer->SetFileName(parallelName.c_str());
+  writer->WriteBlocksInParallelOn();
+  writer->Write();
+  if (writer->GetErrorCode())
+    {
+    cerr << "Writing the leaves in parallel failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  for (int mode = 0; mode < 4; ++mode)
+    {
+    vtkNew<vtkXMLMultiBlockDataReader> reader;
+    reader->SetFileName(mode % 2 ? parallelName.c_str() : serialName.c_str());
+    reader->SetReadBlocksInParallel(mode / 2);
+    reader->Update();
+    if (!CompareTrees(tree.GetPointer(), reader->GetOutput()))
+      {
+      cerr << "Wrong tree with the leaves written "
+           << (mode % 2 ? "in parallel" : "serially") << " and read "
+           << (mode / 2 ? "in parallel" : "serially") << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
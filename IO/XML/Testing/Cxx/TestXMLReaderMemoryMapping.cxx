@@ -0,0 +1,197 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLReaderMemoryMapping.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that the XML readers with MemoryMapping give the values read
+// without it, for polygonal data and image data stored in raw appended
+// data.  Unsigned char arrays are always aligned, so that they are mapped
+// as the output is set up.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <string>
+
+namespace
+{
+
+bool CompareArrays(vtkDataArray *expected, vtkDataArray *read,
+                   const char *what)
+{
+  if (!read ||
+      read->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+      read->GetNumberOfComponents() != expected->GetNumberOfComponents())
+    {
+    cerr << what << " has the wrong size" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < expected->GetNumberOfComponents(); ++c)
+      {
+      if (read->GetComponent(i, c) != expected->GetComponent(i, c))
+        {
+        cerr << what << " differs at tuple " << i << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool CompareFields(vtkFieldData *expected, vtkFieldData *read)
+{
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+    {
+    vtkDataArray *array = expected->GetArray(a);
+    if (!CompareArrays(array, read->GetArray(array->GetName()),
+                       array->GetName()))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+vtkUnsignedCharArray *MakeArray(const char *name, int components,
+                                vtkIdType tuples)
+{
+  vtkUnsignedCharArray *array = vtkUnsignedCharArray::New();
+  array->SetName(name);
+  array->SetNumberOfComponents(components);
+  array->SetNumberOfTuples(tuples);
+  for (vtkIdType i = 0; i < tuples * components; ++i)
+    {
+    array->SetValue(i, static_cast<unsigned char>((7 * i) % 251));
+    }
+  return array;
+}
+
+}
+
+int TestXMLReaderMemoryMapping(int argc, char *argv[])
+{
+  char *tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string polyName = std::string(tempDir) + "/MemoryMapping.vtp";
+  std::string imageName = std::string(tempDir) + "/MemoryMapping.vti";
+  delete [] tempDir;
+
+  // polygonal data with mapped and unaligned arrays
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(40);
+  sphere->SetPhiResolution(30);
+  sphere->Update();
+  vtkNew<vtkPolyData> poly;
+  poly->ShallowCopy(sphere->GetOutput());
+  vtkUnsignedCharArray *colors =
+    MakeArray("Colors", 3, poly->GetNumberOfPoints());
+  poly->GetPointData()->AddArray(colors);
+  colors->Delete();
+  vtkUnsignedCharArray *labels =
+    MakeArray("Labels", 1, poly->GetNumberOfCells());
+  poly->GetCellData()->AddArray(labels);
+  labels->Delete();
+
+  vtkNew<vtkXMLPolyDataWriter> polyWriter;
+  polyWriter->SetInputData(poly.GetPointer());
+  polyWriter->SetFileName(polyName.c_str());
+  polyWriter->SetCompressorTypeToNone();
+  polyWriter->SetDataModeToAppended();
+  polyWriter->EncodeAppendedDataOff();
+  polyWriter->Write();
+
+  // image data
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(33, 17, 9);
+  vtkUnsignedCharArray *scalars =
+    MakeArray("Scalars", 1, image->GetNumberOfPoints());
+  image->GetPointData()->SetScalars(scalars);
+  scalars->Delete();
+  vtkUnsignedCharArray *cells =
+    MakeArray("Cells", 2, image->GetNumberOfCells());
+  image->GetCellData()->AddArray(cells);
+  cells->Delete();
+
+  vtkNew<vtkXMLImageDataWriter> imageWriter;
+  imageWriter->SetInputData(image.GetPointer());
+  imageWriter->SetFileName(imageName.c_str());
+  imageWriter->SetCompressorTypeToNone();
+  imageWriter->SetDataModeToAppended();
+  imageWriter->EncodeAppendedDataOff();
+  imageWriter->Write();
+
+  for (int mapping = 0; mapping < 2; ++mapping)
+    {
+    vtkNew<vtkXMLPolyDataReader> polyReader;
+    polyReader->SetFileName(polyName.c_str());
+    polyReader->SetMemoryMapping(mapping);
+    polyReader->Update();
+    vtkPolyData *readPoly = polyReader->GetOutput();
+    if (readPoly->GetNumberOfCells() != poly->GetNumberOfCells() ||
+        !CompareArrays(poly->GetPoints()->GetData(),
+                       readPoly->GetPoints()->GetData(), "Points") ||
+        !CompareFields(poly->GetPointData(), readPoly->GetPointData()) ||
+        !CompareFields(poly->GetCellData(), readPoly->GetCellData()))
+      {
+      cerr << "Wrong polygonal data with MemoryMapping " << mapping << endl;
+      return EXIT_FAILURE;
+      }
+
+    vtkNew<vtkXMLImageDataReader> imageReader;
+    imageReader->SetFileName(imageName.c_str());
+    imageReader->SetMemoryMapping(mapping);
+    imageReader->Update();
+    vtkImageData *readImage = imageReader->GetOutput();
+    if (!CompareFields(image->GetPointData(), readImage->GetPointData()) ||
+        !CompareFields(image->GetCellData(), readImage->GetCellData()))
+      {
+      cerr << "Wrong image data with MemoryMapping " << mapping << endl;
+      return EXIT_FAILURE;
+      }
+
+    // a part of the image is read into allocated arrays
+    int extent[6] = { 4, 20, 0, 16, 2, 6 };
+    imageReader->vtkAlgorithm::UpdateExtent(extent);
+    readImage = imageReader->GetOutput();
+    for (int k = 2; k <= 6; ++k)
+      {
+      for (int j = 0; j <= 16; ++j)
+        {
+        for (int i = 4; i <= 20; ++i)
+          {
+          if (readImage->GetScalarComponentAsDouble(i, j, k, 0) !=
+              image->GetScalarComponentAsDouble(i, j, k, 0))
+            {
+            cerr << "Wrong subextent with MemoryMapping " << mapping << endl;
+            return EXIT_FAILURE;
+            }
+          }
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -26,6 +26,7 @@
 #include "vtkInstantiator.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkUniformGrid.h"
 #include "vtkXMLDataElement.h"
@@ -62,12 +63,142 @@ struct vtkXMLCompositeDataReaderInternals
     }
   std::set<int> UpdateIndices;
   bool HasUpdateRestriction;
+  typedef std::map<vtkXMLDataElement*, vtkSmartPointer<vtkDataSet> >
+    PreloadedType;
+  PreloadedType Preloaded;
 };
 
+namespace
+{
+
+// The full name of the file of a leaf, or an empty string.
+std::string GetLeafFileName(vtkXMLDataElement* xmlElem, const char* filePath)
+{
+  const char* file = xmlElem->GetAttribute("file");
+  if (!file)
+    {
+    return std::string();
+    }
+
+  std::string fileName;
+  if (!(file[0] == '/' || file[1] == ':'))
+    {
+    fileName = filePath;
+    if (fileName.length())
+      {
+      fileName += "/";
+      }
+    }
+  fileName += file;
+  return fileName;
+}
+
+// The name of the reader class for the extension of fileName.
+const char* GetLeafReaderName(const std::string& fileName)
+{
+  std::string ext = vtksys::SystemTools::GetFilenameLastExtension(fileName);
+  if (ext.size() > 0)
+    {
+    // remote "." from the extension.
+    ext = &(ext.c_str()[1]);
+    }
+
+  // Search for the reader matching this extension.
+  const char* rname = 0;
+  for(const vtkXMLCompositeDataReaderEntry* readerEntry =
+    vtkXMLCompositeDataReaderInternals::ReaderList;
+    !rname && readerEntry->extension; ++readerEntry)
+    {
+    if (ext == readerEntry->extension)
+      {
+      rname = readerEntry->name;
+      }
+    }
+  return rname;
+}
+
+vtkXMLReader* NewReaderOfType(const char* type)
+{
+  vtkXMLReader* reader = 0;
+  if (strcmp(type, "vtkXMLImageDataReader") == 0)
+    {
+    reader = vtkXMLImageDataReader::New();
+    }
+  else if (strcmp(type,"vtkXMLUnstructuredGridReader") == 0)
+    {
+    reader = vtkXMLUnstructuredGridReader::New();
+    }
+  else if (strcmp(type,"vtkXMLPolyDataReader") == 0)
+    {
+    reader = vtkXMLPolyDataReader::New();
+    }
+  else if (strcmp(type,"vtkXMLRectilinearGridReader") == 0)
+    {
+    reader = vtkXMLRectilinearGridReader::New();
+    }
+  else if (strcmp(type,"vtkXMLStructuredGridReader") == 0)
+    {
+    reader = vtkXMLStructuredGridReader::New();
+    }
+  if (!reader)
+    {
+    // If all fails, Use the instantiator to create the reader.
+    reader = vtkXMLReader::SafeDownCast(vtkInstantiator::CreateInstance(type));
+    }
+  return reader;
+}
+
+// Append the "DataSet" elements of the subtree of elem in the order of
+// CountLeaves().
+void CollectLeaves(vtkXMLDataElement* elem,
+                   std::vector<vtkXMLDataElement*>& leaves)
+{
+  unsigned int max = elem->GetNumberOfNestedElements();
+  for (unsigned int cc=0; cc < max; ++cc)
+    {
+    vtkXMLDataElement* child = elem->GetNestedElement(cc);
+    if (child && child->GetName())
+      {
+      if (strcmp(child->GetName(), "DataSet")==0)
+        {
+        leaves.push_back(child);
+        }
+      else
+        {
+        CollectLeaves(child, leaves);
+        }
+      }
+    }
+}
+
+class vtkXMLCompositeDataReaderLeafFunctor
+{
+public:
+  vtkXMLCompositeDataReaderLeafFunctor(
+    const std::vector<vtkSmartPointer<vtkXMLReader> >& readers)
+    : Readers(readers)
+    {
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Readers[i]->Update();
+      }
+    }
+
+private:
+  const std::vector<vtkSmartPointer<vtkXMLReader> >& Readers;
+};
+
+}
+
 //----------------------------------------------------------------------------
 vtkXMLCompositeDataReader::vtkXMLCompositeDataReader()
 {
   this->Internal = new vtkXMLCompositeDataReaderInternals;
+  this->ReadBlocksInParallel = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -80,6 +211,8 @@ vtkXMLCompositeDataReader::~vtkXMLCompositeDataReader()
 void vtkXMLCompositeDataReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ReadBlocksInParallel: " << this->ReadBlocksInParallel
+     << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -157,32 +290,7 @@ vtkXMLReader* vtkXMLCompositeDataReader::GetReaderOfType(const char* type)
     return iter->second.GetPointer();
     }
 
-  vtkXMLReader* reader = 0;
-  if (strcmp(type, "vtkXMLImageDataReader") == 0)
-    {
-    reader = vtkXMLImageDataReader::New();
-    }
-  else if (strcmp(type,"vtkXMLUnstructuredGridReader") == 0)
-    {
-    reader = vtkXMLUnstructuredGridReader::New();
-    }
-  else if (strcmp(type,"vtkXMLPolyDataReader") == 0)
-    {
-    reader = vtkXMLPolyDataReader::New();
-    }
-  else if (strcmp(type,"vtkXMLRectilinearGridReader") == 0)
-    {
-    reader = vtkXMLRectilinearGridReader::New();
-    }
-  else if (strcmp(type,"vtkXMLStructuredGridReader") == 0)
-    {
-    reader = vtkXMLStructuredGridReader::New();
-    }
-  if (!reader)
-    {
-    // If all fails, Use the instantiator to create the reader.
-    reader = vtkXMLReader::SafeDownCast(vtkInstantiator::CreateInstance(type));
-    }
+  vtkXMLReader* reader = NewReaderOfType(type);
   if (reader)
     {
     this->Internal->Readers[type] = reader;
@@ -296,7 +404,68 @@ void vtkXMLCompositeDataReader::ReadXMLData()
   // All process create the  entire tree structure however, only each one only
   // reads the datasets assigned to it.
   unsigned int dataSetIndex=0;
+  if (this->ReadBlocksInParallel)
+    {
+    this->PreloadDatasets(this->GetPrimaryElement(), filePath.c_str(),
+                          dataSetIndex);
+    }
   this->ReadComposite(this->GetPrimaryElement(), composite, filePath.c_str(), dataSetIndex);
+  this->ReleasePreloadedDatasets();
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLCompositeDataReader::PreloadDatasets(vtkXMLDataElement* element,
+  const char* filePath, unsigned int dataSetIndex)
+{
+  this->ReleasePreloadedDatasets();
+
+  std::vector<vtkXMLDataElement*> leaves;
+  CollectLeaves(element, leaves);
+
+  // Each leaf gets its own reader, set up here, so that the threads only
+  // read the files.
+  std::vector<vtkXMLDataElement*> elements;
+  std::vector<vtkSmartPointer<vtkXMLReader> > readers;
+  for (size_t i = 0; i < leaves.size(); ++i)
+    {
+    if (!this->ShouldReadDataSet(dataSetIndex + static_cast<unsigned int>(i)))
+      {
+      continue;
+      }
+    std::string fileName = GetLeafFileName(leaves[i], filePath);
+    const char* rname = fileName.empty() ? 0 : GetLeafReaderName(fileName);
+    vtkXMLReader* reader = rname ? NewReaderOfType(rname) : 0;
+    if (!reader)
+      {
+      // ReadDataset() reports it.
+      continue;
+      }
+    reader->SetFileName(fileName.c_str());
+    reader->GetExecutive();
+    elements.push_back(leaves[i]);
+    readers.push_back(reader);
+    reader->Delete();
+    }
+
+  vtkXMLCompositeDataReaderLeafFunctor readLeaves(readers);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(readers.size()), 1, readLeaves);
+
+  for (size_t i = 0; i < readers.size(); ++i)
+    {
+    vtkSmartPointer<vtkDataSet> outputCopy;
+    if (vtkDataSet* output = readers[i]->GetOutputAsDataSet())
+      {
+      outputCopy.TakeReference(output->NewInstance());
+      outputCopy->ShallowCopy(output);
+      }
+    this->Internal->Preloaded[elements[i]] = outputCopy;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLCompositeDataReader::ReleasePreloadedDatasets()
+{
+  this->Internal->Preloaded.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -321,43 +490,27 @@ int vtkXMLCompositeDataReader::ShouldReadDataSet(unsigned int dataSetIndex)
 vtkDataSet* vtkXMLCompositeDataReader::ReadDataset(vtkXMLDataElement* xmlElem,
   const char* filePath)
 {
-  // Construct the name of the internal file.
-  const char* file = xmlElem->GetAttribute("file");
-  if (!file)
+  vtkXMLCompositeDataReaderInternals::PreloadedType::iterator preloaded =
+    this->Internal->Preloaded.find(xmlElem);
+  if (preloaded != this->Internal->Preloaded.end())
     {
-    return 0;
-    }
-
-  std::string fileName;
-  if (!(file[0] == '/' || file[1] == ':'))
-    {
-    fileName = filePath;
-    if (fileName.length())
+    vtkDataSet* output = preloaded->second;
+    if (output)
       {
-      fileName += "/";
+      output->Register(this);
       }
+    this->Internal->Preloaded.erase(preloaded);
+    return output;
     }
-  fileName += file;
 
-  // Get the file extension.
-  std::string ext = vtksys::SystemTools::GetFilenameLastExtension(fileName);
-  if (ext.size() > 0)
+  // Construct the name of the internal file.
+  std::string fileName = GetLeafFileName(xmlElem, filePath);
+  if (fileName.empty())
     {
-    // remote "." from the extension.
-    ext = &(ext.c_str()[1]);
+    return 0;
     }
 
-  // Search for the reader matching this extension.
-  const char* rname = 0;
-  for(const vtkXMLCompositeDataReaderEntry* readerEntry =
-    this->Internal->ReaderList;
-    !rname && readerEntry->extension; ++readerEntry)
-    {
-    if (ext == readerEntry->extension)
-      {
-      rname = readerEntry->name;
-      }
-    }
+  const char* rname = GetLeafReaderName(fileName);
   vtkXMLReader* reader = this->GetReaderOfType(rname);
   if (!reader)
     {
@@ -47,6 +47,15 @@ public:
   vtkCompositeDataSet* GetOutput();
   vtkCompositeDataSet* GetOutput(int);
 
+  // Description:
+  // When on, the files of the leaves that this process reads are read in
+  // parallel with vtkSMPTools before the output tree is built, each with
+  // its own reader, so that the number of files read at a time is bounded
+  // by the number of SMP threads.  Off by default.
+  vtkSetMacro(ReadBlocksInParallel, int);
+  vtkGetMacro(ReadBlocksInParallel, int);
+  vtkBooleanMacro(ReadBlocksInParallel, int);
+
 protected:
   vtkXMLCompositeDataReader();
   ~vtkXMLCompositeDataReader();
@@ -90,6 +99,20 @@ protected:
   // Read the vtkDataSet (a leaf) in the composite dataset.
   virtual vtkDataSet* ReadDataset(vtkXMLDataElement* xmlElem, const char* filePath);
 
+  // Read in parallel the leaves of the subtree of element that
+  // ShouldReadDataSet() selects, dataSetIndex being the index of its first
+  // leaf.  ReadDataset() then returns them without reading their files
+  // again.  ReadXMLData() calls it for the whole tree when
+  // ReadBlocksInParallel is on; subclasses that skip some of the selected
+  // leaves override it.  ReleasePreloadedDatasets() drops the leaves that
+  // were not used.
+  virtual void PreloadDatasets(vtkXMLDataElement* element,
+                               const char* filePath,
+                               unsigned int dataSetIndex);
+  void ReleasePreloadedDatasets();
+
+  int ReadBlocksInParallel;
+
   // Counts "DataSet" elements in the subtree.
   unsigned int CountLeaves(vtkXMLDataElement* elem);
 
@@ -40,7 +40,16 @@
 #include "vtkXMLUnstructuredGridWriter.h"
 #include "vtkXMLWriter.h"
 #include "vtkDataObjectTreeIterator.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
 #include <vtksys/SystemTools.hxx>
+#include <map>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -55,14 +64,100 @@ public:
   std::string FilePrefix;
   vtkSmartPointer<vtkXMLDataElement> Root;
   std::vector<int> DataTypes;
+
+  // A leaf whose file is written by WritePendingLeaves().
+  struct Leaf
+  {
+    int WriterIndex;
+    vtkXMLDataElement* Element;
+    int ErrorCode;
+  };
+  std::vector<Leaf> PendingLeaves;
 };
 
+namespace
+{
+
+// Add the objects that writing a leaf reads and may modify: the dataset,
+// its arrays and its cells.
+void AddLeafObjects(vtkDataSet* ds, std::vector<vtkObject*>& objects)
+{
+  objects.push_back(ds);
+  vtkFieldData* fields[3] =
+    { ds->GetPointData(), ds->GetCellData(), ds->GetFieldData() };
+  for (int f = 0; f < 3; ++f)
+    {
+    for (int a = 0; fields[f] && a < fields[f]->GetNumberOfArrays(); ++a)
+      {
+      objects.push_back(fields[f]->GetAbstractArray(a));
+      }
+    }
+  if (vtkPointSet* ps = vtkPointSet::SafeDownCast(ds))
+    {
+    if (ps->GetPoints())
+      {
+      objects.push_back(ps->GetPoints()->GetData());
+      }
+    }
+  if (vtkPolyData* pd = vtkPolyData::SafeDownCast(ds))
+    {
+    vtkCellArray* cells[4] =
+      { pd->GetVerts(), pd->GetLines(), pd->GetPolys(), pd->GetStrips() };
+    for (int c = 0; c < 4; ++c)
+      {
+      objects.push_back(cells[c]);
+      }
+    }
+  else if (vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(ds))
+    {
+    objects.push_back(ug->GetCells());
+    objects.push_back(ug->GetCellTypesArray());
+    objects.push_back(ug->GetCellLocationsArray());
+    }
+  else if (vtkRectilinearGrid* rg = vtkRectilinearGrid::SafeDownCast(ds))
+    {
+    objects.push_back(rg->GetXCoordinates());
+    objects.push_back(rg->GetYCoordinates());
+    objects.push_back(rg->GetZCoordinates());
+    }
+}
+
+class vtkXMLCompositeDataWriterLeafFunctor
+{
+public:
+  vtkXMLCompositeDataWriterLeafFunctor(
+    vtkXMLCompositeDataWriterInternals* internal,
+    const std::vector<size_t>& leaves)
+    : Internal(internal), Leaves(leaves)
+    {
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkXMLCompositeDataWriterInternals::Leaf& leaf =
+        this->Internal->PendingLeaves[this->Leaves[i]];
+      vtkXMLWriter* writer = this->Internal->Writers[leaf.WriterIndex];
+      writer->Write();
+      leaf.ErrorCode = static_cast<int>(writer->GetErrorCode());
+      }
+    }
+
+private:
+  vtkXMLCompositeDataWriterInternals* Internal;
+  const std::vector<size_t>& Leaves;
+};
+
+}
+
 //----------------------------------------------------------------------------
 vtkXMLCompositeDataWriter::vtkXMLCompositeDataWriter()
 {
   this->Internal = new vtkXMLCompositeDataWriterInternals;
   this->GhostLevel = 0;
   this->WriteMetaFile = 1;
+  this->WriteBlocksInParallel = 0;
 
   // Setup a callback for the internal writers to report progress.
   this->ProgressObserver = vtkCallbackCommand::New();
@@ -97,6 +192,8 @@ void vtkXMLCompositeDataWriter::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "GhostLevel: " << this->GhostLevel << endl;
   os << indent << "WriteMetaFile: " << this->WriteMetaFile<< endl;
+  os << indent << "WriteBlocksInParallel: " << this->WriteBlocksInParallel
+     << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -196,7 +293,9 @@ int vtkXMLCompositeDataWriter::RequestData(vtkInformation*,
   this->Internal->Root->SetName(compositeData->GetClassName());
 
   int writerIdx = 0;
-  if (!this->WriteComposite(compositeData, this->Internal->Root, writerIdx))
+  this->Internal->PendingLeaves.clear();
+  if (!this->WriteComposite(compositeData, this->Internal->Root, writerIdx) ||
+      !this->WritePendingLeaves())
     {
     this->RemoveWrittenFiles(subdir.c_str());
     return 0;
@@ -262,6 +361,16 @@ int vtkXMLCompositeDataWriter::WriteNonCompositeData(
 
   writer->SetFileName(full.c_str());
 
+  if (this->WriteBlocksInParallel)
+    {
+    vtkXMLCompositeDataWriterInternals::Leaf leaf;
+    leaf.WriterIndex = myWriterIndex;
+    leaf.Element = datasetXML;
+    leaf.ErrorCode = vtkErrorCode::NoError;
+    this->Internal->PendingLeaves.push_back(leaf);
+    return 1;
+    }
+
   // Write the data.
   writer->AddObserver(vtkCommand::ProgressEvent, this->ProgressObserver);
   writer->Write();
@@ -276,6 +385,74 @@ int vtkXMLCompositeDataWriter::WriteNonCompositeData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLCompositeDataWriter::WritePendingLeaves()
+{
+  std::vector<vtkXMLCompositeDataWriterInternals::Leaf>& pending =
+    this->Internal->PendingLeaves;
+  if (pending.empty())
+    {
+    return 1;
+    }
+
+  // The pipeline of each writer is set up here, and a leaf is written by
+  // the threads only if nothing that it reads is read by another leaf.
+  std::vector<std::vector<vtkObject*> > objects(pending.size());
+  std::map<vtkObject*, int> uses;
+  for (size_t i = 0; i < pending.size(); ++i)
+    {
+    vtkXMLWriter* writer = this->Internal->Writers[pending[i].WriterIndex];
+    writer->GetExecutive();
+    AddLeafObjects(vtkDataSet::SafeDownCast(writer->GetInput()), objects[i]);
+    for (size_t j = 0; j < objects[i].size(); ++j)
+      {
+      if (objects[i][j])
+        {
+        ++uses[objects[i][j]];
+        }
+      }
+    }
+  std::vector<size_t> parallel;
+  std::vector<size_t> serial;
+  for (size_t i = 0; i < pending.size(); ++i)
+    {
+    bool shared = false;
+    for (size_t j = 0; !shared && j < objects[i].size(); ++j)
+      {
+      shared = objects[i][j] && uses[objects[i][j]] > 1;
+      }
+    (shared ? serial : parallel).push_back(i);
+    }
+
+  vtkXMLCompositeDataWriterLeafFunctor writeParallel(this->Internal, parallel);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(parallel.size()), 1,
+                   writeParallel);
+  vtkXMLCompositeDataWriterLeafFunctor writeSerial(this->Internal, serial);
+  writeSerial(0, static_cast<vtkIdType>(serial.size()));
+  this->UpdateProgressDiscrete(this->ProgressRange[1]);
+
+  size_t written = 0;
+  for (size_t i = 0; i < pending.size(); ++i)
+    {
+    if (pending[i].ErrorCode != vtkErrorCode::OutOfDiskSpaceError)
+      {
+      ++written;
+      continue;
+      }
+    this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+    vtkErrorMacro("Ran out of disk space; deleting file: "
+                  << this->Internal->Writers[pending[i].WriterIndex]
+                     ->GetFileName());
+    vtkXMLDataElement* element = pending[i].Element;
+    if (element && element->GetParent())
+      {
+      element->GetParent()->RemoveNestedElement(element);
+      }
+    }
+  pending.clear();
+  return written > 0;
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLCompositeDataWriter::WriteData()
 {
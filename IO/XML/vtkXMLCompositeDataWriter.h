@@ -55,6 +55,19 @@ public:
   vtkGetMacro(WriteMetaFile, int);
   virtual void SetWriteMetaFile(int flag);
 
+  // Description:
+  // When on, the files of the leaf datasets are written in parallel with
+  // vtkSMPTools once the whole meta-file structure is known, each by the
+  // writer of its leaf, so that the number of files written at a time is
+  // bounded by the number of SMP threads.  Leaves that share their dataset,
+  // or any of its arrays, with another leaf are written one at a time
+  // afterwards.  The writers share the compressor, as the blocks of
+  // CompressInParallel do, and report progress only as a whole.  Off by
+  // default.
+  vtkSetMacro(WriteBlocksInParallel, int);
+  vtkGetMacro(WriteBlocksInParallel, int);
+  vtkBooleanMacro(WriteBlocksInParallel, int);
+
   // Description:
   // See the vtkAlgorithm for a desciption of what these do
   int ProcessRequest(vtkInformation*,
@@ -137,6 +150,14 @@ protected:
   // if the file structured does not change but the data does.
   int WriteMetaFile;
 
+  int WriteBlocksInParallel;
+
+  // Description:
+  // Write the files of the leaves that WriteNonCompositeData() put off when
+  // WriteBlocksInParallel is on.  The leaves that ran out of disk space are
+  // removed from the meta-file.  Returns 0 if none of them was written.
+  int WritePendingLeaves();
+
   // Callback registered with the ProgressObserver.
   static void ProgressCallbackFunction(vtkObject*, unsigned long, void*,
                                        void*);
@@ -15,11 +15,13 @@
 #include "vtkXMLDataReader.h"
 
 #include "vtkArrayIteratorIncludes.h"
+#include "vtkByteSwap.h"
 #include "vtkCallbackCommand.h"
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDataSet.h"
+#include "vtkFileMappedDataArrayAllocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkPointData.h"
@@ -30,6 +32,13 @@
 
 
 #include <cassert>
+#include <map>
+
+//----------------------------------------------------------------------------
+class vtkXMLDataReaderMappedArrays
+  : public std::map<vtkAbstractArray*, vtkXMLDataElement*>
+{
+};
 
 
 //----------------------------------------------------------------------------
@@ -53,6 +62,8 @@ vtkXMLDataReader::vtkXMLDataReader()
   this->PointDataOffset = NULL;
   this->CellDataTimeStep = NULL;
   this->CellDataOffset = NULL;
+
+  this->MappedArrays = new vtkXMLDataReaderMappedArrays;
 }
 
 //----------------------------------------------------------------------------
@@ -77,6 +88,7 @@ vtkXMLDataReader::~vtkXMLDataReader()
     delete[] this->CellDataTimeStep;
     delete[] this->CellDataOffset;
     }
+  delete this->MappedArrays;
 }
 
 //----------------------------------------------------------------------------
@@ -258,6 +270,7 @@ void vtkXMLDataReader::DestroyPieces()
 void vtkXMLDataReader::SetupOutputData()
 {
   this->Superclass::SetupOutputData();
+  this->MappedArrays->clear();
 
   vtkDataSet* output = vtkDataSet::SafeDownCast(this->GetCurrentOutput());
   vtkPointData* pointData = output->GetPointData();
@@ -271,6 +284,14 @@ void vtkXMLDataReader::SetupOutputData()
   // from one piece because all pieces have the same set of arrays.
   vtkXMLDataElement* ePointData = this->PointDataElements[0];
   vtkXMLDataElement* eCellData = this->CellDataElements[0];
+
+  // The elements of the arrays that may be mapped from the file.
+  int mappedPiece = this->GetMappedPiece();
+  vtkXMLDataElement* eMappedPointData =
+    (mappedPiece >= 0 ? this->PointDataElements[mappedPiece] : 0);
+  vtkXMLDataElement* eMappedCellData =
+    (mappedPiece >= 0 ? this->CellDataElements[mappedPiece] : 0);
+
   this->NumberOfPointArrays = 0;
   if (ePointData)
     {
@@ -288,7 +309,9 @@ void vtkXMLDataReader::SetupOutputData()
         vtkAbstractArray* array = this->CreateArray(eNested);
         if (array)
           {
-          array->SetNumberOfTuples(pointTuples);
+          this->SetupOutputArray(
+            eMappedPointData ? eMappedPointData->GetNestedElement(i) : 0,
+            array, pointTuples);
           pointData->AddArray(array);
           array->Delete();
           }
@@ -318,7 +341,9 @@ void vtkXMLDataReader::SetupOutputData()
         vtkAbstractArray* array = this->CreateArray(eNested);
         if (array)
           {
-          array->SetNumberOfTuples(cellTuples);
+          this->SetupOutputArray(
+            eMappedCellData ? eMappedCellData->GetNestedElement(i) : 0,
+            array, cellTuples);
           cellData->AddArray(array);
           array->Delete();
           }
@@ -733,19 +758,37 @@ int vtkXMLDataReader::ReadArrayValues(
     }
   this->InReadData = 1;
   int result;
-  // All arrays types except vtkBitArray.
-  vtkArrayIterator* iter = array->NewIterator();
-  switch (array->GetDataType())
+  vtkXMLDataReaderMappedArrays::iterator mapped =
+    this->MappedArrays->find(array);
+  if (mapped != this->MappedArrays->end() && mapped->second == da &&
+      arrayIndex == startIndex)
     {
-    vtkArrayIteratorTemplateMacro(
-      result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-        arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-  default:
-    result = 0;
+    // SetupOutputArray mapped the values to their place in the array.
+    result = 1;
     }
-  if (iter)
+  else if (this->MemoryMapping && arrayIndex == 0 && startIndex == 0 &&
+           numValues == array->GetNumberOfTuples() *
+           array->GetNumberOfComponents() &&
+           this->MapArrayValues(da, array, numValues))
     {
-    iter->Delete();
+    result = 1;
+    }
+  else
+    {
+    // All arrays types except vtkBitArray.
+    vtkArrayIterator* iter = array->NewIterator();
+    switch (array->GetDataType())
+      {
+      vtkArrayIteratorTemplateMacro(
+        result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
+          arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
+    default:
+      result = 0;
+      }
+    if (iter)
+      {
+      iter->Delete();
+      }
     }
 
   this->ConvertGhostLevelsToGhostType(fieldType, array, startIndex, numValues);
@@ -761,6 +804,70 @@ int vtkXMLDataReader::ReadArrayValues(
   return result;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLDataReader::MapArrayValues(vtkXMLDataElement* da,
+                                     vtkAbstractArray* array,
+                                     vtkIdType numValues)
+{
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  const char* fileName = this->GetStreamFileName();
+  vtkTypeInt64 offset = 0;
+  if (!dataArray || !fileName || dataArray->GetDataType() == VTK_BIT ||
+      numValues < 1 || numValues % dataArray->GetNumberOfComponents() != 0 ||
+      !da->GetScalarAttribute("offset", offset))
+    {
+    return 0;
+    }
+
+  // The values must be stored raw and aligned in the file.
+  vtkTypeInt64 position;
+  int swap;
+  const int wordSize = dataArray->GetDataTypeSize();
+  if (!this->XMLParser->FindRawAppendedData(offset,
+        static_cast<size_t>(numValues), dataArray->GetDataType(),
+        position, swap) || position % wordSize != 0)
+    {
+    return 0;
+    }
+
+  vtkFileMappedDataArrayAllocator* allocator =
+    vtkFileMappedDataArrayAllocator::New();
+  void* ptr = allocator->MapFile(fileName, position,
+    static_cast<size_t>(numValues) * wordSize,
+    vtkFileMappedDataArrayAllocator::COPY_ON_WRITE);
+  int result = ptr &&
+    dataArray->SetAllocatedVoidArray(ptr, numValues, allocator);
+  allocator->Delete();
+  if (result && swap)
+    {
+    vtkByteSwap::SwapVoidRange(ptr, static_cast<size_t>(numValues),
+                               static_cast<size_t>(wordSize));
+    }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLDataReader::SetupOutputArray(vtkXMLDataElement* da,
+                                        vtkAbstractArray* array,
+                                        vtkIdType numTuples)
+{
+  // Arrays of time steps are mapped when the values of a step are read.
+  if (this->MemoryMapping && da && !this->TimeSteps &&
+      this->MapArrayValues(da, array,
+                           numTuples * array->GetNumberOfComponents()))
+    {
+    (*this->MappedArrays)[array] = da;
+    return;
+    }
+  array->SetNumberOfTuples(numTuples);
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLDataReader::GetMappedPiece()
+{
+  return (this->NumberOfPieces == 1 ? 0 : -1);
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLDataReader::DataProgressCallbackFunction(vtkObject*, unsigned long,
                                                     void* clientdata, void*)
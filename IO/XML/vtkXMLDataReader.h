@@ -27,6 +27,8 @@
 #include "vtkIOXMLModule.h" // For export macro
 #include "vtkXMLReader.h"
 
+class vtkXMLDataReaderMappedArrays;
+
 class VTKIOXML_EXPORT vtkXMLDataReader : public vtkXMLReader
 {
 public:
@@ -93,6 +95,22 @@ protected:
     vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
     vtkIdType startIndex, vtkIdType numValues, FieldType type = OTHER);
 
+  // Replace the values of the whole array by a mapping of the file, see
+  // MemoryMapping. Returns 0 if the values must be read instead.
+  int MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array,
+                     vtkIdType numValues);
+
+  // Give an output array numTuples tuples.  With MemoryMapping, an array
+  // that is read whole from the piece returned by GetMappedPiece() is
+  // mapped from da right away instead of being allocated, and its values
+  // are not read again by ReadArrayValues.
+  void SetupOutputArray(vtkXMLDataElement* da, vtkAbstractArray* array,
+                        vtkIdType numTuples);
+
+  // Return the piece whose arrays are read whole into the output arrays,
+  // or -1 if the output arrays gather several pieces.
+  virtual int GetMappedPiece();
+
 
 
   // Callback registered with the DataProgressObserver.
@@ -134,6 +152,9 @@ protected:
   vtkTypeInt64 *CellDataOffset;
   int CellDataNeedToReadTimeStep(vtkXMLDataElement *eNested);
 
+  // The output arrays mapped by SetupOutputArray, and their elements.
+  vtkXMLDataReaderMappedArrays* MappedArrays;
+
 private:
   vtkXMLDataReader(const vtkXMLDataReader&);  // Not implemented.
   void operator=(const vtkXMLDataReader&);  // Not implemented.
@@ -25,6 +25,7 @@
 #include "vtkXMLDataParser.h"
 #include "vtkXMLFileReadTester.h"
 #include "vtkXMLReaderVersion.h"
+#include "vtkLZ4DataCompressor.h"
 #include "vtkZLibDataCompressor.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -90,6 +91,8 @@ vtkXMLReader::vtkXMLReader()
   this->FileStream = 0;
   this->StringStream = 0;
   this->ReadFromInputString = 0;
+  this->MemoryMapping = 0;
+  this->UncompressInParallel = 0;
   this->InputString = "";
   this->XMLParser = 0;
   this->ReaderErrorObserver = 0;
@@ -178,6 +181,10 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "Stream: (none)\n";
     }
+  os << indent << "MemoryMapping: "
+     << (this->MemoryMapping ? "On" : "Off") << "\n";
+  os << indent << "UncompressInParallel: "
+     << (this->UncompressInParallel ? "On" : "Off") << "\n";
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << ","
@@ -364,6 +371,7 @@ void vtkXMLReader::CreateXMLParser()
     this->DestroyXMLParser();
     }
   this->XMLParser = vtkXMLDataParser::New();
+  this->XMLParser->SetUncompressInParallel(this->UncompressInParallel);
 }
 
 //----------------------------------------------------------------------------
@@ -390,12 +398,16 @@ void vtkXMLReader::SetupCompressor(const char* type)
   vtkObject* object = vtkInstantiator::CreateInstance(type);
   vtkDataCompressor* compressor = vtkDataCompressor::SafeDownCast(object);
 
-  // In static builds, the vtkZLibDataCompressor may not have been
-  // registered with the vtkInstantiator.  Check for it here.
+  // In static builds, the compressors of vtkIOCore may not have been
+  // registered with the vtkInstantiator.  Check for them here.
   if (!compressor && (strcmp(type, "vtkZLibDataCompressor") == 0))
     {
     compressor = vtkZLibDataCompressor::New();
     }
+  else if (!compressor && (strcmp(type, "vtkLZ4DataCompressor") == 0))
+    {
+    compressor = vtkLZ4DataCompressor::New();
+    }
 
   if (!compressor)
     {
@@ -55,6 +55,26 @@ public:
   vtkBooleanMacro(ReadFromInputString,int);
   void SetInputString(std::string s) { this->InputString = s; }
 
+  // Description:
+  // When on, uncompressed arrays stored in raw appended data are mapped
+  // from the file instead of being copied, so that their pages are only
+  // loaded when accessed. The arrays of an output read from a single piece
+  // are mapped as the output is set up, and are never allocated in memory.
+  // Arrays that cannot be mapped, because they are not aligned in the file
+  // for instance, are read as usual. The mapping is copy on write: the file
+  // is never modified. Off by default.
+  vtkSetMacro(MemoryMapping,int);
+  vtkGetMacro(MemoryMapping,int);
+  vtkBooleanMacro(MemoryMapping,int);
+
+  // Description:
+  // When on, the blocks of compressed arrays are uncompressed several at
+  // a time in parallel.  See vtkXMLDataParser::SetUncompressInParallel.
+  // Off by default.
+  vtkSetMacro(UncompressInParallel,int);
+  vtkGetMacro(UncompressInParallel,int);
+  vtkBooleanMacro(UncompressInParallel,int);
+
   // Description:
   // Test whether the file (type) with the given name can be read by this
   // reader. If the file has a newer version than the reader, we still say
@@ -249,6 +269,20 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether arrays are mapped from the input file when possible.
+  int MemoryMapping;
+
+  // Whether the blocks of compressed arrays are uncompressed in parallel.
+  int UncompressInParallel;
+
+  // Return the name of the file read by the stream, or NULL if the input
+  // is a string or a stream provided by the user.
+  const char* GetStreamFileName()
+    {
+    return (this->FileStream && this->Stream == this->FileStream) ?
+      this->FileName : 0;
+    }
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
@@ -340,6 +340,25 @@ void vtkXMLStructuredDataReader::ReadXMLData()
   this->SetOutputExtent(this->UpdateExtent);
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLStructuredDataReader::GetMappedPiece()
+{
+  // The arrays of the piece are the output arrays when the update extent
+  // is the extent of the only piece.
+  if (this->NumberOfPieces != 1)
+    {
+    return -1;
+    }
+  for (int i = 0; i < 6; ++i)
+    {
+    if (this->PieceExtents[i] != this->UpdateExtent[i])
+      {
+      return -1;
+      }
+    }
+  return 0;
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLStructuredDataReader::ReadArrayForPoints(vtkXMLDataElement* da,
                                                    vtkAbstractArray* outArray)
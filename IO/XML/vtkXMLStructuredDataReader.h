@@ -94,6 +94,7 @@ protected:
 
   // Override methods from superclass.
   void SetupEmptyOutput();
+  int GetMappedPiece();
   void SetupPieces(int numPieces);
   void DestroyPieces();
   virtual int ReadArrayForPoints(vtkXMLDataElement* da,
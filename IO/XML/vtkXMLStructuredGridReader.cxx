@@ -136,8 +136,10 @@ void vtkXMLStructuredGridReader::SetupOutputData()
     vtkDataArray* a = vtkDataArray::SafeDownCast(aa);
     if (a)
       {
-      // Allocate the points array.
-      a->SetNumberOfTuples( this->GetNumberOfPoints() );
+      // Allocate the points array, or map it from the only piece.
+      vtkXMLDataElement* eMappedPoints =
+        (this->GetMappedPiece() == 0 ? ePoints->GetNestedElement(0) : 0);
+      this->SetupOutputArray(eMappedPoints, a, this->GetNumberOfPoints());
       points->SetData(a);
       a->Delete();
       }
@@ -464,6 +464,18 @@ void vtkXMLUniformGridAMRReader::ReadComposite(vtkXMLDataElement* element,
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLUniformGridAMRReader::PreloadDatasets(vtkXMLDataElement* element,
+  const char* filePath, unsigned int dataSetIndex)
+{
+  vtkInformation* outinfo = this->GetCurrentOutputInformation();
+  if (outinfo->Has(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS()) ||
+      this->MaximumLevelsToReadByDefault == 0)
+    {
+    this->Superclass::PreloadDatasets(element, filePath, dataSetIndex);
+    }
+}
+
 //----------------------------------------------------------------------------
 vtkDataSet* vtkXMLUniformGridAMRReader::ReadDataset(
   vtkXMLDataElement* xmlElem, const char* filePath)
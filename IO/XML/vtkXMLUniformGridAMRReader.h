@@ -104,6 +104,12 @@ protected:
   // Read the vtkDataSet (a leaf) in the composite dataset.
   virtual vtkDataSet* ReadDataset(vtkXMLDataElement* xmlElem, const char* filePath);
 
+  // Preload the leaves only when all the selected leaves are read, that is
+  // unless MaximumLevelsToReadByDefault limits the levels read.
+  virtual void PreloadDatasets(vtkXMLDataElement* element,
+                               const char* filePath,
+                               unsigned int dataSetIndex);
+
   vtkSmartPointer<vtkOverlappingAMR> Metadata;
   unsigned int MaximumLevelsToReadByDefault;
 
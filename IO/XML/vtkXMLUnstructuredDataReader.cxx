@@ -383,8 +383,13 @@ void vtkXMLUnstructuredDataReader::SetupOutputData()
     vtkDataArray* a = vtkDataArray::SafeDownCast(aa);
     if (a)
       {
-      // Allocate the points array.
-      a->SetNumberOfTuples( this->GetNumberOfPoints() );
+      // Allocate the points array, or map it from the piece read.
+      int mappedPiece = this->GetMappedPiece();
+      vtkXMLDataElement* eMappedPoints =
+        (mappedPiece >= 0 ? this->PointElements[mappedPiece] : 0);
+      this->SetupOutputArray(
+        eMappedPoints ? eMappedPoints->GetNestedElement(0) : 0,
+        a, this->GetNumberOfPoints());
       points->SetData(a);
       a->Delete();
       }
@@ -402,6 +407,13 @@ void vtkXMLUnstructuredDataReader::SetupOutputData()
   points->Delete();
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLUnstructuredDataReader::GetMappedPiece()
+{
+  // The arrays of a single piece read are the output arrays.
+  return (this->EndPiece - this->StartPiece == 1 ? this->StartPiece : -1);
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLUnstructuredDataReader::ReadPiece(vtkXMLDataElement* ePiece)
 {
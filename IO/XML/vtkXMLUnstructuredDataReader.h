@@ -82,6 +82,7 @@ protected:
   void SetupOutputInformation(vtkInformation *outInfo);
 
   void SetupOutputData();
+  int GetMappedPiece();
   int ReadPiece(vtkXMLDataElement* ePiece);
   int ReadPieceData();
   int ReadCellArray(vtkIdType numberOfCells, vtkIdType totalNumberOfCells,
@@ -28,9 +28,11 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
+#include "vtkLZ4DataCompressor.h"
 #include "vtkZLibDataCompressor.h"
 #define vtkXMLOffsetsManager_DoNotInclude
 #include "vtkXMLOffsetsManager.h"
@@ -48,6 +50,7 @@
 
 #include <cassert>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 # include <unistd.h> /* unlink */
@@ -87,6 +90,47 @@ public:
    }
 };
 
+//*****************************************************************************
+// Copies of the blocks given to WriteCompressionBlock while compressing
+// in parallel, and the blocks once compressed.  The buffers are kept
+// from one batch to the next.
+class vtkXMLWriterCompressionBatch
+{
+public:
+  vtkXMLWriterCompressionBatch() : NumberOfBlocks(0) {}
+
+  std::vector<std::vector<unsigned char> > Blocks;
+  std::vector<std::vector<unsigned char> > CompressedBlocks;
+  std::vector<size_t> CompressedSizes;
+  size_t NumberOfBlocks;
+};
+
+//----------------------------------------------------------------------------
+// Compress each block of a batch into its own buffer.
+class vtkXMLWriterCompressFunctor
+{
+public:
+  vtkXMLWriterCompressFunctor(vtkDataCompressor* compressor,
+                              vtkXMLWriterCompressionBatch* batch)
+    : Compressor(compressor), Batch(batch) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const std::vector<unsigned char>& block = this->Batch->Blocks[i];
+      std::vector<unsigned char>& output = this->Batch->CompressedBlocks[i];
+      output.resize(this->Compressor->GetMaximumCompressionSpace(block.size()));
+      this->Batch->CompressedSizes[i] = this->Compressor->Compress(
+        &block[0], block.size(), &output[0], output.size());
+      }
+  }
+
+private:
+  vtkDataCompressor* Compressor;
+  vtkXMLWriterCompressionBatch* Batch;
+};
+
 //----------------------------------------------------------------------------
 // Specialize for cases where IterType is ValueType* (common case for
 // vtkDataArrayTemplate subclasses). The last arg is to help less-robust
@@ -316,6 +360,8 @@ vtkXMLWriter::vtkXMLWriter()
   this->BlockSize = 32768; //2^15
   this->Compressor = vtkZLibDataCompressor::New();
   this->CompressionHeader = 0;
+  this->CompressInParallel = 0;
+  this->CompressionBatch = new vtkXMLWriterCompressionBatch;
   this->Int32IdTypeBuffer = 0;
   this->ByteSwapBuffer = 0;
 
@@ -352,6 +398,7 @@ vtkXMLWriter::~vtkXMLWriter()
   this->OutStringStream = 0;
   delete this->FieldDataOM;
   delete[] this->NumberOfTimeValues;
+  delete this->CompressionBatch;
 }
 
 //----------------------------------------------------------------------------
@@ -379,6 +426,22 @@ void vtkXMLWriter::SetCompressorType(int compressorType)
     this->Modified();
     return;
     }
+
+  if (compressorType == LZ4)
+    {
+    if (this->Compressor && this->Compressor->IsTypeOf("vtkLZ4DataCompressor"))
+      {
+      return;
+      }
+    if (this->Compressor)
+      {
+      this->Compressor->Delete();
+      }
+
+    this->Compressor = vtkLZ4DataCompressor::New();
+    this->Modified();
+    return;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -425,6 +488,7 @@ void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
     }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "CompressInParallel: " << this->CompressInParallel << "\n";
   if (this->Stream)
     {
     os << indent << "Stream: " << this->Stream << "\n";
@@ -1128,6 +1192,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
       }
 
+    // Compress and write the blocks left in the parallel batch.
+    if (result && !this->WriteCompressionBatch())
+      {
+      result = 0;
+      }
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
       {
@@ -1444,6 +1514,7 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 
   // Initialize counter for block writing.
   this->CompressionBlockNumber = 0;
+  this->CompressionBatch->NumberOfBlocks = 0;
 
   return result;
 }
@@ -1451,6 +1522,24 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
+  if (this->CompressInParallel)
+    {
+    // Copy the block, whose buffer is reused for the next block, and
+    // compress the batch once it has a few blocks for each thread.
+    vtkXMLWriterCompressionBatch* batch = this->CompressionBatch;
+    if (batch->Blocks.size() == batch->NumberOfBlocks)
+      {
+      batch->Blocks.resize(batch->NumberOfBlocks + 1);
+      }
+    batch->Blocks[batch->NumberOfBlocks++].assign(data, data + size);
+    if (batch->NumberOfBlocks <
+        4 * static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads()))
+      {
+      return 1;
+      }
+    return this->WriteCompressionBatch();
+    }
+
   // Compress the data.
   vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
 
@@ -1474,6 +1563,52 @@ int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
   return result;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLWriter::WriteCompressionBatch()
+{
+  vtkXMLWriterCompressionBatch* batch = this->CompressionBatch;
+  size_t numBlocks = batch->NumberOfBlocks;
+  batch->NumberOfBlocks = 0;
+  if (numBlocks == 0)
+    {
+    return 1;
+    }
+
+  // Compress the blocks in parallel.
+  if (batch->CompressedBlocks.size() < numBlocks)
+    {
+    batch->CompressedBlocks.resize(numBlocks);
+    batch->CompressedSizes.resize(numBlocks);
+    }
+  vtkXMLWriterCompressFunctor functor(this->Compressor, batch);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1, functor);
+
+  // Write the compressed blocks in their order, and store their sizes
+  // in the compression header.
+  for (size_t i = 0; i < numBlocks; ++i)
+    {
+    size_t outputSize = batch->CompressedSizes[i];
+    if (outputSize == 0)
+      {
+      vtkErrorMacro("Error compressing block " << this->CompressionBlockNumber);
+      return 0;
+      }
+    if (!this->DataStream->Write(&batch->CompressedBlocks[i][0], outputSize))
+      {
+      return 0;
+      }
+    this->CompressionHeader->Set(3+this->CompressionBlockNumber++, outputSize);
+    }
+
+  this->Stream->flush();
+  if (this->Stream->fail())
+    {
+    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 0;
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionHeader()
 {
@@ -46,6 +46,7 @@ class vtkStdString;
 class OffsetsManager;      // one per piece/per time
 class OffsetsManagerGroup; // array of OffsetsManager
 class OffsetsManagerArray; // array of OffsetsManagerGroup
+class vtkXMLWriterCompressionBatch;
 //ETX
 
 class VTKIOXML_EXPORT vtkXMLWriter : public vtkAlgorithm
@@ -129,7 +130,8 @@ public:
   enum CompressorType
     {
     NONE,
-    ZLIB
+    ZLIB,
+    LZ4
     };
 //ETX
 
@@ -144,6 +146,10 @@ public:
     {
     this->SetCompressorType(ZLIB);
     }
+  void SetCompressorTypeToLZ4()
+    {
+    this->SetCompressorType(LZ4);
+    }
 
   // Description:
   // Get/Set the block size used in compression.  When reading, this
@@ -153,6 +159,16 @@ public:
   virtual void SetBlockSize(size_t blockSize);
   vtkGetMacro(BlockSize, size_t);
 
+  // Description:
+  // When on, binary and appended data are compressed several blocks at
+  // a time with vtkSMPTools, then written in their order, so that the
+  // file is the one written without this option.  The compressor must
+  // support concurrent calls of its Compress method, as
+  // vtkZLibDataCompressor and vtkLZ4DataCompressor do.  Off by default.
+  vtkSetMacro(CompressInParallel, int);
+  vtkGetMacro(CompressInParallel, int);
+  vtkBooleanMacro(CompressInParallel, int);
+
   // Description:
   // Get/Set the data mode used for the file's data.  The options are
   // vtkXMLWriter::Ascii, vtkXMLWriter::Binary, and
@@ -282,6 +298,10 @@ protected:
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
 
+  // The blocks waiting to be compressed in parallel.
+  int CompressInParallel;
+  vtkXMLWriterCompressionBatch* CompressionBatch;
+
   // The output stream used to write binary and appended data.  May
   // transparently encode the data.
   vtkOutputStream* DataStream;
@@ -413,6 +433,7 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int WriteCompressionBatch();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
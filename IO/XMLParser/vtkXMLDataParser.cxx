@@ -20,6 +20,7 @@
 #include "vtkDataCompressor.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
@@ -27,6 +28,7 @@
 
 #include <memory>
 #include <sstream>
+#include <vector>
 
 #include "vtkXMLUtilities.h"
 
@@ -50,6 +52,7 @@ vtkXMLDataParser::vtkXMLDataParser()
   this->BlockCompressedSizes = 0;
   this->BlockStartOffsets = 0;
   this->Compressor = 0;
+  this->UncompressInParallel = 0;
 
   this->AsciiDataBuffer = 0;
   this->AsciiDataBufferLength = 0;
@@ -105,6 +108,8 @@ void vtkXMLDataParser::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "Compressor: (none)\n";
     }
+  os << indent << "UncompressInParallel: "
+     << this->UncompressInParallel << "\n";
   os << indent << "Progress: " << this->Progress << "\n";
   os << indent << "Abort: " << this->Abort << "\n";
   os << indent << "AttributesEncoding: " << this->AttributesEncoding << "\n";
@@ -582,6 +587,80 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//----------------------------------------------------------------------------
+// Uncompress the consecutive blocks of a batch, each into its place in
+// the output buffer.
+class vtkXMLDataParserUncompressFunctor
+{
+public:
+  vtkXMLDataParserUncompressFunctor(vtkDataCompressor* compressor,
+                                    const unsigned char* compressedData,
+                                    const vtkTypeInt64* compressedOffsets,
+                                    const size_t* compressedSizes,
+                                    unsigned char* buffer, size_t blockSize,
+                                    std::vector<unsigned char>& results)
+    : Compressor(compressor), CompressedData(compressedData),
+      CompressedOffsets(compressedOffsets), CompressedSizes(compressedSizes),
+      Buffer(buffer), BlockSize(blockSize), Results(results) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Results[i] = this->Compressor->Uncompress(
+        this->CompressedData + (this->CompressedOffsets[i] -
+                                this->CompressedOffsets[0]),
+        this->CompressedSizes[i], this->Buffer + i*this->BlockSize,
+        this->BlockSize) > 0;
+      }
+  }
+
+private:
+  vtkDataCompressor* Compressor;
+  const unsigned char* CompressedData;
+  const vtkTypeInt64* CompressedOffsets;
+  const size_t* CompressedSizes;
+  unsigned char* Buffer;
+  size_t BlockSize;
+  std::vector<unsigned char>& Results;
+};
+
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::ReadBlocks(vtkTypeUInt64 firstBlock, size_t numBlocks,
+                                 unsigned char* buffer)
+{
+  // The blocks follow each other in the stream: read them at once.
+  const vtkTypeInt64* offsets = this->BlockStartOffsets + firstBlock;
+  const size_t* sizes = this->BlockCompressedSizes + firstBlock;
+  size_t compressedSize =
+    static_cast<size_t>(offsets[numBlocks-1] - offsets[0]) +
+    sizes[numBlocks-1];
+  if(!this->DataStream->Seek(offsets[0]))
+    {
+    return 0;
+    }
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if(this->DataStream->Read(&readBuffer[0], compressedSize) < compressedSize)
+    {
+    return 0;
+    }
+
+  // All the blocks but the last one of the data have the same size.
+  std::vector<unsigned char> results(numBlocks);
+  vtkXMLDataParserUncompressFunctor functor(
+    this->Compressor, &readBuffer[0], offsets, sizes, buffer,
+    this->FindBlockSize(firstBlock), results);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1, functor);
+  for(size_t i=0; i < numBlocks; ++i)
+    {
+    if(!results[i])
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(unsigned char* data,
                                               vtkTypeUInt64 startWord,
@@ -757,6 +836,27 @@ size_t vtkXMLDataParser::ReadCompressedData(unsigned char* data,
     this->UpdateProgress(float(outputPointer-data)/length);
 
     unsigned int currentBlock = firstBlock+1;
+    if(this->UncompressInParallel)
+      {
+      // Uncompress a few blocks for each thread at a time, so that the
+      // progress is still reported and the reading may be aborted.
+      size_t batchSize =
+        4 * static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+      while(currentBlock != lastBlock && !this->Abort)
+        {
+        size_t numBlocks = static_cast<size_t>(lastBlock - currentBlock);
+        numBlocks = (numBlocks < batchSize ? numBlocks : batchSize);
+        if(!this->ReadBlocks(currentBlock, numBlocks, outputPointer))
+          {
+          return 0;
+          }
+        this->PerformByteSwap(outputPointer, numBlocks*blockSize / wordSize,
+                              wordSize);
+        outputPointer += numBlocks*blockSize;
+        currentBlock += static_cast<unsigned int>(numBlocks);
+        this->UpdateProgress(float(outputPointer-data)/length);
+        }
+      }
     for(;currentBlock != lastBlock && !this->Abort; ++currentBlock)
       {
       // Read this block.
@@ -916,6 +1016,44 @@ size_t vtkXMLDataParser::ReadAppendedData(vtkTypeInt64 offset,
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::FindRawAppendedData(vtkTypeInt64 offset,
+                                          size_t numWords, int wordType,
+                                          vtkTypeInt64& position, int& swap)
+{
+  if(this->Compressor || !this->AppendedDataPosition ||
+     this->AppendedDataStream->IsA("vtkBase64InputStream"))
+    {
+    return 0;
+    }
+
+  // Read the length of the data from the header in front of it.
+  std::auto_ptr<vtkXMLDataHeader>
+    uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  istream* stream = this->GetStream();
+  this->SeekG(this->AppendedDataPosition+offset);
+  if(!stream->read(reinterpret_cast<char*>(uh->Data()), headerSize))
+    {
+    stream->clear();
+    return 0;
+    }
+  this->PerformByteSwap(uh->Data(), uh->WordCount(), uh->WordSize());
+  size_t wordSize = this->GetWordTypeSize(wordType);
+  if(uh->Get(0) < static_cast<vtkTypeUInt64>(numWords)*wordSize)
+    {
+    return 0;
+    }
+
+  position = this->AppendedDataPosition+offset+headerSize;
+#ifdef VTK_WORDS_BIGENDIAN
+  swap = (wordSize > 1 && this->ByteOrder != vtkXMLDataParser::BigEndian);
+#else
+  swap = (wordSize > 1 && this->ByteOrder == vtkXMLDataParser::BigEndian);
+#endif
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
@@ -73,6 +73,16 @@ public:
   { return this->ReadAppendedData(offset, buffer, startWord, numWords,
                                     VTK_CHAR); }
 
+  // Description:
+  // Locate numWords words of raw, uncompressed appended data starting at
+  // the given appended data offset, for a caller that accesses the file
+  // directly. On success the stream position of the first word is stored
+  // in position, swap is set if the bytes of the words must be swapped and
+  // 1 is returned. Returns 0 if the data are encoded, compressed or too
+  // short; ReadAppendedData() must be used then.
+  int FindRawAppendedData(vtkTypeInt64 offset, size_t numWords, int wordType,
+                          vtkTypeInt64& position, int& swap);
+
   // Description:
   // Read from an ascii data section starting at the current position in
   // the stream.  Returns the number of words read.
@@ -92,6 +102,15 @@ public:
   virtual void SetCompressor(vtkDataCompressor*);
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
 
+  // Description:
+  // When on, the compressed blocks of the data read are read from the
+  // stream a batch at a time, and the blocks of a batch are uncompressed
+  // in parallel with vtkSMPTools.  The compressor must support
+  // concurrent calls of its Uncompress method.  Off by default.
+  vtkSetMacro(UncompressInParallel, int);
+  vtkGetMacro(UncompressInParallel, int);
+  vtkBooleanMacro(UncompressInParallel, int);
+
   // Description:
   // Get the size of a word of the given type.
   size_t GetWordTypeSize(int wordType);
@@ -166,6 +185,8 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadBlocks(vtkTypeUInt64 firstBlock, size_t numBlocks,
+                 unsigned char* buffer);
   size_t ReadUncompressedData(unsigned char* data,
                               vtkTypeUInt64 startWord,
                               size_t numWords,
@@ -223,6 +244,7 @@ protected:
   size_t PartialLastBlockUncompressedSize;
   size_t* BlockCompressedSizes;
   vtkTypeInt64* BlockStartOffsets;
+  int UncompressInParallel;
 
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;
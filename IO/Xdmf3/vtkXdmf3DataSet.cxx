@@ -23,12 +23,14 @@
 #include "vtkDataObject.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkExtractSelection.h"
 #include "vtkMergePoints.h"
 #include "vtkMutableDirectedGraph.h"
 #include "vtkOutEdgeIterator.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSelection.h"
@@ -49,6 +51,7 @@
 #include "XdmfGeometry.hpp"
 #include "XdmfGeometryType.hpp"
 #include "XdmfGraph.hpp"
+#include "XdmfHDF5Controller.hpp"
 #include "XdmfRectilinearGrid.hpp"
 #include "XdmfRegularGrid.hpp"
 #include "XdmfSet.hpp"
@@ -58,6 +61,9 @@
 #include "XdmfTopology.hpp"
 #include "XdmfTopologyType.hpp"
 
+#include <algorithm>
+#include <vector>
+
 //==============================================================================
 bool vtkXdmf3DataSet_ReadIfNeeded(XdmfArray *array, bool dbg=false)
 {
@@ -86,6 +92,309 @@ void vtkXdmf3DataSet_ReleaseIfNeeded(XdmfArray *array, bool MyInit,
     }
 }
 
+//==============================================================================
+// Number of values of an extent.
+vtkIdType vtkXdmf3DataSet_ExtentSize(const int *extent)
+{
+  if (extent[1] < extent[0] || extent[3] < extent[2] || extent[5] < extent[4])
+    {
+    return 0;
+    }
+  return static_cast<vtkIdType>(extent[1] - extent[0] + 1) *
+    (extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1);
+}
+
+//==============================================================================
+// Returns the values of the array of the whole extent extents[0-5] in the
+// part extents[6-11]. When the array is stored in a HDF5 data set with
+// one dimension for each axis of more than one value, k first, and an
+// optional last one for the components, or flat along the only such axis,
+// the part is read as a hyperslab. Otherwise the whole array is read and
+// the part copied out of it.
+vtkDataArray *vtkXdmf3DataSet_ReadPart(XdmfArray *xArray,
+                                       const std::string &name,
+                                       unsigned int ncomp,
+                                       const int *extents,
+                                       vtkXdmf3ArrayKeeper *keeper)
+{
+  const int *whole = extents;
+  const int *part = extents + 6;
+  unsigned int wdims[3];
+  for (int i = 0; i < 3; ++i)
+    {
+    wdims[i] = static_cast<unsigned int>(whole[2*i+1] - whole[2*i] + 1);
+    }
+
+  shared_ptr<XdmfHDF5Controller> controller =
+    shared_dynamic_cast<XdmfHDF5Controller>(xArray->getHeavyDataController());
+  if (controller && !xArray->isInitialized())
+    {
+    std::vector<unsigned int> dims = controller->getDimensions();
+    std::vector<unsigned int> start = controller->getStart();
+    std::vector<unsigned int> stride = controller->getStride();
+    std::vector<int> axes;
+    for (int i = 2; i >= 0; --i)
+      {
+      if (wdims[i] > 1)
+        {
+        axes.push_back(i);
+        }
+      }
+    // number of components folded into the only axis of a flat array
+    unsigned int flat = 1;
+    bool slab = !axes.empty() &&
+      controller->getDataspaceDimensions().size() == dims.size();
+    if (slab && dims.size() == axes.size() + 1)
+      {
+      slab = dims.back() == ncomp;
+      }
+    else if (slab && dims.size() == axes.size() && ncomp > 1)
+      {
+      flat = ncomp;
+      slab = axes.size() == 1 && stride[0] == 1;
+      }
+    else if (slab)
+      {
+      slab = dims.size() == axes.size();
+      }
+    for (size_t a = 0; slab && a < axes.size(); ++a)
+      {
+      slab = dims[a] == wdims[axes[a]] * flat;
+      }
+    if (slab)
+      {
+      for (size_t a = 0; a < axes.size(); ++a)
+        {
+        int i = axes[a];
+        start[a] += static_cast<unsigned int>(part[2*i] - whole[2*i]) *
+          flat * stride[a];
+        dims[a] = static_cast<unsigned int>(part[2*i+1] - part[2*i] + 1) *
+          flat;
+        }
+      shared_ptr<XdmfArray> xPart = XdmfArray::New();
+      xPart->setHeavyDataController(XdmfHDF5Controller::New(
+        controller->getFilePath(), controller->getDataSetPath(),
+        controller->getType(), start, stride, dims,
+        controller->getDataspaceDimensions()));
+      xPart->read();
+      vtkDataArray *values =
+        vtkXdmf3DataSet::XdmfToVTKArray(xPart.get(), name, ncomp);
+      if (!values)
+        {
+        return NULL;
+        }
+      // values points into xPart, which goes away on return
+      vtkDataArray *copy = values->NewInstance();
+      copy->DeepCopy(values);
+      copy->SetName(name.c_str());
+      values->Delete();
+      return copy;
+      }
+    }
+
+  vtkDataArray *array =
+    vtkXdmf3DataSet::XdmfToVTKArray(xArray, name, ncomp, keeper);
+  if (!array)
+    {
+    return NULL;
+    }
+  if (array->GetNumberOfTuples() != vtkXdmf3DataSet_ExtentSize(whole))
+    {
+    cerr << "Skipping " << name << ", whose size does not match the grid"
+         << endl;
+    array->Delete();
+    return NULL;
+    }
+  vtkDataArray *copy = array->NewInstance();
+  copy->SetName(name.c_str());
+  copy->SetNumberOfComponents(array->GetNumberOfComponents());
+  copy->SetNumberOfTuples(vtkXdmf3DataSet_ExtentSize(part));
+  vtkIdType id = 0;
+  for (int k = part[4]; k <= part[5]; ++k)
+    {
+    for (int j = part[2]; j <= part[3]; ++j)
+      {
+      vtkIdType row = (static_cast<vtkIdType>(k - whole[4]) * wdims[1] +
+                       (j - whole[2])) * wdims[0] - whole[0];
+      for (int i = part[0]; i <= part[1]; ++i)
+        {
+        copy->SetTuple(id++, row + i, array);
+        }
+      }
+    }
+  array->Delete();
+  return copy;
+}
+
+//==============================================================================
+// Clips updateExtent to whole and sets extents to whole followed by the
+// clipped extent. Returns false if there is no update extent or if it
+// covers all of whole, so that the whole grid is read.
+bool vtkXdmf3DataSet_PartOf(const int *whole, const int *updateExtent,
+                            int *extents)
+{
+  if (!updateExtent)
+    {
+    return false;
+    }
+  bool part = false;
+  for (int i = 0; i < 3; ++i)
+    {
+    extents[2*i] = whole[2*i];
+    extents[2*i+1] = whole[2*i+1];
+    extents[6+2*i] = std::max(updateExtent[2*i], whole[2*i]);
+    extents[6+2*i+1] = std::min(updateExtent[2*i+1], whole[2*i+1]);
+    part = part || extents[6+2*i] != whole[2*i] ||
+      extents[6+2*i+1] != whole[2*i+1];
+    }
+  return part;
+}
+
+//==============================================================================
+// Reads the attributes of the part of a structured grid given by the point
+// extents, see vtkXdmf3DataSet_PartOf. The cell arrays are skipped when the
+// part is flat along an axis along which the whole extent is not.
+void vtkXdmf3DataSet_PartAttributes(vtkXdmf3ArraySelection *fselection,
+                                    vtkXdmf3ArraySelection *cselection,
+                                    vtkXdmf3ArraySelection *pselection,
+                                    XdmfGrid *grid, vtkDataSet *dataSet,
+                                    vtkXdmf3ArrayKeeper *keeper,
+                                    const int *pointExtents)
+{
+  int cellExtents[12];
+  bool cells = true;
+  for (int i = 0; i < 3; ++i)
+    {
+    cellExtents[2*i] = pointExtents[2*i];
+    cellExtents[2*i+1] = pointExtents[2*i+1];
+    cellExtents[6+2*i] = pointExtents[6+2*i];
+    cellExtents[6+2*i+1] = pointExtents[6+2*i+1];
+    if (pointExtents[2*i+1] > pointExtents[2*i])
+      {
+      cellExtents[2*i+1]--;
+      cellExtents[6+2*i+1]--;
+      cells = cells && cellExtents[6+2*i+1] >= cellExtents[6+2*i];
+      }
+    }
+  vtkXdmf3DataSet::XdmfToVTKAttributes(fselection, cselection, pselection,
+                                       grid, dataSet, keeper, pointExtents,
+                                       cells ? cellExtents : NULL);
+}
+
+//==============================================================================
+// Returns xy points with a third component of zero.
+vtkDataArray *vtkXdmf3DataSet_XYToXYZ(vtkDataArray *vPoints)
+{
+  vtkDataArray *vPoints3 = vPoints->NewInstance();
+  vPoints3->SetNumberOfComponents(3);
+  vPoints3->SetNumberOfTuples(vPoints->GetNumberOfTuples());
+  vPoints3->SetName("");
+  vPoints3->CopyComponent(0, vPoints, 0);
+  vPoints3->CopyComponent(1, vPoints, 1);
+  vPoints3->FillComponent(2, 0.0);
+  vPoints->Delete();
+  return vPoints3;
+}
+
+//==============================================================================
+// Reads the cells of one of npieces contiguous ranges of cells, and the
+// range of points they use, renumbered from zero. Sets pointExtents and
+// cellExtents to the ranges for XdmfToVTKAttributes. Returns false if the
+// grid does not have a single cell type stored in HDF5, which is then read
+// whole.
+bool vtkXdmf3DataSet_CopyPieceShape(XdmfUnstructuredGrid *grid,
+                                    vtkUnstructuredGrid *dataSet,
+                                    unsigned int piece, unsigned int npieces,
+                                    int *pointExtents, int *cellExtents,
+                                    vtkXdmf3ArrayKeeper *keeper)
+{
+  shared_ptr<XdmfTopology> xTopology = grid->getTopology();
+  shared_ptr<const XdmfTopologyType> xCellType = xTopology->getType();
+  shared_ptr<XdmfGeometry> geom = grid->getGeometry();
+  int vCellType = vtkXdmf3DataSet::GetVTKCellType(xCellType);
+  unsigned int numPointsPerCell = xCellType->getNodesPerElement();
+  bool xy = geom->getType() == XdmfGeometryType::XY();
+  if (vCellType == VTK_EMPTY_CELL ||
+      xCellType == XdmfTopologyType::Mixed() || numPointsPerCell == 0 ||
+      (!xy && geom->getType() != XdmfGeometryType::XYZ()) ||
+      !shared_dynamic_cast<XdmfHDF5Controller>(
+        xTopology->getHeavyDataController()))
+    {
+    return false;
+    }
+
+  vtkTypeInt64 numCells = xTopology->getNumberElements();
+  int firstCell = static_cast<int>(piece * numCells / npieces);
+  int endCell = static_cast<int>((piece + 1) * numCells / npieces);
+  int extents[12] = { 0, static_cast<int>(numCells) - 1, 0, 0, 0, 0,
+                      firstCell, endCell - 1, 0, 0, 0, 0 };
+  std::copy(extents, extents + 12, cellExtents);
+  extents[1] = static_cast<int>(geom->getNumberPoints()) - 1;
+  extents[6] = 0;
+  extents[7] = -1;
+
+  vtkCellArray *vCells = vtkCellArray::New();
+  vtkIdTypeArray *ids = vtkIdTypeArray::New();
+  if (endCell > firstCell)
+    {
+    vtkDataArray *topology = vtkXdmf3DataSet_ReadPart(
+      xTopology.get(), "", numPointsPerCell, cellExtents, keeper);
+    if (!topology)
+      {
+      vCells->Delete();
+      ids->Delete();
+      return false;
+      }
+    ids->DeepCopy(topology);
+    topology->Delete();
+    }
+
+  // xmfConnections: p1 p2 ... pN for each cell
+  vtkIdType numPieceCells = ids->GetNumberOfTuples();
+  vtkIdType *conn = ids->GetPointer(0);
+  vtkIdType numIds = numPieceCells * numPointsPerCell;
+  if (numIds > 0)
+    {
+    vtkIdType minId = *std::min_element(conn, conn + numIds);
+    vtkIdType maxId = *std::max_element(conn, conn + numIds);
+    extents[6] = static_cast<int>(minId);
+    extents[7] = static_cast<int>(maxId);
+    vtkIdType* cells_ptr = vCells->WritePointer(
+      numPieceCells, numPieceCells * (1 + numPointsPerCell));
+    for (vtkIdType cc = 0; cc < numPieceCells; cc++)
+      {
+      *cells_ptr++ = numPointsPerCell;
+      for (vtkIdType i = 0; i < static_cast<vtkIdType>(numPointsPerCell); i++)
+        {
+        *cells_ptr++ = *conn++ - minId;
+        }
+      }
+    }
+  ids->Delete();
+  dataSet->SetCells(vCellType, vCells);
+  vCells->Delete();
+  std::copy(extents, extents + 12, pointExtents);
+
+  vtkPoints *p = vtkPoints::New();
+  if (extents[7] >= extents[6])
+    {
+    vtkDataArray *vPoints =
+      vtkXdmf3DataSet_ReadPart(geom.get(), "", xy ? 2 : 3, extents, keeper);
+    if (vPoints && xy)
+      {
+      vPoints = vtkXdmf3DataSet_XYToXYZ(vPoints);
+      }
+    if (vPoints)
+      {
+      p->SetData(vPoints);
+      vPoints->Delete();
+      }
+    }
+  dataSet->SetPoints(p);
+  p->Delete();
+  return true;
+}
+
 //==============================================================================
 vtkDataArray *vtkXdmf3DataSet::XdmfToVTKArray(
   XdmfArray* xArray,
@@ -430,7 +739,8 @@ void vtkXdmf3DataSet::XdmfToVTKAttributes(
   vtkXdmf3ArraySelection *cselection,
   vtkXdmf3ArraySelection *pselection,
   XdmfGrid *grid, vtkDataObject *dObject,
-  vtkXdmf3ArrayKeeper *keeper)
+  vtkXdmf3ArrayKeeper *keeper,
+  const int *pointExtents, const int *cellExtents)
 {
   vtkDataSet *dataSet = vtkDataSet::SafeDownCast(dObject);
   if (!dataSet)
@@ -439,6 +749,14 @@ void vtkXdmf3DataSet::XdmfToVTKAttributes(
     }
   unsigned int numCells = dataSet->GetNumberOfCells();
   unsigned int numPoints = dataSet->GetNumberOfPoints();
+  // the arrays of a part hold the values of the whole grid
+  if (pointExtents)
+    {
+    numPoints = static_cast<unsigned int>(
+      vtkXdmf3DataSet_ExtentSize(pointExtents));
+    numCells = cellExtents ? static_cast<unsigned int>(
+      vtkXdmf3DataSet_ExtentSize(cellExtents)) : 0;
+    }
   unsigned int numAttributes = grid->getNumberAttributes();
   for (unsigned int cc=0; cc < numAttributes; cc++)
     {
@@ -535,8 +853,23 @@ void vtkXdmf3DataSet::XdmfToVTKAttributes(
       atype = GLOBALID;
       }
 
-    vtkDataArray *array = XdmfToVTKArray(xmfAttribute.get(), attrName,
-                                         ncomp, keeper);
+    const int *extents = NULL;
+    if (attrCenter == XdmfAttributeCenter::Cell())
+      {
+      extents = cellExtents;
+      }
+    else if (attrCenter == XdmfAttributeCenter::Node())
+      {
+      extents = pointExtents;
+      }
+    if (extents && vtkXdmf3DataSet_ExtentSize(extents + 6) == 0)
+      {
+      continue;
+      }
+    vtkDataArray *array = extents ?
+      vtkXdmf3DataSet_ReadPart(xmfAttribute.get(), attrName, ncomp, extents,
+                               keeper) :
+      XdmfToVTKArray(xmfAttribute.get(), attrName, ncomp, keeper);
     if (array)
       {
       fieldData->AddArray(array);
@@ -1009,9 +1342,19 @@ void vtkXdmf3DataSet::XdmfToVTK(
   vtkXdmf3ArraySelection *pselection,
   XdmfRegularGrid *grid,
   vtkImageData *dataSet,
-  vtkXdmf3ArrayKeeper *keeper)
+  vtkXdmf3ArrayKeeper *keeper,
+  const int *updateExtent)
 {
   vtkXdmf3DataSet::CopyShape(grid, dataSet, keeper);
+  int extents[12];
+  if (dataSet &&
+      vtkXdmf3DataSet_PartOf(dataSet->GetExtent(), updateExtent, extents))
+    {
+    dataSet->SetExtent(extents + 6);
+    vtkXdmf3DataSet_PartAttributes(fselection, cselection, pselection,
+                                   grid, dataSet, keeper, extents);
+    return;
+    }
   vtkXdmf3DataSet::XdmfToVTKAttributes(fselection, cselection, pselection,
                                        grid, dataSet, keeper);
 }
@@ -1127,9 +1470,52 @@ void vtkXdmf3DataSet::XdmfToVTK(
   vtkXdmf3ArraySelection *pselection,
   XdmfRectilinearGrid *grid,
   vtkRectilinearGrid *dataSet,
-  vtkXdmf3ArrayKeeper *keeper)
+  vtkXdmf3ArrayKeeper *keeper,
+  const int *updateExtent)
 {
   vtkXdmf3DataSet::CopyShape(grid, dataSet, keeper);
+  int extents[12];
+  if (dataSet &&
+      vtkXdmf3DataSet_PartOf(dataSet->GetExtent(), updateExtent, extents))
+    {
+    // the coordinates are small, keep those of the part
+    vtkDataArray *coords[3] = { dataSet->GetXCoordinates(),
+                                dataSet->GetYCoordinates(),
+                                dataSet->GetZCoordinates() };
+    for (int i = 0; i < 3; ++i)
+      {
+      if (coords[i] &&
+          coords[i]->GetNumberOfTuples() == extents[2*i+1] - extents[2*i] + 1)
+        {
+        vtkDataArray *part = coords[i]->NewInstance();
+        part->SetName(coords[i]->GetName());
+        part->SetNumberOfTuples(extents[6+2*i+1] - extents[6+2*i] + 1);
+        for (int j = extents[6+2*i]; j <= extents[6+2*i+1]; ++j)
+          {
+          part->SetTuple(j - extents[6+2*i], j - extents[2*i], coords[i]);
+          }
+        coords[i] = part;
+        }
+      else if (coords[i])
+        {
+        coords[i]->Register(NULL);
+        }
+      }
+    dataSet->SetExtent(extents + 6);
+    dataSet->SetXCoordinates(coords[0]);
+    dataSet->SetYCoordinates(coords[1]);
+    dataSet->SetZCoordinates(coords[2]);
+    for (int i = 0; i < 3; ++i)
+      {
+      if (coords[i])
+        {
+        coords[i]->Delete();
+        }
+      }
+    vtkXdmf3DataSet_PartAttributes(fselection, cselection, pselection,
+                                   grid, dataSet, keeper, extents);
+    return;
+    }
   vtkXdmf3DataSet::XdmfToVTKAttributes(fselection, cselection, pselection,
                                        grid, dataSet, keeper);
 }
@@ -1259,25 +1645,29 @@ void vtkXdmf3DataSet::XdmfToVTK(
   vtkXdmf3ArraySelection *pselection,
   XdmfCurvilinearGrid *grid,
   vtkStructuredGrid *dataSet,
-  vtkXdmf3ArrayKeeper *keeper)
+  vtkXdmf3ArrayKeeper *keeper,
+  const int *updateExtent)
 {
-  vtkXdmf3DataSet::CopyShape(grid, dataSet, keeper);
+  vtkXdmf3DataSet::CopyShape(grid, dataSet, keeper, updateExtent);
+  int whole_extent[6];
+  vtkXdmf3DataSet::GetWholeExtent(grid, whole_extent);
+  int extents[12];
+  if (dataSet &&
+      vtkXdmf3DataSet_PartOf(whole_extent, updateExtent, extents))
+    {
+    vtkXdmf3DataSet_PartAttributes(fselection, cselection, pselection,
+                                   grid, dataSet, keeper, extents);
+    return;
+    }
   vtkXdmf3DataSet::XdmfToVTKAttributes(fselection, cselection, pselection,
                                        grid, dataSet, keeper);
 }
 
 //--------------------------------------------------------------------------
-void vtkXdmf3DataSet::CopyShape(
+void vtkXdmf3DataSet::GetWholeExtent(
   XdmfCurvilinearGrid *grid,
-  vtkStructuredGrid *dataSet,
-  vtkXdmf3ArrayKeeper *keeper)
+  int whole_extent[6])
 {
-  if (!dataSet)
-    {
-    return;
-    }
-
-  int whole_extent[6];
   whole_extent[0] = 0;
   whole_extent[1] = -1;
   whole_extent[2] = 0;
@@ -1297,26 +1687,44 @@ void vtkXdmf3DataSet::CopyShape(
     {
     whole_extent[1] = whole_extent[0];
     }
-  dataSet->SetExtent(whole_extent);
+}
+
+//--------------------------------------------------------------------------
+void vtkXdmf3DataSet::CopyShape(
+  XdmfCurvilinearGrid *grid,
+  vtkStructuredGrid *dataSet,
+  vtkXdmf3ArrayKeeper *keeper,
+  const int *updateExtent)
+{
+  if (!dataSet)
+    {
+    return;
+    }
+
+  int whole_extent[6];
+  vtkXdmf3DataSet::GetWholeExtent(grid, whole_extent);
+  int extents[12];
+  bool part = vtkXdmf3DataSet_PartOf(whole_extent, updateExtent, extents);
+  dataSet->SetExtent(part ? extents + 6 : whole_extent);
 
   vtkDataArray *vPoints = NULL;
   shared_ptr<XdmfGeometry> geom = grid->getGeometry();
   if (geom->getType() == XdmfGeometryType::XY())
     {
-    vPoints = vtkXdmf3DataSet::XdmfToVTKArray(geom.get(), "", 2, keeper);
-    vtkDataArray *vPoints3 = vPoints->NewInstance();
-    vPoints3->SetNumberOfComponents(3);
-    vPoints3->SetNumberOfTuples(vPoints->GetNumberOfTuples());
-    vPoints3->SetName("");
-    vPoints3->CopyComponent(0, vPoints, 0);
-    vPoints3->CopyComponent(1, vPoints, 1);
-    vPoints3->FillComponent(2, 0.0);
-    vPoints->Delete();
-    vPoints = vPoints3;
+    vPoints = part ?
+      vtkXdmf3DataSet_ReadPart(geom.get(), "", 2, extents, keeper) :
+      vtkXdmf3DataSet::XdmfToVTKArray(geom.get(), "", 2, keeper);
+    if (!vPoints)
+      {
+      return;
+      }
+    vPoints = vtkXdmf3DataSet_XYToXYZ(vPoints);
     }
   else if (geom->getType() == XdmfGeometryType::XYZ())
     {
-    vPoints = vtkXdmf3DataSet::XdmfToVTKArray(geom.get(), "", 3, keeper);
+    vPoints = part ?
+      vtkXdmf3DataSet_ReadPart(geom.get(), "", 3, extents, keeper) :
+      vtkXdmf3DataSet::XdmfToVTKArray(geom.get(), "", 3, keeper);
     }
   else
     {
@@ -1390,8 +1798,20 @@ void vtkXdmf3DataSet::XdmfToVTK(
   vtkXdmf3ArraySelection *pselection,
   XdmfUnstructuredGrid *grid,
   vtkUnstructuredGrid *dataSet,
-  vtkXdmf3ArrayKeeper *keeper)
+  vtkXdmf3ArrayKeeper *keeper,
+  unsigned int piece, unsigned int npieces)
 {
+  int pointExtents[12];
+  int cellExtents[12];
+  if (npieces > 1 && dataSet &&
+      vtkXdmf3DataSet_CopyPieceShape(grid, dataSet, piece, npieces,
+                                     pointExtents, cellExtents, keeper))
+    {
+    vtkXdmf3DataSet::XdmfToVTKAttributes(fselection, cselection, pselection,
+                                         grid, dataSet, keeper,
+                                         pointExtents, cellExtents);
+    return;
+    }
   vtkXdmf3DataSet::CopyShape(grid, dataSet, keeper);
   vtkXdmf3DataSet::XdmfToVTKAttributes(fselection, cselection, pselection,
                                        grid, dataSet, keeper);
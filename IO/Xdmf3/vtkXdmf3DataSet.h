@@ -76,13 +76,19 @@ public:
 
   // Description:
   // Populates the given VTK DataObject's attribute arrays with the selected
-  // arrays from the Xdmf Grid
+  // arrays from the Xdmf Grid.
+  // When the data set holds only a part of the grid, pointExtents and
+  // cellExtents each give the whole extent of the point or cell arrays
+  // followed by the extent of the part, twelve values in all. The arrays
+  // of an unstructured grid are one dimensional extents along i. Only the
+  // part is read from the HDF5 heavy data when the layout allows it.
   static void XdmfToVTKAttributes(
     vtkXdmf3ArraySelection *fselection,
     vtkXdmf3ArraySelection *cselection,
     vtkXdmf3ArraySelection *pselection,
     XdmfGrid *grid, vtkDataObject *dObject,
-    vtkXdmf3ArrayKeeper *keeper=NULL);
+    vtkXdmf3ArrayKeeper *keeper=NULL,
+    const int *pointExtents=NULL, const int *cellExtents=NULL);
 
   // Description:
   // Populates the given Xdmf Grid's attribute arrays with the selected
@@ -103,14 +109,16 @@ public:
   //vtkXdmf3RegularGrid
 
   // Description:
-  // Populates the VTK data set with the contents of the Xdmf grid
+  // Populates the VTK data set with the contents of the Xdmf grid.
+  // When updateExtent is given, only that part of the whole extent is read.
   static void XdmfToVTK(
     vtkXdmf3ArraySelection *fselection,
     vtkXdmf3ArraySelection *cselection,
     vtkXdmf3ArraySelection *pselection,
     XdmfRegularGrid *grid,
     vtkImageData *dataSet,
-    vtkXdmf3ArrayKeeper *keeper=NULL);
+    vtkXdmf3ArrayKeeper *keeper=NULL,
+    const int *updateExtent=NULL);
 
   // Description:
   // Helper that does topology for XdmfToVTK
@@ -129,14 +137,16 @@ public:
 
   //vtkXdmf3RectilinearGrid
   // Description:
-  // Populates the VTK data set with the contents of the Xdmf grid
+  // Populates the VTK data set with the contents of the Xdmf grid.
+  // When updateExtent is given, only that part of the whole extent is read.
   static void XdmfToVTK(
     vtkXdmf3ArraySelection *fselection,
     vtkXdmf3ArraySelection *cselection,
     vtkXdmf3ArraySelection *pselection,
     XdmfRectilinearGrid *grid,
     vtkRectilinearGrid *dataSet,
-    vtkXdmf3ArrayKeeper *keeper=NULL);
+    vtkXdmf3ArrayKeeper *keeper=NULL,
+    const int *updateExtent=NULL);
 
   // Description:
   // Helper that does topology for XdmfToVTK
@@ -155,21 +165,29 @@ public:
 
   //vtkXdmf3CurvilinearGrid
   // Description:
-  // Populates the VTK data set with the contents of the Xdmf grid
+  // Populates the VTK data set with the contents of the Xdmf grid.
+  // When updateExtent is given, only that part of the whole extent is read.
   static void XdmfToVTK(
     vtkXdmf3ArraySelection *fselection,
     vtkXdmf3ArraySelection *cselection,
     vtkXdmf3ArraySelection *pselection,
     XdmfCurvilinearGrid *grid,
     vtkStructuredGrid *dataSet,
-    vtkXdmf3ArrayKeeper *keeper=NULL);
+    vtkXdmf3ArrayKeeper *keeper=NULL,
+    const int *updateExtent=NULL);
 
   // Description:
-  // Helper that does topology for XdmfToVTK
+  // Helper that does topology for XdmfToVTK. When updateExtent is given,
+  // only the points of that part of the whole extent are read.
   static void CopyShape(
     XdmfCurvilinearGrid *grid,
     vtkStructuredGrid *dataSet,
-    vtkXdmf3ArrayKeeper *keeper=NULL);
+    vtkXdmf3ArrayKeeper *keeper=NULL,
+    const int *updateExtent=NULL);
+
+  // Description:
+  // Returns the whole extent of the Xdmf grid without reading its points.
+  static void GetWholeExtent(XdmfCurvilinearGrid *grid, int extent[6]);
 
   // Description:
   // Populates the Xdmf Grid with the contents of the VTK data set
@@ -181,14 +199,18 @@ public:
 
   //vtkXdmf3UnstructuredGrid
   // Description:
-  // Populates the VTK data set with the contents of the Xdmf grid
+  // Populates the VTK data set with the contents of the Xdmf grid.
+  // When npieces is more than one, only the contiguous range of cells of
+  // the given piece, and the range of points they use, are read, provided
+  // that all cells have the same type and the topology is stored in HDF5.
   static void XdmfToVTK(
     vtkXdmf3ArraySelection *fselection,
     vtkXdmf3ArraySelection *cselection,
     vtkXdmf3ArraySelection *pselection,
     XdmfUnstructuredGrid *grid,
     vtkUnstructuredGrid *dataSet,
-    vtkXdmf3ArrayKeeper *keeper=NULL);
+    vtkXdmf3ArrayKeeper *keeper=NULL,
+    unsigned int piece=0, unsigned int npieces=1);
 
   // Description:
   // Helper that does topology for XdmfToVTK
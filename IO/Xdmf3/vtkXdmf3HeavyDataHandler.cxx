@@ -52,7 +52,9 @@ shared_ptr<vtkXdmf3HeavyDataHandler> vtkXdmf3HeavyDataHandler::New (
    unsigned int processor, unsigned int nprocessors,
    bool dt, double t,
    vtkXdmf3ArrayKeeper *keeper,
-   bool asTime)
+   bool asTime,
+   bool splitCells,
+   const int *updateExtent)
 {
   shared_ptr<vtkXdmf3HeavyDataHandler> p(new vtkXdmf3HeavyDataHandler());
   p->FieldArrays = fs;
@@ -66,6 +68,12 @@ shared_ptr<vtkXdmf3HeavyDataHandler> vtkXdmf3HeavyDataHandler::New (
   p->time = t;
   p->Keeper = keeper;
   p->AsTime = asTime;
+  p->SplitCells = splitCells;
+  p->HasUpdateExtent = updateExtent != NULL;
+  for (int i = 0; i < 6; i++)
+    {
+    p->UpdateExtent[i] = updateExtent ? updateExtent[i] : 0;
+    }
   return p;
 }
 
@@ -537,7 +545,9 @@ vtkDataObject *vtkXdmf3HeavyDataHandler::MakeUnsGrid
     vtkXdmf3DataSet::XdmfToVTK
       (
        this->FieldArrays, this->CellArrays, this->PointArrays,
-       grid.get(), dataSet, keeper);
+       grid.get(), dataSet, keeper,
+       this->SplitCells ? this->Rank : 0,
+       this->SplitCells ? this->NumProcs : 1);
     return dataSet;
     }
   return NULL;
@@ -555,7 +565,8 @@ vtkDataObject *vtkXdmf3HeavyDataHandler::MakeRecGrid
     vtkXdmf3DataSet::XdmfToVTK
       (
        this->FieldArrays, this->CellArrays, this->PointArrays,
-       grid.get(), dataSet, keeper);
+       grid.get(), dataSet, keeper,
+       this->HasUpdateExtent ? this->UpdateExtent : NULL);
     return dataSet;
     }
   return NULL;
@@ -573,7 +584,8 @@ vtkDataObject *vtkXdmf3HeavyDataHandler::MakeCrvGrid
     vtkXdmf3DataSet::XdmfToVTK
       (
        this->FieldArrays, this->CellArrays, this->PointArrays,
-       grid.get(), dataSet, keeper);
+       grid.get(), dataSet, keeper,
+       this->HasUpdateExtent ? this->UpdateExtent : NULL);
     return dataSet;
     }
   return NULL;
@@ -591,7 +603,8 @@ vtkDataObject *vtkXdmf3HeavyDataHandler::MakeRegGrid
     vtkXdmf3DataSet::XdmfToVTK
       (
        this->FieldArrays, this->CellArrays, this->PointArrays,
-       grid.get(), dataSet, keeper);
+       grid.get(), dataSet, keeper,
+       this->HasUpdateExtent ? this->UpdateExtent : NULL);
     return dataSet;
     }
   return NULL;
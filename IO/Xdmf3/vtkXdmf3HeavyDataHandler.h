@@ -62,7 +62,9 @@ public:
       unsigned int processor, unsigned int nprocessors,
       bool dt, double t,
       vtkXdmf3ArrayKeeper *keeper,
-      bool asTime );
+      bool asTime,
+      bool splitCells = false,
+      const int *updateExtent = NULL );
 
   //Description:
   //destructor
@@ -125,6 +127,11 @@ protected:
   vtkXdmf3ArraySelection* GridsCache;
   vtkXdmf3ArraySelection* SetsCache;
   bool AsTime;
+  //when the output is a single grid, an unstructured one is read as a
+  //range of cells for each piece and a structured one for the update extent
+  bool SplitCells;
+  bool HasUpdateExtent;
+  int UpdateExtent[6];
 };
 
 #endif //vtkXdmf3HeavyDataHandler_h
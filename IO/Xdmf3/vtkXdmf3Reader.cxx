@@ -29,7 +29,6 @@
 #include "vtkObjectFactory.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
-#include "vtkStructuredGrid.h"
 #include "vtkTimerLog.h"
 #include "vtkXdmf3ArrayKeeper.h"
 #include "vtkXdmf3ArraySelection.h"
@@ -216,7 +215,7 @@ public:
   //--------------------------------------------------------------------------
   void ReadHeavyData(unsigned int updatePiece, unsigned int updateNumPieces,
                      bool doTime, double time, vtkMultiBlockDataSet* mbds,
-                     bool AsTime)
+                     bool AsTime, bool splitCells, const int *updateExtent)
   {
     //traverse the xdmf hierarchy, and convert and return what was requested
     shared_ptr<vtkXdmf3HeavyDataHandler> visitor =
@@ -231,7 +230,9 @@ public:
           doTime,
           time,
           this->Keeper,
-          AsTime
+          AsTime,
+          splitCells,
+          updateExtent
           );
       visitor->Populate(this->Domain, mbds);
   }
@@ -629,14 +630,12 @@ int vtkXdmf3Reader::RequestInformation(vtkInformation *,
       shared_dynamic_cast<XdmfCurvilinearGrid>(this->Internal->TopGrid);
     if (crvGrid)
       {
-      vtkStructuredGrid *dataSet = vtkStructuredGrid::New();
-      vtkXdmf3DataSet::CopyShape(crvGrid.get(), dataSet, this->Internal->Keeper);
-      dataSet->GetExtent(whole_extent);
-      dataSet->Delete();
+      vtkXdmf3DataSet::GetWholeExtent(crvGrid.get(), whole_extent);
       }
 
     outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(),
         whole_extent, 6);
+    outInfo->Set(CAN_PRODUCE_SUB_EXTENT(), 1);
     outInfo->Set(vtkDataObject::ORIGIN(), origin, 3);
     outInfo->Set(vtkDataObject::SPACING(), spacing, 3);
     }
@@ -686,14 +685,25 @@ int vtkXdmf3Reader::RequestData(vtkInformation *,
         vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
     }
   */
-  /*
+
+  // A single structured grid is read for the update extent, which the
+  // executive splits into pieces, and a single unstructured grid as a range
+  // of cells for each piece, so that only that part of the heavy data is
+  // read.
+  int vtk_type = this->Internal->GetVTKType();
+  bool structured = (vtk_type == VTK_STRUCTURED_GRID ||
+                     vtk_type == VTK_RECTILINEAR_GRID ||
+                     vtk_type == VTK_IMAGE_DATA ||
+                     vtk_type == VTK_UNIFORM_GRID);
   int update_extent[6] = {0, -1, 0, -1, 0, -1};
-  if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()))
+  bool doExtent = false;
+  if (structured &&
+      outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()))
     {
     outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
         update_extent);
+    doExtent = true;
     }
-  */
 
   // Collect information about what temporal extent is requested.
   double time = 0.0;
@@ -729,7 +739,9 @@ int vtkXdmf3Reader::RequestData(vtkInformation *,
       updatePiece, updateNumPieces,
       doTime, time,
       mbds,
-      this->FileSeriesAsTime);
+      this->FileSeriesAsTime,
+      vtk_type == VTK_UNSTRUCTURED_GRID,
+      doExtent ? update_extent : NULL);
 
   if (mbds->GetNumberOfBlocks()==1)
     {
@@ -0,0 +1,200 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    ImageHistogramParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkImageHistogram gives the same histograms with EnableSMP on
+// and off, with and without stencil, and that vtkImageAccumulate counts
+// and sums the voxels like a voxel by voxel loop.
+
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageAccumulate.h"
+#include "vtkImageData.h"
+#include "vtkImageHistogram.h"
+#include "vtkImageStencilData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+vtkImageData *MakeImage(int type)
+{
+  vtkImageData *image = vtkImageData::New();
+  image->SetDimensions(96, 80, 24);
+  image->AllocateScalars(type, 1);
+  vtkDataArray *scalars = image->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    scalars->SetComponent(i, 0, floor(fabs(vtkMath::Gaussian(300.0, 200.0))));
+    }
+  return image;
+}
+
+// A ball in the middle of the image
+vtkImageStencilData *MakeStencil(vtkImageData *image)
+{
+  vtkImageStencilData *stencil = vtkImageStencilData::New();
+  int *extent = image->GetExtent();
+  stencil->SetExtent(extent);
+  stencil->AllocateExtents();
+  for (int idZ = extent[4]; idZ <= extent[5]; idZ++)
+    {
+    for (int idY = extent[2]; idY <= extent[3]; idY++)
+      {
+      double r2 = 40.0*40.0 - (idY - 40)*(idY - 40) - (idZ - 12)*(idZ - 12);
+      if (r2 > 0)
+        {
+        int dx = static_cast<int>(sqrt(r2));
+        stencil->InsertNextExtent(48 - dx, 48 + dx, idY, idZ);
+        }
+      }
+    }
+  return stencil;
+}
+
+bool CheckHistogram(vtkImageHistogram *histogram, const char *what)
+{
+  histogram->EnableSMPOff();
+  histogram->Update();
+  vtkNew<vtkIdTypeArray> expected;
+  expected->DeepCopy(histogram->GetHistogram());
+  vtkIdType total = histogram->GetTotal();
+
+  histogram->EnableSMPOn();
+  histogram->Update();
+  vtkIdTypeArray *bins = histogram->GetHistogram();
+  if (bins->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+      histogram->GetTotal() != total)
+    {
+    cerr << what << ": the totals differ" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < bins->GetNumberOfTuples(); ++i)
+    {
+    if (bins->GetValue(i) != expected->GetValue(i))
+      {
+      cerr << what << ": bin " << i << " is " << bins->GetValue(i)
+           << " instead of " << expected->GetValue(i) << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+bool CheckAccumulate(vtkImageData *image, vtkImageStencilData *stencil)
+{
+  vtkNew<vtkImageAccumulate> accumulate;
+  accumulate->SetInputData(image);
+  accumulate->SetStencilData(stencil);
+  accumulate->SetComponentExtent(0, 99, 0, 0, 0, 0);
+  accumulate->SetComponentOrigin(0.0, 0.0, 0.0);
+  accumulate->SetComponentSpacing(10.0, 1.0, 1.0);
+  accumulate->IgnoreZeroOn();
+  accumulate->Update();
+
+  std::vector<vtkIdType> bins(100, 0);
+  double sum = 0.0;
+  double min = VTK_DOUBLE_MAX;
+  double max = VTK_DOUBLE_MIN;
+  vtkIdType count = 0;
+  int *extent = image->GetExtent();
+  for (int idZ = extent[4]; idZ <= extent[5]; idZ++)
+    {
+    for (int idY = extent[2]; idY <= extent[3]; idY++)
+      {
+      for (int idX = extent[0]; idX <= extent[1]; idX++)
+        {
+        if (!stencil->IsInside(idX, idY, idZ))
+          {
+          continue;
+          }
+        double v = image->GetScalarComponentAsDouble(idX, idY, idZ, 0);
+        if (v != 0)
+          {
+          sum += v;
+          min = (v < min ? v : min);
+          max = (v > max ? v : max);
+          count++;
+          }
+        int bin = vtkMath::Floor(v / 10.0);
+        if (bin >= 0 && bin < 100)
+          {
+          bins[bin]++;
+          }
+        }
+      }
+    }
+
+  vtkDataArray *output = accumulate->GetOutput()->GetPointData()->GetScalars();
+  for (int i = 0; i < 100; ++i)
+    {
+    if (output->GetComponent(i, 0) != bins[i])
+      {
+      cerr << "Accumulate: bin " << i << " is " << output->GetComponent(i, 0)
+           << " instead of " << bins[i] << endl;
+      return false;
+      }
+    }
+  if (accumulate->GetVoxelCount() != count ||
+      accumulate->GetMin()[0] != min || accumulate->GetMax()[0] != max ||
+      fabs(accumulate->GetMean()[0] - sum/count) > 1e-9*fabs(sum/count))
+    {
+    cerr << "Accumulate: wrong statistics" << endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+int ImageHistogramParallel(int, char *[])
+{
+  vtkMath::RandomSeed(5);
+  const int types[3] = { VTK_SHORT, VTK_UNSIGNED_SHORT, VTK_FLOAT };
+  for (int t = 0; t < 3; ++t)
+    {
+    vtkImageData *image = MakeImage(types[t]);
+    vtkImageStencilData *stencil = MakeStencil(image);
+    vtkNew<vtkImageHistogram> histogram;
+    histogram->SetInputData(image);
+    histogram->GenerateHistogramImageOff();
+    histogram->SetDesiredBytesPerPiece(4096);
+
+    // bins that do not cover the data, with the integer and float paths
+    histogram->SetNumberOfBins(256);
+    histogram->SetBinOrigin(100.0);
+    histogram->SetBinSpacing(1.0);
+    bool ok = CheckHistogram(histogram.GetPointer(), "integer bins");
+    histogram->SetBinOrigin(-50.5);
+    histogram->SetBinSpacing(3.0);
+    ok = ok && CheckHistogram(histogram.GetPointer(), "scaled bins");
+    histogram->AutomaticBinningOn();
+    ok = ok && CheckHistogram(histogram.GetPointer(), "automatic bins");
+    histogram->SetStencilData(stencil);
+    ok = ok && CheckHistogram(histogram.GetPointer(), "stencil");
+    ok = ok && CheckAccumulate(image, stencil);
+
+    stencil->Delete();
+    image->Delete();
+    if (!ok)
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
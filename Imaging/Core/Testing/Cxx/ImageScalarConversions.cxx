@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    ImageScalarConversions.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test vtkImageCast, vtkImageShiftScale and vtkImageMapToColors on 8 and
+// 16 bit images large enough for their lookup tables, against the values
+// computed pixel by pixel.
+
+#include "vtkDataArray.h"
+#include "vtkImageCast.h"
+#include "vtkImageData.h"
+#include "vtkImageMapToColors.h"
+#include "vtkImageShiftScale.h"
+#include "vtkLookupTable.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <cmath>
+
+namespace
+{
+
+// An image whose values sweep the range of the type many times
+vtkImageData *MakeImage(int type, int size)
+{
+  vtkImageData *image = vtkImageData::New();
+  image->SetDimensions(size, size, 16);
+  image->AllocateScalars(type, 1);
+  double typeMin = image->GetScalarTypeMin();
+  double typeRange = image->GetScalarTypeMax() - typeMin + 1;
+  vtkIdType n = image->GetNumberOfPoints();
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    double v = typeMin + fmod(i*7.0, typeRange);
+    image->GetPointData()->GetScalars()->SetComponent(i, 0, v);
+    }
+  return image;
+}
+
+bool TestCast(vtkImageData *image)
+{
+  vtkNew<vtkImageCast> cast;
+  cast->SetInputData(image);
+  cast->ClampOverflowOn();
+  cast->SetOutputScalarTypeToUnsignedChar();
+  cast->Update();
+  vtkDataArray *in = image->GetPointData()->GetScalars();
+  vtkDataArray *out = cast->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < in->GetNumberOfTuples(); ++i)
+    {
+    double v = in->GetComponent(i, 0);
+    v = (v < 0 ? 0 : (v > 255 ? 255 : v));
+    if (out->GetComponent(i, 0) != v)
+      {
+      cerr << "Cast: value " << i << " is " << out->GetComponent(i, 0)
+           << " instead of " << v << endl;
+      return false;
+      }
+    }
+
+  cast->SetOutputScalarTypeToFloat();
+  cast->Update();
+  out = cast->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < in->GetNumberOfTuples(); ++i)
+    {
+    if (out->GetComponent(i, 0) != in->GetComponent(i, 0))
+      {
+      cerr << "Cast: float value " << i << " differs" << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+bool TestShiftScale(vtkImageData *image)
+{
+  vtkNew<vtkImageShiftScale> shiftScale;
+  shiftScale->SetInputData(image);
+  shiftScale->SetShift(100.0);
+  shiftScale->SetScale(0.37);
+  shiftScale->ClampOverflowOn();
+  shiftScale->SetOutputScalarTypeToShort();
+  shiftScale->Update();
+  vtkDataArray *in = image->GetPointData()->GetScalars();
+  vtkDataArray *out = shiftScale->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < in->GetNumberOfTuples(); ++i)
+    {
+    double v = (in->GetComponent(i, 0) + 100.0)*0.37;
+    v = (v < VTK_SHORT_MIN ? VTK_SHORT_MIN :
+         (v > VTK_SHORT_MAX ? VTK_SHORT_MAX : v));
+    if (out->GetComponent(i, 0) != static_cast<short>(v))
+      {
+      cerr << "ShiftScale: value " << i << " is " << out->GetComponent(i, 0)
+           << " instead of " << static_cast<short>(v) << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+bool TestMapToColors(vtkImageData *image, int format)
+{
+  double *range = image->GetScalarRange();
+  vtkNew<vtkLookupTable> table;
+  table->SetRange(range[0] + 10, range[1] - 10);
+  table->SetHueRange(0.0, 0.7);
+  table->SetAlphaRange(0.2, 1.0);
+  table->Build();
+
+  vtkNew<vtkImageMapToColors> map;
+  map->SetInputData(image);
+  map->SetLookupTable(table.GetPointer());
+  map->SetOutputFormat(format);
+  map->Update();
+
+  vtkDataArray *in = image->GetPointData()->GetScalars();
+  vtkDataArray *out = map->GetOutput()->GetPointData()->GetScalars();
+  unsigned char expected[4];
+  for (vtkIdType i = 0; i < in->GetNumberOfTuples(); ++i)
+    {
+    double v = in->GetComponent(i, 0);
+    table->MapScalarsThroughTable2(&v, expected, VTK_DOUBLE, 1, 1, format);
+    for (int c = 0; c < format; ++c)
+      {
+      if (out->GetComponent(i, c) != expected[c])
+        {
+        cerr << "MapToColors: component " << c << " of value " << i
+             << " is " << out->GetComponent(i, c) << " instead of "
+             << static_cast<int>(expected[c]) << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+}
+
+int ImageScalarConversions(int, char *[])
+{
+  const int types[] = { VTK_UNSIGNED_CHAR, VTK_SIGNED_CHAR, VTK_SHORT,
+                        VTK_UNSIGNED_SHORT };
+  for (int t = 0; t < 4; ++t)
+    {
+    vtkImageData *image = MakeImage(types[t], 128);
+    bool ok = (TestCast(image) && TestShiftScale(image) &&
+               TestMapToColors(image, VTK_RGBA) &&
+               TestMapToColors(image, VTK_RGB) &&
+               TestMapToColors(image, VTK_LUMINANCE));
+    image->Delete();
+    if (!ok)
+      {
+      cerr << "Failed for " << vtkImageScalarTypeNameMacro(types[t]) << endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
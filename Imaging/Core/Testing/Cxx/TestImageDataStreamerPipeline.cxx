@@ -0,0 +1,137 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageDataStreamerPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkImageDataStreamer with LimitPipelineMemory streams a chain
+// of image filters in tiles that keep every stage within the memory
+// limit, and that the streamed image is the image computed in one piece.
+
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkImageCast.h"
+#include "vtkImageData.h"
+#include "vtkImageDataStreamer.h"
+#include "vtkImageGaussianSmooth.h"
+#include "vtkImageMapToColors.h"
+#include "vtkImageShiftScale.h"
+#include "vtkLookupTable.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+
+namespace
+{
+
+// Record the largest output of a filter
+class SizeObserver : public vtkCommand
+{
+public:
+  static SizeObserver *New() { return new SizeObserver; }
+
+  void Execute(vtkObject *caller, unsigned long, void *)
+  {
+    vtkAlgorithm *algorithm = static_cast<vtkAlgorithm *>(caller);
+    unsigned long size =
+      vtkImageData::SafeDownCast(algorithm->GetOutputDataObject(0))
+      ->GetActualMemorySize();
+    this->MaximumSize = (size > this->MaximumSize ? size : this->MaximumSize);
+  }
+
+  unsigned long MaximumSize;
+
+protected:
+  SizeObserver() : MaximumSize(0) {}
+};
+
+}
+
+int TestImageDataStreamerPipeline(int, char *[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(0, 127, 0, 127, 0, 31);
+
+  vtkNew<vtkImageCast> cast;
+  cast->SetInputConnection(source->GetOutputPort());
+  cast->SetOutputScalarTypeToDouble();
+
+  vtkNew<vtkImageShiftScale> shiftScale;
+  shiftScale->SetInputConnection(cast->GetOutputPort());
+  shiftScale->SetShift(-40.0);
+  shiftScale->SetScale(0.5);
+  shiftScale->SetOutputScalarTypeToFloat();
+
+  vtkNew<vtkImageGaussianSmooth> smooth;
+  smooth->SetInputConnection(shiftScale->GetOutputPort());
+  smooth->SetStandardDeviations(2.0, 2.0, 2.0);
+  smooth->SetRadiusFactors(2.0, 2.0, 2.0);
+
+  vtkNew<vtkLookupTable> table;
+  table->SetRange(0.0, 100.0);
+  table->Build();
+  vtkNew<vtkImageMapToColors> colors;
+  colors->SetInputConnection(smooth->GetOutputPort());
+  colors->SetLookupTable(table.GetPointer());
+
+  // the image in one piece
+  colors->Update();
+  vtkNew<vtkImageData> expected;
+  expected->DeepCopy(colors->GetOutput());
+  unsigned long fullSize = smooth->GetOutput()->GetActualMemorySize();
+
+  vtkNew<SizeObserver> observer;
+  smooth->AddObserver(vtkCommand::EndEvent, observer.GetPointer());
+
+  const unsigned long limit = 1024;
+  vtkNew<vtkImageDataStreamer> streamer;
+  streamer->SetInputConnection(colors->GetOutputPort());
+  streamer->SetMemoryLimit(limit);
+  streamer->Update();
+  int inputDivisions = streamer->GetNumberOfStreamDivisions();
+
+  observer->MaximumSize = 0;
+  streamer->LimitPipelineMemoryOn();
+  streamer->Modified();
+  streamer->Update();
+  if (streamer->GetNumberOfStreamDivisions() <= inputDivisions)
+    {
+    cerr << streamer->GetNumberOfStreamDivisions() << " divisions for the "
+         << "pipeline, and " << inputDivisions << " for the input" << endl;
+    return EXIT_FAILURE;
+    }
+  if (observer->MaximumSize > limit || observer->MaximumSize * 4 > fullSize)
+    {
+    cerr << "The smoothed tiles take up to " << observer->MaximumSize
+         << " KiB" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkDataArray *e = expected->GetPointData()->GetScalars();
+  vtkDataArray *o = streamer->GetOutput()->GetPointData()->GetScalars();
+  if (e->GetNumberOfTuples() != o->GetNumberOfTuples())
+    {
+    cerr << "Wrong output size" << endl;
+    return EXIT_FAILURE;
+    }
+  for (vtkIdType i = 0; i < e->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < e->GetNumberOfComponents(); ++c)
+      {
+      if (e->GetComponent(i, c) != o->GetComponent(i, c))
+        {
+        cerr << "The streamed image differs at point " << i << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
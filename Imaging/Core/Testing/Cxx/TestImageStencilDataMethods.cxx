@@ -13,12 +13,88 @@
 
 =========================================================================*/
 
-// Test the IsInside method of vtkImageStencilData.
+// Test the IsInside method of vtkImageStencilData, and the Add, Subtract
+// and Replace methods against voxel by voxel boolean operations.
 
 #include "vtkImageStencilData.h"
+#include "vtkMath.h"
 #include "vtkSmartPointer.h"
 #include "vtkTesting.h"
 
+namespace
+{
+
+// A stencil with a few random sub-extents in every row
+vtkSmartPointer<vtkImageStencilData> MakeRandomStencil(const int extent[6])
+{
+  vtkSmartPointer<vtkImageStencilData> stencil =
+    vtkSmartPointer<vtkImageStencilData>::New();
+  stencil->SetExtent(const_cast<int *>(extent));
+  stencil->AllocateExtents();
+  for (int idZ = extent[4]; idZ <= extent[5]; idZ++)
+    {
+    for (int idY = extent[2]; idY <= extent[3]; idY++)
+      {
+      int r = extent[0] + static_cast<int>(vtkMath::Random(0.0, 8.0));
+      while (r <= extent[1])
+        {
+        int r2 = r + static_cast<int>(vtkMath::Random(0.0, 6.0));
+        r2 = (r2 < extent[1] ? r2 : extent[1]);
+        stencil->InsertNextExtent(r, r2, idY, idZ);
+        r = r2 + 2 + static_cast<int>(vtkMath::Random(0.0, 8.0));
+        }
+      }
+    }
+  return stencil;
+}
+
+// Compare a stencil with the expected voxels, over a box around both inputs
+bool CheckStencil(vtkImageStencilData *a, vtkImageStencilData *b,
+                  vtkImageStencilData *result, int operation,
+                  const char *what)
+{
+  for (int idZ = -2; idZ <= 25; idZ++)
+    {
+    for (int idY = -2; idY <= 25; idY++)
+      {
+      for (int idX = -2; idX <= 45; idX++)
+        {
+        int inA = a->IsInside(idX, idY, idZ);
+        int inB = b->IsInside(idX, idY, idZ);
+        int expected = 0;
+        if (operation == 0)
+          {
+          expected = (inA | inB);
+          }
+        else if (operation == 1)
+          {
+          expected = (inA & !inB);
+          }
+        else
+          {
+          // the voxels of b replace those of a where both extents overlap
+          int *ea = a->GetExtent();
+          int *eb = b->GetExtent();
+          bool inBoth = (idX >= ea[0] && idX <= ea[1] && idX >= eb[0] &&
+                         idX <= eb[1] && idY >= ea[2] && idY <= ea[3] &&
+                         idY >= eb[2] && idY <= eb[3] && idZ >= ea[4] &&
+                         idZ <= ea[5] && idZ >= eb[4] && idZ <= eb[5]);
+          expected = (inBoth ? inB : inA);
+          }
+        if (result->IsInside(idX, idY, idZ) != expected)
+          {
+          cerr << what << " failed at (" << idX << ", " << idY << ", "
+               << idZ << ")\n";
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+}
+
 //----------------------------------------------------------------------------
 int TestImageStencilDataMethods(int argc, char *argv[])
 {
@@ -54,5 +130,35 @@ int TestImageStencilDataMethods(int argc, char *argv[])
       }
     }
 
+  // Test the stencil algebra on overlapping random stencils
+  vtkMath::RandomSeed(7);
+  const int extentA[6] = { 0, 39, 0, 19, 0, 9 };
+  const int extentB[6] = { 10, 43, -1, 14, 3, 22 };
+  const char *names[3] = { "Add", "Subtract", "Replace" };
+  for (int operation = 0; operation < 3; operation++)
+    {
+    vtkSmartPointer<vtkImageStencilData> a = MakeRandomStencil(extentA);
+    vtkSmartPointer<vtkImageStencilData> b = MakeRandomStencil(extentB);
+    vtkSmartPointer<vtkImageStencilData> result =
+      vtkSmartPointer<vtkImageStencilData>::New();
+    result->DeepCopy(a);
+    if (operation == 0)
+      {
+      result->Add(b);
+      }
+    else if (operation == 1)
+      {
+      result->Subtract(b);
+      }
+    else
+      {
+      result->Replace(b);
+      }
+    if (!CheckStencil(a, b, result, operation, names[operation]))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
   return EXIT_SUCCESS;
 }
@@ -20,6 +20,7 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTypeTraits.h"
 
 vtkStandardNewMacro(vtkImageCast);
 
@@ -46,6 +47,32 @@ int vtkImageCast::RequestInformation (
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// The span loops take plain pointers and a count, and clamp with selects
+// instead of branches, so that the compiler can vectorize them.
+template <class IT, class OT>
+void vtkImageCastSpan(const IT *inSI, OT *outSI, vtkIdType n)
+{
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    // NB: without clamping, this cast may result in undefined behavior!
+    outSI[i] = static_cast<OT>(inSI[i]);
+    }
+}
+
+template <class IT, class OT>
+void vtkImageCastClampSpan(const IT *inSI, OT *outSI, vtkIdType n,
+                           double typeMin, double typeMax)
+{
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    double val = static_cast<double>(inSI[i]);
+    val = (val > typeMax ? typeMax : val);
+    val = (val < typeMin ? typeMin : val);
+    outSI[i] = static_cast<OT>(val);
+    }
+}
+
 //----------------------------------------------------------------------------
 // This templated function executes the filter for any type of data.
 template <class IT, class OT>
@@ -57,7 +84,7 @@ void vtkImageCastExecute(vtkImageCast *self,
   vtkImageIterator<IT> inIt(inData, outExt);
   vtkImageProgressIterator<OT> outIt(outData, outExt, self, id);
 
-  double typeMin, typeMax, val;
+  double typeMin, typeMax;
   int clamp;
 
   // for preventing overflow
@@ -65,41 +92,26 @@ void vtkImageCastExecute(vtkImageCast *self,
   typeMax = outData->GetScalarTypeMax();
   clamp = self->GetClampOverflow();
 
+  // no need to clamp values that the output type holds
+  if (static_cast<double>(vtkTypeTraits<IT>::Min()) >= typeMin &&
+      static_cast<double>(vtkTypeTraits<IT>::Max()) <= typeMax)
+    {
+    clamp = 0;
+    }
+
   // Loop through output pixels
   while (!outIt.IsAtEnd())
     {
     IT* inSI = inIt.BeginSpan();
     OT* outSI = outIt.BeginSpan();
-    OT* outSIEnd = outIt.EndSpan();
+    vtkIdType n = outIt.EndSpan() - outSI;
     if (clamp)
       {
-      while (outSI != outSIEnd)
-        {
-        // Pixel operation
-        val = static_cast<double>(*inSI);
-        if (val > typeMax)
-          {
-          val = typeMax;
-          }
-        if (val < typeMin)
-          {
-          val = typeMin;
-          }
-        *outSI = static_cast<OT>(val);
-        ++outSI;
-        ++inSI;
-        }
+      vtkImageCastClampSpan(inSI, outSI, n, typeMin, typeMax);
       }
     else
       {
-      while (outSI != outSIEnd)
-        {
-        // now process the components
-        // NB: without clamping, this cast may result in undefined behavior!
-        *outSI = static_cast<OT>(*inSI);
-        ++outSI;
-        ++inSI;
-        }
+      vtkImageCastSpan(inSI, outSI, n);
       }
     inIt.NextSpan();
     outIt.NextSpan();
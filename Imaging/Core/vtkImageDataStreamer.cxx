@@ -14,23 +14,111 @@
 =========================================================================*/
 #include "vtkImageDataStreamer.h"
 
+#include "vtkAbstractArray.h"
+#include "vtkAlgorithm.h"
 #include "vtkCommand.h"
+#include "vtkExecutive.h"
 #include "vtkExtentTranslator.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <cmath>
+#include <vector>
+
 vtkStandardNewMacro(vtkImageDataStreamer);
 vtkCxxSetObjectMacro(vtkImageDataStreamer,ExtentTranslator,vtkExtentTranslator);
 
+// Upper bound on the number of divisions chosen to fit the memory limit.
+static const int VTK_MAXIMUM_NUMBER_OF_DIVISIONS = 1 << 16;
+
+//----------------------------------------------------------------------------
+static double vtkImageDataStreamerNumberOfPoints(const int ext[6])
+{
+  double numPts = 1.0;
+  for (int i = 0; i < 3; ++i)
+    {
+    numPts *= (ext[2*i+1] >= ext[2*i]) ? ext[2*i+1] - ext[2*i] + 1 : 0;
+    }
+  return numPts;
+}
+
+//----------------------------------------------------------------------------
+// Size of a point from the point data arrays advertised in info, or from
+// the scalars alone when the arrays are not described.
+static double vtkImageDataStreamerBytesPerPoint(vtkInformation *info)
+{
+  double bytesPerPoint = 0.0;
+  vtkInformationVector *fields =
+    info->Get(vtkDataObject::POINT_DATA_VECTOR());
+  int numFields = fields ? fields->GetNumberOfInformationObjects() : 0;
+  for (int i = 0; i < numFields; ++i)
+    {
+    vtkInformation *field = fields->GetInformationObject(i);
+    if (!field->Has(vtkDataObject::FIELD_ARRAY_TYPE()))
+      {
+      continue;
+      }
+    int numComponents = 1;
+    if (field->Has(vtkDataObject::FIELD_NUMBER_OF_COMPONENTS()))
+      {
+      numComponents = field->Get(vtkDataObject::FIELD_NUMBER_OF_COMPONENTS());
+      }
+    bytesPerPoint += numComponents *
+      vtkAbstractArray::GetDataTypeSize(
+        field->Get(vtkDataObject::FIELD_ARRAY_TYPE()));
+    }
+  if (bytesPerPoint == 0.0)
+    {
+    bytesPerPoint =
+      vtkImageData::GetNumberOfScalarComponents(info) *
+      vtkAbstractArray::GetDataTypeSize(vtkImageData::GetScalarType(info));
+    }
+  return bytesPerPoint;
+}
+
+//----------------------------------------------------------------------------
+// The output information of the producers of image data upstream of
+// inInfo, inInfo included, following the first input connections.
+static void vtkImageDataStreamerGetPipeline(
+  vtkInformation *inInfo, std::vector<vtkInformation *> &infos)
+{
+  vtkInformation *info = inInfo;
+  while (info)
+    {
+    infos.push_back(info);
+    vtkExecutive *executive = 0;
+    int port = 0;
+    vtkExecutive::PRODUCER()->Get(info, executive, port);
+    vtkAlgorithm *algorithm = executive ? executive->GetAlgorithm() : 0;
+    info = 0;
+    if (algorithm && algorithm->GetNumberOfInputPorts() > 0 &&
+        algorithm->GetNumberOfInputConnections(0) > 0)
+      {
+      info = executive->GetInputInformation(0, 0);
+      if (!vtkImageData::SafeDownCast(info->Get(vtkDataObject::DATA_OBJECT())))
+        {
+        info = 0;
+        }
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 vtkImageDataStreamer::vtkImageDataStreamer()
 {
   // default to 10 divisions
   this->NumberOfStreamDivisions = 10;
   this->CurrentDivision = 0;
+  this->MemoryLimit = 0;
+  this->LimitPipelineMemory = false;
+  this->BytesPerPoint = 0.0;
+  this->SizeRatio = 1.0;
+  this->MaximumSizeRatio = 0.0;
+  this->RefinedPieceSize = 0;
 
   // create default translator
   this->ExtentTranslator = vtkExtentTranslator::New();
@@ -53,6 +141,9 @@ void vtkImageDataStreamer::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "NumberOfStreamDivisions: " << this->NumberOfStreamDivisions << endl;
+  os << indent << "MemoryLimit (in kibibytes): " << this->MemoryLimit << endl;
+  os << indent << "LimitPipelineMemory: "
+     << (this->LimitPipelineMemory ? "On" : "Off") << endl;
   if ( this->ExtentTranslator )
     {
     os << indent << "ExtentTranslator:\n";
@@ -78,6 +169,16 @@ int vtkImageDataStreamer::ProcessRequest(vtkInformation* request,
     int outExt[6];
     outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
 
+    // choose the number of divisions when a new update starts. Once
+    // streaming started again with more divisions, keep them.
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    if (this->MemoryLimit > 0 && this->CurrentDivision == 0 &&
+        this->RefinedPieceSize == 0)
+      {
+      this->NumberOfStreamDivisions =
+        this->ComputeNumberOfStreamDivisions(inInfo, outExt);
+      }
+
     // setup the inputs update extent
     int inExt[6] = {0, -1, 0, -1, 0, -1};
     vtkExtentTranslator *translator = this->GetExtentTranslator();
@@ -90,8 +191,7 @@ int vtkImageDataStreamer::ProcessRequest(vtkInformation* request,
       translator->GetExtent(inExt);
       }
 
-    inputVector[0]->GetInformationObject(0)
-      ->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt, 6);
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt, 6);
 
     return 1;
     }
@@ -106,7 +206,7 @@ int vtkImageDataStreamer::ProcessRequest(vtkInformation* request,
 
 
     // is this the first request
-    if (!this->CurrentDivision)
+    if (!this->CurrentDivision && !this->RefinedPieceSize)
       {
       // Tell the pipeline to start looping.
       request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
@@ -121,6 +221,50 @@ int vtkImageDataStreamer::ProcessRequest(vtkInformation* request,
     int inExt[6];
     inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt);
 
+    if (this->MemoryLimit > 0)
+      {
+      unsigned long size = input->GetActualMemorySize();
+      if (this->LimitPipelineMemory)
+        {
+        std::vector<vtkInformation *> infos;
+        vtkImageDataStreamerGetPipeline(inInfo, infos);
+        for (size_t i = 1; i < infos.size(); ++i)
+          {
+          size += vtkImageData::SafeDownCast(
+            infos[i]->Get(vtkDataObject::DATA_OBJECT()))->GetActualMemorySize();
+          }
+        }
+      double estimatedSize = this->BytesPerPoint *
+        vtkImageDataStreamerNumberOfPoints(inExt) / 1024.0;
+      if (estimatedSize > 0.0 && size / estimatedSize > this->MaximumSizeRatio)
+        {
+        this->MaximumSizeRatio = size / estimatedSize;
+        }
+
+      // the piece is too large: start again with smaller pieces, unless
+      // the previous attempt did not make them noticeably smaller.
+      if (size > this->MemoryLimit &&
+          this->NumberOfStreamDivisions < VTK_MAXIMUM_NUMBER_OF_DIVISIONS &&
+          (this->RefinedPieceSize == 0 || size < 0.8 * this->RefinedPieceSize))
+        {
+        double factor = ceil(static_cast<double>(size) / this->MemoryLimit);
+        double divisions =
+          this->NumberOfStreamDivisions * (factor > 2.0 ? factor : 2.0);
+        this->NumberOfStreamDivisions = VTK_MAXIMUM_NUMBER_OF_DIVISIONS;
+        if (divisions < VTK_MAXIMUM_NUMBER_OF_DIVISIONS)
+          {
+          this->NumberOfStreamDivisions = static_cast<int>(divisions);
+          }
+        vtkDebugMacro("Piece of " << size << " KiB exceeds the memory "
+                      "limit, streaming again in "
+                      << this->NumberOfStreamDivisions << " divisions");
+        this->RefinedPieceSize = size;
+        this->CurrentDivision = 0;
+        request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+        return 1;
+        }
+      }
+
     output->CopyAndCastFrom(input, inExt);
 
     // update the progress
@@ -134,9 +278,50 @@ int vtkImageDataStreamer::ProcessRequest(vtkInformation* request,
       // Tell the pipeline to stop looping.
       request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
       this->CurrentDivision = 0;
+      this->RefinedPieceSize = 0;
+      if (this->MaximumSizeRatio > 0.0)
+        {
+        this->SizeRatio = this->MaximumSizeRatio;
+        }
+      this->MaximumSizeRatio = 0.0;
       }
 
     return 1;
     }
   return this->Superclass::ProcessRequest(request, inputVector, outputVector);
 }
+
+//----------------------------------------------------------------------------
+int vtkImageDataStreamer::ComputeNumberOfStreamDivisions(
+  vtkInformation *inInfo, int outExt[6])
+{
+  // size of a point of the input, or of all the image data upstream
+  this->BytesPerPoint = vtkImageDataStreamerBytesPerPoint(inInfo);
+  if (this->LimitPipelineMemory)
+    {
+    std::vector<vtkInformation *> infos;
+    vtkImageDataStreamerGetPipeline(inInfo, infos);
+    for (size_t i = 1; i < infos.size(); ++i)
+      {
+      this->BytesPerPoint += vtkImageDataStreamerBytesPerPoint(infos[i]);
+      }
+    }
+
+  double numPts = vtkImageDataStreamerNumberOfPoints(outExt);
+  double size =
+    this->SizeRatio * this->BytesPerPoint * numPts / 1024.0;
+  double divisions = ceil(size / this->MemoryLimit);
+  if (divisions > numPts)
+    {
+    divisions = numPts;
+    }
+  if (divisions < 1.0)
+    {
+    return 1;
+    }
+  if (divisions > VTK_MAXIMUM_NUMBER_OF_DIVISIONS)
+    {
+    return VTK_MAXIMUM_NUMBER_OF_DIVISIONS;
+    }
+  return static_cast<int>(divisions);
+}
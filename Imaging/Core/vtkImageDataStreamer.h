@@ -17,6 +17,19 @@
 // To satisfy a request, this filter calls update on its input
 // many times with smaller update extents.  All processing up stream
 // streams smaller pieces.
+//
+// When a memory limit is set, the number of divisions is computed from
+// the requested extent and the point data arrays the input advertises in
+// its information, so that each piece fits in the limit. Should a piece
+// turn out to be larger than the limit anyway, streaming starts again
+// with more divisions, and the discrepancy is taken into account for the
+// next updates.
+//
+// With LimitPipelineMemory on, the limit applies to the image data of the
+// whole chain of filters upstream, so that a limit about the size of a
+// cache makes the chain run tile by tile: each filter then only ever holds
+// a tile of its output, grown by the margins that the filters downstream
+// of it request.
 
 #ifndef vtkImageDataStreamer_h
 #define vtkImageDataStreamer_h
@@ -40,6 +53,22 @@ public:
   vtkSetMacro(NumberOfStreamDivisions,int);
   vtkGetMacro(NumberOfStreamDivisions,int);
 
+  // Description:
+  // Set / Get the memory limit of each input piece in kibibytes (1024
+  // bytes). When it is 0 (the default), NumberOfStreamDivisions is used as
+  // is. Otherwise NumberOfStreamDivisions is computed for each update.
+  vtkSetMacro(MemoryLimit, unsigned long);
+  vtkGetMacro(MemoryLimit, unsigned long);
+
+  // Description:
+  // When on, MemoryLimit bounds the sum of the pieces of image data held
+  // by the input and by the inputs upstream of it, following the first
+  // input connection of each filter, instead of the input piece alone.
+  // Off by default.
+  vtkSetMacro(LimitPipelineMemory, bool);
+  vtkGetMacro(LimitPipelineMemory, bool);
+  vtkBooleanMacro(LimitPipelineMemory, bool);
+
   // Description:
   // Get the extent translator that will be used to split the requests
   virtual void SetExtentTranslator(vtkExtentTranslator*);
@@ -54,9 +83,27 @@ protected:
   vtkImageDataStreamer();
   ~vtkImageDataStreamer();
 
+  // Description:
+  // Return the number of divisions of outExt needed for each piece of the
+  // input to fit in MemoryLimit. The default implementation estimates the
+  // size of the pieces from the point data arrays advertised in inInfo.
+  virtual int ComputeNumberOfStreamDivisions(vtkInformation *inInfo,
+                                             int outExt[6]);
+
   vtkExtentTranslator *ExtentTranslator;
   int            NumberOfStreamDivisions;
   int            CurrentDivision;
+  unsigned long  MemoryLimit;
+  bool           LimitPipelineMemory;
+
+  // Estimated size of a point in bytes, ratio of the measured to the
+  // estimated size of the pieces, largest such ratio during the current
+  // update, and size in kibibytes of the piece that caused the current
+  // update to start again.
+  double         BytesPerPoint;
+  double         SizeRatio;
+  double         MaximumSizeRatio;
+  unsigned long  RefinedPieceSize;
 private:
   vtkImageDataStreamer(const vtkImageDataStreamer&);  // Not implemented.
   void operator=(const vtkImageDataStreamer&);  // Not implemented.
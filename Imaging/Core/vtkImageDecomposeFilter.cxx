@@ -60,7 +60,7 @@ void vtkImageDecomposeFilter::PermuteIncrements(vtkIdType *increments,
                                                 vtkIdType &inc1,
                                                 vtkIdType &inc2)
 {
-  switch (this->Iteration)
+  switch (this->GetIterationAxis())
     {
     case 0:
       inc0 = increments[0];
@@ -86,7 +86,7 @@ void vtkImageDecomposeFilter::PermuteExtent(int *extent, int &min0, int &max0,
                                             int &min1, int &max1,
                                             int &min2, int &max2)
 {
-  switch (this->Iteration)
+  switch (this->GetIterationAxis())
     {
     case 0:
       min0 = extent[0];       max0 = extent[1];
@@ -42,6 +42,11 @@ public:
   void SetDimensionality(int dim);
   vtkGetMacro(Dimensionality,int);
 
+  // Description:
+  // The axis that the current iteration processes.  This is the iteration
+  // itself, unless a subclass processes the axes in another order.
+  virtual int GetIterationAxis() { return this->Iteration; }
+
   // Description:
   // Private methods kept public for template execute functions.
   void PermuteIncrements(vtkIdType *increments, vtkIdType &inc0,
@@ -35,6 +35,9 @@ vtkImageDifference::vtkImageDifference()
   this->AllowShift = 1;
   this->Averaging = 1;
   this->SetNumberOfInputPorts(2);
+  // The errors are accumulated per thread id, which must stay below
+  // NumberOfThreads.
+  this->EnableSMP = false;
 }
 
 
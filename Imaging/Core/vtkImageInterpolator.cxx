@@ -544,6 +544,15 @@ void vtkImageNLCRowInterpolate<F, T>::Nearest(
   // get the number of components per pixel
   int numscalars = weights->NumberOfComponents;
 
+  if (numscalars == 1)
+    { // a plain gather for single-component data
+    for (int i = 0; i < n; i++)
+      {
+      outPtr[i] = inPtr0[iX[i]];
+      }
+    return;
+    }
+
   // This is a hot loop.
   for (int i = n; i > 0; --i)
     {
@@ -665,6 +674,39 @@ void vtkImageNLCRowInterpolate<F, T>::Trilinear(
         }
       }
     }
+  else if (numscalars == 1)
+    { // single-component data, without the loop over the components
+    const T *inPtr00 = inPtr + i00;
+    const T *inPtr01 = inPtr + i01;
+    const T *inPtr10 = inPtr + i10;
+    const T *inPtr11 = inPtr + i11;
+    if (fz == 0)
+      {
+      for (int i = 0; i < n; i++)
+        {
+        F rx = fX[2*i];
+        F fx = fX[2*i + 1];
+        vtkIdType t0 = iX[2*i];
+        vtkIdType t1 = iX[2*i + 1];
+        outPtr[i] = (rx*(ry*inPtr00[t0] + fy*inPtr10[t0]) +
+                     fx*(ry*inPtr00[t1] + fy*inPtr10[t1]));
+        }
+      }
+    else
+      {
+      for (int i = 0; i < n; i++)
+        {
+        F rx = fX[2*i];
+        F fx = fX[2*i + 1];
+        vtkIdType t0 = iX[2*i];
+        vtkIdType t1 = iX[2*i + 1];
+        outPtr[i] = (rx*(ryrz*inPtr00[t0] + ryfz*inPtr01[t0] +
+                         fyrz*inPtr10[t0] + fyfz*inPtr11[t0]) +
+                     fx*(ryrz*inPtr00[t1] + ryfz*inPtr01[t1] +
+                         fyrz*inPtr10[t1] + fyfz*inPtr11[t1]));
+        }
+      }
+    }
   else if (fz == 0)
     { // bilinear interpolation in x,y
     for (int i = n; i > 0; --i)
@@ -743,6 +785,52 @@ void vtkImageNLCRowInterpolate<F, T>::Tricubic(
   // get the number of components per pixel
   int numscalars = weights->NumberOfComponents;
 
+  if (numscalars == 1 && stepX == 4)
+    {
+    // The y,z part of the kernel is the same for the whole row: gather its
+    // nonzero terms once, in the order in which the general loop sums them
+    F fYZ[16];
+    vtkIdType iYZ[16];
+    int nYZ = 0;
+    for (int k = 0; k < stepZ; k++)
+      {
+      F fz = fZ[k];
+      if (fz != 0)
+        {
+        for (int j = 0; j < stepY; j++)
+          {
+          fYZ[nYZ] = fz*fY[j];
+          iYZ[nYZ] = iZ[k] + iY[j];
+          nYZ++;
+          }
+        }
+      }
+
+    for (int i = 0; i < n; i++)
+      {
+      vtkIdType iX0 = iX[4*i];
+      vtkIdType iX1 = iX[4*i + 1];
+      vtkIdType iX2 = iX[4*i + 2];
+      vtkIdType iX3 = iX[4*i + 3];
+      F fX0 = fX[4*i];
+      F fX1 = fX[4*i + 1];
+      F fX2 = fX[4*i + 2];
+      F fX3 = fX[4*i + 3];
+
+      F result = 0;
+      for (int p = 0; p < nYZ; p++)
+        {
+        const T *tmpPtr = inPtr + iYZ[p];
+        result += fYZ[p]*(fX0*tmpPtr[iX0] +
+                          fX1*tmpPtr[iX1] +
+                          fX2*tmpPtr[iX2] +
+                          fX3*tmpPtr[iX3]);
+        }
+      outPtr[i] = result;
+      }
+    return;
+    }
+
   for (int i = n; i > 0; --i)
     {
     vtkIdType iX0 = iX[0];
@@ -23,6 +23,9 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkScalarsToColors.h"
 #include "vtkPointData.h"
+#include "vtkTypeTraits.h"
+
+#include <vector>
 
 vtkStandardNewMacro(vtkImageMapToColors);
 vtkCxxSetObjectMacro(vtkImageMapToColors,LookupTable,vtkScalarsToColors);
@@ -170,6 +173,90 @@ int vtkImageMapToColors::RequestInformation (
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// For 8 and 16 bit inputs, the colors of all the possible values can be
+// mapped once, after which each row is a gather from that color table.
+static int vtkImageMapToColorsTableSize(int dataType)
+{
+  switch (dataType)
+    {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+      return 256;
+    case VTK_SHORT:
+    case VTK_UNSIGNED_SHORT:
+      return 65536;
+    }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImageMapToColorsBuildTable(vtkScalarsToColors *lookupTable,
+                                   int outputFormat, int dataType,
+                                   std::vector<unsigned char> &table, T *)
+{
+  int tableSize = vtkImageMapToColorsTableSize(dataType);
+  std::vector<T> values(tableSize);
+  for (int i = 0; i < tableSize; ++i)
+    {
+    values[i] = static_cast<T>(vtkTypeTraits<T>::Min() + i);
+    }
+  table.resize(tableSize*outputFormat);
+  lookupTable->MapScalarsThroughTable2(&values[0], &table[0], dataType,
+                                       tableSize, 1, outputFormat);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImageMapToColorsGather(const unsigned char *table, T *inPtr,
+                               unsigned char *outPtr, int count,
+                               int inIncrement, int outputFormat)
+{
+  const unsigned char *lookup =
+    table - static_cast<int>(vtkTypeTraits<T>::Min())*outputFormat;
+  int i;
+  switch (outputFormat)
+    {
+    case 4:
+      for (i = 0; i < count; ++i)
+        {
+        const unsigned char *color =
+          lookup + static_cast<int>(inPtr[i*inIncrement])*4;
+        outPtr[4*i] = color[0];
+        outPtr[4*i + 1] = color[1];
+        outPtr[4*i + 2] = color[2];
+        outPtr[4*i + 3] = color[3];
+        }
+      break;
+    case 3:
+      for (i = 0; i < count; ++i)
+        {
+        const unsigned char *color =
+          lookup + static_cast<int>(inPtr[i*inIncrement])*3;
+        outPtr[3*i] = color[0];
+        outPtr[3*i + 1] = color[1];
+        outPtr[3*i + 2] = color[2];
+        }
+      break;
+    case 2:
+      for (i = 0; i < count; ++i)
+        {
+        const unsigned char *color =
+          lookup + static_cast<int>(inPtr[i*inIncrement])*2;
+        outPtr[2*i] = color[0];
+        outPtr[2*i + 1] = color[1];
+        }
+      break;
+    default:
+      for (i = 0; i < count; ++i)
+        {
+        outPtr[i] = lookup[static_cast<int>(inPtr[i*inIncrement])];
+        }
+    }
+}
+
 //----------------------------------------------------------------------------
 // This non-templated function executes the filter for any type of data.
 // All the data to process should be achieved outside this method as
@@ -229,6 +316,20 @@ static void vtkImageMapToColorsExecute(vtkImageMapToColors *self,
   outputFormat = self->GetOutputFormat();
   rowLength = extX*scalarSize*numberOfComponents;
 
+  // Map the colors of all the values once when there are more pixels
+  std::vector<unsigned char> table;
+  int tableSize = vtkImageMapToColorsTableSize(dataType);
+  if (tableSize > 0 &&
+      static_cast<vtkIdType>(extX)*extY*extZ > 2*tableSize)
+    {
+    switch (dataType)
+      {
+      vtkTemplateMacro(
+        vtkImageMapToColorsBuildTable(lookupTable, outputFormat, dataType,
+                                      table, static_cast<VTK_TT *>(0)));
+      }
+    }
+
   // Loop through output pixels
   outPtr1 = outPtr;
   inPtr1 = static_cast<void *>(
@@ -245,9 +346,23 @@ static void vtkImageMapToColorsExecute(vtkImageMapToColors *self,
           }
         count++;
         }
-      lookupTable->MapScalarsThroughTable2(inPtr1,outPtr1,
-                                           dataType,extX,numberOfComponents,
-                                           outputFormat);
+      if (!table.empty())
+        {
+        switch (dataType)
+          {
+          vtkTemplateMacro(
+            vtkImageMapToColorsGather(&table[0],
+                                      static_cast<VTK_TT *>(inPtr1), outPtr1,
+                                      extX, numberOfComponents,
+                                      outputFormat));
+          }
+        }
+      else
+        {
+        lookupTable->MapScalarsThroughTable2(inPtr1,outPtr1,
+                                             dataType,extX,numberOfComponents,
+                                             outputFormat);
+        }
       // Handle NaN color when mask
       if(inMask != NULL)
         {
@@ -20,6 +20,9 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTypeTraits.h"
+
+#include <vector>
 
 vtkStandardNewMacro(vtkImageShiftScale);
 
@@ -63,6 +66,74 @@ int vtkImageShiftScale::RequestInformation(vtkInformation*,
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// The number of values of the 8 and 16 bit input types, whose outputs can
+// be computed once and looked up, and zero for the other types.
+template <class IT>
+struct vtkImageShiftScaleTableSize
+{
+  enum { Value = 0 };
+};
+
+template<>
+struct vtkImageShiftScaleTableSize<char>
+{
+  enum { Value = 256 };
+};
+
+template<>
+struct vtkImageShiftScaleTableSize<signed char>
+{
+  enum { Value = 256 };
+};
+
+template<>
+struct vtkImageShiftScaleTableSize<unsigned char>
+{
+  enum { Value = 256 };
+};
+
+template<>
+struct vtkImageShiftScaleTableSize<short>
+{
+  enum { Value = 65536 };
+};
+
+template<>
+struct vtkImageShiftScaleTableSize<unsigned short>
+{
+  enum { Value = 65536 };
+};
+
+//----------------------------------------------------------------------------
+// The pixel operation on a span, written with plain pointers and selects
+// instead of branches so that the compiler can vectorize it.
+template <class IT, class OT>
+void vtkImageShiftScaleSpan(const IT *inSI, OT *outSI, vtkIdType n,
+                            double shift, double scale,
+                            double typeMin, double typeMax, int clamp)
+{
+  if (clamp)
+    {
+    for (vtkIdType i = 0; i < n; ++i)
+      {
+      double val = (static_cast<double>(inSI[i]) + shift) * scale;
+      val = (val > typeMax ? typeMax : val);
+      val = (val < typeMin ? typeMin : val);
+      outSI[i] = static_cast<OT>(val);
+      }
+    }
+  else
+    {
+    for (vtkIdType i = 0; i < n; ++i)
+      {
+      double val = (static_cast<double>(inSI[i]) + shift) * scale;
+      // NB: without clamping, this cast may result in undefined behavior!
+      outSI[i] = static_cast<OT>(val);
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 // This function template implements the filter for any type of data.
 // The last two arguments help the vtkTemplateMacro calls below
@@ -88,43 +159,44 @@ void vtkImageShiftScaleExecute(vtkImageShiftScale* self,
   double typeMax = outData->GetScalarTypeMax();
   int clamp = self->GetClampOverflow();
 
+  // When there are more pixels than input values, the output of every
+  // input value is computed once and the pixels are looked up.
+  const int tableSize = vtkImageShiftScaleTableSize<IT>::Value;
+  vtkIdType numberOfValues = static_cast<vtkIdType>(
+    outExt[1] - outExt[0] + 1)*(outExt[3] - outExt[2] + 1)*
+    (outExt[5] - outExt[4] + 1)*inData->GetNumberOfScalarComponents();
+  std::vector<OT> table;
+  if (tableSize > 0 && numberOfValues > 2*tableSize)
+    {
+    std::vector<IT> values(tableSize);
+    for (int i = 0; i < tableSize; ++i)
+      {
+      values[i] = static_cast<IT>(vtkTypeTraits<IT>::Min() + i);
+      }
+    table.resize(tableSize);
+    vtkImageShiftScaleSpan(&values[0], &table[0], tableSize,
+                           shift, scale, typeMin, typeMax, clamp);
+    }
+
   // Loop through output pixels.
   while (!outIt.IsAtEnd())
     {
     IT* inSI = inIt.BeginSpan();
     OT* outSI = outIt.BeginSpan();
-    OT* outSIEnd = outIt.EndSpan();
-    if (clamp)
+    vtkIdType n = outIt.EndSpan() - outSI;
+    if (!table.empty())
       {
-      while (outSI != outSIEnd)
+      const OT *lookup =
+        &table[0] - static_cast<int>(vtkTypeTraits<IT>::Min());
+      for (vtkIdType i = 0; i < n; ++i)
         {
-        // Pixel operation
-        double val = (static_cast<double>(*inSI) + shift) * scale;
-        if (val > typeMax)
-          {
-          val = typeMax;
-          }
-        if (val < typeMin)
-          {
-          val = typeMin;
-          }
-        *outSI = static_cast<OT>(val);
-        ++outSI;
-        ++inSI;
+        outSI[i] = lookup[static_cast<int>(inSI[i])];
         }
       }
     else
       {
-      while (outSI != outSIEnd)
-        {
-        // Pixel operation
-        double val = (static_cast<double>(*inSI) + shift) * scale;
-
-        // NB: without clamping, this cast may result in undefined behavior!
-        *outSI = static_cast<OT>(val);
-        ++outSI;
-        ++inSI;
-        }
+      vtkImageShiftScaleSpan(inSI, outSI, n, shift, scale,
+                             typeMin, typeMax, clamp);
       }
     inIt.NextSpan();
     outIt.NextSpan();
@@ -22,6 +22,7 @@
 #include "vtkDataArray.h"
 #include "vtkObjectFactory.h"
 #include "vtkMath.h"
+#include "vtkSMPTools.h"
 
 #include <cmath>
 #include <algorithm>
@@ -109,6 +110,19 @@ struct vtkImageStencilDataAndFunctor
   bool operator()(bool a, bool b) { return (a & b); }
 };
 
+// Functor that selects the second operand, for replacing the first
+// operand with the second.
+struct vtkImageStencilDataSecondFunctor
+{
+  vtkImageStencilDataSecondFunctor() :
+    not1(false), not2(false) {}
+
+  bool not1;
+  bool not2;
+
+  bool operator()(bool, bool b) { return b; }
+};
+
 // Combine extent lists "clist1" and "clist2" with "operation",
 // and place the result in "clist".  The operation is done over
 // the range [ext1, ext2].
@@ -235,6 +249,106 @@ void vtkImageStencilDataClipExtent(
   clistlen = j - i;
 }
 
+// Combine the rows of a stencil with the rows of another stencil.  The
+// operation is applied over [XRange[0],XRange[1]] for the rows within
+// the y and z range of "Range", and the sub-extents of the first stencil
+// outside of XRange are kept as they are.  Every row has its own list
+// and its own small storage, so rows are combined in parallel.
+template<typename F>
+class vtkImageStencilDataRows
+{
+public:
+  vtkImageStencilDataRows(
+    int **lists, int *listLengths, int numberOfEntries, const int extent[6],
+    int **lists2, int *listLengths2, const int extent2[6],
+    const int range[6], F operation) :
+    Lists(lists), ListLengths(listLengths),
+    SmallStore(&listLengths[numberOfEntries]), Extent(extent),
+    Lists2(lists2), ListLengths2(listLengths2), Extent2(extent2),
+    Range(range), Operation(operation) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    vtkIdType sizeY = this->Range[3] - this->Range[2] + 1;
+    vtkImageStencilDataOrFunctor copy(false, false);
+
+    for (vtkIdType row = begin; row < end; ++row)
+      {
+      int idy = this->Range[2] + static_cast<int>(row % sizeY);
+      int idz = this->Range[4] + static_cast<int>(row / sizeY);
+
+      int incr = vtkImageStencilDataIndex(this->Extent2, idy, idz);
+      int clistlen2 = this->ListLengths2[incr];
+      int *clist2 = this->Lists2[incr];
+
+      incr = vtkImageStencilDataIndex(this->Extent, idy, idz);
+      int &clistlen = this->ListLengths[incr];
+      int *&clist = this->Lists[incr];
+      int *clistsmall = &this->SmallStore[2*incr];
+
+      int clistsmall1[2];
+      int clistlen1 = clistlen;
+      int *clist1 = clist;
+      if (clist == clistsmall)
+        {
+        clistsmall1[0] = clistsmall[0];
+        clistsmall1[1] = clistsmall[1];
+        clist1 = clistsmall1;
+        }
+
+      clist = clistsmall;
+      clistlen = 0;
+
+      vtkImageStencilDataBoolean(
+        clist1, clistlen1, clist2, 0, clist, clistlen, clistsmall,
+        copy, this->Extent[0], this->Range[0] - 1);
+      vtkImageStencilDataBoolean(
+        clist1, clistlen1, clist2, clistlen2, clist, clistlen, clistsmall,
+        this->Operation, this->Range[0], this->Range[1]);
+      vtkImageStencilDataBoolean(
+        clist1, clistlen1, clist2, 0, clist, clistlen, clistsmall,
+        copy, this->Range[1] + 1, this->Extent[1]);
+
+      if (clist1 != clistsmall1)
+        {
+        delete [] clist1;
+        }
+      }
+  }
+
+private:
+  int **Lists;
+  int *ListLengths;
+  int *SmallStore;
+  const int *Extent;
+  int **Lists2;
+  int *ListLengths2;
+  const int *Extent2;
+  const int *Range;
+  F Operation;
+};
+
+// Combine the rows within "range" with vtkImageStencilDataRows.
+template<typename F>
+void vtkImageStencilDataCombineRows(
+  int **lists, int *listLengths, int numberOfEntries, const int extent[6],
+  int **lists2, int *listLengths2, const int extent2[6],
+  const int range[6], F operation)
+{
+  if (range[0] > range[1] || range[2] > range[3] || range[4] > range[5])
+    {
+    return;
+    }
+
+  vtkImageStencilDataRows<F> rows(
+    lists, listLengths, numberOfEntries, extent,
+    lists2, listLengths2, extent2, range, operation);
+
+  vtkIdType numberOfRows = range[3] - range[2] + 1;
+  numberOfRows *= range[5] - range[4] + 1;
+  vtkSMPTools::For(0, numberOfRows, rows);
+}
+
 } // end anonymous namespace
 
 //----------------------------------------------------------------------------
@@ -887,56 +1001,25 @@ void vtkImageStencilData::LogicalOperationInPlace(
       }
     }
 
-  // Iterate over the intersected extent
-  for (int idz = extent[4]; idz <= extent[5]; idz++)
-    {
-    for (int idy = extent[2]; idy <= extent[3]; idy++)
-      {
-      int incr = vtkImageStencilDataIndex(stencil->Extent, idy, idz);
-      int clistlen2 = stencil->ExtentListLengths[incr];
-      int *clist2 = stencil->ExtentLists[incr];
-
-      incr = vtkImageStencilDataIndex(this->Extent, idy, idz);
-      int &clistlen = this->ExtentListLengths[incr];
-      int *&clist = this->ExtentLists[incr];
-      int *clistsmall =
-        &this->ExtentListLengths[this->NumberOfExtentEntries + 2*incr];
-
-      int clistsmall1[2];
-      int clistlen1 = clistlen;
-      int *clist1 = clist;
-      if (clist == clistsmall)
-        {
-        clistsmall1[0] = clistsmall[0];
-        clistsmall1[1] = clistsmall[1];
-        clist1 = clistsmall1;
-        }
-
-      clist = clistsmall;
-      clistlen = 0;
-
-      if (operation == Merge)
-        {
-        vtkImageStencilDataBoolean(
-          clist1, clistlen1, clist2, clistlen2,
-          clist, clistlen, clistsmall,
-          vtkImageStencilDataOrFunctor(false, false),
-          this->Extent[0], this->Extent[1]);
-        }
-      else if (operation == Erase)
-        {
-        vtkImageStencilDataBoolean(
-          clist1, clistlen1, clist2, clistlen2,
-          clist, clistlen, clistsmall,
-          vtkImageStencilDataAndFunctor(false, true),
-          this->Extent[0], this->Extent[1]);
-        }
+  // Combine the rows of the intersected extent, over the whole x extent
+  extent[0] = this->Extent[0];
+  extent[1] = this->Extent[1];
 
-      if (clist1 != clistsmall1)
-        {
-        delete [] clist1;
-        }
-      }
+  if (operation == Merge)
+    {
+    vtkImageStencilDataCombineRows(
+      this->ExtentLists, this->ExtentListLengths,
+      this->NumberOfExtentEntries, this->Extent,
+      stencil->ExtentLists, stencil->ExtentListLengths, stencil->Extent,
+      extent, vtkImageStencilDataOrFunctor(false, false));
+    }
+  else if (operation == Erase)
+    {
+    vtkImageStencilDataCombineRows(
+      this->ExtentLists, this->ExtentListLengths,
+      this->NumberOfExtentEntries, this->Extent,
+      stencil->ExtentLists, stencil->ExtentListLengths, stencil->Extent,
+      extent, vtkImageStencilDataAndFunctor(false, true));
     }
 }
 
@@ -992,7 +1075,7 @@ void vtkImageStencilData::Subtract(vtkImageStencilData *stencil1)
 //----------------------------------------------------------------------------
 void vtkImageStencilData::Replace(vtkImageStencilData *stencil1)
 {
-  int extent[6], extent1[6], extent2[6], r1, r2, idy, idz, iter=0;
+  int extent[6], extent1[6], extent2[6];
   stencil1->GetExtent(extent1);
   this->GetExtent(extent2);
 
@@ -1012,25 +1095,12 @@ void vtkImageStencilData::Replace(vtkImageStencilData *stencil1)
   extent[4] = (extent1[4] < extent2[4]) ? extent2[4] : extent1[4];
   extent[5] = (extent1[5] > extent2[5]) ? extent2[5] : extent1[5];
 
-  for (idz=extent[4]; idz<=extent[5]; idz++, iter=0)
-    {
-    for (idy = extent[2]; idy <= extent[3]; idy++, iter=0)
-      {
-      this->RemoveExtent(extent[0], extent[1], idy, idz);
-
-      int moreSubExtents = 1;
-      while( moreSubExtents )
-        {
-        moreSubExtents = stencil1->GetNextExtent(
-          r1, r2, extent[0], extent[1], idy, idz, iter);
-
-        if (r1 <= r2 ) // sanity check
-          {
-          this->InsertAndMergeExtent(r1, r2, idy, idz);
-          }
-        }
-      }
-    }
+  // Within the intersection, the rows take the sub-extents of the stencil
+  vtkImageStencilDataCombineRows(
+    this->ExtentLists, this->ExtentListLengths,
+    this->NumberOfExtentEntries, this->Extent,
+    stencil1->ExtentLists, stencil1->ExtentListLengths, stencil1->Extent,
+    extent, vtkImageStencilDataSecondFunctor());
 
   this->Modified();
 }
@@ -58,12 +58,20 @@ public:
   vtkSetMacro(Order, int);
   vtkGetMacro(Order, int);
 
+  // Description:
+  // Set this on when the input is the half spectrum that vtkImageFFT
+  // computes with its HalfSpectrum on.  Off by default.
+  vtkSetMacro(HalfSpectrum, int);
+  vtkGetMacro(HalfSpectrum, int);
+  vtkBooleanMacro(HalfSpectrum, int);
+
 protected:
   vtkImageButterworthHighPass();
   ~vtkImageButterworthHighPass() {}
 
   int Order;
   double CutOff[3];
+  int HalfSpectrum;
 
   void ThreadedRequestData(vtkInformation *request,
                            vtkInformationVector **inputVector,
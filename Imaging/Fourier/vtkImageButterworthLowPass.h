@@ -59,12 +59,20 @@ public:
   vtkGetMacro(Order, int);
 
 
+  // Description:
+  // Set this on when the input is the half spectrum that vtkImageFFT
+  // computes with its HalfSpectrum on.  Off by default.
+  vtkSetMacro(HalfSpectrum, int);
+  vtkGetMacro(HalfSpectrum, int);
+  vtkBooleanMacro(HalfSpectrum, int);
+
 protected:
   vtkImageButterworthLowPass();
   ~vtkImageButterworthLowPass() {}
 
   int Order;
   double CutOff[3];
+  int HalfSpectrum;
 
   void ThreadedRequestData( vtkInformation *request,
                             vtkInformationVector **inputVector,
@@ -21,15 +21,38 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageFFT);
 
+//----------------------------------------------------------------------------
+vtkImageFFT::vtkImageFFT()
+{
+  this->HalfSpectrum = 0;
+}
+
 //----------------------------------------------------------------------------
 // This extent of the components changes to real and imaginary values.
+// The half spectrum also shortens the X axis to its first N/2+1 values.
 int vtkImageFFT::IterativeRequestInformation(
   vtkInformation* vtkNotUsed(input), vtkInformation* output)
 {
   vtkDataObject::SetPointDataActiveScalarInfo(output, VTK_DOUBLE, 2);
+
+  if (this->HalfSpectrum && this->Iteration == 0)
+    {
+    int wExt[6];
+    output->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wExt);
+    int size = wExt[1] - wExt[0] + 1;
+    if (size % 2)
+      {
+      vtkErrorMacro("HalfSpectrum needs an even X dimension, not " << size);
+      return 0;
+      }
+    wExt[1] = wExt[0] + size/2;
+    output->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wExt, 6);
+    }
+
   return 1;
 }
 
@@ -59,15 +82,16 @@ int vtkImageFFT::IterativeRequestUpdateExtent(
 
 //----------------------------------------------------------------------------
 // This templated execute method handles any type input, but the output
-// is always doubles.
+// is always doubles.  Rows are transformed in batches.  A real input has
+// its X axis transformed as real rows, whose spectra are completed by
+// symmetry unless the half spectrum is requested.
 template <class T>
 void vtkImageFFTExecute(vtkImageFFT *self,
                         vtkImageData *inData, int inExt[6], T *inPtr,
                         vtkImageData *outData, int outExt[6], double *outPtr,
                         int id)
 {
-  vtkImageComplex *inComplex;
-  vtkImageComplex *outComplex;
+  const int batchSize = 16;
   vtkImageComplex *pComplex;
   //
   int inMin0, inMax0;
@@ -79,6 +103,7 @@ void vtkImageFFTExecute(vtkImageFFT *self,
   double *outPtr0, *outPtr1, *outPtr2;
   //
   int idx0, idx1, idx2, inSize0, numberOfComponents;
+  int row, numberOfRows;
   unsigned long count = 0;
   unsigned long target;
   double startProgress;
@@ -102,9 +127,14 @@ void vtkImageFFTExecute(vtkImageFFT *self,
     return;
     }
 
+  bool realRows = (self->GetIteration() == 0 && numberOfComponents == 1 &&
+                   inSize0 % 2 == 0);
+  int outStride = (realRows ? inSize0/2 + 1 : inSize0);
+
   // Allocate the arrays of complex numbers
-  inComplex = new vtkImageComplex[inSize0];
-  outComplex = new vtkImageComplex[inSize0];
+  std::vector<vtkImageComplex> inComplex(realRows ? 0 : batchSize*inSize0);
+  std::vector<double> inReal(realRows ? batchSize*inSize0 : 0);
+  std::vector<vtkImageComplex> outComplex(batchSize*outStride);
 
   target = static_cast<unsigned long>((outMax2-outMin2+1)*(outMax1-outMin1+1)
                                       * self->GetNumberOfIterations() / 50.0);
@@ -117,53 +147,91 @@ void vtkImageFFTExecute(vtkImageFFT *self,
     {
     inPtr1 = inPtr2;
     outPtr1 = outPtr2;
-    for (idx1 = outMin1; !self->AbortExecute && idx1 <= outMax1; ++idx1)
+    for (idx1 = outMin1; !self->AbortExecute && idx1 <= outMax1;
+         idx1 += numberOfRows)
       {
-      if (!id)
+      numberOfRows = outMax1 - idx1 + 1;
+      if (numberOfRows > batchSize)
         {
-        if (!(count%target))
-          {
-          self->UpdateProgress(count/(50.0*target) + startProgress);
-          }
-        count++;
+        numberOfRows = batchSize;
         }
-      // copy into complex numbers
-      inPtr0 = inPtr1;
-      pComplex = inComplex;
-      for (idx0 = inMin0; idx0 <= inMax0; ++idx0)
+
+      // copy into real or complex numbers
+      for (row = 0; row < numberOfRows; ++row)
         {
-        pComplex->Real = static_cast<double>(*inPtr0);
-        pComplex->Imag = 0.0;
-        if (numberOfComponents > 1)
-          { // yes we have an imaginary input
-          pComplex->Imag = static_cast<double>(inPtr0[1]);;
+        if (!id)
+          {
+          if (!(count%target))
+            {
+            self->UpdateProgress(count/(50.0*target) + startProgress);
+            }
+          count++;
+          }
+        inPtr0 = inPtr1 + row*inInc1;
+        if (realRows)
+          {
+          double *pReal = &inReal[row*inSize0];
+          for (idx0 = inMin0; idx0 <= inMax0; ++idx0)
+            {
+            *pReal++ = static_cast<double>(*inPtr0);
+            inPtr0 += inInc0;
+            }
+          continue;
+          }
+        pComplex = &inComplex[row*inSize0];
+        for (idx0 = inMin0; idx0 <= inMax0; ++idx0)
+          {
+          pComplex->Real = static_cast<double>(*inPtr0);
+          pComplex->Imag = 0.0;
+          if (numberOfComponents > 1)
+            { // yes we have an imaginary input
+            pComplex->Imag = static_cast<double>(inPtr0[1]);
+            }
+          inPtr0 += inInc0;
+          ++pComplex;
           }
-        inPtr0 += inInc0;
-        ++pComplex;
         }
 
       // Call the method that performs the fft
-      self->ExecuteFft(inComplex, outComplex, inSize0);
+      if (realRows)
+        {
+        self->ExecuteRealFftRows(&inReal[0], &outComplex[0], inSize0,
+                                 numberOfRows);
+        }
+      else
+        {
+        self->ExecuteFftRows(&inComplex[0], &outComplex[0], inSize0,
+                             numberOfRows);
+        }
 
-      // copy into output
-      outPtr0 = outPtr1;
-      pComplex = outComplex + (outMin0 - inMin0);
-      for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
+      // copy into output, the values past N/2 of real rows being the
+      // conjugates of the values before
+      for (row = 0; row < numberOfRows; ++row)
         {
-        *outPtr0 = static_cast<double>(pComplex->Real);
-        outPtr0[1] = static_cast<double>(pComplex->Imag);
-        outPtr0 += outInc0;
-        ++pComplex;
+        outPtr0 = outPtr1 + row*outInc1;
+        pComplex = &outComplex[row*outStride];
+        for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
+          {
+          int k = idx0 - inMin0;
+          if (k < outStride)
+            {
+            *outPtr0 = pComplex[k].Real;
+            outPtr0[1] = pComplex[k].Imag;
+            }
+          else
+            {
+            *outPtr0 = pComplex[inSize0 - k].Real;
+            outPtr0[1] = -pComplex[inSize0 - k].Imag;
+            }
+          outPtr0 += outInc0;
+          }
         }
-      inPtr1 += inInc1;
-      outPtr1 += outInc1;
+      inPtr1 += numberOfRows*inInc1;
+      outPtr1 += numberOfRows*outInc1;
       }
     inPtr2 += inInc2;
     outPtr2 += outInc2;
     }
-
-  delete [] inComplex;
-  delete [] outComplex;
 }
 
 
@@ -206,6 +274,15 @@ void vtkImageFFT::ThreadedRequestData(
     return;
     }
 
+  // the half spectrum is that of a real input
+  if (this->HalfSpectrum && this->Iteration == 0 &&
+      inData->GetNumberOfScalarComponents() != 1)
+    {
+    vtkErrorMacro(<< "Execute: HalfSpectrum needs a real input, with one "
+                  "component");
+    return;
+    }
+
   // choose which templated function to call.
   switch (inData->GetScalarType())
     {
@@ -289,6 +366,15 @@ int vtkImageFFT::SplitExtent(int splitExt[6], int startExt[6],
   return total;
 }
 
+//----------------------------------------------------------------------------
+void vtkImageFFT::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "HalfSpectrum: "
+     << (this->HalfSpectrum ? "On\n" : "Off\n");
+}
+
 
 
 
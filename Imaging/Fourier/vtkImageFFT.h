@@ -20,8 +20,16 @@
 // imaginary values in component1.  The filter is fastest for images that
 // have power of two sizes.  The filter uses a butterfly diagram for each
 // prime factor of the dimension.  This makes images with prime number dimensions
-// (i.e. 17x17) much slower to compute.  Multi dimensional (i.e volumes)
-// FFT's are decomposed so that each axis executes serially.
+// (i.e. 17x17) much slower to compute, although dimensions with large prime
+// factors are computed as convolutions of power of two sizes (Bluestein's
+// algorithm).  Multi dimensional (i.e volumes) FFT's are decomposed so that
+// each axis executes serially.
+//
+// The X axis of a real input (one component) is transformed as real rows,
+// at about half the cost.  With HalfSpectrum on, only the first N/2+1
+// values of the X axis, of even size N, are output, as the others are the
+// complex conjugates of these.  vtkImageRFFT and the pass filters accept
+// such a half spectrum when their HalfSpectrum is on.
 
 
 #ifndef vtkImageFFT_h
@@ -36,6 +44,14 @@ class VTKIMAGINGFOURIER_EXPORT vtkImageFFT : public vtkImageFourierFilter
 public:
   static vtkImageFFT *New();
   vtkTypeMacro(vtkImageFFT,vtkImageFourierFilter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Output only the first N/2+1 values along X, for real inputs with an
+  // even X dimension N.  Off by default.
+  vtkSetMacro(HalfSpectrum, int);
+  vtkGetMacro(HalfSpectrum, int);
+  vtkBooleanMacro(HalfSpectrum, int);
 
 
   // Description:
@@ -50,9 +66,11 @@ public:
                   int num, int total);
 
 protected:
-  vtkImageFFT() {}
+  vtkImageFFT();
   ~vtkImageFFT() {}
 
+  int HalfSpectrum;
+
   virtual int IterativeRequestInformation(vtkInformation* in,
                                           vtkInformation* out);
   virtual int IterativeRequestUpdateExtent(vtkInformation* in,
@@ -16,6 +16,7 @@
 
 #include "vtkMath.h"
 #include <cmath>
+#include <vector>
 
 /*=========================================================================
         Vectors of complex numbers.
@@ -142,6 +143,38 @@ void vtkImageFourierFilter::ExecuteFftStepN(vtkImageComplex *p_in,
 
 
 
+//----------------------------------------------------------------------------
+// The butterflies cost about 2N times the sum of the prime factors of N,
+// so that lengths with a large prime factor are better transformed as a
+// convolution (Bluestein's chirp z-transform), which costs two transforms
+// of the power of two M >= 2N-1 once the chirp is set up.
+static bool vtkImageFourierFilterUseBluestein(int N)
+{
+  int rest = N;
+  int sum = 0;
+  for (int n = 2; n*n <= rest; ++n)
+    {
+    while (rest % n == 0)
+      {
+      sum += n;
+      rest /= n;
+      }
+    }
+  if (rest > 1)
+    {
+    sum += rest;
+    }
+
+  int M = 1;
+  int logM = 0;
+  while (M < 2*N - 1)
+    {
+    M *= 2;
+    ++logM;
+    }
+  return static_cast<double>(N)*sum > 2.0*M*logM + 1.5*M;
+}
+
 //----------------------------------------------------------------------------
 // This function calculates the whole fft (or rfft) of an array.
 // The contents of the input array are changed.
@@ -168,6 +201,11 @@ void vtkImageFourierFilter::ExecuteFftForwardBackward(vtkImageComplex *in,
       ++p1;
       }
     }
+  if(vtkImageFourierFilterUseBluestein(N))
+    {
+    this->ExecuteFftBluestein(in, out, N, 1, fb);
+    return;
+    }
   p1 = in;
   p2 = out;
   while(block_size < N && n <= N)
@@ -228,4 +266,212 @@ void vtkImageFourierFilter::ExecuteRfft(vtkImageComplex *in,
   this->ExecuteFftForwardBackward(in, out, N, -1);
 }
 
+//----------------------------------------------------------------------------
+// Transforms numberOfRows rows of length N with Bluestein's algorithm, the
+// reverse ones being already scaled: with w[k] = exp(-i*pi*fb*k^2/N),
+// out[k] = w[k] * sum_n (in[n]*w[n]) * conj(w[k-n]), a convolution that is
+// computed with power of two transforms.  The chirp and the transform of
+// conj(w) are shared by all the rows.
+void vtkImageFourierFilter::ExecuteFftBluestein(vtkImageComplex *in,
+                                                vtkImageComplex *out,
+                                                int N, int numberOfRows,
+                                                int fb)
+{
+  int M = 1;
+  while (M < 2*N - 1)
+    {
+    M *= 2;
+    }
+
+  // k^2 is reduced modulo 2N to keep the angles accurate
+  std::vector<vtkImageComplex> chirp(N);
+  vtkTypeInt64 twoN = 2*static_cast<vtkTypeInt64>(N);
+  int k;
+  for (k = 0; k < N; ++k)
+    {
+    vtkTypeInt64 k2 = (static_cast<vtkTypeInt64>(k)*k) % twoN;
+    double angle = -vtkMath::Pi()*fb*static_cast<double>(k2)/N;
+    chirp[k].Real = cos(angle);
+    chirp[k].Imag = sin(angle);
+    }
+
+  std::vector<vtkImageComplex> a(M);
+  std::vector<vtkImageComplex> b(M);
+  std::vector<vtkImageComplex> filter(M);
+  for (k = 0; k < M; ++k)
+    {
+    a[k].Real = a[k].Imag = 0.0;
+    }
+  vtkImageComplexConjugate(chirp[0], a[0]);
+  for (k = 1; k < N; ++k)
+    {
+    vtkImageComplexConjugate(chirp[k], a[k]);
+    a[M - k] = a[k];
+    }
+  this->ExecuteFftForwardBackward(&a[0], &filter[0], M, 1);
+
+  for (int row = 0; row < numberOfRows; ++row)
+    {
+    vtkImageComplex *rowIn = in + static_cast<vtkIdType>(row)*N;
+    vtkImageComplex *rowOut = out + static_cast<vtkIdType>(row)*N;
+    for (k = 0; k < N; ++k)
+      {
+      vtkImageComplexMultiply(rowIn[k], chirp[k], a[k]);
+      }
+    for (k = N; k < M; ++k)
+      {
+      a[k].Real = a[k].Imag = 0.0;
+      }
+    this->ExecuteFftForwardBackward(&a[0], &b[0], M, 1);
+    for (k = 0; k < M; ++k)
+      {
+      vtkImageComplexMultiply(b[k], filter[k], b[k]);
+      }
+    this->ExecuteFftForwardBackward(&b[0], &a[0], M, -1);
+    for (k = 0; k < N; ++k)
+      {
+      vtkImageComplexMultiply(a[k], chirp[k], rowOut[k]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Transforms numberOfRows rows of length N stored one after the other.
+void vtkImageFourierFilter::ExecuteFftRowsForwardBackward(
+  vtkImageComplex *in, vtkImageComplex *out, int N, int numberOfRows, int fb)
+{
+  if (vtkImageFourierFilterUseBluestein(N))
+    {
+    if (fb == -1)
+      {
+      vtkIdType size = static_cast<vtkIdType>(N)*numberOfRows;
+      for (vtkIdType idx = 0; idx < size; ++idx)
+        {
+        in[idx].Real /= N;
+        in[idx].Imag /= N;
+        }
+      }
+    this->ExecuteFftBluestein(in, out, N, numberOfRows, fb);
+    return;
+    }
+
+  for (int row = 0; row < numberOfRows; ++row)
+    {
+    this->ExecuteFftForwardBackward(in + static_cast<vtkIdType>(row)*N,
+                                    out + static_cast<vtkIdType>(row)*N,
+                                    N, fb);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFourierFilter::ExecuteFftRows(vtkImageComplex *in,
+                                           vtkImageComplex *out, int N,
+                                           int numberOfRows)
+{
+  this->ExecuteFftRowsForwardBackward(in, out, N, numberOfRows, 1);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFourierFilter::ExecuteRfftRows(vtkImageComplex *in,
+                                            vtkImageComplex *out, int N,
+                                            int numberOfRows)
+{
+  this->ExecuteFftRowsForwardBackward(in, out, N, numberOfRows, -1);
+}
+
+//----------------------------------------------------------------------------
+// The even and odd samples of a real row of length N = 2M are packed into
+// the real and imaginary parts of a complex row of length M, whose
+// transform Z gives the transforms E and O of the even and odd samples:
+// E[k] = (Z[k] + conj(Z[M-k]))/2, O[k] = (Z[k] - conj(Z[M-k]))/2i, and
+// X[k] = E[k] + exp(-2i*pi*k/N) O[k] for k = 0..M.
+void vtkImageFourierFilter::ExecuteRealFftRows(double *in,
+                                               vtkImageComplex *out,
+                                               int N, int numberOfRows)
+{
+  int M = N/2;
+  vtkIdType size = static_cast<vtkIdType>(M)*numberOfRows;
+  std::vector<vtkImageComplex> z(size);
+  std::vector<vtkImageComplex> Z(size);
+  for (vtkIdType idx = 0; idx < size; ++idx)
+    {
+    z[idx].Real = in[2*idx];
+    z[idx].Imag = in[2*idx + 1];
+    }
+  this->ExecuteFftRowsForwardBackward(&z[0], &Z[0], M, numberOfRows, 1);
+
+  std::vector<vtkImageComplex> twiddle(M + 1);
+  int k;
+  for (k = 0; k <= M; ++k)
+    {
+    double angle = -2.0*vtkMath::Pi()*k/N;
+    twiddle[k].Real = cos(angle);
+    twiddle[k].Imag = sin(angle);
+    }
+
+  for (int row = 0; row < numberOfRows; ++row)
+    {
+    const vtkImageComplex *rowZ = &Z[0] + static_cast<vtkIdType>(row)*M;
+    vtkImageComplex *rowOut = out + static_cast<vtkIdType>(row)*(M + 1);
+    for (k = 0; k <= M; ++k)
+      {
+      vtkImageComplex zk = rowZ[k % M];
+      vtkImageComplex zc, e, o, temp;
+      vtkImageComplexConjugate(rowZ[(M - k) % M], zc);
+      e.Real = 0.5*(zk.Real + zc.Real);
+      e.Imag = 0.5*(zk.Imag + zc.Imag);
+      o.Real = 0.5*(zk.Imag - zc.Imag);
+      o.Imag = -0.5*(zk.Real - zc.Real);
+      vtkImageComplexMultiply(twiddle[k], o, temp);
+      vtkImageComplexAdd(e, temp, rowOut[k]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// The reverse of the above: E[k] = (X[k] + conj(X[M-k]))/2 and
+// O[k] = (X[k] - conj(X[M-k])) exp(2i*pi*k/N)/2 give Z[k] = E[k] + i O[k],
+// whose reverse transform holds the even and odd samples.
+void vtkImageFourierFilter::ExecuteRealRfftRows(vtkImageComplex *in,
+                                                double *out,
+                                                int N, int numberOfRows)
+{
+  int M = N/2;
+  vtkIdType size = static_cast<vtkIdType>(M)*numberOfRows;
+  std::vector<vtkImageComplex> Z(size);
+  std::vector<vtkImageComplex> z(size);
+
+  std::vector<vtkImageComplex> twiddle(M);
+  int k;
+  for (k = 0; k < M; ++k)
+    {
+    double angle = 2.0*vtkMath::Pi()*k/N;
+    twiddle[k].Real = cos(angle);
+    twiddle[k].Imag = sin(angle);
+    }
 
+  for (int row = 0; row < numberOfRows; ++row)
+    {
+    const vtkImageComplex *rowIn = in + static_cast<vtkIdType>(row)*(M + 1);
+    vtkImageComplex *rowZ = &Z[0] + static_cast<vtkIdType>(row)*M;
+    for (k = 0; k < M; ++k)
+      {
+      vtkImageComplex xc, e, d, o;
+      vtkImageComplexConjugate(rowIn[M - k], xc);
+      e.Real = 0.5*(rowIn[k].Real + xc.Real);
+      e.Imag = 0.5*(rowIn[k].Imag + xc.Imag);
+      d.Real = 0.5*(rowIn[k].Real - xc.Real);
+      d.Imag = 0.5*(rowIn[k].Imag - xc.Imag);
+      vtkImageComplexMultiply(d, twiddle[k], o);
+      rowZ[k].Real = e.Real - o.Imag;
+      rowZ[k].Imag = e.Imag + o.Real;
+      }
+    }
+  this->ExecuteFftRowsForwardBackward(&Z[0], &z[0], M, numberOfRows, -1);
+
+  for (vtkIdType idx = 0; idx < size; ++idx)
+    {
+    out[2*idx] = z[idx].Real;
+    out[2*idx + 1] = z[idx].Imag;
+    }
+}
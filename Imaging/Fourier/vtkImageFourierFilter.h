@@ -106,6 +106,25 @@ public:
   // (It is engineered for no decimation)
   void ExecuteRfft(vtkImageComplex *in, vtkImageComplex *out, int N);
 
+  // Description:
+  // These functions transform numberOfRows arrays of length N stored one
+  // after the other, so that the set up of lengths with large prime
+  // factors is shared.  The contents of the input arrays are changed.
+  void ExecuteFftRows(vtkImageComplex *in, vtkImageComplex *out, int N,
+                      int numberOfRows);
+  void ExecuteRfftRows(vtkImageComplex *in, vtkImageComplex *out, int N,
+                       int numberOfRows);
+
+  // Description:
+  // These functions transform real arrays of even length N into the
+  // N/2+1 first values of their spectra, the other values being the
+  // complex conjugates of these, and back.  They cost about half as much
+  // as the complex transforms.
+  void ExecuteRealFftRows(double *in, vtkImageComplex *out, int N,
+                          int numberOfRows);
+  void ExecuteRealRfftRows(vtkImageComplex *in, double *out, int N,
+                           int numberOfRows);
+
   //ETX
 
 protected:
@@ -119,6 +138,11 @@ protected:
                        int N, int bsize, int n, int fb);
   void ExecuteFftForwardBackward(vtkImageComplex *in, vtkImageComplex *out,
                                  int N, int fb);
+  void ExecuteFftRowsForwardBackward(vtkImageComplex *in,
+                                     vtkImageComplex *out,
+                                     int N, int numberOfRows, int fb);
+  void ExecuteFftBluestein(vtkImageComplex *in, vtkImageComplex *out,
+                           int N, int numberOfRows, int fb);
   //ETX
 private:
   vtkImageFourierFilter(const vtkImageFourierFilter&);  // Not implemented.
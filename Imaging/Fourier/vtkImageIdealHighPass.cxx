@@ -27,6 +27,7 @@ vtkStandardNewMacro(vtkImageIdealHighPass);
 vtkImageIdealHighPass::vtkImageIdealHighPass()
 {
   this->CutOff[0] = this->CutOff[1] = this->CutOff[2] = VTK_DOUBLE_MAX;
+  this->HalfSpectrum = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -113,7 +114,14 @@ void vtkImageIdealHighPass::ThreadedRequestData(
 
   min0 = ext[0];
   max0 = ext[1];
-  mid0 = static_cast<double>(wholeExtent[0] + wholeExtent[1] + 1) / 2.0;
+  if (this->HalfSpectrum)
+    { // only the frequencies up to the middle are along X
+    mid0 = static_cast<double>(wholeExtent[1]);
+    }
+  else
+    {
+    mid0 = static_cast<double>(wholeExtent[0] + wholeExtent[1] + 1) / 2.0;
+    }
   mid1 = static_cast<double>(wholeExtent[2] + wholeExtent[3] + 1) / 2.0;
   mid2 = static_cast<double>(wholeExtent[4] + wholeExtent[5] + 1) / 2.0;
   if ( this->CutOff[0] == 0.0)
@@ -225,4 +233,7 @@ void vtkImageIdealHighPass::PrintSelf(ostream& os, vtkIndent indent)
      << this->CutOff[0] << ", "
      << this->CutOff[1] << ", "
      << this->CutOff[2] << " )\n";
+
+  os << indent << "HalfSpectrum: "
+     << (this->HalfSpectrum ? "On\n" : "Off\n");
 }
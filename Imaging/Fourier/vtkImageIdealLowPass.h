@@ -55,11 +55,19 @@ public:
   double GetYCutOff() {return this->CutOff[1];}
   double GetZCutOff() {return this->CutOff[2];}
 
+  // Description:
+  // Set this on when the input is the half spectrum that vtkImageFFT
+  // computes with its HalfSpectrum on.  Off by default.
+  vtkSetMacro(HalfSpectrum, int);
+  vtkGetMacro(HalfSpectrum, int);
+  vtkBooleanMacro(HalfSpectrum, int);
+
 protected:
   vtkImageIdealLowPass();
   ~vtkImageIdealLowPass() {}
 
   double CutOff[3];
+  int HalfSpectrum;
 
   void ThreadedRequestData(vtkInformation *request,
                            vtkInformationVector **inputVector,
@@ -21,14 +21,45 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageRFFT);
 
+//----------------------------------------------------------------------------
+vtkImageRFFT::vtkImageRFFT()
+{
+  this->HalfSpectrum = 0;
+}
+
+//----------------------------------------------------------------------------
+// A half spectrum is transformed along X last, so that the real rows of the
+// output are transformed from complete spectra.
+int vtkImageRFFT::GetIterationAxis()
+{
+  if (this->HalfSpectrum)
+    {
+    return this->Dimensionality - 1 - this->Iteration;
+    }
+  return this->Iteration;
+}
+
 //----------------------------------------------------------------------------
 // This extent of the components changes to real and imaginary values.
+// The transform of a half spectrum along X gives real values, on an X axis
+// of size 2(n-1) for n input values.
 int vtkImageRFFT::IterativeRequestInformation(
   vtkInformation* vtkNotUsed(input), vtkInformation* output)
 {
+  if (this->HalfSpectrum && this->GetIterationAxis() == 0)
+    {
+    int wExt[6];
+    output->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wExt);
+    wExt[1] = wExt[0] + 2*(wExt[1] - wExt[0]) - 1;
+    output->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wExt, 6);
+    vtkDataObject::SetPointDataActiveScalarInfo(output, VTK_DOUBLE, 1);
+    return 1;
+    }
+
   vtkDataObject::SetPointDataActiveScalarInfo(output, VTK_DOUBLE, 2);
   return 1;
 }
@@ -52,7 +83,8 @@ int vtkImageRFFT::IterativeRequestUpdateExtent(
   int *outExt = output->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT());
   int *wExt = input->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
   int inExt[6];
-  vtkImageRFFTInternalRequestUpdateExtent(inExt,outExt,wExt,this->Iteration);
+  vtkImageRFFTInternalRequestUpdateExtent(inExt,outExt,wExt,
+                                          this->GetIterationAxis());
   input->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),inExt,6);
 
   return 1;
@@ -60,15 +92,15 @@ int vtkImageRFFT::IterativeRequestUpdateExtent(
 
 //----------------------------------------------------------------------------
 // This templated execute method handles any type input, but the output
-// is always doubles.
+// is always doubles.  Rows are transformed in batches, and the rows of a
+// half spectrum into real rows.
 template <class T>
 void vtkImageRFFTExecute(vtkImageRFFT *self,
                          vtkImageData *inData, int inExt[6], T *inPtr,
                          vtkImageData *outData, int outExt[6], double *outPtr,
                          int id)
 {
-  vtkImageComplex *inComplex;
-  vtkImageComplex *outComplex;
+  const int batchSize = 16;
   vtkImageComplex *pComplex;
   //
   int inMin0, inMax0;
@@ -80,6 +112,7 @@ void vtkImageRFFTExecute(vtkImageRFFT *self,
   double *outPtr0, *outPtr1, *outPtr2;
   //
   int idx0, idx1, idx2, inSize0, numberOfComponents;
+  int row, numberOfRows;
   unsigned long count = 0;
   unsigned long target;
   double startProgress;
@@ -103,9 +136,13 @@ void vtkImageRFFTExecute(vtkImageRFFT *self,
     return;
     }
 
+  bool realRows = (self->GetHalfSpectrum() && self->GetIterationAxis() == 0);
+  int outSize0 = (realRows ? 2*(inSize0 - 1) : inSize0);
+
   // Allocate the arrays of complex numbers
-  inComplex = new vtkImageComplex[inSize0];
-  outComplex = new vtkImageComplex[inSize0];
+  std::vector<vtkImageComplex> inComplex(batchSize*inSize0);
+  std::vector<vtkImageComplex> outComplex(realRows ? 0 : batchSize*inSize0);
+  std::vector<double> outReal(realRows ? batchSize*outSize0 : 0);
 
   target = static_cast<unsigned long>((outMax2-outMin2+1)*(outMax1-outMin1+1)
                                       * self->GetNumberOfIterations() / 50.0);
@@ -118,53 +155,82 @@ void vtkImageRFFTExecute(vtkImageRFFT *self,
     {
     inPtr1 = inPtr2;
     outPtr1 = outPtr2;
-    for (idx1 = outMin1; !self->AbortExecute && idx1 <= outMax1; ++idx1)
+    for (idx1 = outMin1; !self->AbortExecute && idx1 <= outMax1;
+         idx1 += numberOfRows)
       {
-      if (!id)
+      numberOfRows = outMax1 - idx1 + 1;
+      if (numberOfRows > batchSize)
         {
-        if (!(count%target))
-          {
-          self->UpdateProgress(count/(50.0*target) + startProgress);
-          }
-        count++;
+        numberOfRows = batchSize;
         }
+
       // copy into complex numbers
-      inPtr0 = inPtr1;
-      pComplex = inComplex;
-      for (idx0 = inMin0; idx0 <= inMax0; ++idx0)
+      for (row = 0; row < numberOfRows; ++row)
         {
-        pComplex->Real = static_cast<double>(*inPtr0);
-        pComplex->Imag = 0.0;
-        if (numberOfComponents > 1)
-          { // yes we have an imaginary input
-          pComplex->Imag = static_cast<double>(inPtr0[1]);;
+        if (!id)
+          {
+          if (!(count%target))
+            {
+            self->UpdateProgress(count/(50.0*target) + startProgress);
+            }
+          count++;
+          }
+        inPtr0 = inPtr1 + row*inInc1;
+        pComplex = &inComplex[row*inSize0];
+        for (idx0 = inMin0; idx0 <= inMax0; ++idx0)
+          {
+          pComplex->Real = static_cast<double>(*inPtr0);
+          pComplex->Imag = 0.0;
+          if (numberOfComponents > 1)
+            { // yes we have an imaginary input
+            pComplex->Imag = static_cast<double>(inPtr0[1]);
+            }
+          inPtr0 += inInc0;
+          ++pComplex;
           }
-        inPtr0 += inInc0;
-        ++pComplex;
         }
 
       // Call the method that performs the RFFT
-      self->ExecuteRfft(inComplex, outComplex, inSize0);
+      if (realRows)
+        {
+        self->ExecuteRealRfftRows(&inComplex[0], &outReal[0], outSize0,
+                                  numberOfRows);
+        }
+      else
+        {
+        self->ExecuteRfftRows(&inComplex[0], &outComplex[0], inSize0,
+                              numberOfRows);
+        }
 
       // copy into output
-      outPtr0 = outPtr1;
-      pComplex = outComplex + (outMin0 - inMin0);
-      for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
+      for (row = 0; row < numberOfRows; ++row)
         {
-        *outPtr0 = static_cast<double>(pComplex->Real);
-        outPtr0[1] = static_cast<double>(pComplex->Imag);
-        outPtr0 += outInc0;
-        ++pComplex;
+        outPtr0 = outPtr1 + row*outInc1;
+        if (realRows)
+          {
+          double *pReal = &outReal[row*outSize0] + (outMin0 - inMin0);
+          for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
+            {
+            *outPtr0 = *pReal++;
+            outPtr0 += outInc0;
+            }
+          continue;
+          }
+        pComplex = &outComplex[row*inSize0] + (outMin0 - inMin0);
+        for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
+          {
+          *outPtr0 = pComplex->Real;
+          outPtr0[1] = pComplex->Imag;
+          outPtr0 += outInc0;
+          ++pComplex;
+          }
         }
-      inPtr1 += inInc1;
-      outPtr1 += outInc1;
+      inPtr1 += numberOfRows*inInc1;
+      outPtr1 += numberOfRows*outInc1;
       }
     inPtr2 += inInc2;
     outPtr2 += outInc2;
     }
-
-  delete [] inComplex;
-  delete [] outComplex;
 }
 
 
@@ -190,7 +256,8 @@ void vtkImageRFFT::ThreadedRequestData(
 
   int *wExt = inputVector[0]->GetInformationObject(0)->Get(
     vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
-  vtkImageRFFTInternalRequestUpdateExtent(inExt,outExt,wExt,this->Iteration);
+  vtkImageRFFTInternalRequestUpdateExtent(inExt,outExt,wExt,
+                                          this->GetIterationAxis());
   inPtr = inData->GetScalarPointerForExtent(inExt);
   outPtr = outData->GetScalarPointerForExtent(outExt);
 
@@ -248,7 +315,7 @@ int vtkImageRFFT::SplitExtent(int splitExt[6], int startExt[6],
   splitAxis = 2;
   min = startExt[4];
   max = startExt[5];
-  while ((splitAxis == this->Iteration) || (min == max))
+  while ((splitAxis == this->GetIterationAxis()) || (min == max))
     {
     splitAxis--;
     if (splitAxis < 0)
@@ -291,6 +358,15 @@ int vtkImageRFFT::SplitExtent(int splitExt[6], int startExt[6],
   return total;
 }
 
+//----------------------------------------------------------------------------
+void vtkImageRFFT::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "HalfSpectrum: "
+     << (this->HalfSpectrum ? "On\n" : "Off\n");
+}
+
 
 
 
@@ -25,6 +25,11 @@
 // In most cases the RFFT will produce an image whose imaginary values are all
 // zero's. In this case vtkImageExtractComponents can be used to remove
 // this imaginary components leaving only the real image.
+//
+// With HalfSpectrum on, the input is the half spectrum that vtkImageFFT
+// computes with its HalfSpectrum on: n values along X stand for a real
+// image with 2(n-1) values along X, which is the output, with one real
+// component.
 
 // .SECTION See Also
 // vtkImageExtractComponenents
@@ -43,7 +48,17 @@ class VTKIMAGINGFOURIER_EXPORT vtkImageRFFT : public vtkImageFourierFilter
 public:
   static vtkImageRFFT *New();
   vtkTypeMacro(vtkImageRFFT,vtkImageFourierFilter);
+  void PrintSelf(ostream& os, vtkIndent indent);
 
+  // Description:
+  // Transform a half spectrum along X into a real image.  Off by default.
+  vtkSetMacro(HalfSpectrum, int);
+  vtkGetMacro(HalfSpectrum, int);
+  vtkBooleanMacro(HalfSpectrum, int);
+
+  // Description:
+  // A half spectrum is transformed along X after the other axes.
+  virtual int GetIterationAxis();
 
   // Description:
   // For streaming and threads.  Splits output update extent into num pieces.
@@ -56,9 +71,11 @@ public:
                   int num, int total);
 
 protected:
-  vtkImageRFFT() {}
+  vtkImageRFFT();
   ~vtkImageRFFT() {}
 
+  int HalfSpectrum;
+
   virtual int IterativeRequestInformation(vtkInformation* in,
                                           vtkInformation* out);
   virtual int IterativeRequestUpdateExtent(vtkInformation* in,
@@ -18,10 +18,139 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 vtkStandardNewMacro(vtkImageCityBlockDistance);
 
+//----------------------------------------------------------------------------
+// The forward and backward passes along the rows of the current axis.  Each
+// row only depends on itself, so that rows are processed in parallel.
+class vtkImageCityBlockDistanceRows
+{
+public:
+  vtkImageCityBlockDistanceRows(short *inPtr, short *outPtr,
+                                vtkIdType inInc0, vtkIdType inInc1,
+                                vtkIdType inInc2, vtkIdType outInc0,
+                                vtkIdType outInc1, vtkIdType outInc2,
+                                int size0, int size1,
+                                int numberOfComponents) :
+    InPtr(inPtr), OutPtr(outPtr), InInc0(inInc0), InInc1(inInc1),
+    InInc2(inInc2), OutInc0(outInc0), OutInc1(outInc1), OutInc2(outInc2),
+    Size0(size0), Size1(size1), NumberOfComponents(numberOfComponents) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    short *inPtr0, *inPtrC;
+    short *outPtr0, *outPtrC;
+    int idx0, idxC;
+    short distP, distN;
+    short big = 2000;
+
+    for (vtkIdType row = begin; row < end; ++row)
+      {
+      vtkIdType idx1 = row % this->Size1;
+      vtkIdType idx2 = row / this->Size1;
+      inPtrC = this->InPtr + idx1*this->InInc1 + idx2*this->InInc2;
+      outPtrC = this->OutPtr + idx1*this->OutInc1 + idx2*this->OutInc2;
+      for (idxC = 0; idxC < this->NumberOfComponents; ++idxC)
+        {
+        // execute forward pass
+        distP = big;
+        distN = -big;
+        inPtr0 = inPtrC;
+        outPtr0 = outPtrC;
+        for (idx0 = 0; idx0 < this->Size0; ++idx0)
+          { // preserve sign
+          if (*inPtr0 >= 0)
+            {
+            distN = 0;
+            if (distP > *inPtr0)
+              {
+              distP = *inPtr0;
+              }
+            *outPtr0 = distP;
+            }
+          if (*inPtr0 <= 0)
+            {
+            distP = 0;
+            if (distN < *inPtr0)
+              {
+              distN = *inPtr0;
+              }
+            *outPtr0 = distN;
+            }
+
+          if (distP < big)
+            {
+            ++distP;
+            }
+          if (distN > -big)
+            {
+            --distN;
+            }
+
+          inPtr0 += this->InInc0;
+          outPtr0 += this->OutInc0;
+          }
+
+        // backward pass
+        distP = big;
+        distN = -big;
+        // Undo the last increment to put us at the last pixel
+        // (input is no longer needed)
+        outPtr0 -= this->OutInc0;
+        for (idx0 = 0; idx0 < this->Size0; ++idx0)
+          {
+          if (*outPtr0 >= 0)
+            {
+            if (distP > *outPtr0)
+              {
+              distP = *outPtr0;
+              }
+            *outPtr0 = distP;
+            }
+          if (*outPtr0 <= 0)
+            {
+            if (distN < *outPtr0)
+              {
+              distN = *outPtr0;
+              }
+            *outPtr0 = distN;
+            }
+
+          if (distP < big)
+            {
+            ++distP;
+            }
+          if (distN > -big)
+            {
+            --distN;
+            }
+
+          outPtr0 -= this->OutInc0;
+          }
+
+        inPtrC += 1;
+        outPtrC += 1;
+        }
+      }
+  }
+
+private:
+  short *InPtr;
+  short *OutPtr;
+  vtkIdType InInc0;
+  vtkIdType InInc1;
+  vtkIdType InInc2;
+  vtkIdType OutInc0;
+  vtkIdType OutInc1;
+  vtkIdType OutInc2;
+  int Size0;
+  int Size1;
+  int NumberOfComponents;
+};
+
 //----------------------------------------------------------------------------
 vtkImageCityBlockDistance::vtkImageCityBlockDistance()
 {
@@ -84,17 +213,10 @@ int vtkImageCityBlockDistance::IterativeRequestData(
 
   this->AllocateOutputScalars(outData, uExt, wExt, outInfo);
 
-  short *inPtr0, *inPtr1, *inPtr2, *inPtrC;
-  short *outPtr0, *outPtr1, *outPtr2, *outPtrC;
   vtkIdType inInc0, inInc1, inInc2;
   vtkIdType outInc0, outInc1, outInc2;
-  int min0, max0, min1, max1, min2, max2, numberOfComponents;
-  int idx0, idx1, idx2, idxC;
-  short distP, distN;
-  short big = 2000;
+  int min0, max0, min1, max1, min2, max2;
   int outExt[6];
-  unsigned long count = 0;
-  unsigned long target;
 
   outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),outExt);
 
@@ -114,113 +236,22 @@ int vtkImageCityBlockDistance::IterativeRequestData(
   this->PermuteExtent(outExt, min0, max0, min1, max1, min2, max2);
   this->PermuteIncrements(inData->GetIncrements(), inInc0, inInc1, inInc2);
   this->PermuteIncrements(outData->GetIncrements(), outInc0, outInc1, outInc2);
-  numberOfComponents = inData->GetNumberOfScalarComponents();
 
-  target = static_cast<unsigned long>((max2-min2+1)*(max1-min1+1)/50.0);
-  target++;
-
-  // loop over all the extra axes
-  inPtr2 = static_cast<short *>(inData->GetScalarPointerForExtent(outExt));
-  outPtr2 = static_cast<short *>(outData->GetScalarPointerForExtent(outExt));
-  for (idx2 = min2; idx2 <= max2; ++idx2)
+  vtkImageCityBlockDistanceRows rows(
+    static_cast<short *>(inData->GetScalarPointerForExtent(outExt)),
+    static_cast<short *>(outData->GetScalarPointerForExtent(outExt)),
+    inInc0, inInc1, inInc2, outInc0, outInc1, outInc2,
+    max0 - min0 + 1, max1 - min1 + 1, inData->GetNumberOfScalarComponents());
+
+  // the rows are processed in parallel, in 50 batches for progress
+  vtkIdType numRows = static_cast<vtkIdType>(max2-min2+1)*(max1-min1+1);
+  vtkIdType target = numRows/50 + 1;
+  for (vtkIdType first = 0; !this->AbortExecute && first < numRows;
+       first += target)
     {
-    inPtr1 = inPtr2;
-    outPtr1 = outPtr2;
-    for (idx1 = min1; !this->AbortExecute && idx1 <= max1; ++idx1)
-      {
-      if (!(count%target))
-        {
-        this->UpdateProgress(count/(50.0*target));
-        }
-      count++;
-      inPtrC = inPtr1;
-      outPtrC = outPtr1;
-      for (idxC = 0; idxC < numberOfComponents; ++idxC)
-        {
-        // execute forward pass
-        distP = big;
-        distN = -big;
-        inPtr0 = inPtrC;
-        outPtr0 = outPtrC;
-        for (idx0 = min0; idx0 <= max0; ++idx0)
-          { // preserve sign
-          if (*inPtr0 >= 0)
-            {
-            distN = 0;
-            if (distP > *inPtr0)
-              {
-              distP = *inPtr0;
-              }
-            *outPtr0 = distP;
-            }
-          if (*inPtr0 <= 0)
-            {
-            distP = 0;
-            if (distN < *inPtr0)
-              {
-              distN = *inPtr0;
-              }
-            *outPtr0 = distN;
-            }
-
-          if (distP < big)
-            {
-            ++distP;
-            }
-          if (distN > -big)
-            {
-            --distN;
-            }
-
-          inPtr0 += inInc0;
-          outPtr0 += outInc0;
-          }
-
-        // backward pass
-        distP = big;
-        distN = -big;
-        // Undo the last increment to put us at the last pixel
-        // (input is no longer needed)
-        outPtr0 -= outInc0;
-        for (idx0 = max0; idx0 >= min0; --idx0)
-          {
-          if (*outPtr0 >= 0)
-            {
-            if (distP > *outPtr0)
-              {
-              distP = *outPtr0;
-              }
-            *outPtr0 = distP;
-            }
-          if (*outPtr0 <= 0)
-            {
-            if (distN < *outPtr0)
-              {
-              distN = *outPtr0;
-              }
-            *outPtr0 = distN;
-            }
-
-          if (distP < big)
-            {
-            ++distP;
-            }
-          if (distN > -big)
-            {
-            --distN;
-            }
-
-          outPtr0 -= outInc0;
-          }
-
-        inPtrC += 1;
-        outPtrC += 1;
-        }
-      inPtr1 += inInc1;
-      outPtr1 += outInc1;
-      }
-    inPtr2 += inInc2;
-    outPtr2 += outInc2;
+    this->UpdateProgress(static_cast<double>(first)/numRows);
+    vtkIdType last = first + target;
+    vtkSMPTools::For(first, (last < numRows ? last : numRows), rows);
     }
 
   return 1;
@@ -18,9 +18,12 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageEuclideanDistance);
 
@@ -32,6 +35,7 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
   this->Initialize = 1;
   this->ConsiderAnisotropy = 1;
   this->Algorithm = VTK_EDT_SAITO;
+  this->TakeSquareRoot = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -554,6 +558,137 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
   free(temp);
   free(sq);
 }
+//----------------------------------------------------------------------------
+// Felzenszwalb and Huttenlocher's algorithm transforms each row along the
+// current axis independently: the output at p is min_q(f(q) + w(p-q)^2),
+// the lower envelope of the parabolas rooted at every sample, which is
+// built in one scan and read back in another.  Rows are shared out among
+// threads, each with its own buffers.
+class vtkImageEuclideanDistanceFelzenszwalbRows
+{
+public:
+  vtkImageEuclideanDistanceFelzenszwalbRows(double *outPtr, int size0,
+                                            int size1, vtkIdType inc0,
+                                            vtkIdType inc1, vtkIdType inc2,
+                                            double spacing2) :
+    OutPtr(outPtr), Size0(size0), Size1(size1), Inc0(inc0), Inc1(inc1),
+    Inc2(inc2), Spacing2(spacing2) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<double> &f = this->F.Local();
+    std::vector<double> &z = this->Z.Local();
+    std::vector<int> &v = this->V.Local();
+    int n = this->Size0;
+    f.resize(n);
+    z.resize(n + 1);
+    v.resize(n);
+    double w = this->Spacing2;
+
+    for (vtkIdType row = begin; row < end; ++row)
+      {
+      double *outPtr0 = this->OutPtr + (row % this->Size1)*this->Inc1 +
+        (row / this->Size1)*this->Inc2;
+      int q;
+      for (q = 0; q < n; ++q)
+        {
+        f[q] = outPtr0[q*this->Inc0];
+        }
+
+      // lower envelope: parabola v[j] is the lowest from z[j] to z[j+1]
+      int k = 0;
+      v[0] = 0;
+      z[0] = -VTK_DOUBLE_MAX;
+      z[1] = VTK_DOUBLE_MAX;
+      for (q = 1; q < n; ++q)
+        {
+        double fq = f[q] + w*q*q;
+        int r = v[k];
+        double s = (fq - f[r] - w*r*r)/(2.0*w*(q - r));
+        while (s <= z[k])
+          {
+          r = v[--k];
+          s = (fq - f[r] - w*r*r)/(2.0*w*(q - r));
+          }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k+1] = VTK_DOUBLE_MAX;
+        }
+
+      k = 0;
+      for (q = 0; q < n; ++q)
+        {
+        while (z[k+1] < q)
+          {
+          ++k;
+          }
+        int d = q - v[k];
+        outPtr0[q*this->Inc0] = f[v[k]] + w*d*d;
+        }
+      }
+  }
+
+private:
+  double *OutPtr;
+  int Size0;
+  int Size1;
+  vtkIdType Inc0;
+  vtkIdType Inc1;
+  vtkIdType Inc2;
+  double Spacing2;
+  vtkSMPThreadLocal<std::vector<double> > F;
+  vtkSMPThreadLocal<std::vector<double> > Z;
+  vtkSMPThreadLocal<std::vector<int> > V;
+};
+
+//----------------------------------------------------------------------------
+// Execute Felzenszwalb and Huttenlocher's algorithm.  The first iteration
+// is no different from the next ones, since the background is at
+// MaximumDistance after initialization.
+static void vtkImageEuclideanDistanceExecuteFelzenszwalb(
+  vtkImageEuclideanDistance *self,
+  vtkImageData *outData, int outExt[6], double *outPtr )
+{
+  int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
+  vtkIdType outInc0, outInc1, outInc2;
+
+  self->PermuteExtent(outExt, outMin0,outMax0,outMin1,outMax1,outMin2,outMax2);
+  self->PermuteIncrements(outData->GetIncrements(), outInc0, outInc1, outInc2);
+
+  double spacing = 1.0;
+  if ( self->GetConsiderAnisotropy() )
+    {
+    spacing = outData->GetSpacing()[ self->GetIteration() ];
+    }
+
+  int size1 = outMax1 - outMin1 + 1;
+  vtkIdType numRows = static_cast<vtkIdType>(size1)*(outMax2 - outMin2 + 1);
+  vtkImageEuclideanDistanceFelzenszwalbRows rows(
+    outPtr, outMax0 - outMin0 + 1, size1, outInc0, outInc1, outInc2,
+    spacing*spacing);
+  vtkSMPTools::For(0, numRows, rows);
+}
+
+//----------------------------------------------------------------------------
+// Turn the squared distances into distances once the last axis is done.
+class vtkImageEuclideanDistanceSquareRoot
+{
+public:
+  vtkImageEuclideanDistanceSquareRoot(double *ptr) : Ptr(ptr) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Ptr[i] = sqrt(this->Ptr[i]);
+      }
+  }
+
+private:
+  double *Ptr;
+};
+
 //----------------------------------------------------------------------------
 void vtkImageEuclideanDistance::AllocateOutputScalars(vtkImageData *outData,
                                                       int outExt[6],
@@ -652,10 +787,22 @@ int vtkImageEuclideanDistance::IterativeRequestData(
       vtkImageEuclideanDistanceExecuteSaitoCached( this, outData, outExt,
                                                    static_cast<double *>(outPtr) );
       break;
+    case VTK_EDT_FELZENSZWALB:
+      vtkImageEuclideanDistanceExecuteFelzenszwalb( this, outData, outExt,
+                                                    static_cast<double *>(outPtr) );
+      break;
     default:
       vtkErrorMacro(<< "Execute: Unknown Algorithm");
     }
 
+  if ( this->TakeSquareRoot &&
+       this->GetIteration() == this->GetNumberOfIterations() - 1 )
+    {
+    vtkImageEuclideanDistanceSquareRoot squareRoot(
+      static_cast<double *>(outPtr));
+    vtkSMPTools::For(0, outData->GetNumberOfPoints(), squareRoot);
+    }
+
   this->UpdateProgress((this->GetIteration()+1.0)/3.0);
 
   return 1;
@@ -747,10 +894,17 @@ void vtkImageEuclideanDistance::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << "Saito\n";
     }
+  else if ( this->Algorithm == VTK_EDT_FELZENSZWALB )
+    {
+    os << "Felzenszwalb\n";
+    }
   else
     {
     os << "Saito Cached\n";
     }
+
+  os << indent << "Take Square Root: "
+     << (this->TakeSquareRoot ? "On\n" : "Off\n");
 }
 
 
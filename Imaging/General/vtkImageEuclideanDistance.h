@@ -16,7 +16,7 @@
 // .SECTION Description
 // vtkImageEuclideanDistance implements the Euclidean DT using
 // Saito's algorithm. The distance map produced contains the square of the
-// Euclidean distance values.
+// Euclidean distance values, unless TakeSquareRoot is on.
 //
 // The algorithm has a o(n^(D+1)) complexity over nxnx...xn images in D
 // dimensions. It is very efficient on relatively small images. Cuisenaire's
@@ -29,6 +29,10 @@
 // slow it very significantly. In that case, one should use
 // ::SetAlgorithmToSaitoCached() instead for better performance.
 //
+// ::SetAlgorithmToFelzenszwalb() selects the algorithm of Felzenszwalb and
+// Huttenlocher, which is exact and linear in the number of voxels whatever
+// the distances, and which processes the rows of each axis in parallel.
+//
 // References:
 //
 // T. Saito and J.I. Toriwaki. New algorithms for Euclidean distance
@@ -38,6 +42,9 @@
 // O. Cuisenaire. Distance Transformation: fast algorithms and applications
 // to medical image processing. PhD Thesis, Universite catholique de Louvain,
 // October 1999. http://ltswww.epfl.ch/~cuisenai/papers/oc_thesis.pdf
+//
+// P.F. Felzenszwalb and D.P. Huttenlocher. Distance Transforms of Sampled
+// Functions. Theory of Computing, 8(19). pp. 415--428, 2012.
 
 
 #ifndef vtkImageEuclideanDistance_h
@@ -48,6 +55,7 @@
 
 #define VTK_EDT_SAITO_CACHED 0
 #define VTK_EDT_SAITO 1
+#define VTK_EDT_FELZENSZWALB 2
 
 class VTKIMAGINGGENERAL_EXPORT vtkImageEuclideanDistance : public vtkImageDecomposeFilter
 {
@@ -93,13 +101,22 @@ public:
   // Selects a Euclidean DT algorithm.
   // 1. Saito
   // 2. Saito-cached
-  // More algorithms will be added later on.
+  // 3. Felzenszwalb
   vtkSetMacro(Algorithm, int);
   vtkGetMacro(Algorithm, int);
   void SetAlgorithmToSaito ()
     { this->SetAlgorithm(VTK_EDT_SAITO); }
   void SetAlgorithmToSaitoCached ()
     { this->SetAlgorithm(VTK_EDT_SAITO_CACHED); }
+  void SetAlgorithmToFelzenszwalb ()
+    { this->SetAlgorithm(VTK_EDT_FELZENSZWALB); }
+
+  // Description:
+  // When on, the output holds the Euclidean distances instead of their
+  // squares. Off by default.
+  vtkSetMacro(TakeSquareRoot, int);
+  vtkGetMacro(TakeSquareRoot, int);
+  vtkBooleanMacro(TakeSquareRoot, int);
 
   virtual int IterativeRequestData(vtkInformation*,
                                    vtkInformationVector**,
@@ -113,6 +130,7 @@ protected:
   int Initialize;
   int ConsiderAnisotropy;
   int Algorithm;
+  int TakeSquareRoot;
 
   // Replaces "EnlargeOutputUpdateExtent"
   virtual void AllocateOutputScalars(vtkImageData *outData,
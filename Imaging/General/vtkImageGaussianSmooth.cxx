@@ -20,7 +20,9 @@
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageGaussianSmooth);
 
@@ -34,6 +36,7 @@ vtkImageGaussianSmooth::vtkImageGaussianSmooth()
   this->RadiusFactors[0] = 1.5;
   this->RadiusFactors[1] = 1.5;
   this->RadiusFactors[2] = 1.5;
+  this->UseRecursiveFilter = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -61,6 +64,31 @@ void vtkImageGaussianSmooth::PrintSelf(ostream& os, vtkIndent indent)
      << this->StandardDeviations[0] << ", "
      << this->StandardDeviations[1] << ", "
      << this->StandardDeviations[2] << " )\n";
+
+  os << indent << "UseRecursiveFilter: " << this->UseRecursiveFilter << "\n";
+}
+
+//----------------------------------------------------------------------------
+int vtkImageGaussianSmooth::IsAxisRecursive(int axis)
+{
+  return (this->UseRecursiveFilter && axis < this->Dimensionality &&
+          this->StandardDeviations[axis] >= 0.5);
+}
+
+//----------------------------------------------------------------------------
+// The number of pixels the input is padded with along an axis.
+int vtkImageGaussianSmooth::GetAxisRadius(int axis)
+{
+  int radius = static_cast<int>(this->StandardDeviations[axis]
+                                * this->RadiusFactors[axis]);
+  if (this->IsAxisRecursive(axis))
+    {
+    // the recursive filter has no finite support: pad it enough for the
+    // tails of the gaussian to be negligible
+    radius = std::max(radius, static_cast<int>(
+      ceil(4.0 * this->StandardDeviations[axis])));
+    }
+  return radius;
 }
 
 //----------------------------------------------------------------------------
@@ -125,8 +153,7 @@ void vtkImageGaussianSmooth::InternalRequestUpdateExtent(int *inExt,
   // Expand filtered axes
   for (idx = 0; idx < this->Dimensionality; ++idx)
     {
-    radius = static_cast<int>(this->StandardDeviations[idx]
-                              * this->RadiusFactors[idx]);
+    radius = this->GetAxisRadius(idx);
     inExt[idx*2] -= radius;
     if (inExt[idx*2] < wholeExtent[idx*2])
       {
@@ -236,6 +263,135 @@ vtkImageGaussianSmoothExecute(vtkImageGaussianSmooth *self, int axis,
     }
 }
 
+//----------------------------------------------------------------------------
+// Coefficients of the recursive gaussian of Young and van Vliet: each pass
+// computes w[n] = b[0]*x[n] + b[1]*w[n-1] + b[2]*w[n-2] + b[3]*w[n-3].
+static void vtkImageGaussianSmoothRecursiveCoefficients(double std,
+                                                        double b[4])
+{
+  double q = (std >= 2.5 ? 0.98711*std - 0.96330 :
+              3.97156 - 4.14554*sqrt(1.0 - 0.26891*std));
+  double q2 = q*q;
+  double q3 = q2*q;
+  double b0 = 1.57825 + 2.44413*q + 1.4281*q2 + 0.422205*q3;
+  b[1] = (2.44413*q + 2.85619*q2 + 1.26661*q3) / b0;
+  b[2] = -(1.4281*q2 + 1.26661*q3) / b0;
+  b[3] = 0.422205*q3 / b0;
+  b[0] = 1.0 - (b[1] + b[2] + b[3]);
+}
+
+//----------------------------------------------------------------------------
+// Recursive smoothing along an axis. The lines along the axis are filtered
+// forward then backward in a buffer, several at a time for the y and z axes
+// so that the inner loops run over contiguous x pixels. Each line starts
+// and ends with its boundary pixels replicated, which leaves constant
+// lines unchanged.
+template <class T>
+void
+vtkImageGaussianSmoothRecursiveExecute(vtkImageGaussianSmooth *self, int axis,
+                                       const double b[4], int inMin,
+                                       int inMax, vtkImageData *inData,
+                                       vtkImageData *outData, int outExt[6],
+                                       T *)
+{
+  const int pad = 3;
+  int n = inMax - inMin + 1;
+  int outMin = outExt[2*axis];
+  int outMax = outExt[2*axis+1];
+  int axis0 = (axis == 0 ? 1 : 0);
+  int axis1 = (axis == 2 ? 1 : 2);
+  int max0 = outExt[2*axis0+1] - outExt[2*axis0] + 1;
+  int max1 = outExt[2*axis1+1] - outExt[2*axis1] + 1;
+  int maxC = outData->GetNumberOfScalarComponents();
+  vtkIdType *inIncs = inData->GetIncrements();
+  vtkIdType *outIncs = outData->GetIncrements();
+
+  // lines along x are contiguous, the others are grouped along x
+  int group = (axis == 0 ? 1 : std::min(max0, 256));
+  std::vector<double> buffer((n + 2*pad)*group);
+
+  int coords[3];
+  coords[axis0] = outExt[2*axis0];
+  coords[axis1] = outExt[2*axis1];
+  coords[axis] = inMin;
+  T *inPtrC = static_cast<T *>(inData->GetScalarPointer(coords));
+  coords[axis] = outMin;
+  T *outPtrC = static_cast<T *>(outData->GetScalarPointer(coords));
+
+  for (int idxC = 0; idxC < maxC; ++idxC)
+    {
+    for (int idx1 = 0; !self->AbortExecute && idx1 < max1; ++idx1)
+      {
+      for (int start = 0; start < max0; start += group)
+        {
+        int g = std::min(group, max0 - start);
+        T *inPtr = inPtrC + idx1*inIncs[axis1] + start*inIncs[axis0];
+        T *outPtr = outPtrC + idx1*outIncs[axis1] + start*outIncs[axis0];
+
+        // load the lines, padded with their first pixels
+        double *w = &buffer[pad*group];
+        for (int k = 0; k < n; ++k)
+          {
+          const T *ptr = inPtr + k*inIncs[axis];
+          for (int j = 0; j < g; ++j)
+            {
+            w[k*group + j] = static_cast<double>(ptr[j*inIncs[axis0]]);
+            }
+          }
+        for (int k = -pad; k < 0; ++k)
+          {
+          for (int j = 0; j < g; ++j)
+            {
+            w[k*group + j] = w[j];
+            }
+          }
+
+        // causal pass
+        for (int k = 0; k < n; ++k)
+          {
+          double *wk = w + k*group;
+          for (int j = 0; j < g; ++j)
+            {
+            wk[j] = b[0]*wk[j] + b[1]*wk[j - group] +
+              b[2]*wk[j - 2*group] + b[3]*wk[j - 3*group];
+            }
+          }
+
+        // anticausal pass, padded with the last pixels of the causal one
+        for (int k = n; k < n + pad; ++k)
+          {
+          for (int j = 0; j < g; ++j)
+            {
+            w[k*group + j] = w[(n - 1)*group + j];
+            }
+          }
+        for (int k = n - 1; k >= 0; --k)
+          {
+          double *wk = w + k*group;
+          for (int j = 0; j < g; ++j)
+            {
+            wk[j] = b[0]*wk[j] + b[1]*wk[j + group] +
+              b[2]*wk[j + 2*group] + b[3]*wk[j + 3*group];
+            }
+          }
+
+        // store the part of the lines that is in the output
+        for (int k = outMin; k <= outMax; ++k)
+          {
+          const double *wk = w + (k - inMin)*group;
+          T *ptr = outPtr + (k - outMin)*outIncs[axis];
+          for (int j = 0; j < g; ++j)
+            {
+            ptr[j*outIncs[axis0]] = static_cast<T>(wk[j]);
+            }
+          }
+        }
+      }
+    ++inPtrC;
+    ++outPtrC;
+    }
+}
+
 //----------------------------------------------------------------------------
 template <class T>
 size_t vtkImageGaussianSmoothGetTypeSize(T*)
@@ -267,6 +423,32 @@ void vtkImageGaussianSmooth::ExecuteAxis(int axis,
   int coords[3];
   vtkIdType *outIncs, outIncA;
 
+  // get whole extent for boundary checking ...
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExtent);
+  wholeMin = wholeExtent[axis*2];
+  wholeMax = wholeExtent[axis*2+1];
+
+  if (this->IsAxisRecursive(axis))
+    {
+    double b[4];
+    vtkImageGaussianSmoothRecursiveCoefficients(
+      this->StandardDeviations[axis], b);
+    radius = this->GetAxisRadius(axis);
+    int inMin = std::max(wholeMin, outExt[axis*2] - radius);
+    int inMax = std::min(wholeMax, outExt[axis*2+1] + radius);
+    switch (inData->GetScalarType())
+      {
+      vtkTemplateMacro(
+        vtkImageGaussianSmoothRecursiveExecute(this, axis, b, inMin, inMax,
+                                               inData, outData, outExt,
+                                               static_cast<VTK_TT*>(0))
+        );
+      default:
+        vtkErrorMacro("Unknown scalar type");
+      }
+    return;
+    }
+
   // Get the correct starting pointer of the output
   outPtr = outData->GetScalarPointerForExtent(outExt);
   outIncs = outData->GetIncrements();
@@ -288,11 +470,6 @@ void vtkImageGaussianSmooth::ExecuteAxis(int axis,
   coords[1] = inExt[2];
   coords[2] = inExt[4];
 
-  // get whole extent for boundary checking ...
-  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExtent);
-  wholeMin = wholeExtent[axis*2];
-  wholeMax = wholeExtent[axis*2+1];
-
   // allocate memory for the kernel
   radius = static_cast<int>(this->StandardDeviations[axis]
                             * this->RadiusFactors[axis]);
@@ -358,55 +535,28 @@ void vtkImageGaussianSmooth::ExecuteAxis(int axis,
 }
 
 //----------------------------------------------------------------------------
-// This method decomposes the gaussian and smooths along each axis.
-void vtkImageGaussianSmooth::ThreadedRequestData(
-  vtkInformation *vtkNotUsed(request),
-  vtkInformationVector **inputVector,
-  vtkInformationVector *outputVector,
-  vtkImageData ***inData,
-  vtkImageData **outData,
-  int outExt[6], int id)
+// This method decomposes the gaussian and smooths a block of the output
+// along each axis.
+void vtkImageGaussianSmooth::ExecuteBlock(vtkImageData *inData,
+                                          vtkImageData *outData,
+                                          int outExt[6],
+                                          vtkInformation *inInfo)
 {
-  int inExt[6];
-  int target, count, total, cycle;
-
-  // for feed back, determine line target to get 50 progress update
-  // update is called every target lines. Progress is computed from
-  // the number of pixels processed so far.
-  count = 0; target = 0; total = 0; cycle = 0;
-  if (id == 0)
-    {
-    // determine the number of pixels.
-    total = this->Dimensionality * (outExt[1] - outExt[0] + 1)
-      * (outExt[3] - outExt[2] + 1) * (outExt[5] - outExt[4] + 1)
-      * inData[0][0]->GetNumberOfScalarComponents();
-    // pixels per update (50 updates)
-    target = total / 50;
-    }
+  int inExt[6], wholeExt[6];
+  int cycle = 0, count = 0;
 
-  // this filter expects that input is the same type as output.
-  if (inData[0][0]->GetScalarType() != outData[0]->GetScalarType())
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+  for (int idx = 0; idx < 6; ++idx)
     {
-    vtkErrorMacro("Execute: input ScalarType, "
-                  << inData[0][0]->GetScalarType()
-                  << ", must match out ScalarType "
-                  << outData[0]->GetScalarType());
-    return;
+    inExt[idx] = outExt[idx];
     }
-
-  // Decompose
-  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
-  vtkInformation *outInfo = outputVector->GetInformationObject(0);
-  int wholeExt[6];
-  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
-  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt);
   this->InternalRequestUpdateExtent(inExt, wholeExt);
 
   switch (this->Dimensionality)
     {
     case 1:
-      this->ExecuteAxis(0, inData[0][0], inExt, outData[0], outExt,
-                        &cycle, target, &count, total, inInfo);
+      this->ExecuteAxis(0, inData, inExt, outData, outExt,
+                        &cycle, 0, &count, 0, inInfo);
       break;
     case 2:
       int tempExt[6];
@@ -418,12 +568,12 @@ void vtkImageGaussianSmooth::ThreadedRequestData(
       // create a temp data for intermediate results
       tempData = vtkImageData::New();
       tempData->SetExtent(tempExt);
-      tempData->AllocateScalars(inData[0][0]->GetScalarType(),
-                                inData[0][0]->GetNumberOfScalarComponents());
-      this->ExecuteAxis(1, inData[0][0], inExt, tempData, tempExt,
-                        &cycle, target, &count, total, inInfo);
-      this->ExecuteAxis(0, tempData, tempExt, outData[0], outExt,
-                        &cycle, target, &count, total, inInfo);
+      tempData->AllocateScalars(inData->GetScalarType(),
+                                inData->GetNumberOfScalarComponents());
+      this->ExecuteAxis(1, inData, inExt, tempData, tempExt,
+                        &cycle, 0, &count, 0, inInfo);
+      this->ExecuteAxis(0, tempData, tempExt, outData, outExt,
+                        &cycle, 0, &count, 0, inInfo);
       // release temporary data
       tempData->Delete();
       break;
@@ -443,21 +593,87 @@ void vtkImageGaussianSmooth::ThreadedRequestData(
       // create a temp data for intermediate results
       temp0Data = vtkImageData::New();
       temp0Data->SetExtent(temp0Ext);
-      temp0Data->AllocateScalars(inData[0][0]->GetScalarType(),
-                                 inData[0][0]->GetNumberOfScalarComponents());
+      temp0Data->AllocateScalars(inData->GetScalarType(),
+                                 inData->GetNumberOfScalarComponents());
 
       temp1Data = vtkImageData::New();
       temp1Data->SetExtent(temp1Ext);
-      temp1Data->AllocateScalars(inData[0][0]->GetScalarType(),
-                                 inData[0][0]->GetNumberOfScalarComponents());
-      this->ExecuteAxis(2, inData[0][0], inExt, temp0Data, temp0Ext,
-                        &cycle, target, &count, total, inInfo);
+      temp1Data->AllocateScalars(inData->GetScalarType(),
+                                 inData->GetNumberOfScalarComponents());
+      this->ExecuteAxis(2, inData, inExt, temp0Data, temp0Ext,
+                        &cycle, 0, &count, 0, inInfo);
       this->ExecuteAxis(1, temp0Data, temp0Ext, temp1Data, temp1Ext,
-                        &cycle, target, &count, total, inInfo);
+                        &cycle, 0, &count, 0, inInfo);
       temp0Data->Delete();
-      this->ExecuteAxis(0, temp1Data, temp1Ext, outData[0], outExt,
-                        &cycle, target, &count, total, inInfo);
+      this->ExecuteAxis(0, temp1Data, temp1Ext, outData, outExt,
+                        &cycle, 0, &count, 0, inInfo);
       temp1Data->Delete();
       break;
     }
 }
+
+//----------------------------------------------------------------------------
+// This method splits the output extent into blocks that are small enough
+// for the intermediate images to stay in cache, and smooths them one after
+// the other. Each block is computed from the input padded around it, and
+// the result does not depend on the blocks.
+void vtkImageGaussianSmooth::ThreadedRequestData(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *vtkNotUsed(outputVector),
+  vtkImageData ***inData,
+  vtkImageData **outData,
+  int outExt[6], int id)
+{
+  // this filter expects that input is the same type as output.
+  if (inData[0][0]->GetScalarType() != outData[0]->GetScalarType())
+    {
+    vtkErrorMacro("Execute: input ScalarType, "
+                  << inData[0][0]->GetScalarType()
+                  << ", must match out ScalarType "
+                  << outData[0]->GetScalarType());
+    return;
+    }
+
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+
+  // long blocks along x, whose rows are contiguous, and blocks several
+  // times larger than the padding along the filtered axes
+  int numBlocks[3];
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    int size = outExt[2*axis+1] - outExt[2*axis] + 1;
+    int blockSize = (axis == 0 ? 256 : 64);
+    if (axis < this->Dimensionality)
+      {
+      blockSize = std::max(blockSize, 4*this->GetAxisRadius(axis));
+      }
+    numBlocks[axis] = std::max(1, (size + blockSize - 1) / blockSize);
+    }
+  int total = numBlocks[0]*numBlocks[1]*numBlocks[2];
+
+  int count = 0;
+  int blockExt[6];
+  for (int bz = 0; bz < numBlocks[2]; ++bz)
+    {
+    for (int by = 0; by < numBlocks[1]; ++by)
+      {
+      for (int bx = 0; !this->AbortExecute && bx < numBlocks[0]; ++bx)
+        {
+        int b[3] = { bx, by, bz };
+        for (int axis = 0; axis < 3; ++axis)
+          {
+          int size = outExt[2*axis+1] - outExt[2*axis] + 1;
+          blockExt[2*axis] = outExt[2*axis] + size*b[axis]/numBlocks[axis];
+          blockExt[2*axis+1] =
+            outExt[2*axis] + size*(b[axis] + 1)/numBlocks[axis] - 1;
+          }
+        this->ExecuteBlock(inData[0][0], outData[0], blockExt, inInfo);
+        if (id == 0)
+          {
+          this->UpdateProgress(static_cast<double>(++count) / total);
+          }
+        }
+      }
+    }
+}
@@ -16,6 +16,8 @@
 // .SECTION Description
 // vtkImageGaussianSmooth implements a convolution of the input image
 // with a gaussian. Supports from one to three dimensional convolutions.
+// Each thread smooths its piece of the output block by block, so that the
+// intermediate images of the separable passes stay small.
 
 #ifndef vtkImageGaussianSmooth_h
 #define vtkImageGaussianSmooth_h
@@ -70,6 +72,17 @@ public:
   vtkSetMacro(Dimensionality, int);
   vtkGetMacro(Dimensionality, int);
 
+  // Description:
+  // When on, the axes with a standard deviation of at least 0.5 are
+  // smoothed with a third order recursive approximation of the gaussian
+  // (Young and van Vliet), whose cost per pixel does not depend on the
+  // standard deviation. The input is then padded by at least four standard
+  // deviations, and the image is extended by replicating its boundary
+  // pixels instead of clipping the kernel. Off by default.
+  vtkSetMacro(UseRecursiveFilter, int);
+  vtkGetMacro(UseRecursiveFilter, int);
+  vtkBooleanMacro(UseRecursiveFilter, int);
+
 protected:
   vtkImageGaussianSmooth();
   ~vtkImageGaussianSmooth();
@@ -77,14 +90,19 @@ protected:
   int Dimensionality;
   double StandardDeviations[3];
   double RadiusFactors[3];
+  int UseRecursiveFilter;
 
   void ComputeKernel(double *kernel, int min, int max, double std);
+  int IsAxisRecursive(int axis);
+  int GetAxisRadius(int axis);
   virtual int RequestUpdateExtent (vtkInformation *, vtkInformationVector **, vtkInformationVector *);
   void InternalRequestUpdateExtent(int *, int*);
   void ExecuteAxis(int axis, vtkImageData *inData, int inExt[6],
                    vtkImageData *outData, int outExt[6],
                    int *pcycle, int target, int *pcount, int total,
                    vtkInformation *inInfo);
+  void ExecuteBlock(vtkImageData *inData, vtkImageData *outData,
+                    int outExt[6], vtkInformation *inInfo);
   void ThreadedRequestData(vtkInformation *request,
                            vtkInformationVector **inputVector,
                            vtkInformationVector *outputVector,
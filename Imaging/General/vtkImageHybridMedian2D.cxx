@@ -15,6 +15,7 @@
 #include "vtkImageHybridMedian2D.h"
 
 #include "vtkImageData.h"
+#include "vtkImageRankFilterInternals.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -37,6 +38,21 @@ vtkImageHybridMedian2D::vtkImageHybridMedian2D()
   this->HandleBoundaries = 1;
 }
 
+//----------------------------------------------------------------------------
+// The middle element of the sorted neighborhood, found with a sorting
+// network away from the image boundaries
+template <class T>
+T vtkImageHybridMedian2DMedian(std::vector<T> &array)
+{
+  if (array.size() == 9)
+    {
+    return vtkImageRankMedian9(&array[0]);
+    }
+  std::sort(array.begin(),array.end());
+  return array[static_cast<unsigned int>(0.5*array.size())];
+}
+
+//----------------------------------------------------------------------------
 template <class T>
 void vtkImageHybridMedian2DExecute(vtkImageHybridMedian2D *self,
                                    vtkImageData *inData, T *inPtr2,
@@ -151,8 +167,7 @@ void vtkImageHybridMedian2DExecute(vtkImageHybridMedian2D *self,
             array.push_back( *ptr );
             }
 
-          std::sort(array.begin(),array.end());
-          median1 = array[static_cast<unsigned int>(0.5*array.size())];
+          median1 = vtkImageHybridMedian2DMedian(array);
 
           // compute median of x neighborhood
           // note that y axis direction is up in vtk images, not down
@@ -209,8 +224,7 @@ void vtkImageHybridMedian2DExecute(vtkImageHybridMedian2D *self,
             array.push_back( *ptr );
             }
 
-          std::sort(array.begin(),array.end());
-          median2 = array[static_cast<unsigned int>(0.5*array.size())];
+          median2 = vtkImageHybridMedian2DMedian(array);
 
           // Compute the median of the three. (med1, med2 and center)
           if (median1 > median2)
@@ -17,6 +17,7 @@
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
+#include "vtkImageRankFilterInternals.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -103,8 +104,147 @@ T vtkComputeMedianOfArray(T *aBegin, T *aEnd)
   return m;
 }
 
+//-----------------------------------------------------------------------------
+// Compute the median from a sliding histogram, like vtkComputeMedianOfArray
+template<class T>
+T vtkComputeMedianOfHistogram(const vtkImageRankHistogram<T> &histogram)
+{
+  int n = histogram.GetCount();
+  T m = histogram.GetRank(n/2);
+  if (n % 2 == 0)
+    {
+    T lowMid = histogram.GetRank(n/2 - 1);
+    m = lowMid + (m - lowMid)/2;
+    }
+  return m;
+}
+
+//-----------------------------------------------------------------------------
+// The neighborhood of out along an axis, clipped by the input extent
+inline void vtkImageMedian3DHood(int out, int middle, int size, int inMin,
+                                 int inMax, int &hoodMin, int &hoodMax)
+{
+  hoodMin = std::max(out - middle, inMin);
+  hoodMax = std::min(out - middle + size - 1, inMax);
+}
+
 } // end anonymous namespace
 
+//-----------------------------------------------------------------------------
+// The median filter for 8 and 16 bit integers and large kernels: along each
+// row of the output, a sliding histogram holds the neighborhood, whose
+// columns along x are added and removed as it moves.
+template <class T>
+void vtkImageMedian3DHistogramExecute(vtkImageMedian3D *self,
+                                      vtkImageData *inData,
+                                      vtkImageData *outData, T *outPtr,
+                                      int outExt[6], int id,
+                                      vtkDataArray *inArray)
+{
+  vtkIdType inInc0, inInc1, inInc2;
+  vtkIdType outInc0, outInc1, outInc2;
+  int *kernelMiddle = self->GetKernelMiddle();
+  int *kernelSize = self->GetKernelSize();
+  int *inExt = inData->GetExtent();
+  int numComp = inArray->GetNumberOfComponents();
+  const T *inPtr = static_cast<T *>(inArray->GetVoidPointer(0));
+  inData->GetIncrements(inInc0, inInc1, inInc2);
+  outData->GetIncrements(outInc0, outInc1, outInc2);
+
+  vtkImageRankHistogram<T> histogram;
+  unsigned long count = 0;
+  unsigned long target =
+    static_cast<unsigned long>((outExt[5] - outExt[4] + 1)*
+                               (outExt[3] - outExt[2] + 1)/50.0);
+  target++;
+
+  for (int outIdx2 = outExt[4]; outIdx2 <= outExt[5]; ++outIdx2)
+    {
+    int hoodMin2, hoodMax2;
+    vtkImageMedian3DHood(outIdx2, kernelMiddle[2], kernelSize[2],
+                         inExt[4], inExt[5], hoodMin2, hoodMax2);
+    for (int outIdx1 = outExt[2];
+         !self->AbortExecute && outIdx1 <= outExt[3]; ++outIdx1)
+      {
+      if (!id)
+        {
+        if (!(count%target))
+          {
+          self->UpdateProgress(count/(50.0*target));
+          }
+        count++;
+        }
+      int hoodMin1, hoodMax1;
+      vtkImageMedian3DHood(outIdx1, kernelMiddle[1], kernelSize[1],
+                           inExt[2], inExt[3], hoodMin1, hoodMax1);
+      const T *inRow = inPtr + (hoodMin1 - inExt[2])*inInc1 +
+        (hoodMin2 - inExt[4])*inInc2;
+      T *outRow = outPtr + (outIdx1 - outExt[2])*outInc1 +
+        (outIdx2 - outExt[4])*outInc2;
+
+      for (int outIdxC = 0; outIdxC < numComp; ++outIdxC)
+        {
+        // columns [colMin, colMax] of the row are in the histogram
+        int colMin = inExt[0];
+        int colMax = colMin - 1;
+        for (int outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
+          {
+          int hoodMin0, hoodMax0;
+          vtkImageMedian3DHood(outIdx0, kernelMiddle[0], kernelSize[0],
+                               inExt[0], inExt[1], hoodMin0, hoodMax0);
+          if (colMax < colMin)
+            { // the histogram is empty
+            colMin = hoodMin0;
+            colMax = hoodMin0 - 1;
+            }
+          for (; colMin < hoodMin0; ++colMin)
+            {
+            const T *ptr2 = inRow + (colMin - inExt[0])*inInc0 + outIdxC;
+            for (int i2 = hoodMin2; i2 <= hoodMax2; ++i2, ptr2 += inInc2)
+              {
+              const T *ptr1 = ptr2;
+              for (int i1 = hoodMin1; i1 <= hoodMax1; ++i1, ptr1 += inInc1)
+                {
+                histogram.Remove(*ptr1);
+                }
+              }
+            }
+          while (colMax < hoodMax0)
+            {
+            ++colMax;
+            const T *ptr2 = inRow + (colMax - inExt[0])*inInc0 + outIdxC;
+            for (int i2 = hoodMin2; i2 <= hoodMax2; ++i2, ptr2 += inInc2)
+              {
+              const T *ptr1 = ptr2;
+              for (int i1 = hoodMin1; i1 <= hoodMax1; ++i1, ptr1 += inInc1)
+                {
+                histogram.Add(*ptr1);
+                }
+              }
+            }
+
+          outRow[(outIdx0 - outExt[0])*outInc0 + outIdxC] =
+            vtkComputeMedianOfHistogram(histogram);
+          }
+
+        // empty the histogram for the next row
+        for (; colMin <= colMax; ++colMin)
+          {
+          const T *ptr2 = inRow + (colMin - inExt[0])*inInc0 + outIdxC;
+          for (int i2 = hoodMin2; i2 <= hoodMax2; ++i2, ptr2 += inInc2)
+            {
+            const T *ptr1 = ptr2;
+            for (int i1 = hoodMin1; i1 <= hoodMax1; ++i1, ptr1 += inInc1)
+              {
+              histogram.Remove(*ptr1);
+              }
+            }
+          }
+        }
+      }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // This method contains the second switch statement that calls the correct
 // templated function for the mask types.
@@ -139,6 +279,16 @@ void vtkImageMedian3DExecute(vtkImageMedian3D *self,
     return;
     }
 
+  // Sliding histograms beat sorting once the kernel is large enough
+  // compared to the number of bins they scan
+  int bits = vtkImageRankHistogramBits<T>::Value;
+  if (bits && self->GetNumberOfElements() >= (bits == 8 ? 27 : 125))
+    {
+    vtkImageMedian3DHistogramExecute(self, inData, outData, outPtr, outExt,
+                                     id, inArray);
+    return;
+    }
+
   // Array used to compute the median
   T *workArray = new T[self->GetNumberOfElements()];
 
@@ -233,8 +383,19 @@ void vtkImageMedian3DExecute(vtkImageMedian3D *self,
             tmpPtr2 += inInc2;
             }
 
-          // Replace this pixel with the hood median
-          *outPtr++ = vtkComputeMedianOfArray(workArray, workEnd);
+          // Replace this pixel with the hood median, with a sorting
+          // network for the common 3 and 3x3 neighborhoods
+          switch (workEnd - workArray)
+            {
+            case 3:
+              *outPtr++ = vtkImageRankMedian3(workArray);
+              break;
+            case 9:
+              *outPtr++ = vtkImageRankMedian9(workArray);
+              break;
+            default:
+              *outPtr++ = vtkComputeMedianOfArray(workArray, workEnd);
+            }
           }
 
         // shift neighborhood considering boundaries
@@ -16,11 +16,14 @@
 
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageRankFilterInternals.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkImageRange3D);
 
 //----------------------------------------------------------------------------
@@ -280,6 +283,196 @@ void vtkImageRange3DExecute(vtkImageRange3D *self,
     }
 }
 
+//----------------------------------------------------------------------------
+// The range for 8 and 16 bit integers and large kernels, from a sliding
+// histogram. Each row of the mask must be a single run of pixels, which
+// holds for the ellipsoid, so that the histogram moves along x by adding
+// and removing the two ends of the runs. Returns false for other masks.
+template <class T>
+bool vtkImageRange3DHistogramExecute(vtkImageRange3D *self,
+                                     vtkImageData *mask,
+                                     vtkImageData *inData,
+                                     vtkImageData *outData, int *outExt,
+                                     float *outPtr, int id,
+                                     vtkInformation *inInfo)
+{
+  int *kernelSize = self->GetKernelSize();
+  int *kernelMiddle = self->GetKernelMiddle();
+
+  // find the run of each row of the mask, relative to the middle
+  unsigned char *maskPtr = static_cast<unsigned char *>(
+    mask->GetScalarPointer());
+  vtkIdType maskInc0, maskInc1, maskInc2;
+  mask->GetIncrements(maskInc0, maskInc1, maskInc2);
+  int numRows = kernelSize[1]*kernelSize[2];
+  std::vector<int> runMin(numRows), runMax(numRows);
+  for (int k = 0; k < kernelSize[2]; ++k)
+    {
+    for (int j = 0; j < kernelSize[1]; ++j)
+      {
+      int r = j + k*kernelSize[1];
+      runMin[r] = 0;
+      runMax[r] = -1;
+      for (int i = 0; i < kernelSize[0]; ++i)
+        {
+        if (maskPtr[i*maskInc0 + j*maskInc1 + k*maskInc2])
+          {
+          if (runMin[r] <= runMax[r] && runMax[r] != i - 1)
+            {
+            return false;
+            }
+          if (runMin[r] > runMax[r])
+            {
+            runMin[r] = i;
+            }
+          runMax[r] = i;
+          }
+        }
+      }
+    }
+  // the middle pixel is always part of the range
+  int middleRow = kernelMiddle[1] + kernelMiddle[2]*kernelSize[1];
+  if (kernelMiddle[0] < runMin[middleRow] ||
+      kernelMiddle[0] > runMax[middleRow])
+    {
+    return false;
+    }
+  for (int r = 0; r < numRows; ++r)
+    {
+    runMin[r] -= kernelMiddle[0];
+    runMax[r] -= kernelMiddle[0];
+    }
+
+  int wholeExt[6];
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+  int *inExt = inData->GetExtent();
+  vtkIdType inInc0, inInc1, inInc2;
+  vtkIdType outInc0, outInc1, outInc2;
+  inData->GetIncrements(inInc0, inInc1, inInc2);
+  outData->GetIncrements(outInc0, outInc1, outInc2);
+  const T *inPtr = static_cast<T *>(inData->GetScalarPointer());
+  int numComps = outData->GetNumberOfScalarComponents();
+
+  vtkImageRankHistogram<T> histogram;
+  std::vector<const T *> rowPtrs(numRows);
+  std::vector<int> rows(numRows);
+  unsigned long count = 0;
+  unsigned long target = static_cast<unsigned long>(
+    numComps*(outExt[5]-outExt[4]+1)*(outExt[3]-outExt[2]+1)/50.0);
+  target++;
+
+  for (int outIdxC = 0; outIdxC < numComps; ++outIdxC)
+    {
+    for (int outIdx2 = outExt[4]; outIdx2 <= outExt[5]; ++outIdx2)
+      {
+      for (int outIdx1 = outExt[2];
+           !self->AbortExecute && outIdx1 <= outExt[3]; ++outIdx1)
+        {
+        if (!id)
+          {
+          if (!(count%target))
+            {
+            self->UpdateProgress(count/(50.0*target));
+            }
+          count++;
+          }
+
+        // the rows of the kernel that are inside the image, with pointers
+        // to their pixels at x = 0
+        int numActive = 0;
+        for (int k = 0; k < kernelSize[2]; ++k)
+          {
+          int idx2 = outIdx2 + k - kernelMiddle[2];
+          for (int j = 0; j < kernelSize[1]; ++j)
+            {
+            int idx1 = outIdx1 + j - kernelMiddle[1];
+            int r = j + k*kernelSize[1];
+            if (idx1 >= wholeExt[2] && idx1 <= wholeExt[3] &&
+                idx2 >= wholeExt[4] && idx2 <= wholeExt[5] &&
+                runMin[r] <= runMax[r])
+              {
+              rows[numActive] = r;
+              rowPtrs[numActive++] = inPtr + outIdxC - inExt[0]*inInc0 +
+                (idx1 - inExt[2])*inInc1 + (idx2 - inExt[4])*inInc2;
+              }
+            }
+          }
+
+        float *outPtr0 = outPtr + outIdxC +
+          (outIdx1 - outExt[2])*outInc1 + (outIdx2 - outExt[4])*outInc2;
+        for (int outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
+          {
+          for (int a = 0; a < numActive; ++a)
+            {
+            int r = rows[a];
+            if (outIdx0 == outExt[0])
+              {
+              int first = std::max(outIdx0 + runMin[r], wholeExt[0]);
+              int last = std::min(outIdx0 + runMax[r], wholeExt[1]);
+              for (int idx0 = first; idx0 <= last; ++idx0)
+                {
+                histogram.Add(rowPtrs[a][idx0*inInc0]);
+                }
+              continue;
+              }
+            int leaving = outIdx0 - 1 + runMin[r];
+            if (leaving >= wholeExt[0] && leaving <= wholeExt[1])
+              {
+              histogram.Remove(rowPtrs[a][leaving*inInc0]);
+              }
+            int entering = outIdx0 + runMax[r];
+            if (entering >= wholeExt[0] && entering <= wholeExt[1])
+              {
+              histogram.Add(rowPtrs[a][entering*inInc0]);
+              }
+            }
+
+          T pixelMin = histogram.GetRank(0);
+          T pixelMax = histogram.GetMaximum();
+          *outPtr0 = static_cast<float>(pixelMax - pixelMin);
+          outPtr0 += outInc0;
+          }
+
+        // empty the histogram for the next row
+        for (int a = 0; a < numActive; ++a)
+          {
+          int r = rows[a];
+          int first = std::max(outExt[1] + runMin[r], wholeExt[0]);
+          int last = std::min(outExt[1] + runMax[r], wholeExt[1]);
+          for (int idx0 = first; idx0 <= last; ++idx0)
+            {
+            histogram.Remove(rowPtrs[a][idx0*inInc0]);
+            }
+          }
+        }
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Dispatch to the sliding histogram when it applies
+template <class T>
+void vtkImageRange3DDispatch(vtkImageRange3D *self,
+                             vtkImageData *mask,
+                             vtkImageData *inData, T *inPtr,
+                             vtkImageData *outData, int *outExt,
+                             float *outPtr, int id,
+                             vtkInformation *inInfo)
+{
+  int *kernelSize = self->GetKernelSize();
+  int volume = kernelSize[0]*kernelSize[1]*kernelSize[2];
+  int bits = vtkImageRankHistogramBits<T>::Value;
+  if (bits && volume >= (bits == 8 ? 27 : 125) &&
+      vtkImageRange3DHistogramExecute<T>(self, mask, inData, outData,
+                                         outExt, outPtr, id, inInfo))
+    {
+    return;
+    }
+  vtkImageRange3DExecute(self, mask, inData, inPtr, outData, outExt, outPtr,
+                         id, inInfo);
+}
+
 //----------------------------------------------------------------------------
 // This method contains the first switch statement that calls the correct
 // templated function for the input and output Data types.
@@ -320,7 +513,7 @@ void vtkImageRange3D::ThreadedRequestData(
   switch (inData[0][0]->GetScalarType())
     {
     vtkTemplateMacro(
-      vtkImageRange3DExecute(this, mask, inData[0][0],
+      vtkImageRange3DDispatch(this, mask, inData[0][0],
                              static_cast<VTK_TT *>(inPtr), outData[0], outExt,
                              static_cast<float *>(outPtr), id, inInfo));
     default:
@@ -0,0 +1,187 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageRankFilterInternals.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImageRankFilterInternals - internals for the rank filters
+// .SECTION Description
+// Sliding histograms and sorting networks shared by vtkImageMedian3D,
+// vtkImageRange3D and vtkImageHybridMedian2D.  A sliding histogram holds
+// the values of a neighborhood that moves along x: a step adds the pixels
+// that enter the neighborhood and removes the ones that leave it, and any
+// rank is then found by scanning the histogram, so that the cost per pixel
+// grows with the area of the kernel rather than with its volume.
+
+#ifndef vtkImageRankFilterInternals_h
+#define vtkImageRankFilterInternals_h
+
+#include "vtkTypeTraits.h"
+
+#include <algorithm>
+#include <vector>
+
+// The number of bits of the types that sliding histograms handle, zero
+// for the other types
+template<class T>
+struct vtkImageRankHistogramBits
+{
+  enum { Value = 0 };
+};
+
+template<>
+struct vtkImageRankHistogramBits<char>
+{
+  enum { Value = 8 };
+};
+
+template<>
+struct vtkImageRankHistogramBits<signed char>
+{
+  enum { Value = 8 };
+};
+
+template<>
+struct vtkImageRankHistogramBits<unsigned char>
+{
+  enum { Value = 8 };
+};
+
+template<>
+struct vtkImageRankHistogramBits<short>
+{
+  enum { Value = 16 };
+};
+
+template<>
+struct vtkImageRankHistogramBits<unsigned short>
+{
+  enum { Value = 16 };
+};
+
+// A histogram with one bin per value of T, and a coarse histogram that
+// counts the values of groups of bins to speed up the search of ranks
+template<class T>
+class vtkImageRankHistogram
+{
+public:
+  enum { Bits = vtkImageRankHistogramBits<T>::Value,
+         Shift = Bits/2 };
+
+  vtkImageRankHistogram() :
+    Fine(1 << Bits, 0), Coarse(1 << (Bits - Shift), 0), Count(0) {}
+
+  int GetCount() const { return this->Count; }
+
+  void Add(T v)
+  {
+    int bin = static_cast<int>(v) - vtkTypeTraits<T>::Min();
+    ++this->Fine[bin];
+    ++this->Coarse[bin >> Shift];
+    ++this->Count;
+  }
+
+  void Remove(T v)
+  {
+    int bin = static_cast<int>(v) - vtkTypeTraits<T>::Min();
+    --this->Fine[bin];
+    --this->Coarse[bin >> Shift];
+    --this->Count;
+  }
+
+  // The value of rank k (from 0) among the values in the histogram
+  T GetRank(int k) const
+  {
+    int bin = 0;
+    while (k >= this->Coarse[bin])
+      {
+      k -= this->Coarse[bin++];
+      }
+    bin <<= Shift;
+    while (k >= this->Fine[bin])
+      {
+      k -= this->Fine[bin++];
+      }
+    return static_cast<T>(bin + vtkTypeTraits<T>::Min());
+  }
+
+  T GetMaximum() const
+  {
+    int bin = static_cast<int>(this->Coarse.size()) - 1;
+    while (!this->Coarse[bin])
+      {
+      --bin;
+      }
+    bin = ((bin + 1) << Shift) - 1;
+    while (!this->Fine[bin])
+      {
+      --bin;
+      }
+    return static_cast<T>(bin + vtkTypeTraits<T>::Min());
+  }
+
+private:
+  std::vector<int> Fine;
+  std::vector<int> Coarse;
+  int Count;
+};
+
+// Sort a pair with a compare-exchange
+template<class T>
+inline void vtkImageRankSort2(T &a, T &b)
+{
+  if (b < a)
+    {
+    T t = a;
+    a = b;
+    b = t;
+    }
+}
+
+// The median of 3 values, which are reordered
+template<class T>
+inline T vtkImageRankMedian3(T *p)
+{
+  vtkImageRankSort2(p[0], p[1]);
+  vtkImageRankSort2(p[1], p[2]);
+  vtkImageRankSort2(p[0], p[1]);
+  return p[1];
+}
+
+// The median of 9 values, which are reordered, with the 19 exchanges of
+// the network of Paeth (Graphics Gems)
+template<class T>
+inline T vtkImageRankMedian9(T *p)
+{
+  vtkImageRankSort2(p[1], p[2]);
+  vtkImageRankSort2(p[4], p[5]);
+  vtkImageRankSort2(p[7], p[8]);
+  vtkImageRankSort2(p[0], p[1]);
+  vtkImageRankSort2(p[3], p[4]);
+  vtkImageRankSort2(p[6], p[7]);
+  vtkImageRankSort2(p[1], p[2]);
+  vtkImageRankSort2(p[4], p[5]);
+  vtkImageRankSort2(p[7], p[8]);
+  vtkImageRankSort2(p[0], p[3]);
+  vtkImageRankSort2(p[5], p[8]);
+  vtkImageRankSort2(p[4], p[7]);
+  vtkImageRankSort2(p[3], p[6]);
+  vtkImageRankSort2(p[1], p[4]);
+  vtkImageRankSort2(p[2], p[5]);
+  vtkImageRankSort2(p[4], p[7]);
+  vtkImageRankSort2(p[4], p[2]);
+  vtkImageRankSort2(p[6], p[4]);
+  vtkImageRankSort2(p[4], p[2]);
+  return p[4];
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkImageRankFilterInternals.h
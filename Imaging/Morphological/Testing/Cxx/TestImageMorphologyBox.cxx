@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageMorphologyBox.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the box kernel of vtkImageContinuousDilate3D,
+// vtkImageContinuousErode3D and vtkImageDilateErode3D against maxima,
+// minima and dilations computed voxel by voxel, for several scalar types
+// and kernel sizes, with the image split in small pieces.
+
+#include "vtkDataArray.h"
+#include "vtkImageContinuousDilate3D.h"
+#include "vtkImageContinuousErode3D.h"
+#include "vtkImageData.h"
+#include "vtkImageDilateErode3D.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <cmath>
+
+namespace
+{
+
+vtkImageData *MakeImage(int type, int numComps, bool binary)
+{
+  vtkImageData *image = vtkImageData::New();
+  image->SetExtent(-3, 60, 2, 25, 0, 8);
+  image->AllocateScalars(type, numComps);
+  vtkDataArray *scalars = image->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    for (int c = 0; c < numComps; ++c)
+      {
+      double v = (binary ? (vtkMath::Random() < 0.02 ? 255.0 : 0.0) :
+                  floor(vtkMath::Random(0.0, 200.0)));
+      scalars->SetComponent(i, c, v);
+      }
+    }
+  return image;
+}
+
+// The value expected at (i, j, k) for a kernel of the given size, whose
+// neighborhood is clipped by the image extent
+double Expected(vtkImageData *image, int op, const int size[3],
+                int i, int j, int k, int c)
+{
+  int *extent = image->GetExtent();
+  double value = image->GetScalarComponentAsDouble(i, j, k, c);
+  bool hit = false;
+  int lo[3] = { i - size[0]/2, j - size[1]/2, k - size[2]/2 };
+  for (int z = lo[2]; z < lo[2] + size[2]; ++z)
+    {
+    for (int y = lo[1]; y < lo[1] + size[1]; ++y)
+      {
+      for (int x = lo[0]; x < lo[0] + size[0]; ++x)
+        {
+        if (x < extent[0] || x > extent[1] || y < extent[2] ||
+            y > extent[3] || z < extent[4] || z > extent[5])
+          {
+          continue;
+          }
+        double v = image->GetScalarComponentAsDouble(x, y, z, c);
+        hit = hit || (v == 255.0);
+        if ((op == 0 && v > value) || (op == 1 && v < value))
+          {
+          value = v;
+          }
+        }
+      }
+    }
+  if (op == 2 && hit && value == 0.0)
+    {
+    value = 255.0;
+    }
+  return value;
+}
+
+bool Check(vtkImageData *image, vtkImageData *output, int op,
+           const int size[3], const char *what)
+{
+  int *extent = image->GetExtent();
+  int numComps = image->GetNumberOfScalarComponents();
+  for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+        {
+        for (int c = 0; c < numComps; ++c)
+          {
+          double expected = Expected(image, op, size, i, j, k, c);
+          double v = output->GetScalarComponentAsDouble(i, j, k, c);
+          if (v != expected)
+            {
+            cerr << what << " with kernel " << size[0] << "x" << size[1]
+                 << "x" << size[2] << ": " << v << " instead of " << expected
+                 << " at (" << i << ", " << j << ", " << k << ")" << endl;
+            return false;
+            }
+          }
+        }
+      }
+    }
+  return true;
+}
+
+}
+
+int TestImageMorphologyBox(int, char *[])
+{
+  vtkMath::RandomSeed(89);
+  const int types[3] = { VTK_UNSIGNED_CHAR, VTK_SHORT, VTK_FLOAT };
+  const int sizes[4][3] = { { 1, 1, 1 }, { 3, 3, 3 }, { 70, 1, 2 },
+                            { 8, 5, 4 } };
+
+  vtkNew<vtkImageContinuousDilate3D> dilate;
+  vtkNew<vtkImageContinuousErode3D> erode;
+  vtkNew<vtkImageDilateErode3D> dilateErode;
+  dilate->SetKernelShapeToBox();
+  erode->SetKernelShapeToBox();
+  dilateErode->SetKernelShapeToBox();
+  dilateErode->SetDilateValue(255.0);
+  dilateErode->SetErodeValue(0.0);
+  dilate->EnableSMPOn();
+  dilate->SetDesiredBytesPerPiece(2048);
+  dilateErode->EnableSMPOn();
+  dilateErode->SetDesiredBytesPerPiece(2048);
+
+  for (int t = 0; t < 3; ++t)
+    {
+    vtkImageData *image = MakeImage(types[t], (t == 1 ? 2 : 1), false);
+    vtkImageData *binary = MakeImage(types[t], 1, true);
+    dilate->SetInputData(image);
+    erode->SetInputData(image);
+    dilateErode->SetInputData(binary);
+    bool ok = true;
+    for (int s = 0; s < 4 && ok; ++s)
+      {
+      const int *size = sizes[s];
+      dilate->SetKernelSize(size[0], size[1], size[2]);
+      erode->SetKernelSize(size[0], size[1], size[2]);
+      dilateErode->SetKernelSize(size[0], size[1], size[2]);
+      dilate->Update();
+      erode->Update();
+      dilateErode->Update();
+      ok = Check(image, dilate->GetOutput(), 0, size, "dilate") &&
+        Check(image, erode->GetOutput(), 1, size, "erode") &&
+        Check(binary, dilateErode->GetOutput(), 2, size, "dilate/erode");
+      }
+    image->Delete();
+    binary->Delete();
+    if (!ok)
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
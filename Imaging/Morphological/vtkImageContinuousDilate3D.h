@@ -44,11 +44,27 @@ public:
   // default middle of the neighborhood and computes the elliptical foot print.
   void SetKernelSize(int size0, int size1, int size2);
 
+  // Description:
+  // Set the shape of the neighborhood.  Ellipsoid, the default, uses the
+  // ellipsoid that fits in the kernel.  Box uses all the voxels of the
+  // kernel, and computes the maximum axis by axis at a cost per voxel that
+  // does not depend on the kernel size.
+  enum KernelShapeEnum
+  {
+    ELLIPSOID = 0,
+    BOX = 1
+  };
+  vtkSetClampMacro(KernelShape, int, ELLIPSOID, BOX);
+  void SetKernelShapeToEllipsoid() { this->SetKernelShape(ELLIPSOID); }
+  void SetKernelShapeToBox() { this->SetKernelShape(BOX); }
+  vtkGetMacro(KernelShape, int);
+
 protected:
   vtkImageContinuousDilate3D();
   ~vtkImageContinuousDilate3D();
 
   vtkImageEllipsoidSource *Ellipse;
+  int KernelShape;
 
   void ThreadedRequestData(vtkInformation *request,
                            vtkInformationVector **inputVector,
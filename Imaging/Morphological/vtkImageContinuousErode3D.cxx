@@ -17,6 +17,7 @@
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageMorphologyInternals.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -31,6 +32,7 @@ vtkStandardNewMacro(vtkImageContinuousErode3D);
 vtkImageContinuousErode3D::vtkImageContinuousErode3D()
 {
   this->HandleBoundaries = 1;
+  this->KernelShape = ELLIPSOID;
   this->KernelSize[0] = 1;
   this->KernelSize[1] = 1;
   this->KernelSize[2] = 1;
@@ -54,6 +56,8 @@ vtkImageContinuousErode3D::~vtkImageContinuousErode3D()
 void vtkImageContinuousErode3D::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+  os << indent << "KernelShape: "
+     << (this->KernelShape == BOX ? "Box\n" : "Ellipsoid\n");
 }
 
 //----------------------------------------------------------------------------
@@ -269,6 +273,54 @@ void vtkImageContinuousErode3DExecute(vtkImageContinuousErode3D *self,
     }
 }
 
+//----------------------------------------------------------------------------
+// The box kernel is separable, so the minimum is computed along x, y and
+// z in turn with the running minimum of vtkImageMorphologyLine.
+template <class T>
+void vtkImageContinuousErode3DBoxExecute(vtkImageContinuousErode3D *self,
+                                         vtkImageData *inData,
+                                         vtkDataArray *inArray,
+                                         vtkImageData *outData,
+                                         int *outExt, T *outPtr, int id,
+                                         vtkInformation *inInfo)
+{
+  int *kernelSize = self->GetKernelSize();
+  int *kernelMiddle = self->GetKernelMiddle();
+  int *inExt = inData->GetExtent();
+  int inImageExt[6];
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inImageExt);
+
+  // the neighborhoods of the output voxels, within the input
+  int boxExt[6];
+  for (int axis = 0; axis < 3; axis++)
+    {
+    int lo = outExt[2*axis] - kernelMiddle[axis];
+    int hi = outExt[2*axis + 1] - kernelMiddle[axis] + kernelSize[axis] - 1;
+    boxExt[2*axis] = (lo > inImageExt[2*axis] ? lo : inImageExt[2*axis]);
+    boxExt[2*axis + 1] =
+      (hi < inImageExt[2*axis + 1] ? hi : inImageExt[2*axis + 1]);
+    }
+
+  vtkIdType inInc[3], outInc[3];
+  inData->GetIncrements(inInc);
+  outData->GetIncrements(outInc);
+  int numComps = outData->GetNumberOfScalarComponents();
+  T *inPtr = static_cast<T *>(inArray->GetVoidPointer(
+    (boxExt[0] - inExt[0])*inInc[0] + (boxExt[2] - inExt[2])*inInc[1] +
+    (boxExt[4] - inExt[4])*inInc[2]));
+
+  for (int idxC = 0; idxC < numComps && !self->AbortExecute; idxC++)
+    {
+    vtkImageMorphologyBox<T, vtkImageMorphologyMin<T> >(
+      inPtr + idxC, inInc, boxExt, outPtr + idxC, outInc, outExt,
+      kernelSize, kernelMiddle);
+    if (id == 0)
+      {
+      self->UpdateProgress((idxC + 1.0)/numComps);
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 // This method contains the first switch statement that calls the correct
 // templated function for the input and output Data types.
@@ -302,14 +354,6 @@ void vtkImageContinuousErode3D::ThreadedRequestData(
   // The inPtr is reset anyway, so just get the id 0 pointer.
   inPtr = inArray->GetVoidPointer(0);
 
-  // Error checking on mask
-  mask = this->Ellipse->GetOutput();
-  if (mask->GetScalarType() != VTK_UNSIGNED_CHAR)
-    {
-    vtkErrorMacro(<< "Execute: mask has wrong scalar type");
-    return;
-    }
-
   // this filter expects the output type to be same as input
   if (outData[0]->GetScalarType() != inArray->GetDataType())
     {
@@ -319,6 +363,28 @@ void vtkImageContinuousErode3D::ThreadedRequestData(
     return;
     }
 
+  if (this->KernelShape == BOX)
+    {
+    switch (inArray->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkImageContinuousErode3DBoxExecute(
+          this, inData[0][0], inArray, outData[0], outExt,
+          static_cast<VTK_TT *>(outPtr), id, inInfo));
+      default:
+        vtkErrorMacro(<< "Execute: Unknown ScalarType");
+      }
+    return;
+    }
+
+  // Error checking on mask
+  mask = this->Ellipse->GetOutput();
+  if (mask->GetScalarType() != VTK_UNSIGNED_CHAR)
+    {
+    vtkErrorMacro(<< "Execute: mask has wrong scalar type");
+    return;
+    }
+
   switch (inArray->GetDataType())
     {
     vtkTemplateMacro(
@@ -15,11 +15,14 @@
 #include "vtkImageDilateErode3D.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageMorphologyInternals.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkImageDilateErode3D);
 
 //----------------------------------------------------------------------------
@@ -28,6 +31,7 @@ vtkStandardNewMacro(vtkImageDilateErode3D);
 vtkImageDilateErode3D::vtkImageDilateErode3D()
 {
   this->HandleBoundaries = 1;
+  this->KernelShape = ELLIPSOID;
   this->KernelSize[0] = 1;
   this->KernelSize[1] = 1;
   this->KernelSize[2] = 1;
@@ -57,6 +61,8 @@ void vtkImageDilateErode3D::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "DilateValue: " << this->DilateValue << "\n";
   os << indent << "ErodeValue: " << this->ErodeValue << "\n";
+  os << indent << "KernelShape: "
+     << (this->KernelShape == BOX ? "Box\n" : "Ellipsoid\n");
 }
 
 //----------------------------------------------------------------------------
@@ -269,6 +275,137 @@ void vtkImageDilateErode3DExecute(vtkImageDilateErode3D *self,
     }
 }
 
+//----------------------------------------------------------------------------
+// With the box kernel, an ErodeValue voxel becomes DilateValue if any
+// voxel of its box is DilateValue.  The DilateValue voxels are packed in
+// rows of bits that are dilated along x with word shifts, then along y
+// and z with the running "or" of vtkImageMorphologyLine on whole words.
+template <class T>
+void vtkImageDilateErode3DBoxExecute(vtkImageDilateErode3D *self,
+                                     vtkImageData *inData,
+                                     vtkImageData *outData,
+                                     int *outExt, T *outPtr, int id,
+                                     vtkInformation *inInfo)
+{
+  int *kernelSize = self->GetKernelSize();
+  int *kernelMiddle = self->GetKernelMiddle();
+  T erodeValue = static_cast<T>(self->GetErodeValue());
+  T dilateValue = static_cast<T>(self->GetDilateValue());
+  int inImageExt[6];
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), inImageExt);
+
+  // the neighborhoods of the output voxels, within the image
+  int boxExt[6];
+  for (int axis = 0; axis < 3; axis++)
+    {
+    int lo = outExt[2*axis] - kernelMiddle[axis];
+    int hi = outExt[2*axis + 1] - kernelMiddle[axis] + kernelSize[axis] - 1;
+    boxExt[2*axis] = (lo > inImageExt[2*axis] ? lo : inImageExt[2*axis]);
+    boxExt[2*axis + 1] =
+      (hi < inImageExt[2*axis + 1] ? hi : inImageExt[2*axis + 1]);
+    }
+
+  vtkIdType inInc[3], outInc[3];
+  inData->GetIncrements(inInc);
+  outData->GetIncrements(outInc);
+  int numComps = outData->GetNumberOfScalarComponents();
+  T *inPtr = static_cast<T *>(
+    inData->GetScalarPointer(boxExt[0], boxExt[2], boxExt[4]));
+
+  // bit i of a row is the voxel boxExt[0] + i
+  int nxIn = boxExt[1] - boxExt[0] + 1;
+  int nyIn = boxExt[3] - boxExt[2] + 1;
+  int nzIn = boxExt[5] - boxExt[4] + 1;
+  int ny = outExt[3] - outExt[2] + 1;
+  int nz = outExt[5] - outExt[4] + 1;
+  int numWords = (nxIn + 63)/64;
+  vtkIdType inRowSize = numWords*static_cast<vtkIdType>(nyIn);
+  vtkIdType outRowSize = numWords*static_cast<vtkIdType>(ny);
+  std::vector<vtkTypeUInt64> bits1(inRowSize*nzIn);
+  std::vector<vtkTypeUInt64> bits2(outRowSize*nzIn);
+  std::vector<vtkTypeUInt64> bits3(outRowSize*nz);
+  std::vector<vtkTypeUInt64> temp(3*numWords);
+  int maxLine = (ny + kernelSize[1] > nz + kernelSize[2] ?
+                 ny + kernelSize[1] : nz + kernelSize[2]);
+  std::vector<vtkTypeUInt64> g(maxLine);
+  std::vector<vtkTypeUInt64> h(maxLine);
+
+  for (int idxC = 0; idxC < numComps && !self->AbortExecute; idxC++)
+    {
+    // pack the DilateValue voxels and dilate them along x
+    for (int idxZ = 0; idxZ < nzIn; idxZ++)
+      {
+      for (int idxY = 0; idxY < nyIn; idxY++)
+        {
+        vtkTypeUInt64 *row = &bits1[idxZ*inRowSize + idxY*numWords];
+        const T *inRow = inPtr + idxC + idxY*inInc[1] + idxZ*inInc[2];
+        for (int w = 0; w < numWords; w++)
+          {
+          row[w] = 0;
+          }
+        for (int idxX = 0; idxX < nxIn; idxX++)
+          {
+          if (inRow[idxX*inInc[0]] == dilateValue)
+            {
+            row[idxX >> 6] |= static_cast<vtkTypeUInt64>(1) << (idxX & 63);
+            }
+          }
+        vtkImageMorphologyDilateRow(row, numWords, kernelSize[0],
+                                    kernelMiddle[0], &temp[0]);
+        }
+      }
+
+    // along y, then along z
+    for (int idxZ = 0; idxZ < nzIn; idxZ++)
+      {
+      for (int w = 0; w < numWords; w++)
+        {
+        vtkImageMorphologyLine<vtkTypeUInt64, vtkImageMorphologyOr>(
+          &bits1[idxZ*inRowSize + w], numWords, boxExt[2], boxExt[3],
+          &bits2[idxZ*outRowSize + w], numWords, outExt[2], outExt[3],
+          kernelSize[1], kernelMiddle[1], &g[0], &h[0]);
+        }
+      }
+    for (vtkIdType w = 0; w < outRowSize; w++)
+      {
+      vtkImageMorphologyLine<vtkTypeUInt64, vtkImageMorphologyOr>(
+        &bits2[w], outRowSize, boxExt[4], boxExt[5],
+        &bits3[w], outRowSize, outExt[4], outExt[5],
+        kernelSize[2], kernelMiddle[2], &g[0], &h[0]);
+      }
+
+    // erode values that have a dilate value in their box
+    for (int idxZ = outExt[4]; idxZ <= outExt[5]; idxZ++)
+      {
+      for (int idxY = outExt[2]; idxY <= outExt[3]; idxY++)
+        {
+        const vtkTypeUInt64 *row = &bits3[(idxZ - outExt[4])*outRowSize +
+                                          (idxY - outExt[2])*numWords];
+        const T *inRow = inPtr + idxC + (idxY - boxExt[2])*inInc[1] +
+          (idxZ - boxExt[4])*inInc[2];
+        T *outRow = outPtr + idxC + (idxY - outExt[2])*outInc[1] +
+          (idxZ - outExt[4])*outInc[2];
+        for (int idxX = outExt[0]; idxX <= outExt[1]; idxX++)
+          {
+          int bit = idxX - boxExt[0];
+          T v = inRow[bit*inInc[0]];
+          if (v == erodeValue && ((row[bit >> 6] >> (bit & 63)) & 1))
+            {
+            v = dilateValue;
+            }
+          *outRow = v;
+          outRow += outInc[0];
+          }
+        }
+      }
+
+    if (id == 0)
+      {
+      self->UpdateProgress((idxC + 1.0)/numComps);
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 // This method contains the first switch statement that calls the correct
 // templated function for the input and output Data types.
@@ -289,14 +426,6 @@ void vtkImageDilateErode3D::ThreadedRequestData(
   void *outPtr = outData[0]->GetScalarPointerForExtent(outExt);
   vtkImageData *mask;
 
-  // Error checking on mask
-  mask = this->Ellipse->GetOutput();
-  if (mask->GetScalarType() != VTK_UNSIGNED_CHAR)
-    {
-    vtkErrorMacro(<< "Execute: mask has wrong scalar type");
-    return;
-    }
-
   // this filter expects the output type to be same as input
   if (outData[0]->GetScalarType() != inData[0][0]->GetScalarType())
     {
@@ -306,6 +435,28 @@ void vtkImageDilateErode3D::ThreadedRequestData(
     return;
     }
 
+  if (this->KernelShape == BOX)
+    {
+    switch (inData[0][0]->GetScalarType())
+      {
+      vtkTemplateMacro(
+        vtkImageDilateErode3DBoxExecute(
+          this, inData[0][0], outData[0], outExt,
+          static_cast<VTK_TT *>(outPtr), id, inInfo));
+      default:
+        vtkErrorMacro(<< "Execute: Unknown ScalarType");
+      }
+    return;
+    }
+
+  // Error checking on mask
+  mask = this->Ellipse->GetOutput();
+  if (mask->GetScalarType() != VTK_UNSIGNED_CHAR)
+    {
+    vtkErrorMacro(<< "Execute: mask has wrong scalar type");
+    return;
+    }
+
   switch (inData[0][0]->GetScalarType())
     {
     vtkTemplateMacro(
@@ -45,6 +45,22 @@ public:
   // default middle of the neighborhood and computes the elliptical foot print.
   void SetKernelSize(int size0, int size1, int size2);
 
+  // Description:
+  // Set the shape of the neighborhood.  Ellipsoid, the default, uses the
+  // ellipsoid that fits in the kernel.  Box uses all the voxels of the
+  // kernel, and dilates a bit mask of the DilateValue voxels, 64 voxels at
+  // a time along x, at a cost per voxel that does not depend on the kernel
+  // size.
+  enum KernelShapeEnum
+  {
+    ELLIPSOID = 0,
+    BOX = 1
+  };
+  vtkSetClampMacro(KernelShape, int, ELLIPSOID, BOX);
+  void SetKernelShapeToEllipsoid() { this->SetKernelShape(ELLIPSOID); }
+  void SetKernelShapeToBox() { this->SetKernelShape(BOX); }
+  vtkGetMacro(KernelShape, int);
+
 
   // Description:
   // Set/Get the Dilate and Erode values to be used by this filter.
@@ -58,6 +74,7 @@ protected:
   ~vtkImageDilateErode3D();
 
   vtkImageEllipsoidSource *Ellipse;
+  int KernelShape;
   double DilateValue;
   double ErodeValue;
 
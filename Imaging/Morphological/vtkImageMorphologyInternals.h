@@ -0,0 +1,259 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageMorphologyInternals.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImageMorphologyInternals - internals for box kernels
+// .SECTION Description
+// Separable maxima and minima over boxes, shared by the filters of
+// Imaging/Morphological that offer a box kernel shape.  Along each axis,
+// the running maximum over a window of k samples is computed with the
+// algorithm of van Herk and Gil-Werman: the line is cut in blocks of k
+// samples, and a maximum is the maximum of a suffix of one block and of a
+// prefix of the next block, which costs three comparisons per sample
+// whatever the size of the window.  Binary images are handled by packing
+// 64 voxels per word, so that a line of words is dilated with a few shifts
+// along x and with the same running maximum (an "or") along y and z.
+//
+// M. van Herk, "A fast algorithm for local minimum and maximum filters on
+// rectangular and octagonal kernels", Pattern Recognition Letters 13, 1992.
+// J. Gil and M. Werman, "Computing 2-D min, median, and max filters",
+// IEEE Trans. on Pattern Analysis and Machine Intelligence 15, 1993.
+
+#ifndef vtkImageMorphologyInternals_h
+#define vtkImageMorphologyInternals_h
+
+#include "vtkType.h"
+
+#include <vector>
+
+// The operators of the dilation and of the erosion
+template<class T>
+struct vtkImageMorphologyMax
+{
+  static T Apply(T a, T b) { return (a < b ? b : a); }
+};
+
+template<class T>
+struct vtkImageMorphologyMin
+{
+  static T Apply(T a, T b) { return (b < a ? b : a); }
+};
+
+struct vtkImageMorphologyOr
+{
+  static vtkTypeUInt64 Apply(vtkTypeUInt64 a, vtkTypeUInt64 b)
+  {
+    return (a | b);
+  }
+};
+
+// Compute out[i] = Op over in[j], i - middle <= j < i - middle + size, for
+// the positions outMin <= i <= outMax.  The input holds the positions
+// inMin to inMax, and the positions outside of it are ignored: they take
+// the value of the nearest end of the input, which is in the window since
+// every window holds its own output position.  The work buffers g and h
+// must hold outMax - outMin + size samples.
+template<class T, class Op>
+void vtkImageMorphologyLine(
+  const T *in, vtkIdType inInc, int inMin, int inMax,
+  T *out, vtkIdType outInc, int outMin, int outMax,
+  int size, int middle, T *g, T *h)
+{
+  int start = outMin - middle;
+  int n = outMax - outMin + size;
+
+  // prefix maxima of the blocks in g, and the samples in h
+  int k = 0;
+  for (int j = 0; j < n; j++)
+    {
+    int pos = start + j;
+    pos = (pos < inMin ? inMin : (pos > inMax ? inMax : pos));
+    T v = in[(pos - inMin)*inInc];
+    h[j] = v;
+    g[j] = (k == 0 ? v : Op::Apply(g[j - 1], v));
+    if (++k == size)
+      {
+      k = 0;
+      }
+    }
+
+  // suffix maxima of the blocks in h, the last block may be partial
+  for (int j = n - 2; j >= 0; j--)
+    {
+    if ((j + 1) % size != 0)
+      {
+      h[j] = Op::Apply(h[j], h[j + 1]);
+      }
+    }
+
+  for (int i = 0; i <= outMax - outMin; i++)
+    {
+    out[i*outInc] = Op::Apply(h[i], g[i + size - 1]);
+    }
+}
+
+// Apply Op over a box of kernelSize voxels, whose voxel kernelMiddle is at
+// the output voxel, to one component of the inExt region of an image.
+// The pointers point at the first voxel of each region, and increments are
+// counted in T.  The voxels outside of inExt are ignored, so inExt must
+// hold the neighborhoods of the output that lie within the whole extent.
+template<class T, class Op>
+void vtkImageMorphologyBox(
+  const T *inPtr, const vtkIdType inInc[3], const int inExt[6],
+  T *outPtr, const vtkIdType outInc[3], const int outExt[6],
+  const int kernelSize[3], const int kernelMiddle[3])
+{
+  int nx = outExt[1] - outExt[0] + 1;
+  int ny = outExt[3] - outExt[2] + 1;
+  int nyIn = inExt[3] - inExt[2] + 1;
+  int nzIn = inExt[5] - inExt[4] + 1;
+
+  int maxLine = 0;
+  for (int axis = 0; axis < 3; axis++)
+    {
+    int n = outExt[2*axis + 1] - outExt[2*axis] + kernelSize[axis];
+    maxLine = (n > maxLine ? n : maxLine);
+    }
+  std::vector<T> g(maxLine);
+  std::vector<T> h(maxLine);
+
+  // along x, into rows of the output width for all input rows
+  std::vector<T> temp1(static_cast<vtkIdType>(nx)*nyIn*nzIn);
+  T *rowPtr = &temp1[0];
+  for (int idxZ = 0; idxZ < nzIn; idxZ++)
+    {
+    for (int idxY = 0; idxY < nyIn; idxY++)
+      {
+      vtkImageMorphologyLine<T, Op>(
+        inPtr + idxY*inInc[1] + idxZ*inInc[2], inInc[0], inExt[0], inExt[1],
+        rowPtr, 1, outExt[0], outExt[1],
+        kernelSize[0], kernelMiddle[0], &g[0], &h[0]);
+      rowPtr += nx;
+      }
+    }
+
+  // along y, into slices of the output size for all input slices
+  std::vector<T> temp2(static_cast<vtkIdType>(nx)*ny*nzIn);
+  for (int idxZ = 0; idxZ < nzIn; idxZ++)
+    {
+    for (int idxX = 0; idxX < nx; idxX++)
+      {
+      vtkImageMorphologyLine<T, Op>(
+        &temp1[static_cast<vtkIdType>(idxZ)*nx*nyIn + idxX], nx,
+        inExt[2], inExt[3],
+        &temp2[static_cast<vtkIdType>(idxZ)*nx*ny + idxX], nx,
+        outExt[2], outExt[3],
+        kernelSize[1], kernelMiddle[1], &g[0], &h[0]);
+      }
+    }
+
+  // along z, into the output
+  vtkIdType sliceSize = static_cast<vtkIdType>(nx)*ny;
+  for (int idxY = 0; idxY < ny; idxY++)
+    {
+    for (int idxX = 0; idxX < nx; idxX++)
+      {
+      vtkImageMorphologyLine<T, Op>(
+        &temp2[idxY*nx + idxX], sliceSize, inExt[4], inExt[5],
+        outPtr + idxX*outInc[0] + idxY*outInc[1], outInc[2],
+        outExt[4], outExt[5],
+        kernelSize[2], kernelMiddle[2], &g[0], &h[0]);
+      }
+    }
+}
+
+// Set the bits of the words of a row that is shifted by "shift" bits
+// towards the lower positions (or towards the higher ones if negative),
+// the bits that come from outside of the row being zero.
+inline void vtkImageMorphologyShiftRow(
+  const vtkTypeUInt64 *row, vtkTypeUInt64 *out, int numWords, int shift)
+{
+  int wordShift = (shift >= 0 ? shift : -shift) / 64;
+  int bitShift = (shift >= 0 ? shift : -shift) % 64;
+  for (int w = 0; w < numWords; w++)
+    {
+    vtkTypeUInt64 v = 0;
+    if (shift >= 0)
+      {
+      int s = w + wordShift;
+      if (s < numWords)
+        {
+        v = row[s] >> bitShift;
+        if (bitShift && s + 1 < numWords)
+          {
+          v |= row[s + 1] << (64 - bitShift);
+          }
+        }
+      }
+    else
+      {
+      int s = w - wordShift;
+      if (s >= 0)
+        {
+        v = row[s] << bitShift;
+        if (bitShift && s > 0)
+          {
+          v |= row[s - 1] >> (64 - bitShift);
+          }
+        }
+      }
+    out[w] = v;
+    }
+}
+
+// Set out[p] to the or of row[p] to row[p + length - 1] if direction is 1,
+// or of row[p - length + 1] to row[p] if direction is -1, by doubling the
+// length of the window.  The buffer "temp" must hold numWords words.
+inline void vtkImageMorphologyWindowRow(
+  const vtkTypeUInt64 *row, vtkTypeUInt64 *out, int numWords,
+  int length, int direction, vtkTypeUInt64 *temp)
+{
+  for (int w = 0; w < numWords; w++)
+    {
+    out[w] = row[w];
+    }
+  int n = 1;
+  while (n < length)
+    {
+    int step = (2*n <= length ? n : length - n);
+    vtkImageMorphologyShiftRow(out, temp, numWords, direction*step);
+    for (int w = 0; w < numWords; w++)
+      {
+      out[w] |= temp[w];
+      }
+    n += step;
+    }
+}
+
+// Dilate a row of bits in place over a window of "size" bits whose bit
+// "middle" is at the output bit, as the union of the window that starts
+// at the output bit and of the one that ends there.  The buffer "temp"
+// must hold 3*numWords words.
+inline void vtkImageMorphologyDilateRow(
+  vtkTypeUInt64 *row, int numWords, int size, int middle,
+  vtkTypeUInt64 *temp)
+{
+  vtkTypeUInt64 *forward = temp;
+  vtkTypeUInt64 *backward = temp + numWords;
+  vtkTypeUInt64 *work = temp + 2*numWords;
+
+  vtkImageMorphologyWindowRow(row, forward, numWords, size - middle, 1, work);
+  vtkImageMorphologyWindowRow(row, backward, numWords, middle + 1, -1, work);
+  for (int w = 0; w < numWords; w++)
+    {
+    row[w] = forward[w] | backward[w];
+    }
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkImageMorphologyInternals.h
@@ -21,12 +21,18 @@
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageAccumulate);
 
+// The largest number of bins for which every thread has its own bins
+#define VTK_ACCUMULATE_MAX_PARALLEL_BINS 1048576
+
 //----------------------------------------------------------------------------
 // Constructor sets default values
 vtkImageAccumulate::vtkImageAccumulate()
@@ -123,6 +129,171 @@ vtkImageStencilData *vtkImageAccumulate::GetStencil()
 }
 
 
+//----------------------------------------------------------------------------
+// The bins and the sums of the voxels seen by one thread.
+struct vtkImageAccumulatePartial
+{
+  std::vector<vtkIdType> Bins;
+  double Sum[3];
+  double SumSqr[3];
+  double Min[3];
+  double Max[3];
+  vtkIdType Count;
+};
+
+//----------------------------------------------------------------------------
+// Accumulate the rows of the extent in parallel.  Every thread has its own
+// bins and sums, which are added together by Reduce() once all the rows
+// are done, so that the histogram and the statistics take a single pass.
+template <class T>
+class vtkImageAccumulateRows
+{
+public:
+  vtkImageAccumulateRows(vtkImageData *inData, vtkImageStencilData *stencil,
+                         const int extent[6], bool reverseStencil,
+                         bool ignoreZero, int numC, const int outExtent[6],
+                         const vtkIdType outIncs[3], const double origin[3],
+                         const double spacing[3], vtkIdType size) :
+    InData(inData), Stencil(stencil), Extent(extent),
+    ReverseStencil(reverseStencil), IgnoreZero(ignoreZero),
+    NumberOfComponents(numC), OutExtent(outExtent), OutIncs(outIncs),
+    Origin(origin), Spacing(spacing), Size(size) {}
+
+  void Initialize()
+  {
+    vtkImageAccumulatePartial &partial = this->Partials.Local();
+    partial.Bins.assign(this->Size, 0);
+    for (int idxC = 0; idxC < 3; ++idxC)
+      {
+      partial.Sum[idxC] = 0.0;
+      partial.SumSqr[idxC] = 0.0;
+      partial.Min[idxC] = VTK_DOUBLE_MAX;
+      partial.Max[idxC] = VTK_DOUBLE_MIN;
+      }
+    partial.Count = 0;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType sizeY = this->Extent[3] - this->Extent[2] + 1;
+    vtkIdType row = begin;
+    while (row < end)
+      {
+      // the rows [begin, end) that lie in the slice of the first one
+      int idZ = this->Extent[4] + static_cast<int>(row / sizeY);
+      int idY = this->Extent[2] + static_cast<int>(row % sizeY);
+      vtkIdType rows = end - row;
+      if (rows > this->Extent[3] - idY + 1)
+        {
+        rows = this->Extent[3] - idY + 1;
+        }
+      int extent[6];
+      extent[0] = this->Extent[0];
+      extent[1] = this->Extent[1];
+      extent[2] = idY;
+      extent[3] = idY + static_cast<int>(rows) - 1;
+      extent[4] = idZ;
+      extent[5] = idZ;
+      this->Execute(extent);
+      row += rows;
+      }
+  }
+
+  void Reduce()
+  {
+  }
+
+  vtkSMPThreadLocal<vtkImageAccumulatePartial> Partials;
+
+private:
+  void Execute(const int extent[6])
+  {
+    vtkImageAccumulatePartial &partial = this->Partials.Local();
+    vtkIdType *outPtr = &partial.Bins[0];
+    double *sum = partial.Sum;
+    double *sumSqr = partial.SumSqr;
+    double *min = partial.Min;
+    double *max = partial.Max;
+    vtkIdType count = partial.Count;
+    int numC = this->NumberOfComponents;
+    const int *outExtent = this->OutExtent;
+    const vtkIdType *outIncs = this->OutIncs;
+
+    vtkImageStencilIterator<T> inIter(this->InData, this->Stencil, extent);
+
+    while (!inIter.IsAtEnd())
+      {
+      if (inIter.IsInStencil() ^ this->ReverseStencil)
+        {
+        T *inPtr = inIter.BeginSpan();
+        T *spanEndPtr = inIter.EndSpan();
+
+        while (inPtr != spanEndPtr)
+          {
+          // find the bin for this pixel.
+          bool outOfBounds = false;
+          vtkIdType *outPtrC = outPtr;
+          for (int idxC = 0; idxC < numC; ++idxC)
+            {
+            double v = static_cast<double>(*inPtr++);
+            if (!this->IgnoreZero || v != 0)
+              {
+              // gather statistics
+              sum[idxC] += v;
+              sumSqr[idxC] += v*v;
+              if (v > max[idxC])
+                {
+                max[idxC] = v;
+                }
+              if (v < min[idxC])
+                {
+                min[idxC] = v;
+                }
+              count++;
+              }
+
+            // compute the index
+            int outIdx = vtkMath::Floor(
+              (v - this->Origin[idxC]) / this->Spacing[idxC]);
+
+            // verify that it is in range
+            if (outIdx >= outExtent[idxC*2] && outIdx <= outExtent[idxC*2+1])
+              {
+              outPtrC += (outIdx - outExtent[idxC*2]) * outIncs[idxC];
+              }
+            else
+              {
+              outOfBounds = true;
+              }
+            }
+
+          // increment the bin
+          if (!outOfBounds)
+            {
+            ++(*outPtrC);
+            }
+          }
+        }
+
+      inIter.NextSpan();
+      }
+
+    partial.Count = count;
+  }
+
+  vtkImageData *InData;
+  vtkImageStencilData *Stencil;
+  const int *Extent;
+  bool ReverseStencil;
+  bool IgnoreZero;
+  int NumberOfComponents;
+  const int *OutExtent;
+  const vtkIdType *OutIncs;
+  const double *Origin;
+  const double *Spacing;
+  vtkIdType Size;
+};
+
 //----------------------------------------------------------------------------
 // This templated function executes the filter for any type of data.
 template <class T>
@@ -176,62 +347,41 @@ int vtkImageAccumulateExecute(vtkImageAccumulate *self,
   bool reverseStencil = (self->GetReverseStencil() != 0);
   bool ignoreZero = (self->GetIgnoreZero() != 0);
 
-  vtkImageStencilIterator<T> inIter(inData, stencil, updateExtent, self);
+  vtkImageAccumulateRows<T> rows(
+    inData, stencil, updateExtent, reverseStencil, ignoreZero, numC,
+    outExtent, outIncs, origin, spacing, size);
 
-  while (!inIter.IsAtEnd())
+  if (updateExtent[0] <= updateExtent[1] &&
+      updateExtent[2] <= updateExtent[3] &&
+      updateExtent[4] <= updateExtent[5])
     {
-    if (inIter.IsInStencil() ^ reverseStencil)
-      {
-      T *inPtr = inIter.BeginSpan();
-      T *spanEndPtr = inIter.EndSpan();
-
-      while (inPtr != spanEndPtr)
-        {
-        // find the bin for this pixel.
-        bool outOfBounds = false;
-        vtkIdType *outPtrC = outPtr;
-        for (int idxC = 0; idxC < numC; ++idxC)
-          {
-          double v = static_cast<double>(*inPtr++);
-          if (!ignoreZero || v != 0)
-            {
-            // gather statistics
-            sum[idxC] += v;
-            sumSqr[idxC] += v*v;
-            if (v > max[idxC])
-              {
-              max[idxC] = v;
-              }
-            if (v < min[idxC])
-              {
-              min[idxC] = v;
-              }
-            (*voxelCount)++;
-            }
-
-          // compute the index
-          int outIdx = vtkMath::Floor((v - origin[idxC]) / spacing[idxC]);
-
-          // verify that it is in range
-          if (outIdx >= outExtent[idxC*2] && outIdx <= outExtent[idxC*2+1])
-            {
-            outPtrC += (outIdx - outExtent[idxC*2]) * outIncs[idxC];
-            }
-          else
-            {
-            outOfBounds = true;
-            }
-          }
+    vtkIdType numberOfRows = updateExtent[3] - updateExtent[2] + 1;
+    numberOfRows *= updateExtent[5] - updateExtent[4] + 1;
+    // with millions of bins, the copies of the bins would cost more
+    // memory than threads save time, so all rows go to a single thread
+    vtkIdType grain = (size > VTK_ACCUMULATE_MAX_PARALLEL_BINS ?
+                       numberOfRows : 0);
+    vtkSMPTools::For(0, numberOfRows, grain, rows);
+    }
 
-        // increment the bin
-        if (!outOfBounds)
-          {
-          ++(*outPtrC);
-          }
-        }
+  // add up the bins and the sums of the threads
+  for (typename vtkSMPThreadLocal<vtkImageAccumulatePartial>::iterator
+         iter = rows.Partials.begin(); iter != rows.Partials.end(); ++iter)
+    {
+    vtkImageAccumulatePartial &partial = *iter;
+    const vtkIdType *bins = &partial.Bins[0];
+    for (vtkIdType j = 0; j < size; j++)
+      {
+      outPtr[j] += bins[j];
       }
-
-    inIter.NextSpan();
+    for (int idxC = 0; idxC < 3; ++idxC)
+      {
+      sum[idxC] += partial.Sum[idxC];
+      sumSqr[idxC] += partial.SumSqr[idxC];
+      min[idxC] = (partial.Min[idxC] < min[idxC] ? partial.Min[idxC] : min[idxC]);
+      max[idxC] = (partial.Max[idxC] > max[idxC] ? partial.Max[idxC] : max[idxC]);
+      }
+    *voxelCount += partial.Count;
     }
 
   // initialize the statistics
@@ -24,9 +24,12 @@
 #include "vtkInformationVector.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkMultiThreader.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTemplateAliasMacro.h"
 
 #include <cmath>
+#include <vector>
 
 // turn off 64-bit ints when templating over all types
 # undef VTK_USE_INT64
@@ -480,6 +483,185 @@ void vtkImageHistogramExecuteInt(
 {
 }
 
+//----------------------------------------------------------------------------
+// Integer binning for the pieces executed with vtkSMPTools, which use
+// histograms that cover all the bins: the bin index is clamped instead
+// of relying on a scan of the data range.  It is only called for the
+// integer types.
+template<class T>
+void vtkImageHistogramExecuteIntClamp(
+  vtkImageData *inData, vtkImageStencilData *stencil, int extent[6],
+  vtkIdType *outPtr, vtkIdType offset, vtkIdType maxBin, int component)
+{
+  vtkImageStencilIterator<T> inIter(inData, stencil, extent, NULL);
+
+  // set up components
+  int nc = inData->GetNumberOfScalarComponents();
+  int c = component;
+  if (c < 0)
+    {
+    nc = 1;
+    c = 0;
+    }
+
+  // iterate over all spans in the stencil
+  while (!inIter.IsAtEnd())
+    {
+    if (inIter.IsInStencil())
+      {
+      T *inPtr = inIter.BeginSpan();
+      T *inPtrEnd = inIter.EndSpan();
+
+      // iterate over all voxels in the span
+      if (inPtr != inPtrEnd)
+        {
+        int n = static_cast<int>((inPtrEnd - inPtr)/nc);
+        inPtr += c;
+        do
+          {
+          vtkIdType xi = static_cast<vtkIdType>(*inPtr) - offset;
+          xi = (xi > 0 ? xi : 0);
+          xi = (xi < maxBin ? xi : maxBin);
+          outPtr[xi]++;
+          inPtr += nc;
+          }
+        while (--n);
+        }
+      }
+    inIter.NextSpan();
+    }
+}
+
+//----------------------------------------------------------------------------
+// Bin the pieces of the extent when EnableSMP is on.  Every thread fills
+// its own histogram, with all the bins, for all the pieces it executes.
+class vtkImageHistogramPieces
+{
+public:
+  vtkImageHistogramPieces(vtkImageHistogram *self, vtkImageData *inData,
+                          vtkImageStencilData *stencil, int extent[6],
+                          int pieces, int numberOfBins, double binOrigin,
+                          double binSpacing, int component) :
+    Self(self), InData(inData), Stencil(stencil), Extent(extent),
+    Pieces(pieces), NumberOfBins(numberOfBins), BinOrigin(binOrigin),
+    BinSpacing(binSpacing), Component(component) {}
+
+  void Initialize()
+  {
+    this->Histograms.Local().assign(this->NumberOfBins, 0);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType *histogram = &this->Histograms.Local()[0];
+    int scalarType = this->InData->GetScalarType();
+    int maxBin = this->NumberOfBins - 1;
+
+    // the fast method needs bins that are aligned with the integers
+    bool useFastExecute = (this->BinSpacing == 1.0 &&
+      this->BinOrigin == floor(this->BinOrigin) &&
+      scalarType != VTK_FLOAT && scalarType != VTK_DOUBLE);
+    vtkIdType offset = static_cast<vtkIdType>(this->BinOrigin);
+    int binRange[2] = { 0, maxBin };
+
+    for (vtkIdType piece = begin; piece < end; ++piece)
+      {
+      int extent[6];
+      this->Self->SplitExtent(extent, this->Extent, static_cast<int>(piece),
+                              this->Pieces);
+      if (extent[1] < extent[0] || extent[3] < extent[2] ||
+          extent[5] < extent[4])
+        {
+        continue;
+        }
+      void *inPtr = this->InData->GetScalarPointerForExtent(extent);
+
+      // a nonzero threadId, since progress cannot be reported from here
+      if (useFastExecute)
+        {
+        switch (scalarType)
+          {
+          vtkTemplateAliasMacro(
+            vtkImageHistogramExecuteIntClamp<VTK_TT>(
+              this->InData, this->Stencil, extent, histogram,
+              offset, maxBin, this->Component));
+          }
+        }
+      else
+        {
+        switch (scalarType)
+          {
+          vtkTemplateAliasMacro(
+            vtkImageHistogramExecute(
+              this->Self, this->InData, this->Stencil,
+              static_cast<VTK_TT *>(inPtr), extent, histogram, binRange,
+              this->BinOrigin, this->BinSpacing, this->Component, 1));
+          }
+        }
+      }
+  }
+
+  void Reduce()
+  {
+  }
+
+  vtkSMPThreadLocal<std::vector<vtkIdType> > Histograms;
+
+private:
+  vtkImageHistogram *Self;
+  vtkImageData *InData;
+  vtkImageStencilData *Stencil;
+  int *Extent;
+  int Pieces;
+  int NumberOfBins;
+  double BinOrigin;
+  double BinSpacing;
+  int Component;
+};
+
+//----------------------------------------------------------------------------
+// A partial histogram, which holds the bins [Range[0], Range[1]]
+struct vtkImageHistogramPartial
+{
+  vtkIdType *Bins;
+  int Range[2];
+};
+
+// Sum the partial histograms.  The bins are split between the threads,
+// so that the merge does not grow with the number of threads times the
+// number of bins on a single thread.
+class vtkImageHistogramMerge
+{
+public:
+  vtkImageHistogramMerge(const std::vector<vtkImageHistogramPartial> &parts,
+                         vtkIdType *histogram) :
+    Parts(parts), Histogram(histogram) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    vtkIdType *histogram = this->Histogram;
+    for (vtkIdType ix = begin; ix < end; ++ix)
+      {
+      histogram[ix] = 0;
+      }
+    for (size_t j = 0; j < this->Parts.size(); ++j)
+      {
+      const vtkImageHistogramPartial &part = this->Parts[j];
+      vtkIdType xmin = (part.Range[0] > begin ? part.Range[0] : begin);
+      vtkIdType xmax = (part.Range[1] < end - 1 ? part.Range[1] : end - 1);
+      const vtkIdType *bins = part.Bins - part.Range[0];
+      for (vtkIdType ix = xmin; ix <= xmax; ++ix)
+        {
+        histogram[ix] += bins[ix];
+        }
+      }
+  }
+
+private:
+  const std::vector<vtkImageHistogramPartial> &Parts;
+  vtkIdType *Histogram;
+};
+
 //----------------------------------------------------------------------------
 void vtkImageHistogramGenerateImage(
   vtkIdType *histogram, int nx,
@@ -703,56 +885,85 @@ int vtkImageHistogram::RequestData(
       }
     }
 
-  this->Threader->SetNumberOfThreads(this->NumberOfThreads);
-  this->Threader->SetSingleMethod(vtkImageHistogramThreadedExecute, &ts);
-
-  // always shut off debugging to avoid threading problems with GetMacros
-  bool debug = this->Debug;
-  this->Debug = false;
-  this->Threader->SingleMethodExecute();
-  this->Debug = debug;
-
-  // end of code copied from vtkThreadedImageAlgorithm
-
   // create the histogram array
   this->Histogram->SetNumberOfComponents(1);
   this->Histogram->SetNumberOfTuples(this->NumberOfBins);
   vtkIdType *histogram = this->Histogram->GetPointer(0);
-
-  // clear histogram to zero
   int nx = this->NumberOfBins;
-  int ix;
-  for (ix = 0; ix < nx; ++ix)
+
+  // the histograms of the threads, which are summed at the end
+  std::vector<vtkImageHistogramPartial> parts;
+
+  // always shut off debugging to avoid threading problems with GetMacros
+  bool debug = this->Debug;
+  this->Debug = false;
+
+  if (this->EnableSMP)
     {
-    histogram[ix] = 0;
-    }
+    // the pieces are binned into one histogram per thread, with all bins,
+    // which saves the scan of the data range of the pieces
+    int extent[6];
+    image->GetExtent(extent);
+    vtkImageData *inputs[1] = { image };
+    vtkImageData **inputsPtr[1] = { inputs };
+    vtkIdType pieces = this->GetNumberOfSMPPieces(inputsPtr, NULL, extent);
+    vtkImageHistogramPieces functor(
+      this, image, this->GetStencil(), extent, static_cast<int>(pieces),
+      nx, this->BinOrigin, this->BinSpacing, this->ActiveComponent);
+    if (pieces > 0)
+      {
+      vtkSMPTools::For(0, pieces, functor);
+      }
+    this->Debug = debug;
 
-  // piece together the histogram results from each thread
-  vtkIdType total = 0;
-  for (int j = 0; j < n; j++)
+    for (vtkSMPThreadLocal<std::vector<vtkIdType> >::iterator iter =
+           functor.Histograms.begin();
+         iter != functor.Histograms.end(); ++iter)
+      {
+      vtkImageHistogramPartial part;
+      part.Bins = &(*iter)[0];
+      part.Range[0] = 0;
+      part.Range[1] = nx - 1;
+      parts.push_back(part);
+      }
+    vtkSMPTools::For(0, nx, vtkImageHistogramMerge(parts, histogram));
+    }
+  else
     {
-    vtkIdType *outPtr2 = this->ThreadOutput[j];
-    if (outPtr2)
+    this->Threader->SetNumberOfThreads(this->NumberOfThreads);
+    this->Threader->SetSingleMethod(vtkImageHistogramThreadedExecute, &ts);
+    this->Threader->SingleMethodExecute();
+    this->Debug = debug;
+
+    for (int j = 0; j < n; j++)
       {
-      int xmin = this->ThreadBinRange[j][0];
-      int xmax = this->ThreadBinRange[j][1];
-      for (ix = xmin; ix <= xmax; ++ix)
+      if (this->ThreadOutput[j])
         {
-        vtkIdType c = *outPtr2++;
-        histogram[ix] += c;
-        total += c;
+        vtkImageHistogramPartial part;
+        part.Bins = this->ThreadOutput[j];
+        part.Range[0] = this->ThreadBinRange[j][0];
+        part.Range[1] = this->ThreadBinRange[j][1];
+        parts.push_back(part);
         }
       }
+    vtkSMPTools::For(0, nx, vtkImageHistogramMerge(parts, histogram));
+
+    // delete the temporary memory
+    for (int j = 0; j < n; j++)
+      {
+      delete [] this->ThreadOutput[j];
+      }
     }
 
-  // set the total
-  this->Total = total;
+  // end of code copied from vtkThreadedImageAlgorithm
 
-  // delete the temporary memory
-  for (int j = 0; j < n; j++)
+  // set the total
+  vtkIdType total = 0;
+  for (int ix = 0; ix < nx; ++ix)
     {
-    delete [] this->ThreadOutput[j];
+    total += histogram[ix];
     }
+  this->Total = total;
 
   // generate the output image
   if (this->GetNumberOfOutputPorts() > 0 &&
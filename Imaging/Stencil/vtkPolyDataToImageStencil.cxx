@@ -61,6 +61,7 @@ POSSIBILITY OF SUCH DAMAGES.
 #include "vtkPolyData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <map>
@@ -768,6 +769,35 @@ void vtkPolyDataToImageStencil::ThreadedExecute(
   slice->Delete();
 }
 
+//----------------------------------------------------------------------------
+// Each slice is cut from the input and rasterized into its own rows of the
+// stencil, so that slices are generated in parallel.  The input is only
+// read, and every call to ThreadedExecute has its own slice and raster.
+class vtkPolyDataToImageStencilSlices
+{
+public:
+  vtkPolyDataToImageStencilSlices(vtkPolyDataToImageStencil *self,
+                                  vtkImageStencilData *data,
+                                  const int extent[6]) :
+    Self(self), Data(data), Extent(extent) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    int sliceExtent[6];
+    sliceExtent[0] = this->Extent[0]; sliceExtent[1] = this->Extent[1];
+    sliceExtent[2] = this->Extent[2]; sliceExtent[3] = this->Extent[3];
+    sliceExtent[4] = static_cast<int>(begin);
+    sliceExtent[5] = static_cast<int>(end - 1);
+    // progress is only reported by RequestData, between the batches
+    this->Self->ThreadedExecute(this->Data, sliceExtent, 1);
+  }
+
+private:
+  vtkPolyDataToImageStencil *Self;
+  vtkImageStencilData *Data;
+  const int *Extent;
+};
+
 //----------------------------------------------------------------------------
 int vtkPolyDataToImageStencil::RequestData(
   vtkInformation *request,
@@ -783,9 +813,18 @@ int vtkPolyDataToImageStencil::RequestData(
 
   int extent[6];
   data->GetExtent(extent);
-  // ThreadedExecute is only called from a single thread for
-  // now, but it could as easily be called from ThreadedRequestData
-  this->ThreadedExecute(data, extent, 0);
+
+  // The slices are dispatched in batches, to report progress in between
+  vtkPolyDataToImageStencilSlices slices(this, data, extent);
+  int numberOfSlices = extent[5] - extent[4] + 1;
+  int numberOfBatches = (numberOfSlices < 10 ? numberOfSlices : 10);
+  for (int batch = 0; batch < numberOfBatches; batch++)
+    {
+    this->UpdateProgress(batch*1.0/numberOfBatches);
+    vtkIdType begin = extent[4] + batch*numberOfSlices/numberOfBatches;
+    vtkIdType end = extent[4] + (batch + 1)*numberOfSlices/numberOfBatches;
+    vtkSMPTools::For(begin, end, slices);
+    }
 
   return 1;
 }
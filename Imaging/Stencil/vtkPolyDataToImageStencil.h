@@ -111,6 +111,8 @@ protected:
   double Tolerance;
 
 private:
+  friend class vtkPolyDataToImageStencilSlices;
+
   vtkPolyDataToImageStencil(const vtkPolyDataToImageStencil&);  // Not implemented.
   void operator=(const vtkPolyDataToImageStencil&);  // Not implemented.
 };
@@ -40,54 +40,12 @@
 #include "vtkStringArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
-#include "vtkBoostGraphAdapter.h"
-#include "vtkDirectedGraph.h"
-#include "vtkUndirectedGraph.h"
-
-#include <boost/graph/visitors.hpp>
-#include <boost/graph/breadth_first_search.hpp>
-#include <boost/pending/queue.hpp>
-
-#include <utility> // for pair
-
-using namespace boost;
+#include "vtkGraphFrontier.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
 
 vtkStandardNewMacro(vtkBoostBreadthFirstSearch);
 
-// Redefine the bfs visitor, the only visitor we
-// are using is the tree_edge visitor.
-template <typename DistanceMap>
-class my_distance_recorder : public default_bfs_visitor
-{
-public:
-  my_distance_recorder() { }
-  my_distance_recorder(DistanceMap dist, vtkIdType* far)
-    : d(dist), far_vertex(far), far_dist(-1) { *far_vertex = -1; }
-
-  template <typename Vertex, typename Graph>
-  void examine_vertex(Vertex v, const Graph& vtkNotUsed(g))
-  {
-    if (get(d, v) > far_dist)
-      {
-      *far_vertex = v;
-      far_dist = get(d, v);
-      }
-  }
-
-  template <typename Edge, typename Graph>
-  void tree_edge(Edge e, const Graph& g)
-  {
-    typename graph_traits<Graph>::vertex_descriptor
-    u = source(e, g), v = target(e, g);
-    put(d, v, get(d, u) + 1);
-  }
-
-private:
-  DistanceMap d;
-  vtkIdType* far_vertex;
-  vtkIdType far_dist;
-};
-
 // Constructor/Destructor
 vtkBoostBreadthFirstSearch::vtkBoostBreadthFirstSearch()
 {
@@ -257,35 +215,26 @@ int vtkBoostBreadthFirstSearch::RequestData(
     }
   BFSArray->SetNumberOfTuples(output->GetNumberOfVertices());
 
-  // Initialize the BFS array to all 0's
-  for(int i=0;i< BFSArray->GetNumberOfTuples(); ++i)
-    {
-      BFSArray->SetValue(i, VTK_INT_MAX);
-    }
-
+  // Search the out edges of directed graphs from the origin, level by
+  // level in parallel.
+  vtkGraphFrontier* frontier = vtkGraphFrontier::New();
+  frontier->SetGraph(output);
+  frontier->SetEdgeDirection(vtkGraphFrontier::OUT_EDGES);
+  int* distances = BFSArray->GetPointer(0);
+  int maxDistance = frontier->BreadthFirstSearch(
+    &this->OriginVertexIndex, 1, distances);
+  frontier->Delete();
+
+  // The vertex farthest from the origin is the first one found at the
+  // largest distance.
   vtkIdType maxFromRootVertex = this->OriginVertexIndex;
-
-  // Create a color map (used for marking visited nodes)
-  vector_property_map<default_color_type> color(output->GetNumberOfVertices());
-
-  // Set the distance to the source vertex to zero
-  BFSArray->SetValue(this->OriginVertexIndex, 0);
-
-  // Create a queue to hand off to the BFS
-  boost::queue<int> Q;
-
-  my_distance_recorder<vtkIntArray*> bfsVisitor(BFSArray, &maxFromRootVertex);
-
-  // Is the graph directed or undirected
-  if (vtkDirectedGraph::SafeDownCast(output))
+  for (vtkIdType i = 0; i < BFSArray->GetNumberOfTuples(); ++i)
     {
-    vtkDirectedGraph *g = vtkDirectedGraph::SafeDownCast(output);
-    breadth_first_search(g, this->OriginVertexIndex, Q, bfsVisitor, color);
-    }
-  else
-    {
-    vtkUndirectedGraph *g = vtkUndirectedGraph::SafeDownCast(output);
-    breadth_first_search(g, this->OriginVertexIndex, Q, bfsVisitor, color);
+    if (distances[i] == maxDistance)
+      {
+      maxFromRootVertex = i;
+      break;
+      }
     }
 
   // Add attribute array to the output
@@ -21,12 +21,16 @@
 //
 // .SECTION Description
 //
-// This vtk class uses the Boost breadth_first_search
-// generic algorithm to perform a breadth first search from a given
-// a 'source' vertex on the input graph (a vtkGraph).
+// This vtk class performs a breadth first search from a given
+// a 'source' vertex on the input graph (a vtkGraph), following the out
+// edges of directed graphs. The search is done in parallel by
+// vtkGraphFrontier, with the same results as the Boost
+// breadth_first_search generic algorithm it used to call, except that the
+// MAX_DIST_FROM_ROOT selection is the vertex of smallest index among those
+// farthest from the origin.
 //
 // .SECTION See Also
-// vtkGraph vtkBoostGraphAdapter
+// vtkGraph vtkBoostGraphAdapter vtkGraphFrontier
 
 #ifndef vtkBoostBreadthFirstSearch_h
 #define vtkBoostBreadthFirstSearch_h
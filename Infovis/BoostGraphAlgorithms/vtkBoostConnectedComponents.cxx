@@ -24,6 +24,7 @@
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkFloatArray.h"
+#include "vtkGraphFrontier.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
@@ -34,6 +35,8 @@
 #include "vtkBoostGraphAdapter.h"
 #include <boost/graph/strong_components.hpp>
 
+#include <vector>
+
 using namespace boost;
 
 vtkStandardNewMacro(vtkBoostConnectedComponents);
@@ -79,11 +82,20 @@ int vtkBoostConnectedComponents::RequestData(
     }
   else
     {
-    vtkUndirectedGraph *g = vtkUndirectedGraph::SafeDownCast(input);
+    // Undirected components are labeled in parallel, in the same order as
+    // the Boost connected_components generic algorithm.
+    std::vector<vtkIdType> labels(input->GetNumberOfVertices());
+    vtkGraphFrontier* frontier = vtkGraphFrontier::New();
+    frontier->SetGraph(input);
+    frontier->ConnectedComponents(labels.empty() ? NULL : &labels[0]);
+    frontier->Delete();
     vtkIntArray* comps = vtkIntArray::New();
     comps->SetName("component");
-    vector_property_map<default_color_type> color;
-    connected_components(g, comps, color_map(color));
+    comps->SetNumberOfTuples(input->GetNumberOfVertices());
+    for (vtkIdType i = 0; i < input->GetNumberOfVertices(); ++i)
+      {
+      comps->SetValue(i, static_cast<int>(labels[i]));
+      }
     output->GetVertexData()->AddArray(comps);
     comps->Delete();
     }
@@ -27,6 +27,9 @@
 // strongly connected components of the graph (i.e. the maximal sets of
 // vertices where there is a directed path between any pair of vertices
 // within each set).
+//
+// The components of undirected graphs are found in parallel by
+// vtkGraphFrontier.
 
 #ifndef vtkBoostConnectedComponents_h
 #define vtkBoostConnectedComponents_h
@@ -0,0 +1,286 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGraphFrontier.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDirectedGraph.h"
+#include "vtkEdgeListIterator.h"
+#include "vtkGraphFrontier.h"
+#include "vtkInEdgeIterator.h"
+#include "vtkMath.h"
+#include "vtkMutableDirectedGraph.h"
+#include "vtkMutableUndirectedGraph.h"
+#include "vtkOutEdgeIterator.h"
+#include "vtkSmartPointer.h"
+#include "vtkUndirectedGraph.h"
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#define VTK_CREATE(type,name) \
+  vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
+
+namespace
+{
+// The neighbors of v along the edges selected as by vtkGraphFrontier.
+void GetNeighbors(vtkGraph* g, vtkIdType v, int direction,
+                  std::vector<vtkIdType>& neighbors)
+{
+  neighbors.clear();
+  bool directed = vtkDirectedGraph::SafeDownCast(g) != NULL;
+  if (!directed || direction != vtkGraphFrontier::IN_EDGES)
+    {
+    VTK_CREATE(vtkOutEdgeIterator, it);
+    g->GetOutEdges(v, it);
+    while (it->HasNext())
+      {
+      neighbors.push_back(it->Next().Target);
+      }
+    }
+  if (directed && direction != vtkGraphFrontier::OUT_EDGES)
+    {
+    VTK_CREATE(vtkInEdgeIterator, it);
+    g->GetInEdges(v, it);
+    while (it->HasNext())
+      {
+      neighbors.push_back(it->Next().Source);
+      }
+    }
+}
+
+int ReferenceSearch(vtkGraph* g, vtkIdType source, int direction,
+                    std::vector<int>& distances)
+{
+  distances.assign(g->GetNumberOfVertices(), VTK_INT_MAX);
+  std::deque<vtkIdType> queue;
+  std::vector<vtkIdType> neighbors;
+  distances[source] = 0;
+  queue.push_back(source);
+  int maxDistance = 0;
+  while (!queue.empty())
+    {
+    vtkIdType v = queue.front();
+    queue.pop_front();
+    maxDistance = distances[v];
+    GetNeighbors(g, v, direction, neighbors);
+    for (size_t i = 0; i < neighbors.size(); ++i)
+      {
+      if (distances[neighbors[i]] == VTK_INT_MAX)
+        {
+        distances[neighbors[i]] = distances[v] + 1;
+        queue.push_back(neighbors[i]);
+        }
+      }
+    }
+  return maxDistance;
+}
+
+vtkIdType Find(std::vector<vtkIdType>& parents, vtkIdType v)
+{
+  while (parents[v] != v)
+    {
+    v = parents[v] = parents[parents[v]];
+    }
+  return v;
+}
+
+vtkIdType ReferenceComponents(vtkGraph* g, std::vector<vtkIdType>& components)
+{
+  vtkIdType n = g->GetNumberOfVertices();
+  std::vector<vtkIdType> parents(n);
+  for (vtkIdType v = 0; v < n; ++v)
+    {
+    parents[v] = v;
+    }
+  VTK_CREATE(vtkEdgeListIterator, it);
+  g->GetEdges(it);
+  while (it->HasNext())
+    {
+    vtkEdgeType e = it->Next();
+    vtkIdType a = Find(parents, e.Source);
+    vtkIdType b = Find(parents, e.Target);
+    parents[std::max(a, b)] = std::min(a, b);
+    }
+  components.resize(n);
+  vtkIdType numComponents = 0;
+  for (vtkIdType v = 0; v < n; ++v)
+    {
+    vtkIdType root = Find(parents, v);
+    components[v] = root == v ? numComponents++ : components[root];
+    }
+  return numComponents;
+}
+
+void ReferenceCores(vtkGraph* g, int direction, std::vector<int>& cores)
+{
+  vtkIdType n = g->GetNumberOfVertices();
+  std::vector<std::vector<vtkIdType> > neighbors(n);
+  std::vector<vtkIdType> degrees(n);
+  for (vtkIdType v = 0; v < n; ++v)
+    {
+    GetNeighbors(g, v, direction, neighbors[v]);
+    degrees[v] = static_cast<vtkIdType>(neighbors[v].size());
+    }
+  cores.assign(n, -1);
+  vtkIdType remaining = n;
+  for (int k = 0; remaining > 0; ++k)
+    {
+    bool removed = true;
+    while (removed)
+      {
+      removed = false;
+      for (vtkIdType v = 0; v < n; ++v)
+        {
+        if (cores[v] < 0 && degrees[v] <= k)
+          {
+          cores[v] = k;
+          --remaining;
+          removed = true;
+          for (size_t i = 0; i < neighbors[v].size(); ++i)
+            {
+            --degrees[neighbors[v][i]];
+            }
+          }
+        }
+      }
+    }
+}
+
+void AddRandomEdges(vtkMutableDirectedGraph* dg, vtkMutableUndirectedGraph* ug,
+                    vtkIdType numVertices, vtkIdType numEdges)
+{
+  for (vtkIdType v = 0; v < numVertices; ++v)
+    {
+    dg->AddVertex();
+    ug->AddVertex();
+    }
+  for (vtkIdType e = 0; e < numEdges; ++e)
+    {
+    vtkIdType s = static_cast<vtkIdType>(vtkMath::Random(0, numVertices));
+    vtkIdType t = static_cast<vtkIdType>(vtkMath::Random(0, numVertices));
+    if (s != t)
+      {
+      dg->AddEdge(s, t);
+      ug->AddEdge(s, t);
+      }
+    }
+}
+
+int TestGraph(vtkGraph* g, const char* name)
+{
+  int errors = 0;
+  vtkIdType n = g->GetNumberOfVertices();
+  bool directed = vtkDirectedGraph::SafeDownCast(g) != NULL;
+  VTK_CREATE(vtkGraphFrontier, frontier);
+  frontier->SetGraph(g);
+
+  std::vector<int> distances(n);
+  std::vector<int> expectedDistances;
+  const double alphas[2] = { 14.0, 1.0e6 };
+  for (int direction = vtkGraphFrontier::OUT_EDGES;
+       direction <= vtkGraphFrontier::ALL_EDGES; ++direction)
+    {
+    if (!directed && direction != vtkGraphFrontier::OUT_EDGES)
+      {
+      continue;
+      }
+    frontier->SetEdgeDirection(direction);
+    // the second alpha switches to bottom-up steps as soon as possible
+    for (int a = 0; a < 2; ++a)
+      {
+      frontier->SetAlpha(alphas[a]);
+      for (vtkIdType source = 0; source < n; source += n / 5)
+        {
+        int maxDistance =
+          frontier->BreadthFirstSearch(&source, 1, &distances[0]);
+        int expected = ReferenceSearch(g, source, direction, expectedDistances);
+        if (maxDistance != expected || distances != expectedDistances)
+          {
+          cerr << name << ": wrong distances from " << source
+               << " with edge direction " << direction << " and alpha "
+               << alphas[a] << endl;
+          ++errors;
+          }
+        }
+      }
+    }
+  frontier->SetAlpha(14.0);
+
+  std::vector<vtkIdType> components(n);
+  std::vector<vtkIdType> expectedComponents;
+  vtkIdType numComponents = frontier->ConnectedComponents(&components[0]);
+  if (numComponents != ReferenceComponents(g, expectedComponents) ||
+    components != expectedComponents)
+    {
+    cerr << name << ": wrong components" << endl;
+    ++errors;
+    }
+
+  std::vector<int> cores(n);
+  std::vector<int> expectedCores;
+  for (int direction = vtkGraphFrontier::OUT_EDGES;
+       direction <= vtkGraphFrontier::ALL_EDGES; ++direction)
+    {
+    frontier->SetEdgeDirection(direction);
+    frontier->CoreNumbers(&cores[0]);
+    ReferenceCores(g, direction, expectedCores);
+    if (cores != expectedCores)
+      {
+      cerr << name << ": wrong core numbers with edge direction "
+           << direction << endl;
+      ++errors;
+      }
+    }
+  return errors;
+}
+}
+
+int TestGraphFrontier(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int errors = 0;
+  vtkMath::RandomSeed(1234);
+
+  // A sparse graph with many components and a denser one with a giant
+  // component, where the search switches to bottom-up steps.
+  const vtkIdType numEdges[2] = { 900, 8000 };
+  for (int i = 0; i < 2; ++i)
+    {
+    VTK_CREATE(vtkMutableDirectedGraph, dg);
+    VTK_CREATE(vtkMutableUndirectedGraph, ug);
+    AddRandomEdges(dg, ug, 1000, numEdges[i]);
+    errors += TestGraph(dg, "directed");
+    errors += TestGraph(ug, "undirected");
+
+    VTK_CREATE(vtkDirectedGraph, cdg);
+    VTK_CREATE(vtkUndirectedGraph, cug);
+    if (!cdg->CheckedCompressedCopy(dg) || !cug->CheckedCompressedCopy(ug))
+      {
+      cerr << "Could not compress the graphs" << endl;
+      return 1;
+      }
+    errors += TestGraph(cdg, "compressed directed");
+    errors += TestGraph(cug, "compressed undirected");
+    }
+
+  VTK_CREATE(vtkGraphFrontier, frontier);
+  VTK_CREATE(vtkMutableUndirectedGraph, empty);
+  frontier->SetGraph(empty);
+  if (frontier->BreadthFirstSearch(NULL, 0, NULL) != -1 ||
+    frontier->ConnectedComponents(NULL) != 0)
+    {
+    cerr << "Wrong results on an empty graph" << endl;
+    ++errors;
+    }
+
+  return errors;
+}
@@ -0,0 +1,841 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGraphFrontier.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkGraphFrontier.h"
+
+#include "vtkAtomic.h"
+#include "vtkDirectedGraph.h"
+#include "vtkGraph.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+vtkStandardNewMacro(vtkGraphFrontier);
+vtkCxxSetObjectMacro(vtkGraphFrontier, Graph, vtkGraph);
+
+namespace
+{
+typedef std::vector<vtkIdType> vtkFrontier;
+typedef vtkSMPThreadLocal<vtkFrontier> vtkLocalFrontier;
+typedef vtkSMPThreadLocal<vtkIdType> vtkLocalIdType;
+
+//----------------------------------------------------------------------------
+// The neighbors of a vertex are listed by up to two edge lists: its out
+// edges and, in directed graphs, its in edges, which have the same layout.
+struct vtkFrontierNeighbors
+{
+  const vtkOutEdgeType* const* Edges[2];
+  const vtkIdType* Degrees[2];
+  bool Use[2];
+
+  vtkIdType Degree(vtkIdType v) const
+  {
+    return (this->Use[0] ? this->Degrees[0][v] : 0) +
+      (this->Use[1] ? this->Degrees[1][v] : 0);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Concatenate the lists of the threads into the frontier and empty them.
+void GatherFrontier(vtkLocalFrontier& lists, vtkFrontier& frontier)
+{
+  frontier.clear();
+  for (vtkLocalFrontier::iterator it = lists.begin(); it != lists.end(); ++it)
+    {
+    frontier.insert(frontier.end(), (*it).begin(), (*it).end());
+    (*it).clear();
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType GatherSum(vtkLocalIdType& values)
+{
+  vtkIdType sum = 0;
+  for (vtkLocalIdType::iterator it = values.begin(); it != values.end(); ++it)
+    {
+    sum += *it;
+    *it = 0;
+    }
+  return sum;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType GatherMin(vtkLocalIdType& values)
+{
+  vtkIdType minimum = VTK_ID_MAX;
+  for (vtkLocalIdType::iterator it = values.begin(); it != values.end(); ++it)
+    {
+    minimum = std::min(minimum, *it);
+    *it = VTK_ID_MAX;
+    }
+  return minimum;
+}
+
+//----------------------------------------------------------------------------
+class vtkInitializeSearch
+{
+public:
+  int* Distances;
+  vtkAtomic<vtkTypeInt32>* Visited;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType v = begin; v < end; ++v)
+      {
+      this->Distances[v] = VTK_INT_MAX;
+      this->Visited[v] = 0;
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+class vtkMarkFrontier
+{
+public:
+  const vtkIdType* Frontier;
+  unsigned char* InFrontier;
+  unsigned char Value;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->InFrontier[this->Frontier[i]] = this->Value;
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// The frontier visits its neighbors. The first thread to increment the
+// counter of an unvisited vertex adds it to the next frontier.
+class vtkTopDownStep
+{
+public:
+  vtkFrontierNeighbors Forward;
+  const vtkIdType* Frontier;
+  vtkAtomic<vtkTypeInt32>* Visited;
+  int* Distances;
+  int Level;
+  vtkLocalFrontier Next;
+  vtkLocalIdType NextEdges;
+
+  vtkTopDownStep() : NextEdges(0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkFrontier& next = this->Next.Local();
+    vtkIdType& nextEdges = this->NextEdges.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType v = this->Frontier[i];
+      for (int d = 0; d < 2; ++d)
+        {
+        if (!this->Forward.Use[d])
+          {
+          continue;
+          }
+        const vtkOutEdgeType* edges = this->Forward.Edges[d][v];
+        const vtkIdType numEdges = this->Forward.Degrees[d][v];
+        for (vtkIdType e = 0; e < numEdges; ++e)
+          {
+          vtkIdType u = edges[e].Target;
+          if (this->Visited[u] == 0 && ++this->Visited[u] == 1)
+            {
+            this->Distances[u] = this->Level + 1;
+            next.push_back(u);
+            nextEdges += this->Forward.Degree(u);
+            }
+          }
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// The unvisited vertices look for a neighbor in the frontier. Each thread
+// only writes the vertices of its range.
+class vtkBottomUpStep
+{
+public:
+  vtkFrontierNeighbors Forward;
+  vtkFrontierNeighbors Reverse;
+  const unsigned char* InFrontier;
+  vtkAtomic<vtkTypeInt32>* Visited;
+  int* Distances;
+  int Level;
+  vtkLocalFrontier Next;
+  vtkLocalIdType NextEdges;
+
+  vtkBottomUpStep() : NextEdges(0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkFrontier& next = this->Next.Local();
+    vtkIdType& nextEdges = this->NextEdges.Local();
+    for (vtkIdType v = begin; v < end; ++v)
+      {
+      if (this->Visited[v] != 0)
+        {
+        continue;
+        }
+      bool found = false;
+      for (int d = 0; d < 2 && !found; ++d)
+        {
+        if (!this->Reverse.Use[d])
+          {
+          continue;
+          }
+        const vtkOutEdgeType* edges = this->Reverse.Edges[d][v];
+        const vtkIdType numEdges = this->Reverse.Degrees[d][v];
+        for (vtkIdType e = 0; e < numEdges && !found; ++e)
+          {
+          found = this->InFrontier[edges[e].Target] != 0;
+          }
+        }
+      if (found)
+        {
+        this->Distances[v] = this->Level + 1;
+        this->Visited[v] = 1;
+        next.push_back(v);
+        nextEdges += this->Forward.Degree(v);
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+class vtkHighestDegree
+{
+public:
+  vtkFrontierNeighbors Neighbors;
+  vtkSMPThreadLocal<std::pair<vtkIdType, vtkIdType> > Best;
+
+  vtkHighestDegree() : Best(std::make_pair(static_cast<vtkIdType>(-1),
+                                           static_cast<vtkIdType>(0))) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::pair<vtkIdType, vtkIdType>& best = this->Best.Local();
+    for (vtkIdType v = begin; v < end; ++v)
+      {
+      vtkIdType degree = this->Neighbors.Degree(v);
+      if (degree > best.first || (degree == best.first && v < best.second))
+        {
+        best.first = degree;
+        best.second = v;
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// The vertices reached by the search start with the smallest of them as
+// label, the others with their own id and are listed for propagation.
+class vtkInitializeLabels
+{
+public:
+  const int* Distances;
+  vtkIdType SearchLabel;
+  vtkIdType* Labels;
+  vtkLocalFrontier Remaining;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkFrontier& remaining = this->Remaining.Local();
+    for (vtkIdType v = begin; v < end; ++v)
+      {
+      if (this->Distances[v] != VTK_INT_MAX)
+        {
+        this->Labels[v] = this->SearchLabel;
+        }
+      else
+        {
+        this->Labels[v] = v;
+        remaining.push_back(v);
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+class vtkSmallestReached
+{
+public:
+  const int* Distances;
+  vtkLocalIdType Smallest;
+
+  vtkSmallestReached() : Smallest(VTK_ID_MAX) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType& smallest = this->Smallest.Local();
+    for (vtkIdType v = begin; v < end && v < smallest; ++v)
+      {
+      if (this->Distances[v] != VTK_INT_MAX)
+        {
+        smallest = v;
+        break;
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Every remaining vertex takes the smallest label among its own and those of
+// its neighbors, read from the labels of the previous round.
+class vtkPropagateLabels
+{
+public:
+  vtkFrontierNeighbors Neighbors;
+  const vtkIdType* Remaining;
+  const vtkIdType* Previous;
+  vtkIdType* Labels;
+  vtkLocalIdType Changed;
+
+  vtkPropagateLabels() : Changed(0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType& changed = this->Changed.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType v = this->Remaining[i];
+      vtkIdType label = this->Previous[v];
+      for (int d = 0; d < 2; ++d)
+        {
+        if (!this->Neighbors.Use[d])
+          {
+          continue;
+          }
+        const vtkOutEdgeType* edges = this->Neighbors.Edges[d][v];
+        const vtkIdType numEdges = this->Neighbors.Degrees[d][v];
+        for (vtkIdType e = 0; e < numEdges; ++e)
+          {
+          label = std::min(label, this->Previous[edges[e].Target]);
+          }
+        }
+      if (label != this->Previous[v])
+        {
+        ++changed;
+        }
+      this->Labels[v] = label;
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+class vtkCopyLabels
+{
+public:
+  const vtkIdType* Remaining;
+  const vtkIdType* Source;
+  vtkIdType* Target;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Target[this->Remaining[i]] = this->Source[this->Remaining[i]];
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+class vtkInitializeDegrees
+{
+public:
+  vtkFrontierNeighbors Neighbors;
+  vtkAtomic<vtkIdType>* Degrees;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType v = begin; v < end; ++v)
+      {
+      this->Degrees[v] = this->Neighbors.Degree(v);
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// List the vertices left with at most K neighbors, and find the smallest
+// degree left in case there are none.
+class vtkCoreScan
+{
+public:
+  const vtkAtomic<vtkIdType>* Degrees;
+  const unsigned char* Removed;
+  vtkIdType K;
+  vtkLocalFrontier Next;
+  vtkLocalIdType MinimumDegree;
+
+  vtkCoreScan() : MinimumDegree(VTK_ID_MAX) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkFrontier& next = this->Next.Local();
+    vtkIdType& minimumDegree = this->MinimumDegree.Local();
+    for (vtkIdType v = begin; v < end; ++v)
+      {
+      if (this->Removed[v])
+        {
+        continue;
+        }
+      vtkIdType degree = this->Degrees[v];
+      if (degree <= this->K)
+        {
+        next.push_back(v);
+        }
+      minimumDegree = std::min(minimumDegree, degree);
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+class vtkCoreAssign
+{
+public:
+  const vtkIdType* Frontier;
+  unsigned char* Removed;
+  int* Cores;
+  int K;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Removed[this->Frontier[i]] = 1;
+      this->Cores[this->Frontier[i]] = this->K;
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Removing the frontier lowers the degree of its neighbors that are still
+// above K. The thread that brings a neighbor down to K adds it to the next
+// frontier; a concurrent decrement may bring it lower, which does not change
+// its core number.
+class vtkCorePeel
+{
+public:
+  vtkFrontierNeighbors Neighbors;
+  const vtkIdType* Frontier;
+  vtkAtomic<vtkIdType>* Degrees;
+  vtkIdType K;
+  vtkLocalFrontier Next;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkFrontier& next = this->Next.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType v = this->Frontier[i];
+      for (int d = 0; d < 2; ++d)
+        {
+        if (!this->Neighbors.Use[d])
+          {
+          continue;
+          }
+        const vtkOutEdgeType* edges = this->Neighbors.Edges[d][v];
+        const vtkIdType numEdges = this->Neighbors.Degrees[d][v];
+        for (vtkIdType e = 0; e < numEdges; ++e)
+          {
+          vtkIdType u = edges[e].Target;
+          if (this->Degrees[u] > this->K && --this->Degrees[u] == this->K)
+            {
+            next.push_back(u);
+            }
+          }
+        }
+      }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+class vtkGraphFrontier::vtkInternals
+{
+public:
+  bool Directed;
+  vtkIdType NumberOfVertices;
+  // Out edges, then in edges of directed graphs, of every vertex.
+  std::vector<const vtkOutEdgeType*> Edges[2];
+  std::vector<vtkIdType> Degrees[2];
+  vtkIdType TotalDegrees[2];
+
+  std::vector<vtkAtomic<vtkTypeInt32> > Visited;
+  std::vector<unsigned char> InFrontier;
+
+  vtkInternals() : Directed(false), NumberOfVertices(0)
+  {
+    this->TotalDegrees[0] = this->TotalDegrees[1] = 0;
+  }
+
+  vtkFrontierNeighbors GetNeighbors(bool out, bool in)
+  {
+    vtkFrontierNeighbors neighbors;
+    for (int d = 0; d < 2; ++d)
+      {
+      neighbors.Edges[d] = this->Edges[d].empty() ? NULL : &this->Edges[d][0];
+      neighbors.Degrees[d] =
+        this->Degrees[d].empty() ? NULL : &this->Degrees[d][0];
+      }
+    // the in edges of undirected graphs are their out edges
+    neighbors.Use[0] = out || !this->Directed;
+    neighbors.Use[1] = in && this->Directed;
+    return neighbors;
+  }
+
+  int Search(const vtkFrontierNeighbors& forward,
+    const vtkFrontierNeighbors& reverse, const vtkIdType* sources,
+    vtkIdType numSources, int* distances, double alpha, double beta);
+};
+
+//----------------------------------------------------------------------------
+int vtkGraphFrontier::vtkInternals::Search(
+  const vtkFrontierNeighbors& forward, const vtkFrontierNeighbors& reverse,
+  const vtkIdType* sources, vtkIdType numSources, int* distances,
+  double alpha, double beta)
+{
+  const vtkIdType n = this->NumberOfVertices;
+  this->Visited.resize(n);
+  this->InFrontier.assign(n, 0);
+  vtkAtomic<vtkTypeInt32>* visited = n > 0 ? &this->Visited[0] : NULL;
+
+  vtkInitializeSearch initialize;
+  initialize.Distances = distances;
+  initialize.Visited = visited;
+  vtkSMPTools::For(0, n, initialize);
+
+  vtkFrontier frontier;
+  vtkIdType frontierEdges = 0;
+  for (vtkIdType i = 0; i < numSources; ++i)
+    {
+    vtkIdType s = sources[i];
+    if (s >= 0 && s < n && visited[s] == 0)
+      {
+      visited[s] = 1;
+      distances[s] = 0;
+      frontier.push_back(s);
+      frontierEdges += forward.Degree(s);
+      }
+    }
+  if (frontier.empty())
+    {
+    return -1;
+    }
+  vtkIdType unexploredEdges =
+    (forward.Use[0] ? this->TotalDegrees[0] : 0) +
+    (forward.Use[1] ? this->TotalDegrees[1] : 0) - frontierEdges;
+
+  vtkTopDownStep topDown;
+  topDown.Forward = forward;
+  topDown.Visited = visited;
+  topDown.Distances = distances;
+
+  vtkBottomUpStep bottomUp;
+  bottomUp.Forward = forward;
+  bottomUp.Reverse = reverse;
+  bottomUp.InFrontier = &this->InFrontier[0];
+  bottomUp.Visited = visited;
+  bottomUp.Distances = distances;
+
+  vtkMarkFrontier mark;
+  mark.InFrontier = &this->InFrontier[0];
+
+  vtkFrontier next;
+  vtkIdType previousSize = 0;
+  bool useBottomUp = false;
+  int level = 0;
+  for (;;)
+    {
+    const vtkIdType size = static_cast<vtkIdType>(frontier.size());
+    if (!useBottomUp)
+      {
+      useBottomUp = size > previousSize &&
+        frontierEdges > unexploredEdges / alpha;
+      }
+    else
+      {
+      useBottomUp = !(size < previousSize && size < n / beta);
+      }
+
+    vtkIdType nextEdges;
+    if (useBottomUp)
+      {
+      mark.Frontier = &frontier[0];
+      mark.Value = 1;
+      vtkSMPTools::For(0, size, mark);
+      bottomUp.Level = level;
+      vtkSMPTools::For(0, n, bottomUp);
+      mark.Value = 0;
+      vtkSMPTools::For(0, size, mark);
+      GatherFrontier(bottomUp.Next, next);
+      nextEdges = GatherSum(bottomUp.NextEdges);
+      }
+    else
+      {
+      topDown.Frontier = &frontier[0];
+      topDown.Level = level;
+      vtkSMPTools::For(0, size, topDown);
+      GatherFrontier(topDown.Next, next);
+      nextEdges = GatherSum(topDown.NextEdges);
+      }
+
+    if (next.empty())
+      {
+      return level;
+      }
+    ++level;
+    previousSize = size;
+    frontier.swap(next);
+    frontierEdges = nextEdges;
+    unexploredEdges -= nextEdges;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkGraphFrontier::vtkGraphFrontier()
+{
+  this->Graph = NULL;
+  this->EdgeDirection = OUT_EDGES;
+  this->Alpha = 14.0;
+  this->Beta = 24.0;
+  this->Internals = new vtkInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkGraphFrontier::~vtkGraphFrontier()
+{
+  this->SetGraph(NULL);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+bool vtkGraphFrontier::UpdateAdjacency()
+{
+  if (!this->Graph)
+    {
+    vtkErrorMacro("No graph to traverse.");
+    return false;
+    }
+  if (this->Graph->GetDistributedGraphHelper())
+    {
+    vtkErrorMacro("Distributed graphs are not supported.");
+    return false;
+    }
+
+  vtkInternals* internals = this->Internals;
+  const vtkIdType n = this->Graph->GetNumberOfVertices();
+  internals->NumberOfVertices = n;
+  internals->Directed = vtkDirectedGraph::SafeDownCast(this->Graph) != NULL;
+  const int numLists = internals->Directed ? 2 : 1;
+  for (int d = 0; d < 2; ++d)
+    {
+    internals->Edges[d].resize(d < numLists ? n : 0);
+    internals->Degrees[d].resize(d < numLists ? n : 0);
+    internals->TotalDegrees[d] = 0;
+    }
+  for (vtkIdType v = 0; v < n; ++v)
+    {
+    this->Graph->GetOutEdges(
+      v, internals->Edges[0][v], internals->Degrees[0][v]);
+    internals->TotalDegrees[0] += internals->Degrees[0][v];
+    if (internals->Directed)
+      {
+      const vtkInEdgeType* inEdges;
+      this->Graph->GetInEdges(v, inEdges, internals->Degrees[1][v]);
+      internals->Edges[1][v] = reinterpret_cast<const vtkOutEdgeType*>(inEdges);
+      internals->TotalDegrees[1] += internals->Degrees[1][v];
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkGraphFrontier::BreadthFirstSearch(
+  const vtkIdType* sources, vtkIdType numSources, int* distances)
+{
+  if (!this->UpdateAdjacency())
+    {
+    return -1;
+    }
+  bool out = this->EdgeDirection != IN_EDGES;
+  bool in = this->EdgeDirection != OUT_EDGES;
+  return this->Internals->Search(this->Internals->GetNeighbors(out, in),
+    this->Internals->GetNeighbors(in, out), sources, numSources, distances,
+    this->Alpha, this->Beta);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkGraphFrontier::ConnectedComponents(vtkIdType* components)
+{
+  if (!this->UpdateAdjacency())
+    {
+    return 0;
+    }
+  vtkInternals* internals = this->Internals;
+  const vtkIdType n = internals->NumberOfVertices;
+  if (n == 0)
+    {
+    return 0;
+    }
+  vtkFrontierNeighbors all = internals->GetNeighbors(true, true);
+
+  // The component of the vertex of highest degree, the giant component of
+  // most large graphs, is found by a breadth first search.
+  vtkHighestDegree highest;
+  highest.Neighbors = all;
+  vtkSMPTools::For(0, n, highest);
+  vtkIdType root = 0;
+  vtkIdType rootDegree = -1;
+  for (vtkSMPThreadLocal<std::pair<vtkIdType, vtkIdType> >::iterator it =
+    highest.Best.begin(); it != highest.Best.end(); ++it)
+    {
+    if ((*it).first > rootDegree ||
+      ((*it).first == rootDegree && (*it).second < root))
+      {
+      rootDegree = (*it).first;
+      root = (*it).second;
+      }
+    }
+  std::vector<int> distances(n);
+  internals->Search(all, all, &root, 1, &distances[0], this->Alpha, this->Beta);
+
+  vtkSmallestReached smallest;
+  smallest.Distances = &distances[0];
+  vtkSMPTools::For(0, n, smallest);
+
+  vtkInitializeLabels initialize;
+  initialize.Distances = &distances[0];
+  initialize.SearchLabel = GatherMin(smallest.Smallest);
+  initialize.Labels = components;
+  vtkSMPTools::For(0, n, initialize);
+  vtkFrontier remaining;
+  GatherFrontier(initialize.Remaining, remaining);
+
+  // The other components take the smallest id of their vertices, which
+  // spreads one edge per round.
+  if (!remaining.empty())
+    {
+    std::vector<vtkIdType> previous(components, components + n);
+    vtkPropagateLabels propagate;
+    propagate.Neighbors = all;
+    propagate.Remaining = &remaining[0];
+    vtkCopyLabels copy;
+    copy.Remaining = &remaining[0];
+    copy.Source = components;
+    copy.Target = &previous[0];
+    const vtkIdType size = static_cast<vtkIdType>(remaining.size());
+    vtkIdType changed;
+    do
+      {
+      propagate.Previous = &previous[0];
+      propagate.Labels = components;
+      vtkSMPTools::For(0, size, propagate);
+      changed = GatherSum(propagate.Changed);
+      vtkSMPTools::For(0, size, copy);
+      }
+    while (changed > 0);
+    }
+
+  // Number the components by their smallest vertex, which is their label
+  // and precedes the other vertices of the component.
+  vtkIdType numComponents = 0;
+  for (vtkIdType v = 0; v < n; ++v)
+    {
+    components[v] = components[v] == v ?
+      numComponents++ : components[components[v]];
+    }
+  return numComponents;
+}
+
+//----------------------------------------------------------------------------
+void vtkGraphFrontier::CoreNumbers(int* cores)
+{
+  if (!this->UpdateAdjacency())
+    {
+    return;
+    }
+  vtkInternals* internals = this->Internals;
+  const vtkIdType n = internals->NumberOfVertices;
+  if (n == 0)
+    {
+    return;
+    }
+  vtkFrontierNeighbors neighbors = internals->GetNeighbors(
+    this->EdgeDirection != IN_EDGES, this->EdgeDirection != OUT_EDGES);
+
+  std::vector<vtkAtomic<vtkIdType> > degrees(n);
+  std::vector<unsigned char> removed(n, 0);
+  vtkInitializeDegrees initialize;
+  initialize.Neighbors = neighbors;
+  initialize.Degrees = &degrees[0];
+  vtkSMPTools::For(0, n, initialize);
+
+  vtkCoreScan scan;
+  scan.Degrees = &degrees[0];
+  scan.Removed = &removed[0];
+  vtkCoreAssign assign;
+  assign.Removed = &removed[0];
+  assign.Cores = cores;
+  vtkCorePeel peel;
+  peel.Neighbors = neighbors;
+  peel.Degrees = &degrees[0];
+
+  vtkFrontier frontier;
+  vtkFrontier next;
+  vtkIdType remaining = n;
+  vtkIdType k = 0;
+  while (remaining > 0)
+    {
+    scan.K = k;
+    vtkSMPTools::For(0, n, scan);
+    GatherFrontier(scan.Next, frontier);
+    vtkIdType minimumDegree = GatherMin(scan.MinimumDegree);
+    if (frontier.empty())
+      {
+      // no vertex has a core number between k and the smallest degree left
+      k = minimumDegree;
+      continue;
+      }
+
+    assign.K = static_cast<int>(k);
+    peel.K = k;
+    while (!frontier.empty())
+      {
+      const vtkIdType size = static_cast<vtkIdType>(frontier.size());
+      assign.Frontier = &frontier[0];
+      vtkSMPTools::For(0, size, assign);
+      remaining -= size;
+      peel.Frontier = &frontier[0];
+      vtkSMPTools::For(0, size, peel);
+      GatherFrontier(peel.Next, next);
+      frontier.swap(next);
+      }
+    ++k;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkGraphFrontier::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Graph: " << this->Graph << endl;
+  os << indent << "EdgeDirection: " << this->EdgeDirection << endl;
+  os << indent << "Alpha: " << this->Alpha << endl;
+  os << indent << "Beta: " << this->Beta << endl;
+}
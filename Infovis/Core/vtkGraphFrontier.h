@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGraphFrontier.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkGraphFrontier - multithreaded frontier-based graph traversals
+//
+// .SECTION Description
+// vtkGraphFrontier runs level-synchronous traversals of a vtkGraph with
+// vtkSMPTools. Each level expands a frontier of vertices in parallel and
+// gathers the next frontier from per-thread lists.
+//
+// BreadthFirstSearch() is direction-optimizing (Beamer, Asanovic and
+// Patterson, "Direction-Optimizing Breadth-First Search", SC 2012): while
+// the frontier is small, its vertices visit their neighbors (top-down);
+// once the edges of the frontier outnumber those of the unvisited vertices
+// by Alpha, the unvisited vertices instead look for a parent in the
+// frontier (bottom-up), until the frontier falls under 1/Beta of the
+// vertices.
+//
+// ConnectedComponents() and CoreNumbers() are built on the same frontiers:
+// the former labels the component of the vertex of highest degree with a
+// breadth first search, then propagates the smallest vertex id through the
+// other components; the latter peels the vertices of degree at most k,
+// frontier by frontier, for increasing k.
+//
+// The adjacency of the graph is read directly, as by the graph iterators,
+// and is most compact for graphs made with vtkGraph::CheckedCompressedCopy().
+// Distributed graphs are not supported.
+//
+// .SECTION See Also
+// vtkBoostBreadthFirstSearch vtkBoostConnectedComponents
+// vtkKCoreDecomposition vtkSMPTools
+
+#ifndef vtkGraphFrontier_h
+#define vtkGraphFrontier_h
+
+#include "vtkInfovisCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkGraph;
+
+class VTKINFOVISCORE_EXPORT vtkGraphFrontier : public vtkObject
+{
+public:
+  static vtkGraphFrontier *New();
+  vtkTypeMacro(vtkGraphFrontier, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set the graph to traverse. The graph must not be modified while it is
+  // traversed.
+  void SetGraph(vtkGraph* graph);
+  vtkGetObjectMacro(Graph, vtkGraph);
+
+  // Description:
+  // The edges that lead from a vertex of a directed graph to its neighbors:
+  // its out edges (the default), its in edges, or both. All the edges of a
+  // vertex are used in undirected graphs, and ConnectedComponents() always
+  // uses both directions.
+  enum
+    {
+    OUT_EDGES = 0,
+    IN_EDGES,
+    ALL_EDGES
+    };
+  vtkSetClampMacro(EdgeDirection, int, OUT_EDGES, ALL_EDGES);
+  vtkGetMacro(EdgeDirection, int);
+
+  // Description:
+  // The thresholds at which BreadthFirstSearch() switches to bottom-up
+  // steps, when the edges of the frontier exceed those of the unvisited
+  // vertices divided by Alpha, and back to top-down steps, when the
+  // frontier has fewer than the number of vertices divided by Beta.
+  // The defaults, 14 and 24, are those of the paper.
+  vtkSetClampMacro(Alpha, double, 1e-6, VTK_DOUBLE_MAX);
+  vtkGetMacro(Alpha, double);
+  vtkSetClampMacro(Beta, double, 1e-6, VTK_DOUBLE_MAX);
+  vtkGetMacro(Beta, double);
+
+  //BTX
+  // Description:
+  // Compute the number of edges from the nearest of the sources to each
+  // vertex, VTK_INT_MAX for the vertices that cannot be reached. distances
+  // must have one value per vertex. Returns the largest distance reached,
+  // or -1 without sources.
+  int BreadthFirstSearch(const vtkIdType* sources, vtkIdType numSources,
+                         int* distances);
+
+  // Description:
+  // Label each vertex with the index of its connected component, weakly
+  // connected for directed graphs. Components are numbered in the order of
+  // their smallest vertex id. Returns the number of components.
+  vtkIdType ConnectedComponents(vtkIdType* components);
+
+  // Description:
+  // Compute the core number of each vertex: the largest k such that the
+  // vertex belongs to a subgraph where every vertex has at least k
+  // neighbors, neighbors being given by EdgeDirection.
+  void CoreNumbers(int* cores);
+  //ETX
+
+protected:
+  vtkGraphFrontier();
+  ~vtkGraphFrontier();
+
+  // Description:
+  // Fetch the edge lists of the vertices of the graph, so that the threads
+  // do not go through the graph. Returns false if it cannot be traversed.
+  bool UpdateAdjacency();
+
+  vtkGraph* Graph;
+  int EdgeDirection;
+  double Alpha;
+  double Beta;
+
+private:
+  //BTX
+  class vtkInternals;
+  vtkInternals* Internals;
+  //ETX
+
+  vtkGraphFrontier(const vtkGraphFrontier&); // Not implemented
+  void operator=(const vtkGraphFrontier&); // Not implemented
+};
+
+#endif
@@ -19,216 +19,19 @@
 -------------------------------------------------------------------------*/
 #include "vtkKCoreDecomposition.h"
 #include "vtkGraph.h"
+#include "vtkGraphFrontier.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
-#include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkEdgeListIterator.h"
-#include "vtkInEdgeIterator.h"
-#include "vtkOutEdgeIterator.h"
 #include "vtkUndirectedGraph.h"
-#include "vtkDirectedGraph.h"
 #include "vtkType.h"
 #include <vtksys/hash_map.hxx>
 
 vtkStandardNewMacro(vtkKCoreDecomposition);
 
-namespace
-{
-
-// The Neighbors class defines a graph edge iterator
-// that allows us to iterate over just the in edges,
-// just the out edges, or both the in and out edges.
-class Neighbors
-{
-public:
-  Neighbors(bool _UseInDegreeNeighbors,
-            bool _UseOutDegreeNeighbors)
-    {
-    this->iti = vtkInEdgeIterator::New();
-    this->ito = vtkOutEdgeIterator::New();
-    this->UseInDegreeNeighbors = _UseInDegreeNeighbors;
-    this->UseOutDegreeNeighbors = _UseOutDegreeNeighbors;
-    }
-
-  ~Neighbors()
-    {
-    this->iti->Delete();
-    this->ito->Delete();
-    }
-
-  void Initialize(vtkGraph* g,
-                  int v)
-    {
-    if(vtkUndirectedGraph::SafeDownCast(g))
-      {
-      this->Undirected = true;
-      }
-    else
-      {
-      this->Undirected = false;
-      }
-
-    this->iti->Initialize(g, vtkIdType(v - 1));
-
-    if(!this->Undirected)
-      {
-      this->ito->Initialize(g, vtkIdType(v - 1));
-      }
-    }
-
-  bool HasNext()
-    {
-    if(this->Undirected)
-      {
-      return(this->iti->HasNext());
-      }
-
-    if(this->UseInDegreeNeighbors &&
-      !this->UseOutDegreeNeighbors)
-      {
-      return(this->iti->HasNext());
-      }
-
-    if(!this->UseInDegreeNeighbors &&
-        this->UseOutDegreeNeighbors)
-      {
-      return(this->ito->HasNext());
-      }
-
-    return(this->iti->HasNext() || this->ito->HasNext());
-    }
-
-  int Next()
-    {
-    if(this->Undirected)
-      {
-      return(int(this->iti->Next().Source) + 1);
-      }
-
-    if(this->UseInDegreeNeighbors &&
-      !this->UseOutDegreeNeighbors)
-      {
-      return(int(this->iti->Next().Source) + 1);
-      }
-
-    if(!this->UseInDegreeNeighbors &&
-       this->UseOutDegreeNeighbors)
-      {
-      return(int(this->ito->Next().Target) + 1);
-      }
-
-    if(this->iti->HasNext())
-      {
-      return(int(this->iti->Next().Source) + 1);
-      }
-
-    return(int(this->ito->Next().Target) + 1);
-    }
-
-private:
-  vtkInEdgeIterator* iti;
-  vtkOutEdgeIterator* ito;
-  bool UseInDegreeNeighbors;
-  bool UseOutDegreeNeighbors;
-  bool Undirected;
-};
-
-// Array that is indexed starting from 1.
-class tableVert {
-public:
-  tableVert(int n)
-    {
-    this->_array = vtkIntArray::New();
-    this->_array->SetNumberOfTuples(n);
-    }
-
-  tableVert(vtkIntArray* a)
-    {
-    this->_array = a;
-    this->_array->Register(this->_array);
-    }
-
-  ~tableVert()
-    {
-    if(this->_array)
-      {
-      this->_array->Delete();
-      this->_array = 0;
-      }
-    }
-
-  int& operator[]( int idx )
-    {
-    if(idx < 1 || idx > this->_array->GetNumberOfTuples())
-      {
-      cerr << "Write Number of tuples = " << this->_array->GetNumberOfTuples() << endl;
-      cerr << "Array index out out bounds in tableVert operator [], index: " << idx << endl;
-      return(static_cast<int*>(this->_array->GetVoidPointer(0))[0]);
-      }
-
-    return(static_cast<int*>(this->_array->GetVoidPointer(0))[idx - 1]);
-    }
-
-private:
-  vtkIntArray* _array;
-};
-
-// Array that is indexed starting from 0.
-class tableDeg {
-public:
-  tableDeg()
-    {
-    this->_array = 0;
-    }
-
-  ~tableDeg()
-    {
-    if(this->_array)
-      {
-      this->_array->Delete();
-      this->_array = 0;
-      }
-    }
-
-  int getArraySize()
-    {
-    if(this->_array)
-      {
-      return(this->_array->GetNumberOfTuples());
-      }
-    return(0);
-    }
-
-  void setNewArray(int n)
-    {
-    if(this->_array)
-      {
-      this->_array->Delete();
-      }
-    this->_array = vtkIntArray::New();
-    this->_array->SetNumberOfTuples(n);
-    }
-
-  int& operator[]( int idx )
-    {
-    if(idx < 0 || idx >= this->_array->GetNumberOfTuples())
-      {
-      cerr << "Read Number of tuples = " << this->_array->GetNumberOfTuples() << endl;
-      cerr << "Array index out out bounds in tableDeg operator [], index: " << idx << endl;
-      return(static_cast<int*>(this->_array->GetVoidPointer(0))[0]);
-      }
-
-    return(static_cast<int*>(this->_array->GetVoidPointer(0))[idx]);
-    }
-
-private:
-  vtkIntArray* _array;
-};
-};
-
 vtkKCoreDecomposition::vtkKCoreDecomposition()
 {
   this->OutputArrayName = 0;
@@ -242,117 +45,28 @@ vtkKCoreDecomposition::~vtkKCoreDecomposition()
   this->SetOutputArrayName(0);
 }
 
-// This is the O(edges) k-cores algorithm implementation
-// that looks exactly like the code listing given in the
-// reference paper, "An O(m) Algorithm for Cores Decomposition
-// of Networks."
+// The vertices of degree at most k are peeled in parallel, frontier by
+// frontier, for increasing k, which finds the same cores as the O(edges)
+// algorithm of the reference paper.
 void vtkKCoreDecomposition::Cores(vtkGraph* g,
                                   vtkIntArray* KCoreNumbers)
 {
-  int n, md, start, num;
-  int w, pu, pw;
-  int v, d, i, u, du;
-
-  tableVert deg(KCoreNumbers);
-  tableVert pos(g->GetNumberOfVertices());
-  tableVert vert(g->GetNumberOfVertices());
-  tableDeg bin;
-
-  if(vtkDirectedGraph::SafeDownCast(g) &&
-     this->UseInDegreeNeighbors &&
-     this->UseOutDegreeNeighbors)
-    {
-    bin.setNewArray(2*g->GetNumberOfVertices() - 1);
-    }
-  else
-    {
-    bin.setNewArray(g->GetNumberOfVertices());
-    }
-
-  n = g->GetNumberOfVertices();
-  md = 0;
-  Neighbors neighborVertices(this->UseInDegreeNeighbors,
-                             this->UseOutDegreeNeighbors);
-
-  for(v = 1; v <= n; v++)
-    {
-    d = 0;
-    neighborVertices.Initialize(g, v);
-    while(neighborVertices.HasNext())
-      {
-      d++;
-      neighborVertices.Next();
-      }
-    deg[v] = d;
-    if(d > md)
-      {
-      md = d;
-      }
-    }
-
-  if(md > bin.getArraySize())
-    {
-    vtkErrorMacro("Maximum vertex degree exceeds bin array size: " << md << ". Unable to compute K core.");
-    return;
-    }
-
-  for(d = 0; d <= md; d++)
-    {
-    bin[d] = 0;
-    }
-
-  for(v = 1; v <= n; v++)
+  vtkGraphFrontier* frontier = vtkGraphFrontier::New();
+  frontier->SetGraph(g);
+  if(this->UseInDegreeNeighbors && !this->UseOutDegreeNeighbors)
     {
-    bin[deg[v]] += 1;
+    frontier->SetEdgeDirection(vtkGraphFrontier::IN_EDGES);
     }
-
-  start = 1;
-  for(d = 0; d <= md; d++)
-    {
-    num = bin[d];
-    bin[d] = start;
-    start = start + num;
-    }
-
-  for(v = 1; v <= n; v++)
+  else if(!this->UseInDegreeNeighbors && this->UseOutDegreeNeighbors)
     {
-    pos[v] = bin[deg[v]];
-    vert[pos[v]] = v;
-    bin[deg[v]] += 1;
+    frontier->SetEdgeDirection(vtkGraphFrontier::OUT_EDGES);
     }
-
-  for(d = md; d >= 1; d--)
-    {
-    bin[d] = bin[d - 1];
-    }
-
-  bin[0] = 1;
-
-  for(i = 1; i <= n; i++)
+  else
     {
-    v = vert[i];
-    neighborVertices.Initialize(g, v);
-    while(neighborVertices.HasNext())
-      {
-      u = neighborVertices.Next();
-      if(deg[u] > deg[v])
-        {
-        du = deg[u];
-        pu = pos[u];
-        pw = bin[du];
-        w = vert[pw];
-        if(u != w)
-          {
-          pos[u] = pw;
-          pos[w] = pu;
-          vert[pu] = w;
-          vert[pw] = u;
-          }
-        bin[du] += 1;
-        deg[u] -= 1;
-        }
-      }
+    frontier->SetEdgeDirection(vtkGraphFrontier::ALL_EDGES);
     }
+  frontier->CoreNumbers(KCoreNumbers->GetPointer(0));
+  frontier->Delete();
 }
 
 int vtkKCoreDecomposition::RequestData(vtkInformation *vtkNotUsed(request),
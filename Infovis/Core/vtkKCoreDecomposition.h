@@ -24,13 +24,17 @@
 // analyzing the structure of large networks. A k-core of a graph G is a maximal
 // connected subgraph of G in which all vertices have degree at least k.  The k-core
 // membership for each vertex of the input graph is found on the vertex data of the
-// output graph as an array named 'KCoreDecompositionNumbers' by default.  The algorithm
-// used to find the k-cores has O(number of graph edges) running time, and is described
-// in the following reference paper.
+// output graph as an array named 'KCoreDecompositionNumbers' by default.  The k-cores
+// are found by vtkGraphFrontier, which removes the vertices of degree at most k in
+// parallel for increasing k.  The results are those of the sequential algorithm
+// described in the following reference paper.
 //
 // An O(m) Algorithm for Cores Decomposition of Networks
 //   V. Batagelj, M. Zaversnik, 2001
 //
+// .SECTION See Also
+// vtkGraphFrontier
+//
 // .SECTION Thanks
 // Thanks to Thomas Otahal from Sandia National Laboratories for providing this
 // implementation.
@@ -27,6 +27,7 @@
 #include "vtkFieldData.h"
 #include "vtkGraph.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
@@ -35,7 +36,9 @@
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 
+#include <map>
 #include <set>
+#include <vector>
 
 vtkStandardNewMacro(vtkStringToCategory);
 
@@ -120,6 +123,36 @@ int vtkStringToCategory::RequestData(
   catArr->SetNumberOfTuples(numTuples);
   fd->AddArray(catArr);
   catArr->Delete();
+  if (stringArr->GetStorageMode() == vtkStringArray::PACKED_STORAGE)
+    {
+    // Categorize the packed entries rather than the values, so that
+    // dictionary encoded arrays are read without unpacking them.
+    vtkIdTypeArray* codes = stringArr->GetPackedCodes();
+    vtkIdType numEntries = stringArr->GetPackedOffsets()->GetMaxId();
+    std::vector<int> entryCategory(numEntries, -1);
+    std::map<vtkStdString, int> categories;
+    for (vtkIdType i = 0; i < numTuples*numComp; i++)
+      {
+      vtkIdType entry = codes ? codes->GetValue(i) : i;
+      if (entryCategory[entry] < 0)
+        {
+        vtkIdType length;
+        const char* value = stringArr->GetValueData(i, length);
+        vtkStdString str(value, static_cast<size_t>(length));
+        std::pair<std::map<vtkStdString, int>::iterator, bool> inserted =
+          categories.insert(std::make_pair(str,
+                                           static_cast<int>(categories.size())));
+        if (inserted.second)
+          {
+          strings->InsertNextValue(str);
+          }
+        entryCategory[entry] = inserted.first->second;
+        }
+      catArr->SetValue(i, entryCategory[entry]);
+      }
+    return 1;
+    }
+
   vtkIdList* list = vtkIdList::New();
   std::set<vtkStdString> s;
   int category = 0;
@@ -32,6 +32,10 @@
 // The list of unique strings, in the order they are mapped, can also be
 // retrieved from output port 1. They are in a vtkTable, stored in the "Strings"
 // column as a vtkStringArray.
+//
+// Packed string arrays (see vtkStringArray::Pack) are categorized without
+// being unpacked. For dictionary encoded arrays each distinct string is
+// compared only once.
 
 #ifndef vtkStringToCategory_h
 #define vtkStringToCategory_h
@@ -17,6 +17,7 @@
   Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
   the U.S. Government retains certain rights in this software.
 -------------------------------------------------------------------------*/
+#include "vtkBarnesHut2DLayoutStrategy.h"
 #include "vtkCircularLayoutStrategy.h"
 #include "vtkEdgeListIterator.h"
 #include "vtkFast2DLayoutStrategy.h"
@@ -203,5 +204,35 @@ int TestGraphLayoutStrategy(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
     }
   cerr << "...done." << endl;
 
+  cerr << "Testing vtkBarnesHut2DLayoutStrategy..." << endl;
+  VTK_CREATE(vtkBarnesHut2DLayoutStrategy, barnesHut);
+  barnesHut->SetRestDistance(1.0f);
+  length = barnesHut->GetRestDistance();
+  layout->SetLayoutStrategy(barnesHut);
+  layout->Update();
+  output = layout->GetOutput();
+  output->GetEdges(edges);
+  while (edges->HasNext())
+    {
+    vtkEdgeType e = edges->Next();
+    vtkIdType u = e.Source;
+    vtkIdType v = e.Target;
+    output->GetPoint(u, pt);
+    output->GetPoint(v, pt2);
+    double dist = sqrt(vtkMath::Distance2BetweenPoints(pt, pt2));
+    if (dist < length/tol || dist > length*tol)
+      {
+      cerr << "ERROR: Edge " << u << "," << v << " distance is " << dist
+           << " but resting distance is " << length << endl;
+      errors++;
+      }
+    if (pt[2] != 0.0 || pt2[2] != 0.0)
+      {
+      cerr << "ERROR: Edge " << u << "," << v << " not on the xy plane" << endl;
+      errors++;
+      }
+    }
+  cerr << "...done." << endl;
+
   return errors;
 }
@@ -0,0 +1,503 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBarnesHut2DLayoutStrategy.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBarnesHut2DLayoutStrategy.h"
+
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkEdgeListIterator.h"
+#include "vtkFloatArray.h"
+#include "vtkGraph.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+vtkStandardNewMacro(vtkBarnesHut2DLayoutStrategy);
+
+namespace
+{
+// Cells with fewer vertices are not split, their vertices repel one by one.
+const vtkIdType LeafSize = 8;
+// Coincident vertices would split cells forever.
+const int MaxDepth = 32;
+const float Epsilon = 1e-5f;
+
+// Cool-down function.
+inline float CoolDown(float t, float r)
+{
+  return t-(t/r);
+}
+
+// A square cell of the quadtree. The vertices of the cell are
+// Order[Begin, End), its non-empty children are stored contiguously.
+struct vtkBarnesHutCell
+{
+  float Origin[2];
+  float Size;
+  float Center[2]; // center of mass
+  float Mass;
+  int FirstChild;
+  int NumberOfChildren;
+  vtkIdType Begin;
+  vtkIdType End;
+};
+
+//----------------------------------------------------------------------------
+// Sum the repulsion from the tree and the attraction along the edges of each
+// vertex. Every edge is listed by both of its vertices, so a thread only
+// writes the forces of its own vertices.
+class vtkBarnesHutForces
+{
+public:
+  const std::vector<vtkBarnesHutCell>* Cells;
+  const vtkIdType* Order;
+  const float* Points;
+  const vtkIdType* Offsets;
+  const vtkIdType* Neighbors;
+  const float* Weights;
+  float* Forces;
+  float Theta2;
+  float RestDistance;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const vtkBarnesHutCell* cells = &(*this->Cells)[0];
+    int stack[3 * MaxDepth + 4];
+    for (vtkIdType v = begin; v < end; ++v)
+      {
+      const float x = this->Points[3 * v];
+      const float y = this->Points[3 * v + 1];
+      float fx = 0.0f;
+      float fy = 0.0f;
+
+      int top = 0;
+      stack[top++] = 0;
+      while (top > 0)
+        {
+        const vtkBarnesHutCell& cell = cells[stack[--top]];
+        float dx = x - cell.Center[0];
+        float dy = y - cell.Center[1];
+        float disSquared = dx * dx + dy * dy;
+        bool inside = x >= cell.Origin[0] && x <= cell.Origin[0] + cell.Size &&
+          y >= cell.Origin[1] && y <= cell.Origin[1] + cell.Size;
+        if (!inside && cell.Size * cell.Size < this->Theta2 * disSquared)
+          {
+          disSquared += Epsilon;
+          fx += cell.Mass * dx / disSquared;
+          fy += cell.Mass * dy / disSquared;
+          }
+        else if (cell.FirstChild < 0)
+          {
+          for (vtkIdType i = cell.Begin; i < cell.End; ++i)
+            {
+            vtkIdType u = this->Order[i];
+            // Don't repulse against yourself :)
+            if (u == v)
+              {
+              continue;
+              }
+            dx = x - this->Points[3 * u];
+            dy = y - this->Points[3 * u + 1];
+            disSquared = dx * dx + dy * dy + Epsilon;
+            fx += dx / disSquared;
+            fy += dy / disSquared;
+            }
+          }
+        else
+          {
+          for (int c = 0; c < cell.NumberOfChildren; ++c)
+            {
+            stack[top++] = cell.FirstChild + c;
+            }
+          }
+        }
+
+      for (vtkIdType e = this->Offsets[v]; e < this->Offsets[v + 1]; ++e)
+        {
+        vtkIdType u = this->Neighbors[e];
+        float dx = x - this->Points[3 * u];
+        float dy = y - this->Points[3 * u + 1];
+        float disSquared = dx * dx + dy * dy;
+        float attractValue = this->Weights[e] * disSquared - this->RestDistance;
+        fx -= dx * attractValue;
+        fy -= dy * attractValue;
+        }
+
+      this->Forces[2 * v] = fx;
+      this->Forces[2 * v + 1] = fy;
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+class vtkBarnesHutMove
+{
+public:
+  const float* Forces;
+  float* Points;
+  float Temp;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType v = begin; v < end; ++v)
+      {
+      float forceX = this->Forces[2 * v];
+      float forceY = this->Forces[2 * v + 1];
+
+      // Forces can get extreme so limit them, with the same
+      // pseudo-normalization as vtkSimple2DLayoutStrategy.
+      float forceDiv = fabs(forceX) + fabs(forceY) + Epsilon;
+      float pNormalize = vtkMath::Min(1.0f, 1.0f/forceDiv) * this->Temp;
+      this->Points[3 * v] += forceX * pNormalize;
+      this->Points[3 * v + 1] += forceY * pNormalize;
+      }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+class vtkBarnesHut2DLayoutStrategy::vtkInternals
+{
+public:
+  // The edges of each vertex, in both directions, without self loops.
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Neighbors;
+  std::vector<float> Weights;
+
+  std::vector<vtkBarnesHutCell> Cells;
+  std::vector<vtkIdType> Order;
+  std::vector<vtkIdType> Scratch;
+  std::vector<float> Forces;
+
+  void BuildTree(const float* points, vtkIdType numVertices);
+  void BuildCell(int index, const float* points, vtkIdType begin,
+    vtkIdType end, float x0, float y0, float size, int depth);
+};
+
+//----------------------------------------------------------------------------
+void vtkBarnesHut2DLayoutStrategy::vtkInternals::BuildTree(
+  const float* points, vtkIdType numVertices)
+{
+  float bounds[4] = { points[0], points[0], points[1], points[1] };
+  this->Order.resize(numVertices);
+  this->Scratch.resize(numVertices);
+  for (vtkIdType v = 0; v < numVertices; ++v)
+    {
+    this->Order[v] = v;
+    bounds[0] = std::min(bounds[0], points[3 * v]);
+    bounds[1] = std::max(bounds[1], points[3 * v]);
+    bounds[2] = std::min(bounds[2], points[3 * v + 1]);
+    bounds[3] = std::max(bounds[3], points[3 * v + 1]);
+    }
+  float size = std::max(bounds[1] - bounds[0], bounds[3] - bounds[2]);
+  size = size * 1.001f + Epsilon;
+
+  this->Cells.clear();
+  this->Cells.reserve(2 * numVertices / LeafSize + 1);
+  this->Cells.resize(1);
+  this->BuildCell(0, points, 0, numVertices, bounds[0], bounds[2], size, 0);
+}
+
+//----------------------------------------------------------------------------
+void vtkBarnesHut2DLayoutStrategy::vtkInternals::BuildCell(int index,
+  const float* points, vtkIdType begin, vtkIdType end, float x0, float y0,
+  float size, int depth)
+{
+  vtkIdType* order = &this->Order[0];
+  float center[2] = { 0.0f, 0.0f };
+  for (vtkIdType i = begin; i < end; ++i)
+    {
+    center[0] += points[3 * order[i]];
+    center[1] += points[3 * order[i] + 1];
+    }
+  float mass = static_cast<float>(end - begin);
+
+  vtkBarnesHutCell& cell = this->Cells[index];
+  cell.Origin[0] = x0;
+  cell.Origin[1] = y0;
+  cell.Size = size;
+  cell.Center[0] = center[0] / mass;
+  cell.Center[1] = center[1] / mass;
+  cell.Mass = mass;
+  cell.FirstChild = -1;
+  cell.NumberOfChildren = 0;
+  cell.Begin = begin;
+  cell.End = end;
+  if (end - begin <= LeafSize || depth == MaxDepth)
+    {
+    return;
+    }
+
+  // Sort the vertices of the cell by quadrant.
+  const float half = 0.5f * size;
+  vtkIdType counts[4] = { 0, 0, 0, 0 };
+  for (vtkIdType i = begin; i < end; ++i)
+    {
+    const float* p = points + 3 * order[i];
+    ++counts[(p[0] >= x0 + half ? 1 : 0) + (p[1] >= y0 + half ? 2 : 0)];
+    }
+  vtkIdType starts[5];
+  starts[0] = begin;
+  for (int q = 0; q < 4; ++q)
+    {
+    starts[q + 1] = starts[q] + counts[q];
+    }
+  vtkIdType next[4] = { starts[0], starts[1], starts[2], starts[3] };
+  vtkIdType* scratch = &this->Scratch[0];
+  for (vtkIdType i = begin; i < end; ++i)
+    {
+    const float* p = points + 3 * order[i];
+    scratch[next[(p[0] >= x0 + half ? 1 : 0) + (p[1] >= y0 + half ? 2 : 0)]++] =
+      order[i];
+    }
+  std::copy(scratch + begin, scratch + end, order + begin);
+
+  int numChildren = 0;
+  for (int q = 0; q < 4; ++q)
+    {
+    numChildren += counts[q] > 0 ? 1 : 0;
+    }
+  int firstChild = static_cast<int>(this->Cells.size());
+  // the reference to the cell does not survive the resize
+  this->Cells[index].FirstChild = firstChild;
+  this->Cells[index].NumberOfChildren = numChildren;
+  this->Cells.resize(firstChild + numChildren);
+
+  int child = firstChild;
+  for (int q = 0; q < 4; ++q)
+    {
+    if (counts[q] > 0)
+      {
+      this->BuildCell(child++, points, starts[q], starts[q + 1],
+        (q & 1) ? x0 + half : x0, (q & 2) ? y0 + half : y0, half, depth + 1);
+      }
+    }
+}
+
+// ----------------------------------------------------------------------
+
+vtkBarnesHut2DLayoutStrategy::vtkBarnesHut2DLayoutStrategy()
+{
+  this->Internals = new vtkInternals;
+  this->RandomSeed = 123;
+  this->IterationsPerLayout = 200;
+  this->InitialTemperature = 1;
+  this->CoolDownRate = 50.0;
+  this->LayoutComplete = 0;
+  this->TotalIterations = 0;
+  this->Temp = 0;
+  this->EdgeWeightField = 0;
+  this->SetEdgeWeightField("weight");
+  this->RestDistance = 0;
+  this->Theta = 0.5;
+  this->Jitter = true;
+  this->MaxNumberOfIterations = 200;
+}
+
+// ----------------------------------------------------------------------
+
+vtkBarnesHut2DLayoutStrategy::~vtkBarnesHut2DLayoutStrategy()
+{
+  this->SetEdgeWeightField(0);
+  delete this->Internals;
+}
+
+// ----------------------------------------------------------------------
+
+void vtkBarnesHut2DLayoutStrategy::Initialize()
+{
+  vtkMath::RandomSeed(this->RandomSeed);
+
+  vtkPoints *pts = this->Graph->GetPoints();
+  vtkIdType numVertices = this->Graph->GetNumberOfVertices();
+
+  // Make sure output point type is float
+  if (pts->GetData()->GetDataType() != VTK_FLOAT)
+    {
+    vtkErrorMacro("Layout strategy expects to have points of type float");
+    this->LayoutComplete = 1;
+    return;
+    }
+
+  vtkFloatArray *array = vtkFloatArray::SafeDownCast(pts->GetData());
+  float *rawPointData = array->GetPointer(0);
+
+  // The optimal distance between vertices.
+  if (this->RestDistance == 0)
+    {
+    this->RestDistance = 1.0 / (numVertices > 0 ? numVertices : 1);
+    }
+
+  if (this->Jitter)
+    {
+    for (vtkIdType i = 0; i < numVertices * 3; i += 3)
+      {
+      rawPointData[i] += this->RestDistance*(vtkMath::Random() - .5);
+      rawPointData[i+1] += this->RestDistance*(vtkMath::Random() - .5);
+      }
+    }
+
+  // Get the weight array
+  vtkDataArray* weightArray = NULL;
+  double maxWeight = 1;
+  if (this->WeightEdges && this->EdgeWeightField != NULL)
+    {
+    weightArray = vtkDataArray::SafeDownCast(
+      this->Graph->GetEdgeData()->GetAbstractArray(this->EdgeWeightField));
+    if (weightArray != NULL)
+      {
+      for (vtkIdType w = 0; w < weightArray->GetNumberOfTuples(); w++)
+        {
+        maxWeight = std::max(maxWeight, weightArray->GetTuple1(w));
+        }
+      }
+    }
+
+  // Count the edges of each vertex, then list them.
+  std::vector<vtkIdType>& offsets = this->Internals->Offsets;
+  offsets.assign(numVertices + 1, 0);
+  vtkSmartPointer<vtkEdgeListIterator> edges =
+    vtkSmartPointer<vtkEdgeListIterator>::New();
+  this->Graph->GetEdges(edges);
+  while (edges->HasNext())
+    {
+    vtkEdgeType e = edges->Next();
+    if (e.Source != e.Target)
+      {
+      ++offsets[e.Source + 1];
+      ++offsets[e.Target + 1];
+      }
+    }
+  for (vtkIdType v = 0; v < numVertices; ++v)
+    {
+    offsets[v + 1] += offsets[v];
+    }
+  this->Internals->Neighbors.resize(offsets[numVertices]);
+  this->Internals->Weights.resize(offsets[numVertices]);
+  std::vector<vtkIdType> next(offsets.begin(), offsets.end() - 1);
+  this->Graph->GetEdges(edges);
+  while (edges->HasNext())
+    {
+    vtkEdgeType e = edges->Next();
+    if (e.Source == e.Target)
+      {
+      continue;
+      }
+    float weight = weightArray ?
+      static_cast<float>(weightArray->GetTuple1(e.Id) / maxWeight) : 1.0f;
+    this->Internals->Neighbors[next[e.Source]] = e.Target;
+    this->Internals->Weights[next[e.Source]++] = weight;
+    this->Internals->Neighbors[next[e.Target]] = e.Source;
+    this->Internals->Weights[next[e.Target]++] = weight;
+    }
+
+  this->Internals->Forces.resize(2 * numVertices);
+
+  // Set some vars
+  this->TotalIterations = 0;
+  this->LayoutComplete = 0;
+  this->Temp = this->InitialTemperature;
+}
+
+// ----------------------------------------------------------------------
+
+void vtkBarnesHut2DLayoutStrategy::Layout()
+{
+  // Do I have a graph to layout
+  if (this->Graph == NULL)
+    {
+    vtkErrorMacro("Graph Layout called with Graph==NULL, call SetGraph(g) first");
+    this->LayoutComplete = 1;
+    return;
+    }
+
+  vtkIdType numVertices = this->Graph->GetNumberOfVertices();
+  vtkFloatArray *array =
+    vtkFloatArray::SafeDownCast(this->Graph->GetPoints()->GetData());
+  if (!array || numVertices == 0 ||
+    static_cast<vtkIdType>(this->Internals->Offsets.size()) != numVertices + 1)
+    {
+    this->LayoutComplete = 1;
+    return;
+    }
+  float *rawPointData = array->GetPointer(0);
+
+  vtkBarnesHutForces forces;
+  forces.Cells = &this->Internals->Cells;
+  forces.Points = rawPointData;
+  forces.Offsets = &this->Internals->Offsets[0];
+  forces.Neighbors = this->Internals->Neighbors.empty() ?
+    NULL : &this->Internals->Neighbors[0];
+  forces.Weights = this->Internals->Weights.empty() ?
+    NULL : &this->Internals->Weights[0];
+  forces.Forces = &this->Internals->Forces[0];
+  forces.Theta2 = this->Theta * this->Theta;
+  forces.RestDistance = this->RestDistance;
+
+  vtkBarnesHutMove move;
+  move.Forces = &this->Internals->Forces[0];
+  move.Points = rawPointData;
+
+  for (int i = 0; i < this->IterationsPerLayout; ++i)
+    {
+    // The tree is rebuilt as the vertices move.
+    this->Internals->BuildTree(rawPointData, numVertices);
+    forces.Order = &this->Internals->Order[0];
+    vtkSMPTools::For(0, numVertices, forces);
+
+    move.Temp = this->Temp;
+    vtkSMPTools::For(0, numVertices, move);
+
+    // Reduce temperature as layout approaches a better configuration.
+    this->Temp = CoolDown(this->Temp, this->CoolDownRate);
+
+    // Announce progress
+    double progress = (i+this->TotalIterations) /
+                      static_cast<double>(this->MaxNumberOfIterations);
+    this->InvokeEvent(vtkCommand::ProgressEvent, static_cast<void *>(&progress));
+    }
+
+  // Check for completion of layout
+  this->TotalIterations += this->IterationsPerLayout;
+  if (this->TotalIterations >= this->MaxNumberOfIterations)
+    {
+    // I'm done
+    this->LayoutComplete = 1;
+    }
+
+  // Mark the points as modified
+  this->Graph->GetPoints()->Modified();
+}
+
+// ----------------------------------------------------------------------
+
+void vtkBarnesHut2DLayoutStrategy::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "RandomSeed: " << this->RandomSeed << endl;
+  os << indent << "InitialTemperature: " << this->InitialTemperature << endl;
+  os << indent << "MaxNumberOfIterations: " << this->MaxNumberOfIterations << endl;
+  os << indent << "IterationsPerLayout: " << this->IterationsPerLayout << endl;
+  os << indent << "CoolDownRate: " << this->CoolDownRate << endl;
+  os << indent << "Jitter: " << (this->Jitter ? "True" : "False") << endl;
+  os << indent << "RestDistance: " << this->RestDistance << endl;
+  os << indent << "Theta: " << this->Theta << endl;
+}
@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBarnesHut2DLayoutStrategy.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkBarnesHut2DLayoutStrategy - a multithreaded 2D graph layout
+// for large graphs
+//
+// .SECTION Description
+// This strategy uses the forces of vtkSimple2DLayoutStrategy, but instead
+// of summing the repulsion of all pairs of vertices, which is O(n^2) per
+// iteration, it builds a quadtree of the vertices on every iteration and
+// lets a distant cell of the tree act as a single vertex at its center of
+// mass (Barnes & Hut, "A hierarchical O(N log N) force-calculation
+// algorithm", Nature 324, 1986). The forces on the vertices, repulsion and
+// attraction along the edges, are accumulated in parallel with
+// vtkSMPTools, each thread writing the forces of its own vertices only.
+//
+// .SECTION See Also
+// vtkSimple2DLayoutStrategy vtkFast2DLayoutStrategy
+
+#ifndef vtkBarnesHut2DLayoutStrategy_h
+#define vtkBarnesHut2DLayoutStrategy_h
+
+#include "vtkInfovisLayoutModule.h" // For export macro
+#include "vtkGraphLayoutStrategy.h"
+
+class VTKINFOVISLAYOUT_EXPORT vtkBarnesHut2DLayoutStrategy : public vtkGraphLayoutStrategy
+{
+public:
+  static vtkBarnesHut2DLayoutStrategy *New();
+
+  vtkTypeMacro(vtkBarnesHut2DLayoutStrategy, vtkGraphLayoutStrategy);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Seed the random number generator used to jitter point positions.
+  vtkSetClampMacro(RandomSeed, int, 0, VTK_INT_MAX);
+  vtkGetMacro(RandomSeed, int);
+
+  // Description:
+  // Set/Get the maximum number of iterations to be used.
+  // The default is '200'.
+  vtkSetClampMacro(MaxNumberOfIterations, int, 0, VTK_INT_MAX);
+  vtkGetMacro(MaxNumberOfIterations, int);
+
+  // Description:
+  // Set/Get the number of iterations per layout, so that the application
+  // can show the layout before it is complete. The default is '200'.
+  vtkSetClampMacro(IterationsPerLayout, int, 0, VTK_INT_MAX);
+  vtkGetMacro(IterationsPerLayout, int);
+
+  // Description:
+  // Set the initial temperature, the largest move of a vertex in an
+  // iteration. The default is '1'.
+  vtkSetClampMacro(InitialTemperature, float, 0.0, VTK_FLOAT_MAX);
+  vtkGetMacro(InitialTemperature, float);
+
+  // Description:
+  // Set/Get the cool-down rate. The higher this number is, the longer it
+  // takes to cool down. The default is '50'.
+  vtkSetClampMacro(CoolDownRate, double, 0.01, VTK_DOUBLE_MAX);
+  vtkGetMacro(CoolDownRate, double);
+
+  // Description:
+  // Set random jitter of the nodes at initialization on or off.
+  // Default is ON.
+  vtkSetMacro(Jitter, bool);
+  vtkGetMacro(Jitter, bool);
+
+  // Description:
+  // Manually set the resting distance. Otherwise the distance is computed
+  // automatically as for vtkSimple2DLayoutStrategy.
+  vtkSetMacro(RestDistance, float);
+  vtkGetMacro(RestDistance, float);
+
+  // Description:
+  // Set/Get the opening angle of the quadtree cells. A cell whose width is
+  // smaller than Theta times its distance to a vertex repels the vertex as
+  // a whole. 0 computes the exact repulsion of all pairs; higher values are
+  // faster and less accurate. The default is '0.5'.
+  vtkSetClampMacro(Theta, float, 0.0, VTK_FLOAT_MAX);
+  vtkGetMacro(Theta, float);
+
+  // Description:
+  // This strategy sets up some data structures
+  // for faster processing of each Layout() call
+  virtual void Initialize();
+
+  // Description:
+  // Run IterationsPerLayout iterations of the layout.
+  virtual void Layout();
+
+  // Description:
+  // I'm an iterative layout so this method lets the caller
+  // know if I'm done laying out the graph
+  virtual int IsLayoutComplete() {return this->LayoutComplete;}
+
+protected:
+  vtkBarnesHut2DLayoutStrategy();
+  ~vtkBarnesHut2DLayoutStrategy();
+
+  int    MaxNumberOfIterations;  //Maximum number of iterations.
+  float  InitialTemperature;
+  float  CoolDownRate;  //Cool-down rate.  Note:  Higher # = Slower rate.
+
+private:
+  //BTX
+  class vtkInternals;
+  vtkInternals* Internals;
+  //ETX
+
+  int RandomSeed;
+  int IterationsPerLayout;
+  int TotalIterations;
+  int LayoutComplete;
+  float Temp;
+  float RestDistance;
+  float Theta;
+  bool Jitter;
+
+  vtkBarnesHut2DLayoutStrategy(const vtkBarnesHut2DLayoutStrategy&);  // Not implemented.
+  void operator=(const vtkBarnesHut2DLayoutStrategy&);  // Not implemented.
+};
+
+#endif
@@ -20,6 +20,8 @@
 #include "vtkServerSocket.h"
 #include "vtkPolyData.h"
 #include "vtkDoubleArray.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkZLibDataCompressor.h"
 
 #include <sstream>
 
@@ -111,6 +113,51 @@ int main(int argc, char *argv[])
     // ship messages around.
     is_server = !is_server;
     }
+
+  // Send arrays compressed in several chunks: one compresses well, the
+  // other does not and is sent as is.
+  MESSAGE("---- Test compression ----");
+  vtkNew<vtkZLibDataCompressor> compressor;
+  comm->SetCompressor(compressor.GetPointer());
+  comm->SetCompressionThreshold(1024);
+  comm->SetCompressionChunkSize(4096);
+  const vtkIdType numValues = 100000;
+  vtkNew<vtkUnsignedCharArray> noise;
+  if (is_server)
+    {
+    dArray->SetNumberOfTuples(numValues);
+    noise->SetNumberOfTuples(numValues);
+    unsigned int seed = 1;
+    for (vtkIdType i = 0; i < numValues; ++i)
+      {
+      dArray->SetValue(i, static_cast<double>(i % 100));
+      seed = seed * 1103515245 + 12345;
+      noise->SetValue(i, static_cast<unsigned char>(seed >> 16));
+      }
+    controller->Send(dArray.GetPointer(), 1, 101015);
+    controller->Send(noise.GetPointer(), 1, 101016);
+    }
+  else
+    {
+    controller->Receive(dArray.GetPointer(), 1, 101015);
+    controller->Receive(noise.GetPointer(), 1, 101016);
+    bool valid = (dArray->GetNumberOfTuples() == numValues &&
+                  noise->GetNumberOfTuples() == numValues);
+    unsigned int seed = 1;
+    for (vtkIdType i = 0; valid && i < numValues; ++i)
+      {
+      seed = seed * 1103515245 + 12345;
+      valid = (dArray->GetValue(i) == static_cast<double>(i % 100) &&
+               noise->GetValue(i) == static_cast<unsigned char>(seed >> 16));
+      }
+    if (!valid)
+      {
+      MESSAGE("ERROR: Compressed communication failed!!!");
+      return EXIT_FAILURE;
+      }
+    }
+  MESSAGE("   .... PASSED!");
+
   MESSAGE("All's well!");
   return EXIT_SUCCESS;
 }
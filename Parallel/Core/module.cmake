@@ -6,6 +6,7 @@ vtk_module(vtkParallelCore
     # vtkIOLegacy) because it allows us to turn of wrapping
     # of vtkIOLegacy off but still satisfy API dependcy.
     vtkCommonCore
+    vtkIOCore
     vtkIOLegacy
   PRIVATE_DEPENDS
     vtksys
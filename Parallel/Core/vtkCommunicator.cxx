@@ -15,6 +15,8 @@
 #include "vtkCommunicator.h"
 
 #include "vtkBoundingBox.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataObjectTypes.h"
@@ -31,6 +33,9 @@
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredGrid.h"
@@ -39,6 +44,7 @@
 #include "vtkTable.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedLongArray.h"
+#include "vtkUnstructuredGrid.h"
 
 #define VTK_CREATE(type, name) \
   vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
@@ -220,6 +226,16 @@ int vtkCommunicator::SendElementalDataObject(
   vtkDataObject* data, int remoteHandle,
   int tag)
 {
+  int binary = vtkCommunicator::CanSendBinaryDataObject(data) ? 1 : 0;
+  if (!this->Send(&binary, 1, remoteHandle, tag))
+    {
+    return 0;
+    }
+  if (binary)
+    {
+    return this->SendBinaryDataObject(data, remoteHandle, tag);
+    }
+
   VTK_CREATE(vtkCharArray, buffer);
   if (vtkCommunicator::MarshalDataObject(data, buffer))
     {
@@ -416,6 +432,16 @@ int vtkCommunicator::ReceiveElementalDataObject(
   vtkDataObject* data, int remoteHandle,
   int tag)
 {
+  int binary;
+  if (!this->Receive(&binary, 1, remoteHandle, tag))
+    {
+    return 0;
+    }
+  if (binary)
+    {
+    return this->ReceiveBinaryDataObject(data, remoteHandle, tag);
+    }
+
   VTK_CREATE(vtkCharArray, buffer);
   if (!this->Receive(buffer, remoteHandle, tag))
     {
@@ -425,6 +451,395 @@ int vtkCommunicator::ReceiveElementalDataObject(
   return vtkCommunicator::UnMarshalDataObject(buffer, data);
 }
 
+//----------------------------------------------------------------------------
+// The binary format describes each array in the stream, and lists the array
+// in buffers to be transferred once the stream is.
+static void vtkCommunicatorPushArray(vtkMultiProcessStream &stream,
+                                     vtkDataArray *array,
+                                     std::vector<vtkDataArray*> &buffers)
+{
+  if (!array)
+    {
+    stream << -1;
+    return;
+    }
+  const char *name = array->GetName();
+  stream << array->GetDataType()
+         << static_cast<vtkTypeInt64>(array->GetNumberOfTuples())
+         << array->GetNumberOfComponents()
+         << (name != NULL) << std::string(name ? name : "");
+  buffers.push_back(array);
+}
+
+//----------------------------------------------------------------------------
+static vtkSmartPointer<vtkDataArray> vtkCommunicatorPopArray(
+  vtkMultiProcessStream &stream, std::vector<vtkDataArray*> &buffers)
+{
+  vtkSmartPointer<vtkDataArray> array;
+  int type;
+  stream >> type;
+  if (type < 0)
+    {
+    return array;
+    }
+  vtkTypeInt64 numTuples;
+  int numComponents;
+  bool hasName;
+  std::string name;
+  stream >> numTuples >> numComponents >> hasName >> name;
+  array.TakeReference(vtkDataArray::CreateDataArray(type));
+  array->SetNumberOfComponents(numComponents);
+  array->SetNumberOfTuples(numTuples);
+  if (hasName)
+    {
+    array->SetName(name.c_str());
+    }
+  buffers.push_back(array);
+  return array;
+}
+
+//----------------------------------------------------------------------------
+static void vtkCommunicatorPushFieldData(vtkMultiProcessStream &stream,
+                                         vtkFieldData *fd,
+                                         std::vector<vtkDataArray*> &buffers)
+{
+  stream << fd->GetNumberOfArrays();
+  for (int i = 0; i < fd->GetNumberOfArrays(); i++)
+    {
+    vtkCommunicatorPushArray(stream, fd->GetArray(i), buffers);
+    }
+  vtkDataSetAttributes *dsa = vtkDataSetAttributes::SafeDownCast(fd);
+  if (dsa)
+    {
+    int indices[vtkDataSetAttributes::NUM_ATTRIBUTES];
+    dsa->GetAttributeIndices(indices);
+    for (int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; i++)
+      {
+      stream << indices[i];
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+static void vtkCommunicatorPopFieldData(vtkMultiProcessStream &stream,
+                                        vtkFieldData *fd,
+                                        std::vector<vtkDataArray*> &buffers)
+{
+  int numArrays;
+  stream >> numArrays;
+  for (int i = 0; i < numArrays; i++)
+    {
+    fd->AddArray(vtkCommunicatorPopArray(stream, buffers));
+    }
+  vtkDataSetAttributes *dsa = vtkDataSetAttributes::SafeDownCast(fd);
+  if (dsa)
+    {
+    for (int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; i++)
+      {
+      int index;
+      stream >> index;
+      if (index >= 0)
+        {
+        dsa->SetActiveAttribute(index, i);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+static void vtkCommunicatorPushCells(vtkMultiProcessStream &stream,
+                                     vtkCellArray *cells,
+                                     std::vector<vtkDataArray*> &buffers)
+{
+  stream << static_cast<vtkTypeInt64>(cells ? cells->GetNumberOfCells() : -1);
+  if (cells)
+    {
+    vtkCommunicatorPushArray(stream, cells->GetData(), buffers);
+    }
+}
+
+//----------------------------------------------------------------------------
+static vtkSmartPointer<vtkCellArray> vtkCommunicatorPopCells(
+  vtkMultiProcessStream &stream, std::vector<vtkDataArray*> &buffers)
+{
+  vtkSmartPointer<vtkCellArray> cells;
+  vtkTypeInt64 numCells;
+  stream >> numCells;
+  if (numCells >= 0)
+    {
+    cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetCells(numCells, vtkIdTypeArray::SafeDownCast(
+                      vtkCommunicatorPopArray(stream, buffers)));
+    }
+  return cells;
+}
+
+//----------------------------------------------------------------------------
+static vtkSmartPointer<vtkPoints> vtkCommunicatorPopPoints(
+  vtkMultiProcessStream &stream, std::vector<vtkDataArray*> &buffers)
+{
+  vtkSmartPointer<vtkPoints> points;
+  vtkSmartPointer<vtkDataArray> data =
+    vtkCommunicatorPopArray(stream, buffers);
+  if (data)
+    {
+    points = vtkSmartPointer<vtkPoints>::New();
+    points->SetData(data);
+    }
+  return points;
+}
+
+//----------------------------------------------------------------------------
+static bool vtkCommunicatorHasOnlyDataArrays(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); i++)
+    {
+    // Bit arrays are packed, their buffer is not an array of their type.
+    vtkDataArray *array = fd->GetArray(i);
+    if (!array || array->GetDataType() == VTK_BIT)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkCommunicator::CanSendBinaryDataObject(vtkDataObject *data)
+{
+  switch (data->GetDataObjectType())
+    {
+    case VTK_POLY_DATA:
+    case VTK_UNSTRUCTURED_GRID:
+    case VTK_IMAGE_DATA:
+    case VTK_STRUCTURED_POINTS:
+    case VTK_STRUCTURED_GRID:
+    case VTK_RECTILINEAR_GRID:
+      break;
+    default:
+      return false;
+    }
+  vtkDataSet *ds = static_cast<vtkDataSet*>(data);
+  return vtkCommunicatorHasOnlyDataArrays(ds->GetFieldData()) &&
+    vtkCommunicatorHasOnlyDataArrays(ds->GetPointData()) &&
+    vtkCommunicatorHasOnlyDataArrays(ds->GetCellData());
+}
+
+//----------------------------------------------------------------------------
+int vtkCommunicator::SendBinaryDataObject(vtkDataObject *data,
+                                          int remoteHandle, int tag)
+{
+  vtkMultiProcessStream stream;
+  std::vector<vtkDataArray*> buffers;
+
+  vtkDataSet *ds = static_cast<vtkDataSet*>(data);
+  vtkCommunicatorPushFieldData(stream, ds->GetFieldData(), buffers);
+  vtkCommunicatorPushFieldData(stream, ds->GetPointData(), buffers);
+  vtkCommunicatorPushFieldData(stream, ds->GetCellData(), buffers);
+
+  int extent[6];
+  if (vtkImageData *id = vtkImageData::SafeDownCast(data))
+    {
+    id->GetExtent(extent);
+    double *origin = id->GetOrigin();
+    double *spacing = id->GetSpacing();
+    for (int i = 0; i < 6; i++)
+      {
+      stream << extent[i];
+      }
+    for (int i = 0; i < 3; i++)
+      {
+      stream << origin[i] << spacing[i];
+      }
+    }
+  else if (vtkRectilinearGrid *rg = vtkRectilinearGrid::SafeDownCast(data))
+    {
+    rg->GetExtent(extent);
+    for (int i = 0; i < 6; i++)
+      {
+      stream << extent[i];
+      }
+    vtkCommunicatorPushArray(stream, rg->GetXCoordinates(), buffers);
+    vtkCommunicatorPushArray(stream, rg->GetYCoordinates(), buffers);
+    vtkCommunicatorPushArray(stream, rg->GetZCoordinates(), buffers);
+    }
+  else if (vtkPointSet *ps = vtkPointSet::SafeDownCast(data))
+    {
+    vtkPoints *points = ps->GetPoints();
+    vtkCommunicatorPushArray(stream, points ? points->GetData() : NULL,
+                             buffers);
+    if (vtkStructuredGrid *sg = vtkStructuredGrid::SafeDownCast(data))
+      {
+      sg->GetExtent(extent);
+      for (int i = 0; i < 6; i++)
+        {
+        stream << extent[i];
+        }
+      }
+    else if (vtkPolyData *pd = vtkPolyData::SafeDownCast(data))
+      {
+      vtkCommunicatorPushCells(stream, pd->GetVerts(), buffers);
+      vtkCommunicatorPushCells(stream, pd->GetLines(), buffers);
+      vtkCommunicatorPushCells(stream, pd->GetPolys(), buffers);
+      vtkCommunicatorPushCells(stream, pd->GetStrips(), buffers);
+      }
+    else if (vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(data))
+      {
+      // Grids with a single cell type do not need the types and locations.
+      stream << ug->GetSingleCellType();
+      vtkCommunicatorPushCells(stream, ug->GetCells(), buffers);
+      if (ug->GetSingleCellType() < 0 && ug->GetCells())
+        {
+        vtkCommunicatorPushArray(stream, ug->GetCellTypesArray(), buffers);
+        vtkCommunicatorPushArray(stream, ug->GetCellLocationsArray(),
+                                 buffers);
+        vtkCommunicatorPushArray(stream, ug->GetFaces(), buffers);
+        vtkCommunicatorPushArray(stream, ug->GetFaceLocations(), buffers);
+        }
+      }
+    }
+
+  if (!this->Send(stream, remoteHandle, tag))
+    {
+    return 0;
+    }
+  for (size_t i = 0; i < buffers.size(); i++)
+    {
+    vtkDataArray *array = buffers[i];
+    vtkIdType size = array->GetNumberOfTuples() *
+      array->GetNumberOfComponents();
+    if (size > 0 &&
+        !this->SendVoidArray(array->GetVoidPointer(0), size,
+                             array->GetDataType(), remoteHandle, tag))
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkCommunicator::ReceiveBinaryDataObject(vtkDataObject *data,
+                                             int remoteHandle, int tag)
+{
+  vtkMultiProcessStream stream;
+  if (!this->Receive(stream, remoteHandle, tag))
+    {
+    return 0;
+    }
+  std::vector<vtkDataArray*> buffers;
+
+  vtkDataSet *ds = vtkDataSet::SafeDownCast(data);
+  if (!ds)
+    {
+    vtkErrorMacro("Cannot receive a dataset in a "
+                  << data->GetClassName());
+    return 0;
+    }
+  ds->Initialize();
+  vtkCommunicatorPopFieldData(stream, ds->GetFieldData(), buffers);
+  vtkCommunicatorPopFieldData(stream, ds->GetPointData(), buffers);
+  vtkCommunicatorPopFieldData(stream, ds->GetCellData(), buffers);
+
+  // Grids with a single cell type are built from their connectivity, once
+  // it is received.
+  int singleCellType = -1;
+  vtkSmartPointer<vtkCellArray> singleTypeCells;
+
+  int extent[6];
+  if (vtkImageData *id = vtkImageData::SafeDownCast(data))
+    {
+    double origin[3];
+    double spacing[3];
+    for (int i = 0; i < 6; i++)
+      {
+      stream >> extent[i];
+      }
+    for (int i = 0; i < 3; i++)
+      {
+      stream >> origin[i] >> spacing[i];
+      }
+    id->SetExtent(extent);
+    id->SetOrigin(origin);
+    id->SetSpacing(spacing);
+    }
+  else if (vtkRectilinearGrid *rg = vtkRectilinearGrid::SafeDownCast(data))
+    {
+    for (int i = 0; i < 6; i++)
+      {
+      stream >> extent[i];
+      }
+    rg->SetExtent(extent);
+    rg->SetXCoordinates(vtkCommunicatorPopArray(stream, buffers));
+    rg->SetYCoordinates(vtkCommunicatorPopArray(stream, buffers));
+    rg->SetZCoordinates(vtkCommunicatorPopArray(stream, buffers));
+    }
+  else if (vtkPointSet *ps = vtkPointSet::SafeDownCast(data))
+    {
+    ps->SetPoints(vtkCommunicatorPopPoints(stream, buffers));
+    if (vtkStructuredGrid *sg = vtkStructuredGrid::SafeDownCast(data))
+      {
+      for (int i = 0; i < 6; i++)
+        {
+        stream >> extent[i];
+        }
+      sg->SetExtent(extent);
+      }
+    else if (vtkPolyData *pd = vtkPolyData::SafeDownCast(data))
+      {
+      pd->SetVerts(vtkCommunicatorPopCells(stream, buffers));
+      pd->SetLines(vtkCommunicatorPopCells(stream, buffers));
+      pd->SetPolys(vtkCommunicatorPopCells(stream, buffers));
+      pd->SetStrips(vtkCommunicatorPopCells(stream, buffers));
+      }
+    else if (vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(data))
+      {
+      stream >> singleCellType;
+      vtkSmartPointer<vtkCellArray> cells =
+        vtkCommunicatorPopCells(stream, buffers);
+      if (cells && singleCellType >= 0)
+        {
+        singleTypeCells = cells;
+        }
+      else if (cells)
+        {
+        vtkSmartPointer<vtkDataArray> types =
+          vtkCommunicatorPopArray(stream, buffers);
+        vtkSmartPointer<vtkDataArray> locations =
+          vtkCommunicatorPopArray(stream, buffers);
+        vtkSmartPointer<vtkDataArray> faces =
+          vtkCommunicatorPopArray(stream, buffers);
+        vtkSmartPointer<vtkDataArray> faceLocations =
+          vtkCommunicatorPopArray(stream, buffers);
+        ug->SetCells(vtkUnsignedCharArray::SafeDownCast(types),
+                     vtkIdTypeArray::SafeDownCast(locations), cells,
+                     vtkIdTypeArray::SafeDownCast(faceLocations),
+                     vtkIdTypeArray::SafeDownCast(faces));
+        }
+      }
+    }
+
+  for (size_t i = 0; i < buffers.size(); i++)
+    {
+    vtkDataArray *array = buffers[i];
+    vtkIdType size = array->GetNumberOfTuples() *
+      array->GetNumberOfComponents();
+    if (size > 0 &&
+        !this->ReceiveVoidArray(array->GetVoidPointer(0), size,
+                                array->GetDataType(), remoteHandle, tag))
+      {
+      return 0;
+      }
+    }
+
+  if (singleTypeCells)
+    {
+    vtkUnstructuredGrid::SafeDownCast(data)->SetCells(singleCellType,
+                                                      singleTypeCells);
+    }
+  return 1;
+}
+
 int vtkCommunicator::Receive(vtkDataArray* data, int remoteHandle, int tag)
 {
   // If we are receiving with ANY_SOURCE, we have a problem because some
@@ -1363,6 +1778,31 @@ int vtkCommunicator::AllGatherVVoidArray(const void *sendBuffer,
   return result;
 }
 
+//-----------------------------------------------------------------------------
+int vtkCommunicator::AllToAllVVoidArray(const void *sendBuffer,
+                                        void *recvBuffer,
+                                        vtkIdType *sendLengths,
+                                        vtkIdType *sendOffsets,
+                                        vtkIdType *recvLengths,
+                                        vtkIdType *recvOffsets, int type)
+{
+  int typeSize = 1;
+  switch (type)
+    {
+    vtkTemplateMacro(typeSize = sizeof(VTK_TT));
+    }
+  // One gather to each process in turn.
+  const char *src = reinterpret_cast<const char *>(sendBuffer);
+  int result = 1;
+  for (int i = 0; i < this->NumberOfProcesses; i++)
+    {
+    result &= this->GatherVVoidArray(src + sendOffsets[i]*typeSize,
+                                     recvBuffer, sendLengths[i],
+                                     recvLengths, recvOffsets, type, i);
+    }
+  return result;
+}
+
 //-----------------------------------------------------------------------------
 int vtkCommunicator::AllGatherV(vtkDataArray *sendBuffer,
                                 vtkDataArray *recvBuffer,
@@ -1609,6 +2049,165 @@ int vtkCommunicator::AllReduce(vtkDataArray *sendBuffer,
                                   components*tuples, type, operation);
 }
 
+//-----------------------------------------------------------------------------
+vtkCommunicator::CollectiveRequest::CollectiveRequest()
+  : Operation(NULL), Status(1)
+{
+}
+
+//-----------------------------------------------------------------------------
+vtkCommunicator::CollectiveRequest::CollectiveRequest(
+  const CollectiveRequest& other)
+  : Operation(other.Operation), Status(other.Status)
+{
+  if (this->Operation)
+    {
+    this->Operation->ReferenceCount++;
+    }
+}
+
+//-----------------------------------------------------------------------------
+vtkCommunicator::CollectiveRequest::~CollectiveRequest()
+{
+  this->Release();
+}
+
+//-----------------------------------------------------------------------------
+vtkCommunicator::CollectiveRequest&
+vtkCommunicator::CollectiveRequest::operator=(const CollectiveRequest& other)
+{
+  if (this->Operation != other.Operation)
+    {
+    this->Release();
+    this->Operation = other.Operation;
+    if (this->Operation)
+      {
+      this->Operation->ReferenceCount++;
+      }
+    }
+  this->Status = other.Status;
+  return *this;
+}
+
+//-----------------------------------------------------------------------------
+void vtkCommunicator::CollectiveRequest::Initialize(Pending *pending,
+                                                    int status)
+{
+  this->Release();
+  this->Operation = pending;
+  this->Status = status;
+}
+
+//-----------------------------------------------------------------------------
+void vtkCommunicator::CollectiveRequest::Release()
+{
+  if (this->Operation && --this->Operation->ReferenceCount == 0)
+    {
+    // The buffers of the operation may be freed as soon as the request is
+    // gone, so it has to complete first.
+    this->Operation->Wait();
+    delete this->Operation;
+    }
+  this->Operation = NULL;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::CollectiveRequest::Test()
+{
+  if (!this->Operation)
+    {
+    return 1;
+    }
+  int done = 0;
+  if (!this->Operation->Test(done))
+    {
+    this->Status = 0;
+    done = 1;
+    }
+  if (done)
+    {
+    this->Release();
+    }
+  return done;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::CollectiveRequest::Wait()
+{
+  if (this->Operation)
+    {
+    this->Status = this->Operation->Wait();
+    this->Release();
+    }
+  return this->Status;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::WaitAll(int count, CollectiveRequest *requests)
+{
+  int result = 1;
+  for (int i = 0; i < count; i++)
+    {
+    if (!requests[i].Wait())
+      {
+      result = 0;
+      }
+    }
+  return result;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::IBroadcastVoidArray(void *data, vtkIdType length,
+                                         int type, int srcProcessId,
+                                         CollectiveRequest &req)
+{
+  int status = this->BroadcastVoidArray(data, length, type, srcProcessId);
+  req.Initialize(NULL, status);
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::IGatherVVoidArray(const void *sendBuffer,
+                                       void *recvBuffer,
+                                       vtkIdType sendLength,
+                                       vtkIdType *recvLengths,
+                                       vtkIdType *offsets, int type,
+                                       int destProcessId,
+                                       CollectiveRequest &req)
+{
+  int status = this->GatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                      recvLengths, offsets, type,
+                                      destProcessId);
+  req.Initialize(NULL, status);
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::IReduceVoidArray(const void *sendBuffer,
+                                      void *recvBuffer,
+                                      vtkIdType length, int type,
+                                      int operation, int destProcessId,
+                                      CollectiveRequest &req)
+{
+  int status = this->ReduceVoidArray(sendBuffer, recvBuffer, length, type,
+                                     operation, destProcessId);
+  req.Initialize(NULL, status);
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::IAllReduceVoidArray(const void *sendBuffer,
+                                         void *recvBuffer,
+                                         vtkIdType length, int type,
+                                         int operation,
+                                         CollectiveRequest &req)
+{
+  int status = this->AllReduceVoidArray(sendBuffer, recvBuffer, length, type,
+                                        operation);
+  req.Initialize(NULL, status);
+  return status;
+}
+
 //-----------------------------------------------------------------------------
 int vtkCommunicator::Broadcast(vtkMultiProcessStream& stream, int srcProcessId)
 {
@@ -115,6 +115,64 @@ public:
     virtual ~Operation() {}
   };
 
+  // Description:
+  // A handle on a nonblocking collective operation started by IBroadcast(),
+  // IGatherV(), IReduce() or IAllReduce(). The buffers of the operation must
+  // not be accessed until Test() or Wait() reports its completion.
+  // Communicators without nonblocking collectives run the blocking operation
+  // when it is started, so the request returned is already complete. Copies
+  // of a request share its operation, and destroying the last copy of a
+  // pending request waits for it.
+  class VTKPARALLELCORE_EXPORT CollectiveRequest
+  {
+  public:
+    CollectiveRequest();
+    CollectiveRequest(const CollectiveRequest&);
+    ~CollectiveRequest();
+    CollectiveRequest& operator=(const CollectiveRequest&);
+
+    // Description:
+    // Return 1 if the operation completed and 0 if it is still pending,
+    // without blocking.
+    int Test();
+
+    // Description:
+    // Block until the operation completes. Return 1 if it succeeded and 0
+    // otherwise. A request that was never started succeeds.
+    int Wait();
+
+    // Description:
+    // An operation still in flight, implemented by the communicators with
+    // nonblocking collectives. Test() sets done once the operation
+    // completed, and both methods return 0 on error.
+    class VTKPARALLELCORE_EXPORT Pending
+    {
+    public:
+      Pending() : ReferenceCount(1) {}
+      virtual ~Pending() {}
+      virtual int Test(int &done) = 0;
+      virtual int Wait() = 0;
+
+      int ReferenceCount;
+    };
+
+    // Description:
+    // Internal: make the request track an operation in flight, of which it
+    // takes ownership, or, if pending is NULL, an operation that completed
+    // with the given status.
+    void Initialize(Pending *pending, int status);
+
+  private:
+    void Release();
+
+    Pending *Operation;
+    int Status;
+  };
+
+  // Description:
+  // Wait for all the requests. Return 1 if all of them succeeded.
+  static int WaitAll(int count, CollectiveRequest *requests);
+
 //ETX
 
   // Description:
@@ -929,6 +987,115 @@ public:
                  vtkIdType *recvLengths, vtkIdType *offsets);
   int AllGatherV(vtkDataArray *sendBuffer, vtkDataArray *recvBuffer);
 
+  // Description:
+  // Send a different part of sendBuffer to each process and receive a part
+  // from each process into recvBuffer.  The part sent to process i starts at
+  // sendOffsets[i] and is sendLengths[i] long; the part received from
+  // process i is stored at recvOffsets[i] and is recvLengths[i] long.  All
+  // offsets and lengths are in units of the array type, and recvLengths[i]
+  // must match the sendLengths[j] of process i, where j is this process.
+  int AllToAllV(const int* sendBuffer, int* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_INT);
+  }
+  int AllToAllV(const unsigned int* sendBuffer, unsigned int* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_UNSIGNED_INT);
+  }
+  int AllToAllV(const short* sendBuffer, short* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_SHORT);
+  }
+  int AllToAllV(const unsigned short* sendBuffer, unsigned short* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_UNSIGNED_SHORT);
+  }
+  int AllToAllV(const long* sendBuffer, long* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_LONG);
+  }
+  int AllToAllV(const unsigned long* sendBuffer, unsigned long* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_UNSIGNED_LONG);
+  }
+  int AllToAllV(const unsigned char* sendBuffer, unsigned char* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_UNSIGNED_CHAR);
+  }
+  int AllToAllV(const char* sendBuffer, char* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_CHAR);
+  }
+  int AllToAllV(const signed char* sendBuffer, signed char* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_SIGNED_CHAR);
+  }
+  int AllToAllV(const float* sendBuffer, float* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_FLOAT);
+  }
+  int AllToAllV(const double* sendBuffer, double* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_DOUBLE);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int AllToAllV(const vtkIdType* sendBuffer, vtkIdType* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_ID_TYPE);
+  }
+#else
+  int AllToAllV(const long long* sendBuffer, long long* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_LONG_LONG);
+  }
+#endif
+  int AllToAllV(const unsigned long long* sendBuffer, unsigned long long* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->AllToAllVVoidArray(sendBuffer, recvBuffer,
+                                    sendLengths, sendOffsets,
+                                    recvLengths, recvOffsets, VTK_UNSIGNED_LONG_LONG);
+  }
+
   // Description:
   // Reduce an array to the given destination process.  This version of Reduce
   // takes an identifier defined in the
@@ -1241,6 +1408,396 @@ public:
   int AllReduce(vtkDataArray *sendBuffer, vtkDataArray *recvBuffer,
                 Operation *operation);
 
+//BTX
+  // Description:
+  // Nonblocking version of Broadcast().
+  int IBroadcast(int *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_INT,
+                                     srcProcessId, req);
+  }
+  int IBroadcast(unsigned int *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_UNSIGNED_INT,
+                                     srcProcessId, req);
+  }
+  int IBroadcast(short *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_SHORT,
+                                     srcProcessId, req);
+  }
+  int IBroadcast(unsigned short *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_UNSIGNED_SHORT,
+                                     srcProcessId, req);
+  }
+  int IBroadcast(long *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_LONG,
+                                     srcProcessId, req);
+  }
+  int IBroadcast(unsigned long *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_UNSIGNED_LONG,
+                                     srcProcessId, req);
+  }
+  int IBroadcast(unsigned char *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_UNSIGNED_CHAR,
+                                     srcProcessId, req);
+  }
+  int IBroadcast(char *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_CHAR,
+                                     srcProcessId, req);
+  }
+  int IBroadcast(signed char *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_SIGNED_CHAR,
+                                     srcProcessId, req);
+  }
+  int IBroadcast(float *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_FLOAT,
+                                     srcProcessId, req);
+  }
+  int IBroadcast(double *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_DOUBLE,
+                                     srcProcessId, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int IBroadcast(vtkIdType *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_ID_TYPE,
+                                     srcProcessId, req);
+  }
+#else
+  int IBroadcast(long long *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_LONG_LONG,
+                                     srcProcessId, req);
+  }
+#endif
+  int IBroadcast(unsigned long long *data, vtkIdType length, int srcProcessId,
+                 CollectiveRequest &req) {
+    return this->IBroadcastVoidArray(data, length, VTK_UNSIGNED_LONG_LONG,
+                                     srcProcessId, req);
+  }
+
+  // Description:
+  // Nonblocking version of GatherV().
+  int IGatherV(const int *sendBuffer, int *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_INT,
+                                   destProcessId, req);
+  }
+  int IGatherV(const unsigned int *sendBuffer, unsigned int *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_UNSIGNED_INT,
+                                   destProcessId, req);
+  }
+  int IGatherV(const short *sendBuffer, short *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_SHORT,
+                                   destProcessId, req);
+  }
+  int IGatherV(const unsigned short *sendBuffer, unsigned short *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_UNSIGNED_SHORT,
+                                   destProcessId, req);
+  }
+  int IGatherV(const long *sendBuffer, long *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_LONG,
+                                   destProcessId, req);
+  }
+  int IGatherV(const unsigned long *sendBuffer, unsigned long *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_UNSIGNED_LONG,
+                                   destProcessId, req);
+  }
+  int IGatherV(const unsigned char *sendBuffer, unsigned char *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_UNSIGNED_CHAR,
+                                   destProcessId, req);
+  }
+  int IGatherV(const char *sendBuffer, char *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_CHAR,
+                                   destProcessId, req);
+  }
+  int IGatherV(const signed char *sendBuffer, signed char *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_SIGNED_CHAR,
+                                   destProcessId, req);
+  }
+  int IGatherV(const float *sendBuffer, float *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_FLOAT,
+                                   destProcessId, req);
+  }
+  int IGatherV(const double *sendBuffer, double *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_DOUBLE,
+                                   destProcessId, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int IGatherV(const vtkIdType *sendBuffer, vtkIdType *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_ID_TYPE,
+                                   destProcessId, req);
+  }
+#else
+  int IGatherV(const long long *sendBuffer, long long *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_LONG_LONG,
+                                   destProcessId, req);
+  }
+#endif
+  int IGatherV(const unsigned long long *sendBuffer, unsigned long long *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               CollectiveRequest &req) {
+    return this->IGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                   recvLengths, offsets, VTK_UNSIGNED_LONG_LONG,
+                                   destProcessId, req);
+  }
+
+  // Description:
+  // Nonblocking version of Reduce() with a standard operation.
+  int IReduce(const int *sendBuffer, int *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_INT, operation,
+                                  destProcessId, req);
+  }
+  int IReduce(const unsigned int *sendBuffer, unsigned int *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_UNSIGNED_INT, operation,
+                                  destProcessId, req);
+  }
+  int IReduce(const short *sendBuffer, short *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_SHORT, operation,
+                                  destProcessId, req);
+  }
+  int IReduce(const unsigned short *sendBuffer, unsigned short *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_UNSIGNED_SHORT, operation,
+                                  destProcessId, req);
+  }
+  int IReduce(const long *sendBuffer, long *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_LONG, operation,
+                                  destProcessId, req);
+  }
+  int IReduce(const unsigned long *sendBuffer, unsigned long *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_UNSIGNED_LONG, operation,
+                                  destProcessId, req);
+  }
+  int IReduce(const unsigned char *sendBuffer, unsigned char *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_UNSIGNED_CHAR, operation,
+                                  destProcessId, req);
+  }
+  int IReduce(const char *sendBuffer, char *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_CHAR, operation,
+                                  destProcessId, req);
+  }
+  int IReduce(const signed char *sendBuffer, signed char *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_SIGNED_CHAR, operation,
+                                  destProcessId, req);
+  }
+  int IReduce(const float *sendBuffer, float *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_FLOAT, operation,
+                                  destProcessId, req);
+  }
+  int IReduce(const double *sendBuffer, double *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_DOUBLE, operation,
+                                  destProcessId, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int IReduce(const vtkIdType *sendBuffer, vtkIdType *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_ID_TYPE, operation,
+                                  destProcessId, req);
+  }
+#else
+  int IReduce(const long long *sendBuffer, long long *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_LONG_LONG, operation,
+                                  destProcessId, req);
+  }
+#endif
+  int IReduce(const unsigned long long *sendBuffer, unsigned long long *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              CollectiveRequest &req) {
+    return this->IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                  VTK_UNSIGNED_LONG_LONG, operation,
+                                  destProcessId, req);
+  }
+
+  // Description:
+  // Nonblocking version of AllReduce() with a standard operation.
+  int IAllReduce(const int *sendBuffer, int *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_INT, operation, req);
+  }
+  int IAllReduce(const unsigned int *sendBuffer, unsigned int *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_UNSIGNED_INT, operation, req);
+  }
+  int IAllReduce(const short *sendBuffer, short *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_SHORT, operation, req);
+  }
+  int IAllReduce(const unsigned short *sendBuffer, unsigned short *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_UNSIGNED_SHORT, operation, req);
+  }
+  int IAllReduce(const long *sendBuffer, long *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_LONG, operation, req);
+  }
+  int IAllReduce(const unsigned long *sendBuffer, unsigned long *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_UNSIGNED_LONG, operation, req);
+  }
+  int IAllReduce(const unsigned char *sendBuffer, unsigned char *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_UNSIGNED_CHAR, operation, req);
+  }
+  int IAllReduce(const char *sendBuffer, char *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_CHAR, operation, req);
+  }
+  int IAllReduce(const signed char *sendBuffer, signed char *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_SIGNED_CHAR, operation, req);
+  }
+  int IAllReduce(const float *sendBuffer, float *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_FLOAT, operation, req);
+  }
+  int IAllReduce(const double *sendBuffer, double *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_DOUBLE, operation, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int IAllReduce(const vtkIdType *sendBuffer, vtkIdType *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_ID_TYPE, operation, req);
+  }
+#else
+  int IAllReduce(const long long *sendBuffer, long long *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_LONG_LONG, operation, req);
+  }
+#endif
+  int IAllReduce(const unsigned long long *sendBuffer, unsigned long long *recvBuffer,
+                 vtkIdType length, int operation,
+                 CollectiveRequest &req) {
+    return this->IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                     VTK_UNSIGNED_LONG_LONG, operation, req);
+  }
+//ETX
+
   // Description:
   // Subclasses should reimplement these if they have a more efficient
   // implementation.
@@ -1262,6 +1819,11 @@ public:
   virtual int AllGatherVVoidArray(const void *sendBuffer, void *recvBuffer,
                                   vtkIdType sendLength, vtkIdType *recvLengths,
                                   vtkIdType *offsets, int type);
+  virtual int AllToAllVVoidArray(const void *sendBuffer, void *recvBuffer,
+                                 vtkIdType *sendLengths,
+                                 vtkIdType *sendOffsets,
+                                 vtkIdType *recvLengths,
+                                 vtkIdType *recvOffsets, int type);
   virtual int ReduceVoidArray(const void *sendBuffer, void *recvBuffer,
                               vtkIdType length, int type,
                               int operation, int destProcessId);
@@ -1275,6 +1837,27 @@ public:
                                  vtkIdType length, int type,
                                  Operation *operation);
 
+//BTX
+  // Description:
+  // Start a nonblocking collective operation tracked by req. The default
+  // implementations run the blocking operation and return a completed
+  // request: subclasses should reimplement these if they can overlap the
+  // communication with computation. Return 0 if the operation could not be
+  // started.
+  virtual int IBroadcastVoidArray(void *data, vtkIdType length, int type,
+                                  int srcProcessId, CollectiveRequest &req);
+  virtual int IGatherVVoidArray(const void *sendBuffer, void *recvBuffer,
+                                vtkIdType sendLength, vtkIdType *recvLengths,
+                                vtkIdType *offsets, int type,
+                                int destProcessId, CollectiveRequest &req);
+  virtual int IReduceVoidArray(const void *sendBuffer, void *recvBuffer,
+                               vtkIdType length, int type, int operation,
+                               int destProcessId, CollectiveRequest &req);
+  virtual int IAllReduceVoidArray(const void *sendBuffer, void *recvBuffer,
+                                  vtkIdType length, int type, int operation,
+                                  CollectiveRequest &req);
+//ETX
+
   static void SetUseCopy(int useCopy);
 
 //BTX
@@ -1341,6 +1924,17 @@ protected:
   int ReceiveMultiBlockDataSet(
     vtkMultiBlockDataSet* data, int remoteHandle, int tag);
 
+  // Description:
+  // Datasets made only of vtkDataArrays (vtkPolyData, vtkUnstructuredGrid,
+  // vtkImageData, vtkStructuredGrid and vtkRectilinearGrid) are sent by
+  // SendElementalDataObject() as a stream describing their structure and
+  // arrays, followed by the buffer of each array as is. The receiving side
+  // allocates the arrays from the stream and receives directly into them,
+  // so neither side copies or formats the data.
+  static bool CanSendBinaryDataObject(vtkDataObject* data);
+  int SendBinaryDataObject(vtkDataObject* data, int remoteHandle, int tag);
+  int ReceiveBinaryDataObject(vtkDataObject* data, int remoteHandle, int tag);
+
   int MaximumNumberOfProcesses;
   int NumberOfProcesses;
 
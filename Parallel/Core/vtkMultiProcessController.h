@@ -1088,6 +1088,111 @@ public:
     return this->Communicator->AllGatherV(sendBuffer, recvBuffer);
   }
 
+  // Description:
+  // Send a different part of sendBuffer to each process and receive a part
+  // from each process, see vtkCommunicator::AllToAllV.
+  int AllToAllV(const int* sendBuffer, int* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+  int AllToAllV(const unsigned int* sendBuffer, unsigned int* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+  int AllToAllV(const short* sendBuffer, short* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+  int AllToAllV(const unsigned short* sendBuffer, unsigned short* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+  int AllToAllV(const long* sendBuffer, long* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+  int AllToAllV(const unsigned long* sendBuffer, unsigned long* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+  int AllToAllV(const unsigned char* sendBuffer, unsigned char* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+  int AllToAllV(const char* sendBuffer, char* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+  int AllToAllV(const signed char* sendBuffer, signed char* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+  int AllToAllV(const float* sendBuffer, float* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+  int AllToAllV(const double* sendBuffer, double* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int AllToAllV(const vtkIdType* sendBuffer, vtkIdType* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+#else
+  int AllToAllV(const long long* sendBuffer, long long* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+#endif
+  int AllToAllV(const unsigned long long* sendBuffer, unsigned long long* recvBuffer,
+                vtkIdType* sendLengths, vtkIdType* sendOffsets,
+                vtkIdType* recvLengths, vtkIdType* recvOffsets) {
+    return this->Communicator->AllToAllV(sendBuffer, recvBuffer,
+                                         sendLengths, sendOffsets,
+                                         recvLengths, recvOffsets);
+  }
+
   // Description:
   // Reduce an array to the given destination process.  This version of Reduce
   // takes an identifier defined in the
@@ -1426,6 +1531,357 @@ public:
                 vtkCommunicator::Operation *operation) {
     return this->Communicator->AllReduce(sendBuffer, recvBuffer, operation);
   }
+
+  // Description:
+  // Nonblocking collectives, see vtkCommunicator::CollectiveRequest.
+  int IBroadcast(int *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+  int IBroadcast(unsigned int *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+  int IBroadcast(short *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+  int IBroadcast(unsigned short *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+  int IBroadcast(long *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+  int IBroadcast(unsigned long *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+  int IBroadcast(unsigned char *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+  int IBroadcast(char *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+  int IBroadcast(signed char *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+  int IBroadcast(float *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+  int IBroadcast(double *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int IBroadcast(vtkIdType *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+#else
+  int IBroadcast(long long *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+#endif
+  int IBroadcast(unsigned long long *data, vtkIdType length, int srcProcessId,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IBroadcast(data, length, srcProcessId, req);
+  }
+  int IGatherV(const int *sendBuffer, int *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+  int IGatherV(const unsigned int *sendBuffer, unsigned int *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+  int IGatherV(const short *sendBuffer, short *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+  int IGatherV(const unsigned short *sendBuffer, unsigned short *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+  int IGatherV(const long *sendBuffer, long *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+  int IGatherV(const unsigned long *sendBuffer, unsigned long *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+  int IGatherV(const unsigned char *sendBuffer, unsigned char *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+  int IGatherV(const char *sendBuffer, char *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+  int IGatherV(const signed char *sendBuffer, signed char *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+  int IGatherV(const float *sendBuffer, float *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+  int IGatherV(const double *sendBuffer, double *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int IGatherV(const vtkIdType *sendBuffer, vtkIdType *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+#else
+  int IGatherV(const long long *sendBuffer, long long *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+#endif
+  int IGatherV(const unsigned long long *sendBuffer, unsigned long long *recvBuffer,
+               vtkIdType sendLength, vtkIdType *recvLengths,
+               vtkIdType *offsets, int destProcessId,
+               vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IGatherV(sendBuffer, recvBuffer, sendLength,
+                                        recvLengths, offsets,
+                                        destProcessId, req);
+  }
+  int IReduce(const int *sendBuffer, int *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+  int IReduce(const unsigned int *sendBuffer, unsigned int *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+  int IReduce(const short *sendBuffer, short *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+  int IReduce(const unsigned short *sendBuffer, unsigned short *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+  int IReduce(const long *sendBuffer, long *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+  int IReduce(const unsigned long *sendBuffer, unsigned long *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+  int IReduce(const unsigned char *sendBuffer, unsigned char *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+  int IReduce(const char *sendBuffer, char *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+  int IReduce(const signed char *sendBuffer, signed char *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+  int IReduce(const float *sendBuffer, float *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+  int IReduce(const double *sendBuffer, double *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int IReduce(const vtkIdType *sendBuffer, vtkIdType *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+#else
+  int IReduce(const long long *sendBuffer, long long *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+#endif
+  int IReduce(const unsigned long long *sendBuffer, unsigned long long *recvBuffer,
+              vtkIdType length, int operation, int destProcessId,
+              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IReduce(sendBuffer, recvBuffer, length,
+                                       operation, destProcessId, req);
+  }
+  int IAllReduce(const int *sendBuffer, int *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
+  int IAllReduce(const unsigned int *sendBuffer, unsigned int *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
+  int IAllReduce(const short *sendBuffer, short *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
+  int IAllReduce(const unsigned short *sendBuffer, unsigned short *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
+  int IAllReduce(const long *sendBuffer, long *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
+  int IAllReduce(const unsigned long *sendBuffer, unsigned long *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
+  int IAllReduce(const unsigned char *sendBuffer, unsigned char *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
+  int IAllReduce(const char *sendBuffer, char *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
+  int IAllReduce(const signed char *sendBuffer, signed char *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
+  int IAllReduce(const float *sendBuffer, float *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
+  int IAllReduce(const double *sendBuffer, double *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int IAllReduce(const vtkIdType *sendBuffer, vtkIdType *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
+#else
+  int IAllReduce(const long long *sendBuffer, long long *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
+#endif
+  int IAllReduce(const unsigned long long *sendBuffer, unsigned long long *recvBuffer,
+                 vtkIdType length, int operation,
+                 vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->IAllReduce(sendBuffer, recvBuffer, length,
+                                          operation, req);
+  }
 //ETX
 
 // Internally implemented RMI to break the process loop.
@@ -16,6 +16,7 @@
 
 #include "vtkClientSocket.h"
 #include "vtkCommand.h"
+#include "vtkDataCompressor.h"
 #include "vtkObjectFactory.h"
 #include "vtkServerSocket.h"
 #include "vtkSocketController.h"
@@ -95,6 +96,7 @@ public:
 
 vtkStandardNewMacro(vtkSocketCommunicator);
 vtkCxxSetObjectMacro(vtkSocketCommunicator, Socket, vtkClientSocket);
+vtkCxxSetObjectMacro(vtkSocketCommunicator, Compressor, vtkDataCompressor);
 //----------------------------------------------------------------------------
 vtkSocketCommunicator::vtkSocketCommunicator()
 {
@@ -108,6 +110,13 @@ vtkSocketCommunicator::vtkSocketCommunicator()
   this->LogFile = 0;
   this->TagMessageLength = 0;
   this->BufferMessage = false;
+  this->CompressedMessage = false;
+
+  this->Compressor = 0;
+  this->CompressionThreshold = 65536;
+  this->CompressionChunkSize = 1 << 20;
+  this->SendBufferSize = 0;
+  this->ReceiveBufferSize = 0;
 
   this->ReportErrors = 1;
   this->ReceivedMessageBuffer = new vtkSocketCommunicator::vtkMessageBuffer();
@@ -117,6 +126,7 @@ vtkSocketCommunicator::vtkSocketCommunicator()
 vtkSocketCommunicator::~vtkSocketCommunicator()
 {
   this->SetSocket(0);
+  this->SetCompressor(0);
   this->SetLogStream(0);
   delete this->ReceivedMessageBuffer;
   this->ReceivedMessageBuffer = 0;
@@ -161,6 +171,20 @@ void vtkSocketCommunicator::PrintSelf(ostream& os, vtkIndent indent)
      << ( this->PerformHandshake ? "Yes" : "No" ) << endl;
 
   os << indent << "ReportErrors: " << this->ReportErrors << endl;
+  os << indent << "Compressor: ";
+  if (this->Compressor)
+    {
+    os << endl;
+    this->Compressor->PrintSelf(os, indent.GetNextIndent());
+    }
+  else
+    {
+    os << "(none)" << endl;
+    }
+  os << indent << "CompressionThreshold: " << this->CompressionThreshold << endl;
+  os << indent << "CompressionChunkSize: " << this->CompressionChunkSize << endl;
+  os << indent << "SendBufferSize: " << this->SendBufferSize << endl;
+  os << indent << "ReceiveBufferSize: " << this->ReceiveBufferSize << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -683,6 +707,7 @@ int vtkSocketCommunicator::WaitForConnection(vtkServerSocket* socket,
     {
     return 0;
     }
+  this->ConfigureSocket();
   return this->ServerSideHandshake();
 }
 
@@ -717,11 +742,25 @@ int vtkSocketCommunicator::ConnectTo (const char* hostName, int port )
     }
   this->SetSocket(tmp);
   tmp->Delete();
+  this->ConfigureSocket();
 
   vtkDebugMacro("Connected to " << hostName << " on port " << port);
   return this->ClientSideHandshake();
 }
 
+//----------------------------------------------------------------------------
+void vtkSocketCommunicator::ConfigureSocket()
+{
+  if (this->SendBufferSize > 0)
+    {
+    this->Socket->SetSendBufferSize(this->SendBufferSize);
+    }
+  if (this->ReceiveBufferSize > 0)
+    {
+    this->Socket->SetReceiveBufferSize(this->ReceiveBufferSize);
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkSocketCommunicator::SendTagged(const void* data, int wordSize,
                                       int numWords, int tag,
@@ -733,14 +772,26 @@ int vtkSocketCommunicator::SendTagged(const void* data, int wordSize,
     return 0;
     }
   int length = wordSize * numWords;
-  if(!this->Socket->Send(&length,
+  // A compressed message is flagged by a negative length.
+  bool compress = (this->Compressor && length > 0 &&
+                   length >= this->CompressionThreshold);
+  int header = compress ? -1 - length : length;
+  if(!this->Socket->Send(&header,
       static_cast<int>(sizeof(int))))
     {
     vtkSocketCommunicatorErrorMacro("Could not send length.");
     return 0;
     }
+  if (compress)
+    {
+    if (!this->SendCompressed(data, length))
+      {
+      vtkSocketCommunicatorErrorMacro("Could not send message.");
+      return 0;
+      }
+    }
   // Only do the actual send if there is some data in the message.
-  if (length > 0)
+  else if (length > 0)
     {
     if(!this->Socket->Send(data, length))
       {
@@ -755,6 +806,96 @@ int vtkSocketCommunicator::SendTagged(const void* data, int wordSize,
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Each chunk is sent as its uncompressed size and its compressed size,
+// followed by the compressed bytes. A compressed size of 0 means the chunk
+// did not compress and is sent as is.
+int vtkSocketCommunicator::SendCompressed(const void* data, int length)
+{
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+  int chunkSize = std::min(this->CompressionChunkSize, length);
+  std::vector<unsigned char> buffer(
+    this->Compressor->GetMaximumCompressionSpace(chunkSize));
+  for (int offset = 0; offset < length; offset += chunkSize)
+    {
+    chunkSize = std::min(this->CompressionChunkSize, length - offset);
+    size_t packedSize = this->Compressor->Compress(
+      bytes + offset, chunkSize, &buffer[0], buffer.size());
+    int chunkHeader[2] = { chunkSize, 0 };
+    if (packedSize > 0 && packedSize < static_cast<size_t>(chunkSize))
+      {
+      chunkHeader[1] = static_cast<int>(packedSize);
+      }
+    if (!this->Socket->Send(chunkHeader, static_cast<int>(sizeof(chunkHeader))))
+      {
+      return 0;
+      }
+    if (chunkHeader[1] > 0 ?
+        !this->Socket->Send(&buffer[0], chunkHeader[1]) :
+        !this->Socket->Send(bytes + offset, chunkSize))
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkSocketCommunicator::ReceiveCompressed(void* data, int length)
+{
+  unsigned char* bytes = reinterpret_cast<unsigned char*>(data);
+  std::vector<unsigned char> buffer;
+  for (int offset = 0; offset < length; )
+    {
+    int chunkHeader[2];
+    if (!this->Socket->Receive(chunkHeader,
+        static_cast<int>(sizeof(chunkHeader))))
+      {
+      return 0;
+      }
+    if (this->SwapBytesInReceivedData == vtkSocketCommunicator::SwapOn)
+      {
+      vtkSwap4(reinterpret_cast<char*>(&chunkHeader[0]));
+      vtkSwap4(reinterpret_cast<char*>(&chunkHeader[1]));
+      }
+    int chunkSize = chunkHeader[0];
+    int packedSize = chunkHeader[1];
+    if (chunkSize <= 0 || chunkSize > length - offset || packedSize < 0)
+      {
+      vtkSocketCommunicatorErrorMacro("Corrupted compressed message.");
+      return 0;
+      }
+    if (packedSize == 0)
+      {
+      if (!this->Socket->Receive(bytes + offset, chunkSize))
+        {
+        return 0;
+        }
+      }
+    else
+      {
+      if (!this->Compressor)
+        {
+        vtkSocketCommunicatorErrorMacro(
+          "Received a compressed message but no compressor is set.");
+        return 0;
+        }
+      if (static_cast<int>(buffer.size()) < packedSize)
+        {
+        buffer.resize(packedSize);
+        }
+      if (!this->Socket->Receive(&buffer[0], packedSize) ||
+          this->Compressor->Uncompress(&buffer[0], packedSize,
+            bytes + offset, chunkSize) != static_cast<size_t>(chunkSize))
+        {
+        return 0;
+        }
+      }
+    offset += chunkSize;
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkSocketCommunicator::ReceivedTaggedFromBuffer(
   void* data, int wordSize, int numWords, int tag, const char* logName)
@@ -804,6 +945,7 @@ int vtkSocketCommunicator::ReceiveTagged(void* data, int wordSize,
     {
     int recvTag = -1;
     length = -1;
+    this->CompressedMessage = false;
     if (!this->Socket->Receive(&recvTag, static_cast<int>(sizeof(int))))
       {
       vtkSocketCommunicatorErrorMacro("Could not receive tag. " << tag);
@@ -836,6 +978,11 @@ int vtkSocketCommunicator::ReceiveTagged(void* data, int wordSize,
         length = numWords* wordSize;
         }
       }
+    if (length < 0)
+      {
+      this->CompressedMessage = true;
+      length = -1 - length;
+      }
     if(recvTag != tag)
       {
       // There's a tag mismatch, call the error handler. If the error handler
@@ -901,7 +1048,11 @@ int vtkSocketCommunicator::ReceivePartialTagged(void* data, int wordSize,
   // Only do the actual receive if there is some data to receive
   if (wordSize*numWords > 0)
     {
-    if(!this->Socket->Receive(data, wordSize*numWords))
+    int received = this->CompressedMessage ?
+      this->ReceiveCompressed(data, wordSize*numWords) :
+      this->Socket->Receive(data, wordSize*numWords);
+    this->CompressedMessage = false;
+    if(!received)
       {
       vtkSocketCommunicatorErrorMacro("Could not receive message.");
       return 0;
@@ -18,6 +18,14 @@
 // interprocess communication using BSD style sockets.
 // It supports byte swapping for the communication of  machines
 // with different endianness.
+//
+// When a Compressor is set, messages larger than CompressionThreshold are
+// compressed in chunks of CompressionChunkSize bytes; each chunk is sent as
+// soon as it is compressed, so that the transmission of a chunk overlaps the
+// compression of the next one, and the receiver uncompresses a chunk while
+// the next one arrives. This helps on slow links, such as when images are
+// delivered by vtkClientServerSynchronizedRenderers. Both sides must use the
+// same type of compressor, since the receiver uncompresses with its own.
 
 // .SECTION Caveats
 // Communication between 32 bit and 64 bit systems is not fully
@@ -49,6 +57,7 @@
 #endif
 
 class vtkClientSocket;
+class vtkDataCompressor;
 class vtkServerSocket;
 
 class VTKPARALLELCORE_EXPORT vtkSocketCommunicator : public vtkCommunicator
@@ -164,6 +173,35 @@ public:
   vtkSetMacro(ReportErrors, int);
   vtkGetMacro(ReportErrors, int);
 
+  // Description:
+  // Set/Get the compressor used to compress large messages, for example a
+  // vtkLZ4DataCompressor. No compression is done when it is NULL, which is
+  // the default. Received messages are uncompressed with the same object.
+  void SetCompressor(vtkDataCompressor*);
+  vtkGetObjectMacro(Compressor, vtkDataCompressor);
+
+  // Description:
+  // Messages shorter than this number of bytes are never compressed.
+  // Initial value is 65536.
+  vtkSetClampMacro(CompressionThreshold, int, 0, VTK_INT_MAX);
+  vtkGetMacro(CompressionThreshold, int);
+
+  // Description:
+  // Size in bytes of the chunks in which large messages are compressed and
+  // sent. Initial value is 1 MiB.
+  vtkSetClampMacro(CompressionChunkSize, int, 1024, 1 << 30);
+  vtkGetMacro(CompressionChunkSize, int);
+
+  // Description:
+  // Size in bytes of the kernel send and receive buffers of the socket,
+  // applied when a connection is made. Buffers larger than the system
+  // default keep more data in flight on links with a large
+  // bandwidth-delay product. 0, the default, keeps the system value.
+  vtkSetClampMacro(SendBufferSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(SendBufferSize, int);
+  vtkSetClampMacro(ReceiveBufferSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(ReceiveBufferSize, int);
+
   // Description:
   // Get/Set the actual socket used for communication.
   vtkGetObjectMacro(Socket, vtkClientSocket);
@@ -221,6 +259,12 @@ protected:
 
   int ReportErrors;
 
+  vtkDataCompressor* Compressor;
+  int CompressionThreshold;
+  int CompressionChunkSize;
+  int SendBufferSize;
+  int ReceiveBufferSize;
+
   ofstream* LogFile;
   ostream* LogStream;
 
@@ -236,6 +280,14 @@ protected:
   int ReceivePartialTagged(void* data, int wordSize, int numWords, int tag,
                     const char* logName);
 
+  // Send/receive the body of a message of length bytes in compressed
+  // chunks. Return 1 for success, and 0 for failure.
+  int SendCompressed(const void* data, int length);
+  int ReceiveCompressed(void* data, int length);
+
+  // Apply SendBufferSize and ReceiveBufferSize to the socket.
+  void ConfigureSocket();
+
   int ReceivedTaggedFromBuffer(
     void* data, int wordSize, int numWords, int tag, const char* logName);
 
@@ -266,6 +318,9 @@ private:
   // enough since we split messages > VTK_INT_MAX.
   int TagMessageLength;
 
+  // Set by ReceiveTagged when the message being received was compressed.
+  bool CompressedMessage;
+
   //  Buffer to save messages received with different tag than requested.
   class vtkMessageBuffer;
   vtkMessageBuffer* ReceivedMessageBuffer;
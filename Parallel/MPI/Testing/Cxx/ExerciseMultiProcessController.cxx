@@ -35,6 +35,7 @@
 #include "vtkTypeTraits.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedLongArray.h"
+#include "vtkUnstructuredGrid.h"
 
 #include <string.h>
 #include <time.h>
@@ -308,6 +309,22 @@ static int CompareDataObjects(vtkDataObject *obj1, vtkDataObject *obj2)
       if (!CompareDataArrays(pd1->GetStrips()->GetData(),
                              pd2->GetStrips()->GetData())) return 0;
       }
+
+    vtkUnstructuredGrid *ug1 = vtkUnstructuredGrid::SafeDownCast(ps1);
+    vtkUnstructuredGrid *ug2 = vtkUnstructuredGrid::SafeDownCast(ps2);
+    if (ug1 && ug2)
+      {
+      if (!CompareDataArrays(ug1->GetCells()->GetData(),
+                             ug2->GetCells()->GetData())) return 0;
+      for (vtkIdType i = 0; i < ug1->GetNumberOfCells(); i++)
+        {
+        if (ug1->GetCellType(i) != ug2->GetCellType(i))
+          {
+          vtkGenericWarningMacro("Cell types do not agree.");
+          return 0;
+          }
+        }
+      }
     }
 
   return 1;
@@ -1071,6 +1088,52 @@ static void ExerciseDataObject(vtkMultiProcessController *controller,
   CheckSuccess(controller, result);
 }
 
+//-----------------------------------------------------------------------------
+// Make a grid of hexahedra, with a tetrahedron if mixed is true. Otherwise
+// the grid uses the single cell type storage.
+static vtkSmartPointer<vtkUnstructuredGrid> MakeUnstructuredGrid(bool mixed)
+{
+  VTK_CREATE(vtkPoints, points);
+  for (int k = 0; k < 2; k++)
+    {
+    for (int j = 0; j < 2; j++)
+      {
+      for (int i = 0; i < 4; i++)
+        {
+        points->InsertNextPoint(i, j, k);
+        }
+      }
+    }
+  VTK_CREATE(vtkUnstructuredGrid, grid);
+  grid->SetPoints(points);
+  if (mixed)
+    {
+    grid->Allocate(4);
+    }
+  else
+    {
+    grid->AllocateSingleCellType(VTK_HEXAHEDRON, 8, 3);
+    }
+  for (vtkIdType i = 0; i < 3; i++)
+    {
+    vtkIdType hex[8] = { i, i+1, i+5, i+4, i+8, i+9, i+13, i+12 };
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+    }
+  if (mixed)
+    {
+    vtkIdType tet[4] = { 0, 1, 4, 8 };
+    grid->InsertNextCell(VTK_TETRA, 4, tet);
+    }
+  VTK_CREATE(vtkFloatArray, scalars);
+  scalars->SetName("CellIndex");
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); i++)
+    {
+    scalars->InsertNextValue(static_cast<float>(i));
+    }
+  grid->GetCellData()->SetScalars(scalars);
+  return grid;
+}
+
 //-----------------------------------------------------------------------------
 static void Run(vtkMultiProcessController *controller, void *_args)
 {
@@ -1101,6 +1164,11 @@ static void Run(vtkMultiProcessController *controller, void *_args)
     polySource->Update();
     ExerciseDataObject(controller, polySource->GetOutput(),
                        vtkSmartPointer<vtkPolyData>::New());
+
+    ExerciseDataObject(controller, MakeUnstructuredGrid(false),
+                       vtkSmartPointer<vtkUnstructuredGrid>::New());
+    ExerciseDataObject(controller, MakeUnstructuredGrid(true),
+                       vtkSmartPointer<vtkUnstructuredGrid>::New());
     }
   catch (ExerciseMultiProcessControllerError)
     {
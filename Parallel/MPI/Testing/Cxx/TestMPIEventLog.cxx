@@ -0,0 +1,99 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMPIEventLog.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME TestMPIEventLog.cxx -- Tests the merged trace of vtkMPIEventLog.
+//
+// .SECTION Description
+//  Every process logs an event and takes part in a reduction. The trace
+//  written by the root must contain the events and the communications of
+//  all the processes.
+
+#include "vtkMPIController.h"
+#include "vtkMPIEventLog.h"
+#include "vtkNew.h"
+#include "vtkTestUtilities.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+//------------------------------------------------------------------------------
+int TestMPIEventLog(int argc, char *argv[])
+{
+  vtkMPIController *controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv, 0);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int numProcs = controller->GetNumberOfProcesses();
+  int rank = controller->GetLocalProcessId();
+
+  char *tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/TestMPIEventLog.json";
+  delete [] tempDir;
+
+  vtkMPIEventLog::InitializeLogging();
+
+  vtkNew<vtkMPIEventLog> log;
+  log->SetDescription("work", "test");
+  log->StartLogging();
+  double sum = 0.0;
+  for (int i = 0; i < 100000; ++i)
+    {
+    sum += static_cast<double>(i % (rank + 2));
+    }
+  double total = 0.0;
+  controller->AllReduce(&sum, &total, 1, vtkCommunicator::SUM_OP);
+  log->StopLogging();
+
+  vtkMPIEventLog::FinalizeLogging(fileName.c_str());
+
+  int retVal = 1;
+  if (rank == 0)
+    {
+    std::ifstream file(fileName.c_str());
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::string trace = contents.str();
+    const char *expected[] =
+      { "\"traceEvents\"", "\"work\"", "\"MPI_Allreduce\"", "\"bytes\":" };
+    for (int i = 0; i < 4; ++i)
+      {
+      if (trace.find(expected[i]) == std::string::npos)
+        {
+        cerr << "The trace does not contain " << expected[i] << endl;
+        retVal = 0;
+        }
+      }
+    for (int r = 0; r < numProcs; ++r)
+      {
+      std::ostringstream processName;
+      processName << "\"rank " << r << "\"";
+      if (trace.find(processName.str()) == std::string::npos)
+        {
+        cerr << "The trace has no events of process " << r << endl;
+        retVal = 0;
+        }
+      }
+    }
+
+  int allPassed = 0;
+  controller->AllReduce(&retVal, &allPassed, 1, vtkCommunicator::MIN_OP);
+
+  vtkMultiProcessController::SetGlobalController(NULL);
+  controller->Finalize();
+  controller->Delete();
+
+  return allPassed ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMPIThreadControllers.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME TestMPIThreadControllers.cxx -- Tests the thread controllers of
+// vtkMPIController.
+//
+// .SECTION Description
+//  MPI is initialized with the highest thread level. Every thread
+//  controller starts the exchange of a message with the same tag around a
+//  ring, from several threads when MPI allows it, and reduces a value.
+//  Each controller must only receive its own messages.
+
+#include "vtkMPIController.h"
+#include "vtkSMPTools.h"
+
+namespace
+{
+const int NumberOfControllers = 4;
+
+// Posts the ring exchange of every thread controller. The functor does not
+// wait for the messages: a thread blocked on one controller could wait for
+// a remote thread that is busy with another one.
+class RingFunctor
+{
+public:
+  vtkMPIController *Controller;
+  int *Sent;
+  int *Received;
+  vtkMPICommunicator::Request (*Requests)[2];
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkMPIController *controller =
+        this->Controller->GetThreadController(static_cast<int>(i));
+      int numProcs = controller->GetNumberOfProcesses();
+      int rank = controller->GetLocalProcessId();
+      int next = (rank + 1) % numProcs;
+      int previous = (rank + numProcs - 1) % numProcs;
+
+      this->Sent[i] = 1000 * static_cast<int>(i) + rank;
+      controller->NoBlockReceive(&this->Received[i], 1, previous, 33,
+                                 this->Requests[i][0]);
+      controller->NoBlockSend(&this->Sent[i], 1, next, 33,
+                              this->Requests[i][1]);
+      }
+  }
+};
+}
+
+//------------------------------------------------------------------------------
+int TestMPIThreadControllers(int argc, char *argv[])
+{
+  vtkMPIController *controller = vtkMPIController::New();
+  controller->InitializeThreaded(&argc, &argv,
+                                 vtkMPIController::THREAD_MULTIPLE);
+
+  int rank = controller->GetLocalProcessId();
+  int level = vtkMPIController::GetProvidedThreadLevel();
+  if (rank == 0)
+    {
+    cout << "Provided thread level: " << level << endl;
+    }
+
+  int retVal = 1;
+  if (!controller->CreateThreadControllers(NumberOfControllers) ||
+      controller->GetNumberOfThreadControllers() != NumberOfControllers ||
+      controller->GetThreadController(NumberOfControllers) != NULL)
+    {
+    cerr << "Could not create the thread controllers on process " << rank
+         << endl;
+    retVal = 0;
+    }
+  else
+    {
+    int sent[NumberOfControllers];
+    int received[NumberOfControllers];
+    vtkMPICommunicator::Request requests[NumberOfControllers][2];
+    RingFunctor functor;
+    functor.Controller = controller;
+    functor.Sent = sent;
+    functor.Received = received;
+    functor.Requests = requests;
+    if (level == vtkMPIController::THREAD_MULTIPLE)
+      {
+      vtkSMPTools::For(0, NumberOfControllers, 1, functor);
+      }
+    else
+      {
+      functor(0, NumberOfControllers);
+      }
+
+    int numProcs = controller->GetNumberOfProcesses();
+    int previous = (rank + numProcs - 1) % numProcs;
+    for (int i = 0; i < NumberOfControllers; ++i)
+      {
+      vtkMPIController *threadController = controller->GetThreadController(i);
+      threadController->WaitAll(2, requests[i]);
+      int one = 1;
+      int sum = 0;
+      threadController->AllReduce(&one, &sum, 1, vtkCommunicator::SUM_OP);
+      if (received[i] != 1000 * i + previous || sum != numProcs)
+        {
+        cerr << "Thread controller " << i << " failed on process " << rank
+             << endl;
+        retVal = 0;
+        }
+      }
+    }
+  controller->ReleaseThreadControllers();
+
+  int allPassed = 0;
+  controller->AllReduce(&retVal, &allPassed, 1, vtkCommunicator::MIN_OP);
+
+  controller->Finalize();
+  controller->Delete();
+
+  return allPassed ? 0 : 1;
+}
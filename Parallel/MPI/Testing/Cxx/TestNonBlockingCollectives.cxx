@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestNonBlockingCollectives.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME TestNonBlockingCollectives.cxx -- Tests non-blocking collectives.
+//
+// .SECTION Description
+//  This test starts a broadcast, a gather, a reduction and an all-reduction
+//  at once on every process, waits for all of them and checks their
+//  results.
+
+#include "vtkMPIController.h"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+int TestNonBlockingCollectives( int argc, char *argv[] )
+{
+  vtkMPIController *controller = vtkMPIController::New();
+  controller->Initialize( &argc, &argv, 0 );
+
+  int numProcs = controller->GetNumberOfProcesses();
+  int rank = controller->GetLocalProcessId();
+
+  // The root broadcasts 4 values.
+  int broadcast[4] = { 0, 0, 0, 0 };
+  if( rank == 0 )
+    {
+    for( int i=0; i < 4; ++i )
+      {
+      broadcast[ i ] = 10 + i;
+      }
+    }
+
+  // Process i sends i+1 values to the root.
+  std::vector<double> sendValues( rank+1, rank );
+  std::vector<vtkIdType> lengths( numProcs );
+  std::vector<vtkIdType> offsets( numProcs );
+  vtkIdType total = 0;
+  for( int i=0; i < numProcs; ++i )
+    {
+    lengths[ i ] = i + 1;
+    offsets[ i ] = total;
+    total += lengths[ i ];
+    }
+  std::vector<double> gathered( total, -1.0 );
+
+  vtkIdType value = rank + 1;
+  vtkIdType sum = 0;
+  vtkIdType max = 0;
+
+  vtkCommunicator::CollectiveRequest requests[4];
+  int retVal = 1;
+  retVal &= controller->IBroadcast( broadcast, 4, 0, requests[0] );
+  retVal &= controller->IGatherV( &sendValues[0], &gathered[0], rank+1,
+                                  &lengths[0], &offsets[0], 0, requests[1] );
+  retVal &= controller->IReduce( &value, &max, 1, vtkCommunicator::MAX_OP, 0,
+                                 requests[2] );
+  retVal &= controller->IAllReduce( &value, &sum, 1, vtkCommunicator::SUM_OP,
+                                    requests[3] );
+  retVal &= vtkCommunicator::WaitAll( 4, requests );
+  if( !retVal )
+    {
+    cerr << "A collective failed on process " << rank << endl;
+    }
+
+  for( int i=0; i < 4; ++i )
+    {
+    if( broadcast[ i ] != 10 + i )
+      {
+      cerr << "Wrong broadcast value on process " << rank << endl;
+      retVal = 0;
+      }
+    }
+
+  if( sum != numProcs*(numProcs+1)/2 )
+    {
+    cerr << "Wrong sum " << sum << " on process " << rank << endl;
+    retVal = 0;
+    }
+
+  if( rank == 0 )
+    {
+    if( max != numProcs )
+      {
+      cerr << "Wrong maximum " << max << endl;
+      retVal = 0;
+      }
+    for( int i=0; i < numProcs; ++i )
+      {
+      for( vtkIdType j=0; j < lengths[ i ]; ++j )
+        {
+        if( gathered[ offsets[ i ] + j ] != i )
+          {
+          cerr << "Wrong value gathered from process " << i << endl;
+          retVal = 0;
+          }
+        }
+      }
+    }
+
+  // A request completes once.
+  if( !requests[0].Test() || !requests[0].Wait() )
+    {
+    cerr << "A completed request is still pending" << endl;
+    retVal = 0;
+    }
+
+  int allPassed = 0;
+  controller->AllReduce( &retVal, &allPassed, 1, vtkCommunicator::MIN_OP );
+
+  controller->Finalize();
+  controller->Delete();
+
+  return allPassed ? 0 : 1;
+}
@@ -16,6 +16,7 @@
 #include "vtkMPICommunicator.h"
 
 #include "vtkImageData.h"
+#include "vtkExecutionProfiler.h"
 #include "vtkMPIController.h"
 //#include "vtkMPIGroup.h"
 #include "vtkProcessGroup.h"
@@ -41,6 +42,55 @@ static inline void  vtkMPICommunicatorDebugBarrier(MPI_Comm* handle)
 #endif
 }
 
+//----------------------------------------------------------------------------
+// Records a communication in the vtkExecutionProfiler that is recording, if
+// any, from its construction to its destruction, with the number of bytes
+// sent (or received) and the peer or root process.
+class vtkMPICommunicatorTrace
+{
+public:
+  vtkMPICommunicatorTrace(const char* name, vtkIdType bytes = -1,
+                          const char* peerName = 0, int peer = -1)
+    : Event(-1)
+  {
+    this->Profiler = vtkExecutionProfiler::GetActiveProfiler();
+    if (this->Profiler)
+      {
+      this->Event = this->Profiler->BeginEvent(name, "mpi");
+      if (bytes >= 0)
+        {
+        this->AddArgument("bytes", bytes);
+        }
+      if (peerName)
+        {
+        this->AddArgument(peerName, peer);
+        }
+      }
+  }
+  ~vtkMPICommunicatorTrace()
+  {
+    if (this->Profiler)
+      {
+      this->Profiler->EndEvent(this->Event);
+      }
+  }
+  void AddArgument(const char* name, vtkIdType value)
+  {
+    if (this->Profiler)
+      {
+      this->Profiler->AddEventArgument(this->Event, name, value);
+      }
+  }
+  static vtkIdType Bytes(int type, vtkIdType length)
+  {
+    return length * vtkAbstractArray::GetDataTypeSize(type);
+  }
+
+private:
+  vtkExecutionProfiler* Profiler;
+  vtkIdType Event;
+};
+
 vtkStandardNewMacro(vtkMPICommunicator);
 
 vtkMPICommunicator* vtkMPICommunicator::WorldCommunicator = 0;
@@ -284,6 +334,8 @@ int vtkMPICommunicatorNoBlockSendData(const T* data, int length,
                                       vtkMPICommunicator::Request& req,
                                       MPI_Comm *Handle)
 {
+    vtkMPICommunicatorTrace trace("MPI_Isend", length * sizeof(T),
+                                  "peer", remoteProcessId);
     return MPI_Isend(const_cast<T*>(data), length, datatype,
                      remoteProcessId, tag,
                      *(Handle), &req.Req->Handle);
@@ -296,6 +348,8 @@ int vtkMPICommunicatorNoBlockReceiveData(T* data, int length,
                                          vtkMPICommunicator::Request& req,
                                          MPI_Comm *Handle)
 {
+  vtkMPICommunicatorTrace trace("MPI_Irecv", length * sizeof(T),
+                                "peer", remoteProcessId);
   if (remoteProcessId == vtkMultiProcessController::ANY_SOURCE)
     {
     remoteProcessId = MPI_ANY_SOURCE;
@@ -785,6 +839,8 @@ int vtkMPICommunicator::CheckForMPIError(int err)
 int vtkMPICommunicator::SendVoidArray(const void *data, vtkIdType length,
                                       int type, int remoteProcessId, int tag)
 {
+  vtkMPICommunicatorTrace trace("MPI_Send",
+    vtkMPICommunicatorTrace::Bytes(type, length), "peer", remoteProcessId);
   const char *byteData = static_cast<const char *>(data);
   MPI_Datatype mpiType = vtkMPICommunicatorGetMPIType(type);
   int sizeOfType;
@@ -828,6 +884,7 @@ inline vtkIdType vtkMPICommunicatorMin(vtkIdType a, vtkIdType b)
 int vtkMPICommunicator::ReceiveVoidArray(void *data, vtkIdType maxlength, int type,
                                          int remoteProcessId, int tag)
 {
+  vtkMPICommunicatorTrace trace("MPI_Recv");
   this->Count = 0;
   char *byteData = static_cast<char *>(data);
   MPI_Datatype mpiType = vtkMPICommunicatorGetMPIType(type);
@@ -871,6 +928,8 @@ int vtkMPICommunicator::ReceiveVoidArray(void *data, vtkIdType maxlength, int ty
     maxlength -= words_received;
     if (words_received < maxReceive)
       {
+      trace.AddArgument("bytes", this->Count * sizeOfType);
+      trace.AddArgument("peer", this->LastSenderId);
       // words_received in this packet is exactly equal to maxReceive, then it
       // means that the sender is sending atleast one more packet for this
       // message. Otherwise, we have received all the packets for this message
@@ -1118,6 +1177,7 @@ int vtkMPICommunicator::Request::Test()
 //----------------------------------------------------------------------------
 void vtkMPICommunicator::Request::Wait()
 {
+  vtkMPICommunicatorTrace trace("MPI_Wait");
   MPI_Status status;
 
   int err = MPI_Wait(&this->Req->Handle, &status);
@@ -1155,6 +1215,7 @@ void vtkMPICommunicator::Request::Cancel()
 //-----------------------------------------------------------------------------
 void vtkMPICommunicator::Barrier()
 {
+  vtkMPICommunicatorTrace trace("MPI_Barrier");
   CheckForMPIError(MPI_Barrier(*this->MPIComm->Handle));
 }
 
@@ -1162,6 +1223,8 @@ void vtkMPICommunicator::Barrier()
 int vtkMPICommunicator::BroadcastVoidArray(void *data, vtkIdType length,
                                            int type, int root)
 {
+  vtkMPICommunicatorTrace trace("MPI_Bcast",
+    vtkMPICommunicatorTrace::Bytes(type, length), "root", root);
   vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
   if (!vtkMPICommunicatorCheckSize(type, length)) return 0;
   return CheckForMPIError(MPI_Bcast(data, length,
@@ -1175,6 +1238,8 @@ int vtkMPICommunicator::GatherVoidArray(const void *sendBuffer,
                                         vtkIdType length, int type,
                                         int destProcessId)
 {
+  vtkMPICommunicatorTrace trace("MPI_Gather",
+    vtkMPICommunicatorTrace::Bytes(type, length), "root", destProcessId);
   vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
   int numProc;
   MPI_Comm_size(*this->MPIComm->Handle, &numProc);
@@ -1194,6 +1259,8 @@ int vtkMPICommunicator::GatherVVoidArray(const void *sendBuffer,
                                          vtkIdType *offsets, int type,
                                          int destProcessId)
 {
+  vtkMPICommunicatorTrace trace("MPI_Gatherv",
+    vtkMPICommunicatorTrace::Bytes(type, sendLength), "root", destProcessId);
   vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
   if (!vtkMPICommunicatorCheckSize(type, sendLength)) return 0;
   MPI_Datatype mpiType = vtkMPICommunicatorGetMPIType(type);
@@ -1253,6 +1320,8 @@ int vtkMPICommunicator::ScatterVoidArray(const void *sendBuffer,
                                          vtkIdType length, int type,
                                          int srcProcessId)
 {
+  vtkMPICommunicatorTrace trace("MPI_Scatter",
+    vtkMPICommunicatorTrace::Bytes(type, length), "root", srcProcessId);
   vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
   if (!vtkMPICommunicatorCheckSize(type, length)) return 0;
   MPI_Datatype mpiType = vtkMPICommunicatorGetMPIType(type);
@@ -1270,6 +1339,8 @@ int vtkMPICommunicator::ScatterVVoidArray(const void *sendBuffer,
                                           vtkIdType recvLength, int type,
                                           int srcProcessId)
 {
+  vtkMPICommunicatorTrace trace("MPI_Scatterv",
+    vtkMPICommunicatorTrace::Bytes(type, recvLength), "root", srcProcessId);
   vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
   if (!vtkMPICommunicatorCheckSize(type, recvLength)) return 0;
   MPI_Datatype mpiType = vtkMPICommunicatorGetMPIType(type);
@@ -1328,6 +1399,8 @@ int vtkMPICommunicator::AllGatherVoidArray(const void *sendBuffer,
                                            void *recvBuffer,
                                            vtkIdType length, int type)
 {
+  vtkMPICommunicatorTrace trace("MPI_Allgather",
+    vtkMPICommunicatorTrace::Bytes(type, length));
   vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
   int numProc;
   MPI_Comm_size(*this->MPIComm->Handle, &numProc);
@@ -1346,6 +1419,8 @@ int vtkMPICommunicator::AllGatherVVoidArray(const void *sendBuffer,
                                             vtkIdType *recvLengths,
                                             vtkIdType *offsets, int type)
 {
+  vtkMPICommunicatorTrace trace("MPI_Allgatherv",
+    vtkMPICommunicatorTrace::Bytes(type, sendLength));
   vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
   if (!vtkMPICommunicatorCheckSize(type, sendLength)) return 0;
   MPI_Datatype mpiType = vtkMPICommunicatorGetMPIType(type);
@@ -1402,12 +1477,52 @@ int vtkMPICommunicator::AllGatherVVoidArray(const void *sendBuffer,
                                          *this->MPIComm->Handle));
 }
 
+//-----------------------------------------------------------------------------
+int vtkMPICommunicator::AllToAllVVoidArray(const void *sendBuffer,
+                                           void *recvBuffer,
+                                           vtkIdType *sendLengths,
+                                           vtkIdType *sendOffsets,
+                                           vtkIdType *recvLengths,
+                                           vtkIdType *recvOffsets, int type)
+{
+  vtkMPICommunicatorTrace trace("MPI_Alltoallv");
+  vtkIdType sendLength = 0;
+  vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
+  MPI_Datatype mpiType = vtkMPICommunicatorGetMPIType(type);
+  int numProc;
+  MPI_Comm_size(*this->MPIComm->Handle, &numProc);
+  std::vector<int> mpiSendLengths(numProc), mpiSendOffsets(numProc);
+  std::vector<int> mpiRecvLengths(numProc), mpiRecvOffsets(numProc);
+  for (int i = 0; i < numProc; i++)
+    {
+    if (!vtkMPICommunicatorCheckSize(type, sendLengths[i] + sendOffsets[i]) ||
+        !vtkMPICommunicatorCheckSize(type, recvLengths[i] + recvOffsets[i]))
+      {
+      return 0;
+      }
+    mpiSendLengths[i] = sendLengths[i];
+    mpiSendOffsets[i] = sendOffsets[i];
+    mpiRecvLengths[i] = recvLengths[i];
+    mpiRecvOffsets[i] = recvOffsets[i];
+    sendLength += sendLengths[i];
+    }
+  trace.AddArgument("bytes", vtkMPICommunicatorTrace::Bytes(type, sendLength));
+  return CheckForMPIError(MPI_Alltoallv(const_cast<void *>(sendBuffer),
+                                        &mpiSendLengths[0],
+                                        &mpiSendOffsets[0], mpiType,
+                                        recvBuffer, &mpiRecvLengths[0],
+                                        &mpiRecvOffsets[0], mpiType,
+                                        *this->MPIComm->Handle));
+}
+
 //-----------------------------------------------------------------------------
 int vtkMPICommunicator::ReduceVoidArray(const void *sendBuffer,
                                         void *recvBuffer,
                                         vtkIdType length, int type,
                                         int operation, int destProcessId)
 {
+  vtkMPICommunicatorTrace trace("MPI_Reduce",
+    vtkMPICommunicatorTrace::Bytes(type, length), "root", destProcessId);
   vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
   MPI_Op mpiOp;
   switch (operation)
@@ -1438,6 +1553,8 @@ int vtkMPICommunicator::ReduceVoidArray(
                                 vtkIdType length, int type,
                                 Operation *operation, int destProcessId)
 {
+  vtkMPICommunicatorTrace trace("MPI_Reduce",
+    vtkMPICommunicatorTrace::Bytes(type, length), "root", destProcessId);
   vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
   MPI_Op mpiOp;
   MPI_Op_create(vtkMPICommunicatorUserFunction, operation->Commutative(),
@@ -1463,6 +1580,8 @@ int vtkMPICommunicator::AllReduceVoidArray(const void *sendBuffer,
                                            vtkIdType length, int type,
                                            int operation)
 {
+  vtkMPICommunicatorTrace trace("MPI_Allreduce",
+    vtkMPICommunicatorTrace::Bytes(type, length));
   vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
   MPI_Op mpiOp;
   switch (operation)
@@ -1495,6 +1614,8 @@ int vtkMPICommunicator::AllReduceVoidArray(
                                 vtkIdType length, int type,
                                 Operation *operation)
 {
+  vtkMPICommunicatorTrace trace("MPI_Allreduce",
+    vtkMPICommunicatorTrace::Bytes(type, length));
   vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
   MPI_Op mpiOp;
   MPI_Op_create(vtkMPICommunicatorUserFunction, operation->Commutative(),
@@ -1515,9 +1636,217 @@ int vtkMPICommunicator::AllReduceVoidArray(
   return res;
 }
 
+#if MPI_VERSION >= 3
+//-----------------------------------------------------------------------------
+// A nonblocking collective in flight. MPI_Igatherv reads the counts and
+// displacements until it completes, so they are kept with the request.
+class vtkMPICommunicatorPendingCollective
+  : public vtkCommunicator::CollectiveRequest::Pending
+{
+public:
+  vtkMPICommunicatorPendingCollective() : Handle(MPI_REQUEST_NULL) {}
+
+  virtual int Test(int &done)
+  {
+    return this->Check(MPI_Test(&this->Handle, &done, MPI_STATUS_IGNORE));
+  }
+
+  virtual int Wait()
+  {
+    return this->Check(MPI_Wait(&this->Handle, MPI_STATUS_IGNORE));
+  }
+
+  int Check(int err)
+  {
+    if (err == MPI_SUCCESS)
+      {
+      return 1;
+      }
+    char *msg = vtkMPIController::ErrorString(err);
+    vtkGenericWarningMacro("MPI error occurred: " << msg);
+    delete[] msg;
+    return 0;
+  }
+
+  MPI_Request Handle;
+  std::vector<int> Counts;
+  std::vector<int> Offsets;
+};
+
+//-----------------------------------------------------------------------------
+// Hand a collective over to req once it started.
+static int vtkMPICommunicatorStartCollective(
+  int err, vtkMPICommunicatorPendingCollective *pending,
+  vtkCommunicator::CollectiveRequest &req)
+{
+  if (!pending->Check(err))
+    {
+    delete pending;
+    req.Initialize(NULL, 0);
+    return 0;
+    }
+  req.Initialize(pending, 1);
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+static int vtkMPICommunicatorGetMPIOp(int operation, MPI_Op &mpiOp)
+{
+  switch (operation)
+    {
+    case vtkCommunicator::MAX_OP:         mpiOp = MPI_MAX;     break;
+    case vtkCommunicator::MIN_OP:         mpiOp = MPI_MIN;     break;
+    case vtkCommunicator::SUM_OP:         mpiOp = MPI_SUM;     break;
+    case vtkCommunicator::PRODUCT_OP:     mpiOp = MPI_PROD;    break;
+    case vtkCommunicator::LOGICAL_AND_OP: mpiOp = MPI_LAND;    break;
+    case vtkCommunicator::BITWISE_AND_OP: mpiOp = MPI_BAND;    break;
+    case vtkCommunicator::LOGICAL_OR_OP:  mpiOp = MPI_LOR;     break;
+    case vtkCommunicator::BITWISE_OR_OP:  mpiOp = MPI_BOR;     break;
+    case vtkCommunicator::LOGICAL_XOR_OP: mpiOp = MPI_LXOR;    break;
+    case vtkCommunicator::BITWISE_XOR_OP: mpiOp = MPI_BXOR;    break;
+    default:
+      vtkGenericWarningMacro(<< "Operation number " << operation
+                             << " not supported.");
+      return 0;
+    }
+  return 1;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+int vtkMPICommunicator::IBroadcastVoidArray(void *data, vtkIdType length,
+                                            int type, int root,
+                                            CollectiveRequest &req)
+{
+#if MPI_VERSION >= 3
+  if (!vtkMPICommunicatorCheckSize(type, length))
+    {
+    req.Initialize(NULL, 0);
+    return 0;
+    }
+  vtkMPICommunicatorPendingCollective *pending =
+    new vtkMPICommunicatorPendingCollective;
+  return vtkMPICommunicatorStartCollective(
+    MPI_Ibcast(data, length, vtkMPICommunicatorGetMPIType(type), root,
+               *this->MPIComm->Handle, &pending->Handle), pending, req);
+#else
+  return this->Superclass::IBroadcastVoidArray(data, length, type, root, req);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+int vtkMPICommunicator::IGatherVVoidArray(const void *sendBuffer,
+                                          void *recvBuffer,
+                                          vtkIdType sendLength,
+                                          vtkIdType *recvLengths,
+                                          vtkIdType *offsets, int type,
+                                          int destProcessId,
+                                          CollectiveRequest &req)
+{
+#if MPI_VERSION >= 3
+  if (!vtkMPICommunicatorCheckSize(type, sendLength))
+    {
+    req.Initialize(NULL, 0);
+    return 0;
+    }
+  MPI_Datatype mpiType = vtkMPICommunicatorGetMPIType(type);
+  vtkMPICommunicatorPendingCollective *pending =
+    new vtkMPICommunicatorPendingCollective;
+  int rank;
+  MPI_Comm_rank(*this->MPIComm->Handle, &rank);
+  if (rank != destProcessId)
+    {
+    return vtkMPICommunicatorStartCollective(
+      MPI_Igatherv(const_cast<void *>(sendBuffer), sendLength, mpiType,
+                   NULL, NULL, NULL, mpiType, destProcessId,
+                   *this->MPIComm->Handle, &pending->Handle), pending, req);
+    }
+  int numProc;
+  MPI_Comm_size(*this->MPIComm->Handle, &numProc);
+  pending->Counts.resize(numProc);
+  pending->Offsets.resize(numProc);
+  for (int i = 0; i < numProc; i++)
+    {
+    if (!vtkMPICommunicatorCheckSize(type, recvLengths[i] + offsets[i]))
+      {
+      delete pending;
+      req.Initialize(NULL, 0);
+      return 0;
+      }
+    pending->Counts[i] = recvLengths[i];
+    pending->Offsets[i] = offsets[i];
+    }
+  return vtkMPICommunicatorStartCollective(
+    MPI_Igatherv(const_cast<void *>(sendBuffer), sendLength, mpiType,
+                 recvBuffer, &pending->Counts[0], &pending->Offsets[0],
+                 mpiType, destProcessId, *this->MPIComm->Handle,
+                 &pending->Handle), pending, req);
+#else
+  return this->Superclass::IGatherVVoidArray(sendBuffer, recvBuffer,
+                                             sendLength, recvLengths, offsets,
+                                             type, destProcessId, req);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+int vtkMPICommunicator::IReduceVoidArray(const void *sendBuffer,
+                                         void *recvBuffer,
+                                         vtkIdType length, int type,
+                                         int operation, int destProcessId,
+                                         CollectiveRequest &req)
+{
+#if MPI_VERSION >= 3
+  MPI_Op mpiOp;
+  if (!vtkMPICommunicatorGetMPIOp(operation, mpiOp) ||
+      !vtkMPICommunicatorCheckSize(type, length))
+    {
+    req.Initialize(NULL, 0);
+    return 0;
+    }
+  vtkMPICommunicatorPendingCollective *pending =
+    new vtkMPICommunicatorPendingCollective;
+  return vtkMPICommunicatorStartCollective(
+    MPI_Ireduce(const_cast<void *>(sendBuffer), recvBuffer, length,
+                vtkMPICommunicatorGetMPIType(type), mpiOp, destProcessId,
+                *this->MPIComm->Handle, &pending->Handle), pending, req);
+#else
+  return this->Superclass::IReduceVoidArray(sendBuffer, recvBuffer, length,
+                                            type, operation, destProcessId,
+                                            req);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+int vtkMPICommunicator::IAllReduceVoidArray(const void *sendBuffer,
+                                            void *recvBuffer,
+                                            vtkIdType length, int type,
+                                            int operation,
+                                            CollectiveRequest &req)
+{
+#if MPI_VERSION >= 3
+  MPI_Op mpiOp;
+  if (!vtkMPICommunicatorGetMPIOp(operation, mpiOp) ||
+      !vtkMPICommunicatorCheckSize(type, length))
+    {
+    req.Initialize(NULL, 0);
+    return 0;
+    }
+  vtkMPICommunicatorPendingCollective *pending =
+    new vtkMPICommunicatorPendingCollective;
+  return vtkMPICommunicatorStartCollective(
+    MPI_Iallreduce(const_cast<void *>(sendBuffer), recvBuffer, length,
+                   vtkMPICommunicatorGetMPIType(type), mpiOp,
+                   *this->MPIComm->Handle, &pending->Handle), pending, req);
+#else
+  return this->Superclass::IAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                               type, operation, req);
+#endif
+}
+
 //-----------------------------------------------------------------------------
 int vtkMPICommunicator::WaitAll(const int count, Request requests[])
 {
+  vtkMPICommunicatorTrace trace("MPI_Waitall");
   if( count < 1 )
     {
     return -1;
@@ -167,6 +167,11 @@ public:
   virtual int AllGatherVVoidArray(const void *sendBuffer, void *recvBuffer,
                                   vtkIdType sendLength, vtkIdType *recvLengths,
                                   vtkIdType *offsets, int type);
+  virtual int AllToAllVVoidArray(const void *sendBuffer, void *recvBuffer,
+                                 vtkIdType *sendLengths,
+                                 vtkIdType *sendOffsets,
+                                 vtkIdType *recvLengths,
+                                 vtkIdType *recvOffsets, int type);
   virtual int ReduceVoidArray(const void *sendBuffer, void *recvBuffer,
                               vtkIdType length, int type,
                               int operation, int destProcessId);
@@ -180,6 +185,25 @@ public:
                                  vtkIdType length, int type,
                                  Operation *operation);
 
+//BTX
+  // Description:
+  // Nonblocking collectives with MPI_Ibcast, MPI_Igatherv, MPI_Ireduce and
+  // MPI_Iallreduce. With an MPI older than 3.0, the blocking operations are
+  // run instead.
+  virtual int IBroadcastVoidArray(void *data, vtkIdType length, int type,
+                                  int srcProcessId, CollectiveRequest &req);
+  virtual int IGatherVVoidArray(const void *sendBuffer, void *recvBuffer,
+                                vtkIdType sendLength, vtkIdType *recvLengths,
+                                vtkIdType *offsets, int type,
+                                int destProcessId, CollectiveRequest &req);
+  virtual int IReduceVoidArray(const void *sendBuffer, void *recvBuffer,
+                               vtkIdType length, int type, int operation,
+                               int destProcessId, CollectiveRequest &req);
+  virtual int IAllReduceVoidArray(const void *sendBuffer, void *recvBuffer,
+                                  vtkIdType length, int type, int operation,
+                                  CollectiveRequest &req);
+//ETX
+
   // Description:
   // Nonblocking test for a message.  Inputs are: source -- the source rank
   // or ANY_SOURCE; tag -- the tag value.  Outputs are:
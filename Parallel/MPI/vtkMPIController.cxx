@@ -23,6 +23,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkSmartPointer.h"
 
 #include <cassert>
+#include <vector>
 
 #define VTK_CREATE(type, name) \
   vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
@@ -30,6 +31,50 @@ PURPOSE.  See the above copyright notice for more information.
 int vtkMPIController::Initialized = 0;
 char vtkMPIController::ProcessorName[MPI_MAX_PROCESSOR_NAME] = "";
 int vtkMPIController::UseSsendForRMI = 0;
+int vtkMPIController::ProvidedThreadLevel = vtkMPIController::THREAD_SINGLE;
+
+class vtkMPIControllerThreadControllers
+{
+public:
+  std::vector<vtkSmartPointer<vtkMPIController> > Controllers;
+};
+
+namespace
+{
+//----------------------------------------------------------------------------
+int vtkMPIControllerToMPIThreadLevel(int level)
+{
+  switch (level)
+    {
+    case vtkMPIController::THREAD_FUNNELED:
+      return MPI_THREAD_FUNNELED;
+    case vtkMPIController::THREAD_SERIALIZED:
+      return MPI_THREAD_SERIALIZED;
+    case vtkMPIController::THREAD_MULTIPLE:
+      return MPI_THREAD_MULTIPLE;
+    default:
+      return MPI_THREAD_SINGLE;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkMPIControllerFromMPIThreadLevel(int level)
+{
+  if (level == MPI_THREAD_MULTIPLE)
+    {
+    return vtkMPIController::THREAD_MULTIPLE;
+    }
+  if (level == MPI_THREAD_SERIALIZED)
+    {
+    return vtkMPIController::THREAD_SERIALIZED;
+    }
+  if (level == MPI_THREAD_FUNNELED)
+    {
+    return vtkMPIController::THREAD_FUNNELED;
+    }
+  return vtkMPIController::THREAD_SINGLE;
+}
+}
 
 // Output window which prints out the process id
 // with the error or warning messages
@@ -89,11 +134,13 @@ vtkMPIController::vtkMPIController()
     }
 
   this->OutputWindow = 0;
+  this->ThreadControllers = new vtkMPIControllerThreadControllers;
 }
 
 //----------------------------------------------------------------------------
 vtkMPIController::~vtkMPIController()
 {
+  delete this->ThreadControllers;
   this->SetCommunicator(0);
   if (this->RMICommunicator)
     {
@@ -106,6 +153,10 @@ void vtkMPIController::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
   os << indent << "Initialized: " << ( vtkMPIController::Initialized ? "(yes)" : "(no)" ) << endl;
+  os << indent << "ProvidedThreadLevel: "
+     << vtkMPIController::ProvidedThreadLevel << endl;
+  os << indent << "NumberOfThreadControllers: "
+     << this->GetNumberOfThreadControllers() << endl;
 }
 
 vtkMPICommunicator* vtkMPIController::WorldRMICommunicator=0;
@@ -140,6 +191,27 @@ void vtkMPIController::Initialize()
 //----------------------------------------------------------------------------
 void vtkMPIController::Initialize(int* argc, char*** argv,
                                   int initializedExternally)
+{
+  this->InitializeMPI(argc, argv, initializedExternally, -1);
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIController::InitializeThreaded(int* argc, char*** argv,
+                                          int requestedThreadLevel)
+{
+  if (requestedThreadLevel < THREAD_SINGLE ||
+      requestedThreadLevel > THREAD_MULTIPLE)
+    {
+    vtkErrorMacro("Invalid thread level " << requestedThreadLevel << ".");
+    return;
+    }
+  this->InitializeMPI(argc, argv, 0, requestedThreadLevel);
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIController::InitializeMPI(int* argc, char*** argv,
+                                     int initializedExternally,
+                                     int requestedThreadLevel)
 {
   if (vtkMPIController::Initialized)
     {
@@ -149,10 +221,28 @@ void vtkMPIController::Initialize(int* argc, char*** argv,
 
   // Can be done once in the program.
   vtkMPIController::Initialized = 1;
-  if (initializedExternally == 0)
+  int provided = MPI_THREAD_SINGLE;
+  if (initializedExternally == 0 && requestedThreadLevel >= 0)
     {
-    MPI_Init(argc, argv);
+    MPI_Init_thread(argc, argv,
+      vtkMPIControllerToMPIThreadLevel(requestedThreadLevel), &provided);
+    if (provided < vtkMPIControllerToMPIThreadLevel(requestedThreadLevel))
+      {
+      vtkWarningMacro("MPI provides thread level "
+        << vtkMPIControllerFromMPIThreadLevel(provided)
+        << " instead of " << requestedThreadLevel << ".");
+      }
     }
+  else
+    {
+    if (initializedExternally == 0)
+      {
+      MPI_Init(argc, argv);
+      }
+    MPI_Query_thread(&provided);
+    }
+  vtkMPIController::ProvidedThreadLevel =
+    vtkMPIControllerFromMPIThreadLevel(provided);
   this->InitializeCommunicator(vtkMPICommunicator::GetWorldCommunicator());
 
   int tmp;
@@ -184,6 +274,7 @@ void vtkMPIController::Finalize(int finalizedExternally)
 {
   if (vtkMPIController::Initialized)
     {
+    this->ReleaseThreadControllers();
     vtkMPIController::WorldRMICommunicator->Delete();
     vtkMPIController::WorldRMICommunicator = 0;
     vtkMPICommunicator::WorldCommunicator->Delete();
@@ -199,6 +290,7 @@ void vtkMPIController::Finalize(int finalizedExternally)
       MPI_Finalize();
       }
     vtkMPIController::Initialized = 0;
+    vtkMPIController::ProvidedThreadLevel = THREAD_SINGLE;
     this->Modified();
     }
 
@@ -346,6 +438,60 @@ vtkMPIController *vtkMPIController::PartitionController(int localColor,
   return controller;
 }
 
+//-----------------------------------------------------------------------------
+int vtkMPIController::CreateThreadControllers(int count)
+{
+  this->ReleaseThreadControllers();
+  vtkMPICommunicator* comm =
+    vtkMPICommunicator::SafeDownCast(this->Communicator);
+  if (!comm || count < 0)
+    {
+    vtkErrorMacro("Cannot create " << count << " thread controllers.");
+    return 0;
+    }
+  if (vtkMPIController::ProvidedThreadLevel < THREAD_SERIALIZED)
+    {
+    vtkWarningMacro("MPI does not support calls from several threads "
+                    "(thread level " << vtkMPIController::ProvidedThreadLevel
+                    << "); use InitializeThreaded().");
+    }
+
+  // Every process duplicates the communicators in the same order, as
+  // MPI_Comm_dup is collective.
+  this->ThreadControllers->Controllers.resize(count);
+  for (int i = 0; i < count; ++i)
+    {
+    VTK_CREATE(vtkMPICommunicator, threadComm);
+    threadComm->Duplicate(comm);
+    vtkMPIController* controller = vtkMPIController::New();
+    controller->SetCommunicator(threadComm);
+    this->ThreadControllers->Controllers[i].TakeReference(controller);
+    }
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+vtkMPIController *vtkMPIController::GetThreadController(int index)
+{
+  if (index < 0 || index >= this->GetNumberOfThreadControllers())
+    {
+    return NULL;
+    }
+  return this->ThreadControllers->Controllers[index];
+}
+
+//-----------------------------------------------------------------------------
+int vtkMPIController::GetNumberOfThreadControllers()
+{
+  return static_cast<int>(this->ThreadControllers->Controllers.size());
+}
+
+//-----------------------------------------------------------------------------
+void vtkMPIController::ReleaseThreadControllers()
+{
+  this->ThreadControllers->Controllers.clear();
+}
+
 //-----------------------------------------------------------------------------
 int vtkMPIController::WaitSome(
   const int count, vtkMPICommunicator::Request rqsts[], vtkIntArray *completed)
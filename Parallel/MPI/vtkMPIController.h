@@ -48,6 +48,7 @@
 #include "vtkMPICommunicator.h" // Needed for direct access to communicator
 
 class vtkIntArray;
+class vtkMPIControllerThreadControllers;
 
 class VTKPARALLELMPI_EXPORT vtkMPIController : public vtkMultiProcessController
 {
@@ -78,6 +79,33 @@ public:
   // Same as Initialize(0, 0, 1). Mainly for calling from wrapped languages.
   virtual void Initialize();
 
+  // Description:
+  // The levels of thread support of MPI, from the most restrictive to the
+  // least. They match MPI_THREAD_SINGLE, MPI_THREAD_FUNNELED,
+  // MPI_THREAD_SERIALIZED and MPI_THREAD_MULTIPLE.
+  enum ThreadLevels
+  {
+    THREAD_SINGLE = 0,
+    THREAD_FUNNELED,
+    THREAD_SERIALIZED,
+    THREAD_MULTIPLE
+  };
+
+  // Description:
+  // Same as Initialize(argc, argv) but MPI is initialized with
+  // MPI_Init_thread, requesting the given level of thread support. The
+  // implementation may provide a lower level; check it with
+  // GetProvidedThreadLevel() before calling MPI from several threads.
+  virtual void InitializeThreaded(int* argc, char*** argv,
+                                  int requestedThreadLevel);
+
+  // Description:
+  // Return the level of thread support provided by MPI, one of
+  // ThreadLevels. This is THREAD_SINGLE until MPI is initialized. When MPI
+  // is initialized externally, the level is queried with MPI_Query_thread.
+  static int GetProvidedThreadLevel()
+    { return vtkMPIController::ProvidedThreadLevel; }
+
   // Description:
   // This method is for cleaning up and has to be called before
   // the end of the program if MPI was initialized with
@@ -123,6 +151,32 @@ public:
 
   virtual vtkMPIController *PartitionController(int localColor, int localKey);
 
+  // Description:
+  // Create count controllers whose communicators are duplicates of the
+  // communicator of this controller, one for each thread of a hybrid
+  // MPI+SMP algorithm. Since every duplicate has its own context, threads
+  // using different controllers can communicate with the same tags
+  // without receiving each other's messages. Typically, the thread with
+  // vtkSMPTools::GetThreadIndex() i uses GetThreadController(i). This is
+  // a collective operation on all the processes of the communicator.
+  // Previous thread controllers are released. Using the controllers from
+  // concurrent threads requires GetProvidedThreadLevel() to be
+  // THREAD_MULTIPLE; with THREAD_SERIALIZED, the threads must not call
+  // MPI at the same time. Returns 1 on success, 0 otherwise.
+  int CreateThreadControllers(int count);
+
+  // Description:
+  // Return the thread controller with the given index, or NULL when index
+  // is out of the range of the controllers created by
+  // CreateThreadControllers().
+  vtkMPIController *GetThreadController(int index);
+  int GetNumberOfThreadControllers();
+
+  // Description:
+  // Release the thread controllers. They are also released by Finalize()
+  // and by the destructor.
+  void ReleaseThreadControllers();
+
 //BTX
 
   // Description:
@@ -296,6 +350,11 @@ protected:
   // Duplicate the current communicator, creating RMICommunicator
   void InitializeRMICommunicator();
 
+  // Initialize MPI with MPI_Init, or with MPI_Init_thread when
+  // requestedThreadLevel is not negative, and record the provided level.
+  void InitializeMPI(int* argc, char*** argv, int initializedExternally,
+                     int requestedThreadLevel);
+
   // Description:
   // Implementation for TriggerRMI() provides subclasses an opportunity to
   // modify the behaviour eg. MPIController provides ability to use Ssend
@@ -320,6 +379,10 @@ protected:
   // Description:
   // When set, TriggerRMI uses Ssend instead of Send.
   static int UseSsendForRMI;
+
+  static int ProvidedThreadLevel;
+
+  vtkMPIControllerThreadControllers* ThreadControllers;
 private:
   vtkMPIController(const vtkMPIController&);  // Not implemented.
   void operator=(const vtkMPIController&);  // Not implemented.
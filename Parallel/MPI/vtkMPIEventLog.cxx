@@ -12,62 +12,152 @@
      PURPOSE.  See the above copyright notice for more information.
 
 =========================================================================*/
-
 #include "vtkMPIEventLog.h"
-#include "vtkMPIController.h"
+
+#include "vtkExecutionProfiler.h"
+#include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
-#include "mpi.h" // required before "mpe.h" to avoid "C vs C++" conflicts
-#include "mpe.h"
+#include "vtkTimerLog.h"
 
-int vtkMPIEventLog::LastEventId = 0;
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// The profiler created by InitializeLogging(), if there was none recording.
+static vtkExecutionProfiler* vtkMPIEventLogProfiler = 0;
 
 vtkStandardNewMacro(vtkMPIEventLog);
 
 void vtkMPIEventLog::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+  os << indent << "Name: " << (this->Name ? this->Name : "(none)") << endl;
+  os << indent << "Category: "
+     << (this->Category ? this->Category : "(none)") << endl;
 }
 
 vtkMPIEventLog::vtkMPIEventLog()
 {
 
   this->Active = 0;
+  this->Name = 0;
+  this->Category = 0;
+  this->Event = -1;
 
 }
 
 void vtkMPIEventLog::InitializeLogging()
 {
-  MPE_Init_log();
+  vtkExecutionProfiler* profiler = vtkExecutionProfiler::GetActiveProfiler();
+  if (!profiler)
+    {
+    if (!vtkMPIEventLogProfiler)
+      {
+      vtkMPIEventLogProfiler = vtkExecutionProfiler::New();
+      }
+    profiler = vtkMPIEventLogProfiler;
+    profiler->Start();
+    }
+
+  // The processes leave the last barrier at nearly the same time, which
+  // becomes time 0 of the trace on all of them.
+  vtkMultiProcessController* controller =
+    vtkMultiProcessController::GetGlobalController();
+  if (controller)
+    {
+    profiler->SetProcessId(controller->GetLocalProcessId());
+    controller->Barrier();
+    controller->Barrier();
+    }
+  profiler->SetClockOffset(
+    profiler->GetTimeOrigin() - vtkTimerLog::GetUniversalTime());
 }
 
 void vtkMPIEventLog::FinalizeLogging(const char* fname)
 {
-  MPE_Finish_log(const_cast<char*>(fname));
-}
+  vtkExecutionProfiler* profiler = vtkExecutionProfiler::GetActiveProfiler();
+  if (!profiler)
+    {
+    profiler = vtkMPIEventLogProfiler;
+    }
+  if (!profiler)
+    {
+    vtkGenericWarningMacro("Logging was not initialized.");
+    return;
+    }
+  // Do not record the gathering of the trace.
+  profiler->Stop();
+
+  vtkMultiProcessController* controller =
+    vtkMultiProcessController::GetGlobalController();
+  int rank = controller ? controller->GetLocalProcessId() : 0;
+  int numProcs = controller ? controller->GetNumberOfProcesses() : 1;
+
+  std::ostringstream events;
+  events << "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+         << ",\"args\":{\"name\":\"rank " << rank << "\"}}";
+  if (profiler->GetNumberOfEvents() > 0)
+    {
+    events << ",";
+    profiler->WriteTraceEvents(events);
+    }
+  std::string local = events.str();
 
-int vtkMPIEventLog::SetDescription(const char* name, const char* desc)
-{
-  int err, processId;
-  if ( (err = MPI_Comm_rank(MPI_COMM_WORLD,&processId))
-       != MPI_SUCCESS)
+  std::vector<vtkIdType> lengths(numProcs, 0);
+  std::vector<vtkIdType> offsets(numProcs, 0);
+  std::vector<char> all;
+  vtkIdType length = static_cast<vtkIdType>(local.size());
+  if (controller && numProcs > 1)
+    {
+    controller->Gather(&length, &lengths[0], 1, 0);
+    vtkIdType total = 0;
+    for (int i = 0; i < numProcs; ++i)
+      {
+      offsets[i] = total;
+      total += lengths[i];
+      }
+    all.resize(rank == 0 ? total : 1);
+    controller->GatherV(local.c_str(), &all[0], length,
+                        &lengths[0], &offsets[0], 0);
+    }
+  else
     {
-    char *msg = vtkMPIController::ErrorString(err);
-    vtkErrorMacro("MPI error occurred: " << msg);
-    delete[] msg;
-    return 0;
+    lengths[0] = length;
+    all.assign(local.begin(), local.end());
     }
 
-  this->Active = 1;
-  if (processId == 0)
+  if (rank == 0)
     {
-    this->BeginId = MPE_Log_get_event_number();
-    this->EndId = MPE_Log_get_event_number();
-    MPE_Describe_state(this->BeginId, this->EndId, const_cast<char*>(name),
-                       const_cast<char*>(desc));
+    ofstream os(fname);
+    if (!os)
+      {
+      vtkGenericWarningMacro("Could not open " << (fname ? fname : "(null)"));
+      }
+    else
+      {
+      os << "{\"traceEvents\":[";
+      for (int i = 0; i < numProcs; ++i)
+        {
+        os << (i ? "," : "");
+        os.write(&all[offsets[i]], lengths[i]);
+        }
+      os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+      }
     }
-  MPI_Bcast(&this->BeginId, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  MPI_Bcast(&this->EndId, 1, MPI_INT, 0, MPI_COMM_WORLD);
 
+  if (vtkMPIEventLogProfiler)
+    {
+    vtkMPIEventLogProfiler->Delete();
+    vtkMPIEventLogProfiler = 0;
+    }
+}
+
+int vtkMPIEventLog::SetDescription(const char* name, const char* desc)
+{
+  this->SetName(name);
+  this->SetCategory(desc);
+  this->Active = 1;
   return 1;
 }
 
@@ -79,7 +169,9 @@ void vtkMPIEventLog::StartLogging()
     return;
     }
 
-  MPE_Log_event(this->BeginId, 0, "begin");
+  vtkExecutionProfiler* profiler = vtkExecutionProfiler::GetActiveProfiler();
+  this->Event = profiler ?
+    profiler->BeginEvent(this->Name, this->Category) : -1;
 }
 
 void vtkMPIEventLog::StopLogging()
@@ -89,10 +181,16 @@ void vtkMPIEventLog::StopLogging()
     vtkWarningMacro("This vtkMPIEventLog has not been initialized. Can not log event.");
     return;
     }
-  MPE_Log_event(this->EndId, 0, "end");
+  vtkExecutionProfiler* profiler = vtkExecutionProfiler::GetActiveProfiler();
+  if (profiler)
+    {
+    profiler->EndEvent(this->Event);
+    }
+  this->Event = -1;
 }
 
 vtkMPIEventLog::~vtkMPIEventLog()
 {
+  this->SetName(0);
+  this->SetCategory(0);
 }
-
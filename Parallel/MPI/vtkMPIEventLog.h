@@ -15,17 +15,20 @@
 // .NAME vtkMPIEventLog - Class for logging and timing.
 
 // .SECTION Description
-// This class is wrapper around MPE event logging functions
-// (available from Argonne National Lab/Missippi State
-// University). It allows users to create events with names
-// and log them. Different log file formats can be generated
-// by changing MPE's configuration. Some of these formats are
-// binary (for examples SLOG and CLOG) and can be analyzed with
-// viewers from ANL. ALOG is particularly useful since it is
-// text based and can be processed with simple scripts.
+// This class logs named events of all the processes into one trace. Between
+// InitializeLogging() and FinalizeLogging(), the events issued with
+// StartLogging() and StopLogging() are recorded by a vtkExecutionProfiler,
+// along with the pipeline requests and the communications of
+// vtkMPICommunicator, with their sizes in bytes and their peers.
+//
+// InitializeLogging() aligns the clocks of the processes on a barrier.
+// FinalizeLogging() gathers the events of all the processes and writes them
+// on process 0 as one Chrome trace, where each process is shown with its
+// rank, so that load imbalance and the time spent waiting in
+// communications can be seen side by side.
 
 // .SECTION See Also
-// vtkTimerLog vtkMPIController vtkMPICommunicator
+// vtkExecutionProfiler vtkTimerLog vtkMPIController vtkMPICommunicator
 
 #ifndef vtkMPIEventLog_h
 #define vtkMPIEventLog_h
@@ -39,26 +42,24 @@ public:
   vtkTypeMacro(vtkMPIEventLog,vtkObject);
 
   // Description:
-  // Construct a vtkMPIEventLog with the following initial state:
-  // Processes = 0, MaximumNumberOfProcesses = 0.
+  // Construct a vtkMPIEventLog with no name.
   static vtkMPIEventLog* New();
 
   // Description:
-  // Used to initialize the underlying mpe event.
-  // HAS TO BE CALLED BY ALL PROCESSES before any event
-  // logging is done.
-  // It takes a name and a description for the graphical
-  // representation, for example, "red:vlines3". See
-  // mpe documentation for details.
-  // Returns 0 on MPI failure (or aborts depending on
-  // MPI error handlers)
+  // Set the name of the events of this log, and their category, for
+  // example "communication" or "rendering".
+  // HAS TO BE CALLED before any event logging is done.
+  // Returns 1.
   int SetDescription(const char* name, const char* desc);
 
   // Description:
   // These methods have to be called once on all processors
-  // before and after invoking any logging events.
-  // The name of the logfile is given by fileName.
-  // See mpe documentation for file formats.
+  // before and after invoking any logging events. They use the
+  // global controller of vtkMultiProcessController.
+  // InitializeLogging() starts recording with the vtkExecutionProfiler
+  // that is recording, or with one of its own.
+  // FinalizeLogging() stops recording and writes the trace of all
+  // processes to fileName on process 0.
   static void InitializeLogging();
   static void FinalizeLogging(const char* fileName);
 
@@ -74,17 +75,16 @@ protected:
   vtkMPIEventLog();
   ~vtkMPIEventLog();
 
-  static int LastEventId;
+  vtkSetStringMacro(Name);
+  vtkSetStringMacro(Category);
+
   int Active;
-  int BeginId;
-  int EndId;
+  char* Name;
+  char* Category;
+  vtkIdType Event;
 private:
   vtkMPIEventLog(const vtkMPIEventLog&);  // Not implemented.
   void operator=(const vtkMPIEventLog&);  // Not implemented.
 };
 
 #endif
-
-
-
-
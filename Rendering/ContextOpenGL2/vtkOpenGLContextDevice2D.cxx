@@ -351,6 +351,8 @@ void vtkOpenGLContextDevice2D::End()
     return;
     }
 
+  this->FlushBatch();
+
   this->ProjectionMatrix->Pop();
   this->PopMatrix();
 
@@ -379,6 +381,7 @@ void vtkOpenGLContextDevice2D::BufferIdModeBegin(
   assert("pre: not_yet" && !this->GetBufferIdMode());
   assert("pre: bufferId_exists" && bufferId!=0);
 
+  this->FlushBatch();
   vtkOpenGLClearErrorMacro();
 
   this->BufferId=bufferId;
@@ -463,6 +466,96 @@ void vtkOpenGLContextDevice2D::SetMatrices(vtkShaderProgram *prog)
     this->ModelMatrix->GetMatrix());
 }
 
+bool vtkOpenGLContextDevice2D::CanBatch()
+{
+  vtkOpenGLGL2PSHelper *gl2ps = vtkOpenGLGL2PSHelper::GetInstance();
+  return this->InRender && !this->GetBufferIdMode() &&
+    !(gl2ps && gl2ps->GetActiveState() != vtkOpenGLGL2PSHelper::Inactive);
+}
+
+void vtkOpenGLContextDevice2D::Batch(int mode, float size, float *f, int n,
+                                     unsigned char *colors, int nc,
+                                     unsigned char color[4])
+{
+  if (n <= 0)
+    {
+    return;
+    }
+  if (!this->Storage->BatchVertices.empty() &&
+      (static_cast<GLenum>(mode) != this->Storage->BatchMode ||
+       size != this->Storage->BatchSize))
+    {
+    this->FlushBatch();
+    }
+  this->Storage->BatchMode = static_cast<GLenum>(mode);
+  this->Storage->BatchSize = size;
+
+  // Apply the model matrix now, so that primitives drawn with different
+  // matrices share the queue.
+  double *m = this->ModelMatrix->GetMatrix()->Element[0];
+  size_t first = this->Storage->BatchVertices.size() / 2;
+  this->Storage->BatchVertices.resize(2 * (first + n));
+  this->Storage->BatchColors.resize(4 * (first + n));
+  float *v = &this->Storage->BatchVertices[2 * first];
+  unsigned char *c = &this->Storage->BatchColors[4 * first];
+  for (int i = 0; i < n; ++i, v += 2, c += 4)
+    {
+    double x = f[2 * i];
+    double y = f[2 * i + 1];
+    double w = m[12] * x + m[13] * y + m[15];
+    v[0] = static_cast<float>((m[0] * x + m[1] * y + m[3]) / w);
+    v[1] = static_cast<float>((m[4] * x + m[5] * y + m[7]) / w);
+    const unsigned char *rgba = colors ? colors + nc * i : color;
+    c[0] = rgba[0];
+    c[1] = rgba[1];
+    c[2] = rgba[2];
+    c[3] = (!colors || nc == 4) ? rgba[3] : 255;
+    }
+}
+
+void vtkOpenGLContextDevice2D::FlushBatch()
+{
+  if (this->Storage->BatchVertices.empty())
+    {
+    return;
+    }
+
+  vtkOpenGLClearErrorMacro();
+
+  int n = static_cast<int>(this->Storage->BatchVertices.size() / 2);
+  this->ReadyVCBOProgram();
+  vtkOpenGLHelper *cbo = this->VCBO;
+  this->BuildVBO(cbo, &this->Storage->BatchVertices[0], n,
+    &this->Storage->BatchColors[0], 4, NULL);
+
+  // The vertices are already in device coordinates.
+  vtkNew<vtkMatrix4x4> identity;
+  cbo->Program->SetUniformMatrix("WCDCMatrix",
+    this->ProjectionMatrix->GetMatrix());
+  cbo->Program->SetUniformMatrix("MCWCMatrix", identity.GetPointer());
+
+  if (this->Storage->BatchMode == GL_LINES)
+    {
+    this->SetLineWidth(this->Storage->BatchSize);
+    }
+  else if (this->Storage->BatchMode == GL_POINTS)
+    {
+    this->SetPointSize(this->Storage->BatchSize);
+    }
+  glDrawArrays(this->Storage->BatchMode, 0, n);
+  if (this->Storage->BatchMode == GL_LINES)
+    {
+    this->SetLineWidth(1.0);
+    }
+
+  // Keep the capacity of the queue for the next primitives.
+  this->Storage->BatchVertices.clear();
+  this->Storage->BatchColors.clear();
+  cbo->ReleaseGraphicsResources(this->RenderWindow);
+
+  vtkOpenGLCheckErrorMacro("failed after FlushBatch");
+}
+
 void vtkOpenGLContextDevice2D::BuildVBO(
   vtkOpenGLHelper *cellBO,
   float *f, int nv,
@@ -789,22 +882,28 @@ void vtkOpenGLContextDevice2D::DrawPoly(float *f, int n, unsigned char *colors,
   vtkOpenGLClearErrorMacro();
   this->SetLineType(this->Pen->GetLineType());
 
+  // Solid lines are queued with the other solid primitives.
+  bool batch = this->LinePattern == 0xFFFF && this->CanBatch();
   vtkOpenGLHelper *cbo = 0;
-  if (colors)
+  if (!batch)
     {
-    this->ReadyLinesCBOProgram();
-    cbo = this->LinesCBO;
-    }
-  else
-    {
-    this->ReadyLinesBOProgram();
-    cbo = this->LinesBO;
-    cbo->Program->SetUniform4uc("vertexColor",
-      this->Pen->GetColor());
-    }
-  cbo->Program->SetUniformi("stipple",this->LinePattern);
+    this->FlushBatch();
+    if (colors)
+      {
+      this->ReadyLinesCBOProgram();
+      cbo = this->LinesCBO;
+      }
+    else
+      {
+      this->ReadyLinesBOProgram();
+      cbo = this->LinesBO;
+      cbo->Program->SetUniform4uc("vertexColor",
+        this->Pen->GetColor());
+      }
+    cbo->Program->SetUniformi("stipple",this->LinePattern);
 
-  this->SetMatrices(cbo->Program);
+    this->SetMatrices(cbo->Program);
+    }
 
   // for line stipple we need to compute the scaled
   // cumulative linear distance
@@ -878,6 +977,13 @@ void vtkOpenGLContextDevice2D::DrawPoly(float *f, int n, unsigned char *colors,
       newDistances[i*12+10] = distances[i*2+2];
       }
 
+    if (batch)
+      {
+      this->Batch(GL_TRIANGLES, 0.0f, &(newVerts[0]), newVerts.size()/2,
+        colors ? &(newColors[0]) : NULL, nc, this->Pen->GetColor());
+      return;
+      }
+
     this->BuildVBO(cbo, &(newVerts[0]), newVerts.size()/2,
       colors ? &(newColors[0]) : NULL, nc, &(newDistances[0]));
 
@@ -887,6 +993,29 @@ void vtkOpenGLContextDevice2D::DrawPoly(float *f, int n, unsigned char *colors,
     }
   else
     {
+    if (batch)
+      {
+      // Queue the strip as separate segments.
+      std::vector<float> segments;
+      std::vector<unsigned char> segmentColors;
+      for (int i = 0; i < n-1; i++)
+        {
+        segments.insert(segments.end(), f+i*2, f+i*2+4);
+        if (colors)
+          {
+          copyColors(segmentColors, colors+i*nc, nc);
+          copyColors(segmentColors, colors+(i+1)*nc, nc);
+          }
+        }
+      if (!segments.empty())
+        {
+        this->Batch(GL_LINES, this->Pen->GetWidth(), &(segments[0]),
+          segments.size()/2, colors ? &(segmentColors[0]) : NULL, nc,
+          this->Pen->GetColor());
+        }
+      return;
+      }
+
     this->SetLineWidth(this->Pen->GetWidth());
     this->BuildVBO(cbo, f, n, colors, nc, &(distances[0]));
     PreDraw(*cbo, GL_LINE_STRIP, n);
@@ -925,25 +1054,30 @@ void vtkOpenGLContextDevice2D::DrawLines(float *f, int n, unsigned char *colors,
     }
 
   vtkOpenGLClearErrorMacro();
-
   this->SetLineType(this->Pen->GetLineType());
 
+  // Solid lines are queued with the other solid primitives.
+  bool batch = this->LinePattern == 0xFFFF && this->CanBatch();
   vtkOpenGLHelper *cbo = 0;
-  if (colors)
-    {
-    this->ReadyLinesCBOProgram();
-    cbo = this->LinesCBO;
-    }
-  else
+  if (!batch)
     {
-    this->ReadyLinesBOProgram();
-    cbo = this->LinesBO;
-    cbo->Program->SetUniform4uc("vertexColor",
-      this->Pen->GetColor());
-    }
-  cbo->Program->SetUniformi("stipple",this->LinePattern);
+    this->FlushBatch();
+    if (colors)
+      {
+      this->ReadyLinesCBOProgram();
+      cbo = this->LinesCBO;
+      }
+    else
+      {
+      this->ReadyLinesBOProgram();
+      cbo = this->LinesBO;
+      cbo->Program->SetUniform4uc("vertexColor",
+        this->Pen->GetColor());
+      }
+    cbo->Program->SetUniformi("stipple",this->LinePattern);
 
-  this->SetMatrices(cbo->Program);
+    this->SetMatrices(cbo->Program);
+    }
 
   // for line stipple we need to compute the scaled
   // cumulative linear distance
@@ -1012,6 +1146,13 @@ void vtkOpenGLContextDevice2D::DrawLines(float *f, int n, unsigned char *colors,
       newDistances[i*12+10] = distances[i*2+2];
       }
 
+    if (batch)
+      {
+      this->Batch(GL_TRIANGLES, 0.0f, &(newVerts[0]), newVerts.size()/2,
+        colors ? &(newColors[0]) : NULL, nc, this->Pen->GetColor());
+      return;
+      }
+
     this->BuildVBO(cbo, &(newVerts[0]), newVerts.size()/2,
       colors ? &(newColors[0]) : NULL, nc, &(newDistances[0]));
     PreDraw(*cbo, GL_TRIANGLES, newVerts.size() / 2);
@@ -1020,6 +1161,13 @@ void vtkOpenGLContextDevice2D::DrawLines(float *f, int n, unsigned char *colors,
     }
   else
     {
+    if (batch)
+      {
+      this->Batch(GL_LINES, this->Pen->GetWidth(), f, n, colors, nc,
+        this->Pen->GetColor());
+      return;
+      }
+
     this->SetLineWidth(this->Pen->GetWidth());
     this->BuildVBO(cbo, f, n, colors, nc, &(distances[0]));
     PreDraw(*cbo, GL_LINES, n);
@@ -1049,6 +1197,14 @@ void vtkOpenGLContextDevice2D::DrawPoints(float *f, int n, unsigned char *c,
     return;
     }
 
+  if (this->CanBatch())
+    {
+    this->Batch(GL_POINTS, this->Pen->GetWidth(), f, n, c, nc,
+                this->Pen->GetColor());
+    return;
+    }
+  this->FlushBatch();
+
   vtkOpenGLClearErrorMacro();
 
   vtkOpenGLHelper *cbo = 0;
@@ -1092,6 +1248,7 @@ void vtkOpenGLContextDevice2D::DrawPointSprites(vtkImageData *sprite,
 //    return;
 //    }
 
+  this->FlushBatch();
   vtkOpenGLClearErrorMacro();
   if (points && n > 0)
     {
@@ -1225,6 +1382,18 @@ void vtkOpenGLContextDevice2D::CoreDrawTriangles(
     return;
     }
 
+  if (!this->Brush->GetTexture() && this->CanBatch())
+    {
+    // Skip transparent elements.
+    if (this->Brush->GetColorObject().GetAlpha() != 0)
+      {
+      this->Batch(GL_TRIANGLES, 0.0f, &(tverts[0]), tverts.size()/2, NULL, 0,
+                  this->Brush->GetColor());
+      }
+    return;
+    }
+  this->FlushBatch();
+
   vtkOpenGLClearErrorMacro();
 
   float* texCoord = 0;
@@ -1630,6 +1799,8 @@ void vtkOpenGLContextDevice2D::ComputeStringBounds(const vtkStdString &string,
 void vtkOpenGLContextDevice2D::DrawString(float *point,
                                           const vtkUnicodeString &string)
 {
+  this->FlushBatch();
+
   vtkOpenGLGL2PSHelper *gl2ps = vtkOpenGLGL2PSHelper::GetInstance();
   if (gl2ps)
     {
@@ -1857,6 +2028,7 @@ void vtkOpenGLContextDevice2D::DrawMathTextString(float point[2],
                        xw,   xh,
                        0.0f, xh };
 
+  this->FlushBatch();
   vtkOpenGLClearErrorMacro();
 
   vtkOpenGLHelper *cbo = 0;
@@ -1882,6 +2054,8 @@ void vtkOpenGLContextDevice2D::DrawMathTextString(float point[2],
 void vtkOpenGLContextDevice2D::DrawImage(float p[2], float scale,
                                          vtkImageData *image)
 {
+  this->FlushBatch();
+
   vtkOpenGLGL2PSHelper *gl2ps = vtkOpenGLGL2PSHelper::GetInstance();
   if (gl2ps)
     {
@@ -1948,6 +2122,8 @@ void vtkOpenGLContextDevice2D::DrawImage(float p[2], float scale,
 void vtkOpenGLContextDevice2D::DrawImage(const vtkRectf& pos,
                                          vtkImageData *image)
 {
+  this->FlushBatch();
+
   vtkOpenGLGL2PSHelper *gl2ps = vtkOpenGLGL2PSHelper::GetInstance();
   if (gl2ps)
     {
@@ -2194,6 +2370,8 @@ void vtkOpenGLContextDevice2D::PopMatrix()
 //-----------------------------------------------------------------------------
 void vtkOpenGLContextDevice2D::SetClipping(int *dim)
 {
+  this->FlushBatch();
+
   // Check the bounds, and clamp if necessary
   GLint vp[4] = { this->Storage->Offset.GetX(), this->Storage->Offset.GetY(),
     this->Storage->Dim.GetX(),this->Storage->Dim.GetY()};
@@ -2221,6 +2399,7 @@ void vtkOpenGLContextDevice2D::SetClipping(int *dim)
 //-----------------------------------------------------------------------------
 void vtkOpenGLContextDevice2D::EnableClipping(bool enable)
 {
+  this->FlushBatch();
   if (enable)
     {
     glEnable(GL_SCISSOR_TEST);
@@ -2248,6 +2427,8 @@ bool vtkOpenGLContextDevice2D::SetStringRendererToQt()
 //----------------------------------------------------------------------------
 void vtkOpenGLContextDevice2D::ReleaseGraphicsResources(vtkWindow *window)
 {
+  this->Storage->BatchVertices.clear();
+  this->Storage->BatchColors.clear();
   this->VBO->ReleaseGraphicsResources(window);
   this->VCBO->ReleaseGraphicsResources(window);
   this->LinesBO->ReleaseGraphicsResources(window);
@@ -286,6 +286,15 @@ public:
   // resources to release.
   virtual void ReleaseGraphicsResources(vtkWindow *window);
 
+  // Description:
+  // Draw the points, lines and triangles queued by the previous draw calls.
+  // Consecutive draw calls with a solid pen or brush append their vertices,
+  // colors and model matrix applied, to a single vertex buffer, which is
+  // drawn when a call needs another primitive type, line width or point
+  // size, or other state, and by End(). Code drawing directly with OpenGL
+  // in between the calls of the device must flush it first.
+  void FlushBatch();
+
   // Description:
   // Get the projection matrix this is needed
   vtkMatrix4x4 *GetProjectionMatrix();
@@ -354,6 +363,19 @@ protected:
     float *tcoords);
   void CoreDrawTriangles(std::vector<float> &tverts);
 
+  // Description:
+  // Whether solid primitives can be queued rather than drawn at once, which
+  // is not the case while capturing GL2PS output or drawing buffer ids.
+  bool CanBatch();
+
+  // Description:
+  // Queue n vertices of the primitive type mode (GL_TRIANGLES, GL_LINES or
+  // GL_POINTS), with the line width or point size size. They are colored by
+  // colors, which has nc components, or by color if colors is null. The
+  // queue is flushed first if it holds another primitive type or size.
+  void Batch(int mode, float size, float *f, int n, unsigned char *colors,
+             int nc, unsigned char color[4]);
+
   // used for stipples
   unsigned short LinePattern;
 
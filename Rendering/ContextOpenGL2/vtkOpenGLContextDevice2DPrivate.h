@@ -41,6 +41,7 @@
 #include <algorithm>
 #include <list>
 #include <utility>
+#include <vector>
 
 // .NAME vtkTextureImageCache - store vtkTexture and vtkImageData identified by
 // a unique key.
@@ -242,6 +243,8 @@ public:
     this->GLExtensionsLoaded = true;
     this->GLSL = true;
     this->PowerOfTwoTextures = false;
+    this->BatchMode = GL_TRIANGLES;
+    this->BatchSize = 0.0f;
   }
 
   ~Private()
@@ -490,6 +493,14 @@ public:
   // we cache the textures here for a faster reuse.
   mutable vtkTextureImageCache<UTF16TextPropertyKey> TextTextureCache;
   mutable vtkTextureImageCache<UTF8TextPropertyKey> MathTextTextureCache;
+
+  // Description:
+  // The queue of solid primitives: their vertices in device coordinates,
+  // their RGBA colors, their primitive type and line width or point size.
+  std::vector<float> BatchVertices;
+  std::vector<unsigned char> BatchColors;
+  GLenum BatchMode;
+  float BatchSize;
 };
 
 #endif // VTKOPENGLCONTEXTDEVICE2DPRIVATE_H
@@ -380,6 +380,9 @@ void vtkOpenGLContextDevice3D::DrawPoly(const float *verts, int n,
   assert("verts must be non-null" && verts != NULL);
   assert("n must be greater than 0" && n > 0);
 
+  // Draw the 2D primitives queued before this one.
+  this->Device2D->FlushBatch();
+
   if (this->Pen->GetLineType() == vtkPen::NO_PEN)
     {
     return;
@@ -435,6 +438,8 @@ void vtkOpenGLContextDevice3D::DrawLines(const float *verts, int n,
   assert("verts must be non-null" && verts != NULL);
   assert("n must be greater than 0" && n > 0);
 
+  this->Device2D->FlushBatch();
+
   if (this->Pen->GetLineType() == vtkPen::NO_PEN)
     {
     return;
@@ -486,6 +491,8 @@ void vtkOpenGLContextDevice3D::DrawPoints(const float *verts, int n,
   assert("verts must be non-null" && verts != NULL);
   assert("n must be greater than 0" && n > 0);
 
+  this->Device2D->FlushBatch();
+
   vtkOpenGLClearErrorMacro();
 
   this->EnableDepthBuffer();
@@ -526,6 +533,8 @@ void vtkOpenGLContextDevice3D::DrawTriangleMesh(const float *mesh, int n,
   assert("mesh must be non-null" && mesh != NULL);
   assert("n must be greater than 0" && n > 0);
 
+  this->Device2D->FlushBatch();
+
   vtkOpenGLClearErrorMacro();
 
   this->EnableDepthBuffer();
@@ -45,6 +45,9 @@ void vtkOpenGLPropItem::UpdateTransforms()
     return;
     }
 
+  // The prop draws with its own programs, after the queued 2D primitives.
+  glDev->FlushBatch();
+
   // Get the active camera:
   vtkRenderer *ren = this->Scene->GetRenderer();
   vtkCamera *activeCamera = ren->GetActiveCamera();
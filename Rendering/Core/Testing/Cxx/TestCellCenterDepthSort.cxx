@@ -0,0 +1,156 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellCenterDepthSort.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test covers the sorts of vtkCellCenterDepthSort. The cells of an
+// image are sorted back to front with the quicksort and with the radix
+// sort: every cell must be returned once, the farthest first. With a reuse
+// angle, a small rotation of the camera must keep the last order and a
+// larger one must sort the cells again.
+
+#include "vtkCamera.h"
+#include "vtkCellCenterDepthSort.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+
+#include <vector>
+
+namespace
+{
+
+// Traverse the cells in the order of the sort. False is returned if a cell
+// is missing, repeated or out of order.
+bool Traverse(vtkCellCenterDepthSort *sort, vtkImageData *image,
+              vtkCamera *camera, std::vector<vtkIdType> &order)
+{
+  double position[3];
+  double focalPoint[3];
+  camera->GetPosition(position);
+  camera->GetFocalPoint(focalPoint);
+  double vector[3];
+  vtkMath::Subtract(position, focalPoint, vector);
+
+  vtkIdType numCells = image->GetNumberOfCells();
+  std::vector<bool> returned(numCells, false);
+  order.clear();
+  double lastDepth = VTK_DOUBLE_MIN;
+
+  sort->InitTraversal();
+  vtkIdTypeArray *cells;
+  while ((cells = sort->GetNextCells()) != NULL)
+    {
+    for (vtkIdType i = 0; i < cells->GetNumberOfTuples(); ++i)
+      {
+      vtkIdType cellId = cells->GetValue(i);
+      if (cellId < 0 || cellId >= numCells || returned[cellId])
+        {
+        cerr << "Cell " << cellId << " is not expected" << endl;
+        return false;
+        }
+      returned[cellId] = true;
+      order.push_back(cellId);
+
+      double bounds[6];
+      image->GetCellBounds(cellId, bounds);
+      double center[3] = { 0.5 * (bounds[0] + bounds[1]),
+        0.5 * (bounds[2] + bounds[3]), 0.5 * (bounds[4] + bounds[5]) };
+      double depth = vtkMath::Dot(center, vector);
+      if (depth < lastDepth - 1e-3)
+        {
+        cerr << "Cell " << cellId << " is nearer than the previous one"
+             << endl;
+        return false;
+        }
+      lastDepth = depth;
+      }
+    }
+
+  if (static_cast<vtkIdType>(order.size()) != numCells)
+    {
+    cerr << "Returned " << order.size() << " cells instead of " << numCells
+         << endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+int TestCellCenterDepthSort(int, char *[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(21, 21, 21);
+
+  vtkNew<vtkCamera> camera;
+  camera->SetPosition(40.0, 30.0, 50.0);
+  camera->SetFocalPoint(10.0, 10.0, 10.0);
+  camera->SetViewUp(0.0, 1.0, 0.0);
+
+  vtkNew<vtkCellCenterDepthSort> sort;
+  sort->SetInput(image.Get());
+  sort->SetCamera(camera.Get());
+  sort->SetDirectionToBackToFront();
+  sort->SetMaxCellsReturned(1000);
+
+  std::vector<vtkIdType> order;
+  if (!Traverse(sort.Get(), image.Get(), camera.Get(), order))
+    {
+    cerr << "The quicksort failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Changing the options sorts the cells again, set them before sorting.
+  sort->UseRadixSortOn();
+  sort->SetReuseAngle(5.0);
+  if (!Traverse(sort.Get(), image.Get(), camera.Get(), order))
+    {
+    cerr << "The radix sort failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // A small rotation keeps the order, which is then only approximate.
+  std::vector<vtkIdType> lastOrder = order;
+  camera->Azimuth(2.0);
+  sort->InitTraversal();
+  order.clear();
+  vtkIdTypeArray *cells;
+  while ((cells = sort->GetNextCells()) != NULL)
+    {
+    for (vtkIdType i = 0; i < cells->GetNumberOfTuples(); ++i)
+      {
+      order.push_back(cells->GetValue(i));
+      }
+    }
+  if (order != lastOrder)
+    {
+    cerr << "The order was not reused for a small rotation" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The angle is measured from the last sorted view.
+  camera->Azimuth(10.0);
+  if (!Traverse(sort.Get(), image.Get(), camera.Get(), order))
+    {
+    cerr << "The cells were not sorted again after a large rotation" << endl;
+    return EXIT_FAILURE;
+    }
+  if (order == lastOrder)
+    {
+    cerr << "The order was reused for a large rotation" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -31,6 +31,7 @@
 #include "vtkFloatArray.h"
 #include "vtkCell.h"
 #include "vtkMath.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 
 #include <stack>
@@ -47,6 +48,26 @@ public:
   std::stack<vtkIdPair> Stack;
 };
 
+namespace
+{
+// Depth of each cell center along the projection vector.
+class vtkCellCenterDepthSortComputeDepths
+{
+public:
+  const float *Centers;
+  const float *Vector;
+  float *Depths;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      this->Depths[i] = vtkMath::Dot(this->Centers + 3*i, this->Vector);
+      }
+  }
+};
+}
+
 //-----------------------------------------------------------------------------
 
 vtkStandardNewMacro(vtkCellCenterDepthSort);
@@ -66,6 +87,13 @@ vtkCellCenterDepthSort::vtkCellCenterDepthSort()
   this->CellPartitionDepths->SetNumberOfComponents(1);
 
   this->ToSort = new vtkCellCenterDepthSortStack;
+
+  this->UseRadixSort = false;
+  this->ReuseAngle = 0.0;
+  this->FullySorted = false;
+  this->NextCell = 0;
+  this->SortedVector[0] = this->SortedVector[1] = this->SortedVector[2] = 0.0;
+  this->SortedVectorValid = false;
 }
 
 vtkCellCenterDepthSort::~vtkCellCenterDepthSort()
@@ -82,6 +110,9 @@ vtkCellCenterDepthSort::~vtkCellCenterDepthSort()
 void vtkCellCenterDepthSort::PrintSelf(ostream &os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "UseRadixSort: " << this->UseRadixSort << endl;
+  os << indent << "ReuseAngle: " << this->ReuseAngle << endl;
 }
 
 float *vtkCellCenterDepthSort::ComputeProjectionVector()
@@ -154,13 +185,11 @@ void vtkCellCenterDepthSort::ComputeDepths()
   float *vector = this->ComputeProjectionVector();
   vtkIdType numcells = this->Input->GetNumberOfCells();
 
-  float *center = this->CellCenters->GetPointer(0);
-  float *depth = this->CellDepths->GetPointer(0);
-  for (vtkIdType i = 0; i < numcells; i++)
-    {
-    *(depth++) = vtkMath::Dot(center, vector);
-    center += 3;
-    }
+  vtkCellCenterDepthSortComputeDepths functor;
+  functor.Centers = this->CellCenters->GetPointer(0);
+  functor.Vector = vector;
+  functor.Depths = this->CellDepths->GetPointer(0);
+  vtkSMPTools::For(0, numcells, functor);
 }
 
 void vtkCellCenterDepthSort::InitTraversal()
@@ -169,6 +198,10 @@ void vtkCellCenterDepthSort::InitTraversal()
 
   vtkIdType numcells = this->Input->GetNumberOfCells();
 
+  while (!this->ToSort->Stack.empty()) this->ToSort->Stack.pop();
+  this->FullySorted = false;
+  this->NextCell = 0;
+
   if (   (this->LastSortTime < this->Input->GetMTime())
       || (this->LastSortTime < this->MTime) )
     {
@@ -178,6 +211,21 @@ void vtkCellCenterDepthSort::InitTraversal()
     this->ComputeCellCenters();
     this->CellDepths->SetNumberOfTuples(numcells);
     this->SortedCells->SetNumberOfTuples(numcells);
+    this->SortedVectorValid = false;
+    }
+  else if (this->SortedVectorValid && this->ReuseAngle > 0.0)
+    {
+    float *vector = this->ComputeProjectionVector();
+    double v1[3] = { vector[0], vector[1], vector[2] };
+    double v2[3] =
+      { this->SortedVector[0], this->SortedVector[1], this->SortedVector[2] };
+    if (vtkMath::DegreesFromRadians(vtkMath::AngleBetweenVectors(v1, v2))
+        <= this->ReuseAngle)
+      {
+      vtkDebugMacro("Reusing the last order.");
+      this->FullySorted = true;
+      return;
+      }
     }
 
   vtkDebugMacro("Filling SortedCells to initial values.");
@@ -190,22 +238,55 @@ void vtkCellCenterDepthSort::InitTraversal()
   vtkDebugMacro("Calculating depths.");
   this->ComputeDepths();
 
-  while (!this->ToSort->Stack.empty()) this->ToSort->Stack.pop();
-  this->ToSort->Stack.push(vtkIdPair(0, numcells));
+  float *vector = this->ComputeProjectionVector();
+  this->SortedVector[0] = vector[0];
+  this->SortedVector[1] = vector[1];
+  this->SortedVector[2] = vector[2];
+  if (this->UseRadixSort)
+    {
+    float *depths = this->CellDepths->GetPointer(0);
+    vtkSMPTools::RadixSort(depths, depths + numcells,
+                           this->SortedCells->GetPointer(0));
+    this->FullySorted = true;
+    this->SortedVectorValid = true;
+    }
+  else
+    {
+    // the order is complete once GetNextCells has returned all the cells
+    this->ToSort->Stack.push(vtkIdPair(0, numcells));
+    this->SortedVectorValid = false;
+    }
 
   this->LastSortTime.Modified();
 }
 
 vtkIdTypeArray *vtkCellCenterDepthSort::GetNextCells()
 {
+  vtkIdType *cellIds = this->SortedCells->GetPointer(0);
+  float *cellDepths = this->CellDepths->GetPointer(0);
+
+  if (this->FullySorted)
+    {
+    vtkIdType numcells = this->SortedCells->GetNumberOfTuples() -
+      this->NextCell;
+    if (numcells <= 0)
+      {
+      return NULL;
+      }
+    numcells = std::min(numcells,
+                        static_cast<vtkIdType>(this->MaxCellsReturned));
+    this->SortedCellPartition->SetArray(cellIds + this->NextCell, numcells, 1);
+    this->SortedCellPartition->SetNumberOfTuples(numcells);
+    this->NextCell += numcells;
+    return this->SortedCellPartition;
+    }
+
   if (this->ToSort->Stack.empty())
     {
     // Already sorted and returned everything.
+    this->SortedVectorValid = true;
     return NULL;
     }
-
-  vtkIdType *cellIds = this->SortedCells->GetPointer(0);
-  float *cellDepths = this->CellDepths->GetPointer(0);
   vtkIdPair partition;
 
   partition = this->ToSort->Stack.top();  this->ToSort->Stack.pop();
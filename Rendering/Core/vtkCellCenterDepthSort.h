@@ -32,6 +32,13 @@
 // camera transformed into object space.  It then performs an ordinary sort
 // on the result.
 //
+// By default, the cells are partially sorted as they are traversed, so the
+// first cells are returned early. With UseRadixSort, all the cells are
+// sorted at once by a parallel radix sort (see vtkSMPTools::RadixSort),
+// which is much faster for large data sets. With a ReuseAngle, the order
+// of the last complete sort is kept while the view direction stays within
+// that angle of the view direction of that sort.
+//
 
 #ifndef vtkCellCenterDepthSort_h
 #define vtkCellCenterDepthSort_h
@@ -53,6 +60,22 @@ public:
   virtual void InitTraversal();
   virtual vtkIdTypeArray *GetNextCells();
 
+  // Description:
+  // Sort all the cells in InitTraversal with a parallel radix sort instead
+  // of partially sorting them in GetNextCells. Initial value is false.
+  vtkSetMacro(UseRadixSort, bool);
+  vtkGetMacro(UseRadixSort, bool);
+  vtkBooleanMacro(UseRadixSort, bool);
+
+  // Description:
+  // Angle in degrees under which a change of the view direction does not
+  // sort the cells again: the order of the last complete sort is returned,
+  // provided the input and the sort did not change. The order is then
+  // approximate, which hides little for the small motions of interaction.
+  // Initial value is 0, the cells are sorted every time.
+  vtkSetClampMacro(ReuseAngle, double, 0.0, 90.0);
+  vtkGetMacro(ReuseAngle, double);
+
 protected:
   vtkCellCenterDepthSort();
   virtual ~vtkCellCenterDepthSort();
@@ -68,9 +91,20 @@ protected:
   virtual void ComputeCellCenters();
   virtual void ComputeDepths();
 
+  bool UseRadixSort;
+  double ReuseAngle;
+
 private:
   vtkCellCenterDepthSortStack *ToSort;
 
+  // True when SortedCells holds all the cells in order, then GetNextCells
+  // returns them from NextCell on.
+  bool FullySorted;
+  vtkIdType NextCell;
+  // Projection vector of the last complete sort, for ReuseAngle.
+  float SortedVector[3];
+  bool SortedVectorValid;
+
   vtkCellCenterDepthSort(const vtkCellCenterDepthSort &);  // Not implemented.
   void operator=(const vtkCellCenterDepthSort &);  // Not implemented.
 };
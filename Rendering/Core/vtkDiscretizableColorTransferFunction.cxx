@@ -19,6 +19,7 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPiecewiseFunction.h"
+#include "vtkSMPTools.h"
 #include "vtkTemplateAliasMacro.h"
 #include "vtkTuple.h"
 
@@ -397,18 +398,40 @@ struct VectorMagnitudeGetter
   }
 };
 
+// Map a range of tuples to opacity on each thread.  Evaluating the
+// opacity function does not modify it.
+template<typename T, typename VectorGetter>
+struct VectorToOpacityFunctor
+{
+  VectorGetter Getter;
+  T* Scalars;
+  int Component;
+  int NumberOfComponents;
+  vtkPiecewiseFunction* Opacity;
+  unsigned char* Colors;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for(vtkIdType i = begin; i < end; i++)
+      {
+      double value = this->Getter.Get(
+        this->Scalars, this->Component, this->NumberOfComponents, i);
+      double alpha = this->Opacity->GetValue(value);
+      *(this->Colors + i * 4 + 3) =
+        static_cast<unsigned char>(alpha * 255.0 + 0.5);
+      }
+  }
+};
+
 //-----------------------------------------------------------------------------
 template<typename T, typename VectorGetter>
 void vtkDiscretizableColorTransferFunction::MapVectorToOpacity (
   VectorGetter getter, T* scalars, int component,
   int numberOfComponents, vtkIdType numberOfTuples, unsigned char* colors)
 {
-  for(vtkIdType i = 0; i < numberOfTuples; i++)
-    {
-    double value = getter.Get (scalars, component, numberOfComponents, i);
-    double alpha = this->ScalarOpacityFunction->GetValue(value);
-    *(colors + i * 4 + 3) = static_cast<unsigned char>(alpha * 255.0 + 0.5);
-    }
+  VectorToOpacityFunctor<T, VectorGetter> functor = { getter, scalars,
+    component, numberOfComponents, this->ScalarOpacityFunction, colors };
+  vtkSMPTools::For(0, numberOfTuples, 16384, functor);
 }
 
 //-----------------------------------------------------------------------------
@@ -202,6 +202,7 @@ vtkHardwareSelector::vtkHardwareSelector()
   this->ProcessID = -1;
   this->InPropRender = 0;
   this->UseProcessIdFromData = false;
+  this->UseSinglePass = false;
 }
 
 //----------------------------------------------------------------------------
@@ -285,15 +286,18 @@ bool vtkHardwareSelector::CaptureBuffers()
   this->Renderer->GradientBackgroundOff();
 
   this->BeginSelection();
-  for (this->CurrentPass = MIN_KNOWN_PASS;
-    this->CurrentPass < MAX_KNOWN_PASS; this->CurrentPass++)
+  if (!this->UseSinglePass || !this->CaptureSinglePass())
     {
-    if (!this->PassRequired(this->CurrentPass))
+    for (this->CurrentPass = MIN_KNOWN_PASS;
+      this->CurrentPass < MAX_KNOWN_PASS; this->CurrentPass++)
       {
-      continue;
+      if (!this->PassRequired(this->CurrentPass))
+        {
+        continue;
+        }
+      rwin->Render();
+      this->SavePixelBuffer(this->CurrentPass);
       }
-    rwin->Render();
-    this->SavePixelBuffer(this->CurrentPass);
     }
   this->EndSelection();
 
@@ -803,5 +807,6 @@ void vtkHardwareSelector::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Renderer: " << this->Renderer << endl;
   os << indent << "UseProcessIdFromData: " << this->UseProcessIdFromData <<
     endl;
+  os << indent << "UseSinglePass: " << this->UseSinglePass << endl;
 }
 
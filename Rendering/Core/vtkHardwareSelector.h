@@ -52,6 +52,10 @@
 // During selection, visible datasets that can not be selected from are
 // temporarily hidden so as not to produce invalid indices from their colors.
 //
+// Each pass renders the scene once. With UseSinglePass, devices that can
+// render to several color buffers at once get every id from a single
+// render, see SINGLE_PASS.
+//
 // .SECTION See Also
 // vtkIdentColoredPainter
 
@@ -122,6 +126,15 @@ public:
   vtkSetMacro(UseProcessIdFromData, bool);
   vtkGetMacro(UseProcessIdFromData, bool);
 
+  // Description:
+  // Render the prop, composite, attribute and process ids in one pass
+  // instead of one pass each, when the device and every selectable prop of
+  // the renderer support it. Otherwise, the passes are rendered one after
+  // the other as usual. Initial value is false.
+  vtkSetMacro(UseSinglePass, bool);
+  vtkGetMacro(UseSinglePass, bool);
+  vtkBooleanMacro(UseSinglePass, bool);
+
   // Description:
   // Perform the selection. Returns  a new instance of vtkSelection containing
   // the selection on success.
@@ -166,7 +179,8 @@ public:
   // Description:
   // Called by vtkRenderer to render the selection pass.
   // Returns the number of props rendered.
-  int Render(vtkRenderer* renderer, vtkProp** propArray, int propArrayCount);
+  virtual int Render(vtkRenderer* renderer, vtkProp** propArray,
+    int propArrayCount);
 
   // Description:
   // Called by the mapper (vtkHardwareSelectionPolyDataPainter) before and after
@@ -227,7 +241,11 @@ public:
     ID_MID24,
     ID_HIGH16,
     MAX_KNOWN_PASS = ID_HIGH16,
-    MIN_KNOWN_PASS = PROCESS_PASS
+    MIN_KNOWN_PASS = PROCESS_PASS,
+    // Not one of the known passes: the pass of UseSinglePass, where the
+    // mappers write all the ids at once. As it follows ID_HIGH16, the
+    // tests for the attribute id passes hold for it.
+    SINGLE_PASS
     };
 
   static void Convert(int id, float tcoord[3])
@@ -319,6 +337,12 @@ protected:
   virtual void BeginSelection();
   virtual void EndSelection();
 
+  // Description:
+  // Render the SINGLE_PASS and fill the pixel buffers of all the known
+  // passes from it. Returns false when the device cannot, then the passes
+  // are rendered one by one. The default implementation returns false.
+  virtual bool CaptureSinglePass() { return false; }
+
   virtual void SavePixelBuffer(int passNo);
   void BuildPropHitList(unsigned char* rgbData);
 
@@ -329,6 +353,7 @@ protected:
   unsigned int Area[4];
   int FieldAssociation;
   bool UseProcessIdFromData;
+  bool UseSinglePass;
   vtkIdType MaxAttributeId;
 
   // At most 10 passes.
@@ -80,6 +80,10 @@ vtkMapper::vtkMapper()
   this->InterpolateScalarsBeforeMapping = 0;
   this->ColorCoordinates = 0;
   this->ColorTextureMap = 0;
+  for (int i = 0; i < 5; ++i)
+    {
+    this->ColorCoordinatesParameters[i] = 0.0;
+    }
 
   this->ForceCompileOnly=0;
 
@@ -1146,13 +1150,43 @@ void vtkMapper::MapScalarsToTexture(vtkAbstractArray* scalars, double alpha)
     tmp->Delete();
     }
 
+  int scalarComponent;
+  // Although I like the feature of applying magnitude to single component
+  // scalars, it is not how the old MapScalars for vertex coloring works.
+  if (this->LookupTable->GetVectorMode() == vtkScalarsToColors::MAGNITUDE &&
+      scalars->GetNumberOfComponents() > 1)
+    {
+    scalarComponent = -1;
+    }
+  else
+    {
+    scalarComponent = this->LookupTable->GetVectorComponent();
+    }
+
   // Create new coordinates if necessary.
-  // Need to compare lookup table incase the range has changed.
-  if (this->ColorCoordinates == 0 ||
-      this->GetMTime() > this->ColorCoordinates->GetMTime() ||
-      this->GetExecutive()->GetInputData(0, 0)->GetMTime() >
+  // Need to compare lookup table incase the range has changed. A lookup
+  // table that only changes its colors keeps the coordinates, so that
+  // the renderers do not upload them again.
+  double parameters[5];
+  parameters[0] = range[0];
+  parameters[1] = range[1];
+  parameters[2] = use_log_scale ? 1.0 : 0.0;
+  parameters[3] = scalarComponent;
+  parameters[4] = this->LookupTable->GetNumberOfAvailableColors();
+  bool parametersChanged = false;
+  for (int i = 0; i < 5; ++i)
+    {
+    if (parameters[i] != this->ColorCoordinatesParameters[i])
+      {
+      parametersChanged = true;
+      this->ColorCoordinatesParameters[i] = parameters[i];
+      }
+    }
+  if (this->ColorCoordinates == 0 || parametersChanged ||
+      this->vtkAbstractMapper::GetMTime() >
       this->ColorCoordinates->GetMTime() ||
-      this->LookupTable->GetMTime() > this->ColorCoordinates->GetMTime())
+      this->GetExecutive()->GetInputData(0, 0)->GetMTime() >
+      this->ColorCoordinates->GetMTime())
     {
     // Get rid of old colors
     if ( this->ColorCoordinates )
@@ -1169,18 +1203,6 @@ void vtkMapper::MapScalarsToTexture(vtkAbstractArray* scalars, double alpha)
     this->ColorCoordinates->SetNumberOfComponents(2);
     this->ColorCoordinates->SetNumberOfTuples(num);
     float* output = this->ColorCoordinates->GetPointer(0);
-    int scalarComponent;
-    // Although I like the feature of applying magnitude to single component
-    // scalars, it is not how the old MapScalars for vertex coloring works.
-    if (this->LookupTable->GetVectorMode() == vtkScalarsToColors::MAGNITUDE &&
-        scalars->GetNumberOfComponents() > 1)
-      {
-      scalarComponent = -1;
-      }
-    else
-      {
-      scalarComponent = this->LookupTable->GetVectorComponent();
-      }
     switch (scalars->GetDataType())
       {
       vtkTemplateMacro(
@@ -504,6 +504,10 @@ protected:
   vtkFloatArray *ColorCoordinates;
   // 1D ColorMap used for the texture image.
   vtkImageData* ColorTextureMap;
+  // The lookup table range, log scale, vector component and number of
+  // colors the coordinates were computed for. Other changes of the lookup
+  // table only rebuild the texture image.
+  double ColorCoordinatesParameters[5];
   void MapScalarsToTexture(vtkAbstractArray* scalars, double alpha);
 
   // Makes a lookup table that can be used for deferred colormaps
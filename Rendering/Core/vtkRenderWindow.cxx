@@ -1397,6 +1397,24 @@ void vtkRenderWindow::CopyResultFrame(void)
 }
 
 
+//----------------------------------------------------------------------------
+int vtkRenderWindow::QueuePixelData(int, int, int, int, int, int)
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkRenderWindow::GetQueuedPixelData(vtkUnsignedCharArray *)
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkRenderWindow::GetNumberOfQueuedPixelData()
+{
+  return 0;
+}
+
 //----------------------------------------------------------------------------
 // treat renderWindow and interactor as one object.
 // it might be easier if the GetReference count method were redefined.
@@ -359,6 +359,22 @@ public:
                                    vtkUnsignedCharArray *data, int front,
                                    int blend=0) = 0;
 
+  // Description:
+  // Asynchronous readback of the char pixels, RGB or RGBA when rgba is
+  // set. QueuePixelData() starts reading the rectangle without waiting
+  // for the GPU to finish the frame, GetQueuedPixelData() returns the
+  // oldest queued read in data, waiting for it only if it is not done
+  // yet. Reading frame N after queuing frame N+1 overlaps the transfer
+  // with the rendering. At most two reads are queued: a third one drops
+  // the oldest, as does a read of another rectangle or format.
+  // QueuePixelData() returns 0 when the window cannot read
+  // asynchronously, which is the case of this base class, and
+  // GetQueuedPixelData() returns 0 when no read is queued.
+  virtual int QueuePixelData(int x, int y, int x2, int y2, int front,
+                             int rgba);
+  virtual int GetQueuedPixelData(vtkUnsignedCharArray *data);
+  virtual int GetNumberOfQueuedPixelData();
+
   // Description:
   // Set/Get the zbuffer data from the frame buffer.
   // (x,y) is any corner of the rectangle. (x2,y2) is its opposite corner on
@@ -116,6 +116,7 @@ vtkRenderer::vtkRenderer()
   this->UseDepthPeeling=0;
   this->OcclusionRatio=0.0;
   this->MaximumNumberOfPeels=4;
+  this->UseWeightedBlendedTranslucency=0;
   this->LastRenderingUsedDepthPeeling=0;
 
   this->Selector = 0;
@@ -1411,6 +1412,9 @@ void vtkRenderer::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "MaximumNumberOfPeels: "
      << this->MaximumNumberOfPeels << "\n";
 
+  os << indent << "UseWeightedBlendedTranslucency: "
+     << (this->UseWeightedBlendedTranslucency ? "On" : "Off")<< "\n";
+
   os << indent << "LastRenderingUsedDepthPeeling: "
      << (this->LastRenderingUsedDepthPeeling ? "On" : "Off")<< "\n";
 
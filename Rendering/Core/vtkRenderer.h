@@ -471,6 +471,19 @@ public:
   vtkSetMacro(MaximumNumberOfPeels,int);
   vtkGetMacro(MaximumNumberOfPeels,int);
 
+  // Description:
+  // Turn on/off rendering of translucent material with weighted blended
+  // order independent transparency. The translucent geometry is rendered in
+  // a single pass, so it is faster than depth peeling but approximate:
+  // close layers may blend in the wrong order. It suits interactive
+  // renders, while UseDepthPeeling gives the exact result on still renders.
+  // When on and the GPU supports it, it is used instead of depth peeling.
+  // Only the OpenGL2 backend supports it.
+  // Initial value is off.
+  vtkSetMacro(UseWeightedBlendedTranslucency,int);
+  vtkGetMacro(UseWeightedBlendedTranslucency,int);
+  vtkBooleanMacro(UseWeightedBlendedTranslucency,int);
+
   // Description:
   // Tells if the last call to DeviceRenderTranslucentPolygonalGeometry()
   // actually used depth peeling.
@@ -674,6 +687,12 @@ protected:
   // It has to be a positive value.
   int MaximumNumberOfPeels;
 
+  // Description:
+  // If this flag is on, translucent materials are rendered with weighted
+  // blended order independent transparency instead of depth peeling.
+  // Initial value is off.
+  int UseWeightedBlendedTranslucency;
+
   // Description:
   // Tells if the last call to DeviceRenderTranslucentPolygonalGeometry()
   // actually used depth peeling.
@@ -19,6 +19,7 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkRenderWindow.h"
 #include "vtkRendererCollection.h"
@@ -27,6 +28,7 @@
 #include "vtkCoordinate.h"
 #include "vtkActor2D.h"
 #include "vtkActor2DCollection.h"
+#include "vtkUnsignedCharArray.h"
 #include <vector>
 
 #define BORDER_PIXELS 2
@@ -75,6 +77,7 @@ vtkWindowToImageFilter::vtkWindowToImageFilter()
   this->Viewport[3] = 1;
   this->InputBufferType = VTK_RGB;
   this->FixBoundary = false;
+  this->AsynchronousReadback = false;
 
   this->SetNumberOfInputPorts(0);
   this->SetNumberOfOutputPorts(1);
@@ -131,6 +134,7 @@ void vtkWindowToImageFilter::PrintSelf(ostream& os, vtkIndent indent)
      << "," << this->Viewport[2] << "," << this->Viewport[3] << "\n";
   os << indent << "InputBufferType: " << this->InputBufferType << "\n";
   os << indent << "FixBoundary: " << this->FixBoundary << endl;
+  os << indent << "AsynchronousReadback: " << this->AsynchronousReadback << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -356,6 +360,12 @@ void vtkWindowToImageFilter::RequestData(
       }
     }
 
+  // a single tile can be read asynchronously
+  bool asynchronous = this->AsynchronousReadback &&
+    num_iterations[0] == 1 && num_iterations[1] == 1 &&
+    this->InputBufferType != VTK_ZBUFFER;
+  vtkNew<vtkUnsignedCharArray> queuedPixels;
+
   // Precompute the tile this->Viewport for each iteration.
   double *viewports = new double[4 * num_iterations[0] * num_iterations[1]];
   for (int y = 0; y < num_iterations[1]; y++)
@@ -470,7 +480,27 @@ void vtkWindowToImageFilter::RequestData(
       if (this->InputBufferType == VTK_RGB || this->InputBufferType == VTK_RGBA)
         {
         unsigned char *pixels, *pixels1, *outPtr;
-        if (this->InputBufferType == VTK_RGB)
+        bool queued = false;
+        if (asynchronous && renWin->QueuePixelData(
+              imageBounds[0], imageBounds[1], imageBounds[2], imageBounds[3],
+              buffer, this->InputBufferType == VTK_RGBA))
+          {
+          // take the read of the previous update. Without one, wait for
+          // this read and queue it again for the next update.
+          bool first = renWin->GetNumberOfQueuedPixelData() == 1;
+          queued = renWin->GetQueuedPixelData(queuedPixels.GetPointer()) != 0;
+          if (first)
+            {
+            renWin->QueuePixelData(imageBounds[0], imageBounds[1],
+              imageBounds[2], imageBounds[3], buffer,
+              this->InputBufferType == VTK_RGBA);
+            }
+          }
+        if (queued)
+          {
+          pixels = queuedPixels->GetPointer(0);
+          }
+        else if (this->InputBufferType == VTK_RGB)
           {
           pixels = this->Input->GetPixelData(
             imageBounds[0], imageBounds[1], imageBounds[2], imageBounds[3], buffer);
@@ -527,7 +557,10 @@ void vtkWindowToImageFilter::RequestData(
           }
 
         // free the memory
-        delete [] pixels;
+        if (!queued)
+          {
+          delete [] pixels;
+          }
         }
       else
         { // VTK_ZBUFFER
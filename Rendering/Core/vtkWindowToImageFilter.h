@@ -39,6 +39,11 @@
 // 3.2 and earlier).  Connect this filter to the output of the window,
 // and filter's output to a writer such as vtkPNGWriter.
 //
+// With AsynchronousReadback on, each update starts reading the window
+// and outputs the pixels it started reading at the previous update, so
+// that the transfer overlaps the next frame instead of waiting for the
+// GPU. The output thus lags one update behind the window.
+//
 // Reading back alpha planes is dependent on the correct operation of
 // the render window's GetRGBACharPixelData method, which in turn is
 // dependent on the configuration of the window's alpha planes.  As of
@@ -112,6 +117,17 @@ public:
   void SetViewport(double*);
   vtkGetVectorMacro(Viewport,double,4);
 
+  // Description:
+  // Read RGB or RGBA pixels asynchronously, when the window supports it
+  // and there is no magnification nor tiling. Each update then outputs the
+  // window as it was at the previous update, the first update waits for
+  // the current one. Meant for capturing every frame of an animation or a
+  // remote view, where one frame of latency is better than a stall.
+  // Default is false.
+  vtkSetMacro(AsynchronousReadback, bool);
+  vtkGetMacro(AsynchronousReadback, bool);
+  vtkBooleanMacro(AsynchronousReadback, bool);
+
   // Description:
   // Set/get the window buffer from which data will be read.  Choices
   // include VTK_RGB (read the color image from the window), VTK_RGBA
@@ -146,6 +162,7 @@ protected:
   double Viewport[4];
   int InputBufferType;
   bool FixBoundary;
+  bool AsynchronousReadback;
 
   void RequestData(vtkInformation *,
                    vtkInformationVector **, vtkInformationVector *);
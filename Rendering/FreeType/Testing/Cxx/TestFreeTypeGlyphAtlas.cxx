@@ -0,0 +1,118 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestFreeTypeGlyphAtlas.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test covers the layout of vtkFreeTypeGlyphAtlas. The bounding boxes
+// of strings laid out with every justification must be the ones of
+// vtkFreeTypeTools, the glyphs must be cached once, and each glyph rectangle
+// must match its pixels in the image of the atlas.
+
+#include "vtkFreeTypeGlyphAtlas.h"
+#include "vtkFreeTypeTools.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkTextProperty.h"
+#include "vtkUnicodeString.h"
+
+int TestFreeTypeGlyphAtlas(int, char *[])
+{
+  vtkNew<vtkFreeTypeGlyphAtlas> atlas;
+  vtkNew<vtkTextProperty> tprop;
+  tprop->SetFontSize(18);
+  tprop->SetLineOffset(3);
+
+  const char *strings[] = { "VTK", "Label 42", "AVWAy_g", "Wavy" };
+  const int justifications[] = { VTK_TEXT_LEFT, VTK_TEXT_CENTERED,
+    VTK_TEXT_RIGHT };
+  const int verticalJustifications[] = { VTK_TEXT_BOTTOM, VTK_TEXT_CENTERED,
+    VTK_TEXT_TOP };
+
+  vtkNew<vtkIntArray> rects;
+  rects->SetNumberOfComponents(4);
+  vtkNew<vtkIntArray> texels;
+  texels->SetNumberOfComponents(4);
+  for (int s = 0; s < 4; ++s)
+    {
+    vtkUnicodeString str = vtkUnicodeString::from_utf8(strings[s]);
+    for (int i = 0; i < 9; ++i)
+      {
+      tprop->SetJustification(justifications[i % 3]);
+      tprop->SetVerticalJustification(verticalJustifications[i / 3]);
+      int expected[4];
+      int bbox[4];
+      vtkFreeTypeTools::GetInstance()->GetBoundingBox(
+        tprop.Get(), str, 72, expected);
+      if (!atlas->LayoutString(tprop.Get(), str, 72, rects.Get(),
+                               texels.Get(), bbox))
+        {
+        cerr << "Could not lay out \"" << strings[s] << "\"" << endl;
+        return EXIT_FAILURE;
+        }
+      for (int j = 0; j < 4; ++j)
+        {
+        if (bbox[j] != expected[j])
+          {
+          cerr << "The bounding box of \"" << strings[s] << "\" is ("
+               << bbox[0] << ", " << bbox[1] << ", " << bbox[2] << ", "
+               << bbox[3] << ") instead of (" << expected[0] << ", "
+               << expected[1] << ", " << expected[2] << ", " << expected[3]
+               << ")" << endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+  // The glyphs laid out again come from the atlas.
+  vtkIdType numGlyphs = atlas->GetNumberOfGlyphs();
+  int bbox[4];
+  atlas->LayoutString(tprop.Get(), vtkUnicodeString::from_utf8("Wavy VTK"),
+                      72, rects.Get(), texels.Get(), bbox);
+  if (atlas->GetNumberOfGlyphs() != numGlyphs)
+    {
+    cerr << "The glyphs were added again to the atlas" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkImageData *image = atlas->GetImage();
+  int dims[3];
+  image->GetDimensions(dims);
+  for (vtkIdType i = 0; i < rects->GetNumberOfTuples(); ++i)
+    {
+    int rect[4];
+    int texel[4];
+    rects->GetTupleValue(i, rect);
+    texels->GetTupleValue(i, texel);
+    if (rect[1] - rect[0] != texel[1] - texel[0] ||
+        rect[3] - rect[2] != texel[3] - texel[2] ||
+        texel[0] < 0 || texel[1] > dims[0] ||
+        texel[2] < 0 || texel[3] > dims[1])
+      {
+      cerr << "Glyph " << i << " does not match its pixels in the atlas"
+           << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Rotated strings are left to vtkTextRenderer.
+  tprop->SetOrientation(45.0);
+  if (atlas->LayoutString(tprop.Get(), vtkUnicodeString::from_utf8("VTK"),
+                          72, rects.Get(), texels.Get(), bbox))
+    {
+    cerr << "A rotated string was laid out" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,520 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFreeTypeGlyphAtlas.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkFreeTypeGlyphAtlas.h"
+
+#include "vtkFreeTypeTools.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkTextProperty.h"
+#include "vtkUnicodeString.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+//----------------------------------------------------------------------------
+class vtkFreeTypeGlyphAtlasGlyph
+{
+public:
+  vtkFreeTypeGlyphAtlasGlyph()
+    : Index(0), HasBitmap(false), Left(0), Top(0), Width(0), Rows(0),
+      Advance(0), X(0), Y(0)
+  {
+  }
+
+  FT_UInt Index;
+  bool HasBitmap;
+  // Metrics of the bitmap glyph, as used by vtkFreeTypeTools.
+  int Left;
+  int Top;
+  int Width;
+  int Rows;
+  int Advance;
+  // Lower left corner of the pixels in the atlas.
+  int X;
+  int Y;
+};
+
+//----------------------------------------------------------------------------
+class vtkFreeTypeGlyphAtlasFont
+{
+public:
+  FTC_ScalerRec Scaler;
+  bool HasKerning;
+  int Ascent;
+  int Descent;
+  std::map<vtkUnicodeStringValueType, vtkFreeTypeGlyphAtlasGlyph> Glyphs;
+  std::map<std::pair<FT_UInt, FT_UInt>, int> Kernings;
+};
+
+//----------------------------------------------------------------------------
+class vtkFreeTypeGlyphAtlasInternals
+{
+public:
+  vtkFreeTypeGlyphAtlasInternals()
+    : ShelfX(0), ShelfY(0), ShelfHeight(0)
+  {
+  }
+
+  // The fonts, by family, bold, italic, size and DPI.
+  struct FontKey
+  {
+    std::string Family;
+    int Style[4];
+
+    bool operator<(const FontKey &other) const
+    {
+      if (this->Family != other.Family)
+        {
+        return this->Family < other.Family;
+        }
+      return std::lexicographical_compare(this->Style, this->Style + 4,
+                                          other.Style, other.Style + 4);
+    }
+  };
+  std::map<FontKey, vtkFreeTypeGlyphAtlasFont> Fonts;
+
+  // The glyphs are packed in shelves, from the bottom of the image. The
+  // coverage of the rows used so far, ImageWidth bytes per row.
+  std::vector<unsigned char> Coverage;
+  int ShelfX;
+  int ShelfY;
+  int ShelfHeight;
+
+  // The glyphs of the string being laid out, relative to the pen.
+  std::vector<int> Rects;
+  std::vector<int> Texels;
+};
+
+vtkStandardNewMacro(vtkFreeTypeGlyphAtlas);
+
+//----------------------------------------------------------------------------
+vtkFreeTypeGlyphAtlas::vtkFreeTypeGlyphAtlas()
+{
+  this->ImageWidth = 1024;
+  this->Image = vtkImageData::New();
+  this->Internals = new vtkFreeTypeGlyphAtlasInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkFreeTypeGlyphAtlas::~vtkFreeTypeGlyphAtlas()
+{
+  this->Image->Delete();
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+bool vtkFreeTypeGlyphAtlas::CanLayoutString(vtkTextProperty *tprop,
+                                            const vtkUnicodeString &str)
+{
+  if (!tprop || tprop->GetOrientation() != 0.0 || tprop->GetShadow() ||
+      static_cast<unsigned char>(tprop->GetBackgroundOpacity() * 255) > 0)
+    {
+    return false;
+    }
+  // Math text is rendered by another backend of vtkTextRenderer.
+  for (vtkUnicodeString::const_iterator it = str.begin(); it != str.end();
+       ++it)
+    {
+    if (*it == '\n' || *it == '$')
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkFreeTypeGlyphAtlas::LayoutString(vtkTextProperty *tprop,
+                                         const vtkUnicodeString &str, int dpi,
+                                         vtkIntArray *rects,
+                                         vtkIntArray *texels, int bbox[4])
+{
+  if (!rects || !texels || rects->GetNumberOfComponents() != 4 ||
+      texels->GetNumberOfComponents() != 4)
+    {
+    vtkErrorMacro("The glyphs need two arrays of 4 components.");
+    return false;
+    }
+  return this->Layout(tprop, str, dpi, rects, texels, bbox);
+}
+
+//----------------------------------------------------------------------------
+bool vtkFreeTypeGlyphAtlas::GetBoundingBox(vtkTextProperty *tprop,
+                                           const vtkUnicodeString &str,
+                                           int dpi, int bbox[4])
+{
+  return this->Layout(tprop, str, dpi, NULL, NULL, bbox);
+}
+
+//----------------------------------------------------------------------------
+bool vtkFreeTypeGlyphAtlas::Layout(vtkTextProperty *tprop,
+                                   const vtkUnicodeString &str, int dpi,
+                                   vtkIntArray *rects, vtkIntArray *texels,
+                                   int bbox[4])
+{
+  if (!vtkFreeTypeGlyphAtlas::CanLayoutString(tprop, str))
+    {
+    return false;
+    }
+  if (str.empty())
+    {
+    std::fill(bbox, bbox + 4, 0);
+    return true;
+    }
+  vtkFreeTypeGlyphAtlasFont *font = this->GetFont(tprop, dpi);
+  if (!font)
+    {
+    return false;
+    }
+
+  // Lay out the line from its origin, as vtkFreeTypeTools::GetLineMetrics.
+  std::vector<int> &glyphRects = this->Internals->Rects;
+  std::vector<int> &glyphTexels = this->Internals->Texels;
+  glyphRects.clear();
+  glyphTexels.clear();
+  int pen = 0;
+  int width = 0;
+  int lineBbox[4] = { 0, 0, 0, 0 };
+  FT_UInt previousIndex = 0;
+  for (vtkUnicodeString::const_iterator it = str.begin(); it != str.end();
+       ++it)
+    {
+    vtkFreeTypeGlyphAtlasGlyph *glyph = this->GetGlyph(font, *it);
+    if (font->HasKerning && previousIndex && glyph->Index)
+      {
+      int kerning = this->GetKerning(font, previousIndex, glyph->Index);
+      pen += kerning;
+      width += kerning;
+      }
+    previousIndex = glyph->Index;
+    if (!glyph->HasBitmap)
+      {
+      continue;
+      }
+
+    lineBbox[0] = std::min(lineBbox[0], pen + glyph->Left);
+    lineBbox[1] = std::max(lineBbox[1], pen + glyph->Left + glyph->Width);
+    lineBbox[2] = std::min(lineBbox[2], glyph->Top - 1 - glyph->Rows);
+    lineBbox[3] = std::max(lineBbox[3], glyph->Top - 1);
+    if (rects && glyph->Width && glyph->Rows)
+      {
+      glyphRects.push_back(pen + glyph->Left);
+      glyphRects.push_back(pen + glyph->Left + glyph->Width);
+      glyphRects.push_back(glyph->Top - glyph->Rows);
+      glyphRects.push_back(glyph->Top);
+      glyphTexels.push_back(glyph->X);
+      glyphTexels.push_back(glyph->X + glyph->Width);
+      glyphTexels.push_back(glyph->Y);
+      glyphTexels.push_back(glyph->Y + glyph->Rows);
+      }
+
+    pen += glyph->Advance;
+    width += glyph->Advance;
+    }
+
+  // Place the line in the justified box of the text, as
+  // vtkFreeTypeTools::CalculateBoundingBox does for one unrotated line.
+  int height = font->Ascent - font->Descent;
+  int fullHeight = static_cast<int>(height + tprop->GetLineOffset());
+  int corner[2] = { 0, 0 };
+  switch (tprop->GetJustification())
+    {
+    case VTK_TEXT_CENTERED:
+      corner[0] = -static_cast<int>(width * 0.5);
+      break;
+    case VTK_TEXT_RIGHT:
+      corner[0] = -width;
+      break;
+    default:
+      break;
+    }
+  switch (tprop->GetVerticalJustification())
+    {
+    case VTK_TEXT_CENTERED:
+      corner[1] = -static_cast<int>(fullHeight * 0.5);
+      break;
+    case VTK_TEXT_TOP:
+      corner[1] = -fullHeight;
+      break;
+    default:
+      break;
+    }
+  int origin[2] = { corner[0], corner[1] + fullHeight +
+    static_cast<int>(-font->Ascent - tprop->GetLineOffset()) };
+
+  // The bounding box of the line includes its origin.
+  bbox[0] = std::min(origin[0] + lineBbox[0],
+                     std::min(corner[0], corner[0] + width));
+  bbox[1] = std::max(origin[0] + lineBbox[1],
+                     std::max(corner[0], corner[0] + width));
+  bbox[2] = std::min(origin[1] + lineBbox[2],
+                     std::min(corner[1], corner[1] + fullHeight));
+  bbox[3] = std::max(origin[1] + lineBbox[3],
+                     std::max(corner[1], corner[1] + fullHeight));
+
+  if (rects)
+    {
+    for (size_t i = 0; i < glyphRects.size(); i += 4)
+      {
+      int rect[4] = { glyphRects[i] + origin[0], glyphRects[i + 1] + origin[0],
+        glyphRects[i + 2] + origin[1], glyphRects[i + 3] + origin[1] };
+      rects->InsertNextTupleValue(rect);
+      texels->InsertNextTupleValue(&glyphTexels[i]);
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkFreeTypeGlyphAtlasFont *vtkFreeTypeGlyphAtlas::GetFont(
+  vtkTextProperty *tprop, int dpi)
+{
+  vtkFreeTypeGlyphAtlasInternals::FontKey key;
+  const char *family = tprop->GetFontFamily() != VTK_FONT_FILE ?
+    tprop->GetFontFamilyAsString() : tprop->GetFontFile();
+  key.Family = family ? family : "";
+  key.Style[0] = tprop->GetBold();
+  key.Style[1] = tprop->GetItalic();
+  key.Style[2] = tprop->GetFontSize();
+  key.Style[3] = dpi;
+
+  std::map<vtkFreeTypeGlyphAtlasInternals::FontKey,
+    vtkFreeTypeGlyphAtlasFont>::iterator it =
+      this->Internals->Fonts.find(key);
+  if (it != this->Internals->Fonts.end())
+    {
+    return &it->second;
+    }
+
+  // The scaler of vtkFreeTypeTools::PrepareMetaData.
+  vtkFreeTypeTools *tools = vtkFreeTypeTools::GetInstance();
+  size_t tpropCacheId;
+  tools->MapTextPropertyToId(tprop, &tpropCacheId);
+  vtkFreeTypeGlyphAtlasFont font;
+  font.Scaler.face_id = reinterpret_cast<FTC_FaceID>(tpropCacheId);
+  font.Scaler.width = tprop->GetFontSize() * 64; // 26.6 format point size
+  font.Scaler.height = tprop->GetFontSize() * 64;
+  font.Scaler.pixel = 0;
+  font.Scaler.x_res = dpi;
+  font.Scaler.y_res = dpi;
+  FT_Size size;
+  if (!tools->GetSize(&font.Scaler, &size))
+    {
+    vtkErrorMacro("Failed loading the font " << key.Family);
+    return NULL;
+    }
+  font.HasKerning = (FT_HAS_KERNING(size->face) != 0);
+  font.Ascent = 0;
+  font.Descent = 0;
+  vtkFreeTypeGlyphAtlasFont *result =
+    &this->Internals->Fonts.insert(std::make_pair(key, font)).first->second;
+
+  // The line height of vtkFreeTypeTools::CalculateBoundingBox.
+  for (const char *heightString = "_/7Agfy"; *heightString; ++heightString)
+    {
+    vtkFreeTypeGlyphAtlasGlyph *glyph = this->GetGlyph(result, *heightString);
+    if (glyph->HasBitmap)
+      {
+      result->Ascent = std::max(glyph->Top - 1, result->Ascent);
+      result->Descent = std::min(-(glyph->Rows - (glyph->Top - 1)),
+                                 result->Descent);
+      }
+    }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+vtkFreeTypeGlyphAtlasGlyph *vtkFreeTypeGlyphAtlas::GetGlyph(
+  vtkFreeTypeGlyphAtlasFont *font, unsigned int c)
+{
+  std::map<vtkUnicodeStringValueType, vtkFreeTypeGlyphAtlasGlyph>::iterator
+    it = font->Glyphs.find(c);
+  if (it != font->Glyphs.end())
+    {
+    return &it->second;
+    }
+
+  vtkFreeTypeGlyphAtlasGlyph &glyph = font->Glyphs[c];
+  FT_BitmapGlyph bitmapGlyph = NULL;
+  FT_Bitmap *bitmap = vtkFreeTypeTools::GetInstance()->GetBitmap(
+    c, &font->Scaler, glyph.Index, bitmapGlyph);
+  if (!bitmap)
+    {
+    vtkDebugMacro(<< "Unrecognized character: " << c);
+    return &glyph;
+    }
+  glyph.HasBitmap = true;
+  glyph.Left = bitmapGlyph->left;
+  glyph.Top = bitmapGlyph->top;
+  glyph.Width = static_cast<int>(bitmap->width);
+  glyph.Rows = static_cast<int>(bitmap->rows);
+  glyph.Advance = (bitmapGlyph->root.advance.x + 0x8000) >> 16;
+  if (glyph.Width == 0 || glyph.Rows == 0)
+    {
+    return &glyph;
+    }
+  if (glyph.Width >= this->ImageWidth)
+    {
+    vtkWarningMacro("The glyph of " << c << " is wider than the atlas.");
+    glyph.Width = 0;
+    return &glyph;
+    }
+
+  // Start a new shelf if the glyph does not fit on the current one. A
+  // pixel is left between the glyphs.
+  vtkFreeTypeGlyphAtlasInternals *internals = this->Internals;
+  if (internals->ShelfX + glyph.Width + 1 > this->ImageWidth)
+    {
+    internals->ShelfY += internals->ShelfHeight;
+    internals->ShelfX = 0;
+    internals->ShelfHeight = 0;
+    }
+  glyph.X = internals->ShelfX;
+  glyph.Y = internals->ShelfY;
+  internals->ShelfX += glyph.Width + 1;
+  internals->ShelfHeight = std::max(internals->ShelfHeight, glyph.Rows + 1);
+
+  size_t usedSize = static_cast<size_t>(glyph.Y + glyph.Rows) *
+    this->ImageWidth;
+  if (internals->Coverage.size() < usedSize)
+    {
+    internals->Coverage.resize(usedSize, 0);
+    }
+
+  // The first row of the bitmap is the top one.
+  const unsigned char *bitmapRow = bitmap->buffer;
+  for (int j = glyph.Rows - 1; j >= 0; --j)
+    {
+    std::copy(bitmapRow, bitmapRow + glyph.Width, internals->Coverage.begin() +
+              (glyph.Y + j) * this->ImageWidth + glyph.X);
+    bitmapRow += bitmap->pitch;
+    }
+  this->Modified();
+  return &glyph;
+}
+
+//----------------------------------------------------------------------------
+int vtkFreeTypeGlyphAtlas::GetKerning(vtkFreeTypeGlyphAtlasFont *font,
+                                      unsigned int left, unsigned int right)
+{
+  std::pair<FT_UInt, FT_UInt> pair(left, right);
+  std::map<std::pair<FT_UInt, FT_UInt>, int>::iterator it =
+    font->Kernings.find(pair);
+  if (it != font->Kernings.end())
+    {
+    return it->second;
+    }
+
+  int kerning = 0;
+  FT_Size size;
+  FT_Vector delta;
+  if (vtkFreeTypeTools::GetInstance()->GetSize(&font->Scaler, &size) &&
+      FT_Get_Kerning(size->face, left, right, FT_KERNING_DEFAULT,
+                     &delta) == 0)
+    {
+    kerning = delta.x >> 6;
+    }
+  font->Kernings[pair] = kerning;
+  return kerning;
+}
+
+//----------------------------------------------------------------------------
+vtkImageData *vtkFreeTypeGlyphAtlas::GetImage()
+{
+  if (this->ImageTime > this->GetMTime())
+    {
+    return this->Image;
+    }
+
+  int rows = static_cast<int>(this->Internals->Coverage.size() /
+                              this->ImageWidth);
+  int height = 1;
+  while (height < rows)
+    {
+    height *= 2;
+    }
+  this->Image->SetDimensions(this->ImageWidth, height, 1);
+  this->Image->AllocateScalars(VTK_UNSIGNED_CHAR, 4);
+  unsigned char *pixel =
+    static_cast<unsigned char*>(this->Image->GetScalarPointer());
+  std::vector<unsigned char>::const_iterator coverage =
+    this->Internals->Coverage.begin();
+  vtkIdType numPixels = static_cast<vtkIdType>(this->ImageWidth) * height;
+  for (vtkIdType i = 0; i < numPixels; ++i, pixel += 4)
+    {
+    pixel[0] = pixel[1] = pixel[2] = 255;
+    if (coverage != this->Internals->Coverage.end())
+      {
+      pixel[3] = *coverage++;
+      }
+    else
+      {
+      pixel[3] = 0;
+      }
+    }
+  this->Image->Modified();
+  this->ImageTime.Modified();
+  return this->Image;
+}
+
+//----------------------------------------------------------------------------
+void vtkFreeTypeGlyphAtlas::SetImageWidth(int width)
+{
+  width = std::max(width, 64);
+  if (width != this->ImageWidth)
+    {
+    this->ImageWidth = width;
+    this->Clear();
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkFreeTypeGlyphAtlas::GetNumberOfGlyphs()
+{
+  vtkIdType numGlyphs = 0;
+  std::map<vtkFreeTypeGlyphAtlasInternals::FontKey,
+    vtkFreeTypeGlyphAtlasFont>::const_iterator it;
+  for (it = this->Internals->Fonts.begin();
+       it != this->Internals->Fonts.end(); ++it)
+    {
+    numGlyphs += static_cast<vtkIdType>(it->second.Glyphs.size());
+    }
+  return numGlyphs;
+}
+
+//----------------------------------------------------------------------------
+void vtkFreeTypeGlyphAtlas::Clear()
+{
+  vtkFreeTypeGlyphAtlasInternals *internals = this->Internals;
+  internals->Fonts.clear();
+  internals->Coverage.clear();
+  internals->ShelfX = 0;
+  internals->ShelfY = 0;
+  internals->ShelfHeight = 0;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkFreeTypeGlyphAtlas::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ImageWidth: " << this->ImageWidth << endl;
+  os << indent << "NumberOfGlyphs: " << this->GetNumberOfGlyphs() << endl;
+}
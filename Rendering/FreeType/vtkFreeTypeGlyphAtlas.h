@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFreeTypeGlyphAtlas.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkFreeTypeGlyphAtlas - pack the glyphs rasterized by FreeType in a
+// single image
+// .SECTION Description
+// vtkFreeTypeGlyphAtlas rasterizes each glyph once per font and DPI, with
+// vtkFreeTypeTools, and packs it in the rows of an image shared by all the
+// strings laid out with the atlas. The metrics of the glyphs and the kerning
+// of their pairs are cached with them, so a string made of glyphs already in
+// the atlas is laid out without FreeType. Many short strings can then be
+// drawn at once, as textured quads of a single vertex buffer.
+//
+// Only the font family (or file), size, bold and italic of the text
+// property select the glyphs. The image is white, with the coverage of the
+// glyphs in its alpha: the text color and opacity are left to the caller,
+// e.g. as point colors modulated by the texture.
+//
+// .SECTION Caveats
+// Only single line, unrotated strings without shadow or background are
+// laid out. Other strings must be rendered with vtkTextRenderer.
+//
+// .SECTION See Also
+// vtkFreeTypeTools vtkFreeTypeLabelRenderStrategy
+
+#ifndef vtkFreeTypeGlyphAtlas_h
+#define vtkFreeTypeGlyphAtlas_h
+
+#include "vtkRenderingFreeTypeModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkImageData;
+class vtkIntArray;
+class vtkTextProperty;
+class vtkUnicodeString;
+class vtkFreeTypeGlyphAtlasFont;
+class vtkFreeTypeGlyphAtlasGlyph;
+class vtkFreeTypeGlyphAtlasInternals;
+
+class VTKRENDERINGFREETYPE_EXPORT vtkFreeTypeGlyphAtlas : public vtkObject
+{
+public:
+  static vtkFreeTypeGlyphAtlas *New();
+  vtkTypeMacro(vtkFreeTypeGlyphAtlas, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Return whether a string with this text property can be laid out by the
+  // atlas: it must have a single line, no orientation, no shadow and no
+  // background.
+  static bool CanLayoutString(vtkTextProperty *tprop,
+                              const vtkUnicodeString &str);
+
+  // Description:
+  // Lay out a string as vtkFreeTypeTools renders it, anchored at (0, 0)
+  // with the justification and the line offset of the text property, and
+  // add its missing glyphs to the atlas. For each glyph with pixels, the
+  // rectangle it covers in pixels (xmin, xmax, ymin, ymax) is appended to
+  // rects, and the rectangle of its pixels in the image of the atlas to
+  // texels: both arrays must have 4 components. The bounding box of the
+  // string, as computed by vtkFreeTypeTools::GetBoundingBox, is stored in
+  // bbox. Return false if the string can not be laid out by the atlas or if
+  // the font could not be loaded.
+  bool LayoutString(vtkTextProperty *tprop, const vtkUnicodeString &str,
+                    int dpi, vtkIntArray *rects, vtkIntArray *texels,
+                    int bbox[4]);
+
+  // Description:
+  // Compute the bounding box of a string as LayoutString() does, without
+  // appending its glyphs.
+  bool GetBoundingBox(vtkTextProperty *tprop, const vtkUnicodeString &str,
+                      int dpi, int bbox[4]);
+
+  // Description:
+  // The RGBA image holding the glyphs, updated on demand. Its width is
+  // ImageWidth and its height the next power of two that holds the rows of
+  // glyphs. Texels already returned by LayoutString() remain valid as the
+  // image grows, until Clear() is called.
+  vtkImageData *GetImage();
+
+  // Description:
+  // The width, in pixels, of the image of the atlas. Changing it clears the
+  // atlas. Initial value is 1024.
+  void SetImageWidth(int width);
+  vtkGetMacro(ImageWidth, int);
+
+  // Description:
+  // Return the number of glyphs cached, including those without pixels.
+  vtkIdType GetNumberOfGlyphs();
+
+  // Description:
+  // Remove all the glyphs from the atlas.
+  void Clear();
+
+protected:
+  vtkFreeTypeGlyphAtlas();
+  ~vtkFreeTypeGlyphAtlas();
+
+  // Get the font of the text property, loading it if needed.
+  vtkFreeTypeGlyphAtlasFont *GetFont(vtkTextProperty *tprop, int dpi);
+
+  // Get a glyph of a font, adding it to the atlas if needed.
+  vtkFreeTypeGlyphAtlasGlyph *GetGlyph(vtkFreeTypeGlyphAtlasFont *font,
+                                       unsigned int c);
+
+  // Get the kerning between two glyphs of a font.
+  int GetKerning(vtkFreeTypeGlyphAtlasFont *font, unsigned int left,
+                 unsigned int right);
+
+  // Shared by LayoutString() and GetBoundingBox().
+  bool Layout(vtkTextProperty *tprop, const vtkUnicodeString &str, int dpi,
+              vtkIntArray *rects, vtkIntArray *texels, int bbox[4]);
+
+  int ImageWidth;
+  vtkImageData *Image;
+  vtkTimeStamp ImageTime;
+
+  vtkFreeTypeGlyphAtlasInternals *Internals;
+
+private:
+  vtkFreeTypeGlyphAtlas(const vtkFreeTypeGlyphAtlas&);  // Not implemented.
+  void operator=(const vtkFreeTypeGlyphAtlas&);  // Not implemented.
+};
+
+#endif
@@ -196,6 +196,9 @@ public:
   static bool LookupFace(vtkTextProperty *tprop, FT_Library lib, FT_Face *face);
 
 protected:
+  // The glyph atlas rasterizes its glyphs with the caches of the instance.
+  friend class vtkFreeTypeGlyphAtlas;
+
   // Description:
   // Create the FreeType Cache manager instance and set this->CacheManager
   virtual FT_Error CreateFTCManager();
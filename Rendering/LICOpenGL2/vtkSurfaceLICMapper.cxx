@@ -26,6 +26,8 @@
 #include "vtkGenericDataObjectReader.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
+#include "vtkLight.h"
+#include "vtkLightCollection.h"
 #include "vtkLineIntegralConvolution2D.h"
 #include "vtkMath.h"
 #include "vtkMatrix3x3.h"
@@ -813,6 +815,12 @@ public:
   long long LastInputDataSetMTime;
   long long LastPropertyMTime;
   long long LastLUTMTime;
+  long long LastCameraMTime;
+  long long LastMatrixMTime;
+  long long LastLightingMTime;
+  int ViewOrigin[2];
+  double Background[7];
+  bool Interactive;
 
   deque<vtkPixelExtent> BlockExts;
   vtkPixelExtent DataSetExt;
@@ -821,6 +829,7 @@ public:
   bool OutputDataNeedsUpdate;
   bool CommunicatorNeedsUpdate;
   bool GeometryNeedsUpdate;
+  bool VectorsNeedUpdate;
   bool GatherNeedsUpdate;
   bool LICNeedsUpdate;
   bool ColorNeedsUpdate;
@@ -868,12 +877,22 @@ public:
     this->LastInputDataSetMTime = 0;
     this->LastPropertyMTime = 0;
     this->LastLUTMTime = 0;
+    this->LastCameraMTime = 0;
+    this->LastMatrixMTime = 0;
+    this->LastLightingMTime = 0;
+    this->ViewOrigin[0] = this->ViewOrigin[1] = 0;
+    for (int i = 0; i < 7; ++i)
+      {
+      this->Background[i] = -1.0;
+      }
+    this->Interactive = false;
     this->GLSupport = false;
 
     this->ContextNeedsUpdate = true;
     this->OutputDataNeedsUpdate = true;
     this->CommunicatorNeedsUpdate = true;
     this->GeometryNeedsUpdate = true;
+    this->VectorsNeedUpdate = true;
     this->LICNeedsUpdate = true;
     this->GatherNeedsUpdate = true;
     this->ColorNeedsUpdate = true;
@@ -957,13 +976,15 @@ public:
     {
     this->ClearTextures();
 
+    this->NoiseImage = NULL;
     this->Compositor = NULL;
     this->LICer = NULL;
     this->FBO = NULL;
     }
 
   // Description:
-  // Free textures we're holding a reference to.
+  // Free the screen size textures we're holding a reference to. The
+  // noise texture does not depend on the viewport and is kept.
   void ClearTextures()
     {
     this->DepthImage = NULL;
@@ -972,7 +993,6 @@ public:
     this->MaskVectorImage = NULL;
     this->CompositeVectorImage = NULL;
     this->CompositeMaskVectorImage = NULL;
-    this->NoiseImage = NULL;
     this->LICImage = NULL;
     this->RGBColorImage = NULL;
     this->HSLColorImage = NULL;
@@ -1064,6 +1084,7 @@ public:
     this->OutputDataNeedsUpdate = false;
     this->CommunicatorNeedsUpdate = false;
     this->GeometryNeedsUpdate = false;
+    this->VectorsNeedUpdate = false;
     this->GatherNeedsUpdate = false;
     this->LICNeedsUpdate = false;
     this->ColorNeedsUpdate = false;
@@ -1078,6 +1099,7 @@ public:
     this->OutputDataNeedsUpdate= true;
     this->CommunicatorNeedsUpdate= true;
     this->GeometryNeedsUpdate= true;
+    this->VectorsNeedUpdate= true;
     this->GatherNeedsUpdate= true;
     this->LICNeedsUpdate= true;
     this->ColorNeedsUpdate= true;
@@ -1173,19 +1195,70 @@ public:
     vtkOpenGLStaticCheckErrorMacro("failed at RenderQuad");
   }
 
-  // always return true as these state monitors do not exist in the
-  // new backend
-  bool LightingChanged()
-    {
-    return true;
+  // Description:
+  // Detect changes to the lights of the renderer. They change the
+  // shading of the surface but not the projected vectors.
+  bool LightingChanged(vtkRenderer *ren)
+    {
+    long long lightingMTime = 0;
+    vtkLightCollection *lights = ren->GetLights();
+    vtkCollectionSimpleIterator lit;
+    lights->InitTraversal(lit);
+    while (vtkLight *light = lights->GetNextLight(lit))
+      {
+      long long lightMTime = light->GetMTime();
+      lightingMTime = std::max(lightingMTime, lightMTime);
+      }
+    lightingMTime = std::max(lightingMTime,
+      static_cast<long long>(lights->GetMTime()));
+    if (lightingMTime != this->LastLightingMTime)
+      {
+      this->LastLightingMTime = lightingMTime;
+      return true;
+      }
+    return false;
     }
-  bool ViewChanged()
-    {
-    return true;
+
+  // Description:
+  // Detect changes to the camera, to the actor's transform or to the
+  // position of the viewport, which move the projected vectors.
+  bool ViewChanged(vtkRenderer *ren, vtkActor *act)
+    {
+    long long cameraMTime = ren->GetActiveCamera()->GetMTime();
+    long long matrixMTime = act->GetMatrix()->GetMTime();
+    int viewsize[2];
+    int origin[2];
+    ren->GetTiledSizeAndOrigin(
+      &viewsize[0], &viewsize[1], &origin[0], &origin[1]);
+    if ( (cameraMTime != this->LastCameraMTime)
+      || (matrixMTime != this->LastMatrixMTime)
+      || (origin[0] != this->ViewOrigin[0])
+      || (origin[1] != this->ViewOrigin[1]) )
+      {
+      this->LastCameraMTime = cameraMTime;
+      this->LastMatrixMTime = matrixMTime;
+      this->ViewOrigin[0] = origin[0];
+      this->ViewOrigin[1] = origin[1];
+      return true;
+      }
+    return false;
     }
-  bool BackgroundChanged(vtkRenderer *)
-    {
-    return true;
+
+  // Description:
+  // Detect changes to the background, which is blended with the
+  // geometry image.
+  bool BackgroundChanged(vtkRenderer *ren)
+    {
+    double bg[7];
+    ren->GetBackground(bg);
+    ren->GetBackground2(bg+3);
+    bg[6] = ren->GetGradientBackground();
+    if (!std::equal(bg, bg+7, this->Background))
+      {
+      std::copy(bg, bg+7, this->Background);
+      return true;
+      }
+    return false;
     }
 
   // Description:
@@ -1484,6 +1557,10 @@ vtkSurfaceLICMapper::vtkSurfaceLICMapper()
   this->Enable = 1;
   this->AlwaysUpdate = 0;
 
+  this->InteractiveMode = 0;
+  this->InteractiveUpdateRate = 1.0;
+  this->InteractiveNumberOfSteps = 5;
+
   this->StepSize = 1;
   this->NumberOfSteps = 20;
   this->NormalizeVectors = 1;
@@ -1584,6 +1661,9 @@ void vtkSurfaceLICMapper::ShallowCopy(vtkAbstractMapper *mapper)
     this->SetMaskThreshold(m->GetMaskThreshold());
     this->SetMaskIntensity(m->GetMaskIntensity());
     this->SetMaskColor(m->GetMaskColor());
+    this->SetInteractiveMode(m->GetInteractiveMode());
+    this->SetInteractiveUpdateRate(m->GetInteractiveUpdateRate());
+    this->SetInteractiveNumberOfSteps(m->GetInteractiveNumberOfSteps());
     this->SetInputArrayToProcess(0,
       m->GetInputArrayInformation(0));
     }
@@ -1767,7 +1847,15 @@ vtkSetMonitoredParameterMacro(
       int,
       val = val < 0 ? 0 : val;
       val = val > 1 ? 1 : val;
-      this->Internals->GeometryNeedsUpdate = true;)
+      this->Internals->VectorsNeedUpdate = true;)
+
+// interactive lic
+vtkSetMonitoredParameterMacro(
+      InteractiveNumberOfSteps,
+      int,
+      val = val < 1 ? 1 : val;
+      this->Internals->GatherNeedsUpdate = true;
+      this->Internals->LICNeedsUpdate = true;)
 
 // colors
 vtkSetMonitoredParameterMacro(
@@ -2197,7 +2285,7 @@ bool vtkSurfaceLICMapper::NeedToComputeLIC()
 {
   if ( this->Internals->LICNeedsUpdate
     || this->Internals->GatherNeedsUpdate
-    || this->Internals->GeometryNeedsUpdate
+    || this->Internals->VectorsNeedUpdate
     || this->Internals->CommunicatorNeedsUpdate
     || this->Internals->OutputDataNeedsUpdate
     || this->Internals->ContextNeedsUpdate
@@ -2218,7 +2306,7 @@ bool vtkSurfaceLICMapper::NeedToComputeLIC()
 bool vtkSurfaceLICMapper::NeedToGatherVectors()
 {
   if ( this->Internals->GatherNeedsUpdate
-    || this->Internals->GeometryNeedsUpdate
+    || this->Internals->VectorsNeedUpdate
     || this->Internals->OutputDataNeedsUpdate
     || this->Internals->CommunicatorNeedsUpdate
     || this->Internals->ContextNeedsUpdate
@@ -2253,17 +2341,24 @@ bool vtkSurfaceLICMapper::NeedToRenderGeometry(
     }
 
   // lights changed
-  if ( this->Internals->LightingChanged() )
+  if ( this->Internals->LightingChanged(renderer) )
     {
     this->Internals->GeometryNeedsUpdate = true;
     }
 
-  // props changed
+  // props changed. the representation may change what is
+  // rasterized, so the vectors are projected again as well.
   long long propMTime = actor->GetProperty()->GetMTime();
   if ( this->Internals->LastPropertyMTime != propMTime )
     {
     this->Internals->LastPropertyMTime = propMTime;
     this->Internals->GeometryNeedsUpdate = true;
+    this->Internals->VectorsNeedUpdate = true;
+    }
+
+  if ( this->Internals->VectorsNeedUpdate )
+    {
+    this->Internals->GeometryNeedsUpdate = true;
     }
 
   // background colors changed
@@ -2329,7 +2424,9 @@ bool vtkSurfaceLICMapper::NeedToUpdateOutputData()
 }
 
 //----------------------------------------------------------------------------
-void vtkSurfaceLICMapper::ValidateContext(vtkRenderer *renderer)
+void vtkSurfaceLICMapper::ValidateContext(
+      vtkRenderer *renderer,
+      vtkActor *actor)
 {
   bool modified = false;
 
@@ -2365,7 +2462,7 @@ void vtkSurfaceLICMapper::ValidateContext(vtkRenderer *renderer)
     }
 
   // view changed
-  if (this->Internals->ViewChanged())
+  if (this->Internals->ViewChanged(renderer, actor))
     {
     modified = true;
     }
@@ -2376,6 +2473,17 @@ void vtkSurfaceLICMapper::ValidateContext(vtkRenderer *renderer)
     this->Internals->UpdateAll();
     }
 
+  // switching between interactive and still renders changes the
+  // integration, but the projected vectors are still valid
+  bool interactive = this->InteractiveMode
+    && (context->GetDesiredUpdateRate() >= this->InteractiveUpdateRate);
+  if (interactive != this->Internals->Interactive)
+    {
+    this->Internals->Interactive = interactive;
+    this->Internals->GatherNeedsUpdate = true;
+    this->Internals->LICNeedsUpdate = true;
+    }
+
   #if vtkSurfaceLICMapperDEBUG >= 1
   cerr
     << this->Internals->Communicator->GetWorldRank()
@@ -2434,7 +2542,10 @@ void vtkSurfaceLICMapper::ProcessInformation(
   if (lut && ((lutMTime = lut->GetMTime()) > this->Internals->LastLUTMTime))
     {
     this->Internals->LastLUTMTime = lutMTime;
-    this->Internals->UpdateAll();
+    // scalar colors are rasterized with the geometry, the
+    // vectors and the LIC computed from them are still valid
+    this->Internals->GeometryNeedsUpdate = true;
+    this->Internals->ColorNeedsUpdate = true;
     #if vtkSurfaceLICMapperDEBUG >= 1
     LUTNeedsUpdate = true;
     #endif
@@ -2534,7 +2645,7 @@ void vtkSurfaceLICMapper::RenderPiece(
 
   vtkOpenGLClearErrorMacro();
 
-  this->ValidateContext(renderer);
+  this->ValidateContext(renderer, actor);
   vtkOpenGLRenderWindow *renWin =
     vtkOpenGLRenderWindow::SafeDownCast(renderer->GetVTKWindow());
 
@@ -2592,6 +2703,29 @@ void vtkSurfaceLICMapper::RenderPiece(
         this->Internals->Viewsize[0],
         this->Internals->Viewsize[1]);
 
+  // while interacting integrate over the same arc length with fewer,
+  // longer steps, and skip the second LIC pass and its contrast
+  // enhancement. the full integration is done on the next still render.
+  int numberOfSteps = this->NumberOfSteps;
+  double stepSizePx = this->StepSize;
+  int enhancedLIC = this->EnhancedLIC;
+  int enhanceContrast = this->EnhanceContrast;
+  if ( this->Internals->Interactive
+    && (this->InteractiveNumberOfSteps < this->NumberOfSteps) )
+    {
+    numberOfSteps = this->InteractiveNumberOfSteps;
+    stepSizePx *= static_cast<double>(this->NumberOfSteps)/numberOfSteps;
+    enhancedLIC = 0;
+    if (enhanceContrast == ENHANCE_CONTRAST_LIC)
+      {
+      enhanceContrast = ENHANCE_CONTRAST_OFF;
+      }
+    else if (enhanceContrast == ENHANCE_CONTRAST_BOTH)
+      {
+      enhanceContrast = ENHANCE_CONTRAST_COLOR;
+      }
+    }
+
   // save the active fbo and its draw buffer
   int prevDrawBuf = 0;
   glGetIntegerv(GL_DRAW_BUFFER, &prevDrawBuf);
@@ -2687,10 +2821,10 @@ void vtkSurfaceLICMapper::RenderPiece(
           viewExt,
           this->Internals->BlockExts,
           this->CompositeStrategy,
-          this->StepSize,
-          this->NumberOfSteps,
+          stepSizePx,
+          numberOfSteps,
           this->NormalizeVectors,
-          this->EnhancedLIC,
+          enhancedLIC,
           this->AntiAlias);
 
     if (comm->GetMPIInitialized())
@@ -2818,7 +2952,7 @@ void vtkSurfaceLICMapper::RenderPiece(
           1.0/this->Internals->Viewsize[1]};
 
     double stepSize
-      = this->StepSize*sqrt(tcScale[0]*tcScale[0]+tcScale[1]*tcScale[1]);
+      = stepSizePx*sqrt(tcScale[0]*tcScale[0]+tcScale[1]*tcScale[1]);
 
     stepSize = stepSize <= 0.0 ? 1.0e-10 : stepSize;
 
@@ -2826,9 +2960,9 @@ void vtkSurfaceLICMapper::RenderPiece(
     vtkLineIntegralConvolution2D *LICer = this->Internals->LICer;
 
     LICer->SetStepSize(stepSize);
-    LICer->SetNumberOfSteps(this->NumberOfSteps);
-    LICer->SetEnhancedLIC(this->EnhancedLIC);
-    switch (this->EnhanceContrast)
+    LICer->SetNumberOfSteps(numberOfSteps);
+    LICer->SetEnhancedLIC(enhancedLIC);
+    switch (enhanceContrast)
       {
       case ENHANCE_CONTRAST_LIC:
       case ENHANCE_CONTRAST_BOTH:
@@ -3324,6 +3458,9 @@ void vtkSurfaceLICMapper::PrintSelf(ostream & os, vtkIndent indent)
     << indent << "ImpulseNoiseProbablity=" << this->ImpulseNoiseProbability << endl
     << indent << "ImpulseNoiseBackgroundValue=" << this->ImpulseNoiseBackgroundValue << endl
     << indent << "NoiseGeneratorSeed=" << this->NoiseGeneratorSeed << endl
+    << indent << "InteractiveMode=" << this->InteractiveMode << endl
+    << indent << "InteractiveUpdateRate=" << this->InteractiveUpdateRate << endl
+    << indent << "InteractiveNumberOfSteps=" << this->InteractiveNumberOfSteps << endl
     << indent << "AlwaysUpdate=" << this->AlwaysUpdate << endl
     << indent << "Enable=" << this->Enable << endl
     << indent << "CompositeStrategy=" << this->CompositeStrategy << endl;
@@ -83,6 +83,11 @@ public:
   // programs used for generating LIC.
   virtual vtkDataObject* GetOutput();
 
+  // Description:
+  // The LIC shaders already write to several color buffers, so the mapper
+  // is only selected one pass at a time.
+  virtual bool GetSupportsSinglePassSelection() { return false; }
+
   // Description:
   // Enable/Disable this painter.
   void SetEnable(int val);
@@ -100,6 +105,29 @@ public:
   void SetStepSize(double val);
   vtkGetMacro(StepSize, double);
 
+  // Description:
+  // When set, renders made while the render window's desired update rate
+  // is at least InteractiveUpdateRate, as during camera interaction,
+  // integrate the same arc length with InteractiveNumberOfSteps longer
+  // steps and skip the second LIC pass and the LIC contrast enhancement.
+  // The first still render refines the LIC without rendering the geometry
+  // again. Off by default.
+  vtkSetMacro(InteractiveMode, int);
+  vtkGetMacro(InteractiveMode, int);
+  vtkBooleanMacro(InteractiveMode, int);
+
+  // Description:
+  // Get/Set the desired update rate at and above which renders are
+  // interactive. The default is 1.
+  vtkSetMacro(InteractiveUpdateRate, double);
+  vtkGetMacro(InteractiveUpdateRate, double);
+
+  // Description:
+  // Get/Set the number of integration steps in each direction used by
+  // interactive renders. The default is 5.
+  void SetInteractiveNumberOfSteps(int val);
+  vtkGetMacro(InteractiveNumberOfSteps, int);
+
   // Description:
   // Normalize vectors during integration. When set(the default) the
   // input vector field is normalized during integration, and each
@@ -437,7 +465,7 @@ protected:
 
   // Description:
   // Look for changes that would trigger stage updates
-  void ValidateContext(vtkRenderer *renderer);
+  void ValidateContext(vtkRenderer *renderer, vtkActor *actor);
 
   // Description:
   // Return false if stage can be skipped
@@ -498,6 +526,10 @@ protected:
   double  ImpulseNoiseBackgroundValue;
   int     NoiseGeneratorSeed;
 
+  int     InteractiveMode;
+  double  InteractiveUpdateRate;
+  int     InteractiveNumberOfSteps;
+
   int     AlwaysUpdate;
   int     Enable;
   int     CompositeStrategy;
@@ -0,0 +1,100 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricLODActorBackground.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test covers the background construction of the LOD of
+// vtkQuadricLODActor. A wavy surface is rendered at an update rate that
+// requires the LOD: the render starts its construction and returns, and the
+// LOD must be decimated once it is ready.
+
+#include "vtkCellArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkQuadricClustering.h"
+#include "vtkQuadricLODActor.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+
+#include <cmath>
+
+int TestQuadricLODActorBackground(int, char *[])
+{
+  // A surface of 2 * 200 * 200 triangles.
+  const int res = 201;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < res; ++j)
+    {
+    for (int i = 0; i < res; ++i)
+      {
+      points->InsertNextPoint(i, j, 10.0 * sin(0.1 * i) * cos(0.1 * j));
+      }
+    }
+  vtkNew<vtkCellArray> triangles;
+  for (int j = 0; j < res - 1; ++j)
+    {
+    for (int i = 0; i < res - 1; ++i)
+      {
+      vtkIdType id = j * res + i;
+      vtkIdType lower[3] = { id, id + 1, id + res + 1 };
+      vtkIdType upper[3] = { id, id + res + 1, id + res };
+      triangles->InsertNextCell(3, lower);
+      triangles->InsertNextCell(3, upper);
+      }
+    }
+  vtkNew<vtkPolyData> surface;
+  surface->SetPoints(points.Get());
+  surface->SetPolys(triangles.Get());
+
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputData(surface.Get());
+  vtkNew<vtkQuadricLODActor> actor;
+  actor->SetMapper(mapper.Get());
+  actor->BuildLODInBackgroundOn();
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor.Get());
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer.Get());
+
+  // Without an interactor, the update rate of the render window selects the
+  // LOD.
+  renWin->SetDesiredUpdateRate(1000.0);
+  renWin->Render();
+  actor->WaitForLOD();
+  if (actor->IsBuildingLOD())
+    {
+    cerr << "The LOD is still being built" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkIdType numCells = actor->GetLODFilter()->GetOutput()->GetNumberOfCells();
+  if (numCells == 0 || numCells >= surface->GetNumberOfCells())
+    {
+    cerr << "The LOD has " << numCells << " cells for an input of "
+         << surface->GetNumberOfCells() << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The LOD is rendered, and not built again.
+  renWin->Render();
+  if (actor->IsBuildingLOD())
+    {
+    cerr << "The LOD was built again" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
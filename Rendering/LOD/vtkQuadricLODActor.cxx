@@ -28,6 +28,30 @@
 #include "vtkCellData.h"
 #include "vtkRenderWindowInteractor.h"
 #include "vtkFollower.h"
+#include "vtkAtomicTypes.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+//----------------------------------------------------------------------------
+// The state of the LOD built in the background.
+class vtkQuadricLODActorBuilder
+{
+public:
+  vtkQuadricLODActorBuilder() : ThreadId(-1)
+  {
+    this->Running = 0;
+  }
+
+  vtkNew<vtkMultiThreader> Threader;
+  int ThreadId;
+
+  // The filter updated by the thread and its input, a shallow copy of the
+  // input of the mapper. They are kept until the LOD is swapped in.
+  vtkSmartPointer<vtkQuadricClustering> Filter;
+  vtkSmartPointer<vtkPolyData> Input;
+
+  vtkAtomicInt32 Running;
+};
 
 vtkStandardNewMacro(vtkQuadricLODActor);
 
@@ -47,6 +71,8 @@ vtkQuadricLODActor::vtkQuadricLODActor()
   this->Static = 0;
   this->MaximumDisplayListSize = 25000;
   this->DeferLODConstruction = 0;
+  this->BuildLODInBackground = 0;
+  this->Builder = new vtkQuadricLODActorBuilder;
   this->CollapseDimensionRatio = 0.05;
   this->DataConfiguration = UNKNOWN;
   this->PropType = ACTOR;
@@ -71,6 +97,11 @@ vtkQuadricLODActor::vtkQuadricLODActor()
 //----------------------------------------------------------------------------
 vtkQuadricLODActor::~vtkQuadricLODActor()
 {
+  if (this->Builder->ThreadId >= 0)
+    {
+    this->Builder->Threader->TerminateThread(this->Builder->ThreadId);
+    }
+  delete this->Builder;
   this->LODFilter->Delete();
   this->LODActor->Delete();
   this->LODActor = NULL;
@@ -134,9 +165,15 @@ void vtkQuadricLODActor::Render(vtkRenderer *ren, vtkMapper *vtkNotUsed(m))
     return;
     }
 
-  // determine out how much time we have to render
+  // a LOD built in the background replaces the previous one once ready
+  this->SwapInLOD();
+
+  // determine out how much time we have to render, without an interactor
+  // the render window holds the desired update rate
   float allowedTime = this->AllocatedRenderTime;
-  double frameRate = ren->GetRenderWindow()->GetInteractor()->GetDesiredUpdateRate();
+  vtkRenderWindowInteractor *iren = ren->GetRenderWindow()->GetInteractor();
+  double frameRate = (iren ? iren->GetDesiredUpdateRate() :
+                      ren->GetRenderWindow()->GetDesiredUpdateRate());
   frameRate = (frameRate < 1.0 ? 1.0 : (frameRate > 75 ? 75.0 : frameRate));
   int interactiveRender = 0;
   // interactive renders are defined when compared with the desired update rate. Here we use
@@ -159,8 +196,9 @@ void vtkQuadricLODActor::Render(vtkRenderer *ren, vtkMapper *vtkNotUsed(m))
 
   vtkMatrix4x4 *matrix;
 
-  // Build LOD only if necessary
+  // Build LOD only if necessary, once the one in the background is done
   if ((interactiveRender || !this->DeferLODConstruction) &&
+      !this->IsBuildingLOD() &&
       (this->GetMTime() > this->BuildTime ||
       (this->Mapper->GetMTime() > this->BuildTime) ||
       (this->CachedInteractiveFrameRate < 0.9*frameRate) ||
@@ -262,20 +300,24 @@ void vtkQuadricLODActor::Render(vtkRenderer *ren, vtkMapper *vtkNotUsed(m))
 
     vtkDebugMacro("QC bin size: " << dim);
     this->LODFilter->AutoAdjustNumberOfDivisionsOff();
-    this->LODFilter->SetInputConnection(this->Mapper->GetInputConnection(0, 0));
-    this->LODFilter->Update();
-    nCells = this->GetDisplayListSize(this->LODFilter->GetOutput());
-    this->LODMapper->SetInputConnection(this->LODFilter->GetOutputPort());
 
     // Make sure the device has the same matrix. Only update when still update
     // rate is requested.
     matrix = this->LODActor->GetUserMatrix();
     this->GetMatrix(matrix);
 
-    this->LODMapper->Update();
-    if (this->Static)
+    if (!this->BuildLODInBackground || !this->StartBuildingLOD(pd))
       {
-      this->LODMapper->StaticOn();
+      this->LODFilter->SetInputConnection(this->Mapper->GetInputConnection(0, 0));
+      this->LODFilter->Update();
+      nCells = this->GetDisplayListSize(this->LODFilter->GetOutput());
+      this->LODMapper->SetInputConnection(this->LODFilter->GetOutputPort());
+
+      this->LODMapper->Update();
+      if (this->Static)
+        {
+        this->LODMapper->StaticOn();
+        }
       }
     this->BuildTime.Modified();
     }
@@ -289,7 +331,7 @@ void vtkQuadricLODActor::Render(vtkRenderer *ren, vtkMapper *vtkNotUsed(m))
 #ifndef NDEBUG
   float bestTime = bestMapper->GetTimeToDraw();
 #endif
-  if (interactiveRender)
+  if (interactiveRender && !this->IsBuildingLOD())
     {//use lod
     bestMapper = this->LODMapper;
 #ifndef NDEBUG
@@ -332,6 +374,95 @@ void vtkQuadricLODActor::Render(vtkRenderer *ren, vtkMapper *vtkNotUsed(m))
   this->EstimatedRenderTime = bestMapper->GetTimeToDraw();
 }
 
+//----------------------------------------------------------------------------
+bool vtkQuadricLODActor::StartBuildingLOD(vtkPolyData *input)
+{
+  vtkQuadricLODActorBuilder *builder = this->Builder;
+  builder->Filter = this->LODFilter;
+  builder->Input = vtkSmartPointer<vtkPolyData>::New();
+  builder->Input->ShallowCopy(input);
+  this->LODFilter->SetInputData(builder->Input);
+
+  builder->Running = 1;
+  builder->ThreadId = builder->Threader->SpawnThread(
+    &vtkQuadricLODActor::BuildLODThread, builder);
+  if (builder->ThreadId < 0)
+    {
+    vtkWarningMacro("Could not start the LOD thread, building it now.");
+    builder->Running = 0;
+    builder->Filter = NULL;
+    builder->Input = NULL;
+    return false;
+    }
+  vtkDebugMacro("Building LOD in the background");
+  return true;
+}
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkQuadricLODActor::BuildLODThread(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkQuadricLODActorBuilder *builder =
+    static_cast<vtkQuadricLODActorBuilder*>(info->UserData);
+  builder->Filter->Update();
+  builder->Running = 0;
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricLODActor::SwapInLOD()
+{
+  vtkQuadricLODActorBuilder *builder = this->Builder;
+  if (builder->ThreadId >= 0)
+    {
+    if (builder->Running)
+      {
+      return;
+      }
+    builder->Threader->TerminateThread(builder->ThreadId);
+    builder->ThreadId = -1;
+    }
+  if (!builder->Filter)
+    {
+    return;
+    }
+
+  // The mapper renders a copy of the output, so that the filter may be
+  // updated again while the LOD is rendered.
+  vtkPolyData *lod = vtkPolyData::New();
+  lod->ShallowCopy(builder->Filter->GetOutput());
+  builder->Filter->SetInputData(NULL);
+  builder->Filter = NULL;
+  builder->Input = NULL;
+
+  this->LODMapper->SetInputData(lod);
+  lod->Delete();
+  this->LODMapper->Update();
+  if (this->Static)
+    {
+    this->LODMapper->StaticOn();
+    }
+  vtkDebugMacro("Swapped in the LOD built in the background");
+}
+
+//----------------------------------------------------------------------------
+bool vtkQuadricLODActor::IsBuildingLOD()
+{
+  return this->Builder->ThreadId >= 0 && this->Builder->Running;
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricLODActor::WaitForLOD()
+{
+  if (this->Builder->ThreadId >= 0)
+    {
+    this->Builder->Threader->TerminateThread(this->Builder->ThreadId);
+    this->Builder->ThreadId = -1;
+    }
+  this->SwapInLOD();
+}
+
 //----------------------------------------------------------------------------
 void vtkQuadricLODActor::ReleaseGraphicsResources(vtkWindow *renWin)
 {
@@ -365,6 +496,9 @@ void vtkQuadricLODActor::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Defer LOD Construction: "
      << (this->DeferLODConstruction ? "On\n" : "Off\n");
 
+  os << indent << "Build LOD In Background: "
+     << (this->BuildLODInBackground ? "On\n" : "Off\n");
+
   os << indent << "Static : " << (this->Static ? "On\n" : "Off\n");
 
   os << indent << "Collapse Dimension Ratio: " << this->CollapseDimensionRatio << "\n";
@@ -34,7 +34,10 @@
 // the first render (whether a full resolution render or interactive render)
 // the LOD is computed. This behavior can be changed so that the LOD
 // construction is deferred until the first interactive render. Either way,
-// when the LOD is constructed, the user may notice a short pause.
+// when the LOD is constructed, the user may notice a short pause. To avoid
+// the pause, the LOD may be built in a background thread instead (see
+// BuildLODInBackground): the full resolution geometry is rendered until the
+// LOD is ready.
 //
 // This class can be used as a direct replacement for vtkActor. It may also be
 // used as a replacement for vtkFollower's (the ability to track a camera is
@@ -48,11 +51,13 @@
 
 #include "vtkRenderingLODModule.h" // For export macro
 #include "vtkActor.h"
+#include "vtkMultiThreader.h" // For VTK_THREAD_RETURN_TYPE
 
 class vtkQuadricClustering;
 class vtkPolyDataMapper;
 class vtkCamera;
 class vtkPolyData;
+class vtkQuadricLODActorBuilder;
 
 class VTKRENDERINGLOD_EXPORT vtkQuadricLODActor : public vtkActor
 {
@@ -74,6 +79,26 @@ public:
   vtkGetMacro(DeferLODConstruction, int);
   vtkBooleanMacro(DeferLODConstruction, int);
 
+  // Description:
+  // Specify whether to build the LOD in a background thread. The render that
+  // requests the LOD then starts the build and returns, and the renders that
+  // follow use the full resolution geometry until the LOD is ready. The LOD
+  // filter runs on a shallow copy of the input of the mapper, so it must not
+  // be modified while the LOD is built. By default, BuildLODInBackground is
+  // false.
+  vtkSetMacro(BuildLODInBackground, int);
+  vtkGetMacro(BuildLODInBackground, int);
+  vtkBooleanMacro(BuildLODInBackground, int);
+
+  // Description:
+  // Return whether a LOD is being built in the background.
+  bool IsBuildingLOD();
+
+  // Description:
+  // Wait for the LOD being built in the background, if any. The LOD is used
+  // by the next interactive render.
+  void WaitForLOD();
+
   // Description:
   // Turn on/off a flag to control whether the underlying pipeline is static.
   // If static, this means that the data pipeline executes once and then not
@@ -226,6 +251,20 @@ protected:
   // Specify to defer construction of the LOD.
   int DeferLODConstruction;
 
+  // Build the LOD in a background thread.
+  int BuildLODInBackground;
+  vtkQuadricLODActorBuilder *Builder;
+
+  // Start updating the LOD filter in the background, on a shallow copy of
+  // the input of the mapper. Return false if the thread could not start.
+  bool StartBuildingLOD(vtkPolyData *input);
+
+  // Make the LOD mapper render the LOD built in the background, once ready.
+  void SwapInLOD();
+
+  // Executed by the background thread.
+  static VTK_THREAD_RETURN_TYPE BuildLODThread(void *arg);
+
   // Keep track of building
   vtkTimeStamp BuildTime;
 
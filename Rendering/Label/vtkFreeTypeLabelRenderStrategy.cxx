@@ -15,16 +15,30 @@
 #include "vtkFreeTypeLabelRenderStrategy.h"
 
 #include "vtkActor2D.h"
+#include "vtkCellArray.h"
+#include "vtkFloatArray.h"
+#include "vtkFreeTypeGlyphAtlas.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataMapper2D.h"
 #include "vtkRenderer.h"
 #include "vtkSmartPointer.h"
 #include "vtkTextMapper.h"
 #include "vtkTextProperty.h"
 #include "vtkTextRenderer.h"
+#include "vtkTexture.h"
+#include "vtkTexturedActor2D.h"
 #include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkWindow.h"
 
 vtkStandardNewMacro(vtkFreeTypeLabelRenderStrategy);
+vtkCxxSetObjectMacro(vtkFreeTypeLabelRenderStrategy, GlyphAtlas,
+                     vtkFreeTypeGlyphAtlas);
 
 //----------------------------------------------------------------------------
 vtkFreeTypeLabelRenderStrategy::vtkFreeTypeLabelRenderStrategy()
@@ -33,6 +47,38 @@ vtkFreeTypeLabelRenderStrategy::vtkFreeTypeLabelRenderStrategy()
   this->Mapper = vtkTextMapper::New();
   this->Actor = vtkActor2D::New();
   this->Actor->SetMapper(this->Mapper);
+
+  this->BatchLabels = false;
+  this->GlyphAtlas = vtkFreeTypeGlyphAtlas::New();
+  this->GlyphRects = vtkIntArray::New();
+  this->GlyphRects->SetNumberOfComponents(4);
+  this->GlyphTexels = vtkIntArray::New();
+  this->GlyphTexels->SetNumberOfComponents(4);
+
+  this->BatchPoints = vtkPoints::New();
+  this->BatchTCoords = vtkFloatArray::New();
+  this->BatchTCoords->SetNumberOfComponents(2);
+  this->BatchColors = vtkUnsignedCharArray::New();
+  this->BatchColors->SetNumberOfComponents(4);
+  this->BatchQuads = vtkCellArray::New();
+  this->BatchData = vtkPolyData::New();
+  this->BatchData->SetPoints(this->BatchPoints);
+  this->BatchData->SetPolys(this->BatchQuads);
+  this->BatchData->GetPointData()->SetTCoords(this->BatchTCoords);
+  this->BatchData->GetPointData()->SetScalars(this->BatchColors);
+  this->BatchMapper = vtkPolyDataMapper2D::New();
+  this->BatchMapper->SetInputData(this->BatchData);
+
+  // The glyphs are drawn pixel for pixel.
+  this->BatchTexture = vtkTexture::New();
+  this->BatchTexture->InterpolateOff();
+  this->BatchTexture->RepeatOff();
+  this->BatchTexture->EdgeClampOn();
+  this->BatchActor = vtkTexturedActor2D::New();
+  this->BatchActor->SetMapper(this->BatchMapper);
+  this->BatchActor->SetTexture(this->BatchTexture);
+  this->BatchActor->GetPositionCoordinate()->SetCoordinateSystemToDisplay();
+  this->BatchActor->GetPositionCoordinate()->SetValue(0.0, 0.0, 0.0);
 }
 
 //----------------------------------------------------------------------------
@@ -40,11 +86,62 @@ vtkFreeTypeLabelRenderStrategy::~vtkFreeTypeLabelRenderStrategy()
 {
   this->Mapper->Delete();
   this->Actor->Delete();
+  this->SetGlyphAtlas(NULL);
+  this->GlyphRects->Delete();
+  this->GlyphTexels->Delete();
+  this->BatchPoints->Delete();
+  this->BatchTCoords->Delete();
+  this->BatchColors->Delete();
+  this->BatchQuads->Delete();
+  this->BatchData->Delete();
+  this->BatchMapper->Delete();
+  this->BatchTexture->Delete();
+  this->BatchActor->Delete();
 }
 
 void vtkFreeTypeLabelRenderStrategy::ReleaseGraphicsResources(vtkWindow *window)
 {
   this->Actor->ReleaseGraphicsResources(window);
+  this->BatchActor->ReleaseGraphicsResources(window);
+  this->BatchTexture->ReleaseGraphicsResources(window);
+}
+
+//----------------------------------------------------------------------------
+void vtkFreeTypeLabelRenderStrategy::StartFrame()
+{
+  this->BatchPoints->Reset();
+  this->BatchTCoords->Reset();
+  this->BatchColors->Reset();
+  this->BatchQuads->Reset();
+}
+
+//----------------------------------------------------------------------------
+void vtkFreeTypeLabelRenderStrategy::EndFrame()
+{
+  vtkIdType numPoints = this->BatchPoints->GetNumberOfPoints();
+  if (numPoints == 0 || !this->Renderer || !this->GlyphAtlas)
+    {
+    return;
+    }
+
+  // The atlas is complete for the frame, the texels are now normalized.
+  vtkImageData *image = this->GlyphAtlas->GetImage();
+  int dims[3];
+  image->GetDimensions(dims);
+  float *tcoord = this->BatchTCoords->GetPointer(0);
+  for (vtkIdType i = 0; i < numPoints; ++i, tcoord += 2)
+    {
+    tcoord[0] /= dims[0];
+    tcoord[1] /= dims[1];
+    }
+
+  this->BatchPoints->Modified();
+  this->BatchTCoords->Modified();
+  this->BatchColors->Modified();
+  this->BatchQuads->Modified();
+  this->BatchData->Modified();
+  this->BatchTexture->SetInputData(image);
+  this->BatchActor->RenderOverlay(this->Renderer);
 }
 
 //double compute_bounds_time1 = 0;
@@ -91,7 +188,11 @@ void vtkFreeTypeLabelRenderStrategy::ComputeLabelBounds(
     }
 
   int bbox[4];
-  this->TextRenderer->GetBoundingBox(copy, label.utf8_str(), bbox, dpi);
+  if (!this->BatchLabels || !this->GlyphAtlas ||
+      !this->GlyphAtlas->GetBoundingBox(copy, label, dpi, bbox))
+    {
+    this->TextRenderer->GetBoundingBox(copy, label.utf8_str(), bbox, dpi);
+    }
 
   // Take line offset into account
   bds[0] = bbox[0];
@@ -154,6 +255,52 @@ void vtkFreeTypeLabelRenderStrategy::RenderLabel(
     {
     tprop = this->DefaultTextProperty;
     }
+
+  if (this->BatchLabels && this->GlyphAtlas)
+    {
+    int dpi = this->Renderer->GetVTKWindow() ?
+      this->Renderer->GetVTKWindow()->GetDPI() : 72;
+    int bbox[4];
+    this->GlyphRects->Reset();
+    this->GlyphTexels->Reset();
+    if (this->GlyphAtlas->LayoutString(tprop, label, dpi, this->GlyphRects,
+                                       this->GlyphTexels, bbox))
+      {
+      double *color = tprop->GetColor();
+      unsigned char rgba[4] = {
+        static_cast<unsigned char>(color[0] * 255),
+        static_cast<unsigned char>(color[1] * 255),
+        static_cast<unsigned char>(color[2] * 255),
+        static_cast<unsigned char>(tprop->GetOpacity() * 255) };
+      for (vtkIdType i = 0; i < this->GlyphRects->GetNumberOfTuples(); ++i)
+        {
+        int rect[4];
+        int texel[4];
+        this->GlyphRects->GetTupleValue(i, rect);
+        this->GlyphTexels->GetTupleValue(i, texel);
+        vtkIdType quad[4];
+        quad[0] = this->BatchPoints->InsertNextPoint(
+          x[0] + rect[0], x[1] + rect[2], 0.0);
+        quad[1] = this->BatchPoints->InsertNextPoint(
+          x[0] + rect[1], x[1] + rect[2], 0.0);
+        quad[2] = this->BatchPoints->InsertNextPoint(
+          x[0] + rect[1], x[1] + rect[3], 0.0);
+        quad[3] = this->BatchPoints->InsertNextPoint(
+          x[0] + rect[0], x[1] + rect[3], 0.0);
+        this->BatchTCoords->InsertNextTuple2(texel[0], texel[2]);
+        this->BatchTCoords->InsertNextTuple2(texel[1], texel[2]);
+        this->BatchTCoords->InsertNextTuple2(texel[1], texel[3]);
+        this->BatchTCoords->InsertNextTuple2(texel[0], texel[3]);
+        for (int j = 0; j < 4; ++j)
+          {
+          this->BatchColors->InsertNextTupleValue(rgba);
+          }
+        this->BatchQuads->InsertNextCell(4, quad);
+        }
+      return;
+      }
+    }
+
   this->Mapper->SetTextProperty(tprop);
   this->Mapper->SetInput(label.utf8_str());
   this->Actor->GetPositionCoordinate()->SetCoordinateSystemToDisplay();
@@ -172,4 +319,6 @@ void vtkFreeTypeLabelRenderStrategy::RenderLabel(
 void vtkFreeTypeLabelRenderStrategy::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+  os << indent << "BatchLabels: " << this->BatchLabels << endl;
+  os << indent << "GlyphAtlas: " << this->GlyphAtlas << endl;
 }
@@ -17,6 +17,11 @@
 // .SECTION Description
 // Uses the FreeType to render labels and compute label sizes.
 // This strategy may be used with vtkLabelPlacementMapper.
+//
+// By default each label is rendered by a vtkTextMapper, with a texture of
+// its own. With BatchLabels, the labels are laid out with a shared
+// vtkFreeTypeGlyphAtlas instead, and drawn together at the end of the
+// frame, as textured quads of a single vtkPolyData.
 
 #ifndef vtkFreeTypeLabelRenderStrategy_h
 #define vtkFreeTypeLabelRenderStrategy_h
@@ -25,8 +30,18 @@
 #include "vtkLabelRenderStrategy.h"
 
 class vtkActor2D;
+class vtkCellArray;
+class vtkFloatArray;
+class vtkFreeTypeGlyphAtlas;
+class vtkIntArray;
+class vtkPoints;
+class vtkPolyData;
+class vtkPolyDataMapper2D;
 class vtkTextRenderer;
 class vtkTextMapper;
+class vtkTexture;
+class vtkTexturedActor2D;
+class vtkUnsignedCharArray;
 
 class VTKRENDERINGLABEL_EXPORT vtkFreeTypeLabelRenderStrategy : public vtkLabelRenderStrategy
 {
@@ -62,6 +77,29 @@ class VTKRENDERINGLABEL_EXPORT vtkFreeTypeLabelRenderStrategy : public vtkLabelR
   virtual void RenderLabel(int x[2], vtkTextProperty* tprop, vtkUnicodeString label, int width)
     { this->Superclass::RenderLabel(x, tprop, label, width); }
 
+  // Description:
+  // Draw the labels that the glyph atlas can lay out together, in
+  // EndFrame(). The other labels (on several lines, rotated, with a shadow
+  // or a background) are still rendered one by one, under the batched ones.
+  // The bounds of the labels are computed with the atlas too. Off by
+  // default.
+  vtkSetMacro(BatchLabels, bool);
+  vtkGetMacro(BatchLabels, bool);
+  vtkBooleanMacro(BatchLabels, bool);
+
+  // Description:
+  // The atlas holding the glyphs of the batched labels. It may be shared by
+  // several strategies rendering in the same context. A new atlas is
+  // created by default.
+  void SetGlyphAtlas(vtkFreeTypeGlyphAtlas *atlas);
+  vtkGetObjectMacro(GlyphAtlas, vtkFreeTypeGlyphAtlas);
+
+  // Description:
+  // Start and end a rendering frame. The batched labels are drawn by
+  // EndFrame().
+  virtual void StartFrame();
+  virtual void EndFrame();
+
   // Description:
   // Release any graphics resources that are being consumed by this strategy.
   // The parameter window could be used to determine which graphic
@@ -76,6 +114,22 @@ protected:
   vtkTextMapper* Mapper;
   vtkActor2D* Actor;
 
+  bool BatchLabels;
+  vtkFreeTypeGlyphAtlas *GlyphAtlas;
+
+  // The glyphs of the batched labels, in display coordinates, with the
+  // texture coordinates in pixels of the atlas until EndFrame().
+  vtkIntArray *GlyphRects;
+  vtkIntArray *GlyphTexels;
+  vtkPoints *BatchPoints;
+  vtkFloatArray *BatchTCoords;
+  vtkUnsignedCharArray *BatchColors;
+  vtkCellArray *BatchQuads;
+  vtkPolyData *BatchData;
+  vtkPolyDataMapper2D *BatchMapper;
+  vtkTexture *BatchTexture;
+  vtkTexturedActor2D *BatchActor;
+
 private:
   vtkFreeTypeLabelRenderStrategy(const vtkFreeTypeLabelRenderStrategy&);  // Not implemented.
   void operator=(const vtkFreeTypeLabelRenderStrategy&);  // Not implemented.
@@ -39,10 +39,12 @@
 #include "vtkPolyData.h"
 #include "vtkPythagoreanQuadruples.h"
 #include "vtkRenderer.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkTextProperty.h"
 
 #include <octree/octree>
+#include <algorithm>
 #include <deque>
 #include <set>
 #include <vector>
@@ -1959,6 +1961,8 @@ void vtkLabelHierarchyBuildCoincidenceMap(
 // The exact procedure involves sorting all labels in descending priority, filling the root of
 // the label octree with the highest priority labels, and then inserting the remaining labels
 // in the highest possible level of octree which is not already full.
+// Rather than dropping the labels one at a time, the sorted labels are split among the children
+// of each full node at once, which produces the same tree.
 void vtkLabelHierarchy::ComputeHierarchy()
 {
   delete this->Impl->Hierarchy3;
@@ -1996,26 +2000,21 @@ void vtkLabelHierarchy::ComputeHierarchy()
     this->Impl->Hierarchy3->root()->value().SetGeometry( center, maxDim );
     }
 
-  this->Impl->PrepareSortedAnchors( allAnchors );
+  std::vector<Implementation::BulkAnchor> anchors;
+  this->Impl->SortAnchors( anchors );
   //this->Impl->FillHierarchyRoot( allAnchors );
 
   double scale = 1.;
   if ( this->Impl->Hierarchy3 )
     {
-    for ( Implementation::LabelSet::iterator it = allAnchors.begin(); it != allAnchors.end(); ++ it )
-      {
-      this->Impl->DropAnchor3( *it ); // Ha!!!
-      }
+    this->Impl->FillHierarchy( this->Impl->Hierarchy3, anchors );
     //vtkLabelHierarchyBuildCoincidenceMap( this->Impl, this, this->Impl->Hierarchy3 );
     vtkLabelHierarchy::Implementation::HierarchyCursor3 curs( this->Impl->Hierarchy3 );
     scale = curs->value().GetSize()/(1 << this->MaximumDepth);
     }
   else if ( this->Impl->Hierarchy2 )
     {
-    for ( Implementation::LabelSet::iterator it = allAnchors.begin(); it != allAnchors.end(); ++ it )
-      {
-      this->Impl->DropAnchor2( *it ); // Ha!!!
-      }
+    this->Impl->FillHierarchy( this->Impl->Hierarchy2, anchors );
     //vtkLabelHierarchyBuildCoincidenceMap( this->Impl, this, this->Impl->Hierarchy2 );
     vtkLabelHierarchy::Implementation::HierarchyCursor2 curs( this->Impl->Hierarchy2 );
     scale = curs->value().GetSize()/(1 << this->MaximumDepth);
@@ -2385,153 +2384,212 @@ void vtkLabelHierarchy::Implementation::RecursiveNodeDivide( HierarchyCursor2& c
   (void)cursor;
 }
 
-void vtkLabelHierarchy::Implementation::PrepareSortedAnchors( LabelSet& anchors )
+namespace
 {
-  anchors.clear();
-  vtkIdType npts = this->Husk->GetPoints()->GetNumberOfPoints();
-  for ( vtkIdType i = 0; i < npts; ++ i )
-    {
-    anchors.insert( i );
-    }
-}
-
-void vtkLabelHierarchy::Implementation::FillHierarchyRoot( LabelSet& anchors )
+// Orders point ids by descending priority, then by id, as the multiset
+// of all the anchors would.
+class vtkLabelHierarchyPriorityOrder
 {
-  LabelSet::iterator endRootAnchors;
-  if ( static_cast<int>( anchors.size() ) < this->Husk->GetTargetLabelCount() )
-    {
-    endRootAnchors = anchors.end();
-    }
-  else
+public:
+  const double* Priorities;
+
+  bool operator () ( vtkIdType a, vtkIdType b ) const
     {
-    endRootAnchors = anchors.begin();
-    for ( int i = 0; i < this->Husk->GetTargetLabelCount(); ++ i )
+    if ( !this->Priorities )
       {
-      ++ endRootAnchors;
+      return a < b;
       }
+    return this->Priorities[a] > this->Priorities[b] ||
+      ( this->Priorities[a] == this->Priorities[b] && a < b );
     }
-  this->Hierarchy3->root()->value().insert( anchors.begin(), endRootAnchors );
-  anchors.erase( anchors.begin(), endRootAnchors );
-}
+};
 
-void vtkLabelHierarchy::Implementation::DropAnchor2( vtkIdType anchor )
+// Each node keeps a range of the anchors, in priority order: its own
+// anchors first, then those of each of its children.
+template <class NodePointer>
+struct vtkLabelHierarchyRange
 {
-  //HierarchyCursor3 curs( this->Hierarchy3 );
-  //PriorityComparator comparator( this->Husk );
-  //LabelSet emptyNode( comparator );
-  // See comment near declaration of Current for more info:
-  vtkLabelHierarchy::Implementation::Current = this->Husk;
-
-  LabelSet emptyNode( this->Husk );
-  HierarchyCursor2 curs( this->Hierarchy2 );
-  const double* ctr = curs->value().GetCenter();
-  double x[3];
-  double sz = curs->value().GetSize();
-  int m[3]; // "branch selector" for each axis (mX is 0 if rX < 0.5 or 1 otherwise)
-  int child; // Always set to m0 + 2 * ( m1 + 2 * m2 ), offset into array of node children
-  int j;
-  // Retrieve the point coordinates
-  this->Husk->GetPoints()->GetPoint( anchor, x );
+  NodePointer Node;
+  size_t Begin;
+  size_t End;
+  double Threshold;
+  size_t Level;
+};
 
-  //Coord coord( x );
-  this->Husk->GetCoincidentPoints()->AddPoint( anchor, x );
+// Selects the child of the current node that each anchor descends into,
+// and makes the anchor coordinates relative to that child.
+template <int d>
+class vtkLabelHierarchySelectChild
+{
+public:
+  vtkLabelHierarchy::Implementation::BulkAnchor* Anchors;
+  int* Children;
+  double Threshold;
 
-  // Convert into "octree" coordinates (x[i] in [0,1[ for easy descent).
-  for ( j = 0; j < 2; ++ j )
+  void operator () ( vtkIdType begin, vtkIdType end ) const
     {
-    x[j] = ( x[j] - ctr[j] ) / sz + 0.5;
-    }
-  double thresh = 1.;
-  while ( static_cast<int>( curs->value().GetLocalAnchorCount() ) >= this->Husk->GetTargetLabelCount() )
-    { // descend the tree or make children as required.
-    thresh *= 0.5;
-    for ( j = 0; j < 2; ++ j )
+    for ( vtkIdType i = begin; i < end; ++ i )
       {
-      if ( x[j] < thresh )
+      double* x = this->Anchors[i].X;
+      int child = 0;
+      for ( int j = 0; j < d; ++ j )
         {
-        m[j] = 0;
-        }
-      else
-        {
-        m[j] = 1;
-        x[j] -= thresh;
+        if ( x[j] >= this->Threshold )
+          {
+          child |= 1 << j;
+          x[j] -= this->Threshold;
+          }
         }
+      this->Children[i] = child;
       }
-    child = m[0] + 2 * m[1];
-    if ( curs->is_leaf_node() )
+    }
+};
+}
+
+void vtkLabelHierarchy::Implementation::SortAnchors( std::vector<BulkAnchor>& anchors )
+{
+  vtkPoints* pts = this->Husk->GetPoints();
+  vtkIdType npts = pts->GetNumberOfPoints();
+  vtkDataArray* priorities = this->Husk->GetPriorities();
+  std::vector<double> priorityValues;
+  if ( priorities )
+    {
+    priorityValues.resize( npts );
+    for ( vtkIdType i = 0; i < npts; ++ i )
       {
-      curs->value().AddChildren( &(*curs), emptyNode );
+      priorityValues[i] = priorities->GetTuple1( i );
       }
-    curs->value().Increment(); // Increment the count of labels in this portion of the tree.
-    curs.down( child );
     }
-  curs->value().Insert( anchor );
-  if ( curs.level() > this->ActualDepth )
+
+  std::vector<vtkIdType> ids( npts );
+  for ( vtkIdType i = 0; i < npts; ++ i )
     {
-    this->ActualDepth = curs.level();
+    ids[i] = i;
     }
+  vtkLabelHierarchyPriorityOrder order;
+  order.Priorities = priorities && npts ? &priorityValues[0] : 0;
+  vtkSMPTools::Sort( ids.begin(), ids.end(), order );
 
-  this->SmudgeAnchor2( curs, anchor, x );
+  anchors.resize( npts );
+  for ( vtkIdType i = 0; i < npts; ++ i )
+    {
+    anchors[i].Id = ids[i];
+    pts->GetPoint( ids[i], anchors[i].X );
+    this->Husk->GetCoincidentPoints()->AddPoint( ids[i], anchors[i].X );
+    }
 }
 
-void vtkLabelHierarchy::Implementation::DropAnchor3( vtkIdType anchor )
+template <int d>
+void vtkLabelHierarchy::Implementation::FillHierarchy(
+  octree<LabelSet,d>* hierarchy, std::vector<BulkAnchor>& anchors )
 {
-  //HierarchyCursor3 curs( this->Hierarchy3 );
-  //PriorityComparator comparator( this->Husk );
-  //LabelSet emptyNode( comparator );
+  typedef typename octree<LabelSet,d>::octree_node_pointer NodePointer;
   // See comment near declaration of Current for more info:
   vtkLabelHierarchy::Implementation::Current = this->Husk;
 
   LabelSet emptyNode( this->Husk );
-  HierarchyCursor3 curs( this->Hierarchy3 );
-  const double* ctr = curs->value().GetCenter();
-  double x[3];
-  double sz = curs->value().GetSize();
-  int m[3]; // "branch selector" for each axis (mX is 0 if rX < 0.5 or 1 otherwise)
-  int child; // Always set to m0 + 2 * ( m1 + 2 * m2 ), offset into array of node children
-  int j;
-  // Retrieve the point coordinates
-  this->Husk->GetPoints()->GetPoint( anchor, x );
-
-  //Coord coord(x);
-  this->Husk->GetCoincidentPoints()->AddPoint( anchor, x );
+  size_t target = static_cast<size_t>(
+    std::max( this->Husk->GetTargetLabelCount(), 1 ) );
+  size_t numAnchors = anchors.size();
+  if ( !numAnchors )
+    {
+    return;
+    }
 
   // Convert into "octree" coordinates (x[i] in [0,1[ for easy descent).
-  for ( j = 0; j < 3; ++ j )
+  NodePointer root = hierarchy->root();
+  const double* ctr = root->value().GetCenter();
+  double sz = root->value().GetSize();
+  for ( size_t i = 0; i < numAnchors; ++ i )
     {
-    x[j] = ( x[j] - ctr[j] ) / sz + 0.5;
+    for ( int j = 0; j < d; ++ j )
+      {
+      anchors[i].X[j] = ( anchors[i].X[j] - ctr[j] ) / sz + 0.5;
+      }
     }
-  double thresh = 1.;
-  while ( static_cast<int>( curs->value().GetLocalAnchorCount() ) >= this->Husk->GetTargetLabelCount() )
-    { // descend the tree or make children as required.
-    thresh *= 0.5;
-    for ( j = 0; j < 3; ++ j )
+
+  typedef vtkLabelHierarchyRange<NodePointer> Range;
+  std::vector<Range> ranges;
+  Range rootRange = { root, 0, numAnchors, 1., 0 };
+  ranges.push_back( rootRange );
+  std::vector<BulkAnchor> sorted( numAnchors );
+  std::vector<int> children( numAnchors );
+  vtkLabelHierarchySelectChild<d> select;
+  select.Anchors = &anchors[0];
+  select.Children = &children[0];
+  while ( !ranges.empty() )
+    {
+    Range range = ranges.back();
+    ranges.pop_back();
+    LabelSet& labels = range.Node->value();
+    size_t local = std::min( range.End - range.Begin, target );
+    for ( size_t i = range.Begin; i < range.Begin + local; ++ i )
       {
-      if ( x[j] < thresh )
-        {
-        m[j] = 0;
-        }
-      else
-        {
-        m[j] = 1;
-        x[j] -= thresh;
-        }
+      labels.insert( labels.end(), anchors[i].Id );
+      }
+    labels.TotalAnchors = range.End - range.Begin;
+    if ( range.Level > this->ActualDepth )
+      {
+      this->ActualDepth = range.Level;
       }
-    child = m[0] + 2 * ( m[1] + 2 * m[2] );
-    if ( curs->is_leaf_node() )
+    size_t begin = range.Begin + local;
+    if ( begin == range.End )
+      {
+      continue;
+      }
+
+    // Split the remaining anchors among the children, keeping their order.
+    select.Threshold = range.Threshold * 0.5;
+    vtkSMPTools::For( begin, range.End, 4096, select );
+    size_t offsets[( 1 << d ) + 1] = { 0 };
+    for ( size_t i = begin; i < range.End; ++ i )
       {
-      curs->value().AddChildren( &(*curs), emptyNode );
+      ++ offsets[children[i] + 1];
+      }
+    for ( int c = 0; c < ( 1 << d ); ++ c )
+      {
+      offsets[c + 1] += offsets[c];
+      }
+    for ( size_t i = begin; i < range.End; ++ i )
+      {
+      sorted[begin + offsets[children[i]] ++] = anchors[i];
+      }
+    std::copy( sorted.begin() + begin, sorted.begin() + range.End,
+               anchors.begin() + begin );
+
+    labels.AddChildren( range.Node, emptyNode );
+    size_t first = begin;
+    for ( int c = 0; c < ( 1 << d ); ++ c )
+      {
+      size_t last = begin + offsets[c];
+      if ( last > first )
+        {
+        Range child = { &(*range.Node)[c], first, last, select.Threshold,
+                        range.Level + 1 };
+        ranges.push_back( child );
+        }
+      first = last;
       }
-    curs->value().Increment();
-    curs.down( child );
     }
-  curs->value().Insert( anchor );
-  if ( curs.level() > this->ActualDepth )
+}
+
+void vtkLabelHierarchy::Implementation::FillHierarchyRoot( LabelSet& anchors )
+{
+  LabelSet::iterator endRootAnchors;
+  if ( static_cast<int>( anchors.size() ) < this->Husk->GetTargetLabelCount() )
     {
-    this->ActualDepth = curs.level();
+    endRootAnchors = anchors.end();
     }
-
-  this->SmudgeAnchor3( curs, anchor, x );
+  else
+    {
+    endRootAnchors = anchors.begin();
+    for ( int i = 0; i < this->Husk->GetTargetLabelCount(); ++ i )
+      {
+      ++ endRootAnchors;
+      }
+    }
+  this->Hierarchy3->root()->value().insert( anchors.begin(), endRootAnchors );
+  anchors.erase( anchors.begin(), endRootAnchors );
 }
 
 // If an anchor is near any octree boundaries, copy it to neighbors at the same level.
@@ -188,6 +188,7 @@ public:
   virtual void GetCell(vtkIdType, vtkGenericCell*);
   virtual int GetCellType(vtkIdType);
   virtual void GetCellPoints(vtkIdType, vtkIdList*);
+  using vtkPointSet::GetCellPoints;
   virtual void GetPointCells(vtkIdType, vtkIdList*);
   virtual vtkIdType FindCell(double*, vtkCell*, vtkIdType, double, int&, double*, double*);
   virtual vtkIdType FindCell(double*, vtkCell*, vtkGenericCell*, vtkIdType, double, int&, double*, double*);
@@ -3,6 +3,7 @@
 
 #include "vtkObject.h" // for vtkstd
 #include <set>
+#include <vector>
 
 #include "octree/octree"
 
@@ -179,11 +180,24 @@ public:
   void RecursiveNodeDivide( HierarchyCursor3& cursor );
 
   // Description:
-  // Routines called by ComputeHierarchy()
-  void PrepareSortedAnchors( LabelSet& anchors );
+  // A label anchor being sorted into the hierarchy: its point id and its
+  // coordinates, relative to the node it descends into once in the tree.
+  struct BulkAnchor
+  {
+    vtkIdType Id;
+    double X[3];
+  };
+
+  // Description:
+  // Routines called by ComputeHierarchy(). SortAnchors() lists the anchors
+  // in descending priority; FillHierarchy() then gives each node of the
+  // tree the TargetLabelCount first anchors that reach it and splits the
+  // others among its children, level by level.
+  void SortAnchors( std::vector<BulkAnchor>& anchors );
+  template <int d>
+  void FillHierarchy( octree<LabelSet,d>* hierarchy,
+                      std::vector<BulkAnchor>& anchors );
   void FillHierarchyRoot( LabelSet& anchors );
-  void DropAnchor2( vtkIdType anchor );
-  void DropAnchor3( vtkIdType anchor );
   void SmudgeAnchor2( HierarchyCursor2& cursor, vtkIdType anchor, double* x );
   void SmudgeAnchor3( HierarchyCursor3& cursor, vtkIdType anchor, double* x );
 
@@ -19,7 +19,9 @@
 #include "vtkTextProperty.h"
 #include "vtkTextRenderer.h"
 
+#include <algorithm>
 #include <map>
+#include <string>
 
 class vtkLabelSizeCalculator::Internals
 {
@@ -221,6 +223,9 @@ vtkIntArray* vtkLabelSizeCalculator::LabelSizesForArray(
   lsz->SetNumberOfComponents( 4 );
   lsz->SetNumberOfTuples( nl );
 
+  // Labels often repeat (category names, units...): measure each text once
+  // per font type and copy the bounds of its first occurrence.
+  std::map<std::pair<int, std::string>, vtkIdType> measured;
   int bbox[4];
   int* bds = lsz->GetPointer( 0 );
   for ( vtkIdType i = 0; i < nl; ++ i )
@@ -230,13 +235,23 @@ vtkIntArray* vtkLabelSizeCalculator::LabelSizesForArray(
       {
       type = types->GetValue( i );
       }
+    std::pair<std::map<std::pair<int, std::string>, vtkIdType>::iterator, bool>
+      first = measured.insert( std::make_pair(
+        std::make_pair( type, labels->GetVariantValue( i ).ToString() ), i ) );
+    if ( !first.second )
+      {
+      std::copy( lsz->GetPointer( 4 * first.first->second ),
+                 lsz->GetPointer( 4 * first.first->second + 4 ), bds );
+      bds += 4;
+      continue;
+      }
     vtkTextProperty* prop = this->Implementation->FontProperties[type];
     if (!prop)
       {
       prop = this->Implementation->FontProperties[0];
       }
     this->FontUtil->GetBoundingBox(
-          prop, labels->GetVariantValue(i).ToString().c_str(), bbox, this->DPI);
+          prop, first.first->first.second.c_str(), bbox, this->DPI);
     bds[0] = bbox[1] - bbox[0];
     bds[1] = bbox[3] - bbox[2];
     bds[2] = bbox[0];
@@ -0,0 +1,88 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAsynchronousReadback.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test covers the asynchronous readback of vtkWindowToImageFilter.
+// The first update must give the current window, and each later update
+// the window as it was at the previous update.
+
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkWindowToImageFilter.h"
+
+namespace
+{
+
+// Capture the window and check the color of its first pixel.
+bool CheckCapture(vtkWindowToImageFilter *w2i, unsigned char red,
+                  const char *what)
+{
+  w2i->Modified();
+  w2i->Update();
+  vtkUnsignedCharArray *pixels = vtkUnsignedCharArray::SafeDownCast(
+    w2i->GetOutput()->GetPointData()->GetScalars());
+  if (!pixels || pixels->GetValue(0) != red)
+    {
+    cerr << "Wrong image for the " << what << " update: red is "
+         << (pixels ? static_cast<int>(pixels->GetValue(0)) : -1)
+         << " instead of " << static_cast<int>(red) << endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+int TestAsynchronousReadback(int, char *[])
+{
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(64, 64);
+  vtkNew<vtkRenderer> renderer;
+  renWin->AddRenderer(renderer.Get());
+
+  vtkNew<vtkWindowToImageFilter> w2i;
+  w2i->SetInput(renWin.Get());
+  w2i->ReadFrontBufferOff();
+  w2i->ShouldRerenderOff();
+  w2i->AsynchronousReadbackOn();
+
+  renderer->SetBackground(1.0, 0.0, 0.0);
+  renWin->Render();
+  if (!CheckCapture(w2i.Get(), 255, "first"))
+    {
+    return EXIT_FAILURE;
+    }
+  if (renWin->GetNumberOfQueuedPixelData() == 0)
+    {
+    // no asynchronous reads, the filter read synchronously
+    return EXIT_SUCCESS;
+    }
+
+  renderer->SetBackground(0.0, 0.0, 0.0);
+  renWin->Render();
+  if (!CheckCapture(w2i.Get(), 255, "second"))
+    {
+    return EXIT_FAILURE;
+    }
+  renWin->Render();
+  if (!CheckCapture(w2i.Get(), 0, "third"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGlyph3DMapperCullingAndLOD.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test covers the GPU culling of vtkOpenGLGlyph3DMapper. A grid of
+// spheres, most of them out of the view, must look the same with and
+// without culling. A level of detail without source from the camera on
+// must then remove every sphere. The culling needs an OpenGL 3.2 context,
+// without one only the first check is done.
+
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkNew.h"
+#include "vtkOpenGLGlyph3DMapper.h"
+#include "vtkOpenGLRenderWindow.h"
+#include "vtkPlaneSource.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnsignedCharArray.h"
+
+namespace
+{
+
+void GetPixels(vtkRenderWindow *renWin, vtkUnsignedCharArray *pixels)
+{
+  renWin->Render();
+  int *size = renWin->GetSize();
+  renWin->GetPixelData(0, 0, size[0] - 1, size[1] - 1, 1, pixels);
+}
+
+bool SamePixels(vtkUnsignedCharArray *expected, vtkUnsignedCharArray *pixels)
+{
+  if (expected->GetNumberOfTuples() != pixels->GetNumberOfTuples())
+    {
+    return false;
+    }
+  vtkIdType size =
+    expected->GetNumberOfTuples() * expected->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < size; ++i)
+    {
+    if (expected->GetValue(i) != pixels->GetValue(i))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int TestGlyph3DMapperCullingAndLOD(int, char *[])
+{
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  vtkNew<vtkRenderer> renderer;
+  renWin->AddRenderer(renderer.Get());
+
+  vtkNew<vtkPlaneSource> grid;
+  grid->SetOrigin(-20.0, -20.0, 0.0);
+  grid->SetPoint1(20.0, -20.0, 0.0);
+  grid->SetPoint2(-20.0, 20.0, 0.0);
+  grid->SetResolution(20, 20);
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(0.5);
+
+  vtkNew<vtkOpenGLGlyph3DMapper> mapper;
+  mapper->SetInputConnection(grid->GetOutputPort());
+  mapper->SetSourceConnection(sphere->GetOutputPort());
+  mapper->ScalingOff();
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper.Get());
+  renderer->AddActor(actor.Get());
+
+  vtkCamera *camera = renderer->GetActiveCamera();
+  camera->SetPosition(0.0, 0.0, 15.0);
+  camera->SetFocalPoint(0.0, 0.0, 0.0);
+  camera->SetViewUp(0.0, 1.0, 0.0);
+  renderer->ResetCameraClippingRange();
+
+  vtkNew<vtkUnsignedCharArray> expected;
+  GetPixels(renWin.Get(), expected.Get());
+
+  vtkNew<vtkUnsignedCharArray> pixels;
+  mapper->CullingAndLODOn();
+  GetPixels(renWin.Get(), pixels.Get());
+  if (!SamePixels(expected.Get(), pixels.Get()))
+    {
+    cerr << "The culling changed the image" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!vtkOpenGLRenderWindow::GetContextSupportsOpenGL32())
+    {
+    return EXIT_SUCCESS;
+    }
+
+  mapper->SetNumberOfLOD(1);
+  mapper->SetLODDistanceAndSource(0, 0.0, NULL);
+  mapper->CullingAndLODOff();
+  actor->SetVisibility(0);
+  GetPixels(renWin.Get(), expected.Get());
+  actor->SetVisibility(1);
+  mapper->CullingAndLODOn();
+  GetPixels(renWin.Get(), pixels.Get());
+  if (!SamePixels(expected.Get(), pixels.Get()))
+    {
+    cerr << "The empty level of detail did not remove the glyphs" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,156 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestHardwareSelectorSinglePass.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test covers the single pass of vtkOpenGLHardwareSelector. A sphere
+// and the blocks of a multiblock dataset are selected by cells and by
+// points, one pass at a time and in a single pass: both selections must be
+// the same. Without an OpenGL 3.2 context the single pass falls back to the
+// passes one by one.
+
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkCompositePolyDataMapper2.h"
+#include "vtkHardwareSelector.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkOpenGLRenderWindow.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSelection.h"
+#include "vtkSelectionNode.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+namespace
+{
+
+vtkSelection *Select(vtkRenderer *renderer, int association, bool singlePass)
+{
+  vtkNew<vtkHardwareSelector> selector;
+  selector->SetRenderer(renderer);
+  selector->SetFieldAssociation(association);
+  selector->SetArea(0, 0, 299, 299);
+  selector->SetUseSinglePass(singlePass);
+  vtkSelection *selection = selector->Select();
+  if (singlePass && vtkOpenGLRenderWindow::GetContextSupportsOpenGL32() &&
+      selector->GetCurrentPass() != vtkHardwareSelector::SINGLE_PASS)
+    {
+    cerr << "The selection was not done in a single pass" << endl;
+    selection->Delete();
+    return NULL;
+    }
+  return selection;
+}
+
+bool SameSelections(vtkSelection *expected, vtkSelection *selection)
+{
+  if (expected->GetNumberOfNodes() != selection->GetNumberOfNodes())
+    {
+    cerr << "Selected " << selection->GetNumberOfNodes() << " nodes instead of "
+         << expected->GetNumberOfNodes() << endl;
+    return false;
+    }
+  for (unsigned int i = 0; i < expected->GetNumberOfNodes(); ++i)
+    {
+    vtkInformation *expectedInfo = expected->GetNode(i)->GetProperties();
+    vtkInformation *info = selection->GetNode(i)->GetProperties();
+    if (expectedInfo->Get(vtkSelectionNode::PROP_ID()) !=
+          info->Get(vtkSelectionNode::PROP_ID()) ||
+        expectedInfo->Get(vtkSelectionNode::COMPOSITE_INDEX()) !=
+          info->Get(vtkSelectionNode::COMPOSITE_INDEX()))
+      {
+      cerr << "Node " << i << " selects another prop or block" << endl;
+      return false;
+      }
+    vtkIdTypeArray *expectedIds =
+      vtkIdTypeArray::SafeDownCast(expected->GetNode(i)->GetSelectionList());
+    vtkIdTypeArray *ids =
+      vtkIdTypeArray::SafeDownCast(selection->GetNode(i)->GetSelectionList());
+    if (!expectedIds || !ids ||
+        expectedIds->GetNumberOfTuples() != ids->GetNumberOfTuples())
+      {
+      cerr << "Node " << i << " selects another number of ids" << endl;
+      return false;
+      }
+    for (vtkIdType j = 0; j < ids->GetNumberOfTuples(); ++j)
+      {
+      if (expectedIds->GetValue(j) != ids->GetValue(j))
+        {
+        cerr << "Node " << i << " selects id " << ids->GetValue(j)
+             << " instead of " << expectedIds->GetValue(j) << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+}
+
+int TestHardwareSelectorSinglePass(int, char *[])
+{
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->SetMultiSamples(0);
+  vtkNew<vtkRenderer> renderer;
+  renWin->AddRenderer(renderer.Get());
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper.Get());
+  actor->SetPosition(-1.0, 0.0, 0.0);
+  renderer->AddActor(actor.Get());
+
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  for (unsigned int i = 0; i < 3; ++i)
+    {
+    vtkNew<vtkSphereSource> block;
+    block->SetCenter(1.0, i - 1.0, 0.0);
+    block->SetRadius(0.4);
+    block->Update();
+    blocks->SetBlock(i, block->GetOutput());
+    }
+  vtkNew<vtkCompositePolyDataMapper2> compositeMapper;
+  compositeMapper->SetInputDataObject(blocks.Get());
+  vtkNew<vtkActor> compositeActor;
+  compositeActor->SetMapper(compositeMapper.Get());
+  renderer->AddActor(compositeActor.Get());
+
+  renderer->ResetCamera();
+  renWin->Render();
+
+  int associations[2] = { vtkDataObject::FIELD_ASSOCIATION_CELLS,
+    vtkDataObject::FIELD_ASSOCIATION_POINTS };
+  for (int i = 0; i < 2; ++i)
+    {
+    vtkSmartPointer<vtkSelection> expected;
+    expected.TakeReference(Select(renderer.Get(), associations[i], false));
+    vtkSmartPointer<vtkSelection> selection;
+    selection.TakeReference(Select(renderer.Get(), associations[i], true));
+    if (!expected || !selection ||
+        !SameSelections(expected.Get(), selection.Get()))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
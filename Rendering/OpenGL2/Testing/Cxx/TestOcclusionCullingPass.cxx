@@ -0,0 +1,111 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOcclusionCullingPass.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test covers the occlusion culling render pass. A wall hides a grid
+// of spheres: after a few frames the spheres are culled, while the wall and
+// a sphere in front of it are not. When the camera looks from the other
+// side of the wall, every sphere comes back.
+
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkNew.h"
+#include "vtkOcclusionCullingPass.h"
+#include "vtkOpenGLRenderer.h"
+#include "vtkPlaneSource.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkRenderStepsPass.h"
+#include "vtkRenderWindow.h"
+#include "vtkSphereSource.h"
+
+namespace
+{
+
+// Render up to 10 frames, as the results of the queries may come late,
+// until the pass culls \p expected props.
+bool RenderUntilCulled(vtkRenderWindow *renWin,
+                       vtkOcclusionCullingPass *culling, int expected)
+{
+  for (int frame = 0; frame < 10; ++frame)
+    {
+    renWin->Render();
+    if (culling->GetNumberOfCulledProps() == expected)
+      {
+      return true;
+      }
+    }
+  cerr << "Culled " << culling->GetNumberOfCulledProps() << " props instead of "
+       << expected << endl;
+  return false;
+}
+
+}
+
+int TestOcclusionCullingPass(int, char *[])
+{
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  vtkNew<vtkRenderer> renderer;
+  renWin->AddRenderer(renderer.Get());
+
+  vtkNew<vtkPlaneSource> wall;
+  wall->SetOrigin(-10.0, -10.0, 0.0);
+  wall->SetPoint1(10.0, -10.0, 0.0);
+  wall->SetPoint2(-10.0, 10.0, 0.0);
+  vtkNew<vtkPolyDataMapper> wallMapper;
+  wallMapper->SetInputConnection(wall->GetOutputPort());
+  vtkNew<vtkActor> wallActor;
+  wallActor->SetMapper(wallMapper.Get());
+  renderer->AddActor(wallActor.Get());
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(0.4);
+  vtkNew<vtkPolyDataMapper> sphereMapper;
+  sphereMapper->SetInputConnection(sphere->GetOutputPort());
+  for (int i = 0; i < 25; ++i)
+    {
+    vtkNew<vtkActor> actor;
+    actor->SetMapper(sphereMapper.Get());
+    actor->SetPosition(2.0 * (i % 5) - 4.0, 2.0 * (i / 5) - 4.0, -3.0);
+    renderer->AddActor(actor.Get());
+    }
+  vtkNew<vtkActor> front;
+  front->SetMapper(sphereMapper.Get());
+  front->SetPosition(0.0, 0.0, 3.0);
+  renderer->AddActor(front.Get());
+
+  vtkNew<vtkRenderStepsPass> steps;
+  vtkNew<vtkOcclusionCullingPass> culling;
+  culling->SetDelegatePass(steps->GetOpaquePass());
+  steps->SetOpaquePass(culling.Get());
+  vtkOpenGLRenderer::SafeDownCast(renderer.Get())->SetPass(steps.Get());
+
+  vtkCamera *camera = renderer->GetActiveCamera();
+  camera->SetPosition(0.0, 0.0, 20.0);
+  camera->SetFocalPoint(0.0, 0.0, 0.0);
+  camera->SetViewUp(0.0, 1.0, 0.0);
+  renderer->ResetCameraClippingRange();
+  if (!RenderUntilCulled(renWin.Get(), culling.Get(), 25))
+    {
+    return EXIT_FAILURE;
+    }
+
+  camera->SetPosition(0.0, 0.0, -20.0);
+  renderer->ResetCameraClippingRange();
+  if (!RenderUntilCulled(renWin.Get(), culling.Get(), 1))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
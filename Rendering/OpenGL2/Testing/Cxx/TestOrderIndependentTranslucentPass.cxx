@@ -0,0 +1,133 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOrderIndependentTranslucentPass.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test covers the weighted blended translucency of vtkRenderer. Three
+// translucent spheres that overlap are rendered with the actors in two
+// orders: the images must be the same, up to the rounding of the sums. The
+// pixels without geometry must keep the background color. The translucency
+// needs an OpenGL 3.2 context, without one only the background is checked.
+
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkNew.h"
+#include "vtkOpenGLRenderWindow.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkProperty.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstdlib>
+
+namespace
+{
+
+void AddSphere(vtkRenderer *renderer, vtkPolyDataMapper *mapper,
+               double x, double r, double g, double b)
+{
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  actor->SetPosition(x, 0.0, 0.0);
+  actor->GetProperty()->SetColor(r, g, b);
+  actor->GetProperty()->SetOpacity(0.5);
+  renderer->AddActor(actor.Get());
+}
+
+void GetPixels(vtkRenderWindow *renWin, vtkUnsignedCharArray *pixels)
+{
+  renWin->Render();
+  int *size = renWin->GetSize();
+  renWin->GetPixelData(0, 0, size[0] - 1, size[1] - 1, 1, pixels);
+}
+
+bool SamePixels(vtkUnsignedCharArray *expected, vtkUnsignedCharArray *pixels)
+{
+  if (expected->GetNumberOfTuples() != pixels->GetNumberOfTuples())
+    {
+    return false;
+    }
+  vtkIdType size =
+    expected->GetNumberOfTuples() * expected->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < size; ++i)
+    {
+    if (abs(expected->GetValue(i) - pixels->GetValue(i)) > 1)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int TestOrderIndependentTranslucentPass(int, char *[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputConnection(sphere->GetOutputPort());
+
+  vtkNew<vtkUnsignedCharArray> pixels[2];
+  for (int i = 0; i < 2; ++i)
+    {
+    vtkNew<vtkRenderWindow> renWin;
+    renWin->SetSize(300, 300);
+    renWin->SetMultiSamples(0);
+    vtkNew<vtkRenderer> renderer;
+    renderer->SetBackground(0.2, 0.4, 0.6);
+    renderer->UseWeightedBlendedTranslucencyOn();
+    renWin->AddRenderer(renderer.Get());
+
+    if (i == 0)
+      {
+      AddSphere(renderer.Get(), mapper.Get(), -0.3, 1.0, 0.0, 0.0);
+      AddSphere(renderer.Get(), mapper.Get(), 0.0, 0.0, 1.0, 0.0);
+      AddSphere(renderer.Get(), mapper.Get(), 0.3, 0.0, 0.0, 1.0);
+      }
+    else
+      {
+      AddSphere(renderer.Get(), mapper.Get(), 0.3, 0.0, 0.0, 1.0);
+      AddSphere(renderer.Get(), mapper.Get(), 0.0, 0.0, 1.0, 0.0);
+      AddSphere(renderer.Get(), mapper.Get(), -0.3, 1.0, 0.0, 0.0);
+      }
+
+    vtkCamera *camera = renderer->GetActiveCamera();
+    camera->SetPosition(0.0, 0.0, 5.0);
+    camera->SetFocalPoint(0.0, 0.0, 0.0);
+    camera->SetViewUp(0.0, 1.0, 0.0);
+    renderer->ResetCameraClippingRange();
+    GetPixels(renWin.Get(), pixels[i].Get());
+
+    // the lower left corner is background
+    unsigned char corner[3];
+    pixels[i]->GetTupleValue(0, corner);
+    if (corner[0] != 51 || corner[1] != 102 || corner[2] != 153)
+      {
+      cerr << "The background color changed to " << int(corner[0]) << " "
+           << int(corner[1]) << " " << int(corner[2]) << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  if (vtkOpenGLRenderWindow::GetContextSupportsOpenGL32() &&
+      !SamePixels(pixels[0].Get(), pixels[1].Get()))
+    {
+    cerr << "The image depends on the order of the actors" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
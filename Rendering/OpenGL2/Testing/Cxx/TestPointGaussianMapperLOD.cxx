@@ -0,0 +1,107 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPointGaussianMapperLOD.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test covers the level of detail of vtkOpenGLPointGaussianMapper. A
+// small budget must be respected, a small upload rate must still converge
+// after a few renders, a budget larger than the cloud must draw all of it,
+// and a camera looking away must draw nothing.
+
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkNew.h"
+#include "vtkOpenGLPointGaussianMapper.h"
+#include "vtkPointSource.h"
+#include "vtkPolyData.h"
+#include "vtkRandomAttributeGenerator.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+
+int TestPointGaussianMapperLOD(int, char *[])
+{
+  vtkNew<vtkPointSource> points;
+  points->SetNumberOfPoints(100000);
+  points->SetRadius(10.0);
+  vtkNew<vtkRandomAttributeGenerator> randomAttr;
+  randomAttr->SetInputConnection(points->GetOutputPort());
+  randomAttr->SetDataTypeToFloat();
+  randomAttr->GeneratePointScalarsOn();
+  points->Update();
+  vtkIdType numPoints = points->GetOutput()->GetNumberOfPoints();
+
+  vtkNew<vtkOpenGLPointGaussianMapper> mapper;
+  mapper->SetInputConnection(randomAttr->GetOutputPort());
+  mapper->SetScaleArray("RandomPointScalars");
+  mapper->SetScaleFactor(0.1);
+  mapper->SetNodeSize(256);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  vtkNew<vtkRenderer> renderer;
+  renWin->AddRenderer(renderer.Get());
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper.Get());
+  renderer->AddActor(actor.Get());
+  renderer->ResetCamera();
+
+  mapper->SetPointBudget(5000);
+  mapper->SetNodeUploadsPerRender(1000);
+  renWin->Render();
+  if (mapper->GetNumberOfRenderedPoints() <= 0 ||
+      mapper->GetNumberOfRenderedPoints() > 5000)
+    {
+    cerr << "Rendered " << mapper->GetNumberOfRenderedPoints()
+         << " points with a budget of 5000" << endl;
+    return EXIT_FAILURE;
+    }
+
+  mapper->SetNodeUploadsPerRender(1);
+  renWin->Render();
+  if (mapper->GetNumberOfPendingNodes() == 0)
+    {
+    cerr << "Every node was uploaded in a single render" << endl;
+    return EXIT_FAILURE;
+    }
+  for (int i = 0; i < 100 && mapper->GetNumberOfPendingNodes() > 0; ++i)
+    {
+    renWin->Render();
+    }
+  if (mapper->GetNumberOfPendingNodes() > 0)
+    {
+    cerr << "The refinement did not complete" << endl;
+    return EXIT_FAILURE;
+    }
+
+  mapper->SetPointBudget(100 * numPoints);
+  mapper->SetNodeUploadsPerRender(100000);
+  renWin->Render();
+  if (mapper->GetNumberOfRenderedPoints() != numPoints)
+    {
+    cerr << "Rendered " << mapper->GetNumberOfRenderedPoints()
+         << " points instead of " << numPoints << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkCamera *camera = renderer->GetActiveCamera();
+  camera->SetFocalPoint(0.0, 0.0, 100.0);
+  camera->SetPosition(0.0, 0.0, 50.0);
+  renWin->Render();
+  if (mapper->GetNumberOfRenderedPoints() != 0)
+    {
+    cerr << "Rendered " << mapper->GetNumberOfRenderedPoints()
+         << " points behind the camera" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
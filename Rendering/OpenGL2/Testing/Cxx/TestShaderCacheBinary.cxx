@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestShaderCacheBinary.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test covers the program binaries of vtkOpenGLShaderCache. A first
+// window compiles the programs of a sphere and saves their binaries, a
+// second window must load them and render the same image. Without support
+// for program binaries nothing is saved and only the first window renders.
+
+#include "vtkActor.h"
+#include "vtkNew.h"
+#include "vtkOpenGLRenderWindow.h"
+#include "vtkOpenGLShaderCache.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+
+#include "vtksys/SystemTools.hxx"
+
+#include <string>
+
+namespace
+{
+
+// Render a sphere in a new window that caches its programs in \p dir.
+// The number of binaries loaded and saved by the window are returned.
+void RenderSphere(const std::string &dir, vtkUnsignedCharArray *pixels,
+                  int &loaded, int &saved)
+{
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper.Get());
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor.Get());
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(200, 200);
+  renWin->AddRenderer(renderer.Get());
+  vtkOpenGLShaderCache *cache =
+    vtkOpenGLRenderWindow::SafeDownCast(renWin.Get())->GetShaderCache();
+  cache->SetBinaryCacheDirectory(dir.c_str());
+  renWin->Render();
+  renWin->GetPixelData(0, 0, 199, 199, 1, pixels);
+  loaded = cache->GetNumberOfLoadedBinaries();
+  saved = cache->GetNumberOfSavedBinaries();
+}
+
+bool SamePixels(vtkUnsignedCharArray *expected, vtkUnsignedCharArray *pixels)
+{
+  if (expected->GetNumberOfTuples() != pixels->GetNumberOfTuples())
+    {
+    return false;
+    }
+  vtkIdType size =
+    expected->GetNumberOfTuples() * expected->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < size; ++i)
+    {
+    if (expected->GetValue(i) != pixels->GetValue(i))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int TestShaderCacheBinary(int argc, char *argv[])
+{
+  char *tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string dir = std::string(tempDir) + "/TestShaderCacheBinary";
+  delete [] tempDir;
+  vtksys::SystemTools::RemoveADirectory(dir);
+
+  vtkNew<vtkUnsignedCharArray> expected;
+  int loaded = 0;
+  int saved = 0;
+  RenderSphere(dir, expected.Get(), loaded, saved);
+  if (loaded != 0)
+    {
+    cerr << "Loaded " << loaded << " binaries from an empty directory" << endl;
+    return EXIT_FAILURE;
+    }
+  if (saved == 0)
+    {
+    cout << "Program binaries are not supported" << endl;
+    return EXIT_SUCCESS;
+    }
+
+  vtkNew<vtkUnsignedCharArray> pixels;
+  RenderSphere(dir, pixels.Get(), loaded, saved);
+  if (loaded == 0 || saved != 0)
+    {
+    cerr << "Loaded " << loaded << " and saved " << saved
+         << " binaries instead of loading every program" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!SamePixels(expected.Get(), pixels.Get()))
+    {
+    cerr << "The loaded programs changed the image" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtksys::SystemTools::RemoveADirectory(dir);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,27 @@
+//VTK::System::Dec
+
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGlyph3DCullingFS.glsl
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Culling step of the glyph mapper: nothing is rasterized, but a program
+// needs a fragment shader.
+
+// the output of this shader
+//VTK::Output::Dec
+
+void main()
+{
+  gl_FragData[0] = vec4(1.0);
+}
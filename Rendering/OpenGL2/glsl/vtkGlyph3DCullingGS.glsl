@@ -0,0 +1,44 @@
+//VTK::System::Dec
+
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGlyph3DCullingGS.glsl
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Culling step of the glyph mapper: emit the glyphs kept by the vertex
+// shader, captured by transform feedback.
+
+layout(points) in;
+layout(points, max_vertices = 1) out;
+
+in mat4 glyphMatrixVSOutput[];
+in mat3 glyphNormalMatrixVSOutput[];
+in vec4 glyphColorVSOutput[];
+in float keepVSOutput[];
+
+out mat4 glyphMatrixTF;
+out mat3 glyphNormalMatrixTF;
+out vec4 glyphColorTF;
+
+void main()
+{
+  if (keepVSOutput[0] > 0.0)
+    {
+    glyphMatrixTF = glyphMatrixVSOutput[0];
+    glyphNormalMatrixTF = glyphNormalMatrixVSOutput[0];
+    glyphColorTF = glyphColorVSOutput[0];
+    gl_Position = gl_in[0].gl_Position;
+    EmitVertex();
+    EndPrimitive();
+    }
+}
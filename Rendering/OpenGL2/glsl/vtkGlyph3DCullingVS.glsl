@@ -0,0 +1,62 @@
+//VTK::System::Dec
+
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGlyph3DCullingVS.glsl
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Culling step of the glyph mapper: each point is a glyph, kept when its
+// bounding sphere is in the view frustum and its distance to the camera is
+// in the range of the current level of detail.
+
+attribute mat4 GCMCMatrix;
+attribute mat3 glyphNormalMatrix;
+attribute vec4 glyphColor;
+
+uniform mat4 MCVCMatrix;
+uniform vec4 cullPlanes[6]; // normalized frustum planes in model coordinates
+uniform vec3 glyphCenter; // bounding sphere of the glyph
+uniform float glyphRadius;
+uniform vec2 lodRange; // distances to the camera of this level
+
+varying mat4 glyphMatrixVSOutput;
+varying mat3 glyphNormalMatrixVSOutput;
+varying vec4 glyphColorVSOutput;
+varying float keepVSOutput;
+
+void main()
+{
+  vec4 center = GCMCMatrix * vec4(glyphCenter, 1.0);
+  float scale = max(length(GCMCMatrix[0].xyz),
+    max(length(GCMCMatrix[1].xyz), length(GCMCMatrix[2].xyz)));
+  float radius = glyphRadius * scale;
+
+  keepVSOutput = 1.0;
+  for (int i = 0; i < 6; i++)
+    {
+    if (dot(cullPlanes[i].xyz, center.xyz) + cullPlanes[i].w < -radius)
+      {
+      keepVSOutput = 0.0;
+      }
+    }
+  float distance = length((MCVCMatrix * center).xyz);
+  if (distance < lodRange.x || distance >= lodRange.y)
+    {
+    keepVSOutput = 0.0;
+    }
+
+  glyphMatrixVSOutput = GCMCMatrix;
+  glyphNormalMatrixVSOutput = glyphNormalMatrix;
+  glyphColorVSOutput = glyphColor;
+  gl_Position = center;
+}
@@ -0,0 +1,28 @@
+//VTK::System::Dec
+
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkOcclusionCullingPassFS.glsl
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Fragment shader of the bounding boxes tested by the occlusion culling
+// pass. Only the samples that pass the depth test matter, color writes are
+// disabled.
+
+// the output of this shader
+//VTK::Output::Dec
+
+void main(void)
+{
+  gl_FragData[0] = vec4(1.0);
+}
@@ -0,0 +1,26 @@
+//VTK::System::Dec
+
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkOcclusionCullingPassVS.glsl
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Vertex shader of the bounding boxes tested by the occlusion culling pass.
+// The corners are already in clip coordinates.
+
+attribute vec4 vertexDC;
+
+void main()
+{
+  gl_Position = vertexDC;
+}
@@ -0,0 +1,39 @@
+//VTK::System::Dec
+
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkOrderIndependentTranslucentPassFinalFS.glsl
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+varying vec2 tcoordVC;
+
+uniform sampler2D accumulationTexture;
+uniform sampler2D weightTexture;
+
+// the output of this shader
+//VTK::Output::Dec
+
+void main()
+{
+  vec4 accumulation = texture2D(accumulationTexture, tcoordVC);
+  float weight = texture2D(weightTexture, tcoordVC).r;
+
+  // the alpha of the accumulation is the fraction of the opaque geometry
+  // that shows through
+  if (accumulation.a >= 1.0)
+    {
+    discard;
+    }
+  gl_FragData[0] = vec4(accumulation.rgb / max(weight, 0.00001),
+    1.0 - accumulation.a);
+}
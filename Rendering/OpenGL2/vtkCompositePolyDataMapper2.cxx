@@ -28,9 +28,11 @@
 #include "vtkMultiPieceDataSet.h"
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLBufferObject.h"
+#include "vtkOpenGLHardwareSelector.h"
 #include "vtkOpenGLIndexBufferObject.h"
 #include "vtkOpenGLRenderWindow.h"
 #include "vtkOpenGLTexture.h"
+#include "vtkOpenGLVertexArrayObject.h"
 #include "vtkOpenGLVertexBufferObject.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -50,11 +52,44 @@ vtkCompositePolyDataMapper2::vtkCompositePolyDataMapper2()
   this->MaximumFlatIndex = 0;
   this->CanUseTextureMapForColoringSet = false;
   this->CanUseTextureMapForColoringValue = false;
+  this->BlockIndexBuffer = 0;
+  this->BlockAttributeBuffer = 0;
+  this->BlockAttributeTexture = 0;
 }
 
 //----------------------------------------------------------------------------
 vtkCompositePolyDataMapper2::~vtkCompositePolyDataMapper2()
 {
+  if (this->BlockIndexBuffer)
+    {
+    this->BlockIndexBuffer->Delete();
+    }
+  if (this->BlockAttributeBuffer)
+    {
+    this->BlockAttributeBuffer->Delete();
+    }
+  if (this->BlockAttributeTexture)
+    { // Resources released previously.
+    this->BlockAttributeTexture->Delete();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCompositePolyDataMapper2::ReleaseGraphicsResources(vtkWindow* win)
+{
+  if (this->BlockIndexBuffer)
+    {
+    this->BlockIndexBuffer->ReleaseGraphicsResources();
+    }
+  if (this->BlockAttributeBuffer)
+    {
+    this->BlockAttributeBuffer->ReleaseGraphicsResources();
+    }
+  if (this->BlockAttributeTexture)
+    {
+    this->BlockAttributeTexture->ReleaseGraphicsResources(win);
+    }
+  this->Superclass::ReleaseGraphicsResources(win);
 }
 
 //----------------------------------------------------------------------------
@@ -71,28 +106,93 @@ void vtkCompositePolyDataMapper2::FreeStructures()
   this->EdgeIndexArray.resize(0);
   this->EdgeIndexOffsets.resize(0);
   this->RenderValues.resize(0);
+  this->BlockAttributes.resize(0);
 }
 
 void vtkCompositePolyDataMapper2::ReplaceShaderColor(
   std::map<vtkShader::Type, vtkShader *> shaders,
   vtkRenderer *ren, vtkActor *actor)
 {
-  std::string FSSource = shaders[vtkShader::Fragment]->GetSource();
+  // edges are drawn in the edge color whatever the block
+  if (!this->DrawingEdges)
+    {
+    std::string VSSource = shaders[vtkShader::Vertex]->GetSource();
+    std::string GSSource = shaders[vtkShader::Geometry]->GetSource();
+    std::string FSSource = shaders[vtkShader::Fragment]->GetSource();
+
+    // pass the block index of the vertex down to the fragment shader,
+    // which looks up the color and opacity of the block
+    vtkShaderProgram::Substitute(VSSource,"//VTK::Color::Dec",
+      "//VTK::Color::Dec\n"
+      "attribute float blockIndexMC;\n"
+      "varying float blockIndexVSOutput;",false);
+    vtkShaderProgram::Substitute(VSSource,"//VTK::Color::Impl",
+      "//VTK::Color::Impl\n"
+      "  blockIndexVSOutput = blockIndexMC;",false);
+
+    vtkShaderProgram::Substitute(GSSource,"//VTK::Color::Dec",
+      "//VTK::Color::Dec\n"
+      "in float blockIndexVSOutput[];\n"
+      "out float blockIndexGSOutput;",false);
+    vtkShaderProgram::Substitute(GSSource,"//VTK::Color::Impl",
+      "//VTK::Color::Impl\n"
+      "blockIndexGSOutput = blockIndexVSOutput[i];",false);
+
+    vtkShaderProgram::Substitute(FSSource,"//VTK::Color::Dec",
+      "uniform samplerBuffer blockAttributes;\n"
+      "varying float blockIndexVSOutput;\n"
+      "//VTK::Color::Dec",false);
+    vtkShaderProgram::Substitute(FSSource,"//VTK::Color::Impl",
+      "//VTK::Color::Impl\n"
+      "  int blockIndex = int(blockIndexVSOutput + 0.5);\n"
+      "  vec4 blockAmbient = texelFetchBuffer(blockAttributes, 2*blockIndex);\n"
+      "  vec4 blockDiffuse = texelFetchBuffer(blockAttributes, 2*blockIndex + 1);\n"
+      "  if (blockAmbient.a > 0.0) {\n"
+      "    ambientColor = blockAmbient.rgb;\n"
+      "    diffuseColor = blockDiffuse.rgb; }\n"
+      "  opacity = opacity*blockDiffuse.a;\n",
+      false);
+
+    shaders[vtkShader::Vertex]->SetSource(VSSource);
+    shaders[vtkShader::Geometry]->SetSource(GSSource);
+    shaders[vtkShader::Fragment]->SetSource(FSSource);
+    }
 
-  vtkShaderProgram::Substitute(FSSource,"//VTK::Color::Dec",
-    "uniform bool OverridesColor;\n"
-    "//VTK::Color::Dec",false);
+  this->Superclass::ReplaceShaderColor(shaders,ren,actor);
+}
 
-  vtkShaderProgram::Substitute(FSSource,"//VTK::Color::Impl",
-    "//VTK::Color::Impl\n"
-    "  if (OverridesColor) {\n"
-    "    ambientColor = ambientColorUniform;\n"
-    "    diffuseColor = diffuseColorUniform; }\n",
-    false);
+//-----------------------------------------------------------------------------
+void vtkCompositePolyDataMapper2::SetMapperShaderParameters(
+  vtkOpenGLHelper &cellBO, vtkRenderer *ren, vtkActor *actor)
+{
+  bool updateAttributes = cellBO.IBO->IndexCount &&
+    (this->VBOBuildTime > cellBO.AttributeUpdateTime ||
+     cellBO.ShaderSourceTime > cellBO.AttributeUpdateTime);
 
-  shaders[vtkShader::Fragment]->SetSource(FSSource);
+  this->Superclass::SetMapperShaderParameters(cellBO, ren, actor);
 
-  this->Superclass::ReplaceShaderColor(shaders,ren,actor);
+  if (this->DrawingEdges)
+    {
+    return;
+    }
+
+  if (updateAttributes)
+    {
+    cellBO.VAO->Bind();
+    if (!cellBO.VAO->AddAttributeArray(cellBO.Program,
+                                    this->BlockIndexBuffer,
+                                    "blockIndexMC", 0, sizeof(float),
+                                    VTK_FLOAT, 1, false))
+      {
+      vtkErrorMacro(<< "Error setting 'blockIndexMC' in shader VAO.");
+      }
+    }
+
+  if (this->BlockAttributeTexture)
+    {
+    cellBO.Program->SetUniformi("blockAttributes",
+      this->BlockAttributeTexture->GetTextureUnit());
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -200,6 +300,12 @@ void vtkCompositePolyDataMapper2::Render(
       }
 #endif
 
+    // the block attributes are read from a buffer texture, which
+    // OpenGL ES does not have
+#if GL_ES_VERSION_2_0 == 1
+    this->UseGeneric = true;
+#endif
+
     // clear old structures if the render method changed
     if (lastUseGeneric != this->UseGeneric)
       {
@@ -350,30 +456,34 @@ void vtkCompositePolyDataMapper2::BuildRenderValues(
     }
   else
     {
-    double op = this->BlockState.Opacity.top();
     bool vis = this->BlockState.Visibility.top();
-    vtkColor3d acolor = this->BlockState.AmbientColor.top();
-    vtkColor3d dcolor = this->BlockState.DiffuseColor.top();
+    vtkColor3d &acolor = this->BlockState.AmbientColor.top();
+    vtkColor3d &dcolor = this->BlockState.DiffuseColor.top();
+    vtkProperty *ppty = actor->GetProperty();
+    float *attributes = &this->BlockAttributes[8*my_flat_index];
+    for (int i = 0; i < 3; ++i)
+      {
+      attributes[i] = static_cast<float>(acolor[i] * ppty->GetAmbient());
+      attributes[4 + i] = static_cast<float>(dcolor[i] * ppty->GetDiffuse());
+      }
+    attributes[3] = (this->BlockState.AmbientColor.size() > 1) ? 1.0f : 0.0f;
+    attributes[7] = static_cast<float>(this->BlockState.Opacity.top());
+
     if (this->RenderValues.size() == 0)
       {
       vtkCompositePolyDataMapper2::RenderValue rv;
       rv.StartVertex = 0;
       rv.StartIndex = 0;
       rv.StartEdgeIndex = 0;
-      rv.Opacity = op;
       rv.Visibility = vis;
-      rv.AmbientColor = acolor;
-      rv.DiffuseColor = dcolor;
       rv.PickId = my_flat_index;
-      rv.OverridesColor = (this->BlockState.AmbientColor.size() > 1);
       this->RenderValues.push_back(rv);
       }
 
-    // has something changed?
-    if (this->RenderValues.back().Opacity != op ||
-        this->RenderValues.back().Visibility != vis ||
-        this->RenderValues.back().AmbientColor != acolor ||
-        this->RenderValues.back().DiffuseColor != dcolor ||
+    // has something changed? The colors and opacities of the blocks
+    // come from the block attributes, so only the visibility splits
+    // the blocks into ranges.
+    if (this->RenderValues.back().Visibility != vis ||
         selector)
       {
       // close old group
@@ -385,12 +495,8 @@ void vtkCompositePolyDataMapper2::BuildRenderValues(
       rv.StartVertex = lastVertex;
       rv.StartIndex = lastIndex;
       rv.StartEdgeIndex = lastEdgeIndex;
-      rv.Opacity = op;
       rv.Visibility = vis;
-      rv.AmbientColor = acolor;
-      rv.DiffuseColor = dcolor;
       rv.PickId = my_flat_index;
-      rv.OverridesColor = (this->BlockState.AmbientColor.size() > 1);
       this->RenderValues.push_back(rv);
       }
     lastVertex = this->VertexOffsets[my_flat_index];
@@ -434,7 +540,8 @@ void vtkCompositePolyDataMapper2::RenderPieceDraw(
   if (this->RenderValuesBuildTime < this->GetMTime() ||
       this->RenderValuesBuildTime < actor->GetProperty()->GetMTime() ||
       this->RenderValuesBuildTime < this->VBOBuildTime ||
-      this->RenderValuesBuildTime < this->SelectionStateChanged)
+      this->RenderValuesBuildTime < this->SelectionStateChanged ||
+      this->RenderValuesBuildTime < this->BlockAttributesTime)
     {
     vtkCompositeDataSet *input = vtkCompositeDataSet::SafeDownCast(
       this->GetInputDataObject(0, 0));
@@ -442,6 +549,7 @@ void vtkCompositePolyDataMapper2::RenderPieceDraw(
     unsigned int lastIndex = 0;
     unsigned int lastEdgeIndex = 0;
     this->RenderValues.resize(0);
+    this->BlockAttributes.assign(8*(this->MaximumFlatIndex + 1), 0.0f);
     unsigned int flat_index = 0;
     this->BuildRenderValues(ren, actor, input,
       flat_index, lastVertex, lastIndex, lastEdgeIndex);
@@ -449,6 +557,20 @@ void vtkCompositePolyDataMapper2::RenderPieceDraw(
     this->RenderValues.back().EndVertex = lastVertex - 1;
     this->RenderValues.back().EndIndex = lastIndex - 1;
     this->RenderValues.back().EndEdgeIndex = lastEdgeIndex - 1;
+
+    if (!this->BlockAttributeTexture)
+      {
+      this->BlockAttributeTexture = vtkTextureObject::New();
+      this->BlockAttributeBuffer = vtkOpenGLBufferObject::New();
+      }
+    this->BlockAttributeTexture->SetContext(
+      static_cast<vtkOpenGLRenderWindow*>(ren->GetVTKWindow()));
+    this->BlockAttributeBuffer->Upload(this->BlockAttributes,
+      vtkOpenGLBufferObject::TextureBuffer);
+    this->BlockAttributeTexture->CreateTextureBuffer(
+      static_cast<unsigned int>(this->BlockAttributes.size()/4),
+      4, VTK_FLOAT,
+      this->BlockAttributeBuffer);
     this->RenderValuesBuildTime.Modified();
     }
 
@@ -456,6 +578,7 @@ void vtkCompositePolyDataMapper2::RenderPieceDraw(
   if (this->Tris.IBO->IndexCount)
     {
     // First we do the triangles, update the shader, set uniforms, etc.
+    this->BlockAttributeTexture->Activate();
     this->UpdateShaders(this->Tris, ren, actor);
     if (!this->HaveWideLines(ren,actor) && representation == VTK_WIREFRAME)
       {
@@ -467,10 +590,19 @@ void vtkCompositePolyDataMapper2::RenderPieceDraw(
     unsigned int modeDenom = (representation == VTK_POINTS) ? 1 :
       (representation == VTK_WIREFRAME) ? 2 : 3;
 
-    vtkProperty *ppty = actor->GetProperty();
-    double aIntensity = this->DrawingEdges ? 1.0 : ppty->GetAmbient();
-    double dIntensity = this->DrawingEdges ? 0.0 : ppty->GetDiffuse();
     vtkShaderProgram *prog = this->Tris.Program;
+    // the opacity of each block is in the block attributes
+    prog->SetUniformf("opacityUniform", 1.0);
+
+    // gl_PrimitiveID starts over for each range drawn by a multi draw,
+    // so cell colors, normals and selection need one draw per range
+    bool multiDraw = (!selector &&
+      !this->HaveCellScalars && !this->HaveCellNormals);
+#if GL_ES_VERSION_2_0 == 1
+    multiDraw = false;
+#endif
+    std::vector<GLsizei> counts;
+    std::vector<const GLvoid *> offsets;
 
     std::vector<
       vtkCompositePolyDataMapper2::RenderValue>::iterator it;
@@ -478,7 +610,14 @@ void vtkCompositePolyDataMapper2::RenderPieceDraw(
     this->PrimitiveIDOffset = 0;
     for (it = this->RenderValues.begin(); it != this->RenderValues.end(); it++)
       {
-      if (it->Visibility)
+      if (it->Visibility && multiDraw)
+        {
+        counts.push_back(
+          static_cast<GLsizei>(it->EndIndex - it->StartIndex + 1));
+        offsets.push_back(
+          reinterpret_cast<const GLvoid *>(it->StartIndex*sizeof(GLuint)));
+        }
+      else if (it->Visibility)
         {
         if (selector &&
             selector->GetCurrentPass() ==
@@ -487,21 +626,17 @@ void vtkCompositePolyDataMapper2::RenderPieceDraw(
           selector->RenderCompositeIndex(it->PickId);
           prog->SetUniform3f("mapperIndex", selector->GetPropColorValue());
           }
-        // override the opacity and color
-        prog->SetUniformf("opacityUniform", it->Opacity);
-        vtkColor3d &aColor = it->AmbientColor;
-        float ambientColor[3] = {static_cast<float>(aColor[0] * aIntensity),
-          static_cast<float>(aColor[1] * aIntensity),
-          static_cast<float>(aColor[2] * aIntensity)};
-        vtkColor3d &dColor = it->DiffuseColor;
-        float diffuseColor[3] = {static_cast<float>(dColor[0] * dIntensity),
-          static_cast<float>(dColor[1] * dIntensity),
-          static_cast<float>(dColor[2] * dIntensity)};
-        prog->SetUniform3f("ambientColorUniform", ambientColor);
-        prog->SetUniform3f("diffuseColorUniform", diffuseColor);
+        vtkOpenGLHardwareSelector *glSelector =
+          vtkOpenGLHardwareSelector::SafeDownCast(selector);
+        if (glSelector &&
+            glSelector->GetCurrentPass() == vtkHardwareSelector::SINGLE_PASS)
+          {
+          glSelector->RenderCompositeIndex(it->PickId);
+          prog->SetUniform3f("compositeIndex",
+            glSelector->GetCompositeColorValue());
+          }
         prog->SetUniformi("PrimitiveIDOffset",
           this->PrimitiveIDOffset);
-        prog->SetUniformi("OverridesColor", it->OverridesColor);
         glDrawRangeElements(mode,
           static_cast<GLuint>(it->StartVertex),
           static_cast<GLuint>(it->EndVertex),
@@ -512,7 +647,15 @@ void vtkCompositePolyDataMapper2::RenderPieceDraw(
       this->PrimitiveIDOffset +=
         ((it->EndIndex - it->StartIndex + 1)/modeDenom);
       }
+#if GL_ES_VERSION_2_0 != 1
+    if (!counts.empty())
+      {
+      glMultiDrawElements(mode, &counts[0], GL_UNSIGNED_INT,
+        &offsets[0], static_cast<GLsizei>(counts.size()));
+      }
+#endif
     this->Tris.IBO->Release();
+    this->BlockAttributeTexture->Deactivate();
     }
   if (selector && (
         selector->GetCurrentPass() == vtkHardwareSelector::ID_LOW24 ||
@@ -690,6 +833,7 @@ void vtkCompositePolyDataMapper2::BuildBufferObjects(
   // create the cell scalar array adjusted for ogl Cells
   std::vector<unsigned char> newColors;
   std::vector<float> newNorms;
+  std::vector<float> blockIndices;
 
   unsigned int voffset = 0;
   for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
@@ -698,6 +842,7 @@ void vtkCompositePolyDataMapper2::BuildBufferObjects(
     vtkDataObject *dso = iter->GetCurrentDataObject();
     vtkPolyData *pd = vtkPolyData::SafeDownCast(dso);
     this->AppendOneBufferObject(ren, act, pd, voffset, newColors, newNorms);
+    blockIndices.resize(this->VBO->VertexCount, static_cast<float>(fidx));
     this->VertexOffsets[fidx] =
       static_cast<unsigned int>(this->VBO->VertexCount);
     voffset = static_cast<unsigned int>(this->VBO->VertexCount);
@@ -709,6 +854,15 @@ void vtkCompositePolyDataMapper2::BuildBufferObjects(
 
   this->VBO->Upload(this->VBO->PackedVBO, vtkOpenGLBufferObject::ArrayBuffer);
   this->VBO->PackedVBO.resize(0);
+  if (!this->BlockIndexBuffer)
+    {
+    this->BlockIndexBuffer = vtkOpenGLBufferObject::New();
+    }
+  if (!blockIndices.empty())
+    {
+    this->BlockIndexBuffer->Upload(blockIndices,
+      vtkOpenGLBufferObject::ArrayBuffer);
+    }
   this->Tris.IBO->Upload(this->IndexArray,
     vtkOpenGLBufferObject::ElementArrayBuffer);
   this->Tris.IBO->IndexCount = this->IndexArray.size();
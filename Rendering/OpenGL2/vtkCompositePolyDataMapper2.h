@@ -41,6 +41,12 @@ public:
   virtual void RenderPieceDraw(vtkRenderer *ren, vtkActor *act);
   virtual void RenderEdges(vtkRenderer *ren, vtkActor *act);
 
+  // Description:
+  // Release any graphics resources that are being consumed by this mapper.
+  // The parameter window could be used to determine which graphic
+  // resources to release.
+  void ReleaseGraphicsResources(vtkWindow *);
+
 protected:
   vtkCompositePolyDataMapper2();
   ~vtkCompositePolyDataMapper2();
@@ -52,6 +58,12 @@ protected:
     std::map<vtkShader::Type, vtkShader *> shaders,
     vtkRenderer *ren, vtkActor *act);
 
+  // Description:
+  // Set the block index attribute and the block attribute texture,
+  // called by UpdateShader
+  virtual void SetMapperShaderParameters(vtkOpenGLHelper &cellBO,
+    vtkRenderer *ren, vtkActor *act);
+
   // Description:
   // Build the VBO/IBO, called by UpdateBufferObjects
   virtual void BuildBufferObjects(vtkRenderer *ren, vtkActor *act);
@@ -67,6 +79,8 @@ protected:
   std::vector<unsigned int> EdgeIndexOffsets;
   unsigned int MaximumFlatIndex;
 
+  // A range of consecutive blocks of the same visibility, drawn together.
+  // When selecting, every block is a range of its own.
   class RenderValue
     {
     public:
@@ -76,17 +90,24 @@ protected:
       unsigned int EndVertex;
       unsigned int EndIndex;
       unsigned int EndEdgeIndex;
-      double Opacity;
-      bool OverridesColor;
       bool Visibility;
-      vtkColor3d AmbientColor;
-      vtkColor3d DiffuseColor;
       unsigned int PickId;
     };
 
   std::vector<RenderValue> RenderValues;
   vtkTimeStamp RenderValuesBuildTime;
 
+  // The flat index of the block of each vertex, an attribute of the VBO.
+  vtkOpenGLBufferObject *BlockIndexBuffer;
+
+  // Two RGBA texels per flat index, read by the fragment shader: the
+  // ambient color and whether the block overrides the color, then the
+  // diffuse color and the opacity. Changing them only updates this
+  // buffer texture.
+  std::vector<float> BlockAttributes;
+  vtkOpenGLBufferObject *BlockAttributeBuffer;
+  vtkTextureObject *BlockAttributeTexture;
+
   bool UseGeneric;  // use the generic render
   vtkTimeStamp GenericTestTime;
 
@@ -26,6 +26,8 @@
 #include "vtkToolkits.h"
 #include "vtk_glew.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 #include <EGL/egl.h>
 
@@ -111,6 +113,30 @@ vtkEGLRenderWindow::vtkEGLRenderWindow()
 #ifdef VTK_USE_OFFSCREEN_EGL
   this->DeviceIndex = VTK_EGL_DEVICE_INDEX;
 #endif
+  // the environment overrides the index chosen at build time, so that the
+  // processes of a job can be spread over the devices without rebuilding
+  const char* device = vtksys::SystemTools::GetEnv("VTK_EGL_DEVICE_INDEX");
+  if (device && *device)
+    {
+    if (strcmp(device, "local_rank") == 0)
+      {
+      this->DeviceIndex = NODE_LOCAL_RANK;
+      }
+    else
+      {
+      char* end = NULL;
+      long index = strtol(device, &end, 10);
+      if (*end == '\0' && index >= 0 && index <= VTK_INT_MAX)
+        {
+        this->DeviceIndex = static_cast<int>(index);
+        }
+      else
+        {
+        vtkWarningMacro("Ignoring VTK_EGL_DEVICE_INDEX=" << device
+                        << ", expected a device index or local_rank.");
+        }
+      }
+    }
 #if ANDROID
   this->OffScreenRendering = false;
 #else
@@ -219,6 +245,57 @@ int vtkEGLRenderWindow::GetNumberOfDevices()
 }
 
 
+void vtkEGLRenderWindow::SetDeviceIndex(int index)
+{
+  if (index == this->DeviceIndex)
+    {
+    return;
+    }
+  if (index < NODE_LOCAL_RANK)
+    {
+    vtkErrorMacro("Invalid EGL device index: " << index);
+    return;
+    }
+  if (this->Internals->Display != EGL_NO_DISPLAY)
+    {
+    vtkWarningMacro("The EGL device can only be selected before the first "
+                    "render. Keeping device index " << this->DeviceIndex);
+    return;
+    }
+  this->DeviceIndex = index;
+  this->Modified();
+}
+
+
+int vtkEGLRenderWindow::GetNodeLocalRank()
+{
+  // each launcher exports the rank among the processes of the job started
+  // on the same node under its own name
+  static const char* const variables[] =
+    {
+    "OMPI_COMM_WORLD_LOCAL_RANK", // Open MPI
+    "MV2_COMM_WORLD_LOCAL_RANK",  // MVAPICH2
+    "MPI_LOCALRANKID",            // MPICH and Intel MPI (Hydra)
+    "SLURM_LOCALID",              // srun
+    NULL
+    };
+  for (int i = 0; variables[i]; ++i)
+    {
+    const char* value = vtksys::SystemTools::GetEnv(variables[i]);
+    if (value && *value)
+      {
+      char* end = NULL;
+      long rank = strtol(value, &end, 10);
+      if (*end == '\0' && rank >= 0 && rank <= VTK_INT_MAX)
+        {
+        return static_cast<int>(rank);
+        }
+      }
+    }
+  return -1;
+}
+
+
 void vtkEGLRenderWindow::SetDeviceAsDisplay(int deviceIndex)
 {
   vtkInternals* impl = this->Internals;
@@ -297,9 +374,16 @@ void vtkEGLRenderWindow::ResizeWindow(int width, int height)
 
   if (impl->Display == EGL_NO_DISPLAY)
     {
-      if (this->DeviceIndex > 0)
+      int deviceIndex = this->DeviceIndex;
+      if (deviceIndex == NODE_LOCAL_RANK)
+        {
+        int rank = vtkEGLRenderWindow::GetNodeLocalRank();
+        int numDevices = rank > 0 ? this->GetNumberOfDevices() : 0;
+        deviceIndex = numDevices > 0 ? rank % numDevices : 0;
+        }
+      if (deviceIndex > 0)
         {
-        this->SetDeviceAsDisplay(this->DeviceIndex);
+        this->SetDeviceAsDisplay(deviceIndex);
         }
       if (impl->Display == EGL_NO_DISPLAY)
         {
@@ -505,6 +589,15 @@ void vtkEGLRenderWindow::PrintSelf(ostream& os, vtkIndent indent)
   vtkInternals* impl = this->Internals;
   this->Superclass::PrintSelf(os,indent);
 
+  os << indent << "DeviceIndex: ";
+  if (this->DeviceIndex == NODE_LOCAL_RANK)
+    {
+    os << "NODE_LOCAL_RANK\n";
+    }
+  else
+    {
+    os << this->DeviceIndex << "\n";
+    }
   os << indent << "Context: " << impl->Context << "\n";
   os << indent << "Display: " << impl->Display << "\n";
   os << indent << "Surface: " << impl->Surface << "\n";
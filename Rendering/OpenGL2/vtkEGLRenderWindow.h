@@ -19,6 +19,12 @@
 // an offscreen pbuffer for OpenGL.
 // vtkOpenGLRenderer interfaces to the OpenGL graphics library.
 // Application programmers should normally use vtkRenderWindow instead of the OpenGL specific version.
+//
+// On systems with several graphics cards, DeviceIndex selects the one to
+// render on. The VTK_EGL_DEVICE_INDEX environment variable overrides the
+// value configured at build time: it holds either an index or "local_rank",
+// which spreads the processes of a parallel job started on the same node
+// over its devices.
 
 #ifndef vtkEGLRenderWindow_h
 #define vtkEGLRenderWindow_h
@@ -161,6 +167,22 @@ public:
   // Description:
   // Returns the number of devices (graphics cards) on a system.
   int GetNumberOfDevices();
+
+  // Description:
+  // Index of the device (graphics card) to render on. It is used when the
+  // window creates its display, at the first render, and cannot change
+  // after. NODE_LOCAL_RANK selects the device GetNodeLocalRank() modulo
+  // GetNumberOfDevices(), or the default device when the rank is unknown.
+  enum { NODE_LOCAL_RANK = -1 };
+  virtual void SetDeviceIndex(int index);
+  void SetDeviceIndexToNodeLocalRank()
+    { this->SetDeviceIndex(NODE_LOCAL_RANK); }
+
+  // Description:
+  // Rank of this process among the processes of its job on the same node,
+  // as given by the MPI launchers (Open MPI, MPICH, MVAPICH) or Slurm, or
+  // -1 when the process was not started by one of them.
+  static int GetNodeLocalRank();
   // Description:
   // Returns true if driver has an
   // EGL/OpenGL bug that makes vtkChartsCoreCxx-TestChartDoubleColors and other tests to fail
@@ -174,7 +196,6 @@ protected:
 
   int ScreenSize[2];
   int OwnWindow;
-  int DeviceIndex;
   bool IsPointSpriteBugTested;
   bool IsPointSpriteBugPresent_;
   class vtkInternals;
@@ -196,14 +196,16 @@ bool vtkCompositeMapperHelper::GetNeedToRebuildShaders(
     {
     bool result =
       this->Superclass::GetNeedToRebuildShaders(cellBO, ren, actor);
-    this->LastColorCoordinates = this->VBO->ColorComponents;
+    this->LastColorCoordinates =
+      this->VBO->ColorComponents + this->ColorBufferComponents;
     this->LastNormalsOffset = this->VBO->NormalOffset;
     this->LastTCoordComponents = this->VBO->TCoordComponents;
     return result;
     }
 
   // after the first datasedt we only look for changes in pointdata
-  if (this->LastColorCoordinates != this->VBO->ColorComponents ||
+  if (this->LastColorCoordinates !=
+        this->VBO->ColorComponents + this->ColorBufferComponents ||
       this->LastNormalsOffset != this->VBO->NormalOffset ||
       this->LastTCoordComponents != this->VBO->TCoordComponents)
     {
@@ -297,7 +299,8 @@ void vtkGenericCompositePolyDataMapper2::ComputeBounds()
     }
 
   if (input->GetMTime() < this->BoundsMTime &&
-      this->GetMTime() < this->BoundsMTime)
+      this->GetMTime() < this->BoundsMTime &&
+      this->BlockAttributesTime < this->BoundsMTime)
     {
     return;
     }
@@ -314,6 +317,7 @@ bool vtkGenericCompositePolyDataMapper2::GetIsOpaque()
   vtkCompositeDataSet *input = vtkCompositeDataSet::SafeDownCast(
     this->GetInputDataObject(0, 0));
   unsigned long int lastMTime = std::max(input ? input->GetMTime() : 0, this->GetMTime());
+  lastMTime = std::max(lastMTime, this->BlockAttributesTime.GetMTime());
   if (lastMTime <= this->LastOpaqueCheckTime)
     {
     return this->LastOpaqueCheckValue;
@@ -377,7 +381,7 @@ void vtkGenericCompositePolyDataMapper2::SetBlockVisibility(unsigned int index,
   if(this->CompositeAttributes)
     {
     this->CompositeAttributes->SetBlockVisibility(index, visible);
-    this->Modified();
+    this->BlockAttributesTime.Modified();
     }
 }
 
@@ -400,7 +404,7 @@ void vtkGenericCompositePolyDataMapper2::RemoveBlockVisibility(unsigned int inde
   if(this->CompositeAttributes)
     {
     this->CompositeAttributes->RemoveBlockVisibility(index);
-    this->Modified();
+    this->BlockAttributesTime.Modified();
     }
 }
 
@@ -410,7 +414,7 @@ void vtkGenericCompositePolyDataMapper2::RemoveBlockVisibilites()
   if(this->CompositeAttributes)
     {
     this->CompositeAttributes->RemoveBlockVisibilites();
-    this->Modified();
+    this->BlockAttributesTime.Modified();
     }
 }
 
@@ -420,7 +424,7 @@ void vtkGenericCompositePolyDataMapper2::SetBlockColor(unsigned int index, doubl
   if(this->CompositeAttributes)
     {
     this->CompositeAttributes->SetBlockColor(index, color);
-    this->Modified();
+    this->BlockAttributesTime.Modified();
     }
 }
 
@@ -446,7 +450,7 @@ void vtkGenericCompositePolyDataMapper2::RemoveBlockColor(unsigned int index)
   if(this->CompositeAttributes)
     {
     this->CompositeAttributes->RemoveBlockColor(index);
-    this->Modified();
+    this->BlockAttributesTime.Modified();
     }
 }
 
@@ -456,7 +460,7 @@ void vtkGenericCompositePolyDataMapper2::RemoveBlockColors()
   if(this->CompositeAttributes)
     {
     this->CompositeAttributes->RemoveBlockColors();
-    this->Modified();
+    this->BlockAttributesTime.Modified();
     }
 }
 
@@ -466,7 +470,7 @@ void vtkGenericCompositePolyDataMapper2::SetBlockOpacity(unsigned int index, dou
   if(this->CompositeAttributes)
     {
     this->CompositeAttributes->SetBlockOpacity(index, opacity);
-    this->Modified();
+    this->BlockAttributesTime.Modified();
     }
 }
 
@@ -486,7 +490,7 @@ void vtkGenericCompositePolyDataMapper2::RemoveBlockOpacity(unsigned int index)
   if(this->CompositeAttributes)
     {
     this->CompositeAttributes->RemoveBlockOpacity(index);
-    this->Modified();
+    this->BlockAttributesTime.Modified();
     }
 }
 
@@ -496,7 +500,7 @@ void vtkGenericCompositePolyDataMapper2::RemoveBlockOpacities()
   if(this->CompositeAttributes)
     {
     this->CompositeAttributes->RemoveBlockOpacities();
-    this->Modified();
+    this->BlockAttributesTime.Modified();
     }
 }
 
@@ -588,7 +592,9 @@ void vtkGenericCompositePolyDataMapper2::RenderBlock(vtkRenderer *renderer,
     // Implies that the block is a non-null leaf node.
     // The top of the "stacks" have the state that this block must be rendered
     // with.
-    if (selector && selector->GetCurrentPass() == vtkHardwareSelector::COMPOSITE_INDEX_PASS)
+    if (selector &&
+        (selector->GetCurrentPass() == vtkHardwareSelector::COMPOSITE_INDEX_PASS ||
+         selector->GetCurrentPass() == vtkHardwareSelector::SINGLE_PASS))
       {
       selector->BeginRenderProp();
       selector->RenderCompositeIndex(my_flat_index);
@@ -58,6 +58,8 @@ public:
 
   // Description:
   // Set/get the visibility for a block given its flat index.
+  // Changing the visibility, color or opacity of blocks does not modify
+  // the mapper, so that the buffer objects and shaders are not rebuilt.
   void SetBlockVisibility(unsigned int index, bool visible);
   bool GetBlockVisibility(unsigned int index) const;
   void RemoveBlockVisibility(unsigned int index);
@@ -111,6 +113,10 @@ protected:
   // Time stamp for computation of bounds.
   vtkTimeStamp BoundsMTime;
 
+  // Description:
+  // Time of the last change of the block visibilities, colors or opacities.
+  vtkTimeStamp BlockAttributesTime;
+
   // what "index" are we currently rendering, -1 means none
   int CurrentFlatIndex;
   std::map<const vtkShaderProgram *, bool> ShadersInitialized;
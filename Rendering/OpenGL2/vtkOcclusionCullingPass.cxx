@@ -0,0 +1,423 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkOcclusionCullingPass.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkOcclusionCullingPass.h"
+#include "vtkObjectFactory.h"
+#include <cassert>
+
+#include "vtk_glew.h"
+#include "vtkMath.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMatrix4x4.h"
+#include "vtkOpenGLBufferObject.h"
+#include "vtkOpenGLCamera.h"
+#include "vtkOpenGLError.h"
+#include "vtkOpenGLHelper.h"
+#include "vtkOpenGLRenderWindow.h"
+#include "vtkOpenGLShaderCache.h"
+#include "vtkOpenGLVertexArrayObject.h"
+#include "vtkProp.h"
+#include "vtkRenderer.h"
+#include "vtkRenderState.h"
+#include "vtkShaderProgram.h"
+
+#include "vtkOcclusionCullingPassFS.h"
+#include "vtkOcclusionCullingPassVS.h"
+
+#include <map>
+#include <vector>
+
+// Occlusion state of one prop, kept from one frame to the next.
+class vtkOcclusionCullingPropState
+{
+public:
+  vtkOcclusionCullingPropState()
+    : Query(0), Pending(false), Visible(true), OccludedFrames(0), Used(false)
+    {
+    }
+
+  GLuint Query;
+  bool Pending;
+  bool Visible;
+  int OccludedFrames;
+  bool Used;
+};
+
+class vtkOcclusionCullingPassInternals
+{
+public:
+  std::map<vtkProp *, vtkOcclusionCullingPropState> States;
+
+  // Props whose box is drawn at this render, and their boxes, 36 vertices
+  // of 4 clip coordinates each.
+  std::vector<vtkOcclusionCullingPropState *> Tested;
+  std::vector<float> Boxes;
+};
+
+namespace
+{
+
+// The 12 triangles of a box, as indices of corners whose bits 0, 1 and 2
+// select the maximum x, y and z.
+const int BoxTriangles[36] =
+{
+  0, 2, 6, 0, 6, 4,
+  1, 5, 7, 1, 7, 3,
+  0, 4, 5, 0, 5, 1,
+  2, 3, 7, 2, 7, 6,
+  0, 1, 3, 0, 3, 2,
+  4, 6, 7, 4, 7, 5
+};
+
+// Append the triangles of the box \p bounds in clip coordinates to
+// \p boxes. \p wcdc is the transposed world to clip matrix of the camera.
+// Return false without appending anything when the box crosses the near
+// plane, as the part of the box behind the camera would not be drawn.
+bool AppendBox(const double bounds[6], vtkMatrix4x4 *wcdc,
+               std::vector<float> &boxes)
+{
+  float corners[8][4];
+  for (int c = 0; c < 8; ++c)
+    {
+    double wc[4] = { bounds[c & 1], bounds[2 + ((c >> 1) & 1)],
+                     bounds[4 + ((c >> 2) & 1)], 1.0 };
+    double dc[4];
+    for (int j = 0; j < 4; ++j)
+      {
+      dc[j] = 0.0;
+      for (int i = 0; i < 4; ++i)
+        {
+        dc[j] += wc[i] * wcdc->GetElement(i, j);
+        }
+      corners[c][j] = static_cast<float>(dc[j]);
+      }
+    if (dc[3] <= 0.0 || dc[2] < -dc[3])
+      {
+      return false;
+      }
+    }
+  for (int v = 0; v < 36; ++v)
+    {
+    boxes.insert(boxes.end(), corners[BoxTriangles[v]],
+                 corners[BoxTriangles[v]] + 4);
+    }
+  return true;
+}
+
+}
+
+vtkStandardNewMacro(vtkOcclusionCullingPass);
+vtkCxxSetObjectMacro(vtkOcclusionCullingPass,DelegatePass,vtkRenderPass);
+
+// ----------------------------------------------------------------------------
+vtkOcclusionCullingPass::vtkOcclusionCullingPass()
+{
+  this->DelegatePass = 0;
+  this->NumberOfOccludedFrames = 3;
+  this->PixelThreshold = 0;
+  this->NumberOfCulledProps = 0;
+  this->Internals = new vtkOcclusionCullingPassInternals;
+  this->BoxProgram = 0;
+  this->BoxBuffer = vtkOpenGLBufferObject::New();
+}
+
+// ----------------------------------------------------------------------------
+vtkOcclusionCullingPass::~vtkOcclusionCullingPass()
+{
+  if (this->DelegatePass != 0)
+    {
+    this->DelegatePass->Delete();
+    }
+  delete this->Internals;
+  delete this->BoxProgram;
+  this->BoxBuffer->Delete();
+}
+
+// ----------------------------------------------------------------------------
+void vtkOcclusionCullingPass::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "NumberOfOccludedFrames: " << this->NumberOfOccludedFrames
+     << endl;
+  os << indent << "PixelThreshold: " << this->PixelThreshold << endl;
+  os << indent << "NumberOfCulledProps: " << this->NumberOfCulledProps
+     << endl;
+  os << indent << "DelegatePass:";
+  if (this->DelegatePass != 0)
+    {
+    this->DelegatePass->PrintSelf(os,indent);
+    }
+  else
+    {
+    os << "(none)" <<endl;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Description:
+// Perform rendering according to a render state \p s.
+// \pre s_exists: s!=0
+void vtkOcclusionCullingPass::Render(const vtkRenderState *s)
+{
+  assert("pre: s_exists" && s != 0);
+
+  this->NumberOfRenderedProps = 0;
+  this->NumberOfCulledProps = 0;
+  if (this->DelegatePass == 0)
+    {
+    vtkWarningMacro(<<" no delegate.");
+    return;
+    }
+
+  vtkRenderer *ren = s->GetRenderer();
+  vtkOpenGLCamera *cam =
+    vtkOpenGLCamera::SafeDownCast(ren->GetActiveCamera());
+
+#if GL_ES_VERSION_2_0 != 1
+  // a selection needs the ids of every prop
+  if (cam && !ren->GetSelector() && !ren->GetIsPicking())
+    {
+    vtkMatrix4x4 *wcvc;
+    vtkMatrix3x3 *norms;
+    vtkMatrix4x4 *vcdc;
+    vtkMatrix4x4 *wcdc;
+    cam->GetKeyMatrices(ren, wcvc, norms, vcdc, wcdc);
+
+    std::map<vtkProp *, vtkOcclusionCullingPropState> &states =
+      this->Internals->States;
+    std::map<vtkProp *, vtkOcclusionCullingPropState>::iterator it;
+    for (it = states.begin(); it != states.end(); ++it)
+      {
+      it->second.Used = false;
+      }
+    this->Internals->Tested.clear();
+    this->Internals->Boxes.clear();
+
+    std::vector<vtkProp *> props;
+    props.reserve(s->GetPropArrayCount());
+    for (int i = 0; i < s->GetPropArrayCount(); ++i)
+      {
+      vtkProp *p = s->GetPropArray()[i];
+      vtkOcclusionCullingPropState &state = states[p];
+      state.Used = true;
+
+      // the result of a query issued at a previous frame, if it is there
+      if (state.Pending)
+        {
+        GLuint available = 0;
+        glGetQueryObjectuiv(state.Query, GL_QUERY_RESULT_AVAILABLE,
+                            &available);
+        if (available)
+          {
+          GLuint samples = 0;
+          glGetQueryObjectuiv(state.Query, GL_QUERY_RESULT, &samples);
+          state.Pending = false;
+          if (samples > static_cast<GLuint>(this->PixelThreshold))
+            {
+            state.OccludedFrames = 0;
+            state.Visible = true;
+            }
+          else if (++state.OccludedFrames >= this->NumberOfOccludedFrames)
+            {
+            state.Visible = false;
+            }
+          }
+        }
+
+      double *bounds = p->GetBounds();
+      size_t boxesSize = this->Internals->Boxes.size();
+      if (!bounds || !vtkMath::AreBoundsInitialized(bounds) ||
+          !AppendBox(bounds, wcdc, this->Internals->Boxes))
+        {
+        state.OccludedFrames = 0;
+        state.Visible = true;
+        }
+      else if (state.Pending)
+        {
+        // the query is still running, its box is not drawn again
+        this->Internals->Boxes.resize(boxesSize);
+        }
+      else
+        {
+        this->Internals->Tested.push_back(&state);
+        }
+
+      if (state.Visible)
+        {
+        props.push_back(p);
+        }
+      else
+        {
+        ++this->NumberOfCulledProps;
+        }
+      }
+
+    // forget the props that are gone
+    it = states.begin();
+    while (it != states.end())
+      {
+      if (it->second.Used)
+        {
+        ++it;
+        continue;
+        }
+      if (it->second.Query)
+        {
+        glDeleteQueries(1, &it->second.Query);
+        }
+      states.erase(it++);
+      }
+
+    vtkRenderState s2(ren);
+    s2.SetFrameBuffer(s->GetFrameBuffer());
+    s2.SetPropArrayAndCount(props.empty() ? 0 : &props[0],
+                            static_cast<int>(props.size()));
+    s2.SetRequiredKeys(s->GetRequiredKeys());
+    this->DelegatePass->Render(&s2);
+    this->NumberOfRenderedProps =
+      this->DelegatePass->GetNumberOfRenderedProps();
+
+    if (!this->Internals->Tested.empty())
+      {
+      this->RenderBoxes(
+        vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow()));
+      }
+    vtkOpenGLCheckErrorMacro("failed after occlusion queries");
+    return;
+    }
+#endif
+
+  this->DelegatePass->Render(s);
+  this->NumberOfRenderedProps =
+    this->DelegatePass->GetNumberOfRenderedProps();
+}
+
+// ----------------------------------------------------------------------------
+void vtkOcclusionCullingPass::RenderBoxes(vtkOpenGLRenderWindow *renWin)
+{
+#if GL_ES_VERSION_2_0 != 1
+  if (!this->BoxProgram)
+    {
+    this->BoxProgram = new vtkOpenGLHelper;
+    std::string VSSource = vtkOcclusionCullingPassVS;
+    std::string FSSource = vtkOcclusionCullingPassFS;
+    std::string GSSource;
+    this->BoxProgram->Program =
+      renWin->GetShaderCache()->ReadyShaderProgram(
+        VSSource.c_str(),
+        FSSource.c_str(),
+        GSSource.c_str());
+    }
+  else
+    {
+    renWin->GetShaderCache()->ReadyShaderProgram(this->BoxProgram->Program);
+    }
+  if (!this->BoxProgram->Program ||
+      !this->BoxProgram->Program->GetCompiled())
+    {
+    vtkErrorMacro("Couldn't build the shader program of the boxes.");
+    return;
+    }
+
+  this->BoxBuffer->Upload(this->Internals->Boxes,
+                          vtkOpenGLBufferObject::ArrayBuffer);
+  this->BoxProgram->VAO->Bind();
+  if (!this->BoxProgram->VAO->AddAttributeArray(this->BoxProgram->Program,
+        this->BoxBuffer, "vertexDC", 0, 4 * sizeof(float), VTK_FLOAT, 4,
+        false))
+    {
+    vtkErrorMacro(<< "Error setting 'vertexDC' in shader VAO.");
+    this->BoxProgram->VAO->Release();
+    return;
+    }
+
+  // test the boxes against the depth buffer without changing anything
+  GLboolean colorMask[4];
+  glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+  GLboolean depthMask;
+  glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+  GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+  GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+  glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+  glDepthMask(GL_FALSE);
+  glEnable(GL_DEPTH_TEST);
+  glDisable(GL_CULL_FACE);
+
+  std::vector<vtkOcclusionCullingPropState *> &tested =
+    this->Internals->Tested;
+  for (size_t i = 0; i < tested.size(); ++i)
+    {
+    if (!tested[i]->Query)
+      {
+      glGenQueries(1, &tested[i]->Query);
+      }
+    glBeginQuery(GL_SAMPLES_PASSED, tested[i]->Query);
+    glDrawArrays(GL_TRIANGLES, static_cast<GLint>(36 * i), 36);
+    glEndQuery(GL_SAMPLES_PASSED);
+    tested[i]->Pending = true;
+    }
+
+  glColorMask(colorMask[0], colorMask[1], colorMask[2], colorMask[3]);
+  glDepthMask(depthMask);
+  if (!depthTest)
+    {
+    glDisable(GL_DEPTH_TEST);
+    }
+  if (cullFace)
+    {
+    glEnable(GL_CULL_FACE);
+    }
+  this->BoxProgram->VAO->Release();
+#else
+  (void)renWin;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Description:
+// Release graphics resources and ask components to release their own
+// resources.
+// \pre w_exists: w!=0
+void vtkOcclusionCullingPass::ReleaseGraphicsResources(vtkWindow *w)
+{
+  assert("pre: w_exists" && w != 0);
+
+  if (this->DelegatePass != 0)
+    {
+    this->DelegatePass->ReleaseGraphicsResources(w);
+    }
+  if (this->BoxProgram != 0)
+    {
+    this->BoxProgram->ReleaseGraphicsResources(w);
+    delete this->BoxProgram;
+    this->BoxProgram = 0;
+    }
+  this->BoxBuffer->ReleaseGraphicsResources();
+
+#if GL_ES_VERSION_2_0 != 1
+  std::map<vtkProp *, vtkOcclusionCullingPropState>::iterator it;
+  for (it = this->Internals->States.begin();
+       it != this->Internals->States.end(); ++it)
+    {
+    if (it->second.Query)
+      {
+      glDeleteQueries(1, &it->second.Query);
+      }
+    }
+#endif
+  this->Internals->States.clear();
+  this->Internals->Tested.clear();
+}
@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkOcclusionCullingPass.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkOcclusionCullingPass - Skip the props hidden in previous frames.
+// .SECTION Description
+// vtkOcclusionCullingPass renders its delegate pass with the props that were
+// not occluded in the previous frames. After the delegate, it draws the
+// bounding box of every prop inside an occlusion query, against the depth
+// buffer left by the delegate and without writing any color or depth.
+//
+// The queries are read at the next frame without waiting for the GPU: a
+// prop whose query is not finished keeps its previous state. A prop is
+// culled only after its box passed no more than PixelThreshold samples for
+// NumberOfOccludedFrames results in a row, and it is rendered again as soon
+// as one result sees more, so that props do not flicker while the camera
+// moves. A prop whose box crosses the near plane of the camera is always
+// rendered.
+//
+// This pass is meant to wrap the opaque step of vtkRenderStepsPass:
+// \code
+// culling->SetDelegatePass(steps->GetOpaquePass());
+// steps->SetOpaquePass(culling);
+// \endcode
+// The other steps still get every prop. OpenGL ES 2 has no occlusion
+// queries, there the delegate renders every prop.
+//
+// .SECTION See Also
+// vtkRenderPass vtkRenderStepsPass vtkFrustumCoverageCuller
+
+#ifndef vtkOcclusionCullingPass_h
+#define vtkOcclusionCullingPass_h
+
+#include "vtkRenderingOpenGL2Module.h" // For export macro
+#include "vtkRenderPass.h"
+
+class vtkOpenGLBufferObject;
+class vtkOpenGLHelper;
+class vtkOpenGLRenderWindow;
+class vtkOcclusionCullingPassInternals; // Pimpl
+
+class VTKRENDERINGOPENGL2_EXPORT vtkOcclusionCullingPass : public vtkRenderPass
+{
+public:
+  static vtkOcclusionCullingPass *New();
+  vtkTypeMacro(vtkOcclusionCullingPass,vtkRenderPass);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  //BTX
+  // Description:
+  // Perform rendering according to a render state \p s.
+  // \pre s_exists: s!=0
+  virtual void Render(const vtkRenderState *s);
+  //ETX
+
+  // Description:
+  // Release graphics resources and ask components to release their own
+  // resources.
+  // \pre w_exists: w!=0
+  virtual void ReleaseGraphicsResources(vtkWindow *w);
+
+  // Description:
+  // Delegate for rendering the props that are not culled.
+  // Initial value is a NULL pointer.
+  vtkGetObjectMacro(DelegatePass,vtkRenderPass);
+  virtual void SetDelegatePass(vtkRenderPass *delegatePass);
+
+  // Description:
+  // Number of occlusion results in a row that must find the box of a prop
+  // hidden before the prop is culled. Initial value is 3.
+  vtkSetClampMacro(NumberOfOccludedFrames,int,1,VTK_INT_MAX);
+  vtkGetMacro(NumberOfOccludedFrames,int);
+
+  // Description:
+  // A box that passes no more than this number of samples is hidden.
+  // Initial value is 0.
+  vtkSetClampMacro(PixelThreshold,int,0,VTK_INT_MAX);
+  vtkGetMacro(PixelThreshold,int);
+
+  // Description:
+  // Number of props left out of the delegate at the last render.
+  vtkGetMacro(NumberOfCulledProps,int);
+
+ protected:
+  // Description:
+  // Default constructor. DelegatePass is set to NULL.
+  vtkOcclusionCullingPass();
+
+  // Description:
+  // Destructor.
+  virtual ~vtkOcclusionCullingPass();
+
+  // Description:
+  // Draw the boxes of the props tested at this render, each one inside
+  // the occlusion query of its prop.
+  void RenderBoxes(vtkOpenGLRenderWindow *renWin);
+
+  vtkRenderPass *DelegatePass;
+  int NumberOfOccludedFrames;
+  int PixelThreshold;
+  int NumberOfCulledProps;
+
+  vtkOcclusionCullingPassInternals *Internals;
+
+  vtkOpenGLHelper *BoxProgram;
+  vtkOpenGLBufferObject *BoxBuffer;
+
+ private:
+  vtkOcclusionCullingPass(const vtkOcclusionCullingPass&);  // Not implemented.
+  void operator=(const vtkOcclusionCullingPass&);  // Not implemented.
+};
+
+#endif
@@ -16,6 +16,7 @@
 #include "vtkOpenGLHelper.h"
 
 #include "vtkBitArray.h"
+#include "vtkBoundingBox.h"
 #include "vtkCamera.h"
 #include "vtkDataObject.h"
 #include "vtkHardwareSelector.h"
@@ -24,7 +25,9 @@
 #include "vtkMatrix4x4.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkOpenGLActor.h"
 #include "vtkOpenGLBufferObject.h"
+#include "vtkOpenGLCamera.h"
 #include "vtkOpenGLError.h"
 #include "vtkOpenGLIndexBufferObject.h"
 #include "vtkOpenGLRenderWindow.h"
@@ -32,13 +35,35 @@
 #include "vtkOpenGLShaderCache.h"
 #include "vtkOpenGLVertexArrayObject.h"
 #include "vtkOpenGLVertexBufferObject.h"
+#include "vtkPolyData.h"
 #include "vtkProperty.h"
 #include "vtkShader.h"
 #include "vtkShaderProgram.h"
 #include "vtkTransform.h"
+#include "vtkTransformFeedback.h"
 
+#include "vtkGlyph3DCullingFS.h"
+#include "vtkGlyph3DCullingGS.h"
+#include "vtkGlyph3DCullingVS.h"
 #include "vtkGlyph3DVS.h"
 
+#if GL_ES_VERSION_2_0 != 1
+namespace
+{
+
+// Allocate \p size bytes, left undefined, for the transform feedback.
+void AllocateCulledBuffer(vtkOpenGLBufferObject *buffer, size_t size)
+{
+  buffer->GenerateBuffer(vtkOpenGLBufferObject::ArrayBuffer);
+  buffer->Bind();
+  glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), NULL,
+    GL_DYNAMIC_COPY);
+  buffer->Release();
+}
+
+}
+#endif
+
 //-----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkOpenGLGlyph3DHelper)
 
@@ -53,6 +78,16 @@ vtkOpenGLGlyph3DHelper::vtkOpenGLGlyph3DHelper()
   this->ModelColor = NULL;
   this->UseFastPath = false;
   this->UsingInstancing = false;
+  this->CullingAndLOD = false;
+  this->CullingProgram = NULL;
+  this->CullingFeedback = NULL;
+  this->CulledMatrixBuffer = vtkOpenGLBufferObject::New();
+  this->CulledNormalMatrixBuffer = vtkOpenGLBufferObject::New();
+  this->CulledColorBuffer = vtkOpenGLBufferObject::New();
+  this->CulledBufferCapacity = 0;
+  this->NumberOfCulledInstances = 0;
+  this->CullingQuery = 0;
+  this->CulledAttributesBound = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -64,6 +99,29 @@ vtkOpenGLGlyph3DHelper::~vtkOpenGLGlyph3DHelper()
   this->MatrixBuffer = 0;
   this->ColorBuffer->Delete();
   this->ColorBuffer = 0;
+  this->CulledMatrixBuffer->Delete();
+  this->CulledMatrixBuffer = 0;
+  this->CulledNormalMatrixBuffer->Delete();
+  this->CulledNormalMatrixBuffer = 0;
+  this->CulledColorBuffer->Delete();
+  this->CulledColorBuffer = 0;
+  delete this->CullingProgram;
+  this->CullingProgram = 0;
+  if (this->CullingFeedback)
+    {
+    this->CullingFeedback->Delete();
+    this->CullingFeedback = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkOpenGLGlyph3DHelper::SetCullingAndLOD(bool culling,
+  const std::vector<vtkOpenGLGlyph3DHelper *> &lodHelpers,
+  const std::vector<double> &lodDistances)
+{
+  this->CullingAndLOD = culling;
+  this->LODHelpers = lodHelpers;
+  this->LODDistances = lodDistances;
 }
 
 
@@ -75,6 +133,28 @@ void vtkOpenGLGlyph3DHelper::ReleaseGraphicsResources(vtkWindow *window)
   this->NormalMatrixBuffer->ReleaseGraphicsResources();
   this->MatrixBuffer->ReleaseGraphicsResources();
   this->ColorBuffer->ReleaseGraphicsResources();
+  this->MatrixBufferLoadTime = vtkTimeStamp();
+  this->NormalMatrixBufferLoadTime = vtkTimeStamp();
+  this->ColorBufferLoadTime = vtkTimeStamp();
+  if (this->CullingProgram)
+    {
+    this->CullingProgram->ReleaseGraphicsResources(window);
+    delete this->CullingProgram;
+    this->CullingProgram = 0;
+    }
+  this->CulledMatrixBuffer->ReleaseGraphicsResources();
+  this->CulledNormalMatrixBuffer->ReleaseGraphicsResources();
+  this->CulledColorBuffer->ReleaseGraphicsResources();
+  this->CulledBufferCapacity = 0;
+  this->NumberOfCulledInstances = 0;
+#if GL_ES_VERSION_2_0 != 1
+  if (this->CullingQuery)
+    {
+    GLuint query = static_cast<GLuint>(this->CullingQuery);
+    glDeleteQueries(1, &query);
+    this->CullingQuery = 0;
+    }
+#endif
   this->Superclass::ReleaseGraphicsResources(window);
 }
 
@@ -371,7 +451,8 @@ void vtkOpenGLGlyph3DHelper::GlyphRender(
   std::vector<float> &matrices,
   std::vector<float> &normalMatrices,
   std::vector<vtkIdType> &pickIds,
-  unsigned long pointMTime)
+  unsigned long matricesMTime,
+  unsigned long colorsMTime)
 {
   // we always tell our triangle VAO to emulate unless we
   // have opngl 3.2 to be safe
@@ -392,7 +473,7 @@ void vtkOpenGLGlyph3DHelper::GlyphRender(
       !selector && GLEW_ARB_instanced_arrays)
     {
     this->GlyphRenderInstances(ren, actor, numPts,
-      colors, matrices, normalMatrices, pointMTime);
+      colors, matrices, normalMatrices, matricesMTime, colorsMTime);
     return;
     }
 #endif
@@ -525,53 +606,67 @@ void vtkOpenGLGlyph3DHelper::GlyphRenderInstances(
     vtkRenderer* ren, vtkActor* actor, vtkIdType numPts,
     std::vector<unsigned char> &colors, std::vector<float> &matrices,
     std::vector<float> &normalMatrices,
-    unsigned long pointMTime)
+    unsigned long matricesMTime, unsigned long colorsMTime)
 {
+#if GL_ES_VERSION_2_0 != 1
+  // the culling step needs a geometry shader
+  if (this->CullingAndLOD &&
+      vtkOpenGLRenderWindow::GetContextSupportsOpenGL32())
+    {
+    this->UploadInstanceBuffers(colors, matrices, normalMatrices, true,
+      matricesMTime, colorsMTime);
+    if (this->CullInstances(ren, actor, numPts))
+      {
+      this->GlyphRenderCulledInstances(ren, actor);
+      for (size_t i = 0; i < this->LODHelpers.size(); ++i)
+        {
+        this->LODHelpers[i]->GlyphRenderCulledInstances(ren, actor);
+        }
+      return;
+      }
+    }
+#endif
+
   this->UsingInstancing = true;
   this->RenderPieceStart(ren,actor);
   this->UpdateShaders(this->Tris, ren, actor);
 
-  // do the superclass and then reset a couple values
+  bool normals = this->VBO->NormalOffset &&
+    this->LastLightComplexity[this->LastBoundBO] > 0;
+  bool uploaded = this->UploadInstanceBuffers(colors, matrices,
+    normalMatrices, normals, matricesMTime, colorsMTime);
+
+  // the VAO only needs the buffers again when they or the VAO changed
   if (this->Tris.IBO->IndexCount &&   // we have points and one of
-      (this->VBOBuildTime > this->InstanceBuffersLoadTime ||
-      this->Tris.ShaderSourceTime > this->InstanceBuffersLoadTime ||
-      pointMTime > this->InstanceBuffersLoadTime.GetMTime()))
+      (uploaded || this->CulledAttributesBound ||
+      this->VBOBuildTime > this->InstanceBuffersLoadTime ||
+      this->Tris.ShaderSourceTime > this->InstanceBuffersLoadTime))
     {
     this->Tris.VAO->Bind();
-    // add 3 new BOs?
-    this->MatrixBuffer->Bind();
-    this->MatrixBuffer->Upload(matrices, vtkOpenGLBufferObject::ArrayBuffer);
     if (!this->Tris.VAO->AddAttributeMatrixWithDivisor(this->Tris.Program, this->MatrixBuffer,
         "GCMCMatrix", 0, 16*sizeof(float), VTK_FLOAT, 4, false, 1))
       {
       vtkErrorMacro(<< "Error setting 'GCMCMatrix' in shader VAO.");
       }
-    this->MatrixBuffer->Release();
 
-    if (this->VBO->NormalOffset && this->LastLightComplexity[this->LastBoundBO] > 0)
+    if (normals)
       {
-      this->NormalMatrixBuffer->Bind();
-      this->NormalMatrixBuffer->Upload(
-        normalMatrices, vtkOpenGLBufferObject::ArrayBuffer);
       if (!this->Tris.VAO->AddAttributeMatrixWithDivisor(
             this->Tris.Program, this->NormalMatrixBuffer,
             "glyphNormalMatrix", 0, 9*sizeof(float), VTK_FLOAT, 3, false, 1))
         {
         vtkErrorMacro(<< "Error setting 'glyphNormalMatrix' in shader VAO.");
         }
-      this->NormalMatrixBuffer->Release();
       }
 
-    this->ColorBuffer->Bind();
-    this->ColorBuffer->Upload(colors, vtkOpenGLBufferObject::ArrayBuffer);
     if (!this->Tris.VAO->AddAttributeArrayWithDivisor(
           this->Tris.Program, this->ColorBuffer,
           "glyphColor", 0, 4*sizeof(unsigned char), VTK_UNSIGNED_CHAR, 4, true, 1, false))
       {
       vtkErrorMacro(<< "Error setting 'diffuse color' in shader VAO.");
       }
-    this->ColorBuffer->Release();
 
+    this->CulledAttributesBound = false;
     this->InstanceBuffersLoadTime.Modified();
     }
 
@@ -597,6 +692,292 @@ void vtkOpenGLGlyph3DHelper::GlyphRenderInstances(
   this->Tris.IBO->Release();
   this->RenderPieceFinish(ren, actor);
 }
+
+//-----------------------------------------------------------------------------
+bool vtkOpenGLGlyph3DHelper::UploadInstanceBuffers(
+    std::vector<unsigned char> &colors, std::vector<float> &matrices,
+    std::vector<float> &normalMatrices, bool normals,
+    unsigned long matricesMTime, unsigned long colorsMTime)
+{
+  bool uploaded = false;
+  if (matricesMTime > this->MatrixBufferLoadTime)
+    {
+    this->MatrixBuffer->Upload(matrices, vtkOpenGLBufferObject::ArrayBuffer);
+    this->MatrixBuffer->Release();
+    this->MatrixBufferLoadTime.Modified();
+    uploaded = true;
+    }
+  if (normals && matricesMTime > this->NormalMatrixBufferLoadTime)
+    {
+    this->NormalMatrixBuffer->Upload(
+      normalMatrices, vtkOpenGLBufferObject::ArrayBuffer);
+    this->NormalMatrixBuffer->Release();
+    this->NormalMatrixBufferLoadTime.Modified();
+    uploaded = true;
+    }
+  if (colorsMTime > this->ColorBufferLoadTime)
+    {
+    this->ColorBuffer->Upload(colors, vtkOpenGLBufferObject::ArrayBuffer);
+    this->ColorBuffer->Release();
+    this->ColorBufferLoadTime.Modified();
+    uploaded = true;
+    }
+  return uploaded;
+}
+#endif
+
+#if GL_ES_VERSION_2_0 != 1
+//-----------------------------------------------------------------------------
+bool vtkOpenGLGlyph3DHelper::CullInstances(
+    vtkRenderer* ren, vtkActor* actor, vtkIdType numPts)
+{
+  vtkOpenGLRenderWindow *renWin =
+    vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow());
+
+  if (!this->CullingFeedback)
+    {
+    this->CullingFeedback = vtkTransformFeedback::New();
+    this->CullingFeedback->SetBufferMode(GL_SEPARATE_ATTRIBS);
+    this->CullingFeedback->AddVarying(
+      vtkTransformFeedback::Matrix4x4_F, "glyphMatrixTF");
+    this->CullingFeedback->AddVarying(
+      vtkTransformFeedback::Matrix3x3_F, "glyphNormalMatrixTF");
+    this->CullingFeedback->AddVarying(
+      vtkTransformFeedback::Color_RGBA_F, "glyphColorTF");
+    }
+  if (!this->CullingProgram)
+    {
+    this->CullingProgram = new vtkOpenGLHelper;
+    std::string VSSource = vtkGlyph3DCullingVS;
+    std::string FSSource = vtkGlyph3DCullingFS;
+    std::string GSSource = vtkGlyph3DCullingGS;
+    this->CullingProgram->Program =
+      renWin->GetShaderCache()->ReadyShaderProgram(
+        VSSource.c_str(),
+        FSSource.c_str(),
+        GSSource.c_str(),
+        this->CullingFeedback);
+    }
+  else
+    {
+    renWin->GetShaderCache()->ReadyShaderProgram(
+      this->CullingProgram->Program, this->CullingFeedback);
+    }
+  vtkShaderProgram *program = this->CullingProgram->Program;
+  if (!program || !program->GetCompiled())
+    {
+    vtkErrorMacro("Couldn't build the culling shader program, the glyphs "
+                  "are drawn without culling.");
+    return false;
+    }
+
+  // the frustum planes and the distances are in model coordinates
+  vtkOpenGLCamera *cam = (vtkOpenGLCamera *)(ren->GetActiveCamera());
+  vtkMatrix4x4 *wcdc;
+  vtkMatrix4x4 *wcvc;
+  vtkMatrix3x3 *norms;
+  vtkMatrix4x4 *vcdc;
+  cam->GetKeyMatrices(ren,wcvc,norms,vcdc,wcdc);
+  vtkMatrix4x4 *mcwc = 0;
+  if (!actor->GetIsIdentity())
+    {
+    vtkMatrix3x3 *anorms;
+    ((vtkOpenGLActor *)actor)->GetKeyMatrices(mcwc,anorms);
+    vtkMatrix4x4::Multiply4x4(mcwc, wcdc, this->TempMatrix4);
+    }
+  else
+    {
+    this->TempMatrix4->DeepCopy(wcdc);
+    }
+
+  // the matrices are transposed, row i of the projection is column i here
+  float planes[6][4];
+  for (int i = 0; i < 3; ++i)
+    {
+    for (int j = 0; j < 4; ++j)
+      {
+      planes[2*i][j] = static_cast<float>(
+        this->TempMatrix4->GetElement(j, 3) +
+        this->TempMatrix4->GetElement(j, i));
+      planes[2*i+1][j] = static_cast<float>(
+        this->TempMatrix4->GetElement(j, 3) -
+        this->TempMatrix4->GetElement(j, i));
+      }
+    }
+  for (int i = 0; i < 6; ++i)
+    {
+    float norm = vtkMath::Norm(planes[i]);
+    if (norm > 0.0)
+      {
+      for (int j = 0; j < 4; ++j)
+        {
+        planes[i][j] /= norm;
+        }
+      }
+    }
+  program->SetUniform4fv("cullPlanes", 6, planes);
+
+  if (mcwc)
+    {
+    vtkMatrix4x4::Multiply4x4(mcwc, wcvc, this->TempMatrix4);
+    program->SetUniformMatrix("MCVCMatrix", this->TempMatrix4);
+    }
+  else
+    {
+    program->SetUniformMatrix("MCVCMatrix", wcvc);
+    }
+
+  // one bounding sphere holds the glyph of every level
+  std::vector<vtkOpenGLGlyph3DHelper *> levels(1, this);
+  levels.insert(levels.end(), this->LODHelpers.begin(), this->LODHelpers.end());
+  vtkBoundingBox box;
+  for (size_t l = 0; l < levels.size(); ++l)
+    {
+    vtkPolyData *input = levels[l]->GetInput();
+    if (input && input->GetNumberOfPoints())
+      {
+      box.AddBounds(input->GetBounds());
+      }
+    }
+  double center[3] = { 0.0, 0.0, 0.0 };
+  if (box.IsValid())
+    {
+    box.GetCenter(center);
+    }
+  float glyphCenter[3] = { static_cast<float>(center[0]),
+    static_cast<float>(center[1]), static_cast<float>(center[2]) };
+  program->SetUniform3f("glyphCenter", glyphCenter);
+  program->SetUniformf("glyphRadius", box.IsValid() ?
+    static_cast<float>(box.GetDiagonalLength() / 2.0) : 0.0f);
+
+  this->CullingProgram->VAO->Bind();
+  if (!this->CullingProgram->VAO->AddAttributeMatrixWithDivisor(program,
+        this->MatrixBuffer, "GCMCMatrix", 0, 16*sizeof(float), VTK_FLOAT, 4,
+        false, 0) ||
+      !this->CullingProgram->VAO->AddAttributeMatrixWithDivisor(program,
+        this->NormalMatrixBuffer, "glyphNormalMatrix", 0, 9*sizeof(float),
+        VTK_FLOAT, 3, false, 0) ||
+      !this->CullingProgram->VAO->AddAttributeArray(program,
+        this->ColorBuffer, "glyphColor", 0, 4*sizeof(unsigned char),
+        VTK_UNSIGNED_CHAR, 4, true))
+    {
+    vtkErrorMacro(<< "Error setting the glyph attributes in the culling VAO.");
+    this->CullingProgram->VAO->Release();
+    return false;
+    }
+
+  // one transform feedback per level, each one into the culled buffers of
+  // the helper of that level, before waiting for any count
+  glEnable(GL_RASTERIZER_DISCARD);
+  for (size_t l = 0; l < levels.size(); ++l)
+    {
+    vtkOpenGLGlyph3DHelper *level = levels[l];
+    if (level->CulledBufferCapacity < numPts)
+      {
+      AllocateCulledBuffer(level->CulledMatrixBuffer, numPts*16*sizeof(float));
+      AllocateCulledBuffer(level->CulledNormalMatrixBuffer,
+        numPts*9*sizeof(float));
+      AllocateCulledBuffer(level->CulledColorBuffer, numPts*4*sizeof(float));
+      level->CulledBufferCapacity = numPts;
+      }
+    if (!level->CullingQuery)
+      {
+      GLuint query;
+      glGenQueries(1, &query);
+      level->CullingQuery = static_cast<unsigned int>(query);
+      }
+
+    float lodRange[2] = {
+      l == 0 ? 0.0f : static_cast<float>(this->LODDistances[l-1]),
+      l < this->LODDistances.size() ?
+        static_cast<float>(this->LODDistances[l]) : VTK_FLOAT_MAX };
+    program->SetUniform2f("lodRange", lodRange);
+
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0,
+      static_cast<GLuint>(level->CulledMatrixBuffer->GetHandle()));
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 1,
+      static_cast<GLuint>(level->CulledNormalMatrixBuffer->GetHandle()));
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 2,
+      static_cast<GLuint>(level->CulledColorBuffer->GetHandle()));
+    glBeginQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN,
+      static_cast<GLuint>(level->CullingQuery));
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(numPts));
+    glEndTransformFeedback();
+    glEndQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN);
+    }
+  for (GLuint i = 0; i < 3; ++i)
+    {
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, i, 0);
+    }
+  glDisable(GL_RASTERIZER_DISCARD);
+  this->CullingProgram->VAO->Release();
+
+  for (size_t l = 0; l < levels.size(); ++l)
+    {
+    GLuint count = 0;
+    glGetQueryObjectuiv(static_cast<GLuint>(levels[l]->CullingQuery),
+      GL_QUERY_RESULT, &count);
+    levels[l]->NumberOfCulledInstances = static_cast<vtkIdType>(count);
+    }
+
+  vtkOpenGLCheckErrorMacro("failed after culling the glyphs");
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void vtkOpenGLGlyph3DHelper::GlyphRenderCulledInstances(
+    vtkRenderer* ren, vtkActor* actor)
+{
+  this->CurrentInput = this->GetInput();
+  if (this->NumberOfCulledInstances <= 0 || !this->CurrentInput ||
+      this->CurrentInput->GetNumberOfPoints() == 0)
+    {
+    return;
+    }
+
+  this->UsingInstancing = true;
+  this->RenderPieceStart(ren,actor);
+  this->UpdateShaders(this->Tris, ren, actor);
+
+  if (this->Tris.IBO->IndexCount)
+    {
+    // the culled buffers hold the colors as floats
+    this->Tris.VAO->Bind();
+    if (!this->Tris.VAO->AddAttributeMatrixWithDivisor(this->Tris.Program,
+          this->CulledMatrixBuffer, "GCMCMatrix", 0, 16*sizeof(float),
+          VTK_FLOAT, 4, false, 1))
+      {
+      vtkErrorMacro(<< "Error setting 'GCMCMatrix' in shader VAO.");
+      }
+    if (this->VBO->NormalOffset &&
+        this->LastLightComplexity[this->LastBoundBO] > 0 &&
+        !this->Tris.VAO->AddAttributeMatrixWithDivisor(this->Tris.Program,
+          this->CulledNormalMatrixBuffer, "glyphNormalMatrix", 0,
+          9*sizeof(float), VTK_FLOAT, 3, false, 1))
+      {
+      vtkErrorMacro(<< "Error setting 'glyphNormalMatrix' in shader VAO.");
+      }
+    if (!this->Tris.VAO->AddAttributeArrayWithDivisor(this->Tris.Program,
+          this->CulledColorBuffer, "glyphColor", 0, 4*sizeof(float),
+          VTK_FLOAT, 4, false, 1, false))
+      {
+      vtkErrorMacro(<< "Error setting 'diffuse color' in shader VAO.");
+      }
+    this->CulledAttributesBound = true;
+
+    this->Tris.IBO->Bind();
+    glDrawElementsInstanced(GL_TRIANGLES,
+                            static_cast<GLsizei>(this->Tris.IBO->IndexCount),
+                            GL_UNSIGNED_INT,
+                            reinterpret_cast<const GLvoid *>(NULL),
+                            static_cast<GLsizei>(this->NumberOfCulledInstances));
+    this->Tris.IBO->Release();
+    vtkOpenGLCheckErrorMacro("failed after Render");
+    }
+
+  this->RenderPieceFinish(ren, actor);
+}
 #endif
 
 //-----------------------------------------------------------------------------
@@ -22,6 +22,7 @@
 #include "vtkOpenGLPolyDataMapper.h"
 
 class vtkBitArray;
+class vtkTransformFeedback;
 
 class VTKRENDERINGOPENGL2_EXPORT vtkOpenGLGlyph3DHelper : public vtkOpenGLPolyDataMapper
 {
@@ -52,11 +53,24 @@ public:
   }
 
   // Description
-  // Fast path for rendering glyphs comprised of only one type of primative
+  // Fast path for rendering glyphs comprised of only one type of primative.
+  // The instance buffers of the matrices and of the colors are uploaded
+  // again only when \p matricesMTime or \p colorsMTime changes.
   void GlyphRender(vtkRenderer* ren, vtkActor* actor, vtkIdType numPts,
       std::vector<unsigned char> &colors, std::vector<float> &matrices,
       std::vector<float> &normalMatrices, std::vector<vtkIdType> &pickIds,
-      unsigned long pointMTime);
+      unsigned long matricesMTime, unsigned long colorsMTime);
+
+  // Description:
+  // When \p culling is on and the glyphs are drawn with instancing, the
+  // glyphs whose bounding sphere is out of the view frustum are removed on
+  // the GPU, with transform feedback, before they are drawn. The glyphs
+  // farther from the camera than lodDistances[i] are drawn by
+  // lodHelpers[i], with its own input, up to the next distance. Distances
+  // must increase and the helpers must outlive this one.
+  void SetCullingAndLOD(bool culling,
+    const std::vector<vtkOpenGLGlyph3DHelper *> &lodHelpers,
+    const std::vector<double> &lodDistances);
 
   // Description:
   // Release any graphics resources that are being consumed by this mapper.
@@ -73,7 +87,27 @@ protected:
   void GlyphRenderInstances(vtkRenderer* ren, vtkActor* actor, vtkIdType numPts,
       std::vector<unsigned char> &colors, std::vector<float> &matrices,
       std::vector<float> &normalMatrices,
-      unsigned long pointMTime);
+      unsigned long matricesMTime, unsigned long colorsMTime);
+
+  // Description:
+  // Upload the instance buffers whose data changed. Return true if one was
+  // uploaded.
+  bool UploadInstanceBuffers(std::vector<unsigned char> &colors,
+      std::vector<float> &matrices, std::vector<float> &normalMatrices,
+      bool normals, unsigned long matricesMTime, unsigned long colorsMTime);
+#endif
+
+#if GL_ES_VERSION_2_0 != 1
+  // Description:
+  // Write the glyphs of the instance buffers that pass the culling in the
+  // culled buffers of this helper and of the LOD helpers, and set their
+  // NumberOfCulledInstances. The instance buffers must be uploaded. Return
+  // false if the glyphs must be drawn without culling.
+  bool CullInstances(vtkRenderer* ren, vtkActor* actor, vtkIdType numPts);
+
+  // Description:
+  // Draw the NumberOfCulledInstances glyphs of the culled buffers.
+  void GlyphRenderCulledInstances(vtkRenderer* ren, vtkActor* actor);
 #endif
 
   // Description:
@@ -126,6 +160,31 @@ protected:
   vtkOpenGLBufferObject *MatrixBuffer;
   vtkOpenGLBufferObject *ColorBuffer;
   vtkTimeStamp InstanceBuffersLoadTime;
+  vtkTimeStamp MatrixBufferLoadTime;
+  vtkTimeStamp NormalMatrixBufferLoadTime;
+  vtkTimeStamp ColorBufferLoadTime;
+
+  // Description:
+  // GPU culling and levels of detail, see SetCullingAndLOD. The culled
+  // buffers hold the glyphs drawn by this helper at the last render, the
+  // colors as floats. The culling program and its transform feedback are
+  // only used by the helper of the first level.
+  bool CullingAndLOD;
+  std::vector<vtkOpenGLGlyph3DHelper *> LODHelpers;
+  std::vector<double> LODDistances;
+  vtkOpenGLHelper *CullingProgram;
+  vtkTransformFeedback *CullingFeedback;
+  vtkOpenGLBufferObject *CulledMatrixBuffer;
+  vtkOpenGLBufferObject *CulledNormalMatrixBuffer;
+  vtkOpenGLBufferObject *CulledColorBuffer;
+  vtkIdType CulledBufferCapacity;
+  vtkIdType NumberOfCulledInstances;
+  unsigned int CullingQuery;
+
+  // Description:
+  // True when the instance attributes of the VAO point to the culled
+  // buffers.
+  bool CulledAttributesBound;
 
 
 private:
@@ -50,7 +50,11 @@ public:
   std::vector<float> Matrices;  // transposed
   std::vector<float> NormalMatrices; // transposed
   vtkTimeStamp BuildTime;
+  vtkTimeStamp MatricesBuildTime;
+  vtkTimeStamp ColorsBuildTime;
   vtkOpenGLGlyph3DHelper *Mapper;
+  std::vector<vtkOpenGLGlyph3DHelper *> LODMappers;
+  vtkTimeStamp LODBuildTime;
   int NumberOfPoints;
 
   vtkOpenGLGlyph3DMapperEntry()
@@ -65,6 +69,24 @@ public:
   ~vtkOpenGLGlyph3DMapperEntry()
   {
     this->Mapper->Delete();
+    this->SetNumberOfLODMappers(0);
+  };
+  void SetNumberOfLODMappers(size_t number)
+  {
+    for (size_t i = number; i < this->LODMappers.size(); ++i)
+      {
+      this->LODMappers[i]->Delete();
+      }
+    size_t oldSize = this->LODMappers.size();
+    this->LODMappers.resize(number, NULL);
+    for (size_t i = oldSize; i < number; ++i)
+      {
+      this->LODMappers[i] = vtkOpenGLGlyph3DHelper::New();
+      vtkPolyData *ss = vtkPolyData::New();
+      this->LODMappers[i]->SetInputData(ss);
+      ss->Delete();
+      this->LODMappers[i]->SetPopulateSelectionSettings(0);
+      }
   };
 };
 
@@ -115,6 +137,7 @@ vtkOpenGLGlyph3DMapper::vtkOpenGLGlyph3DMapper()
   this->GlyphValues = new vtkOpenGLGlyph3DMapper::vtkOpenGLGlyph3DMapperArray();
   this->LastWindow = 0;
   this->ColorMapper = vtkOpenGLGlyph3DMappervtkColorMapper::New();
+  this->CullingAndLOD = false;
 }
 
 // ---------------------------------------------------------------------------
@@ -155,6 +178,42 @@ void vtkOpenGLGlyph3DMapper::CopyInformationToSubMapper(
   mapper->SetImmediateModeRendering(this->ImmediateModeRendering);
 }
 
+// ---------------------------------------------------------------------------
+void vtkOpenGLGlyph3DMapper::SetNumberOfLOD(int number)
+{
+  number = number < 0 ? 0 : number;
+  if (static_cast<size_t>(number) == this->LODSources.size())
+    {
+    return;
+    }
+  this->LODDistances.resize(number, 0.0);
+  this->LODSources.resize(number);
+  this->LODTime.Modified();
+}
+
+// ---------------------------------------------------------------------------
+int vtkOpenGLGlyph3DMapper::GetNumberOfLOD()
+{
+  return static_cast<int>(this->LODSources.size());
+}
+
+// ---------------------------------------------------------------------------
+// The levels only change the helpers, so the glyph structures are not
+// rebuilt: LODTime is stamped instead of the mapper.
+void vtkOpenGLGlyph3DMapper::SetLODDistanceAndSource(int index,
+  double distance, vtkPolyData *source)
+{
+  if (index < 0 || index >= this->GetNumberOfLOD())
+    {
+    vtkErrorMacro("No level of detail " << index << ", there are "
+      << this->GetNumberOfLOD() << " levels.");
+    return;
+    }
+  this->LODDistances[index] = distance;
+  this->LODSources[index] = source;
+  this->LODTime.Modified();
+}
+
 void vtkOpenGLGlyph3DMapper::SetupColorMapper()
 {
   this->ColorMapper->ShallowCopy(this);
@@ -306,6 +365,36 @@ void vtkOpenGLGlyph3DMapper::Render(
       }
     }
 
+  // and so are the sources of the levels of detail
+  std::vector<double> lodDistances;
+  if (this->CullingAndLOD && subarray->Entries.size() == 1)
+    {
+    vtkOpenGLGlyph3DMapper::vtkOpenGLGlyph3DMapperEntry *entry =
+      subarray->Entries[0];
+    bool lodChanged = this->LODTime > entry->LODBuildTime ||
+      numberOfSourcesChanged;
+    entry->SetNumberOfLODMappers(this->LODSources.size());
+    for (size_t cc = 0; cc < this->LODSources.size(); cc++)
+      {
+      vtkPolyData *s = this->LODSources[cc];
+      vtkPolyData *ss = entry->LODMappers[cc]->GetInput();
+      if (lodChanged || (s && s->GetMTime() > ss->GetMTime()))
+        {
+        if (s)
+          {
+          ss->ShallowCopy(s);
+          }
+        else
+          {
+          ss->Initialize();
+          }
+        this->CopyInformationToSubMapper(entry->LODMappers[cc]);
+        }
+      }
+    entry->LODBuildTime.Modified();
+    lodDistances = this->LODDistances;
+    }
+
   vtkHardwareSelector* selector = ren->GetSelector();
   bool selecting_points = selector && (selector->GetFieldAssociation() ==
     vtkDataObject::FIELD_ASSOCIATION_POINTS);
@@ -371,9 +460,15 @@ void vtkOpenGLGlyph3DMapper::Render(
     gh->SetUseFastPath(fastPath);
     if (fastPath)
       {
+      std::vector<vtkOpenGLGlyph3DHelper *> lodMappers;
+      if (!lodDistances.empty())
+        {
+        lodMappers = entry->LODMappers;
+        }
+      gh->SetCullingAndLOD(this->CullingAndLOD, lodMappers, lodDistances);
       gh->GlyphRender(ren, actor, entry->NumberOfPoints,
         entry->Colors, entry->Matrices, entry->NormalMatrices,
-        entry->PickIds, subarray->BuildTime);
+        entry->PickIds, entry->MatricesBuildTime, entry->ColorsBuildTime);
       }
     else
       {
@@ -491,11 +586,18 @@ void vtkOpenGLGlyph3DMapper::RebuildStructures(
     numPointsPerSource[0] = numPts;
     }
 
+  // keep the previous values, an entry whose matrices or colors did not
+  // change does not upload them again
+  std::vector<std::vector<unsigned char> > oldColors(numEntries);
+  std::vector<std::vector<float> > oldMatrices(numEntries);
+
   // for each entry start with a reasonable allocation
   for (size_t cc = 0; cc < subarray->Entries.size(); cc++)
     {
     vtkOpenGLGlyph3DMapper::vtkOpenGLGlyph3DMapperEntry *entry =
       subarray->Entries[cc];
+    oldColors[cc].swap(entry->Colors);
+    oldMatrices[cc].swap(entry->Matrices);
     entry->PickIds.resize(numPointsPerSource[cc]);
     entry->Colors.resize(numPointsPerSource[cc]*4);
     entry->Matrices.resize(numPointsPerSource[cc]*16);
@@ -707,6 +809,21 @@ void vtkOpenGLGlyph3DMapper::RebuildStructures(
       }
     }
 
+  for (size_t cc = 0; cc < subarray->Entries.size(); cc++)
+    {
+    vtkOpenGLGlyph3DMapper::vtkOpenGLGlyph3DMapperEntry *entry =
+      subarray->Entries[cc];
+    // the normal matrices follow the matrices
+    if (entry->Matrices != oldMatrices[cc])
+      {
+      entry->MatricesBuildTime.Modified();
+      }
+    if (entry->Colors != oldColors[cc])
+      {
+      entry->ColorsBuildTime.Modified();
+      }
+    }
+
   subarray->LastSelectingState = selecting_points;
   subarray->BuildTime.Modified();
   trans->Delete();
@@ -728,6 +845,10 @@ void vtkOpenGLGlyph3DMapper::ReleaseGraphicsResources(vtkWindow *window)
       for (;miter2 != miter->second->Entries.end(); miter2++)
         {
         miter2->second->Mapper->ReleaseGraphicsResources(window);
+        for (size_t i = 0; i < miter2->second->LODMappers.size(); ++i)
+          {
+          miter2->second->LODMappers[i]->ReleaseGraphicsResources(window);
+          }
         }
       }
     }
@@ -737,4 +858,7 @@ void vtkOpenGLGlyph3DMapper::ReleaseGraphicsResources(vtkWindow *window)
 void vtkOpenGLGlyph3DMapper::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CullingAndLOD: "
+     << (this->CullingAndLOD ? "On" : "Off") << endl;
+  os << indent << "NumberOfLOD: " << this->GetNumberOfLOD() << endl;
 }
@@ -19,7 +19,11 @@
 // don't make sense in vtkOpenGLGlyph3DMapper: GeneratePointIds, old-style
 // SetSource, PointIdsName, IsPointVisible.
 // .SECTION Implementation
-//
+// The glyphs made only of polygons are drawn with instancing when the
+// context supports it. With CullingAndLOD on and an OpenGL 3.2 context, the
+// glyphs out of the view frustum are removed on the GPU before the draw,
+// and the glyphs far from the camera are drawn with the simpler sources
+// given by SetLODDistanceAndSource.
 // .SECTION See Also
 // vtkOpenGLGlyph3D
 
@@ -29,6 +33,8 @@
 #include "vtkRenderingOpenGL2Module.h" // For export macro
 #include "vtkGlyph3DMapper.h"
 #include "vtkNew.h" // For vtkNew
+#include "vtkSmartPointer.h" // For ivars
+#include <vector> // For ivars
 
 class vtkOpenGLGlyph3DHelper;
 class vtkBitArray;
@@ -53,6 +59,29 @@ public:
   // resources to release.
   virtual void ReleaseGraphicsResources(vtkWindow *window);
 
+  // Description:
+  // Remove the glyphs out of the view frustum on the GPU, and draw the
+  // glyphs far from the camera with the sources of the levels of detail.
+  // It only applies to the glyphs drawn with instancing, with an OpenGL 3.2
+  // context, and the levels of detail only when there is one source.
+  // Initial value is false.
+  vtkSetMacro(CullingAndLOD, bool);
+  vtkGetMacro(CullingAndLOD, bool);
+  vtkBooleanMacro(CullingAndLOD, bool);
+
+  // Description:
+  // Number of levels of detail besides the source. Initial value is 0.
+  void SetNumberOfLOD(int number);
+  int GetNumberOfLOD();
+
+  // Description:
+  // Draw the glyphs farther than \p distance from the camera with
+  // \p source, up to the distance of the next level. The distances must
+  // increase with \p index. A NULL source removes those glyphs, as a
+  // last level that skips the glyphs too far to be seen.
+  void SetLODDistanceAndSource(int index, double distance,
+    vtkPolyData *source);
+
 protected:
   vtkOpenGLGlyph3DMapper();
   ~vtkOpenGLGlyph3DMapper();
@@ -83,6 +112,11 @@ protected:
 
   vtkWeakPointer<vtkWindow> LastWindow; // Window used for previous render.
 
+  bool CullingAndLOD;
+  std::vector<double> LODDistances;
+  std::vector<vtkSmartPointer<vtkPolyData> > LODSources;
+  vtkTimeStamp LODTime;
+
 private:
   vtkOpenGLGlyph3DMapper(const vtkOpenGLGlyph3DMapper&); // Not implemented.
   void operator=(const vtkOpenGLGlyph3DMapper&); // Not implemented.
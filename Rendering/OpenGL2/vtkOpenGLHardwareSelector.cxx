@@ -16,13 +16,19 @@
 
 #include "vtk_glew.h"
 
+#include "vtkActor.h"
+#include "vtkFrameBufferObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkOpenGLPolyDataMapper.h"
+#include "vtkPropCollection.h"
 #include "vtkRenderer.h"
 #include "vtkRenderWindow.h"
 #include "vtkOpenGLRenderWindow.h"
 
 #include "vtkOpenGLError.h"
 
+#include <vector>
+
 //#define vtkOpenGLHardwareSelectorDEBUG
 #ifdef vtkOpenGLHardwareSelectorDEBUG
 #include "vtkPNMWriter.h"
@@ -43,12 +49,14 @@ public:
   bool MultisampleSupport;
   bool OriginalMultisample;
   bool OriginalBlending;
+  bool SinglePassCaptured;
 
   vtkInternals() :
     Context(NULL),
     MultisampleSupport(false),
     OriginalMultisample(false),
-    OriginalBlending(false)
+    OriginalBlending(false),
+    SinglePassCaptured(false)
     {}
 
   // Description:
@@ -138,6 +146,12 @@ vtkOpenGLHardwareSelector::vtkOpenGLHardwareSelector()
   cerr << "=====vtkOpenGLHardwareSelector::vtkOpenGLHardwareSelector" << endl;
   #endif
   this->Internals = new vtkInternals;
+  this->CompositeColorValue[0] = 0.0;
+  this->CompositeColorValue[1] = 0.0;
+  this->CompositeColorValue[2] = 0.0;
+  this->ProcessColorValue[0] = 0.0;
+  this->ProcessColorValue[1] = 0.0;
+  this->ProcessColorValue[2] = 0.0;
 }
 
 //----------------------------------------------------------------------------
@@ -253,6 +267,23 @@ void vtkOpenGLHardwareSelector::BeginRenderProp()
     vtkHardwareSelector::Convert(this->ProcessID + 1, color);
     this->SetPropColorValue(color);
     }
+  else if (this->CurrentPass == SINGLE_PASS)
+    {
+    int propid = this->PropID;
+    if (propid >= 0xfffffe)
+      {
+      vtkErrorMacro("Too many props. Currently only " << 0xfffffe
+        << " props are supported.");
+      return;
+      }
+    float color[3];
+    vtkHardwareSelector::Convert(propid + 1, color);
+    this->SetPropColorValue(color);
+    vtkHardwareSelector::Convert(this->ProcessID + 1, this->ProcessColorValue);
+    // the composite index of the mappers that do not render one, as in
+    // RenderCompositeIndex(1)
+    vtkHardwareSelector::Convert(1 + ID_OFFSET, this->CompositeColorValue);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -273,6 +304,11 @@ void vtkOpenGLHardwareSelector::RenderCompositeIndex(unsigned int index)
     vtkHardwareSelector::Convert(static_cast<int>(0xffffff & index), color);
     this->SetPropColorValue(color);
     }
+  else if (this->CurrentPass == SINGLE_PASS)
+    {
+    vtkHardwareSelector::Convert(static_cast<int>(0xffffff & index),
+      this->CompositeColorValue);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -329,6 +365,166 @@ void vtkOpenGLHardwareSelector::RenderProcessId(unsigned int processid)
 }
 
 
+//----------------------------------------------------------------------------
+bool vtkOpenGLHardwareSelector::CaptureSinglePass()
+{
+#if GL_ES_VERSION_2_0 != 1 || GL_ES_VERSION_3_0 == 1
+  if (this->UseProcessIdFromData ||
+      !vtkOpenGLRenderWindow::GetContextSupportsOpenGL32() ||
+      !vtkOpenGLRenderWindow::SafeDownCast(this->Renderer->GetRenderWindow()) ||
+      !this->PropsSupportSinglePass())
+    {
+    return false;
+    }
+
+  // Render() only gets the props when the renderer has some, else the
+  // passes are rendered as usual
+  this->Internals->SinglePassCaptured = false;
+  this->CurrentPass = SINGLE_PASS;
+  this->Renderer->GetRenderWindow()->Render();
+  return this->Internals->SinglePassCaptured;
+#else
+  return false;
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool vtkOpenGLHardwareSelector::PropsSupportSinglePass()
+{
+  vtkPropCollection *props = this->Renderer->GetViewProps();
+  vtkCollectionSimpleIterator pit;
+  vtkProp *prop;
+  for (props->InitTraversal(pit); (prop = props->GetNextProp(pit)); )
+    {
+    if (!prop->GetVisibility() || !prop->GetPickable() ||
+        !prop->GetSupportsSelection())
+      {
+      continue;
+      }
+    vtkActor *actor = vtkActor::SafeDownCast(prop);
+    vtkOpenGLPolyDataMapper *mapper = actor ?
+      vtkOpenGLPolyDataMapper::SafeDownCast(actor->GetMapper()) : NULL;
+    if (!mapper || !mapper->GetSupportsSinglePassSelection())
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkOpenGLHardwareSelector::Render(vtkRenderer* renderer,
+  vtkProp** propArray, int propArrayCount)
+{
+  if (this->CurrentPass != SINGLE_PASS)
+    {
+    return this->Superclass::Render(renderer, propArray, propArrayCount);
+    }
+
+#if GL_ES_VERSION_2_0 != 1 || GL_ES_VERSION_3_0 == 1
+  vtkOpenGLRenderWindow *renWin =
+    static_cast<vtkOpenGLRenderWindow *>(renderer->GetRenderWindow());
+  int *size = renWin->GetSize();
+
+  // the frame buffer has the size of the window so that the viewport and
+  // scissor box of the renderer apply as they are
+  vtkFrameBufferObject *fbo = vtkFrameBufferObject::New();
+  fbo->SetContext(renWin);
+  fbo->SetNumberOfRenderTargets(4);
+  unsigned int buffers[4] = { 0, 1, 2, 3 };
+  fbo->SetActiveBuffers(4, buffers);
+  fbo->SetDepthBufferNeeded(true);
+  if (!fbo->StartNonOrtho(size[0], size[1], false))
+    {
+    fbo->UnBind();
+    fbo->Delete();
+    return 0;
+    }
+
+  // 0 is the id of the pixels that no prop covers
+  GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+  glDisable(GL_SCISSOR_TEST);
+  glClearColor(0.0, 0.0, 0.0, 0.0);
+#if GL_ES_VERSION_2_0 == 1
+  glClearDepthf(static_cast<GLclampf>(1.0));
+#else
+  glClearDepth(static_cast<GLclampf>(1.0));
+#endif
+  glDepthMask(GL_TRUE);
+  glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  if (scissor)
+    {
+    glEnable(GL_SCISSOR_TEST);
+    }
+
+  int rendered = this->Superclass::Render(renderer, propArray, propArrayCount);
+  this->ReadSinglePassBuffers();
+
+  fbo->UnBind();
+  fbo->Delete();
+  this->Internals->SinglePassCaptured = true;
+  return rendered;
+#else
+  return this->Superclass::Render(renderer, propArray, propArrayCount);
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkOpenGLHardwareSelector::ReadSinglePassBuffers()
+{
+#if GL_ES_VERSION_2_0 != 1 || GL_ES_VERSION_3_0 == 1
+  GLsizei width = static_cast<GLsizei>(this->Area[2] - this->Area[0] + 1);
+  GLsizei height = static_cast<GLsizei>(this->Area[3] - this->Area[1] + 1);
+  size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+  std::vector<unsigned char> rgba(4 * count);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+  // color buffer i holds the ids of the pass passes[i]
+  const int passes[4] =
+    { ACTOR_PASS, COMPOSITE_INDEX_PASS, ID_LOW24, PROCESS_PASS };
+  for (int i = 0; i < 4; ++i)
+    {
+    int pass = passes[i];
+    if (pass == PROCESS_PASS && !this->PassRequired(PROCESS_PASS))
+      {
+      continue;
+      }
+    glReadBuffer(GL_COLOR_ATTACHMENT0 + i);
+    glReadPixels(static_cast<GLint>(this->Area[0]),
+      static_cast<GLint>(this->Area[1]), width, height,
+      GL_RGBA, GL_UNSIGNED_BYTE, &rgba[0]);
+
+    // the pixel buffers are RGB, as read from the window
+    unsigned char *rgb = new unsigned char[3 * count];
+    for (size_t j = 0; j < count; ++j)
+      {
+      rgb[3*j] = rgba[4*j];
+      rgb[3*j + 1] = rgba[4*j + 1];
+      rgb[3*j + 2] = rgba[4*j + 2];
+      }
+    delete [] this->PixBuffer[pass];
+    this->PixBuffer[pass] = rgb;
+
+    if (pass == ID_LOW24)
+      {
+      // the alpha of the attribute ids holds the low byte of ID_MID24
+      unsigned char *mid = new unsigned char[3 * count];
+      for (size_t j = 0; j < count; ++j)
+        {
+        mid[3*j] = rgba[4*j + 3];
+        mid[3*j + 1] = 0;
+        mid[3*j + 2] = 0;
+        }
+      delete [] this->PixBuffer[ID_MID24];
+      this->PixBuffer[ID_MID24] = mid;
+      }
+    }
+  vtkOpenGLCheckErrorMacro("failed after reading the selection buffers");
+
+  this->BuildPropHitList(this->PixBuffer[ACTOR_PASS]);
+#endif
+}
 
 //----------------------------------------------------------------------------
 void vtkOpenGLHardwareSelector::PrintSelf(ostream& os, vtkIndent indent)
@@ -18,6 +18,13 @@
 // .SECTION Description
 // Implements the device specific code of vtkOpenGLHardwareSelector.
 //
+// The SINGLE_PASS renders into a frame buffer object with four RGBA color
+// buffers: the prop id, the composite index, the attribute id, whose alpha
+// holds bits 24 to 31, and the process id. It needs an OpenGL 3.2 context
+// and is used when every selectable prop is an actor whose mapper is a
+// vtkOpenGLPolyDataMapper that supports it, and the process ids do not come
+// from the data.
+//
 // .SECTION See Also
 // vtkHardwareSelector
 
@@ -55,6 +62,17 @@ public:
   // effect when this->UseProcessIdFromData is true.
   virtual void RenderProcessId(unsigned int processid);
 
+  // Description:
+  // Colors of the composite index and of the process id, used by the
+  // mappers in the SINGLE_PASS where PropColorValue is the prop id.
+  vtkGetVector3Macro(CompositeColorValue,float);
+  vtkGetVector3Macro(ProcessColorValue,float);
+
+  // Description:
+  // Overridden to render the SINGLE_PASS in the frame buffer object.
+  virtual int Render(vtkRenderer* renderer, vtkProp** propArray,
+    int propArrayCount);
+
 protected:
   vtkOpenGLHardwareSelector();
   virtual ~vtkOpenGLHardwareSelector();
@@ -66,6 +84,23 @@ protected:
 
   virtual void SavePixelBuffer(int passNo);
 
+  // Description:
+  // Render the SINGLE_PASS if the context and the props support it.
+  virtual bool CaptureSinglePass();
+
+  // Description:
+  // Whether the mappers of all the selectable props can write the ids of
+  // the SINGLE_PASS.
+  bool PropsSupportSinglePass();
+
+  // Description:
+  // Copy the color buffers of the SINGLE_PASS in the pixel buffers of the
+  // passes they replace.
+  void ReadSinglePassBuffers();
+
+  float CompositeColorValue[3];
+  float ProcessColorValue[3];
+
   // for internal state
   class vtkInternals;
   vtkInternals* Internals;
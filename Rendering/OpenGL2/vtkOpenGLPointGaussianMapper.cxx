@@ -32,12 +32,15 @@
 #include "vtkProperty.h"
 #include "vtkRenderer.h"
 #include "vtkShaderProgram.h"
+#include "vtkSMPTools.h"
 
 #include "vtkPointGaussianVS.h"
 #include "vtkPolyDataFS.h"
 
 #include "vtk_glew.h"
 
+#include <algorithm>
+#include <queue>
 
 
 class vtkOpenGLPointGaussianMapperHelper : public vtkOpenGLPolyDataMapper
@@ -46,7 +49,7 @@ public:
   static vtkOpenGLPointGaussianMapperHelper* New();
   vtkTypeMacro(vtkOpenGLPointGaussianMapperHelper, vtkOpenGLPolyDataMapper)
 
-  vtkPointGaussianMapper *Owner;
+  vtkOpenGLPointGaussianMapper *Owner;
 
   bool UsingPoints;
   float *OpacityTable; // the table
@@ -58,6 +61,19 @@ public:
   double ScaleOffset; // used for quick lookups
   double TriangleScale;
 
+  // A node of the level of detail octree. Its points, an evenly spread
+  // sample of the points of its octant, are LODPoints[Offset, Offset+Count)
+  // and the points of its subtree follow them.
+  struct LODNode
+    {
+    double Bounds[6];
+    vtkIdType Offset;
+    vtkIdType Count;
+    int Children[8];
+    int Slot; // slot of the node in the VBO, -1 when not uploaded
+    unsigned long LastRender; // last render that selected the node
+    };
+
 protected:
   vtkOpenGLPointGaussianMapperHelper();
   ~vtkOpenGLPointGaussianMapperHelper();
@@ -101,6 +117,31 @@ protected:
   // create the table for scale values
   void BuildScaleTable();
 
+  // Description:
+  // Build the octree of the level of detail if the input or the node size
+  // changed, and make room in the VBO for PointBudget points.
+  void BuildLODBufferObjects(vtkPolyData *poly);
+  int BuildLODNode(vtkTypeUInt64 *codes, vtkIdType begin, vtkIdType end,
+    int level, const double bounds[6]);
+
+  // Description:
+  // Select the nodes to draw in this render, upload the missing ones within
+  // the upload budget, and fill LODDrawNodes.
+  void UpdateLODNodes(vtkRenderer *ren, vtkActor *act);
+  int GetFreeLODSlot();
+  void UploadLODNode(int index, int slot);
+
+  std::vector<LODNode> LODNodes;
+  std::vector<vtkIdType> LODPoints; // input point ids, grouped by node
+  vtkTimeStamp LODBuildTime;
+  int LODNodeSize;
+  int LODBlockSize; // floats per vertex
+  std::vector<int> LODSlots; // node in each slot of the VBO, or -1
+  std::vector<int> LODDrawNodes;
+  unsigned long LODRenderCount;
+  vtkDataArray *LODScales;
+  vtkDataArray *LODOpacities;
+
   // Description:
   // Does the shader source need to be recomputed
   virtual bool GetNeedToRebuildShaders(vtkOpenGLHelper &cellBO,
@@ -126,6 +167,11 @@ vtkOpenGLPointGaussianMapperHelper::vtkOpenGLPointGaussianMapperHelper()
   this->OpacityOffset = 0.0;
   this->ScaleOffset = 0.0;
   this->TriangleScale = 0.0;
+  this->LODNodeSize = 0;
+  this->LODBlockSize = 0;
+  this->LODRenderCount = 0;
+  this->LODScales = NULL;
+  this->LODOpacities = NULL;
 }
 
 
@@ -503,6 +549,131 @@ void vtkOpenGLPointGaussianMapperHelperPackVBOTemplate(
     }
 }
 
+// pack the points of a level of detail node, given by their ids
+template< typename PointDataType, typename SizeDataType >
+void vtkOpenGLPointGaussianMapperHelperPackIdsTemplate2(
+              float *&it,
+              PointDataType* points,
+              const vtkIdType *ids, vtkIdType numIds,
+              vtkOpenGLPointGaussianMapperHelper *self,
+              unsigned char *colors, int colorComponents,
+              SizeDataType* sizes, vtkDataArray *opacities)
+{
+  float defaultSize = self->Owner->GetScaleFactor();
+  for (vtkIdType i = 0; i < numIds; ++i)
+    {
+    vtkOpenGLPointGaussianMapperHelperPackVBOTemplate3(
+      it, points, sizes, ids[i], self,
+      colors, colorComponents, opacities, defaultSize);
+    }
+}
+
+template< typename PointDataType >
+void vtkOpenGLPointGaussianMapperHelperPackIdsTemplate(
+    float *&it,
+    PointDataType* points,
+    const vtkIdType *ids, vtkIdType numIds,
+    vtkOpenGLPointGaussianMapperHelper *self,
+    unsigned char *colors, int colorComponents,
+    vtkDataArray* sizes, vtkDataArray *opacities)
+{
+  if (sizes)
+    {
+    switch (sizes->GetDataType())
+      {
+      vtkTemplateMacro(
+          vtkOpenGLPointGaussianMapperHelperPackIdsTemplate2(
+            it, points, ids, numIds, self,
+            colors, colorComponents,
+            static_cast<VTK_TT*>(sizes->GetVoidPointer(0)), opacities)
+          );
+      }
+    }
+  else
+    {
+    vtkOpenGLPointGaussianMapperHelperPackIdsTemplate2(
+          it, points, ids, numIds, self,
+          colors, colorComponents,
+          static_cast<float*>(NULL), opacities);
+    }
+}
+
+// the octree has at most this many levels below the root, so that the
+// three bits of every level fit in a 64 bit Morton code
+const int vtkOpenGLPointGaussianMapperMaxLODLevel = 21;
+
+// compute the Morton codes of the points, quantized in a cube
+template< typename PointDataType >
+struct vtkOpenGLPointGaussianMapperMortonFunctor
+{
+  const PointDataType *Points;
+  const vtkIdType *Ids;
+  vtkTypeUInt64 *Codes;
+  double Origin[3];
+  double Scale;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const vtkTypeUInt64 maxCell =
+      (static_cast<vtkTypeUInt64>(1) << vtkOpenGLPointGaussianMapperMaxLODLevel) - 1;
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const PointDataType *p = this->Points + 3*this->Ids[i];
+      vtkTypeUInt64 cell[3];
+      for (int j = 0; j < 3; ++j)
+        {
+        double x = (p[j] - this->Origin[j])*this->Scale;
+        cell[j] = x <= 0.0 ? 0 : std::min(static_cast<vtkTypeUInt64>(x), maxCell);
+        }
+      // interleave the bits as x y z from the coarsest level down
+      vtkTypeUInt64 code = 0;
+      for (int b = vtkOpenGLPointGaussianMapperMaxLODLevel - 1; b >= 0; --b)
+        {
+        code = (code << 3) |
+          (((cell[0] >> b) & 1) << 2) |
+          (((cell[1] >> b) & 1) << 1) |
+          ((cell[2] >> b) & 1);
+        }
+      this->Codes[i] = code;
+      }
+  }
+};
+
+template< typename PointDataType >
+void vtkOpenGLPointGaussianMapperComputeCodes(
+  const PointDataType *points, const vtkIdType *ids, vtkIdType numIds,
+  const double origin[3], double scale, vtkTypeUInt64 *codes)
+{
+  vtkOpenGLPointGaussianMapperMortonFunctor<PointDataType> functor;
+  functor.Points = points;
+  functor.Ids = ids;
+  functor.Codes = codes;
+  functor.Origin[0] = origin[0];
+  functor.Origin[1] = origin[1];
+  functor.Origin[2] = origin[2];
+  functor.Scale = scale;
+  vtkSMPTools::For(0, numIds, functor);
+}
+
+// is the box fully on the negative side of one of the planes
+bool vtkOpenGLPointGaussianMapperIsBoxCulled(
+  const double planes[24], const double bounds[6])
+{
+  for (int i = 0; i < 6; ++i)
+    {
+    const double *plane = planes + 4*i;
+    // the corner of the box furthest along the normal of the plane
+    double x = plane[0] > 0.0 ? bounds[1] : bounds[0];
+    double y = plane[1] > 0.0 ? bounds[3] : bounds[2];
+    double z = plane[2] > 0.0 ? bounds[5] : bounds[4];
+    if (plane[0]*x + plane[1]*y + plane[2]*z + plane[3] < 0.0)
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
 } // anonymous namespace
 
 //-------------------------------------------------------------------------
@@ -665,8 +836,24 @@ void vtkOpenGLPointGaussianMapperHelper::BuildBufferObjects(
     splatCount *= 3;
     }
 
-  this->VBO->PackedVBO.resize(blockSize * splatCount);
   this->VBO->Stride = sizeof(float) * blockSize;
+  if (this->Owner->GetPointBudget() > 0)
+    {
+    // the nodes are packed as they are uploaded, by UpdateLODNodes
+    this->LODBlockSize = blockSize;
+    this->LODScales = hasScaleArray ?
+      poly->GetPointData()->GetArray(this->Owner->GetScaleArray()) : NULL;
+    this->LODOpacities = hasOpacityArray ?
+      poly->GetPointData()->GetArray(this->Owner->GetOpacityArray()) : NULL;
+    this->BuildLODBufferObjects(poly);
+    return;
+    }
+  std::vector<LODNode>().swap(this->LODNodes);
+  std::vector<vtkIdType>().swap(this->LODPoints);
+  this->LODSlots.clear();
+  this->LODDrawNodes.clear();
+
+  this->VBO->PackedVBO.resize(blockSize * splatCount);
 
   // Create a buffer, and copy the data over.
   float *it = &(this->VBO->PackedVBO.begin()[0]);
@@ -701,6 +888,347 @@ void vtkOpenGLPointGaussianMapperHelper::BuildBufferObjects(
   this->VBOBuildTime.Modified();
 }
 
+//-------------------------------------------------------------------------
+void vtkOpenGLPointGaussianMapperHelper::BuildLODBufferObjects(
+  vtkPolyData *poly)
+{
+  vtkPoints *points = poly->GetPoints();
+  int nodeSize = this->Owner->GetNodeSize();
+
+  if (this->LODBuildTime < poly->GetMTime() ||
+      this->LODNodeSize != nodeSize)
+    {
+    // the points to draw, as the verts or the whole input
+    this->LODPoints.clear();
+    vtkCellArray *verts = poly->GetVerts();
+    if (verts->GetNumberOfCells())
+      {
+      this->LODPoints.reserve(verts->GetNumberOfConnectivityEntries() -
+        verts->GetNumberOfCells());
+      vtkIdType* indices(NULL);
+      vtkIdType npts(0);
+      for (verts->InitTraversal(); verts->GetNextCell(npts, indices); )
+        {
+        this->LODPoints.insert(this->LODPoints.end(), indices, indices + npts);
+        }
+      }
+    else
+      {
+      this->LODPoints.resize(points->GetNumberOfPoints());
+      for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+        {
+        this->LODPoints[i] = i;
+        }
+      }
+
+    // sort the points along a Morton curve in the bounding cube, so that
+    // the points of every octant are contiguous
+    vtkIdType numIds = static_cast<vtkIdType>(this->LODPoints.size());
+    this->LODNodes.clear();
+    this->LODNodeSize = nodeSize;
+    if (numIds > 0)
+      {
+      double bounds[6];
+      points->GetBounds(bounds);
+      double size = std::max(bounds[1] - bounds[0],
+        std::max(bounds[3] - bounds[2], bounds[5] - bounds[4]));
+      if (size <= 0.0)
+        {
+        size = 1.0;
+        }
+      double origin[3] = { bounds[0], bounds[2], bounds[4] };
+      double cube[6] = { bounds[0], bounds[0] + size, bounds[2],
+        bounds[2] + size, bounds[4], bounds[4] + size };
+      double scale = (1 << vtkOpenGLPointGaussianMapperMaxLODLevel)/size;
+
+      std::vector<vtkTypeUInt64> codes(numIds);
+      switch (points->GetDataType())
+        {
+        vtkTemplateMacro(
+          vtkOpenGLPointGaussianMapperComputeCodes(
+            static_cast<VTK_TT*>(points->GetVoidPointer(0)),
+            &this->LODPoints[0], numIds, origin, scale, &codes[0]));
+        }
+      vtkSMPTools::RadixSort(&codes[0], &codes[0] + numIds,
+        &this->LODPoints[0]);
+      this->BuildLODNode(&codes[0], 0, numIds, 0, cube);
+      }
+    this->LODBuildTime.Modified();
+    }
+
+  // every slot of the VBO holds a full node, and there is no need for
+  // more slots than nodes
+  vtkIdType numSlots = (this->Owner->GetPointBudget() + nodeSize - 1)/nodeSize;
+  numSlots = std::min(numSlots,
+    static_cast<vtkIdType>(this->LODNodes.size()));
+  this->LODSlots.assign(numSlots, -1);
+  for (size_t i = 0; i < this->LODNodes.size(); ++i)
+    {
+    this->LODNodes[i].Slot = -1;
+    }
+  this->LODDrawNodes.clear();
+
+  vtkIdType slotVertices =
+    static_cast<vtkIdType>(nodeSize)*(this->UsingPoints ? 1 : 3);
+  this->VBO->GenerateBuffer(vtkOpenGLBufferObject::ArrayBuffer);
+  this->VBO->Bind();
+  glBufferData(GL_ARRAY_BUFFER,
+    numSlots*slotVertices*this->VBO->Stride, NULL, GL_DYNAMIC_DRAW);
+  this->VBO->VertexCount = numSlots*slotVertices;
+
+  this->Points.IBO->IndexCount = 0;
+  this->Lines.IBO->IndexCount = 0;
+  this->TriStrips.IBO->IndexCount = 0;
+  this->Tris.IBO->IndexCount = this->VBO->VertexCount;
+  this->VBOBuildTime.Modified();
+}
+
+//-------------------------------------------------------------------------
+int vtkOpenGLPointGaussianMapperHelper::BuildLODNode(
+  vtkTypeUInt64 *codes, vtkIdType begin, vtkIdType end,
+  int level, const double bounds[6])
+{
+  int index = static_cast<int>(this->LODNodes.size());
+  this->LODNodes.push_back(LODNode());
+  LODNode &node = this->LODNodes.back();
+  std::copy(bounds, bounds + 6, node.Bounds);
+  std::fill(node.Children, node.Children + 8, -1);
+  node.Offset = begin;
+  node.Slot = -1;
+  node.LastRender = 0;
+
+  vtkIdType count = end - begin;
+  int nodeSize = this->LODNodeSize;
+  if (count <= nodeSize || level == vtkOpenGLPointGaussianMapperMaxLODLevel)
+    {
+    // at the last level the points are too close to tell apart, keep
+    // only what fits in a node
+    node.Count = std::min(count, static_cast<vtkIdType>(nodeSize));
+    return index;
+    }
+  node.Count = nodeSize;
+
+  // move an evenly spread sample to the front of the range, keeping the
+  // order of the other points for the children
+  vtkIdType *ids = &this->LODPoints[0];
+  std::vector<vtkIdType> sampleIds(nodeSize);
+  std::vector<vtkTypeUInt64> sampleCodes(nodeSize);
+  int sample = nodeSize - 1;
+  vtkIdType samplePos = begin + static_cast<vtkIdType>(
+    static_cast<double>(sample)*count/nodeSize);
+  vtkIdType dest = end;
+  for (vtkIdType i = end - 1; i >= begin; --i)
+    {
+    if (i == samplePos)
+      {
+      sampleIds[sample] = ids[i];
+      sampleCodes[sample] = codes[i];
+      --sample;
+      samplePos = sample < 0 ? begin - 1 : begin + static_cast<vtkIdType>(
+        static_cast<double>(sample)*count/nodeSize);
+      }
+    else
+      {
+      --dest;
+      ids[dest] = ids[i];
+      codes[dest] = codes[i];
+      }
+    }
+  std::copy(sampleIds.begin(), sampleIds.end(), ids + begin);
+  std::copy(sampleCodes.begin(), sampleCodes.end(), codes + begin);
+
+  // the remaining points are still sorted, split them by octant
+  int shift = 3*(vtkOpenGLPointGaussianMapperMaxLODLevel - 1 - level);
+  double center[3] = { 0.5*(bounds[0] + bounds[1]),
+    0.5*(bounds[2] + bounds[3]), 0.5*(bounds[4] + bounds[5]) };
+  vtkIdType childBegin = begin + nodeSize;
+  while (childBegin < end)
+    {
+    int octant = static_cast<int>((codes[childBegin] >> shift) & 7);
+    vtkIdType childEnd = childBegin + 1;
+    while (childEnd < end &&
+           static_cast<int>((codes[childEnd] >> shift) & 7) == octant)
+      {
+      ++childEnd;
+      }
+    double childBounds[6];
+    for (int j = 0; j < 3; ++j)
+      {
+      bool upper = ((octant >> (2 - j)) & 1) != 0;
+      childBounds[2*j] = upper ? center[j] : bounds[2*j];
+      childBounds[2*j+1] = upper ? bounds[2*j+1] : center[j];
+      }
+    int child = this->BuildLODNode(codes, childBegin, childEnd,
+      level + 1, childBounds);
+    this->LODNodes[index].Children[octant] = child;
+    childBegin = childEnd;
+    }
+  return index;
+}
+
+//-------------------------------------------------------------------------
+void vtkOpenGLPointGaussianMapperHelper::UpdateLODNodes(
+  vtkRenderer *ren, vtkActor *actor)
+{
+  unsigned long render = ++this->LODRenderCount;
+  this->LODDrawNodes.clear();
+  this->Owner->NumberOfRenderedPoints = 0;
+  this->Owner->NumberOfPendingNodes = 0;
+  if (this->LODNodes.empty() || this->LODSlots.empty())
+    {
+    return;
+    }
+
+  // the frustum planes and the view matrix in model coordinates
+  vtkCamera *cam = ren->GetActiveCamera();
+  double mcdc[16];
+  double mcvc[16];
+  vtkMatrix4x4::DeepCopy(mcdc, cam->GetCompositeProjectionTransformMatrix(
+    ren->GetTiledAspectRatio(), -1, 1));
+  vtkMatrix4x4::DeepCopy(mcvc, cam->GetViewTransformMatrix());
+  if (!actor->GetIsIdentity())
+    {
+    vtkMatrix4x4 *mcwc = actor->GetMatrix();
+    vtkMatrix4x4::Multiply4x4(mcdc, *mcwc->Element, mcdc);
+    vtkMatrix4x4::Multiply4x4(mcvc, *mcwc->Element, mcvc);
+    }
+  double planes[24];
+  for (int i = 0; i < 3; ++i)
+    {
+    for (int j = 0; j < 4; ++j)
+      {
+      planes[8*i+j] = mcdc[12+j] + mcdc[4*i+j];
+      planes[8*i+4+j] = mcdc[12+j] - mcdc[4*i+j];
+      }
+    }
+  bool parallel = cam->GetParallelProjection() != 0;
+
+  // refine the visible nodes that look largest first, within the budget
+  // of points and of slots
+  std::priority_queue<std::pair<double, int> > queue;
+  if (!vtkOpenGLPointGaussianMapperIsBoxCulled(planes, this->LODNodes[0].Bounds))
+    {
+    queue.push(std::make_pair(VTK_DOUBLE_MAX, 0));
+    }
+  std::vector<int> selected;
+  vtkIdType budget = this->Owner->GetPointBudget();
+  vtkIdType numPoints = 0;
+  while (!queue.empty() && selected.size() < this->LODSlots.size())
+    {
+    LODNode &node = this->LODNodes[queue.top().second];
+    if (numPoints + node.Count > budget)
+      {
+      break;
+      }
+    selected.push_back(queue.top().second);
+    queue.pop();
+    numPoints += node.Count;
+    node.LastRender = render;
+
+    for (int i = 0; i < 8; ++i)
+      {
+      if (node.Children[i] < 0)
+        {
+        continue;
+        }
+      const double *bounds = this->LODNodes[node.Children[i]].Bounds;
+      if (vtkOpenGLPointGaussianMapperIsBoxCulled(planes, bounds))
+        {
+        continue;
+        }
+      double radius = 0.5*sqrt(
+        (bounds[1] - bounds[0])*(bounds[1] - bounds[0]) +
+        (bounds[3] - bounds[2])*(bounds[3] - bounds[2]) +
+        (bounds[5] - bounds[4])*(bounds[5] - bounds[4]));
+      double priority = radius;
+      if (!parallel)
+        {
+        double depth = -(mcvc[8]*0.5*(bounds[0] + bounds[1]) +
+          mcvc[9]*0.5*(bounds[2] + bounds[3]) +
+          mcvc[10]*0.5*(bounds[4] + bounds[5]) + mcvc[11]);
+        priority = depth > radius ? radius/depth : VTK_DOUBLE_MAX;
+        }
+      queue.push(std::make_pair(priority, node.Children[i]));
+      }
+    }
+
+  // parents come before their children, so a node missing an upload
+  // leaves the coarser nodes around it drawn
+  int uploads = 0;
+  for (size_t i = 0; i < selected.size(); ++i)
+    {
+    LODNode &node = this->LODNodes[selected[i]];
+    if (node.Slot < 0)
+      {
+      if (uploads >= this->Owner->GetNodeUploadsPerRender())
+        {
+        ++this->Owner->NumberOfPendingNodes;
+        continue;
+        }
+      this->UploadLODNode(selected[i], this->GetFreeLODSlot());
+      ++uploads;
+      }
+    this->LODDrawNodes.push_back(selected[i]);
+    this->Owner->NumberOfRenderedPoints += node.Count;
+    }
+}
+
+//-------------------------------------------------------------------------
+int vtkOpenGLPointGaussianMapperHelper::GetFreeLODSlot()
+{
+  // an empty slot, or else the one of the node unused for the longest time
+  int best = -1;
+  unsigned long bestRender = this->LODRenderCount;
+  for (size_t i = 0; i < this->LODSlots.size(); ++i)
+    {
+    if (this->LODSlots[i] < 0)
+      {
+      return static_cast<int>(i);
+      }
+    unsigned long lastRender = this->LODNodes[this->LODSlots[i]].LastRender;
+    if (lastRender < bestRender)
+      {
+      best = static_cast<int>(i);
+      bestRender = lastRender;
+      }
+    }
+  return best;
+}
+
+//-------------------------------------------------------------------------
+void vtkOpenGLPointGaussianMapperHelper::UploadLODNode(int index, int slot)
+{
+  if (this->LODSlots[slot] >= 0)
+    {
+    this->LODNodes[this->LODSlots[slot]].Slot = -1;
+    }
+  this->LODSlots[slot] = index;
+  LODNode &node = this->LODNodes[index];
+  node.Slot = slot;
+
+  int vertsPerPoint = this->UsingPoints ? 1 : 3;
+  std::vector<float> packed(node.Count*vertsPerPoint*this->LODBlockSize);
+  float *it = &packed[0];
+  vtkPoints *points = this->CurrentInput->GetPoints();
+  switch (points->GetDataType())
+    {
+    vtkTemplateMacro(
+      vtkOpenGLPointGaussianMapperHelperPackIdsTemplate(
+        it, static_cast<VTK_TT*>(points->GetVoidPointer(0)),
+        &this->LODPoints[node.Offset], node.Count,
+        this,
+        this->Colors ? (unsigned char *)this->Colors->GetVoidPointer(0) : (unsigned char*)NULL,
+        this->Colors ? this->Colors->GetNumberOfComponents() : 0,
+        this->LODScales, this->LODOpacities));
+    }
+
+  vtkIdType slotBytes = static_cast<vtkIdType>(this->LODNodeSize)*
+    vertsPerPoint*this->VBO->Stride;
+  this->VBO->Bind();
+  glBufferSubData(GL_ARRAY_BUFFER, slot*slotBytes,
+    packed.size()*sizeof(float), &packed[0]);
+}
+
 //-----------------------------------------------------------------------------
 void vtkOpenGLPointGaussianMapperHelper::RenderPieceDraw(vtkRenderer* ren, vtkActor *actor)
 {
@@ -720,16 +1248,27 @@ void vtkOpenGLPointGaussianMapperHelper::RenderPieceDraw(vtkRenderer* ren, vtkAc
       glGetIntegerv(GL_BLEND_DST_RGB, &blendDstC);
       glBlendFunc( GL_SRC_ALPHA, GL_ONE);  // additive for emissive sources
       }
+    if (this->Owner->GetPointBudget() > 0)
+      {
+      this->UpdateLODNodes(ren, actor);
+      }
     // First we do the triangles or points, update the shader, set uniforms, etc.
     this->UpdateShaders(this->Tris, ren, actor);
-    if (this->UsingPoints)
+    GLenum mode = this->UsingPoints ? GL_POINTS : GL_TRIANGLES;
+    if (this->Owner->GetPointBudget() > 0)
       {
-      glDrawArrays(GL_POINTS, 0,
-        static_cast<GLuint>(this->VBO->VertexCount));
+      int vertsPerPoint = this->UsingPoints ? 1 : 3;
+      for (size_t i = 0; i < this->LODDrawNodes.size(); ++i)
+        {
+        const LODNode &node = this->LODNodes[this->LODDrawNodes[i]];
+        glDrawArrays(mode,
+          static_cast<GLint>(node.Slot*this->LODNodeSize*vertsPerPoint),
+          static_cast<GLsizei>(node.Count*vertsPerPoint));
+        }
       }
     else
       {
-      glDrawArrays(GL_TRIANGLES, 0,
+      glDrawArrays(mode, 0,
         static_cast<GLuint>(this->VBO->VertexCount));
       }
     if (this->Owner->GetEmissive() != 0)
@@ -749,6 +1288,11 @@ vtkOpenGLPointGaussianMapper::vtkOpenGLPointGaussianMapper()
 {
   this->Helper = vtkOpenGLPointGaussianMapperHelper::New();
   this->Helper->Owner = this;
+  this->PointBudget = 0;
+  this->NodeSize = 4096;
+  this->NodeUploadsPerRender = 16;
+  this->NumberOfRenderedPoints = 0;
+  this->NumberOfPendingNodes = 0;
 }
 
 vtkOpenGLPointGaussianMapper::~vtkOpenGLPointGaussianMapper()
@@ -790,4 +1334,9 @@ bool vtkOpenGLPointGaussianMapper::GetIsOpaque()
 void vtkOpenGLPointGaussianMapper::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "PointBudget: " << this->PointBudget << "\n";
+  os << indent << "NodeSize: " << this->NodeSize << "\n";
+  os << indent << "NodeUploadsPerRender: " << this->NodeUploadsPerRender << "\n";
+  os << indent << "NumberOfRenderedPoints: " << this->NumberOfRenderedPoints << "\n";
+  os << indent << "NumberOfPendingNodes: " << this->NumberOfPendingNodes << "\n";
 }
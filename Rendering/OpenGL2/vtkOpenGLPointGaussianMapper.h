@@ -15,6 +15,17 @@
 // .SECTION Description
 // An OpenGL mapper that uses imposters to draw PointGaussians. Supports
 // transparency and picking as well.
+//
+// For clouds too large to draw at every frame, a positive PointBudget
+// enables a level of detail. The points are then sorted into an octree
+// where every node keeps an evenly spread sample of the points below it,
+// and each render draws the nodes that best cover the view, largest on
+// screen first, up to PointBudget points. Nodes live in a GPU cache sized
+// by the budget and at most NodeUploadsPerRender of them are sent each
+// render, so the interaction cost stays bounded while the missing nodes
+// arrive over the next renders: render again while
+// GetNumberOfPendingNodes() is positive to finish the refinement. In this
+// mode the point ids given to a hardware selector do not match the input.
 
 #ifndef vtkOpenGLPointGaussianMapper_h
 #define vtkOpenGLPointGaussianMapper_h
@@ -41,6 +52,34 @@ public:
   // Is this mapper opqaue? currently always false.
   virtual bool GetIsOpaque();
 
+  // Description:
+  // Maximum number of points drawn at each render. Zero, the default, draws
+  // every point and disables the level of detail.
+  vtkSetClampMacro(PointBudget,vtkIdType,0,VTK_ID_MAX);
+  vtkGetMacro(PointBudget,vtkIdType);
+
+  // Description:
+  // Maximum number of points in a node of the level of detail octree.
+  // Larger nodes mean fewer draw calls but a coarser selection.
+  // Default is 4096.
+  vtkSetClampMacro(NodeSize,int,64,1048576);
+  vtkGetMacro(NodeSize,int);
+
+  // Description:
+  // Maximum number of octree nodes sent to the GPU at each render.
+  // Default is 16.
+  vtkSetClampMacro(NodeUploadsPerRender,int,1,VTK_INT_MAX);
+  vtkGetMacro(NodeUploadsPerRender,int);
+
+  // Description:
+  // Number of points drawn at the last render with a point budget.
+  vtkGetMacro(NumberOfRenderedPoints,vtkIdType);
+
+  // Description:
+  // Number of nodes selected at the last render that were not drawn
+  // because they were still waiting for their upload.
+  vtkGetMacro(NumberOfPendingNodes,int);
+
 protected:
   vtkOpenGLPointGaussianMapper();
   ~vtkOpenGLPointGaussianMapper();
@@ -50,6 +89,14 @@ protected:
   vtkOpenGLPointGaussianMapperHelper *Helper;
   vtkTimeStamp HelperUpdateTime;
 
+  vtkIdType PointBudget;
+  int NodeSize;
+  int NodeUploadsPerRender;
+  vtkIdType NumberOfRenderedPoints;
+  int NumberOfPendingNodes;
+
+  friend class vtkOpenGLPointGaussianMapperHelper;
+
 private:
   vtkOpenGLPointGaussianMapper(const vtkOpenGLPointGaussianMapper&); // Not implemented.
   void operator=(const vtkOpenGLPointGaussianMapper&); // Not implemented.
@@ -34,6 +34,7 @@
 #include "vtkOpenGLBufferObject.h"
 #include "vtkOpenGLCamera.h"
 #include "vtkOpenGLError.h"
+#include "vtkOpenGLHardwareSelector.h"
 #include "vtkOpenGLHelper.h"
 #include "vtkOpenGLIndexBufferObject.h"
 #include "vtkOpenGLRenderWindow.h"
@@ -42,6 +43,7 @@
 #include "vtkOpenGLTexture.h"
 #include "vtkOpenGLVertexArrayObject.h"
 #include "vtkOpenGLVertexBufferObject.h"
+#include "vtkOrderIndependentTranslucentPass.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkProperty.h"
@@ -96,6 +98,8 @@ vtkOpenGLPolyDataMapper::vtkOpenGLPolyDataMapper()
   this->ProcessIdArrayName = NULL;
   this->CompositeIdArrayName = NULL;
   this->VBO = vtkOpenGLVertexBufferObject::New();
+  this->ColorBufferObject = 0;
+  this->ColorBufferComponents = 0;
 
   this->AppleBugPrimIDBuffer = 0;
   this->HaveAppleBug = false;
@@ -155,6 +159,11 @@ vtkOpenGLPolyDataMapper::~vtkOpenGLPolyDataMapper()
   this->VBO->Delete();
   this->VBO = 0;
 
+  if (this->ColorBufferObject)
+    {
+    this->ColorBufferObject->Delete();
+    }
+
   if (this->AppleBugPrimIDBuffer)
     {
     this->AppleBugPrimIDBuffer->Delete();
@@ -196,11 +205,16 @@ void vtkOpenGLPolyDataMapper::ReleaseGraphicsResources(vtkWindow* win)
     {
     this->CellNormalBuffer->ReleaseGraphicsResources();
     }
+  if (this->ColorBufferObject)
+    {
+    this->ColorBufferObject->ReleaseGraphicsResources();
+    }
   if (this->AppleBugPrimIDBuffer)
     {
     this->AppleBugPrimIDBuffer->ReleaseGraphicsResources();
     }
   this->VBOBuildString = "";
+  this->ColorBufferBuildString = "";
   this->IBOBuildString = "";
   this->Modified();
 }
@@ -385,7 +399,7 @@ void vtkOpenGLPolyDataMapper::ReplaceShaderColor(
       }
     }
   // add scalar vertex coloring
-  if (this->VBO->ColorComponents != 0 && !this->DrawingEdges)
+  if (this->HavePointColors() && !this->DrawingEdges)
     {
     colorDec += "varying vec4 vertexColorVSOutput;\n";
     vtkShaderProgram::Substitute(VSSource,"//VTK::Color::Dec",
@@ -467,7 +481,7 @@ void vtkOpenGLPolyDataMapper::ReplaceShaderColor(
     }
 
   // now handle scalar coloring
-  if (this->VBO->ColorComponents != 0 && !this->DrawingEdges)
+  if (this->HavePointColors() && !this->DrawingEdges)
     {
     if (this->ScalarMaterialMode == VTK_MATERIALMODE_AMBIENT ||
         (this->ScalarMaterialMode == VTK_MATERIALMODE_DEFAULT &&
@@ -912,7 +926,24 @@ void vtkOpenGLPolyDataMapper::ReplaceShaderPicking(
 {
   std::string FSSource = shaders[vtkShader::Fragment]->GetSource();
 
-  if (this->LastSelectionState >= vtkHardwareSelector::MIN_KNOWN_PASS)
+  if (this->LastSelectionState == vtkHardwareSelector::SINGLE_PASS &&
+      this->HavePickScalars)
+    {
+    // one color buffer per pass, see vtkOpenGLHardwareSelector
+    vtkShaderProgram::Substitute(FSSource,
+      "//VTK::Picking::Dec",
+      "uniform vec3 mapperIndex;\n"
+      "uniform vec3 compositeIndex;\n"
+      "uniform vec3 processIndex;\n"
+      "uniform samplerBuffer textureC;");
+    vtkShaderProgram::Substitute(FSSource, "//VTK::Picking::Impl",
+      "  gl_FragData[0] = vec4(mapperIndex,1.0);\n"
+      "  gl_FragData[1] = vec4(compositeIndex,1.0);\n"
+      "  gl_FragData[2] = texelFetchBuffer(textureC, gl_PrimitiveID + PrimitiveIDOffset);\n"
+      "  gl_FragData[3] = vec4(processIndex,1.0);\n"
+      );
+    }
+  else if (this->LastSelectionState >= vtkHardwareSelector::MIN_KNOWN_PASS)
     {
     if (this->HavePickScalars)
       {
@@ -985,6 +1016,18 @@ void vtkOpenGLPolyDataMapper::ReplaceShaderDepthPeeling(
       //  "gl_FragData[0] = vec4(odepth*odepth,tdepth*tdepth,gl_FragCoord.z*gl_FragCoord.z,1.0);"
       );
     }
+  // or weighted blending? the weight favors the fragments close to the
+  // camera, see vtkOrderIndependentTranslucentPass
+  else if (info &&
+    info->Has(vtkOrderIndependentTranslucentPass::WeightedBlending()))
+    {
+    vtkShaderProgram::Substitute(FSSource, "//VTK::DepthPeeling::Impl",
+      "float weight = gl_FragData[0].a *\n"
+      "    clamp(3000.0*pow(1.0 - gl_FragCoord.z, 3.0), 0.01, 3000.0);\n"
+      "  gl_FragData[1] = vec4(weight);\n"
+      "  gl_FragData[0] = vec4(gl_FragData[0].rgb*weight, gl_FragData[0].a);\n"
+      );
+    }
   shaders[vtkShader::Fragment]->SetSource(FSSource);
 }
 
@@ -1283,6 +1326,14 @@ void vtkOpenGLPolyDataMapper::ReplaceShaderValues(
   //cout << "FS: " << shaders[vtkShader::Fragment]->GetSource() << endl;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkOpenGLPolyDataMapper::GetSupportsSinglePassSelection()
+{
+  // composite ids from the data vary per cell, the single pass only has
+  // one per block
+  return this->CompositeIdArrayName == NULL;
+}
+
 //-----------------------------------------------------------------------------
 bool vtkOpenGLPolyDataMapper::GetNeedToRebuildShaders(
   vtkOpenGLHelper &cellBO, vtkRenderer* ren, vtkActor *actor)
@@ -1354,7 +1405,8 @@ bool vtkOpenGLPolyDataMapper::GetNeedToRebuildShaders(
 
   // check for prop keys
   vtkInformation *info = actor->GetPropertyKeys();
-  int dp = (info && info->Has(vtkDepthPeelingPass::OpaqueZTextureUnit())) ? 1 : 0;
+  int dp = (info && info->Has(vtkDepthPeelingPass::OpaqueZTextureUnit())) ? 1 :
+    (info && info->Has(vtkOrderIndependentTranslucentPass::WeightedBlending())) ? 2 : 0;
 
   if (this->LastDepthPeeling != dp)
     {
@@ -1449,6 +1501,7 @@ void vtkOpenGLPolyDataMapper::SetMapperShaderParameters(vtkOpenGLHelper &cellBO,
     this->PrimitiveIDOffset);
 
   if (cellBO.IBO->IndexCount && (this->VBOBuildTime > cellBO.AttributeUpdateTime ||
+      this->ColorBufferBuildTime > cellBO.AttributeUpdateTime ||
       cellBO.ShaderSourceTime > cellBO.AttributeUpdateTime))
     {
     cellBO.VAO->Bind();
@@ -1486,6 +1539,18 @@ void vtkOpenGLPolyDataMapper::SetMapperShaderParameters(vtkOpenGLHelper &cellBO,
         vtkErrorMacro(<< "Error setting 'scalarColor' in shader VAO.");
         }
       }
+    else if (this->ColorBufferComponents != 0 && !this->DrawingEdges)
+      {
+      if (!cellBO.VAO->AddAttributeArray(cellBO.Program,
+                                      this->ColorBufferObject,
+                                      "scalarColor", 0,
+                                      this->ColorBufferComponents,
+                                      VTK_UNSIGNED_CHAR,
+                                      this->ColorBufferComponents, true))
+        {
+        vtkErrorMacro(<< "Error setting 'scalarColor' in shader VAO.");
+        }
+      }
     if (this->AppleBugPrimIDs.size())
       {
       if (!cellBO.VAO->AddAttributeArray(cellBO.Program,
@@ -1573,6 +1638,18 @@ void vtkOpenGLPolyDataMapper::SetMapperShaderParameters(vtkOpenGLHelper &cellBO,
         {
         cellBO.Program->SetUniform3f("mapperIndex", selector->GetPropColorValue());
         }
+      vtkOpenGLHardwareSelector *glSelector =
+        vtkOpenGLHardwareSelector::SafeDownCast(selector);
+      if (selector->GetCurrentPass() == vtkHardwareSelector::SINGLE_PASS &&
+          glSelector)
+        {
+        cellBO.Program->SetUniform3f("mapperIndex",
+          glSelector->GetPropColorValue());
+        cellBO.Program->SetUniform3f("compositeIndex",
+          glSelector->GetCompositeColorValue());
+        cellBO.Program->SetUniform3f("processIndex",
+          glSelector->GetProcessColorValue());
+        }
       }
     else
       {
@@ -1979,7 +2056,8 @@ void vtkOpenGLPolyDataMapper::RenderPieceStart(vtkRenderer* ren, vtkActor *actor
       }
     if (selector->GetCurrentPass() == vtkHardwareSelector::ID_LOW24 ||
         selector->GetCurrentPass() == vtkHardwareSelector::ID_MID24 ||
-        selector->GetCurrentPass() == vtkHardwareSelector::ID_HIGH16)
+        selector->GetCurrentPass() == vtkHardwareSelector::ID_HIGH16 ||
+        selector->GetCurrentPass() == vtkHardwareSelector::SINGLE_PASS)
       {
       selector->RenderAttributeId(0);
       }
@@ -2360,6 +2438,12 @@ void vtkOpenGLPolyDataMapper::UpdateBufferObjects(vtkRenderer *ren, vtkActor *ac
     }
 }
 
+//-------------------------------------------------------------------------
+bool vtkOpenGLPolyDataMapper::HavePointColors()
+{
+  return this->VBO->ColorComponents != 0 || this->ColorBufferComponents != 0;
+}
+
 //-------------------------------------------------------------------------
 bool vtkOpenGLPolyDataMapper::GetNeedToRebuildBufferObjects(
   vtkRenderer *vtkNotUsed(ren), vtkActor *act)
@@ -2413,6 +2497,7 @@ void vtkOpenGLPolyDataMapper::AppendCellTextures(
         break;
       case vtkHardwareSelector::ID_LOW24:
       case vtkHardwareSelector::ID_MID24:
+      case vtkHardwareSelector::SINGLE_PASS:
         if (selector->GetFieldAssociation() ==
           vtkDataObject::FIELD_ASSOCIATION_POINTS)
           {
@@ -2465,7 +2550,10 @@ void vtkOpenGLPolyDataMapper::AppendCellTextures(
           newColors.push_back(value & 0xff);
           newColors.push_back((value & 0xff00) >> 8);
           newColors.push_back((value & 0xff0000) >> 16);
-          newColors.push_back(0xff);
+          // the single pass keeps the next byte of the id in alpha
+          newColors.push_back(
+            selector->GetCurrentPass() == vtkHardwareSelector::SINGLE_PASS ?
+            (value & 0xff000000) >> 24 : 0xff);
           }
         } // for cell
       }
@@ -2568,7 +2656,10 @@ void vtkOpenGLPolyDataMapper::AppendCellTextures(
           newColors.push_back(value & 0xff);
           newColors.push_back((value & 0xff00) >> 8);
           newColors.push_back((value & 0xff0000) >> 16);
-          newColors.push_back(0xff);
+          // the single pass keeps the next byte of the id in alpha
+          newColors.push_back(
+            selector->GetCurrentPass() == vtkHardwareSelector::SINGLE_PASS ?
+            (value & 0xff000000) >> 24 : 0xff);
           }
         }
       else
@@ -2901,15 +2992,15 @@ void vtkOpenGLPolyDataMapper::BuildBufferObjects(vtkRenderer *ren, vtkActor *act
       }
 
   // rebuild the VBO if the data has changed we create a string for the VBO what
-  // can change the VBO? points normals tcoords colors so what can change those?
-  // the input data is clearly one as it can change all four items tcoords may
-  // haveTextures or not colors may change based on quite a few mapping
-  // parameters in the mapper
+  // can change the VBO? points normals tcoords so what can change those?
+  // the input data is clearly one as it can change all three items tcoords may
+  // haveTextures or not. The colors live in their own buffer since they may
+  // change based on quite a few mapping parameters in the mapper, the lookup
+  // table most often, while the geometry stays the same.
   std::ostringstream toString;
   toString.str("");
   toString.clear();
   toString << poly->GetMTime() <<
-    'A' << (c ? c->GetMTime() : 1) <<
     'B' << (n ? n->GetMTime() : 1) <<
     'C' << (tcoords ? tcoords->GetMTime() : 1);
 
@@ -2918,14 +3009,37 @@ void vtkOpenGLPolyDataMapper::BuildBufferObjects(vtkRenderer *ren, vtkActor *act
     // Build the VBO
     this->VBO->CreateVBO(poly->GetPoints(),
         poly->GetPoints()->GetNumberOfPoints(),
-        n, tcoords,
-        c ? (unsigned char *)c->GetVoidPointer(0) : NULL,
-        c ? c->GetNumberOfComponents() : 0);
+        n, tcoords, NULL, 0);
 
     this->VBOBuildTime.Modified();
     this->VBOBuildString = toString.str();
     }
 
+  toString.str("");
+  toString.clear();
+  toString << poly->GetMTime() << 'A' << (c ? c->GetMTime() : 1);
+
+  if (this->ColorBufferBuildString != toString.str())
+    {
+    this->ColorBufferComponents = 0;
+    if (c)
+      {
+      if (!this->ColorBufferObject)
+        {
+        this->ColorBufferObject = vtkOpenGLBufferObject::New();
+        }
+      // the mapped colors are unsigned chars, uploaded as they are
+      this->ColorBufferComponents = c->GetNumberOfComponents();
+      this->ColorBufferObject->Upload(
+        static_cast<unsigned char *>(c->GetVoidPointer(0)),
+        c->GetNumberOfTuples() * this->ColorBufferComponents,
+        vtkOpenGLBufferObject::ArrayBuffer);
+      }
+
+    this->ColorBufferBuildTime.Modified();
+    this->ColorBufferBuildString = toString.str();
+    }
+
   // now create the IBOs
   this->BuildIBO(ren, act, poly);
 
@@ -67,6 +67,13 @@ public:
   // selection.
   virtual bool GetSupportsSelection() { return true; }
 
+  // Description:
+  // WARNING: INTERNAL METHOD - NOT INTENDED FOR GENERAL USE
+  // DO NOT USE THIS METHOD OUTSIDE OF THE RENDERING PROCESS
+  // Used by vtkOpenGLHardwareSelector to determine if the mapper can write
+  // all of its ids in the SINGLE_PASS.
+  virtual bool GetSupportsSinglePassSelection();
+
   // Description:
   // Returns if the mapper does not expect to have translucent geometry. This
   // may happen when using ScalarMode is set to not map scalars i.e. render the
@@ -291,6 +298,14 @@ protected:
   // The VBO and its layout.
   vtkOpenGLVertexBufferObject *VBO;
 
+  // The mapped scalar colors are kept out of the VBO in their own buffer,
+  // so that a new lookup table re-uploads the colors alone.
+  vtkOpenGLBufferObject *ColorBufferObject;
+  int ColorBufferComponents;
+
+  // Are there point colors, in the VBO or in ColorBufferObject?
+  bool HavePointColors();
+
   // Structures for the various cell types we render.
   vtkOpenGLHelper Points;
   vtkOpenGLHelper Lines;
@@ -317,6 +332,8 @@ protected:
   bool UsingScalarColoring;
   vtkTimeStamp VBOBuildTime; // When was the OpenGL VBO updated?
   std::string VBOBuildString; // used for determining whento rebuild the VBO
+  vtkTimeStamp ColorBufferBuildTime; // When was the color buffer updated?
+  std::string ColorBufferBuildString; // when to rebuild the color buffer
   std::string IBOBuildString; // used for determining whento rebuild the IBOs
   vtkOpenGLTexture* InternalColorTexture;
 
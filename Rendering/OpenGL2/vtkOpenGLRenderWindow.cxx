@@ -31,6 +31,9 @@
 #include "vtkOpenGLRenderer.h"
 #include "vtkOpenGLShaderCache.h"
 #include "vtkOpenGLVertexArrayObject.h"
+#if GL_ES_VERSION_2_0 != 1 || GL_ES_VERSION_3_0 == 1
+#include "vtkPixelBufferObject.h"
+#endif
 #include "vtkRendererCollection.h"
 #include "vtkShaderProgram.h"
 #include "vtkStdString.h"
@@ -40,6 +43,8 @@
 
 #include "vtkTextureObjectVS.h"  // a pass through shader
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 using std::ostringstream;
 
@@ -128,6 +133,12 @@ vtkOpenGLRenderWindow::vtkOpenGLRenderWindow()
 
   this->DrawPixelsTextureObject = NULL;
 
+  this->ReadbackBuffers[0] = NULL;
+  this->ReadbackBuffers[1] = NULL;
+  this->FirstReadback = 0;
+  this->NumberOfReadbacks = 0;
+  this->ReadbackComponents = 0;
+
   this->OwnContext = 1;
   this->MaximumHardwareLineWidth = 1.0;
 
@@ -148,6 +159,14 @@ vtkOpenGLRenderWindow::~vtkOpenGLRenderWindow()
     this->DrawPixelsTextureObject->UnRegister(this);
     this->DrawPixelsTextureObject = NULL;
     }
+  for (int i = 0; i < 2; ++i)
+    {
+    if (this->ReadbackBuffers[i])
+      {
+      this->ReadbackBuffers[i]->Delete();
+      this->ReadbackBuffers[i] = NULL;
+      }
+    }
   this->TextureResourceIds.clear();
   if(this->TextureUnitManager!=0)
     {
@@ -180,6 +199,16 @@ void vtkOpenGLRenderWindow::ReleaseGraphicsResources(vtkRenderWindow *renWin)
      this->DrawPixelsTextureObject->ReleaseGraphicsResources(renWin);
      }
 
+  // queued reads are lost with their buffers
+  for (int i = 0; i < 2; ++i)
+    {
+    if (this->ReadbackBuffers[i])
+      {
+      this->ReadbackBuffers[i]->SetContext(NULL);
+      }
+    }
+  this->NumberOfReadbacks = 0;
+
   this->ShaderCache->ReleaseGraphicsResources(renWin);
 
   if (this->TextureResourceIds.size())
@@ -909,6 +938,124 @@ int vtkOpenGLRenderWindow::GetPixelData(int x1, int y1,
 
 }
 
+int vtkOpenGLRenderWindow::QueuePixelData(int x1, int y1,
+                                          int x2, int y2,
+                                          int front, int rgba)
+{
+#if GL_ES_VERSION_2_0 != 1 || GL_ES_VERSION_3_0 == 1
+  // set the current window
+  this->MakeCurrent();
+
+  int extent[4] = { std::min(x1, x2), std::min(y1, y2),
+                    std::max(x1, x2), std::max(y1, y2) };
+  int components = rgba ? 4 : 3;
+  if (this->NumberOfReadbacks > 0 &&
+      (components != this->ReadbackComponents ||
+       !std::equal(extent, extent + 4, this->ReadbackExtent)))
+    {
+    this->NumberOfReadbacks = 0;
+    }
+  if (this->NumberOfReadbacks == 2)
+    {
+    // reuse the buffer of the oldest read
+    this->FirstReadback = 1 - this->FirstReadback;
+    this->NumberOfReadbacks = 1;
+    }
+  std::copy(extent, extent + 4, this->ReadbackExtent);
+  this->ReadbackComponents = components;
+
+  int index = (this->FirstReadback + this->NumberOfReadbacks) % 2;
+  if (!this->ReadbackBuffers[index])
+    {
+    this->ReadbackBuffers[index] = vtkPixelBufferObject::New();
+    }
+  vtkPixelBufferObject *pbo = this->ReadbackBuffers[index];
+  pbo->SetContext(this);
+  int width = extent[2] - extent[0] + 1;
+  int height = extent[3] - extent[1] + 1;
+  pbo->Allocate(VTK_UNSIGNED_CHAR, width*height, components,
+    vtkPixelBufferObject::PACKED_BUFFER);
+
+  // Must clear previous errors first.
+  while(glGetError() != GL_NO_ERROR)
+    {
+    ;
+    }
+
+  if (front)
+    {
+    glReadBuffer(static_cast<GLenum>(this->GetFrontLeftBuffer()));
+    }
+  else
+    {
+    glReadBuffer(static_cast<GLenum>(this->GetBackLeftBuffer()));
+    }
+
+  glDisable( GL_SCISSOR_TEST );
+  glPixelStorei( GL_PACK_ALIGNMENT, 1 );
+
+  // with a buffer bound, glReadPixels only queues the copy into it
+  pbo->BindToPackedBuffer();
+  glReadPixels(extent[0], extent[1], width, height,
+    rgba ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, NULL);
+  pbo->UnBind();
+
+  if (glGetError() != GL_NO_ERROR)
+    {
+    return 0;
+    }
+  ++this->NumberOfReadbacks;
+  return 1;
+#else
+  (void)x1;
+  (void)y1;
+  (void)x2;
+  (void)y2;
+  (void)front;
+  (void)rgba;
+  return 0;
+#endif
+}
+
+int vtkOpenGLRenderWindow::GetQueuedPixelData(vtkUnsignedCharArray *data)
+{
+#if GL_ES_VERSION_2_0 != 1 || GL_ES_VERSION_3_0 == 1
+  if (this->NumberOfReadbacks == 0)
+    {
+    return 0;
+    }
+
+  // set the current window
+  this->MakeCurrent();
+
+  vtkPixelBufferObject *pbo = this->ReadbackBuffers[this->FirstReadback];
+  this->FirstReadback = 1 - this->FirstReadback;
+  --this->NumberOfReadbacks;
+
+  // mapping waits for the copy if the GPU did not get to it yet
+  const unsigned char *pixels =
+    static_cast<const unsigned char *>(pbo->MapPackedBuffer());
+  if (!pixels)
+    {
+    return 0;
+    }
+  vtkIdType size = static_cast<vtkIdType>(pbo->GetSize());
+  data->SetNumberOfComponents(this->ReadbackComponents);
+  data->SetNumberOfTuples(size/this->ReadbackComponents);
+  memcpy(data->GetPointer(0), pixels, size);
+  pbo->UnmapPackedBuffer();
+  return 1;
+#else
+  (void)data;
+  return 0;
+#endif
+}
+
+int vtkOpenGLRenderWindow::GetNumberOfQueuedPixelData()
+{
+  return this->NumberOfReadbacks;
+}
+
 int vtkOpenGLRenderWindow::SetPixelData(int x1, int y1, int x2, int y2,
                                         vtkUnsignedCharArray *data, int front)
 {
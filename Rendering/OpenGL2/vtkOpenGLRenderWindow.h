@@ -32,6 +32,7 @@ class vtkIdList;
 class vtkOpenGLHardwareSupport;
 class vtkOpenGLShaderCache;
 class vtkOpenGLVertexArrayObject;
+class vtkPixelBufferObject;
 class vtkShaderProgram;
 class vtkStdString;
 class vtkTexture;
@@ -93,6 +94,14 @@ public:
                                    vtkUnsignedCharArray *data, int front,
                                    int blend=0);
 
+  // Description:
+  // Read the char pixels through a pair of pixel buffer objects, used in
+  // turn, so that glReadPixels returns before the frame is done.
+  virtual int QueuePixelData(int x, int y, int x2, int y2, int front,
+                             int rgba);
+  virtual int GetQueuedPixelData(vtkUnsignedCharArray *data);
+  virtual int GetNumberOfQueuedPixelData();
+
   // Description:
   // Set/Get the zbuffer data from an image
   virtual float *GetZbufferData( int x1, int y1, int x2, int y2 );
@@ -380,6 +389,13 @@ protected:
 
   vtkTextureObject *DrawPixelsTextureObject;
 
+  // the reads of QueuePixelData, the oldest is ReadbackBuffers[FirstReadback]
+  vtkPixelBufferObject *ReadbackBuffers[2];
+  int FirstReadback;
+  int NumberOfReadbacks;
+  int ReadbackExtent[4];
+  int ReadbackComponents;
+
   bool Initialized; // ensure glewinit has been called
 
   float MaximumHardwareLineWidth;
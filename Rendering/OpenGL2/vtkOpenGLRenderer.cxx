@@ -27,6 +27,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkOpenGLCamera.h"
 #include "vtkOpenGLError.h"
 #include "vtkOpenGLRenderWindow.h"
+#include "vtkOrderIndependentTranslucentPass.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
@@ -68,6 +69,7 @@ vtkOpenGLRenderer::vtkOpenGLRenderer()
   this->PickedZ = 0;
 
   this->DepthPeelingPass = 0;
+  this->OrderIndependentTranslucentPass = 0;
   this->ShadowMapPass = 0;
   this->DepthPeelingHigherLayer=0;
 
@@ -266,13 +268,30 @@ void vtkOpenGLRenderer::DeviceRenderTranslucentPolygonalGeometry()
   vtkOpenGLRenderWindow *context
     = vtkOpenGLRenderWindow::SafeDownCast(this->RenderWindow);
 
-  if(this->UseDepthPeeling && !context)
+  if((this->UseDepthPeeling || this->UseWeightedBlendedTranslucency) &&
+     !context)
     {
     vtkErrorMacro("OpenGL render window is required.")
     return;
     }
 
-  if(!this->UseDepthPeeling)
+  if (this->UseWeightedBlendedTranslucency)
+    {
+    if (!this->OrderIndependentTranslucentPass)
+      {
+      this->OrderIndependentTranslucentPass =
+        vtkOrderIndependentTranslucentPass::New();
+      vtkTranslucentPass *tp = vtkTranslucentPass::New();
+      this->OrderIndependentTranslucentPass->SetTranslucentPass(tp);
+      tp->Delete();
+      }
+    vtkRenderState s(this);
+    s.SetPropArrayAndCount(this->PropArray, this->PropArrayCount);
+    s.SetFrameBuffer(0);
+    this->LastRenderingUsedDepthPeeling=0;
+    this->OrderIndependentTranslucentPass->Render(&s);
+    }
+  else if(!this->UseDepthPeeling)
     {
     // just alpha blending
     this->UpdateTranslucentPolygonalGeometry();
@@ -516,6 +535,10 @@ void vtkOpenGLRenderer::ReleaseGraphicsResources(vtkWindow *w)
     {
     this->DepthPeelingPass->ReleaseGraphicsResources(w);
     }
+  if (w && this->OrderIndependentTranslucentPass)
+    {
+    this->OrderIndependentTranslucentPass->ReleaseGraphicsResources(w);
+    }
   if (w && this->ShadowMapPass)
     {
     this->ShadowMapPass->ReleaseGraphicsResources(w);
@@ -653,6 +676,11 @@ vtkOpenGLRenderer::~vtkOpenGLRenderer()
     this->DepthPeelingPass->Delete();
     this->DepthPeelingPass = 0;
     }
+  if (this->OrderIndependentTranslucentPass)
+    {
+    this->OrderIndependentTranslucentPass->Delete();
+    this->OrderIndependentTranslucentPass = 0;
+    }
 }
 
 bool vtkOpenGLRenderer::HaveApplePrimitiveIdBug()
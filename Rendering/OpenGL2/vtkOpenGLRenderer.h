@@ -28,6 +28,7 @@ class vtkRenderPass;
 class vtkOpenGLTexture;
 class vtkTextureObject;
 class vtkDepthPeelingPass;
+class vtkOrderIndependentTranslucentPass;
 class vtkShadowMapPass;
 
 class VTKRENDERINGOPENGL2_EXPORT vtkOpenGLRenderer : public vtkRenderer
@@ -113,6 +114,11 @@ protected:
   // Depth peeling is delegated to an instance of vtkDepthPeelingPass
   vtkDepthPeelingPass *DepthPeelingPass;
 
+  // Description:
+  // Weighted blended translucency is delegated to an instance of
+  // vtkOrderIndependentTranslucentPass
+  vtkOrderIndependentTranslucentPass *OrderIndependentTranslucentPass;
+
   // Description:
   // Shadows are delegated to an instance of vtkShadowMapPass
   vtkShadowMapPass *ShadowMapPass;
@@ -23,11 +23,28 @@
 #include "vtkOpenGLHelper.h"
 
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <sstream>
 
-
+#ifdef _WIN32
+# include <process.h> // for _getpid
+# define vtkGetProcessId _getpid
+#else
+# include <unistd.h> // for getpid
+# define vtkGetProcessId getpid
+#endif
 
 #include "vtksys/MD5.h"
+#include "vtksys/SystemTools.hxx"
+
+namespace
+{
+// first bytes of the files of BinaryCacheDirectory, with the version of
+// their layout
+const char vtkProgramBinaryMagic[8] = { 'V','T','K','P','B','I','N','1' };
+}
 
 class vtkOpenGLShaderCache::Private
 {
@@ -37,9 +54,15 @@ public:
   // map of hash to shader program structs
   std::map<std::string, vtkShaderProgram *> ShaderPrograms;
 
+  // whether the context can get and load program binaries, -1 until the
+  // first program is cached, and the description of its driver
+  int BinarySupport;
+  std::string DriverKey;
+
   Private()
   {
   md5 = vtksysMD5_New();
+  this->BinarySupport = -1;
   }
 
   ~Private()
@@ -92,6 +115,14 @@ vtkStandardNewMacro(vtkOpenGLShaderCache);
 vtkOpenGLShaderCache::vtkOpenGLShaderCache() : Internal(new Private)
 {
   this->LastShaderBound  = NULL;
+  this->BinaryCacheDirectory = NULL;
+  this->NumberOfLoadedBinaries = 0;
+  this->NumberOfSavedBinaries = 0;
+  const char *dir = vtksys::SystemTools::GetEnv("VTK_SHADER_CACHE_DIRECTORY");
+  if (dir && *dir)
+    {
+    this->SetBinaryCacheDirectory(dir);
+    }
 }
 
 // ----------------------------------------------------------------------------
@@ -105,6 +136,7 @@ vtkOpenGLShaderCache::~vtkOpenGLShaderCache()
     }
 
   delete this->Internal;
+  this->SetBinaryCacheDirectory(NULL);
 }
 
 // perform System and Output replacments
@@ -317,10 +349,14 @@ vtkShaderProgram *vtkOpenGLShaderCache::ReadyShaderProgram(
     return NULL;
     }
 
-  // compile if needed
-  if (!shader->GetCompiled() && !shader->CompileShader())
+  // compile if needed, unless the binary of the program is cached
+  if (!shader->GetCompiled() && !this->LoadProgramBinary(shader))
     {
-    return NULL;
+    if (!shader->CompileShader())
+      {
+      return NULL;
+      }
+    this->SaveProgramBinary(shader);
     }
 
   // bind if needed
@@ -442,8 +478,152 @@ int vtkOpenGLShaderCache::BindShader(vtkShaderProgram* shader)
 }
 
 
+std::string vtkOpenGLShaderCache::GetProgramBinaryFileName(
+  vtkShaderProgram *shader)
+{
+  if (!this->BinaryCacheDirectory || !*this->BinaryCacheDirectory ||
+      shader->GetTransformFeedback() || shader->GetMD5Hash().empty())
+    {
+    return std::string();
+    }
+
+  if (this->Internal->BinarySupport == -1)
+    {
+#if GL_ES_VERSION_2_0 != 1
+    bool supported = GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary;
+#else
+#if GL_ES_VERSION_3_0 == 1
+    bool supported = true;
+#else
+    bool supported = false;
+#endif
+#endif
+#if GL_ES_VERSION_2_0 != 1 || GL_ES_VERSION_3_0 == 1
+    if (supported)
+      {
+      // a driver may support the extension without any binary format
+      GLint formats = 0;
+      glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+      supported = formats > 0;
+      }
+#endif
+    this->Internal->BinarySupport = supported ? 1 : 0;
+    if (supported)
+      {
+      const char *vendor = (const char *)glGetString(GL_VENDOR);
+      const char *renderer = (const char *)glGetString(GL_RENDERER);
+      const char *version = (const char *)glGetString(GL_VERSION);
+      std::ostringstream key;
+      key << (vendor ? vendor : "") << "\n" << (renderer ? renderer : "")
+          << "\n" << (version ? version : "");
+      this->Internal->DriverKey = key.str();
+      }
+    }
+  if (this->Internal->BinarySupport == 0)
+    {
+    return std::string();
+    }
+
+  std::string hash;
+  this->Internal->ComputeMD5(shader->GetMD5Hash().c_str(),
+    this->Internal->DriverKey.c_str(), NULL, hash);
+  return std::string(this->BinaryCacheDirectory) + "/" + hash + ".bin";
+}
+
+bool vtkOpenGLShaderCache::LoadProgramBinary(vtkShaderProgram *shader)
+{
+  std::string fileName = this->GetProgramBinaryFileName(shader);
+  if (fileName.empty())
+    {
+    return false;
+    }
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+    {
+    return false;
+    }
+
+  char magic[sizeof(vtkProgramBinaryMagic)];
+  unsigned int format = 0;
+  unsigned int length = 0;
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char *>(&format), sizeof(format));
+  file.read(reinterpret_cast<char *>(&length), sizeof(length));
+  std::vector<char> binary;
+  if (file && length > 0 &&
+      memcmp(magic, vtkProgramBinaryMagic, sizeof(magic)) == 0)
+    {
+    binary.resize(length);
+    file.read(&binary[0], length);
+    }
+  file.close();
+
+  if (binary.empty() || !shader->LoadBinary(format, binary))
+    {
+    // truncated by a crash or rejected by an updated driver, it is
+    // replaced once the program is compiled
+    vtksys::SystemTools::RemoveFile(fileName);
+    return false;
+    }
+  this->NumberOfLoadedBinaries++;
+  return true;
+}
+
+void vtkOpenGLShaderCache::SaveProgramBinary(vtkShaderProgram *shader)
+{
+  std::string fileName = this->GetProgramBinaryFileName(shader);
+  unsigned int format = 0;
+  std::vector<char> binary;
+  if (fileName.empty() || !shader->GetBinary(format, binary))
+    {
+    return;
+    }
+  vtksys::SystemTools::MakeDirectory(this->BinaryCacheDirectory);
+
+  // processes sharing the directory may save the same program at once,
+  // each writes its own file and renames it over the final one
+  std::ostringstream tmpName;
+  tmpName << fileName << "." << vtkGetProcessId() << ".tmp";
+  std::ofstream file(tmpName.str().c_str(),
+    std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file)
+    {
+    vtkWarningMacro("Cannot write the program binary " << tmpName.str());
+    return;
+    }
+  unsigned int length = static_cast<unsigned int>(binary.size());
+  file.write(vtkProgramBinaryMagic, sizeof(vtkProgramBinaryMagic));
+  file.write(reinterpret_cast<const char *>(&format), sizeof(format));
+  file.write(reinterpret_cast<const char *>(&length), sizeof(length));
+  file.write(&binary[0], length);
+  file.close();
+  if (!file)
+    {
+    vtksys::SystemTools::RemoveFile(tmpName.str());
+    return;
+    }
+#ifdef _WIN32
+  // rename does not replace an existing file there
+  vtksys::SystemTools::RemoveFile(fileName);
+#endif
+  if (rename(tmpName.str().c_str(), fileName.c_str()) != 0)
+    {
+    vtksys::SystemTools::RemoveFile(tmpName.str());
+    return;
+    }
+  this->NumberOfSavedBinaries++;
+}
+
 // ----------------------------------------------------------------------------
 void vtkOpenGLShaderCache::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "BinaryCacheDirectory: "
+     << (this->BinaryCacheDirectory ? this->BinaryCacheDirectory : "(none)")
+     << "\n";
+  os << indent << "NumberOfLoadedBinaries: "
+     << this->NumberOfLoadedBinaries << "\n";
+  os << indent << "NumberOfSavedBinaries: "
+     << this->NumberOfSavedBinaries << "\n";
 }
@@ -15,6 +15,10 @@
 // .NAME vtkOpenGLShaderCache - manage Shader Programs within a context
 // .SECTION Description
 // vtkOpenGLShaderCache manages shader program compilation and binding
+//
+// The programs can also be kept on disk between processes: when a
+// BinaryCacheDirectory is set, the binary of every linked program is saved
+// there and later loaded instead of compiling the shaders again.
 
 #ifndef vtkOpenGLShaderCache_h
 #define vtkOpenGLShaderCache_h
@@ -69,6 +73,22 @@ public:
   virtual void ClearLastShaderBound() { this->LastShaderBound = NULL; }
   vtkGetObjectMacro(LastShaderBound, vtkShaderProgram);
 
+  // Description:
+  // Directory of the program binaries. A binary is found by the hash of
+  // the shader sources and by the vendor, renderer and version of the
+  // OpenGL driver. A binary that the driver rejects is replaced by a newly
+  // compiled one. Programs capturing a transform feedback are not cached.
+  // This needs OpenGL 4.1, GL_ARB_get_program_binary or OpenGL ES 3.
+  // Initial value is the VTK_SHADER_CACHE_DIRECTORY environment variable,
+  // or NULL (no binaries) when it is not set.
+  vtkSetStringMacro(BinaryCacheDirectory);
+  vtkGetStringMacro(BinaryCacheDirectory);
+
+  // Description:
+  // Number of programs loaded from and saved to BinaryCacheDirectory.
+  vtkGetMacro(NumberOfLoadedBinaries, int);
+  vtkGetMacro(NumberOfSavedBinaries, int);
+
 protected:
   vtkOpenGLShaderCache();
   ~vtkOpenGLShaderCache();
@@ -87,10 +107,25 @@ protected:
     std::map<vtkShader::Type,vtkShader *> shaders);
   virtual int BindShader(vtkShaderProgram* shader);
 
+  // Description:
+  // Link a program from its binary in BinaryCacheDirectory, or save the
+  // binary of a linked program there. LoadProgramBinary returns false when
+  // the program must be compiled.
+  bool LoadProgramBinary(vtkShaderProgram *shader);
+  void SaveProgramBinary(vtkShaderProgram *shader);
+
+  // Description:
+  // Path of the binary of a program, empty when it cannot be cached.
+  std::string GetProgramBinaryFileName(vtkShaderProgram *shader);
+
   class Private;
   Private *Internal;
   vtkShaderProgram *LastShaderBound;
 
+  char *BinaryCacheDirectory;
+  int NumberOfLoadedBinaries;
+  int NumberOfSavedBinaries;
+
 private:
   vtkOpenGLShaderCache(const vtkOpenGLShaderCache&);  // Not implemented.
   void operator=(const vtkOpenGLShaderCache&);  // Not implemented.
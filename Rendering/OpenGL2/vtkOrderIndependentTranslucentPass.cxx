@@ -0,0 +1,404 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkOrderIndependentTranslucentPass.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkOrderIndependentTranslucentPass.h"
+#include "vtkFrameBufferObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkObjectFactory.h"
+#include "vtkOpenGLError.h"
+#include "vtkOpenGLHelper.h"
+#include "vtkOpenGLRenderWindow.h"
+#include "vtkOpenGLShaderCache.h"
+#include "vtkProp.h"
+#include "vtkRenderState.h"
+#include "vtkRenderer.h"
+#include "vtkShaderProgram.h"
+#include "vtkTextureObject.h"
+#include <cassert>
+
+// the 2D blending shaders we use
+#include "vtkOrderIndependentTranslucentPassFinalFS.h"
+#include "vtkTextureObjectVS.h"
+
+vtkStandardNewMacro(vtkOrderIndependentTranslucentPass);
+vtkCxxSetObjectMacro(vtkOrderIndependentTranslucentPass,TranslucentPass,
+  vtkRenderPass);
+
+vtkInformationKeyMacro(vtkOrderIndependentTranslucentPass,WeightedBlending,
+  Integer);
+
+// ----------------------------------------------------------------------------
+vtkOrderIndependentTranslucentPass::vtkOrderIndependentTranslucentPass()
+{
+  this->TranslucentPass = 0;
+
+  this->ViewportX = 0;
+  this->ViewportY = 0;
+  this->ViewportWidth = 100;
+  this->ViewportHeight = 100;
+
+  this->FrameBuffer = 0;
+  this->AccumulationTexture = 0;
+  this->WeightTexture = 0;
+  this->ZTexture = 0;
+  this->FinalBlendProgram = 0;
+}
+
+// ----------------------------------------------------------------------------
+vtkOrderIndependentTranslucentPass::~vtkOrderIndependentTranslucentPass()
+{
+  if (this->TranslucentPass != 0)
+    {
+    this->TranslucentPass->Delete();
+    }
+  if (this->FrameBuffer != 0)
+    {
+    this->FrameBuffer->Delete();
+    }
+  if (this->AccumulationTexture != 0)
+    {
+    this->AccumulationTexture->Delete();
+    }
+  if (this->WeightTexture != 0)
+    {
+    this->WeightTexture->Delete();
+    }
+  if (this->ZTexture != 0)
+    {
+    this->ZTexture->Delete();
+    }
+  delete this->FinalBlendProgram;
+}
+
+// ----------------------------------------------------------------------------
+// Description:
+// Release graphics resources and ask components to release their own
+// resources.
+// \pre w_exists: w!=0
+void vtkOrderIndependentTranslucentPass::ReleaseGraphicsResources(
+  vtkWindow *w)
+{
+  assert("pre: w_exists" && w!=0);
+
+  if (this->FinalBlendProgram != 0)
+    {
+    this->FinalBlendProgram->ReleaseGraphicsResources(w);
+    delete this->FinalBlendProgram;
+    this->FinalBlendProgram = 0;
+    }
+  if (this->TranslucentPass)
+    {
+    this->TranslucentPass->ReleaseGraphicsResources(w);
+    }
+  if (this->FrameBuffer != 0)
+    {
+    this->FrameBuffer->Delete();
+    this->FrameBuffer = 0;
+    }
+  if (this->AccumulationTexture != 0)
+    {
+    this->AccumulationTexture->Delete();
+    this->AccumulationTexture = 0;
+    }
+  if (this->WeightTexture != 0)
+    {
+    this->WeightTexture->Delete();
+    this->WeightTexture = 0;
+    }
+  if (this->ZTexture != 0)
+    {
+    this->ZTexture->Delete();
+    this->ZTexture = 0;
+    }
+}
+
+// ----------------------------------------------------------------------------
+void vtkOrderIndependentTranslucentPass::PrintSelf(ostream& os,
+                                                   vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "TranslucentPass:";
+  if (this->TranslucentPass != 0)
+    {
+    this->TranslucentPass->PrintSelf(os,indent);
+    }
+  else
+    {
+    os << "(none)" << endl;
+    }
+}
+
+namespace
+{
+vtkTextureObject *vtkOrderIndependentTranslucentPassCreateTexture(
+  vtkOpenGLRenderWindow *context, int width, int height, int numComponents)
+{
+  vtkTextureObject *result = vtkTextureObject::New();
+  result->SetContext(context);
+  if (numComponents == 0)
+    {
+    result->AllocateDepth(width, height, vtkTextureObject::Float32);
+    }
+  else
+    {
+    // the sums of the weights go beyond 1, so the colors are not clamped
+    result->Allocate2D(width, height, numComponents, VTK_FLOAT);
+    }
+  result->SetMinificationFilter(vtkTextureObject::Nearest);
+  result->SetMagnificationFilter(vtkTextureObject::Nearest);
+  result->SetWrapS(vtkTextureObject::ClampToEdge);
+  result->SetWrapT(vtkTextureObject::ClampToEdge);
+  return result;
+}
+}
+
+// ----------------------------------------------------------------------------
+void vtkOrderIndependentTranslucentPass::BlendFinal(
+  vtkOpenGLRenderWindow *renWin)
+{
+  if (!this->FinalBlendProgram)
+    {
+    this->FinalBlendProgram = new vtkOpenGLHelper;
+    std::string VSSource = vtkTextureObjectVS;
+    std::string FSSource = vtkOrderIndependentTranslucentPassFinalFS;
+    std::string GSSource;
+    this->FinalBlendProgram->Program =
+      renWin->GetShaderCache()->ReadyShaderProgram(
+        VSSource.c_str(),
+        FSSource.c_str(),
+        GSSource.c_str());
+    }
+  else
+    {
+    renWin->GetShaderCache()->ReadyShaderProgram(
+      this->FinalBlendProgram->Program);
+    }
+
+  this->AccumulationTexture->Activate();
+  this->FinalBlendProgram->Program->SetUniformi(
+    "accumulationTexture", this->AccumulationTexture->GetTextureUnit());
+  this->WeightTexture->Activate();
+  this->FinalBlendProgram->Program->SetUniformi(
+    "weightTexture", this->WeightTexture->GetTextureUnit());
+
+  // the shader returns the transparency of the translucent geometry as
+  // alpha, the usual blending then applies
+  glDisable(GL_DEPTH_TEST);
+  glEnable(GL_BLEND);
+  this->AccumulationTexture->CopyToFrameBuffer(0, 0,
+    this->ViewportWidth-1, this->ViewportHeight-1,
+    0, 0, this->ViewportWidth, this->ViewportHeight,
+    this->FinalBlendProgram->Program,
+    this->FinalBlendProgram->VAO);
+  glEnable(GL_DEPTH_TEST);
+
+  this->WeightTexture->Deactivate();
+  this->AccumulationTexture->Deactivate();
+}
+
+// ----------------------------------------------------------------------------
+// Description:
+// Perform rendering according to a render state \p s.
+// \pre s_exists: s!=0
+void vtkOrderIndependentTranslucentPass::Render(const vtkRenderState *s)
+{
+  assert("pre: s_exists" && s!=0);
+
+  this->NumberOfRenderedProps = 0;
+
+  if (this->TranslucentPass == 0)
+    {
+    vtkWarningMacro(<<"No TranslucentPass delegate set. Nothing can be rendered.");
+    return;
+    }
+
+  // Any prop to render?
+  bool hasTranslucentPolygonalGeometry = false;
+  int i = 0;
+  while (!hasTranslucentPolygonalGeometry && i < s->GetPropArrayCount())
+    {
+    hasTranslucentPolygonalGeometry =
+      s->GetPropArray()[i]->HasTranslucentPolygonalGeometry() == 1;
+    ++i;
+    }
+  if (!hasTranslucentPolygonalGeometry)
+    {
+    return; // nothing to render.
+    }
+
+  vtkRenderer *r = s->GetRenderer();
+  vtkOpenGLRenderWindow *renWin =
+    vtkOpenGLRenderWindow::SafeDownCast(r->GetRenderWindow());
+
+#if GL_ES_VERSION_2_0 != 1 || GL_ES_VERSION_3_0 == 1
+  // float textures to accumulate, two render targets
+  bool supported = renWin &&
+    vtkFrameBufferObject::IsSupported(renWin) &&
+    vtkTextureObject::IsSupported(renWin, true, true, false);
+  if (supported)
+    {
+    vtkFrameBufferObject *fbo = vtkFrameBufferObject::New();
+    fbo->SetContext(renWin);
+    supported = fbo->GetMaximumNumberOfRenderTargets() >= 2;
+    fbo->Delete();
+    }
+#else
+  bool supported = false;
+#endif
+  if (!supported)
+    {
+    // just use alpha blending
+    this->TranslucentPass->Render(s);
+    this->NumberOfRenderedProps =
+      this->TranslucentPass->GetNumberOfRenderedProps();
+    return;
+    }
+
+#if GL_ES_VERSION_2_0 != 1 || GL_ES_VERSION_3_0 == 1
+  if (s->GetFrameBuffer() == 0)
+    {
+    // get the viewport dimensions
+    r->GetTiledSizeAndOrigin(&this->ViewportWidth,&this->ViewportHeight,
+                             &this->ViewportX,&this->ViewportY);
+    }
+  else
+    {
+    int size[2];
+    s->GetWindowSize(size);
+    this->ViewportWidth = size[0];
+    this->ViewportHeight = size[1];
+    this->ViewportX = 0;
+    this->ViewportY = 0;
+    }
+
+  // has the size changed?
+  if (this->AccumulationTexture && (
+      this->AccumulationTexture->GetWidth() != static_cast<unsigned int>(this->ViewportWidth) ||
+      this->AccumulationTexture->GetHeight() != static_cast<unsigned int>(this->ViewportHeight)))
+    {
+    this->AccumulationTexture->Delete();
+    this->AccumulationTexture = 0;
+    this->WeightTexture->Delete();
+    this->WeightTexture = 0;
+    this->ZTexture->Delete();
+    this->ZTexture = 0;
+    }
+
+  // create the buffers we need if not done already
+  if (this->FrameBuffer == 0)
+    {
+    this->FrameBuffer = vtkFrameBufferObject::New();
+    this->FrameBuffer->SetContext(renWin);
+    }
+  if (this->AccumulationTexture == 0)
+    {
+    this->AccumulationTexture = vtkOrderIndependentTranslucentPassCreateTexture(
+      renWin, this->ViewportWidth, this->ViewportHeight, 4);
+    this->WeightTexture = vtkOrderIndependentTranslucentPassCreateTexture(
+      renWin, this->ViewportWidth, this->ViewportHeight, 1);
+    this->ZTexture = vtkOrderIndependentTranslucentPassCreateTexture(
+      renWin, this->ViewportWidth, this->ViewportHeight, 0);
+    }
+
+  // the opaque geometry hides the translucent one behind it
+  this->ZTexture->CopyFromFrameBuffer(this->ViewportX, this->ViewportY,
+    0, 0, this->ViewportWidth, this->ViewportHeight);
+
+  this->FrameBuffer->SetNumberOfRenderTargets(2);
+  this->FrameBuffer->SetColorBuffer(0, this->AccumulationTexture);
+  this->FrameBuffer->SetColorBuffer(1, this->WeightTexture);
+  unsigned int indices[2] = { 0, 1 };
+  this->FrameBuffer->SetActiveBuffers(2, indices);
+  this->FrameBuffer->SetDepthBuffer(this->ZTexture);
+  this->FrameBuffer->StartNonOrtho(this->ViewportWidth, this->ViewportHeight,
+    false);
+
+  GLboolean scissorTest = glIsEnabled(GL_SCISSOR_TEST);
+  glViewport(0, 0, this->ViewportWidth, this->ViewportHeight);
+  glScissor(0, 0, this->ViewportWidth, this->ViewportHeight);
+  glEnable(GL_SCISSOR_TEST);
+
+  // no color, the alpha is the product of the transparencies
+  glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  glClearColor(0.0, 0.0, 0.0, 1.0);
+  glClear(GL_COLOR_BUFFER_BIT);
+
+#ifdef GL_MULTISAMPLE
+  GLboolean multiSampleStatus = glIsEnabled(GL_MULTISAMPLE);
+  glDisable(GL_MULTISAMPLE);
+#endif
+
+  // the fragments are summed in any order: the colors and the weights are
+  // added, the transparencies multiplied
+  glEnable(GL_DEPTH_TEST);
+  glDepthFunc(GL_LEQUAL);
+  glDepthMask(GL_FALSE);
+  glEnable(GL_BLEND);
+  glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+
+  // set the required keys on the props
+  int c = s->GetPropArrayCount();
+  for (i = 0; i < c; i++)
+    {
+    vtkProp *p = s->GetPropArray()[i];
+    vtkInformation *info = p->GetPropertyKeys();
+    if (!info)
+      {
+      info = vtkInformation::New();
+      p->SetPropertyKeys(info);
+      info->Delete();
+      }
+    info->Set(vtkOrderIndependentTranslucentPass::WeightedBlending(), 1);
+    }
+
+  this->TranslucentPass->Render(s);
+  this->NumberOfRenderedProps =
+    this->TranslucentPass->GetNumberOfRenderedProps();
+
+  for (i = 0; i < c; i++)
+    {
+    vtkProp *p = s->GetPropArray()[i];
+    p->GetPropertyKeys()->Remove(
+      vtkOrderIndependentTranslucentPass::WeightedBlending());
+    }
+
+  this->FrameBuffer->UnBind();
+
+  // restore the state of the render window
+  glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA,
+                      GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+  glDepthMask(GL_TRUE);
+  glViewport(this->ViewportX, this->ViewportY,
+             this->ViewportWidth, this->ViewportHeight);
+  glScissor(this->ViewportX, this->ViewportY,
+            this->ViewportWidth, this->ViewportHeight);
+  if (!scissorTest)
+    {
+    glDisable(GL_SCISSOR_TEST);
+    }
+#ifdef GL_MULTISAMPLE
+  if (multiSampleStatus)
+    {
+    glEnable(GL_MULTISAMPLE);
+    }
+#endif
+
+  this->BlendFinal(renWin);
+
+  vtkOpenGLCheckErrorMacro("failed after Render");
+#endif
+}
@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkOrderIndependentTranslucentPass.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkOrderIndependentTranslucentPass - Implement a weighted blended
+// Order Independent Transparency render pass.
+// .SECTION Description
+// Render the translucent polygonal geometry of a scene in a single pass,
+// without sorting polygons in the view direction.
+//
+// This pass expects an initialized depth buffer and color buffer, as
+// vtkDepthPeelingPass does. The translucent geometry is rendered once by
+// the delegate TranslucentPass in an offscreen buffer, where each fragment
+// is accumulated with a weight that decreases with its depth. The average
+// color is then blended over the opaque geometry.
+//
+// Unlike depth peeling, the result is an approximation: layers of close
+// depths and high opacities may not appear in the exact order. It suits
+// interactive renders, where depth peeling may be used for still renders.
+// The pass needs float textures and multiple render targets, otherwise it
+// renders with alpha blending.
+//
+// Its delegate is usually set to a vtkTranslucentPass. The pass may replace
+// the translucent pass of a vtkRenderStepsPass.
+//
+// See "Weighted Blended Order-Independent Transparency", McGuire and
+// Bavoil, Journal of Computer Graphics Techniques, 2013.
+//
+// .SECTION See Also
+// vtkRenderPass, vtkTranslucentPass, vtkDepthPeelingPass
+
+#ifndef vtkOrderIndependentTranslucentPass_h
+#define vtkOrderIndependentTranslucentPass_h
+
+#include "vtkRenderingOpenGL2Module.h" // For export macro
+#include "vtkRenderPass.h"
+
+class vtkFrameBufferObject;
+class vtkInformationIntegerKey;
+class vtkOpenGLHelper;
+class vtkOpenGLRenderWindow;
+class vtkTextureObject;
+
+class VTKRENDERINGOPENGL2_EXPORT vtkOrderIndependentTranslucentPass :
+  public vtkRenderPass
+{
+public:
+  static vtkOrderIndependentTranslucentPass *New();
+  vtkTypeMacro(vtkOrderIndependentTranslucentPass,vtkRenderPass);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  //BTX
+  // Description:
+  // Perform rendering according to a render state \p s.
+  // \pre s_exists: s!=0
+  virtual void Render(const vtkRenderState *s);
+  //ETX
+
+  // Description:
+  // Release graphics resources and ask components to release their own
+  // resources.
+  // \pre w_exists: w!=0
+  void ReleaseGraphicsResources(vtkWindow *w);
+
+  // Description:
+  // Delegate for rendering the translucent polygonal geometry.
+  // If it is NULL, nothing will be rendered and a warning will be emitted.
+  // It is usually set to a vtkTranslucentPass.
+  // Initial value is a NULL pointer.
+  vtkGetObjectMacro(TranslucentPass,vtkRenderPass);
+  virtual void SetTranslucentPass(vtkRenderPass *translucentPass);
+
+  // Description:
+  // Key set on the props while they are rendered by this pass. The mappers
+  // then write the weighted color of their fragments.
+  static vtkInformationIntegerKey *WeightedBlending();
+
+ protected:
+  // Description:
+  // Default constructor. TranslucentPass is set to NULL.
+  vtkOrderIndependentTranslucentPass();
+
+  // Description:
+  // Destructor.
+  virtual ~vtkOrderIndependentTranslucentPass();
+
+  // Description:
+  // Blend the average color of the accumulated fragments over the
+  // current frame buffer.
+  void BlendFinal(vtkOpenGLRenderWindow *renWin);
+
+  vtkRenderPass *TranslucentPass;
+
+  int ViewportX;
+  int ViewportY;
+  int ViewportWidth;
+  int ViewportHeight;
+
+  vtkFrameBufferObject *FrameBuffer;
+  // Sum of the weighted premultiplied colors, the alpha holds the product
+  // of the transparencies.
+  vtkTextureObject *AccumulationTexture;
+  // Sum of the weighted opacities.
+  vtkTextureObject *WeightTexture;
+  vtkTextureObject *ZTexture;
+  vtkOpenGLHelper *FinalBlendProgram;
+
+ private:
+  vtkOrderIndependentTranslucentPass(const vtkOrderIndependentTranslucentPass&);  // Not implemented.
+  void operator=(const vtkOrderIndependentTranslucentPass&);  // Not implemented.
+};
+
+#endif
@@ -430,6 +430,76 @@ int vtkShaderProgram::CompileShader()
   return 1;
 }
 
+bool vtkShaderProgram::GetBinary(unsigned int &format,
+                                 std::vector<char> &binary)
+{
+#if GL_ES_VERSION_2_0 != 1 || GL_ES_VERSION_3_0 == 1
+  if (!this->Linked || this->Handle == 0)
+    {
+    return false;
+    }
+  GLint length = 0;
+  glGetProgramiv(static_cast<GLuint>(this->Handle), GL_PROGRAM_BINARY_LENGTH,
+    &length);
+  if (length <= 0)
+    {
+    return false;
+    }
+  binary.resize(length);
+  GLenum binaryFormat = 0;
+  glGetProgramBinary(static_cast<GLuint>(this->Handle), length, &length,
+    &binaryFormat, &binary[0]);
+  if (length <= 0)
+    {
+    return false;
+    }
+  binary.resize(length);
+  format = binaryFormat;
+  return true;
+#else
+  (void)format;
+  (void)binary;
+  return false;
+#endif
+}
+
+bool vtkShaderProgram::LoadBinary(unsigned int format,
+                                  const std::vector<char> &binary)
+{
+#if GL_ES_VERSION_2_0 != 1 || GL_ES_VERSION_3_0 == 1
+  if (this->Handle != 0 || binary.empty())
+    {
+    return false;
+    }
+  GLuint handle_ = glCreateProgram();
+  if (handle_ == 0)
+    {
+    this->Error = "Could not create shader program.";
+    return false;
+    }
+  glProgramBinary(handle_, static_cast<GLenum>(format), &binary[0],
+    static_cast<GLsizei>(binary.size()));
+  GLint isLinked = 0;
+  glGetProgramiv(handle_, GL_LINK_STATUS, &isLinked);
+  if (isLinked == 0)
+    {
+    // the driver changed since the binary was saved
+    glDeleteProgram(handle_);
+    return false;
+    }
+  this->Handle = static_cast<int>(handle_);
+  this->UniformsUsed.clear();
+  this->Attributes.clear();
+  this->Linked = true;
+  this->Compiled = true;
+  return true;
+#else
+  (void)format;
+  (void)binary;
+  return false;
+#endif
+}
+
 void vtkShaderProgram::Release()
 {
   glUseProgram(0);
@@ -22,6 +22,7 @@
 
 #include <string> // For member variables.
 #include <map>    // For member variables.
+#include <vector> // For program binaries.
 
 class vtkMatrix3x3;
 class vtkMatrix4x4;
@@ -250,6 +251,17 @@ protected:
   /** Releases the shader program from the current context. */
   void Release();
 
+  // Description:
+  // Get the binary of the linked program and its format. Returns false
+  // when the driver provides none.
+  bool GetBinary(unsigned int &format, std::vector<char> &binary);
+
+  // Description:
+  // Link the program from a binary returned by GetBinary, instead of
+  // compiling its shaders. Returns false, leaving the program without
+  // handle, when the driver rejects the binary.
+  bool LoadBinary(unsigned int format, const std::vector<char> &binary);
+
   /************* end **************************************/
 
   vtkShader *VertexShader;
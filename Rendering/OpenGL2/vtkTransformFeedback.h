@@ -20,6 +20,8 @@
 // shader to be captured into a buffer for later processing. This is used in
 // VTK to capture vertex information during GL2PS export when using the OpenGL2
 // backend as a replacement for the deprecated OpenGL feedback buffer.
+// vtkOpenGLGlyph3DHelper also uses it to keep the glyphs that pass its GPU
+// culling in instance buffers.
 
 #ifndef vtkTransformFeedback_h
 #define vtkTransformFeedback_h
@@ -45,7 +47,9 @@ public:
   enum VaryingRole
     {
     Vertex_ClipCoordinate_F, // Projected XYZW
-    Color_RGBA_F
+    Color_RGBA_F,
+    Matrix4x4_F, // Column major 4x4 matrix
+    Matrix3x3_F  // Column major 3x3 matrix
     };
 
   struct VaryingMetaData
@@ -97,17 +101,14 @@ public:
   // Varyings and setting NumberOfVertices.
   size_t GetBufferSize() const;
 
-  /*
-   * GL_SEPARATE_ATTRIBS is not supported yet.
-   *
   // Description:
   // The bufferMode argument to glTransformFeedbackVaryings. Must be
   // GL_INTERLEAVED_ATTRIBS or GL_SEPARATE_ATTRIBS. Default is interleaved. Must
-  // be set prior to calling BindVaryings.
+  // be set prior to calling BindVaryings. BindBuffer and ReadBuffer only
+  // handle interleaved varyings: with separate varyings, the caller binds one
+  // buffer per varying itself.
   vtkSetMacro(BufferMode, int)
   vtkGetMacro(BufferMode, int)
-  *
-  */
 
   // Description:
   // Call glTransformFeedbackVaryings(). Must be called after the shaders are
@@ -183,6 +184,10 @@ inline size_t vtkTransformFeedback::GetBytesPerVertex(
       return 4 * sizeof(float);
     case Color_RGBA_F:
       return 4 * sizeof(float);
+    case Matrix4x4_F:
+      return 16 * sizeof(float);
+    case Matrix3x3_F:
+      return 9 * sizeof(float);
     }
 
   vtkGenericWarningMacro("Unknown role enum value: " << role);
@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestRadixKCompositer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME TestRadixKCompositer.cxx -- Tests vtkRadixKCompositer.
+//
+// .SECTION Description
+//  Every process makes an image whose depths differ from those of the
+//  other processes, with some background pixels. The images are composited
+//  with several radices, with and without color, and the result on the root
+//  is compared to the nearest pixel of each process.
+
+#include "vtkMPIController.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkRadixKCompositer.h"
+#include "vtkUnsignedCharArray.h"
+
+namespace
+{
+const vtkIdType NumberOfPixels = 1001;
+
+//------------------------------------------------------------------------------
+float Depth(vtkIdType i, int rank, int numProcs)
+{
+  if ((i + rank) % 3 == 0)
+    {
+    return 1.0f;
+    }
+  return static_cast<float>(((i * 7 + rank * 5) % 97) * numProcs + rank + 1) /
+    static_cast<float>(97 * numProcs + 10);
+}
+
+//------------------------------------------------------------------------------
+void MakeImage(int rank, int numProcs, vtkUnsignedCharArray *p,
+               vtkFloatArray *z)
+{
+  z->SetNumberOfTuples(NumberOfPixels);
+  if (p)
+    {
+    p->SetNumberOfComponents(4);
+    p->SetNumberOfTuples(NumberOfPixels);
+    }
+  for (vtkIdType i = 0; i < NumberOfPixels; ++i)
+    {
+    float depth = Depth(i, rank, numProcs);
+    z->SetValue(i, depth);
+    if (p)
+      {
+      unsigned char *pixel = p->GetPointer(4 * i);
+      pixel[0] = depth < 1.0f ? static_cast<unsigned char>(rank) : 255;
+      pixel[1] = depth < 1.0f ? static_cast<unsigned char>(i % 256) : 255;
+      pixel[2] = 0;
+      pixel[3] = 255;
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+bool CheckImage(int numProcs, vtkUnsignedCharArray *p, vtkFloatArray *z)
+{
+  for (vtkIdType i = 0; i < NumberOfPixels; ++i)
+    {
+    int nearest = 0;
+    float depth = Depth(i, 0, numProcs);
+    for (int rank = 1; rank < numProcs; ++rank)
+      {
+      if (Depth(i, rank, numProcs) < depth)
+        {
+        depth = Depth(i, rank, numProcs);
+        nearest = rank;
+        }
+      }
+    if (z->GetValue(i) != depth)
+      {
+      cerr << "Wrong depth " << z->GetValue(i) << " at pixel " << i
+           << " instead of " << depth << endl;
+      return false;
+      }
+    if (p)
+      {
+      unsigned char *pixel = p->GetPointer(4 * i);
+      bool background = (depth == 1.0f);
+      if (pixel[0] != (background ? 255 : nearest) ||
+          pixel[1] != (background ? 255 : i % 256))
+        {
+        cerr << "Wrong color at pixel " << i << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestRadixKCompositer(int argc, char *argv[])
+{
+  vtkMPIController *controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv, 0);
+
+  int numProcs = controller->GetNumberOfProcesses();
+  int rank = controller->GetLocalProcessId();
+
+  vtkNew<vtkRadixKCompositer> compositer;
+  compositer->SetController(controller);
+
+  int retVal = 1;
+  const int radices[] = { 2, 4, 8 };
+  for (int r = 0; r < 3; ++r)
+    {
+    compositer->SetRadix(radices[r]);
+    for (int withColor = 0; withColor < 2; ++withColor)
+      {
+      vtkNew<vtkUnsignedCharArray> p;
+      vtkNew<vtkFloatArray> z;
+      vtkUnsignedCharArray *color = withColor ? p.GetPointer() : NULL;
+      MakeImage(rank, numProcs, color, z.GetPointer());
+      compositer->CompositeBuffer(color, z.GetPointer(), NULL, NULL);
+      if (rank == 0 && !CheckImage(numProcs, color, z.GetPointer()))
+        {
+        cerr << "Compositing failed with a radix of " << radices[r]
+             << (withColor ? " and color" : "") << endl;
+        retVal = 0;
+        }
+      }
+    }
+
+  int allPassed = 0;
+  controller->AllReduce(&retVal, &allPassed, 1, vtkCommunicator::MIN_OP);
+
+  controller->Finalize();
+  controller->Delete();
+
+  return allPassed ? 0 : 1;
+}
@@ -16,6 +16,9 @@
 // .SECTION Description
 // vtkClientServerSynchronizedRenderers is a vtkSynchronizedRenderers subclass
 // designed to be used in 2 processes, client-server mode.
+// The images are sent through the vtkSocketCommunicator of the controller;
+// over slow links, set a compressor on that communicator to send them
+// compressed.
 
 #ifndef vtkClientServerSynchronizedRenderers_h
 #define vtkClientServerSynchronizedRenderers_h
@@ -32,6 +32,8 @@
 #include "vtkPixelBufferObject.h"
 #include "vtkImageExtractComponents.h"
 #include "vtkMultiProcessController.h"
+#include "vtkCompositer.h"
+#include "vtkFloatArray.h"
 #include <sstream>
 #include "vtkTimerLog.h"
 #include "vtkStdString.h"
@@ -64,11 +66,13 @@ extern const char *vtkCompositeZPassShader_fs;
 
 vtkStandardNewMacro(vtkCompositeZPass);
 vtkCxxSetObjectMacro(vtkCompositeZPass,Controller,vtkMultiProcessController);
+vtkCxxSetObjectMacro(vtkCompositeZPass,Compositer,vtkCompositer);
 
 // ----------------------------------------------------------------------------
 vtkCompositeZPass::vtkCompositeZPass()
 {
   this->Controller=0;
+  this->Compositer=0;
   this->PBO=0;
   this->ZTexture=0;
   this->Program=0;
@@ -83,6 +87,10 @@ vtkCompositeZPass::~vtkCompositeZPass()
     {
       this->Controller->Delete();
     }
+  if(this->Compositer!=0)
+    {
+    this->Compositer->Delete();
+    }
   if(this->PBO!=0)
     {
     vtkErrorMacro(<<"PixelBufferObject should have been deleted in ReleaseGraphicsResources().");
@@ -117,6 +125,16 @@ void vtkCompositeZPass::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << "(none)" <<endl;
     }
+
+  os << indent << "Compositer:";
+  if(this->Compositer!=0)
+    {
+    this->Compositer->PrintSelf(os,indent);
+    }
+  else
+    {
+    os << "(none)" <<endl;
+    }
 }
 
 // ----------------------------------------------------------------------------
@@ -229,6 +247,7 @@ void vtkCompositeZPass::Render(const vtkRenderState *s)
   if(this->RawZBufferSize<static_cast<size_t>(w*h))
     {
     delete[] this->RawZBuffer;
+    this->RawZBuffer=0;
     }
   if(this->RawZBuffer==0)
     {
@@ -263,7 +282,7 @@ void vtkCompositeZPass::Render(const vtkRenderState *s)
 #endif
 
 
-  if(me==0)
+  if(me==0 && this->Compositer==0)
     {
     // root
     // 1. for each satellite
@@ -628,7 +647,7 @@ void vtkCompositeZPass::Render(const vtkRenderState *s)
     }
   else
     {
-    // satellite
+    // satellite, or any process when there is a compositer
     // 1. send z-buffer
     // 2. receive final z-buffer and copy it
 
@@ -694,15 +713,30 @@ void vtkCompositeZPass::Render(const vtkRenderState *s)
 #endif
 
 
-    // client to root process
-    this->Controller->Send(this->RawZBuffer,
-                           static_cast<vtkIdType>(this->RawZBufferSize),0,
-                           VTK_COMPOSITE_Z_PASS_MESSAGE_GATHER);
+    if(this->Compositer!=0)
+      {
+      // the compositer leaves the final z-buffer on the root only.
+      vtkFloatArray *zBuffer=vtkFloatArray::New();
+      zBuffer->SetArray(this->RawZBuffer,static_cast<vtkIdType>(numTups),1);
+      this->Compositer->SetController(this->Controller);
+      this->Compositer->SetNumberOfProcesses(numProcs);
+      this->Compositer->CompositeBuffer(0,zBuffer,0,0);
+      zBuffer->Delete();
+      this->Controller->Broadcast(this->RawZBuffer,
+                                  static_cast<vtkIdType>(numTups),0);
+      }
+    else
+      {
+      // client to root process
+      this->Controller->Send(this->RawZBuffer,
+                             static_cast<vtkIdType>(this->RawZBufferSize),0,
+                             VTK_COMPOSITE_Z_PASS_MESSAGE_GATHER);
 
-    // receiving final z-buffer.
-    this->Controller->Receive(this->RawZBuffer,
-                              static_cast<vtkIdType>(this->RawZBufferSize),0,
-                              VTK_COMPOSITE_Z_PASS_MESSAGE_SCATTER);
+      // receiving final z-buffer.
+      this->Controller->Receive(this->RawZBuffer,
+                                static_cast<vtkIdType>(this->RawZBufferSize),0,
+                                VTK_COMPOSITE_Z_PASS_MESSAGE_SCATTER);
+      }
 
 
 #ifdef VTK_COMPOSITE_ZPASS_DEBUG
@@ -32,6 +32,7 @@
 #include "vtkRenderPass.h"
 
 class vtkMultiProcessController;
+class vtkCompositer;
 
 class vtkPixelBufferObject;
 class vtkTextureObject;
@@ -67,6 +68,16 @@ public:
   vtkGetObjectMacro(Controller,vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController *controller);
 
+  // Description:
+  // Compositer used to composite the depth buffers, such as a
+  // vtkRadixKCompositer. It must accept a NULL color buffer. Every process
+  // composites its piece of the depth buffer and process 0 broadcasts the
+  // result, instead of receiving each z-buffer in turn and sending back the
+  // composited one.
+  // Initial value is a NULL pointer: process 0 composites on the GPU.
+  vtkGetObjectMacro(Compositer,vtkCompositer);
+  virtual void SetCompositer(vtkCompositer *compositer);
+
   // Description:
   // Is the pass supported by the OpenGL context?
   bool IsSupported(vtkOpenGLRenderWindow *context);
@@ -88,6 +99,7 @@ public:
   void CreateProgram(vtkOpenGLRenderWindow *context);
 
   vtkMultiProcessController *Controller;
+  vtkCompositer *Compositer;
 
   vtkPixelBufferObject *PBO;
   vtkTextureObject *ZTexture;
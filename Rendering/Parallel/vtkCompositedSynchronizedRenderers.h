@@ -35,6 +35,7 @@ public:
 
   // Description:
   // Get/Set the composite. vtkTreeCompositer is used by default.
+  // vtkRadixKCompositer scales better with many processes.
   void SetCompositer(vtkCompositer*);
   vtkGetObjectMacro(Compositer, vtkCompositer);
 
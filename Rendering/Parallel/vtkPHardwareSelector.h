@@ -60,6 +60,12 @@ protected:
   void StartRender();
   void EndRender();
 
+  // Description:
+  // The image compositing only gathers the color buffer of the window, not
+  // the color buffers of the single pass, so the passes are always rendered
+  // one by one.
+  virtual bool CaptureSinglePass() { return false; }
+
   bool ProcessIsRoot;
 
 private:
@@ -0,0 +1,480 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkRadixKCompositer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkRadixKCompositer.h"
+#include "vtkObjectFactory.h"
+#include "vtkDataArray.h"
+#include "vtkFloatArray.h"
+#include "vtkMultiProcessController.h"
+
+#include <vector>
+
+vtkStandardNewMacro(vtkRadixKCompositer);
+
+// Buffers holding the compressed pieces, kept between frames.
+class vtkRadixKCompositerInternals
+{
+public:
+  std::vector<float> Z;
+  std::vector<unsigned char> P;
+  std::vector<float> GatheredZ;
+  std::vector<unsigned char> GatheredP;
+};
+
+namespace
+{
+enum
+{
+  VTK_RADIXK_LENGTH_TAG = 301,
+  VTK_RADIXK_Z_TAG = 302,
+  VTK_RADIXK_P_TAG = 303
+};
+
+// A pixel of the color buffer, copied as a whole.
+template <int N>
+struct vtkRadixKPixel
+{
+  unsigned char Bytes[N];
+};
+
+// Runs of background are stored as a single pixel whose depth is the length
+// of the run, as in vtkCompressCompositer. Runs are kept short enough for
+// their length to be exact in a float.
+const vtkIdType VTK_RADIXK_MAX_RUN = 1 << 24;
+
+//-------------------------------------------------------------------------
+// Compress length pixels; p may be NULL for depth only. Return the length
+// of the compressed piece.
+template <class P>
+vtkIdType vtkRadixKCompress(const float *z, const P *p, vtkIdType length,
+                            float *zOut, P *pOut)
+{
+  vtkIdType out = 0;
+  vtkIdType i = 0;
+  while (i < length)
+    {
+    if (z[i] >= 1.0f)
+      {
+      vtkIdType first = i;
+      while (i < length && z[i] >= 1.0f && i - first < VTK_RADIXK_MAX_RUN)
+        {
+        ++i;
+        }
+      zOut[out] = static_cast<float>(i - first);
+      if (p)
+        {
+        pOut[out] = p[first];
+        }
+      }
+    else
+      {
+      zOut[out] = z[i];
+      if (p)
+        {
+        pOut[out] = p[i];
+        }
+      ++i;
+      }
+    ++out;
+    }
+  return out;
+}
+
+//-------------------------------------------------------------------------
+// Composite a compressed piece over the uncompressed one. Background runs
+// are skipped without looking at the local pixels.
+template <class P>
+void vtkRadixKMerge(const float *zIn, const P *pIn, vtkIdType lengthIn,
+                    float *z, P *p)
+{
+  vtkIdType k = 0;
+  for (vtkIdType i = 0; i < lengthIn; ++i)
+    {
+    if (zIn[i] > 1.0f)
+      {
+      k += static_cast<vtkIdType>(zIn[i]);
+      }
+    else
+      {
+      if (zIn[i] < z[k])
+        {
+        z[k] = zIn[i];
+        if (p)
+          {
+          p[k] = pIn[i];
+          }
+        }
+      ++k;
+      }
+    }
+}
+
+//-------------------------------------------------------------------------
+template <class P>
+void vtkRadixKUncompress(const float *zIn, const P *pIn, vtkIdType lengthIn,
+                         float *z, P *p)
+{
+  vtkIdType k = 0;
+  for (vtkIdType i = 0; i < lengthIn; ++i)
+    {
+    vtkIdType count = 1;
+    float depth = zIn[i];
+    if (depth > 1.0f)
+      {
+      count = static_cast<vtkIdType>(depth);
+      depth = 1.0f;
+      }
+    for (vtkIdType j = 0; j < count; ++j, ++k)
+      {
+      z[k] = depth;
+      if (p)
+        {
+        p[k] = pIn[i];
+        }
+      }
+    }
+}
+
+//-------------------------------------------------------------------------
+// Return the part of [start, end) kept by member part of a group.
+void vtkRadixKSplit(vtkIdType start, vtkIdType end, int part, int groupSize,
+                    vtkIdType &partStart, vtkIdType &partEnd)
+{
+  vtkIdType length = end - start;
+  partEnd = start + length * (part + 1) / groupSize;
+  partStart = start + length * part / groupSize;
+}
+
+//-------------------------------------------------------------------------
+int vtkRadixKGroupSize(int radix, int numSwap, int stride)
+{
+  int groupSize = numSwap / stride;
+  return groupSize < radix ? groupSize : radix;
+}
+
+//-------------------------------------------------------------------------
+// Return the piece of the image a process holds after the last round.
+void vtkRadixKPiece(int id, int numSwap, int radix, vtkIdType numPixels,
+                    vtkIdType &start, vtkIdType &end)
+{
+  start = 0;
+  end = numPixels;
+  for (int stride = 1; stride < numSwap;)
+    {
+    int groupSize = vtkRadixKGroupSize(radix, numSwap, stride);
+    vtkRadixKSplit(start, end, (id / stride) % groupSize, groupSize,
+                   start, end);
+    stride *= groupSize;
+    }
+}
+
+//-------------------------------------------------------------------------
+// Compress the piece [start, end) in the buffers of internals.
+template <class P>
+vtkIdType vtkRadixKCompressPiece(const float *z, const P *p,
+                                 vtkIdType start, vtkIdType end,
+                                 vtkRadixKCompositerInternals *internals)
+{
+  vtkIdType length = end - start;
+  internals->Z.resize(length > 0 ? length : 1);
+  internals->P.resize(p ? sizeof(P) * internals->Z.size() : 1);
+  return vtkRadixKCompress(z + start, p ? p + start : 0, length,
+                           &internals->Z[0],
+                           reinterpret_cast<P*>(&internals->P[0]));
+}
+
+//-------------------------------------------------------------------------
+template <class P>
+void vtkRadixKSend(vtkMultiProcessController *controller, int id,
+                   const float *z, const P *p,
+                   vtkIdType start, vtkIdType end,
+                   vtkRadixKCompositerInternals *internals)
+{
+  vtkIdType length = vtkRadixKCompressPiece(z, p, start, end, internals);
+  controller->Send(&length, 1, id, VTK_RADIXK_LENGTH_TAG);
+  if (length > 0)
+    {
+    controller->Send(&internals->Z[0], length, id, VTK_RADIXK_Z_TAG);
+    if (p)
+      {
+      controller->Send(&internals->P[0],
+                       static_cast<vtkIdType>(length * sizeof(P)), id,
+                       VTK_RADIXK_P_TAG);
+      }
+    }
+}
+
+//-------------------------------------------------------------------------
+// Receive a compressed piece and composite it over [start, end), or
+// overwrite [start, end) with it when merge is false.
+template <class P>
+void vtkRadixKReceive(vtkMultiProcessController *controller, int id,
+                      float *z, P *p, vtkIdType start, bool merge,
+                      vtkRadixKCompositerInternals *internals)
+{
+  vtkIdType length = 0;
+  controller->Receive(&length, 1, id, VTK_RADIXK_LENGTH_TAG);
+  if (length <= 0)
+    {
+    return;
+    }
+  internals->Z.resize(length);
+  controller->Receive(&internals->Z[0], length, id, VTK_RADIXK_Z_TAG);
+  P *pIn = 0;
+  if (p)
+    {
+    internals->P.resize(length * sizeof(P));
+    controller->Receive(&internals->P[0],
+                        static_cast<vtkIdType>(length * sizeof(P)), id,
+                        VTK_RADIXK_P_TAG);
+    pIn = reinterpret_cast<P*>(&internals->P[0]);
+    }
+  if (merge)
+    {
+    vtkRadixKMerge(&internals->Z[0], pIn, length, z + start,
+                   p ? p + start : 0);
+    }
+  else
+    {
+    vtkRadixKUncompress(&internals->Z[0], pIn, length, z + start,
+                        p ? p + start : 0);
+    }
+}
+
+//-------------------------------------------------------------------------
+// Gather the pieces to process 0 with two gathers in flight at once.
+template <class P>
+void vtkRadixKGatherPieces(vtkMultiProcessController *controller,
+                           int numProcs, int numSwap, int radix,
+                           float *z, P *p, vtkIdType numPixels,
+                           vtkIdType start, vtkIdType end,
+                           vtkRadixKCompositerInternals *internals)
+{
+  int myId = controller->GetLocalProcessId();
+  vtkIdType length = 0;
+  if (myId < numSwap)
+    {
+    length = vtkRadixKCompressPiece(z, p, start, end, internals);
+    }
+  else
+    {
+    internals->Z.resize(1);
+    internals->P.resize(1);
+    }
+
+  std::vector<vtkIdType> lengths(numProcs, 0);
+  controller->Gather(&length, &lengths[0], 1, 0);
+
+  std::vector<vtkIdType> offsets(numProcs, 0);
+  std::vector<vtkIdType> byteLengths(numProcs, 0);
+  std::vector<vtkIdType> byteOffsets(numProcs, 0);
+  vtkIdType total = 0;
+  for (int i = 0; i < numProcs; ++i)
+    {
+    offsets[i] = total;
+    byteLengths[i] = static_cast<vtkIdType>(lengths[i] * sizeof(P));
+    byteOffsets[i] = static_cast<vtkIdType>(total * sizeof(P));
+    total += lengths[i];
+    }
+  internals->GatheredZ.resize(total > 0 ? total : 1);
+  internals->GatheredP.resize(p ? sizeof(P) * internals->GatheredZ.size() : 1);
+
+  vtkCommunicator::CollectiveRequest requests[2];
+  controller->IGatherV(&internals->Z[0], &internals->GatheredZ[0], length,
+                       &lengths[0], &offsets[0], 0, requests[0]);
+  if (p)
+    {
+    controller->IGatherV(&internals->P[0], &internals->GatheredP[0],
+                         static_cast<vtkIdType>(length * sizeof(P)),
+                         &byteLengths[0], &byteOffsets[0], 0, requests[1]);
+    }
+  vtkCommunicator::WaitAll(p ? 2 : 1, requests);
+
+  if (myId != 0)
+    {
+    return;
+    }
+  for (int id = 1; id < numSwap; ++id)
+    {
+    vtkIdType pieceStart, pieceEnd;
+    vtkRadixKPiece(id, numSwap, radix, numPixels, pieceStart, pieceEnd);
+    const P *pIn = p ? reinterpret_cast<const P*>(
+      &internals->GatheredP[byteOffsets[id]]) : 0;
+    vtkRadixKUncompress(&internals->GatheredZ[offsets[id]], pIn, lengths[id],
+                        z + pieceStart, p ? p + pieceStart : 0);
+    }
+}
+
+//-------------------------------------------------------------------------
+template <class P>
+void vtkRadixKComposite(vtkMultiProcessController *controller, int numProcs,
+                        int radix, float *z, P *p, vtkIdType numPixels,
+                        vtkRadixKCompositerInternals *internals)
+{
+  int myId = controller->GetLocalProcessId();
+  if (numProcs < 2 || myId >= numProcs)
+    {
+    return;
+    }
+  bool collective = (numProcs == controller->GetNumberOfProcesses());
+
+  // The processes beyond the largest power of two fold their image into a
+  // partner before the rounds.
+  int numSwap = 1;
+  while (2 * numSwap <= numProcs)
+    {
+    numSwap *= 2;
+    }
+  vtkIdType start = 0;
+  vtkIdType end = numPixels;
+  if (myId >= numSwap)
+    {
+    vtkRadixKSend(controller, myId - numSwap, z, p, 0, numPixels, internals);
+    if (collective)
+      {
+      vtkRadixKGatherPieces(controller, numProcs, numSwap, radix, z, p,
+                            numPixels, start, end, internals);
+      }
+    return;
+    }
+  if (myId + numSwap < numProcs)
+    {
+    vtkRadixKReceive(controller, myId + numSwap, z, p, 0, true, internals);
+    }
+
+  for (int stride = 1; stride < numSwap;)
+    {
+    int groupSize = vtkRadixKGroupSize(radix, numSwap, stride);
+    int part = (myId / stride) % groupSize;
+    int base = myId - part * stride;
+    vtkIdType partStart, partEnd;
+    vtkRadixKSplit(start, end, part, groupSize, partStart, partEnd);
+
+    // Members exchange in pairs, the lower one sending first, so the
+    // blocking sends can not deadlock.
+    for (int d = 1; d < groupSize; ++d)
+      {
+      int other = part ^ d;
+      int id = base + other * stride;
+      vtkIdType otherStart, otherEnd;
+      vtkRadixKSplit(start, end, other, groupSize, otherStart, otherEnd);
+      if (part < other)
+        {
+        vtkRadixKSend(controller, id, z, p, otherStart, otherEnd, internals);
+        vtkRadixKReceive(controller, id, z, p, partStart, true, internals);
+        }
+      else
+        {
+        vtkRadixKReceive(controller, id, z, p, partStart, true, internals);
+        vtkRadixKSend(controller, id, z, p, otherStart, otherEnd, internals);
+        }
+      }
+    start = partStart;
+    end = partEnd;
+    stride *= groupSize;
+    }
+
+  if (collective)
+    {
+    vtkRadixKGatherPieces(controller, numProcs, numSwap, radix, z, p,
+                          numPixels, start, end, internals);
+    }
+  else if (myId == 0)
+    {
+    for (int id = 1; id < numSwap; ++id)
+      {
+      vtkIdType pieceStart, pieceEnd;
+      vtkRadixKPiece(id, numSwap, radix, numPixels, pieceStart, pieceEnd);
+      vtkRadixKReceive(controller, id, z, p, pieceStart, false, internals);
+      }
+    }
+  else
+    {
+    vtkRadixKSend(controller, 0, z, p, start, end, internals);
+    }
+}
+}
+
+//-------------------------------------------------------------------------
+vtkRadixKCompositer::vtkRadixKCompositer()
+{
+  this->Radix = 8;
+  this->Internals = new vtkRadixKCompositerInternals;
+}
+
+//-------------------------------------------------------------------------
+vtkRadixKCompositer::~vtkRadixKCompositer()
+{
+  delete this->Internals;
+}
+
+//-------------------------------------------------------------------------
+void vtkRadixKCompositer::CompositeBuffer(vtkDataArray *pBuf,
+                                          vtkFloatArray *zBuf,
+                                          vtkDataArray *vtkNotUsed(pTmp),
+                                          vtkFloatArray *vtkNotUsed(zTmp))
+{
+  if (!this->Controller)
+    {
+    vtkErrorMacro("A controller is required.");
+    return;
+    }
+
+  int radix = 2;
+  while (2 * radix <= this->Radix)
+    {
+    radix *= 2;
+    }
+  float *z = zBuf->GetPointer(0);
+  vtkIdType numPixels = zBuf->GetNumberOfTuples();
+
+  if (!pBuf)
+    {
+    vtkRadixKComposite(this->Controller, this->NumberOfProcesses, radix, z,
+                       static_cast<vtkRadixKPixel<1>*>(0), numPixels,
+                       this->Internals);
+    return;
+    }
+
+  void *p = pBuf->GetVoidPointer(0);
+  int pixelSize = pBuf->GetNumberOfComponents() * pBuf->GetDataTypeSize();
+  switch (pixelSize)
+    {
+    case 3:
+      vtkRadixKComposite(this->Controller, this->NumberOfProcesses, radix, z,
+                         static_cast<vtkRadixKPixel<3>*>(p), numPixels,
+                         this->Internals);
+      break;
+    case 4:
+      vtkRadixKComposite(this->Controller, this->NumberOfProcesses, radix, z,
+                         static_cast<vtkRadixKPixel<4>*>(p), numPixels,
+                         this->Internals);
+      break;
+    case 16:
+      vtkRadixKComposite(this->Controller, this->NumberOfProcesses, radix, z,
+                         static_cast<vtkRadixKPixel<16>*>(p), numPixels,
+                         this->Internals);
+      break;
+    default:
+      vtkErrorMacro("Pixels of " << pixelSize << " bytes are not supported.");
+    }
+}
+
+//-------------------------------------------------------------------------
+void vtkRadixKCompositer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Radix: " << this->Radix << endl;
+}
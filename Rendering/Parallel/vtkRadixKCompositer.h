@@ -0,0 +1,81 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkRadixKCompositer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkRadixKCompositer - Implements radix-k (binary-swap) compositing.
+//
+// .SECTION Description
+// vtkRadixKCompositer splits the image among the processes instead of
+// sending whole images up a tree. In each round, the processes are grouped
+// by Radix; each member of a group keeps one part of its current piece of
+// the image and exchanges the other parts with the other members, so every
+// process composites a smaller piece in each round. With a Radix of 2 it
+// is binary-swap compositing. When the number of processes is not a power
+// of two, the extra processes first send their image to a partner.
+//
+// Pieces are run length encoded in transit, as vtkCompressCompositer does,
+// so only the pixels covered by geometry are exchanged. At the end, the
+// pieces are gathered to process 0, with a collective gather when all the
+// processes of the controller composite.
+//
+// Like the other compositers, it plugs into
+// vtkCompositedSynchronizedRenderers and vtkCompositeRenderManager with
+// SetCompositer(). The color buffer may be NULL to composite depth only,
+// which is how vtkCompositeZPass uses it. It will not handle transparency.
+//
+// .SECTION See Also
+// vtkCompositer vtkCompressCompositer vtkTreeCompositer
+
+#ifndef vtkRadixKCompositer_h
+#define vtkRadixKCompositer_h
+
+#include "vtkRenderingParallelModule.h" // For export macro
+#include "vtkCompositer.h"
+
+class vtkRadixKCompositerInternals;
+
+class VTKRENDERINGPARALLEL_EXPORT vtkRadixKCompositer : public vtkCompositer
+{
+public:
+  static vtkRadixKCompositer *New();
+  vtkTypeMacro(vtkRadixKCompositer,vtkCompositer);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // The final image gets put into pBuf and zBuf of process 0. pBuf may be
+  // NULL to composite depth only; otherwise it must have unsigned char RGB
+  // or RGBA pixels, or float RGBA pixels. pTmp and zTmp are not used.
+  virtual void CompositeBuffer(vtkDataArray *pBuf, vtkFloatArray *zBuf,
+                               vtkDataArray *pTmp, vtkFloatArray *zTmp);
+
+  // Description:
+  // The largest number of processes exchanging pieces of the image in a
+  // round. It is rounded down to a power of two: 2 is binary-swap, larger
+  // values take fewer rounds of more messages. Initial value is 8.
+  vtkSetClampMacro(Radix, int, 2, 256);
+  vtkGetMacro(Radix, int);
+
+protected:
+  vtkRadixKCompositer();
+  ~vtkRadixKCompositer();
+
+  int Radix;
+
+  vtkRadixKCompositerInternals *Internals;
+
+private:
+  vtkRadixKCompositer(const vtkRadixKCompositer&); // Not implemented
+  void operator=(const vtkRadixKCompositer&); // Not implemented
+};
+
+#endif
@@ -0,0 +1,143 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGPURayCastEmptySpaceSkipping.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test covers the empty space skipping of the GPU volume mapper. The
+// head, where the air is transparent, must look the same with and without
+// skipping, also after the opacity function moved the transparent range.
+
+#include "vtkCamera.h"
+#include "vtkColorTransferFunction.h"
+#include "vtkNew.h"
+#include "vtkOpenGLGPUVolumeRayCastMapper.h"
+#include "vtkPiecewiseFunction.h"
+#include "vtkRenderer.h"
+#include "vtkRenderWindow.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkVolume.h"
+#include "vtkVolume16Reader.h"
+#include "vtkVolumeProperty.h"
+
+#include <cstdlib>
+
+namespace
+{
+
+void GetPixels(vtkRenderWindow *renWin, vtkUnsignedCharArray *pixels)
+{
+  renWin->Render();
+  int *size = renWin->GetSize();
+  renWin->GetPixelData(0, 0, size[0] - 1, size[1] - 1, 1, pixels);
+}
+
+// The skipped steps are whole steps of the ray, only rounding may change
+// the color of a pixel.
+bool SamePixels(vtkUnsignedCharArray *expected, vtkUnsignedCharArray *pixels)
+{
+  if (expected->GetNumberOfTuples() != pixels->GetNumberOfTuples())
+    {
+    return false;
+    }
+  vtkIdType size =
+    expected->GetNumberOfTuples() * expected->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < size; ++i)
+    {
+    if (abs(expected->GetValue(i) - pixels->GetValue(i)) > 2)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+bool CompareSkipping(vtkRenderWindow *renWin,
+                     vtkOpenGLGPUVolumeRayCastMapper *mapper)
+{
+  vtkNew<vtkUnsignedCharArray> expected;
+  mapper->EmptySpaceSkippingOff();
+  GetPixels(renWin, expected.GetPointer());
+
+  vtkNew<vtkUnsignedCharArray> pixels;
+  mapper->EmptySpaceSkippingOn();
+  GetPixels(renWin, pixels.GetPointer());
+  return SamePixels(expected.GetPointer(), pixels.GetPointer());
+}
+
+}
+
+int TestGPURayCastEmptySpaceSkipping(int argc, char *argv[])
+{
+  char* fname =
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "Data/headsq/quarter");
+
+  vtkNew<vtkVolume16Reader> reader;
+  reader->SetDataDimensions(64, 64);
+  reader->SetDataByteOrderToLittleEndian();
+  reader->SetImageRange(1, 93);
+  reader->SetDataSpacing(3.2, 3.2, 1.5);
+  reader->SetFilePrefix(fname);
+  reader->SetDataMask(0x7fff);
+
+  delete[] fname;
+
+  vtkNew<vtkOpenGLGPUVolumeRayCastMapper> volumeMapper;
+  volumeMapper->SetInputConnection(reader->GetOutputPort());
+  volumeMapper->SetBlendModeToComposite();
+
+  vtkNew<vtkColorTransferFunction> colorFunction;
+  colorFunction->AddRGBPoint(900.0, 198/255.0, 134/255.0, 66/255.0);
+
+  vtkNew<vtkPiecewiseFunction> scalarOpacity;
+  scalarOpacity->AddPoint(0, 0.0);
+  scalarOpacity->AddPoint(449, 0.0);
+  scalarOpacity->AddPoint(900, 0.15);
+  scalarOpacity->AddPoint(4095, 0.5);
+
+  vtkNew<vtkVolumeProperty> volumeProperty;
+  volumeProperty->SetInterpolationType(VTK_LINEAR_INTERPOLATION);
+  volumeProperty->SetColor(colorFunction.GetPointer());
+  volumeProperty->SetScalarOpacity(scalarOpacity.GetPointer());
+
+  vtkNew<vtkVolume> volume;
+  volume->SetMapper(volumeMapper.GetPointer());
+  volume->SetProperty(volumeProperty.GetPointer());
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  vtkNew<vtkRenderer> ren;
+  renWin->AddRenderer(ren.GetPointer());
+  ren->AddVolume(volume.GetPointer());
+  ren->GetActiveCamera()->Azimuth(45.0);
+  ren->GetActiveCamera()->Elevation(30.0);
+  ren->ResetCamera();
+
+  if (!CompareSkipping(renWin.GetPointer(), volumeMapper.GetPointer()))
+    {
+    cerr << "The empty space skipping changed the image" << endl;
+    return EXIT_FAILURE;
+    }
+
+  scalarOpacity->RemoveAllPoints();
+  scalarOpacity->AddPoint(0, 0.0);
+  scalarOpacity->AddPoint(1400, 0.0);
+  scalarOpacity->AddPoint(4095, 0.8);
+  if (!CompareSkipping(renWin.GetPointer(), volumeMapper.GetPointer()))
+    {
+    cerr << "The empty space skipping changed the image after the opacity "
+         << "function changed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
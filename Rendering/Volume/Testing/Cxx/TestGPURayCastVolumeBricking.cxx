@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGPURayCastVolumeBricking.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test covers the rendering in bricks of the GPU volume mapper. The
+// memory given to the mapper holds less than half of the head, which must
+// look as when it is loaded whole. A fully transparent opacity function
+// must then leave every brick out.
+
+#include "vtkCamera.h"
+#include "vtkColorTransferFunction.h"
+#include "vtkNew.h"
+#include "vtkOpenGLGPUVolumeRayCastMapper.h"
+#include "vtkPiecewiseFunction.h"
+#include "vtkRenderer.h"
+#include "vtkRenderWindow.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkVolume.h"
+#include "vtkVolume16Reader.h"
+#include "vtkVolumeProperty.h"
+
+#include <cstdlib>
+
+namespace
+{
+
+void GetPixels(vtkRenderWindow *renWin, vtkUnsignedCharArray *pixels)
+{
+  renWin->Render();
+  int *size = renWin->GetSize();
+  renWin->GetPixelData(0, 0, size[0] - 1, size[1] - 1, 1, pixels);
+}
+
+// The rays restart their sampling at the faces of the bricks, compare the
+// images on average.
+bool SimilarPixels(vtkUnsignedCharArray *expected,
+                   vtkUnsignedCharArray *pixels)
+{
+  if (expected->GetNumberOfTuples() != pixels->GetNumberOfTuples())
+    {
+    return false;
+    }
+  vtkIdType size =
+    expected->GetNumberOfTuples() * expected->GetNumberOfComponents();
+  double difference = 0.0;
+  for (vtkIdType i = 0; i < size; ++i)
+    {
+    difference += abs(expected->GetValue(i) - pixels->GetValue(i));
+    }
+  return difference / size < 1.0;
+}
+
+}
+
+int TestGPURayCastVolumeBricking(int argc, char *argv[])
+{
+  char* fname =
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "Data/headsq/quarter");
+
+  vtkNew<vtkVolume16Reader> reader;
+  reader->SetDataDimensions(64, 64);
+  reader->SetDataByteOrderToLittleEndian();
+  reader->SetImageRange(1, 93);
+  reader->SetDataSpacing(3.2, 3.2, 1.5);
+  reader->SetFilePrefix(fname);
+  reader->SetDataMask(0x7fff);
+
+  delete[] fname;
+
+  vtkNew<vtkOpenGLGPUVolumeRayCastMapper> volumeMapper;
+  volumeMapper->SetInputConnection(reader->GetOutputPort());
+  volumeMapper->SetBlendModeToComposite();
+
+  vtkNew<vtkColorTransferFunction> colorFunction;
+  colorFunction->AddRGBPoint(900.0, 198/255.0, 134/255.0, 66/255.0);
+
+  vtkNew<vtkPiecewiseFunction> scalarOpacity;
+  scalarOpacity->AddPoint(0, 0.0);
+  scalarOpacity->AddPoint(449, 0.0);
+  scalarOpacity->AddPoint(900, 0.15);
+  scalarOpacity->AddPoint(4095, 0.5);
+
+  vtkNew<vtkVolumeProperty> volumeProperty;
+  volumeProperty->SetInterpolationType(VTK_LINEAR_INTERPOLATION);
+  volumeProperty->SetColor(colorFunction.GetPointer());
+  volumeProperty->SetScalarOpacity(scalarOpacity.GetPointer());
+
+  vtkNew<vtkVolume> volume;
+  volume->SetMapper(volumeMapper.GetPointer());
+  volume->SetProperty(volumeProperty.GetPointer());
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  vtkNew<vtkRenderer> ren;
+  renWin->AddRenderer(ren.GetPointer());
+  ren->AddVolume(volume.GetPointer());
+  ren->GetActiveCamera()->Azimuth(45.0);
+  ren->GetActiveCamera()->Elevation(30.0);
+  ren->ResetCamera();
+
+  vtkNew<vtkUnsignedCharArray> expected;
+  GetPixels(renWin.GetPointer(), expected.GetPointer());
+
+  // The head takes 762 kB as unsigned short, in 12 bricks
+  volumeMapper->SetMaxMemoryInBytes(300000);
+  volumeMapper->SetMaxMemoryFraction(1.0);
+  volumeMapper->SetBrickSize(33);
+  volumeMapper->VolumeBrickingOn();
+
+  vtkNew<vtkUnsignedCharArray> pixels;
+  GetPixels(renWin.GetPointer(), pixels.GetPointer());
+  if (volumeMapper->GetNumberOfRenderedBricks() < 2 ||
+      volumeMapper->GetNumberOfUploadedBricks() < 2)
+    {
+    cerr << "Rendered " << volumeMapper->GetNumberOfRenderedBricks()
+         << " bricks with " << volumeMapper->GetNumberOfUploadedBricks()
+         << " uploads" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!SimilarPixels(expected.GetPointer(), pixels.GetPointer()))
+    {
+    cerr << "The bricks changed the image" << endl;
+    return EXIT_FAILURE;
+    }
+
+  scalarOpacity->RemoveAllPoints();
+  scalarOpacity->AddPoint(0, 0.0);
+  scalarOpacity->AddPoint(4095, 0.0);
+  renWin->Render();
+  if (volumeMapper->GetNumberOfRenderedBricks() != 0)
+    {
+    cerr << "Rendered " << volumeMapper->GetNumberOfRenderedBricks()
+         << " transparent bricks" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -53,6 +53,8 @@ uniform vec4 in_volume_bias;
 
 //VTK::Termination::Dec
 
+//VTK::EmptySpace::Dec
+
 //VTK::Cropping::Dec
 
 //VTK::Shading::Dec
@@ -108,6 +110,8 @@ void main()
     {
     //VTK::Base::Impl
 
+    //VTK::EmptySpace::Impl
+
     //VTK::Cropping::Impl
 
     //VTK::Clipping::Impl
@@ -73,7 +73,10 @@
 #include "vtkWeakPointer.h"
 
 // C/C++ includes
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstring>
 #include <limits>
 #include <map>
 #include <sstream>
@@ -100,6 +103,7 @@ public:
     this->VolumeTextureObject = 0;
     this->NoiseTextureObject = 0;
     this->DepthTextureObject = 0;
+    this->BlockOccupancyTextureObject = 0;
     this->TextureWidth = 1024;
     this->ActualSampleDistance = 1.0;
     this->RGBTables = 0;
@@ -110,6 +114,17 @@ public:
     this->CurrentMask = 0;
     this->Dimensions[0] = this->Dimensions[1] = this->Dimensions[2] = -1;
     this->TextureSize[0] = this->TextureSize[1] = this->TextureSize[2] = -1;
+    this->NumberOfBlocks[0] = this->NumberOfBlocks[1] =
+      this->NumberOfBlocks[2] = 0;
+    this->BlockSize = 0;
+    this->UseBricks = false;
+    this->LastUseBricks = false;
+    this->BrickSize = 0;
+    this->VolumeFormat = 0;
+    this->VolumeType = 0;
+    this->VolumeInternalFormat = 0;
+    this->ResidentBrickMemory = 0;
+    this->BrickRenderCount = 0;
     this->WindowLowerLeft[0] = this->WindowLowerLeft[1] = 0;
     this->WindowSize[0] = this->WindowSize[1] = 0;
     this->ScalarsRange[0][0] = this->ScalarsRange[0][1] = 0.0;
@@ -163,6 +178,14 @@ public:
       this->DepthTextureObject = 0;
       }
 
+    if (this->BlockOccupancyTextureObject)
+      {
+      this->BlockOccupancyTextureObject->Delete();
+      this->BlockOccupancyTextureObject = 0;
+      }
+
+    this->DeleteBricks(0);
+
     if (this->RTTDepthBufferTextureObject)
       {
       this->RTTDepthBufferTextureObject->Delete();
@@ -254,6 +277,36 @@ public:
   // Update depth texture (used for early termination of the ray)
   void UpdateDepthTexture(vtkRenderer* ren, vtkVolume* vol);
 
+  // Test if the rays skip the transparent blocks of the volume
+  bool IsEmptySpaceSkipped(int noOfComponents);
+
+  // Compute the range of the scalars of each block of the volume
+  void ComputeBlockRanges(vtkDataArray* scalars);
+
+  // Update the texture of the blocks that are not fully transparent
+  void UpdateBlockOccupancy(vtkRenderer* ren);
+
+  // Test if the volume is rendered in bricks
+  bool IsVolumeBricked(vtkDataArray* scalars);
+
+  // Split the volume in bricks, none of them loaded yet
+  void BuildBricks(vtkImageData* input, vtkDataArray* scalars);
+
+  // Release the textures of the bricks and forget them. The window may be
+  // null when the context is gone.
+  void DeleteBricks(vtkWindow* window);
+
+  // Upload the scalars of a brick to a new texture
+  void LoadBrick(vtkRenderer* ren, vtkDataArray* scalars, int brick);
+
+  // Release the textures of the least recently used bricks until a brick of
+  // the given size fits in the memory of the mapper
+  void FreeBrickMemory(vtkWindow* window, vtkIdType size);
+
+  // Render the visible bricks back to front
+  void RenderBricks(vtkRenderer* ren, vtkVolume* vol, vtkImageData* input,
+                    vtkDataArray* scalars, vtkMatrix4x4* modelviewMatrix);
+
   // Update parameters for lighting that will be used in the shader.
   void UpdateLightingParameters(vtkRenderer* ren, vtkVolume* vol);
 
@@ -270,6 +323,13 @@ public:
   // Update clipping params to shader
   void UpdateClipping(vtkRenderer* ren, vtkVolume* vol);
 
+  // Update the shader parameters that depend on the loaded extents
+  void UpdateExtentsUniforms(vtkRenderer* ren, vtkVolume* vol,
+                             vtkMatrix4x4* modelviewMatrix);
+
+  // Draw the geometry of the loaded extents
+  void DrawVolumeGeometry();
+
   // Update the interval of sampling
   void UpdateSamplingDistance(vtkImageData *input,
                               vtkRenderer* ren, vtkVolume* vol);
@@ -305,6 +365,7 @@ public:
   vtkTextureObject* VolumeTextureObject;
   vtkTextureObject* NoiseTextureObject;
   vtkTextureObject* DepthTextureObject;
+  vtkTextureObject* BlockOccupancyTextureObject;
 
   int TextureWidth;
 
@@ -323,6 +384,38 @@ public:
   int WindowSize[2];
 
   double ScalarsRange[4][2];
+
+  // Normalized min and max of the scalars of each block, with the voxels
+  // around the block that the linear interpolation reaches
+  std::vector<float> BlockRanges;
+  int NumberOfBlocks[3];
+  int BlockSize;
+  vtkTimeStamp BlockRangesBuildTime;
+  vtkTimeStamp BlockOccupancyBuildTime;
+
+  // Part of the volume with its own texture, when the volume is rendered
+  // in bricks
+  struct Brick
+    {
+    int Extents[6];
+    double Bounds[6];
+    float Range[2];
+    vtkIdType MemorySize;
+    vtkTextureObject* TextureObject;
+    unsigned long LastRender;
+    unsigned long LastVisible;
+    };
+  std::vector<Brick> Bricks;
+  bool UseBricks;
+  bool LastUseBricks;
+  int BrickSize;
+  int WholeExtents[6];
+  GLenum VolumeFormat;
+  GLenum VolumeType;
+  GLint VolumeInternalFormat;
+  vtkIdType ResidentBrickMemory;
+  unsigned long BrickRenderCount;
+
   double LoadedBounds[6];
   int Extents[6];
   double DatasetStepSize[3];
@@ -560,6 +653,15 @@ bool vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::LoadVolume(
   this->VolumeTextureObject->SetContext(vtkOpenGLRenderWindow::SafeDownCast(
                                          ren->GetRenderWindow()));
 
+  // The bricks of the previous data are obsolete, and the whole volume
+  // is not loaded when rendering in bricks
+  this->DeleteBricks(ren->GetRenderWindow());
+  if (this->UseBricks)
+    {
+    this->VolumeTextureObject->ReleaseGraphicsResources(
+      ren->GetRenderWindow());
+    }
+
   int scalarType = scalars->GetDataType();
 
   // Get the default choices for format from the texture
@@ -754,6 +856,16 @@ bool vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::LoadVolume(
 
   this->UpdateInterpolationType(volumeProperty);
 
+  if (this->UseBricks)
+    {
+    // The bricks are uploaded when they are rendered
+    this->VolumeFormat = format;
+    this->VolumeType = type;
+    this->VolumeInternalFormat = internalFormat;
+    this->BuildBricks(imageData, scalars);
+    return 1;
+    }
+
   if (!this->HandleLargeDataTypes)
     {
     void* dataPtr = scalars->GetVoidPointer(0);
@@ -1032,12 +1144,26 @@ int vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::UpdateVolume(
 
     this->UpdateInterpolationType(volumeProperty);
 
-    if (interpolationType != this->InterpolationType)
+    if (interpolationType != this->InterpolationType && !this->UseBricks)
       {
       this->VolumeTextureObject->Activate();
       this->VolumeTextureObject->SetMagnificationFilter(this->InterpolationType);
       this->VolumeTextureObject->SetMinificationFilter(this->InterpolationType);
       }
+    else if (interpolationType != this->InterpolationType)
+      {
+      for (size_t b = 0; b < this->Bricks.size(); ++b)
+        {
+        vtkTextureObject* brickTexture = this->Bricks[b].TextureObject;
+        if (brickTexture)
+          {
+          brickTexture->Activate();
+          brickTexture->SetMagnificationFilter(this->InterpolationType);
+          brickTexture->SetMinificationFilter(this->InterpolationType);
+          brickTexture->Deactivate();
+          }
+        }
+      }
     }
   this->VolumeUpdateTime.Modified();
 
@@ -1382,6 +1508,602 @@ void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::UpdateDepthTexture(
 #endif
 }
 
+//----------------------------------------------------------------------------
+bool vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::IsEmptySpaceSkipped(
+  int noOfComponents)
+{
+  return this->Parent->EmptySpaceSkipping && noOfComponents == 1 &&
+    this->Parent->BlendMode == vtkVolumeMapper::COMPOSITE_BLEND &&
+    !this->UseBricks;
+}
+
+namespace
+{
+
+// Range of the normalized scalars of each block of \p blockSize voxels in
+// a volume of \p size voxels. A block also covers the voxels next to it, as
+// the samples near its faces interpolate them.
+template <typename T>
+void ComputeBlockRangesTemplate(const T* data, const int size[3],
+                                int blockSize, const int numberOfBlocks[3],
+                                double shift, double scale, float* ranges)
+{
+  // first and last block of each voxel, along each axis
+  std::vector<int> firstBlock[3];
+  std::vector<int> lastBlock[3];
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    firstBlock[axis].resize(size[axis]);
+    lastBlock[axis].resize(size[axis]);
+    for (int i = 0; i < size[axis]; ++i)
+      {
+      int first = i / blockSize - (i % blockSize == 0 ? 1 : 0);
+      int last = (i + 1) / blockSize;
+      firstBlock[axis][i] = first < 0 ? 0 : first;
+      lastBlock[axis][i] = last < numberOfBlocks[axis] ?
+        last : numberOfBlocks[axis] - 1;
+      }
+    }
+
+  vtkIdType numberOfBlockValues = 2 * static_cast<vtkIdType>(
+    numberOfBlocks[0]) * numberOfBlocks[1] * numberOfBlocks[2];
+  for (vtkIdType b = 0; b < numberOfBlockValues; b += 2)
+    {
+    ranges[b] = VTK_FLOAT_MAX;
+    ranges[b + 1] = -VTK_FLOAT_MAX;
+    }
+
+  for (int k = 0; k < size[2]; ++k)
+    {
+    for (int j = 0; j < size[1]; ++j)
+      {
+      for (int i = 0; i < size[0]; ++i, ++data)
+        {
+        float value = static_cast<float>(
+          (static_cast<double>(*data) - shift) * scale);
+        for (int bk = firstBlock[2][k]; bk <= lastBlock[2][k]; ++bk)
+          {
+          for (int bj = firstBlock[1][j]; bj <= lastBlock[1][j]; ++bj)
+            {
+            float* range = ranges + 2 * ((static_cast<vtkIdType>(bk) *
+              numberOfBlocks[1] + bj) * numberOfBlocks[0] +
+              firstBlock[0][i]);
+            for (int bi = firstBlock[0][i]; bi <= lastBlock[0][i];
+                 ++bi, range += 2)
+              {
+              range[0] = value < range[0] ? value : range[0];
+              range[1] = value > range[1] ? value : range[1];
+              }
+            }
+          }
+        }
+      }
+    }
+}
+
+// Size in bytes of a voxel of the texture of \p scalars, as 64 bit values
+// are converted to float.
+vtkIdType GetTexelSize(vtkDataArray* scalars)
+{
+  int size = scalars->GetDataTypeSize();
+  return scalars->GetNumberOfComponents() * (size < 4 ? size : 4);
+}
+
+// Number of nonzero entries of \p table before each entry, so that a range
+// of entries is tested at once.
+void CountVisibleEntries(const float* table, int tableWidth,
+                         std::vector<int>& visibleEntries)
+{
+  visibleEntries.assign(tableWidth + 1, 0);
+  for (int i = 0; i < tableWidth; ++i)
+    {
+    visibleEntries[i + 1] = visibleEntries[i] + (table[i] > 0.0f ? 1 : 0);
+    }
+}
+
+// Test if the table entries that the samples of a normalized range of
+// scalars interpolate are not all zero.
+bool IsRangeVisible(const std::vector<int>& visibleEntries,
+                    const float range[2])
+{
+  double tableWidth = static_cast<double>(visibleEntries.size() - 1);
+  double first = std::floor(range[0] * tableWidth - 0.5);
+  double last = std::ceil(range[1] * tableWidth - 0.5);
+  if (!(first <= last))
+    {
+    // NaN scalars
+    return true;
+    }
+  int firstEntry = static_cast<int>(
+    vtkMath::ClampValue(first, 0.0, tableWidth - 1.0));
+  int lastEntry = static_cast<int>(
+    vtkMath::ClampValue(last, 0.0, tableWidth - 1.0));
+  return visibleEntries[lastEntry + 1] > visibleEntries[firstEntry];
+}
+
+}
+
+//----------------------------------------------------------------------------
+void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::ComputeBlockRanges(
+  vtkDataArray* scalars)
+{
+  this->BlockSize = this->Parent->EmptySpaceBlockSize;
+  for (int i = 0; i < 3; ++i)
+    {
+    this->NumberOfBlocks[i] =
+      (this->TextureSize[i] + this->BlockSize - 1) / this->BlockSize;
+    }
+  this->BlockRanges.resize(2 * static_cast<size_t>(this->NumberOfBlocks[0]) *
+    this->NumberOfBlocks[1] * this->NumberOfBlocks[2]);
+  if (this->BlockRanges.empty())
+    {
+    return;
+    }
+
+  // same normalization as the lookup in the opacity table
+  double shift = this->ScalarsRange[0][0];
+  double width = this->ScalarsRange[0][1] - this->ScalarsRange[0][0];
+  double scale = width != 0.0 ? 1.0 / width : 0.0;
+
+  switch (scalars->GetDataType())
+    {
+    vtkTemplateMacro(
+      ComputeBlockRangesTemplate(
+        static_cast<VTK_TT*>(scalars->GetVoidPointer(0)), this->TextureSize,
+        this->BlockSize, this->NumberOfBlocks, shift, scale,
+        &this->BlockRanges[0]));
+    }
+  this->BlockRangesBuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::UpdateBlockOccupancy(
+  vtkRenderer* ren)
+{
+  vtkOpenGLVolumeOpacityTable* opacityTable = this->OpacityTables->GetTable(0);
+  const float* table = opacityTable->GetTable();
+  if (!table || this->BlockRanges.empty())
+    {
+    return;
+    }
+
+  if (!this->BlockOccupancyTextureObject)
+    {
+    this->BlockOccupancyTextureObject = vtkTextureObject::New();
+    }
+  this->BlockOccupancyTextureObject->SetContext(
+    vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow()));
+
+  if (this->BlockOccupancyTextureObject->GetHandle() &&
+      this->BlockOccupancyBuildTime > this->BlockRangesBuildTime &&
+      this->BlockOccupancyBuildTime.GetMTime() > opacityTable->GetBuildTime())
+    {
+    return;
+    }
+
+  std::vector<int> visibleEntries;
+  CountVisibleEntries(table, opacityTable->GetTextureWidth(), visibleEntries);
+
+  size_t numberOfBlocks = this->BlockRanges.size() / 2;
+  std::vector<unsigned char> occupancy(numberOfBlocks);
+  for (size_t b = 0; b < numberOfBlocks; ++b)
+    {
+    occupancy[b] =
+      IsRangeVisible(visibleEntries, &this->BlockRanges[2 * b]) ? 255 : 0;
+    }
+
+  this->BlockOccupancyTextureObject->Create3DFromRaw(
+    this->NumberOfBlocks[0],
+    this->NumberOfBlocks[1],
+    this->NumberOfBlocks[2],
+    1,
+    VTK_UNSIGNED_CHAR,
+    &occupancy[0]);
+  this->BlockOccupancyTextureObject->Activate();
+  this->BlockOccupancyTextureObject->SetWrapS(vtkTextureObject::ClampToEdge);
+  this->BlockOccupancyTextureObject->SetWrapT(vtkTextureObject::ClampToEdge);
+  this->BlockOccupancyTextureObject->SetWrapR(vtkTextureObject::ClampToEdge);
+  this->BlockOccupancyTextureObject->SetMagnificationFilter(
+    vtkTextureObject::Nearest);
+  this->BlockOccupancyTextureObject->SetMinificationFilter(
+    vtkTextureObject::Nearest);
+  this->BlockOccupancyTextureObject->Deactivate();
+  this->BlockOccupancyBuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::IsVolumeBricked(
+  vtkDataArray* scalars)
+{
+  if (!this->Parent->VolumeBricking || this->Parent->MaskInput ||
+      this->Parent->RenderToImage ||
+      this->Parent->BlendMode != vtkVolumeMapper::COMPOSITE_BLEND)
+    {
+    return false;
+    }
+
+  vtkIdType maxMemory = static_cast<vtkIdType>(static_cast<float>(
+    this->Parent->MaxMemoryInBytes) * this->Parent->MaxMemoryFraction);
+  return scalars->GetNumberOfTuples() * GetTexelSize(scalars) > maxMemory;
+}
+
+//----------------------------------------------------------------------------
+void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::BuildBricks(
+  vtkImageData* input, vtkDataArray* scalars)
+{
+  this->BrickSize = this->Parent->BrickSize;
+  for (int i = 0; i < 6; ++i)
+    {
+    this->WholeExtents[i] = this->Extents[i];
+    }
+
+  // Neighbor bricks share the points of their common face, while the cells
+  // are split between them
+  int cellFlag = this->Parent->CellFlag ? 1 : 0;
+  int step = this->BrickSize - 1 + cellFlag;
+  int numberOfBricks[3];
+  for (int i = 0; i < 3; ++i)
+    {
+    int intervals = this->TextureSize[i] - 1 + cellFlag;
+    numberOfBricks[i] = (intervals + step - 1) / step;
+    numberOfBricks[i] = numberOfBricks[i] < 1 ? 1 : numberOfBricks[i];
+    }
+
+  // The range of the scalars of a single component volume tells the bricks
+  // hidden by the opacity function
+  int noOfComponents = scalars->GetNumberOfComponents();
+  std::vector<float> ranges;
+  if (noOfComponents == 1)
+    {
+    ranges.resize(2 * static_cast<size_t>(numberOfBricks[0]) *
+      numberOfBricks[1] * numberOfBricks[2]);
+    double shift = this->ScalarsRange[0][0];
+    double width = this->ScalarsRange[0][1] - this->ScalarsRange[0][0];
+    double scale = width != 0.0 ? 1.0 / width : 0.0;
+    switch (scalars->GetDataType())
+      {
+      vtkTemplateMacro(
+        ComputeBlockRangesTemplate(
+          static_cast<VTK_TT*>(scalars->GetVoidPointer(0)), this->TextureSize,
+          step, numberOfBricks, shift, scale, &ranges[0]));
+      }
+    }
+
+  double origin[3];
+  input->GetOrigin(origin);
+  vtkIdType texelSize = GetTexelSize(scalars);
+
+  Brick brick;
+  brick.TextureObject = 0;
+  brick.LastRender = 0;
+  brick.LastVisible = 0;
+  int index[3];
+  for (index[2] = 0; index[2] < numberOfBricks[2]; ++index[2])
+    {
+    for (index[1] = 0; index[1] < numberOfBricks[1]; ++index[1])
+      {
+      for (index[0] = 0; index[0] < numberOfBricks[0]; ++index[0])
+        {
+        brick.MemorySize = texelSize;
+        for (int i = 0; i < 3; ++i)
+          {
+          int first = this->WholeExtents[2 * i] + index[i] * step;
+          int last = first + this->BrickSize - 1;
+          last = last < this->WholeExtents[2 * i + 1] ?
+            last : this->WholeExtents[2 * i + 1];
+          brick.Extents[2 * i] = first;
+          brick.Extents[2 * i + 1] = last;
+          brick.MemorySize *= last - first + 1;
+
+          double bound1 = origin[i] + first * this->CellSpacing[i];
+          double bound2 = origin[i] + (last + cellFlag) * this->CellSpacing[i];
+          brick.Bounds[2 * i] = bound1 < bound2 ? bound1 : bound2;
+          brick.Bounds[2 * i + 1] = bound1 < bound2 ? bound2 : bound1;
+          }
+
+        if (ranges.empty())
+          {
+          brick.Range[0] = 0.0f;
+          brick.Range[1] = 1.0f;
+          }
+        else
+          {
+          size_t b = this->Bricks.size();
+          brick.Range[0] = ranges[2 * b];
+          brick.Range[1] = ranges[2 * b + 1];
+          }
+        this->Bricks.push_back(brick);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::DeleteBricks(
+  vtkWindow* window)
+{
+  for (size_t b = 0; b < this->Bricks.size(); ++b)
+    {
+    if (this->Bricks[b].TextureObject)
+      {
+      if (window)
+        {
+        this->Bricks[b].TextureObject->ReleaseGraphicsResources(window);
+        }
+      this->Bricks[b].TextureObject->Delete();
+      }
+    }
+  this->Bricks.clear();
+  this->ResidentBrickMemory = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::LoadBrick(
+  vtkRenderer* ren, vtkDataArray* scalars, int index)
+{
+  Brick& brick = this->Bricks[index];
+  int size[3];
+  for (int i = 0; i < 3; ++i)
+    {
+    size[i] = brick.Extents[2 * i + 1] - brick.Extents[2 * i] + 1;
+    }
+  int noOfComponents = scalars->GetNumberOfComponents();
+
+  brick.TextureObject = vtkTextureObject::New();
+  brick.TextureObject->SetContext(vtkOpenGLRenderWindow::SafeDownCast(
+                                    ren->GetRenderWindow()));
+  brick.TextureObject->SetDataType(this->VolumeType);
+  brick.TextureObject->SetFormat(this->VolumeFormat);
+  brick.TextureObject->SetInternalFormat(this->VolumeInternalFormat);
+  brick.TextureObject->Create3DFromRaw(size[0], size[1], size[2],
+                                       noOfComponents, scalars->GetDataType(),
+                                       0);
+  brick.TextureObject->Activate();
+  brick.TextureObject->SetWrapS(vtkTextureObject::ClampToEdge);
+  brick.TextureObject->SetWrapT(vtkTextureObject::ClampToEdge);
+  brick.TextureObject->SetWrapR(vtkTextureObject::ClampToEdge);
+  brick.TextureObject->SetMagnificationFilter(this->InterpolationType);
+  brick.TextureObject->SetMinificationFilter(this->InterpolationType);
+  brick.TextureObject->SetBorderColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+  // The rows of the brick are not contiguous in the scalars, send them
+  // slice by slice
+  vtkIdType rowLength = this->WholeExtents[1] - this->WholeExtents[0] + 1;
+  vtkIdType sliceLength = rowLength *
+    (this->WholeExtents[3] - this->WholeExtents[2] + 1);
+  vtkIdType firstTuple =
+    (brick.Extents[4] - this->WholeExtents[4]) * sliceLength +
+    (brick.Extents[2] - this->WholeExtents[2]) * rowLength +
+    brick.Extents[0] - this->WholeExtents[0];
+  if (!this->HandleLargeDataTypes)
+    {
+    size_t tupleSize = scalars->GetDataTypeSize() * noOfComponents;
+    size_t brickRowSize = size[0] * tupleSize;
+    const char* data = static_cast<const char*>(scalars->GetVoidPointer(0));
+    std::vector<char> slice(brickRowSize * size[1]);
+    for (int k = 0; k < size[2]; ++k)
+      {
+      for (int j = 0; j < size[1]; ++j)
+        {
+        vtkIdType tuple = firstTuple + k * sliceLength + j * rowLength;
+        memcpy(&slice[j * brickRowSize], data + tuple * tupleSize,
+               brickRowSize);
+        }
+      glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, k, size[0], size[1], 1,
+                      this->VolumeFormat, this->VolumeType, &slice[0]);
+      }
+    }
+  else
+    {
+    std::vector<float> slice(
+      static_cast<size_t>(size[0]) * size[1] * noOfComponents);
+    for (int k = 0; k < size[2]; ++k)
+      {
+      float* value = &slice[0];
+      for (int j = 0; j < size[1]; ++j)
+        {
+        vtkIdType tuple = firstTuple + k * sliceLength + j * rowLength;
+        for (int i = 0; i < size[0]; ++i, ++tuple)
+          {
+          double* scalarPtr = scalars->GetTuple(tuple);
+          for (int n = 0; n < noOfComponents; ++n, ++value)
+            {
+            *value = static_cast<float>(
+              scalarPtr[n] * this->Scale[n] + this->Bias[n]);
+            }
+          }
+        }
+      glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, k, size[0], size[1], 1,
+                      this->VolumeFormat, this->VolumeType, &slice[0]);
+      }
+    }
+  brick.TextureObject->Deactivate();
+  this->ResidentBrickMemory += brick.MemorySize;
+}
+
+//----------------------------------------------------------------------------
+void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::FreeBrickMemory(
+  vtkWindow* window, vtkIdType size)
+{
+  vtkIdType maxMemory = static_cast<vtkIdType>(static_cast<float>(
+    this->Parent->MaxMemoryInBytes) * this->Parent->MaxMemoryFraction);
+  while (this->ResidentBrickMemory + size > maxMemory)
+    {
+    // Release the bricks out of the view first, then the bricks already
+    // drawn by this render, but not the visible bricks still to draw
+    int victim = -1;
+    bool victimDrawn = false;
+    for (size_t b = 0; b < this->Bricks.size(); ++b)
+      {
+      const Brick& brick = this->Bricks[b];
+      bool drawn = brick.LastRender == this->BrickRenderCount;
+      if (!brick.TextureObject ||
+          (!drawn && brick.LastVisible == this->BrickRenderCount))
+        {
+        continue;
+        }
+      if (victim < 0 || (victimDrawn && !drawn) ||
+          (drawn == victimDrawn &&
+           brick.LastRender < this->Bricks[victim].LastRender))
+        {
+        victim = static_cast<int>(b);
+        victimDrawn = drawn;
+        }
+      }
+    if (victim < 0)
+      {
+      // The brick does not fit at all, it still gets loaded alone
+      return;
+      }
+
+    Brick& brick = this->Bricks[victim];
+    brick.TextureObject->ReleaseGraphicsResources(window);
+    brick.TextureObject->Delete();
+    brick.TextureObject = 0;
+    this->ResidentBrickMemory -= brick.MemorySize;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::RenderBricks(
+  vtkRenderer* ren, vtkVolume* vol, vtkImageData* input,
+  vtkDataArray* scalars, vtkMatrix4x4* modelviewMatrix)
+{
+  ++this->BrickRenderCount;
+
+  vtkCamera* cam = ren->GetActiveCamera();
+  double planes[24];
+  cam->GetFrustumPlanes(ren->GetTiledAspectRatio(), planes);
+  double camPos[3];
+  double camDirection[3];
+  cam->GetPosition(camPos);
+  cam->GetDirectionOfProjection(camDirection);
+  vtkMatrix4x4* volumeMatrix = vol->GetMatrix();
+
+  std::vector<int> visibleEntries;
+  const float* table = 0;
+  if (scalars->GetNumberOfComponents() == 1)
+    {
+    vtkOpenGLVolumeOpacityTable* opacityTable =
+      this->OpacityTables->GetTable(0);
+    table = opacityTable->GetTable();
+    if (table)
+      {
+      CountVisibleEntries(table, opacityTable->GetTextureWidth(),
+                          visibleEntries);
+      }
+    }
+
+  // Keep the bricks in the view frustum that are not fully transparent,
+  // sorted by their distance to the camera
+  std::vector<std::pair<double, int> > order;
+  for (size_t b = 0; b < this->Bricks.size(); ++b)
+    {
+    Brick& brick = this->Bricks[b];
+    if (table && !IsRangeVisible(visibleEntries, brick.Range))
+      {
+      continue;
+      }
+
+    double corners[8][4];
+    double center[3] = {0.0, 0.0, 0.0};
+    for (int c = 0; c < 8; ++c)
+      {
+      double corner[4] = { brick.Bounds[c & 1],
+                           brick.Bounds[2 + ((c >> 1) & 1)],
+                           brick.Bounds[4 + ((c >> 2) & 1)], 1.0 };
+      volumeMatrix->MultiplyPoint(corner, corners[c]);
+      for (int i = 0; i < 3; ++i)
+        {
+        corners[c][i] /= corners[c][3];
+        center[i] += corners[c][i] / 8.0;
+        }
+      }
+
+    bool outside = false;
+    for (int p = 0; p < 6 && !outside; ++p)
+      {
+      outside = true;
+      for (int c = 0; c < 8 && outside; ++c)
+        {
+        outside = vtkMath::Dot(planes + 4 * p, corners[c]) +
+          planes[4 * p + 3] < 0.0;
+        }
+      }
+    if (outside)
+      {
+      continue;
+      }
+
+    double distance;
+    if (cam->GetParallelProjection())
+      {
+      double toCenter[3];
+      vtkMath::Subtract(center, camPos, toCenter);
+      distance = vtkMath::Dot(toCenter, camDirection);
+      }
+    else
+      {
+      distance = vtkMath::Distance2BetweenPoints(center, camPos);
+      }
+    order.push_back(std::make_pair(distance, static_cast<int>(b)));
+    brick.LastVisible = this->BrickRenderCount;
+    }
+  std::sort(order.rbegin(), order.rend());
+
+  double wholeBounds[6];
+  int wholeExtents[6];
+  int wholeSize[3];
+  std::copy(this->LoadedBounds, this->LoadedBounds + 6, wholeBounds);
+  std::copy(this->Extents, this->Extents + 6, wholeExtents);
+  std::copy(this->TextureSize, this->TextureSize + 3, wholeSize);
+
+  int uploadedBricks = 0;
+  for (size_t o = 0; o < order.size(); ++o)
+    {
+    int index = order[o].second;
+    if (!this->Bricks[index].TextureObject)
+      {
+      this->FreeBrickMemory(ren->GetRenderWindow(),
+                            this->Bricks[index].MemorySize);
+      this->LoadBrick(ren, scalars, index);
+      ++uploadedBricks;
+      }
+
+    Brick& brick = this->Bricks[index];
+    brick.LastRender = this->BrickRenderCount;
+    for (int i = 0; i < 3; ++i)
+      {
+      this->Extents[2 * i] = brick.Extents[2 * i];
+      this->Extents[2 * i + 1] = brick.Extents[2 * i + 1];
+      this->TextureSize[i] = brick.Extents[2 * i + 1] -
+        brick.Extents[2 * i] + 1;
+      this->LoadedBounds[2 * i] = brick.Bounds[2 * i];
+      this->LoadedBounds[2 * i + 1] = brick.Bounds[2 * i + 1];
+      }
+
+    // The geometry is computed with the inverse of the volume matrix, the
+    // shader already got the inverse of its transpose
+    this->InverseVolumeMat->DeepCopy(volumeMatrix);
+    this->InverseVolumeMat->Invert();
+    this->UpdateVolumeGeometry(ren, vol, input);
+    this->UpdateExtentsUniforms(ren, vol, modelviewMatrix);
+
+    brick.TextureObject->Activate();
+    this->ShaderProgram->SetUniformi("in_volume",
+      brick.TextureObject->GetTextureUnit());
+    this->DrawVolumeGeometry();
+    brick.TextureObject->Deactivate();
+    }
+
+  std::copy(wholeBounds, wholeBounds + 6, this->LoadedBounds);
+  std::copy(wholeExtents, wholeExtents + 6, this->Extents);
+  std::copy(wholeSize, wholeSize + 3, this->TextureSize);
+
+  this->Parent->NumberOfRenderedBricks = static_cast<int>(order.size());
+  this->Parent->NumberOfUploadedBricks = uploadedBricks;
+}
+
 //----------------------------------------------------------------------------
 void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::UpdateLightingParameters(
   vtkRenderer* ren, vtkVolume* vol)
@@ -1571,6 +2293,7 @@ void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::UpdateVolumeGeometry(
 {
   if (this->NeedToInitializeResources ||
       input->GetMTime() > this->InputUpdateTime.GetMTime() ||
+      this->UseBricks ||
       this->IsCameraInside(ren, vol) ||
       this->CameraWasInsideInLastUpdate)
     {
@@ -1869,6 +2592,108 @@ void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::UpdateClipping(
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::UpdateExtentsUniforms(
+  vtkRenderer* ren, vtkVolume* vol, vtkMatrix4x4* modelviewMatrix)
+{
+  float fvalue3[3];
+
+  for (int i = 0; i < 3; ++i)
+    {
+    this->CellStep[i] = 1.0 / static_cast<double>(
+      this->TextureSize[i] - 1 + (this->Parent->CellFlag ? 1 : 0));
+    this->CellScale[i] = (this->LoadedBounds[2 * i + 1] -
+                          this->LoadedBounds[2 * i]) * 0.5;
+    this->DatasetStepSize[i] = 1.0 / (this->LoadedBounds[2 * i + 1] -
+                                      this->LoadedBounds[2 * i]);
+    }
+
+  // Step should be dependant on the bounds and not on the texture size
+  // since we can have non uniform voxel size / spacing / aspect ratio
+  vtkInternal::ToFloat(this->CellStep, fvalue3);
+  this->ShaderProgram->SetUniform3fv("in_cellStep", 1, &fvalue3);
+
+  vtkInternal::ToFloat(this->CellScale, fvalue3);
+  this->ShaderProgram->SetUniform3fv("in_cellScale", 1, &fvalue3);
+
+  // Compute texture to dataset matrix
+  this->TextureToDataSetMat->Identity();
+  this->TextureToDataSetMat->SetElement(0, 0,
+    (1.0 / this->DatasetStepSize[0]));
+  this->TextureToDataSetMat->SetElement(1, 1,
+    (1.0 / this->DatasetStepSize[1]));
+  this->TextureToDataSetMat->SetElement(2, 2,
+    (1.0 / this->DatasetStepSize[2]));
+  this->TextureToDataSetMat->SetElement(3, 3,
+    1.0);
+  this->TextureToDataSetMat->SetElement(0, 3,
+    this->LoadedBounds[0]);
+  this->TextureToDataSetMat->SetElement(1, 3,
+    this->LoadedBounds[2]);
+  this->TextureToDataSetMat->SetElement(2, 3,
+    this->LoadedBounds[4]);
+
+  this->TextureToDataSetMat->Transpose();
+  this->InverseTextureToDataSetMat->DeepCopy(
+    this->TextureToDataSetMat.GetPointer());
+  this->InverseTextureToDataSetMat->Invert();
+  this->ShaderProgram->SetUniformMatrix(
+    "in_textureDatasetMatrix", this->TextureToDataSetMat.GetPointer());
+  this->ShaderProgram->SetUniformMatrix(
+    "in_inverseTextureDatasetMatrix", this->InverseTextureToDataSetMat.GetPointer());
+
+  this->TempMatrix4x4->DeepCopy(vol->GetMatrix());
+  this->TempMatrix4x4->Transpose();
+  vtkMatrix4x4::Multiply4x4(this->TempMatrix4x4.GetPointer(),
+                            modelviewMatrix,
+                            this->TextureToEyeTransposeInverse.GetPointer());
+
+  vtkMatrix4x4::Multiply4x4(this->TextureToDataSetMat.GetPointer(),
+                            this->TextureToEyeTransposeInverse.GetPointer(),
+                            this->TextureToEyeTransposeInverse.GetPointer());
+
+  this->TextureToEyeTransposeInverse->Invert();
+  this->ShaderProgram->SetUniformMatrix(
+    "in_texureToEyeIt", this->TextureToEyeTransposeInverse.GetPointer());
+
+  vtkInternal::ToFloat(this->LoadedBounds[0],
+                       this->LoadedBounds[2],
+                       this->LoadedBounds[4], fvalue3);
+  this->ShaderProgram->SetUniform3fv("in_volumeExtentsMin", 1, &fvalue3);
+
+  vtkInternal::ToFloat(this->LoadedBounds[1],
+                       this->LoadedBounds[3],
+                       this->LoadedBounds[5], fvalue3);
+  this->ShaderProgram->SetUniform3fv("in_volumeExtentsMax", 1, &fvalue3);
+
+  vtkInternal::ToFloat(this->Extents[0],
+                       this->Extents[2],
+                       this->Extents[4], fvalue3);
+  this->ShaderProgram->SetUniform3fv("in_textureExtentsMin", 1, &fvalue3);
+
+  vtkInternal::ToFloat(this->Extents[1],
+                       this->Extents[3],
+                       this->Extents[5], fvalue3);
+  this->ShaderProgram->SetUniform3fv("in_textureExtentsMax", 1, &fvalue3);
+
+  // Updating cropping if enabled
+  this->UpdateCropping(ren, vol);
+}
+
+//----------------------------------------------------------------------------
+void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::DrawVolumeGeometry()
+{
+#ifdef __APPLE__
+  if (vtkOpenGLRenderWindow::GetContextSupportsOpenGL32())
+#endif
+    {
+    glBindVertexArray(this->CubeVAOId);
+    }
+  glDrawElements(GL_TRIANGLES,
+                 this->BBoxPolyData->GetNumberOfCells() * 3,
+                 GL_UNSIGNED_INT, 0);
+}
+
 //----------------------------------------------------------------------------
 void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::UpdateSamplingDistance(
   vtkImageData* input, vtkRenderer* vtkNotUsed(ren), vtkVolume* vol)
@@ -2059,6 +2884,12 @@ vtkOpenGLGPUVolumeRayCastMapper::vtkOpenGLGPUVolumeRayCastMapper() :
 {
   this->Impl = new vtkInternal(this);
   this->ReductionFactor = 1.0;
+  this->EmptySpaceSkipping = 0;
+  this->EmptySpaceBlockSize = 8;
+  this->VolumeBricking = 0;
+  this->BrickSize = 128;
+  this->NumberOfRenderedBricks = 0;
+  this->NumberOfUploadedBricks = 0;
 }
 
 ///
@@ -2084,6 +2915,14 @@ void vtkOpenGLGPUVolumeRayCastMapper::PrintSelf(ostream& os, vtkIndent indent)
     this->Impl->ActualSampleDistance << "\n";
   os << indent << "LastProjectionParallel: " <<
     this->Impl->LastProjectionParallel << "\n";
+  os << indent << "EmptySpaceSkipping: " << this->EmptySpaceSkipping << "\n";
+  os << indent << "EmptySpaceBlockSize: " << this->EmptySpaceBlockSize << "\n";
+  os << indent << "VolumeBricking: " << this->VolumeBricking << "\n";
+  os << indent << "BrickSize: " << this->BrickSize << "\n";
+  os << indent << "NumberOfRenderedBricks: " << this->NumberOfRenderedBricks
+     << "\n";
+  os << indent << "NumberOfUploadedBricks: " << this->NumberOfUploadedBricks
+     << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -2141,6 +2980,15 @@ void vtkOpenGLGPUVolumeRayCastMapper::ReleaseGraphicsResources(
     this->Impl->DepthTextureObject = 0;
     }
 
+  if (this->Impl->BlockOccupancyTextureObject)
+    {
+    this->Impl->BlockOccupancyTextureObject->ReleaseGraphicsResources(window);
+    this->Impl->BlockOccupancyTextureObject->Delete();
+    this->Impl->BlockOccupancyTextureObject = 0;
+    }
+
+  this->Impl->DeleteBricks(window);
+
   if (this->Impl->FBO)
     {
     this->Impl->FBO->Delete();
@@ -2421,6 +3269,21 @@ void vtkOpenGLGPUVolumeRayCastMapper::BuildShader(vtkRenderer* ren,
       vtkvolume::ComputeRayDirectionDeclaration(ren, this, vol,noOfComponents),
     true);
 
+  // Empty space skipping methods replacements
+  //--------------------------------------------------------------------------
+  bool skipEmptySpace = this->Impl->IsEmptySpaceSkipped(noOfComponents);
+  fragmentShader = vtkvolume::replace(
+    fragmentShader,
+    "//VTK::EmptySpace::Dec",
+    vtkvolume::EmptySpaceDeclarationFragment(ren, this, vol, skipEmptySpace),
+    true);
+
+  fragmentShader = vtkvolume::replace(
+    fragmentShader,
+    "//VTK::EmptySpace::Impl",
+    vtkvolume::EmptySpaceImplementation(ren, this, vol, skipEmptySpace),
+    true);
+
   // Cropping methods replacements
   //--------------------------------------------------------------------------
   vertexShader = vtkvolume::replace(
@@ -2823,11 +3686,15 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren,
   this->Impl->InverseVolumeMat->Invert();
 
   // Update the volume if needed
+  bool useBricks = this->Impl->IsVolumeBricked(scalars);
   bool volumeModified = false;
   if (this->Impl->NeedToInitializeResources ||
-      (input->GetMTime() > this->Impl->InputUpdateTime.GetMTime()))
+      (input->GetMTime() > this->Impl->InputUpdateTime.GetMTime()) ||
+      useBricks != this->Impl->UseBricks ||
+      (useBricks && this->BrickSize != this->Impl->BrickSize))
     {
     volumeModified = true;
+    this->Impl->UseBricks = useBricks;
     input->GetDimensions(this->Impl->Dimensions);
 
     // Update bounds, data, and geometry
@@ -2842,6 +3709,13 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren,
     this->Impl->UpdateVolume(volumeProperty);
     }
 
+  bool skipEmptySpace = this->Impl->IsEmptySpaceSkipped(noOfComponents);
+  if (skipEmptySpace && (volumeModified || this->Impl->BlockRanges.empty() ||
+      this->Impl->BlockSize != this->EmptySpaceBlockSize))
+    {
+    this->Impl->ComputeBlockRanges(scalars);
+    }
+
   // Mask
   vtkVolumeMask* mask = 0;
   if(this->MaskInput != 0)
@@ -2875,10 +3749,12 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren,
       this->Impl->ShaderBuildTime.GetMTime() ||
       this->GetMTime() > this->Impl->ShaderBuildTime.GetMTime() ||
       cam->GetParallelProjection() !=
-      this->Impl->LastProjectionParallel)
+      this->Impl->LastProjectionParallel ||
+      this->Impl->UseBricks != this->Impl->LastUseBricks)
     {
     this->Impl->LastProjectionParallel =
       cam->GetParallelProjection();
+    this->Impl->LastUseBricks = this->Impl->UseBricks;
     this->BuildShader(ren, vol, noOfComponents);
     }
   else
@@ -2889,8 +3765,11 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren,
     }
 
   // And now update the geometry that will be used
-  // to render the 3D texture
-  this->Impl->UpdateVolumeGeometry(ren, vol, input);
+  // to render the 3D texture, the bricks update their own
+  if (!this->Impl->UseBricks)
+    {
+    this->Impl->UpdateVolumeGeometry(ren, vol, input);
+    }
 
   // Update the transfer functions
   if (independentComponents)
@@ -2920,6 +3799,11 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren,
       }
     }
 
+  if (skipEmptySpace)
+    {
+    this->Impl->UpdateBlockOccupancy(ren);
+    }
+
   // Update noise sampler texture
   this->Impl->UpdateNoiseTexture(ren);
 
@@ -2935,30 +3819,6 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren,
   float fvalue3[3];
   float fvalue4[4];
 
-  // Update sampling distance
-  int* loadedExtent = input->GetExtent();
-
-  this->Impl->CellStep[0] =
-    (1.0/static_cast<double>(loadedExtent[1] - loadedExtent[0]));
-  this->Impl->CellStep[1] =
-    (1.0/static_cast<double>(loadedExtent[3] - loadedExtent[2]));
-  this->Impl->CellStep[2] =
-    (1.0/static_cast<double>(loadedExtent[5] -loadedExtent[4]));
-
-  this->Impl->CellScale[0] = (this->Impl->LoadedBounds[1] -
-                              this->Impl->LoadedBounds[0]) * 0.5;
-  this->Impl->CellScale[1] = (this->Impl->LoadedBounds[3] -
-                              this->Impl->LoadedBounds[2]) * 0.5;
-  this->Impl->CellScale[2] = (this->Impl->LoadedBounds[5] -
-                              this->Impl->LoadedBounds[4]) * 0.5;
-
-  this->Impl->DatasetStepSize[0] = 1.0 / (this->Impl->LoadedBounds[1] -
-                                          this->Impl->LoadedBounds[0]);
-  this->Impl->DatasetStepSize[1] = 1.0 / (this->Impl->LoadedBounds[3] -
-                                          this->Impl->LoadedBounds[2]);
-  this->Impl->DatasetStepSize[2] = 1.0 / (this->Impl->LoadedBounds[5] -
-                                          this->Impl->LoadedBounds[4]);
-
   if (cam->GetParallelProjection())
     {
     double dir[4];
@@ -2988,14 +3848,6 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren,
   this->Impl->ShaderProgram->SetUniform4f("in_volume_scale",tscale);
   this->Impl->ShaderProgram->SetUniform4f("in_volume_bias",tbias);
 
-  // Step should be dependant on the bounds and not on the texture size
-  // since we can have non uniform voxel size / spacing / aspect ratio
-  vtkInternal::ToFloat(this->Impl->CellStep, fvalue3);
-  this->Impl->ShaderProgram->SetUniform3fv("in_cellStep", 1, &fvalue3);
-
-  vtkInternal::ToFloat(this->Impl->CellScale, fvalue3);
-  this->Impl->ShaderProgram->SetUniform3fv("in_cellScale", 1, &fvalue3);
-
   vtkInternal::ToFloat(this->Impl->CellSpacing, fvalue3);
   this->Impl->ShaderProgram->SetUniform3fv("in_cellSpacing", 1, &fvalue3);
 
@@ -3007,10 +3859,13 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren,
   this->Impl->ShaderProgram->SetUniform2fv("in_scalarsRange", 4,
                                            scalarsRange);
 
-  // Bind textures
-  this->Impl->VolumeTextureObject->Activate();
-  this->Impl->ShaderProgram->SetUniformi("in_volume",
-    this->Impl->VolumeTextureObject->GetTextureUnit());
+  // Bind textures, the bricks are bound when they are drawn
+  if (!this->Impl->UseBricks)
+    {
+    this->Impl->VolumeTextureObject->Activate();
+    this->Impl->ShaderProgram->SetUniformi("in_volume",
+      this->Impl->VolumeTextureObject->GetTextureUnit());
+    }
 
   // Opacity, color, and gradient opacity samplers / textures
   int numberOfSamplers = (independentComponents ? noOfComponents : 1);
@@ -3050,6 +3905,23 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren,
     this->Impl->DepthTextureObject->GetTextureUnit());
 #endif
 
+  if (skipEmptySpace && this->Impl->BlockOccupancyTextureObject)
+    {
+    this->Impl->BlockOccupancyTextureObject->Activate();
+    this->Impl->ShaderProgram->SetUniformi("in_blockOccupancy",
+      this->Impl->BlockOccupancyTextureObject->GetTextureUnit());
+    for (int i = 0; i < 3; ++i)
+      {
+      fvalue3[i] = static_cast<float>(this->Impl->BlockSize) /
+        this->Impl->TextureSize[i];
+      }
+    this->Impl->ShaderProgram->SetUniform3fv("in_blockSize", 1, &fvalue3);
+    vtkInternal::ToFloat(this->Impl->NumberOfBlocks[0],
+                         this->Impl->NumberOfBlocks[1],
+                         this->Impl->NumberOfBlocks[2], fvalue3);
+    this->Impl->ShaderProgram->SetUniform3fv("in_numberOfBlocks", 1, &fvalue3);
+    }
+
   if (this->Impl->CurrentMask)
     {
     this->Impl->CurrentMask->Activate();
@@ -3120,69 +3992,9 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren,
   this->Impl->ShaderProgram->SetUniformMatrix(
     "in_inverseVolumeMatrix", this->Impl->InverseVolumeMat.GetPointer());
 
-  // Compute texture to dataset matrix
-  this->Impl->TextureToDataSetMat->Identity();
-  this->Impl->TextureToDataSetMat->SetElement(0, 0,
-    (1.0 / this->Impl->DatasetStepSize[0]));
-  this->Impl->TextureToDataSetMat->SetElement(1, 1,
-    (1.0 / this->Impl->DatasetStepSize[1]));
-  this->Impl->TextureToDataSetMat->SetElement(2, 2,
-    (1.0 / this->Impl->DatasetStepSize[2]));
-  this->Impl->TextureToDataSetMat->SetElement(3, 3,
-    1.0);
-  this->Impl->TextureToDataSetMat->SetElement(0, 3,
-    this->Impl->LoadedBounds[0]);
-  this->Impl->TextureToDataSetMat->SetElement(1, 3,
-    this->Impl->LoadedBounds[2]);
-  this->Impl->TextureToDataSetMat->SetElement(2, 3,
-    this->Impl->LoadedBounds[4]);
-
-  this->Impl->TextureToDataSetMat->Transpose();
-  this->Impl->InverseTextureToDataSetMat->DeepCopy(
-    this->Impl->TextureToDataSetMat.GetPointer());
-  this->Impl->InverseTextureToDataSetMat->Invert();
-  this->Impl->ShaderProgram->SetUniformMatrix(
-    "in_textureDatasetMatrix", this->Impl->TextureToDataSetMat.GetPointer());
-  this->Impl->ShaderProgram->SetUniformMatrix(
-    "in_inverseTextureDatasetMatrix", this->Impl->InverseTextureToDataSetMat.GetPointer());
-
-
-  vtkMatrix4x4::Multiply4x4(this->Impl->TempMatrix4x4.GetPointer(),
-                            modelviewMatrix,
-                            this->Impl->TextureToEyeTransposeInverse.GetPointer());
-
-  vtkMatrix4x4::Multiply4x4(this->Impl->TextureToDataSetMat.GetPointer(),
-                            this->Impl->TextureToEyeTransposeInverse.GetPointer(),
-                            this->Impl->TextureToEyeTransposeInverse.GetPointer());
-
-
-  this->Impl->TextureToEyeTransposeInverse->Invert();
-  this->Impl->ShaderProgram->SetUniformMatrix(
-    "in_texureToEyeIt", this->Impl->TextureToEyeTransposeInverse.GetPointer());
-
   vtkInternal::ToFloat(cam->GetPosition(), fvalue3, 3);
   this->Impl->ShaderProgram->SetUniform3fv("in_cameraPos", 1, &fvalue3);
 
-  vtkInternal::ToFloat(this->Impl->LoadedBounds[0],
-                       this->Impl->LoadedBounds[2],
-                       this->Impl->LoadedBounds[4], fvalue3);
-  this->Impl->ShaderProgram->SetUniform3fv("in_volumeExtentsMin", 1, &fvalue3);
-
-  vtkInternal::ToFloat(this->Impl->LoadedBounds[1],
-                       this->Impl->LoadedBounds[3],
-                       this->Impl->LoadedBounds[5], fvalue3);
-  this->Impl->ShaderProgram->SetUniform3fv("in_volumeExtentsMax", 1, &fvalue3);
-
-  vtkInternal::ToFloat(this->Impl->Extents[0],
-                       this->Impl->Extents[2],
-                       this->Impl->Extents[4], fvalue3);
-  this->Impl->ShaderProgram->SetUniform3fv("in_textureExtentsMin", 1, &fvalue3);
-
-  vtkInternal::ToFloat(this->Impl->Extents[1],
-                       this->Impl->Extents[3],
-                       this->Impl->Extents[5], fvalue3);
-  this->Impl->ShaderProgram->SetUniform3fv("in_textureExtentsMax", 1, &fvalue3);
-
   // TODO Take consideration of reduction factor
   vtkInternal::ToFloat(this->Impl->WindowLowerLeft, fvalue2);
   this->Impl->ShaderProgram->SetUniform2fv("in_windowLowerLeftCorner", 1, &fvalue2);
@@ -3198,9 +4010,6 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren,
   this->Impl->ShaderProgram->SetUniformi("in_useJittering", this->GetUseJittering());
   this->Impl->ShaderProgram->SetUniformi("in_cellFlag", this->CellFlag);
 
-  // Updating cropping if enabled
-  this->Impl->UpdateCropping(ren, vol);
-
   // Updating clipping if enabled
   this->Impl->UpdateClipping(ren, vol);
 
@@ -3219,18 +4028,21 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren,
     this->Impl->ShaderProgram->SetUniform4fv("in_componentWeight", 1, &fvalue4);
     }
 
-#ifdef __APPLE__
-  if (vtkOpenGLRenderWindow::GetContextSupportsOpenGL32())
-#endif
+  if (this->Impl->UseBricks)
     {
-    glBindVertexArray(this->Impl->CubeVAOId);
+    this->Impl->RenderBricks(ren, vol, input, scalars, modelviewMatrix);
+    }
+  else
+    {
+    this->Impl->UpdateExtentsUniforms(ren, vol, modelviewMatrix);
+    this->Impl->DrawVolumeGeometry();
     }
-  glDrawElements(GL_TRIANGLES,
-                 this->Impl->BBoxPolyData->GetNumberOfCells() * 3,
-                 GL_UNSIGNED_INT, 0);
 
   // relase the texture units we were using
-  this->Impl->VolumeTextureObject->Deactivate();
+  if (!this->Impl->UseBricks)
+    {
+    this->Impl->VolumeTextureObject->Deactivate();
+    }
   this->Impl->NoiseTextureObject->Deactivate();
   this->Impl->DepthTextureObject->Deactivate();
 
@@ -3247,6 +4059,11 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren,
       }
     }
 
+  if (skipEmptySpace && this->Impl->BlockOccupancyTextureObject)
+    {
+    this->Impl->BlockOccupancyTextureObject->Deactivate();
+    }
+
   if (this->Impl->CurrentMask)
     {
     this->Impl->CurrentMask->Deactivate();
@@ -53,6 +53,52 @@ public:
   // RenderToImage mode.
   void GetColorImage(vtkImageData* im);
 
+  // Description:
+  // Skip the transparent regions of the volume while casting the rays. The
+  // volume is split in blocks of EmptySpaceBlockSize voxels per axis, and
+  // the rays jump over the blocks whose range of scalars maps to a zero
+  // opacity. The range of every block is computed when the scalars change,
+  // the transparent blocks when the scalar opacity changes. This applies to
+  // single component volumes rendered with composite blending, and pays off
+  // on sparse volumes such as segmented data or CT with wide air regions.
+  // Initial value is off.
+  vtkSetMacro(EmptySpaceSkipping, int);
+  vtkGetMacro(EmptySpaceSkipping, int);
+  vtkBooleanMacro(EmptySpaceSkipping, int);
+
+  // Description:
+  // Number of voxels along each axis of the blocks used by
+  // EmptySpaceSkipping. Initial value is 8.
+  vtkSetClampMacro(EmptySpaceBlockSize, int, 2, 64);
+  vtkGetMacro(EmptySpaceBlockSize, int);
+
+  // Description:
+  // Render the volume in bricks when its texture does not fit in
+  // MaxMemoryInBytes * MaxMemoryFraction. The bricks in the view whose
+  // scalars are not fully transparent are drawn back to front, each one
+  // with its own texture. The bricks stay on the GPU while they fit in the
+  // memory given to the mapper; a missing brick is uploaded just before it
+  // is drawn, in place of the bricks least recently used, so that a volume
+  // larger than the GPU memory is rendered at full resolution. This applies
+  // to composite blending, without mask and out of RenderToImage.
+  // Initial value is off.
+  vtkSetMacro(VolumeBricking, int);
+  vtkGetMacro(VolumeBricking, int);
+  vtkBooleanMacro(VolumeBricking, int);
+
+  // Description:
+  // Number of voxels along each axis of the bricks used by VolumeBricking.
+  // Neighbor bricks share the voxels of their common face.
+  // Initial value is 128.
+  vtkSetClampMacro(BrickSize, int, 8, 2048);
+  vtkGetMacro(BrickSize, int);
+
+  // Description:
+  // Number of bricks drawn, and of bricks uploaded to the GPU, at the last
+  // render with VolumeBricking.
+  vtkGetMacro(NumberOfRenderedBricks, int);
+  vtkGetMacro(NumberOfUploadedBricks, int);
+
 protected:
   vtkOpenGLGPUVolumeRayCastMapper();
   ~vtkOpenGLGPUVolumeRayCastMapper();
@@ -115,6 +161,14 @@ protected:
 
   double ReductionFactor;
 
+  int EmptySpaceSkipping;
+  int EmptySpaceBlockSize;
+
+  int VolumeBricking;
+  int BrickSize;
+  int NumberOfRenderedBricks;
+  int NumberOfUploadedBricks;
+
 private:
   class vtkInternal;
   vtkInternal* Impl;
@@ -182,6 +182,27 @@ public:
     return this->TextureObject->GetTextureUnit();
     }
 
+  // Get the opacity values of the last update, one per texel, or NULL if the
+  // table was never updated.
+  //--------------------------------------------------------------------------
+  const float* GetTable() const
+    {
+    return this->Table;
+    }
+
+  //--------------------------------------------------------------------------
+  int GetTextureWidth() const
+    {
+    return this->TextureWidth;
+    }
+
+  // Get the time the opacity values were last computed.
+  //--------------------------------------------------------------------------
+  unsigned long GetBuildTime() const
+    {
+    return this->BuildTime.GetMTime();
+    }
+
   //--------------------------------------------------------------------------
   void ReleaseGraphicsResources(vtkWindow *window)
     {
@@ -1408,6 +1408,57 @@ namespace vtkvolume
     return std::string();
    }
 
+  //--------------------------------------------------------------------------
+  std::string EmptySpaceDeclarationFragment(vtkRenderer* vtkNotUsed(ren),
+                                            vtkVolumeMapper* vtkNotUsed(mapper),
+                                            vtkVolume* vtkNotUsed(vol),
+                                            bool skipEmptySpace)
+  {
+    if (!skipEmptySpace)
+      {
+      return std::string();
+      }
+    return std::string("\
+      \n// Blocks of the volume, a block is 0 when it is fully transparent\
+      \nuniform sampler3D in_blockOccupancy;\
+      \nuniform vec3 in_blockSize;\
+      \nuniform vec3 in_numberOfBlocks;"
+    );
+  }
+
+  //--------------------------------------------------------------------------
+  std::string EmptySpaceImplementation(vtkRenderer* vtkNotUsed(ren),
+                                       vtkVolumeMapper* vtkNotUsed(mapper),
+                                       vtkVolume* vtkNotUsed(vol),
+                                       bool skipEmptySpace)
+  {
+    if (!skipEmptySpace)
+      {
+      return std::string();
+      }
+    return std::string("\
+      \n    // Jump over the samples left in a transparent block: they are\
+      \n    // skipped, the ray advance below leaves the block.\
+      \n    vec3 l_block = floor(g_dataPos / in_blockSize);\
+      \n    if (texture3D(in_blockOccupancy,\
+      \n                  (l_block + vec3(0.5)) / in_numberOfBlocks).r == 0.0)\
+      \n      {\
+      \n      vec3 l_blockExit = (l_block + step(vec3(0.0), g_dirStep)) *\
+      \n                         in_blockSize;\
+      \n      vec3 l_dir = g_dirStep +\
+      \n                   vec3(equal(g_dirStep, vec3(0.0))) * 1.0e-10;\
+      \n      vec3 l_exitT = (l_blockExit - g_dataPos) / l_dir;\
+      \n      float l_steps = floor(min(l_exitT.x, min(l_exitT.y, l_exitT.z)));\
+      \n      if (l_steps > 0.0)\
+      \n        {\
+      \n        g_dataPos += g_dirStep * l_steps;\
+      \n        l_currentT += l_steps;\
+      \n        }\
+      \n      l_skip = true;\
+      \n      }"
+    );
+  }
+
   //--------------------------------------------------------------------------
   std::string CroppingDeclarationVertex(vtkRenderer* vtkNotUsed(ren),
                                         vtkVolumeMapper* vtkNotUsed(mapper),
@@ -0,0 +1,55 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    KernelTimings.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+/*
+Timings of the filters and writers that regressed in the past, on
+synthetic datasets of increasing size. Run it once per thread count with
+-threads, and once per build for each vtkSMPTools backend, with -json to
+keep the results and -baseline to compare them to an earlier run. The
+rendering timings are in TimingTests.
+*/
+
+#include "vtkKernelTimingTests.h"
+#include "vtkImageReslice.h"
+
+/*=========================================================================
+The main entry point
+=========================================================================*/
+int main( int argc, char *argv[] )
+{
+  // create the timing framework
+  vtkRenderTimings a;
+
+  // add the tests
+  a.TestsToRun.push_back(new flyingEdgesTest("FlyingEdges3D"));
+
+  a.TestsToRun.push_back(new contourGridTest("ContourGrid", false));
+  a.TestsToRun.push_back(new contourGridTest("SMPContourGrid", true));
+
+  a.TestsToRun.push_back(new xmlWriterTest("XMLPolyDataWriter", false, false));
+  a.TestsToRun.push_back(
+    new xmlWriterTest("XMLPolyDataWriterZLib", false, true));
+  a.TestsToRun.push_back(
+    new xmlWriterTest("XMLUnstructuredGridWriter", true, false));
+  a.TestsToRun.push_back(
+    new xmlWriterTest("XMLUnstructuredGridWriterZLib", true, true));
+
+  a.TestsToRun.push_back(new resliceTest("ImageReslice", VTK_RESLICE_LINEAR));
+  a.TestsToRun.push_back(
+    new resliceTest("ImageResliceCubic", VTK_RESLICE_CUBIC));
+
+  // process them
+  return a.ParseCommandLineArguments(argc, argv);
+}
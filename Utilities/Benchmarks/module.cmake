@@ -8,6 +8,12 @@ vtk_module(vtkUtilitiesBenchmarks
     vtkInteractionStyle
     vtkViewsContext2D
     vtkFiltersGeometry
+    vtkFiltersGeneral
+    vtkFiltersParallel
+    vtkFiltersSMP
+    vtkImagingCore
+    vtkIOXML
+    vtkjsoncpp
     vtksys
   EXCLUDE_FROM_WRAPPING
 )
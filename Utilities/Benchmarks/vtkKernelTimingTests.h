@@ -0,0 +1,329 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkKernelTimingTests.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkKernelTimingTests_h
+#define vtkKernelTimingTests_h
+
+/*
+These tests time filters and writers without rendering. Each test builds
+a synthetic dataset scaled by the sequence numbers, which is not timed,
+then runs its kernel as many times as the target time allows and reports
+the average time of a run. See vtkRenderTimingTests.h for how to add a
+test.
+*/
+
+#include "vtkRenderTimings.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkNew.h"
+
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkImageData.h"
+#include "vtkPSphereSource.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkUnstructuredGrid.h"
+
+// run the kernel until at least one run was made and the target time
+// is used up, or at most maxRuns times, and return the average time
+// of a run
+static double vtkKernelTimingRun(vtkAlgorithm *kernel, double targetTime,
+  int maxRuns = 10)
+{
+  double startTime = vtkTimerLog::GetUniversalTime();
+  int runs = 0;
+  while (runs < maxRuns)
+    {
+    kernel->Modified();
+    kernel->Update();
+    runs++;
+    if (vtkTimerLog::GetUniversalTime() - startTime > targetTime)
+      {
+      break;
+      }
+    }
+  return (vtkTimerLog::GetUniversalTime() - startTime) / runs;
+}
+
+// the wavelet image of about (40 res1) x (40 res2) x (40 res3) points
+static void vtkKernelTimingWavelet(vtkRTAnalyticSource *wavelet,
+  int res1, int res2, int res3)
+{
+  wavelet->SetWholeExtent(-20*res1, 20*res1 - 1,
+                          -20*res2, 20*res2 - 1,
+                          -20*res3, 20*res3 - 1);
+  wavelet->SetCenter(0.0, 0.0, 0.0);
+  wavelet->Update();
+}
+
+/*=========================================================================
+Define a test for contouring images with vtkFlyingEdges3D
+=========================================================================*/
+#include "vtkFlyingEdges3D.h"
+
+class flyingEdgesTest : public vtkRTTest
+{
+  public:
+  flyingEdgesTest(const char *name) : vtkRTTest(name)
+    {
+    }
+
+  const char *GetSummaryResultName() { return "Mvoxels/sec"; }
+
+  const char *GetSecondSummaryResultName() { return "Mvoxels"; }
+
+  virtual vtkRTTestResult Run(vtkRTTestSequence *ats,
+      int /*argc*/, char * /* argv */[])
+    {
+    int res1, res2, res3;
+    ats->GetSequenceNumbers(res1,res2,res3);
+
+    vtkNew<vtkRTAnalyticSource> wavelet;
+    vtkKernelTimingWavelet(wavelet.Get(), res1, res2, res3);
+
+    vtkNew<vtkFlyingEdges3D> contour;
+    contour->SetInputData(wavelet->GetOutput());
+    contour->SetNumberOfContours(3);
+    contour->SetValue(0, 100.0);
+    contour->SetValue(1, 160.0);
+    contour->SetValue(2, 220.0);
+    contour->ComputeNormalsOn();
+    contour->ComputeScalarsOff();
+
+    double runTime = vtkKernelTimingRun(contour.Get(), this->TargetTime);
+    double numVoxels = wavelet->GetOutput()->GetNumberOfPoints();
+
+    vtkRTTestResult result;
+    result.Results["run time"] = runTime;
+    result.Results["Mvoxels"] = 1.0e-6 * numVoxels;
+    result.Results["Mvoxels/sec"] = 1.0e-6 * numVoxels / runTime;
+    result.Results["triangles"] =
+      contour->GetOutput()->GetNumberOfCells();
+
+    return result;
+    }
+};
+
+/*=========================================================================
+Define a test for contouring unstructured grids, with or without
+vtkSMPContourGrid
+=========================================================================*/
+#include "vtkContourGrid.h"
+#include "vtkSMPContourGrid.h"
+
+class contourGridTest : public vtkRTTest
+{
+  public:
+  contourGridTest(const char *name, bool withSMP) : vtkRTTest(name)
+    {
+    this->WithSMP = withSMP;
+    }
+
+  const char *GetSummaryResultName() { return "Mcells/sec"; }
+
+  const char *GetSecondSummaryResultName() { return "Mcells"; }
+
+  virtual vtkRTTestResult Run(vtkRTTestSequence *ats,
+      int /*argc*/, char * /* argv */[])
+    {
+    int res1, res2, res3;
+    ats->GetSequenceNumbers(res1,res2,res3);
+
+    // tetrahedralize the wavelet, five tetrahedra per voxel
+    vtkNew<vtkRTAnalyticSource> wavelet;
+    vtkKernelTimingWavelet(wavelet.Get(), res1, res2, res3);
+    vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+    tetrahedralize->SetInputData(wavelet->GetOutput());
+    tetrahedralize->Update();
+    vtkUnstructuredGrid *grid = tetrahedralize->GetOutput();
+
+    vtkContourGrid *contour = this->WithSMP ?
+      vtkSMPContourGrid::New() : vtkContourGrid::New();
+    contour->SetInputData(grid);
+    contour->SetNumberOfContours(3);
+    contour->SetValue(0, 100.0);
+    contour->SetValue(1, 160.0);
+    contour->SetValue(2, 220.0);
+    contour->ComputeScalarsOff();
+
+    double runTime = vtkKernelTimingRun(contour, this->TargetTime);
+    double numCells = grid->GetNumberOfCells();
+
+    vtkRTTestResult result;
+    result.Results["run time"] = runTime;
+    result.Results["Mcells"] = 1.0e-6 * numCells;
+    result.Results["Mcells/sec"] = 1.0e-6 * numCells / runTime;
+    contour->Delete();
+
+    return result;
+    }
+
+  protected:
+  bool WithSMP;
+};
+
+/*=========================================================================
+Define a test for writing polydata and unstructured grids in the VTK XML
+formats. The files are written to a string to leave out the disk.
+=========================================================================*/
+#include "vtkXMLPolyDataWriter.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+#include "vtkXMLWriter.h"
+
+class xmlWriterTest : public vtkRTTest
+{
+  public:
+  xmlWriterTest(const char *name, bool withUnstructuredGrid,
+    bool withCompression) : vtkRTTest(name)
+    {
+    this->WithUnstructuredGrid = withUnstructuredGrid;
+    this->WithCompression = withCompression;
+    }
+
+  const char *GetSummaryResultName() { return "MB/sec"; }
+
+  const char *GetSecondSummaryResultName() { return "MB"; }
+
+  virtual vtkRTTestResult Run(vtkRTTestSequence *ats,
+      int /*argc*/, char * /* argv */[])
+    {
+    vtkXMLWriter *writer;
+    vtkNew<vtkRTAnalyticSource> wavelet;
+    vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+    vtkNew<vtkPSphereSource> sphere;
+    if (this->WithUnstructuredGrid)
+      {
+      int res1, res2, res3;
+      ats->GetSequenceNumbers(res1,res2,res3);
+      vtkKernelTimingWavelet(wavelet.Get(), res1, res2, res3);
+      tetrahedralize->SetInputData(wavelet->GetOutput());
+      tetrahedralize->Update();
+      writer = vtkXMLUnstructuredGridWriter::New();
+      writer->SetInputData(tetrahedralize->GetOutput());
+      }
+    else
+      {
+      int ures, vres;
+      ats->GetSequenceNumbers(ures,vres);
+      sphere->SetThetaResolution(ures * 50);
+      sphere->SetPhiResolution(vres * 100);
+      sphere->Update();
+      writer = vtkXMLPolyDataWriter::New();
+      writer->SetInputData(sphere->GetOutput());
+      }
+    writer->WriteToOutputStringOn();
+    writer->SetDataModeToAppended();
+    if (this->WithCompression)
+      {
+      writer->SetCompressorTypeToZLib();
+      }
+    else
+      {
+      writer->SetCompressorTypeToNone();
+      }
+
+    double startTime = vtkTimerLog::GetUniversalTime();
+    int runs = 0;
+    size_t numBytes = 0;
+    while (runs < 10)
+      {
+      writer->Modified();
+      writer->Write();
+      numBytes = writer->GetOutputString().size();
+      runs++;
+      if (vtkTimerLog::GetUniversalTime() - startTime > this->TargetTime)
+        {
+        break;
+        }
+      }
+    double runTime = (vtkTimerLog::GetUniversalTime() - startTime) / runs;
+    double numMB = 1.0e-6 * numBytes;
+    writer->Delete();
+
+    vtkRTTestResult result;
+    result.Results["run time"] = runTime;
+    result.Results["MB"] = numMB;
+    result.Results["MB/sec"] = numMB / runTime;
+
+    return result;
+    }
+
+  protected:
+  bool WithUnstructuredGrid;
+  bool WithCompression;
+};
+
+/*=========================================================================
+Define a test for resampling images on oblique axes with vtkImageReslice
+=========================================================================*/
+#include "vtkImageReslice.h"
+#include "vtkTransform.h"
+
+class resliceTest : public vtkRTTest
+{
+  public:
+  resliceTest(const char *name, int interpolationMode) : vtkRTTest(name)
+    {
+    this->InterpolationMode = interpolationMode;
+    }
+
+  const char *GetSummaryResultName() { return "Mvoxels/sec"; }
+
+  const char *GetSecondSummaryResultName() { return "Mvoxels"; }
+
+  virtual vtkRTTestResult Run(vtkRTTestSequence *ats,
+      int /*argc*/, char * /* argv */[])
+    {
+    int res1, res2, res3;
+    ats->GetSequenceNumbers(res1,res2,res3);
+
+    vtkNew<vtkRTAnalyticSource> wavelet;
+    vtkKernelTimingWavelet(wavelet.Get(), res1, res2, res3);
+
+    vtkNew<vtkTransform> rotation;
+    rotation->RotateWXYZ(30.0, 1.0, 2.0, 3.0);
+
+    vtkNew<vtkImageReslice> reslice;
+    reslice->SetInputData(wavelet->GetOutput());
+    reslice->SetResliceAxesDirectionCosines(
+      rotation->GetMatrix()->Element[0][0],
+      rotation->GetMatrix()->Element[1][0],
+      rotation->GetMatrix()->Element[2][0],
+      rotation->GetMatrix()->Element[0][1],
+      rotation->GetMatrix()->Element[1][1],
+      rotation->GetMatrix()->Element[2][1],
+      rotation->GetMatrix()->Element[0][2],
+      rotation->GetMatrix()->Element[1][2],
+      rotation->GetMatrix()->Element[2][2]);
+    reslice->SetInterpolationMode(this->InterpolationMode);
+    reslice->SetOutputExtent(wavelet->GetOutput()->GetExtent());
+
+    double runTime = vtkKernelTimingRun(reslice.Get(), this->TargetTime);
+    double numVoxels = reslice->GetOutput()->GetNumberOfPoints();
+
+    vtkRTTestResult result;
+    result.Results["run time"] = runTime;
+    result.Results["Mvoxels"] = 1.0e-6 * numVoxels;
+    result.Results["Mvoxels/sec"] = 1.0e-6 * numVoxels / runTime;
+
+    return result;
+    }
+
+  protected:
+  int InterpolationMode;
+};
+
+#endif
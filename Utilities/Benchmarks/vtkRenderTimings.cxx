@@ -24,9 +24,17 @@
 #include "vtkDelimitedTextWriter.h"
 #include "vtkDoubleArray.h"
 #include "vtkPlot.h"
+#include "vtkSMPTools.h"
 #include "vtkTable.h"
 #include "vtkRenderWindow.h"
 
+#include "vtk_jsoncpp.h"
+
+// the build passes the vtkSMPTools implementation in use
+#ifndef VTK_SMP_BACKEND
+#define VTK_SMP_BACKEND "unknown"
+#endif
+
 void vtkRTTestSequence::GetSequenceNumbers(int &xdim)
 {
   static int linearSequence[] = {1, 2, 3, 5};
@@ -242,10 +250,16 @@ vtkRenderTimings::vtkRenderTimings()
   this->SequenceEnd = 0;
   this->SequenceStepTimeLimit = 15.0; // seconds
   this->DetailedResultsFileName = "results.csv";
+  this->Threshold = 0.1;
+  this->NumberOfThreads = 0;
 }
 
 int vtkRenderTimings::RunTests()
 {
+  // the SMP backends can only be initialized once per process, so
+  // scaling studies run the tests once for each thread count
+  vtkSMPTools::Initialize(this->NumberOfThreads);
+
   // what tests to run?
   bool useRegex = false;
   vtksys::RegularExpression re;
@@ -302,6 +316,117 @@ void vtkRenderTimings::ReportResults()
     (*tsItr)->ReportDetailedResults(rfile);
     }
   rfile.close();
+
+  if (this->JSONResultsFileName.size())
+    {
+    this->WriteJSONResults();
+    }
+}
+
+void vtkRenderTimings::WriteJSONResults()
+{
+  Json::Value root;
+  root["platform"] = this->SystemName;
+  root["smp backend"] = VTK_SMP_BACKEND;
+  root["smp threads"] = vtkSMPTools::GetEstimatedNumberOfThreads();
+
+  Json::Value &tests = root["tests"];
+  std::vector<vtkRTTestSequence *>::iterator tsItr;
+  for (tsItr = this->TestSequences.begin(); tsItr != this->TestSequences.end(); tsItr++)
+    {
+    vtkRTTest *test = (*tsItr)->Test;
+    Json::Value &jtest = tests[test->GetName()];
+    jtest["summary result"] = test->GetSummaryResultName();
+    jtest["largest is best"] = test->UseLargestSummaryResult();
+    Json::Value &sequence = jtest["sequence"];
+    sequence = Json::Value(Json::arrayValue);
+    const std::vector<vtkRTTestResult> &trs = (*tsItr)->GetTestResults();
+    std::vector<vtkRTTestResult>::const_iterator trItr;
+    for (trItr = trs.begin(); trItr != trs.end(); trItr++)
+      {
+      Json::Value step;
+      step["sequence number"] = trItr->SequenceNumber;
+      std::map<std::string, double>::const_iterator rItr;
+      for (rItr = trItr->Results.begin(); rItr != trItr->Results.end(); rItr++)
+        {
+        step[rItr->first] = rItr->second;
+        }
+      sequence.append(step);
+      }
+    }
+
+  ofstream jfile;
+  jfile.open(this->JSONResultsFileName.c_str());
+  Json::StyledStreamWriter writer;
+  writer.write(jfile, root);
+  jfile.close();
+}
+
+int vtkRenderTimings::CompareToBaseline()
+{
+  ifstream bfile(this->BaselineFileName.c_str());
+  Json::Value baseline;
+  Json::Reader reader;
+  if (!bfile || !reader.parse(bfile, baseline, false))
+    {
+    cerr << "Could not read the baseline " << this->BaselineFileName << endl;
+    return 1;
+    }
+
+  int regressions = 0;
+  const Json::Value &tests = baseline["tests"];
+  std::vector<vtkRTTestSequence *>::iterator tsItr;
+  for (tsItr = this->TestSequences.begin(); tsItr != this->TestSequences.end(); tsItr++)
+    {
+    vtkRTTest *test = (*tsItr)->Test;
+    std::string name = test->GetName();
+    if (!tests.isMember(name))
+      {
+      continue;
+      }
+    const char *summaryName = test->GetSummaryResultName();
+    bool largest = test->UseLargestSummaryResult();
+
+    // the steps that were run by both, the baseline may have had more
+    // or less time
+    std::map<int, double> expected;
+    const Json::Value &sequence = tests[name]["sequence"];
+    for (Json::ArrayIndex i = 0; i < sequence.size(); ++i)
+      {
+      if (sequence[i].isMember(summaryName))
+        {
+        expected[sequence[i]["sequence number"].asInt()] =
+          sequence[i][summaryName].asDouble();
+        }
+      }
+
+    const std::vector<vtkRTTestResult> &trs = (*tsItr)->GetTestResults();
+    std::vector<vtkRTTestResult>::const_iterator trItr;
+    for (trItr = trs.begin(); trItr != trs.end(); trItr++)
+      {
+      std::map<int, double>::iterator eItr = expected.find(trItr->SequenceNumber);
+      std::map<std::string, double>::const_iterator rItr =
+        trItr->Results.find(summaryName);
+      if (eItr == expected.end() || rItr == trItr->Results.end())
+        {
+        continue;
+        }
+      double value = rItr->second;
+      double base = eItr->second;
+      if ((largest && value < base * (1.0 - this->Threshold)) ||
+          (!largest && value > base * (1.0 + this->Threshold)))
+        {
+        cerr << "Regression in " << name << ":" << trItr->SequenceNumber
+          << ": " << value << " " << summaryName << ", baseline "
+          << base << endl;
+        regressions++;
+        }
+      }
+    }
+
+  cout << regressions << " regressions beyond " << 100.0 * this->Threshold
+    << "% of " << this->BaselineFileName << endl;
+  return regressions;
 }
 
 int vtkRenderTimings::ParseCommandLineArguments( int argc, char *argv[] )
@@ -312,6 +437,19 @@ int vtkRenderTimings::ParseCommandLineArguments( int argc, char *argv[] )
   typedef vtksys::CommandLineArguments argT;
   this->Arguments.AddArgument("-rn", argT::SPACE_ARGUMENT, &this->DetailedResultsFileName,
     "Specify where to write the detailed results to. Defaults to results.csv.");
+  this->Arguments.AddArgument("-json", argT::SPACE_ARGUMENT, &this->JSONResultsFileName,
+    "Specify a file to also write the detailed results to as JSON, along with "
+    "the platform and the vtkSMPTools backend and number of threads.");
+  this->Arguments.AddArgument("-baseline", argT::SPACE_ARGUMENT, &this->BaselineFileName,
+    "Specify a JSON results file of an earlier run to compare to. The summary "
+    "result of each sequence step run by both is compared, and the exit code "
+    "is non zero when any of them is worse than the threshold allows.");
+  this->Arguments.AddArgument("-threshold", argT::SPACE_ARGUMENT, &this->Threshold,
+    "Specify the fraction by which a summary result may be worse than the "
+    "baseline. Defaults to 0.1.");
+  this->Arguments.AddArgument("-threads", argT::SPACE_ARGUMENT, &this->NumberOfThreads,
+    "Specify the number of threads used by vtkSMPTools. Defaults to 0, the "
+    "backend's default.");
   this->Arguments.AddArgument("-regex", argT::SPACE_ARGUMENT, &this->Regex,
     "Specify a regular expression for what tests should be run.");
   this->Arguments.AddArgument("-tls", argT::SPACE_ARGUMENT,
@@ -381,5 +519,10 @@ int vtkRenderTimings::ParseCommandLineArguments( int argc, char *argv[] )
   this->RunTests();
   this->ReportResults();
 
+  if (this->BaselineFileName.size() && this->CompareToBaseline())
+    {
+    return 1;
+    }
+
   return 0;
  }
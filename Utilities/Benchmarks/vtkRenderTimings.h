@@ -111,6 +111,12 @@ public:
   // display the results in realtime using VTK charting
   void SetChartResults(bool v) { this->ChartResults = v; }
 
+  // the results of each step of the sequence that was run
+  const std::vector<vtkRTTestResult> &GetTestResults()
+    {
+    return this->TestResults;
+    }
+
   vtkRTTest *Test;
   float TargetTime;
 
@@ -160,6 +166,15 @@ protected:
   int RunTests();
   void ReportResults();
 
+  // write the detailed results to a JSON file, along with the
+  // platform and the vtkSMPTools backend and thread count
+  void WriteJSONResults();
+
+  // compare the summary results to those of a JSON results file,
+  // step by step, and return the number of regressions beyond the
+  // threshold
+  int CompareToBaseline();
+
 private:
   std::string Regex; // regualr expression for tests
   double TargetTime;
@@ -172,6 +187,10 @@ private:
   int SequenceEnd;
   double SequenceStepTimeLimit;
   std::string DetailedResultsFileName;
+  std::string JSONResultsFileName;
+  std::string BaselineFileName;
+  double Threshold;
+  int NumberOfThreads;
 };
 
 #endif
@@ -110,6 +110,21 @@ they are system headers.  Do NOT add any #undef lines here.  */
 #define PyGILState_Release(state) (state)=((PyGILState_STATE)0)
 #endif
 
+// The wrappers release the GIL around the methods that execute pipelines,
+// render or write files when VTK_PYTHON_RELEASE_GIL is defined, so that
+// other python threads run meanwhile. The python callbacks that these
+// methods invoke take the GIL back. Unlike Py_BEGIN_ALLOW_THREADS, these
+// do not open a block, so the return value of the method stays in scope.
+#if defined(VTK_PYTHON_RELEASE_GIL) && !defined(VTK_NO_PYTHON_THREADS)
+#define VTK_PYTHON_BEGIN_ALLOW_THREADS \
+  PyThreadState *vtkPythonSavedThreadState = PyEval_SaveThread();
+#define VTK_PYTHON_END_ALLOW_THREADS \
+  PyEval_RestoreThread(vtkPythonSavedThreadState);
+#else
+#define VTK_PYTHON_BEGIN_ALLOW_THREADS
+#define VTK_PYTHON_END_ALLOW_THREADS
+#endif
+
 // Description:
 // RAII class to manage Python threading using GIL (Global Interpreter Lock).
 // GIL is locked at object creation and unlocked at destruction.
@@ -127,8 +142,9 @@ public:
   vtkPythonScopeGilEnsurer(bool force = false, bool noRelease = false)
     : State(PyGILState_UNLOCKED)
   {
-#ifdef VTK_PYTHON_FULL_THREADSAFE
-    // Force is always true with VTK_PYTHON_FULL_THREADSAFE
+#if defined(VTK_PYTHON_FULL_THREADSAFE) || defined(VTK_PYTHON_RELEASE_GIL)
+    // Force is always true with VTK_PYTHON_FULL_THREADSAFE, and with
+    // VTK_PYTHON_RELEASE_GIL since the GIL may not be held by VTK code
     force = true;
 #endif
     this->Force = force;
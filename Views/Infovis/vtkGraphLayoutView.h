@@ -31,6 +31,7 @@
 // .SEE ALSO
 // vtkFast2DLayoutStrategy
 // vtkSimple2DLayoutStrategy
+// vtkBarnesHut2DLayoutStrategy
 // vtkForceDirectedLayoutStrategy
 //
 // .SECTION Thanks
@@ -170,6 +171,8 @@ public:
   //  - "Circular"      Places vertices uniformly on a circle.
   //  - "Cone"          Cone tree layout.
   //  - "Span Tree"     Span Tree Layout.
+  //  - "Barnes Hut 2D" The simple 2D layout with an approximate,
+  //                    multithreaded repulsion for large graphs.
   // Default is "Simple 2D".
   void SetLayoutStrategy(const char* name);
   void SetLayoutStrategyToRandom()
@@ -196,6 +199,8 @@ public:
     { this->SetLayoutStrategy("Cone"); }
   void SetLayoutStrategyToSpanTree()
     { this->SetLayoutStrategy("Span Tree"); }
+  void SetLayoutStrategyToBarnesHut2D()
+    { this->SetLayoutStrategy("Barnes Hut 2D"); }
   const char* GetLayoutStrategyName();
 
   // Description:
@@ -28,6 +28,7 @@
 #include "vtkApplyIcons.h"
 #include "vtkArcParallelEdgeStrategy.h"
 #include "vtkAssignCoordinatesLayoutStrategy.h"
+#include "vtkBarnesHut2DLayoutStrategy.h"
 #include "vtkCellData.h"
 #include "vtkCircularLayoutStrategy.h"
 #include "vtkClustering2DLayoutStrategy.h"
@@ -754,6 +755,10 @@ void vtkRenderedGraphRepresentation::SetLayoutStrategy(vtkGraphLayoutStrategy* s
     {
     this->SetLayoutStrategyName("Span Tree");
     }
+  else if (vtkBarnesHut2DLayoutStrategy::SafeDownCast(s))
+    {
+    this->SetLayoutStrategyName("Barnes Hut 2D");
+    }
   else
     {
     this->SetLayoutStrategyName("Unknown");
@@ -817,6 +822,10 @@ void vtkRenderedGraphRepresentation::SetLayoutStrategy(const char* name)
     {
     strategy = vtkSmartPointer<vtkSpanTreeLayoutStrategy>::New();
     }
+  else if (str == "barneshut2d")
+    {
+    strategy = vtkSmartPointer<vtkBarnesHut2DLayoutStrategy>::New();
+    }
   else if (str != "passthrough")
     {
     vtkErrorMacro("Unknown layout strategy: \"" << name << "\"");
@@ -248,6 +248,8 @@ public:
     { this->SetLayoutStrategy("Cone"); }
   void SetLayoutStrategyToSpanTree()
     { this->SetLayoutStrategy("Span Tree"); }
+  void SetLayoutStrategyToBarnesHut2D()
+    { this->SetLayoutStrategy("Barnes Hut 2D"); }
 
   // Description:
   // Set the layout strategy to use coordinates from arrays.
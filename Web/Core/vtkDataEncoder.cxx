@@ -24,10 +24,13 @@
 #include "vtkMutexLock.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <map>
 #include <vector>
 
@@ -37,6 +40,161 @@
 //****************************************************************************
 namespace
 {
+  //--------------------------------------------------------------------------
+  // Compute the smallest rectangle (x, y, width, height) containing the
+  // pixels of image that differ from reference. The rectangle is the whole
+  // image when the two images cannot be compared, and empty when they are
+  // identical.
+  void ComputeDirtyRegion(vtkImageData* reference, vtkImageData* image,
+    int region[4])
+    {
+    int dims[3];
+    image->GetDimensions(dims);
+    region[0] = 0;
+    region[1] = 0;
+    region[2] = dims[0];
+    region[3] = dims[1];
+
+    int refDims[3];
+    reference->GetDimensions(refDims);
+    vtkUnsignedCharArray* scalars = vtkUnsignedCharArray::SafeDownCast(
+      image->GetPointData()->GetScalars());
+    vtkUnsignedCharArray* refScalars = vtkUnsignedCharArray::SafeDownCast(
+      reference->GetPointData()->GetScalars());
+    if (!scalars || !refScalars || dims[2] != 1 ||
+      refDims[0] != dims[0] || refDims[1] != dims[1] || refDims[2] != 1 ||
+      scalars->GetNumberOfComponents() != refScalars->GetNumberOfComponents())
+      {
+      return;
+      }
+
+    const size_t pixelSize = scalars->GetNumberOfComponents();
+    const size_t rowSize = pixelSize * dims[0];
+    const unsigned char* pixels = scalars->GetPointer(0);
+    const unsigned char* refPixels = refScalars->GetPointer(0);
+
+    // Rows first, as whole rows compare with a single memcmp.
+    int ymin = 0;
+    while (ymin < dims[1] && memcmp(pixels + ymin * rowSize,
+        refPixels + ymin * rowSize, rowSize) == 0)
+      {
+      ++ymin;
+      }
+    if (ymin == dims[1])
+      {
+      region[2] = region[3] = 0;
+      return;
+      }
+    int ymax = dims[1] - 1;
+    while (memcmp(pixels + ymax * rowSize,
+        refPixels + ymax * rowSize, rowSize) == 0)
+      {
+      --ymax;
+      }
+
+    int xmin = dims[0];
+    int xmax = -1;
+    for (int y = ymin; y <= ymax; ++y)
+      {
+      const unsigned char* row = pixels + y * rowSize;
+      const unsigned char* refRow = refPixels + y * rowSize;
+      int x = 0;
+      while (x < xmin &&
+        memcmp(row + x * pixelSize, refRow + x * pixelSize, pixelSize) == 0)
+        {
+        ++x;
+        }
+      xmin = x;
+      x = dims[0] - 1;
+      while (x > xmax &&
+        memcmp(row + x * pixelSize, refRow + x * pixelSize, pixelSize) == 0)
+        {
+        --x;
+        }
+      xmax = x;
+      }
+
+    region[0] = xmin;
+    region[1] = ymin;
+    region[2] = xmax - xmin + 1;
+    region[3] = ymax - ymin + 1;
+    }
+
+  //--------------------------------------------------------------------------
+  // Compress the given region of image as a jpg, optionally base-64 encoded.
+  // The writer and the crop image are reused from one frame to the next. The
+  // caller takes the reference of the returned array.
+  vtkUnsignedCharArray* EncodeImage(vtkJPEGWriter* writer, vtkImageData* crop,
+    vtkImageData* image, const int region[4], int quality, bool base64)
+    {
+    vtkUnsignedCharArray* data = vtkUnsignedCharArray::New();
+    if (region[2] == 0 || region[3] == 0)
+      {
+      if (base64)
+        {
+        data->InsertNextValue(0);
+        }
+      return data;
+      }
+
+    int dims[3];
+    image->GetDimensions(dims);
+    vtkImageData* input = image;
+    if (region[2] != dims[0] || region[3] != dims[1])
+      {
+      vtkDataArray* scalars = image->GetPointData()->GetScalars();
+      int numComps = scalars->GetNumberOfComponents();
+      crop->SetDimensions(region[2], region[3], 1);
+      if (crop->GetScalarType() != VTK_UNSIGNED_CHAR ||
+        crop->GetNumberOfScalarComponents() != numComps ||
+        crop->GetPointData()->GetScalars() == NULL ||
+        crop->GetPointData()->GetScalars()->GetNumberOfTuples() <
+        static_cast<vtkIdType>(region[2]) * region[3])
+        {
+        crop->AllocateScalars(VTK_UNSIGNED_CHAR, numComps);
+        }
+      const size_t rowSize = static_cast<size_t>(numComps) * region[2];
+      const unsigned char* src =
+        static_cast<unsigned char*>(scalars->GetVoidPointer(0));
+      unsigned char* dest = static_cast<unsigned char*>(
+        crop->GetPointData()->GetScalars()->GetVoidPointer(0));
+      for (int y = 0; y < region[3]; ++y)
+        {
+        memcpy(dest + y * rowSize,
+          src + ((region[1] + y) * dims[0] + region[0]) * numComps, rowSize);
+        }
+      crop->Modified();
+      input = crop;
+      }
+
+    // The writer fills the array it is given instead of allocating its own.
+    vtkUnsignedCharArray* jpeg = data;
+    if (base64)
+      {
+      jpeg = vtkUnsignedCharArray::New();
+      }
+    writer->SetResult(jpeg);
+    writer->SetInputData(input);
+    writer->SetQuality(quality);
+    writer->Write();
+    writer->SetInputData(NULL);
+    writer->SetResult(NULL);
+
+    if (base64)
+      {
+      data->SetNumberOfComponents(1);
+      data->SetNumberOfTuples(std::ceil(1.5 * jpeg->GetNumberOfTuples()));
+      unsigned long size = vtkBase64Utilities::Encode(
+        jpeg->GetPointer(0),
+        jpeg->GetNumberOfTuples(),
+        data->GetPointer(0), /*mark_end=*/ 0);
+      data->SetNumberOfTuples(static_cast<vtkIdType>(size)+1);
+      data->SetValue(size, 0);
+      jpeg->Delete();
+      }
+    return data;
+    }
+
   class vtkSharedData
     {
   public:
@@ -45,8 +203,19 @@ namespace
     public:
       vtkTypeUInt32 TimeStamp;
       vtkSmartPointer<vtkUnsignedCharArray> Data;
-      OutputValueType() : TimeStamp(0), Data(NULL)
+      // Region of the frame encoded in Data, as x, y, width, height.
+      int Region[4];
+      // Stamp of the frame Data is a delta against, 0 for a whole frame.
+      vtkTypeUInt64 ReferenceStamp;
+      // The frame itself, kept to become the reference of the next deltas.
+      vtkSmartPointer<vtkImageData> Image;
+      int Quality;
+      bool Base64;
+      OutputValueType() : TimeStamp(0), Data(NULL), ReferenceStamp(0),
+        Image(NULL), Quality(100), Base64(true)
       {
+        this->Region[0] = this->Region[1] = 0;
+        this->Region[2] = this->Region[3] = 0;
       }
       };
 
@@ -56,13 +225,28 @@ namespace
       vtkTypeUInt32 OutputStamp;
       vtkSmartPointer<vtkImageData> Image;
       int Quality;
-      InputValueType() : OutputStamp(0), Image(NULL), Quality(100)
+      bool Delta;
+      bool Base64;
+      InputValueType() : OutputStamp(0), Image(NULL), Quality(100),
+        Delta(false), Base64(true)
+      {
+      }
+      };
+
+    // The frame last delivered for a key, which deltas are computed against.
+    struct ReferenceValueType
+      {
+    public:
+      vtkTypeUInt64 Stamp;
+      vtkSmartPointer<vtkImageData> Image;
+      ReferenceValueType() : Stamp(0), Image(NULL)
       {
       }
       };
 
     typedef std::map<vtkTypeUInt32, InputValueType > InputMapType;
     typedef std::map<vtkTypeUInt32, OutputValueType> OutputMapType;
+    typedef std::map<vtkTypeUInt32, ReferenceValueType> ReferenceMapType;
   private:
     bool Done;
     vtkSimpleMutexLock DoneLock;
@@ -74,8 +258,10 @@ namespace
     int ActiveThreadCount;
 
     //------------------------------------------------------------------------
-    // OutputsLock must be held before accessing any of the following members.
+    // OutputsLock must be held before accessing any of the following members,
+    // including changes to the reference counts of their images.
     OutputMapType Outputs;
+    ReferenceMapType References;
 
     //------------------------------------------------------------------------
     // Constructs used to synchronization.
@@ -157,7 +343,7 @@ namespace
     
     //------------------------------------------------------------------------
     void PushAndTakeReference(vtkTypeUInt32 key, vtkImageData* &data,
-      vtkTypeUInt64 stamp, int quality)
+      vtkTypeUInt64 stamp, int quality, bool delta, bool base64)
       {
       this->InputsLock.Lock();
         {
@@ -165,6 +351,8 @@ namespace
         value.Image.TakeReference(data);
         value.OutputStamp = stamp;
         value.Quality = quality;
+        value.Delta = delta;
+        value.Base64 = base64;
         data = NULL;
         }
       this->InputsLock.Unlock();
@@ -189,7 +377,8 @@ namespace
     // NOTE: This method may suspend the calling thread until inputs become
     // available.
     vtkTypeUInt64 GetNextInputToProcess(vtkTypeUInt32& key,
-      vtkSmartPointer<vtkImageData>& image, int& quality)
+      vtkSmartPointer<vtkImageData>& image, int& quality, bool& delta,
+      bool& base64)
       {
       vtkTypeUInt32 stamp = 0;
 
@@ -207,6 +396,8 @@ namespace
             iter->second.Image = NULL;
             stamp = iter->second.OutputStamp;
             quality = iter->second.Quality;
+            delta = iter->second.Delta;
+            base64 = iter->second.Base64;
             break;
             }
           }
@@ -223,8 +414,34 @@ namespace
       }
 
     //------------------------------------------------------------------------
+    // Get the frame last delivered for key, returning its stamp. Release it
+    // with ReleaseImage().
+    vtkTypeUInt64 GetReference(vtkTypeUInt32 key,
+      vtkSmartPointer<vtkImageData>& image)
+      {
+      this->OutputsLock.Lock();
+      const ReferenceValueType& reference = this->References[key];
+      image = reference.Image;
+      vtkTypeUInt64 stamp = reference.Stamp;
+      this->OutputsLock.Unlock();
+      return stamp;
+      }
+
+    //------------------------------------------------------------------------
+    // Drop a reference to an image that other threads may reference too.
+    void ReleaseImage(vtkSmartPointer<vtkImageData>& image)
+      {
+      this->OutputsLock.Lock();
+      image = NULL;
+      this->OutputsLock.Unlock();
+      }
+
+    //------------------------------------------------------------------------
+    // When the output keeps image (for deltas), image is passed over as well.
     void SetOutputReference(const vtkTypeUInt32 &key,
-      vtkTypeUInt64 timestamp, vtkUnsignedCharArray* &dataRef)
+      vtkTypeUInt64 timestamp, vtkUnsignedCharArray* &dataRef,
+      const int region[4], vtkTypeUInt64 referenceStamp,
+      vtkSmartPointer<vtkImageData>& image, int quality, bool base64)
       {
       this->OutputsLock.Lock();
       assert(dataRef->GetReferenceCount() == 1);
@@ -236,8 +453,14 @@ namespace
         //cout << "Done: " <<
         //  vtkMultiThreader::GetCurrentThreadID() << " "
         //  << key << ", " << timestamp << endl;
-        this->Outputs[key].TimeStamp = timestamp;
-        this->Outputs[key].Data.TakeReference(dataRef);
+        OutputValueType& output = this->Outputs[key];
+        output.TimeStamp = timestamp;
+        output.Data.TakeReference(dataRef);
+        std::copy(region, region + 4, output.Region);
+        output.ReferenceStamp = referenceStamp;
+        output.Image = image;
+        output.Quality = quality;
+        output.Base64 = base64;
         dataRef = NULL;
         }
       else
@@ -245,24 +468,55 @@ namespace
         dataRef->Delete();
         dataRef = NULL;
         }
+      image = NULL;
       this->OutputsLock.Unlock();
       this->OutputsAvailable.Broadcast();
       }
 
     //------------------------------------------------------------------------
+    // A delta computed against a frame that was not the last one delivered
+    // cannot be applied by the client. In that case, the whole frame is
+    // encoded again with writer and crop. This is done while holding
+    // OutputsLock since the workers may reference the frame too.
     bool CopyLatestOutputIfDifferent(
-      vtkTypeUInt32 key, vtkUnsignedCharArray* data)
+      vtkTypeUInt32 key, vtkUnsignedCharArray* data, int region[4],
+      vtkJPEGWriter* writer, vtkImageData* crop)
       {
       vtkTypeUInt64 dataTimeStamp = 0;
       this->OutputsLock.Lock();
         {
         const vtkSharedData::OutputValueType &output = this->Outputs[key];
-        if (output.Data.GetPointer() != NULL &&
+        ReferenceValueType& reference = this->References[key];
+        bool delivered = output.Image.GetPointer() != NULL &&
+          reference.Stamp == output.TimeStamp;
+        if (output.Data.GetPointer() != NULL && !delivered &&
           (output.Data->GetMTime() > data->GetMTime() ||
            output.Data->GetNumberOfTuples() != data->GetNumberOfTuples()))
           {
-          data->DeepCopy(output.Data.GetPointer());
+          if (output.ReferenceStamp != 0 &&
+            output.ReferenceStamp != reference.Stamp)
+            {
+            int dims[3];
+            output.Image->GetDimensions(dims);
+            region[0] = region[1] = 0;
+            region[2] = dims[0];
+            region[3] = dims[1];
+            vtkUnsignedCharArray* frame = EncodeImage(writer, crop,
+              output.Image, region, output.Quality, output.Base64);
+            data->DeepCopy(frame);
+            frame->Delete();
+            }
+          else
+            {
+            data->DeepCopy(output.Data.GetPointer());
+            std::copy(output.Region, output.Region + 4, region);
+            }
           data->Modified();
+          if (output.Image.GetPointer() != NULL)
+            {
+            reference.Image = output.Image;
+            reference.Stamp = output.TimeStamp;
+            }
           }
         dataTimeStamp = output.TimeStamp;
         }
@@ -304,14 +558,22 @@ namespace
 
     sharedData->BeginWorker();
 
+    // Reused for all the frames encoded by this thread.
+    vtkNew<vtkJPEGWriter> writer;
+    writer->WriteToMemoryOn();
+    vtkNew<vtkImageData> crop;
+
     while (true)
       {
       vtkTypeUInt32 key = 0;
       vtkSmartPointer<vtkImageData> image;
       vtkTypeUInt64 timestamp = 0;
       int quality = 100;
+      bool delta = false;
+      bool base64 = true;
 
-      timestamp = sharedData->GetNextInputToProcess(key, image, quality);
+      timestamp = sharedData->GetNextInputToProcess(key, image, quality,
+        delta, base64);
 
       if (timestamp == 0 || image.GetPointer() == NULL)
         {
@@ -322,25 +584,35 @@ namespace
       //cout << "Working Thread: " << vtkMultiThreader::GetCurrentThreadID() << endl;
       
       // Do the encoding.
-      vtkNew<vtkJPEGWriter> writer;
-      writer->WriteToMemoryOn();
-      writer->SetInputData(image);
-      writer->SetQuality(quality);
-      writer->Write();
-      vtkUnsignedCharArray* data = writer->GetResult();
-
-      vtkUnsignedCharArray* result = vtkUnsignedCharArray::New();
-      result->SetNumberOfComponents(1);
-      result->SetNumberOfTuples(std::ceil(1.5 * data->GetNumberOfTuples()));
-      unsigned long size = vtkBase64Utilities::Encode(
-        data->GetPointer(0),
-        data->GetNumberOfTuples(),
-        result->GetPointer(0), /*mark_end=*/ 0);
-      result->SetNumberOfTuples(static_cast<vtkIdType>(size)+1);
-      result->SetValue(size, 0);
+      int dims[3];
+      image->GetDimensions(dims);
+      int region[4] = { 0, 0, dims[0], dims[1] };
+      vtkTypeUInt64 referenceStamp = 0;
+      if (delta)
+        {
+        vtkSmartPointer<vtkImageData> reference;
+        referenceStamp = sharedData->GetReference(key, reference);
+        if (reference.GetPointer() != NULL)
+          {
+          ComputeDirtyRegion(reference, image, region);
+          }
+        sharedData->ReleaseImage(reference);
+        if (region[2] == dims[0] && region[3] == dims[1])
+          {
+          // a whole frame does not depend on the previous one.
+          referenceStamp = 0;
+          }
+        }
+      vtkUnsignedCharArray* result = EncodeImage(writer.GetPointer(),
+        crop.GetPointer(), image, region, quality, base64);
+      if (!delta)
+        {
+        image = NULL;
+        }
 
       // Pass over the "result" reference.
-      sharedData->SetOutputReference(key, timestamp, result);
+      sharedData->SetOutputReference(key, timestamp, result, region,
+        referenceStamp, image, quality, base64);
       assert(result == NULL);
       }
 
@@ -355,6 +627,15 @@ class vtkDataEncoder::vtkInternals
 {
 private:
   std::map<vtkTypeUInt32, vtkSmartPointer<vtkUnsignedCharArray> > ClonedOutputs;
+  struct RegionType
+    {
+    int Region[4];
+    RegionType()
+      {
+      this->Region[0] = this->Region[1] = this->Region[2] = this->Region[3] = 0;
+      }
+    };
+  std::map<vtkTypeUInt32, RegionType> ClonedRegions;
 public:
   vtkNew<vtkMultiThreader> Threader;
   vtkSharedData SharedData;
@@ -362,9 +643,14 @@ public:
 
   vtkSmartPointer<vtkUnsignedCharArray> lastBase64Image;
 
+  // Encode the whole frames replacing stale deltas on the main thread.
+  vtkNew<vtkJPEGWriter> Writer;
+  vtkNew<vtkImageData> Crop;
+
   vtkInternals() : Counter(0)
   {
     lastBase64Image = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    this->Writer->WriteToMemoryOn();
   }
 
   void TerminateAllWorkers()
@@ -384,16 +670,20 @@ public:
   // Since changes to vtkObjectBase::ReferenceCount are not thread safe, we have
   // this level of indirection between the outputs stored in SharedData and
   // passed back to the user/main thread.
-  bool GetLatestOutput(
-    vtkTypeUInt32 key, vtkSmartPointer<vtkUnsignedCharArray>& data)
+  bool GetLatestOutput(vtkTypeUInt32 key,
+    vtkSmartPointer<vtkUnsignedCharArray>& data, int region[4])
     {
     vtkSmartPointer<vtkUnsignedCharArray>& output = this->ClonedOutputs[key];
+    int* outputRegion = this->ClonedRegions[key].Region;
     if (!output)
       {
       output = vtkSmartPointer<vtkUnsignedCharArray>::New();
       }
     data = output;
-    return this->SharedData.CopyLatestOutputIfDifferent(key, data);
+    bool latest = this->SharedData.CopyLatestOutputIfDifferent(key, data,
+      outputRegion, this->Writer.GetPointer(), this->Crop.GetPointer());
+    std::copy(outputRegion, outputRegion + 4, region);
+    return latest;
     }
 
   // Once an imagedata has been written to memory as a jpg or png, this
@@ -417,6 +707,8 @@ public:
 vtkStandardNewMacro(vtkDataEncoder);
 //----------------------------------------------------------------------------
 vtkDataEncoder::vtkDataEncoder() :
+  DeltaFrames(0),
+  Base64Encoding(1),
   Internals(new vtkInternals())
 {
   this->Internals->SpawnWorkers();
@@ -445,7 +737,8 @@ void vtkDataEncoder::PushAndTakeReference(vtkTypeUInt32 key, vtkImageData* &data
   assert(data->GetReferenceCount() == 1);
 
   this->Internals->SharedData.PushAndTakeReference(
-    key, data, ++this->Internals->Counter, quality);
+    key, data, ++this->Internals->Counter, quality, this->DeltaFrames != 0,
+    this->Base64Encoding != 0);
   assert(data == NULL);
 }
 
@@ -453,7 +746,15 @@ void vtkDataEncoder::PushAndTakeReference(vtkTypeUInt32 key, vtkImageData* &data
 bool vtkDataEncoder::GetLatestOutput(
   vtkTypeUInt32 key, vtkSmartPointer<vtkUnsignedCharArray>& data)
 {
-  return this->Internals->GetLatestOutput(key, data);
+  int region[4];
+  return this->Internals->GetLatestOutput(key, data, region);
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataEncoder::GetLatestOutput(vtkTypeUInt32 key,
+  vtkSmartPointer<vtkUnsignedCharArray>& data, int region[4])
+{
+  return this->Internals->GetLatestOutput(key, data, region);
 }
 
 //----------------------------------------------------------------------------
@@ -501,4 +802,6 @@ void vtkDataEncoder::Flush(vtkTypeUInt32 key)
 void vtkDataEncoder::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DeltaFrames: " << this->DeltaFrames << endl;
+  os << indent << "Base64Encoding: " << this->Base64Encoding << endl;
 }
@@ -26,6 +26,11 @@
 // takes longer to compress and encode than that pushed in at N+1-th location or
 // if it was pushed in before the N-th location was even taken up for encoding
 // by the a thread in the thread pool.
+//
+// With DeltaFrames on, only the rectangle of pixels that changed since the
+// image last returned by GetLatestOutput() for the same key is encoded, which
+// saves most of the bandwidth of interactive views that change little from
+// one frame to the next.
 
 #ifndef vtkDataEncoder_h
 #define vtkDataEncoder_h
@@ -49,6 +54,26 @@ public:
   // and clear internal data-structures.
   void Initialize();
 
+  // Description:
+  // When on, images pushed afterwards are encoded as deltas: only the
+  // smallest rectangle containing the pixels that changed since the image
+  // last returned by GetLatestOutput() for the same key is compressed. The
+  // rectangle is given by the GetLatestOutput() overload with a region. The
+  // first image of a key, and images whose size changed, are encoded whole.
+  // Off by default.
+  vtkSetMacro(DeltaFrames, int);
+  vtkGetMacro(DeltaFrames, int);
+  vtkBooleanMacro(DeltaFrames, int);
+
+  // Description:
+  // When on, the compressed images pushed afterwards are base-64 encoded,
+  // and null terminated, so that they can be used as strings. Turn it off
+  // to get the compressed bytes, e.g. for binary websocket messages. On by
+  // default.
+  vtkSetMacro(Base64Encoding, int);
+  vtkGetMacro(Base64Encoding, int);
+  vtkBooleanMacro(Base64Encoding, int);
+
   // Description:
   // Push an image into the encoder. It is not safe to modify the image
   // after this point, including changing the reference counts for it.
@@ -66,6 +91,15 @@ public:
   // pending processing.
   bool GetLatestOutput(vtkTypeUInt32 key,vtkSmartPointer<vtkUnsignedCharArray>& data);
 
+  // Description:
+  // Same as GetLatestOutput(key, data), also returning the region of the
+  // image encoded in data, as x, y, width and height in pixels from the
+  // lower left corner. The region is the whole image unless DeltaFrames is
+  // on, and is empty when the image did not change. The
+  // client applies a region on top of the image it was given last.
+  bool GetLatestOutput(vtkTypeUInt32 key,
+    vtkSmartPointer<vtkUnsignedCharArray>& data, int region[4]);
+
   // Description:
   // Flushes the encoding pipe and blocks till the most recently pushed image
   // for the particular key has been processed. This call will block. Once this
@@ -86,6 +120,9 @@ protected:
   vtkDataEncoder();
   ~vtkDataEncoder();
 
+  int DeltaFrames;
+  int Base64Encoding;
+
 private:
   vtkDataEncoder(const vtkDataEncoder&); // Not implemented
   void operator=(const vtkDataEncoder&); // Not implemented
@@ -37,11 +37,70 @@
 #include "vtkWebGLObject.h"
 #include "vtkWindowToImageFilter.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <map>
 #include <sstream>
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Average blocks of factor x factor pixels of a window image into a new image
+// that the caller owns.
+vtkImageData* ShrinkImage(vtkImageData* image, int factor)
+{
+  vtkImageData* result = vtkImageData::New();
+  vtkUnsignedCharArray* scalars = vtkUnsignedCharArray::SafeDownCast(
+    image->GetPointData()->GetScalars());
+  int dims[3];
+  image->GetDimensions(dims);
+  if (!scalars || dims[2] != 1)
+    {
+    result->ShallowCopy(image);
+    return result;
+    }
+
+  const int numComps = scalars->GetNumberOfComponents();
+  const int outDims[2] =
+    { (dims[0] + factor - 1) / factor, (dims[1] + factor - 1) / factor };
+  result->SetDimensions(outDims[0], outDims[1], 1);
+  vtkNew<vtkUnsignedCharArray> outScalars;
+  outScalars->SetName(scalars->GetName());
+  outScalars->SetNumberOfComponents(numComps);
+  outScalars->SetNumberOfTuples(outDims[0] * outDims[1]);
+  result->GetPointData()->SetScalars(outScalars.GetPointer());
+
+  const unsigned char* in = scalars->GetPointer(0);
+  unsigned char* out = outScalars->GetPointer(0);
+  for (int j = 0; j < outDims[1]; ++j)
+    {
+    const int y0 = j * factor;
+    const int y1 = std::min(y0 + factor, dims[1]);
+    for (int i = 0; i < outDims[0]; ++i)
+      {
+      const int x0 = i * factor;
+      const int x1 = std::min(x0 + factor, dims[0]);
+      const int count = (y1 - y0) * (x1 - x0);
+      for (int c = 0; c < numComps; ++c)
+        {
+        int sum = 0;
+        for (int y = y0; y < y1; ++y)
+          {
+          const unsigned char* row = in + (y * dims[0]) * numComps + c;
+          for (int x = x0; x < x1; ++x)
+            {
+            sum += row[x * numComps];
+            }
+          }
+        *out++ = static_cast<unsigned char>((sum + count / 2) / count);
+        }
+      }
+    }
+  return result;
+}
+}
+
 class vtkWebApplication::vtkInternals
 {
 public:
@@ -53,7 +112,59 @@ public:
     bool HasImagesBeingProcessed;
     vtkObject* ViewPointer;
     unsigned long ObserverId;
-    ImageCacheValueType() : NeedsRender(true), HasImagesBeingProcessed(false), ViewPointer(NULL), ObserverId(0) { }
+
+    // State of the adaptive quality controller.
+    int LastQuality;
+    int LastReductionFactor;
+    bool Adapted;
+    int AdaptedQuality;
+    int AdaptedReductionFactor;
+    double LastRenderTime;
+    double FrameTime;
+
+    ImageCacheValueType() : NeedsRender(true), HasImagesBeingProcessed(false),
+      ViewPointer(NULL), ObserverId(0), LastQuality(0), LastReductionFactor(1),
+      Adapted(false), AdaptedQuality(-1), AdaptedReductionFactor(1),
+      LastRenderTime(0.0), FrameTime(0.0) { }
+
+    // Trade quality, then resolution, for speed when the smoothed frame time
+    // is over the target, and give them back in the reverse order when it is
+    // well under. The band in between keeps the settings from oscillating.
+    void Adapt(int maxQuality, int minQuality, int maxReductionFactor,
+      double targetFrameTime)
+    {
+      minQuality = std::min(minQuality, maxQuality);
+      if (this->AdaptedQuality < 0 || this->AdaptedQuality > maxQuality)
+        {
+        this->AdaptedQuality = maxQuality;
+        }
+      if (this->FrameTime > 1.25 * targetFrameTime)
+        {
+        if (this->AdaptedQuality > minQuality)
+          {
+          this->AdaptedQuality = std::max(minQuality, static_cast<int>(
+            this->AdaptedQuality * targetFrameTime / this->FrameTime));
+          }
+        else if (this->AdaptedReductionFactor < maxReductionFactor)
+          {
+          ++this->AdaptedReductionFactor;
+          }
+        }
+      else if (this->FrameTime > 0.0 &&
+        this->FrameTime < 0.75 * targetFrameTime)
+        {
+        if (this->AdaptedReductionFactor > 1)
+          {
+          --this->AdaptedReductionFactor;
+          }
+        else
+          {
+          this->AdaptedQuality = std::min(maxQuality, this->AdaptedQuality + 10);
+          }
+        }
+      this->AdaptedReductionFactor =
+        std::min(this->AdaptedReductionFactor, maxReductionFactor);
+    }
 
     void SetListener(vtkObject* view)
     {
@@ -118,6 +229,10 @@ vtkStandardNewMacro(vtkWebApplication);
 vtkWebApplication::vtkWebApplication():
   ImageEncoding(ENCODING_BASE64),
   ImageCompression(COMPRESSION_JPEG),
+  AdaptiveQuality(0),
+  TargetFrameTime(0.1),
+  MinimumQuality(20),
+  MaximumImageReductionFactor(4),
   Internals(new vtkWebApplication::vtkInternals())
 {
 }
@@ -136,11 +251,22 @@ bool vtkWebApplication::GetHasImagesBeingProcessed(vtkRenderWindow* view)
   return value.HasImagesBeingProcessed;
 }
 
+//----------------------------------------------------------------------------
+int vtkWebApplication::GetLastQuality(vtkRenderWindow* view)
+{
+  return this->Internals->ImageCache[view].LastQuality;
+}
+
+//----------------------------------------------------------------------------
+int vtkWebApplication::GetLastImageReductionFactor(vtkRenderWindow* view)
+{
+  return this->Internals->ImageCache[view].LastReductionFactor;
+}
+
 //----------------------------------------------------------------------------
 vtkUnsignedCharArray* vtkWebApplication::InteractiveRender(vtkRenderWindow* view, int quality)
 {
-  // for now, just do the same as StillRender().
-  return this->StillRender(view, quality);
+  return this->Render(view, quality, true);
 }
 
 //----------------------------------------------------------------------------
@@ -151,6 +277,13 @@ void vtkWebApplication::InvalidateCache(vtkRenderWindow* view)
 
 //----------------------------------------------------------------------------
 vtkUnsignedCharArray* vtkWebApplication::StillRender(vtkRenderWindow* view, int quality)
+{
+  return this->Render(view, quality, false);
+}
+
+//----------------------------------------------------------------------------
+vtkUnsignedCharArray* vtkWebApplication::Render(
+  vtkRenderWindow* view, int quality, bool asynchronousReadback)
 {
   if (!view)
     {
@@ -161,8 +294,12 @@ vtkUnsignedCharArray* vtkWebApplication::StillRender(vtkRenderWindow* view, int
   vtkInternals::ImageCacheValueType& value = this->Internals->ImageCache[view];
   value.SetListener(view);
 
+  bool interacting = this->AdaptiveQuality != 0 &&
+    this->Internals->ButtonStates[view] != 0;
+
+  // once the interaction is over, a degraded image does not stand for the view
   if (value.NeedsRender == false &&
-    value.Data != NULL /* FIXME SEB &&
+    value.Data != NULL && (interacting || !value.Adapted) /* FIXME SEB &&
     view->HasDirtyRepresentation() == false */)
     {
     //cout <<  "Reusing cache" << endl;
@@ -171,6 +308,46 @@ vtkUnsignedCharArray* vtkWebApplication::StillRender(vtkRenderWindow* view, int
     return value.Data;
     }
 
+  if (interacting && value.Data != NULL)
+    {
+    // Drop the frame rather than queue it behind one the encoder has not
+    // finished: the view is captured again once the client can take it.
+    bool latest = this->Internals->Encoder->GetLatestOutput(this->Internals->ObjectIdMap->GetGlobalId(view), value.Data);
+    if (!latest)
+      {
+      value.HasImagesBeingProcessed = true;
+      return value.Data;
+      }
+    }
+
+  int reductionFactor = 1;
+  if (interacting)
+    {
+    double now = vtkTimerLog::GetUniversalTime();
+    double period = now - value.LastRenderTime;
+    // a long pause starts a new measurement instead of counting as a frame
+    if (value.LastRenderTime > 0.0 &&
+      period < std::max(1.0, 4.0 * this->TargetFrameTime))
+      {
+      value.FrameTime = value.FrameTime > 0.0 ?
+        0.5 * (value.FrameTime + period) : period;
+      }
+    value.LastRenderTime = now;
+    value.Adapt(quality, this->MinimumQuality,
+      this->MaximumImageReductionFactor, this->TargetFrameTime);
+    reductionFactor = value.AdaptedReductionFactor;
+    value.Adapted = reductionFactor > 1 || value.AdaptedQuality < quality;
+    quality = value.AdaptedQuality;
+    }
+  else
+    {
+    value.LastRenderTime = 0.0;
+    value.FrameTime = 0.0;
+    value.Adapted = false;
+    }
+  value.LastQuality = quality;
+  value.LastReductionFactor = reductionFactor;
+
   //cout <<  "Regenerating " << endl;
   //vtkTimerLog::ResetLog();
   //vtkTimerLog::CleanupLog();
@@ -187,16 +364,31 @@ vtkUnsignedCharArray* vtkWebApplication::StillRender(vtkRenderWindow* view, int
   w2i->ReadFrontBufferOff();
   w2i->ShouldRerenderOff();
   w2i->FixBoundaryOn();
+  w2i->SetAsynchronousReadback(asynchronousReadback);
   w2i->Update();
 
-  vtkImageData* image = vtkImageData::New();
-  image->ShallowCopy(w2i->GetOutput());
+  // an asynchronous read gives the previous frame, the view must be
+  // rendered again to deliver the current one
+  bool lagging = asynchronousReadback && view->GetNumberOfQueuedPixelData() > 0;
+
+  vtkImageData* image = NULL;
+  if (reductionFactor > 1)
+    {
+    image = ShrinkImage(w2i->GetOutput(), reductionFactor);
+    }
+  else
+    {
+    image = vtkImageData::New();
+    image->ShallowCopy(w2i->GetOutput());
+    }
 
   //vtkTimerLog::MarkEndEvent("CaptureWindow");
 
   //vtkTimerLog::MarkEndEvent("StillRenderToString");
   //vtkTimerLog::DumpLogWithIndents(&cout, 0.0);
 
+  this->Internals->Encoder->SetBase64Encoding(
+    this->ImageEncoding == ENCODING_BASE64);
   this->Internals->Encoder->PushAndTakeReference(this->Internals->ObjectIdMap->GetGlobalId(view), image, quality);
   assert(image == NULL);
 
@@ -209,8 +401,8 @@ vtkUnsignedCharArray* vtkWebApplication::StillRender(vtkRenderWindow* view, int
     }
 
   bool latest = this->Internals->Encoder->GetLatestOutput(this->Internals->ObjectIdMap->GetGlobalId(view), value.Data);
-  value.HasImagesBeingProcessed = !latest;
-  value.NeedsRender = false;
+  value.HasImagesBeingProcessed = !latest || lagging;
+  value.NeedsRender = lagging;
   return value.Data;
 }
 
@@ -435,6 +627,11 @@ void vtkWebApplication::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "ImageEncoding: " << this->ImageEncoding << endl;
   os << indent << "ImageCompression: " << this->ImageCompression << endl;
+  os << indent << "AdaptiveQuality: " << this->AdaptiveQuality << endl;
+  os << indent << "TargetFrameTime: " << this->TargetFrameTime << endl;
+  os << indent << "MinimumQuality: " << this->MinimumQuality << endl;
+  os << indent << "MaximumImageReductionFactor: "
+     << this->MaximumImageReductionFactor << endl;
 }
 
 //----------------------------------------------------------------------------
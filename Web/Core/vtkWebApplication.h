@@ -37,7 +37,9 @@ public:
   void PrintSelf(ostream& os, vtkIndent indent);
 
   // Description:
-  // Set the encoding to be used for rendered images.
+  // Set the encoding to be used for rendered images. With ENCODING_NONE, the
+  // rendered images are the compressed bytes, as for binary websocket
+  // messages, and StillRenderToString() must not be used.
   enum
     {
     ENCODING_NONE=0,
@@ -58,7 +60,36 @@ public:
   vtkGetMacro(ImageCompression, int);
 
   // Description:
-  // Render a view and obtain the rendered image.
+  // When on, images rendered while a mouse button is held on a view (see
+  // HandleInteractionEvent()) adapt to the measured frame time: the JPEG
+  // quality is lowered, down to MinimumQuality, then the image is shrunk by
+  // up to MaximumImageReductionFactor until frames arrive within
+  // TargetFrameTime seconds. The frame time is the period between renders
+  // of the view, so it covers the round trip to the client as well as the
+  // encoding. No new frame is captured while the previous one is still
+  // being encoded, and the first render after the buttons are released is
+  // a full resolution image at the requested quality. Off by default.
+  vtkSetMacro(AdaptiveQuality, int);
+  vtkGetMacro(AdaptiveQuality, int);
+  vtkBooleanMacro(AdaptiveQuality, int);
+  vtkSetClampMacro(TargetFrameTime, double, 0.001, VTK_DOUBLE_MAX);
+  vtkGetMacro(TargetFrameTime, double);
+  vtkSetClampMacro(MinimumQuality, int, 0, 100);
+  vtkGetMacro(MinimumQuality, int);
+  vtkSetClampMacro(MaximumImageReductionFactor, int, 1, 16);
+  vtkGetMacro(MaximumImageReductionFactor, int);
+
+  // Description:
+  // Return the JPEG quality and the image reduction factor used for the last
+  // image rendered from the view.
+  int GetLastQuality(vtkRenderWindow* view);
+  int GetLastImageReductionFactor(vtkRenderWindow* view);
+
+  // Description:
+  // Render a view and obtain the rendered image. InteractiveRender() reads
+  // the window asynchronously, so it returns the image of its previous
+  // call while the current one is transferred, and reports images being
+  // processed until the view is rendered again.
   vtkUnsignedCharArray* StillRender(vtkRenderWindow* view, int quality = 100);
   vtkUnsignedCharArray* InteractiveRender(vtkRenderWindow* view, int quality = 50);
   const char* StillRenderToString(vtkRenderWindow* view, unsigned long time = 0, int quality = 100);
@@ -101,8 +132,17 @@ protected:
   vtkWebApplication();
   ~vtkWebApplication();
 
+  // Description:
+  // Implementation of StillRender() and InteractiveRender().
+  vtkUnsignedCharArray* Render(vtkRenderWindow* view, int quality,
+                               bool asynchronousReadback);
+
   int ImageEncoding;
   int ImageCompression;
+  int AdaptiveQuality;
+  double TargetFrameTime;
+  int MinimumQuality;
+  int MaximumImageReductionFactor;
   unsigned long LastStillRenderToStringMTime;
 
 private:
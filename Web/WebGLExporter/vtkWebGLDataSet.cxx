@@ -18,6 +18,10 @@
 #include "vtkObjectFactory.h"
 #include "vtkWebGLExporter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 vtkStandardNewMacro(vtkWebGLDataSet);
 
 std::string vtkWebGLDataSet::GetMD5()
@@ -39,6 +43,7 @@ vtkWebGLDataSet::vtkWebGLDataSet()
   this->binary = NULL;
   this->binarySize = 0;
   this->hasChanged = false;
+  this->quantize = false;
   }
 
 vtkWebGLDataSet::~vtkWebGLDataSet()
@@ -149,6 +154,10 @@ void vtkWebGLDataSet::GenerateBinaryData()
     memcpy(&this->binary[0], &pos, sizeof(pos));
     this->binarySize = total;
     }
+  else if (this->webGLType == wTRIANGLES && this->quantize)
+    {
+    this->GenerateQuantizedMeshData();
+    }
   else if (this->webGLType == wTRIANGLES)
     {
     pos = sizeof(pos);
@@ -204,6 +213,91 @@ void vtkWebGLDataSet::SetType(WebGLObjectTypes t)
   this->webGLType = t;
   }
 
+void vtkWebGLDataSet::SetQuantize(bool q)
+  {
+  this->quantize = q;
+  }
+
+// Layout: Size, 'Q', VertCount, Origin[3], Step[3], Vert (uint16), Normal
+// (int8), Color, IndCount, IndBytes, Index (zigzag varints of the
+// differences between consecutive indexes), Matrix
+void vtkWebGLDataSet::GenerateQuantizedMeshData()
+  {
+  float origin[6] = {0, 0, 0, 0, 0, 0};
+  if (this->NumberOfVertices > 0)
+    {
+    float upper[3];
+    for (int c=0; c<3; c++) origin[c] = upper[c] = this->vertices[c];
+    for (int i=1; i<this->NumberOfVertices; i++)
+      {
+      for (int c=0; c<3; c++)
+        {
+        origin[c] = std::min(origin[c], this->vertices[i*3+c]);
+        upper[c] = std::max(upper[c], this->vertices[i*3+c]);
+        }
+      }
+    for (int c=0; c<3; c++) origin[3+c] = (upper[c] - origin[c]) / 65535.0f;
+    }
+
+  std::vector<unsigned char> indexStream;
+  indexStream.reserve(this->NumberOfIndexes*2);
+  int last = 0;
+  for (int i=0; i<this->NumberOfIndexes; i++)
+    {
+    int index = static_cast<unsigned short>(this->indexes[i]);
+    int delta = index - last;
+    last = index;
+    unsigned int value = delta < 0 ? ((static_cast<unsigned int>(-delta) << 1) - 1) : (static_cast<unsigned int>(delta) << 1);
+    while (value >= 0x80)
+      {
+      indexStream.push_back(static_cast<unsigned char>((value & 0x7f) | 0x80));
+      value >>= 7;
+      }
+    indexStream.push_back(static_cast<unsigned char>(value));
+    }
+  int indexBytes = static_cast<int>(indexStream.size());
+
+  int pos = sizeof(pos);
+  int total = sizeof(pos) + 1 + sizeof(this->NumberOfVertices) + sizeof(origin)  //Size, Type, VertCount, Origin, Step
+      + this->NumberOfVertices*3*(2+1) + this->NumberOfVertices*4                   //Vert, Normal, Color
+      + sizeof(this->NumberOfIndexes) + sizeof(indexBytes) + indexBytes             //IndCount, IndBytes, Index
+      + sizeof(this->Matrix[0])*16;                                                 //Matrix
+  this->binary = new unsigned char[total];
+  memset(this->binary,0,total);
+
+  this->binary[pos++] = 'Q';
+  memcpy(&this->binary[pos], &this->NumberOfVertices, sizeof(this->NumberOfVertices)); pos+=sizeof(this->NumberOfVertices);
+  memcpy(&this->binary[pos], origin, sizeof(origin)); pos+=sizeof(origin);
+  for (int i=0; i<this->NumberOfVertices*3; i++)
+    {
+    float step = origin[3+i%3];
+    unsigned short q = 0;
+    if (step > 0)
+      {
+      float scaled = (this->vertices[i] - origin[i%3]) / step + 0.5f;
+      q = static_cast<unsigned short>(std::min(scaled, 65535.0f));
+      }
+    this->binary[pos++] = static_cast<unsigned char>(q & 0xff);
+    this->binary[pos++] = static_cast<unsigned char>(q >> 8);
+    }
+  for (int i=0; i<this->NumberOfVertices*3; i++)
+    {
+    float n = std::max(-1.0f, std::min(1.0f, this->normals[i]));
+    this->binary[pos++] = static_cast<unsigned char>(static_cast<signed char>(floor(n*127.0f + 0.5f)));
+    }
+  memcpy(&this->binary[pos], this->colors, this->NumberOfVertices*4); pos+=this->NumberOfVertices*4;
+  memcpy(&this->binary[pos], &this->NumberOfIndexes, sizeof(this->NumberOfIndexes)); pos+=sizeof(this->NumberOfIndexes);
+  memcpy(&this->binary[pos], &indexBytes, sizeof(indexBytes)); pos+=sizeof(indexBytes);
+  if (indexBytes)
+    {
+    memcpy(&this->binary[pos], &indexStream[0], indexBytes); pos+=indexBytes;                                             //Index
+    }
+  memcpy(&this->binary[pos], this->Matrix, sizeof(this->Matrix[0])*16); pos+=sizeof(this->Matrix[0])*16;
+
+  memcpy(&this->binary[0], &pos, sizeof(pos));
+  this->binarySize = total;
+  }
+
 bool vtkWebGLDataSet::HasChanged()
   {
   return this->hasChanged;
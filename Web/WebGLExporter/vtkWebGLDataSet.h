@@ -41,6 +41,13 @@ public:
   void SetMatrix(float* m);
   void SetType(WebGLObjectTypes t);
 
+  // Description:
+  // When true, triangles are written in the quantized format: 16 bits per
+  // vertex coordinate within the bounds of the vertices, 8 bits per normal
+  // component, and indexes as variable length differences. This is about a
+  // third of the size of the float format.
+  void SetQuantize(bool q);
+
   unsigned char* GetBinaryData();
   int GetBinarySize();
   void GenerateBinaryData();
@@ -69,8 +76,11 @@ protected:
   unsigned char* binary;   // Data in binary
   int binarySize;          // Size of the data in binary
   bool hasChanged;
+  bool quantize;
   std::string MD5;
 
+  void GenerateQuantizedMeshData();
+
 private:
   vtkWebGLDataSet(const vtkWebGLDataSet&); // Not implemented
   void operator=(const vtkWebGLDataSet&);   // Not implemented
@@ -92,6 +92,7 @@ vtkWebGLExporter::vtkWebGLExporter()
   this->SceneSize[1] = 0;
   this->SceneSize[2] = 0;
   this->hasWidget = false;
+  this->QuantizeGeometry = false;
 }
 
 vtkWebGLExporter::~vtkWebGLExporter()
@@ -125,6 +126,17 @@ void vtkWebGLExporter::SetMaxAllowedSize(int size)
   this->SetMaxAllowedSize(size, size);
   }
 
+void vtkWebGLExporter::SetQuantizeGeometry(bool quantize)
+  {
+  if (this->QuantizeGeometry != quantize)
+    {
+    this->QuantizeGeometry = quantize;
+    // Forget the actors so that their objects are built again.
+    this->Internal->ActorTimestamp.clear();
+    this->Modified();
+    }
+  }
+
 void vtkWebGLExporter::SetCenterOfRotation(float a1, float a2, float a3)
   {
   this->CenterOfRotation[0] = a1;
@@ -232,17 +244,21 @@ void vtkWebGLExporter::parseActor(vtkActor* actor, unsigned long actorTime, size
   vtkMapper* mapper = actor->GetMapper();
   if (mapper)
     {
+    // The key only uses modification times so that the geometry of
+    // unchanged actors is neither triangulated nor serialized again.
     unsigned long dataMTime;
-    vtkTriangleFilter* polydata = this->GetPolyData(mapper, dataMTime);
+    vtkDataObject* input = mapper->GetInputDataObject(0, 0);
     vtkActor* key = actor;
     dataMTime = actor->GetMTime() + mapper->GetLookupTable()->GetMTime();
     dataMTime += actor->GetProperty()->GetMTime() + mapper->GetMTime() + actor->GetRedrawMTime();
-    dataMTime += polydata->GetOutput()->GetNumberOfLines() + polydata->GetOutput()->GetNumberOfPolys();
     dataMTime += actor->GetProperty()->GetRepresentation() + mapper->GetScalarMode() + actor->GetVisibility();
-    dataMTime += polydata->GetInput()->GetMTime();
+    if (input) dataMTime += input->GetMTime();
     if (vtkFollower::SafeDownCast(actor)) dataMTime += vtkFollower::SafeDownCast(actor)->GetCamera()->GetMTime();
     if(dataMTime != actorTime && actor->GetVisibility())
       {
+      unsigned long inputMTime;
+      vtkTriangleFilter* polydata = this->GetPolyData(mapper, inputMTime);
+
       double bb[6];
       actor->GetBounds(bb);
       double m1 = std::max(bb[1]-bb[0], bb[3]-bb[2]); m1 = std::max(m1, bb[5]-bb[4]);
@@ -267,6 +283,7 @@ void vtkWebGLExporter::parseActor(vtkActor* actor, unsigned long actorTime, size
           }
         }
       if (obj == NULL) obj = vtkWebGLPolyData::New();
+      ((vtkWebGLPolyData*)obj)->SetQuantize(this->QuantizeGeometry);
 
       if (polydata->GetOutput()->GetNumberOfPolys() != 0)
         {
@@ -620,6 +637,7 @@ int vtkWebGLExporter::GetNumberOfObjects()
 void vtkWebGLExporter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "QuantizeGeometry: " << this->QuantizeGeometry << endl;
 }
 
 const char* vtkWebGLExporter::GetId()
@@ -63,6 +63,16 @@ public:
   void SetMaxAllowedSize(int mesh, int lines);
   void SetMaxAllowedSize(int size);
 
+  // Description:
+  // When on, the triangles of the actors are exported in a quantized
+  // format, with 16 bit coordinates within the bounds of each part, 8 bit
+  // normals and compressed indexes, about a third of the size of the float
+  // format. Changing it rebuilds all the objects at the next parseScene().
+  // Off by default.
+  void SetQuantizeGeometry(bool quantize);
+  vtkGetMacro(QuantizeGeometry, bool);
+  vtkBooleanMacro(QuantizeGeometry, bool);
+
   //BTX
   static void ComputeMD5(const unsigned char* content, int size, std::string &hash);
 protected:
@@ -89,6 +99,7 @@ protected:
   int meshObjMaxSize, lineObjMaxSize;        // Max size of object allowed (faces)
   std::string renderersMetaData;
   bool hasWidget;
+  bool QuantizeGeometry;
 
 private:
   vtkWebGLExporter(const vtkWebGLExporter&); // Not implemented
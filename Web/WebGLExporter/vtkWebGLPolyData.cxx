@@ -48,6 +48,7 @@ class vtkWebGLPolyData::vtkInternal
 public:
   std::vector<vtkWebGLDataSet*> Parts;
   std::map<long int, short> IndexMap;
+  bool Quantize;
   };
 //*****************************************************************************
 
@@ -56,6 +57,7 @@ vtkWebGLPolyData::vtkWebGLPolyData()
   this->webGlType = wTRIANGLES;
   this->iswidget = false;
   this->Internal = new vtkInternal();
+  this->Internal->Quantize = false;
   }
 
 vtkWebGLPolyData::~vtkWebGLPolyData()
@@ -271,6 +273,7 @@ void vtkWebGLPolyData::GenerateBinaryData()
   for(size_t i=0; i<this->Internal->Parts.size(); i++)
     {
     obj = this->Internal->Parts[i];
+    obj->SetQuantize(this->Internal->Quantize);
     obj->GenerateBinaryData();
     ss << obj->GetMD5();
     }
@@ -284,6 +287,11 @@ void vtkWebGLPolyData::GenerateBinaryData()
   else cout << "Warning: GenerateBinaryData() @ vtkWebGLObject: This isn\'t supposed to happen.";
   }
 
+void vtkWebGLPolyData::SetQuantize(bool q)
+  {
+  this->Internal->Quantize = q;
+  }
+
 int vtkWebGLPolyData::GetNumberOfParts()
   {
   return static_cast<int>(this->Internal->Parts.size());
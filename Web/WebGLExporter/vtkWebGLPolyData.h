@@ -57,6 +57,11 @@ public:
   void SetPoints(float* points, int numberOfPoints, unsigned char* colors, int maxSize);
   void SetTransformationMatrix(vtkMatrix4x4* m);
 
+  // Description:
+  // Write the triangles of the parts in the quantized format of
+  // vtkWebGLDataSet. Takes effect at the next GenerateBinaryData().
+  void SetQuantize(bool q);
+
 protected:
   vtkWebGLPolyData();
   ~vtkWebGLPolyData();
@@ -564,8 +564,10 @@ WebGLRenderer.prototype.parseObject = function(obj){
   }
 
   //-=-=-=-=-=[ MESH ]=-=-=-=-=-
-  else if (type == 'M'){
+  else if (type == 'M' || type == 'Q'){
     obj.numberOfVertices = (ss[pos++]) + (ss[pos++] << 8) + (ss[pos++] << 16) + (ss[pos++] << 24);
+    if (type == 'Q') pos = this.parseQuantizedMesh(obj, ss, pos);
+    else {
     //Getting Vertices
     test = new Int8Array(obj.numberOfVertices*4*3); for(i=0; i<obj.numberOfVertices*4*3; i++) test[i] = ss[pos++];
     obj.vertices = new Float32Array(test.buffer);
@@ -580,6 +582,7 @@ WebGLRenderer.prototype.parseObject = function(obj){
     //Getting Index
     test = new Int8Array(obj.numberOfIndex*2); for(i=0; i<obj.numberOfIndex*2; i++) test[i] = ss[pos++];
     obj.index = new Uint16Array(test.buffer);
+    }
     //Getting Matrix
     test = new Int8Array(16*4); for(i=0; i<16*4; i++) test[i] = ss[pos++];
     obj.matrix = new Float32Array(test.buffer);
@@ -658,6 +661,40 @@ WebGLRenderer.prototype.parseObject = function(obj){
   }
 }
 
+// Read the vertices, normals, colors and indexes of a quantized mesh ('Q').
+// The vertices are 16 bit offsets from the origin of the mesh in steps, the
+// normals have 8 bits per component and the indexes are zigzag varints of
+// the differences between consecutive indexes. Returns the position of the
+// matrix.
+WebGLRenderer.prototype.parseQuantizedMesh = function(obj, ss, pos){
+  //Getting Origin and Step
+  test = new Int8Array(6*4); for(i=0; i<6*4; i++) test[i] = ss[pos++];
+  var bounds = new Float32Array(test.buffer);
+  //Getting Vertices
+  obj.vertices = new Float32Array(obj.numberOfVertices*3);
+  for(i=0; i<obj.numberOfVertices*3; i++, pos+=2)
+    obj.vertices[i] = bounds[i%3] + (ss[pos] + (ss[pos+1] << 8))*bounds[3+i%3];
+  //Getting Normals
+  obj.normals = new Float32Array(obj.numberOfVertices*3);
+  for(i=0; i<obj.numberOfVertices*3; i++) obj.normals[i] = ((ss[pos++] << 24) >> 24)/127.0;
+  //Getting Colors
+  test = []; for(i=0; i<obj.numberOfVertices*4; i++) test[i] = ss[pos++]/255.0;
+  obj.colors = new Float32Array(test);
+
+  obj.numberOfIndex = (ss[pos++]) + (ss[pos++] << 8) + (ss[pos++] << 16) + (ss[pos++] << 24);
+  pos += 4; //Size of the index stream
+  //Getting Index
+  obj.index = new Uint16Array(obj.numberOfIndex);
+  var last = 0;
+  for(i=0; i<obj.numberOfIndex; i++){
+    var value = 0, shift = 0, b;
+    do { b = ss[pos++]; value |= (b & 0x7f) << shift; shift += 7; } while (b & 0x80);
+    last += (value >>> 1) ^ -(value & 1);
+    obj.index[i] = last;
+  }
+  return pos;
+}
+
 WebGLRenderer.prototype.renderColorMap = function(){
   obj = this;
   render = this.father;
@@ -17,10 +17,12 @@ Caveats:
    supported.  Char arrays are also not easy to handle and might not
    work as you expect.  Patches welcome.
 
- - You need to make sure you hold a reference to a Numpy array you want
-   to import into VTK.  If not you'll get a segfault (in the best case).
-   The same holds in reverse when you convert a VTK array to a numpy
-   array -- don't delete the VTK array.
+ - Neither conversion copies the data by default, and each side holds
+   a reference to the other: the VTK array returned by numpy_to_vtk
+   keeps the numpy data alive until it frees or resizes its memory, and
+   the numpy array returned by vtk_to_numpy keeps the VTK array alive.
+   Resizing the VTK array moves its data, after which the two arrays no
+   longer share it, so do not resize a VTK array that is viewed by numpy.
 
 
 Created by Prabhu Ramachandran in Feb. 2008.
@@ -111,12 +113,12 @@ def numpy_to_vtk(num_array, deep=0, array_type=None):
 
     If the second argument is set to 1, the array is deep-copied from
     from numpy. This is not as efficient as the default behavior
-    (shallow copy) and uses more memory but detaches the two arrays
-    such that the numpy array can be released.
+    (shallow copy) and uses more memory but detaches the two arrays.
 
-    WARNING: You must maintain a reference to the passed numpy array, if
-    the numpy data is gc'd and VTK will point to garbage which will in
-    the best case give you a segfault.
+    Without a deep copy, the VTK array holds a reference to the numpy
+    data, so the numpy array does not need to be kept.  Read-only numpy
+    arrays and arrays whose type differs from array_type are always
+    deep-copied.
 
     Parameters
     ----------
@@ -155,8 +157,6 @@ def numpy_to_vtk(num_array, deep=0, array_type=None):
     else:
         result_array.SetNumberOfComponents(shape[1])
 
-    result_array.SetNumberOfTuples(shape[0])
-
     # Ravel the array appropriately.
     arr_dtype = get_numpy_array_type(vtk_typecode)
     if numpy.issubdtype(z.dtype, arr_dtype) or \
@@ -169,14 +169,24 @@ def numpy_to_vtk(num_array, deep=0, array_type=None):
         # do not deep copy its data.
         deep = 1
 
-    # Point the VTK array to the numpy data.  The last argument (1)
-    # tells the array not to deallocate.
+    if not deep:
+        # The VTK array holds the buffer of the numpy data, and with it a
+        # reference to the numpy array, until it frees or resizes its
+        # memory.  Read-only data cannot be shared this way.
+        try:
+            vtk.set_array_buffer(result_array, z_flat)
+            return result_array
+        except (TypeError, ValueError, BufferError):
+            deep = 1
+
+    result_array.SetNumberOfTuples(shape[0])
+
+    # Point the VTK array to the numpy data before copying it.  The last
+    # argument (1) tells the array not to deallocate.
     result_array.SetVoidArray(z_flat, len(z_flat), 1)
-    if deep:
-        copy = result_array.NewInstance()
-        copy.DeepCopy(result_array)
-        result_array = copy
-    return result_array
+    copy = result_array.NewInstance()
+    copy.DeepCopy(result_array)
+    return copy
 
 def numpy_to_vtkIdTypeArray(num_array, deep=0):
     isize = vtk.vtkIdTypeArray().GetDataTypeSize()
@@ -197,7 +207,8 @@ def vtk_to_numpy(vtk_array):
 
     Given a subclass of vtkDataArray, this function returns an
     appropriate numpy array containing the same data -- it actually
-    points to the same data.
+    points to the same data, and holds a reference to the VTK array
+    through the buffer protocol.
 
     WARNING: This does not work for bit arrays.
 
@@ -16,6 +16,9 @@
 #include "PyVTKExtras.h"
 #include "vtkPythonCompatibility.h"
 #include "PyVTKMutableObject.h"
+#include "vtkPythonBufferDataArrayAllocator.h"
+#include "vtkPythonUtil.h"
+#include "vtkDataArray.h"
 
 // Silence warning like
 // "dereferencing type-punned pointer will break strict-aliasing rules"
@@ -119,12 +122,42 @@ static PyObject *PyVTKExtras_buffer_shared(PyObject *, PyObject *args)
   return NULL;
 }
 
+//--------------------------------------------------------------------
+static PyObject *PyVTKExtras_set_array_buffer(PyObject *, PyObject *args)
+{
+  PyObject *ob[2] = { NULL, NULL };
+  if (PyArg_UnpackTuple(args, "set_array_buffer", 2, 2, &ob[0], &ob[1]))
+    {
+    vtkDataArray *array = static_cast<vtkDataArray *>(
+      vtkPythonUtil::GetPointerFromObject(ob[0], "vtkDataArray"));
+    if (!array)
+      {
+      if (!PyErr_Occurred())
+        {
+        PyErr_SetString(PyExc_TypeError, "a vtkDataArray is required");
+        }
+      return NULL;
+      }
+    if (vtkPythonBufferDataArrayAllocator::SetArrayBuffer(array, ob[1]))
+      {
+      Py_RETURN_NONE;
+      }
+    }
+  return NULL;
+}
+
 //--------------------------------------------------------------------
 static PyMethodDef PyVTKExtras_Methods[] = {
   {"buffer_shared", PyVTKExtras_buffer_shared, METH_VARARGS,
    "Check if two objects share the same buffer, meaning that they"
    " point to the same block of memory.  An TypeError exception will"
    " be raised if either of the objects does not provide a buffer."},
+  {"set_array_buffer", PyVTKExtras_set_array_buffer, METH_VARARGS,
+   "Make the values of a vtkDataArray the contents of a writable,"
+   " contiguous buffer, such as a numpy array, without copying them."
+   " The number of components of the array must be set first.  The"
+   " array keeps a reference to the buffer until it frees or resizes"
+   " its memory."},
   {NULL, NULL, 0, NULL}
 };
 
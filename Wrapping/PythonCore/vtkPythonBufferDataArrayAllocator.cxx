@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPythonBufferDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkPythonBufferDataArrayAllocator.h"
+#include "vtkDataArray.h"
+
+//--------------------------------------------------------------------
+vtkPythonBufferDataArrayAllocator::vtkPythonBufferDataArrayAllocator()
+{
+  Py_buffer empty = VTK_PYBUFFER_INITIALIZER;
+  this->View = empty;
+  this->HasView = false;
+}
+
+//--------------------------------------------------------------------
+vtkPythonBufferDataArrayAllocator::~vtkPythonBufferDataArrayAllocator()
+{
+  this->ReleaseBuffer();
+}
+
+//--------------------------------------------------------------------
+void vtkPythonBufferDataArrayAllocator::ReleaseBuffer()
+{
+  if (!this->HasView)
+    {
+    return;
+    }
+  this->HasView = false;
+
+  // The array may be freed after Py_Finalize, or by a thread that does
+  // not hold the GIL.
+#if PY_VERSION_HEX >= 0x02060000
+  if (Py_IsInitialized())
+    {
+    vtkPythonScopeGilEnsurer gilEnsurer(true);
+    PyBuffer_Release(&this->View);
+    }
+#endif
+}
+
+//--------------------------------------------------------------------
+void *vtkPythonBufferDataArrayAllocator::Reallocate(void *ptr,
+                                                    size_t oldSize,
+                                                    size_t newSize)
+{
+  if (ptr && this->HasView && ptr == this->View.buf)
+    {
+    // Move the values out of the buffer, which is released in Free().
+    return this->CopyReallocate(ptr, oldSize, newSize);
+    }
+  return this->Superclass::Reallocate(ptr, oldSize, newSize);
+}
+
+//--------------------------------------------------------------------
+void vtkPythonBufferDataArrayAllocator::Free(void *ptr, size_t size)
+{
+  if (ptr && this->HasView && ptr == this->View.buf)
+    {
+    this->ReleaseBuffer();
+    return;
+    }
+  this->Superclass::Free(ptr, size);
+}
+
+//--------------------------------------------------------------------
+int vtkPythonBufferDataArrayAllocator::SetArrayBuffer(vtkDataArray *array,
+                                                      PyObject *obj)
+{
+#if PY_VERSION_HEX >= 0x02060000
+  int valueSize = array->GetDataTypeSize();
+  int numComponents = array->GetNumberOfComponents();
+  if (array->GetDataType() == VTK_BIT || valueSize == 0)
+    {
+    PyErr_SetString(PyExc_TypeError,
+      "the array does not have one value per element");
+    return 0;
+    }
+
+  // The array may write to its values, so the buffer must be writable.
+  vtkPythonBufferDataArrayAllocator *allocator =
+    vtkPythonBufferDataArrayAllocator::New();
+  if (PyObject_GetBuffer(obj, &allocator->View,
+                         PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS) == -1)
+    {
+    allocator->Delete();
+    return 0;
+    }
+  allocator->HasView = true;
+
+  Py_ssize_t tupleSize = static_cast<Py_ssize_t>(valueSize) * numComponents;
+  if (allocator->View.len % tupleSize != 0)
+    {
+    PyErr_SetString(PyExc_ValueError,
+      "the buffer size is not a multiple of the tuple size");
+    allocator->Delete();
+    return 0;
+    }
+
+  vtkIdType numValues =
+    static_cast<vtkIdType>(allocator->View.len / valueSize);
+  if (!array->SetAllocatedVoidArray(allocator->View.buf, numValues,
+                                    allocator))
+    {
+    PyErr_SetString(PyExc_TypeError,
+      "the array cannot use the memory of a buffer");
+    allocator->Delete();
+    return 0;
+    }
+
+  // The array keeps the allocator, and the buffer, alive.
+  allocator->Delete();
+  return 1;
+#else
+  (void)array;
+  (void)obj;
+  PyErr_SetString(PyExc_TypeError,
+    "sharing buffers with arrays requires python 2.6 or later");
+  return 0;
+#endif
+}
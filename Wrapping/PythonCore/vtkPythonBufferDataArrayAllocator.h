@@ -0,0 +1,76 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPythonBufferDataArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPythonBufferDataArrayAllocator - data array memory of a python buffer
+// .SECTION Description
+// vtkPythonBufferDataArrayAllocator hands the memory of a python object
+// that supports the buffer protocol, such as a numpy array, to a data
+// array without copying it. The allocator holds the buffer, and with it a
+// reference to the python object, until the array frees its memory, so
+// the python object may be released as soon as the array is set.
+//
+// Each instance holds at most one buffer. When an array that uses it is
+// resized, its values are copied to memory allocated like in
+// vtkDataArrayAllocator and the buffer is released.
+//
+// .SECTION See Also
+// vtkDataArrayAllocator vtkDataArray::SetAllocatedVoidArray
+
+#ifndef vtkPythonBufferDataArrayAllocator_h
+#define vtkPythonBufferDataArrayAllocator_h
+
+#include "vtkWrappingPythonCoreModule.h" // For export macro
+#include "vtkPython.h"
+#include "vtkPythonCompatibility.h" // For Py_buffer
+#include "vtkDataArrayAllocator.h"
+
+class vtkDataArray;
+
+class VTKWRAPPINGPYTHONCORE_EXPORT vtkPythonBufferDataArrayAllocator
+  : public vtkDataArrayAllocator
+{
+public:
+  vtkTypeMacro(vtkPythonBufferDataArrayAllocator, vtkDataArrayAllocator);
+
+  static vtkPythonBufferDataArrayAllocator *New()
+    { return new vtkPythonBufferDataArrayAllocator; }
+
+  // Description:
+  // Make the values of the array the contents of the writable, contiguous
+  // buffer of obj, whose size must be a multiple of the size of a tuple.
+  // The number of components of the array must be set. Returns 0 and sets
+  // a python exception on failure, in which case the array is unchanged.
+  // Must be called with the GIL held. Requires python 2.6 or later.
+  static int SetArrayBuffer(vtkDataArray *array, PyObject *obj);
+
+  virtual void *Reallocate(void *ptr, size_t oldSize, size_t newSize);
+  virtual void Free(void *ptr, size_t size);
+
+protected:
+  vtkPythonBufferDataArrayAllocator();
+  ~vtkPythonBufferDataArrayAllocator();
+
+  // Release the buffer, taking the GIL.
+  void ReleaseBuffer();
+
+  Py_buffer View;
+  bool HasView;
+
+private:
+  vtkPythonBufferDataArrayAllocator(const vtkPythonBufferDataArrayAllocator&);  // Not implemented.
+  void operator=(const vtkPythonBufferDataArrayAllocator&);  // Not implemented.
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkPythonBufferDataArrayAllocator.h
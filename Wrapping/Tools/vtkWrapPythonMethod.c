@@ -40,6 +40,10 @@ static void vtkWrapPython_GetAllParameters(
 static void vtkWrapPython_SaveArrayArgs(
   FILE *fp, FunctionInfo *currentFunction);
 
+/* check whether the GIL is released around the C++ method */
+static int vtkWrapPython_MethodReleasesGIL(
+  FunctionInfo *currentFunction, ClassInfo *data);
+
 /* generate the code that calls the C++ method */
 static void vtkWrapPython_GenerateMethodCall(
   FILE *fp, FunctionInfo *currentFunction, ClassInfo *data,
@@ -653,6 +657,47 @@ void vtkWrapPython_SaveArrayArgs(FILE *fp, FunctionInfo *currentFunction)
     }
 }
 
+/* -------------------------------------------------------------------- */
+/* check whether the GIL can be released while the C++ method runs, which
+ * is done for the methods that execute pipelines, render or write files
+ * if VTK_PYTHON_RELEASE_GIL is defined */
+static int vtkWrapPython_MethodReleasesGIL(
+  FunctionInfo *currentFunction, ClassInfo *data)
+{
+  static const char *methodNames[] = {
+    "Update", "UpdateInformation", "UpdateWholeExtent", "UpdatePiece",
+    "UpdateTimeStep", "Render", "Write", NULL };
+  int i;
+  int found = 0;
+
+  if (vtkWrap_IsConstructor(data, currentFunction) ||
+      !currentFunction->Name)
+    {
+    return 0;
+    }
+
+  for (i = 0; methodNames[i] != NULL; i++)
+    {
+    if (strcmp(currentFunction->Name, methodNames[i]) == 0)
+      {
+      found = 1;
+      break;
+      }
+    }
+
+  /* python objects and callbacks need the GIL */
+  for (i = 0; found && i < currentFunction->NumberOfParameters; i++)
+    {
+    if (vtkWrap_IsPythonObject(currentFunction->Parameters[i]) ||
+        vtkWrap_IsFunction(currentFunction->Parameters[i]))
+      {
+      found = 0;
+      }
+    }
+
+  return found;
+}
+
 /* -------------------------------------------------------------------- */
 /* generate the code that calls the C++ method */
 static void vtkWrapPython_GenerateMethodCall(
@@ -663,12 +708,20 @@ static void vtkWrapPython_GenerateMethodCall(
   ValueInfo *arg;
   int totalArgs;
   int is_constructor;
+  int releases_gil;
   int i, k, n;
 
   totalArgs = vtkWrap_CountWrappedParameters(currentFunction);
 
   is_constructor = vtkWrap_IsConstructor(data, currentFunction);
 
+  releases_gil = vtkWrapPython_MethodReleasesGIL(currentFunction, data);
+  if (releases_gil)
+    {
+    fprintf(fp,
+            "    VTK_PYTHON_BEGIN_ALLOW_THREADS\n");
+    }
+
   /* for vtkobjects, do a bound call and an unbound call */
   n = 1;
   if (is_vtkobject &&
@@ -826,6 +879,12 @@ static void vtkWrapPython_GenerateMethodCall(
       }
     }
 
+  if (releases_gil)
+    {
+    fprintf(fp,
+            "    VTK_PYTHON_END_ALLOW_THREADS\n");
+    }
+
   if (is_constructor)
     {
     /* initialize tuples created with default constructor */